@@ -73,12 +73,16 @@ function(resolve_arrow_dependency)
   set(ARROW_IPC ON)
   set(ARROW_FILESYSTEM ON)
   set(ARROW_JSON ON)
+  set(ARROW_ORC ON)
   set(ARROW_PARQUET ON)
   set(ARROW_SIMD_LEVEL "NONE")
   set(ARROW_RUNTIME_SIMD_LEVEL "NONE")
   set(ARROW_POSITION_INDEPENDENT_CODE ON)
   set(ARROW_DEPENDENCY_SOURCE "BUNDLED")
   set(ARROW_WITH_ZLIB ON)
+  set(ARROW_WITH_LZ4 ON)
+  set(ARROW_WITH_SNAPPY ON)
+  set(ARROW_WITH_ZSTD ON)
   set(ZLIB_SOURCE "SYSTEM")
   set(ARROW_VERBOSE_THIRDPARTY_BUILD OFF)
 
@@ -187,6 +191,16 @@ function(resolve_avro_dependency)
                                            ${avro-cpp_SOURCE_DIR}/lang/c++)
     endif()
 
+    # Expose the optional codecs that the vendored Avro library is built with.
+    get_directory_property(AVRO_COMPILE_DEFINITIONS
+                           DIRECTORY "${avro-cpp_SOURCE_DIR}/lang/c++"
+                           COMPILE_DEFINITIONS)
+    foreach(avro_codec_definition SNAPPY_CODEC_AVAILABLE ZSTD_CODEC_AVAILABLE)
+      if(avro_codec_definition IN_LIST AVRO_COMPILE_DEFINITIONS)
+        target_compile_definitions(avrocpp_s INTERFACE ${avro_codec_definition})
+      endif()
+    endforeach()
+
     set(AVRO_VENDORED TRUE)
     set_target_properties(avrocpp_s PROPERTIES OUTPUT_NAME "iceberg_vendored_avrocpp")
     set_target_properties(avrocpp_s PROPERTIES POSITION_INDEPENDENT_CODE ON)
@@ -22,6 +22,7 @@
 #include "iceberg/arrow/arrow_file_io.h"
 #include "iceberg/avro/avro_register.h"
 #include "iceberg/catalog/memory/in_memory_catalog.h"
+#include "iceberg/orc/orc_register.h"
 #include "iceberg/parquet/parquet_register.h"
 #include "iceberg/table.h"
 #include "iceberg/table_scan.h"
@@ -39,6 +40,7 @@ int main(int argc, char** argv) {
   const std::unordered_map<std::string, std::string> properties;
 
   iceberg::avro::RegisterAll();
+  iceberg::orc::RegisterAll();
   iceberg::parquet::RegisterAll();
 
   auto catalog = iceberg::InMemoryCatalog::Make("test", iceberg::arrow::MakeLocalFileIO(),
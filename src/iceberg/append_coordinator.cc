@@ -0,0 +1,179 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/append_coordinator.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "iceberg/fast_append.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/merge_append.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief The files of a producer and the promise of their commit.
+struct PendingAppend {
+  std::vector<std::shared_ptr<DataFile>> files;
+  std::promise<Status> promise;
+};
+
+std::future<Status> ReadyFuture(Status status) {
+  std::promise<Status> promise;
+  promise.set_value(std::move(status));
+  return promise.get_future();
+}
+
+}  // namespace
+
+class AppendCoordinator::Impl {
+ public:
+  Impl(std::shared_ptr<Table> table, Options options)
+      : table_(std::move(table)),
+        options_(options),
+        thread_([this]() { Run(); }) {}
+
+  ~Impl() {
+    {
+      std::lock_guard lock(mutex_);
+      stopped_ = true;
+    }
+    cv_.notify_all();
+  }
+
+  std::future<Status> Append(std::vector<std::shared_ptr<DataFile>> files) {
+    for (const auto& file : files) {
+      if (file == nullptr) {
+        return ReadyFuture(InvalidArgument("Cannot append null data file"));
+      }
+      if (file->content != DataFile::Content::kData) {
+        return ReadyFuture(
+            InvalidArgument("Cannot append delete file {} as a data file",
+                            file->file_path));
+      }
+    }
+    if (files.empty()) {
+      return ReadyFuture({});
+    }
+
+    PendingAppend append{.files = std::move(files)};
+    auto future = append.promise.get_future();
+    {
+      std::lock_guard lock(mutex_);
+      if (pending_.empty()) {
+        deadline_ = std::chrono::steady_clock::now() + options_.max_delay;
+      }
+      pending_files_ += static_cast<int64_t>(append.files.size());
+      pending_.push_back(std::move(append));
+    }
+    cv_.notify_all();
+    return future;
+  }
+
+  void Flush() {
+    {
+      std::lock_guard lock(mutex_);
+      flush_ = !pending_.empty();
+    }
+    cv_.notify_all();
+  }
+
+ private:
+  void Run() {
+    std::unique_lock lock(mutex_);
+    while (true) {
+      cv_.wait(lock, [&]() { return stopped_ || !pending_.empty(); });
+      if (pending_.empty()) {
+        return;
+      }
+      cv_.wait_until(lock, deadline_, [&]() {
+        return stopped_ || flush_ || pending_files_ >= options_.max_files;
+      });
+      auto group = std::exchange(pending_, {});
+      pending_files_ = 0;
+      flush_ = false;
+      lock.unlock();
+      Commit(group);
+      lock.lock();
+    }
+  }
+
+  /// \brief Commits the files of a group of producers as one append.
+  void Commit(std::vector<PendingAppend>& group) {
+    std::unique_ptr<FastAppend> append =
+        options_.merge_manifests ? std::make_unique<MergeAppend>(table_)
+                                 : std::make_unique<FastAppend>(table_);
+    for (const auto& pending : group) {
+      for (const auto& file : pending.files) {
+        append->AppendFile(file);
+      }
+    }
+    auto status = append->Commit();
+    for (auto& pending : group) {
+      pending.promise.set_value(status);
+    }
+  }
+
+  std::shared_ptr<Table> table_;
+  const Options options_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<PendingAppend> pending_;
+  int64_t pending_files_ = 0;
+  std::chrono::steady_clock::time_point deadline_;
+  bool flush_ = false;
+  bool stopped_ = false;
+  /// \brief Declared last, so that it starts once the other members are initialized.
+  std::jthread thread_;
+};
+
+Result<std::unique_ptr<AppendCoordinator>> AppendCoordinator::Make(
+    std::shared_ptr<Table> table, Options options) {
+  if (table == nullptr) {
+    return InvalidArgument("Table to append to must not be null");
+  }
+  if (options.max_delay.count() < 0) {
+    return InvalidArgument("Append delay must not be negative, got {}ms",
+                           options.max_delay.count());
+  }
+  if (options.max_files <= 0) {
+    return InvalidArgument("Maximum number of pending files must be positive, got {}",
+                           options.max_files);
+  }
+  return std::unique_ptr<AppendCoordinator>(new AppendCoordinator(
+      std::make_unique<Impl>(std::move(table), options)));
+}
+
+AppendCoordinator::AppendCoordinator(std::unique_ptr<Impl> impl)
+    : impl_(std::move(impl)) {}
+
+AppendCoordinator::~AppendCoordinator() = default;
+
+std::future<Status> AppendCoordinator::Append(
+    std::vector<std::shared_ptr<DataFile>> files) {
+  return impl_->Append(std::move(files));
+}
+
+void AppendCoordinator::Flush() { impl_->Flush(); }
+
+}  // namespace iceberg
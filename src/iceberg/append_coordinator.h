@@ -0,0 +1,98 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/append_coordinator.h
+/// Group commit of the appends of many producers to one table.
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief Coalesces the appends of many producers to a table into few snapshots.
+///
+/// Each commit writes new table metadata, and concurrent commits to the same table race
+/// each other and retry. Producers that append small batches of data files from many
+/// threads therefore hand them to a coordinator instead, whose own thread commits the
+/// files of all the producers received within `Options::max_delay` of the first one,
+/// or as soon as `Options::max_files` files are pending, as a single append. The files
+/// received while a commit is in progress go to the next one, so the number of commits
+/// does not grow with the number of producers.
+///
+/// Each producer gets a future completed with the status of the commit of its files.
+/// The files of a commit are all committed or none is, so a failed commit fails every
+/// producer of the group. Commits to the table from elsewhere are handled as concurrent
+/// commits by the retries of the append.
+class ICEBERG_EXPORT AppendCoordinator {
+ public:
+  /// \brief Configuration of the grouping of the appends.
+  struct Options {
+    /// \brief How long the first pending files wait for other producers before they
+    /// are committed. Zero commits the pending files as soon as the previous commit
+    /// completes.
+    std::chrono::milliseconds max_delay = std::chrono::milliseconds(50);
+    /// \brief The number of pending files that are committed without waiting for
+    /// `max_delay`, must be positive.
+    int64_t max_files = 1000;
+    /// \brief Whether to commit with a MergeAppend, which merges the small manifests
+    /// of the appends, instead of a FastAppend.
+    bool merge_manifests = true;
+  };
+
+  /// \brief Creates a coordinator of the appends to a table.
+  ///
+  /// \param table The table to append to, which must have a catalog to commit to
+  /// \param options The configuration of the grouping
+  /// \return A Result containing the coordinator, or an error if the options are
+  /// invalid.
+  static Result<std::unique_ptr<AppendCoordinator>> Make(std::shared_ptr<Table> table,
+                                                         Options options);
+
+  /// \brief Commits the pending files and waits for the commit to complete.
+  ~AppendCoordinator();
+
+  /// \brief Queues data files to append to the table. Thread-safe.
+  ///
+  /// \param files Data files of the partition specs with their partition_spec_id
+  /// \return A future completed with the status of the commit of the files, or at once
+  /// with an error if a file is not a data file.
+  std::future<Status> Append(std::vector<std::shared_ptr<DataFile>> files);
+
+  /// \brief Commits the pending files without waiting for `Options::max_delay`.
+  /// Thread-safe.
+  void Flush();
+
+ private:
+  class Impl;
+
+  explicit AppendCoordinator(std::unique_ptr<Impl> impl);
+
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace iceberg
@@ -0,0 +1,66 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/append_files.h
+/// API for appending new data files to a table.
+
+#include <memory>
+#include <string>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief API for appending new files in a table.
+///
+/// This API accumulates file additions, produces a new snapshot of the table, and
+/// commits that snapshot as the current snapshot of the main branch.
+///
+/// When committing, these changes will be applied to the latest table snapshot. Commit
+/// conflicts will be resolved by applying the changes to the new latest snapshot and
+/// reattempting the commit.
+class ICEBERG_EXPORT AppendFiles {
+ public:
+  virtual ~AppendFiles() = default;
+
+  /// \brief Append a data file to the table.
+  ///
+  /// \param file A data file of the partition spec with its partition_spec_id
+  /// \return Reference to this for method chaining
+  virtual AppendFiles& AppendFile(std::shared_ptr<DataFile> file) = 0;
+
+  /// \brief Set a summary property of the snapshot produced by this update.
+  ///
+  /// \param property The name of the summary property
+  /// \param value The value of the summary property
+  /// \return Reference to this for method chaining
+  virtual AppendFiles& Set(const std::string& property, const std::string& value) = 0;
+
+  /// \brief Apply the pending changes and commit them to the table.
+  ///
+  /// \return Status::OK if the changes were committed; ErrorKind::kCommitFailed if they
+  /// could not be committed because of concurrent changes, after retrying
+  virtual Status Commit() = 0;
+};
+
+}  // namespace iceberg
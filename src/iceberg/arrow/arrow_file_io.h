@@ -28,6 +28,9 @@ namespace iceberg::arrow {
 
 ICEBERG_BUNDLE_EXPORT std::unique_ptr<FileIO> MakeMockFileIO();
 
-ICEBERG_BUNDLE_EXPORT std::unique_ptr<FileIO> MakeLocalFileIO();
+/// \brief Make a FileIO of the local file system.
+///
+/// \param memory_map Whether input files are opened as memory-mapped files.
+ICEBERG_BUNDLE_EXPORT std::unique_ptr<FileIO> MakeLocalFileIO(bool memory_map = false);
 
 }  // namespace iceberg::arrow
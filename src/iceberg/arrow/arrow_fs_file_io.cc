@@ -17,20 +17,491 @@
  * under the License.
  */
 
+#include <algorithm>
+#include <charconv>
 #include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <format>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
+#include <arrow/buffer.h>
 #include <arrow/filesystem/localfs.h>
 #include <arrow/filesystem/mockfs.h>
+#include <arrow/util/future.h>
+#include <arrow/util/iterator.h>
+#include <arrow/util/thread_pool.h>
 
 #include "iceberg/arrow/arrow_file_io.h"
 #include "iceberg/arrow/arrow_fs_file_io_internal.h"
 #include "iceberg/arrow/arrow_status_internal.h"
+#include "iceberg/executor.h"
+#include "iceberg/file_writer.h"
+#include "iceberg/metrics_reporter.h"
+#include "iceberg/util/macros.h"
+#include "iceberg/util/read_ranges_internal.h"
+#include "iceberg/util/tracing.h"
+#include "iceberg/util/uuid.h"
 
 namespace iceberg::arrow {
 
+namespace {
+
+::arrow::fs::FileInfo MakeFileInfo(const std::string& file_location,
+                                   std::optional<size_t> length) {
+  ::arrow::fs::FileInfo file_info(file_location, ::arrow::fs::FileType::File);
+  if (length.has_value()) {
+    file_info.set_size(length.value());
+  }
+  return file_info;
+}
+
+/// \brief An input file of an Arrow file system.
+class ArrowInputFile : public InputFile {
+ public:
+  ArrowInputFile(std::string location,
+                 std::shared_ptr<::arrow::io::RandomAccessFile> file,
+                 ReadCoalescingOptions read_coalescing)
+      : location_(std::move(location)),
+        file_(std::move(file)),
+        read_coalescing_(read_coalescing) {}
+
+  const std::string& location() const override { return location_; }
+
+  Result<int64_t> Size() override {
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(auto size, file_->GetSize());
+    return size;
+  }
+
+  Result<int64_t> ReadAt(int64_t offset, std::span<uint8_t> out) override {
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(
+        auto read, file_->ReadAt(offset, static_cast<int64_t>(out.size()), out.data()));
+    return read;
+  }
+
+  // Close ranges are merged, and the merged ranges are read concurrently when the file
+  // system supports it.
+  Status ReadRanges(std::span<const ReadRange> ranges) override {
+    auto coalesced = CoalesceReadRanges(ranges, read_coalescing_);
+    std::vector<::arrow::io::ReadRange> arrow_ranges;
+    arrow_ranges.reserve(coalesced.size());
+    for (const auto& range : coalesced) {
+      arrow_ranges.push_back({.offset = range.offset, .length = range.length});
+    }
+    auto futures = file_->ReadManyAsync(arrow_ranges);
+    for (size_t i = 0; i < coalesced.size(); ++i) {
+      const auto& merged = coalesced[i];
+      ICEBERG_ARROW_ASSIGN_OR_RETURN(auto buffer, futures[i].result());
+      for (size_t index : merged.ranges) {
+        const auto& range = ranges[index];
+        const int64_t begin = range.offset - merged.offset;
+        if (begin + static_cast<int64_t>(range.out.size()) > buffer->size()) {
+          return IOError("Cannot read {} bytes at offset {} of file {}: end of file",
+                         range.out.size(), range.offset, location_);
+        }
+        std::memcpy(range.out.data(), buffer->data() + begin, range.out.size());
+      }
+    }
+    return {};
+  }
+
+  Status Close() override {
+    ICEBERG_ARROW_RETURN_NOT_OK(file_->Close());
+    return {};
+  }
+
+ private:
+  std::string location_;
+  std::shared_ptr<::arrow::io::RandomAccessFile> file_;
+  ReadCoalescingOptions read_coalescing_;
+};
+
+/// \brief An output file of an Arrow file system.
+class ArrowOutputFile : public OutputFile {
+ public:
+  ArrowOutputFile(std::string location, std::shared_ptr<::arrow::io::OutputStream> file)
+      : location_(std::move(location)), file_(std::move(file)) {}
+
+  const std::string& location() const override { return location_; }
+
+  Status Write(std::string_view data) override {
+    ICEBERG_ARROW_RETURN_NOT_OK(file_->Write(data.data(), data.size()));
+    return {};
+  }
+
+  Result<int64_t> Position() const override {
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(auto position, file_->Tell());
+    return position;
+  }
+
+  Status Flush() override {
+    ICEBERG_ARROW_RETURN_NOT_OK(file_->Flush());
+    return {};
+  }
+
+  Status Close() override {
+    ICEBERG_ARROW_RETURN_NOT_OK(file_->Close());
+    return {};
+  }
+
+ private:
+  std::string location_;
+  std::shared_ptr<::arrow::io::OutputStream> file_;
+};
+
+/// \brief An Arrow random access file reading an InputFile.
+class InputFileAdapter : public ::arrow::io::RandomAccessFile {
+ public:
+  explicit InputFileAdapter(std::unique_ptr<InputFile> file) : file_(std::move(file)) {}
+
+  ::arrow::Status Close() override {
+    if (closed_) {
+      return ::arrow::Status::OK();
+    }
+    closed_ = true;
+    return ToArrowStatus(file_->Close());
+  }
+
+  bool closed() const override { return closed_; }
+
+  ::arrow::Result<int64_t> Tell() const override { return position_; }
+
+  ::arrow::Status Seek(int64_t position) override {
+    if (position < 0) {
+      return ::arrow::Status::Invalid("Cannot seek to negative position ", position);
+    }
+    position_ = position;
+    return ::arrow::Status::OK();
+  }
+
+  ::arrow::Result<int64_t> GetSize() override {
+    auto size = file_->Size();
+    if (!size.has_value()) {
+      return ToArrowStatus(size.error());
+    }
+    return size.value();
+  }
+
+  ::arrow::Result<int64_t> Read(int64_t nbytes, void* out) override {
+    ARROW_ASSIGN_OR_RAISE(auto read, ReadAt(position_, nbytes, out));
+    position_ += read;
+    return read;
+  }
+
+  ::arrow::Result<std::shared_ptr<::arrow::Buffer>> Read(int64_t nbytes) override {
+    ARROW_ASSIGN_OR_RAISE(auto buffer, ReadAt(position_, nbytes));
+    position_ += buffer->size();
+    return buffer;
+  }
+
+  ::arrow::Result<int64_t> ReadAt(int64_t position, int64_t nbytes, void* out) override {
+    if (closed_) {
+      return ::arrow::Status::Invalid("Operation on closed file");
+    }
+    auto read = file_->ReadAt(
+        position, {static_cast<uint8_t*>(out), static_cast<size_t>(nbytes)});
+    if (!read.has_value()) {
+      return ToArrowStatus(read.error());
+    }
+    return read.value();
+  }
+
+  ::arrow::Result<std::shared_ptr<::arrow::Buffer>> ReadAt(int64_t position,
+                                                           int64_t nbytes) override {
+    ARROW_ASSIGN_OR_RAISE(auto buffer, ::arrow::AllocateResizableBuffer(nbytes));
+    ARROW_ASSIGN_OR_RAISE(auto read, ReadAt(position, nbytes, buffer->mutable_data()));
+    if (read < nbytes) {
+      ARROW_RETURN_NOT_OK(buffer->Resize(read));
+    }
+    return std::shared_ptr<::arrow::Buffer>(std::move(buffer));
+  }
+
+ private:
+  std::unique_ptr<InputFile> file_;
+  int64_t position_ = 0;
+  bool closed_ = false;
+};
+
+/// \brief An Arrow output stream writing an OutputFile.
+class OutputFileAdapter : public ::arrow::io::OutputStream {
+ public:
+  explicit OutputFileAdapter(std::unique_ptr<OutputFile> file) : file_(std::move(file)) {}
+
+  ::arrow::Status Close() override {
+    if (closed_) {
+      return ::arrow::Status::OK();
+    }
+    closed_ = true;
+    return ToArrowStatus(file_->Close());
+  }
+
+  bool closed() const override { return closed_; }
+
+  ::arrow::Result<int64_t> Tell() const override {
+    auto position = file_->Position();
+    if (!position.has_value()) {
+      return ToArrowStatus(position.error());
+    }
+    return position.value();
+  }
+
+  ::arrow::Status Write(const void* data, int64_t nbytes) override {
+    if (closed_) {
+      return ::arrow::Status::Invalid("Operation on closed file");
+    }
+    return ToArrowStatus(
+        file_->Write({static_cast<const char*>(data), static_cast<size_t>(nbytes)}));
+  }
+
+  ::arrow::Status Flush() override { return ToArrowStatus(file_->Flush()); }
+
+ private:
+  std::unique_ptr<OutputFile> file_;
+  bool closed_ = false;
+};
+
+/// \brief An Arrow output stream writing the bytes written to it to another stream in
+/// the background, in parts of a given size.
+///
+/// The parts are written in order by one thread at a time, on the executor, or by the
+/// writing thread when it waits for the parts to be written while no thread writes
+/// them. Close() waits for all parts. Errors are returned by the next operations on
+/// the stream.
+class BackgroundUploadStream : public ::arrow::io::OutputStream {
+ public:
+  BackgroundUploadStream(std::shared_ptr<::arrow::io::OutputStream> sink,
+                         int64_t part_size, int32_t parts_in_flight,
+                         std::shared_ptr<Executor> executor)
+      : state_(std::make_shared<State>()),
+        part_size_(part_size),
+        parts_in_flight_(parts_in_flight),
+        executor_(std::move(executor)) {
+    state_->sink = std::move(sink);
+    part_.reserve(static_cast<size_t>(part_size_));
+  }
+
+  ::arrow::Status Close() override {
+    if (closed_) {
+      return ::arrow::Status::OK();
+    }
+    closed_ = true;
+    auto status = Wait();
+    auto close_status = state_->sink->Close();
+    return status.ok() ? close_status : status;
+  }
+
+  bool closed() const override { return closed_; }
+
+  ::arrow::Result<int64_t> Tell() const override { return position_; }
+
+  ::arrow::Status Write(const void* data, int64_t nbytes) override {
+    if (closed_) {
+      return ::arrow::Status::Invalid("Operation on closed file");
+    }
+    const auto* bytes = static_cast<const char*>(data);
+    while (nbytes > 0) {
+      const int64_t length =
+          std::min(nbytes, part_size_ - static_cast<int64_t>(part_.size()));
+      part_.append(bytes, static_cast<size_t>(length));
+      bytes += length;
+      nbytes -= length;
+      position_ += length;
+      if (static_cast<int64_t>(part_.size()) == part_size_) {
+        ARROW_RETURN_NOT_OK(Enqueue());
+      }
+    }
+    return ::arrow::Status::OK();
+  }
+
+  // Writers flush their stream after each block, so the parts are not waited for, but
+  // only on Close().
+  ::arrow::Status Flush() override {
+    std::lock_guard lock(state_->mutex);
+    return state_->status;
+  }
+
+ private:
+  struct State {
+    std::shared_ptr<::arrow::io::OutputStream> sink;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::string> parts;
+    // The number of parts queued or being written.
+    int32_t pending = 0;
+    // Whether a thread is writing the queued parts.
+    bool writing = false;
+    // Whether a task writing the queued parts was submitted and has not started.
+    bool scheduled = false;
+    ::arrow::Status status;
+  };
+
+  // Writes the queued parts to the sink until none is left, unless another thread
+  // already does.
+  static void WriteParts(State& state, std::unique_lock<std::mutex>& lock) {
+    if (state.writing) {
+      return;
+    }
+    state.writing = true;
+    while (!state.parts.empty()) {
+      auto part = std::move(state.parts.front());
+      state.parts.pop_front();
+      const bool failed = !state.status.ok();
+      lock.unlock();
+      // The parts after an error are dropped.
+      auto status = failed ? ::arrow::Status::OK()
+                           : state.sink->Write(part.data(),
+                                               static_cast<int64_t>(part.size()));
+      lock.lock();
+      if (!status.ok() && state.status.ok()) {
+        state.status = std::move(status);
+      }
+      --state.pending;
+      state.cv.notify_all();
+    }
+    state.writing = false;
+    state.cv.notify_all();
+  }
+
+  // Queues the current part, waiting while `parts_in_flight_` parts are pending.
+  ::arrow::Status Enqueue() {
+    std::unique_lock lock(state_->mutex);
+    while (state_->pending >= parts_in_flight_) {
+      if (state_->writing) {
+        state_->cv.wait(lock);
+      } else {
+        // The submitted task has not started, so this thread writes the parts.
+        WriteParts(*state_, lock);
+      }
+    }
+    ARROW_RETURN_NOT_OK(state_->status);
+    state_->parts.push_back(std::move(part_));
+    ++state_->pending;
+    part_ = std::string();
+    part_.reserve(static_cast<size_t>(part_size_));
+    if (!state_->writing && !state_->scheduled) {
+      state_->scheduled = true;
+      lock.unlock();
+      executor_->Submit([state = state_]() {
+        std::unique_lock lock(state->mutex);
+        state->scheduled = false;
+        WriteParts(*state, lock);
+      });
+    }
+    return ::arrow::Status::OK();
+  }
+
+  // Queues the current part and waits until all parts are written.
+  ::arrow::Status Wait() {
+    if (!part_.empty()) {
+      ARROW_RETURN_NOT_OK(Enqueue());
+    }
+    std::unique_lock lock(state_->mutex);
+    while (state_->pending > 0) {
+      if (state_->writing) {
+        state_->cv.wait(lock);
+      } else {
+        WriteParts(*state_, lock);
+      }
+    }
+    return state_->status;
+  }
+
+  // Shared with the tasks writing the parts, which may outlive the stream.
+  std::shared_ptr<State> state_;
+  const int64_t part_size_;
+  const int32_t parts_in_flight_;
+  std::shared_ptr<Executor> executor_;
+  // The bytes of the part being filled.
+  std::string part_;
+  int64_t position_ = 0;
+  bool closed_ = false;
+};
+
+/// \brief Returns the positive number of a writer property, or `default_value` if it
+/// is not set.
+template <typename T>
+Result<T> ParsePositiveProperty(
+    const std::unordered_map<std::string, std::string>& properties,
+    std::string_view key, T default_value) {
+  auto it = properties.find(std::string(key));
+  if (it == properties.cend()) {
+    return default_value;
+  }
+  const auto& value = it->second;
+  T number = 0;
+  auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), number);
+  if (ec != std::errc() || end != value.data() + value.size() || number <= 0) {
+    return InvalidArgument("Invalid {}: {}, expected a positive integer", key, value);
+  }
+  return number;
+}
+
+/// \brief An Arrow random access file counting the bytes read from another one and
+/// the time spent reading them.
+class MeteredInputFile : public ::arrow::io::RandomAccessFile {
+ public:
+  MeteredInputFile(std::shared_ptr<::arrow::io::RandomAccessFile> file,
+                   std::shared_ptr<ReadMetrics> metrics)
+      : file_(std::move(file)), metrics_(std::move(metrics)) {}
+
+  ::arrow::Status Close() override { return file_->Close(); }
+
+  bool closed() const override { return file_->closed(); }
+
+  bool supports_zero_copy() const override { return file_->supports_zero_copy(); }
+
+  ::arrow::Result<int64_t> Tell() const override { return file_->Tell(); }
+
+  ::arrow::Status Seek(int64_t position) override { return file_->Seek(position); }
+
+  ::arrow::Result<int64_t> GetSize() override { return file_->GetSize(); }
+
+  ::arrow::Result<int64_t> Read(int64_t nbytes, void* out) override {
+    auto timed = metrics_->io_duration.Start();
+    ARROW_ASSIGN_OR_RAISE(auto read, file_->Read(nbytes, out));
+    metrics_->bytes_read.Increment(read);
+    return read;
+  }
+
+  ::arrow::Result<std::shared_ptr<::arrow::Buffer>> Read(int64_t nbytes) override {
+    auto timed = metrics_->io_duration.Start();
+    ARROW_ASSIGN_OR_RAISE(auto buffer, file_->Read(nbytes));
+    metrics_->bytes_read.Increment(buffer->size());
+    return buffer;
+  }
+
+  ::arrow::Result<int64_t> ReadAt(int64_t position, int64_t nbytes, void* out) override {
+    auto timed = metrics_->io_duration.Start();
+    ARROW_ASSIGN_OR_RAISE(auto read, file_->ReadAt(position, nbytes, out));
+    metrics_->bytes_read.Increment(read);
+    return read;
+  }
+
+  ::arrow::Result<std::shared_ptr<::arrow::Buffer>> ReadAt(int64_t position,
+                                                           int64_t nbytes) override {
+    auto timed = metrics_->io_duration.Start();
+    ARROW_ASSIGN_OR_RAISE(auto buffer, file_->ReadAt(position, nbytes));
+    metrics_->bytes_read.Increment(buffer->size());
+    return buffer;
+  }
+
+ private:
+  std::shared_ptr<::arrow::io::RandomAccessFile> file_;
+  std::shared_ptr<ReadMetrics> metrics_;
+};
+
+}  // namespace
+
 /// \brief Read the content of the file at the given location.
 Result<std::string> ArrowFileSystemFileIO::ReadFile(const std::string& file_location,
                                                     std::optional<size_t> length) {
+  ICEBERG_TRACE_SCOPE(trace, "FileIO::ReadFile");
+  ICEBERG_TRACE_ATTRIBUTE(trace, "path", file_location);
   ::arrow::fs::FileInfo file_info(file_location);
   if (length.has_value()) {
     file_info.set_size(length.value());
@@ -50,6 +521,7 @@ Result<std::string> ArrowFileSystemFileIO::ReadFile(const std::string& file_loca
     remain -= read_bytes;
     offset += read_bytes;
   }
+  ICEBERG_TRACE_ATTRIBUTE(trace, "bytes", static_cast<int64_t>(content.size()));
 
   return content;
 }
@@ -64,29 +536,202 @@ Status ArrowFileSystemFileIO::WriteFile(const std::string& file_location,
   return {};
 }
 
+Status ArrowFileSystemFileIO::WriteFileIfAbsent(const std::string& file_location,
+                                                std::string_view content) {
+  if (arrow_fs_->type_name() != "local") {
+    return NotSupported("Cannot write {} if absent, the {} file system has no atomic "
+                        "conditional writes",
+                        file_location, arrow_fs_->type_name());
+  }
+  std::string path = file_location;
+  if (file_location.find("://") != std::string::npos) {
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(path, arrow_fs_->PathFromUri(file_location));
+  }
+  const std::filesystem::path target(path);
+  std::error_code error;
+  std::filesystem::create_directories(target.parent_path(), error);
+  if (error) {
+    return IOError("Cannot create the directory of {}: {}", file_location,
+                   error.message());
+  }
+
+  // The temporary file is complete before it is linked, so readers never see a partly
+  // written file at the location.
+  const auto temp_path = std::format("{}.{}.tmp", path, Uuid::GenerateV4().ToString());
+  ICEBERG_RETURN_UNEXPECTED(WriteFile(temp_path, content));
+  std::filesystem::create_hard_link(temp_path, target, error);
+  std::error_code remove_error;
+  std::filesystem::remove(temp_path, remove_error);
+  if (error == std::errc::file_exists) {
+    return AlreadyExists("File {} already exists", file_location);
+  }
+  if (error) {
+    return IOError("Cannot write {}: {}", file_location, error.message());
+  }
+  return {};
+}
+
+Result<bool> ArrowFileSystemFileIO::FileExists(const std::string& file_location) {
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(auto file_info, arrow_fs_->GetFileInfo(file_location));
+  return file_info.IsFile();
+}
+
+Result<std::unique_ptr<InputFile>> ArrowFileSystemFileIO::NewInputFile(
+    const std::string& file_location, std::optional<size_t> length) {
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(
+      auto file, arrow_fs_->OpenInputFile(MakeFileInfo(file_location, length)));
+  return std::make_unique<ArrowInputFile>(file_location, std::move(file),
+                                          read_coalescing_);
+}
+
+Result<std::unique_ptr<OutputFile>> ArrowFileSystemFileIO::NewOutputFile(
+    const std::string& file_location) {
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(auto file, arrow_fs_->OpenOutputStream(file_location));
+  return std::make_unique<ArrowOutputFile>(file_location, std::move(file));
+}
+
 /// \brief Delete a file at the given location.
 Status ArrowFileSystemFileIO::DeleteFile(const std::string& file_location) {
   ICEBERG_ARROW_RETURN_NOT_OK(arrow_fs_->DeleteFile(file_location));
   return {};
 }
 
+std::vector<FileDeleteFailure> ArrowFileSystemFileIO::DeleteFiles(
+    std::span<const std::string> file_locations) {
+  std::vector<FileDeleteFailure> failures;
+  auto* executor = arrow_fs_->io_context().executor();
+  std::vector<::arrow::Future<>> deletes;
+  for (size_t begin = 0; begin < file_locations.size(); begin += kDeleteBatchSize) {
+    const auto batch = file_locations.subspan(
+        begin, std::min(kDeleteBatchSize, file_locations.size() - begin));
+    deletes.clear();
+    for (const auto& file_location : batch) {
+      auto submitted = executor->Submit(
+          [this, &file_location]() { return arrow_fs_->DeleteFile(file_location); });
+      deletes.push_back(submitted.ok() ? std::move(submitted).ValueOrDie()
+                                       : ::arrow::Future<>::MakeFinished(
+                                             submitted.status()));
+    }
+    for (size_t i = 0; i < batch.size(); ++i) {
+      const auto& status = deletes[i].status();
+      if (!status.ok()) {
+        failures.push_back(
+            {.file_location = batch[i],
+             .error = {.kind = ToErrorKind(status), .message = status.ToString()}});
+      }
+    }
+  }
+  return failures;
+}
+
+Status ArrowFileSystemFileIO::ListFiles(
+    const std::string& prefix, const std::function<Status(const FileInfo&)>& visitor) {
+  ::arrow::fs::FileSelector selector;
+  selector.base_dir = prefix;
+  selector.allow_not_found = true;
+  selector.recursive = true;
+  // Object stores list the paths of the files without the scheme of the prefix.
+  std::string_view scheme;
+  if (auto pos = prefix.find("://"); pos != std::string::npos) {
+    scheme = std::string_view(prefix).substr(0, pos + 3);
+  }
+
+  auto generator = arrow_fs_->GetFileInfoGenerator(selector);
+  while (true) {
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(auto file_infos, generator().result());
+    if (::arrow::IsIterationEnd(file_infos)) {
+      break;
+    }
+    for (const auto& file_info : file_infos) {
+      if (!file_info.IsFile()) {
+        continue;
+      }
+      const auto& path = file_info.path();
+      FileInfo file{
+          .location = scheme.empty() || path.starts_with(scheme)
+                          ? path
+                          : std::string(scheme) + path,
+          .size = file_info.size(),
+          .last_modified =
+              std::chrono::time_point_cast<std::chrono::milliseconds>(file_info.mtime()),
+      };
+      ICEBERG_RETURN_UNEXPECTED(visitor(file));
+    }
+  }
+  return {};
+}
+
 std::unique_ptr<FileIO> ArrowFileSystemFileIO::MakeMockFileIO() {
   return std::make_unique<ArrowFileSystemFileIO>(
       std::make_shared<::arrow::fs::internal::MockFileSystem>(
           std::chrono::system_clock::now()));
 }
 
-std::unique_ptr<FileIO> ArrowFileSystemFileIO::MakeLocalFileIO() {
+std::unique_ptr<FileIO> ArrowFileSystemFileIO::MakeLocalFileIO(bool memory_map) {
+  auto options = ::arrow::fs::LocalFileSystemOptions::Defaults();
+  options.use_mmap = memory_map;
   return std::make_unique<ArrowFileSystemFileIO>(
-      std::make_shared<::arrow::fs::LocalFileSystem>());
+      std::make_shared<::arrow::fs::LocalFileSystem>(options));
+}
+
+Result<std::shared_ptr<::arrow::io::RandomAccessFile>> OpenArrowInputFile(
+    const std::shared_ptr<FileIO>& io, const std::string& file_location,
+    std::optional<size_t> length, std::shared_ptr<ReadMetrics> metrics) {
+  if (io == nullptr) {
+    return InvalidArgument("FileIO is required to read {}", file_location);
+  }
+  std::shared_ptr<::arrow::io::RandomAccessFile> file;
+  if (auto* arrow_io = dynamic_cast<ArrowFileSystemFileIO*>(io.get())) {
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(
+        file, arrow_io->fs()->OpenInputFile(MakeFileInfo(file_location, length)));
+  } else {
+    ICEBERG_ASSIGN_OR_RAISE(auto input_file, io->NewInputFile(file_location, length));
+    file = std::make_shared<InputFileAdapter>(std::move(input_file));
+  }
+  if (metrics != nullptr) {
+    return std::make_shared<MeteredInputFile>(std::move(file), std::move(metrics));
+  }
+  return file;
+}
+
+Result<std::shared_ptr<::arrow::io::OutputStream>> OpenArrowOutputStream(
+    const std::shared_ptr<FileIO>& io, const std::string& file_location) {
+  if (io == nullptr) {
+    return InvalidArgument("FileIO is required to write {}", file_location);
+  }
+  if (auto* arrow_io = dynamic_cast<ArrowFileSystemFileIO*>(io.get())) {
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(auto file,
+                                   arrow_io->fs()->OpenOutputStream(file_location));
+    return file;
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto file, io->NewOutputFile(file_location));
+  return std::make_shared<OutputFileAdapter>(std::move(file));
+}
+
+Result<std::shared_ptr<::arrow::io::OutputStream>> OpenArrowOutputStream(
+    const WriterOptions& options) {
+  ICEBERG_ASSIGN_OR_RAISE(auto parts_in_flight,
+                          ParsePositiveProperty<int32_t>(
+                              options.properties,
+                              WriterOptions::kUploadPartsInFlightProperty, 0));
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto part_size, ParsePositiveProperty<int64_t>(
+                          options.properties, WriterOptions::kUploadPartSizeProperty,
+                          WriterOptions::kDefaultUploadPartSize));
+  ICEBERG_ASSIGN_OR_RAISE(auto file, OpenArrowOutputStream(options.io, options.path));
+  if (parts_in_flight == 0) {
+    return file;
+  }
+  return std::make_shared<BackgroundUploadStream>(std::move(file), part_size,
+                                                  parts_in_flight, DefaultExecutor());
 }
 
 std::unique_ptr<FileIO> MakeMockFileIO() {
   return ArrowFileSystemFileIO::MakeMockFileIO();
 }
 
-std::unique_ptr<FileIO> MakeLocalFileIO() {
-  return ArrowFileSystemFileIO::MakeLocalFileIO();
+std::unique_ptr<FileIO> MakeLocalFileIO(bool memory_map) {
+  return ArrowFileSystemFileIO::MakeLocalFileIO(memory_map);
 }
 
 }  // namespace iceberg::arrow
@@ -19,26 +19,42 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
 
 #include <arrow/filesystem/filesystem.h>
+#include <arrow/io/interfaces.h>
 
 #include "iceberg/file_io.h"
 #include "iceberg/iceberg_bundle_export.h"
+#include "iceberg/type_fwd.h"
 
 namespace iceberg::arrow {
 
 /// \brief A concrete implementation of FileIO for Arrow file system.
 class ICEBERG_BUNDLE_EXPORT ArrowFileSystemFileIO : public FileIO {
  public:
-  explicit ArrowFileSystemFileIO(std::shared_ptr<::arrow::fs::FileSystem> arrow_fs)
-      : arrow_fs_(std::move(arrow_fs)) {}
+  /// \brief Constructs a FileIO of an Arrow file system.
+  ///
+  /// \param arrow_fs The Arrow file system.
+  /// \param read_coalescing How the ranges of vectored reads of the input files are
+  /// merged. The merged ranges are read concurrently.
+  explicit ArrowFileSystemFileIO(std::shared_ptr<::arrow::fs::FileSystem> arrow_fs,
+                                 ReadCoalescingOptions read_coalescing = {})
+      : arrow_fs_(std::move(arrow_fs)), read_coalescing_(read_coalescing) {}
 
   /// \brief Make an in-memory FileIO backed by arrow::fs::internal::MockFileSystem.
   static std::unique_ptr<FileIO> MakeMockFileIO();
 
   /// \brief Make a local FileIO backed by arrow::fs::LocalFileSystem.
-  static std::unique_ptr<FileIO> MakeLocalFileIO();
+  ///
+  /// \param memory_map Whether input files are opened as memory-mapped files, so that
+  /// readers get slices of the mapping instead of copies read with system calls.
+  static std::unique_ptr<FileIO> MakeLocalFileIO(bool memory_map = false);
 
   ~ArrowFileSystemFileIO() override = default;
 
@@ -49,14 +65,90 @@ class ICEBERG_BUNDLE_EXPORT ArrowFileSystemFileIO : public FileIO {
   /// \brief Write the given content to the file at the given location.
   Status WriteFile(const std::string& file_location, std::string_view content) override;
 
+  /// \brief Write the given content to a new file, unless a file exists at the location.
+  ///
+  /// Only the local file system is supported: the content is written to a temporary
+  /// file, which is then hard linked to the location, as linking fails when the
+  /// location exists. Other file systems return ErrorKind::kNotSupported, as Arrow file
+  /// systems have no conditional writes.
+  Status WriteFileIfAbsent(const std::string& file_location,
+                           std::string_view content) override;
+
+  /// \brief Check whether a file exists at the given location.
+  Result<bool> FileExists(const std::string& file_location) override;
+
+  /// \brief Opens the file at the given location for positional reads.
+  Result<std::unique_ptr<InputFile>> NewInputFile(const std::string& file_location,
+                                                  std::optional<size_t> length) override;
+
+  /// \brief Opens the file at the given location for streaming writes.
+  Result<std::unique_ptr<OutputFile>> NewOutputFile(
+      const std::string& file_location) override;
+
   /// \brief Delete a file at the given location.
   Status DeleteFile(const std::string& file_location) override;
 
+  /// \brief Delete the files at the given locations.
+  ///
+  /// The files are deleted concurrently on the IO executor of the file system, in
+  /// batches of at most kDeleteBatchSize files.
+  std::vector<FileDeleteFailure> DeleteFiles(
+      std::span<const std::string> file_locations) override;
+
+  /// \brief The maximum number of files deleted concurrently by DeleteFiles, which is
+  /// also the maximum number of keys of a bulk delete request of object stores.
+  static constexpr size_t kDeleteBatchSize = 1000;
+
+  /// \brief Lists the files under a location, recursively.
+  ///
+  /// The files are listed with a recursive FileSelector, whose results are streamed
+  /// one batch at a time.
+  Status ListFiles(const std::string& prefix,
+                   const std::function<Status(const FileInfo&)>& visitor) override;
+
   /// \brief Get the Arrow file system.
   const std::shared_ptr<::arrow::fs::FileSystem>& fs() const { return arrow_fs_; }
 
+  /// \brief How the ranges of vectored reads are merged.
+  const ReadCoalescingOptions& read_coalescing() const { return read_coalescing_; }
+
  private:
   std::shared_ptr<::arrow::fs::FileSystem> arrow_fs_;
+  ReadCoalescingOptions read_coalescing_;
 };
 
+/// \brief Opens a file of a FileIO as an Arrow random access file.
+///
+/// Files of an ArrowFileSystemFileIO are opened with its Arrow file system, and files
+/// of other FileIO implementations are read through their InputFile.
+///
+/// \param io The FileIO of the file.
+/// \param file_location The location of the file to read.
+/// \param length The length of the file if known.
+/// \param metrics Receives the bytes read from the file and the time spent reading
+/// them, or null to not count them.
+ICEBERG_BUNDLE_EXPORT Result<std::shared_ptr<::arrow::io::RandomAccessFile>>
+OpenArrowInputFile(const std::shared_ptr<FileIO>& io, const std::string& file_location,
+                   std::optional<size_t> length,
+                   std::shared_ptr<ReadMetrics> metrics = nullptr);
+
+/// \brief Opens a file of a FileIO as an Arrow output stream.
+///
+/// Files of an ArrowFileSystemFileIO are opened with its Arrow file system, and files
+/// of other FileIO implementations are written through their OutputFile.
+///
+/// \param io The FileIO of the file.
+/// \param file_location The location of the file to write.
+ICEBERG_BUNDLE_EXPORT Result<std::shared_ptr<::arrow::io::OutputStream>>
+OpenArrowOutputStream(const std::shared_ptr<FileIO>& io,
+                      const std::string& file_location);
+
+/// \brief Opens the file of a writer as an Arrow output stream.
+///
+/// The file is opened with OpenArrowOutputStream(). When the writer properties set
+/// WriterOptions::kUploadPartsInFlightProperty, the bytes written to the stream are
+/// written to the file in the background, one part after the other.
+ICEBERG_BUNDLE_EXPORT Result<std::shared_ptr<::arrow::io::OutputStream>>
+OpenArrowOutputStream(const WriterOptions& options);
+
 }  // namespace iceberg::arrow
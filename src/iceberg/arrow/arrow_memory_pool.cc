@@ -0,0 +1,88 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "iceberg/arrow/arrow_memory_pool_internal.h"
+#include "iceberg/arrow/arrow_status_internal.h"
+
+namespace iceberg::arrow {
+
+namespace {
+
+/// \brief An Arrow memory pool forwarding to an iceberg memory pool.
+class ArrowMemoryPoolAdapter : public ::arrow::MemoryPool {
+ public:
+  explicit ArrowMemoryPoolAdapter(iceberg::MemoryPool* pool) : pool_(pool) {}
+
+  using ::arrow::MemoryPool::Allocate;
+  using ::arrow::MemoryPool::Free;
+  using ::arrow::MemoryPool::Reallocate;
+
+  ::arrow::Status Allocate(int64_t size, int64_t alignment, uint8_t** out) override {
+    return ToArrowStatus(pool_->Allocate(size, alignment, out));
+  }
+
+  ::arrow::Status Reallocate(int64_t old_size, int64_t new_size, int64_t alignment,
+                             uint8_t** ptr) override {
+    return ToArrowStatus(pool_->Reallocate(old_size, new_size, alignment, ptr));
+  }
+
+  void Free(uint8_t* buffer, int64_t size, int64_t alignment) override {
+    pool_->Free(buffer, size, alignment);
+  }
+
+  int64_t bytes_allocated() const override { return pool_->bytes_allocated(); }
+
+  int64_t max_memory() const override { return pool_->max_memory(); }
+
+  int64_t total_bytes_allocated() const override {
+    return pool_->total_bytes_allocated();
+  }
+
+  int64_t num_allocations() const override { return pool_->num_allocations(); }
+
+  std::string backend_name() const override { return "iceberg"; }
+
+ private:
+  iceberg::MemoryPool* pool_;
+};
+
+}  // namespace
+
+::arrow::MemoryPool* ToArrowMemoryPool(const std::shared_ptr<MemoryPool>& pool) {
+  if (pool == nullptr) {
+    return ::arrow::default_memory_pool();
+  }
+  static std::mutex mutex;
+  // An adapter only holds the address of its pool, so the adapter of a destroyed pool
+  // is reused as is by a pool allocated at the same address.
+  static std::unordered_map<MemoryPool*, std::unique_ptr<ArrowMemoryPoolAdapter>>
+      adapters;
+  std::lock_guard lock(mutex);
+  auto& adapter = adapters[pool.get()];
+  if (adapter == nullptr) {
+    adapter = std::make_unique<ArrowMemoryPoolAdapter>(pool.get());
+  }
+  return adapter.get();
+}
+
+}  // namespace iceberg::arrow
@@ -0,0 +1,40 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include <arrow/memory_pool.h>
+
+#include "iceberg/memory_pool.h"
+
+namespace iceberg::arrow {
+
+/// \brief Returns an Arrow memory pool allocating from `pool`, or the default Arrow
+/// memory pool if `pool` is null.
+///
+/// Arrow buffers keep a raw pointer to the pool they were allocated from, which must
+/// outlive them, including the buffers of the arrays exported to the C data interface.
+/// The Arrow pool of each iceberg pool is therefore created once and kept for the
+/// lifetime of the process, while the iceberg pool itself must outlive the buffers as
+/// documented by MemoryPool.
+::arrow::MemoryPool* ToArrowMemoryPool(const std::shared_ptr<MemoryPool>& pool);
+
+}  // namespace iceberg::arrow
@@ -0,0 +1,376 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <algorithm>
+#include <variant>
+
+#include <arrow/array.h>
+#include <arrow/buffer.h>
+#include <arrow/c/bridge.h>
+#include <arrow/compute/api.h>
+#include <arrow/extension_type.h>
+#include <arrow/record_batch.h>
+#include <arrow/scalar.h>
+#include <arrow/type.h>
+
+#include "iceberg/arrow/arrow_metadata_columns_internal.h"
+#include "iceberg/arrow/arrow_status_internal.h"
+#include "iceberg/metadata_columns.h"
+#include "iceberg/schema.h"
+#include "iceberg/schema_internal.h"
+#include "iceberg/type.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/conversion_cache_internal.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg::arrow {
+
+namespace {
+
+/// \brief Returns the positions of the rows plus an offset as an int64 array.
+Result<std::shared_ptr<::arrow::Array>> MakePositionArray(
+    std::span<const std::pair<int64_t, int64_t>> positions, int64_t length,
+    int64_t offset, ::arrow::MemoryPool* pool) {
+  int64_t num_positions = 0;
+  for (const auto& [begin, end] : positions) {
+    num_positions += end - begin;
+  }
+  if (num_positions != length) {
+    return Invalid("Expected the positions of {} rows, got {}", length, num_positions);
+  }
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(
+      std::shared_ptr<::arrow::Buffer> buffer,
+      ::arrow::AllocateBuffer(length * static_cast<int64_t>(sizeof(int64_t)), pool));
+  auto* values = reinterpret_cast<int64_t*>(buffer->mutable_data());
+  for (const auto& [begin, end] : positions) {
+    for (int64_t position = begin; position < end; ++position) {
+      *values++ = position + offset;
+    }
+  }
+  return std::make_shared<::arrow::Int64Array>(length, std::move(buffer));
+}
+
+/// \brief Returns the _file column, a dictionary of the file path if its type is a
+/// dictionary.
+Result<std::shared_ptr<::arrow::Array>> MakeFilePathArray(
+    const std::string& file_path, const std::shared_ptr<::arrow::DataType>& type,
+    int64_t length, ::arrow::MemoryPool* pool) {
+  if (type->id() != ::arrow::Type::DICTIONARY) {
+    return MakeConstantArray(Literal::String(file_path), type, length, pool);
+  }
+  const auto& dictionary_type =
+      internal::checked_cast<const ::arrow::DictionaryType&>(*type);
+  ICEBERG_ASSIGN_OR_RAISE(auto dictionary,
+                          MakeConstantArray(Literal::String(file_path),
+                                            dictionary_type.value_type(), 1, pool));
+  ICEBERG_ASSIGN_OR_RAISE(auto indices,
+                          MakeConstantArray(Literal::Int(0), dictionary_type.index_type(),
+                                            length, pool));
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(
+      auto array, ::arrow::DictionaryArray::FromArrays(type, indices, dictionary));
+  return array;
+}
+
+/// \brief Returns the _partition column of the partition values of the file.
+Result<std::shared_ptr<::arrow::Array>> MakePartitionArray(
+    const StructType& partition_type, const MetadataColumnValues& values,
+    const std::shared_ptr<::arrow::DataType>& type, int64_t length,
+    ::arrow::MemoryPool* pool) {
+  const auto& fields = partition_type.fields();
+  if (type->id() != ::arrow::Type::STRUCT ||
+      static_cast<size_t>(type->num_fields()) != fields.size()) {
+    return InvalidSchema("Unexpected Arrow type of the _partition column: {}",
+                         type->ToString());
+  }
+  std::vector<std::shared_ptr<::arrow::Array>> children;
+  children.reserve(fields.size());
+  for (size_t i = 0; i < fields.size(); ++i) {
+    const auto& child_type = type->field(static_cast<int>(i))->type();
+    auto it = values.partition.find(fields[i].field_id());
+    if (it == values.partition.cend()) {
+      ICEBERG_ARROW_ASSIGN_OR_RETURN(auto child,
+                                     ::arrow::MakeArrayOfNull(child_type, length, pool));
+      children.push_back(std::move(child));
+    } else {
+      ICEBERG_ASSIGN_OR_RAISE(auto child,
+                              MakeConstantArray(it->second, child_type, length, pool));
+      children.push_back(std::move(child));
+    }
+  }
+  return std::make_shared<::arrow::StructArray>(type, length, std::move(children));
+}
+
+/// \brief Replaces the null values of a stored column with inherited values.
+Result<std::shared_ptr<::arrow::Array>> InheritNulls(
+    const std::shared_ptr<::arrow::Array>& column,
+    const std::shared_ptr<::arrow::Array>& inherited, ::arrow::MemoryPool* pool) {
+  if (column->null_count() == 0) {
+    return column;
+  }
+  if (column->null_count() == column->length()) {
+    return inherited;
+  }
+  ::arrow::compute::ExecContext context(pool);
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(
+      auto result, ::arrow::compute::CallFunction("coalesce", {column, inherited},
+                                                  &context));
+  return result.make_array();
+}
+
+/// \brief Converts a projection to the Arrow schema of the record batches read for it.
+Result<std::shared_ptr<::arrow::Schema>> ConvertReadArrowSchema(
+    const Schema& projection) {
+  ArrowSchema arrow_schema;
+  ICEBERG_RETURN_UNEXPECTED(ToArrowSchema(projection, &arrow_schema));
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(auto schema, ::arrow::ImportSchema(&arrow_schema));
+  const auto& fields = projection.fields();
+  for (size_t i = 0; i < fields.size(); ++i) {
+    if (fields[i].field_id() != MetadataColumns::kFilePath.field_id()) {
+      continue;
+    }
+    auto field = schema->field(static_cast<int>(i));
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(
+        schema, schema->SetField(static_cast<int>(i),
+                                 field->WithType(::arrow::dictionary(::arrow::int32(),
+                                                                     field->type()))));
+  }
+  return schema;
+}
+
+}  // namespace
+
+Result<std::shared_ptr<::arrow::Scalar>> MakeScalar(
+    const Literal& literal, const std::shared_ptr<::arrow::DataType>& type) {
+  auto make_scalar = [&](const auto& value) -> Result<std::shared_ptr<::arrow::Scalar>> {
+    using T = std::decay_t<decltype(value)>;
+    if constexpr (std::is_same_v<T, std::monostate>) {
+      return ::arrow::MakeNullScalar(type);
+    } else if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, int32_t> ||
+                         std::is_same_v<T, int64_t> || std::is_same_v<T, float> ||
+                         std::is_same_v<T, double>) {
+      ICEBERG_ARROW_ASSIGN_OR_RETURN(auto scalar, ::arrow::MakeScalar(type, value));
+      return scalar;
+    } else if constexpr (std::is_same_v<T, std::string>) {
+      ICEBERG_ARROW_ASSIGN_OR_RETURN(
+          auto scalar, ::arrow::MakeScalar(type, ::arrow::Buffer::FromString(value)));
+      return scalar;
+    } else if constexpr (std::is_same_v<T, std::vector<uint8_t>>) {
+      ICEBERG_ARROW_ASSIGN_OR_RETURN(
+          auto scalar,
+          ::arrow::MakeScalar(type, ::arrow::Buffer::FromString(
+                                        std::string(value.begin(), value.end()))));
+      return scalar;
+    } else if constexpr (std::is_same_v<T, Decimal>) {
+      ICEBERG_ARROW_ASSIGN_OR_RETURN(
+          auto scalar,
+          ::arrow::MakeScalar(type, ::arrow::Decimal128(value.high(), value.low())));
+      return scalar;
+    } else if constexpr (std::is_same_v<T, Uuid>) {
+      const auto bytes = value.bytes();
+      ICEBERG_ARROW_ASSIGN_OR_RETURN(
+          auto scalar,
+          ::arrow::MakeScalar(type, ::arrow::Buffer::FromString(
+                                        std::string(bytes.begin(), bytes.end()))));
+      return scalar;
+    } else {
+      return InvalidArgument("Cannot generate a column of value {}", literal.ToString());
+    }
+  };
+  return std::visit(make_scalar, literal.value());
+}
+
+Result<std::shared_ptr<::arrow::Array>> MakeConstantArray(
+    const Literal& literal, const std::shared_ptr<::arrow::DataType>& type,
+    int64_t length, ::arrow::MemoryPool* pool) {
+  if (type->id() == ::arrow::Type::EXTENSION) {
+    const auto& extension_type =
+        internal::checked_cast<const ::arrow::ExtensionType&>(*type);
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto storage,
+        MakeConstantArray(literal, extension_type.storage_type(), length, pool));
+    return ::arrow::ExtensionType::WrapArray(type, storage);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto scalar, MakeScalar(literal, type));
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(auto array,
+                                 ::arrow::MakeArrayFromScalar(*scalar, length, pool));
+  return array;
+}
+
+Result<std::shared_ptr<::arrow::Schema>> MakeReadArrowSchema(const Schema& projection) {
+  // The readers of a scan convert the same projection for each file.
+  static ConversionCache<std::shared_ptr<::arrow::Schema>> cache;
+  return cache.GetOrConvert(projection.ToString(),
+                            [&]() { return ConvertReadArrowSchema(projection); });
+}
+
+std::shared_ptr<::arrow::DataType> StorageType(
+    const std::shared_ptr<::arrow::DataType>& type) {
+  if (type->id() == ::arrow::Type::EXTENSION) {
+    return StorageType(
+        internal::checked_cast<const ::arrow::ExtensionType&>(*type).storage_type());
+  }
+  if (type->num_fields() == 0) {
+    return type;
+  }
+  ::arrow::FieldVector fields;
+  bool changed = false;
+  for (const auto& field : type->fields()) {
+    auto storage_type = StorageType(field->type());
+    changed = changed || storage_type != field->type();
+    fields.push_back(field->WithType(std::move(storage_type)));
+  }
+  if (!changed) {
+    return type;
+  }
+  switch (type->id()) {
+    case ::arrow::Type::STRUCT:
+      return ::arrow::struct_(std::move(fields));
+    case ::arrow::Type::LIST:
+      return ::arrow::list(std::move(fields[0]));
+    case ::arrow::Type::LARGE_LIST:
+      return ::arrow::large_list(std::move(fields[0]));
+    case ::arrow::Type::MAP:
+      return std::make_shared<::arrow::MapType>(
+          std::move(fields[0]),
+          internal::checked_cast<const ::arrow::MapType&>(*type).keys_sorted());
+    default:
+      // The readers only produce extension types in structs, lists and maps.
+      return type;
+  }
+}
+
+namespace {
+
+std::shared_ptr<::arrow::ArrayData> ViewDataAsType(
+    const std::shared_ptr<::arrow::ArrayData>& data,
+    const std::shared_ptr<::arrow::DataType>& type) {
+  if (data->type == type) {
+    return data;
+  }
+  auto view = data->Copy();
+  view->type = type;
+  auto storage_type = type;
+  if (type->id() == ::arrow::Type::EXTENSION) {
+    storage_type =
+        internal::checked_cast<const ::arrow::ExtensionType&>(*type).storage_type();
+  }
+  for (size_t i = 0; i < view->child_data.size(); ++i) {
+    const auto& child_type = storage_type->field(static_cast<int>(i))->type();
+    view->child_data[i] = ViewDataAsType(view->child_data[i], child_type);
+  }
+  return view;
+}
+
+}  // namespace
+
+std::shared_ptr<::arrow::Array> ViewAsType(
+    const std::shared_ptr<::arrow::Array>& array,
+    const std::shared_ptr<::arrow::DataType>& type) {
+  if (array->type() == type) {
+    return array;
+  }
+  return ::arrow::MakeArray(ViewDataAsType(array->data(), type));
+}
+
+bool HasMetadataColumns(const Schema& projection) {
+  return std::ranges::any_of(projection.fields(), [](const SchemaField& field) {
+    return MetadataColumns::IsMetadataColumn(field.field_id());
+  });
+}
+
+bool NeedsRowPositions(const Schema& projection) {
+  return std::ranges::any_of(projection.fields(), [](const SchemaField& field) {
+    return field.field_id() == MetadataColumns::kRowPosition.field_id() ||
+           field.field_id() == MetadataColumns::kRowId.field_id();
+  });
+}
+
+Result<std::shared_ptr<::arrow::RecordBatch>> SetMetadataColumns(
+    const std::shared_ptr<::arrow::RecordBatch>& batch, const Schema& projection,
+    const std::string& file_path, const MetadataColumnValues& values,
+    std::span<const std::pair<int64_t, int64_t>> positions, ::arrow::MemoryPool* pool) {
+  const auto& fields = projection.fields();
+  if (static_cast<size_t>(batch->num_columns()) != fields.size()) {
+    return InvalidSchema("Expected a record batch of {} columns, got {}", fields.size(),
+                         batch->num_columns());
+  }
+
+  const int64_t length = batch->num_rows();
+  auto result = batch;
+  for (size_t i = 0; i < fields.size(); ++i) {
+    const int32_t field_id = fields[i].field_id();
+    if (!MetadataColumns::IsMetadataColumn(field_id)) {
+      continue;
+    }
+    const int index = static_cast<int>(i);
+    const auto& column = batch->column(index);
+    const auto& type = column->type();
+
+    std::shared_ptr<::arrow::Array> array;
+    if (field_id == MetadataColumns::kFilePath.field_id()) {
+      ICEBERG_ASSIGN_OR_RAISE(array, MakeFilePathArray(file_path, type, length, pool));
+    } else if (field_id == MetadataColumns::kRowPosition.field_id()) {
+      ICEBERG_ASSIGN_OR_RAISE(array,
+                              MakePositionArray(positions, length, /*offset=*/0, pool));
+    } else if (field_id == MetadataColumns::kIsDeleted.field_id()) {
+      // Deleted rows are skipped by the readers.
+      ICEBERG_ASSIGN_OR_RAISE(
+          array, MakeConstantArray(Literal::Boolean(false), type, length, pool));
+    } else if (field_id == MetadataColumns::kSpecId.field_id()) {
+      ICEBERG_ASSIGN_OR_RAISE(
+          array, MakeConstantArray(values.spec_id.has_value()
+                                       ? Literal::Int(values.spec_id.value())
+                                       : Literal::Null(int32()),
+                                   type, length, pool));
+    } else if (field_id == MetadataColumns::kPartitionColumnId) {
+      if (fields[i].type()->type_id() != TypeId::kStruct) {
+        return InvalidSchema("The _partition column must be a struct, got {}",
+                             fields[i].type()->ToString());
+      }
+      ICEBERG_ASSIGN_OR_RAISE(
+          array,
+          MakePartitionArray(internal::checked_cast<const StructType&>(*fields[i].type()),
+                             values, type, length, pool));
+    } else if (field_id == MetadataColumns::kRowId.field_id()) {
+      if (!values.first_row_id.has_value() || column->null_count() == 0) {
+        continue;
+      }
+      ICEBERG_ASSIGN_OR_RAISE(auto inherited,
+                              MakePositionArray(positions, length,
+                                                values.first_row_id.value(), pool));
+      ICEBERG_ASSIGN_OR_RAISE(array, InheritNulls(column, inherited, pool));
+    } else if (field_id == MetadataColumns::kLastUpdatedSequenceNumber.field_id()) {
+      if (!values.data_sequence_number.has_value() || column->null_count() == 0) {
+        continue;
+      }
+      ICEBERG_ASSIGN_OR_RAISE(
+          auto inherited,
+          MakeConstantArray(Literal::Long(values.data_sequence_number.value()), type,
+                            length, pool));
+      ICEBERG_ASSIGN_OR_RAISE(array, InheritNulls(column, inherited, pool));
+    } else {
+      continue;
+    }
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(
+        result, result->SetColumn(index, result->schema()->field(index), array));
+  }
+  return result;
+}
+
+}  // namespace iceberg::arrow
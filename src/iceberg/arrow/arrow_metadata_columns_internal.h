@@ -0,0 +1,91 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+
+#include <arrow/type_fwd.h>
+
+#include "iceberg/file_reader.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg::arrow {
+
+/// \brief Returns a scalar of a literal value with the Arrow type of its column, which
+/// is not an extension type.
+Result<std::shared_ptr<::arrow::Scalar>> MakeScalar(
+    const Literal& literal, const std::shared_ptr<::arrow::DataType>& type);
+
+/// \brief Returns an array with a literal value in every row, broadcast from a scalar
+/// of the value without building it row by row.
+Result<std::shared_ptr<::arrow::Array>> MakeConstantArray(
+    const Literal& literal, const std::shared_ptr<::arrow::DataType>& type,
+    int64_t length, ::arrow::MemoryPool* pool);
+
+/// \brief Returns the Arrow schema of the record batches read for a projection.
+///
+/// The _file metadata column is a dictionary array, as all of its values are the path
+/// of the file read. The schemas are cached by projection.
+Result<std::shared_ptr<::arrow::Schema>> MakeReadArrowSchema(const Schema& projection);
+
+/// \brief Returns a type with its extension types, at any depth, replaced by their
+/// storage types, which arrays of the type can be built with.
+std::shared_ptr<::arrow::DataType> StorageType(
+    const std::shared_ptr<::arrow::DataType>& type);
+
+/// \brief Returns an array of a type with the buffers of an array of its StorageType(),
+/// without copying them.
+std::shared_ptr<::arrow::Array> ViewAsType(
+    const std::shared_ptr<::arrow::Array>& array,
+    const std::shared_ptr<::arrow::DataType>& type);
+
+/// \brief Returns whether a projection has top-level metadata columns.
+bool HasMetadataColumns(const Schema& projection);
+
+/// \brief Returns whether the metadata columns of a projection are computed from the
+/// positions of the rows in the file, which are the _pos and _row_id columns.
+bool NeedsRowPositions(const Schema& projection);
+
+/// \brief Sets the top-level metadata columns of a record batch read for a projection.
+///
+/// The _file, _pos, _deleted, _spec_id and _partition columns are generated, while
+/// their columns in the batch are only placeholders. The _row_id and
+/// _last_updated_sequence_number columns keep the values stored in the file, and their
+/// null values are inherited from the first row id and the data sequence number of the
+/// file if they are known.
+///
+/// \param batch The record batch, whose columns are the fields of the projection
+/// \param projection The projected schema
+/// \param file_path The path of the file read, for the _file column
+/// \param values The values of the other metadata columns that are not in the file
+/// \param positions The ranges of positions in the file of the rows of the batch, in
+/// order, which are only used if NeedsRowPositions(projection)
+/// \param pool The pool to allocate the generated columns from
+Result<std::shared_ptr<::arrow::RecordBatch>> SetMetadataColumns(
+    const std::shared_ptr<::arrow::RecordBatch>& batch, const Schema& projection,
+    const std::string& file_path, const MetadataColumnValues& values,
+    std::span<const std::pair<int64_t, int64_t>> positions, ::arrow::MemoryPool* pool);
+
+}  // namespace iceberg::arrow
@@ -0,0 +1,97 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/arrow/arrow_register.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <arrow/util/compression.h>
+
+#include "iceberg/arrow/arrow_status_internal.h"
+#include "iceberg/puffin/puffin_format.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg::arrow {
+
+namespace {
+
+Result<std::string> Compress(::arrow::Compression::type type, std::string_view data) {
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(auto codec, ::arrow::util::Codec::Create(type));
+  const auto* input = reinterpret_cast<const uint8_t*>(data.data());
+  const auto input_size = static_cast<int64_t>(data.size());
+  std::string output(codec->MaxCompressedLen(input_size, input), '\0');
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(
+      auto size, codec->Compress(input_size, input, static_cast<int64_t>(output.size()),
+                                 reinterpret_cast<uint8_t*>(output.data())));
+  output.resize(size);
+  return output;
+}
+
+/// \brief Decompresses a single frame with a streaming decompressor, since the
+/// decompressed size of a blob is not stored in the footer.
+Result<std::string> Decompress(::arrow::Compression::type type, std::string_view data) {
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(auto codec, ::arrow::util::Codec::Create(type));
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(auto decompressor, codec->MakeDecompressor());
+  const auto* input = reinterpret_cast<const uint8_t*>(data.data());
+  auto input_size = static_cast<int64_t>(data.size());
+  std::string output(std::max<size_t>(data.size() * 2, 1024), '\0');
+  int64_t output_size = 0;
+  while (!decompressor->IsFinished()) {
+    if (output_size == static_cast<int64_t>(output.size())) {
+      output.resize(output.size() * 2);
+    }
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(
+        auto result,
+        decompressor->Decompress(
+            input_size, input, static_cast<int64_t>(output.size()) - output_size,
+            reinterpret_cast<uint8_t*>(output.data()) + output_size));
+    input += result.bytes_read;
+    input_size -= result.bytes_read;
+    output_size += result.bytes_written;
+    if (input_size == 0 && !result.need_more_output && !decompressor->IsFinished()) {
+      return DecompressError("Truncated {} frame of {} bytes",
+                             ::arrow::util::Codec::GetCodecAsString(type), data.size());
+    }
+  }
+  output.resize(output_size);
+  return output;
+}
+
+void RegisterCodec(PuffinCompressionCodec codec, ::arrow::Compression::type type) {
+  PuffinCodecRegistry(codec, PuffinCodec{
+                                 .compress = [type](std::string_view data) {
+                                   return Compress(type, data);
+                                 },
+                                 .decompress = [type](std::string_view data) {
+                                   return Decompress(type, data);
+                                 },
+                             });
+}
+
+}  // namespace
+
+void RegisterPuffinCodecs() {
+  RegisterCodec(PuffinCompressionCodec::kLz4, ::arrow::Compression::LZ4_FRAME);
+  RegisterCodec(PuffinCompressionCodec::kZstd, ::arrow::Compression::ZSTD);
+}
+
+}  // namespace iceberg::arrow
@@ -0,0 +1,435 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/arrow/arrow_scan.h"
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <arrow/c/bridge.h>
+#include <arrow/compute/api_scalar.h>
+#include <arrow/compute/expression.h>
+#include <arrow/record_batch.h>
+#include <arrow/scalar.h>
+#include <arrow/type.h>
+
+#include "iceberg/arrow/arrow_status_internal.h"
+#include "iceberg/expression/expressions.h"
+#include "iceberg/expression/literal.h"
+#include "iceberg/schema.h"
+#include "iceberg/schema_internal.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg::arrow {
+
+namespace {
+
+/// \brief Converts a valid Arrow scalar to a literal, or returns std::nullopt if its
+/// type has no literal.
+std::optional<Literal> ToLiteral(const ::arrow::Scalar& scalar) {
+  if (!scalar.is_valid) {
+    return std::nullopt;
+  }
+  using internal::checked_cast;
+  switch (scalar.type->id()) {
+    case ::arrow::Type::BOOL:
+      return Literal::Boolean(checked_cast<const ::arrow::BooleanScalar&>(scalar).value);
+    case ::arrow::Type::INT8:
+      return Literal::Int(checked_cast<const ::arrow::Int8Scalar&>(scalar).value);
+    case ::arrow::Type::INT16:
+      return Literal::Int(checked_cast<const ::arrow::Int16Scalar&>(scalar).value);
+    case ::arrow::Type::INT32:
+      return Literal::Int(checked_cast<const ::arrow::Int32Scalar&>(scalar).value);
+    case ::arrow::Type::INT64:
+      return Literal::Long(checked_cast<const ::arrow::Int64Scalar&>(scalar).value);
+    case ::arrow::Type::FLOAT:
+      return Literal::Float(checked_cast<const ::arrow::FloatScalar&>(scalar).value);
+    case ::arrow::Type::DOUBLE:
+      return Literal::Double(checked_cast<const ::arrow::DoubleScalar&>(scalar).value);
+    case ::arrow::Type::STRING:
+    case ::arrow::Type::LARGE_STRING:
+    case ::arrow::Type::STRING_VIEW:
+      return Literal::String(
+          std::string(checked_cast<const ::arrow::BaseBinaryScalar&>(scalar).view()));
+    case ::arrow::Type::BINARY:
+    case ::arrow::Type::LARGE_BINARY:
+    case ::arrow::Type::BINARY_VIEW: {
+      auto view = checked_cast<const ::arrow::BaseBinaryScalar&>(scalar).view();
+      return Literal::Binary(std::vector<uint8_t>(view.begin(), view.end()));
+    }
+    case ::arrow::Type::DATE32:
+      return Literal::Date(checked_cast<const ::arrow::Date32Scalar&>(scalar).value);
+    case ::arrow::Type::TIMESTAMP: {
+      const auto& type = checked_cast<const ::arrow::TimestampType&>(*scalar.type);
+      if (type.unit() != ::arrow::TimeUnit::MICRO) {
+        return std::nullopt;
+      }
+      const int64_t value = checked_cast<const ::arrow::TimestampScalar&>(scalar).value;
+      return type.timezone().empty() ? Literal::Timestamp(value)
+                                     : Literal::TimestampTz(value);
+    }
+    default:
+      return std::nullopt;
+  }
+}
+
+/// \brief Returns the name of a referenced field, with the names of nested fields
+/// joined by dots, or std::nullopt if it is not referenced by name.
+std::optional<std::string> FieldName(const ::arrow::compute::Expression& expr) {
+  const auto* ref = expr.field_ref();
+  if (ref == nullptr) {
+    return std::nullopt;
+  }
+  if (const auto* name = ref->name()) {
+    return *name;
+  }
+  const auto* nested_refs = ref->nested_refs();
+  if (nested_refs == nullptr) {
+    return std::nullopt;
+  }
+  std::string name;
+  for (const auto& nested_ref : *nested_refs) {
+    if (nested_ref.name() == nullptr) {
+      return std::nullopt;
+    }
+    if (!name.empty()) {
+      name += '.';
+    }
+    name += *nested_ref.name();
+  }
+  return name;
+}
+
+/// \brief Returns the literal of a scalar literal expression, or std::nullopt.
+std::optional<Literal> ScalarLiteral(const ::arrow::compute::Expression& expr) {
+  const auto* datum = expr.literal();
+  if (datum == nullptr || !datum->is_scalar()) {
+    return std::nullopt;
+  }
+  return ToLiteral(*datum->scalar());
+}
+
+/// \brief Converts Arrow compute filters, returning null for the expressions that
+/// cannot be converted and clearing `exact` when a part of the filter is dropped.
+class FilterConverter {
+ public:
+  std::shared_ptr<Expression> Convert(const ::arrow::compute::Expression& expr) {
+    auto converted = ConvertExpression(expr);
+    if (converted == nullptr) {
+      exact_ = false;
+    }
+    return converted;
+  }
+
+  bool exact() const { return exact_; }
+
+ private:
+  std::shared_ptr<Expression> ConvertExpression(
+      const ::arrow::compute::Expression& expr) {
+    if (auto literal = ScalarLiteral(expr)) {
+      if (const auto* value = std::get_if<bool>(&literal->value())) {
+        return *value ? std::shared_ptr<Expression>(Expressions::AlwaysTrue())
+                      : Expressions::AlwaysFalse();
+      }
+      return nullptr;
+    }
+    const auto* call = expr.call();
+    if (call == nullptr) {
+      return nullptr;
+    }
+    const auto& name = call->function_name;
+    const auto& args = call->arguments;
+    if ((name == "and" || name == "and_kleene") && args.size() == 2) {
+      // A conjunct that cannot be converted only makes the filter match more rows.
+      auto left = Convert(args[0]);
+      auto right = Convert(args[1]);
+      if (left == nullptr || right == nullptr) {
+        return left != nullptr ? left : right;
+      }
+      return Expressions::And(std::move(left), std::move(right));
+    }
+    if ((name == "or" || name == "or_kleene") && args.size() == 2) {
+      auto left = Convert(args[0]);
+      auto right = Convert(args[1]);
+      if (left == nullptr || right == nullptr) {
+        return nullptr;
+      }
+      return Expressions::Or(std::move(left), std::move(right));
+    }
+    if (name == "invert" && args.size() == 1) {
+      // The negation of a filter matching more rows would match fewer rows.
+      FilterConverter child_converter;
+      auto child = child_converter.Convert(args[0]);
+      if (child == nullptr || !child_converter.exact()) {
+        return nullptr;
+      }
+      return Expressions::Not(std::move(child));
+    }
+    if (args.empty()) {
+      return nullptr;
+    }
+    if (args.size() == 1) {
+      return ConvertUnary(*call);
+    }
+    if (args.size() == 2) {
+      return ConvertComparison(name, args[0], args[1]);
+    }
+    return nullptr;
+  }
+
+  std::shared_ptr<Expression> ConvertUnary(
+      const ::arrow::compute::Expression::Call& call) {
+    auto field = FieldName(call.arguments[0]);
+    if (!field.has_value()) {
+      return nullptr;
+    }
+    const auto& name = call.function_name;
+    if (name == "is_null") {
+      const auto* options =
+          static_cast<const ::arrow::compute::NullOptions*>(call.options.get());
+      if (options != nullptr && options->nan_is_null) {
+        return nullptr;
+      }
+      return Expressions::IsNull(std::move(*field));
+    }
+    if (name == "is_valid") {
+      return Expressions::NotNull(std::move(*field));
+    }
+    if (name == "is_nan") {
+      return Expressions::IsNaN(std::move(*field));
+    }
+    if (name == "is_in") {
+      const auto* options =
+          static_cast<const ::arrow::compute::SetLookupOptions*>(call.options.get());
+      if (options == nullptr || !options->value_set.is_arraylike()) {
+        return nullptr;
+      }
+      auto value_set = options->value_set.make_array();
+      std::vector<Literal> values;
+      values.reserve(value_set->length());
+      for (int64_t i = 0; i < value_set->length(); ++i) {
+        auto scalar = value_set->GetScalar(i);
+        if (!scalar.ok()) {
+          return nullptr;
+        }
+        // Null values match nulls in Arrow, but never match in Iceberg.
+        auto literal = ToLiteral(**scalar);
+        if (!literal.has_value()) {
+          return nullptr;
+        }
+        values.push_back(std::move(*literal));
+      }
+      if (values.empty()) {
+        return Expressions::AlwaysFalse();
+      }
+      return Expressions::In(std::move(*field), std::move(values));
+    }
+    if (name == "starts_with") {
+      const auto* options =
+          static_cast<const ::arrow::compute::MatchSubstringOptions*>(call.options.get());
+      if (options == nullptr || options->ignore_case) {
+        return nullptr;
+      }
+      return Expressions::StartsWith(std::move(*field), options->pattern);
+    }
+    return nullptr;
+  }
+
+  std::shared_ptr<Expression> ConvertComparison(
+      const std::string& name, const ::arrow::compute::Expression& left,
+      const ::arrow::compute::Expression& right) {
+    auto field = FieldName(left);
+    auto literal = ScalarLiteral(right);
+    bool flipped = false;
+    if (!field.has_value() || !literal.has_value()) {
+      field = FieldName(right);
+      literal = ScalarLiteral(left);
+      flipped = true;
+    }
+    if (!field.has_value() || !literal.has_value()) {
+      return nullptr;
+    }
+    if (name == "equal") {
+      return Expressions::Equal(std::move(*field), std::move(*literal));
+    }
+    if (name == "not_equal") {
+      return Expressions::NotEqual(std::move(*field), std::move(*literal));
+    }
+    if (name == (flipped ? "greater" : "less")) {
+      return Expressions::LessThan(std::move(*field), std::move(*literal));
+    }
+    if (name == (flipped ? "greater_equal" : "less_equal")) {
+      return Expressions::LessThanOrEqual(std::move(*field), std::move(*literal));
+    }
+    if (name == (flipped ? "less" : "greater")) {
+      return Expressions::GreaterThan(std::move(*field), std::move(*literal));
+    }
+    if (name == (flipped ? "less_equal" : "greater_equal")) {
+      return Expressions::GreaterThanOrEqual(std::move(*field), std::move(*literal));
+    }
+    return nullptr;
+  }
+
+  bool exact_ = true;
+};
+
+/// \brief Reads the file scan tasks of a combined task one after the other.
+class CombinedTaskReader : public ::arrow::RecordBatchReader {
+ public:
+  CombinedTaskReader(std::shared_ptr<CombinedScanTask> task, std::shared_ptr<FileIO> io,
+                     std::shared_ptr<Schema> projected_schema,
+                     std::shared_ptr<::arrow::Schema> schema, int32_t prefetch_batches)
+      : task_(std::move(task)),
+        io_(std::move(io)),
+        projected_schema_(std::move(projected_schema)),
+        schema_(std::move(schema)),
+        prefetch_batches_(prefetch_batches) {}
+
+  std::shared_ptr<::arrow::Schema> schema() const override { return schema_; }
+
+  ::arrow::Status ReadNext(std::shared_ptr<::arrow::RecordBatch>* batch) override {
+    const auto& tasks = task_->tasks();
+    while (true) {
+      if (current_ == nullptr) {
+        if (next_task_ == tasks.size()) {
+          *batch = nullptr;
+          return ::arrow::Status::OK();
+        }
+        const auto& task = tasks[next_task_++];
+        auto stream = task->ToArrow(io_, projected_schema_, task->residual(),
+                                    RowFilterMode::kNone, prefetch_batches_);
+        if (!stream.has_value()) {
+          return ToArrowStatus(stream.error());
+        }
+        ARROW_ASSIGN_OR_RAISE(current_, ::arrow::ImportRecordBatchReader(&*stream));
+      }
+      ARROW_RETURN_NOT_OK(current_->ReadNext(batch));
+      if (*batch != nullptr) {
+        return ::arrow::Status::OK();
+      }
+      ARROW_RETURN_NOT_OK(current_->Close());
+      current_.reset();
+    }
+  }
+
+  ::arrow::Status Close() override {
+    next_task_ = task_->tasks().size();
+    if (current_ == nullptr) {
+      return ::arrow::Status::OK();
+    }
+    auto status = current_->Close();
+    current_.reset();
+    return status;
+  }
+
+ private:
+  std::shared_ptr<CombinedScanTask> task_;
+  std::shared_ptr<FileIO> io_;
+  std::shared_ptr<Schema> projected_schema_;
+  std::shared_ptr<::arrow::Schema> schema_;
+  int32_t prefetch_batches_;
+  size_t next_task_ = 0;
+  std::shared_ptr<::arrow::RecordBatchReader> current_;
+};
+
+}  // namespace
+
+ArrowFilterConversion FromArrowExpression(const ::arrow::compute::Expression& filter) {
+  FilterConverter converter;
+  auto converted = converter.Convert(filter);
+  if (converted == nullptr) {
+    converted = Expressions::AlwaysTrue();
+  }
+  return {.filter = std::move(converted), .exact = converter.exact()};
+}
+
+ArrowFragment::ArrowFragment(std::shared_ptr<CombinedScanTask> task,
+                             std::shared_ptr<FileIO> io,
+                             std::shared_ptr<Schema> projected_schema,
+                             std::shared_ptr<::arrow::Schema> schema)
+    : task_(std::move(task)),
+      io_(std::move(io)),
+      projected_schema_(std::move(projected_schema)),
+      schema_(std::move(schema)) {}
+
+const std::shared_ptr<CombinedScanTask>& ArrowFragment::task() const { return task_; }
+
+Result<std::shared_ptr<::arrow::RecordBatchReader>> ArrowFragment::ToRecordBatchReader(
+    int32_t prefetch_batches) const {
+  if (prefetch_batches < 0) {
+    return InvalidArgument("Prefetched batches must not be negative: {}",
+                           prefetch_batches);
+  }
+  return std::make_shared<CombinedTaskReader>(task_, io_, projected_schema_, schema_,
+                                              prefetch_batches);
+}
+
+ArrowScan::ArrowScan(std::unique_ptr<TableScan> scan,
+                     std::shared_ptr<::arrow::Schema> schema, bool filter_exact)
+    : scan_(std::move(scan)), schema_(std::move(schema)), filter_exact_(filter_exact) {}
+
+ArrowScan::~ArrowScan() = default;
+
+Result<std::unique_ptr<ArrowScan>> ArrowScan::Make(
+    std::unique_ptr<TableScanBuilder> builder, const ::arrow::compute::Expression& filter,
+    std::vector<std::string> columns) {
+  if (builder == nullptr) {
+    return InvalidArgument("Cannot make an Arrow scan without a scan builder");
+  }
+  auto conversion = FromArrowExpression(filter);
+  builder->WithFilter(std::move(conversion.filter));
+  if (!columns.empty()) {
+    builder->WithColumnNames(std::move(columns));
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto scan, builder->Build());
+
+  ArrowSchema c_schema;
+  ICEBERG_RETURN_UNEXPECTED(ToArrowSchema(*scan->projection(), &c_schema));
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(auto schema, ::arrow::ImportSchema(&c_schema));
+  return std::unique_ptr<ArrowScan>(
+      new ArrowScan(std::move(scan), std::move(schema), conversion.exact));
+}
+
+const TableScan& ArrowScan::scan() const { return *scan_; }
+
+const std::shared_ptr<::arrow::Schema>& ArrowScan::schema() const { return schema_; }
+
+bool ArrowScan::filter_exact() const { return filter_exact_; }
+
+Result<std::vector<ArrowFragment>> ArrowScan::GetFragments() const {
+  ICEBERG_ASSIGN_OR_RAISE(auto tasks, scan_->PlanTasks());
+  std::vector<ArrowFragment> fragments;
+  fragments.reserve(tasks.size());
+  for (auto& task : tasks) {
+    fragments.emplace_back(std::move(task), scan_->io(), scan_->projection(), schema_);
+  }
+  return fragments;
+}
+
+Result<std::shared_ptr<::arrow::RecordBatchReader>> ArrowScan::ToRecordBatchReader(
+    int32_t parallelism, ScanOrder order) const {
+  ICEBERG_ASSIGN_OR_RAISE(auto stream, scan_->ToArrow(parallelism, order));
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(auto reader, ::arrow::ImportRecordBatchReader(&stream));
+  return reader;
+}
+
+}  // namespace iceberg::arrow
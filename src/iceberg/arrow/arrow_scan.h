@@ -0,0 +1,144 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/arrow/arrow_scan.h
+/// \brief Read table scans from Arrow C++ with filters and projections pushed down.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "iceberg/iceberg_bundle_export.h"
+#include "iceberg/result.h"
+#include "iceberg/table_scan.h"
+#include "iceberg/type_fwd.h"
+
+namespace arrow {
+class RecordBatchReader;
+class Schema;
+namespace compute {
+class Expression;
+}  // namespace compute
+}  // namespace arrow
+
+namespace iceberg::arrow {
+
+/// \brief An Iceberg filter converted from an Arrow compute filter.
+struct ICEBERG_BUNDLE_EXPORT ArrowFilterConversion {
+  /// \brief The converted filter, never null.
+  std::shared_ptr<Expression> filter;
+  /// \brief Whether the converted filter matches exactly the rows of the Arrow filter.
+  ///
+  /// When false, the converted filter matches a superset of the rows, so it can still
+  /// skip data but the Arrow filter must be applied to the returned rows.
+  bool exact = true;
+};
+
+/// \brief Converts an Arrow compute filter to an Iceberg filter.
+///
+/// Comparisons of a field with a literal, is_null, is_valid, is_nan, is_in and
+/// starts_with calls, and their combinations with and, or and not are converted.
+/// Fields are referenced by name, with the names of nested fields joined by dots.
+/// Conjuncts that cannot be converted are dropped, and other expressions that cannot
+/// be converted become AlwaysTrue.
+ICEBERG_BUNDLE_EXPORT ArrowFilterConversion
+FromArrowExpression(const ::arrow::compute::Expression& filter);
+
+/// \brief A part of an ArrowScan that can be read independently of the others, such as
+/// on another thread.
+class ICEBERG_BUNDLE_EXPORT ArrowFragment {
+ public:
+  ArrowFragment(std::shared_ptr<CombinedScanTask> task, std::shared_ptr<FileIO> io,
+                std::shared_ptr<Schema> projected_schema,
+                std::shared_ptr<::arrow::Schema> schema);
+
+  /// \brief The file scan tasks read by this fragment.
+  const std::shared_ptr<CombinedScanTask>& task() const;
+
+  /// \brief Returns a reader of the rows of the fragment.
+  ///
+  /// The file scan tasks are read one after the other like FileScanTask::ToArrow with
+  /// their residual, so rows deleted by their delete files are not returned, and the
+  /// returned batches may contain rows that do not match the filter.
+  /// \param prefetch_batches The number of batches read ahead on the executor of each
+  /// task, see FileScanTask::ToArrow.
+  Result<std::shared_ptr<::arrow::RecordBatchReader>> ToRecordBatchReader(
+      int32_t prefetch_batches = 0) const;
+
+ private:
+  std::shared_ptr<CombinedScanTask> task_;
+  std::shared_ptr<FileIO> io_;
+  std::shared_ptr<Schema> projected_schema_;
+  std::shared_ptr<::arrow::Schema> schema_;
+};
+
+/// \brief A table scan read as Arrow C++ record batches.
+///
+/// The projection and the filter of the Arrow query are pushed down to the scan, which
+/// uses them to skip manifests, data files, row groups and columns. The scan is split
+/// into fragments that are read in parallel by the caller, or read with a number of
+/// workers into a single reader.
+class ICEBERG_BUNDLE_EXPORT ArrowScan {
+ public:
+  /// \brief Makes a scan with a projection and an Arrow filter.
+  ///
+  /// \param builder The builder of the scan, with its snapshot and options. Its filter
+  /// is replaced by the converted Arrow filter.
+  /// \param filter The Arrow filter, converted with FromArrowExpression().
+  /// \param columns The names of the projected columns, all columns if empty.
+  /// \return A Result containing the scan, or an error if the scan cannot be built,
+  /// such as when a projected column is unknown.
+  static Result<std::unique_ptr<ArrowScan>> Make(
+      std::unique_ptr<TableScanBuilder> builder,
+      const ::arrow::compute::Expression& filter, std::vector<std::string> columns = {});
+
+  ~ArrowScan();
+
+  /// \brief The table scan with the pushed down projection and filter.
+  const TableScan& scan() const;
+
+  /// \brief The Arrow schema of the returned batches.
+  const std::shared_ptr<::arrow::Schema>& schema() const;
+
+  /// \brief Whether the whole Arrow filter was pushed down, see
+  /// ArrowFilterConversion::exact. The Arrow filter must be applied to the returned
+  /// rows either way, because files are only skipped by their metrics.
+  bool filter_exact() const;
+
+  /// \brief Plans the fragments of the scan, one per task returned by
+  /// TableScan::PlanTasks().
+  Result<std::vector<ArrowFragment>> GetFragments() const;
+
+  /// \brief Returns a reader of the rows of the scan read by a number of workers, see
+  /// TableScan::ToArrow.
+  Result<std::shared_ptr<::arrow::RecordBatchReader>> ToRecordBatchReader(
+      int32_t parallelism, ScanOrder order = ScanOrder::kOrdered) const;
+
+ private:
+  ArrowScan(std::unique_ptr<TableScan> scan, std::shared_ptr<::arrow::Schema> schema,
+            bool filter_exact);
+
+  std::unique_ptr<TableScan> scan_;
+  std::shared_ptr<::arrow::Schema> schema_;
+  bool filter_exact_;
+};
+
+}  // namespace iceberg::arrow
@@ -32,11 +32,34 @@ inline ErrorKind ToErrorKind(const ::arrow::Status& status) {
       return ErrorKind::kIOError;
     case ::arrow::StatusCode::NotImplemented:
       return ErrorKind::kNotImplemented;
+    case ::arrow::StatusCode::OutOfMemory:
+      return ErrorKind::kOutOfMemory;
     default:
       return ErrorKind::kUnknownError;
   }
 }
 
+inline ::arrow::Status ToArrowStatus(const Error& error) {
+  switch (error.kind) {
+    case ErrorKind::kIOError:
+      return ::arrow::Status::IOError(error.message);
+    case ErrorKind::kNotImplemented:
+    case ErrorKind::kNotSupported:
+      return ::arrow::Status::NotImplemented(error.message);
+    case ErrorKind::kInvalid:
+    case ErrorKind::kInvalidArgument:
+      return ::arrow::Status::Invalid(error.message);
+    case ErrorKind::kOutOfMemory:
+      return ::arrow::Status::OutOfMemory(error.message);
+    default:
+      return ::arrow::Status::UnknownError(error.message);
+  }
+}
+
+inline ::arrow::Status ToArrowStatus(const Status& status) {
+  return status.has_value() ? ::arrow::Status::OK() : ToArrowStatus(status.error());
+}
+
 #define ICEBERG_ARROW_ASSIGN_OR_RETURN_IMPL(result_name, lhs, rexpr, error_transform) \
   auto&& result_name = (rexpr);                                                       \
   if (!result_name.ok()) {                                                            \
@@ -0,0 +1,42 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/async.h"
+
+#include <cstring>
+
+namespace iceberg {
+
+Task<Result<std::optional<ArrowArray>>> NextAsync(ArrowArrayStream* stream,
+                                                  std::shared_ptr<Executor> executor) {
+  return RunOn(std::move(executor), [stream]() -> Result<std::optional<ArrowArray>> {
+    ArrowArray array;
+    if (int code = stream->get_next(stream, &array); code != 0) {
+      const char* message = stream->get_last_error(stream);
+      return IOError("Cannot read the next batch of the stream: {}",
+                     message != nullptr ? message : std::strerror(code));
+    }
+    if (array.release == nullptr) {
+      return std::nullopt;
+    }
+    return array;
+  });
+}
+
+}  // namespace iceberg
@@ -0,0 +1,234 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/async.h
+/// Coroutines awaiting the operations of the library without blocking a thread.
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "iceberg/arrow_c_data.h"
+#include "iceberg/executor.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+
+namespace iceberg {
+
+/// \brief A coroutine returning a value of type T, usually a Result.
+///
+/// A task is lazy: it starts when it is awaited by another coroutine, or by
+/// SyncWait(), and resumes its awaiter when it completes, on the thread that completed
+/// it. Tasks are driven by executors: awaiting ScheduleOn() moves a coroutine to an
+/// executor, so an engine can multiplex thousands of tasks on the threads of its own
+/// event loop by implementing Executor::Submit with it. The arguments of a coroutine
+/// must outlive its task, which is why the asynchronous operations of the library
+/// take their arguments by value, and the objects they are called on must outlive
+/// the task.
+template <typename T>
+class [[nodiscard]] Task {
+ public:
+  static_assert(!std::is_void_v<T>, "Tasks return a value, e.g. a Status");
+
+  struct promise_type {
+    Task get_return_object() {
+      return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    /// \brief Resumes the awaiter of the task, if any, when it completes.
+    struct FinalAwaiter {
+      bool await_ready() noexcept { return false; }
+
+      std::coroutine_handle<> await_suspend(
+          std::coroutine_handle<promise_type> handle) noexcept {
+        auto continuation = handle.promise().continuation;
+        return continuation ? continuation : std::noop_coroutine();
+      }
+
+      void await_resume() noexcept {}
+    };
+
+    FinalAwaiter final_suspend() noexcept { return {}; }
+
+    template <typename U>
+      requires std::is_convertible_v<U&&, T>
+    void return_value(U&& value) {
+      this->value.emplace(std::forward<U>(value));
+    }
+
+    void unhandled_exception() { exception = std::current_exception(); }
+
+    std::coroutine_handle<> continuation;
+    std::optional<T> value;
+    std::exception_ptr exception;
+  };
+
+  Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+  Task& operator=(Task&& other) noexcept {
+    if (this != &other) {
+      if (handle_) {
+        handle_.destroy();
+      }
+      handle_ = std::exchange(other.handle_, nullptr);
+    }
+    return *this;
+  }
+
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+
+  ~Task() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  /// \brief Starts the task and suspends the awaiting coroutine until it completes.
+  auto operator co_await() && noexcept {
+    struct Awaiter {
+      bool await_ready() noexcept { return false; }
+
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiter) noexcept {
+        handle.promise().continuation = awaiter;
+        return handle;
+      }
+
+      T await_resume() {
+        auto& promise = handle.promise();
+        if (promise.exception) {
+          std::rethrow_exception(promise.exception);
+        }
+        return std::move(promise.value.value());
+      }
+
+      std::coroutine_handle<promise_type> handle;
+    };
+    return Awaiter{handle_};
+  }
+
+ private:
+  explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+  std::coroutine_handle<promise_type> handle_;
+};
+
+/// \brief Returns an awaitable resuming the awaiting coroutine on a task of the
+/// executor.
+inline auto ScheduleOn(Executor& executor) noexcept {
+  struct Awaiter {
+    bool await_ready() noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+      executor.Submit([handle]() { handle.resume(); });
+    }
+
+    void await_resume() noexcept {}
+
+    Executor& executor;
+  };
+  return Awaiter{executor};
+}
+
+/// \brief Runs a blocking call on an executor, and resumes the awaiting coroutine on
+/// the executor once it returns.
+///
+/// \param executor The executor of the call, the DefaultExecutor() if null
+/// \param call The call, taken by value so that it outlives the task
+template <typename Call>
+Task<std::invoke_result_t<Call&>> RunOn(std::shared_ptr<Executor> executor, Call call) {
+  if (executor == nullptr) {
+    executor = DefaultExecutor();
+  }
+  co_await ScheduleOn(*executor);
+  co_return call();
+}
+
+namespace internal {
+
+/// \brief A coroutine that starts at once and is destroyed when it completes.
+struct DetachedCoroutine {
+  struct promise_type {
+    DetachedCoroutine get_return_object() noexcept { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::terminate(); }
+  };
+};
+
+}  // namespace internal
+
+/// \brief Runs a task to completion, blocking the calling thread until it completes.
+///
+/// This bridges coroutines to blocking code, e.g. in tests or at the top of a thread
+/// that has nothing else to do. It must not be called from a thread that the task
+/// needs to complete, such as the only thread of the executor that it runs on.
+template <typename T>
+T SyncWait(Task<T> task) {
+  struct State {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done = false;
+    std::optional<T> value;
+    std::exception_ptr exception;
+  };
+  State state;
+  [](Task<T> task, State& state) -> internal::DetachedCoroutine {
+    std::optional<T> value;
+    std::exception_ptr exception;
+    try {
+      value.emplace(co_await std::move(task));
+    } catch (...) {
+      exception = std::current_exception();
+    }
+    std::lock_guard lock(state.mutex);
+    state.value = std::move(value);
+    state.exception = std::move(exception);
+    state.done = true;
+    state.cv.notify_all();
+  }(std::move(task), state);
+
+  std::unique_lock lock(state.mutex);
+  state.cv.wait(lock, [&]() { return state.done; });
+  if (state.exception) {
+    std::rethrow_exception(state.exception);
+  }
+  return std::move(state.value.value());
+}
+
+/// \brief Reads the next batch of an Arrow stream, e.g. one returned by
+/// FileScanTask::ToArrow(), without blocking the awaiting coroutine.
+///
+/// \param stream The stream, which must outlive the task
+/// \param executor The executor of the blocking read, the DefaultExecutor() if null
+/// \return The next batch, or nullopt at the end of the stream.
+ICEBERG_EXPORT Task<Result<std::optional<ArrowArray>>> NextAsync(
+    ArrowArrayStream* stream, std::shared_ptr<Executor> executor = nullptr);
+
+}  // namespace iceberg
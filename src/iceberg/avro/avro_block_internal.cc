@@ -0,0 +1,286 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/avro/avro_block_internal.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+#include "iceberg/arrow/arrow_status_internal.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg::avro {
+
+namespace {
+
+constexpr std::string_view kAvroMagic{"Obj\x01", 4};
+// The largest encoding of a long.
+constexpr size_t kMaxLongSize = 10;
+// The size of the first read of the file header, which grows until it holds it.
+constexpr int64_t kHeaderReadSize = 16 * 1024;
+// The size of the reads scanning for a sync marker.
+constexpr int64_t kSyncScanSize = 64 * 1024;
+
+/// \brief Returns the position following the first sync marker that starts at or
+/// after `position`, or the size of the file if there is none.
+Result<int64_t> FindSync(::arrow::io::RandomAccessFile& file, const uint8_t* sync,
+                         int64_t position, int64_t file_size) {
+  constexpr auto kSyncSize = static_cast<int64_t>(kAvroSyncSize);
+  while (file_size - position >= kSyncSize) {
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(
+        auto data, file.ReadAt(position, std::min(kSyncScanSize, file_size - position)));
+    if (data->size() < kSyncSize) {
+      break;
+    }
+    const uint8_t* begin = data->data();
+    const uint8_t* end = begin + data->size();
+    if (auto it = std::search(begin, end, sync, sync + kSyncSize); it != end) {
+      return position + (it - begin) + kSyncSize;
+    }
+    // A marker may start in the last bytes of the range.
+    position += data->size() - (kSyncSize - 1);
+  }
+  return file_size;
+}
+
+}  // namespace
+
+std::optional<std::pair<int64_t, size_t>> DecodeAvroLong(const uint8_t* data,
+                                                         size_t size) {
+  uint64_t encoded = 0;
+  for (size_t i = 0; i < std::min(size, kMaxLongSize); ++i) {
+    encoded |= static_cast<uint64_t>(data[i] & 0x7f) << (7 * i);
+    if ((data[i] & 0x80) == 0) {
+      return std::make_pair(
+          static_cast<int64_t>(encoded >> 1) ^ -static_cast<int64_t>(encoded & 1), i + 1);
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<int64_t> AvroFileHeaderLength(const uint8_t* data, size_t size) {
+  if (size < kAvroMagic.size() ||
+      std::memcmp(data, kAvroMagic.data(), kAvroMagic.size()) != 0) {
+    return std::nullopt;
+  }
+  size_t pos = kAvroMagic.size();
+  // Skips a value of a length followed by as many bytes.
+  auto skip_bytes = [&]() {
+    auto length = DecodeAvroLong(data + pos, size - pos);
+    if (!length.has_value() || length->first < 0 ||
+        static_cast<uint64_t>(length->first) > size - pos - length->second) {
+      return false;
+    }
+    pos += length->second + length->first;
+    return true;
+  };
+
+  // The metadata is a map of blocks of entries, ended by an empty block.
+  while (true) {
+    auto count = DecodeAvroLong(data + pos, size - pos);
+    if (!count.has_value()) {
+      return std::nullopt;
+    }
+    pos += count->second;
+    if (count->first == 0) {
+      break;
+    }
+    if (count->first < 0) {
+      // A negative count is followed by the size of the block in bytes.
+      if (!skip_bytes()) {
+        return std::nullopt;
+      }
+      continue;
+    }
+    // Each entry is a string key and a bytes value.
+    for (int64_t i = 0; i < 2 * count->first; ++i) {
+      if (!skip_bytes()) {
+        return std::nullopt;
+      }
+    }
+  }
+  if (size - pos < kAvroSyncSize) {
+    return std::nullopt;
+  }
+  return static_cast<int64_t>(pos + kAvroSyncSize);
+}
+
+std::optional<AvroBlockHeader> DecodeAvroBlockHeader(const uint8_t* data, size_t size) {
+  auto count = DecodeAvroLong(data, size);
+  if (!count.has_value() || count->first < 0) {
+    return std::nullopt;
+  }
+  auto block_size = DecodeAvroLong(data + count->second, size - count->second);
+  if (!block_size.has_value() || block_size->first < 0 ||
+      block_size->first > std::numeric_limits<int64_t>::max() -
+                              static_cast<int64_t>(kMaxAvroBlockHeaderSize +
+                                                   kAvroSyncSize)) {
+    return std::nullopt;
+  }
+  return AvroBlockHeader{
+      .object_count = count->first,
+      .length = static_cast<int64_t>(count->second + block_size->second) +
+                block_size->first + static_cast<int64_t>(kAvroSyncSize)};
+}
+
+AvroParallelDecoder::AvroParallelDecoder(Options options,
+                                         std::shared_ptr<::arrow::Buffer> header,
+                                         int64_t file_size, int64_t position, int64_t end)
+    : options_(std::move(options)),
+      header_(std::move(header)),
+      file_size_(file_size),
+      position_(position),
+      end_(end),
+      window_(options_.executor, static_cast<size_t>(options_.parallelism),
+              options_.ordered) {}
+
+// Destroying the window waits for the chunks being decoded and never starts the
+// pending ones, so the decode function is not called once the decoder is destroyed.
+AvroParallelDecoder::~AvroParallelDecoder() = default;
+
+Result<std::unique_ptr<AvroParallelDecoder>> AvroParallelDecoder::Make(
+    Options options) {
+  if (options.file == nullptr || options.decode == nullptr ||
+      options.executor == nullptr) {
+    return InvalidArgument("Avro parallel decoding requires a file, a decoder and an "
+                           "executor");
+  }
+  if (options.parallelism < 1 || options.chunk_size < 1) {
+    return InvalidArgument("Invalid Avro decode parallelism {} or chunk size {}",
+                           options.parallelism, options.chunk_size);
+  }
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(auto file_size, options.file->GetSize());
+
+  // Read the header, whose metadata holds the schema, in growing ranges.
+  std::shared_ptr<::arrow::Buffer> header;
+  std::optional<int64_t> header_length;
+  for (int64_t length = std::min(kHeaderReadSize, file_size);;
+       length = std::min(length * 2, file_size)) {
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(header, options.file->ReadAt(0, length));
+    header_length = AvroFileHeaderLength(header->data(), header->size());
+    if (header_length.has_value() || length == file_size) {
+      break;
+    }
+  }
+  if (!header_length.has_value()) {
+    return Invalid("Invalid Avro file header");
+  }
+  header = ::arrow::SliceBuffer(header, 0, header_length.value());
+
+  int64_t position = header_length.value();
+  int64_t end = file_size;
+  if (options.split.has_value()) {
+    const auto [offset, length] = options.split.value();
+    // The marker of the header is the first one to look for, as it precedes the first
+    // block.
+    const auto* sync = header->data() + header->size() - kAvroSyncSize;
+    ICEBERG_ASSIGN_OR_RAISE(
+        position,
+        FindSync(*options.file, sync,
+                 std::max(offset, position - static_cast<int64_t>(kAvroSyncSize)),
+                 file_size));
+    end = std::min(file_size, offset + length + static_cast<int64_t>(kAvroSyncSize));
+  }
+  return std::unique_ptr<AvroParallelDecoder>(new AvroParallelDecoder(
+      std::move(options), std::move(header), file_size, position, end));
+}
+
+Result<std::optional<AvroChunk>> AvroParallelDecoder::ReadChunk() {
+  if (position_ >= end_) {
+    return std::nullopt;
+  }
+  const int64_t remaining = file_size_ - position_;
+  const auto* sync = header_->data() + header_->size() - kAvroSyncSize;
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(
+      auto data,
+      options_.file->ReadAt(position_, std::min(options_.chunk_size, remaining)));
+
+  int64_t length = 0;
+  int64_t rows = 0;
+  while (position_ + length < end_) {
+    auto block = DecodeAvroBlockHeader(data->data() + length,
+                                       static_cast<size_t>(data->size() - length));
+    const int64_t needed =
+        block.has_value() ? block->length : static_cast<int64_t>(kMaxAvroBlockHeaderSize);
+    if (needed > data->size() - length) {
+      if (length > 0) {
+        // The block is read with the next chunk.
+        break;
+      }
+      if (data->size() == remaining) {
+        return Invalid("Truncated Avro block at {}", position_);
+      }
+      // The block is larger than a chunk, so the chunk is the whole block.
+      ICEBERG_ARROW_ASSIGN_OR_RETURN(
+          data, options_.file->ReadAt(position_, std::min(needed, remaining)));
+      continue;
+    }
+    if (!block.has_value()) {
+      return Invalid("Invalid Avro block header at {}", position_ + length);
+    }
+    if (std::memcmp(data->data() + length + block->length - kAvroSyncSize, sync,
+                    kAvroSyncSize) != 0) {
+      return Invalid("Invalid sync marker of the Avro block at {}", position_ + length);
+    }
+    length += block->length;
+    rows += block->object_count;
+  }
+
+  AvroChunk chunk{.data = ::arrow::SliceBuffer(data, 0, length), .first_row = next_row_};
+  position_ += length;
+  next_row_ += rows;
+  return chunk;
+}
+
+Status AvroParallelDecoder::Schedule() {
+  while (!eof_ && !window_.full()) {
+    ICEBERG_ASSIGN_OR_RAISE(auto chunk, ReadChunk());
+    if (!chunk.has_value()) {
+      eof_ = true;
+      break;
+    }
+    window_.Push([decode = options_.decode, header = header_,
+                  chunk = std::move(chunk.value())]() { return decode(header, chunk); });
+  }
+  return {};
+}
+
+Result<std::optional<std::shared_ptr<::arrow::Array>>> AvroParallelDecoder::Next() {
+  while (batches_.empty()) {
+    ICEBERG_RETURN_UNEXPECTED(status_);
+    status_ = Schedule();
+    ICEBERG_RETURN_UNEXPECTED(status_);
+    if (window_.empty()) {
+      return std::nullopt;
+    }
+    auto batches = window_.Take();
+    if (!batches.has_value()) {
+      status_ = std::unexpected(batches.error());
+      return std::unexpected(batches.error());
+    }
+    batches_.assign(batches->begin(), batches->end());
+  }
+  auto batch = std::move(batches_.front());
+  batches_.pop_front();
+  return batch;
+}
+
+}  // namespace iceberg::avro
@@ -0,0 +1,151 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <arrow/array.h>
+#include <arrow/buffer.h>
+#include <arrow/io/interfaces.h>
+
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+#include "iceberg/util/task_window_internal.h"
+
+namespace iceberg::avro {
+
+/// \brief The size of the sync markers following the header and the blocks of an
+/// Avro data file.
+constexpr size_t kAvroSyncSize = 16;
+
+/// \brief The largest encoding of a block header, which holds the number of objects
+/// and the size of the block as two longs of up to 10 bytes.
+constexpr size_t kMaxAvroBlockHeaderSize = 20;
+
+/// \brief Decodes a zig-zag encoded long, returning its value and its encoded size, or
+/// nullopt if the data ends before it or it is invalid.
+std::optional<std::pair<int64_t, size_t>> DecodeAvroLong(const uint8_t* data,
+                                                         size_t size);
+
+/// \brief Returns the length of the header of an Avro data file, up to the end of its
+/// sync marker, or nullopt if the data does not start with a complete header.
+std::optional<int64_t> AvroFileHeaderLength(const uint8_t* data, size_t size);
+
+/// \brief The header of a block of an Avro data file.
+struct AvroBlockHeader {
+  /// \brief The number of objects in the block.
+  int64_t object_count;
+  /// \brief The length of the block, from its header to the end of its sync marker.
+  int64_t length;
+};
+
+/// \brief Decodes the header of a block, or returns nullopt if the data ends before
+/// it or it is invalid, which is the case if at least kMaxAvroBlockHeaderSize bytes
+/// are given.
+std::optional<AvroBlockHeader> DecodeAvroBlockHeader(const uint8_t* data, size_t size);
+
+/// \brief A run of consecutive blocks of an Avro data file.
+struct AvroChunk {
+  /// \brief The blocks, each followed by its sync marker.
+  std::shared_ptr<::arrow::Buffer> data;
+  /// \brief The position in the file of the first object of the chunk.
+  int64_t first_row;
+};
+
+/// \brief Decodes the objects of a chunk into batches of its own.
+using AvroChunkDecoder =
+    std::function<Result<std::vector<std::shared_ptr<::arrow::Array>>>(
+        const std::shared_ptr<::arrow::Buffer>& header, const AvroChunk& chunk)>;
+
+/// \brief Decodes the blocks of an Avro data file in parallel.
+///
+/// Blocks are compressed independently, so they are read in chunks of consecutive
+/// blocks of about `chunk_size` bytes, located from the block headers and checked
+/// against the sync marker of the file, and each chunk is decoded on its own into
+/// batches that end with it. The calling thread reads the chunks, and up to
+/// `parallelism` of them are decoded ahead of the batches taken, by helpers submitted
+/// to the executor and by the calling thread when no helper has claimed the chunk it
+/// needs, so it never waits for a helper that has not started. Batches are returned
+/// in file order when `ordered` is set, and as their chunks are decoded otherwise.
+/// Decoding stops at the first error, which is returned by every later call to Next.
+class AvroParallelDecoder {
+ public:
+  struct Options {
+    /// \brief The file to decode.
+    std::shared_ptr<::arrow::io::RandomAccessFile> file;
+    /// \brief The split of the file to decode: the blocks following the first sync
+    /// marker at or after `offset`, up to the first one whose sync marker starts at or
+    /// after `offset + length`. The whole file if unset.
+    std::optional<std::pair<int64_t, int64_t>> split;
+    /// \brief Decodes the objects of a chunk, called concurrently.
+    AvroChunkDecoder decode;
+    /// \brief The executor of the helpers.
+    std::shared_ptr<Executor> executor;
+    /// \brief The number of chunks decoded at the same time.
+    int32_t parallelism = 1;
+    /// \brief The size that chunks are read in, unless a block is larger.
+    int64_t chunk_size = 4 * 1024 * 1024;
+    /// \brief Whether to return the batches in file order.
+    bool ordered = true;
+  };
+
+  /// \brief Reads the header of the file and locates the start of the split.
+  static Result<std::unique_ptr<AvroParallelDecoder>> Make(Options options);
+
+  /// \brief Stops decoding, waiting for the chunks being decoded by helpers.
+  ~AvroParallelDecoder();
+
+  /// \brief Returns the next batch, or nullopt at the end of the blocks.
+  Result<std::optional<std::shared_ptr<::arrow::Array>>> Next();
+
+ private:
+  AvroParallelDecoder(Options options, std::shared_ptr<::arrow::Buffer> header,
+                      int64_t file_size, int64_t position, int64_t end);
+
+  /// \brief Reads the blocks of the next chunk, or returns nullopt at the end.
+  Result<std::optional<AvroChunk>> ReadChunk();
+
+  /// \brief Reads chunks until `parallelism` chunks are in the window.
+  Status Schedule();
+
+  Options options_;
+  std::shared_ptr<::arrow::Buffer> header_;
+  const int64_t file_size_;
+  // The position of the next chunk, and the position that no block starts at or after.
+  int64_t position_;
+  const int64_t end_;
+  // The position in the file of the first object of the next chunk.
+  int64_t next_row_ = 0;
+  bool eof_ = false;
+  // The batches of the chunk being returned.
+  std::deque<std::shared_ptr<::arrow::Array>> batches_;
+  // The first error, returned by every later call to Next.
+  Status status_;
+  // The chunks read and not taken yet, decoded by helpers.
+  TaskWindow<std::vector<std::shared_ptr<::arrow::Array>>> window_;
+};
+
+}  // namespace iceberg::avro
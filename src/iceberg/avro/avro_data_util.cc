@@ -84,7 +84,12 @@ Status AppendStructToBuilder(const ::avro::NodePtr& avro_node,
       ICEBERG_RETURN_UNEXPECTED(AppendFieldToBuilder(avro_field_node, avro_field_datum,
                                                      field_projection, expected_field,
                                                      field_builder));
-    } else if (field_projection.kind == FieldProjection::Kind::kNull) {
+    } else if (field_projection.kind == FieldProjection::Kind::kNull ||
+               field_projection.kind == FieldProjection::Kind::kMetadata ||
+               field_projection.kind == FieldProjection::Kind::kConstant ||
+               field_projection.kind == FieldProjection::Kind::kDefault) {
+      // Metadata, constant and default columns are placeholders generated by the
+      // reader afterwards.
       ICEBERG_ARROW_RETURN_NOT_OK(field_builder->AppendNull());
     } else {
       return NotImplemented("Unsupported field projection kind: {}",
@@ -433,14 +438,13 @@ Status AppendFieldToBuilder(const ::avro::NodePtr& avro_node,
   }
 
   const auto& projected_type = *projected_field.type();
-  if (projected_type.is_primitive()) {
-    return AppendPrimitiveValueToBuilder(avro_node, avro_datum, projected_field,
-                                         array_builder);
-  } else {
+  if (projected_type.is_nested()) {
     const auto& nested_type = internal::checked_cast<const NestedType&>(projected_type);
     return AppendNestedValueToBuilder(avro_node, avro_datum, projection.children,
                                       nested_type, array_builder);
   }
+  return AppendPrimitiveValueToBuilder(avro_node, avro_datum, projected_field,
+                                       array_builder);
 }
 
 }  // namespace
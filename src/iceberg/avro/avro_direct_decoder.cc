@@ -0,0 +1,710 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/avro/avro_direct_decoder_internal.h"
+
+#include <span>
+
+#include <arrow/array/builder_binary.h>
+#include <arrow/array/builder_decimal.h>
+#include <arrow/array/builder_nested.h>
+#include <arrow/array/builder_primitive.h>
+#include <arrow/util/decimal.h>
+#include <avro/LogicalType.hh>
+#include <avro/Types.hh>
+
+#include "iceberg/arrow/arrow_status_internal.h"
+#include "iceberg/avro/avro_schema_util_internal.h"
+#include "iceberg/schema.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg::avro {
+
+/// \brief A decode step of a node of the Avro file schema.
+struct DecodeNode {
+  using DecodeFn = Status (*)(const DecodeNode& node, ::avro::Decoder& decoder,
+                              DecodeContext& context,
+                              ::arrow::ArrayBuilder* array_builder);
+  using SkipFn = Status (*)(const DecodeNode& node, ::avro::Decoder& decoder);
+
+  /// \brief Decodes a value into the builder of its projected field, or null if the
+  /// value is never projected.
+  DecodeFn decode = nullptr;
+  /// \brief Skips a value.
+  SkipFn skip = nullptr;
+  /// \brief The size of fixed values.
+  size_t fixed_size = 0;
+  /// \brief The steps of the record fields, union branches, array elements, or map
+  /// keys and values.
+  std::vector<DecodeNode> children;
+  /// \brief The position of the projected field of each record field, or -1 if the
+  /// record field is skipped.
+  std::vector<int> positions;
+  /// \brief The positions of the projected fields that are missing in the record.
+  std::vector<int> null_positions;
+};
+
+namespace {
+
+constexpr int kSkippedField = -1;
+
+// Skip steps, by Avro type.
+
+Status SkipNull(const DecodeNode&, ::avro::Decoder& decoder) {
+  decoder.decodeNull();
+  return {};
+}
+
+Status SkipBool(const DecodeNode&, ::avro::Decoder& decoder) {
+  decoder.decodeBool();
+  return {};
+}
+
+Status SkipInt(const DecodeNode&, ::avro::Decoder& decoder) {
+  decoder.decodeInt();
+  return {};
+}
+
+Status SkipLong(const DecodeNode&, ::avro::Decoder& decoder) {
+  decoder.decodeLong();
+  return {};
+}
+
+Status SkipFloat(const DecodeNode&, ::avro::Decoder& decoder) {
+  decoder.decodeFloat();
+  return {};
+}
+
+Status SkipDouble(const DecodeNode&, ::avro::Decoder& decoder) {
+  decoder.decodeDouble();
+  return {};
+}
+
+Status SkipString(const DecodeNode&, ::avro::Decoder& decoder) {
+  decoder.skipString();
+  return {};
+}
+
+Status SkipBytes(const DecodeNode&, ::avro::Decoder& decoder) {
+  decoder.skipBytes();
+  return {};
+}
+
+Status SkipFixed(const DecodeNode& node, ::avro::Decoder& decoder) {
+  decoder.skipFixed(node.fixed_size);
+  return {};
+}
+
+Status SkipEnum(const DecodeNode&, ::avro::Decoder& decoder) {
+  decoder.decodeEnum();
+  return {};
+}
+
+Result<const DecodeNode*> UnionBranch(const DecodeNode& node, ::avro::Decoder& decoder) {
+  const size_t branch = decoder.decodeUnionIndex();
+  if (branch >= node.children.size()) {
+    return InvalidArgument("Avro union branch {} out of bound {}", branch,
+                           node.children.size());
+  }
+  return &node.children[branch];
+}
+
+Status SkipUnion(const DecodeNode& node, ::avro::Decoder& decoder) {
+  ICEBERG_ASSIGN_OR_RAISE(auto branch, UnionBranch(node, decoder));
+  return branch->skip(*branch, decoder);
+}
+
+Status SkipRecord(const DecodeNode& node, ::avro::Decoder& decoder) {
+  for (const auto& child : node.children) {
+    ICEBERG_RETURN_UNEXPECTED(child.skip(child, decoder));
+  }
+  return {};
+}
+
+// Blocks of arrays and maps with a known byte size are skipped at once, only the items
+// of the other blocks are skipped one by one.
+
+Status SkipArray(const DecodeNode& node, ::avro::Decoder& decoder) {
+  const auto& element = node.children[0];
+  for (size_t n = decoder.skipArray(); n != 0; n = decoder.arrayNext()) {
+    for (size_t i = 0; i < n; ++i) {
+      ICEBERG_RETURN_UNEXPECTED(element.skip(element, decoder));
+    }
+  }
+  return {};
+}
+
+Status SkipMap(const DecodeNode& node, ::avro::Decoder& decoder) {
+  const auto& key = node.children[0];
+  const auto& value = node.children[1];
+  for (size_t n = decoder.skipMap(); n != 0; n = decoder.mapNext()) {
+    for (size_t i = 0; i < n; ++i) {
+      ICEBERG_RETURN_UNEXPECTED(key.skip(key, decoder));
+      ICEBERG_RETURN_UNEXPECTED(value.skip(value, decoder));
+    }
+  }
+  return {};
+}
+
+// Decode steps, by projected type.
+
+Status DecodeNull(const DecodeNode&, ::avro::Decoder& decoder, DecodeContext&,
+                  ::arrow::ArrayBuilder* array_builder) {
+  decoder.decodeNull();
+  ICEBERG_ARROW_RETURN_NOT_OK(array_builder->AppendNull());
+  return {};
+}
+
+Status DecodeBool(const DecodeNode&, ::avro::Decoder& decoder, DecodeContext&,
+                  ::arrow::ArrayBuilder* array_builder) {
+  auto* builder = internal::checked_cast<::arrow::BooleanBuilder*>(array_builder);
+  ICEBERG_ARROW_RETURN_NOT_OK(builder->Append(decoder.decodeBool()));
+  return {};
+}
+
+/// \brief Decodes an Avro int into the builder of an int, long or date field.
+template <typename Builder>
+Status DecodeInt(const DecodeNode&, ::avro::Decoder& decoder, DecodeContext&,
+                 ::arrow::ArrayBuilder* array_builder) {
+  auto* builder = internal::checked_cast<Builder*>(array_builder);
+  ICEBERG_ARROW_RETURN_NOT_OK(builder->Append(decoder.decodeInt()));
+  return {};
+}
+
+/// \brief Decodes an Avro long into the builder of a long, time or timestamp field.
+template <typename Builder>
+Status DecodeLong(const DecodeNode&, ::avro::Decoder& decoder, DecodeContext&,
+                  ::arrow::ArrayBuilder* array_builder) {
+  auto* builder = internal::checked_cast<Builder*>(array_builder);
+  ICEBERG_ARROW_RETURN_NOT_OK(builder->Append(decoder.decodeLong()));
+  return {};
+}
+
+/// \brief Decodes an Avro float into the builder of a float or double field.
+template <typename Builder>
+Status DecodeFloat(const DecodeNode&, ::avro::Decoder& decoder, DecodeContext&,
+                   ::arrow::ArrayBuilder* array_builder) {
+  auto* builder = internal::checked_cast<Builder*>(array_builder);
+  ICEBERG_ARROW_RETURN_NOT_OK(builder->Append(decoder.decodeFloat()));
+  return {};
+}
+
+Status DecodeDouble(const DecodeNode&, ::avro::Decoder& decoder, DecodeContext&,
+                    ::arrow::ArrayBuilder* array_builder) {
+  auto* builder = internal::checked_cast<::arrow::DoubleBuilder*>(array_builder);
+  ICEBERG_ARROW_RETURN_NOT_OK(builder->Append(decoder.decodeDouble()));
+  return {};
+}
+
+Status DecodeString(const DecodeNode&, ::avro::Decoder& decoder, DecodeContext& context,
+                    ::arrow::ArrayBuilder* array_builder) {
+  decoder.decodeString(context.string_buffer);
+  auto* builder = internal::checked_cast<::arrow::StringBuilder*>(array_builder);
+  ICEBERG_ARROW_RETURN_NOT_OK(builder->Append(context.string_buffer));
+  return {};
+}
+
+Status DecodeBytes(const DecodeNode&, ::avro::Decoder& decoder, DecodeContext& context,
+                   ::arrow::ArrayBuilder* array_builder) {
+  decoder.decodeBytes(context.bytes_buffer);
+  auto* builder = internal::checked_cast<::arrow::BinaryBuilder*>(array_builder);
+  ICEBERG_ARROW_RETURN_NOT_OK(builder->Append(
+      context.bytes_buffer.data(), static_cast<int32_t>(context.bytes_buffer.size())));
+  return {};
+}
+
+Status DecodeFixed(const DecodeNode& node, ::avro::Decoder& decoder,
+                   DecodeContext& context, ::arrow::ArrayBuilder* array_builder) {
+  decoder.decodeFixed(node.fixed_size, context.bytes_buffer);
+  auto* builder = internal::checked_cast<::arrow::FixedSizeBinaryBuilder*>(array_builder);
+  ICEBERG_ARROW_RETURN_NOT_OK(builder->Append(context.bytes_buffer.data()));
+  return {};
+}
+
+Status DecodeDecimal(const DecodeNode& node, ::avro::Decoder& decoder,
+                     DecodeContext& context, ::arrow::ArrayBuilder* array_builder) {
+  decoder.decodeFixed(node.fixed_size, context.bytes_buffer);
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(
+      auto decimal,
+      ::arrow::Decimal128::FromBigEndian(context.bytes_buffer.data(),
+                                         static_cast<int32_t>(node.fixed_size)));
+  auto* builder = internal::checked_cast<::arrow::Decimal128Builder*>(array_builder);
+  ICEBERG_ARROW_RETURN_NOT_OK(builder->Append(decimal));
+  return {};
+}
+
+Status DecodeUnion(const DecodeNode& node, ::avro::Decoder& decoder,
+                   DecodeContext& context, ::arrow::ArrayBuilder* array_builder) {
+  ICEBERG_ASSIGN_OR_RAISE(auto branch, UnionBranch(node, decoder));
+  return branch->decode(*branch, decoder, context, array_builder);
+}
+
+Status DecodeStruct(const DecodeNode& node, ::avro::Decoder& decoder,
+                    DecodeContext& context, ::arrow::ArrayBuilder* array_builder) {
+  auto* struct_builder = internal::checked_cast<::arrow::StructBuilder*>(array_builder);
+  ICEBERG_ARROW_RETURN_NOT_OK(struct_builder->Append());
+  for (size_t i = 0; i < node.children.size(); ++i) {
+    const auto& child = node.children[i];
+    const int position = node.positions[i];
+    if (position == kSkippedField) {
+      ICEBERG_RETURN_UNEXPECTED(child.skip(child, decoder));
+    } else {
+      ICEBERG_RETURN_UNEXPECTED(child.decode(child, decoder, context,
+                                             struct_builder->field_builder(position)));
+    }
+  }
+  for (int position : node.null_positions) {
+    ICEBERG_ARROW_RETURN_NOT_OK(struct_builder->field_builder(position)->AppendNull());
+  }
+  return {};
+}
+
+Status DecodeList(const DecodeNode& node, ::avro::Decoder& decoder,
+                  DecodeContext& context, ::arrow::ArrayBuilder* array_builder) {
+  auto* list_builder = internal::checked_cast<::arrow::ListBuilder*>(array_builder);
+  ICEBERG_ARROW_RETURN_NOT_OK(list_builder->Append());
+  auto* value_builder = list_builder->value_builder();
+  const auto& element = node.children[0];
+  for (size_t n = decoder.arrayStart(); n != 0; n = decoder.arrayNext()) {
+    for (size_t i = 0; i < n; ++i) {
+      ICEBERG_RETURN_UNEXPECTED(element.decode(element, decoder, context, value_builder));
+    }
+  }
+  return {};
+}
+
+Status DecodeMap(const DecodeNode& node, ::avro::Decoder& decoder, DecodeContext& context,
+                 ::arrow::ArrayBuilder* array_builder) {
+  auto* map_builder = internal::checked_cast<::arrow::MapBuilder*>(array_builder);
+  ICEBERG_ARROW_RETURN_NOT_OK(map_builder->Append());
+  auto* key_builder = map_builder->key_builder();
+  auto* item_builder = map_builder->item_builder();
+  const auto& key = node.children[0];
+  const auto& value = node.children[1];
+  for (size_t n = decoder.mapStart(); n != 0; n = decoder.mapNext()) {
+    for (size_t i = 0; i < n; ++i) {
+      ICEBERG_RETURN_UNEXPECTED(key.decode(key, decoder, context, key_builder));
+      ICEBERG_RETURN_UNEXPECTED(value.decode(value, decoder, context, item_builder));
+    }
+  }
+  return {};
+}
+
+/// \brief Decodes an array of key-value records into the builder of a map field.
+Status DecodeArrayMap(const DecodeNode& node, ::avro::Decoder& decoder,
+                      DecodeContext& context, ::arrow::ArrayBuilder* array_builder) {
+  auto* map_builder = internal::checked_cast<::arrow::MapBuilder*>(array_builder);
+  ICEBERG_ARROW_RETURN_NOT_OK(map_builder->Append());
+  auto* key_builder = map_builder->key_builder();
+  auto* item_builder = map_builder->item_builder();
+  const auto& record = node.children[0];
+  const auto& key = record.children[0];
+  const auto& value = record.children[1];
+  for (size_t n = decoder.arrayStart(); n != 0; n = decoder.arrayNext()) {
+    for (size_t i = 0; i < n; ++i) {
+      ICEBERG_RETURN_UNEXPECTED(key.decode(key, decoder, context, key_builder));
+      ICEBERG_RETURN_UNEXPECTED(value.decode(value, decoder, context, item_builder));
+    }
+  }
+  return {};
+}
+
+// Compilation of the decode steps.
+
+/// \brief Compiles the steps to skip the values of an Avro node.
+Result<DecodeNode> CompileSkip(const ::avro::NodePtr& avro_node) {
+  DecodeNode node;
+  auto compile_leaves = [&]() -> Status {
+    node.children.reserve(avro_node->leaves());
+    for (size_t i = 0; i < avro_node->leaves(); ++i) {
+      ICEBERG_ASSIGN_OR_RAISE(auto child, CompileSkip(avro_node->leafAt(i)));
+      node.children.push_back(std::move(child));
+    }
+    return {};
+  };
+
+  switch (avro_node->type()) {
+    case ::avro::AVRO_NULL:
+      node.skip = SkipNull;
+      break;
+    case ::avro::AVRO_BOOL:
+      node.skip = SkipBool;
+      break;
+    case ::avro::AVRO_INT:
+      node.skip = SkipInt;
+      break;
+    case ::avro::AVRO_LONG:
+      node.skip = SkipLong;
+      break;
+    case ::avro::AVRO_FLOAT:
+      node.skip = SkipFloat;
+      break;
+    case ::avro::AVRO_DOUBLE:
+      node.skip = SkipDouble;
+      break;
+    case ::avro::AVRO_STRING:
+      node.skip = SkipString;
+      break;
+    case ::avro::AVRO_BYTES:
+      node.skip = SkipBytes;
+      break;
+    case ::avro::AVRO_FIXED:
+      node.skip = SkipFixed;
+      node.fixed_size = avro_node->fixedSize();
+      break;
+    case ::avro::AVRO_ENUM:
+      node.skip = SkipEnum;
+      break;
+    case ::avro::AVRO_UNION:
+      node.skip = SkipUnion;
+      ICEBERG_RETURN_UNEXPECTED(compile_leaves());
+      break;
+    case ::avro::AVRO_RECORD:
+      node.skip = SkipRecord;
+      ICEBERG_RETURN_UNEXPECTED(compile_leaves());
+      node.positions.assign(node.children.size(), kSkippedField);
+      break;
+    case ::avro::AVRO_ARRAY:
+      node.skip = SkipArray;
+      ICEBERG_RETURN_UNEXPECTED(compile_leaves());
+      break;
+    case ::avro::AVRO_MAP:
+      node.skip = SkipMap;
+      ICEBERG_RETURN_UNEXPECTED(compile_leaves());
+      break;
+    default:
+      return NotSupported("Unsupported Avro node to decode: {}", ToString(avro_node));
+  }
+  return node;
+}
+
+Result<DecodeNode> CompileField(const ::avro::NodePtr& avro_node,
+                                const FieldProjection& projection,
+                                const SchemaField& projected_field);
+
+Result<DecodeNode> CompileStruct(const ::avro::NodePtr& avro_node,
+                                 std::span<const FieldProjection> projections,
+                                 const StructType& struct_type) {
+  if (avro_node->type() != ::avro::AVRO_RECORD) {
+    return InvalidArgument("Expected Avro record, got type: {}", ToString(avro_node));
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto node, CompileSkip(avro_node));
+  node.decode = DecodeStruct;
+
+  for (size_t i = 0; i < projections.size(); ++i) {
+    const auto& field_projection = projections[i];
+    const auto& expected_field = struct_type.fields()[i];
+    if (field_projection.kind == FieldProjection::Kind::kProjected) {
+      size_t avro_field_index = std::get<size_t>(field_projection.from);
+      if (avro_field_index >= avro_node->leaves()) {
+        return InvalidArgument("Avro field index {} out of bound {}", avro_field_index,
+                               avro_node->leaves());
+      }
+      ICEBERG_ASSIGN_OR_RAISE(node.children[avro_field_index],
+                              CompileField(avro_node->leafAt(avro_field_index),
+                                           field_projection, expected_field));
+      node.positions[avro_field_index] = static_cast<int>(i);
+    } else if (field_projection.kind == FieldProjection::Kind::kNull ||
+               field_projection.kind == FieldProjection::Kind::kMetadata ||
+               field_projection.kind == FieldProjection::Kind::kConstant ||
+               field_projection.kind == FieldProjection::Kind::kDefault) {
+      // Metadata, constant and default columns are placeholders generated by the
+      // reader afterwards.
+      node.null_positions.push_back(static_cast<int>(i));
+    } else {
+      return NotImplemented("Unsupported field projection kind: {}",
+                            ToString(field_projection.kind));
+    }
+  }
+  return node;
+}
+
+Result<DecodeNode> CompileList(const ::avro::NodePtr& avro_node,
+                               const FieldProjection& element_projection,
+                               const ListType& list_type) {
+  if (avro_node->type() != ::avro::AVRO_ARRAY) {
+    return InvalidArgument("Expected Avro array, got type: {}", ToString(avro_node));
+  }
+  DecodeNode node{.decode = DecodeList, .skip = SkipArray};
+  ICEBERG_ASSIGN_OR_RAISE(auto element, CompileField(avro_node->leafAt(0),
+                                                     element_projection,
+                                                     list_type.fields().back()));
+  node.children.push_back(std::move(element));
+  return node;
+}
+
+Result<DecodeNode> CompileMap(const ::avro::NodePtr& avro_node,
+                              const FieldProjection& key_projection,
+                              const FieldProjection& value_projection,
+                              const MapType& map_type) {
+  auto compile_entry = [&](const ::avro::NodePtr& key_node,
+                           const ::avro::NodePtr& value_node,
+                           DecodeNode& entry) -> Status {
+    ICEBERG_ASSIGN_OR_RAISE(auto key,
+                            CompileField(key_node, key_projection, map_type.key()));
+    ICEBERG_ASSIGN_OR_RAISE(auto value,
+                            CompileField(value_node, value_projection, map_type.value()));
+    entry.children.push_back(std::move(key));
+    entry.children.push_back(std::move(value));
+    return {};
+  };
+
+  if (avro_node->type() == ::avro::AVRO_MAP) {
+    // Handle regular Avro map: map<string, value>
+    DecodeNode node{.decode = DecodeMap, .skip = SkipMap};
+    ICEBERG_RETURN_UNEXPECTED(
+        compile_entry(avro_node->leafAt(0), avro_node->leafAt(1), node));
+    return node;
+  } else if (avro_node->type() == ::avro::AVRO_ARRAY && HasMapLogicalType(avro_node)) {
+    // Handle array-based map: list<struct<key, value>>
+    const auto& record_node = avro_node->leafAt(0);
+    if (record_node->type() != ::avro::AVRO_RECORD || record_node->leaves() != 2) {
+      return InvalidArgument(
+          "Array-based map must contain records with exactly 2 fields, got: {}",
+          ToString(record_node));
+    }
+    DecodeNode record{.skip = SkipRecord};
+    ICEBERG_RETURN_UNEXPECTED(
+        compile_entry(record_node->leafAt(0), record_node->leafAt(1), record));
+    DecodeNode node{.decode = DecodeArrayMap, .skip = SkipArray};
+    node.children.push_back(std::move(record));
+    return node;
+  } else {
+    return InvalidArgument("Expected Avro map or array with map logical type, got: {}",
+                           ToString(avro_node));
+  }
+}
+
+Result<DecodeNode> CompilePrimitive(const ::avro::NodePtr& avro_node,
+                                    const SchemaField& projected_field) {
+  const auto& projected_type = *projected_field.type();
+  ICEBERG_ASSIGN_OR_RAISE(auto node, CompileSkip(avro_node));
+  const auto avro_type = avro_node->type();
+  const auto logical_type = avro_node->logicalType().type();
+
+  switch (projected_type.type_id()) {
+    case TypeId::kBoolean:
+      if (avro_type != ::avro::AVRO_BOOL) {
+        return InvalidArgument("Expected Avro boolean for boolean field, got: {}",
+                               ToString(avro_node));
+      }
+      node.decode = DecodeBool;
+      return node;
+
+    case TypeId::kInt:
+      if (avro_type != ::avro::AVRO_INT) {
+        return InvalidArgument("Expected Avro int for int field, got: {}",
+                               ToString(avro_node));
+      }
+      node.decode = DecodeInt<::arrow::Int32Builder>;
+      return node;
+
+    case TypeId::kLong:
+      if (avro_type == ::avro::AVRO_LONG) {
+        node.decode = DecodeLong<::arrow::Int64Builder>;
+      } else if (avro_type == ::avro::AVRO_INT) {
+        node.decode = DecodeInt<::arrow::Int64Builder>;
+      } else {
+        return InvalidArgument("Expected Avro int/long for long field, got: {}",
+                               ToString(avro_node));
+      }
+      return node;
+
+    case TypeId::kFloat:
+      if (avro_type != ::avro::AVRO_FLOAT) {
+        return InvalidArgument("Expected Avro float for float field, got: {}",
+                               ToString(avro_node));
+      }
+      node.decode = DecodeFloat<::arrow::FloatBuilder>;
+      return node;
+
+    case TypeId::kDouble:
+      if (avro_type == ::avro::AVRO_DOUBLE) {
+        node.decode = DecodeDouble;
+      } else if (avro_type == ::avro::AVRO_FLOAT) {
+        node.decode = DecodeFloat<::arrow::DoubleBuilder>;
+      } else {
+        return InvalidArgument("Expected Avro float/double for double field, got: {}",
+                               ToString(avro_node));
+      }
+      return node;
+
+    case TypeId::kString:
+      if (avro_type != ::avro::AVRO_STRING) {
+        return InvalidArgument("Expected Avro string for string field, got: {}",
+                               ToString(avro_node));
+      }
+      node.decode = DecodeString;
+      return node;
+
+    case TypeId::kBinary:
+      if (avro_type != ::avro::AVRO_BYTES) {
+        return InvalidArgument("Expected Avro bytes for binary field, got: {}",
+                               ToString(avro_node));
+      }
+      node.decode = DecodeBytes;
+      return node;
+
+    case TypeId::kFixed: {
+      const auto& fixed_type = internal::checked_cast<const FixedType&>(projected_type);
+      if (avro_type != ::avro::AVRO_FIXED) {
+        return InvalidArgument("Expected Avro fixed for fixed field, got: {}",
+                               ToString(avro_node));
+      }
+      if (node.fixed_size != static_cast<size_t>(fixed_type.length())) {
+        return InvalidArgument("Expected Avro fixed[{}], got: {}", fixed_type.length(),
+                               ToString(avro_node));
+      }
+      node.decode = DecodeFixed;
+      return node;
+    }
+
+    case TypeId::kUuid:
+      if (avro_type != ::avro::AVRO_FIXED || logical_type != ::avro::LogicalType::UUID) {
+        return InvalidArgument("Expected Avro fixed for uuid field, got: {}",
+                               ToString(avro_node));
+      }
+      if (node.fixed_size != 16) {
+        return InvalidArgument("Expected UUID fixed length 16, got: {}",
+                               node.fixed_size);
+      }
+      node.decode = DecodeFixed;
+      return node;
+
+    case TypeId::kDecimal:
+      if (avro_type != ::avro::AVRO_FIXED ||
+          logical_type != ::avro::LogicalType::DECIMAL) {
+        return InvalidArgument(
+            "Expected Avro fixed with decimal logical type for decimal field, got: {}",
+            ToString(avro_node));
+      }
+      node.decode = DecodeDecimal;
+      return node;
+
+    case TypeId::kDate:
+      if (avro_type != ::avro::AVRO_INT || logical_type != ::avro::LogicalType::DATE) {
+        return InvalidArgument(
+            "Expected Avro int with DATE logical type for date field, got: {}",
+            ToString(avro_node));
+      }
+      node.decode = DecodeInt<::arrow::Date32Builder>;
+      return node;
+
+    case TypeId::kTime:
+      if (avro_type != ::avro::AVRO_LONG ||
+          logical_type != ::avro::LogicalType::TIME_MICROS) {
+        return InvalidArgument(
+            "Expected Avro long with TIME_MICROS for time field, got: {}",
+            ToString(avro_node));
+      }
+      node.decode = DecodeLong<::arrow::Time64Builder>;
+      return node;
+
+    case TypeId::kTimestamp:
+    case TypeId::kTimestampTz:
+      if (avro_type != ::avro::AVRO_LONG ||
+          logical_type != ::avro::LogicalType::TIMESTAMP_MICROS) {
+        return InvalidArgument(
+            "Expected Avro long with TIMESTAMP_MICROS for timestamp field, got: {}",
+            ToString(avro_node));
+      }
+      node.decode = DecodeLong<::arrow::TimestampBuilder>;
+      return node;
+
+    default:
+      return InvalidArgument("Unsupported primitive type {} to decode avro node {}",
+                             projected_field.type()->ToString(), ToString(avro_node));
+  }
+}
+
+/// \brief Compiles the steps to decode the values of an Avro node into the builder of
+/// a projected field.
+Result<DecodeNode> CompileField(const ::avro::NodePtr& avro_node,
+                                const FieldProjection& projection,
+                                const SchemaField& projected_field) {
+  if (avro_node->type() == ::avro::AVRO_UNION) {
+    DecodeNode node{.decode = DecodeUnion, .skip = SkipUnion};
+    node.children.reserve(avro_node->leaves());
+    for (size_t i = 0; i < avro_node->leaves(); ++i) {
+      const auto& branch_node = avro_node->leafAt(i);
+      if (branch_node->type() == ::avro::AVRO_NULL) {
+        node.children.push_back(DecodeNode{.decode = DecodeNull, .skip = SkipNull});
+        continue;
+      }
+      ICEBERG_ASSIGN_OR_RAISE(auto branch,
+                              CompileField(branch_node, projection, projected_field));
+      node.children.push_back(std::move(branch));
+    }
+    return node;
+  }
+
+  const auto& projected_type = *projected_field.type();
+  switch (projected_type.type_id()) {
+    case TypeId::kStruct:
+      return CompileStruct(avro_node, projection.children,
+                           internal::checked_cast<const StructType&>(projected_type));
+    case TypeId::kList:
+      if (projection.children.size() != 1) {
+        return InvalidArgument("Expected 1 projection for list, got: {}",
+                               projection.children.size());
+      }
+      return CompileList(avro_node, projection.children[0],
+                         internal::checked_cast<const ListType&>(projected_type));
+    case TypeId::kMap:
+      if (projection.children.size() != 2) {
+        return InvalidArgument("Expected 2 projections for map, got: {}",
+                               projection.children.size());
+      }
+      return CompileMap(avro_node, projection.children[0], projection.children[1],
+                        internal::checked_cast<const MapType&>(projected_type));
+    default:
+      return CompilePrimitive(avro_node, projected_field);
+  }
+}
+
+}  // namespace
+
+AvroDirectDecoder::AvroDirectDecoder(std::unique_ptr<DecodeNode> root)
+    : root_(std::move(root)) {}
+
+AvroDirectDecoder::~AvroDirectDecoder() = default;
+
+AvroDirectDecoder::AvroDirectDecoder(AvroDirectDecoder&&) noexcept = default;
+
+AvroDirectDecoder& AvroDirectDecoder::operator=(AvroDirectDecoder&&) noexcept = default;
+
+Result<AvroDirectDecoder> AvroDirectDecoder::Make(const ::avro::NodePtr& avro_node,
+                                                  const SchemaProjection& projection,
+                                                  const Schema& projected_schema) {
+  ICEBERG_ASSIGN_OR_RAISE(auto root,
+                          CompileStruct(avro_node, projection.fields, projected_schema));
+  return AvroDirectDecoder(std::make_unique<DecodeNode>(std::move(root)));
+}
+
+Status AvroDirectDecoder::Decode(::avro::Decoder& decoder,
+                                 ::arrow::ArrayBuilder* array_builder) {
+  return root_->decode(*root_, decoder, context_, array_builder);
+}
+
+Status AvroDirectDecoder::Skip(::avro::Decoder& decoder) {
+  return root_->skip(*root_, decoder);
+}
+
+}  // namespace iceberg::avro
@@ -0,0 +1,83 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <arrow/array/builder_base.h>
+#include <avro/Decoder.hh>
+#include <avro/Node.hh>
+
+#include "iceberg/schema_util.h"
+
+namespace iceberg::avro {
+
+struct DecodeNode;
+
+/// \brief Scratch buffers reused across the decoded values.
+struct DecodeContext {
+  std::string string_buffer;
+  std::vector<uint8_t> bytes_buffer;
+};
+
+/// \brief Decodes Avro binary records straight into an Arrow struct builder.
+///
+/// The projected schema is resolved against the Avro file schema once, into a tree of
+/// decode steps with one step per node of the file schema. Projected values are decoded
+/// into the builders of their projected fields and other values are skipped, without
+/// materializing an intermediate `::avro::GenericDatum`.
+class AvroDirectDecoder {
+ public:
+  ~AvroDirectDecoder();
+
+  AvroDirectDecoder(AvroDirectDecoder&&) noexcept;
+  AvroDirectDecoder& operator=(AvroDirectDecoder&&) noexcept;
+
+  /// \brief Compiles the decode steps of a projection.
+  ///
+  /// \param avro_node The Avro file schema node (must be a record at root level)
+  /// \param projection Schema projection from `projected_schema` to `avro_node`
+  /// \param projected_schema The projected schema
+  /// \return A Result containing the decoder, or an error if a projected field cannot
+  /// be decoded from its Avro node.
+  static Result<AvroDirectDecoder> Make(const ::avro::NodePtr& avro_node,
+                                        const SchemaProjection& projection,
+                                        const Schema& projected_schema);
+
+  /// \brief Decodes the next record and appends it to the builder.
+  ///
+  /// \param decoder The decoder positioned at the start of a record
+  /// \param array_builder The struct builder of the projected schema
+  Status Decode(::avro::Decoder& decoder, ::arrow::ArrayBuilder* array_builder);
+
+  /// \brief Skips the next record.
+  Status Skip(::avro::Decoder& decoder);
+
+ private:
+  explicit AvroDirectDecoder(std::unique_ptr<DecodeNode> root);
+
+  std::unique_ptr<DecodeNode> root_;
+  DecodeContext context_;
+};
+
+}  // namespace iceberg::avro
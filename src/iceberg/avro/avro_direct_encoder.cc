@@ -0,0 +1,399 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/avro/avro_direct_encoder_internal.h"
+
+#include <algorithm>
+#include <array>
+#include <string_view>
+#include <vector>
+
+#include <arrow/array/array_binary.h>
+#include <arrow/array/array_decimal.h>
+#include <arrow/array/array_nested.h>
+#include <arrow/array/array_primitive.h>
+#include <arrow/extension_type.h>
+#include <avro/Types.hh>
+
+#include "iceberg/avro/avro_schema_util_internal.h"
+#include "iceberg/schema.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg::avro {
+
+/// \brief An encode step of a node of the Avro schema.
+struct EncodeNode {
+  using EncodeFn = Status (*)(const EncodeNode& node, const ::arrow::Array& array,
+                              int64_t index, ::avro::Encoder& encoder);
+
+  /// \brief Encodes a non-null value of the array.
+  EncodeFn encode = nullptr;
+  /// \brief Whether the Avro node is a union of null and the value.
+  bool optional = false;
+  /// \brief The size of fixed values.
+  size_t fixed_size = 0;
+  /// \brief The steps of the record fields, list elements, or map keys and values.
+  std::vector<EncodeNode> children;
+};
+
+namespace {
+
+// ToAvroNodeVisitor uses 0 for null branch and 1 for value branch.
+constexpr size_t kNullBranch = 0;
+constexpr size_t kValueBranch = 1;
+
+Status EncodeValue(const EncodeNode& node, const ::arrow::Array& array, int64_t index,
+                   ::avro::Encoder& encoder) {
+  if (node.optional) {
+    if (array.IsNull(index)) {
+      encoder.encodeUnionIndex(kNullBranch);
+      encoder.encodeNull();
+      return {};
+    }
+    encoder.encodeUnionIndex(kValueBranch);
+  } else if (array.IsNull(index)) [[unlikely]] {
+    return InvalidSchema("Cannot encode null of {} as a non-union Avro type",
+                         array.type()->ToString());
+  }
+  return node.encode(node, array, index, encoder);
+}
+
+// Encode steps, by Arrow array type.
+
+Status EncodeBool(const EncodeNode&, const ::arrow::Array& array, int64_t index,
+                  ::avro::Encoder& encoder) {
+  encoder.encodeBool(
+      internal::checked_cast<const ::arrow::BooleanArray&>(array).Value(index));
+  return {};
+}
+
+template <typename ArrayType>
+Status EncodeInt(const EncodeNode&, const ::arrow::Array& array, int64_t index,
+                 ::avro::Encoder& encoder) {
+  encoder.encodeInt(internal::checked_cast<const ArrayType&>(array).Value(index));
+  return {};
+}
+
+template <typename ArrayType>
+Status EncodeLong(const EncodeNode&, const ::arrow::Array& array, int64_t index,
+                  ::avro::Encoder& encoder) {
+  encoder.encodeLong(internal::checked_cast<const ArrayType&>(array).Value(index));
+  return {};
+}
+
+Status EncodeFloat(const EncodeNode&, const ::arrow::Array& array, int64_t index,
+                   ::avro::Encoder& encoder) {
+  encoder.encodeFloat(
+      internal::checked_cast<const ::arrow::FloatArray&>(array).Value(index));
+  return {};
+}
+
+Status EncodeDouble(const EncodeNode&, const ::arrow::Array& array, int64_t index,
+                    ::avro::Encoder& encoder) {
+  encoder.encodeDouble(
+      internal::checked_cast<const ::arrow::DoubleArray&>(array).Value(index));
+  return {};
+}
+
+/// \brief Encodes a string or binary value. Avro strings and bytes share their
+/// encoding, so strings are written from a view instead of a copy.
+Status EncodeBytes(const EncodeNode&, const ::arrow::Array& array, int64_t index,
+                   ::avro::Encoder& encoder) {
+  std::string_view value =
+      internal::checked_cast<const ::arrow::BinaryArray&>(array).GetView(index);
+  encoder.encodeBytes(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+  return {};
+}
+
+Status EncodeFixed(const EncodeNode& node, const ::arrow::Array& array, int64_t index,
+                   ::avro::Encoder& encoder) {
+  // UUIDs are arrow.uuid extension arrays of fixed size binary storage.
+  const auto& storage =
+      array.type_id() == ::arrow::Type::EXTENSION
+          ? *internal::checked_cast<const ::arrow::ExtensionArray&>(array).storage()
+          : array;
+  std::string_view value =
+      internal::checked_cast<const ::arrow::FixedSizeBinaryArray&>(storage).GetView(
+          index);
+  if (value.size() != node.fixed_size) [[unlikely]] {
+    return InvalidArgument("Cannot encode {} bytes as Avro fixed of size {}",
+                           value.size(), node.fixed_size);
+  }
+  encoder.encodeFixed(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+  return {};
+}
+
+/// \brief Encodes a decimal as the big-endian two's complement bytes of its unscaled
+/// value, truncated to the size of the Avro fixed.
+Status EncodeDecimal(const EncodeNode& node, const ::arrow::Array& array, int64_t index,
+                     ::avro::Encoder& encoder) {
+  std::string_view value =
+      internal::checked_cast<const ::arrow::Decimal128Array&>(array).GetView(index);
+  std::array<uint8_t, 16> bytes;
+  std::ranges::reverse_copy(value, bytes.begin());
+  encoder.encodeFixed(bytes.data() + bytes.size() - node.fixed_size, node.fixed_size);
+  return {};
+}
+
+Status EncodeStruct(const EncodeNode& node, const ::arrow::Array& array, int64_t index,
+                    ::avro::Encoder& encoder) {
+  const auto& struct_array = internal::checked_cast<const ::arrow::StructArray&>(array);
+  for (size_t i = 0; i < node.children.size(); ++i) {
+    ICEBERG_RETURN_UNEXPECTED(EncodeValue(
+        node.children[i], *struct_array.field(static_cast<int>(i)), index, encoder));
+  }
+  return {};
+}
+
+Status EncodeList(const EncodeNode& node, const ::arrow::Array& array, int64_t index,
+                  ::avro::Encoder& encoder) {
+  const auto& list_array = internal::checked_cast<const ::arrow::ListArray&>(array);
+  const auto start = list_array.value_offset(index);
+  const auto end = list_array.value_offset(index + 1);
+  const auto& values = *list_array.values();
+  encoder.arrayStart();
+  if (end > start) {
+    encoder.setItemCount(static_cast<size_t>(end - start));
+    for (auto i = start; i < end; ++i) {
+      encoder.startItem();
+      ICEBERG_RETURN_UNEXPECTED(EncodeValue(node.children[0], values, i, encoder));
+    }
+  }
+  encoder.arrayEnd();
+  return {};
+}
+
+/// \brief Encodes a map as an Avro map, whose keys are strings.
+Status EncodeMap(const EncodeNode& node, const ::arrow::Array& array, int64_t index,
+                 ::avro::Encoder& encoder) {
+  const auto& map_array = internal::checked_cast<const ::arrow::MapArray&>(array);
+  const auto start = map_array.value_offset(index);
+  const auto end = map_array.value_offset(index + 1);
+  const auto& keys = *map_array.keys();
+  const auto& items = *map_array.items();
+  encoder.mapStart();
+  if (end > start) {
+    encoder.setItemCount(static_cast<size_t>(end - start));
+    for (auto i = start; i < end; ++i) {
+      encoder.startItem();
+      ICEBERG_RETURN_UNEXPECTED(EncodeBytes(node.children[0], keys, i, encoder));
+      ICEBERG_RETURN_UNEXPECTED(EncodeValue(node.children[1], items, i, encoder));
+    }
+  }
+  encoder.mapEnd();
+  return {};
+}
+
+/// \brief Encodes a map as an Avro array of key-value records, for keys that are not
+/// strings.
+Status EncodeMapArray(const EncodeNode& node, const ::arrow::Array& array,
+                      int64_t index, ::avro::Encoder& encoder) {
+  const auto& map_array = internal::checked_cast<const ::arrow::MapArray&>(array);
+  const auto start = map_array.value_offset(index);
+  const auto end = map_array.value_offset(index + 1);
+  const auto& keys = *map_array.keys();
+  const auto& items = *map_array.items();
+  encoder.arrayStart();
+  if (end > start) {
+    encoder.setItemCount(static_cast<size_t>(end - start));
+    for (auto i = start; i < end; ++i) {
+      encoder.startItem();
+      ICEBERG_RETURN_UNEXPECTED(EncodeValue(node.children[0], keys, i, encoder));
+      ICEBERG_RETURN_UNEXPECTED(EncodeValue(node.children[1], items, i, encoder));
+    }
+  }
+  encoder.arrayEnd();
+  return {};
+}
+
+Status ExpectAvroType(const ::avro::NodePtr& avro_node, ::avro::Type avro_type,
+                      const Type& type) {
+  if (avro_node->type() != avro_type) {
+    return InvalidArgument("Expected Avro {} for {} field, got: {}",
+                           ::avro::toString(avro_type), type.ToString(),
+                           ToString(avro_node));
+  }
+  return {};
+}
+
+Result<EncodeNode> CompileField(const ::avro::NodePtr& avro_node,
+                                const SchemaField& field);
+
+Result<EncodeNode> CompileStruct(const ::avro::NodePtr& avro_node,
+                                 const StructType& struct_type) {
+  ICEBERG_RETURN_UNEXPECTED(ExpectAvroType(avro_node, ::avro::AVRO_RECORD, struct_type));
+  const auto fields = struct_type.fields();
+  if (avro_node->leaves() != fields.size()) {
+    return InvalidArgument("Expected Avro record with {} fields, got: {}", fields.size(),
+                           ToString(avro_node));
+  }
+  EncodeNode node{.encode = EncodeStruct};
+  node.children.reserve(fields.size());
+  for (size_t i = 0; i < fields.size(); ++i) {
+    ICEBERG_ASSIGN_OR_RAISE(auto child, CompileField(avro_node->leafAt(i), fields[i]));
+    node.children.push_back(std::move(child));
+  }
+  return node;
+}
+
+Result<EncodeNode> CompileList(const ::avro::NodePtr& avro_node,
+                               const ListType& list_type) {
+  ICEBERG_RETURN_UNEXPECTED(ExpectAvroType(avro_node, ::avro::AVRO_ARRAY, list_type));
+  EncodeNode node{.encode = EncodeList};
+  ICEBERG_ASSIGN_OR_RAISE(auto element,
+                          CompileField(avro_node->leafAt(0), list_type.fields().back()));
+  node.children.push_back(std::move(element));
+  return node;
+}
+
+Result<EncodeNode> CompileMap(const ::avro::NodePtr& avro_node, const MapType& map_type) {
+  if (avro_node->type() == ::avro::AVRO_MAP) {
+    if (map_type.key().type()->type_id() != TypeId::kString) {
+      return InvalidArgument("Expected string keys for Avro map, got: {}",
+                             map_type.ToString());
+    }
+    EncodeNode node{.encode = EncodeMap};
+    node.children.push_back(EncodeNode{.encode = EncodeBytes});
+    ICEBERG_ASSIGN_OR_RAISE(auto value,
+                            CompileField(avro_node->leafAt(1), map_type.value()));
+    node.children.push_back(std::move(value));
+    return node;
+  }
+
+  ICEBERG_RETURN_UNEXPECTED(ExpectAvroType(avro_node, ::avro::AVRO_ARRAY, map_type));
+  const auto& record_node = avro_node->leafAt(0);
+  if (record_node->type() != ::avro::AVRO_RECORD || record_node->leaves() != 2) {
+    return InvalidArgument("Expected Avro record with 2 fields for map value, got: {}",
+                           ToString(record_node));
+  }
+  EncodeNode node{.encode = EncodeMapArray};
+  ICEBERG_ASSIGN_OR_RAISE(auto key, CompileField(record_node->leafAt(0), map_type.key()));
+  ICEBERG_ASSIGN_OR_RAISE(auto value,
+                          CompileField(record_node->leafAt(1), map_type.value()));
+  node.children.push_back(std::move(key));
+  node.children.push_back(std::move(value));
+  return node;
+}
+
+Result<EncodeNode> CompilePrimitive(const ::avro::NodePtr& avro_node, const Type& type) {
+  switch (type.type_id()) {
+    case TypeId::kBoolean:
+      ICEBERG_RETURN_UNEXPECTED(ExpectAvroType(avro_node, ::avro::AVRO_BOOL, type));
+      return EncodeNode{.encode = EncodeBool};
+    case TypeId::kInt:
+      ICEBERG_RETURN_UNEXPECTED(ExpectAvroType(avro_node, ::avro::AVRO_INT, type));
+      return EncodeNode{.encode = EncodeInt<::arrow::Int32Array>};
+    case TypeId::kDate:
+      ICEBERG_RETURN_UNEXPECTED(ExpectAvroType(avro_node, ::avro::AVRO_INT, type));
+      return EncodeNode{.encode = EncodeInt<::arrow::Date32Array>};
+    case TypeId::kLong:
+      ICEBERG_RETURN_UNEXPECTED(ExpectAvroType(avro_node, ::avro::AVRO_LONG, type));
+      return EncodeNode{.encode = EncodeLong<::arrow::Int64Array>};
+    case TypeId::kTime:
+      ICEBERG_RETURN_UNEXPECTED(ExpectAvroType(avro_node, ::avro::AVRO_LONG, type));
+      return EncodeNode{.encode = EncodeLong<::arrow::Time64Array>};
+    case TypeId::kTimestamp:
+    case TypeId::kTimestampTz:
+      ICEBERG_RETURN_UNEXPECTED(ExpectAvroType(avro_node, ::avro::AVRO_LONG, type));
+      return EncodeNode{.encode = EncodeLong<::arrow::TimestampArray>};
+    case TypeId::kFloat:
+      ICEBERG_RETURN_UNEXPECTED(ExpectAvroType(avro_node, ::avro::AVRO_FLOAT, type));
+      return EncodeNode{.encode = EncodeFloat};
+    case TypeId::kDouble:
+      ICEBERG_RETURN_UNEXPECTED(ExpectAvroType(avro_node, ::avro::AVRO_DOUBLE, type));
+      return EncodeNode{.encode = EncodeDouble};
+    case TypeId::kString:
+      ICEBERG_RETURN_UNEXPECTED(ExpectAvroType(avro_node, ::avro::AVRO_STRING, type));
+      return EncodeNode{.encode = EncodeBytes};
+    case TypeId::kBinary:
+      ICEBERG_RETURN_UNEXPECTED(ExpectAvroType(avro_node, ::avro::AVRO_BYTES, type));
+      return EncodeNode{.encode = EncodeBytes};
+    case TypeId::kDecimal:
+      ICEBERG_RETURN_UNEXPECTED(ExpectAvroType(avro_node, ::avro::AVRO_FIXED, type));
+      if (avro_node->fixedSize() > 16) {
+        return InvalidArgument("Expected Avro fixed of at most 16 bytes for {}, got: {}",
+                               type.ToString(), ToString(avro_node));
+      }
+      return EncodeNode{.encode = EncodeDecimal, .fixed_size = avro_node->fixedSize()};
+    case TypeId::kUuid:
+    case TypeId::kFixed:
+      ICEBERG_RETURN_UNEXPECTED(ExpectAvroType(avro_node, ::avro::AVRO_FIXED, type));
+      return EncodeNode{.encode = EncodeFixed, .fixed_size = avro_node->fixedSize()};
+    default:
+      return NotSupported("Unsupported type {} to encode as avro node {}",
+                          type.ToString(), ToString(avro_node));
+  }
+}
+
+/// \brief Compiles the steps to encode the values of a field as an Avro node.
+Result<EncodeNode> CompileField(const ::avro::NodePtr& avro_node,
+                                const SchemaField& field) {
+  if (avro_node->type() == ::avro::AVRO_UNION) {
+    if (avro_node->leaves() != 2 ||
+        avro_node->leafAt(kNullBranch)->type() != ::avro::AVRO_NULL) {
+      return InvalidArgument("Expected Avro union of null and a value for {}, got: {}",
+                             field.name(), ToString(avro_node));
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto node,
+                            CompileField(avro_node->leafAt(kValueBranch), field));
+    node.optional = true;
+    return node;
+  }
+
+  const auto& type = *field.type();
+  switch (type.type_id()) {
+    case TypeId::kStruct:
+      return CompileStruct(avro_node, internal::checked_cast<const StructType&>(type));
+    case TypeId::kList:
+      return CompileList(avro_node, internal::checked_cast<const ListType&>(type));
+    case TypeId::kMap:
+      return CompileMap(avro_node, internal::checked_cast<const MapType&>(type));
+    default:
+      return CompilePrimitive(avro_node, type);
+  }
+}
+
+}  // namespace
+
+AvroDirectEncoder::AvroDirectEncoder(std::unique_ptr<EncodeNode> root)
+    : root_(std::move(root)) {}
+
+AvroDirectEncoder::~AvroDirectEncoder() = default;
+
+AvroDirectEncoder::AvroDirectEncoder(AvroDirectEncoder&&) noexcept = default;
+
+AvroDirectEncoder& AvroDirectEncoder::operator=(AvroDirectEncoder&&) noexcept = default;
+
+Result<AvroDirectEncoder> AvroDirectEncoder::Make(const ::avro::NodePtr& avro_node,
+                                                  const Schema& schema) {
+  ICEBERG_ASSIGN_OR_RAISE(auto root, CompileStruct(avro_node, schema));
+  return AvroDirectEncoder(std::make_unique<EncodeNode>(std::move(root)));
+}
+
+Status AvroDirectEncoder::Encode(const ::arrow::Array& array, int64_t index,
+                                 ::avro::Encoder& encoder) {
+  if (index < 0 || index >= array.length()) {
+    return InvalidArgument("Cannot encode row {} of array of length {}", index,
+                           array.length());
+  }
+  return root_->encode(*root_, array, index, encoder);
+}
+
+}  // namespace iceberg::avro
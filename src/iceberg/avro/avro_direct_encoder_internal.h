@@ -0,0 +1,71 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include <arrow/array/array_base.h>
+#include <avro/Encoder.hh>
+#include <avro/Node.hh>
+
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg::avro {
+
+struct EncodeNode;
+
+/// \brief Encodes the rows of Arrow struct arrays straight as Avro binary records.
+///
+/// The write schema is resolved against its Avro schema once, into a tree of encode
+/// steps with one step per node of the Avro schema. The values of each row are then
+/// written to the encoder from the Arrow columns, without materializing an intermediate
+/// `::avro::GenericDatum`.
+class AvroDirectEncoder {
+ public:
+  ~AvroDirectEncoder();
+
+  AvroDirectEncoder(AvroDirectEncoder&&) noexcept;
+  AvroDirectEncoder& operator=(AvroDirectEncoder&&) noexcept;
+
+  /// \brief Compiles the encode steps of a write schema.
+  ///
+  /// \param avro_node The Avro schema node of `schema` (must be a record at root level)
+  /// \param schema The write schema, whose Arrow arrays are encoded
+  /// \return A Result containing the encoder, or an error if a field cannot be encoded
+  /// as its Avro node.
+  static Result<AvroDirectEncoder> Make(const ::avro::NodePtr& avro_node,
+                                        const Schema& schema);
+
+  /// \brief Encodes a row of a struct array of the write schema as a record.
+  ///
+  /// \param array The struct array of the rows
+  /// \param index The index of the row to encode
+  /// \param encoder The encoder positioned at the start of a record
+  Status Encode(const ::arrow::Array& array, int64_t index, ::avro::Encoder& encoder);
+
+ private:
+  explicit AvroDirectEncoder(std::unique_ptr<EncodeNode> root);
+
+  std::unique_ptr<EncodeNode> root_;
+};
+
+}  // namespace iceberg::avro
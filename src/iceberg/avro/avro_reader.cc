@@ -19,7 +19,15 @@
 
 #include "iceberg/avro/avro_reader.h"
 
+#include <algorithm>
+#include <charconv>
+#include <format>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <variant>
 
 #include <arrow/array/builder_base.h>
 #include <arrow/c/bridge.h>
@@ -27,46 +35,309 @@
 #include <arrow/record_batch.h>
 #include <arrow/result.h>
 #include <arrow/type.h>
+#include <arrow/util/byte_size.h>
 #include <avro/DataFile.hh>
 #include <avro/Generic.hh>
 #include <avro/GenericDatum.hh>
 
 #include "iceberg/arrow/arrow_fs_file_io_internal.h"
+#include "iceberg/arrow/arrow_memory_pool_internal.h"
+#include "iceberg/arrow/arrow_metadata_columns_internal.h"
 #include "iceberg/arrow/arrow_status_internal.h"
+#include "iceberg/avro/avro_block_internal.h"
 #include "iceberg/avro/avro_data_util_internal.h"
+#include "iceberg/avro/avro_direct_decoder_internal.h"
 #include "iceberg/avro/avro_register.h"
 #include "iceberg/avro/avro_schema_util_internal.h"
 #include "iceberg/avro/avro_stream_internal.h"
+#include "iceberg/deletes/position_delete_index.h"
+#include "iceberg/executor.h"
 #include "iceberg/name_mapping.h"
-#include "iceberg/schema_internal.h"
-#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/batch_sizer_internal.h"
+#include "iceberg/util/conversion_cache_internal.h"
 #include "iceberg/util/macros.h"
+#include "iceberg/util/tracing.h"
 
 namespace iceberg::avro {
 
 namespace {
 
-Result<std::unique_ptr<AvroInputStream>> CreateInputStream(const ReaderOptions& options,
-                                                           int64_t buffer_size) {
-  ::arrow::fs::FileInfo file_info(options.path, ::arrow::fs::FileType::File);
-  if (options.length) {
-    file_info.set_size(options.length.value());
+/// \brief Returns the positive number of a reader property, or `default_value` if it
+/// is not set.
+template <typename T>
+Result<T> ParsePositiveProperty(
+    const std::unordered_map<std::string, std::string>& properties,
+    std::string_view key, T default_value) {
+  auto it = properties.find(std::string(key));
+  if (it == properties.cend()) {
+    return default_value;
   }
+  const auto& value = it->second;
+  T number = 0;
+  auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), number);
+  if (ec != std::errc() || end != value.data() + value.size() || number <= 0) {
+    return InvalidArgument("Invalid {}: {}, expected a positive integer", key, value);
+  }
+  return number;
+}
+
+constexpr int64_t kDefaultChunkSize = 4 * 1024 * 1024;
+
+using RowRanges = std::vector<std::pair<int64_t, int64_t>>;
+
+/// \brief Appends the position of a row read to the ranges of the rows of a batch.
+void AppendPosition(RowRanges& positions, int64_t position) {
+  if (!positions.empty() && positions.back().second == position) {
+    ++positions.back().second;
+  } else {
+    positions.emplace_back(position, position + 1);
+  }
+}
+
+bool IsConstant(const FieldProjection& field_projection) {
+  return field_projection.kind == FieldProjection::Kind::kConstant ||
+         field_projection.kind == FieldProjection::Kind::kDefault;
+}
+
+/// \brief Sets the columns of a batch of records read that are not decoded, which are
+/// the fields with constant or default values, and the metadata columns if `values`
+/// is set. The decoders append nulls to these columns.
+Result<std::shared_ptr<::arrow::Array>> SetGeneratedColumns(
+    const std::shared_ptr<::arrow::Array>& array, const Schema& read_schema,
+    const SchemaProjection& projection, const std::string& file_path,
+    const std::optional<MetadataColumnValues>& values,
+    std::span<const std::pair<int64_t, int64_t>> positions, ::arrow::MemoryPool* pool) {
+  if (!values.has_value() && std::ranges::none_of(projection.fields, IsConstant)) {
+    return array;
+  }
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(std::shared_ptr<::arrow::RecordBatch> batch,
+                                 ::arrow::RecordBatch::FromStructArray(array));
+  for (size_t i = 0; i < projection.fields.size(); ++i) {
+    if (!IsConstant(projection.fields[i])) {
+      continue;
+    }
+    const int index = static_cast<int>(i);
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto column,
+        arrow::MakeConstantArray(std::get<Literal>(projection.fields[i].from),
+                                 batch->column(index)->type(), batch->num_rows(), pool));
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(
+        batch, batch->SetColumn(index, batch->schema()->field(index), column));
+  }
+  if (values.has_value()) {
+    ICEBERG_ASSIGN_OR_RAISE(
+        batch, arrow::SetMetadataColumns(batch, read_schema, file_path, values.value(),
+                                         positions, pool));
+  }
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(auto struct_array, batch->ToStructArray());
+  return struct_array;
+}
+
+/// \brief A process-wide cache of the resolution of name mappings against the schemas
+/// of Avro files without field ids.
+///
+/// The files of migrated tables have no field ids and often share the same schema, so
+/// the file schema with the field ids of a name mapping, and the projections of read
+/// schemas onto it, are resolved once for all of them. Entries are keyed by the schema
+/// stored in the file header and by the address of the name mapping, which they keep
+/// alive so that the address is not reused.
+class NameMappingCache {
+ public:
+  static NameMappingCache& Instance() {
+    static NameMappingCache cache;
+    return cache;
+  }
+
+  /// \brief Returns the file schema with the field ids of a name mapping.
+  Result<::avro::ValidSchema> GetFileSchema(
+      const std::string& header_schema, const std::shared_ptr<const NameMapping>& mapping,
+      const ::avro::ValidSchema& file_schema) {
+    auto key = std::format("schema:{}:{}", static_cast<const void*>(mapping.get()),
+                           header_schema);
+    if (auto value = Get(key); value.has_value()) {
+      return std::get<::avro::ValidSchema>(std::move(value.value()));
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto root, MakeAvroNodeWithFieldIds(file_schema.root(),
+                                                                *mapping));
+    ::avro::ValidSchema mapped_schema(root);
+    Put(std::move(key), mapped_schema, mapping);
+    return mapped_schema;
+  }
+
+  /// \brief Returns the projection of a read schema onto a file schema with the field
+  /// ids of a name mapping.
+  Result<SchemaProjection> GetProjection(
+      const std::string& header_schema, const std::shared_ptr<const NameMapping>& mapping,
+      const Schema& read_schema, const ::avro::ValidSchema& mapped_schema) {
+    auto key = std::format("projection:{}:{}:{}", static_cast<const void*>(mapping.get()),
+                           read_schema.ToString(), header_schema);
+    if (auto value = Get(key); value.has_value()) {
+      return std::get<SchemaProjection>(std::move(value.value()));
+    }
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto projection,
+        Project(read_schema, mapped_schema.root(), /*prune_source=*/false));
+    Put(std::move(key), projection, mapping);
+    return projection;
+  }
+
+ private:
+  using Value = std::variant<::avro::ValidSchema, SchemaProjection>;
+
+  struct Item {
+    std::string key;
+    Value value;
+    std::shared_ptr<const NameMapping> mapping;
+  };
 
-  auto io = internal::checked_pointer_cast<arrow::ArrowFileSystemFileIO>(options.io);
-  ICEBERG_ARROW_ASSIGN_OR_RETURN(auto file, io->fs()->OpenInputFile(file_info));
-  return std::make_unique<AvroInputStream>(file, buffer_size);
+  static constexpr size_t kCapacity = 256;
+
+  // Returns the cached value of a key and marks it as most recently used.
+  std::optional<Value> Get(const std::string& key) {
+    std::lock_guard lock(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.cend()) {
+      return std::nullopt;
+    }
+    items_.splice(items_.begin(), items_, it->second);
+    return it->second->value;
+  }
+
+  void Put(std::string key, Value value, std::shared_ptr<const NameMapping> mapping) {
+    std::lock_guard lock(mutex_);
+    if (index_.contains(key)) {
+      return;
+    }
+    items_.push_front(Item{
+        .key = std::move(key), .value = std::move(value), .mapping = std::move(mapping)});
+    index_.emplace(items_.front().key, items_.begin());
+    if (items_.size() > kCapacity) {
+      index_.erase(items_.back().key);
+      items_.pop_back();
+    }
+  }
+
+  std::mutex mutex_;
+  // Cached items, from the most to the least recently used.
+  std::list<Item> items_;
+  std::unordered_map<std::string_view, std::list<Item>::iterator> index_;
+};
+
+/// \brief Returns the process-wide cache of the projections of read schemas onto the
+/// schemas of Avro files with field ids, keyed by both schemas.
+ConversionCache<SchemaProjection>& ProjectionCache() {
+  static ConversionCache<SchemaProjection> cache;
+  return cache;
+}
+
+/// \brief Returns the schema stored in the header of an Avro file.
+std::string HeaderSchema(const ::avro::DataFileReaderBase& reader) {
+  const auto& metadata = reader.metadata();
+  auto it = metadata.find("avro.schema");
+  if (it == metadata.cend()) {
+    return reader.dataSchema().toJson(/*prettyPrint=*/false);
+  }
+  return {it->second.begin(), it->second.end()};
+}
+
+/// \brief What the blocks of a file are decoded with, shared by the chunks decoded in
+/// parallel.
+struct ChunkDecodeContext {
+  ::avro::ValidSchema file_schema;
+  SchemaProjection projection;
+  std::shared_ptr<::iceberg::Schema> read_schema;
+  // The type of the batches, which may have extension types such as arrow.uuid.
+  std::shared_ptr<::arrow::DataType> arrow_type;
+  ::arrow::MemoryPool* pool;
+  int64_t batch_size;
+  // Adapts the number of rows of the batches of each chunk to their size, if set.
+  std::optional<BatchSizer> batch_sizer;
+  std::shared_ptr<const PositionDeleteIndex> position_deletes;
+  // The path of the file and the values of the metadata columns not stored in it, if
+  // the read schema has metadata columns.
+  std::string file_path;
+  std::optional<MetadataColumnValues> metadata_columns;
+};
+
+/// \brief Decodes the blocks of a chunk into batches of up to `batch_size` rows.
+Result<std::vector<std::shared_ptr<::arrow::Array>>> DecodeChunk(
+    const ChunkDecodeContext& context, const std::shared_ptr<::arrow::Buffer>& header,
+    const AvroChunk& chunk) {
+  ICEBERG_ASSIGN_OR_RAISE(auto direct_decoder,
+                          AvroDirectDecoder::Make(context.file_schema.root(),
+                                                  context.projection,
+                                                  *context.read_schema));
+  // Extension types have no builders, so the values are appended to builders of the
+  // storage types and the batches viewed as the extension types, without copies.
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(
+      std::shared_ptr<::arrow::ArrayBuilder> builder,
+      ::arrow::MakeBuilder(arrow::StorageType(context.arrow_type), context.pool));
+  std::vector<std::shared_ptr<::arrow::Array>> batches;
+  int64_t batch_size = context.batch_size;
+  auto batch_sizer = context.batch_sizer;
+  // The positions of the rows of the batch being built.
+  RowRanges positions;
+  auto finish_batch = [&]() -> Status {
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(std::shared_ptr<::arrow::Array> batch,
+                                   builder->Finish());
+    batch = arrow::ViewAsType(batch, context.arrow_type);
+    ICEBERG_ASSIGN_OR_RAISE(
+        batch, SetGeneratedColumns(batch, *context.read_schema, context.projection,
+                                   context.file_path, context.metadata_columns,
+                                   positions, context.pool));
+    positions.clear();
+    if (batch_sizer.has_value()) {
+      batch_sizer->Observe(batch->length(), ::arrow::util::TotalBufferSize(*batch));
+      batch_size = batch_sizer->batch_size();
+    }
+    batches.push_back(std::move(batch));
+    return {};
+  };
+
+  // The chunk is read as a file of its own, made of the header of the file and the
+  // blocks of the chunk, so that the blocks are decompressed by the Avro reader.
+  try {
+    ::avro::DataFileReaderBase reader(std::make_unique<AvroBufferInputStream>(
+        std::vector<std::shared_ptr<::arrow::Buffer>>{header, chunk.data}));
+    reader.init();
+    int64_t row = chunk.first_row;
+    while (reader.hasMore()) {
+      reader.decr();
+      const int64_t position = row++;
+      if (context.position_deletes != nullptr &&
+          context.position_deletes->IsDeleted(position)) {
+        ICEBERG_RETURN_UNEXPECTED(direct_decoder.Skip(reader.decoder()));
+        continue;
+      }
+      ICEBERG_RETURN_UNEXPECTED(direct_decoder.Decode(reader.decoder(), builder.get()));
+      if (context.metadata_columns.has_value()) {
+        AppendPosition(positions, position);
+      }
+      if (builder->length() >= batch_size) {
+        ICEBERG_RETURN_UNEXPECTED(finish_batch());
+      }
+    }
+  } catch (const std::exception& e) {
+    return IOError("Failed to decode the Avro blocks of {} bytes: {}",
+                   chunk.data->size(), e.what());
+  }
+  if (builder->length() > 0) {
+    ICEBERG_RETURN_UNEXPECTED(finish_batch());
+  }
+  return batches;
 }
 
 }  // namespace
 
 // A stateful context to keep track of the reading progress.
 struct ReadContext {
-  // The datum to reuse for reading the data.
+  // The datum to reuse for reading the data, only used when decoding into datums.
   std::unique_ptr<::avro::GenericDatum> datum_;
   // The arrow schema to build the record batch.
   std::shared_ptr<::arrow::Schema> arrow_schema_;
-  // The builder to build the record batch.
+  // The type of the record batch, which may have extension types such as arrow.uuid.
+  std::shared_ptr<::arrow::DataType> arrow_type_;
+  // The builder to build the record batch, of the storage type of arrow_type_.
   std::shared_ptr<::arrow::ArrayBuilder> builder_;
 };
 
@@ -84,12 +355,33 @@ class AvroReader::Impl {
 
     batch_size_ = options.batch_size;
     read_schema_ = options.projection;
+    pool_ = arrow::ToArrowMemoryPool(options.memory_pool);
+
+    ICEBERG_ASSIGN_OR_RAISE(auto parallelism,
+                            ParsePositiveProperty<int32_t>(
+                                options.properties, kDecodeParallelismProperty, 1));
+    auto datum_it = options.properties.find(std::string(kDecodeDatumProperty));
+    const bool decode_datum =
+        datum_it != options.properties.cend() && datum_it->second == "true";
+    if (parallelism > 1 && decode_datum) {
+      return NotSupported("Decoding Avro datums in parallel");
+    }
 
     // Open the input stream and adapt to the avro interface.
-    // TODO(gangwu): make this configurable
-    constexpr int64_t kDefaultBufferSize = 1024 * 1024;
-    ICEBERG_ASSIGN_OR_RAISE(auto input_stream,
-                            CreateInputStream(options, kDefaultBufferSize));
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto file, arrow::OpenArrowInputFile(options.io, options.path, options.length,
+                                             options.metrics));
+    std::unique_ptr<AvroInputStream> input_stream;
+    if (parallelism > 1) {
+      // The blocks are read by the parallel decoder, the stream only reads the header.
+      constexpr int64_t kHeaderBufferSize = 64 * 1024;
+      input_stream = std::make_unique<AvroInputStream>(file, kHeaderBufferSize);
+    } else {
+      // TODO(gangwu): make this configurable
+      constexpr int64_t kDefaultBufferSize = 1024 * 1024;
+      input_stream = std::make_unique<AvroInputStream>(
+          file, kDefaultBufferSize, AvroInputStream::ReadMode::kBlocks);
+    }
 
     // Create a base reader without setting reader schema to enable projection.
     auto base_reader =
@@ -100,15 +392,14 @@ class AvroReader::Impl {
     HasIdVisitor has_id_visitor;
     ICEBERG_RETURN_UNEXPECTED(has_id_visitor.Visit(file_schema));
 
+    const std::string header_schema = HeaderSchema(*base_reader);
     if (has_id_visitor.HasNoIds()) {
       // Apply field IDs based on name mapping if available
       if (options.name_mapping) {
-        ICEBERG_ASSIGN_OR_RAISE(
-            auto new_root_node,
-            MakeAvroNodeWithFieldIds(file_schema.root(), *options.name_mapping));
-
         // Update the file schema to use the new schema with field IDs
-        file_schema = ::avro::ValidSchema(new_root_node);
+        ICEBERG_ASSIGN_OR_RAISE(file_schema,
+                                NameMappingCache::Instance().GetFileSchema(
+                                    header_schema, options.name_mapping, file_schema));
       } else {
         return InvalidSchema(
             "Avro file schema has no field IDs and no name mapping provided");
@@ -119,13 +410,104 @@ class AvroReader::Impl {
 
     // Project the read schema on top of the file schema.
     // TODO(gangwu): support pruning source fields
-    ICEBERG_ASSIGN_OR_RAISE(projection_, Project(*read_schema_, file_schema.root(),
-                                                 /*prune_source=*/false));
-    reader_ = std::make_unique<::avro::DataFileReader<::avro::GenericDatum>>(
-        std::move(base_reader), file_schema);
+    ICEBERG_ASSIGN_OR_RAISE(
+        projection_,
+        ProjectWithConstants(*read_schema_, options.constants, options.default_values,
+                             [&](const ::iceberg::Schema& schema) {
+                               if (has_id_visitor.HasNoIds()) {
+                                 return NameMappingCache::Instance().GetProjection(
+                                     header_schema, options.name_mapping, schema,
+                                     file_schema);
+                               }
+                               return ProjectionCache().GetOrConvert(
+                                   std::format("{}\n{}", schema.ToString(),
+                                               header_schema),
+                                   [&]() {
+                                     return Project(schema, file_schema.root(),
+                                                    /*prune_source=*/false);
+                                   });
+                             }));
+    if (options.target_batch_bytes.has_value()) {
+      ICEBERG_ASSIGN_OR_RAISE(
+          batch_sizer_, BatchSizer::Make(options.target_batch_bytes.value(),
+                                         BatchSizer::EstimateRowWidth(*read_schema_)));
+      batch_size_ = batch_sizer_->batch_size();
+    }
+    if (decode_datum) {
+      datum_reader_ = std::make_unique<::avro::DataFileReader<::avro::GenericDatum>>(
+          std::move(base_reader), file_schema);
+    } else {
+      // The file schema only adds field ids to the data schema, so the records are
+      // decoded with the data schema.
+      ICEBERG_ASSIGN_OR_RAISE(auto direct_decoder,
+                              AvroDirectDecoder::Make(file_schema.root(), projection_,
+                                                      *read_schema_));
+      direct_decoder_.emplace(std::move(direct_decoder));
+      if (parallelism == 1) {
+        base_reader->init();
+      }
+      base_reader_ = std::move(base_reader);
+    }
 
-    if (options.split) {
-      reader_->sync(options.split->offset);
+    if (options.position_deletes != nullptr && !options.position_deletes->IsEmpty()) {
+      // Positions of the rows are only known when reading from the start of the file.
+      if (options.split) {
+        return NotSupported("Applying position deletes to a split of an Avro file");
+      }
+      position_deletes_ = options.position_deletes;
+    }
+    if (arrow::HasMetadataColumns(*read_schema_)) {
+      // Likewise for the metadata columns computed from the positions of the rows.
+      if (options.split && arrow::NeedsRowPositions(*read_schema_)) {
+        return NotSupported("Reading row positions from a split of an Avro file");
+      }
+      file_path_ = options.path;
+      metadata_columns_ = options.metadata_columns;
+    }
+
+    if (parallelism > 1) {
+      ICEBERG_ASSIGN_OR_RAISE(
+          auto chunk_size,
+          ParsePositiveProperty<int64_t>(options.properties, kDecodeChunkSizeProperty,
+                                         kDefaultChunkSize));
+      ICEBERG_RETURN_UNEXPECTED(InitReadContext());
+      auto ordered_it = options.properties.find(std::string(kDecodeOrderedProperty));
+      ChunkDecodeContext decode_context{.file_schema = file_schema,
+                                        .projection = projection_,
+                                        .read_schema = read_schema_,
+                                        .arrow_type = context_->arrow_type_,
+                                        .pool = pool_,
+                                        .batch_size = batch_size_,
+                                        .batch_sizer = batch_sizer_,
+                                        .position_deletes = position_deletes_,
+                                        .file_path = file_path_,
+                                        .metadata_columns = metadata_columns_};
+      AvroParallelDecoder::Options decoder_options{
+          .file = std::move(file),
+          .decode =
+              [decode_context = std::move(decode_context)](
+                  const std::shared_ptr<::arrow::Buffer>& header,
+                  const AvroChunk& chunk) {
+                return DecodeChunk(decode_context, header, chunk);
+              },
+          .executor = options.executor != nullptr ? options.executor : DefaultExecutor(),
+          .parallelism = parallelism,
+          .chunk_size = chunk_size,
+          .ordered = ordered_it == options.properties.cend() ||
+                     ordered_it->second == "true"};
+      if (options.split) {
+        decoder_options.split =
+            std::make_pair(static_cast<int64_t>(options.split->offset),
+                           static_cast<int64_t>(options.split->length));
+      }
+      ICEBERG_ASSIGN_OR_RAISE(parallel_decoder_,
+                              AvroParallelDecoder::Make(std::move(decoder_options)));
+    } else if (options.split) {
+      if (datum_reader_ != nullptr) {
+        datum_reader_->sync(options.split->offset);
+      } else {
+        base_reader_->sync(options.split->offset);
+      }
       split_end_ = options.split->offset + options.split->length;
     }
     return {};
@@ -136,25 +518,31 @@ class AvroReader::Impl {
       ICEBERG_RETURN_UNEXPECTED(InitReadContext());
     }
 
-    while (context_->builder_->length() < batch_size_) {
-      if (split_end_ && reader_->pastSync(split_end_.value())) {
-        break;
+    if (parallel_decoder_ != nullptr) {
+      ICEBERG_ASSIGN_OR_RAISE(auto batch, parallel_decoder_->Next());
+      if (!batch.has_value()) {
+        return std::nullopt;
       }
-      if (!reader_->read(*context_->datum_)) {
-        break;
-      }
-      ICEBERG_RETURN_UNEXPECTED(
-          AppendDatumToBuilder(reader_->readerSchema().root(), *context_->datum_,
-                               projection_, *read_schema_, context_->builder_.get()));
+      return ExportArrowArray(*batch.value());
     }
 
+    if (datum_reader_ != nullptr) {
+      ICEBERG_RETURN_UNEXPECTED(ReadDatums());
+    } else {
+      ICEBERG_RETURN_UNEXPECTED(DecodeRecords());
+    }
     return ConvertBuilderToArrowArray();
   }
 
   Status Close() {
-    if (reader_ != nullptr) {
-      reader_->close();
-      reader_.reset();
+    parallel_decoder_.reset();
+    if (datum_reader_ != nullptr) {
+      datum_reader_->close();
+      datum_reader_.reset();
+    }
+    if (base_reader_ != nullptr) {
+      base_reader_->close();
+      base_reader_.reset();
     }
     context_.reset();
     return {};
@@ -174,11 +562,12 @@ class AvroReader::Impl {
   }
 
   Result<std::unordered_map<std::string, std::string>> Metadata() {
-    if (reader_ == nullptr) {
+    if (datum_reader_ == nullptr && base_reader_ == nullptr) {
       return Invalid("Reader is not opened");
     }
 
-    const auto& metadata = reader_->metadata();
+    const auto& metadata =
+        datum_reader_ != nullptr ? datum_reader_->metadata() : base_reader_->metadata();
 
     std::unordered_map<std::string, std::string> metadata_map;
     metadata_map.reserve(metadata.size());
@@ -192,22 +581,67 @@ class AvroReader::Impl {
   }
 
  private:
+  // Reads the records into the datum and appends it to the builder.
+  Status ReadDatums() {
+    while (context_->builder_->length() < batch_size_) {
+      if (split_end_ && datum_reader_->pastSync(split_end_.value())) {
+        break;
+      }
+      if (!datum_reader_->read(*context_->datum_)) {
+        break;
+      }
+      const int64_t position = next_row_++;
+      if (position_deletes_ != nullptr && position_deletes_->IsDeleted(position)) {
+        continue;
+      }
+      ICEBERG_RETURN_UNEXPECTED(AppendDatumToBuilder(
+          datum_reader_->readerSchema().root(), *context_->datum_, projection_,
+          *read_schema_, context_->builder_.get()));
+      if (metadata_columns_.has_value()) {
+        AppendPosition(positions_, position);
+      }
+    }
+    return {};
+  }
+
+  // Decodes the records directly into the builder.
+  Status DecodeRecords() {
+    while (context_->builder_->length() < batch_size_) {
+      if (split_end_ && base_reader_->pastSync(split_end_.value())) {
+        break;
+      }
+      if (!base_reader_->hasMore()) {
+        break;
+      }
+      base_reader_->decr();
+      const int64_t position = next_row_++;
+      if (position_deletes_ != nullptr && position_deletes_->IsDeleted(position)) {
+        ICEBERG_RETURN_UNEXPECTED(direct_decoder_->Skip(base_reader_->decoder()));
+        continue;
+      }
+      ICEBERG_RETURN_UNEXPECTED(
+          direct_decoder_->Decode(base_reader_->decoder(), context_->builder_.get()));
+      if (metadata_columns_.has_value()) {
+        AppendPosition(positions_, position);
+      }
+    }
+    return {};
+  }
+
   Status InitReadContext() {
     context_ = std::make_unique<ReadContext>();
-    context_->datum_ = std::make_unique<::avro::GenericDatum>(reader_->readerSchema());
-
-    ArrowSchema arrow_schema;
-    ICEBERG_RETURN_UNEXPECTED(ToArrowSchema(*read_schema_, &arrow_schema));
-    auto import_result = ::arrow::ImportSchema(&arrow_schema);
-    if (!import_result.ok()) {
-      return InvalidSchema("Failed to import the arrow schema: {}",
-                           import_result.status().message());
+    if (datum_reader_ != nullptr) {
+      context_->datum_ =
+          std::make_unique<::avro::GenericDatum>(datum_reader_->readerSchema());
     }
-    context_->arrow_schema_ = import_result.MoveValueUnsafe();
 
-    auto arrow_struct_type =
+    ICEBERG_ASSIGN_OR_RAISE(context_->arrow_schema_,
+                            arrow::MakeReadArrowSchema(*read_schema_));
+
+    context_->arrow_type_ =
         std::make_shared<::arrow::StructType>(context_->arrow_schema_->fields());
-    auto builder_result = ::arrow::MakeBuilder(arrow_struct_type);
+    auto builder_result =
+        ::arrow::MakeBuilder(arrow::StorageType(context_->arrow_type_), pool_);
     if (!builder_result.ok()) {
       return InvalidSchema("Failed to make the arrow builder: {}",
                            builder_result.status().message());
@@ -228,9 +662,22 @@ class AvroReader::Impl {
                               builder_result.status().message());
     }
 
-    auto array = builder_result.MoveValueUnsafe();
+    auto array =
+        arrow::ViewAsType(builder_result.MoveValueUnsafe(), context_->arrow_type_);
+    ICEBERG_ASSIGN_OR_RAISE(
+        array, SetGeneratedColumns(array, *read_schema_, projection_, file_path_,
+                                   metadata_columns_, positions_, pool_));
+    positions_.clear();
+    if (batch_sizer_.has_value()) {
+      batch_sizer_->Observe(array->length(), ::arrow::util::TotalBufferSize(*array));
+      batch_size_ = batch_sizer_->batch_size();
+    }
+    return ExportArrowArray(*array);
+  }
+
+  static Result<ArrowArray> ExportArrowArray(const ::arrow::Array& array) {
     ArrowArray arrow_array;
-    auto export_result = ::arrow::ExportArray(*array, &arrow_array);
+    auto export_result = ::arrow::ExportArray(array, &arrow_array);
     if (!export_result.ok()) {
       return InvalidArrowData("Failed to export the arrow array: {}",
                               export_result.message());
@@ -241,21 +688,47 @@ class AvroReader::Impl {
  private:
   // Max number of rows in the record batch to read.
   int64_t batch_size_{};
+  // Adapts `batch_size_` to the size of the batches read, if a target size is set.
+  std::optional<BatchSizer> batch_sizer_;
+  // The pool to allocate the batches from.
+  ::arrow::MemoryPool* pool_ = ::arrow::default_memory_pool();
   // The end of the split to read and used to terminate the reading.
   std::optional<int64_t> split_end_;
+  // The positions of the deleted rows to skip, if any.
+  std::shared_ptr<const PositionDeleteIndex> position_deletes_;
+  // The position of the next row to read.
+  int64_t next_row_ = 0;
+  // The path of the file and the values of the metadata columns not stored in it, if
+  // the read schema has metadata columns.
+  std::string file_path_;
+  std::optional<MetadataColumnValues> metadata_columns_;
+  // The positions of the rows in the builder, if the read schema has metadata columns.
+  RowRanges positions_;
   // The schema to read.
   std::shared_ptr<::iceberg::Schema> read_schema_;
   // The projection result to apply to the read schema.
   SchemaProjection projection_;
-  // The avro reader to read the data into a datum.
-  std::unique_ptr<::avro::DataFileReader<::avro::GenericDatum>> reader_;
+  // The avro reader to read the data into a datum, if records are decoded into datums.
+  std::unique_ptr<::avro::DataFileReader<::avro::GenericDatum>> datum_reader_;
+  // The avro reader to decode the data directly, otherwise.
+  std::unique_ptr<::avro::DataFileReaderBase> base_reader_;
+  // The decoder of the projected fields, when decoding directly.
+  std::optional<AvroDirectDecoder> direct_decoder_;
+  // The decoder of the blocks, when decoding them in parallel.
+  std::unique_ptr<AvroParallelDecoder> parallel_decoder_;
   // The context to keep track of the reading progress.
   std::unique_ptr<ReadContext> context_;
 };
 
 AvroReader::~AvroReader() = default;
 
-Result<std::optional<ArrowArray>> AvroReader::Next() { return impl_->Next(); }
+Result<std::optional<ArrowArray>> AvroReader::Next() {
+  ICEBERG_TRACE_SCOPE(trace, "AvroReader::Next");
+  auto batch = impl_->Next();
+  ICEBERG_TRACE_ATTRIBUTE(trace, "rows",
+                          batch.has_value() && batch->has_value() ? (*batch)->length : 0);
+  return batch;
+}
 
 Result<ArrowSchema> AvroReader::Schema() { return impl_->Schema(); }
 
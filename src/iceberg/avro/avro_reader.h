@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include <string_view>
+
 #include "iceberg/file_reader.h"
 #include "iceberg/iceberg_bundle_export.h"
 
@@ -27,6 +29,28 @@ namespace iceberg::avro {
 /// \brief A reader that reads ArrowArray from Avro files.
 class ICEBERG_BUNDLE_EXPORT AvroReader : public Reader {
  public:
+  /// \brief Reader property to decode the records into Avro generic datums before
+  /// appending them to the Arrow builders, instead of decoding them directly into the
+  /// builders. Enabled by the value "true".
+  static constexpr std::string_view kDecodeDatumProperty = "read.avro.decode-datum";
+
+  /// \brief Reader property with the number of chunks of blocks of the file decoded at
+  /// the same time on ReaderOptions::executor, or the default executor if it is null.
+  /// Batches end at the end of each chunk. Defaults to 1, which decodes the file on the
+  /// calling thread, and is not supported with kDecodeDatumProperty.
+  static constexpr std::string_view kDecodeParallelismProperty =
+      "read.avro.decode-parallelism";
+
+  /// \brief Reader property to return the batches decoded in parallel in file order,
+  /// enabled by the value "true", the default. Otherwise batches are returned as soon
+  /// as their chunk is decoded.
+  static constexpr std::string_view kDecodeOrderedProperty = "read.avro.decode-ordered";
+
+  /// \brief Reader property with the size in bytes of the chunks of blocks decoded in
+  /// parallel, unless a block is larger. Defaults to 4 MiB.
+  static constexpr std::string_view kDecodeChunkSizeProperty =
+      "read.avro.decode-chunk-size";
+
   AvroReader() = default;
 
   ~AvroReader() override;
@@ -19,26 +19,35 @@
 
 #include "avro_stream_internal.h"
 
+#include <algorithm>
 #include <format>
+#include <utility>
 
 #include <arrow/result.h>
 
+#include "iceberg/avro/avro_block_internal.h"
 #include "iceberg/exception.h"
 
 namespace iceberg::avro {
 
 AvroInputStream::AvroInputStream(
-    std::shared_ptr<arrow::io::RandomAccessFile> input_stream, int64_t buffer_size)
+    std::shared_ptr<arrow::io::RandomAccessFile> input_stream, int64_t buffer_size,
+    ReadMode mode)
     : input_stream_(std::move(input_stream)),
       buffer_size_(buffer_size),
-      buffer_(buffer_size) {}
+      mode_(mode),
+      buffer_(mode == ReadMode::kBuffered ? buffer_size : 0) {}
 
-AvroInputStream::~AvroInputStream() = default;
+AvroInputStream::~AvroInputStream() {
+  if (readahead_.has_value()) {
+    readahead_->Wait();
+  }
+}
 
 bool AvroInputStream::next(const uint8_t** data, size_t* len) {
   // Return all unconsumed data in the buffer
   if (buffer_pos_ < available_bytes_) {
-    *data = buffer_.data() + buffer_pos_;
+    *data = buffer_data() + buffer_pos_;
     *len = available_bytes_ - buffer_pos_;
     byte_count_ += available_bytes_ - buffer_pos_;
     buffer_pos_ = available_bytes_;
@@ -46,18 +55,15 @@ bool AvroInputStream::next(const uint8_t** data, size_t* len) {
   }
 
   // Read from the input stream when the buffer is empty
-  auto result = input_stream_->Read(buffer_.size(), buffer_.data());
   // TODO(xiao.dong) Avro interface requires to return false if an error has occurred or
   // reach EOF, so error message can not be raised to the caller, add some log after we
   // have a logging system
-  if (!result.ok() || result.ValueUnsafe() <= 0) {
+  if (!(mode_ == ReadMode::kBlocks ? ReadRange() : ReadBuffered())) {
     return false;
   }
-  available_bytes_ = result.ValueUnsafe();
-  buffer_pos_ = 0;
 
   // Return the whole buffer
-  *data = buffer_.data();
+  *data = buffer_data();
   *len = available_bytes_;
   byte_count_ += available_bytes_;
   buffer_pos_ = available_bytes_;
@@ -65,6 +71,117 @@ bool AvroInputStream::next(const uint8_t** data, size_t* len) {
   return true;
 }
 
+bool AvroInputStream::ReadBuffered() {
+  auto result = input_stream_->Read(buffer_.size(), buffer_.data());
+  if (!result.ok() || result.ValueUnsafe() <= 0) {
+    return false;
+  }
+  available_bytes_ = result.ValueUnsafe();
+  buffer_pos_ = 0;
+  return true;
+}
+
+bool AvroInputStream::ReadRange() {
+  const auto position = static_cast<int64_t>(byte_count_);
+  if (file_size_ < 0) {
+    auto size = input_stream_->GetSize();
+    if (!size.ok()) {
+      return false;
+    }
+    file_size_ = size.ValueUnsafe();
+  }
+  if (position >= file_size_) {
+    return false;
+  }
+
+  if (position != read_end_) {
+    // The blocks are only followed from the file header through contiguous ranges.
+    if (readahead_.has_value()) {
+      readahead_->Wait();
+      readahead_.reset();
+    }
+    block_start_ = -1;
+    block_end_ = -1;
+    partial_header_.clear();
+  }
+
+  ::arrow::Result<std::shared_ptr<::arrow::Buffer>> range;
+  if (readahead_.has_value()) {
+    range = readahead_->result();
+    readahead_.reset();
+  } else {
+    range = input_stream_->ReadAt(position, RangeLength(position));
+  }
+  if (!range.ok() || range.ValueUnsafe()->size() == 0) {
+    return false;
+  }
+  range_ = std::move(range).ValueUnsafe();
+  available_bytes_ = range_->size();
+  buffer_pos_ = 0;
+  read_end_ = position + range_->size();
+
+  if (position == 0) {
+    block_start_ = AvroFileHeaderLength(range_->data(), range_->size()).value_or(-1);
+  }
+  TrackBlocks(position, *range_);
+
+  // Read the next range while this one is decoded.
+  if (read_end_ < file_size_) {
+    readahead_ = input_stream_->ReadAsync(read_end_, RangeLength(read_end_));
+  }
+  return true;
+}
+
+int64_t AvroInputStream::RangeLength(int64_t position) const {
+  // A block that continues past the range is read to its end at once.
+  const int64_t end = std::max(position + buffer_size_, block_end_);
+  return std::min(end, file_size_) - position;
+}
+
+void AvroInputStream::TrackBlocks(int64_t position, const ::arrow::Buffer& range) {
+  const int64_t end = position + range.size();
+  while (block_start_ >= 0) {
+    if (block_end_ < 0) {
+      // Decode the header of the block, which may have started in the last range.
+      std::string header = std::move(partial_header_);
+      partial_header_.clear();
+      const int64_t header_pos = block_start_ + static_cast<int64_t>(header.size());
+      if (header_pos < position || header_pos > end) {
+        block_start_ = -1;
+        return;
+      }
+      const auto available = std::min<int64_t>(
+          end - header_pos,
+          static_cast<int64_t>(kMaxAvroBlockHeaderSize - header.size()));
+      header.append(reinterpret_cast<const char*>(range.data() + (header_pos - position)),
+                    available);
+
+      auto block = DecodeAvroBlockHeader(reinterpret_cast<const uint8_t*>(header.data()),
+                                         header.size());
+      if (!block.has_value()) {
+        if (header.size() < kMaxAvroBlockHeaderSize) {
+          // The header continues in the next range.
+          partial_header_ = std::move(header);
+        } else {
+          block_start_ = -1;
+        }
+        return;
+      }
+      block_end_ = block_start_ + block->length;
+    }
+    if (block_end_ > end) {
+      // The block continues in the next range.
+      return;
+    }
+    block_start_ = block_end_;
+    block_end_ = -1;
+  }
+}
+
+const uint8_t* AvroInputStream::buffer_data() const {
+  return mode_ == ReadMode::kBlocks ? range_->data() : buffer_.data();
+}
+
 void AvroInputStream::backup(size_t len) {
   ICEBERG_CHECK(len <= buffer_pos_, "Cannot backup {} bytes, only {} bytes available",
                 len, buffer_pos_);
@@ -87,14 +204,62 @@ void AvroInputStream::skip(size_t len) {
 size_t AvroInputStream::byteCount() const { return byte_count_; }
 
 void AvroInputStream::seek(int64_t position) {
-  auto status = input_stream_->Seek(position);
-  ICEBERG_CHECK(status.ok(), "Failed to seek to {}, got {}", position, status.ToString());
+  // Ranges are read at their positions in kBlocks mode.
+  if (mode_ == ReadMode::kBuffered) {
+    auto status = input_stream_->Seek(position);
+    ICEBERG_CHECK(status.ok(), "Failed to seek to {}, got {}", position,
+                  status.ToString());
+  }
 
   buffer_pos_ = 0;
   available_bytes_ = 0;
   byte_count_ = position;
 }
 
+AvroBufferInputStream::AvroBufferInputStream(
+    std::vector<std::shared_ptr<::arrow::Buffer>> buffers)
+    : buffers_(std::move(buffers)) {}
+
+bool AvroBufferInputStream::next(const uint8_t** data, size_t* len) {
+  while (buffer_index_ < buffers_.size()) {
+    const auto& buffer = buffers_[buffer_index_];
+    const auto size = static_cast<size_t>(buffer->size());
+    if (buffer_pos_ < size) {
+      *data = buffer->data() + buffer_pos_;
+      *len = size - buffer_pos_;
+      byte_count_ += size - buffer_pos_;
+      buffer_pos_ = size;
+      return true;
+    }
+    ++buffer_index_;
+    buffer_pos_ = 0;
+  }
+  return false;
+}
+
+void AvroBufferInputStream::backup(size_t len) {
+  ICEBERG_CHECK(len <= buffer_pos_, "Cannot backup {} bytes, only {} bytes available",
+                len, buffer_pos_);
+  buffer_pos_ -= len;
+  byte_count_ -= len;
+}
+
+void AvroBufferInputStream::skip(size_t len) {
+  while (len > 0 && buffer_index_ < buffers_.size()) {
+    const auto size = static_cast<size_t>(buffers_[buffer_index_]->size());
+    const size_t skipped = std::min(len, size - buffer_pos_);
+    buffer_pos_ += skipped;
+    byte_count_ += skipped;
+    len -= skipped;
+    if (buffer_pos_ == size) {
+      ++buffer_index_;
+      buffer_pos_ = 0;
+    }
+  }
+}
+
+size_t AvroBufferInputStream::byteCount() const { return byte_count_; }
+
 AvroOutputStream::AvroOutputStream(std::shared_ptr<arrow::io::OutputStream> output_stream,
                                    int64_t buffer_size)
     : output_stream_(std::move(output_stream)),
@@ -19,15 +19,35 @@
 
 #pragma once
 
+#include <optional>
+#include <string>
+
+#include <arrow/buffer.h>
 #include <arrow/io/interfaces.h>
+#include <arrow/util/future.h>
 #include <avro/Stream.hh>
 
 namespace iceberg::avro {
 
 class AvroInputStream : public ::avro::SeekableInputStream {
  public:
+  /// \brief How the stream reads the underlying file.
+  enum class ReadMode {
+    /// \brief Sequential reads of `buffer_size` bytes copied into a buffer.
+    kBuffered,
+    /// \brief Positional reads of at least `buffer_size` bytes that are handed out
+    /// without copying.
+    ///
+    /// The stream follows the block headers of the Avro file, so that a read that
+    /// ends within a block is followed by a read of the rest of the block, however
+    /// large. The next range is read ahead asynchronously while the current one is
+    /// decoded. Pointers returned by next() point into the buffers of the file, which
+    /// are not copied when the file supports zero-copy reads.
+    kBlocks,
+  };
+
   explicit AvroInputStream(std::shared_ptr<::arrow::io::RandomAccessFile> input_stream,
-                           int64_t buffer_size);
+                           int64_t buffer_size, ReadMode mode = ReadMode::kBuffered);
 
   ~AvroInputStream() override;
 
@@ -54,12 +74,63 @@ class AvroInputStream : public ::avro::SeekableInputStream {
   void seek(int64_t position) override;
 
  private:
+  /// \brief Reads the next buffer in kBuffered mode.
+  bool ReadBuffered();
+
+  /// \brief Reads the range of the file at byte_count_ in kBlocks mode.
+  bool ReadRange();
+
+  /// \brief Returns the length of the range to read at a position in kBlocks mode.
+  int64_t RangeLength(int64_t position) const;
+
+  /// \brief Follows the block headers of the Avro file through a range read at a
+  /// position.
+  void TrackBlocks(int64_t position, const ::arrow::Buffer& range);
+
+  /// \brief Returns the data of the current buffer.
+  const uint8_t* buffer_data() const;
+
   std::shared_ptr<::arrow::io::RandomAccessFile> input_stream_;
   const int64_t buffer_size_;
+  const ReadMode mode_;
   std::vector<uint8_t> buffer_;
   size_t byte_count_ = 0;       // bytes read from the input stream
   size_t buffer_pos_ = 0;       // next position to read in the buffer
   size_t available_bytes_ = 0;  // bytes available in the buffer
+
+  // State of kBlocks mode.
+  std::shared_ptr<::arrow::Buffer> range_;  // the range being handed out
+  int64_t file_size_ = -1;                  // size of the file, once known
+  int64_t read_end_ = -1;                   // end of the last range read
+  // Start of the first block that does not end within the ranges read, or -1 when the
+  // blocks are not followed, e.g. after seeking to an arbitrary position.
+  int64_t block_start_ = -1;
+  // End of that block, or -1 until its header has been read.
+  int64_t block_end_ = -1;
+  // Bytes of the header of that block in the last range, when it continues in the next.
+  std::string partial_header_;
+  // The read of the range that follows the last one, if any.
+  std::optional<::arrow::Future<std::shared_ptr<::arrow::Buffer>>> readahead_;
+};
+
+/// \brief An input stream over Arrow buffers read before, handed out without copying.
+class AvroBufferInputStream : public ::avro::InputStream {
+ public:
+  explicit AvroBufferInputStream(std::vector<std::shared_ptr<::arrow::Buffer>> buffers);
+
+  bool next(const uint8_t** data, size_t* len) override;
+
+  void backup(size_t len) override;
+
+  void skip(size_t len) override;
+
+  size_t byteCount() const override;
+
+ private:
+  std::vector<std::shared_ptr<::arrow::Buffer>> buffers_;
+  size_t buffer_index_ = 0;  // the buffer being handed out
+  size_t buffer_pos_ = 0;    // next position to read in the buffer
+  size_t byte_count_ = 0;    // bytes handed out
 };
 
 class AvroOutputStream : public ::avro::OutputStream {
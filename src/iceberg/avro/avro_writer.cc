@@ -19,7 +19,9 @@
 
 #include "iceberg/avro/avro_writer.h"
 
+#include <charconv>
 #include <memory>
+#include <optional>
 
 #include <arrow/array/builder_base.h>
 #include <arrow/c/bridge.h>
@@ -32,13 +34,18 @@
 #include "iceberg/arrow/arrow_fs_file_io_internal.h"
 #include "iceberg/arrow/arrow_status_internal.h"
 #include "iceberg/avro/avro_data_util_internal.h"
+#include "iceberg/avro/avro_direct_encoder_internal.h"
 #include "iceberg/avro/avro_register.h"
 #include "iceberg/avro/avro_schema_util_internal.h"
 #include "iceberg/avro/avro_stream_internal.h"
+#include "iceberg/metrics_config.h"
 #include "iceberg/schema.h"
 #include "iceberg/schema_internal.h"
-#include "iceberg/util/checked_cast.h"
+#include "iceberg/table_properties.h"
+#include "iceberg/util/arrow_metrics_internal.h"
+#include "iceberg/util/conversion_cache_internal.h"
 #include "iceberg/util/macros.h"
+#include "iceberg/util/string_util.h"
 
 namespace iceberg::avro {
 
@@ -46,9 +53,92 @@ namespace {
 
 Result<std::unique_ptr<AvroOutputStream>> CreateOutputStream(const WriterOptions& options,
                                                              int64_t buffer_size) {
-  auto io = internal::checked_pointer_cast<arrow::ArrowFileSystemFileIO>(options.io);
-  ICEBERG_ARROW_ASSIGN_OR_RETURN(auto output, io->fs()->OpenOutputStream(options.path));
-  return std::make_unique<AvroOutputStream>(output, buffer_size);
+  ICEBERG_ASSIGN_OR_RAISE(auto output,
+                          arrow::OpenArrowOutputStream(options));
+  return std::make_unique<AvroOutputStream>(std::move(output), buffer_size);
+}
+
+/// \brief The Avro codec and compression level to write the data blocks with.
+struct Compression {
+  ::avro::Codec codec = ::avro::NULL_CODEC;
+  std::optional<int> level;
+};
+
+/// \brief Returns whether a writer property configures the writer, rather than being
+/// written to the file metadata.
+bool IsWriterProperty(const std::string& key) {
+  return key == TableProperties::kAvroCompression.key() ||
+         key == TableProperties::kAvroCompressionLevel.key() ||
+         key == AvroWriter::kEncodeDatumProperty ||
+         key == WriterOptions::kUploadPartsInFlightProperty ||
+         key == WriterOptions::kUploadPartSizeProperty ||
+         key == WriterOptions::kSortedFieldIdsProperty;
+}
+
+/// \brief Returns the compression chosen by the writer properties, which defaults to
+/// the default of the table properties.
+Result<Compression> ParseCompression(
+    const std::unordered_map<std::string, std::string>& properties) {
+  auto get = [&](const auto& entry) -> const std::string& {
+    auto it = properties.find(entry.key());
+    return it != properties.cend() ? it->second : entry.value();
+  };
+  const std::string codec = StringUtils::ToLower(get(TableProperties::kAvroCompression));
+  const std::string& level = get(TableProperties::kAvroCompressionLevel);
+
+  Compression compression;
+  int min_level = 0;
+  int max_level = 0;
+  if (codec == "uncompressed") {
+    compression.codec = ::avro::NULL_CODEC;
+  } else if (codec == "gzip") {
+    compression.codec = ::avro::DEFLATE_CODEC;
+    max_level = 9;
+  } else if (codec == "snappy") {
+#ifdef SNAPPY_CODEC_AVAILABLE
+    compression.codec = ::avro::SNAPPY_CODEC;
+#else
+    return NotSupported("Avro compression codec snappy is not available");
+#endif
+  } else if (codec == "zstd") {
+#ifdef ZSTD_CODEC_AVAILABLE
+    compression.codec = ::avro::ZSTD_CODEC;
+    min_level = 1;
+    max_level = 22;
+#else
+    return NotSupported("Avro compression codec zstd is not available");
+#endif
+  } else {
+    return InvalidArgument("Unsupported Avro compression codec: {}", codec);
+  }
+
+  // Codecs without levels ignore the level, like the Java implementation.
+  if (level.empty() || max_level == 0) {
+    return compression;
+  }
+  int value = 0;
+  auto [end, ec] = std::from_chars(level.data(), level.data() + level.size(), value);
+  if (ec != std::errc() || end != level.data() + level.size() || value < min_level ||
+      value > max_level) {
+    return InvalidArgument("Invalid {} compression level {}, expected {} to {}", codec,
+                           level, min_level, max_level);
+  }
+  compression.level = value;
+  return compression;
+}
+
+/// \brief Returns the Avro schema of the files written with a schema.
+///
+/// The schemas are cached by write schema, as a writer converts the same schema for
+/// each file it rolls to. They are shared by the writers and never modified.
+Result<std::shared_ptr<::avro::ValidSchema>> MakeAvroSchema(const Schema& write_schema) {
+  static ConversionCache<std::shared_ptr<::avro::ValidSchema>> cache;
+  return cache.GetOrConvert(
+      write_schema.ToString(), [&]() -> Result<std::shared_ptr<::avro::ValidSchema>> {
+        ::avro::NodePtr root;
+        ICEBERG_RETURN_UNEXPECTED(ToAvroNodeVisitor{}.Visit(write_schema, &root));
+        return std::make_shared<::avro::ValidSchema>(root);
+      });
 }
 
 }  // namespace
@@ -58,57 +148,99 @@ class AvroWriter::Impl {
   Status Open(const WriterOptions& options) {
     write_schema_ = options.schema;
 
-    ::avro::NodePtr root;
-    ICEBERG_RETURN_UNEXPECTED(ToAvroNodeVisitor{}.Visit(*write_schema_, &root));
-
-    avro_schema_ = std::make_shared<::avro::ValidSchema>(root);
+    ICEBERG_ASSIGN_OR_RAISE(avro_schema_, MakeAvroSchema(*write_schema_));
+    ICEBERG_ASSIGN_OR_RAISE(auto compression, ParseCompression(options.properties));
+    ICEBERG_ASSIGN_OR_RAISE(auto metrics_config,
+                            MetricsConfig::Make(options.properties, *write_schema_));
+    ICEBERG_ASSIGN_OR_RAISE(
+        metrics_collector_,
+        ArrowMetricsCollector::Make(*write_schema_, std::move(metrics_config)));
 
     // Open the output stream and adapt to the avro interface.
     constexpr int64_t kDefaultBufferSize = 1024 * 1024;
     ICEBERG_ASSIGN_OR_RAISE(auto output_stream,
                             CreateOutputStream(options, kDefaultBufferSize));
     arrow_output_stream_ = output_stream->arrow_output_stream();
+    output_stream_ = output_stream.get();
     std::map<std::string, std::vector<uint8_t>> metadata;
     for (const auto& [key, value] : options.properties) {
+      if (IsWriterProperty(key)) {
+        continue;
+      }
       std::vector<uint8_t> vec;
       vec.reserve(value.size());
       vec.assign(value.begin(), value.end());
       metadata.emplace(key, std::move(vec));
     }
-    writer_ = std::make_unique<::avro::DataFileWriter<::avro::GenericDatum>>(
-        std::move(output_stream), *avro_schema_, 16 * 1024 /*syncInterval*/,
-        ::avro::NULL_CODEC /*codec*/, metadata);
-    datum_ = std::make_unique<::avro::GenericDatum>(*avro_schema_);
+    auto encode_datum = options.properties.find(std::string(kEncodeDatumProperty));
+    if (encode_datum != options.properties.end() && encode_datum->second == "true") {
+      datum_writer_ = std::make_unique<::avro::DataFileWriter<::avro::GenericDatum>>(
+          std::move(output_stream), *avro_schema_, 16 * 1024 /*syncInterval*/,
+          compression.codec, metadata, compression.level);
+      datum_ = std::make_unique<::avro::GenericDatum>(*avro_schema_);
+    } else {
+      ICEBERG_ASSIGN_OR_RAISE(
+          auto direct_encoder,
+          AvroDirectEncoder::Make(avro_schema_->root(), *write_schema_));
+      direct_encoder_.emplace(std::move(direct_encoder));
+      writer_ = std::make_unique<::avro::DataFileWriterBase>(
+          std::move(output_stream), *avro_schema_, 16 * 1024 /*syncInterval*/,
+          compression.codec, metadata, compression.level);
+    }
     ICEBERG_RETURN_UNEXPECTED(ToArrowSchema(*write_schema_, &arrow_schema_));
     return {};
   }
 
   Status Write(ArrowArray* data) {
+    ICEBERG_RETURN_UNEXPECTED(metrics_collector_->Update(*data));
     ICEBERG_ARROW_ASSIGN_OR_RETURN(auto result,
                                    ::arrow::ImportArray(data, &arrow_schema_));
 
-    for (int64_t i = 0; i < result->length(); i++) {
-      ICEBERG_RETURN_UNEXPECTED(ExtractDatumFromArray(*result, i, datum_.get()));
-      writer_->write(*datum_);
+    if (datum_writer_ != nullptr) {
+      for (int64_t i = 0; i < result->length(); i++) {
+        ICEBERG_RETURN_UNEXPECTED(ExtractDatumFromArray(*result, i, datum_.get()));
+        datum_writer_->write(*datum_);
+      }
+      return {};
     }
 
+    // Records are encoded into the block being written, which is compressed and
+    // flushed to the output stream once it reaches the sync interval.
+    for (int64_t i = 0; i < result->length(); i++) {
+      writer_->syncIfNeeded();
+      ICEBERG_RETURN_UNEXPECTED(direct_encoder_->Encode(*result, i, writer_->encoder()));
+      writer_->incr();
+    }
     return {};
   }
 
   Status Close() {
-    if (writer_ != nullptr) {
-      writer_->close();
-      writer_.reset();
+    if (!Closed()) {
+      if (datum_writer_ != nullptr) {
+        datum_writer_->close();
+        datum_writer_.reset();
+      } else {
+        writer_->close();
+        writer_.reset();
+      }
+      metrics_ = metrics_collector_->Finish();
       ICEBERG_ARROW_ASSIGN_OR_RETURN(total_bytes_, arrow_output_stream_->Tell());
       ICEBERG_ARROW_RETURN_NOT_OK(arrow_output_stream_->Close());
     }
     return {};
   }
 
-  bool Closed() const { return writer_ == nullptr; }
+  bool Closed() const { return writer_ == nullptr && datum_writer_ == nullptr; }
 
   int64_t length() { return total_bytes_; }
 
+  // Bytes of the written blocks, the block being encoded is not counted.
+  int64_t EstimatedLength() const {
+    return static_cast<int64_t>(output_stream_->byteCount());
+  }
+
+  const Metrics& metrics() const { return metrics_; }
+
  private:
   // The schema to write.
   std::shared_ptr<::iceberg::Schema> write_schema_;
@@ -116,13 +248,23 @@ class AvroWriter::Impl {
   std::shared_ptr<::avro::ValidSchema> avro_schema_;
   // Arrow output stream of the Avro file to write
   std::shared_ptr<::arrow::io::OutputStream> arrow_output_stream_;
-  // The avro writer to write the data into a datum.
-  std::unique_ptr<::avro::DataFileWriter<::avro::GenericDatum>> writer_;
+  // The Avro output stream, owned by the Avro writer.
+  AvroOutputStream* output_stream_ = nullptr;
+  // The avro writer to encode the data directly.
+  std::unique_ptr<::avro::DataFileWriterBase> writer_;
+  // The encoder of the rows, when encoding directly.
+  std::optional<AvroDirectEncoder> direct_encoder_;
+  // The avro writer to write the data through a datum, otherwise.
+  std::unique_ptr<::avro::DataFileWriter<::avro::GenericDatum>> datum_writer_;
   // Reusable Avro datum for writing individual records.
   std::unique_ptr<::avro::GenericDatum> datum_;
   // Arrow schema to write data.
   ArrowSchema arrow_schema_;
   int64_t total_bytes_ = 0;
+  // Collector of the column metrics of the written rows.
+  std::optional<ArrowMetricsCollector> metrics_collector_;
+  // Metrics of the closed file.
+  Metrics metrics_;
 };
 
 AvroWriter::~AvroWriter() = default;
@@ -143,8 +285,7 @@ Status AvroWriter::Close() {
 
 std::optional<Metrics> AvroWriter::metrics() {
   if (impl_->Closed()) {
-    // TODO(xiao.dong) implement metrics
-    return {};
+    return impl_->metrics();
   }
   return std::nullopt;
 }
@@ -156,6 +297,13 @@ std::optional<int64_t> AvroWriter::length() {
   return std::nullopt;
 }
 
+std::optional<int64_t> AvroWriter::estimated_length() {
+  if (impl_->Closed()) {
+    return impl_->length();
+  }
+  return impl_->EstimatedLength();
+}
+
 std::vector<int64_t> AvroWriter::split_offsets() { return {}; }
 
 void RegisterWriter() {
@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include <string_view>
+
 #include "iceberg/file_writer.h"
 #include "iceberg/iceberg_bundle_export.h"
 
@@ -27,6 +29,11 @@ namespace iceberg::avro {
 /// \brief A writer for serializing ArrowArray to Avro files.
 class ICEBERG_BUNDLE_EXPORT AvroWriter : public Writer {
  public:
+  /// \brief Writer property to convert the rows into Avro generic datums before
+  /// encoding them, instead of encoding them directly from the Arrow arrays. Enabled by
+  /// the value "true".
+  static constexpr std::string_view kEncodeDatumProperty = "write.avro.encode-datum";
+
   AvroWriter() = default;
 
   ~AvroWriter() override;
@@ -41,6 +48,8 @@ class ICEBERG_BUNDLE_EXPORT AvroWriter : public Writer {
 
   std::optional<int64_t> length() final;
 
+  std::optional<int64_t> estimated_length() final;
+
   std::vector<int64_t> split_offsets() final;
 
  private:
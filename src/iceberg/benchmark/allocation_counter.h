@@ -0,0 +1,37 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/benchmark/allocation_counter.h
+/// A process-wide count of heap allocations for benchmarks.
+
+#include <cstdint>
+
+namespace iceberg {
+
+/// \brief Returns the number of calls to the global operator new since the process
+/// started.
+///
+/// The count only covers benchmark binaries that link allocation_counter.cc, which
+/// replaces the global operator new. Allocations that bypass it, such as those of
+/// Arrow memory pools, are not counted.
+int64_t AllocationCount();
+
+}  // namespace iceberg
@@ -0,0 +1,276 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <unistd.h>
+
+#include "iceberg/arrow/arrow_fs_file_io_internal.h"
+#include "iceberg/avro/avro_register.h"
+#include "iceberg/catalog/hadoop/hadoop_catalog.h"
+#include "iceberg/catalog/memory/in_memory_catalog.h"
+#include "iceberg/fast_append.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/metrics_reporter.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/table.h"
+#include "iceberg/table_identifier.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/table_properties.h"
+#include "iceberg/type.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+namespace {
+
+/// \brief Number of commits of each committer in an iteration.
+constexpr int32_t kCommitsPerCommitter = 10;
+
+/// \brief The catalog the committers commit through.
+enum class CatalogKind : int64_t {
+  /// \brief InMemoryCatalog, whose commits swap the metadata location under a lock.
+  kInMemory = 0,
+  /// \brief HadoopCatalog, whose commits write the next metadata file only if it is
+  /// absent, by hard-linking a fully written temporary file on the local file system.
+  kFileSystem = 1,
+};
+
+/// \brief Counts the commit attempts of the commit reports.
+class AttemptCounter : public MetricsReporter {
+ public:
+  void Report(const MetricsReport& report) override {
+    if (const auto* commit = std::get_if<CommitReport>(&report)) {
+      attempts_.fetch_add(commit->metrics.attempts.value(), std::memory_order_relaxed);
+    }
+  }
+
+  int64_t attempts() const { return attempts_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<int64_t> attempts_{0};
+};
+
+/// \brief Creates the catalogs and tables of the benchmark under a temporary
+/// directory removed at exit.
+class CommitEnvironment {
+ public:
+  CommitEnvironment()
+      : root_(std::filesystem::temp_directory_path() /
+              std::format("iceberg-commit-benchmark-{}", ::getpid())),
+        file_io_(arrow::ArrowFileSystemFileIO::MakeLocalFileIO()) {
+    avro::RegisterAll();
+    std::filesystem::create_directories(root_);
+  }
+
+  ~CommitEnvironment() {
+    std::error_code ec;
+    std::filesystem::remove_all(root_, ec);
+  }
+
+  /// \brief Creates a new table in a catalog of a kind.
+  ///
+  /// Commits retry up to 1000 times with a backoff from 1 ms to 100 ms, so that
+  /// contention shows in the retries and latencies rather than in failed commits.
+  Result<std::pair<std::shared_ptr<Catalog>, TableIdentifier>> NewTable(
+      CatalogKind kind) {
+    const auto warehouse = (root_ / std::format("warehouse-{}", ++table_count_)).string();
+    TableIdentifier identifier{.ns = Namespace{.levels = {"db"}}, .name = "events"};
+    const std::unordered_map<std::string, std::string> properties{
+        {TableProperties::kCommitNumRetries.key(), "1000"},
+        {TableProperties::kCommitMinRetryWaitMs.key(), "1"},
+        {TableProperties::kCommitMaxRetryWaitMs.key(), "100"},
+        {TableProperties::kCommitTotalRetryTimeMs.key(), "600000"},
+    };
+    // InMemoryCatalog does not create tables, so it registers the metadata written by
+    // HadoopCatalog.
+    auto hadoop_catalog = HadoopCatalog::Make("bench", file_io_, warehouse);
+    ICEBERG_ASSIGN_OR_RAISE(auto table,
+                            hadoop_catalog->CreateTable(identifier, schema_,
+                                                        *PartitionSpec::Unpartitioned(),
+                                                        /*location=*/"", properties));
+    if (kind == CatalogKind::kFileSystem) {
+      return std::make_pair(std::shared_ptr<Catalog>(hadoop_catalog), identifier);
+    }
+    auto catalog = InMemoryCatalog::Make("bench", file_io_, warehouse, {});
+    ICEBERG_RETURN_UNEXPECTED(catalog->CreateNamespace(identifier.ns, {}));
+    ICEBERG_RETURN_UNEXPECTED(
+        catalog->RegisterTable(identifier, table->metadata_location()));
+    return std::make_pair(std::shared_ptr<Catalog>(catalog), identifier);
+  }
+
+ private:
+  std::filesystem::path root_;
+  std::shared_ptr<FileIO> file_io_;
+  Schema schema_{std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int64())}};
+  int32_t table_count_ = 0;
+};
+
+CommitEnvironment& Environment() {
+  static CommitEnvironment environment;
+  return environment;
+}
+
+/// \brief Returns the latency at a quantile of sorted latencies, in milliseconds.
+double Percentile(const std::vector<std::chrono::nanoseconds>& sorted, double quantile) {
+  if (sorted.empty()) {
+    return 0;
+  }
+  const auto index =
+      static_cast<size_t>(quantile * static_cast<double>(sorted.size() - 1));
+  return std::chrono::duration<double, std::milli>(sorted[index]).count();
+}
+
+/// \brief Measures concurrent FastAppend commits to one table.
+///
+/// Arguments are the number of committer threads, the number of data files appended
+/// by each commit and the catalog, see CatalogKind. Each iteration creates a new
+/// table, and each committer loads it and commits kCommitsPerCommitter appends. An
+/// iteration fails if a commit fails or if the table does not end with a snapshot
+/// for each commit, so the benchmark doubles as a stress test of concurrent commits.
+///
+/// Reports the committed appends per second, the retries per commit and the
+/// percentiles of the latency of a commit, including its retries.
+void BM_ConcurrentCommits(benchmark::State& state) {
+  const auto committers = static_cast<int32_t>(state.range(0));
+  const auto files_per_commit = static_cast<int32_t>(state.range(1));
+  const auto kind = static_cast<CatalogKind>(state.range(2));
+
+  auto reporter = std::make_shared<AttemptCounter>();
+  std::vector<std::chrono::nanoseconds> latencies;
+  int64_t commits = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto table = Environment().NewTable(kind);
+    if (!table.has_value()) {
+      state.SkipWithError(table.error().message.c_str());
+      return;
+    }
+    const auto& [catalog, identifier] = table.value();
+    std::mutex mutex;
+    std::string error;
+    state.ResumeTiming();
+
+    std::vector<std::thread> threads;
+    for (int32_t c = 0; c < committers; ++c) {
+      threads.emplace_back([&, c]() {
+        std::vector<std::chrono::nanoseconds> thread_latencies;
+        auto fail = [&](const std::string& message) {
+          std::lock_guard lock(mutex);
+          error = message;
+        };
+        auto loaded = catalog->LoadTable(identifier);
+        if (!loaded.has_value()) {
+          return fail(loaded.error().message);
+        }
+        std::shared_ptr<Table> committer_table = std::move(loaded.value());
+        committer_table->set_metrics_reporter(reporter);
+        for (int32_t i = 0; i < kCommitsPerCommitter; ++i) {
+          FastAppend append(committer_table);
+          for (int32_t f = 0; f < files_per_commit; ++f) {
+            append.AppendFile(std::make_shared<DataFile>(DataFile{
+                .file_path = std::format("data/{}-{}-{}.parquet", c, i, f),
+                .file_format = FileFormatType::kParquet,
+                .record_count = 1000,
+                .file_size_in_bytes = 64 * 1024 * 1024,
+            }));
+          }
+          const auto start = std::chrono::steady_clock::now();
+          auto status = append.Commit();
+          thread_latencies.push_back(std::chrono::steady_clock::now() - start);
+          if (!status.has_value()) {
+            return fail(status.error().message);
+          }
+        }
+        std::lock_guard lock(mutex);
+        latencies.insert(latencies.end(), thread_latencies.begin(),
+                         thread_latencies.end());
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    state.PauseTiming();
+    if (!error.empty()) {
+      state.SkipWithError(error.c_str());
+      return;
+    }
+    auto final_table = catalog->LoadTable(identifier);
+    if (!final_table.has_value()) {
+      state.SkipWithError(final_table.error().message.c_str());
+      return;
+    }
+    const auto expected = static_cast<size_t>(committers) * kCommitsPerCommitter;
+    if (final_table.value()->metadata()->snapshots.size() != expected) {
+      state.SkipWithError(std::format("Expected {} snapshots, found {}", expected,
+                                      final_table.value()->metadata()->snapshots.size())
+                              .c_str());
+      return;
+    }
+    commits += static_cast<int64_t>(expected);
+    state.ResumeTiming();
+  }
+
+  std::ranges::sort(latencies);
+  state.counters["commits_per_second"] =
+      benchmark::Counter(static_cast<double>(commits), benchmark::Counter::kIsRate);
+  state.counters["retries_per_commit"] =
+      commits == 0 ? 0
+                   : static_cast<double>(reporter->attempts() - commits) /
+                         static_cast<double>(commits);
+  state.counters["p50_ms"] = Percentile(latencies, 0.5);
+  state.counters["p95_ms"] = Percentile(latencies, 0.95);
+  state.counters["p99_ms"] = Percentile(latencies, 0.99);
+  state.counters["max_ms"] = Percentile(latencies, 1);
+}
+
+BENCHMARK(BM_ConcurrentCommits)
+    ->ArgNames({"committers", "files", "catalog"})
+    // Scale the number of committers.
+    ->Args({1, 10, 0})
+    ->Args({8, 10, 0})
+    ->Args({32, 10, 0})
+    ->Args({200, 10, 0})
+    // Larger commits hold their attempts longer.
+    ->Args({32, 1000, 0})
+    // Commit through metadata files written only if absent.
+    ->Args({1, 10, 1})
+    ->Args({8, 10, 1})
+    ->Args({32, 10, 1})
+    ->Iterations(3)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace iceberg
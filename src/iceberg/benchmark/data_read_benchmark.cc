@@ -0,0 +1,402 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <arrow/array.h>
+#include <arrow/builder.h>
+#include <arrow/c/bridge.h>
+#include <arrow/type.h>
+#include <benchmark/benchmark.h>
+#include <unistd.h>
+
+#include "iceberg/arrow/arrow_fs_file_io_internal.h"
+#include "iceberg/arrow/arrow_status_internal.h"
+#include "iceberg/arrow_c_data.h"
+#include "iceberg/avro/avro_register.h"
+#include "iceberg/file_format.h"
+#include "iceberg/file_reader.h"
+#include "iceberg/file_writer.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/parquet/parquet_register.h"
+#include "iceberg/schema.h"
+#include "iceberg/schema_internal.h"
+#include "iceberg/table_properties.h"
+#include "iceberg/table_scan.h"
+#include "iceberg/type.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+namespace {
+
+/// \brief Number of rows of each generated data file.
+constexpr int64_t kNumRows = 200'000;
+
+/// \brief Number of top-level columns of the flat schema.
+constexpr int32_t kFlatColumns = 16;
+
+constexpr std::array<std::string_view, 3> kCodecs = {"uncompressed", "gzip", "zstd"};
+
+/// \brief A flat schema of longs, doubles and strings.
+std::shared_ptr<Schema> FlatSchema() {
+  std::vector<SchemaField> fields{SchemaField::MakeRequired(1, "id", int64())};
+  for (int32_t i = 1; i < kFlatColumns; ++i) {
+    std::shared_ptr<Type> type;
+    switch (i % 3) {
+      case 0:
+        type = int64();
+        break;
+      case 1:
+        type = float64();
+        break;
+      default:
+        type = string();
+        break;
+    }
+    fields.push_back(SchemaField::MakeOptional(i + 1, std::format("c{}", i), type));
+  }
+  return std::make_shared<Schema>(std::move(fields), /*schema_id=*/0);
+}
+
+/// \brief A schema with structs and lists.
+std::shared_ptr<Schema> NestedSchema() {
+  return std::make_shared<Schema>(
+      std::vector<SchemaField>{
+          SchemaField::MakeRequired(1, "id", int64()),
+          SchemaField::MakeOptional(2, "point",
+                                    std::make_shared<StructType>(std::vector<SchemaField>{
+                                        SchemaField::MakeRequired(3, "x", float64()),
+                                        SchemaField::MakeRequired(4, "y", float64())})),
+          SchemaField::MakeOptional(5, "tags",
+                                    std::make_shared<ListType>(SchemaField::MakeRequired(
+                                        6, "element", int64()))),
+          SchemaField::MakeOptional(7, "name", string()),
+          SchemaField::MakeOptional(
+              8, "location",
+              std::make_shared<StructType>(std::vector<SchemaField>{
+                  SchemaField::MakeOptional(9, "city", string()),
+                  SchemaField::MakeOptional(10, "zip", int32())}))},
+      /*schema_id=*/0);
+}
+
+/// \brief Returns a schema with the first `num_columns` top-level fields of `schema`,
+/// or all of them if `num_columns` is 0.
+std::shared_ptr<Schema> Project(const std::shared_ptr<Schema>& schema,
+                                int64_t num_columns) {
+  auto fields = schema->fields();
+  if (num_columns <= 0 || static_cast<size_t>(num_columns) >= fields.size()) {
+    return schema;
+  }
+  return std::make_shared<Schema>(
+      std::vector<SchemaField>(fields.begin(), fields.begin() + num_columns),
+      /*schema_id=*/0);
+}
+
+/// \brief Appends a deterministic value derived from `row` to a builder.
+::arrow::Status AppendValue(::arrow::ArrayBuilder& builder, int64_t row) {
+  switch (builder.type()->id()) {
+    case ::arrow::Type::INT32:
+      return static_cast<::arrow::Int32Builder&>(builder).Append(
+          static_cast<int32_t>(row % 100'000));
+    case ::arrow::Type::INT64:
+      return static_cast<::arrow::Int64Builder&>(builder).Append(row);
+    case ::arrow::Type::DOUBLE:
+      return static_cast<::arrow::DoubleBuilder&>(builder).Append(
+          static_cast<double>(row) * 0.5);
+    case ::arrow::Type::STRING:
+      return static_cast<::arrow::StringBuilder&>(builder).Append(
+          std::format("value-{}", row % 10'000));
+    case ::arrow::Type::STRUCT: {
+      auto& struct_builder = static_cast<::arrow::StructBuilder&>(builder);
+      for (int i = 0; i < struct_builder.num_fields(); ++i) {
+        ARROW_RETURN_NOT_OK(AppendValue(*struct_builder.field_builder(i), row + i));
+      }
+      return struct_builder.Append();
+    }
+    case ::arrow::Type::LIST: {
+      auto& list_builder = static_cast<::arrow::ListBuilder&>(builder);
+      ARROW_RETURN_NOT_OK(list_builder.Append());
+      for (int64_t i = 0; i < row % 4; ++i) {
+        ARROW_RETURN_NOT_OK(AppendValue(*list_builder.value_builder(), row + i));
+      }
+      return ::arrow::Status::OK();
+    }
+    default:
+      return ::arrow::Status::NotImplemented("Unsupported benchmark column type: ",
+                                             builder.type()->ToString());
+  }
+}
+
+/// \brief The file format, compression codec and schema of a data file.
+struct FileShape {
+  FileFormatType format;
+  std::string_view codec;
+  bool nested;
+
+  auto operator<=>(const FileShape&) const = default;
+};
+
+/// \brief A generated data file.
+struct DataFileFixture {
+  std::shared_ptr<Schema> schema;
+  std::shared_ptr<DataFile> data_file;
+};
+
+/// \brief Writes data files under a temporary directory removed at exit.
+class DataFileGenerator {
+ public:
+  DataFileGenerator()
+      : root_(std::filesystem::temp_directory_path() /
+              std::format("iceberg-read-benchmark-{}", ::getpid())),
+        file_io_(arrow::ArrowFileSystemFileIO::MakeLocalFileIO()) {
+    avro::RegisterAll();
+    parquet::RegisterAll();
+    std::filesystem::create_directories(root_);
+  }
+
+  ~DataFileGenerator() {
+    std::error_code ec;
+    std::filesystem::remove_all(root_, ec);
+  }
+
+  const std::shared_ptr<FileIO>& file_io() const { return file_io_; }
+
+  /// \brief Returns the data file of a shape, writing it on first use.
+  Result<DataFileFixture> Get(const FileShape& shape) {
+    if (auto it = files_.find(shape); it != files_.end()) {
+      return it->second;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto file, Write(shape));
+    files_.emplace(shape, file);
+    return file;
+  }
+
+ private:
+  Result<DataFileFixture> Write(const FileShape& shape) {
+    auto schema = shape.nested ? NestedSchema() : FlatSchema();
+
+    ArrowSchema c_schema;
+    ICEBERG_RETURN_UNEXPECTED(ToArrowSchema(*schema, &c_schema));
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(auto arrow_schema, ::arrow::ImportSchema(&c_schema));
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(
+        auto builder, ::arrow::MakeBuilder(::arrow::struct_(arrow_schema->fields())));
+    for (int64_t row = 0; row < kNumRows; ++row) {
+      ICEBERG_ARROW_RETURN_NOT_OK(AppendValue(*builder, row));
+    }
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(auto array, builder->Finish());
+
+    const bool is_parquet = shape.format == FileFormatType::kParquet;
+    const auto extension = is_parquet ? "parquet" : "avro";
+    const auto path =
+        (root_ / std::format("data-{}.{}", files_.size(), extension)).string();
+    const auto& codec_property = is_parquet ? TableProperties::kParquetCompression.key()
+                                            : TableProperties::kAvroCompression.key();
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto writer,
+        WriterFactoryRegistry::Open(shape.format,
+                                    {.path = path,
+                                     .schema = schema,
+                                     .io = file_io_,
+                                     .properties = {{codec_property,
+                                                     std::string(shape.codec)}}}));
+    ArrowArray c_array;
+    ICEBERG_ARROW_RETURN_NOT_OK(::arrow::ExportArray(*array, &c_array));
+    ICEBERG_RETURN_UNEXPECTED(writer->Write(&c_array));
+    ICEBERG_RETURN_UNEXPECTED(writer->Close());
+
+    auto data_file = std::make_shared<DataFile>();
+    data_file->file_path = path;
+    data_file->file_format = shape.format;
+    data_file->record_count = kNumRows;
+    data_file->file_size_in_bytes =
+        static_cast<int64_t>(std::filesystem::file_size(path));
+    return DataFileFixture{.schema = std::move(schema),
+                           .data_file = std::move(data_file)};
+  }
+
+  std::filesystem::path root_;
+  std::shared_ptr<FileIO> file_io_;
+  std::map<FileShape, DataFileFixture> files_;
+};
+
+DataFileGenerator& Generator() {
+  static DataFileGenerator generator;
+  return generator;
+}
+
+/// \brief Returns the data file selected by the first three benchmark arguments: the
+/// format (0 for Parquet, 1 for Avro), the index of the codec in kCodecs and whether
+/// the schema is nested.
+Result<DataFileFixture> GetFile(const benchmark::State& state) {
+  return Generator().Get(FileShape{
+      .format = state.range(0) == 0 ? FileFormatType::kParquet : FileFormatType::kAvro,
+      .codec = kCodecs[state.range(1)],
+      .nested = state.range(2) != 0});
+}
+
+void SetThroughput(benchmark::State& state, const DataFile& data_file) {
+  state.SetBytesProcessed(state.iterations() * data_file.file_size_in_bytes);
+  state.counters["rows_per_second"] =
+      benchmark::Counter(static_cast<double>(state.iterations() * kNumRows),
+                         benchmark::Counter::kIsRate);
+}
+
+/// \brief The I/O stage: reads the bytes of the data file.
+void BM_ReadFile(benchmark::State& state) {
+  auto file = GetFile(state);
+  if (!file.has_value()) {
+    state.SkipWithError(file.error().message.c_str());
+    return;
+  }
+  for (auto _ : state) {
+    auto content = Generator().file_io()->ReadFile(
+        file->data_file->file_path,
+        static_cast<size_t>(file->data_file->file_size_in_bytes));
+    if (!content.has_value()) {
+      state.SkipWithError(content.error().message.c_str());
+      return;
+    }
+    benchmark::DoNotOptimize(content);
+  }
+  SetThroughput(state, *file->data_file);
+}
+
+/// \brief The decode and projection stages: reads all batches of the data file with a
+/// Reader. The fourth argument is the number of projected columns, 0 for all, and the
+/// fifth is the batch size.
+void BM_Reader(benchmark::State& state) {
+  auto file = GetFile(state);
+  if (!file.has_value()) {
+    state.SkipWithError(file.error().message.c_str());
+    return;
+  }
+  const auto projection = Project(file->schema, state.range(3));
+  const ReaderOptions options{
+      .path = file->data_file->file_path,
+      .length = static_cast<size_t>(file->data_file->file_size_in_bytes),
+      .batch_size = state.range(4),
+      .io = Generator().file_io(),
+      .projection = projection};
+  for (auto _ : state) {
+    auto reader = ReaderFactoryRegistry::Open(file->data_file->file_format, options);
+    if (!reader.has_value()) {
+      state.SkipWithError(reader.error().message.c_str());
+      return;
+    }
+    while (true) {
+      auto batch = reader.value()->Next();
+      if (!batch.has_value()) {
+        state.SkipWithError(batch.error().message.c_str());
+        return;
+      }
+      if (!batch->has_value()) {
+        break;
+      }
+      batch->value().release(&batch->value());
+    }
+  }
+  SetThroughput(state, *file->data_file);
+}
+
+/// \brief All stages, including the export to an ArrowArrayStream: reads the data
+/// file with FileScanTask::ToArrow. The fourth argument is the number of projected
+/// columns, 0 for all.
+void BM_ScanTask(benchmark::State& state) {
+  auto file = GetFile(state);
+  if (!file.has_value()) {
+    state.SkipWithError(file.error().message.c_str());
+    return;
+  }
+  const auto projection = Project(file->schema, state.range(3));
+  const FileScanTask task(file->data_file);
+  for (auto _ : state) {
+    auto stream = task.ToArrow(Generator().file_io(), projection, /*filter=*/nullptr);
+    if (!stream.has_value()) {
+      state.SkipWithError(stream.error().message.c_str());
+      return;
+    }
+    ArrowArray batch;
+    while (stream->get_next(&stream.value(), &batch) == 0 && batch.release != nullptr) {
+      batch.release(&batch);
+    }
+    stream->release(&stream.value());
+  }
+  SetThroughput(state, *file->data_file);
+}
+
+/// \brief Adds the arguments of every data file followed by `extra_args`.
+void FileArgs(benchmark::internal::Benchmark* bench,
+              const std::vector<int64_t>& extra_args) {
+  for (int64_t format : {0, 1}) {
+    for (int64_t codec = 0; codec < static_cast<int64_t>(kCodecs.size()); ++codec) {
+      for (int64_t nested : {0, 1}) {
+        std::vector<int64_t> args{format, codec, nested};
+        args.insert(args.end(), extra_args.begin(), extra_args.end());
+        bench->Args(args);
+      }
+    }
+  }
+}
+
+void ReadFileArgs(benchmark::internal::Benchmark* bench) { FileArgs(bench, {}); }
+
+void ReaderArgs(benchmark::internal::Benchmark* bench) {
+  for (int64_t batch_size : {1024, 4096, 65536}) {
+    FileArgs(bench, {0, batch_size});
+  }
+  for (int64_t columns : {1, 4}) {
+    FileArgs(bench, {columns, ReaderOptions::kDefaultBatchSize});
+  }
+}
+
+void ScanTaskArgs(benchmark::internal::Benchmark* bench) {
+  for (int64_t columns : {0, 1, 4}) {
+    FileArgs(bench, {columns});
+  }
+}
+
+BENCHMARK(BM_ReadFile)
+    ->ArgNames({"format", "codec", "nested"})
+    ->Apply(ReadFileArgs)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_Reader)
+    ->ArgNames({"format", "codec", "nested", "columns", "batch_size"})
+    ->Apply(ReaderArgs)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(BM_ScanTask)
+    ->ArgNames({"format", "codec", "nested", "columns"})
+    ->Apply(ScanTaskArgs)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace iceberg
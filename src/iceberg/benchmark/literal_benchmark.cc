@@ -0,0 +1,82 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "iceberg/expression/literal.h"
+#include "iceberg/type.h"
+#include "iceberg/util/conversions.h"
+
+namespace iceberg {
+namespace {
+
+void BM_LiteralCompare(benchmark::State& state, const Literal& lhs, const Literal& rhs) {
+  for (auto _ : state) {
+    auto result = lhs <=> rhs;
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+BENCHMARK_CAPTURE(BM_LiteralCompare, int, Literal::Int(42), Literal::Int(43));
+BENCHMARK_CAPTURE(BM_LiteralCompare, long, Literal::Long(1234567890),
+                  Literal::Long(1234567891));
+BENCHMARK_CAPTURE(BM_LiteralCompare, double, Literal::Double(1.5), Literal::Double(2.5));
+BENCHMARK_CAPTURE(BM_LiteralCompare, string, Literal::String("iceberg-a"),
+                  Literal::String("iceberg-b"));
+BENCHMARK_CAPTURE(BM_LiteralCompare, decimal, Literal::Decimal(1234567, 9, 2),
+                  Literal::Decimal(1234568, 9, 2));
+
+void BM_ToBytes(benchmark::State& state, const Literal& value) {
+  for (auto _ : state) {
+    auto bytes = Conversions::ToBytes(value);
+    benchmark::DoNotOptimize(bytes);
+  }
+}
+
+BENCHMARK_CAPTURE(BM_ToBytes, int, Literal::Int(42));
+BENCHMARK_CAPTURE(BM_ToBytes, long, Literal::Long(1234567890));
+BENCHMARK_CAPTURE(BM_ToBytes, double, Literal::Double(1.5));
+BENCHMARK_CAPTURE(BM_ToBytes, string, Literal::String("iceberg"));
+BENCHMARK_CAPTURE(BM_ToBytes, decimal, Literal::Decimal(1234567, 9, 2));
+
+void BM_FromBytes(benchmark::State& state, const Literal& value) {
+  const auto bytes = Conversions::ToBytes(value);
+  if (!bytes.has_value()) {
+    state.SkipWithError(bytes.error().message.c_str());
+    return;
+  }
+  for (auto _ : state) {
+    auto result = Conversions::FromBytes(value.type(), std::span(bytes.value()));
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+BENCHMARK_CAPTURE(BM_FromBytes, int, Literal::Int(42));
+BENCHMARK_CAPTURE(BM_FromBytes, long, Literal::Long(1234567890));
+BENCHMARK_CAPTURE(BM_FromBytes, double, Literal::Double(1.5));
+BENCHMARK_CAPTURE(BM_FromBytes, string, Literal::String("iceberg"));
+BENCHMARK_CAPTURE(BM_FromBytes, decimal, Literal::Decimal(1234567, 9, 2));
+
+}  // namespace
+}  // namespace iceberg
@@ -0,0 +1,251 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <unistd.h>
+
+#include "iceberg/arrow/arrow_fs_file_io_internal.h"
+#include "iceberg/avro/avro_register.h"
+#include "iceberg/benchmark/allocation_counter.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_reader.h"
+#include "iceberg/manifest_writer.h"
+#include "iceberg/partition_field.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/transform.h"
+#include "iceberg/type.h"
+#include "iceberg/util/conversions.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+namespace {
+
+/// \brief Allocation budget of a decoded manifest entry, as a fixed part plus a part
+/// per column with metrics.
+///
+/// The budget guards the manifest decode path against allocation regressions and
+/// should be lowered as allocations are removed from it. Each column inherently
+/// costs map nodes for its counts and bounds plus the buffers of its bounds.
+constexpr double kBaseAllocationsPerEntry = 24;
+constexpr double kAllocationsPerColumn = 8;
+
+/// \brief Environment variable overriding the allocation budget of an entry, or
+/// disabling the check when set to 0.
+constexpr const char* kAllocationsLimitEnv =
+    "ICEBERG_BENCHMARK_MAX_ALLOCATIONS_PER_ENTRY";
+
+/// \brief Returns the allocation budget of an entry of a manifest with the given
+/// number of columns, or 0 if the budget is not checked.
+double AllocationsPerEntryLimit(int32_t num_columns) {
+  if (const char* limit = std::getenv(kAllocationsLimitEnv); limit != nullptr) {
+    return std::strtod(limit, nullptr);
+  }
+  return kBaseAllocationsPerEntry + kAllocationsPerColumn * num_columns;
+}
+
+/// \brief The shape of a synthetic manifest.
+struct ManifestShape {
+  int32_t num_entries;
+  int32_t num_columns;
+  bool partitioned;
+
+  auto operator<=>(const ManifestShape&) const = default;
+};
+
+/// \brief A synthetic manifest written to a local file.
+struct SyntheticManifest {
+  std::string path;
+  std::shared_ptr<Schema> partition_schema;
+};
+
+/// \brief Writes synthetic manifests under a temporary directory removed at exit.
+class ManifestGenerator {
+ public:
+  ManifestGenerator()
+      : root_(std::filesystem::temp_directory_path() /
+              std::format("iceberg-manifest-read-benchmark-{}", ::getpid())),
+        file_io_(arrow::ArrowFileSystemFileIO::MakeLocalFileIO()) {
+    avro::RegisterAll();
+    std::filesystem::create_directories(root_);
+  }
+
+  ~ManifestGenerator() {
+    std::error_code ec;
+    std::filesystem::remove_all(root_, ec);
+  }
+
+  const std::shared_ptr<FileIO>& file_io() const { return file_io_; }
+
+  /// \brief Returns the manifest of a shape, writing it on first use.
+  Result<SyntheticManifest> Get(const ManifestShape& shape) {
+    if (auto it = manifests_.find(shape); it != manifests_.end()) {
+      return it->second;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto manifest, Generate(shape));
+    manifests_.emplace(shape, manifest);
+    return manifest;
+  }
+
+ private:
+  Result<SyntheticManifest> Generate(const ManifestShape& shape) {
+    std::vector<SchemaField> fields{SchemaField::MakeRequired(1, "id", int64())};
+    for (int32_t i = 1; i < shape.num_columns; ++i) {
+      fields.push_back(SchemaField::MakeOptional(i + 1, std::format("c{}", i), int32()));
+    }
+    auto schema = std::make_shared<Schema>(std::move(fields), /*schema_id=*/0);
+
+    std::shared_ptr<PartitionSpec> spec = PartitionSpec::Unpartitioned();
+    if (shape.partitioned && shape.num_columns > 1) {
+      spec = std::make_shared<PartitionSpec>(
+          schema, /*spec_id=*/1,
+          std::vector<PartitionField>{
+              PartitionField(2, 1000, "c1", Transform::Identity())});
+    }
+
+    const auto path =
+        (root_ / std::format("manifest-{}.avro", manifests_.size())).string();
+    ICEBERG_ASSIGN_OR_RAISE(auto writer, ManifestWriter::MakeV2Writer(
+                                             /*snapshot_id=*/1000, path, file_io_, spec));
+    for (int32_t e = 0; e < shape.num_entries; ++e) {
+      ICEBERG_RETURN_UNEXPECTED(
+          writer->Add(MakeEntry(shape, e, !spec->fields().empty())));
+    }
+    ICEBERG_RETURN_UNEXPECTED(writer->Close());
+
+    SyntheticManifest manifest{.path = path};
+    ICEBERG_ASSIGN_OR_RAISE(manifest.partition_schema, spec->PartitionSchema());
+    return manifest;
+  }
+
+  /// \brief Makes an added data file with counts and bounds for every column.
+  static ManifestEntry MakeEntry(const ManifestShape& shape, int64_t file_index,
+                                 bool partitioned) {
+    ManifestEntry entry;
+    entry.status = ManifestStatus::kAdded;
+    entry.snapshot_id = 1000;
+    entry.data_file = std::make_shared<DataFile>();
+    auto& file = *entry.data_file;
+    file.file_path = std::format("s3://bucket/warehouse/db/table/data/file-{}.parquet",
+                                 file_index);
+    file.file_format = FileFormatType::kParquet;
+    if (partitioned) {
+      file.partition = {Literal::Int(static_cast<int32_t>(file_index % 16))};
+    }
+    file.record_count = 1000;
+    file.file_size_in_bytes = 64 * 1024 * 1024;
+    for (int32_t field_id = 1; field_id <= shape.num_columns; ++field_id) {
+      file.column_sizes[field_id] = 4096;
+      file.value_counts[field_id] = file.record_count;
+      file.null_value_counts[field_id] = 0;
+      file.lower_bounds[field_id] = Conversions::ToBytes(Literal::Int(0)).value();
+      file.upper_bounds[field_id] = Conversions::ToBytes(Literal::Int(1000)).value();
+    }
+    return entry;
+  }
+
+  std::filesystem::path root_;
+  std::shared_ptr<FileIO> file_io_;
+  std::map<ManifestShape, SyntheticManifest> manifests_;
+};
+
+ManifestGenerator& Generator() {
+  static ManifestGenerator generator;
+  return generator;
+}
+
+/// \brief Measures decoding every entry of a manifest with ManifestReader, and the
+/// heap allocations made per decoded entry.
+///
+/// Arguments are the number of entries, the number of columns with metrics and
+/// whether the manifest is partitioned. The benchmark fails when the allocations per
+/// entry exceed the budget of AllocationsPerEntryLimit().
+void BM_ReadManifest(benchmark::State& state) {
+  const ManifestShape shape{
+      .num_entries = static_cast<int32_t>(state.range(0)),
+      .num_columns = static_cast<int32_t>(state.range(1)),
+      .partitioned = state.range(2) != 0,
+  };
+
+  auto manifest = Generator().Get(shape);
+  if (!manifest.has_value()) {
+    state.SkipWithError(manifest.error().message.c_str());
+    return;
+  }
+
+  const int64_t allocations_before = AllocationCount();
+  for (auto _ : state) {
+    int64_t num_entries = 0;
+    auto status = [&]() -> Status {
+      ICEBERG_ASSIGN_OR_RAISE(
+          auto reader, ManifestReader::Make(manifest->path, Generator().file_io(),
+                                            manifest->partition_schema));
+      return reader->VisitEntries([&](ManifestEntry&& entry) -> Status {
+        benchmark::DoNotOptimize(entry);
+        ++num_entries;
+        return {};
+      });
+    }();
+    if (!status.has_value()) {
+      state.SkipWithError(status.error().message.c_str());
+      return;
+    }
+    if (num_entries != shape.num_entries) {
+      state.SkipWithError("Unexpected number of manifest entries");
+      return;
+    }
+  }
+  const int64_t allocations = AllocationCount() - allocations_before;
+
+  const int64_t entries = state.iterations() * shape.num_entries;
+  state.SetItemsProcessed(entries);
+  const double allocations_per_entry =
+      static_cast<double>(allocations) / static_cast<double>(entries);
+  state.counters["allocs_per_entry"] = allocations_per_entry;
+
+  const double limit = AllocationsPerEntryLimit(shape.num_columns);
+  if (limit > 0 && allocations_per_entry > limit) {
+    const auto message =
+        std::format("{:.1f} allocations per entry exceed the budget of {:.1f}",
+                    allocations_per_entry, limit);
+    state.SkipWithError(message.c_str());
+  }
+}
+
+BENCHMARK(BM_ReadManifest)
+    ->ArgNames({"entries", "columns", "partitioned"})
+    ->Args({1000, 1, 0})
+    ->Args({1000, 10, 0})
+    ->Args({1000, 10, 1})
+    // Metrics of wide tables dominate manifest decoding.
+    ->Args({1000, 100, 0})
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace iceberg
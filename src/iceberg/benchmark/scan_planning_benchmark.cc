@@ -0,0 +1,318 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <unistd.h>
+
+#include "iceberg/arrow/arrow_fs_file_io_internal.h"
+#include "iceberg/avro/avro_register.h"
+#include "iceberg/benchmark/allocation_counter.h"
+#include "iceberg/expression/expressions.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/manifest_writer.h"
+#include "iceberg/partition_field.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/table_scan.h"
+#include "iceberg/transform.h"
+#include "iceberg/type.h"
+#include "iceberg/util/conversions.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+namespace {
+
+/// \brief Number of distinct values of the partition column of partitioned tables.
+constexpr int32_t kNumPartitions = 16;
+
+/// \brief The shape of a synthetic table.
+struct TableShape {
+  int32_t num_snapshots;
+  int32_t manifests_per_snapshot;
+  int32_t entries_per_manifest;
+  int32_t num_columns;
+  bool partitioned;
+
+  auto operator<=>(const TableShape&) const = default;
+};
+
+/// \brief A synthetic table whose metadata and manifests are written to local files.
+struct SyntheticTable {
+  std::shared_ptr<TableMetadata> metadata;
+  std::shared_ptr<FileIO> file_io;
+};
+
+/// \brief Writes synthetic tables under a temporary directory removed at exit.
+class TableGenerator {
+ public:
+  TableGenerator()
+      : root_(std::filesystem::temp_directory_path() /
+              std::format("iceberg-scan-planning-benchmark-{}", ::getpid())),
+        file_io_(arrow::ArrowFileSystemFileIO::MakeLocalFileIO()) {
+    avro::RegisterAll();
+    std::filesystem::create_directories(root_);
+  }
+
+  ~TableGenerator() {
+    std::error_code ec;
+    std::filesystem::remove_all(root_, ec);
+  }
+
+  /// \brief Returns the table of a shape, writing it on first use.
+  Result<SyntheticTable> Get(const TableShape& shape) {
+    if (auto it = tables_.find(shape); it != tables_.end()) {
+      return it->second;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto table, Generate(shape));
+    tables_.emplace(shape, table);
+    return table;
+  }
+
+ private:
+  /// \brief Writes one manifest per snapshot and manifest index, and a manifest list
+  /// per snapshot that references the manifests of the snapshot and its ancestors.
+  Result<SyntheticTable> Generate(const TableShape& shape) {
+    const auto dir = root_ / std::format("table-{}", tables_.size());
+    std::filesystem::create_directories(dir);
+
+    std::vector<SchemaField> fields{SchemaField::MakeRequired(1, "id", int64())};
+    for (int32_t i = 1; i < shape.num_columns; ++i) {
+      fields.push_back(SchemaField::MakeOptional(i + 1, std::format("c{}", i), int32()));
+    }
+    auto schema = std::make_shared<Schema>(std::move(fields), /*schema_id=*/0);
+
+    std::shared_ptr<PartitionSpec> spec = PartitionSpec::Unpartitioned();
+    if (shape.partitioned && shape.num_columns > 1) {
+      spec = std::make_shared<PartitionSpec>(
+          schema, /*spec_id=*/1,
+          std::vector<PartitionField>{
+              PartitionField(2, 1000, "c1", Transform::Identity())});
+    }
+
+    std::vector<ManifestFile> manifests;
+    std::vector<std::shared_ptr<Snapshot>> snapshots;
+    int64_t file_index = 0;
+    for (int32_t s = 0; s < shape.num_snapshots; ++s) {
+      const int64_t snapshot_id = 1000 + s;
+      const int64_t sequence_number = s + 1;
+      for (int32_t m = 0; m < shape.manifests_per_snapshot; ++m) {
+        const auto path = (dir / std::format("manifest-{}-{}.avro", s, m)).string();
+        // All files of a manifest are in one partition, so filters on the partition
+        // column can skip whole manifests.
+        const auto partition = static_cast<int32_t>(manifests.size() % kNumPartitions);
+        ICEBERG_ASSIGN_OR_RAISE(
+            auto writer, ManifestWriter::MakeV2Writer(snapshot_id, path, file_io_, spec));
+        for (int32_t e = 0; e < shape.entries_per_manifest; ++e) {
+          ICEBERG_RETURN_UNEXPECTED(
+              writer->Add(MakeEntry(shape, snapshot_id, file_index++, partition,
+                                    spec->fields().empty())));
+        }
+        ICEBERG_RETURN_UNEXPECTED(writer->Close());
+        ICEBERG_ASSIGN_OR_RAISE(auto manifest, writer->ToManifestFile());
+        manifest.sequence_number = sequence_number;
+        manifest.min_sequence_number = sequence_number;
+        manifests.push_back(std::move(manifest));
+      }
+
+      const auto list_path = (dir / std::format("snap-{}.avro", s)).string();
+      std::optional<int64_t> parent_id;
+      if (s > 0) {
+        parent_id = snapshot_id - 1;
+      }
+      ICEBERG_ASSIGN_OR_RAISE(auto list_writer,
+                              ManifestListWriter::MakeV2Writer(
+                                  snapshot_id, parent_id, sequence_number, list_path,
+                                  file_io_));
+      ICEBERG_RETURN_UNEXPECTED(list_writer->AddAll(manifests));
+      ICEBERG_RETURN_UNEXPECTED(list_writer->Close());
+
+      ICEBERG_ASSIGN_OR_RAISE(auto timestamp,
+                              TimePointMsFromUnixMs(1700000000000 + s));
+      snapshots.push_back(std::make_shared<Snapshot>(Snapshot{
+          .snapshot_id = snapshot_id,
+          .parent_snapshot_id = parent_id,
+          .sequence_number = sequence_number,
+          .timestamp_ms = timestamp,
+          .manifest_list = list_path,
+          .schema_id = 0,
+      }));
+    }
+
+    const int32_t spec_id = spec->spec_id();
+    auto metadata = std::make_shared<TableMetadata>(TableMetadata{
+        .format_version = 2,
+        .table_uuid = "scan-planning-benchmark",
+        .location = dir.string(),
+        .last_sequence_number = shape.num_snapshots,
+        .last_column_id = shape.num_columns,
+        .schemas = {std::move(schema)},
+        .current_schema_id = 0,
+        .partition_specs = {std::move(spec)},
+        .default_spec_id = spec_id,
+        .current_snapshot_id = snapshots.empty() ? Snapshot::kInvalidSnapshotId
+                                                 : snapshots.back()->snapshot_id,
+        .snapshots = std::move(snapshots),
+    });
+    return SyntheticTable{.metadata = std::move(metadata), .file_io = file_io_};
+  }
+
+  /// \brief Makes an added data file with bounds for every column.
+  static ManifestEntry MakeEntry(const TableShape& shape, int64_t snapshot_id,
+                                 int64_t file_index, int32_t partition,
+                                 bool unpartitioned) {
+    ManifestEntry entry;
+    entry.status = ManifestStatus::kAdded;
+    entry.snapshot_id = snapshot_id;
+    entry.data_file = std::make_shared<DataFile>();
+    auto& file = *entry.data_file;
+    file.file_path = std::format("data/file-{}.parquet", file_index);
+    file.file_format = FileFormatType::kParquet;
+    if (!unpartitioned) {
+      file.partition = {Literal::Int(partition)};
+    }
+    file.record_count = 1000;
+    file.file_size_in_bytes = 64 * 1024 * 1024;
+
+    const int64_t first_id = file_index * file.record_count;
+    file.value_counts[1] = file.record_count;
+    file.lower_bounds[1] = Conversions::ToBytes(Literal::Long(first_id)).value();
+    file.upper_bounds[1] =
+        Conversions::ToBytes(Literal::Long(first_id + file.record_count - 1)).value();
+    for (int32_t field_id = 2; field_id <= shape.num_columns; ++field_id) {
+      file.value_counts[field_id] = file.record_count;
+      file.null_value_counts[field_id] = 0;
+      const int32_t lower = field_id == 2 ? partition : 0;
+      const int32_t upper = field_id == 2 ? partition : 1000;
+      file.lower_bounds[field_id] = Conversions::ToBytes(Literal::Int(lower)).value();
+      file.upper_bounds[field_id] = Conversions::ToBytes(Literal::Int(upper)).value();
+    }
+    return entry;
+  }
+
+  std::filesystem::path root_;
+  std::shared_ptr<FileIO> file_io_;
+  std::map<TableShape, SyntheticTable> tables_;
+};
+
+TableGenerator& Generator() {
+  static TableGenerator generator;
+  return generator;
+}
+
+/// \brief Resets the peak resident set size of the process, on Linux only.
+void ResetPeakRss() { std::ofstream("/proc/self/clear_refs") << "5"; }
+
+/// \brief Returns the peak resident set size of the process in bytes, or 0 where it
+/// is unknown.
+int64_t PeakRss() {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.starts_with("VmHWM:")) {
+      return std::stoll(line.substr(6)) * 1024;
+    }
+  }
+  return 0;
+}
+
+/// \brief Measures TableScanBuilder::Build() and PlanFiles() on a synthetic table.
+///
+/// Arguments are the numbers of snapshots, manifests per snapshot, entries per
+/// manifest and columns, whether the table is partitioned, whether the scan filters
+/// one partition value and the planning parallelism.
+void BM_PlanFiles(benchmark::State& state) {
+  const TableShape shape{
+      .num_snapshots = static_cast<int32_t>(state.range(0)),
+      .manifests_per_snapshot = static_cast<int32_t>(state.range(1)),
+      .entries_per_manifest = static_cast<int32_t>(state.range(2)),
+      .num_columns = static_cast<int32_t>(state.range(3)),
+      .partitioned = state.range(4) != 0,
+  };
+  const bool filtered = state.range(5) != 0;
+  const auto parallelism = static_cast<int32_t>(state.range(6));
+
+  auto table = Generator().Get(shape);
+  if (!table.has_value()) {
+    state.SkipWithError(table.error().message.c_str());
+    return;
+  }
+
+  ResetPeakRss();
+  const int64_t allocations_before = AllocationCount();
+  size_t num_tasks = 0;
+  for (auto _ : state) {
+    TableScanBuilder builder(table->metadata, table->file_io);
+    builder.WithPlanningParallelism(parallelism);
+    if (filtered) {
+      builder.WithFilter(Expressions::Equal("c1", Literal::Int(0)));
+    }
+    auto scan = builder.Build();
+    if (!scan.has_value()) {
+      state.SkipWithError(scan.error().message.c_str());
+      return;
+    }
+    auto tasks = scan.value()->PlanFiles();
+    if (!tasks.has_value()) {
+      state.SkipWithError(tasks.error().message.c_str());
+      return;
+    }
+    num_tasks = tasks->size();
+  }
+
+  state.counters["tasks"] = static_cast<double>(num_tasks);
+  const int64_t allocations = AllocationCount() - allocations_before;
+  state.counters["allocations"] = benchmark::Counter(static_cast<double>(allocations),
+                                                     benchmark::Counter::kAvgIterations);
+  state.counters["peak_rss"] =
+      benchmark::Counter(static_cast<double>(PeakRss()), benchmark::Counter::kDefaults,
+                         benchmark::Counter::kIs1024);
+}
+
+BENCHMARK(BM_PlanFiles)
+    ->ArgNames({"snapshots", "manifests", "entries", "columns", "partitioned",
+                "filtered", "parallelism"})
+    // Scale the number of manifests and files.
+    ->Args({1, 10, 100, 10, 0, 0, 1})
+    ->Args({1, 100, 100, 10, 0, 0, 1})
+    ->Args({10, 10, 1000, 10, 0, 0, 1})
+    // Scale the number of columns, whose metrics dominate manifest decoding.
+    ->Args({1, 10, 1000, 100, 0, 0, 1})
+    // Prune manifests and files with a filter on the partition column.
+    ->Args({1, 100, 100, 10, 1, 0, 1})
+    ->Args({1, 100, 100, 10, 1, 1, 1})
+    // Read manifests in parallel.
+    ->Args({1, 100, 100, 10, 1, 0, 8})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace iceberg
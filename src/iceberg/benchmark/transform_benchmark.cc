@@ -0,0 +1,86 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "iceberg/expression/literal.h"
+#include "iceberg/transform.h"
+#include "iceberg/util/decimal.h"
+#include "iceberg/util/uuid.h"
+
+namespace iceberg {
+namespace {
+
+// 2024-01-02T10:00:00 in microseconds from the epoch.
+constexpr int64_t kTimestamp = 1704189600000000;
+
+void BM_Transform(benchmark::State& state, const std::shared_ptr<Transform>& transform,
+                  const Literal& value) {
+  auto function = transform->Bind(value.type());
+  if (!function.has_value()) {
+    state.SkipWithError(function.error().message.c_str());
+    return;
+  }
+  for (auto _ : state) {
+    auto result = function.value()->Transform(value);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+BENCHMARK_CAPTURE(BM_Transform, identity_long, Transform::Identity(),
+                  Literal::Long(1234567890));
+BENCHMARK_CAPTURE(BM_Transform, identity_string, Transform::Identity(),
+                  Literal::String("iceberg"));
+BENCHMARK_CAPTURE(BM_Transform, bucket_int, Transform::Bucket(16), Literal::Int(42));
+BENCHMARK_CAPTURE(BM_Transform, bucket_long, Transform::Bucket(16),
+                  Literal::Long(1234567890));
+BENCHMARK_CAPTURE(BM_Transform, bucket_string, Transform::Bucket(16),
+                  Literal::String("iceberg"));
+BENCHMARK_CAPTURE(BM_Transform, bucket_decimal, Transform::Bucket(16),
+                  Literal::Decimal(1234567, 9, 2));
+BENCHMARK_CAPTURE(BM_Transform, bucket_uuid, Transform::Bucket(16),
+                  Literal::UUID(
+                      Uuid::FromString("f79c3e09-677c-4bbd-a479-3f349cb785e7").value()));
+BENCHMARK_CAPTURE(BM_Transform, truncate_int, Transform::Truncate(10), Literal::Int(42));
+BENCHMARK_CAPTURE(BM_Transform, truncate_long, Transform::Truncate(10),
+                  Literal::Long(1234567890));
+BENCHMARK_CAPTURE(BM_Transform, truncate_string, Transform::Truncate(3),
+                  Literal::String("iceberg"));
+BENCHMARK_CAPTURE(BM_Transform, truncate_decimal, Transform::Truncate(10),
+                  Literal::Decimal(1234567, 9, 2));
+BENCHMARK_CAPTURE(BM_Transform, year_date, Transform::Year(), Literal::Date(19724));
+BENCHMARK_CAPTURE(BM_Transform, year_timestamp, Transform::Year(),
+                  Literal::Timestamp(kTimestamp));
+BENCHMARK_CAPTURE(BM_Transform, month_date, Transform::Month(), Literal::Date(19724));
+BENCHMARK_CAPTURE(BM_Transform, month_timestamp, Transform::Month(),
+                  Literal::Timestamp(kTimestamp));
+BENCHMARK_CAPTURE(BM_Transform, day_date, Transform::Day(), Literal::Date(19724));
+BENCHMARK_CAPTURE(BM_Transform, day_timestamp, Transform::Day(),
+                  Literal::Timestamp(kTimestamp));
+BENCHMARK_CAPTURE(BM_Transform, hour_timestamp, Transform::Hour(),
+                  Literal::Timestamp(kTimestamp));
+BENCHMARK_CAPTURE(BM_Transform, void_int, Transform::Void(), Literal::Int(42));
+
+}  // namespace
+}  // namespace iceberg
@@ -0,0 +1,84 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "iceberg/util/bucket_util.h"
+#include "iceberg/util/decimal.h"
+#include "iceberg/util/truncate_util.h"
+#include "iceberg/util/uuid.h"
+
+namespace iceberg {
+namespace {
+
+void BM_HashLong(benchmark::State& state) {
+  int64_t value = 1234567890;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(BucketUtils::HashLong(value++));
+  }
+}
+BENCHMARK(BM_HashLong);
+
+void BM_HashBytes(benchmark::State& state) {
+  const std::vector<uint8_t> bytes(state.range(0), 0x5a);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(BucketUtils::HashBytes(bytes));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HashBytes)->Arg(8)->Arg(64)->Arg(1024);
+
+void BM_TruncateUTF8(benchmark::State& state) {
+  // Mixes one, two and three byte code points.
+  const std::string source = "iceberg-été-冰山-table";
+  for (auto _ : state) {
+    auto truncated = TruncateUtils::TruncateUTF8(source, state.range(0));
+    benchmark::DoNotOptimize(truncated);
+  }
+}
+BENCHMARK(BM_TruncateUTF8)->Arg(4)->Arg(16);
+
+void BM_DecimalFromString(benchmark::State& state, std::string_view str) {
+  for (auto _ : state) {
+    auto decimal = Decimal::FromString(str);
+    benchmark::DoNotOptimize(decimal);
+  }
+}
+BENCHMARK_CAPTURE(BM_DecimalFromString, short, std::string_view("1234.56"));
+BENCHMARK_CAPTURE(BM_DecimalFromString, long,
+                  std::string_view("-12345678901234567890123456.789012345678"));
+BENCHMARK_CAPTURE(BM_DecimalFromString, exponent, std::string_view("1.23456E+20"));
+
+void BM_UuidFromString(benchmark::State& state) {
+  constexpr std::string_view kUuid = "f79c3e09-677c-4bbd-a479-3f349cb785e7";
+  for (auto _ : state) {
+    auto uuid = Uuid::FromString(kUuid);
+    benchmark::DoNotOptimize(uuid);
+  }
+}
+BENCHMARK(BM_UuidFromString);
+
+}  // namespace
+}  // namespace iceberg
@@ -0,0 +1,336 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/caching_catalog.h"
+
+#include <list>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "iceberg/table.h"
+#include "iceberg/transaction.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// \brief Encodes an identifier into a key that is unique per table.
+std::string CacheKey(const TableIdentifier& identifier) {
+  std::string key;
+  for (const auto& level : identifier.ns.levels) {
+    key.append(level);
+    key.push_back('\0');
+  }
+  key.push_back('\1');
+  key.append(identifier.name);
+  return key;
+}
+
+/// \brief The immutable state of a loaded table.
+struct CachedTable {
+  std::shared_ptr<TableMetadata> metadata;
+  std::string metadata_location;
+  std::shared_ptr<FileIO> io;
+};
+
+}  // namespace
+
+/// \brief The least recently used list of the cached tables.
+///
+/// Every change of an entry made by a commit or an invalidation bumps a generation
+/// counter. A load records the generation before asking the wrapped catalog, and its
+/// result is only cached if no entry changed meanwhile, so that a slow load never
+/// replaces the result of a more recent commit.
+class CachingCatalog::TableCache {
+ public:
+  explicit TableCache(Options options) : options_(options) {}
+
+  uint64_t generation() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return generation_;
+  }
+
+  /// \brief Returns the cached table and whether it can be returned without
+  /// validation.
+  std::optional<std::pair<CachedTable, bool>> Find(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      return std::nullopt;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second);
+    const bool fresh = Clock::now() - it->second->validated_at < options_.ttl;
+    if (fresh) {
+      ++stats_.hits;
+    }
+    return std::make_pair(it->second->table, fresh);
+  }
+
+  /// \brief Marks a cached table as current if its metadata location is still
+  /// `metadata_location` and no entry changed since `generation`.
+  bool Validate(const std::string& key, const std::string& metadata_location,
+                uint64_t generation) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (generation != generation_ || it == entries_.end() ||
+        it->second->table.metadata_location != metadata_location) {
+      return false;
+    }
+    it->second->validated_at = Clock::now();
+    ++stats_.validated_hits;
+    return true;
+  }
+
+  /// \brief Caches a table read by a load, unless an entry changed since
+  /// `generation`.
+  void PutLoaded(const std::string& key, CachedTable table, uint64_t generation) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.misses;
+    if (generation == generation_) {
+      PutLocked(key, std::move(table));
+    }
+  }
+
+  /// \brief Caches a table returned by a commit.
+  void PutCommitted(const std::string& key, CachedTable table) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++generation_;
+    PutLocked(key, std::move(table));
+  }
+
+  void Remove(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++generation_;
+    if (auto it = entries_.find(key); it != entries_.end()) {
+      lru_.erase(it->second);
+      entries_.erase(it);
+    }
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++generation_;
+    lru_.clear();
+    entries_.clear();
+  }
+
+  Stats stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = stats_;
+    stats.entry_count = static_cast<int64_t>(entries_.size());
+    return stats;
+  }
+
+ private:
+  struct Entry {
+    std::string key;
+    CachedTable table;
+    Clock::time_point validated_at;
+  };
+
+  void PutLocked(const std::string& key, CachedTable table) {
+    if (auto it = entries_.find(key); it != entries_.end()) {
+      it->second->table = std::move(table);
+      it->second->validated_at = Clock::now();
+      lru_.splice(lru_.begin(), lru_, it->second);
+      return;
+    }
+    lru_.push_front(Entry{.key = key, .table = std::move(table),
+                          .validated_at = Clock::now()});
+    entries_.emplace(key, lru_.begin());
+    while (static_cast<int64_t>(entries_.size()) > options_.max_entries) {
+      entries_.erase(lru_.back().key);
+      lru_.pop_back();
+      ++stats_.evictions;
+    }
+  }
+
+  const Options options_;
+  mutable std::mutex mutex_;
+  uint64_t generation_ = 0;
+  /// \brief The entries, most recently used first.
+  std::list<Entry> lru_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> entries_;
+  Stats stats_;
+};
+
+CachingCatalog::CachingCatalog(std::shared_ptr<Catalog> catalog,
+                               std::unique_ptr<TableCache> cache)
+    : catalog_(std::move(catalog)), cache_(std::move(cache)) {}
+
+CachingCatalog::~CachingCatalog() = default;
+
+Result<std::shared_ptr<CachingCatalog>> CachingCatalog::Make(
+    std::shared_ptr<Catalog> catalog, Options options) {
+  if (catalog == nullptr) {
+    return InvalidArgument("Catalog to cache must not be null");
+  }
+  if (options.ttl.count() < 0) {
+    return InvalidArgument("Cache TTL must not be negative, got {}ms",
+                           options.ttl.count());
+  }
+  if (options.max_entries <= 0) {
+    return InvalidArgument("Cache size must be positive, got {}", options.max_entries);
+  }
+  return std::shared_ptr<CachingCatalog>(
+      new CachingCatalog(std::move(catalog), std::make_unique<TableCache>(options)));
+}
+
+std::string_view CachingCatalog::name() const { return catalog_->name(); }
+
+Status CachingCatalog::CreateNamespace(
+    const Namespace& ns, const std::unordered_map<std::string, std::string>& properties) {
+  return catalog_->CreateNamespace(ns, properties);
+}
+
+Result<std::vector<Namespace>> CachingCatalog::ListNamespaces(const Namespace& ns) const {
+  return catalog_->ListNamespaces(ns);
+}
+
+Status CachingCatalog::DropNamespace(const Namespace& ns) {
+  return catalog_->DropNamespace(ns);
+}
+
+Result<bool> CachingCatalog::NamespaceExists(const Namespace& ns) const {
+  return catalog_->NamespaceExists(ns);
+}
+
+Result<std::unordered_map<std::string, std::string>>
+CachingCatalog::GetNamespaceProperties(const Namespace& ns) const {
+  return catalog_->GetNamespaceProperties(ns);
+}
+
+Status CachingCatalog::UpdateNamespaceProperties(
+    const Namespace& ns, const std::unordered_map<std::string, std::string>& updates,
+    const std::unordered_set<std::string>& removals) {
+  return catalog_->UpdateNamespaceProperties(ns, updates, removals);
+}
+
+Result<std::vector<TableIdentifier>> CachingCatalog::ListTables(
+    const Namespace& ns) const {
+  return catalog_->ListTables(ns);
+}
+
+Result<std::unique_ptr<Table>> CachingCatalog::CreateTable(
+    const TableIdentifier& identifier, const Schema& schema, const PartitionSpec& spec,
+    const std::string& location,
+    const std::unordered_map<std::string, std::string>& properties) {
+  ICEBERG_ASSIGN_OR_RAISE(auto table, catalog_->CreateTable(identifier, schema, spec,
+                                                            location, properties));
+  return CacheTable(*table);
+}
+
+Result<std::unique_ptr<Table>> CachingCatalog::UpdateTable(
+    const TableIdentifier& identifier,
+    const std::vector<std::unique_ptr<TableRequirement>>& requirements,
+    const std::vector<std::unique_ptr<TableUpdate>>& updates) {
+  auto table = catalog_->UpdateTable(identifier, requirements, updates);
+  if (!table.has_value()) {
+    // A failed commit usually means that the cached metadata is out of date.
+    cache_->Remove(CacheKey(identifier));
+    return std::unexpected(table.error());
+  }
+  return CacheTable(*table.value());
+}
+
+Result<std::shared_ptr<Transaction>> CachingCatalog::StageCreateTable(
+    const TableIdentifier& identifier, const Schema& schema, const PartitionSpec& spec,
+    const std::string& location,
+    const std::unordered_map<std::string, std::string>& properties) {
+  return catalog_->StageCreateTable(identifier, schema, spec, location, properties);
+}
+
+Result<bool> CachingCatalog::TableExists(const TableIdentifier& identifier) const {
+  return catalog_->TableExists(identifier);
+}
+
+Status CachingCatalog::DropTable(const TableIdentifier& identifier, bool purge) {
+  auto status = catalog_->DropTable(identifier, purge);
+  cache_->Remove(CacheKey(identifier));
+  return status;
+}
+
+Result<std::unique_ptr<Table>> CachingCatalog::LoadTable(
+    const TableIdentifier& identifier) {
+  const auto key = CacheKey(identifier);
+  const auto generation = cache_->generation();
+  if (auto cached = cache_->Find(key); cached.has_value()) {
+    auto& [table, fresh] = cached.value();
+    if (fresh) {
+      return std::make_unique<Table>(identifier, table.metadata, table.metadata_location,
+                                     table.io, shared_from_this());
+    }
+    auto location = catalog_->GetTableMetadataLocation(identifier);
+    if (location.has_value() && cache_->Validate(key, location.value(), generation)) {
+      return std::make_unique<Table>(identifier, table.metadata, table.metadata_location,
+                                     table.io, shared_from_this());
+    }
+  }
+
+  ICEBERG_ASSIGN_OR_RAISE(auto table, catalog_->LoadTable(identifier));
+  cache_->PutLoaded(key,
+                    CachedTable{.metadata = table->metadata(),
+                                .metadata_location = table->metadata_location(),
+                                .io = table->io()},
+                    generation);
+  return std::make_unique<Table>(identifier, table->metadata(),
+                                 table->metadata_location(), table->io(),
+                                 shared_from_this());
+}
+
+Result<std::string> CachingCatalog::GetTableMetadataLocation(
+    const TableIdentifier& identifier) const {
+  return catalog_->GetTableMetadataLocation(identifier);
+}
+
+Result<std::shared_ptr<Table>> CachingCatalog::RegisterTable(
+    const TableIdentifier& identifier, const std::string& metadata_file_location) {
+  ICEBERG_ASSIGN_OR_RAISE(auto table,
+                          catalog_->RegisterTable(identifier, metadata_file_location));
+  return std::shared_ptr<Table>(CacheTable(*table));
+}
+
+std::unique_ptr<Catalog::TableBuilder> CachingCatalog::BuildTable(
+    const TableIdentifier& identifier, const Schema& schema) const {
+  return catalog_->BuildTable(identifier, schema);
+}
+
+void CachingCatalog::Invalidate(const TableIdentifier& identifier) {
+  cache_->Remove(CacheKey(identifier));
+}
+
+void CachingCatalog::InvalidateAll() { cache_->Clear(); }
+
+CachingCatalog::Stats CachingCatalog::stats() const { return cache_->stats(); }
+
+std::unique_ptr<Table> CachingCatalog::CacheTable(const Table& table) {
+  cache_->PutCommitted(CacheKey(table.name()),
+                       CachedTable{.metadata = table.metadata(),
+                                   .metadata_location = table.metadata_location(),
+                                   .io = table.io()});
+  return std::make_unique<Table>(table.name(), table.metadata(),
+                                 table.metadata_location(), table.io(),
+                                 shared_from_this());
+}
+
+}  // namespace iceberg
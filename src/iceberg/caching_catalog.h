@@ -0,0 +1,172 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/caching_catalog.h
+/// Catalog decorator caching loaded table metadata.
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "iceberg/catalog.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+
+namespace iceberg {
+
+/// \brief A Catalog that keeps the metadata of the tables loaded through another
+/// Catalog.
+///
+/// Table metadata is immutable: a commit writes a new metadata file and moves the
+/// pointer of the table to it. The tables returned by LoadTable therefore share the
+/// cached TableMetadata, and with it its schemas, partition specs and sort orders,
+/// instead of reading and parsing the metadata file again.
+///
+/// A cached table is returned as is for `Options::ttl` after it was loaded or last
+/// validated. Past that, the next load asks the wrapped catalog for the location of
+/// the current metadata file with GetTableMetadataLocation. If it did not change the
+/// cached metadata is still current and is kept for another `ttl`; otherwise, or if
+/// the wrapped catalog cannot tell, the table is loaded again. Up to
+/// `Options::max_entries` tables are cached, and the least recently loaded ones are
+/// evicted beyond that.
+///
+/// Creating, registering and committing to tables through this catalog, including
+/// commits of the tables it returns, update the cache, and dropping a table or a
+/// failed commit invalidates it. Commits by other clients are only seen once the
+/// cached entry is validated again, so a table may be up to `ttl` out of date, and
+/// Table::Refresh does not bypass the cache.
+class ICEBERG_EXPORT CachingCatalog
+    : public Catalog,
+      public std::enable_shared_from_this<CachingCatalog> {
+ public:
+  /// \brief Configuration of the cache.
+  struct Options {
+    /// \brief How long a cached table is returned without validating it. Zero
+    /// validates the table on every load.
+    std::chrono::milliseconds ttl = std::chrono::seconds(30);
+    /// \brief The maximum number of cached tables, must be positive.
+    int64_t max_entries = 1000;
+  };
+
+  /// \brief Counters describing the use of the cache.
+  struct Stats {
+    /// \brief Number of loads served from the cache without validation.
+    int64_t hits = 0;
+    /// \brief Number of loads served from the cache after validating the entry.
+    int64_t validated_hits = 0;
+    /// \brief Number of loads that read the table from the wrapped catalog.
+    int64_t misses = 0;
+    /// \brief Number of entries evicted to make room for other entries.
+    int64_t evictions = 0;
+    /// \brief Number of tables currently in the cache.
+    int64_t entry_count = 0;
+  };
+
+  ~CachingCatalog() override;
+
+  /// \brief Creates a catalog caching the tables loaded through `catalog`.
+  ///
+  /// \param catalog The catalog to delegate all operations to
+  /// \param options The configuration of the cache
+  /// \return A Result containing the catalog, or an error if the options are invalid.
+  static Result<std::shared_ptr<CachingCatalog>> Make(std::shared_ptr<Catalog> catalog,
+                                                      Options options);
+
+  std::string_view name() const override;
+
+  Status CreateNamespace(
+      const Namespace& ns,
+      const std::unordered_map<std::string, std::string>& properties) override;
+
+  Result<std::vector<Namespace>> ListNamespaces(const Namespace& ns) const override;
+
+  Status DropNamespace(const Namespace& ns) override;
+
+  Result<bool> NamespaceExists(const Namespace& ns) const override;
+
+  Result<std::unordered_map<std::string, std::string>> GetNamespaceProperties(
+      const Namespace& ns) const override;
+
+  Status UpdateNamespaceProperties(
+      const Namespace& ns, const std::unordered_map<std::string, std::string>& updates,
+      const std::unordered_set<std::string>& removals) override;
+
+  Result<std::vector<TableIdentifier>> ListTables(const Namespace& ns) const override;
+
+  Result<std::unique_ptr<Table>> CreateTable(
+      const TableIdentifier& identifier, const Schema& schema, const PartitionSpec& spec,
+      const std::string& location,
+      const std::unordered_map<std::string, std::string>& properties) override;
+
+  Result<std::unique_ptr<Table>> UpdateTable(
+      const TableIdentifier& identifier,
+      const std::vector<std::unique_ptr<TableRequirement>>& requirements,
+      const std::vector<std::unique_ptr<TableUpdate>>& updates) override;
+
+  Result<std::shared_ptr<Transaction>> StageCreateTable(
+      const TableIdentifier& identifier, const Schema& schema, const PartitionSpec& spec,
+      const std::string& location,
+      const std::unordered_map<std::string, std::string>& properties) override;
+
+  Result<bool> TableExists(const TableIdentifier& identifier) const override;
+
+  Status DropTable(const TableIdentifier& identifier, bool purge) override;
+
+  Result<std::unique_ptr<Table>> LoadTable(const TableIdentifier& identifier) override;
+
+  Result<std::string> GetTableMetadataLocation(
+      const TableIdentifier& identifier) const override;
+
+  Result<std::shared_ptr<Table>> RegisterTable(
+      const TableIdentifier& identifier,
+      const std::string& metadata_file_location) override;
+
+  std::unique_ptr<TableBuilder> BuildTable(const TableIdentifier& identifier,
+                                           const Schema& schema) const override;
+
+  /// \brief Removes a table from the cache, so that the next load reads it again.
+  void Invalidate(const TableIdentifier& identifier);
+
+  /// \brief Removes all tables from the cache. The counters are kept.
+  void InvalidateAll();
+
+  /// \brief Returns a snapshot of the counters of the cache.
+  Stats stats() const;
+
+ private:
+  class TableCache;
+
+  CachingCatalog(std::shared_ptr<Catalog> catalog, std::unique_ptr<TableCache> cache);
+
+  /// \brief Caches a table returned by the wrapped catalog and returns a table of this
+  /// catalog sharing its metadata.
+  std::unique_ptr<Table> CacheTable(const Table& table);
+
+  std::shared_ptr<Catalog> catalog_;
+  std::unique_ptr<TableCache> cache_;
+};
+
+}  // namespace iceberg
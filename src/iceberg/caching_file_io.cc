@@ -0,0 +1,537 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/caching_file_io.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include <zlib.h>
+
+#include "iceberg/util/macros.h"
+#include "iceberg/util/murmurhash3_internal.h"
+
+namespace iceberg {
+
+namespace {
+
+constexpr std::array<std::string_view, 4> kMetadataFileSuffixes = {
+    ".metadata.json", ".metadata.json.gz", ".gz.metadata.json", ".avro"};
+constexpr std::array<std::string_view, 3> kDataFileSuffixes = {".parquet", ".orc",
+                                                               ".puffin"};
+
+/// \brief Suffix of the entry files being written, which are renamed once complete.
+constexpr std::string_view kTempFileSuffix = ".tmp";
+
+constexpr uint32_t kEntryMagic = 0x43464349;  // "ICFC"
+
+/// \brief The header of an entry file, which is followed by the key of the entry and
+/// its content.
+struct EntryHeader {
+  uint32_t magic;
+  /// \brief The CRC-32 checksum of the content.
+  uint32_t checksum;
+  uint64_t key_size;
+  uint64_t content_size;
+};
+
+uint32_t Crc32(std::string_view data) {
+  return static_cast<uint32_t>(crc32_z(crc32(0L, Z_NULL, 0),
+                                       reinterpret_cast<const Bytef*>(data.data()),
+                                       data.size()));
+}
+
+bool HasSuffix(std::string_view location, std::span<const std::string_view> suffixes) {
+  return std::ranges::any_of(
+      suffixes, [&](std::string_view suffix) { return location.ends_with(suffix); });
+}
+
+/// \brief The name of the entry file of a key, from a 128-bit hash of the key.
+std::string EntryFileName(std::string_view key) {
+  std::array<uint64_t, 2> hash;
+  MurmurHash3_x64_128(key.data(), static_cast<int>(key.size()), 0, hash.data());
+  return std::format("{:016x}{:016x}", hash[0], hash[1]);
+}
+
+/// \brief Reads the header and the key of an entry file.
+Result<std::pair<EntryHeader, std::string>> ReadEntryHeader(std::ifstream& in) {
+  EntryHeader header;
+  if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+    return Invalid("Truncated cache entry header");
+  }
+  if (header.magic != kEntryMagic) {
+    return Invalid("Invalid cache entry magic {:#x}", header.magic);
+  }
+  std::string key(header.key_size, '\0');
+  if (!in.read(key.data(), static_cast<std::streamsize>(key.size()))) {
+    return Invalid("Truncated cache entry key");
+  }
+  return std::pair{header, std::move(key)};
+}
+
+/// \brief Reads the content of an entry file.
+///
+/// \return The content, an IOError if the file does not exist, or an Invalid error if
+/// the file is not an entry of the key or does not match its checksum.
+Result<std::string> ReadEntryFile(const std::filesystem::path& path,
+                                  std::string_view key) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return IOError("Cannot open cache entry {}", path.string());
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto entry, ReadEntryHeader(in));
+  const auto& [header, entry_key] = entry;
+  // Keys whose hashes collide share an entry file, which holds the last one written.
+  if (entry_key != key) {
+    return Invalid("Cache entry {} holds another key", path.string());
+  }
+  std::string content(header.content_size, '\0');
+  if (!in.read(content.data(), static_cast<std::streamsize>(content.size()))) {
+    return Invalid("Truncated cache entry {}", path.string());
+  }
+  if (Crc32(content) != header.checksum) {
+    return Invalid("Checksum mismatch of cache entry {}", path.string());
+  }
+  return content;
+}
+
+bool WriteEntryFile(const std::filesystem::path& path, std::string_view key,
+                    std::string_view content) {
+  const EntryHeader header{.magic = kEntryMagic,
+                           .checksum = Crc32(content),
+                           .key_size = key.size(),
+                           .content_size = content.size()};
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(key.data(), static_cast<std::streamsize>(key.size()));
+  out.write(content.data(), static_cast<std::streamsize>(content.size()));
+  out.close();
+  return !out.fail();
+}
+
+int64_t EntrySize(std::string_view key, int64_t content_size) {
+  return static_cast<int64_t>(sizeof(EntryHeader) + key.size()) + content_size;
+}
+
+}  // namespace
+
+/// \brief An LRU cache of byte strings, stored in the files of a local directory.
+///
+/// Entries are read and written outside of the lock. An entry file is written under a
+/// temporary name and renamed once complete, so a concurrent read sees either the
+/// previous file or the complete new one.
+class LocalFileCache {
+ public:
+  LocalFileCache(std::filesystem::path directory, int64_t capacity_bytes)
+      : directory_(std::move(directory)), capacity_bytes_(capacity_bytes) {}
+
+  ~LocalFileCache() = default;
+
+  /// \brief Creates the directory and indexes the entries it already holds, from the
+  /// most to the least recently written.
+  Status Load() {
+    std::error_code ec;
+    std::filesystem::create_directories(directory_, ec);
+    if (ec) {
+      return IOError("Cannot create cache directory {}: {}", directory_.string(),
+                     ec.message());
+    }
+
+    struct LoadedEntry {
+      std::filesystem::file_time_type write_time;
+      Entry entry;
+    };
+    std::vector<LoadedEntry> loaded;
+    std::error_code list_ec;
+    for (const auto& file : std::filesystem::directory_iterator(directory_, list_ec)) {
+      if (!file.is_regular_file(ec)) {
+        continue;
+      }
+      const auto& path = file.path();
+      auto file_name = path.filename().string();
+      std::ifstream in(path, std::ios::binary);
+      auto header = ReadEntryHeader(in);
+      in.close();
+      // Drop incomplete files of an interrupted process, and files of no entry.
+      if (file_name.ends_with(kTempFileSuffix) || !header.has_value() ||
+          file_name != EntryFileName(header->second)) {
+        std::filesystem::remove(path, ec);
+        continue;
+      }
+      auto& [entry_header, key] = header.value();
+      const auto size_bytes =
+          EntrySize(key, static_cast<int64_t>(entry_header.content_size));
+      loaded.push_back(
+          {.write_time = file.last_write_time(ec),
+           .entry = {.key = std::move(key),
+                     .file_name = std::move(file_name),
+                     .size_bytes = size_bytes}});
+    }
+    if (list_ec) {
+      return IOError("Cannot list cache directory {}: {}", directory_.string(),
+                     list_ec.message());
+    }
+    std::ranges::sort(loaded, std::ranges::greater{}, &LoadedEntry::write_time);
+
+    std::lock_guard lock(mutex_);
+    for (auto& [_, entry] : loaded) {
+      stats_.size_bytes += entry.size_bytes;
+      ++stats_.entry_count;
+      entries_.push_back(std::move(entry));
+      index_.emplace(entries_.back().key, std::prev(entries_.end()));
+    }
+    EvictOverCapacity();
+    return {};
+  }
+
+  /// \brief Returns the content of a key and marks it as most recently used, or
+  /// nullopt if the key is not cached or its entry is corrupted.
+  std::optional<std::string> Get(const std::string& key) {
+    std::filesystem::path path;
+    {
+      std::lock_guard lock(mutex_);
+      auto it = index_.find(key);
+      if (it == index_.cend()) {
+        ++stats_.misses;
+        return std::nullopt;
+      }
+      entries_.splice(entries_.begin(), entries_, it->second);
+      path = directory_ / it->second->file_name;
+    }
+
+    auto content = ReadEntryFile(path, key);
+    if (content.has_value()) {
+      // The write time orders the entries by use when they are loaded again.
+      std::error_code ec;
+      std::filesystem::last_write_time(
+          path, std::filesystem::file_time_type::clock::now(), ec);
+    }
+
+    std::lock_guard lock(mutex_);
+    if (content.has_value()) {
+      ++stats_.hits;
+      return std::move(content).value();
+    }
+    ++stats_.misses;
+    if (content.error().kind != ErrorKind::kIOError) {
+      ++stats_.corrupted;
+    }
+    if (auto it = index_.find(key); it != index_.cend()) {
+      Erase(it->second);
+    }
+    return std::nullopt;
+  }
+
+  /// \brief Caches the content of a key, unless it exceeds the capacity. Failures to
+  /// write the entry are ignored, since the content can be read again.
+  void Put(const std::string& key, std::string_view content) {
+    const auto size_bytes = EntrySize(key, static_cast<int64_t>(content.size()));
+    if (size_bytes > capacity_bytes_) {
+      return;
+    }
+    auto file_name = EntryFileName(key);
+    const auto path = directory_ / file_name;
+    const auto temp_path =
+        directory_ / std::format("{}.{}{}", file_name, next_temp_id_++, kTempFileSuffix);
+    std::error_code ec;
+    if (!WriteEntryFile(temp_path, key, content)) {
+      std::filesystem::remove(temp_path, ec);
+      return;
+    }
+
+    std::lock_guard lock(mutex_);
+    if (index_.contains(key)) {
+      // Cached by a concurrent read of the same key.
+      std::filesystem::remove(temp_path, ec);
+      return;
+    }
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+      std::filesystem::remove(temp_path, ec);
+      return;
+    }
+    entries_.push_front(
+        {.key = key, .file_name = std::move(file_name), .size_bytes = size_bytes});
+    index_.emplace(entries_.front().key, entries_.begin());
+    stats_.size_bytes += size_bytes;
+    ++stats_.entry_count;
+    EvictOverCapacity();
+  }
+
+  void Clear() {
+    std::lock_guard lock(mutex_);
+    while (!entries_.empty()) {
+      Erase(std::prev(entries_.end()));
+    }
+  }
+
+  CachingFileIO::Stats stats() const {
+    std::lock_guard lock(mutex_);
+    return stats_;
+  }
+
+ private:
+  struct Entry {
+    std::string key;
+    std::string file_name;
+    int64_t size_bytes;
+  };
+
+  /// \brief Removes an entry and its file. Requires the lock.
+  void Erase(std::list<Entry>::iterator it) {
+    std::error_code ec;
+    std::filesystem::remove(directory_ / it->file_name, ec);
+    stats_.size_bytes -= it->size_bytes;
+    --stats_.entry_count;
+    index_.erase(it->key);
+    entries_.erase(it);
+  }
+
+  /// \brief Evicts the least recently used entries beyond the capacity. Requires the
+  /// lock.
+  void EvictOverCapacity() {
+    while (stats_.size_bytes > capacity_bytes_) {
+      Erase(std::prev(entries_.end()));
+      ++stats_.evictions;
+    }
+  }
+
+  const std::filesystem::path directory_;
+  const int64_t capacity_bytes_;
+  std::atomic<uint64_t> next_temp_id_ = 0;
+  mutable std::mutex mutex_;
+  /// \brief Cached entries, from the most to the least recently used.
+  std::list<Entry> entries_;
+  std::unordered_map<std::string_view, std::list<Entry>::iterator> index_;
+  CachingFileIO::Stats stats_;
+};
+
+namespace {
+
+/// \brief An input file read in blocks, which are cached.
+///
+/// The file of the wrapped FileIO is only opened when a block is not cached, so that
+/// reading a cached file makes no request to the object store.
+class CachingInputFile : public InputFile {
+ public:
+  CachingInputFile(std::shared_ptr<FileIO> file_io,
+                   std::shared_ptr<LocalFileCache> cache, std::string location,
+                   std::optional<size_t> length, int64_t block_size)
+      : file_io_(std::move(file_io)),
+        cache_(std::move(cache)),
+        location_(std::move(location)),
+        length_(length),
+        block_size_(block_size) {}
+
+  const std::string& location() const override { return location_; }
+
+  Result<int64_t> Size() override {
+    if (length_.has_value()) {
+      return static_cast<int64_t>(length_.value());
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto* file, File());
+    return file->Size();
+  }
+
+  Result<int64_t> ReadAt(int64_t offset, std::span<uint8_t> out) override {
+    if (offset < 0) {
+      return InvalidArgument("Cannot read file {} at negative offset {}", location_,
+                             offset);
+    }
+    size_t read = 0;
+    while (read < out.size()) {
+      const int64_t position = offset + static_cast<int64_t>(read);
+      const int64_t block_index = position / block_size_;
+      ICEBERG_ASSIGN_OR_RAISE(auto block, ReadBlock(block_index));
+      const auto block_offset =
+          static_cast<size_t>(position - block_index * block_size_);
+      if (block_offset >= block.size()) {
+        break;
+      }
+      const auto length = std::min(block.size() - block_offset, out.size() - read);
+      std::memcpy(out.data() + read, block.data() + block_offset, length);
+      read += length;
+      // Only the last block of the file is shorter than the block size.
+      if (block.size() < static_cast<size_t>(block_size_)) {
+        break;
+      }
+    }
+    return static_cast<int64_t>(read);
+  }
+
+  Status Close() override {
+    std::lock_guard lock(mutex_);
+    closed_ = true;
+    if (file_ != nullptr) {
+      return file_->Close();
+    }
+    return {};
+  }
+
+ private:
+  /// \brief Returns the file of the wrapped FileIO, opening it on first use.
+  Result<InputFile*> File() {
+    std::lock_guard lock(mutex_);
+    if (closed_) {
+      return Invalid("Cannot read closed file {}", location_);
+    }
+    if (file_ == nullptr) {
+      ICEBERG_ASSIGN_OR_RAISE(file_, file_io_->NewInputFile(location_, length_));
+    }
+    return file_.get();
+  }
+
+  Result<std::string> ReadBlock(int64_t block_index) {
+    {
+      std::lock_guard lock(mutex_);
+      if (closed_) {
+        return Invalid("Cannot read closed file {}", location_);
+      }
+    }
+    // The block size is part of the key, so that blocks of another size are not mixed.
+    auto key = std::format("{}\n{}:{}", location_, block_size_, block_index);
+    if (auto block = cache_->Get(key); block.has_value()) {
+      return std::move(block).value();
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto* file, File());
+    std::string block(block_size_, '\0');
+    std::span<uint8_t> out(reinterpret_cast<uint8_t*>(block.data()), block.size());
+    ICEBERG_ASSIGN_OR_RAISE(auto read, file->ReadAt(block_index * block_size_, out));
+    block.resize(read);
+    cache_->Put(key, block);
+    return block;
+  }
+
+  std::shared_ptr<FileIO> file_io_;
+  std::shared_ptr<LocalFileCache> cache_;
+  std::string location_;
+  std::optional<size_t> length_;
+  int64_t block_size_;
+  std::mutex mutex_;
+  std::unique_ptr<InputFile> file_;
+  bool closed_ = false;
+};
+
+}  // namespace
+
+CachingFileIO::CachingFileIO(std::shared_ptr<FileIO> file_io,
+                             std::shared_ptr<LocalFileCache> cache, Options options)
+    : file_io_(std::move(file_io)),
+      cache_(std::move(cache)),
+      options_(std::move(options)) {}
+
+CachingFileIO::~CachingFileIO() = default;
+
+Result<std::shared_ptr<CachingFileIO>> CachingFileIO::Make(
+    std::shared_ptr<FileIO> file_io, Options options) {
+  if (file_io == nullptr) {
+    return InvalidArgument("FileIO to cache must not be null");
+  }
+  if (options.directory.empty()) {
+    return InvalidArgument("Cache directory must not be empty");
+  }
+  if (options.capacity_bytes <= 0) {
+    return InvalidArgument("Cache capacity must be positive, got {}",
+                           options.capacity_bytes);
+  }
+  if (options.block_size <= 0) {
+    return InvalidArgument("Cache block size must be positive, got {}",
+                           options.block_size);
+  }
+  auto cache =
+      std::make_shared<LocalFileCache>(options.directory, options.capacity_bytes);
+  ICEBERG_RETURN_UNEXPECTED(cache->Load());
+  return std::shared_ptr<CachingFileIO>(
+      new CachingFileIO(std::move(file_io), std::move(cache), std::move(options)));
+}
+
+bool CachingFileIO::IsCacheable(std::string_view file_location) const {
+  return HasSuffix(file_location, kMetadataFileSuffixes) ||
+         (options_.cache_data_files && HasSuffix(file_location, kDataFileSuffixes));
+}
+
+Result<std::string> CachingFileIO::ReadFile(const std::string& file_location,
+                                            std::optional<size_t> length) {
+  if (!IsCacheable(file_location)) {
+    return file_io_->ReadFile(file_location, length);
+  }
+  if (auto content = cache_->Get(file_location); content.has_value()) {
+    return std::move(content).value();
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto content, file_io_->ReadFile(file_location, length));
+  cache_->Put(file_location, content);
+  return content;
+}
+
+Status CachingFileIO::WriteFile(const std::string& file_location,
+                                std::string_view content) {
+  return file_io_->WriteFile(file_location, content);
+}
+
+Status CachingFileIO::WriteFileIfAbsent(const std::string& file_location,
+                                        std::string_view content) {
+  return file_io_->WriteFileIfAbsent(file_location, content);
+}
+
+Result<bool> CachingFileIO::FileExists(const std::string& file_location) {
+  return file_io_->FileExists(file_location);
+}
+
+Result<std::unique_ptr<InputFile>> CachingFileIO::NewInputFile(
+    const std::string& file_location, std::optional<size_t> length) {
+  if (!IsCacheable(file_location)) {
+    return file_io_->NewInputFile(file_location, length);
+  }
+  return std::make_unique<CachingInputFile>(file_io_, cache_, file_location, length,
+                                            options_.block_size);
+}
+
+Result<std::unique_ptr<OutputFile>> CachingFileIO::NewOutputFile(
+    const std::string& file_location) {
+  return file_io_->NewOutputFile(file_location);
+}
+
+Status CachingFileIO::DeleteFile(const std::string& file_location) {
+  return file_io_->DeleteFile(file_location);
+}
+
+std::vector<FileDeleteFailure> CachingFileIO::DeleteFiles(
+    std::span<const std::string> file_locations) {
+  return file_io_->DeleteFiles(file_locations);
+}
+
+Status CachingFileIO::ListFiles(const std::string& prefix,
+                                const std::function<Status(const FileInfo&)>& visitor) {
+  return file_io_->ListFiles(prefix, visitor);
+}
+
+void CachingFileIO::Clear() { cache_->Clear(); }
+
+CachingFileIO::Stats CachingFileIO::stats() const { return cache_->stats(); }
+
+}  // namespace iceberg
@@ -0,0 +1,149 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/caching_file_io.h
+/// FileIO decorator caching immutable files on local disk.
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "iceberg/file_io.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+
+namespace iceberg {
+
+class LocalFileCache;
+
+/// \brief A FileIO that keeps the files read through another FileIO on local disk.
+///
+/// Iceberg never rewrites a file in place: metadata files, manifest lists, manifests
+/// and data files each get a new path, so a cached file never goes stale and the cache
+/// needs no invalidation. Repeated reads of the same tables are served from the local
+/// disk instead of the object store.
+///
+/// Table metadata files (`.metadata.json`, optionally gzipped) and Avro files, which
+/// are manifests and manifest lists, are cached. Data files (`.parquet`, `.orc` and
+/// `.puffin`) are only cached when `Options::cache_data_files` is set. Other files,
+/// such as the mutable `version-hint.text`, are never cached.
+///
+/// Files read whole with ReadFile are cached whole. Files opened with NewInputFile are
+/// cached in blocks of `Options::block_size` bytes, so that reading the footer and a
+/// few column chunks of a large data file only caches those. Each entry is stored in
+/// its own file with a CRC-32 checksum of its content, which is verified on every
+/// read: an entry that does not match is dropped and read again from the wrapped
+/// FileIO. The entries hold up to `Options::capacity_bytes` bytes of disk space, and
+/// the least recently used entries are evicted beyond that. Entries left in the cache
+/// directory by a previous process are reused.
+///
+/// Writes and deletes go to the wrapped FileIO. Deleting a file does not remove its
+/// entries, which are evicted like any other once they are no longer read.
+class ICEBERG_EXPORT CachingFileIO : public FileIO {
+ public:
+  /// \brief Configuration of the cache.
+  struct Options {
+    /// \brief The directory holding the cached entries, created if missing. It should
+    /// not be shared by concurrent processes.
+    std::string directory;
+    /// \brief The disk space in bytes used by the cached entries, must be positive.
+    int64_t capacity_bytes = 0;
+    /// \brief The size in bytes of the blocks of the files opened with NewInputFile.
+    int64_t block_size = 1024 * 1024;
+    /// \brief Whether data files are cached, in addition to metadata files.
+    bool cache_data_files = false;
+  };
+
+  /// \brief Counters describing the use of the cache.
+  struct Stats {
+    /// \brief Number of reads served from the cache.
+    int64_t hits = 0;
+    /// \brief Number of reads of cacheable files not served from the cache.
+    int64_t misses = 0;
+    /// \brief Number of entries evicted to make room for other entries.
+    int64_t evictions = 0;
+    /// \brief Number of entries dropped because they did not match their checksum.
+    int64_t corrupted = 0;
+    /// \brief Number of entries currently in the cache.
+    int64_t entry_count = 0;
+    /// \brief Disk space in bytes used by the entries currently in the cache.
+    int64_t size_bytes = 0;
+  };
+
+  ~CachingFileIO() override;
+
+  /// \brief Creates a FileIO caching the files read through `file_io`.
+  ///
+  /// \param file_io The FileIO to read the files that are not cached
+  /// \param options The configuration of the cache
+  /// \return A Result containing the FileIO, or an error if the options are invalid or
+  /// the cache directory cannot be created.
+  static Result<std::shared_ptr<CachingFileIO>> Make(std::shared_ptr<FileIO> file_io,
+                                                     Options options);
+
+  Result<std::string> ReadFile(const std::string& file_location,
+                               std::optional<size_t> length) override;
+
+  Status WriteFile(const std::string& file_location, std::string_view content) override;
+
+  Status WriteFileIfAbsent(const std::string& file_location,
+                           std::string_view content) override;
+
+  Result<bool> FileExists(const std::string& file_location) override;
+
+  Result<std::unique_ptr<InputFile>> NewInputFile(const std::string& file_location,
+                                                  std::optional<size_t> length) override;
+
+  Result<std::unique_ptr<OutputFile>> NewOutputFile(
+      const std::string& file_location) override;
+
+  Status DeleteFile(const std::string& file_location) override;
+
+  std::vector<FileDeleteFailure> DeleteFiles(
+      std::span<const std::string> file_locations) override;
+
+  Status ListFiles(const std::string& prefix,
+                   const std::function<Status(const FileInfo&)>& visitor) override;
+
+  /// \brief Returns whether the files at the given location are cached.
+  bool IsCacheable(std::string_view file_location) const;
+
+  /// \brief Removes all entries from the cache. The counters are kept.
+  void Clear();
+
+  /// \brief Returns a snapshot of the counters of the cache.
+  Stats stats() const;
+
+ private:
+  CachingFileIO(std::shared_ptr<FileIO> file_io, std::shared_ptr<LocalFileCache> cache,
+                Options options);
+
+  std::shared_ptr<FileIO> file_io_;
+  std::shared_ptr<LocalFileCache> cache_;
+  Options options_;
+};
+
+}  // namespace iceberg
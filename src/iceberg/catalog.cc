@@ -0,0 +1,39 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/catalog.h"
+
+#include "iceberg/async.h"
+#include "iceberg/table.h"
+
+namespace iceberg {
+
+Result<std::string> Catalog::GetTableMetadataLocation(
+    const TableIdentifier& identifier) const {
+  return NotSupported("Catalog {} does not expose metadata locations", name());
+}
+
+Task<Result<std::unique_ptr<Table>>> Catalog::LoadTableAsync(
+    TableIdentifier identifier, std::shared_ptr<Executor> executor) {
+  return RunOn(std::move(executor), [this, identifier = std::move(identifier)]() {
+    return LoadTable(identifier);
+  });
+}
+
+}  // namespace iceberg
@@ -168,6 +168,29 @@ class ICEBERG_EXPORT Catalog {
   /// ErrorKind::kNoSuchTable if the table does not exist
   virtual Result<std::unique_ptr<Table>> LoadTable(const TableIdentifier& identifier) = 0;
 
+  /// \brief Get the location of the current metadata file of a table
+  ///
+  /// Catalogs that keep a pointer to the current metadata file return it without
+  /// reading the file, which lets callers holding a table check cheaply whether it is
+  /// still current. The default implementation returns ErrorKind::kNotSupported.
+  ///
+  /// \param identifier a table identifier
+  /// \return the metadata file location, or an error if the table does not exist
+  virtual Result<std::string> GetTableMetadataLocation(
+      const TableIdentifier& identifier) const;
+
+  /// \brief Load a table without blocking the awaiting coroutine
+  ///
+  /// The default implementation calls LoadTable() on the executor. Catalogs with
+  /// asynchronous clients can override it to not block a thread of the executor.
+  /// The catalog must outlive the task.
+  ///
+  /// \param identifier a table identifier
+  /// \param executor the executor of the blocking call, the DefaultExecutor() if null
+  /// \return a task returning what LoadTable() returns
+  virtual Task<Result<std::unique_ptr<Table>>> LoadTableAsync(
+      TableIdentifier identifier, std::shared_ptr<Executor> executor = nullptr);
+
   /// \brief Register a table with the catalog if it does not exist
   ///
   /// \param identifier a table identifier
@@ -0,0 +1,563 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/catalog/hadoop/hadoop_catalog.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <format>
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "iceberg/exception.h"
+#include "iceberg/file_io.h"
+#include "iceberg/json_internal.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/sort_order.h"
+#include "iceberg/table.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/table_properties.h"
+#include "iceberg/table_requirement.h"
+#include "iceberg/table_update.h"
+#include "iceberg/util/macros.h"
+#include "iceberg/util/tracing.h"
+#include "iceberg/util/uuid.h"
+
+namespace iceberg {
+
+namespace {
+
+constexpr std::string_view kMetadataFolder = "metadata";
+constexpr std::string_view kVersionFilePrefix = "v";
+constexpr std::string_view kVersionFileSuffix = ".metadata.json";
+
+std::string_view TrimTrailingSlashes(std::string_view location) {
+  while (location.ends_with('/')) {
+    location.remove_suffix(1);
+  }
+  return location;
+}
+
+std::string_view FileName(std::string_view location) {
+  if (auto pos = location.find_last_of('/'); pos != std::string_view::npos) {
+    location.remove_prefix(pos + 1);
+  }
+  return location;
+}
+
+/// \brief Parses a positive version number, with no sign or surrounding characters.
+std::optional<int64_t> ParseVersion(std::string_view digits) {
+  int64_t version = 0;
+  auto [end, error] = std::from_chars(digits.data(), digits.data() + digits.size(),
+                                      version);
+  if (digits.empty() || digits.front() == '-' || error != std::errc() ||
+      end != digits.data() + digits.size() || version <= 0) {
+    return std::nullopt;
+  }
+  return version;
+}
+
+/// \brief Returns the version of a metadata file named "v<version>.metadata.json".
+std::optional<int64_t> VersionFromFileName(std::string_view file_name) {
+  if (!file_name.starts_with(kVersionFilePrefix) ||
+      !file_name.ends_with(kVersionFileSuffix)) {
+    return std::nullopt;
+  }
+  file_name.remove_prefix(kVersionFilePrefix.size());
+  file_name.remove_suffix(kVersionFileSuffix.size());
+  return ParseVersion(file_name);
+}
+
+std::string ToString(const Namespace& ns) {
+  std::string result;
+  for (const auto& level : ns.levels) {
+    if (!result.empty()) {
+      result += '.';
+    }
+    result += level;
+  }
+  return result;
+}
+
+std::string ToString(const TableIdentifier& identifier) {
+  return identifier.ns.levels.empty()
+             ? identifier.name
+             : std::format("{}.{}", ToString(identifier.ns), identifier.name);
+}
+
+Status ValidateName(std::string_view name) {
+  if (name.empty() || name == "." || name == ".." ||
+      name.find('/') != std::string_view::npos) {
+    return InvalidArgument("Invalid name '{}' of a HadoopCatalog, names must not be "
+                           "empty, '.' or '..', or contain '/'",
+                           name);
+  }
+  return {};
+}
+
+}  // namespace
+
+HadoopCatalog::HadoopCatalog(std::string name, std::shared_ptr<FileIO> file_io,
+                             std::string warehouse_location,
+                             std::unordered_map<std::string, std::string> properties)
+    : catalog_name_(std::move(name)),
+      file_io_(std::move(file_io)),
+      warehouse_location_(TrimTrailingSlashes(warehouse_location)),
+      properties_(std::move(properties)) {}
+
+HadoopCatalog::~HadoopCatalog() = default;
+
+std::shared_ptr<HadoopCatalog> HadoopCatalog::Make(
+    std::string name, std::shared_ptr<FileIO> file_io, std::string warehouse_location,
+    std::unordered_map<std::string, std::string> properties) {
+  return std::make_shared<HadoopCatalog>(std::move(name), std::move(file_io),
+                                         std::move(warehouse_location),
+                                         std::move(properties));
+}
+
+std::string_view HadoopCatalog::name() const { return catalog_name_; }
+
+Result<std::string> HadoopCatalog::NamespaceLocation(const Namespace& ns) const {
+  std::string location = warehouse_location_;
+  for (const auto& level : ns.levels) {
+    ICEBERG_RETURN_UNEXPECTED(ValidateName(level));
+    location += '/';
+    location += level;
+  }
+  return location;
+}
+
+Result<std::string> HadoopCatalog::TableLocation(
+    const TableIdentifier& identifier) const {
+  ICEBERG_RETURN_UNEXPECTED(ValidateName(identifier.name));
+  ICEBERG_ASSIGN_OR_RAISE(auto location, NamespaceLocation(identifier.ns));
+  return std::format("{}/{}", location, identifier.name);
+}
+
+std::string HadoopCatalog::VersionFileLocation(std::string_view table_location,
+                                               int64_t version) {
+  return std::format("{}/{}/{}{}{}", TrimTrailingSlashes(table_location),
+                     kMetadataFolder, kVersionFilePrefix, version, kVersionFileSuffix);
+}
+
+Result<std::optional<int64_t>> HadoopCatalog::FindVersion(
+    const std::string& table_location) const {
+  if (!file_io_) [[unlikely]] {
+    return InvalidArgument("file_io is not set for catalog {}", catalog_name_);
+  }
+  const auto metadata_location = std::format("{}/{}", table_location, kMetadataFolder);
+  // A missing or partly written hint falls back to the listing, as does a hint whose
+  // version does not exist.
+  if (auto hint = file_io_->ReadFile(
+          std::format("{}/{}", metadata_location, kVersionHintFile), std::nullopt);
+      hint.has_value()) {
+    std::string_view digits = hint.value();
+    while (!digits.empty() && std::isspace(static_cast<unsigned char>(digits.back()))) {
+      digits.remove_suffix(1);
+    }
+    if (auto version = ParseVersion(digits); version.has_value()) {
+      const auto version_location = VersionFileLocation(table_location, *version);
+      ICEBERG_ASSIGN_OR_RAISE(auto exists, file_io_->FileExists(version_location));
+      if (exists) {
+        return FindVersionFrom(table_location, *version);
+      }
+    }
+  }
+
+  std::optional<int64_t> latest;
+  ICEBERG_RETURN_UNEXPECTED(
+      file_io_->ListFiles(metadata_location, [&](const FileInfo& file) -> Status {
+        if (auto version = VersionFromFileName(FileName(file.location));
+            version.has_value() && *version > latest.value_or(0)) {
+          latest = version;
+        }
+        return {};
+      }));
+  if (!latest.has_value()) {
+    return std::nullopt;
+  }
+  // Versions may have been committed since the listing.
+  return FindVersionFrom(table_location, *latest);
+}
+
+Result<int64_t> HadoopCatalog::FindVersionFrom(const std::string& table_location,
+                                               int64_t version) const {
+  // Versions are written one after the other, so the versions after an existing one
+  // exist up to the latest: probe with growing steps until a version is missing, then
+  // search between the last existing version and the missing one.
+  int64_t step = 1;
+  int64_t missing = version + step;
+  while (true) {
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto exists, file_io_->FileExists(VersionFileLocation(table_location, missing)));
+    if (!exists) {
+      break;
+    }
+    version = missing;
+    step *= 2;
+    missing = version + step;
+  }
+  while (missing - version > 1) {
+    const int64_t middle = version + (missing - version) / 2;
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto exists, file_io_->FileExists(VersionFileLocation(table_location, middle)));
+    (exists ? version : missing) = middle;
+  }
+  return version;
+}
+
+Status HadoopCatalog::WriteVersion(const std::string& table_location, int64_t version,
+                                   const TableMetadata& metadata) {
+  ICEBERG_ASSIGN_OR_RAISE(auto content, ToJsonString(metadata));
+  ICEBERG_RETURN_UNEXPECTED(file_io_->WriteFileIfAbsent(
+      VersionFileLocation(table_location, version), content));
+  // The version is committed: a hint that cannot be written only makes the next
+  // lookups probe further.
+  std::ignore = file_io_->WriteFile(
+      std::format("{}/{}/{}", table_location, kMetadataFolder, kVersionHintFile),
+      std::to_string(version));
+  return {};
+}
+
+Result<std::vector<std::vector<std::string>>> HadoopCatalog::ListTablePaths(
+    const Namespace& ns) const {
+  if (!file_io_) [[unlikely]] {
+    return InvalidArgument("file_io is not set for catalog {}", catalog_name_);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto ns_location, NamespaceLocation(ns));
+  const auto prefix = ns_location + '/';
+  std::set<std::vector<std::string>> table_paths;
+  ICEBERG_RETURN_UNEXPECTED(
+      file_io_->ListFiles(ns_location, [&](const FileInfo& file) -> Status {
+        std::string_view relative = file.location;
+        if (!relative.starts_with(prefix)) {
+          return {};
+        }
+        relative.remove_prefix(prefix.size());
+        std::vector<std::string> levels;
+        for (size_t begin = 0; begin <= relative.size();) {
+          const auto end = std::min(relative.find('/', begin), relative.size());
+          levels.emplace_back(relative.substr(begin, end - begin));
+          begin = end + 1;
+        }
+        // A table is a folder whose metadata folder holds a version or a hint.
+        if (levels.size() >= 3 && levels[levels.size() - 2] == kMetadataFolder &&
+            (levels.back() == kVersionHintFile ||
+             VersionFromFileName(levels.back()).has_value())) {
+          levels.resize(levels.size() - 2);
+          table_paths.insert(std::move(levels));
+        }
+        return {};
+      }));
+  return std::vector<std::vector<std::string>>(table_paths.begin(), table_paths.end());
+}
+
+Status HadoopCatalog::CreateNamespace(
+    const Namespace& ns, const std::unordered_map<std::string, std::string>& properties) {
+  return NotSupported(
+      "Cannot create namespace {}, namespaces of a HadoopCatalog exist while they hold "
+      "tables",
+      ToString(ns));
+}
+
+Result<std::vector<Namespace>> HadoopCatalog::ListNamespaces(const Namespace& ns) const {
+  ICEBERG_ASSIGN_OR_RAISE(auto table_paths, ListTablePaths(ns));
+  if (!ns.levels.empty() && table_paths.empty()) {
+    return NoSuchNamespace("Namespace {} does not exist", ToString(ns));
+  }
+  std::vector<Namespace> namespaces;
+  for (const auto& path : table_paths) {
+    if (path.size() < 2 ||
+        (!namespaces.empty() && namespaces.back().levels.back() == path.front())) {
+      continue;
+    }
+    Namespace child = ns;
+    child.levels.push_back(path.front());
+    namespaces.push_back(std::move(child));
+  }
+  return namespaces;
+}
+
+Status HadoopCatalog::DropNamespace(const Namespace& ns) {
+  ICEBERG_ASSIGN_OR_RAISE(auto exists, NamespaceExists(ns));
+  if (exists) {
+    return NotAllowed("Namespace {} is not empty", ToString(ns));
+  }
+  return NoSuchNamespace("Namespace {} does not exist", ToString(ns));
+}
+
+Result<bool> HadoopCatalog::NamespaceExists(const Namespace& ns) const {
+  if (ns.levels.empty()) {
+    return true;
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto table_paths, ListTablePaths(ns));
+  return !table_paths.empty();
+}
+
+Result<std::unordered_map<std::string, std::string>>
+HadoopCatalog::GetNamespaceProperties(const Namespace& ns) const {
+  ICEBERG_ASSIGN_OR_RAISE(auto exists, NamespaceExists(ns));
+  if (!exists) {
+    return NoSuchNamespace("Namespace {} does not exist", ToString(ns));
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto location, NamespaceLocation(ns));
+  return std::unordered_map<std::string, std::string>{{"location", std::move(location)}};
+}
+
+Status HadoopCatalog::UpdateNamespaceProperties(
+    const Namespace& ns, const std::unordered_map<std::string, std::string>& updates,
+    const std::unordered_set<std::string>& removals) {
+  return NotSupported("Namespaces of a HadoopCatalog have no properties");
+}
+
+Result<std::vector<TableIdentifier>> HadoopCatalog::ListTables(
+    const Namespace& ns) const {
+  ICEBERG_ASSIGN_OR_RAISE(auto table_paths, ListTablePaths(ns));
+  if (!ns.levels.empty() && table_paths.empty()) {
+    return NoSuchNamespace("Namespace {} does not exist", ToString(ns));
+  }
+  std::vector<TableIdentifier> tables;
+  for (auto& path : table_paths) {
+    if (path.size() == 1) {
+      tables.emplace_back(ns, std::move(path.front()));
+    }
+  }
+  return tables;
+}
+
+Result<std::unique_ptr<Table>> HadoopCatalog::CreateTable(
+    const TableIdentifier& identifier, const Schema& schema, const PartitionSpec& spec,
+    const std::string& location,
+    const std::unordered_map<std::string, std::string>& properties) {
+  ICEBERG_TRACE_SCOPE(trace, "Catalog::CreateTable");
+  ICEBERG_TRACE_ATTRIBUTE(trace, "table", identifier.name);
+  ICEBERG_ASSIGN_OR_RAISE(auto table_location, TableLocation(identifier));
+  if (!location.empty() && TrimTrailingSlashes(location) != table_location) {
+    return InvalidArgument(
+        "Cannot create table {} at {}, tables of a HadoopCatalog are at {}",
+        ToString(identifier), location, table_location);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto version, FindVersion(table_location));
+  if (version.has_value()) {
+    return AlreadyExists("Table {} already exists", ToString(identifier));
+  }
+
+  auto table_properties = properties;
+  int8_t format_version = TableMetadata::kDefaultTableFormatVersion;
+  if (auto it = table_properties.find(TableProperties::kFormatVersion.key());
+      it != table_properties.end()) {
+    auto parsed = ParseVersion(it->second);
+    if (!parsed.has_value() || *parsed > TableMetadata::kSupportedTableFormatVersion) {
+      return InvalidArgument("Unsupported format version: {}", it->second);
+    }
+    format_version = static_cast<int8_t>(*parsed);
+    table_properties.erase(it);
+  }
+
+  auto table_schema = std::make_shared<Schema>(
+      std::vector<SchemaField>(schema.fields().begin(), schema.fields().end()),
+      Schema::kInitialSchemaId);
+  auto table_spec = std::make_shared<PartitionSpec>(
+      table_schema, spec.spec_id(),
+      std::vector<PartitionField>(spec.fields().begin(), spec.fields().end()),
+      spec.last_assigned_field_id());
+  const auto& sort_order = SortOrder::Unsorted();
+  TableMetadata base{
+      .format_version = format_version,
+      .table_uuid = Uuid::GenerateV4().ToString(),
+      .location = table_location,
+      .last_sequence_number = TableMetadata::kInitialSequenceNumber,
+      .last_updated_ms = std::chrono::time_point_cast<std::chrono::milliseconds>(
+          std::chrono::system_clock::now()),
+      .last_column_id = Schema::kInvalidColumnId,
+      .partition_specs = {table_spec},
+      .default_spec_id = table_spec->spec_id(),
+      .last_partition_id = table_spec->last_assigned_field_id(),
+      .properties = std::move(table_properties),
+      .current_snapshot_id = Snapshot::kInvalidSnapshotId,
+      .sort_orders = {sort_order},
+      .default_sort_order_id = sort_order->order_id(),
+      .next_row_id = TableMetadata::kInitialRowId,
+  };
+  auto builder = TableMetadataBuilder::BuildFrom(&base);
+  builder->SetCurrentSchema(std::move(table_schema), Schema::kInvalidColumnId);
+  ICEBERG_ASSIGN_OR_RAISE(std::shared_ptr<TableMetadata> metadata, builder->Build());
+
+  constexpr int64_t kFirstVersion = 1;
+  auto status = WriteVersion(table_location, kFirstVersion, *metadata);
+  if (!status.has_value() && status.error().kind == ErrorKind::kAlreadyExists) {
+    return AlreadyExists("Table {} already exists", ToString(identifier));
+  }
+  ICEBERG_RETURN_UNEXPECTED(status);
+  return std::make_unique<Table>(identifier, std::move(metadata),
+                                 VersionFileLocation(table_location, kFirstVersion),
+                                 file_io_,
+                                 std::static_pointer_cast<Catalog>(shared_from_this()));
+}
+
+Result<std::unique_ptr<Table>> HadoopCatalog::UpdateTable(
+    const TableIdentifier& identifier,
+    const std::vector<std::unique_ptr<TableRequirement>>& requirements,
+    const std::vector<std::unique_ptr<TableUpdate>>& updates) {
+  ICEBERG_TRACE_SCOPE(trace, "Catalog::UpdateTable");
+  ICEBERG_TRACE_ATTRIBUTE(trace, "table", identifier.name);
+  ICEBERG_ASSIGN_OR_RAISE(auto table_location, TableLocation(identifier));
+  ICEBERG_ASSIGN_OR_RAISE(auto version, FindVersion(table_location));
+  if (!version.has_value()) {
+    return NoSuchTable("Table {} does not exist", ToString(identifier));
+  }
+  const auto base_location = VersionFileLocation(table_location, *version);
+  ICEBERG_ASSIGN_OR_RAISE(auto base, TableMetadataUtil::Read(*file_io_, base_location));
+  for (const auto& requirement : requirements) {
+    ICEBERG_RETURN_UNEXPECTED(requirement->Validate(base.get()));
+  }
+
+  auto builder = TableMetadataBuilder::BuildFrom(base.get());
+  for (const auto& update : updates) {
+    update->ApplyTo(*builder);
+  }
+  builder->SetPreviousMetadataLocation(base_location);
+  ICEBERG_ASSIGN_OR_RAISE(std::shared_ptr<TableMetadata> metadata, builder->Build());
+
+  // The version is only written if no concurrent commit wrote it, which makes the
+  // requirements validated against the base hold for the commit.
+  const int64_t new_version = *version + 1;
+  auto status = WriteVersion(table_location, new_version, *metadata);
+  if (!status.has_value() && status.error().kind == ErrorKind::kAlreadyExists) {
+    return CommitFailed("Cannot commit version {} of table {}, it was committed "
+                        "concurrently",
+                        new_version, ToString(identifier));
+  }
+  ICEBERG_RETURN_UNEXPECTED(status);
+
+  // The files that cannot be deleted are left behind as orphan files, the commit has
+  // succeeded already.
+  if (auto removed_files = TableMetadataUtil::RemovedMetadataFiles(*base, *metadata);
+      !removed_files.empty()) {
+    std::ignore = file_io_->DeleteFiles(removed_files);
+  }
+
+  return std::make_unique<Table>(identifier, std::move(metadata),
+                                 VersionFileLocation(table_location, new_version),
+                                 file_io_,
+                                 std::static_pointer_cast<Catalog>(shared_from_this()));
+}
+
+Result<std::shared_ptr<Transaction>> HadoopCatalog::StageCreateTable(
+    const TableIdentifier& identifier, const Schema& schema, const PartitionSpec& spec,
+    const std::string& location,
+    const std::unordered_map<std::string, std::string>& properties) {
+  return NotImplemented("stage create table");
+}
+
+Result<bool> HadoopCatalog::TableExists(const TableIdentifier& identifier) const {
+  ICEBERG_ASSIGN_OR_RAISE(auto table_location, TableLocation(identifier));
+  ICEBERG_ASSIGN_OR_RAISE(auto version, FindVersion(table_location));
+  return version.has_value();
+}
+
+Status HadoopCatalog::DropTable(const TableIdentifier& identifier, bool purge) {
+  ICEBERG_TRACE_SCOPE(trace, "Catalog::DropTable");
+  ICEBERG_TRACE_ATTRIBUTE(trace, "table", identifier.name);
+  if (!file_io_) [[unlikely]] {
+    return InvalidArgument("file_io is not set for catalog {}", catalog_name_);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto table_location, TableLocation(identifier));
+  const auto prefix =
+      purge ? table_location : std::format("{}/{}", table_location, kMetadataFolder);
+  // The hint and the versions are deleted last, so that a table whose files could not
+  // all be deleted can still be loaded and dropped again.
+  std::vector<std::string> files;
+  std::vector<std::string> version_files;
+  ICEBERG_RETURN_UNEXPECTED(
+      file_io_->ListFiles(prefix, [&](const FileInfo& file) -> Status {
+        const auto file_name = FileName(file.location);
+        auto& batch = file_name == kVersionHintFile ||
+                              VersionFromFileName(file_name).has_value()
+                          ? version_files
+                          : files;
+        batch.push_back(file.location);
+        return {};
+      }));
+  for (const auto* batch : {&files, &version_files}) {
+    if (auto failures = file_io_->DeleteFiles(*batch); !failures.empty()) {
+      return std::unexpected(std::move(failures.front().error));
+    }
+  }
+  return {};
+}
+
+Result<std::unique_ptr<Table>> HadoopCatalog::LoadTable(
+    const TableIdentifier& identifier) {
+  ICEBERG_TRACE_SCOPE(trace, "Catalog::LoadTable");
+  ICEBERG_TRACE_ATTRIBUTE(trace, "table", identifier.name);
+  ICEBERG_ASSIGN_OR_RAISE(auto metadata_location, GetTableMetadataLocation(identifier));
+  ICEBERG_ASSIGN_OR_RAISE(auto metadata,
+                          TableMetadataUtil::Read(*file_io_, metadata_location));
+  return std::make_unique<Table>(identifier, std::move(metadata),
+                                 std::move(metadata_location), file_io_,
+                                 std::static_pointer_cast<Catalog>(shared_from_this()));
+}
+
+Result<std::string> HadoopCatalog::GetTableMetadataLocation(
+    const TableIdentifier& identifier) const {
+  ICEBERG_ASSIGN_OR_RAISE(auto table_location, TableLocation(identifier));
+  ICEBERG_ASSIGN_OR_RAISE(auto version, FindVersion(table_location));
+  if (!version.has_value()) {
+    return NoSuchTable("Table {} does not exist", ToString(identifier));
+  }
+  return VersionFileLocation(table_location, *version);
+}
+
+Result<std::shared_ptr<Table>> HadoopCatalog::RegisterTable(
+    const TableIdentifier& identifier, const std::string& metadata_file_location) {
+  ICEBERG_ASSIGN_OR_RAISE(auto table_location, TableLocation(identifier));
+  ICEBERG_ASSIGN_OR_RAISE(auto version, FindVersion(table_location));
+  if (version.has_value()) {
+    return AlreadyExists("Table {} already exists", ToString(identifier));
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto metadata,
+                          TableMetadataUtil::Read(*file_io_, metadata_file_location));
+  if (TrimTrailingSlashes(metadata->location) != table_location) {
+    return InvalidArgument(
+        "Cannot register table {} with metadata at {}, tables of a HadoopCatalog are "
+        "at {}",
+        ToString(identifier), metadata->location, table_location);
+  }
+  auto status = WriteVersion(table_location, 1, *metadata);
+  if (!status.has_value() && status.error().kind == ErrorKind::kAlreadyExists) {
+    return AlreadyExists("Table {} already exists", ToString(identifier));
+  }
+  ICEBERG_RETURN_UNEXPECTED(status);
+  ICEBERG_ASSIGN_OR_RAISE(auto table, LoadTable(identifier));
+  return std::shared_ptr<Table>(std::move(table));
+}
+
+std::unique_ptr<Catalog::TableBuilder> HadoopCatalog::BuildTable(
+    const TableIdentifier& identifier, const Schema& schema) const {
+  throw IcebergError("not implemented");
+}
+
+}  // namespace iceberg
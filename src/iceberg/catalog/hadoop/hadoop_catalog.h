@@ -0,0 +1,178 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/catalog/hadoop/hadoop_catalog.h
+/// A catalog keeping its tables in the files of a warehouse location.
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "iceberg/catalog.h"
+
+namespace iceberg {
+
+/// \brief A catalog keeping its tables in the files of a warehouse location, with no
+/// service other than the storage of the FileIO.
+///
+/// The table `a.b.t` is at `<warehouse>/a/b/t`, and its metadata files are named
+/// `v<version>.metadata.json` in the `metadata` folder of the table, as in the Hadoop
+/// catalog of the Java implementation. A commit writes the next version with
+/// FileIO::WriteFileIfAbsent, so that of concurrent commits of a version only one
+/// succeeds, and the others fail with ErrorKind::kCommitFailed. Metadata files are not
+/// compressed, so that a version has a single file.
+///
+/// The current version of a table is read from the `version-hint.text` file of its
+/// metadata folder, which each commit rewrites once its version is written. As the
+/// hint may lag behind concurrent commits, the versions after it are probed with
+/// exponentially growing steps and a binary search, so that loading a table takes a
+/// few requests however many versions it has. Tables without a readable hint list
+/// their metadata folder to find their latest version instead.
+///
+/// Namespaces are the folders of the warehouse holding tables: as object stores have
+/// no empty folders, they cannot be created, have no properties other than their
+/// `location`, and exist while they hold a table. Listing namespaces and tables lists
+/// the files under the namespace.
+class ICEBERG_EXPORT HadoopCatalog
+    : public Catalog,
+      public std::enable_shared_from_this<HadoopCatalog> {
+ public:
+  /// \brief The file of the metadata folder holding the current version of a table.
+  static constexpr std::string_view kVersionHintFile = "version-hint.text";
+
+  HadoopCatalog(std::string name, std::shared_ptr<FileIO> file_io,
+                std::string warehouse_location,
+                std::unordered_map<std::string, std::string> properties);
+  ~HadoopCatalog() override;
+
+  static std::shared_ptr<HadoopCatalog> Make(
+      std::string name, std::shared_ptr<FileIO> file_io, std::string warehouse_location,
+      std::unordered_map<std::string, std::string> properties = {});
+
+  std::string_view name() const override;
+
+  /// \brief Returns ErrorKind::kNotSupported, namespaces exist while they hold tables.
+  Status CreateNamespace(
+      const Namespace& ns,
+      const std::unordered_map<std::string, std::string>& properties) override;
+
+  Result<std::vector<Namespace>> ListNamespaces(const Namespace& ns) const override;
+
+  /// \brief Returns ErrorKind::kNotAllowed if the namespace holds tables, or
+  /// ErrorKind::kNoSuchNamespace otherwise.
+  Status DropNamespace(const Namespace& ns) override;
+
+  Result<bool> NamespaceExists(const Namespace& ns) const override;
+
+  Result<std::unordered_map<std::string, std::string>> GetNamespaceProperties(
+      const Namespace& ns) const override;
+
+  /// \brief Returns ErrorKind::kNotSupported, namespaces have no properties.
+  Status UpdateNamespaceProperties(
+      const Namespace& ns, const std::unordered_map<std::string, std::string>& updates,
+      const std::unordered_set<std::string>& removals) override;
+
+  Result<std::vector<TableIdentifier>> ListTables(const Namespace& ns) const override;
+
+  /// \brief Create a table at its location in the warehouse.
+  ///
+  /// The schema and the partition spec keep their field IDs. The `format-version`
+  /// property sets the format version of the table and is not stored.
+  ///
+  /// \return The table, ErrorKind::kAlreadyExists if the table exists, or
+  /// ErrorKind::kInvalidArgument if a location other than the one of the table in the
+  /// warehouse is given.
+  Result<std::unique_ptr<Table>> CreateTable(
+      const TableIdentifier& identifier, const Schema& schema, const PartitionSpec& spec,
+      const std::string& location,
+      const std::unordered_map<std::string, std::string>& properties) override;
+
+  Result<std::unique_ptr<Table>> UpdateTable(
+      const TableIdentifier& identifier,
+      const std::vector<std::unique_ptr<TableRequirement>>& requirements,
+      const std::vector<std::unique_ptr<TableUpdate>>& updates) override;
+
+  Result<std::shared_ptr<Transaction>> StageCreateTable(
+      const TableIdentifier& identifier, const Schema& schema, const PartitionSpec& spec,
+      const std::string& location,
+      const std::unordered_map<std::string, std::string>& properties) override;
+
+  Result<bool> TableExists(const TableIdentifier& identifier) const override;
+
+  /// \brief Drop a table by deleting its metadata folder, and with `purge` all the
+  /// files under its location.
+  Status DropTable(const TableIdentifier& identifier, bool purge) override;
+
+  Result<std::unique_ptr<Table>> LoadTable(const TableIdentifier& identifier) override;
+
+  Result<std::string> GetTableMetadataLocation(
+      const TableIdentifier& identifier) const override;
+
+  /// \brief Register a table by writing the given metadata file as its first version.
+  ///
+  /// The location of the metadata must be the location of the table in the warehouse.
+  Result<std::shared_ptr<Table>> RegisterTable(
+      const TableIdentifier& identifier,
+      const std::string& metadata_file_location) override;
+
+  std::unique_ptr<TableBuilder> BuildTable(const TableIdentifier& identifier,
+                                           const Schema& schema) const override;
+
+  /// \brief Returns the location of a table in the warehouse.
+  Result<std::string> TableLocation(const TableIdentifier& identifier) const;
+
+  /// \brief Returns the location of a version of the metadata of a table.
+  static std::string VersionFileLocation(std::string_view table_location,
+                                         int64_t version);
+
+ private:
+  /// \brief Returns the location of a namespace in the warehouse.
+  Result<std::string> NamespaceLocation(const Namespace& ns) const;
+
+  /// \brief Returns the latest version of a table, or std::nullopt if the table has no
+  /// metadata files.
+  Result<std::optional<int64_t>> FindVersion(const std::string& table_location) const;
+
+  /// \brief Returns the latest version, given an existing one.
+  Result<int64_t> FindVersionFrom(const std::string& table_location,
+                                  int64_t version) const;
+
+  /// \brief Writes a version of the metadata of a table, then points the version hint
+  /// to it.
+  Status WriteVersion(const std::string& table_location, int64_t version,
+                      const TableMetadata& metadata);
+
+  /// \brief Returns the tables under a namespace, as the levels of their locations
+  /// relative to the namespace, with the name of the table last.
+  Result<std::vector<std::vector<std::string>>> ListTablePaths(
+      const Namespace& ns) const;
+
+  std::string catalog_name_;
+  std::shared_ptr<FileIO> file_io_;
+  std::string warehouse_location_;
+  std::unordered_map<std::string, std::string> properties_;
+};
+
+}  // namespace iceberg
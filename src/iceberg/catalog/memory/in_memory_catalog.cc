@@ -20,12 +20,21 @@
 #include "iceberg/catalog/memory/in_memory_catalog.h"
 
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <iterator>  // IWYU pragma: keep
+#include <thread>
+#include <tuple>
+#include <utility>
 
 #include "iceberg/exception.h"
+#include "iceberg/file_io.h"
 #include "iceberg/table.h"
 #include "iceberg/table_metadata.h"
+#include "iceberg/table_requirement.h"
+#include "iceberg/table_update.h"
 #include "iceberg/util/macros.h"
+#include "iceberg/util/tracing.h"
 
 namespace iceberg {
 
@@ -102,6 +111,15 @@ class ICEBERG_EXPORT InMemoryNamespace {
   Status RegisterTable(const TableIdentifier& table_ident,
                        const std::string& metadata_location);
 
+  /// \brief Replaces the metadata location of a registered table.
+  ///
+  /// \param table_ident The fully qualified identifier of the table.
+  /// \param metadata_location The path to the new metadata of the table.
+  /// \return Status::OK if the location is replaced;
+  ///         ErrorKind::kNotFound if the table does not exist.
+  Status UpdateTableMetadataLocation(const TableIdentifier& table_ident,
+                                     const std::string& metadata_location);
+
   /// \brief Unregisters a table from the specified namespace.
   ///
   /// \param table_ident The identifier of the table to unregister.
@@ -290,6 +308,18 @@ Status InMemoryNamespace::RegisterTable(TableIdentifier const& table_ident,
   return {};
 }
 
+Status InMemoryNamespace::UpdateTableMetadataLocation(
+    TableIdentifier const& table_ident, const std::string& metadata_location) {
+  const auto ns = GetNamespace(this, table_ident.ns);
+  ICEBERG_RETURN_UNEXPECTED(ns);
+  const auto it = ns.value()->table_metadata_locations_.find(table_ident.name);
+  if (it == ns.value()->table_metadata_locations_.end()) {
+    return NotFound("{} does not exist", table_ident.name);
+  }
+  it->second = metadata_location;
+  return {};
+}
+
 Status InMemoryNamespace::UnregisterTable(TableIdentifier const& table_ident) {
   const auto ns = GetNamespace(this, table_ident.ns);
   ICEBERG_RETURN_UNEXPECTED(ns);
@@ -314,6 +344,67 @@ Result<std::string> InMemoryNamespace::GetTableMetadataLocation(
   return it->second;
 }
 
+/// \brief Deletes the previous metadata files that commits dropped from the metadata
+/// log of their table, on a background thread so that commits do not wait for them.
+class MetadataFileCleaner {
+ public:
+  explicit MetadataFileCleaner(std::shared_ptr<FileIO> file_io)
+      : file_io_(std::move(file_io)), thread_([this]() { Run(); }) {}
+
+  /// \brief Deletes the files that are still pending, then stops the thread.
+  ~MetadataFileCleaner() {
+    {
+      std::lock_guard lock(mutex_);
+      stopped_ = true;
+    }
+    cv_.notify_all();
+  }
+
+  /// \brief Queues files to delete.
+  void Delete(std::vector<std::string> file_locations) {
+    {
+      std::lock_guard lock(mutex_);
+      std::ranges::move(file_locations, std::back_inserter(pending_));
+    }
+    cv_.notify_all();
+  }
+
+  /// \brief Waits until the queued files are deleted.
+  void Wait() {
+    std::unique_lock lock(mutex_);
+    cv_.wait(lock, [&]() { return pending_.empty() && !deleting_; });
+  }
+
+ private:
+  void Run() {
+    std::unique_lock lock(mutex_);
+    while (true) {
+      cv_.wait(lock, [&]() { return stopped_ || !pending_.empty(); });
+      if (pending_.empty()) {
+        return;
+      }
+      auto file_locations = std::exchange(pending_, {});
+      deleting_ = true;
+      lock.unlock();
+      // The files that cannot be deleted are left behind as orphan files, the commit
+      // has succeeded already.
+      std::ignore = file_io_->DeleteFiles(file_locations);
+      lock.lock();
+      deleting_ = false;
+      cv_.notify_all();
+    }
+  }
+
+  std::shared_ptr<FileIO> file_io_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<std::string> pending_;
+  bool deleting_ = false;
+  bool stopped_ = false;
+  /// \brief Declared last, so that it starts once the other members are initialized.
+  std::jthread thread_;
+};
+
 std::shared_ptr<InMemoryCatalog> InMemoryCatalog::Make(
     std::string const& name, std::shared_ptr<FileIO> const& file_io,
     std::string const& warehouse_location,
@@ -337,42 +428,42 @@ std::string_view InMemoryCatalog::name() const { return catalog_name_; }
 
 Status InMemoryCatalog::CreateNamespace(
     const Namespace& ns, const std::unordered_map<std::string, std::string>& properties) {
-  std::unique_lock lock(mutex_);
+  auto lock = WriteLock();
   return root_namespace_->CreateNamespace(ns, properties);
 }
 
 Result<std::unordered_map<std::string, std::string>>
 InMemoryCatalog::GetNamespaceProperties(const Namespace& ns) const {
-  std::unique_lock lock(mutex_);
+  auto lock = ReadLock();
   return root_namespace_->GetProperties(ns);
 }
 
 Result<std::vector<Namespace>> InMemoryCatalog::ListNamespaces(
     const Namespace& ns) const {
-  std::unique_lock lock(mutex_);
+  auto lock = ReadLock();
   return root_namespace_->ListNamespaces(ns);
 }
 
 Status InMemoryCatalog::DropNamespace(const Namespace& ns) {
-  std::unique_lock lock(mutex_);
+  auto lock = WriteLock();
   return root_namespace_->DropNamespace(ns);
 }
 
 Result<bool> InMemoryCatalog::NamespaceExists(const Namespace& ns) const {
-  std::unique_lock lock(mutex_);
+  auto lock = ReadLock();
   return root_namespace_->NamespaceExists(ns);
 }
 
 Status InMemoryCatalog::UpdateNamespaceProperties(
     const Namespace& ns, const std::unordered_map<std::string, std::string>& updates,
     const std::unordered_set<std::string>& removals) {
-  std::unique_lock lock(mutex_);
+  auto lock = WriteLock();
   return root_namespace_->UpdateNamespaceProperties(ns, updates, removals);
 }
 
 Result<std::vector<TableIdentifier>> InMemoryCatalog::ListTables(
     const Namespace& ns) const {
-  std::unique_lock lock(mutex_);
+  auto lock = ReadLock();
   const auto& table_names = root_namespace_->ListTables(ns);
   ICEBERG_RETURN_UNEXPECTED(table_names);
   std::vector<TableIdentifier> table_idents;
@@ -394,7 +485,48 @@ Result<std::unique_ptr<Table>> InMemoryCatalog::UpdateTable(
     const TableIdentifier& identifier,
     const std::vector<std::unique_ptr<TableRequirement>>& requirements,
     const std::vector<std::unique_ptr<TableUpdate>>& updates) {
-  return NotImplemented("update table");
+  ICEBERG_TRACE_SCOPE(trace, "Catalog::UpdateTable");
+  ICEBERG_TRACE_ATTRIBUTE(trace, "table", identifier.name);
+  if (!file_io_) [[unlikely]] {
+    return InvalidArgument("file_io is not set for catalog {}", catalog_name_);
+  }
+
+  // Commits are serialized by the write lock, so the metadata validated against the
+  // requirements is the one replaced by the commit.
+  auto lock = WriteLock();
+  ICEBERG_ASSIGN_OR_RAISE(auto base_location,
+                          root_namespace_->GetTableMetadataLocation(identifier));
+  ICEBERG_ASSIGN_OR_RAISE(auto base, TableMetadataUtil::Read(*file_io_, base_location));
+  for (const auto& requirement : requirements) {
+    ICEBERG_RETURN_UNEXPECTED(requirement->Validate(base.get()));
+  }
+
+  auto builder = TableMetadataBuilder::BuildFrom(base.get());
+  for (const auto& update : updates) {
+    update->ApplyTo(*builder);
+  }
+  builder->SetPreviousMetadataLocation(base_location);
+  ICEBERG_ASSIGN_OR_RAISE(std::shared_ptr<TableMetadata> metadata, builder->Build());
+
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto metadata_location,
+      TableMetadataUtil::NewMetadataFileLocation(*metadata, base_location));
+  ICEBERG_RETURN_UNEXPECTED(
+      TableMetadataUtil::Write(*file_io_, metadata_location, *metadata));
+  ICEBERG_RETURN_UNEXPECTED(
+      root_namespace_->UpdateTableMetadataLocation(identifier, metadata_location));
+
+  if (auto removed_files = TableMetadataUtil::RemovedMetadataFiles(*base, *metadata);
+      !removed_files.empty()) {
+    if (metadata_file_cleaner_ == nullptr) {
+      metadata_file_cleaner_ = std::make_unique<MetadataFileCleaner>(file_io_);
+    }
+    metadata_file_cleaner_->Delete(std::move(removed_files));
+  }
+
+  return std::make_unique<Table>(identifier, std::move(metadata),
+                                 std::move(metadata_location), file_io_,
+                                 std::static_pointer_cast<Catalog>(shared_from_this()));
 }
 
 Result<std::shared_ptr<Transaction>> InMemoryCatalog::StageCreateTable(
@@ -405,25 +537,29 @@ Result<std::shared_ptr<Transaction>> InMemoryCatalog::StageCreateTable(
 }
 
 Result<bool> InMemoryCatalog::TableExists(const TableIdentifier& identifier) const {
-  std::unique_lock lock(mutex_);
+  auto lock = ReadLock();
   return root_namespace_->TableExists(identifier);
 }
 
 Status InMemoryCatalog::DropTable(const TableIdentifier& identifier, bool purge) {
-  std::unique_lock lock(mutex_);
+  ICEBERG_TRACE_SCOPE(trace, "Catalog::DropTable");
+  ICEBERG_TRACE_ATTRIBUTE(trace, "table", identifier.name);
+  auto lock = WriteLock();
   // TODO(Guotao): Delete all metadata files if purge is true.
   return root_namespace_->UnregisterTable(identifier);
 }
 
 Result<std::unique_ptr<Table>> InMemoryCatalog::LoadTable(
     const TableIdentifier& identifier) {
+  ICEBERG_TRACE_SCOPE(trace, "Catalog::LoadTable");
+  ICEBERG_TRACE_ATTRIBUTE(trace, "table", identifier.name);
   if (!file_io_) [[unlikely]] {
     return InvalidArgument("file_io is not set for catalog {}", catalog_name_);
   }
 
   Result<std::string> metadata_location;
   {
-    std::unique_lock lock(mutex_);
+    auto lock = ReadLock();
     ICEBERG_ASSIGN_OR_RAISE(metadata_location,
                             root_namespace_->GetTableMetadataLocation(identifier));
   }
@@ -436,18 +572,84 @@ Result<std::unique_ptr<Table>> InMemoryCatalog::LoadTable(
                                  std::static_pointer_cast<Catalog>(shared_from_this()));
 }
 
+Result<std::string> InMemoryCatalog::GetTableMetadataLocation(
+    const TableIdentifier& identifier) const {
+  auto lock = ReadLock();
+  return root_namespace_->GetTableMetadataLocation(identifier);
+}
+
 Result<std::shared_ptr<Table>> InMemoryCatalog::RegisterTable(
     const TableIdentifier& identifier, const std::string& metadata_file_location) {
-  std::unique_lock lock(mutex_);
-  if (!root_namespace_->NamespaceExists(identifier.ns)) {
-    return NoSuchNamespace("table namespace does not exist.");
-  }
-  if (!root_namespace_->RegisterTable(identifier, metadata_file_location)) {
-    return UnknownError("The registry failed.");
+  {
+    auto lock = WriteLock();
+    if (!root_namespace_->NamespaceExists(identifier.ns)) {
+      return NoSuchNamespace("table namespace does not exist.");
+    }
+    if (!root_namespace_->RegisterTable(identifier, metadata_file_location)) {
+      return UnknownError("The registry failed.");
+    }
   }
   return LoadTable(identifier);
 }
 
+namespace {
+
+/// \brief Takes a lock, counting the acquisitions that have to wait and their wait time.
+///
+/// Only waiting acquisitions are timed, to keep uncontended lookups cheap.
+template <typename Lock>
+Lock LockCounted(std::shared_mutex& mutex, std::atomic<int64_t>& contended,
+                 std::atomic<int64_t>& wait_nanos) {
+  Lock lock(mutex, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    contended.fetch_add(1, std::memory_order_relaxed);
+    auto start = std::chrono::steady_clock::now();
+    lock.lock();
+    auto wait = std::chrono::steady_clock::now() - start;
+    wait_nanos.fetch_add(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count(),
+        std::memory_order_relaxed);
+  }
+  return lock;
+}
+
+}  // namespace
+
+void InMemoryCatalog::WaitForMetadataFileDeletes() {
+  MetadataFileCleaner* cleaner = nullptr;
+  {
+    auto lock = ReadLock();
+    cleaner = metadata_file_cleaner_.get();
+  }
+  if (cleaner != nullptr) {
+    cleaner->Wait();
+  }
+}
+
+InMemoryCatalog::LockStats InMemoryCatalog::lock_stats() const {
+  return LockStats{
+      .shared_acquisitions = shared_acquisitions_.load(std::memory_order_relaxed),
+      .exclusive_acquisitions = exclusive_acquisitions_.load(std::memory_order_relaxed),
+      .contended_shared_acquisitions =
+          contended_shared_acquisitions_.load(std::memory_order_relaxed),
+      .contended_exclusive_acquisitions =
+          contended_exclusive_acquisitions_.load(std::memory_order_relaxed),
+      .wait_nanos = wait_nanos_.load(std::memory_order_relaxed),
+  };
+}
+
+std::shared_lock<std::shared_mutex> InMemoryCatalog::ReadLock() const {
+  shared_acquisitions_.fetch_add(1, std::memory_order_relaxed);
+  return LockCounted<std::shared_lock<std::shared_mutex>>(
+      mutex_, contended_shared_acquisitions_, wait_nanos_);
+}
+
+std::unique_lock<std::shared_mutex> InMemoryCatalog::WriteLock() {
+  exclusive_acquisitions_.fetch_add(1, std::memory_order_relaxed);
+  return LockCounted<std::unique_lock<std::shared_mutex>>(
+      mutex_, contended_exclusive_acquisitions_, wait_nanos_);
+}
+
 std::unique_ptr<Catalog::TableBuilder> InMemoryCatalog::BuildTable(
     const TableIdentifier& identifier, const Schema& schema) const {
   throw IcebergError("not implemented");
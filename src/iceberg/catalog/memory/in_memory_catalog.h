@@ -19,7 +19,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <mutex>
+#include <shared_mutex>
 
 #include "iceberg/catalog.h"
 
@@ -32,6 +35,10 @@ namespace iceberg {
  * or external systems. It is primarily intended for unit tests, prototyping, or
  * demonstration purposes.
  *
+ * Read-only operations share the catalog lock, so concurrent lookups do not
+ * serialize on each other; only operations that modify the catalog take it
+ * exclusively.
+ *
  * @note This class is **not** suitable for production use.
  *       All data will be lost when the process exits.
  */
@@ -39,6 +46,20 @@ class ICEBERG_EXPORT InMemoryCatalog
     : public Catalog,
       public std::enable_shared_from_this<InMemoryCatalog> {
  public:
+  /// \brief Counters of the catalog lock, for diagnosing contention.
+  struct LockStats {
+    /// \brief Number of times read-only operations took the lock.
+    int64_t shared_acquisitions = 0;
+    /// \brief Number of times modifying operations took the lock.
+    int64_t exclusive_acquisitions = 0;
+    /// \brief Number of shared acquisitions that had to wait for a writer.
+    int64_t contended_shared_acquisitions = 0;
+    /// \brief Number of exclusive acquisitions that had to wait for other operations.
+    int64_t contended_exclusive_acquisitions = 0;
+    /// \brief Total time spent waiting for the lock, in nanoseconds.
+    int64_t wait_nanos = 0;
+  };
+
   InMemoryCatalog(std::string const& name, std::shared_ptr<FileIO> const& file_io,
                   std::string const& warehouse_location,
                   std::unordered_map<std::string, std::string> const& properties);
@@ -91,6 +112,9 @@ class ICEBERG_EXPORT InMemoryCatalog
 
   Result<std::unique_ptr<Table>> LoadTable(const TableIdentifier& identifier) override;
 
+  Result<std::string> GetTableMetadataLocation(
+      const TableIdentifier& identifier) const override;
+
   Result<std::shared_ptr<Table>> RegisterTable(
       const TableIdentifier& identifier,
       const std::string& metadata_file_location) override;
@@ -98,13 +122,36 @@ class ICEBERG_EXPORT InMemoryCatalog
   std::unique_ptr<TableBuilder> BuildTable(const TableIdentifier& identifier,
                                            const Schema& schema) const override;
 
+  /// \brief Waits until the previous metadata files that commits dropped from the
+  /// metadata log are deleted.
+  ///
+  /// With `write.metadata.delete-after-commit.enabled`, UpdateTable deletes these files
+  /// in the background once the commit succeeded.
+  void WaitForMetadataFileDeletes();
+
+  /// \brief Returns the counters of the catalog lock since the catalog was created.
+  LockStats lock_stats() const;
+
  private:
+  /// \brief Takes the catalog lock for a read-only operation.
+  std::shared_lock<std::shared_mutex> ReadLock() const;
+
+  /// \brief Takes the catalog lock for an operation that modifies the catalog.
+  std::unique_lock<std::shared_mutex> WriteLock();
+
   std::string catalog_name_;
   std::unordered_map<std::string, std::string> properties_;
   std::shared_ptr<FileIO> file_io_;
   std::string warehouse_location_;
   std::unique_ptr<class InMemoryNamespace> root_namespace_;
-  mutable std::recursive_mutex mutex_;
+  /// \brief Created by the first commit that drops metadata files to delete.
+  std::unique_ptr<class MetadataFileCleaner> metadata_file_cleaner_;
+  mutable std::shared_mutex mutex_;
+  mutable std::atomic<int64_t> shared_acquisitions_{0};
+  std::atomic<int64_t> exclusive_acquisitions_{0};
+  mutable std::atomic<int64_t> contended_shared_acquisitions_{0};
+  std::atomic<int64_t> contended_exclusive_acquisitions_{0};
+  mutable std::atomic<int64_t> wait_nanos_{0};
 };
 
 }  // namespace iceberg
@@ -0,0 +1,124 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/catalog/rest/http_client.h"
+
+#include <utility>
+
+namespace iceberg::catalog::rest {
+
+HttpClient::HttpClient(HttpClientOptions options) : options_(std::move(options)) {}
+
+HttpClient::~HttpClient() = default;
+
+Result<cpr::Response> HttpClient::Get(const std::string& url,
+                                      const cpr::Parameters& parameters) {
+  return Execute(Method::kGet, url, parameters, /*body=*/{});
+}
+
+Result<cpr::Response> HttpClient::Head(const std::string& url) {
+  return Execute(Method::kHead, url, cpr::Parameters{}, /*body=*/{});
+}
+
+Result<cpr::Response> HttpClient::Delete(const std::string& url,
+                                         const cpr::Parameters& parameters) {
+  return Execute(Method::kDelete, url, parameters, /*body=*/{});
+}
+
+Result<cpr::Response> HttpClient::Post(const std::string& url, std::string body) {
+  return Execute(Method::kPost, url, cpr::Parameters{}, std::move(body));
+}
+
+size_t HttpClient::idle_sessions() const {
+  std::lock_guard lock(mutex_);
+  return idle_sessions_.size() + idle_body_sessions_.size();
+}
+
+Result<cpr::Response> HttpClient::Execute(Method method, const std::string& url,
+                                          const cpr::Parameters& parameters,
+                                          std::string body) {
+  const bool with_body = method == Method::kPost;
+  auto session = Acquire(with_body);
+  session->SetUrl(cpr::Url{url});
+  session->SetParameters(parameters);
+  if (with_body) {
+    session->SetBody(cpr::Body{std::move(body)});
+  }
+
+  cpr::Response response;
+  switch (method) {
+    case Method::kGet:
+      response = session->Get();
+      break;
+    case Method::kHead:
+      response = session->Head();
+      break;
+    case Method::kDelete:
+      response = session->Delete();
+      break;
+    case Method::kPost:
+      response = session->Post();
+      break;
+  }
+
+  if (response.error.code != cpr::ErrorCode::OK) {
+    // The connection may be broken, so the session is not reused.
+    return IOError("HTTP request to {} failed: {}", url, response.error.message);
+  }
+  Release(std::move(session), with_body);
+  return response;
+}
+
+std::unique_ptr<cpr::Session> HttpClient::Acquire(bool with_body) {
+  {
+    std::lock_guard lock(mutex_);
+    auto& idle = with_body ? idle_body_sessions_ : idle_sessions_;
+    if (!idle.empty()) {
+      auto session = std::move(idle.back());
+      idle.pop_back();
+      return session;
+    }
+  }
+
+  auto session = std::make_unique<cpr::Session>();
+  cpr::Header header{{"Content-Type", "application/json"},
+                     {"Accept", "application/json"}};
+  for (const auto& [name, value] : options_.headers) {
+    header[name] = value;
+  }
+  session->SetHeader(header);
+  session->SetConnectTimeout(cpr::ConnectTimeout{options_.connect_timeout});
+  session->SetTimeout(cpr::Timeout{options_.request_timeout});
+  session->SetAcceptEncoding(cpr::AcceptEncoding{
+      {cpr::AcceptEncodingMethods::gzip, cpr::AcceptEncodingMethods::deflate}});
+  if (options_.http2) {
+    session->SetHttpVersion(cpr::HttpVersion{cpr::HttpVersionCode::VERSION_2_0_TLS});
+  }
+  return session;
+}
+
+void HttpClient::Release(std::unique_ptr<cpr::Session> session, bool with_body) {
+  std::lock_guard lock(mutex_);
+  auto& idle = with_body ? idle_body_sessions_ : idle_sessions_;
+  if (idle_sessions_.size() + idle_body_sessions_.size() < options_.max_idle_sessions) {
+    idle.push_back(std::move(session));
+  }
+}
+
+}  // namespace iceberg::catalog::rest
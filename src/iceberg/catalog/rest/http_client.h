@@ -0,0 +1,114 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/catalog/rest/http_client.h
+/// A thread-safe HTTP client that reuses connections across requests.
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <cpr/cpr.h>
+
+#include "iceberg/catalog/rest/iceberg_rest_export.h"
+#include "iceberg/result.h"
+
+namespace iceberg::catalog::rest {
+
+/// \brief Options of an HttpClient.
+struct ICEBERG_REST_EXPORT HttpClientOptions {
+  /// \brief Headers sent with every request.
+  std::unordered_map<std::string, std::string> headers;
+  /// \brief Timeout for establishing a connection.
+  std::chrono::milliseconds connect_timeout{10'000};
+  /// \brief Timeout for a whole request, including reading the response.
+  std::chrono::milliseconds request_timeout{60'000};
+  /// \brief Maximum number of idle sessions kept for reuse.
+  size_t max_idle_sessions = 16;
+  /// \brief Whether to negotiate HTTP/2 on TLS connections. Plain HTTP connections
+  /// always use HTTP/1.1.
+  bool http2 = true;
+};
+
+/// \brief A thread-safe HTTP client that reuses connections across requests.
+///
+/// Each request runs on a `cpr::Session` taken from a pool of idle sessions, so the
+/// connections of a session, kept alive by libcurl, are reused by later requests
+/// instead of paying for TCP and TLS setup on every call. Concurrent requests run on
+/// separate sessions, and at most `max_idle_sessions` sessions are kept between
+/// requests. Responses compressed with gzip or deflate are decoded transparently.
+class ICEBERG_REST_EXPORT HttpClient {
+ public:
+  explicit HttpClient(HttpClientOptions options = {});
+  ~HttpClient();
+
+  HttpClient(const HttpClient&) = delete;
+  HttpClient& operator=(const HttpClient&) = delete;
+
+  /// \brief Sends a GET request.
+  ///
+  /// \return The response, or an IOError if no response was received.
+  Result<cpr::Response> Get(const std::string& url, const cpr::Parameters& parameters);
+
+  /// \brief Sends a HEAD request.
+  ///
+  /// \return The response, or an IOError if no response was received.
+  Result<cpr::Response> Head(const std::string& url);
+
+  /// \brief Sends a DELETE request.
+  ///
+  /// \return The response, or an IOError if no response was received.
+  Result<cpr::Response> Delete(const std::string& url,
+                               const cpr::Parameters& parameters);
+
+  /// \brief Sends a POST request with a JSON body.
+  ///
+  /// \return The response, or an IOError if no response was received.
+  Result<cpr::Response> Post(const std::string& url, std::string body);
+
+  /// \brief Returns the number of idle sessions kept for reuse.
+  size_t idle_sessions() const;
+
+ private:
+  enum class Method { kGet, kHead, kDelete, kPost };
+
+  Result<cpr::Response> Execute(Method method, const std::string& url,
+                                const cpr::Parameters& parameters, std::string body);
+
+  std::unique_ptr<cpr::Session> Acquire(bool with_body);
+
+  void Release(std::unique_ptr<cpr::Session> session, bool with_body);
+
+  HttpClientOptions options_;
+  mutable std::mutex mutex_;
+  /// \brief Idle sessions of requests without a body.
+  std::vector<std::unique_ptr<cpr::Session>> idle_sessions_;
+  /// \brief Idle sessions of requests with a body. A session remembers the body of its
+  /// last request, which would turn a later GET into a GET with a body, so requests
+  /// with and without a body do not share sessions.
+  std::vector<std::unique_ptr<cpr::Session>> idle_body_sessions_;
+};
+
+}  // namespace iceberg::catalog::rest
@@ -0,0 +1,1173 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/catalog/rest/json_internal.h"
+
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "iceberg/expression/expression.h"
+#include "iceberg/expression/literal.h"
+#include "iceberg/expression/predicate.h"
+#include "iceberg/expression/term.h"
+#include "iceberg/file_format.h"
+#include "iceberg/json_internal.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/sort_order.h"
+#include "iceberg/statistics_file.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/table_requirement.h"
+#include "iceberg/table_update.h"
+#include "iceberg/transform.h"
+#include "iceberg/type.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/conversions.h"
+#include "iceberg/util/decimal.h"
+#include "iceberg/util/json_util_internal.h"
+#include "iceberg/util/macros.h"
+#include "iceberg/util/uuid.h"
+
+namespace iceberg::rest {
+
+namespace {
+
+// Catalog config and errors
+constexpr std::string_view kDefaults = "defaults";
+constexpr std::string_view kOverrides = "overrides";
+constexpr std::string_view kEndpoints = "endpoints";
+constexpr std::string_view kError = "error";
+constexpr std::string_view kMessage = "message";
+constexpr std::string_view kType = "type";
+constexpr std::string_view kCode = "code";
+
+// Namespaces and tables
+constexpr std::string_view kNamespace = "namespace";
+constexpr std::string_view kNamespaces = "namespaces";
+constexpr std::string_view kName = "name";
+constexpr std::string_view kIdentifiers = "identifiers";
+constexpr std::string_view kProperties = "properties";
+constexpr std::string_view kRemovals = "removals";
+constexpr std::string_view kUpdates = "updates";
+constexpr std::string_view kUpdated = "updated";
+constexpr std::string_view kRemoved = "removed";
+constexpr std::string_view kMissing = "missing";
+constexpr std::string_view kNextPageToken = "next-page-token";
+constexpr std::string_view kMetadataLocation = "metadata-location";
+constexpr std::string_view kMetadata = "metadata";
+constexpr std::string_view kConfig = "config";
+constexpr std::string_view kOverwrite = "overwrite";
+constexpr std::string_view kIdentifier = "identifier";
+constexpr std::string_view kRequirements = "requirements";
+constexpr std::string_view kTableChanges = "table-changes";
+
+// Table updates
+constexpr std::string_view kAction = "action";
+constexpr std::string_view kUUID = "uuid";
+constexpr std::string_view kFormatVersion = "format-version";
+constexpr std::string_view kSchema = "schema";
+constexpr std::string_view kLastColumnId = "last-column-id";
+constexpr std::string_view kSchemaId = "schema-id";
+constexpr std::string_view kSchemaIds = "schema-ids";
+constexpr std::string_view kSpec = "spec";
+constexpr std::string_view kSpecId = "spec-id";
+constexpr std::string_view kSpecIds = "spec-ids";
+constexpr std::string_view kSortOrder = "sort-order";
+constexpr std::string_view kSortOrderId = "sort-order-id";
+constexpr std::string_view kSnapshot = "snapshot";
+constexpr std::string_view kSnapshotId = "snapshot-id";
+constexpr std::string_view kSnapshotIds = "snapshot-ids";
+constexpr std::string_view kRefName = "ref-name";
+constexpr std::string_view kMinSnapshotsToKeep = "min-snapshots-to-keep";
+constexpr std::string_view kMaxSnapshotAgeMs = "max-snapshot-age-ms";
+constexpr std::string_view kMaxRefAgeMs = "max-ref-age-ms";
+constexpr std::string_view kLocation = "location";
+constexpr std::string_view kStatistics = "statistics";
+constexpr std::string_view kPartitionStatistics = "partition-statistics";
+
+// Table requirements
+constexpr std::string_view kRef = "ref";
+constexpr std::string_view kLastAssignedFieldId = "last-assigned-field-id";
+constexpr std::string_view kCurrentSchemaId = "current-schema-id";
+constexpr std::string_view kLastAssignedPartitionId = "last-assigned-partition-id";
+constexpr std::string_view kDefaultSpecId = "default-spec-id";
+constexpr std::string_view kDefaultSortOrderId = "default-sort-order-id";
+
+// Scan planning
+constexpr std::string_view kStatus = "status";
+constexpr std::string_view kPlanId = "plan-id";
+constexpr std::string_view kPlanTasks = "plan-tasks";
+constexpr std::string_view kFileScanTasks = "file-scan-tasks";
+constexpr std::string_view kDeleteFiles = "delete-files";
+constexpr std::string_view kDataFile = "data-file";
+constexpr std::string_view kDeleteFileReferences = "delete-file-references";
+constexpr std::string_view kSelect = "select";
+constexpr std::string_view kFilter = "filter";
+constexpr std::string_view kCaseSensitive = "case-sensitive";
+constexpr std::string_view kStartSnapshotId = "start-snapshot-id";
+constexpr std::string_view kEndSnapshotId = "end-snapshot-id";
+
+// Expressions
+constexpr std::string_view kTerm = "term";
+constexpr std::string_view kValue = "value";
+constexpr std::string_view kValues = "values";
+constexpr std::string_view kLeft = "left";
+constexpr std::string_view kRight = "right";
+constexpr std::string_view kChild = "child";
+constexpr std::string_view kTransform = "transform";
+
+// Content files
+constexpr std::string_view kContent = "content";
+constexpr std::string_view kFilePath = "file-path";
+constexpr std::string_view kFileFormat = "file-format";
+constexpr std::string_view kPartition = "partition";
+constexpr std::string_view kFileSizeInBytes = "file-size-in-bytes";
+constexpr std::string_view kRecordCount = "record-count";
+constexpr std::string_view kKeyMetadata = "key-metadata";
+constexpr std::string_view kSplitOffsets = "split-offsets";
+constexpr std::string_view kEqualityIds = "equality-ids";
+constexpr std::string_view kColumnSizes = "column-sizes";
+constexpr std::string_view kValueCounts = "value-counts";
+constexpr std::string_view kNullValueCounts = "null-value-counts";
+constexpr std::string_view kNanValueCounts = "nan-value-counts";
+constexpr std::string_view kLowerBounds = "lower-bounds";
+constexpr std::string_view kUpperBounds = "upper-bounds";
+constexpr std::string_view kKeys = "keys";
+constexpr std::string_view kFirstRowId = "first-row-id";
+constexpr std::string_view kReferencedDataFile = "referenced-data-file";
+constexpr std::string_view kContentOffset = "content-offset";
+constexpr std::string_view kContentSizeInBytes = "content-size-in-bytes";
+
+Result<std::vector<Namespace>> NamespacesFromJson(const nlohmann::json& json,
+                                                 std::string_view key) {
+  return FromJsonList<Namespace>(json, key, NamespaceFromJson);
+}
+
+/// \brief Returns the type name of an expression in the REST expression model.
+std::string_view ExpressionTypeName(Expression::Operation op) {
+  switch (op) {
+    case Expression::Operation::kTrue:
+      return "true";
+    case Expression::Operation::kFalse:
+      return "false";
+    case Expression::Operation::kIsNull:
+      return "is-null";
+    case Expression::Operation::kNotNull:
+      return "not-null";
+    case Expression::Operation::kIsNan:
+      return "is-nan";
+    case Expression::Operation::kNotNan:
+      return "not-nan";
+    case Expression::Operation::kLt:
+      return "lt";
+    case Expression::Operation::kLtEq:
+      return "lt-eq";
+    case Expression::Operation::kGt:
+      return "gt";
+    case Expression::Operation::kGtEq:
+      return "gt-eq";
+    case Expression::Operation::kEq:
+      return "eq";
+    case Expression::Operation::kNotEq:
+      return "not-eq";
+    case Expression::Operation::kIn:
+      return "in";
+    case Expression::Operation::kNotIn:
+      return "not-in";
+    case Expression::Operation::kNot:
+      return "not";
+    case Expression::Operation::kAnd:
+      return "and";
+    case Expression::Operation::kOr:
+      return "or";
+    case Expression::Operation::kStartsWith:
+      return "starts-with";
+    case Expression::Operation::kNotStartsWith:
+      return "not-starts-with";
+    default:
+      return {};
+  }
+}
+
+/// \brief Serializes the value of a literal in an expression.
+///
+/// Dates, times and timestamps are written as numbers, which the server converts to
+/// the type of the referenced column when binding the expression.
+Result<nlohmann::json> LiteralToJson(const Literal& literal) {
+  if (literal.IsNull() || literal.IsAboveMax() || literal.IsBelowMin()) {
+    return NotSupported("Cannot serialize literal {} to JSON", literal.ToString());
+  }
+  const auto& value = literal.value();
+  switch (literal.type()->type_id()) {
+    case TypeId::kBoolean:
+      return std::get<bool>(value);
+    case TypeId::kInt:
+    case TypeId::kDate:
+      return std::get<int32_t>(value);
+    case TypeId::kLong:
+    case TypeId::kTime:
+    case TypeId::kTimestamp:
+    case TypeId::kTimestampTz:
+      return std::get<int64_t>(value);
+    case TypeId::kFloat:
+      return std::get<float>(value);
+    case TypeId::kDouble:
+      return std::get<double>(value);
+    case TypeId::kString:
+      return std::get<std::string>(value);
+    case TypeId::kUuid:
+      return std::get<Uuid>(value).ToString();
+    default:
+      return NotSupported("Cannot serialize {} literal to JSON",
+                          literal.type()->ToString());
+  }
+}
+
+/// \brief Parses the value of a literal in an expression.
+///
+/// The value has no type in the REST expression model, so numbers are parsed as longs
+/// and doubles, which are converted to the type of the referenced column when the
+/// expression is bound.
+Result<Literal> ExpressionLiteralFromJson(const nlohmann::json& json) {
+  if (json.is_boolean()) {
+    return Literal::Boolean(json.get<bool>());
+  }
+  if (json.is_number_integer()) {
+    return Literal::Long(json.get<int64_t>());
+  }
+  if (json.is_number()) {
+    return Literal::Double(json.get<double>());
+  }
+  if (json.is_string()) {
+    return Literal::String(json.get<std::string>());
+  }
+  return JsonParseError("Cannot parse expression literal from {}", SafeDumpJson(json));
+}
+
+/// \brief Serializes the term of an unbound predicate: the name of a reference, or an
+/// object for a transform term.
+template <typename B>
+nlohmann::json TermToJson(UnboundTerm<B>& term) {
+  std::string name(term.reference()->name());
+  if constexpr (std::is_same_v<B, BoundTransform>) {
+    nlohmann::json json;
+    json[kType] = kTransform;
+    json[kTransform] =
+        internal::checked_cast<const UnboundTransform&>(term).transform()->ToString();
+    json[kTerm] = std::move(name);
+    return json;
+  } else {
+    return name;
+  }
+}
+
+template <typename B>
+Status PredicateToJson(const UnboundPredicate<B>& pred, nlohmann::json& json) {
+  json[kTerm] = TermToJson(*pred.term());
+  const auto& literals = pred.literals();
+  switch (pred.op()) {
+    case Expression::Operation::kIn:
+    case Expression::Operation::kNotIn:
+      json[kValues] = nlohmann::json::array();
+      for (const auto& literal : literals) {
+        ICEBERG_ASSIGN_OR_RAISE(auto value, LiteralToJson(literal));
+        json[kValues].push_back(std::move(value));
+      }
+      break;
+    default:
+      if (!literals.empty()) {
+        ICEBERG_ASSIGN_OR_RAISE(json[kValue], LiteralToJson(literals.front()));
+      }
+      break;
+  }
+  return {};
+}
+
+/// \brief Consumes a number of exactly `width` digits from the front of `str`.
+std::optional<int32_t> ConsumeDigits(std::string_view& str, size_t width) {
+  int32_t value = 0;
+  if (str.size() < width) {
+    return std::nullopt;
+  }
+  auto [ptr, ec] = std::from_chars(str.data(), str.data() + width, value);
+  if (ec != std::errc{} || ptr != str.data() + width || value < 0) {
+    return std::nullopt;
+  }
+  str.remove_prefix(width);
+  return value;
+}
+
+bool ConsumeChar(std::string_view& str, char c) {
+  if (str.empty() || str.front() != c) {
+    return false;
+  }
+  str.remove_prefix(1);
+  return true;
+}
+
+/// \brief Consumes a "yyyy-MM-dd" date, returning days from the epoch.
+std::optional<int32_t> ConsumeDate(std::string_view& str) {
+  auto year = ConsumeDigits(str, 4);
+  if (!year || !ConsumeChar(str, '-')) {
+    return std::nullopt;
+  }
+  auto month = ConsumeDigits(str, 2);
+  if (!month || !ConsumeChar(str, '-')) {
+    return std::nullopt;
+  }
+  auto day = ConsumeDigits(str, 2);
+  if (!day) {
+    return std::nullopt;
+  }
+  std::chrono::year_month_day date{std::chrono::year{*year},
+                                   std::chrono::month{static_cast<unsigned>(*month)},
+                                   std::chrono::day{static_cast<unsigned>(*day)}};
+  if (!date.ok()) {
+    return std::nullopt;
+  }
+  return std::chrono::sys_days(date).time_since_epoch().count();
+}
+
+/// \brief Consumes a "HH:mm[:ss[.SSSSSS]]" time, returning microseconds from midnight.
+///
+/// Digits of the fraction beyond microseconds are ignored.
+std::optional<int64_t> ConsumeTime(std::string_view& str) {
+  auto hour = ConsumeDigits(str, 2);
+  if (!hour || *hour > 23 || !ConsumeChar(str, ':')) {
+    return std::nullopt;
+  }
+  auto minute = ConsumeDigits(str, 2);
+  if (!minute || *minute > 59) {
+    return std::nullopt;
+  }
+  int64_t micros = (*hour * 60L + *minute) * 60L * 1000000L;
+  if (!ConsumeChar(str, ':')) {
+    return micros;
+  }
+  auto second = ConsumeDigits(str, 2);
+  if (!second || *second > 59) {
+    return std::nullopt;
+  }
+  micros += *second * 1000000L;
+  if (!ConsumeChar(str, '.')) {
+    return micros;
+  }
+  int64_t scale = 100000;
+  size_t digits = 0;
+  while (!str.empty() && str.front() >= '0' && str.front() <= '9') {
+    micros += (str.front() - '0') * scale;
+    scale /= 10;
+    str.remove_prefix(1);
+    ++digits;
+  }
+  if (digits == 0) {
+    return std::nullopt;
+  }
+  return micros;
+}
+
+/// \brief Parses a "yyyy-MM-ddTHH:mm:ss.SSSSSS" timestamp, with a zone offset such as
+/// "+00:00" when `with_zone` is set, returning microseconds from the epoch in UTC.
+std::optional<int64_t> ParseTimestamp(std::string_view str, bool with_zone) {
+  auto date = ConsumeDate(str);
+  if (!date || !ConsumeChar(str, 'T')) {
+    return std::nullopt;
+  }
+  auto time = ConsumeTime(str);
+  if (!time) {
+    return std::nullopt;
+  }
+  int64_t micros = *date * 86400000000L + *time;
+  if (!with_zone) {
+    return str.empty() ? std::optional<int64_t>(micros) : std::nullopt;
+  }
+  if (str == "Z") {
+    return micros;
+  }
+  int64_t sign = ConsumeChar(str, '+') ? 1 : (ConsumeChar(str, '-') ? -1 : 0);
+  auto offset = sign != 0 ? ConsumeTime(str) : std::nullopt;
+  if (!offset || !str.empty()) {
+    return std::nullopt;
+  }
+  return micros - sign * *offset;
+}
+
+/// \brief Parses a string of hexadecimal digits to bytes.
+std::optional<std::vector<uint8_t>> ParseHex(std::string_view str) {
+  if (str.size() % 2 != 0) {
+    return std::nullopt;
+  }
+  std::vector<uint8_t> bytes(str.size() / 2);
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    auto [ptr, ec] =
+        std::from_chars(str.data() + 2 * i, str.data() + 2 * i + 2, bytes[i], 16);
+    if (ec != std::errc{} || ptr != str.data() + 2 * i + 2) {
+      return std::nullopt;
+    }
+  }
+  return bytes;
+}
+
+/// \brief Parses a value of a primitive type from its single-value JSON serialization
+/// in the Iceberg spec.
+Result<Literal> LiteralFromJson(const nlohmann::json& json,
+                                const std::shared_ptr<PrimitiveType>& type) {
+  if (json.is_null()) {
+    return Literal::Null(type);
+  }
+  const auto* str = json.get_ptr<const std::string*>();
+  switch (type->type_id()) {
+    case TypeId::kBoolean:
+      if (json.is_boolean()) {
+        return Literal::Boolean(json.get<bool>());
+      }
+      break;
+    case TypeId::kInt:
+      if (json.is_number_integer()) {
+        return Literal::Int(json.get<int32_t>());
+      }
+      break;
+    case TypeId::kLong:
+      if (json.is_number_integer()) {
+        return Literal::Long(json.get<int64_t>());
+      }
+      break;
+    case TypeId::kFloat:
+      if (json.is_number()) {
+        return Literal::Float(json.get<float>());
+      }
+      break;
+    case TypeId::kDouble:
+      if (json.is_number()) {
+        return Literal::Double(json.get<double>());
+      }
+      break;
+    case TypeId::kString:
+      if (str != nullptr) {
+        return Literal::String(*str);
+      }
+      break;
+    case TypeId::kUuid:
+      if (str != nullptr) {
+        ICEBERG_ASSIGN_OR_RAISE(auto uuid, Uuid::FromString(*str));
+        return Literal::UUID(uuid);
+      }
+      break;
+    case TypeId::kDate:
+      if (str != nullptr) {
+        std::string_view rest = *str;
+        if (auto date = ConsumeDate(rest); date && rest.empty()) {
+          return Literal::Date(*date);
+        }
+      }
+      break;
+    case TypeId::kTime:
+      if (str != nullptr) {
+        std::string_view rest = *str;
+        if (auto time = ConsumeTime(rest); time && rest.empty()) {
+          return Literal::Time(*time);
+        }
+      }
+      break;
+    case TypeId::kTimestamp:
+      if (str != nullptr) {
+        if (auto timestamp = ParseTimestamp(*str, /*with_zone=*/false)) {
+          return Literal::Timestamp(*timestamp);
+        }
+      }
+      break;
+    case TypeId::kTimestampTz:
+      if (str != nullptr) {
+        if (auto timestamp = ParseTimestamp(*str, /*with_zone=*/true)) {
+          return Literal::TimestampTz(*timestamp);
+        }
+      }
+      break;
+    case TypeId::kBinary:
+    case TypeId::kFixed:
+      if (str != nullptr) {
+        if (auto bytes = ParseHex(*str)) {
+          return type->type_id() == TypeId::kBinary ? Literal::Binary(std::move(*bytes))
+                                                    : Literal::Fixed(std::move(*bytes));
+        }
+      }
+      break;
+    case TypeId::kDecimal:
+      if (str != nullptr) {
+        const auto& decimal_type = internal::checked_cast<const DecimalType&>(*type);
+        int32_t scale = 0;
+        ICEBERG_ASSIGN_OR_RAISE(auto decimal,
+                                Decimal::FromString(*str, /*precision=*/nullptr, &scale));
+        if (scale == decimal_type.scale()) {
+          return Literal::Decimal(decimal.value(), decimal_type.precision(), scale);
+        }
+      }
+      break;
+    default:
+      break;
+  }
+  return JsonParseError("Cannot parse {} value from {}", type->ToString(),
+                        SafeDumpJson(json));
+}
+
+/// \brief Parses a map of column IDs to counts, serialized as arrays of keys and values.
+Result<std::map<int32_t, int64_t>> CountMapFromJson(const nlohmann::json& json,
+                                                    std::string_view key) {
+  std::map<int32_t, int64_t> counts;
+  ICEBERG_ASSIGN_OR_RAISE(auto map_json, GetJsonValueOptional<nlohmann::json>(json, key));
+  if (!map_json.has_value()) {
+    return counts;
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto keys,
+                          GetJsonValue<std::vector<int32_t>>(*map_json, kKeys));
+  ICEBERG_ASSIGN_OR_RAISE(auto values,
+                          GetJsonValue<std::vector<int64_t>>(*map_json, kValues));
+  if (keys.size() != values.size()) {
+    return JsonParseError("Cannot parse {} with {} keys and {} values", key, keys.size(),
+                          values.size());
+  }
+  for (size_t i = 0; i < keys.size(); ++i) {
+    counts.emplace(keys[i], values[i]);
+  }
+  return counts;
+}
+
+/// \brief Parses a map of column IDs to bounds, serialized as arrays of keys and
+/// values, to the single-value binary serialization of the bounds.
+///
+/// Bounds of columns that are not primitive columns of the schema are dropped.
+Result<std::map<int32_t, std::vector<uint8_t>>> BoundMapFromJson(
+    const nlohmann::json& json, std::string_view key, const Schema& schema) {
+  std::map<int32_t, std::vector<uint8_t>> bounds;
+  ICEBERG_ASSIGN_OR_RAISE(auto map_json, GetJsonValueOptional<nlohmann::json>(json, key));
+  if (!map_json.has_value()) {
+    return bounds;
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto keys,
+                          GetJsonValue<std::vector<int32_t>>(*map_json, kKeys));
+  ICEBERG_ASSIGN_OR_RAISE(auto values, GetJsonValue<nlohmann::json>(*map_json, kValues));
+  if (!values.is_array() || keys.size() != values.size()) {
+    return JsonParseError("Cannot parse {} with {} keys and values {}", key, keys.size(),
+                          SafeDumpJson(values));
+  }
+  for (size_t i = 0; i < keys.size(); ++i) {
+    ICEBERG_ASSIGN_OR_RAISE(auto field, schema.FindFieldById(keys[i]));
+    if (!field.has_value() || !field->get().type()->is_primitive()) {
+      continue;
+    }
+    auto type = internal::checked_pointer_cast<PrimitiveType>(field->get().type());
+    ICEBERG_ASSIGN_OR_RAISE(auto bound, LiteralFromJson(values[i], type));
+    ICEBERG_ASSIGN_OR_RAISE(bounds[keys[i]], Conversions::ToBytes(bound));
+  }
+  return bounds;
+}
+
+/// \brief Parses a data or delete file of a scan planning response.
+Result<std::shared_ptr<DataFile>> ContentFileFromJson(const nlohmann::json& json,
+                                                      const TableMetadata& metadata,
+                                                      const Schema& schema) {
+  auto file = std::make_shared<DataFile>();
+  ICEBERG_ASSIGN_OR_RAISE(auto content, GetJsonValue<std::string>(json, kContent));
+  if (content == "data") {
+    file->content = DataFile::Content::kData;
+  } else if (content == "position-deletes") {
+    file->content = DataFile::Content::kPositionDeletes;
+  } else if (content == "equality-deletes") {
+    file->content = DataFile::Content::kEqualityDeletes;
+  } else {
+    return JsonParseError("Unknown content file type: {}", content);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(file->file_path, GetJsonValue<std::string>(json, kFilePath));
+  ICEBERG_ASSIGN_OR_RAISE(auto file_format, GetJsonValue<std::string>(json, kFileFormat));
+  ICEBERG_ASSIGN_OR_RAISE(file->file_format, FileFormatTypeFromString(file_format));
+  ICEBERG_ASSIGN_OR_RAISE(file->partition_spec_id, GetJsonValue<int32_t>(json, kSpecId));
+  ICEBERG_ASSIGN_OR_RAISE(file->record_count, GetJsonValue<int64_t>(json, kRecordCount));
+  ICEBERG_ASSIGN_OR_RAISE(file->file_size_in_bytes,
+                          GetJsonValue<int64_t>(json, kFileSizeInBytes));
+
+  ICEBERG_ASSIGN_OR_RAISE(auto spec, metadata.PartitionSpecById(file->partition_spec_id));
+  ICEBERG_ASSIGN_OR_RAISE(auto partition_type, spec->PartitionType());
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto partition,
+      GetJsonValueOrDefault<nlohmann::json>(json, kPartition, nlohmann::json::array()));
+  const size_t num_fields = partition_type ? partition_type->fields().size() : 0;
+  if (!partition.is_array() || partition.size() != num_fields) {
+    return JsonParseError("Cannot parse partition of spec {} from {}",
+                          file->partition_spec_id, SafeDumpJson(partition));
+  }
+  for (size_t i = 0; i < num_fields; ++i) {
+    auto type = internal::checked_pointer_cast<PrimitiveType>(
+        partition_type->fields()[i].type());
+    ICEBERG_ASSIGN_OR_RAISE(auto value, LiteralFromJson(partition[i], type));
+    file->partition.push_back(std::move(value));
+  }
+
+  ICEBERG_ASSIGN_OR_RAISE(auto key_metadata,
+                          GetJsonValueOptional<std::string>(json, kKeyMetadata));
+  if (key_metadata.has_value()) {
+    auto bytes = ParseHex(*key_metadata);
+    if (!bytes.has_value()) {
+      return JsonParseError("Cannot parse key metadata from {}", *key_metadata);
+    }
+    file->key_metadata = std::move(*bytes);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(
+      file->split_offsets,
+      GetJsonValueOrDefault<std::vector<int64_t>>(json, kSplitOffsets));
+  ICEBERG_ASSIGN_OR_RAISE(
+      file->equality_ids,
+      GetJsonValueOrDefault<std::vector<int32_t>>(json, kEqualityIds));
+  ICEBERG_ASSIGN_OR_RAISE(file->sort_order_id,
+                          GetJsonValueOptional<int32_t>(json, kSortOrderId));
+  ICEBERG_ASSIGN_OR_RAISE(file->first_row_id,
+                          GetJsonValueOptional<int64_t>(json, kFirstRowId));
+  ICEBERG_ASSIGN_OR_RAISE(file->referenced_data_file,
+                          GetJsonValueOptional<std::string>(json, kReferencedDataFile));
+  ICEBERG_ASSIGN_OR_RAISE(file->content_offset,
+                          GetJsonValueOptional<int64_t>(json, kContentOffset));
+  ICEBERG_ASSIGN_OR_RAISE(file->content_size_in_bytes,
+                          GetJsonValueOptional<int64_t>(json, kContentSizeInBytes));
+
+  ICEBERG_ASSIGN_OR_RAISE(file->column_sizes, CountMapFromJson(json, kColumnSizes));
+  ICEBERG_ASSIGN_OR_RAISE(file->value_counts, CountMapFromJson(json, kValueCounts));
+  ICEBERG_ASSIGN_OR_RAISE(file->null_value_counts,
+                          CountMapFromJson(json, kNullValueCounts));
+  ICEBERG_ASSIGN_OR_RAISE(file->nan_value_counts,
+                          CountMapFromJson(json, kNanValueCounts));
+  ICEBERG_ASSIGN_OR_RAISE(file->lower_bounds,
+                          BoundMapFromJson(json, kLowerBounds, schema));
+  ICEBERG_ASSIGN_OR_RAISE(file->upper_bounds,
+                          BoundMapFromJson(json, kUpperBounds, schema));
+  return file;
+}
+
+Result<ScanTasks> ScanTasksFromJson(const nlohmann::json& json,
+                                    const TableMetadata& metadata) {
+  ICEBERG_ASSIGN_OR_RAISE(auto schema, metadata.Schema());
+  ScanTasks tasks;
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto delete_files,
+      GetJsonValueOrDefault<nlohmann::json>(json, kDeleteFiles, nlohmann::json::array()));
+  for (const auto& delete_file_json : delete_files) {
+    ICEBERG_ASSIGN_OR_RAISE(auto delete_file,
+                            ContentFileFromJson(delete_file_json, metadata, *schema));
+    tasks.delete_files.push_back(std::move(delete_file));
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto file_scan_tasks,
+                          GetJsonValueOrDefault<nlohmann::json>(
+                              json, kFileScanTasks, nlohmann::json::array()));
+  for (const auto& task_json : file_scan_tasks) {
+    RestFileScanTask task;
+    ICEBERG_ASSIGN_OR_RAISE(auto data_file_json,
+                            GetJsonValue<nlohmann::json>(task_json, kDataFile));
+    ICEBERG_ASSIGN_OR_RAISE(task.data_file,
+                            ContentFileFromJson(data_file_json, metadata, *schema));
+    ICEBERG_ASSIGN_OR_RAISE(task.delete_file_references,
+                            GetJsonValueOrDefault<std::vector<int32_t>>(
+                                task_json, kDeleteFileReferences));
+    for (int32_t reference : task.delete_file_references) {
+      if (reference < 0 || static_cast<size_t>(reference) >= tasks.delete_files.size()) {
+        return JsonParseError("Delete file reference {} is out of range for {} files",
+                              reference, tasks.delete_files.size());
+      }
+    }
+    tasks.file_scan_tasks.push_back(std::move(task));
+  }
+  ICEBERG_ASSIGN_OR_RAISE(
+      tasks.plan_tasks,
+      GetJsonValueOrDefault<std::vector<std::string>>(json, kPlanTasks));
+  return tasks;
+}
+
+}  // namespace
+
+nlohmann::json ToJson(const Namespace& ns) { return ns.levels; }
+
+Result<Namespace> NamespaceFromJson(const nlohmann::json& json) {
+  if (!json.is_array()) {
+    return JsonParseError("Cannot parse namespace from non-array: {}",
+                          SafeDumpJson(json));
+  }
+  Namespace ns;
+  for (const auto& level : json) {
+    if (!level.is_string()) {
+      return JsonParseError("Cannot parse namespace level from non-string: {}",
+                            SafeDumpJson(level));
+    }
+    ns.levels.push_back(level.get<std::string>());
+  }
+  return ns;
+}
+
+nlohmann::json ToJson(const TableIdentifier& identifier) {
+  nlohmann::json json;
+  json[kNamespace] = ToJson(identifier.ns);
+  json[kName] = identifier.name;
+  return json;
+}
+
+Result<TableIdentifier> TableIdentifierFromJson(const nlohmann::json& json) {
+  ICEBERG_ASSIGN_OR_RAISE(auto ns_json, GetJsonValue<nlohmann::json>(json, kNamespace));
+  ICEBERG_ASSIGN_OR_RAISE(auto ns, NamespaceFromJson(ns_json));
+  ICEBERG_ASSIGN_OR_RAISE(auto name, GetJsonValue<std::string>(json, kName));
+  return TableIdentifier{.ns = std::move(ns), .name = std::move(name)};
+}
+
+nlohmann::json ToJson(const CreateNamespaceRequest& request) {
+  nlohmann::json json;
+  json[kNamespace] = ToJson(request.namespace_);
+  json[kProperties] = request.properties;
+  return json;
+}
+
+nlohmann::json ToJson(const UpdateNamespacePropertiesRequest& request) {
+  nlohmann::json json;
+  json[kRemovals] = request.removals;
+  json[kUpdates] = request.updates;
+  return json;
+}
+
+nlohmann::json ToJson(const RegisterTableRequest& request) {
+  nlohmann::json json;
+  json[kName] = request.name;
+  json[kMetadataLocation] = request.metadata_location;
+  if (request.overwrite) {
+    json[kOverwrite] = true;
+  }
+  return json;
+}
+
+Result<nlohmann::json> ToJson(const TableUpdate& update) {
+  nlohmann::json json;
+  if (const auto* u = dynamic_cast<const table::AssignUUID*>(&update)) {
+    json[kAction] = "assign-uuid";
+    json[kUUID] = u->uuid();
+  } else if (const auto* u = dynamic_cast<const table::UpgradeFormatVersion*>(&update)) {
+    json[kAction] = "upgrade-format-version";
+    json[kFormatVersion] = static_cast<int32_t>(u->format_version());
+  } else if (const auto* u = dynamic_cast<const table::AddSchema*>(&update)) {
+    json[kAction] = "add-schema";
+    json[kSchema] = iceberg::ToJson(*u->schema());
+    json[kLastColumnId] = u->last_column_id();
+  } else if (const auto* u = dynamic_cast<const table::SetCurrentSchema*>(&update)) {
+    json[kAction] = "set-current-schema";
+    json[kSchemaId] = u->schema_id();
+  } else if (const auto* u = dynamic_cast<const table::AddPartitionSpec*>(&update)) {
+    json[kAction] = "add-spec";
+    json[kSpec] = iceberg::ToJson(*u->spec());
+  } else if (const auto* u =
+                 dynamic_cast<const table::SetDefaultPartitionSpec*>(&update)) {
+    json[kAction] = "set-default-spec";
+    json[kSpecId] = u->spec_id();
+  } else if (const auto* u = dynamic_cast<const table::RemovePartitionSpecs*>(&update)) {
+    json[kAction] = "remove-partition-specs";
+    json[kSpecIds] = u->spec_ids();
+  } else if (const auto* u = dynamic_cast<const table::RemoveSchemas*>(&update)) {
+    json[kAction] = "remove-schemas";
+    json[kSchemaIds] = u->schema_ids();
+  } else if (const auto* u = dynamic_cast<const table::AddSortOrder*>(&update)) {
+    json[kAction] = "add-sort-order";
+    json[kSortOrder] = iceberg::ToJson(*u->sort_order());
+  } else if (const auto* u = dynamic_cast<const table::SetDefaultSortOrder*>(&update)) {
+    json[kAction] = "set-default-sort-order";
+    json[kSortOrderId] = u->sort_order_id();
+  } else if (const auto* u = dynamic_cast<const table::AddSnapshot*>(&update)) {
+    json[kAction] = "add-snapshot";
+    json[kSnapshot] = iceberg::ToJson(*u->snapshot());
+  } else if (const auto* u = dynamic_cast<const table::RemoveSnapshots*>(&update)) {
+    json[kAction] = "remove-snapshots";
+    json[kSnapshotIds] = u->snapshot_ids();
+  } else if (const auto* u = dynamic_cast<const table::RemoveSnapshotRef*>(&update)) {
+    json[kAction] = "remove-snapshot-ref";
+    json[kRefName] = u->ref_name();
+  } else if (const auto* u = dynamic_cast<const table::SetSnapshotRef*>(&update)) {
+    json[kAction] = "set-snapshot-ref";
+    json[kRefName] = u->ref_name();
+    json[kSnapshotId] = u->snapshot_id();
+    json[kType] = std::string(ToString(u->type()));
+    SetOptionalField(json, kMinSnapshotsToKeep, u->min_snapshots_to_keep());
+    SetOptionalField(json, kMaxSnapshotAgeMs, u->max_snapshot_age_ms());
+    SetOptionalField(json, kMaxRefAgeMs, u->max_ref_age_ms());
+  } else if (const auto* u = dynamic_cast<const table::SetProperties*>(&update)) {
+    json[kAction] = "set-properties";
+    json[kUpdates] = u->updated();
+  } else if (const auto* u = dynamic_cast<const table::RemoveProperties*>(&update)) {
+    json[kAction] = "remove-properties";
+    json[kRemovals] = u->removed();
+  } else if (const auto* u = dynamic_cast<const table::SetLocation*>(&update)) {
+    json[kAction] = "set-location";
+    json[kLocation] = u->location();
+  } else if (const auto* u = dynamic_cast<const table::SetStatistics*>(&update)) {
+    json[kAction] = "set-statistics";
+    json[kStatistics] = iceberg::ToJson(*u->statistics_file());
+  } else if (const auto* u = dynamic_cast<const table::RemoveStatistics*>(&update)) {
+    json[kAction] = "remove-statistics";
+    json[kSnapshotId] = u->snapshot_id();
+  } else if (const auto* u =
+                 dynamic_cast<const table::SetPartitionStatistics*>(&update)) {
+    json[kAction] = "set-partition-statistics";
+    json[kPartitionStatistics] = iceberg::ToJson(*u->partition_statistics_file());
+  } else if (const auto* u =
+                 dynamic_cast<const table::RemovePartitionStatistics*>(&update)) {
+    json[kAction] = "remove-partition-statistics";
+    json[kSnapshotId] = u->snapshot_id();
+  } else {
+    return NotSupported("Cannot serialize unknown table update");
+  }
+  return json;
+}
+
+Result<nlohmann::json> ToJson(const TableRequirement& requirement) {
+  nlohmann::json json;
+  if (dynamic_cast<const table::AssertDoesNotExist*>(&requirement) != nullptr) {
+    json[kType] = "assert-create";
+  } else if (const auto* r = dynamic_cast<const table::AssertUUID*>(&requirement)) {
+    json[kType] = "assert-table-uuid";
+    json[kUUID] = r->uuid();
+  } else if (const auto* r =
+                 dynamic_cast<const table::AssertRefSnapshotID*>(&requirement)) {
+    json[kType] = "assert-ref-snapshot-id";
+    json[kRef] = r->ref_name();
+    // A null snapshot id asserts that the ref does not exist.
+    json[kSnapshotId] = r->snapshot_id().has_value()
+                            ? nlohmann::json(r->snapshot_id().value())
+                            : nlohmann::json(nullptr);
+  } else if (const auto* r =
+                 dynamic_cast<const table::AssertLastAssignedFieldId*>(&requirement)) {
+    json[kType] = "assert-last-assigned-field-id";
+    json[kLastAssignedFieldId] = r->last_assigned_field_id();
+  } else if (const auto* r =
+                 dynamic_cast<const table::AssertCurrentSchemaID*>(&requirement)) {
+    json[kType] = "assert-current-schema-id";
+    json[kCurrentSchemaId] = r->schema_id();
+  } else if (const auto* r = dynamic_cast<const table::AssertLastAssignedPartitionId*>(
+                 &requirement)) {
+    json[kType] = "assert-last-assigned-partition-id";
+    json[kLastAssignedPartitionId] = r->last_assigned_partition_id();
+  } else if (const auto* r =
+                 dynamic_cast<const table::AssertDefaultSpecID*>(&requirement)) {
+    json[kType] = "assert-default-spec-id";
+    json[kDefaultSpecId] = r->spec_id();
+  } else if (const auto* r =
+                 dynamic_cast<const table::AssertDefaultSortOrderID*>(&requirement)) {
+    json[kType] = "assert-default-sort-order-id";
+    json[kDefaultSortOrderId] = r->sort_order_id();
+  } else {
+    return NotSupported("Cannot serialize unknown table requirement");
+  }
+  return json;
+}
+
+Result<nlohmann::json> CommitTableRequestToJson(
+    const TableIdentifier& identifier,
+    const std::vector<std::unique_ptr<TableRequirement>>& requirements,
+    const std::vector<std::unique_ptr<TableUpdate>>& updates) {
+  nlohmann::json json;
+  json[kIdentifier] = ToJson(identifier);
+  json[kRequirements] = nlohmann::json::array();
+  for (const auto& requirement : requirements) {
+    ICEBERG_ASSIGN_OR_RAISE(auto requirement_json, ToJson(*requirement));
+    json[kRequirements].push_back(std::move(requirement_json));
+  }
+  json[kUpdates] = nlohmann::json::array();
+  for (const auto& update : updates) {
+    ICEBERG_ASSIGN_OR_RAISE(auto update_json, ToJson(*update));
+    json[kUpdates].push_back(std::move(update_json));
+  }
+  return json;
+}
+
+Result<nlohmann::json> ToJson(const CommitTableRequest& request) {
+  return CommitTableRequestToJson(request.identifier, request.requirements,
+                                  request.updates);
+}
+
+Result<nlohmann::json> ToJson(const CommitTransactionRequest& request) {
+  nlohmann::json json;
+  json[kTableChanges] = nlohmann::json::array();
+  for (const auto& table_change : request.table_changes) {
+    ICEBERG_ASSIGN_OR_RAISE(auto table_change_json, ToJson(table_change));
+    json[kTableChanges].push_back(std::move(table_change_json));
+  }
+  return json;
+}
+
+Result<nlohmann::json> ToJson(const Expression& expr) {
+  nlohmann::json json;
+  const auto type = ExpressionTypeName(expr.op());
+  if (type.empty()) {
+    return NotSupported("Cannot serialize expression {} to JSON", expr.ToString());
+  }
+  json[kType] = type;
+  switch (expr.op()) {
+    case Expression::Operation::kTrue:
+    case Expression::Operation::kFalse:
+      return json;
+    case Expression::Operation::kNot: {
+      const auto& not_expr = internal::checked_cast<const Not&>(expr);
+      ICEBERG_ASSIGN_OR_RAISE(json[kChild], ToJson(*not_expr.child()));
+      return json;
+    }
+    case Expression::Operation::kAnd: {
+      const auto& and_expr = internal::checked_cast<const And&>(expr);
+      ICEBERG_ASSIGN_OR_RAISE(json[kLeft], ToJson(*and_expr.left()));
+      ICEBERG_ASSIGN_OR_RAISE(json[kRight], ToJson(*and_expr.right()));
+      return json;
+    }
+    case Expression::Operation::kOr: {
+      const auto& or_expr = internal::checked_cast<const Or&>(expr);
+      ICEBERG_ASSIGN_OR_RAISE(json[kLeft], ToJson(*or_expr.left()));
+      ICEBERG_ASSIGN_OR_RAISE(json[kRight], ToJson(*or_expr.right()));
+      return json;
+    }
+    default:
+      break;
+  }
+
+  if (const auto* pred = dynamic_cast<const UnboundPredicate<BoundReference>*>(&expr)) {
+    ICEBERG_RETURN_UNEXPECTED(PredicateToJson(*pred, json));
+    return json;
+  }
+  if (const auto* pred = dynamic_cast<const UnboundPredicate<BoundTransform>*>(&expr)) {
+    ICEBERG_RETURN_UNEXPECTED(PredicateToJson(*pred, json));
+    return json;
+  }
+  return NotSupported("Cannot serialize predicate {} to JSON", expr.ToString());
+}
+
+Result<std::shared_ptr<Expression>> ExpressionFromJson(const nlohmann::json& json) {
+  if (json.is_boolean()) {
+    return json.get<bool>() ? std::static_pointer_cast<Expression>(True::Instance())
+                            : std::static_pointer_cast<Expression>(False::Instance());
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto type, GetJsonValue<std::string>(json, kType));
+  std::optional<Expression::Operation> op;
+  for (auto candidate = Expression::Operation::kTrue;
+       candidate <= Expression::Operation::kNotStartsWith;
+       candidate = static_cast<Expression::Operation>(static_cast<int>(candidate) + 1)) {
+    if (ExpressionTypeName(candidate) == type) {
+      op = candidate;
+      break;
+    }
+  }
+  if (!op.has_value()) {
+    return JsonParseError("Unknown expression type: {}", type);
+  }
+
+  switch (*op) {
+    case Expression::Operation::kTrue:
+      return True::Instance();
+    case Expression::Operation::kFalse:
+      return False::Instance();
+    case Expression::Operation::kNot: {
+      ICEBERG_ASSIGN_OR_RAISE(auto child_json,
+                              GetJsonValue<nlohmann::json>(json, kChild));
+      ICEBERG_ASSIGN_OR_RAISE(auto child, ExpressionFromJson(child_json));
+      return std::make_shared<Not>(std::move(child));
+    }
+    case Expression::Operation::kAnd:
+    case Expression::Operation::kOr: {
+      ICEBERG_ASSIGN_OR_RAISE(auto left_json, GetJsonValue<nlohmann::json>(json, kLeft));
+      ICEBERG_ASSIGN_OR_RAISE(auto right_json,
+                              GetJsonValue<nlohmann::json>(json, kRight));
+      ICEBERG_ASSIGN_OR_RAISE(auto left, ExpressionFromJson(left_json));
+      ICEBERG_ASSIGN_OR_RAISE(auto right, ExpressionFromJson(right_json));
+      if (*op == Expression::Operation::kAnd) {
+        return std::make_shared<And>(std::move(left), std::move(right));
+      }
+      return std::make_shared<Or>(std::move(left), std::move(right));
+    }
+    default:
+      break;
+  }
+
+  std::vector<Literal> literals;
+  switch (*op) {
+    case Expression::Operation::kIsNull:
+    case Expression::Operation::kNotNull:
+    case Expression::Operation::kIsNan:
+    case Expression::Operation::kNotNan:
+      break;
+    case Expression::Operation::kIn:
+    case Expression::Operation::kNotIn: {
+      ICEBERG_ASSIGN_OR_RAISE(auto values, GetJsonValue<nlohmann::json>(json, kValues));
+      if (!values.is_array()) {
+        return JsonParseError("Cannot parse expression values from {}",
+                              SafeDumpJson(values));
+      }
+      for (const auto& value : values) {
+        ICEBERG_ASSIGN_OR_RAISE(auto literal, ExpressionLiteralFromJson(value));
+        literals.push_back(std::move(literal));
+      }
+      break;
+    }
+    default: {
+      ICEBERG_ASSIGN_OR_RAISE(auto value, GetJsonValue<nlohmann::json>(json, kValue));
+      ICEBERG_ASSIGN_OR_RAISE(auto literal, ExpressionLiteralFromJson(value));
+      literals.push_back(std::move(literal));
+      break;
+    }
+  }
+
+  ICEBERG_ASSIGN_OR_RAISE(auto term, GetJsonValue<nlohmann::json>(json, kTerm));
+  if (term.is_string()) {
+    return std::make_shared<UnboundPredicate<BoundReference>>(
+        *op, std::make_shared<NamedReference>(term.get<std::string>()),
+        std::move(literals));
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto term_type, GetJsonValue<std::string>(term, kType));
+  if (term_type != kTransform) {
+    return JsonParseError("Unknown term type: {}", term_type);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto transform_str,
+                          GetJsonValue<std::string>(term, kTransform));
+  ICEBERG_ASSIGN_OR_RAISE(auto name, GetJsonValue<std::string>(term, kTerm));
+  ICEBERG_ASSIGN_OR_RAISE(auto transform, TransformFromString(transform_str));
+  auto ref = std::make_shared<NamedReference>(std::move(name));
+  return std::make_shared<UnboundPredicate<BoundTransform>>(
+      *op, std::make_shared<UnboundTransform>(std::move(ref), std::move(transform)),
+      std::move(literals));
+}
+
+Result<nlohmann::json> ToJson(const PlanTableScanRequest& request) {
+  nlohmann::json json;
+  SetOptionalField(json, kSnapshotId, request.snapshot_id);
+  if (!request.select.empty()) {
+    json[kSelect] = request.select;
+  }
+  if (request.filter != nullptr) {
+    ICEBERG_ASSIGN_OR_RAISE(json[kFilter], ToJson(*request.filter));
+  }
+  json[kCaseSensitive] = request.case_sensitive;
+  SetOptionalField(json, kStartSnapshotId, request.start_snapshot_id);
+  SetOptionalField(json, kEndSnapshotId, request.end_snapshot_id);
+  return json;
+}
+
+Result<CatalogConfig> CatalogConfigFromJson(const nlohmann::json& json) {
+  CatalogConfig config;
+  ICEBERG_ASSIGN_OR_RAISE(config.defaults, FromJsonMap(json, kDefaults));
+  ICEBERG_ASSIGN_OR_RAISE(config.overrides, FromJsonMap(json, kOverrides));
+  ICEBERG_ASSIGN_OR_RAISE(
+      config.endpoints,
+      GetJsonValueOrDefault<std::vector<std::string>>(json, kEndpoints));
+  return config;
+}
+
+Result<ErrorResponse> ErrorResponseFromJson(const nlohmann::json& json) {
+  const auto& error_json =
+      json.contains(kError) && json.at(kError).is_object() ? json.at(kError) : json;
+  ErrorResponse error;
+  ICEBERG_ASSIGN_OR_RAISE(error.message, GetJsonValue<std::string>(error_json, kMessage));
+  ICEBERG_ASSIGN_OR_RAISE(error.type, GetJsonValue<std::string>(error_json, kType));
+  ICEBERG_ASSIGN_OR_RAISE(error.code, GetJsonValue<int32_t>(error_json, kCode));
+  return error;
+}
+
+Result<ListNamespacesResponse> ListNamespacesResponseFromJson(
+    const nlohmann::json& json) {
+  ListNamespacesResponse response;
+  ICEBERG_ASSIGN_OR_RAISE(response.next_page_token,
+                          GetJsonValueOrDefault<std::string>(json, kNextPageToken));
+  ICEBERG_ASSIGN_OR_RAISE(response.namespaces, NamespacesFromJson(json, kNamespaces));
+  return response;
+}
+
+Result<GetNamespaceResponse> GetNamespaceResponseFromJson(const nlohmann::json& json) {
+  GetNamespaceResponse response;
+  ICEBERG_ASSIGN_OR_RAISE(auto ns_json, GetJsonValue<nlohmann::json>(json, kNamespace));
+  ICEBERG_ASSIGN_OR_RAISE(response.namespace_, NamespaceFromJson(ns_json));
+  ICEBERG_ASSIGN_OR_RAISE(response.properties, FromJsonMap(json, kProperties));
+  return response;
+}
+
+Result<UpdateNamespacePropertiesResponse> UpdateNamespacePropertiesResponseFromJson(
+    const nlohmann::json& json) {
+  UpdateNamespacePropertiesResponse response;
+  ICEBERG_ASSIGN_OR_RAISE(response.updated,
+                          GetJsonValue<std::vector<std::string>>(json, kUpdated));
+  ICEBERG_ASSIGN_OR_RAISE(response.removed,
+                          GetJsonValue<std::vector<std::string>>(json, kRemoved));
+  ICEBERG_ASSIGN_OR_RAISE(
+      response.missing,
+      GetJsonValueOrDefault<std::vector<std::string>>(json, kMissing));
+  return response;
+}
+
+Result<ListTablesResponse> ListTablesResponseFromJson(const nlohmann::json& json) {
+  ListTablesResponse response;
+  ICEBERG_ASSIGN_OR_RAISE(response.next_page_token,
+                          GetJsonValueOrDefault<std::string>(json, kNextPageToken));
+  ICEBERG_ASSIGN_OR_RAISE(
+      response.identifiers,
+      FromJsonList<TableIdentifier>(json, kIdentifiers, TableIdentifierFromJson));
+  return response;
+}
+
+Result<LoadTableResult> LoadTableResultFromJson(const nlohmann::json& json) {
+  LoadTableResult result;
+  ICEBERG_ASSIGN_OR_RAISE(result.metadata_location,
+                          GetJsonValueOptional<std::string>(json, kMetadataLocation));
+  ICEBERG_ASSIGN_OR_RAISE(auto metadata_json,
+                          GetJsonValue<nlohmann::json>(json, kMetadata));
+  ICEBERG_ASSIGN_OR_RAISE(result.metadata, TableMetadataFromJson(metadata_json));
+  ICEBERG_ASSIGN_OR_RAISE(result.config, FromJsonMap(json, kConfig));
+  return result;
+}
+
+Result<CommitTableResponse> CommitTableResponseFromJson(const nlohmann::json& json) {
+  CommitTableResponse response;
+  ICEBERG_ASSIGN_OR_RAISE(response.metadata_location,
+                          GetJsonValue<std::string>(json, kMetadataLocation));
+  ICEBERG_ASSIGN_OR_RAISE(auto metadata_json,
+                          GetJsonValue<nlohmann::json>(json, kMetadata));
+  ICEBERG_ASSIGN_OR_RAISE(response.metadata, TableMetadataFromJson(metadata_json));
+  return response;
+}
+
+Result<PlanTableScanResponse> PlanTableScanResponseFromJson(
+    const nlohmann::json& json, const TableMetadata& metadata) {
+  PlanTableScanResponse response;
+  ICEBERG_ASSIGN_OR_RAISE(response.plan_status, GetJsonValue<std::string>(json, kStatus));
+  ICEBERG_ASSIGN_OR_RAISE(response.plan_id,
+                          GetJsonValueOrDefault<std::string>(json, kPlanId));
+  ICEBERG_ASSIGN_OR_RAISE(response.tasks, ScanTasksFromJson(json, metadata));
+  return response;
+}
+
+Result<FetchScanTasksResponse> FetchScanTasksResponseFromJson(
+    const nlohmann::json& json, const TableMetadata& metadata) {
+  return ScanTasksFromJson(json, metadata);
+}
+
+}  // namespace iceberg::rest
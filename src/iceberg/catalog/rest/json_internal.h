@@ -0,0 +1,156 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/catalog/rest/json_internal.h
+/// JSON serialization of the request and response bodies of the Iceberg REST Catalog
+/// API.
+
+#include <memory>
+#include <vector>
+
+#include <nlohmann/json_fwd.hpp>
+
+#include "iceberg/catalog/rest/iceberg_rest_export.h"
+#include "iceberg/catalog/rest/types.h"
+#include "iceberg/result.h"
+#include "iceberg/table_identifier.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg::rest {
+
+/// \brief Serializes a namespace to a JSON array of its levels.
+ICEBERG_REST_EXPORT nlohmann::json ToJson(const Namespace& ns);
+
+/// \brief Deserializes a namespace from a JSON array of its levels.
+ICEBERG_REST_EXPORT Result<Namespace> NamespaceFromJson(const nlohmann::json& json);
+
+/// \brief Serializes a table identifier to a JSON object.
+ICEBERG_REST_EXPORT nlohmann::json ToJson(const TableIdentifier& identifier);
+
+/// \brief Deserializes a table identifier from a JSON object.
+ICEBERG_REST_EXPORT Result<TableIdentifier> TableIdentifierFromJson(
+    const nlohmann::json& json);
+
+/// \brief Serializes a `CreateNamespaceRequest` to a JSON object.
+ICEBERG_REST_EXPORT nlohmann::json ToJson(const CreateNamespaceRequest& request);
+
+/// \brief Serializes an `UpdateNamespacePropertiesRequest` to a JSON object.
+ICEBERG_REST_EXPORT nlohmann::json ToJson(
+    const UpdateNamespacePropertiesRequest& request);
+
+/// \brief Serializes a `RegisterTableRequest` to a JSON object.
+ICEBERG_REST_EXPORT nlohmann::json ToJson(const RegisterTableRequest& request);
+
+/// \brief Serializes a table update to a JSON object of its action.
+///
+/// \return The JSON object, or an error if the update has no REST representation.
+ICEBERG_REST_EXPORT Result<nlohmann::json> ToJson(const TableUpdate& update);
+
+/// \brief Serializes a table requirement to a JSON object of its type.
+///
+/// \return The JSON object, or an error if the requirement has no REST representation.
+ICEBERG_REST_EXPORT Result<nlohmann::json> ToJson(const TableRequirement& requirement);
+
+/// \brief Serializes the changes of a table to a `CommitTableRequest` JSON object.
+///
+/// \return The JSON object, or an error if a requirement or update has no REST
+/// representation.
+ICEBERG_REST_EXPORT Result<nlohmann::json> CommitTableRequestToJson(
+    const TableIdentifier& identifier,
+    const std::vector<std::unique_ptr<TableRequirement>>& requirements,
+    const std::vector<std::unique_ptr<TableUpdate>>& updates);
+
+/// \brief Serializes a `CommitTableRequest` to a JSON object.
+ICEBERG_REST_EXPORT Result<nlohmann::json> ToJson(const CommitTableRequest& request);
+
+/// \brief Serializes a `CommitTransactionRequest` to a JSON object.
+ICEBERG_REST_EXPORT Result<nlohmann::json> ToJson(
+    const CommitTransactionRequest& request);
+
+/// \brief Serializes an expression to a JSON object of the REST expression model.
+///
+/// Predicates on transforms are written with a transform term object.
+///
+/// \return The JSON object, or NotSupported for bound predicates and literals of
+/// binary, fixed and decimal types.
+ICEBERG_REST_EXPORT Result<nlohmann::json> ToJson(const Expression& expr);
+
+/// \brief Deserializes an unbound expression from a JSON object of the REST expression
+/// model.
+///
+/// Literal values have no type in the model: numbers are parsed as long or double
+/// literals, which are converted to the types of the referenced columns when the
+/// expression is bound.
+ICEBERG_REST_EXPORT Result<std::shared_ptr<Expression>> ExpressionFromJson(
+    const nlohmann::json& json);
+
+/// \brief Serializes a `PlanTableScanRequest` to a JSON object.
+///
+/// \return The JSON object, or NotSupported if the filter cannot be serialized.
+ICEBERG_REST_EXPORT Result<nlohmann::json> ToJson(const PlanTableScanRequest& request);
+
+/// \brief Deserializes a `CatalogConfig` from a JSON object.
+ICEBERG_REST_EXPORT Result<CatalogConfig> CatalogConfigFromJson(
+    const nlohmann::json& json);
+
+/// \brief Deserializes an `ErrorResponse` from a JSON object.
+///
+/// The error model may be nested in an "error" object, as the REST spec defines it.
+ICEBERG_REST_EXPORT Result<ErrorResponse> ErrorResponseFromJson(
+    const nlohmann::json& json);
+
+/// \brief Deserializes a `ListNamespacesResponse` from a JSON object.
+ICEBERG_REST_EXPORT Result<ListNamespacesResponse> ListNamespacesResponseFromJson(
+    const nlohmann::json& json);
+
+/// \brief Deserializes a `GetNamespaceResponse` from a JSON object.
+ICEBERG_REST_EXPORT Result<GetNamespaceResponse> GetNamespaceResponseFromJson(
+    const nlohmann::json& json);
+
+/// \brief Deserializes an `UpdateNamespacePropertiesResponse` from a JSON object.
+ICEBERG_REST_EXPORT Result<UpdateNamespacePropertiesResponse>
+UpdateNamespacePropertiesResponseFromJson(const nlohmann::json& json);
+
+/// \brief Deserializes a `ListTablesResponse` from a JSON object.
+ICEBERG_REST_EXPORT Result<ListTablesResponse> ListTablesResponseFromJson(
+    const nlohmann::json& json);
+
+/// \brief Deserializes a `LoadTableResult` from a JSON object.
+ICEBERG_REST_EXPORT Result<LoadTableResult> LoadTableResultFromJson(
+    const nlohmann::json& json);
+
+/// \brief Deserializes a `CommitTableResponse` from a JSON object.
+ICEBERG_REST_EXPORT Result<CommitTableResponse> CommitTableResponseFromJson(
+    const nlohmann::json& json);
+
+/// \brief Deserializes a `PlanTableScanResponse` from a JSON object.
+///
+/// The partition values and column bounds of the content files are parsed with the
+/// partition specs and the current schema of the scanned table.
+ICEBERG_REST_EXPORT Result<PlanTableScanResponse> PlanTableScanResponseFromJson(
+    const nlohmann::json& json, const TableMetadata& metadata);
+
+/// \brief Deserializes a `FetchScanTasksResponse` from a JSON object, like
+/// PlanTableScanResponseFromJson.
+ICEBERG_REST_EXPORT Result<FetchScanTasksResponse> FetchScanTasksResponseFromJson(
+    const nlohmann::json& json, const TableMetadata& metadata);
+
+}  // namespace iceberg::rest
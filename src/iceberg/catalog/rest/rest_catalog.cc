@@ -19,26 +19,507 @@
 
 #include "iceberg/catalog/rest/rest_catalog.h"
 
+#include <algorithm>
+#include <format>
+#include <iterator>
+#include <string_view>
 #include <utility>
 
 #include <cpr/cpr.h>
+#include <nlohmann/json.hpp>
 
+#include "iceberg/catalog/rest/json_internal.h"
 #include "iceberg/catalog/rest/types.h"
+#include "iceberg/exception.h"
+#include "iceberg/executor.h"
+#include "iceberg/json_internal.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/table.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/table_requirement.h"
+#include "iceberg/table_update.h"
+#include "iceberg/util/macros.h"
+#include "iceberg/util/tracing.h"
 
 namespace iceberg::catalog::rest {
 
-RestCatalog::RestCatalog(const std::string& base_url) : base_url_(std::move(base_url)) {}
+namespace {
 
-cpr::Response RestCatalog::GetConfig() {
-  cpr::Url url = cpr::Url{base_url_ + "/v1/config"};
-  cpr::Response r = cpr::Get(url);
-  return r;
+constexpr std::string_view kPrefix = "prefix";
+constexpr std::string_view kWarehouse = "warehouse";
+/// \brief The separator of namespace levels in URLs, the unit separator.
+constexpr char kNamespaceSeparator = '\x1F';
+
+/// \brief The kind of resource of a request, for errors without a known type.
+enum class ResourceKind { kConfig, kNamespace, kTable, kCommit, kPlan };
+
+/// \brief Percent-encodes a path segment or query value.
+std::string UrlEncode(std::string_view value) {
+  constexpr std::string_view kHexDigits = "0123456789ABCDEF";
+  std::string encoded;
+  encoded.reserve(value.size());
+  for (char c : value) {
+    auto byte = static_cast<unsigned char>(c);
+    if ((byte >= 'A' && byte <= 'Z') || (byte >= 'a' && byte <= 'z') ||
+        (byte >= '0' && byte <= '9') || c == '-' || c == '.' || c == '_' || c == '~') {
+      encoded.push_back(c);
+    } else {
+      encoded.push_back('%');
+      encoded.push_back(kHexDigits[byte >> 4]);
+      encoded.push_back(kHexDigits[byte & 0x0F]);
+    }
+  }
+  return encoded;
+}
+
+/// \brief Joins the levels of a namespace with the unit separator.
+std::string JoinNamespace(const Namespace& ns) {
+  std::string joined;
+  for (const auto& level : ns.levels) {
+    if (!joined.empty()) {
+      joined.push_back(kNamespaceSeparator);
+    }
+    joined.append(level);
+  }
+  return joined;
+}
+
+Result<nlohmann::json> ParseJson(const std::string& body) {
+  auto json = nlohmann::json::parse(body, /*cb=*/nullptr, /*allow_exceptions=*/false);
+  if (json.is_discarded()) {
+    return JsonParseError("Invalid JSON response: {}", body);
+  }
+  return json;
+}
+
+/// \brief Converts an unsuccessful response to an error.
+///
+/// The error type of the REST error model takes precedence, and the status code
+/// decides for other errors, depending on the kind of resource requested.
+std::unexpected<Error> ErrorFromResponse(const cpr::Response& response,
+                                         ResourceKind resource) {
+  std::string message = response.text;
+  std::string type;
+  if (auto json = ParseJson(response.text); json.has_value()) {
+    if (auto error = ::iceberg::rest::ErrorResponseFromJson(json.value());
+        error.has_value()) {
+      message = std::move(error->message);
+      type = std::move(error->type);
+    }
+  }
+  if (message.empty()) {
+    message = std::format("HTTP status {}", response.status_code);
+  }
+
+  if (type == "NoSuchNamespaceException") {
+    return NoSuchNamespace("{}", message);
+  }
+  if (type == "NoSuchTableException") {
+    return NoSuchTable("{}", message);
+  }
+  if (type == "AlreadyExistsException") {
+    return AlreadyExists("{}", message);
+  }
+  if (type == "NamespaceNotEmptyException") {
+    return NotAllowed("{}", message);
+  }
+  if (type == "CommitFailedException") {
+    return CommitFailed("{}", message);
+  }
+
+  switch (response.status_code) {
+    case 400:
+      return InvalidArgument("{}", message);
+    case 401:
+    case 403:
+      return NotAllowed("{}", message);
+    case 404:
+      if (resource == ResourceKind::kNamespace) {
+        return NoSuchNamespace("{}", message);
+      }
+      if (resource == ResourceKind::kTable || resource == ResourceKind::kCommit) {
+        return NoSuchTable("{}", message);
+      }
+      return NotFound("{}", message);
+    case 405:
+    case 406:
+      return NotSupported("{}", message);
+    case 409:
+      if (resource == ResourceKind::kCommit) {
+        return CommitFailed("{}", message);
+      }
+      return AlreadyExists("{}", message);
+    case 501:
+      return NotImplemented("{}", message);
+    default:
+      break;
+  }
+  if (resource == ResourceKind::kCommit && response.status_code >= 500) {
+    // The commit may have succeeded on the server.
+    return CommitStateUnknown("{}", message);
+  }
+  return IOError("{}", message);
+}
+
+bool IsSuccess(const cpr::Response& response) {
+  return response.status_code >= 200 && response.status_code < 300;
+}
+
+/// \brief Returns the JSON body of a successful response, or the error of another.
+Result<nlohmann::json> ResponseJson(const cpr::Response& response,
+                                    ResourceKind resource) {
+  if (!IsSuccess(response)) {
+    return ErrorFromResponse(response, resource);
+  }
+  return ParseJson(response.text);
+}
+
+Status ResponseStatus(const cpr::Response& response, ResourceKind resource) {
+  if (!IsSuccess(response)) {
+    return ErrorFromResponse(response, resource);
+  }
+  return {};
+}
+
+/// \brief Returns whether a HEAD request found its resource.
+Result<bool> ResponseExists(const cpr::Response& response, ResourceKind resource) {
+  if (response.status_code == 404) {
+    return false;
+  }
+  ICEBERG_RETURN_UNEXPECTED(ResponseStatus(response, resource));
+  return true;
+}
+
+}  // namespace
+
+RestCatalog::RestCatalog(RestCatalogConfig config, std::unique_ptr<HttpClient> client,
+                         std::unordered_map<std::string, std::string> properties,
+                         std::vector<std::string> endpoints)
+    : config_(std::move(config)),
+      client_(std::move(client)),
+      properties_(std::move(properties)),
+      endpoints_(std::make_move_iterator(endpoints.begin()),
+                 std::make_move_iterator(endpoints.end())) {
+  std::string_view uri = config_.uri;
+  while (uri.ends_with('/')) {
+    uri.remove_suffix(1);
+  }
+  base_url_ = std::format("{}/v1/", uri);
+  if (auto it = properties_.find(std::string(kPrefix));
+      it != properties_.end() && !it->second.empty()) {
+    base_url_ += UrlEncode(it->second) + "/";
+  }
+}
+
+RestCatalog::~RestCatalog() = default;
+
+Result<std::shared_ptr<RestCatalog>> RestCatalog::Make(RestCatalogConfig config) {
+  if (config.uri.empty()) {
+    return InvalidArgument("The URI of the REST catalog is not set");
+  }
+  auto client = std::make_unique<HttpClient>(config.http_options);
+
+  std::string_view uri = config.uri;
+  while (uri.ends_with('/')) {
+    uri.remove_suffix(1);
+  }
+  cpr::Parameters parameters;
+  if (auto it = config.properties.find(std::string(kWarehouse));
+      it != config.properties.end()) {
+    parameters.Add({std::string(kWarehouse), it->second});
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto response,
+                          client->Get(std::format("{}/v1/config", uri), parameters));
+  ICEBERG_ASSIGN_OR_RAISE(auto json, ResponseJson(response, ResourceKind::kConfig));
+  ICEBERG_ASSIGN_OR_RAISE(auto server_config,
+                          ::iceberg::rest::CatalogConfigFromJson(json));
+
+  auto properties = std::move(server_config.defaults);
+  for (const auto& [key, value] : config.properties) {
+    properties[key] = value;
+  }
+  for (auto& [key, value] : server_config.overrides) {
+    properties[key] = std::move(value);
+  }
+  return std::shared_ptr<RestCatalog>(
+      new RestCatalog(std::move(config), std::move(client), std::move(properties),
+                      std::move(server_config.endpoints)));
+}
+
+std::string_view RestCatalog::name() const { return config_.name; }
+
+std::string RestCatalog::NamespacesUrl() const { return base_url_ + "namespaces"; }
+
+std::string RestCatalog::NamespaceUrl(const Namespace& ns) const {
+  return std::format("{}/{}", NamespacesUrl(), UrlEncode(JoinNamespace(ns)));
+}
+
+std::string RestCatalog::TablesUrl(const Namespace& ns) const {
+  return NamespaceUrl(ns) + "/tables";
+}
+
+std::string RestCatalog::TableUrl(const TableIdentifier& identifier) const {
+  return std::format("{}/{}", TablesUrl(identifier.ns), UrlEncode(identifier.name));
+}
+
+Status RestCatalog::CreateNamespace(
+    const Namespace& ns, const std::unordered_map<std::string, std::string>& properties) {
+  ::iceberg::rest::CreateNamespaceRequest request{.namespace_ = ns,
+                                                  .properties = properties};
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto response,
+      client_->Post(NamespacesUrl(), ::iceberg::rest::ToJson(request).dump()));
+  return ResponseStatus(response, ResourceKind::kNamespace);
+}
+
+Result<std::vector<Namespace>> RestCatalog::ListNamespaces(const Namespace& ns) const {
+  std::vector<Namespace> namespaces;
+  std::string page_token;
+  do {
+    cpr::Parameters parameters;
+    if (!ns.levels.empty()) {
+      parameters.Add({"parent", JoinNamespace(ns)});
+    }
+    if (!page_token.empty()) {
+      parameters.Add({"pageToken", page_token});
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto response, client_->Get(NamespacesUrl(), parameters));
+    ICEBERG_ASSIGN_OR_RAISE(auto json, ResponseJson(response, ResourceKind::kNamespace));
+    ICEBERG_ASSIGN_OR_RAISE(auto page,
+                            ::iceberg::rest::ListNamespacesResponseFromJson(json));
+    std::ranges::move(page.namespaces, std::back_inserter(namespaces));
+    page_token = std::move(page.next_page_token);
+  } while (!page_token.empty());
+  return namespaces;
+}
+
+Status RestCatalog::DropNamespace(const Namespace& ns) {
+  ICEBERG_ASSIGN_OR_RAISE(auto response,
+                          client_->Delete(NamespaceUrl(ns), cpr::Parameters{}));
+  return ResponseStatus(response, ResourceKind::kNamespace);
+}
+
+Result<bool> RestCatalog::NamespaceExists(const Namespace& ns) const {
+  ICEBERG_ASSIGN_OR_RAISE(auto response, client_->Head(NamespaceUrl(ns)));
+  return ResponseExists(response, ResourceKind::kNamespace);
+}
+
+Result<std::unordered_map<std::string, std::string>> RestCatalog::GetNamespaceProperties(
+    const Namespace& ns) const {
+  ICEBERG_ASSIGN_OR_RAISE(auto response,
+                          client_->Get(NamespaceUrl(ns), cpr::Parameters{}));
+  ICEBERG_ASSIGN_OR_RAISE(auto json, ResponseJson(response, ResourceKind::kNamespace));
+  ICEBERG_ASSIGN_OR_RAISE(auto result,
+                          ::iceberg::rest::GetNamespaceResponseFromJson(json));
+  return std::move(result.properties);
+}
+
+Status RestCatalog::UpdateNamespaceProperties(
+    const Namespace& ns, const std::unordered_map<std::string, std::string>& updates,
+    const std::unordered_set<std::string>& removals) {
+  ::iceberg::rest::UpdateNamespacePropertiesRequest request{
+      .removals = {removals.begin(), removals.end()}, .updates = updates};
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto response, client_->Post(NamespaceUrl(ns) + "/properties",
+                                   ::iceberg::rest::ToJson(request).dump()));
+  ICEBERG_ASSIGN_OR_RAISE(auto json, ResponseJson(response, ResourceKind::kNamespace));
+  ICEBERG_RETURN_UNEXPECTED(
+      ::iceberg::rest::UpdateNamespacePropertiesResponseFromJson(json));
+  return {};
+}
+
+Result<std::vector<TableIdentifier>> RestCatalog::ListTables(const Namespace& ns) const {
+  std::vector<TableIdentifier> identifiers;
+  std::string page_token;
+  do {
+    cpr::Parameters parameters;
+    if (!page_token.empty()) {
+      parameters.Add({"pageToken", page_token});
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto response, client_->Get(TablesUrl(ns), parameters));
+    ICEBERG_ASSIGN_OR_RAISE(auto json, ResponseJson(response, ResourceKind::kNamespace));
+    ICEBERG_ASSIGN_OR_RAISE(auto page, ::iceberg::rest::ListTablesResponseFromJson(json));
+    std::ranges::move(page.identifiers, std::back_inserter(identifiers));
+    page_token = std::move(page.next_page_token);
+  } while (!page_token.empty());
+  return identifiers;
+}
+
+Result<std::unique_ptr<Table>> RestCatalog::CreateTable(
+    const TableIdentifier& identifier, const Schema& schema, const PartitionSpec& spec,
+    const std::string& location,
+    const std::unordered_map<std::string, std::string>& properties) {
+  ICEBERG_TRACE_SCOPE(trace, "Catalog::CreateTable");
+  ICEBERG_TRACE_ATTRIBUTE(trace, "table", identifier.name);
+  nlohmann::json request;
+  request["name"] = identifier.name;
+  if (!location.empty()) {
+    request["location"] = location;
+  }
+  request["schema"] = ToJson(schema);
+  request["partition-spec"] = ToJson(spec);
+  request["properties"] = properties;
+  ICEBERG_ASSIGN_OR_RAISE(auto response,
+                          client_->Post(TablesUrl(identifier.ns), request.dump()));
+  ICEBERG_ASSIGN_OR_RAISE(auto json, ResponseJson(response, ResourceKind::kTable));
+  ICEBERG_ASSIGN_OR_RAISE(auto result, ::iceberg::rest::LoadTableResultFromJson(json));
+  return MakeTable(identifier, std::move(result.metadata),
+                   result.metadata_location.value_or(""));
+}
+
+Result<std::unique_ptr<Table>> RestCatalog::UpdateTable(
+    const TableIdentifier& identifier,
+    const std::vector<std::unique_ptr<TableRequirement>>& requirements,
+    const std::vector<std::unique_ptr<TableUpdate>>& updates) {
+  ICEBERG_TRACE_SCOPE(trace, "Catalog::UpdateTable");
+  ICEBERG_TRACE_ATTRIBUTE(trace, "table", identifier.name);
+  ICEBERG_ASSIGN_OR_RAISE(auto request, ::iceberg::rest::CommitTableRequestToJson(
+                                              identifier, requirements, updates));
+  ICEBERG_ASSIGN_OR_RAISE(auto response,
+                          client_->Post(TableUrl(identifier), request.dump()));
+  ICEBERG_ASSIGN_OR_RAISE(auto json, ResponseJson(response, ResourceKind::kCommit));
+  ICEBERG_ASSIGN_OR_RAISE(auto result,
+                          ::iceberg::rest::CommitTableResponseFromJson(json));
+  return MakeTable(identifier, std::move(result.metadata),
+                   std::move(result.metadata_location));
+}
+
+Status RestCatalog::CommitTransaction(
+    const ::iceberg::rest::CommitTransactionRequest& request) {
+  ICEBERG_TRACE_SCOPE(trace, "Catalog::CommitTransaction");
+  ICEBERG_TRACE_ATTRIBUTE(trace, "tables",
+                          static_cast<int64_t>(request.table_changes.size()));
+  ICEBERG_ASSIGN_OR_RAISE(auto json, ::iceberg::rest::ToJson(request));
+  ICEBERG_ASSIGN_OR_RAISE(auto response,
+                          client_->Post(base_url_ + "transactions/commit", json.dump()));
+  return ResponseStatus(response, ResourceKind::kCommit);
+}
+
+Result<std::shared_ptr<Transaction>> RestCatalog::StageCreateTable(
+    const TableIdentifier& identifier, const Schema& schema, const PartitionSpec& spec,
+    const std::string& location,
+    const std::unordered_map<std::string, std::string>& properties) {
+  return NotImplemented("stage create table");
+}
+
+Result<bool> RestCatalog::TableExists(const TableIdentifier& identifier) const {
+  ICEBERG_ASSIGN_OR_RAISE(auto response, client_->Head(TableUrl(identifier)));
+  return ResponseExists(response, ResourceKind::kTable);
+}
+
+Status RestCatalog::DropTable(const TableIdentifier& identifier, bool purge) {
+  ICEBERG_TRACE_SCOPE(trace, "Catalog::DropTable");
+  ICEBERG_TRACE_ATTRIBUTE(trace, "table", identifier.name);
+  cpr::Parameters parameters{{"purgeRequested", purge ? "true" : "false"}};
+  ICEBERG_ASSIGN_OR_RAISE(auto response,
+                          client_->Delete(TableUrl(identifier), parameters));
+  return ResponseStatus(response, ResourceKind::kTable);
+}
+
+Result<std::unique_ptr<Table>> RestCatalog::LoadTable(const TableIdentifier& identifier) {
+  ICEBERG_TRACE_SCOPE(trace, "Catalog::LoadTable");
+  ICEBERG_TRACE_ATTRIBUTE(trace, "table", identifier.name);
+  ICEBERG_ASSIGN_OR_RAISE(auto response,
+                          client_->Get(TableUrl(identifier), cpr::Parameters{}));
+  ICEBERG_ASSIGN_OR_RAISE(auto json, ResponseJson(response, ResourceKind::kTable));
+  ICEBERG_ASSIGN_OR_RAISE(auto result, ::iceberg::rest::LoadTableResultFromJson(json));
+  return MakeTable(identifier, std::move(result.metadata),
+                   result.metadata_location.value_or(""));
+}
+
+std::vector<Result<std::unique_ptr<Table>>> RestCatalog::LoadTables(
+    const std::vector<TableIdentifier>& identifiers, int32_t parallelism,
+    std::shared_ptr<Executor> executor) {
+  if (executor == nullptr) {
+    executor = DefaultExecutor();
+  }
+  std::vector<Result<std::unique_ptr<Table>>> tables(identifiers.size());
+  // Each table keeps its own result, so one failed load does not stop the others.
+  auto status = RunInParallel(*executor, identifiers.size(), std::max(parallelism, 1),
+                              [&](size_t index) -> Status {
+                                tables[index] = LoadTable(identifiers[index]);
+                                return {};
+                              });
+  ICEBERG_DCHECK(status.has_value(), "Table loads do not fail the batch");
+  return tables;
+}
+
+Result<std::shared_ptr<Table>> RestCatalog::RegisterTable(
+    const TableIdentifier& identifier, const std::string& metadata_file_location) {
+  ::iceberg::rest::RegisterTableRequest request{
+      .name = identifier.name, .metadata_location = metadata_file_location};
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto response, client_->Post(NamespaceUrl(identifier.ns) + "/register",
+                                   ::iceberg::rest::ToJson(request).dump()));
+  ICEBERG_ASSIGN_OR_RAISE(auto json, ResponseJson(response, ResourceKind::kTable));
+  ICEBERG_ASSIGN_OR_RAISE(auto result, ::iceberg::rest::LoadTableResultFromJson(json));
+  return MakeTable(identifier, std::move(result.metadata),
+                   result.metadata_location.value_or(metadata_file_location));
+}
+
+std::unique_ptr<Catalog::TableBuilder> RestCatalog::BuildTable(
+    const TableIdentifier& identifier, const Schema& schema) const {
+  throw IcebergError("not implemented");
+}
+
+bool RestCatalog::SupportsEndpoint(std::string_view endpoint) const {
+  return endpoints_.contains(std::string(endpoint));
+}
+
+Result<::iceberg::rest::PlanTableScanResponse> RestCatalog::PlanTableScan(
+    const TableIdentifier& identifier,
+    const ::iceberg::rest::PlanTableScanRequest& request,
+    const TableMetadata& metadata) {
+  ICEBERG_TRACE_SCOPE(trace, "Catalog::PlanTableScan");
+  ICEBERG_TRACE_ATTRIBUTE(trace, "table", identifier.name);
+  ICEBERG_ASSIGN_OR_RAISE(auto request_json, ::iceberg::rest::ToJson(request));
+  ICEBERG_ASSIGN_OR_RAISE(auto response, client_->Post(TableUrl(identifier) + "/plan",
+                                                       request_json.dump()));
+  ICEBERG_ASSIGN_OR_RAISE(auto json, ResponseJson(response, ResourceKind::kPlan));
+  return ::iceberg::rest::PlanTableScanResponseFromJson(json, metadata);
+}
+
+Result<::iceberg::rest::FetchPlanningResultResponse> RestCatalog::FetchPlanningResult(
+    const TableIdentifier& identifier, const std::string& plan_id,
+    const TableMetadata& metadata) {
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto response,
+      client_->Get(std::format("{}/plan/{}", TableUrl(identifier), UrlEncode(plan_id)),
+                   cpr::Parameters{}));
+  ICEBERG_ASSIGN_OR_RAISE(auto json, ResponseJson(response, ResourceKind::kPlan));
+  return ::iceberg::rest::PlanTableScanResponseFromJson(json, metadata);
+}
+
+Result<::iceberg::rest::FetchScanTasksResponse> RestCatalog::FetchScanTasks(
+    const TableIdentifier& identifier, const std::string& plan_task,
+    const TableMetadata& metadata) {
+  nlohmann::json request;
+  request["plan-task"] = plan_task;
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto response, client_->Post(TableUrl(identifier) + "/tasks", request.dump()));
+  ICEBERG_ASSIGN_OR_RAISE(auto json, ResponseJson(response, ResourceKind::kPlan));
+  return ::iceberg::rest::FetchScanTasksResponseFromJson(json, metadata);
+}
+
+Status RestCatalog::CancelPlanning(const TableIdentifier& identifier,
+                                   const std::string& plan_id) {
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto response,
+      client_->Delete(std::format("{}/plan/{}", TableUrl(identifier), UrlEncode(plan_id)),
+                      cpr::Parameters{}));
+  return ResponseStatus(response, ResourceKind::kPlan);
 }
 
-cpr::Response RestCatalog::ListNamespaces() {
-  cpr::Url url = cpr::Url{base_url_ + "/v1/namespaces"};
-  cpr::Response r = cpr::Get(url);
-  return r;
+Result<std::unique_ptr<Table>> RestCatalog::MakeTable(
+    TableIdentifier identifier, std::shared_ptr<TableMetadata> metadata,
+    std::string metadata_location) {
+  if (!config_.file_io) [[unlikely]] {
+    return InvalidArgument("file_io is not set for catalog {}", config_.name);
+  }
+  return std::make_unique<Table>(std::move(identifier), std::move(metadata),
+                                 std::move(metadata_location), config_.file_io,
+                                 std::static_pointer_cast<Catalog>(shared_from_this()));
 }
 
 }  // namespace iceberg::catalog::rest
@@ -1,40 +1,201 @@
-// Licensed to the Apache Software Foundation (ASF) under one
-// or more contributor license agreements.  See the NOTICE file
-// distributed with this work for additional information
-// regarding copyright ownership.  The ASF licenses this file
-// to you under the Apache License, Version 2.0 (the
-// "License"); you may not use this file except in compliance
-// with the License.  You may obtain a copy of the License at
-//
-//   http://www.apache.org/licenses/LICENSE-2.0
-//
-// Unless required by applicable law or agreed to in writing,
-// software distributed under the License is distributed on an
-// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
-// KIND, either express or implied.  See the License for the
-// specific language governing permissions and limitations
-// under the License.
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
 
 #pragma once
 
-#include <string>
+/// \file iceberg/catalog/rest/rest_catalog.h
+/// A catalog client of the Iceberg REST Catalog API.
 
-#include <cpr/cpr.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
+#include "iceberg/catalog.h"
+#include "iceberg/catalog/rest/http_client.h"
 #include "iceberg/catalog/rest/iceberg_rest_export.h"
+#include "iceberg/catalog/rest/types.h"
 
 namespace iceberg::catalog::rest {
 
-class ICEBERG_REST_EXPORT RestCatalog {
+/// \brief Configuration of a RestCatalog.
+struct ICEBERG_REST_EXPORT RestCatalogConfig {
+  /// \brief The name of the catalog.
+  std::string name = "rest";
+  /// \brief The base URI of the REST server, such as "http://localhost:8181".
+  std::string uri;
+  /// \brief The catalog properties. They take precedence over the defaults of the
+  /// server, and are overridden by the overrides of the server. The "warehouse"
+  /// property is sent to the server when fetching its configuration.
+  std::unordered_map<std::string, std::string> properties;
+  /// \brief The FileIO of the tables loaded from the catalog.
+  std::shared_ptr<FileIO> file_io;
+  /// \brief Options of the HTTP client shared by all requests of the catalog.
+  HttpClientOptions http_options;
+};
+
+/// \brief A catalog backed by a server implementing the Iceberg REST Catalog API.
+///
+/// All requests of the catalog go through one HttpClient, which reuses its connections
+/// to the server, so loading many tables does not pay for a new TCP and TLS handshake
+/// per request. The catalog is thread-safe, and concurrent requests run on separate
+/// connections.
+class ICEBERG_REST_EXPORT RestCatalog
+    : public Catalog,
+      public std::enable_shared_from_this<RestCatalog> {
  public:
-  explicit RestCatalog(const std::string& base_url);
-  ~RestCatalog() = default;
+  ~RestCatalog() override;
+
+  /// \brief Creates a catalog, fetching its configuration from the server.
+  ///
+  /// \param config The configuration of the catalog
+  /// \return The catalog, or an error if the configuration could not be fetched.
+  static Result<std::shared_ptr<RestCatalog>> Make(RestCatalogConfig config);
+
+  std::string_view name() const override;
+
+  /// \brief Returns the catalog properties merged with the configuration of the server.
+  const std::unordered_map<std::string, std::string>& properties() const {
+    return properties_;
+  }
+
+  Status CreateNamespace(
+      const Namespace& ns,
+      const std::unordered_map<std::string, std::string>& properties) override;
+
+  Result<std::vector<Namespace>> ListNamespaces(const Namespace& ns) const override;
+
+  Status DropNamespace(const Namespace& ns) override;
+
+  Result<bool> NamespaceExists(const Namespace& ns) const override;
+
+  Result<std::unordered_map<std::string, std::string>> GetNamespaceProperties(
+      const Namespace& ns) const override;
+
+  Status UpdateNamespaceProperties(
+      const Namespace& ns, const std::unordered_map<std::string, std::string>& updates,
+      const std::unordered_set<std::string>& removals) override;
+
+  Result<std::vector<TableIdentifier>> ListTables(const Namespace& ns) const override;
+
+  Result<std::unique_ptr<Table>> CreateTable(
+      const TableIdentifier& identifier, const Schema& schema, const PartitionSpec& spec,
+      const std::string& location,
+      const std::unordered_map<std::string, std::string>& properties) override;
 
-  cpr::Response GetConfig();
+  Result<std::unique_ptr<Table>> UpdateTable(
+      const TableIdentifier& identifier,
+      const std::vector<std::unique_ptr<TableRequirement>>& requirements,
+      const std::vector<std::unique_ptr<TableUpdate>>& updates) override;
 
-  cpr::Response ListNamespaces();
+  /// \brief Commits changes to several tables atomically, in one request.
+  ///
+  /// Either all changes are committed or none is. The requirements of every table are
+  /// validated by the server against its current metadata.
+  ///
+  /// \param request The changes of each table
+  /// \return Status indicating the outcome of the commit, ErrorKind::kCommitFailed if
+  /// a requirement does not hold, or ErrorKind::kCommitStateUnknown if the server failed
+  /// without telling whether the changes were committed.
+  Status CommitTransaction(const ::iceberg::rest::CommitTransactionRequest& request);
+
+  Result<std::shared_ptr<Transaction>> StageCreateTable(
+      const TableIdentifier& identifier, const Schema& schema, const PartitionSpec& spec,
+      const std::string& location,
+      const std::unordered_map<std::string, std::string>& properties) override;
+
+  Result<bool> TableExists(const TableIdentifier& identifier) const override;
+
+  Status DropTable(const TableIdentifier& identifier, bool purge) override;
+
+  Result<std::unique_ptr<Table>> LoadTable(const TableIdentifier& identifier) override;
+
+  /// \brief Loads several tables with concurrent requests.
+  ///
+  /// \param identifiers The tables to load
+  /// \param parallelism The maximum number of concurrent requests
+  /// \param executor The executor of the requests, the DefaultExecutor() if null
+  /// \return The result of LoadTable() for each identifier, in the same order.
+  std::vector<Result<std::unique_ptr<Table>>> LoadTables(
+      const std::vector<TableIdentifier>& identifiers, int32_t parallelism = 8,
+      std::shared_ptr<Executor> executor = nullptr);
+
+  Result<std::shared_ptr<Table>> RegisterTable(
+      const TableIdentifier& identifier,
+      const std::string& metadata_file_location) override;
+
+  std::unique_ptr<TableBuilder> BuildTable(const TableIdentifier& identifier,
+                                           const Schema& schema) const override;
+
+  /// \brief Returns whether the server advertises an endpoint in its configuration,
+  /// such as "POST /v1/{prefix}/namespaces/{namespace}/tables/{table}/plan".
+  bool SupportsEndpoint(std::string_view endpoint) const;
+
+  /// \brief Starts planning a scan of a table on the server.
+  ///
+  /// \param identifier The table to scan
+  /// \param request The snapshot, columns and filter of the scan
+  /// \param metadata The metadata of the table, to parse the planned files with
+  /// \return The plan, either completed with its first scan tasks or submitted to be
+  /// polled with FetchPlanningResult(). NotSupported if the filter has no REST
+  /// representation or the server does not plan scans.
+  Result<::iceberg::rest::PlanTableScanResponse> PlanTableScan(
+      const TableIdentifier& identifier,
+      const ::iceberg::rest::PlanTableScanRequest& request,
+      const TableMetadata& metadata);
+
+  /// \brief Fetches the state of a submitted scan plan.
+  Result<::iceberg::rest::FetchPlanningResultResponse> FetchPlanningResult(
+      const TableIdentifier& identifier, const std::string& plan_id,
+      const TableMetadata& metadata);
+
+  /// \brief Fetches the scan tasks of a plan task returned by the server.
+  Result<::iceberg::rest::FetchScanTasksResponse> FetchScanTasks(
+      const TableIdentifier& identifier, const std::string& plan_task,
+      const TableMetadata& metadata);
+
+  /// \brief Cancels a scan plan, releasing its resources on the server.
+  Status CancelPlanning(const TableIdentifier& identifier, const std::string& plan_id);
 
  private:
+  RestCatalog(RestCatalogConfig config, std::unique_ptr<HttpClient> client,
+              std::unordered_map<std::string, std::string> properties,
+              std::vector<std::string> endpoints);
+
+  std::string NamespacesUrl() const;
+  std::string NamespaceUrl(const Namespace& ns) const;
+  std::string TablesUrl(const Namespace& ns) const;
+  std::string TableUrl(const TableIdentifier& identifier) const;
+
+  Result<std::unique_ptr<Table>> MakeTable(TableIdentifier identifier,
+                                           std::shared_ptr<TableMetadata> metadata,
+                                           std::string metadata_location);
+
+  RestCatalogConfig config_;
+  std::unique_ptr<HttpClient> client_;
+  std::unordered_map<std::string, std::string> properties_;
+  /// \brief The endpoints advertised by the server.
+  std::unordered_set<std::string> endpoints_;
+  /// \brief The base URL of the catalog endpoints, including the server prefix.
   std::string base_url_;
 };
 
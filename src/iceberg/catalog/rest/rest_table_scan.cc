@@ -0,0 +1,214 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/catalog/rest/rest_table_scan.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "iceberg/deletes/delete_loader.h"
+#include "iceberg/executor.h"
+#include "iceberg/expression/residual_evaluator.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg::catalog::rest {
+
+namespace {
+
+constexpr std::string_view kCompleted = "completed";
+constexpr std::string_view kSubmitted = "submitted";
+constexpr auto kInitialPollDelay = std::chrono::milliseconds(10);
+constexpr auto kMaxPollDelay = std::chrono::seconds(1);
+
+/// \brief Returns whether an error tells that the server cannot plan the scan.
+bool IsUnsupported(const Error& error) {
+  return error.kind == ErrorKind::kNotSupported ||
+         error.kind == ErrorKind::kNotImplemented;
+}
+
+/// \brief Converts the scan tasks returned by the server to file scan tasks.
+class FileScanTaskConverter {
+ public:
+  FileScanTaskConverter(const TableScanContext& context, std::shared_ptr<FileIO> io,
+                        std::shared_ptr<Schema> schema)
+      : context_(context), io_(std::move(io)), schema_(std::move(schema)) {}
+
+  /// \brief Passes the file scan tasks to the callback, skipping the files whose
+  /// partition cannot match the filter.
+  Status Convert(const ::iceberg::rest::ScanTasks& tasks,
+                 const TableScan::FileScanTaskCallback& callback) {
+    for (const auto& task : tasks.file_scan_tasks) {
+      std::shared_ptr<Expression> residual;
+      if (context_.filter != nullptr) {
+        ICEBERG_ASSIGN_OR_RAISE(auto evaluator,
+                                ResidualEvaluatorFor(task.data_file->partition_spec_id));
+        ICEBERG_ASSIGN_OR_RAISE(residual,
+                                evaluator->ResidualFor(task.data_file->partition));
+        if (residual->op() == Expression::Operation::kFalse) {
+          continue;
+        }
+      }
+      std::vector<std::shared_ptr<DataFile>> deletes;
+      deletes.reserve(task.delete_file_references.size());
+      for (int32_t reference : task.delete_file_references) {
+        deletes.push_back(tasks.delete_files[reference]);
+      }
+      std::shared_ptr<DeleteLoader> delete_loader;
+      if (!deletes.empty()) {
+        // The tasks of the scan share one loader, so every delete file is read once.
+        if (delete_loader_ == nullptr) {
+          delete_loader_ =
+              std::make_shared<DeleteLoader>(io_, schema_, context_.memory_pool);
+        }
+        delete_loader = delete_loader_;
+      }
+      ICEBERG_RETURN_UNEXPECTED(callback(std::make_shared<FileScanTask>(
+          task.data_file, std::move(deletes), std::move(delete_loader),
+          std::move(residual), context_.memory_pool, context_.executor,
+          context_.io_executor)));
+    }
+    return {};
+  }
+
+ private:
+  Result<const ResidualEvaluator*> ResidualEvaluatorFor(int32_t spec_id) {
+    auto it = residual_evaluators_.find(spec_id);
+    if (it == residual_evaluators_.end()) {
+      ICEBERG_ASSIGN_OR_RAISE(auto spec,
+                              context_.table_metadata->PartitionSpecById(spec_id));
+      ICEBERG_ASSIGN_OR_RAISE(
+          auto evaluator,
+          ResidualEvaluator::Make(context_.filter, std::move(spec),
+                                  context_.case_sensitive));
+      it = residual_evaluators_.emplace(spec_id, std::move(evaluator)).first;
+    }
+    return it->second.get();
+  }
+
+  const TableScanContext& context_;
+  std::shared_ptr<FileIO> io_;
+  std::shared_ptr<Schema> schema_;
+  std::shared_ptr<DeleteLoader> delete_loader_;
+  std::unordered_map<int32_t, std::unique_ptr<ResidualEvaluator>> residual_evaluators_;
+};
+
+}  // namespace
+
+RestTableScan::RestTableScan(std::shared_ptr<RestCatalog> catalog,
+                             TableIdentifier identifier,
+                             std::unique_ptr<TableScan> local_scan)
+    : TableScan(local_scan->context(), local_scan->io()),
+      catalog_(std::move(catalog)),
+      identifier_(std::move(identifier)),
+      local_scan_(std::move(local_scan)) {}
+
+Status RestTableScan::PlanFiles(const FileScanTaskCallback& callback) const {
+  if (context_.snapshot == nullptr) {
+    return {};
+  }
+  if (!catalog_->SupportsEndpoint(kPlanEndpoint) ||
+      !catalog_->SupportsEndpoint(kTasksEndpoint)) {
+    return local_scan_->PlanFiles(callback);
+  }
+
+  ::iceberg::rest::PlanTableScanRequest request{
+      .filter = context_.filter, .case_sensitive = context_.case_sensitive};
+  if (context_.from_snapshot_id.has_value()) {
+    request.start_snapshot_id = context_.from_snapshot_id;
+    request.end_snapshot_id = context_.snapshot->snapshot_id;
+  } else {
+    request.snapshot_id = context_.snapshot->snapshot_id;
+  }
+  for (const auto& field : context_.projected_schema->fields()) {
+    request.select.emplace_back(field.name());
+  }
+
+  auto response = catalog_->PlanTableScan(identifier_, request, *context_.table_metadata);
+  if (!response.has_value() && IsUnsupported(response.error())) {
+    return local_scan_->PlanFiles(callback);
+  }
+  ICEBERG_RETURN_UNEXPECTED(response);
+
+  const std::string plan_id = response->plan_id;
+  auto status = PlanServerTasks(std::move(response.value()), callback);
+  if (!status.has_value() && !plan_id.empty()) {
+    // Release the plan on the server, the error of the scan takes precedence.
+    std::ignore = catalog_->CancelPlanning(identifier_, plan_id);
+  }
+  return status;
+}
+
+Status RestTableScan::PlanServerTasks(::iceberg::rest::PlanTableScanResponse response,
+                                      const FileScanTaskCallback& callback) const {
+  const auto& metadata = *context_.table_metadata;
+  auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(kInitialPollDelay);
+  while (response.plan_status == kSubmitted) {
+    std::this_thread::sleep_for(delay);
+    delay = std::min(delay * 2, std::chrono::milliseconds(kMaxPollDelay));
+    ICEBERG_ASSIGN_OR_RAISE(
+        response, catalog_->FetchPlanningResult(identifier_, response.plan_id, metadata));
+  }
+  if (response.plan_status != kCompleted) {
+    return IOError("Scan planning of table {} ended with status {}", identifier_.name,
+                   response.plan_status);
+  }
+
+  ICEBERG_ASSIGN_OR_RAISE(auto schema,
+                          metadata.SchemaById(context_.snapshot->schema_id
+                                                  ? context_.snapshot->schema_id
+                                                  : metadata.current_schema_id));
+  FileScanTaskConverter converter(context_, file_io_, std::move(schema));
+  ICEBERG_RETURN_UNEXPECTED(converter.Convert(response.tasks, callback));
+
+  // Plan tasks are fetched in batches of concurrent requests, and the tasks of a batch
+  // are passed to the callback in order once all of its requests are done.
+  auto& executor = context_.executor != nullptr ? *context_.executor : *DefaultExecutor();
+  const auto parallelism = std::max(context_.planning_parallelism, 1);
+  std::vector<std::string> plan_tasks = std::move(response.tasks.plan_tasks);
+  for (size_t next = 0; next < plan_tasks.size();) {
+    const size_t count =
+        std::min(plan_tasks.size() - next, static_cast<size_t>(parallelism));
+    std::vector<::iceberg::rest::FetchScanTasksResponse> pages(count);
+    ICEBERG_RETURN_UNEXPECTED(
+        RunInParallel(executor, count, parallelism, [&](size_t index) -> Status {
+          ICEBERG_ASSIGN_OR_RAISE(
+              pages[index],
+              catalog_->FetchScanTasks(identifier_, plan_tasks[next + index], metadata));
+          return {};
+        }));
+    next += count;
+    for (auto& page : pages) {
+      ICEBERG_RETURN_UNEXPECTED(converter.Convert(page, callback));
+      std::ranges::move(page.plan_tasks, std::back_inserter(plan_tasks));
+    }
+  }
+  return {};
+}
+
+}  // namespace iceberg::catalog::rest
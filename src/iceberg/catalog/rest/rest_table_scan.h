@@ -0,0 +1,80 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/catalog/rest/rest_table_scan.h
+/// A table scan planned by the server of a REST catalog.
+
+#include <memory>
+#include <string_view>
+
+#include "iceberg/catalog/rest/iceberg_rest_export.h"
+#include "iceberg/catalog/rest/rest_catalog.h"
+#include "iceberg/table_identifier.h"
+#include "iceberg/table_scan.h"
+
+namespace iceberg::catalog::rest {
+
+/// \brief A scan whose files are planned by the server of a REST catalog.
+///
+/// The snapshot, projected columns and filter of the scan are sent to the plan
+/// endpoint of the table, and a plan submitted for asynchronous planning is polled
+/// until the server completes it. The plan tasks returned with a plan are fetched
+/// from the tasks endpoint with concurrent requests, up to the planning parallelism
+/// of the scan on its executor, and the plan tasks they return are fetched in turn.
+/// The residual filter of each planned file is computed from its partition like in a
+/// locally planned scan.
+///
+/// The scan is planned locally by the scan it wraps when the server does not advertise
+/// both endpoints, rejects the request as not supported, or when the filter has no REST
+/// representation.
+class ICEBERG_REST_EXPORT RestTableScan : public TableScan {
+ public:
+  /// \brief The endpoint starting the planning of a scan.
+  static constexpr std::string_view kPlanEndpoint =
+      "POST /v1/{prefix}/namespaces/{namespace}/tables/{table}/plan";
+  /// \brief The endpoint fetching the scan tasks of a plan task.
+  static constexpr std::string_view kTasksEndpoint =
+      "POST /v1/{prefix}/namespaces/{namespace}/tables/{table}/tasks";
+
+  /// \brief Constructs a scan planned by the server.
+  ///
+  /// \param catalog The catalog of the scanned table
+  /// \param identifier The identifier of the scanned table
+  /// \param local_scan The scan of the table planned locally when the server cannot
+  /// plan it, whose context and FileIO are shared by this scan
+  RestTableScan(std::shared_ptr<RestCatalog> catalog, TableIdentifier identifier,
+                std::unique_ptr<TableScan> local_scan);
+
+  using TableScan::PlanFiles;
+
+  Status PlanFiles(const FileScanTaskCallback& callback) const override;
+
+ private:
+  /// \brief Passes the tasks of a plan and of its plan tasks to the callback.
+  Status PlanServerTasks(::iceberg::rest::PlanTableScanResponse response,
+                         const FileScanTaskCallback& callback) const;
+
+  std::shared_ptr<RestCatalog> catalog_;
+  TableIdentifier identifier_;
+  std::unique_ptr<TableScan> local_scan_;
+};
+
+}  // namespace iceberg::catalog::rest
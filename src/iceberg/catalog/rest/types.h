@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -27,6 +28,8 @@
 
 #include "iceberg/catalog/rest/iceberg_rest_export.h"
 #include "iceberg/table_identifier.h"
+#include "iceberg/table_requirement.h"
+#include "iceberg/table_update.h"
 #include "iceberg/type_fwd.h"
 
 /// \file iceberg/catalog/rest/types.h
@@ -34,6 +37,23 @@
 
 namespace iceberg::rest {
 
+/// \brief Server-provided configuration for the catalog.
+struct ICEBERG_REST_EXPORT CatalogConfig {
+  /// \brief Properties used as defaults for the catalog properties.
+  std::unordered_map<std::string, std::string> defaults;
+  /// \brief Properties that override the catalog properties.
+  std::unordered_map<std::string, std::string> overrides;
+  /// \brief Endpoints supported by the server, such as "GET /v1/{prefix}/namespaces".
+  std::vector<std::string> endpoints;
+};
+
+/// \brief Error returned by the server.
+struct ICEBERG_REST_EXPORT ErrorResponse {
+  std::string message;  // required
+  std::string type;     // required
+  int32_t code = 0;     // required
+};
+
 /// \brief Request to create a namespace.
 struct ICEBERG_REST_EXPORT CreateNamespaceRequest {
   Namespace namespace_;  // required
@@ -70,13 +90,71 @@ struct ICEBERG_REST_EXPORT RenameTableRequest {
   TableIdentifier destination;  // required
 };
 
+/// \brief Request to commit changes to a table.
+struct ICEBERG_REST_EXPORT CommitTableRequest {
+  TableIdentifier identifier;                                   // required
+  std::vector<std::unique_ptr<TableRequirement>> requirements;  // required
+  std::vector<std::unique_ptr<TableUpdate>> updates;            // required
+};
+
+/// \brief Request to commit changes to several tables atomically.
+struct ICEBERG_REST_EXPORT CommitTransactionRequest {
+  std::vector<CommitTableRequest> table_changes;  // required
+};
+
+/// \brief Request to plan a scan of a table on the server.
+struct ICEBERG_REST_EXPORT PlanTableScanRequest {
+  /// \brief The snapshot to scan, the current snapshot if unset.
+  std::optional<int64_t> snapshot_id;
+  /// \brief The names of the columns to read, all columns if empty.
+  std::vector<std::string> select;
+  /// \brief The filter of the rows to read, all rows if null.
+  std::shared_ptr<Expression> filter;
+  bool case_sensitive = true;
+  /// \brief With `end_snapshot_id`, plans the data files appended after this snapshot.
+  std::optional<int64_t> start_snapshot_id;
+  std::optional<int64_t> end_snapshot_id;
+};
+
+/// \brief A data file to scan, with the delete files to apply to it.
+struct ICEBERG_REST_EXPORT RestFileScanTask {
+  std::shared_ptr<DataFile> data_file;  // required
+  /// \brief Positions of the delete files of the task in `ScanTasks::delete_files`.
+  std::vector<int32_t> delete_file_references;
+};
+
+/// \brief Scan tasks returned by the server for a plan or a plan task.
+struct ICEBERG_REST_EXPORT ScanTasks {
+  /// \brief The delete files referenced by the file scan tasks.
+  std::vector<std::shared_ptr<DataFile>> delete_files;
+  std::vector<RestFileScanTask> file_scan_tasks;
+  /// \brief Opaque tokens to fetch the remaining scan tasks with.
+  std::vector<std::string> plan_tasks;
+};
+
+/// \brief Response body of a scan planning request.
+struct ICEBERG_REST_EXPORT PlanTableScanResponse {
+  /// \brief One of "completed", "submitted", "cancelled" or "failed".
+  std::string plan_status;  // required
+  /// \brief The plan to poll while its status is "submitted".
+  std::string plan_id;
+  /// \brief The scan tasks of a completed plan.
+  ScanTasks tasks;
+};
+
+/// \brief Alias of PlanTableScanResponse used as the body of a planning result.
+using FetchPlanningResultResponse = PlanTableScanResponse;
+
+/// \brief Alias of ScanTasks used as the body of FetchScanTasksResponse.
+using FetchScanTasksResponse = ScanTasks;
+
 /// \brief An opaque token that allows clients to make use of pagination for list APIs.
 using PageToken = std::string;
 
 /// \brief Result body for table create/load/register APIs.
 struct ICEBERG_REST_EXPORT LoadTableResult {
   std::optional<std::string> metadata_location;
-  std::shared_ptr<TableMetadata> metadata;  // required  // required
+  std::shared_ptr<TableMetadata> metadata;  // required
   std::unordered_map<std::string, std::string> config;
   // TODO(Li Feiyang): Add std::shared_ptr<StorageCredential> storage_credential;
 };
@@ -112,6 +190,12 @@ struct ICEBERG_REST_EXPORT UpdateNamespacePropertiesResponse {
   std::vector<std::string> missing;
 };
 
+/// \brief Response body after committing table changes.
+struct ICEBERG_REST_EXPORT CommitTableResponse {
+  std::string metadata_location;            // required
+  std::shared_ptr<TableMetadata> metadata;  // required
+};
+
 /// \brief Response body for listing tables in a namespace.
 struct ICEBERG_REST_EXPORT ListTablesResponse {
   PageToken next_page_token;
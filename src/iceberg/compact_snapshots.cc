@@ -0,0 +1,112 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/compact_snapshots.h"
+
+#include <nlohmann/json.hpp>
+
+#include "iceberg/json_internal.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+CompactSnapshots::CompactSnapshots() : json_offsets_{0} {}
+
+CompactSnapshots::~CompactSnapshots() = default;
+
+void CompactSnapshots::Append(int64_t snapshot_id,
+                              std::optional<int64_t> parent_snapshot_id,
+                              TimePointMs timestamp_ms, std::string_view json) {
+  positions_.emplace(snapshot_id, snapshot_ids_.size());
+  snapshot_ids_.push_back(snapshot_id);
+  parent_snapshot_ids_.push_back(parent_snapshot_id);
+  timestamps_ms_.push_back(timestamp_ms);
+  json_.append(json);
+  json_offsets_.push_back(json_.size());
+  snapshots_.emplace_back();
+}
+
+std::optional<size_t> CompactSnapshots::Find(int64_t snapshot_id) const {
+  auto it = positions_.find(snapshot_id);
+  if (it == positions_.cend()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+std::string_view CompactSnapshots::json(size_t pos) const {
+  return std::string_view(json_).substr(json_offsets_[pos],
+                                        json_offsets_[pos + 1] - json_offsets_[pos]);
+}
+
+Result<std::shared_ptr<Snapshot>> CompactSnapshots::At(size_t pos) const {
+  if (pos >= size()) {
+    return InvalidArgument("Snapshot position {} is out of range [0, {})", pos, size());
+  }
+  {
+    std::lock_guard lock(mutex_);
+    if (snapshots_[pos] != nullptr) {
+      return snapshots_[pos];
+    }
+  }
+  auto snapshot_json = nlohmann::json::parse(json(pos), /*cb=*/nullptr,
+                                             /*allow_exceptions=*/false);
+  if (snapshot_json.is_discarded()) [[unlikely]] {
+    return JsonParseError("Failed to parse snapshot {}", snapshot_ids_[pos]);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(std::shared_ptr<Snapshot> snapshot,
+                          SnapshotFromJson(snapshot_json));
+
+  std::lock_guard lock(mutex_);
+  // Keep the snapshot materialized by a concurrent call, if any.
+  if (snapshots_[pos] == nullptr) {
+    snapshots_[pos] = std::move(snapshot);
+  }
+  return snapshots_[pos];
+}
+
+Result<std::shared_ptr<Snapshot>> CompactSnapshots::Get(int64_t snapshot_id) const {
+  auto pos = Find(snapshot_id);
+  if (!pos.has_value()) {
+    return NotFound("Snapshot with ID {} is not found", snapshot_id);
+  }
+  return At(pos.value());
+}
+
+Result<std::reference_wrapper<const PersistentVector<std::shared_ptr<Snapshot>>>>
+CompactSnapshots::All() const {
+  {
+    std::lock_guard lock(mutex_);
+    if (all_materialized_) {
+      return std::cref(all_);
+    }
+  }
+  for (size_t pos = 0; pos < size(); ++pos) {
+    ICEBERG_RETURN_UNEXPECTED(At(pos));
+  }
+  std::lock_guard lock(mutex_);
+  if (!all_materialized_) {
+    all_ = snapshots_;
+    all_materialized_ = true;
+  }
+  return std::cref(all_);
+}
+
+}  // namespace iceberg
@@ -0,0 +1,125 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/compact_snapshots.h
+/// Snapshots of table metadata kept in a compact form and materialized on demand.
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+#include "iceberg/util/persistent_vector.h"
+#include "iceberg/util/timepoint.h"
+
+namespace iceberg {
+
+/// \brief The snapshots of a table, kept in a compact columnar form.
+///
+/// Tables with long histories have tens of thousands of snapshots, while most readers
+/// only use the current one. The ids, parent ids and timestamps of the snapshots are
+/// kept in columns, indexed by snapshot id, and the other fields in the JSON text of
+/// each snapshot. A Snapshot object is only materialized when it is requested, and
+/// then reused by later requests.
+///
+/// The snapshots cannot be changed once added, and can be read concurrently.
+class ICEBERG_EXPORT CompactSnapshots {
+ public:
+  CompactSnapshots();
+  ~CompactSnapshots();
+
+  CompactSnapshots(const CompactSnapshots&) = delete;
+  CompactSnapshots& operator=(const CompactSnapshots&) = delete;
+
+  /// \brief Adds a snapshot.
+  ///
+  /// \param snapshot_id The id of the snapshot
+  /// \param parent_snapshot_id The id of the parent of the snapshot, if any
+  /// \param timestamp_ms The timestamp of the snapshot
+  /// \param json The JSON text of the snapshot, which must deserialize to a snapshot
+  /// with the same id, parent id and timestamp
+  void Append(int64_t snapshot_id, std::optional<int64_t> parent_snapshot_id,
+              TimePointMs timestamp_ms, std::string_view json);
+
+  /// \brief The number of snapshots.
+  size_t size() const { return snapshot_ids_.size(); }
+
+  /// \brief Whether there are no snapshots.
+  bool empty() const { return snapshot_ids_.empty(); }
+
+  /// \brief Returns the position of a snapshot, or nullopt if there is no such
+  /// snapshot.
+  std::optional<size_t> Find(int64_t snapshot_id) const;
+
+  /// \brief The id of the snapshot at a position.
+  int64_t snapshot_id(size_t pos) const { return snapshot_ids_[pos]; }
+
+  /// \brief The id of the parent of the snapshot at a position.
+  std::optional<int64_t> parent_snapshot_id(size_t pos) const {
+    return parent_snapshot_ids_[pos];
+  }
+
+  /// \brief The timestamp of the snapshot at a position.
+  TimePointMs timestamp_ms(size_t pos) const { return timestamps_ms_[pos]; }
+
+  /// \brief The JSON text of the snapshot at a position.
+  std::string_view json(size_t pos) const;
+
+  /// \brief Returns the snapshot at a position, materializing it on first use.
+  Result<std::shared_ptr<Snapshot>> At(size_t pos) const;
+
+  /// \brief Returns the snapshot with the given id, materializing it on first use.
+  ///
+  /// \return The snapshot, or NotFound if there is no such snapshot.
+  Result<std::shared_ptr<Snapshot>> Get(int64_t snapshot_id) const;
+
+  /// \brief Returns all snapshots in the order they were added, materializing them on
+  /// first use.
+  Result<std::reference_wrapper<const PersistentVector<std::shared_ptr<Snapshot>>>>
+  All() const;
+
+ private:
+  std::vector<int64_t> snapshot_ids_;
+  std::vector<std::optional<int64_t>> parent_snapshot_ids_;
+  std::vector<TimePointMs> timestamps_ms_;
+  /// \brief The JSON texts of the snapshots, one after the other.
+  std::string json_;
+  /// \brief The offsets of the JSON texts in `json_`, followed by its size.
+  std::vector<size_t> json_offsets_;
+  std::unordered_map<int64_t, size_t> positions_;
+
+  mutable std::mutex mutex_;
+  /// \brief The materialized snapshots, or null for those not materialized yet.
+  mutable std::vector<std::shared_ptr<Snapshot>> snapshots_;
+  mutable bool all_materialized_ = false;
+  /// \brief All snapshots, once they are all materialized.
+  mutable PersistentVector<std::shared_ptr<Snapshot>> all_;
+};
+
+}  // namespace iceberg
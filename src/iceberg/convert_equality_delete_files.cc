@@ -0,0 +1,393 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/convert_equality_delete_files.h"
+
+#include <algorithm>
+#include <format>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <nanoarrow/nanoarrow.h>
+
+#include "iceberg/arrow_c_data.h"
+#include "iceberg/arrow_c_data_guard_internal.h"
+#include "iceberg/deletes/delete_loader.h"
+#include "iceberg/deletes/equality_delete_set.h"
+#include "iceberg/deletes/position_delete_writer.h"
+#include "iceberg/executor.h"
+#include "iceberg/file_format.h"
+#include "iceberg/file_io.h"
+#include "iceberg/file_reader.h"
+#include "iceberg/location_provider.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/metadata_columns.h"
+#include "iceberg/partition_map.h"
+#include "iceberg/rewrite_data_files.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/table_properties.h"
+#include "iceberg/table_scan.h"
+#include "iceberg/type.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/macros.h"
+#include "iceberg/util/uuid.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief Estimated bytes of a deleted row of an equality delete set besides its key:
+/// its offset, its hash and its slots in the hash table.
+constexpr int64_t kDeleteOverheadBytes = 32;
+/// \brief Estimated bytes of a variable-length value of a key.
+constexpr int64_t kVariableValueBytes = 32;
+
+/// \brief A data file with equality deletes and the delete files that apply to it.
+struct DataFileDeletes {
+  std::shared_ptr<DataFile> data_file;
+  std::vector<std::shared_ptr<DataFile>> position_deletes;
+  std::vector<std::shared_ptr<DataFile>> equality_deletes;
+};
+
+/// \brief The data files of a partition whose equality deletes are converted together.
+struct PartitionGroup {
+  int32_t spec_id = 0;
+  std::vector<Literal> partition;
+  std::vector<DataFileDeletes> files;
+  // Paths of the files, as the scan may split a file into several tasks
+  std::unordered_set<std::string> paths;
+  // Paths of the equality delete files that apply to the files
+  std::unordered_set<std::string> equality_delete_paths;
+  int64_t estimated_bytes = 0;
+};
+
+/// \brief Estimates the memory of the rows of an equality delete file once loaded.
+int64_t EstimateEqualityDeleteBytes(const Schema& schema, const DataFile& delete_file) {
+  int64_t key_bytes = 0;
+  for (int32_t field_id : delete_file.equality_ids) {
+    // Each value is preceded by a null marker.
+    key_bytes += 1;
+    auto field = schema.FindFieldById(field_id);
+    if (!field.has_value() || !field.value().has_value()) {
+      key_bytes += kVariableValueBytes;
+      continue;
+    }
+    switch (const auto& type = field.value()->get().type(); type->type_id()) {
+      case TypeId::kBoolean:
+        key_bytes += 1;
+        break;
+      case TypeId::kInt:
+      case TypeId::kFloat:
+      case TypeId::kDate:
+        key_bytes += 4;
+        break;
+      case TypeId::kDecimal:
+      case TypeId::kUuid:
+        key_bytes += 16;
+        break;
+      case TypeId::kFixed:
+        key_bytes += internal::checked_cast<const FixedType&>(*type).length();
+        break;
+      case TypeId::kString:
+      case TypeId::kBinary:
+        key_bytes += kVariableValueBytes;
+        break;
+      default:
+        key_bytes += 8;
+        break;
+    }
+  }
+  return delete_file.record_count * (key_bytes + kDeleteOverheadBytes);
+}
+
+/// \brief Writes the positions of the rows of a data file matching its equality
+/// deletes, skipping the rows deleted by its position deletes.
+Status ConvertDataFile(const DataFileDeletes& file, const std::shared_ptr<FileIO>& io,
+                       const Schema& table_schema, DeleteLoader& loader,
+                       PositionDeleteWriter& writer) {
+  const auto& data_file = *file.data_file;
+  std::shared_ptr<const PositionDeleteIndex> position_deletes;
+  if (!file.position_deletes.empty()) {
+    ICEBERG_ASSIGN_OR_RAISE(position_deletes, loader.LoadPositionDeletes(
+                                                  file.position_deletes,
+                                                  data_file.file_path));
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto equality_deletes,
+                          loader.LoadEqualityDeletes(file.equality_deletes));
+
+  // Only the equality fields and the positions of the rows are read.
+  std::unordered_set<int32_t> field_ids;
+  for (const auto& deletes : equality_deletes) {
+    field_ids.insert(deletes->equality_field_ids().begin(),
+                     deletes->equality_field_ids().end());
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto equality_fields, table_schema.Project(field_ids));
+  auto fields = equality_fields->fields();
+  std::vector<SchemaField> projected_fields(fields.begin(), fields.end());
+  projected_fields.push_back(MetadataColumns::kRowPosition);
+  const size_t position_column = projected_fields.size() - 1;
+  auto projection = std::make_shared<Schema>(std::move(projected_fields));
+
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto reader,
+      ReaderFactoryRegistry::Open(
+          data_file.file_format,
+          {.path = data_file.file_path,
+           .length = static_cast<size_t>(data_file.file_size_in_bytes),
+           .io = io,
+           .projection = projection,
+           .position_deletes = std::move(position_deletes),
+           .metadata_columns = {.spec_id = data_file.partition_spec_id}}));
+  ICEBERG_ASSIGN_OR_RAISE(auto arrow_schema, reader->Schema());
+  internal::ArrowSchemaGuard schema_guard(&arrow_schema);
+  std::vector<uint8_t> selection;
+  while (true) {
+    ICEBERG_ASSIGN_OR_RAISE(auto batch, reader->Next());
+    if (!batch.has_value()) {
+      break;
+    }
+    internal::ArrowArrayGuard array_guard(&batch.value());
+    const ArrowArray& array = batch.value();
+    if (array.n_children <= static_cast<int64_t>(position_column) ||
+        std::string_view(arrow_schema.children[position_column]->format) != "l") {
+      return InvalidArrowData("Expected the row positions of {} in column {}",
+                              data_file.file_path, position_column);
+    }
+
+    selection.assign((array.length + 7) / 8, 0xFF);
+    for (const auto& deletes : equality_deletes) {
+      ICEBERG_RETURN_UNEXPECTED(
+          deletes->RemoveDeleted(*projection, arrow_schema, array, selection));
+    }
+    const ArrowArray* positions = array.children[position_column];
+    const auto* values = static_cast<const int64_t*>(positions->buffers[1]) +
+                         positions->offset + array.offset;
+    for (int64_t row = 0; row < array.length; ++row) {
+      if ((selection[row / 8] & (1 << (row % 8))) == 0) {
+        ICEBERG_RETURN_UNEXPECTED(writer.Delete(data_file.file_path, values[row]));
+      }
+    }
+  }
+  return reader->Close();
+}
+
+}  // namespace
+
+ConvertEqualityDeleteFiles::ConvertEqualityDeleteFiles(std::shared_ptr<Table> table)
+    : table_(std::move(table)) {}
+
+ConvertEqualityDeleteFiles::~ConvertEqualityDeleteFiles() = default;
+
+ConvertEqualityDeleteFiles& ConvertEqualityDeleteFiles::WithParallelism(
+    int32_t parallelism) {
+  parallelism_ = parallelism;
+  return *this;
+}
+
+ConvertEqualityDeleteFiles& ConvertEqualityDeleteFiles::WithExecutor(
+    std::shared_ptr<Executor> executor) {
+  executor_ = std::move(executor);
+  return *this;
+}
+
+ConvertEqualityDeleteFiles& ConvertEqualityDeleteFiles::MaxMemory(int64_t bytes) {
+  max_memory_ = bytes;
+  return *this;
+}
+
+ConvertEqualityDeleteFiles& ConvertEqualityDeleteFiles::WithLocationProvider(
+    std::shared_ptr<LocationProvider> provider) {
+  location_provider_ = std::move(provider);
+  return *this;
+}
+
+Result<ConvertEqualityDeleteFilesResult> ConvertEqualityDeleteFiles::Execute() const {
+  if (parallelism_ < 1) {
+    return InvalidArgument("Parallelism must be positive, got {}", parallelism_);
+  }
+  if (max_memory_ <= 0) {
+    return InvalidArgument("Maximum memory must be positive, got {}", max_memory_);
+  }
+
+  const auto metadata = table_->metadata();
+  const auto& io = table_->io();
+  const auto& properties = table_->properties();
+  const auto executor = executor_ != nullptr ? executor_ : DefaultExecutor();
+  ConvertEqualityDeleteFilesResult result;
+  if (metadata->current_snapshot_id == Snapshot::kInvalidSnapshotId ||
+      metadata->format_version < 2) {
+    return result;
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto snapshot, metadata->Snapshot());
+  ICEBERG_ASSIGN_OR_RAISE(auto schema, metadata->Schema());
+
+  // Group the data files with equality deletes by partition. All live data files are
+  // planned, so every file an equality delete file applies to is in a group.
+  TableScanBuilder builder(metadata, io);
+  builder.WithSnapshotId(snapshot->snapshot_id).WithExecutor(executor);
+  ICEBERG_ASSIGN_OR_RAISE(auto scan, builder.Build());
+  PartitionMap<PartitionGroup> partitions;
+  std::unordered_map<std::string, std::shared_ptr<DataFile>> equality_delete_files;
+  ICEBERG_RETURN_UNEXPECTED(
+      scan->PlanFiles([&](std::shared_ptr<FileScanTask> task) -> Status {
+        const auto& data_file = task->data_file();
+        DataFileDeletes file{.data_file = data_file};
+        for (const auto& delete_file : task->delete_files()) {
+          if (delete_file->content == DataFile::Content::kEqualityDeletes) {
+            file.equality_deletes.push_back(delete_file);
+          } else {
+            file.position_deletes.push_back(delete_file);
+          }
+        }
+        if (file.equality_deletes.empty()) {
+          return {};
+        }
+        ICEBERG_ASSIGN_OR_RAISE(auto key, PartitionTupleKey::Make(
+                                              data_file->partition_spec_id,
+                                              data_file->partition));
+        auto [group, inserted] = partitions.TryEmplace(std::move(key));
+        if (inserted) {
+          group->spec_id = data_file->partition_spec_id;
+          group->partition = data_file->partition;
+        }
+        if (!group->paths.insert(data_file->file_path).second) {
+          return {};
+        }
+        for (const auto& delete_file : file.equality_deletes) {
+          if (group->equality_delete_paths.insert(delete_file->file_path).second) {
+            group->estimated_bytes += EstimateEqualityDeleteBytes(*schema, *delete_file);
+            equality_delete_files.emplace(delete_file->file_path, delete_file);
+          }
+        }
+        group->files.push_back(std::move(file));
+        return {};
+      }));
+
+  // Skip the partitions over their share of the memory budget, and keep the equality
+  // delete files that apply to them.
+  const int64_t partition_memory = std::max<int64_t>(max_memory_ / parallelism_, 1);
+  std::vector<const PartitionGroup*> groups;
+  std::unordered_set<std::string> kept_paths;
+  for (const auto& [key, group] : partitions) {
+    if (group.estimated_bytes > partition_memory) {
+      ++result.skipped_partitions_count;
+      kept_paths.insert(group.equality_delete_paths.begin(),
+                        group.equality_delete_paths.end());
+    } else {
+      groups.push_back(&group);
+    }
+  }
+  std::vector<std::shared_ptr<DataFile>> removed_files;
+  for (const auto& [path, file] : equality_delete_files) {
+    if (!kept_paths.contains(path)) {
+      removed_files.push_back(file);
+    }
+  }
+  if (removed_files.empty()) {
+    return result;
+  }
+
+  std::shared_ptr<LocationProvider> location_provider = location_provider_;
+  if (location_provider == nullptr) {
+    location_provider = LocationProvider::Make(metadata->location, properties);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto format,
+      FileFormatTypeFromString(properties.Get(TableProperties::kDefaultFileFormat)));
+  const auto file_name_prefix = Uuid::GenerateV7().ToString();
+
+  // Convert the partitions, each one loading its own equality deletes.
+  std::vector<std::optional<DataFile>> new_files(groups.size());
+  auto convert_group = [&](size_t index) -> Status {
+    const auto& group = *groups[index];
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto location,
+        location_provider->NewDataLocation(std::format(
+            "{}-{:05}-deletes.{}", file_name_prefix, index + 1, ToString(format))));
+    ICEBERG_ASSIGN_OR_RAISE(auto writer, PositionDeleteWriter::Make({
+                                             .path = std::move(location),
+                                             .format = format,
+                                             .io = io,
+                                             .properties = metadata->properties,
+                                             .spec_id = group.spec_id,
+                                             .partition = group.partition,
+                                         }));
+    DeleteLoader loader(io, schema);
+    for (const auto& file : group.files) {
+      ICEBERG_RETURN_UNEXPECTED(ConvertDataFile(file, io, *schema, loader, *writer));
+    }
+    ICEBERG_ASSIGN_OR_RAISE(new_files[index], writer->Close());
+    return {};
+  };
+  auto delete_new_files = [&]() {
+    std::vector<std::string> paths;
+    for (const auto& file : new_files) {
+      if (file.has_value()) {
+        paths.push_back(file->file_path);
+      }
+    }
+    if (!paths.empty()) {
+      std::ignore = io->DeleteFiles(paths);
+    }
+  };
+  if (auto status = RunInParallel(*executor, groups.size(), parallelism_, convert_group);
+      !status.has_value()) {
+    delete_new_files();
+    return std::unexpected(status.error());
+  }
+
+  RewriteFiles rewrite(table_);
+  rewrite.ValidateFromSnapshot(snapshot->snapshot_id);
+  for (const auto& file : removed_files) {
+    rewrite.RemoveDeleteFile(file);
+  }
+  std::vector<std::string> data_file_paths;
+  for (const auto* group : groups) {
+    data_file_paths.insert(data_file_paths.end(), group->paths.begin(),
+                           group->paths.end());
+  }
+  rewrite.ValidateDataFilesExist(data_file_paths);
+  for (auto& file : new_files) {
+    if (file.has_value()) {
+      ++result.added_position_delete_files_count;
+      result.added_position_deletes_count += file->record_count;
+      rewrite.AddDeleteFile(std::make_shared<DataFile>(std::move(file.value())));
+    }
+  }
+  if (auto status = rewrite.Commit(); !status.has_value()) {
+    if (status.error().kind != ErrorKind::kCommitStateUnknown) {
+      delete_new_files();
+    }
+    return std::unexpected(status.error());
+  }
+  result.converted_partitions_count = static_cast<int32_t>(groups.size());
+  result.removed_equality_delete_files_count = static_cast<int64_t>(removed_files.size());
+  result.snapshot_id = rewrite.snapshot_id();
+  return result;
+}
+
+}  // namespace iceberg
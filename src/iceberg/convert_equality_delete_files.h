@@ -0,0 +1,110 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/convert_equality_delete_files.h
+/// Conversion of the equality deletes of a table to position deletes.
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief The outcome of an equality delete conversion.
+struct ICEBERG_EXPORT ConvertEqualityDeleteFilesResult {
+  /// \brief The number of partitions whose data files were resolved.
+  int32_t converted_partitions_count = 0;
+  /// \brief The number of partitions left as is because their equality deletes exceed
+  /// their share of the memory budget.
+  int32_t skipped_partitions_count = 0;
+  /// \brief The number of equality delete files that were removed.
+  int64_t removed_equality_delete_files_count = 0;
+  /// \brief The number of position delete files that were written.
+  int64_t added_position_delete_files_count = 0;
+  /// \brief The number of deleted positions of the position delete files.
+  int64_t added_position_deletes_count = 0;
+  /// \brief The ID of the committed snapshot, if any equality delete file was removed.
+  std::optional<int64_t> snapshot_id;
+};
+
+/// \brief Replaces the equality delete files of a table with position delete files.
+///
+/// The data files of the current snapshot with equality deletes are planned with their
+/// delete files and grouped by partition. For each partition, the equality deletes
+/// are loaded once, and the equality fields and row positions of its data files are
+/// read with their position deletes applied. The positions of the rows matching an
+/// equality delete are written to a position delete file of the partition, so scans
+/// no longer join the rows of these data files against the equality deletes.
+///
+/// Up to `parallelism` partitions are converted concurrently, each with its own loaded
+/// equality deletes, which are released once the partition is done. A partition whose
+/// equality deletes are estimated to need more than `MaxMemory() / parallelism` bytes
+/// is skipped, and so are the equality delete files that also apply to it.
+///
+/// The equality delete files that only apply to converted partitions are removed and
+/// the position delete files are added by a single RewriteFiles validated from the
+/// planned snapshot, which fails if a concurrent snapshot removed a converted data file
+/// or one of the equality delete files. The new files are deleted if the commit fails.
+/// Position deletes are written instead of deletion vectors, as snapshots are only
+/// committed to tables of format version 1 and 2.
+class ICEBERG_EXPORT ConvertEqualityDeleteFiles {
+ public:
+  /// \brief The default memory budget of the loaded equality deletes.
+  static constexpr int64_t kDefaultMaxMemoryBytes = int64_t{1} << 30;  // 1 GB
+
+  /// \brief Creates a conversion of the equality deletes of a table.
+  ///
+  /// \param table The table to convert, which must have a catalog to commit to
+  explicit ConvertEqualityDeleteFiles(std::shared_ptr<Table> table);
+
+  ~ConvertEqualityDeleteFiles();
+
+  /// \brief Sets the number of partitions converted concurrently, 1 by default.
+  ConvertEqualityDeleteFiles& WithParallelism(int32_t parallelism);
+
+  /// \brief Sets the executor converting the partitions concurrently, the
+  /// DefaultExecutor() if null.
+  ConvertEqualityDeleteFiles& WithExecutor(std::shared_ptr<Executor> executor);
+
+  /// \brief Sets the memory budget of the equality deletes loaded by all partitions.
+  ConvertEqualityDeleteFiles& MaxMemory(int64_t bytes);
+
+  /// \brief Sets the provider of the locations of the position delete files, which are
+  /// written to `write.data.path`, or the `data` directory of the table, by default.
+  ConvertEqualityDeleteFiles& WithLocationProvider(
+      std::shared_ptr<LocationProvider> provider);
+
+  /// \brief Converts the equality deletes and commits the position delete files.
+  Result<ConvertEqualityDeleteFilesResult> Execute() const;
+
+ private:
+  std::shared_ptr<Table> table_;
+  int32_t parallelism_ = 1;
+  std::shared_ptr<Executor> executor_;
+  int64_t max_memory_ = kDefaultMaxMemoryBytes;
+  std::shared_ptr<LocationProvider> location_provider_;
+};
+
+}  // namespace iceberg
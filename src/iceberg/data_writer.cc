@@ -0,0 +1,2058 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/data_writer.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <limits>
+#include <list>
+#include <numeric>
+#include <queue>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+
+#include "iceberg/deletes/position_delete_writer.h"
+#include "iceberg/expression/literal.h"
+#include "iceberg/file_io.h"
+#include "iceberg/location_provider.h"
+#include "iceberg/partition_field.h"
+#include "iceberg/partition_map.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/row/struct_like.h"
+#include "iceberg/schema.h"
+#include "iceberg/schema_internal.h"
+#include "iceberg/sort_field.h"
+#include "iceberg/sort_key_encoder_internal.h"
+#include "iceberg/sort_order.h"
+#include "iceberg/transform.h"
+#include "iceberg/type.h"
+#include "iceberg/util/arrow_array_filter_internal.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/conversions.h"
+#include "iceberg/util/formatter.h"  // IWYU pragma: keep
+#include "iceberg/util/formatter_internal.h"
+#include "iceberg/util/int128.h"
+#include "iceberg/util/macros.h"
+#include "iceberg/util/string_util.h"
+#include "iceberg/util/uuid.h"
+
+namespace iceberg {
+
+namespace {
+
+void ReleaseArray(ArrowArray* array) {
+  if (array->release != nullptr) {
+    array->release(array);
+  }
+}
+
+bool IsValid(const ArrowArray& array, int64_t row) {
+  const auto* validity = static_cast<const uint8_t*>(array.buffers[0]);
+  if (array.null_count == 0 || validity == nullptr) {
+    return true;
+  }
+  const int64_t index = array.offset + row;
+  return (validity[index >> 3] >> (index & 7)) & 1;
+}
+
+template <typename T>
+T ValueAt(const ArrowArray& array, int64_t row) {
+  T value;
+  std::memcpy(&value,
+              static_cast<const uint8_t*>(array.buffers[1]) +
+                  (array.offset + row) * sizeof(T),
+              sizeof(T));
+  return value;
+}
+
+std::string_view BinaryAt(const ArrowArray& array, int64_t row) {
+  const auto* offsets = static_cast<const int32_t*>(array.buffers[1]);
+  const auto* data = static_cast<const char*>(array.buffers[2]);
+  const int64_t index = array.offset + row;
+  return {data + offsets[index],
+          static_cast<size_t>(offsets[index + 1] - offsets[index])};
+}
+
+std::vector<uint8_t> ToBytes(std::string_view value) {
+  return {value.begin(), value.end()};
+}
+
+/// \brief Reads the value of a row of a primitive array as a literal.
+Result<Literal> LiteralAt(const std::shared_ptr<PrimitiveType>& type,
+                          const ArrowArray& array, int64_t row) {
+  if (!IsValid(array, row)) {
+    return Literal::Null(type);
+  }
+  switch (type->type_id()) {
+    case TypeId::kBoolean: {
+      const auto* values = static_cast<const uint8_t*>(array.buffers[1]);
+      const int64_t index = array.offset + row;
+      return Literal::Boolean((values[index >> 3] >> (index & 7)) & 1);
+    }
+    case TypeId::kInt:
+      return Literal::Int(ValueAt<int32_t>(array, row));
+    case TypeId::kDate:
+      return Literal::Date(ValueAt<int32_t>(array, row));
+    case TypeId::kLong:
+      return Literal::Long(ValueAt<int64_t>(array, row));
+    case TypeId::kTime:
+      return Literal::Time(ValueAt<int64_t>(array, row));
+    case TypeId::kTimestamp:
+      return Literal::Timestamp(ValueAt<int64_t>(array, row));
+    case TypeId::kTimestampTz:
+      return Literal::TimestampTz(ValueAt<int64_t>(array, row));
+    case TypeId::kFloat:
+      return Literal::Float(ValueAt<float>(array, row));
+    case TypeId::kDouble:
+      return Literal::Double(ValueAt<double>(array, row));
+    case TypeId::kDecimal: {
+      const auto& decimal_type = internal::checked_cast<const DecimalType&>(*type);
+      return Literal::Decimal(ValueAt<int128_t>(array, row), decimal_type.precision(),
+                              decimal_type.scale());
+    }
+    case TypeId::kString:
+      return Literal::String(std::string(BinaryAt(array, row)));
+    case TypeId::kBinary:
+      return Literal::Binary(ToBytes(BinaryAt(array, row)));
+    case TypeId::kFixed:
+    case TypeId::kUuid: {
+      const int32_t length =
+          type->type_id() == TypeId::kUuid
+              ? 16
+              : internal::checked_cast<const FixedType&>(*type).length();
+      const auto* values =
+          static_cast<const uint8_t*>(array.buffers[1]) + (array.offset + row) * length;
+      std::vector<uint8_t> bytes(values, values + length);
+      if (type->type_id() == TypeId::kFixed) {
+        return Literal::Fixed(std::move(bytes));
+      }
+      ICEBERG_ASSIGN_OR_RAISE(auto uuid, Uuid::FromBytes(bytes));
+      return Literal::UUID(uuid);
+    }
+    default:
+      return NotSupported("Unsupported partition type: {}", type->ToString());
+  }
+}
+
+/// \brief Exposes partition values to the location provider.
+class PartitionStructLike : public StructLike {
+ public:
+  explicit PartitionStructLike(const std::vector<Literal>& values) : values_(values) {}
+
+  Result<Scalar> GetField(size_t pos) const override {
+    if (pos >= values_.size()) {
+      return InvalidArgument("Invalid partition field position {}, size {}", pos,
+                             values_.size());
+    }
+    return std::visit(
+        [](const auto& value) -> Scalar {
+          using T = std::decay_t<decltype(value)>;
+          if constexpr (std::is_same_v<T, std::string>) {
+            return std::string_view(value);
+          } else if constexpr (std::is_same_v<T, std::vector<uint8_t>>) {
+            return std::string_view(reinterpret_cast<const char*>(value.data()),
+                                    value.size());
+          } else if constexpr (std::is_same_v<T, Uuid>) {
+            const auto bytes = value.bytes();
+            return std::string_view(reinterpret_cast<const char*>(bytes.data()),
+                                    bytes.size());
+          } else if constexpr (std::is_same_v<T, Literal::BelowMin> ||
+                               std::is_same_v<T, Literal::AboveMax>) {
+            return std::monostate{};
+          } else {
+            return value;
+          }
+        },
+        values_[pos].value());
+  }
+
+  size_t num_fields() const override { return values_.size(); }
+
+ private:
+  const std::vector<Literal>& values_;
+};
+
+void CollectFieldPositions(const StructType& type, std::vector<int32_t>& path,
+                           std::unordered_map<int32_t, std::vector<int32_t>>& positions) {
+  const auto fields = type.fields();
+  for (size_t pos = 0; pos < fields.size(); ++pos) {
+    path.push_back(static_cast<int32_t>(pos));
+    positions.emplace(fields[pos].field_id(), path);
+    const auto& field_type = fields[pos].type();
+    if (field_type->type_id() == TypeId::kStruct) {
+      CollectFieldPositions(internal::checked_cast<const StructType&>(*field_type), path,
+                            positions);
+    }
+    path.pop_back();
+  }
+}
+
+/// \brief A view of a nested column over the rows of a batch.
+Result<ArrowArray> ColumnView(const ArrowArray& batch, std::span<const int32_t> path) {
+  const ArrowArray* array = &batch;
+  // Struct children are indexed by the positions of their parents, offsets included.
+  int64_t offset = batch.offset;
+  for (int32_t pos : path) {
+    if (pos >= array->n_children) {
+      return InvalidArrowData("Arrow struct array has {} children, expected at least {}",
+                              array->n_children, pos + 1);
+    }
+    const ArrowArray* child = array->children[pos];
+    if (child->length < offset + batch.length) {
+      return InvalidArrowData("Arrow child array has {} rows, expected at least {}",
+                              child->length, offset + batch.length);
+    }
+    offset += child->offset;
+    array = child;
+  }
+  ArrowArray view = *array;
+  view.offset = offset;
+  view.length = batch.length;
+  view.null_count = array->null_count == 0 ? 0 : -1;
+  view.release = nullptr;
+  return view;
+}
+
+/// \brief A column of the batches, transformed for partitioning or sorting.
+struct TransformedColumn {
+  /// \brief The positions of the column and its parents in their structs.
+  std::vector<int32_t> path;
+  std::shared_ptr<TransformFunction> function;
+  std::shared_ptr<PrimitiveType> type;
+};
+
+/// \brief Binds the transform of a partition or sort field to its source column.
+Result<TransformedColumn> BindColumn(
+    const Schema& schema,
+    const std::unordered_map<int32_t, std::vector<int32_t>>& positions,
+    int32_t source_id, const Transform& transform) {
+  ICEBERG_ASSIGN_OR_RAISE(auto source_field, schema.FindFieldById(source_id));
+  auto position = positions.find(source_id);
+  if (!source_field.has_value() || position == positions.end()) {
+    return InvalidArgument("Cannot find source field {} of transform {}", source_id,
+                           transform.ToString());
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto function, transform.Bind(source_field->get().type()));
+  auto result_type = function->ResultType();
+  if (!result_type->is_primitive()) {
+    return NotSupported("Unsupported transform result type: {}",
+                        result_type->ToString());
+  }
+  return TransformedColumn{
+      .path = position->second,
+      .function = std::move(function),
+      .type = internal::checked_pointer_cast<PrimitiveType>(std::move(result_type))};
+}
+
+/// \brief Transforms a column of a batch.
+Result<ArrowArray> TransformColumn(const TransformedColumn& column,
+                                   const ArrowArray& batch) {
+  ICEBERG_ASSIGN_OR_RAISE(auto view, ColumnView(batch, column.path));
+  return column.function->TransformArray(view);
+}
+
+/// \brief Computes the partitions of the rows of batches.
+///
+/// The source columns of the partition fields are transformed a batch at a time, and
+/// each row is given a key of the bytes of its partition values, equal for the rows of
+/// the same partition.
+class PartitionKeyer {
+ public:
+  ~PartitionKeyer() { ReleaseTransformed(); }
+
+  static Result<std::unique_ptr<PartitionKeyer>> Make(const Schema& schema,
+                                                      const PartitionSpec& spec) {
+    std::unordered_map<int32_t, std::vector<int32_t>> positions;
+    std::vector<int32_t> path;
+    CollectFieldPositions(schema, path, positions);
+
+    auto keyer = std::unique_ptr<PartitionKeyer>(new PartitionKeyer());
+    for (const auto& partition_field : spec.fields()) {
+      ICEBERG_ASSIGN_OR_RAISE(auto column,
+                              BindColumn(schema, positions, partition_field.source_id(),
+                                         *partition_field.transform()));
+      const int32_t byte_width = KeyByteWidth(*column.type);
+      keyer->fields_.push_back(
+          Field{.column = std::move(column), .byte_width = byte_width});
+    }
+    keyer->transformed_.resize(keyer->fields_.size());
+    return keyer;
+  }
+
+  bool partitioned() const { return !fields_.empty(); }
+
+  /// \brief Transforms the source columns of a batch.
+  Status Transform(const ArrowArray& batch) {
+    ReleaseTransformed();
+    for (size_t i = 0; i < fields_.size(); ++i) {
+      ICEBERG_ASSIGN_OR_RAISE(transformed_[i],
+                              TransformColumn(fields_[i].column, batch));
+    }
+    return {};
+  }
+
+  /// \brief Appends the key of a row of the transformed batch.
+  ///
+  /// Each partition value is encoded as a null tag followed by its bytes, prefixed by
+  /// their length for variable-width values.
+  void AppendKey(int64_t row, std::string& key) const {
+    for (size_t i = 0; i < fields_.size(); ++i) {
+      const ArrowArray& values = transformed_[i];
+      if (!IsValid(values, row)) {
+        key.push_back('\0');
+        continue;
+      }
+      key.push_back('\1');
+      const int32_t byte_width = fields_[i].byte_width;
+      if (byte_width == kVariableWidth) {
+        const auto value = BinaryAt(values, row);
+        const auto length = static_cast<int32_t>(value.size());
+        key.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        key.append(value);
+      } else if (byte_width == kBitWidth) {
+        const auto* bits = static_cast<const uint8_t*>(values.buffers[1]);
+        const int64_t index = values.offset + row;
+        key.push_back(static_cast<char>((bits[index >> 3] >> (index & 7)) & 1));
+      } else {
+        key.append(static_cast<const char*>(values.buffers[1]) +
+                       (values.offset + row) * byte_width,
+                   byte_width);
+      }
+    }
+  }
+
+  /// \brief Finds the rows of the transformed batch that start a run of rows of the
+  /// same partition.
+  ///
+  /// Adjacent rows are compared a column at a time, in tight loops over the values of
+  /// each column.
+  void FindRunStarts(int64_t length, std::vector<int64_t>& starts) {
+    changed_.assign(length, 0);
+    for (size_t i = 0; i < fields_.size(); ++i) {
+      const ArrowArray& values = transformed_[i];
+      if (values.null_count == 0 || values.buffers[0] == nullptr) {
+        MarkChangedRows(fields_[i].byte_width, values, changed_.data());
+        continue;
+      }
+      // The values of null rows are unspecified, so they are compared by validity.
+      field_changed_.assign(length, 0);
+      MarkChangedRows(fields_[i].byte_width, values, field_changed_.data());
+      bool previous_valid = IsValid(values, 0);
+      for (int64_t row = 1; row < length; ++row) {
+        const bool valid = IsValid(values, row);
+        if (valid != previous_valid || (valid && field_changed_[row] != 0)) {
+          changed_[row] = 1;
+        }
+        previous_valid = valid;
+      }
+    }
+    starts.clear();
+    starts.push_back(0);
+    for (int64_t row = 1; row < length; ++row) {
+      if (changed_[row] != 0) {
+        starts.push_back(row);
+      }
+    }
+  }
+
+  /// \brief Returns the partition values of a row of the transformed batch.
+  Result<std::vector<Literal>> Partition(int64_t row) const {
+    std::vector<Literal> partition;
+    partition.reserve(fields_.size());
+    for (size_t i = 0; i < fields_.size(); ++i) {
+      ICEBERG_ASSIGN_OR_RAISE(auto value,
+                              LiteralAt(fields_[i].column.type, transformed_[i], row));
+      partition.push_back(std::move(value));
+    }
+    return partition;
+  }
+
+ private:
+  static constexpr int32_t kVariableWidth = -1;
+  static constexpr int32_t kBitWidth = 0;
+
+  struct Field {
+    TransformedColumn column;
+    int32_t byte_width = 0;
+  };
+
+  PartitionKeyer() = default;
+
+  static int32_t KeyByteWidth(const PrimitiveType& type) {
+    switch (type.type_id()) {
+      case TypeId::kBoolean:
+        return kBitWidth;
+      case TypeId::kString:
+      case TypeId::kBinary:
+        return kVariableWidth;
+      case TypeId::kInt:
+      case TypeId::kDate:
+      case TypeId::kFloat:
+        return 4;
+      case TypeId::kDecimal:
+      case TypeId::kUuid:
+        return 16;
+      case TypeId::kFixed:
+        return internal::checked_cast<const FixedType&>(type).length();
+      default:
+        return 8;
+    }
+  }
+
+  template <typename T>
+  static void MarkChangedValues(const T* values, int64_t length, uint8_t* changed) {
+    for (int64_t row = 1; row < length; ++row) {
+      changed[row] |= static_cast<uint8_t>(values[row] != values[row - 1]);
+    }
+  }
+
+  /// \brief Marks the rows whose value differs from the value of the previous row.
+  static void MarkChangedRows(int32_t byte_width, const ArrowArray& values,
+                              uint8_t* changed) {
+    const int64_t length = values.length;
+    const auto* data = static_cast<const uint8_t*>(values.buffers[1]);
+    switch (byte_width) {
+      case 4:
+        MarkChangedValues(reinterpret_cast<const uint32_t*>(data) + values.offset,
+                          length, changed);
+        break;
+      case 8:
+        MarkChangedValues(reinterpret_cast<const uint64_t*>(data) + values.offset,
+                          length, changed);
+        break;
+      default:
+        for (int64_t row = 1; row < length; ++row) {
+          changed[row] |= static_cast<uint8_t>(!ValuesEqual(byte_width, values, row));
+        }
+        break;
+    }
+  }
+
+  static bool ValuesEqual(int32_t byte_width, const ArrowArray& values, int64_t row) {
+    if (byte_width == kVariableWidth) {
+      return BinaryAt(values, row) == BinaryAt(values, row - 1);
+    }
+    const int64_t index = values.offset + row;
+    const auto* data = static_cast<const uint8_t*>(values.buffers[1]);
+    if (byte_width == kBitWidth) {
+      return ((data[index >> 3] >> (index & 7)) & 1) ==
+             ((data[(index - 1) >> 3] >> ((index - 1) & 7)) & 1);
+    }
+    return std::memcmp(data + index * byte_width, data + (index - 1) * byte_width,
+                       byte_width) == 0;
+  }
+
+  void ReleaseTransformed() {
+    for (auto& array : transformed_) {
+      ReleaseArray(&array);
+    }
+  }
+
+  std::vector<Field> fields_;
+  std::vector<ArrowArray> transformed_;
+  std::vector<uint8_t> changed_;
+  std::vector<uint8_t> field_changed_;
+};
+
+/// \brief The state shared by the files of a partitioned writer.
+struct WriterContext {
+  PartitionedWriterOptions options;
+  int32_t file_count = 0;
+  std::vector<DataFile> data_files;
+
+  Result<std::string> NewFileLocation(const std::vector<Literal>& partition) {
+    auto filename = std::format("{}-{:05}.{}", options.file_name_prefix, ++file_count,
+                                ToString(options.format));
+    if (options.spec->fields().empty()) {
+      return options.location_provider->NewDataLocation(filename);
+    }
+    return options.location_provider->NewDataLocation(
+        *options.spec, PartitionStructLike(partition), filename);
+  }
+};
+
+/// \brief Writes the rows of a partition to files of the target size.
+class RollingFileWriter {
+ public:
+  RollingFileWriter(WriterContext& context, std::vector<Literal> partition)
+      : context_(context), partition_(std::move(partition)) {}
+
+  ~RollingFileWriter() {
+    if (writer_ != nullptr) {
+      std::ignore = writer_->Close();
+    }
+  }
+
+  bool is_open() const { return writer_ != nullptr; }
+
+  /// \brief The estimated in-memory size of the rows written to the open file.
+  int64_t open_bytes() const { return bytes_; }
+
+  /// \brief The partition of the files.
+  const std::vector<Literal>& partition() const { return partition_; }
+
+  /// \brief Writes rows, rolling the file once it reaches the target size.
+  ///
+  /// \param rows The rows to write, whose ownership is transferred to the writer
+  /// \param bytes The estimated size of the rows
+  /// \param path If not null, set to the location of the file of the rows
+  /// \param position If not null, set to the position of the first row in its file
+  Status Write(ArrowArray* rows, int64_t bytes, std::string* path = nullptr,
+               int64_t* position = nullptr) {
+    if (writer_ == nullptr) {
+      ICEBERG_RETURN_UNEXPECTED(OpenFile());
+    }
+    if (path != nullptr) {
+      *path = path_;
+      *position = records_;
+    }
+    const int64_t length = rows->length;
+    ICEBERG_RETURN_UNEXPECTED(writer_->Write(rows));
+    records_ += length;
+    bytes_ += bytes;
+    // Writers that cannot estimate the encoded size of the open file are rolled at the
+    // in-memory size of their rows.
+    const int64_t file_size = writer_->estimated_length().value_or(bytes_);
+    if (file_size >= context_.options.target_file_size_bytes) {
+      return CloseFile();
+    }
+    return {};
+  }
+
+  /// \brief Closes the open file and adds it to the data files of the context.
+  Status CloseFile() {
+    if (writer_ == nullptr) {
+      return {};
+    }
+    auto writer = std::move(writer_);
+    bytes_ = 0;
+    ICEBERG_RETURN_UNEXPECTED(writer->Close());
+
+    DataFile data_file;
+    data_file.content = DataFile::Content::kData;
+    data_file.file_path = std::move(path_);
+    data_file.file_format = context_.options.format;
+    data_file.partition = partition_;
+    data_file.record_count = std::exchange(records_, 0);
+    auto length = writer->length();
+    if (!length.has_value()) {
+      return InvalidArgument("Writer did not report the length of {}",
+                             data_file.file_path);
+    }
+    data_file.file_size_in_bytes = length.value();
+    if (auto metrics = writer->metrics(); metrics.has_value()) {
+      auto copy_counts = [](const auto& from, auto& to) {
+        for (const auto& [field_id, count] : from) {
+          to[static_cast<int32_t>(field_id)] = count;
+        }
+      };
+      copy_counts(metrics->column_sizes, data_file.column_sizes);
+      copy_counts(metrics->value_counts, data_file.value_counts);
+      copy_counts(metrics->null_value_counts, data_file.null_value_counts);
+      copy_counts(metrics->nan_value_counts, data_file.nan_value_counts);
+      for (const auto& [field_id, bound] : metrics->lower_bounds) {
+        ICEBERG_ASSIGN_OR_RAISE(data_file.lower_bounds[static_cast<int32_t>(field_id)],
+                                Conversions::ToBytes(bound));
+      }
+      for (const auto& [field_id, bound] : metrics->upper_bounds) {
+        ICEBERG_ASSIGN_OR_RAISE(data_file.upper_bounds[static_cast<int32_t>(field_id)],
+                                Conversions::ToBytes(bound));
+      }
+    }
+    data_file.split_offsets = writer->split_offsets();
+    data_file.partition_spec_id = context_.options.spec->spec_id();
+    context_.data_files.push_back(std::move(data_file));
+    return {};
+  }
+
+ private:
+  Status OpenFile() {
+    ICEBERG_ASSIGN_OR_RAISE(path_, context_.NewFileLocation(partition_));
+    ICEBERG_ASSIGN_OR_RAISE(auto writer, context_.options.writer_factory());
+    ICEBERG_RETURN_UNEXPECTED(
+        writer->Open(WriterOptions{.path = path_,
+                                   .schema = context_.options.schema,
+                                   .io = context_.options.io,
+                                   .memory_pool = context_.options.memory_pool,
+                                   .properties = context_.options.properties}));
+    writer_ = std::move(writer);
+    return {};
+  }
+
+  WriterContext& context_;
+  const std::vector<Literal> partition_;
+  std::unique_ptr<Writer> writer_;
+  std::string path_;
+  int64_t records_ = 0;
+  int64_t bytes_ = 0;
+};
+
+}  // namespace
+
+class SortKeyEncoder::Impl {
+ public:
+  static Result<std::unique_ptr<Impl>> Make(const Schema& schema,
+                                             const PartitionSpec& spec,
+                                             const SortOrder& sort_order,
+                                             std::span<const int32_t> zorder_field_ids,
+                                             int32_t zorder_width) {
+    std::unordered_map<int32_t, std::vector<int32_t>> positions;
+    std::vector<int32_t> path;
+    CollectFieldPositions(schema, path, positions);
+
+    auto encoder = std::unique_ptr<Impl>(new Impl());
+    for (const auto& partition_field : spec.fields()) {
+      ICEBERG_ASSIGN_OR_RAISE(auto column,
+                              BindColumn(schema, positions, partition_field.source_id(),
+                                         *partition_field.transform()));
+      encoder->columns_.push_back(
+          Column{.column = std::move(column), .descending = false, .nulls_first = true});
+    }
+    encoder->partition_columns_ = encoder->columns_.size();
+    for (int32_t field_id : zorder_field_ids) {
+      ICEBERG_ASSIGN_OR_RAISE(
+          auto column, BindColumn(schema, positions, field_id, *Transform::Identity()));
+      encoder->zorder_columns_.push_back(std::move(column));
+    }
+    encoder->zorder_width_ = zorder_width;
+    for (const auto& sort_field : sort_order.fields()) {
+      ICEBERG_ASSIGN_OR_RAISE(auto column,
+                              BindColumn(schema, positions, sort_field.source_id(),
+                                         *sort_field.transform()));
+      encoder->columns_.push_back(
+          Column{.column = std::move(column),
+                 .descending = sort_field.direction() == SortDirection::kDescending,
+                 .nulls_first = sort_field.null_order() == NullOrder::kFirst});
+    }
+    return encoder;
+  }
+
+  /// \brief Encodes the sort keys of the rows of a batch.
+  Status Encode(const ArrowArray& batch, SortKeys& keys) {
+    const int64_t length = batch.length;
+    std::vector<ArrowArray> values(columns_.size() + zorder_columns_.size());
+    auto release = [&values]() {
+      for (auto& array : values) {
+        ReleaseArray(&array);
+      }
+    };
+    for (size_t i = 0; i < values.size(); ++i) {
+      auto transformed =
+          TransformColumn(i < columns_.size() ? columns_[i].column
+                                              : zorder_columns_[i - columns_.size()],
+                          batch);
+      if (!transformed.has_value()) {
+        release();
+        return std::unexpected(transformed.error());
+      }
+      values[i] = transformed.value();
+    }
+
+    // Sizes the keys of the rows, then encodes the columns one after the other.
+    keys.offsets.assign(length + 1, 0);
+    for (size_t i = 0; i < columns_.size(); ++i) {
+      AddKeySizes(*columns_[i].column.type, values[i], keys.offsets);
+    }
+    const auto zorder_size =
+        static_cast<int64_t>(zorder_columns_.size()) * zorder_width_;
+    for (int64_t row = 0; row < length && zorder_size > 0; ++row) {
+      keys.offsets[row + 1] += zorder_size;
+    }
+    std::partial_sum(keys.offsets.begin(), keys.offsets.end(), keys.offsets.begin());
+    keys.data.resize(keys.offsets.back());
+    cursors_.assign(keys.offsets.begin(), keys.offsets.end() - 1);
+    for (size_t i = 0; i < partition_columns_; ++i) {
+      EncodeColumn(columns_[i], values[i], keys.data.data());
+    }
+    if (!zorder_columns_.empty()) {
+      EncodeZOrder(std::span(values).subspan(columns_.size()), keys.data.data());
+    }
+    for (size_t i = partition_columns_; i < columns_.size(); ++i) {
+      EncodeColumn(columns_[i], values[i], keys.data.data());
+    }
+    release();
+    return {};
+  }
+
+ private:
+  struct Column {
+    TransformedColumn column;
+    bool descending = false;
+    bool nulls_first = true;
+  };
+
+  static constexpr uint8_t kNullFirstTag = 0;
+  static constexpr uint8_t kValueTag = 1;
+  static constexpr uint8_t kNullLastTag = 2;
+
+  Impl() = default;
+
+  static int32_t FixedKeyWidth(const PrimitiveType& type) {
+    switch (type.type_id()) {
+      case TypeId::kBoolean:
+        return 1;
+      case TypeId::kInt:
+      case TypeId::kDate:
+      case TypeId::kFloat:
+        return 4;
+      case TypeId::kDecimal:
+      case TypeId::kUuid:
+        return 16;
+      case TypeId::kFixed:
+        return internal::checked_cast<const FixedType&>(type).length();
+      default:
+        return 8;
+    }
+  }
+
+  static bool IsBinaryLike(const PrimitiveType& type) {
+    return type.type_id() == TypeId::kString || type.type_id() == TypeId::kBinary;
+  }
+
+  /// \brief Adds the size of the encoded values of a column to the sizes of the keys,
+  /// which are stored at the position of the next row.
+  static void AddKeySizes(const PrimitiveType& type, const ArrowArray& values,
+                          std::vector<int64_t>& sizes) {
+    const int64_t length = values.length;
+    const bool has_nulls = values.null_count != 0 && values.buffers[0] != nullptr;
+    if (!IsBinaryLike(type)) {
+      const int64_t width = FixedKeyWidth(type);
+      for (int64_t row = 0; row < length; ++row) {
+        sizes[row + 1] += 1 + (!has_nulls || IsValid(values, row) ? width : 0);
+      }
+      return;
+    }
+    for (int64_t row = 0; row < length; ++row) {
+      if (has_nulls && !IsValid(values, row)) {
+        sizes[row + 1] += 1;
+        continue;
+      }
+      const auto value = BinaryAt(values, row);
+      // The zeros of the value are escaped, and the value ends with two zeros.
+      sizes[row + 1] +=
+          3 + static_cast<int64_t>(value.size()) + std::ranges::count(value, '\0');
+    }
+  }
+
+  template <typename T>
+  static void StoreBigEndian(T value, uint8_t* out) {
+    if constexpr (std::endian::native == std::endian::little) {
+      value = std::byteswap(value);
+    }
+    std::memcpy(out, &value, sizeof(T));
+  }
+
+  /// \brief Encodes the value of a row at `out`, returning the size of the encoding.
+  static size_t EncodeValue(const PrimitiveType& type, const ArrowArray& values,
+                            int64_t row, uint8_t* out) {
+    const int64_t index = values.offset + row;
+    const auto* data = static_cast<const uint8_t*>(values.buffers[1]);
+    switch (type.type_id()) {
+      case TypeId::kBoolean:
+        out[0] = (data[index >> 3] >> (index & 7)) & 1;
+        return 1;
+      case TypeId::kInt:
+      case TypeId::kDate:
+        StoreBigEndian(ValueAt<uint32_t>(values, row) ^ (uint32_t{1} << 31), out);
+        return 4;
+      case TypeId::kFloat: {
+        float value = ValueAt<float>(values, row);
+        if (std::isnan(value)) {
+          // NaN sorts after all values, whatever its sign.
+          value = std::numeric_limits<float>::quiet_NaN();
+        }
+        uint32_t bits = std::bit_cast<uint32_t>(value);
+        bits = (bits >> 31) != 0 ? ~bits : bits | (uint32_t{1} << 31);
+        StoreBigEndian(bits, out);
+        return 4;
+      }
+      case TypeId::kDouble: {
+        double value = ValueAt<double>(values, row);
+        if (std::isnan(value)) {
+          value = std::numeric_limits<double>::quiet_NaN();
+        }
+        uint64_t bits = std::bit_cast<uint64_t>(value);
+        bits = (bits >> 63) != 0 ? ~bits : bits | (uint64_t{1} << 63);
+        StoreBigEndian(bits, out);
+        return 8;
+      }
+      case TypeId::kDecimal: {
+        const auto value = ValueAt<int128_t>(values, row);
+        StoreBigEndian(static_cast<uint64_t>(value >> 64) ^ (uint64_t{1} << 63), out);
+        StoreBigEndian(static_cast<uint64_t>(value), out + 8);
+        return 16;
+      }
+      case TypeId::kUuid:
+      case TypeId::kFixed: {
+        const auto width = static_cast<size_t>(FixedKeyWidth(type));
+        std::memcpy(out, data + index * width, width);
+        return width;
+      }
+      case TypeId::kString:
+      case TypeId::kBinary: {
+        size_t size = 0;
+        for (char c : BinaryAt(values, row)) {
+          out[size++] = static_cast<uint8_t>(c);
+          if (c == '\0') {
+            out[size++] = 0xff;
+          }
+        }
+        out[size++] = 0;
+        out[size++] = 0;
+        return size;
+      }
+      default:
+        // Longs, times and timestamps.
+        StoreBigEndian(ValueAt<uint64_t>(values, row) ^ (uint64_t{1} << 63), out);
+        return 8;
+    }
+  }
+
+  void EncodeColumn(const Column& column, const ArrowArray& values, uint8_t* data) {
+    const auto& type = *column.column.type;
+    const bool has_nulls = values.null_count != 0 && values.buffers[0] != nullptr;
+    for (int64_t row = 0; row < values.length; ++row) {
+      uint8_t* out = data + cursors_[row];
+      if (has_nulls && !IsValid(values, row)) {
+        out[0] = column.nulls_first ? kNullFirstTag : kNullLastTag;
+        cursors_[row] += 1;
+        continue;
+      }
+      out[0] = kValueTag;
+      const size_t size = EncodeValue(type, values, row, out + 1);
+      if (column.descending) {
+        for (size_t i = 1; i <= size; ++i) {
+          out[i] = static_cast<uint8_t>(~out[i]);
+        }
+      }
+      cursors_[row] += static_cast<int64_t>(1 + size);
+    }
+  }
+
+  /// \brief Normalizes the values of a column to `width` bytes per row at `out`, which
+  /// must be zeroed.
+  static void NormalizeZOrderColumn(const PrimitiveType& type, const ArrowArray& values,
+                                    int32_t width, uint8_t* out) {
+    const int64_t length = values.length;
+    const bool has_nulls = values.null_count != 0 && values.buffers[0] != nullptr;
+    const auto size = static_cast<size_t>(width);
+    auto store = [&](int64_t row, uint64_t bits) {
+      uint8_t bytes[8];
+      StoreBigEndian(bits, bytes);
+      std::memcpy(out + row * width, bytes, std::min<size_t>(size, 8));
+    };
+    switch (type.type_id()) {
+      case TypeId::kInt:
+      case TypeId::kDate:
+        for (int64_t row = 0; row < length; ++row) {
+          const auto value = static_cast<int64_t>(ValueAt<int32_t>(values, row));
+          store(row, static_cast<uint64_t>(value) ^ (uint64_t{1} << 63));
+        }
+        break;
+      case TypeId::kLong:
+      case TypeId::kTime:
+      case TypeId::kTimestamp:
+      case TypeId::kTimestampTz:
+        for (int64_t row = 0; row < length; ++row) {
+          store(row, ValueAt<uint64_t>(values, row) ^ (uint64_t{1} << 63));
+        }
+        break;
+      case TypeId::kFloat:
+      case TypeId::kDouble:
+        for (int64_t row = 0; row < length; ++row) {
+          double value = type.type_id() == TypeId::kFloat
+                             ? static_cast<double>(ValueAt<float>(values, row))
+                             : ValueAt<double>(values, row);
+          if (std::isnan(value)) {
+            value = std::numeric_limits<double>::quiet_NaN();
+          }
+          uint64_t bits = std::bit_cast<uint64_t>(value);
+          store(row, (bits >> 63) != 0 ? ~bits : bits | (uint64_t{1} << 63));
+        }
+        break;
+      case TypeId::kString:
+      case TypeId::kBinary:
+        for (int64_t row = 0; row < length; ++row) {
+          const auto value = BinaryAt(values, row);
+          std::memcpy(out + row * width, value.data(), std::min(size, value.size()));
+        }
+        break;
+      default:
+        // Booleans, decimals, UUIDs and fixed values use their sort key encoding.
+        for (int64_t row = 0; row < length; ++row) {
+          uint8_t bytes[16] = {};
+          size_t encoded = EncodeValue(type, values, row, bytes);
+          std::memcpy(out + row * width, bytes, std::min(size, encoded));
+        }
+        break;
+    }
+    if (has_nulls) {
+      for (int64_t row = 0; row < length; ++row) {
+        if (!IsValid(values, row)) {
+          std::memset(out + row * width, 0, size);
+        }
+      }
+    }
+  }
+
+  /// \brief Encodes the Z-order keys of the rows, interleaving the bits of their
+  /// normalized values from the most significant one.
+  void EncodeZOrder(std::span<const ArrowArray> values, uint8_t* data) {
+    const int64_t length = values.empty() ? 0 : values.front().length;
+    const auto num_columns = static_cast<int32_t>(zorder_columns_.size());
+    const int64_t width = zorder_width_;
+    normalized_.assign(static_cast<size_t>(num_columns * width * length), 0);
+    for (int32_t i = 0; i < num_columns; ++i) {
+      NormalizeZOrderColumn(*zorder_columns_[i].type, values[i], zorder_width_,
+                            normalized_.data() + i * width * length);
+    }
+    for (int64_t row = 0; row < length; ++row) {
+      uint8_t* out = data + cursors_[row];
+      std::memset(out, 0, static_cast<size_t>(num_columns * width));
+      int64_t out_bit = 0;
+      for (int64_t bit = 0; bit < width * 8; ++bit) {
+        for (int32_t i = 0; i < num_columns; ++i, ++out_bit) {
+          const uint8_t byte = normalized_[(i * length + row) * width + bit / 8];
+          if ((byte >> (7 - bit % 8)) & 1) {
+            out[out_bit / 8] |= static_cast<uint8_t>(0x80 >> (out_bit % 8));
+          }
+        }
+      }
+      cursors_[row] += num_columns * width;
+    }
+  }
+
+  std::vector<Column> columns_;
+  size_t partition_columns_ = 0;
+  std::vector<TransformedColumn> zorder_columns_;
+  int32_t zorder_width_ = 8;
+  std::vector<int64_t> cursors_;
+  std::vector<uint8_t> normalized_;
+};
+
+SortKeyEncoder::SortKeyEncoder(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+
+SortKeyEncoder::~SortKeyEncoder() = default;
+
+Result<std::unique_ptr<SortKeyEncoder>> SortKeyEncoder::Make(
+    const Schema& schema, const PartitionSpec& spec, const SortOrder& sort_order,
+    std::span<const int32_t> zorder_field_ids, int32_t zorder_width) {
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto impl, Impl::Make(schema, spec, sort_order, zorder_field_ids, zorder_width));
+  return std::unique_ptr<SortKeyEncoder>(new SortKeyEncoder(std::move(impl)));
+}
+
+Status SortKeyEncoder::Encode(const ArrowArray& batch, SortKeys& keys) {
+  return impl_->Encode(batch, keys);
+}
+
+namespace {
+
+Status ValidateOptions(PartitionedWriterOptions& options) {
+  if (options.schema == nullptr || options.spec == nullptr) {
+    return InvalidArgument("Partitioned writer requires a schema and a partition spec");
+  }
+  if (options.location_provider == nullptr) {
+    return InvalidArgument("Partitioned writer requires a location provider");
+  }
+  if (options.target_file_size_bytes <= 0) {
+    return InvalidArgument("Invalid target file size: {}",
+                           options.target_file_size_bytes);
+  }
+  if (options.max_open_files <= 0 || options.max_open_bytes <= 0) {
+    return InvalidArgument("Invalid limits of open files: {} files, {} bytes",
+                           options.max_open_files, options.max_open_bytes);
+  }
+  if (!options.writer_factory) {
+    options.writer_factory = WriterFactoryRegistry::GetFactory(options.format);
+  }
+  if (options.file_name_prefix.empty()) {
+    options.file_name_prefix = Uuid::GenerateV7().ToString();
+  }
+  return {};
+}
+
+}  // namespace
+
+class FanoutDataWriter::Impl {
+ public:
+  ~Impl() {
+    if (arrow_schema_.release != nullptr) {
+      arrow_schema_.release(&arrow_schema_);
+    }
+  }
+
+  static Result<std::unique_ptr<Impl>> Make(PartitionedWriterOptions options) {
+    ICEBERG_RETURN_UNEXPECTED(ValidateOptions(options));
+    ICEBERG_ASSIGN_OR_RAISE(auto keyer,
+                            PartitionKeyer::Make(*options.schema, *options.spec));
+    auto impl = std::unique_ptr<Impl>(new Impl(std::move(options), std::move(keyer)));
+    ICEBERG_RETURN_UNEXPECTED(
+        ToArrowSchema(*impl->context_.options.schema, &impl->arrow_schema_));
+    return impl;
+  }
+
+  Status Write(ArrowArray* batch, WrittenRows* written) {
+    ArrowArray rows = *batch;
+    batch->release = nullptr;
+    if (written != nullptr) {
+      written->files.clear();
+      written->file_indices.resize(rows.length);
+      written->positions.resize(rows.length);
+    }
+    auto status = WriteRows(rows, written);
+    ReleaseArray(&rows);
+    return status;
+  }
+
+  Result<std::vector<DataFile>> Close() {
+    if (closed_) {
+      return InvalidArgument("Partitioned writer is closed");
+    }
+    closed_ = true;
+    while (!lru_.empty()) {
+      ICEBERG_RETURN_UNEXPECTED(CloseFile(*lru_.front()));
+    }
+    partitions_.clear();
+    return std::move(context_.data_files);
+  }
+
+  size_t open_files() const { return lru_.size(); }
+
+ private:
+  struct Partition {
+    explicit Partition(WriterContext& context, std::vector<Literal> values)
+        : writer(context, std::move(values)) {}
+
+    RollingFileWriter writer;
+    /// \brief The position of the partition in the LRU list, valid while its file is
+    /// open.
+    std::list<Partition*>::iterator lru_position;
+  };
+
+  Impl(PartitionedWriterOptions options, std::unique_ptr<PartitionKeyer> keyer)
+      : keyer_(std::move(keyer)) {
+    context_.options = std::move(options);
+  }
+
+  /// \brief Writes the rows of a batch, whose ownership stays with the caller, and
+  /// reports where they were written if `written` is not null.
+  Status WriteRows(ArrowArray& batch, WrittenRows* written) {
+    if (closed_) {
+      return InvalidArgument("Partitioned writer is closed");
+    }
+    if (batch.length == 0) {
+      return {};
+    }
+    ICEBERG_ASSIGN_OR_RAISE(const int64_t batch_bytes,
+                            EstimateArrowArraySize(arrow_schema_, batch));
+    if (!keyer_->partitioned()) {
+      ICEBERG_ASSIGN_OR_RAISE(auto* partition, GetPartition({}, 0));
+      return WriteTo(*partition, batch, batch_bytes, written, {});
+    }
+
+    // Number the partitions of the batch in the order of their first rows.
+    ICEBERG_RETURN_UNEXPECTED(keyer_->Transform(batch));
+    batch_groups_.clear();
+    group_keys_.clear();
+    group_first_rows_.clear();
+    row_groups_.resize(batch.length);
+    for (int64_t row = 0; row < batch.length; ++row) {
+      key_.clear();
+      keyer_->AppendKey(row, key_);
+      auto it = batch_groups_.find(key_);
+      if (it == batch_groups_.end()) {
+        it = batch_groups_.emplace(key_, static_cast<int32_t>(group_keys_.size())).first;
+        group_keys_.push_back(key_);
+        group_first_rows_.push_back(row);
+      }
+      row_groups_[row] = it->second;
+    }
+
+    if (group_keys_.size() == 1) {
+      ICEBERG_ASSIGN_OR_RAISE(auto* partition, GetPartition(group_keys_[0], 0));
+      return WriteTo(*partition, batch, batch_bytes, written, {});
+    }
+
+    // Sort the row indices by partition, keeping the order of the rows of each one.
+    group_offsets_.assign(group_keys_.size() + 1, 0);
+    for (int64_t row = 0; row < batch.length; ++row) {
+      ++group_offsets_[row_groups_[row] + 1];
+    }
+    for (size_t group = 1; group < group_offsets_.size(); ++group) {
+      group_offsets_[group] += group_offsets_[group - 1];
+    }
+    row_indices_.resize(batch.length);
+    std::vector<int64_t> next(group_offsets_.begin(), group_offsets_.end() - 1);
+    for (int64_t row = 0; row < batch.length; ++row) {
+      row_indices_[next[row_groups_[row]]++] = row;
+    }
+
+    for (size_t group = 0; group < group_keys_.size(); ++group) {
+      const int64_t begin = group_offsets_[group];
+      const int64_t count = group_offsets_[group + 1] - begin;
+      const auto indices = std::span<const int64_t>(row_indices_)
+                               .subspan(begin, static_cast<size_t>(count));
+      ICEBERG_ASSIGN_OR_RAISE(auto rows, TakeArrowArray(arrow_schema_, batch, indices));
+      auto partition = GetPartition(group_keys_[group], group_first_rows_[group]);
+      if (!partition.has_value()) {
+        ReleaseArray(&rows);
+        return std::unexpected(partition.error());
+      }
+      auto status = WriteTo(**partition, rows, batch_bytes * count / batch.length,
+                            written, indices);
+      ReleaseArray(&rows);
+      ICEBERG_RETURN_UNEXPECTED(status);
+    }
+    return {};
+  }
+
+  Result<Partition*> GetPartition(const std::string& key, int64_t first_row) {
+    auto it = partitions_.find(key);
+    if (it != partitions_.end()) {
+      return it->second.get();
+    }
+    std::vector<Literal> values;
+    if (keyer_->partitioned()) {
+      ICEBERG_ASSIGN_OR_RAISE(values, keyer_->Partition(first_row));
+    }
+    auto partition = std::make_unique<Partition>(context_, std::move(values));
+    auto* result = partition.get();
+    partitions_.emplace(key, std::move(partition));
+    return result;
+  }
+
+  /// \brief Writes rows to the file of a partition, closing the least recently written
+  /// files to stay within the limits of open files.
+  ///
+  /// \param written If not null, the file and positions of the rows are set in it
+  /// \param indices The rows of the batch that are written, or empty for all of them
+  Status WriteTo(Partition& partition, ArrowArray& rows, int64_t bytes,
+                 WrittenRows* written, std::span<const int64_t> indices) {
+    if (partition.writer.is_open()) {
+      lru_.splice(lru_.end(), lru_, partition.lru_position);
+    } else {
+      while (lru_.size() >= static_cast<size_t>(context_.options.max_open_files)) {
+        ICEBERG_RETURN_UNEXPECTED(CloseFile(*lru_.front()));
+      }
+    }
+
+    const int64_t bytes_before = partition.writer.open_bytes();
+    const bool was_open = partition.writer.is_open();
+    ArrowArray owned = rows;
+    rows.release = nullptr;
+    const int64_t length = owned.length;
+    std::string path;
+    int64_t position = 0;
+    auto status = partition.writer.Write(
+        &owned, bytes, written != nullptr ? &path : nullptr, &position);
+    if (written != nullptr && status.has_value()) {
+      const auto file_index = static_cast<int32_t>(written->files.size());
+      written->files.push_back(
+          WrittenRows::File{.path = std::move(path),
+                            .partition = partition.writer.partition()});
+      for (int64_t i = 0; i < length; ++i) {
+        const int64_t row = indices.empty() ? i : indices[i];
+        written->file_indices[row] = file_index;
+        written->positions[row] = position + i;
+      }
+    }
+    if (!was_open && partition.writer.is_open()) {
+      partition.lru_position = lru_.insert(lru_.end(), &partition);
+    } else if (was_open && !partition.writer.is_open()) {
+      lru_.erase(partition.lru_position);
+    }
+    open_bytes_ += partition.writer.open_bytes() - bytes_before;
+    ICEBERG_RETURN_UNEXPECTED(status);
+
+    while (open_bytes_ > context_.options.max_open_bytes && !lru_.empty()) {
+      ICEBERG_RETURN_UNEXPECTED(CloseFile(*lru_.front()));
+    }
+    return {};
+  }
+
+  Status CloseFile(Partition& partition) {
+    open_bytes_ -= partition.writer.open_bytes();
+    lru_.erase(partition.lru_position);
+    return partition.writer.CloseFile();
+  }
+
+  WriterContext context_;
+  std::unique_ptr<PartitionKeyer> keyer_;
+  ArrowSchema arrow_schema_{};
+  std::unordered_map<std::string, std::unique_ptr<Partition>, StringHash,
+                     std::equal_to<>>
+      partitions_;
+  /// \brief The partitions with an open file, least recently written first.
+  std::list<Partition*> lru_;
+  int64_t open_bytes_ = 0;
+  bool closed_ = false;
+
+  // Scratch state of the batch being written.
+  std::string key_;
+  std::unordered_map<std::string, int32_t, StringHash, std::equal_to<>> batch_groups_;
+  std::vector<std::string> group_keys_;
+  std::vector<int64_t> group_first_rows_;
+  std::vector<int32_t> row_groups_;
+  std::vector<int64_t> group_offsets_;
+  std::vector<int64_t> row_indices_;
+};
+
+FanoutDataWriter::FanoutDataWriter(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+
+FanoutDataWriter::~FanoutDataWriter() = default;
+
+Result<std::unique_ptr<FanoutDataWriter>> FanoutDataWriter::Make(
+    PartitionedWriterOptions options) {
+  ICEBERG_ASSIGN_OR_RAISE(auto impl, Impl::Make(std::move(options)));
+  return std::unique_ptr<FanoutDataWriter>(new FanoutDataWriter(std::move(impl)));
+}
+
+Status FanoutDataWriter::Write(ArrowArray* batch) {
+  return impl_->Write(batch, nullptr);
+}
+
+Status FanoutDataWriter::Write(ArrowArray* batch, WrittenRows* written) {
+  return impl_->Write(batch, written);
+}
+
+Result<std::vector<DataFile>> FanoutDataWriter::Close() { return impl_->Close(); }
+
+size_t FanoutDataWriter::open_files() const { return impl_->open_files(); }
+
+class ClusteredDataWriter::Impl {
+ public:
+  ~Impl() {
+    if (arrow_schema_.release != nullptr) {
+      arrow_schema_.release(&arrow_schema_);
+    }
+  }
+
+  static Result<std::unique_ptr<Impl>> Make(PartitionedWriterOptions options) {
+    ICEBERG_RETURN_UNEXPECTED(ValidateOptions(options));
+    ICEBERG_ASSIGN_OR_RAISE(auto keyer,
+                            PartitionKeyer::Make(*options.schema, *options.spec));
+    auto impl = std::unique_ptr<Impl>(new Impl(std::move(options), std::move(keyer)));
+    ICEBERG_RETURN_UNEXPECTED(
+        ToArrowSchema(*impl->context_.options.schema, &impl->arrow_schema_));
+    return impl;
+  }
+
+  Status Write(ArrowArray* batch) {
+    ArrowArray rows = *batch;
+    batch->release = nullptr;
+    auto status = WriteRows(rows);
+    ReleaseArray(&rows);
+    return status;
+  }
+
+  Result<std::vector<DataFile>> Close() {
+    if (closed_) {
+      return InvalidArgument("Partitioned writer is closed");
+    }
+    closed_ = true;
+    if (writer_ != nullptr) {
+      ICEBERG_RETURN_UNEXPECTED(writer_->CloseFile());
+      writer_.reset();
+    }
+    return std::move(context_.data_files);
+  }
+
+  size_t open_files() const { return writer_ != nullptr && writer_->is_open() ? 1 : 0; }
+
+ private:
+  Impl(PartitionedWriterOptions options, std::unique_ptr<PartitionKeyer> keyer)
+      : keyer_(std::move(keyer)) {
+    context_.options = std::move(options);
+  }
+
+  /// \brief Writes the rows of a batch, whose ownership stays with the caller.
+  Status WriteRows(ArrowArray& batch) {
+    if (closed_) {
+      return InvalidArgument("Partitioned writer is closed");
+    }
+    if (batch.length == 0) {
+      return {};
+    }
+    ICEBERG_ASSIGN_OR_RAISE(const int64_t batch_bytes,
+                            EstimateArrowArraySize(arrow_schema_, batch));
+    if (!keyer_->partitioned()) {
+      if (writer_ == nullptr) {
+        writer_ = std::make_unique<RollingFileWriter>(context_, std::vector<Literal>{});
+      }
+      return WriteTo(batch, batch_bytes);
+    }
+
+    ICEBERG_RETURN_UNEXPECTED(keyer_->Transform(batch));
+    keyer_->FindRunStarts(batch.length, run_starts_);
+    run_starts_.push_back(batch.length);
+    for (size_t run = 0; run + 1 < run_starts_.size(); ++run) {
+      const int64_t begin = run_starts_[run];
+      const int64_t count = run_starts_[run + 1] - begin;
+      ICEBERG_RETURN_UNEXPECTED(StartPartition(begin));
+      if (count == batch.length) {
+        return WriteTo(batch, batch_bytes);
+      }
+      row_indices_.resize(count);
+      std::iota(row_indices_.begin(), row_indices_.end(), begin);
+      ICEBERG_ASSIGN_OR_RAISE(auto rows,
+                              TakeArrowArray(arrow_schema_, batch, row_indices_));
+      auto status = WriteTo(rows, batch_bytes * count / batch.length);
+      ReleaseArray(&rows);
+      ICEBERG_RETURN_UNEXPECTED(status);
+    }
+    return {};
+  }
+
+  /// \brief Switches to the partition of a row of the transformed batch, closing the
+  /// file of the previous partition.
+  Status StartPartition(int64_t row) {
+    key_.clear();
+    keyer_->AppendKey(row, key_);
+    if (writer_ != nullptr && key_ == current_key_) {
+      return {};
+    }
+    if (completed_keys_.contains(key_)) {
+      return InvalidArgument(
+          "Incoming rows are not clustered by partition: rows of partition {} follow "
+          "rows of other partitions. Either cluster the rows or use a fan-out writer",
+          FormatPartition(row));
+    }
+    if (writer_ != nullptr) {
+      ICEBERG_RETURN_UNEXPECTED(writer_->CloseFile());
+      completed_keys_.insert(std::move(current_key_));
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto partition, keyer_->Partition(row));
+    writer_ = std::make_unique<RollingFileWriter>(context_, std::move(partition));
+    current_key_ = key_;
+    return {};
+  }
+
+  Status WriteTo(ArrowArray& rows, int64_t bytes) {
+    ArrowArray owned = rows;
+    rows.release = nullptr;
+    return writer_->Write(&owned, bytes);
+  }
+
+  std::string FormatPartition(int64_t row) const {
+    auto partition = keyer_->Partition(row);
+    if (!partition.has_value()) {
+      return "<unknown>";
+    }
+    return FormatRange(partition.value(), ", ", "(", ")");
+  }
+
+  WriterContext context_;
+  std::unique_ptr<PartitionKeyer> keyer_;
+  ArrowSchema arrow_schema_{};
+  /// \brief Writes the rows of the current partition.
+  std::unique_ptr<RollingFileWriter> writer_;
+  std::string current_key_;
+  /// \brief The keys of the partitions whose rows were all written.
+  std::unordered_set<std::string, StringHash, std::equal_to<>> completed_keys_;
+  bool closed_ = false;
+
+  // Scratch state of the batch being written.
+  std::string key_;
+  std::vector<int64_t> run_starts_;
+  std::vector<int64_t> row_indices_;
+};
+
+ClusteredDataWriter::ClusteredDataWriter(std::unique_ptr<Impl> impl)
+    : impl_(std::move(impl)) {}
+
+ClusteredDataWriter::~ClusteredDataWriter() = default;
+
+Result<std::unique_ptr<ClusteredDataWriter>> ClusteredDataWriter::Make(
+    PartitionedWriterOptions options) {
+  ICEBERG_ASSIGN_OR_RAISE(auto impl, Impl::Make(std::move(options)));
+  return std::unique_ptr<ClusteredDataWriter>(new ClusteredDataWriter(std::move(impl)));
+}
+
+Status ClusteredDataWriter::Write(ArrowArray* batch) { return impl_->Write(batch); }
+
+Result<std::vector<DataFile>> ClusteredDataWriter::Close() { return impl_->Close(); }
+
+size_t ClusteredDataWriter::open_files() const { return impl_->open_files(); }
+
+class SortedDataWriter::Impl {
+ public:
+  ~Impl() {
+    ReleaseBuffer();
+    if (arrow_schema_.release != nullptr) {
+      arrow_schema_.release(&arrow_schema_);
+    }
+  }
+
+  static Result<std::unique_ptr<Impl>> Make(PartitionedWriterOptions options,
+                                            SortOptions sort_options) {
+    ICEBERG_RETURN_UNEXPECTED(ValidateOptions(options));
+    if (sort_options.sort_order == nullptr) {
+      return InvalidArgument("Sorted writer requires a sort order");
+    }
+    if (sort_options.buffer_bytes <= 0) {
+      return InvalidArgument("Invalid sort buffer size: {}", sort_options.buffer_bytes);
+    }
+    if (!sort_options.spill_reader_factory) {
+      sort_options.spill_reader_factory =
+          ReaderFactoryRegistry::GetFactory(options.format);
+    }
+    if (!sort_options.zorder_field_ids.empty() &&
+        sort_options.zorder_bytes_per_column <= 0) {
+      return InvalidArgument("Invalid Z-order bytes per column: {}",
+                             sort_options.zorder_bytes_per_column);
+    }
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto encoder,
+        SortKeyEncoder::Make(*options.schema, *options.spec, *sort_options.sort_order,
+                             sort_options.zorder_field_ids,
+                             sort_options.zorder_bytes_per_column));
+    if (sort_options.zorder_field_ids.empty()) {
+      // Fields sorted without a transform may be encoded for sorted values.
+      std::string sorted_field_ids;
+      for (const auto& sort_field : sort_options.sort_order->fields()) {
+        if (sort_field.transform()->transform_type() == TransformType::kIdentity) {
+          if (!sorted_field_ids.empty()) {
+            sorted_field_ids += ',';
+          }
+          sorted_field_ids += std::to_string(sort_field.source_id());
+        }
+      }
+      if (!sorted_field_ids.empty()) {
+        options.properties[std::string(WriterOptions::kSortedFieldIdsProperty)] =
+            std::move(sorted_field_ids);
+      }
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto sink, ClusteredDataWriter::Make(options));
+    auto impl = std::unique_ptr<Impl>(new Impl(std::move(options),
+                                               std::move(sort_options),
+                                               std::move(encoder), std::move(sink)));
+    ICEBERG_RETURN_UNEXPECTED(
+        ToArrowSchema(*impl->options_.schema, &impl->arrow_schema_));
+    return impl;
+  }
+
+  Status Write(ArrowArray* batch) {
+    ArrowArray rows = *batch;
+    batch->release = nullptr;
+    if (closed_) {
+      ReleaseArray(&rows);
+      return InvalidArgument("Partitioned writer is closed");
+    }
+    if (rows.length == 0) {
+      ReleaseArray(&rows);
+      return {};
+    }
+    SortKeys keys;
+    auto bytes = EstimateArrowArraySize(arrow_schema_, rows);
+    auto status = bytes.has_value() ? encoder_->Encode(rows, keys)
+                                    : Status(std::unexpected(bytes.error()));
+    if (!status.has_value()) {
+      ReleaseArray(&rows);
+      return status;
+    }
+    buffered_bytes_ += bytes.value() + static_cast<int64_t>(keys.data.size()) +
+                       static_cast<int64_t>(keys.offsets.size() * sizeof(int64_t));
+    batches_.push_back(rows);
+    keys_.push_back(std::move(keys));
+    if (buffered_bytes_ >= sort_options_.buffer_bytes) {
+      return Spill();
+    }
+    return {};
+  }
+
+  Result<std::vector<DataFile>> Close() {
+    if (closed_) {
+      return InvalidArgument("Partitioned writer is closed");
+    }
+    closed_ = true;
+    auto status = runs_.empty() ? WriteBuffer() : MergeRuns();
+    status = DeleteRuns(std::move(status));
+    ICEBERG_RETURN_UNEXPECTED(status);
+    ICEBERG_ASSIGN_OR_RAISE(auto data_files, sink_->Close());
+    // Files ordered by a Z-order key are not sorted by any sort order of the table.
+    for (auto& data_file : data_files) {
+      if (sort_options_.zorder_field_ids.empty()) {
+        data_file.sort_order_id = sort_options_.sort_order->order_id();
+      }
+    }
+    return data_files;
+  }
+
+  size_t spilled_runs() const { return runs_.size(); }
+
+ private:
+  /// \brief The number of sorted rows that are gathered into a batch.
+  static constexpr int64_t kOutputBatchRows = 4096;
+
+  struct SpilledRun {
+    std::string path;
+    int64_t length = 0;
+  };
+
+  /// \brief The position of the merge in a spilled run.
+  struct RunCursor {
+    ~RunCursor() {
+      ReleaseArray(&batch);
+      if (reader != nullptr) {
+        std::ignore = reader->Close();
+      }
+    }
+
+    std::unique_ptr<Reader> reader;
+    ArrowArray batch{};
+    SortKeys keys;
+    int64_t row = 0;
+
+    bool exhausted() const { return reader == nullptr; }
+    std::string_view key() const { return keys[row]; }
+  };
+
+  Impl(PartitionedWriterOptions options, SortOptions sort_options,
+       std::unique_ptr<SortKeyEncoder> encoder, std::unique_ptr<ClusteredDataWriter> sink)
+      : options_(std::move(options)),
+        sort_options_(std::move(sort_options)),
+        encoder_(std::move(encoder)),
+        sink_(std::move(sink)) {}
+
+  void ReleaseBuffer() {
+    for (auto& batch : batches_) {
+      ReleaseArray(&batch);
+    }
+    batches_.clear();
+    keys_.clear();
+    buffered_bytes_ = 0;
+  }
+
+  /// \brief Returns the locations of the buffered rows in sorted order.
+  std::vector<ArrowRowLocation> SortBuffer() const {
+    std::vector<ArrowRowLocation> rows;
+    for (size_t array = 0; array < batches_.size(); ++array) {
+      for (int64_t row = 0; row < batches_[array].length; ++row) {
+        rows.push_back({.array = static_cast<int64_t>(array), .row = row});
+      }
+    }
+    std::ranges::stable_sort(rows, [this](const auto& lhs, const auto& rhs) {
+      return keys_[lhs.array][lhs.row] < keys_[rhs.array][rhs.row];
+    });
+    return rows;
+  }
+
+  /// \brief Gathers rows of a list of arrays into batches written by `write`.
+  template <typename WriteFn>
+  Status WriteRows(std::span<const ArrowArray* const> arrays,
+                   std::span<const ArrowRowLocation> rows, WriteFn&& write) {
+    for (size_t begin = 0; begin < rows.size(); begin += kOutputBatchRows) {
+      const size_t count = std::min<size_t>(kOutputBatchRows, rows.size() - begin);
+      ICEBERG_ASSIGN_OR_RAISE(
+          auto batch, TakeArrowArrays(arrow_schema_, arrays, rows.subspan(begin, count)));
+      auto status = write(&batch);
+      ReleaseArray(&batch);
+      ICEBERG_RETURN_UNEXPECTED(status);
+    }
+    return {};
+  }
+
+  std::vector<const ArrowArray*> BufferedArrays() const {
+    std::vector<const ArrowArray*> arrays;
+    for (const auto& batch : batches_) {
+      arrays.push_back(&batch);
+    }
+    return arrays;
+  }
+
+  /// \brief Sorts the buffered rows and writes them to the data files.
+  Status WriteBuffer() {
+    const auto rows = SortBuffer();
+    auto status = WriteRows(BufferedArrays(), rows,
+                            [this](ArrowArray* batch) { return sink_->Write(batch); });
+    ReleaseBuffer();
+    return status;
+  }
+
+  /// \brief Sorts the buffered rows and writes them to a spill file.
+  Status Spill() {
+    if (sort_options_.spill_location.empty()) {
+      ReleaseBuffer();
+      return InvalidArgument(
+          "Sorted writer buffered more than {} bytes and has no spill location",
+          sort_options_.buffer_bytes);
+    }
+    SpilledRun run{.path = std::format("{}/{}-spill-{:05}.{}",
+                                       sort_options_.spill_location,
+                                       options_.file_name_prefix, runs_.size() + 1,
+                                       ToString(options_.format))};
+    auto status = WriteRun(run);
+    ReleaseBuffer();
+    ICEBERG_RETURN_UNEXPECTED(status);
+    runs_.push_back(std::move(run));
+    return {};
+  }
+
+  Status WriteRun(SpilledRun& run) {
+    ICEBERG_ASSIGN_OR_RAISE(auto writer, options_.writer_factory());
+    ICEBERG_RETURN_UNEXPECTED(
+        writer->Open(WriterOptions{.path = run.path,
+                                   .schema = options_.schema,
+                                   .io = options_.io,
+                                   .memory_pool = options_.memory_pool,
+                                   .properties = options_.properties}));
+    const auto rows = SortBuffer();
+    auto status =
+        WriteRows(BufferedArrays(), rows,
+                  [&writer](ArrowArray* batch) { return writer->Write(batch); });
+    if (!status.has_value()) {
+      std::ignore = writer->Close();
+      return status;
+    }
+    ICEBERG_RETURN_UNEXPECTED(writer->Close());
+    auto length = writer->length();
+    if (!length.has_value()) {
+      return InvalidArgument("Writer did not report the length of {}", run.path);
+    }
+    run.length = length.value();
+    return {};
+  }
+
+  /// \brief Reads the next batch of a run and encodes its keys, or closes the reader
+  /// at the end of the run.
+  Status Advance(RunCursor& cursor) {
+    ReleaseArray(&cursor.batch);
+    cursor.row = 0;
+    while (true) {
+      ICEBERG_ASSIGN_OR_RAISE(auto batch, cursor.reader->Next());
+      if (!batch.has_value()) {
+        auto reader = std::move(cursor.reader);
+        return reader->Close();
+      }
+      cursor.batch = batch.value();
+      if (cursor.batch.length > 0) {
+        return encoder_->Encode(cursor.batch, cursor.keys);
+      }
+      ReleaseArray(&cursor.batch);
+    }
+  }
+
+  /// \brief Spills the buffered rows and merges the sorted runs into the data files.
+  Status MergeRuns() {
+    if (!batches_.empty()) {
+      ICEBERG_RETURN_UNEXPECTED(Spill());
+    }
+    std::vector<RunCursor> cursors(runs_.size());
+    for (size_t i = 0; i < runs_.size(); ++i) {
+      ICEBERG_ASSIGN_OR_RAISE(cursors[i].reader, sort_options_.spill_reader_factory());
+      ICEBERG_RETURN_UNEXPECTED(cursors[i].reader->Open(
+          ReaderOptions{.path = runs_[i].path,
+                        .length = static_cast<size_t>(runs_[i].length),
+                        .io = options_.io,
+                        .projection = options_.schema,
+                        .memory_pool = options_.memory_pool,
+                        .properties = options_.properties}));
+      ICEBERG_RETURN_UNEXPECTED(Advance(cursors[i]));
+    }
+
+    // A min-heap of the runs by their next key. Equal keys are taken from the earlier
+    // run, which keeps the merge stable.
+    auto greater = [&cursors](size_t lhs, size_t rhs) {
+      const auto order = cursors[lhs].key() <=> cursors[rhs].key();
+      return order == 0 ? lhs > rhs : order > 0;
+    };
+    std::priority_queue<size_t, std::vector<size_t>, decltype(greater)> heap(greater);
+    for (size_t i = 0; i < cursors.size(); ++i) {
+      if (!cursors[i].exhausted()) {
+        heap.push(i);
+      }
+    }
+
+    std::vector<const ArrowArray*> arrays;
+    for (const auto& cursor : cursors) {
+      arrays.push_back(&cursor.batch);
+    }
+    std::vector<ArrowRowLocation> pending;
+    auto flush = [&]() -> Status {
+      auto status = WriteRows(arrays, pending,
+                              [this](ArrowArray* batch) { return sink_->Write(batch); });
+      pending.clear();
+      return status;
+    };
+    while (!heap.empty()) {
+      const size_t run = heap.top();
+      heap.pop();
+      auto& cursor = cursors[run];
+      pending.push_back({.array = static_cast<int64_t>(run), .row = cursor.row});
+      if (++cursor.row < cursor.batch.length) {
+        heap.push(run);
+        if (std::cmp_greater_equal(pending.size(), kOutputBatchRows)) {
+          ICEBERG_RETURN_UNEXPECTED(flush());
+        }
+        continue;
+      }
+      // The pending rows are taken from the batch before it is replaced.
+      ICEBERG_RETURN_UNEXPECTED(flush());
+      ICEBERG_RETURN_UNEXPECTED(Advance(cursor));
+      if (!cursor.exhausted()) {
+        heap.push(run);
+      }
+    }
+    return flush();
+  }
+
+  /// \brief Deletes the spill files, returning the status of the merge or the first
+  /// error of the deletes.
+  Status DeleteRuns(Status status) {
+    if (options_.io == nullptr) {
+      return status;
+    }
+    for (const auto& run : runs_) {
+      auto deleted = options_.io->DeleteFile(run.path);
+      if (status.has_value() && !deleted.has_value()) {
+        status = std::move(deleted);
+      }
+    }
+    return status;
+  }
+
+  PartitionedWriterOptions options_;
+  SortOptions sort_options_;
+  std::unique_ptr<SortKeyEncoder> encoder_;
+  std::unique_ptr<ClusteredDataWriter> sink_;
+  ArrowSchema arrow_schema_{};
+  bool closed_ = false;
+
+  // The buffered rows, with the sort keys of each batch.
+  std::vector<ArrowArray> batches_;
+  std::vector<SortKeys> keys_;
+  int64_t buffered_bytes_ = 0;
+
+  std::vector<SpilledRun> runs_;
+};
+
+SortedDataWriter::SortedDataWriter(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+
+SortedDataWriter::~SortedDataWriter() = default;
+
+Result<std::unique_ptr<SortedDataWriter>> SortedDataWriter::Make(
+    PartitionedWriterOptions options, SortOptions sort_options) {
+  ICEBERG_ASSIGN_OR_RAISE(auto impl,
+                          Impl::Make(std::move(options), std::move(sort_options)));
+  return std::unique_ptr<SortedDataWriter>(new SortedDataWriter(std::move(impl)));
+}
+
+Status SortedDataWriter::Write(ArrowArray* batch) { return impl_->Write(batch); }
+
+Result<std::vector<DataFile>> SortedDataWriter::Close() { return impl_->Close(); }
+
+size_t SortedDataWriter::spilled_runs() const { return impl_->spilled_runs(); }
+
+class DeltaWriter::Impl {
+ public:
+  ~Impl() {
+    if (arrow_schema_.release != nullptr) {
+      arrow_schema_.release(&arrow_schema_);
+    }
+  }
+
+  static Result<std::unique_ptr<Impl>> Make(PartitionedWriterOptions options,
+                                            std::vector<int32_t> equality_field_ids) {
+    ICEBERG_RETURN_UNEXPECTED(ValidateOptions(options));
+    if (equality_field_ids.empty()) {
+      return InvalidArgument("Delta writer requires equality field IDs");
+    }
+    // Keys are the sort keys of the key fields, which are equal for equal keys.
+    std::vector<SortField> key_fields;
+    for (int32_t field_id : equality_field_ids) {
+      key_fields.emplace_back(field_id, Transform::Identity(), SortDirection::kAscending,
+                              NullOrder::kFirst);
+    }
+    const SortOrder key_order(/*order_id=*/1, std::move(key_fields));
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto encoder,
+        SortKeyEncoder::Make(*options.schema, *PartitionSpec::Unpartitioned(),
+                             key_order));
+    ICEBERG_ASSIGN_OR_RAISE(auto data_writer, FanoutDataWriter::Make(options));
+    auto equality_options = options;
+    equality_options.file_name_prefix += "-eq-deletes";
+    ICEBERG_ASSIGN_OR_RAISE(auto equality_writer,
+                            FanoutDataWriter::Make(std::move(equality_options)));
+
+    auto impl = std::unique_ptr<Impl>(new Impl());
+    impl->equality_field_ids_ = std::move(equality_field_ids);
+    impl->encoder_ = std::move(encoder);
+    impl->data_writer_ = std::move(data_writer);
+    impl->equality_writer_ = std::move(equality_writer);
+    impl->position_context_.options = std::move(options);
+    impl->position_context_.options.file_name_prefix += "-pos-deletes";
+    ICEBERG_RETURN_UNEXPECTED(
+        ToArrowSchema(*impl->position_context_.options.schema, &impl->arrow_schema_));
+    return impl;
+  }
+
+  Status Insert(ArrowArray* batch) {
+    ArrowArray rows = *batch;
+    batch->release = nullptr;
+    auto status = EncodeKeys(rows);
+    if (status.has_value() && rows.length > 0) {
+      status = InsertRows(rows);
+    }
+    ReleaseArray(&rows);
+    return status;
+  }
+
+  Status Delete(ArrowArray* batch) {
+    ArrowArray rows = *batch;
+    batch->release = nullptr;
+    auto status = EncodeKeys(rows);
+    if (status.has_value() && rows.length > 0) {
+      status = DeleteRows(rows);
+    }
+    ReleaseArray(&rows);
+    return status;
+  }
+
+  Status Upsert(ArrowArray* batch) {
+    ArrowArray rows = *batch;
+    batch->release = nullptr;
+    auto status = EncodeKeys(rows);
+    if (status.has_value() && rows.length > 0) {
+      status = UpsertRows(rows);
+    }
+    ReleaseArray(&rows);
+    return status;
+  }
+
+  Result<DeltaWriteResult> Close() {
+    if (closed_) {
+      return InvalidArgument("Delta writer is closed");
+    }
+    closed_ = true;
+    DeltaWriteResult result;
+    ICEBERG_ASSIGN_OR_RAISE(result.data_files, data_writer_->Close());
+    ICEBERG_ASSIGN_OR_RAISE(auto equality_deletes, equality_writer_->Close());
+    for (auto& delete_file : equality_deletes) {
+      delete_file.content = DataFile::Content::kEqualityDeletes;
+      delete_file.equality_ids = equality_field_ids_;
+      result.delete_files.push_back(std::move(delete_file));
+    }
+    for (auto& [partition, writer] : position_writers_) {
+      ICEBERG_ASSIGN_OR_RAISE(auto delete_file, writer->Close());
+      if (delete_file.has_value()) {
+        result.delete_files.push_back(std::move(delete_file.value()));
+      }
+    }
+    index_.clear();
+    return result;
+  }
+
+  size_t indexed_keys() const { return index_.size(); }
+
+ private:
+  /// \brief The location of an inserted row.
+  struct RowLocation {
+    /// \brief The index of the data file of the row in `files_`.
+    int32_t file;
+    int64_t position;
+  };
+
+  /// \brief A data file of the inserted rows.
+  struct InsertedFile {
+    std::string path;
+    std::vector<Literal> partition;
+    /// \brief The position delete writer of the partition of the file, created with
+    /// the first delete of a row of the file.
+    PositionDeleteWriter* deletes = nullptr;
+  };
+
+  Impl() = default;
+
+  Status EncodeKeys(const ArrowArray& rows) {
+    if (closed_) {
+      return InvalidArgument("Delta writer is closed");
+    }
+    if (rows.length == 0) {
+      return {};
+    }
+    return encoder_->Encode(rows, keys_);
+  }
+
+  /// \brief Writes rows to the data files and indexes their keys. Ownership of the
+  /// rows is transferred to the data writer.
+  Status InsertRows(ArrowArray& rows) {
+    ArrowArray owned = rows;
+    rows.release = nullptr;
+    ICEBERG_RETURN_UNEXPECTED(data_writer_->Write(&owned, &written_));
+
+    file_ids_.resize(written_.files.size());
+    for (size_t i = 0; i < written_.files.size(); ++i) {
+      auto& file = written_.files[i];
+      auto it = file_ids_by_path_.find(file.path);
+      if (it == file_ids_by_path_.end()) {
+        const auto file_id = static_cast<int32_t>(files_.size());
+        files_.push_back(InsertedFile{.path = file.path,
+                                      .partition = std::move(file.partition)});
+        it = file_ids_by_path_.emplace(std::move(file.path), file_id).first;
+      }
+      file_ids_[i] = it->second;
+    }
+    for (int64_t row = 0; row < static_cast<int64_t>(written_.positions.size()); ++row) {
+      const RowLocation location{.file = file_ids_[written_.file_indices[row]],
+                                 .position = written_.positions[row]};
+      auto [it, inserted] = index_.try_emplace(std::string(keys_[row]), location);
+      if (!inserted) {
+        // The key was inserted before in the checkpoint, whose row is replaced.
+        ICEBERG_RETURN_UNEXPECTED(DeletePosition(it->second));
+        it->second = location;
+      }
+    }
+    return {};
+  }
+
+  Status DeleteRows(ArrowArray& rows) {
+    equality_rows_.clear();
+    for (int64_t row = 0; row < rows.length; ++row) {
+      auto it = index_.find(keys_[row]);
+      if (it == index_.end()) {
+        equality_rows_.push_back(row);
+        continue;
+      }
+      ICEBERG_RETURN_UNEXPECTED(DeletePosition(it->second));
+      index_.erase(it);
+    }
+    return WriteEqualityDeletes(rows);
+  }
+
+  Status UpsertRows(ArrowArray& rows) {
+    // Keys that were not inserted in the checkpoint may be in earlier commits, and
+    // are deleted by equality once per batch. The rows of the other keys are deleted
+    // by position when the rows of the batch are indexed.
+    equality_rows_.clear();
+    batch_keys_.clear();
+    for (int64_t row = 0; row < rows.length; ++row) {
+      const auto key = keys_[row];
+      if (!index_.contains(key) && batch_keys_.insert(key).second) {
+        equality_rows_.push_back(row);
+      }
+    }
+    if (!equality_rows_.empty()) {
+      ICEBERG_ASSIGN_OR_RAISE(auto deletes,
+                              TakeArrowArray(arrow_schema_, rows, equality_rows_));
+      ICEBERG_RETURN_UNEXPECTED(equality_writer_->Write(&deletes));
+    }
+    return InsertRows(rows);
+  }
+
+  /// \brief Writes the rows of `equality_rows_` as equality deletes.
+  Status WriteEqualityDeletes(ArrowArray& rows) {
+    if (equality_rows_.empty()) {
+      return {};
+    }
+    if (static_cast<int64_t>(equality_rows_.size()) == rows.length) {
+      ArrowArray owned = rows;
+      rows.release = nullptr;
+      return equality_writer_->Write(&owned);
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto deletes,
+                            TakeArrowArray(arrow_schema_, rows, equality_rows_));
+    return equality_writer_->Write(&deletes);
+  }
+
+  /// \brief Deletes an inserted row by its position.
+  Status DeletePosition(const RowLocation& location) {
+    auto& file = files_[location.file];
+    if (file.deletes == nullptr) {
+      ICEBERG_ASSIGN_OR_RAISE(auto key,
+                              PartitionTupleKey::Make(
+                                  position_context_.options.spec->spec_id(),
+                                  file.partition));
+      if (auto* writer = position_writers_.Find(key); writer != nullptr) {
+        file.deletes = writer->get();
+      } else {
+        ICEBERG_ASSIGN_OR_RAISE(auto path,
+                                position_context_.NewFileLocation(file.partition));
+        const auto& options = position_context_.options;
+        ICEBERG_ASSIGN_OR_RAISE(
+            auto new_writer,
+            PositionDeleteWriter::Make(
+                PositionDeleteWriterOptions{.path = std::move(path),
+                                            .format = options.format,
+                                            .io = options.io,
+                                            .memory_pool = options.memory_pool,
+                                            .properties = options.properties,
+                                            .spec_id = options.spec->spec_id(),
+                                            .partition = file.partition,
+                                            .writer_factory = options.writer_factory}));
+        file.deletes = new_writer.get();
+        position_writers_.TryEmplace(std::move(key), std::move(new_writer));
+      }
+    }
+    return file.deletes->Delete(file.path, location.position);
+  }
+
+  std::vector<int32_t> equality_field_ids_;
+  std::unique_ptr<SortKeyEncoder> encoder_;
+  std::unique_ptr<FanoutDataWriter> data_writer_;
+  std::unique_ptr<FanoutDataWriter> equality_writer_;
+  /// \brief Names the position delete files.
+  WriterContext position_context_;
+  PartitionMap<std::unique_ptr<PositionDeleteWriter>> position_writers_;
+  ArrowSchema arrow_schema_{};
+  std::vector<InsertedFile> files_;
+  std::unordered_map<std::string, int32_t, StringHash, std::equal_to<>>
+      file_ids_by_path_;
+  /// \brief The locations of the rows inserted in the checkpoint by their key.
+  std::unordered_map<std::string, RowLocation, StringHash, std::equal_to<>> index_;
+  bool closed_ = false;
+
+  // Scratch state of the batch being written.
+  SortKeys keys_;
+  WrittenRows written_;
+  std::vector<int32_t> file_ids_;
+  std::vector<int64_t> equality_rows_;
+  std::unordered_set<std::string_view> batch_keys_;
+};
+
+DeltaWriter::DeltaWriter(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+
+DeltaWriter::~DeltaWriter() = default;
+
+Result<std::unique_ptr<DeltaWriter>> DeltaWriter::Make(
+    PartitionedWriterOptions options, std::vector<int32_t> equality_field_ids) {
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto impl, Impl::Make(std::move(options), std::move(equality_field_ids)));
+  return std::unique_ptr<DeltaWriter>(new DeltaWriter(std::move(impl)));
+}
+
+Status DeltaWriter::Insert(ArrowArray* batch) { return impl_->Insert(batch); }
+
+Status DeltaWriter::Delete(ArrowArray* batch) { return impl_->Delete(batch); }
+
+Status DeltaWriter::Upsert(ArrowArray* batch) { return impl_->Upsert(batch); }
+
+Result<DeltaWriteResult> DeltaWriter::Close() { return impl_->Close(); }
+
+size_t DeltaWriter::indexed_keys() const { return impl_->indexed_keys(); }
+
+}  // namespace iceberg
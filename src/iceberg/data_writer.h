@@ -0,0 +1,300 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/data_writer.h
+/// Writers that route batches of rows to the data files of their partitions.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "iceberg/arrow_c_data.h"
+#include "iceberg/file_format.h"
+#include "iceberg/file_reader.h"
+#include "iceberg/file_writer.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/result.h"
+#include "iceberg/table_properties.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief Options for creating a partitioned data writer.
+struct ICEBERG_EXPORT PartitionedWriterOptions {
+  /// \brief The schema of the rows to write.
+  std::shared_ptr<Schema> schema;
+  /// \brief The partition spec of the rows to write.
+  std::shared_ptr<PartitionSpec> spec;
+  /// \brief The file format of the data files.
+  FileFormatType format = FileFormatType::kParquet;
+  /// \brief FileIO instance passed to the file writers.
+  std::shared_ptr<FileIO> io;
+  /// \brief The pool of the buffers of the file writers, their default pool if null.
+  std::shared_ptr<MemoryPool> memory_pool;
+  /// \brief Provides the locations of the data files.
+  std::shared_ptr<LocationProvider> location_provider;
+  /// \brief Format-specific properties passed to the file writers.
+  std::unordered_map<std::string, std::string> properties;
+  /// \brief Prefix of the names of the data files, a random UUID if empty.
+  std::string file_name_prefix;
+  /// \brief A data file is closed once its estimated length reaches this size, and the
+  /// next rows of its partition go to a new file. The length is estimated by the file
+  /// writer while the file is written, or from the in-memory size of the rows if the
+  /// writer cannot estimate it.
+  int64_t target_file_size_bytes = TableProperties::kWriteTargetFileSizeBytes.value();
+  /// \brief The maximum number of open data files.
+  int32_t max_open_files = 64;
+  /// \brief The maximum estimated size of the rows buffered by the open data files. The
+  /// least recently written files are closed when it is exceeded.
+  int64_t max_open_bytes = int64_t{1} << 30;  // 1 GB
+  /// \brief Creates the file writers, the factory registered for the format if unset.
+  WriterFactory writer_factory;
+};
+
+/// \brief The data files and positions that the rows of a batch were written to.
+struct ICEBERG_EXPORT WrittenRows {
+  /// \brief A data file that rows of the batch were written to.
+  struct File {
+    /// \brief The location of the data file.
+    std::string path;
+    /// \brief The partition of the data file.
+    std::vector<Literal> partition;
+  };
+
+  /// \brief The data files of the rows.
+  std::vector<File> files;
+  /// \brief The index in `files` of the data file of each row of the batch.
+  std::vector<int32_t> file_indices;
+  /// \brief The position of each row of the batch in its data file.
+  std::vector<int64_t> positions;
+};
+
+/// \brief Writes batches of rows to data files, with a file for each partition.
+///
+/// The partition of each row is computed with the vectorized partition transforms,
+/// and the rows of a batch are scattered to the files of their partitions. Files are
+/// kept open across batches, so the input does not need to be clustered by partition.
+/// Files are rolled at the target file size, and the least recently written files are
+/// closed when the number or the size of the open files exceeds its limit.
+class ICEBERG_EXPORT FanoutDataWriter {
+ public:
+  ~FanoutDataWriter();
+
+  /// \brief Creates a fan-out writer.
+  static Result<std::unique_ptr<FanoutDataWriter>> Make(PartitionedWriterOptions options);
+
+  /// \brief Writes a batch of rows.
+  ///
+  /// \param batch A struct array matching the schema of the writer. Ownership of the
+  /// batch is transferred to the writer.
+  Status Write(ArrowArray* batch);
+
+  /// \brief Writes a batch of rows and reports where each row was written.
+  ///
+  /// \param batch A struct array matching the schema of the writer. Ownership of the
+  /// batch is transferred to the writer.
+  /// \param written Set to the data files and positions of the rows of the batch.
+  Status Write(ArrowArray* batch, WrittenRows* written);
+
+  /// \brief Closes the open files and returns all data files that were written.
+  Result<std::vector<DataFile>> Close();
+
+  /// \brief The number of open data files.
+  size_t open_files() const;
+
+ private:
+  class Impl;
+  explicit FanoutDataWriter(std::unique_ptr<Impl> impl);
+
+  std::unique_ptr<Impl> impl_;
+};
+
+/// \brief Writes batches of rows clustered by partition to data files.
+///
+/// The rows of each partition must be contiguous in the input, across batches, as
+/// after sorting or shuffling by partition. A single file is open at a time, which is
+/// closed when the partition of the rows changes or when it reaches the target file
+/// size. Writing rows of a partition whose file was closed for rows of another
+/// partition fails.
+class ICEBERG_EXPORT ClusteredDataWriter {
+ public:
+  ~ClusteredDataWriter();
+
+  /// \brief Creates a clustered writer. The limits of open files of the options are
+  /// not used.
+  static Result<std::unique_ptr<ClusteredDataWriter>> Make(
+      PartitionedWriterOptions options);
+
+  /// \brief Writes a batch of rows.
+  ///
+  /// \param batch A struct array matching the schema of the writer. Ownership of the
+  /// batch is transferred to the writer.
+  /// \return InvalidArgument if the rows are not clustered by partition.
+  Status Write(ArrowArray* batch);
+
+  /// \brief Closes the open file and returns all data files that were written.
+  Result<std::vector<DataFile>> Close();
+
+  /// \brief The number of open data files, at most one.
+  size_t open_files() const;
+
+ private:
+  class Impl;
+  explicit ClusteredDataWriter(std::unique_ptr<Impl> impl);
+
+  std::unique_ptr<Impl> impl_;
+};
+
+/// \brief Options of the sort of a sorted data writer.
+struct ICEBERG_EXPORT SortOptions {
+  /// \brief The sort order of the rows of the data files.
+  std::shared_ptr<SortOrder> sort_order;
+  /// \brief The maximum estimated size of the buffered rows. Once it is exceeded, the
+  /// buffered rows are sorted and spilled to a file of the spill location.
+  int64_t buffer_bytes = int64_t{256} << 20;  // 256 MB
+  /// \brief The location of the files of the spilled rows, which are written with the
+  /// file format of the data files and deleted once the writer is closed. Writing more
+  /// rows than fit in the buffer fails if it is empty.
+  std::string spill_location;
+  /// \brief Creates the readers of the spilled rows, the factory registered for the
+  /// format if unset.
+  ReaderFactory spill_reader_factory;
+  /// \brief The source field IDs of the columns of a Z-order. When set, rows are
+  /// ordered by the Z-order key of these columns before the fields of the sort order,
+  /// and the data files have no sort order ID.
+  std::vector<int32_t> zorder_field_ids;
+  /// \brief The number of leading bytes of the normalized values of each Z-order
+  /// column that are interleaved in the Z-order key.
+  int32_t zorder_bytes_per_column = 8;
+};
+
+/// \brief Writes batches of rows to data files, sorted by partition and by a sort
+/// order or a Z-order.
+///
+/// Rows are buffered up to the size of the sort buffer. The sort keys of the rows are
+/// normalized to byte strings that compare like the rows, so that rows are sorted by
+/// comparing a single string instead of each field of the sort order. When the buffer
+/// is full, its rows are sorted and spilled as a sorted run, and the runs are merged
+/// when the writer is closed. The sorted rows are written with a clustered writer, so
+/// the data files of a partition hold contiguous ranges of the sorted rows.
+///
+/// A Z-order key interleaves the bits of several columns, so that rows that are close
+/// in all of these columns are close in the files, and the bounds of the files prune
+/// filters on any of the columns rather than only on the first field of a sort order.
+class ICEBERG_EXPORT SortedDataWriter {
+ public:
+  ~SortedDataWriter();
+
+  /// \brief Creates a sorted writer. The limits of open files of the options are not
+  /// used.
+  static Result<std::unique_ptr<SortedDataWriter>> Make(PartitionedWriterOptions options,
+                                                        SortOptions sort_options);
+
+  /// \brief Writes a batch of rows.
+  ///
+  /// \param batch A struct array matching the schema of the writer. Ownership of the
+  /// batch is transferred to the writer.
+  Status Write(ArrowArray* batch);
+
+  /// \brief Sorts and writes the buffered rows, and returns all data files that were
+  /// written.
+  Result<std::vector<DataFile>> Close();
+
+  /// \brief The number of sorted runs that were spilled.
+  size_t spilled_runs() const;
+
+ private:
+  class Impl;
+  explicit SortedDataWriter(std::unique_ptr<Impl> impl);
+
+  std::unique_ptr<Impl> impl_;
+};
+
+/// \brief The files written by a delta writer, to be committed together.
+struct ICEBERG_EXPORT DeltaWriteResult {
+  /// \brief The data files of the inserted rows.
+  std::vector<DataFile> data_files;
+  /// \brief The equality and position delete files of the deleted rows.
+  std::vector<DataFile> delete_files;
+};
+
+/// \brief Writes the inserts and deletes of a checkpoint of a stream of changes keyed
+/// by a primary key.
+///
+/// Equality deletes only apply to data files of earlier commits, so the rows inserted
+/// by the writer cannot be deleted by equality. The writer keeps a hash index of the
+/// primary keys it inserted, from the key to the data file and position of its row. A
+/// delete or an update of a key of the index becomes a position delete of that row,
+/// which readers apply without joining rows against equality deletes. Other deletes
+/// and updates are written as equality deletes of the key fields, with the full row of
+/// the change. A key inserted again replaces its indexed row with a position delete.
+///
+/// Rows are written with a fan-out writer, and deletes to a fan-out writer of
+/// equality delete files and to a position delete writer for each partition. The
+/// writer covers a single checkpoint: its files must be committed together, as with a
+/// RowDelta, and the next checkpoint starts with a new writer and an empty index.
+class ICEBERG_EXPORT DeltaWriter {
+ public:
+  ~DeltaWriter();
+
+  /// \brief Creates a delta writer.
+  ///
+  /// \param options The options of the data files, also used for the delete files
+  /// \param equality_field_ids The IDs of the fields of the primary key
+  static Result<std::unique_ptr<DeltaWriter>> Make(
+      PartitionedWriterOptions options, std::vector<int32_t> equality_field_ids);
+
+  /// \brief Inserts a batch of rows.
+  ///
+  /// \param batch A struct array matching the schema of the writer. Ownership of the
+  /// batch is transferred to the writer.
+  Status Insert(ArrowArray* batch);
+
+  /// \brief Deletes the rows with the keys of a batch of rows.
+  ///
+  /// \param batch A struct array matching the schema of the writer. Ownership of the
+  /// batch is transferred to the writer.
+  Status Delete(ArrowArray* batch);
+
+  /// \brief Replaces the rows with the keys of a batch of rows by the rows of the
+  /// batch.
+  ///
+  /// \param batch A struct array matching the schema of the writer. Ownership of the
+  /// batch is transferred to the writer.
+  Status Upsert(ArrowArray* batch);
+
+  /// \brief Closes the open files and returns all files that were written.
+  Result<DeltaWriteResult> Close();
+
+  /// \brief The number of keys of the rows inserted in the checkpoint.
+  size_t indexed_keys() const;
+
+ private:
+  class Impl;
+  explicit DeltaWriter(std::unique_ptr<Impl> impl);
+
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace iceberg
@@ -0,0 +1,313 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/deletes/delete_file_index.h"
+
+#include <algorithm>
+#include <compare>
+#include <map>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#include "iceberg/expression/literal.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/metadata_columns.h"
+#include "iceberg/schema.h"
+#include "iceberg/schema_field.h"
+#include "iceberg/type.h"
+#include "iceberg/util/conversions.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief Returns a key identifying the partition of a file written with a spec.
+Result<PartitionTupleKey> PartitionKey(const DataFile& file) {
+  return PartitionTupleKey::Make(file.partition_spec_id, file.partition);
+}
+
+/// \brief Returns the data file referenced by all deletes of a position delete file, if
+/// there is one.
+std::optional<std::string> ReferencedDataFile(const DataFile& delete_file) {
+  if (delete_file.referenced_data_file.has_value()) {
+    return delete_file.referenced_data_file;
+  }
+  // The deletes reference a single data file if the bounds of the path are equal.
+  const int32_t path_id = MetadataColumns::kDeleteFilePath.field_id();
+  auto lower = delete_file.lower_bounds.find(path_id);
+  auto upper = delete_file.upper_bounds.find(path_id);
+  if (lower != delete_file.lower_bounds.cend() &&
+      upper != delete_file.upper_bounds.cend() && lower->second == upper->second) {
+    return std::string(lower->second.begin(), lower->second.end());
+  }
+  return std::nullopt;
+}
+
+std::string_view AsStringView(const std::vector<uint8_t>& bytes) {
+  return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+}
+
+/// \brief Returns whether the bounds of the paths of a position delete file include the
+/// path of a data file.
+bool CanContainPositionDeletes(const DataFile& data_file, const DataFile& delete_file) {
+  const int32_t path_id = MetadataColumns::kDeleteFilePath.field_id();
+  auto lower = delete_file.lower_bounds.find(path_id);
+  if (lower != delete_file.lower_bounds.cend() &&
+      std::string_view(data_file.file_path) < AsStringView(lower->second)) {
+    return false;
+  }
+  auto upper = delete_file.upper_bounds.find(path_id);
+  if (upper != delete_file.upper_bounds.cend() &&
+      std::string_view(data_file.file_path) > AsStringView(upper->second)) {
+    return false;
+  }
+  return true;
+}
+
+std::optional<int64_t> Count(const std::map<int32_t, int64_t>& counts,
+                             int32_t field_id) {
+  auto it = counts.find(field_id);
+  if (it == counts.cend()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+bool ContainsNull(const DataFile& file, int32_t field_id) {
+  auto null_count = Count(file.null_value_counts, field_id);
+  return null_count.has_value() && *null_count > 0;
+}
+
+bool AllNonNull(const DataFile& file, int32_t field_id) {
+  auto null_count = Count(file.null_value_counts, field_id);
+  return null_count.has_value() && *null_count == 0;
+}
+
+bool AllNull(const DataFile& file, int32_t field_id) {
+  auto null_count = Count(file.null_value_counts, field_id);
+  auto value_count = Count(file.value_counts, field_id);
+  return null_count.has_value() && value_count.has_value() &&
+         *null_count == *value_count;
+}
+
+const std::vector<uint8_t>* Bound(const std::map<int32_t, std::vector<uint8_t>>& bounds,
+                                  int32_t field_id) {
+  auto it = bounds.find(field_id);
+  return it == bounds.cend() ? nullptr : &it->second;
+}
+
+/// \brief Returns whether the values of a field in two files may overlap, according to
+/// their bounds.
+///
+/// The bounds are compared in their serialized form, without deserializing them.
+bool RangesOverlap(const DataFile& data_file, const DataFile& delete_file,
+                   int32_t field_id, const std::shared_ptr<PrimitiveType>& type) {
+  const auto* data_lower = Bound(data_file.lower_bounds, field_id);
+  const auto* data_upper = Bound(data_file.upper_bounds, field_id);
+  const auto* delete_lower = Bound(delete_file.lower_bounds, field_id);
+  const auto* delete_upper = Bound(delete_file.upper_bounds, field_id);
+  if (data_lower == nullptr || data_upper == nullptr || delete_lower == nullptr ||
+      delete_upper == nullptr) {
+    return true;
+  }
+  // Unordered or invalid bounds do not prune anything.
+  auto is_after = [&type](const std::vector<uint8_t>& lhs,
+                          const std::vector<uint8_t>& rhs) {
+    auto cmp = Conversions::CompareBytes(*type, lhs, rhs);
+    return cmp.has_value() && cmp.value() == std::partial_ordering::greater;
+  };
+  return !is_after(*data_lower, *delete_upper) && !is_after(*delete_lower, *data_upper);
+}
+
+}  // namespace
+
+void DeleteFileIndex::Group::Add(IndexedDeleteFile file) {
+  files_.push_back(std::move(file));
+}
+
+void DeleteFileIndex::Group::Sort() {
+  std::ranges::stable_sort(files_, {}, &IndexedDeleteFile::sequence_number);
+}
+
+std::span<const DeleteFileIndex::IndexedDeleteFile> DeleteFileIndex::Group::From(
+    int64_t min_sequence_number) const {
+  auto first = std::ranges::lower_bound(files_, min_sequence_number, {},
+                                        &IndexedDeleteFile::sequence_number);
+  return {first, files_.cend()};
+}
+
+DeleteFileIndex::DeleteFileIndex() = default;
+
+DeleteFileIndex::~DeleteFileIndex() = default;
+
+DeleteFileIndex::DeleteFileIndex(DeleteFileIndex&&) noexcept = default;
+
+DeleteFileIndex& DeleteFileIndex::operator=(DeleteFileIndex&&) noexcept = default;
+
+Result<DeleteFileIndex> DeleteFileIndex::Make(std::shared_ptr<Schema> schema,
+                                              std::vector<ManifestEntry> delete_entries) {
+  DeleteFileIndex index;
+  index.schema_ = std::move(schema);
+  for (auto& entry : delete_entries) {
+    if (entry.data_file == nullptr) {
+      return InvalidManifest("Delete manifest entry has no data file");
+    }
+    ICEBERG_RETURN_UNEXPECTED(
+        index.Add(std::move(entry.data_file), entry.sequence_number.value_or(0)));
+  }
+
+  auto sort_groups = [](auto& groups) {
+    for (auto& [_, group] : groups) {
+      group.Sort();
+    }
+  };
+  sort_groups(index.deletion_vectors_);
+  sort_groups(index.path_deletes_);
+  for (auto& [_, groups] : index.partition_deletes_) {
+    groups.position_deletes.Sort();
+    groups.equality_deletes.Sort();
+  }
+  index.global_equality_deletes_.Sort();
+  return index;
+}
+
+Status DeleteFileIndex::Add(std::shared_ptr<DataFile> delete_file,
+                            int64_t sequence_number) {
+  IndexedDeleteFile entry{.file = std::move(delete_file),
+                          .sequence_number = sequence_number};
+  const DataFile& file = *entry.file;
+  if (file.content == DataFile::Content::kData) {
+    return InvalidArgument("Data file {} cannot be indexed as a delete file",
+                           file.file_path);
+  }
+  if (file.content == DataFile::Content::kEqualityDeletes) {
+    // Equality deletes of unpartitioned specs apply to the data files of all specs.
+    if (file.partition.empty()) {
+      global_equality_deletes_.Add(std::move(entry));
+    } else {
+      ICEBERG_ASSIGN_OR_RAISE(auto partition, PartitionKey(file));
+      partition_deletes_[std::move(partition)].equality_deletes.Add(std::move(entry));
+    }
+  } else if (file.file_format == FileFormatType::kPuffin) {
+    if (!file.referenced_data_file.has_value()) {
+      return InvalidManifest("Deletion vector {} has no referenced data file",
+                             file.file_path);
+    }
+    deletion_vectors_[file.referenced_data_file.value()].Add(std::move(entry));
+  } else if (auto path = ReferencedDataFile(file); path.has_value()) {
+    path_deletes_[std::move(path.value())].Add(std::move(entry));
+  } else {
+    ICEBERG_ASSIGN_OR_RAISE(auto partition, PartitionKey(file));
+    partition_deletes_[std::move(partition)].position_deletes.Add(std::move(entry));
+  }
+  empty_ = false;
+  return {};
+}
+
+bool DeleteFileIndex::IsEmpty() const { return empty_; }
+
+bool DeleteFileIndex::CanContainEqualityDeletes(
+    const DataFile& data_file, const IndexedDeleteFile& delete_file) const {
+  if (schema_ == nullptr) {
+    return true;
+  }
+  for (int32_t field_id : delete_file.file->equality_ids) {
+    auto field = schema_->FindFieldById(field_id);
+    if (!field.has_value() || !field->has_value()) {
+      continue;
+    }
+    const auto& type = field->value().get().type();
+    if (!type->is_primitive()) {
+      continue;
+    }
+    if (ContainsNull(data_file, field_id) && ContainsNull(*delete_file.file, field_id)) {
+      // Null values of the data file are deleted.
+      continue;
+    }
+    if (AllNull(data_file, field_id) && AllNonNull(*delete_file.file, field_id)) {
+      return false;
+    }
+    if (AllNull(*delete_file.file, field_id) && AllNonNull(data_file, field_id)) {
+      return false;
+    }
+    // Bounds of floating point fields do not include NaN values, which may be deleted.
+    if (type->type_id() == TypeId::kFloat || type->type_id() == TypeId::kDouble) {
+      continue;
+    }
+    if (!RangesOverlap(data_file, *delete_file.file, field_id,
+                       std::static_pointer_cast<PrimitiveType>(type))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Result<std::vector<std::shared_ptr<DataFile>>> DeleteFileIndex::ForDataFile(
+    const DataFile& data_file, int64_t sequence_number) const {
+  std::vector<std::shared_ptr<DataFile>> delete_files;
+  if (empty_) {
+    return delete_files;
+  }
+  const PartitionGroups* partition = nullptr;
+  if (!partition_deletes_.empty()) {
+    ICEBERG_ASSIGN_OR_RAISE(auto key, PartitionKey(data_file));
+    partition = partition_deletes_.Find(key);
+  }
+  auto find_group = [&](const auto& groups) -> const Group* {
+    auto it = groups.find(data_file.file_path);
+    return it == groups.cend() ? nullptr : &it->second;
+  };
+
+  if (const Group* group = find_group(deletion_vectors_); group != nullptr) {
+    for (const auto& entry : group->From(sequence_number)) {
+      delete_files.push_back(entry.file);
+    }
+  }
+  if (delete_files.empty()) {
+    if (const Group* group = find_group(path_deletes_); group != nullptr) {
+      for (const auto& entry : group->From(sequence_number)) {
+        delete_files.push_back(entry.file);
+      }
+    }
+    if (partition != nullptr) {
+      for (const auto& entry : partition->position_deletes.From(sequence_number)) {
+        if (CanContainPositionDeletes(data_file, *entry.file)) {
+          delete_files.push_back(entry.file);
+        }
+      }
+    }
+  }
+
+  auto add_equality_deletes = [&](const Group& group) {
+    for (const auto& entry : group.From(sequence_number + 1)) {
+      if (CanContainEqualityDeletes(data_file, entry)) {
+        delete_files.push_back(entry.file);
+      }
+    }
+  };
+  add_equality_deletes(global_equality_deletes_);
+  if (partition != nullptr) {
+    add_equality_deletes(partition->equality_deletes);
+  }
+  return delete_files;
+}
+
+}  // namespace iceberg
@@ -0,0 +1,134 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/deletes/delete_file_index.h
+/// Index of the delete files of a snapshot, for finding the deletes of data files.
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/partition_map.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief An index of delete files, which finds the delete files that apply to a data
+/// file without matching it against every delete file.
+///
+/// Delete files are grouped by the data files that they may apply to: deletion vectors
+/// and position delete files referencing a single data file by its path, other delete
+/// files by their partition spec id and partition tuple, and equality delete files of
+/// unpartitioned specs in a global group. Each group is sorted by data sequence number,
+/// so the delete files that are new enough to apply are found with a binary search.
+/// The remaining candidates are pruned with the bounds of the files: position deletes
+/// by the bounds of their file paths, and equality deletes by the bounds and null
+/// counts of their equality fields.
+///
+/// The index is immutable once built and can be queried concurrently.
+class ICEBERG_EXPORT DeleteFileIndex {
+ public:
+  ~DeleteFileIndex();
+
+  DeleteFileIndex(DeleteFileIndex&&) noexcept;
+  DeleteFileIndex& operator=(DeleteFileIndex&&) noexcept;
+  DeleteFileIndex(const DeleteFileIndex&) = delete;
+  DeleteFileIndex& operator=(const DeleteFileIndex&) = delete;
+
+  /// \brief Builds an index of delete files.
+  ///
+  /// \param schema The table schema, which resolves the types of the bounds of
+  /// equality fields. Equality deletes are not pruned by their bounds without it.
+  /// \param delete_entries The live manifest entries of the delete files
+  /// \return A Result containing the index, or an error if an entry is invalid.
+  static Result<DeleteFileIndex> Make(std::shared_ptr<Schema> schema,
+                                      std::vector<ManifestEntry> delete_entries);
+
+  /// \brief Returns whether the index has no delete files.
+  bool IsEmpty() const;
+
+  /// \brief Returns the delete files that may apply to a data file.
+  ///
+  /// Position deletes apply to the data files with a lower or equal data sequence
+  /// number, and equality deletes to the data files with a lower data sequence number.
+  /// When a deletion vector applies, it replaces the position delete files of the data
+  /// file.
+  ///
+  /// \param data_file The data file
+  /// \param sequence_number The data sequence number of the data file
+  /// \return A Result containing the delete files, or an error if the partition of
+  /// the data file could not be serialized.
+  Result<std::vector<std::shared_ptr<DataFile>>> ForDataFile(
+      const DataFile& data_file, int64_t sequence_number) const;
+
+ private:
+  struct IndexedDeleteFile {
+    std::shared_ptr<DataFile> file;
+    int64_t sequence_number;
+  };
+
+  /// \brief Delete files sorted by data sequence number.
+  class Group {
+   public:
+    void Add(IndexedDeleteFile file);
+    void Sort();
+
+    /// \brief Returns the delete files with a data sequence number of at least
+    /// `min_sequence_number`.
+    std::span<const IndexedDeleteFile> From(int64_t min_sequence_number) const;
+
+   private:
+    std::vector<IndexedDeleteFile> files_;
+  };
+
+  /// \brief The delete files of a partition.
+  struct PartitionGroups {
+    Group position_deletes;
+    Group equality_deletes;
+  };
+
+  DeleteFileIndex();
+
+  Status Add(std::shared_ptr<DataFile> delete_file, int64_t sequence_number);
+
+  bool CanContainEqualityDeletes(const DataFile& data_file,
+                                 const IndexedDeleteFile& delete_file) const;
+
+  std::shared_ptr<Schema> schema_;
+  /// \brief Deletion vectors, keyed by the data file they reference.
+  std::unordered_map<std::string, Group> deletion_vectors_;
+  /// \brief Position delete files referencing a single data file, keyed by its path.
+  std::unordered_map<std::string, Group> path_deletes_;
+  /// \brief Other delete files of partitioned specs, and position delete files of
+  /// unpartitioned specs, keyed by spec id and partition tuple.
+  PartitionMap<PartitionGroups> partition_deletes_;
+  /// \brief Equality delete files of unpartitioned specs, which apply to the data
+  /// files of all specs.
+  Group global_equality_deletes_;
+  bool empty_ = true;
+};
+
+}  // namespace iceberg
@@ -0,0 +1,507 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/deletes/delete_loader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include <nanoarrow/nanoarrow.h>
+
+#include "iceberg/arrow/nanoarrow_status_internal.h"
+#include "iceberg/arrow_c_data_guard_internal.h"
+#include "iceberg/deletes/equality_delete_set.h"
+#include "iceberg/deletes/position_delete_index.h"
+#include "iceberg/file_io.h"
+#include "iceberg/file_reader.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/metadata_columns.h"
+#include "iceberg/schema.h"
+#include "iceberg/util/macros.h"
+#include "iceberg/util/spill_file_internal.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief Deleted positions of a position delete file, keyed by data file path.
+using PositionDeletesByPath =
+    std::unordered_map<std::string, std::shared_ptr<const PositionDeleteIndex>>;
+
+/// \brief A thread-safe map of values loaded at most once per key.
+///
+/// Concurrent lookups of a key that is being loaded wait for the load to finish. Failed
+/// loads are not cached, so they are retried by later lookups.
+template <typename T>
+class LoadOnceMap {
+ public:
+  using ValueResult = Result<std::shared_ptr<const T>>;
+
+  ValueResult GetOrLoad(const std::string& key,
+                        const std::function<ValueResult()>& load) {
+    std::promise<ValueResult> promise;
+    std::shared_future<ValueResult> future;
+    bool loading = false;
+    {
+      std::lock_guard lock(mutex_);
+      auto [it, inserted] = values_.try_emplace(key);
+      if (inserted) {
+        it->second = promise.get_future().share();
+        loading = true;
+      }
+      future = it->second;
+    }
+    if (!loading) {
+      return future.get();
+    }
+
+    auto result = load();
+    if (!result.has_value()) {
+      std::lock_guard lock(mutex_);
+      values_.erase(key);
+    }
+    promise.set_value(result);
+    return result;
+  }
+
+  /// \brief Forgets the loaded value of a key, so that the next lookup loads it again.
+  /// A value that is still being loaded is kept.
+  void Erase(const std::string& key) {
+    std::lock_guard lock(mutex_);
+    auto it = values_.find(key);
+    if (it != values_.end() &&
+        it->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+      values_.erase(it);
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::shared_future<ValueResult>> values_;
+};
+
+/// \brief Keeps the loaded equality deletes within a memory budget by spilling the
+/// least recently used sets to a local file.
+///
+/// A spilled set is erased from the map it was loaded in, whose next load of it
+/// restores it from the spill file. Sets are written once, later evictions of a
+/// restored set only drop it from memory. The keys of single delete files are their
+/// paths and the keys of merged sets end with a newline, so they do not collide.
+class EqualityDeleteSpill {
+ public:
+  using SetMap = LoadOnceMap<EqualityDeleteSet>;
+
+  explicit EqualityDeleteSpill(SpillOptions options) : options_(std::move(options)) {}
+
+  /// \brief Returns the spilled set of a key, or null if it was not spilled.
+  Result<std::shared_ptr<const EqualityDeleteSet>> Restore(const std::string& key,
+                                                           const Schema& schema) {
+    int64_t offset;
+    {
+      std::lock_guard lock(mutex_);
+      auto it = offsets_.find(key);
+      if (it == offsets_.end()) {
+        return nullptr;
+      }
+      offset = it->second;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto data, file_->Read(offset));
+    ICEBERG_ASSIGN_OR_RAISE(auto deletes, EqualityDeleteSet::Deserialize(schema, data));
+    return std::make_shared<const EqualityDeleteSet>(std::move(deletes));
+  }
+
+  /// \brief Marks the set of a key as the most recently used, and spills the least
+  /// recently used sets beyond the memory budget.
+  Status Use(SetMap& map, const std::string& key,
+             const std::shared_ptr<const EqualityDeleteSet>& deletes) {
+    std::lock_guard lock(mutex_);
+    if (auto it = index_.find(key); it != index_.end()) {
+      items_.splice(items_.begin(), items_, it->second);
+      return {};
+    }
+    items_.push_front(Item{.map = &map,
+                           .key = key,
+                           .deletes = deletes,
+                           .size_bytes = deletes->size_bytes()});
+    index_.emplace(key, items_.begin());
+    size_bytes_ += items_.front().size_bytes;
+
+    // The most recently used set is kept even when it exceeds the budget on its own.
+    while (size_bytes_ > options_.memory_budget_bytes && items_.size() > 1) {
+      auto& lru = items_.back();
+      if (!offsets_.contains(lru.key)) {
+        if (file_ == nullptr) {
+          ICEBERG_ASSIGN_OR_RAISE(
+              file_, SpillFile::Make(options_.directory, "equality-deletes"));
+        }
+        ICEBERG_ASSIGN_OR_RAISE(auto offset, file_->Append(lru.deletes->Serialize()));
+        offsets_.emplace(lru.key, offset);
+      }
+      lru.map->Erase(lru.key);
+      size_bytes_ -= lru.size_bytes;
+      index_.erase(lru.key);
+      items_.pop_back();
+    }
+    return {};
+  }
+
+ private:
+  struct Item {
+    SetMap* map;
+    std::string key;
+    std::shared_ptr<const EqualityDeleteSet> deletes;
+    int64_t size_bytes;
+  };
+
+  const SpillOptions options_;
+  std::mutex mutex_;
+  /// \brief The sets in memory, from the most to the least recently used.
+  std::list<Item> items_;
+  std::unordered_map<std::string, std::list<Item>::iterator> index_;
+  int64_t size_bytes_ = 0;
+  /// \brief The spill file, created when the first set is spilled.
+  std::unique_ptr<SpillFile> file_;
+  /// \brief The offsets of the spilled sets in the spill file.
+  std::unordered_map<std::string, int64_t> offsets_;
+};
+
+/// \brief Adds the deleted positions of a batch read from a position delete file.
+Status AddPositionDeletes(const ArrowSchema& schema, const ArrowArray& batch,
+                          std::unordered_map<std::string, PositionDeleteIndex>& deletes) {
+  ArrowError error;
+  ArrowArrayView array_view;
+  auto status = ArrowArrayViewInitFromSchema(&array_view, &schema, &error);
+  ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(status, error);
+  internal::ArrowArrayViewGuard view_guard(&array_view);
+  status = ArrowArrayViewSetArray(&array_view, &batch, &error);
+  ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(status, error);
+  if (array_view.n_children != 2) {
+    return InvalidArrowData("Expected 2 columns in position deletes, got {}",
+                            array_view.n_children);
+  }
+
+  const ArrowArrayView* path_view = array_view.children[0];
+  const ArrowArrayView* pos_view = array_view.children[1];
+  // Position delete files are sorted by path, so consecutive rows mostly share the
+  // index of the same data file.
+  std::string_view last_path;
+  PositionDeleteIndex* index = nullptr;
+  for (int64_t row = 0; row < batch.length; ++row) {
+    if (ArrowArrayViewIsNull(path_view, row) || ArrowArrayViewIsNull(pos_view, row)) {
+      return InvalidArgument("Position delete file has a null file path or position");
+    }
+    ArrowStringView path = ArrowArrayViewGetStringUnsafe(path_view, row);
+    std::string_view path_value(path.data, static_cast<size_t>(path.size_bytes));
+    if (index == nullptr || path_value != last_path) {
+      index = &deletes[std::string(path_value)];
+      last_path = path_value;
+    }
+    index->Delete(ArrowArrayViewGetIntUnsafe(pos_view, row));
+  }
+  return {};
+}
+
+}  // namespace
+
+class DeleteLoader::Impl {
+ public:
+  Impl(std::shared_ptr<FileIO> io, std::shared_ptr<Schema> schema,
+       std::shared_ptr<MemoryPool> memory_pool, std::optional<SpillOptions> spill)
+      : io_(std::move(io)),
+        schema_(std::move(schema)),
+        memory_pool_(std::move(memory_pool)) {
+    if (spill.has_value()) {
+      spill_ = std::make_unique<EqualityDeleteSpill>(std::move(spill.value()));
+    }
+  }
+
+  Result<std::shared_ptr<const PositionDeleteIndex>> LoadDeletionVector(
+      const DataFile& delete_file) {
+    if (!delete_file.content_offset.has_value() ||
+        !delete_file.content_size_in_bytes.has_value()) {
+      return InvalidArgument("Deletion vector {} has no content offset or size",
+                             delete_file.file_path);
+    }
+    const int64_t offset = delete_file.content_offset.value();
+    const int64_t size = delete_file.content_size_in_bytes.value();
+    return deletion_vectors_.GetOrLoad(
+        std::format("{}@{}", offset, delete_file.file_path),
+        [&]() -> Result<std::shared_ptr<const PositionDeleteIndex>> {
+          ICEBERG_ASSIGN_OR_RAISE(auto content, ReadPuffinFile(delete_file));
+          if (offset < 0 || size < 0 ||
+              static_cast<size_t>(offset + size) > content->size()) {
+            return InvalidArgument(
+                "Deletion vector at offset {} with size {} is out of bounds of {}",
+                offset, size, delete_file.file_path);
+          }
+          ICEBERG_ASSIGN_OR_RAISE(
+              auto index, PositionDeleteIndex::DeserializeDeletionVector(
+                              std::string_view(*content).substr(offset, size)));
+          if (index.Cardinality() != delete_file.record_count) {
+            return InvalidArgument(
+                "Deletion vector at offset {} of {} has {} positions, expected {}",
+                offset, delete_file.file_path, index.Cardinality(),
+                delete_file.record_count);
+          }
+          return std::make_shared<const PositionDeleteIndex>(std::move(index));
+        });
+  }
+
+  Result<std::shared_ptr<const PositionDeletesByPath>> LoadPositionDeleteFile(
+      const DataFile& delete_file) {
+    return position_delete_files_.GetOrLoad(
+        delete_file.file_path,
+        [&]() -> Result<std::shared_ptr<const PositionDeletesByPath>> {
+          const ReaderOptions options{
+              .path = delete_file.file_path,
+              .length = static_cast<size_t>(delete_file.file_size_in_bytes),
+              .io = io_,
+              .projection = std::make_shared<Schema>(std::vector<SchemaField>{
+                  MetadataColumns::kDeleteFilePath, MetadataColumns::kDeleteFilePos}),
+              .memory_pool = memory_pool_};
+          ICEBERG_ASSIGN_OR_RAISE(
+              auto reader, ReaderFactoryRegistry::Open(delete_file.file_format, options));
+
+          std::unordered_map<std::string, PositionDeleteIndex> deletes;
+          ICEBERG_ASSIGN_OR_RAISE(auto arrow_schema, reader->Schema());
+          internal::ArrowSchemaGuard schema_guard(&arrow_schema);
+          while (true) {
+            ICEBERG_ASSIGN_OR_RAISE(auto batch, reader->Next());
+            if (!batch.has_value()) {
+              break;
+            }
+            internal::ArrowArrayGuard array_guard(&batch.value());
+            ICEBERG_RETURN_UNEXPECTED(
+                AddPositionDeletes(arrow_schema, batch.value(), deletes));
+          }
+          ICEBERG_RETURN_UNEXPECTED(reader->Close());
+
+          auto deletes_by_path = std::make_shared<PositionDeletesByPath>();
+          deletes_by_path->reserve(deletes.size());
+          for (auto& [path, index] : deletes) {
+            deletes_by_path->emplace(
+                path, std::make_shared<const PositionDeleteIndex>(std::move(index)));
+          }
+          return deletes_by_path;
+        });
+  }
+
+  Result<std::shared_ptr<const EqualityDeleteSet>> LoadEqualityDeleteFile(
+      const DataFile& delete_file) {
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto deletes,
+        equality_delete_files_.GetOrLoad(
+            delete_file.file_path,
+            [&]() { return ReadEqualityDeleteFile(delete_file); }));
+    if (spill_ != nullptr) {
+      ICEBERG_RETURN_UNEXPECTED(
+          spill_->Use(equality_delete_files_, delete_file.file_path, deletes));
+    }
+    return deletes;
+  }
+
+  /// \brief Loads the merged rows of equality delete files with the same fields.
+  Result<std::shared_ptr<const EqualityDeleteSet>> LoadEqualityDeleteGroup(
+      const std::vector<const DataFile*>& delete_files) {
+    if (delete_files.size() == 1) {
+      return LoadEqualityDeleteFile(*delete_files.front());
+    }
+    std::string key;
+    for (const auto* delete_file : delete_files) {
+      key.append(delete_file->file_path).push_back('\n');
+    }
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto merged_deletes,
+        equality_delete_groups_.GetOrLoad(
+            key, [&]() -> Result<std::shared_ptr<const EqualityDeleteSet>> {
+              // Merged sets are only spilled once loaded, with the schema.
+              if (spill_ != nullptr && schema_ != nullptr) {
+                ICEBERG_ASSIGN_OR_RAISE(auto restored, spill_->Restore(key, *schema_));
+                if (restored != nullptr) {
+                  return restored;
+                }
+              }
+              std::optional<EqualityDeleteSet> merged;
+              for (const auto* delete_file : delete_files) {
+                ICEBERG_ASSIGN_OR_RAISE(auto deletes,
+                                        LoadEqualityDeleteFile(*delete_file));
+                if (!merged.has_value()) {
+                  ICEBERG_ASSIGN_OR_RAISE(
+                      merged,
+                      EqualityDeleteSet::Make(*schema_, deletes->equality_field_ids()));
+                }
+                ICEBERG_RETURN_UNEXPECTED(merged->Merge(*deletes));
+              }
+              return std::make_shared<const EqualityDeleteSet>(
+                  std::move(merged.value()));
+            }));
+    if (spill_ != nullptr) {
+      ICEBERG_RETURN_UNEXPECTED(
+          spill_->Use(equality_delete_groups_, key, merged_deletes));
+    }
+    return merged_deletes;
+  }
+
+  const std::shared_ptr<Schema>& schema() const { return schema_; }
+
+ private:
+  /// \brief Reads an equality delete file, or restores its spilled deletes.
+  Result<std::shared_ptr<const EqualityDeleteSet>> ReadEqualityDeleteFile(
+      const DataFile& delete_file) {
+    if (schema_ == nullptr) {
+      return InvalidArgument("Cannot load equality deletes of {} without a schema",
+                             delete_file.file_path);
+    }
+    if (spill_ != nullptr) {
+      ICEBERG_ASSIGN_OR_RAISE(auto restored,
+                              spill_->Restore(delete_file.file_path, *schema_));
+      if (restored != nullptr) {
+        return restored;
+      }
+    }
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto deletes, EqualityDeleteSet::Make(*schema_, delete_file.equality_ids));
+    const ReaderOptions options{
+        .path = delete_file.file_path,
+        .length = static_cast<size_t>(delete_file.file_size_in_bytes),
+        .io = io_,
+        .projection = deletes.schema(),
+        .memory_pool = memory_pool_};
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto reader, ReaderFactoryRegistry::Open(delete_file.file_format, options));
+
+    ICEBERG_ASSIGN_OR_RAISE(auto arrow_schema, reader->Schema());
+    internal::ArrowSchemaGuard schema_guard(&arrow_schema);
+    while (true) {
+      ICEBERG_ASSIGN_OR_RAISE(auto batch, reader->Next());
+      if (!batch.has_value()) {
+        break;
+      }
+      internal::ArrowArrayGuard array_guard(&batch.value());
+      ICEBERG_RETURN_UNEXPECTED(
+          deletes.Add(*deletes.schema(), arrow_schema, batch.value()));
+    }
+    ICEBERG_RETURN_UNEXPECTED(reader->Close());
+    return std::make_shared<const EqualityDeleteSet>(std::move(deletes));
+  }
+
+  // Puffin files are read whole once, because they usually hold the deletion vectors
+  // of many data files.
+  Result<std::shared_ptr<const std::string>> ReadPuffinFile(const DataFile& delete_file) {
+    return puffin_files_.GetOrLoad(
+        delete_file.file_path, [&]() -> Result<std::shared_ptr<const std::string>> {
+          ICEBERG_ASSIGN_OR_RAISE(
+              auto content,
+              io_->ReadFile(delete_file.file_path,
+                            static_cast<size_t>(delete_file.file_size_in_bytes)));
+          return std::make_shared<const std::string>(std::move(content));
+        });
+  }
+
+  std::shared_ptr<FileIO> io_;
+  std::shared_ptr<Schema> schema_;
+  std::shared_ptr<MemoryPool> memory_pool_;
+  LoadOnceMap<std::string> puffin_files_;
+  LoadOnceMap<PositionDeleteIndex> deletion_vectors_;
+  LoadOnceMap<PositionDeletesByPath> position_delete_files_;
+  LoadOnceMap<EqualityDeleteSet> equality_delete_files_;
+  // Merged equality deletes keyed by the paths of their delete files, which are the
+  // same for the data files of a partition.
+  LoadOnceMap<EqualityDeleteSet> equality_delete_groups_;
+  // Keeps the equality deletes within the memory budget, or null to keep them all.
+  std::unique_ptr<EqualityDeleteSpill> spill_;
+};
+
+DeleteLoader::DeleteLoader(std::shared_ptr<FileIO> io, std::shared_ptr<Schema> schema,
+                           std::shared_ptr<MemoryPool> memory_pool,
+                           std::optional<SpillOptions> spill)
+    : impl_(std::make_unique<Impl>(std::move(io), std::move(schema),
+                                   std::move(memory_pool), std::move(spill))) {}
+
+DeleteLoader::~DeleteLoader() = default;
+
+Result<std::shared_ptr<const PositionDeleteIndex>> DeleteLoader::LoadPositionDeletes(
+    const std::vector<std::shared_ptr<DataFile>>& delete_files,
+    const std::string& data_file_path) {
+  std::vector<std::shared_ptr<const PositionDeleteIndex>> indexes;
+  indexes.reserve(delete_files.size());
+  for (const auto& delete_file : delete_files) {
+    if (delete_file->content != DataFile::Content::kPositionDeletes) {
+      return InvalidArgument("{} is not a position delete file", delete_file->file_path);
+    }
+    if (delete_file->file_format == FileFormatType::kPuffin) {
+      ICEBERG_ASSIGN_OR_RAISE(auto index, impl_->LoadDeletionVector(*delete_file));
+      indexes.push_back(std::move(index));
+      continue;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto deletes_by_path,
+                            impl_->LoadPositionDeleteFile(*delete_file));
+    if (auto it = deletes_by_path->find(data_file_path); it != deletes_by_path->cend()) {
+      indexes.push_back(it->second);
+    }
+  }
+
+  // A single index is shared as is, which is the common case for deletion vectors.
+  if (indexes.size() == 1) {
+    return std::move(indexes.front());
+  }
+  auto merged = std::make_shared<PositionDeleteIndex>();
+  for (const auto& index : indexes) {
+    merged->Merge(*index);
+  }
+  return merged;
+}
+
+Result<std::vector<std::shared_ptr<const EqualityDeleteSet>>>
+DeleteLoader::LoadEqualityDeletes(
+    const std::vector<std::shared_ptr<DataFile>>& delete_files) {
+  // Delete files are grouped by their sorted equality field ids.
+  std::map<std::vector<int32_t>, std::vector<const DataFile*>> groups;
+  for (const auto& delete_file : delete_files) {
+    if (delete_file->content != DataFile::Content::kEqualityDeletes) {
+      return InvalidArgument("{} is not an equality delete file", delete_file->file_path);
+    }
+    auto field_ids = delete_file->equality_ids;
+    std::ranges::sort(field_ids);
+    auto duplicates = std::ranges::unique(field_ids);
+    field_ids.erase(duplicates.begin(), duplicates.end());
+    groups[std::move(field_ids)].push_back(delete_file.get());
+  }
+
+  std::vector<std::shared_ptr<const EqualityDeleteSet>> deletes;
+  deletes.reserve(groups.size());
+  for (const auto& [_, group] : groups) {
+    ICEBERG_ASSIGN_OR_RAISE(auto group_deletes, impl_->LoadEqualityDeleteGroup(group));
+    deletes.push_back(std::move(group_deletes));
+  }
+  return deletes;
+}
+
+const std::shared_ptr<Schema>& DeleteLoader::schema() const { return impl_->schema(); }
+
+}  // namespace iceberg
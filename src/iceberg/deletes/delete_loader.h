@@ -0,0 +1,102 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/deletes/delete_loader.h
+/// Loading of the delete files that apply to data files.
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/spill_options.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief Loads the deletes of data files from position delete files, deletion vectors
+/// and equality delete files.
+///
+/// Each delete file is read at most once per loader and the loaded deletes are shared
+/// by all data files that they apply to, so a single loader should be used for all
+/// tasks of a scan. The loader is thread-safe, concurrent loads of the same file wait
+/// for the first one to finish.
+///
+/// With spill options, the loaded equality deletes are kept within the memory budget:
+/// the least recently used sets beyond it are written to a local spill file and read
+/// back from there when they are used again, instead of reading their delete files
+/// again. Sets still used by a reader stay in memory until it releases them.
+class ICEBERG_EXPORT DeleteLoader {
+ public:
+  /// \brief Constructs a loader reading delete files with the given FileIO.
+  ///
+  /// \param io The FileIO to read delete files
+  /// \param schema The table schema, which resolves the equality fields of equality
+  /// delete files. Equality deletes cannot be loaded without it.
+  /// \param memory_pool The pool of the buffers of the delete file readers, their
+  /// default pool if null
+  /// \param spill Where and beyond which memory budget the equality deletes are
+  /// spilled, or std::nullopt to keep them all in memory
+  explicit DeleteLoader(std::shared_ptr<FileIO> io,
+                        std::shared_ptr<Schema> schema = nullptr,
+                        std::shared_ptr<MemoryPool> memory_pool = nullptr,
+                        std::optional<SpillOptions> spill = std::nullopt);
+
+  ~DeleteLoader();
+
+  DeleteLoader(const DeleteLoader&) = delete;
+  DeleteLoader& operator=(const DeleteLoader&) = delete;
+
+  /// \brief Loads the positions of a data file that are deleted by the delete files.
+  ///
+  /// \param delete_files Position delete files and deletion vectors that apply to
+  /// the data file. Position delete files may contain deletes of other data files,
+  /// which are ignored.
+  /// \param data_file_path The location of the data file.
+  /// \return A Result containing the deleted positions, or an error if a delete file
+  /// could not be read.
+  Result<std::shared_ptr<const PositionDeleteIndex>> LoadPositionDeletes(
+      const std::vector<std::shared_ptr<DataFile>>& delete_files,
+      const std::string& data_file_path);
+
+  /// \brief Loads the rows deleted by equality delete files.
+  ///
+  /// The rows of the delete files with the same equality fields are merged into one
+  /// set, which is shared by all data files with the same delete files, such as the
+  /// data files of a partition.
+  ///
+  /// \param delete_files Equality delete files that apply to a data file
+  /// \return A Result containing a set of deleted rows for each distinct set of
+  /// equality fields, or an error if a delete file could not be read.
+  Result<std::vector<std::shared_ptr<const EqualityDeleteSet>>> LoadEqualityDeletes(
+      const std::vector<std::shared_ptr<DataFile>>& delete_files);
+
+  /// \brief Returns the table schema of the loader, or null if it has none.
+  const std::shared_ptr<Schema>& schema() const;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace iceberg
@@ -0,0 +1,165 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/deletes/deletion_vector_writer.h"
+
+#include <map>
+#include <string_view>
+#include <utility>
+
+#include "iceberg/deletes/position_delete_index.h"
+#include "iceberg/file_format.h"
+#include "iceberg/file_io.h"
+#include "iceberg/metadata_columns.h"
+#include "iceberg/puffin/puffin_writer.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+class DeletionVectorWriter::Impl {
+ public:
+  explicit Impl(DeletionVectorWriterOptions options) : options_(std::move(options)) {}
+
+  Status Delete(const DataFile& data_file, int64_t position) {
+    if (position < 0) {
+      return InvalidArgument("Invalid position {} deleted from {}", position,
+                             data_file.file_path);
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto* vector, VectorOf(data_file));
+    vector->positions.Delete(position);
+    return {};
+  }
+
+  Status Delete(const DataFile& data_file, const PositionDeleteIndex& positions) {
+    ICEBERG_ASSIGN_OR_RAISE(auto* vector, VectorOf(data_file));
+    vector->positions.Merge(positions);
+    return {};
+  }
+
+  Result<std::vector<DataFile>> Close() {
+    if (closed_) {
+      return InvalidArgument("Deletion vector writer is closed");
+    }
+    closed_ = true;
+    auto vectors = std::exchange(vectors_, {});
+    std::erase_if(vectors,
+                  [](const auto& entry) { return entry.second.positions.IsEmpty(); });
+    std::vector<DataFile> delete_files;
+    if (vectors.empty()) {
+      return delete_files;
+    }
+
+    ICEBERG_ASSIGN_OR_RAISE(auto file, options_.io->NewOutputFile(options_.path));
+    ICEBERG_ASSIGN_OR_RAISE(auto writer, PuffinWriter::Make(std::move(file)));
+    for (const auto& [path, vector] : vectors) {
+      const std::string data = vector.positions.SerializeDeletionVector();
+      const int64_t cardinality = vector.positions.Cardinality();
+      ICEBERG_ASSIGN_OR_RAISE(
+          auto blob,
+          writer->Add(PuffinBlob{
+              .type = std::string(PuffinConstants::kDeletionVectorV1),
+              .fields = {MetadataColumns::kRowPosition.field_id()},
+              .data = data,
+              .properties = {{std::string(PuffinConstants::kReferencedDataFile), path},
+                             {std::string(PuffinConstants::kCardinality),
+                              std::to_string(cardinality)}}}));
+
+      DataFile delete_file;
+      delete_file.content = DataFile::Content::kPositionDeletes;
+      delete_file.file_path = options_.path;
+      delete_file.file_format = FileFormatType::kPuffin;
+      delete_file.partition = vector.partition;
+      delete_file.record_count = cardinality;
+      delete_file.partition_spec_id = vector.spec_id;
+      delete_file.referenced_data_file = path;
+      delete_file.content_offset = blob.offset;
+      delete_file.content_size_in_bytes = blob.length;
+      delete_files.push_back(std::move(delete_file));
+    }
+    ICEBERG_RETURN_UNEXPECTED(writer->Close());
+    for (auto& delete_file : delete_files) {
+      delete_file.file_size_in_bytes = writer->file_size();
+    }
+    return delete_files;
+  }
+
+ private:
+  struct Vector {
+    int32_t spec_id = 0;
+    std::vector<Literal> partition;
+    PositionDeleteIndex positions;
+  };
+
+  Result<Vector*> VectorOf(const DataFile& data_file) {
+    if (closed_) {
+      return InvalidArgument("Deletion vector writer is closed");
+    }
+    if (data_file.content != DataFile::Content::kData) {
+      return InvalidArgument("Cannot delete rows of {}, which is not a data file",
+                             data_file.file_path);
+    }
+    // Deletes usually come in runs of the same data file.
+    if (last_vector_ != nullptr && last_path_ == data_file.file_path) {
+      return last_vector_;
+    }
+    auto [it, inserted] = vectors_.try_emplace(data_file.file_path);
+    if (inserted) {
+      it->second.spec_id = data_file.partition_spec_id;
+      it->second.partition = data_file.partition;
+    }
+    last_path_ = it->first;
+    last_vector_ = &it->second;
+    return last_vector_;
+  }
+
+  DeletionVectorWriterOptions options_;
+  /// \brief The deletion vectors keyed by the paths of their data files, in the order
+  /// of their blobs.
+  std::map<std::string, Vector, std::less<>> vectors_;
+  std::string_view last_path_;
+  Vector* last_vector_ = nullptr;
+  bool closed_ = false;
+};
+
+DeletionVectorWriter::DeletionVectorWriter(std::unique_ptr<Impl> impl)
+    : impl_(std::move(impl)) {}
+
+DeletionVectorWriter::~DeletionVectorWriter() = default;
+
+Result<std::unique_ptr<DeletionVectorWriter>> DeletionVectorWriter::Make(
+    DeletionVectorWriterOptions options) {
+  if (options.path.empty() || options.io == nullptr) {
+    return InvalidArgument("Deletion vector writer requires a path and a FileIO");
+  }
+  return std::unique_ptr<DeletionVectorWriter>(
+      new DeletionVectorWriter(std::make_unique<Impl>(std::move(options))));
+}
+
+Status DeletionVectorWriter::Delete(const DataFile& data_file, int64_t position) {
+  return impl_->Delete(data_file, position);
+}
+
+Status DeletionVectorWriter::Delete(const DataFile& data_file,
+                                    const PositionDeleteIndex& positions) {
+  return impl_->Delete(data_file, positions);
+}
+
+Result<std::vector<DataFile>> DeletionVectorWriter::Close() { return impl_->Close(); }
+
+}  // namespace iceberg
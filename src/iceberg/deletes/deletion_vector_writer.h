@@ -0,0 +1,84 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/deletes/deletion_vector_writer.h
+/// Writer of the deletion vectors of data files into a Puffin file.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+class PositionDeleteIndex;
+
+/// \brief Options for creating a deletion vector writer.
+struct ICEBERG_EXPORT DeletionVectorWriterOptions {
+  /// \brief The location of the Puffin file.
+  std::string path;
+  /// \brief FileIO instance to write the Puffin file.
+  std::shared_ptr<FileIO> io;
+};
+
+/// \brief Writes the deleted rows of data files as deletion vectors.
+///
+/// The deleted positions of each data file are collected into a bitmap, which is
+/// serialized into a `deletion-vector-v1` blob of a single Puffin file when the writer
+/// is closed. Each deletion vector is a delete file of its own, which references its
+/// data file and the range of its blob in the Puffin file.
+class ICEBERG_EXPORT DeletionVectorWriter {
+ public:
+  ~DeletionVectorWriter();
+
+  /// \brief Creates a deletion vector writer.
+  static Result<std::unique_ptr<DeletionVectorWriter>> Make(
+      DeletionVectorWriterOptions options);
+
+  /// \brief Deletes a row of a data file.
+  ///
+  /// \param data_file The data file, whose partition is the partition of its deletion
+  /// vector
+  /// \param position The position of the row in the data file
+  /// \return InvalidArgument if the position is negative.
+  Status Delete(const DataFile& data_file, int64_t position);
+
+  /// \brief Deletes the positions of an index from a data file, such as the positions of
+  /// its previous deletion vector, which the new deletion vector replaces.
+  Status Delete(const DataFile& data_file, const PositionDeleteIndex& positions);
+
+  /// \brief Writes the Puffin file and returns a delete file for each deletion vector,
+  /// in the order of their data file paths. Nothing is written if no rows were deleted.
+  Result<std::vector<DataFile>> Close();
+
+ private:
+  class Impl;
+  explicit DeletionVectorWriter(std::unique_ptr<Impl> impl);
+
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace iceberg
@@ -0,0 +1,586 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/deletes/equality_delete_set.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+#include "iceberg/schema.h"
+#include "iceberg/type.h"
+#include "iceberg/util/binary_codec_internal.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/decimal.h"
+#include "iceberg/util/endian.h"
+#include "iceberg/util/int128.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+constexpr uint8_t kNullMarker = 0;
+constexpr uint8_t kValueMarker = 1;
+constexpr size_t kInitialSlots = 16;
+
+bool GetBit(const uint8_t* bitmap, int64_t index) {
+  return (bitmap[index >> 3] >> (index & 7)) & 1;
+}
+
+void ClearBit(uint8_t* bitmap, int64_t index) {
+  bitmap[index >> 3] &= static_cast<uint8_t>(~(1 << (index & 7)));
+}
+
+/// \brief Finds the positions of a field and its parents in nested structs.
+bool FindFieldPath(const StructType& type, int32_t field_id, std::vector<int32_t>& path) {
+  const auto fields = type.fields();
+  for (size_t pos = 0; pos < fields.size(); ++pos) {
+    path.push_back(static_cast<int32_t>(pos));
+    if (fields[pos].field_id() == field_id) {
+      return true;
+    }
+    const auto& field_type = fields[pos].type();
+    if (field_type->type_id() == TypeId::kStruct &&
+        FindFieldPath(internal::checked_cast<const StructType&>(*field_type), field_id,
+                      path)) {
+      return true;
+    }
+    path.pop_back();
+  }
+  return false;
+}
+
+/// \brief Values of variable length are preceded by their size in the keys.
+bool IsVariableLength(TypeId type_id) {
+  return type_id == TypeId::kString || type_id == TypeId::kBinary ||
+         type_id == TypeId::kDecimal;
+}
+
+/// \brief An equality field resolved in a batch.
+struct Column {
+  const Type* type;
+  const ArrowSchema* schema;
+  const ArrowArray* array;
+  // Index of the first row of the batch in the buffers of the column.
+  int64_t offset;
+  // Whether the value and all of its parent structs are non-null, for each row.
+  std::vector<uint8_t> valid;
+};
+
+Status CheckFormat(const Column& column, std::string_view expected) {
+  std::string_view format = column.schema->format;
+  if (!format.starts_with(expected)) {
+    return InvalidArrowData("Cannot read {} values from Arrow format {}",
+                            column.type->ToString(), format);
+  }
+  return {};
+}
+
+template <typename T>
+Result<const T*> Buffer(const Column& column, int64_t index) {
+  if (column.array->n_buffers <= index) {
+    return InvalidArrowData("Arrow array has {} buffers, expected at least {}",
+                            column.array->n_buffers, index + 1);
+  }
+  return static_cast<const T*>(column.array->buffers[index]);
+}
+
+/// \brief Calls `fn(row, bytes)` for each fixed-width value of a column, serialized in
+/// little endian like Conversions::ToBytes.
+template <typename T, typename Fn>
+Status ForEachFixedWidth(const Column& column, Fn&& fn) {
+  ICEBERG_ASSIGN_OR_RAISE(auto data, Buffer<T>(column, 1));
+  const auto length = static_cast<int64_t>(column.valid.size());
+  for (int64_t row = 0; row < length; ++row) {
+    if (!column.valid[row]) {
+      continue;
+    }
+    T value = data[column.offset + row];
+    if constexpr (std::is_floating_point_v<T>) {
+      // NaN values are equal regardless of their sign and payload.
+      if (std::isnan(value)) {
+        value = std::numeric_limits<T>::quiet_NaN();
+      }
+    }
+    value = ToLittleEndian(value);
+    fn(row, std::string_view(reinterpret_cast<const char*>(&value), sizeof(T)));
+  }
+  return {};
+}
+
+template <typename Offset, typename Fn>
+Status ForEachBinary(const Column& column, Fn&& fn) {
+  ICEBERG_ASSIGN_OR_RAISE(auto offsets, Buffer<Offset>(column, 1));
+  ICEBERG_ASSIGN_OR_RAISE(auto data, Buffer<char>(column, 2));
+  const auto length = static_cast<int64_t>(column.valid.size());
+  for (int64_t row = 0; row < length; ++row) {
+    if (column.valid[row]) {
+      const Offset start = offsets[column.offset + row];
+      const Offset end = offsets[column.offset + row + 1];
+      fn(row, std::string_view(data + start, static_cast<size_t>(end - start)));
+    }
+  }
+  return {};
+}
+
+/// \brief Calls `fn(row, bytes)` with the value of each non-null row of a column,
+/// serialized like Conversions::ToBytes.
+template <typename Fn>
+Status ForEachValue(const Column& column, Fn&& fn) {
+  const auto length = static_cast<int64_t>(column.valid.size());
+  switch (column.type->type_id()) {
+    case TypeId::kBoolean: {
+      ICEBERG_RETURN_UNEXPECTED(CheckFormat(column, "b"));
+      ICEBERG_ASSIGN_OR_RAISE(auto bits, Buffer<uint8_t>(column, 1));
+      for (int64_t row = 0; row < length; ++row) {
+        if (column.valid[row]) {
+          const char value = GetBit(bits, column.offset + row) ? 1 : 0;
+          fn(row, std::string_view(&value, 1));
+        }
+      }
+      return {};
+    }
+    case TypeId::kInt:
+    case TypeId::kDate:
+      ICEBERG_RETURN_UNEXPECTED(
+          CheckFormat(column, column.type->type_id() == TypeId::kInt ? "i" : "tdD"));
+      return ForEachFixedWidth<int32_t>(column, fn);
+    case TypeId::kLong:
+    case TypeId::kTime:
+    case TypeId::kTimestamp:
+    case TypeId::kTimestampTz: {
+      const TypeId type_id = column.type->type_id();
+      ICEBERG_RETURN_UNEXPECTED(CheckFormat(column, type_id == TypeId::kLong   ? "l"
+                                                    : type_id == TypeId::kTime ? "ttu"
+                                                                               : "tsu:"));
+      return ForEachFixedWidth<int64_t>(column, fn);
+    }
+    case TypeId::kFloat:
+      ICEBERG_RETURN_UNEXPECTED(CheckFormat(column, "f"));
+      return ForEachFixedWidth<float>(column, fn);
+    case TypeId::kDouble:
+      ICEBERG_RETURN_UNEXPECTED(CheckFormat(column, "g"));
+      return ForEachFixedWidth<double>(column, fn);
+    case TypeId::kDecimal: {
+      ICEBERG_RETURN_UNEXPECTED(CheckFormat(column, "d:"));
+      std::string_view format = column.schema->format;
+      if (std::ranges::count(format, ',') > 1 && !format.ends_with(",128")) {
+        return NotSupported("Unsupported Arrow decimal format: {}", format);
+      }
+      ICEBERG_ASSIGN_OR_RAISE(auto data, Buffer<uint8_t>(column, 1));
+      for (int64_t row = 0; row < length; ++row) {
+        if (!column.valid[row]) {
+          continue;
+        }
+        int128_t unscaled;
+        std::memcpy(&unscaled, data + (column.offset + row) * Decimal::kByteWidth,
+                    Decimal::kByteWidth);
+        const auto bytes = Decimal(unscaled).ToBigEndian();
+        fn(row, std::string_view(reinterpret_cast<const char*>(bytes.data()),
+                                 bytes.size()));
+      }
+      return {};
+    }
+    case TypeId::kString:
+    case TypeId::kBinary: {
+      const bool is_string = column.type->type_id() == TypeId::kString;
+      std::string_view format = column.schema->format;
+      if (format == (is_string ? "u" : "z")) {
+        return ForEachBinary<int32_t>(column, fn);
+      }
+      if (format == (is_string ? "U" : "Z")) {
+        return ForEachBinary<int64_t>(column, fn);
+      }
+      return InvalidArrowData("Cannot read {} values from Arrow format {}",
+                              column.type->ToString(), format);
+    }
+    case TypeId::kFixed:
+    case TypeId::kUuid: {
+      ICEBERG_RETURN_UNEXPECTED(CheckFormat(column, "w:"));
+      const int32_t width =
+          column.type->type_id() == TypeId::kUuid
+              ? 16
+              : internal::checked_cast<const FixedType&>(*column.type).length();
+      std::string_view format = column.schema->format;
+      int32_t format_width = 0;
+      auto [ptr, ec] =
+          std::from_chars(format.data() + 2, format.data() + format.size(), format_width);
+      if (ec != std::errc() || format_width != width) {
+        return InvalidArrowData("Cannot read {} values from Arrow format {}",
+                                column.type->ToString(), format);
+      }
+      ICEBERG_ASSIGN_OR_RAISE(auto data, Buffer<char>(column, 1));
+      for (int64_t row = 0; row < length; ++row) {
+        if (column.valid[row]) {
+          fn(row, std::string_view(data + (column.offset + row) * width,
+                                   static_cast<size_t>(width)));
+        }
+      }
+      return {};
+    }
+    default:
+      return NotSupported("Cannot compare {} values of equality deletes",
+                          column.type->ToString());
+  }
+}
+
+/// \brief The keys of the rows of a batch, stored back to back.
+struct BatchKeys {
+  std::string_view operator[](int64_t row) const {
+    return std::string_view(bytes).substr(offsets[row], offsets[row + 1] - offsets[row]);
+  }
+
+  std::string bytes;
+  std::vector<size_t> offsets;
+  std::vector<uint64_t> hashes;
+};
+
+/// \brief Encodes and hashes the keys of all rows of a batch, one column at a time.
+Result<BatchKeys> EncodeKeys(const std::vector<Column>& columns, int64_t length) {
+  // The sizes of the keys are computed first, so that each column writes its values
+  // in place.
+  std::vector<size_t> sizes(length, 0);
+  for (const auto& column : columns) {
+    const size_t header = IsVariableLength(column.type->type_id()) ? sizeof(uint32_t) : 0;
+    for (auto& size : sizes) {
+      size += 1;
+    }
+    ICEBERG_RETURN_UNEXPECTED(ForEachValue(
+        column, [&](int64_t row, std::string_view value) {
+          sizes[row] += header + value.size();
+        }));
+  }
+
+  BatchKeys keys;
+  keys.offsets.resize(length + 1, 0);
+  for (int64_t row = 0; row < length; ++row) {
+    keys.offsets[row + 1] = keys.offsets[row] + sizes[row];
+  }
+  keys.bytes.resize(keys.offsets.back(), static_cast<char>(kNullMarker));
+  std::vector<size_t> cursors(keys.offsets.begin(), keys.offsets.end() - 1);
+  for (const auto& column : columns) {
+    const bool variable_length = IsVariableLength(column.type->type_id());
+    for (int64_t row = 0; row < length; ++row) {
+      // Null values are only the null marker, which is already written.
+      cursors[row] += column.valid[row] ? 0 : 1;
+    }
+    ICEBERG_RETURN_UNEXPECTED(
+        ForEachValue(column, [&](int64_t row, std::string_view value) {
+          char* out = keys.bytes.data() + cursors[row];
+          *out++ = static_cast<char>(kValueMarker);
+          if (variable_length) {
+            const uint32_t size = ToLittleEndian(static_cast<uint32_t>(value.size()));
+            std::memcpy(out, &size, sizeof(size));
+            out += sizeof(size);
+          }
+          std::memcpy(out, value.data(), value.size());
+          cursors[row] = out + value.size() - keys.bytes.data();
+        }));
+  }
+
+  keys.hashes.resize(length);
+  const std::hash<std::string_view> hash;
+  for (int64_t row = 0; row < length; ++row) {
+    keys.hashes[row] = hash(keys[row]);
+  }
+  return keys;
+}
+
+}  // namespace
+
+class EqualityDeleteSet::Impl {
+ public:
+  /// \brief Resolves the equality fields in a batch.
+  Result<std::vector<Column>> Resolve(const Schema& schema,
+                                      const ArrowSchema& arrow_schema,
+                                      const ArrowArray& array) const {
+    if (std::string_view(arrow_schema.format) != "+s") {
+      return InvalidArrowData("Expected a struct array for equality deletes, got {}",
+                              arrow_schema.format);
+    }
+    std::vector<Column> columns;
+    columns.reserve(field_ids.size());
+    for (size_t i = 0; i < field_ids.size(); ++i) {
+      std::vector<int32_t> path;
+      if (!FindFieldPath(schema, field_ids[i], path)) {
+        return InvalidArgument("Equality field {} is not in the schema of the batch",
+                               field_ids[i]);
+      }
+      Column column{.type = types[i].get(),
+                    .schema = &arrow_schema,
+                    .array = &array,
+                    .offset = array.offset,
+                    .valid = std::vector<uint8_t>(array.length, 1)};
+      ICEBERG_RETURN_UNEXPECTED(AndValidity(column));
+      for (int32_t pos : path) {
+        if (std::string_view(column.schema->format) != "+s") {
+          return InvalidArrowData("Expected a struct array for field {}, got format {}",
+                                  field_ids[i], column.schema->format);
+        }
+        if (pos >= column.schema->n_children || pos >= column.array->n_children) {
+          return InvalidArrowData(
+              "Cannot find field {} at position {} of a struct with {} children",
+              field_ids[i], pos, column.array->n_children);
+        }
+        const ArrowArray* child = column.array->children[pos];
+        if (child->length < column.offset + array.length) {
+          return InvalidArrowData("Child array of field {} is too short: {} < {}",
+                                  field_ids[i], child->length,
+                                  column.offset + array.length);
+        }
+        column.schema = column.schema->children[pos];
+        column.array = child;
+        column.offset += child->offset;
+        ICEBERG_RETURN_UNEXPECTED(AndValidity(column));
+      }
+      columns.push_back(std::move(column));
+    }
+    return columns;
+  }
+
+  bool Contains(uint64_t hash, std::string_view key) const {
+    if (slots.empty()) {
+      return false;
+    }
+    const size_t mask = slots.size() - 1;
+    for (size_t slot = hash & mask; slots[slot] != 0; slot = (slot + 1) & mask) {
+      const uint32_t entry = slots[slot] - 1;
+      if (hashes[entry] == hash && Key(entry) == key) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void Insert(uint64_t hash, std::string_view key) {
+    if (Contains(hash, key)) {
+      return;
+    }
+    // The table is kept at most half full, so that probe sequences stay short.
+    if ((hashes.size() + 1) * 2 > slots.size()) {
+      Grow();
+    }
+    keys.append(key);
+    offsets.push_back(keys.size());
+    hashes.push_back(hash);
+    Place(static_cast<uint32_t>(hashes.size()));
+  }
+
+  std::string_view Key(uint32_t entry) const {
+    return std::string_view(keys).substr(offsets[entry],
+                                         offsets[entry + 1] - offsets[entry]);
+  }
+
+  /// \brief Ids of the equality fields, in increasing order.
+  std::vector<int32_t> field_ids;
+  /// \brief Types of the equality fields, in the order of their ids.
+  std::vector<std::shared_ptr<Type>> types;
+  std::shared_ptr<Schema> schema;
+  /// \brief The deleted keys, stored back to back.
+  std::string keys;
+  /// \brief Offsets of the deleted keys, followed by the size of `keys`.
+  std::vector<size_t> offsets{0};
+  /// \brief Hashes of the deleted keys.
+  std::vector<uint64_t> hashes;
+  /// \brief Open addressing table of key indexes plus one, where 0 is an empty slot.
+  std::vector<uint32_t> slots;
+
+  int64_t size_bytes() const {
+    return static_cast<int64_t>(keys.capacity() + offsets.capacity() * sizeof(size_t) +
+                                hashes.capacity() * sizeof(uint64_t) +
+                                slots.capacity() * sizeof(uint32_t));
+  }
+
+ private:
+  static Status AndValidity(Column& column) {
+    if (column.array->null_count == 0) {
+      return {};
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto bitmap, Buffer<uint8_t>(column, 0));
+    if (bitmap == nullptr) {
+      return {};
+    }
+    for (size_t row = 0; row < column.valid.size(); ++row) {
+      column.valid[row] &= GetBit(bitmap, column.offset + static_cast<int64_t>(row));
+    }
+    return {};
+  }
+
+  void Place(uint32_t entry_plus_one) {
+    const size_t mask = slots.size() - 1;
+    size_t slot = hashes[entry_plus_one - 1] & mask;
+    while (slots[slot] != 0) {
+      slot = (slot + 1) & mask;
+    }
+    slots[slot] = entry_plus_one;
+  }
+
+  void Grow() {
+    slots.assign(std::max(kInitialSlots, slots.size() * 2), 0);
+    for (size_t entry = 0; entry < hashes.size(); ++entry) {
+      Place(static_cast<uint32_t>(entry + 1));
+    }
+  }
+};
+
+EqualityDeleteSet::EqualityDeleteSet(std::unique_ptr<Impl> impl)
+    : impl_(std::move(impl)) {}
+
+EqualityDeleteSet::~EqualityDeleteSet() = default;
+
+EqualityDeleteSet::EqualityDeleteSet(EqualityDeleteSet&&) noexcept = default;
+
+EqualityDeleteSet& EqualityDeleteSet::operator=(EqualityDeleteSet&&) noexcept = default;
+
+Result<EqualityDeleteSet> EqualityDeleteSet::Make(
+    const Schema& schema, std::vector<int32_t> equality_field_ids) {
+  if (equality_field_ids.empty()) {
+    return InvalidArgument("Equality deletes must have at least one equality field");
+  }
+  std::ranges::sort(equality_field_ids);
+  auto duplicates = std::ranges::unique(equality_field_ids);
+  equality_field_ids.erase(duplicates.begin(), duplicates.end());
+
+  auto impl = std::make_unique<Impl>();
+  for (int32_t field_id : equality_field_ids) {
+    std::vector<int32_t> path;
+    if (!FindFieldPath(schema, field_id, path)) {
+      return InvalidArgument(
+          "Equality field {} is not a field of the schema or is nested in a list or map",
+          field_id);
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto field, schema.FindFieldById(field_id));
+    const auto& type = field.value().get().type();
+    if (!type->is_primitive()) {
+      return InvalidArgument("Equality field {} is not a primitive field: {}", field_id,
+                             type->ToString());
+    }
+    impl->types.push_back(type);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto projected, schema.Project(std::unordered_set<int32_t>(
+                          equality_field_ids.begin(), equality_field_ids.end())));
+  impl->schema = std::move(projected);
+  impl->field_ids = std::move(equality_field_ids);
+  return EqualityDeleteSet(std::move(impl));
+}
+
+const std::vector<int32_t>& EqualityDeleteSet::equality_field_ids() const {
+  return impl_->field_ids;
+}
+
+const std::shared_ptr<Schema>& EqualityDeleteSet::schema() const { return impl_->schema; }
+
+Status EqualityDeleteSet::Add(const Schema& schema, const ArrowSchema& arrow_schema,
+                              const ArrowArray& array) {
+  ICEBERG_ASSIGN_OR_RAISE(auto columns, impl_->Resolve(schema, arrow_schema, array));
+  ICEBERG_ASSIGN_OR_RAISE(auto keys, EncodeKeys(columns, array.length));
+  for (int64_t row = 0; row < array.length; ++row) {
+    impl_->Insert(keys.hashes[row], keys[row]);
+  }
+  return {};
+}
+
+Status EqualityDeleteSet::Merge(const EqualityDeleteSet& other) {
+  if (other.impl_->field_ids != impl_->field_ids) {
+    return InvalidArgument("Cannot merge equality deletes of different fields");
+  }
+  for (size_t entry = 0; entry < other.impl_->hashes.size(); ++entry) {
+    impl_->Insert(other.impl_->hashes[entry],
+                  other.impl_->Key(static_cast<uint32_t>(entry)));
+  }
+  return {};
+}
+
+Status EqualityDeleteSet::RemoveDeleted(const Schema& schema,
+                                        const ArrowSchema& arrow_schema,
+                                        const ArrowArray& array,
+                                        std::span<uint8_t> selection) const {
+  if (static_cast<int64_t>(selection.size()) < (array.length + 7) / 8) {
+    return InvalidArgument("Selection of {} bytes is too short for {} rows",
+                           selection.size(), array.length);
+  }
+  if (IsEmpty()) {
+    return {};
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto columns, impl_->Resolve(schema, arrow_schema, array));
+  ICEBERG_ASSIGN_OR_RAISE(auto keys, EncodeKeys(columns, array.length));
+  for (int64_t row = 0; row < array.length; ++row) {
+    if (GetBit(selection.data(), row) &&
+        impl_->Contains(keys.hashes[row], keys[row])) {
+      ClearBit(selection.data(), row);
+    }
+  }
+  return {};
+}
+
+int64_t EqualityDeleteSet::size() const {
+  return static_cast<int64_t>(impl_->hashes.size());
+}
+
+bool EqualityDeleteSet::IsEmpty() const { return impl_->hashes.empty(); }
+
+int64_t EqualityDeleteSet::size_bytes() const { return impl_->size_bytes(); }
+
+std::vector<uint8_t> EqualityDeleteSet::Serialize() const {
+  BinaryWriter writer;
+  writer.Varint(impl_->field_ids.size());
+  for (int32_t field_id : impl_->field_ids) {
+    writer.Long(field_id);
+  }
+  writer.Varint(impl_->hashes.size());
+  for (size_t entry = 0; entry < impl_->hashes.size(); ++entry) {
+    writer.String(impl_->Key(static_cast<uint32_t>(entry)));
+  }
+  return std::move(writer).Finish();
+}
+
+Result<EqualityDeleteSet> EqualityDeleteSet::Deserialize(const Schema& schema,
+                                                         std::span<const uint8_t> data) {
+  BinaryReader reader(data);
+  ICEBERG_ASSIGN_OR_RAISE(auto field_count, reader.Count());
+  std::vector<int32_t> field_ids;
+  field_ids.reserve(field_count);
+  for (size_t i = 0; i < field_count; ++i) {
+    ICEBERG_ASSIGN_OR_RAISE(auto field_id, reader.Int());
+    field_ids.push_back(field_id);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto deletes, Make(schema, std::move(field_ids)));
+  ICEBERG_ASSIGN_OR_RAISE(auto key_count, reader.Count());
+  const std::hash<std::string_view> hash;
+  for (size_t i = 0; i < key_count; ++i) {
+    ICEBERG_ASSIGN_OR_RAISE(auto bytes, reader.Bytes());
+    const std::string_view key(reinterpret_cast<const char*>(bytes.data()),
+                               bytes.size());
+    deletes.impl_->Insert(hash(key), key);
+  }
+  if (!reader.AtEnd()) {
+    return Invalid("Unexpected data at the end of the equality deletes");
+  }
+  return deletes;
+}
+
+}  // namespace iceberg
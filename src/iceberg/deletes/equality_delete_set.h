@@ -0,0 +1,123 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/deletes/equality_delete_set.h
+/// Hash set of the rows deleted by equality delete files.
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "iceberg/arrow_c_data.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief The set of rows deleted by equality delete files with the same equality
+/// fields.
+///
+/// Rows are keyed by the concatenated values of their equality fields, each serialized
+/// with Conversions::ToBytes and preceded by a null marker, so that all primitive types
+/// are supported and null values match null values. NaN values are normalized, so that
+/// all NaN values are equal. Keys are stored in a single buffer indexed by an open
+/// addressing hash table.
+///
+/// Batches are probed column by column: the keys of all rows of a batch are encoded
+/// and hashed before they are looked up, instead of comparing rows one at a time.
+class ICEBERG_EXPORT EqualityDeleteSet {
+ public:
+  ~EqualityDeleteSet();
+
+  EqualityDeleteSet(EqualityDeleteSet&&) noexcept;
+  EqualityDeleteSet& operator=(EqualityDeleteSet&&) noexcept;
+  EqualityDeleteSet(const EqualityDeleteSet&) = delete;
+  EqualityDeleteSet& operator=(const EqualityDeleteSet&) = delete;
+
+  /// \brief Creates an empty set of deleted rows.
+  ///
+  /// \param schema The table schema
+  /// \param equality_field_ids Ids of the equality fields, which must be primitive
+  /// fields of the schema that are not nested in lists or maps
+  /// \return A Result containing the set, or an error if a field is invalid.
+  static Result<EqualityDeleteSet> Make(const Schema& schema,
+                                        std::vector<int32_t> equality_field_ids);
+
+  /// \brief Returns the ids of the equality fields, in increasing order.
+  const std::vector<int32_t>& equality_field_ids() const;
+
+  /// \brief Returns the projection of the table schema on the equality fields.
+  const std::shared_ptr<Schema>& schema() const;
+
+  /// \brief Adds the rows of a batch read from an equality delete file.
+  ///
+  /// \param schema The schema of the batch, which must contain the equality fields
+  /// \param arrow_schema The Arrow schema of the batch
+  /// \param array The struct array of the batch
+  Status Add(const Schema& schema, const ArrowSchema& arrow_schema,
+             const ArrowArray& array);
+
+  /// \brief Adds the rows of another set with the same equality fields.
+  Status Merge(const EqualityDeleteSet& other);
+
+  /// \brief Clears the bits of the deleted rows of a batch in a selection bitmap.
+  ///
+  /// \param schema The schema of the batch, which must contain the equality fields
+  /// \param arrow_schema The Arrow schema of the batch
+  /// \param array The struct array of the batch
+  /// \param selection A bitmap in Arrow validity layout with a bit for each row of the
+  /// batch, ignoring the offset of the array
+  Status RemoveDeleted(const Schema& schema, const ArrowSchema& arrow_schema,
+                       const ArrowArray& array, std::span<uint8_t> selection) const;
+
+  /// \brief Returns the number of distinct deleted rows.
+  int64_t size() const;
+
+  /// \brief Returns whether no row is deleted.
+  bool IsEmpty() const;
+
+  /// \brief Returns the memory in bytes held by the keys and the hash table.
+  int64_t size_bytes() const;
+
+  /// \brief Serializes the equality field ids and the deleted keys.
+  ///
+  /// The keys are written as they are stored, so the serialized set takes about the
+  /// size of its keys. The hash table is not written.
+  std::vector<uint8_t> Serialize() const;
+
+  /// \brief Deserializes a set written by Serialize(), rebuilding its hash table.
+  ///
+  /// \param schema The table schema of the serialized set
+  /// \param data The serialized set
+  /// \return A Result containing the set, or an error if the data is invalid.
+  static Result<EqualityDeleteSet> Deserialize(const Schema& schema,
+                                               std::span<const uint8_t> data);
+
+ private:
+  class Impl;
+  explicit EqualityDeleteSet(std::unique_ptr<Impl> impl);
+
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace iceberg
@@ -0,0 +1,253 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/deletes/position_delete_index.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <map>
+#include <optional>
+#include <vector>
+
+#include "iceberg/util/endian.h"
+#include "roaring/roaring.hh"
+
+namespace iceberg {
+
+namespace {
+
+constexpr std::array<uint8_t, 4> kDeletionVectorMagic = {0xD1, 0xD3, 0x39, 0x64};
+constexpr size_t kLengthSize = sizeof(uint32_t);
+constexpr size_t kCrcSize = sizeof(uint32_t);
+constexpr uint64_t kBitmapRange = uint64_t{1} << 32;
+
+uint32_t HighBits(int64_t position) { return static_cast<uint32_t>(position >> 32); }
+
+uint32_t LowBits(int64_t position) { return static_cast<uint32_t>(position); }
+
+int64_t ToPosition(uint32_t key, uint32_t low) {
+  return static_cast<int64_t>((static_cast<uint64_t>(key) << 32) | low);
+}
+
+template <typename T>
+void Append(std::string& out, T value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T Load(const char* data) {
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return value;
+}
+
+uint32_t Crc32(std::string_view data) {
+  return static_cast<uint32_t>(crc32(crc32(0L, Z_NULL, 0),
+                                     reinterpret_cast<const Bytef*>(data.data()),
+                                     static_cast<uInt>(data.size())));
+}
+
+}  // namespace
+
+class PositionDeleteIndex::Impl {
+ public:
+  /// \brief Bitmaps of the lower 32 bits of the positions, keyed by the upper 32 bits.
+  std::map<uint32_t, roaring::Roaring> bitmaps;
+};
+
+PositionDeleteIndex::PositionDeleteIndex() : impl_(std::make_unique<Impl>()) {}
+
+PositionDeleteIndex::~PositionDeleteIndex() = default;
+
+PositionDeleteIndex::PositionDeleteIndex(PositionDeleteIndex&&) noexcept = default;
+
+PositionDeleteIndex& PositionDeleteIndex::operator=(PositionDeleteIndex&&) noexcept =
+    default;
+
+void PositionDeleteIndex::Delete(int64_t position) {
+  if (position < 0) {
+    return;
+  }
+  impl_->bitmaps[HighBits(position)].add(LowBits(position));
+}
+
+void PositionDeleteIndex::Delete(int64_t begin, int64_t end) {
+  begin = std::max<int64_t>(begin, 0);
+  if (begin >= end) {
+    return;
+  }
+  const uint32_t first_key = HighBits(begin);
+  const uint32_t last_key = HighBits(end - 1);
+  for (uint64_t key = first_key; key <= last_key; ++key) {
+    const uint64_t low = key == first_key ? LowBits(begin) : 0;
+    const uint64_t high = key == last_key ? uint64_t{LowBits(end - 1)} + 1 : kBitmapRange;
+    impl_->bitmaps[static_cast<uint32_t>(key)].addRange(low, high);
+  }
+}
+
+void PositionDeleteIndex::Merge(const PositionDeleteIndex& other) {
+  for (const auto& [key, bitmap] : other.impl_->bitmaps) {
+    impl_->bitmaps[key] |= bitmap;
+  }
+}
+
+bool PositionDeleteIndex::IsDeleted(int64_t position) const {
+  if (position < 0) {
+    return false;
+  }
+  auto it = impl_->bitmaps.find(HighBits(position));
+  return it != impl_->bitmaps.cend() && it->second.contains(LowBits(position));
+}
+
+bool PositionDeleteIndex::IsEmpty() const {
+  for (const auto& [_, bitmap] : impl_->bitmaps) {
+    if (!bitmap.isEmpty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int64_t PositionDeleteIndex::Cardinality() const {
+  int64_t cardinality = 0;
+  for (const auto& [_, bitmap] : impl_->bitmaps) {
+    cardinality += static_cast<int64_t>(bitmap.cardinality());
+  }
+  return cardinality;
+}
+
+void PositionDeleteIndex::ForEach(int64_t begin, int64_t end,
+                                  const std::function<void(int64_t)>& visitor) const {
+  begin = std::max<int64_t>(begin, 0);
+  if (begin >= end) {
+    return;
+  }
+  const uint32_t first_key = HighBits(begin);
+  const uint32_t last_key = HighBits(end - 1);
+  std::vector<uint32_t> values;
+  for (auto it = impl_->bitmaps.lower_bound(first_key);
+       it != impl_->bitmaps.cend() && it->first <= last_key; ++it) {
+    const auto& [key, bitmap] = *it;
+    const uint32_t low = key == first_key ? LowBits(begin) : 0;
+    const uint32_t last = key == last_key ? LowBits(end - 1)
+                                            : std::numeric_limits<uint32_t>::max();
+    // Ranks count the values less than or equal to their argument.
+    const uint64_t first_rank = low == 0 ? 0 : bitmap.rank(low - 1);
+    const uint64_t count = bitmap.rank(last) - first_rank;
+    values.resize(count);
+    if (count == 0 || !bitmap.rangeUint32Array(values.data(), first_rank, count)) {
+      continue;
+    }
+    for (uint32_t value : values) {
+      visitor(ToPosition(key, value));
+    }
+  }
+}
+
+std::string PositionDeleteIndex::SerializeDeletionVector() const {
+  uint64_t bitmap_count = 0;
+  for (const auto& [_, bitmap] : impl_->bitmaps) {
+    bitmap_count += bitmap.isEmpty() ? 0 : 1;
+  }
+
+  std::string blob(kLengthSize, '\0');
+  blob.append(reinterpret_cast<const char*>(kDeletionVectorMagic.data()),
+              kDeletionVectorMagic.size());
+  Append(blob, ToLittleEndian(bitmap_count));
+  for (const auto& [key, bitmap] : impl_->bitmaps) {
+    if (bitmap.isEmpty()) {
+      continue;
+    }
+    Append(blob, ToLittleEndian(key));
+    const size_t offset = blob.size();
+    blob.resize(offset + bitmap.getSizeInBytes(/*portable=*/true));
+    bitmap.write(blob.data() + offset, /*portable=*/true);
+  }
+
+  // The length and the checksum cover the magic bytes and the bitmaps.
+  const auto vector_size = static_cast<uint32_t>(blob.size() - kLengthSize);
+  const uint32_t length = ToBigEndian(vector_size);
+  std::memcpy(blob.data(), &length, kLengthSize);
+  Append(blob, ToBigEndian(Crc32(std::string_view(blob).substr(kLengthSize))));
+  return blob;
+}
+
+Result<PositionDeleteIndex> PositionDeleteIndex::DeserializeDeletionVector(
+    std::string_view blob) {
+  constexpr size_t kMinVectorSize = kDeletionVectorMagic.size() + sizeof(uint64_t);
+  if (blob.size() < kLengthSize + kMinVectorSize + kCrcSize) {
+    return InvalidArgument("Deletion vector blob is too short: {} bytes", blob.size());
+  }
+  const uint32_t vector_size = FromBigEndian(Load<uint32_t>(blob.data()));
+  if (vector_size != blob.size() - kLengthSize - kCrcSize) {
+    return InvalidArgument("Deletion vector length {} does not match blob size {}",
+                           vector_size, blob.size());
+  }
+  const std::string_view vector = blob.substr(kLengthSize, vector_size);
+  if (std::memcmp(vector.data(), kDeletionVectorMagic.data(),
+                  kDeletionVectorMagic.size()) != 0) {
+    return InvalidArgument("Invalid magic bytes in deletion vector");
+  }
+  const uint32_t checksum =
+      FromBigEndian(Load<uint32_t>(blob.data() + blob.size() - kCrcSize));
+  if (checksum != Crc32(vector)) {
+    return InvalidArgument("Deletion vector checksum mismatch");
+  }
+
+  PositionDeleteIndex index;
+  std::string_view bitmaps = vector.substr(kDeletionVectorMagic.size());
+  const uint64_t bitmap_count = FromLittleEndian(Load<uint64_t>(bitmaps.data()));
+  bitmaps.remove_prefix(sizeof(uint64_t));
+  std::optional<uint32_t> last_key;
+  for (uint64_t i = 0; i < bitmap_count; ++i) {
+    if (bitmaps.size() < sizeof(uint32_t)) {
+      return InvalidArgument("Deletion vector is truncated");
+    }
+    const uint32_t key = FromLittleEndian(Load<uint32_t>(bitmaps.data()));
+    bitmaps.remove_prefix(sizeof(uint32_t));
+    if (last_key.has_value() && key <= *last_key) {
+      return InvalidArgument("Deletion vector keys are not increasing");
+    }
+    last_key = key;
+
+    roaring::Roaring bitmap;
+    try {
+      bitmap = roaring::Roaring::readSafe(bitmaps.data(), bitmaps.size());
+    } catch (const std::exception& e) {
+      return InvalidArgument("Invalid bitmap in deletion vector: {}", e.what());
+    }
+    const size_t bitmap_size = bitmap.getSizeInBytes(/*portable=*/true);
+    if (bitmap_size > bitmaps.size()) {
+      return InvalidArgument("Deletion vector is truncated");
+    }
+    bitmaps.remove_prefix(bitmap_size);
+    index.impl_->bitmaps.emplace(key, std::move(bitmap));
+  }
+  if (!bitmaps.empty()) {
+    return InvalidArgument("Deletion vector has {} trailing bytes", bitmaps.size());
+  }
+  return index;
+}
+
+}  // namespace iceberg
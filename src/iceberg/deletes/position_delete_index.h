@@ -0,0 +1,90 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/deletes/position_delete_index.h
+/// Bitmap of the deleted row positions of a data file.
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+
+namespace iceberg {
+
+/// \brief The set of deleted row positions of a data file.
+///
+/// Positions are stored in roaring bitmaps keyed by their upper 32 bits, which is the
+/// layout of the deletion vectors of the Iceberg v3 spec.
+class ICEBERG_EXPORT PositionDeleteIndex {
+ public:
+  PositionDeleteIndex();
+  ~PositionDeleteIndex();
+
+  PositionDeleteIndex(PositionDeleteIndex&&) noexcept;
+  PositionDeleteIndex& operator=(PositionDeleteIndex&&) noexcept;
+  PositionDeleteIndex(const PositionDeleteIndex&) = delete;
+  PositionDeleteIndex& operator=(const PositionDeleteIndex&) = delete;
+
+  /// \brief Marks a position as deleted. Negative positions are ignored.
+  void Delete(int64_t position);
+
+  /// \brief Marks the positions in [begin, end) as deleted.
+  void Delete(int64_t begin, int64_t end);
+
+  /// \brief Marks all positions deleted in another index as deleted.
+  void Merge(const PositionDeleteIndex& other);
+
+  /// \brief Returns whether a position is deleted.
+  bool IsDeleted(int64_t position) const;
+
+  /// \brief Returns whether no position is deleted.
+  bool IsEmpty() const;
+
+  /// \brief Returns the number of deleted positions.
+  int64_t Cardinality() const;
+
+  /// \brief Calls `visitor` with each deleted position in [begin, end), in increasing
+  /// order.
+  void ForEach(int64_t begin, int64_t end,
+               const std::function<void(int64_t)>& visitor) const;
+
+  /// \brief Serializes the index into a deletion vector blob.
+  ///
+  /// The blob holds the length of the deletion vector, the magic bytes, the bitmaps in
+  /// the portable 64-bit roaring format and a CRC-32 checksum, as stored in the
+  /// `deletion-vector-v1` blobs of Puffin files.
+  std::string SerializeDeletionVector() const;
+
+  /// \brief Deserializes a deletion vector blob.
+  /// \param blob The blob written by SerializeDeletionVector().
+  /// \return A Result containing the index, or an error if the blob is corrupted.
+  static Result<PositionDeleteIndex> DeserializeDeletionVector(std::string_view blob);
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace iceberg
@@ -0,0 +1,266 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/deletes/position_delete_writer.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include <nanoarrow/nanoarrow.h>
+
+#include "iceberg/arrow/nanoarrow_status_internal.h"
+#include "iceberg/arrow_c_data_guard_internal.h"
+#include "iceberg/deletes/position_delete_index.h"
+#include "iceberg/metadata_columns.h"
+#include "iceberg/schema.h"
+#include "iceberg/schema_internal.h"
+#include "iceberg/util/conversions.h"
+#include "iceberg/util/macros.h"
+#include "iceberg/util/string_util.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief The number of deletes written in a batch.
+constexpr int64_t kBatchRows = 4096;
+
+/// \brief Builds the (file_path, pos) batches of a position delete file.
+class DeleteBatchBuilder {
+ public:
+  DeleteBatchBuilder(const ArrowSchema& schema, Writer& writer)
+      : schema_(schema), writer_(writer) {}
+
+  ~DeleteBatchBuilder() {
+    if (array_.release != nullptr) {
+      ArrowArrayRelease(&array_);
+    }
+  }
+
+  Status Append(std::string_view path, int64_t position) {
+    if (array_.release == nullptr) {
+      ArrowError error;
+      ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(
+          ArrowArrayInitFromSchema(&array_, &schema_, &error), error);
+      ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayStartAppending(&array_));
+    }
+    ArrowStringView path_view(path.data(), static_cast<int64_t>(path.size()));
+    ICEBERG_NANOARROW_RETURN_UNEXPECTED(
+        ArrowArrayAppendString(array_.children[0], path_view));
+    ICEBERG_NANOARROW_RETURN_UNEXPECTED(
+        ArrowArrayAppendInt(array_.children[1], position));
+    ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayFinishElement(&array_));
+    if (array_.length >= kBatchRows) {
+      return Flush();
+    }
+    return {};
+  }
+
+  /// \brief Writes the appended deletes.
+  Status Flush() {
+    if (array_.release == nullptr) {
+      return {};
+    }
+    ArrowError error;
+    ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(
+        ArrowArrayFinishBuildingDefault(&array_, &error), error);
+    ArrowArray batch = std::exchange(array_, ArrowArray{});
+    return writer_.Write(&batch);
+  }
+
+ private:
+  const ArrowSchema& schema_;
+  Writer& writer_;
+  ArrowArray array_{};
+};
+
+}  // namespace
+
+class PositionDeleteWriter::Impl {
+ public:
+  explicit Impl(PositionDeleteWriterOptions options) : options_(std::move(options)) {}
+
+  Status Delete(std::string_view data_file_path, int64_t position) {
+    if (position < 0) {
+      return InvalidArgument("Invalid position {} deleted from {}", position,
+                             data_file_path);
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto* index, IndexOf(data_file_path));
+    index->Delete(position);
+    return {};
+  }
+
+  Status Delete(std::string_view data_file_path, const PositionDeleteIndex& positions) {
+    ICEBERG_ASSIGN_OR_RAISE(auto* index, IndexOf(data_file_path));
+    index->Merge(positions);
+    return {};
+  }
+
+  Result<std::optional<DataFile>> Close() {
+    if (closed_) {
+      return InvalidArgument("Position delete writer is closed");
+    }
+    closed_ = true;
+    std::vector<const std::string*> paths;
+    for (const auto& [path, index] : deletes_) {
+      if (!index.IsEmpty()) {
+        paths.push_back(&path);
+      }
+    }
+    if (paths.empty()) {
+      return std::nullopt;
+    }
+    std::ranges::sort(paths,
+                      [](const auto* lhs, const auto* rhs) { return *lhs < *rhs; });
+
+    auto schema = std::make_shared<Schema>(std::vector<SchemaField>{
+        MetadataColumns::kDeleteFilePath, MetadataColumns::kDeleteFilePos});
+    ArrowSchema arrow_schema;
+    ICEBERG_RETURN_UNEXPECTED(ToArrowSchema(*schema, &arrow_schema));
+    internal::ArrowSchemaGuard schema_guard(&arrow_schema);
+    ICEBERG_ASSIGN_OR_RAISE(auto writer, options_.writer_factory());
+    ICEBERG_RETURN_UNEXPECTED(
+        writer->Open(WriterOptions{.path = options_.path,
+                                   .schema = schema,
+                                   .io = options_.io,
+                                   .memory_pool = options_.memory_pool,
+                                   .properties = options_.properties}));
+
+    int64_t record_count = 0;
+    int64_t min_position = std::numeric_limits<int64_t>::max();
+    int64_t max_position = 0;
+    {
+      DeleteBatchBuilder builder(arrow_schema, *writer);
+      Status status;
+      for (const auto* path : paths) {
+        deletes_.find(*path)->second.ForEach(
+            0, std::numeric_limits<int64_t>::max(), [&](int64_t position) {
+              if (status.has_value()) {
+                status = builder.Append(*path, position);
+              }
+              min_position = std::min(min_position, position);
+              max_position = std::max(max_position, position);
+              ++record_count;
+            });
+        if (!status.has_value()) {
+          std::ignore = writer->Close();
+          return std::unexpected(status.error());
+        }
+      }
+      ICEBERG_RETURN_UNEXPECTED(builder.Flush());
+    }
+    ICEBERG_RETURN_UNEXPECTED(writer->Close());
+
+    DataFile delete_file;
+    delete_file.content = DataFile::Content::kPositionDeletes;
+    delete_file.file_path = options_.path;
+    delete_file.file_format = options_.format;
+    delete_file.partition = options_.partition;
+    delete_file.record_count = record_count;
+    auto length = writer->length();
+    if (!length.has_value()) {
+      return InvalidArgument("Writer did not report the length of {}", options_.path);
+    }
+    delete_file.file_size_in_bytes = length.value();
+    if (auto metrics = writer->metrics(); metrics.has_value()) {
+      for (const auto& [field_id, size] : metrics->column_sizes) {
+        delete_file.column_sizes[static_cast<int32_t>(field_id)] = size;
+      }
+    }
+    // The bounds of the paths are not truncated, so that delete files can be matched
+    // with their data files by their bounds.
+    const int32_t path_id = MetadataColumns::kDeleteFilePath.field_id();
+    const int32_t pos_id = MetadataColumns::kDeleteFilePos.field_id();
+    for (int32_t field_id : {path_id, pos_id}) {
+      delete_file.value_counts[field_id] = record_count;
+      delete_file.null_value_counts[field_id] = 0;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(delete_file.lower_bounds[path_id],
+                            Conversions::ToBytes(Literal::String(*paths.front())));
+    ICEBERG_ASSIGN_OR_RAISE(delete_file.upper_bounds[path_id],
+                            Conversions::ToBytes(Literal::String(*paths.back())));
+    ICEBERG_ASSIGN_OR_RAISE(delete_file.lower_bounds[pos_id],
+                            Conversions::ToBytes(Literal::Long(min_position)));
+    ICEBERG_ASSIGN_OR_RAISE(delete_file.upper_bounds[pos_id],
+                            Conversions::ToBytes(Literal::Long(max_position)));
+    if (paths.size() == 1) {
+      delete_file.referenced_data_file = *paths.front();
+    }
+    delete_file.split_offsets = writer->split_offsets();
+    delete_file.partition_spec_id = options_.spec_id;
+    deletes_.clear();
+    return delete_file;
+  }
+
+ private:
+  Result<PositionDeleteIndex*> IndexOf(std::string_view data_file_path) {
+    if (closed_) {
+      return InvalidArgument("Position delete writer is closed");
+    }
+    // Deletes usually come in runs of the same data file.
+    if (last_index_ != nullptr && last_path_ == data_file_path) {
+      return last_index_;
+    }
+    auto it = deletes_.find(data_file_path);
+    if (it == deletes_.end()) {
+      it = deletes_.emplace(std::string(data_file_path), PositionDeleteIndex()).first;
+    }
+    last_path_ = it->first;
+    last_index_ = &it->second;
+    return last_index_;
+  }
+
+  PositionDeleteWriterOptions options_;
+  std::unordered_map<std::string, PositionDeleteIndex, StringHash, std::equal_to<>>
+      deletes_;
+  std::string_view last_path_;
+  PositionDeleteIndex* last_index_ = nullptr;
+  bool closed_ = false;
+};
+
+PositionDeleteWriter::PositionDeleteWriter(std::unique_ptr<Impl> impl)
+    : impl_(std::move(impl)) {}
+
+PositionDeleteWriter::~PositionDeleteWriter() = default;
+
+Result<std::unique_ptr<PositionDeleteWriter>> PositionDeleteWriter::Make(
+    PositionDeleteWriterOptions options) {
+  if (options.path.empty()) {
+    return InvalidArgument("Position delete writer requires a path");
+  }
+  if (!options.writer_factory) {
+    options.writer_factory = WriterFactoryRegistry::GetFactory(options.format);
+  }
+  return std::unique_ptr<PositionDeleteWriter>(
+      new PositionDeleteWriter(std::make_unique<Impl>(std::move(options))));
+}
+
+Status PositionDeleteWriter::Delete(std::string_view data_file_path, int64_t position) {
+  return impl_->Delete(data_file_path, position);
+}
+
+Status PositionDeleteWriter::Delete(std::string_view data_file_path,
+                                    const PositionDeleteIndex& positions) {
+  return impl_->Delete(data_file_path, positions);
+}
+
+Result<std::optional<DataFile>> PositionDeleteWriter::Close() { return impl_->Close(); }
+
+}  // namespace iceberg
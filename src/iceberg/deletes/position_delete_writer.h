@@ -0,0 +1,100 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/deletes/position_delete_writer.h
+/// Writer of position delete files.
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "iceberg/expression/literal.h"
+#include "iceberg/file_format.h"
+#include "iceberg/file_writer.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+class PositionDeleteIndex;
+
+/// \brief Options for creating a position delete writer.
+struct ICEBERG_EXPORT PositionDeleteWriterOptions {
+  /// \brief The location of the position delete file.
+  std::string path;
+  /// \brief The file format of the position delete file.
+  FileFormatType format = FileFormatType::kParquet;
+  /// \brief FileIO instance passed to the file writer.
+  std::shared_ptr<FileIO> io;
+  /// \brief The pool of the buffers of the file writer, its default pool if null.
+  std::shared_ptr<MemoryPool> memory_pool;
+  /// \brief Format-specific properties passed to the file writer.
+  std::unordered_map<std::string, std::string> properties;
+  /// \brief The id of the partition spec of the deleted data files.
+  int32_t spec_id = 0;
+  /// \brief The partition of the deleted data files.
+  std::vector<Literal> partition;
+  /// \brief Creates the file writer, the factory registered for the format if unset.
+  WriterFactory writer_factory;
+};
+
+/// \brief Writes the deleted rows of data files to a position delete file.
+///
+/// Deletes can be added in any order. The deleted positions of each data file are
+/// buffered in a roaring bitmap, which keeps them sorted in a few bits per position,
+/// so the file is written sorted by path and position as the spec requires, without
+/// sorting the deletes.
+class ICEBERG_EXPORT PositionDeleteWriter {
+ public:
+  ~PositionDeleteWriter();
+
+  /// \brief Creates a position delete writer.
+  static Result<std::unique_ptr<PositionDeleteWriter>> Make(
+      PositionDeleteWriterOptions options);
+
+  /// \brief Deletes a row of a data file.
+  ///
+  /// \param data_file_path The location of the data file
+  /// \param position The position of the row in the data file
+  /// \return InvalidArgument if the position is negative.
+  Status Delete(std::string_view data_file_path, int64_t position);
+
+  /// \brief Deletes the positions of an index from a data file.
+  Status Delete(std::string_view data_file_path, const PositionDeleteIndex& positions);
+
+  /// \brief Writes the deletes and returns the position delete file, or nothing if no
+  /// rows were deleted.
+  Result<std::optional<DataFile>> Close();
+
+ private:
+  class Impl;
+  explicit PositionDeleteWriter(std::unique_ptr<Impl> impl);
+
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace iceberg
@@ -0,0 +1,255 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/executor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+class ThreadPoolExecutor::Impl {
+ public:
+  explicit Impl(int32_t num_threads) : queues_(static_cast<size_t>(num_threads)) {
+    threads_.reserve(queues_.size());
+    for (size_t i = 0; i < queues_.size(); ++i) {
+      threads_.emplace_back([this, i]() { Run(i); });
+    }
+  }
+
+  ~Impl() {
+    {
+      std::lock_guard lock(mutex_);
+      stopped_ = true;
+    }
+    cv_.notify_all();
+    if (current_pool_ == this) {
+      // Released by one of its own tasks, e.g. one holding the last reference to the
+      // executor: this thread runs its share of the queued tasks, then is detached and
+      // exits once the task returns, without touching the pool again.
+      while (Reserve()) {
+        Take(current_index_)();
+      }
+      current_pool_ = nullptr;
+      threads_[current_index_].detach();
+    }
+    threads_.clear();
+  }
+
+  void Submit(std::function<void()> task) {
+    const size_t index = current_pool_ == this
+                             ? current_index_
+                             : next_queue_.fetch_add(1, std::memory_order_relaxed) %
+                                   queues_.size();
+    {
+      std::lock_guard lock(queues_[index].mutex);
+      queues_[index].tasks.push_back(std::move(task));
+    }
+    {
+      std::lock_guard lock(mutex_);
+      ++pending_;
+    }
+    cv_.notify_one();
+  }
+
+  int32_t concurrency() const { return static_cast<int32_t>(queues_.size()); }
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  void Run(size_t index) {
+    current_pool_ = this;
+    current_index_ = index;
+    while (true) {
+      {
+        std::unique_lock lock(mutex_);
+        cv_.wait(lock, [&]() { return stopped_ || pending_ > 0; });
+        if (pending_ == 0) {
+          return;
+        }
+        // Reserves one of the queued tasks, so one is left for this thread.
+        --pending_;
+      }
+      Take(index)();
+      if (current_pool_ != this) {
+        // The pool was destroyed by the task.
+        return;
+      }
+    }
+  }
+
+  /// \brief Reserves one of the queued tasks, returns false if there is none.
+  bool Reserve() {
+    std::lock_guard lock(mutex_);
+    if (pending_ == 0) {
+      return false;
+    }
+    --pending_;
+    return true;
+  }
+
+  /// \brief Takes a reserved task, the newest of its own queue or else the oldest of
+  /// another queue.
+  std::function<void()> Take(size_t index) {
+    while (true) {
+      {
+        auto& own = queues_[index];
+        std::lock_guard lock(own.mutex);
+        if (!own.tasks.empty()) {
+          auto task = std::move(own.tasks.back());
+          own.tasks.pop_back();
+          return task;
+        }
+      }
+      for (size_t i = 1; i < queues_.size(); ++i) {
+        auto& other = queues_[(index + i) % queues_.size()];
+        std::lock_guard lock(other.mutex);
+        if (!other.tasks.empty()) {
+          auto task = std::move(other.tasks.front());
+          other.tasks.pop_front();
+          return task;
+        }
+      }
+    }
+  }
+
+  static thread_local const Impl* current_pool_;
+  static thread_local size_t current_index_;
+
+  std::vector<Queue> queues_;
+  std::atomic<size_t> next_queue_ = 0;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  /// \brief The number of queued tasks not reserved by a thread yet.
+  size_t pending_ = 0;
+  bool stopped_ = false;
+  /// \brief Declared last, so that the threads start once the other members are
+  /// initialized and are joined before they are destroyed.
+  std::vector<std::jthread> threads_;
+};
+
+thread_local const ThreadPoolExecutor::Impl* ThreadPoolExecutor::Impl::current_pool_ =
+    nullptr;
+thread_local size_t ThreadPoolExecutor::Impl::current_index_ = 0;
+
+ThreadPoolExecutor::ThreadPoolExecutor(std::unique_ptr<Impl> impl)
+    : impl_(std::move(impl)) {}
+
+ThreadPoolExecutor::~ThreadPoolExecutor() = default;
+
+Result<std::unique_ptr<ThreadPoolExecutor>> ThreadPoolExecutor::Make(
+    int32_t num_threads) {
+  if (num_threads < 1) {
+    return InvalidArgument("Number of threads must be positive, got {}", num_threads);
+  }
+  return std::unique_ptr<ThreadPoolExecutor>(
+      new ThreadPoolExecutor(std::make_unique<Impl>(num_threads)));
+}
+
+void ThreadPoolExecutor::Submit(std::function<void()> task) {
+  impl_->Submit(std::move(task));
+}
+
+int32_t ThreadPoolExecutor::concurrency() const { return impl_->concurrency(); }
+
+std::shared_ptr<Executor> DefaultExecutor() {
+  static const std::shared_ptr<Executor> executor = []() {
+    const auto num_threads =
+        std::max<int32_t>(static_cast<int32_t>(std::thread::hardware_concurrency()), 1);
+    return std::shared_ptr<Executor>(ThreadPoolExecutor::Make(num_threads).value());
+  }();
+  return executor;
+}
+
+namespace {
+
+/// \brief The state of RunInParallel shared with its helpers, which may start after
+/// it returned.
+struct ParallelRun {
+  const size_t count;
+  const std::function<Status(size_t)>* task;
+  std::mutex mutex;
+  std::condition_variable cv;
+  size_t next = 0;
+  size_t running = 0;
+  Status status;
+
+  /// \brief Runs the unclaimed tasks until all are claimed or one failed.
+  void Run() {
+    while (true) {
+      size_t index;
+      {
+        std::lock_guard lock(mutex);
+        if (next >= count) {
+          return;
+        }
+        index = next++;
+        ++running;
+      }
+      auto task_status = (*task)(index);
+      {
+        std::lock_guard lock(mutex);
+        if (!task_status.has_value() && status.has_value()) {
+          status = std::move(task_status);
+          // No task starts after a failure.
+          next = count;
+        }
+        --running;
+      }
+      cv.notify_all();
+    }
+  }
+};
+
+}  // namespace
+
+Status RunInParallel(Executor& executor, size_t count, int32_t parallelism,
+                     const std::function<Status(size_t)>& task) {
+  const auto num_workers =
+      std::min(count, static_cast<size_t>(std::max<int32_t>(parallelism, 1)));
+  if (num_workers <= 1) {
+    for (size_t i = 0; i < count; ++i) {
+      ICEBERG_RETURN_UNEXPECTED(task(i));
+    }
+    return {};
+  }
+
+  auto run = std::make_shared<ParallelRun>(count, &task);
+  for (size_t i = 1; i < num_workers; ++i) {
+    executor.Submit([run]() { run->Run(); });
+  }
+  run->Run();
+  // Helpers starting from now find every task claimed, so only the running ones are
+  // waited for.
+  std::unique_lock lock(run->mutex);
+  run->cv.wait(lock, [&]() { return run->running == 0; });
+  return std::move(run->status);
+}
+
+}  // namespace iceberg
@@ -0,0 +1,96 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/executor.h
+/// Executors running the concurrent work of scans, reads and maintenance actions.
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+
+namespace iceberg {
+
+/// \brief Runs tasks submitted by the library, such as planning manifests, reading
+/// batches ahead or rewriting groups of files.
+///
+/// The library creates no threads of its own when an executor is given to it, so
+/// engines with their own scheduler can implement this interface to own the CPU and
+/// I/O concurrency of the library. Operations never wait on a submitted task that has
+/// not started, as they do its work on the calling thread instead, so an executor may
+/// run tasks in any order, and operations may be called from its own tasks.
+class ICEBERG_EXPORT Executor {
+ public:
+  virtual ~Executor() = default;
+
+  /// \brief Schedules a task, which must eventually run exactly once.
+  virtual void Submit(std::function<void()> task) = 0;
+
+  /// \brief The number of tasks that can run at the same time.
+  virtual int32_t concurrency() const = 0;
+};
+
+/// \brief A work-stealing pool of threads.
+///
+/// Each thread has a queue of tasks, taking the last submitted task of its own queue
+/// first and otherwise the oldest task of another queue. Tasks submitted by a task
+/// go to the queue of its thread, and other tasks to the queues in turn. Destroying
+/// the pool runs the tasks submitted before and joins the threads. A task may release
+/// the last reference to its pool, e.g. through the shared state of a scan, in which
+/// case its thread is detached instead of joined.
+class ICEBERG_EXPORT ThreadPoolExecutor : public Executor {
+ public:
+  /// \brief Creates a pool of `num_threads` threads, which must be positive.
+  static Result<std::unique_ptr<ThreadPoolExecutor>> Make(int32_t num_threads);
+
+  ~ThreadPoolExecutor() override;
+
+  void Submit(std::function<void()> task) override;
+
+  int32_t concurrency() const override;
+
+ private:
+  class Impl;
+
+  explicit ThreadPoolExecutor(std::unique_ptr<Impl> impl);
+
+  std::unique_ptr<Impl> impl_;
+};
+
+/// \brief Returns the executor of the operations that are not given one, a
+/// ThreadPoolExecutor with a thread per hardware thread created on first use.
+ICEBERG_EXPORT std::shared_ptr<Executor> DefaultExecutor();
+
+/// \brief Runs `task` for the indices [0, count) on up to `parallelism` threads,
+/// returning the first error.
+///
+/// The calling thread runs tasks too, and `parallelism - 1` helpers are submitted to
+/// the executor, so tasks run on the calling thread only when `parallelism` is 1.
+/// No task starts after one fails, and the function returns once the started tasks
+/// are done.
+ICEBERG_EXPORT Status RunInParallel(Executor& executor, size_t count,
+                                    int32_t parallelism,
+                                    const std::function<Status(size_t)>& task);
+
+}  // namespace iceberg
@@ -0,0 +1,393 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/expire_snapshots.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+
+#include "iceberg/catalog.h"
+#include "iceberg/executor.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_entry_batch.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/manifest_reader.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/statistics_file.h"
+#include "iceberg/table.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/table_properties.h"
+#include "iceberg/table_requirements.h"
+#include "iceberg/table_update.h"
+#include "iceberg/util/macros.h"
+#include "iceberg/util/string_util.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief Visits the paths of the files of the entries of a manifest, skipping the
+/// deleted entries when `live_only` is set.
+///
+/// Only the required data file fields are decoded, and the partition tuples are
+/// skipped.
+Status VisitFilePaths(const ManifestFile& manifest, const std::shared_ptr<FileIO>& io,
+                      bool live_only,
+                      const std::function<void(std::string_view)>& visitor) {
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto reader,
+      ManifestReader::Make(manifest, io, /*partition_schema=*/nullptr,
+                           {.columns = {std::string(DataFile::kFilePath.name())}}));
+  return reader->VisitBatches([&](const ManifestEntryBatch& batch) -> Status {
+    for (int64_t row = 0; row < batch.size(); ++row) {
+      if (!live_only || batch.status(row) != ManifestStatus::kDeleted) {
+        visitor(batch.file_path(row));
+      }
+    }
+    return {};
+  });
+}
+
+/// \brief Deletes files in bulk and counts the deleted ones.
+void DeleteFiles(FileIO& io, const std::vector<std::string>& paths, int64_t& count,
+                 ExpireSnapshotsResult& result) {
+  if (paths.empty()) {
+    return;
+  }
+  auto failures = io.DeleteFiles(paths);
+  count += static_cast<int64_t>(paths.size() - failures.size());
+  result.delete_failures.insert(result.delete_failures.end(),
+                                std::make_move_iterator(failures.begin()),
+                                std::make_move_iterator(failures.end()));
+}
+
+}  // namespace
+
+ExpireSnapshots::ExpireSnapshots(std::shared_ptr<Table> table)
+    : table_(std::move(table)) {}
+
+ExpireSnapshots::~ExpireSnapshots() = default;
+
+ExpireSnapshots& ExpireSnapshots::ExpireSnapshotId(int64_t snapshot_id) {
+  snapshot_ids_to_expire_.insert(snapshot_id);
+  return *this;
+}
+
+ExpireSnapshots& ExpireSnapshots::ExpireOlderThan(TimePointMs timestamp) {
+  expire_older_than_ = timestamp;
+  return *this;
+}
+
+ExpireSnapshots& ExpireSnapshots::RetainLast(int32_t num_snapshots) {
+  retain_last_ = num_snapshots;
+  return *this;
+}
+
+ExpireSnapshots& ExpireSnapshots::CleanExpiredFiles(bool clean) {
+  clean_expired_files_ = clean;
+  return *this;
+}
+
+ExpireSnapshots& ExpireSnapshots::WithParallelism(int32_t parallelism) {
+  parallelism_ = parallelism;
+  return *this;
+}
+
+ExpireSnapshots& ExpireSnapshots::WithExecutor(std::shared_ptr<Executor> executor) {
+  executor_ = std::move(executor);
+  return *this;
+}
+
+Result<std::vector<int64_t>> ExpireSnapshots::Apply() const {
+  return ExpiredSnapshotIds(*table_->metadata());
+}
+
+Result<std::vector<int64_t>> ExpireSnapshots::ExpiredSnapshotIds(
+    const TableMetadata& base) const {
+  if (retain_last_.has_value() && retain_last_.value() < 1) {
+    return InvalidArgument("Number of snapshots to retain must be positive, got {}",
+                           retain_last_.value());
+  }
+  if (base.compact_snapshots != nullptr) {
+    return InvalidArgument("Cannot expire snapshots of metadata read lazily");
+  }
+
+  const auto& properties = table_->properties();
+  const auto now = std::chrono::time_point_cast<std::chrono::milliseconds>(
+      std::chrono::system_clock::now());
+  const int64_t default_max_age_ms =
+      expire_older_than_.has_value()
+          ? (now - expire_older_than_.value()).count()
+          : properties.Get(TableProperties::kMaxSnapshotAgeMs);
+  const int32_t default_min_to_keep =
+      retain_last_.value_or(properties.Get(TableProperties::kMinSnapshotsToKeep));
+
+  std::unordered_map<int64_t, const Snapshot*> snapshots_by_id;
+  for (const auto& snapshot : base.snapshots) {
+    snapshots_by_id.emplace(snapshot->snapshot_id, snapshot.get());
+  }
+  auto parent_of = [&](const Snapshot* snapshot) -> const Snapshot* {
+    if (!snapshot->parent_snapshot_id.has_value()) {
+      return nullptr;
+    }
+    auto it = snapshots_by_id.find(snapshot->parent_snapshot_id.value());
+    return it == snapshots_by_id.end() ? nullptr : it->second;
+  };
+
+  std::unordered_set<int64_t> retained;
+  // Snapshots in the lineage of a ref, which are only kept by the retention of the ref.
+  std::unordered_set<int64_t> referenced;
+  for (const auto& [name, ref] : base.refs) {
+    auto it = snapshots_by_id.find(ref->snapshot_id);
+    if (it == snapshots_by_id.end()) {
+      continue;
+    }
+    if (snapshot_ids_to_expire_.contains(ref->snapshot_id)) {
+      return InvalidArgument("Cannot expire snapshot {}: it is referenced by {}",
+                             ref->snapshot_id, name);
+    }
+    retained.insert(ref->snapshot_id);
+    if (ref->type() != SnapshotRefType::kBranch) {
+      continue;
+    }
+
+    const auto& branch = std::get<SnapshotRef::Branch>(ref->retention);
+    const int32_t min_to_keep =
+        branch.min_snapshots_to_keep.value_or(default_min_to_keep);
+    const TimePointMs older_than =
+        now - std::chrono::milliseconds(
+                  branch.max_snapshot_age_ms.value_or(default_max_age_ms));
+    // The branch keeps the newest ancestors up to the first one it does not need,
+    // the older ones are still walked to mark them as referenced.
+    int32_t kept = 0;
+    bool retaining = true;
+    for (const Snapshot* snapshot = it->second; snapshot != nullptr;
+         snapshot = parent_of(snapshot)) {
+      referenced.insert(snapshot->snapshot_id);
+      retaining =
+          retaining && (kept < min_to_keep || snapshot->timestamp_ms >= older_than);
+      if (retaining) {
+        retained.insert(snapshot->snapshot_id);
+        ++kept;
+      }
+    }
+  }
+
+  const TimePointMs default_older_than =
+      now - std::chrono::milliseconds(default_max_age_ms);
+  std::vector<int64_t> expired;
+  for (const auto& snapshot : base.snapshots) {
+    const int64_t snapshot_id = snapshot->snapshot_id;
+    if (snapshot_ids_to_expire_.contains(snapshot_id)) {
+      expired.push_back(snapshot_id);
+    } else if (retained.contains(snapshot_id)) {
+      continue;
+    } else if (referenced.contains(snapshot_id) ||
+               snapshot->timestamp_ms < default_older_than) {
+      expired.push_back(snapshot_id);
+    }
+  }
+  return expired;
+}
+
+Result<ExpireSnapshotsResult> ExpireSnapshots::Commit() {
+  if (parallelism_ < 1) {
+    return InvalidArgument("Parallelism must be positive, got {}", parallelism_);
+  }
+  if (table_->catalog() == nullptr) {
+    return NotSupported("Cannot commit to table {} without a catalog",
+                        table_->name().name);
+  }
+  if (clean_expired_files_ && !table_->properties().Get(TableProperties::kGcEnabled)) {
+    return InvalidArgument(
+        "Cannot clean the expired files of table {}: {} is false, files may be "
+        "referenced by other tables",
+        table_->name().name, TableProperties::kGcEnabled.key());
+  }
+
+  // Keep the base alive, the table is refreshed after the commit.
+  const std::shared_ptr<TableMetadata> base = table_->metadata();
+  ICEBERG_ASSIGN_OR_RAISE(auto expired_ids, ExpiredSnapshotIds(*base));
+  ExpireSnapshotsResult result;
+  if (expired_ids.empty()) {
+    return result;
+  }
+
+  std::vector<std::unique_ptr<TableUpdate>> updates;
+  updates.push_back(std::make_unique<table::RemoveSnapshots>(expired_ids));
+  ICEBERG_ASSIGN_OR_RAISE(auto requirements,
+                          TableRequirements::ForUpdateTable(*base, updates));
+  ICEBERG_RETURN_UNEXPECTED(
+      table_->catalog()->UpdateTable(table_->name(), requirements, updates));
+  result.expired_snapshot_ids = std::move(expired_ids);
+  // The snapshots are expired, a failed refresh only leaves the table stale.
+  std::ignore = table_->Refresh();
+
+  if (clean_expired_files_) {
+    ICEBERG_RETURN_UNEXPECTED(CleanFiles(*base, result.expired_snapshot_ids, result));
+  }
+  return result;
+}
+
+Status ExpireSnapshots::CleanFiles(const TableMetadata& base,
+                                   const std::vector<int64_t>& expired_ids,
+                                   ExpireSnapshotsResult& result) const {
+  const auto& io = table_->io();
+  const auto executor = executor_ != nullptr ? executor_ : DefaultExecutor();
+  const std::unordered_set<int64_t> expired(expired_ids.begin(), expired_ids.end());
+
+  // Read the manifest lists of all snapshots, the retained ones first.
+  std::vector<const Snapshot*> snapshots;
+  snapshots.reserve(base.snapshots.size());
+  for (const auto& snapshot : base.snapshots) {
+    if (!expired.contains(snapshot->snapshot_id)) {
+      snapshots.push_back(snapshot.get());
+    }
+  }
+  const size_t retained_count = snapshots.size();
+  for (const auto& snapshot : base.snapshots) {
+    if (expired.contains(snapshot->snapshot_id)) {
+      snapshots.push_back(snapshot.get());
+    }
+  }
+  std::vector<std::vector<ManifestFile>> manifest_lists(snapshots.size());
+  ICEBERG_RETURN_UNEXPECTED(
+      RunInParallel(*executor, snapshots.size(), parallelism_, [&](size_t i) -> Status {
+        if (snapshots[i]->manifest_list.empty()) {
+          return {};
+        }
+        ICEBERG_ASSIGN_OR_RAISE(
+            auto reader, ManifestListReader::Make(snapshots[i]->manifest_list, io));
+        ICEBERG_ASSIGN_OR_RAISE(manifest_lists[i], reader->Files());
+        return {};
+      }));
+
+  // Manifests are shared by the snapshots that did not rewrite them, each one is read
+  // once.
+  std::unordered_set<std::string_view> retained_lists;
+  std::unordered_set<std::string_view> retained_paths;
+  std::vector<const ManifestFile*> retained_manifests;
+  for (size_t i = 0; i < retained_count; ++i) {
+    retained_lists.insert(snapshots[i]->manifest_list);
+    for (const auto& manifest : manifest_lists[i]) {
+      if (retained_paths.insert(manifest.manifest_path).second) {
+        retained_manifests.push_back(&manifest);
+      }
+    }
+  }
+  std::vector<std::string> expired_lists;
+  std::unordered_set<std::string_view> expired_paths;
+  std::vector<const ManifestFile*> expired_manifests;
+  for (size_t i = retained_count; i < snapshots.size(); ++i) {
+    if (!snapshots[i]->manifest_list.empty() &&
+        !retained_lists.contains(snapshots[i]->manifest_list)) {
+      expired_lists.push_back(snapshots[i]->manifest_list);
+    }
+    for (const auto& manifest : manifest_lists[i]) {
+      if (!retained_paths.contains(manifest.manifest_path) &&
+          expired_paths.insert(manifest.manifest_path).second) {
+        expired_manifests.push_back(&manifest);
+      }
+    }
+  }
+
+  // The files of the expired manifests are candidates for deletion, including the ones
+  // of deleted entries that the expired snapshots still referenced.
+  std::mutex mutex;
+  std::unordered_set<std::string, StringHash, std::equal_to<>> candidates;
+  ICEBERG_RETURN_UNEXPECTED(RunInParallel(
+      *executor, expired_manifests.size(), parallelism_, [&](size_t i) -> Status {
+        std::vector<std::string> paths;
+        ICEBERG_RETURN_UNEXPECTED(
+            VisitFilePaths(*expired_manifests[i], io, /*live_only=*/false,
+                           [&](std::string_view path) { paths.emplace_back(path); }));
+        std::lock_guard lock(mutex);
+        candidates.insert(std::make_move_iterator(paths.begin()),
+                          std::make_move_iterator(paths.end()));
+        return {};
+      }));
+
+  // Drop the candidates that are live in a retained manifest. The candidate set is only
+  // read while the retained manifests are.
+  if (!candidates.empty()) {
+    std::vector<std::string> reachable;
+    ICEBERG_RETURN_UNEXPECTED(RunInParallel(
+        *executor, retained_manifests.size(), parallelism_, [&](size_t i) -> Status {
+          std::vector<std::string> paths;
+          ICEBERG_RETURN_UNEXPECTED(VisitFilePaths(
+              *retained_manifests[i], io, /*live_only=*/true,
+              [&](std::string_view path) {
+                if (auto it = candidates.find(path); it != candidates.end()) {
+                  paths.push_back(*it);
+                }
+              }));
+          std::lock_guard lock(mutex);
+          reachable.insert(reachable.end(), std::make_move_iterator(paths.begin()),
+                           std::make_move_iterator(paths.end()));
+          return {};
+        }));
+    for (const auto& path : reachable) {
+      candidates.erase(path);
+    }
+  }
+
+  std::vector<std::pair<int64_t, std::string_view>> statistics;
+  for (const auto& file : base.statistics) {
+    statistics.emplace_back(file->snapshot_id, file->path);
+  }
+  for (const auto& file : base.partition_statistics) {
+    statistics.emplace_back(file->snapshot_id, file->path);
+  }
+  std::unordered_set<std::string_view> retained_statistics;
+  for (const auto& [snapshot_id, path] : statistics) {
+    if (!expired.contains(snapshot_id)) {
+      retained_statistics.insert(path);
+    }
+  }
+  std::vector<std::string> expired_statistics;
+  for (const auto& [snapshot_id, path] : statistics) {
+    if (expired.contains(snapshot_id) && !retained_statistics.contains(path)) {
+      expired_statistics.emplace_back(path);
+    }
+  }
+
+  // Files go before the manifests that reference them, and manifests before the
+  // manifest lists, so a failed cleanup leaves no dangling reference.
+  std::vector<std::string> files(candidates.begin(), candidates.end());
+  DeleteFiles(*io, files, result.deleted_files_count, result);
+  std::vector<std::string> manifests;
+  manifests.reserve(expired_manifests.size());
+  for (const auto* manifest : expired_manifests) {
+    manifests.push_back(manifest->manifest_path);
+  }
+  DeleteFiles(*io, manifests, result.deleted_manifests_count, result);
+  DeleteFiles(*io, expired_lists, result.deleted_manifest_lists_count, result);
+  DeleteFiles(*io, expired_statistics, result.deleted_statistics_files_count, result);
+  return {};
+}
+
+}  // namespace iceberg
@@ -0,0 +1,133 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/expire_snapshots.h
+/// Expiration of old snapshots and cleanup of the files only they reference.
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <unordered_set>
+#include <vector>
+
+#include "iceberg/file_io.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+#include "iceberg/util/timepoint.h"
+
+namespace iceberg {
+
+/// \brief The outcome of a snapshot expiration.
+struct ICEBERG_EXPORT ExpireSnapshotsResult {
+  /// \brief The IDs of the snapshots removed from the table.
+  std::vector<int64_t> expired_snapshot_ids;
+  /// \brief The number of deleted data and delete files.
+  int64_t deleted_files_count = 0;
+  /// \brief The number of deleted manifests.
+  int64_t deleted_manifests_count = 0;
+  /// \brief The number of deleted manifest lists.
+  int64_t deleted_manifest_lists_count = 0;
+  /// \brief The number of deleted statistics and partition statistics files.
+  int64_t deleted_statistics_files_count = 0;
+  /// \brief The unreachable files that could not be deleted, which are left behind.
+  std::vector<FileDeleteFailure> delete_failures;
+};
+
+/// \brief Removes old snapshots from a table and deletes the files that are no longer
+/// reachable from the remaining snapshots.
+///
+/// Each branch keeps the snapshots of its lineage that are newer than the expiration
+/// timestamp, and at least the last `history.expire.min-snapshots-to-keep` of them or
+/// the minimum of its retention policy. Tags keep the snapshot they point to, and the
+/// snapshots that are not in the lineage of any ref are kept while they are newer than
+/// the expiration timestamp, which is `history.expire.max-snapshot-age-ms` before now
+/// by default.
+///
+/// After the metadata without the expired snapshots is committed, the manifest lists of
+/// the expired and retained snapshots are read, and the manifests only the expired
+/// snapshots reference, deduplicated by path, are read with up to `parallelism` of them
+/// in flight to collect their file paths. The retained manifests are then read the same
+/// way to drop the paths that are still live, so that only the candidate paths are kept
+/// in memory rather than every file of the table. The unreachable files, manifests and
+/// manifest lists are removed with FileIO::DeleteFiles, in this order so that a failed
+/// cleanup never leaves a manifest pointing to a deleted file.
+class ICEBERG_EXPORT ExpireSnapshots {
+ public:
+  /// \brief Creates an expiration of the snapshots of a table.
+  ///
+  /// \param table The table to expire, which must have a catalog to commit to
+  explicit ExpireSnapshots(std::shared_ptr<Table> table);
+
+  ~ExpireSnapshots();
+
+  /// \brief Expires a snapshot, whatever its age, unless a ref points to it.
+  ExpireSnapshots& ExpireSnapshotId(int64_t snapshot_id);
+
+  /// \brief Expires the snapshots older than a timestamp that are not retained.
+  ExpireSnapshots& ExpireOlderThan(TimePointMs timestamp);
+
+  /// \brief Sets the number of ancestors of each branch to keep whatever their age,
+  /// overriding `history.expire.min-snapshots-to-keep`.
+  ExpireSnapshots& RetainLast(int32_t num_snapshots);
+
+  /// \brief Sets whether to delete the files that become unreachable, true by default.
+  ///
+  /// Deleting files requires `gc.enabled`, as files of a table may be referenced by
+  /// other tables when it is disabled.
+  ExpireSnapshots& CleanExpiredFiles(bool clean);
+
+  /// \brief Sets the number of manifests read concurrently, 1 by default.
+  ExpireSnapshots& WithParallelism(int32_t parallelism);
+
+  /// \brief Sets the executor reading the manifests concurrently, the
+  /// DefaultExecutor() if null.
+  ExpireSnapshots& WithExecutor(std::shared_ptr<Executor> executor);
+
+  /// \brief Returns the IDs of the snapshots that would be expired from the current
+  /// metadata of the table.
+  Result<std::vector<int64_t>> Apply() const;
+
+  /// \brief Commits the removal of the expired snapshots and deletes the files that
+  /// are no longer reachable.
+  ///
+  /// \return The expired snapshots and deleted files; ErrorKind::kCommitFailed if a ref
+  /// of the table moved concurrently
+  Result<ExpireSnapshotsResult> Commit();
+
+ private:
+  /// \brief Returns the snapshots of `base` that would be expired.
+  Result<std::vector<int64_t>> ExpiredSnapshotIds(const TableMetadata& base) const;
+
+  /// \brief Deletes the files reachable from the expired snapshots of `base` only.
+  Status CleanFiles(const TableMetadata& base, const std::vector<int64_t>& expired_ids,
+                    ExpireSnapshotsResult& result) const;
+
+  std::shared_ptr<Table> table_;
+  std::unordered_set<int64_t> snapshot_ids_to_expire_;
+  std::optional<TimePointMs> expire_older_than_;
+  std::optional<int32_t> retain_last_;
+  bool clean_expired_files_ = true;
+  int32_t parallelism_ = 1;
+  std::shared_ptr<Executor> executor_;
+};
+
+}  // namespace iceberg
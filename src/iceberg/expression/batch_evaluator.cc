@@ -0,0 +1,1024 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/expression/batch_evaluator.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "iceberg/expression/binder.h"
+#include "iceberg/expression/expression_visitor.h"
+#include "iceberg/expression/literal_set.h"
+#include "iceberg/schema.h"
+#include "iceberg/type.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/decimal.h"
+#include "iceberg/util/int128.h"
+#include "iceberg/util/macros.h"
+#include "iceberg/util/uuid.h"
+#include "iceberg/util/visit_type.h"
+
+namespace iceberg {
+
+namespace {
+
+// One byte per row instead of one bit, so that kernels and the combination of
+// child results compile to plain vectorizable loops.
+using Mask = std::vector<uint8_t>;
+
+// Sets up to this size are matched by comparing every row with each value, larger
+// sets by probing the hash index of the set, or by searching a sorted copy of the set
+// when it is not indexed.
+constexpr size_t kInLinearLimit = 16;
+
+bool GetBit(const uint8_t* bitmap, int64_t index) {
+  return (bitmap[index >> 3] >> (index & 7)) & 1;
+}
+
+/// \brief Maps a float to an integer with the same total order as Literal, where
+/// -NaN < -Infinity < -0 < 0 < Infinity < NaN and NaN payloads are equivalent.
+int32_t FloatKey(float value) {
+  auto bits = std::bit_cast<int32_t>(value);
+  if ((bits & 0x7fffffff) > 0x7f800000) {
+    bits = (bits & static_cast<int32_t>(0x80000000)) | 0x7fc00000;
+  }
+  return bits ^ ((bits >> 31) & 0x7fffffff);
+}
+
+/// \brief Maps a double to an integer with the same total order as Literal.
+int64_t DoubleKey(double value) {
+  auto bits = std::bit_cast<int64_t>(value);
+  if ((bits & 0x7fffffffffffffff) > 0x7ff0000000000000) {
+    bits = (bits & static_cast<int64_t>(0x8000000000000000)) | 0x7ff8000000000000;
+  }
+  return bits ^ ((bits >> 63) & 0x7fffffffffffffff);
+}
+
+/// \brief Values of a fixed-width column, holding keys that compare like Literal.
+template <typename T>
+struct FixedWidthValues {
+  using Key = T;
+
+  T operator[](int64_t index) const { return data[index]; }
+
+  const T* data;
+};
+
+/// \brief Values of a string or binary column with 32-bit or 64-bit offsets.
+template <typename Offset>
+struct BinaryValues {
+  using Key = std::string_view;
+
+  std::string_view operator[](int64_t index) const {
+    return {data + offsets[index],
+            static_cast<size_t>(offsets[index + 1] - offsets[index])};
+  }
+
+  const Offset* offsets;
+  const char* data;
+};
+
+/// \brief Values of a fixed-size binary column.
+struct FixedSizeBinaryValues {
+  using Key = std::string_view;
+
+  std::string_view operator[](int64_t index) const {
+    return {data + index * width, static_cast<size_t>(width)};
+  }
+
+  const char* data;
+  int64_t width;
+};
+
+template <typename V>
+Result<const V*> ValueAs(const Literal::Value& value) {
+  if (const auto* typed = std::get_if<V>(&value); typed != nullptr) {
+    return typed;
+  }
+  return InvalidExpression("Cannot evaluate a literal that does not match the column");
+}
+
+std::string_view BytesKey(const std::vector<uint8_t>& bytes) {
+  return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+}
+
+/// \brief The key type of the values of an Iceberg type in a batch, and the conversion
+/// of literals of the type into keys. Only defined for types that can be evaluated.
+///
+/// String keys point into the literal, which must outlive the key.
+template <typename T>
+struct KeyTraits {};
+
+template <typename K, typename V>
+struct DirectKeyTraits {
+  using Key = K;
+  static Result<Key> FromValue(const Literal::Value& value) {
+    ICEBERG_ASSIGN_OR_RAISE(auto typed, ValueAs<V>(value));
+    return static_cast<Key>(*typed);
+  }
+};
+
+template <>
+struct KeyTraits<BooleanType> : DirectKeyTraits<uint8_t, bool> {};
+template <>
+struct KeyTraits<IntType> : DirectKeyTraits<int32_t, int32_t> {};
+template <>
+struct KeyTraits<DateType> : DirectKeyTraits<int32_t, int32_t> {};
+template <>
+struct KeyTraits<LongType> : DirectKeyTraits<int64_t, int64_t> {};
+template <>
+struct KeyTraits<TimeType> : DirectKeyTraits<int64_t, int64_t> {};
+template <>
+struct KeyTraits<TimestampType> : DirectKeyTraits<int64_t, int64_t> {};
+template <>
+struct KeyTraits<TimestampTzType> : DirectKeyTraits<int64_t, int64_t> {};
+
+template <>
+struct KeyTraits<FloatType> {
+  using Key = int32_t;
+  static Result<Key> FromValue(const Literal::Value& value) {
+    ICEBERG_ASSIGN_OR_RAISE(auto typed, ValueAs<float>(value));
+    return FloatKey(*typed);
+  }
+};
+
+template <>
+struct KeyTraits<DoubleType> {
+  using Key = int64_t;
+  static Result<Key> FromValue(const Literal::Value& value) {
+    ICEBERG_ASSIGN_OR_RAISE(auto typed, ValueAs<double>(value));
+    return DoubleKey(*typed);
+  }
+};
+
+// Literals are cast to the scale of the column when binding, so the unscaled values
+// can be compared directly.
+template <>
+struct KeyTraits<DecimalType> {
+  using Key = int128_t;
+  static Result<Key> FromValue(const Literal::Value& value) {
+    ICEBERG_ASSIGN_OR_RAISE(auto typed, ValueAs<Decimal>(value));
+    return typed->value();
+  }
+};
+
+template <>
+struct KeyTraits<StringType> {
+  using Key = std::string_view;
+  static Result<Key> FromValue(const Literal::Value& value) {
+    ICEBERG_ASSIGN_OR_RAISE(auto typed, ValueAs<std::string>(value));
+    return std::string_view(*typed);
+  }
+};
+
+template <>
+struct KeyTraits<BinaryType> {
+  using Key = std::string_view;
+  static Result<Key> FromValue(const Literal::Value& value) {
+    ICEBERG_ASSIGN_OR_RAISE(auto typed, ValueAs<std::vector<uint8_t>>(value));
+    return BytesKey(*typed);
+  }
+};
+
+template <>
+struct KeyTraits<FixedType> : KeyTraits<BinaryType> {};
+
+template <>
+struct KeyTraits<UuidType> {
+  using Key = std::string_view;
+  static Result<Key> FromValue(const Literal::Value& value) {
+    ICEBERG_ASSIGN_OR_RAISE(auto typed, ValueAs<Uuid>(value));
+    auto bytes = typed->bytes();
+    return std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+  }
+};
+
+template <typename T>
+concept HasKeyTraits = requires { typename KeyTraits<T>::Key; };
+
+/// \brief A column of the batch resolved from a bound reference.
+struct Column {
+  const ArrowSchema* schema;
+  const ArrowArray* array;
+  // Index of the first row of the batch in the buffers of the column.
+  int64_t offset;
+  // Whether the value and all of its parent structs are non-null, for each row.
+  Mask valid;
+  // The values of a dictionary-encoded column, which predicates are evaluated on once
+  // per batch before mapping the results to the rows through `indices`.
+  std::shared_ptr<const Column> dictionary;
+  // The index in the dictionary of the value of each valid row, and 0 for null rows.
+  std::vector<int64_t> indices;
+};
+
+/// \brief Maps the results of a predicate on the values of a dictionary to the rows of
+/// a dictionary-encoded column. Null rows never match.
+Mask MapDictionary(const Column& column, const Mask& values) {
+  Mask result(column.valid.size());
+  for (size_t i = 0; i < result.size(); ++i) {
+    result[i] = column.valid[i] & values[column.indices[i]];
+  }
+  return result;
+}
+
+Status CheckFormat(const Column& column, const Type& type, std::string_view expected) {
+  std::string_view format = column.schema->format;
+  if (!format.starts_with(expected)) {
+    return InvalidArrowData("Cannot read {} values from Arrow format {}", type.ToString(),
+                            format);
+  }
+  return {};
+}
+
+template <typename T>
+Result<const T*> Buffer(const Column& column, int64_t index) {
+  if (column.array->n_buffers <= index) {
+    return InvalidArrowData("Arrow array has {} buffers, expected at least {}",
+                            column.array->n_buffers, index + 1);
+  }
+  return static_cast<const T*>(column.array->buffers[index]);
+}
+
+/// \brief Calls `fn(values)` with the typed values of a column, whose keys are those of
+/// KeyTraits for the column type.
+template <typename Fn>
+Result<Mask> WithValues(const Column& column, const Type& type, Fn&& fn) {
+  const auto length = static_cast<int64_t>(column.valid.size());
+  const int64_t offset = column.offset;
+  switch (type.type_id()) {
+    case TypeId::kBoolean: {
+      ICEBERG_RETURN_UNEXPECTED(CheckFormat(column, type, "b"));
+      ICEBERG_ASSIGN_OR_RAISE(auto bits, Buffer<uint8_t>(column, 1));
+      std::vector<uint8_t> keys(length);
+      for (int64_t i = 0; i < length; ++i) {
+        keys[i] = GetBit(bits, offset + i);
+      }
+      return fn(FixedWidthValues<uint8_t>{keys.data()});
+    }
+    case TypeId::kInt:
+    case TypeId::kDate: {
+      ICEBERG_RETURN_UNEXPECTED(
+          CheckFormat(column, type, type.type_id() == TypeId::kInt ? "i" : "tdD"));
+      ICEBERG_ASSIGN_OR_RAISE(auto data, Buffer<int32_t>(column, 1));
+      return fn(FixedWidthValues<int32_t>{data + offset});
+    }
+    case TypeId::kLong:
+    case TypeId::kTime:
+    case TypeId::kTimestamp:
+    case TypeId::kTimestampTz: {
+      std::string_view expected = type.type_id() == TypeId::kLong   ? "l"
+                                  : type.type_id() == TypeId::kTime ? "ttu"
+                                                                    : "tsu:";
+      ICEBERG_RETURN_UNEXPECTED(CheckFormat(column, type, expected));
+      ICEBERG_ASSIGN_OR_RAISE(auto data, Buffer<int64_t>(column, 1));
+      return fn(FixedWidthValues<int64_t>{data + offset});
+    }
+    case TypeId::kFloat: {
+      ICEBERG_RETURN_UNEXPECTED(CheckFormat(column, type, "f"));
+      ICEBERG_ASSIGN_OR_RAISE(auto data, Buffer<float>(column, 1));
+      std::vector<int32_t> keys(length);
+      for (int64_t i = 0; i < length; ++i) {
+        keys[i] = FloatKey(data[offset + i]);
+      }
+      return fn(FixedWidthValues<int32_t>{keys.data()});
+    }
+    case TypeId::kDouble: {
+      ICEBERG_RETURN_UNEXPECTED(CheckFormat(column, type, "g"));
+      ICEBERG_ASSIGN_OR_RAISE(auto data, Buffer<double>(column, 1));
+      std::vector<int64_t> keys(length);
+      for (int64_t i = 0; i < length; ++i) {
+        keys[i] = DoubleKey(data[offset + i]);
+      }
+      return fn(FixedWidthValues<int64_t>{keys.data()});
+    }
+    case TypeId::kDecimal: {
+      ICEBERG_RETURN_UNEXPECTED(CheckFormat(column, type, "d:"));
+      std::string_view format = column.schema->format;
+      if (std::ranges::count(format, ',') > 1 && !format.ends_with(",128")) {
+        return NotSupported("Unsupported Arrow decimal format: {}", format);
+      }
+      ICEBERG_ASSIGN_OR_RAISE(auto data, Buffer<uint8_t>(column, 1));
+      std::vector<int128_t> keys(length);
+      std::memcpy(keys.data(), data + offset * Decimal::kByteWidth,
+                  length * Decimal::kByteWidth);
+      return fn(FixedWidthValues<int128_t>{keys.data()});
+    }
+    case TypeId::kString:
+    case TypeId::kBinary: {
+      const bool is_string = type.type_id() == TypeId::kString;
+      std::string_view format = column.schema->format;
+      if (format != (is_string ? "u" : "z") && format != (is_string ? "U" : "Z")) {
+        return InvalidArrowData("Cannot read {} values from Arrow format {}",
+                                type.ToString(), format);
+      }
+      ICEBERG_ASSIGN_OR_RAISE(auto data, Buffer<char>(column, 2));
+      if (format == "u" || format == "z") {
+        ICEBERG_ASSIGN_OR_RAISE(auto offsets, Buffer<int32_t>(column, 1));
+        return fn(BinaryValues<int32_t>{offsets + offset, data});
+      }
+      ICEBERG_ASSIGN_OR_RAISE(auto offsets, Buffer<int64_t>(column, 1));
+      return fn(BinaryValues<int64_t>{offsets + offset, data});
+    }
+    case TypeId::kFixed:
+    case TypeId::kUuid: {
+      ICEBERG_RETURN_UNEXPECTED(CheckFormat(column, type, "w:"));
+      const int32_t width =
+          type.type_id() == TypeId::kUuid
+              ? 16
+              : internal::checked_cast<const FixedType&>(type).length();
+      std::string_view format = column.schema->format;
+      int32_t format_width = 0;
+      auto [ptr, ec] =
+          std::from_chars(format.data() + 2, format.data() + format.size(), format_width);
+      if (ec != std::errc() || format_width != width) {
+        return InvalidArrowData("Cannot read {} values from Arrow format {}",
+                                type.ToString(), format);
+      }
+      ICEBERG_ASSIGN_OR_RAISE(auto data, Buffer<char>(column, 1));
+      return fn(FixedSizeBinaryValues{data + offset * width, width});
+    }
+    default:
+      return NotSupported("Cannot evaluate predicates on {} columns", type.ToString());
+  }
+}
+
+template <typename Values, typename Key, typename Cmp>
+Mask CompareValues(const Values& values, const Key& key, int64_t length, Cmp cmp) {
+  Mask result(length);
+  for (int64_t i = 0; i < length; ++i) {
+    result[i] = cmp(values[i], key);
+  }
+  return result;
+}
+
+template <typename T>
+Mask NaNValues(const T* data, int64_t length) {
+  Mask result(length);
+  for (int64_t i = 0; i < length; ++i) {
+    result[i] = data[i] != data[i];
+  }
+  return result;
+}
+
+Mask AndMask(Mask left, const Mask& right) {
+  for (size_t i = 0; i < left.size(); ++i) {
+    left[i] &= right[i];
+  }
+  return left;
+}
+
+Mask OrMask(Mask left, const Mask& right) {
+  for (size_t i = 0; i < left.size(); ++i) {
+    left[i] |= right[i];
+  }
+  return left;
+}
+
+Mask Complement(Mask mask) {
+  for (auto& selected : mask) {
+    selected ^= 1;
+  }
+  return mask;
+}
+
+using FieldPositions = std::unordered_map<int32_t, std::vector<int32_t>>;
+
+/// \brief A batch being evaluated, which resolves the columns referenced by the
+/// expression. Columns are cached, since filters commonly reference the same column
+/// more than once.
+class Batch {
+ public:
+  Batch(const FieldPositions& field_positions, const ArrowSchema& schema,
+        const ArrowArray& array)
+      : field_positions_(field_positions),
+        schema_(schema),
+        array_(array),
+        length_(array.length) {}
+
+  int64_t length() const { return length_; }
+
+  /// \brief Finds the column of a field in the batch and computes which of its values
+  /// are valid.
+  Result<const Column*> Resolve(int32_t field_id) {
+    if (auto it = columns_.find(field_id); it != columns_.end()) {
+      return &it->second;
+    }
+
+    // Fields are checked when the expression is compiled.
+    const auto& positions = field_positions_.at(field_id);
+    Column column{.schema = &schema_,
+                  .array = &array_,
+                  .offset = array_.offset,
+                  .valid = Mask(length_, 1)};
+    ICEBERG_RETURN_UNEXPECTED(AndValidity(column));
+    for (int32_t pos : positions) {
+      if (std::string_view(column.schema->format) != "+s") {
+        return InvalidArrowData("Expected a struct array for field {}, got format {}",
+                                field_id, column.schema->format);
+      }
+      if (pos >= column.schema->n_children || pos >= column.array->n_children) {
+        return InvalidArrowData("Cannot find field {} at position {} of a struct with {} "
+                                "children",
+                                field_id, pos, column.array->n_children);
+      }
+      const ArrowArray* child = column.array->children[pos];
+      if (child->length < column.offset + length_) {
+        return InvalidArrowData("Child array of field {} is too short: {} < {}", field_id,
+                                child->length, column.offset + length_);
+      }
+      column.schema = column.schema->children[pos];
+      column.array = child;
+      column.offset += child->offset;
+      ICEBERG_RETURN_UNEXPECTED(AndValidity(column));
+    }
+    if (column.schema->dictionary != nullptr) {
+      ICEBERG_RETURN_UNEXPECTED(ResolveDictionary(column));
+    }
+    return &columns_.emplace(field_id, std::move(column)).first->second;
+  }
+
+ private:
+  /// \brief Resolves the dictionary of a column and the index of each valid row in it.
+  /// Rows whose dictionary value is null are not valid.
+  Status ResolveDictionary(Column& column) const {
+    const ArrowArray* values = column.array->dictionary;
+    if (values == nullptr) {
+      return InvalidArrowData("Dictionary-encoded Arrow array has no dictionary");
+    }
+    auto dictionary = std::make_shared<Column>(Column{.schema = column.schema->dictionary,
+                                                      .array = values,
+                                                      .offset = values->offset,
+                                                      .valid = Mask(values->length, 1)});
+    if (values->null_count != 0) {
+      ICEBERG_ASSIGN_OR_RAISE(auto bitmap, Buffer<uint8_t>(*dictionary, 0));
+      for (int64_t i = 0; bitmap != nullptr && i < values->length; ++i) {
+        dictionary->valid[i] = GetBit(bitmap, values->offset + i);
+      }
+    }
+
+    std::string_view format = column.schema->format;
+    column.indices.assign(length_, 0);
+    auto read_indices = [&]<typename Index>(Index) -> Status {
+      ICEBERG_ASSIGN_OR_RAISE(auto data, Buffer<Index>(column, 1));
+      for (int64_t i = 0; i < length_; ++i) {
+        if (!column.valid[i]) {
+          continue;
+        }
+        const auto index = static_cast<int64_t>(data[column.offset + i]);
+        if (index < 0 || index >= values->length) {
+          return InvalidArrowData("Dictionary index {} is out of range for {} values",
+                                  index, values->length);
+        }
+        column.indices[i] = index;
+        column.valid[i] = dictionary->valid[index];
+      }
+      return {};
+    };
+    if (format == "c") {
+      ICEBERG_RETURN_UNEXPECTED(read_indices(int8_t{}));
+    } else if (format == "C") {
+      ICEBERG_RETURN_UNEXPECTED(read_indices(uint8_t{}));
+    } else if (format == "s") {
+      ICEBERG_RETURN_UNEXPECTED(read_indices(int16_t{}));
+    } else if (format == "S") {
+      ICEBERG_RETURN_UNEXPECTED(read_indices(uint16_t{}));
+    } else if (format == "i") {
+      ICEBERG_RETURN_UNEXPECTED(read_indices(int32_t{}));
+    } else if (format == "I") {
+      ICEBERG_RETURN_UNEXPECTED(read_indices(uint32_t{}));
+    } else if (format == "l") {
+      ICEBERG_RETURN_UNEXPECTED(read_indices(int64_t{}));
+    } else {
+      return InvalidArrowData("Unsupported Arrow dictionary index format {}", format);
+    }
+    column.dictionary = std::move(dictionary);
+    return {};
+  }
+
+  Status AndValidity(Column& column) const {
+    if (column.array->null_count == 0) {
+      return {};
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto bitmap, Buffer<uint8_t>(column, 0));
+    if (bitmap == nullptr) {
+      return {};
+    }
+    for (int64_t i = 0; i < length_; ++i) {
+      column.valid[i] &= GetBit(bitmap, column.offset + i);
+    }
+    return {};
+  }
+
+  const FieldPositions& field_positions_;
+  const ArrowSchema& schema_;
+  const ArrowArray& array_;
+  const int64_t length_;
+  std::unordered_map<int32_t, Column> columns_;
+};
+
+/// \brief A node of a compiled expression.
+class Node {
+ public:
+  virtual ~Node() = default;
+
+  /// \brief Returns one byte per row of the batch, set for the matching rows.
+  virtual Result<Mask> Evaluate(Batch& batch) const = 0;
+};
+
+using NodePtr = std::shared_ptr<const Node>;
+
+class ConstantNode : public Node {
+ public:
+  explicit ConstantNode(bool value) : value_(value) {}
+
+  Result<Mask> Evaluate(Batch& batch) const override {
+    return Mask(batch.length(), value_ ? 1 : 0);
+  }
+
+ private:
+  const bool value_;
+};
+
+class NotNode : public Node {
+ public:
+  explicit NotNode(NodePtr child) : child_(std::move(child)) {}
+
+  Result<Mask> Evaluate(Batch& batch) const override {
+    ICEBERG_ASSIGN_OR_RAISE(auto result, child_->Evaluate(batch));
+    return Complement(std::move(result));
+  }
+
+ private:
+  const NodePtr child_;
+};
+
+class AndNode : public Node {
+ public:
+  AndNode(NodePtr left, NodePtr right)
+      : left_(std::move(left)), right_(std::move(right)) {}
+
+  Result<Mask> Evaluate(Batch& batch) const override {
+    ICEBERG_ASSIGN_OR_RAISE(auto left, left_->Evaluate(batch));
+    ICEBERG_ASSIGN_OR_RAISE(auto right, right_->Evaluate(batch));
+    return AndMask(std::move(left), right);
+  }
+
+ private:
+  const NodePtr left_;
+  const NodePtr right_;
+};
+
+class OrNode : public Node {
+ public:
+  OrNode(NodePtr left, NodePtr right)
+      : left_(std::move(left)), right_(std::move(right)) {}
+
+  Result<Mask> Evaluate(Batch& batch) const override {
+    ICEBERG_ASSIGN_OR_RAISE(auto left, left_->Evaluate(batch));
+    ICEBERG_ASSIGN_OR_RAISE(auto right, right_->Evaluate(batch));
+    return OrMask(std::move(left), right);
+  }
+
+ private:
+  const NodePtr left_;
+  const NodePtr right_;
+};
+
+class NotNullNode : public Node {
+ public:
+  explicit NotNullNode(int32_t field_id) : field_id_(field_id) {}
+
+  Result<Mask> Evaluate(Batch& batch) const override {
+    ICEBERG_ASSIGN_OR_RAISE(auto column, batch.Resolve(field_id_));
+    return column->valid;
+  }
+
+ private:
+  const int32_t field_id_;
+};
+
+template <typename T>
+class NaNNode : public Node {
+ public:
+  NaNNode(int32_t field_id, std::shared_ptr<Type> type)
+      : field_id_(field_id), type_(std::move(type)) {}
+
+  Result<Mask> Evaluate(Batch& batch) const override {
+    ICEBERG_ASSIGN_OR_RAISE(auto column, batch.Resolve(field_id_));
+    const Column& values = column->dictionary != nullptr ? *column->dictionary : *column;
+    ICEBERG_RETURN_UNEXPECTED(
+        CheckFormat(values, *type_, std::is_same_v<T, float> ? "f" : "g"));
+    ICEBERG_ASSIGN_OR_RAISE(auto data, Buffer<T>(values, 1));
+    auto result =
+        NaNValues(data + values.offset, static_cast<int64_t>(values.valid.size()));
+    if (column->dictionary != nullptr) {
+      return MapDictionary(*column, result);
+    }
+    return AndMask(std::move(result), column->valid);
+  }
+
+ private:
+  const int32_t field_id_;
+  const std::shared_ptr<Type> type_;
+};
+
+/// \brief A predicate on the values of a column whose keys have type `Key`, which calls
+/// `Derived::Match(values, length)` with the typed values of the column, or with the
+/// values of its dictionary if it is dictionary-encoded.
+///
+/// Null values never match.
+template <typename Derived, typename Key>
+class ValuesNode : public Node {
+ public:
+  ValuesNode(int32_t field_id, std::shared_ptr<Type> type)
+      : field_id_(field_id), type_(std::move(type)) {}
+
+  Result<Mask> Evaluate(Batch& batch) const override {
+    ICEBERG_ASSIGN_OR_RAISE(auto column, batch.Resolve(field_id_));
+    const Column& values_column =
+        column->dictionary != nullptr ? *column->dictionary : *column;
+    const auto length = static_cast<int64_t>(values_column.valid.size());
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto result,
+        WithValues(values_column, *type_, [&](const auto& values) -> Result<Mask> {
+          using Values = std::decay_t<decltype(values)>;
+          if constexpr (std::is_same_v<typename Values::Key, Key>) {
+            return static_cast<const Derived&>(*this).Match(values, length);
+          } else {
+            std::unreachable();
+          }
+        }));
+    if (column->dictionary != nullptr) {
+      return MapDictionary(*column, result);
+    }
+    return AndMask(std::move(result), column->valid);
+  }
+
+ private:
+  const int32_t field_id_;
+  const std::shared_ptr<Type> type_;
+};
+
+template <typename Key, typename Cmp>
+class CompareNode : public ValuesNode<CompareNode<Key, Cmp>, Key> {
+ public:
+  CompareNode(int32_t field_id, std::shared_ptr<Type> type, Key key)
+      : ValuesNode<CompareNode, Key>(field_id, std::move(type)), key_(key) {}
+
+  template <typename Values>
+  Mask Match(const Values& values, int64_t length) const {
+    return CompareValues(values, key_, length, Cmp{});
+  }
+
+ private:
+  const Key key_;
+};
+
+template <typename Key>
+class InNode : public ValuesNode<InNode<Key>, Key> {
+ public:
+  InNode(int32_t field_id, std::shared_ptr<Type> type, LiteralSet literal_set,
+         std::vector<Key> keys)
+      : ValuesNode<InNode, Key>(field_id, std::move(type)),
+        literal_set_(std::move(literal_set)),
+        keys_(std::move(keys)) {
+    if (keys_.size() > kInLinearLimit) {
+      std::sort(keys_.begin(), keys_.end());
+    }
+  }
+
+  template <typename Values>
+  Mask Match(const Values& values, int64_t length) const {
+    if (auto matches = ProbeIndex(values, length)) {
+      return std::move(*matches);
+    }
+    Mask matches(length, 0);
+    if (keys_.size() <= kInLinearLimit) {
+      for (const auto& key : keys_) {
+        for (int64_t i = 0; i < length; ++i) {
+          matches[i] |= values[i] == key;
+        }
+      }
+    } else {
+      for (int64_t i = 0; i < length; ++i) {
+        matches[i] = std::binary_search(keys_.begin(), keys_.end(), values[i]);
+      }
+    }
+    return matches;
+  }
+
+ private:
+  /// \brief Matches the values against the hash index of the set, or returns
+  /// std::nullopt if the set is not indexed for the keys of the values.
+  ///
+  /// Float columns also have integer keys, but their sets hold float values and are
+  /// never indexed as integers.
+  template <typename Values>
+  std::optional<Mask> ProbeIndex(const Values& values, int64_t length) const {
+    constexpr bool kIntegerKeys =
+        std::is_same_v<Key, int32_t> || std::is_same_v<Key, int64_t>;
+    constexpr bool kBinaryKeys = std::is_same_v<Key, std::string_view>;
+    if constexpr (kIntegerKeys || kBinaryKeys) {
+      if (literal_set_.size() <= kInLinearLimit ||
+          literal_set_.index_kind() != (kIntegerKeys ? LiteralSet::IndexKind::kInteger
+                                                     : LiteralSet::IndexKind::kBinary)) {
+        return std::nullopt;
+      }
+      // Probe in chunks to convert the keys without materializing the whole column.
+      using ProbeKey = std::conditional_t<kIntegerKeys, int64_t, std::string_view>;
+      constexpr int64_t kChunkSize = 1024;
+      std::array<ProbeKey, kChunkSize> keys;
+      Mask matches(length);
+      for (int64_t begin = 0; begin < length; begin += kChunkSize) {
+        const int64_t size = std::min(kChunkSize, length - begin);
+        for (int64_t i = 0; i < size; ++i) {
+          keys[i] = values[begin + i];
+        }
+        literal_set_.ContainsKeys(
+            std::span<const ProbeKey>(keys.data(), size),
+            std::span<uint8_t>(matches.data() + begin, static_cast<size_t>(size)));
+      }
+      return matches;
+    } else {
+      return std::nullopt;
+    }
+  }
+
+  const LiteralSet literal_set_;
+  std::vector<Key> keys_;
+};
+
+class StartsWithNode : public ValuesNode<StartsWithNode, std::string_view> {
+ public:
+  StartsWithNode(int32_t field_id, std::shared_ptr<Type> type, std::string_view prefix)
+      : ValuesNode(field_id, std::move(type)), prefix_(prefix) {}
+
+  template <typename Values>
+  Mask Match(const Values& values, int64_t length) const {
+    Mask matches(length);
+    for (int64_t i = 0; i < length; ++i) {
+      matches[i] = values[i].starts_with(prefix_);
+    }
+    return matches;
+  }
+
+ private:
+  const std::string_view prefix_;
+};
+
+/// \brief Compiles a bound expression into a tree of nodes, which are specialized for
+/// the key type of each referenced column and hold the literals already converted to
+/// keys, so that evaluating a batch does not dispatch on literal values.
+class Compiler : public BoundVisitor<NodePtr> {
+ public:
+  explicit Compiler(const FieldPositions& field_positions)
+      : field_positions_(field_positions) {}
+
+  Result<NodePtr> AlwaysTrue() override { return std::make_shared<ConstantNode>(true); }
+
+  Result<NodePtr> AlwaysFalse() override { return std::make_shared<ConstantNode>(false); }
+
+  Result<NodePtr> Not(NodePtr child_result) override {
+    return std::make_shared<NotNode>(std::move(child_result));
+  }
+
+  Result<NodePtr> And(NodePtr left_result, NodePtr right_result) override {
+    return std::make_shared<AndNode>(std::move(left_result), std::move(right_result));
+  }
+
+  Result<NodePtr> Or(NodePtr left_result, NodePtr right_result) override {
+    return std::make_shared<OrNode>(std::move(left_result), std::move(right_result));
+  }
+
+  Result<NodePtr> IsNull(const std::shared_ptr<BoundTerm>& term) override {
+    ICEBERG_ASSIGN_OR_RAISE(auto result, NotNull(term));
+    return std::make_shared<NotNode>(std::move(result));
+  }
+
+  Result<NodePtr> NotNull(const std::shared_ptr<BoundTerm>& term) override {
+    ICEBERG_ASSIGN_OR_RAISE(auto field_id, FieldId(term));
+    return std::make_shared<NotNullNode>(field_id);
+  }
+
+  Result<NodePtr> IsNaN(const std::shared_ptr<BoundTerm>& term) override {
+    ICEBERG_ASSIGN_OR_RAISE(auto field_id, FieldId(term));
+    switch (term->type()->type_id()) {
+      case TypeId::kFloat:
+        return std::make_shared<NaNNode<float>>(field_id, term->type());
+      case TypeId::kDouble:
+        return std::make_shared<NaNNode<double>>(field_id, term->type());
+      default:
+        return std::make_shared<ConstantNode>(false);
+    }
+  }
+
+  Result<NodePtr> NotNaN(const std::shared_ptr<BoundTerm>& term) override {
+    ICEBERG_ASSIGN_OR_RAISE(auto result, IsNaN(term));
+    return std::make_shared<NotNode>(std::move(result));
+  }
+
+  Result<NodePtr> Lt(const std::shared_ptr<BoundTerm>& term,
+                     const Literal& lit) override {
+    return Compare<std::less<>>(term, lit);
+  }
+
+  Result<NodePtr> LtEq(const std::shared_ptr<BoundTerm>& term,
+                       const Literal& lit) override {
+    return Compare<std::less_equal<>>(term, lit);
+  }
+
+  Result<NodePtr> Gt(const std::shared_ptr<BoundTerm>& term,
+                     const Literal& lit) override {
+    return Compare<std::greater<>>(term, lit);
+  }
+
+  Result<NodePtr> GtEq(const std::shared_ptr<BoundTerm>& term,
+                       const Literal& lit) override {
+    return Compare<std::greater_equal<>>(term, lit);
+  }
+
+  Result<NodePtr> Eq(const std::shared_ptr<BoundTerm>& term,
+                     const Literal& lit) override {
+    return Compare<std::equal_to<>>(term, lit);
+  }
+
+  Result<NodePtr> NotEq(const std::shared_ptr<BoundTerm>& term,
+                        const Literal& lit) override {
+    ICEBERG_ASSIGN_OR_RAISE(auto result, Eq(term, lit));
+    return std::make_shared<NotNode>(std::move(result));
+  }
+
+  Result<NodePtr> In(const std::shared_ptr<BoundTerm>& term,
+                     const BoundSetPredicate::LiteralSet& literal_set) override {
+    ICEBERG_ASSIGN_OR_RAISE(auto field_id, FieldId(term));
+    return VisitType(*term->type(), [&](const auto& type) -> Result<NodePtr> {
+      using T = std::decay_t<decltype(type)>;
+      if constexpr (HasKeyTraits<T>) {
+        using Key = typename KeyTraits<T>::Key;
+        std::vector<Key> keys;
+        keys.reserve(literal_set.size());
+        for (const auto& value : literal_set) {
+          ICEBERG_ASSIGN_OR_RAISE(auto key, KeyTraits<T>::FromValue(value));
+          keys.push_back(key);
+        }
+        return std::make_shared<InNode<Key>>(field_id, term->type(), literal_set,
+                                             std::move(keys));
+      } else {
+        return NotSupported("Cannot evaluate predicates on {} columns", type.ToString());
+      }
+    });
+  }
+
+  Result<NodePtr> NotIn(const std::shared_ptr<BoundTerm>& term,
+                        const BoundSetPredicate::LiteralSet& literal_set) override {
+    ICEBERG_ASSIGN_OR_RAISE(auto result, In(term, literal_set));
+    return std::make_shared<NotNode>(std::move(result));
+  }
+
+  Result<NodePtr> StartsWith(const std::shared_ptr<BoundTerm>& term,
+                             const Literal& lit) override {
+    ICEBERG_ASSIGN_OR_RAISE(auto field_id, FieldId(term));
+    return VisitType(*term->type(), [&](const auto& type) -> Result<NodePtr> {
+      using T = std::decay_t<decltype(type)>;
+      if constexpr (HasKeyTraits<T>) {
+        if constexpr (std::is_same_v<typename KeyTraits<T>::Key, std::string_view>) {
+          ICEBERG_ASSIGN_OR_RAISE(auto prefix, KeyTraits<T>::FromValue(lit.value()));
+          return std::make_shared<StartsWithNode>(field_id, term->type(), prefix);
+        }
+      }
+      return InvalidExpression("Cannot evaluate starts with on {}", term->ToString());
+    });
+  }
+
+  Result<NodePtr> NotStartsWith(const std::shared_ptr<BoundTerm>& term,
+                                const Literal& lit) override {
+    ICEBERG_ASSIGN_OR_RAISE(auto result, StartsWith(term, lit));
+    return std::make_shared<NotNode>(std::move(result));
+  }
+
+ private:
+  template <typename Cmp>
+  Result<NodePtr> Compare(const std::shared_ptr<BoundTerm>& term, const Literal& lit) {
+    ICEBERG_ASSIGN_OR_RAISE(auto field_id, FieldId(term));
+    return VisitType(*term->type(), [&](const auto& type) -> Result<NodePtr> {
+      using T = std::decay_t<decltype(type)>;
+      if constexpr (HasKeyTraits<T>) {
+        using Key = typename KeyTraits<T>::Key;
+        ICEBERG_ASSIGN_OR_RAISE(auto key, KeyTraits<T>::FromValue(lit.value()));
+        return std::make_shared<CompareNode<Key, Cmp>>(field_id, term->type(), key);
+      } else {
+        return NotSupported("Cannot evaluate predicates on {} columns", type.ToString());
+      }
+    });
+  }
+
+  /// \brief Returns the id of the field of a bound reference, which must be reachable
+  /// from the batch struct through structs only.
+  Result<int32_t> FieldId(const std::shared_ptr<BoundTerm>& term) const {
+    if (term->kind() != Term::Kind::kReference) {
+      return NotSupported("Cannot evaluate {} on a batch, only references are supported",
+                          term->ToString());
+    }
+    const int32_t field_id = term->reference()->field().field_id();
+    if (!field_positions_.contains(field_id)) {
+      return NotSupported("Cannot evaluate field {} nested in a list or map on a batch",
+                          field_id);
+    }
+    return field_id;
+  }
+
+  const FieldPositions& field_positions_;
+};
+
+void CollectFieldPositions(const StructType& type, std::vector<int32_t>& path,
+                           FieldPositions& positions) {
+  const auto fields = type.fields();
+  for (size_t pos = 0; pos < fields.size(); ++pos) {
+    path.push_back(static_cast<int32_t>(pos));
+    positions.emplace(fields[pos].field_id(), path);
+    const auto& field_type = fields[pos].type();
+    if (field_type->type_id() == TypeId::kStruct) {
+      CollectFieldPositions(internal::checked_cast<const StructType&>(*field_type), path,
+                            positions);
+    }
+    path.pop_back();
+  }
+}
+
+}  // namespace
+
+class BatchEvaluator::Impl {
+ public:
+  // The bound expression, which owns the literals that string keys of the nodes
+  // point to.
+  std::shared_ptr<Expression> expr;
+  // Field id to the positions of the field and its parents in the batch struct.
+  FieldPositions field_positions;
+  NodePtr root;
+};
+
+BatchEvaluator::BatchEvaluator(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+
+BatchEvaluator::~BatchEvaluator() = default;
+
+Result<std::unique_ptr<BatchEvaluator>> BatchEvaluator::Make(
+    const Schema& schema, const std::shared_ptr<Expression>& expr, bool case_sensitive) {
+  auto impl = std::make_unique<Impl>();
+  impl->expr = expr;
+  ICEBERG_ASSIGN_OR_RAISE(auto is_bound, Binder::IsBound(expr));
+  if (!is_bound) {
+    ICEBERG_ASSIGN_OR_RAISE(impl->expr, Binder::Bind(schema, expr, case_sensitive));
+  }
+  std::vector<int32_t> path;
+  CollectFieldPositions(schema, path, impl->field_positions);
+  Compiler compiler(impl->field_positions);
+  ICEBERG_ASSIGN_OR_RAISE(impl->root, Visit<NodePtr>(impl->expr, compiler));
+  return std::unique_ptr<BatchEvaluator>(new BatchEvaluator(std::move(impl)));
+}
+
+Result<std::vector<uint8_t>> BatchEvaluator::Evaluate(const ArrowSchema& schema,
+                                                      const ArrowArray& array) const {
+  if (std::string_view(schema.format) != "+s") {
+    return InvalidArrowData("Cannot evaluate a batch that is not a struct array: {}",
+                            schema.format);
+  }
+  Batch batch(impl_->field_positions, schema, array);
+  ICEBERG_ASSIGN_OR_RAISE(auto mask, impl_->root->Evaluate(batch));
+
+  std::vector<uint8_t> bitmap((array.length + 7) / 8, 0);
+  for (int64_t i = 0; i < array.length; ++i) {
+    bitmap[i >> 3] |= static_cast<uint8_t>(mask[i] << (i & 7));
+  }
+  return bitmap;
+}
+
+}  // namespace iceberg
@@ -0,0 +1,82 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/expression/batch_evaluator.h
+/// Evaluate filters against batches of rows in Arrow columnar format.
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "iceberg/arrow_c_data.h"
+#include "iceberg/expression/expression.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief Evaluates an expression on all rows of an Arrow struct array at once.
+///
+/// The expression is compiled once into a tree of predicates specialized for the type
+/// of each referenced column, with literals already converted to the representation of
+/// the column values. Each batch is then evaluated column by column with typed kernels
+/// over the Arrow buffers instead of row by row through StructLike, which makes the
+/// evaluator suitable for residual filtering of scanned data. Predicates on
+/// dictionary-encoded columns are evaluated once on the dictionary values, and their
+/// results are mapped to the rows through the indices.
+///
+/// Null values never satisfy a comparison, IN, IS NAN or STARTS_WITH predicate, while
+/// their negations (NOT_EQ, NOT_IN, NOT_NAN and NOT_STARTS_WITH) are the exact
+/// complement of the positive predicates and therefore select null values.
+class ICEBERG_EXPORT BatchEvaluator {
+ public:
+  ~BatchEvaluator();
+
+  /// \brief Creates an evaluator for a filter on table rows.
+  ///
+  /// Predicates may reference primitive columns nested in structs, but not columns
+  /// nested in lists or maps, nor transforms of columns.
+  ///
+  /// \param schema The schema of the evaluated batches, whose top-level fields are the
+  /// children of the batch struct array in the same order
+  /// \param expr A bound or unbound expression on the schema
+  /// \param case_sensitive Whether field name matching should be case sensitive
+  static Result<std::unique_ptr<BatchEvaluator>> Make(
+      const Schema& schema, const std::shared_ptr<Expression>& expr,
+      bool case_sensitive = true);
+
+  /// \brief Evaluates the expression on every row of a batch.
+  ///
+  /// \param schema The Arrow schema of the batch
+  /// \param array The struct array of the batch
+  /// \return A bitmap in Arrow validity layout with a bit set for each matching row
+  Result<std::vector<uint8_t>> Evaluate(const ArrowSchema& schema,
+                                        const ArrowArray& array) const;
+
+ private:
+  class Impl;
+  explicit BatchEvaluator(std::unique_ptr<Impl> impl);
+
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace iceberg
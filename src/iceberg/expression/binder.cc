@@ -0,0 +1,390 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/expression/binder.h"
+
+#include <cmath>
+#include <compare>
+#include <optional>
+#include <variant>
+#include <vector>
+
+#include "iceberg/expression/expression_visitor.h"
+#include "iceberg/expression/expressions.h"
+#include "iceberg/expression/predicate.h"
+#include "iceberg/schema.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+class BindVisitor : public ExpressionVisitor<std::shared_ptr<Expression>> {
+ public:
+  BindVisitor(const Schema& schema, bool case_sensitive)
+      : schema_(schema), case_sensitive_(case_sensitive) {}
+
+  Result<std::shared_ptr<Expression>> AlwaysTrue() override {
+    return Expressions::AlwaysTrue();
+  }
+
+  Result<std::shared_ptr<Expression>> AlwaysFalse() override {
+    return Expressions::AlwaysFalse();
+  }
+
+  Result<std::shared_ptr<Expression>> Not(
+      std::shared_ptr<Expression> child_result) override {
+    return Expressions::Not(std::move(child_result));
+  }
+
+  Result<std::shared_ptr<Expression>> And(
+      std::shared_ptr<Expression> left_result,
+      std::shared_ptr<Expression> right_result) override {
+    return Expressions::And(std::move(left_result), std::move(right_result));
+  }
+
+  Result<std::shared_ptr<Expression>> Or(
+      std::shared_ptr<Expression> left_result,
+      std::shared_ptr<Expression> right_result) override {
+    return Expressions::Or(std::move(left_result), std::move(right_result));
+  }
+
+  Result<std::shared_ptr<Expression>> Predicate(
+      const std::shared_ptr<BoundPredicate>& pred) override {
+    return InvalidExpression("Found already bound predicate: {}", pred->ToString());
+  }
+
+  Result<std::shared_ptr<Expression>> Predicate(
+      const std::shared_ptr<Unbound<Expression>>& pred) override {
+    return pred->Bind(schema_, case_sensitive_);
+  }
+
+ private:
+  const Schema& schema_;
+  bool case_sensitive_;
+};
+
+bool IsLowerBound(Expression::Operation op) {
+  return op == Expression::Operation::kGt || op == Expression::Operation::kGtEq;
+}
+
+bool IsUpperBound(Expression::Operation op) {
+  return op == Expression::Operation::kLt || op == Expression::Operation::kLtEq;
+}
+
+/// \brief Returns the predicate if it is an `=`, `<`, `<=`, `>` or `>=` comparison.
+std::shared_ptr<BoundLiteralPredicate> AsRangePredicate(
+    const std::shared_ptr<Expression>& expr) {
+  if (expr->op() != Expression::Operation::kEq && !IsLowerBound(expr->op()) &&
+      !IsUpperBound(expr->op())) {
+    return nullptr;
+  }
+  return std::dynamic_pointer_cast<BoundLiteralPredicate>(expr);
+}
+
+bool IsNaN(const Literal& literal) {
+  if (const auto* value = std::get_if<float>(&literal.value())) {
+    return std::isnan(*value);
+  }
+  if (const auto* value = std::get_if<double>(&literal.value())) {
+    return std::isnan(*value);
+  }
+  return false;
+}
+
+/// \brief Whether `value` satisfies the comparison `op` against `bound`.
+bool Satisfies(const Literal& value, Expression::Operation op, const Literal& bound) {
+  auto cmp = value <=> bound;
+  switch (op) {
+    case Expression::Operation::kLt:
+      return cmp < 0;
+    case Expression::Operation::kLtEq:
+      return cmp <= 0;
+    case Expression::Operation::kGt:
+      return cmp > 0;
+    case Expression::Operation::kGtEq:
+      return cmp >= 0;
+    default:
+      return cmp == 0;
+  }
+}
+
+/// \brief Merges two range predicates on the same term into one expression.
+///
+/// \return The merged expression, or std::nullopt if the conjunction cannot be
+/// expressed as a single predicate, e.g. a non-empty range with two bounds.
+std::optional<std::shared_ptr<Expression>> MergeRanges(
+    const std::shared_ptr<BoundLiteralPredicate>& left,
+    const std::shared_ptr<BoundLiteralPredicate>& right) {
+  const auto& left_value = left->literal();
+  const auto& right_value = right->literal();
+  auto cmp = left_value <=> right_value;
+  if (cmp == std::partial_ordering::unordered || IsNaN(left_value) ||
+      IsNaN(right_value)) {
+    return std::nullopt;
+  }
+
+  auto left_op = left->op();
+  auto right_op = right->op();
+  if (left_op == Expression::Operation::kEq) {
+    if (Satisfies(left_value, right_op, right_value)) {
+      return left;
+    }
+    return Expressions::AlwaysFalse();
+  }
+  if (right_op == Expression::Operation::kEq) {
+    if (Satisfies(right_value, left_op, left_value)) {
+      return right;
+    }
+    return Expressions::AlwaysFalse();
+  }
+
+  if (IsLowerBound(left_op) && IsLowerBound(right_op)) {
+    // Keep the tighter bound; on a tie the exclusive one is tighter.
+    if (cmp == 0) {
+      return right_op == Expression::Operation::kGt ? right : left;
+    }
+    return cmp > 0 ? left : right;
+  }
+  if (IsUpperBound(left_op) && IsUpperBound(right_op)) {
+    if (cmp == 0) {
+      return right_op == Expression::Operation::kLt ? right : left;
+    }
+    return cmp < 0 ? left : right;
+  }
+
+  const auto& lower = IsLowerBound(left_op) ? left : right;
+  const auto& upper = IsLowerBound(left_op) ? right : left;
+  auto bounds_cmp = lower->literal() <=> upper->literal();
+  if (bounds_cmp > 0) {
+    return Expressions::AlwaysFalse();
+  }
+  if (bounds_cmp == 0) {
+    if (lower->op() == Expression::Operation::kGtEq &&
+        upper->op() == Expression::Operation::kLtEq) {
+      return std::make_shared<BoundLiteralPredicate>(Expression::Operation::kEq,
+                                                     lower->term(), lower->literal());
+    }
+    return Expressions::AlwaysFalse();
+  }
+  return std::nullopt;
+}
+
+/// \brief Simplifies an expression after binding.
+///
+/// Negations are pushed down to the predicates, and the range predicates of a
+/// conjunction that share a term are merged, folding empty ranges to false. Predicates
+/// themselves are already folded for the field type by UnboundPredicate::Bind.
+class Simplifier {
+ public:
+  Result<std::shared_ptr<Expression>> Simplify(const std::shared_ptr<Expression>& expr) {
+    switch (expr->op()) {
+      case Expression::Operation::kNot: {
+        // Negating the child pushes the Not down to the predicates.
+        const auto& not_expr = internal::checked_cast<const ::iceberg::Not&>(*expr);
+        ICEBERG_ASSIGN_OR_RAISE(auto negated, not_expr.child()->Negate());
+        return Simplify(negated);
+      }
+      case Expression::Operation::kAnd: {
+        std::vector<std::shared_ptr<Expression>> conjuncts;
+        ICEBERG_ASSIGN_OR_RAISE(auto always_false, CollectConjuncts(expr, conjuncts));
+        if (always_false) {
+          return Expressions::AlwaysFalse();
+        }
+        std::shared_ptr<Expression> result = Expressions::AlwaysTrue();
+        for (auto& conjunct : conjuncts) {
+          result = Expressions::And(std::move(result), std::move(conjunct));
+        }
+        return result;
+      }
+      case Expression::Operation::kOr: {
+        const auto& or_expr = internal::checked_cast<const ::iceberg::Or&>(*expr);
+        ICEBERG_ASSIGN_OR_RAISE(auto left, Simplify(or_expr.left()));
+        ICEBERG_ASSIGN_OR_RAISE(auto right, Simplify(or_expr.right()));
+        return Expressions::Or(std::move(left), std::move(right));
+      }
+      default:
+        return expr;
+    }
+  }
+
+ private:
+  /// \brief Flattens a conjunction into `conjuncts`, merging range predicates.
+  ///
+  /// \return Whether the conjunction is always false.
+  Result<bool> CollectConjuncts(const std::shared_ptr<Expression>& expr,
+                                std::vector<std::shared_ptr<Expression>>& conjuncts) {
+    if (expr->op() == Expression::Operation::kAnd) {
+      const auto& and_expr = internal::checked_cast<const ::iceberg::And&>(*expr);
+      ICEBERG_ASSIGN_OR_RAISE(auto left_false,
+                              CollectConjuncts(and_expr.left(), conjuncts));
+      if (left_false) {
+        return true;
+      }
+      return CollectConjuncts(and_expr.right(), conjuncts);
+    }
+
+    ICEBERG_ASSIGN_OR_RAISE(auto simplified, Simplify(expr));
+    switch (simplified->op()) {
+      case Expression::Operation::kTrue:
+        return false;
+      case Expression::Operation::kFalse:
+        return true;
+      case Expression::Operation::kAnd:
+        // A negated disjunction becomes a conjunction that is flattened as well.
+        return CollectConjuncts(simplified, conjuncts);
+      default:
+        return AddConjunct(std::move(simplified), conjuncts);
+    }
+  }
+
+  /// \brief Appends a conjunct, or merges it into a range predicate on the same term.
+  ///
+  /// \return Whether the conjunction is always false.
+  static bool AddConjunct(std::shared_ptr<Expression> expr,
+                          std::vector<std::shared_ptr<Expression>>& conjuncts) {
+    if (auto pred = AsRangePredicate(expr)) {
+      for (auto& conjunct : conjuncts) {
+        auto other = AsRangePredicate(conjunct);
+        if (other == nullptr || !other->term()->Equals(*pred->term())) {
+          continue;
+        }
+        if (auto merged = MergeRanges(other, pred)) {
+          if ((*merged)->op() == Expression::Operation::kFalse) {
+            return true;
+          }
+          conjunct = std::move(*merged);
+          return false;
+        }
+      }
+    }
+    conjuncts.push_back(std::move(expr));
+    return false;
+  }
+};
+
+/// \brief Reports std::nullopt for subtrees without predicates.
+class IsBoundVisitor : public ExpressionVisitor<std::optional<bool>> {
+ public:
+  Result<std::optional<bool>> AlwaysTrue() override { return std::nullopt; }
+
+  Result<std::optional<bool>> AlwaysFalse() override { return std::nullopt; }
+
+  Result<std::optional<bool>> Not(std::optional<bool> child_result) override {
+    return child_result;
+  }
+
+  Result<std::optional<bool>> And(std::optional<bool> left_result,
+                                  std::optional<bool> right_result) override {
+    return Combine(left_result, right_result);
+  }
+
+  Result<std::optional<bool>> Or(std::optional<bool> left_result,
+                                 std::optional<bool> right_result) override {
+    return Combine(left_result, right_result);
+  }
+
+  Result<std::optional<bool>> Predicate(
+      const std::shared_ptr<BoundPredicate>& pred) override {
+    return true;
+  }
+
+  Result<std::optional<bool>> Predicate(
+      const std::shared_ptr<Unbound<Expression>>& pred) override {
+    return false;
+  }
+
+ private:
+  static Result<std::optional<bool>> Combine(std::optional<bool> left,
+                                             std::optional<bool> right) {
+    if (!left.has_value()) {
+      return right;
+    }
+    if (!right.has_value()) {
+      return left;
+    }
+    if (*left != *right) {
+      return InvalidExpression("Found partially bound expression");
+    }
+    return left;
+  }
+};
+
+/// \brief Collects the field IDs of the references of bound predicates.
+class ReferenceVisitor : public ExpressionVisitor<std::monostate> {
+ public:
+  explicit ReferenceVisitor(std::unordered_set<int32_t>& field_ids)
+      : field_ids_(field_ids) {}
+
+  Result<std::monostate> AlwaysTrue() override { return {}; }
+
+  Result<std::monostate> AlwaysFalse() override { return {}; }
+
+  Result<std::monostate> Not(std::monostate) override { return {}; }
+
+  Result<std::monostate> And(std::monostate, std::monostate) override { return {}; }
+
+  Result<std::monostate> Or(std::monostate, std::monostate) override { return {}; }
+
+  Result<std::monostate> Predicate(const std::shared_ptr<BoundPredicate>& pred) override {
+    field_ids_.insert(pred->reference()->field().field_id());
+    return {};
+  }
+
+  Result<std::monostate> Predicate(
+      const std::shared_ptr<Unbound<Expression>>& pred) override {
+    return InvalidExpression("Found unbound predicate while collecting references");
+  }
+
+ private:
+  std::unordered_set<int32_t>& field_ids_;
+};
+
+}  // namespace
+
+Result<std::shared_ptr<Expression>> Binder::Bind(const Schema& schema,
+                                                 const std::shared_ptr<Expression>& expr,
+                                                 bool case_sensitive) {
+  BindVisitor visitor(schema, case_sensitive);
+  ICEBERG_ASSIGN_OR_RAISE(auto bound, Visit<std::shared_ptr<Expression>>(expr, visitor));
+  Simplifier simplifier;
+  return simplifier.Simplify(bound);
+}
+
+Result<bool> Binder::IsBound(const std::shared_ptr<Expression>& expr) {
+  IsBoundVisitor visitor;
+  ICEBERG_ASSIGN_OR_RAISE(auto is_bound, Visit<std::optional<bool>>(expr, visitor));
+  return is_bound.value_or(false);
+}
+
+Result<std::unordered_set<int32_t>> Binder::BoundReferences(
+    const Schema& schema, const std::shared_ptr<Expression>& expr, bool case_sensitive) {
+  ICEBERG_ASSIGN_OR_RAISE(auto is_bound, IsBound(expr));
+  std::shared_ptr<Expression> bound = expr;
+  if (!is_bound) {
+    ICEBERG_ASSIGN_OR_RAISE(bound, Bind(schema, expr, case_sensitive));
+  }
+  std::unordered_set<int32_t> field_ids;
+  ReferenceVisitor visitor(field_ids);
+  ICEBERG_RETURN_UNEXPECTED(Visit<std::monostate>(bound, visitor));
+  return field_ids;
+}
+
+}  // namespace iceberg
@@ -0,0 +1,70 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/expression/binder.h
+/// Bind unbound expressions to a schema.
+
+#include <cstdint>
+#include <memory>
+#include <unordered_set>
+
+#include "iceberg/expression/expression.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief Binds every predicate of an expression tree to a schema.
+class ICEBERG_EXPORT Binder {
+ public:
+  /// \brief Bind an expression to a schema.
+  ///
+  /// The bound expression is simplified: Not nodes are pushed down to the predicates,
+  /// and the `=`, `<`, `<=`, `>` and `>=` predicates of a conjunction on the same term
+  /// are merged, e.g. `a > 1 and a >= 3` becomes `a >= 3` and `a > 5 and a < 3`
+  /// becomes false.
+  ///
+  /// \param schema The schema to bind field references against
+  /// \param expr The expression to bind, which must not contain bound predicates
+  /// \param case_sensitive Whether field name matching should be case sensitive
+  /// \return The bound expression, or an error if a reference cannot be resolved
+  static Result<std::shared_ptr<Expression>> Bind(const Schema& schema,
+                                                  const std::shared_ptr<Expression>& expr,
+                                                  bool case_sensitive);
+
+  /// \brief Returns whether all predicates of an expression are bound.
+  ///
+  /// Expressions without any predicate, such as `true`, are considered unbound.
+  static Result<bool> IsBound(const std::shared_ptr<Expression>& expr);
+
+  /// \brief Returns the IDs of the fields referenced by an expression.
+  ///
+  /// \param schema The schema to bind field references against
+  /// \param expr The expression, bound to `schema` or unbound
+  /// \param case_sensitive Whether field name matching should be case sensitive
+  /// \return The referenced field IDs, or an error if a reference cannot be resolved
+  static Result<std::unordered_set<int32_t>> BoundReferences(
+      const Schema& schema, const std::shared_ptr<Expression>& expr,
+      bool case_sensitive);
+};
+
+}  // namespace iceberg
@@ -0,0 +1,297 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/expression/expression_serialization.h"
+
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "iceberg/expression/expression.h"
+#include "iceberg/expression/literal.h"
+#include "iceberg/expression/predicate.h"
+#include "iceberg/expression/term.h"
+#include "iceberg/schema.h"
+#include "iceberg/transform.h"
+#include "iceberg/type.h"
+#include "iceberg/util/binary_codec_internal.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/conversions.h"
+#include "iceberg/util/formatter.h"  // IWYU pragma: keep
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+constexpr uint8_t kFormatVersion = 1;
+
+// Whether a predicate is written with field names or field IDs.
+constexpr uint8_t kUnboundPredicate = 0;
+constexpr uint8_t kBoundPredicate = 1;
+
+template <typename B>
+Status WriteUnboundPredicate(BinaryWriter& writer, const UnboundPredicate<B>& predicate) {
+  const auto& term = predicate.term();
+  writer.Byte(kUnboundPredicate);
+  writer.Byte(static_cast<uint8_t>(term->kind()));
+  writer.String(term->reference()->name());
+  if constexpr (std::is_same_v<B, BoundTransform>) {
+    writer.String(
+        internal::checked_cast<const UnboundTransform&>(*term).transform()->ToString());
+  }
+  writer.Varint(predicate.literals().size());
+  for (const auto& literal : predicate.literals()) {
+    ICEBERG_RETURN_UNEXPECTED(WriteBinaryLiteral(writer, literal));
+  }
+  return {};
+}
+
+Result<const PrimitiveType*> PrimitiveTermType(const BoundTerm& term) {
+  auto type = term.type();
+  if (!type->is_primitive()) {
+    return InvalidExpression("Cannot serialize a predicate on a {} term", *type);
+  }
+  return internal::checked_cast<const PrimitiveType*>(type.get());
+}
+
+Status WriteBoundPredicate(BinaryWriter& writer, const BoundPredicate& predicate) {
+  auto& term = *predicate.term();
+  writer.Byte(kBoundPredicate);
+  writer.Byte(static_cast<uint8_t>(term.kind()));
+  writer.Long(term.reference()->field().field_id());
+  switch (term.kind()) {
+    case Term::Kind::kReference:
+      break;
+    case Term::Kind::kTransform:
+      writer.String(
+          internal::checked_cast<const BoundTransform&>(term).transform()->ToString());
+      break;
+    default:
+      return NotSupported("Cannot serialize the term {}", term);
+  }
+
+  switch (predicate.kind()) {
+    case BoundPredicate::Kind::kUnary:
+      return {};
+    case BoundPredicate::Kind::kLiteral: {
+      const auto& literal =
+          internal::checked_cast<const BoundLiteralPredicate&>(predicate).literal();
+      return WriteBinaryLiteral(writer, literal);
+    }
+    case BoundPredicate::Kind::kSet: {
+      // The values of a set have the type of its term.
+      ICEBERG_ASSIGN_OR_RAISE(auto type, PrimitiveTermType(term));
+      const auto& values =
+          internal::checked_cast<const BoundSetPredicate&>(predicate).literal_set();
+      writer.Varint(values.size());
+      for (const auto& value : values) {
+        ICEBERG_ASSIGN_OR_RAISE(auto bytes, Conversions::ToBytes(*type, value));
+        writer.Bytes(bytes);
+      }
+      return {};
+    }
+  }
+  std::unreachable();
+}
+
+Status WriteExpression(BinaryWriter& writer, const Expression& expr) {
+  writer.Byte(static_cast<uint8_t>(expr.op()));
+  switch (expr.op()) {
+    case Expression::Operation::kTrue:
+    case Expression::Operation::kFalse:
+      return {};
+    case Expression::Operation::kNot:
+      return WriteExpression(writer, *internal::checked_cast<const Not&>(expr).child());
+    case Expression::Operation::kAnd: {
+      const auto& and_expr = internal::checked_cast<const And&>(expr);
+      ICEBERG_RETURN_UNEXPECTED(WriteExpression(writer, *and_expr.left()));
+      return WriteExpression(writer, *and_expr.right());
+    }
+    case Expression::Operation::kOr: {
+      const auto& or_expr = internal::checked_cast<const Or&>(expr);
+      ICEBERG_RETURN_UNEXPECTED(WriteExpression(writer, *or_expr.left()));
+      return WriteExpression(writer, *or_expr.right());
+    }
+    default:
+      break;
+  }
+
+  if (const auto* predicate = dynamic_cast<const BoundPredicate*>(&expr)) {
+    return WriteBoundPredicate(writer, *predicate);
+  }
+  if (const auto* predicate =
+          dynamic_cast<const UnboundPredicate<BoundReference>*>(&expr)) {
+    return WriteUnboundPredicate(writer, *predicate);
+  }
+  if (const auto* predicate =
+          dynamic_cast<const UnboundPredicate<BoundTransform>*>(&expr)) {
+    return WriteUnboundPredicate(writer, *predicate);
+  }
+  return NotSupported("Cannot serialize the expression {}", expr);
+}
+
+Result<std::shared_ptr<Transform>> ReadTransform(BinaryReader& reader) {
+  ICEBERG_ASSIGN_OR_RAISE(auto transform_str, reader.String());
+  return TransformFromString(transform_str);
+}
+
+Result<std::shared_ptr<Expression>> ReadUnboundPredicate(BinaryReader& reader,
+                                                         Expression::Operation op,
+                                                         Term::Kind kind) {
+  ICEBERG_ASSIGN_OR_RAISE(auto name, reader.String());
+  auto ref = std::make_shared<NamedReference>(std::move(name));
+  std::shared_ptr<Transform> transform;
+  if (kind == Term::Kind::kTransform) {
+    ICEBERG_ASSIGN_OR_RAISE(transform, ReadTransform(reader));
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto count, reader.Count());
+  std::vector<Literal> literals;
+  literals.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    ICEBERG_ASSIGN_OR_RAISE(auto literal, ReadBinaryLiteral(reader));
+    literals.push_back(std::move(literal));
+  }
+  if (transform == nullptr) {
+    return std::make_shared<UnboundPredicate<BoundReference>>(op, std::move(ref),
+                                                              std::move(literals));
+  }
+  return std::make_shared<UnboundPredicate<BoundTransform>>(
+      op, std::make_shared<UnboundTransform>(std::move(ref), std::move(transform)),
+      std::move(literals));
+}
+
+Result<std::shared_ptr<Expression>> ReadBoundPredicate(BinaryReader& reader,
+                                                       Expression::Operation op,
+                                                       Term::Kind kind,
+                                                       const Schema& schema) {
+  ICEBERG_ASSIGN_OR_RAISE(auto field_id, reader.Int());
+  ICEBERG_ASSIGN_OR_RAISE(auto field, schema.FindFieldById(field_id));
+  if (!field.has_value()) {
+    return Invalid("Field {} of a serialized predicate is not in the schema", field_id);
+  }
+  auto ref = std::make_shared<BoundReference>(field->get());
+  std::shared_ptr<BoundTerm> term = ref;
+  if (kind == Term::Kind::kTransform) {
+    ICEBERG_ASSIGN_OR_RAISE(auto transform, ReadTransform(reader));
+    ICEBERG_ASSIGN_OR_RAISE(auto transform_func, transform->Bind(ref->type()));
+    term = std::make_shared<BoundTransform>(std::move(ref), std::move(transform),
+                                            std::move(transform_func));
+  }
+
+  switch (op) {
+    case Expression::Operation::kIsNull:
+    case Expression::Operation::kNotNull:
+    case Expression::Operation::kIsNan:
+    case Expression::Operation::kNotNan:
+      return std::make_shared<BoundUnaryPredicate>(op, std::move(term));
+    case Expression::Operation::kIn:
+    case Expression::Operation::kNotIn: {
+      ICEBERG_ASSIGN_OR_RAISE(auto type, PrimitiveTermType(*term));
+      ICEBERG_ASSIGN_OR_RAISE(auto count, reader.Count());
+      std::vector<Literal::Value> values;
+      values.reserve(count);
+      for (size_t i = 0; i < count; ++i) {
+        ICEBERG_ASSIGN_OR_RAISE(auto bytes, reader.Bytes());
+        ICEBERG_ASSIGN_OR_RAISE(auto value, Conversions::FromBytes(*type, bytes));
+        values.push_back(std::move(value));
+      }
+      return std::make_shared<BoundSetPredicate>(op, std::move(term),
+                                                 LiteralSet(std::move(values)));
+    }
+    default: {
+      ICEBERG_ASSIGN_OR_RAISE(auto literal, ReadBinaryLiteral(reader));
+      return std::make_shared<BoundLiteralPredicate>(op, std::move(term),
+                                                     std::move(literal));
+    }
+  }
+}
+
+Result<std::shared_ptr<Expression>> ReadExpression(BinaryReader& reader,
+                                                   const Schema* schema) {
+  ICEBERG_ASSIGN_OR_RAISE(auto op_value, reader.Byte());
+  if (op_value > static_cast<uint8_t>(Expression::Operation::kNotStartsWith)) {
+    return Invalid("Invalid expression operation {} in serialized data", op_value);
+  }
+  const auto op = static_cast<Expression::Operation>(op_value);
+  switch (op) {
+    case Expression::Operation::kTrue:
+      return True::Instance();
+    case Expression::Operation::kFalse:
+      return False::Instance();
+    case Expression::Operation::kNot: {
+      ICEBERG_ASSIGN_OR_RAISE(auto child, ReadExpression(reader, schema));
+      return std::make_shared<Not>(std::move(child));
+    }
+    case Expression::Operation::kAnd:
+    case Expression::Operation::kOr: {
+      ICEBERG_ASSIGN_OR_RAISE(auto left, ReadExpression(reader, schema));
+      ICEBERG_ASSIGN_OR_RAISE(auto right, ReadExpression(reader, schema));
+      if (op == Expression::Operation::kAnd) {
+        return std::make_shared<And>(std::move(left), std::move(right));
+      }
+      return std::make_shared<Or>(std::move(left), std::move(right));
+    }
+    default:
+      break;
+  }
+
+  ICEBERG_ASSIGN_OR_RAISE(auto form, reader.Byte());
+  ICEBERG_ASSIGN_OR_RAISE(auto kind_value, reader.Byte());
+  const auto kind = static_cast<Term::Kind>(kind_value);
+  if (kind != Term::Kind::kReference && kind != Term::Kind::kTransform) {
+    return Invalid("Invalid term kind {} in serialized data", kind_value);
+  }
+  switch (form) {
+    case kUnboundPredicate:
+      return ReadUnboundPredicate(reader, op, kind);
+    case kBoundPredicate:
+      if (schema == nullptr) {
+        return InvalidArgument("Cannot deserialize a bound predicate without a schema");
+      }
+      return ReadBoundPredicate(reader, op, kind, *schema);
+    default:
+      return Invalid("Invalid predicate form {} in serialized data", form);
+  }
+}
+
+}  // namespace
+
+Result<std::vector<uint8_t>> SerializeExpression(const Expression& expr) {
+  BinaryWriter writer;
+  writer.Byte(kFormatVersion);
+  ICEBERG_RETURN_UNEXPECTED(WriteExpression(writer, expr));
+  return std::move(writer).Finish();
+}
+
+Result<std::shared_ptr<Expression>> DeserializeExpression(std::span<const uint8_t> data,
+                                                          const Schema* schema) {
+  BinaryReader reader(data);
+  ICEBERG_ASSIGN_OR_RAISE(auto version, reader.Byte());
+  if (version != kFormatVersion) {
+    return NotSupported("Unsupported expression format version {}", version);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto expr, ReadExpression(reader, schema));
+  if (!reader.AtEnd()) {
+    return Invalid("Unexpected data at the end of the serialized expression");
+  }
+  return expr;
+}
+
+}  // namespace iceberg
@@ -0,0 +1,56 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/expression/expression_serialization.h
+/// A compact binary form of expressions, to send filters to other processes.
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief Serializes an expression in a versioned binary form.
+///
+/// Unbound predicates are written with the names of their fields and their typed
+/// literals. Bound predicates are written with the IDs of their fields, and their
+/// values in the single-value binary serialization of the type of their term. Aggregate
+/// expressions are not supported.
+/// \param expr The expression to serialize.
+/// \return A Result containing the serialized expression or an error.
+ICEBERG_EXPORT Result<std::vector<uint8_t>> SerializeExpression(const Expression& expr);
+
+/// \brief Restores an expression written by SerializeExpression.
+///
+/// \param data The serialized expression.
+/// \param schema The schema that the bound predicates of the expression are bound to,
+/// or null if the expression has no bound predicates.
+/// \return A Result containing the expression or an error if the data is not a valid
+/// expression.
+ICEBERG_EXPORT Result<std::shared_ptr<Expression>> DeserializeExpression(
+    std::span<const uint8_t> data, const Schema* schema = nullptr);
+
+}  // namespace iceberg
@@ -0,0 +1,213 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/expression/expression_visitor.h
+/// Visitors that traverse expression trees bottom-up.
+
+#include <memory>
+#include <vector>
+
+#include "iceberg/expression/expression.h"
+#include "iceberg/expression/literal.h"
+#include "iceberg/expression/predicate.h"
+#include "iceberg/expression/term.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+/// \brief Base visitor for traversing expression trees.
+///
+/// Child results are computed first and passed to the parent callbacks, so a visitor
+/// only needs to combine the results of its operands.
+///
+/// \tparam R The result type produced by the visitor
+template <typename R>
+class ICEBERG_EXPORT ExpressionVisitor {
+ public:
+  virtual ~ExpressionVisitor() = default;
+
+  /// \brief Visit a True expression.
+  virtual Result<R> AlwaysTrue() = 0;
+
+  /// \brief Visit a False expression.
+  virtual Result<R> AlwaysFalse() = 0;
+
+  /// \brief Visit a Not expression with the result of its child.
+  virtual Result<R> Not(R child_result) = 0;
+
+  /// \brief Visit an And expression with the results of its operands.
+  virtual Result<R> And(R left_result, R right_result) = 0;
+
+  /// \brief Visit an Or expression with the results of its operands.
+  virtual Result<R> Or(R left_result, R right_result) = 0;
+
+  /// \brief Visit a bound predicate.
+  virtual Result<R> Predicate(const std::shared_ptr<BoundPredicate>& pred) = 0;
+
+  /// \brief Visit an unbound predicate.
+  virtual Result<R> Predicate(const std::shared_ptr<Unbound<Expression>>& pred) = 0;
+};
+
+/// \brief Visitor for bound expressions that dispatches on the predicate operation.
+///
+/// \tparam R The result type produced by the visitor
+template <typename R>
+class ICEBERG_EXPORT BoundVisitor : public ExpressionVisitor<R> {
+ public:
+  virtual Result<R> IsNull(const std::shared_ptr<BoundTerm>& term) = 0;
+  virtual Result<R> NotNull(const std::shared_ptr<BoundTerm>& term) = 0;
+  virtual Result<R> IsNaN(const std::shared_ptr<BoundTerm>& term) = 0;
+  virtual Result<R> NotNaN(const std::shared_ptr<BoundTerm>& term) = 0;
+  virtual Result<R> Lt(const std::shared_ptr<BoundTerm>& term, const Literal& lit) = 0;
+  virtual Result<R> LtEq(const std::shared_ptr<BoundTerm>& term, const Literal& lit) = 0;
+  virtual Result<R> Gt(const std::shared_ptr<BoundTerm>& term, const Literal& lit) = 0;
+  virtual Result<R> GtEq(const std::shared_ptr<BoundTerm>& term, const Literal& lit) = 0;
+  virtual Result<R> Eq(const std::shared_ptr<BoundTerm>& term, const Literal& lit) = 0;
+  virtual Result<R> NotEq(const std::shared_ptr<BoundTerm>& term, const Literal& lit) = 0;
+  virtual Result<R> In(const std::shared_ptr<BoundTerm>& term,
+                       const BoundSetPredicate::LiteralSet& literal_set) = 0;
+  virtual Result<R> NotIn(const std::shared_ptr<BoundTerm>& term,
+                          const BoundSetPredicate::LiteralSet& literal_set) = 0;
+
+  virtual Result<R> StartsWith(const std::shared_ptr<BoundTerm>& term,
+                               const Literal& lit) {
+    return NotSupported("StartsWith is not supported by this visitor");
+  }
+
+  virtual Result<R> NotStartsWith(const std::shared_ptr<BoundTerm>& term,
+                                  const Literal& lit) {
+    return NotSupported("NotStartsWith is not supported by this visitor");
+  }
+
+  Result<R> Predicate(const std::shared_ptr<BoundPredicate>& pred) override {
+    const auto& term = pred->term();
+    switch (pred->kind()) {
+      case BoundPredicate::Kind::kUnary:
+        switch (pred->op()) {
+          case Expression::Operation::kIsNull:
+            return IsNull(term);
+          case Expression::Operation::kNotNull:
+            return NotNull(term);
+          case Expression::Operation::kIsNan:
+            return IsNaN(term);
+          case Expression::Operation::kNotNan:
+            return NotNaN(term);
+          default:
+            break;
+        }
+        break;
+      case BoundPredicate::Kind::kLiteral: {
+        const auto& lit =
+            internal::checked_cast<const BoundLiteralPredicate&>(*pred).literal();
+        switch (pred->op()) {
+          case Expression::Operation::kLt:
+            return Lt(term, lit);
+          case Expression::Operation::kLtEq:
+            return LtEq(term, lit);
+          case Expression::Operation::kGt:
+            return Gt(term, lit);
+          case Expression::Operation::kGtEq:
+            return GtEq(term, lit);
+          case Expression::Operation::kEq:
+            return Eq(term, lit);
+          case Expression::Operation::kNotEq:
+            return NotEq(term, lit);
+          case Expression::Operation::kStartsWith:
+            return StartsWith(term, lit);
+          case Expression::Operation::kNotStartsWith:
+            return NotStartsWith(term, lit);
+          default:
+            break;
+        }
+        break;
+      }
+      case BoundPredicate::Kind::kSet: {
+        const auto& literal_set =
+            internal::checked_cast<const BoundSetPredicate&>(*pred).literal_set();
+        switch (pred->op()) {
+          case Expression::Operation::kIn:
+            return In(term, literal_set);
+          case Expression::Operation::kNotIn:
+            return NotIn(term, literal_set);
+          default:
+            break;
+        }
+        break;
+      }
+    }
+    return InvalidExpression("Unsupported bound predicate: {}", pred->ToString());
+  }
+
+  Result<R> Predicate(const std::shared_ptr<Unbound<Expression>>& pred) override {
+    return InvalidExpression("Found unbound predicate while visiting bound expression");
+  }
+};
+
+/// \brief Traverse an expression tree with the given visitor.
+///
+/// \param expr The expression to traverse
+/// \param visitor The visitor to apply
+/// \return The result of the visitor for the root expression, or the first error raised
+template <typename R>
+Result<R> Visit(const std::shared_ptr<Expression>& expr, ExpressionVisitor<R>& visitor) {
+  if (expr == nullptr) {
+    return InvalidExpression("Cannot visit a null expression");
+  }
+
+  switch (expr->op()) {
+    case Expression::Operation::kTrue:
+      return visitor.AlwaysTrue();
+    case Expression::Operation::kFalse:
+      return visitor.AlwaysFalse();
+    case Expression::Operation::kNot: {
+      const auto& not_expr = internal::checked_cast<const ::iceberg::Not&>(*expr);
+      ICEBERG_ASSIGN_OR_RAISE(auto child_result, Visit(not_expr.child(), visitor));
+      return visitor.Not(std::move(child_result));
+    }
+    case Expression::Operation::kAnd: {
+      const auto& and_expr = internal::checked_cast<const ::iceberg::And&>(*expr);
+      ICEBERG_ASSIGN_OR_RAISE(auto left_result, Visit(and_expr.left(), visitor));
+      ICEBERG_ASSIGN_OR_RAISE(auto right_result, Visit(and_expr.right(), visitor));
+      return visitor.And(std::move(left_result), std::move(right_result));
+    }
+    case Expression::Operation::kOr: {
+      const auto& or_expr = internal::checked_cast<const ::iceberg::Or&>(*expr);
+      ICEBERG_ASSIGN_OR_RAISE(auto left_result, Visit(or_expr.left(), visitor));
+      ICEBERG_ASSIGN_OR_RAISE(auto right_result, Visit(or_expr.right(), visitor));
+      return visitor.Or(std::move(left_result), std::move(right_result));
+    }
+    default:
+      break;
+  }
+
+  if (auto bound_pred = std::dynamic_pointer_cast<BoundPredicate>(expr)) {
+    return visitor.Predicate(bound_pred);
+  }
+  if (auto unbound_pred = std::dynamic_pointer_cast<Unbound<Expression>>(expr)) {
+    return visitor.Predicate(unbound_pred);
+  }
+  return NotSupported("Cannot visit expression: {}", expr->ToString());
+}
+
+}  // namespace iceberg
@@ -331,7 +331,7 @@ std::shared_ptr<NamedReference> Expressions::Ref(std::string name) {
 }
 
 Literal Expressions::Lit(Literal::Value value, std::shared_ptr<PrimitiveType> type) {
-  throw IcebergError("Literal creation is not implemented");
+  return {std::move(value), std::move(type)};
 }
 
 }  // namespace iceberg
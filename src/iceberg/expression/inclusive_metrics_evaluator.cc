@@ -0,0 +1,396 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/expression/inclusive_metrics_evaluator.h"
+
+#include <cmath>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include "iceberg/expression/binder.h"
+#include "iceberg/expression/expression_visitor.h"
+#include "iceberg/expression/rewrite_not.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/schema.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/conversions.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+// Large IN lists are not worth comparing value by value against the bounds.
+constexpr size_t kInPredicateLimit = 200;
+
+constexpr bool kRowsMightMatch = true;
+constexpr bool kRowsCannotMatch = false;
+
+bool IsNaN(const Scalar& scalar) {
+  if (const auto* value = std::get_if<float>(&scalar)) {
+    return std::isnan(*value);
+  }
+  if (const auto* value = std::get_if<double>(&scalar)) {
+    return std::isnan(*value);
+  }
+  return false;
+}
+
+class MetricsEvalVisitor : public BoundVisitor<bool> {
+ public:
+  explicit MetricsEvalVisitor(const DataFile& data_file) : data_file_(data_file) {}
+
+  Result<bool> AlwaysTrue() override { return kRowsMightMatch; }
+
+  Result<bool> AlwaysFalse() override { return kRowsCannotMatch; }
+
+  Result<bool> Not(bool child_result) override {
+    return InvalidExpression("Cannot evaluate not expression, rewrite it first");
+  }
+
+  Result<bool> And(bool left_result, bool right_result) override {
+    return left_result && right_result;
+  }
+
+  Result<bool> Or(bool left_result, bool right_result) override {
+    return left_result || right_result;
+  }
+
+  Result<bool> IsNull(const std::shared_ptr<BoundTerm>& term) override {
+    auto field_id = FieldId(term);
+    if (!field_id.has_value()) {
+      return kRowsMightMatch;
+    }
+    auto null_count = Count(data_file_.null_value_counts, *field_id);
+    if (null_count.has_value() && *null_count == 0) {
+      return kRowsCannotMatch;
+    }
+    return kRowsMightMatch;
+  }
+
+  Result<bool> NotNull(const std::shared_ptr<BoundTerm>& term) override {
+    auto field_id = FieldId(term);
+    if (field_id.has_value() && ContainsNullsOnly(*field_id)) {
+      return kRowsCannotMatch;
+    }
+    return kRowsMightMatch;
+  }
+
+  Result<bool> IsNaN(const std::shared_ptr<BoundTerm>& term) override {
+    auto field_id = FieldId(term);
+    if (!field_id.has_value()) {
+      return kRowsMightMatch;
+    }
+    auto nan_count = Count(data_file_.nan_value_counts, *field_id);
+    if (nan_count.has_value() && *nan_count == 0) {
+      return kRowsCannotMatch;
+    }
+    if (ContainsNullsOnly(*field_id)) {
+      return kRowsCannotMatch;
+    }
+    return kRowsMightMatch;
+  }
+
+  Result<bool> NotNaN(const std::shared_ptr<BoundTerm>& term) override {
+    auto field_id = FieldId(term);
+    if (field_id.has_value() && ContainsNaNsOnly(*field_id)) {
+      return kRowsCannotMatch;
+    }
+    return kRowsMightMatch;
+  }
+
+  Result<bool> Lt(const std::shared_ptr<BoundTerm>& term, const Literal& lit) override {
+    auto field_id = FieldId(term);
+    if (!field_id.has_value()) {
+      return kRowsMightMatch;
+    }
+    if (ContainsNullsOnly(*field_id) || ContainsNaNsOnly(*field_id)) {
+      return kRowsCannotMatch;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto lower, LowerBound(term, *field_id));
+    if (lower.has_value() && lit.Compare(*lower) <= 0) {
+      return kRowsCannotMatch;
+    }
+    return kRowsMightMatch;
+  }
+
+  Result<bool> LtEq(const std::shared_ptr<BoundTerm>& term, const Literal& lit) override {
+    auto field_id = FieldId(term);
+    if (!field_id.has_value()) {
+      return kRowsMightMatch;
+    }
+    if (ContainsNullsOnly(*field_id) || ContainsNaNsOnly(*field_id)) {
+      return kRowsCannotMatch;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto lower, LowerBound(term, *field_id));
+    if (lower.has_value() && lit.Compare(*lower) < 0) {
+      return kRowsCannotMatch;
+    }
+    return kRowsMightMatch;
+  }
+
+  Result<bool> Gt(const std::shared_ptr<BoundTerm>& term, const Literal& lit) override {
+    auto field_id = FieldId(term);
+    if (!field_id.has_value()) {
+      return kRowsMightMatch;
+    }
+    if (ContainsNullsOnly(*field_id) || ContainsNaNsOnly(*field_id)) {
+      return kRowsCannotMatch;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto upper, UpperBound(term, *field_id));
+    if (upper.has_value() && lit.Compare(*upper) >= 0) {
+      return kRowsCannotMatch;
+    }
+    return kRowsMightMatch;
+  }
+
+  Result<bool> GtEq(const std::shared_ptr<BoundTerm>& term, const Literal& lit) override {
+    auto field_id = FieldId(term);
+    if (!field_id.has_value()) {
+      return kRowsMightMatch;
+    }
+    if (ContainsNullsOnly(*field_id) || ContainsNaNsOnly(*field_id)) {
+      return kRowsCannotMatch;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto upper, UpperBound(term, *field_id));
+    if (upper.has_value() && lit.Compare(*upper) > 0) {
+      return kRowsCannotMatch;
+    }
+    return kRowsMightMatch;
+  }
+
+  Result<bool> Eq(const std::shared_ptr<BoundTerm>& term, const Literal& lit) override {
+    auto field_id = FieldId(term);
+    if (!field_id.has_value()) {
+      return kRowsMightMatch;
+    }
+    if (ContainsNullsOnly(*field_id) || ContainsNaNsOnly(*field_id)) {
+      return kRowsCannotMatch;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto lower, LowerBound(term, *field_id));
+    if (lower.has_value() && lit.Compare(*lower) < 0) {
+      return kRowsCannotMatch;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto upper, UpperBound(term, *field_id));
+    if (upper.has_value() && lit.Compare(*upper) > 0) {
+      return kRowsCannotMatch;
+    }
+    return kRowsMightMatch;
+  }
+
+  Result<bool> NotEq(const std::shared_ptr<BoundTerm>& term,
+                     const Literal& lit) override {
+    // Bounds do not tell whether every value equals the literal.
+    return kRowsMightMatch;
+  }
+
+  Result<bool> In(const std::shared_ptr<BoundTerm>& term,
+                  const BoundSetPredicate::LiteralSet& literal_set) override {
+    auto field_id = FieldId(term);
+    if (!field_id.has_value()) {
+      return kRowsMightMatch;
+    }
+    if (ContainsNullsOnly(*field_id) || ContainsNaNsOnly(*field_id)) {
+      return kRowsCannotMatch;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto lower, LowerBound(term, *field_id));
+    ICEBERG_ASSIGN_OR_RAISE(auto upper, UpperBound(term, *field_id));
+    if (!lower.has_value() && !upper.has_value()) {
+      return kRowsMightMatch;
+    }
+
+    // The smallest and largest values of the set prune files of any set size.
+    if (const auto* min = literal_set.min();
+        min != nullptr && upper.has_value() && Literal::Compare(*min, *upper) > 0) {
+      return kRowsCannotMatch;
+    }
+    if (const auto* max = literal_set.max();
+        max != nullptr && lower.has_value() && Literal::Compare(*max, *lower) < 0) {
+      return kRowsCannotMatch;
+    }
+    if (literal_set.size() > kInPredicateLimit) {
+      return kRowsMightMatch;
+    }
+    for (const auto& value : literal_set) {
+      if ((!lower.has_value() || !(Literal::Compare(value, *lower) < 0)) &&
+          (!upper.has_value() || !(Literal::Compare(value, *upper) > 0))) {
+        return kRowsMightMatch;
+      }
+    }
+    return kRowsCannotMatch;
+  }
+
+  Result<bool> NotIn(const std::shared_ptr<BoundTerm>& term,
+                     const BoundSetPredicate::LiteralSet& literal_set) override {
+    return kRowsMightMatch;
+  }
+
+  Result<bool> StartsWith(const std::shared_ptr<BoundTerm>& term,
+                          const Literal& lit) override {
+    auto field_id = FieldId(term);
+    const auto* prefix = std::get_if<std::string>(&lit.value());
+    if (!field_id.has_value() || prefix == nullptr) {
+      return kRowsMightMatch;
+    }
+    if (ContainsNullsOnly(*field_id)) {
+      return kRowsCannotMatch;
+    }
+
+    // Truncate the bounds to the prefix length so that a bound that starts with the
+    // prefix compares as equal.
+    ICEBERG_ASSIGN_OR_RAISE(auto lower, LowerBound(term, *field_id));
+    if (lower.has_value()) {
+      const auto lower_str = std::get<std::string_view>(*lower);
+      if (lower_str.compare(0, prefix->size(), *prefix) > 0) {
+        return kRowsCannotMatch;
+      }
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto upper, UpperBound(term, *field_id));
+    if (upper.has_value()) {
+      const auto upper_str = std::get<std::string_view>(*upper);
+      if (upper_str.compare(0, prefix->size(), *prefix) < 0) {
+        return kRowsCannotMatch;
+      }
+    }
+    return kRowsMightMatch;
+  }
+
+  Result<bool> NotStartsWith(const std::shared_ptr<BoundTerm>& term,
+                             const Literal& lit) override {
+    auto field_id = FieldId(term);
+    const auto* prefix = std::get_if<std::string>(&lit.value());
+    if (!field_id.has_value() || prefix == nullptr || MayContainNull(*field_id)) {
+      return kRowsMightMatch;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto lower, LowerBound(term, *field_id));
+    ICEBERG_ASSIGN_OR_RAISE(auto upper, UpperBound(term, *field_id));
+    if (!lower.has_value() || !upper.has_value()) {
+      return kRowsMightMatch;
+    }
+    // If both bounds start with the prefix, so does every value between them.
+    const auto lower_str = std::get<std::string_view>(*lower);
+    const auto upper_str = std::get<std::string_view>(*upper);
+    if (lower_str.starts_with(*prefix) && upper_str.starts_with(*prefix)) {
+      return kRowsCannotMatch;
+    }
+    return kRowsMightMatch;
+  }
+
+ private:
+  /// \brief Returns the id of the column referenced by the term, or nullopt if the
+  /// term is not a plain column reference, e.g. a transform, in which case the column
+  /// metrics do not apply to the values of the term.
+  static std::optional<int32_t> FieldId(const std::shared_ptr<BoundTerm>& term) {
+    if (term->kind() != Term::Kind::kReference) {
+      return std::nullopt;
+    }
+    return term->reference()->field().field_id();
+  }
+
+  static std::optional<int64_t> Count(const std::map<int32_t, int64_t>& counts,
+                                      int32_t field_id) {
+    auto it = counts.find(field_id);
+    if (it == counts.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  bool ContainsNullsOnly(int32_t field_id) const {
+    auto value_count = Count(data_file_.value_counts, field_id);
+    auto null_count = Count(data_file_.null_value_counts, field_id);
+    return value_count.has_value() && null_count.has_value() &&
+           *value_count == *null_count;
+  }
+
+  bool ContainsNaNsOnly(int32_t field_id) const {
+    auto value_count = Count(data_file_.value_counts, field_id);
+    auto nan_count = Count(data_file_.nan_value_counts, field_id);
+    return value_count.has_value() && nan_count.has_value() &&
+           *value_count == *nan_count;
+  }
+
+  bool MayContainNull(int32_t field_id) const {
+    auto null_count = Count(data_file_.null_value_counts, field_id);
+    return !null_count.has_value() || *null_count != 0;
+  }
+
+  /// \brief Returns a bound of a column as a view of the serialized bound.
+  Result<std::optional<Scalar>> Bound(
+      const std::shared_ptr<BoundTerm>& term, int32_t field_id,
+      const std::map<int32_t, std::vector<uint8_t>>& bounds) const {
+    auto it = bounds.find(field_id);
+    if (it == bounds.end()) {
+      return std::nullopt;
+    }
+    const auto& type = internal::checked_cast<const PrimitiveType&>(*term->type());
+    ICEBERG_ASSIGN_OR_RAISE(auto bound, Conversions::ScalarFromBytes(type, it->second));
+    // Older writers may produce NaN bounds for floating point columns, which do not
+    // bound anything.
+    if (iceberg::IsNaN(bound)) {
+      return std::nullopt;
+    }
+    return bound;
+  }
+
+  Result<std::optional<Scalar>> LowerBound(const std::shared_ptr<BoundTerm>& term,
+                                           int32_t field_id) const {
+    return Bound(term, field_id, data_file_.lower_bounds);
+  }
+
+  Result<std::optional<Scalar>> UpperBound(const std::shared_ptr<BoundTerm>& term,
+                                           int32_t field_id) const {
+    return Bound(term, field_id, data_file_.upper_bounds);
+  }
+
+  const DataFile& data_file_;
+};
+
+}  // namespace
+
+InclusiveMetricsEvaluator::InclusiveMetricsEvaluator(std::shared_ptr<Expression> expr)
+    : expr_(std::move(expr)) {}
+
+InclusiveMetricsEvaluator::~InclusiveMetricsEvaluator() = default;
+
+Result<std::unique_ptr<InclusiveMetricsEvaluator>> InclusiveMetricsEvaluator::Make(
+    const std::shared_ptr<Expression>& expr, const Schema& schema, bool case_sensitive) {
+  ICEBERG_ASSIGN_OR_RAISE(auto rewritten, RewriteNot::Rewrite(expr));
+  ICEBERG_ASSIGN_OR_RAISE(auto is_bound, Binder::IsBound(rewritten));
+  if (!is_bound) {
+    ICEBERG_ASSIGN_OR_RAISE(rewritten, Binder::Bind(schema, rewritten, case_sensitive));
+  }
+  return std::unique_ptr<InclusiveMetricsEvaluator>(
+      new InclusiveMetricsEvaluator(std::move(rewritten)));
+}
+
+Result<bool> InclusiveMetricsEvaluator::Evaluate(const DataFile& data_file) const {
+  // Files without rows cannot match, and a negative count means the count is unknown.
+  if (data_file.record_count == 0) {
+    return kRowsCannotMatch;
+  }
+  MetricsEvalVisitor visitor(data_file);
+  return Visit<bool>(expr_, visitor);
+}
+
+}  // namespace iceberg
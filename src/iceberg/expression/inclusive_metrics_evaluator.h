@@ -0,0 +1,65 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/expression/inclusive_metrics_evaluator.h
+/// Evaluate filters against the column metrics of data files.
+
+#include <memory>
+
+#include "iceberg/expression/expression.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief Evaluates an expression on the column metrics of a data file.
+///
+/// The evaluation is inclusive: `false` means that the file cannot contain rows that
+/// match the expression, so it can be skipped without reading it, while `true` means
+/// that some rows might match. Metrics that are missing from the file never cause a
+/// file to be skipped.
+class ICEBERG_EXPORT InclusiveMetricsEvaluator {
+ public:
+  ~InclusiveMetricsEvaluator();
+
+  /// \brief Creates an evaluator for a filter on table rows.
+  ///
+  /// \param expr A bound or unbound expression on the table schema
+  /// \param schema The table schema to bind the expression to
+  /// \param case_sensitive Whether field name matching should be case sensitive
+  static Result<std::unique_ptr<InclusiveMetricsEvaluator>> Make(
+      const std::shared_ptr<Expression>& expr, const Schema& schema,
+      bool case_sensitive = true);
+
+  /// \brief Test whether a data file may contain rows that match the filter.
+  ///
+  /// \param data_file The data file whose column metrics are evaluated
+  /// \return false if the file cannot contain matching rows, true otherwise
+  Result<bool> Evaluate(const DataFile& data_file) const;
+
+ private:
+  explicit InclusiveMetricsEvaluator(std::shared_ptr<Expression> expr);
+
+  std::shared_ptr<Expression> expr_;
+};
+
+}  // namespace iceberg
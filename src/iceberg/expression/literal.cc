@@ -23,6 +23,9 @@
 #include <concepts>
 #include <cstdint>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
 
 #include "iceberg/util/checked_cast.h"
 #include "iceberg/util/conversions.h"
@@ -434,6 +437,46 @@ std::partial_ordering Literal::operator<=>(const Literal& other) const {
   }
 }
 
+std::partial_ordering Literal::Compare(const Value& value, const Scalar& other) {
+  return std::visit(
+      [&other](const auto& lhs) -> std::partial_ordering {
+        using T = std::decay_t<decltype(lhs)>;
+        if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, int32_t> ||
+                      std::is_same_v<T, int64_t> ||
+                      std::is_same_v<T, ::iceberg::Decimal>) {
+          if (const auto* rhs = std::get_if<T>(&other)) {
+            return lhs <=> *rhs;
+          }
+        } else if constexpr (std::is_floating_point_v<T>) {
+          if (const auto* rhs = std::get_if<T>(&other)) {
+            return CompareFloat(lhs, *rhs);
+          }
+        } else if constexpr (std::is_same_v<T, std::string>) {
+          if (const auto* rhs = std::get_if<std::string_view>(&other)) {
+            return std::string_view(lhs) <=> *rhs;
+          }
+        } else if constexpr (std::is_same_v<T, std::vector<uint8_t>>) {
+          if (const auto* rhs = std::get_if<std::string_view>(&other)) {
+            // Compare as unsigned bytes, like std::string_view and std::vector do.
+            const std::string_view lhs_view(reinterpret_cast<const char*>(lhs.data()),
+                                            lhs.size());
+            return lhs_view <=> *rhs;
+          }
+        } else if constexpr (std::is_same_v<T, Uuid>) {
+          if (const auto* rhs = std::get_if<std::string_view>(&other)) {
+            const auto bytes = lhs.bytes();
+            // UUIDs are only compared for equality, like UUID literals.
+            if (std::string_view(reinterpret_cast<const char*>(bytes.data()),
+                                 bytes.size()) == *rhs) {
+              return std::partial_ordering::equivalent;
+            }
+          }
+        }
+        return std::partial_ordering::unordered;
+      },
+      value);
+}
+
 std::string Literal::ToString() const {
   if (std::holds_alternative<BelowMin>(value_)) {
     return "belowMin";
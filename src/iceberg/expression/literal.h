@@ -27,6 +27,7 @@
 
 #include "iceberg/iceberg_export.h"
 #include "iceberg/result.h"
+#include "iceberg/row/struct_like.h"
 #include "iceberg/type.h"
 #include "iceberg/util/decimal.h"
 #include "iceberg/util/formattable.h"
@@ -138,6 +139,21 @@ class ICEBERG_EXPORT Literal : public util::Formattable {
   /// AboveMax, BelowMin or Null.
   std::partial_ordering operator<=>(const Literal& other) const;
 
+  /// \brief Compare this literal with a scalar of the same primitive type.
+  ///
+  /// String, binary, fixed and UUID scalars are views, e.g. of serialized bounds, so
+  /// the comparison does not copy them like a comparison between literals would.
+  /// \return The comparison result, unordered if either side is AboveMax, BelowMin or
+  /// Null, or if the scalar does not hold a value of this literal's type.
+  std::partial_ordering Compare(const Scalar& other) const {
+    return Compare(value_, other);
+  }
+
+  /// \brief Compare a literal value with a scalar of the same primitive type.
+  ///
+  /// Decimal values are compared unscaled, so both sides must have the same scale.
+  static std::partial_ordering Compare(const Value& value, const Scalar& other);
+
   /// Check if this literal represents a value above the maximum allowed value
   /// for its type. This occurs when casting from a wider type to a narrower type
   /// and the value exceeds the target type's maximum.
@@ -160,6 +176,7 @@ class ICEBERG_EXPORT Literal : public util::Formattable {
   Literal(Value value, std::shared_ptr<PrimitiveType> type);
 
   friend class Conversions;
+  friend class Expressions;
   friend class LiteralCaster;
 
   Value value_;
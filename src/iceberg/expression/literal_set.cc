@@ -0,0 +1,415 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/expression/literal_set.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <compare>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+// Sets from this size on are guarded by a bloom filter, which is much smaller than
+// the hash table and therefore rejects most absent keys from the CPU caches.
+constexpr size_t kBloomFilterMinSize = 1024;
+
+/// \brief The finalizer of MurmurHash3, which spreads every input bit.
+uint64_t Mix(uint64_t value) {
+  value ^= value >> 33;
+  value *= 0xff51afd7ed558ccdULL;
+  value ^= value >> 33;
+  value *= 0xc4ceb9fe1a85ec53ULL;
+  value ^= value >> 33;
+  return value;
+}
+
+uint64_t HashKey(int64_t key) { return Mix(static_cast<uint64_t>(key)); }
+
+uint64_t HashKey(std::string_view key) {
+  return Mix(std::hash<std::string_view>{}(key));
+}
+
+/// \brief Returns the number of slots of a table that holds `size` keys at a load
+/// factor of at most one half.
+size_t TableCapacity(size_t size) { return std::bit_ceil(std::max<size_t>(size * 2, 8)); }
+
+/// \brief A bloom filter that sets two bits per key, taken from the halves of the hash.
+class BloomFilter {
+ public:
+  explicit BloomFilter(size_t size)
+      : words_(std::bit_ceil(std::max<size_t>(size * 8, 64)) / 64),
+        mask_(words_.size() * 64 - 1) {}
+
+  void Add(uint64_t hash) {
+    auto low = hash & mask_;
+    auto high = (hash >> 32) & mask_;
+    words_[low >> 6] |= uint64_t{1} << (low & 63);
+    words_[high >> 6] |= uint64_t{1} << (high & 63);
+  }
+
+  bool MightContain(uint64_t hash) const {
+    auto low = hash & mask_;
+    auto high = (hash >> 32) & mask_;
+    return ((words_[low >> 6] >> (low & 63)) & (words_[high >> 6] >> (high & 63)) & 1) !=
+           0;
+  }
+
+ private:
+  std::vector<uint64_t> words_;
+  uint64_t mask_;
+};
+
+/// \brief An open-addressing hash set of integers with linear probing.
+class IntegerTable {
+ public:
+  explicit IntegerTable(size_t size)
+      : slots_(TableCapacity(size), kEmpty), mask_(slots_.size() - 1) {}
+
+  void Insert(int64_t key, uint64_t hash) {
+    if (key == kEmpty) {
+      contains_empty_ = true;
+      return;
+    }
+    for (auto pos = hash & mask_;; pos = (pos + 1) & mask_) {
+      if (slots_[pos] == key) {
+        return;
+      }
+      if (slots_[pos] == kEmpty) {
+        slots_[pos] = key;
+        return;
+      }
+    }
+  }
+
+  bool Find(int64_t key, uint64_t hash) const {
+    if (key == kEmpty) {
+      return contains_empty_;
+    }
+    for (auto pos = hash & mask_;; pos = (pos + 1) & mask_) {
+      if (slots_[pos] == key) {
+        return true;
+      }
+      if (slots_[pos] == kEmpty) {
+        return false;
+      }
+    }
+  }
+
+ private:
+  // Marks free slots. The key itself is tracked by contains_empty_.
+  static constexpr int64_t kEmpty = std::numeric_limits<int64_t>::min();
+
+  std::vector<int64_t> slots_;
+  uint64_t mask_;
+  bool contains_empty_ = false;
+};
+
+/// \brief An open-addressing hash set of strings with linear probing, whose slots
+/// keep the hash of the key so that most mismatches skip the byte comparison.
+class BinaryTable {
+ public:
+  explicit BinaryTable(size_t size)
+      : slots_(TableCapacity(size)), mask_(slots_.size() - 1) {}
+
+  /// \brief Inserts a key, which must outlive the table.
+  void Insert(std::string_view key, uint64_t hash) {
+    for (auto pos = hash & mask_;; pos = (pos + 1) & mask_) {
+      auto& slot = slots_[pos];
+      if (!slot.used) {
+        slot = {.hash = hash, .key = key, .used = true};
+        return;
+      }
+      if (slot.hash == hash && slot.key == key) {
+        return;
+      }
+    }
+  }
+
+  bool Find(std::string_view key, uint64_t hash) const {
+    for (auto pos = hash & mask_;; pos = (pos + 1) & mask_) {
+      const auto& slot = slots_[pos];
+      if (!slot.used) {
+        return false;
+      }
+      if (slot.hash == hash && slot.key == key) {
+        return true;
+      }
+    }
+  }
+
+ private:
+  struct Slot {
+    uint64_t hash = 0;
+    std::string_view key;
+    bool used = false;
+  };
+
+  std::vector<Slot> slots_;
+  uint64_t mask_;
+};
+
+std::optional<std::string_view> BinaryKey(const Literal::Value& value) {
+  if (const auto* str = std::get_if<std::string>(&value)) {
+    return std::string_view(*str);
+  }
+  if (const auto* bytes = std::get_if<std::vector<uint8_t>>(&value)) {
+    return std::string_view(reinterpret_cast<const char*>(bytes->data()), bytes->size());
+  }
+  return std::nullopt;
+}
+
+std::optional<int64_t> IntegerKey(const Literal::Value& value) {
+  if (const auto* int_value = std::get_if<int32_t>(&value)) {
+    return *int_value;
+  }
+  if (const auto* long_value = std::get_if<int64_t>(&value)) {
+    return *long_value;
+  }
+  return std::nullopt;
+}
+
+/// \brief Compares two values of the same alternative in the order of Literal.
+///
+/// \return std::nullopt if the values are not ordered.
+std::optional<std::partial_ordering> CompareValues(const Literal::Value& lhs,
+                                                   const Literal::Value& rhs) {
+  return std::visit(
+      [&rhs](const auto& left) -> std::optional<std::partial_ordering> {
+        using T = std::decay_t<decltype(left)>;
+        const auto* right = std::get_if<T>(&rhs);
+        if (right == nullptr) {
+          return std::nullopt;
+        }
+        if constexpr (std::is_floating_point_v<T>) {
+          // Equal NaNs of the same sign, like Literal.
+          if (std::isnan(left) && std::isnan(*right) &&
+              std::signbit(left) == std::signbit(*right)) {
+            return std::partial_ordering::equivalent;
+          }
+          return std::strong_order(left, *right);
+        } else if constexpr (std::is_same_v<T, bool> || std::is_integral_v<T> ||
+                             std::is_same_v<T, std::string> ||
+                             std::is_same_v<T, std::vector<uint8_t>> ||
+                             std::is_same_v<T, Decimal>) {
+          return left <=> *right;
+        } else {
+          return std::nullopt;
+        }
+      },
+      lhs);
+}
+
+}  // namespace
+
+struct LiteralSet::State {
+  explicit State(std::vector<Literal::Value> set_values) : values(std::move(set_values)) {
+    if (values.empty()) {
+      return;
+    }
+    FindBounds();
+    if (IntegerKey(values.front()).has_value()) {
+      BuildIntegerIndex();
+    } else if (BinaryKey(values.front()).has_value()) {
+      BuildBinaryIndex();
+    }
+  }
+
+  void FindBounds() {
+    size_t min_pos = 0;
+    size_t max_pos = 0;
+    for (size_t pos = 1; pos < values.size(); ++pos) {
+      auto min_cmp = CompareValues(values[pos], values[min_pos]);
+      auto max_cmp = CompareValues(values[pos], values[max_pos]);
+      if (!min_cmp.has_value() || !max_cmp.has_value()) {
+        return;
+      }
+      if (*min_cmp < 0) {
+        min_pos = pos;
+      }
+      if (*max_cmp > 0) {
+        max_pos = pos;
+      }
+    }
+    if (CompareValues(values.front(), values.front()).has_value()) {
+      min = &values[min_pos];
+      max = &values[max_pos];
+    }
+  }
+
+  void BuildIntegerIndex() {
+    std::vector<int64_t> keys;
+    keys.reserve(values.size());
+    for (const auto& value : values) {
+      auto key = IntegerKey(value);
+      if (!key.has_value()) {
+        return;
+      }
+      keys.push_back(*key);
+    }
+    integers.emplace(keys.size());
+    if (keys.size() >= kBloomFilterMinSize) {
+      bloom_filter.emplace(keys.size());
+    }
+    for (auto key : keys) {
+      auto hash = HashKey(key);
+      integers->Insert(key, hash);
+      if (bloom_filter.has_value()) {
+        bloom_filter->Add(hash);
+      }
+    }
+    kind = IndexKind::kInteger;
+  }
+
+  void BuildBinaryIndex() {
+    std::vector<std::string_view> keys;
+    keys.reserve(values.size());
+    for (const auto& value : values) {
+      auto key = BinaryKey(value);
+      if (!key.has_value()) {
+        return;
+      }
+      keys.push_back(*key);
+    }
+    strings.emplace(keys.size());
+    if (keys.size() >= kBloomFilterMinSize) {
+      bloom_filter.emplace(keys.size());
+    }
+    for (auto key : keys) {
+      auto hash = HashKey(key);
+      strings->Insert(key, hash);
+      if (bloom_filter.has_value()) {
+        bloom_filter->Add(hash);
+      }
+    }
+    kind = IndexKind::kBinary;
+  }
+
+  template <typename Key, typename Table>
+  bool Find(const Table& table, Key key) const {
+    auto hash = HashKey(key);
+    if (bloom_filter.has_value() && !bloom_filter->MightContain(hash)) {
+      return false;
+    }
+    return table.Find(key, hash);
+  }
+
+  // The keys of `strings` point into these values, which are never modified.
+  const std::vector<Literal::Value> values;
+  IndexKind kind = IndexKind::kNone;
+  std::optional<IntegerTable> integers;
+  std::optional<BinaryTable> strings;
+  std::optional<BloomFilter> bloom_filter;
+  const Literal::Value* min = nullptr;
+  const Literal::Value* max = nullptr;
+};
+
+LiteralSet::LiteralSet() : LiteralSet(std::vector<Literal::Value>{}) {}
+
+LiteralSet::LiteralSet(std::vector<Literal::Value> values)
+    : state_(std::make_shared<const State>(std::move(values))) {}
+
+const std::vector<Literal::Value>& LiteralSet::values() const { return state_->values; }
+
+LiteralSet::IndexKind LiteralSet::index_kind() const { return state_->kind; }
+
+bool LiteralSet::Contains(const Literal::Value& value) const {
+  switch (state_->kind) {
+    case IndexKind::kInteger:
+      if (auto key = IntegerKey(value); key.has_value()) {
+        return ContainsKey(*key);
+      }
+      return false;
+    case IndexKind::kBinary:
+      if (auto key = BinaryKey(value); key.has_value()) {
+        return ContainsKey(*key);
+      }
+      return false;
+    case IndexKind::kNone:
+      break;
+  }
+  return std::ranges::any_of(state_->values, [&value](const Literal::Value& element) {
+    auto cmp = CompareValues(value, element);
+    if (cmp.has_value()) {
+      return *cmp == 0;
+    }
+    // Unordered values, such as UUIDs, are still compared for equality.
+    return !std::holds_alternative<std::monostate>(value) && value == element;
+  });
+}
+
+bool LiteralSet::ContainsKey(int64_t key) const {
+  ICEBERG_DCHECK(state_->kind == IndexKind::kInteger, "The set is not of integers");
+  return state_->Find(*state_->integers, key);
+}
+
+bool LiteralSet::ContainsKey(std::string_view key) const {
+  ICEBERG_DCHECK(state_->kind == IndexKind::kBinary, "The set is not of strings");
+  return state_->Find(*state_->strings, key);
+}
+
+void LiteralSet::ContainsKeys(std::span<const int64_t> keys,
+                              std::span<uint8_t> matches) const {
+  ICEBERG_DCHECK(state_->kind == IndexKind::kInteger, "The set is not of integers");
+  ICEBERG_DCHECK(keys.size() == matches.size(), "Keys and matches differ in size");
+  const auto& table = *state_->integers;
+  if (!state_->bloom_filter.has_value()) {
+    for (size_t i = 0; i < keys.size(); ++i) {
+      matches[i] = table.Find(keys[i], HashKey(keys[i]));
+    }
+    return;
+  }
+  // Filter the whole batch first, so that the table is only probed for the keys that
+  // pass, which are usually few.
+  const auto& bloom_filter = *state_->bloom_filter;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    matches[i] = bloom_filter.MightContain(HashKey(keys[i]));
+  }
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (matches[i]) {
+      matches[i] = table.Find(keys[i], HashKey(keys[i]));
+    }
+  }
+}
+
+void LiteralSet::ContainsKeys(std::span<const std::string_view> keys,
+                              std::span<uint8_t> matches) const {
+  ICEBERG_DCHECK(state_->kind == IndexKind::kBinary, "The set is not of strings");
+  ICEBERG_DCHECK(keys.size() == matches.size(), "Keys and matches differ in size");
+  for (size_t i = 0; i < keys.size(); ++i) {
+    matches[i] = state_->Find(*state_->strings, keys[i]);
+  }
+}
+
+const Literal::Value* LiteralSet::min() const { return state_->min; }
+
+const Literal::Value* LiteralSet::max() const { return state_->max; }
+
+}  // namespace iceberg
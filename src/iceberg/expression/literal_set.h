@@ -0,0 +1,129 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/expression/literal_set.h
+/// A set of literal values for membership tests of IN predicates.
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "iceberg/expression/literal.h"
+#include "iceberg/iceberg_export.h"
+
+namespace iceberg {
+
+/// \brief An immutable set of literal values of the same primitive type.
+///
+/// Integer values (int, long, date, time and timestamps) and string or binary values
+/// are indexed in a flat open-addressing hash table, guarded by a bloom filter for
+/// large sets, so that a membership test does not depend on the size of the set.
+/// Values of other types are tested by comparing them one by one.
+///
+/// Copies share the values and the index.
+class ICEBERG_EXPORT LiteralSet {
+ public:
+  using value_type = Literal::Value;
+  using const_iterator = std::vector<Literal::Value>::const_iterator;
+
+  /// \brief How the values of the set are indexed.
+  enum class IndexKind : uint8_t {
+    /// \brief Not indexed, membership is tested by comparing every value.
+    kNone,
+    /// \brief int32_t and int64_t values, probed with int64_t keys.
+    kInteger,
+    /// \brief std::string and binary values, probed with std::string_view keys.
+    kBinary,
+  };
+
+  LiteralSet();
+
+  /// \brief Create a set of values.
+  ///
+  /// \param values The values, which must all hold the same alternative. Duplicates
+  /// are kept in values() but do not affect membership tests.
+  explicit LiteralSet(std::vector<Literal::Value> values);
+
+  // Copies share the state, and are also used for moves so that a moved-from set
+  // remains valid.
+  LiteralSet(const LiteralSet&) = default;
+  LiteralSet& operator=(const LiteralSet&) = default;
+
+  const std::vector<Literal::Value>& values() const;
+
+  const_iterator begin() const { return values().begin(); }
+  const_iterator end() const { return values().end(); }
+  size_t size() const { return values().size(); }
+  bool empty() const { return values().empty(); }
+
+  /// \brief Returns how the values are indexed for the typed probes below.
+  IndexKind index_kind() const;
+
+  /// \brief Returns whether the set contains a value.
+  ///
+  /// Float and double values compare like Literal, so -0.0 and 0.0 are different and
+  /// NaN is equal to NaN of the same sign. Null never matches.
+  bool Contains(const Literal::Value& value) const;
+
+  /// \brief Returns whether the set contains an integer key.
+  ///
+  /// \pre index_kind() is IndexKind::kInteger
+  bool ContainsKey(int64_t key) const;
+
+  /// \brief Returns whether the set contains a string or binary key.
+  ///
+  /// \pre index_kind() is IndexKind::kBinary
+  bool ContainsKey(std::string_view key) const;
+
+  /// \brief Probes a batch of integer keys.
+  ///
+  /// \pre index_kind() is IndexKind::kInteger
+  /// \param keys The keys to probe
+  /// \param matches Set to 1 for each key in the set and 0 otherwise, must have the
+  /// size of `keys`
+  void ContainsKeys(std::span<const int64_t> keys, std::span<uint8_t> matches) const;
+
+  /// \brief Probes a batch of string or binary keys.
+  ///
+  /// \pre index_kind() is IndexKind::kBinary
+  /// \param keys The keys to probe
+  /// \param matches Set to 1 for each key in the set and 0 otherwise, must have the
+  /// size of `keys`
+  void ContainsKeys(std::span<const std::string_view> keys,
+                    std::span<uint8_t> matches) const;
+
+  /// \brief Returns the smallest value in the order of Literal, or nullptr if the set
+  /// is empty or its values are not ordered, such as UUIDs.
+  const Literal::Value* min() const;
+
+  /// \brief Returns the largest value in the order of Literal, or nullptr if the set
+  /// is empty or its values are not ordered, such as UUIDs.
+  const Literal::Value* max() const;
+
+ private:
+  struct State;
+
+  std::shared_ptr<const State> state_;
+};
+
+}  // namespace iceberg
@@ -0,0 +1,348 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/expression/manifest_evaluator.h"
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include "iceberg/expression/binder.h"
+#include "iceberg/expression/expression_visitor.h"
+#include "iceberg/expression/projections.h"
+#include "iceberg/expression/rewrite_not.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/conversions.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+// Large IN lists are not worth comparing value by value against the bounds.
+constexpr size_t kInPredicateLimit = 200;
+
+constexpr bool kRowsMightMatch = true;
+constexpr bool kRowsCannotMatch = false;
+
+class ManifestEvalVisitor : public BoundVisitor<bool> {
+ public:
+  ManifestEvalVisitor(const StructType& partition_type, const ManifestFile& manifest)
+      : partition_type_(partition_type), summaries_(manifest.partitions) {}
+
+  Result<bool> AlwaysTrue() override { return kRowsMightMatch; }
+
+  Result<bool> AlwaysFalse() override { return kRowsCannotMatch; }
+
+  Result<bool> Not(bool child_result) override {
+    return InvalidExpression("Cannot evaluate not expression, rewrite it first");
+  }
+
+  Result<bool> And(bool left_result, bool right_result) override {
+    return left_result && right_result;
+  }
+
+  Result<bool> Or(bool left_result, bool right_result) override {
+    return left_result || right_result;
+  }
+
+  Result<bool> IsNull(const std::shared_ptr<BoundTerm>& term) override {
+    ICEBERG_ASSIGN_OR_RAISE(auto summary, Summary(term));
+    // No file in the manifest has a null value for the partition field.
+    if (!summary->contains_null) {
+      return kRowsCannotMatch;
+    }
+    return kRowsMightMatch;
+  }
+
+  Result<bool> NotNull(const std::shared_ptr<BoundTerm>& term) override {
+    ICEBERG_ASSIGN_OR_RAISE(auto summary, Summary(term));
+    if (ContainsNullsOnly(*summary, term->type()->type_id())) {
+      return kRowsCannotMatch;
+    }
+    return kRowsMightMatch;
+  }
+
+  Result<bool> IsNaN(const std::shared_ptr<BoundTerm>& term) override {
+    ICEBERG_ASSIGN_OR_RAISE(auto summary, Summary(term));
+    if (summary->contains_nan.has_value() && !summary->contains_nan.value()) {
+      return kRowsCannotMatch;
+    }
+    return kRowsMightMatch;
+  }
+
+  Result<bool> NotNaN(const std::shared_ptr<BoundTerm>& term) override {
+    ICEBERG_ASSIGN_OR_RAISE(auto summary, Summary(term));
+    if (ContainsNaNsOnly(*summary)) {
+      return kRowsCannotMatch;
+    }
+    return kRowsMightMatch;
+  }
+
+  Result<bool> Lt(const std::shared_ptr<BoundTerm>& term, const Literal& lit) override {
+    ICEBERG_ASSIGN_OR_RAISE(auto lower, LowerBound(term));
+    if (!lower.has_value() || lit.Compare(*lower) <= 0) {
+      return kRowsCannotMatch;
+    }
+    return kRowsMightMatch;
+  }
+
+  Result<bool> LtEq(const std::shared_ptr<BoundTerm>& term, const Literal& lit) override {
+    ICEBERG_ASSIGN_OR_RAISE(auto lower, LowerBound(term));
+    if (!lower.has_value() || lit.Compare(*lower) < 0) {
+      return kRowsCannotMatch;
+    }
+    return kRowsMightMatch;
+  }
+
+  Result<bool> Gt(const std::shared_ptr<BoundTerm>& term, const Literal& lit) override {
+    ICEBERG_ASSIGN_OR_RAISE(auto upper, UpperBound(term));
+    if (!upper.has_value() || lit.Compare(*upper) >= 0) {
+      return kRowsCannotMatch;
+    }
+    return kRowsMightMatch;
+  }
+
+  Result<bool> GtEq(const std::shared_ptr<BoundTerm>& term, const Literal& lit) override {
+    ICEBERG_ASSIGN_OR_RAISE(auto upper, UpperBound(term));
+    if (!upper.has_value() || lit.Compare(*upper) > 0) {
+      return kRowsCannotMatch;
+    }
+    return kRowsMightMatch;
+  }
+
+  Result<bool> Eq(const std::shared_ptr<BoundTerm>& term, const Literal& lit) override {
+    ICEBERG_ASSIGN_OR_RAISE(auto lower, LowerBound(term));
+    if (!lower.has_value() || lit.Compare(*lower) < 0) {
+      return kRowsCannotMatch;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto upper, UpperBound(term));
+    if (!upper.has_value() || lit.Compare(*upper) > 0) {
+      return kRowsCannotMatch;
+    }
+    return kRowsMightMatch;
+  }
+
+  Result<bool> NotEq(const std::shared_ptr<BoundTerm>& term,
+                     const Literal& lit) override {
+    // Bounds do not tell whether every value equals the literal.
+    return kRowsMightMatch;
+  }
+
+  Result<bool> In(const std::shared_ptr<BoundTerm>& term,
+                  const BoundSetPredicate::LiteralSet& literal_set) override {
+    ICEBERG_ASSIGN_OR_RAISE(auto lower, LowerBound(term));
+    if (!lower.has_value()) {
+      return kRowsCannotMatch;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto upper, UpperBound(term));
+    if (!upper.has_value()) {
+      return kRowsCannotMatch;
+    }
+
+    // The smallest and largest values of the set prune manifests of any set size.
+    if (const auto* min = literal_set.min();
+        min != nullptr && Literal::Compare(*min, *upper) > 0) {
+      return kRowsCannotMatch;
+    }
+    if (const auto* max = literal_set.max();
+        max != nullptr && Literal::Compare(*max, *lower) < 0) {
+      return kRowsCannotMatch;
+    }
+    if (literal_set.size() > kInPredicateLimit) {
+      return kRowsMightMatch;
+    }
+    for (const auto& value : literal_set) {
+      if (!(Literal::Compare(value, *lower) < 0) &&
+          !(Literal::Compare(value, *upper) > 0)) {
+        return kRowsMightMatch;
+      }
+    }
+    return kRowsCannotMatch;
+  }
+
+  Result<bool> NotIn(const std::shared_ptr<BoundTerm>& term,
+                     const BoundSetPredicate::LiteralSet& literal_set) override {
+    return kRowsMightMatch;
+  }
+
+  Result<bool> StartsWith(const std::shared_ptr<BoundTerm>& term,
+                          const Literal& lit) override {
+    const auto* prefix = std::get_if<std::string>(&lit.value());
+    if (prefix == nullptr) {
+      return kRowsMightMatch;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto lower, LowerBound(term));
+    if (!lower.has_value()) {
+      return kRowsCannotMatch;
+    }
+    const auto lower_str = std::get<std::string_view>(*lower);
+    // Truncate the lower bound to the prefix length so that a lower bound that starts
+    // with the prefix compares as equal.
+    if (lower_str.compare(0, prefix->size(), *prefix) > 0) {
+      return kRowsCannotMatch;
+    }
+
+    ICEBERG_ASSIGN_OR_RAISE(auto upper, UpperBound(term));
+    if (!upper.has_value()) {
+      return kRowsCannotMatch;
+    }
+    const auto upper_str = std::get<std::string_view>(*upper);
+    if (upper_str.compare(0, prefix->size(), *prefix) < 0) {
+      return kRowsCannotMatch;
+    }
+    return kRowsMightMatch;
+  }
+
+  Result<bool> NotStartsWith(const std::shared_ptr<BoundTerm>& term,
+                             const Literal& lit) override {
+    const auto* prefix = std::get_if<std::string>(&lit.value());
+    if (prefix == nullptr) {
+      return kRowsMightMatch;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto summary, Summary(term));
+    if (summary->contains_null) {
+      return kRowsMightMatch;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto lower, LowerBound(term));
+    ICEBERG_ASSIGN_OR_RAISE(auto upper, UpperBound(term));
+    if (!lower.has_value() || !upper.has_value()) {
+      return kRowsMightMatch;
+    }
+    // If both bounds start with the prefix, so does every value between them.
+    const auto lower_str = std::get<std::string_view>(*lower);
+    const auto upper_str = std::get<std::string_view>(*upper);
+    if (lower_str.starts_with(*prefix) && upper_str.starts_with(*prefix)) {
+      return kRowsCannotMatch;
+    }
+    return kRowsMightMatch;
+  }
+
+ private:
+  Result<size_t> FieldIndex(const std::shared_ptr<BoundTerm>& term) const {
+    const int32_t field_id = term->reference()->field().field_id();
+    const auto fields = partition_type_.fields();
+    for (size_t i = 0; i < fields.size(); ++i) {
+      if (fields[i].field_id() == field_id) {
+        return i;
+      }
+    }
+    return InvalidExpression("Cannot find partition field with id {}", field_id);
+  }
+
+  Result<const PartitionFieldSummary*> Summary(const std::shared_ptr<BoundTerm>& term) {
+    ICEBERG_ASSIGN_OR_RAISE(auto index, FieldIndex(term));
+    if (index >= summaries_.size()) {
+      return InvalidManifestList(
+          "Manifest has {} partition field summaries, but partition field {} is at {}",
+          summaries_.size(), term->reference()->field().field_id(), index);
+    }
+    return &summaries_[index];
+  }
+
+  /// \brief Returns a bound of a partition field as a view of the serialized bound.
+  Result<std::optional<Scalar>> Bound(
+      const std::shared_ptr<BoundTerm>& term,
+      const std::optional<std::vector<uint8_t>> PartitionFieldSummary::* bound) {
+    ICEBERG_ASSIGN_OR_RAISE(auto summary, Summary(term));
+    const auto& bytes = summary->*bound;
+    if (!bytes.has_value()) {
+      return std::nullopt;
+    }
+    const auto& type = internal::checked_cast<const PrimitiveType&>(*term->type());
+    ICEBERG_ASSIGN_OR_RAISE(auto scalar, Conversions::ScalarFromBytes(type, *bytes));
+    return scalar;
+  }
+
+  Result<std::optional<Scalar>> LowerBound(const std::shared_ptr<BoundTerm>& term) {
+    return Bound(term, &PartitionFieldSummary::lower_bound);
+  }
+
+  Result<std::optional<Scalar>> UpperBound(const std::shared_ptr<BoundTerm>& term) {
+    return Bound(term, &PartitionFieldSummary::upper_bound);
+  }
+
+  static bool ContainsNullsOnly(const PartitionFieldSummary& summary, TypeId type_id) {
+    // The lower bound is absent if all partition values are null.
+    if (!summary.contains_null || summary.lower_bound.has_value()) {
+      return false;
+    }
+    // NaN values of floating point types are not in the bounds and are tracked
+    // separately.
+    if (type_id == TypeId::kFloat || type_id == TypeId::kDouble) {
+      return !summary.contains_nan.value_or(true);
+    }
+    return true;
+  }
+
+  static bool ContainsNaNsOnly(const PartitionFieldSummary& summary) {
+    return summary.contains_nan.value_or(false) && !summary.contains_null &&
+           !summary.lower_bound.has_value();
+  }
+
+  const StructType& partition_type_;
+  const std::vector<PartitionFieldSummary>& summaries_;
+};
+
+}  // namespace
+
+ManifestEvaluator::ManifestEvaluator(std::shared_ptr<Expression> expr,
+                                     std::shared_ptr<StructType> partition_type)
+    : expr_(std::move(expr)), partition_type_(std::move(partition_type)) {}
+
+ManifestEvaluator::~ManifestEvaluator() = default;
+
+Result<std::unique_ptr<ManifestEvaluator>> ManifestEvaluator::MakeRowFilter(
+    const std::shared_ptr<Expression>& expr, std::shared_ptr<PartitionSpec> spec,
+    bool case_sensitive) {
+  auto projection = Projections::Inclusive(spec, case_sensitive);
+  ICEBERG_ASSIGN_OR_RAISE(auto partition_filter, projection->Project(expr));
+  return MakePartitionFilter(partition_filter, std::move(spec), case_sensitive);
+}
+
+Result<std::unique_ptr<ManifestEvaluator>> ManifestEvaluator::MakePartitionFilter(
+    const std::shared_ptr<Expression>& expr, std::shared_ptr<PartitionSpec> spec,
+    bool case_sensitive) {
+  ICEBERG_ASSIGN_OR_RAISE(auto partition_schema, spec->PartitionSchema());
+  if (partition_schema == nullptr) {
+    partition_schema = std::make_shared<Schema>(std::vector<SchemaField>{});
+  }
+
+  ICEBERG_ASSIGN_OR_RAISE(auto rewritten, RewriteNot::Rewrite(expr));
+  ICEBERG_ASSIGN_OR_RAISE(auto bound,
+                          Binder::Bind(*partition_schema, rewritten, case_sensitive));
+  return std::unique_ptr<ManifestEvaluator>(
+      new ManifestEvaluator(std::move(bound), std::move(partition_schema)));
+}
+
+Result<bool> ManifestEvaluator::Evaluate(const ManifestFile& manifest) const {
+  if (manifest.partitions.empty()) {
+    // Manifests without summaries cannot be pruned.
+    return kRowsMightMatch;
+  }
+  ManifestEvalVisitor visitor(*partition_type_, manifest);
+  return Visit<bool>(expr_, visitor);
+}
+
+}  // namespace iceberg
@@ -0,0 +1,78 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/expression/manifest_evaluator.h
+/// Evaluate partition filters against manifest partition summaries.
+
+#include <memory>
+
+#include "iceberg/expression/expression.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief Evaluates an expression on a manifest's partition field summaries.
+///
+/// The evaluation is inclusive: `false` means that no data file tracked by the
+/// manifest can match the expression, so the manifest can be skipped without reading
+/// it, while `true` means that some rows might match.
+class ICEBERG_EXPORT ManifestEvaluator {
+ public:
+  ~ManifestEvaluator();
+
+  /// \brief Creates an evaluator for a filter on table rows.
+  ///
+  /// The filter is projected through the partition spec transforms before it is
+  /// evaluated against the partition summaries.
+  ///
+  /// \param expr A bound or unbound expression on the table schema
+  /// \param spec The partition spec of the manifests to evaluate
+  /// \param case_sensitive Whether field name matching should be case sensitive
+  static Result<std::unique_ptr<ManifestEvaluator>> MakeRowFilter(
+      const std::shared_ptr<Expression>& expr, std::shared_ptr<PartitionSpec> spec,
+      bool case_sensitive = true);
+
+  /// \brief Creates an evaluator for a filter on partition values.
+  ///
+  /// \param expr An unbound expression on the partition fields of the spec
+  /// \param spec The partition spec of the manifests to evaluate
+  /// \param case_sensitive Whether field name matching should be case sensitive
+  static Result<std::unique_ptr<ManifestEvaluator>> MakePartitionFilter(
+      const std::shared_ptr<Expression>& expr, std::shared_ptr<PartitionSpec> spec,
+      bool case_sensitive = true);
+
+  /// \brief Test whether the data files tracked by a manifest may match the filter.
+  ///
+  /// \param manifest The manifest whose partition summaries are evaluated
+  /// \return false if the manifest cannot contain matching rows, true otherwise
+  Result<bool> Evaluate(const ManifestFile& manifest) const;
+
+ private:
+  ManifestEvaluator(std::shared_ptr<Expression> expr,
+                    std::shared_ptr<StructType> partition_type);
+
+  std::shared_ptr<Expression> expr_;
+  std::shared_ptr<StructType> partition_type_;
+};
+
+}  // namespace iceberg
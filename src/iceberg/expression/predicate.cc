@@ -20,7 +20,12 @@
 #include "iceberg/expression/predicate.h"
 
 #include <algorithm>
+#include <cmath>
+#include <compare>
 #include <format>
+#include <string>
+#include <variant>
+#include <vector>
 
 #include "iceberg/exception.h"
 #include "iceberg/expression/expressions.h"
@@ -143,6 +148,28 @@ bool IsFloatingType(TypeId type) {
   return type == TypeId::kFloat || type == TypeId::kDouble;
 }
 
+/// \brief Removes duplicate literals of the same type.
+void DeduplicateLiterals(std::vector<Literal>& literals) {
+  if (literals.size() < 2) {
+    return;
+  }
+  if (literals.front().type()->type_id() == TypeId::kUuid) {
+    // UUID literals only compare for equality, so they are sorted by their bytes.
+    auto bytes = [](const Literal& literal) {
+      return std::get<Uuid>(literal.value()).bytes();
+    };
+    std::ranges::sort(literals, [&](const Literal& lhs, const Literal& rhs) {
+      return std::ranges::lexicographical_compare(bytes(lhs), bytes(rhs));
+    });
+    literals.erase(std::ranges::unique(literals).begin(), literals.end());
+    return;
+  }
+  std::ranges::stable_sort(literals, [](const Literal& lhs, const Literal& rhs) {
+    return (lhs <=> rhs) == std::partial_ordering::less;
+  });
+  literals.erase(std::ranges::unique(literals).begin(), literals.end());
+}
+
 }  // namespace
 
 template <typename B>
@@ -249,6 +276,8 @@ Result<std::shared_ptr<Expression>> UnboundPredicate<B>::BindInOperation(
     }
   }
 
+  DeduplicateLiterals(converted_literals);
+
   // If no valid literals remain after conversion and filtering
   if (converted_literals.empty()) {
     switch (BASE::op()) {
@@ -301,7 +330,31 @@ BoundUnaryPredicate::BoundUnaryPredicate(Expression::Operation op,
 BoundUnaryPredicate::~BoundUnaryPredicate() = default;
 
 Result<bool> BoundUnaryPredicate::Test(const Literal::Value& value) const {
-  return NotImplemented("BoundUnaryPredicate::Test not implemented");
+  const bool is_null = std::holds_alternative<std::monostate>(value);
+  bool is_nan = false;
+  if (const auto* f = std::get_if<float>(&value)) {
+    is_nan = std::isnan(*f);
+  } else if (const auto* d = std::get_if<double>(&value)) {
+    is_nan = std::isnan(*d);
+  }
+
+  switch (op()) {
+    case Expression::Operation::kIsNull:
+      return is_null;
+    case Expression::Operation::kNotNull:
+      return !is_null;
+    case Expression::Operation::kIsNan:
+      return is_nan;
+    case Expression::Operation::kNotNan:
+      return !is_nan;
+    default:
+      return InvalidExpression("Invalid operation for BoundUnaryPredicate: {}", op());
+  }
+}
+
+Result<std::shared_ptr<Expression>> BoundUnaryPredicate::Negate() const {
+  ICEBERG_ASSIGN_OR_RAISE(auto negated_op, ::iceberg::Negate(op()));
+  return std::make_shared<BoundUnaryPredicate>(negated_op, term());
 }
 
 bool BoundUnaryPredicate::Equals(const Expression& other) const {
@@ -332,7 +385,47 @@ BoundLiteralPredicate::BoundLiteralPredicate(Expression::Operation op,
 BoundLiteralPredicate::~BoundLiteralPredicate() = default;
 
 Result<bool> BoundLiteralPredicate::Test(const Literal::Value& value) const {
-  return NotImplemented("BoundLiteralPredicate::Test not implemented");
+  if (std::holds_alternative<std::monostate>(value)) {
+    // Null matches no comparison, so it only matches the negated operations.
+    return op() == Expression::Operation::kNotEq ||
+           op() == Expression::Operation::kNotStartsWith;
+  }
+
+  if (op() == Expression::Operation::kStartsWith ||
+      op() == Expression::Operation::kNotStartsWith) {
+    const auto* str = std::get_if<std::string>(&value);
+    const auto* prefix = std::get_if<std::string>(&literal_.value());
+    if (str == nullptr || prefix == nullptr) {
+      return InvalidExpression("StartsWith requires string values");
+    }
+    const bool starts_with = str->starts_with(*prefix);
+    return op() == Expression::Operation::kStartsWith ? starts_with : !starts_with;
+  }
+
+  const auto cmp = Expressions::Lit(value, literal_.type()) <=> literal_;
+  switch (op()) {
+    case Expression::Operation::kLt:
+      return cmp == std::partial_ordering::less;
+    case Expression::Operation::kLtEq:
+      return cmp == std::partial_ordering::less ||
+             cmp == std::partial_ordering::equivalent;
+    case Expression::Operation::kGt:
+      return cmp == std::partial_ordering::greater;
+    case Expression::Operation::kGtEq:
+      return cmp == std::partial_ordering::greater ||
+             cmp == std::partial_ordering::equivalent;
+    case Expression::Operation::kEq:
+      return cmp == std::partial_ordering::equivalent;
+    case Expression::Operation::kNotEq:
+      return cmp != std::partial_ordering::equivalent;
+    default:
+      return InvalidExpression("Invalid operation for BoundLiteralPredicate: {}", op());
+  }
+}
+
+Result<std::shared_ptr<Expression>> BoundLiteralPredicate::Negate() const {
+  ICEBERG_ASSIGN_OR_RAISE(auto negated_op, ::iceberg::Negate(op()));
+  return std::make_shared<BoundLiteralPredicate>(negated_op, term(), literal_);
 }
 
 bool BoundLiteralPredicate::Equals(const Expression& other) const {
@@ -371,17 +464,37 @@ BoundSetPredicate::BoundSetPredicate(Expression::Operation op,
                                      std::shared_ptr<BoundTerm> term,
                                      std::span<const Literal> literals)
     : BoundPredicate(op, std::move(term)) {
+  std::vector<Literal::Value> values;
+  values.reserve(literals.size());
   for (const auto& literal : literals) {
     ICEBERG_DCHECK((*literal.type() == *term_->type()),
                    "Literal type does not match term type");
-    value_set_.push_back(literal.value());
+    values.push_back(literal.value());
   }
+  value_set_ = LiteralSet(std::move(values));
 }
 
+BoundSetPredicate::BoundSetPredicate(Expression::Operation op,
+                                     std::shared_ptr<BoundTerm> term,
+                                     LiteralSet value_set)
+    : BoundPredicate(op, std::move(term)), value_set_(std::move(value_set)) {}
+
 BoundSetPredicate::~BoundSetPredicate() = default;
 
 Result<bool> BoundSetPredicate::Test(const Literal::Value& value) const {
-  return NotImplemented("BoundSetPredicate::Test not implemented");
+  switch (op()) {
+    case Expression::Operation::kIn:
+      return value_set_.Contains(value);
+    case Expression::Operation::kNotIn:
+      return !value_set_.Contains(value);
+    default:
+      return InvalidExpression("Invalid operation for BoundSetPredicate: {}", op());
+  }
+}
+
+Result<std::shared_ptr<Expression>> BoundSetPredicate::Negate() const {
+  ICEBERG_ASSIGN_OR_RAISE(auto negated_op, ::iceberg::Negate(op()));
+  return std::make_shared<BoundSetPredicate>(negated_op, term(), value_set_);
 }
 
 bool BoundSetPredicate::Equals(const Expression& other) const {
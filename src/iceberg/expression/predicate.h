@@ -25,6 +25,7 @@
 #include <concepts>
 
 #include "iceberg/expression/expression.h"
+#include "iceberg/expression/literal_set.h"
 #include "iceberg/expression/term.h"
 
 namespace iceberg {
@@ -78,6 +79,9 @@ class ICEBERG_EXPORT UnboundPredicate : public Predicate<UnboundTerm<B>>,
     return BASE::term()->reference();
   }
 
+  /// \brief Returns the literals this predicate compares against.
+  const std::vector<Literal>& literals() const { return values_; }
+
   std::string ToString() const override;
 
   /// \brief Bind this UnboundPredicate.
@@ -147,6 +151,8 @@ class ICEBERG_EXPORT BoundUnaryPredicate : public BoundPredicate {
 
   Kind kind() const override { return Kind::kUnary; }
 
+  Result<std::shared_ptr<Expression>> Negate() const override;
+
   std::string ToString() const override;
 
   bool Equals(const Expression& other) const override;
@@ -172,6 +178,8 @@ class ICEBERG_EXPORT BoundLiteralPredicate : public BoundPredicate {
 
   Kind kind() const override { return Kind::kLiteral; }
 
+  Result<std::shared_ptr<Expression>> Negate() const override;
+
   std::string ToString() const override;
 
   bool Equals(const Expression& other) const override;
@@ -191,23 +199,34 @@ class ICEBERG_EXPORT BoundSetPredicate : public BoundPredicate {
   BoundSetPredicate(Expression::Operation op, std::shared_ptr<BoundTerm> term,
                     std::span<const Literal> literals);
 
+  using LiteralSet = ::iceberg::LiteralSet;
+
+  /// \brief Create a bound set predicate from values already converted to the term
+  /// type.
+  ///
+  /// \param op The set operation (kIn, kNotIn)
+  /// \param term The bound term to test for membership
+  /// \param value_set The set of values to test against
+  BoundSetPredicate(Expression::Operation op, std::shared_ptr<BoundTerm> term,
+                    LiteralSet value_set);
+
   ~BoundSetPredicate() override;
 
   /// \brief Returns the set of literals to test against.
-  const std::vector<Literal::Value>& literal_set() const { return value_set_; }
+  const LiteralSet& literal_set() const { return value_set_; }
 
   Result<bool> Test(const Literal::Value& value) const override;
 
   Kind kind() const override { return Kind::kSet; }
 
+  Result<std::shared_ptr<Expression>> Negate() const override;
+
   std::string ToString() const override;
 
   bool Equals(const Expression& other) const override;
 
  private:
-  /// FIXME: Literal::Value does not have hash support. We need to add this
-  /// and replace the vector with a unordered_set.
-  std::vector<Literal::Value> value_set_;
+  LiteralSet value_set_;
 };
 
 }  // namespace iceberg
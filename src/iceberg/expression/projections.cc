@@ -0,0 +1,151 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/expression/projections.h"
+
+#include "iceberg/expression/expression_visitor.h"
+#include "iceberg/expression/expressions.h"
+#include "iceberg/expression/rewrite_not.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/transform.h"
+
+namespace iceberg {
+
+namespace {
+
+class BaseProjection : public ProjectionEvaluator,
+                       public ExpressionVisitor<std::shared_ptr<Expression>> {
+ public:
+  BaseProjection(std::shared_ptr<PartitionSpec> spec, bool case_sensitive)
+      : spec_(std::move(spec)), case_sensitive_(case_sensitive) {}
+
+  Result<std::shared_ptr<Expression>> Project(
+      const std::shared_ptr<Expression>& expr) override {
+    // Projections are only defined for expressions without Not nodes, e.g. the
+    // inclusive projection of not(x > 5) is not the negation of that of x > 5.
+    ICEBERG_ASSIGN_OR_RAISE(auto rewritten, RewriteNot::Rewrite(expr));
+    return Visit<std::shared_ptr<Expression>>(rewritten, *this);
+  }
+
+  Result<std::shared_ptr<Expression>> AlwaysTrue() override {
+    return Expressions::AlwaysTrue();
+  }
+
+  Result<std::shared_ptr<Expression>> AlwaysFalse() override {
+    return Expressions::AlwaysFalse();
+  }
+
+  Result<std::shared_ptr<Expression>> Not(
+      std::shared_ptr<Expression> child_result) override {
+    return InvalidExpression("Cannot project not expression, rewrite it first");
+  }
+
+  Result<std::shared_ptr<Expression>> And(
+      std::shared_ptr<Expression> left_result,
+      std::shared_ptr<Expression> right_result) override {
+    return Expressions::And(std::move(left_result), std::move(right_result));
+  }
+
+  Result<std::shared_ptr<Expression>> Or(
+      std::shared_ptr<Expression> left_result,
+      std::shared_ptr<Expression> right_result) override {
+    return Expressions::Or(std::move(left_result), std::move(right_result));
+  }
+
+  Result<std::shared_ptr<Expression>> Predicate(
+      const std::shared_ptr<Unbound<Expression>>& pred) override {
+    ICEBERG_ASSIGN_OR_RAISE(auto bound, pred->Bind(*spec_->schema(), case_sensitive_));
+    if (auto bound_pred = std::dynamic_pointer_cast<BoundPredicate>(bound)) {
+      return Predicate(bound_pred);
+    }
+    // Binding may simplify the predicate to true or false.
+    return bound;
+  }
+
+  using ExpressionVisitor<std::shared_ptr<Expression>>::Predicate;
+
+ protected:
+  std::shared_ptr<PartitionSpec> spec_;
+  bool case_sensitive_;
+};
+
+class InclusiveProjection : public BaseProjection {
+ public:
+  using BaseProjection::BaseProjection;
+  using BaseProjection::Predicate;
+
+  Result<std::shared_ptr<Expression>> Predicate(
+      const std::shared_ptr<BoundPredicate>& pred) override {
+    const int32_t source_id = pred->reference()->field().field_id();
+
+    // Every partition field derived from the source column narrows the projection.
+    std::shared_ptr<Expression> result = Expressions::AlwaysTrue();
+    for (const auto& field : spec_->fields()) {
+      if (field.source_id() != source_id) {
+        continue;
+      }
+      ICEBERG_ASSIGN_OR_RAISE(auto projected,
+                              field.transform()->Project(field.name(), pred));
+      if (projected != nullptr) {
+        result = Expressions::And(std::move(result), std::move(projected));
+      }
+    }
+    return result;
+  }
+};
+
+class StrictProjection : public BaseProjection {
+ public:
+  using BaseProjection::BaseProjection;
+  using BaseProjection::Predicate;
+
+  Result<std::shared_ptr<Expression>> Predicate(
+      const std::shared_ptr<BoundPredicate>& pred) override {
+    const int32_t source_id = pred->reference()->field().field_id();
+
+    // Any partition field derived from the source column may guarantee the predicate.
+    std::shared_ptr<Expression> result = Expressions::AlwaysFalse();
+    for (const auto& field : spec_->fields()) {
+      if (field.source_id() != source_id) {
+        continue;
+      }
+      ICEBERG_ASSIGN_OR_RAISE(auto projected,
+                              field.transform()->ProjectStrict(field.name(), pred));
+      if (projected != nullptr) {
+        result = Expressions::Or(std::move(result), std::move(projected));
+      }
+    }
+    return result;
+  }
+};
+
+}  // namespace
+
+std::unique_ptr<ProjectionEvaluator> Projections::Inclusive(
+    std::shared_ptr<PartitionSpec> spec, bool case_sensitive) {
+  return std::make_unique<InclusiveProjection>(std::move(spec), case_sensitive);
+}
+
+std::unique_ptr<ProjectionEvaluator> Projections::Strict(
+    std::shared_ptr<PartitionSpec> spec, bool case_sensitive) {
+  return std::make_unique<StrictProjection>(std::move(spec), case_sensitive);
+}
+
+}  // namespace iceberg
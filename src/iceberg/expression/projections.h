@@ -0,0 +1,77 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/expression/projections.h
+/// Project row filters to partition filters.
+
+#include <memory>
+
+#include "iceberg/expression/expression.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief Projects expressions on table columns to expressions on partition values.
+class ICEBERG_EXPORT ProjectionEvaluator {
+ public:
+  virtual ~ProjectionEvaluator() = default;
+
+  /// \brief Project an expression on the table schema.
+  ///
+  /// \param expr A bound or unbound expression on the table columns
+  /// \return An unbound expression on the partition fields
+  virtual Result<std::shared_ptr<Expression>> Project(
+      const std::shared_ptr<Expression>& expr) = 0;
+};
+
+/// \brief Factory methods for projection evaluators.
+class ICEBERG_EXPORT Projections {
+ public:
+  /// \brief Creates an inclusive projection for a partition spec.
+  ///
+  /// An inclusive projection guarantees that if an expression matches a row, the
+  /// projected expression will match the row's partition. Predicates that cannot be
+  /// projected, such as predicates on columns that are not partition sources, become
+  /// `true`.
+  ///
+  /// \param spec The partition spec to project through
+  /// \param case_sensitive Whether field name matching should be case sensitive
+  static std::unique_ptr<ProjectionEvaluator> Inclusive(
+      std::shared_ptr<PartitionSpec> spec, bool case_sensitive = true);
+
+  /// \brief Creates a strict projection for a partition spec.
+  ///
+  /// A strict projection guarantees that if the projected expression matches a
+  /// partition, the expression matches every row in the partition. Predicates that
+  /// cannot be projected, such as equality on a bucketed column, become `false`.
+  ///
+  /// \param spec The partition spec to project through
+  /// \param case_sensitive Whether field name matching should be case sensitive
+  static std::unique_ptr<ProjectionEvaluator> Strict(
+      std::shared_ptr<PartitionSpec> spec, bool case_sensitive = true);
+
+ private:
+  Projections() = default;
+};
+
+}  // namespace iceberg
@@ -0,0 +1,274 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/expression/residual_evaluator.h"
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+#include "iceberg/expression/binder.h"
+#include "iceberg/expression/expression_visitor.h"
+#include "iceberg/expression/expressions.h"
+#include "iceberg/expression/predicate.h"
+#include "iceberg/expression/rewrite_not.h"
+#include "iceberg/partition_map.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/transform.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief The projections of a row predicate to a partition field, bound to the
+/// partition schema. A null projection cannot decide the predicate.
+struct FieldProjection {
+  size_t position;
+  std::shared_ptr<Expression> strict;
+  std::shared_ptr<Expression> inclusive;
+};
+
+using ProjectionMap =
+    std::unordered_map<const BoundPredicate*, std::vector<FieldProjection>>;
+
+Result<std::shared_ptr<Expression>> BindProjection(
+    const std::shared_ptr<UnboundPredicate<BoundReference>>& projected,
+    const Schema& partition_schema) {
+  if (projected == nullptr) {
+    return nullptr;
+  }
+  return projected->Bind(partition_schema, /*case_sensitive=*/true);
+}
+
+/// \brief Returns whether a projection bound to the partition schema matches the
+/// partition value.
+Result<bool> TestProjection(const Expression& projection, const Literal& value) {
+  switch (projection.op()) {
+    case Expression::Operation::kTrue:
+      return true;
+    case Expression::Operation::kFalse:
+      return false;
+    default: {
+      const auto* pred = dynamic_cast<const BoundPredicate*>(&projection);
+      if (pred == nullptr) {
+        return InvalidExpression("Partition projection is not a predicate");
+      }
+      return pred->Test(value.value());
+    }
+  }
+}
+
+/// \brief Projects every predicate of a bound row filter to the partition fields.
+class ProjectionCollector : public ExpressionVisitor<bool> {
+ public:
+  ProjectionCollector(const PartitionSpec& spec, const Schema& partition_schema,
+                      ProjectionMap& projections)
+      : spec_(spec), partition_schema_(partition_schema), projections_(projections) {}
+
+  Result<bool> AlwaysTrue() override { return true; }
+  Result<bool> AlwaysFalse() override { return true; }
+  Result<bool> Not(bool child_result) override { return true; }
+  Result<bool> And(bool left_result, bool right_result) override { return true; }
+  Result<bool> Or(bool left_result, bool right_result) override { return true; }
+
+  Result<bool> Predicate(const std::shared_ptr<BoundPredicate>& pred) override {
+    const int32_t source_id = pred->reference()->field().field_id();
+    const auto fields = spec_.fields();
+    std::vector<FieldProjection> field_projections;
+    for (size_t pos = 0; pos < fields.size(); ++pos) {
+      const auto& field = fields[pos];
+      if (field.source_id() != source_id) {
+        continue;
+      }
+      ICEBERG_ASSIGN_OR_RAISE(auto strict,
+                              field.transform()->ProjectStrict(field.name(), pred));
+      ICEBERG_ASSIGN_OR_RAISE(auto inclusive,
+                              field.transform()->Project(field.name(), pred));
+      FieldProjection projection{.position = pos};
+      ICEBERG_ASSIGN_OR_RAISE(projection.strict,
+                              BindProjection(strict, partition_schema_));
+      ICEBERG_ASSIGN_OR_RAISE(projection.inclusive,
+                              BindProjection(inclusive, partition_schema_));
+      field_projections.push_back(std::move(projection));
+    }
+    if (!field_projections.empty()) {
+      projections_.emplace(pred.get(), std::move(field_projections));
+    }
+    return true;
+  }
+
+  Result<bool> Predicate(const std::shared_ptr<Unbound<Expression>>& pred) override {
+    return InvalidExpression("Residuals are only computed for bound expressions");
+  }
+
+ private:
+  const PartitionSpec& spec_;
+  const Schema& partition_schema_;
+  ProjectionMap& projections_;
+};
+
+/// \brief Replaces the predicates decided by a partition with true or false.
+class ResidualVisitor : public ExpressionVisitor<std::shared_ptr<Expression>> {
+ public:
+  ResidualVisitor(const ProjectionMap& projections, const std::vector<Literal>& partition)
+      : projections_(projections), partition_(partition) {}
+
+  Result<std::shared_ptr<Expression>> AlwaysTrue() override {
+    return Expressions::AlwaysTrue();
+  }
+
+  Result<std::shared_ptr<Expression>> AlwaysFalse() override {
+    return Expressions::AlwaysFalse();
+  }
+
+  Result<std::shared_ptr<Expression>> Not(
+      std::shared_ptr<Expression> child_result) override {
+    return Expressions::Not(std::move(child_result));
+  }
+
+  Result<std::shared_ptr<Expression>> And(
+      std::shared_ptr<Expression> left_result,
+      std::shared_ptr<Expression> right_result) override {
+    return Expressions::And(std::move(left_result), std::move(right_result));
+  }
+
+  Result<std::shared_ptr<Expression>> Or(
+      std::shared_ptr<Expression> left_result,
+      std::shared_ptr<Expression> right_result) override {
+    return Expressions::Or(std::move(left_result), std::move(right_result));
+  }
+
+  Result<std::shared_ptr<Expression>> Predicate(
+      const std::shared_ptr<BoundPredicate>& pred) override {
+    auto it = projections_.find(pred.get());
+    if (it == projections_.end()) {
+      // Not derived from a partition field, the predicate must be evaluated on rows.
+      return pred;
+    }
+    for (const auto& projection : it->second) {
+      const auto& value = partition_[projection.position];
+      if (projection.strict != nullptr) {
+        ICEBERG_ASSIGN_OR_RAISE(auto guaranteed,
+                                TestProjection(*projection.strict, value));
+        if (guaranteed) {
+          return Expressions::AlwaysTrue();
+        }
+      }
+      if (projection.inclusive != nullptr) {
+        ICEBERG_ASSIGN_OR_RAISE(auto possible,
+                                TestProjection(*projection.inclusive, value));
+        if (!possible) {
+          return Expressions::AlwaysFalse();
+        }
+      }
+    }
+    return pred;
+  }
+
+  Result<std::shared_ptr<Expression>> Predicate(
+      const std::shared_ptr<Unbound<Expression>>& pred) override {
+    return InvalidExpression("Residuals are only computed for bound expressions");
+  }
+
+ private:
+  const ProjectionMap& projections_;
+  const std::vector<Literal>& partition_;
+};
+
+}  // namespace
+
+class ResidualEvaluator::Impl {
+ public:
+  Impl(std::shared_ptr<Expression> expr, int32_t spec_id, size_t num_fields,
+       ProjectionMap projections)
+      : expr_(std::move(expr)),
+        spec_id_(spec_id),
+        num_fields_(num_fields),
+        projections_(std::move(projections)) {}
+
+  Result<std::shared_ptr<Expression>> ResidualFor(
+      const std::vector<Literal>& partition) {
+    if (projections_.empty()) {
+      // No predicate references a partition source column.
+      return expr_;
+    }
+    if (partition.size() != num_fields_) {
+      return InvalidArgument("Expected {} partition values, got {}", num_fields_,
+                             partition.size());
+    }
+
+    ICEBERG_ASSIGN_OR_RAISE(auto key, PartitionTupleKey::Make(spec_id_, partition));
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (const auto* residual = residuals_.Find(key); residual != nullptr) {
+        return *residual;
+      }
+    }
+
+    ResidualVisitor visitor(projections_, partition);
+    ICEBERG_ASSIGN_OR_RAISE(auto residual,
+                            Visit<std::shared_ptr<Expression>>(expr_, visitor));
+    std::lock_guard<std::mutex> lock(mutex_);
+    return *residuals_.TryEmplace(std::move(key), std::move(residual)).first;
+  }
+
+ private:
+  std::shared_ptr<Expression> expr_;
+  int32_t spec_id_;
+  size_t num_fields_;
+  ProjectionMap projections_;
+
+  std::mutex mutex_;
+  PartitionMap<std::shared_ptr<Expression>> residuals_;
+};
+
+ResidualEvaluator::ResidualEvaluator(std::unique_ptr<Impl> impl)
+    : impl_(std::move(impl)) {}
+
+ResidualEvaluator::~ResidualEvaluator() = default;
+
+Result<std::unique_ptr<ResidualEvaluator>> ResidualEvaluator::Make(
+    const std::shared_ptr<Expression>& expr, std::shared_ptr<PartitionSpec> spec,
+    bool case_sensitive) {
+  ICEBERG_ASSIGN_OR_RAISE(auto rewritten, RewriteNot::Rewrite(expr));
+  ICEBERG_ASSIGN_OR_RAISE(auto bound,
+                          Binder::Bind(*spec->schema(), rewritten, case_sensitive));
+
+  ICEBERG_ASSIGN_OR_RAISE(auto partition_schema, spec->PartitionSchema());
+  if (partition_schema == nullptr) {
+    partition_schema = std::make_shared<Schema>(std::vector<SchemaField>{});
+  }
+
+  ProjectionMap projections;
+  ProjectionCollector collector(*spec, *partition_schema, projections);
+  ICEBERG_RETURN_UNEXPECTED(Visit<bool>(bound, collector));
+
+  return std::unique_ptr<ResidualEvaluator>(new ResidualEvaluator(
+      std::make_unique<Impl>(std::move(bound), spec->spec_id(), spec->fields().size(),
+                             std::move(projections))));
+}
+
+Result<std::shared_ptr<Expression>> ResidualEvaluator::ResidualFor(
+    const std::vector<Literal>& partition) const {
+  return impl_->ResidualFor(partition);
+}
+
+}  // namespace iceberg
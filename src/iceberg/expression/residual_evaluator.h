@@ -0,0 +1,75 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/expression/residual_evaluator.h
+/// Compute the part of a row filter that is not guaranteed by a partition.
+
+#include <memory>
+#include <vector>
+
+#include "iceberg/expression/expression.h"
+#include "iceberg/expression/literal.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief Computes residual expressions of a row filter for partitions of a spec.
+///
+/// The residual of a filter for a partition is the filter with every predicate that
+/// is guaranteed by the partition values replaced by true, and every predicate that
+/// cannot match them replaced by false. Rows of a file in the partition match the
+/// filter if and only if they match the residual, so a residual of true means that
+/// rows need not be filtered at all.
+///
+/// Predicates are replaced by testing their strict and inclusive projections on the
+/// partition values. Residuals are memoized per partition, and an evaluator can be
+/// shared by threads.
+class ICEBERG_EXPORT ResidualEvaluator {
+ public:
+  ~ResidualEvaluator();
+
+  /// \brief Creates an evaluator for a filter on table rows.
+  ///
+  /// \param expr A bound or unbound expression on the schema of the spec
+  /// \param spec The partition spec of the partitions to evaluate
+  /// \param case_sensitive Whether field name matching should be case sensitive
+  static Result<std::unique_ptr<ResidualEvaluator>> Make(
+      const std::shared_ptr<Expression>& expr, std::shared_ptr<PartitionSpec> spec,
+      bool case_sensitive = true);
+
+  /// \brief Returns the residual of the filter for a partition.
+  ///
+  /// \param partition The partition values, ordered like the fields of the spec
+  /// \return The residual expression, bound to the schema of the spec
+  Result<std::shared_ptr<Expression>> ResidualFor(
+      const std::vector<Literal>& partition) const;
+
+ private:
+  class Impl;
+
+  explicit ResidualEvaluator(std::unique_ptr<Impl> impl);
+
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace iceberg
@@ -0,0 +1,77 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/expression/rewrite_not.h"
+
+#include "iceberg/expression/expression_visitor.h"
+#include "iceberg/expression/expressions.h"
+
+namespace iceberg {
+
+namespace {
+
+class RewriteNotVisitor : public ExpressionVisitor<std::shared_ptr<Expression>> {
+ public:
+  Result<std::shared_ptr<Expression>> AlwaysTrue() override {
+    return Expressions::AlwaysTrue();
+  }
+
+  Result<std::shared_ptr<Expression>> AlwaysFalse() override {
+    return Expressions::AlwaysFalse();
+  }
+
+  Result<std::shared_ptr<Expression>> Not(
+      std::shared_ptr<Expression> child_result) override {
+    // The child has already been rewritten, so negating it pushes the Not down to
+    // the predicates without introducing new Not nodes.
+    return child_result->Negate();
+  }
+
+  Result<std::shared_ptr<Expression>> And(
+      std::shared_ptr<Expression> left_result,
+      std::shared_ptr<Expression> right_result) override {
+    return Expressions::And(std::move(left_result), std::move(right_result));
+  }
+
+  Result<std::shared_ptr<Expression>> Or(
+      std::shared_ptr<Expression> left_result,
+      std::shared_ptr<Expression> right_result) override {
+    return Expressions::Or(std::move(left_result), std::move(right_result));
+  }
+
+  Result<std::shared_ptr<Expression>> Predicate(
+      const std::shared_ptr<BoundPredicate>& pred) override {
+    return pred;
+  }
+
+  Result<std::shared_ptr<Expression>> Predicate(
+      const std::shared_ptr<Unbound<Expression>>& pred) override {
+    return std::dynamic_pointer_cast<Expression>(pred);
+  }
+};
+
+}  // namespace
+
+Result<std::shared_ptr<Expression>> RewriteNot::Rewrite(
+    const std::shared_ptr<Expression>& expr) {
+  RewriteNotVisitor visitor;
+  return Visit<std::shared_ptr<Expression>>(expr, visitor);
+}
+
+}  // namespace iceberg
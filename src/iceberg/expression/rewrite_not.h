@@ -0,0 +1,47 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/expression/rewrite_not.h
+/// Push negations down to the predicates of an expression.
+
+#include <memory>
+
+#include "iceberg/expression/expression.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+
+namespace iceberg {
+
+/// \brief Rewrites an expression so that it no longer contains Not nodes.
+///
+/// Negations are applied to the operands using De Morgan's laws and to predicates by
+/// negating their operation, e.g. not(a < 5) becomes a >= 5.
+class ICEBERG_EXPORT RewriteNot {
+ public:
+  /// \brief Rewrite an expression without Not nodes.
+  ///
+  /// \param expr The bound or unbound expression to rewrite
+  /// \return An equivalent expression without Not nodes
+  static Result<std::shared_ptr<Expression>> Rewrite(
+      const std::shared_ptr<Expression>& expr);
+};
+
+}  // namespace iceberg
@@ -0,0 +1,123 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/fast_append.h"
+
+#include <format>
+#include <iterator>
+#include <string>
+
+#include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_reader.h"
+#include "iceberg/manifest_writer.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+FastAppend::FastAppend(std::shared_ptr<Table> table)
+    : SnapshotProducer(std::move(table)) {}
+
+FastAppend::~FastAppend() = default;
+
+AppendFiles& FastAppend::AppendFile(std::shared_ptr<DataFile> file) {
+  if (file == nullptr) {
+    errors_.emplace_back(ErrorKind::kInvalidArgument, "Cannot append null data file");
+    return *this;
+  }
+  if (file->content != DataFile::Content::kData) {
+    errors_.emplace_back(
+        ErrorKind::kInvalidArgument,
+        std::format("Cannot append delete file {} as a data file", file->file_path));
+    return *this;
+  }
+
+  ++added_files_count_;
+  added_records_ += file->record_count;
+  added_files_size_ += file->file_size_in_bytes;
+  const int32_t spec_id = file->partition_spec_id;
+  new_files_[spec_id].push_back(std::move(file));
+  return *this;
+}
+
+AppendFiles& FastAppend::Set(const std::string& property, const std::string& value) {
+  properties_[property] = value;
+  return *this;
+}
+
+Status FastAppend::Commit() {
+  if (!errors_.empty()) {
+    return InvalidArgument("{}", errors_.front().message);
+  }
+  return CommitSnapshot();
+}
+
+const std::string& FastAppend::operation() const { return DataOperation::kAppend; }
+
+Status FastAppend::WriteNewManifests(const TableMetadata& base) {
+  for (const auto& [spec_id, files] : new_files_) {
+    ICEBERG_ASSIGN_OR_RAISE(auto manifests, WriteAddedManifests(base, spec_id, files));
+    new_manifests_.insert(new_manifests_.end(),
+                          std::make_move_iterator(manifests.begin()),
+                          std::make_move_iterator(manifests.end()));
+  }
+  return {};
+}
+
+Result<std::vector<ManifestFile>> FastAppend::Apply(const TableMetadata& base,
+                                                    const Snapshot* parent) {
+  if (new_manifests_.empty() && !new_files_.empty()) {
+    ICEBERG_RETURN_UNEXPECTED(WriteNewManifests(base));
+  }
+
+  std::vector<ManifestFile> manifests = new_manifests_;
+  if (parent != nullptr) {
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto reader, ManifestListReader::Make(parent->manifest_list, table()->io()));
+    ICEBERG_ASSIGN_OR_RAISE(auto existing, reader->Files());
+    manifests.insert(manifests.end(), std::make_move_iterator(existing.begin()),
+                     std::make_move_iterator(existing.end()));
+  }
+  return manifests;
+}
+
+std::unordered_map<std::string, std::string> FastAppend::Summary() const {
+  auto summary = properties_;
+  summary[SnapshotSummaryFields::kAddedDataFiles] = std::to_string(added_files_count_);
+  summary[SnapshotSummaryFields::kAddedRecords] = std::to_string(added_records_);
+  summary[SnapshotSummaryFields::kAddedFileSize] = std::to_string(added_files_size_);
+  return summary;
+}
+
+void FastAppend::CleanUncommitted(const std::unordered_set<std::string>& committed) {
+  // New manifests may have been rewritten into other manifests before the commit.
+  for (const auto& manifest : new_manifests_) {
+    if (!committed.contains(manifest.manifest_path)) {
+      DeleteFile(manifest.manifest_path);
+    }
+  }
+  if (committed.empty()) {
+    new_manifests_.clear();
+  }
+}
+
+}  // namespace iceberg
@@ -0,0 +1,87 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/fast_append.h
+/// Append that writes the new files to new manifests without rewriting existing ones.
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "iceberg/append_files.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/snapshot_producer.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief Append implementation that adds a new manifest file for the write.
+///
+/// The new files of each partition spec are written to manifests of about
+/// `commit.manifest.target-size-bytes`, up to `commit.manifest.write-parallelism` at a
+/// time, which are added to the manifests of the current snapshot in the manifest list
+/// of the new snapshot. The
+/// manifests are written once: when a commit attempt conflicts with a concurrent
+/// commit, only the manifest list is written again on top of the refreshed table.
+class ICEBERG_EXPORT FastAppend : public SnapshotProducer, public AppendFiles {
+ public:
+  /// \brief Creates an append to a table.
+  ///
+  /// \param table The table to append to, which must have a catalog to commit to
+  explicit FastAppend(std::shared_ptr<Table> table);
+
+  ~FastAppend() override;
+
+  AppendFiles& AppendFile(std::shared_ptr<DataFile> file) override;
+
+  AppendFiles& Set(const std::string& property, const std::string& value) override;
+
+  Status Commit() override;
+
+ protected:
+  const std::string& operation() const override;
+
+  Result<std::vector<ManifestFile>> Apply(const TableMetadata& base,
+                                          const Snapshot* parent) override;
+
+  std::unordered_map<std::string, std::string> Summary() const override;
+
+  void CleanUncommitted(const std::unordered_set<std::string>& committed) override;
+
+ private:
+  /// \brief Writes the new files to manifests, once for all commit attempts.
+  Status WriteNewManifests(const TableMetadata& base);
+
+  // New data files by partition spec ID
+  std::map<int32_t, std::vector<std::shared_ptr<DataFile>>> new_files_;
+  std::vector<ManifestFile> new_manifests_;
+  std::unordered_map<std::string, std::string> properties_;
+  int64_t added_records_ = 0;
+  int64_t added_files_size_ = 0;
+  int32_t added_files_count_ = 0;
+  std::vector<Error> errors_;
+};
+
+}  // namespace iceberg
@@ -0,0 +1,150 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/file_io.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "iceberg/async.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief An input file of the content read whole by FileIO::ReadFile.
+class BufferedInputFile : public InputFile {
+ public:
+  BufferedInputFile(std::string location, std::string content)
+      : location_(std::move(location)), content_(std::move(content)) {}
+
+  const std::string& location() const override { return location_; }
+
+  Result<int64_t> Size() override { return static_cast<int64_t>(content_.size()); }
+
+  Result<int64_t> ReadAt(int64_t offset, std::span<uint8_t> out) override {
+    if (closed_) {
+      return Invalid("Cannot read closed file {}", location_);
+    }
+    if (offset < 0) {
+      return InvalidArgument("Cannot read file {} at negative offset {}", location_,
+                             offset);
+    }
+    const auto begin = std::min(static_cast<size_t>(offset), content_.size());
+    const auto length = std::min(out.size(), content_.size() - begin);
+    std::memcpy(out.data(), content_.data() + begin, length);
+    return static_cast<int64_t>(length);
+  }
+
+  Status Close() override {
+    closed_ = true;
+    return {};
+  }
+
+ private:
+  std::string location_;
+  std::string content_;
+  bool closed_ = false;
+};
+
+/// \brief An output file buffering its content, which is written whole by
+/// FileIO::WriteFile on close.
+class BufferedOutputFile : public OutputFile {
+ public:
+  BufferedOutputFile(FileIO& io, std::string location)
+      : io_(io), location_(std::move(location)) {}
+
+  const std::string& location() const override { return location_; }
+
+  Status Write(std::string_view data) override {
+    if (closed_) {
+      return Invalid("Cannot write closed file {}", location_);
+    }
+    content_.append(data);
+    return {};
+  }
+
+  Result<int64_t> Position() const override {
+    return static_cast<int64_t>(content_.size());
+  }
+
+  Status Close() override {
+    if (closed_) {
+      return {};
+    }
+    closed_ = true;
+    return io_.WriteFile(location_, content_);
+  }
+
+ private:
+  FileIO& io_;
+  std::string location_;
+  std::string content_;
+  bool closed_ = false;
+};
+
+}  // namespace
+
+Status InputFile::ReadRanges(std::span<const ReadRange> ranges) {
+  for (const auto& range : ranges) {
+    ICEBERG_ASSIGN_OR_RAISE(auto read, ReadAt(range.offset, range.out));
+    if (read != static_cast<int64_t>(range.out.size())) {
+      return IOError("Cannot read {} bytes at offset {} of file {}, only {} were read",
+                     range.out.size(), range.offset, location(), read);
+    }
+  }
+  return {};
+}
+
+Task<Result<std::string>> FileIO::ReadFileAsync(std::string file_location,
+                                                std::optional<size_t> length,
+                                                std::shared_ptr<Executor> executor) {
+  return RunOn(std::move(executor),
+               [this, file_location = std::move(file_location), length]() {
+                 return ReadFile(file_location, length);
+               });
+}
+
+Result<std::unique_ptr<InputFile>> FileIO::NewInputFile(const std::string& file_location,
+                                                        std::optional<size_t> length) {
+  ICEBERG_ASSIGN_OR_RAISE(auto content, ReadFile(file_location, length));
+  return std::make_unique<BufferedInputFile>(file_location, std::move(content));
+}
+
+Result<std::unique_ptr<OutputFile>> FileIO::NewOutputFile(
+    const std::string& file_location) {
+  return std::make_unique<BufferedOutputFile>(*this, file_location);
+}
+
+std::vector<FileDeleteFailure> FileIO::DeleteFiles(
+    std::span<const std::string> file_locations) {
+  std::vector<FileDeleteFailure> failures;
+  for (const auto& file_location : file_locations) {
+    auto status = DeleteFile(file_location);
+    if (!status.has_value()) {
+      failures.push_back(
+          {.file_location = file_location, .error = std::move(status.error())});
+    }
+  }
+  return failures;
+}
+
+}  // namespace iceberg
@@ -19,20 +19,121 @@
 
 #pragma once
 
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "iceberg/iceberg_export.h"
 #include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+#include "iceberg/util/timepoint.h"
 
 namespace iceberg {
 
+/// \brief A range of bytes of a file to read, and the buffer to read it into.
+struct ICEBERG_EXPORT ReadRange {
+  /// \brief The offset of the first byte to read.
+  int64_t offset;
+  /// \brief The buffer to read the bytes into, whose size is the number of bytes.
+  std::span<uint8_t> out;
+};
+
+/// \brief How the ranges of a vectored read are merged into fewer requests.
+///
+/// Object stores have a high latency per request, so reading the bytes between two
+/// close ranges is cheaper than issuing a request for each of them.
+struct ICEBERG_EXPORT ReadCoalescingOptions {
+  /// \brief The maximum number of bytes between two ranges that are merged.
+  int64_t hole_size_limit = 8 * 1024;
+  /// \brief The maximum size of a merged range. Larger ranges are not split.
+  int64_t range_size_limit = 32 * 1024 * 1024;
+};
+
+/// \brief A file opened for positional reads.
+///
+/// Reads do not move a position in the file, so that file formats can read the parts
+/// they need, e.g. the footer and the column chunks of a Parquet file, without reading
+/// the whole file. Implementations should support concurrent reads.
+class ICEBERG_EXPORT InputFile {
+ public:
+  virtual ~InputFile() = default;
+
+  /// \brief The location of the file.
+  virtual const std::string& location() const = 0;
+
+  /// \brief Returns the length of the file in bytes.
+  virtual Result<int64_t> Size() = 0;
+
+  /// \brief Reads bytes of the file from the given offset.
+  ///
+  /// \param offset The offset of the first byte to read.
+  /// \param out The buffer to read the bytes into.
+  /// \return The number of bytes read, which is less than the size of `out` only when
+  /// the end of the file is reached.
+  virtual Result<int64_t> ReadAt(int64_t offset, std::span<uint8_t> out) = 0;
+
+  /// \brief Reads several ranges of the file.
+  ///
+  /// The default implementation reads the ranges one after the other. Implementations
+  /// may coalesce close ranges or read them concurrently.
+  /// \return An error if a range could not be read fully.
+  virtual Status ReadRanges(std::span<const ReadRange> ranges);
+
+  /// \brief Closes the file. Reads fail once the file is closed.
+  virtual Status Close() { return {}; }
+};
+
+/// \brief A file opened for streaming writes.
+class ICEBERG_EXPORT OutputFile {
+ public:
+  virtual ~OutputFile() = default;
+
+  /// \brief The location of the file.
+  virtual const std::string& location() const = 0;
+
+  /// \brief Appends bytes to the file.
+  virtual Status Write(std::string_view data) = 0;
+
+  /// \brief Returns the number of bytes written so far.
+  virtual Result<int64_t> Position() const = 0;
+
+  /// \brief Flushes the bytes written so far, if the implementation buffers them.
+  virtual Status Flush() { return {}; }
+
+  /// \brief Finishes writing the file.
+  ///
+  /// The file may not exist or be incomplete until it is closed.
+  virtual Status Close() = 0;
+};
+
+/// \brief A file that FileIO::DeleteFiles could not delete.
+struct ICEBERG_EXPORT FileDeleteFailure {
+  /// \brief The location of the file.
+  std::string file_location;
+  /// \brief Why the file could not be deleted.
+  Error error;
+};
+
+/// \brief A file found by FileIO::ListFiles.
+struct ICEBERG_EXPORT FileInfo {
+  /// \brief The location of the file.
+  std::string location;
+  /// \brief The size of the file in bytes.
+  int64_t size = 0;
+  /// \brief When the file was last modified.
+  TimePointMs last_modified;
+};
+
 /// \brief Pluggable module for reading, writing, and deleting files.
 ///
-/// This module only handle metadata files, not data files. The metadata files
-/// are typically small and are used to store schema, partition information,
-/// and other metadata about the table.
+/// Metadata files, which are typically small and store the schema, partition
+/// information and other metadata about the table, are read and written whole.
+/// Data files are read and written through InputFile and OutputFile.
 ///
 /// Note that these functions are not atomic. For example, if a write fails,
 /// the file may be partially written. Implementations should be careful to
@@ -55,6 +156,21 @@ class ICEBERG_EXPORT FileIO {
     return NotImplemented("ReadFile not implemented");
   }
 
+  /// \brief Read the content of the file at the given location without blocking the
+  /// awaiting coroutine.
+  ///
+  /// The default implementation calls ReadFile on the executor. Implementations with
+  /// asynchronous clients should override it to not block a thread of the executor.
+  /// The FileIO must outlive the task.
+  ///
+  /// \param file_location The location of the file to read.
+  /// \param length The number of bytes to read, as for ReadFile.
+  /// \param executor The executor of the blocking call, the DefaultExecutor() if null.
+  /// \return A task returning what ReadFile returns.
+  virtual Task<Result<std::string>> ReadFileAsync(
+      std::string file_location, std::optional<size_t> length,
+      std::shared_ptr<Executor> executor = nullptr);
+
   /// \brief Write the given content to the file at the given location.
   ///
   /// \param file_location The location of the file to write.
@@ -66,6 +182,52 @@ class ICEBERG_EXPORT FileIO {
     return NotImplemented("WriteFile not implemented");
   }
 
+  /// \brief Write the given content to a new file, unless a file exists at the location.
+  ///
+  /// The check and the write are atomic: of concurrent writes to the same location,
+  /// exactly one succeeds. File systems implement it with a link or rename that does
+  /// not replace an existing file, object stores with a conditional put, such as S3
+  /// `If-None-Match: *`. Catalogs storing their tables in files commit with it.
+  ///
+  /// \param file_location The location of the file to write.
+  /// \param content The content to write to the file.
+  /// \return void if the file was written, ErrorKind::kAlreadyExists if a file exists at
+  /// the location, another error code if the write failed.
+  virtual Status WriteFileIfAbsent(const std::string& file_location,
+                                   std::string_view content) {
+    return NotImplemented("WriteFileIfAbsent not implemented");
+  }
+
+  /// \brief Check whether a file exists at the given location.
+  ///
+  /// \param file_location The location of the file to check.
+  /// \return Whether the file exists, or an error code if it could not be checked.
+  virtual Result<bool> FileExists(const std::string& file_location) {
+    return NotImplemented("FileExists not implemented");
+  }
+
+  /// \brief Opens the file at the given location for positional reads.
+  ///
+  /// The default implementation reads the whole file with ReadFile when the file is
+  /// opened. Implementations should override it to read the requested ranges only.
+  ///
+  /// \param file_location The location of the file to read.
+  /// \param length The length of the file if known, which saves a request for it.
+  /// \return The opened file, or an error if the file could not be opened.
+  virtual Result<std::unique_ptr<InputFile>> NewInputFile(
+      const std::string& file_location, std::optional<size_t> length);
+
+  /// \brief Opens the file at the given location for streaming writes.
+  ///
+  /// The default implementation buffers the written bytes and writes them with
+  /// WriteFile when the file is closed. Implementations should override it to stream
+  /// the bytes instead.
+  ///
+  /// \param file_location The location of the file to write.
+  /// \return The opened file, or an error if the file could not be created.
+  virtual Result<std::unique_ptr<OutputFile>> NewOutputFile(
+      const std::string& file_location);
+
   /// \brief Delete a file at the given location.
   ///
   /// \param file_location The location of the file to delete.
@@ -73,6 +235,32 @@ class ICEBERG_EXPORT FileIO {
   virtual Status DeleteFile(const std::string& file_location) {
     return NotImplemented("DeleteFile not implemented");
   }
+
+  /// \brief Delete the files at the given locations.
+  ///
+  /// Every file is attempted, whether or not the others could be deleted. The default
+  /// implementation deletes the files one after the other with DeleteFile.
+  /// Implementations should override it to delete the files in batches or
+  /// concurrently.
+  ///
+  /// \param file_locations The locations of the files to delete.
+  /// \return The files that could not be deleted, with their errors.
+  virtual std::vector<FileDeleteFailure> DeleteFiles(
+      std::span<const std::string> file_locations);
+
+  /// \brief Lists the files under a location, recursively.
+  ///
+  /// The files are visited as they are listed, in no particular order, so that
+  /// locations with many files are not held in memory. Locations keep the scheme of
+  /// the prefix. A missing prefix has no files.
+  ///
+  /// \param prefix The location to list.
+  /// \param visitor Called for each file, listing stops at the first error it returns.
+  /// \return void if all files were visited, an error code otherwise.
+  virtual Status ListFiles(const std::string& prefix,
+                           const std::function<Status(const FileInfo&)>& visitor) {
+    return NotImplemented("ListFiles not implemented");
+  }
 };
 
 }  // namespace iceberg
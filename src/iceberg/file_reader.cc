@@ -24,6 +24,8 @@
 #include "iceberg/result.h"
 #include "iceberg/util/formatter.h"
 #include "iceberg/util/macros.h"
+#include "iceberg/util/murmurhash3_internal.h"
+#include "iceberg/util/tracing.h"
 
 namespace iceberg {
 
@@ -35,8 +37,22 @@ ReaderFactory GetNotImplementedFactory(FileFormatType format_type) {
   };
 }
 
+FooterReader GetNotImplementedFooterReader(FileFormatType format_type) {
+  return [format_type](const FooterOptions&) -> Result<FileFooter> {
+    return NotImplemented("Missing footer reader for file format: {}", format_type);
+  };
+}
+
 }  // namespace
 
+bool RowGroupSample::Contains(std::string_view path, int64_t row_group) const {
+  uint32_t path_hash = 0;
+  MurmurHash3_x86_32(path.data(), static_cast<int>(path.size()), seed, &path_hash);
+  uint32_t hash = 0;
+  MurmurHash3_x86_32_Longs(&row_group, 1, path_hash, &hash);
+  return static_cast<double>(hash) < fraction * 0x1p32;
+}
+
 ReaderFactory& ReaderFactoryRegistry::GetFactory(FileFormatType format_type) {
   static std::unordered_map<FileFormatType, ReaderFactory> factories = {
       {FileFormatType::kAvro, GetNotImplementedFactory(FileFormatType::kAvro)},
@@ -54,9 +70,38 @@ ReaderFactoryRegistry::ReaderFactoryRegistry(FileFormatType format_type,
 
 Result<std::unique_ptr<Reader>> ReaderFactoryRegistry::Open(
     FileFormatType format_type, const ReaderOptions& options) {
+  ICEBERG_TRACE_SCOPE(trace, "Reader::Open");
+  ICEBERG_TRACE_ATTRIBUTE(trace, "path", options.path);
+  ICEBERG_TRACE_ATTRIBUTE(trace, "format", ToString(format_type));
   ICEBERG_ASSIGN_OR_RAISE(auto reader, GetFactory(format_type)());
   ICEBERG_RETURN_UNEXPECTED(reader->Open(options));
   return reader;
 }
 
+FooterReader& FooterReaderRegistry::GetReader(FileFormatType format_type) {
+  static std::unordered_map<FileFormatType, FooterReader> readers = {
+      {FileFormatType::kAvro, GetNotImplementedFooterReader(FileFormatType::kAvro)},
+      {FileFormatType::kParquet, GetNotImplementedFooterReader(FileFormatType::kParquet)},
+      {FileFormatType::kOrc, GetNotImplementedFooterReader(FileFormatType::kOrc)},
+      {FileFormatType::kPuffin, GetNotImplementedFooterReader(FileFormatType::kPuffin)},
+  };
+  return readers.at(format_type);
+}
+
+FooterReaderRegistry::FooterReaderRegistry(FileFormatType format_type,
+                                           FooterReader reader) {
+  GetReader(format_type) = std::move(reader);
+}
+
+Result<FileFooter> FooterReaderRegistry::Read(FileFormatType format_type,
+                                              const FooterOptions& options) {
+  ICEBERG_TRACE_SCOPE(trace, "Reader::ReadFooter");
+  ICEBERG_TRACE_ATTRIBUTE(trace, "path", options.path);
+  ICEBERG_TRACE_ATTRIBUTE(trace, "format", ToString(format_type));
+  if (options.schema == nullptr) {
+    return InvalidArgument("Cannot read the footer of {} without a schema", options.path);
+  }
+  return GetReader(format_type)(options);
+}
+
 }  // namespace iceberg
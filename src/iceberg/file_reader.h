@@ -22,12 +22,20 @@
 /// \file iceberg/file_reader.h
 /// Reader interface for file formats like Parquet, Avro and ORC.
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include "iceberg/arrow_c_data.h"
+#include "iceberg/expression/literal.h"
 #include "iceberg/file_format.h"
+#include "iceberg/metrics.h"
+#include "iceberg/metrics_config.h"
 #include "iceberg/result.h"
 #include "iceberg/type_fwd.h"
 
@@ -67,6 +75,48 @@ struct ICEBERG_EXPORT Split {
   size_t length;
 };
 
+/// \brief A deterministic sample of the row groups of a file.
+///
+/// A row group is in the sample when the hash of the path of the file, the index of the
+/// row group and the seed falls in the sampled fraction of the hash range, so that every
+/// read with the same seed reads the same row groups.
+struct ICEBERG_EXPORT RowGroupSample {
+  /// \brief The fraction of the row groups to read, in (0, 1].
+  double fraction = 1.0;
+  /// \brief The seed of the hash.
+  uint32_t seed = 0;
+
+  /// \brief Returns whether the row group at the given index of a file is sampled.
+  bool Contains(std::string_view path, int64_t row_group) const;
+};
+
+/// \brief Values of the metadata columns of a data file that are not stored in it.
+///
+/// The _file, _pos and _deleted metadata columns are generated by readers from the path
+/// of the file and the positions of the rows read.
+struct ICEBERG_EXPORT MetadataColumnValues {
+  /// \brief The id of the partition spec of the file, for the _spec_id column.
+  std::optional<int32_t> spec_id;
+  /// \brief The partition values of the file by partition field id, for the fields of
+  /// the _partition column. Fields without a value are null.
+  std::unordered_map<int32_t, Literal> partition;
+  /// \brief The first row id of the file, from which the _row_id of the rows that do
+  /// not store it is inherited as the first row id plus the position of the row.
+  std::optional<int64_t> first_row_id;
+  /// \brief The data sequence number of the file, which is inherited by the rows that
+  /// do not store their _last_updated_sequence_number.
+  std::optional<int64_t> data_sequence_number;
+};
+
+/// \brief A path of object fields in a variant column.
+struct ICEBERG_EXPORT VariantPath {
+  /// \brief The field id of the variant column.
+  int32_t field_id;
+  /// \brief The names of the object fields from the variant to the value, such as
+  /// {"user", "id"} for the path user.id.
+  std::vector<std::string> names;
+};
+
 /// \brief Options for creating a reader.
 struct ICEBERG_EXPORT ReaderOptions {
   static constexpr int64_t kDefaultBatchSize = 4096;
@@ -77,14 +127,24 @@ struct ICEBERG_EXPORT ReaderOptions {
   std::optional<size_t> length;
   /// \brief The split to read.
   std::optional<Split> split;
+  /// \brief The sample of the row groups to read, or std::nullopt to read them all.
+  /// Only the Parquet reader samples row groups, other readers read every row.
+  std::optional<RowGroupSample> row_group_sample;
   /// \brief The batch size to read. Only applies to implementations that support
   /// batching.
   int64_t batch_size = kDefaultBatchSize;
+  /// \brief The target number of bytes of a batch, which replaces `batch_size` when
+  /// set. Implementations estimate the number of rows from the width of the rows of
+  /// the projection, and adapt it to the sizes of the batches that are read.
+  std::optional<int64_t> target_batch_bytes;
   /// \brief FileIO instance to open the file. Reader implementations should down cast it
   /// to the specific FileIO implementation. By default, the `iceberg-bundle` library uses
   /// `ArrowFileSystemFileIO` as the default implementation.
   std::shared_ptr<class FileIO> io;
   /// \brief The projection schema to read from the file. This field is required.
+  ///
+  /// Top-level metadata columns of MetadataColumns, such as _file and _pos, are
+  /// generated by the reader. The _file column is read as a dictionary array.
   std::shared_ptr<class Schema> projection;
   /// \brief The filter to apply to the data. Reader implementations may ignore this if
   /// the file format does not support filtering.
@@ -92,6 +152,34 @@ struct ICEBERG_EXPORT ReaderOptions {
   /// \brief Name mapping for schema evolution compatibility. Used when reading files
   /// that may have different field names than the current schema.
   std::shared_ptr<class NameMapping> name_mapping;
+  /// \brief Positions of deleted rows of the file, which are skipped by the reader.
+  /// Positions are counted from the first row of the file, not of the split.
+  std::shared_ptr<const class PositionDeleteIndex> position_deletes;
+  /// \brief The pool to allocate the buffers of the batches from, the default pool of
+  /// the implementation if null. The pool must outlive the reader and its batches.
+  std::shared_ptr<MemoryPool> memory_pool;
+  /// \brief Receives the metrics of the reader, such as the bytes read, or null to not
+  /// collect them. Implementations may leave some of the metrics unset.
+  std::shared_ptr<ReadMetrics> metrics;
+  /// \brief The executor of the work that implementations parallelize within the file,
+  /// such as decoding the blocks of an Avro file, or null for the DefaultExecutor().
+  std::shared_ptr<Executor> executor;
+  /// \brief The values of the metadata columns of the projection that are not stored
+  /// in the file.
+  MetadataColumnValues metadata_columns;
+  /// \brief Values of top-level projected fields that are the same for every row of the
+  /// file, such as identity partition values, by field id. These fields are not read
+  /// from the file, and are returned as arrays broadcast from the values.
+  std::unordered_map<int32_t, Literal> constants;
+  /// \brief Initial default values of top-level projected fields by field id, which are
+  /// returned like `constants` for the fields that are missing from the file.
+  std::unordered_map<int32_t, Literal> default_values;
+  /// \brief Top-level optional primitive fields of the projection that are read from
+  /// paths of top-level variant columns, by field id. Values that are missing or of
+  /// another type are read as null. Readers of shredded variants read the typed values
+  /// of a path directly and prune rows by them like other columns. Only the Parquet
+  /// reader supports variant columns.
+  std::unordered_map<int32_t, VariantPath> variant_paths;
   /// \brief Format-specific or implementation-specific properties.
   std::unordered_map<std::string, std::string> properties;
 };
@@ -112,4 +200,50 @@ struct ICEBERG_EXPORT ReaderFactoryRegistry {
                                               const ReaderOptions& options);
 };
 
+/// \brief Options for reading the metrics of an existing data file from its footer.
+struct ICEBERG_EXPORT FooterOptions {
+  /// \brief The path to the file to read.
+  std::string path;
+  /// \brief The total length of the file, which is looked up if unset.
+  std::optional<size_t> length;
+  /// \brief FileIO instance to open the file.
+  std::shared_ptr<class FileIO> io;
+  /// \brief The schema of the table the file is added to. This field is required.
+  ///
+  /// Columns of the file are matched to its fields by field id, and the columns that
+  /// do not match a primitive field have no metrics.
+  std::shared_ptr<class Schema> schema;
+  /// \brief Name mapping that assigns field ids to the columns of files written without
+  /// them, such as the files of tables migrated to Iceberg.
+  std::shared_ptr<class NameMapping> name_mapping;
+  /// \brief The metrics modes of the fields of `schema`.
+  MetricsConfig metrics_config = MetricsConfig::Default();
+};
+
+/// \brief The length, metrics and split offsets of a data file read from its footer.
+struct ICEBERG_EXPORT FileFooter {
+  int64_t length = 0;
+  Metrics metrics;
+  std::vector<int64_t> split_offsets;
+};
+
+/// \brief Function reading the footer of a file of a specific file format.
+using FooterReader = std::function<Result<FileFooter>(const FooterOptions&)>;
+
+/// \brief Registry of footer readers for different file formats.
+///
+/// Footer readers compute the metrics of a file from the statistics stored in its
+/// footer without reading its data, with the same bounds truncation as the writers.
+struct ICEBERG_EXPORT FooterReaderRegistry {
+  /// \brief Register a footer reader for a specific file format.
+  FooterReaderRegistry(FileFormatType format_type, FooterReader reader);
+
+  /// \brief Get the footer reader for a specific file format.
+  static FooterReader& GetReader(FileFormatType format_type);
+
+  /// \brief Read the footer of a file of a specific file format.
+  static Result<FileFooter> Read(FileFormatType format_type,
+                                 const FooterOptions& options);
+};
+
 }  // namespace iceberg
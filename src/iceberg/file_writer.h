@@ -25,6 +25,9 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 
 #include "iceberg/arrow_c_data.h"
 #include "iceberg/file_format.h"
@@ -36,6 +39,23 @@ namespace iceberg {
 
 /// \brief Options for creating a writer.
 struct ICEBERG_EXPORT WriterOptions {
+  /// \brief Writer property with the number of parts of the file that are uploaded in
+  /// the background, on the default executor, while the writer encodes the next ones.
+  /// The encoded bytes are cut into parts of kUploadPartSizeProperty bytes, which are
+  /// written to the file in order, and the writer waits while this many parts are
+  /// pending. Not set by default, which writes the bytes on the calling thread.
+  static constexpr std::string_view kUploadPartsInFlightProperty =
+      "write.upload.parts-in-flight";
+  /// \brief Writer property with the size in bytes of the parts uploaded in the
+  /// background.
+  static constexpr std::string_view kUploadPartSizeProperty =
+      "write.upload.part-size-bytes";
+  static constexpr int64_t kDefaultUploadPartSize = 8 * 1024 * 1024;
+  /// \brief Writer property with the comma-separated IDs of the fields that the rows
+  /// are sorted by, which writers may use to choose the encodings of their columns.
+  /// Set by SortedDataWriter for the fields of its sort order that are not transformed.
+  static constexpr std::string_view kSortedFieldIdsProperty = "write.sorted-field-ids";
+
   /// \brief The path to the file to write.
   std::string path;
   /// \brief The schema of the data to write.
@@ -44,6 +64,9 @@ struct ICEBERG_EXPORT WriterOptions {
   /// to the specific FileIO implementation. By default, the `iceberg-bundle` library uses
   /// `ArrowFileSystemFileIO` as the default implementation.
   std::shared_ptr<class FileIO> io;
+  /// \brief The pool to allocate the buffers of the writer from, the default pool of
+  /// the implementation if null. The pool must outlive the writer.
+  std::shared_ptr<MemoryPool> memory_pool;
   /// \brief Format-specific or implementation-specific properties.
   std::unordered_map<std::string, std::string> properties;
 };
@@ -76,6 +99,13 @@ class ICEBERG_EXPORT Writer {
   /// Only valid after the file is closed.
   virtual std::optional<int64_t> length() = 0;
 
+  /// \brief Get the estimated length of the file while it is written.
+  ///
+  /// The estimate covers the bytes already written to the file and the encoded size of
+  /// the buffered rows, so that files can be rolled at a target size. Returns
+  /// std::nullopt if the writer cannot estimate it.
+  virtual std::optional<int64_t> estimated_length() { return std::nullopt; }
+
   /// \brief Returns a list of recommended split locations, if applicable, empty
   /// otherwise. When available, this information is used for planning scan tasks whose
   /// boundaries are determined by these offsets. The returned list must be sorted in
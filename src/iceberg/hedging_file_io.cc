@@ -0,0 +1,398 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/hedging_file_io.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <string_view>
+#include <utility>
+#include <variant>
+
+#include "iceberg/executor.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// \brief The number of recent latencies the hedge delay is computed from.
+constexpr size_t kLatencySamples = 512;
+/// \brief The number of latencies recorded before the hedge delay is computed.
+constexpr size_t kMinLatencySamples = 32;
+/// \brief The number of latencies recorded between two computations of the delay.
+constexpr size_t kHedgeDelayInterval = 32;
+
+/// \brief The bytes of a positional read.
+struct ReadBuffer {
+  std::vector<uint8_t> bytes;
+  int64_t length = 0;
+};
+
+}  // namespace
+
+/// \brief The concurrency limit, the recent latencies and the counters, shared by a
+/// HedgingFileIO, its input files and the requests still running for them.
+class HedgingState : public std::enable_shared_from_this<HedgingState> {
+ public:
+  explicit HedgingState(HedgingFileIO::Options options)
+      : options_(std::move(options)),
+        limit_(static_cast<double>(options_.initial_concurrency)),
+        hedge_delay_(options_.initial_hedge_delay) {}
+
+  const HedgingFileIO::Options& options() const { return options_; }
+
+  /// \brief Runs a request within the concurrency limit, retrying it when throttled.
+  template <typename T>
+  Result<T> Run(const std::function<Result<T>()>& request) {
+    for (int32_t attempt = 0;; ++attempt) {
+      const auto started = Acquire();
+      auto result = request();
+      const bool throttled = !result.has_value() && IsThrottling(result.error());
+      Release(started, throttled);
+      if (result.has_value()) {
+        RecordLatency(Clock::now() - started);
+      }
+      if (!throttled || attempt >= options_.max_throttle_retries) {
+        return result;
+      }
+    }
+  }
+
+  /// \brief Runs a request, and a second one if the first takes longer than the hedge
+  /// delay, returning the first result that succeeds.
+  template <typename T>
+  Result<T> Hedge(std::function<Result<T>()> request) {
+    struct Race {
+      std::mutex mutex;
+      std::condition_variable done_cv;
+      std::array<bool, 2> claimed{};
+      std::array<bool, 2> done{};
+      std::optional<T> value;
+      size_t winner = 0;
+      std::optional<Error> error;
+    };
+    auto race = std::make_shared<Race>();
+    auto launch = [self = shared_from_this(), race, request](size_t index) {
+      return [self, race, request, index]() {
+        {
+          std::lock_guard lock(race->mutex);
+          if (race->claimed[index]) {
+            return;
+          }
+          race->claimed[index] = true;
+        }
+        auto result = self->Run<T>(request);
+        std::lock_guard lock(race->mutex);
+        race->done[index] = true;
+        if (result.has_value()) {
+          if (!race->value.has_value()) {
+            race->value = std::move(result.value());
+            race->winner = index;
+          }
+        } else if (!race->error.has_value()) {
+          race->error = std::move(result.error());
+        }
+        race->done_cv.notify_all();
+      };
+    };
+    auto& executor = options_.executor != nullptr ? *options_.executor
+                                                  : *DefaultExecutor();
+
+    executor.Submit(launch(0));
+    std::unique_lock lock(race->mutex);
+    race->done_cv.wait_for(lock, hedge_delay(), [&] { return race->done[0]; });
+    if (!race->claimed[0]) {
+      // The executor is busy, so the request runs here and is not hedged.
+      race->claimed[0] = true;
+      lock.unlock();
+      return Run<T>(request);
+    }
+    if (!race->done[0] && HasCapacity()) {
+      hedged_reads_.fetch_add(1, std::memory_order_relaxed);
+      lock.unlock();
+      executor.Submit(launch(1));
+      lock.lock();
+    }
+    // A request that has not started is never waited for.
+    race->done_cv.wait(lock, [&] {
+      return race->value.has_value() ||
+             std::ranges::none_of(std::array<size_t, 2>{0, 1}, [&](size_t index) {
+               return race->claimed[index] && !race->done[index];
+             });
+    });
+    race->claimed = {true, true};
+    if (!race->value.has_value()) {
+      return std::unexpected(std::move(race->error.value()));
+    }
+    if (race->winner == 1) {
+      hedge_wins_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return std::move(race->value.value());
+  }
+
+  HedgingFileIO::Stats stats() const {
+    HedgingFileIO::Stats stats{
+        .hedged_reads = hedged_reads_.load(std::memory_order_relaxed),
+        .hedge_wins = hedge_wins_.load(std::memory_order_relaxed),
+        .throttled_requests = throttled_requests_.load(std::memory_order_relaxed),
+    };
+    {
+      std::lock_guard lock(limit_mutex_);
+      stats.concurrency_limit = limit_;
+    }
+    stats.hedge_delay = hedge_delay();
+    return stats;
+  }
+
+ private:
+  bool IsThrottling(const Error& error) const {
+    return options_.is_throttling ? options_.is_throttling(error)
+                                  : HedgingFileIO::IsThrottling(error);
+  }
+
+  int32_t Capacity() const {
+    return std::max(options_.min_concurrency, static_cast<int32_t>(limit_));
+  }
+
+  /// \brief Waits until a request can start within the limit, returning its start.
+  Clock::time_point Acquire() {
+    std::unique_lock lock(limit_mutex_);
+    limit_cv_.wait(lock, [&] { return in_flight_ < Capacity(); });
+    ++in_flight_;
+    return Clock::now();
+  }
+
+  bool HasCapacity() const {
+    std::lock_guard lock(limit_mutex_);
+    return in_flight_ < Capacity();
+  }
+
+  /// \brief Ends a request, halving the limit if it was throttled and the limit was
+  /// not already halved since it started, and otherwise raising it additively.
+  void Release(Clock::time_point started, bool throttled) {
+    {
+      std::lock_guard lock(limit_mutex_);
+      --in_flight_;
+      if (throttled) {
+        throttled_requests_.fetch_add(1, std::memory_order_relaxed);
+        if (started >= last_decrease_) {
+          limit_ = std::max(static_cast<double>(options_.min_concurrency), limit_ / 2);
+          last_decrease_ = Clock::now();
+        }
+      } else {
+        limit_ = std::min(static_cast<double>(options_.max_concurrency),
+                          limit_ + 1 / limit_);
+      }
+    }
+    limit_cv_.notify_all();
+  }
+
+  void RecordLatency(Clock::duration latency) {
+    std::lock_guard lock(latency_mutex_);
+    latencies_[num_latencies_ % kLatencySamples] = latency;
+    ++num_latencies_;
+    if (num_latencies_ < kMinLatencySamples ||
+        num_latencies_ % kHedgeDelayInterval != 0) {
+      return;
+    }
+    std::vector<Clock::duration> samples(
+        latencies_.begin(),
+        latencies_.begin() + static_cast<std::ptrdiff_t>(
+                                 std::min(num_latencies_, kLatencySamples)));
+    const auto rank = std::min(
+        samples.size() - 1,
+        static_cast<size_t>(std::ceil(options_.hedge_percentile *
+                                      static_cast<double>(samples.size()))) -
+            1);
+    const auto nth = samples.begin() + static_cast<std::ptrdiff_t>(rank);
+    std::ranges::nth_element(samples, nth);
+    hedge_delay_ = std::max<Clock::duration>(*nth, options_.min_hedge_delay);
+  }
+
+  Clock::duration hedge_delay() const {
+    std::lock_guard lock(latency_mutex_);
+    return hedge_delay_;
+  }
+
+  const HedgingFileIO::Options options_;
+
+  mutable std::mutex limit_mutex_;
+  std::condition_variable limit_cv_;
+  double limit_;
+  int32_t in_flight_ = 0;
+  Clock::time_point last_decrease_{};
+
+  mutable std::mutex latency_mutex_;
+  std::array<Clock::duration, kLatencySamples> latencies_{};
+  size_t num_latencies_ = 0;
+  Clock::duration hedge_delay_;
+
+  std::atomic<int64_t> hedged_reads_{0};
+  std::atomic<int64_t> hedge_wins_{0};
+  std::atomic<int64_t> throttled_requests_{0};
+};
+
+namespace {
+
+class HedgingInputFile : public InputFile {
+ public:
+  HedgingInputFile(std::shared_ptr<InputFile> file, std::shared_ptr<HedgingState> state)
+      : file_(std::move(file)), state_(std::move(state)) {}
+
+  const std::string& location() const override { return file_->location(); }
+
+  Result<int64_t> Size() override { return file_->Size(); }
+
+  Result<int64_t> ReadAt(int64_t offset, std::span<uint8_t> out) override {
+    if (std::cmp_greater(out.size(), state_->options().max_hedged_read_bytes)) {
+      return state_->Run<int64_t>([&]() { return file_->ReadAt(offset, out); });
+    }
+    // The requests still running once the read returned must not write to `out`.
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto buffer,
+        state_->Hedge<ReadBuffer>([file = file_, offset,
+                                   size = out.size()]() -> Result<ReadBuffer> {
+          ReadBuffer buffer{.bytes = std::vector<uint8_t>(size)};
+          ICEBERG_ASSIGN_OR_RAISE(buffer.length, file->ReadAt(offset, buffer.bytes));
+          return buffer;
+        }));
+    std::memcpy(out.data(), buffer.bytes.data(), static_cast<size_t>(buffer.length));
+    return buffer.length;
+  }
+
+  Status ReadRanges(std::span<const ReadRange> ranges) override {
+    ICEBERG_RETURN_UNEXPECTED(
+        state_->Run<std::monostate>([&]() -> Result<std::monostate> {
+          ICEBERG_RETURN_UNEXPECTED(file_->ReadRanges(ranges));
+          return std::monostate{};
+        }));
+    return {};
+  }
+
+  Status Close() override { return file_->Close(); }
+
+ private:
+  // Shared with the requests of hedged reads, which may outlive the read.
+  std::shared_ptr<InputFile> file_;
+  std::shared_ptr<HedgingState> state_;
+};
+
+}  // namespace
+
+HedgingFileIO::HedgingFileIO(std::shared_ptr<FileIO> file_io,
+                             std::shared_ptr<HedgingState> state)
+    : file_io_(std::move(file_io)), state_(std::move(state)) {}
+
+HedgingFileIO::~HedgingFileIO() = default;
+
+Result<std::shared_ptr<HedgingFileIO>> HedgingFileIO::Make(
+    std::shared_ptr<FileIO> file_io, Options options) {
+  if (file_io == nullptr) {
+    return InvalidArgument("FileIO to hedge must not be null");
+  }
+  if (!(options.hedge_percentile > 0 && options.hedge_percentile <= 1)) {
+    return InvalidArgument("Hedge percentile must be in (0, 1], got {}",
+                           options.hedge_percentile);
+  }
+  if (options.min_concurrency < 1 ||
+      options.max_concurrency < options.min_concurrency ||
+      options.initial_concurrency < options.min_concurrency ||
+      options.initial_concurrency > options.max_concurrency) {
+    return InvalidArgument(
+        "Concurrency limits must satisfy 1 <= min <= initial <= max, got {}, {} and {}",
+        options.min_concurrency, options.initial_concurrency, options.max_concurrency);
+  }
+  if (options.max_throttle_retries < 0) {
+    return InvalidArgument("Throttle retries must not be negative, got {}",
+                           options.max_throttle_retries);
+  }
+  return std::shared_ptr<HedgingFileIO>(new HedgingFileIO(
+      std::move(file_io), std::make_shared<HedgingState>(std::move(options))));
+}
+
+bool HedgingFileIO::IsThrottling(const Error& error) {
+  constexpr std::array<std::string_view, 5> kMarkers = {"503", "429", "SlowDown",
+                                                        "Throttl", "TooManyRequests"};
+  return std::ranges::any_of(kMarkers, [&](std::string_view marker) {
+    return error.message.find(marker) != std::string::npos;
+  });
+}
+
+Result<std::string> HedgingFileIO::ReadFile(const std::string& file_location,
+                                            std::optional<size_t> length) {
+  auto read = [file_io = file_io_, file_location, length]() {
+    return file_io->ReadFile(file_location, length);
+  };
+  if (length.has_value() &&
+      std::cmp_greater(*length, state_->options().max_hedged_read_bytes)) {
+    return state_->Run<std::string>(read);
+  }
+  return state_->Hedge<std::string>(std::move(read));
+}
+
+Status HedgingFileIO::WriteFile(const std::string& file_location,
+                                std::string_view content) {
+  return file_io_->WriteFile(file_location, content);
+}
+
+Status HedgingFileIO::WriteFileIfAbsent(const std::string& file_location,
+                                        std::string_view content) {
+  return file_io_->WriteFileIfAbsent(file_location, content);
+}
+
+Result<bool> HedgingFileIO::FileExists(const std::string& file_location) {
+  return file_io_->FileExists(file_location);
+}
+
+Result<std::unique_ptr<InputFile>> HedgingFileIO::NewInputFile(
+    const std::string& file_location, std::optional<size_t> length) {
+  ICEBERG_ASSIGN_OR_RAISE(auto file, file_io_->NewInputFile(file_location, length));
+  return std::make_unique<HedgingInputFile>(std::move(file), state_);
+}
+
+Result<std::unique_ptr<OutputFile>> HedgingFileIO::NewOutputFile(
+    const std::string& file_location) {
+  return file_io_->NewOutputFile(file_location);
+}
+
+Status HedgingFileIO::DeleteFile(const std::string& file_location) {
+  return file_io_->DeleteFile(file_location);
+}
+
+std::vector<FileDeleteFailure> HedgingFileIO::DeleteFiles(
+    std::span<const std::string> file_locations) {
+  return file_io_->DeleteFiles(file_locations);
+}
+
+Status HedgingFileIO::ListFiles(const std::string& prefix,
+                                const std::function<Status(const FileInfo&)>& visitor) {
+  return file_io_->ListFiles(prefix, visitor);
+}
+
+HedgingFileIO::Stats HedgingFileIO::stats() const { return state_->stats(); }
+
+}  // namespace iceberg
@@ -0,0 +1,153 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/hedging_file_io.h
+/// FileIO decorator hedging slow reads and adapting their concurrency to throttling.
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "iceberg/file_io.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+class HedgingState;
+
+/// \brief A FileIO that cuts the tail latency of the reads of another FileIO.
+///
+/// A whole-file read or a positional read is hedged: once it has taken longer than a
+/// percentile of the latencies of the recent reads, the same read is issued again and
+/// the first of the two to succeed is returned. Both requests run on the executor,
+/// into buffers of their own, so that the read returns as soon as either is done; a
+/// request that has not started when the read is hedged is run on the calling thread
+/// instead, and the read is not hedged.
+///
+/// The reads in flight are limited by a concurrency limit adjusted like TCP
+/// congestion windows (AIMD). A read rejected by throttling, such as an HTTP 503
+/// SlowDown response of S3, halves the limit, at most once per round of requests, and
+/// is retried; every successful read raises the limit by its inverse, so by one per
+/// round of requests. Hedges are only issued while the limit is not reached.
+///
+/// Vectored reads are only limited and retried, since they may be coalesced into
+/// several requests by the FileIO. Writes, deletes and listings are forwarded.
+class ICEBERG_EXPORT HedgingFileIO : public FileIO {
+ public:
+  /// \brief Configuration of the hedging and of the concurrency limit.
+  struct Options {
+    /// \brief The percentile of the recent read latencies after which a read is
+    /// hedged, in (0, 1].
+    double hedge_percentile = 0.95;
+    /// \brief The delay after which reads are hedged until enough latencies are
+    /// known.
+    std::chrono::milliseconds initial_hedge_delay{500};
+    /// \brief The shortest delay after which a read is hedged.
+    std::chrono::milliseconds min_hedge_delay{10};
+    /// \brief Reads of more bytes are not hedged, as they are copied once read.
+    int64_t max_hedged_read_bytes = 16 * 1024 * 1024;
+    /// \brief The concurrency limit to start with.
+    int32_t initial_concurrency = 64;
+    /// \brief The lowest concurrency limit, at least 1.
+    int32_t min_concurrency = 1;
+    /// \brief The highest concurrency limit.
+    int32_t max_concurrency = 512;
+    /// \brief The number of times a throttled request is retried.
+    int32_t max_throttle_retries = 3;
+    /// \brief Returns whether an error is a throttling response. IsThrottling if not
+    /// set.
+    std::function<bool(const Error&)> is_throttling;
+    /// \brief Runs the requests of hedged reads, or null for the DefaultExecutor().
+    std::shared_ptr<Executor> executor;
+  };
+
+  /// \brief Counters of the hedging and of the concurrency limit.
+  struct Stats {
+    /// \brief Number of reads hedged with a second request.
+    int64_t hedged_reads = 0;
+    /// \brief Number of hedged reads returned by their second request.
+    int64_t hedge_wins = 0;
+    /// \brief Number of requests rejected by throttling.
+    int64_t throttled_requests = 0;
+    /// \brief The current concurrency limit.
+    double concurrency_limit = 0;
+    /// \brief The current delay after which reads are hedged.
+    std::chrono::nanoseconds hedge_delay{0};
+  };
+
+  ~HedgingFileIO() override;
+
+  /// \brief Creates a FileIO hedging the reads of `file_io`.
+  ///
+  /// \param file_io The FileIO making the requests
+  /// \param options The configuration of the hedging
+  /// \return A Result containing the FileIO, or an error if `file_io` is null or the
+  /// options are invalid.
+  static Result<std::shared_ptr<HedgingFileIO>> Make(std::shared_ptr<FileIO> file_io,
+                                                     Options options);
+
+  /// \brief Returns whether an error looks like the throttling response of an object
+  /// store, from the HTTP status 503 or 429 or the S3 error codes SlowDown and
+  /// Throttling in its message.
+  static bool IsThrottling(const Error& error);
+
+  Result<std::string> ReadFile(const std::string& file_location,
+                               std::optional<size_t> length) override;
+
+  Status WriteFile(const std::string& file_location, std::string_view content) override;
+
+  Status WriteFileIfAbsent(const std::string& file_location,
+                           std::string_view content) override;
+
+  Result<bool> FileExists(const std::string& file_location) override;
+
+  Result<std::unique_ptr<InputFile>> NewInputFile(const std::string& file_location,
+                                                  std::optional<size_t> length) override;
+
+  Result<std::unique_ptr<OutputFile>> NewOutputFile(
+      const std::string& file_location) override;
+
+  Status DeleteFile(const std::string& file_location) override;
+
+  std::vector<FileDeleteFailure> DeleteFiles(
+      std::span<const std::string> file_locations) override;
+
+  Status ListFiles(const std::string& prefix,
+                   const std::function<Status(const FileInfo&)>& visitor) override;
+
+  /// \brief Returns a snapshot of the counters.
+  Stats stats() const;
+
+ private:
+  HedgingFileIO(std::shared_ptr<FileIO> file_io, std::shared_ptr<HedgingState> state);
+
+  std::shared_ptr<FileIO> file_io_;
+  std::shared_ptr<HedgingState> state_;
+};
+
+}  // namespace iceberg
@@ -0,0 +1,194 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/import_files.h"
+
+#include <string>
+#include <utility>
+
+#include <nlohmann/json.hpp>
+
+#include "iceberg/executor.h"
+#include "iceberg/fast_append.h"
+#include "iceberg/file_reader.h"
+#include "iceberg/json_internal.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/metrics_config.h"
+#include "iceberg/name_mapping.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/table_properties.h"
+#include "iceberg/util/conversions.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief Returns the name mapping set by the `schema.name-mapping.default` property of
+/// a table, or null if it is not set.
+Result<std::shared_ptr<NameMapping>> DefaultNameMapping(const TableMetadata& metadata) {
+  auto it = metadata.properties.find(std::string(TableProperties::kDefaultNameMapping));
+  if (it == metadata.properties.end()) {
+    return nullptr;
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto json, FromJsonString(it->second));
+  ICEBERG_ASSIGN_OR_RAISE(auto name_mapping, NameMappingFromJson(json));
+  return std::shared_ptr<NameMapping>(std::move(name_mapping));
+}
+
+/// \brief Sets the metrics of a data file read from its footer.
+Status SetMetrics(const Metrics& metrics, DataFile& data_file) {
+  auto copy_counts = [](const auto& from, auto& to) {
+    for (const auto& [field_id, count] : from) {
+      to[static_cast<int32_t>(field_id)] = count;
+    }
+  };
+  data_file.record_count = metrics.row_count;
+  copy_counts(metrics.column_sizes, data_file.column_sizes);
+  copy_counts(metrics.value_counts, data_file.value_counts);
+  copy_counts(metrics.null_value_counts, data_file.null_value_counts);
+  copy_counts(metrics.nan_value_counts, data_file.nan_value_counts);
+  for (const auto& [field_id, bound] : metrics.lower_bounds) {
+    ICEBERG_ASSIGN_OR_RAISE(data_file.lower_bounds[static_cast<int32_t>(field_id)],
+                            Conversions::ToBytes(bound));
+  }
+  for (const auto& [field_id, bound] : metrics.upper_bounds) {
+    ICEBERG_ASSIGN_OR_RAISE(data_file.upper_bounds[static_cast<int32_t>(field_id)],
+                            Conversions::ToBytes(bound));
+  }
+  return {};
+}
+
+}  // namespace
+
+ImportFiles::ImportFiles(std::shared_ptr<Table> table) : table_(std::move(table)) {}
+
+ImportFiles::~ImportFiles() = default;
+
+ImportFiles& ImportFiles::AddFile(std::string path, std::vector<Literal> partition,
+                                  std::optional<int64_t> file_size_in_bytes) {
+  files_.push_back(File{.path = std::move(path),
+                        .partition = std::move(partition),
+                        .file_size_in_bytes = file_size_in_bytes});
+  return *this;
+}
+
+ImportFiles& ImportFiles::WithFormat(FileFormatType format) {
+  format_ = format;
+  return *this;
+}
+
+ImportFiles& ImportFiles::WithNameMapping(std::shared_ptr<NameMapping> name_mapping) {
+  name_mapping_ = std::move(name_mapping);
+  return *this;
+}
+
+ImportFiles& ImportFiles::WithParallelism(int32_t parallelism) {
+  parallelism_ = parallelism;
+  return *this;
+}
+
+ImportFiles& ImportFiles::WithExecutor(std::shared_ptr<Executor> executor) {
+  executor_ = std::move(executor);
+  return *this;
+}
+
+ImportFiles& ImportFiles::Set(const std::string& property, const std::string& value) {
+  properties_[property] = value;
+  return *this;
+}
+
+Result<ImportFilesResult> ImportFiles::Execute() const {
+  if (parallelism_ < 1) {
+    return InvalidArgument("Parallelism must be positive, got {}", parallelism_);
+  }
+  ImportFilesResult result;
+  if (files_.empty()) {
+    return result;
+  }
+
+  const auto metadata = table_->metadata();
+  ICEBERG_ASSIGN_OR_RAISE(auto schema, metadata->Schema());
+  ICEBERG_ASSIGN_OR_RAISE(auto spec, metadata->PartitionSpec());
+  for (const auto& file : files_) {
+    if (file.partition.size() != spec->fields().size()) {
+      return InvalidArgument(
+          "Cannot import {} with {} partition values into partition spec {} with {} "
+          "fields",
+          file.path, file.partition.size(), spec->spec_id(), spec->fields().size());
+    }
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto metrics_config,
+                          MetricsConfig::Make(metadata->properties, *schema));
+  auto name_mapping = name_mapping_;
+  if (name_mapping == nullptr) {
+    ICEBERG_ASSIGN_OR_RAISE(name_mapping, DefaultNameMapping(*metadata));
+  }
+
+  // Reading a footer is mostly waiting for the storage, so the footers of many files
+  // are read at the same time.
+  std::vector<std::shared_ptr<DataFile>> data_files(files_.size());
+  auto read = [&](size_t index) -> Status {
+    const auto& file = files_[index];
+    FooterOptions options{
+        .path = file.path,
+        .io = table_->io(),
+        .schema = schema,
+        .name_mapping = name_mapping,
+        .metrics_config = metrics_config,
+    };
+    if (file.file_size_in_bytes.has_value()) {
+      options.length = static_cast<size_t>(*file.file_size_in_bytes);
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto footer, FooterReaderRegistry::Read(format_, options));
+    auto data_file = std::make_shared<DataFile>(DataFile{
+        .content = DataFile::Content::kData,
+        .file_path = file.path,
+        .file_format = format_,
+        .partition = file.partition,
+        .file_size_in_bytes = footer.length,
+        .split_offsets = std::move(footer.split_offsets),
+        .partition_spec_id = spec->spec_id(),
+    });
+    ICEBERG_RETURN_UNEXPECTED(SetMetrics(footer.metrics, *data_file));
+    data_files[index] = std::move(data_file);
+    return {};
+  };
+  const auto executor = executor_ != nullptr ? executor_ : DefaultExecutor();
+  ICEBERG_RETURN_UNEXPECTED(RunInParallel(*executor, files_.size(), parallelism_, read));
+
+  FastAppend append(table_);
+  for (const auto& [property, value] : properties_) {
+    append.Set(property, value);
+  }
+  for (auto& data_file : data_files) {
+    result.imported_records_count += data_file->record_count;
+    append.AppendFile(std::move(data_file));
+  }
+  ICEBERG_RETURN_UNEXPECTED(append.Commit());
+  result.imported_files_count = static_cast<int64_t>(files_.size());
+  result.snapshot_id = append.snapshot_id();
+  return result;
+}
+
+}  // namespace iceberg
@@ -0,0 +1,116 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/import_files.h
+/// Import of existing data files into a table.
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "iceberg/expression/literal.h"
+#include "iceberg/file_format.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief The outcome of an import of existing data files.
+struct ICEBERG_EXPORT ImportFilesResult {
+  /// \brief The number of imported data files.
+  int64_t imported_files_count = 0;
+  /// \brief The number of records of the imported data files.
+  int64_t imported_records_count = 0;
+  /// \brief The ID of the committed snapshot, if any file was imported.
+  std::optional<int64_t> snapshot_id;
+};
+
+/// \brief Adds existing data files to a table without rewriting them, such as the files
+/// of a Hive or Parquet dataset migrated to Iceberg.
+///
+/// The footers of the files are read with up to `parallelism` files in flight, and the
+/// metrics of each file are computed from the statistics of its footer without reading
+/// its data, following the `write.metadata.metrics.*` modes of the table. The columns
+/// of files written without field ids are matched to the table schema by a name
+/// mapping, the `schema.name-mapping.default` of the table unless one is set.
+///
+/// The files are committed by a single FastAppend, whose manifests are written up to
+/// `commit.manifest.write-parallelism` at a time. Files are not checked against the
+/// files of the table, so a file imported twice has its rows duplicated. Very large
+/// imports can be split into several imports to bound the memory of the data files.
+class ICEBERG_EXPORT ImportFiles {
+ public:
+  /// \brief Creates an import of files into a table.
+  ///
+  /// \param table The table to import into, which must have a catalog to commit to
+  explicit ImportFiles(std::shared_ptr<Table> table);
+
+  ~ImportFiles();
+
+  /// \brief Adds an existing data file of the default partition spec of the table.
+  ///
+  /// \param path The location of the file
+  /// \param partition The partition tuple of the file, empty for unpartitioned tables
+  /// \param file_size_in_bytes The size of the file if known, which saves a request to
+  /// the storage
+  ImportFiles& AddFile(std::string path, std::vector<Literal> partition = {},
+                       std::optional<int64_t> file_size_in_bytes = std::nullopt);
+
+  /// \brief Sets the format of the files, Parquet by default.
+  ImportFiles& WithFormat(FileFormatType format);
+
+  /// \brief Sets the name mapping of the columns of files without field ids.
+  ImportFiles& WithNameMapping(std::shared_ptr<NameMapping> name_mapping);
+
+  /// \brief Sets the number of footers read concurrently, 1 by default.
+  ImportFiles& WithParallelism(int32_t parallelism);
+
+  /// \brief Sets the executor reading the footers concurrently, the DefaultExecutor()
+  /// if null.
+  ImportFiles& WithExecutor(std::shared_ptr<Executor> executor);
+
+  /// \brief Sets a summary property of the new snapshot.
+  ImportFiles& Set(const std::string& property, const std::string& value);
+
+  /// \brief Reads the footers of the files and commits them to the table.
+  Result<ImportFilesResult> Execute() const;
+
+ private:
+  struct File {
+    std::string path;
+    std::vector<Literal> partition;
+    std::optional<int64_t> file_size_in_bytes;
+  };
+
+  std::shared_ptr<Table> table_;
+  std::vector<File> files_;
+  FileFormatType format_ = FileFormatType::kParquet;
+  std::shared_ptr<NameMapping> name_mapping_;
+  int32_t parallelism_ = 1;
+  std::shared_ptr<Executor> executor_;
+  std::unordered_map<std::string, std::string> properties_;
+};
+
+}  // namespace iceberg
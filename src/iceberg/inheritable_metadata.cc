@@ -31,11 +31,13 @@ namespace iceberg {
 
 BaseInheritableMetadata::BaseInheritableMetadata(int32_t spec_id, int64_t snapshot_id,
                                                  int64_t sequence_number,
-                                                 std::string manifest_location)
+                                                 std::string manifest_location,
+                                                 std::optional<int64_t> first_row_id)
     : spec_id_(spec_id),
       snapshot_id_(snapshot_id),
       sequence_number_(sequence_number),
-      manifest_location_(std::move(manifest_location)) {}
+      manifest_location_(std::move(manifest_location)),
+      next_row_id_(first_row_id) {}
 
 Status BaseInheritableMetadata::Apply(ManifestEntry& entry) {
   if (!entry.snapshot_id.has_value()) {
@@ -66,9 +68,26 @@ Status BaseInheritableMetadata::Apply(ManifestEntry& entry) {
     return InvalidManifest("Manifest entry has no data file");
   }
 
+  // In v3 metadata, live data files without a first row ID are assigned the next row
+  // IDs of the manifest.
+  auto& file = *entry.data_file;
+  if (entry.status != ManifestStatus::kDeleted &&
+      file.content == DataFile::Content::kData && !file.first_row_id.has_value()) {
+    file.first_row_id = AssignFirstRowId(file.record_count);
+  }
+
   return {};
 }
 
+std::optional<int64_t> BaseInheritableMetadata::AssignFirstRowId(int64_t record_count) {
+  if (!next_row_id_.has_value()) {
+    return std::nullopt;
+  }
+  const int64_t first_row_id = next_row_id_.value();
+  next_row_id_ = first_row_id + record_count;
+  return first_row_id;
+}
+
 Status EmptyInheritableMetadata::Apply(ManifestEntry& entry) {
   if (!entry.snapshot_id.has_value()) {
     return InvalidManifest(
@@ -98,7 +117,9 @@ Result<std::unique_ptr<InheritableMetadata>> InheritableMetadataFactory::FromMan
 
   return std::make_unique<BaseInheritableMetadata>(
       manifest.partition_spec_id, manifest.added_snapshot_id, manifest.sequence_number,
-      manifest.manifest_path);
+      manifest.manifest_path,
+      manifest.content == ManifestFile::Content::kData ? manifest.first_row_id
+                                                       : std::nullopt);
 }
 
 Result<std::unique_ptr<InheritableMetadata>> InheritableMetadataFactory::ForCopy(
@@ -24,6 +24,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "iceberg/iceberg_export.h"
@@ -45,6 +46,19 @@ class ICEBERG_EXPORT InheritableMetadata {
   /// \param entry The manifest entry to modify.
   /// \return Status indicating success or failure.
   virtual Status Apply(ManifestEntry& entry) = 0;
+
+  /// \brief Assigns the first row ID of a live data file that has none.
+  ///
+  /// Row IDs are assigned to such files in the order they are read, from the first row
+  /// ID of the manifest and the record counts of the previous ones. Reserving no
+  /// records returns the next row ID without assigning any.
+  ///
+  /// \param record_count The number of records of the file.
+  /// \return The first row ID of the file, or nullopt if the manifest does not assign
+  /// row IDs.
+  virtual std::optional<int64_t> AssignFirstRowId(int64_t record_count) {
+    return std::nullopt;
+  }
 };
 
 /// \brief Base implementation of InheritableMetadata that handles standard inheritance
@@ -56,16 +70,21 @@ class ICEBERG_EXPORT BaseInheritableMetadata : public InheritableMetadata {
   /// \param snapshot_id Snapshot ID from the manifest.
   /// \param sequence_number Sequence number from the manifest.
   /// \param manifest_location Path to the manifest file.
+  /// \param first_row_id First row ID of the data files of the manifest without one.
   BaseInheritableMetadata(int32_t spec_id, int64_t snapshot_id, int64_t sequence_number,
-                          std::string manifest_location);
+                          std::string manifest_location,
+                          std::optional<int64_t> first_row_id = std::nullopt);
 
   Status Apply(ManifestEntry& entry) override;
 
+  std::optional<int64_t> AssignFirstRowId(int64_t record_count) override;
+
  private:
   int32_t spec_id_;
   int64_t snapshot_id_;
   int64_t sequence_number_;
   std::string manifest_location_;
+  std::optional<int64_t> next_row_id_;
 };
 
 /// \brief Empty implementation that applies no inheritance.
@@ -0,0 +1,454 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/instrumented_file_io.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <format>
+#include <iterator>
+#include <unordered_set>
+
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Operation = InstrumentedFileIO::Operation;
+using FileCategory = InstrumentedFileIO::FileCategory;
+
+constexpr std::array<std::string_view, 4> kMetadataFileSuffixes = {
+    ".metadata.json", ".metadata.json.gz", ".gz.metadata.json", "version-hint.text"};
+constexpr std::array<std::string_view, 2> kDataFileSuffixes = {".parquet", ".orc"};
+
+bool HasSuffix(std::string_view name, std::span<const std::string_view> suffixes) {
+  return std::ranges::any_of(
+      suffixes, [&](std::string_view suffix) { return name.ends_with(suffix); });
+}
+
+}  // namespace
+
+/// \brief The atomic counters behind the statistics, shared by an InstrumentedFileIO
+/// and the files it opens.
+class FileIOStatsRecorder {
+ public:
+  /// \brief Records a call and its latency.
+  void Record(Operation operation, FileCategory category, bool ok, int64_t bytes,
+              Clock::time_point start) {
+    RecordRequest(operation, category, ok, bytes);
+    RecordLatency(operation, start);
+  }
+
+  void RecordRequest(Operation operation, FileCategory category, bool ok,
+                     int64_t bytes) {
+    auto& counters =
+        counters_[static_cast<size_t>(operation)][static_cast<size_t>(category)];
+    counters.requests.fetch_add(1, std::memory_order_relaxed);
+    if (!ok) {
+      counters.errors.fetch_add(1, std::memory_order_relaxed);
+    }
+    counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  void RecordLatency(Operation operation, Clock::time_point start) {
+    const auto nanos =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start)
+            .count();
+    const auto& bounds = InstrumentedFileIO::kLatencyBucketBoundsMicros;
+    const auto bucket = static_cast<size_t>(std::distance(
+        bounds.begin(), std::ranges::lower_bound(bounds, (nanos + 999) / 1000)));
+    auto& histogram = histograms_[static_cast<size_t>(operation)];
+    histogram.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    histogram.sum_nanos.fetch_add(nanos, std::memory_order_relaxed);
+  }
+
+  InstrumentedFileIO::Stats Snapshot() const {
+    InstrumentedFileIO::Stats stats;
+    for (size_t op = 0; op < InstrumentedFileIO::kOperationCount; ++op) {
+      for (size_t category = 0; category < InstrumentedFileIO::kFileCategoryCount;
+           ++category) {
+        const auto& counters = counters_[op][category];
+        stats.requests[op][category] = {
+            .requests = counters.requests.load(std::memory_order_relaxed),
+            .errors = counters.errors.load(std::memory_order_relaxed),
+            .bytes = counters.bytes.load(std::memory_order_relaxed)};
+      }
+      const auto& histogram = histograms_[op];
+      auto& latencies = stats.latencies[op];
+      for (size_t bucket = 0; bucket < InstrumentedFileIO::kLatencyBucketCount;
+           ++bucket) {
+        latencies.buckets[bucket] =
+            histogram.buckets[bucket].load(std::memory_order_relaxed);
+        latencies.count += latencies.buckets[bucket];
+      }
+      latencies.sum_nanos = histogram.sum_nanos.load(std::memory_order_relaxed);
+    }
+    return stats;
+  }
+
+  void Reset() {
+    for (auto& by_category : counters_) {
+      for (auto& counters : by_category) {
+        counters.requests.store(0, std::memory_order_relaxed);
+        counters.errors.store(0, std::memory_order_relaxed);
+        counters.bytes.store(0, std::memory_order_relaxed);
+      }
+    }
+    for (auto& histogram : histograms_) {
+      for (auto& bucket : histogram.buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+      }
+      histogram.sum_nanos.store(0, std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  struct Counters {
+    std::atomic<int64_t> requests{0};
+    std::atomic<int64_t> errors{0};
+    std::atomic<int64_t> bytes{0};
+  };
+
+  struct Histogram {
+    std::array<std::atomic<int64_t>, InstrumentedFileIO::kLatencyBucketCount> buckets{};
+    std::atomic<int64_t> sum_nanos{0};
+  };
+
+  std::array<std::array<Counters, InstrumentedFileIO::kFileCategoryCount>,
+             InstrumentedFileIO::kOperationCount>
+      counters_;
+  std::array<Histogram, InstrumentedFileIO::kOperationCount> histograms_;
+};
+
+namespace {
+
+class InstrumentedInputFile : public InputFile {
+ public:
+  InstrumentedInputFile(std::unique_ptr<InputFile> file,
+                        std::shared_ptr<FileIOStatsRecorder> recorder,
+                        FileCategory category)
+      : file_(std::move(file)), recorder_(std::move(recorder)), category_(category) {}
+
+  const std::string& location() const override { return file_->location(); }
+
+  Result<int64_t> Size() override { return file_->Size(); }
+
+  Result<int64_t> ReadAt(int64_t offset, std::span<uint8_t> out) override {
+    const auto start = Clock::now();
+    auto read = file_->ReadAt(offset, out);
+    recorder_->Record(Operation::kRead, category_, read.has_value(),
+                      read.value_or(0), start);
+    return read;
+  }
+
+  Status ReadRanges(std::span<const ReadRange> ranges) override {
+    const auto start = Clock::now();
+    auto status = file_->ReadRanges(ranges);
+    int64_t bytes = 0;
+    if (status.has_value()) {
+      for (const auto& range : ranges) {
+        bytes += static_cast<int64_t>(range.out.size());
+      }
+    }
+    recorder_->Record(Operation::kRead, category_, status.has_value(), bytes, start);
+    return status;
+  }
+
+  Status Close() override { return file_->Close(); }
+
+ private:
+  std::unique_ptr<InputFile> file_;
+  std::shared_ptr<FileIOStatsRecorder> recorder_;
+  FileCategory category_;
+};
+
+class InstrumentedOutputFile : public OutputFile {
+ public:
+  InstrumentedOutputFile(std::unique_ptr<OutputFile> file,
+                         std::shared_ptr<FileIOStatsRecorder> recorder,
+                         FileCategory category)
+      : file_(std::move(file)), recorder_(std::move(recorder)), category_(category) {}
+
+  const std::string& location() const override { return file_->location(); }
+
+  Status Write(std::string_view data) override {
+    const auto start = Clock::now();
+    auto status = file_->Write(data);
+    recorder_->Record(Operation::kWrite, category_, status.has_value(),
+                      status.has_value() ? static_cast<int64_t>(data.size()) : 0,
+                      start);
+    return status;
+  }
+
+  Result<int64_t> Position() const override { return file_->Position(); }
+
+  Status Flush() override { return file_->Flush(); }
+
+  Status Close() override { return file_->Close(); }
+
+ private:
+  std::unique_ptr<OutputFile> file_;
+  std::shared_ptr<FileIOStatsRecorder> recorder_;
+  FileCategory category_;
+};
+
+}  // namespace
+
+InstrumentedFileIO::RequestStats InstrumentedFileIO::Stats::Total(
+    Operation operation) const {
+  RequestStats total;
+  for (const auto& stats : requests[static_cast<size_t>(operation)]) {
+    total.requests += stats.requests;
+    total.errors += stats.errors;
+    total.bytes += stats.bytes;
+  }
+  return total;
+}
+
+std::string InstrumentedFileIO::Stats::ToPrometheus(std::string_view prefix) const {
+  std::string out;
+  auto append_counter = [&](std::string_view name, std::string_view help,
+                            int64_t RequestStats::* field) {
+    std::format_to(std::back_inserter(out), "# HELP {}_{} {}\n# TYPE {}_{} counter\n",
+                   prefix, name, help, prefix, name);
+    for (size_t op = 0; op < kOperationCount; ++op) {
+      for (size_t category = 0; category < kFileCategoryCount; ++category) {
+        std::format_to(std::back_inserter(out),
+                       "{}_{}{{operation=\"{}\",category=\"{}\"}} {}\n", prefix, name,
+                       ToString(static_cast<Operation>(op)),
+                       ToString(static_cast<FileCategory>(category)),
+                       requests[op][category].*field);
+      }
+    }
+  };
+  append_counter("requests_total", "Number of FileIO calls.", &RequestStats::requests);
+  append_counter("errors_total", "Number of FileIO calls that failed.",
+                 &RequestStats::errors);
+  append_counter("bytes_total", "Number of bytes read or written.",
+                 &RequestStats::bytes);
+
+  std::format_to(std::back_inserter(out),
+                 "# HELP {}_latency_seconds Latency of FileIO calls.\n"
+                 "# TYPE {}_latency_seconds histogram\n",
+                 prefix, prefix);
+  for (size_t op = 0; op < kOperationCount; ++op) {
+    const auto name = ToString(static_cast<Operation>(op));
+    const auto& histogram = latencies[op];
+    int64_t cumulative = 0;
+    for (size_t bucket = 0; bucket < kLatencyBucketBoundsMicros.size(); ++bucket) {
+      cumulative += histogram.buckets[bucket];
+      std::format_to(std::back_inserter(out),
+                     "{}_latency_seconds_bucket{{operation=\"{}\",le=\"{:g}\"}} {}\n",
+                     prefix, name,
+                     static_cast<double>(kLatencyBucketBoundsMicros[bucket]) / 1e6,
+                     cumulative);
+    }
+    std::format_to(std::back_inserter(out),
+                   "{}_latency_seconds_bucket{{operation=\"{}\",le=\"+Inf\"}} {}\n"
+                   "{}_latency_seconds_sum{{operation=\"{}\"}} {}\n"
+                   "{}_latency_seconds_count{{operation=\"{}\"}} {}\n",
+                   prefix, name, histogram.count, prefix, name,
+                   static_cast<double>(histogram.sum_nanos) / 1e9, prefix, name,
+                   histogram.count);
+  }
+  return out;
+}
+
+InstrumentedFileIO::InstrumentedFileIO(std::shared_ptr<FileIO> file_io,
+                                       std::shared_ptr<FileIOStatsRecorder> recorder,
+                                       Options options)
+    : file_io_(std::move(file_io)),
+      recorder_(std::move(recorder)),
+      options_(std::move(options)) {}
+
+InstrumentedFileIO::~InstrumentedFileIO() = default;
+
+Result<std::shared_ptr<InstrumentedFileIO>> InstrumentedFileIO::Make(
+    std::shared_ptr<FileIO> file_io, Options options) {
+  if (file_io == nullptr) {
+    return InvalidArgument("FileIO to instrument must not be null");
+  }
+  return std::shared_ptr<InstrumentedFileIO>(
+      new InstrumentedFileIO(std::move(file_io), std::make_shared<FileIOStatsRecorder>(),
+                             std::move(options)));
+}
+
+InstrumentedFileIO::FileCategory InstrumentedFileIO::ClassifyFile(
+    std::string_view file_location) {
+  // Only the file name matters, the directories of a table are configurable.
+  const auto name = file_location.substr(file_location.find_last_of('/') + 1);
+  if (HasSuffix(name, kMetadataFileSuffixes)) {
+    return FileCategory::kMetadata;
+  }
+  if (name.ends_with(".avro")) {
+    return name.starts_with("snap-") ? FileCategory::kManifestList
+                                     : FileCategory::kManifest;
+  }
+  if (name.ends_with(".puffin") || name.find("-deletes.") != std::string_view::npos) {
+    return FileCategory::kDelete;
+  }
+  if (HasSuffix(name, kDataFileSuffixes)) {
+    return FileCategory::kData;
+  }
+  return FileCategory::kOther;
+}
+
+InstrumentedFileIO::FileCategory InstrumentedFileIO::Classify(
+    std::string_view file_location) const {
+  return options_.classifier ? options_.classifier(file_location)
+                             : ClassifyFile(file_location);
+}
+
+Result<std::string> InstrumentedFileIO::ReadFile(const std::string& file_location,
+                                                 std::optional<size_t> length) {
+  const auto start = Clock::now();
+  auto content = file_io_->ReadFile(file_location, length);
+  recorder_->Record(Operation::kRead, Classify(file_location), content.has_value(),
+                    content.has_value() ? static_cast<int64_t>(content->size()) : 0,
+                    start);
+  return content;
+}
+
+Status InstrumentedFileIO::WriteFile(const std::string& file_location,
+                                     std::string_view content) {
+  const auto start = Clock::now();
+  auto status = file_io_->WriteFile(file_location, content);
+  recorder_->Record(Operation::kWrite, Classify(file_location), status.has_value(),
+                    status.has_value() ? static_cast<int64_t>(content.size()) : 0,
+                    start);
+  return status;
+}
+
+Status InstrumentedFileIO::WriteFileIfAbsent(const std::string& file_location,
+                                             std::string_view content) {
+  const auto start = Clock::now();
+  auto status = file_io_->WriteFileIfAbsent(file_location, content);
+  recorder_->Record(Operation::kWrite, Classify(file_location), status.has_value(),
+                    status.has_value() ? static_cast<int64_t>(content.size()) : 0,
+                    start);
+  return status;
+}
+
+Result<bool> InstrumentedFileIO::FileExists(const std::string& file_location) {
+  const auto start = Clock::now();
+  auto exists = file_io_->FileExists(file_location);
+  recorder_->Record(Operation::kOpen, Classify(file_location), exists.has_value(), 0,
+                    start);
+  return exists;
+}
+
+Result<std::unique_ptr<InputFile>> InstrumentedFileIO::NewInputFile(
+    const std::string& file_location, std::optional<size_t> length) {
+  const auto category = Classify(file_location);
+  const auto start = Clock::now();
+  auto file = file_io_->NewInputFile(file_location, length);
+  recorder_->Record(Operation::kOpen, category, file.has_value(), 0, start);
+  ICEBERG_RETURN_UNEXPECTED(file);
+  return std::make_unique<InstrumentedInputFile>(std::move(file).value(), recorder_,
+                                                 category);
+}
+
+Result<std::unique_ptr<OutputFile>> InstrumentedFileIO::NewOutputFile(
+    const std::string& file_location) {
+  const auto category = Classify(file_location);
+  const auto start = Clock::now();
+  auto file = file_io_->NewOutputFile(file_location);
+  recorder_->Record(Operation::kOpen, category, file.has_value(), 0, start);
+  ICEBERG_RETURN_UNEXPECTED(file);
+  return std::make_unique<InstrumentedOutputFile>(std::move(file).value(), recorder_,
+                                                  category);
+}
+
+Status InstrumentedFileIO::DeleteFile(const std::string& file_location) {
+  const auto start = Clock::now();
+  auto status = file_io_->DeleteFile(file_location);
+  recorder_->Record(Operation::kDelete, Classify(file_location), status.has_value(), 0,
+                    start);
+  return status;
+}
+
+std::vector<FileDeleteFailure> InstrumentedFileIO::DeleteFiles(
+    std::span<const std::string> file_locations) {
+  const auto start = Clock::now();
+  auto failures = file_io_->DeleteFiles(file_locations);
+  recorder_->RecordLatency(Operation::kDelete, start);
+  std::unordered_set<std::string_view> failed;
+  for (const auto& failure : failures) {
+    failed.insert(failure.file_location);
+  }
+  for (const auto& file_location : file_locations) {
+    recorder_->RecordRequest(Operation::kDelete, Classify(file_location),
+                             !failed.contains(file_location), 0);
+  }
+  return failures;
+}
+
+Status InstrumentedFileIO::ListFiles(
+    const std::string& prefix, const std::function<Status(const FileInfo&)>& visitor) {
+  const auto start = Clock::now();
+  auto status = file_io_->ListFiles(prefix, visitor);
+  recorder_->Record(Operation::kList, FileCategory::kOther, status.has_value(), 0,
+                    start);
+  return status;
+}
+
+InstrumentedFileIO::Stats InstrumentedFileIO::stats() const {
+  return recorder_->Snapshot();
+}
+
+void InstrumentedFileIO::ResetStats() { recorder_->Reset(); }
+
+std::string_view ToString(InstrumentedFileIO::Operation operation) {
+  switch (operation) {
+    case InstrumentedFileIO::Operation::kOpen:
+      return "open";
+    case InstrumentedFileIO::Operation::kRead:
+      return "read";
+    case InstrumentedFileIO::Operation::kWrite:
+      return "write";
+    case InstrumentedFileIO::Operation::kDelete:
+      return "delete";
+    case InstrumentedFileIO::Operation::kList:
+      return "list";
+  }
+  return "unknown";
+}
+
+std::string_view ToString(InstrumentedFileIO::FileCategory category) {
+  switch (category) {
+    case InstrumentedFileIO::FileCategory::kMetadata:
+      return "metadata";
+    case InstrumentedFileIO::FileCategory::kManifestList:
+      return "manifest_list";
+    case InstrumentedFileIO::FileCategory::kManifest:
+      return "manifest";
+    case InstrumentedFileIO::FileCategory::kData:
+      return "data";
+    case InstrumentedFileIO::FileCategory::kDelete:
+      return "delete";
+    case InstrumentedFileIO::FileCategory::kOther:
+      return "other";
+  }
+  return "unknown";
+}
+
+}  // namespace iceberg
@@ -0,0 +1,204 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/instrumented_file_io.h
+/// FileIO decorator counting requests, bytes and latencies.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "iceberg/file_io.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+
+namespace iceberg {
+
+class FileIOStatsRecorder;
+
+/// \brief A FileIO that records statistics of the requests made through another
+/// FileIO.
+///
+/// Every call is counted once, by operation and by category of the file it is made
+/// for, with the number of bytes read or written and whether it failed. The latency
+/// of every call is added to a histogram of its operation. A vectored read counts as a
+/// single request, and the files of DeleteFiles are counted one by one while the
+/// batch is a single latency observation.
+///
+/// Statistics are recorded with relaxed atomic counters, so a FileIO can be shared by
+/// threads, and read as a consistent-enough snapshot with stats(), e.g. to export
+/// them to a monitoring system with Stats::ToPrometheus().
+class ICEBERG_EXPORT InstrumentedFileIO : public FileIO {
+ public:
+  /// \brief The kinds of calls that are counted.
+  enum class Operation : uint8_t {
+    /// \brief NewInputFile, NewOutputFile and FileExists.
+    kOpen,
+    /// \brief ReadFile and the reads of input files.
+    kRead,
+    /// \brief WriteFile, WriteFileIfAbsent and the writes of output files.
+    kWrite,
+    /// \brief DeleteFile and DeleteFiles, counted per file.
+    kDelete,
+    /// \brief ListFiles.
+    kList,
+  };
+  static constexpr size_t kOperationCount = 5;
+
+  /// \brief The kinds of files a call is made for, derived from their location.
+  enum class FileCategory : uint8_t {
+    /// \brief Table metadata files and version hints.
+    kMetadata,
+    /// \brief Manifest lists, `snap-*.avro`.
+    kManifestList,
+    /// \brief Other Avro files, which are manifests.
+    kManifest,
+    /// \brief Data files.
+    kData,
+    /// \brief Puffin files and files named like delete files, `*-deletes.*`.
+    kDelete,
+    /// \brief Anything else, such as the prefixes of ListFiles.
+    kOther,
+  };
+  static constexpr size_t kFileCategoryCount = 6;
+
+  /// \brief The upper bounds in microseconds of the latency histogram buckets. The
+  /// last bucket holds the latencies above the last bound.
+  static constexpr std::array<int64_t, 14> kLatencyBucketBoundsMicros = {
+      100,    250,    500,     1'000,   2'500,   5'000,     10'000,
+      25'000, 50'000, 100'000, 250'000, 500'000, 1'000'000, 5'000'000};
+  static constexpr size_t kLatencyBucketCount = kLatencyBucketBoundsMicros.size() + 1;
+
+  /// \brief Counters of the calls of an operation on a category of files.
+  struct RequestStats {
+    /// \brief Number of calls.
+    int64_t requests = 0;
+    /// \brief Number of calls that returned an error.
+    int64_t errors = 0;
+    /// \brief Number of bytes read or written.
+    int64_t bytes = 0;
+  };
+
+  /// \brief The distribution of the latencies of the calls of an operation.
+  struct LatencyHistogram {
+    /// \brief Number of latencies in each bucket, not cumulative.
+    std::array<int64_t, kLatencyBucketCount> buckets{};
+    /// \brief Number of latencies recorded.
+    int64_t count = 0;
+    /// \brief Sum of the latencies recorded, in nanoseconds.
+    int64_t sum_nanos = 0;
+  };
+
+  /// \brief A snapshot of the statistics.
+  struct ICEBERG_EXPORT Stats {
+    /// \brief Counters indexed by operation, then by file category.
+    std::array<std::array<RequestStats, kFileCategoryCount>, kOperationCount> requests{};
+    /// \brief Latency histograms indexed by operation.
+    std::array<LatencyHistogram, kOperationCount> latencies{};
+
+    /// \brief Returns the counters of an operation on a category of files.
+    const RequestStats& Get(Operation operation, FileCategory category) const {
+      return requests[static_cast<size_t>(operation)][static_cast<size_t>(category)];
+    }
+
+    /// \brief Returns the counters of an operation summed over all categories.
+    RequestStats Total(Operation operation) const;
+
+    /// \brief Formats the statistics in the Prometheus text exposition format.
+    ///
+    /// \param prefix The prefix of the metric names
+    std::string ToPrometheus(std::string_view prefix = "iceberg_file_io") const;
+  };
+
+  /// \brief Configuration of the instrumentation.
+  struct Options {
+    /// \brief Returns the category of a file location. ClassifyFile if not set.
+    std::function<FileCategory(std::string_view)> classifier;
+  };
+
+  ~InstrumentedFileIO() override;
+
+  /// \brief Creates a FileIO recording the statistics of the calls to `file_io`.
+  ///
+  /// \param file_io The FileIO making the requests
+  /// \param options The configuration of the instrumentation
+  /// \return A Result containing the FileIO, or an error if `file_io` is null.
+  static Result<std::shared_ptr<InstrumentedFileIO>> Make(std::shared_ptr<FileIO> file_io,
+                                                          Options options = {});
+
+  /// \brief Returns the category of a file from the naming conventions of Iceberg.
+  static FileCategory ClassifyFile(std::string_view file_location);
+
+  Result<std::string> ReadFile(const std::string& file_location,
+                               std::optional<size_t> length) override;
+
+  Status WriteFile(const std::string& file_location, std::string_view content) override;
+
+  Status WriteFileIfAbsent(const std::string& file_location,
+                           std::string_view content) override;
+
+  Result<bool> FileExists(const std::string& file_location) override;
+
+  Result<std::unique_ptr<InputFile>> NewInputFile(const std::string& file_location,
+                                                  std::optional<size_t> length) override;
+
+  Result<std::unique_ptr<OutputFile>> NewOutputFile(
+      const std::string& file_location) override;
+
+  Status DeleteFile(const std::string& file_location) override;
+
+  std::vector<FileDeleteFailure> DeleteFiles(
+      std::span<const std::string> file_locations) override;
+
+  Status ListFiles(const std::string& prefix,
+                   const std::function<Status(const FileInfo&)>& visitor) override;
+
+  /// \brief Returns a snapshot of the statistics.
+  Stats stats() const;
+
+  /// \brief Resets all statistics to zero.
+  void ResetStats();
+
+ private:
+  InstrumentedFileIO(std::shared_ptr<FileIO> file_io,
+                     std::shared_ptr<FileIOStatsRecorder> recorder, Options options);
+
+  FileCategory Classify(std::string_view file_location) const;
+
+  std::shared_ptr<FileIO> file_io_;
+  std::shared_ptr<FileIOStatsRecorder> recorder_;
+  Options options_;
+};
+
+/// \brief Returns the name of an operation, e.g. "read".
+ICEBERG_EXPORT std::string_view ToString(InstrumentedFileIO::Operation operation);
+
+/// \brief Returns the name of a file category, e.g. "manifest_list".
+ICEBERG_EXPORT std::string_view ToString(InstrumentedFileIO::FileCategory category);
+
+}  // namespace iceberg
@@ -22,12 +22,18 @@
 #include <algorithm>
 #include <cstdint>
 #include <format>
+#include <istream>
 #include <regex>
+#include <string_view>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
 #include <nlohmann/json.hpp>
 
+#include "iceberg/compact_snapshots.h"
+#include "iceberg/file_io.h"
+#include "iceberg/metadata_intern_pool.h"
 #include "iceberg/name_mapping.h"
 #include "iceberg/partition_field.h"
 #include "iceberg/partition_spec.h"
@@ -42,6 +48,7 @@
 #include "iceberg/type.h"
 #include "iceberg/util/formatter.h"  // IWYU pragma: keep
 #include "iceberg/util/json_util_internal.h"
+#include "iceberg/util/json_writer_internal.h"
 #include "iceberg/util/macros.h"
 #include "iceberg/util/timepoint.h"
 
@@ -93,6 +100,8 @@ constexpr std::string_view kSequenceNumber = "sequence-number";
 constexpr std::string_view kTimestampMs = "timestamp-ms";
 constexpr std::string_view kManifestList = "manifest-list";
 constexpr std::string_view kSummary = "summary";
+constexpr std::string_view kFirstRowId = "first-row-id";
+constexpr std::string_view kAddedRows = "added-rows";
 constexpr std::string_view kMinSnapshotsToKeep = "min-snapshots-to-keep";
 constexpr std::string_view kMaxSnapshotAgeMs = "max-snapshot-age-ms";
 constexpr std::string_view kMaxRefAgeMs = "max-ref-age-ms";
@@ -298,6 +307,8 @@ nlohmann::json ToJson(const Type& type) {
     }
     case TypeId::kUuid:
       return "uuid";
+    case TypeId::kVariant:
+      return "variant";
   }
   std::unreachable();
 }
@@ -343,6 +354,8 @@ nlohmann::json ToJson(const Snapshot& snapshot) {
     json[kSummary] = snapshot.summary;
   }
   SetOptionalField(json, kSchemaId, snapshot.schema_id);
+  SetOptionalField(json, kFirstRowId, snapshot.first_row_id);
+  SetOptionalField(json, kAddedRows, snapshot.added_rows);
   return json;
 }
 
@@ -417,6 +430,8 @@ Result<std::unique_ptr<Type>> TypeFromJson(const nlohmann::json& json) {
       return std::make_unique<BinaryType>();
     } else if (type_str == "uuid") {
       return std::make_unique<UuidType>();
+    } else if (type_str == "variant") {
+      return std::make_unique<VariantType>();
     } else if (type_str.starts_with("fixed")) {
       std::regex fixed_regex(R"(fixed\[\s*(\d+)\s*\])");
       std::smatch match;
@@ -594,11 +609,15 @@ Result<std::unique_ptr<Snapshot>> SnapshotFromJson(const nlohmann::json& json) {
   }
 
   ICEBERG_ASSIGN_OR_RAISE(auto schema_id, GetJsonValueOptional<int32_t>(json, kSchemaId));
+  ICEBERG_ASSIGN_OR_RAISE(auto first_row_id,
+                          GetJsonValueOptional<int64_t>(json, kFirstRowId));
+  ICEBERG_ASSIGN_OR_RAISE(auto added_rows,
+                          GetJsonValueOptional<int64_t>(json, kAddedRows));
 
   return std::make_unique<Snapshot>(
       snapshot_id, parent_snapshot_id,
       sequence_number.value_or(TableMetadata::kInitialSequenceNumber), timestamp_ms,
-      manifest_list, std::move(summary), schema_id);
+      manifest_list, std::move(summary), schema_id, first_row_id, added_rows);
 }
 
 nlohmann::json ToJson(const BlobMetadata& blob_metadata) {
@@ -771,9 +790,7 @@ nlohmann::json ToJson(const TableMetadata& table_metadata) {
   // write properties map
   json[kProperties] = table_metadata.properties;
 
-  if (std::ranges::find_if(table_metadata.snapshots, [&](const auto& snapshot) {
-        return snapshot->snapshot_id == table_metadata.current_snapshot_id;
-      }) != table_metadata.snapshots.cend()) {
+  if (table_metadata.HasSnapshot(table_metadata.current_snapshot_id)) {
     json[kCurrentSnapshotId] = table_metadata.current_snapshot_id;
   } else {
     json[kCurrentSnapshotId] = nlohmann::json::value_t::null;
@@ -785,6 +802,13 @@ nlohmann::json ToJson(const TableMetadata& table_metadata) {
 
   json[kRefs] = ToJsonMap(table_metadata.refs);
   json[kSnapshots] = ToJsonList(table_metadata.snapshots);
+  if (const auto& compact = table_metadata.compact_snapshots; compact != nullptr) {
+    // The JSON of compact snapshots is kept as is, without materializing them.
+    for (size_t pos = 0; pos < compact->size(); ++pos) {
+      json[kSnapshots].push_back(nlohmann::json::parse(compact->json(pos), /*cb=*/nullptr,
+                                                       /*allow_exceptions=*/false));
+    }
+  }
   json[kStatistics] = ToJsonList(table_metadata.statistics);
   json[kPartitionStatistics] = ToJsonList(table_metadata.partition_statistics);
   json[kSnapshotLog] = ToJsonList(table_metadata.snapshot_log);
@@ -799,6 +823,287 @@ Result<std::string> ToJsonString(const TableMetadata& table_metadata) {
 
 namespace {
 
+// The streaming counterparts of the ToJson functions above, for the parts of the table
+// metadata that grow with its history.
+
+template <typename T>
+void WriteOptionalField(JsonWriter& writer, std::string_view key,
+                        const std::optional<T>& value) {
+  if (value.has_value()) {
+    writer.Key(key);
+    writer.Int(*value);
+  }
+}
+
+void WriteJson(JsonWriter& writer,
+               const std::unordered_map<std::string, std::string>& string_map) {
+  writer.StartObject();
+  for (const auto& [key, value] : string_map) {
+    writer.Key(key);
+    writer.String(value);
+  }
+  writer.EndObject();
+}
+
+void WriteJson(JsonWriter& writer, const SnapshotRef& ref) {
+  writer.StartObject();
+  writer.Key(kSnapshotId);
+  writer.Int(ref.snapshot_id);
+  writer.Key(kType);
+  writer.String(std::format("{}", ref.type()));
+  if (ref.type() == SnapshotRefType::kBranch) {
+    const auto& branch = std::get<SnapshotRef::Branch>(ref.retention);
+    WriteOptionalField(writer, kMinSnapshotsToKeep, branch.min_snapshots_to_keep);
+    WriteOptionalField(writer, kMaxSnapshotAgeMs, branch.max_snapshot_age_ms);
+    WriteOptionalField(writer, kMaxRefAgeMs, branch.max_ref_age_ms);
+  } else if (ref.type() == SnapshotRefType::kTag) {
+    const auto& tag = std::get<SnapshotRef::Tag>(ref.retention);
+    WriteOptionalField(writer, kMaxRefAgeMs, tag.max_ref_age_ms);
+  }
+  writer.EndObject();
+}
+
+void WriteJson(JsonWriter& writer, const Snapshot& snapshot) {
+  writer.StartObject();
+  writer.Key(kSnapshotId);
+  writer.Int(snapshot.snapshot_id);
+  WriteOptionalField(writer, kParentSnapshotId, snapshot.parent_snapshot_id);
+  if (snapshot.sequence_number > TableMetadata::kInitialSequenceNumber) {
+    writer.Key(kSequenceNumber);
+    writer.Int(snapshot.sequence_number);
+  }
+  writer.Key(kTimestampMs);
+  writer.Int(UnixMsFromTimePointMs(snapshot.timestamp_ms));
+  writer.Key(kManifestList);
+  writer.String(snapshot.manifest_list);
+  // If there is an operation, write the summary map
+  if (snapshot.operation().has_value()) {
+    writer.Key(kSummary);
+    WriteJson(writer, snapshot.summary);
+  }
+  WriteOptionalField(writer, kSchemaId, snapshot.schema_id);
+  WriteOptionalField(writer, kFirstRowId, snapshot.first_row_id);
+  WriteOptionalField(writer, kAddedRows, snapshot.added_rows);
+  writer.EndObject();
+}
+
+void WriteJson(JsonWriter& writer, const BlobMetadata& blob_metadata) {
+  writer.StartObject();
+  writer.Key(kType);
+  writer.String(blob_metadata.type);
+  writer.Key(kSnapshotId);
+  writer.Int(blob_metadata.source_snapshot_id);
+  writer.Key(kSequenceNumber);
+  writer.Int(blob_metadata.source_snapshot_sequence_number);
+  writer.Key(kFields);
+  writer.StartArray();
+  for (int32_t field_id : blob_metadata.fields) {
+    writer.Int(field_id);
+  }
+  writer.EndArray();
+  if (!blob_metadata.properties.empty()) {
+    writer.Key(kProperties);
+    WriteJson(writer, blob_metadata.properties);
+  }
+  writer.EndObject();
+}
+
+void WriteJson(JsonWriter& writer, const StatisticsFile& statistics_file) {
+  writer.StartObject();
+  writer.Key(kSnapshotId);
+  writer.Int(statistics_file.snapshot_id);
+  writer.Key(kStatisticsPath);
+  writer.String(statistics_file.path);
+  writer.Key(kFileSizeInBytes);
+  writer.Int(statistics_file.file_size_in_bytes);
+  writer.Key(kFileFooterSizeInBytes);
+  writer.Int(statistics_file.file_footer_size_in_bytes);
+  writer.Key(kBlobMetadata);
+  writer.StartArray();
+  for (const auto& blob_metadata : statistics_file.blob_metadata) {
+    WriteJson(writer, blob_metadata);
+  }
+  writer.EndArray();
+  writer.EndObject();
+}
+
+void WriteJson(JsonWriter& writer,
+               const PartitionStatisticsFile& partition_statistics_file) {
+  writer.StartObject();
+  writer.Key(kSnapshotId);
+  writer.Int(partition_statistics_file.snapshot_id);
+  writer.Key(kStatisticsPath);
+  writer.String(partition_statistics_file.path);
+  writer.Key(kFileSizeInBytes);
+  writer.Int(partition_statistics_file.file_size_in_bytes);
+  writer.EndObject();
+}
+
+void WriteJson(JsonWriter& writer, const SnapshotLogEntry& snapshot_log_entry) {
+  writer.StartObject();
+  writer.Key(kTimestampMs);
+  writer.Int(UnixMsFromTimePointMs(snapshot_log_entry.timestamp_ms));
+  writer.Key(kSnapshotId);
+  writer.Int(snapshot_log_entry.snapshot_id);
+  writer.EndObject();
+}
+
+void WriteJson(JsonWriter& writer, const MetadataLogEntry& metadata_log_entry) {
+  writer.StartObject();
+  writer.Key(kTimestampMs);
+  writer.Int(UnixMsFromTimePointMs(metadata_log_entry.timestamp_ms));
+  writer.Key(kMetadataFile);
+  writer.String(metadata_log_entry.metadata_file);
+  writer.EndObject();
+}
+
+template <typename T>
+const T& Deref(const T& item) {
+  return item;
+}
+
+template <typename T>
+const T& Deref(const std::shared_ptr<T>& item) {
+  return *item;
+}
+
+/// \brief Writes a list of items with WriteJson, as a JSON array.
+template <typename List>
+void WriteJsonList(JsonWriter& writer, const List& list) {
+  writer.StartArray();
+  for (const auto& item : list) {
+    WriteJson(writer, Deref(item));
+  }
+  writer.EndArray();
+}
+
+/// \brief Writes a list of items with ToJson, as a JSON array.
+///
+/// The JSON tree of one item is built at a time, for the items that stay small, e.g.
+/// schemas and partition specs.
+template <typename List>
+void WriteJsonTreeList(JsonWriter& writer, const List& list) {
+  writer.StartArray();
+  for (const auto& item : list) {
+    writer.Value(ToJson(Deref(item)));
+  }
+  writer.EndArray();
+}
+
+}  // namespace
+
+Status WriteJson(const TableMetadata& table_metadata, OutputFile& file) {
+  JsonWriter writer(file);
+  writer.StartObject();
+
+  writer.Key(kFormatVersion);
+  writer.Int(table_metadata.format_version);
+  writer.Key(kTableUuid);
+  writer.String(table_metadata.table_uuid);
+  writer.Key(kLocation);
+  writer.String(table_metadata.location);
+  if (table_metadata.format_version > 1) {
+    writer.Key(kLastSequenceNumber);
+    writer.Int(table_metadata.last_sequence_number);
+  }
+  writer.Key(kLastUpdatedMs);
+  writer.Int(UnixMsFromTimePointMs(table_metadata.last_updated_ms));
+  writer.Key(kLastColumnId);
+  writer.Int(table_metadata.last_column_id);
+
+  // for older readers, continue writing the current schema as "schema".
+  if (table_metadata.format_version == 1) {
+    for (const auto& schema : table_metadata.schemas) {
+      if (schema->schema_id() == table_metadata.current_schema_id) {
+        writer.Key(kSchema);
+        writer.Value(ToJson(*schema));
+        break;
+      }
+    }
+  }
+
+  // write the current schema ID and schema list
+  WriteOptionalField(writer, kCurrentSchemaId, table_metadata.current_schema_id);
+  writer.Key(kSchemas);
+  WriteJsonTreeList(writer, table_metadata.schemas);
+
+  // for older readers, continue writing the default spec as "partition-spec"
+  if (table_metadata.format_version == 1) {
+    for (const auto& partition_spec : table_metadata.partition_specs) {
+      if (partition_spec->spec_id() == table_metadata.default_spec_id) {
+        writer.Key(kPartitionSpec);
+        writer.Value(ToJson(*partition_spec));
+        break;
+      }
+    }
+  }
+
+  // write the default spec ID and spec list
+  writer.Key(kDefaultSpecId);
+  writer.Int(table_metadata.default_spec_id);
+  writer.Key(kPartitionSpecs);
+  WriteJsonTreeList(writer, table_metadata.partition_specs);
+  writer.Key(kLastPartitionId);
+  writer.Int(table_metadata.last_partition_id);
+
+  // write the default order ID and sort order list
+  writer.Key(kDefaultSortOrderId);
+  writer.Int(table_metadata.default_sort_order_id);
+  writer.Key(kSortOrders);
+  WriteJsonTreeList(writer, table_metadata.sort_orders);
+
+  // write properties map
+  writer.Key(kProperties);
+  WriteJson(writer, table_metadata.properties);
+
+  writer.Key(kCurrentSnapshotId);
+  if (table_metadata.HasSnapshot(table_metadata.current_snapshot_id)) {
+    writer.Int(table_metadata.current_snapshot_id);
+  } else {
+    writer.Null();
+  }
+
+  if (table_metadata.format_version >= 3) {
+    writer.Key(kNextRowId);
+    writer.Int(table_metadata.next_row_id);
+  }
+
+  writer.Key(kRefs);
+  writer.StartObject();
+  for (const auto& [name, ref] : table_metadata.refs) {
+    writer.Key(name);
+    WriteJson(writer, *ref);
+  }
+  writer.EndObject();
+
+  writer.Key(kSnapshots);
+  writer.StartArray();
+  for (const auto& snapshot : table_metadata.snapshots) {
+    WriteJson(writer, *snapshot);
+  }
+  if (const auto& compact = table_metadata.compact_snapshots; compact != nullptr) {
+    // The JSON of compact snapshots is copied as is, without materializing them.
+    for (size_t pos = 0; pos < compact->size(); ++pos) {
+      writer.RawValue(compact->json(pos));
+    }
+  }
+  writer.EndArray();
+
+  writer.Key(kStatistics);
+  WriteJsonList(writer, table_metadata.statistics);
+  writer.Key(kPartitionStatistics);
+  WriteJsonList(writer, table_metadata.partition_statistics);
+  writer.Key(kSnapshotLog);
+  WriteJsonList(writer, table_metadata.snapshot_log);
+  writer.Key(kMetadataLog);
+  WriteJsonList(writer, table_metadata.metadata_log);
+
+  writer.EndObject();
+  return writer.Finish();
+}
+
+namespace {
+
 /// \brief Parse the schemas from the JSON object.
 ///
 /// \param[in] json The JSON object to parse.
@@ -1054,6 +1359,176 @@ Result<std::unique_ptr<TableMetadata>> TableMetadataFromJson(const nlohmann::jso
   return table_metadata;
 }
 
+namespace {
+
+/// \brief The top-level lists of table metadata that are converted while parsing.
+enum class StreamedList : uint8_t {
+  kNone,
+  kSnapshots,
+  kSnapshotLog,
+  kMetadataLog,
+};
+
+StreamedList StreamedListOf(std::string_view key) {
+  if (key == kSnapshots) {
+    return StreamedList::kSnapshots;
+  }
+  if (key == kSnapshotLog) {
+    return StreamedList::kSnapshotLog;
+  }
+  if (key == kMetadataLog) {
+    return StreamedList::kMetadataLog;
+  }
+  return StreamedList::kNone;
+}
+
+/// \brief Removes the snapshots that are neither referenced by a ref nor ancestors of
+/// a referenced snapshot.
+void RetainReferencedSnapshots(TableMetadata& metadata) {
+  std::unordered_map<int64_t, std::optional<int64_t>> parents_by_id;
+  for (const auto& snapshot : metadata.snapshots) {
+    parents_by_id.emplace(snapshot->snapshot_id, snapshot->parent_snapshot_id);
+  }
+  const auto& compact = metadata.compact_snapshots;
+  for (size_t pos = 0; compact != nullptr && pos < compact->size(); ++pos) {
+    parents_by_id.emplace(compact->snapshot_id(pos), compact->parent_snapshot_id(pos));
+  }
+  std::unordered_set<int64_t> retained;
+  auto retain_ancestors = [&](int64_t snapshot_id) {
+    for (std::optional<int64_t> id = snapshot_id; id.has_value();) {
+      auto it = parents_by_id.find(id.value());
+      if (it == parents_by_id.cend() || !retained.insert(id.value()).second) {
+        break;
+      }
+      id = it->second;
+    }
+  };
+  retain_ancestors(metadata.current_snapshot_id);
+  for (const auto& [_, ref] : metadata.refs) {
+    retain_ancestors(ref->snapshot_id);
+  }
+  erase_if(metadata.snapshots, [&](const auto& snapshot) {
+    return !retained.contains(snapshot->snapshot_id);
+  });
+  if (compact != nullptr && retained.size() < parents_by_id.size()) {
+    auto retained_compact = std::make_shared<CompactSnapshots>();
+    for (size_t pos = 0; pos < compact->size(); ++pos) {
+      if (retained.contains(compact->snapshot_id(pos))) {
+        retained_compact->Append(compact->snapshot_id(pos),
+                                 compact->parent_snapshot_id(pos),
+                                 compact->timestamp_ms(pos), compact->json(pos));
+      }
+    }
+    metadata.compact_snapshots = std::move(retained_compact);
+  }
+}
+
+/// \brief Parses table metadata from a string or a stream, see
+/// TableMetadataFromJsonString.
+template <typename Input>
+Result<std::unique_ptr<TableMetadata>> TableMetadataFromJsonInput(
+    Input&& input, const TableMetadataReadOptions& options) {
+  using ParseEvent = nlohmann::json::parse_event_t;
+
+  std::vector<std::shared_ptr<Snapshot>> snapshots;
+  std::shared_ptr<CompactSnapshots> compact_snapshots;
+  if (options.lazy_snapshots) {
+    compact_snapshots = std::make_shared<CompactSnapshots>();
+  }
+  std::vector<SnapshotLogEntry> snapshot_log;
+  std::vector<MetadataLogEntry> metadata_log;
+  Status status;
+
+  // Depth 1 holds the top-level fields, and depth 2 the elements of top-level lists.
+  std::string key;
+  StreamedList streamed_list = StreamedList::kNone;
+  auto callback = [&](int depth, ParseEvent event, nlohmann::json& parsed) -> bool {
+    if (depth == 1) {
+      if (event == ParseEvent::key) {
+        key = parsed.get_ref<const std::string&>();
+      } else if (event == ParseEvent::array_start) {
+        streamed_list = StreamedListOf(key);
+      } else if (event == ParseEvent::array_end) {
+        streamed_list = StreamedList::kNone;
+      }
+      return true;
+    }
+    if (depth != 2 || event != ParseEvent::object_end ||
+        streamed_list == StreamedList::kNone) {
+      return true;
+    }
+    if (!status.has_value()) {
+      return false;
+    }
+    // The converted elements are discarded from the JSON tree.
+    switch (streamed_list) {
+      case StreamedList::kSnapshots:
+        if (auto snapshot = SnapshotFromJson(parsed); !snapshot.has_value()) {
+          status = std::unexpected(std::move(snapshot).error());
+        } else if (compact_snapshots != nullptr) {
+          // Parsed strings are valid UTF-8, so nothing is replaced.
+          const auto& value = *snapshot.value();
+          compact_snapshots->Append(
+              value.snapshot_id, value.parent_snapshot_id, value.timestamp_ms,
+              parsed.dump(/*indent=*/-1, /*indent_char=*/' ', /*ensure_ascii=*/false,
+                          nlohmann::json::error_handler_t::replace));
+        } else {
+          snapshots.push_back(std::move(snapshot).value());
+        }
+        break;
+      case StreamedList::kSnapshotLog:
+        if (auto entry = SnapshotLogEntryFromJson(parsed); entry.has_value()) {
+          snapshot_log.push_back(std::move(entry).value());
+        } else {
+          status = std::unexpected(std::move(entry).error());
+        }
+        break;
+      case StreamedList::kMetadataLog:
+        if (auto entry = MetadataLogEntryFromJson(parsed); entry.has_value()) {
+          metadata_log.push_back(std::move(entry).value());
+        } else {
+          status = std::unexpected(std::move(entry).error());
+        }
+        break;
+      case StreamedList::kNone:
+        break;
+    }
+    return false;
+  };
+
+  auto json = nlohmann::json::parse(std::forward<Input>(input), callback,
+                                    /*allow_exceptions=*/false);
+  if (json.is_discarded()) [[unlikely]] {
+    return JsonParseError("Failed to parse table metadata JSON string");
+  }
+  ICEBERG_RETURN_UNEXPECTED(status);
+
+  ICEBERG_ASSIGN_OR_RAISE(auto table_metadata, TableMetadataFromJson(json));
+  table_metadata->snapshots = std::move(snapshots);
+  table_metadata->compact_snapshots = std::move(compact_snapshots);
+  table_metadata->snapshot_log = std::move(snapshot_log);
+  table_metadata->metadata_log = std::move(metadata_log);
+  if (options.only_referenced_snapshots) {
+    RetainReferencedSnapshots(*table_metadata);
+  }
+  if (options.intern_pool != nullptr) {
+    options.intern_pool->Intern(*table_metadata);
+  }
+  return table_metadata;
+}
+
+}  // namespace
+
+Result<std::unique_ptr<TableMetadata>> TableMetadataFromJsonString(
+    std::string_view json_string, const TableMetadataReadOptions& options) {
+  return TableMetadataFromJsonInput(json_string, options);
+}
+
+Result<std::unique_ptr<TableMetadata>> TableMetadataFromJsonStream(
+    std::istream& stream, const TableMetadataReadOptions& options) {
+  return TableMetadataFromJsonInput(stream, options);
+}
+
 Result<nlohmann::json> FromJsonString(const std::string& json_string) {
   auto json =
       nlohmann::json::parse(json_string, /*cb=*/nullptr, /*allow_exceptions=*/false);
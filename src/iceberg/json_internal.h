@@ -19,7 +19,9 @@
 
 #pragma once
 
+#include <iosfwd>
 #include <memory>
+#include <string_view>
 
 #include <nlohmann/json_fwd.hpp>
 
@@ -270,6 +272,19 @@ ICEBERG_EXPORT nlohmann::json ToJson(const TableMetadata& table_metadata);
 /// \return A JSON string of the `TableMetadata`.
 ICEBERG_EXPORT Result<std::string> ToJsonString(const TableMetadata& table_metadata);
 
+/// \brief Serializes a `TableMetadata` object to JSON written into a file.
+///
+/// Unlike ToJsonString, the JSON text is written into the file in chunks as it is
+/// produced, and the snapshots, logs and references are written field by field instead
+/// of through a JSON tree. Neither the tree nor the text of a table with a long history
+/// is therefore held in memory at once. The members are written in the order of the
+/// spec instead of the sorted order of ToJsonString. The file is not closed.
+///
+/// \param table_metadata The `TableMetadata` object to be serialized.
+/// \param file The file to write the JSON text into.
+/// \return An error if the serialization or a write to the file failed.
+ICEBERG_EXPORT Status WriteJson(const TableMetadata& table_metadata, OutputFile& file);
+
 /// \brief Deserializes a JSON object into a `TableMetadata` object.
 ///
 /// \param json The JSON object representing a `TableMetadata`.
@@ -277,6 +292,31 @@ ICEBERG_EXPORT Result<std::string> ToJsonString(const TableMetadata& table_metad
 ICEBERG_EXPORT Result<std::unique_ptr<TableMetadata>> TableMetadataFromJson(
     const nlohmann::json& json);
 
+/// \brief Deserializes a JSON string into a `TableMetadata` object.
+///
+/// Unlike parsing the string with FromJsonString and converting it with
+/// TableMetadataFromJson, the snapshots, snapshot log and metadata log entries are
+/// converted while the string is parsed, and their JSON objects are discarded as soon
+/// as they are converted. The JSON tree of a table with a long history therefore never
+/// holds its history, which is most of the metadata file.
+///
+/// \param json_string The JSON string representing a `TableMetadata`.
+/// \param options The options for reading the table metadata.
+/// \return A `TableMetadata` object or an error if the conversion fails.
+ICEBERG_EXPORT Result<std::unique_ptr<TableMetadata>> TableMetadataFromJsonString(
+    std::string_view json_string, const TableMetadataReadOptions& options = {});
+
+/// \brief Deserializes a JSON stream into a `TableMetadata` object.
+///
+/// Like TableMetadataFromJsonString, but the text is read from the stream as it is
+/// parsed, e.g. from a GZipInputBuffer, so that it is never held in memory at once.
+///
+/// \param stream The stream of the JSON text representing a `TableMetadata`.
+/// \param options The options for reading the table metadata.
+/// \return A `TableMetadata` object or an error if the conversion fails.
+ICEBERG_EXPORT Result<std::unique_ptr<TableMetadata>> TableMetadataFromJsonStream(
+    std::istream& stream, const TableMetadataReadOptions& options = {});
+
 /// \brief Deserialize a JSON string into a `nlohmann::json` object.
 ///
 /// \param json_string The JSON string to deserialize.
@@ -0,0 +1,151 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/location_provider.h"
+
+#include <cstdint>
+#include <format>
+#include <string_view>
+
+#include "iceberg/partition_spec.h"
+#include "iceberg/table_properties.h"
+#include "iceberg/util/macros.h"
+#include "iceberg/util/murmurhash3_internal.h"
+
+namespace iceberg {
+
+namespace {
+
+std::string StripTrailingSlash(std::string location) {
+  while (location.size() > 1 && location.back() == '/') {
+    location.pop_back();
+  }
+  return location;
+}
+
+std::string DataLocation(const std::string& table_location,
+                         const TableProperties& properties) {
+  auto data_location = properties.Get(TableProperties::kWriteDataLocation);
+  if (data_location.empty()) {
+    return table_location + "/data";
+  }
+  return StripTrailingSlash(std::move(data_location));
+}
+
+/// \brief Returns the last two directories of a table location, such as
+/// "db/table", which tell tables apart under a shared data location.
+std::string PathContext(std::string_view table_location) {
+  const auto name_start = table_location.rfind('/');
+  if (name_start == std::string_view::npos) {
+    return std::string(table_location);
+  }
+  const auto parent = table_location.substr(0, name_start);
+  const auto parent_start = parent.rfind('/');
+  if (parent.empty() || parent.ends_with(':') || parent.ends_with('/')) {
+    // The table is at the root of a file system, such as "s3://bucket/table".
+    return std::string(table_location.substr(name_start + 1));
+  }
+  return std::string(table_location.substr(
+      parent_start == std::string_view::npos ? 0 : parent_start + 1));
+}
+
+/// \brief Returns the directories of the entropy of a file name.
+///
+/// The 20 low bits of the Murmur3 hash of the file name are written in binary, in
+/// directories of 4, 4, 4 and 8 bits.
+std::string EntropyDirectories(std::string_view filename) {
+  uint32_t hash;
+  MurmurHash3_x86_32(filename.data(), static_cast<int>(filename.size()), 0, &hash);
+  std::string bits;
+  bits.reserve(23);
+  for (int bit = 19; bit >= 0; --bit) {
+    bits.push_back(((hash >> bit) & 1) != 0 ? '1' : '0');
+    if (bit == 16 || bit == 12 || bit == 8) {
+      bits.push_back('/');
+    }
+  }
+  return bits;
+}
+
+}  // namespace
+
+std::unique_ptr<LocationProvider> LocationProvider::Make(
+    std::string table_location, const TableProperties& properties) {
+  if (properties.Get(TableProperties::kObjectStoreEnabled)) {
+    return std::make_unique<ObjectStoreLocationProvider>(std::move(table_location),
+                                                         properties);
+  }
+  return std::make_unique<DefaultLocationProvider>(std::move(table_location),
+                                                   properties);
+}
+
+DefaultLocationProvider::DefaultLocationProvider(std::string table_location,
+                                                 const TableProperties& properties)
+    : data_location_(
+          DataLocation(StripTrailingSlash(std::move(table_location)), properties)) {}
+
+Result<std::string> DefaultLocationProvider::NewDataLocation(
+    const std::string& filename) {
+  return std::format("{}/{}", data_location_, filename);
+}
+
+Result<std::string> DefaultLocationProvider::NewDataLocation(
+    const PartitionSpec& spec, const StructLike& partition_data,
+    const std::string& filename) {
+  ICEBERG_ASSIGN_OR_RAISE(auto partition_path, spec.PartitionPath(partition_data));
+  return std::format("{}/{}/{}", data_location_, partition_path, filename);
+}
+
+ObjectStoreLocationProvider::ObjectStoreLocationProvider(
+    std::string table_location, const TableProperties& properties)
+    : include_partition_paths_(
+          properties.Get(TableProperties::kWriteObjectStorePartitionedPaths)) {
+  table_location = StripTrailingSlash(std::move(table_location));
+  storage_location_ = DataLocation(table_location, properties);
+  // Files under the table location are already told apart by their location.
+  if (!storage_location_.starts_with(table_location)) {
+    context_ = PathContext(table_location);
+  }
+}
+
+Result<std::string> ObjectStoreLocationProvider::NewDataLocation(
+    const std::string& filename) {
+  const auto entropy = EntropyDirectories(filename);
+  if (context_.has_value()) {
+    return std::format("{}/{}/{}/{}", storage_location_, entropy, *context_, filename);
+  }
+  if (!include_partition_paths_) {
+    // Without partition directories, the last directory of the entropy is a prefix of
+    // the file name.
+    return std::format("{}/{}-{}", storage_location_, entropy, filename);
+  }
+  return std::format("{}/{}/{}", storage_location_, entropy, filename);
+}
+
+Result<std::string> ObjectStoreLocationProvider::NewDataLocation(
+    const PartitionSpec& spec, const StructLike& partition_data,
+    const std::string& filename) {
+  if (!include_partition_paths_) {
+    return NewDataLocation(filename);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto partition_path, spec.PartitionPath(partition_data));
+  return NewDataLocation(std::format("{}/{}", partition_path, filename));
+}
+
+}  // namespace iceberg
@@ -19,9 +19,15 @@
 
 #pragma once
 
+/// \file iceberg/location_provider.h
+/// Locations of the data files written to a table.
+
+#include <memory>
+#include <optional>
 #include <string>
 
 #include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
 #include "iceberg/type_fwd.h"
 
 namespace iceberg {
@@ -31,11 +37,21 @@ class ICEBERG_EXPORT LocationProvider {
  public:
   virtual ~LocationProvider() = default;
 
+  /// \brief Returns the location provider of a table.
+  ///
+  /// This is an ObjectStoreLocationProvider when TableProperties::kObjectStoreEnabled
+  /// is set, and a DefaultLocationProvider otherwise.
+  ///
+  /// \param table_location the location of the table
+  /// \param properties the properties of the table
+  static std::unique_ptr<LocationProvider> Make(std::string table_location,
+                                                const TableProperties& properties);
+
   /// \brief Return a fully-qualified data file location for the given filename.
   ///
   /// \param filename a file name
   /// \return a fully-qualified location URI for a data file
-  virtual std::string NewDataLocation(const std::string& filename) = 0;
+  virtual Result<std::string> NewDataLocation(const std::string& filename) = 0;
 
   /// \brief Return a fully-qualified data file location for the given partition and
   /// filename.
@@ -48,9 +64,54 @@ class ICEBERG_EXPORT LocationProvider {
   ///
   /// TODO(wgtmac): StructLike is not well thought yet, we may wrap an ArrowArray
   /// with single row in StructLike.
-  virtual std::string NewDataLocation(const PartitionSpec& spec,
+  virtual Result<std::string> NewDataLocation(const PartitionSpec& spec,
+                                              const StructLike& partition_data,
+                                              const std::string& filename) = 0;
+};
+
+/// \brief Writes data files under the partition directories of the data location.
+///
+/// The data location is TableProperties::kWriteDataLocation, or the "data" directory
+/// of the table location.
+class ICEBERG_EXPORT DefaultLocationProvider : public LocationProvider {
+ public:
+  DefaultLocationProvider(std::string table_location,
+                          const TableProperties& properties);
+
+  Result<std::string> NewDataLocation(const std::string& filename) override;
+
+  Result<std::string> NewDataLocation(const PartitionSpec& spec,
                                       const StructLike& partition_data,
-                                      const std::string& filename) = 0;
+                                      const std::string& filename) override;
+
+ private:
+  std::string data_location_;
+};
+
+/// \brief Spreads data files over many prefixes of the data location.
+///
+/// Object stores such as S3 partition their key space by prefix and throttle the
+/// requests to a single prefix, so each file is put under a directory derived from the
+/// Murmur3 hash of its name, as "0101/0110/1001/10110010". When the data location is
+/// not under the table location, the last two directories of the table location follow
+/// the hash to tell the tables apart. Partition directories are kept after the hash
+/// unless TableProperties::kWriteObjectStorePartitionedPaths is false, in which case
+/// the last directory of the hash is a prefix of the file name instead.
+class ICEBERG_EXPORT ObjectStoreLocationProvider : public LocationProvider {
+ public:
+  ObjectStoreLocationProvider(std::string table_location,
+                              const TableProperties& properties);
+
+  Result<std::string> NewDataLocation(const std::string& filename) override;
+
+  Result<std::string> NewDataLocation(const PartitionSpec& spec,
+                                      const StructLike& partition_data,
+                                      const std::string& filename) override;
+
+ private:
+  std::string storage_location_;
+  std::optional<std::string> context_;
+  bool include_partition_paths_;
 };
 
 }  // namespace iceberg
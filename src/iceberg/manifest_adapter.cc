@@ -19,6 +19,9 @@
 
 #include "iceberg/manifest_adapter.h"
 
+#include <map>
+#include <type_traits>
+
 #include <nanoarrow/nanoarrow.h>
 
 #include "iceberg/arrow/nanoarrow_status_internal.h"
@@ -117,6 +120,147 @@ Status AppendMap(ArrowArray* array,
   return {};
 }
 
+Status AppendPartitionValue(ArrowArray* child_array, const SchemaField& partition_field,
+                            const Literal& partition_value) {
+  if (partition_value.IsNull()) {
+    ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayAppendNull(child_array, 1));
+    return {};
+  }
+  switch (partition_field.type()->type_id()) {
+    case TypeId::kBoolean:
+      ICEBERG_RETURN_UNEXPECTED(AppendField(
+          child_array, static_cast<uint64_t>(
+                           std::get<bool>(partition_value.value()) == true ? 1L : 0L)));
+      break;
+    case TypeId::kInt:
+      ICEBERG_RETURN_UNEXPECTED(AppendField(
+          child_array, static_cast<int64_t>(std::get<int32_t>(partition_value.value()))));
+      break;
+    case TypeId::kLong:
+      ICEBERG_RETURN_UNEXPECTED(
+          AppendField(child_array, std::get<int64_t>(partition_value.value())));
+      break;
+    case TypeId::kFloat:
+      ICEBERG_RETURN_UNEXPECTED(AppendField(
+          child_array, static_cast<double>(std::get<float>(partition_value.value()))));
+      break;
+    case TypeId::kDouble:
+      ICEBERG_RETURN_UNEXPECTED(
+          AppendField(child_array, std::get<double>(partition_value.value())));
+      break;
+    case TypeId::kString:
+      ICEBERG_RETURN_UNEXPECTED(
+          AppendField(child_array, std::get<std::string>(partition_value.value())));
+      break;
+    case TypeId::kFixed:
+    case TypeId::kBinary:
+      ICEBERG_RETURN_UNEXPECTED(AppendField(
+          child_array, std::get<std::vector<uint8_t>>(partition_value.value())));
+      break;
+    case TypeId::kDate:
+      ICEBERG_RETURN_UNEXPECTED(AppendField(
+          child_array, static_cast<int64_t>(std::get<int32_t>(partition_value.value()))));
+      break;
+    case TypeId::kTime:
+    case TypeId::kTimestamp:
+    case TypeId::kTimestampTz:
+      ICEBERG_RETURN_UNEXPECTED(
+          AppendField(child_array, std::get<int64_t>(partition_value.value())));
+      break;
+    case TypeId::kDecimal:
+      ICEBERG_RETURN_UNEXPECTED(AppendField(
+          child_array, std::get<Decimal>(partition_value.value()).ToBytes()));
+      break;
+    case TypeId::kUuid:
+      ICEBERG_RETURN_UNEXPECTED(
+          AppendField(child_array, std::get<Uuid>(partition_value.value()).bytes()));
+      break;
+    case TypeId::kStruct:
+    case TypeId::kList:
+    case TypeId::kMap:
+      // TODO(xiao.dong) Literals do not currently support these types
+    default:
+      return InvalidManifest("Unsupported partition type: {}",
+                             partition_field.ToString());
+  }
+  return {};
+}
+
+Status AppendOptional(ArrowArray* array, const std::optional<int64_t>& value) {
+  if (value.has_value()) {
+    return AppendField(array, value.value());
+  }
+  ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayAppendNull(array, 1));
+  return {};
+}
+
+/// \brief Reserves the data buffer of a string or binary array.
+Status ReserveData(ArrowArray* array, int64_t additional_bytes) {
+  ICEBERG_NANOARROW_RETURN_UNEXPECTED(
+      ArrowBufferReserve(ArrowArrayBuffer(array, 2), additional_bytes));
+  return {};
+}
+
+/// \brief Finishes `count` elements of a struct array whose children were appended
+/// column by column, the bulk equivalent of ArrowArrayFinishElement().
+Status FinishStructElements(ArrowArray* array, int64_t count) {
+  for (int64_t i = 0; i < array->n_children; i++) {
+    if (array->children[i]->length != array->length + count) [[unlikely]] {
+      return InvalidArrowData("Child {} of struct array has {} elements, expected {}", i,
+                              array->children[i]->length, array->length + count);
+    }
+  }
+  // The validity bitmap is only allocated once a null is appended.
+  if (auto bitmap = ArrowArrayValidityBitmap(array); bitmap->buffer.data != nullptr) {
+    ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowBitmapAppend(bitmap, 1, count));
+  }
+  array->length += count;
+  return {};
+}
+
+/// \brief Appends a map column of the data files, reserving the entries of all maps.
+template <typename V>
+Status AppendMapColumn(ArrowArray* array, std::span<const ManifestEntry> entries,
+                       const std::map<int32_t, V> DataFile::* member) {
+  int64_t map_size = 0;
+  int64_t value_bytes = 0;
+  for (const auto& entry : entries) {
+    const auto& map_value = (*entry.data_file).*member;
+    map_size += static_cast<int64_t>(map_value.size());
+    if constexpr (std::is_same_v<V, std::vector<uint8_t>>) {
+      for (const auto& [key, value] : map_value) {
+        value_bytes += static_cast<int64_t>(value.size());
+      }
+    }
+  }
+  auto map_array = array->children[0];
+  ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayReserve(map_array, map_size));
+  if constexpr (std::is_same_v<V, std::vector<uint8_t>>) {
+    if (map_array->n_children == 2) {
+      ICEBERG_RETURN_UNEXPECTED(ReserveData(map_array->children[1], value_bytes));
+    }
+  }
+  for (const auto& entry : entries) {
+    ICEBERG_RETURN_UNEXPECTED(AppendMap(array, (*entry.data_file).*member));
+  }
+  return {};
+}
+
+/// \brief Appends a list column of the data files, reserving the elements of all lists.
+template <typename T>
+Status AppendListColumn(ArrowArray* array, std::span<const ManifestEntry> entries,
+                        const std::vector<T> DataFile::* member) {
+  int64_t list_size = 0;
+  for (const auto& entry : entries) {
+    list_size += static_cast<int64_t>(((*entry.data_file).*member).size());
+  }
+  ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayReserve(array->children[0], list_size));
+  for (const auto& entry : entries) {
+    ICEBERG_RETURN_UNEXPECTED(AppendList(array, (*entry.data_file).*member));
+  }
+  return {};
+}
+
 }  // namespace
 
 Status ManifestAdapter::StartAppending() {
@@ -168,72 +312,8 @@ Status ManifestEntryAdapter::AppendPartitionValues(
   auto fields = partition_type->fields();
 
   for (size_t i = 0; i < fields.size(); i++) {
-    const auto& partition_value = partition_values[i];
-    const auto& partition_field = fields[i];
-    auto child_array = array->children[i];
-    if (partition_value.IsNull()) {
-      ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayAppendNull(child_array, 1));
-      continue;
-    }
-    switch (partition_field.type()->type_id()) {
-      case TypeId::kBoolean:
-        ICEBERG_RETURN_UNEXPECTED(AppendField(
-            child_array, static_cast<uint64_t>(
-                             std::get<bool>(partition_value.value()) == true ? 1L : 0L)));
-        break;
-      case TypeId::kInt:
-        ICEBERG_RETURN_UNEXPECTED(AppendField(
-            child_array,
-            static_cast<int64_t>(std::get<int32_t>(partition_value.value()))));
-        break;
-      case TypeId::kLong:
-        ICEBERG_RETURN_UNEXPECTED(
-            AppendField(child_array, std::get<int64_t>(partition_value.value())));
-        break;
-      case TypeId::kFloat:
-        ICEBERG_RETURN_UNEXPECTED(AppendField(
-            child_array, static_cast<double>(std::get<float>(partition_value.value()))));
-        break;
-      case TypeId::kDouble:
-        ICEBERG_RETURN_UNEXPECTED(
-            AppendField(child_array, std::get<double>(partition_value.value())));
-        break;
-      case TypeId::kString:
-        ICEBERG_RETURN_UNEXPECTED(
-            AppendField(child_array, std::get<std::string>(partition_value.value())));
-        break;
-      case TypeId::kFixed:
-      case TypeId::kBinary:
-        ICEBERG_RETURN_UNEXPECTED(AppendField(
-            child_array, std::get<std::vector<uint8_t>>(partition_value.value())));
-        break;
-      case TypeId::kDate:
-        ICEBERG_RETURN_UNEXPECTED(AppendField(
-            child_array,
-            static_cast<int64_t>(std::get<int32_t>(partition_value.value()))));
-        break;
-      case TypeId::kTime:
-      case TypeId::kTimestamp:
-      case TypeId::kTimestampTz:
-        ICEBERG_RETURN_UNEXPECTED(
-            AppendField(child_array, std::get<int64_t>(partition_value.value())));
-        break;
-      case TypeId::kDecimal:
-        ICEBERG_RETURN_UNEXPECTED(AppendField(
-            child_array, std::get<Decimal>(partition_value.value()).ToBytes()));
-        break;
-      case TypeId::kUuid:
-        ICEBERG_RETURN_UNEXPECTED(
-            AppendField(child_array, std::get<Uuid>(partition_value.value()).bytes()));
-        break;
-      case TypeId::kStruct:
-      case TypeId::kList:
-      case TypeId::kMap:
-        // TODO(xiao.dong) Literals do not currently support these types
-      default:
-        return InvalidManifest("Unsupported partition type: {}",
-                               partition_field.ToString());
-    }
+    ICEBERG_RETURN_UNEXPECTED(
+        AppendPartitionValue(array->children[i], fields[i], partition_values[i]));
   }
   ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayFinishElement(array));
   return {};
@@ -436,6 +516,227 @@ Status ManifestEntryAdapter::AppendInternal(const ManifestEntry& entry) {
   return {};
 }
 
+Status ManifestEntryAdapter::AppendDataFiles(
+    ArrowArray* array, const std::shared_ptr<StructType>& data_file_type,
+    std::span<const ManifestEntry> entries) {
+  auto fields = data_file_type->fields();
+  for (size_t i = 0; i < fields.size(); i++) {
+    const auto& field = fields[i];
+    auto child_array = array->children[i];
+
+    switch (field.field_id()) {
+      case 134:  // content (optional int32)
+        for (const auto& entry : entries) {
+          ICEBERG_RETURN_UNEXPECTED(
+              AppendField(child_array, static_cast<int64_t>(entry.data_file->content)));
+        }
+        break;
+      case 100: {
+        // file_path (required string)
+        int64_t path_bytes = 0;
+        for (const auto& entry : entries) {
+          path_bytes += static_cast<int64_t>(entry.data_file->file_path.size());
+        }
+        ICEBERG_RETURN_UNEXPECTED(ReserveData(child_array, path_bytes));
+        for (const auto& entry : entries) {
+          ICEBERG_RETURN_UNEXPECTED(AppendField(child_array, entry.data_file->file_path));
+        }
+        break;
+      }
+      case 101:  // file_format (required string)
+        for (const auto& entry : entries) {
+          ICEBERG_RETURN_UNEXPECTED(
+              AppendField(child_array, ToString(entry.data_file->file_format)));
+        }
+        break;
+      case 102: {
+        // partition (required struct)
+        auto partition_type = internal::checked_pointer_cast<StructType>(field.type());
+        auto partition_fields = partition_type->fields();
+        if (child_array->n_children != partition_fields.size()) [[unlikely]] {
+          return InvalidArrowData(
+              "Arrow array of partition does not match partition type.");
+        }
+        for (const auto& entry : entries) {
+          if (entry.data_file->partition.size() != partition_fields.size()) [[unlikely]] {
+            return InvalidArrowData(
+                "Literal list of partition does not match partition type.");
+          }
+        }
+        for (size_t j = 0; j < partition_fields.size(); j++) {
+          for (const auto& entry : entries) {
+            ICEBERG_RETURN_UNEXPECTED(
+                AppendPartitionValue(child_array->children[j], partition_fields[j],
+                                     entry.data_file->partition[j]));
+          }
+        }
+        ICEBERG_RETURN_UNEXPECTED(
+            FinishStructElements(child_array, static_cast<int64_t>(entries.size())));
+        break;
+      }
+      case 103:  // record_count (required int64)
+        for (const auto& entry : entries) {
+          ICEBERG_RETURN_UNEXPECTED(
+              AppendField(child_array, entry.data_file->record_count));
+        }
+        break;
+      case 104:  // file_size_in_bytes (required int64)
+        for (const auto& entry : entries) {
+          ICEBERG_RETURN_UNEXPECTED(
+              AppendField(child_array, entry.data_file->file_size_in_bytes));
+        }
+        break;
+      case 105:  // block_size_in_bytes (compatible in v1)
+        // always 64MB for v1
+        for (size_t j = 0; j < entries.size(); j++) {
+          ICEBERG_RETURN_UNEXPECTED(AppendField(child_array, kBlockSizeInBytesV1));
+        }
+        break;
+      case 108:  // column_sizes (optional map)
+        ICEBERG_RETURN_UNEXPECTED(
+            AppendMapColumn(child_array, entries, &DataFile::column_sizes));
+        break;
+      case 109:  // value_counts (optional map)
+        ICEBERG_RETURN_UNEXPECTED(
+            AppendMapColumn(child_array, entries, &DataFile::value_counts));
+        break;
+      case 110:  // null_value_counts (optional map)
+        ICEBERG_RETURN_UNEXPECTED(
+            AppendMapColumn(child_array, entries, &DataFile::null_value_counts));
+        break;
+      case 137:  // nan_value_counts (optional map)
+        ICEBERG_RETURN_UNEXPECTED(
+            AppendMapColumn(child_array, entries, &DataFile::nan_value_counts));
+        break;
+      case 125:  // lower_bounds (optional map)
+        ICEBERG_RETURN_UNEXPECTED(
+            AppendMapColumn(child_array, entries, &DataFile::lower_bounds));
+        break;
+      case 128:  // upper_bounds (optional map)
+        ICEBERG_RETURN_UNEXPECTED(
+            AppendMapColumn(child_array, entries, &DataFile::upper_bounds));
+        break;
+      case 131:  // key_metadata (optional binary)
+        for (const auto& entry : entries) {
+          if (!entry.data_file->key_metadata.empty()) {
+            ICEBERG_RETURN_UNEXPECTED(
+                AppendField(child_array, entry.data_file->key_metadata));
+          } else {
+            ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayAppendNull(child_array, 1));
+          }
+        }
+        break;
+      case 132:  // split_offsets (optional list)
+        ICEBERG_RETURN_UNEXPECTED(
+            AppendListColumn(child_array, entries, &DataFile::split_offsets));
+        break;
+      case 135:  // equality_ids (optional list)
+        ICEBERG_RETURN_UNEXPECTED(
+            AppendListColumn(child_array, entries, &DataFile::equality_ids));
+        break;
+      case 140:  // sort_order_id (optional int32)
+        for (const auto& entry : entries) {
+          const auto& sort_order_id = entry.data_file->sort_order_id;
+          ICEBERG_RETURN_UNEXPECTED(AppendOptional(
+              child_array, sort_order_id.has_value()
+                               ? std::optional<int64_t>(sort_order_id.value())
+                               : std::nullopt));
+        }
+        break;
+      case 142:  // first_row_id (optional int64)
+        for (const auto& entry : entries) {
+          ICEBERG_RETURN_UNEXPECTED(
+              AppendOptional(child_array, entry.data_file->first_row_id));
+        }
+        break;
+      case 143:  // referenced_data_file (optional string)
+        for (const auto& entry : entries) {
+          ICEBERG_ASSIGN_OR_RAISE(auto referenced_data_file,
+                                  GetReferenceDataFile(*entry.data_file));
+          if (referenced_data_file.has_value()) {
+            ICEBERG_RETURN_UNEXPECTED(
+                AppendField(child_array, referenced_data_file.value()));
+          } else {
+            ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayAppendNull(child_array, 1));
+          }
+        }
+        break;
+      case 144:  // content_offset (optional int64)
+        for (const auto& entry : entries) {
+          ICEBERG_RETURN_UNEXPECTED(
+              AppendOptional(child_array, entry.data_file->content_offset));
+        }
+        break;
+      case 145:  // content_size_in_bytes (optional int64)
+        for (const auto& entry : entries) {
+          ICEBERG_RETURN_UNEXPECTED(
+              AppendOptional(child_array, entry.data_file->content_size_in_bytes));
+        }
+        break;
+      default:
+        return InvalidManifest("Unknown data file field id: {} ", field.field_id());
+    }
+  }
+  return FinishStructElements(array, static_cast<int64_t>(entries.size()));
+}
+
+Status ManifestEntryAdapter::AppendAllInternal(std::span<const ManifestEntry> entries) {
+  if (entries.empty()) {
+    return {};
+  }
+  for (const auto& entry : entries) {
+    if (!entry.data_file) {
+      return InvalidManifest("Missing required data_file field from manifest entry.");
+    }
+  }
+  const auto count = static_cast<int64_t>(entries.size());
+  // Reserves the fixed-width buffers of all columns, including nested ones.
+  ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayReserve(&array_, count));
+
+  const auto& fields = manifest_schema_->fields();
+  for (size_t i = 0; i < fields.size(); i++) {
+    const auto& field = fields[i];
+    auto array = array_.children[i];
+
+    switch (field.field_id()) {
+      case 0:  // status (required int32)
+        for (const auto& entry : entries) {
+          ICEBERG_RETURN_UNEXPECTED(AppendField(
+              array, static_cast<int64_t>(static_cast<int32_t>(entry.status))));
+        }
+        break;
+      case 1:  // snapshot_id (optional int64)
+        for (const auto& entry : entries) {
+          ICEBERG_RETURN_UNEXPECTED(AppendOptional(array, entry.snapshot_id));
+        }
+        break;
+      case 2: {
+        // data_file (required struct)
+        auto data_file_type = internal::checked_pointer_cast<StructType>(field.type());
+        ICEBERG_RETURN_UNEXPECTED(AppendDataFiles(array, data_file_type, entries));
+        break;
+      }
+      case 3:  // sequence_number (optional int64)
+        for (const auto& entry : entries) {
+          ICEBERG_ASSIGN_OR_RAISE(auto sequence_num, GetSequenceNumber(entry));
+          ICEBERG_RETURN_UNEXPECTED(AppendOptional(array, sequence_num));
+        }
+        break;
+      case 4:  // file_sequence_number (optional int64)
+        for (const auto& entry : entries) {
+          ICEBERG_RETURN_UNEXPECTED(AppendOptional(array, entry.file_sequence_number));
+        }
+        break;
+      default:
+        return InvalidManifest("Unknown manifest entry field id: {}", field.field_id());
+    }
+  }
+
+  ICEBERG_RETURN_UNEXPECTED(FinishStructElements(&array_, count));
+  size_ += count;
+  return {};
+}
+
 Status ManifestEntryAdapter::InitSchema(const std::unordered_set<int32_t>& fields_ids) {
   ICEBERG_ASSIGN_OR_RAISE(auto manifest_entry_type, GetManifestEntryType())
   auto fields_span = manifest_entry_type->fields();
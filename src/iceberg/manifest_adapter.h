@@ -24,6 +24,7 @@
 
 #include <memory>
 #include <optional>
+#include <span>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -67,8 +68,20 @@ class ICEBERG_EXPORT ManifestEntryAdapter : public ManifestAdapter {
 
   virtual Status Append(const ManifestEntry& entry) = 0;
 
+  /// \brief Appends a batch of entries column by column.
+  ///
+  /// Produces the same array as appending the entries one at a time, but reserves the
+  /// buffers for the whole batch up front and fills each column in a single pass.
+  virtual Status AppendAll(std::span<const ManifestEntry> entries) = 0;
+
   const std::shared_ptr<Schema>& schema() const { return manifest_schema_; }
 
+  /// \brief Appends a partition tuple as an element of a struct array of the partition
+  /// type.
+  static Status AppendPartitionValues(ArrowArray* array,
+                                      const std::shared_ptr<StructType>& partition_type,
+                                      const std::vector<Literal>& partition_values);
+
  protected:
   virtual Result<std::shared_ptr<StructType>> GetManifestEntryType();
 
@@ -78,12 +91,13 @@ class ICEBERG_EXPORT ManifestEntryAdapter : public ManifestAdapter {
   /// initialized to include only the fields with these IDs.
   Status InitSchema(const std::unordered_set<int32_t>& fields_ids);
   Status AppendInternal(const ManifestEntry& entry);
+  Status AppendAllInternal(std::span<const ManifestEntry> entries);
   Status AppendDataFile(ArrowArray* array,
                         const std::shared_ptr<StructType>& data_file_type,
                         const DataFile& file);
-  static Status AppendPartitionValues(ArrowArray* array,
-                                      const std::shared_ptr<StructType>& partition_type,
-                                      const std::vector<Literal>& partition_values);
+  Status AppendDataFiles(ArrowArray* array,
+                         const std::shared_ptr<StructType>& data_file_type,
+                         std::span<const ManifestEntry> entries);
 
   virtual Result<std::optional<int64_t>> GetSequenceNumber(
       const ManifestEntry& entry) const;
@@ -0,0 +1,218 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/manifest_cache.h"
+
+#include <format>
+#include <map>
+#include <type_traits>
+#include <utility>
+
+#include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_list.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief Approximate bookkeeping overhead of a node of a std::map.
+constexpr int64_t kMapNodeOverhead = 4 * sizeof(void*);
+
+template <typename T>
+int64_t VectorSize(const std::vector<T>& values) {
+  return static_cast<int64_t>(values.capacity() * sizeof(T));
+}
+
+template <typename V>
+int64_t MapSize(const std::map<int32_t, V>& values) {
+  int64_t size = static_cast<int64_t>(values.size() *
+                                      (sizeof(std::pair<const int32_t, V>) +
+                                       kMapNodeOverhead));
+  if constexpr (std::is_same_v<V, std::vector<uint8_t>>) {
+    for (const auto& [_, value] : values) {
+      size += VectorSize(value);
+    }
+  }
+  return size;
+}
+
+/// \brief Estimates the memory held by a decoded manifest entry.
+int64_t EstimateSize(const ManifestEntry& entry) {
+  int64_t size = sizeof(ManifestEntry);
+  if (const auto& data_file = entry.data_file; data_file != nullptr) {
+    size += sizeof(DataFile) + static_cast<int64_t>(data_file->file_path.capacity()) +
+            VectorSize(data_file->partition) + MapSize(data_file->column_sizes) +
+            MapSize(data_file->value_counts) + MapSize(data_file->null_value_counts) +
+            MapSize(data_file->nan_value_counts) + MapSize(data_file->lower_bounds) +
+            MapSize(data_file->upper_bounds) + VectorSize(data_file->key_metadata) +
+            VectorSize(data_file->split_offsets) + VectorSize(data_file->equality_ids);
+    if (data_file->referenced_data_file.has_value()) {
+      size += static_cast<int64_t>(data_file->referenced_data_file->capacity());
+    }
+  }
+  return size;
+}
+
+/// \brief Estimates the memory held by a decoded manifest file.
+int64_t EstimateSize(const ManifestFile& manifest) {
+  int64_t size = sizeof(ManifestFile) +
+                 static_cast<int64_t>(manifest.manifest_path.capacity()) +
+                 VectorSize(manifest.partitions) + VectorSize(manifest.key_metadata);
+  for (const auto& summary : manifest.partitions) {
+    size += summary.lower_bound ? VectorSize(*summary.lower_bound) : 0;
+    size += summary.upper_bound ? VectorSize(*summary.upper_bound) : 0;
+  }
+  return size;
+}
+
+template <typename T>
+int64_t EstimateSize(const std::vector<T>& values) {
+  int64_t size = sizeof(std::vector<T>);
+  for (const auto& value : values) {
+    size += EstimateSize(value);
+  }
+  return size;
+}
+
+// The inherited metadata is part of the key, because it is applied to the cached
+// entries.
+std::string EntriesKey(const ManifestFile& manifest) {
+  return std::format("manifest:{}:{}:{}:{}", manifest.partition_spec_id,
+                     manifest.added_snapshot_id, manifest.sequence_number,
+                     manifest.manifest_path);
+}
+
+std::string ManifestFilesKey(std::string_view manifest_list_location) {
+  return std::format("manifest-list:{}", manifest_list_location);
+}
+
+std::mutex global_cache_mutex;
+std::shared_ptr<ManifestCache> global_cache;
+
+}  // namespace
+
+ManifestCache::ManifestCache(int64_t capacity_bytes) : capacity_bytes_(capacity_bytes) {}
+
+Result<std::shared_ptr<ManifestCache>> ManifestCache::Make(int64_t capacity_bytes) {
+  if (capacity_bytes <= 0) {
+    return InvalidArgument("Manifest cache capacity must be positive, got {}",
+                           capacity_bytes);
+  }
+  return std::shared_ptr<ManifestCache>(new ManifestCache(capacity_bytes));
+}
+
+std::shared_ptr<ManifestCache> ManifestCache::Global() {
+  std::lock_guard lock(global_cache_mutex);
+  return global_cache;
+}
+
+void ManifestCache::SetGlobal(std::shared_ptr<ManifestCache> cache) {
+  std::lock_guard lock(global_cache_mutex);
+  global_cache = std::move(cache);
+}
+
+std::shared_ptr<const std::vector<ManifestEntry>> ManifestCache::GetEntries(
+    const ManifestFile& manifest) {
+  auto value = Get(EntriesKey(manifest));
+  if (!value.has_value()) {
+    return nullptr;
+  }
+  return std::get<std::shared_ptr<const std::vector<ManifestEntry>>>(*value);
+}
+
+void ManifestCache::PutEntries(const ManifestFile& manifest,
+                               std::vector<ManifestEntry> entries) {
+  const int64_t size_bytes = EstimateSize(entries);
+  Put(EntriesKey(manifest),
+      std::make_shared<const std::vector<ManifestEntry>>(std::move(entries)),
+      size_bytes);
+}
+
+std::shared_ptr<const std::vector<ManifestFile>> ManifestCache::GetManifestFiles(
+    std::string_view manifest_list_location) {
+  auto value = Get(ManifestFilesKey(manifest_list_location));
+  if (!value.has_value()) {
+    return nullptr;
+  }
+  return std::get<std::shared_ptr<const std::vector<ManifestFile>>>(*value);
+}
+
+void ManifestCache::PutManifestFiles(std::string_view manifest_list_location,
+                                     std::vector<ManifestFile> manifest_files) {
+  const int64_t size_bytes = EstimateSize(manifest_files);
+  Put(ManifestFilesKey(manifest_list_location),
+      std::make_shared<const std::vector<ManifestFile>>(std::move(manifest_files)),
+      size_bytes);
+}
+
+void ManifestCache::Clear() {
+  std::lock_guard lock(mutex_);
+  index_.clear();
+  items_.clear();
+  stats_.file_count = 0;
+  stats_.size_bytes = 0;
+}
+
+ManifestCache::Stats ManifestCache::stats() const {
+  std::lock_guard lock(mutex_);
+  return stats_;
+}
+
+std::optional<ManifestCache::Value> ManifestCache::Get(const std::string& key) {
+  std::lock_guard lock(mutex_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    ++stats_.misses;
+    return std::nullopt;
+  }
+  ++stats_.hits;
+  items_.splice(items_.begin(), items_, it->second);
+  return it->second->value;
+}
+
+void ManifestCache::Put(std::string key, Value value, int64_t size_bytes) {
+  std::lock_guard lock(mutex_);
+  if (auto it = index_.find(key); it != index_.end()) {
+    auto item = it->second;
+    index_.erase(it);
+    stats_.size_bytes -= item->size_bytes;
+    --stats_.file_count;
+    items_.erase(item);
+  }
+  if (size_bytes > capacity_bytes_) {
+    return;
+  }
+
+  while (stats_.size_bytes + size_bytes > capacity_bytes_) {
+    const auto& lru = items_.back();
+    stats_.size_bytes -= lru.size_bytes;
+    --stats_.file_count;
+    ++stats_.evictions;
+    index_.erase(lru.key);
+    items_.pop_back();
+  }
+
+  items_.push_front(
+      Item{.key = std::move(key), .value = std::move(value), .size_bytes = size_bytes});
+  index_.emplace(items_.front().key, items_.begin());
+  stats_.size_bytes += size_bytes;
+  ++stats_.file_count;
+}
+
+}  // namespace iceberg
@@ -0,0 +1,132 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/manifest_cache.h
+/// Cache of decoded manifest files and manifest lists.
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief A thread-safe LRU cache of decoded manifests and manifest lists.
+///
+/// Manifests and manifest lists are immutable once written, so their decoded contents
+/// can be reused by every reader of the same file. The cache holds up to a configured
+/// number of bytes, estimated from the decoded contents, and evicts the least recently
+/// used files beyond that. Files larger than the capacity are not cached.
+///
+/// When a process-wide cache is installed with SetGlobal(), the readers created by
+/// ManifestReader::Make from a ManifestFile and by ManifestListReader::Make serve
+/// their results from it. The data files of cached manifest
+/// entries are shared by all readers and must not be modified.
+class ICEBERG_EXPORT ManifestCache {
+ public:
+  /// \brief Counters describing the use of the cache.
+  struct Stats {
+    /// \brief Number of lookups that found the file in the cache.
+    int64_t hits = 0;
+    /// \brief Number of lookups that did not find the file in the cache.
+    int64_t misses = 0;
+    /// \brief Number of files evicted to make room for other files.
+    int64_t evictions = 0;
+    /// \brief Number of files currently in the cache.
+    int64_t file_count = 0;
+    /// \brief Estimated size in bytes of the files currently in the cache.
+    int64_t size_bytes = 0;
+  };
+
+  /// \brief Creates a cache holding up to `capacity_bytes` bytes of decoded data.
+  /// \param capacity_bytes The capacity of the cache, must be positive.
+  /// \return A Result containing the cache or an error.
+  static Result<std::shared_ptr<ManifestCache>> Make(int64_t capacity_bytes);
+
+  /// \brief Returns the process-wide cache, or null if none is installed.
+  static std::shared_ptr<ManifestCache> Global();
+
+  /// \brief Installs the process-wide cache, or disables it when given null.
+  static void SetGlobal(std::shared_ptr<ManifestCache> cache);
+
+  /// \brief Returns the cached entries of a manifest, or null if they are not cached.
+  ///
+  /// Entries are looked up by the manifest path and the manifest metadata that is
+  /// inherited by the entries.
+  std::shared_ptr<const std::vector<ManifestEntry>> GetEntries(
+      const ManifestFile& manifest);
+
+  /// \brief Caches the entries read from a manifest.
+  void PutEntries(const ManifestFile& manifest, std::vector<ManifestEntry> entries);
+
+  /// \brief Returns the cached files of a manifest list, or null if they are not cached.
+  std::shared_ptr<const std::vector<ManifestFile>> GetManifestFiles(
+      std::string_view manifest_list_location);
+
+  /// \brief Caches the files read from a manifest list.
+  void PutManifestFiles(std::string_view manifest_list_location,
+                        std::vector<ManifestFile> manifest_files);
+
+  /// \brief Removes all files from the cache. The counters are kept.
+  void Clear();
+
+  /// \brief The capacity of the cache in bytes.
+  int64_t capacity_bytes() const { return capacity_bytes_; }
+
+  /// \brief Returns a snapshot of the counters of the cache.
+  Stats stats() const;
+
+ private:
+  using Value = std::variant<std::shared_ptr<const std::vector<ManifestEntry>>,
+                             std::shared_ptr<const std::vector<ManifestFile>>>;
+
+  struct Item {
+    std::string key;
+    Value value;
+    int64_t size_bytes;
+  };
+
+  explicit ManifestCache(int64_t capacity_bytes);
+
+  /// \brief Returns the cached value of a key and marks it as most recently used.
+  std::optional<Value> Get(const std::string& key);
+
+  void Put(std::string key, Value value, int64_t size_bytes);
+
+  const int64_t capacity_bytes_;
+  mutable std::mutex mutex_;
+  /// \brief Cached items, from the most to the least recently used.
+  std::list<Item> items_;
+  std::unordered_map<std::string_view, std::list<Item>::iterator> index_;
+  Stats stats_;
+};
+
+}  // namespace iceberg
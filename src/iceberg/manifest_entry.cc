@@ -36,6 +36,26 @@ bool ManifestEntry::operator==(const ManifestEntry& other) const {
           (!data_file && !other.data_file));
 }
 
+DataFile DataFile::CopyWithoutStats() const {
+  DataFile copy;
+  copy.content = content;
+  copy.file_path = file_path;
+  copy.file_format = file_format;
+  copy.partition = partition;
+  copy.record_count = record_count;
+  copy.file_size_in_bytes = file_size_in_bytes;
+  copy.key_metadata = key_metadata;
+  copy.split_offsets = split_offsets;
+  copy.equality_ids = equality_ids;
+  copy.sort_order_id = sort_order_id;
+  copy.partition_spec_id = partition_spec_id;
+  copy.first_row_id = first_row_id;
+  copy.referenced_data_file = referenced_data_file;
+  copy.content_offset = content_offset;
+  copy.content_size_in_bytes = content_size_in_bytes;
+  return copy;
+}
+
 std::shared_ptr<StructType> DataFile::Type(std::shared_ptr<StructType> partition_type) {
   if (!partition_type) {
     partition_type = PartitionSpec::Unpartitioned()->schema();
@@ -266,6 +266,12 @@ struct ICEBERG_EXPORT DataFile {
 
   bool operator==(const DataFile& other) const = default;
 
+  /// \brief Returns a copy of the file without its column metrics.
+  ///
+  /// The column sizes, value and null counts and bounds are only needed to plan a
+  /// scan, so planned tasks can hold this much smaller copy instead.
+  DataFile CopyWithoutStats() const;
+
   static std::shared_ptr<StructType> Type(std::shared_ptr<StructType> partition_type);
 };
 
@@ -0,0 +1,606 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/manifest_entry_batch.h"
+
+#include <nanoarrow/nanoarrow.h>
+
+#include "iceberg/arrow/nanoarrow_status_internal.h"
+#include "iceberg/expression/literal.h"
+#include "iceberg/inheritable_metadata.h"
+#include "iceberg/schema.h"
+#include "iceberg/type.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief Returns the position of a field in a struct type, or nullopt if the struct
+/// has no field with the id.
+std::optional<int64_t> FieldPosition(const StructType& type, int32_t field_id) {
+  const auto& fields = type.fields();
+  for (size_t pos = 0; pos < fields.size(); ++pos) {
+    if (fields[pos].field_id() == field_id) {
+      return static_cast<int64_t>(pos);
+    }
+  }
+  return std::nullopt;
+}
+
+/// \brief Returns the view of the child of a struct view for a field, or nullptr if
+/// the field is optional and not part of the struct.
+Result<const ArrowArrayView*> ChildView(const ArrowArrayView* parent,
+                                        const StructType& type, int32_t field_id,
+                                        bool required, ArrowType storage_type) {
+  auto pos = FieldPosition(type, field_id);
+  if (!pos.has_value()) {
+    if (required) {
+      return InvalidManifest("Required field {} is missing in manifest entries",
+                             field_id);
+    }
+    return nullptr;
+  }
+  const ArrowArrayView* child = parent->children[pos.value()];
+  if (child->storage_type != storage_type) {
+    return InvalidManifest("Field {} should be a {} in manifest entries", field_id,
+                           ArrowTypeString(storage_type));
+  }
+  return child;
+}
+
+Result<const ArrowArrayView*> ChildView(const ArrowArrayView* parent,
+                                        const StructType& type,
+                                        const SchemaField& field,
+                                        ArrowType storage_type) {
+  return ChildView(parent, type, field.field_id(), !field.optional(), storage_type);
+}
+
+/// \brief Checks that a map view has integer keys and values of the given type.
+Status CheckMapView(const ArrowArrayView* map, ArrowType value_type) {
+  if (map == nullptr) {
+    return {};
+  }
+  const ArrowArrayView* entries = map->children[0];
+  if (entries->storage_type != ArrowType::NANOARROW_TYPE_STRUCT ||
+      entries->n_children != 2 ||
+      entries->children[0]->storage_type != ArrowType::NANOARROW_TYPE_INT32 ||
+      entries->children[1]->storage_type != value_type) {
+    return InvalidManifest("Metrics map should map int to {} in manifest entries",
+                           ArrowTypeString(value_type));
+  }
+  return {};
+}
+
+/// \brief Checks that a list view has elements of the given type.
+Status CheckListView(const ArrowArrayView* list, ArrowType element_type) {
+  if (list != nullptr && list->children[0]->storage_type != element_type) {
+    return InvalidManifest("List elements should be {} in manifest entries",
+                           ArrowTypeString(element_type));
+  }
+  return {};
+}
+
+std::optional<int64_t> GetOptionalInt(const ArrowArrayView* view, int64_t row) {
+  if (view == nullptr || ArrowArrayViewIsNull(view, row)) {
+    return std::nullopt;
+  }
+  return ArrowArrayViewGetIntUnsafe(view, row);
+}
+
+std::optional<std::string_view> GetOptionalString(const ArrowArrayView* view,
+                                                  int64_t row) {
+  if (view == nullptr || ArrowArrayViewIsNull(view, row)) {
+    return std::nullopt;
+  }
+  auto value = ArrowArrayViewGetStringUnsafe(view, row);
+  return std::string_view(value.data, value.size_bytes);
+}
+
+std::span<const uint8_t> GetBytes(const ArrowArrayView* view, int64_t index) {
+  auto buffer = ArrowArrayViewGetBytesUnsafe(view, index);
+  return {buffer.data.as_uint8, static_cast<size_t>(buffer.size_bytes)};
+}
+
+/// \brief Returns the range of map entries of a row.
+std::pair<int64_t, int64_t> MapRange(const ArrowArrayView* map, int64_t row) {
+  if (map == nullptr || ArrowArrayViewIsNull(map, row)) {
+    return {0, 0};
+  }
+  // ArrowArrayViewListChildOffset does not support maps, read the offsets directly.
+  const int32_t* offsets = map->buffer_views[1].data.as_int32 + map->offset;
+  return {offsets[row], offsets[row + 1]};
+}
+
+/// \brief Returns the index of the map entry of a row with the given key.
+std::optional<int64_t> FindMapEntry(const ArrowArrayView* map, int64_t row,
+                                    int32_t key) {
+  auto [begin, end] = MapRange(map, row);
+  for (int64_t index = begin; index < end; ++index) {
+    if (ArrowArrayViewGetIntUnsafe(map->children[0]->children[0], index) == key) {
+      return index;
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<int64_t> GetMapInt(const ArrowArrayView* map, int64_t row, int32_t key) {
+  auto index = FindMapEntry(map, row, key);
+  if (!index.has_value()) {
+    return std::nullopt;
+  }
+  return ArrowArrayViewGetIntUnsafe(map->children[0]->children[1], index.value());
+}
+
+std::optional<std::span<const uint8_t>> GetMapBytes(const ArrowArrayView* map,
+                                                    int64_t row, int32_t key) {
+  auto index = FindMapEntry(map, row, key);
+  if (!index.has_value()) {
+    return std::nullopt;
+  }
+  return GetBytes(map->children[0]->children[1], index.value());
+}
+
+void ReadIntMap(const ArrowArrayView* map, int64_t row,
+                std::map<int32_t, int64_t>& values) {
+  auto [begin, end] = MapRange(map, row);
+  for (int64_t index = begin; index < end; ++index) {
+    auto key = ArrowArrayViewGetIntUnsafe(map->children[0]->children[0], index);
+    values[static_cast<int32_t>(key)] =
+        ArrowArrayViewGetIntUnsafe(map->children[0]->children[1], index);
+  }
+}
+
+void ReadBytesMap(const ArrowArrayView* map, int64_t row,
+                  std::map<int32_t, std::vector<uint8_t>>& values) {
+  auto [begin, end] = MapRange(map, row);
+  for (int64_t index = begin; index < end; ++index) {
+    auto key = ArrowArrayViewGetIntUnsafe(map->children[0]->children[0], index);
+    auto bytes = GetBytes(map->children[0]->children[1], index);
+    values[static_cast<int32_t>(key)] = {bytes.begin(), bytes.end()};
+  }
+}
+
+template <typename T>
+void ReadIntList(const ArrowArrayView* list, int64_t row, std::vector<T>& values) {
+  if (list == nullptr || ArrowArrayViewIsNull(list, row)) {
+    return;
+  }
+  auto begin = ArrowArrayViewListChildOffset(list, row);
+  auto end = ArrowArrayViewListChildOffset(list, row + 1);
+  values.reserve(end - begin);
+  for (int64_t index = begin; index < end; ++index) {
+    values.push_back(
+        static_cast<T>(ArrowArrayViewGetIntUnsafe(list->children[0], index)));
+  }
+}
+
+/// \brief Decodes a partition value, in the same way as ManifestReader::Entries().
+Result<Literal> ReadPartitionValue(const ArrowArrayView* view, int64_t row,
+                                   const SchemaField& field) {
+  if (ArrowArrayViewIsNull(view, row)) {
+    return Literal::Null(internal::checked_pointer_cast<PrimitiveType>(field.type()));
+  }
+  switch (view->storage_type) {
+    case ArrowType::NANOARROW_TYPE_BOOL:
+      return Literal::Boolean(ArrowArrayViewGetUIntUnsafe(view, row) != 0);
+    case ArrowType::NANOARROW_TYPE_INT32:
+      return Literal::Int(static_cast<int32_t>(ArrowArrayViewGetIntUnsafe(view, row)));
+    case ArrowType::NANOARROW_TYPE_INT64:
+      return Literal::Long(ArrowArrayViewGetIntUnsafe(view, row));
+    case ArrowType::NANOARROW_TYPE_FLOAT:
+      return Literal::Float(static_cast<float>(ArrowArrayViewGetDoubleUnsafe(view, row)));
+    case ArrowType::NANOARROW_TYPE_DOUBLE:
+      return Literal::Double(ArrowArrayViewGetDoubleUnsafe(view, row));
+    case ArrowType::NANOARROW_TYPE_STRING: {
+      auto value = ArrowArrayViewGetStringUnsafe(view, row);
+      return Literal::String(std::string(value.data, value.size_bytes));
+    }
+    case ArrowType::NANOARROW_TYPE_BINARY: {
+      auto bytes = GetBytes(view, row);
+      return Literal::Binary(std::vector<uint8_t>(bytes.begin(), bytes.end()));
+    }
+    default:
+      return InvalidManifest("Unsupported field type: {} in data file partition.",
+                             static_cast<int32_t>(view->storage_type));
+  }
+}
+
+}  // namespace
+
+struct ManifestEntryBatch::Impl {
+  ~Impl() {
+    if (view_initialized) {
+      ArrowArrayViewReset(&view);
+    }
+  }
+
+  const ArrowSchema* partition_schema = nullptr;
+  const ArrowArray* partition_array = nullptr;
+  InheritableMetadata* inheritable_metadata = nullptr;
+  std::shared_ptr<StructType> partition_type;
+
+  ArrowArrayView view;
+  bool view_initialized = false;
+
+  const ArrowArrayView* status = nullptr;
+  const ArrowArrayView* snapshot_id = nullptr;
+  const ArrowArrayView* sequence_number = nullptr;
+  const ArrowArrayView* file_sequence_number = nullptr;
+
+  const ArrowArrayView* content = nullptr;
+  const ArrowArrayView* file_path = nullptr;
+  const ArrowArrayView* file_format = nullptr;
+  const ArrowArrayView* partition = nullptr;
+  const ArrowArrayView* record_count = nullptr;
+  const ArrowArrayView* file_size = nullptr;
+  const ArrowArrayView* column_sizes = nullptr;
+  const ArrowArrayView* value_counts = nullptr;
+  const ArrowArrayView* null_value_counts = nullptr;
+  const ArrowArrayView* nan_value_counts = nullptr;
+  const ArrowArrayView* lower_bounds = nullptr;
+  const ArrowArrayView* upper_bounds = nullptr;
+  const ArrowArrayView* key_metadata = nullptr;
+  const ArrowArrayView* split_offsets = nullptr;
+  const ArrowArrayView* equality_ids = nullptr;
+  const ArrowArrayView* sort_order_id = nullptr;
+  const ArrowArrayView* first_row_id = nullptr;
+  const ArrowArrayView* referenced_data_file = nullptr;
+  const ArrowArrayView* content_offset = nullptr;
+  const ArrowArrayView* content_size = nullptr;
+
+  // First row IDs inherited by the live data files without one, by row, or empty if
+  // the manifest does not assign row IDs.
+  std::vector<std::optional<int64_t>> inherited_first_row_ids;
+};
+
+ManifestEntryBatch::ManifestEntryBatch(std::unique_ptr<Impl> impl)
+    : impl_(std::move(impl)) {}
+
+ManifestEntryBatch::~ManifestEntryBatch() = default;
+
+ManifestEntryBatch::ManifestEntryBatch(ManifestEntryBatch&&) noexcept = default;
+
+ManifestEntryBatch& ManifestEntryBatch::operator=(ManifestEntryBatch&&) noexcept =
+    default;
+
+Result<ManifestEntryBatch> ManifestEntryBatch::Make(
+    const ArrowSchema& schema, const ArrowArray& array, const Schema& entry_schema,
+    InheritableMetadata* inheritable_metadata) {
+  if (schema.n_children != array.n_children ||
+      static_cast<size_t>(array.n_children) != entry_schema.fields().size()) {
+    return InvalidManifest("Columns size not match between schema:{} and array:{}",
+                           entry_schema.fields().size(), array.n_children);
+  }
+
+  auto impl = std::make_unique<Impl>();
+  impl->inheritable_metadata = inheritable_metadata;
+
+  ArrowError error;
+  auto status = ArrowArrayViewInitFromSchema(&impl->view, &schema, &error);
+  ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(status, error);
+  impl->view_initialized = true;
+  // The buffers of the batch are read in place. Setting the array checks their sizes,
+  // as ManifestReader::Entries() does, but not every offset of the decoded arrays.
+  status = ArrowArrayViewSetArray(&impl->view, &array, &error);
+  ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(status, error);
+
+  const ArrowArrayView* root = &impl->view;
+  const StructType& entry_type = entry_schema;
+  ICEBERG_ASSIGN_OR_RAISE(impl->status,
+                          ChildView(root, entry_type, ManifestEntry::kStatus,
+                                    ArrowType::NANOARROW_TYPE_INT32));
+  ICEBERG_ASSIGN_OR_RAISE(impl->snapshot_id,
+                          ChildView(root, entry_type, ManifestEntry::kSnapshotId,
+                                    ArrowType::NANOARROW_TYPE_INT64));
+  ICEBERG_ASSIGN_OR_RAISE(impl->sequence_number,
+                          ChildView(root, entry_type, ManifestEntry::kSequenceNumber,
+                                    ArrowType::NANOARROW_TYPE_INT64));
+  ICEBERG_ASSIGN_OR_RAISE(
+      impl->file_sequence_number,
+      ChildView(root, entry_type, ManifestEntry::kFileSequenceNumber,
+                ArrowType::NANOARROW_TYPE_INT64));
+
+  auto data_file_pos = FieldPosition(entry_type, ManifestEntry::kDataFileFieldId);
+  if (!data_file_pos.has_value()) {
+    return InvalidManifest("Field {} is missing in manifest entries",
+                           ManifestEntry::kDataFileField);
+  }
+  const auto& data_file_type = internal::checked_cast<const StructType&>(
+      *entry_type.fields()[data_file_pos.value()].type());
+  ICEBERG_ASSIGN_OR_RAISE(
+      const ArrowArrayView* data_file,
+      ChildView(root, entry_type, ManifestEntry::kDataFileFieldId, /*required=*/true,
+                ArrowType::NANOARROW_TYPE_STRUCT));
+
+  ICEBERG_ASSIGN_OR_RAISE(impl->content,
+                          ChildView(data_file, data_file_type, DataFile::kContent,
+                                    ArrowType::NANOARROW_TYPE_INT32));
+  ICEBERG_ASSIGN_OR_RAISE(impl->file_path,
+                          ChildView(data_file, data_file_type, DataFile::kFilePath,
+                                    ArrowType::NANOARROW_TYPE_STRING));
+  ICEBERG_ASSIGN_OR_RAISE(impl->file_format,
+                          ChildView(data_file, data_file_type, DataFile::kFileFormat,
+                                    ArrowType::NANOARROW_TYPE_STRING));
+  ICEBERG_ASSIGN_OR_RAISE(
+      impl->partition,
+      ChildView(data_file, data_file_type, DataFile::kPartitionFieldId,
+                /*required=*/true, ArrowType::NANOARROW_TYPE_STRUCT));
+  ICEBERG_ASSIGN_OR_RAISE(impl->record_count,
+                          ChildView(data_file, data_file_type, DataFile::kRecordCount,
+                                    ArrowType::NANOARROW_TYPE_INT64));
+  ICEBERG_ASSIGN_OR_RAISE(impl->file_size,
+                          ChildView(data_file, data_file_type, DataFile::kFileSize,
+                                    ArrowType::NANOARROW_TYPE_INT64));
+  ICEBERG_ASSIGN_OR_RAISE(impl->column_sizes,
+                          ChildView(data_file, data_file_type, DataFile::kColumnSizes,
+                                    ArrowType::NANOARROW_TYPE_MAP));
+  ICEBERG_ASSIGN_OR_RAISE(impl->value_counts,
+                          ChildView(data_file, data_file_type, DataFile::kValueCounts,
+                                    ArrowType::NANOARROW_TYPE_MAP));
+  ICEBERG_ASSIGN_OR_RAISE(impl->null_value_counts,
+                          ChildView(data_file, data_file_type, DataFile::kNullValueCounts,
+                                    ArrowType::NANOARROW_TYPE_MAP));
+  ICEBERG_ASSIGN_OR_RAISE(impl->nan_value_counts,
+                          ChildView(data_file, data_file_type, DataFile::kNanValueCounts,
+                                    ArrowType::NANOARROW_TYPE_MAP));
+  ICEBERG_ASSIGN_OR_RAISE(impl->lower_bounds,
+                          ChildView(data_file, data_file_type, DataFile::kLowerBounds,
+                                    ArrowType::NANOARROW_TYPE_MAP));
+  ICEBERG_ASSIGN_OR_RAISE(impl->upper_bounds,
+                          ChildView(data_file, data_file_type, DataFile::kUpperBounds,
+                                    ArrowType::NANOARROW_TYPE_MAP));
+  ICEBERG_ASSIGN_OR_RAISE(impl->key_metadata,
+                          ChildView(data_file, data_file_type, DataFile::kKeyMetadata,
+                                    ArrowType::NANOARROW_TYPE_BINARY));
+  ICEBERG_ASSIGN_OR_RAISE(impl->split_offsets,
+                          ChildView(data_file, data_file_type, DataFile::kSplitOffsets,
+                                    ArrowType::NANOARROW_TYPE_LIST));
+  ICEBERG_ASSIGN_OR_RAISE(impl->equality_ids,
+                          ChildView(data_file, data_file_type, DataFile::kEqualityIds,
+                                    ArrowType::NANOARROW_TYPE_LIST));
+  ICEBERG_ASSIGN_OR_RAISE(impl->sort_order_id,
+                          ChildView(data_file, data_file_type, DataFile::kSortOrderId,
+                                    ArrowType::NANOARROW_TYPE_INT32));
+  ICEBERG_ASSIGN_OR_RAISE(impl->first_row_id,
+                          ChildView(data_file, data_file_type, DataFile::kFirstRowId,
+                                    ArrowType::NANOARROW_TYPE_INT64));
+  ICEBERG_ASSIGN_OR_RAISE(
+      impl->referenced_data_file,
+      ChildView(data_file, data_file_type, DataFile::kReferencedDataFile,
+                ArrowType::NANOARROW_TYPE_STRING));
+  ICEBERG_ASSIGN_OR_RAISE(impl->content_offset,
+                          ChildView(data_file, data_file_type, DataFile::kContentOffset,
+                                    ArrowType::NANOARROW_TYPE_INT64));
+  ICEBERG_ASSIGN_OR_RAISE(impl->content_size,
+                          ChildView(data_file, data_file_type, DataFile::kContentSize,
+                                    ArrowType::NANOARROW_TYPE_INT64));
+
+  for (const auto* map : {impl->column_sizes, impl->value_counts,
+                          impl->null_value_counts, impl->nan_value_counts}) {
+    ICEBERG_RETURN_UNEXPECTED(CheckMapView(map, ArrowType::NANOARROW_TYPE_INT64));
+  }
+  for (const auto* map : {impl->lower_bounds, impl->upper_bounds}) {
+    ICEBERG_RETURN_UNEXPECTED(CheckMapView(map, ArrowType::NANOARROW_TYPE_BINARY));
+  }
+  ICEBERG_RETURN_UNEXPECTED(
+      CheckListView(impl->split_offsets, ArrowType::NANOARROW_TYPE_INT64));
+  ICEBERG_RETURN_UNEXPECTED(
+      CheckListView(impl->equality_ids, ArrowType::NANOARROW_TYPE_INT32));
+
+  auto partition_pos =
+      FieldPosition(data_file_type, DataFile::kPartitionFieldId).value();
+  impl->partition_type = internal::checked_pointer_cast<StructType>(
+      data_file_type.fields()[partition_pos].type());
+  if (impl->partition->n_children !=
+      static_cast<int64_t>(impl->partition_type->fields().size())) {
+    return InvalidManifest("Partition struct has {} columns but the spec has {} fields",
+                           impl->partition->n_children,
+                           impl->partition_type->fields().size());
+  }
+  impl->partition_schema = schema.children[*data_file_pos]->children[partition_pos];
+  impl->partition_array = array.children[*data_file_pos]->children[partition_pos];
+
+  // Row IDs are assigned to all the live data files of the batch at once, so that they
+  // do not depend on which entries are materialized.
+  ManifestEntryBatch batch(std::move(impl));
+  if (inheritable_metadata != nullptr &&
+      inheritable_metadata->AssignFirstRowId(0).has_value()) {
+    auto& first_row_ids = batch.impl_->inherited_first_row_ids;
+    first_row_ids.resize(batch.size());
+    for (int64_t row = 0; row < batch.size(); ++row) {
+      if (batch.status(row) != ManifestStatus::kDeleted &&
+          batch.content(row) == DataFile::Content::kData &&
+          !GetOptionalInt(batch.impl_->first_row_id, row).has_value()) {
+        first_row_ids[row] =
+            inheritable_metadata->AssignFirstRowId(batch.record_count(row));
+      }
+    }
+  }
+  return batch;
+}
+
+int64_t ManifestEntryBatch::size() const { return impl_->view.length; }
+
+ManifestStatus ManifestEntryBatch::status(int64_t row) const {
+  return static_cast<ManifestStatus>(ArrowArrayViewGetIntUnsafe(impl_->status, row));
+}
+
+std::optional<int64_t> ManifestEntryBatch::snapshot_id(int64_t row) const {
+  return GetOptionalInt(impl_->snapshot_id, row);
+}
+
+std::optional<int64_t> ManifestEntryBatch::sequence_number(int64_t row) const {
+  return GetOptionalInt(impl_->sequence_number, row);
+}
+
+std::optional<int64_t> ManifestEntryBatch::file_sequence_number(int64_t row) const {
+  return GetOptionalInt(impl_->file_sequence_number, row);
+}
+
+DataFile::Content ManifestEntryBatch::content(int64_t row) const {
+  return static_cast<DataFile::Content>(
+      GetOptionalInt(impl_->content, row)
+          .value_or(static_cast<int64_t>(DataFile::Content::kData)));
+}
+
+std::string_view ManifestEntryBatch::file_path(int64_t row) const {
+  return GetOptionalString(impl_->file_path, row).value_or("");
+}
+
+Result<FileFormatType> ManifestEntryBatch::file_format(int64_t row) const {
+  auto format = GetOptionalString(impl_->file_format, row);
+  if (!format.has_value()) {
+    return InvalidManifest("Field {} is required but null at row {}",
+                           DataFile::kFileFormat.name(), row);
+  }
+  return FileFormatTypeFromString(format.value());
+}
+
+Result<std::vector<Literal>> ManifestEntryBatch::partition(int64_t row) const {
+  const auto& fields = impl_->partition_type->fields();
+  std::vector<Literal> partition;
+  partition.reserve(fields.size());
+  for (size_t pos = 0; pos < fields.size(); ++pos) {
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto value,
+        ReadPartitionValue(impl_->partition->children[pos], row, fields[pos]));
+    partition.push_back(std::move(value));
+  }
+  return partition;
+}
+
+int64_t ManifestEntryBatch::record_count(int64_t row) const {
+  return ArrowArrayViewGetIntUnsafe(impl_->record_count, row);
+}
+
+int64_t ManifestEntryBatch::file_size_in_bytes(int64_t row) const {
+  return ArrowArrayViewGetIntUnsafe(impl_->file_size, row);
+}
+
+std::optional<int64_t> ManifestEntryBatch::column_size(int64_t row,
+                                                       int32_t field_id) const {
+  return GetMapInt(impl_->column_sizes, row, field_id);
+}
+
+std::optional<int64_t> ManifestEntryBatch::value_count(int64_t row,
+                                                       int32_t field_id) const {
+  return GetMapInt(impl_->value_counts, row, field_id);
+}
+
+std::optional<int64_t> ManifestEntryBatch::null_value_count(int64_t row,
+                                                            int32_t field_id) const {
+  return GetMapInt(impl_->null_value_counts, row, field_id);
+}
+
+std::optional<int64_t> ManifestEntryBatch::nan_value_count(int64_t row,
+                                                           int32_t field_id) const {
+  return GetMapInt(impl_->nan_value_counts, row, field_id);
+}
+
+std::optional<std::span<const uint8_t>> ManifestEntryBatch::lower_bound(
+    int64_t row, int32_t field_id) const {
+  return GetMapBytes(impl_->lower_bounds, row, field_id);
+}
+
+std::optional<std::span<const uint8_t>> ManifestEntryBatch::upper_bound(
+    int64_t row, int32_t field_id) const {
+  return GetMapBytes(impl_->upper_bounds, row, field_id);
+}
+
+std::span<const int64_t> ManifestEntryBatch::split_offsets(int64_t row) const {
+  const ArrowArrayView* list = impl_->split_offsets;
+  if (list == nullptr || ArrowArrayViewIsNull(list, row)) {
+    return {};
+  }
+  auto begin = ArrowArrayViewListChildOffset(list, row);
+  auto end = ArrowArrayViewListChildOffset(list, row + 1);
+  const ArrowArrayView* elements = list->children[0];
+  const int64_t* values = elements->buffer_views[1].data.as_int64 + elements->offset;
+  return {values + begin, static_cast<size_t>(end - begin)};
+}
+
+std::optional<int64_t> ManifestEntryBatch::first_row_id(int64_t row) const {
+  if (auto first_row_id = GetOptionalInt(impl_->first_row_id, row)) {
+    return first_row_id;
+  }
+  if (impl_->inherited_first_row_ids.empty()) {
+    return std::nullopt;
+  }
+  return impl_->inherited_first_row_ids[row];
+}
+
+const ArrowSchema& ManifestEntryBatch::partition_schema() const {
+  return *impl_->partition_schema;
+}
+
+const ArrowArray& ManifestEntryBatch::partition_array() const {
+  return *impl_->partition_array;
+}
+
+Result<ManifestEntry> ManifestEntryBatch::Entry(int64_t row) const {
+  if (row < 0 || row >= size()) {
+    return InvalidArgument("Row {} is out of range for a batch of {} entries", row,
+                           size());
+  }
+
+  ManifestEntry entry;
+  entry.status = status(row);
+  entry.snapshot_id = snapshot_id(row);
+  entry.sequence_number = sequence_number(row);
+  entry.file_sequence_number = file_sequence_number(row);
+
+  auto file = std::make_shared<DataFile>();
+  file->content = content(row);
+  file->file_path = std::string(file_path(row));
+  ICEBERG_ASSIGN_OR_RAISE(file->file_format, file_format(row));
+  ICEBERG_ASSIGN_OR_RAISE(file->partition, partition(row));
+  file->record_count = record_count(row);
+  file->file_size_in_bytes = file_size_in_bytes(row);
+  ReadIntMap(impl_->column_sizes, row, file->column_sizes);
+  ReadIntMap(impl_->value_counts, row, file->value_counts);
+  ReadIntMap(impl_->null_value_counts, row, file->null_value_counts);
+  ReadIntMap(impl_->nan_value_counts, row, file->nan_value_counts);
+  ReadBytesMap(impl_->lower_bounds, row, file->lower_bounds);
+  ReadBytesMap(impl_->upper_bounds, row, file->upper_bounds);
+  if (impl_->key_metadata != nullptr && !ArrowArrayViewIsNull(impl_->key_metadata, row)) {
+    auto bytes = GetBytes(impl_->key_metadata, row);
+    file->key_metadata.assign(bytes.begin(), bytes.end());
+  }
+  ReadIntList(impl_->split_offsets, row, file->split_offsets);
+  ReadIntList(impl_->equality_ids, row, file->equality_ids);
+  if (auto sort_order_id = GetOptionalInt(impl_->sort_order_id, row)) {
+    file->sort_order_id = static_cast<int32_t>(sort_order_id.value());
+  }
+  file->first_row_id = first_row_id(row);
+  if (auto referenced = GetOptionalString(impl_->referenced_data_file, row)) {
+    file->referenced_data_file = std::string(referenced.value());
+  }
+  file->content_offset = GetOptionalInt(impl_->content_offset, row);
+  file->content_size_in_bytes = GetOptionalInt(impl_->content_size, row);
+  entry.data_file = std::move(file);
+
+  if (impl_->inheritable_metadata != nullptr) {
+    ICEBERG_RETURN_UNEXPECTED(impl_->inheritable_metadata->Apply(entry));
+  }
+  return entry;
+}
+
+}  // namespace iceberg
@@ -0,0 +1,134 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/manifest_entry_batch.h
+/// Columnar view over a batch of decoded manifest entries.
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "iceberg/arrow_c_data.h"
+#include "iceberg/file_format.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief A read-only columnar view over a batch of manifest entries.
+///
+/// The accessors read the values of a row directly from the decoded Arrow arrays, so
+/// entries can be filtered on their status, path, partition or metrics without
+/// allocating a DataFile for each of them. Entry() materializes a single row when it is
+/// needed.
+///
+/// The view does not own the arrays it reads and is only valid while they are alive,
+/// i.e. for the duration of the ManifestReader::VisitBatches() callback it is passed to.
+class ICEBERG_EXPORT ManifestEntryBatch {
+ public:
+  ~ManifestEntryBatch();
+
+  ManifestEntryBatch(ManifestEntryBatch&&) noexcept;
+  ManifestEntryBatch& operator=(ManifestEntryBatch&&) noexcept;
+
+  /// \brief Creates a view over a batch of manifest entries.
+  ///
+  /// \param schema The Arrow schema of the batch
+  /// \param array The struct array of the batch
+  /// \param entry_schema The manifest entry schema the batch was read with
+  /// \param inheritable_metadata Metadata applied to the entries materialized by
+  /// Entry(), or nullptr to apply none
+  static Result<ManifestEntryBatch> Make(const ArrowSchema& schema,
+                                         const ArrowArray& array,
+                                         const Schema& entry_schema,
+                                         InheritableMetadata* inheritable_metadata);
+
+  /// \brief Returns the number of entries in the batch.
+  int64_t size() const;
+
+  /// \brief Returns the status of an entry.
+  ManifestStatus status(int64_t row) const;
+  /// \brief Returns the snapshot id of an entry as stored, before inheritance.
+  std::optional<int64_t> snapshot_id(int64_t row) const;
+  /// \brief Returns the data sequence number of an entry as stored, before inheritance.
+  std::optional<int64_t> sequence_number(int64_t row) const;
+  /// \brief Returns the file sequence number of an entry as stored, before inheritance.
+  std::optional<int64_t> file_sequence_number(int64_t row) const;
+
+  /// \brief Returns the content type of the file of an entry.
+  DataFile::Content content(int64_t row) const;
+  /// \brief Returns the location of the file of an entry.
+  std::string_view file_path(int64_t row) const;
+  /// \brief Returns the format of the file of an entry.
+  Result<FileFormatType> file_format(int64_t row) const;
+  /// \brief Returns the partition tuple of the file of an entry.
+  Result<std::vector<Literal>> partition(int64_t row) const;
+  /// \brief Returns the number of records in the file of an entry.
+  int64_t record_count(int64_t row) const;
+  /// \brief Returns the size in bytes of the file of an entry.
+  int64_t file_size_in_bytes(int64_t row) const;
+
+  /// \brief Returns the size on disk of a column in the file of an entry.
+  std::optional<int64_t> column_size(int64_t row, int32_t field_id) const;
+  /// \brief Returns the number of values, including nulls and NaNs, of a column in the
+  /// file of an entry.
+  std::optional<int64_t> value_count(int64_t row, int32_t field_id) const;
+  /// \brief Returns the number of null values of a column in the file of an entry.
+  std::optional<int64_t> null_value_count(int64_t row, int32_t field_id) const;
+  /// \brief Returns the number of NaN values of a column in the file of an entry.
+  std::optional<int64_t> nan_value_count(int64_t row, int32_t field_id) const;
+  /// \brief Returns the serialized lower bound of a column in the file of an entry.
+  std::optional<std::span<const uint8_t>> lower_bound(int64_t row,
+                                                      int32_t field_id) const;
+  /// \brief Returns the serialized upper bound of a column in the file of an entry.
+  std::optional<std::span<const uint8_t>> upper_bound(int64_t row,
+                                                      int32_t field_id) const;
+  /// \brief Returns the split offsets of the file of an entry, empty when unset.
+  std::span<const int64_t> split_offsets(int64_t row) const;
+  /// \brief Returns the first row ID of the file of an entry, inherited from the
+  /// manifest by the live data files without one.
+  std::optional<int64_t> first_row_id(int64_t row) const;
+
+  /// \brief Returns the Arrow schema of the partition struct column.
+  ///
+  /// Together with partition_array() this allows a BatchEvaluator on the partition
+  /// schema to evaluate a partition filter on all entries of the batch at once.
+  const ArrowSchema& partition_schema() const;
+  /// \brief Returns the partition struct column of the batch.
+  const ArrowArray& partition_array() const;
+
+  /// \brief Materializes an entry, applying the inheritable metadata of the manifest.
+  Result<ManifestEntry> Entry(int64_t row) const;
+
+ private:
+  struct Impl;
+
+  explicit ManifestEntryBatch(std::unique_ptr<Impl> impl);
+
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace iceberg
@@ -153,6 +153,10 @@ struct ICEBERG_EXPORT ManifestFile {
   /// \brief Checks if this manifest file contains entries with DELETED status
   bool has_deleted_files() const { return deleted_files_count.value_or(1) > 0; }
 
+  /// \brief Checks if this manifest file contains entries with ADDED or EXISTING status,
+  /// which are the files live in the snapshot that lists it.
+  bool has_live_files() const { return has_added_files() || has_existing_files(); }
+
   inline static const SchemaField kManifestPath = SchemaField::MakeRequired(
       500, "manifest_path", iceberg::string(), "Location URI with FS scheme");
   inline static const SchemaField kManifestLength = SchemaField::MakeRequired(
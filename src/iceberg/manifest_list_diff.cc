@@ -0,0 +1,108 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/manifest_list_diff.h"
+
+#include <string_view>
+#include <unordered_set>
+
+#include "iceberg/manifest_reader.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+ManifestListDiffer::ManifestListDiffer(std::shared_ptr<FileIO> io) : io_(std::move(io)) {}
+
+ManifestListDiffer::~ManifestListDiffer() = default;
+
+Result<std::shared_ptr<const std::vector<ManifestFile>>>
+ManifestListDiffer::ReadManifestList(const std::string& manifest_list_location) {
+  if (cached_manifests_ != nullptr && cached_location_ == manifest_list_location) {
+    return cached_manifests_;
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto reader,
+                          ManifestListReader::Make(manifest_list_location, io_));
+  ICEBERG_ASSIGN_OR_RAISE(auto files, reader->Files());
+  return std::make_shared<const std::vector<ManifestFile>>(std::move(files));
+}
+
+Result<ManifestListChanges> ManifestListDiffer::Diff(
+    const TableMetadata& metadata, std::optional<int64_t> from_snapshot_id,
+    int64_t to_snapshot_id) {
+  ICEBERG_ASSIGN_OR_RAISE(auto to_snapshot, metadata.SnapshotById(to_snapshot_id));
+  ICEBERG_ASSIGN_OR_RAISE(auto to_manifests,
+                          ReadManifestList(to_snapshot->manifest_list));
+
+  ManifestListChanges changes;
+  if (!from_snapshot_id.has_value()) {
+    changes.added_manifests = *to_manifests;
+  } else if (from_snapshot_id.value() != to_snapshot_id) {
+    ICEBERG_ASSIGN_OR_RAISE(auto from_snapshot,
+                            metadata.SnapshotById(from_snapshot_id.value()));
+    ICEBERG_ASSIGN_OR_RAISE(auto from_manifests,
+                            ReadManifestList(from_snapshot->manifest_list));
+
+    // Collect the snapshots after the older snapshot in the lineage of the newer one.
+    std::unordered_set<int64_t> new_snapshot_ids;
+    auto snapshot = to_snapshot;
+    while (snapshot->snapshot_id != from_snapshot->snapshot_id) {
+      new_snapshot_ids.insert(snapshot->snapshot_id);
+      if (!snapshot->parent_snapshot_id.has_value()) {
+        break;
+      }
+      auto parent = metadata.SnapshotById(snapshot->parent_snapshot_id.value());
+      if (!parent.has_value()) {
+        // The rest of the lineage has expired.
+        break;
+      }
+      snapshot = std::move(parent.value());
+    }
+    bool from_is_ancestor = snapshot->snapshot_id == from_snapshot->snapshot_id;
+
+    std::unordered_set<std::string_view> from_paths;
+    if (!from_is_ancestor) {
+      for (const auto& manifest : *from_manifests) {
+        from_paths.insert(manifest.manifest_path);
+      }
+    }
+    std::unordered_set<std::string_view> to_paths;
+    for (const auto& manifest : *to_manifests) {
+      to_paths.insert(manifest.manifest_path);
+      bool added = from_is_ancestor
+                       ? new_snapshot_ids.contains(manifest.added_snapshot_id)
+                       : !from_paths.contains(manifest.manifest_path);
+      if (added) {
+        changes.added_manifests.push_back(manifest);
+      }
+    }
+    for (const auto& manifest : *from_manifests) {
+      if (!to_paths.contains(manifest.manifest_path)) {
+        changes.removed_manifests.push_back(manifest);
+      }
+    }
+  }
+
+  cached_location_ = to_snapshot->manifest_list;
+  cached_manifests_ = std::move(to_manifests);
+  return changes;
+}
+
+}  // namespace iceberg
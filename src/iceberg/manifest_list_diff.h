@@ -0,0 +1,84 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/manifest_list_diff.h
+/// Incremental comparison of the manifest lists of two snapshots.
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief The manifests added and removed between two snapshots.
+struct ICEBERG_EXPORT ManifestListChanges {
+  /// \brief Manifests of the newer snapshot that the older snapshot does not have.
+  std::vector<ManifestFile> added_manifests;
+  /// \brief Manifests of the older snapshot that the newer snapshot does not have.
+  std::vector<ManifestFile> removed_manifests;
+};
+
+/// \brief Computes the manifests that changed between snapshots of a table.
+///
+/// The differ is meant for readers that poll a table for new snapshots and diff each
+/// new snapshot against the previously planned one: the manifest list of the newer
+/// snapshot of a diff is kept, so that the next diff against it only reads the manifest
+/// list of the new snapshot. When the older snapshot is an ancestor of the newer one, the
+/// added manifests are the ones added by the snapshots in between, which is given by
+/// their added_snapshot_id.
+///
+/// The differ is not thread-safe.
+class ICEBERG_EXPORT ManifestListDiffer {
+ public:
+  /// \brief Creates a differ reading manifest lists with the given FileIO.
+  explicit ManifestListDiffer(std::shared_ptr<FileIO> io);
+
+  ~ManifestListDiffer();
+
+  /// \brief Returns the manifests that changed between two snapshots of a table.
+  ///
+  /// \param metadata The metadata of the table, which has both snapshots
+  /// \param from_snapshot_id The previously planned snapshot, or nullopt to return all
+  /// manifests of the newer snapshot as added
+  /// \param to_snapshot_id The newer snapshot
+  Result<ManifestListChanges> Diff(const TableMetadata& metadata,
+                                   std::optional<int64_t> from_snapshot_id,
+                                   int64_t to_snapshot_id);
+
+ private:
+  /// \brief Returns the manifests of a manifest list, from the kept one if it matches.
+  Result<std::shared_ptr<const std::vector<ManifestFile>>> ReadManifestList(
+      const std::string& manifest_list_location);
+
+  std::shared_ptr<FileIO> io_;
+  // The manifest list of the newer snapshot of the last diff.
+  std::string cached_location_;
+  std::shared_ptr<const std::vector<ManifestFile>> cached_manifests_;
+};
+
+}  // namespace iceberg
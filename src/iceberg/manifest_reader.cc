@@ -19,21 +19,53 @@
 
 #include "iceberg/manifest_reader.h"
 
+#include <algorithm>
+
+#include "iceberg/async.h"
+#include "iceberg/manifest_cache.h"
 #include "iceberg/manifest_entry.h"
 #include "iceberg/manifest_list.h"
 #include "iceberg/manifest_reader_internal.h"
 #include "iceberg/schema.h"
 #include "iceberg/schema_internal.h"
 #include "iceberg/util/macros.h"
+#include "iceberg/util/tracing.h"
 
 namespace iceberg {
 
-Result<std::unique_ptr<ManifestReader>> ManifestReader::Make(
+namespace {
+
+/// \brief Returns the schema to read manifest entries with, which only has the selected
+/// optional data file fields.
+Result<std::shared_ptr<Schema>> ManifestEntrySchema(
+    std::shared_ptr<Schema> partition_schema, const std::vector<std::string>& columns) {
+  auto data_file_type = DataFile::Type(std::move(partition_schema));
+  if (!columns.empty()) {
+    for (const auto& column : columns) {
+      ICEBERG_ASSIGN_OR_RAISE(auto field, data_file_type->GetFieldByName(column));
+      if (!field.has_value()) {
+        return InvalidArgument("Cannot select unknown data file field: {}", column);
+      }
+    }
+    std::vector<SchemaField> fields;
+    for (const auto& field : data_file_type->fields()) {
+      if (!field.optional() || field.field_id() == DataFile::kContent.field_id() ||
+          std::ranges::find(columns, field.name()) != columns.end()) {
+        fields.push_back(field);
+      }
+    }
+    data_file_type = std::make_shared<StructType>(std::move(fields));
+  }
+  auto manifest_entry_type =
+      ManifestEntry::TypeFromDataFileType(std::move(data_file_type));
+  return FromStructType(std::move(*manifest_entry_type), std::nullopt);
+}
+
+Result<std::unique_ptr<ManifestReader>> MakeManifestReader(
     const ManifestFile& manifest, std::shared_ptr<FileIO> file_io,
-    std::shared_ptr<Schema> partition_schema) {
-  auto manifest_entry_schema = ManifestEntry::TypeFromPartitionType(partition_schema);
-  std::shared_ptr<Schema> schema =
-      FromStructType(std::move(*manifest_entry_schema), std::nullopt);
+    std::shared_ptr<Schema> partition_schema, const ManifestReadOptions& options) {
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto schema, ManifestEntrySchema(std::move(partition_schema), options.columns));
 
   ICEBERG_ASSIGN_OR_RAISE(auto reader,
                           ReaderFactoryRegistry::Open(FileFormatType::kAvro,
@@ -46,16 +78,94 @@ Result<std::unique_ptr<ManifestReader>> ManifestReader::Make(
                           InheritableMetadataFactory::FromManifest(manifest));
 
   return std::make_unique<ManifestReaderImpl>(std::move(reader), std::move(schema),
-                                              std::move(inheritable_metadata));
+                                              std::move(inheritable_metadata),
+                                              options.stats_field_ids,
+                                              options.statuses);
+}
+
+Result<std::unique_ptr<ManifestListReader>> MakeManifestListReader(
+    std::string_view manifest_list_location, std::shared_ptr<FileIO> file_io) {
+  std::vector<SchemaField> fields(ManifestFile::Type().fields().begin(),
+                                  ManifestFile::Type().fields().end());
+  auto schema = std::make_shared<Schema>(fields);
+  ICEBERG_ASSIGN_OR_RAISE(auto reader, ReaderFactoryRegistry::Open(
+                                           FileFormatType::kAvro,
+                                           {.path = std::string(manifest_list_location),
+                                            .io = std::move(file_io),
+                                            .projection = schema}));
+  return std::make_unique<ManifestListReaderImpl>(std::move(reader), std::move(schema));
+}
+
+}  // namespace
+
+Task<Result<std::vector<ManifestEntry>>> ManifestReader::EntriesAsync(
+    std::shared_ptr<Executor> executor) const {
+  return RunOn(std::move(executor), [this]() { return Entries(); });
+}
+
+Status ManifestReader::VisitEntries(
+    const std::function<Status(ManifestEntry&&)>& visitor) const {
+  ICEBERG_ASSIGN_OR_RAISE(auto entries, Entries());
+  for (auto& entry : entries) {
+    ICEBERG_RETURN_UNEXPECTED(visitor(std::move(entry)));
+  }
+  return {};
+}
+
+Status ManifestReader::VisitBatches(
+    const std::function<Status(const ManifestEntryBatch&)>& /*visitor*/) const {
+  return NotSupported("Manifest reader does not support visiting entry batches");
+}
+
+Result<std::vector<ManifestEntry>> CachedManifestReader::Entries() const {
+  ICEBERG_TRACE_SCOPE(trace, "CachedManifestReader::Entries");
+  ICEBERG_TRACE_ATTRIBUTE(trace, "path", manifest_.manifest_path);
+  if (auto entries = cache_->GetEntries(manifest_); entries != nullptr) {
+    ICEBERG_TRACE_ATTRIBUTE(trace, "cache_hit", int64_t{1});
+    ICEBERG_TRACE_ATTRIBUTE(trace, "rows", static_cast<int64_t>(entries->size()));
+    return *entries;
+  }
+  ICEBERG_TRACE_ATTRIBUTE(trace, "cache_hit", int64_t{0});
+  ICEBERG_ASSIGN_OR_RAISE(auto reader,
+                          MakeManifestReader(manifest_, file_io_, partition_schema_,
+                                             ManifestReadOptions{}));
+  ICEBERG_ASSIGN_OR_RAISE(auto entries, reader->Entries());
+  ICEBERG_TRACE_ATTRIBUTE(trace, "rows", static_cast<int64_t>(entries.size()));
+  cache_->PutEntries(manifest_, entries);
+  return entries;
+}
+
+Result<std::vector<ManifestFile>> CachedManifestListReader::Files() const {
+  if (auto files = cache_->GetManifestFiles(manifest_list_location_); files != nullptr) {
+    return *files;
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto reader,
+                          MakeManifestListReader(manifest_list_location_, file_io_));
+  ICEBERG_ASSIGN_OR_RAISE(auto files, reader->Files());
+  cache_->PutManifestFiles(manifest_list_location_, files);
+  return files;
+}
+
+Result<std::unique_ptr<ManifestReader>> ManifestReader::Make(
+    const ManifestFile& manifest, std::shared_ptr<FileIO> file_io,
+    std::shared_ptr<Schema> partition_schema, const ManifestReadOptions& options) {
+  // The cache only holds complete entries.
+  bool reads_all = options.columns.empty() && !options.stats_field_ids.has_value() &&
+                   options.statuses.empty();
+  if (auto cache = ManifestCache::Global(); cache != nullptr && reads_all) {
+    return std::make_unique<CachedManifestReader>(manifest, std::move(file_io),
+                                                  std::move(partition_schema),
+                                                  std::move(cache));
+  }
+  return MakeManifestReader(manifest, std::move(file_io), std::move(partition_schema),
+                            options);
 }
 
 Result<std::unique_ptr<ManifestReader>> ManifestReader::Make(
     std::string_view manifest_location, std::shared_ptr<FileIO> file_io,
-    std::shared_ptr<Schema> partition_schema) {
-  auto manifest_entry_schema = ManifestEntry::TypeFromPartitionType(partition_schema);
-  auto fields_span = manifest_entry_schema->fields();
-  std::vector<SchemaField> fields(fields_span.begin(), fields_span.end());
-  auto schema = std::make_shared<Schema>(fields);
+    std::shared_ptr<Schema> partition_schema, const ManifestReadOptions& options) {
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto schema, ManifestEntrySchema(std::move(partition_schema), options.columns));
   ICEBERG_ASSIGN_OR_RAISE(
       auto reader, ReaderFactoryRegistry::Open(FileFormatType::kAvro,
                                                {.path = std::string(manifest_location),
@@ -63,20 +173,20 @@ Result<std::unique_ptr<ManifestReader>> ManifestReader::Make(
                                                 .projection = schema}));
   ICEBERG_ASSIGN_OR_RAISE(auto inheritable_metadata, InheritableMetadataFactory::Empty());
   return std::make_unique<ManifestReaderImpl>(std::move(reader), std::move(schema),
-                                              std::move(inheritable_metadata));
+                                              std::move(inheritable_metadata),
+                                              options.stats_field_ids,
+                                              options.statuses);
 }
 
 Result<std::unique_ptr<ManifestListReader>> ManifestListReader::Make(
     std::string_view manifest_list_location, std::shared_ptr<FileIO> file_io) {
-  std::vector<SchemaField> fields(ManifestFile::Type().fields().begin(),
-                                  ManifestFile::Type().fields().end());
-  auto schema = std::make_shared<Schema>(fields);
-  ICEBERG_ASSIGN_OR_RAISE(auto reader, ReaderFactoryRegistry::Open(
-                                           FileFormatType::kAvro,
-                                           {.path = std::string(manifest_list_location),
-                                            .io = std::move(file_io),
-                                            .projection = schema}));
-  return std::make_unique<ManifestListReaderImpl>(std::move(reader), std::move(schema));
+  ICEBERG_TRACE_SCOPE(trace, "ManifestListReader::Make");
+  ICEBERG_TRACE_ATTRIBUTE(trace, "path", manifest_list_location);
+  if (auto cache = ManifestCache::Global(); cache != nullptr) {
+    return std::make_unique<CachedManifestListReader>(
+        std::string(manifest_list_location), std::move(file_io), std::move(cache));
+  }
+  return MakeManifestListReader(manifest_list_location, std::move(file_io));
 }
 
 }  // namespace iceberg
@@ -22,38 +22,92 @@
 /// \file iceberg/manifest_reader.h
 /// Data reader interface for manifest files.
 
+#include <functional>
 #include <memory>
+#include <optional>
+#include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "iceberg/iceberg_export.h"
+#include "iceberg/manifest_entry.h"
 #include "iceberg/result.h"
 #include "iceberg/type_fwd.h"
 
 namespace iceberg {
 
+/// \brief Options to read only part of the manifest entries.
+struct ICEBERG_EXPORT ManifestReadOptions {
+  /// \brief Names of the optional data file fields to read, e.g. "lower_bounds".
+  ///
+  /// All fields are read when empty. Otherwise the other optional fields are skipped
+  /// while decoding the manifest and left unset in the returned data files, while the
+  /// entry fields and the required data file fields are always read, as well as the
+  /// content of the file.
+  std::vector<std::string> columns;
+  /// \brief Ids of the table columns to keep the metrics of.
+  ///
+  /// When set, the column sizes, value counts and bounds of the other columns are
+  /// dropped from the entries returned by Entries() and VisitEntries().
+  std::optional<std::unordered_set<int32_t>> stats_field_ids;
+  /// \brief Statuses of the entries to read, all of them when empty.
+  ///
+  /// The status of the entries of each batch is decoded first, and the other fields are
+  /// only parsed for the entries with one of these statuses. The other entries are
+  /// dropped from Entries() and VisitEntries(), while VisitBatches() visits all of them.
+  std::vector<ManifestStatus> statuses;
+};
+
 /// \brief Read manifest entries from a manifest file.
 class ICEBERG_EXPORT ManifestReader {
  public:
   virtual ~ManifestReader() = default;
   virtual Result<std::vector<ManifestEntry>> Entries() const = 0;
 
+  /// \brief Reads the entries of the manifest without blocking the awaiting coroutine.
+  ///
+  /// By default Entries() runs on the executor and the coroutine is resumed on it.
+  /// \param executor The executor reading the manifest, the DefaultExecutor() if null.
+  virtual Task<Result<std::vector<ManifestEntry>>> EntriesAsync(
+      std::shared_ptr<Executor> executor = nullptr) const;
+
+  /// \brief Visits the entries of the manifest in file order.
+  ///
+  /// Unlike Entries(), the entries are decoded one batch at a time, so a large manifest
+  /// can be processed without holding all of its entries in memory. Stops at the first
+  /// error returned by the visitor.
+  virtual Status VisitEntries(
+      const std::function<Status(ManifestEntry&&)>& visitor) const;
+
+  /// \brief Visits the entries of the manifest in file order as columnar batches.
+  ///
+  /// The batches are views over the decoded Arrow arrays that are only valid during the
+  /// visitor call, which lets callers filter entries before materializing them with
+  /// ManifestEntryBatch::Entry(). Readers that do not decode manifest files, such as
+  /// readers serving entries from a ManifestCache, return NotSupported.
+  virtual Status VisitBatches(
+      const std::function<Status(const ManifestEntryBatch&)>& visitor) const;
+
   /// \brief Creates a reader for a manifest file.
   /// \param manifest A ManifestFile object containing metadata about the manifest.
   /// \param file_io File IO implementation to use.
   /// \param partition_schema Schema for the partition.
+  /// \param options Columns to read, all of them by default. Readers that only read
+  /// part of the entries do not use the ManifestCache.
   /// \return A Result containing the reader or an error.
   static Result<std::unique_ptr<ManifestReader>> Make(
       const ManifestFile& manifest, std::shared_ptr<FileIO> file_io,
-      std::shared_ptr<Schema> partition_schema);
+      std::shared_ptr<Schema> partition_schema, const ManifestReadOptions& options = {});
 
   /// \brief Creates a reader for a manifest file.
   /// \param manifest_location Path to the manifest file.
   /// \param file_io File IO implementation to use.
   /// \param partition_schema Schema for the partition.
+  /// \param options Columns to read, all of them by default.
   /// \return A Result containing the reader or an error.
   static Result<std::unique_ptr<ManifestReader>> Make(
       std::string_view manifest_location, std::shared_ptr<FileIO> file_io,
-      std::shared_ptr<Schema> partition_schema);
+      std::shared_ptr<Schema> partition_schema, const ManifestReadOptions& options = {});
 };
 
 /// \brief Read manifest files from a manifest list file.
@@ -19,44 +19,140 @@
 
 #include "manifest_reader_internal.h"
 
+#include <algorithm>
+#include <span>
+
 #include <nanoarrow/nanoarrow.h>
 
 #include "iceberg/arrow/nanoarrow_status_internal.h"
 #include "iceberg/arrow_c_data_guard_internal.h"
 #include "iceberg/file_format.h"
 #include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_entry_batch.h"
 #include "iceberg/manifest_list.h"
 #include "iceberg/schema.h"
 #include "iceberg/type.h"
 #include "iceberg/util/checked_cast.h"
 #include "iceberg/util/macros.h"
+#include "iceberg/util/tracing.h"
 
 namespace iceberg {
 
-#define PARSE_PRIMITIVE_FIELD(item, array_view, type)                                   \
-  for (int64_t row_idx = 0; row_idx < array_view->length; row_idx++) {                  \
-    if (!ArrowArrayViewIsNull(array_view, row_idx)) {                                   \
-      auto value = ArrowArrayViewGetIntUnsafe(array_view, row_idx);                     \
-      item = static_cast<type>(value);                                                  \
-    } else if (required) {                                                              \
-      return InvalidManifestList("Field {} is required but null at row {}", field_name, \
-                                 row_idx);                                              \
-    }                                                                                   \
+/// \brief The rows of a batch whose fields are parsed, which the parsing macros check
+/// with `selected(row_idx)`.
+struct RowSelection {
+  // One flag per row of the batch, or null when every row is parsed.
+  const std::vector<uint8_t>* rows = nullptr;
+
+  bool operator()(int64_t row_idx) const {
+    return rows == nullptr || (*rows)[row_idx] != 0;
   }
+};
 
-#define PARSE_STRING_FIELD(item, array_view)                                            \
-  for (int64_t row_idx = 0; row_idx < array_view->length; row_idx++) {                  \
-    if (!ArrowArrayViewIsNull(array_view, row_idx)) {                                   \
-      auto value = ArrowArrayViewGetStringUnsafe(array_view, row_idx);                  \
-      item = std::string(value.data, value.size_bytes);                                 \
-    } else if (required) {                                                              \
-      return InvalidManifestList("Field {} is required but null at row {}", field_name, \
-                                 row_idx);                                              \
-    }                                                                                   \
+/// \brief Returns the error of a required field that is null in a row.
+Status RequiredFieldIsNull(std::string_view field_name, int64_t row_idx) {
+  return InvalidManifestList("Field {} is required but null at row {}", field_name,
+                             row_idx);
+}
+
+/// \brief Calls `parse(row_idx, value_idx)` for each selected row of a column that is
+/// not null, where `value_idx` is the index of its value in the buffers of the column.
+///
+/// The common columns without nulls of batches without unselected rows are parsed in a
+/// loop without any check per row.
+template <typename Parse>
+Status ForEachValue(const ArrowArrayView* view, const RowSelection& selected,
+                    bool required, std::string_view field_name, Parse&& parse) {
+  const uint8_t* validity = view->buffer_views[0].data.as_uint8;
+  const bool has_nulls = validity != nullptr && view->null_count != 0;
+  if (!has_nulls && selected.rows == nullptr) {
+    for (int64_t row_idx = 0; row_idx < view->length; row_idx++) {
+      parse(row_idx, view->offset + row_idx);
+    }
+    return {};
   }
+  for (int64_t row_idx = 0; row_idx < view->length; row_idx++) {
+    if (!selected(row_idx)) {
+      continue;
+    }
+    const int64_t value_idx = view->offset + row_idx;
+    if (has_nulls && !ArrowBitGet(validity, value_idx)) {
+      if (required) {
+        return RequiredFieldIsNull(field_name, row_idx);
+      }
+      continue;
+    }
+    parse(row_idx, value_idx);
+  }
+  return {};
+}
+
+/// \brief Calls `assign(row_idx, value)` with the integer value of each selected row of
+/// a column that is not null.
+///
+/// The values are read from the buffer of the physical type of the column, which is
+/// resolved once per column instead of once per value, so that the loop over the rows
+/// is specialized for each type at compile time.
+template <typename Assign>
+Status ParseIntColumn(const ArrowArrayView* view, const RowSelection& selected,
+                      bool required, std::string_view field_name, Assign&& assign) {
+  const auto& values = view->buffer_views[1].data;
+  switch (view->storage_type) {
+    case ArrowType::NANOARROW_TYPE_INT32:
+      return ForEachValue(view, selected, required, field_name,
+                          [&](int64_t row_idx, int64_t value_idx) {
+                            assign(row_idx, values.as_int32[value_idx]);
+                          });
+    case ArrowType::NANOARROW_TYPE_INT64:
+      return ForEachValue(view, selected, required, field_name,
+                          [&](int64_t row_idx, int64_t value_idx) {
+                            assign(row_idx, values.as_int64[value_idx]);
+                          });
+    default:
+      return ForEachValue(view, selected, required, field_name,
+                          [&](int64_t row_idx, int64_t /*value_idx*/) {
+                            assign(row_idx, ArrowArrayViewGetIntUnsafe(view, row_idx));
+                          });
+  }
+}
+
+/// \brief Calls `assign(row_idx, value)` with the string value of each selected row of
+/// a column that is not null, like ParseIntColumn().
+template <typename Assign>
+Status ParseStringColumn(const ArrowArrayView* view, const RowSelection& selected,
+                         bool required, std::string_view field_name, Assign&& assign) {
+  if (view->storage_type == ArrowType::NANOARROW_TYPE_STRING) {
+    const int32_t* offsets = view->buffer_views[1].data.as_int32;
+    const char* data = view->buffer_views[2].data.as_char;
+    return ForEachValue(view, selected, required, field_name,
+                        [&](int64_t row_idx, int64_t value_idx) {
+                          const int32_t start = offsets[value_idx];
+                          const int32_t end = offsets[value_idx + 1];
+                          assign(row_idx, std::string_view(data + start, end - start));
+                        });
+  }
+  return ForEachValue(view, selected, required, field_name,
+                      [&](int64_t row_idx, int64_t /*value_idx*/) {
+                        auto value = ArrowArrayViewGetStringUnsafe(view, row_idx);
+                        assign(row_idx, std::string_view(value.data, value.size_bytes));
+                      });
+}
+
+#define PARSE_PRIMITIVE_FIELD(item, array_view, type)                         \
+  ICEBERG_RETURN_UNEXPECTED(ParseIntColumn(                                   \
+      array_view, selected, required, field_name,                             \
+      [&](int64_t row_idx, int64_t value) { item = static_cast<type>(value); }))
+
+#define PARSE_STRING_FIELD(item, array_view)                                        \
+  ICEBERG_RETURN_UNEXPECTED(ParseStringColumn(                                      \
+      array_view, selected, required, field_name,                                   \
+      [&](int64_t row_idx, std::string_view value) { item = std::string(value); }))
 
 #define PARSE_BINARY_FIELD(item, array_view)                                            \
   for (int64_t row_idx = 0; row_idx < array_view->length; row_idx++) {                  \
+    if (!selected(row_idx)) {                                                           \
+      continue;                                                                         \
+    }                                                                                   \
     if (!ArrowArrayViewIsNull(view_of_column, row_idx)) {                               \
       item = ArrowArrayViewGetInt8Vector(array_view, row_idx);                          \
     } else if (required) {                                                              \
@@ -67,6 +163,9 @@ namespace iceberg {
 
 #define PARSE_INTEGER_VECTOR_FIELD(item, count, array_view, type)                   \
   for (int64_t manifest_idx = 0; manifest_idx < count; manifest_idx++) {            \
+    if (!selected(manifest_idx)) {                                                  \
+      continue;                                                                     \
+    }                                                                               \
     auto offset = ArrowArrayViewListChildOffset(array_view, manifest_idx);          \
     auto next_offset = ArrowArrayViewListChildOffset(array_view, manifest_idx + 1); \
     for (int64_t offset_idx = offset; offset_idx < next_offset; offset_idx++) {     \
@@ -87,10 +186,16 @@ namespace iceberg {
     auto view_of_map_value = view_of_map->children[1];                               \
     ASSERT_VIEW_TYPE(view_of_map_value, value_type);                                 \
     for (int64_t row_idx = 0; row_idx < count; row_idx++) {                          \
+      if (!selected(row_idx)) {                                                      \
+        continue;                                                                    \
+      }                                                                              \
       auto offset = array_view->buffer_views[1].data.as_int32[row_idx];              \
       auto next_offset = array_view->buffer_views[1].data.as_int32[row_idx + 1];     \
       for (int32_t offset_idx = offset; offset_idx < next_offset; offset_idx++) {    \
         auto key = ArrowArrayViewGetIntUnsafe(view_of_map_key, offset_idx);          \
+        if (stats_field_ids != nullptr && !stats_field_ids->contains(key)) {         \
+          continue;                                                                  \
+        }                                                                            \
         item[key] = assignment;                                                      \
       }                                                                              \
     }                                                                                \
@@ -189,30 +294,44 @@ Status ParsePartitionFieldSummaryList(ArrowArrayView* view_of_column,
   return {};
 }
 
-Result<std::vector<ManifestFile>> ParseManifestList(ArrowSchema* schema,
-                                                    ArrowArray* array_in,
+/// \brief Initializes a view for the batches of a reader from their schema, once for all
+/// the batches.
+Status InitArrayView(const ArrowSchema& schema, ArrowArrayView& view) {
+  ArrowError error;
+  auto status = ArrowArrayViewInitFromSchema(&view, &schema, &error);
+  ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(status, error);
+  return {};
+}
+
+/// \brief Points a view at the buffers of a decoded batch, which are read in place.
+///
+/// Setting the array checks the sizes of the buffers against the lengths of the arrays,
+/// which is what the unchecked accessors rely on. The offsets are not checked one by
+/// one: the batches come from the Avro decoder, not from an untrusted producer.
+Status SetArrayView(ArrowArrayView& view, const ArrowArray* array) {
+  ArrowError error;
+  auto status = ArrowArrayViewSetArray(&view, array, &error);
+  ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(status, error);
+  return {};
+}
+
+Result<std::vector<ManifestFile>> ParseManifestList(ArrowArrayView& array_view,
+                                                    const ArrowArray* array_in,
                                                     const Schema& iceberg_schema) {
-  if (schema->n_children != array_in->n_children) {
+  if (array_view.n_children != array_in->n_children) {
     return InvalidManifestList("Columns size not match between schema:{} and array:{}",
-                               schema->n_children, array_in->n_children);
+                               array_view.n_children, array_in->n_children);
   }
   if (iceberg_schema.fields().size() != array_in->n_children) {
     return InvalidManifestList("Columns size not match between schema:{} and array:{}",
                                iceberg_schema.fields().size(), array_in->n_children);
   }
-
-  ArrowError error;
-  ArrowArrayView array_view;
-  auto status = ArrowArrayViewInitFromSchema(&array_view, schema, &error);
-  ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(status, error);
-  internal::ArrowArrayViewGuard view_guard(&array_view);
-  status = ArrowArrayViewSetArray(&array_view, array_in, &error);
-  ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(status, error);
-  status = ArrowArrayViewValidate(&array_view, NANOARROW_VALIDATION_LEVEL_FULL, &error);
-  ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(status, error);
+  ICEBERG_RETURN_UNEXPECTED(SetArrayView(array_view, array_in));
 
   std::vector<ManifestFile> manifest_files;
   manifest_files.resize(array_in->length);
+  // Every manifest of the list is parsed.
+  const RowSelection selected;
 
   for (int64_t idx = 0; idx < array_in->n_children; idx++) {
     const auto& field = iceberg_schema.GetFieldByIndex(idx);
@@ -327,23 +446,84 @@ Status ParseLiteral(ArrowArrayView* view_of_partition, int64_t row_idx,
   return {};
 }
 
-Status ParseDataFile(const std::shared_ptr<StructType>& data_file_schema,
-                     ArrowArrayView* view_of_column,
-                     std::vector<ManifestEntry>& manifest_entries) {
+/// \brief Returns the position of a field in the full, unprojected struct type, which
+/// the parsers switch on, so that the fields of projected manifests are parsed correctly.
+Result<int64_t> FullFieldIndex(const StructType& full_type, const SchemaField& field) {
+  const auto& fields = full_type.fields();
+  for (size_t idx = 0; idx < fields.size(); ++idx) {
+    if (fields[idx].field_id() == field.field_id()) {
+      return static_cast<int64_t>(idx);
+    }
+  }
+  return InvalidManifest("Unsupported field: {} in manifest entry.", field.name());
+}
+
+/// \brief The columns of the manifest entries read with a schema, resolved once for all
+/// the batches of a manifest.
+///
+/// The schema depends on the format version of the manifest and on the projection, so
+/// the parsers switch on the position of each column in the full, unprojected types.
+/// Resolving them and the required flags up front leaves one switch per column of a
+/// batch, with a loop over the rows specialized for its field in each case.
+struct ManifestEntryLayout {
+  struct Column {
+    int64_t field_idx;
+    std::string_view name;
+    bool required;
+  };
+
+  std::vector<Column> columns;
+  std::vector<Column> data_file_columns;
+
+  static Result<ManifestEntryLayout> Make(const Schema& schema) {
+    static const auto kFullManifestEntryType =
+        ManifestEntry::TypeFromPartitionType(nullptr);
+    static const auto kFullDataFileType = DataFile::Type(nullptr);
+    auto resolve = [](const StructType& full_type, const SchemaField& field)
+        -> Result<Column> {
+      ICEBERG_ASSIGN_OR_RAISE(auto field_idx, FullFieldIndex(full_type, field));
+      return Column{
+          .field_idx = field_idx, .name = field.name(), .required = !field.optional()};
+    };
+
+    ManifestEntryLayout layout;
+    for (const auto& field : schema.fields()) {
+      ICEBERG_ASSIGN_OR_RAISE(auto column, resolve(*kFullManifestEntryType, field));
+      if (column.field_idx == 4) {
+        if (field.type()->type_id() != TypeId::kStruct) {
+          return InvalidManifest("DataFile field should be a struct.");
+        }
+        const auto& data_file_type =
+            internal::checked_cast<const StructType&>(*field.type());
+        for (const auto& file_field : data_file_type.fields()) {
+          ICEBERG_ASSIGN_OR_RAISE(auto file_column,
+                                  resolve(*kFullDataFileType, file_field));
+          layout.data_file_columns.push_back(file_column);
+        }
+      }
+      layout.columns.push_back(column);
+    }
+    return layout;
+  }
+};
+
+Status ParseDataFile(const ManifestEntryLayout& layout, ArrowArrayView* view_of_column,
+                     std::vector<ManifestEntry>& manifest_entries,
+                     const std::unordered_set<int32_t>* stats_field_ids,
+                     const RowSelection& selected) {
   if (view_of_column->storage_type != ArrowType::NANOARROW_TYPE_STRUCT) {
     return InvalidManifest("DataFile field should be a struct.");
   }
-  if (view_of_column->n_children != data_file_schema->fields().size()) {
+  if (view_of_column->n_children != layout.data_file_columns.size()) {
     return InvalidManifest("DataFile schema size:{} not match with ArrayArray columns:{}",
-                           data_file_schema->fields().size(), view_of_column->n_children);
+                           layout.data_file_columns.size(), view_of_column->n_children);
   }
   for (int64_t col_idx = 0; col_idx < view_of_column->n_children; ++col_idx) {
-    auto field_name = data_file_schema->GetFieldByIndex(col_idx).value()->get().name();
-    auto required = !data_file_schema->GetFieldByIndex(col_idx).value()->get().optional();
+    const auto& [field_idx, field_name, required] = layout.data_file_columns[col_idx];
     auto view_of_file_field = view_of_column->children[col_idx];
     auto manifest_entry_count = view_of_file_field->length;
 
-    switch (col_idx) {
+    switch (field_idx) {
       case 0:
         PARSE_PRIMITIVE_FIELD(manifest_entries[row_idx].data_file->content,
                               view_of_file_field, DataFile::Content);
@@ -354,7 +534,7 @@ Status ParseDataFile(const std::shared_ptr<StructType>& data_file_schema,
         break;
       case 2:
         for (int64_t row_idx = 0; row_idx < view_of_file_field->length; row_idx++) {
-          if (!ArrowArrayViewIsNull(view_of_file_field, row_idx)) {
+          if (selected(row_idx) && !ArrowArrayViewIsNull(view_of_file_field, row_idx)) {
             auto value = ArrowArrayViewGetStringUnsafe(view_of_file_field, row_idx);
             std::string_view path_str(value.data, value.size_bytes);
             ICEBERG_ASSIGN_OR_RAISE(manifest_entries[row_idx].data_file->file_format,
@@ -369,6 +549,9 @@ Status ParseDataFile(const std::shared_ptr<StructType>& data_file_schema,
         if (view_of_file_field->n_children > 0) {
           auto view_of_partition = view_of_file_field->children[0];
           for (int64_t row_idx = 0; row_idx < view_of_partition->length; row_idx++) {
+            if (!selected(row_idx)) {
+              continue;
+            }
             if (ArrowArrayViewIsNull(view_of_partition, row_idx)) {
               break;
             }
@@ -452,44 +635,81 @@ Status ParseDataFile(const std::shared_ptr<StructType>& data_file_schema,
   return {};
 }
 
-Result<std::vector<ManifestEntry>> ParseManifestEntry(ArrowSchema* schema,
-                                                      ArrowArray* array_in,
-                                                      const Schema& iceberg_schema) {
-  if (schema->n_children != array_in->n_children) {
+/// \brief Decodes the status column of a batch and flags the rows with one of the given
+/// statuses, returning how many there are.
+Result<int64_t> SelectRowsByStatus(const ArrowArrayView& array_view,
+                                   const Schema& iceberg_schema,
+                                   std::span<const ManifestStatus> statuses,
+                                   std::vector<uint8_t>& rows) {
+  const auto& status_field = ManifestEntry::kStatus;
+  auto fields = iceberg_schema.fields();
+  auto it = std::ranges::find(fields, status_field.field_id(), &SchemaField::field_id);
+  if (it == fields.end()) {
+    return InvalidManifest("Field {} is not found in manifest entry.",
+                           status_field.name());
+  }
+  auto view_of_status = array_view.children[std::distance(fields.begin(), it)];
+  rows.assign(view_of_status->length, 0);
+  int64_t selected_count = 0;
+  for (int64_t row_idx = 0; row_idx < view_of_status->length; row_idx++) {
+    if (ArrowArrayViewIsNull(view_of_status, row_idx)) {
+      return InvalidManifest("Field {} is required but null at row {}",
+                             status_field.name(), row_idx);
+    }
+    auto status = static_cast<ManifestStatus>(
+        ArrowArrayViewGetIntUnsafe(view_of_status, row_idx));
+    if (std::ranges::find(statuses, status) != statuses.end()) {
+      rows[row_idx] = 1;
+      ++selected_count;
+    }
+  }
+  return selected_count;
+}
+
+/// \brief Parses the entries of a batch, only those with one of the given statuses when
+/// there are any. The status column is decoded first, and the other fields of the rows
+/// with other statuses are skipped.
+Result<std::vector<ManifestEntry>> ParseManifestEntry(
+    ArrowArrayView& array_view, const ArrowArray* array_in, const Schema& iceberg_schema,
+    const ManifestEntryLayout& layout, const std::unordered_set<int32_t>* stats_field_ids,
+    std::span<const ManifestStatus> statuses) {
+  if (array_view.n_children != array_in->n_children) {
     return InvalidManifest("Columns size not match between schema:{} and array:{}",
-                           schema->n_children, array_in->n_children);
+                           array_view.n_children, array_in->n_children);
   }
-  if (iceberg_schema.fields().size() != array_in->n_children) {
+  if (layout.columns.size() != array_in->n_children) {
     return InvalidManifest("Columns size not match between schema:{} and array:{}",
-                           iceberg_schema.fields().size(), array_in->n_children);
+                           layout.columns.size(), array_in->n_children);
+  }
+  ICEBERG_RETURN_UNEXPECTED(SetArrayView(array_view, array_in));
+
+  std::vector<uint8_t> selected_rows;
+  RowSelection selected;
+  if (!statuses.empty()) {
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto selected_count,
+        SelectRowsByStatus(array_view, iceberg_schema, statuses, selected_rows));
+    if (selected_count == 0) {
+      return std::vector<ManifestEntry>{};
+    }
+    if (selected_count < array_in->length) {
+      selected.rows = &selected_rows;
+    }
   }
-
-  ArrowError error;
-  ArrowArrayView array_view;
-  auto status = ArrowArrayViewInitFromSchema(&array_view, schema, &error);
-  ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(status, error);
-  internal::ArrowArrayViewGuard view_guard(&array_view);
-  status = ArrowArrayViewSetArray(&array_view, array_in, &error);
-  ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(status, error);
-  status = ArrowArrayViewValidate(&array_view, NANOARROW_VALIDATION_LEVEL_FULL, &error);
-  ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(status, error);
 
   std::vector<ManifestEntry> manifest_entries;
   manifest_entries.resize(array_in->length);
   for (int64_t i = 0; i < array_in->length; i++) {
-    manifest_entries[i].data_file = std::make_shared<DataFile>();
+    if (selected(i)) {
+      manifest_entries[i].data_file = std::make_shared<DataFile>();
+    }
   }
 
   for (int64_t idx = 0; idx < array_in->n_children; idx++) {
-    const auto& field = iceberg_schema.GetFieldByIndex(idx);
-    if (!field.has_value()) {
-      return InvalidManifest("Field not found in schema: {}", idx);
-    }
-    auto field_name = field.value()->get().name();
-    bool required = !field.value()->get().optional();
+    const auto& [field_idx, field_name, required] = layout.columns[idx];
     auto view_of_column = array_view.children[idx];
 
-    switch (idx) {
+    switch (field_idx) {
       case 0:
         PARSE_PRIMITIVE_FIELD(manifest_entries[row_idx].status, view_of_column,
                               ManifestStatus);
@@ -506,58 +726,113 @@ Result<std::vector<ManifestEntry>> ParseManifestEntry(ArrowSchema* schema,
         PARSE_PRIMITIVE_FIELD(manifest_entries[row_idx].file_sequence_number,
                               view_of_column, int64_t);
         break;
-      case 4: {
-        auto data_file_schema =
-            internal::checked_pointer_cast<StructType>(field.value()->get().type());
-        ICEBERG_RETURN_UNEXPECTED(
-            ParseDataFile(data_file_schema, view_of_column, manifest_entries));
+      case 4:
+        ICEBERG_RETURN_UNEXPECTED(ParseDataFile(layout, view_of_column, manifest_entries,
+                                                stats_field_ids, selected));
         break;
-      }
       default:
         return InvalidManifest("Unsupported field: {} in manifest entry.", field_name);
     }
   }
+  if (selected.rows != nullptr) {
+    size_t kept = 0;
+    for (int64_t i = 0; i < array_in->length; i++) {
+      if (selected(i)) {
+        manifest_entries[kept++] = std::move(manifest_entries[i]);
+      }
+    }
+    manifest_entries.resize(kept);
+  }
   return manifest_entries;
 }
 
 Result<std::vector<ManifestEntry>> ManifestReaderImpl::Entries() const {
+  ICEBERG_TRACE_SCOPE(trace, "ManifestReader::Entries");
   std::vector<ManifestEntry> manifest_entries;
+  ICEBERG_RETURN_UNEXPECTED(VisitEntries([&](ManifestEntry&& entry) -> Status {
+    manifest_entries.push_back(std::move(entry));
+    return {};
+  }));
+  ICEBERG_TRACE_ATTRIBUTE(trace, "rows", static_cast<int64_t>(manifest_entries.size()));
+  return manifest_entries;
+}
+
+Status ManifestReaderImpl::VisitEntries(
+    const std::function<Status(ManifestEntry&&)>& visitor) const {
   ICEBERG_ASSIGN_OR_RAISE(auto arrow_schema, reader_->Schema());
   internal::ArrowSchemaGuard schema_guard(&arrow_schema);
+  ArrowArrayView array_view;
+  ICEBERG_RETURN_UNEXPECTED(InitArrayView(arrow_schema, array_view));
+  internal::ArrowArrayViewGuard view_guard(&array_view);
+  ICEBERG_ASSIGN_OR_RAISE(auto layout, ManifestEntryLayout::Make(*schema_));
+  // Row IDs are assigned in the order of all the live entries, so they are parsed even
+  // when only some of them are visited.
+  auto statuses = statuses_;
+  if (!statuses.empty() && inheritable_metadata_->AssignFirstRowId(0).has_value()) {
+    for (auto live : {ManifestStatus::kAdded, ManifestStatus::kExisting}) {
+      if (std::ranges::find(statuses, live) == statuses.end()) {
+        statuses.push_back(live);
+      }
+    }
+  }
   while (true) {
     ICEBERG_ASSIGN_OR_RAISE(auto result, reader_->Next());
-    if (result.has_value()) {
-      internal::ArrowArrayGuard array_guard(&result.value());
-      ICEBERG_ASSIGN_OR_RAISE(
-          auto parse_result,
-          ParseManifestEntry(&arrow_schema, &result.value(), *schema_));
-      manifest_entries.insert(manifest_entries.end(),
-                              std::make_move_iterator(parse_result.begin()),
-                              std::make_move_iterator(parse_result.end()));
-    } else {
+    if (!result.has_value()) {
       // eof
       break;
     }
+    internal::ArrowArrayGuard array_guard(&result.value());
+    ICEBERG_ASSIGN_OR_RAISE(auto parse_result,
+                            ParseManifestEntry(array_view, &result.value(), *schema_,
+                                               layout,
+                                               stats_field_ids_ ? &*stats_field_ids_
+                                                                : nullptr,
+                                               statuses));
+    for (auto& entry : parse_result) {
+      // Apply inheritance before handing out the entry
+      ICEBERG_RETURN_UNEXPECTED(inheritable_metadata_->Apply(entry));
+      if (statuses.size() != statuses_.size() &&
+          std::ranges::find(statuses_, entry.status) == statuses_.end()) {
+        continue;
+      }
+      ICEBERG_RETURN_UNEXPECTED(visitor(std::move(entry)));
+    }
   }
+  return {};
+}
 
-  // Apply inheritance to all entries
-  for (auto& entry : manifest_entries) {
-    ICEBERG_RETURN_UNEXPECTED(inheritable_metadata_->Apply(entry));
+Status ManifestReaderImpl::VisitBatches(
+    const std::function<Status(const ManifestEntryBatch&)>& visitor) const {
+  ICEBERG_ASSIGN_OR_RAISE(auto arrow_schema, reader_->Schema());
+  internal::ArrowSchemaGuard schema_guard(&arrow_schema);
+  while (true) {
+    ICEBERG_ASSIGN_OR_RAISE(auto result, reader_->Next());
+    if (!result.has_value()) {
+      // eof
+      break;
+    }
+    internal::ArrowArrayGuard array_guard(&result.value());
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto batch, ManifestEntryBatch::Make(arrow_schema, result.value(), *schema_,
+                                             inheritable_metadata_.get()));
+    ICEBERG_RETURN_UNEXPECTED(visitor(batch));
   }
-
-  return manifest_entries;
+  return {};
 }
 
 Result<std::vector<ManifestFile>> ManifestListReaderImpl::Files() const {
   std::vector<ManifestFile> manifest_files;
   ICEBERG_ASSIGN_OR_RAISE(auto arrow_schema, reader_->Schema());
   internal::ArrowSchemaGuard schema_guard(&arrow_schema);
+  ArrowArrayView array_view;
+  ICEBERG_RETURN_UNEXPECTED(InitArrayView(arrow_schema, array_view));
+  internal::ArrowArrayViewGuard view_guard(&array_view);
   while (true) {
     ICEBERG_ASSIGN_OR_RAISE(auto result, reader_->Next());
     if (result.has_value()) {
       internal::ArrowArrayGuard array_guard(&result.value());
       ICEBERG_ASSIGN_OR_RAISE(
-          auto parse_result, ParseManifestList(&arrow_schema, &result.value(), *schema_));
+          auto parse_result, ParseManifestList(array_view, &result.value(), *schema_));
       manifest_files.insert(manifest_files.end(),
                             std::make_move_iterator(parse_result.begin()),
                             std::make_move_iterator(parse_result.end()));
@@ -22,8 +22,13 @@
 /// \file iceberg/internal/manifest_reader_internal.h
 /// Reader implementation for manifest list files and manifest files.
 
+#include <optional>
+#include <unordered_set>
+
 #include "iceberg/file_reader.h"
 #include "iceberg/inheritable_metadata.h"
+#include "iceberg/manifest_cache.h"
+#include "iceberg/manifest_list.h"
 #include "iceberg/manifest_reader.h"
 
 namespace iceberg {
@@ -31,19 +36,54 @@ namespace iceberg {
 /// \brief Read manifest entries from a manifest file.
 class ManifestReaderImpl : public ManifestReader {
  public:
-  explicit ManifestReaderImpl(std::unique_ptr<Reader> reader,
-                              std::shared_ptr<Schema> schema,
-                              std::unique_ptr<InheritableMetadata> inheritable_metadata)
+  explicit ManifestReaderImpl(
+      std::unique_ptr<Reader> reader, std::shared_ptr<Schema> schema,
+      std::unique_ptr<InheritableMetadata> inheritable_metadata,
+      std::optional<std::unordered_set<int32_t>> stats_field_ids = std::nullopt,
+      std::vector<ManifestStatus> statuses = {})
       : schema_(std::move(schema)),
         reader_(std::move(reader)),
-        inheritable_metadata_(std::move(inheritable_metadata)) {}
+        inheritable_metadata_(std::move(inheritable_metadata)),
+        stats_field_ids_(std::move(stats_field_ids)),
+        statuses_(std::move(statuses)) {}
 
   Result<std::vector<ManifestEntry>> Entries() const override;
 
+  Status VisitEntries(
+      const std::function<Status(ManifestEntry&&)>& visitor) const override;
+
+  Status VisitBatches(
+      const std::function<Status(const ManifestEntryBatch&)>& visitor) const override;
+
  private:
   std::shared_ptr<Schema> schema_;
   std::unique_ptr<Reader> reader_;
   std::unique_ptr<InheritableMetadata> inheritable_metadata_;
+  // Ids of the columns to keep the metrics of, or nullopt to keep all of them.
+  std::optional<std::unordered_set<int32_t>> stats_field_ids_;
+  // Statuses of the entries to parse, or empty to parse all of them.
+  std::vector<ManifestStatus> statuses_;
+};
+
+/// \brief Read manifest entries from a ManifestCache, reading the manifest file only
+/// when its entries are not cached.
+class CachedManifestReader : public ManifestReader {
+ public:
+  CachedManifestReader(ManifestFile manifest, std::shared_ptr<FileIO> file_io,
+                       std::shared_ptr<Schema> partition_schema,
+                       std::shared_ptr<ManifestCache> cache)
+      : manifest_(std::move(manifest)),
+        file_io_(std::move(file_io)),
+        partition_schema_(std::move(partition_schema)),
+        cache_(std::move(cache)) {}
+
+  Result<std::vector<ManifestEntry>> Entries() const override;
+
+ private:
+  ManifestFile manifest_;
+  std::shared_ptr<FileIO> file_io_;
+  std::shared_ptr<Schema> partition_schema_;
+  std::shared_ptr<ManifestCache> cache_;
 };
 
 /// \brief Read manifest files from a manifest list file.
@@ -60,6 +100,25 @@ class ManifestListReaderImpl : public ManifestListReader {
   std::unique_ptr<Reader> reader_;
 };
 
+/// \brief Read manifest files from a ManifestCache, reading the manifest list file only
+/// when its manifest files are not cached.
+class CachedManifestListReader : public ManifestListReader {
+ public:
+  CachedManifestListReader(std::string manifest_list_location,
+                           std::shared_ptr<FileIO> file_io,
+                           std::shared_ptr<ManifestCache> cache)
+      : manifest_list_location_(std::move(manifest_list_location)),
+        file_io_(std::move(file_io)),
+        cache_(std::move(cache)) {}
+
+  Result<std::vector<ManifestFile>> Files() const override;
+
+ private:
+  std::string manifest_list_location_;
+  std::shared_ptr<FileIO> file_io_;
+  std::shared_ptr<ManifestCache> cache_;
+};
+
 enum class ManifestFileField : int32_t {
   kManifestPath = 0,
   kManifestLength = 1,
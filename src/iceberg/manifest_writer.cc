@@ -19,8 +19,15 @@
 
 #include "iceberg/manifest_writer.h"
 
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <variant>
+
+#include "iceberg/expression/literal.h"
 #include "iceberg/manifest_entry.h"
 #include "iceberg/manifest_list.h"
+#include "iceberg/partition_spec.h"
 #include "iceberg/schema.h"
 #include "iceberg/util/macros.h"
 #include "iceberg/v1_metadata.h"
@@ -29,18 +36,135 @@
 
 namespace iceberg {
 
+namespace {
+
+bool IsNaN(const Literal& literal) {
+  return std::visit(
+      [](const auto& value) {
+        if constexpr (std::is_floating_point_v<std::decay_t<decltype(value)>>) {
+          return std::isnan(value);
+        } else {
+          return false;
+        }
+      },
+      literal.value());
+}
+
+}  // namespace
+
+/// \brief Counts and partition value summaries of the entries of a manifest.
+struct ManifestWriter::Summary {
+  struct FieldSummary {
+    bool contains_null = false;
+    bool contains_nan = false;
+    std::optional<Literal> lower_bound;
+    std::optional<Literal> upper_bound;
+  };
+
+  void Update(const ManifestEntry& entry) {
+    const auto& file = *entry.data_file;
+    if (file.content != DataFile::Content::kData) {
+      content = ManifestFile::Content::kDeletes;
+    }
+
+    switch (entry.status) {
+      case ManifestStatus::kAdded:
+        ++added_files_count;
+        added_rows_count += file.record_count;
+        break;
+      case ManifestStatus::kExisting:
+        ++existing_files_count;
+        existing_rows_count += file.record_count;
+        break;
+      case ManifestStatus::kDeleted:
+        ++deleted_files_count;
+        deleted_rows_count += file.record_count;
+        break;
+    }
+
+    // Added entries without a sequence number inherit the sequence number of the
+    // snapshot, which is newer than every assigned one.
+    if (entry.status != ManifestStatus::kDeleted && entry.sequence_number.has_value() &&
+        (!min_sequence_number.has_value() ||
+         entry.sequence_number.value() < min_sequence_number.value())) {
+      min_sequence_number = entry.sequence_number;
+    }
+
+    const size_t num_fields = std::min(fields.size(), file.partition.size());
+    for (size_t i = 0; i < num_fields; ++i) {
+      auto& field = fields[i];
+      const auto& value = file.partition[i];
+      if (value.IsNull()) {
+        field.contains_null = true;
+      } else if (IsNaN(value)) {
+        field.contains_nan = true;
+      } else {
+        if (!field.lower_bound.has_value() || value < field.lower_bound.value()) {
+          field.lower_bound = value;
+        }
+        if (!field.upper_bound.has_value() || value > field.upper_bound.value()) {
+          field.upper_bound = value;
+        }
+      }
+    }
+  }
+
+  ManifestFile::Content content = ManifestFile::Content::kData;
+  int32_t added_files_count = 0;
+  int32_t existing_files_count = 0;
+  int32_t deleted_files_count = 0;
+  int64_t added_rows_count = 0;
+  int64_t existing_rows_count = 0;
+  int64_t deleted_rows_count = 0;
+  std::optional<int64_t> min_sequence_number;
+  std::vector<FieldSummary> fields;
+};
+
+ManifestWriter::ManifestWriter(std::unique_ptr<Writer> writer,
+                               std::unique_ptr<ManifestEntryAdapter> adapter,
+                               std::string manifest_location,
+                               std::optional<int64_t> snapshot_id,
+                               std::shared_ptr<PartitionSpec> partition_spec)
+    : writer_(std::move(writer)),
+      adapter_(std::move(adapter)),
+      manifest_location_(std::move(manifest_location)),
+      snapshot_id_(snapshot_id),
+      partition_spec_(std::move(partition_spec)),
+      summary_(std::make_unique<Summary>()) {
+  if (partition_spec_ != nullptr) {
+    summary_->fields.resize(partition_spec_->fields().size());
+  }
+}
+
+ManifestWriter::~ManifestWriter() = default;
+
 Status ManifestWriter::Add(const ManifestEntry& entry) {
   if (adapter_->size() >= kBatchSize) {
     ICEBERG_ASSIGN_OR_RAISE(auto array, adapter_->FinishAppending());
     ICEBERG_RETURN_UNEXPECTED(writer_->Write(array));
     ICEBERG_RETURN_UNEXPECTED(adapter_->StartAppending());
   }
-  return adapter_->Append(entry);
+  ICEBERG_RETURN_UNEXPECTED(adapter_->Append(entry));
+  summary_->Update(entry);
+  return {};
 }
 
-Status ManifestWriter::AddAll(const std::vector<ManifestEntry>& entries) {
-  for (const auto& entry : entries) {
-    ICEBERG_RETURN_UNEXPECTED(Add(entry));
+Status ManifestWriter::AddAll(std::span<const ManifestEntry> entries) {
+  while (!entries.empty()) {
+    if (adapter_->size() >= kBatchSize) {
+      ICEBERG_ASSIGN_OR_RAISE(auto array, adapter_->FinishAppending());
+      ICEBERG_RETURN_UNEXPECTED(writer_->Write(array));
+      ICEBERG_RETURN_UNEXPECTED(adapter_->StartAppending());
+    }
+    // Fill up the current batch
+    const auto count = std::min(entries.size(),
+                                static_cast<size_t>(kBatchSize - adapter_->size()));
+    auto batch = entries.first(count);
+    ICEBERG_RETURN_UNEXPECTED(adapter_->AppendAll(batch));
+    for (const auto& entry : batch) {
+      summary_->Update(entry);
+    }
+    entries = entries.subspan(count);
   }
   return {};
 }
@@ -50,7 +174,55 @@ Status ManifestWriter::Close() {
     ICEBERG_ASSIGN_OR_RAISE(auto array, adapter_->FinishAppending());
     ICEBERG_RETURN_UNEXPECTED(writer_->Write(array));
   }
-  return writer_->Close();
+  ICEBERG_RETURN_UNEXPECTED(writer_->Close());
+  closed_ = true;
+  return {};
+}
+
+std::optional<int64_t> ManifestWriter::estimated_length() const {
+  return writer_->estimated_length();
+}
+
+Result<ManifestFile> ManifestWriter::ToManifestFile() const {
+  if (!closed_) {
+    return Invalid("Cannot get the manifest file of {} before the writer is closed",
+                   manifest_location_);
+  }
+  auto length = writer_->length();
+  if (!length.has_value()) {
+    return Invalid("Length of the manifest file {} is unknown", manifest_location_);
+  }
+
+  ManifestFile manifest{
+      .manifest_path = manifest_location_,
+      .manifest_length = length.value(),
+      .partition_spec_id = partition_spec_ != nullptr ? partition_spec_->spec_id()
+                                                      : PartitionSpec::kInitialSpecId,
+      .content = summary_->content,
+      .sequence_number = TableMetadata::kInvalidSequenceNumber,
+      .min_sequence_number =
+          summary_->min_sequence_number.value_or(TableMetadata::kInvalidSequenceNumber),
+      .added_snapshot_id = snapshot_id_.value_or(Snapshot::kInvalidSnapshotId),
+      .added_files_count = summary_->added_files_count,
+      .existing_files_count = summary_->existing_files_count,
+      .deleted_files_count = summary_->deleted_files_count,
+      .added_rows_count = summary_->added_rows_count,
+      .existing_rows_count = summary_->existing_rows_count,
+      .deleted_rows_count = summary_->deleted_rows_count,
+  };
+  manifest.partitions.reserve(summary_->fields.size());
+  for (const auto& field : summary_->fields) {
+    PartitionFieldSummary field_summary{.contains_null = field.contains_null,
+                                        .contains_nan = field.contains_nan};
+    if (field.lower_bound.has_value()) {
+      ICEBERG_ASSIGN_OR_RAISE(field_summary.lower_bound, field.lower_bound->Serialize());
+    }
+    if (field.upper_bound.has_value()) {
+      ICEBERG_ASSIGN_OR_RAISE(field_summary.upper_bound, field.upper_bound->Serialize());
+    }
+    manifest.partitions.push_back(std::move(field_summary));
+  }
+  return manifest;
 }
 
 Result<std::unique_ptr<Writer>> OpenFileWriter(
@@ -70,7 +242,7 @@ Result<std::unique_ptr<ManifestWriter>> ManifestWriter::MakeV1Writer(
     std::optional<int64_t> snapshot_id, std::string_view manifest_location,
     std::shared_ptr<FileIO> file_io, std::shared_ptr<PartitionSpec> partition_spec) {
   auto adapter =
-      std::make_unique<ManifestEntryAdapterV1>(snapshot_id, std::move(partition_spec));
+      std::make_unique<ManifestEntryAdapterV1>(snapshot_id, partition_spec);
   ICEBERG_RETURN_UNEXPECTED(adapter->Init());
   ICEBERG_RETURN_UNEXPECTED(adapter->StartAppending());
 
@@ -78,14 +250,16 @@ Result<std::unique_ptr<ManifestWriter>> ManifestWriter::MakeV1Writer(
   ICEBERG_ASSIGN_OR_RAISE(auto writer,
                           OpenFileWriter(manifest_location, std::move(schema),
                                          std::move(file_io), adapter->metadata()));
-  return std::make_unique<ManifestWriter>(std::move(writer), std::move(adapter));
+  return std::make_unique<ManifestWriter>(std::move(writer), std::move(adapter),
+                                          std::string(manifest_location), snapshot_id,
+                                          std::move(partition_spec));
 }
 
 Result<std::unique_ptr<ManifestWriter>> ManifestWriter::MakeV2Writer(
     std::optional<int64_t> snapshot_id, std::string_view manifest_location,
     std::shared_ptr<FileIO> file_io, std::shared_ptr<PartitionSpec> partition_spec) {
   auto adapter =
-      std::make_unique<ManifestEntryAdapterV2>(snapshot_id, std::move(partition_spec));
+      std::make_unique<ManifestEntryAdapterV2>(snapshot_id, partition_spec);
   ICEBERG_RETURN_UNEXPECTED(adapter->Init());
   ICEBERG_RETURN_UNEXPECTED(adapter->StartAppending());
 
@@ -93,15 +267,17 @@ Result<std::unique_ptr<ManifestWriter>> ManifestWriter::MakeV2Writer(
   ICEBERG_ASSIGN_OR_RAISE(auto writer,
                           OpenFileWriter(manifest_location, std::move(schema),
                                          std::move(file_io), adapter->metadata()));
-  return std::make_unique<ManifestWriter>(std::move(writer), std::move(adapter));
+  return std::make_unique<ManifestWriter>(std::move(writer), std::move(adapter),
+                                          std::string(manifest_location), snapshot_id,
+                                          std::move(partition_spec));
 }
 
 Result<std::unique_ptr<ManifestWriter>> ManifestWriter::MakeV3Writer(
     std::optional<int64_t> snapshot_id, std::optional<int64_t> first_row_id,
     std::string_view manifest_location, std::shared_ptr<FileIO> file_io,
     std::shared_ptr<PartitionSpec> partition_spec) {
-  auto adapter = std::make_unique<ManifestEntryAdapterV3>(snapshot_id, first_row_id,
-                                                          std::move(partition_spec));
+  auto adapter =
+      std::make_unique<ManifestEntryAdapterV3>(snapshot_id, first_row_id, partition_spec);
   ICEBERG_RETURN_UNEXPECTED(adapter->Init());
   ICEBERG_RETURN_UNEXPECTED(adapter->StartAppending());
 
@@ -109,7 +285,9 @@ Result<std::unique_ptr<ManifestWriter>> ManifestWriter::MakeV3Writer(
   ICEBERG_ASSIGN_OR_RAISE(auto writer,
                           OpenFileWriter(manifest_location, std::move(schema),
                                          std::move(file_io), adapter->metadata()));
-  return std::make_unique<ManifestWriter>(std::move(writer), std::move(adapter));
+  return std::make_unique<ManifestWriter>(std::move(writer), std::move(adapter),
+                                          std::string(manifest_location), snapshot_id,
+                                          std::move(partition_spec));
 }
 
 Status ManifestListWriter::Add(const ManifestFile& file) {
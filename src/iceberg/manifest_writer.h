@@ -23,6 +23,9 @@
 /// Data writer interface for manifest files and manifest list files.
 
 #include <memory>
+#include <optional>
+#include <span>
+#include <string>
 #include <vector>
 
 #include "iceberg/file_writer.h"
@@ -36,10 +39,11 @@ namespace iceberg {
 class ICEBERG_EXPORT ManifestWriter {
  public:
   ManifestWriter(std::unique_ptr<Writer> writer,
-                 std::unique_ptr<ManifestEntryAdapter> adapter)
-      : writer_(std::move(writer)), adapter_(std::move(adapter)) {}
+                 std::unique_ptr<ManifestEntryAdapter> adapter,
+                 std::string manifest_location, std::optional<int64_t> snapshot_id,
+                 std::shared_ptr<PartitionSpec> partition_spec);
 
-  ~ManifestWriter() = default;
+  ~ManifestWriter();
 
   /// \brief Write manifest entry to file.
   /// \param entry Manifest entry to write.
@@ -47,13 +51,34 @@ class ICEBERG_EXPORT ManifestWriter {
   Status Add(const ManifestEntry& entry);
 
   /// \brief Write manifest entries to file.
+  ///
+  /// The entries are appended to the batches of the manifest column by column, which
+  /// is faster than adding them one at a time for large manifests.
   /// \param entries Manifest entries to write.
   /// \return Status::OK() if all entries were written successfully
-  Status AddAll(const std::vector<ManifestEntry>& entries);
+  Status AddAll(std::span<const ManifestEntry> entries);
 
   /// \brief Close writer and flush to storage.
   Status Close();
 
+  /// \brief Get the estimated length of the manifest while it is written.
+  ///
+  /// Entries are written in batches, so the estimate does not include the entries of
+  /// the batch being filled.
+  ///
+  /// \return The estimated length, or std::nullopt if the file format cannot estimate it.
+  std::optional<int64_t> estimated_length() const;
+
+  /// \brief Get the manifest list entry of the written manifest file.
+  ///
+  /// The entry has the entry counts of the manifest and the summaries of its partition
+  /// values. Its sequence numbers are unassigned if the manifest has added entries
+  /// without one, and are inherited when it is written to the manifest list of the
+  /// snapshot that adds it.
+  ///
+  /// \return The manifest file, or an error if the writer is not closed.
+  Result<ManifestFile> ToManifestFile() const;
+
   /// \brief Creates a writer for a manifest file.
   /// \param snapshot_id ID of the snapshot.
   /// \param manifest_location Path to the manifest file.
@@ -87,9 +112,16 @@ class ICEBERG_EXPORT ManifestWriter {
       std::shared_ptr<PartitionSpec> partition_spec);
 
  private:
+  struct Summary;
+
   static constexpr int64_t kBatchSize = 1024;
   std::unique_ptr<Writer> writer_;
   std::unique_ptr<ManifestEntryAdapter> adapter_;
+  std::string manifest_location_;
+  std::optional<int64_t> snapshot_id_;
+  std::shared_ptr<PartitionSpec> partition_spec_;
+  std::unique_ptr<Summary> summary_;
+  bool closed_ = false;
 };
 
 /// \brief Write manifest files to a manifest list file.
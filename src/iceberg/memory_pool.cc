@@ -0,0 +1,340 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/memory_pool.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief The address of the buffers of zero bytes, which are not allocated.
+alignas(MemoryPool::kDefaultAlignment) uint8_t zero_size_area[1];
+
+Status CheckAllocation(int64_t size, int64_t alignment) {
+  if (size < 0) {
+    return InvalidArgument("Cannot allocate a buffer of negative size {}", size);
+  }
+  if (alignment <= 0 || !std::has_single_bit(static_cast<uint64_t>(alignment)) ||
+      alignment > MemoryPool::kDefaultAlignment) {
+    return InvalidArgument("Invalid buffer alignment {}", alignment);
+  }
+  return {};
+}
+
+/// \brief Updates `max` to `value` if it is higher.
+void UpdateMax(std::atomic<int64_t>& max, int64_t value) {
+  int64_t current = max.load(std::memory_order_relaxed);
+  while (value > current &&
+         !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+  }
+}
+
+class SystemMemoryPool : public MemoryPool {
+ public:
+  Status Allocate(int64_t size, int64_t alignment, uint8_t** out) override {
+    ICEBERG_RETURN_UNEXPECTED(CheckAllocation(size, alignment));
+    ICEBERG_ASSIGN_OR_RAISE(*out, AllocateAligned(size));
+    Account(size);
+    return {};
+  }
+
+  Status Reallocate(int64_t old_size, int64_t new_size, int64_t alignment,
+                    uint8_t** ptr) override {
+    ICEBERG_RETURN_UNEXPECTED(CheckAllocation(new_size, alignment));
+    if (new_size == old_size) {
+      return {};
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto* buffer, AllocateAligned(new_size));
+    std::memcpy(buffer, *ptr, static_cast<size_t>(std::min(old_size, new_size)));
+    FreeAligned(*ptr);
+    *ptr = buffer;
+    bytes_allocated_.fetch_sub(old_size, std::memory_order_relaxed);
+    Account(new_size);
+    return {};
+  }
+
+  void Free(uint8_t* buffer, int64_t size, int64_t alignment) override {
+    FreeAligned(buffer);
+    bytes_allocated_.fetch_sub(size, std::memory_order_relaxed);
+  }
+
+  int64_t bytes_allocated() const override {
+    return bytes_allocated_.load(std::memory_order_relaxed);
+  }
+
+  int64_t max_memory() const override {
+    return max_memory_.load(std::memory_order_relaxed);
+  }
+
+  int64_t total_bytes_allocated() const override {
+    return total_bytes_allocated_.load(std::memory_order_relaxed);
+  }
+
+  int64_t num_allocations() const override {
+    return num_allocations_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  static Result<uint8_t*> AllocateAligned(int64_t size) {
+    if (size == 0) {
+      return zero_size_area;
+    }
+    // aligned_alloc requires a size that is a multiple of the alignment.
+    const auto rounded = (static_cast<size_t>(size) + kDefaultAlignment - 1) &
+                         ~static_cast<size_t>(kDefaultAlignment - 1);
+    auto* buffer = static_cast<uint8_t*>(std::aligned_alloc(kDefaultAlignment, rounded));
+    if (buffer == nullptr) {
+      return OutOfMemory("Failed to allocate {} bytes", size);
+    }
+    return buffer;
+  }
+
+  static void FreeAligned(uint8_t* buffer) {
+    if (buffer != zero_size_area) {
+      std::free(buffer);
+    }
+  }
+
+  void Account(int64_t size) {
+    UpdateMax(max_memory_, bytes_allocated_.fetch_add(size, std::memory_order_relaxed) +
+                               size);
+    total_bytes_allocated_.fetch_add(size, std::memory_order_relaxed);
+    num_allocations_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  std::atomic<int64_t> bytes_allocated_{0};
+  std::atomic<int64_t> max_memory_{0};
+  std::atomic<int64_t> total_bytes_allocated_{0};
+  std::atomic<int64_t> num_allocations_{0};
+};
+
+}  // namespace
+
+const std::shared_ptr<MemoryPool>& MemoryPool::System() {
+  static const std::shared_ptr<MemoryPool> pool = std::make_shared<SystemMemoryPool>();
+  return pool;
+}
+
+TrackingMemoryPool::TrackingMemoryPool(std::optional<int64_t> limit,
+                                       std::shared_ptr<MemoryPool> parent)
+    : limit_(limit), parent_(parent != nullptr ? std::move(parent) : System()) {}
+
+Status TrackingMemoryPool::Reserve(int64_t size) {
+  const int64_t allocated = bytes_allocated_.fetch_add(size, std::memory_order_relaxed);
+  if (limit_.has_value() && allocated + size > limit_.value()) {
+    bytes_allocated_.fetch_sub(size, std::memory_order_relaxed);
+    return OutOfMemory(
+        "Cannot allocate {} bytes, {} of the limit of {} bytes are allocated", size,
+        allocated, limit_.value());
+  }
+  UpdateMax(max_memory_, allocated + size);
+  total_bytes_allocated_.fetch_add(size, std::memory_order_relaxed);
+  num_allocations_.fetch_add(1, std::memory_order_relaxed);
+  return {};
+}
+
+void TrackingMemoryPool::Release(int64_t size) {
+  bytes_allocated_.fetch_sub(size, std::memory_order_relaxed);
+}
+
+Status TrackingMemoryPool::Allocate(int64_t size, int64_t alignment, uint8_t** out) {
+  ICEBERG_RETURN_UNEXPECTED(Reserve(size));
+  auto status = parent_->Allocate(size, alignment, out);
+  if (!status.has_value()) {
+    Release(size);
+  }
+  return status;
+}
+
+Status TrackingMemoryPool::Reallocate(int64_t old_size, int64_t new_size,
+                                      int64_t alignment, uint8_t** ptr) {
+  const int64_t growth = std::max<int64_t>(new_size - old_size, 0);
+  ICEBERG_RETURN_UNEXPECTED(Reserve(growth));
+  auto status = parent_->Reallocate(old_size, new_size, alignment, ptr);
+  if (!status.has_value()) {
+    Release(growth);
+  } else if (new_size < old_size) {
+    Release(old_size - new_size);
+  }
+  return status;
+}
+
+void TrackingMemoryPool::Free(uint8_t* buffer, int64_t size, int64_t alignment) {
+  parent_->Free(buffer, size, alignment);
+  Release(size);
+}
+
+int64_t TrackingMemoryPool::bytes_allocated() const {
+  return bytes_allocated_.load(std::memory_order_relaxed);
+}
+
+int64_t TrackingMemoryPool::max_memory() const {
+  return max_memory_.load(std::memory_order_relaxed);
+}
+
+int64_t TrackingMemoryPool::total_bytes_allocated() const {
+  return total_bytes_allocated_.load(std::memory_order_relaxed);
+}
+
+int64_t TrackingMemoryPool::num_allocations() const {
+  return num_allocations_.load(std::memory_order_relaxed);
+}
+
+RecyclingMemoryPool::RecyclingMemoryPool(int64_t max_retained_bytes,
+                                         std::shared_ptr<MemoryPool> parent)
+    : max_retained_bytes_(max_retained_bytes),
+      parent_(parent != nullptr ? std::move(parent) : System()) {}
+
+RecyclingMemoryPool::~RecyclingMemoryPool() {
+  for (size_t size_class = 0; size_class < free_buffers_.size(); ++size_class) {
+    for (auto* buffer : free_buffers_[size_class]) {
+      parent_->Free(buffer, int64_t{1} << size_class, kDefaultAlignment);
+    }
+  }
+}
+
+int RecyclingMemoryPool::SizeClass(int64_t size) const {
+  if (size <= 0 || size > max_retained_bytes_) {
+    return -1;
+  }
+  return static_cast<int>(std::bit_width(
+      static_cast<uint64_t>(std::max<int64_t>(size, kDefaultAlignment) - 1)));
+}
+
+Result<uint8_t*> RecyclingMemoryPool::AllocateClass(int size_class) {
+  const int64_t class_size = int64_t{1} << size_class;
+  {
+    std::lock_guard lock(mutex_);
+    auto& buffers = free_buffers_[size_class];
+    if (!buffers.empty()) {
+      auto* buffer = buffers.back();
+      buffers.pop_back();
+      bytes_retained_ -= class_size;
+      ++num_recycled_;
+      return buffer;
+    }
+  }
+  uint8_t* buffer = nullptr;
+  ICEBERG_RETURN_UNEXPECTED(parent_->Allocate(class_size, kDefaultAlignment, &buffer));
+  return buffer;
+}
+
+void RecyclingMemoryPool::FreeClass(uint8_t* buffer, int size_class) {
+  const int64_t class_size = int64_t{1} << size_class;
+  {
+    std::lock_guard lock(mutex_);
+    if (bytes_retained_ + class_size <= max_retained_bytes_) {
+      free_buffers_[size_class].push_back(buffer);
+      bytes_retained_ += class_size;
+      return;
+    }
+  }
+  parent_->Free(buffer, class_size, kDefaultAlignment);
+}
+
+void RecyclingMemoryPool::Account(int64_t size) {
+  UpdateMax(max_memory_,
+            bytes_allocated_.fetch_add(size, std::memory_order_relaxed) + size);
+  total_bytes_allocated_.fetch_add(size, std::memory_order_relaxed);
+  num_allocations_.fetch_add(1, std::memory_order_relaxed);
+}
+
+Status RecyclingMemoryPool::Allocate(int64_t size, int64_t alignment, uint8_t** out) {
+  ICEBERG_RETURN_UNEXPECTED(CheckAllocation(size, alignment));
+  if (const int size_class = SizeClass(size); size_class >= 0) {
+    ICEBERG_ASSIGN_OR_RAISE(*out, AllocateClass(size_class));
+  } else {
+    ICEBERG_RETURN_UNEXPECTED(parent_->Allocate(size, alignment, out));
+  }
+  Account(size);
+  return {};
+}
+
+Status RecyclingMemoryPool::Reallocate(int64_t old_size, int64_t new_size,
+                                       int64_t alignment, uint8_t** ptr) {
+  ICEBERG_RETURN_UNEXPECTED(CheckAllocation(new_size, alignment));
+  const int old_class = SizeClass(old_size);
+  const int new_class = SizeClass(new_size);
+  if (old_class < 0 && new_class < 0) {
+    ICEBERG_RETURN_UNEXPECTED(parent_->Reallocate(old_size, new_size, alignment, ptr));
+  } else if (old_class != new_class) {
+    uint8_t* buffer = nullptr;
+    if (new_class >= 0) {
+      ICEBERG_ASSIGN_OR_RAISE(buffer, AllocateClass(new_class));
+    } else {
+      ICEBERG_RETURN_UNEXPECTED(parent_->Allocate(new_size, alignment, &buffer));
+    }
+    std::memcpy(buffer, *ptr, static_cast<size_t>(std::min(old_size, new_size)));
+    if (old_class >= 0) {
+      FreeClass(*ptr, old_class);
+    } else {
+      parent_->Free(*ptr, old_size, alignment);
+    }
+    *ptr = buffer;
+  }
+  // A buffer resized within its size class keeps its memory.
+  bytes_allocated_.fetch_sub(old_size, std::memory_order_relaxed);
+  Account(new_size);
+  return {};
+}
+
+void RecyclingMemoryPool::Free(uint8_t* buffer, int64_t size, int64_t alignment) {
+  if (const int size_class = SizeClass(size); size_class >= 0) {
+    FreeClass(buffer, size_class);
+  } else {
+    parent_->Free(buffer, size, alignment);
+  }
+  bytes_allocated_.fetch_sub(size, std::memory_order_relaxed);
+}
+
+int64_t RecyclingMemoryPool::bytes_allocated() const {
+  return bytes_allocated_.load(std::memory_order_relaxed);
+}
+
+int64_t RecyclingMemoryPool::max_memory() const {
+  return max_memory_.load(std::memory_order_relaxed);
+}
+
+int64_t RecyclingMemoryPool::total_bytes_allocated() const {
+  return total_bytes_allocated_.load(std::memory_order_relaxed);
+}
+
+int64_t RecyclingMemoryPool::num_allocations() const {
+  return num_allocations_.load(std::memory_order_relaxed);
+}
+
+int64_t RecyclingMemoryPool::bytes_retained() const {
+  std::lock_guard lock(mutex_);
+  return bytes_retained_;
+}
+
+int64_t RecyclingMemoryPool::num_recycled() const {
+  std::lock_guard lock(mutex_);
+  return num_recycled_;
+}
+
+}  // namespace iceberg
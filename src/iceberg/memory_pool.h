@@ -0,0 +1,198 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/memory_pool.h
+/// Memory pools of the buffers allocated by file readers and writers.
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+
+namespace iceberg {
+
+/// \brief Allocates the buffers of file readers and writers, and accounts for them.
+///
+/// Readers and writers given a pool through ReaderOptions or WriterOptions allocate
+/// the buffers of the batches they read or write from it, such as the Arrow buffers
+/// of the Parquet and Avro implementations. A pool must outlive the readers and
+/// writers using it and the batches they return. Implementations must be thread-safe.
+class ICEBERG_EXPORT MemoryPool {
+ public:
+  /// \brief The alignment of the buffers allocated by default, suitable for SIMD.
+  static constexpr int64_t kDefaultAlignment = 64;
+
+  virtual ~MemoryPool() = default;
+
+  /// \brief Allocates a buffer of `size` bytes aligned to `alignment` bytes.
+  ///
+  /// \return An OutOfMemory error if the buffer cannot be allocated.
+  virtual Status Allocate(int64_t size, int64_t alignment, uint8_t** out) = 0;
+
+  /// \brief Resizes a buffer allocated by this pool, which may move it.
+  ///
+  /// \return An OutOfMemory error if the buffer cannot be resized, in which case it is
+  /// left unchanged.
+  virtual Status Reallocate(int64_t old_size, int64_t new_size, int64_t alignment,
+                            uint8_t** ptr) = 0;
+
+  /// \brief Frees a buffer allocated by this pool.
+  virtual void Free(uint8_t* buffer, int64_t size, int64_t alignment) = 0;
+
+  /// \brief The number of bytes currently allocated.
+  virtual int64_t bytes_allocated() const = 0;
+
+  /// \brief The highest number of bytes allocated at once.
+  virtual int64_t max_memory() const = 0;
+
+  /// \brief The number of bytes allocated over the lifetime of the pool, including
+  /// the bytes freed since.
+  virtual int64_t total_bytes_allocated() const = 0;
+
+  /// \brief The number of allocations and reallocations made.
+  virtual int64_t num_allocations() const = 0;
+
+  /// \brief Returns the process-wide pool allocating with the system allocator.
+  static const std::shared_ptr<MemoryPool>& System();
+};
+
+/// \brief A pool accounting for the buffers allocated through it from a parent pool,
+/// optionally up to a limit.
+///
+/// A tracking pool is typically created for each scan or writer, to measure its memory
+/// usage while other scans and writers share the process, and to fail it gracefully
+/// with an OutOfMemory error instead of exhausting the memory of the process. Tracking
+/// pools can be nested, e.g. a pool per scan with a parent pool per query, in which case
+/// the limits of all of them apply.
+class ICEBERG_EXPORT TrackingMemoryPool : public MemoryPool {
+ public:
+  /// \brief Creates a pool allocating from `parent`.
+  ///
+  /// \param limit The maximum number of bytes allocated at once, unlimited if unset
+  /// \param parent The pool to allocate from, the system pool if null
+  explicit TrackingMemoryPool(std::optional<int64_t> limit = std::nullopt,
+                              std::shared_ptr<MemoryPool> parent = nullptr);
+
+  Status Allocate(int64_t size, int64_t alignment, uint8_t** out) override;
+
+  Status Reallocate(int64_t old_size, int64_t new_size, int64_t alignment,
+                    uint8_t** ptr) override;
+
+  void Free(uint8_t* buffer, int64_t size, int64_t alignment) override;
+
+  int64_t bytes_allocated() const override;
+  int64_t max_memory() const override;
+  int64_t total_bytes_allocated() const override;
+  int64_t num_allocations() const override;
+
+  /// \brief The maximum number of bytes allocated at once, if any.
+  const std::optional<int64_t>& limit() const { return limit_; }
+
+ private:
+  /// \brief Accounts for `size` more bytes, failing if the limit would be exceeded.
+  Status Reserve(int64_t size);
+
+  /// \brief Accounts for `size` bytes less.
+  void Release(int64_t size);
+
+  std::optional<int64_t> limit_;
+  std::shared_ptr<MemoryPool> parent_;
+  std::atomic<int64_t> bytes_allocated_{0};
+  std::atomic<int64_t> max_memory_{0};
+  std::atomic<int64_t> total_bytes_allocated_{0};
+  std::atomic<int64_t> num_allocations_{0};
+};
+
+/// \brief A pool keeping the buffers freed through it for its next allocations instead
+/// of returning them to a parent pool.
+///
+/// The batches read from a file have buffers of about the same sizes, which are freed
+/// when the consumer releases a batch and allocated again for the next one. Readers
+/// given a recycling pool, e.g. one per scan, reuse these buffers without going through
+/// the allocator once reading is steady, which matters when many concurrent scans
+/// contend on it. Buffers are recycled in power-of-two size classes, so a growing buffer
+/// also keeps its memory within its class, and up to `max_retained_bytes` bytes of them
+/// are kept, beyond which freed buffers go back to the parent pool. The kept buffers are
+/// returned to the parent when the pool is destroyed.
+class ICEBERG_EXPORT RecyclingMemoryPool : public MemoryPool {
+ public:
+  /// \brief Creates a pool allocating from `parent`.
+  ///
+  /// \param max_retained_bytes The maximum number of bytes of freed buffers kept for
+  /// the next allocations. Larger buffers are not recycled.
+  /// \param parent The pool to allocate from, the system pool if null
+  explicit RecyclingMemoryPool(int64_t max_retained_bytes,
+                               std::shared_ptr<MemoryPool> parent = nullptr);
+
+  ~RecyclingMemoryPool() override;
+
+  Status Allocate(int64_t size, int64_t alignment, uint8_t** out) override;
+
+  Status Reallocate(int64_t old_size, int64_t new_size, int64_t alignment,
+                    uint8_t** ptr) override;
+
+  void Free(uint8_t* buffer, int64_t size, int64_t alignment) override;
+
+  int64_t bytes_allocated() const override;
+  int64_t max_memory() const override;
+  int64_t total_bytes_allocated() const override;
+  int64_t num_allocations() const override;
+
+  /// \brief The number of bytes of freed buffers kept for the next allocations.
+  int64_t bytes_retained() const;
+
+  /// \brief The number of buffers allocated by reusing a freed buffer.
+  int64_t num_recycled() const;
+
+ private:
+  /// \brief Returns the base-2 logarithm of the size class of a buffer, or -1 if
+  /// buffers of its size are not recycled.
+  int SizeClass(int64_t size) const;
+
+  /// \brief Returns a buffer of a size class, reusing a freed one if there is any.
+  Result<uint8_t*> AllocateClass(int size_class);
+
+  /// \brief Keeps a buffer of a size class for the next allocations, or frees it if
+  /// the pool retains enough bytes already.
+  void FreeClass(uint8_t* buffer, int size_class);
+
+  void Account(int64_t size);
+
+  const int64_t max_retained_bytes_;
+  std::shared_ptr<MemoryPool> parent_;
+  mutable std::mutex mutex_;
+  /// \brief The freed buffers of each size class.
+  std::array<std::vector<uint8_t*>, 64> free_buffers_;
+  int64_t bytes_retained_ = 0;
+  int64_t num_recycled_ = 0;
+  std::atomic<int64_t> bytes_allocated_{0};
+  std::atomic<int64_t> max_memory_{0};
+  std::atomic<int64_t> total_bytes_allocated_{0};
+  std::atomic<int64_t> num_allocations_{0};
+};
+
+}  // namespace iceberg
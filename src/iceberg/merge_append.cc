@@ -0,0 +1,185 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/merge_append.h"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <utility>
+
+#include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_reader.h"
+#include "iceberg/manifest_writer.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/table.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/table_properties.h"
+#include "iceberg/type.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief Packs items into bins of at most `target_weight`, starting from the end.
+///
+/// Packing from the end leaves the bin with the first items as the one that is not
+/// full. Bins and the items within each bin keep the order of `items`.
+std::vector<std::vector<ManifestFile>> PackEnd(std::vector<ManifestFile> items,
+                                               int64_t target_weight) {
+  std::vector<std::vector<ManifestFile>> bins;
+  int64_t bin_weight = 0;
+  for (auto it = items.rbegin(); it != items.rend(); ++it) {
+    if (bins.empty() ||
+        (!bins.back().empty() && bin_weight + it->manifest_length > target_weight)) {
+      bins.emplace_back();
+      bin_weight = 0;
+    }
+    bin_weight += it->manifest_length;
+    bins.back().push_back(std::move(*it));
+  }
+  for (auto& bin : bins) {
+    std::ranges::reverse(bin);
+  }
+  std::ranges::reverse(bins);
+  return bins;
+}
+
+}  // namespace
+
+MergeAppend::MergeAppend(std::shared_ptr<Table> table) : FastAppend(std::move(table)) {}
+
+MergeAppend::~MergeAppend() = default;
+
+Result<std::vector<ManifestFile>> MergeAppend::Apply(const TableMetadata& base,
+                                                     const Snapshot* parent) {
+  // The new manifests come first, followed by the manifests of the parent.
+  ICEBERG_ASSIGN_OR_RAISE(auto manifests, FastAppend::Apply(base, parent));
+
+  const auto& properties = table()->properties();
+  if (!properties.Get(TableProperties::kManifestMergeEnabled)) {
+    return manifests;
+  }
+  const int64_t target_size_bytes =
+      properties.Get(TableProperties::kManifestTargetSizeBytes);
+  const int32_t min_count_to_merge =
+      std::max(properties.Get(TableProperties::kManifestMinMergeCount), 0);
+
+  // Data manifests before delete manifests, and newer partition specs first.
+  using GroupKey = std::pair<ManifestFile::Content, int32_t>;
+  auto compare = [](const GroupKey& lhs, const GroupKey& rhs) {
+    return std::tuple(lhs.first, -int64_t{lhs.second}) <
+           std::tuple(rhs.first, -int64_t{rhs.second});
+  };
+  std::map<GroupKey, std::vector<ManifestFile>, decltype(compare)> groups(compare);
+  for (auto& manifest : manifests) {
+    groups[{manifest.content, manifest.partition_spec_id}].push_back(
+        std::move(manifest));
+  }
+
+  std::vector<ManifestFile> merged;
+  for (auto& [key, group] : groups) {
+    ICEBERG_ASSIGN_OR_RAISE(auto group_manifests,
+                            MergeGroup(base, std::move(group), target_size_bytes,
+                                       min_count_to_merge));
+    merged.insert(merged.end(), std::make_move_iterator(group_manifests.begin()),
+                  std::make_move_iterator(group_manifests.end()));
+  }
+  return merged;
+}
+
+Result<std::vector<ManifestFile>> MergeAppend::MergeGroup(const TableMetadata& base,
+                                                          std::vector<ManifestFile> group,
+                                                          int64_t target_size_bytes,
+                                                          int32_t min_count_to_merge) {
+  const std::string newest = group.front().manifest_path;
+  std::vector<ManifestFile> manifests;
+  for (auto& bin : PackEnd(std::move(group), target_size_bytes)) {
+    const bool has_newest = bin.front().manifest_path == newest;
+    if (bin.size() == 1 ||
+        (has_newest && bin.size() < static_cast<size_t>(min_count_to_merge))) {
+      // Not worth a rewrite yet, keep the manifests as they are.
+      manifests.insert(manifests.end(), std::make_move_iterator(bin.begin()),
+                       std::make_move_iterator(bin.end()));
+      continue;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto manifest, MergeBin(base, bin));
+    manifests.push_back(std::move(manifest));
+  }
+  return manifests;
+}
+
+Result<ManifestFile> MergeAppend::MergeBin(const TableMetadata& base,
+                                           const std::vector<ManifestFile>& bin) {
+  std::vector<std::string> key;
+  key.reserve(bin.size());
+  for (const auto& manifest : bin) {
+    key.push_back(manifest.manifest_path);
+  }
+  if (auto it = merged_manifests_.find(key); it != merged_manifests_.end()) {
+    return it->second;
+  }
+
+  ICEBERG_ASSIGN_OR_RAISE(auto spec,
+                          base.PartitionSpecById(bin.front().partition_spec_id));
+  ICEBERG_ASSIGN_OR_RAISE(auto partition_schema, spec->PartitionSchema());
+  ICEBERG_ASSIGN_OR_RAISE(auto writer, NewManifestWriter(base, std::move(spec)));
+  for (const auto& manifest : bin) {
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto reader, ManifestReader::Make(manifest, table()->io(), partition_schema));
+    ICEBERG_RETURN_UNEXPECTED(reader->VisitEntries([&](ManifestEntry&& entry) -> Status {
+      if (entry.snapshot_id == snapshot_id()) {
+        // Changes of this snapshot keep their status, and added files inherit their
+        // sequence numbers from the committed snapshot.
+        if (entry.status == ManifestStatus::kAdded) {
+          entry.sequence_number.reset();
+          entry.file_sequence_number.reset();
+        }
+      } else if (entry.status == ManifestStatus::kDeleted) {
+        // Deletes of older snapshots are only tracked by the manifests of those
+        // snapshots.
+        return {};
+      } else {
+        entry.status = ManifestStatus::kExisting;
+      }
+      return writer->Add(entry);
+    }));
+  }
+  ICEBERG_RETURN_UNEXPECTED(writer->Close());
+  ICEBERG_ASSIGN_OR_RAISE(auto merged, writer->ToManifestFile());
+  merged_manifests_.emplace(std::move(key), merged);
+  return merged;
+}
+
+void MergeAppend::CleanUncommitted(const std::unordered_set<std::string>& committed) {
+  FastAppend::CleanUncommitted(committed);
+  for (auto it = merged_manifests_.begin(); it != merged_manifests_.end();) {
+    if (!committed.contains(it->second.manifest_path)) {
+      DeleteFile(it->second.manifest_path);
+      it = merged_manifests_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+}  // namespace iceberg
@@ -0,0 +1,81 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/merge_append.h
+/// Append that merges small manifests into larger ones when committing.
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "iceberg/fast_append.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief Append implementation that merges manifests when committing.
+///
+/// The new files are written to new manifests as with FastAppend. The new manifests and
+/// the manifests of the current snapshot are then grouped by content and partition
+/// spec, and the manifests of each group are bin-packed into manifests of about
+/// `commit.manifest.target-size-bytes`. The bin that holds the newest manifests is only
+/// merged once it has `commit.manifest.min-count-to-merge` manifests, so that small
+/// commits do not rewrite a manifest each time. Merging is disabled by setting
+/// `commit.manifest-merge.enabled` to false.
+///
+/// Entries are streamed from the merged manifests to the new manifest, and merged
+/// manifests are reused by retries of the commit when their inputs are unchanged.
+class ICEBERG_EXPORT MergeAppend : public FastAppend {
+ public:
+  /// \brief Creates an append to a table.
+  ///
+  /// \param table The table to append to, which must have a catalog to commit to
+  explicit MergeAppend(std::shared_ptr<Table> table);
+
+  ~MergeAppend() override;
+
+ protected:
+  Result<std::vector<ManifestFile>> Apply(const TableMetadata& base,
+                                          const Snapshot* parent) override;
+
+  void CleanUncommitted(const std::unordered_set<std::string>& committed) override;
+
+ private:
+  /// \brief Bin-packs and merges the manifests of one content and partition spec,
+  /// ordered from the newest to the oldest.
+  Result<std::vector<ManifestFile>> MergeGroup(const TableMetadata& base,
+                                               std::vector<ManifestFile> group,
+                                               int64_t target_size_bytes,
+                                               int32_t min_count_to_merge);
+
+  /// \brief Writes the live entries of a bin of manifests to a single manifest.
+  Result<ManifestFile> MergeBin(const TableMetadata& base,
+                                const std::vector<ManifestFile>& bin);
+
+  // Merged manifests by the paths of the manifests they were merged from
+  std::map<std::vector<std::string>, ManifestFile> merged_manifests_;
+};
+
+}  // namespace iceberg
@@ -48,7 +48,7 @@ struct ICEBERG_EXPORT MetadataColumns {
                                 "Ordinal position of a row in the source data file");
 
   inline static const SchemaField kIsDeleted = SchemaField::MakeRequired(
-      kInt32Max - 3, "_deleted", iceberg::binary(), "Whether the row has been deleted");
+      kInt32Max - 3, "_deleted", iceberg::boolean(), "Whether the row has been deleted");
 
   inline static const SchemaField kSpecId =
       SchemaField::MakeRequired(kInt32Max - 4, "_spec_id", iceberg::int32(),
@@ -0,0 +1,168 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/metadata_intern_pool.h"
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/sort_order.h"
+#include "iceberg/table_metadata.h"
+
+namespace iceberg {
+
+namespace {
+
+bool Equivalent(const Schema& lhs, const Schema& rhs) { return lhs == rhs; }
+
+bool Equivalent(const SortOrder& lhs, const SortOrder& rhs) { return lhs == rhs; }
+
+/// \brief Specs are compared once their schemas are interned, so equal schemas are
+/// the same instance.
+bool Equivalent(const PartitionSpec& lhs, const PartitionSpec& rhs) {
+  return lhs == rhs && lhs.last_assigned_field_id() == rhs.last_assigned_field_id() &&
+         lhs.schema() == rhs.schema();
+}
+
+}  // namespace
+
+/// \brief The pooled values of a type, by the hash of their string form.
+template <typename T>
+class MetadataInternPool::Entries {
+ public:
+  std::shared_ptr<T> Intern(const std::shared_ptr<T>& value, Stats& stats) {
+    const size_t hash = std::hash<std::string>{}(value->ToString());
+    auto [it, end] = entries_.equal_range(hash);
+    while (it != end) {
+      auto pooled = it->second.lock();
+      if (pooled == nullptr) {
+        it = entries_.erase(it);
+        --stats.entry_count;
+        continue;
+      }
+      if (pooled == value) {
+        return pooled;
+      }
+      if (Equivalent(*pooled, *value)) {
+        ++stats.hits;
+        return pooled;
+      }
+      ++it;
+    }
+
+    entries_.emplace(hash, value);
+    ++stats.misses;
+    ++stats.entry_count;
+    if (entries_.size() >= sweep_size_) {
+      Sweep(stats);
+    }
+    return value;
+  }
+
+ private:
+  /// \brief Drops the entries of the values that are no longer used, and sets the size
+  /// of the next sweep to twice the number of remaining entries.
+  void Sweep(Stats& stats) {
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      if (it->second.expired()) {
+        it = entries_.erase(it);
+        --stats.entry_count;
+      } else {
+        ++it;
+      }
+    }
+    sweep_size_ = std::max<size_t>(kMinSweepSize, 2 * entries_.size());
+  }
+
+  static constexpr size_t kMinSweepSize = 64;
+
+  std::unordered_multimap<size_t, std::weak_ptr<T>> entries_;
+  size_t sweep_size_ = kMinSweepSize;
+};
+
+MetadataInternPool::MetadataInternPool()
+    : schemas_(std::make_unique<Entries<Schema>>()),
+      specs_(std::make_unique<Entries<PartitionSpec>>()),
+      sort_orders_(std::make_unique<Entries<SortOrder>>()) {}
+
+MetadataInternPool::~MetadataInternPool() = default;
+
+std::shared_ptr<Schema> MetadataInternPool::Intern(
+    const std::shared_ptr<Schema>& schema) {
+  if (schema == nullptr) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  return schemas_->Intern(schema, stats_);
+}
+
+std::shared_ptr<PartitionSpec> MetadataInternPool::Intern(
+    const std::shared_ptr<PartitionSpec>& spec) {
+  if (spec == nullptr) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto schema = spec->schema();
+  if (schema != nullptr) {
+    schema = schemas_->Intern(schema, stats_);
+  }
+  if (schema == spec->schema()) {
+    return specs_->Intern(spec, stats_);
+  }
+  // Rebind the spec to the pooled schema, so that it does not keep its own copy alive.
+  auto fields = spec->fields();
+  auto rebound = std::make_shared<PartitionSpec>(
+      std::move(schema), spec->spec_id(),
+      std::vector<PartitionField>(fields.begin(), fields.end()),
+      spec->last_assigned_field_id());
+  return specs_->Intern(rebound, stats_);
+}
+
+std::shared_ptr<SortOrder> MetadataInternPool::Intern(
+    const std::shared_ptr<SortOrder>& sort_order) {
+  if (sort_order == nullptr) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  return sort_orders_->Intern(sort_order, stats_);
+}
+
+void MetadataInternPool::Intern(TableMetadata& metadata) {
+  for (auto& schema : metadata.schemas) {
+    schema = Intern(schema);
+  }
+  for (auto& spec : metadata.partition_specs) {
+    spec = Intern(spec);
+  }
+  for (auto& sort_order : metadata.sort_orders) {
+    sort_order = Intern(sort_order);
+  }
+}
+
+MetadataInternPool::Stats MetadataInternPool::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+}  // namespace iceberg
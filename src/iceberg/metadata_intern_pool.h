@@ -0,0 +1,97 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/metadata_intern_pool.h
+/// Deduplicate structurally equal schemas, partition specs and sort orders.
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief Shares structurally equal schemas, partition specs and sort orders.
+///
+/// Tables created from the same definitions hold equal schemas, specs and orders, but
+/// every metadata file read creates its own copies, and each schema builds its own
+/// lookup indexes on first use. Interning a value returns the instance already held by
+/// the pool if one is equal to it, and otherwise adds the value to the pool, so that a
+/// process holding the metadata of many tables keeps a single copy of each distinct
+/// definition and builds its indexes once.
+///
+/// Values are found by a hash of their content and compared with their equality
+/// operators. Partition specs are only shared if their schemas are equal too. The pool
+/// does not keep the values alive: entries whose values are no longer used are dropped
+/// as the pool grows. The pool can be shared by threads.
+///
+/// Set TableMetadataReadOptions::intern_pool to intern the metadata read from files.
+class ICEBERG_EXPORT MetadataInternPool {
+ public:
+  /// \brief Counters describing the use of the pool.
+  struct Stats {
+    /// \brief Number of values replaced by an equal value of the pool.
+    int64_t hits = 0;
+    /// \brief Number of values added to the pool.
+    int64_t misses = 0;
+    /// \brief Number of values currently in the pool, including values that are no
+    /// longer used but were not dropped yet.
+    int64_t entry_count = 0;
+  };
+
+  MetadataInternPool();
+  ~MetadataInternPool();
+
+  MetadataInternPool(const MetadataInternPool&) = delete;
+  MetadataInternPool& operator=(const MetadataInternPool&) = delete;
+
+  /// \brief Returns the schema of the pool equal to `schema`, adding it if missing.
+  std::shared_ptr<Schema> Intern(const std::shared_ptr<Schema>& schema);
+
+  /// \brief Returns the partition spec of the pool equal to `spec`, adding it if
+  /// missing.
+  std::shared_ptr<PartitionSpec> Intern(const std::shared_ptr<PartitionSpec>& spec);
+
+  /// \brief Returns the sort order of the pool equal to `sort_order`, adding it if
+  /// missing.
+  std::shared_ptr<SortOrder> Intern(const std::shared_ptr<SortOrder>& sort_order);
+
+  /// \brief Replaces the schemas, partition specs and sort orders of `metadata` by the
+  /// equal instances of the pool.
+  void Intern(TableMetadata& metadata);
+
+  /// \brief Returns a snapshot of the counters of the pool.
+  Stats stats() const;
+
+ private:
+  template <typename T>
+  class Entries;
+
+  mutable std::mutex mutex_;
+  std::unique_ptr<Entries<Schema>> schemas_;
+  std::unique_ptr<Entries<PartitionSpec>> specs_;
+  std::unique_ptr<Entries<SortOrder>> sort_orders_;
+  Stats stats_;
+};
+
+}  // namespace iceberg
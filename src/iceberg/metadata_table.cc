@@ -0,0 +1,659 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/metadata_table.h"
+
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <nanoarrow/nanoarrow.h>
+
+#include "iceberg/arrow/nanoarrow_status_internal.h"
+#include "iceberg/arrow_c_data_guard_internal.h"
+#include "iceberg/file_reader.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/manifest_reader.h"
+#include "iceberg/partition_statistics.h"
+#include "iceberg/schema.h"
+#include "iceberg/schema_internal.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/type.h"
+#include "iceberg/util/arrow_array_filter_internal.h"
+#include "iceberg/util/macros.h"
+#include "iceberg/util/string_util.h"
+#include "iceberg/util/timepoint.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief Returns the next batch of a metadata table, or nullopt after the last one.
+using NextBatch = std::function<Result<std::optional<ArrowArray>>()>;
+
+/// \brief Private data of the ArrowArrayStream of a metadata table.
+struct MetadataStreamPrivateData {
+  std::shared_ptr<Schema> schema;
+  NextBatch next;
+  std::string last_error;
+};
+
+int GetSchema(struct ArrowArrayStream* stream, struct ArrowSchema* out) {
+  if (!stream || !stream->private_data) {
+    return EINVAL;
+  }
+  auto* private_data = static_cast<MetadataStreamPrivateData*>(stream->private_data);
+  if (auto status = ToArrowSchema(*private_data->schema, out); !status.has_value()) {
+    private_data->last_error = status.error().message;
+    return EINVAL;
+  }
+  return 0;
+}
+
+int GetNext(struct ArrowArrayStream* stream, struct ArrowArray* out) {
+  if (!stream || !stream->private_data) {
+    return EINVAL;
+  }
+  auto* private_data = static_cast<MetadataStreamPrivateData*>(stream->private_data);
+  auto next_result = private_data->next();
+  if (!next_result.has_value()) {
+    private_data->last_error = next_result.error().message;
+    std::memset(out, 0, sizeof(ArrowArray));
+    return EIO;
+  }
+  if (next_result->has_value()) {
+    *out = std::move(next_result->value());
+  } else {
+    // End of stream, signaled by a released array.
+    std::memset(out, 0, sizeof(ArrowArray));
+  }
+  return 0;
+}
+
+const char* GetLastError(struct ArrowArrayStream* stream) {
+  if (!stream || !stream->private_data) {
+    return nullptr;
+  }
+  auto* private_data = static_cast<MetadataStreamPrivateData*>(stream->private_data);
+  return private_data->last_error.empty() ? nullptr : private_data->last_error.c_str();
+}
+
+void Release(struct ArrowArrayStream* stream) {
+  if (!stream || !stream->private_data) {
+    return;
+  }
+  delete static_cast<MetadataStreamPrivateData*>(stream->private_data);
+  stream->private_data = nullptr;
+  stream->release = nullptr;
+}
+
+ArrowArrayStream MakeStream(std::shared_ptr<Schema> schema, NextBatch next) {
+  auto private_data = std::make_unique<MetadataStreamPrivateData>();
+  private_data->schema = std::move(schema);
+  private_data->next = std::move(next);
+  return ArrowArrayStream{.get_schema = GetSchema,
+                          .get_next = GetNext,
+                          .get_last_error = GetLastError,
+                          .release = Release,
+                          .private_data = private_data.release()};
+}
+
+/// \brief Returns a source of a single batch, built when it is requested.
+NextBatch SingleBatch(std::function<Result<ArrowArray>()> build) {
+  return [build = std::move(build),
+          done = false]() mutable -> Result<std::optional<ArrowArray>> {
+    if (done) {
+      return std::nullopt;
+    }
+    done = true;
+    ICEBERG_ASSIGN_OR_RAISE(auto batch, build());
+    return batch;
+  };
+}
+
+/// \brief Returns the position of the field with the given id in a struct type.
+int64_t FieldIndex(const StructType& type, int32_t field_id) {
+  const auto fields = type.fields();
+  for (size_t i = 0; i < fields.size(); ++i) {
+    if (fields[i].field_id() == field_id) {
+      return static_cast<int64_t>(i);
+    }
+  }
+  return -1;
+}
+
+/// \brief Reads the batches of Avro files one file after another.
+///
+/// Each file is opened when the batches of the previous one have been read, and all
+/// files are read with the same projection so that their batches share a schema.
+class AvroFileBatches {
+ public:
+  struct File {
+    std::string path;
+    std::optional<size_t> length;
+  };
+
+  AvroFileBatches(std::vector<File> files, std::shared_ptr<FileIO> io,
+                  std::shared_ptr<Schema> projection)
+      : files_(std::move(files)),
+        io_(std::move(io)),
+        projection_(std::move(projection)) {}
+
+  ~AvroFileBatches() {
+    if (schema_.release != nullptr) {
+      schema_.release(&schema_);
+    }
+    if (reader_ != nullptr) {
+      std::ignore = reader_->Close();
+    }
+  }
+
+  /// \brief Returns the next batch, or nullopt after the batches of the last file.
+  Result<std::optional<ArrowArray>> Next() {
+    while (true) {
+      if (reader_ == nullptr) {
+        if (next_file_ == files_.size()) {
+          return std::nullopt;
+        }
+        const auto& file = files_[next_file_];
+        ICEBERG_ASSIGN_OR_RAISE(reader_, ReaderFactoryRegistry::Open(
+                                             FileFormatType::kAvro,
+                                             {.path = file.path,
+                                              .length = file.length,
+                                              .io = io_,
+                                              .projection = projection_}));
+        if (schema_.release == nullptr) {
+          ICEBERG_ASSIGN_OR_RAISE(schema_, reader_->Schema());
+        }
+      }
+      ICEBERG_ASSIGN_OR_RAISE(auto batch, reader_->Next());
+      if (batch.has_value()) {
+        return batch;
+      }
+      ICEBERG_RETURN_UNEXPECTED(reader_->Close());
+      reader_.reset();
+      ++next_file_;
+    }
+  }
+
+  /// \brief The index of the file of the last returned batch.
+  size_t file_index() const { return next_file_; }
+
+  /// \brief The Arrow schema of the batches, set once the first file is opened.
+  const ArrowSchema& schema() const { return schema_; }
+
+ private:
+  std::vector<File> files_;
+  std::shared_ptr<FileIO> io_;
+  std::shared_ptr<Schema> projection_;
+  size_t next_file_ = 0;
+  std::unique_ptr<Reader> reader_;
+  ArrowSchema schema_{};
+};
+
+/// \brief Replaces the null snapshot ids and sequence numbers of a batch of manifest
+/// entries with the values inherited from their manifest, as ManifestReader does.
+///
+/// Only the columns with null values are rebuilt, the others are kept as decoded.
+Status InheritEntryColumns(const StructType& entry_type, const ArrowSchema& schema,
+                           ArrowArray& batch, const ManifestFile& manifest) {
+  ArrowError error;
+  ArrowArrayView view;
+  ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(
+      ArrowArrayViewInitFromSchema(&view, &schema, &error), error);
+  internal::ArrowArrayViewGuard view_guard(&view);
+  ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(
+      ArrowArrayViewSetArray(&view, &batch, &error), error);
+  const ArrowArrayView* status_view =
+      view.children[FieldIndex(entry_type, ManifestEntry::kStatus.field_id())];
+  // Sequence numbers are not stored in v1 manifests, whose sequence number is 0, and are
+  // only inherited by added entries in later versions.
+  const bool added_only = manifest.sequence_number != 0;
+
+  auto inherit = [&](int32_t field_id, int64_t value, bool only_added) -> Status {
+    const int64_t index = FieldIndex(entry_type, field_id);
+    const ArrowArrayView* column = view.children[index];
+    // A null count of -1 is unknown, for which the column is rebuilt.
+    if (batch.children[index]->null_count == 0) {
+      return {};
+    }
+    ArrowArray inherited;
+    ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(
+        ArrowArrayInitFromSchema(&inherited, schema.children[index], &error), error);
+    auto build = [&]() -> Status {
+      ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayStartAppending(&inherited));
+      for (int64_t row = 0; row < column->length; ++row) {
+        if (!ArrowArrayViewIsNull(column, row)) {
+          ICEBERG_NANOARROW_RETURN_UNEXPECTED(
+              ArrowArrayAppendInt(&inherited, ArrowArrayViewGetIntUnsafe(column, row)));
+        } else if (!only_added || ArrowArrayViewGetIntUnsafe(status_view, row) ==
+                                      static_cast<int64_t>(ManifestStatus::kAdded)) {
+          ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayAppendInt(&inherited, value));
+        } else {
+          ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayAppendNull(&inherited, 1));
+        }
+      }
+      ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(
+          ArrowArrayFinishBuildingDefault(&inherited, &error), error);
+      return {};
+    };
+    if (auto status = build(); !status.has_value()) {
+      ArrowArrayRelease(&inherited);
+      return status;
+    }
+    // The parent releases the children it points to, including the replacement.
+    ArrowArray* child = batch.children[index];
+    child->release(child);
+    *child = inherited;
+    return {};
+  };
+  ICEBERG_RETURN_UNEXPECTED(inherit(ManifestEntry::kSnapshotId.field_id(),
+                                    manifest.added_snapshot_id, /*only_added=*/false));
+  ICEBERG_RETURN_UNEXPECTED(inherit(ManifestEntry::kSequenceNumber.field_id(),
+                                    manifest.sequence_number, added_only));
+  ICEBERG_RETURN_UNEXPECTED(inherit(ManifestEntry::kFileSequenceNumber.field_id(),
+                                    manifest.sequence_number, added_only));
+  return {};
+}
+
+/// \brief Returns the data files of the live entries of a batch of manifest entries.
+///
+/// The data file column is moved out of the batch when all entries are live, which is
+/// the common case, and the live rows are copied otherwise. The batch is released.
+Result<ArrowArray> LiveDataFiles(const StructType& entry_type, const ArrowSchema& schema,
+                                 ArrowArray batch) {
+  internal::ArrowArrayGuard batch_guard(&batch);
+  ArrowError error;
+  ArrowArrayView view;
+  ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(
+      ArrowArrayViewInitFromSchema(&view, &schema, &error), error);
+  internal::ArrowArrayViewGuard view_guard(&view);
+  ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(
+      ArrowArrayViewSetArray(&view, &batch, &error), error);
+  const ArrowArrayView* status_view =
+      view.children[FieldIndex(entry_type, ManifestEntry::kStatus.field_id())];
+
+  std::vector<uint8_t> selection((batch.length + 7) / 8, 0);
+  int64_t live = 0;
+  for (int64_t row = 0; row < batch.length; ++row) {
+    if (ArrowArrayViewGetIntUnsafe(status_view, row) !=
+        static_cast<int64_t>(ManifestStatus::kDeleted)) {
+      selection[row >> 3] |= static_cast<uint8_t>(1 << (row & 7));
+      ++live;
+    }
+  }
+
+  const int64_t index = FieldIndex(entry_type, ManifestEntry::kDataFileFieldId);
+  ArrowArray* entries = &batch;
+  ArrowArray filtered{};
+  internal::ArrowArrayGuard filtered_guard(&filtered);
+  if (live != batch.length || batch.offset != 0) {
+    ICEBERG_ASSIGN_OR_RAISE(filtered, FilterArrowArray(schema, batch, selection));
+    entries = &filtered;
+  }
+  // Moving a child out of its parent leaves a released child, which the parent skips
+  // when it is released.
+  ArrowArray data_files = *entries->children[index];
+  entries->children[index]->release = nullptr;
+  return data_files;
+}
+
+/// \brief Returns the manifests of a snapshot.
+Result<std::vector<ManifestFile>> SnapshotManifests(const Snapshot& snapshot,
+                                                    const std::shared_ptr<FileIO>& io) {
+  ICEBERG_ASSIGN_OR_RAISE(auto reader,
+                          ManifestListReader::Make(snapshot.manifest_list, io));
+  return reader->Files();
+}
+
+/// \brief Returns a source of the entries, or their live data files, of manifests.
+NextBatch ManifestEntryBatches(std::vector<ManifestFile> manifests,
+                               std::shared_ptr<FileIO> io,
+                               std::shared_ptr<StructType> partition_type,
+                               bool data_files) {
+  auto entry_type = ManifestEntry::TypeFromPartitionType(partition_type);
+  std::vector<AvroFileBatches::File> files;
+  files.reserve(manifests.size());
+  for (const auto& manifest : manifests) {
+    files.push_back({.path = manifest.manifest_path,
+                     .length = static_cast<size_t>(manifest.manifest_length)});
+  }
+  auto projection_type = ManifestEntry::TypeFromPartitionType(partition_type);
+  auto batches = std::make_shared<AvroFileBatches>(
+      std::move(files), std::move(io),
+      FromStructType(std::move(*projection_type), std::nullopt));
+  return [batches, entry_type, manifests = std::move(manifests),
+          data_files]() -> Result<std::optional<ArrowArray>> {
+    ICEBERG_ASSIGN_OR_RAISE(auto batch, batches->Next());
+    if (!batch.has_value()) {
+      return std::nullopt;
+    }
+    if (data_files) {
+      ICEBERG_ASSIGN_OR_RAISE(
+          auto live, LiveDataFiles(*entry_type, batches->schema(), batch.value()));
+      return live;
+    }
+    internal::ArrowArrayGuard batch_guard(&batch.value());
+    ICEBERG_RETURN_UNEXPECTED(InheritEntryColumns(*entry_type, batches->schema(),
+                                                  batch.value(),
+                                                  manifests[batches->file_index()]));
+    return std::exchange(batch.value(), ArrowArray{});
+  };
+}
+
+/// \brief Appends a string, or a null when unset.
+Status AppendString(ArrowArray* array, const std::optional<std::string_view>& value) {
+  if (!value.has_value()) {
+    ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayAppendNull(array, 1));
+    return {};
+  }
+  ArrowStringView view(value->data(), static_cast<int64_t>(value->size()));
+  ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayAppendString(array, view));
+  return {};
+}
+
+/// \brief Appends an integer, or a null when unset.
+Status AppendInt(ArrowArray* array, const std::optional<int64_t>& value) {
+  if (!value.has_value()) {
+    ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayAppendNull(array, 1));
+    return {};
+  }
+  ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayAppendInt(array, value.value()));
+  return {};
+}
+
+/// \brief Returns a timestamp in the microseconds of the timestamptz type.
+int64_t TimestampMicros(const TimePointMs& timestamp) {
+  return UnixMsFromTimePointMs(timestamp) * 1000;
+}
+
+/// \brief Builds a batch of a schema by appending each of its rows.
+Result<ArrowArray> BuildBatch(const Schema& schema,
+                              const std::function<Status(ArrowArray*)>& append_rows) {
+  ArrowSchema arrow_schema;
+  ICEBERG_RETURN_UNEXPECTED(ToArrowSchema(schema, &arrow_schema));
+  internal::ArrowSchemaGuard schema_guard(&arrow_schema);
+  ArrowError error;
+  ArrowArray array;
+  ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(
+      ArrowArrayInitFromSchema(&array, &arrow_schema, &error), error);
+  auto build = [&]() -> Status {
+    ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayStartAppending(&array));
+    ICEBERG_RETURN_UNEXPECTED(append_rows(&array));
+    ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(
+        ArrowArrayFinishBuildingDefault(&array, &error), error);
+    return {};
+  };
+  if (auto status = build(); !status.has_value()) {
+    ArrowArrayRelease(&array);
+    return std::unexpected(status.error());
+  }
+  return array;
+}
+
+Status AppendSnapshots(const TableMetadata& metadata, ArrowArray* array) {
+  ICEBERG_ASSIGN_OR_RAISE(auto snapshots, metadata.AllSnapshots());
+  for (const auto& snapshot : snapshots) {
+    ICEBERG_RETURN_UNEXPECTED(
+        AppendInt(array->children[0], TimestampMicros(snapshot->timestamp_ms)));
+    ICEBERG_RETURN_UNEXPECTED(AppendInt(array->children[1], snapshot->snapshot_id));
+    ICEBERG_RETURN_UNEXPECTED(
+        AppendInt(array->children[2], snapshot->parent_snapshot_id));
+    ICEBERG_RETURN_UNEXPECTED(AppendString(array->children[3], snapshot->operation()));
+    ICEBERG_RETURN_UNEXPECTED(AppendString(array->children[4], snapshot->manifest_list));
+    ArrowArray* summary = array->children[5];
+    ArrowArray* summary_entries = summary->children[0];
+    for (const auto& [key, value] : snapshot->summary) {
+      ICEBERG_RETURN_UNEXPECTED(AppendString(summary_entries->children[0], key));
+      ICEBERG_RETURN_UNEXPECTED(AppendString(summary_entries->children[1], value));
+      ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayFinishElement(summary_entries));
+    }
+    ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayFinishElement(summary));
+    ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayFinishElement(array));
+  }
+  return {};
+}
+
+Status AppendHistory(const TableMetadata& metadata, ArrowArray* array) {
+  // Snapshots that are ancestors of the current snapshot are still part of the table.
+  std::unordered_set<int64_t> current_ancestors;
+  for (auto snapshot_id = std::optional<int64_t>(metadata.current_snapshot_id);
+       snapshot_id.has_value() && *snapshot_id != Snapshot::kInvalidSnapshotId;) {
+    auto snapshot = metadata.SnapshotById(*snapshot_id);
+    if (!snapshot.has_value()) {
+      // The rest of the lineage has expired.
+      break;
+    }
+    current_ancestors.insert(*snapshot_id);
+    snapshot_id = snapshot.value()->parent_snapshot_id;
+  }
+
+  for (const auto& entry : metadata.snapshot_log) {
+    std::optional<int64_t> parent_snapshot_id;
+    if (auto snapshot = metadata.SnapshotById(entry.snapshot_id); snapshot.has_value()) {
+      parent_snapshot_id = snapshot.value()->parent_snapshot_id;
+    }
+    ICEBERG_RETURN_UNEXPECTED(
+        AppendInt(array->children[0], TimestampMicros(entry.timestamp_ms)));
+    ICEBERG_RETURN_UNEXPECTED(AppendInt(array->children[1], entry.snapshot_id));
+    ICEBERG_RETURN_UNEXPECTED(AppendInt(array->children[2], parent_snapshot_id));
+    ICEBERG_RETURN_UNEXPECTED(AppendInt(
+        array->children[3], current_ancestors.contains(entry.snapshot_id) ? 1 : 0));
+    ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayFinishElement(array));
+  }
+  return {};
+}
+
+std::shared_ptr<Schema> SnapshotsSchema() {
+  return std::make_shared<Schema>(std::vector<SchemaField>{
+      SchemaField::MakeRequired(1, "committed_at", timestamp_tz()),
+      SchemaField::MakeRequired(2, "snapshot_id", int64()),
+      SchemaField::MakeOptional(3, "parent_id", int64()),
+      SchemaField::MakeOptional(4, "operation", string()),
+      SchemaField::MakeOptional(5, "manifest_list", string()),
+      SchemaField::MakeOptional(
+          6, "summary",
+          map(SchemaField::MakeRequired(7, std::string(MapType::kKeyName), string()),
+              SchemaField::MakeRequired(8, std::string(MapType::kValueName),
+                                        string())))});
+}
+
+std::shared_ptr<Schema> HistorySchema() {
+  return std::make_shared<Schema>(std::vector<SchemaField>{
+      SchemaField::MakeRequired(1, "made_current_at", timestamp_tz()),
+      SchemaField::MakeRequired(2, "snapshot_id", int64()),
+      SchemaField::MakeOptional(3, "parent_id", int64()),
+      SchemaField::MakeRequired(4, "is_current_ancestor", boolean())});
+}
+
+std::shared_ptr<Schema> MetadataTableSchema(MetadataTableType type,
+                                            std::shared_ptr<StructType> partition_type) {
+  switch (type) {
+    case MetadataTableType::kEntries:
+      return FromStructType(
+          std::move(*ManifestEntry::TypeFromPartitionType(std::move(partition_type))),
+          std::nullopt);
+    case MetadataTableType::kFiles:
+    case MetadataTableType::kAllDataFiles:
+      return FromStructType(std::move(*DataFile::Type(std::move(partition_type))),
+                            std::nullopt);
+    case MetadataTableType::kManifests:
+      return FromStructType(ManifestFile::Type(), std::nullopt);
+    case MetadataTableType::kPartitions:
+      return PartitionStatsSchema(std::move(partition_type));
+    case MetadataTableType::kSnapshots:
+      return SnapshotsSchema();
+    case MetadataTableType::kHistory:
+      return HistorySchema();
+  }
+  std::unreachable();
+}
+
+}  // namespace
+
+std::string_view ToString(MetadataTableType type) {
+  switch (type) {
+    case MetadataTableType::kEntries:
+      return "entries";
+    case MetadataTableType::kFiles:
+      return "files";
+    case MetadataTableType::kAllDataFiles:
+      return "all_data_files";
+    case MetadataTableType::kManifests:
+      return "manifests";
+    case MetadataTableType::kPartitions:
+      return "partitions";
+    case MetadataTableType::kSnapshots:
+      return "snapshots";
+    case MetadataTableType::kHistory:
+      return "history";
+  }
+  std::unreachable();
+}
+
+Result<MetadataTableType> MetadataTableTypeFromString(std::string_view name) {
+  auto lower = StringUtils::ToLower(name);
+  for (auto type : {MetadataTableType::kEntries, MetadataTableType::kFiles,
+                    MetadataTableType::kAllDataFiles, MetadataTableType::kManifests,
+                    MetadataTableType::kPartitions, MetadataTableType::kSnapshots,
+                    MetadataTableType::kHistory}) {
+    if (lower == ToString(type)) {
+      return type;
+    }
+  }
+  return InvalidArgument("Invalid metadata table: {}", name);
+}
+
+MetadataTableScan::MetadataTableScan(MetadataTableType type,
+                                     std::shared_ptr<TableMetadata> metadata,
+                                     std::shared_ptr<FileIO> io,
+                                     std::shared_ptr<Snapshot> snapshot,
+                                     std::shared_ptr<StructType> partition_type,
+                                     std::shared_ptr<Schema> schema)
+    : type_(type),
+      metadata_(std::move(metadata)),
+      io_(std::move(io)),
+      snapshot_(std::move(snapshot)),
+      partition_type_(std::move(partition_type)),
+      schema_(std::move(schema)) {}
+
+MetadataTableScan::~MetadataTableScan() = default;
+
+Result<std::unique_ptr<MetadataTableScan>> MetadataTableScan::Make(
+    MetadataTableType type, std::shared_ptr<TableMetadata> metadata,
+    std::shared_ptr<FileIO> io, std::optional<int64_t> snapshot_id) {
+  if (metadata == nullptr) {
+    return InvalidArgument("Cannot scan a metadata table without table metadata");
+  }
+  if (!snapshot_id.has_value() &&
+      metadata->current_snapshot_id != Snapshot::kInvalidSnapshotId) {
+    snapshot_id = metadata->current_snapshot_id;
+  }
+  std::shared_ptr<Snapshot> snapshot;
+  if (snapshot_id.has_value()) {
+    ICEBERG_ASSIGN_OR_RAISE(snapshot, metadata->SnapshotById(*snapshot_id));
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto partition_type, UnifiedPartitionType(*metadata));
+  auto schema = MetadataTableSchema(type, partition_type);
+  return std::unique_ptr<MetadataTableScan>(
+      new MetadataTableScan(type, std::move(metadata), std::move(io), std::move(snapshot),
+                            std::move(partition_type), std::move(schema)));
+}
+
+Result<ArrowArrayStream> MetadataTableScan::ToArrow() const {
+  auto no_batches = []() -> Result<std::optional<ArrowArray>> { return std::nullopt; };
+  switch (type_) {
+    case MetadataTableType::kEntries:
+    case MetadataTableType::kFiles: {
+      if (snapshot_ == nullptr) {
+        return MakeStream(schema_, no_batches);
+      }
+      ICEBERG_ASSIGN_OR_RAISE(auto manifests, SnapshotManifests(*snapshot_, io_));
+      return MakeStream(schema_, ManifestEntryBatches(
+                                     std::move(manifests), io_, partition_type_,
+                                     /*data_files=*/type_ == MetadataTableType::kFiles));
+    }
+    case MetadataTableType::kAllDataFiles: {
+      // Manifests are shared by the snapshots that did not rewrite them.
+      ICEBERG_ASSIGN_OR_RAISE(auto snapshots, metadata_->AllSnapshots());
+      std::unordered_set<std::string> manifest_paths;
+      std::vector<ManifestFile> manifests;
+      for (const auto& snapshot : snapshots) {
+        ICEBERG_ASSIGN_OR_RAISE(auto snapshot_manifests,
+                                SnapshotManifests(*snapshot, io_));
+        for (auto& manifest : snapshot_manifests) {
+          if (manifest.content == ManifestFile::Content::kData &&
+              manifest_paths.insert(manifest.manifest_path).second) {
+            manifests.push_back(std::move(manifest));
+          }
+        }
+      }
+      return MakeStream(schema_, ManifestEntryBatches(std::move(manifests), io_,
+                                                      partition_type_,
+                                                      /*data_files=*/true));
+    }
+    case MetadataTableType::kManifests: {
+      if (snapshot_ == nullptr) {
+        return MakeStream(schema_, no_batches);
+      }
+      auto batches = std::make_shared<AvroFileBatches>(
+          std::vector<AvroFileBatches::File>{{.path = snapshot_->manifest_list}}, io_,
+          schema_);
+      return MakeStream(schema_, [batches]() { return batches->Next(); });
+    }
+    case MetadataTableType::kPartitions: {
+      if (snapshot_ == nullptr) {
+        return MakeStream(schema_, no_batches);
+      }
+      return MakeStream(
+          schema_, SingleBatch([metadata = metadata_, io = io_, schema = schema_,
+                                snapshot_id = snapshot_->snapshot_id]() mutable
+                                   -> Result<ArrowArray> {
+            ICEBERG_ASSIGN_OR_RAISE(auto collector,
+                                    ComputePartitionStats(*metadata, snapshot_id, io));
+            ArrowSchema arrow_schema;
+            ICEBERG_RETURN_UNEXPECTED(ToArrowSchema(*schema, &arrow_schema));
+            internal::ArrowSchemaGuard schema_guard(&arrow_schema);
+            return PartitionStatsToArrow(arrow_schema, collector.partition_type(),
+                                         collector.stats());
+          }));
+    }
+    case MetadataTableType::kSnapshots:
+      return MakeStream(schema_, SingleBatch([metadata = metadata_, schema = schema_]() {
+                          return BuildBatch(*schema, [&](ArrowArray* array) {
+                            return AppendSnapshots(*metadata, array);
+                          });
+                        }));
+    case MetadataTableType::kHistory:
+      return MakeStream(schema_, SingleBatch([metadata = metadata_, schema = schema_]() {
+                          return BuildBatch(*schema, [&](ArrowArray* array) {
+                            return AppendHistory(*metadata, array);
+                          });
+                        }));
+  }
+  std::unreachable();
+}
+
+}  // namespace iceberg
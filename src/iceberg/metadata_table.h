@@ -0,0 +1,114 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/metadata_table.h
+/// Scans of the metadata tables of a table, returned as Arrow streams.
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+#include "iceberg/arrow_c_data.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief The metadata tables of a table.
+enum class MetadataTableType {
+  /// \brief The entries of the manifests of a snapshot, including the deleted ones,
+  /// with their inherited snapshot ids and sequence numbers.
+  kEntries,
+  /// \brief The live data and delete files of a snapshot.
+  kFiles,
+  /// \brief The live data files of the manifests of all snapshots.
+  kAllDataFiles,
+  /// \brief The manifests of a snapshot, as stored in its manifest list.
+  kManifests,
+  /// \brief The file and record counts of the partitions of a snapshot.
+  kPartitions,
+  /// \brief The snapshots of the table.
+  kSnapshots,
+  /// \brief The snapshots that were the current snapshot of the table, in order.
+  kHistory,
+};
+
+/// \brief Returns the name of a metadata table, e.g. "all_data_files".
+ICEBERG_EXPORT std::string_view ToString(MetadataTableType type);
+
+/// \brief Returns the metadata table with the given name.
+ICEBERG_EXPORT Result<MetadataTableType> MetadataTableTypeFromString(
+    std::string_view name);
+
+/// \brief A scan of a metadata table.
+///
+/// The rows of the tables read from manifests and manifest lists are returned in the
+/// Arrow batches decoded from those files, which are passed through as they are read:
+/// the entries, files and all_data_files tables only replace the columns that need
+/// inherited values or drop deleted entries, and the manifests table returns the
+/// manifest list as is. The partition tuples of the tables read from manifests have the
+/// unified partition type of the table, with null values for the fields of the other
+/// partition specs.
+class ICEBERG_EXPORT MetadataTableScan {
+ public:
+  ~MetadataTableScan();
+
+  /// \brief Creates a scan of a metadata table.
+  ///
+  /// \param type The metadata table to scan
+  /// \param metadata The metadata of the table
+  /// \param io The FileIO to read the manifests and manifest lists
+  /// \param snapshot_id The snapshot to read the snapshot tables of, the current
+  /// snapshot when unset
+  static Result<std::unique_ptr<MetadataTableScan>> Make(
+      MetadataTableType type, std::shared_ptr<TableMetadata> metadata,
+      std::shared_ptr<FileIO> io, std::optional<int64_t> snapshot_id = std::nullopt);
+
+  /// \brief The metadata table of the scan.
+  MetadataTableType type() const { return type_; }
+
+  /// \brief The schema of the rows of the metadata table.
+  const std::shared_ptr<Schema>& schema() const { return schema_; }
+
+  /// \brief Returns a C-ABI compatible ArrowArrayStream of the rows of the table.
+  ///
+  /// Manifests are read as the batches are requested. The tables of a snapshot are
+  /// empty when the table has no snapshot.
+  Result<ArrowArrayStream> ToArrow() const;
+
+ private:
+  MetadataTableScan(MetadataTableType type, std::shared_ptr<TableMetadata> metadata,
+                    std::shared_ptr<FileIO> io, std::shared_ptr<Snapshot> snapshot,
+                    std::shared_ptr<StructType> partition_type,
+                    std::shared_ptr<Schema> schema);
+
+  MetadataTableType type_;
+  std::shared_ptr<TableMetadata> metadata_;
+  std::shared_ptr<FileIO> io_;
+  // The snapshot of the snapshot tables, or null if the table has no snapshot.
+  std::shared_ptr<Snapshot> snapshot_;
+  std::shared_ptr<StructType> partition_type_;
+  std::shared_ptr<Schema> schema_;
+};
+
+}  // namespace iceberg
@@ -0,0 +1,152 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/metrics_config.h"
+
+#include <charconv>
+#include <format>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "iceberg/schema.h"
+#include "iceberg/table_properties.h"
+#include "iceberg/util/macros.h"
+#include "iceberg/util/string_util.h"
+
+namespace iceberg {
+
+namespace {
+
+constexpr int32_t kDefaultTruncateLength = 16;
+
+/// \brief Collects the field ids of the first `limit` primitive columns, in schema
+/// order.
+void CollectPrimitiveIds(const Type& type, size_t limit, std::vector<int32_t>* ids) {
+  const auto& nested = static_cast<const NestedType&>(type);
+  for (const auto& field : nested.fields()) {
+    if (ids->size() >= limit) {
+      return;
+    }
+    if (field.type()->is_primitive()) {
+      ids->push_back(field.field_id());
+    } else if (field.type()->is_nested()) {
+      CollectPrimitiveIds(*field.type(), limit, ids);
+    }
+  }
+}
+
+}  // namespace
+
+Result<MetricsMode> MetricsMode::FromString(std::string_view mode) {
+  const std::string lower = StringUtils::ToLower(mode);
+  if (lower == "none") {
+    return None();
+  } else if (lower == "counts") {
+    return Counts();
+  } else if (lower == "full") {
+    return Full();
+  }
+
+  constexpr std::string_view kTruncatePrefix = "truncate(";
+  if (lower.starts_with(kTruncatePrefix) && lower.ends_with(')')) {
+    const std::string_view digits = std::string_view(lower).substr(
+        kTruncatePrefix.size(), lower.size() - kTruncatePrefix.size() - 1);
+    int32_t length = 0;
+    auto [end, ec] =
+        std::from_chars(digits.data(), digits.data() + digits.size(), length);
+    if (ec == std::errc() && end == digits.data() + digits.size() && length > 0) {
+      return Truncate(length);
+    }
+  }
+  return InvalidArgument("Invalid metrics mode: {}", mode);
+}
+
+std::string MetricsMode::ToString() const {
+  switch (kind) {
+    case Kind::kNone:
+      return "none";
+    case Kind::kCounts:
+      return "counts";
+    case Kind::kTruncate:
+      return std::format("truncate({})", length);
+    case Kind::kFull:
+      return "full";
+  }
+  std::unreachable();
+}
+
+MetricsConfig MetricsConfig::Default() {
+  return MetricsConfig(MetricsMode::Truncate(kDefaultTruncateLength));
+}
+
+Result<MetricsConfig> MetricsConfig::Make(
+    const std::unordered_map<std::string, std::string>& properties,
+    const Schema& schema) {
+  MetricsConfig config = Default();
+
+  if (auto it = properties.find(TableProperties::kDefaultWriteMetricsMode.key());
+      it != properties.cend()) {
+    ICEBERG_ASSIGN_OR_RAISE(config.default_mode_, MetricsMode::FromString(it->second));
+  } else {
+    int32_t max_inferred = TableProperties::kMetricsMaxInferredColumnDefaults.value();
+    if (auto max_it =
+            properties.find(TableProperties::kMetricsMaxInferredColumnDefaults.key());
+        max_it != properties.cend()) {
+      const std::string& value = max_it->second;
+      auto [end, ec] =
+          std::from_chars(value.data(), value.data() + value.size(), max_inferred);
+      if (ec != std::errc() || end != value.data() + value.size() || max_inferred < 0) {
+        return InvalidArgument("Invalid {}: {}",
+                               TableProperties::kMetricsMaxInferredColumnDefaults.key(),
+                               value);
+      }
+    }
+    if (schema.fields().size() > static_cast<size_t>(max_inferred)) {
+      std::vector<int32_t> ids;
+      CollectPrimitiveIds(schema, static_cast<size_t>(max_inferred), &ids);
+      for (int32_t id : ids) {
+        config.column_modes_.emplace(id, config.default_mode_);
+      }
+      config.default_mode_ = MetricsMode::None();
+    }
+  }
+
+  const auto prefix = TableProperties::kMetricsModeColumnConfPrefix;
+  for (const auto& [key, value] : properties) {
+    if (!key.starts_with(prefix)) {
+      continue;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto mode, MetricsMode::FromString(value));
+    ICEBERG_ASSIGN_OR_RAISE(auto field,
+                            schema.FindFieldByName(std::string_view(key).substr(
+                                prefix.size())));
+    if (field.has_value()) {
+      config.column_modes_.insert_or_assign(field->get().field_id(), mode);
+    }
+  }
+  return config;
+}
+
+MetricsMode MetricsConfig::ColumnMode(int32_t field_id) const {
+  auto it = column_modes_.find(field_id);
+  return it != column_modes_.cend() ? it->second : default_mode_;
+}
+
+}  // namespace iceberg
@@ -0,0 +1,101 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/metrics_config.h
+/// Configuration of the column metrics collected by file writers.
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief The metrics collected for a column.
+struct ICEBERG_EXPORT MetricsMode {
+  enum class Kind : uint8_t {
+    /// No metrics.
+    kNone,
+    /// Value counts, null value counts and NaN value counts.
+    kCounts,
+    /// Counts, and lower and upper bounds truncated to `length`.
+    kTruncate,
+    /// Counts, and lower and upper bounds.
+    kFull,
+  };
+
+  Kind kind = Kind::kFull;
+  /// \brief The length that string and binary bounds are truncated to, for kTruncate.
+  int32_t length = 0;
+
+  static MetricsMode None() { return {.kind = Kind::kNone}; }
+  static MetricsMode Counts() { return {.kind = Kind::kCounts}; }
+  static MetricsMode Truncate(int32_t length) {
+    return {.kind = Kind::kTruncate, .length = length};
+  }
+  static MetricsMode Full() { return {.kind = Kind::kFull}; }
+
+  /// \brief Parses a mode of `write.metadata.metrics.*`: none, counts, truncate(N) or
+  /// full, ignoring case.
+  static Result<MetricsMode> FromString(std::string_view mode);
+
+  std::string ToString() const;
+
+  bool operator==(const MetricsMode&) const = default;
+};
+
+/// \brief The metrics modes of the columns of a table.
+class ICEBERG_EXPORT MetricsConfig {
+ public:
+  /// \brief Returns the configuration that collects the default mode, truncate(16),
+  /// for all columns.
+  static MetricsConfig Default();
+
+  /// \brief Makes the configuration of the `write.metadata.metrics.default` and
+  /// `write.metadata.metrics.column.<name>` properties.
+  ///
+  /// Without a default mode, the columns of schemas with more top-level columns than
+  /// `write.metadata.metrics.max-inferred-column-defaults` default to none, except the
+  /// first primitive columns up to that number. Columns that are not in the schema are
+  /// ignored.
+  ///
+  /// \param properties The table properties
+  /// \param schema The schema of the written files
+  /// \return A Result containing the configuration, or an error if a mode is invalid.
+  static Result<MetricsConfig> Make(
+      const std::unordered_map<std::string, std::string>& properties,
+      const Schema& schema);
+
+  /// \brief Returns the metrics mode of a column.
+  MetricsMode ColumnMode(int32_t field_id) const;
+
+ private:
+  explicit MetricsConfig(MetricsMode default_mode) : default_mode_(default_mode) {}
+
+  MetricsMode default_mode_;
+  std::unordered_map<int32_t, MetricsMode> column_modes_;
+};
+
+}  // namespace iceberg
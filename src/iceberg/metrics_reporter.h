@@ -0,0 +1,255 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/metrics_reporter.h
+/// Metrics of scan planning, file reads and snapshot commits, and the interface to
+/// report them.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/table_identifier.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief A counter that can be incremented concurrently.
+///
+/// Copying a counter copies its current value.
+class ICEBERG_EXPORT Counter {
+ public:
+  Counter() = default;
+  Counter(const Counter& other) : value_(other.value()) {}
+  Counter& operator=(const Counter& other) {
+    value_.store(other.value(), std::memory_order_relaxed);
+    return *this;
+  }
+
+  /// \brief Adds `amount` to the counter.
+  void Increment(int64_t amount = 1) {
+    value_.fetch_add(amount, std::memory_order_relaxed);
+  }
+
+  /// \brief The current value of the counter.
+  int64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<int64_t> value_{0};
+};
+
+/// \brief A timer accumulating the durations of timed operations, which can be
+/// recorded concurrently.
+///
+/// Copying a timer copies its current totals.
+class ICEBERG_EXPORT Timer {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /// \brief Records the time from its construction to its destruction in a timer.
+  class ICEBERG_EXPORT Timed {
+   public:
+    explicit Timed(Timer& timer) : timer_(timer), start_(Clock::now()) {}
+    ~Timed() { timer_.Record(Clock::now() - start_); }
+
+    Timed(const Timed&) = delete;
+    Timed& operator=(const Timed&) = delete;
+
+   private:
+    Timer& timer_;
+    Clock::time_point start_;
+  };
+
+  Timer() = default;
+  Timer(const Timer& other)
+      : total_nanos_(other.total_duration().count()), count_(other.count()) {}
+  Timer& operator=(const Timer& other) {
+    total_nanos_.store(other.total_duration().count(), std::memory_order_relaxed);
+    count_.store(other.count(), std::memory_order_relaxed);
+    return *this;
+  }
+
+  /// \brief Starts timing an operation, which ends when the result is destroyed.
+  Timed Start() { return Timed(*this); }
+
+  /// \brief Records the duration of an operation.
+  void Record(std::chrono::nanoseconds duration) {
+    total_nanos_.fetch_add(duration.count(), std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// \brief The sum of the recorded durations.
+  std::chrono::nanoseconds total_duration() const {
+    return std::chrono::nanoseconds(total_nanos_.load(std::memory_order_relaxed));
+  }
+
+  /// \brief The number of recorded durations.
+  int64_t count() const { return count_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<int64_t> total_nanos_{0};
+  std::atomic<int64_t> count_{0};
+};
+
+/// \brief Metrics of the planning of a table scan.
+///
+/// Manifests are skipped by their partition summaries, data files by their partition
+/// and column metrics, and delete files by their partition.
+struct ICEBERG_EXPORT ScanMetrics {
+  /// \brief Time spent planning, including the callbacks receiving the tasks.
+  Timer total_planning_duration;
+  /// \brief Number of data files returned in scan tasks.
+  Counter result_data_files;
+  /// \brief Number of delete files referenced by the returned scan tasks, counting a
+  /// delete file once per task.
+  Counter result_delete_files;
+  /// \brief Number of data manifests of the snapshot.
+  Counter total_data_manifests;
+  /// \brief Number of delete manifests of the snapshot.
+  Counter total_delete_manifests;
+  /// \brief Number of data manifests that were read.
+  Counter scanned_data_manifests;
+  /// \brief Number of delete manifests that were read.
+  Counter scanned_delete_manifests;
+  /// \brief Number of data manifests skipped without reading them.
+  Counter skipped_data_manifests;
+  /// \brief Number of delete manifests skipped without reading them.
+  Counter skipped_delete_manifests;
+  /// \brief Number of live data files of the read manifests that were skipped.
+  Counter skipped_data_files;
+  /// \brief Number of live delete files of the read manifests that were skipped.
+  Counter skipped_delete_files;
+  /// \brief Number of delete files indexed to be matched with data files.
+  Counter indexed_delete_files;
+  /// \brief Total size in bytes of the returned data files.
+  Counter total_file_size_in_bytes;
+  /// \brief Total size in bytes of the delete files of the returned scan tasks.
+  Counter total_delete_file_size_in_bytes;
+};
+
+/// \brief Report of a planned table scan.
+struct ICEBERG_EXPORT ScanReport {
+  /// \brief The scanned table, empty if unknown.
+  TableIdentifier table;
+  /// \brief ID of the scanned snapshot.
+  int64_t snapshot_id;
+  /// \brief ID of the schema of the scanned snapshot.
+  std::optional<int32_t> schema_id;
+  /// \brief The scan filter, or null if the scan has no filter.
+  std::shared_ptr<Expression> filter;
+  /// \brief IDs of the top-level fields of the projected schema.
+  std::vector<int32_t> projected_field_ids;
+  ScanMetrics metrics;
+};
+
+/// \brief Metrics of reading the rows of a data file.
+///
+/// Collected by a Reader given them in its ReaderOptions and by the stream returned by
+/// FileScanTask::ToArrow(). The counters may be read while the file is read, and keep
+/// their values after the reader or stream is released.
+struct ICEBERG_EXPORT ReadMetrics {
+  /// \brief Number of batches returned by the stream.
+  Counter batches;
+  /// \brief Number of rows returned by the reader, before rows are filtered.
+  Counter rows_read;
+  /// \brief Number of rows removed because they do not match the row filter.
+  Counter rows_filtered;
+  /// \brief Number of rows removed by equality delete files.
+  Counter rows_deleted;
+  /// \brief Number of rows returned by the stream.
+  Counter rows_returned;
+  /// \brief Time spent in the reader reading and decoding batches.
+  Timer decode_duration;
+  /// \brief Time spent waiting for batches read ahead on a background thread.
+  Timer wait_duration;
+  /// \brief Number of bytes read from the file.
+  Counter bytes_read;
+  /// \brief Time spent in reads of the file. Reads issued ahead by the reader run
+  /// concurrently with decoding, so this may exceed the decode time.
+  Timer io_duration;
+  /// \brief Number of row groups of the split skipped because none of their rows can
+  /// match the filter or all of them are deleted by position deletes.
+  Counter row_groups_skipped;
+  /// \brief Number of rows of the read row groups that were decoded and dropped by the
+  /// reader, because their pages cannot match the filter or they are deleted by
+  /// position deletes.
+  Counter rows_skipped;
+};
+
+/// \brief Metrics of a snapshot commit.
+///
+/// Added and removed counts are taken from the summary of the committed snapshot and
+/// are 0 when it does not track them.
+struct ICEBERG_EXPORT CommitMetrics {
+  /// \brief Time spent committing, including the retries and their backoff.
+  Timer total_duration;
+  /// \brief Number of commit attempts, 1 if the first attempt succeeded.
+  Counter attempts;
+  Counter added_data_files;
+  Counter removed_data_files;
+  Counter total_data_files;
+  Counter added_delete_files;
+  Counter removed_delete_files;
+  Counter total_delete_files;
+  Counter added_records;
+  Counter removed_records;
+  Counter total_records;
+  Counter added_files_size_in_bytes;
+  Counter removed_files_size_in_bytes;
+  Counter total_files_size_in_bytes;
+};
+
+/// \brief Report of a committed snapshot.
+struct ICEBERG_EXPORT CommitReport {
+  /// \brief The table the snapshot was committed to.
+  TableIdentifier table;
+  /// \brief ID of the committed snapshot.
+  int64_t snapshot_id;
+  /// \brief Sequence number of the committed snapshot.
+  int64_t sequence_number;
+  /// \brief The data operation of the committed snapshot, see DataOperation.
+  std::string operation;
+  CommitMetrics metrics;
+};
+
+/// \brief A report passed to a MetricsReporter.
+using MetricsReport = std::variant<ScanReport, CommitReport>;
+
+/// \brief Receives the reports of scans and commits.
+///
+/// Scans report when planning completes and commits when the snapshot is committed,
+/// on the thread that planned or committed. A reporter shared by several tables or
+/// scans must be thread-safe.
+class ICEBERG_EXPORT MetricsReporter {
+ public:
+  virtual ~MetricsReporter() = default;
+
+  /// \brief Receives a report.
+  virtual void Report(const MetricsReport& report) = 0;
+};
+
+}  // namespace iceberg
@@ -0,0 +1,370 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/orc/orc_reader.h"
+
+#include <arrow/adapters/orc/adapter.h>
+#include <arrow/c/bridge.h>
+#include <arrow/memory_pool.h>
+#include <arrow/record_batch.h>
+#include <arrow/result.h>
+#include <arrow/table.h>
+#include <arrow/type.h>
+#include <arrow/util/byte_size.h>
+#include <arrow/util/key_value_metadata.h>
+
+#include "iceberg/arrow/arrow_fs_file_io_internal.h"
+#include "iceberg/arrow/arrow_memory_pool_internal.h"
+#include "iceberg/arrow/arrow_metadata_columns_internal.h"
+#include "iceberg/arrow/arrow_status_internal.h"
+#include "iceberg/deletes/position_delete_index.h"
+#include "iceberg/metrics_reporter.h"
+#include "iceberg/orc/orc_register.h"
+#include "iceberg/orc/orc_schema_util_internal.h"
+#include "iceberg/parquet/parquet_data_util_internal.h"
+#include "iceberg/result.h"
+#include "iceberg/util/batch_sizer_internal.h"
+#include "iceberg/util/macros.h"
+#include "iceberg/util/tracing.h"
+
+namespace iceberg::orc {
+
+namespace {
+
+Result<std::shared_ptr<::arrow::io::RandomAccessFile>> OpenInputStream(
+    const ReaderOptions& options) {
+  return arrow::OpenArrowInputFile(options.io, options.path, options.length,
+                                   options.metrics);
+}
+
+}  // namespace
+
+class OrcReader::Impl {
+ public:
+  // Open the ORC reader with the given options
+  Status Open(const ReaderOptions& options) {
+    if (options.projection == nullptr) {
+      return InvalidArgument("Projected schema is required by ORC reader");
+    }
+
+    split_ = options.split;
+    read_schema_ = options.projection;
+    file_path_ = options.path;
+    metadata_columns_ = options.metadata_columns;
+    has_metadata_columns_ = arrow::HasMetadataColumns(*read_schema_);
+    pool_ = arrow::ToArrowMemoryPool(options.memory_pool);
+    batch_size_ = options.batch_size;
+    metrics_ = options.metrics;
+    if (options.position_deletes != nullptr && !options.position_deletes->IsEmpty()) {
+      position_deletes_ = options.position_deletes;
+    }
+
+    // Open the ORC file reader, which reads the file tail
+    ICEBERG_ASSIGN_OR_RAISE(input_stream_, OpenInputStream(options));
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(
+        reader_, ::arrow::adapters::orc::ORCFileReader::Open(input_stream_, pool_));
+
+    // Project read schema onto the ORC file schema
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(auto file_schema, reader_->ReadSchema());
+    ICEBERG_ASSIGN_OR_RAISE(
+        projection_.projection,
+        ProjectWithConstants(*read_schema_, options.constants, options.default_values,
+                             [&](const ::iceberg::Schema& schema)
+                                 -> Result<SchemaProjection> {
+                               ICEBERG_ASSIGN_OR_RAISE(auto projection,
+                                                       Project(schema, *file_schema));
+                               projection_.column_names =
+                                   std::move(projection.column_names);
+                               return std::move(projection.projection);
+                             }));
+    if (options.target_batch_bytes.has_value()) {
+      ICEBERG_ASSIGN_OR_RAISE(
+          batch_sizer_, BatchSizer::Make(options.target_batch_bytes.value(),
+                                         BatchSizer::EstimateRowWidth(*read_schema_)));
+      batch_size_ = batch_sizer_->batch_size();
+    }
+
+    return {};
+  }
+
+  // Read the next batch of data
+  Result<std::optional<ArrowArray>> Next() {
+    if (output_arrow_schema_ == nullptr) {
+      ICEBERG_RETURN_UNEXPECTED(InitReadContext());
+    }
+
+    std::shared_ptr<::arrow::RecordBatch> batch;
+    // The positions in the file of the rows of the batch.
+    std::vector<std::pair<int64_t, int64_t>> positions;
+    while (batch == nullptr) {
+      if (stripe_reader_ == nullptr) {
+        if (next_stripe_ == stripes_.size()) {
+          return std::nullopt;
+        }
+        ICEBERG_RETURN_UNEXPECTED(OpenStripe(stripes_[next_stripe_++]));
+      }
+      ICEBERG_ARROW_ASSIGN_OR_RETURN(batch, stripe_reader_->Next());
+      if (batch == nullptr) {
+        stripe_reader_.reset();
+        continue;
+      }
+      if (batch_sizer_.has_value()) {
+        // The batch size of a stripe is fixed when it is opened, so the next stripes
+        // are read with the adapted size.
+        batch_sizer_->Observe(batch->num_rows(), ::arrow::util::TotalBufferSize(*batch));
+        batch_size_ = batch_sizer_->batch_size();
+      }
+      const int64_t first_row = next_row_;
+      next_row_ += batch->num_rows();
+      positions.clear();
+      if (position_deletes_ != nullptr) {
+        ICEBERG_ASSIGN_OR_RAISE(
+            batch, RemoveDeletedRows(std::move(batch), first_row, positions));
+      } else {
+        positions.emplace_back(first_row, next_row_);
+      }
+    }
+
+    if (parquet::RequiresProjection(*batch->schema(), *output_arrow_schema_,
+                                    projection_.projection)) {
+      ICEBERG_ASSIGN_OR_RAISE(
+          batch, parquet::ProjectRecordBatch(std::move(batch), output_arrow_schema_,
+                                             *read_schema_, projection_.projection,
+                                             pool_));
+    }
+    if (has_metadata_columns_) {
+      ICEBERG_ASSIGN_OR_RAISE(
+          batch, arrow::SetMetadataColumns(batch, *read_schema_, file_path_,
+                                           metadata_columns_, positions, pool_));
+    }
+
+    ArrowArray arrow_array;
+    ICEBERG_ARROW_RETURN_NOT_OK(::arrow::ExportRecordBatch(*batch, &arrow_array));
+    return arrow_array;
+  }
+
+  // Close the reader and release resources
+  Status Close() {
+    if (reader_ == nullptr) {
+      return {};  // Already closed
+    }
+
+    if (stripe_reader_ != nullptr) {
+      ICEBERG_ARROW_RETURN_NOT_OK(stripe_reader_->Close());
+      stripe_reader_.reset();
+    }
+
+    reader_.reset();
+    ICEBERG_ARROW_RETURN_NOT_OK(input_stream_->Close());
+    return {};
+  }
+
+  // Get the schema of the data
+  Result<ArrowSchema> Schema() {
+    if (output_arrow_schema_ == nullptr) {
+      ICEBERG_RETURN_UNEXPECTED(InitReadContext());
+    }
+
+    ArrowSchema arrow_schema;
+    ICEBERG_ARROW_RETURN_NOT_OK(
+        ::arrow::ExportSchema(*output_arrow_schema_, &arrow_schema));
+    return arrow_schema;
+  }
+
+  Result<std::unordered_map<std::string, std::string>> Metadata() {
+    if (reader_ == nullptr) {
+      return Invalid("Reader is not opened");
+    }
+
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(auto kv_metadata, reader_->ReadMetadata());
+    if (!kv_metadata) {
+      return std::unordered_map<std::string, std::string>{};
+    }
+
+    std::unordered_map<std::string, std::string> metadata_map;
+    kv_metadata->ToUnorderedMap(&metadata_map);
+    return metadata_map;
+  }
+
+ private:
+  Status InitReadContext() {
+    // Build the output Arrow schema
+    ICEBERG_ASSIGN_OR_RAISE(output_arrow_schema_,
+                            arrow::MakeReadArrowSchema(*read_schema_));
+
+    // Stripe pruning based on the split. Splits are planned at the stripe offsets
+    // recorded in the split offsets of the data file, so a split reads whole stripes.
+    int64_t num_split_stripes = 0;
+    const int64_t num_stripes = reader_->NumberOfStripes();
+    for (int64_t i = 0; i < num_stripes; ++i) {
+      auto stripe = reader_->GetStripeInformation(i);
+      if (split_.has_value()) {
+        const auto offset = static_cast<size_t>(stripe.offset);
+        if (offset >= split_->offset + split_->length) {
+          break;
+        }
+        if (offset < split_->offset) {
+          continue;
+        }
+      }
+      ++num_split_stripes;
+      // Skip the stripes whose rows are all deleted
+      if (position_deletes_ != nullptr && AllRowsDeleted(stripe)) {
+        continue;
+      }
+      stripes_.push_back(stripe);
+    }
+    if (metrics_ != nullptr) {
+      metrics_->row_groups_skipped.Increment(num_split_stripes -
+                                             static_cast<int64_t>(stripes_.size()));
+    }
+
+    return {};
+  }
+
+  bool AllRowsDeleted(const ::arrow::adapters::orc::StripeInformation& stripe) const {
+    int64_t deleted = 0;
+    position_deletes_->ForEach(stripe.first_row_id, stripe.first_row_id + stripe.num_rows,
+                               [&](int64_t) { ++deleted; });
+    return deleted == stripe.num_rows;
+  }
+
+  // Position the reader at the first row of a stripe and read its projected columns.
+  Status OpenStripe(const ::arrow::adapters::orc::StripeInformation& stripe) {
+    ICEBERG_ARROW_RETURN_NOT_OK(reader_->Seek(stripe.first_row_id));
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(
+        stripe_reader_, reader_->NextStripeReader(batch_size_, projection_.column_names));
+    if (stripe_reader_ == nullptr) {
+      return IOError("Failed to read stripe at offset {}", stripe.offset);
+    }
+    next_row_ = stripe.first_row_id;
+    return {};
+  }
+
+  // Drop the deleted rows of a record batch, and append the ranges of positions of the
+  // rows kept to `positions`. Returns nullptr if all of its rows are deleted.
+  Result<std::shared_ptr<::arrow::RecordBatch>> RemoveDeletedRows(
+      std::shared_ptr<::arrow::RecordBatch> batch, int64_t first_row,
+      std::vector<std::pair<int64_t, int64_t>>& positions) {
+    const int64_t num_rows = batch->num_rows();
+    std::vector<std::shared_ptr<::arrow::RecordBatch>> slices;
+    int64_t live_begin = 0;
+    int64_t deleted = 0;
+    position_deletes_->ForEach(first_row, first_row + num_rows, [&](int64_t position) {
+      const int64_t row = position - first_row;
+      if (row > live_begin) {
+        slices.push_back(batch->Slice(live_begin, row - live_begin));
+        positions.emplace_back(first_row + live_begin, position);
+      }
+      live_begin = row + 1;
+      ++deleted;
+    });
+    if (live_begin < num_rows) {
+      positions.emplace_back(first_row + live_begin, first_row + num_rows);
+    }
+    if (deleted == 0) {
+      return batch;
+    }
+    if (live_begin < num_rows) {
+      slices.push_back(batch->Slice(live_begin, num_rows - live_begin));
+    }
+    if (metrics_ != nullptr) {
+      metrics_->rows_skipped.Increment(deleted);
+    }
+
+    if (slices.empty()) {
+      return nullptr;
+    }
+    if (slices.size() == 1) {
+      return slices.front();
+    }
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(
+        auto table, ::arrow::Table::FromRecordBatches(batch->schema(), slices));
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(auto combined, table->CombineChunksToBatch(pool_));
+    return combined;
+  }
+
+ private:
+  ::arrow::MemoryPool* pool_ = ::arrow::default_memory_pool();
+  // The split to read from the ORC file.
+  std::optional<Split> split_;
+  // Schema to read from the ORC file.
+  std::shared_ptr<::iceberg::Schema> read_schema_;
+  // The path of the file, and the values of the metadata columns not stored in it.
+  std::string file_path_;
+  MetadataColumnValues metadata_columns_;
+  // Whether the read schema has metadata columns to generate.
+  bool has_metadata_columns_ = false;
+  // The number of rows of the record batches to read.
+  int64_t batch_size_ = ReaderOptions::kDefaultBatchSize;
+  // Adapts `batch_size_` to the size of the batches read, if a target size is set.
+  std::optional<BatchSizer> batch_sizer_;
+  // The positions of the deleted rows to skip, if any.
+  std::shared_ptr<const PositionDeleteIndex> position_deletes_;
+  // Receives the metrics of the reader, if any.
+  std::shared_ptr<ReadMetrics> metrics_;
+  // The columns to read and the projection of the read schema onto them.
+  OrcProjection projection_;
+  // The arrow schema to output record batches.
+  std::shared_ptr<::arrow::Schema> output_arrow_schema_;
+  // The input stream to read ORC file.
+  std::shared_ptr<::arrow::io::RandomAccessFile> input_stream_;
+  // ORC file reader to read the stripes.
+  std::unique_ptr<::arrow::adapters::orc::ORCFileReader> reader_;
+  // The stripes to read, in file order.
+  std::vector<::arrow::adapters::orc::StripeInformation> stripes_;
+  // The index in `stripes_` of the next stripe to read.
+  size_t next_stripe_ = 0;
+  // The reader of the stripe being read, if any.
+  std::shared_ptr<::arrow::RecordBatchReader> stripe_reader_;
+  // The position in the file of the first row of the next record batch.
+  int64_t next_row_ = 0;
+};
+
+OrcReader::~OrcReader() = default;
+
+Result<std::optional<ArrowArray>> OrcReader::Next() {
+  ICEBERG_TRACE_SCOPE(trace, "OrcReader::Next");
+  auto batch = impl_->Next();
+  ICEBERG_TRACE_ATTRIBUTE(trace, "rows",
+                          batch.has_value() && batch->has_value() ? (*batch)->length : 0);
+  return batch;
+}
+
+Result<ArrowSchema> OrcReader::Schema() { return impl_->Schema(); }
+
+Result<std::unordered_map<std::string, std::string>> OrcReader::Metadata() {
+  return impl_->Metadata();
+}
+
+Status OrcReader::Open(const ReaderOptions& options) {
+  impl_ = std::make_unique<Impl>();
+  return impl_->Open(options);
+}
+
+Status OrcReader::Close() { return impl_->Close(); }
+
+void RegisterReader() {
+  static ReaderFactoryRegistry orc_reader_register(
+      FileFormatType::kOrc, []() -> Result<std::unique_ptr<Reader>> {
+        return std::make_unique<OrcReader>();
+      });
+}
+
+}  // namespace iceberg::orc
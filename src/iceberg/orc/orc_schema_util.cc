@@ -0,0 +1,245 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/orc/orc_schema_util_internal.h"
+
+#include <charconv>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+
+#include <arrow/type.h>
+#include <arrow/util/key_value_metadata.h>
+
+#include "iceberg/constants.h"
+#include "iceberg/type.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg::orc {
+
+namespace {
+
+/// \brief Returns the field id of the `iceberg.id` attribute of an ORC column, or
+/// nullopt if it does not have one.
+std::optional<int32_t> FieldIdAttribute(const ::arrow::Field& field) {
+  if (field.metadata() == nullptr) {
+    return std::nullopt;
+  }
+  auto value = field.metadata()->Get(kOrcFieldIdKey);
+  if (!value.ok()) {
+    return std::nullopt;
+  }
+  int32_t field_id = 0;
+  auto [end, ec] =
+      std::from_chars(value->data(), value->data() + value->size(), field_id);
+  if (ec != std::errc() || end != value->data() + value->size()) {
+    return std::nullopt;
+  }
+  return field_id;
+}
+
+/// \brief Converts ORC columns to Iceberg fields that carry the ids of the matching
+/// expected fields.
+class FieldConverter {
+ public:
+  /// \brief Returns the field of an expected struct that matches an ORC column, or
+  /// nullptr if there is none.
+  static Result<const SchemaField*> FindExpected(const StructType& expected,
+                                                 const ::arrow::Field& field) {
+    auto field_id = FieldIdAttribute(field);
+    ICEBERG_ASSIGN_OR_RAISE(auto found, field_id.has_value()
+                                            ? expected.GetFieldById(*field_id)
+                                            : expected.GetFieldByName(field.name()));
+    return found.has_value() ? &found->get() : nullptr;
+  }
+
+  Result<SchemaField> Convert(const ::arrow::Field& field, const SchemaField* expected) {
+    int32_t field_id;
+    if (expected != nullptr) {
+      field_id = expected->field_id();
+    } else if (auto attribute = FieldIdAttribute(field); attribute.has_value()) {
+      field_id = *attribute;
+    } else {
+      field_id = next_unmatched_id_--;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto type, ConvertType(*field.type(),
+                               expected != nullptr ? expected->type().get() : nullptr));
+    return SchemaField(field_id, field.name(), std::move(type), field.nullable());
+  }
+
+ private:
+  Result<std::shared_ptr<Type>> ConvertType(const ::arrow::DataType& type,
+                                            const Type* expected) {
+    switch (type.id()) {
+      case ::arrow::Type::BOOL:
+        return boolean();
+      case ::arrow::Type::INT8:
+      case ::arrow::Type::INT16:
+      case ::arrow::Type::INT32:
+        return int32();
+      case ::arrow::Type::INT64:
+        // The Java implementation writes times as longs of microseconds.
+        if (expected != nullptr && expected->type_id() == TypeId::kTime) {
+          return time();
+        }
+        return int64();
+      case ::arrow::Type::FLOAT:
+        return float32();
+      case ::arrow::Type::DOUBLE:
+        return float64();
+      case ::arrow::Type::STRING:
+      case ::arrow::Type::LARGE_STRING:
+        return string();
+      case ::arrow::Type::BINARY:
+      case ::arrow::Type::LARGE_BINARY:
+        return binary();
+      case ::arrow::Type::DATE32:
+        return date();
+      case ::arrow::Type::TIMESTAMP:
+        // ORC timestamps are read in nanoseconds and cast to microseconds.
+        if (internal::checked_cast<const ::arrow::TimestampType&>(type)
+                .timezone()
+                .empty()) {
+          return timestamp();
+        }
+        return timestamp_tz();
+      case ::arrow::Type::DECIMAL128: {
+        const auto& decimal_type =
+            internal::checked_cast<const ::arrow::Decimal128Type&>(type);
+        return decimal(decimal_type.precision(), decimal_type.scale());
+      }
+      case ::arrow::Type::STRUCT: {
+        const auto* expected_struct = expected != nullptr &&
+                                              expected->type_id() == TypeId::kStruct
+                                          ? &internal::checked_cast<const StructType&>(
+                                                *expected)
+                                          : nullptr;
+        std::vector<SchemaField> fields;
+        fields.reserve(type.num_fields());
+        for (const auto& child : type.fields()) {
+          const SchemaField* expected_child = nullptr;
+          if (expected_struct != nullptr) {
+            ICEBERG_ASSIGN_OR_RAISE(expected_child,
+                                    FindExpected(*expected_struct, *child));
+          }
+          ICEBERG_ASSIGN_OR_RAISE(auto field, Convert(*child, expected_child));
+          fields.push_back(std::move(field));
+        }
+        return std::make_shared<StructType>(std::move(fields));
+      }
+      case ::arrow::Type::LIST:
+      case ::arrow::Type::LARGE_LIST: {
+        const SchemaField* expected_element =
+            expected != nullptr && expected->type_id() == TypeId::kList
+                ? &internal::checked_cast<const ListType&>(*expected).fields()[0]
+                : nullptr;
+        ICEBERG_ASSIGN_OR_RAISE(auto element,
+                                Convert(*type.field(0), expected_element));
+        return std::make_shared<ListType>(std::move(element));
+      }
+      case ::arrow::Type::MAP: {
+        const auto& map_type = internal::checked_cast<const ::arrow::MapType&>(type);
+        const auto* expected_map =
+            expected != nullptr && expected->type_id() == TypeId::kMap
+                ? &internal::checked_cast<const MapType&>(*expected)
+                : nullptr;
+        ICEBERG_ASSIGN_OR_RAISE(
+            auto key, Convert(*map_type.key_field(),
+                              expected_map != nullptr ? &expected_map->key() : nullptr));
+        ICEBERG_ASSIGN_OR_RAISE(
+            auto value,
+            Convert(*map_type.item_field(),
+                    expected_map != nullptr ? &expected_map->value() : nullptr));
+        return std::make_shared<MapType>(std::move(key), std::move(value));
+      }
+      default:
+        return NotSupported("Unsupported ORC column type: {}", type.ToString());
+    }
+  }
+
+  // Ids of the nested columns without an expected field, counting down so that they
+  // do not collide with the ids of the expected schema.
+  int32_t next_unmatched_id_ = std::numeric_limits<int32_t>::max();
+};
+
+void CollectColumnIds(const Type& type, const std::string& prefix, bool named,
+                      int64_t& next_column_id,
+                      std::unordered_map<std::string, int64_t>& column_ids) {
+  if (!type.is_nested()) {
+    return;
+  }
+  // Fields of lists and maps cannot be named by a path of struct fields.
+  named = named && type.type_id() == TypeId::kStruct;
+  for (const auto& field :
+       internal::checked_cast<const NestedType&>(type).fields()) {
+    const int64_t column_id = next_column_id++;
+    std::string path;
+    if (named) {
+      path = prefix.empty() ? field.name() : prefix + "." + field.name();
+      column_ids.emplace(path, column_id);
+    }
+    CollectColumnIds(*field.type(), path, named, next_column_id, column_ids);
+  }
+}
+
+}  // namespace
+
+Result<OrcProjection> Project(const Schema& expected_schema,
+                              const ::arrow::Schema& file_schema) {
+  FieldConverter converter;
+  OrcProjection result;
+  std::vector<SchemaField> fields;
+  for (const auto& field : file_schema.fields()) {
+    ICEBERG_ASSIGN_OR_RAISE(auto expected,
+                            FieldConverter::FindExpected(expected_schema, *field));
+    if (expected == nullptr) {
+      continue;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto converted, converter.Convert(*field, expected));
+    fields.push_back(std::move(converted));
+    result.column_names.push_back(field->name());
+  }
+
+  // Only the matching columns are read, so the projection is made onto them alone.
+  Schema read_schema(std::move(fields));
+  ICEBERG_ASSIGN_OR_RAISE(
+      result.projection,
+      ::iceberg::Project(expected_schema, read_schema, /*prune_source=*/false));
+  return result;
+}
+
+std::vector<int64_t> ColumnIds(const Schema& schema,
+                               const std::vector<std::string>& names) {
+  std::unordered_map<std::string, int64_t> column_ids;
+  // Column 0 is the root struct.
+  int64_t next_column_id = 1;
+  CollectColumnIds(schema, /*prefix=*/"", /*named=*/true, next_column_id, column_ids);
+
+  std::vector<int64_t> result;
+  for (const auto& name : names) {
+    if (auto it = column_ids.find(name); it != column_ids.end()) {
+      result.push_back(it->second);
+    }
+  }
+  return result;
+}
+
+}  // namespace iceberg::orc
@@ -0,0 +1,66 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <arrow/type_fwd.h>
+
+#include "iceberg/result.h"
+#include "iceberg/schema.h"
+#include "iceberg/schema_util.h"
+
+namespace iceberg::orc {
+
+/// \brief The columns to read from an ORC file and their projection.
+struct OrcProjection {
+  /// \brief The names of the top-level ORC columns to read, in file order.
+  std::vector<std::string> column_names;
+  /// \brief The projection from the expected schema onto the columns read.
+  SchemaProjection projection;
+};
+
+/// \brief Project an Iceberg Schema onto the Arrow schema of an ORC file.
+///
+/// ORC columns are matched with the expected fields by the `iceberg.id` attribute
+/// written by the Java implementation. Files without the attribute, such as the ones
+/// written through Arrow, are matched by field names. Only the top-level columns that
+/// match a field of the expected schema are read.
+///
+/// \param expected_schema The Iceberg Schema that defines the expected structure.
+/// \param file_schema The Arrow schema of the ORC file.
+/// \return The columns to read and the projection onto them.
+Result<OrcProjection> Project(const Schema& expected_schema,
+                              const ::arrow::Schema& file_schema);
+
+/// \brief Returns the ORC column ids of the fields of a schema.
+///
+/// ORC numbers the columns of a file in pre-order, starting with 0 for the root struct.
+/// Nested fields of structs are named by their dot-separated path.
+///
+/// \param schema The schema of the written ORC file.
+/// \param names The names of the fields.
+/// \return The column ids of the fields, skipping the names not in the schema.
+std::vector<int64_t> ColumnIds(const Schema& schema,
+                               const std::vector<std::string>& names);
+
+}  // namespace iceberg::orc
@@ -0,0 +1,366 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/orc/orc_writer.h"
+
+#include <charconv>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <arrow/adapters/orc/adapter.h>
+#include <arrow/adapters/orc/options.h>
+#include <arrow/c/bridge.h>
+#include <arrow/record_batch.h>
+#include <arrow/table.h>
+#include <arrow/util/byte_size.h>
+#include <arrow/util/compression.h>
+
+#include "iceberg/arrow/arrow_fs_file_io_internal.h"
+#include "iceberg/arrow/arrow_memory_pool_internal.h"
+#include "iceberg/arrow/arrow_status_internal.h"
+#include "iceberg/metrics_config.h"
+#include "iceberg/orc/orc_schema_util_internal.h"
+#include "iceberg/schema.h"
+#include "iceberg/schema_internal.h"
+#include "iceberg/table_properties.h"
+#include "iceberg/util/arrow_metrics_internal.h"
+#include "iceberg/util/macros.h"
+#include "iceberg/util/string_util.h"
+
+namespace iceberg::orc {
+
+namespace {
+
+Result<std::shared_ptr<::arrow::io::OutputStream>> OpenOutputStream(
+    const WriterOptions& options) {
+  return arrow::OpenArrowOutputStream(options.io, options.path);
+}
+
+/// \brief Returns the value of a writer property, or nullptr if it is not set.
+template <typename T>
+const std::string* FindProperty(
+    const std::unordered_map<std::string, std::string>& properties,
+    const TableProperties::Entry<T>& entry) {
+  auto it = properties.find(entry.key());
+  return it != properties.cend() ? &it->second : nullptr;
+}
+
+/// \brief Returns a positive numeric property, which defaults to the default of the
+/// table property.
+template <typename T>
+Result<T> ParsePositive(const std::unordered_map<std::string, std::string>& properties,
+                        const TableProperties::Entry<T>& entry) {
+  const std::string* value = FindProperty(properties, entry);
+  if (value == nullptr) {
+    return entry.value();
+  }
+  T number{};
+  auto [end, ec] = std::from_chars(value->data(), value->data() + value->size(), number);
+  if (ec != std::errc() || end != value->data() + value->size() || !(number > 0)) {
+    return InvalidArgument("Invalid {}: {}, expected a positive number", entry.key(),
+                           *value);
+  }
+  return number;
+}
+
+Result<::arrow::Compression::type> ParseCodec(const std::string& codec) {
+  if (codec == "none") {
+    return ::arrow::Compression::UNCOMPRESSED;
+  } else if (codec == "zlib") {
+    // Written as the ZLIB compression kind of ORC.
+    return ::arrow::Compression::GZIP;
+  } else if (codec == "snappy") {
+    return ::arrow::Compression::SNAPPY;
+  } else if (codec == "lzo") {
+    return ::arrow::Compression::LZO;
+  } else if (codec == "lz4") {
+    return ::arrow::Compression::LZ4;
+  } else if (codec == "zstd") {
+    return ::arrow::Compression::ZSTD;
+  }
+  return InvalidArgument("Unsupported ORC compression codec: {}", codec);
+}
+
+Result<::arrow::adapters::orc::CompressionStrategy> ParseCompressionStrategy(
+    const std::string& strategy) {
+  if (strategy == "speed") {
+    return ::arrow::adapters::orc::CompressionStrategy::kSpeed;
+  } else if (strategy == "compression") {
+    return ::arrow::adapters::orc::CompressionStrategy::kCompression;
+  }
+  return InvalidArgument("Unsupported ORC compression strategy: {}", strategy);
+}
+
+/// \brief Splits a comma-separated list of column names, ignoring surrounding spaces.
+std::vector<std::string> SplitColumnNames(std::string_view columns) {
+  std::vector<std::string> names;
+  size_t begin = 0;
+  while (begin <= columns.size()) {
+    size_t end = columns.find(',', begin);
+    if (end == std::string_view::npos) {
+      end = columns.size();
+    }
+    std::string_view name = columns.substr(begin, end - begin);
+    while (!name.empty() && name.front() == ' ') {
+      name.remove_prefix(1);
+    }
+    while (!name.empty() && name.back() == ' ') {
+      name.remove_suffix(1);
+    }
+    if (!name.empty()) {
+      names.emplace_back(name);
+    }
+    begin = end + 1;
+  }
+  return names;
+}
+
+/// \brief Maps the ORC table properties of the writer properties onto the ORC write
+/// options.
+///
+/// Bloom filters are written for the columns of `write.orc.bloom.filter.columns`, a
+/// comma-separated list of column names. Columns that are not in the schema, such as
+/// dropped columns, are ignored.
+Result<::arrow::adapters::orc::WriteOptions> MakeWriteOptions(
+    const std::unordered_map<std::string, std::string>& properties,
+    const Schema& schema) {
+  ::arrow::adapters::orc::WriteOptions options;
+
+  const std::string* codec_property =
+      FindProperty(properties, TableProperties::kOrcCompression);
+  const std::string codec_name = StringUtils::ToLower(
+      codec_property != nullptr ? *codec_property
+                                : TableProperties::kOrcCompression.value());
+  ICEBERG_ASSIGN_OR_RAISE(options.compression, ParseCodec(codec_name));
+  if (!::arrow::util::Codec::IsAvailable(options.compression)) {
+    return NotSupported("ORC compression codec {} is not available", codec_name);
+  }
+
+  const std::string* strategy_property =
+      FindProperty(properties, TableProperties::kOrcCompressionStrategy);
+  ICEBERG_ASSIGN_OR_RAISE(
+      options.compression_strategy,
+      ParseCompressionStrategy(StringUtils::ToLower(
+          strategy_property != nullptr
+              ? *strategy_property
+              : TableProperties::kOrcCompressionStrategy.value())));
+
+  ICEBERG_ASSIGN_OR_RAISE(
+      options.stripe_size,
+      ParsePositive(properties, TableProperties::kOrcStripeSizeBytes));
+  ICEBERG_ASSIGN_OR_RAISE(
+      options.batch_size, ParsePositive(properties, TableProperties::kOrcWriteBatchSize));
+
+  const std::string* columns =
+      FindProperty(properties, TableProperties::kOrcBloomFilterColumns);
+  if (columns != nullptr && !columns->empty()) {
+    options.bloom_filter_columns = ColumnIds(schema, SplitColumnNames(*columns));
+    ICEBERG_ASSIGN_OR_RAISE(
+        options.bloom_filter_fpp,
+        ParsePositive(properties, TableProperties::kOrcBloomFilterFpp));
+    if (options.bloom_filter_fpp >= 1) {
+      return InvalidArgument("Invalid {}: {}, expected a probability in (0, 1)",
+                             TableProperties::kOrcBloomFilterFpp.key(),
+                             options.bloom_filter_fpp);
+    }
+  }
+  return options;
+}
+
+}  // namespace
+
+class OrcWriter::Impl {
+ public:
+  Status Open(const WriterOptions& options) {
+    io_ = options.io;
+    path_ = options.path;
+    pool_ = arrow::ToArrowMemoryPool(options.memory_pool);
+
+    ArrowSchema c_schema;
+    ICEBERG_RETURN_UNEXPECTED(ToArrowSchema(*options.schema, &c_schema));
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(arrow_schema_, ::arrow::ImportSchema(&c_schema));
+
+    ICEBERG_ASSIGN_OR_RAISE(auto write_options,
+                            MakeWriteOptions(options.properties, *options.schema));
+    ICEBERG_ASSIGN_OR_RAISE(auto metrics_config,
+                            MetricsConfig::Make(options.properties, *options.schema));
+    ICEBERG_ASSIGN_OR_RAISE(metrics_collector_,
+                            ArrowMetricsCollector::Make(*options.schema,
+                                                        std::move(metrics_config)));
+
+    ICEBERG_ASSIGN_OR_RAISE(output_stream_, OpenOutputStream(options));
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(
+        writer_,
+        ::arrow::adapters::orc::ORCFileWriter::Open(output_stream_.get(), write_options));
+    return {};
+  }
+
+  Status Write(ArrowArray* array) {
+    ICEBERG_RETURN_UNEXPECTED(metrics_collector_->Update(*array));
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(auto batch,
+                                   ::arrow::ImportRecordBatch(array, arrow_schema_));
+    if (batch->num_rows() == 0) {
+      return {};
+    }
+
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(auto batch_bytes,
+                                   ::arrow::util::ReferencedBufferSize(*batch));
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(auto table,
+                                   ::arrow::Table::FromRecordBatches({batch}));
+    ICEBERG_ARROW_RETURN_NOT_OK(writer_->Write(*table));
+
+    // The writer buffers the rows of a stripe until it reaches the stripe size, so the
+    // rows written since the output last grew are not flushed yet.
+    buffered_bytes_ += batch_bytes;
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(auto position, output_stream_->Tell());
+    if (position > flushed_length_) {
+      flushed_length_ = position;
+      flushed_row_bytes_ += buffered_bytes_;
+      buffered_bytes_ = 0;
+    }
+    return {};
+  }
+
+  // Close the writer and release resources
+  Status Close() {
+    if (writer_ == nullptr) {
+      return {};  // Already closed
+    }
+
+    ICEBERG_ARROW_RETURN_NOT_OK(writer_->Close());
+    writer_.reset();
+    metrics_ = metrics_collector_->Finish();
+
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(total_bytes_, output_stream_->Tell());
+    ICEBERG_ARROW_RETURN_NOT_OK(output_stream_->Close());
+
+    // The ORC writer of Arrow does not report where its stripes were written, so they
+    // are read back from the tail of the file.
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto input_file,
+        arrow::OpenArrowInputFile(io_, path_, static_cast<size_t>(total_bytes_)));
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(
+        auto reader, ::arrow::adapters::orc::ORCFileReader::Open(input_file, pool_));
+    const int64_t num_stripes = reader->NumberOfStripes();
+    split_offsets_.reserve(num_stripes);
+    for (int64_t i = 0; i < num_stripes; ++i) {
+      split_offsets_.push_back(reader->GetStripeInformation(i).offset);
+    }
+    ICEBERG_ARROW_RETURN_NOT_OK(input_file->Close());
+    return {};
+  }
+
+  bool Closed() const { return writer_ == nullptr; }
+
+  int64_t length() const { return total_bytes_; }
+
+  std::optional<int64_t> EstimatedLength() const {
+    // The buffered rows are estimated with the ratio of encoded to in-memory bytes of
+    // the flushed ones.
+    if (flushed_row_bytes_ == 0) {
+      return flushed_length_ + buffered_bytes_;
+    }
+    const double ratio =
+        static_cast<double>(flushed_length_) / static_cast<double>(flushed_row_bytes_);
+    return flushed_length_ +
+           static_cast<int64_t>(static_cast<double>(buffered_bytes_) * ratio);
+  }
+
+  std::vector<int64_t> split_offsets() const { return split_offsets_; }
+
+  const Metrics& metrics() const { return metrics_; }
+
+ private:
+  ::arrow::MemoryPool* pool_ = ::arrow::default_memory_pool();
+  // FileIO and path of the written file, to read its stripes back when closed.
+  std::shared_ptr<FileIO> io_;
+  std::string path_;
+  // Schema to write to the ORC file.
+  std::shared_ptr<::arrow::Schema> arrow_schema_;
+  // The output stream to write ORC file.
+  std::shared_ptr<::arrow::io::OutputStream> output_stream_;
+  // ORC file writer to write ArrowArray.
+  std::unique_ptr<::arrow::adapters::orc::ORCFileWriter> writer_;
+  // Length of the output when it last grew.
+  int64_t flushed_length_{0};
+  // Estimated size in bytes of the rows written before the output last grew.
+  int64_t flushed_row_bytes_{0};
+  // Estimated size in bytes of the rows written since the output last grew.
+  int64_t buffered_bytes_{0};
+  // Total length of the written ORC file.
+  int64_t total_bytes_{0};
+  // Stripe start offsets in the ORC file.
+  std::vector<int64_t> split_offsets_;
+  // Collector of the column metrics of the written rows.
+  std::optional<ArrowMetricsCollector> metrics_collector_;
+  // Metrics of the closed file.
+  Metrics metrics_;
+};
+
+OrcWriter::~OrcWriter() = default;
+
+Status OrcWriter::Open(const WriterOptions& options) {
+  impl_ = std::make_unique<Impl>();
+  return impl_->Open(options);
+}
+
+Status OrcWriter::Write(ArrowArray* array) { return impl_->Write(array); }
+
+Status OrcWriter::Close() { return impl_->Close(); }
+
+std::optional<Metrics> OrcWriter::metrics() {
+  if (!impl_->Closed()) {
+    return std::nullopt;
+  }
+  return impl_->metrics();
+}
+
+std::optional<int64_t> OrcWriter::length() {
+  if (!impl_->Closed()) {
+    return std::nullopt;
+  }
+  return impl_->length();
+}
+
+std::optional<int64_t> OrcWriter::estimated_length() {
+  if (impl_->Closed()) {
+    return impl_->length();
+  }
+  return impl_->EstimatedLength();
+}
+
+std::vector<int64_t> OrcWriter::split_offsets() {
+  if (!impl_->Closed()) {
+    return {};
+  }
+  return impl_->split_offsets();
+}
+
+void RegisterWriter() {
+  static WriterFactoryRegistry orc_writer_register(
+      FileFormatType::kOrc, []() -> Result<std::unique_ptr<Writer>> {
+        return std::make_unique<OrcWriter>();
+      });
+}
+
+}  // namespace iceberg::orc
@@ -0,0 +1,766 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/parquet/parquet_bloom_filter_writer_internal.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <utility>
+
+#include <arrow/array.h>
+#include <arrow/extension_type.h>
+#include <parquet/bloom_filter.h>
+#include <parquet/exception.h>
+#include <parquet/types.h>
+#include <parquet/xxhasher.h>
+
+#include "iceberg/arrow/arrow_status_internal.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg::parquet {
+
+namespace {
+
+// Types of the Thrift compact protocol.
+constexpr uint8_t kCompactStop = 0;
+constexpr uint8_t kCompactBooleanTrue = 1;
+constexpr uint8_t kCompactBooleanFalse = 2;
+constexpr uint8_t kCompactByte = 3;
+constexpr uint8_t kCompactI16 = 4;
+constexpr uint8_t kCompactI32 = 5;
+constexpr uint8_t kCompactI64 = 6;
+constexpr uint8_t kCompactDouble = 7;
+constexpr uint8_t kCompactBinary = 8;
+constexpr uint8_t kCompactList = 9;
+constexpr uint8_t kCompactSet = 10;
+constexpr uint8_t kCompactMap = 11;
+constexpr uint8_t kCompactStruct = 12;
+
+// Field ids of the Parquet Thrift structs on the path to the bloom filter locations.
+constexpr int16_t kFileMetaDataRowGroups = 4;
+constexpr int16_t kRowGroupColumns = 1;
+constexpr int16_t kColumnChunkMetaData = 3;
+constexpr int16_t kColumnMetaDataBloomFilterOffset = 14;
+constexpr int16_t kColumnMetaDataBloomFilterLength = 15;
+
+// Nesting limit of skipped values, which guards against corrupt input.
+constexpr int kMaxNestingDepth = 64;
+
+constexpr std::string_view kParquetMagic = "PAR1";
+
+uint64_t ZigZagEncode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t ZigZagDecode(uint64_t value) {
+  return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+using BloomFilterLocations = std::vector<std::vector<std::optional<BloomFilterLocation>>>;
+
+/// \brief Copies a FileMetaData of the Thrift compact protocol, adding the locations of
+/// bloom filters to the ColumnMetaData of its column chunks.
+///
+/// Every other value is copied byte for byte. Since the field headers of the compact
+/// protocol hold the difference to the id of the previous field, only the headers of
+/// the ColumnMetaData fields are rewritten.
+class FooterTranscoder {
+ public:
+  FooterTranscoder(std::string_view input, const BloomFilterLocations& locations)
+      : input_(input), locations_(locations) {}
+
+  Result<std::string> Transcode() {
+    output_.reserve(input_.size() + input_.size() / 8);
+    ICEBERG_RETURN_UNEXPECTED(CopyStruct(kFileMetaDataRowGroups, kCompactList, [&]() {
+      return CopyList(locations_.size(), [&](size_t row_group) {
+        return CopyStruct(kRowGroupColumns, kCompactList, [&]() {
+          return CopyList(locations_[row_group].size(), [&](size_t column) {
+            return CopyStruct(kColumnChunkMetaData, kCompactStruct, [&]() {
+              return CopyColumnMetaData(locations_[row_group][column]);
+            });
+          });
+        });
+      });
+    }));
+    if (pos_ != input_.size()) {
+      return Invalid("Parquet footer has {} bytes after the FileMetaData",
+                     input_.size() - pos_);
+    }
+    return std::move(output_);
+  }
+
+ private:
+  struct FieldHeader {
+    uint8_t type;
+    int16_t id;
+  };
+
+  Result<uint8_t> ReadByte() {
+    if (pos_ >= input_.size()) {
+      return Invalid("Unexpected end of Parquet footer");
+    }
+    return static_cast<uint8_t>(input_[pos_++]);
+  }
+
+  Status Advance(uint64_t size) {
+    if (size > input_.size() - pos_) {
+      return Invalid("Unexpected end of Parquet footer");
+    }
+    pos_ += size;
+    return {};
+  }
+
+  Result<uint64_t> ReadVarint() {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      ICEBERG_ASSIGN_OR_RAISE(auto byte, ReadByte());
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+    return Invalid("Invalid varint in Parquet footer");
+  }
+
+  Result<FieldHeader> ReadFieldHeader(int16_t last_id) {
+    ICEBERG_ASSIGN_OR_RAISE(auto byte, ReadByte());
+    const uint8_t type = byte & 0x0f;
+    if (type == kCompactStop) {
+      return FieldHeader{.type = kCompactStop, .id = 0};
+    }
+    if (const int delta = byte >> 4; delta != 0) {
+      return FieldHeader{.type = type, .id = static_cast<int16_t>(last_id + delta)};
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto id, ReadVarint());
+    return FieldHeader{.type = type, .id = static_cast<int16_t>(ZigZagDecode(id))};
+  }
+
+  Result<std::pair<uint8_t, uint64_t>> ReadListHeader() {
+    ICEBERG_ASSIGN_OR_RAISE(auto byte, ReadByte());
+    uint64_t size = byte >> 4;
+    if (size == 15) {
+      ICEBERG_ASSIGN_OR_RAISE(size, ReadVarint());
+    }
+    return std::make_pair(static_cast<uint8_t>(byte & 0x0f), size);
+  }
+
+  /// \brief Skips a value. Booleans of struct fields are held by the field header,
+  /// while booleans in collections take a byte.
+  Status Skip(uint8_t type, bool in_collection, int depth) {
+    if (depth > kMaxNestingDepth) {
+      return Invalid("Parquet footer is nested too deeply");
+    }
+    switch (type) {
+      case kCompactBooleanTrue:
+      case kCompactBooleanFalse:
+        return in_collection ? Advance(1) : Status{};
+      case kCompactByte:
+        return Advance(1);
+      case kCompactI16:
+      case kCompactI32:
+      case kCompactI64:
+        ICEBERG_RETURN_UNEXPECTED(ReadVarint());
+        return {};
+      case kCompactDouble:
+        return Advance(8);
+      case kCompactBinary: {
+        ICEBERG_ASSIGN_OR_RAISE(auto size, ReadVarint());
+        return Advance(size);
+      }
+      case kCompactList:
+      case kCompactSet: {
+        ICEBERG_ASSIGN_OR_RAISE(auto header, ReadListHeader());
+        for (uint64_t i = 0; i < header.second; ++i) {
+          ICEBERG_RETURN_UNEXPECTED(
+              Skip(header.first, /*in_collection=*/true, depth + 1));
+        }
+        return {};
+      }
+      case kCompactMap: {
+        ICEBERG_ASSIGN_OR_RAISE(auto size, ReadVarint());
+        if (size == 0) {
+          return {};
+        }
+        ICEBERG_ASSIGN_OR_RAISE(auto types, ReadByte());
+        for (uint64_t i = 0; i < size; ++i) {
+          ICEBERG_RETURN_UNEXPECTED(
+              Skip(types >> 4, /*in_collection=*/true, depth + 1));
+          ICEBERG_RETURN_UNEXPECTED(
+              Skip(types & 0x0f, /*in_collection=*/true, depth + 1));
+        }
+        return {};
+      }
+      case kCompactStruct: {
+        int16_t last_id = 0;
+        while (true) {
+          ICEBERG_ASSIGN_OR_RAISE(auto field, ReadFieldHeader(last_id));
+          if (field.type == kCompactStop) {
+            return {};
+          }
+          ICEBERG_RETURN_UNEXPECTED(Skip(field.type, /*in_collection=*/false, depth + 1));
+          last_id = field.id;
+        }
+      }
+      default:
+        return Invalid("Invalid Thrift type {} in Parquet footer", type);
+    }
+  }
+
+  Status CopyValue(uint8_t type) {
+    const size_t start = pos_;
+    ICEBERG_RETURN_UNEXPECTED(Skip(type, /*in_collection=*/false, /*depth=*/0));
+    output_.append(input_.substr(start, pos_ - start));
+    return {};
+  }
+
+  /// \brief Copies a struct, copying the value of the field with the given id and type
+  /// by copy_field.
+  template <typename CopyField>
+  Status CopyStruct(int16_t id, uint8_t type, CopyField&& copy_field) {
+    int16_t last_id = 0;
+    while (true) {
+      const size_t start = pos_;
+      ICEBERG_ASSIGN_OR_RAISE(auto field, ReadFieldHeader(last_id));
+      output_.append(input_.substr(start, pos_ - start));
+      if (field.type == kCompactStop) {
+        return {};
+      }
+      if (field.id == id && field.type == type) {
+        ICEBERG_RETURN_UNEXPECTED(copy_field());
+      } else {
+        ICEBERG_RETURN_UNEXPECTED(CopyValue(field.type));
+      }
+      last_id = field.id;
+    }
+  }
+
+  /// \brief Copies a list of structs, copying its elements by copy_element.
+  template <typename CopyElement>
+  Status CopyList(size_t expected_size, CopyElement&& copy_element) {
+    const size_t start = pos_;
+    ICEBERG_ASSIGN_OR_RAISE(auto header, ReadListHeader());
+    output_.append(input_.substr(start, pos_ - start));
+    if (header.first != kCompactStruct || header.second != expected_size) {
+      return Invalid("Parquet footer has {} row groups or columns, expected {}",
+                     header.second, expected_size);
+    }
+    for (size_t i = 0; i < expected_size; ++i) {
+      ICEBERG_RETURN_UNEXPECTED(copy_element(i));
+    }
+    return {};
+  }
+
+  void WriteVarint(uint64_t value) {
+    while (value >= 0x80) {
+      output_.push_back(static_cast<char>((value & 0x7f) | 0x80));
+      value >>= 7;
+    }
+    output_.push_back(static_cast<char>(value));
+  }
+
+  void WriteFieldHeader(uint8_t type, int16_t id, int16_t last_id) {
+    if (id > last_id && id - last_id <= 15) {
+      output_.push_back(static_cast<char>(((id - last_id) << 4) | type));
+    } else {
+      output_.push_back(static_cast<char>(type));
+      WriteVarint(ZigZagEncode(id));
+    }
+  }
+
+  /// \brief Copies a ColumnMetaData, adding the location of its bloom filter in the
+  /// order of the field ids. A location that is already set is kept.
+  Status CopyColumnMetaData(const std::optional<BloomFilterLocation>& location) {
+    bool added = !location.has_value();
+    int16_t last_id = 0;
+    int16_t last_written_id = 0;
+    while (true) {
+      ICEBERG_ASSIGN_OR_RAISE(auto field, ReadFieldHeader(last_id));
+      const bool stop = field.type == kCompactStop;
+      if (!added && (stop || field.id >= kColumnMetaDataBloomFilterOffset)) {
+        added = true;
+        if (stop || field.id > kColumnMetaDataBloomFilterLength) {
+          WriteFieldHeader(kCompactI64, kColumnMetaDataBloomFilterOffset,
+                           last_written_id);
+          WriteVarint(ZigZagEncode(location->offset));
+          WriteFieldHeader(kCompactI32, kColumnMetaDataBloomFilterLength,
+                           kColumnMetaDataBloomFilterOffset);
+          WriteVarint(ZigZagEncode(location->length));
+          last_written_id = kColumnMetaDataBloomFilterLength;
+        }
+      }
+      if (stop) {
+        output_.push_back(static_cast<char>(kCompactStop));
+        return {};
+      }
+      WriteFieldHeader(field.type, field.id, last_written_id);
+      ICEBERG_RETURN_UNEXPECTED(CopyValue(field.type));
+      last_id = last_written_id = field.id;
+    }
+  }
+
+  std::string_view input_;
+  size_t pos_ = 0;
+  const BloomFilterLocations& locations_;
+  std::string output_;
+};
+
+/// \brief An output stream that can hold back the last writes to its sink.
+///
+/// The Parquet file writer writes the footer last, in three writes: the FileMetaData,
+/// its length and the magic bytes. Holding back the last three writes while the file
+/// writer is closed keeps the footer out of the sink, while the positions that the
+/// file writer sees stay those of the file it writes.
+class HoldingOutputStream : public ::arrow::io::OutputStream {
+ public:
+  HoldingOutputStream(std::shared_ptr<::arrow::io::OutputStream> sink, int64_t position)
+      : sink_(std::move(sink)), position_(position) {}
+
+  /// \brief Does not close the sink, which is closed by its owner.
+  ::arrow::Status Close() override {
+    closed_ = true;
+    return ::arrow::Status::OK();
+  }
+
+  bool closed() const override { return closed_; }
+
+  ::arrow::Result<int64_t> Tell() const override { return position_; }
+
+  using ::arrow::io::OutputStream::Write;
+
+  ::arrow::Status Write(const void* data, int64_t nbytes) override {
+    position_ += nbytes;
+    if (!holding_) {
+      return sink_->Write(data, nbytes);
+    }
+    held_.emplace_back(static_cast<const char*>(data), static_cast<size_t>(nbytes));
+    if (held_.size() > kHeldWrites) {
+      auto status = sink_->Write(held_.front().data(),
+                                 static_cast<int64_t>(held_.front().size()));
+      held_.pop_front();
+      return status;
+    }
+    return ::arrow::Status::OK();
+  }
+
+  ::arrow::Status Flush() override {
+    return holding_ ? ::arrow::Status::OK() : sink_->Flush();
+  }
+
+  void Hold() { holding_ = true; }
+
+  /// \brief Stops holding back writes, and returns the bytes held back.
+  std::string Release() {
+    std::string bytes;
+    for (const auto& write : held_) {
+      bytes += write;
+    }
+    held_.clear();
+    holding_ = false;
+    return bytes;
+  }
+
+ private:
+  static constexpr size_t kHeldWrites = 3;
+
+  std::shared_ptr<::arrow::io::OutputStream> sink_;
+  int64_t position_;
+  bool holding_ = false;
+  bool closed_ = false;
+  std::deque<std::string> held_;
+};
+
+/// \brief Appends the arrays of the Parquet leaf columns of an array, in the order of
+/// the leaf columns. Values under null structs and lists are included, which at worst
+/// adds false positives to the filters.
+void CollectLeaves(const std::shared_ptr<::arrow::Array>& array,
+                   std::vector<std::shared_ptr<::arrow::Array>>* leaves) {
+  switch (array->type_id()) {
+    case ::arrow::Type::EXTENSION:
+      CollectLeaves(
+          internal::checked_cast<const ::arrow::ExtensionArray&>(*array).storage(),
+          leaves);
+      return;
+    case ::arrow::Type::STRUCT: {
+      const auto& struct_array =
+          internal::checked_cast<const ::arrow::StructArray&>(*array);
+      for (int i = 0; i < struct_array.num_fields(); ++i) {
+        CollectLeaves(struct_array.field(i), leaves);
+      }
+      return;
+    }
+    case ::arrow::Type::LIST:
+    case ::arrow::Type::MAP: {
+      // The values of a map are its entries, a struct of the key and the value.
+      const auto& list_array = internal::checked_cast<const ::arrow::ListArray&>(*array);
+      const int64_t begin = list_array.length() > 0 ? list_array.value_offset(0) : 0;
+      const int64_t end =
+          list_array.length() > 0 ? list_array.value_offset(list_array.length()) : 0;
+      CollectLeaves(list_array.values()->Slice(begin, end - begin), leaves);
+      return;
+    }
+    default:
+      leaves->push_back(array);
+  }
+}
+
+/// \brief Appends the hashes of the non-null values of an array.
+template <typename Hash>
+void HashValid(const ::arrow::Array& array, Hash&& hash, std::vector<uint64_t>* hashes) {
+  for (int64_t i = 0; i < array.length(); ++i) {
+    if (array.IsValid(i)) {
+      hashes->push_back(hash(i));
+    }
+  }
+}
+
+template <typename ArrayType>
+void HashBinaryValues(const ::arrow::Array& array, const ::parquet::XxHasher& hasher,
+                      std::vector<uint64_t>* hashes) {
+  const auto& binary = internal::checked_cast<const ArrayType&>(array);
+  HashValid(
+      array,
+      [&](int64_t i) {
+        const auto value = binary.GetView(i);
+        ::parquet::ByteArray byte_array(static_cast<uint32_t>(value.size()),
+                                        reinterpret_cast<const uint8_t*>(value.data()));
+        return hasher.Hash(&byte_array);
+      },
+      hashes);
+}
+
+template <typename T>
+void HashNumericValues(const ::arrow::Array& array, const ::parquet::XxHasher& hasher,
+                       std::vector<uint64_t>* hashes) {
+  const auto* values = array.data()->GetValues<T>(1);
+  HashValid(array, [&](int64_t i) { return hasher.Hash(values[i]); }, hashes);
+}
+
+/// \brief Appends the hashes of the non-null values of a leaf column array, hashed as
+/// values of the physical type of the column like the Parquet reader hashes them.
+Status HashValues(const ::arrow::Array& array, const ::parquet::ColumnDescriptor& column,
+                  const ::parquet::XxHasher& hasher, std::vector<uint64_t>* hashes) {
+  switch (column.physical_type()) {
+    case ::parquet::Type::INT32:
+      HashNumericValues<int32_t>(array, hasher, hashes);
+      return {};
+    case ::parquet::Type::INT64:
+      HashNumericValues<int64_t>(array, hasher, hashes);
+      return {};
+    case ::parquet::Type::FLOAT:
+      HashNumericValues<float>(array, hasher, hashes);
+      return {};
+    case ::parquet::Type::DOUBLE:
+      HashNumericValues<double>(array, hasher, hashes);
+      return {};
+    case ::parquet::Type::BYTE_ARRAY:
+      switch (array.type_id()) {
+        case ::arrow::Type::STRING:
+        case ::arrow::Type::BINARY:
+          HashBinaryValues<::arrow::BinaryArray>(array, hasher, hashes);
+          return {};
+        case ::arrow::Type::LARGE_STRING:
+        case ::arrow::Type::LARGE_BINARY:
+          HashBinaryValues<::arrow::LargeBinaryArray>(array, hasher, hashes);
+          return {};
+        default:
+          break;
+      }
+      break;
+    case ::parquet::Type::FIXED_LEN_BYTE_ARRAY: {
+      const auto length = static_cast<uint32_t>(column.type_length());
+      if (array.type_id() == ::arrow::Type::FIXED_SIZE_BINARY) {
+        const auto& fixed =
+            internal::checked_cast<const ::arrow::FixedSizeBinaryArray&>(array);
+        HashValid(
+            array,
+            [&](int64_t i) {
+              ::parquet::FLBA value(fixed.GetValue(i));
+              return hasher.Hash(&value, length);
+            },
+            hashes);
+        return {};
+      }
+      if (array.type_id() == ::arrow::Type::DECIMAL128 && length <= 16) {
+        const auto& decimals =
+            internal::checked_cast<const ::arrow::FixedSizeBinaryArray&>(array);
+        std::array<uint8_t, 16> bytes;
+        // Arrow decimals are little-endian, while Parquet writes them big-endian in the
+        // length of the column.
+        HashValid(
+            array,
+            [&](int64_t i) {
+              const uint8_t* value = decimals.GetValue(i);
+              std::reverse_copy(value, value + length, bytes.begin());
+              ::parquet::FLBA flba(bytes.data());
+              return hasher.Hash(&flba, length);
+            },
+            hashes);
+        return {};
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  return NotSupported("Cannot write a bloom filter of Parquet column {} from {} values",
+                      column.path()->ToDotString(), array.type()->ToString());
+}
+
+/// \brief Builds the bloom filter of a column chunk.
+///
+/// The filter is sized for the distinct values of the column chunk at the false positive
+/// probability. Their hashes are collected until there are more than a filter of the
+/// maximum size holds, after which they go into a filter of the maximum size.
+class BloomFilterBuilder {
+ public:
+  BloomFilterBuilder(double fpp, uint32_t max_bytes)
+      : fpp_(fpp), max_bytes_(max_bytes) {
+    // A split-block filter holds -ln(1 - fpp^(1/8)) distinct values per byte.
+    max_ndv_ = std::max<size_t>(
+        1, static_cast<size_t>(static_cast<double>(max_bytes) *
+                               -std::log1p(-std::pow(fpp, 0.125))));
+  }
+
+  void Insert(const std::vector<uint64_t>& hashes) {
+    if (filter_ != nullptr) {
+      for (uint64_t hash : hashes) {
+        filter_->InsertHash(hash);
+      }
+      return;
+    }
+    hashes_.insert(hashes_.end(), hashes.begin(), hashes.end());
+    if (hashes_.size() >= 2 * max_ndv_) {
+      Deduplicate();
+      if (hashes_.size() > max_ndv_) {
+        filter_ = MakeFilter(max_bytes_);
+      }
+    }
+  }
+
+  std::unique_ptr<::parquet::BlockSplitBloomFilter> Finish() {
+    if (filter_ == nullptr) {
+      Deduplicate();
+      const auto ndv = static_cast<uint32_t>(std::clamp<size_t>(
+          hashes_.size(), 1, std::numeric_limits<uint32_t>::max()));
+      filter_ = MakeFilter(std::min(
+          ::parquet::BlockSplitBloomFilter::OptimalNumOfBytes(ndv, fpp_), max_bytes_));
+    }
+    return std::move(filter_);
+  }
+
+ private:
+  void Deduplicate() {
+    std::ranges::sort(hashes_);
+    hashes_.erase(std::ranges::unique(hashes_).begin(), hashes_.end());
+  }
+
+  /// \brief Makes a filter of the hashes collected so far.
+  std::unique_ptr<::parquet::BlockSplitBloomFilter> MakeFilter(uint32_t num_bytes) {
+    auto filter = std::make_unique<::parquet::BlockSplitBloomFilter>();
+    filter->Init(num_bytes);
+    for (uint64_t hash : hashes_) {
+      filter->InsertHash(hash);
+    }
+    hashes_ = {};
+    return filter;
+  }
+
+  double fpp_;
+  uint32_t max_bytes_;
+  size_t max_ndv_;
+  // Hashes of the values, until the filter is made.
+  std::vector<uint64_t> hashes_;
+  std::unique_ptr<::parquet::BlockSplitBloomFilter> filter_;
+};
+
+}  // namespace
+
+Result<std::string> AddBloomFilterLocations(std::string_view file_metadata,
+                                            const BloomFilterLocations& locations) {
+  return FooterTranscoder(file_metadata, locations).Transcode();
+}
+
+class BloomFilterWriter::Impl {
+ public:
+  Impl(std::shared_ptr<::arrow::io::OutputStream> sink, int64_t position,
+       std::shared_ptr<::parquet::SchemaDescriptor> schema,
+       std::vector<BloomFilterColumn> columns, uint32_t max_bytes)
+      : sink_(sink),
+        stream_(std::make_shared<HoldingOutputStream>(std::move(sink), position)),
+        schema_(std::move(schema)),
+        columns_(std::move(columns)),
+        max_bytes_(max_bytes) {}
+
+  std::shared_ptr<::arrow::io::OutputStream> stream() const { return stream_; }
+
+  Status Update(const ::arrow::RecordBatch& batch) {
+    leaves_.clear();
+    for (const auto& column : batch.columns()) {
+      CollectLeaves(column, &leaves_);
+    }
+    if (std::cmp_not_equal(leaves_.size(), schema_->num_columns())) {
+      return InvalidArrowData("Batch has {} leaf columns, expected {}", leaves_.size(),
+                              schema_->num_columns());
+    }
+    if (builders_.empty()) {
+      for (const auto& column : columns_) {
+        builders_.emplace_back(column.fpp, max_bytes_);
+      }
+    }
+    for (size_t i = 0; i < columns_.size(); ++i) {
+      const int column_index = columns_[i].column_index;
+      hashes_.clear();
+      ICEBERG_RETURN_UNEXPECTED(HashValues(*leaves_[column_index],
+                                           *schema_->Column(column_index), hasher_,
+                                           &hashes_));
+      builders_[i].Insert(hashes_);
+    }
+    return {};
+  }
+
+  void FinishRowGroup() {
+    if (builders_.empty()) {
+      return;
+    }
+    auto& filters = filters_.emplace_back();
+    for (auto& builder : builders_) {
+      filters.push_back(builder.Finish());
+    }
+    builders_.clear();
+  }
+
+  void HoldFooter() { stream_->Hold(); }
+
+  Status Finish() {
+    FinishRowGroup();
+    const std::string held = stream_->Release();
+    const std::string_view tail(held);
+    if (tail.size() < 8 || !tail.ends_with(kParquetMagic)) {
+      return Invalid("Parquet file writer did not write a footer");
+    }
+    const auto* length_bytes =
+        reinterpret_cast<const uint8_t*>(tail.data()) + tail.size() - 8;
+    const uint32_t metadata_length = length_bytes[0] | (length_bytes[1] << 8) |
+                                     (length_bytes[2] << 16) |
+                                     (static_cast<uint32_t>(length_bytes[3]) << 24);
+    if (metadata_length > tail.size() - 8) {
+      return Invalid("Parquet footer was not written in one piece");
+    }
+    // The bytes before the footer, such as the page index, stay where they were written.
+    const size_t metadata_start = tail.size() - 8 - metadata_length;
+    ICEBERG_ARROW_RETURN_NOT_OK(
+        sink_->Write(tail.data(), static_cast<int64_t>(metadata_start)));
+
+    BloomFilterLocations locations(filters_.size());
+    for (size_t row_group = 0; row_group < filters_.size(); ++row_group) {
+      locations[row_group].resize(schema_->num_columns());
+      for (size_t i = 0; i < columns_.size(); ++i) {
+        ICEBERG_ARROW_ASSIGN_OR_RETURN(auto offset, sink_->Tell());
+        try {
+          filters_[row_group][i]->WriteTo(sink_.get());
+        } catch (const ::parquet::ParquetException& e) {
+          return IOError("Failed to write bloom filter of column {} in row group {}: {}",
+                         columns_[i].column_index, row_group, e.what());
+        }
+        ICEBERG_ARROW_ASSIGN_OR_RETURN(auto end, sink_->Tell());
+        locations[row_group][columns_[i].column_index] = BloomFilterLocation{
+            .offset = offset, .length = static_cast<int32_t>(end - offset)};
+      }
+    }
+    filters_.clear();
+
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto metadata,
+        AddBloomFilterLocations(tail.substr(metadata_start, metadata_length), locations));
+    const auto length = static_cast<uint32_t>(metadata.size());
+    const std::array<char, 4> length_le = {
+        static_cast<char>(length & 0xff), static_cast<char>((length >> 8) & 0xff),
+        static_cast<char>((length >> 16) & 0xff), static_cast<char>(length >> 24)};
+    ICEBERG_ARROW_RETURN_NOT_OK(
+        sink_->Write(metadata.data(), static_cast<int64_t>(metadata.size())));
+    ICEBERG_ARROW_RETURN_NOT_OK(sink_->Write(length_le.data(), length_le.size()));
+    ICEBERG_ARROW_RETURN_NOT_OK(sink_->Write(kParquetMagic.data(), kParquetMagic.size()));
+    return {};
+  }
+
+ private:
+  std::shared_ptr<::arrow::io::OutputStream> sink_;
+  std::shared_ptr<HoldingOutputStream> stream_;
+  std::shared_ptr<::parquet::SchemaDescriptor> schema_;
+  std::vector<BloomFilterColumn> columns_;
+  uint32_t max_bytes_;
+  ::parquet::XxHasher hasher_;
+  // Builders of the filters of the current row group, empty before its first batch.
+  std::vector<BloomFilterBuilder> builders_;
+  // Filters of the finished row groups, by row group and in the order of columns_.
+  std::vector<std::vector<std::unique_ptr<::parquet::BlockSplitBloomFilter>>> filters_;
+  // Buffers reused across batches.
+  std::vector<std::shared_ptr<::arrow::Array>> leaves_;
+  std::vector<uint64_t> hashes_;
+};
+
+BloomFilterWriter::BloomFilterWriter(std::unique_ptr<Impl> impl)
+    : impl_(std::move(impl)) {}
+
+BloomFilterWriter::~BloomFilterWriter() = default;
+
+Result<std::unique_ptr<BloomFilterWriter>> BloomFilterWriter::Make(
+    std::shared_ptr<::arrow::io::OutputStream> sink,
+    std::shared_ptr<::parquet::SchemaDescriptor> schema,
+    const std::vector<BloomFilterColumn>& columns, int64_t max_bytes) {
+  std::vector<BloomFilterColumn> hashed_columns;
+  for (const auto& column : columns) {
+    if (column.column_index < 0 || column.column_index >= schema->num_columns()) {
+      return InvalidArgument("Invalid Parquet column index {}", column.column_index);
+    }
+    if (schema->Column(column.column_index)->physical_type() !=
+        ::parquet::Type::BOOLEAN) {
+      hashed_columns.push_back(column);
+    }
+  }
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(auto position, sink->Tell());
+  // Filters are a power of two bytes, at most the maximum size.
+  const auto num_bytes = std::bit_floor(static_cast<uint32_t>(std::clamp<int64_t>(
+      max_bytes, ::parquet::BlockSplitBloomFilter::kMinimumBloomFilterBytes,
+      ::parquet::BlockSplitBloomFilter::kMaximumBloomFilterBytes)));
+  return std::unique_ptr<BloomFilterWriter>(new BloomFilterWriter(std::make_unique<Impl>(
+      std::move(sink), position, std::move(schema), std::move(hashed_columns),
+      num_bytes)));
+}
+
+std::shared_ptr<::arrow::io::OutputStream> BloomFilterWriter::stream() const {
+  return impl_->stream();
+}
+
+Status BloomFilterWriter::Update(const ::arrow::RecordBatch& batch) {
+  return impl_->Update(batch);
+}
+
+void BloomFilterWriter::FinishRowGroup() { impl_->FinishRowGroup(); }
+
+void BloomFilterWriter::HoldFooter() { impl_->HoldFooter(); }
+
+Status BloomFilterWriter::Finish() { return impl_->Finish(); }
+
+}  // namespace iceberg::parquet
@@ -0,0 +1,108 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <arrow/io/interfaces.h>
+#include <arrow/record_batch.h>
+#include <parquet/schema.h>
+
+#include "iceberg/result.h"
+
+namespace iceberg::parquet {
+
+/// \brief A leaf column of a Parquet file that has a bloom filter.
+struct BloomFilterColumn {
+  /// \brief The index of the leaf column in the Parquet schema.
+  int column_index;
+  /// \brief The false positive probability of the filter.
+  double fpp;
+};
+
+/// \brief The location of a bloom filter in a Parquet file.
+struct BloomFilterLocation {
+  int64_t offset;
+  int32_t length;
+};
+
+/// \brief Adds the locations of bloom filters to the column chunks of a Parquet footer.
+///
+/// \param file_metadata The FileMetaData of the footer, in the Thrift compact protocol.
+/// \param locations The location of the bloom filter of each column chunk, by row group
+/// and column index, or std::nullopt for column chunks without one.
+/// \return The FileMetaData with bloom_filter_offset and bloom_filter_length set.
+Result<std::string> AddBloomFilterLocations(
+    std::string_view file_metadata,
+    const std::vector<std::vector<std::optional<BloomFilterLocation>>>& locations);
+
+/// \brief Writes split-block bloom filters of Parquet leaf columns into a Parquet file.
+///
+/// Parquet C++ writes bloom filters only since Arrow 22, so the filters are built from
+/// the batches written to each row group, and spliced into the file when it is closed.
+/// The Parquet file writer writes to stream(), which holds back the footer that the
+/// writer writes last; Finish() writes the filters in its place, followed by the footer
+/// with the locations of the filters added to its column chunks.
+class BloomFilterWriter {
+ public:
+  ~BloomFilterWriter();
+
+  /// \brief Creates a writer of the bloom filters of a Parquet file.
+  ///
+  /// \param sink The stream that the Parquet file is written to.
+  /// \param schema The schema of the Parquet file.
+  /// \param columns The leaf columns with bloom filters. Boolean columns are ignored,
+  /// since Parquet does not hash booleans.
+  /// \param max_bytes The maximum size in bytes of a bloom filter.
+  static Result<std::unique_ptr<BloomFilterWriter>> Make(
+      std::shared_ptr<::arrow::io::OutputStream> sink,
+      std::shared_ptr<::parquet::SchemaDescriptor> schema,
+      const std::vector<BloomFilterColumn>& columns, int64_t max_bytes);
+
+  /// \brief The stream for the Parquet file writer to write to.
+  std::shared_ptr<::arrow::io::OutputStream> stream() const;
+
+  /// \brief Adds the values of a batch written to the current row group to its filters.
+  Status Update(const ::arrow::RecordBatch& batch);
+
+  /// \brief Finishes the filters of the current row group, before the file writer
+  /// starts a new one.
+  void FinishRowGroup();
+
+  /// \brief Holds back the footer, before the file writer is closed.
+  void HoldFooter();
+
+  /// \brief Writes the filters and the footer, after the file writer is closed.
+  Status Finish();
+
+ private:
+  class Impl;
+
+  explicit BloomFilterWriter(std::unique_ptr<Impl> impl);
+
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace iceberg::parquet
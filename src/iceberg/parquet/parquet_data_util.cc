@@ -17,19 +17,29 @@
  * under the License.
  */
 
+#include <algorithm>
+#include <limits>
+#include <span>
+
 #include <arrow/array.h>
 #include <arrow/array/builder_primitive.h>
+#include <arrow/buffer.h>
+#include <arrow/builder.h>
 #include <arrow/compute/api.h>
+#include <arrow/extension_type.h>
 #include <arrow/record_batch.h>
 #include <arrow/type.h>
 
+#include "iceberg/arrow/arrow_metadata_columns_internal.h"
 #include "iceberg/arrow/arrow_status_internal.h"
 #include "iceberg/parquet/parquet_data_util_internal.h"
+#include "iceberg/parquet/parquet_schema_util_internal.h"
 #include "iceberg/schema.h"
 #include "iceberg/schema_util.h"
 #include "iceberg/type.h"
 #include "iceberg/util/checked_cast.h"
 #include "iceberg/util/macros.h"
+#include "iceberg/util/variant_internal.h"
 
 namespace iceberg::parquet {
 
@@ -52,6 +62,90 @@ Result<std::shared_ptr<::arrow::Array>> MakeNullArray(
   return array;
 }
 
+constexpr int64_t kMicrosPerDay = 86400000000;
+
+/// \brief Converts the values of a primitive array to `output_arrow_type` in a single
+/// pass, sharing the validity bitmap of the array.
+///
+/// Null slots are converted as well, so `convert` must accept any value.
+template <typename From, typename To, typename Convert>
+Result<std::shared_ptr<::arrow::Array>> ConvertPrimitiveArray(
+    const ::arrow::ArrayData& data,
+    const std::shared_ptr<::arrow::DataType>& output_arrow_type,
+    ::arrow::MemoryPool* pool, Convert convert) {
+  // Keep the offset within the first byte of the bitmap, so that the bitmap is shared
+  // without copying its bits.
+  const int64_t offset = data.offset % 8;
+  std::shared_ptr<::arrow::Buffer> validity;
+  if (data.buffers[0] != nullptr) {
+    validity = ::arrow::SliceBuffer(data.buffers[0], data.offset / 8);
+  }
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(
+      auto values,
+      ::arrow::AllocateBuffer((offset + data.length) * static_cast<int64_t>(sizeof(To)),
+                              pool));
+  const From* in = data.GetValues<From>(1);
+  To* out = reinterpret_cast<To*>(values->mutable_data()) + offset;
+  for (int64_t i = 0; i < data.length; ++i) {
+    out[i] = convert(in[i]);
+  }
+  return ::arrow::MakeArray(::arrow::ArrayData::Make(
+      output_arrow_type, data.length, {std::move(validity), std::move(values)},
+      data.null_count, offset));
+}
+
+/// \brief Promotes a primitive array to the type of an evolved column without the
+/// generic cast kernels, or returns null if the promotion has no dedicated kernel.
+Result<std::shared_ptr<::arrow::Array>> PromotePrimitiveArray(
+    const std::shared_ptr<::arrow::Array>& array,
+    const std::shared_ptr<::arrow::DataType>& output_arrow_type,
+    ::arrow::MemoryPool* pool) {
+  const auto& data = *array->data();
+  switch (output_arrow_type->id()) {
+    case ::arrow::Type::INT64:
+      if (array->type_id() == ::arrow::Type::INT32) {
+        return ConvertPrimitiveArray<int32_t, int64_t>(
+            data, output_arrow_type, pool,
+            [](int32_t value) { return static_cast<int64_t>(value); });
+      }
+      break;
+    case ::arrow::Type::DOUBLE:
+      if (array->type_id() == ::arrow::Type::FLOAT) {
+        return ConvertPrimitiveArray<float, double>(
+            data, output_arrow_type, pool,
+            [](float value) { return static_cast<double>(value); });
+      }
+      break;
+    case ::arrow::Type::DECIMAL128:
+      if (array->type_id() == ::arrow::Type::DECIMAL128) {
+        // Only the precision is widened, the unscaled values are unchanged.
+        auto promoted = data.Copy();
+        promoted->type = output_arrow_type;
+        return ::arrow::MakeArray(std::move(promoted));
+      }
+      break;
+    case ::arrow::Type::TIMESTAMP:
+      if (array->type_id() == ::arrow::Type::DATE32 &&
+          internal::checked_cast<const ::arrow::TimestampType&>(*output_arrow_type)
+                  .unit() == ::arrow::TimeUnit::MICRO) {
+        const auto* days = data.GetValues<int32_t>(1);
+        const auto [min, max] = std::minmax_element(days, days + data.length);
+        constexpr int64_t kMaxDays = std::numeric_limits<int64_t>::max() / kMicrosPerDay;
+        if (data.length > 0 && (*min < -kMaxDays || *max > kMaxDays)) {
+          // Leave the values out of the timestamp range to the checked cast.
+          break;
+        }
+        return ConvertPrimitiveArray<int32_t, int64_t>(
+            data, output_arrow_type, pool,
+            [](int32_t value) { return value * kMicrosPerDay; });
+      }
+      break;
+    default:
+      break;
+  }
+  return nullptr;
+}
+
 Result<std::shared_ptr<::arrow::Array>> ProjectPrimitiveArray(
     const std::shared_ptr<::arrow::Array>& array,
     const std::shared_ptr<::arrow::DataType>& output_arrow_type,
@@ -59,15 +153,180 @@ Result<std::shared_ptr<::arrow::Array>> ProjectPrimitiveArray(
   if (array->type()->Equals(output_arrow_type)) {
     return array;
   }
+  // Arrays of the storage type of an extension type, such as the 16-byte binary of
+  // arrow.uuid, are wrapped without copying their buffers.
+  if (output_arrow_type->id() == ::arrow::Type::EXTENSION &&
+      internal::checked_cast<const ::arrow::ExtensionType&>(*output_arrow_type)
+          .storage_type()
+          ->Equals(array->type())) {
+    return ::arrow::ExtensionType::WrapArray(output_arrow_type, array);
+  }
+
+  ICEBERG_ASSIGN_OR_RAISE(auto promoted,
+                          PromotePrimitiveArray(array, output_arrow_type, pool));
+  if (promoted != nullptr) {
+    return promoted;
+  }
 
-  // Use Arrow compute cast function for type conversions.
+  // Use Arrow compute cast function for the other type conversions.
   // Note: We don't check the schema evolution rule again because projecting schemas
   // has checked this.
-  ICEBERG_ARROW_ASSIGN_OR_RETURN(auto cast_result,
-                                 ::arrow::compute::Cast(array, output_arrow_type));
+  ::arrow::compute::ExecContext context(pool);
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(
+      auto cast_result,
+      ::arrow::compute::Cast(array, output_arrow_type,
+                             ::arrow::compute::CastOptions::Safe(), &context));
   return cast_result.make_array();
 }
 
+/// \brief Returns the field of a struct array with a name, or nullptr if the array is
+/// not a struct or has no such field.
+std::shared_ptr<::arrow::Array> GetFieldByName(
+    const std::shared_ptr<::arrow::Array>& array, std::string_view name) {
+  if (array == nullptr || array->type_id() != ::arrow::Type::STRUCT) {
+    return nullptr;
+  }
+  return internal::checked_cast<const ::arrow::StructArray&>(*array).GetFieldByName(
+      std::string(name));
+}
+
+/// \brief Returns the struct array of the group of a variant column, which is read as
+/// an extension array when the group is annotated as a variant.
+std::shared_ptr<::arrow::Array> VariantGroup(
+    const std::shared_ptr<::arrow::Array>& array) {
+  if (array->type_id() == ::arrow::Type::EXTENSION) {
+    return internal::checked_cast<const ::arrow::ExtensionArray&>(*array).storage();
+  }
+  return array;
+}
+
+/// \brief Returns the binary field of the group of a variant column with a name.
+Result<std::shared_ptr<::arrow::BinaryArray>> GetVariantBinary(
+    const std::shared_ptr<::arrow::Array>& group, std::string_view name) {
+  auto array = GetFieldByName(group, name);
+  if (array == nullptr || array->type_id() != ::arrow::Type::BINARY) {
+    return InvalidSchema("Expected a binary {} field in a variant column", name);
+  }
+  return internal::checked_pointer_cast<::arrow::BinaryArray>(std::move(array));
+}
+
+/// \brief Projects the group of a variant column on its metadata and value arrays.
+Result<std::shared_ptr<::arrow::Array>> ProjectVariantArray(
+    const std::shared_ptr<::arrow::Array>& variant_array,
+    const std::shared_ptr<::arrow::DataType>& output_arrow_type) {
+  auto array = VariantGroup(variant_array);
+  ICEBERG_ASSIGN_OR_RAISE(auto metadata, GetVariantBinary(array, kVariantMetadataName));
+  ICEBERG_ASSIGN_OR_RAISE(auto value, GetVariantBinary(array, kVariantValueName));
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(
+      auto output_array,
+      ::arrow::StructArray::Make({std::move(metadata), std::move(value)},
+                                 output_arrow_type->fields(), array->null_bitmap(),
+                                 array->null_count(), array->offset()));
+  return output_array;
+}
+
+/// \brief Reads the values of a path of a variant column from the arrays of its group.
+///
+/// The typed values of a shredded path are returned as is when the values on the path
+/// that are not shredded are all null. Otherwise, the rows without a typed value are
+/// decoded from the deepest value on the path that is not null.
+Result<std::shared_ptr<::arrow::Array>> ProjectVariantPathArray(
+    const std::shared_ptr<::arrow::Array>& variant_array,
+    const std::shared_ptr<::arrow::DataType>& output_arrow_type,
+    const std::shared_ptr<PrimitiveType>& type, const VariantPathAttributes& path,
+    ::arrow::MemoryPool* pool) {
+  auto array = VariantGroup(variant_array);
+  // The value arrays on the path, with the number of names of the path they are at.
+  std::vector<std::pair<std::shared_ptr<::arrow::BinaryArray>, size_t>> values;
+  std::shared_ptr<::arrow::Array> typed;
+  auto group = array;
+  for (size_t depth = 0; group != nullptr; ++depth) {
+    if (GetFieldByName(group, kVariantValueName) != nullptr) {
+      ICEBERG_ASSIGN_OR_RAISE(auto value, GetVariantBinary(group, kVariantValueName));
+      values.emplace_back(std::move(value), depth);
+    }
+    auto typed_value = GetFieldByName(group, kVariantTypedValueName);
+    if (depth == path.names.size()) {
+      if (path.typed_column.has_value()) {
+        typed = std::move(typed_value);
+      }
+      break;
+    }
+    group = GetFieldByName(typed_value, path.names[depth]);
+  }
+  if (path.typed_column.has_value() && typed == nullptr) {
+    return InvalidSchema("Missing the typed values of a shredded variant path");
+  }
+
+  std::shared_ptr<::arrow::Array> typed_array;
+  if (typed != nullptr) {
+    ICEBERG_ASSIGN_OR_RAISE(typed_array,
+                            ProjectPrimitiveArray(typed, output_arrow_type, pool));
+  }
+  const int64_t length = array->length();
+  if (std::ranges::all_of(values, [&](const auto& value) {
+        return value.first->null_count() == length;
+      })) {
+    if (typed_array != nullptr) {
+      return typed_array;
+    }
+    return MakeNullArray(output_arrow_type, length, pool);
+  }
+
+  ICEBERG_ASSIGN_OR_RAISE(auto metadata, GetVariantBinary(array, kVariantMetadataName));
+  auto storage_type = output_arrow_type;
+  if (storage_type->id() == ::arrow::Type::EXTENSION) {
+    storage_type =
+        internal::checked_cast<const ::arrow::ExtensionType&>(*storage_type)
+            .storage_type();
+  }
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(auto builder, ::arrow::MakeBuilder(storage_type, pool));
+  ICEBERG_ARROW_RETURN_NOT_OK(builder->Reserve(length));
+  const std::span<const std::string> names(path.names);
+  // Consecutive typed values are copied at once.
+  int64_t typed_begin = 0;
+  for (int64_t i = 0; i <= length; ++i) {
+    if (i < length && typed_array != nullptr && typed_array->IsValid(i)) {
+      continue;
+    }
+    if (typed_begin < i) {
+      ICEBERG_ARROW_RETURN_NOT_OK(builder->AppendArraySlice(
+          ::arrow::ArraySpan(*typed_array->data()), typed_begin, i - typed_begin));
+    }
+    typed_begin = i + 1;
+    if (i == length) {
+      break;
+    }
+
+    std::optional<Literal> literal;
+    for (auto it = values.rbegin(); it != values.rend(); ++it) {
+      const auto& [value, depth] = *it;
+      if (value->IsNull(i)) {
+        continue;
+      }
+      ICEBERG_ASSIGN_OR_RAISE(
+          auto field, FindVariantField(metadata->GetView(i), value->GetView(i),
+                                       names.subspan(depth)));
+      if (field.has_value()) {
+        ICEBERG_ASSIGN_OR_RAISE(literal, VariantToLiteral(field.value(), type));
+      }
+      break;
+    }
+    if (literal.has_value() && !literal->IsNull()) {
+      ICEBERG_ASSIGN_OR_RAISE(auto scalar,
+                              arrow::MakeScalar(literal.value(), storage_type));
+      ICEBERG_ARROW_RETURN_NOT_OK(builder->AppendScalar(*scalar));
+    } else {
+      ICEBERG_ARROW_RETURN_NOT_OK(builder->AppendNull());
+    }
+  }
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(auto output_array, builder->Finish());
+  if (storage_type != output_arrow_type) {
+    return ::arrow::ExtensionType::WrapArray(output_arrow_type, output_array);
+  }
+  return output_array;
+}
+
 Result<std::shared_ptr<::arrow::Array>> ProjectStructArray(
     const std::shared_ptr<::arrow::StructArray>& struct_array,
     const std::shared_ptr<::arrow::StructType>& output_struct_type,
@@ -86,6 +345,8 @@ Result<std::shared_ptr<::arrow::Array>> ProjectStructArray(
 
   std::vector<std::shared_ptr<::arrow::Array>> projected_arrays;
   projected_arrays.reserve(projections.size());
+  // Whether every field is the Parquet field at the same position, returned as is.
+  bool unchanged = projections.size() == static_cast<size_t>(struct_array->num_fields());
 
   for (size_t i = 0; i < projections.size(); ++i) {
     const auto& projected_field = struct_type.fields()[i];
@@ -102,22 +363,45 @@ Result<std::shared_ptr<::arrow::Array>> ProjectStructArray(
                                parquet_field_index, struct_array->num_fields());
       }
       const auto& parquet_array = struct_array->field(parquet_field_index);
-      if (projected_field.type()->is_nested()) {
+      if (const auto* path = dynamic_cast<const VariantPathAttributes*>(
+              field_projection.attributes.get())) {
+        ICEBERG_ASSIGN_OR_RAISE(
+            projected_array,
+            ProjectVariantPathArray(
+                parquet_array, output_arrow_type,
+                internal::checked_pointer_cast<PrimitiveType>(projected_field.type()),
+                *path, pool));
+      } else if (projected_field.type()->is_nested()) {
         const auto& nested_type =
             internal::checked_cast<const NestedType&>(*projected_field.type());
         ICEBERG_ASSIGN_OR_RAISE(
             projected_array,
             ProjectNestedArray(parquet_array, output_arrow_type, nested_type,
                                field_projection.children, pool));
+      } else if (projected_field.type()->type_id() == TypeId::kVariant) {
+        ICEBERG_ASSIGN_OR_RAISE(projected_array,
+                                ProjectVariantArray(parquet_array, output_arrow_type));
       } else {
         ICEBERG_ASSIGN_OR_RAISE(
             projected_array,
             ProjectPrimitiveArray(parquet_array, output_arrow_type, pool));
       }
-    } else if (field_projection.kind == FieldProjection::Kind::kNull) {
+      unchanged = unchanged && static_cast<size_t>(parquet_field_index) == i &&
+                  projected_array == parquet_array;
+    } else if (field_projection.kind == FieldProjection::Kind::kConstant ||
+               field_projection.kind == FieldProjection::Kind::kDefault) {
+      ICEBERG_ASSIGN_OR_RAISE(
+          projected_array,
+          arrow::MakeConstantArray(std::get<Literal>(field_projection.from),
+                                   output_arrow_type, struct_array->length(), pool));
+      unchanged = false;
+    } else if (field_projection.kind == FieldProjection::Kind::kNull ||
+               field_projection.kind == FieldProjection::Kind::kMetadata) {
+      // Metadata columns are placeholders generated by the reader afterwards.
       ICEBERG_ASSIGN_OR_RAISE(
           projected_array,
           MakeNullArray(output_arrow_type, struct_array->length(), pool));
+      unchanged = false;
     } else {
       return NotImplemented("Unsupported field projection kind: {}",
                             ToString(field_projection.kind));
@@ -126,6 +410,12 @@ Result<std::shared_ptr<::arrow::Array>> ProjectStructArray(
     projected_arrays.emplace_back(std::move(projected_array));
   }
 
+  if (unchanged && output_struct_type->Equals(*struct_array->type(),
+                                              /*check_metadata=*/false)) {
+    // All fields are reused as is, so is the struct array.
+    return struct_array;
+  }
+
   ICEBERG_ARROW_ASSIGN_OR_RETURN(
       auto output_array,
       ::arrow::StructArray::Make(projected_arrays, output_struct_type->fields(),
@@ -161,6 +451,11 @@ Result<std::shared_ptr<::arrow::Array>> ProjectListArray(
         ProjectPrimitiveArray(list_array->values(), output_element_type, pool));
   }
 
+  if (projected_values == list_array->values() &&
+      output_list_type->Equals(*list_array->type(), /*check_metadata=*/false)) {
+    return list_array;
+  }
+
   return std::make_shared<::arrow::ListArray>(
       output_list_type, list_array->length(), list_array->value_offsets(),
       std::move(projected_values), list_array->null_bitmap(), list_array->null_count(),
@@ -207,6 +502,11 @@ Result<std::shared_ptr<::arrow::Array>> ProjectMapArray(
         ProjectPrimitiveArray(map_array->items(), output_map_type->item_type(), pool));
   }
 
+  if (projected_keys == map_array->keys() && projected_items == map_array->items() &&
+      output_map_type->Equals(*map_array->type(), /*check_metadata=*/false)) {
+    return map_array;
+  }
+
   return std::make_shared<::arrow::MapArray>(
       output_map_type, map_array->length(), map_array->value_offsets(),
       std::move(projected_keys), std::move(projected_items), map_array->null_bitmap(),
@@ -260,8 +560,40 @@ Result<std::shared_ptr<::arrow::Array>> ProjectNestedArray(
   }
 }
 
+bool IsIdentityProjection(std::span<const FieldProjection> projections) {
+  for (size_t i = 0; i < projections.size(); ++i) {
+    const auto& projection = projections[i];
+    if (projection.kind != FieldProjection::Kind::kProjected) {
+      return false;
+    }
+    const auto* from = std::get_if<size_t>(&projection.from);
+    if (from == nullptr || *from != i || !IsIdentityProjection(projection.children)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace
 
+bool RequiresProjection(const ::arrow::Schema& batch_schema,
+                        const ::arrow::Schema& output_arrow_schema,
+                        const SchemaProjection& projection) {
+  const auto num_fields = static_cast<size_t>(output_arrow_schema.num_fields());
+  if (batch_schema.num_fields() != output_arrow_schema.num_fields() ||
+      projection.fields.size() != num_fields ||
+      !IsIdentityProjection(projection.fields)) {
+    return true;
+  }
+  for (int i = 0; i < output_arrow_schema.num_fields(); ++i) {
+    if (!batch_schema.field(i)->type()->Equals(*output_arrow_schema.field(i)->type(),
+                                               /*check_metadata=*/false)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 Result<std::shared_ptr<::arrow::RecordBatch>> ProjectRecordBatch(
     std::shared_ptr<::arrow::RecordBatch> record_batch,
     const std::shared_ptr<::arrow::Schema>& output_arrow_schema,
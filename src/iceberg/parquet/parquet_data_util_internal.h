@@ -25,6 +25,20 @@
 
 namespace iceberg::parquet {
 
+/// \brief Returns whether record batches read from a Parquet file must be converted
+/// with `ProjectRecordBatch` to match the projected Iceberg schema.
+///
+/// No conversion is required when every projected field is read at its own position
+/// with the Arrow type of the output schema, so the record batches read can be
+/// exported as is.
+///
+/// \param batch_schema The Arrow schema of the record batches read.
+/// \param output_arrow_schema The Arrow schema to convert to.
+/// \param projection The projection from projected Iceberg schema to the record batch.
+bool RequiresProjection(const ::arrow::Schema& batch_schema,
+                        const ::arrow::Schema& output_arrow_schema,
+                        const SchemaProjection& projection);
+
 /// \brief Convert record batch read from a Parquet file to projected Iceberg Schema.
 ///
 /// \param record_batch The record batch to convert.
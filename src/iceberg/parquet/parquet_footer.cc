@@ -0,0 +1,289 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <cmath>
+#include <compare>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <parquet/exception.h>
+#include <parquet/file_reader.h>
+#include <parquet/metadata.h>
+#include <parquet/schema.h>
+#include <parquet/statistics.h>
+
+#include "iceberg/arrow/arrow_fs_file_io_internal.h"
+#include "iceberg/arrow/arrow_status_internal.h"
+#include "iceberg/file_reader.h"
+#include "iceberg/name_mapping.h"
+#include "iceberg/parquet/parquet_register.h"
+#include "iceberg/parquet/parquet_schema_util_internal.h"
+#include "iceberg/schema.h"
+#include "iceberg/type.h"
+#include "iceberg/util/arrow_metrics_internal.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg::parquet {
+
+namespace {
+
+/// \brief Assigns field ids to the leaf columns of a Parquet schema without field ids
+/// from a name mapping, in the order of the columns.
+class NameMappingVisitor {
+ public:
+  explicit NameMappingVisitor(std::vector<std::optional<int32_t>>& ids) : ids_(ids) {}
+
+  /// \brief Visits the leaf columns of a node whose field has the given id.
+  ///
+  /// \param mapping The mapping of the nested fields of the field, or null
+  void Visit(const ::parquet::schema::Node& node, std::optional<int32_t> id,
+             const MappedFields* mapping) {
+    if (node.is_primitive()) {
+      ids_.push_back(id);
+      return;
+    }
+    const auto& group = internal::checked_cast<const ::parquet::schema::GroupNode&>(node);
+    const auto& logical_type = group.logical_type();
+    const bool is_list = (logical_type != nullptr && logical_type->is_list()) ||
+                         group.converted_type() == ::parquet::ConvertedType::LIST;
+    const bool is_map = (logical_type != nullptr && logical_type->is_map()) ||
+                        group.converted_type() == ::parquet::ConvertedType::MAP ||
+                        group.converted_type() == ::parquet::ConvertedType::MAP_KEY_VALUE;
+    if ((is_list || is_map) && group.field_count() == 1 &&
+        group.field(0)->is_repeated()) {
+      // The repeated group between a list or a map and its elements has no field.
+      const auto& repeated = *group.field(0);
+      const auto* repeated_group =
+          repeated.is_group()
+              ? &internal::checked_cast<const ::parquet::schema::GroupNode&>(repeated)
+              : nullptr;
+      if (is_map && repeated_group != nullptr && repeated_group->field_count() == 2) {
+        VisitField(*repeated_group->field(0), "key", mapping);
+        VisitField(*repeated_group->field(1), "value", mapping);
+        return;
+      }
+      if (is_list) {
+        // Lists written by older writers may repeat their elements directly.
+        const bool has_element_group =
+            repeated_group != nullptr && repeated_group->field_count() == 1;
+        VisitField(has_element_group ? *repeated_group->field(0) : repeated, "element",
+                   mapping);
+        return;
+      }
+    }
+    for (int i = 0; i < group.field_count(); ++i) {
+      VisitField(*group.field(i), group.field(i)->name(), mapping);
+    }
+  }
+
+ private:
+  void VisitField(const ::parquet::schema::Node& node, std::string_view name,
+                  const MappedFields* mapping) {
+    std::optional<int32_t> id;
+    const MappedFields* nested = nullptr;
+    if (mapping != nullptr) {
+      id = mapping->Id(name);
+      if (id.has_value()) {
+        if (auto field = mapping->Field(*id); field.has_value()) {
+          nested = field->get().nested_mapping.get();
+        }
+      }
+    }
+    Visit(node, id, nested);
+  }
+
+  std::vector<std::optional<int32_t>>& ids_;
+};
+
+/// \brief Returns the field ids of the leaf columns of a Parquet file, from the file
+/// or from the name mapping if the file has no field ids.
+std::vector<std::optional<int32_t>> ColumnFieldIds(
+    const ::parquet::SchemaDescriptor& schema, const NameMapping* name_mapping) {
+  std::vector<std::optional<int32_t>> ids;
+  ids.reserve(schema.num_columns());
+  if (HasFieldIds(schema.schema_root())) {
+    for (int i = 0; i < schema.num_columns(); ++i) {
+      const int32_t field_id = schema.Column(i)->schema_node()->field_id();
+      ids.push_back(field_id >= 0 ? std::optional<int32_t>(field_id) : std::nullopt);
+    }
+    return ids;
+  }
+  NameMappingVisitor visitor(ids);
+  visitor.Visit(*schema.group_node(), std::nullopt,
+                name_mapping != nullptr ? &name_mapping->AsMappedFields() : nullptr);
+  return ids;
+}
+
+/// \brief Converts a plain encoded Parquet min/max value to an Iceberg value of the
+/// column, or std::nullopt if it is not a usable bound.
+Result<std::optional<Literal>> ToLiteral(std::string_view encoded,
+                                         const std::shared_ptr<PrimitiveType>& file_type,
+                                         const std::shared_ptr<PrimitiveType>& type) {
+  std::span<const uint8_t> bytes(reinterpret_cast<const uint8_t*>(encoded.data()),
+                                 encoded.size());
+  ICEBERG_ASSIGN_OR_RAISE(auto literal, Literal::Deserialize(bytes, file_type));
+  if (file_type->type_id() != type->type_id()) {
+    // The column type has been promoted since the file was written.
+    ICEBERG_ASSIGN_OR_RAISE(literal, literal.CastTo(type));
+  }
+  // Older writers may store NaN as the min or max of floating point columns.
+  if (const auto* value = std::get_if<float>(&literal.value());
+      value != nullptr && std::isnan(*value)) {
+    return std::nullopt;
+  }
+  if (const auto* value = std::get_if<double>(&literal.value());
+      value != nullptr && std::isnan(*value)) {
+    return std::nullopt;
+  }
+  return literal;
+}
+
+/// \brief Computes the metrics of a Parquet file from the statistics of its column
+/// chunks.
+///
+/// The counts of a column are only set when every column chunk has them, and its
+/// bounds when every column chunk with non-null values has a min and a max. Bounds are
+/// not set for the columns in lists and maps, as in the metrics of written files, nor
+/// NaN counts, which Parquet statistics do not have.
+Result<Metrics> FooterMetrics(const ::parquet::FileMetaData& metadata,
+                              const FooterOptions& options) {
+  Metrics metrics;
+  metrics.row_count = metadata.num_rows();
+  const auto& file_schema = *metadata.schema();
+  const auto field_ids = ColumnFieldIds(file_schema, options.name_mapping.get());
+  for (int column = 0; column < file_schema.num_columns(); ++column) {
+    if (!field_ids[column].has_value()) {
+      continue;
+    }
+    const int32_t field_id = *field_ids[column];
+    ICEBERG_ASSIGN_OR_RAISE(auto field, options.schema->FindFieldById(field_id));
+    if (!field.has_value() || !field->get().type()->is_primitive()) {
+      continue;
+    }
+    const MetricsMode mode = options.metrics_config.ColumnMode(field_id);
+    if (mode.kind == MetricsMode::Kind::kNone) {
+      continue;
+    }
+
+    const auto& descr = *file_schema.Column(column);
+    auto type = internal::checked_pointer_cast<PrimitiveType>(field->get().type());
+    auto file_type = descr.max_repetition_level() == 0 &&
+                             (mode.kind == MetricsMode::Kind::kTruncate ||
+                              mode.kind == MetricsMode::Kind::kFull)
+                         ? StatisticsType(descr, type->type_id())
+                         : nullptr;
+    int64_t column_size = 0;
+    int64_t value_count = 0;
+    int64_t null_count = 0;
+    bool has_null_count = true;
+    bool has_bounds = file_type != nullptr;
+    std::optional<Literal> lower_bound;
+    std::optional<Literal> upper_bound;
+    for (int row_group = 0; row_group < metadata.num_row_groups(); ++row_group) {
+      auto chunk = metadata.RowGroup(row_group)->ColumnChunk(column);
+      column_size += chunk->total_compressed_size();
+      value_count += chunk->num_values();
+      auto statistics = chunk->is_stats_set() ? chunk->statistics() : nullptr;
+      const bool chunk_has_null_count =
+          statistics != nullptr && statistics->HasNullCount();
+      if (chunk_has_null_count) {
+        null_count += statistics->null_count();
+      } else {
+        has_null_count = false;
+      }
+      if (!has_bounds) {
+        continue;
+      }
+      if (statistics == nullptr || !statistics->HasMinMax()) {
+        // A chunk of nulls has no min and max, and does not widen the bounds.
+        has_bounds =
+            chunk_has_null_count && statistics->null_count() == chunk->num_values();
+        continue;
+      }
+      ICEBERG_ASSIGN_OR_RAISE(auto min,
+                              ToLiteral(statistics->EncodeMin(), file_type, type));
+      ICEBERG_ASSIGN_OR_RAISE(auto max,
+                              ToLiteral(statistics->EncodeMax(), file_type, type));
+      if (!min.has_value() || !max.has_value()) {
+        has_bounds = false;
+        continue;
+      }
+      if (!lower_bound.has_value() || *min < *lower_bound) {
+        lower_bound = std::move(min);
+      }
+      if (!upper_bound.has_value() || *max > *upper_bound) {
+        upper_bound = std::move(max);
+      }
+    }
+
+    metrics.column_sizes[field_id] = column_size;
+    metrics.value_counts[field_id] = value_count;
+    if (has_null_count) {
+      metrics.null_value_counts[field_id] = null_count;
+    }
+    if (!has_bounds || !lower_bound.has_value()) {
+      continue;
+    }
+    if (mode.kind == MetricsMode::Kind::kTruncate) {
+      metrics.lower_bounds.emplace(field_id,
+                                   TruncateLowerBound(*lower_bound, mode.length));
+      if (auto upper = TruncateUpperBound(*upper_bound, mode.length)) {
+        metrics.upper_bounds.emplace(field_id, std::move(*upper));
+      }
+    } else {
+      metrics.lower_bounds.emplace(field_id, std::move(*lower_bound));
+      metrics.upper_bounds.emplace(field_id, std::move(*upper_bound));
+    }
+  }
+  return metrics;
+}
+
+Result<FileFooter> ReadFooter(const FooterOptions& options) {
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto input, arrow::OpenArrowInputFile(options.io, options.path, options.length));
+  FileFooter footer;
+  ICEBERG_ARROW_ASSIGN_OR_RETURN(footer.length, input->GetSize());
+  std::shared_ptr<::parquet::FileMetaData> metadata;
+  try {
+    metadata = ::parquet::ReadMetaData(input);
+  } catch (const ::parquet::ParquetException& e) {
+    return IOError("Failed to read the footer of Parquet file {}: {}", options.path,
+                   e.what());
+  }
+  ICEBERG_ASSIGN_OR_RAISE(footer.metrics, FooterMetrics(*metadata, options));
+  footer.split_offsets.reserve(metadata->num_row_groups());
+  for (int row_group = 0; row_group < metadata->num_row_groups(); ++row_group) {
+    footer.split_offsets.push_back(metadata->RowGroup(row_group)->file_offset());
+  }
+  return footer;
+}
+
+}  // namespace
+
+void RegisterFooterReader() {
+  static FooterReaderRegistry parquet_footer_reader_register(FileFormatType::kParquet,
+                                                             ReadFooter);
+}
+
+}  // namespace iceberg::parquet
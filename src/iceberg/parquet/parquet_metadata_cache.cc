@@ -0,0 +1,129 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/parquet/parquet_metadata_cache.h"
+
+#include <utility>
+
+#include <parquet/metadata.h>
+
+namespace iceberg::parquet {
+
+namespace {
+
+/// \brief Approximate memory held by the decoded metadata of a column chunk, beyond
+/// its serialized size.
+constexpr int64_t kColumnChunkOverhead = 256;
+
+/// \brief Estimates the memory held by a parsed footer.
+int64_t EstimateSize(const ::parquet::FileMetaData& metadata) {
+  return static_cast<int64_t>(metadata.size()) +
+         static_cast<int64_t>(metadata.num_row_groups()) * metadata.num_columns() *
+             kColumnChunkOverhead;
+}
+
+std::mutex global_cache_mutex;
+std::shared_ptr<ParquetMetadataCache> global_cache;
+
+}  // namespace
+
+ParquetMetadataCache::ParquetMetadataCache(int64_t capacity_bytes)
+    : capacity_bytes_(capacity_bytes) {}
+
+Result<std::shared_ptr<ParquetMetadataCache>> ParquetMetadataCache::Make(
+    int64_t capacity_bytes) {
+  if (capacity_bytes <= 0) {
+    return InvalidArgument("Parquet metadata cache capacity must be positive, got {}",
+                           capacity_bytes);
+  }
+  return std::shared_ptr<ParquetMetadataCache>(new ParquetMetadataCache(capacity_bytes));
+}
+
+std::shared_ptr<ParquetMetadataCache> ParquetMetadataCache::Global() {
+  std::lock_guard lock(global_cache_mutex);
+  return global_cache;
+}
+
+void ParquetMetadataCache::SetGlobal(std::shared_ptr<ParquetMetadataCache> cache) {
+  std::lock_guard lock(global_cache_mutex);
+  global_cache = std::move(cache);
+}
+
+std::shared_ptr<::parquet::FileMetaData> ParquetMetadataCache::Get(
+    std::string_view path) {
+  std::lock_guard lock(mutex_);
+  auto it = index_.find(path);
+  if (it == index_.end()) {
+    ++stats_.misses;
+    return nullptr;
+  }
+  ++stats_.hits;
+  items_.splice(items_.begin(), items_, it->second);
+  return it->second->metadata;
+}
+
+void ParquetMetadataCache::Put(std::string_view path,
+                               std::shared_ptr<::parquet::FileMetaData> metadata) {
+  if (metadata == nullptr) {
+    return;
+  }
+  const int64_t size_bytes = EstimateSize(*metadata);
+  std::lock_guard lock(mutex_);
+  if (auto it = index_.find(path); it != index_.end()) {
+    auto item = it->second;
+    index_.erase(it);
+    stats_.size_bytes -= item->size_bytes;
+    --stats_.file_count;
+    items_.erase(item);
+  }
+  if (size_bytes > capacity_bytes_) {
+    return;
+  }
+
+  while (stats_.size_bytes + size_bytes > capacity_bytes_) {
+    const auto& lru = items_.back();
+    stats_.size_bytes -= lru.size_bytes;
+    --stats_.file_count;
+    ++stats_.evictions;
+    index_.erase(lru.path);
+    items_.pop_back();
+  }
+
+  items_.push_front(Item{.path = std::string(path),
+                         .metadata = std::move(metadata),
+                         .size_bytes = size_bytes});
+  index_.emplace(items_.front().path, items_.begin());
+  stats_.size_bytes += size_bytes;
+  ++stats_.file_count;
+}
+
+void ParquetMetadataCache::Clear() {
+  std::lock_guard lock(mutex_);
+  index_.clear();
+  items_.clear();
+  stats_.file_count = 0;
+  stats_.size_bytes = 0;
+}
+
+ParquetMetadataCache::Stats ParquetMetadataCache::stats() const {
+  std::lock_guard lock(mutex_);
+  return stats_;
+}
+
+}  // namespace iceberg::parquet
@@ -0,0 +1,113 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/parquet/parquet_metadata_cache.h
+/// Cache of the parsed footers of Parquet files.
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "iceberg/iceberg_bundle_export.h"
+#include "iceberg/result.h"
+
+namespace parquet {
+class FileMetaData;
+}  // namespace parquet
+
+namespace iceberg::parquet {
+
+/// \brief A thread-safe LRU cache of the parsed footers of Parquet files.
+///
+/// Opening a Parquet file reads its footer, which takes a request to the storage and
+/// a Thrift decode. Data files are immutable once written, so the footer of a path can
+/// be shared by every reader of the file, e.g. the tasks of several splits of a file or
+/// repeated scans of a table. The cache holds up to a configured number of bytes,
+/// estimated from the size of the footers, and evicts the least recently used footers
+/// beyond that. Footers larger than the capacity are not cached.
+///
+/// When a process-wide cache is installed with SetGlobal(), ParquetReader::Open looks
+/// up the footer of the file in it before reading it from the file, and caches the
+/// footers it reads.
+class ICEBERG_BUNDLE_EXPORT ParquetMetadataCache {
+ public:
+  /// \brief Counters describing the use of the cache.
+  struct Stats {
+    /// \brief Number of lookups that found the footer in the cache.
+    int64_t hits = 0;
+    /// \brief Number of lookups that did not find the footer in the cache.
+    int64_t misses = 0;
+    /// \brief Number of footers evicted to make room for other footers.
+    int64_t evictions = 0;
+    /// \brief Number of footers currently in the cache.
+    int64_t file_count = 0;
+    /// \brief Estimated size in bytes of the footers currently in the cache.
+    int64_t size_bytes = 0;
+  };
+
+  /// \brief Creates a cache holding up to `capacity_bytes` bytes of footers.
+  /// \param capacity_bytes The capacity of the cache, must be positive.
+  /// \return A Result containing the cache or an error.
+  static Result<std::shared_ptr<ParquetMetadataCache>> Make(int64_t capacity_bytes);
+
+  /// \brief Returns the process-wide cache, or null if none is installed.
+  static std::shared_ptr<ParquetMetadataCache> Global();
+
+  /// \brief Installs the process-wide cache, or disables it when given null.
+  static void SetGlobal(std::shared_ptr<ParquetMetadataCache> cache);
+
+  /// \brief Returns the cached footer of a file, or null if it is not cached.
+  std::shared_ptr<::parquet::FileMetaData> Get(std::string_view path);
+
+  /// \brief Caches the footer read from a file.
+  void Put(std::string_view path, std::shared_ptr<::parquet::FileMetaData> metadata);
+
+  /// \brief Removes all footers from the cache. The counters are kept.
+  void Clear();
+
+  /// \brief The capacity of the cache in bytes.
+  int64_t capacity_bytes() const { return capacity_bytes_; }
+
+  /// \brief Returns a snapshot of the counters of the cache.
+  Stats stats() const;
+
+ private:
+  struct Item {
+    std::string path;
+    std::shared_ptr<::parquet::FileMetaData> metadata;
+    int64_t size_bytes;
+  };
+
+  explicit ParquetMetadataCache(int64_t capacity_bytes);
+
+  const int64_t capacity_bytes_;
+  mutable std::mutex mutex_;
+  /// \brief Cached footers, from the most to the least recently used.
+  std::list<Item> items_;
+  std::unordered_map<std::string_view, std::list<Item>::iterator> index_;
+  Stats stats_;
+};
+
+}  // namespace iceberg::parquet
@@ -19,29 +19,51 @@
 
 #include "iceberg/parquet/parquet_reader.h"
 
+#include <algorithm>
+#include <charconv>
+#include <deque>
+#include <format>
 #include <numeric>
+#include <optional>
+#include <unordered_set>
 
 #include <arrow/c/bridge.h>
+#include <arrow/io/caching.h>
 #include <arrow/memory_pool.h>
 #include <arrow/record_batch.h>
 #include <arrow/result.h>
+#include <arrow/table.h>
 #include <arrow/type.h>
+#include <arrow/util/bit_util.h>
 #include <arrow/util/key_value_metadata.h>
 #include <parquet/arrow/reader.h>
 #include <parquet/arrow/schema.h>
+#include <parquet/exception.h>
 #include <parquet/file_reader.h>
 #include <parquet/properties.h>
 
 #include "iceberg/arrow/arrow_fs_file_io_internal.h"
+#include "iceberg/arrow/arrow_memory_pool_internal.h"
+#include "iceberg/arrow/arrow_metadata_columns_internal.h"
 #include "iceberg/arrow/arrow_status_internal.h"
+#include "iceberg/deletes/position_delete_index.h"
+#include "iceberg/executor.h"
+#include "iceberg/expression/batch_evaluator.h"
+#include "iceberg/expression/binder.h"
+#include "iceberg/metrics_reporter.h"
 #include "iceberg/parquet/parquet_data_util_internal.h"
+#include "iceberg/parquet/parquet_metadata_cache.h"
 #include "iceberg/parquet/parquet_register.h"
+#include "iceberg/parquet/parquet_row_group_filter_internal.h"
 #include "iceberg/parquet/parquet_schema_util_internal.h"
 #include "iceberg/result.h"
-#include "iceberg/schema_internal.h"
 #include "iceberg/schema_util.h"
+#include "iceberg/util/batch_sizer_internal.h"
 #include "iceberg/util/checked_cast.h"
+#include "iceberg/util/conversion_cache_internal.h"
 #include "iceberg/util/macros.h"
+#include "iceberg/util/task_window_internal.h"
+#include "iceberg/util/tracing.h"
 
 namespace iceberg::parquet {
 
@@ -49,33 +71,175 @@ namespace {
 
 Result<std::shared_ptr<::arrow::io::RandomAccessFile>> OpenInputStream(
     const ReaderOptions& options) {
-  ::arrow::fs::FileInfo file_info(options.path, ::arrow::fs::FileType::File);
-  if (options.length) {
-    file_info.set_size(options.length.value());
+  return arrow::OpenArrowInputFile(options.io, options.path, options.length,
+                                   options.metrics);
+}
+
+Result<SchemaProjection> BuildProjection(
+    const ::parquet::FileMetaData& metadata,
+    const ::parquet::ArrowReaderProperties& arrow_reader_properties,
+    const Schema& read_schema, const std::unordered_map<int32_t, Literal>& constants,
+    const std::unordered_map<int32_t, Literal>& default_values,
+    const std::unordered_map<int32_t, VariantPath>& variant_paths) {
+  if (!HasFieldIds(metadata.schema()->schema_root())) {
+    // TODO(gangwu): apply name mapping to Parquet schema
+    return NotImplemented("Applying name mapping to Parquet schema is not implemented");
   }
 
-  auto io = internal::checked_pointer_cast<arrow::ArrowFileSystemFileIO>(options.io);
-  ICEBERG_ARROW_ASSIGN_OR_RETURN(auto input, io->fs()->OpenInputFile(file_info));
-  return input;
+  // The files of a table mostly share a few schemas, so the projections of the read
+  // schemas onto them are cached by the Parquet schema and the Arrow schema stored in
+  // the file, from which the SchemaManifest is made. The reader properties it depends
+  // on are the same for all readers.
+  static ConversionCache<SchemaProjection> cache;
+  std::string file_schema = metadata.schema()->ToString();
+  if (const auto& key_value_metadata = metadata.key_value_metadata();
+      key_value_metadata != nullptr) {
+    if (auto arrow_schema = key_value_metadata->Get("ARROW:schema"); arrow_schema.ok()) {
+      file_schema += *arrow_schema;
+    }
+  }
+
+  std::optional<::parquet::arrow::SchemaManifest> schema_manifest;
+  return ProjectWithConstants(
+      read_schema, constants, default_values,
+      [&](const Schema& schema) -> Result<SchemaProjection> {
+        std::string key = schema.ToString();
+        for (const auto& field : schema.fields()) {
+          auto it = variant_paths.find(field.field_id());
+          if (it != variant_paths.cend()) {
+            key += std::format("\n{}: {}", field.field_id(), it->second.field_id);
+            for (const auto& name : it->second.names) {
+              key += "." + name;
+            }
+          }
+        }
+        return cache.GetOrConvert(
+            std::format("{}\n{}", key, file_schema),
+            [&]() -> Result<SchemaProjection> {
+              if (!schema_manifest.has_value()) {
+                ICEBERG_ARROW_RETURN_NOT_OK(::parquet::arrow::SchemaManifest::Make(
+                    metadata.schema(), metadata.key_value_metadata(),
+                    arrow_reader_properties, &schema_manifest.emplace()));
+              }
+              // Leverage SchemaManifest to project the schema
+              return Project(schema, schema_manifest.value(), variant_paths);
+            });
+      });
 }
 
-Result<SchemaProjection> BuildProjection(::parquet::arrow::FileReader* reader,
-                                         const Schema& read_schema) {
-  auto metadata = reader->parquet_reader()->metadata();
+/// \brief Returns the positive number of a reader property, or `default_value` if it
+/// is not set.
+Result<int32_t> ParsePositiveProperty(
+    const std::unordered_map<std::string, std::string>& properties,
+    std::string_view key, int32_t default_value) {
+  auto it = properties.find(std::string(key));
+  if (it == properties.cend()) {
+    return default_value;
+  }
+  const auto& value = it->second;
+  int32_t number = 0;
+  auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), number);
+  if (ec != std::errc() || end != value.data() + value.size() || number <= 0) {
+    return InvalidArgument("Invalid {}: {}, expected a positive integer", key, value);
+  }
+  return number;
+}
 
-  if (!HasFieldIds(metadata->schema()->schema_root())) {
-    // TODO(gangwu): apply name mapping to Parquet schema
-    return NotImplemented("Applying name mapping to Parquet schema is not implemented");
+/// \brief Returns whether a string column is read as a dictionary array, which is by
+/// default when every row group has a dictionary page for it.
+bool ReadsDictionary(const std::unordered_map<std::string, std::string>& properties,
+                     const ::parquet::FileMetaData& metadata, std::string_view name,
+                     int column_id) {
+  auto it = properties.find(
+      std::format("{}{}", ParquetReader::kReadDictionaryColumnPrefix, name));
+  if (it == properties.cend()) {
+    it = properties.find(std::string(ParquetReader::kReadDictionaryProperty));
+    if (it == properties.cend() || it->second != "true") {
+      return false;
+    }
+    for (int i = 0; i < metadata.num_row_groups(); ++i) {
+      if (!metadata.RowGroup(i)->ColumnChunk(column_id)->has_dictionary_page()) {
+        return false;
+      }
+    }
+    return true;
   }
+  return it->second == "true";
+}
 
-  ::parquet::arrow::SchemaManifest schema_manifest;
-  ICEBERG_ARROW_RETURN_NOT_OK(::parquet::arrow::SchemaManifest::Make(
-      metadata->schema(), metadata->key_value_metadata(), reader->properties(),
-      &schema_manifest));
+/// \brief Returns the rows that are in both sorted lists of disjoint row ranges.
+RowRanges IntersectRowRanges(const RowRanges& lhs, const RowRanges& rhs) {
+  RowRanges ranges;
+  size_t i = 0;
+  size_t j = 0;
+  while (i < lhs.size() && j < rhs.size()) {
+    const int64_t begin = std::max(lhs[i].first, rhs[j].first);
+    const int64_t end = std::min(lhs[i].second, rhs[j].second);
+    if (begin < end) {
+      ranges.emplace_back(begin, end);
+    }
+    if (lhs[i].second < rhs[j].second) {
+      ++i;
+    } else {
+      ++j;
+    }
+  }
+  return ranges;
+}
+
+/// \brief Returns the bitmap of the rows of a record batch that match a filter.
+Result<std::vector<uint8_t>> EvaluateRecordBatch(const BatchEvaluator& evaluator,
+                                                 const ::arrow::RecordBatch& batch) {
+  ArrowSchema arrow_schema;
+  ICEBERG_ARROW_RETURN_NOT_OK(::arrow::ExportSchema(*batch.schema(), &arrow_schema));
+  ArrowArray arrow_array;
+  if (auto status = ::arrow::ExportRecordBatch(batch, &arrow_array); !status.ok()) {
+    arrow_schema.release(&arrow_schema);
+    ICEBERG_ARROW_RETURN_NOT_OK(status);
+  }
+  auto selection = evaluator.Evaluate(arrow_schema, arrow_array);
+  arrow_array.release(&arrow_array);
+  arrow_schema.release(&arrow_schema);
+  return selection;
+}
 
-  // Leverage SchemaManifest to project the schema
-  ICEBERG_ASSIGN_OR_RAISE(auto projection, Project(read_schema, schema_manifest));
-  return projection;
+using RecordBatches = std::vector<std::shared_ptr<::arrow::RecordBatch>>;
+
+/// \brief What the row groups read in parallel are read with.
+struct RowGroupReadContext {
+  std::shared_ptr<::arrow::io::RandomAccessFile> input;
+  std::shared_ptr<::parquet::FileMetaData> metadata;
+  ::parquet::ReaderProperties reader_properties;
+  ::parquet::ArrowReaderProperties arrow_reader_properties;
+  ::arrow::MemoryPool* pool;
+  std::vector<int> column_indices;
+};
+
+/// \brief Reads the record batches of a row group with a file reader of its own, as a
+/// file reader cannot be used by several threads. The file metadata is not parsed
+/// again.
+Result<RecordBatches> ReadRowGroup(const RowGroupReadContext& context, int row_group) {
+  try {
+    std::unique_ptr<::parquet::arrow::FileReader> reader;
+    ICEBERG_ARROW_RETURN_NOT_OK(::parquet::arrow::FileReader::Make(
+        context.pool,
+        ::parquet::ParquetFileReader::Open(context.input, context.reader_properties,
+                                           context.metadata),
+        context.arrow_reader_properties, &reader));
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(
+        auto batch_reader,
+        reader->GetRecordBatchReader({row_group}, context.column_indices));
+    RecordBatches batches;
+    while (true) {
+      ICEBERG_ARROW_ASSIGN_OR_RETURN(auto batch, batch_reader->Next());
+      if (batch == nullptr) {
+        return batches;
+      }
+      batches.push_back(std::move(batch));
+    }
+  } catch (const ::parquet::ParquetException& e) {
+    return IOError("Failed to read Parquet row group {}: {}", row_group, e.what());
+  }
 }
 
 class EmptyRecordBatchReader : public ::arrow::RecordBatchReader {
@@ -99,8 +263,32 @@ struct ReadContext {
   // the schema of record batches returned by `record_batch_reader_`
   // when there is any schema evolution.
   std::shared_ptr<::arrow::Schema> output_arrow_schema_;
-  // The reader to read record batches from the Parquet file.
+  // The reader to read record batches from the Parquet file, unless row groups are
+  // read in parallel.
   std::unique_ptr<::arrow::RecordBatchReader> record_batch_reader_;
+  // What the row groups are read with when they are read in parallel.
+  std::shared_ptr<const RowGroupReadContext> row_group_read_context_;
+  // The selected row groups that are not read yet, in file order.
+  std::deque<int> row_groups_;
+  // The row groups being read in parallel, taken in file order. Its capacity bounds
+  // the number of row groups held in memory.
+  std::unique_ptr<TaskWindow<RecordBatches>> row_group_window_;
+  // The record batches of the row group being returned.
+  std::deque<std::shared_ptr<::arrow::RecordBatch>> batches_;
+  // The rows to return, as positions in the concatenation of the selected row
+  // groups. All rows are returned if not set.
+  std::optional<RowRanges> row_ranges_;
+  // The index of the first range in `row_ranges_` that has not been fully returned.
+  size_t next_range_ = 0;
+  // The position of the first row of the next record batch.
+  int64_t next_row_ = 0;
+  // The position in the concatenation of the selected row groups and in the file of
+  // the first row of each selected row group, to compute the positions of the rows
+  // returned.
+  std::vector<std::pair<int64_t, int64_t>> row_group_first_rows_;
+  // Whether the record batches read must be projected to `output_arrow_schema_`,
+  // otherwise they are exported as is. Decided from the first record batch if unset.
+  std::optional<bool> project_batches_;
 };
 
 // TODO(gangwu): list of work items
@@ -117,23 +305,75 @@ class ParquetReader::Impl {
     }
 
     split_ = options.split;
+    row_group_sample_ = options.row_group_sample;
     read_schema_ = options.projection;
+    file_path_ = options.path;
+    metadata_columns_ = options.metadata_columns;
+    has_metadata_columns_ = arrow::HasMetadataColumns(*read_schema_);
+    constants_ = options.constants;
+    default_values_ = options.default_values;
+    variant_paths_ = options.variant_paths;
+    pool_ = arrow::ToArrowMemoryPool(options.memory_pool);
+    filter_ = options.filter;
+    metrics_ = options.metrics;
+    if (options.position_deletes != nullptr && !options.position_deletes->IsEmpty()) {
+      position_deletes_ = options.position_deletes;
+    }
+
+    executor_ = options.executor != nullptr ? options.executor : DefaultExecutor();
+    ICEBERG_ASSIGN_OR_RAISE(row_group_parallelism_,
+                            ParsePositiveProperty(options.properties,
+                                                  kRowGroupParallelismProperty, 1));
 
     // Prepare reader properties
-    ::parquet::ReaderProperties reader_properties(pool_);
-    ::parquet::ArrowReaderProperties arrow_reader_properties;
-    arrow_reader_properties.set_batch_size(options.batch_size);
-    arrow_reader_properties.set_arrow_extensions_enabled(true);
+    reader_properties_ = ::parquet::ReaderProperties(pool_);
+    arrow_reader_properties_.set_batch_size(options.batch_size);
+    arrow_reader_properties_.set_arrow_extensions_enabled(true);
+    // Coalesce the reads of the column chunks of each selected row group, which are
+    // issued concurrently when the row group is first read. The reads are merged with
+    // the limits of the FileIO, so that a row group takes few requests.
+    arrow_reader_properties_.set_pre_buffer(true);
+    auto cache_options = ::arrow::io::CacheOptions::LazyDefaults();
+    if (auto* arrow_io = dynamic_cast<arrow::ArrowFileSystemFileIO*>(options.io.get())) {
+      cache_options.hole_size_limit = arrow_io->read_coalescing().hole_size_limit;
+      cache_options.range_size_limit = arrow_io->read_coalescing().range_size_limit;
+    }
+    arrow_reader_properties_.set_cache_options(cache_options);
+    auto late_materialization_it =
+        options.properties.find(std::string(kLateMaterializationProperty));
+    late_materialization_ = late_materialization_it != options.properties.cend() &&
+                            late_materialization_it->second == "true";
+    auto use_threads_it = options.properties.find(std::string(kUseThreadsProperty));
+    arrow_reader_properties_.set_use_threads(
+        use_threads_it != options.properties.cend() && use_threads_it->second == "true");
 
     // Open the Parquet file reader
     ICEBERG_ASSIGN_OR_RAISE(input_stream_, OpenInputStream(options));
-    auto file_reader =
-        ::parquet::ParquetFileReader::Open(input_stream_, reader_properties);
-    ICEBERG_ARROW_RETURN_NOT_OK(::parquet::arrow::FileReader::Make(
-        pool_, std::move(file_reader), arrow_reader_properties, &reader_));
+    // A cached footer is not read from the file again.
+    auto metadata_cache = ParquetMetadataCache::Global();
+    auto cached_metadata =
+        metadata_cache != nullptr ? metadata_cache->Get(options.path) : nullptr;
+    auto file_reader = ::parquet::ParquetFileReader::Open(
+        input_stream_, reader_properties_, cached_metadata);
+    auto metadata = file_reader->metadata();
+    if (metadata_cache != nullptr && cached_metadata == nullptr) {
+      metadata_cache->Put(options.path, metadata);
+    }
 
     // Project read schema onto the Parquet file schema
-    ICEBERG_ASSIGN_OR_RAISE(projection_, BuildProjection(reader_.get(), *read_schema_));
+    ICEBERG_ASSIGN_OR_RAISE(
+        projection_, BuildProjection(*metadata, arrow_reader_properties_, *read_schema_,
+                                     constants_, default_values_, variant_paths_));
+    SelectDictionaryColumns(options.properties, *metadata);
+    if (options.target_batch_bytes.has_value()) {
+      ICEBERG_ASSIGN_OR_RAISE(
+          auto batch_sizer, BatchSizer::Make(options.target_batch_bytes.value(),
+                                             EstimateRowWidth(*metadata)));
+      arrow_reader_properties_.set_batch_size(batch_sizer.batch_size());
+    }
+
+    ICEBERG_ARROW_RETURN_NOT_OK(::parquet::arrow::FileReader::Make(
+        pool_, std::move(file_reader), arrow_reader_properties_, &reader_));
 
     return {};
   }
@@ -144,14 +384,45 @@ class ParquetReader::Impl {
       ICEBERG_RETURN_UNEXPECTED(InitReadContext());
     }
 
-    ICEBERG_ARROW_ASSIGN_OR_RETURN(auto batch, context_->record_batch_reader_->Next());
-    if (!batch) {
-      return std::nullopt;
+    std::shared_ptr<::arrow::RecordBatch> batch;
+    // The rows of the batch, as positions in the concatenation of the selected row
+    // groups.
+    RowRanges rows;
+    while (batch == nullptr) {
+      ICEBERG_ASSIGN_OR_RAISE(batch, ReadNextBatch());
+      if (!batch) {
+        return std::nullopt;
+      }
+      const int64_t first_row = context_->next_row_;
+      const int64_t num_rows = batch->num_rows();
+      context_->next_row_ += num_rows;
+      rows.clear();
+      if (context_->row_ranges_.has_value()) {
+        ICEBERG_ASSIGN_OR_RAISE(batch, SelectRows(std::move(batch), first_row, rows));
+        if (metrics_ != nullptr) {
+          metrics_->rows_skipped.Increment(num_rows -
+                                           (batch != nullptr ? batch->num_rows() : 0));
+        }
+      } else {
+        rows.emplace_back(first_row, first_row + num_rows);
+      }
     }
 
-    ICEBERG_ASSIGN_OR_RAISE(
-        batch, ProjectRecordBatch(std::move(batch), context_->output_arrow_schema_,
-                                  *read_schema_, projection_, pool_));
+    if (!context_->project_batches_.has_value()) {
+      context_->project_batches_ = RequiresProjection(
+          *batch->schema(), *context_->output_arrow_schema_, projection_);
+    }
+    if (context_->project_batches_.value()) {
+      ICEBERG_ASSIGN_OR_RAISE(
+          batch, ProjectRecordBatch(std::move(batch), context_->output_arrow_schema_,
+                                    *read_schema_, projection_, pool_));
+    }
+    if (has_metadata_columns_) {
+      ICEBERG_ASSIGN_OR_RAISE(
+          batch, arrow::SetMetadataColumns(batch, *read_schema_, file_path_,
+                                           metadata_columns_, ToFilePositions(rows),
+                                           pool_));
+    }
 
     ArrowArray arrow_array;
     ICEBERG_ARROW_RETURN_NOT_OK(::arrow::ExportRecordBatch(*batch, &arrow_array));
@@ -165,7 +436,10 @@ class ParquetReader::Impl {
     }
 
     if (context_ != nullptr) {
-      ICEBERG_ARROW_RETURN_NOT_OK(context_->record_batch_reader_->Close());
+      if (context_->record_batch_reader_ != nullptr) {
+        ICEBERG_ARROW_RETURN_NOT_OK(context_->record_batch_reader_->Close());
+      }
+      // Waits for the row groups being read in parallel.
       context_.reset();
     }
 
@@ -212,13 +486,10 @@ class ParquetReader::Impl {
     context_ = std::make_unique<ReadContext>();
 
     // Build the output Arrow schema
-    ArrowSchema arrow_schema;
-    ICEBERG_RETURN_UNEXPECTED(ToArrowSchema(*read_schema_, &arrow_schema));
-    ICEBERG_ARROW_ASSIGN_OR_RETURN(context_->output_arrow_schema_,
-                                   ::arrow::ImportSchema(&arrow_schema));
+    ICEBERG_ASSIGN_OR_RAISE(context_->output_arrow_schema_,
+                            MakeOutputArrowSchema(*read_schema_));
 
     // Row group pruning based on the split
-    // TODO(gangwu): add row group filtering based on zone map, bloom filter, etc.
     std::vector<int> row_group_indices;
     if (split_.has_value()) {
       auto metadata = reader_->parquet_reader()->metadata();
@@ -236,29 +507,505 @@ class ParquetReader::Impl {
       std::iota(row_group_indices.begin(), row_group_indices.end(), 0);  // NOLINT
     }
 
+    const auto num_split_row_groups = static_cast<int64_t>(row_group_indices.size());
+
+    // Row group pruning based on the sample
+    if (row_group_sample_.has_value()) {
+      std::erase_if(row_group_indices, [&](int row_group) {
+        return !row_group_sample_->Contains(file_path_, row_group);
+      });
+    }
+
+    // Row group and page pruning based on column statistics, bloom filters and the
+    // page index
+    if (filter_ != nullptr && !row_group_indices.empty()) {
+      ICEBERG_RETURN_UNEXPECTED(FilterRowGroups(row_group_indices));
+    }
+
+    // Skip the deleted rows, and the row groups whose rows are all deleted
+    if (position_deletes_ != nullptr && !row_group_indices.empty()) {
+      ApplyPositionDeletes(row_group_indices);
+    }
+    // Skip the rows that do not match the filter, decoding only its columns first
+    if (late_materialization_ && filter_ != nullptr && !row_group_indices.empty()) {
+      ICEBERG_RETURN_UNEXPECTED(SelectMatchingRows(row_group_indices));
+    }
+    if (metrics_ != nullptr) {
+      metrics_->row_groups_skipped.Increment(
+          num_split_row_groups - static_cast<int64_t>(row_group_indices.size()));
+    }
+    if (has_metadata_columns_) {
+      auto metadata = reader_->parquet_reader()->metadata();
+      std::vector<int64_t> file_first_rows(metadata->num_row_groups() + 1, 0);
+      for (int i = 0; i < metadata->num_row_groups(); ++i) {
+        file_first_rows[i + 1] = file_first_rows[i] + metadata->RowGroup(i)->num_rows();
+      }
+      int64_t row_offset = 0;
+      for (int row_group : row_group_indices) {
+        context_->row_group_first_rows_.emplace_back(row_offset,
+                                                     file_first_rows[row_group]);
+        row_offset += metadata->RowGroup(row_group)->num_rows();
+      }
+    }
+
     // Create the record batch reader
     if (row_group_indices.empty()) {
       // None of the row groups are selected, return an empty record batch reader
       context_->record_batch_reader_ = std::make_unique<EmptyRecordBatchReader>();
+    } else if (row_group_parallelism_ > 1 && row_group_indices.size() > 1) {
+      context_->row_group_read_context_ =
+          std::make_shared<const RowGroupReadContext>(RowGroupReadContext{
+              .input = input_stream_,
+              .metadata = reader_->parquet_reader()->metadata(),
+              .reader_properties = reader_properties_,
+              .arrow_reader_properties = arrow_reader_properties_,
+              .pool = pool_,
+              .column_indices = SelectedColumnIndices(projection_)});
+      context_->row_groups_.assign(row_group_indices.begin(), row_group_indices.end());
+      context_->row_group_window_ = std::make_unique<TaskWindow<RecordBatches>>(
+          executor_, static_cast<size_t>(row_group_parallelism_), /*ordered=*/true);
     } else {
       auto column_indices = SelectedColumnIndices(projection_);
       ICEBERG_ARROW_ASSIGN_OR_RETURN(
           context_->record_batch_reader_,
           reader_->GetRecordBatchReader(row_group_indices, column_indices));
+      context_->project_batches_ =
+          RequiresProjection(*context_->record_batch_reader_->schema(),
+                             *context_->output_arrow_schema_, projection_);
+    }
+
+    return {};
+  }
+
+  // Read the selected top-level string columns as dictionary arrays.
+  void SelectDictionaryColumns(
+      const std::unordered_map<std::string, std::string>& properties,
+      const ::parquet::FileMetaData& metadata) {
+    const auto& fields = read_schema_->fields();
+    for (size_t i = 0; i < fields.size(); ++i) {
+      const auto& field_projection = projection_.fields[i];
+      if (fields[i].type()->type_id() != TypeId::kString ||
+          field_projection.kind != FieldProjection::Kind::kProjected ||
+          field_projection.attributes == nullptr) {
+        continue;
+      }
+      const auto& attributes = internal::checked_cast<const ParquetExtraAttributes&>(
+          *field_projection.attributes);
+      if (!attributes.column_id.has_value()) {
+        continue;
+      }
+      const int column_id = attributes.column_id.value();
+      // Binary columns without the string annotation are not read as utf8.
+      if (!metadata.schema()->Column(column_id)->logical_type()->is_string() ||
+          !ReadsDictionary(properties, metadata, fields[i].name(), column_id)) {
+        continue;
+      }
+      arrow_reader_properties_.set_read_dictionary(column_id, true);
+      dictionary_field_ids_.insert(fields[i].field_id());
+    }
+  }
+
+  // Estimate the width of the projected rows from the uncompressed sizes of their
+  // column chunks. Encodings such as dictionaries make the chunks smaller than the
+  // decoded values, so the width is at least the estimate from the read schema.
+  double EstimateRowWidth(const ::parquet::FileMetaData& metadata) const {
+    const double schema_width = BatchSizer::EstimateRowWidth(*read_schema_);
+    if (metadata.num_rows() <= 0) {
+      return schema_width;
+    }
+    const auto column_indices = SelectedColumnIndices(projection_);
+    int64_t num_bytes = 0;
+    for (int i = 0; i < metadata.num_row_groups(); ++i) {
+      auto row_group = metadata.RowGroup(i);
+      for (int column : column_indices) {
+        num_bytes += row_group->ColumnChunk(column)->total_uncompressed_size();
+      }
+    }
+    const double file_width =
+        static_cast<double>(num_bytes) / static_cast<double>(metadata.num_rows());
+    return std::max(schema_width, file_width);
+  }
+
+  // Convert a schema to the Arrow schema of the record batches returned for it.
+  Result<std::shared_ptr<::arrow::Schema>> MakeOutputArrowSchema(const Schema& schema) {
+    ICEBERG_ASSIGN_OR_RAISE(auto output_arrow_schema, arrow::MakeReadArrowSchema(schema));
+    const auto& fields = schema.fields();
+    for (size_t i = 0; i < fields.size(); ++i) {
+      if (!dictionary_field_ids_.contains(fields[i].field_id())) {
+        continue;
+      }
+      auto field = output_arrow_schema->field(static_cast<int>(i));
+      ICEBERG_ARROW_ASSIGN_OR_RETURN(
+          output_arrow_schema,
+          output_arrow_schema->SetField(
+              static_cast<int>(i),
+              field->WithType(::arrow::dictionary(::arrow::int32(), field->type()))));
+    }
+    return output_arrow_schema;
+  }
+
+  // Read the next record batch of the selected row groups, or nullptr at the end.
+  Result<std::shared_ptr<::arrow::RecordBatch>> ReadNextBatch() {
+    if (context_->row_group_window_ == nullptr) {
+      ICEBERG_ARROW_ASSIGN_OR_RETURN(auto batch, context_->record_batch_reader_->Next());
+      return batch;
     }
 
+    auto& window = *context_->row_group_window_;
+    auto& batches = context_->batches_;
+    while (batches.empty()) {
+      auto& row_groups = context_->row_groups_;
+      while (!row_groups.empty() && !window.full()) {
+        window.Push([read_context = context_->row_group_read_context_,
+                     row_group = row_groups.front()]() {
+          return ReadRowGroup(*read_context, row_group);
+        });
+        row_groups.pop_front();
+      }
+      if (window.empty()) {
+        return nullptr;
+      }
+      ICEBERG_ASSIGN_OR_RAISE(auto row_group_batches, window.Take());
+      batches.assign(std::make_move_iterator(row_group_batches.begin()),
+                     std::make_move_iterator(row_group_batches.end()));
+    }
+    auto batch = std::move(batches.front());
+    batches.pop_front();
+    return batch;
+  }
+
+  // Drop the row groups that cannot contain rows matching the filter and record the
+  // rows of the remaining ones that may match.
+  Status FilterRowGroups(std::vector<int>& row_group_indices) {
+    auto row_group_filter =
+        RowGroupFilter::Make(filter_, read_schema_, reader_->parquet_reader(),
+                             VariantPathFields(*read_schema_, projection_));
+    if (!row_group_filter.has_value()) {
+      // The filter references columns that are not projected, so it cannot be bound
+      // to the read schema. Filtering is optional for readers, read all row groups.
+      return {};
+    }
+
+    auto metadata = reader_->parquet_reader()->metadata();
+    std::vector<int> selected_row_groups;
+    RowRanges row_ranges;
+    bool all_rows = true;
+    int64_t row_offset = 0;
+    for (int row_group : row_group_indices) {
+      ICEBERG_ASSIGN_OR_RAISE(auto should_read,
+                              (*row_group_filter)->ShouldRead(row_group));
+      if (!should_read) {
+        continue;
+      }
+      ICEBERG_ASSIGN_OR_RAISE(auto ranges, (*row_group_filter)->SelectRows(row_group));
+      if (ranges.empty()) {
+        continue;
+      }
+
+      const int64_t num_rows = metadata->RowGroup(row_group)->num_rows();
+      all_rows = all_rows && ranges.size() == 1 && ranges.front().first == 0 &&
+                 ranges.front().second == num_rows;
+      for (const auto& [begin, end] : ranges) {
+        row_ranges.emplace_back(row_offset + begin, row_offset + end);
+      }
+      row_offset += num_rows;
+      selected_row_groups.push_back(row_group);
+    }
+
+    row_group_indices = std::move(selected_row_groups);
+    if (!all_rows) {
+      // The Arrow reader cannot skip pages, so rows outside of the selected pages are
+      // decoded and then dropped from the record batches.
+      context_->row_ranges_ = std::move(row_ranges);
+    }
     return {};
   }
 
+  // Remove the deleted positions from the rows to read. Row groups without remaining
+  // rows are dropped.
+  void ApplyPositionDeletes(std::vector<int>& row_group_indices) {
+    auto metadata = reader_->parquet_reader()->metadata();
+    // Positions of the first row of each row group in the file.
+    std::vector<int64_t> first_rows(metadata->num_row_groups() + 1, 0);
+    for (int i = 0; i < metadata->num_row_groups(); ++i) {
+      first_rows[i + 1] = first_rows[i] + metadata->RowGroup(i)->num_rows();
+    }
+
+    std::vector<int> selected_row_groups;
+    RowRanges row_ranges;
+    bool all_rows = true;
+    // Offsets of the current row group among the row groups to read before and after
+    // applying the deletes.
+    int64_t row_offset = 0;
+    int64_t selected_row_offset = 0;
+    size_t next_range = 0;
+    for (int row_group : row_group_indices) {
+      const int64_t first_row = first_rows[row_group];
+      const int64_t num_rows = first_rows[row_group + 1] - first_row;
+
+      // The ranges of the row group to read, relative to its first row.
+      RowRanges ranges;
+      if (context_->row_ranges_.has_value()) {
+        const auto& selected_ranges = context_->row_ranges_.value();
+        while (next_range < selected_ranges.size() &&
+               selected_ranges[next_range].first < row_offset + num_rows) {
+          ranges.emplace_back(selected_ranges[next_range].first - row_offset,
+                              selected_ranges[next_range].second - row_offset);
+          ++next_range;
+        }
+      } else {
+        ranges.emplace_back(0, num_rows);
+      }
+      row_offset += num_rows;
+
+      RowRanges live_ranges;
+      for (const auto& [begin, end] : ranges) {
+        int64_t live_begin = begin;
+        position_deletes_->ForEach(
+            first_row + begin, first_row + end, [&](int64_t position) {
+              const int64_t row = position - first_row;
+              if (row > live_begin) {
+                live_ranges.emplace_back(live_begin, row);
+              }
+              live_begin = row + 1;
+            });
+        if (live_begin < end) {
+          live_ranges.emplace_back(live_begin, end);
+        }
+      }
+      if (live_ranges.empty()) {
+        continue;
+      }
+
+      all_rows = all_rows && live_ranges.size() == 1 && live_ranges.front().first == 0 &&
+                 live_ranges.front().second == num_rows;
+      for (const auto& [begin, end] : live_ranges) {
+        row_ranges.emplace_back(selected_row_offset + begin, selected_row_offset + end);
+      }
+      selected_row_offset += num_rows;
+      selected_row_groups.push_back(row_group);
+    }
+
+    row_group_indices = std::move(selected_row_groups);
+    if (all_rows) {
+      context_->row_ranges_.reset();
+    } else {
+      context_->row_ranges_ = std::move(row_ranges);
+    }
+  }
+
+  // Read the columns referenced by the filter and keep only the selected rows that
+  // match it, so that the other projected columns are decoded only for the row groups
+  // with matching rows. Row groups without remaining rows are dropped.
+  Status SelectMatchingRows(std::vector<int>& row_group_indices) {
+    auto field_ids =
+        Binder::BoundReferences(*read_schema_, filter_, /*case_sensitive=*/true);
+    if (!field_ids.has_value()) {
+      // The filter references columns that are not projected, it is not applied.
+      return {};
+    }
+    ICEBERG_ASSIGN_OR_RAISE(std::shared_ptr<Schema> filter_schema,
+                            read_schema_->Project(field_ids.value()));
+    if (arrow::HasMetadataColumns(*filter_schema)) {
+      // Metadata columns are generated after the rows are selected.
+      return {};
+    }
+    auto evaluator = BatchEvaluator::Make(*filter_schema, filter_);
+    if (!evaluator.has_value()) {
+      // The filter cannot be evaluated on batches, such as on transformed columns.
+      return {};
+    }
+
+    auto metadata = reader_->parquet_reader()->metadata();
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto filter_projection,
+        BuildProjection(*metadata, arrow_reader_properties_, *filter_schema, constants_,
+                        default_values_, variant_paths_));
+    auto column_indices = SelectedColumnIndices(filter_projection);
+    if (column_indices.empty() ||
+        column_indices.size() >= SelectedColumnIndices(projection_).size()) {
+      // Nothing is saved when all projected columns are referenced by the filter.
+      return {};
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto output_arrow_schema,
+                            MakeOutputArrowSchema(*filter_schema));
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(
+        auto batch_reader,
+        reader_->GetRecordBatchReader(row_group_indices, column_indices));
+    const bool project_batches = RequiresProjection(
+        *batch_reader->schema(), *output_arrow_schema, filter_projection);
+
+    // The matching rows, as positions in the concatenation of the row groups.
+    RowRanges matches;
+    int64_t position = 0;
+    while (true) {
+      ICEBERG_ARROW_ASSIGN_OR_RETURN(auto batch, batch_reader->Next());
+      if (batch == nullptr) {
+        break;
+      }
+      if (project_batches) {
+        ICEBERG_ASSIGN_OR_RAISE(batch,
+                                ProjectRecordBatch(std::move(batch), output_arrow_schema,
+                                                   *filter_schema, filter_projection,
+                                                   pool_));
+      }
+      ICEBERG_ASSIGN_OR_RAISE(auto selection,
+                              EvaluateRecordBatch(*evaluator.value(), *batch));
+      for (int64_t i = 0; i < batch->num_rows(); ++i, ++position) {
+        if (!::arrow::bit_util::GetBit(selection.data(), i)) {
+          continue;
+        }
+        if (!matches.empty() && matches.back().second == position) {
+          ++matches.back().second;
+        } else {
+          matches.emplace_back(position, position + 1);
+        }
+      }
+    }
+    ICEBERG_ARROW_RETURN_NOT_OK(batch_reader->Close());
+    if (context_->row_ranges_.has_value()) {
+      matches = IntersectRowRanges(matches, context_->row_ranges_.value());
+    }
+
+    std::vector<int> selected_row_groups;
+    RowRanges row_ranges;
+    bool all_rows = true;
+    // Offsets of the current row group among the row groups to read before and after
+    // dropping the row groups without matching rows.
+    int64_t row_offset = 0;
+    int64_t selected_row_offset = 0;
+    size_t next_range = 0;
+    for (int row_group : row_group_indices) {
+      const int64_t num_rows = metadata->RowGroup(row_group)->num_rows();
+      const int64_t end_row = row_offset + num_rows;
+      const size_t num_ranges = row_ranges.size();
+      while (next_range < matches.size() && matches[next_range].first < end_row) {
+        auto& [begin, end] = matches[next_range];
+        const int64_t shift = selected_row_offset - row_offset;
+        row_ranges.emplace_back(begin + shift, std::min(end, end_row) + shift);
+        if (end > end_row) {
+          // The rest of the range is in the next row group.
+          begin = end_row;
+          break;
+        }
+        ++next_range;
+      }
+      row_offset = end_row;
+      if (row_ranges.size() == num_ranges) {
+        continue;
+      }
+
+      all_rows = all_rows && row_ranges.size() == num_ranges + 1 &&
+                 row_ranges.back().first == selected_row_offset &&
+                 row_ranges.back().second == selected_row_offset + num_rows;
+      selected_row_offset += num_rows;
+      selected_row_groups.push_back(row_group);
+    }
+
+    row_group_indices = std::move(selected_row_groups);
+    if (all_rows) {
+      context_->row_ranges_.reset();
+    } else {
+      context_->row_ranges_ = std::move(row_ranges);
+    }
+    return {};
+  }
+
+  // Keep only the rows of a record batch that are in the selected row ranges, and
+  // append the ranges of the rows kept to `rows`. Returns nullptr if none of its rows
+  // is selected.
+  Result<std::shared_ptr<::arrow::RecordBatch>> SelectRows(
+      std::shared_ptr<::arrow::RecordBatch> batch, int64_t first_row, RowRanges& rows) {
+    const auto& row_ranges = context_->row_ranges_.value();
+    const int64_t end_row = first_row + batch->num_rows();
+
+    std::vector<std::shared_ptr<::arrow::RecordBatch>> slices;
+    auto& next_range = context_->next_range_;
+    while (next_range < row_ranges.size() && row_ranges[next_range].first < end_row) {
+      const int64_t begin = std::max(row_ranges[next_range].first, first_row);
+      const int64_t end = std::min(row_ranges[next_range].second, end_row);
+      if (begin < end) {
+        slices.push_back(batch->Slice(begin - first_row, end - begin));
+        rows.emplace_back(begin, end);
+      }
+      if (row_ranges[next_range].second > end_row) {
+        break;
+      }
+      ++next_range;
+    }
+
+    if (slices.empty()) {
+      return nullptr;
+    }
+    if (slices.size() == 1) {
+      return slices.front();
+    }
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(
+        auto table, ::arrow::Table::FromRecordBatches(batch->schema(), slices));
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(auto combined, table->CombineChunksToBatch(pool_));
+    return combined;
+  }
+
+  // Convert ranges of positions in the concatenation of the selected row groups to
+  // ranges of positions in the file.
+  RowRanges ToFilePositions(const RowRanges& rows) const {
+    const auto& first_rows = context_->row_group_first_rows_;
+    RowRanges positions;
+    for (auto [begin, end] : rows) {
+      // The last selected row group that starts at or before `begin`.
+      auto it = std::ranges::upper_bound(
+          first_rows, begin, {}, [](const auto& first_row) { return first_row.first; });
+      while (begin < end && it != first_rows.cbegin()) {
+        const auto& [row_offset, file_row] = *std::prev(it);
+        const int64_t group_end =
+            it != first_rows.cend() ? std::min(it->first, end) : end;
+        positions.emplace_back(file_row + begin - row_offset,
+                               file_row + group_end - row_offset);
+        begin = group_end;
+        ++it;
+      }
+    }
+    return positions;
+  }
+
  private:
   // TODO(gangwu): make memory pool configurable
   ::arrow::MemoryPool* pool_ = ::arrow::default_memory_pool();
   // The split to read from the Parquet file.
   std::optional<Split> split_;
+  // The sample of the row groups to read, or all of them.
+  std::optional<RowGroupSample> row_group_sample_;
   // Schema to read from the Parquet file.
   std::shared_ptr<::iceberg::Schema> read_schema_;
+  // The path of the file, and the values of the metadata columns not stored in it.
+  std::string file_path_;
+  MetadataColumnValues metadata_columns_;
+  // Whether the read schema has metadata columns to generate.
+  bool has_metadata_columns_ = false;
+  // The values of the fields filled instead of read, by field id.
+  std::unordered_map<int32_t, Literal> constants_;
+  std::unordered_map<int32_t, Literal> default_values_;
+  std::unordered_map<int32_t, VariantPath> variant_paths_;
+  // The filter to prune row groups, if any.
+  std::shared_ptr<Expression> filter_;
+  // The positions of the deleted rows to skip, if any.
+  std::shared_ptr<const PositionDeleteIndex> position_deletes_;
+  // Receives the metrics of the reader, if any.
+  std::shared_ptr<ReadMetrics> metrics_;
+  // The executor of the row groups read in parallel.
+  std::shared_ptr<Executor> executor_;
+  // The number of row groups read at the same time.
+  int32_t row_group_parallelism_ = 1;
+  // Whether the columns referenced by the filter are read first to skip the rows that
+  // do not match it.
+  bool late_materialization_ = false;
+  // The properties of the Parquet file readers.
+  ::parquet::ReaderProperties reader_properties_;
+  ::parquet::ArrowReaderProperties arrow_reader_properties_;
   // The projection result to apply to the read schema.
   SchemaProjection projection_;
+  // The ids of the top-level fields read as dictionary arrays.
+  std::unordered_set<int32_t> dictionary_field_ids_;
   // The input stream to read Parquet file.
   std::shared_ptr<::arrow::io::RandomAccessFile> input_stream_;
   // Parquet file reader to create RecordBatchReader.
@@ -269,7 +1016,13 @@ class ParquetReader::Impl {
 
 ParquetReader::~ParquetReader() = default;
 
-Result<std::optional<ArrowArray>> ParquetReader::Next() { return impl_->Next(); }
+Result<std::optional<ArrowArray>> ParquetReader::Next() {
+  ICEBERG_TRACE_SCOPE(trace, "ParquetReader::Next");
+  auto batch = impl_->Next();
+  ICEBERG_TRACE_ATTRIBUTE(trace, "rows",
+                          batch.has_value() && batch->has_value() ? (*batch)->length : 0);
+  return batch;
+}
 
 Result<ArrowSchema> ParquetReader::Schema() { return impl_->Schema(); }
 
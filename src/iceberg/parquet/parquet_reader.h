@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include <string_view>
+
 #include "iceberg/file_reader.h"
 #include "iceberg/iceberg_bundle_export.h"
 
@@ -27,6 +29,37 @@ namespace iceberg::parquet {
 /// \brief A reader that reads ArrowArray from Parquet files.
 class ICEBERG_BUNDLE_EXPORT ParquetReader : public Reader {
  public:
+  /// \brief Reader property to decode the columns of each row group in parallel on the
+  /// Arrow CPU thread pool, enabled by the value "true".
+  static constexpr std::string_view kUseThreadsProperty = "read.parquet.use-threads";
+
+  /// \brief Reader property with the number of selected row groups read at the same
+  /// time on ReaderOptions::executor, or the default executor if it is null. Row groups
+  /// are returned in file order, and batches end at the end of each row group.
+  /// Defaults to 1, which reads the row groups one after the other on the calling
+  /// thread.
+  static constexpr std::string_view kRowGroupParallelismProperty =
+      "read.parquet.row-group-parallelism";
+
+  /// \brief Reader property to read the columns referenced by ReaderOptions::filter
+  /// first and skip the rows that do not match it, enabled by the value "true". The
+  /// other projected columns are then decoded only for the row groups with matching
+  /// rows, and the rows that do not match are removed from the returned batches.
+  static constexpr std::string_view kLateMaterializationProperty =
+      "read.parquet.late-materialization";
+
+  /// \brief Reader property to read the top-level string columns that are dictionary
+  /// encoded in every row group as dictionary<int32, utf8> arrays, enabled by the value
+  /// "true". Predicates on such columns are evaluated once per dictionary value.
+  static constexpr std::string_view kReadDictionaryProperty =
+      "read.parquet.dictionary-enabled";
+
+  /// \brief Prefix of the reader property, followed by a top-level field name, that
+  /// overrides kReadDictionaryProperty for the string column of the field with the
+  /// value "true" or "false".
+  static constexpr std::string_view kReadDictionaryColumnPrefix =
+      "read.parquet.dictionary-enabled.column.";
+
   ParquetReader() = default;
 
   ~ParquetReader() override;
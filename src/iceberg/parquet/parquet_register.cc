@@ -24,6 +24,7 @@ namespace iceberg::parquet {
 void RegisterAll() {
   RegisterReader();
   RegisterWriter();
+  RegisterFooterReader();
 }
 
 }  // namespace iceberg::parquet
@@ -32,7 +32,11 @@ ICEBERG_BUNDLE_EXPORT void RegisterReader();
 /// \brief Register Parquet writer implementation.
 ICEBERG_BUNDLE_EXPORT void RegisterWriter();
 
-/// \brief Register Parquet reader and writer implementations.
+/// \brief Register the Parquet footer reader, which reads the metrics of existing
+/// Parquet files.
+ICEBERG_BUNDLE_EXPORT void RegisterFooterReader();
+
+/// \brief Register Parquet reader, writer and footer reader implementations.
 ICEBERG_BUNDLE_EXPORT void RegisterAll();
 
 }  // namespace iceberg::parquet
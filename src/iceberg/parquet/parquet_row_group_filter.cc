@@ -0,0 +1,606 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/parquet/parquet_row_group_filter_internal.h"
+
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <parquet/bloom_filter.h>
+#include <parquet/bloom_filter_reader.h>
+#include <parquet/exception.h>
+#include <parquet/metadata.h>
+#include <parquet/page_index.h>
+#include <parquet/schema.h>
+#include <parquet/statistics.h>
+#include <parquet/types.h>
+
+#include "iceberg/expression/binder.h"
+#include "iceberg/expression/expression_visitor.h"
+#include "iceberg/expression/rewrite_not.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/parquet/parquet_schema_util_internal.h"
+#include "iceberg/schema_field.h"
+#include "iceberg/type.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/decimal.h"
+#include "iceberg/util/macros.h"
+#include "iceberg/util/uuid.h"
+
+namespace iceberg::parquet {
+
+namespace {
+
+constexpr bool kRowsMightMatch = true;
+constexpr bool kRowsCannotMatch = false;
+
+/// \brief Converts a plain encoded Parquet min/max value to a serialized Iceberg bound.
+Result<std::vector<uint8_t>> ToBound(std::string_view encoded,
+                                     const std::shared_ptr<PrimitiveType>& file_type,
+                                     const std::shared_ptr<PrimitiveType>& type) {
+  std::span<const uint8_t> bytes(reinterpret_cast<const uint8_t*>(encoded.data()),
+                                 encoded.size());
+  if (file_type->type_id() == type->type_id()) {
+    // Plain encoding of these types matches the Iceberg single-value serialization.
+    return std::vector<uint8_t>(bytes.begin(), bytes.end());
+  }
+  // The column type has been promoted since the file was written.
+  ICEBERG_ASSIGN_OR_RAISE(auto literal, Literal::Deserialize(bytes, file_type));
+  ICEBERG_ASSIGN_OR_RAISE(literal, literal.CastTo(type));
+  return literal.Serialize();
+}
+
+/// \brief Sets the bounds of a column in data file metrics from Parquet min/max values.
+Status SetBounds(const ::parquet::ColumnDescriptor& descr, const SchemaField& field,
+                 std::string_view encoded_min, std::string_view encoded_max,
+                 DataFile& metrics) {
+  if (!field.type()->is_primitive()) {
+    return {};
+  }
+  auto type = internal::checked_pointer_cast<PrimitiveType>(field.type());
+  auto file_type = StatisticsType(descr, type->type_id());
+  if (file_type == nullptr) {
+    return {};
+  }
+  ICEBERG_ASSIGN_OR_RAISE(metrics.lower_bounds[field.field_id()],
+                          ToBound(encoded_min, file_type, type));
+  ICEBERG_ASSIGN_OR_RAISE(metrics.upper_bounds[field.field_id()],
+                          ToBound(encoded_max, file_type, type));
+  return {};
+}
+
+RowRanges Intersect(const RowRanges& left, const RowRanges& right) {
+  RowRanges result;
+  auto l = left.begin();
+  auto r = right.begin();
+  while (l != left.end() && r != right.end()) {
+    const int64_t begin = std::max(l->first, r->first);
+    const int64_t end = std::min(l->second, r->second);
+    if (begin < end) {
+      result.emplace_back(begin, end);
+    }
+    if (l->second < r->second) {
+      ++l;
+    } else {
+      ++r;
+    }
+  }
+  return result;
+}
+
+RowRanges Union(const RowRanges& left, const RowRanges& right) {
+  RowRanges merged;
+  merged.reserve(left.size() + right.size());
+  std::ranges::merge(left, right, std::back_inserter(merged));
+
+  RowRanges result;
+  for (const auto& range : merged) {
+    if (!result.empty() && range.first <= result.back().second) {
+      result.back().second = std::max(result.back().second, range.second);
+    } else {
+      result.push_back(range);
+    }
+  }
+  return result;
+}
+
+/// \brief Hashes a literal value the way Parquet hashes the values of a column.
+///
+/// Returns nullopt when the value does not have the physical type of the column.
+std::optional<uint64_t> HashValue(const ::parquet::BloomFilter& bloom_filter,
+                                  const ::parquet::ColumnDescriptor& descr,
+                                  const Literal::Value& value) {
+  switch (descr.physical_type()) {
+    case ::parquet::Type::INT32:
+      if (const auto* v = std::get_if<int32_t>(&value)) {
+        return bloom_filter.Hash(*v);
+      }
+      if (const auto* v = std::get_if<Decimal>(&value)) {
+        return bloom_filter.Hash(static_cast<int32_t>(v->value()));
+      }
+      break;
+    case ::parquet::Type::INT64:
+      if (const auto* v = std::get_if<int64_t>(&value)) {
+        return bloom_filter.Hash(*v);
+      }
+      if (const auto* v = std::get_if<Decimal>(&value)) {
+        return bloom_filter.Hash(static_cast<int64_t>(v->value()));
+      }
+      break;
+    case ::parquet::Type::FLOAT:
+      if (const auto* v = std::get_if<float>(&value)) {
+        return bloom_filter.Hash(*v);
+      }
+      break;
+    case ::parquet::Type::DOUBLE:
+      if (const auto* v = std::get_if<double>(&value)) {
+        return bloom_filter.Hash(*v);
+      }
+      break;
+    case ::parquet::Type::BYTE_ARRAY:
+      if (const auto* v = std::get_if<std::string>(&value)) {
+        ::parquet::ByteArray byte_array(static_cast<uint32_t>(v->size()),
+                                        reinterpret_cast<const uint8_t*>(v->data()));
+        return bloom_filter.Hash(&byte_array);
+      }
+      if (const auto* v = std::get_if<std::vector<uint8_t>>(&value)) {
+        ::parquet::ByteArray byte_array(static_cast<uint32_t>(v->size()), v->data());
+        return bloom_filter.Hash(&byte_array);
+      }
+      break;
+    case ::parquet::Type::FIXED_LEN_BYTE_ARRAY: {
+      // Parquet hashes only the bytes of a fixed length value, not its length.
+      const auto length = static_cast<uint32_t>(descr.type_length());
+      if (const auto* v = std::get_if<std::vector<uint8_t>>(&value)) {
+        if (v->size() == length) {
+          ::parquet::FLBA flba(v->data());
+          return bloom_filter.Hash(&flba, length);
+        }
+      }
+      if (const auto* v = std::get_if<Uuid>(&value)) {
+        if (v->bytes().size() == length) {
+          ::parquet::FLBA flba(v->bytes().data());
+          return bloom_filter.Hash(&flba, length);
+        }
+      }
+      if (const auto* v = std::get_if<Decimal>(&value)) {
+        // Decimals are stored as big-endian two's complement values, sign-extended to
+        // the length of the column.
+        auto minimal = v->ToBigEndian();
+        if (minimal.size() <= length) {
+          std::vector<uint8_t> bytes(length - minimal.size(), v->IsNegative() ? 0xff : 0);
+          bytes.insert(bytes.end(), minimal.begin(), minimal.end());
+          ::parquet::FLBA flba(bytes.data());
+          return bloom_filter.Hash(&flba, length);
+        }
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  return std::nullopt;
+}
+
+/// \brief Evaluates equality and IN predicates against the bloom filters of a row group.
+class BloomFilterVisitor : public BoundVisitor<bool> {
+ public:
+  BloomFilterVisitor(const ::parquet::SchemaDescriptor& parquet_schema,
+                     const std::unordered_map<int32_t, int>& column_indices,
+                     const BloomFilterLookup& bloom_filter)
+      : parquet_schema_(parquet_schema),
+        column_indices_(column_indices),
+        bloom_filter_(bloom_filter) {}
+
+  Result<bool> AlwaysTrue() override { return kRowsMightMatch; }
+
+  Result<bool> AlwaysFalse() override { return kRowsCannotMatch; }
+
+  Result<bool> Not(bool child_result) override {
+    return InvalidExpression("Cannot evaluate not expression, rewrite it first");
+  }
+
+  Result<bool> And(bool left_result, bool right_result) override {
+    return left_result && right_result;
+  }
+
+  Result<bool> Or(bool left_result, bool right_result) override {
+    return left_result || right_result;
+  }
+
+  Result<bool> IsNull(const std::shared_ptr<BoundTerm>& term) override {
+    return kRowsMightMatch;
+  }
+
+  Result<bool> NotNull(const std::shared_ptr<BoundTerm>& term) override {
+    return kRowsMightMatch;
+  }
+
+  Result<bool> IsNaN(const std::shared_ptr<BoundTerm>& term) override {
+    return kRowsMightMatch;
+  }
+
+  Result<bool> NotNaN(const std::shared_ptr<BoundTerm>& term) override {
+    return kRowsMightMatch;
+  }
+
+  Result<bool> Lt(const std::shared_ptr<BoundTerm>& term, const Literal& lit) override {
+    return kRowsMightMatch;
+  }
+
+  Result<bool> LtEq(const std::shared_ptr<BoundTerm>& term, const Literal& lit) override {
+    return kRowsMightMatch;
+  }
+
+  Result<bool> Gt(const std::shared_ptr<BoundTerm>& term, const Literal& lit) override {
+    return kRowsMightMatch;
+  }
+
+  Result<bool> GtEq(const std::shared_ptr<BoundTerm>& term, const Literal& lit) override {
+    return kRowsMightMatch;
+  }
+
+  Result<bool> Eq(const std::shared_ptr<BoundTerm>& term, const Literal& lit) override {
+    return MightContain(term, {lit.value()});
+  }
+
+  Result<bool> NotEq(const std::shared_ptr<BoundTerm>& term,
+                     const Literal& lit) override {
+    return kRowsMightMatch;
+  }
+
+  Result<bool> In(const std::shared_ptr<BoundTerm>& term,
+                  const BoundSetPredicate::LiteralSet& literal_set) override {
+    return MightContain(term, literal_set.values());
+  }
+
+  Result<bool> NotIn(const std::shared_ptr<BoundTerm>& term,
+                     const BoundSetPredicate::LiteralSet& literal_set) override {
+    return kRowsMightMatch;
+  }
+
+  Result<bool> StartsWith(const std::shared_ptr<BoundTerm>& term,
+                          const Literal& lit) override {
+    return kRowsMightMatch;
+  }
+
+  Result<bool> NotStartsWith(const std::shared_ptr<BoundTerm>& term,
+                             const Literal& lit) override {
+    return kRowsMightMatch;
+  }
+
+ private:
+  Result<bool> MightContain(const std::shared_ptr<BoundTerm>& term,
+                            const std::vector<Literal::Value>& values) {
+    if (term->kind() != Term::Kind::kReference) {
+      return kRowsMightMatch;
+    }
+    auto it = column_indices_.find(term->reference()->field().field_id());
+    if (it == column_indices_.end()) {
+      return kRowsMightMatch;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto bloom_filter, bloom_filter_(it->second));
+    if (bloom_filter == nullptr) {
+      return kRowsMightMatch;
+    }
+
+    const auto* descr = parquet_schema_.Column(it->second);
+    for (const auto& value : values) {
+      auto hash = HashValue(*bloom_filter, *descr, value);
+      if (!hash.has_value() || bloom_filter->FindHash(*hash)) {
+        return kRowsMightMatch;
+      }
+    }
+    return kRowsCannotMatch;
+  }
+
+  const ::parquet::SchemaDescriptor& parquet_schema_;
+  const std::unordered_map<int32_t, int>& column_indices_;
+  const BloomFilterLookup& bloom_filter_;
+};
+
+/// \brief Computes the rows of a row group that may match an expression from the
+/// column index and offset index of the filtered columns.
+class PageIndexVisitor : public ExpressionVisitor<RowRanges> {
+ public:
+  PageIndexVisitor(const Schema& schema,
+                   const ::parquet::SchemaDescriptor& parquet_schema,
+                   const std::unordered_map<int32_t, int>& column_indices,
+                   ::parquet::RowGroupPageIndexReader* page_index_reader,
+                   int64_t num_rows)
+      : schema_(schema),
+        parquet_schema_(parquet_schema),
+        column_indices_(column_indices),
+        page_index_reader_(page_index_reader),
+        num_rows_(num_rows) {}
+
+  Result<RowRanges> AlwaysTrue() override { return AllRows(); }
+
+  Result<RowRanges> AlwaysFalse() override { return RowRanges{}; }
+
+  Result<RowRanges> Not(RowRanges child_result) override {
+    return InvalidExpression("Cannot evaluate not expression, rewrite it first");
+  }
+
+  Result<RowRanges> And(RowRanges left_result, RowRanges right_result) override {
+    return Intersect(left_result, right_result);
+  }
+
+  Result<RowRanges> Or(RowRanges left_result, RowRanges right_result) override {
+    return Union(left_result, right_result);
+  }
+
+  Result<RowRanges> Predicate(const std::shared_ptr<BoundPredicate>& pred) override {
+    if (pred->term()->kind() != Term::Kind::kReference) {
+      return AllRows();
+    }
+    const int32_t field_id = pred->term()->reference()->field().field_id();
+    auto it = column_indices_.find(field_id);
+    if (it == column_indices_.end()) {
+      return AllRows();
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto field, schema_.FindFieldById(field_id));
+    if (!field.has_value()) {
+      return AllRows();
+    }
+
+    std::shared_ptr<::parquet::ColumnIndex> column_index;
+    std::shared_ptr<::parquet::OffsetIndex> offset_index;
+    try {
+      column_index = page_index_reader_->GetColumnIndex(it->second);
+      offset_index = page_index_reader_->GetOffsetIndex(it->second);
+    } catch (const ::parquet::ParquetException& e) {
+      return IOError("Failed to read page index of column {}: {}", it->second, e.what());
+    }
+    if (column_index == nullptr || offset_index == nullptr) {
+      return AllRows();
+    }
+    const auto& pages = offset_index->page_locations();
+    const auto& null_pages = column_index->null_pages();
+    const auto& min_values = column_index->encoded_min_values();
+    const auto& max_values = column_index->encoded_max_values();
+    if (null_pages.size() != pages.size() || min_values.size() != pages.size() ||
+        max_values.size() != pages.size()) {
+      return AllRows();
+    }
+
+    // Evaluate the predicate against every page as if the page was a data file.
+    ICEBERG_ASSIGN_OR_RAISE(auto evaluator,
+                            InclusiveMetricsEvaluator::Make(pred, schema_));
+    const auto* descr = parquet_schema_.Column(it->second);
+    RowRanges ranges;
+    for (size_t i = 0; i < pages.size(); ++i) {
+      const int64_t first_row = pages[i].first_row_index;
+      const int64_t end_row =
+          i + 1 < pages.size() ? pages[i + 1].first_row_index : num_rows_;
+
+      DataFile metrics;
+      metrics.record_count = end_row - first_row;
+      metrics.value_counts[field_id] = end_row - first_row;
+      if (null_pages[i]) {
+        metrics.null_value_counts[field_id] = end_row - first_row;
+      } else {
+        if (column_index->has_null_counts()) {
+          metrics.null_value_counts[field_id] = column_index->null_counts()[i];
+        }
+        ICEBERG_RETURN_UNEXPECTED(
+            SetBounds(*descr, field->get(), min_values[i], max_values[i], metrics));
+      }
+
+      ICEBERG_ASSIGN_OR_RAISE(auto might_match, evaluator->Evaluate(metrics));
+      if (!might_match) {
+        continue;
+      }
+      if (!ranges.empty() && ranges.back().second == first_row) {
+        ranges.back().second = end_row;
+      } else {
+        ranges.emplace_back(first_row, end_row);
+      }
+    }
+    return ranges;
+  }
+
+  Result<RowRanges> Predicate(const std::shared_ptr<Unbound<Expression>>& pred) override {
+    return InvalidExpression("Found unbound predicate while visiting bound expression");
+  }
+
+ private:
+  RowRanges AllRows() const { return {{0, num_rows_}}; }
+
+  const Schema& schema_;
+  const ::parquet::SchemaDescriptor& parquet_schema_;
+  const std::unordered_map<int32_t, int>& column_indices_;
+  ::parquet::RowGroupPageIndexReader* page_index_reader_;
+  int64_t num_rows_;
+};
+
+}  // namespace
+
+Result<bool> MightMatchBloomFilters(
+    const std::shared_ptr<Expression>& filter,
+    const ::parquet::SchemaDescriptor& parquet_schema,
+    const std::unordered_map<int32_t, int>& column_indices,
+    const BloomFilterLookup& bloom_filter) {
+  BloomFilterVisitor visitor(parquet_schema, column_indices, bloom_filter);
+  return Visit<bool>(filter, visitor);
+}
+
+RowGroupFilter::RowGroupFilter(
+    std::shared_ptr<Expression> filter,
+    std::unique_ptr<InclusiveMetricsEvaluator> metrics_evaluator,
+    std::shared_ptr<Schema> schema, ::parquet::ParquetFileReader* file_reader,
+    const std::unordered_map<int32_t, const VariantPathAttributes*>& variant_paths)
+    : filter_(std::move(filter)),
+      metrics_evaluator_(std::move(metrics_evaluator)),
+      schema_(std::move(schema)),
+      file_reader_(file_reader) {
+  auto parquet_schema = file_reader_->metadata()->schema();
+  for (int i = 0; i < parquet_schema->num_columns(); ++i) {
+    const auto* descr = parquet_schema->Column(i);
+    // Statistics of columns in lists and maps count elements instead of rows.
+    if (descr->max_repetition_level() > 0) {
+      continue;
+    }
+    const int32_t field_id = descr->schema_node()->field_id();
+    if (field_id >= 0) {
+      column_indices_.emplace(field_id, i);
+    }
+  }
+  for (const auto& [field_id, path] : variant_paths) {
+    if (path->typed_column.has_value()) {
+      column_indices_[field_id] = path->typed_column.value();
+      variant_value_columns_.emplace(field_id, path->value_columns);
+    }
+  }
+}
+
+std::unordered_map<int32_t, int> RowGroupFilter::ColumnIndices(int row_group) const {
+  if (variant_value_columns_.empty()) {
+    return column_indices_;
+  }
+  auto row_group_metadata = file_reader_->metadata()->RowGroup(row_group);
+  auto column_indices = column_indices_;
+  for (const auto& [field_id, value_columns] : variant_value_columns_) {
+    // The values of the path are its typed values if all of its values are shredded.
+    const bool shredded = std::ranges::all_of(value_columns, [&](int32_t column) {
+      auto column_chunk = row_group_metadata->ColumnChunk(column);
+      if (!column_chunk->is_stats_set()) {
+        return false;
+      }
+      auto statistics = column_chunk->statistics();
+      return statistics->HasNullCount() &&
+             statistics->null_count() == row_group_metadata->num_rows();
+    });
+    if (!shredded) {
+      column_indices.erase(field_id);
+    }
+  }
+  return column_indices;
+}
+
+RowGroupFilter::~RowGroupFilter() = default;
+
+Result<std::unique_ptr<RowGroupFilter>> RowGroupFilter::Make(
+    const std::shared_ptr<Expression>& filter, std::shared_ptr<Schema> schema,
+    ::parquet::ParquetFileReader* file_reader,
+    const std::unordered_map<int32_t, const VariantPathAttributes*>& variant_paths) {
+  ICEBERG_ASSIGN_OR_RAISE(auto bound, RewriteNot::Rewrite(filter));
+  ICEBERG_ASSIGN_OR_RAISE(auto is_bound, Binder::IsBound(bound));
+  if (!is_bound) {
+    ICEBERG_ASSIGN_OR_RAISE(bound,
+                            Binder::Bind(*schema, bound, /*case_sensitive=*/true));
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto metrics_evaluator,
+                          InclusiveMetricsEvaluator::Make(bound, *schema));
+  return std::unique_ptr<RowGroupFilter>(
+      new RowGroupFilter(std::move(bound), std::move(metrics_evaluator),
+                         std::move(schema), file_reader, variant_paths));
+}
+
+Result<bool> RowGroupFilter::ShouldRead(int row_group) const {
+  auto row_group_metadata = file_reader_->metadata()->RowGroup(row_group);
+
+  // Translate the column chunk statistics into data file metrics, which the metrics
+  // evaluator already knows how to evaluate.
+  DataFile metrics;
+  metrics.record_count = row_group_metadata->num_rows();
+  const auto column_indices = ColumnIndices(row_group);
+  for (const auto& [field_id, column_index] : column_indices) {
+    auto column_chunk = row_group_metadata->ColumnChunk(column_index);
+    if (!column_chunk->is_stats_set()) {
+      continue;
+    }
+    auto statistics = column_chunk->statistics();
+    metrics.value_counts[field_id] = row_group_metadata->num_rows();
+    if (statistics->HasNullCount()) {
+      metrics.null_value_counts[field_id] = statistics->null_count();
+    }
+    if (!statistics->HasMinMax()) {
+      continue;
+    }
+
+    ICEBERG_ASSIGN_OR_RAISE(auto field, schema_->FindFieldById(field_id));
+    if (field.has_value()) {
+      ICEBERG_RETURN_UNEXPECTED(
+          SetBounds(*file_reader_->metadata()->schema()->Column(column_index),
+                    field->get(), statistics->EncodeMin(), statistics->EncodeMax(),
+                    metrics));
+    }
+  }
+
+  ICEBERG_ASSIGN_OR_RAISE(auto might_match, metrics_evaluator_->Evaluate(metrics));
+  if (!might_match) {
+    return kRowsCannotMatch;
+  }
+
+  // Bloom filters are read on first use, only for the columns of equality and IN
+  // predicates.
+  std::shared_ptr<::parquet::RowGroupBloomFilterReader> row_group_reader;
+  std::unordered_map<int, std::unique_ptr<::parquet::BloomFilter>> bloom_filters;
+  BloomFilterLookup bloom_filter =
+      [&](int column_index) -> Result<const ::parquet::BloomFilter*> {
+    auto [it, inserted] = bloom_filters.try_emplace(column_index);
+    if (!inserted) {
+      return it->second.get();
+    }
+    try {
+      if (row_group_reader == nullptr) {
+        row_group_reader = file_reader_->GetBloomFilterReader().RowGroup(row_group);
+      }
+      if (row_group_reader != nullptr) {
+        it->second = row_group_reader->GetColumnBloomFilter(column_index);
+      }
+    } catch (const ::parquet::ParquetException& e) {
+      return IOError("Failed to read bloom filter of column {} in row group {}: {}",
+                     column_index, row_group, e.what());
+    }
+    return it->second.get();
+  };
+  return MightMatchBloomFilters(filter_, *file_reader_->metadata()->schema(),
+                                column_indices, bloom_filter);
+}
+
+Result<RowRanges> RowGroupFilter::SelectRows(int row_group) const {
+  const int64_t num_rows = file_reader_->metadata()->RowGroup(row_group)->num_rows();
+  std::shared_ptr<::parquet::RowGroupPageIndexReader> page_index_reader;
+  try {
+    auto file_page_index_reader = file_reader_->GetPageIndexReader();
+    if (file_page_index_reader != nullptr) {
+      page_index_reader = file_page_index_reader->RowGroup(row_group);
+    }
+  } catch (const ::parquet::ParquetException& e) {
+    return IOError("Failed to read page index of row group {}: {}", row_group, e.what());
+  }
+  if (page_index_reader == nullptr) {
+    return RowRanges{{0, num_rows}};
+  }
+
+  const auto column_indices = ColumnIndices(row_group);
+  PageIndexVisitor visitor(*schema_, *file_reader_->metadata()->schema(), column_indices,
+                           page_index_reader.get(), num_rows);
+  return Visit<RowRanges>(filter_, visitor);
+}
+
+}  // namespace iceberg::parquet
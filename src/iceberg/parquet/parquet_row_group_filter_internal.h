@@ -0,0 +1,132 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <parquet/bloom_filter.h>
+#include <parquet/file_reader.h>
+#include <parquet/schema.h>
+
+#include "iceberg/expression/expression.h"
+#include "iceberg/expression/inclusive_metrics_evaluator.h"
+#include "iceberg/result.h"
+#include "iceberg/schema.h"
+
+namespace iceberg::parquet {
+
+struct VariantPathAttributes;
+
+/// \brief Sorted, disjoint and half-open ranges of row positions in a row group.
+using RowRanges = std::vector<std::pair<int64_t, int64_t>>;
+
+/// \brief Returns the bloom filter of a column by its index in the Parquet file, or
+/// nullptr if the column does not have one.
+using BloomFilterLookup =
+    std::function<Result<const ::parquet::BloomFilter*>(int column_index)>;
+
+/// \brief Test whether a row group may contain rows that match a filter by the bloom
+/// filters of its columns.
+///
+/// Only equality and IN predicates are checked. Their values are hashed as values of
+/// the physical type of the column, so a value that does not have that type, e.g. a
+/// long value of a column written as int before it was promoted, might match.
+///
+/// \param filter A bound expression without NOT nodes.
+/// \param parquet_schema The schema of the Parquet file.
+/// \param column_indices Iceberg field id to the index of its leaf column in the file.
+/// \param bloom_filter Returns the bloom filters of the columns in the row group.
+/// \return false if the row group cannot contain matching rows, true otherwise.
+Result<bool> MightMatchBloomFilters(
+    const std::shared_ptr<Expression>& filter,
+    const ::parquet::SchemaDescriptor& parquet_schema,
+    const std::unordered_map<int32_t, int>& column_indices,
+    const BloomFilterLookup& bloom_filter);
+
+/// \brief Selects the row groups of a Parquet file that may contain rows matching a
+/// filter.
+///
+/// A row group is skipped when the min/max/null-count statistics of its column chunks
+/// rule out the filter, or when the bloom filter of a column rules out every value of
+/// an equality or IN predicate on it. Within a row group, the page index narrows the
+/// selection down to the pages that may contain matching rows. Columns without field
+/// ids, columns nested in repeated fields and statistics that cannot be converted to the
+/// Iceberg type of the column are ignored, so they never cause rows to be skipped.
+///
+/// Fields read from paths of shredded variant columns are filtered by the typed values
+/// of the path, in the row groups where no value on the path is left unshredded.
+class RowGroupFilter {
+ public:
+  ~RowGroupFilter();
+
+  /// \brief Creates a row group filter.
+  ///
+  /// \param filter A bound or unbound expression on the read schema.
+  /// \param schema The Iceberg schema to bind the filter to.
+  /// \param file_reader The Parquet file whose row groups are selected.
+  /// \param variant_paths The fields of the schema read from paths of variant columns,
+  /// as returned by VariantPathFields.
+  static Result<std::unique_ptr<RowGroupFilter>> Make(
+      const std::shared_ptr<Expression>& filter, std::shared_ptr<Schema> schema,
+      ::parquet::ParquetFileReader* file_reader,
+      const std::unordered_map<int32_t, const VariantPathAttributes*>& variant_paths =
+          {});
+
+  /// \brief Test whether a row group may contain rows that match the filter.
+  ///
+  /// \param row_group The index of the row group in the file.
+  /// \return false if the row group cannot contain matching rows, true otherwise.
+  Result<bool> ShouldRead(int row_group) const;
+
+  /// \brief Returns the rows of a row group that may match the filter.
+  ///
+  /// Rows are selected by the column index and offset index of the filtered columns.
+  /// All rows are selected if the file does not have a page index.
+  ///
+  /// \param row_group The index of the row group in the file.
+  /// \return The ranges of selected row positions, relative to the row group.
+  Result<RowRanges> SelectRows(int row_group) const;
+
+ private:
+  RowGroupFilter(
+      std::shared_ptr<Expression> filter,
+      std::unique_ptr<InclusiveMetricsEvaluator> metrics_evaluator,
+      std::shared_ptr<Schema> schema, ::parquet::ParquetFileReader* file_reader,
+      const std::unordered_map<int32_t, const VariantPathAttributes*>& variant_paths);
+
+  /// \brief Returns the columns whose values are the values of the fields in a row
+  /// group, by field id.
+  std::unordered_map<int32_t, int> ColumnIndices(int row_group) const;
+
+  std::shared_ptr<Expression> filter_;
+  std::unique_ptr<InclusiveMetricsEvaluator> metrics_evaluator_;
+  std::shared_ptr<Schema> schema_;
+  ::parquet::ParquetFileReader* file_reader_;
+  // Iceberg field id to the index of its leaf column in the Parquet file.
+  std::unordered_map<int32_t, int> column_indices_;
+  // Field id of a variant path in column_indices_ to the value columns on the path.
+  std::unordered_map<int32_t, std::vector<int32_t>> variant_value_columns_;
+};
+
+}  // namespace iceberg::parquet
@@ -25,12 +25,14 @@
 #include <arrow/util/key_value_metadata.h>
 #include <parquet/arrow/schema.h>
 #include <parquet/schema.h>
+#include <parquet/types.h>
 
 #include "iceberg/constants.h"
 #include "iceberg/metadata_columns.h"
 #include "iceberg/parquet/parquet_schema_util_internal.h"
 #include "iceberg/result.h"
 #include "iceberg/schema_util_internal.h"
+#include "iceberg/type.h"
 #include "iceberg/util/checked_cast.h"
 #include "iceberg/util/formatter.h"
 #include "iceberg/util/macros.h"
@@ -39,6 +41,22 @@ namespace iceberg::parquet {
 
 namespace {
 
+bool IsMicros(const ::parquet::ColumnDescriptor& descr) {
+  const auto& logical_type = descr.logical_type();
+  if (logical_type == nullptr) {
+    return false;
+  }
+  if (logical_type->is_timestamp()) {
+    return internal::checked_cast<const ::parquet::TimestampLogicalType&>(*logical_type)
+               .time_unit() == ::parquet::LogicalType::TimeUnit::MICROS;
+  }
+  if (logical_type->is_time()) {
+    return internal::checked_cast<const ::parquet::TimeLogicalType&>(*logical_type)
+               .time_unit() == ::parquet::LogicalType::TimeUnit::MICROS;
+  }
+  return false;
+}
+
 std::optional<int32_t> FieldIdFromMetadata(
     const std::shared_ptr<const ::arrow::KeyValueMetadata>& metadata) {
   if (!metadata) {
@@ -117,6 +135,10 @@ Status ValidateParquetSchemaEvolution(
           return {};
         }
       }
+      // Dates can be promoted to timestamps since format version 3.
+      if (arrow_type->id() == ::arrow::Type::DATE32) {
+        return {};
+      }
       break;
     case TypeId::kTimestampTz:
       if (arrow_type->id() == ::arrow::Type::TIMESTAMP) {
@@ -158,6 +180,12 @@ Status ValidateParquetSchemaEvolution(
           return {};
         }
       }
+      // Files written without the UUID logical type store UUIDs as 16-byte binary.
+      if (arrow_type->id() == ::arrow::Type::FIXED_SIZE_BINARY &&
+          internal::checked_cast<const ::arrow::FixedSizeBinaryType&>(*arrow_type)
+                  .byte_width() == 16) {
+        return {};
+      }
       break;
     case TypeId::kFixed:
       if (arrow_type->id() == ::arrow::Type::FIXED_SIZE_BINARY) {
@@ -184,6 +212,16 @@ Status ValidateParquetSchemaEvolution(
         return {};
       }
       break;
+    case TypeId::kVariant:
+      // Groups annotated as variants are read as an extension type of a struct.
+      if (arrow_type->id() == ::arrow::Type::STRUCT ||
+          (arrow_type->id() == ::arrow::Type::EXTENSION &&
+           internal::checked_cast<const ::arrow::ExtensionType&>(*arrow_type)
+                   .storage_type()
+                   ->id() == ::arrow::Type::STRUCT)) {
+        return {};
+      }
+      break;
     default:
       break;
   }
@@ -197,9 +235,140 @@ Result<FieldProjection> ProjectNested(
     const Type& nested_type,
     const std::vector<::parquet::arrow::SchemaField>& parquet_fields);
 
+/// \brief Returns the field of a group with a name, or nullptr if it has none.
+const ::parquet::arrow::SchemaField* FindChild(const ::parquet::arrow::SchemaField& group,
+                                               std::string_view name) {
+  for (const auto& child : group.children) {
+    if (child.field->name() == name) {
+      return &child;
+    }
+  }
+  return nullptr;
+}
+
+/// \brief Projects a leaf column of the group of a variant column.
+Result<FieldProjection> ProjectVariantColumn(const ::parquet::arrow::SchemaField& group,
+                                             const ::parquet::arrow::SchemaField& leaf) {
+  if (leaf.column_index < 0) {
+    return InvalidSchema("Variant field {} must be a primitive column",
+                         leaf.field->name());
+  }
+  FieldProjection projection;
+  projection.kind = FieldProjection::Kind::kProjected;
+  projection.from = static_cast<size_t>(&leaf - group.children.data());
+  projection.attributes = std::make_shared<ParquetExtraAttributes>(leaf.column_index);
+  return projection;
+}
+
+/// \brief Projects a variant column on the metadata and value columns of its group.
+Result<FieldProjection> ProjectVariant(
+    const ::parquet::arrow::SchemaField& parquet_field) {
+  if (FindChild(parquet_field, kVariantTypedValueName) != nullptr) {
+    return NotSupported(
+        "Cannot read the shredded variant column {} as a whole, only paths of it",
+        parquet_field.field->name());
+  }
+  const auto* metadata = FindChild(parquet_field, kVariantMetadataName);
+  const auto* value = FindChild(parquet_field, kVariantValueName);
+  if (metadata == nullptr || value == nullptr) {
+    return InvalidSchema("Variant column {} must have a metadata and a value field",
+                         parquet_field.field->name());
+  }
+  FieldProjection result;
+  for (const auto* leaf : {metadata, value}) {
+    ICEBERG_ASSIGN_OR_RAISE(auto projection, ProjectVariantColumn(parquet_field, *leaf));
+    result.children.push_back(std::move(projection));
+  }
+  return result;
+}
+
+/// \brief Returns whether the typed values of a shredded variant path are read as
+/// values of a type.
+///
+/// Typed values of other types are not read, as values of other types are read as null
+/// whether they are shredded or not.
+Result<bool> CanReadTypedValues(const Type& type,
+                                const ::parquet::arrow::SchemaField& typed_value) {
+  if (typed_value.column_index < 0) {
+    return false;
+  }
+  const auto arrow_type = typed_value.field->type()->id();
+  const bool is_integer =
+      arrow_type == ::arrow::Type::INT8 || arrow_type == ::arrow::Type::INT16 ||
+      arrow_type == ::arrow::Type::INT32 || arrow_type == ::arrow::Type::INT64;
+  if (type.type_id() == TypeId::kInt && is_integer) {
+    if (arrow_type == ::arrow::Type::INT64) {
+      // Only the values that fit are read, which cannot be told from the column type.
+      return NotSupported("Cannot read long values of a variant path as int values");
+    }
+    return true;
+  }
+  if (type.type_id() == TypeId::kLong && is_integer) {
+    return true;
+  }
+  return ValidateParquetSchemaEvolution(type, typed_value).has_value();
+}
+
+/// \brief Projects a field read from a path of a variant column on the columns of its
+/// group.
+///
+/// The values of the path are in the value column of the variant, unless the variant
+/// is an object shredded into the fields of its typed_value group. Each of these fields
+/// has a value column and may in turn be shredded, up to the typed values of the path.
+Result<FieldProjection> ProjectVariantPath(
+    const SchemaField& field, const ::parquet::arrow::SchemaField& parquet_field,
+    const std::vector<std::string>& names) {
+  if (!field.type()->is_primitive() || !field.optional()) {
+    return InvalidSchema("Variant path field {} must be an optional primitive field",
+                         field.name());
+  }
+  const auto* metadata = FindChild(parquet_field, kVariantMetadataName);
+  if (metadata == nullptr) {
+    return InvalidSchema("Variant column {} must have a metadata field",
+                         parquet_field.field->name());
+  }
+
+  FieldProjection result;
+  ICEBERG_ASSIGN_OR_RAISE(auto metadata_projection,
+                          ProjectVariantColumn(parquet_field, *metadata));
+  result.children.push_back(std::move(metadata_projection));
+  std::vector<int32_t> value_columns;
+  std::optional<int32_t> typed_column;
+  const auto* group = &parquet_field;
+  for (size_t depth = 0; group != nullptr; ++depth) {
+    if (const auto* value = FindChild(*group, kVariantValueName); value != nullptr) {
+      ICEBERG_ASSIGN_OR_RAISE(auto projection, ProjectVariantColumn(*group, *value));
+      result.children.push_back(std::move(projection));
+      value_columns.push_back(value->column_index);
+    }
+    const auto* typed_value = FindChild(*group, kVariantTypedValueName);
+    if (typed_value == nullptr) {
+      break;
+    }
+    if (depth == names.size()) {
+      ICEBERG_ASSIGN_OR_RAISE(auto can_read,
+                              CanReadTypedValues(*field.type(), *typed_value));
+      if (can_read) {
+        ICEBERG_ASSIGN_OR_RAISE(auto projection,
+                                ProjectVariantColumn(*group, *typed_value));
+        result.children.push_back(std::move(projection));
+        typed_column = typed_value->column_index;
+      }
+      break;
+    }
+    group = typed_value->field->type()->id() == ::arrow::Type::STRUCT
+                ? FindChild(*typed_value, names[depth])
+                : nullptr;
+  }
+  result.attributes = std::make_shared<VariantPathAttributes>(
+      names, std::move(value_columns), typed_column);
+  return result;
+}
+
 Result<FieldProjection> ProjectStruct(
     const StructType& struct_type,
-    const std::vector<::parquet::arrow::SchemaField>& parquet_fields) {
+    const std::vector<::parquet::arrow::SchemaField>& parquet_fields,
+    const std::unordered_map<int32_t, VariantPath>& variant_paths = {}) {
   struct FieldContext {
     size_t local_index;
     const ::parquet::arrow::SchemaField& parquet_field;
@@ -229,13 +398,27 @@ Result<FieldProjection> ProjectStruct(
     int32_t field_id = field.field_id();
     FieldProjection child_projection;
 
-    if (auto iter = field_context_map.find(field_id); iter != field_context_map.cend()) {
+    if (auto path = variant_paths.find(field_id); path != variant_paths.cend()) {
+      auto iter = field_context_map.find(path->second.field_id);
+      if (iter != field_context_map.cend()) {
+        ICEBERG_ASSIGN_OR_RAISE(
+            child_projection, ProjectVariantPath(field, iter->second.parquet_field,
+                                                 path->second.names));
+        child_projection.from = iter->second.local_index;
+        child_projection.kind = FieldProjection::Kind::kProjected;
+      } else {
+        child_projection.kind = FieldProjection::Kind::kNull;
+      }
+    } else if (auto iter = field_context_map.find(field_id);
+               iter != field_context_map.cend()) {
       const auto& parquet_field = iter->second.parquet_field;
       ICEBERG_RETURN_UNEXPECTED(
           ValidateParquetSchemaEvolution(*field.type(), parquet_field));
       if (field.type()->is_nested()) {
         ICEBERG_ASSIGN_OR_RAISE(child_projection,
                                 ProjectNested(*field.type(), parquet_field.children));
+      } else if (field.type()->type_id() == TypeId::kVariant) {
+        ICEBERG_ASSIGN_OR_RAISE(child_projection, ProjectVariant(parquet_field));
       } else {
         child_projection.attributes =
             std::make_shared<ParquetExtraAttributes>(parquet_field.column_index);
@@ -393,14 +576,28 @@ void CollectColumnIds(const FieldProjection& field_projection,
 
 }  // namespace
 
-Result<SchemaProjection> Project(const Schema& expected_schema,
-                                 const ::parquet::arrow::SchemaManifest& parquet_schema) {
-  ICEBERG_ASSIGN_OR_RAISE(auto field_projection,
-                          ProjectNested(static_cast<const Type&>(expected_schema),
-                                        parquet_schema.schema_fields));
+Result<SchemaProjection> Project(
+    const Schema& expected_schema, const ::parquet::arrow::SchemaManifest& parquet_schema,
+    const std::unordered_map<int32_t, VariantPath>& variant_paths) {
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto field_projection,
+      ProjectStruct(expected_schema, parquet_schema.schema_fields, variant_paths));
   return SchemaProjection{std::move(field_projection.children)};
 }
 
+std::unordered_map<int32_t, const VariantPathAttributes*> VariantPathFields(
+    const Schema& schema, const SchemaProjection& projection) {
+  std::unordered_map<int32_t, const VariantPathAttributes*> fields;
+  const auto& schema_fields = schema.fields();
+  for (size_t i = 0; i < schema_fields.size() && i < projection.fields.size(); ++i) {
+    if (const auto* attributes = dynamic_cast<const VariantPathAttributes*>(
+            projection.fields[i].attributes.get())) {
+      fields.emplace(schema_fields[i].field_id(), attributes);
+    }
+  }
+  return fields;
+}
+
 std::vector<int32_t> SelectedColumnIndices(const SchemaProjection& projection) {
   std::vector<int32_t> column_ids;
   for (const auto& field : projection.fields) {
@@ -427,4 +624,61 @@ bool HasFieldIds(const ::parquet::schema::NodePtr& node) {
   return false;
 }
 
+std::shared_ptr<PrimitiveType> StatisticsType(const ::parquet::ColumnDescriptor& descr,
+                                              TypeId type_id) {
+  switch (descr.physical_type()) {
+    case ::parquet::Type::BOOLEAN:
+      if (type_id == TypeId::kBoolean) {
+        return boolean();
+      }
+      break;
+    case ::parquet::Type::INT32:
+      if (type_id == TypeId::kInt || type_id == TypeId::kLong) {
+        return int32();
+      }
+      if (type_id == TypeId::kDate) {
+        return date();
+      }
+      break;
+    case ::parquet::Type::INT64:
+      if (type_id == TypeId::kLong) {
+        return int64();
+      }
+      if (!IsMicros(descr)) {
+        break;
+      }
+      if (type_id == TypeId::kTime) {
+        return time();
+      }
+      if (type_id == TypeId::kTimestamp) {
+        return timestamp();
+      }
+      if (type_id == TypeId::kTimestampTz) {
+        return timestamp_tz();
+      }
+      break;
+    case ::parquet::Type::FLOAT:
+      if (type_id == TypeId::kFloat || type_id == TypeId::kDouble) {
+        return float32();
+      }
+      break;
+    case ::parquet::Type::DOUBLE:
+      if (type_id == TypeId::kDouble) {
+        return float64();
+      }
+      break;
+    case ::parquet::Type::BYTE_ARRAY:
+      if (type_id == TypeId::kString) {
+        return string();
+      }
+      if (type_id == TypeId::kBinary) {
+        return binary();
+      }
+      break;
+    default:
+      break;
+  }
+  return nullptr;
+}
+
 }  // namespace iceberg::parquet
@@ -20,23 +20,62 @@
 #pragma once
 
 #include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include <parquet/arrow/schema.h>
+#include <parquet/schema.h>
 
+#include "iceberg/file_reader.h"
 #include "iceberg/schema.h"
 #include "iceberg/schema_util.h"
+#include "iceberg/type.h"
 
 namespace iceberg::parquet {
 
+/// \brief Names of the fields of the group of a variant column, whose values are
+/// shredded into `typed_value` when it is present.
+constexpr std::string_view kVariantMetadataName = "metadata";
+constexpr std::string_view kVariantValueName = "value";
+constexpr std::string_view kVariantTypedValueName = "typed_value";
+
 /// \brief Parquet specific attributes for the field.
 struct ParquetExtraAttributes : public FieldProjection::ExtraAttributes {
-  explicit ParquetExtraAttributes(int32_t column_id) : column_id(column_id) {}
+  explicit ParquetExtraAttributes(std::optional<int32_t> column_id)
+      : column_id(column_id) {}
   ~ParquetExtraAttributes() override = default;
 
   /// \brief The column id of projected Parquet column.
   std::optional<int32_t> column_id;
 };
 
+/// \brief Parquet specific attributes of a field read from a path of a variant column.
+///
+/// The field is projected from the group of the variant column, and the children of
+/// its projection are the leaf columns read for the path. As the groups read are pruned
+/// of the columns that are not read, the arrays of the path are found by name.
+struct VariantPathAttributes : public ParquetExtraAttributes {
+  VariantPathAttributes(std::vector<std::string> names,
+                        std::vector<int32_t> value_columns,
+                        std::optional<int32_t> typed_column)
+      : ParquetExtraAttributes(std::nullopt),
+        names(std::move(names)),
+        value_columns(std::move(value_columns)),
+        typed_column(typed_column) {}
+  ~VariantPathAttributes() override = default;
+
+  /// \brief The names of the object fields of the path.
+  std::vector<std::string> names;
+  /// \brief The value columns of the variant and of each shredded field on the path,
+  /// which hold the values that are not shredded.
+  std::vector<int32_t> value_columns;
+  /// \brief The column of the typed values of the path, if the path is shredded with
+  /// a type that is read as the type of the field.
+  std::optional<int32_t> typed_column;
+};
+
 /// \brief Project an Iceberg Schema onto a Parquet Schema.
 ///
 /// This function creates a projection from an Iceberg Schema to a Parquet schema.
@@ -45,10 +84,21 @@ struct ParquetExtraAttributes : public FieldProjection::ExtraAttributes {
 ///
 /// \param expected_schema The Iceberg Schema that defines the expected structure.
 /// \param parquet_schema The Parquet schema to read data from.
+/// \param variant_paths The top-level fields read from paths of variant columns, by
+/// field id, which are projected with VariantPathAttributes.
 /// \return The schema projection result with column indices of projected Parquet columns
 /// specified via ParquetExtraAttributes.
-Result<SchemaProjection> Project(const Schema& expected_schema,
-                                 const ::parquet::arrow::SchemaManifest& parquet_schema);
+Result<SchemaProjection> Project(
+    const Schema& expected_schema, const ::parquet::arrow::SchemaManifest& parquet_schema,
+    const std::unordered_map<int32_t, VariantPath>& variant_paths = {});
+
+/// \brief Returns the attributes of the top-level fields of a projection that are read
+/// from paths of variant columns, by field id.
+///
+/// \param schema The projected Iceberg schema.
+/// \param projection The projection of the schema returned by `Project`.
+std::unordered_map<int32_t, const VariantPathAttributes*> VariantPathFields(
+    const Schema& schema, const SchemaProjection& projection);
 
 /// \brief Get the selected column indices by walking through the projection result.
 ///
@@ -62,4 +112,12 @@ std::vector<int32_t> SelectedColumnIndices(const SchemaProjection& projection);
 /// \return True if the Parquet schema has field IDs, false otherwise.
 bool HasFieldIds(const ::parquet::schema::NodePtr& root_node);
 
+/// \brief Returns the type of the values that a Parquet column stores for an Iceberg
+/// column of the given type.
+///
+/// Returns nullptr when the Parquet min/max values of the column cannot be interpreted
+/// as Iceberg values, e.g. for decimals or timestamps in a unit other than microseconds.
+std::shared_ptr<PrimitiveType> StatisticsType(const ::parquet::ColumnDescriptor& descr,
+                                              TypeId type_id);
+
 }  // namespace iceberg::parquet
@@ -19,10 +19,20 @@
 
 #include "iceberg/parquet/parquet_writer.h"
 
+#include <algorithm>
+#include <charconv>
+#include <limits>
 #include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <arrow/c/bridge.h>
 #include <arrow/record_batch.h>
+#include <arrow/util/byte_size.h>
+#include <arrow/util/compression.h>
 #include <arrow/util/key_value_metadata.h>
 #include <parquet/arrow/schema.h>
 #include <parquet/arrow/writer.h>
@@ -30,10 +40,16 @@
 #include <parquet/properties.h>
 
 #include "iceberg/arrow/arrow_fs_file_io_internal.h"
+#include "iceberg/arrow/arrow_memory_pool_internal.h"
 #include "iceberg/arrow/arrow_status_internal.h"
+#include "iceberg/metrics_config.h"
+#include "iceberg/parquet/parquet_bloom_filter_writer_internal.h"
+#include "iceberg/schema.h"
 #include "iceberg/schema_internal.h"
-#include "iceberg/util/checked_cast.h"
+#include "iceberg/table_properties.h"
+#include "iceberg/util/arrow_metrics_internal.h"
 #include "iceberg/util/macros.h"
+#include "iceberg/util/string_util.h"
 
 namespace iceberg::parquet {
 
@@ -41,9 +57,309 @@ namespace {
 
 Result<std::shared_ptr<::arrow::io::OutputStream>> OpenOutputStream(
     const WriterOptions& options) {
-  auto io = internal::checked_pointer_cast<arrow::ArrowFileSystemFileIO>(options.io);
-  ICEBERG_ARROW_ASSIGN_OR_RETURN(auto output, io->fs()->OpenOutputStream(options.path));
-  return output;
+  return arrow::OpenArrowOutputStream(options);
+}
+
+/// \brief Returns the value of a writer property, or nullptr if it is not set.
+template <typename T>
+const std::string* FindProperty(
+    const std::unordered_map<std::string, std::string>& properties,
+    const TableProperties::Entry<T>& entry) {
+  auto it = properties.find(entry.key());
+  return it != properties.cend() ? &it->second : nullptr;
+}
+
+/// \brief Returns a positive size property, which defaults to the default of the
+/// table property.
+Result<int64_t> ParseSize(const std::unordered_map<std::string, std::string>& properties,
+                          const TableProperties::Entry<int32_t>& entry) {
+  const std::string* value = FindProperty(properties, entry);
+  if (value == nullptr) {
+    return entry.value();
+  }
+  int64_t size = 0;
+  auto [end, ec] = std::from_chars(value->data(), value->data() + value->size(), size);
+  if (ec != std::errc() || end != value->data() + value->size() || size <= 0) {
+    return InvalidArgument("Invalid {}: {}, expected a positive integer", entry.key(),
+                           *value);
+  }
+  return size;
+}
+
+Result<::arrow::Compression::type> ParseCodec(const std::string& codec) {
+  if (codec == "uncompressed") {
+    return ::arrow::Compression::UNCOMPRESSED;
+  } else if (codec == "snappy") {
+    return ::arrow::Compression::SNAPPY;
+  } else if (codec == "gzip") {
+    return ::arrow::Compression::GZIP;
+  } else if (codec == "lz4") {
+    // The LZ4 codec of Parquet, which is the Hadoop framed format.
+    return ::arrow::Compression::LZ4_HADOOP;
+  } else if (codec == "zstd") {
+    return ::arrow::Compression::ZSTD;
+  } else if (codec == "brotli") {
+    return ::arrow::Compression::BROTLI;
+  }
+  return InvalidArgument("Unsupported Parquet compression codec: {}", codec);
+}
+
+/// \brief The false positive probability of bloom filters without a configured one.
+constexpr double kDefaultBloomFilterFpp = 0.01;
+
+/// \brief Returns the indices of the Parquet leaf columns of a field of the schema,
+/// which are all the leaf columns under a struct, list or map field. A field that is
+/// not in the schema, such as a dropped field, has none.
+Result<std::vector<int>> LeafColumnsOf(
+    const std::string& name, const Schema& schema,
+    const ::parquet::SchemaDescriptor& schema_descriptor) {
+  std::vector<int> columns;
+  ICEBERG_ASSIGN_OR_RAISE(auto field, schema.FindFieldByName(name));
+  if (!field.has_value()) {
+    return columns;
+  }
+  const int32_t field_id = field->get().field_id();
+  for (int i = 0; i < schema_descriptor.num_columns(); ++i) {
+    for (const auto* node = schema_descriptor.Column(i)->schema_node().get();
+         node != nullptr; node = node->parent()) {
+      if (node->field_id() == field_id) {
+        columns.push_back(i);
+        break;
+      }
+    }
+  }
+  return columns;
+}
+
+/// \brief Returns the leaf columns with bloom filters, which are the columns of the
+/// `write.parquet.bloom-filter-enabled.column.<name>` properties with the false
+/// positive probabilities of the `write.parquet.bloom-filter-fpp.column.<name>`
+/// properties.
+///
+/// Columns that are not in the schema, such as dropped columns, are ignored. A bloom
+/// filter of a struct, list or map column is written for its leaf columns.
+Result<std::vector<BloomFilterColumn>> BloomFilterColumns(
+    const std::unordered_map<std::string, std::string>& properties, const Schema& schema,
+    const ::parquet::SchemaDescriptor& schema_descriptor) {
+  const auto enabled_prefix = TableProperties::kParquetBloomFilterColumnEnabledPrefix;
+  const auto fpp_prefix = TableProperties::kParquetBloomFilterColumnFppPrefix;
+
+  std::vector<BloomFilterColumn> columns;
+  for (const auto& [key, value] : properties) {
+    if (!key.starts_with(enabled_prefix) ||
+        !StringUtils::EqualsIgnoreCase(value, "true")) {
+      continue;
+    }
+    const std::string column = key.substr(enabled_prefix.size());
+
+    double fpp = kDefaultBloomFilterFpp;
+    if (auto it = properties.find(std::string(fpp_prefix) + column);
+        it != properties.cend()) {
+      const std::string& fpp_value = it->second;
+      auto [end, ec] =
+          std::from_chars(fpp_value.data(), fpp_value.data() + fpp_value.size(), fpp);
+      if (ec != std::errc() || end != fpp_value.data() + fpp_value.size() ||
+          !(fpp > 0 && fpp < 1)) {
+        return InvalidArgument("Invalid {}: {}, expected a probability in (0, 1)",
+                               it->first, fpp_value);
+      }
+    }
+
+    ICEBERG_ASSIGN_OR_RAISE(auto leaf_columns,
+                            LeafColumnsOf(column, schema, schema_descriptor));
+    for (int i : leaf_columns) {
+      columns.push_back({.column_index = i, .fpp = fpp});
+    }
+  }
+  return columns;
+}
+
+/// \brief Returns the encoding of a `write.parquet.encoding.column.<name>` property, or
+/// std::nullopt for dictionary encoding.
+Result<std::optional<::parquet::Encoding::type>> ParseEncoding(const std::string& key,
+                                                              const std::string& value) {
+  const std::string encoding = StringUtils::ToLower(value);
+  if (encoding == "dictionary") {
+    return std::nullopt;
+  } else if (encoding == "plain") {
+    return ::parquet::Encoding::PLAIN;
+  } else if (encoding == "delta-binary-packed") {
+    return ::parquet::Encoding::DELTA_BINARY_PACKED;
+  } else if (encoding == "delta-length-byte-array") {
+    return ::parquet::Encoding::DELTA_LENGTH_BYTE_ARRAY;
+  } else if (encoding == "delta-byte-array") {
+    return ::parquet::Encoding::DELTA_BYTE_ARRAY;
+  } else if (encoding == "byte-stream-split") {
+    return ::parquet::Encoding::BYTE_STREAM_SPLIT;
+  }
+  return InvalidArgument("Invalid {}: {}, unsupported Parquet encoding", key, value);
+}
+
+/// \brief Returns whether Parquet C++ writes values of a physical type with an
+/// encoding.
+bool SupportsEncoding(::parquet::Type::type type, ::parquet::Encoding::type encoding) {
+  switch (encoding) {
+    case ::parquet::Encoding::PLAIN:
+      return true;
+    case ::parquet::Encoding::DELTA_BINARY_PACKED:
+      return type == ::parquet::Type::INT32 || type == ::parquet::Type::INT64;
+    case ::parquet::Encoding::DELTA_LENGTH_BYTE_ARRAY:
+      return type == ::parquet::Type::BYTE_ARRAY;
+    case ::parquet::Encoding::DELTA_BYTE_ARRAY:
+      return type == ::parquet::Type::BYTE_ARRAY ||
+             type == ::parquet::Type::FIXED_LEN_BYTE_ARRAY;
+    case ::parquet::Encoding::BYTE_STREAM_SPLIT:
+      return type != ::parquet::Type::BOOLEAN && type != ::parquet::Type::INT96 &&
+             type != ::parquet::Type::BYTE_ARRAY;
+    default:
+      return false;
+  }
+}
+
+/// \brief Returns the encoding chosen for a column by the adaptive encodings, or
+/// std::nullopt to keep dictionary encoding.
+///
+/// Floating point values rarely repeat and their bytes of equal significance compress
+/// much better together, so they are split into byte streams. Sorted integers, which
+/// include dates, times and timestamps, are stored as the bit-packed deltas of
+/// consecutive values, and sorted strings as the suffixes they do not share with the
+/// previous value.
+std::optional<::parquet::Encoding::type> AdaptiveEncoding(
+    const ::parquet::ColumnDescriptor& column, bool sorted) {
+  switch (column.physical_type()) {
+    case ::parquet::Type::FLOAT:
+    case ::parquet::Type::DOUBLE:
+      return ::parquet::Encoding::BYTE_STREAM_SPLIT;
+    case ::parquet::Type::INT32:
+    case ::parquet::Type::INT64:
+      return sorted ? std::make_optional(::parquet::Encoding::DELTA_BINARY_PACKED)
+                    : std::nullopt;
+    case ::parquet::Type::BYTE_ARRAY:
+      return sorted ? std::make_optional(::parquet::Encoding::DELTA_BYTE_ARRAY)
+                    : std::nullopt;
+    default:
+      return std::nullopt;
+  }
+}
+
+/// \brief Sets the encodings of the columns of the
+/// `write.parquet.encoding.column.<name>` properties and, when
+/// `write.parquet.adaptive-encoding.enabled` is set, of the other columns whose values
+/// suit an encoding better than a dictionary.
+///
+/// Parquet C++ only uses the encoding of a column when its dictionary is disabled, so
+/// the dictionary of the columns with an encoding is disabled. The other columns keep
+/// their dictionary, which falls back to plain encoding once it exceeds
+/// `write.parquet.dict-size-bytes`. Columns are sorted when their fields are in the
+/// WriterOptions::kSortedFieldIdsProperty writer property.
+Status SetColumnEncodings(const std::unordered_map<std::string, std::string>& properties,
+                          const Schema& schema,
+                          const ::parquet::SchemaDescriptor& schema_descriptor,
+                          ::parquet::WriterProperties::Builder* builder) {
+  const auto encoding_prefix = TableProperties::kParquetColumnEncodingPrefix;
+  std::unordered_map<int, std::optional<::parquet::Encoding::type>> encodings;
+  for (const auto& [key, value] : properties) {
+    if (!key.starts_with(encoding_prefix)) {
+      continue;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto encoding, ParseEncoding(key, value));
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto columns,
+        LeafColumnsOf(key.substr(encoding_prefix.size()), schema, schema_descriptor));
+    for (int i : columns) {
+      const auto* column = schema_descriptor.Column(i);
+      if (encoding.has_value() &&
+          !SupportsEncoding(column->physical_type(), *encoding)) {
+        return InvalidArgument("Invalid {}: {}, not supported by column {}", key, value,
+                               column->path()->ToDotString());
+      }
+      encodings[i] = encoding;
+    }
+  }
+
+  const std::string* adaptive =
+      FindProperty(properties, TableProperties::kParquetAdaptiveEncodingEnabled);
+  if (adaptive != nullptr && StringUtils::EqualsIgnoreCase(*adaptive, "true")) {
+    std::unordered_set<int32_t> sorted_field_ids;
+    if (auto it = properties.find(std::string(WriterOptions::kSortedFieldIdsProperty));
+        it != properties.cend()) {
+      const std::string& ids = it->second;
+      for (const char* begin = ids.data(); begin <= ids.data() + ids.size();) {
+        int32_t field_id = 0;
+        auto [end, ec] = std::from_chars(begin, ids.data() + ids.size(), field_id);
+        if (ec != std::errc() || (end != ids.data() + ids.size() && *end != ',')) {
+          return InvalidArgument("Invalid {}: {}, expected comma-separated field IDs",
+                                 it->first, ids);
+        }
+        sorted_field_ids.insert(field_id);
+        begin = end + 1;
+      }
+    }
+    for (int i = 0; i < schema_descriptor.num_columns(); ++i) {
+      if (!encodings.contains(i)) {
+        const auto* column = schema_descriptor.Column(i);
+        encodings[i] = AdaptiveEncoding(
+            *column, sorted_field_ids.contains(column->schema_node()->field_id()));
+      }
+    }
+  }
+
+  for (const auto& [i, encoding] : encodings) {
+    if (encoding.has_value()) {
+      const auto path = schema_descriptor.Column(i)->path();
+      builder->disable_dictionary(path)->encoding(path, *encoding);
+    }
+  }
+  return {};
+}
+
+/// \brief Maps the Parquet table properties of the writer properties onto the
+/// Parquet writer properties.
+Result<std::shared_ptr<::parquet::WriterProperties>> MakeWriterProperties(
+    const std::unordered_map<std::string, std::string>& properties, const Schema& schema,
+    const ::parquet::SchemaDescriptor& schema_descriptor, ::arrow::MemoryPool* pool) {
+  const std::string* codec_property =
+      FindProperty(properties, TableProperties::kParquetCompression);
+  const std::string codec_name = StringUtils::ToLower(
+      codec_property != nullptr ? *codec_property
+                                : TableProperties::kParquetCompression.value());
+  ICEBERG_ASSIGN_OR_RAISE(auto codec, ParseCodec(codec_name));
+  if (!::arrow::util::Codec::IsAvailable(codec)) {
+    return NotSupported("Parquet compression codec {} is not available", codec_name);
+  }
+
+  ::parquet::WriterProperties::Builder builder;
+  builder.memory_pool(pool)->compression(codec);
+
+  // Codecs without levels ignore the level, like the Java implementation.
+  const std::string* level =
+      FindProperty(properties, TableProperties::kParquetCompressionLevel);
+  if (level != nullptr && !level->empty() &&
+      ::arrow::util::Codec::SupportsCompressionLevel(codec)) {
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(auto min_level,
+                                   ::arrow::util::Codec::MinimumCompressionLevel(codec));
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(auto max_level,
+                                   ::arrow::util::Codec::MaximumCompressionLevel(codec));
+    int value = 0;
+    auto [end, ec] = std::from_chars(level->data(), level->data() + level->size(), value);
+    if (ec != std::errc() || end != level->data() + level->size() || value < min_level ||
+        value > max_level) {
+      return InvalidArgument("Invalid {} compression level {}, expected {} to {}",
+                             codec_name, *level, min_level, max_level);
+    }
+    builder.compression_level(value);
+  }
+
+  ICEBERG_ASSIGN_OR_RAISE(auto page_size,
+                          ParseSize(properties, TableProperties::kParquetPageSizeBytes));
+  ICEBERG_ASSIGN_OR_RAISE(auto dict_size,
+                          ParseSize(properties, TableProperties::kParquetDictSizeBytes));
+  builder.data_pagesize(page_size)->dictionary_pagesize_limit(dict_size);
+  // Row groups are closed by their size in bytes instead of their number of rows.
+  builder.max_row_group_length(std::numeric_limits<int64_t>::max());
+  ICEBERG_RETURN_UNEXPECTED(
+      SetColumnEncodings(properties, schema, schema_descriptor, &builder));
+  return builder.build();
 }
 
 }  // namespace
@@ -51,24 +367,49 @@ Result<std::shared_ptr<::arrow::io::OutputStream>> OpenOutputStream(
 class ParquetWriter::Impl {
  public:
   Status Open(const WriterOptions& options) {
-    auto writer_properties =
-        ::parquet::WriterProperties::Builder().memory_pool(pool_)->build();
+    pool_ = arrow::ToArrowMemoryPool(options.memory_pool);
     auto arrow_writer_properties = ::parquet::default_arrow_writer_properties();
 
     ArrowSchema c_schema;
     ICEBERG_RETURN_UNEXPECTED(ToArrowSchema(*options.schema, &c_schema));
     ICEBERG_ARROW_ASSIGN_OR_RETURN(arrow_schema_, ::arrow::ImportSchema(&c_schema));
 
+    // The Parquet schema is converted first, since the writer properties refer to its
+    // columns.
     std::shared_ptr<::parquet::SchemaDescriptor> schema_descriptor;
-    ICEBERG_ARROW_RETURN_NOT_OK(
-        ::parquet::arrow::ToParquetSchema(arrow_schema_.get(), *writer_properties,
-                                          *arrow_writer_properties, &schema_descriptor));
+    ICEBERG_ARROW_RETURN_NOT_OK(::parquet::arrow::ToParquetSchema(
+        arrow_schema_.get(), *::parquet::default_writer_properties(),
+        *arrow_writer_properties, &schema_descriptor));
+    ICEBERG_ASSIGN_OR_RAISE(auto writer_properties,
+                            MakeWriterProperties(options.properties, *options.schema,
+                                                 *schema_descriptor, pool_));
+    ICEBERG_ASSIGN_OR_RAISE(
+        row_group_size_,
+        ParseSize(options.properties, TableProperties::kParquetRowGroupSizeBytes));
+    ICEBERG_ASSIGN_OR_RAISE(auto metrics_config,
+                            MetricsConfig::Make(options.properties, *options.schema));
+    ICEBERG_ASSIGN_OR_RAISE(metrics_collector_,
+                            ArrowMetricsCollector::Make(*options.schema,
+                                                        std::move(metrics_config)));
     auto schema_node = std::static_pointer_cast<::parquet::schema::GroupNode>(
         schema_descriptor->schema_root());
 
     ICEBERG_ASSIGN_OR_RAISE(output_stream_, OpenOutputStream(options));
+    std::shared_ptr<::arrow::io::OutputStream> sink = output_stream_;
+    ICEBERG_ASSIGN_OR_RAISE(auto bloom_filter_columns,
+                            BloomFilterColumns(options.properties, *options.schema,
+                                               *schema_descriptor));
+    if (!bloom_filter_columns.empty()) {
+      ICEBERG_ASSIGN_OR_RAISE(
+          auto max_bytes,
+          ParseSize(options.properties, TableProperties::kParquetBloomFilterMaxBytes));
+      ICEBERG_ASSIGN_OR_RAISE(bloom_filter_writer_,
+                              BloomFilterWriter::Make(output_stream_, schema_descriptor,
+                                                      bloom_filter_columns, max_bytes));
+      sink = bloom_filter_writer_->stream();
+    }
     auto file_writer = ::parquet::ParquetFileWriter::Open(
-        output_stream_, std::move(schema_node), std::move(writer_properties));
+        std::move(sink), std::move(schema_node), std::move(writer_properties));
     ICEBERG_ARROW_RETURN_NOT_OK(
         ::parquet::arrow::FileWriter::Make(pool_, std::move(file_writer), arrow_schema_,
                                            std::move(arrow_writer_properties), &writer_));
@@ -77,10 +418,42 @@ class ParquetWriter::Impl {
   }
 
   Status Write(ArrowArray* array) {
+    ICEBERG_RETURN_UNEXPECTED(metrics_collector_->Update(*array));
     ICEBERG_ARROW_ASSIGN_OR_RETURN(auto batch,
                                    ::arrow::ImportRecordBatch(array, arrow_schema_));
 
-    ICEBERG_ARROW_RETURN_NOT_OK(writer_->WriteRecordBatch(*batch));
+    const int64_t num_rows = batch->num_rows();
+    if (num_rows == 0) {
+      return {};
+    }
+
+    // Parquet row groups are limited by their number of rows, so the rows of a row
+    // group are estimated from the in-memory size of the batches, and the batches are
+    // split where a row group reaches the row group size.
+    ICEBERG_ARROW_ASSIGN_OR_RETURN(auto batch_bytes,
+                                   ::arrow::util::ReferencedBufferSize(*batch));
+    const int64_t row_bytes = std::max<int64_t>(1, batch_bytes / num_rows);
+    int64_t offset = 0;
+    while (offset < num_rows) {
+      if (row_group_bytes_ >= row_group_size_) {
+        if (bloom_filter_writer_ != nullptr) {
+          bloom_filter_writer_->FinishRowGroup();
+        }
+        ICEBERG_ARROW_RETURN_NOT_OK(writer_->NewBufferedRowGroup());
+        flushed_row_bytes_ += row_group_bytes_;
+        row_group_bytes_ = 0;
+      }
+      const int64_t rows = std::clamp<int64_t>(
+          (row_group_size_ - row_group_bytes_ + row_bytes - 1) / row_bytes, 1,
+          num_rows - offset);
+      auto slice = batch->Slice(offset, rows);
+      if (bloom_filter_writer_ != nullptr) {
+        ICEBERG_RETURN_UNEXPECTED(bloom_filter_writer_->Update(*slice));
+      }
+      ICEBERG_ARROW_RETURN_NOT_OK(writer_->WriteRecordBatch(*slice));
+      offset += rows;
+      row_group_bytes_ += rows * row_bytes;
+    }
 
     return {};
   }
@@ -91,11 +464,28 @@ class ParquetWriter::Impl {
       return {};  // Already closed
     }
 
+    if (bloom_filter_writer_ != nullptr) {
+      bloom_filter_writer_->HoldFooter();
+    }
     ICEBERG_ARROW_RETURN_NOT_OK(writer_->Close());
+    if (bloom_filter_writer_ != nullptr) {
+      ICEBERG_RETURN_UNEXPECTED(bloom_filter_writer_->Finish());
+      bloom_filter_writer_.reset();
+    }
     auto& metadata = writer_->metadata();
     split_offsets_.reserve(metadata->num_row_groups());
+    metrics_ = metrics_collector_->Finish();
     for (int i = 0; i < metadata->num_row_groups(); ++i) {
-      split_offsets_.push_back(metadata->RowGroup(i)->file_offset());
+      auto row_group = metadata->RowGroup(i);
+      split_offsets_.push_back(row_group->file_offset());
+      for (int j = 0; j < row_group->num_columns(); ++j) {
+        const int32_t field_id = metadata->schema()->Column(j)->schema_node()->field_id();
+        if (metrics_collector_->config().ColumnMode(field_id).kind !=
+            MetricsMode::Kind::kNone) {
+          metrics_.column_sizes[field_id] +=
+              row_group->ColumnChunk(j)->total_compressed_size();
+        }
+      }
     }
     writer_.reset();
 
@@ -108,8 +498,26 @@ class ParquetWriter::Impl {
 
   int64_t length() const { return total_bytes_; }
 
+  std::optional<int64_t> EstimatedLength() const {
+    auto position = output_stream_->Tell();
+    if (!position.ok()) {
+      return std::nullopt;
+    }
+    // The open row group is buffered in memory until it is flushed, so its encoded size
+    // is estimated with the ratio of encoded to in-memory bytes of the flushed ones.
+    if (flushed_row_bytes_ == 0) {
+      return *position + row_group_bytes_;
+    }
+    const double ratio =
+        static_cast<double>(*position) / static_cast<double>(flushed_row_bytes_);
+    return *position +
+           static_cast<int64_t>(static_cast<double>(row_group_bytes_) * ratio);
+  }
+
   std::vector<int64_t> split_offsets() const { return split_offsets_; }
 
+  const Metrics& metrics() const { return metrics_; }
+
  private:
   // TODO(gangwu): make memory pool configurable
   ::arrow::MemoryPool* pool_ = ::arrow::default_memory_pool();
@@ -119,10 +527,22 @@ class ParquetWriter::Impl {
   std::shared_ptr<::arrow::io::OutputStream> output_stream_;
   // Parquet file writer to write ArrowArray.
   std::unique_ptr<::parquet::arrow::FileWriter> writer_;
+  // Writer of the bloom filters of the file, or nullptr if it has none.
+  std::unique_ptr<BloomFilterWriter> bloom_filter_writer_;
+  // Target size in bytes of the row groups.
+  int64_t row_group_size_{0};
+  // Estimated size in bytes of the rows written to the current row group.
+  int64_t row_group_bytes_{0};
+  // Estimated size in bytes of the rows of the flushed row groups.
+  int64_t flushed_row_bytes_{0};
   // Total length of the written Parquet file.
   int64_t total_bytes_{0};
   // Row group start offsets in the Parquet file.
   std::vector<int64_t> split_offsets_;
+  // Collector of the column metrics of the written rows.
+  std::optional<ArrowMetricsCollector> metrics_collector_;
+  // Metrics of the closed file.
+  Metrics metrics_;
 };
 
 ParquetWriter::~ParquetWriter() = default;
@@ -140,7 +560,7 @@ std::optional<Metrics> ParquetWriter::metrics() {
   if (!impl_->Closed()) {
     return std::nullopt;
   }
-  return {};
+  return impl_->metrics();
 }
 
 std::optional<int64_t> ParquetWriter::length() {
@@ -150,6 +570,13 @@ std::optional<int64_t> ParquetWriter::length() {
   return impl_->length();
 }
 
+std::optional<int64_t> ParquetWriter::estimated_length() {
+  if (impl_->Closed()) {
+    return impl_->length();
+  }
+  return impl_->EstimatedLength();
+}
+
 std::vector<int64_t> ParquetWriter::split_offsets() {
   if (!impl_->Closed()) {
     return {};
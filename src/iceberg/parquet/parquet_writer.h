@@ -41,6 +41,8 @@ class ICEBERG_BUNDLE_EXPORT ParquetWriter : public Writer {
 
   std::optional<int64_t> length() final;
 
+  std::optional<int64_t> estimated_length() final;
+
   std::vector<int64_t> split_offsets() final;
 
  private:
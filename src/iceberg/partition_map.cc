@@ -0,0 +1,52 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/partition_map.h"
+
+#include "iceberg/expression/literal.h"
+#include "iceberg/util/conversions.h"
+#include "iceberg/util/macros.h"
+#include "iceberg/util/murmurhash3_internal.h"
+
+namespace iceberg {
+
+Result<PartitionTupleKey> PartitionTupleKey::Make(int32_t spec_id,
+                                                  std::span<const Literal> partition) {
+  std::string bytes;
+  for (const auto& value : partition) {
+    if (value.IsNull()) {
+      bytes.push_back('\0');
+      continue;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto value_bytes, Conversions::ToBytes(value));
+    const auto size = static_cast<uint32_t>(value_bytes.size());
+    bytes.push_back('\1');
+    bytes.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    bytes.append(value_bytes.begin(), value_bytes.end());
+  }
+  return PartitionTupleKey(spec_id, std::move(bytes));
+}
+
+PartitionTupleKey::PartitionTupleKey(int32_t spec_id, std::string bytes)
+    : spec_id_(spec_id), bytes_(std::move(bytes)) {
+  MurmurHash3_x86_32(bytes_.data(), static_cast<int>(bytes_.size()),
+                     static_cast<uint32_t>(spec_id_), &hash_);
+}
+
+}  // namespace iceberg
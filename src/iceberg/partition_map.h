@@ -0,0 +1,228 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/partition_map.h
+/// Hash containers keyed by the partition of a partition spec.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief A partition tuple of a partition spec, encoded for hashing and comparison.
+///
+/// The key holds the spec ID and the single-value serialization of each partition
+/// value, the one that bucket transforms hash, with a marker for nulls. Two keys are
+/// equal if they have the same spec ID and partition values of the same types, and
+/// their hash is computed once with MurmurHash3 so that lookups only compare bytes.
+class ICEBERG_EXPORT PartitionTupleKey {
+ public:
+  /// \brief Encodes the partition of a spec.
+  ///
+  /// \param spec_id The ID of the partition spec
+  /// \param partition The partition values, ordered like the fields of the spec
+  static Result<PartitionTupleKey> Make(int32_t spec_id,
+                                        std::span<const Literal> partition);
+
+  /// \brief Returns the ID of the partition spec.
+  int32_t spec_id() const { return spec_id_; }
+
+  /// \brief Returns the encoded partition values.
+  std::string_view bytes() const { return bytes_; }
+
+  /// \brief Returns the hash of the key.
+  uint32_t hash() const { return hash_; }
+
+  bool operator==(const PartitionTupleKey& other) const {
+    return hash_ == other.hash_ && spec_id_ == other.spec_id_ && bytes_ == other.bytes_;
+  }
+
+ private:
+  PartitionTupleKey(int32_t spec_id, std::string bytes);
+
+  int32_t spec_id_;
+  uint32_t hash_;
+  std::string bytes_;
+};
+
+/// \brief A map from the partitions of partition specs to values.
+///
+/// The map uses open addressing with linear probing over a table of slots holding the
+/// hash of each key and the position of its entry, so a probe compares hashes before
+/// reading an entry. Entries are stored in insertion order, which is also the order of
+/// iteration, and are never removed except by Clear(). The keys of the entries must
+/// not be modified. Pointers to values are invalidated by insertions.
+template <typename V>
+class PartitionMap {
+ public:
+  using value_type = std::pair<PartitionTupleKey, V>;
+  using iterator = typename std::vector<value_type>::iterator;
+  using const_iterator = typename std::vector<value_type>::const_iterator;
+
+  /// \brief Returns the value of a partition, or null if it is not in the map.
+  V* Find(const PartitionTupleKey& key) {
+    const auto slot = Probe(key);
+    return slots_.empty() || slots_[slot].index == kEmpty
+               ? nullptr
+               : &entries_[slots_[slot].index].second;
+  }
+
+  /// \copydoc Find(const PartitionTupleKey&)
+  const V* Find(const PartitionTupleKey& key) const {
+    return const_cast<PartitionMap*>(this)->Find(key);
+  }
+
+  /// \brief Returns whether a partition is in the map.
+  bool Contains(const PartitionTupleKey& key) const { return Find(key) != nullptr; }
+
+  /// \brief Inserts a value for a partition constructed from `args` if the partition
+  /// is not in the map.
+  ///
+  /// \return The value of the partition, and whether it was inserted
+  template <typename... Args>
+  std::pair<V*, bool> TryEmplace(PartitionTupleKey key, Args&&... args) {
+    if ((entries_.size() + 1) * 2 > slots_.size()) {
+      Rehash(std::max<size_t>(slots_.size() * 2, kMinSlots));
+    }
+    const auto slot = Probe(key);
+    if (slots_[slot].index != kEmpty) {
+      return {&entries_[slots_[slot].index].second, false};
+    }
+    slots_[slot] = {.hash = key.hash(), .index = static_cast<uint32_t>(entries_.size())};
+    entries_.emplace_back(std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+                          std::forward_as_tuple(std::forward<Args>(args)...));
+    return {&entries_.back().second, true};
+  }
+
+  /// \brief Returns the value of a partition, inserting a default value if the
+  /// partition is not in the map.
+  V& operator[](PartitionTupleKey key) { return *TryEmplace(std::move(key)).first; }
+
+  /// \brief Reserves room for `size` entries without rehashing.
+  void Reserve(size_t size) {
+    entries_.reserve(size);
+    size_t num_slots = kMinSlots;
+    while (num_slots < size * 2) {
+      num_slots *= 2;
+    }
+    if (num_slots > slots_.size()) {
+      Rehash(num_slots);
+    }
+  }
+
+  /// \brief Removes all entries.
+  void Clear() {
+    entries_.clear();
+    slots_.clear();
+  }
+
+  size_t size() const { return entries_.size(); }
+  bool empty() const { return entries_.empty(); }
+
+  iterator begin() { return entries_.begin(); }
+  iterator end() { return entries_.end(); }
+  const_iterator begin() const { return entries_.begin(); }
+  const_iterator end() const { return entries_.end(); }
+
+ private:
+  static constexpr uint32_t kEmpty = UINT32_MAX;
+  static constexpr size_t kMinSlots = 16;
+
+  struct Slot {
+    uint32_t hash = 0;
+    uint32_t index = kEmpty;
+  };
+
+  /// \brief Returns the slot of a key, or the empty slot where it would be inserted.
+  size_t Probe(const PartitionTupleKey& key) const {
+    if (slots_.empty()) {
+      return 0;
+    }
+    const size_t mask = slots_.size() - 1;
+    for (size_t slot = key.hash() & mask;; slot = (slot + 1) & mask) {
+      const Slot& candidate = slots_[slot];
+      if (candidate.index == kEmpty ||
+          (candidate.hash == key.hash() && entries_[candidate.index].first == key)) {
+        return slot;
+      }
+    }
+  }
+
+  void Rehash(size_t num_slots) {
+    slots_.assign(num_slots, Slot{});
+    const size_t mask = num_slots - 1;
+    for (size_t i = 0; i < entries_.size(); ++i) {
+      const uint32_t hash = entries_[i].first.hash();
+      size_t slot = hash & mask;
+      while (slots_[slot].index != kEmpty) {
+        slot = (slot + 1) & mask;
+      }
+      slots_[slot] = {.hash = hash, .index = static_cast<uint32_t>(i)};
+    }
+  }
+
+  std::vector<value_type> entries_;
+  // A power of two of at least twice the number of entries.
+  std::vector<Slot> slots_;
+};
+
+/// \brief A set of partitions of partition specs, with the layout of PartitionMap.
+class ICEBERG_EXPORT PartitionSet {
+ public:
+  /// \brief Inserts a partition, and returns whether it was not in the set.
+  bool Insert(PartitionTupleKey key) {
+    return partitions_.TryEmplace(std::move(key)).second;
+  }
+
+  /// \brief Returns whether a partition is in the set.
+  bool Contains(const PartitionTupleKey& key) const { return partitions_.Contains(key); }
+
+  /// \brief Removes all partitions.
+  void Clear() { partitions_.Clear(); }
+
+  size_t size() const { return partitions_.size(); }
+  bool empty() const { return partitions_.empty(); }
+
+  /// \brief Calls `visitor` with each partition, in insertion order.
+  template <typename Visitor>
+  void ForEach(Visitor&& visitor) const {
+    for (const auto& [key, unused] : partitions_) {
+      visitor(key);
+    }
+  }
+
+ private:
+  PartitionMap<std::monostate> partitions_;
+};
+
+}  // namespace iceberg
@@ -20,17 +20,168 @@
 #include "iceberg/partition_spec.h"
 
 #include <algorithm>
+#include <chrono>
 #include <format>
 #include <ranges>
+#include <span>
 
+#include "iceberg/row/struct_like.h"
 #include "iceberg/schema.h"
 #include "iceberg/schema_field.h"
+#include "iceberg/schema_internal.h"
 #include "iceberg/transform.h"
+#include "iceberg/type.h"
+#include "iceberg/util/checked_cast.h"
 #include "iceberg/util/formatter.h"  // IWYU pragma: keep
 #include "iceberg/util/macros.h"
+#include "iceberg/util/uuid.h"
 
 namespace iceberg {
 
+namespace {
+
+using namespace std::chrono;  // NOLINT
+
+constexpr int64_t kMicrosPerSecond = 1'000'000;
+constexpr int64_t kMicrosPerDay = 86'400 * kMicrosPerSecond;
+
+/// \brief Formats a date as "yyyy-MM-dd".
+std::string HumanDate(int64_t days_since_epoch) {
+  return std::format("{:%F}", sys_days(days(days_since_epoch)));
+}
+
+/// \brief Formats a time of day as "HH:mm", followed by the seconds and fraction of a
+/// second when they are not zero, as java.time.LocalTime.
+std::string HumanTime(int64_t micros_of_day) {
+  const int64_t seconds = micros_of_day / kMicrosPerSecond;
+  const int64_t micros = micros_of_day % kMicrosPerSecond;
+  std::string result = std::format("{:02}:{:02}", seconds / 3600, seconds / 60 % 60);
+  if (seconds % 60 != 0 || micros != 0) {
+    std::format_to(std::back_inserter(result), ":{:02}", seconds % 60);
+  }
+  if (micros % 1000 == 0 && micros != 0) {
+    std::format_to(std::back_inserter(result), ".{:03}", micros / 1000);
+  } else if (micros != 0) {
+    std::format_to(std::back_inserter(result), ".{:06}", micros);
+  }
+  return result;
+}
+
+std::string HumanTimestamp(int64_t micros) {
+  const int64_t day = micros / kMicrosPerDay - (micros % kMicrosPerDay < 0 ? 1 : 0);
+  return std::format("{}T{}", HumanDate(day), HumanTime(micros - day * kMicrosPerDay));
+}
+
+std::string Base64(std::string_view bytes) {
+  static constexpr std::string_view kAlphabet =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string result;
+  result.reserve((bytes.size() + 2) / 3 * 4);
+  for (size_t i = 0; i < bytes.size(); i += 3) {
+    const size_t n = std::min<size_t>(3, bytes.size() - i);
+    uint32_t group = 0;
+    for (size_t j = 0; j < 3; ++j) {
+      group = (group << 8) | (j < n ? static_cast<uint8_t>(bytes[i + j]) : 0);
+    }
+    for (size_t j = 0; j < 4; ++j) {
+      result.push_back(j <= n ? kAlphabet[(group >> (18 - 6 * j)) & 0x3F] : '=');
+    }
+  }
+  return result;
+}
+
+/// \brief Encodes a path component as application/x-www-form-urlencoded UTF-8, as
+/// java.net.URLEncoder.
+std::string UrlEncode(std::string_view value) {
+  std::string result;
+  result.reserve(value.size());
+  for (char c : value) {
+    if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+        c == '.' || c == '-' || c == '*' || c == '_') {
+      result.push_back(c);
+    } else if (c == ' ') {
+      result.push_back('+');
+    } else {
+      std::format_to(std::back_inserter(result), "%{:02X}", static_cast<uint8_t>(c));
+    }
+  }
+  return result;
+}
+
+/// \brief Returns the human-readable string of a value of a source type.
+Result<std::string> HumanValue(const Type& type, const Scalar& value) {
+  switch (type.type_id()) {
+    case TypeId::kDate:
+      return HumanDate(std::get<int32_t>(value));
+    case TypeId::kTime:
+      return HumanTime(std::get<int64_t>(value));
+    case TypeId::kTimestamp:
+      return HumanTimestamp(std::get<int64_t>(value));
+    case TypeId::kTimestampTz:
+      return HumanTimestamp(std::get<int64_t>(value)) + "Z";
+    case TypeId::kDecimal:
+      return std::get<Decimal>(value).ToString(
+          internal::checked_cast<const DecimalType&>(type).scale());
+    case TypeId::kUuid: {
+      const auto bytes = std::get<std::string_view>(value);
+      ICEBERG_ASSIGN_OR_RAISE(
+          auto uuid, Uuid::FromBytes(std::span(
+                         reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size())));
+      return uuid.ToString();
+    }
+    case TypeId::kBinary:
+    case TypeId::kFixed:
+      return Base64(std::get<std::string_view>(value));
+    default:
+      return std::visit(
+          []<typename T>(const T& v) -> Result<std::string> {
+            if constexpr (std::is_same_v<T, bool>) {
+              return v ? "true" : "false";
+            } else if constexpr (std::is_same_v<T, std::string_view> ||
+                                 std::is_arithmetic_v<T>) {
+              return std::format("{}", v);
+            } else {
+              return NotSupported("Cannot format partition values of nested types");
+            }
+          },
+          value);
+  }
+}
+
+/// \brief Returns the human-readable string of a partition value, as
+/// Transform::toHumanString in Java.
+Result<std::string> HumanPartitionValue(const Transform& transform,
+                                        const Type& source_type, const Scalar& value) {
+  if (std::holds_alternative<std::monostate>(value)) {
+    return "null";
+  }
+  switch (transform.transform_type()) {
+    case TransformType::kIdentity:
+    case TransformType::kTruncate:
+      return HumanValue(source_type, value);
+    case TransformType::kYear:
+      return std::format("{:04}", 1970 + std::get<int32_t>(value));
+    case TransformType::kMonth: {
+      const int32_t months = std::get<int32_t>(value);
+      const int32_t years = months / 12 - (months % 12 < 0 ? 1 : 0);
+      return std::format("{:04}-{:02}", 1970 + years, months - years * 12 + 1);
+    }
+    case TransformType::kDay:
+      return HumanDate(std::get<int32_t>(value));
+    case TransformType::kHour: {
+      const int32_t hours = std::get<int32_t>(value);
+      const int32_t day = hours / 24 - (hours % 24 < 0 ? 1 : 0);
+      return std::format("{}-{:02}", HumanDate(day), hours - day * 24);
+    }
+    case TransformType::kBucket:
+      return std::to_string(std::get<int32_t>(value));
+    default:
+      return "null";
+  }
+}
+
+}  // namespace
+
 PartitionSpec::PartitionSpec(std::shared_ptr<Schema> schema, int32_t spec_id,
                              std::vector<PartitionField> fields,
                              std::optional<int32_t> last_assigned_field_id)
@@ -104,6 +255,40 @@ Result<std::shared_ptr<StructType>> PartitionSpec::PartitionType() {
   return partition_type_;
 }
 
+Result<std::shared_ptr<Schema>> PartitionSpec::PartitionSchema() {
+  ICEBERG_ASSIGN_OR_RAISE(auto partition_type, PartitionType());
+  if (partition_type == nullptr) {
+    return nullptr;
+  }
+  return FromStructType(*partition_type, std::nullopt);
+}
+
+Result<std::string> PartitionSpec::PartitionPath(const StructLike& partition_data) const {
+  if (partition_data.num_fields() != fields_.size()) {
+    return InvalidArgument("Invalid partition data with {} fields, expected {}",
+                           partition_data.num_fields(), fields_.size());
+  }
+  std::string path;
+  for (size_t pos = 0; pos < fields_.size(); ++pos) {
+    const auto& field = fields_[pos];
+    ICEBERG_ASSIGN_OR_RAISE(auto source_field, schema_->FindFieldById(field.source_id()));
+    if (!source_field.has_value()) {
+      return InvalidSchema("Cannot find source field for partition field:{}",
+                           field.field_id());
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto value, partition_data.GetField(pos));
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto human_value,
+        HumanPartitionValue(*field.transform(), *source_field->get().type(), value));
+    if (pos > 0) {
+      path.push_back('/');
+    }
+    std::format_to(std::back_inserter(path), "{}={}", UrlEncode(field.name()),
+                   UrlEncode(human_value));
+  }
+  return path;
+}
+
 std::string PartitionSpec::ToString() const {
   std::string repr = std::format("partition_spec[spec_id<{}>,\n", spec_id_);
   for (const auto& field : fields_) {
@@ -75,6 +75,19 @@ class ICEBERG_EXPORT PartitionSpec : public util::Formattable {
   /// \brief Get the partition type.
   Result<std::shared_ptr<StructType>> PartitionType();
 
+  /// \brief Get the schema of the partition tuples, or nullptr if the spec has no
+  /// fields.
+  Result<std::shared_ptr<Schema>> PartitionSchema();
+
+  /// \brief Returns the relative path of the directory of a partition.
+  ///
+  /// The path has a "name=value" directory for each partition field, where the value
+  /// is the human-readable string of the partition value, such as "2024-01-02" for a
+  /// day, and both are URL-encoded.
+  ///
+  /// \param partition_data the partition values, in the order of the fields
+  Result<std::string> PartitionPath(const StructLike& partition_data) const;
+
   std::string ToString() const override;
 
   int32_t last_assigned_field_id() const { return last_assigned_field_id_; }
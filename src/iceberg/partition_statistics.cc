@@ -0,0 +1,621 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/partition_statistics.h"
+
+#include <algorithm>
+#include <atomic>
+#include <initializer_list>
+#include <utility>
+
+#include <nanoarrow/nanoarrow.h>
+
+#include "iceberg/arrow/nanoarrow_status_internal.h"
+#include "iceberg/arrow_c_data_guard_internal.h"
+#include "iceberg/executor.h"
+#include "iceberg/expression/batch_evaluator.h"
+#include "iceberg/file_reader.h"
+#include "iceberg/file_writer.h"
+#include "iceberg/manifest_adapter.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/manifest_reader.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/schema_internal.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/type.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/macros.h"
+#include "iceberg/util/timepoint.h"
+#include "iceberg/util/uuid.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief The number of partitions written in a batch.
+constexpr int64_t kBatchRows = 4096;
+
+/// \brief The number of columns of the partition statistics schema.
+constexpr int64_t kNumStatsColumns = 13;
+
+bool GetBit(const uint8_t* bitmap, int64_t index) {
+  return (bitmap[index >> 3] >> (index & 7)) & 1;
+}
+
+/// \brief The spec ID of the keys of partition tuples of the unified partition type,
+/// which does not belong to a single spec.
+constexpr int32_t kUnifiedSpecId = -1;
+
+Status AppendOptional(ArrowArray* array, const std::optional<int64_t>& value) {
+  if (!value.has_value()) {
+    ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayAppendNull(array, 1));
+    return {};
+  }
+  ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayAppendInt(array, value.value()));
+  return {};
+}
+
+/// \brief Appends the statistics of a partition as a row of the statistics schema.
+Status AppendStats(ArrowArray* array, const std::shared_ptr<StructType>& partition_type,
+                   const PartitionStats& stats) {
+  ICEBERG_RETURN_UNEXPECTED(ManifestEntryAdapter::AppendPartitionValues(
+      array->children[0], partition_type, stats.partition));
+  for (auto [index, value] : std::initializer_list<std::pair<int64_t, int64_t>>{
+           {1, stats.spec_id},
+           {2, stats.data_record_count},
+           {3, stats.data_file_count},
+           {4, stats.total_data_file_size_in_bytes},
+           {5, stats.position_delete_record_count},
+           {6, stats.position_delete_file_count},
+           {7, stats.equality_delete_record_count},
+           {8, stats.equality_delete_file_count},
+           {12, stats.dv_count}}) {
+    ICEBERG_NANOARROW_RETURN_UNEXPECTED(
+        ArrowArrayAppendInt(array->children[index], value));
+  }
+  ICEBERG_RETURN_UNEXPECTED(AppendOptional(array->children[9], stats.total_record_count));
+  ICEBERG_RETURN_UNEXPECTED(AppendOptional(array->children[10], stats.last_updated_at));
+  ICEBERG_RETURN_UNEXPECTED(
+      AppendOptional(array->children[11], stats.last_updated_snapshot_id));
+  ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayFinishElement(array));
+  return {};
+}
+
+/// \brief Reads a partition value of a row of a partition statistics file.
+Result<Literal> ParsePartitionValue(const ArrowArrayView* view, const SchemaField& field,
+                                    int64_t row) {
+  auto type = internal::checked_pointer_cast<PrimitiveType>(field.type());
+  if (ArrowArrayViewIsNull(view, row)) {
+    return Literal::Null(std::move(type));
+  }
+  auto bytes = [&]() {
+    ArrowBufferView buffer = ArrowArrayViewGetBytesUnsafe(view, row);
+    return std::vector<uint8_t>(buffer.data.as_uint8,
+                                buffer.data.as_uint8 + buffer.size_bytes);
+  };
+  switch (type->type_id()) {
+    case TypeId::kBoolean:
+      return Literal::Boolean(ArrowArrayViewGetIntUnsafe(view, row) != 0);
+    case TypeId::kInt:
+      return Literal::Int(static_cast<int32_t>(ArrowArrayViewGetIntUnsafe(view, row)));
+    case TypeId::kDate:
+      return Literal::Date(static_cast<int32_t>(ArrowArrayViewGetIntUnsafe(view, row)));
+    case TypeId::kLong:
+      return Literal::Long(ArrowArrayViewGetIntUnsafe(view, row));
+    case TypeId::kTime:
+      return Literal::Time(ArrowArrayViewGetIntUnsafe(view, row));
+    case TypeId::kTimestamp:
+      return Literal::Timestamp(ArrowArrayViewGetIntUnsafe(view, row));
+    case TypeId::kTimestampTz:
+      return Literal::TimestampTz(ArrowArrayViewGetIntUnsafe(view, row));
+    case TypeId::kFloat:
+      return Literal::Float(static_cast<float>(ArrowArrayViewGetDoubleUnsafe(view, row)));
+    case TypeId::kDouble:
+      return Literal::Double(ArrowArrayViewGetDoubleUnsafe(view, row));
+    case TypeId::kString: {
+      ArrowStringView value = ArrowArrayViewGetStringUnsafe(view, row);
+      return Literal::String(std::string(value.data, value.size_bytes));
+    }
+    case TypeId::kBinary:
+      return Literal::Binary(bytes());
+    case TypeId::kFixed:
+      return Literal::Fixed(bytes());
+    case TypeId::kUuid: {
+      ICEBERG_ASSIGN_OR_RAISE(auto uuid, Uuid::FromBytes(bytes()));
+      return Literal::UUID(uuid);
+    }
+    default:
+      return NotSupported("Unsupported partition field in partition statistics: {}",
+                          field.ToString());
+  }
+}
+
+/// \brief Reads the rows of a batch of a partition statistics file.
+Status ParseStats(const ArrowSchema& schema, const ArrowArray& batch,
+                  const StructType& partition_type, std::vector<PartitionStats>& stats) {
+  ArrowError error;
+  ArrowArrayView array_view;
+  auto status = ArrowArrayViewInitFromSchema(&array_view, &schema, &error);
+  ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(status, error);
+  internal::ArrowArrayViewGuard view_guard(&array_view);
+  status = ArrowArrayViewSetArray(&array_view, &batch, &error);
+  ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(status, error);
+  if (array_view.n_children != kNumStatsColumns) {
+    return InvalidArrowData("Expected {} columns in partition statistics, got {}",
+                            kNumStatsColumns, array_view.n_children);
+  }
+  const ArrowArrayView* partition_view = array_view.children[0];
+  const auto fields = partition_type.fields();
+  if (partition_view->n_children != static_cast<int64_t>(fields.size())) {
+    return InvalidArrowData(
+        "Expected {} partition fields in partition statistics, got {}", fields.size(),
+        partition_view->n_children);
+  }
+
+  auto get = [&](int64_t index, int64_t row) -> int64_t {
+    const ArrowArrayView* view = array_view.children[index];
+    return ArrowArrayViewIsNull(view, row) ? 0 : ArrowArrayViewGetIntUnsafe(view, row);
+  };
+  auto get_optional = [&](int64_t index, int64_t row) -> std::optional<int64_t> {
+    const ArrowArrayView* view = array_view.children[index];
+    if (ArrowArrayViewIsNull(view, row)) {
+      return std::nullopt;
+    }
+    return ArrowArrayViewGetIntUnsafe(view, row);
+  };
+  for (int64_t row = 0; row < batch.length; ++row) {
+    PartitionStats& row_stats = stats.emplace_back();
+    row_stats.partition.reserve(fields.size());
+    for (size_t i = 0; i < fields.size(); ++i) {
+      ICEBERG_ASSIGN_OR_RAISE(
+          auto value, ParsePartitionValue(partition_view->children[i], fields[i], row));
+      row_stats.partition.push_back(std::move(value));
+    }
+    row_stats.spec_id = static_cast<int32_t>(get(1, row));
+    row_stats.data_record_count = get(2, row);
+    row_stats.data_file_count = static_cast<int32_t>(get(3, row));
+    row_stats.total_data_file_size_in_bytes = get(4, row);
+    row_stats.position_delete_record_count = get(5, row);
+    row_stats.position_delete_file_count = static_cast<int32_t>(get(6, row));
+    row_stats.equality_delete_record_count = get(7, row);
+    row_stats.equality_delete_file_count = static_cast<int32_t>(get(8, row));
+    row_stats.total_record_count = get_optional(9, row);
+    row_stats.last_updated_at = get_optional(10, row);
+    row_stats.last_updated_snapshot_id = get_optional(11, row);
+    row_stats.dv_count = static_cast<int32_t>(get(12, row));
+  }
+  return {};
+}
+
+/// \brief Adds the live entries of a manifest to a collector.
+Status UpdateFromManifest(const ManifestFile& manifest_file,
+                          const std::shared_ptr<FileIO>& io,
+                          const std::shared_ptr<Schema>& partition_schema,
+                          PartitionStatsCollector& collector) {
+  ICEBERG_ASSIGN_OR_RAISE(auto manifest_reader,
+                          ManifestReader::Make(manifest_file, io, partition_schema));
+  ICEBERG_ASSIGN_OR_RAISE(auto entries, manifest_reader->Entries());
+  for (const auto& entry : entries) {
+    ICEBERG_RETURN_UNEXPECTED(collector.Update(entry));
+  }
+  return {};
+}
+
+}  // namespace
+
+void PartitionStats::Merge(const PartitionStats& other) {
+  spec_id = std::max(spec_id, other.spec_id);
+  data_record_count += other.data_record_count;
+  data_file_count += other.data_file_count;
+  total_data_file_size_in_bytes += other.total_data_file_size_in_bytes;
+  position_delete_record_count += other.position_delete_record_count;
+  position_delete_file_count += other.position_delete_file_count;
+  equality_delete_record_count += other.equality_delete_record_count;
+  equality_delete_file_count += other.equality_delete_file_count;
+  dv_count += other.dv_count;
+  if (total_record_count.has_value() && other.total_record_count.has_value()) {
+    total_record_count = total_record_count.value() + other.total_record_count.value();
+  } else {
+    total_record_count.reset();
+  }
+  if (other.last_updated_at.has_value() &&
+      (!last_updated_at.has_value() || other.last_updated_at > last_updated_at)) {
+    last_updated_at = other.last_updated_at;
+    last_updated_snapshot_id = other.last_updated_snapshot_id;
+  }
+}
+
+Result<std::shared_ptr<StructType>> UnifiedPartitionType(const TableMetadata& metadata) {
+  std::vector<std::shared_ptr<PartitionSpec>> specs = metadata.partition_specs;
+  std::ranges::sort(specs, {}, [](const auto& spec) { return spec->spec_id(); });
+
+  std::vector<SchemaField> fields;
+  std::unordered_map<int32_t, size_t> positions;
+  for (const auto& spec : specs) {
+    ICEBERG_ASSIGN_OR_RAISE(auto partition_type, spec->PartitionType());
+    if (partition_type == nullptr) {
+      continue;
+    }
+    for (const auto& field : partition_type->fields()) {
+      auto [it, inserted] = positions.try_emplace(field.field_id(), fields.size());
+      if (inserted) {
+        fields.push_back(SchemaField::MakeOptional(
+            field.field_id(), std::string(field.name()), field.type()));
+      } else if (*fields[it->second].type() != *field.type()) {
+        return InvalidArgument(
+            "Conflicting types of partition field {} in partition spec {}: {} and {}",
+            field.field_id(), spec->spec_id(), fields[it->second].type()->ToString(),
+            field.type()->ToString());
+      }
+    }
+  }
+  return std::make_shared<StructType>(std::move(fields));
+}
+
+std::shared_ptr<Schema> PartitionStatsSchema(std::shared_ptr<StructType> partition_type) {
+  return std::make_shared<Schema>(std::vector<SchemaField>{
+      SchemaField::MakeRequired(1, "partition", std::move(partition_type)),
+      SchemaField::MakeRequired(2, "spec_id", int32()),
+      SchemaField::MakeRequired(3, "data_record_count", int64()),
+      SchemaField::MakeRequired(4, "data_file_count", int32()),
+      SchemaField::MakeRequired(5, "total_data_file_size_in_bytes", int64()),
+      SchemaField::MakeOptional(6, "position_delete_record_count", int64()),
+      SchemaField::MakeOptional(7, "position_delete_file_count", int32()),
+      SchemaField::MakeOptional(8, "equality_delete_record_count", int64()),
+      SchemaField::MakeOptional(9, "equality_delete_file_count", int32()),
+      SchemaField::MakeOptional(10, "total_record_count", int64()),
+      SchemaField::MakeOptional(11, "last_updated_at", int64()),
+      SchemaField::MakeOptional(12, "last_updated_snapshot_id", int64()),
+      SchemaField::MakeOptional(13, "dv_count", int32())});
+}
+
+PartitionStatsCollector::PartitionStatsCollector(
+    std::shared_ptr<StructType> partition_type,
+    std::unordered_map<int32_t, std::vector<size_t>> spec_positions,
+    std::unordered_map<int64_t, int64_t> snapshot_timestamps)
+    : partition_type_(std::move(partition_type)),
+      spec_positions_(std::move(spec_positions)),
+      snapshot_timestamps_(std::move(snapshot_timestamps)) {}
+
+Result<PartitionStatsCollector> PartitionStatsCollector::Make(
+    const TableMetadata& metadata) {
+  ICEBERG_ASSIGN_OR_RAISE(auto partition_type, UnifiedPartitionType(metadata));
+  std::unordered_map<int32_t, size_t> positions;
+  const auto fields = partition_type->fields();
+  for (size_t i = 0; i < fields.size(); ++i) {
+    positions.emplace(fields[i].field_id(), i);
+  }
+
+  std::unordered_map<int32_t, std::vector<size_t>> spec_positions;
+  for (const auto& spec : metadata.partition_specs) {
+    auto& spec_fields = spec_positions[spec->spec_id()];
+    for (const auto& field : spec->fields()) {
+      spec_fields.push_back(positions.at(field.field_id()));
+    }
+  }
+  std::unordered_map<int64_t, int64_t> snapshot_timestamps;
+  for (const auto& snapshot : metadata.snapshots) {
+    snapshot_timestamps.emplace(snapshot->snapshot_id,
+                                UnixMsFromTimePointMs(snapshot->timestamp_ms));
+  }
+  return PartitionStatsCollector(std::move(partition_type), std::move(spec_positions),
+                                 std::move(snapshot_timestamps));
+}
+
+Status PartitionStatsCollector::Update(const ManifestEntry& entry) {
+  if (entry.status == ManifestStatus::kDeleted) {
+    return {};
+  }
+  const DataFile& file = *entry.data_file;
+  auto spec_it = spec_positions_.find(file.partition_spec_id);
+  if (spec_it == spec_positions_.end()) {
+    return InvalidArgument("Unknown partition spec {} of {}", file.partition_spec_id,
+                           file.file_path);
+  }
+  const auto& positions = spec_it->second;
+  if (file.partition.size() != positions.size()) {
+    return InvalidManifest("Expected {} partition values of {}, got {}",
+                           positions.size(), file.file_path, file.partition.size());
+  }
+
+  const auto fields = partition_type_->fields();
+  std::vector<Literal> partition;
+  partition.reserve(fields.size());
+  for (const auto& field : fields) {
+    partition.push_back(
+        Literal::Null(internal::checked_pointer_cast<PrimitiveType>(field.type())));
+  }
+  for (size_t i = 0; i < positions.size(); ++i) {
+    partition[positions[i]] = file.partition[i];
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto key, PartitionTupleKey::Make(kUnifiedSpecId, partition));
+  auto [stats_ptr, inserted] = stats_.TryEmplace(std::move(key));
+  PartitionStats& stats = *stats_ptr;
+  if (inserted) {
+    stats.partition = std::move(partition);
+    stats.spec_id = file.partition_spec_id;
+  } else {
+    stats.spec_id = std::max(stats.spec_id, file.partition_spec_id);
+  }
+
+  switch (file.content) {
+    case DataFile::Content::kData:
+      stats.data_record_count += file.record_count;
+      ++stats.data_file_count;
+      stats.total_data_file_size_in_bytes += file.file_size_in_bytes;
+      break;
+    case DataFile::Content::kPositionDeletes:
+      stats.position_delete_record_count += file.record_count;
+      if (file.file_format == FileFormatType::kPuffin) {
+        ++stats.dv_count;
+      } else {
+        ++stats.position_delete_file_count;
+      }
+      break;
+    case DataFile::Content::kEqualityDeletes:
+      stats.equality_delete_record_count += file.record_count;
+      ++stats.equality_delete_file_count;
+      break;
+  }
+
+  if (entry.snapshot_id.has_value()) {
+    auto timestamp_it = snapshot_timestamps_.find(entry.snapshot_id.value());
+    if (timestamp_it != snapshot_timestamps_.end() &&
+        (!stats.last_updated_at.has_value() ||
+         timestamp_it->second > stats.last_updated_at.value())) {
+      stats.last_updated_at = timestamp_it->second;
+      stats.last_updated_snapshot_id = entry.snapshot_id;
+    }
+  }
+  return {};
+}
+
+void PartitionStatsCollector::Merge(const PartitionStatsCollector& other) {
+  for (const auto& [key, other_stats] : other.stats_) {
+    auto [stats, inserted] = stats_.TryEmplace(key, other_stats);
+    if (!inserted) {
+      stats->Merge(other_stats);
+    }
+  }
+}
+
+std::vector<PartitionStats> PartitionStatsCollector::stats() const {
+  std::vector<PartitionStats> stats;
+  stats.reserve(stats_.size());
+  for (const auto& [key, partition_stats] : stats_) {
+    stats.push_back(partition_stats);
+  }
+  return stats;
+}
+
+Result<PartitionStatsCollector> ComputePartitionStats(
+    const TableMetadata& metadata, int64_t snapshot_id,
+    const std::shared_ptr<FileIO>& io, int32_t parallelism,
+    std::shared_ptr<Executor> executor) {
+  if (parallelism < 1) {
+    return InvalidArgument("Parallelism must be positive, got {}", parallelism);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto snapshot, metadata.SnapshotById(snapshot_id));
+  ICEBERG_ASSIGN_OR_RAISE(auto collector, PartitionStatsCollector::Make(metadata));
+  ICEBERG_ASSIGN_OR_RAISE(auto manifest_list_reader,
+                          ManifestListReader::Make(snapshot->manifest_list, io));
+  ICEBERG_ASSIGN_OR_RAISE(auto manifest_files, manifest_list_reader->Files());
+
+  // Resolve the partition schema of every spec up front, workers only read the map.
+  std::unordered_map<int32_t, std::shared_ptr<Schema>> partition_schemas;
+  for (const auto& manifest_file : manifest_files) {
+    if (partition_schemas.contains(manifest_file.partition_spec_id)) {
+      continue;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto partition_spec,
+                            metadata.PartitionSpecById(manifest_file.partition_spec_id));
+    ICEBERG_ASSIGN_OR_RAISE(auto partition_schema, partition_spec->PartitionSchema());
+    partition_schemas.emplace(manifest_file.partition_spec_id,
+                              std::move(partition_schema));
+  }
+
+  const auto num_workers =
+      std::min(manifest_files.size(), static_cast<size_t>(parallelism));
+  std::vector<PartitionStatsCollector> collectors(num_workers, collector);
+  // Each worker reads the manifests it claims into its own collector, and no manifest
+  // is claimed after a failure.
+  std::atomic<size_t> next_manifest = 0;
+  auto read = [&](size_t worker) -> Status {
+    for (size_t i = next_manifest++; i < manifest_files.size(); i = next_manifest++) {
+      const auto& manifest_file = manifest_files[i];
+      auto status = UpdateFromManifest(
+          manifest_file, io, partition_schemas.at(manifest_file.partition_spec_id),
+          collectors[worker]);
+      if (!status.has_value()) {
+        next_manifest = manifest_files.size();
+        return status;
+      }
+    }
+    return {};
+  };
+  ICEBERG_RETURN_UNEXPECTED(
+      RunInParallel(executor != nullptr ? *executor : *DefaultExecutor(), num_workers,
+                    static_cast<int32_t>(num_workers), read));
+
+  for (const auto& worker_collector : collectors) {
+    collector.Merge(worker_collector);
+  }
+  return collector;
+}
+
+Result<ArrowArray> PartitionStatsToArrow(
+    const ArrowSchema& schema, const std::shared_ptr<StructType>& partition_type,
+    std::span<const PartitionStats> stats) {
+  ArrowError error;
+  ArrowArray array;
+  ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(
+      ArrowArrayInitFromSchema(&array, &schema, &error), error);
+  auto build = [&]() -> Status {
+    ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayStartAppending(&array));
+    for (const auto& partition_stats : stats) {
+      ICEBERG_RETURN_UNEXPECTED(AppendStats(&array, partition_type, partition_stats));
+    }
+    ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(
+        ArrowArrayFinishBuildingDefault(&array, &error), error);
+    return {};
+  };
+  if (auto status = build(); !status.has_value()) {
+    ArrowArrayRelease(&array);
+    return std::unexpected(status.error());
+  }
+  return array;
+}
+
+Result<PartitionStatisticsFile> WritePartitionStatsFile(
+    const std::shared_ptr<StructType>& partition_type,
+    std::span<const PartitionStats> stats, int64_t snapshot_id, FileFormatType format,
+    const std::string& path, const std::shared_ptr<FileIO>& io) {
+  if (partition_type == nullptr || partition_type->fields().empty()) {
+    return InvalidArgument("Cannot write partition statistics of unpartitioned tables");
+  }
+  auto schema = PartitionStatsSchema(partition_type);
+  ArrowSchema arrow_schema;
+  ICEBERG_RETURN_UNEXPECTED(ToArrowSchema(*schema, &arrow_schema));
+  internal::ArrowSchemaGuard schema_guard(&arrow_schema);
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto writer, WriterFactoryRegistry::Open(
+                       format, WriterOptions{.path = path, .schema = schema, .io = io}));
+
+  auto write_batch = [&](std::span<const PartitionStats> batch_stats) -> Status {
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto array, PartitionStatsToArrow(arrow_schema, partition_type, batch_stats));
+    // The writer takes the ownership of the batch.
+    return writer->Write(&array);
+  };
+  for (size_t offset = 0; offset < stats.size(); offset += kBatchRows) {
+    auto status = write_batch(
+        stats.subspan(offset, std::min(stats.size() - offset, size_t{kBatchRows})));
+    if (!status.has_value()) {
+      std::ignore = writer->Close();
+      return std::unexpected(status.error());
+    }
+  }
+  ICEBERG_RETURN_UNEXPECTED(writer->Close());
+
+  auto length = writer->length();
+  if (!length.has_value()) {
+    return InvalidArgument("Writer did not report the length of {}", path);
+  }
+  return PartitionStatisticsFile{
+      .snapshot_id = snapshot_id, .path = path, .file_size_in_bytes = length.value()};
+}
+
+Result<std::vector<PartitionStats>> ReadPartitionStatsFile(
+    const std::shared_ptr<StructType>& partition_type,
+    const PartitionStatisticsFile& file, const std::shared_ptr<FileIO>& io) {
+  const auto extension_pos = file.path.rfind('.');
+  if (extension_pos == std::string::npos) {
+    return InvalidArgument("Cannot infer the format of partition statistics file {}",
+                           file.path);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto format,
+                          FileFormatTypeFromString(file.path.substr(extension_pos + 1)));
+  const ReaderOptions options{.path = file.path,
+                              .length = static_cast<size_t>(file.file_size_in_bytes),
+                              .io = io,
+                              .projection = PartitionStatsSchema(partition_type)};
+  ICEBERG_ASSIGN_OR_RAISE(auto reader, ReaderFactoryRegistry::Open(format, options));
+
+  std::vector<PartitionStats> stats;
+  ICEBERG_ASSIGN_OR_RAISE(auto arrow_schema, reader->Schema());
+  internal::ArrowSchemaGuard schema_guard(&arrow_schema);
+  while (true) {
+    ICEBERG_ASSIGN_OR_RAISE(auto batch, reader->Next());
+    if (!batch.has_value()) {
+      break;
+    }
+    internal::ArrowArrayGuard array_guard(&batch.value());
+    ICEBERG_RETURN_UNEXPECTED(
+        ParseStats(arrow_schema, batch.value(), *partition_type, stats));
+  }
+  ICEBERG_RETURN_UNEXPECTED(reader->Close());
+  return stats;
+}
+
+Result<PartitionCounts> CountPartitions(
+    const std::shared_ptr<StructType>& partition_type,
+    std::span<const PartitionStats> stats,
+    const std::shared_ptr<Expression>& partition_filter, bool case_sensitive) {
+  PartitionCounts counts;
+  auto add = [&](const PartitionStats& partition_stats) {
+    ++counts.partition_count;
+    counts.data_record_count += partition_stats.data_record_count;
+    counts.data_file_count += partition_stats.data_file_count;
+    counts.total_data_file_size_in_bytes += partition_stats.total_data_file_size_in_bytes;
+    counts.delete_file_count += partition_stats.delete_file_count();
+  };
+  if (partition_filter == nullptr) {
+    std::ranges::for_each(stats, add);
+    return counts;
+  }
+
+  // The partition tuples are evaluated as a batch whose columns are the partition
+  // fields.
+  auto schema = FromStructType(*partition_type, std::nullopt);
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto evaluator, BatchEvaluator::Make(*schema, partition_filter, case_sensitive));
+  ArrowSchema arrow_schema;
+  ICEBERG_RETURN_UNEXPECTED(ToArrowSchema(*schema, &arrow_schema));
+  internal::ArrowSchemaGuard schema_guard(&arrow_schema);
+  ArrowError error;
+  ArrowArray array;
+  ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(
+      ArrowArrayInitFromSchema(&array, &arrow_schema, &error), error);
+  internal::ArrowArrayGuard array_guard(&array);
+  ICEBERG_NANOARROW_RETURN_UNEXPECTED(ArrowArrayStartAppending(&array));
+  for (const auto& partition_stats : stats) {
+    ICEBERG_RETURN_UNEXPECTED(ManifestEntryAdapter::AppendPartitionValues(
+        &array, partition_type, partition_stats.partition));
+  }
+  ICEBERG_NANOARROW_RETURN_UNEXPECTED_WITH_ERROR(
+      ArrowArrayFinishBuildingDefault(&array, &error), error);
+
+  ICEBERG_ASSIGN_OR_RAISE(auto selection, evaluator->Evaluate(arrow_schema, array));
+  for (size_t i = 0; i < stats.size(); ++i) {
+    if (GetBit(selection.data(), static_cast<int64_t>(i))) {
+      add(stats[i]);
+    }
+  }
+  return counts;
+}
+
+Result<std::optional<PartitionCounts>> CountPartitionsFromStatistics(
+    const TableMetadata& metadata, int64_t snapshot_id,
+    const std::shared_ptr<FileIO>& io,
+    const std::shared_ptr<Expression>& partition_filter, bool case_sensitive) {
+  auto it = std::ranges::find_if(metadata.partition_statistics, [&](const auto& file) {
+    return file->snapshot_id == snapshot_id;
+  });
+  if (it == metadata.partition_statistics.end()) {
+    return std::nullopt;
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto partition_type, UnifiedPartitionType(metadata));
+  ICEBERG_ASSIGN_OR_RAISE(auto stats, ReadPartitionStatsFile(partition_type, **it, io));
+  return CountPartitions(partition_type, stats, partition_filter, case_sensitive);
+}
+
+}  // namespace iceberg
@@ -0,0 +1,237 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/partition_statistics.h
+/// Aggregation of per-partition file and record counts into partition statistics
+/// files, and answers to partition-level count queries from those files.
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "iceberg/arrow_c_data.h"
+#include "iceberg/expression/literal.h"
+#include "iceberg/file_format.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/partition_map.h"
+#include "iceberg/result.h"
+#include "iceberg/statistics_file.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief Statistics of the live files of a partition.
+struct ICEBERG_EXPORT PartitionStats {
+  /// The partition tuple in the unified partition type of the table
+  std::vector<Literal> partition;
+  /// The id of the latest partition spec the files of the partition were written with
+  int32_t spec_id = 0;
+  /// The number of records in the data files
+  int64_t data_record_count = 0;
+  /// The number of data files
+  int32_t data_file_count = 0;
+  /// The total size of the data files in bytes
+  int64_t total_data_file_size_in_bytes = 0;
+  /// The number of deleted positions in the position delete files and deletion vectors
+  int64_t position_delete_record_count = 0;
+  /// The number of position delete files, without deletion vectors
+  int32_t position_delete_file_count = 0;
+  /// The number of records in the equality delete files
+  int64_t equality_delete_record_count = 0;
+  /// The number of equality delete files
+  int32_t equality_delete_file_count = 0;
+  /// The number of records after applying the deletes, if it was computed
+  std::optional<int64_t> total_record_count;
+  /// The commit time of the latest snapshot that added files to the partition, in
+  /// milliseconds since the epoch
+  std::optional<int64_t> last_updated_at;
+  /// The id of the latest snapshot that added files to the partition
+  std::optional<int64_t> last_updated_snapshot_id;
+  /// The number of deletion vectors
+  int32_t dv_count = 0;
+
+  /// \brief The number of delete files and deletion vectors of the partition.
+  int64_t delete_file_count() const {
+    return static_cast<int64_t>(position_delete_file_count) +
+           equality_delete_file_count + dv_count;
+  }
+
+  /// \brief Adds the statistics of the same partition, e.g. computed by another thread.
+  void Merge(const PartitionStats& other);
+
+  friend bool operator==(const PartitionStats& lhs, const PartitionStats& rhs) = default;
+};
+
+/// \brief Returns the type of the partition tuples of all the partition specs of a
+/// table.
+///
+/// The type has an optional field for each partition field of any spec, in the order
+/// of the specs and of their fields. Tuples of a spec have null values for the fields
+/// of the other specs.
+ICEBERG_EXPORT Result<std::shared_ptr<StructType>> UnifiedPartitionType(
+    const TableMetadata& metadata);
+
+/// \brief Returns the schema of the partition statistics files of a table.
+///
+/// \param partition_type The unified partition type of the table
+ICEBERG_EXPORT std::shared_ptr<Schema> PartitionStatsSchema(
+    std::shared_ptr<StructType> partition_type);
+
+/// \brief Aggregates the statistics of partitions from the entries of manifests.
+class ICEBERG_EXPORT PartitionStatsCollector {
+ public:
+  /// \brief Makes a collector of the partitions of a table.
+  static Result<PartitionStatsCollector> Make(const TableMetadata& metadata);
+
+  /// \brief Adds a live manifest entry to the statistics of its partition.
+  ///
+  /// The partition spec id of the data file and the snapshot id of the entry must be
+  /// set, as they are once the entry is read from its manifest.
+  Status Update(const ManifestEntry& entry);
+
+  /// \brief Merges the statistics of a collector of the same table, e.g. of another
+  /// thread.
+  void Merge(const PartitionStatsCollector& other);
+
+  /// \brief The unified partition type of the partition tuples.
+  const std::shared_ptr<StructType>& partition_type() const { return partition_type_; }
+
+  /// \brief The statistics of the partitions, in no particular order.
+  std::vector<PartitionStats> stats() const;
+
+ private:
+  PartitionStatsCollector(
+      std::shared_ptr<StructType> partition_type,
+      std::unordered_map<int32_t, std::vector<size_t>> spec_positions,
+      std::unordered_map<int64_t, int64_t> snapshot_timestamps);
+
+  std::shared_ptr<StructType> partition_type_;
+  // The positions of the fields of each spec in the unified partition type.
+  std::unordered_map<int32_t, std::vector<size_t>> spec_positions_;
+  // The commit times of the snapshots of the table, keyed by snapshot id.
+  std::unordered_map<int64_t, int64_t> snapshot_timestamps_;
+  // Partition statistics keyed by the partition tuple of the unified partition type.
+  PartitionMap<PartitionStats> stats_;
+};
+
+/// \brief Computes the statistics of the partitions of a snapshot from its manifests.
+///
+/// \param metadata The table metadata
+/// \param snapshot_id The snapshot whose live files are counted
+/// \param io The FileIO to read the manifests
+/// \param parallelism The number of manifests read concurrently, each into a collector
+/// of its own that is merged once all the manifests are read
+/// \param executor The executor reading the manifests concurrently, the
+/// DefaultExecutor() if null
+ICEBERG_EXPORT Result<PartitionStatsCollector> ComputePartitionStats(
+    const TableMetadata& metadata, int64_t snapshot_id,
+    const std::shared_ptr<FileIO>& io, int32_t parallelism = 1,
+    std::shared_ptr<Executor> executor = nullptr);
+
+/// \brief Appends the statistics of partitions to a new Arrow array.
+///
+/// \param schema The Arrow schema of `PartitionStatsSchema(partition_type)`
+/// \param partition_type The unified partition type of the partition tuples
+/// \param stats The statistics to append, one row per partition
+/// \return A struct array that must be released by the caller
+ICEBERG_EXPORT Result<ArrowArray> PartitionStatsToArrow(
+    const ArrowSchema& schema, const std::shared_ptr<StructType>& partition_type,
+    std::span<const PartitionStats> stats);
+
+/// \brief Writes the statistics of partitions to a partition statistics file.
+///
+/// \param partition_type The unified partition type of the partition tuples
+/// \param stats The statistics to write
+/// \param snapshot_id The snapshot the statistics were computed from
+/// \param format The format of the file
+/// \param path The location of the file
+/// \param io The FileIO to write the file
+/// \return The partition statistics file to register in the table metadata with
+/// `TableMetadataBuilder::SetPartitionStatistics`.
+ICEBERG_EXPORT Result<PartitionStatisticsFile> WritePartitionStatsFile(
+    const std::shared_ptr<StructType>& partition_type,
+    std::span<const PartitionStats> stats, int64_t snapshot_id, FileFormatType format,
+    const std::string& path, const std::shared_ptr<FileIO>& io);
+
+/// \brief Reads the statistics of partitions from a partition statistics file.
+///
+/// The format of the file is inferred from the extension of its path.
+///
+/// \param partition_type The unified partition type of the table
+/// \param file The partition statistics file
+/// \param io The FileIO to read the file
+ICEBERG_EXPORT Result<std::vector<PartitionStats>> ReadPartitionStatsFile(
+    const std::shared_ptr<StructType>& partition_type,
+    const PartitionStatisticsFile& file, const std::shared_ptr<FileIO>& io);
+
+/// \brief Counts of the files and records of a set of partitions.
+struct ICEBERG_EXPORT PartitionCounts {
+  /// The number of partitions
+  int64_t partition_count = 0;
+  /// The number of records in the data files
+  int64_t data_record_count = 0;
+  /// The number of data files
+  int64_t data_file_count = 0;
+  /// The total size of the data files in bytes
+  int64_t total_data_file_size_in_bytes = 0;
+  /// The number of delete files and deletion vectors
+  int64_t delete_file_count = 0;
+
+  /// \brief The exact number of rows of the partitions, which is known when they have
+  /// no deletes.
+  std::optional<int64_t> row_count() const {
+    if (delete_file_count != 0) {
+      return std::nullopt;
+    }
+    return data_record_count;
+  }
+};
+
+/// \brief Counts the files and records of the partitions matching a partition filter.
+///
+/// \param partition_type The unified partition type of the partition tuples
+/// \param stats The statistics of the partitions
+/// \param partition_filter A filter on the fields of the partition type, or null to
+/// count all the partitions. Partitions are selected by the exact value of their tuple,
+/// so that the counts are exact.
+/// \param case_sensitive Whether field name matching should be case sensitive
+ICEBERG_EXPORT Result<PartitionCounts> CountPartitions(
+    const std::shared_ptr<StructType>& partition_type,
+    std::span<const PartitionStats> stats,
+    const std::shared_ptr<Expression>& partition_filter, bool case_sensitive = true);
+
+/// \brief Counts the files and records of the partitions of a snapshot matching a
+/// partition filter from its partition statistics file, without reading manifests.
+///
+/// A `COUNT(*)` query whose filter only selects partitions is answered by the
+/// `row_count()` of the counts, when it is known.
+///
+/// \return The counts, or nullopt if the snapshot has no partition statistics file.
+ICEBERG_EXPORT Result<std::optional<PartitionCounts>> CountPartitionsFromStatistics(
+    const TableMetadata& metadata, int64_t snapshot_id,
+    const std::shared_ptr<FileIO>& io,
+    const std::shared_ptr<Expression>& partition_filter, bool case_sensitive = true);
+
+}  // namespace iceberg
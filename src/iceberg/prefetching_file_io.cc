@@ -0,0 +1,289 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/prefetching_file_io.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "iceberg/executor.h"
+
+namespace iceberg {
+
+/// \brief The files read ahead by a PrefetchingFileIO, shared with the submitted reads,
+/// which may start after the FileIO is destroyed.
+class FilePrefetchState {
+ public:
+  FilePrefetchState(std::shared_ptr<FileIO> file_io,
+                    std::vector<PrefetchingFileIO::File> files, size_t capacity,
+                    size_t capacity_bytes, std::shared_ptr<Executor> executor)
+      : file_io_(std::move(file_io)),
+        capacity_(capacity),
+        capacity_bytes_(capacity_bytes),
+        executor_(std::move(executor)) {
+    entries_.reserve(files.size());
+    for (auto& file : files) {
+      // A file listed twice is read ahead once.
+      if (index_.try_emplace(file.location, entries_.size()).second) {
+        entries_.push_back({.location = std::move(file.location), .length = file.length});
+      }
+    }
+    pending_ = entries_.size();
+  }
+
+  /// \brief Submits the first reads ahead.
+  static void Start(const std::shared_ptr<FilePrefetchState>& state) {
+    std::unique_lock lock(state->mutex_);
+    Schedule(state, lock);
+  }
+
+  /// \brief Stops reading ahead, the running reads finish without being waited for.
+  void Stop() {
+    std::lock_guard lock(mutex_);
+    stopped_ = true;
+  }
+
+  /// \brief Returns whether a file is read ahead and not taken yet.
+  bool IsPrefetched(const std::string& location) {
+    std::lock_guard lock(mutex_);
+    auto it = index_.find(location);
+    return it != index_.end() && entries_[it->second].state != EntryState::kTaken;
+  }
+
+  /// \brief Takes the content of a file read ahead, reading it if its read did not
+  /// start.
+  ///
+  /// \return The content or the error of reading the file, or nullopt if the file is
+  /// not read ahead or was already taken.
+  static std::optional<Result<std::string>> Take(
+      const std::shared_ptr<FilePrefetchState>& state, const std::string& location,
+      std::optional<size_t> length) {
+    std::unique_lock lock(state->mutex_);
+    auto it = state->index_.find(location);
+    if (it == state->index_.end()) {
+      return std::nullopt;
+    }
+    auto& entry = state->entries_[it->second];
+    switch (entry.state) {
+      case EntryState::kTaken:
+        return std::nullopt;
+      case EntryState::kPending:
+        entry.state = EntryState::kTaken;
+        --state->pending_;
+        lock.unlock();
+        return state->file_io_->ReadFile(location, entry.length ? entry.length : length);
+      case EntryState::kRunning:
+      case EntryState::kFetched:
+        break;
+    }
+    state->cv_.wait(lock, [&]() { return entry.state == EntryState::kFetched; });
+    auto content = std::exchange(entry.content, std::string{});
+    entry.state = EntryState::kTaken;
+    --state->held_;
+    state->held_bytes_ -= entry.length.value_or(0);
+    Schedule(state, lock);
+    return content;
+  }
+
+ private:
+  enum class EntryState {
+    kPending,
+    kRunning,
+    kFetched,
+    kTaken,
+  };
+
+  struct Entry {
+    std::string location;
+    std::optional<size_t> length;
+    EntryState state = EntryState::kPending;
+    Result<std::string> content;
+  };
+
+  /// \brief Submits reads ahead while there is room for them, called with the lock
+  /// held.
+  ///
+  /// The queued reads take the next pending entries in order, so the bytes they will
+  /// hold are those of the entries after the ones being read. Files the consumer reads
+  /// itself meanwhile may make them take later entries, which only overshoots the byte
+  /// capacity by a few files.
+  static void Schedule(const std::shared_ptr<FilePrefetchState>& state,
+                       std::unique_lock<std::mutex>& lock) {
+    const auto& entries = state->entries_;
+    size_t cursor = state->next_;
+    auto next_pending_length = [&]() -> size_t {
+      while (cursor < entries.size() && entries[cursor].state != EntryState::kPending) {
+        ++cursor;
+      }
+      return cursor < entries.size() ? entries[cursor++].length.value_or(0) : 0;
+    };
+    size_t reserved_bytes = state->held_bytes_;
+    if (state->capacity_bytes_ > 0) {
+      for (size_t i = 0; i < state->queued_; ++i) {
+        reserved_bytes += next_pending_length();
+      }
+    }
+    size_t submits = 0;
+    while (!state->stopped_ && state->queued_ + state->held_ < state->capacity_ &&
+           state->queued_ < state->pending_) {
+      if (state->capacity_bytes_ > 0) {
+        auto length = next_pending_length();
+        if (state->queued_ + state->held_ > 0 &&
+            reserved_bytes + length > state->capacity_bytes_) {
+          break;
+        }
+        reserved_bytes += length;
+      }
+      ++state->queued_;
+      ++submits;
+    }
+    if (submits == 0) {
+      return;
+    }
+    lock.unlock();
+    for (size_t i = 0; i < submits; ++i) {
+      state->executor_->Submit([state]() { Fetch(state); });
+    }
+    lock.lock();
+  }
+
+  /// \brief Reads the next file that is neither read nor taken, if any.
+  static void Fetch(const std::shared_ptr<FilePrefetchState>& state) {
+    std::unique_lock lock(state->mutex_);
+    --state->queued_;
+    auto& entries = state->entries_;
+    while (state->next_ < entries.size() &&
+           entries[state->next_].state != EntryState::kPending) {
+      ++state->next_;
+    }
+    if (state->stopped_ || state->next_ == entries.size()) {
+      return;
+    }
+    auto& entry = entries[state->next_++];
+    entry.state = EntryState::kRunning;
+    --state->pending_;
+    ++state->held_;
+    state->held_bytes_ += entry.length.value_or(0);
+    lock.unlock();
+    auto content = state->file_io_->ReadFile(entry.location, entry.length);
+    lock.lock();
+    entry.content = std::move(content);
+    entry.state = EntryState::kFetched;
+    state->cv_.notify_all();
+  }
+
+  const std::shared_ptr<FileIO> file_io_;
+  const size_t capacity_;
+  /// \brief The maximum length of the held entries, or 0 for no bound.
+  const size_t capacity_bytes_;
+  const std::shared_ptr<Executor> executor_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  /// \brief The files to read ahead, in order. Entries are never added or removed.
+  std::vector<Entry> entries_;
+  std::unordered_map<std::string, size_t> index_;
+  /// \brief No entry before this one is pending.
+  size_t next_ = 0;
+  /// \brief The entries neither read nor taken.
+  size_t pending_ = 0;
+  /// \brief The reads submitted and not started yet.
+  size_t queued_ = 0;
+  /// \brief The entries being read or read, and not taken yet.
+  size_t held_ = 0;
+  /// \brief The total length of the held entries.
+  size_t held_bytes_ = 0;
+  bool stopped_ = false;
+};
+
+PrefetchingFileIO::PrefetchingFileIO(std::shared_ptr<FileIO> file_io,
+                                     std::shared_ptr<FilePrefetchState> state)
+    : file_io_(std::move(file_io)), state_(std::move(state)) {}
+
+PrefetchingFileIO::~PrefetchingFileIO() { state_->Stop(); }
+
+Result<std::shared_ptr<PrefetchingFileIO>> PrefetchingFileIO::Make(
+    std::shared_ptr<FileIO> file_io, std::vector<File> files, size_t capacity,
+    std::shared_ptr<Executor> executor, size_t capacity_bytes) {
+  if (file_io == nullptr) {
+    return InvalidArgument("FileIO to prefetch from must not be null");
+  }
+  if (capacity == 0) {
+    return InvalidArgument("Number of files to prefetch must be positive");
+  }
+  auto state = std::make_shared<FilePrefetchState>(
+      file_io, std::move(files), capacity, capacity_bytes,
+      executor != nullptr ? std::move(executor) : DefaultExecutor());
+  FilePrefetchState::Start(state);
+  return std::shared_ptr<PrefetchingFileIO>(
+      new PrefetchingFileIO(std::move(file_io), std::move(state)));
+}
+
+Result<std::string> PrefetchingFileIO::ReadFile(const std::string& file_location,
+                                                std::optional<size_t> length) {
+  if (auto content = FilePrefetchState::Take(state_, file_location, length)) {
+    return std::move(content.value());
+  }
+  return file_io_->ReadFile(file_location, length);
+}
+
+Status PrefetchingFileIO::WriteFile(const std::string& file_location,
+                                    std::string_view content) {
+  return file_io_->WriteFile(file_location, content);
+}
+
+Status PrefetchingFileIO::WriteFileIfAbsent(const std::string& file_location,
+                                            std::string_view content) {
+  return file_io_->WriteFileIfAbsent(file_location, content);
+}
+
+Result<bool> PrefetchingFileIO::FileExists(const std::string& file_location) {
+  return file_io_->FileExists(file_location);
+}
+
+Result<std::unique_ptr<InputFile>> PrefetchingFileIO::NewInputFile(
+    const std::string& file_location, std::optional<size_t> length) {
+  if (state_->IsPrefetched(file_location)) {
+    // Served from memory by ReadFile.
+    return FileIO::NewInputFile(file_location, length);
+  }
+  return file_io_->NewInputFile(file_location, length);
+}
+
+Result<std::unique_ptr<OutputFile>> PrefetchingFileIO::NewOutputFile(
+    const std::string& file_location) {
+  return file_io_->NewOutputFile(file_location);
+}
+
+Status PrefetchingFileIO::DeleteFile(const std::string& file_location) {
+  return file_io_->DeleteFile(file_location);
+}
+
+std::vector<FileDeleteFailure> PrefetchingFileIO::DeleteFiles(
+    std::span<const std::string> file_locations) {
+  return file_io_->DeleteFiles(file_locations);
+}
+
+Status PrefetchingFileIO::ListFiles(
+    const std::string& prefix, const std::function<Status(const FileInfo&)>& visitor) {
+  return file_io_->ListFiles(prefix, visitor);
+}
+
+}  // namespace iceberg
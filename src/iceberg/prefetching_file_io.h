@@ -0,0 +1,117 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/prefetching_file_io.h
+/// FileIO decorator reading a known sequence of files ahead on an executor.
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "iceberg/file_io.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+class FilePrefetchState;
+
+/// \brief A FileIO that reads the files about to be read through another FileIO ahead
+/// of time, e.g. the manifests of a scan on an executor dedicated to I/O.
+///
+/// The files to prefetch are read whole with ReadFile, in the order they are given,
+/// while at most `capacity` of them, and with a byte capacity about that many bytes,
+/// are read or being read and not taken yet. The
+/// first ReadFile or NewInputFile of a prefetched file takes its content, waiting for
+/// its read if it is running, and reading it on the calling thread if it did not
+/// start yet, so a slow executor never stalls the reader. This bounds the memory held
+/// by the files read ahead, and lets a consumer that takes files slowly hold back the
+/// reads. Later reads of a taken file, the other files, and all writes, deletes and
+/// listings go to the wrapped FileIO.
+///
+/// Reads are never waited for when the FileIO is destroyed: the reads that did not
+/// start are dropped, and the running ones finish on the executor.
+class ICEBERG_EXPORT PrefetchingFileIO : public FileIO {
+ public:
+  /// \brief A file to read ahead.
+  struct File {
+    /// \brief The location of the file.
+    std::string location;
+    /// \brief The length of the file if known, which saves a request for it.
+    std::optional<size_t> length;
+  };
+
+  ~PrefetchingFileIO() override;
+
+  /// \brief Creates a FileIO reading `files` ahead through `file_io`.
+  ///
+  /// \param file_io The FileIO reading the files
+  /// \param files The files to read ahead, in the order they will be read
+  /// \param capacity The maximum number of files read ahead and not taken yet
+  /// \param executor The executor of the reads ahead, the DefaultExecutor() if null
+  /// \param capacity_bytes The maximum total length of the files read ahead and not
+  /// taken yet, or 0 to only bound their number. The next file is always read ahead
+  /// when none is held, and files of unknown length count as empty.
+  /// \return A Result containing the FileIO, or an error if `file_io` is null or the
+  /// capacity is not positive.
+  static Result<std::shared_ptr<PrefetchingFileIO>> Make(
+      std::shared_ptr<FileIO> file_io, std::vector<File> files, size_t capacity,
+      std::shared_ptr<Executor> executor = nullptr, size_t capacity_bytes = 0);
+
+  Result<std::string> ReadFile(const std::string& file_location,
+                               std::optional<size_t> length) override;
+
+  Status WriteFile(const std::string& file_location, std::string_view content) override;
+
+  Status WriteFileIfAbsent(const std::string& file_location,
+                           std::string_view content) override;
+
+  Result<bool> FileExists(const std::string& file_location) override;
+
+  Result<std::unique_ptr<InputFile>> NewInputFile(const std::string& file_location,
+                                                  std::optional<size_t> length) override;
+
+  Result<std::unique_ptr<OutputFile>> NewOutputFile(
+      const std::string& file_location) override;
+
+  Status DeleteFile(const std::string& file_location) override;
+
+  std::vector<FileDeleteFailure> DeleteFiles(
+      std::span<const std::string> file_locations) override;
+
+  Status ListFiles(const std::string& prefix,
+                   const std::function<Status(const FileInfo&)>& visitor) override;
+
+ private:
+  PrefetchingFileIO(std::shared_ptr<FileIO> file_io,
+                    std::shared_ptr<FilePrefetchState> state);
+
+  std::shared_ptr<FileIO> file_io_;
+  std::shared_ptr<FilePrefetchState> state_;
+};
+
+}  // namespace iceberg
@@ -0,0 +1,461 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/puffin/bloom_filter_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_set>
+#include <utility>
+
+#include "iceberg/arrow_c_data.h"
+#include "iceberg/expression/binder.h"
+#include "iceberg/expression/expression.h"
+#include "iceberg/expression/literal.h"
+#include "iceberg/expression/predicate.h"
+#include "iceberg/expression/rewrite_not.h"
+#include "iceberg/expression/term.h"
+#include "iceberg/file_io.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/puffin/puffin_format.h"
+#include "iceberg/puffin/puffin_reader.h"
+#include "iceberg/puffin/puffin_writer.h"
+#include "iceberg/row/arrow_array_wrapper.h"
+#include "iceberg/schema.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/table_scan.h"
+#include "iceberg/type.h"
+#include "iceberg/util/binary_codec_internal.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/conversions.h"
+#include "iceberg/util/endian.h"
+#include "iceberg/util/macros.h"
+#include "iceberg/util/murmurhash3_internal.h"
+
+namespace iceberg {
+
+namespace {
+
+constexpr int32_t kMaxHashes = 30;
+
+std::string_view AsStringView(std::span<const uint8_t> bytes) {
+  return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+}
+
+std::string BytesToString(std::vector<uint8_t> bytes) {
+  return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+}
+
+std::span<const uint8_t> AsBytes(std::string_view str) {
+  return {reinterpret_cast<const uint8_t*>(str.data()), str.size()};
+}
+
+}  // namespace
+
+BloomFilter::BloomFilter(int32_t num_hashes, std::vector<uint64_t> words)
+    : num_hashes_(num_hashes), words_(std::move(words)) {}
+
+BloomFilter BloomFilter::Make(int64_t num_values, double false_positive_probability) {
+  const double n = static_cast<double>(std::max<int64_t>(num_values, 1));
+  const double p = std::clamp(false_positive_probability, 1e-9, 0.5);
+  // The optimal number of bits is -n ln(p) / ln(2)^2, with ln(2) m / n hashes.
+  const double bits = std::ceil(-n * std::log(p) / (std::log(2.0) * std::log(2.0)));
+  const auto num_words = std::max<size_t>(1, static_cast<size_t>(std::ceil(bits / 64)));
+  const auto num_hashes = std::clamp<int32_t>(
+      static_cast<int32_t>(std::lround(static_cast<double>(num_words * 64) / n *
+                                       std::log(2.0))),
+      1, kMaxHashes);
+  return BloomFilter(num_hashes, std::vector<uint64_t>(num_words));
+}
+
+void BloomFilter::Add(std::string_view value) {
+  uint64_t hash[2];
+  MurmurHash3_x64_128(value.data(), static_cast<int>(value.size()), 0, hash);
+  const uint64_t num_bits = words_.size() * 64;
+  for (int32_t i = 0; i < num_hashes_; ++i) {
+    const uint64_t bit = (hash[0] + static_cast<uint64_t>(i) * hash[1]) % num_bits;
+    words_[bit >> 6] |= uint64_t{1} << (bit & 63);
+  }
+}
+
+bool BloomFilter::MightContain(std::string_view value) const {
+  uint64_t hash[2];
+  MurmurHash3_x64_128(value.data(), static_cast<int>(value.size()), 0, hash);
+  const uint64_t num_bits = words_.size() * 64;
+  for (int32_t i = 0; i < num_hashes_; ++i) {
+    const uint64_t bit = (hash[0] + static_cast<uint64_t>(i) * hash[1]) % num_bits;
+    if ((words_[bit >> 6] & (uint64_t{1} << (bit & 63))) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string BloomFilter::Serialize() const {
+  std::vector<uint8_t> bits(words_.size() * sizeof(uint64_t));
+  for (size_t i = 0; i < words_.size(); ++i) {
+    const uint64_t word = ToLittleEndian(words_[i]);
+    std::memcpy(bits.data() + i * sizeof(uint64_t), &word, sizeof(uint64_t));
+  }
+  BinaryWriter writer;
+  writer.Byte(static_cast<uint8_t>(num_hashes_));
+  writer.Bytes(bits);
+  return BytesToString(std::move(writer).Finish());
+}
+
+Result<BloomFilter> BloomFilter::Deserialize(std::string_view data) {
+  BinaryReader reader(AsBytes(data));
+  ICEBERG_ASSIGN_OR_RAISE(auto num_hashes, reader.Byte());
+  ICEBERG_ASSIGN_OR_RAISE(auto bits, reader.Bytes());
+  if (num_hashes == 0 || num_hashes > kMaxHashes || bits.empty() ||
+      bits.size() % sizeof(uint64_t) != 0 || !reader.AtEnd()) {
+    return InvalidArgument("Invalid bloom filter of {} bytes", data.size());
+  }
+  std::vector<uint64_t> words(bits.size() / sizeof(uint64_t));
+  for (size_t i = 0; i < words.size(); ++i) {
+    uint64_t word;
+    std::memcpy(&word, bits.data() + i * sizeof(uint64_t), sizeof(uint64_t));
+    words[i] = FromLittleEndian(word);
+  }
+  return BloomFilter(num_hashes, std::move(words));
+}
+
+BloomFilterIndex::BloomFilterIndex(int32_t field_id) : field_id_(field_id) {}
+
+void BloomFilterIndex::Add(std::string file_path, BloomFilter filter) {
+  filters_.insert_or_assign(std::move(file_path), std::move(filter));
+}
+
+const BloomFilter* BloomFilterIndex::FilterFor(std::string_view file_path) const {
+  auto it = filters_.find(file_path);
+  return it != filters_.end() ? &it->second : nullptr;
+}
+
+std::string BloomFilterIndex::Serialize() const {
+  BinaryWriter writer;
+  writer.Varint(filters_.size());
+  for (const auto& [file_path, filter] : filters_) {
+    writer.String(file_path);
+    writer.String(filter.Serialize());
+  }
+  return BytesToString(std::move(writer).Finish());
+}
+
+Result<BloomFilterIndex> BloomFilterIndex::Deserialize(int32_t field_id,
+                                                       std::string_view data) {
+  BinaryReader reader(AsBytes(data));
+  BloomFilterIndex index(field_id);
+  ICEBERG_ASSIGN_OR_RAISE(auto count, reader.Count());
+  for (size_t i = 0; i < count; ++i) {
+    ICEBERG_ASSIGN_OR_RAISE(auto file_path, reader.String());
+    ICEBERG_ASSIGN_OR_RAISE(auto filter_data, reader.Bytes());
+    ICEBERG_ASSIGN_OR_RAISE(auto filter,
+                            BloomFilter::Deserialize(AsStringView(filter_data)));
+    index.Add(std::move(file_path), std::move(filter));
+  }
+  if (!reader.AtEnd()) {
+    return InvalidArgument("Unexpected data at the end of the bloom filter index");
+  }
+  return index;
+}
+
+BloomFilterIndexEvaluator::BloomFilterIndexEvaluator(
+    std::shared_ptr<const BloomFilterIndex> index, std::shared_ptr<Expression> expr)
+    : index_(std::move(index)), expr_(std::move(expr)) {}
+
+Result<std::unique_ptr<BloomFilterIndexEvaluator>> BloomFilterIndexEvaluator::Make(
+    std::shared_ptr<const BloomFilterIndex> index,
+    const std::shared_ptr<Expression>& expr, const Schema& schema,
+    bool case_sensitive) {
+  if (index == nullptr) {
+    return InvalidArgument("Cannot evaluate a null bloom filter index");
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto rewritten, RewriteNot::Rewrite(expr));
+  ICEBERG_ASSIGN_OR_RAISE(auto is_bound, Binder::IsBound(rewritten));
+  if (!is_bound) {
+    ICEBERG_ASSIGN_OR_RAISE(rewritten, Binder::Bind(schema, rewritten, case_sensitive));
+  }
+  return std::unique_ptr<BloomFilterIndexEvaluator>(
+      new BloomFilterIndexEvaluator(std::move(index), std::move(rewritten)));
+}
+
+namespace {
+
+/// \brief Returns false if no row of a file whose key column has a filter can match
+/// the expression.
+Result<bool> MightMatch(const Expression& expr, int32_t field_id,
+                        const BloomFilter& filter) {
+  switch (expr.op()) {
+    case Expression::Operation::kFalse:
+      return false;
+    case Expression::Operation::kAnd: {
+      const auto& and_expr = internal::checked_cast<const And&>(expr);
+      ICEBERG_ASSIGN_OR_RAISE(auto left, MightMatch(*and_expr.left(), field_id, filter));
+      if (!left) {
+        return false;
+      }
+      return MightMatch(*and_expr.right(), field_id, filter);
+    }
+    case Expression::Operation::kOr: {
+      const auto& or_expr = internal::checked_cast<const Or&>(expr);
+      ICEBERG_ASSIGN_OR_RAISE(auto left, MightMatch(*or_expr.left(), field_id, filter));
+      if (left) {
+        return true;
+      }
+      return MightMatch(*or_expr.right(), field_id, filter);
+    }
+    case Expression::Operation::kEq:
+    case Expression::Operation::kIn:
+      break;
+    default:
+      return true;
+  }
+
+  const auto* predicate = dynamic_cast<const BoundPredicate*>(&expr);
+  if (predicate == nullptr || predicate->term()->kind() != Term::Kind::kReference ||
+      predicate->term()->reference()->field().field_id() != field_id) {
+    return true;
+  }
+  if (predicate->kind() == BoundPredicate::Kind::kLiteral) {
+    const auto& literal =
+        internal::checked_cast<const BoundLiteralPredicate&>(expr).literal();
+    ICEBERG_ASSIGN_OR_RAISE(auto bytes, literal.Serialize());
+    return filter.MightContain(AsStringView(bytes));
+  }
+  if (predicate->kind() == BoundPredicate::Kind::kSet) {
+    const auto& type = internal::checked_cast<const PrimitiveType&>(
+        *predicate->term()->reference()->type());
+    for (const auto& value :
+         internal::checked_cast<const BoundSetPredicate&>(expr).literal_set()) {
+      ICEBERG_ASSIGN_OR_RAISE(auto bytes, Conversions::ToBytes(type, value));
+      if (filter.MightContain(AsStringView(bytes))) {
+        return true;
+      }
+    }
+    return false;
+  }
+  return true;
+}
+
+bool SupportsIndex(TypeId type_id) {
+  switch (type_id) {
+    case TypeId::kInt:
+    case TypeId::kDate:
+    case TypeId::kLong:
+    case TypeId::kTime:
+    case TypeId::kTimestamp:
+    case TypeId::kTimestampTz:
+    case TypeId::kString:
+    case TypeId::kBinary:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// \brief Adds the non-null values of the only column of the rows of a data file.
+Status AddColumnValues(ArrowArrayStream& stream, TypeId type_id,
+                       const std::string& file_path, BloomFilter& filter) {
+  ArrowSchema schema;
+  if (int code = stream.get_schema(&stream, &schema); code != 0) {
+    return IOError("Cannot read the schema of {}: {}", file_path, std::strerror(code));
+  }
+  std::unique_ptr<ArrowArrayStructLike> rows;
+  Status status;
+  while (status.has_value()) {
+    ArrowArray array;
+    if (int code = stream.get_next(&stream, &array); code != 0) {
+      const char* message = stream.get_last_error(&stream);
+      status = IOError("Cannot read the rows of {}: {}", file_path,
+                       message != nullptr ? message : std::strerror(code));
+      break;
+    }
+    if (array.release == nullptr) {
+      break;
+    }
+    status = [&]() -> Status {
+      if (rows == nullptr) {
+        ICEBERG_ASSIGN_OR_RAISE(rows, ArrowArrayStructLike::Make(schema, array));
+      } else {
+        ICEBERG_RETURN_UNEXPECTED(rows->Reset(array));
+      }
+      switch (type_id) {
+        case TypeId::kInt:
+        case TypeId::kDate: {
+          ICEBERG_ASSIGN_OR_RAISE(auto column, rows->GetInt32Column(0));
+          for (int64_t i = 0; i < column.size(); ++i) {
+            if (column.IsValid(i)) {
+              // The single-value serialization of numbers is little-endian.
+              const int32_t value = ToLittleEndian(column.values[i]);
+              filter.Add({reinterpret_cast<const char*>(&value), sizeof(value)});
+            }
+          }
+          return {};
+        }
+        case TypeId::kString:
+        case TypeId::kBinary: {
+          ICEBERG_ASSIGN_OR_RAISE(auto column, rows->GetBinaryColumn(0));
+          for (int64_t i = 0; i < column.size(); ++i) {
+            if (column.IsValid(i)) {
+              filter.Add(column.Value(i));
+            }
+          }
+          return {};
+        }
+        default: {
+          ICEBERG_ASSIGN_OR_RAISE(auto column, rows->GetInt64Column(0));
+          for (int64_t i = 0; i < column.size(); ++i) {
+            if (column.IsValid(i)) {
+              const int64_t value = ToLittleEndian(column.values[i]);
+              filter.Add({reinterpret_cast<const char*>(&value), sizeof(value)});
+            }
+          }
+          return {};
+        }
+      }
+    }();
+    array.release(&array);
+  }
+  rows.reset();
+  schema.release(&schema);
+  return status;
+}
+
+}  // namespace
+
+Result<bool> BloomFilterIndexEvaluator::Evaluate(const DataFile& data_file) const {
+  const auto* filter = index_->FilterFor(data_file.file_path);
+  if (filter == nullptr) {
+    return true;
+  }
+  return MightMatch(*expr_, index_->field_id(), *filter);
+}
+
+Result<BloomFilterIndex> ComputeBloomFilterIndex(
+    std::span<const std::shared_ptr<FileScanTask>> tasks,
+    const std::shared_ptr<FileIO>& io, const Schema& schema, int32_t field_id,
+    double false_positive_probability) {
+  auto field = std::ranges::find_if(schema.fields(), [field_id](const auto& field) {
+    return field.field_id() == field_id;
+  });
+  if (field == schema.fields().end() || !SupportsIndex(field->type()->type_id())) {
+    return InvalidArgument(
+        "Cannot index field {}, which is not a top-level int, long, date, time, "
+        "timestamp, string or binary column",
+        field_id);
+  }
+  const TypeId type_id = field->type()->type_id();
+  ICEBERG_ASSIGN_OR_RAISE(std::shared_ptr<Schema> projected_schema,
+                          schema.Project(std::unordered_set<int32_t>{field_id}));
+
+  BloomFilterIndex index(field_id);
+  for (const auto& task : tasks) {
+    const auto& data_file = task->data_file();
+    if (index.FilterFor(data_file->file_path) != nullptr) {
+      continue;
+    }
+    auto filter = BloomFilter::Make(data_file->record_count, false_positive_probability);
+    // Deleted rows are indexed too, so that the index of a snapshot does not depend on
+    // its delete files.
+    FileScanTask file_task(data_file, /*delete_files=*/{});
+    ICEBERG_ASSIGN_OR_RAISE(auto stream,
+                            file_task.ToArrow(io, projected_schema, /*filter=*/nullptr));
+    auto status = AddColumnValues(stream, type_id, data_file->file_path, filter);
+    stream.release(&stream);
+    ICEBERG_RETURN_UNEXPECTED(status);
+    index.Add(data_file->file_path, std::move(filter));
+  }
+  return index;
+}
+
+Result<StatisticsFile> WriteBloomFilterIndex(const BloomFilterIndex& index,
+                                             std::unique_ptr<OutputFile> file,
+                                             int64_t snapshot_id,
+                                             int64_t sequence_number) {
+  if (file == nullptr) {
+    return InvalidArgument("Cannot write a bloom filter index to a null file");
+  }
+  StatisticsFile statistics_file{.snapshot_id = snapshot_id,
+                                 .path = file->location(),
+                                 .file_size_in_bytes = 0,
+                                 .file_footer_size_in_bytes = 0,
+                                 .blob_metadata = {}};
+  ICEBERG_ASSIGN_OR_RAISE(auto writer, PuffinWriter::Make(std::move(file)));
+  const std::string data = index.Serialize();
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto blob, writer->Add(PuffinBlob{.type = std::string(kBloomFilterIndexBlobType),
+                                        .fields = {index.field_id()},
+                                        .snapshot_id = snapshot_id,
+                                        .sequence_number = sequence_number,
+                                        .data = data}));
+  statistics_file.blob_metadata.push_back(
+      BlobMetadata{.type = std::move(blob.type),
+                   .source_snapshot_id = blob.snapshot_id,
+                   .source_snapshot_sequence_number = blob.sequence_number,
+                   .fields = std::move(blob.fields),
+                   .properties = std::move(blob.properties)});
+  ICEBERG_RETURN_UNEXPECTED(writer->Close());
+  statistics_file.file_size_in_bytes = writer->file_size();
+  statistics_file.file_footer_size_in_bytes = writer->footer_size();
+  return statistics_file;
+}
+
+const StatisticsFile* FindBloomFilterIndexFile(const TableMetadata& metadata,
+                                               int64_t snapshot_id, int32_t field_id) {
+  for (const auto& statistics_file : metadata.statistics) {
+    if (statistics_file == nullptr || statistics_file->snapshot_id != snapshot_id) {
+      continue;
+    }
+    for (const auto& blob : statistics_file->blob_metadata) {
+      if (blob.type == kBloomFilterIndexBlobType && blob.fields.size() == 1 &&
+          blob.fields[0] == field_id) {
+        return statistics_file.get();
+      }
+    }
+  }
+  return nullptr;
+}
+
+Result<BloomFilterIndex> ReadBloomFilterIndex(FileIO& io,
+                                              const StatisticsFile& statistics_file,
+                                              int32_t field_id) {
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto file,
+      io.NewInputFile(statistics_file.path,
+                      static_cast<size_t>(statistics_file.file_size_in_bytes)));
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto reader,
+      PuffinReader::Open(std::move(file), statistics_file.file_footer_size_in_bytes));
+  auto blob = std::ranges::find_if(
+      reader->metadata().blobs, [field_id](const PuffinBlobMetadata& blob) {
+        return blob.type == kBloomFilterIndexBlobType && blob.fields.size() == 1 &&
+               blob.fields[0] == field_id;
+      });
+  if (blob == reader->metadata().blobs.end()) {
+    return NotFound("No bloom filter index of field {} in {}", field_id,
+                    statistics_file.path);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto data, reader->ReadBlobs(std::span(&*blob, 1)));
+  ICEBERG_ASSIGN_OR_RAISE(auto index, BloomFilterIndex::Deserialize(field_id, data[0]));
+  ICEBERG_RETURN_UNEXPECTED(reader->Close());
+  return index;
+}
+
+}  // namespace iceberg
@@ -0,0 +1,179 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/puffin/bloom_filter_index.h
+/// Bloom filters of the values of a key column per data file, stored in the statistics
+/// files of snapshots, to plan point lookups on the column.
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/statistics_file.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief The type of the blobs of bloom filter indexes.
+constexpr std::string_view kBloomFilterIndexBlobType = "iceberg-bloom-filter-index-v1";
+
+/// \brief A bloom filter of values in their single-value serialization.
+///
+/// Values are hashed with the 128-bit MurmurHash3, whose two halves derive the bits of
+/// the value by double hashing.
+class ICEBERG_EXPORT BloomFilter {
+ public:
+  /// \brief Makes an empty filter sized for a number of distinct values.
+  ///
+  /// \param num_values The expected number of distinct values
+  /// \param false_positive_probability The probability that MightContain() is true for
+  /// a value that was not added, once the expected number of values are added
+  static BloomFilter Make(int64_t num_values, double false_positive_probability = 0.01);
+
+  /// \brief Adds a value, in its single-value serialization.
+  void Add(std::string_view value);
+
+  /// \brief Returns false if the value was not added, and true if it may have been.
+  bool MightContain(std::string_view value) const;
+
+  /// \brief Returns the number of bits of the filter.
+  int64_t num_bits() const { return static_cast<int64_t>(words_.size()) * 64; }
+
+  /// \brief Returns the number of bits set for each value.
+  int32_t num_hashes() const { return num_hashes_; }
+
+  /// \brief Serializes the filter.
+  std::string Serialize() const;
+
+  /// \brief Deserializes a filter written by Serialize().
+  static Result<BloomFilter> Deserialize(std::string_view data);
+
+ private:
+  BloomFilter(int32_t num_hashes, std::vector<uint64_t> words);
+
+  int32_t num_hashes_;
+  std::vector<uint64_t> words_;
+};
+
+/// \brief The bloom filters of the values of a key column, one per data file.
+///
+/// Point lookups on a column whose lower and upper bounds overlap in most data files,
+/// such as a hashed or random key, cannot skip files with the column metrics. The
+/// filters of the index rule out the files that do not contain the looked up keys.
+class ICEBERG_EXPORT BloomFilterIndex {
+ public:
+  /// \brief Makes an empty index of a column.
+  explicit BloomFilterIndex(int32_t field_id);
+
+  /// \brief The id of the indexed column.
+  int32_t field_id() const { return field_id_; }
+
+  /// \brief Sets the filter of the values of the column in a data file.
+  void Add(std::string file_path, BloomFilter filter);
+
+  /// \brief Returns the filter of a data file, or null if the file is not indexed.
+  const BloomFilter* FilterFor(std::string_view file_path) const;
+
+  /// \brief Returns the number of indexed data files.
+  size_t size() const { return filters_.size(); }
+
+  /// \brief Serializes the filters of the index, the payload of its blob.
+  std::string Serialize() const;
+
+  /// \brief Deserializes the filters of an index written by Serialize().
+  static Result<BloomFilterIndex> Deserialize(int32_t field_id, std::string_view data);
+
+ private:
+  int32_t field_id_;
+  std::map<std::string, BloomFilter, std::less<>> filters_;
+};
+
+/// \brief Evaluates whether a data file may contain rows matching a filter, using the
+/// bloom filter of the file in an index.
+///
+/// Only equality and IN predicates on the indexed column can rule out a file. Files
+/// that are not in the index may match, so that an index computed for an older
+/// snapshot still prunes the files that it covers.
+class ICEBERG_EXPORT BloomFilterIndexEvaluator {
+ public:
+  /// \brief Makes an evaluator of a filter, which is bound to the schema if unbound.
+  static Result<std::unique_ptr<BloomFilterIndexEvaluator>> Make(
+      std::shared_ptr<const BloomFilterIndex> index,
+      const std::shared_ptr<Expression>& expr, const Schema& schema,
+      bool case_sensitive);
+
+  /// \brief Returns false if the data file cannot contain rows matching the filter.
+  Result<bool> Evaluate(const DataFile& data_file) const;
+
+ private:
+  BloomFilterIndexEvaluator(std::shared_ptr<const BloomFilterIndex> index,
+                            std::shared_ptr<Expression> expr);
+
+  std::shared_ptr<const BloomFilterIndex> index_;
+  std::shared_ptr<Expression> expr_;
+};
+
+/// \brief Computes the bloom filter index of a key column by scanning the data files
+/// of a snapshot.
+///
+/// The filter of each file is sized for its record count, and null values are not
+/// added.
+/// \param tasks The scan tasks of whole data files, such as the planned files of a
+/// snapshot
+/// \param io The FileIO to read the files
+/// \param schema The schema of the table
+/// \param field_id The id of the key column, a top-level int, long, date, time,
+/// timestamp, string or binary column
+/// \param false_positive_probability The false positive probability of the filters
+ICEBERG_EXPORT Result<BloomFilterIndex> ComputeBloomFilterIndex(
+    std::span<const std::shared_ptr<FileScanTask>> tasks,
+    const std::shared_ptr<FileIO>& io, const Schema& schema, int32_t field_id,
+    double false_positive_probability = 0.01);
+
+/// \brief Writes an index as a blob of a Puffin file.
+///
+/// \param index The index to write
+/// \param file The Puffin file
+/// \param snapshot_id The snapshot the index was computed from
+/// \param sequence_number The sequence number of the snapshot
+/// \return The statistics file to register in the table metadata with
+/// `TableMetadataBuilder::SetStatistics`.
+ICEBERG_EXPORT Result<StatisticsFile> WriteBloomFilterIndex(
+    const BloomFilterIndex& index, std::unique_ptr<OutputFile> file, int64_t snapshot_id,
+    int64_t sequence_number);
+
+/// \brief Returns the statistics file of a snapshot with a bloom filter index of a
+/// column, or null if there is none.
+ICEBERG_EXPORT const StatisticsFile* FindBloomFilterIndexFile(
+    const TableMetadata& metadata, int64_t snapshot_id, int32_t field_id);
+
+/// \brief Reads the bloom filter index of a column from a statistics file.
+ICEBERG_EXPORT Result<BloomFilterIndex> ReadBloomFilterIndex(
+    FileIO& io, const StatisticsFile& statistics_file, int32_t field_id);
+
+}  // namespace iceberg
@@ -0,0 +1,438 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/puffin/ndv_statistics.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+#include "iceberg/executor.h"
+#include "iceberg/expression/literal.h"
+#include "iceberg/file_io.h"
+#include "iceberg/puffin/puffin_format.h"
+#include "iceberg/puffin/puffin_reader.h"
+#include "iceberg/puffin/puffin_writer.h"
+#include "iceberg/schema.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/table_scan.h"
+#include "iceberg/type.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/conversions.h"
+#include "iceberg/util/endian.h"
+#include "iceberg/util/int128.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+bool GetBit(const uint8_t* bitmap, int64_t index) {
+  return (bitmap[index >> 3] >> (index & 7)) & 1;
+}
+
+bool SupportsSketch(TypeId type_id) {
+  switch (type_id) {
+    case TypeId::kBoolean:
+    case TypeId::kInt:
+    case TypeId::kLong:
+    case TypeId::kFloat:
+    case TypeId::kDouble:
+    case TypeId::kDecimal:
+    case TypeId::kDate:
+    case TypeId::kTime:
+    case TypeId::kTimestamp:
+    case TypeId::kTimestampTz:
+    case TypeId::kString:
+    case TypeId::kUuid:
+    case TypeId::kFixed:
+    case TypeId::kBinary:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// \brief A level of the arrays from the root struct to a column.
+struct Level {
+  const ArrowArray* array;
+  /// \brief The position of the first row in the buffers of the array.
+  int64_t start;
+};
+
+template <typename T>
+std::string_view FixedWidthValue(const void* buffer, int64_t index, T& scratch) {
+  std::memcpy(&scratch, static_cast<const T*>(buffer) + index, sizeof(T));
+  // The single-value serialization of numbers is little-endian.
+  scratch = ToLittleEndian(scratch);
+  return {reinterpret_cast<const char*>(&scratch), sizeof(T)};
+}
+
+}  // namespace
+
+NdvSketchCollector::NdvSketchCollector(std::vector<Column> columns)
+    : columns_(std::move(columns)), sketches_(columns_.size()) {}
+
+Result<NdvSketchCollector> NdvSketchCollector::Make(const Schema& schema,
+                                                    std::span<const int32_t> field_ids) {
+  const std::unordered_set<int32_t> selected(field_ids.begin(), field_ids.end());
+  std::vector<Column> columns;
+  std::vector<int32_t> path;
+  // Primitive columns are reached through structs only, as the values of lists and
+  // maps are not the values of a column.
+  auto visit = [&](auto&& self, std::span<const SchemaField> fields) -> void {
+    for (size_t i = 0; i < fields.size(); ++i) {
+      const auto& field = fields[i];
+      path.push_back(static_cast<int32_t>(i));
+      if (field.type()->type_id() == TypeId::kStruct) {
+        self(self, internal::checked_cast<const StructType&>(*field.type()).fields());
+      } else if (SupportsSketch(field.type()->type_id()) &&
+                 (selected.empty() || selected.contains(field.field_id()))) {
+        Column column{.field_id = field.field_id(),
+                      .type_id = field.type()->type_id(),
+                      .path = path};
+        if (column.type_id == TypeId::kFixed) {
+          column.byte_width =
+              internal::checked_cast<const FixedType&>(*field.type()).length();
+        } else if (column.type_id == TypeId::kUuid) {
+          column.byte_width = 16;
+        } else if (column.type_id == TypeId::kDecimal) {
+          const auto& decimal = internal::checked_cast<const DecimalType&>(*field.type());
+          column.precision = decimal.precision();
+          column.scale = decimal.scale();
+        }
+        columns.push_back(std::move(column));
+      }
+      path.pop_back();
+    }
+  };
+  visit(visit, schema.fields());
+
+  if (!selected.empty() && columns.size() != selected.size()) {
+    for (int32_t field_id : selected) {
+      if (std::ranges::none_of(columns, [field_id](const Column& column) {
+            return column.field_id == field_id;
+          })) {
+        return InvalidArgument(
+            "Cannot collect the sketch of field {}, which is not a primitive column "
+            "outside of lists and maps",
+            field_id);
+      }
+    }
+  }
+  return NdvSketchCollector(std::move(columns));
+}
+
+std::vector<int32_t> NdvSketchCollector::field_ids() const {
+  std::vector<int32_t> field_ids;
+  field_ids.reserve(columns_.size());
+  for (const auto& column : columns_) {
+    field_ids.push_back(column.field_id);
+  }
+  return field_ids;
+}
+
+Status NdvSketchCollector::Update(const ArrowArray& array) {
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    ICEBERG_RETURN_UNEXPECTED(UpdateColumn(columns_[i], array, sketches_[i]));
+  }
+  return {};
+}
+
+Status NdvSketchCollector::UpdateColumn(const Column& column, const ArrowArray& array,
+                                        ThetaSketch& sketch) const {
+  // The rows of a struct are the rows of its children, shifted by the offset of the
+  // struct, so the positions of a row in the buffers add up the offsets of the levels.
+  std::vector<Level> levels{{.array = &array, .start = array.offset}};
+  for (int32_t index : column.path) {
+    const auto* parent = levels.back().array;
+    if (index >= parent->n_children) {
+      return InvalidArrowData("Arrow struct array has {} children, expected at least {}",
+                              parent->n_children, index + 1);
+    }
+    const auto* child = parent->children[index];
+    levels.push_back({.array = child, .start = levels.back().start + child->offset});
+  }
+  const auto& values = *levels.back().array;
+  const int64_t start = levels.back().start;
+  const int64_t expected_buffers =
+      column.type_id == TypeId::kString || column.type_id == TypeId::kBinary ? 3 : 2;
+  if (values.n_buffers != expected_buffers) {
+    return InvalidArrowData("Arrow array of type {} has {} buffers, expected {}",
+                            ToString(column.type_id), values.n_buffers,
+                            expected_buffers);
+  }
+
+  auto is_valid = [&](int64_t row) {
+    for (const auto& level : levels) {
+      if (level.array->null_count != 0 && level.array->n_buffers > 0 &&
+          level.array->buffers[0] != nullptr &&
+          !GetBit(static_cast<const uint8_t*>(level.array->buffers[0]),
+                  level.start + row)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  const void* buffer = values.buffers[1];
+  int32_t int_scratch;
+  int64_t long_scratch;
+  float float_scratch;
+  double double_scratch;
+  for (int64_t row = 0; row < array.length; ++row) {
+    if (!is_valid(row)) {
+      continue;
+    }
+    const int64_t index = start + row;
+    switch (column.type_id) {
+      case TypeId::kBoolean: {
+        const char value = GetBit(static_cast<const uint8_t*>(buffer), index) ? 1 : 0;
+        sketch.Update({&value, 1});
+        break;
+      }
+      case TypeId::kInt:
+      case TypeId::kDate:
+        sketch.Update(FixedWidthValue(buffer, index, int_scratch));
+        break;
+      case TypeId::kLong:
+      case TypeId::kTime:
+      case TypeId::kTimestamp:
+      case TypeId::kTimestampTz:
+        sketch.Update(FixedWidthValue(buffer, index, long_scratch));
+        break;
+      case TypeId::kFloat:
+        sketch.Update(FixedWidthValue(buffer, index, float_scratch));
+        break;
+      case TypeId::kDouble:
+        sketch.Update(FixedWidthValue(buffer, index, double_scratch));
+        break;
+      case TypeId::kDecimal: {
+        // Arrow decimals are little-endian 128-bit integers, and their single-value
+        // serialization is the minimal big-endian two's complement of the value.
+        int128_t value;
+        std::memcpy(&value, static_cast<const uint8_t*>(buffer) + index * sizeof(value),
+                    sizeof(value));
+        ICEBERG_ASSIGN_OR_RAISE(auto bytes,
+                                Conversions::ToBytes(Literal::Decimal(
+                                    value, column.precision, column.scale)));
+        sketch.Update({reinterpret_cast<const char*>(bytes.data()), bytes.size()});
+        break;
+      }
+      case TypeId::kString:
+      case TypeId::kBinary: {
+        const auto* offsets = static_cast<const int32_t*>(buffer);
+        const auto* data = static_cast<const char*>(values.buffers[2]);
+        sketch.Update({data + offsets[index],
+                       static_cast<size_t>(offsets[index + 1] - offsets[index])});
+        break;
+      }
+      case TypeId::kFixed:
+      case TypeId::kUuid: {
+        const auto* data = static_cast<const char*>(buffer);
+        sketch.Update({data + index * column.byte_width,
+                       static_cast<size_t>(column.byte_width)});
+        break;
+      }
+      default:
+        std::unreachable();
+    }
+  }
+  return {};
+}
+
+Status NdvSketchCollector::Merge(const NdvSketchCollector& other) {
+  if (field_ids() != other.field_ids()) {
+    return InvalidArgument("Cannot merge the sketches of other columns");
+  }
+  for (size_t i = 0; i < sketches_.size(); ++i) {
+    sketches_[i].Merge(other.sketches_[i]);
+  }
+  return {};
+}
+
+namespace {
+
+/// \brief Scans a task and updates the sketches with its rows.
+Status UpdateFromTask(const FileScanTask& task, const std::shared_ptr<FileIO>& io,
+                const std::shared_ptr<Schema>& projected_schema,
+                NdvSketchCollector& collector) {
+  ICEBERG_ASSIGN_OR_RAISE(auto stream, task.ToArrow(io, projected_schema, nullptr));
+  Status status;
+  while (status.has_value()) {
+    ArrowArray array;
+    if (int code = stream.get_next(&stream, &array); code != 0) {
+      const char* message = stream.get_last_error(&stream);
+      status = IOError("Cannot read the rows of {}: {}", task.data_file()->file_path,
+                       message != nullptr ? message : std::strerror(code));
+      break;
+    }
+    if (array.release == nullptr) {
+      break;
+    }
+    status = collector.Update(array);
+    array.release(&array);
+  }
+  stream.release(&stream);
+  return status;
+}
+
+}  // namespace
+
+Result<NdvSketchCollector> ComputeNdvSketches(
+    std::span<const std::shared_ptr<FileScanTask>> tasks,
+    const std::shared_ptr<FileIO>& io, const Schema& schema,
+    std::span<const int32_t> field_ids, int32_t parallelism,
+    std::shared_ptr<Executor> executor) {
+  if (parallelism < 1) {
+    return InvalidArgument("Parallelism must be positive, got {}", parallelism);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto collector, NdvSketchCollector::Make(schema, field_ids));
+  // Only the columns of the sketches are read.
+  const auto ids = collector.field_ids();
+  ICEBERG_ASSIGN_OR_RAISE(
+      std::shared_ptr<Schema> projected_schema,
+      schema.Project(std::unordered_set<int32_t>(ids.begin(), ids.end())));
+  ICEBERG_ASSIGN_OR_RAISE(collector, NdvSketchCollector::Make(*projected_schema, ids));
+
+  const auto num_workers = std::min(tasks.size(), static_cast<size_t>(parallelism));
+  std::vector<NdvSketchCollector> collectors(num_workers, collector);
+  // Each worker scans the tasks it claims with its own sketches, and no task is claimed
+  // after a failure.
+  std::atomic<size_t> next_task = 0;
+  auto scan = [&](size_t worker) -> Status {
+    for (size_t i = next_task++; i < tasks.size(); i = next_task++) {
+      auto status = UpdateFromTask(*tasks[i], io, projected_schema, collectors[worker]);
+      if (!status.has_value()) {
+        next_task = tasks.size();
+        return status;
+      }
+    }
+    return {};
+  };
+  ICEBERG_RETURN_UNEXPECTED(
+      RunInParallel(executor != nullptr ? *executor : *DefaultExecutor(), num_workers,
+                    static_cast<int32_t>(num_workers), scan));
+
+  for (const auto& worker_collector : collectors) {
+    ICEBERG_RETURN_UNEXPECTED(collector.Merge(worker_collector));
+  }
+  return collector;
+}
+
+Result<StatisticsFile> WriteNdvStatistics(const NdvSketchCollector& sketches,
+                                          std::unique_ptr<OutputFile> file,
+                                          int64_t snapshot_id, int64_t sequence_number) {
+  if (file == nullptr) {
+    return InvalidArgument("Cannot write statistics to a null file");
+  }
+  StatisticsFile statistics_file{.snapshot_id = snapshot_id,
+                                 .path = file->location(),
+                                 .file_size_in_bytes = 0,
+                                 .file_footer_size_in_bytes = 0,
+                                 .blob_metadata = {}};
+  ICEBERG_ASSIGN_OR_RAISE(auto writer, PuffinWriter::Make(std::move(file)));
+  const auto field_ids = sketches.field_ids();
+  for (size_t i = 0; i < field_ids.size(); ++i) {
+    const auto& sketch = sketches.sketches()[i];
+    const std::string data = sketch.Serialize();
+    const auto ndv = static_cast<int64_t>(std::llround(sketch.Estimate()));
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto blob,
+        writer->Add(PuffinBlob{
+            .type = std::string(PuffinConstants::kApacheDataSketchesThetaV1),
+            .fields = {field_ids[i]},
+            .snapshot_id = snapshot_id,
+            .sequence_number = sequence_number,
+            .data = data,
+            .properties = {{std::string(kNdvBlobProperty), std::to_string(ndv)}}}));
+    statistics_file.blob_metadata.push_back(
+        BlobMetadata{.type = std::move(blob.type),
+                     .source_snapshot_id = blob.snapshot_id,
+                     .source_snapshot_sequence_number = blob.sequence_number,
+                     .fields = std::move(blob.fields),
+                     .properties = std::move(blob.properties)});
+  }
+  ICEBERG_RETURN_UNEXPECTED(writer->Close());
+  statistics_file.file_size_in_bytes = writer->file_size();
+  statistics_file.file_footer_size_in_bytes = writer->footer_size();
+  return statistics_file;
+}
+
+std::unordered_map<int32_t, int64_t> NdvEstimates(const TableMetadata& metadata,
+                                                  int64_t snapshot_id) {
+  std::unordered_map<int32_t, int64_t> estimates;
+  for (const auto& statistics_file : metadata.statistics) {
+    if (statistics_file == nullptr || statistics_file->snapshot_id != snapshot_id) {
+      continue;
+    }
+    for (const auto& blob : statistics_file->blob_metadata) {
+      if (blob.type != PuffinConstants::kApacheDataSketchesThetaV1 ||
+          blob.fields.size() != 1) {
+        continue;
+      }
+      auto it = blob.properties.find(std::string(kNdvBlobProperty));
+      if (it == blob.properties.end()) {
+        continue;
+      }
+      int64_t ndv;
+      const auto& value = it->second;
+      const char* end = value.data() + value.size();
+      if (auto [ptr, ec] = std::from_chars(value.data(), end, ndv);
+          ec == std::errc() && ptr == end) {
+        estimates.emplace(blob.fields[0], ndv);
+      }
+    }
+  }
+  return estimates;
+}
+
+Result<std::unordered_map<int32_t, ThetaSketch>> ReadNdvSketches(
+    FileIO& io, const StatisticsFile& statistics_file) {
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto file,
+      io.NewInputFile(statistics_file.path,
+                      static_cast<size_t>(statistics_file.file_size_in_bytes)));
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto reader,
+      PuffinReader::Open(std::move(file), statistics_file.file_footer_size_in_bytes));
+  std::vector<PuffinBlobMetadata> blobs;
+  for (const auto& blob : reader->metadata().blobs) {
+    if (blob.type == PuffinConstants::kApacheDataSketchesThetaV1 &&
+        blob.fields.size() == 1) {
+      blobs.push_back(blob);
+    }
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto data, reader->ReadBlobs(blobs));
+  std::unordered_map<int32_t, ThetaSketch> sketches;
+  for (size_t i = 0; i < blobs.size(); ++i) {
+    ICEBERG_ASSIGN_OR_RAISE(auto sketch, ThetaSketch::Deserialize(data[i]));
+    sketches.insert_or_assign(blobs[i].fields[0], std::move(sketch));
+  }
+  ICEBERG_RETURN_UNEXPECTED(reader->Close());
+  return sketches;
+}
+
+}  // namespace iceberg
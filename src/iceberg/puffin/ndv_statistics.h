@@ -0,0 +1,139 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/puffin/ndv_statistics.h
+/// Collection and lookup of the distinct value counts of columns, stored as theta
+/// sketches in the statistics files of snapshots.
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "iceberg/arrow_c_data.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/puffin/theta_sketch.h"
+#include "iceberg/result.h"
+#include "iceberg/statistics_file.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief The blob property of the estimated number of distinct values of a sketch.
+constexpr std::string_view kNdvBlobProperty = "ndv";
+
+/// \brief Collects a theta sketch for each primitive column of the Arrow arrays of a
+/// schema, e.g. while the arrays are written or scanned.
+///
+/// Values are hashed in their single-value serialization, so that the sketches are
+/// compatible with the sketches of other implementations. Null values are not counted.
+class ICEBERG_EXPORT NdvSketchCollector {
+ public:
+  /// \brief Makes a collector for columns of a schema.
+  ///
+  /// \param schema The schema of the arrays
+  /// \param field_ids The ids of the columns, or empty for all the primitive columns
+  /// that are not in lists or maps
+  /// \return The collector, or an error if a column is not such a primitive column.
+  static Result<NdvSketchCollector> Make(const Schema& schema,
+                                         std::span<const int32_t> field_ids = {});
+
+  /// \brief Updates the sketches with the rows of an array, which keeps its ownership.
+  ///
+  /// \param array A struct array of the schema, in the layout of `ToArrowSchema`
+  Status Update(const ArrowArray& array);
+
+  /// \brief Merges the sketches of a collector of the same columns, e.g. of another
+  /// thread.
+  Status Merge(const NdvSketchCollector& other);
+
+  /// \brief The ids of the columns, in the order of their sketches.
+  std::vector<int32_t> field_ids() const;
+
+  /// \brief The sketches of the columns.
+  const std::vector<ThetaSketch>& sketches() const { return sketches_; }
+
+ private:
+  struct Column {
+    int32_t field_id;
+    TypeId type_id;
+    int32_t byte_width = 0;
+    int32_t precision = 0;
+    int32_t scale = 0;
+    /// \brief The indices of the children from the root struct to the column.
+    std::vector<int32_t> path;
+  };
+
+  explicit NdvSketchCollector(std::vector<Column> columns);
+
+  Status UpdateColumn(const Column& column, const ArrowArray& array,
+                      ThetaSketch& sketch) const;
+
+  std::vector<Column> columns_;
+  std::vector<ThetaSketch> sketches_;
+};
+
+/// \brief Computes the sketches of columns by scanning the tasks of a snapshot.
+///
+/// \param tasks The scan tasks, such as the planned files of a snapshot
+/// \param io The FileIO to read the files
+/// \param schema The schema of the table
+/// \param field_ids The ids of the columns, or empty for all the primitive columns
+/// \param parallelism The number of tasks scanned concurrently, each with sketches of
+/// its own that are merged once all the tasks are scanned
+/// \param executor The executor scanning the tasks concurrently, the DefaultExecutor()
+/// if null
+ICEBERG_EXPORT Result<NdvSketchCollector> ComputeNdvSketches(
+    std::span<const std::shared_ptr<FileScanTask>> tasks,
+    const std::shared_ptr<FileIO>& io, const Schema& schema,
+    std::span<const int32_t> field_ids = {}, int32_t parallelism = 1,
+    std::shared_ptr<Executor> executor = nullptr);
+
+/// \brief Writes the sketches of a collector as `apache-datasketches-theta-v1` blobs of
+/// a Puffin file.
+///
+/// \param sketches The sketches to write
+/// \param file The Puffin file
+/// \param snapshot_id The snapshot the sketches were computed from
+/// \param sequence_number The sequence number of the snapshot
+/// \return The statistics file to register in the table metadata with
+/// `TableMetadataBuilder::SetStatistics`.
+ICEBERG_EXPORT Result<StatisticsFile> WriteNdvStatistics(
+    const NdvSketchCollector& sketches, std::unique_ptr<OutputFile> file,
+    int64_t snapshot_id, int64_t sequence_number);
+
+/// \brief Returns the estimated numbers of distinct values of the columns of a
+/// snapshot, keyed by field id.
+///
+/// The estimates are read from the blob metadata of the statistics file of the
+/// snapshot in the table metadata, without reading the file. Columns without sketches
+/// are absent.
+ICEBERG_EXPORT std::unordered_map<int32_t, int64_t> NdvEstimates(
+    const TableMetadata& metadata, int64_t snapshot_id);
+
+/// \brief Reads the sketches of a statistics file, keyed by field id, e.g. to merge
+/// them with the sketches of new data.
+ICEBERG_EXPORT Result<std::unordered_map<int32_t, ThetaSketch>> ReadNdvSketches(
+    FileIO& io, const StatisticsFile& statistics_file);
+
+}  // namespace iceberg
@@ -0,0 +1,156 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/puffin/puffin_format.h"
+
+#include <exception>
+#include <unordered_map>
+#include <utility>
+
+#include <nlohmann/json.hpp>
+
+#include "iceberg/puffin/puffin_format_internal.h"
+#include "iceberg/util/json_util_internal.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+constexpr std::string_view kBlobs = "blobs";
+constexpr std::string_view kProperties = "properties";
+constexpr std::string_view kType = "type";
+constexpr std::string_view kFields = "fields";
+constexpr std::string_view kSnapshotId = "snapshot-id";
+constexpr std::string_view kSequenceNumber = "sequence-number";
+constexpr std::string_view kOffset = "offset";
+constexpr std::string_view kLength = "length";
+constexpr std::string_view kCompressionCodec = "compression-codec";
+
+PuffinCodecFunction NotSupportedFunction(PuffinCompressionCodec codec) {
+  return [codec](std::string_view) -> Result<std::string> {
+    return NotSupported("Puffin compression codec {} is not registered", ToString(codec));
+  };
+}
+
+PuffinCodecFunction Identity() {
+  return [](std::string_view data) -> Result<std::string> { return std::string(data); };
+}
+
+nlohmann::json ToJson(const PuffinBlobMetadata& blob) {
+  nlohmann::json json;
+  json[kType] = blob.type;
+  json[kFields] = blob.fields;
+  json[kSnapshotId] = blob.snapshot_id;
+  json[kSequenceNumber] = blob.sequence_number;
+  json[kOffset] = blob.offset;
+  json[kLength] = blob.length;
+  if (blob.compression_codec != PuffinCompressionCodec::kNone) {
+    json[kCompressionCodec] = ToString(blob.compression_codec);
+  }
+  if (!blob.properties.empty()) {
+    json[kProperties] = blob.properties;
+  }
+  return json;
+}
+
+Result<PuffinBlobMetadata> BlobMetadataFromJson(const nlohmann::json& json) {
+  PuffinBlobMetadata blob;
+  ICEBERG_ASSIGN_OR_RAISE(blob.type, GetJsonValue<std::string>(json, kType));
+  ICEBERG_ASSIGN_OR_RAISE(blob.fields, GetJsonValue<std::vector<int32_t>>(json, kFields));
+  ICEBERG_ASSIGN_OR_RAISE(blob.snapshot_id, GetJsonValue<int64_t>(json, kSnapshotId));
+  ICEBERG_ASSIGN_OR_RAISE(blob.sequence_number,
+                          GetJsonValue<int64_t>(json, kSequenceNumber));
+  ICEBERG_ASSIGN_OR_RAISE(blob.offset, GetJsonValue<int64_t>(json, kOffset));
+  ICEBERG_ASSIGN_OR_RAISE(blob.length, GetJsonValue<int64_t>(json, kLength));
+  ICEBERG_ASSIGN_OR_RAISE(auto codec,
+                          GetJsonValueOptional<std::string>(json, kCompressionCodec));
+  if (codec.has_value()) {
+    ICEBERG_ASSIGN_OR_RAISE(blob.compression_codec,
+                            PuffinCompressionCodecFromString(codec.value()));
+  }
+  ICEBERG_ASSIGN_OR_RAISE(blob.properties, FromJsonMap(json, kProperties));
+  return blob;
+}
+
+}  // namespace
+
+std::string_view ToString(PuffinCompressionCodec codec) {
+  switch (codec) {
+    case PuffinCompressionCodec::kNone:
+      return "none";
+    case PuffinCompressionCodec::kLz4:
+      return "lz4";
+    case PuffinCompressionCodec::kZstd:
+      return "zstd";
+  }
+  std::unreachable();
+}
+
+Result<PuffinCompressionCodec> PuffinCompressionCodecFromString(std::string_view name) {
+  if (name == "lz4") return PuffinCompressionCodec::kLz4;
+  if (name == "zstd") return PuffinCompressionCodec::kZstd;
+  return NotSupported("Unsupported Puffin compression codec: {}", name);
+}
+
+PuffinCodecRegistry::PuffinCodecRegistry(PuffinCompressionCodec codec, PuffinCodec impl) {
+  GetCodec(codec) = std::move(impl);
+}
+
+PuffinCodec& PuffinCodecRegistry::GetCodec(PuffinCompressionCodec codec) {
+  static std::unordered_map<PuffinCompressionCodec, PuffinCodec> codecs = {
+      {PuffinCompressionCodec::kNone, {Identity(), Identity()}},
+      {PuffinCompressionCodec::kLz4,
+       {NotSupportedFunction(PuffinCompressionCodec::kLz4),
+        NotSupportedFunction(PuffinCompressionCodec::kLz4)}},
+      {PuffinCompressionCodec::kZstd,
+       {NotSupportedFunction(PuffinCompressionCodec::kZstd),
+        NotSupportedFunction(PuffinCompressionCodec::kZstd)}},
+  };
+  return codecs.at(codec);
+}
+
+std::string PuffinFileMetadataToJson(const PuffinFileMetadata& metadata) {
+  nlohmann::json json;
+  json[kBlobs] = nlohmann::json::array();
+  for (const auto& blob : metadata.blobs) {
+    json[kBlobs].push_back(ToJson(blob));
+  }
+  if (!metadata.properties.empty()) {
+    json[kProperties] = metadata.properties;
+  }
+  return json.dump();
+}
+
+Result<PuffinFileMetadata> PuffinFileMetadataFromJson(std::string_view payload) {
+  nlohmann::json json;
+  try {
+    json = nlohmann::json::parse(payload);
+  } catch (const std::exception& ex) {
+    return JsonParseError("Cannot parse the footer of the Puffin file: {}", ex.what());
+  }
+  PuffinFileMetadata metadata;
+  ICEBERG_ASSIGN_OR_RAISE(
+      metadata.blobs,
+      FromJsonList<PuffinBlobMetadata>(json, kBlobs, BlobMetadataFromJson));
+  ICEBERG_ASSIGN_OR_RAISE(metadata.properties, FromJsonMap(json, kProperties));
+  return metadata;
+}
+
+}  // namespace iceberg
@@ -0,0 +1,126 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/puffin/puffin_format.h
+/// Metadata of Puffin files, which store blobs such as statistics and deletion vectors.
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+
+namespace iceberg {
+
+/// \brief Compression codecs of the blobs of Puffin files.
+enum class PuffinCompressionCodec {
+  kNone,
+  /// \brief A single LZ4 frame.
+  kLz4,
+  /// \brief A single Zstandard frame.
+  kZstd,
+};
+
+/// \brief Returns the name of a codec in the Puffin footer, e.g. "zstd".
+ICEBERG_EXPORT std::string_view ToString(PuffinCompressionCodec codec);
+
+/// \brief Returns the codec of a name in the Puffin footer.
+ICEBERG_EXPORT Result<PuffinCompressionCodec> PuffinCompressionCodecFromString(
+    std::string_view name);
+
+/// \brief Well-known blob types and properties of Puffin files.
+struct ICEBERG_EXPORT PuffinConstants {
+  /// \brief A serialized form of a "compact" Theta sketch of the Apache DataSketches
+  /// library, estimating the number of distinct values of a field.
+  static constexpr std::string_view kApacheDataSketchesThetaV1 =
+      "apache-datasketches-theta-v1";
+  /// \brief A deletion vector of a data file.
+  static constexpr std::string_view kDeletionVectorV1 = "deletion-vector-v1";
+
+  /// \brief The application that wrote the file, a property of the file.
+  static constexpr std::string_view kCreatedBy = "created-by";
+  /// \brief The data file of a deletion vector, a property of its blob.
+  static constexpr std::string_view kReferencedDataFile = "referenced-data-file";
+  /// \brief The number of positions of a deletion vector, a property of its blob.
+  static constexpr std::string_view kCardinality = "cardinality";
+};
+
+/// \brief The metadata of a blob, as stored in the footer of a Puffin file.
+struct ICEBERG_EXPORT PuffinBlobMetadata {
+  /// \brief The type of the blob.
+  std::string type;
+  /// \brief The ids of the fields the blob was computed for.
+  std::vector<int32_t> fields;
+  /// \brief The id of the snapshot the blob was computed from, or -1.
+  int64_t snapshot_id = -1;
+  /// \brief The sequence number of the snapshot the blob was computed from, or -1.
+  int64_t sequence_number = -1;
+  /// \brief The offset of the blob in the file.
+  int64_t offset = 0;
+  /// \brief The length of the stored blob, after compression.
+  int64_t length = 0;
+  /// \brief The codec the blob is compressed with.
+  PuffinCompressionCodec compression_codec = PuffinCompressionCodec::kNone;
+  /// \brief Additional properties of the blob, specific to its type.
+  std::unordered_map<std::string, std::string> properties;
+
+  friend bool operator==(const PuffinBlobMetadata& lhs,
+                         const PuffinBlobMetadata& rhs) = default;
+};
+
+/// \brief The footer metadata of a Puffin file.
+struct ICEBERG_EXPORT PuffinFileMetadata {
+  /// \brief The blobs of the file, in the order of their offsets.
+  std::vector<PuffinBlobMetadata> blobs;
+  /// \brief Properties of the file.
+  std::unordered_map<std::string, std::string> properties;
+
+  friend bool operator==(const PuffinFileMetadata& lhs,
+                         const PuffinFileMetadata& rhs) = default;
+};
+
+/// \brief Compresses or decompresses the data of a blob.
+using PuffinCodecFunction = std::function<Result<std::string>(std::string_view)>;
+
+/// \brief The implementation of a compression codec.
+struct ICEBERG_EXPORT PuffinCodec {
+  PuffinCodecFunction compress;
+  PuffinCodecFunction decompress;
+};
+
+/// \brief Registry of the implementations of Puffin compression codecs.
+///
+/// The core library does not depend on compression libraries, so the LZ4 and Zstandard
+/// codecs fail with NotSupported until an implementation is registered, e.g. by
+/// `iceberg::arrow::RegisterPuffinCodecs()` of the bundle library.
+struct ICEBERG_EXPORT PuffinCodecRegistry {
+  /// \brief Register the implementation of a codec.
+  PuffinCodecRegistry(PuffinCompressionCodec codec, PuffinCodec impl);
+
+  /// \brief Get the implementation of a codec.
+  static PuffinCodec& GetCodec(PuffinCompressionCodec codec);
+};
+
+}  // namespace iceberg
@@ -0,0 +1,50 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/puffin/puffin_format_internal.h
+/// Layout of Puffin files shared by the reader and the writer.
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "iceberg/puffin/puffin_format.h"
+#include "iceberg/result.h"
+
+namespace iceberg {
+
+/// \brief The magic bytes at the start of a Puffin file, and around its footer payload.
+constexpr std::array<char, 4> kPuffinMagic = {'P', 'F', 'A', '1'};
+
+/// \brief The size of the end of the footer: the payload size, the flags and the magic.
+constexpr int64_t kPuffinFooterTailSize = 12;
+
+/// \brief The flag of a footer payload compressed with LZ4, in the first byte of flags.
+constexpr uint8_t kPuffinFooterPayloadCompressed = 0x01;
+
+/// \brief Serializes the footer payload of a Puffin file.
+std::string PuffinFileMetadataToJson(const PuffinFileMetadata& metadata);
+
+/// \brief Parses the footer payload of a Puffin file.
+Result<PuffinFileMetadata> PuffinFileMetadataFromJson(std::string_view payload);
+
+}  // namespace iceberg
@@ -0,0 +1,189 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/puffin/puffin_reader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "iceberg/file_io.h"
+#include "iceberg/puffin/puffin_format_internal.h"
+#include "iceberg/util/endian.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief The size of the end of the file read when the footer size is unknown, which
+/// covers the footers of most files.
+constexpr int64_t kFooterReadSize = 16 * 1024;
+
+constexpr int64_t kMagicSize = kPuffinMagic.size();
+
+/// \brief The smallest footer: the magic, an empty payload and the tail.
+constexpr int64_t kMinFooterSize = kMagicSize + kPuffinFooterTailSize;
+
+bool HasMagic(std::string_view data, size_t offset) {
+  return data.compare(offset, kPuffinMagic.size(), kPuffinMagic.data(),
+                      kPuffinMagic.size()) == 0;
+}
+
+Result<std::string> ReadExactly(InputFile& file, int64_t offset, int64_t length) {
+  std::string data(length, '\0');
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto read, file.ReadAt(offset, {reinterpret_cast<uint8_t*>(data.data()),
+                                      data.size()}));
+  if (read != length) {
+    return IOError("Cannot read {} bytes at offset {} of {}, only {} were read", length,
+                   offset, file.location(), read);
+  }
+  return data;
+}
+
+Result<std::string> Decompress(const PuffinBlobMetadata& blob, std::string data) {
+  if (blob.compression_codec == PuffinCompressionCodec::kNone) {
+    return data;
+  }
+  return PuffinCodecRegistry::GetCodec(blob.compression_codec).decompress(data);
+}
+
+}  // namespace
+
+PuffinReader::PuffinReader(std::unique_ptr<InputFile> file, PuffinFileMetadata metadata,
+                           int64_t footer_size, int64_t footer_offset)
+    : file_(std::move(file)),
+      metadata_(std::move(metadata)),
+      footer_size_(footer_size),
+      footer_offset_(footer_offset) {}
+
+PuffinReader::~PuffinReader() = default;
+
+Result<std::unique_ptr<PuffinReader>> PuffinReader::Open(
+    std::unique_ptr<InputFile> file, std::optional<int64_t> footer_size) {
+  if (file == nullptr) {
+    return InvalidArgument("Cannot open a null Puffin file");
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto file_size, file->Size());
+  if (file_size < kMagicSize + kMinFooterSize) {
+    return InvalidArgument("Invalid Puffin file {}: {} bytes is too short",
+                           file->location(), file_size);
+  }
+  if (footer_size.has_value() && (footer_size.value() < kMinFooterSize ||
+                                  footer_size.value() > file_size - kMagicSize)) {
+    return InvalidArgument("Invalid footer size {} of Puffin file {}",
+                           footer_size.value(), file->location());
+  }
+
+  // Read the end of the file, which holds the whole footer unless it is unusually
+  // large, in which case the rest of the footer is read once its size is known.
+  const int64_t tail_size = footer_size.value_or(std::min(file_size, kFooterReadSize));
+  ICEBERG_ASSIGN_OR_RAISE(auto tail,
+                          ReadExactly(*file, file_size - tail_size, tail_size));
+  if (!HasMagic(tail, tail.size() - kPuffinMagic.size())) {
+    return InvalidArgument("Invalid Puffin file {}: missing the magic of the footer",
+                           file->location());
+  }
+  const char* fields = tail.data() + tail.size() - kPuffinFooterTailSize;
+  int32_t payload_size;
+  std::memcpy(&payload_size, fields, sizeof(payload_size));
+  payload_size = FromLittleEndian(payload_size);
+  const auto flags = static_cast<uint8_t>(fields[sizeof(payload_size)]);
+  const int64_t actual_footer_size = kMinFooterSize + payload_size;
+  if (payload_size < 0 ||
+      actual_footer_size > file_size - kMagicSize) {
+    return InvalidArgument("Invalid Puffin file {}: footer payload size {}",
+                           file->location(), payload_size);
+  }
+  if (footer_size.has_value() && footer_size.value() != actual_footer_size) {
+    return InvalidArgument("Invalid Puffin file {}: footer size is {}, expected {}",
+                           file->location(), actual_footer_size, footer_size.value());
+  }
+  if (actual_footer_size > tail_size) {
+    ICEBERG_ASSIGN_OR_RAISE(auto head,
+                            ReadExactly(*file, file_size - actual_footer_size,
+                                      actual_footer_size - tail_size));
+    tail.insert(0, head);
+  }
+
+  const auto footer = std::string_view(tail).substr(tail.size() - actual_footer_size);
+  if (!HasMagic(footer, 0)) {
+    return InvalidArgument("Invalid Puffin file {}: missing the magic of the footer",
+                           file->location());
+  }
+  std::string payload(footer.substr(kPuffinMagic.size(), payload_size));
+  if ((flags & kPuffinFooterPayloadCompressed) != 0) {
+    ICEBERG_ASSIGN_OR_RAISE(
+        payload,
+        PuffinCodecRegistry::GetCodec(PuffinCompressionCodec::kLz4).decompress(payload));
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto metadata, PuffinFileMetadataFromJson(payload));
+  const int64_t footer_offset = file_size - actual_footer_size;
+  return std::unique_ptr<PuffinReader>(new PuffinReader(
+      std::move(file), std::move(metadata), actual_footer_size, footer_offset));
+}
+
+Status PuffinReader::CheckRange(const PuffinBlobMetadata& blob) const {
+  if (file_ == nullptr) {
+    return InvalidArgument("Puffin reader is closed");
+  }
+  if (blob.offset < kMagicSize || blob.length < 0 ||
+      blob.length > footer_offset_ - blob.offset) {
+    return InvalidArgument("Invalid range [{}, {}) of a {} blob of Puffin file {}",
+                           blob.offset, blob.offset + blob.length, blob.type,
+                           file_->location());
+  }
+  return {};
+}
+
+Result<std::string> PuffinReader::ReadBlob(const PuffinBlobMetadata& blob) {
+  ICEBERG_RETURN_UNEXPECTED(CheckRange(blob));
+  ICEBERG_ASSIGN_OR_RAISE(auto data, ReadExactly(*file_, blob.offset, blob.length));
+  return Decompress(blob, std::move(data));
+}
+
+Result<std::vector<std::string>> PuffinReader::ReadBlobs(
+    std::span<const PuffinBlobMetadata> blobs) {
+  std::vector<std::string> data(blobs.size());
+  std::vector<ReadRange> ranges;
+  ranges.reserve(blobs.size());
+  for (size_t i = 0; i < blobs.size(); ++i) {
+    ICEBERG_RETURN_UNEXPECTED(CheckRange(blobs[i]));
+    data[i].resize(blobs[i].length);
+    ranges.push_back({.offset = blobs[i].offset,
+                      .out = {reinterpret_cast<uint8_t*>(data[i].data()),
+                              data[i].size()}});
+  }
+  ICEBERG_RETURN_UNEXPECTED(file_->ReadRanges(ranges));
+  for (size_t i = 0; i < blobs.size(); ++i) {
+    ICEBERG_ASSIGN_OR_RAISE(data[i], Decompress(blobs[i], std::move(data[i])));
+  }
+  return data;
+}
+
+Status PuffinReader::Close() {
+  if (file_ == nullptr) {
+    return {};
+  }
+  auto file = std::move(file_);
+  return file->Close();
+}
+
+}  // namespace iceberg
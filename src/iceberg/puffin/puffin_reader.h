@@ -0,0 +1,90 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/puffin/puffin_reader.h
+/// Reader of Puffin files, which reads the blobs it is asked for only.
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/puffin/puffin_format.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief Reads the footer and the blobs of a Puffin file.
+///
+/// Opening the file reads its footer only, usually with a single read of the end of the
+/// file. Blobs are then read on demand with positional reads of their ranges, so that a
+/// reader of one deletion vector does not read the other blobs of the file.
+class ICEBERG_EXPORT PuffinReader {
+ public:
+  ~PuffinReader();
+
+  /// \brief Opens a Puffin file and reads its footer.
+  ///
+  /// \param file The file to read
+  /// \param footer_size The size of the footer if known, e.g. from a previous read of
+  /// the file, which is then read with a single request of its exact range
+  /// \return The reader, or an error if the file is not a valid Puffin file.
+  static Result<std::unique_ptr<PuffinReader>> Open(
+      std::unique_ptr<InputFile> file, std::optional<int64_t> footer_size = std::nullopt);
+
+  /// \brief The metadata of the file and its blobs.
+  const PuffinFileMetadata& metadata() const { return metadata_; }
+
+  /// \brief The size of the footer, including its magic and trailing fields.
+  int64_t footer_size() const { return footer_size_; }
+
+  /// \brief Reads and decompresses a blob.
+  ///
+  /// \param blob The metadata of the blob, either from the footer or from another
+  /// source such as the content offset and size of a delete file
+  /// \return The data of the blob, or an error if its range is outside of the blobs of
+  /// the file or its codec is not supported.
+  Result<std::string> ReadBlob(const PuffinBlobMetadata& blob);
+
+  /// \brief Reads and decompresses several blobs, with a vectored read of their ranges.
+  Result<std::vector<std::string>> ReadBlobs(std::span<const PuffinBlobMetadata> blobs);
+
+  /// \brief Closes the file. Blobs cannot be read once the file is closed.
+  Status Close();
+
+ private:
+  PuffinReader(std::unique_ptr<InputFile> file, PuffinFileMetadata metadata,
+               int64_t footer_size, int64_t footer_offset);
+
+  Status CheckRange(const PuffinBlobMetadata& blob) const;
+
+  std::unique_ptr<InputFile> file_;
+  PuffinFileMetadata metadata_;
+  int64_t footer_size_;
+  /// \brief The offset of the footer, where the blobs end.
+  int64_t footer_offset_;
+};
+
+}  // namespace iceberg
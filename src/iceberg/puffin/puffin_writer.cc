@@ -0,0 +1,124 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/puffin/puffin_writer.h"
+
+#include <cstring>
+#include <utility>
+
+#include "iceberg/file_io.h"
+#include "iceberg/puffin/puffin_format_internal.h"
+#include "iceberg/util/endian.h"
+#include "iceberg/util/macros.h"
+#include "iceberg/version.h"
+
+namespace iceberg {
+
+namespace {
+
+void AppendMagic(std::string& out) {
+  out.append(kPuffinMagic.data(), kPuffinMagic.size());
+}
+
+void AppendInt32(std::string& out, int32_t value) {
+  value = ToLittleEndian(value);
+  out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+}  // namespace
+
+PuffinWriter::PuffinWriter(std::unique_ptr<OutputFile> file, PuffinFileMetadata metadata)
+    : file_(std::move(file)), metadata_(std::move(metadata)) {}
+
+PuffinWriter::~PuffinWriter() = default;
+
+Result<std::unique_ptr<PuffinWriter>> PuffinWriter::Make(
+    std::unique_ptr<OutputFile> file,
+    std::unordered_map<std::string, std::string> properties) {
+  if (file == nullptr) {
+    return InvalidArgument("Cannot write a null Puffin file");
+  }
+  properties.try_emplace(std::string(PuffinConstants::kCreatedBy),
+                         "Apache Iceberg C++ " ICEBERG_VERSION_STRING);
+  PuffinFileMetadata metadata;
+  metadata.properties = std::move(properties);
+  return std::unique_ptr<PuffinWriter>(
+      new PuffinWriter(std::move(file), std::move(metadata)));
+}
+
+Status PuffinWriter::WriteHeader() {
+  if (!header_written_) {
+    ICEBERG_RETURN_UNEXPECTED(
+        file_->Write(std::string_view(kPuffinMagic.data(), kPuffinMagic.size())));
+    header_written_ = true;
+  }
+  return {};
+}
+
+Result<PuffinBlobMetadata> PuffinWriter::Add(const PuffinBlob& blob) {
+  if (closed_) {
+    return InvalidArgument("Puffin writer is closed");
+  }
+  ICEBERG_RETURN_UNEXPECTED(WriteHeader());
+  std::string compressed;
+  std::string_view data = blob.data;
+  if (blob.compression_codec != PuffinCompressionCodec::kNone) {
+    ICEBERG_ASSIGN_OR_RAISE(
+        compressed, PuffinCodecRegistry::GetCodec(blob.compression_codec).compress(data));
+    data = compressed;
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto offset, file_->Position());
+  ICEBERG_RETURN_UNEXPECTED(file_->Write(data));
+
+  PuffinBlobMetadata metadata{.type = blob.type,
+                              .fields = blob.fields,
+                              .snapshot_id = blob.snapshot_id,
+                              .sequence_number = blob.sequence_number,
+                              .offset = offset,
+                              .length = static_cast<int64_t>(data.size()),
+                              .compression_codec = blob.compression_codec,
+                              .properties = blob.properties};
+  metadata_.blobs.push_back(metadata);
+  return metadata;
+}
+
+Status PuffinWriter::Close() {
+  if (closed_) {
+    return InvalidArgument("Puffin writer is closed");
+  }
+  closed_ = true;
+  ICEBERG_RETURN_UNEXPECTED(WriteHeader());
+
+  // The footer is the magic, the uncompressed JSON payload, the size of the payload,
+  // the flags and the magic again.
+  const std::string payload = PuffinFileMetadataToJson(metadata_);
+  std::string footer;
+  footer.reserve(payload.size() + kPuffinMagic.size() + kPuffinFooterTailSize);
+  AppendMagic(footer);
+  footer.append(payload);
+  AppendInt32(footer, static_cast<int32_t>(payload.size()));
+  AppendInt32(footer, /*flags=*/0);
+  AppendMagic(footer);
+  ICEBERG_RETURN_UNEXPECTED(file_->Write(footer));
+  ICEBERG_ASSIGN_OR_RAISE(file_size_, file_->Position());
+  footer_size_ = static_cast<int64_t>(footer.size());
+  return file_->Close();
+}
+
+}  // namespace iceberg
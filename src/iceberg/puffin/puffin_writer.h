@@ -0,0 +1,104 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/puffin/puffin_writer.h
+/// Writer of Puffin files, which streams the blobs into the file as they are added.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/puffin/puffin_format.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief A blob to add to a Puffin file.
+struct ICEBERG_EXPORT PuffinBlob {
+  /// \brief The type of the blob.
+  std::string type;
+  /// \brief The ids of the fields the blob was computed for.
+  std::vector<int32_t> fields;
+  /// \brief The id of the snapshot the blob was computed from, or -1.
+  int64_t snapshot_id = -1;
+  /// \brief The sequence number of the snapshot the blob was computed from, or -1.
+  int64_t sequence_number = -1;
+  /// \brief The uncompressed data of the blob.
+  std::string_view data;
+  /// \brief The codec to compress the blob with.
+  PuffinCompressionCodec compression_codec = PuffinCompressionCodec::kNone;
+  /// \brief Additional properties of the blob, specific to its type.
+  std::unordered_map<std::string, std::string> properties;
+};
+
+/// \brief Writes blobs into a Puffin file.
+///
+/// The data of each blob is written to the file when it is added, so only the metadata
+/// of the blobs is kept until the footer is written by Close().
+class ICEBERG_EXPORT PuffinWriter {
+ public:
+  ~PuffinWriter();
+
+  /// \brief Creates a Puffin writer.
+  ///
+  /// \param file The file to write
+  /// \param properties The properties of the file, to which `created-by` is added
+  /// unless it is set
+  static Result<std::unique_ptr<PuffinWriter>> Make(
+      std::unique_ptr<OutputFile> file,
+      std::unordered_map<std::string, std::string> properties = {});
+
+  /// \brief Compresses and writes a blob.
+  ///
+  /// \return The metadata of the blob, with its offset and length in the file.
+  Result<PuffinBlobMetadata> Add(const PuffinBlob& blob);
+
+  /// \brief Writes the footer and closes the file.
+  Status Close();
+
+  /// \brief The metadata of the blobs written so far.
+  const std::vector<PuffinBlobMetadata>& blobs() const { return metadata_.blobs; }
+
+  /// \brief The size of the footer, once the writer is closed.
+  int64_t footer_size() const { return footer_size_; }
+
+  /// \brief The size of the file, once the writer is closed.
+  int64_t file_size() const { return file_size_; }
+
+ private:
+  PuffinWriter(std::unique_ptr<OutputFile> file, PuffinFileMetadata metadata);
+
+  Status WriteHeader();
+
+  std::unique_ptr<OutputFile> file_;
+  PuffinFileMetadata metadata_;
+  bool header_written_ = false;
+  bool closed_ = false;
+  int64_t footer_size_ = 0;
+  int64_t file_size_ = 0;
+};
+
+}  // namespace iceberg
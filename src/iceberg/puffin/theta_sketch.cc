@@ -0,0 +1,225 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/puffin/theta_sketch.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "iceberg/util/endian.h"
+#include "iceberg/util/murmurhash3_internal.h"
+
+namespace iceberg {
+
+namespace {
+
+constexpr uint8_t kSerialVersion = 3;
+constexpr uint8_t kCompactFamily = 3;
+
+constexpr uint8_t kBigEndianFlag = 1 << 0;
+constexpr uint8_t kReadOnlyFlag = 1 << 1;
+constexpr uint8_t kEmptyFlag = 1 << 2;
+constexpr uint8_t kCompactFlag = 1 << 3;
+constexpr uint8_t kOrderedFlag = 1 << 4;
+constexpr uint8_t kSingleItemFlag = 1 << 5;
+
+/// \brief The hash of the seed stored in serialized sketches, so that sketches of
+/// different seeds are not merged.
+uint16_t SeedHash(uint64_t seed) {
+  uint64_t key = ToLittleEndian(seed);
+  uint64_t hash[2];
+  MurmurHash3_x64_128(&key, sizeof(key), 0, hash);
+  return static_cast<uint16_t>(hash[0] & 0xFFFF);
+}
+
+template <typename T>
+void Append(std::string& out, T value) {
+  value = ToLittleEndian(value);
+  out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+T Load(std::string_view data, size_t offset) {
+  T value;
+  std::memcpy(&value, data.data() + offset, sizeof(value));
+  return FromLittleEndian(value);
+}
+
+}  // namespace
+
+ThetaSketch::ThetaSketch(int32_t nominal_entries)
+    : nominal_entries_(std::max(nominal_entries, 16)) {}
+
+void ThetaSketch::Update(std::string_view value) {
+  uint64_t hash[2];
+  MurmurHash3_x64_128(value.data(), static_cast<int>(value.size()), kDefaultSeed, hash);
+  empty_ = false;
+  UpdateHash(hash[0] >> 1);
+}
+
+void ThetaSketch::UpdateHash(uint64_t hash) {
+  // Zero is not a valid hash, as in the library.
+  if (hash == 0 || hash >= theta_) {
+    return;
+  }
+  hashes_.push_back(hash);
+  if (hashes_.size() >= 2 * static_cast<size_t>(nominal_entries_)) {
+    Rebuild();
+  }
+}
+
+void ThetaSketch::Rebuild() {
+  std::ranges::sort(hashes_);
+  hashes_.erase(std::unique(hashes_.begin(), hashes_.end()), hashes_.end());
+  if (hashes_.size() > static_cast<size_t>(nominal_entries_)) {
+    // The smallest dropped hash is the new theta, so that the retained hashes are all
+    // the hashes below it.
+    theta_ = hashes_[nominal_entries_];
+    hashes_.resize(nominal_entries_);
+  }
+}
+
+ThetaSketch ThetaSketch::Compacted() const {
+  ThetaSketch sketch = *this;
+  sketch.Rebuild();
+  return sketch;
+}
+
+void ThetaSketch::Merge(const ThetaSketch& other) {
+  empty_ = empty_ && other.empty_;
+  if (other.theta_ < theta_) {
+    theta_ = other.theta_;
+    std::erase_if(hashes_, [this](uint64_t hash) { return hash >= theta_; });
+  }
+  for (uint64_t hash : other.hashes_) {
+    UpdateHash(hash);
+  }
+}
+
+uint64_t ThetaSketch::theta() const { return Compacted().theta_; }
+
+int64_t ThetaSketch::num_retained() const {
+  return static_cast<int64_t>(Compacted().hashes_.size());
+}
+
+double ThetaSketch::Estimate() const {
+  const auto sketch = Compacted();
+  const auto count = static_cast<double>(sketch.hashes_.size());
+  if (sketch.theta_ == kMaxTheta) {
+    return count;
+  }
+  return count / (static_cast<double>(sketch.theta_) / static_cast<double>(kMaxTheta));
+}
+
+std::string ThetaSketch::Serialize() const {
+  const auto sketch = Compacted();
+  const auto& hashes = sketch.hashes_;
+  const bool estimation_mode = sketch.theta_ < kMaxTheta;
+  uint8_t flags = kReadOnlyFlag | kCompactFlag | kOrderedFlag;
+  uint8_t preamble_longs = 1;
+  if (hashes.empty() && !estimation_mode) {
+    flags |= kEmptyFlag;
+  } else if (hashes.size() == 1 && !estimation_mode) {
+    flags |= kSingleItemFlag;
+  } else {
+    preamble_longs = estimation_mode ? 3 : 2;
+  }
+
+  std::string out;
+  out.reserve(8 * (preamble_longs + hashes.size()));
+  Append<uint8_t>(out, preamble_longs);
+  Append<uint8_t>(out, kSerialVersion);
+  Append<uint8_t>(out, kCompactFamily);
+  // The logarithms of the nominal entries and of the hash table size are not used by
+  // compact sketches.
+  Append<uint16_t>(out, 0);
+  Append<uint8_t>(out, flags);
+  Append<uint16_t>(out, SeedHash(kDefaultSeed));
+  if (preamble_longs > 1) {
+    Append<uint32_t>(out, static_cast<uint32_t>(hashes.size()));
+    Append<uint32_t>(out, 0);
+  }
+  if (preamble_longs > 2) {
+    Append<uint64_t>(out, sketch.theta_);
+  }
+  for (uint64_t hash : hashes) {
+    Append<uint64_t>(out, hash);
+  }
+  return out;
+}
+
+Result<ThetaSketch> ThetaSketch::Deserialize(std::string_view data) {
+  if (data.size() < 8) {
+    return InvalidArgument("Invalid theta sketch of {} bytes", data.size());
+  }
+  const auto preamble_longs = static_cast<uint8_t>(data[0]) & 0x3F;
+  const auto serial_version = static_cast<uint8_t>(data[1]);
+  const auto family = static_cast<uint8_t>(data[2]);
+  const auto flags = static_cast<uint8_t>(data[5]);
+  if (serial_version != kSerialVersion || family != kCompactFamily ||
+      (flags & kCompactFlag) == 0) {
+    return NotSupported(
+        "Unsupported theta sketch of serial version {} and family {}, expected a "
+        "compact sketch of serial version {}",
+        serial_version, family, kSerialVersion);
+  }
+  if ((flags & kBigEndianFlag) != 0) {
+    return NotSupported("Unsupported big-endian theta sketch");
+  }
+  if (const auto seed_hash = Load<uint16_t>(data, 6);
+      seed_hash != SeedHash(kDefaultSeed)) {
+    return InvalidArgument("Theta sketch of seed hash {} does not use the default seed",
+                           seed_hash);
+  }
+
+  ThetaSketch sketch;
+  size_t num_entries = 0;
+  size_t offset = 8;
+  if (preamble_longs == 1) {
+    num_entries = (flags & kSingleItemFlag) != 0 ? 1 : 0;
+  } else if (preamble_longs == 2 || preamble_longs == 3) {
+    if (data.size() < 8 * static_cast<size_t>(preamble_longs)) {
+      return InvalidArgument("Invalid theta sketch of {} bytes", data.size());
+    }
+    num_entries = Load<uint32_t>(data, 8);
+    if (preamble_longs == 3) {
+      sketch.theta_ = Load<uint64_t>(data, 16);
+    }
+    offset = 8 * preamble_longs;
+  } else {
+    return InvalidArgument("Invalid theta sketch with {} preamble longs",
+                           preamble_longs);
+  }
+  if ((data.size() - offset) / 8 < num_entries) {
+    return InvalidArgument("Invalid theta sketch of {} bytes with {} entries",
+                           data.size(), num_entries);
+  }
+  sketch.empty_ = (flags & kEmptyFlag) != 0;
+  // The retained hashes of larger sketches are kept, so that merging them does not
+  // lose accuracy.
+  sketch.nominal_entries_ =
+      std::max(sketch.nominal_entries_, static_cast<int32_t>(num_entries));
+  sketch.hashes_.reserve(num_entries);
+  for (size_t i = 0; i < num_entries; ++i) {
+    sketch.hashes_.push_back(Load<uint64_t>(data, offset + 8 * i));
+  }
+  return sketch;
+}
+
+}  // namespace iceberg
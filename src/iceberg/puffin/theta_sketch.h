@@ -0,0 +1,103 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/puffin/theta_sketch.h
+/// Theta sketches estimating the number of distinct values of a column.
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+
+namespace iceberg {
+
+/// \brief A theta sketch of the Apache DataSketches library.
+///
+/// Values are hashed with the 64-bit MurmurHash3 of the library and its default seed,
+/// and the sketch retains the smallest hashes, up to its nominal number of entries.
+/// Sketches are serialized in the "compact" format of the library, which is the
+/// payload of `apache-datasketches-theta-v1` blobs, so that they can be read and
+/// merged by other implementations.
+class ICEBERG_EXPORT ThetaSketch {
+ public:
+  /// \brief The default number of retained hashes, giving a relative standard error of
+  /// about 1.6% in estimation mode.
+  static constexpr int32_t kDefaultNominalEntries = 4096;
+  /// \brief The default hash seed of the library.
+  static constexpr uint64_t kDefaultSeed = 9001;
+  /// \brief The theta of a sketch that retains the hashes of all the values.
+  static constexpr uint64_t kMaxTheta = std::numeric_limits<int64_t>::max();
+
+  explicit ThetaSketch(int32_t nominal_entries = kDefaultNominalEntries);
+
+  /// \brief Updates the sketch with a value, in its single-value serialization.
+  void Update(std::string_view value);
+
+  /// \brief Merges the values of another sketch into this sketch.
+  void Merge(const ThetaSketch& other);
+
+  /// \brief Returns the estimated number of distinct values.
+  double Estimate() const;
+
+  /// \brief Returns whether the sketch was not updated with any value.
+  bool IsEmpty() const { return empty_; }
+
+  /// \brief Returns whether the sketch dropped hashes, so that Estimate() is not exact.
+  bool IsEstimationMode() const { return theta() < kMaxTheta; }
+
+  /// \brief Returns the threshold below which the hashes are retained.
+  uint64_t theta() const;
+
+  /// \brief Returns the number of retained hashes.
+  int64_t num_retained() const;
+
+  /// \brief Serializes the sketch in the compact format of the library.
+  std::string Serialize() const;
+
+  /// \brief Deserializes a sketch in the compact format of the library.
+  ///
+  /// \return The sketch, or an error if the data is not a compact theta sketch of the
+  /// default seed.
+  static Result<ThetaSketch> Deserialize(std::string_view data);
+
+ private:
+  void UpdateHash(uint64_t hash);
+
+  /// \brief Sorts and deduplicates the hashes, and drops the hashes above the nominal
+  /// number of entries.
+  void Rebuild();
+
+  /// \brief Returns a copy of the sketch with the sorted distinct hashes below theta.
+  ThetaSketch Compacted() const;
+
+  int32_t nominal_entries_;
+  uint64_t theta_ = kMaxTheta;
+  bool empty_ = true;
+  /// \brief The hashes below theta, which may be unsorted and contain duplicates until
+  /// there are twice the nominal number of entries.
+  std::vector<uint64_t> hashes_;
+};
+
+}  // namespace iceberg
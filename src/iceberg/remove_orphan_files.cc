@@ -0,0 +1,376 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/remove_orphan_files.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
+
+#include "iceberg/executor.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_entry_batch.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/manifest_reader.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/statistics_file.h"
+#include "iceberg/table.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/table_properties.h"
+#include "iceberg/util/macros.h"
+#include "iceberg/util/string_util.h"
+#include "iceberg/util/uuid.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief Locations hashed into shards, each kept in memory up to its share of the
+/// memory limit and appended to a spill file beyond it.
+///
+/// Locations of a shard are stored one after the other, separated by a NUL byte,
+/// which object keys and file names cannot contain. Add() can be called concurrently.
+class LocationShards {
+ public:
+  LocationShards(size_t num_shards, size_t memory_limit_bytes,
+                 std::filesystem::path spill_prefix)
+      : shard_limit_bytes_(std::max<size_t>(memory_limit_bytes / num_shards, 1)),
+        spill_prefix_(std::move(spill_prefix)),
+        shards_(num_shards) {}
+
+  ~LocationShards() {
+    for (size_t i = 0; i < shards_.size(); ++i) {
+      if (shards_[i].spilled) {
+        std::error_code ec;
+        std::filesystem::remove(SpillPath(i), ec);
+      }
+    }
+  }
+
+  size_t num_shards() const { return shards_.size(); }
+
+  /// \brief Adds a location to the shard of a normalized location.
+  Status Add(std::string_view key, std::string_view location) {
+    const size_t index = std::hash<std::string_view>{}(key) % shards_.size();
+    auto& shard = shards_[index];
+    std::lock_guard lock(shard.mutex);
+    shard.buffer.append(location);
+    shard.buffer.push_back('\0');
+    if (shard.buffer.size() < shard_limit_bytes_) {
+      return {};
+    }
+    std::ofstream out(SpillPath(index), std::ios::binary | std::ios::app);
+    out.write(shard.buffer.data(), static_cast<std::streamsize>(shard.buffer.size()));
+    if (!out) {
+      return IOError("Failed to spill locations to {}", SpillPath(index).string());
+    }
+    shard.spilled = true;
+    shard.buffer.clear();
+    return {};
+  }
+
+  /// \brief Visits the locations of a shard, the spilled ones first.
+  Status Visit(size_t index,
+               const std::function<void(std::string_view)>& visitor) const {
+    const auto& shard = shards_[index];
+    if (shard.spilled) {
+      std::ifstream in(SpillPath(index), std::ios::binary);
+      if (!in) {
+        return IOError("Failed to read spilled locations from {}",
+                       SpillPath(index).string());
+      }
+      for (std::string location; std::getline(in, location, '\0');) {
+        visitor(location);
+      }
+      if (in.bad()) {
+        return IOError("Failed to read spilled locations from {}",
+                       SpillPath(index).string());
+      }
+    }
+    std::string_view buffer = shard.buffer;
+    for (size_t begin = 0; begin < buffer.size();) {
+      const size_t end = buffer.find('\0', begin);
+      visitor(buffer.substr(begin, end - begin));
+      begin = end + 1;
+    }
+    return {};
+  }
+
+ private:
+  struct Shard {
+    std::mutex mutex;
+    std::string buffer;
+    bool spilled = false;
+  };
+
+  std::filesystem::path SpillPath(size_t index) const {
+    return std::filesystem::path(spill_prefix_.string() + "-" + std::to_string(index));
+  }
+
+  const size_t shard_limit_bytes_;
+  const std::filesystem::path spill_prefix_;
+  std::vector<Shard> shards_;
+};
+
+/// \brief Visits the paths of the files of all entries of a manifest.
+///
+/// Only the required data file fields are decoded, and the partition tuples are
+/// skipped.
+Status VisitFilePaths(const ManifestFile& manifest, const std::shared_ptr<FileIO>& io,
+                      const std::function<Status(std::string_view)>& visitor) {
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto reader,
+      ManifestReader::Make(manifest, io, /*partition_schema=*/nullptr,
+                           {.columns = {std::string(DataFile::kFilePath.name())}}));
+  return reader->VisitBatches([&](const ManifestEntryBatch& batch) -> Status {
+    for (int64_t row = 0; row < batch.size(); ++row) {
+      ICEBERG_RETURN_UNEXPECTED(visitor(batch.file_path(row)));
+    }
+    return {};
+  });
+}
+
+}  // namespace
+
+std::string NormalizeLocation(
+    std::string_view location,
+    const std::unordered_map<std::string, std::string>& equal_schemes,
+    const std::unordered_map<std::string, std::string>& equal_authorities) {
+  std::string scheme;
+  std::string authority;
+  std::string_view path = location;
+  if (auto pos = location.find("://"); pos != std::string_view::npos) {
+    scheme = StringUtils::ToLower(location.substr(0, pos));
+    auto rest = location.substr(pos + 3);
+    auto slash = rest.find('/');
+    authority = std::string(rest.substr(0, slash));
+    path = slash == std::string_view::npos ? std::string_view{} : rest.substr(slash);
+  } else if (StringUtils::ToLower(location.substr(0, 5)) == "file:") {
+    scheme = "file";
+    path = location.substr(5);
+  }
+  if (auto it = equal_schemes.find(scheme); it != equal_schemes.end()) {
+    scheme = it->second;
+  }
+  if (auto it = equal_authorities.find(authority); it != equal_authorities.end()) {
+    authority = it->second;
+  }
+
+  std::string normalized;
+  normalized.reserve(location.size());
+  // Local paths are compared without their scheme.
+  if (!scheme.empty() && scheme != "file") {
+    normalized.append(scheme).append("://").append(authority);
+  }
+  for (char c : path) {
+    if (c != '/' || normalized.empty() || normalized.back() != '/') {
+      normalized.push_back(c);
+    }
+  }
+  return normalized;
+}
+
+RemoveOrphanFiles::RemoveOrphanFiles(std::shared_ptr<Table> table)
+    : table_(std::move(table)), equal_schemes_{{"s3a", "s3"}, {"s3n", "s3"}} {}
+
+RemoveOrphanFiles::~RemoveOrphanFiles() = default;
+
+RemoveOrphanFiles& RemoveOrphanFiles::Location(std::string location) {
+  location_ = std::move(location);
+  return *this;
+}
+
+RemoveOrphanFiles& RemoveOrphanFiles::OlderThan(TimePointMs timestamp) {
+  older_than_ = timestamp;
+  return *this;
+}
+
+RemoveOrphanFiles& RemoveOrphanFiles::DryRun(bool dry_run) {
+  dry_run_ = dry_run;
+  return *this;
+}
+
+RemoveOrphanFiles& RemoveOrphanFiles::WithParallelism(int32_t parallelism) {
+  parallelism_ = parallelism;
+  return *this;
+}
+
+RemoveOrphanFiles& RemoveOrphanFiles::WithExecutor(std::shared_ptr<Executor> executor) {
+  executor_ = std::move(executor);
+  return *this;
+}
+
+RemoveOrphanFiles& RemoveOrphanFiles::EqualSchemes(
+    std::unordered_map<std::string, std::string> schemes) {
+  equal_schemes_ = std::move(schemes);
+  return *this;
+}
+
+RemoveOrphanFiles& RemoveOrphanFiles::EqualAuthorities(
+    std::unordered_map<std::string, std::string> authorities) {
+  equal_authorities_ = std::move(authorities);
+  return *this;
+}
+
+RemoveOrphanFiles& RemoveOrphanFiles::NumShards(size_t num_shards) {
+  num_shards_ = num_shards;
+  return *this;
+}
+
+RemoveOrphanFiles& RemoveOrphanFiles::MemoryLimit(size_t bytes) {
+  memory_limit_bytes_ = bytes;
+  return *this;
+}
+
+RemoveOrphanFiles& RemoveOrphanFiles::SpillDirectory(std::string directory) {
+  spill_directory_ = std::move(directory);
+  return *this;
+}
+
+Result<RemoveOrphanFilesResult> RemoveOrphanFiles::Execute() const {
+  if (parallelism_ < 1) {
+    return InvalidArgument("Parallelism must be positive, got {}", parallelism_);
+  }
+  if (num_shards_ < 1) {
+    return InvalidArgument("Number of shards must be positive, got {}", num_shards_);
+  }
+  if (!dry_run_ && !table_->properties().Get(TableProperties::kGcEnabled)) {
+    return InvalidArgument(
+        "Cannot remove the orphan files of table {}: {} is false, files may be "
+        "referenced by other tables",
+        table_->name().name, TableProperties::kGcEnabled.key());
+  }
+
+  const auto& io = table_->io();
+  const auto metadata = table_->metadata();
+  const auto executor = executor_ != nullptr ? executor_ : DefaultExecutor();
+  const auto older_than =
+      older_than_.value_or(std::chrono::time_point_cast<std::chrono::milliseconds>(
+                               std::chrono::system_clock::now()) -
+                           std::chrono::days(3));
+  auto normalize = [&](std::string_view location) {
+    return NormalizeLocation(location, equal_schemes_, equal_authorities_);
+  };
+
+  std::error_code ec;
+  const std::filesystem::path spill_directory =
+      spill_directory_.has_value() ? std::filesystem::path(spill_directory_.value())
+                                   : std::filesystem::temp_directory_path(ec);
+  if (ec) {
+    return IOError("Failed to find a directory for spill files: {}", ec.message());
+  }
+  const auto spill_prefix =
+      spill_directory / ("orphan-files-" + Uuid::GenerateV4().ToString());
+  LocationShards referenced(num_shards_, memory_limit_bytes_ / 2,
+                            spill_prefix.string() + "-referenced");
+  LocationShards listed(num_shards_, memory_limit_bytes_ / 2,
+                        spill_prefix.string() + "-listed");
+  auto add_referenced = [&](std::string_view location) -> Status {
+    auto key = normalize(location);
+    return referenced.Add(key, key);
+  };
+
+  // Referenced metadata files.
+  ICEBERG_RETURN_UNEXPECTED(add_referenced(table_->metadata_location()));
+  for (const auto& entry : metadata->metadata_log) {
+    ICEBERG_RETURN_UNEXPECTED(add_referenced(entry.metadata_file));
+  }
+  ICEBERG_RETURN_UNEXPECTED(
+      add_referenced(metadata->location + "/metadata/version-hint.text"));
+  for (const auto& file : metadata->statistics) {
+    ICEBERG_RETURN_UNEXPECTED(add_referenced(file->path));
+  }
+  for (const auto& file : metadata->partition_statistics) {
+    ICEBERG_RETURN_UNEXPECTED(add_referenced(file->path));
+  }
+
+  // Referenced manifest lists, manifests and content files.
+  ICEBERG_ASSIGN_OR_RAISE(auto snapshots, metadata->AllSnapshots());
+  std::vector<std::vector<ManifestFile>> manifest_lists(snapshots.size());
+  ICEBERG_RETURN_UNEXPECTED(
+      RunInParallel(*executor, snapshots.size(), parallelism_, [&](size_t i) -> Status {
+        const auto& manifest_list = snapshots[i]->manifest_list;
+        if (manifest_list.empty()) {
+          return {};
+        }
+        ICEBERG_RETURN_UNEXPECTED(add_referenced(manifest_list));
+        ICEBERG_ASSIGN_OR_RAISE(auto reader, ManifestListReader::Make(manifest_list, io));
+        ICEBERG_ASSIGN_OR_RAISE(manifest_lists[i], reader->Files());
+        return {};
+      }));
+  // Manifests are shared by the snapshots that did not rewrite them, each one is read
+  // once.
+  std::unordered_set<std::string_view> manifest_paths;
+  std::vector<const ManifestFile*> manifests;
+  for (const auto& manifest_list : manifest_lists) {
+    for (const auto& manifest : manifest_list) {
+      if (manifest_paths.insert(manifest.manifest_path).second) {
+        manifests.push_back(&manifest);
+      }
+    }
+  }
+  ICEBERG_RETURN_UNEXPECTED(
+      RunInParallel(*executor, manifests.size(), parallelism_, [&](size_t i) -> Status {
+        ICEBERG_RETURN_UNEXPECTED(add_referenced(manifests[i]->manifest_path));
+        return VisitFilePaths(*manifests[i], io, add_referenced);
+      }));
+
+  // Listed files, as they are streamed by the FileIO.
+  const std::string& location = location_.value_or(metadata->location);
+  ICEBERG_RETURN_UNEXPECTED(io->ListFiles(location, [&](const FileInfo& file) -> Status {
+    if (file.last_modified >= older_than) {
+      return {};
+    }
+    return listed.Add(normalize(file.location), file.location);
+  }));
+
+  // Join the listed and referenced locations one shard at a time.
+  std::vector<std::vector<std::string>> shard_orphans(num_shards_);
+  ICEBERG_RETURN_UNEXPECTED(
+      RunInParallel(*executor, num_shards_, parallelism_, [&](size_t shard) -> Status {
+        std::unordered_set<std::string, StringHash, std::equal_to<>> keys;
+        ICEBERG_RETURN_UNEXPECTED(referenced.Visit(
+            shard, [&](std::string_view key) { keys.emplace(key); }));
+        return listed.Visit(shard, [&](std::string_view file_location) {
+          if (!keys.contains(normalize(file_location))) {
+            shard_orphans[shard].emplace_back(file_location);
+          }
+        });
+      }));
+
+  RemoveOrphanFilesResult result;
+  for (auto& orphans : shard_orphans) {
+    result.orphan_file_locations.insert(result.orphan_file_locations.end(),
+                                        std::make_move_iterator(orphans.begin()),
+                                        std::make_move_iterator(orphans.end()));
+  }
+  if (!dry_run_ && !result.orphan_file_locations.empty()) {
+    result.delete_failures = io->DeleteFiles(result.orphan_file_locations);
+    result.deleted_files_count = static_cast<int64_t>(
+        result.orphan_file_locations.size() - result.delete_failures.size());
+  }
+  return result;
+}
+
+}  // namespace iceberg
@@ -0,0 +1,147 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/remove_orphan_files.h
+/// Detection and removal of the files under a table location that no snapshot
+/// references.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "iceberg/file_io.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+#include "iceberg/util/timepoint.h"
+
+namespace iceberg {
+
+/// \brief Returns the form of a location used to compare it with other locations.
+///
+/// Schemes and authorities are replaced by their canonical names in
+/// `equal_schemes` and `equal_authorities`, and repeated slashes of the path are
+/// collapsed. Locations without a scheme are local paths, as are `file:` locations.
+///
+/// \param location The location to normalize
+/// \param equal_schemes Canonical names of schemes, e.g. "s3a" to "s3"
+/// \param equal_authorities Canonical names of authorities
+ICEBERG_EXPORT std::string NormalizeLocation(
+    std::string_view location,
+    const std::unordered_map<std::string, std::string>& equal_schemes,
+    const std::unordered_map<std::string, std::string>& equal_authorities);
+
+/// \brief The outcome of an orphan file removal.
+struct ICEBERG_EXPORT RemoveOrphanFilesResult {
+  /// \brief The locations of the orphan files, as listed.
+  std::vector<std::string> orphan_file_locations;
+  /// \brief The number of deleted orphan files, 0 for a dry run.
+  int64_t deleted_files_count = 0;
+  /// \brief The orphan files that could not be deleted.
+  std::vector<FileDeleteFailure> delete_failures;
+};
+
+/// \brief Finds the files under the location of a table that are not referenced by
+/// the table metadata, and deletes them.
+///
+/// The referenced files are the current and previous metadata files, and the manifest
+/// lists, manifests, data and delete files and statistics files of all snapshots. The
+/// manifest lists and manifests are read with up to `parallelism` of them in flight, and
+/// each manifest shared by several snapshots is read once.
+///
+/// Both the listed and the referenced locations are normalized and hashed into shards,
+/// kept in memory up to the memory limit and spilled to files of the spill directory
+/// beyond it. The orphans are then found one shard at a time, with a hash set of the
+/// referenced locations of the shard only, so memory is bounded by the size of a shard
+/// whatever the number of files of the table.
+///
+/// Files newer than the `OlderThan()` timestamp, 3 days before now by default, are
+/// never orphans, as they may belong to a commit in progress.
+class ICEBERG_EXPORT RemoveOrphanFiles {
+ public:
+  /// \brief The default number of shards of the listed and referenced locations.
+  static constexpr size_t kDefaultNumShards = 64;
+  /// \brief The default memory limit of the shards before they are spilled.
+  static constexpr size_t kDefaultMemoryLimitBytes = size_t{256} << 20;
+
+  /// \brief Creates an orphan file removal for a table.
+  explicit RemoveOrphanFiles(std::shared_ptr<Table> table);
+
+  ~RemoveOrphanFiles();
+
+  /// \brief Sets the location to list, the table location by default.
+  RemoveOrphanFiles& Location(std::string location);
+
+  /// \brief Only considers the files last modified before a timestamp.
+  RemoveOrphanFiles& OlderThan(TimePointMs timestamp);
+
+  /// \brief Sets whether to only find the orphan files without deleting them.
+  RemoveOrphanFiles& DryRun(bool dry_run);
+
+  /// \brief Sets the number of manifest lists and manifests read concurrently, 1 by
+  /// default.
+  RemoveOrphanFiles& WithParallelism(int32_t parallelism);
+
+  /// \brief Sets the executor reading the manifests and shards concurrently, the
+  /// DefaultExecutor() if null.
+  RemoveOrphanFiles& WithExecutor(std::shared_ptr<Executor> executor);
+
+  /// \brief Sets the canonical names of schemes, by default "s3a" and "s3n" are "s3".
+  RemoveOrphanFiles& EqualSchemes(std::unordered_map<std::string, std::string> schemes);
+
+  /// \brief Sets the canonical names of authorities, none by default.
+  RemoveOrphanFiles& EqualAuthorities(
+      std::unordered_map<std::string, std::string> authorities);
+
+  /// \brief Sets the number of shards of the listed and referenced locations.
+  RemoveOrphanFiles& NumShards(size_t num_shards);
+
+  /// \brief Sets how many bytes of locations are kept in memory before the shards are
+  /// spilled.
+  RemoveOrphanFiles& MemoryLimit(size_t bytes);
+
+  /// \brief Sets the local directory of the spill files, the system temporary directory
+  /// by default.
+  RemoveOrphanFiles& SpillDirectory(std::string directory);
+
+  /// \brief Finds the orphan files and deletes them unless this is a dry run.
+  Result<RemoveOrphanFilesResult> Execute() const;
+
+ private:
+  std::shared_ptr<Table> table_;
+  std::optional<std::string> location_;
+  std::optional<TimePointMs> older_than_;
+  bool dry_run_ = false;
+  int32_t parallelism_ = 1;
+  std::shared_ptr<Executor> executor_;
+  std::unordered_map<std::string, std::string> equal_schemes_;
+  std::unordered_map<std::string, std::string> equal_authorities_;
+  size_t num_shards_ = kDefaultNumShards;
+  size_t memory_limit_bytes_ = kDefaultMemoryLimitBytes;
+  std::optional<std::string> spill_directory_;
+};
+
+}  // namespace iceberg
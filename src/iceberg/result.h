@@ -32,6 +32,7 @@ enum class ErrorKind {
   kAlreadyExists,
   kCommitFailed,
   kCommitStateUnknown,
+  kCompressError,
   kDecompressError,
   kInvalid,  // For general invalid errors
   kInvalidArgument,
@@ -48,7 +49,9 @@ enum class ErrorKind {
   kNotFound,
   kNotImplemented,
   kNotSupported,
+  kOutOfMemory,
   kUnknownError,
+  kValidationFailed,  // Conflicts with concurrent changes that retries cannot resolve
 };
 
 /// \brief Error with a kind and a message.
@@ -81,6 +84,7 @@ using Status = Result<void>;
 DEFINE_ERROR_FUNCTION(AlreadyExists)
 DEFINE_ERROR_FUNCTION(CommitFailed)
 DEFINE_ERROR_FUNCTION(CommitStateUnknown)
+DEFINE_ERROR_FUNCTION(CompressError)
 DEFINE_ERROR_FUNCTION(DecompressError)
 DEFINE_ERROR_FUNCTION(Invalid)
 DEFINE_ERROR_FUNCTION(InvalidArgument)
@@ -97,7 +101,9 @@ DEFINE_ERROR_FUNCTION(NotAllowed)
 DEFINE_ERROR_FUNCTION(NotFound)
 DEFINE_ERROR_FUNCTION(NotImplemented)
 DEFINE_ERROR_FUNCTION(NotSupported)
+DEFINE_ERROR_FUNCTION(OutOfMemory)
 DEFINE_ERROR_FUNCTION(UnknownError)
+DEFINE_ERROR_FUNCTION(ValidationFailed)
 
 #undef DEFINE_ERROR_FUNCTION
 
@@ -0,0 +1,735 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/rewrite_data_files.h"
+
+#include <algorithm>
+#include <compare>
+#include <cstring>
+#include <format>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <set>
+#include <tuple>
+#include <utility>
+
+#include "iceberg/arrow_c_data.h"
+#include "iceberg/data_writer.h"
+#include "iceberg/executor.h"
+#include "iceberg/file_format.h"
+#include "iceberg/file_io.h"
+#include "iceberg/location_provider.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_entry_batch.h"
+#include "iceberg/manifest_reader.h"
+#include "iceberg/manifest_writer.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/sort_order.h"
+#include "iceberg/table.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/table_properties.h"
+#include "iceberg/table_scan.h"
+#include "iceberg/type.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief A partition of a partition spec.
+using PartitionKey = std::pair<int32_t, std::vector<Literal>>;
+
+/// \brief Orders partitions by spec ID and then tuple-wise with nulls first. Values
+/// that cannot be ordered, such as NaN, are considered equivalent.
+struct PartitionKeyLess {
+  bool operator()(const PartitionKey& lhs, const PartitionKey& rhs) const {
+    if (lhs.first != rhs.first) {
+      return lhs.first < rhs.first;
+    }
+    const auto size = std::min(lhs.second.size(), rhs.second.size());
+    for (size_t i = 0; i < size; ++i) {
+      const bool lhs_null = lhs.second[i].IsNull();
+      const bool rhs_null = rhs.second[i].IsNull();
+      if (lhs_null || rhs_null) {
+        if (lhs_null != rhs_null) {
+          return lhs_null;
+        }
+        continue;
+      }
+      if (auto cmp = lhs.second[i] <=> rhs.second[i];
+          cmp != std::partial_ordering::equivalent &&
+          cmp != std::partial_ordering::unordered) {
+        return cmp == std::partial_ordering::less;
+      }
+    }
+    return lhs.second.size() < rhs.second.size();
+  }
+};
+
+/// \brief Reads the rows of a task, with its deletes applied, and writes them.
+template <typename Writer>
+Status RewriteTask(const FileScanTask& task, const std::shared_ptr<FileIO>& io,
+                   const std::shared_ptr<Schema>& schema, Writer& writer) {
+  ICEBERG_ASSIGN_OR_RAISE(auto stream, task.ToArrow(io, schema, nullptr));
+  Status status;
+  while (status.has_value()) {
+    ArrowArray array;
+    if (int code = stream.get_next(&stream, &array); code != 0) {
+      const char* message = stream.get_last_error(&stream);
+      status = IOError("Cannot read the rows of {}: {}", task.data_file()->file_path,
+                       message != nullptr ? message : std::strerror(code));
+      break;
+    }
+    if (array.release == nullptr) {
+      break;
+    }
+    status = writer.Write(&array);
+  }
+  stream.release(&stream);
+  return status;
+}
+
+/// \brief Sets the summary counts of the delete files added or removed by a snapshot.
+void SetDeleteCounts(std::unordered_map<std::string, std::string>& summary,
+                     const std::vector<std::shared_ptr<DataFile>>& files, bool added) {
+  int64_t position_files = 0;
+  int64_t equality_files = 0;
+  int64_t position_deletes = 0;
+  int64_t equality_deletes = 0;
+  for (const auto& file : files) {
+    if (file->content == DataFile::Content::kEqualityDeletes) {
+      ++equality_files;
+      equality_deletes += file->record_count;
+    } else {
+      ++position_files;
+      position_deletes += file->record_count;
+    }
+  }
+  using Fields = SnapshotSummaryFields;
+  summary[added ? Fields::kAddedDeleteFiles : Fields::kRemovedDeleteFiles] =
+      std::to_string(files.size());
+  summary[added ? Fields::kAddedPosDeleteFiles : Fields::kRemovedPosDeleteFiles] =
+      std::to_string(position_files);
+  summary[added ? Fields::kAddedEqDeleteFiles : Fields::kRemovedEqDeleteFiles] =
+      std::to_string(equality_files);
+  summary[added ? Fields::kAddedPosDeletes : Fields::kRemovedPosDeletes] =
+      std::to_string(position_deletes);
+  summary[added ? Fields::kAddedEqDeletes : Fields::kRemovedEqDeletes] =
+      std::to_string(equality_deletes);
+}
+
+/// \brief A group of data files of a partition rewritten together.
+struct FileGroup {
+  int32_t spec_id;
+  std::vector<std::shared_ptr<FileScanTask>> tasks;
+  int64_t size_bytes = 0;
+  bool has_selected_deletes = false;
+};
+
+}  // namespace
+
+RewriteFiles::RewriteFiles(std::shared_ptr<Table> table)
+    : SnapshotProducer(std::move(table)) {}
+
+RewriteFiles::~RewriteFiles() = default;
+
+RewriteFiles& RewriteFiles::RemoveDataFile(std::shared_ptr<DataFile> file) {
+  if (file == nullptr) {
+    errors_.emplace_back(ErrorKind::kInvalidArgument, "Cannot remove null data file");
+    return *this;
+  }
+  if (file->content != DataFile::Content::kData) {
+    errors_.emplace_back(
+        ErrorKind::kInvalidArgument,
+        std::format("Cannot remove delete file {} as a data file", file->file_path));
+    return *this;
+  }
+  if (removed_paths_.insert(file->file_path).second) {
+    removed_files_.push_back(std::move(file));
+  }
+  return *this;
+}
+
+RewriteFiles& RewriteFiles::AddDataFile(std::shared_ptr<DataFile> file) {
+  if (file == nullptr) {
+    errors_.emplace_back(ErrorKind::kInvalidArgument, "Cannot add null data file");
+    return *this;
+  }
+  if (file->content != DataFile::Content::kData) {
+    errors_.emplace_back(
+        ErrorKind::kInvalidArgument,
+        std::format("Cannot add delete file {} as a data file", file->file_path));
+    return *this;
+  }
+  added_files_.push_back(std::move(file));
+  return *this;
+}
+
+RewriteFiles& RewriteFiles::RemoveDeleteFile(std::shared_ptr<DataFile> file) {
+  if (file == nullptr) {
+    errors_.emplace_back(ErrorKind::kInvalidArgument, "Cannot remove null delete file");
+    return *this;
+  }
+  if (file->content == DataFile::Content::kData) {
+    errors_.emplace_back(
+        ErrorKind::kInvalidArgument,
+        std::format("Cannot remove data file {} as a delete file", file->file_path));
+    return *this;
+  }
+  if (removed_paths_.insert(file->file_path).second) {
+    removed_delete_files_.push_back(std::move(file));
+  }
+  return *this;
+}
+
+RewriteFiles& RewriteFiles::AddDeleteFile(std::shared_ptr<DataFile> file) {
+  if (file == nullptr) {
+    errors_.emplace_back(ErrorKind::kInvalidArgument, "Cannot add null delete file");
+    return *this;
+  }
+  if (file->content == DataFile::Content::kData) {
+    errors_.emplace_back(
+        ErrorKind::kInvalidArgument,
+        std::format("Cannot add data file {} as a delete file", file->file_path));
+    return *this;
+  }
+  if (file->content == DataFile::Content::kPositionDeletes &&
+      file->referenced_data_file.has_value()) {
+    referenced_paths_.insert(file->referenced_data_file.value());
+  }
+  added_delete_files_.push_back(std::move(file));
+  return *this;
+}
+
+RewriteFiles& RewriteFiles::ValidateFromSnapshot(int64_t snapshot_id) {
+  starting_snapshot_id_ = snapshot_id;
+  return *this;
+}
+
+RewriteFiles& RewriteFiles::ValidateDataFilesExist(
+    const std::vector<std::string>& data_file_paths) {
+  referenced_paths_.insert(data_file_paths.begin(), data_file_paths.end());
+  return *this;
+}
+
+RewriteFiles& RewriteFiles::Set(const std::string& property, const std::string& value) {
+  properties_[property] = value;
+  return *this;
+}
+
+Status RewriteFiles::Commit() {
+  if (!errors_.empty()) {
+    return InvalidArgument("{}", errors_.front().message);
+  }
+  if (removed_files_.empty() && removed_delete_files_.empty()) {
+    return InvalidArgument("Cannot rewrite files of table {} without removed files",
+                           table()->name().name);
+  }
+  if (!added_delete_files_.empty() && table()->metadata()->format_version < 2) {
+    return InvalidArgument("Cannot add delete files to table {} of format version {}",
+                           table()->name().name, table()->metadata()->format_version);
+  }
+  return CommitSnapshot();
+}
+
+const std::string& RewriteFiles::operation() const { return DataOperation::kReplace; }
+
+Status RewriteFiles::ValidateNoNewDeletes(const TableMetadata& base,
+                                          const Snapshot& parent) const {
+  if (!starting_snapshot_id_.has_value() || removed_files_.empty()) {
+    return {};
+  }
+  std::set<PartitionKey, PartitionKeyLess> removed_partitions;
+  for (const auto& file : removed_files_) {
+    removed_partitions.emplace(file->partition_spec_id, file->partition);
+  }
+  return VisitConcurrentFiles(
+      base, &parent, starting_snapshot_id_, ManifestFile::Content::kDeletes,
+      /*conflict_detection_filter=*/nullptr,
+      [&](const DataFile& delete_file, int64_t snapshot_id) -> Status {
+        // Deletes of an unpartitioned spec apply to the files of all partitions.
+        const bool conflicts =
+            delete_file.referenced_data_file.has_value()
+                ? removed_paths_.contains(delete_file.referenced_data_file.value())
+                : delete_file.partition.empty() ||
+                      removed_partitions.contains(
+                          {delete_file.partition_spec_id, delete_file.partition});
+        if (conflicts) {
+          return ValidationFailed(
+              "Cannot commit, snapshot {} added delete file {} that may apply to a "
+              "rewritten data file",
+              snapshot_id, delete_file.file_path);
+        }
+        return {};
+      });
+}
+
+Result<ManifestFile> RewriteFiles::RewriteManifest(const TableMetadata& base,
+                                                   const ManifestFile& manifest,
+                                                   size_t& removed_count) {
+  if (auto it = rewritten_.find(manifest.manifest_path); it != rewritten_.end()) {
+    removed_count += it->second.second;
+    return it->second.first;
+  }
+
+  // Only the paths are read to find the manifests that track a removed file.
+  bool has_removed = false;
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto path_reader,
+      ManifestReader::Make(manifest, table()->io(), /*partition_schema=*/nullptr,
+                           {.columns = {std::string(DataFile::kFilePath.name())}}));
+  ICEBERG_RETURN_UNEXPECTED(
+      path_reader->VisitBatches([&](const ManifestEntryBatch& batch) -> Status {
+        for (int64_t row = 0; row < batch.size() && !has_removed; ++row) {
+          has_removed = batch.status(row) != ManifestStatus::kDeleted &&
+                        removed_paths_.contains(batch.file_path(row));
+        }
+        return {};
+      }));
+  if (!has_removed) {
+    return manifest;
+  }
+
+  ICEBERG_ASSIGN_OR_RAISE(auto spec, base.PartitionSpecById(manifest.partition_spec_id));
+  ICEBERG_ASSIGN_OR_RAISE(auto partition_schema, spec->PartitionSchema());
+  ICEBERG_ASSIGN_OR_RAISE(auto writer, NewManifestWriter(base, std::move(spec)));
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto reader, ManifestReader::Make(manifest, table()->io(), partition_schema));
+  size_t count = 0;
+  ICEBERG_RETURN_UNEXPECTED(reader->VisitEntries([&](ManifestEntry&& entry) -> Status {
+    if (entry.status == ManifestStatus::kDeleted) {
+      // Deletes of older snapshots are only tracked by the manifests of those
+      // snapshots.
+      return {};
+    }
+    if (removed_paths_.contains(entry.data_file->file_path)) {
+      entry.status = ManifestStatus::kDeleted;
+      entry.snapshot_id = snapshot_id();
+      ++count;
+    } else {
+      entry.status = ManifestStatus::kExisting;
+    }
+    return writer->Add(entry);
+  }));
+  ICEBERG_RETURN_UNEXPECTED(writer->Close());
+  ICEBERG_ASSIGN_OR_RAISE(auto rewritten, writer->ToManifestFile());
+  rewritten_.emplace(manifest.manifest_path, std::make_pair(rewritten, count));
+  removed_count += count;
+  return rewritten;
+}
+
+Result<std::vector<ManifestFile>> RewriteFiles::Apply(const TableMetadata& base,
+                                                      const Snapshot* parent) {
+  if (parent == nullptr) {
+    return ValidationFailed("Cannot commit, table {} has no current snapshot",
+                            table()->name().name);
+  }
+  ICEBERG_RETURN_UNEXPECTED(ValidateNoNewDeletes(base, *parent));
+  ICEBERG_RETURN_UNEXPECTED(SnapshotProducer::ValidateDataFilesExist(
+      base, parent, starting_snapshot_id_, referenced_paths_));
+
+  if (new_manifests_.empty()) {
+    // The data manifests are written first, so that they are also listed first.
+    for (const auto* added : {&added_files_, &added_delete_files_}) {
+      std::map<int32_t, std::vector<std::shared_ptr<DataFile>>> files_by_spec;
+      for (const auto& file : *added) {
+        files_by_spec[file->partition_spec_id].push_back(file);
+      }
+      for (const auto& [spec_id, files] : files_by_spec) {
+        ICEBERG_ASSIGN_OR_RAISE(auto manifests,
+                                WriteAddedManifests(base, spec_id, files));
+        new_manifests_.insert(new_manifests_.end(),
+                              std::make_move_iterator(manifests.begin()),
+                              std::make_move_iterator(manifests.end()));
+      }
+    }
+  }
+
+  std::unordered_set<int32_t> removed_spec_ids;
+  for (const auto& file : removed_files_) {
+    removed_spec_ids.insert(file->partition_spec_id);
+  }
+  std::unordered_set<int32_t> removed_delete_spec_ids;
+  for (const auto& file : removed_delete_files_) {
+    removed_delete_spec_ids.insert(file->partition_spec_id);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto reader, ManifestListReader::Make(parent->manifest_list, table()->io()));
+  ICEBERG_ASSIGN_OR_RAISE(auto existing, reader->Files());
+  std::vector<ManifestFile> manifests = new_manifests_;
+  size_t removed_count = 0;
+  for (const auto& manifest : existing) {
+    const auto& spec_ids = manifest.content == ManifestFile::Content::kData
+                               ? removed_spec_ids
+                               : removed_delete_spec_ids;
+    if (!spec_ids.contains(manifest.partition_spec_id) ||
+        !(manifest.has_added_files() || manifest.has_existing_files())) {
+      manifests.push_back(manifest);
+      continue;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto rewritten,
+                            RewriteManifest(base, manifest, removed_count));
+    manifests.push_back(std::move(rewritten));
+  }
+  const size_t removed_files_count = removed_files_.size() + removed_delete_files_.size();
+  if (removed_count != removed_files_count) {
+    return ValidationFailed(
+        "Cannot commit, {} of the {} rewritten files are no longer in table {}",
+        removed_files_count - removed_count, removed_files_count, table()->name().name);
+  }
+  return manifests;
+}
+
+std::unordered_map<std::string, std::string> RewriteFiles::Summary() const {
+  int64_t added_records = 0;
+  int64_t added_size = 0;
+  for (const auto& file : added_files_) {
+    added_records += file->record_count;
+    added_size += file->file_size_in_bytes;
+  }
+  int64_t deleted_records = 0;
+  int64_t removed_size = 0;
+  for (const auto& file : removed_files_) {
+    deleted_records += file->record_count;
+    removed_size += file->file_size_in_bytes;
+  }
+  for (const auto& file : added_delete_files_) {
+    added_size += file->file_size_in_bytes;
+  }
+  for (const auto& file : removed_delete_files_) {
+    removed_size += file->file_size_in_bytes;
+  }
+
+  auto summary = properties_;
+  summary[SnapshotSummaryFields::kAddedDataFiles] = std::to_string(added_files_.size());
+  summary[SnapshotSummaryFields::kAddedRecords] = std::to_string(added_records);
+  summary[SnapshotSummaryFields::kAddedFileSize] = std::to_string(added_size);
+  summary[SnapshotSummaryFields::kDeletedDataFiles] =
+      std::to_string(removed_files_.size());
+  summary[SnapshotSummaryFields::kDeletedRecords] = std::to_string(deleted_records);
+  summary[SnapshotSummaryFields::kRemovedFileSize] = std::to_string(removed_size);
+  if (!added_delete_files_.empty() || !removed_delete_files_.empty()) {
+    SetDeleteCounts(summary, added_delete_files_, /*added=*/true);
+    SetDeleteCounts(summary, removed_delete_files_, /*added=*/false);
+  }
+  return summary;
+}
+
+void RewriteFiles::CleanUncommitted(const std::unordered_set<std::string>& committed) {
+  for (const auto& manifest : new_manifests_) {
+    if (!committed.contains(manifest.manifest_path)) {
+      DeleteFile(manifest.manifest_path);
+    }
+  }
+  if (committed.empty()) {
+    new_manifests_.clear();
+  }
+  for (auto it = rewritten_.begin(); it != rewritten_.end();) {
+    if (!committed.contains(it->second.first.manifest_path)) {
+      DeleteFile(it->second.first.manifest_path);
+      it = rewritten_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+RewriteDataFiles::RewriteDataFiles(std::shared_ptr<Table> table)
+    : table_(std::move(table)) {}
+
+RewriteDataFiles::~RewriteDataFiles() = default;
+
+RewriteDataFiles& RewriteDataFiles::Filter(std::shared_ptr<Expression> filter) {
+  filter_ = std::move(filter);
+  return *this;
+}
+
+RewriteDataFiles& RewriteDataFiles::TargetFileSize(int64_t bytes) {
+  target_file_size_ = bytes;
+  return *this;
+}
+
+RewriteDataFiles& RewriteDataFiles::MinFileSize(int64_t bytes) {
+  min_file_size_ = bytes;
+  return *this;
+}
+
+RewriteDataFiles& RewriteDataFiles::DeleteFileThreshold(int32_t count) {
+  delete_file_threshold_ = count;
+  return *this;
+}
+
+RewriteDataFiles& RewriteDataFiles::MinInputFiles(int32_t count) {
+  min_input_files_ = count;
+  return *this;
+}
+
+RewriteDataFiles& RewriteDataFiles::MaxFileGroupSize(int64_t bytes) {
+  max_file_group_size_ = bytes;
+  return *this;
+}
+
+RewriteDataFiles& RewriteDataFiles::WithParallelism(int32_t parallelism) {
+  parallelism_ = parallelism;
+  return *this;
+}
+
+RewriteDataFiles& RewriteDataFiles::WithExecutor(std::shared_ptr<Executor> executor) {
+  executor_ = std::move(executor);
+  return *this;
+}
+
+RewriteDataFiles& RewriteDataFiles::MaxMemory(int64_t bytes) {
+  max_memory_ = bytes;
+  return *this;
+}
+
+RewriteDataFiles& RewriteDataFiles::Sort(std::shared_ptr<SortOrder> sort_order) {
+  strategy_ = Strategy::kSort;
+  sort_order_ = std::move(sort_order);
+  return *this;
+}
+
+RewriteDataFiles& RewriteDataFiles::ZOrder(std::vector<std::string> column_names) {
+  strategy_ = Strategy::kZOrder;
+  zorder_columns_ = std::move(column_names);
+  return *this;
+}
+
+RewriteDataFiles& RewriteDataFiles::RewriteAll(bool rewrite_all) {
+  rewrite_all_ = rewrite_all;
+  return *this;
+}
+
+RewriteDataFiles& RewriteDataFiles::WithLocationProvider(
+    std::shared_ptr<LocationProvider> provider) {
+  location_provider_ = std::move(provider);
+  return *this;
+}
+
+Result<RewriteDataFilesResult> RewriteDataFiles::Execute() const {
+  if (parallelism_ < 1) {
+    return InvalidArgument("Parallelism must be positive, got {}", parallelism_);
+  }
+  if (min_input_files_ < 1) {
+    return InvalidArgument("Minimum number of input files must be positive, got {}",
+                           min_input_files_);
+  }
+  if (max_file_group_size_ <= 0 || max_memory_ <= 0) {
+    return InvalidArgument("Maximum file group size and memory must be positive");
+  }
+
+  const auto metadata = table_->metadata();
+  const auto& io = table_->io();
+  const auto& properties = table_->properties();
+  const int64_t target_file_size = target_file_size_.value_or(
+      properties.Get(TableProperties::kWriteTargetFileSizeBytes));
+  if (target_file_size <= 0) {
+    return InvalidArgument("Target file size must be positive, got {}", target_file_size);
+  }
+  const int64_t min_file_size = min_file_size_.value_or(target_file_size / 4 * 3);
+  const auto executor = executor_ != nullptr ? executor_ : DefaultExecutor();
+
+  RewriteDataFilesResult result;
+  if (metadata->current_snapshot_id == Snapshot::kInvalidSnapshotId) {
+    return result;
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto snapshot, metadata->Snapshot());
+  ICEBERG_ASSIGN_OR_RAISE(auto schema, metadata->Schema());
+
+  // Resolve the order of the rows of the sort and Z-order strategies.
+  std::shared_ptr<SortOrder> sort_order;
+  std::vector<int32_t> zorder_field_ids;
+  if (strategy_ == Strategy::kSort) {
+    sort_order = sort_order_;
+    if (sort_order == nullptr) {
+      ICEBERG_ASSIGN_OR_RAISE(sort_order, metadata->SortOrder());
+    }
+    if (sort_order->fields().empty()) {
+      return InvalidArgument("Cannot sort the rewritten files by an unsorted order");
+    }
+  } else if (strategy_ == Strategy::kZOrder) {
+    if (zorder_columns_.empty()) {
+      return InvalidArgument("Cannot Z-order the rewritten files by no columns");
+    }
+    for (const auto& name : zorder_columns_) {
+      ICEBERG_ASSIGN_OR_RAISE(auto field, schema->FindFieldByName(name));
+      if (!field.has_value()) {
+        return InvalidArgument("Cannot find Z-order column {}", name);
+      }
+      if (!field->get().type()->is_primitive()) {
+        return InvalidArgument("Cannot Z-order by non-primitive column {}", name);
+      }
+      zorder_field_ids.push_back(field->get().field_id());
+    }
+    sort_order = SortOrder::Unsorted();
+  }
+
+  // Select the small files and the files with many deletes, by partition.
+  TableScanBuilder builder(metadata, io);
+  builder.WithSnapshotId(snapshot->snapshot_id).WithExecutor(executor);
+  if (filter_ != nullptr) {
+    builder.WithFilter(filter_);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto scan, builder.Build());
+  std::map<PartitionKey, std::vector<std::shared_ptr<FileScanTask>>, PartitionKeyLess>
+      selected;
+  auto has_many_deletes = [&](const FileScanTask& task) {
+    return task.delete_files().size() >= static_cast<size_t>(delete_file_threshold_);
+  };
+  ICEBERG_RETURN_UNEXPECTED(
+      scan->PlanFiles([&](std::shared_ptr<FileScanTask> task) -> Status {
+        const auto& file = *task->data_file();
+        if (rewrite_all_ || file.file_size_in_bytes < min_file_size ||
+            has_many_deletes(*task)) {
+          selected[{file.partition_spec_id, file.partition}].push_back(std::move(task));
+        }
+        return {};
+      }));
+
+  // Bin-pack the selected files of each partition, first fit by decreasing size.
+  std::vector<FileGroup> groups;
+  for (auto& [partition, tasks] : selected) {
+    std::ranges::sort(tasks, std::greater{}, [](const auto& task) {
+      return task->data_file()->file_size_in_bytes;
+    });
+    std::vector<FileGroup> bins;
+    for (auto& task : tasks) {
+      const int64_t size = task->data_file()->file_size_in_bytes;
+      auto bin = std::ranges::find_if(bins, [&](const FileGroup& group) {
+        return group.size_bytes + size <= max_file_group_size_;
+      });
+      if (bin == bins.end()) {
+        bin = bins.insert(bins.end(), FileGroup{.spec_id = partition.first});
+      }
+      bin->size_bytes += size;
+      bin->has_selected_deletes |= has_many_deletes(*task);
+      bin->tasks.push_back(std::move(task));
+    }
+    for (auto& bin : bins) {
+      const bool enough_files =
+          bin.tasks.size() > 1 &&
+          (bin.tasks.size() >= static_cast<size_t>(min_input_files_) ||
+           bin.size_bytes > target_file_size);
+      if (rewrite_all_ || enough_files || bin.has_selected_deletes) {
+        groups.push_back(std::move(bin));
+      }
+    }
+  }
+  if (groups.empty()) {
+    return result;
+  }
+
+  auto data_location = properties.Get(TableProperties::kWriteDataLocation);
+  if (data_location.empty()) {
+    data_location = metadata->location + "/data";
+  }
+  std::shared_ptr<LocationProvider> location_provider = location_provider_;
+  if (location_provider == nullptr) {
+    location_provider = LocationProvider::Make(metadata->location, properties);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto format,
+      FileFormatTypeFromString(properties.Get(TableProperties::kDefaultFileFormat)));
+
+  // Rewrite the groups, each one buffering its share of the memory budget.
+  std::vector<std::vector<DataFile>> new_files(groups.size());
+  auto rewrite_group = [&](size_t index) -> Status {
+    const auto& group = groups[index];
+    ICEBERG_ASSIGN_OR_RAISE(auto spec, metadata->PartitionSpecById(group.spec_id));
+    const int64_t group_memory = std::max<int64_t>(max_memory_ / parallelism_, 1);
+    PartitionedWriterOptions options{
+        .schema = schema,
+        .spec = std::move(spec),
+        .format = format,
+        .io = io,
+        .location_provider = location_provider,
+        .properties = metadata->properties,
+        .target_file_size_bytes = target_file_size,
+        .max_open_bytes = group_memory,
+    };
+    auto rewrite = [&](auto& writer) -> Status {
+      for (const auto& task : group.tasks) {
+        ICEBERG_RETURN_UNEXPECTED(RewriteTask(*task, io, schema, writer));
+      }
+      ICEBERG_ASSIGN_OR_RAISE(new_files[index], writer.Close());
+      return {};
+    };
+    if (strategy_ == Strategy::kBinPack) {
+      ICEBERG_ASSIGN_OR_RAISE(auto writer, FanoutDataWriter::Make(std::move(options)));
+      return rewrite(*writer);
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto writer,
+                            SortedDataWriter::Make(std::move(options),
+                                                   SortOptions{
+                                                       .sort_order = sort_order,
+                                                       .buffer_bytes = group_memory,
+                                                       .spill_location = data_location,
+                                                       .zorder_field_ids =
+                                                           zorder_field_ids,
+                                                   }));
+    return rewrite(*writer);
+  };
+  auto delete_new_files = [&]() {
+    std::vector<std::string> paths;
+    for (const auto& files : new_files) {
+      for (const auto& file : files) {
+        paths.push_back(file.file_path);
+      }
+    }
+    if (!paths.empty()) {
+      std::ignore = io->DeleteFiles(paths);
+    }
+  };
+  if (auto status = RunInParallel(*executor, groups.size(), parallelism_, rewrite_group);
+      !status.has_value()) {
+    delete_new_files();
+    return std::unexpected(status.error());
+  }
+
+  RewriteFiles rewrite(table_);
+  rewrite.ValidateFromSnapshot(snapshot->snapshot_id);
+  for (const auto& group : groups) {
+    for (const auto& task : group.tasks) {
+      rewrite.RemoveDataFile(task->data_file());
+      result.rewritten_bytes_count += task->data_file()->file_size_in_bytes;
+    }
+    result.rewritten_data_files_count += static_cast<int64_t>(group.tasks.size());
+  }
+  for (auto& files : new_files) {
+    for (auto& file : files) {
+      rewrite.AddDataFile(std::make_shared<DataFile>(file));
+      ++result.added_data_files_count;
+    }
+  }
+  if (auto status = rewrite.Commit(); !status.has_value()) {
+    if (status.error().kind != ErrorKind::kCommitStateUnknown) {
+      delete_new_files();
+    }
+    return std::unexpected(status.error());
+  }
+  result.rewritten_file_groups_count = static_cast<int32_t>(groups.size());
+  result.snapshot_id = rewrite.snapshot_id();
+  return result;
+}
+
+}  // namespace iceberg
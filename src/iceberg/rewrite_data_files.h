@@ -0,0 +1,260 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/rewrite_data_files.h
+/// Compaction of the small data files of a table into files of the target size.
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/result.h"
+#include "iceberg/snapshot_producer.h"
+#include "iceberg/type_fwd.h"
+#include "iceberg/util/string_util.h"
+
+namespace iceberg {
+
+/// \brief Replaces data and delete files of a table with new files holding the same rows
+/// and deletes.
+///
+/// The new snapshot has the `replace` operation. The manifests of the current snapshot
+/// that track a removed file are rewritten with its entry marked as deleted, and the
+/// new data and delete files are added to new data and delete manifests.
+///
+/// The commit fails with ErrorKind::kValidationFailed if a removed file is no longer in
+/// the table, if a snapshot committed after the one set with ValidateFromSnapshot()
+/// added delete files that may apply to a removed data file: the new files inherit the
+/// sequence number of the new snapshot, so those deletes would not apply to their rows,
+/// or if such a snapshot removed a data file referenced by a new position delete file
+/// or passed to ValidateDataFilesExist().
+class ICEBERG_EXPORT RewriteFiles : public SnapshotProducer {
+ public:
+  /// \brief Creates a rewrite of the data files of a table.
+  ///
+  /// \param table The table to rewrite, which must have a catalog to commit to
+  explicit RewriteFiles(std::shared_ptr<Table> table);
+
+  ~RewriteFiles() override;
+
+  /// \brief Removes a data file of the current snapshot.
+  RewriteFiles& RemoveDataFile(std::shared_ptr<DataFile> file);
+
+  /// \brief Adds a data file holding rows of the removed files.
+  RewriteFiles& AddDataFile(std::shared_ptr<DataFile> file);
+
+  /// \brief Removes a position or equality delete file of the current snapshot.
+  RewriteFiles& RemoveDeleteFile(std::shared_ptr<DataFile> file);
+
+  /// \brief Adds a position or equality delete file holding deletes of the removed
+  /// delete files. Delete files require table format version 2.
+  RewriteFiles& AddDeleteFile(std::shared_ptr<DataFile> file);
+
+  /// \brief Sets the snapshot the removed files were read from, which must be an
+  /// ancestor of the snapshot the rewrite is committed on top of.
+  RewriteFiles& ValidateFromSnapshot(int64_t snapshot_id);
+
+  /// \brief Fails the commit if a snapshot committed after the starting snapshot
+  /// removed one of the data files, like the data files of the added position deletes.
+  RewriteFiles& ValidateDataFilesExist(const std::vector<std::string>& data_file_paths);
+
+  /// \brief Sets a summary property of the new snapshot.
+  RewriteFiles& Set(const std::string& property, const std::string& value);
+
+  /// \brief Validates the rewrite against the current snapshot and commits it.
+  Status Commit();
+
+ protected:
+  const std::string& operation() const override;
+
+  Result<std::vector<ManifestFile>> Apply(const TableMetadata& base,
+                                          const Snapshot* parent) override;
+
+  std::unordered_map<std::string, std::string> Summary() const override;
+
+  void CleanUncommitted(const std::unordered_set<std::string>& committed) override;
+
+ private:
+  /// \brief Fails if a snapshot after the starting snapshot added delete files that
+  /// may apply to the removed files.
+  Status ValidateNoNewDeletes(const TableMetadata& base, const Snapshot& parent) const;
+
+  /// \brief Returns the manifest replacing `manifest`, or `manifest` itself if it does
+  /// not track a removed file.
+  Result<ManifestFile> RewriteManifest(const TableMetadata& base,
+                                       const ManifestFile& manifest,
+                                       size_t& removed_count);
+
+  std::vector<Error> errors_;
+  std::vector<std::shared_ptr<DataFile>> removed_files_;
+  std::unordered_set<std::string, StringHash, std::equal_to<>> removed_paths_;
+  std::vector<std::shared_ptr<DataFile>> added_files_;
+  std::vector<std::shared_ptr<DataFile>> removed_delete_files_;
+  std::vector<std::shared_ptr<DataFile>> added_delete_files_;
+  // Data files that must still be in the table, including the ones referenced by the
+  // added position delete files
+  std::unordered_set<std::string, StringHash, std::equal_to<>> referenced_paths_;
+  std::optional<int64_t> starting_snapshot_id_;
+  std::unordered_map<std::string, std::string> properties_;
+  std::vector<ManifestFile> new_manifests_;
+  // Rewritten manifests and their number of removed files by the paths of the
+  // manifests they replace, reused by the retries of the commit
+  std::unordered_map<std::string, std::pair<ManifestFile, size_t>> rewritten_;
+};
+
+/// \brief The outcome of a data file compaction.
+struct ICEBERG_EXPORT RewriteDataFilesResult {
+  /// \brief The number of rewritten groups of files.
+  int32_t rewritten_file_groups_count = 0;
+  /// \brief The number of data files that were replaced.
+  int64_t rewritten_data_files_count = 0;
+  /// \brief The number of data files that were written.
+  int64_t added_data_files_count = 0;
+  /// \brief The total size of the replaced data files.
+  int64_t rewritten_bytes_count = 0;
+  /// \brief The ID of the committed snapshot, if any group was rewritten.
+  std::optional<int64_t> snapshot_id;
+};
+
+/// \brief Compacts the data files of a table with a bin-pack, sort or Z-order strategy.
+///
+/// The data files of the current snapshot that match the filter are planned with their
+/// delete files, and the files smaller than the minimum file size or with at least
+/// `DeleteFileThreshold()` delete files are selected, or all of them with RewriteAll().
+/// The selected files of each partition are bin-packed into groups of at most the
+/// maximum group size, and a group is rewritten when it has at least `MinInputFiles()`
+/// files, holds more than a target file of data, or has files selected for their
+/// deletes.
+///
+/// Up to `parallelism` groups are rewritten concurrently. The rows of a group are read
+/// with FileScanTask::ToArrow, which applies the delete files, and written in the
+/// partition spec of the group by a FanoutDataWriter that rolls files at the target
+/// size. With the sort and Z-order strategies, the rows of a group are written by a
+/// SortedDataWriter instead, ordered by a sort order or by the Z-order key of several
+/// columns, and spilled to the data location when they exceed the memory of the group.
+/// Each group may buffer `MaxMemory() / parallelism` bytes of rows, so the memory of
+/// the compaction is bounded whatever the size of the groups. All groups are then
+/// committed as a single RewriteFiles validated from the planned snapshot, and the new
+/// files are deleted if the commit fails.
+class ICEBERG_EXPORT RewriteDataFiles {
+ public:
+  /// \brief The default minimum number of files of a group to rewrite.
+  static constexpr int32_t kDefaultMinInputFiles = 5;
+  /// \brief The default number of delete files selecting a file, so that files are
+  /// only selected for their size.
+  static constexpr int32_t kDefaultDeleteFileThreshold =
+      std::numeric_limits<int32_t>::max();
+  /// \brief The default maximum size of the data files of a group.
+  static constexpr int64_t kDefaultMaxFileGroupSizeBytes = int64_t{100} << 30;  // 100 GB
+  /// \brief The default memory budget of the rows buffered by the writers.
+  static constexpr int64_t kDefaultMaxMemoryBytes = int64_t{1} << 30;  // 1 GB
+
+  /// \brief Creates a compaction of the data files of a table.
+  ///
+  /// \param table The table to compact, which must have a catalog to commit to
+  explicit RewriteDataFiles(std::shared_ptr<Table> table);
+
+  ~RewriteDataFiles();
+
+  /// \brief Only rewrites the data files that may contain rows matching a filter.
+  RewriteDataFiles& Filter(std::shared_ptr<Expression> filter);
+
+  /// \brief Sets the size of the new files, `write.target-file-size-bytes` by default.
+  RewriteDataFiles& TargetFileSize(int64_t bytes);
+
+  /// \brief Sets the size under which files are selected, 75% of the target file size
+  /// by default.
+  RewriteDataFiles& MinFileSize(int64_t bytes);
+
+  /// \brief Sets the number of delete files from which files are selected whatever
+  /// their size.
+  RewriteDataFiles& DeleteFileThreshold(int32_t count);
+
+  /// \brief Sets the minimum number of files of a group to rewrite.
+  RewriteDataFiles& MinInputFiles(int32_t count);
+
+  /// \brief Sets the maximum size of the data files of a group.
+  RewriteDataFiles& MaxFileGroupSize(int64_t bytes);
+
+  /// \brief Sets the number of groups rewritten concurrently, 1 by default.
+  RewriteDataFiles& WithParallelism(int32_t parallelism);
+
+  /// \brief Sets the executor rewriting the groups concurrently, the DefaultExecutor()
+  /// if null.
+  RewriteDataFiles& WithExecutor(std::shared_ptr<Executor> executor);
+
+  /// \brief Sets the memory budget of the rows buffered by the writers of all groups.
+  RewriteDataFiles& MaxMemory(int64_t bytes);
+
+  /// \brief Rewrites the groups with their rows sorted by a sort order, the sort order
+  /// of the table if null.
+  RewriteDataFiles& Sort(std::shared_ptr<SortOrder> sort_order = nullptr);
+
+  /// \brief Rewrites the groups with their rows ordered by the Z-order key of columns.
+  ///
+  /// \param column_names The names of the columns, which must be primitive
+  RewriteDataFiles& ZOrder(std::vector<std::string> column_names);
+
+  /// \brief Sets whether to select all files of the matching partitions and rewrite
+  /// every group whatever its size, false by default.
+  RewriteDataFiles& RewriteAll(bool rewrite_all);
+
+  /// \brief Sets the provider of the locations of the new files, which are written to
+  /// `write.data.path`, or the `data` directory of the table, by default.
+  RewriteDataFiles& WithLocationProvider(std::shared_ptr<LocationProvider> provider);
+
+  /// \brief Rewrites the selected groups of files and commits the new files.
+  Result<RewriteDataFilesResult> Execute() const;
+
+ private:
+  enum class Strategy {
+    kBinPack,
+    kSort,
+    kZOrder,
+  };
+
+  std::shared_ptr<Table> table_;
+  std::shared_ptr<Expression> filter_;
+  Strategy strategy_ = Strategy::kBinPack;
+  std::shared_ptr<SortOrder> sort_order_;
+  std::vector<std::string> zorder_columns_;
+  bool rewrite_all_ = false;
+  std::optional<int64_t> target_file_size_;
+  std::optional<int64_t> min_file_size_;
+  int32_t delete_file_threshold_ = kDefaultDeleteFileThreshold;
+  int32_t min_input_files_ = kDefaultMinInputFiles;
+  int64_t max_file_group_size_ = kDefaultMaxFileGroupSizeBytes;
+  int32_t parallelism_ = 1;
+  std::shared_ptr<Executor> executor_;
+  int64_t max_memory_ = kDefaultMaxMemoryBytes;
+  std::shared_ptr<LocationProvider> location_provider_;
+};
+
+}  // namespace iceberg
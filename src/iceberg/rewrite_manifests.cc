@@ -0,0 +1,280 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/rewrite_manifests.h"
+
+#include <algorithm>
+#include <compare>
+#include <iterator>
+#include <utility>
+
+#include "iceberg/executor.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_reader.h"
+#include "iceberg/manifest_writer.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/table_properties.h"
+#include "iceberg/type.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief Orders cluster keys tuple-wise with nulls first. Values that cannot be
+/// ordered, such as NaN, are considered equivalent.
+bool ClusterKeyLess(const std::vector<Literal>& lhs, const std::vector<Literal>& rhs) {
+  const auto size = std::min(lhs.size(), rhs.size());
+  for (size_t i = 0; i < size; ++i) {
+    const bool lhs_null = lhs[i].IsNull();
+    const bool rhs_null = rhs[i].IsNull();
+    if (lhs_null || rhs_null) {
+      if (lhs_null != rhs_null) {
+        return lhs_null;
+      }
+      continue;
+    }
+    if (auto cmp = lhs[i] <=> rhs[i]; cmp != std::partial_ordering::equivalent &&
+                                      cmp != std::partial_ordering::unordered) {
+      return cmp == std::partial_ordering::less;
+    }
+  }
+  return lhs.size() < rhs.size();
+}
+
+struct ClusteredEntry {
+  std::vector<Literal> key;
+  ManifestEntry entry;
+};
+
+}  // namespace
+
+RewriteManifests::RewriteManifests(std::shared_ptr<Table> table)
+    : SnapshotProducer(std::move(table)) {}
+
+RewriteManifests::~RewriteManifests() = default;
+
+RewriteManifests& RewriteManifests::ClusterBy(ClusterFunction cluster_by) {
+  cluster_by_ = std::move(cluster_by);
+  return *this;
+}
+
+RewriteManifests& RewriteManifests::RewriteIf(
+    std::function<bool(const ManifestFile&)> predicate) {
+  predicate_ = std::move(predicate);
+  return *this;
+}
+
+RewriteManifests& RewriteManifests::WithParallelism(int32_t parallelism) {
+  parallelism_ = parallelism;
+  return *this;
+}
+
+RewriteManifests& RewriteManifests::WithExecutor(std::shared_ptr<Executor> executor) {
+  executor_ = std::move(executor);
+  return *this;
+}
+
+RewriteManifests& RewriteManifests::Set(const std::string& property,
+                                        const std::string& value) {
+  properties_[property] = value;
+  return *this;
+}
+
+Status RewriteManifests::Commit() {
+  if (parallelism_ < 1) {
+    return InvalidArgument("Parallelism must be positive, got {}", parallelism_);
+  }
+  return CommitSnapshot();
+}
+
+const std::string& RewriteManifests::operation() const {
+  return DataOperation::kReplace;
+}
+
+Result<std::vector<ManifestFile>> RewriteManifests::Apply(const TableMetadata& base,
+                                                          const Snapshot* parent) {
+  created_manifests_count_ = 0;
+  kept_manifests_count_ = 0;
+  replaced_manifests_count_ = 0;
+  processed_entries_count_ = 0;
+  if (parent == nullptr) {
+    return std::vector<ManifestFile>{};
+  }
+
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto reader, ManifestListReader::Make(parent->manifest_list, table()->io()));
+  ICEBERG_ASSIGN_OR_RAISE(auto manifests, reader->Files());
+
+  // Delete manifests are kept as they are, the rewritten manifests are grouped by spec.
+  std::map<int32_t, std::vector<ManifestFile>> groups;
+  std::vector<ManifestFile> kept;
+  for (auto& manifest : manifests) {
+    if (manifest.content != ManifestFile::Content::kData ||
+        (predicate_ && !predicate_(manifest))) {
+      kept.push_back(std::move(manifest));
+    } else {
+      groups[manifest.partition_spec_id].push_back(std::move(manifest));
+    }
+  }
+
+  std::vector<ManifestFile> new_manifests;
+  for (const auto& [spec_id, group] : groups) {
+    std::vector<std::string> key;
+    key.reserve(group.size());
+    for (const auto& manifest : group) {
+      key.push_back(manifest.manifest_path);
+    }
+    auto it = rewritten_.find(key);
+    if (it == rewritten_.end()) {
+      ICEBERG_ASSIGN_OR_RAISE(auto rewritten, RewriteGroup(base, spec_id, group));
+      it = rewritten_.emplace(std::move(key), std::move(rewritten)).first;
+    }
+    replaced_manifests_count_ += static_cast<int32_t>(group.size());
+    created_manifests_count_ += static_cast<int32_t>(it->second.manifests.size());
+    processed_entries_count_ += it->second.entries_count;
+    new_manifests.insert(new_manifests.end(), it->second.manifests.begin(),
+                         it->second.manifests.end());
+  }
+  kept_manifests_count_ = static_cast<int32_t>(kept.size());
+  new_manifests.insert(new_manifests.end(), std::make_move_iterator(kept.begin()),
+                       std::make_move_iterator(kept.end()));
+  return new_manifests;
+}
+
+Result<RewriteManifests::RewrittenGroup> RewriteManifests::RewriteGroup(
+    const TableMetadata& base, int32_t spec_id, const std::vector<ManifestFile>& group) {
+  ICEBERG_ASSIGN_OR_RAISE(auto spec, base.PartitionSpecById(spec_id));
+  ICEBERG_ASSIGN_OR_RAISE(auto partition_schema, spec->PartitionSchema());
+  const auto executor = executor_ != nullptr ? executor_ : DefaultExecutor();
+
+  // Read the live entries of each manifest, keyed by their cluster.
+  std::vector<std::vector<ClusteredEntry>> manifest_entries(group.size());
+  auto read = [&](size_t index) -> Status {
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto reader, ManifestReader::Make(group[index], table()->io(), partition_schema));
+    auto& entries = manifest_entries[index];
+    return reader->VisitEntries([&](ManifestEntry&& entry) -> Status {
+      if (entry.status == ManifestStatus::kDeleted) {
+        return {};
+      }
+      entry.status = ManifestStatus::kExisting;
+      auto key = cluster_by_ ? cluster_by_(*entry.data_file) : entry.data_file->partition;
+      entries.push_back(ClusteredEntry{.key = std::move(key), .entry = std::move(entry)});
+      return {};
+    });
+  };
+  ICEBERG_RETURN_UNEXPECTED(RunInParallel(*executor, group.size(), parallelism_, read));
+
+  int64_t group_length = 0;
+  std::vector<ClusteredEntry> entries;
+  for (size_t i = 0; i < group.size(); ++i) {
+    group_length += group[i].manifest_length;
+    entries.insert(entries.end(), std::make_move_iterator(manifest_entries[i].begin()),
+                   std::make_move_iterator(manifest_entries[i].end()));
+  }
+  manifest_entries.clear();
+  std::ranges::stable_sort(entries, ClusterKeyLess, &ClusteredEntry::key);
+
+  // Size the new manifests from the average size of the entries in the rewritten
+  // manifests, and only start a new manifest at a cluster boundary unless the cluster
+  // is larger than a manifest on its own.
+  const int64_t target_size_bytes =
+      table()->properties().Get(TableProperties::kManifestTargetSizeBytes);
+  const auto entries_count = static_cast<int64_t>(entries.size());
+  const int64_t entry_size = std::max<int64_t>(
+      entries_count > 0 ? group_length / entries_count : group_length, 1);
+  const auto entries_per_manifest =
+      static_cast<size_t>(std::max<int64_t>(target_size_bytes / entry_size, 1));
+  std::vector<std::pair<size_t, size_t>> ranges;
+  size_t begin = 0;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    if (i - begin >= entries_per_manifest &&
+        (ClusterKeyLess(entries[i - 1].key, entries[i].key) ||
+         !ClusterKeyLess(entries[begin].key, entries[i].key))) {
+      ranges.emplace_back(begin, i);
+      begin = i;
+    }
+  }
+  if (begin < entries.size()) {
+    ranges.emplace_back(begin, entries.size());
+  }
+
+  // Writers are created up front, as the names of the new manifests are assigned in
+  // order, and then filled concurrently.
+  std::vector<std::unique_ptr<ManifestWriter>> writers;
+  writers.reserve(ranges.size());
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    ICEBERG_ASSIGN_OR_RAISE(auto writer, NewManifestWriter(base, spec));
+    writers.push_back(std::move(writer));
+  }
+
+  RewrittenGroup rewritten{.manifests = std::vector<ManifestFile>(ranges.size()),
+                           .entries_count = entries_count};
+  auto write = [&](size_t index) -> Status {
+    auto& writer = writers[index];
+    for (size_t i = ranges[index].first; i < ranges[index].second; ++i) {
+      ICEBERG_RETURN_UNEXPECTED(writer->Add(entries[i].entry));
+    }
+    ICEBERG_RETURN_UNEXPECTED(writer->Close());
+    ICEBERG_ASSIGN_OR_RAISE(rewritten.manifests[index], writer->ToManifestFile());
+    return {};
+  };
+  if (auto status = RunInParallel(*executor, ranges.size(), parallelism_, write);
+      !status.has_value()) {
+    for (const auto& manifest : rewritten.manifests) {
+      if (!manifest.manifest_path.empty()) {
+        DeleteFile(manifest.manifest_path);
+      }
+    }
+    return std::unexpected(status.error());
+  }
+  return rewritten;
+}
+
+std::unordered_map<std::string, std::string> RewriteManifests::Summary() const {
+  auto summary = properties_;
+  summary[SnapshotSummaryFields::kCreatedManifestsCount] =
+      std::to_string(created_manifests_count_);
+  summary[SnapshotSummaryFields::kKeptManifestsCount] =
+      std::to_string(kept_manifests_count_);
+  summary[SnapshotSummaryFields::kReplacedManifestsCount] =
+      std::to_string(replaced_manifests_count_);
+  summary[SnapshotSummaryFields::kProcessedManifestEntries] =
+      std::to_string(processed_entries_count_);
+  return summary;
+}
+
+void RewriteManifests::CleanUncommitted(
+    const std::unordered_set<std::string>& committed) {
+  for (const auto& [key, rewritten] : rewritten_) {
+    for (const auto& manifest : rewritten.manifests) {
+      if (!committed.contains(manifest.manifest_path)) {
+        DeleteFile(manifest.manifest_path);
+      }
+    }
+  }
+  rewritten_.clear();
+}
+
+}  // namespace iceberg
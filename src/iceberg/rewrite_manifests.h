@@ -0,0 +1,126 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/rewrite_manifests.h
+/// Rewrite of the manifests of a table clustered by partition.
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "iceberg/expression/literal.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/snapshot_producer.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief Rewrites the data manifests of the current snapshot, clustering their live
+/// entries so that each new manifest covers a narrow range of partitions.
+///
+/// The live entries of the rewritten manifests are read with up to `parallelism`
+/// manifests in flight, ordered by their cluster key within each partition spec, and
+/// written to new manifests of about `commit.manifest.target-size-bytes`. A cluster is
+/// only split across manifests when it is larger than a manifest on its own, so the
+/// partition ranges of the new manifests do not overlap and manifest pruning during
+/// planning skips all but the manifests of the matching partitions.
+///
+/// The table data is unchanged: the new snapshot has the `replace` operation and the
+/// rewritten entries keep their snapshot IDs and sequence numbers as existing entries.
+class ICEBERG_EXPORT RewriteManifests : public SnapshotProducer {
+ public:
+  /// \brief Returns the key of the cluster of a data file.
+  ///
+  /// Keys are compared tuple-wise, with null values first. The function is called
+  /// concurrently when the parallelism is greater than 1.
+  using ClusterFunction = std::function<std::vector<Literal>(const DataFile&)>;
+
+  /// \brief Creates a rewrite of the manifests of a table.
+  ///
+  /// \param table The table to rewrite, which must have a catalog to commit to
+  explicit RewriteManifests(std::shared_ptr<Table> table);
+
+  ~RewriteManifests() override;
+
+  /// \brief Clusters the entries by a function of their data files instead of their
+  /// partition tuples.
+  RewriteManifests& ClusterBy(ClusterFunction cluster_by);
+
+  /// \brief Only rewrites the data manifests that match a predicate, the other
+  /// manifests are kept as they are.
+  RewriteManifests& RewriteIf(std::function<bool(const ManifestFile&)> predicate);
+
+  /// \brief Sets the number of manifests read and written concurrently, 1 by default.
+  RewriteManifests& WithParallelism(int32_t parallelism);
+
+  /// \brief Sets the executor reading and writing the manifests concurrently, the
+  /// DefaultExecutor() if null.
+  RewriteManifests& WithExecutor(std::shared_ptr<Executor> executor);
+
+  /// \brief Sets a summary property of the new snapshot.
+  RewriteManifests& Set(const std::string& property, const std::string& value);
+
+  /// \brief Writes the new manifests and commits the snapshot that replaces the
+  /// rewritten manifests with them.
+  Status Commit();
+
+ protected:
+  const std::string& operation() const override;
+
+  Result<std::vector<ManifestFile>> Apply(const TableMetadata& base,
+                                          const Snapshot* parent) override;
+
+  std::unordered_map<std::string, std::string> Summary() const override;
+
+  void CleanUncommitted(const std::unordered_set<std::string>& committed) override;
+
+ private:
+  struct RewrittenGroup {
+    std::vector<ManifestFile> manifests;
+    int64_t entries_count = 0;
+  };
+
+  /// \brief Reads and clusters the live entries of the manifests of one partition spec
+  /// and writes them to new manifests.
+  Result<RewrittenGroup> RewriteGroup(const TableMetadata& base, int32_t spec_id,
+                                      const std::vector<ManifestFile>& group);
+
+  ClusterFunction cluster_by_;
+  std::function<bool(const ManifestFile&)> predicate_;
+  int32_t parallelism_ = 1;
+  std::shared_ptr<Executor> executor_;
+  std::unordered_map<std::string, std::string> properties_;
+  // New manifests by the paths of the manifests they were rewritten from, reused by
+  // the retries of the commit
+  std::map<std::vector<std::string>, RewrittenGroup> rewritten_;
+  int32_t created_manifests_count_ = 0;
+  int32_t kept_manifests_count_ = 0;
+  int32_t replaced_manifests_count_ = 0;
+  int64_t processed_entries_count_ = 0;
+};
+
+}  // namespace iceberg
@@ -19,7 +19,11 @@
 
 #include "iceberg/row/arrow_array_wrapper.h"
 
+#include <algorithm>
 #include <cstring>
+#include <initializer_list>
+#include <span>
+#include <vector>
 
 #include <nanoarrow/nanoarrow.h>
 
@@ -36,9 +40,38 @@ namespace iceberg {
 
 namespace {
 
-// TODO(gangwu): Reuse created ArrowArrayStructLike and others with cache.
+/// \brief The wrapper of the nested values of one child array.
+///
+/// The wrapper is created on first access and re-pointed at the requested row on
+/// later accesses, so reading nested values does not allocate per row.
+struct NestedWrapper {
+  /// \brief The array the wrapper was last pointed at, or null if the parent has been
+  /// reset to another array since.
+  const ArrowArray* array = nullptr;
+  std::shared_ptr<ArrowArrayStructLike> struct_like;
+  std::shared_ptr<ArrowArrayArrayLike> array_like;
+  std::shared_ptr<ArrowArrayMapLike> map_like;
+};
+
+template <typename Wrapper>
+Result<std::shared_ptr<Wrapper>> Repoint(std::shared_ptr<Wrapper>& wrapper,
+                                         const ArrowArray*& wrapped_array,
+                                         const ArrowSchema& schema,
+                                         const ArrowArray& array, int64_t index) {
+  if (wrapper == nullptr) {
+    ICEBERG_ASSIGN_OR_RAISE(wrapper, Wrapper::Make(schema, array, index));
+  } else if (wrapped_array != &array) {
+    ICEBERG_RETURN_UNEXPECTED(wrapper->Reset(array, index));
+  } else {
+    ICEBERG_RETURN_UNEXPECTED(wrapper->Reset(index));
+  }
+  wrapped_array = &array;
+  return wrapper;
+}
+
 Result<Scalar> ExtractValue(const ArrowSchema* schema, const ArrowArray* array,
-                            const ArrowArrayView* array_view, int64_t index) {
+                            const ArrowArrayView* array_view, int64_t index,
+                            NestedWrapper& nested) {
   if (ArrowArrayViewIsNull(array_view, index)) {
     return std::monostate{};
   }
@@ -83,18 +116,21 @@ Result<Scalar> ExtractValue(const ArrowSchema* schema, const ArrowArray* array,
       return Decimal(int_value);
     }
     case NANOARROW_TYPE_STRUCT: {
-      ICEBERG_ASSIGN_OR_RAISE(std::shared_ptr<StructLike> struct_like,
-                              ArrowArrayStructLike::Make(*schema, *array, index));
+      ICEBERG_ASSIGN_OR_RAISE(
+          std::shared_ptr<StructLike> struct_like,
+          Repoint(nested.struct_like, nested.array, *schema, *array, index));
       return struct_like;
     }
     case NANOARROW_TYPE_LIST: {
-      ICEBERG_ASSIGN_OR_RAISE(std::shared_ptr<ArrayLike> array_like,
-                              ArrowArrayArrayLike::Make(*schema, *array, index));
+      ICEBERG_ASSIGN_OR_RAISE(
+          std::shared_ptr<ArrayLike> array_like,
+          Repoint(nested.array_like, nested.array, *schema, *array, index));
       return array_like;
     }
     case NANOARROW_TYPE_MAP: {
-      ICEBERG_ASSIGN_OR_RAISE(std::shared_ptr<MapLike> map_like,
-                              ArrowArrayMapLike::Make(*schema, *array, index));
+      ICEBERG_ASSIGN_OR_RAISE(
+          std::shared_ptr<MapLike> map_like,
+          Repoint(nested.map_like, nested.array, *schema, *array, index));
       return map_like;
     }
     case NANOARROW_TYPE_EXTENSION:
@@ -132,13 +168,39 @@ class ArrowArrayStructLike::Impl {
     const ArrowArray* child_array = array_.get().children[pos];
     const ArrowArrayView* child_view = array_view_.children[pos];
 
-    return ExtractValue(child_schema, child_array, child_view, row_index_);
+    return ExtractValue(child_schema, child_array, child_view, row_index_,
+                        nested_[pos]);
   }
 
   size_t num_fields() const { return static_cast<size_t>(schema_.n_children); }
 
+  template <typename T>
+  Result<ArrowColumnView<T>> GetColumn(size_t pos,
+                                       std::initializer_list<ArrowType> types) const {
+    ICEBERG_ASSIGN_OR_RAISE(auto child, Child(pos, types));
+    const int64_t offset = array_.get().offset + child->offset;
+    const auto* values = static_cast<const T*>(child->buffers[1]);
+    return ArrowColumnView<T>{
+        .values = std::span<const T>(values + offset, Length()),
+        .validity = Validity(*child, offset)};
+  }
+
+  Result<ArrowBinaryColumnView> GetBinaryColumn(size_t pos) const {
+    ICEBERG_ASSIGN_OR_RAISE(auto child,
+                            Child(pos, {NANOARROW_TYPE_STRING, NANOARROW_TYPE_BINARY}));
+    const int64_t offset = array_.get().offset + child->offset;
+    const auto* offsets = static_cast<const int32_t*>(child->buffers[1]);
+    return ArrowBinaryColumnView{
+        .offsets = std::span<const int32_t>(offsets + offset, Length() + 1),
+        .data = static_cast<const char*>(child->buffers[2]),
+        .validity = Validity(*child, offset)};
+  }
+
   Status Reset(const ArrowArray& array, int64_t row_index) {
     array_ = std::cref(array);
+    for (auto& nested : nested_) {
+      nested.array = nullptr;
+    }
     row_index_ = row_index;
 
     ArrowError error;
@@ -158,16 +220,47 @@ class ArrowArrayStructLike::Impl {
         ArrowArrayViewInitFromSchema(&array_view_, &schema_, &error));
     NANOARROW_RETURN_IF_NOT_OK(
         ArrowArrayViewSetArray(&array_view_, &array_.get(), &error));
+    nested_.resize(static_cast<size_t>(schema_.n_children));
     return {};
   }
 
  private:
+  /// \brief Returns the child array of a field if its storage type is one of `types`.
+  Result<const ArrowArray*> Child(size_t pos,
+                                  std::initializer_list<ArrowType> types) const {
+    // NOLINTNEXTLINE(modernize-use-integer-sign-comparison)
+    if (pos >= static_cast<size_t>(schema_.n_children)) {
+      return InvalidArgument("Field index {} out of range (size: {})", pos,
+                             schema_.n_children);
+    }
+    const ArrowType storage_type = array_view_.children[pos]->storage_type;
+    if (std::ranges::find(types, storage_type) == types.end()) {
+      return InvalidArgument("Field {} has unexpected Arrow type: {}", pos,
+                             static_cast<int>(storage_type));
+    }
+    // Children of a sliced struct array start at the offset of the struct.
+    return array_.get().children[pos];
+  }
+
+  size_t Length() const { return static_cast<size_t>(array_.get().length); }
+
+  /// \brief Returns the validity of a child array whose values for the rows of the
+  /// struct start at `offset`.
+  static ArrowValidityView Validity(const ArrowArray& child, int64_t offset) {
+    if (child.null_count == 0 || child.n_buffers == 0) {
+      return {};
+    }
+    return {.bitmap = static_cast<const uint8_t*>(child.buffers[0]), .offset = offset};
+  }
+
   ArrowArrayView array_view_;
   internal::ArrowArrayViewGuard array_view_guard_{&array_view_};
 
   const ArrowSchema& schema_;
   std::reference_wrapper<const ArrowArray> array_;
   int64_t row_index_;
+
+  mutable std::vector<NestedWrapper> nested_;
 };
 
 Result<std::unique_ptr<ArrowArrayStructLike>> ArrowArrayStructLike::Make(
@@ -188,6 +281,27 @@ Result<Scalar> ArrowArrayStructLike::GetField(size_t pos) const {
 
 size_t ArrowArrayStructLike::num_fields() const { return impl_->num_fields(); }
 
+Result<ArrowColumnView<int32_t>> ArrowArrayStructLike::GetInt32Column(size_t pos) const {
+  return impl_->GetColumn<int32_t>(pos, {NANOARROW_TYPE_INT32, NANOARROW_TYPE_DATE32});
+}
+
+Result<ArrowColumnView<int64_t>> ArrowArrayStructLike::GetInt64Column(size_t pos) const {
+  return impl_->GetColumn<int64_t>(
+      pos, {NANOARROW_TYPE_INT64, NANOARROW_TYPE_TIME64, NANOARROW_TYPE_TIMESTAMP});
+}
+
+Result<ArrowColumnView<float>> ArrowArrayStructLike::GetFloatColumn(size_t pos) const {
+  return impl_->GetColumn<float>(pos, {NANOARROW_TYPE_FLOAT});
+}
+
+Result<ArrowColumnView<double>> ArrowArrayStructLike::GetDoubleColumn(size_t pos) const {
+  return impl_->GetColumn<double>(pos, {NANOARROW_TYPE_DOUBLE});
+}
+
+Result<ArrowBinaryColumnView> ArrowArrayStructLike::GetBinaryColumn(size_t pos) const {
+  return impl_->GetBinaryColumn(pos);
+}
+
 Status ArrowArrayStructLike::Reset(int64_t row_index) { return impl_->Reset(row_index); }
 
 Status ArrowArrayStructLike::Reset(const ArrowArray& array, int64_t row_index) {
@@ -214,13 +328,14 @@ class ArrowArrayArrayLike::Impl {
     const ArrowArrayView* child_view = array_view_.children[0];
 
     return ExtractValue(child_schema, child_array, child_view,
-                        offset_ + static_cast<int64_t>(pos));
+                        offset_ + static_cast<int64_t>(pos), element_);
   }
 
   size_t size() const { return static_cast<size_t>(length_); }
 
   Status Reset(const ArrowArray& array, int64_t row_index) {
     array_ = std::cref(array);
+    element_.array = nullptr;
     row_index_ = row_index;
 
     ArrowError error;
@@ -264,6 +379,8 @@ class ArrowArrayArrayLike::Impl {
 
   int64_t offset_ = 0;
   int64_t length_ = 0;
+
+  mutable NestedWrapper element_;
 };
 
 Result<std::unique_ptr<ArrowArrayArrayLike>> ArrowArrayArrayLike::Make(
@@ -310,7 +427,7 @@ class ArrowArrayMapLike::Impl {
     const ArrowArrayView* keys_view = array_view_.children[0]->children[0];
 
     return ExtractValue(keys_schema, keys_array, keys_view,
-                        offset_ + static_cast<int64_t>(pos));
+                        offset_ + static_cast<int64_t>(pos), key_);
   }
 
   Result<Scalar> GetValue(size_t pos) const {
@@ -324,13 +441,15 @@ class ArrowArrayMapLike::Impl {
     const ArrowArrayView* values_view = array_view_.children[0]->children[1];
 
     return ExtractValue(values_schema, values_array, values_view,
-                        offset_ + static_cast<int64_t>(pos));
+                        offset_ + static_cast<int64_t>(pos), value_);
   }
 
   size_t size() const { return static_cast<size_t>(length_); }
 
   Status Reset(const ArrowArray& array, int64_t row_index) {
     array_ = std::cref(array);
+    key_.array = nullptr;
+    value_.array = nullptr;
     row_index_ = row_index;
 
     ArrowError error;
@@ -378,6 +497,9 @@ class ArrowArrayMapLike::Impl {
 
   int64_t offset_ = 0;
   int64_t length_ = 0;
+
+  mutable NestedWrapper key_;
+  mutable NestedWrapper value_;
 };
 
 Result<std::unique_ptr<ArrowArrayMapLike>> ArrowArrayMapLike::Make(
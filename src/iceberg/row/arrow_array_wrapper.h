@@ -23,12 +23,69 @@
 /// Wrapper classes for ArrowArray that implement StructLike, ArrayLike, and MapLike
 /// interfaces for unified row-oriented data access from columnar ArrowArray data.
 
+#include <cstdint>
+#include <span>
+#include <string_view>
+
 #include "iceberg/arrow_c_data.h"
 #include "iceberg/row/struct_like.h"
 
 namespace iceberg {
 
+/// \brief The validity bitmap of a column of an ArrowArray.
+struct ICEBERG_EXPORT ArrowValidityView {
+  /// \brief The validity bitmap, or null if no value is null.
+  const uint8_t* bitmap = nullptr;
+  /// \brief The bit of the first value of the column in the bitmap.
+  int64_t offset = 0;
+
+  /// \brief Returns whether the i-th value of the column is not null.
+  bool IsValid(int64_t i) const {
+    const int64_t bit = offset + i;
+    return bitmap == nullptr || ((bitmap[bit >> 3] >> (bit & 7)) & 1) != 0;
+  }
+};
+
+/// \brief A view of a fixed-width column of an ArrowArray.
+///
+/// The values point into the buffers of the array and hold unspecified values for
+/// null rows.
+template <typename T>
+struct ArrowColumnView {
+  std::span<const T> values;
+  ArrowValidityView validity;
+
+  int64_t size() const { return static_cast<int64_t>(values.size()); }
+  bool IsValid(int64_t i) const { return validity.IsValid(i); }
+};
+
+/// \brief A view of a string or binary column of an ArrowArray.
+struct ICEBERG_EXPORT ArrowBinaryColumnView {
+  /// \brief The offsets of the values in `data`, one more than the number of values.
+  std::span<const int32_t> offsets;
+  /// \brief The concatenated values.
+  const char* data = nullptr;
+  ArrowValidityView validity;
+
+  int64_t size() const { return static_cast<int64_t>(offsets.size()) - 1; }
+  bool IsValid(int64_t i) const { return validity.IsValid(i); }
+
+  /// \brief Returns the i-th value, which is empty for null rows.
+  std::string_view Value(int64_t i) const {
+    return {data + offsets[i], static_cast<size_t>(offsets[i + 1] - offsets[i])};
+  }
+};
+
 /// \brief Wrapper for one row of a struct-typed ArrowArray.
+///
+/// GetField() reads one value of the current row at a time. Batch consumers should
+/// read whole columns with the typed column accessors instead, which return views of
+/// the Arrow buffers and are indexed like the rows. Views remain valid until the
+/// wrapper is reset to another array.
+///
+/// Struct, list and map values are returned as wrappers owned by this one, which are
+/// re-pointed at the current row by the next read of the same field instead of being
+/// allocated per row. Copy out nested values that must outlive that read.
 class ICEBERG_EXPORT ArrowArrayStructLike : public StructLike {
  public:
   ~ArrowArrayStructLike() override;
@@ -37,6 +94,21 @@ class ICEBERG_EXPORT ArrowArrayStructLike : public StructLike {
 
   size_t num_fields() const override;
 
+  /// \brief Returns the values of an int or date field.
+  Result<ArrowColumnView<int32_t>> GetInt32Column(size_t pos) const;
+
+  /// \brief Returns the values of a long, time or timestamp field.
+  Result<ArrowColumnView<int64_t>> GetInt64Column(size_t pos) const;
+
+  /// \brief Returns the values of a float field.
+  Result<ArrowColumnView<float>> GetFloatColumn(size_t pos) const;
+
+  /// \brief Returns the values of a double field.
+  Result<ArrowColumnView<double>> GetDoubleColumn(size_t pos) const;
+
+  /// \brief Returns the values of a string or binary field with 32-bit offsets.
+  Result<ArrowBinaryColumnView> GetBinaryColumn(size_t pos) const;
+
   Status Reset(int64_t row_index);
 
   Status Reset(const ArrowArray& array, int64_t row_index = 0);
@@ -56,6 +128,9 @@ class ICEBERG_EXPORT ArrowArrayStructLike : public StructLike {
 };
 
 /// \brief Wrapper for one row of a list-typed ArrowArray.
+///
+/// Nested elements are re-pointed by the next GetElement(), like the nested fields of
+/// ArrowArrayStructLike.
 class ICEBERG_EXPORT ArrowArrayArrayLike : public ArrayLike {
  public:
   ~ArrowArrayArrayLike() override;
@@ -83,6 +158,9 @@ class ICEBERG_EXPORT ArrowArrayArrayLike : public ArrayLike {
 };
 
 /// \brief Wrapper for one row of a map-typed ArrowArray.
+///
+/// Nested keys and values are re-pointed by the next GetKey() or GetValue()
+/// respectively, like the nested fields of ArrowArrayStructLike.
 class ICEBERG_EXPORT ArrowArrayMapLike : public MapLike {
  public:
   ~ArrowArrayMapLike() override;
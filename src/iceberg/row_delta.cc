@@ -0,0 +1,215 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/row_delta.h"
+
+#include <format>
+#include <iterator>
+#include <string>
+
+#include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_reader.h"
+#include "iceberg/manifest_writer.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+RowDelta::RowDelta(std::shared_ptr<Table> table) : SnapshotProducer(std::move(table)) {}
+
+RowDelta::~RowDelta() = default;
+
+RowDelta& RowDelta::AddRows(std::shared_ptr<DataFile> file) {
+  if (file == nullptr) {
+    errors_.emplace_back(ErrorKind::kInvalidArgument, "Cannot add null data file");
+    return *this;
+  }
+  if (file->content != DataFile::Content::kData) {
+    errors_.emplace_back(
+        ErrorKind::kInvalidArgument,
+        std::format("Cannot add delete file {} as a data file", file->file_path));
+    return *this;
+  }
+
+  ++added_data_files_;
+  added_records_ += file->record_count;
+  added_files_size_ += file->file_size_in_bytes;
+  const int32_t spec_id = file->partition_spec_id;
+  new_data_files_[spec_id].push_back(std::move(file));
+  return *this;
+}
+
+RowDelta& RowDelta::AddDeletes(std::shared_ptr<DataFile> file) {
+  if (file == nullptr) {
+    errors_.emplace_back(ErrorKind::kInvalidArgument, "Cannot add null delete file");
+    return *this;
+  }
+  switch (file->content) {
+    case DataFile::Content::kData:
+      errors_.emplace_back(
+          ErrorKind::kInvalidArgument,
+          std::format("Cannot add data file {} as a delete file", file->file_path));
+      return *this;
+    case DataFile::Content::kPositionDeletes:
+      ++added_pos_delete_files_;
+      added_pos_deletes_ += file->record_count;
+      if (file->referenced_data_file.has_value()) {
+        // Deletes of a removed file would not apply to the rows it was rewritten to.
+        referenced_paths_.insert(file->referenced_data_file.value());
+      }
+      break;
+    case DataFile::Content::kEqualityDeletes:
+      if (file->equality_ids.empty()) {
+        errors_.emplace_back(
+            ErrorKind::kInvalidArgument,
+            std::format("Cannot add equality delete file {} without equality field IDs",
+                        file->file_path));
+        return *this;
+      }
+      ++added_eq_delete_files_;
+      added_eq_deletes_ += file->record_count;
+      break;
+  }
+
+  added_files_size_ += file->file_size_in_bytes;
+  const int32_t spec_id = file->partition_spec_id;
+  new_delete_files_[spec_id].push_back(std::move(file));
+  return *this;
+}
+
+RowDelta& RowDelta::ValidateFromSnapshot(int64_t snapshot_id) {
+  starting_snapshot_id_ = snapshot_id;
+  return *this;
+}
+
+RowDelta& RowDelta::ConflictDetectionFilter(std::shared_ptr<Expression> filter) {
+  conflict_detection_filter_ = std::move(filter);
+  return *this;
+}
+
+RowDelta& RowDelta::ValidateDataFilesExist(
+    const std::vector<std::string>& data_file_paths) {
+  referenced_paths_.insert(data_file_paths.begin(), data_file_paths.end());
+  return *this;
+}
+
+RowDelta& RowDelta::ValidateNoConflictingDataFiles() {
+  validate_new_data_files_ = true;
+  return *this;
+}
+
+RowDelta& RowDelta::ValidateNoConflictingDeleteFiles() {
+  validate_new_delete_files_ = true;
+  return *this;
+}
+
+RowDelta& RowDelta::Set(const std::string& property, const std::string& value) {
+  properties_[property] = value;
+  return *this;
+}
+
+Status RowDelta::Commit() {
+  if (!errors_.empty()) {
+    return InvalidArgument("{}", errors_.front().message);
+  }
+  if (!new_delete_files_.empty() && table()->metadata()->format_version < 2) {
+    return InvalidArgument("Cannot add delete files to table {} of format version {}",
+                           table()->name().name, table()->metadata()->format_version);
+  }
+  return CommitSnapshot();
+}
+
+const std::string& RowDelta::operation() const {
+  if (new_delete_files_.empty()) {
+    return DataOperation::kAppend;
+  }
+  if (new_data_files_.empty()) {
+    return DataOperation::kDelete;
+  }
+  return DataOperation::kOverwrite;
+}
+
+Result<std::vector<ManifestFile>> RowDelta::Apply(const TableMetadata& base,
+                                                  const Snapshot* parent) {
+  ICEBERG_RETURN_UNEXPECTED(SnapshotProducer::ValidateDataFilesExist(
+      base, parent, starting_snapshot_id_, referenced_paths_));
+  if (validate_new_data_files_) {
+    ICEBERG_RETURN_UNEXPECTED(ValidateAddedDataFiles(base, parent, starting_snapshot_id_,
+                                                     conflict_detection_filter_));
+  }
+  if (validate_new_delete_files_) {
+    ICEBERG_RETURN_UNEXPECTED(ValidateNoNewDeleteFiles(
+        base, parent, starting_snapshot_id_, conflict_detection_filter_));
+  }
+
+  if (new_manifests_.empty()) {
+    // The data manifests are written first, so that they are also listed first.
+    for (const auto* files_by_spec : {&new_data_files_, &new_delete_files_}) {
+      for (const auto& [spec_id, files] : *files_by_spec) {
+        ICEBERG_ASSIGN_OR_RAISE(auto manifests,
+                                WriteAddedManifests(base, spec_id, files));
+        new_manifests_.insert(new_manifests_.end(),
+                              std::make_move_iterator(manifests.begin()),
+                              std::make_move_iterator(manifests.end()));
+      }
+    }
+  }
+
+  std::vector<ManifestFile> manifests = new_manifests_;
+  if (parent != nullptr) {
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto reader, ManifestListReader::Make(parent->manifest_list, table()->io()));
+    ICEBERG_ASSIGN_OR_RAISE(auto existing, reader->Files());
+    manifests.insert(manifests.end(), std::make_move_iterator(existing.begin()),
+                     std::make_move_iterator(existing.end()));
+  }
+  return manifests;
+}
+
+std::unordered_map<std::string, std::string> RowDelta::Summary() const {
+  auto summary = properties_;
+  summary[SnapshotSummaryFields::kAddedDataFiles] = std::to_string(added_data_files_);
+  summary[SnapshotSummaryFields::kAddedRecords] = std::to_string(added_records_);
+  summary[SnapshotSummaryFields::kAddedFileSize] = std::to_string(added_files_size_);
+  summary[SnapshotSummaryFields::kAddedDeleteFiles] =
+      std::to_string(added_pos_delete_files_ + added_eq_delete_files_);
+  summary[SnapshotSummaryFields::kAddedPosDeleteFiles] =
+      std::to_string(added_pos_delete_files_);
+  summary[SnapshotSummaryFields::kAddedEqDeleteFiles] =
+      std::to_string(added_eq_delete_files_);
+  summary[SnapshotSummaryFields::kAddedPosDeletes] = std::to_string(added_pos_deletes_);
+  summary[SnapshotSummaryFields::kAddedEqDeletes] = std::to_string(added_eq_deletes_);
+  return summary;
+}
+
+void RowDelta::CleanUncommitted(const std::unordered_set<std::string>& committed) {
+  for (const auto& manifest : new_manifests_) {
+    if (!committed.contains(manifest.manifest_path)) {
+      DeleteFile(manifest.manifest_path);
+    }
+  }
+  if (committed.empty()) {
+    new_manifests_.clear();
+  }
+}
+
+}  // namespace iceberg
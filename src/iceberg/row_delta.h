@@ -0,0 +1,140 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/row_delta.h
+/// Merge-on-read commit of new data files with the delete files of changed rows.
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/result.h"
+#include "iceberg/snapshot_producer.h"
+#include "iceberg/type_fwd.h"
+#include "iceberg/util/string_util.h"
+
+namespace iceberg {
+
+/// \brief Commits new data files and position or equality delete files in a single
+/// snapshot, without rewriting the data files whose rows are deleted.
+///
+/// The new data files and the new delete files are written to separate data and delete
+/// manifests, one per partition spec, which are added to the manifests of the current
+/// snapshot. The manifests are written once and reused by the retries of the commit.
+/// All new files inherit the sequence number of the committed snapshot, so its
+/// equality deletes only apply to the rows of older data files, while its position
+/// deletes may also apply to the rows of its new data files, as for an upsert.
+///
+/// The new snapshot has the `append` operation if it only adds data files, `delete` if
+/// it only adds delete files, and `overwrite` otherwise. Delete files require table
+/// format version 2.
+///
+/// Concurrent commits are validated from the snapshot set with ValidateFromSnapshot(),
+/// or from the creation of the table, reading only the manifests added since then. The
+/// commit fails with ErrorKind::kValidationFailed if a snapshot committed after it:
+/// - removed a data file referenced by a new position delete file or passed to
+///   ValidateDataFilesExist();
+/// - added data files that may contain rows matching the conflict detection filter,
+///   with ValidateNoConflictingDataFiles();
+/// - added delete files that may apply to rows matching the conflict detection filter,
+///   with ValidateNoConflictingDeleteFiles().
+class ICEBERG_EXPORT RowDelta : public SnapshotProducer {
+ public:
+  /// \brief Creates a row delta of a table.
+  ///
+  /// \param table The table to change, which must have a catalog to commit to
+  explicit RowDelta(std::shared_ptr<Table> table);
+
+  ~RowDelta() override;
+
+  /// \brief Adds a data file of new rows.
+  RowDelta& AddRows(std::shared_ptr<DataFile> file);
+
+  /// \brief Adds a position or equality delete file of deleted rows.
+  RowDelta& AddDeletes(std::shared_ptr<DataFile> file);
+
+  /// \brief Sets the snapshot the changed rows were read from, which must be an
+  /// ancestor of the snapshot the row delta is committed on top of.
+  RowDelta& ValidateFromSnapshot(int64_t snapshot_id);
+
+  /// \brief Sets the filter on table rows the changes were planned with, used to find
+  /// the concurrent changes that conflict with them. Defaults to all rows.
+  RowDelta& ConflictDetectionFilter(std::shared_ptr<Expression> filter);
+
+  /// \brief Fails the commit if a concurrent snapshot removed one of the data files.
+  ///
+  /// \param data_file_paths The paths of the data files the deletes were written for
+  RowDelta& ValidateDataFilesExist(const std::vector<std::string>& data_file_paths);
+
+  /// \brief Fails the commit if a concurrent snapshot added data files that may contain
+  /// rows matching the conflict detection filter.
+  RowDelta& ValidateNoConflictingDataFiles();
+
+  /// \brief Fails the commit if a concurrent snapshot added delete files that may
+  /// apply to rows matching the conflict detection filter.
+  RowDelta& ValidateNoConflictingDeleteFiles();
+
+  /// \brief Sets a summary property of the new snapshot.
+  RowDelta& Set(const std::string& property, const std::string& value);
+
+  /// \brief Validates the row delta against the current snapshot and commits it.
+  Status Commit();
+
+ protected:
+  const std::string& operation() const override;
+
+  Result<std::vector<ManifestFile>> Apply(const TableMetadata& base,
+                                          const Snapshot* parent) override;
+
+  std::unordered_map<std::string, std::string> Summary() const override;
+
+  void CleanUncommitted(const std::unordered_set<std::string>& committed) override;
+
+ private:
+  std::vector<Error> errors_;
+  // New data and delete files by partition spec ID
+  std::map<int32_t, std::vector<std::shared_ptr<DataFile>>> new_data_files_;
+  std::map<int32_t, std::vector<std::shared_ptr<DataFile>>> new_delete_files_;
+  std::unordered_set<std::string, StringHash, std::equal_to<>> referenced_paths_;
+  std::optional<int64_t> starting_snapshot_id_;
+  std::shared_ptr<Expression> conflict_detection_filter_;
+  bool validate_new_data_files_ = false;
+  bool validate_new_delete_files_ = false;
+  std::unordered_map<std::string, std::string> properties_;
+  std::vector<ManifestFile> new_manifests_;
+  int32_t added_data_files_ = 0;
+  int32_t added_pos_delete_files_ = 0;
+  int32_t added_eq_delete_files_ = 0;
+  int64_t added_records_ = 0;
+  int64_t added_pos_deletes_ = 0;
+  int64_t added_eq_deletes_ = 0;
+  int64_t added_files_size_ = 0;
+};
+
+}  // namespace iceberg
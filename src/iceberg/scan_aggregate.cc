@@ -0,0 +1,203 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/scan_aggregate.h"
+
+#include <utility>
+
+#include "iceberg/manifest_entry.h"
+#include "iceberg/schema.h"
+#include "iceberg/type.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/conversions.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief Returns the count of a column in a map of counts.
+std::optional<int64_t> FindCount(const std::map<int32_t, int64_t>& counts,
+                                 int32_t field_id) {
+  auto it = counts.find(field_id);
+  if (it == counts.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+}  // namespace
+
+ScanAggregate ScanAggregate::CountStar() {
+  return {.operation = AggregateOperation::kCountStar};
+}
+
+ScanAggregate ScanAggregate::Count(std::string column) {
+  return {.operation = AggregateOperation::kCount, .column = std::move(column)};
+}
+
+ScanAggregate ScanAggregate::Min(std::string column) {
+  return {.operation = AggregateOperation::kMin, .column = std::move(column)};
+}
+
+ScanAggregate ScanAggregate::Max(std::string column) {
+  return {.operation = AggregateOperation::kMax, .column = std::move(column)};
+}
+
+struct MetricsAggregator::State {
+  AggregateOperation operation;
+  int32_t field_id = 0;
+  bool optional = true;
+  std::shared_ptr<PrimitiveType> type;
+  /// \brief The count of a count aggregate.
+  int64_t count = 0;
+  /// \brief The min or max of the files added so far, if any has a non-null value.
+  std::optional<Literal> bound;
+  /// \brief Whether a file had no metrics for the aggregate.
+  bool unavailable = false;
+  bool exact = true;
+
+  /// \brief Returns the number of non-null values of the column in a data file, or
+  /// nullopt if the file has no metrics for it.
+  std::optional<int64_t> NonNullCount(const DataFile& data_file) const {
+    auto values = FindCount(data_file.value_counts, field_id);
+    auto nulls = optional ? FindCount(data_file.null_value_counts, field_id) : 0;
+    if (!values.has_value() || !nulls.has_value()) {
+      return std::nullopt;
+    }
+    return values.value() - nulls.value();
+  }
+
+  Status Add(const DataFile& data_file, bool file_exact) {
+    exact &= file_exact;
+    switch (operation) {
+      case AggregateOperation::kCountStar:
+        count += data_file.record_count;
+        return {};
+      case AggregateOperation::kCount: {
+        auto non_null = NonNullCount(data_file);
+        if (non_null.has_value()) {
+          count += non_null.value();
+        } else {
+          unavailable = true;
+        }
+        return {};
+      }
+      case AggregateOperation::kMin:
+      case AggregateOperation::kMax:
+        return AddBound(data_file);
+    }
+    std::unreachable();
+  }
+
+  Status AddBound(const DataFile& data_file) {
+    const bool is_min = operation == AggregateOperation::kMin;
+    if (type->type_id() == TypeId::kFloat || type->type_id() == TypeId::kDouble) {
+      // The bounds of floating-point columns do not cover NaN values.
+      auto nans = FindCount(data_file.nan_value_counts, field_id);
+      exact &= nans.has_value() && nans.value() == 0;
+    }
+    const auto& bounds = is_min ? data_file.lower_bounds : data_file.upper_bounds;
+    auto it = bounds.find(field_id);
+    if (it == bounds.end()) {
+      // A file without non-null values has no bounds.
+      auto non_null = NonNullCount(data_file);
+      unavailable |= !non_null.has_value() || non_null.value() != 0;
+      return {};
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto value, Conversions::FromBytes(type, it->second));
+    if (!bound.has_value() ||
+        (is_min ? value < bound.value() : value > bound.value())) {
+      bound = std::move(value);
+    }
+    return {};
+  }
+
+  AggregateValue Value() const {
+    if (unavailable) {
+      return {};
+    }
+    switch (operation) {
+      case AggregateOperation::kCountStar:
+      case AggregateOperation::kCount:
+        return {.value = Literal::Long(count), .exact = exact};
+      case AggregateOperation::kMin:
+      case AggregateOperation::kMax:
+        return {.value = bound.has_value() ? bound.value() : Literal::Null(type),
+                .exact = exact};
+    }
+    std::unreachable();
+  }
+};
+
+MetricsAggregator::MetricsAggregator(std::vector<State> states)
+    : states_(std::move(states)) {}
+
+MetricsAggregator::~MetricsAggregator() = default;
+
+Result<std::unique_ptr<MetricsAggregator>> MetricsAggregator::Make(
+    const Schema& schema, const std::vector<ScanAggregate>& aggregates,
+    bool case_sensitive) {
+  std::vector<State> states;
+  states.reserve(aggregates.size());
+  for (const auto& aggregate : aggregates) {
+    State state{.operation = aggregate.operation};
+    if (aggregate.operation != AggregateOperation::kCountStar) {
+      ICEBERG_ASSIGN_OR_RAISE(auto field,
+                              schema.FindFieldByName(aggregate.column, case_sensitive));
+      if (!field.has_value()) {
+        return InvalidArgument("Cannot find column to aggregate: {}", aggregate.column);
+      }
+      const auto& schema_field = field->get();
+      state.field_id = schema_field.field_id();
+      state.optional = schema_field.optional();
+      if (schema_field.type()->is_primitive()) {
+        state.type = internal::checked_pointer_cast<PrimitiveType>(schema_field.type());
+        // String and binary bounds may be truncated prefixes of the values.
+        const TypeId type_id = state.type->type_id();
+        state.exact = aggregate.operation == AggregateOperation::kCount ||
+                      (type_id != TypeId::kString && type_id != TypeId::kBinary &&
+                       type_id != TypeId::kFixed);
+      } else if (aggregate.operation != AggregateOperation::kCount) {
+        return InvalidArgument("Cannot compute the min or max of non-primitive column {}",
+                               aggregate.column);
+      }
+    }
+    states.push_back(std::move(state));
+  }
+  return std::unique_ptr<MetricsAggregator>(new MetricsAggregator(std::move(states)));
+}
+
+Status MetricsAggregator::Add(const DataFile& data_file, bool exact) {
+  for (auto& state : states_) {
+    ICEBERG_RETURN_UNEXPECTED(state.Add(data_file, exact));
+  }
+  return {};
+}
+
+std::vector<AggregateValue> MetricsAggregator::Values() const {
+  std::vector<AggregateValue> values;
+  values.reserve(states_.size());
+  for (const auto& state : states_) {
+    values.push_back(state.Value());
+  }
+  return values;
+}
+
+}  // namespace iceberg
@@ -0,0 +1,114 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/scan_aggregate.h
+/// Aggregates of the rows of a scan computed from the metrics of its data files.
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "iceberg/expression/literal.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief The operation of an aggregate of the rows of a scan.
+enum class AggregateOperation {
+  /// \brief The number of rows.
+  kCountStar,
+  /// \brief The number of non-null values of a column.
+  kCount,
+  /// \brief The smallest non-null value of a column.
+  kMin,
+  /// \brief The largest non-null value of a column.
+  kMax,
+};
+
+/// \brief An aggregate of the rows of a scan.
+struct ICEBERG_EXPORT ScanAggregate {
+  AggregateOperation operation = AggregateOperation::kCountStar;
+  /// \brief The name of the aggregated column, unused by kCountStar.
+  std::string column;
+
+  static ScanAggregate CountStar();
+  static ScanAggregate Count(std::string column);
+  static ScanAggregate Min(std::string column);
+  static ScanAggregate Max(std::string column);
+};
+
+/// \brief The value of an aggregate computed from the metrics of data files.
+struct ICEBERG_EXPORT AggregateValue {
+  /// \brief The value, or nullopt if the metrics of a data file cannot bound it.
+  ///
+  /// Counts are long literals, and the min and max are literals of the type of the
+  /// column, null when no row has a non-null value.
+  std::optional<Literal> value;
+  /// \brief Whether the value is the aggregate of the rows of the scan.
+  ///
+  /// Otherwise the value bounds it: counts and the max are at least, and the min is
+  /// at most, the aggregate of the rows. Values are not exact when delete files or a
+  /// filter apply to the rows of a data file, and the min and max of strings and
+  /// binaries, whose bounds may be truncated, or of floating-point columns with NaN
+  /// values are never exact.
+  bool exact = false;
+};
+
+/// \brief Computes aggregates of the rows of data files from their metrics, without
+/// reading the files.
+class ICEBERG_EXPORT MetricsAggregator {
+ public:
+  ~MetricsAggregator();
+
+  /// \brief Creates an aggregator.
+  ///
+  /// \param schema The schema of the rows of the data files
+  /// \param aggregates The aggregates to compute. Min and max aggregates must be of
+  /// primitive columns.
+  /// \param case_sensitive Whether column names are matched case sensitively
+  static Result<std::unique_ptr<MetricsAggregator>> Make(
+      const Schema& schema, const std::vector<ScanAggregate>& aggregates,
+      bool case_sensitive = true);
+
+  /// \brief Adds the rows of a data file.
+  ///
+  /// \param data_file The data file, whose metrics are used
+  /// \param exact Whether all of the rows of the file are aggregated, false when
+  /// delete files or a filter apply to them
+  Status Add(const DataFile& data_file, bool exact);
+
+  /// \brief Returns the values of the aggregates of the added files, in the order of
+  /// the aggregates.
+  std::vector<AggregateValue> Values() const;
+
+ private:
+  struct State;
+
+  explicit MetricsAggregator(std::vector<State> states);
+
+  std::vector<State> states_;
+};
+
+}  // namespace iceberg
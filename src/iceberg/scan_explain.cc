@@ -0,0 +1,113 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/scan_explain.h"
+
+#include <format>
+#include <iterator>
+#include <utility>
+
+#include "iceberg/expression/expression.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief Formats a duration in milliseconds.
+std::string FormatMillis(std::chrono::nanoseconds duration) {
+  return std::format("{:.3f} ms",
+                     std::chrono::duration<double, std::milli>(duration).count());
+}
+
+}  // namespace
+
+std::string_view ToString(ManifestOutcome outcome) {
+  switch (outcome) {
+    case ManifestOutcome::kScanned:
+      return "scanned";
+    case ManifestOutcome::kSkippedByPartitionSummaries:
+      return "skipped by partition summaries";
+  }
+  std::unreachable();
+}
+
+std::string ScanExplain::ToString() const {
+  std::string out;
+  auto it = std::back_inserter(out);
+  std::format_to(it, "Scan of snapshot {} with filter {}\n", snapshot_id,
+                 filter != nullptr ? filter->ToString() : "true");
+  std::format_to(it,
+                 "Planning: {} (manifest list {}, manifest filtering {}, delete files "
+                 "{}, data files {})\n",
+                 FormatMillis(durations.total),
+                 FormatMillis(durations.read_manifest_list),
+                 FormatMillis(durations.filter_manifests),
+                 FormatMillis(durations.index_delete_files),
+                 FormatMillis(durations.plan_data_files));
+  std::format_to(it, "Data manifests: {} total, {} scanned, {} skipped\n",
+                 metrics.total_data_manifests.value(),
+                 metrics.scanned_data_manifests.value(),
+                 metrics.skipped_data_manifests.value());
+  std::format_to(it, "Delete manifests: {} total, {} scanned, {} skipped\n",
+                 metrics.total_delete_manifests.value(),
+                 metrics.scanned_delete_manifests.value(),
+                 metrics.skipped_delete_manifests.value());
+  std::format_to(it,
+                 "Data files: {} planned, {} skipped by partition, {} skipped by "
+                 "metrics\n",
+                 metrics.result_data_files.value(), data_files_skipped_by_partition,
+                 data_files_skipped_by_metrics);
+  std::format_to(it,
+                 "Delete files: {} indexed, {} skipped by partition, {} matched to data "
+                 "files\n",
+                 metrics.indexed_delete_files.value(),
+                 metrics.skipped_delete_files.value(),
+                 metrics.result_delete_files.value());
+
+  for (const auto& manifest : manifests) {
+    std::format_to(it, "Manifest {} ({}, spec {}): {}", manifest.manifest_path,
+                   iceberg::ToString(manifest.content), manifest.partition_spec_id,
+                   iceberg::ToString(manifest.outcome));
+    if (manifest.outcome == ManifestOutcome::kScanned) {
+      std::format_to(it,
+                     ", {} live files, {} skipped by partition, {} skipped by metrics, "
+                     "{} {}",
+                     manifest.live_files, manifest.files_skipped_by_partition,
+                     manifest.files_skipped_by_metrics, manifest.result_files,
+                     manifest.content == ManifestFile::Content::kData ? "planned"
+                                                                      : "indexed");
+      if (manifest.content == ManifestFile::Content::kData) {
+        std::format_to(it, ", {} matched delete files", manifest.matched_delete_files);
+      }
+    }
+    out.push_back('\n');
+  }
+
+  for (const auto& residual : residuals) {
+    std::format_to(it, "Partition (spec {}) [", residual.partition_spec_id);
+    for (size_t i = 0; i < residual.partition.size(); ++i) {
+      std::format_to(it, "{}{}", i == 0 ? "" : ", ", residual.partition[i].ToString());
+    }
+    std::format_to(it, "]: {} data files, residual {}\n", residual.data_files,
+                   residual.residual->ToString());
+  }
+  return out;
+}
+
+}  // namespace iceberg
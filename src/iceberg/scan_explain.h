@@ -0,0 +1,129 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/scan_explain.h
+/// A profile of the planning of a table scan.
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "iceberg/expression/literal.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/metrics_reporter.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief How planning handled a manifest of the scanned snapshot.
+enum class ManifestOutcome {
+  /// \brief The manifest was read.
+  kScanned,
+  /// \brief The partition summaries of the manifest show that none of its files can
+  /// match the scan filter, so it was not read.
+  kSkippedByPartitionSummaries,
+};
+
+/// \brief Returns the name of a manifest outcome.
+ICEBERG_EXPORT std::string_view ToString(ManifestOutcome outcome);
+
+/// \brief The explanation of how a manifest was planned.
+///
+/// File counts only cover live entries, and are 0 for manifests that were not read.
+struct ICEBERG_EXPORT ManifestExplain {
+  std::string manifest_path;
+  ManifestFile::Content content = ManifestFile::Content::kData;
+  int32_t partition_spec_id = 0;
+  ManifestOutcome outcome = ManifestOutcome::kScanned;
+  /// \brief Number of live files of the manifest.
+  int64_t live_files = 0;
+  /// \brief Number of files skipped because their partition cannot match the filter.
+  int64_t files_skipped_by_partition = 0;
+  /// \brief Number of data files skipped because their column metrics or bloom filter
+  /// show that they hold no matching rows.
+  int64_t files_skipped_by_metrics = 0;
+  /// \brief Number of planned data files of a data manifest, or of indexed delete
+  /// files of a delete manifest.
+  int64_t result_files = 0;
+  /// \brief Number of delete files matched to the planned data files of a data
+  /// manifest, counting a delete file once per data file.
+  int64_t matched_delete_files = 0;
+};
+
+/// \brief The residual of the scan filter for a partition with planned data files.
+struct ICEBERG_EXPORT PartitionResidual {
+  int32_t partition_spec_id = 0;
+  /// \brief The partition values, ordered like the fields of the spec.
+  std::vector<Literal> partition;
+  /// \brief The part of the filter that must still be applied to the rows of the
+  /// partition, true when every row matches.
+  std::shared_ptr<Expression> residual;
+  /// \brief Number of planned data files of the partition.
+  int64_t data_files = 0;
+};
+
+/// \brief Wall-clock time of each stage of scan planning.
+struct ICEBERG_EXPORT ScanStageDurations {
+  /// \brief Reading the manifest list of the snapshot.
+  std::chrono::nanoseconds read_manifest_list{0};
+  /// \brief Skipping manifests by their partition summaries and preparing the
+  /// evaluators of the filter.
+  std::chrono::nanoseconds filter_manifests{0};
+  /// \brief Reading the delete manifests and indexing their delete files.
+  std::chrono::nanoseconds index_delete_files{0};
+  /// \brief Reading the data manifests and planning their data files.
+  std::chrono::nanoseconds plan_data_files{0};
+  /// \brief The whole planning.
+  std::chrono::nanoseconds total{0};
+};
+
+/// \brief A profile of the planning of a table scan, returned by TableScan::Explain().
+///
+/// Unlike the ScanMetrics of a scan report, it details how each manifest was planned,
+/// why files were skipped and what remains of the filter in each partition, which
+/// tells where planning spends its time and why a scan reads the files it does.
+struct ICEBERG_EXPORT ScanExplain {
+  /// \brief ID of the scanned snapshot.
+  int64_t snapshot_id = 0;
+  /// \brief The scan filter, or null if the scan has no filter.
+  std::shared_ptr<Expression> filter;
+  /// \brief The manifests of the snapshot, in manifest list order.
+  std::vector<ManifestExplain> manifests;
+  /// \brief The residuals of the partitions of the planned data files, in the order in
+  /// which the partitions were first planned. Empty when the scan has no filter.
+  std::vector<PartitionResidual> residuals;
+  /// \brief Number of data files skipped because their partition cannot match.
+  int64_t data_files_skipped_by_partition = 0;
+  /// \brief Number of data files skipped by their column metrics.
+  int64_t data_files_skipped_by_metrics = 0;
+  ScanStageDurations durations;
+  /// \brief The metrics of planning, as reported to a MetricsReporter.
+  ScanMetrics metrics;
+
+  /// \brief Returns a human-readable, multi-line description of the profile.
+  std::string ToString() const;
+};
+
+}  // namespace iceberg
@@ -0,0 +1,93 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/scan_plan_cache.h"
+
+#include <utility>
+
+namespace iceberg {
+
+ScanPlanCache::ScanPlanCache(int64_t capacity_bytes) : capacity_bytes_(capacity_bytes) {}
+
+Result<std::shared_ptr<ScanPlanCache>> ScanPlanCache::Make(int64_t capacity_bytes) {
+  if (capacity_bytes <= 0) {
+    return InvalidArgument("Scan plan cache capacity must be positive, got {}",
+                           capacity_bytes);
+  }
+  return std::shared_ptr<ScanPlanCache>(new ScanPlanCache(capacity_bytes));
+}
+
+std::shared_ptr<const std::vector<uint8_t>> ScanPlanCache::Get(std::string_view key) {
+  std::lock_guard lock(mutex_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    ++stats_.misses;
+    return nullptr;
+  }
+  ++stats_.hits;
+  items_.splice(items_.begin(), items_, it->second);
+  return it->second->plan;
+}
+
+void ScanPlanCache::Put(std::string key, std::vector<uint8_t> plan) {
+  const auto size_bytes = static_cast<int64_t>(key.size() + plan.size());
+  std::lock_guard lock(mutex_);
+  if (auto it = index_.find(key); it != index_.end()) {
+    auto item = it->second;
+    index_.erase(it);
+    stats_.size_bytes -= item->size_bytes;
+    --stats_.plan_count;
+    items_.erase(item);
+  }
+  if (size_bytes > capacity_bytes_) {
+    return;
+  }
+
+  while (stats_.size_bytes + size_bytes > capacity_bytes_) {
+    const auto& lru = items_.back();
+    stats_.size_bytes -= lru.size_bytes;
+    --stats_.plan_count;
+    ++stats_.evictions;
+    index_.erase(lru.key);
+    items_.pop_back();
+  }
+
+  items_.push_front(
+      Item{.key = std::move(key),
+           .plan = std::make_shared<const std::vector<uint8_t>>(std::move(plan)),
+           .size_bytes = size_bytes});
+  index_.emplace(items_.front().key, items_.begin());
+  stats_.size_bytes += size_bytes;
+  ++stats_.plan_count;
+}
+
+void ScanPlanCache::Clear() {
+  std::lock_guard lock(mutex_);
+  index_.clear();
+  items_.clear();
+  stats_.plan_count = 0;
+  stats_.size_bytes = 0;
+}
+
+ScanPlanCache::Stats ScanPlanCache::stats() const {
+  std::lock_guard lock(mutex_);
+  return stats_;
+}
+
+}  // namespace iceberg
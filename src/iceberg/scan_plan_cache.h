@@ -0,0 +1,105 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/scan_plan_cache.h
+/// Cache of the planned tasks of scans.
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+
+namespace iceberg {
+
+/// \brief A thread-safe LRU cache of the planned tasks of scans.
+///
+/// Snapshots are immutable, so the tasks planned for a snapshot of a table with a
+/// filter, a projection and scan options are the same for every scan repeating them,
+/// and an entry never becomes stale. A scan built with TableScanBuilder::WithPlanCache()
+/// keys its plan by the table UUID, the snapshot ID, the filter bound to the table
+/// schema with its negations rewritten, the IDs of the projected fields, the scan
+/// options, the row limit, the sample and whether column stats are kept.
+///
+/// Plans are held in the compact form written by SerializeScanTasks, and the cache
+/// holds up to a configured number of bytes of them, evicting the least recently used
+/// plans beyond that. Plans larger than the capacity are not cached.
+class ICEBERG_EXPORT ScanPlanCache {
+ public:
+  /// \brief Counters describing the use of the cache.
+  struct Stats {
+    /// \brief Number of lookups that found the plan in the cache.
+    int64_t hits = 0;
+    /// \brief Number of lookups that did not find the plan in the cache.
+    int64_t misses = 0;
+    /// \brief Number of plans evicted to make room for other plans.
+    int64_t evictions = 0;
+    /// \brief Number of plans currently in the cache.
+    int64_t plan_count = 0;
+    /// \brief Size in bytes of the plans currently in the cache, with their keys.
+    int64_t size_bytes = 0;
+  };
+
+  /// \brief Creates a cache holding up to `capacity_bytes` bytes of plans.
+  /// \param capacity_bytes The capacity of the cache, must be positive.
+  /// \return A Result containing the cache or an error.
+  static Result<std::shared_ptr<ScanPlanCache>> Make(int64_t capacity_bytes);
+
+  /// \brief Returns the serialized plan of a key and marks it as most recently used, or
+  /// null if it is not cached.
+  std::shared_ptr<const std::vector<uint8_t>> Get(std::string_view key);
+
+  /// \brief Caches the serialized plan of a key.
+  void Put(std::string key, std::vector<uint8_t> plan);
+
+  /// \brief Removes all plans from the cache. The counters are kept.
+  void Clear();
+
+  /// \brief The capacity of the cache in bytes.
+  int64_t capacity_bytes() const { return capacity_bytes_; }
+
+  /// \brief Returns a snapshot of the counters of the cache.
+  Stats stats() const;
+
+ private:
+  struct Item {
+    std::string key;
+    std::shared_ptr<const std::vector<uint8_t>> plan;
+    int64_t size_bytes;
+  };
+
+  explicit ScanPlanCache(int64_t capacity_bytes);
+
+  const int64_t capacity_bytes_;
+  mutable std::mutex mutex_;
+  /// \brief Cached plans, from the most to the least recently used.
+  std::list<Item> items_;
+  std::unordered_map<std::string_view, std::list<Item>::iterator> index_;
+  Stats stats_;
+};
+
+}  // namespace iceberg
@@ -0,0 +1,563 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/scan_task_serialization.h"
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "iceberg/expression/expression.h"
+#include "iceberg/expression/expression_serialization.h"
+#include "iceberg/expression/literal.h"
+#include "iceberg/file_format.h"
+#include "iceberg/file_reader.h"
+#include "iceberg/json_internal.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/schema.h"
+#include "iceberg/table_scan.h"
+#include "iceberg/util/binary_codec_internal.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+constexpr std::string_view kMagic = "IST";
+constexpr uint8_t kFormatVersion = 3;
+constexpr std::string_view kShardMagic = "IMS";
+constexpr uint8_t kShardFormatVersion = 1;
+
+void WriteCountMap(BinaryWriter& writer, const std::map<int32_t, int64_t>& counts) {
+  writer.Varint(counts.size());
+  for (const auto& [field_id, count] : counts) {
+    writer.Long(field_id);
+    writer.Long(count);
+  }
+}
+
+Result<std::map<int32_t, int64_t>> ReadCountMap(BinaryReader& reader) {
+  ICEBERG_ASSIGN_OR_RAISE(auto size, reader.Count());
+  std::map<int32_t, int64_t> counts;
+  for (size_t i = 0; i < size; ++i) {
+    ICEBERG_ASSIGN_OR_RAISE(auto field_id, reader.Int());
+    ICEBERG_ASSIGN_OR_RAISE(auto count, reader.Long());
+    counts.emplace_hint(counts.end(), field_id, count);
+  }
+  return counts;
+}
+
+void WriteBoundMap(BinaryWriter& writer,
+                   const std::map<int32_t, std::vector<uint8_t>>& bounds) {
+  writer.Varint(bounds.size());
+  for (const auto& [field_id, bound] : bounds) {
+    writer.Long(field_id);
+    writer.Bytes(bound);
+  }
+}
+
+Result<std::map<int32_t, std::vector<uint8_t>>> ReadBoundMap(BinaryReader& reader) {
+  ICEBERG_ASSIGN_OR_RAISE(auto size, reader.Count());
+  std::map<int32_t, std::vector<uint8_t>> bounds;
+  for (size_t i = 0; i < size; ++i) {
+    ICEBERG_ASSIGN_OR_RAISE(auto field_id, reader.Int());
+    ICEBERG_ASSIGN_OR_RAISE(auto bound, reader.Bytes());
+    bounds.emplace_hint(bounds.end(), field_id,
+                        std::vector<uint8_t>(bound.begin(), bound.end()));
+  }
+  return bounds;
+}
+
+/// \brief Writes a data or delete file, whose partition is written to the partition
+/// dictionary of the batch at `partition_index`.
+void WriteDataFile(BinaryWriter& writer, const DataFile& file, size_t partition_index) {
+  writer.Byte(static_cast<uint8_t>(file.content));
+  writer.String(file.file_path);
+  writer.Byte(static_cast<uint8_t>(file.file_format));
+  writer.Varint(partition_index);
+  writer.Long(file.partition_spec_id);
+  writer.Long(file.record_count);
+  writer.Long(file.file_size_in_bytes);
+  WriteCountMap(writer, file.column_sizes);
+  WriteCountMap(writer, file.value_counts);
+  WriteCountMap(writer, file.null_value_counts);
+  WriteCountMap(writer, file.nan_value_counts);
+  WriteBoundMap(writer, file.lower_bounds);
+  WriteBoundMap(writer, file.upper_bounds);
+  writer.Bytes(file.key_metadata);
+  writer.Varint(file.split_offsets.size());
+  for (int64_t offset : file.split_offsets) {
+    writer.Long(offset);
+  }
+  writer.Varint(file.equality_ids.size());
+  for (int32_t field_id : file.equality_ids) {
+    writer.Long(field_id);
+  }
+  writer.OptionalLong(file.sort_order_id);
+  writer.OptionalLong(file.first_row_id);
+  writer.Byte(file.referenced_data_file.has_value());
+  if (file.referenced_data_file.has_value()) {
+    writer.String(*file.referenced_data_file);
+  }
+  writer.OptionalLong(file.content_offset);
+  writer.OptionalLong(file.content_size_in_bytes);
+}
+
+Result<std::shared_ptr<DataFile>> ReadDataFile(
+    BinaryReader& reader, const std::vector<std::vector<Literal>>& partitions) {
+  auto file = std::make_shared<DataFile>();
+  ICEBERG_ASSIGN_OR_RAISE(auto content, reader.Byte());
+  ICEBERG_ASSIGN_OR_RAISE(file->content, DataFileContentFromInt(content));
+  ICEBERG_ASSIGN_OR_RAISE(file->file_path, reader.String());
+  ICEBERG_ASSIGN_OR_RAISE(auto format, reader.Byte());
+  if (format > static_cast<uint8_t>(FileFormatType::kPuffin)) {
+    return Invalid("Invalid file format {} in scan task batch", format);
+  }
+  file->file_format = static_cast<FileFormatType>(format);
+  ICEBERG_ASSIGN_OR_RAISE(auto partition_index, reader.Varint());
+  if (partition_index >= partitions.size()) {
+    return Invalid("Invalid partition {} in scan task batch", partition_index);
+  }
+  file->partition = partitions[partition_index];
+  ICEBERG_ASSIGN_OR_RAISE(file->partition_spec_id, reader.Int());
+  ICEBERG_ASSIGN_OR_RAISE(file->record_count, reader.Long());
+  ICEBERG_ASSIGN_OR_RAISE(file->file_size_in_bytes, reader.Long());
+  ICEBERG_ASSIGN_OR_RAISE(file->column_sizes, ReadCountMap(reader));
+  ICEBERG_ASSIGN_OR_RAISE(file->value_counts, ReadCountMap(reader));
+  ICEBERG_ASSIGN_OR_RAISE(file->null_value_counts, ReadCountMap(reader));
+  ICEBERG_ASSIGN_OR_RAISE(file->nan_value_counts, ReadCountMap(reader));
+  ICEBERG_ASSIGN_OR_RAISE(file->lower_bounds, ReadBoundMap(reader));
+  ICEBERG_ASSIGN_OR_RAISE(file->upper_bounds, ReadBoundMap(reader));
+  ICEBERG_ASSIGN_OR_RAISE(auto key_metadata, reader.Bytes());
+  file->key_metadata.assign(key_metadata.begin(), key_metadata.end());
+  ICEBERG_ASSIGN_OR_RAISE(auto offset_count, reader.Count());
+  file->split_offsets.reserve(offset_count);
+  for (size_t i = 0; i < offset_count; ++i) {
+    ICEBERG_ASSIGN_OR_RAISE(auto offset, reader.Long());
+    file->split_offsets.push_back(offset);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto equality_id_count, reader.Count());
+  file->equality_ids.reserve(equality_id_count);
+  for (size_t i = 0; i < equality_id_count; ++i) {
+    ICEBERG_ASSIGN_OR_RAISE(auto field_id, reader.Int());
+    file->equality_ids.push_back(field_id);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto sort_order_id, reader.OptionalLong());
+  if (sort_order_id.has_value()) {
+    file->sort_order_id = static_cast<int32_t>(*sort_order_id);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(file->first_row_id, reader.OptionalLong());
+  ICEBERG_ASSIGN_OR_RAISE(auto has_referenced_data_file, reader.Byte());
+  if (has_referenced_data_file != 0) {
+    ICEBERG_ASSIGN_OR_RAISE(file->referenced_data_file, reader.String());
+  }
+  ICEBERG_ASSIGN_OR_RAISE(file->content_offset, reader.OptionalLong());
+  ICEBERG_ASSIGN_OR_RAISE(file->content_size_in_bytes, reader.OptionalLong());
+  return file;
+}
+
+Result<std::optional<int32_t>> ReadOptionalInt(BinaryReader& reader) {
+  ICEBERG_ASSIGN_OR_RAISE(auto value, reader.OptionalLong());
+  if (!value.has_value()) {
+    return std::nullopt;
+  }
+  if (*value < std::numeric_limits<int32_t>::min() ||
+      *value > std::numeric_limits<int32_t>::max()) {
+    return Invalid("Integer {} out of range in serialized data", *value);
+  }
+  return static_cast<int32_t>(*value);
+}
+
+void WriteOptionalBytes(BinaryWriter& writer,
+                        const std::optional<std::vector<uint8_t>>& bytes) {
+  writer.Byte(bytes.has_value());
+  if (bytes.has_value()) {
+    writer.Bytes(*bytes);
+  }
+}
+
+Result<std::optional<std::vector<uint8_t>>> ReadOptionalBytes(BinaryReader& reader) {
+  ICEBERG_ASSIGN_OR_RAISE(auto has_value, reader.Byte());
+  if (has_value == 0) {
+    return std::nullopt;
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto bytes, reader.Bytes());
+  return std::vector<uint8_t>(bytes.begin(), bytes.end());
+}
+
+void WriteManifestFile(BinaryWriter& writer, const ManifestFile& manifest_file) {
+  writer.String(manifest_file.manifest_path);
+  writer.Long(manifest_file.manifest_length);
+  writer.Long(manifest_file.partition_spec_id);
+  writer.Byte(static_cast<uint8_t>(manifest_file.content));
+  writer.Long(manifest_file.sequence_number);
+  writer.Long(manifest_file.min_sequence_number);
+  writer.Long(manifest_file.added_snapshot_id);
+  writer.OptionalLong(manifest_file.added_files_count);
+  writer.OptionalLong(manifest_file.existing_files_count);
+  writer.OptionalLong(manifest_file.deleted_files_count);
+  writer.OptionalLong(manifest_file.added_rows_count);
+  writer.OptionalLong(manifest_file.existing_rows_count);
+  writer.OptionalLong(manifest_file.deleted_rows_count);
+  writer.Varint(manifest_file.partitions.size());
+  for (const auto& summary : manifest_file.partitions) {
+    writer.Byte(summary.contains_null);
+    writer.Byte(summary.contains_nan.has_value() ? 1 + *summary.contains_nan : 0);
+    WriteOptionalBytes(writer, summary.lower_bound);
+    WriteOptionalBytes(writer, summary.upper_bound);
+  }
+  writer.Bytes(manifest_file.key_metadata);
+  writer.OptionalLong(manifest_file.first_row_id);
+}
+
+Result<ManifestFile> ReadManifestFile(BinaryReader& reader) {
+  ManifestFile manifest_file;
+  ICEBERG_ASSIGN_OR_RAISE(manifest_file.manifest_path, reader.String());
+  ICEBERG_ASSIGN_OR_RAISE(manifest_file.manifest_length, reader.Long());
+  ICEBERG_ASSIGN_OR_RAISE(manifest_file.partition_spec_id, reader.Int());
+  ICEBERG_ASSIGN_OR_RAISE(auto content, reader.Byte());
+  if (content > static_cast<uint8_t>(ManifestFile::Content::kDeletes)) {
+    return Invalid("Invalid manifest content {} in manifest shard", content);
+  }
+  manifest_file.content = static_cast<ManifestFile::Content>(content);
+  ICEBERG_ASSIGN_OR_RAISE(manifest_file.sequence_number, reader.Long());
+  ICEBERG_ASSIGN_OR_RAISE(manifest_file.min_sequence_number, reader.Long());
+  ICEBERG_ASSIGN_OR_RAISE(manifest_file.added_snapshot_id, reader.Long());
+  ICEBERG_ASSIGN_OR_RAISE(manifest_file.added_files_count, ReadOptionalInt(reader));
+  ICEBERG_ASSIGN_OR_RAISE(manifest_file.existing_files_count, ReadOptionalInt(reader));
+  ICEBERG_ASSIGN_OR_RAISE(manifest_file.deleted_files_count, ReadOptionalInt(reader));
+  ICEBERG_ASSIGN_OR_RAISE(manifest_file.added_rows_count, reader.OptionalLong());
+  ICEBERG_ASSIGN_OR_RAISE(manifest_file.existing_rows_count, reader.OptionalLong());
+  ICEBERG_ASSIGN_OR_RAISE(manifest_file.deleted_rows_count, reader.OptionalLong());
+  ICEBERG_ASSIGN_OR_RAISE(auto summary_count, reader.Count());
+  manifest_file.partitions.resize(summary_count);
+  for (auto& summary : manifest_file.partitions) {
+    ICEBERG_ASSIGN_OR_RAISE(auto contains_null, reader.Byte());
+    summary.contains_null = contains_null != 0;
+    ICEBERG_ASSIGN_OR_RAISE(auto contains_nan, reader.Byte());
+    if (contains_nan != 0) {
+      summary.contains_nan = contains_nan == 2;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(summary.lower_bound, ReadOptionalBytes(reader));
+    ICEBERG_ASSIGN_OR_RAISE(summary.upper_bound, ReadOptionalBytes(reader));
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto key_metadata, reader.Bytes());
+  manifest_file.key_metadata.assign(key_metadata.begin(), key_metadata.end());
+  ICEBERG_ASSIGN_OR_RAISE(manifest_file.first_row_id, reader.OptionalLong());
+  return manifest_file;
+}
+
+Result<std::vector<ManifestFile>> ReadManifestFiles(BinaryReader& reader) {
+  ICEBERG_ASSIGN_OR_RAISE(auto count, reader.Count());
+  std::vector<ManifestFile> manifest_files;
+  manifest_files.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    ICEBERG_ASSIGN_OR_RAISE(auto manifest_file, ReadManifestFile(reader));
+    manifest_files.push_back(std::move(manifest_file));
+  }
+  return manifest_files;
+}
+
+/// \brief Writes the tasks of a batch, collecting the partition tuples and the delete
+/// files that they reference into dictionaries.
+class BatchSerializer {
+ public:
+  explicit BatchSerializer(const ScanTaskBatch& batch) : batch_(batch) {}
+
+  Result<std::vector<uint8_t>> Serialize() {
+    BinaryWriter tasks;
+    tasks.Varint(batch_.tasks.size());
+    for (const auto& combined_task : batch_.tasks) {
+      tasks.Varint(combined_task->tasks().size());
+      for (const auto& task : combined_task->tasks()) {
+        ICEBERG_RETURN_UNEXPECTED(WriteTask(tasks, *task));
+      }
+    }
+
+    BinaryWriter out;
+    out.String(kMagic);
+    out.Byte(kFormatVersion);
+    // The table schema and the projected schema are written once when they are the
+    // same, and referenced by their position plus one, 0 for none.
+    std::vector<const Schema*> schemas;
+    auto schema_ref = [&](const std::shared_ptr<Schema>& schema) -> uint64_t {
+      if (schema == nullptr) {
+        return 0;
+      }
+      auto it = std::ranges::find(schemas, schema.get());
+      if (it == schemas.end()) {
+        schemas.push_back(schema.get());
+        it = std::prev(schemas.end());
+      }
+      return std::distance(schemas.begin(), it) + 1;
+    };
+    const uint64_t schema_index = schema_ref(batch_.schema);
+    const uint64_t projected_schema_index = schema_ref(batch_.projected_schema);
+    out.Varint(schemas.size());
+    for (const auto* schema : schemas) {
+      ICEBERG_ASSIGN_OR_RAISE(auto json, ToJsonString(*schema));
+      out.String(json);
+    }
+    out.Varint(schema_index);
+    out.Varint(projected_schema_index);
+    out.Varint(partition_indices_.size());
+    out.Append(partitions_);
+    out.Varint(delete_file_indices_.size());
+    out.Append(delete_files_);
+    out.Append(tasks);
+    return std::move(out).Finish();
+  }
+
+ private:
+  Status WriteTask(BinaryWriter& writer, const FileScanTask& task) {
+    if (dynamic_cast<const ChangelogScanTask*>(&task) != nullptr) {
+      return NotSupported("Cannot serialize changelog scan tasks");
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto partition_index,
+                            PartitionIndex(task.data_file()->partition));
+    WriteDataFile(writer, *task.data_file(), partition_index);
+    writer.Varint(task.delete_files().size());
+    for (const auto& delete_file : task.delete_files()) {
+      ICEBERG_ASSIGN_OR_RAISE(auto delete_file_index, DeleteFileIndex(*delete_file));
+      writer.Varint(delete_file_index);
+    }
+    writer.Long(task.start());
+    writer.Long(task.length());
+    writer.Byte(task.projected_file_size().has_value());
+    if (task.projected_file_size().has_value()) {
+      writer.Long(*task.projected_file_size());
+    }
+    writer.Byte(task.row_group_sample().has_value());
+    if (task.row_group_sample().has_value()) {
+      writer.Long(std::bit_cast<int64_t>(task.row_group_sample()->fraction));
+      writer.Varint(task.row_group_sample()->seed);
+    }
+    writer.Byte(task.residual() != nullptr);
+    if (task.residual() != nullptr) {
+      if (batch_.schema == nullptr) {
+        return InvalidArgument("Cannot serialize a residual without the table schema");
+      }
+      ICEBERG_ASSIGN_OR_RAISE(auto residual, SerializeExpression(*task.residual()));
+      writer.Bytes(residual);
+    }
+    return {};
+  }
+
+  Result<size_t> PartitionIndex(const std::vector<Literal>& partition) {
+    BinaryWriter tuple;
+    tuple.Varint(partition.size());
+    for (const auto& value : partition) {
+      ICEBERG_RETURN_UNEXPECTED(WriteBinaryLiteral(tuple, value));
+    }
+    const auto& bytes = tuple.bytes();
+    auto [it, inserted] = partition_indices_.try_emplace(
+        std::string(bytes.begin(), bytes.end()), partition_indices_.size());
+    if (inserted) {
+      partitions_.Append(tuple);
+    }
+    return it->second;
+  }
+
+  Result<size_t> DeleteFileIndex(const DataFile& delete_file) {
+    auto [it, inserted] =
+        delete_file_indices_.try_emplace(&delete_file, delete_file_indices_.size());
+    if (inserted) {
+      ICEBERG_ASSIGN_OR_RAISE(auto partition_index,
+                              PartitionIndex(delete_file.partition));
+      WriteDataFile(delete_files_, delete_file, partition_index);
+    }
+    return it->second;
+  }
+
+  const ScanTaskBatch& batch_;
+  /// \brief Serialized partition tuples, each written once.
+  BinaryWriter partitions_;
+  std::unordered_map<std::string, size_t> partition_indices_;
+  /// \brief Serialized delete files, each written once however many tasks share it.
+  BinaryWriter delete_files_;
+  std::unordered_map<const DataFile*, size_t> delete_file_indices_;
+};
+
+Result<std::shared_ptr<Schema>> ReadSchemaRef(
+    BinaryReader& reader, const std::vector<std::shared_ptr<Schema>>& schemas) {
+  ICEBERG_ASSIGN_OR_RAISE(auto schema_ref, reader.Varint());
+  if (schema_ref > schemas.size()) {
+    return Invalid("Invalid schema {} in scan task batch", schema_ref);
+  }
+  return schema_ref == 0 ? nullptr : schemas[schema_ref - 1];
+}
+
+}  // namespace
+
+Result<std::vector<uint8_t>> SerializeScanTasks(const ScanTaskBatch& batch) {
+  return BatchSerializer(batch).Serialize();
+}
+
+Result<ScanTaskBatch> DeserializeScanTasks(std::span<const uint8_t> data) {
+  BinaryReader reader(data);
+  ICEBERG_ASSIGN_OR_RAISE(auto magic, reader.String());
+  if (magic != kMagic) {
+    return Invalid("Not a scan task batch");
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto version, reader.Byte());
+  if (version != kFormatVersion) {
+    return NotSupported("Unsupported scan task batch version {}", version);
+  }
+
+  ICEBERG_ASSIGN_OR_RAISE(auto schema_count, reader.Count());
+  std::vector<std::shared_ptr<Schema>> schemas;
+  schemas.reserve(schema_count);
+  for (size_t i = 0; i < schema_count; ++i) {
+    ICEBERG_ASSIGN_OR_RAISE(auto json_string, reader.String());
+    ICEBERG_ASSIGN_OR_RAISE(auto json, FromJsonString(json_string));
+    ICEBERG_ASSIGN_OR_RAISE(auto schema, SchemaFromJson(json));
+    schemas.push_back(std::move(schema));
+  }
+  ScanTaskBatch batch;
+  ICEBERG_ASSIGN_OR_RAISE(batch.schema, ReadSchemaRef(reader, schemas));
+  ICEBERG_ASSIGN_OR_RAISE(batch.projected_schema, ReadSchemaRef(reader, schemas));
+
+  ICEBERG_ASSIGN_OR_RAISE(auto partition_count, reader.Count());
+  std::vector<std::vector<Literal>> partitions(partition_count);
+  for (auto& partition : partitions) {
+    ICEBERG_ASSIGN_OR_RAISE(auto size, reader.Count());
+    partition.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+      ICEBERG_ASSIGN_OR_RAISE(auto value, ReadBinaryLiteral(reader));
+      partition.push_back(std::move(value));
+    }
+  }
+
+  ICEBERG_ASSIGN_OR_RAISE(auto delete_file_count, reader.Count());
+  std::vector<std::shared_ptr<DataFile>> delete_files;
+  delete_files.reserve(delete_file_count);
+  for (size_t i = 0; i < delete_file_count; ++i) {
+    ICEBERG_ASSIGN_OR_RAISE(auto delete_file, ReadDataFile(reader, partitions));
+    delete_files.push_back(std::move(delete_file));
+  }
+
+  ICEBERG_ASSIGN_OR_RAISE(auto combined_task_count, reader.Count());
+  batch.tasks.reserve(combined_task_count);
+  for (size_t i = 0; i < combined_task_count; ++i) {
+    ICEBERG_ASSIGN_OR_RAISE(auto task_count, reader.Count());
+    std::vector<std::shared_ptr<FileScanTask>> tasks;
+    tasks.reserve(task_count);
+    for (size_t j = 0; j < task_count; ++j) {
+      ICEBERG_ASSIGN_OR_RAISE(auto data_file, ReadDataFile(reader, partitions));
+      ICEBERG_ASSIGN_OR_RAISE(auto task_delete_count, reader.Count());
+      std::vector<std::shared_ptr<DataFile>> task_deletes;
+      task_deletes.reserve(task_delete_count);
+      for (size_t k = 0; k < task_delete_count; ++k) {
+        ICEBERG_ASSIGN_OR_RAISE(auto delete_index, reader.Varint());
+        if (delete_index >= delete_files.size()) {
+          return Invalid("Invalid delete file {} in scan task batch", delete_index);
+        }
+        task_deletes.push_back(delete_files[delete_index]);
+      }
+      ICEBERG_ASSIGN_OR_RAISE(auto start, reader.Long());
+      ICEBERG_ASSIGN_OR_RAISE(auto length, reader.Long());
+      std::optional<int64_t> projected_file_size;
+      ICEBERG_ASSIGN_OR_RAISE(auto has_projected_file_size, reader.Byte());
+      if (has_projected_file_size != 0) {
+        ICEBERG_ASSIGN_OR_RAISE(projected_file_size, reader.Long());
+      }
+      std::optional<RowGroupSample> row_group_sample;
+      ICEBERG_ASSIGN_OR_RAISE(auto has_row_group_sample, reader.Byte());
+      if (has_row_group_sample != 0) {
+        ICEBERG_ASSIGN_OR_RAISE(auto fraction, reader.Long());
+        ICEBERG_ASSIGN_OR_RAISE(auto seed, reader.Varint());
+        row_group_sample = RowGroupSample{.fraction = std::bit_cast<double>(fraction),
+                                          .seed = static_cast<uint32_t>(seed)};
+      }
+      std::shared_ptr<Expression> residual;
+      ICEBERG_ASSIGN_OR_RAISE(auto has_residual, reader.Byte());
+      if (has_residual != 0) {
+        if (batch.schema == nullptr) {
+          return Invalid("Scan task batch has a residual but no schema");
+        }
+        ICEBERG_ASSIGN_OR_RAISE(auto residual_bytes, reader.Bytes());
+        ICEBERG_ASSIGN_OR_RAISE(
+            residual, DeserializeExpression(residual_bytes, batch.schema.get()));
+      }
+      auto task = std::make_shared<FileScanTask>(
+          std::move(data_file), std::move(task_deletes), /*delete_loader=*/nullptr,
+          std::move(residual), /*memory_pool=*/nullptr, /*executor=*/nullptr,
+          /*io_executor=*/nullptr, projected_file_size);
+      if (start != task->start() || length != task->length()) {
+        task = task->Slice(start, length);
+      }
+      if (row_group_sample.has_value()) {
+        task = task->SampleRowGroups(*row_group_sample);
+      }
+      tasks.push_back(std::move(task));
+    }
+    batch.tasks.push_back(std::make_shared<CombinedScanTask>(std::move(tasks)));
+  }
+  if (!reader.AtEnd()) {
+    return Invalid("Unexpected data at the end of the scan task batch");
+  }
+  return batch;
+}
+
+Result<std::vector<uint8_t>> SerializeManifestShard(const ManifestShard& shard) {
+  BinaryWriter out;
+  out.String(kShardMagic);
+  out.Byte(kShardFormatVersion);
+  out.Long(shard.snapshot_id);
+  for (const auto* manifest_files : {&shard.data_manifests, &shard.delete_manifests}) {
+    out.Varint(manifest_files->size());
+    for (const auto& manifest_file : *manifest_files) {
+      WriteManifestFile(out, manifest_file);
+    }
+  }
+  return std::move(out).Finish();
+}
+
+Result<ManifestShard> DeserializeManifestShard(std::span<const uint8_t> data) {
+  BinaryReader reader(data);
+  ICEBERG_ASSIGN_OR_RAISE(auto magic, reader.String());
+  if (magic != kShardMagic) {
+    return Invalid("Not a manifest shard");
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto version, reader.Byte());
+  if (version != kShardFormatVersion) {
+    return NotSupported("Unsupported manifest shard version {}", version);
+  }
+  ManifestShard shard;
+  ICEBERG_ASSIGN_OR_RAISE(shard.snapshot_id, reader.Long());
+  ICEBERG_ASSIGN_OR_RAISE(shard.data_manifests, ReadManifestFiles(reader));
+  ICEBERG_ASSIGN_OR_RAISE(shard.delete_manifests, ReadManifestFiles(reader));
+  if (!reader.AtEnd()) {
+    return Invalid("Unexpected data at the end of the manifest shard");
+  }
+  return shard;
+}
+
+}  // namespace iceberg
@@ -0,0 +1,84 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/scan_task_serialization.h
+/// A compact binary form of planned scan tasks and of manifest shards, to read or
+/// plan them on other processes.
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief Scan tasks planned by one process to be read by others.
+struct ICEBERG_EXPORT ScanTaskBatch {
+  /// \brief The schema that the residuals of the tasks are bound to, the table schema
+  /// of the scan. Required when a task has a residual.
+  std::shared_ptr<Schema> schema;
+  /// \brief The schema read by the tasks, or null.
+  std::shared_ptr<Schema> projected_schema;
+  /// \brief The tasks, each meant to be read by one worker.
+  std::vector<std::shared_ptr<CombinedScanTask>> tasks;
+};
+
+/// \brief Serializes a batch of scan tasks.
+///
+/// The data files, delete files, residuals, byte ranges, projected file sizes and row
+/// group samples of the tasks are written in a versioned binary form. The schemas, the
+/// partition tuples and the delete files are written once in dictionaries referenced by
+/// the tasks, so that a batch of tasks does not repeat them. The delete loader, memory
+/// pool and executors of the tasks are local to the process and are not written.
+/// Changelog tasks are not supported.
+/// \param batch The tasks to serialize.
+/// \return A Result containing the serialized batch or an error.
+ICEBERG_EXPORT Result<std::vector<uint8_t>> SerializeScanTasks(
+    const ScanTaskBatch& batch);
+
+/// \brief Restores a batch of scan tasks written by SerializeScanTasks.
+///
+/// The residuals are bound to the restored schema of the batch, and the tasks that
+/// share a delete file share the restored file.
+/// \param data The serialized batch.
+/// \return A Result containing the batch or an error if the data is not a valid batch.
+ICEBERG_EXPORT Result<ScanTaskBatch> DeserializeScanTasks(std::span<const uint8_t> data);
+
+/// \brief Serializes a manifest shard returned by TableScan::PlanShards().
+///
+/// The manifests are written with their counts and partition summaries in a versioned
+/// binary form.
+/// \param shard The shard to serialize.
+/// \return A Result containing the serialized shard or an error.
+ICEBERG_EXPORT Result<std::vector<uint8_t>> SerializeManifestShard(
+    const ManifestShard& shard);
+
+/// \brief Restores a manifest shard written by SerializeManifestShard.
+/// \param data The serialized shard.
+/// \return A Result containing the shard or an error if the data is not a valid shard.
+ICEBERG_EXPORT Result<ManifestShard> DeserializeManifestShard(
+    std::span<const uint8_t> data);
+
+}  // namespace iceberg
@@ -0,0 +1,142 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/scan_task_spill.h"
+
+#include <map>
+#include <type_traits>
+#include <utility>
+
+#include "iceberg/manifest_entry.h"
+#include "iceberg/scan_task_serialization.h"
+#include "iceberg/table_scan.h"
+#include "iceberg/util/macros.h"
+#include "iceberg/util/spill_file_internal.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief Approximate bookkeeping overhead of a node of a std::map.
+constexpr int64_t kMapNodeOverhead = 4 * sizeof(void*);
+
+template <typename T>
+int64_t VectorSize(const std::vector<T>& values) {
+  return static_cast<int64_t>(values.capacity() * sizeof(T));
+}
+
+template <typename V>
+int64_t MapSize(const std::map<int32_t, V>& values) {
+  int64_t size = static_cast<int64_t>(values.size() *
+                                      (sizeof(std::pair<const int32_t, V>) +
+                                       kMapNodeOverhead));
+  if constexpr (std::is_same_v<V, std::vector<uint8_t>>) {
+    for (const auto& [_, value] : values) {
+      size += VectorSize(value);
+    }
+  }
+  return size;
+}
+
+/// \brief Estimates the memory held by a task and its data file. The delete files are
+/// shared by the tasks of a scan and are not counted.
+int64_t EstimateSize(const FileScanTask& task) {
+  const auto& data_file = *task.data_file();
+  return sizeof(FileScanTask) + VectorSize(task.delete_files()) + sizeof(DataFile) +
+         static_cast<int64_t>(data_file.file_path.capacity()) +
+         VectorSize(data_file.partition) + MapSize(data_file.column_sizes) +
+         MapSize(data_file.value_counts) + MapSize(data_file.null_value_counts) +
+         MapSize(data_file.nan_value_counts) + MapSize(data_file.lower_bounds) +
+         MapSize(data_file.upper_bounds) + VectorSize(data_file.split_offsets);
+}
+
+int64_t EstimateSize(const CombinedScanTask& task) {
+  int64_t size = sizeof(CombinedScanTask) + VectorSize(task.tasks());
+  for (const auto& file_task : task.tasks()) {
+    size += EstimateSize(*file_task);
+  }
+  return size;
+}
+
+}  // namespace
+
+ScanTaskSpill::ScanTaskSpill(SpillOptions options, std::shared_ptr<Schema> schema,
+                             std::shared_ptr<Schema> projected_schema)
+    : options_(std::move(options)),
+      schema_(std::move(schema)),
+      projected_schema_(std::move(projected_schema)) {}
+
+ScanTaskSpill::~ScanTaskSpill() = default;
+
+Result<std::unique_ptr<ScanTaskSpill>> ScanTaskSpill::Make(
+    SpillOptions options, std::shared_ptr<Schema> schema,
+    std::shared_ptr<Schema> projected_schema) {
+  if (options.memory_budget_bytes <= 0) {
+    return InvalidArgument("Spill memory budget must be positive, got {}",
+                           options.memory_budget_bytes);
+  }
+  return std::unique_ptr<ScanTaskSpill>(
+      new ScanTaskSpill(std::move(options), std::move(schema),
+                        std::move(projected_schema)));
+}
+
+Status ScanTaskSpill::Add(std::shared_ptr<CombinedScanTask> task) {
+  buffered_bytes_ += EstimateSize(*task);
+  buffered_.push_back(std::move(task));
+  ++task_count_;
+  if (buffered_bytes_ > options_.memory_budget_bytes) {
+    ICEBERG_RETURN_UNEXPECTED(Spill());
+  }
+  return {};
+}
+
+Status ScanTaskSpill::Spill() {
+  ICEBERG_ASSIGN_OR_RAISE(auto data,
+                          SerializeScanTasks({.schema = schema_,
+                                              .projected_schema = projected_schema_,
+                                              .tasks = buffered_}));
+  if (file_ == nullptr) {
+    ICEBERG_ASSIGN_OR_RAISE(file_, SpillFile::Make(options_.directory, "scan-tasks"));
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto offset, file_->Append(data));
+  offsets_.push_back(offset);
+  buffered_.clear();
+  buffered_bytes_ = 0;
+  return {};
+}
+
+Status ScanTaskSpill::ForEach(const Callback& callback) const {
+  for (int64_t offset : offsets_) {
+    ICEBERG_ASSIGN_OR_RAISE(auto data, file_->Read(offset));
+    ICEBERG_ASSIGN_OR_RAISE(auto batch, DeserializeScanTasks(data));
+    for (auto& task : batch.tasks) {
+      ICEBERG_RETURN_UNEXPECTED(callback(std::move(task)));
+    }
+  }
+  for (const auto& task : buffered_) {
+    ICEBERG_RETURN_UNEXPECTED(callback(task));
+  }
+  return {};
+}
+
+int64_t ScanTaskSpill::spilled_bytes() const {
+  return file_ != nullptr ? file_->size_bytes() : 0;
+}
+
+}  // namespace iceberg
@@ -0,0 +1,104 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/scan_task_spill.h
+/// Planned scan tasks held within a memory budget by spilling them to local disk.
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/spill_options.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+class SpillFile;
+
+/// \brief The planned tasks of a scan, spilled to a local file beyond a memory budget.
+///
+/// Tasks are buffered in memory until they hold more than the memory budget, then the
+/// buffered tasks are appended to a spill file in the compact form written by
+/// SerializeScanTasks. ForEach() reads them back one spilled batch at a time, so that
+/// the tasks of the largest scans can be planned and then consumed with about the
+/// budget of memory. The spill file is removed when the object is destroyed.
+///
+/// Tasks read back from the spill file are like the tasks of DeserializeScanTasks:
+/// they have no delete loader, memory pool or executors.
+class ICEBERG_EXPORT ScanTaskSpill {
+ public:
+  /// \brief Callback receiving the tasks in the order they were added.
+  using Callback = std::function<Status(std::shared_ptr<CombinedScanTask>)>;
+
+  /// \brief Creates an empty spill of the tasks of a scan.
+  /// \param options The directory of the spill file and the memory budget, which
+  /// must be positive.
+  /// \param schema The table schema of the scan, which the residuals are bound to.
+  /// \param projected_schema The schema read by the tasks.
+  /// \return A Result containing the spill or an error.
+  static Result<std::unique_ptr<ScanTaskSpill>> Make(
+      SpillOptions options, std::shared_ptr<Schema> schema,
+      std::shared_ptr<Schema> projected_schema);
+
+  ~ScanTaskSpill();
+
+  ScanTaskSpill(const ScanTaskSpill&) = delete;
+  ScanTaskSpill& operator=(const ScanTaskSpill&) = delete;
+
+  /// \brief Adds a task, spilling the buffered tasks once they exceed the budget.
+  Status Add(std::shared_ptr<CombinedScanTask> task);
+
+  /// \brief Passes the tasks to a callback in the order they were added, reading the
+  /// spilled ones back. An error returned by the callback stops the iteration.
+  Status ForEach(const Callback& callback) const;
+
+  /// \brief The number of tasks added.
+  int64_t task_count() const { return task_count_; }
+
+  /// \brief The size in bytes of the spill file, 0 if no task was spilled.
+  int64_t spilled_bytes() const;
+
+  /// \brief The estimated memory in bytes of the tasks buffered in memory.
+  int64_t buffered_bytes() const { return buffered_bytes_; }
+
+ private:
+  ScanTaskSpill(SpillOptions options, std::shared_ptr<Schema> schema,
+                std::shared_ptr<Schema> projected_schema);
+
+  /// \brief Appends the buffered tasks to the spill file.
+  Status Spill();
+
+  const SpillOptions options_;
+  std::shared_ptr<Schema> schema_;
+  std::shared_ptr<Schema> projected_schema_;
+  std::vector<std::shared_ptr<CombinedScanTask>> buffered_;
+  int64_t buffered_bytes_ = 0;
+  int64_t task_count_ = 0;
+  /// \brief The spill file, created when the tasks are first spilled.
+  std::unique_ptr<SpillFile> file_;
+  /// \brief The offsets of the spilled batches in the spill file.
+  std::vector<int64_t> offsets_;
+};
+
+}  // namespace iceberg
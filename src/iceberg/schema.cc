@@ -19,8 +19,14 @@
 
 #include "iceberg/schema.h"
 
+#include <algorithm>
+#include <bit>
 #include <format>
 #include <functional>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <utility>
 
 #include "iceberg/schema_internal.h"
 #include "iceberg/type.h"
@@ -30,18 +36,6 @@
 
 namespace iceberg {
 
-class IdToFieldVisitor {
- public:
-  explicit IdToFieldVisitor(
-      std::unordered_map<int32_t, std::reference_wrapper<const SchemaField>>&
-          id_to_field);
-  Status Visit(const PrimitiveType& type);
-  Status Visit(const NestedType& type);
-
- private:
-  std::unordered_map<int32_t, std::reference_wrapper<const SchemaField>>& id_to_field_;
-};
-
 class NameToIdVisitor {
  public:
   explicit NameToIdVisitor(
@@ -56,6 +50,8 @@ class NameToIdVisitor {
                const std::string& short_path);
   Status Visit(const PrimitiveType& type, const std::string& path,
                const std::string& short_path);
+  Status Visit(const VariantType& type, const std::string& path,
+               const std::string& short_path);
   void Finish();
 
  private:
@@ -69,9 +65,6 @@ class NameToIdVisitor {
   std::function<std::string(std::string_view)> quoting_func_;
 };
 
-Schema::Schema(std::vector<SchemaField> fields, std::optional<int32_t> schema_id)
-    : StructType(std::move(fields)), schema_id_(schema_id) {}
-
 std::optional<int32_t> Schema::schema_id() const { return schema_id_; }
 
 std::string Schema::ToString() const {
@@ -87,80 +80,264 @@ bool Schema::Equals(const Schema& other) const {
   return schema_id_ == other.schema_id_ && fields_ == other.fields_;
 }
 
-Result<std::optional<std::reference_wrapper<const SchemaField>>> Schema::FindFieldByName(
-    std::string_view name, bool case_sensitive) const {
-  if (case_sensitive) {
-    ICEBERG_ASSIGN_OR_RAISE(auto name_to_id, name_to_id_.Get(*this));
-    auto it = name_to_id.get().find(name);
-    if (it == name_to_id.get().end()) {
+namespace {
+
+/// \brief An open-addressing hash table from names to field ids.
+///
+/// The names are interned in a single buffer and the table holds indexes into the
+/// entries, so that a lookup touches a few contiguous cache lines instead of chasing
+/// the nodes of a std::unordered_map.
+class FlatNameTable {
+ public:
+  void Build(
+      const std::unordered_map<std::string, int32_t, StringHash, std::equal_to<>>&
+          name_to_id) {
+    size_t names_size = 0;
+    for (const auto& entry : name_to_id) {
+      names_size += entry.first.size();
+    }
+    names_.reserve(names_size);
+    entries_.reserve(name_to_id.size());
+    for (const auto& [name, field_id] : name_to_id) {
+      entries_.push_back({.hash = StringHash{}(name),
+                          .offset = static_cast<uint32_t>(names_.size()),
+                          .length = static_cast<uint32_t>(name.size()),
+                          .field_id = field_id});
+      names_.append(name);
+    }
+
+    // At most half full, so that probe sequences stay short.
+    slots_.assign(std::bit_ceil(std::max<size_t>(8, 2 * entries_.size())), kEmptySlot);
+    const size_t mask = slots_.size() - 1;
+    for (uint32_t entry = 0; entry < entries_.size(); ++entry) {
+      size_t slot = entries_[entry].hash & mask;
+      while (slots_[slot] != kEmptySlot) {
+        slot = (slot + 1) & mask;
+      }
+      slots_[slot] = entry;
+    }
+  }
+
+  std::optional<int32_t> Find(std::string_view name) const {
+    if (slots_.empty()) {
       return std::nullopt;
-    };
-    return FindFieldById(it->second);
+    }
+    const size_t hash = StringHash{}(name);
+    const size_t mask = slots_.size() - 1;
+    for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+      const uint32_t entry = slots_[slot];
+      if (entry == kEmptySlot) {
+        return std::nullopt;
+      }
+      const auto& candidate = entries_[entry];
+      if (candidate.hash == hash &&
+          name == std::string_view(names_).substr(candidate.offset, candidate.length)) {
+        return candidate.field_id;
+      }
+    }
   }
-  ICEBERG_ASSIGN_OR_RAISE(auto lowercase_name_to_id, lowercase_name_to_id_.Get(*this));
-  auto it = lowercase_name_to_id.get().find(StringUtils::ToLower(name));
-  if (it == lowercase_name_to_id.get().end()) {
-    return std::nullopt;
+
+ private:
+  static constexpr uint32_t kEmptySlot = std::numeric_limits<uint32_t>::max();
+
+  struct Entry {
+    size_t hash;
+    uint32_t offset;
+    uint32_t length;
+    int32_t field_id;
+  };
+
+  std::string names_;
+  std::vector<Entry> entries_;
+  std::vector<uint32_t> slots_;
+};
+
+}  // namespace
+
+/// \brief The fields of a schema by id, and the field ids by name.
+///
+/// Built once per schema, as the schema is immutable. The errors of an invalid schema
+/// are kept, and returned by the lookups that need the part of the index they affect.
+struct Schema::Index {
+  struct Field {
+    int32_t field_id;
+    /// The id of the field this field is nested in, or kInvalidColumnId.
+    int32_t parent_id;
+    /// The field, owned by the schema or by the type of its parent field.
+    const SchemaField* field;
+    /// The canonical name of the field, in column_names.
+    uint32_t name_offset;
+    uint32_t name_length;
+  };
+
+  Status id_status;
+  /// The fields of the schema, sorted by id.
+  std::vector<Field> fields;
+  /// The position in `fields` of each id, or -1, when the ids are dense enough for a
+  /// direct lookup instead of a binary search.
+  std::vector<int32_t> dense_positions;
+  std::string column_names;
+
+  /// The projections of SelectFieldIds, by sorted set of ids.
+  mutable std::mutex projections_mutex;
+  mutable std::map<std::vector<int32_t>, std::shared_ptr<Schema>> projections;
+
+  Status name_status;
+  FlatNameTable names;
+  Status lowercase_name_status;
+  FlatNameTable lowercase_names;
+
+  static std::unique_ptr<const Index> Make(const Schema& schema) {
+    auto index = std::make_unique<Index>();
+    index->AddFields(schema, kInvalidColumnId, /*parent_name=*/"");
+    index->IndexIds();
+
+    std::unordered_map<std::string, int32_t, StringHash, std::equal_to<>> name_to_id;
+    NameToIdVisitor visitor(name_to_id, /*case_sensitive=*/true);
+    index->name_status =
+        VisitTypeInline(schema, &visitor, /*path=*/"", /*short_path=*/"");
+    if (index->name_status.has_value()) {
+      visitor.Finish();
+      index->names.Build(name_to_id);
+    }
+
+    std::unordered_map<std::string, int32_t, StringHash, std::equal_to<>>
+        lowercase_name_to_id;
+    NameToIdVisitor lowercase_visitor(lowercase_name_to_id, /*case_sensitive=*/false);
+    index->lowercase_name_status = VisitTypeInline(schema, &lowercase_visitor,
+                                                   /*path=*/"", /*short_path=*/"");
+    if (index->lowercase_name_status.has_value()) {
+      lowercase_visitor.Finish();
+      index->lowercase_names.Build(lowercase_name_to_id);
+    }
+    return index;
   }
-  return FindFieldById(it->second);
-}
 
-Result<std::unordered_map<int32_t, std::reference_wrapper<const SchemaField>>>
-Schema::InitIdToFieldMap(const Schema& self) {
-  std::unordered_map<int32_t, std::reference_wrapper<const SchemaField>> id_to_field;
-  IdToFieldVisitor visitor(id_to_field);
-  ICEBERG_RETURN_UNEXPECTED(VisitTypeInline(self, &visitor));
-  return id_to_field;
-}
+  const Field* Find(int32_t field_id) const {
+    if (!dense_positions.empty()) {
+      if (field_id < 0 || std::cmp_greater_equal(field_id, dense_positions.size())) {
+        return nullptr;
+      }
+      const int32_t pos = dense_positions[field_id];
+      return pos < 0 ? nullptr : &fields[pos];
+    }
+    auto it = std::ranges::lower_bound(fields, field_id, {}, &Field::field_id);
+    return it == fields.end() || it->field_id != field_id ? nullptr : &*it;
+  }
 
-Result<std::unordered_map<std::string, int32_t, StringHash, std::equal_to<>>>
-Schema::InitNameToIdMap(const Schema& self) {
-  std::unordered_map<std::string, int32_t, StringHash, std::equal_to<>> name_to_id;
-  NameToIdVisitor visitor(name_to_id, /*case_sensitive=*/true);
-  ICEBERG_RETURN_UNEXPECTED(
-      VisitTypeInline(self, &visitor, /*path=*/"", /*short_path=*/""));
-  visitor.Finish();
-  return name_to_id;
+  std::string_view ColumnName(const Field& field) const {
+    return std::string_view(column_names).substr(field.name_offset, field.name_length);
+  }
+
+ private:
+  void AddFields(const NestedType& type, int32_t parent_id,
+                 std::string_view parent_name) {
+    for (const auto& field : type.fields()) {
+      const auto name_offset = static_cast<uint32_t>(column_names.size());
+      if (!parent_name.empty()) {
+        column_names.append(parent_name).push_back('.');
+      }
+      column_names.append(field.name());
+      const auto name_length = static_cast<uint32_t>(column_names.size() - name_offset);
+      fields.push_back({.field_id = field.field_id(),
+                        .parent_id = parent_id,
+                        .field = &field,
+                        .name_offset = name_offset,
+                        .name_length = name_length});
+      if (field.type()->is_nested()) {
+        // Copied, as appending the names of the nested fields may move the buffer.
+        std::string name(std::string_view(column_names).substr(name_offset, name_length));
+        AddFields(internal::checked_cast<const NestedType&>(*field.type()),
+                  field.field_id(), name);
+      }
+    }
+  }
+
+  void IndexIds() {
+    std::ranges::stable_sort(fields, {}, &Field::field_id);
+    auto duplicate = std::ranges::adjacent_find(
+        fields, [](const Field& lhs, const Field& rhs) {
+          return lhs.field_id == rhs.field_id;
+        });
+    if (duplicate != fields.end()) {
+      id_status = InvalidSchema("Duplicate field id found: {}", duplicate->field_id);
+      return;
+    }
+    // Field ids are usually assigned sequentially, so a direct table is only a few
+    // times larger than the number of fields.
+    if (!fields.empty() && fields.front().field_id >= 0 &&
+        std::cmp_less(fields.back().field_id, 4 * fields.size() + 64)) {
+      dense_positions.assign(static_cast<size_t>(fields.back().field_id) + 1, -1);
+      for (size_t pos = 0; pos < fields.size(); ++pos) {
+        dense_positions[fields[pos].field_id] = static_cast<int32_t>(pos);
+      }
+    }
+  }
+};
+
+Schema::Schema(std::vector<SchemaField> fields, std::optional<int32_t> schema_id)
+    : StructType(std::move(fields)), schema_id_(schema_id) {}
+
+Schema::~Schema() = default;
+
+const Schema::Index& Schema::index() const {
+  if (const Index* index = index_.load(std::memory_order_acquire); index != nullptr)
+      [[likely]] {
+    return *index;
+  }
+  std::call_once(index_once_, [this]() {
+    index_owner_ = Index::Make(*this);
+    index_.store(index_owner_.get(), std::memory_order_release);
+  });
+  return *index_owner_;
 }
 
-Result<std::unordered_map<std::string, int32_t, StringHash, std::equal_to<>>>
-Schema::InitLowerCaseNameToIdMap(const Schema& self) {
-  std::unordered_map<std::string, int32_t, StringHash, std::equal_to<>>
-      lowercase_name_to_id;
-  NameToIdVisitor visitor(lowercase_name_to_id, /*case_sensitive=*/false);
-  ICEBERG_RETURN_UNEXPECTED(
-      VisitTypeInline(self, &visitor, /*path=*/"", /*short_path=*/""));
-  visitor.Finish();
-  return lowercase_name_to_id;
+Result<std::optional<std::reference_wrapper<const SchemaField>>> Schema::FindFieldByName(
+    std::string_view name, bool case_sensitive) const {
+  const auto& index = this->index();
+  std::optional<int32_t> field_id;
+  if (case_sensitive) {
+    ICEBERG_RETURN_UNEXPECTED(index.name_status);
+    field_id = index.names.Find(name);
+  } else {
+    ICEBERG_RETURN_UNEXPECTED(index.lowercase_name_status);
+    field_id = index.lowercase_names.Find(StringUtils::ToLower(name));
+  }
+  if (!field_id.has_value()) {
+    return std::nullopt;
+  }
+  return FindFieldById(*field_id);
 }
 
 Result<std::optional<std::reference_wrapper<const SchemaField>>> Schema::FindFieldById(
     int32_t field_id) const {
-  ICEBERG_ASSIGN_OR_RAISE(auto id_to_field, id_to_field_.Get(*this));
-  auto it = id_to_field.get().find(field_id);
-  if (it == id_to_field.get().end()) {
+  const auto& index = this->index();
+  ICEBERG_RETURN_UNEXPECTED(index.id_status);
+  const auto* field = index.Find(field_id);
+  if (field == nullptr) {
     return std::nullopt;
   }
-  return it->second;
+  return std::cref(*field->field);
 }
 
-IdToFieldVisitor::IdToFieldVisitor(
-    std::unordered_map<int32_t, std::reference_wrapper<const SchemaField>>& id_to_field)
-    : id_to_field_(id_to_field) {}
-
-Status IdToFieldVisitor::Visit(const PrimitiveType& type) { return {}; }
+Result<std::optional<std::string_view>> Schema::FindColumnName(int32_t field_id) const {
+  const auto& index = this->index();
+  ICEBERG_RETURN_UNEXPECTED(index.id_status);
+  const auto* field = index.Find(field_id);
+  if (field == nullptr) {
+    return std::nullopt;
+  }
+  return index.ColumnName(*field);
+}
 
-Status IdToFieldVisitor::Visit(const NestedType& type) {
-  const auto& nested = internal::checked_cast<const NestedType&>(type);
-  const auto& fields = nested.fields();
-  for (const auto& field : fields) {
-    auto it = id_to_field_.try_emplace(field.field_id(), std::cref(field));
-    if (!it.second) {
-      return InvalidSchema("Duplicate field id found: {}", field.field_id());
-    }
-    ICEBERG_RETURN_UNEXPECTED(VisitTypeInline(*field.type(), this));
+Result<std::optional<int32_t>> Schema::FindParentId(int32_t field_id) const {
+  const auto& index = this->index();
+  ICEBERG_RETURN_UNEXPECTED(index.id_status);
+  const auto* field = index.Find(field_id);
+  if (field == nullptr || field->parent_id == kInvalidColumnId) {
+    return std::nullopt;
   }
-  return {};
+  return field->parent_id;
 }
 
 NameToIdVisitor::NameToIdVisitor(
@@ -239,6 +416,11 @@ Status NameToIdVisitor::Visit(const PrimitiveType& type, const std::string& path
   return {};
 }
 
+Status NameToIdVisitor::Visit(const VariantType& type, const std::string& path,
+                              const std::string& short_path) {
+  return {};
+}
+
 std::string NameToIdVisitor::BuildPath(std::string_view prefix,
                                        std::string_view field_name, bool case_sensitive) {
   std::string quoted_name;
@@ -289,7 +471,7 @@ class PruneColumnVisitor {
 
   Result<std::shared_ptr<Type>> Visit(const SchemaField& field) const {
     if (selected_ids_.contains(field.field_id())) {
-      return (select_full_types_ || field.type()->is_primitive()) ? field.type()
+      return (select_full_types_ || !field.type()->is_nested()) ? field.type()
                                                                   : Visit(field.type());
     }
     return Visit(field.type());
@@ -404,4 +586,44 @@ Result<std::unique_ptr<Schema>> Schema::Project(
                         std::nullopt);
 }
 
+Result<std::shared_ptr<Schema>> Schema::SelectFieldIds(
+    std::span<const int32_t> field_ids) const {
+  // Beyond this many distinct projections, the cache is dropped rather than grown.
+  constexpr size_t kMaxCachedProjections = 64;
+
+  std::vector<int32_t> key(field_ids.begin(), field_ids.end());
+  std::ranges::sort(key);
+  key.erase(std::ranges::unique(key).begin(), key.end());
+
+  const auto& index = this->index();
+  {
+    std::lock_guard lock(index.projections_mutex);
+    if (auto it = index.projections.find(key); it != index.projections.end()) {
+      return it->second;
+    }
+  }
+
+  const std::unordered_set<int32_t> selected_ids(key.begin(), key.end());
+  PruneColumnVisitor visitor(selected_ids, /*select_full_types=*/true);
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto pruned_type, visitor.Visit(std::shared_ptr<StructType>(ToStructType(*this))));
+  std::shared_ptr<Schema> projection;
+  if (!pruned_type) {
+    projection = std::make_shared<Schema>(std::vector<SchemaField>{}, schema_id_);
+  } else if (pruned_type->type_id() != TypeId::kStruct) {
+    return InvalidSchema("Projected type must be a struct type");
+  } else {
+    projection = FromStructType(
+        std::move(internal::checked_cast<StructType&>(*pruned_type)), schema_id_);
+  }
+
+  std::lock_guard lock(index.projections_mutex);
+  if (index.projections.size() >= kMaxCachedProjections) {
+    index.projections.clear();
+  }
+  // A concurrent call may have cached an equal projection first, which is kept.
+  return index.projections.try_emplace(std::move(key), std::move(projection))
+      .first->second;
+}
+
 }  // namespace iceberg
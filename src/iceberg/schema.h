@@ -23,9 +23,13 @@
 /// Schemas for Iceberg tables.  This header contains the definition of Schema
 /// and any utility functions.  See iceberg/type.h and iceberg/field.h as well.
 
+#include <atomic>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 #include <vector>
 
@@ -33,7 +37,6 @@
 #include "iceberg/result.h"
 #include "iceberg/schema_field.h"
 #include "iceberg/type.h"
-#include "iceberg/util/lazy.h"
 #include "iceberg/util/string_util.h"
 
 namespace iceberg {
@@ -51,6 +54,8 @@ class ICEBERG_EXPORT Schema : public StructType {
   explicit Schema(std::vector<SchemaField> fields,
                   std::optional<int32_t> schema_id = std::nullopt);
 
+  ~Schema() override;
+
   /// \brief Get the schema ID.
   ///
   /// A schema is identified by a unique ID for the purposes of schema
@@ -75,6 +80,17 @@ class ICEBERG_EXPORT Schema : public StructType {
   Result<std::optional<std::reference_wrapper<const SchemaField>>> FindFieldById(
       int32_t field_id) const;
 
+  /// \brief Find the canonical name of a field by field id.
+  ///
+  /// The canonical name is the dot-concatenated path of the field, with the "element",
+  /// "key" and "value" names of the lists and maps it is nested in.
+  Result<std::optional<std::string_view>> FindColumnName(int32_t field_id) const;
+
+  /// \brief Find the id of the struct, list or map field that a field is nested in.
+  ///
+  /// \return The id of the parent field, or nullopt for top-level and unknown fields.
+  Result<std::optional<int32_t>> FindParentId(int32_t field_id) const;
+
   /// \brief Creates a projected schema from selected field names.
   ///
   /// \param names Selected field names and nested names are dot-concatenated.
@@ -94,26 +110,36 @@ class ICEBERG_EXPORT Schema : public StructType {
   Result<std::unique_ptr<Schema>> Project(
       const std::unordered_set<int32_t>& field_ids) const;
 
+  /// \brief Creates a projected schema from selected field IDs, selecting nested
+  /// fields whole.
+  ///
+  /// Unlike Project, selecting a struct, list or map field selects all of its
+  /// sub-fields, and the projection keeps the schema ID. Structs, lists and maps are
+  /// otherwise pruned down to the selected fields they contain. The projections are
+  /// cached by the schema per set of IDs, so that scans of the same fields share them.
+  ///
+  /// \param field_ids IDs of the fields to select, unknown IDs are ignored.
+  /// \return Projected schema containing only the selected fields.
+  Result<std::shared_ptr<Schema>> SelectFieldIds(
+      std::span<const int32_t> field_ids) const;
+
   friend bool operator==(const Schema& lhs, const Schema& rhs) { return lhs.Equals(rhs); }
 
  private:
   /// \brief Compare two schemas for equality.
   bool Equals(const Schema& other) const;
 
-  static Result<std::unordered_map<int32_t, std::reference_wrapper<const SchemaField>>>
-  InitIdToFieldMap(const Schema&);
-  static Result<std::unordered_map<std::string, int32_t, StringHash, std::equal_to<>>>
-  InitNameToIdMap(const Schema&);
-  static Result<std::unordered_map<std::string, int32_t, StringHash, std::equal_to<>>>
-  InitLowerCaseNameToIdMap(const Schema&);
+  /// \brief Flat lookup tables of the fields by id and by name, see schema.cc.
+  struct Index;
+
+  /// \brief Returns the index, building it on first use.
+  const Index& index() const;
 
   const std::optional<int32_t> schema_id_;
-  /// Mapping from field id to field.
-  Lazy<InitIdToFieldMap> id_to_field_;
-  /// Mapping from field name to field id.
-  Lazy<InitNameToIdMap> name_to_id_;
-  /// Mapping from lowercased field name to field id
-  Lazy<InitLowerCaseNameToIdMap> lowercase_name_to_id_;
+  /// The index once built, read without locking by lookups.
+  mutable std::atomic<const Index*> index_{nullptr};
+  mutable std::once_flag index_once_;
+  mutable std::unique_ptr<const Index> index_owner_;
 };
 
 }  // namespace iceberg
@@ -141,6 +141,17 @@ ArrowErrorCode ToArrowSchema(const Type& type, bool optional, std::string_view n
           ArrowMetadataBuilderAppend(&metadata_buffer, ArrowCharView(kArrowExtensionName),
                                      ArrowCharView(kArrowUuidExtensionName)));
     } break;
+    case TypeId::kVariant: {
+      // The unshredded representation: the metadata and the value of each variant.
+      NANOARROW_RETURN_NOT_OK(ArrowSchemaSetTypeStruct(schema, 2));
+      for (int i = 0; i < 2; ++i) {
+        NANOARROW_RETURN_NOT_OK(ArrowSchemaSetType(schema->children[i],
+                                                   NANOARROW_TYPE_BINARY));
+        schema->children[i]->flags &= ~ARROW_FLAG_NULLABLE;
+      }
+      NANOARROW_RETURN_NOT_OK(ArrowSchemaSetName(schema->children[0], "metadata"));
+      NANOARROW_RETURN_NOT_OK(ArrowSchemaSetName(schema->children[1], "value"));
+    } break;
   }
 
   if (!name.empty()) {
@@ -313,6 +324,13 @@ std::unique_ptr<Schema> FromStructType(StructType&& struct_type,
   return std::make_unique<Schema>(std::move(fields), schema_id);
 }
 
+std::unique_ptr<Schema> FromStructType(const StructType& struct_type,
+                                       std::optional<int32_t> schema_id) {
+  auto fields = struct_type.fields();
+  return std::make_unique<Schema>(std::vector<SchemaField>(fields.begin(), fields.end()),
+                                  schema_id);
+}
+
 Result<std::unique_ptr<Schema>> FromArrowSchema(const ArrowSchema& schema,
                                                 std::optional<int32_t> schema_id) {
   ICEBERG_ASSIGN_OR_RAISE(auto type, FromArrowSchema(schema));
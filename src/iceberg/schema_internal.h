@@ -53,6 +53,14 @@ Result<std::unique_ptr<Schema>> FromArrowSchema(const ArrowSchema& schema,
 std::unique_ptr<Schema> FromStructType(StructType&& struct_type,
                                        std::optional<int32_t> schema_id);
 
+/// \brief Convert a struct type to an Iceberg schema with copies of its fields.
+///
+/// \param[in] struct_type The struct type to convert.
+/// \param[in] schema_id The schema ID of the Iceberg schema.
+/// \return The Iceberg schema.
+std::unique_ptr<Schema> FromStructType(const StructType& struct_type,
+                                       std::optional<int32_t> schema_id);
+
 std::unique_ptr<StructType> ToStructType(const Schema& schema);
 
 }  // namespace iceberg
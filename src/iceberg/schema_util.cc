@@ -61,6 +61,12 @@ Status ValidateSchemaEvolution(const Type& expected_type, const Type& source_typ
         return {};
       }
     } break;
+    case TypeId::kTimestamp: {
+      // Dates can be promoted to timestamps since format version 3.
+      if (source_type.type_id() == TypeId::kDate) {
+        return {};
+      }
+    } break;
     case TypeId::kDecimal: {
       if (source_type.type_id() == TypeId::kDecimal) {
         const auto& expected_decimal =
@@ -160,6 +166,65 @@ Result<SchemaProjection> Project(const Schema& expected_schema,
   return SchemaProjection{std::move(field_projection.children)};
 }
 
+Result<SchemaProjection> ProjectWithConstants(
+    const Schema& expected_schema, const std::unordered_map<int32_t, Literal>& constants,
+    const std::unordered_map<int32_t, Literal>& defaults,
+    const std::function<Result<SchemaProjection>(const Schema&)>& project) {
+  if (constants.empty() && defaults.empty()) {
+    return project(expected_schema);
+  }
+
+  const auto& fields = expected_schema.fields();
+  std::vector<SchemaField> source_fields;
+  source_fields.reserve(fields.size());
+  for (const auto& field : fields) {
+    auto constant = constants.find(field.field_id());
+    auto default_value = defaults.find(field.field_id());
+    const Literal* value = constant != constants.cend() ? &constant->second
+                           : default_value != defaults.cend() ? &default_value->second
+                                                              : nullptr;
+    if (value != nullptr && !value->IsNull() && *value->type() != *field.type()) {
+      return InvalidArgument("Cannot fill field {} of type {} with {}", field.name(),
+                             field.type()->ToString(), value->ToString());
+    }
+    if (constant != constants.cend()) {
+      continue;
+    }
+    if (default_value != defaults.cend() && !field.optional()) {
+      // A required field missing from the source takes its default value.
+      source_fields.push_back(SchemaField::MakeOptional(field.field_id(),
+                                                        std::string(field.name()),
+                                                        field.type(),
+                                                        std::string(field.doc())));
+    } else {
+      source_fields.push_back(field);
+    }
+  }
+
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto source_projection,
+      project(Schema(std::move(source_fields), expected_schema.schema_id())));
+  SchemaProjection result;
+  result.fields.reserve(fields.size());
+  size_t next_field = 0;
+  for (const auto& field : fields) {
+    if (auto it = constants.find(field.field_id()); it != constants.cend()) {
+      result.fields.push_back(
+          FieldProjection{.kind = FieldProjection::Kind::kConstant, .from = it->second});
+      continue;
+    }
+    auto field_projection = std::move(source_projection.fields[next_field++]);
+    if (field_projection.kind == FieldProjection::Kind::kNull) {
+      if (auto it = defaults.find(field.field_id()); it != defaults.cend()) {
+        field_projection.kind = FieldProjection::Kind::kDefault;
+        field_projection.from = it->second;
+      }
+    }
+    result.fields.push_back(std::move(field_projection));
+  }
+  return result;
+}
+
 std::string_view ToString(FieldProjection::Kind kind) {
   switch (kind) {
     case FieldProjection::Kind::kProjected:
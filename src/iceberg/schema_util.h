@@ -19,8 +19,10 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
@@ -92,6 +94,24 @@ ICEBERG_EXPORT Result<SchemaProjection> Project(const Schema& expected_schema,
                                                 const Schema& source_schema,
                                                 bool prune_source);
 
+/// \brief Project the expected schema on a source with a projection function, filling
+/// top-level fields with constant or default values instead of reading them.
+///
+/// \param expected_schema The expected schema.
+/// \param constants Values of top-level fields that are the same for every row of the
+/// source, such as identity partition values, by field id. These fields are projected
+/// as `kConstant` and are not read from the source.
+/// \param defaults Initial default values of top-level fields by field id. These fields
+/// are projected as `kDefault` when they are missing from the source.
+/// \param project The function that projects a schema on the source. It is called with
+/// the expected schema without the constant fields, where the fields with a default
+/// value are optional.
+/// \return The projection result.
+ICEBERG_EXPORT Result<SchemaProjection> ProjectWithConstants(
+    const Schema& expected_schema, const std::unordered_map<int32_t, Literal>& constants,
+    const std::unordered_map<int32_t, Literal>& defaults,
+    const std::function<Result<SchemaProjection>(const Schema&)>& project);
+
 ICEBERG_EXPORT std::string_view ToString(FieldProjection::Kind kind);
 ICEBERG_EXPORT std::string ToString(const FieldProjection& projection);
 ICEBERG_EXPORT std::string ToString(const SchemaProjection& projection);
@@ -62,6 +62,9 @@ ICEBERG_EXPORT constexpr Result<SnapshotRefType> SnapshotRefTypeFromString(
 
 /// \brief A reference to a snapshot, either a branch or a tag.
 struct ICEBERG_EXPORT SnapshotRef {
+  /// The name of the main branch of a table
+  inline static const std::string kMainBranch = "main";
+
   struct ICEBERG_EXPORT Branch {
     /// A positive number for the minimum number of snapshots to keep in a branch while
     /// expiring snapshots. Defaults to table property
@@ -181,6 +184,14 @@ struct SnapshotSummaryFields {
   inline static const std::string kDeletedDuplicatedFiles = "deleted-duplicate-files";
   /// \brief Number of partitions with files added or removed in the snapshot
   inline static const std::string kChangedPartitionCountProp = "changed-partition-count";
+  /// \brief Number of manifests written by a manifest rewrite
+  inline static const std::string kCreatedManifestsCount = "manifests-created";
+  /// \brief Number of manifests kept as they are by a manifest rewrite
+  inline static const std::string kKeptManifestsCount = "manifests-kept";
+  /// \brief Number of manifests replaced by a manifest rewrite
+  inline static const std::string kReplacedManifestsCount = "manifests-replaced";
+  /// \brief Number of manifest entries rewritten by a manifest rewrite
+  inline static const std::string kProcessedManifestEntries = "entries-processed";
 
   /// Other Fields, see https://iceberg.apache.org/spec/#other-fields
 
@@ -240,6 +251,11 @@ struct ICEBERG_EXPORT Snapshot {
   std::unordered_map<std::string, std::string> summary;
   /// ID of the table's current schema when the snapshot was created.
   std::optional<int32_t> schema_id;
+  /// The first row ID assigned to the rows added by the snapshot, from format version 3.
+  std::optional<int64_t> first_row_id;
+  /// The number of row IDs assigned by the snapshot, which is the upper bound of the
+  /// rows it added, from format version 3.
+  std::optional<int64_t> added_rows;
 
   /// \brief Return the name of the DataOperations data operation that produced this
   /// snapshot.
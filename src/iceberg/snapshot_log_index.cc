@@ -0,0 +1,55 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/snapshot_log_index.h"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
+#include "iceberg/table_metadata.h"
+
+namespace iceberg {
+
+SnapshotLogIndex::SnapshotLogIndex(const TableMetadata& metadata) {
+  const auto& snapshot_log = metadata.snapshot_log;
+  std::vector<size_t> order(snapshot_log.size());
+  std::iota(order.begin(), order.end(), size_t{0});
+  std::ranges::stable_sort(order, {}, [&](size_t position) {
+    return snapshot_log[position].timestamp_ms;
+  });
+
+  entries_.reserve(order.size());
+  size_t last_position = 0;
+  for (size_t i = 0; i < order.size(); ++i) {
+    last_position = i == 0 ? order[i] : std::max(last_position, order[i]);
+    entries_.push_back({.timestamp = snapshot_log[order[i]].timestamp_ms,
+                        .snapshot_id = snapshot_log[last_position].snapshot_id});
+  }
+}
+
+std::optional<int64_t> SnapshotLogIndex::SnapshotIdAsOf(TimePointMs timestamp) const {
+  auto it = std::ranges::upper_bound(entries_, timestamp, {}, &Entry::timestamp);
+  if (it == entries_.begin()) {
+    return std::nullopt;
+  }
+  return std::prev(it)->snapshot_id;
+}
+
+}  // namespace iceberg
@@ -0,0 +1,63 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/snapshot_log_index.h
+/// Index of the snapshot log of a table for time-travel lookups.
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/type_fwd.h"
+#include "iceberg/util/timepoint.h"
+
+namespace iceberg {
+
+/// \brief Finds the current snapshot of a table at a point in time by binary search.
+///
+/// The current snapshot at a time is the snapshot of the last entry of the snapshot
+/// log that is not later than the time. The timestamps of the log come from the clocks
+/// of the writers and may go back a little, so the entries are sorted by timestamp, and
+/// each keeps the snapshot of the last logged of the entries up to it. Building the
+/// index takes O(n log n) for a log of n entries, and a lookup O(log n), instead of
+/// O(n) for a scan of the log. The index is immutable and thread-safe.
+class ICEBERG_EXPORT SnapshotLogIndex {
+ public:
+  /// \brief Indexes the snapshot log of table metadata.
+  explicit SnapshotLogIndex(const TableMetadata& metadata);
+
+  /// \brief Returns the ID of the current snapshot at a time, or nullopt if the time is
+  /// before the first entry of the log.
+  std::optional<int64_t> SnapshotIdAsOf(TimePointMs timestamp) const;
+
+ private:
+  struct Entry {
+    TimePointMs timestamp;
+    int64_t snapshot_id;
+  };
+
+  /// \brief The entries sorted by timestamp, with the snapshot of the last logged of
+  /// the entries up to each.
+  std::vector<Entry> entries_;
+};
+
+}  // namespace iceberg
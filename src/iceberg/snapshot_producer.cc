@@ -0,0 +1,639 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/snapshot_producer.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <limits>
+#include <random>
+#include <thread>
+#include <tuple>
+#include <unordered_set>
+
+#include "iceberg/catalog.h"
+#include "iceberg/executor.h"
+#include "iceberg/expression/inclusive_metrics_evaluator.h"
+#include "iceberg/expression/manifest_evaluator.h"
+#include "iceberg/file_io.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_entry_batch.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/manifest_reader.h"
+#include "iceberg/manifest_writer.h"
+#include "iceberg/metrics_reporter.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/table_properties.h"
+#include "iceberg/table_requirement.h"
+#include "iceberg/table_requirements.h"
+#include "iceberg/table_update.h"
+#include "iceberg/util/macros.h"
+#include "iceberg/util/uuid.h"
+
+namespace iceberg {
+
+namespace {
+
+// The number of added files written to a manifest between checks of its size.
+constexpr size_t kAddedFilesBatchSize = 1024;
+
+int64_t NewSnapshotId() {
+  auto bytes = Uuid::GenerateV4().bytes();
+  uint64_t most_significant;
+  uint64_t least_significant;
+  std::memcpy(&most_significant, bytes.data(), sizeof(most_significant));
+  std::memcpy(&least_significant, bytes.data() + sizeof(most_significant),
+              sizeof(least_significant));
+  return static_cast<int64_t>((most_significant ^ least_significant) &
+                              static_cast<uint64_t>(std::numeric_limits<int64_t>::max()));
+}
+
+std::optional<int64_t> ParseCount(
+    const std::unordered_map<std::string, std::string>& summary, const std::string& key) {
+  auto it = summary.find(key);
+  if (it == summary.end()) {
+    return std::nullopt;
+  }
+  int64_t value = 0;
+  const auto& str = it->second;
+  if (auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+      ec != std::errc{} || ptr != str.data() + str.size()) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+// Sets a total of the summary from the total of the parent and the added and removed
+// counts of the change. The total is left unset if the parent does not track it.
+void UpdateTotal(std::unordered_map<std::string, std::string>& summary,
+                 const Snapshot* parent, const std::string& total_key,
+                 const std::string& added_key, const std::string& removed_key) {
+  int64_t total = 0;
+  if (parent != nullptr) {
+    auto parent_total = ParseCount(parent->summary, total_key);
+    if (!parent_total.has_value()) {
+      return;
+    }
+    total = parent_total.value();
+  }
+  total += ParseCount(summary, added_key).value_or(0);
+  total -= ParseCount(summary, removed_key).value_or(0);
+  summary[total_key] = std::to_string(total);
+}
+
+/// \brief Sets the file and record totals that are missing from a summary, because the
+/// parent snapshot does not have them, from the counts of the manifests of the snapshot
+/// when all of them have their counts, so that the following snapshots have them again.
+void SetMissingTotals(std::unordered_map<std::string, std::string>& summary,
+                      const std::vector<ManifestFile>& manifests) {
+  if (summary.contains(SnapshotSummaryFields::kTotalDataFiles) &&
+      summary.contains(SnapshotSummaryFields::kTotalDeleteFiles) &&
+      summary.contains(SnapshotSummaryFields::kTotalRecords)) {
+    return;
+  }
+  int64_t data_files = 0;
+  int64_t delete_files = 0;
+  int64_t records = 0;
+  for (const auto& manifest : manifests) {
+    if (!manifest.added_files_count.has_value() ||
+        !manifest.existing_files_count.has_value()) {
+      return;
+    }
+    const int64_t files = static_cast<int64_t>(*manifest.added_files_count) +
+                          *manifest.existing_files_count;
+    if (manifest.content == ManifestFile::Content::kDeletes) {
+      delete_files += files;
+      continue;
+    }
+    if (!manifest.added_rows_count.has_value() ||
+        !manifest.existing_rows_count.has_value()) {
+      return;
+    }
+    data_files += files;
+    records += *manifest.added_rows_count + *manifest.existing_rows_count;
+  }
+  summary.try_emplace(SnapshotSummaryFields::kTotalDataFiles, std::to_string(data_files));
+  summary.try_emplace(SnapshotSummaryFields::kTotalDeleteFiles,
+                      std::to_string(delete_files));
+  summary.try_emplace(SnapshotSummaryFields::kTotalRecords, std::to_string(records));
+}
+
+/// \brief Returns the number of row IDs assigned by a manifest list to its data
+/// manifests without a first row ID, which are all the rows they track.
+int64_t AssignedRowIds(const std::vector<ManifestFile>& manifests) {
+  int64_t rows = 0;
+  for (const auto& manifest : manifests) {
+    if (manifest.content == ManifestFile::Content::kData &&
+        !manifest.first_row_id.has_value()) {
+      rows += manifest.added_rows_count.value_or(0) +
+              manifest.existing_rows_count.value_or(0);
+    }
+  }
+  return rows;
+}
+
+}  // namespace
+
+SnapshotProducer::SnapshotProducer(std::shared_ptr<Table> table)
+    : table_(std::move(table)),
+      snapshot_id_(NewSnapshotId()),
+      commit_uuid_(Uuid::GenerateV4().ToString()) {}
+
+SnapshotProducer::~SnapshotProducer() = default;
+
+Result<std::unique_ptr<ManifestWriter>> SnapshotProducer::NewManifestWriter(
+    const TableMetadata& base, std::shared_ptr<PartitionSpec> spec) {
+  auto location = TableMetadataUtil::MetadataFileLocation(
+      base, std::format("{}-m{}.avro", commit_uuid_, manifest_count_++));
+  switch (base.format_version) {
+    case 1:
+      return ManifestWriter::MakeV1Writer(snapshot_id_, location, table_->io(),
+                                          std::move(spec));
+    case 2:
+      return ManifestWriter::MakeV2Writer(snapshot_id_, location, table_->io(),
+                                          std::move(spec));
+    case 3:
+      // Added files inherit their first row IDs from the manifest, which are assigned
+      // when the manifest list is written.
+      return ManifestWriter::MakeV3Writer(snapshot_id_, /*first_row_id=*/std::nullopt,
+                                          location, table_->io(), std::move(spec));
+    default:
+      return NotSupported("Cannot write manifests of table format version {}",
+                          base.format_version);
+  }
+}
+
+Result<std::vector<ManifestFile>> SnapshotProducer::WriteAddedManifests(
+    const TableMetadata& base, int32_t spec_id,
+    std::span<const std::shared_ptr<DataFile>> files) {
+  ICEBERG_ASSIGN_OR_RAISE(auto spec, base.PartitionSpecById(spec_id));
+  const int64_t target_size_bytes =
+      table_->properties().Get(TableProperties::kManifestTargetSizeBytes);
+  const int32_t parallelism = std::max<int32_t>(
+      table_->properties().Get(TableProperties::kManifestWriteParallelism), 1);
+
+  // Shards of less than a batch are not worth a manifest of their own.
+  const size_t shards_count =
+      std::clamp<size_t>((files.size() + kAddedFilesBatchSize - 1) / kAddedFilesBatchSize,
+                         1, static_cast<size_t>(parallelism));
+  std::vector<std::vector<ManifestFile>> shard_manifests(shards_count);
+  auto write = [&](size_t shard) -> Status {
+    auto& manifests = shard_manifests[shard];
+    const size_t shard_begin = files.size() * shard / shards_count;
+    const size_t shard_end = files.size() * (shard + 1) / shards_count;
+    const auto shard_files = files.subspan(shard_begin, shard_end - shard_begin);
+    std::unique_ptr<ManifestWriter> writer;
+    std::vector<ManifestEntry> entries;
+    for (size_t begin = 0; begin < shard_files.size(); begin += kAddedFilesBatchSize) {
+      if (writer == nullptr) {
+        ICEBERG_ASSIGN_OR_RAISE(writer, NewManifestWriter(base, spec));
+      }
+      entries.clear();
+      const auto batch = shard_files.subspan(
+          begin, std::min(kAddedFilesBatchSize, shard_files.size() - begin));
+      for (const auto& file : batch) {
+        entries.push_back(ManifestEntry{
+            .status = ManifestStatus::kAdded,
+            .snapshot_id = snapshot_id_,
+            .data_file = file,
+        });
+      }
+      ICEBERG_RETURN_UNEXPECTED(writer->AddAll(entries));
+      // The size is checked between batches of entries, so manifests may exceed the
+      // target by a batch.
+      if (writer->estimated_length().value_or(0) >= target_size_bytes) {
+        ICEBERG_RETURN_UNEXPECTED(writer->Close());
+        ICEBERG_ASSIGN_OR_RAISE(manifests.emplace_back(), writer->ToManifestFile());
+        writer.reset();
+      }
+    }
+    if (writer != nullptr) {
+      ICEBERG_RETURN_UNEXPECTED(writer->Close());
+      ICEBERG_ASSIGN_OR_RAISE(manifests.emplace_back(), writer->ToManifestFile());
+    }
+    return {};
+  };
+
+  auto status = RunInParallel(*DefaultExecutor(), shards_count, parallelism, write);
+  std::vector<ManifestFile> manifests;
+  for (auto& shard : shard_manifests) {
+    for (auto& manifest : shard) {
+      if (!status.has_value()) {
+        DeleteFile(manifest.manifest_path);
+      } else {
+        manifests.push_back(std::move(manifest));
+      }
+    }
+  }
+  ICEBERG_RETURN_UNEXPECTED(status);
+  return manifests;
+}
+
+void SnapshotProducer::DeleteFile(const std::string& location) const {
+  std::ignore = table_->io()->DeleteFile(location);
+}
+
+Result<std::unordered_set<int64_t>> SnapshotProducer::ConcurrentSnapshotIds(
+    const TableMetadata& base, const Snapshot& parent,
+    std::optional<int64_t> starting_snapshot_id) {
+  // The snapshots committed since the starting snapshot, from the lineage of the
+  // parent, which only needs the table metadata.
+  std::unordered_set<int64_t> new_snapshot_ids;
+  for (std::optional<int64_t> id = parent.snapshot_id; id != starting_snapshot_id;) {
+    if (!id.has_value()) {
+      return ValidationFailed(
+          "Cannot commit, snapshot {} is not an ancestor of the current snapshot",
+          starting_snapshot_id.value());
+    }
+    auto snapshot = base.SnapshotById(id.value());
+    if (!snapshot.has_value()) {
+      return ValidationFailed(
+          "Cannot validate the changes since snapshot {}, snapshot {} has expired",
+          starting_snapshot_id.value_or(Snapshot::kInvalidSnapshotId), id.value());
+    }
+    new_snapshot_ids.insert(id.value());
+    id = snapshot.value()->parent_snapshot_id;
+  }
+  return new_snapshot_ids;
+}
+
+Status SnapshotProducer::VisitConcurrentFiles(
+    const TableMetadata& base, const Snapshot* parent,
+    std::optional<int64_t> starting_snapshot_id, ManifestFile::Content content,
+    const std::shared_ptr<Expression>& conflict_detection_filter,
+    const std::function<Status(const DataFile&, int64_t)>& visitor) const {
+  if (parent == nullptr || parent->snapshot_id == starting_snapshot_id) {
+    return {};
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto new_snapshot_ids,
+                          ConcurrentSnapshotIds(base, *parent, starting_snapshot_id));
+
+  // The manifests added by these snapshots are the ones of the parent's manifest list
+  // with their added_snapshot_id, including those that merged or rewrote their files.
+  ICEBERG_ASSIGN_OR_RAISE(auto list_reader,
+                          ManifestListReader::Make(parent->manifest_list, table_->io()));
+  ICEBERG_ASSIGN_OR_RAISE(auto manifests, list_reader->Files());
+  std::unique_ptr<InclusiveMetricsEvaluator> metrics_evaluator;
+  if (conflict_detection_filter != nullptr) {
+    ICEBERG_ASSIGN_OR_RAISE(auto schema, base.Schema());
+    ICEBERG_ASSIGN_OR_RAISE(metrics_evaluator, InclusiveMetricsEvaluator::Make(
+                                                   conflict_detection_filter, *schema));
+  }
+  std::unordered_map<int32_t, std::unique_ptr<ManifestEvaluator>> manifest_evaluators;
+  for (const auto& manifest : manifests) {
+    if (manifest.content != content ||
+        !new_snapshot_ids.contains(manifest.added_snapshot_id) ||
+        !(manifest.has_added_files() || manifest.has_existing_files())) {
+      continue;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto spec,
+                            base.PartitionSpecById(manifest.partition_spec_id));
+    if (conflict_detection_filter != nullptr) {
+      auto& evaluator = manifest_evaluators[manifest.partition_spec_id];
+      if (evaluator == nullptr) {
+        ICEBERG_ASSIGN_OR_RAISE(
+            evaluator, ManifestEvaluator::MakeRowFilter(conflict_detection_filter, spec));
+      }
+      ICEBERG_ASSIGN_OR_RAISE(auto might_match, evaluator->Evaluate(manifest));
+      if (!might_match) {
+        continue;
+      }
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto partition_schema, spec->PartitionSchema());
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto reader,
+        ManifestReader::Make(manifest, table_->io(), std::move(partition_schema)));
+    ICEBERG_RETURN_UNEXPECTED(reader->VisitEntries([&](ManifestEntry&& entry) -> Status {
+      // Files of older snapshots are carried over as existing by merged manifests.
+      const int64_t added_snapshot_id =
+          entry.snapshot_id.value_or(manifest.added_snapshot_id);
+      if (entry.status == ManifestStatus::kDeleted ||
+          !new_snapshot_ids.contains(added_snapshot_id)) {
+        return {};
+      }
+      if (metrics_evaluator != nullptr) {
+        ICEBERG_ASSIGN_OR_RAISE(auto might_match,
+                                metrics_evaluator->Evaluate(*entry.data_file));
+        if (!might_match) {
+          return {};
+        }
+      }
+      return visitor(*entry.data_file, added_snapshot_id);
+    }));
+  }
+  return {};
+}
+
+Status SnapshotProducer::ValidateAddedDataFiles(
+    const TableMetadata& base, const Snapshot* parent,
+    std::optional<int64_t> starting_snapshot_id,
+    const std::shared_ptr<Expression>& conflict_detection_filter) const {
+  return VisitConcurrentFiles(
+      base, parent, starting_snapshot_id, ManifestFile::Content::kData,
+      conflict_detection_filter, [](const DataFile& file, int64_t snapshot_id) {
+        return ValidationFailed(
+            "Found conflicting data file {} added by concurrent snapshot {}",
+            file.file_path, snapshot_id);
+      });
+}
+
+Status SnapshotProducer::ValidateNoNewDeleteFiles(
+    const TableMetadata& base, const Snapshot* parent,
+    std::optional<int64_t> starting_snapshot_id,
+    const std::shared_ptr<Expression>& conflict_detection_filter) const {
+  return VisitConcurrentFiles(
+      base, parent, starting_snapshot_id, ManifestFile::Content::kDeletes,
+      conflict_detection_filter, [](const DataFile& file, int64_t snapshot_id) {
+        return ValidationFailed(
+            "Found conflicting delete file {} added by concurrent snapshot {}",
+            file.file_path, snapshot_id);
+      });
+}
+
+Status SnapshotProducer::ValidateDataFilesExist(
+    const TableMetadata& base, const Snapshot* parent,
+    std::optional<int64_t> starting_snapshot_id,
+    const std::unordered_set<std::string, StringHash, std::equal_to<>>& data_file_paths)
+    const {
+  if (parent == nullptr || parent->snapshot_id == starting_snapshot_id ||
+      data_file_paths.empty()) {
+    return {};
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto new_snapshot_ids,
+                          ConcurrentSnapshotIds(base, *parent, starting_snapshot_id));
+
+  // A file removed by a snapshot is only tracked as deleted by the manifests written
+  // by that snapshot, and only their file paths are read.
+  ICEBERG_ASSIGN_OR_RAISE(auto list_reader,
+                          ManifestListReader::Make(parent->manifest_list, table_->io()));
+  ICEBERG_ASSIGN_OR_RAISE(auto manifests, list_reader->Files());
+  for (const auto& manifest : manifests) {
+    if (manifest.content != ManifestFile::Content::kData ||
+        !new_snapshot_ids.contains(manifest.added_snapshot_id) ||
+        !manifest.has_deleted_files()) {
+      continue;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto reader,
+        ManifestReader::Make(manifest, table_->io(), /*partition_schema=*/nullptr,
+                             {.columns = {std::string(DataFile::kFilePath.name())}}));
+    ICEBERG_RETURN_UNEXPECTED(
+        reader->VisitBatches([&](const ManifestEntryBatch& batch) -> Status {
+          for (int64_t row = 0; row < batch.size(); ++row) {
+            if (batch.status(row) == ManifestStatus::kDeleted &&
+                data_file_paths.contains(batch.file_path(row))) {
+              return ValidationFailed(
+                  "Cannot commit, data file {} was removed by concurrent snapshot {}",
+                  batch.file_path(row), manifest.added_snapshot_id);
+            }
+          }
+          return {};
+        }));
+  }
+  return {};
+}
+
+Result<std::shared_ptr<Snapshot>> SnapshotProducer::ApplySnapshot(
+    const TableMetadata& base, const Snapshot* parent, int32_t attempt,
+    const std::vector<ManifestFile>& manifests) {
+  // Sequence numbers are only assigned from format version 2.
+  const int64_t sequence_number = base.format_version > 1
+                                      ? base.last_sequence_number + 1
+                                      : TableMetadata::kInitialSequenceNumber;
+  std::optional<int64_t> parent_snapshot_id;
+  if (parent != nullptr) {
+    parent_snapshot_id = parent->snapshot_id;
+  }
+
+  auto manifest_list = TableMetadataUtil::MetadataFileLocation(
+      base, std::format("snap-{}-{}-{}.avro", snapshot_id_, attempt + 1, commit_uuid_));
+  std::unique_ptr<ManifestListWriter> writer;
+  std::optional<int64_t> first_row_id;
+  std::optional<int64_t> added_rows;
+  if (base.format_version == 1) {
+    ICEBERG_ASSIGN_OR_RAISE(writer,
+                            ManifestListWriter::MakeV1Writer(
+                                snapshot_id_, parent_snapshot_id, manifest_list,
+                                table_->io()));
+  } else if (base.format_version == 2) {
+    ICEBERG_ASSIGN_OR_RAISE(writer, ManifestListWriter::MakeV2Writer(
+                                        snapshot_id_, parent_snapshot_id,
+                                        sequence_number, manifest_list, table_->io()));
+  } else if (base.format_version == 3) {
+    // The new data manifests are assigned consecutive ranges of row IDs from the next
+    // row ID of the table, by their record counts.
+    first_row_id = base.next_row_id;
+    added_rows = AssignedRowIds(manifests);
+    ICEBERG_ASSIGN_OR_RAISE(writer, ManifestListWriter::MakeV3Writer(
+                                        snapshot_id_, parent_snapshot_id,
+                                        sequence_number, first_row_id, manifest_list,
+                                        table_->io()));
+  } else {
+    return NotSupported("Cannot commit snapshots to table format version {}",
+                        base.format_version);
+  }
+  manifest_lists_.push_back(manifest_list);
+  ICEBERG_RETURN_UNEXPECTED(writer->AddAll(manifests));
+  ICEBERG_RETURN_UNEXPECTED(writer->Close());
+
+  auto summary = Summary();
+  summary[SnapshotSummaryFields::kOperation] = operation();
+  UpdateTotal(summary, parent, SnapshotSummaryFields::kTotalDataFiles,
+              SnapshotSummaryFields::kAddedDataFiles,
+              SnapshotSummaryFields::kDeletedDataFiles);
+  UpdateTotal(summary, parent, SnapshotSummaryFields::kTotalDeleteFiles,
+              SnapshotSummaryFields::kAddedDeleteFiles,
+              SnapshotSummaryFields::kRemovedDeleteFiles);
+  UpdateTotal(summary, parent, SnapshotSummaryFields::kTotalRecords,
+              SnapshotSummaryFields::kAddedRecords,
+              SnapshotSummaryFields::kDeletedRecords);
+  UpdateTotal(summary, parent, SnapshotSummaryFields::kTotalFileSize,
+              SnapshotSummaryFields::kAddedFileSize,
+              SnapshotSummaryFields::kRemovedFileSize);
+  UpdateTotal(summary, parent, SnapshotSummaryFields::kTotalPosDeletes,
+              SnapshotSummaryFields::kAddedPosDeletes,
+              SnapshotSummaryFields::kRemovedPosDeletes);
+  UpdateTotal(summary, parent, SnapshotSummaryFields::kTotalEqDeletes,
+              SnapshotSummaryFields::kAddedEqDeletes,
+              SnapshotSummaryFields::kRemovedEqDeletes);
+  SetMissingTotals(summary, manifests);
+
+  return std::make_shared<Snapshot>(Snapshot{
+      .snapshot_id = snapshot_id_,
+      .parent_snapshot_id = parent_snapshot_id,
+      .sequence_number = sequence_number,
+      .timestamp_ms = TimePointMs{std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::system_clock::now().time_since_epoch())},
+      .manifest_list = std::move(manifest_list),
+      .summary = std::move(summary),
+      .schema_id = base.current_schema_id,
+      .first_row_id = first_row_id,
+      .added_rows = added_rows,
+  });
+}
+
+Status SnapshotProducer::CommitOnce(const TableMetadata& base, int32_t attempt,
+                                    std::vector<ManifestFile>& manifests) {
+  std::shared_ptr<Snapshot> parent;
+  if (base.current_snapshot_id != Snapshot::kInvalidSnapshotId) {
+    ICEBERG_ASSIGN_OR_RAISE(parent, base.Snapshot());
+  }
+  ICEBERG_ASSIGN_OR_RAISE(manifests, Apply(base, parent.get()));
+  ICEBERG_ASSIGN_OR_RAISE(auto snapshot,
+                          ApplySnapshot(base, parent.get(), attempt, manifests));
+  last_snapshot_ = snapshot;
+
+  // Moving the main branch keeps its retention policy.
+  SnapshotRef::Branch retention;
+  if (auto it = base.refs.find(SnapshotRef::kMainBranch);
+      it != base.refs.end() && it->second->type() == SnapshotRefType::kBranch) {
+    retention = std::get<SnapshotRef::Branch>(it->second->retention);
+  }
+
+  std::vector<std::unique_ptr<TableUpdate>> updates;
+  updates.push_back(std::make_unique<table::AddSnapshot>(snapshot));
+  updates.push_back(std::make_unique<table::SetSnapshotRef>(
+      SnapshotRef::kMainBranch, snapshot_id_, SnapshotRefType::kBranch,
+      retention.min_snapshots_to_keep, retention.max_snapshot_age_ms,
+      retention.max_ref_age_ms));
+  ICEBERG_ASSIGN_OR_RAISE(auto requirements,
+                          TableRequirements::ForUpdateTable(base, updates));
+  ICEBERG_RETURN_UNEXPECTED(
+      table_->catalog()->UpdateTable(table_->name(), requirements, updates));
+  return {};
+}
+
+Status SnapshotProducer::CommitSnapshot() {
+  if (table_->catalog() == nullptr) {
+    return NotSupported("Cannot commit to table {} without a catalog",
+                        table_->name().name);
+  }
+
+  const auto& properties = table_->properties();
+  const int32_t num_retries =
+      std::max(properties.Get(TableProperties::kCommitNumRetries), 0);
+  const std::chrono::milliseconds min_wait(
+      std::max(properties.Get(TableProperties::kCommitMinRetryWaitMs), 0));
+  const std::chrono::milliseconds max_wait(
+      std::max(properties.Get(TableProperties::kCommitMaxRetryWaitMs), 0));
+  const std::chrono::milliseconds total_timeout(
+      std::max(properties.Get(TableProperties::kCommitTotalRetryTimeMs), 0));
+  const auto start = std::chrono::steady_clock::now();
+
+  std::vector<ManifestFile> manifests;
+  Status status;
+  int32_t attempts = 0;
+  for (int32_t attempt = 0;; ++attempt) {
+    ++attempts;
+    status = CommitOnce(*table_->metadata(), attempt, manifests);
+    if (status.has_value() || status.error().kind != ErrorKind::kCommitFailed ||
+        attempt >= num_retries) {
+      break;
+    }
+
+    // Exponential backoff with up to 10% jitter, to spread out the retries of
+    // concurrent writers.
+    auto wait = std::min(min_wait * (int64_t{1} << std::min(attempt, 30)), max_wait);
+    thread_local std::mt19937_64 random(std::random_device{}());
+    wait += std::chrono::milliseconds(std::uniform_int_distribution<int64_t>(
+        0, wait.count() / 10)(random));
+    if (std::chrono::steady_clock::now() - start + wait > total_timeout) {
+      break;
+    }
+    std::this_thread::sleep_for(wait);
+
+    // Produce the snapshot again on top of the metadata that won the race.
+    auto refreshed = table_->Refresh();
+    if (!refreshed.has_value()) {
+      status = std::move(refreshed);
+      break;
+    }
+  }
+
+  if (!status.has_value() && status.error().kind == ErrorKind::kCommitStateUnknown) {
+    // The snapshot may have been committed, so none of its files can be deleted.
+    return status;
+  }
+
+  std::unordered_set<std::string> committed;
+  if (status.has_value()) {
+    for (const auto& manifest : manifests) {
+      committed.insert(manifest.manifest_path);
+    }
+    committed.insert(manifest_lists_.back());
+  }
+  for (const auto& manifest_list : manifest_lists_) {
+    if (!committed.contains(manifest_list)) {
+      DeleteFile(manifest_list);
+    }
+  }
+  manifest_lists_.clear();
+  CleanUncommitted(committed);
+
+  if (status.has_value()) {
+    ReportCommit(*last_snapshot_, attempts, std::chrono::steady_clock::now() - start);
+    // The snapshot is committed, a failed refresh only leaves the table stale.
+    std::ignore = table_->Refresh();
+  }
+  return status;
+}
+
+void SnapshotProducer::ReportCommit(const Snapshot& snapshot, int32_t attempts,
+                                    std::chrono::nanoseconds duration) const {
+  const auto& reporter = table_->metrics_reporter();
+  if (reporter == nullptr) {
+    return;
+  }
+
+  CommitReport report{
+      .table = table_->name(),
+      .snapshot_id = snapshot.snapshot_id,
+      .sequence_number = snapshot.sequence_number,
+      .operation = operation(),
+  };
+  auto& metrics = report.metrics;
+  metrics.total_duration.Record(duration);
+  metrics.attempts.Increment(attempts);
+  const auto& summary = snapshot.summary;
+  for (const auto& [counter, key] :
+       {std::pair{&metrics.added_data_files, &SnapshotSummaryFields::kAddedDataFiles},
+        {&metrics.removed_data_files, &SnapshotSummaryFields::kDeletedDataFiles},
+        {&metrics.total_data_files, &SnapshotSummaryFields::kTotalDataFiles},
+        {&metrics.added_delete_files, &SnapshotSummaryFields::kAddedDeleteFiles},
+        {&metrics.removed_delete_files, &SnapshotSummaryFields::kRemovedDeleteFiles},
+        {&metrics.total_delete_files, &SnapshotSummaryFields::kTotalDeleteFiles},
+        {&metrics.added_records, &SnapshotSummaryFields::kAddedRecords},
+        {&metrics.removed_records, &SnapshotSummaryFields::kDeletedRecords},
+        {&metrics.total_records, &SnapshotSummaryFields::kTotalRecords},
+        {&metrics.added_files_size_in_bytes, &SnapshotSummaryFields::kAddedFileSize},
+        {&metrics.removed_files_size_in_bytes, &SnapshotSummaryFields::kRemovedFileSize},
+        {&metrics.total_files_size_in_bytes, &SnapshotSummaryFields::kTotalFileSize}}) {
+    counter->Increment(ParseCount(summary, *key).value_or(0));
+  }
+  reporter->Report(report);
+}
+
+}  // namespace iceberg
@@ -0,0 +1,205 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/snapshot_producer.h
+/// Base class of the updates that commit a new snapshot to a table.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+#include "iceberg/util/string_util.h"
+
+namespace iceberg {
+
+/// \brief Base class of the updates that commit a new snapshot to the main branch.
+///
+/// CommitSnapshot() writes the manifest list of the new snapshot on top of the current
+/// metadata of the table, and commits the snapshot through the catalog of the table.
+/// When the commit loses an optimistic concurrency race, the table is refreshed and the
+/// snapshot is produced again on top of the new metadata, after an exponential backoff
+/// set by the `commit.retry.*` table properties. Subclasses keep the manifests they
+/// write across the attempts, so a retry only writes a new manifest list. A committed
+/// snapshot is reported to the metrics reporter of the table, if any.
+class ICEBERG_EXPORT SnapshotProducer {
+ public:
+  virtual ~SnapshotProducer();
+
+  /// \brief The ID of the snapshot produced by this update.
+  int64_t snapshot_id() const { return snapshot_id_; }
+
+ protected:
+  explicit SnapshotProducer(std::shared_ptr<Table> table);
+
+  /// \brief Apply the pending changes and commit the new snapshot.
+  ///
+  /// \return Status::OK if the snapshot was committed; ErrorKind::kCommitFailed if it
+  /// could not be committed because of concurrent changes, after retrying
+  Status CommitSnapshot();
+
+  /// \brief The data operation of the new snapshot, see DataOperation.
+  virtual const std::string& operation() const = 0;
+
+  /// \brief Returns the manifests of the new snapshot.
+  ///
+  /// Called for each commit attempt. Manifests written for a previous attempt are
+  /// still valid and should be reused.
+  ///
+  /// \param base The table metadata the new snapshot is committed on top of
+  /// \param parent The current snapshot of `base`, or null if the table has none
+  virtual Result<std::vector<ManifestFile>> Apply(const TableMetadata& base,
+                                                  const Snapshot* parent) = 0;
+
+  /// \brief Returns the summary properties of the changes of the new snapshot.
+  ///
+  /// Totals are derived from the summary of the parent snapshot and the added and
+  /// deleted counts of these properties.
+  virtual std::unordered_map<std::string, std::string> Summary() const = 0;
+
+  /// \brief Deletes the files written by Apply() that are not referenced by the
+  /// committed snapshot.
+  ///
+  /// \param committed The paths of the manifests of the committed snapshot, empty if
+  /// the commit failed
+  virtual void CleanUncommitted(const std::unordered_set<std::string>& committed) = 0;
+
+  /// \brief Returns a writer for a new manifest of the snapshot.
+  ///
+  /// \param base The table metadata the new snapshot is committed on top of
+  /// \param spec The partition spec of the manifest
+  Result<std::unique_ptr<ManifestWriter>> NewManifestWriter(
+      const TableMetadata& base, std::shared_ptr<PartitionSpec> spec);
+
+  /// \brief Writes files added by the snapshot to new manifests.
+  ///
+  /// The files are split by count into up to `commit.manifest.write-parallelism`
+  /// contiguous shards that are written concurrently on the DefaultExecutor(), and
+  /// each shard starts a new manifest once the current one reaches
+  /// `commit.manifest.target-size-bytes`. Files sorted by partition are written to
+  /// manifests of narrow partition ranges. The data and file sequence numbers of the
+  /// added entries are inherited from the committed snapshot.
+  ///
+  /// \param base The table metadata the new snapshot is committed on top of
+  /// \param spec_id The ID of the partition spec of the files
+  /// \param files The added files, all data files or all delete files
+  /// \return The new manifests in the order of the files; the manifests already written
+  /// are deleted on failure
+  Result<std::vector<ManifestFile>> WriteAddedManifests(
+      const TableMetadata& base, int32_t spec_id,
+      std::span<const std::shared_ptr<DataFile>> files);
+
+  /// \brief Deletes a file, ignoring failures as the file is not referenced.
+  void DeleteFile(const std::string& location) const;
+
+  /// \brief Visits the live files of `parent` that were added by the snapshots committed
+  /// after the starting snapshot and may contain rows matching a filter.
+  ///
+  /// Only the manifests of `parent` whose added_snapshot_id is one of those snapshots
+  /// are read, skipping the ones whose partition summaries or whose files' metrics
+  /// cannot match the filter, so validating a retried commit costs time proportional
+  /// to the concurrent changes rather than to the size of the table.
+  ///
+  /// \param base The table metadata the new snapshot is committed on top of
+  /// \param parent The current snapshot of `base`, or null if the table has none
+  /// \param starting_snapshot_id The snapshot the changes were planned from, or nullopt
+  /// if the table had no snapshot then
+  /// \param content Whether to visit the data files or the delete files
+  /// \param conflict_detection_filter A filter on table rows, or null to visit all files
+  /// \param visitor Called with each added file and the ID of the snapshot that added it
+  /// \return ErrorKind::kValidationFailed if the starting snapshot is not an ancestor of
+  /// `parent`, or the first error of the visitor
+  Status VisitConcurrentFiles(
+      const TableMetadata& base, const Snapshot* parent,
+      std::optional<int64_t> starting_snapshot_id, ManifestFile::Content content,
+      const std::shared_ptr<Expression>& conflict_detection_filter,
+      const std::function<Status(const DataFile&, int64_t)>& visitor) const;
+
+  /// \brief Fails with ErrorKind::kValidationFailed if a snapshot committed after the
+  /// starting snapshot added data files that may contain rows matching the filter.
+  Status ValidateAddedDataFiles(
+      const TableMetadata& base, const Snapshot* parent,
+      std::optional<int64_t> starting_snapshot_id,
+      const std::shared_ptr<Expression>& conflict_detection_filter) const;
+
+  /// \brief Fails with ErrorKind::kValidationFailed if a snapshot committed after the
+  /// starting snapshot added delete files that may apply to rows matching the filter.
+  Status ValidateNoNewDeleteFiles(
+      const TableMetadata& base, const Snapshot* parent,
+      std::optional<int64_t> starting_snapshot_id,
+      const std::shared_ptr<Expression>& conflict_detection_filter) const;
+
+  /// \brief Fails with ErrorKind::kValidationFailed if a snapshot committed after the
+  /// starting snapshot removed one of the data files.
+  ///
+  /// Only the manifests of `parent` added by those snapshots with deleted files are
+  /// read, and only for the paths of their entries.
+  Status ValidateDataFilesExist(
+      const TableMetadata& base, const Snapshot* parent,
+      std::optional<int64_t> starting_snapshot_id,
+      const std::unordered_set<std::string, StringHash, std::equal_to<>>& data_file_paths)
+      const;
+
+  const std::shared_ptr<Table>& table() const { return table_; }
+
+ private:
+  /// \brief Returns the IDs of the snapshots committed after the starting snapshot
+  /// in the lineage of `parent`.
+  static Result<std::unordered_set<int64_t>> ConcurrentSnapshotIds(
+      const TableMetadata& base, const Snapshot& parent,
+      std::optional<int64_t> starting_snapshot_id);
+
+  /// \brief Writes the manifest list of the new snapshot and returns the snapshot.
+  Result<std::shared_ptr<Snapshot>> ApplySnapshot(
+      const TableMetadata& base, const Snapshot* parent, int32_t attempt,
+      const std::vector<ManifestFile>& manifests);
+
+  /// \brief Commits the new snapshot on top of `base` once.
+  Status CommitOnce(const TableMetadata& base, int32_t attempt,
+                    std::vector<ManifestFile>& manifests);
+
+  /// \brief Reports the committed snapshot to the metrics reporter of the table.
+  void ReportCommit(const Snapshot& snapshot, int32_t attempts,
+                    std::chrono::nanoseconds duration) const;
+
+  std::shared_ptr<Table> table_;
+  const int64_t snapshot_id_;
+  const std::string commit_uuid_;
+  // Manifests may be created concurrently by WriteAddedManifests()
+  std::atomic<int32_t> manifest_count_ = 0;
+  // Manifest lists written by the commit attempts, the last one is committed on success
+  std::vector<std::string> manifest_lists_;
+  // The snapshot of the last commit attempt
+  std::shared_ptr<Snapshot> last_snapshot_;
+};
+
+}  // namespace iceberg
@@ -0,0 +1,91 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/sort_key_encoder_internal.h
+/// Byte-comparable sort keys of the rows of Arrow batches.
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "iceberg/arrow_c_data.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief Sort keys of the rows of a batch, as byte strings in a single buffer.
+struct ICEBERG_EXPORT SortKeys {
+  std::vector<uint8_t> data;
+  std::vector<int64_t> offsets;
+
+  std::string_view operator[](int64_t row) const {
+    return {reinterpret_cast<const char*>(data.data()) + offsets[row],
+            static_cast<size_t>(offsets[row + 1] - offsets[row])};
+  }
+};
+
+/// \brief Encodes the sort keys of rows as byte strings that sort in the order of the
+/// rows.
+///
+/// Rows are ordered by their partition, then by their Z-order key if any, then by the
+/// fields of the sort order. Each value is encoded as a null tag placed by the null
+/// order, followed by bytes that compare like the value: big-endian integers with a
+/// flipped sign bit, IEEE floats flipped to compare as integers, and byte strings with
+/// escaped zeros and a zero terminator. The bytes of descending values are inverted.
+/// Keys are encoded a column at a time, so that each step is a loop over the values of
+/// a column.
+///
+/// The Z-order key interleaves the bits of the values of its columns, each normalized
+/// to a fixed number of bytes that compare like the values: integers widened to 64
+/// bits with a flipped sign bit, floats widened to doubles and flipped like above, and
+/// the leading bytes of byte strings. Nulls are normalized to zeros.
+class ICEBERG_EXPORT SortKeyEncoder {
+ public:
+  /// \brief Makes an encoder for the rows of batches of a schema.
+  ///
+  /// \param schema The schema of the batches
+  /// \param spec The partition spec whose fields lead the keys, which may be
+  /// unpartitioned
+  /// \param sort_order The sort order whose fields follow the partition
+  /// \param zorder_field_ids The fields of the Z-order key, if any
+  /// \param zorder_width The number of bytes of each value in the Z-order key
+  static Result<std::unique_ptr<SortKeyEncoder>> Make(
+      const Schema& schema, const PartitionSpec& spec, const SortOrder& sort_order,
+      std::span<const int32_t> zorder_field_ids = {}, int32_t zorder_width = 8);
+
+  ~SortKeyEncoder();
+
+  /// \brief Encodes the sort keys of the rows of a batch.
+  Status Encode(const ArrowArray& batch, SortKeys& keys);
+
+ private:
+  class Impl;
+
+  explicit SortKeyEncoder(std::unique_ptr<Impl> impl);
+
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace iceberg
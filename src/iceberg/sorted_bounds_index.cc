@@ -0,0 +1,340 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/sorted_bounds_index.h"
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "iceberg/expression/binder.h"
+#include "iceberg/expression/predicate.h"
+#include "iceberg/expression/rewrite_not.h"
+#include "iceberg/expression/term.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/schema.h"
+#include "iceberg/sort_order.h"
+#include "iceberg/transform.h"
+#include "iceberg/type.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/conversions.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief An inclusive range of values of the sort column, unbounded on a side whose
+/// bound is unset.
+struct ValueRange {
+  std::optional<Literal> lower;
+  std::optional<Literal> upper;
+  bool empty = false;
+};
+
+/// \brief Returns whether the bounds of the column can be ordered without surprises:
+/// floating point columns may have NaN bounds and UUIDs are not totally ordered.
+bool IsOrdered(TypeId type_id) {
+  switch (type_id) {
+    case TypeId::kInt:
+    case TypeId::kLong:
+    case TypeId::kDecimal:
+    case TypeId::kDate:
+    case TypeId::kTime:
+    case TypeId::kTimestamp:
+    case TypeId::kTimestampTz:
+    case TypeId::kString:
+    case TypeId::kBinary:
+    case TypeId::kFixed:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// \brief Returns whether a literal can bound a range, which a null, below-min or
+/// above-max literal cannot.
+bool IsComparable(const Literal& literal) {
+  return !literal.IsNull() && !literal.IsBelowMin() && !literal.IsAboveMax();
+}
+
+/// \brief Returns the tighter of two bounds, or either one if they are unordered.
+std::optional<Literal> Tighter(std::optional<Literal> lhs, std::optional<Literal> rhs,
+                               bool lower) {
+  if (!lhs.has_value()) {
+    return rhs;
+  }
+  if (!rhs.has_value()) {
+    return lhs;
+  }
+  auto order = *lhs <=> *rhs;
+  if (lower ? order < 0 : order > 0) {
+    return rhs;
+  }
+  return lhs;
+}
+
+/// \brief Returns the looser of two bounds, unbounded if either is or if they are
+/// unordered.
+std::optional<Literal> Looser(std::optional<Literal> lhs, std::optional<Literal> rhs,
+                              bool lower) {
+  if (!lhs.has_value() || !rhs.has_value()) {
+    return std::nullopt;
+  }
+  auto order = *lhs <=> *rhs;
+  if (order == std::partial_ordering::unordered) {
+    return std::nullopt;
+  }
+  if (lower ? order > 0 : order < 0) {
+    return rhs;
+  }
+  return lhs;
+}
+
+/// \brief Returns the range of the column outside which no row can match a bound
+/// expression.
+Result<ValueRange> RangeOf(const Expression& expr, int32_t field_id) {
+  switch (expr.op()) {
+    case Expression::Operation::kFalse:
+      return ValueRange{.empty = true};
+    case Expression::Operation::kAnd: {
+      const auto& and_expr = internal::checked_cast<const And&>(expr);
+      ICEBERG_ASSIGN_OR_RAISE(auto left, RangeOf(*and_expr.left(), field_id));
+      ICEBERG_ASSIGN_OR_RAISE(auto right, RangeOf(*and_expr.right(), field_id));
+      if (left.empty || right.empty) {
+        return ValueRange{.empty = true};
+      }
+      return ValueRange{
+          .lower = Tighter(std::move(left.lower), std::move(right.lower), true),
+          .upper = Tighter(std::move(left.upper), std::move(right.upper), false)};
+    }
+    case Expression::Operation::kOr: {
+      const auto& or_expr = internal::checked_cast<const Or&>(expr);
+      ICEBERG_ASSIGN_OR_RAISE(auto left, RangeOf(*or_expr.left(), field_id));
+      ICEBERG_ASSIGN_OR_RAISE(auto right, RangeOf(*or_expr.right(), field_id));
+      if (left.empty) {
+        return right;
+      }
+      if (right.empty) {
+        return left;
+      }
+      return ValueRange{
+          .lower = Looser(std::move(left.lower), std::move(right.lower), true),
+          .upper = Looser(std::move(left.upper), std::move(right.upper), false)};
+    }
+    default:
+      break;
+  }
+
+  const auto* predicate = dynamic_cast<const BoundPredicate*>(&expr);
+  if (predicate == nullptr || predicate->term()->kind() != Term::Kind::kReference ||
+      predicate->term()->reference()->field().field_id() != field_id) {
+    return ValueRange{};
+  }
+  if (predicate->kind() == BoundPredicate::Kind::kLiteral) {
+    const auto& literal =
+        internal::checked_cast<const BoundLiteralPredicate&>(expr).literal();
+    if (!IsComparable(literal)) {
+      return ValueRange{};
+    }
+    switch (expr.op()) {
+      case Expression::Operation::kEq:
+        return ValueRange{.lower = literal, .upper = literal};
+      case Expression::Operation::kLt:
+      case Expression::Operation::kLtEq:
+        return ValueRange{.upper = literal};
+      case Expression::Operation::kGt:
+      case Expression::Operation::kGtEq:
+        return ValueRange{.lower = literal};
+      default:
+        return ValueRange{};
+    }
+  }
+  if (predicate->kind() == BoundPredicate::Kind::kSet &&
+      expr.op() == Expression::Operation::kIn) {
+    auto type = internal::checked_pointer_cast<PrimitiveType>(
+        predicate->term()->reference()->type());
+    ValueRange range{.empty = true};
+    for (const auto& value :
+         internal::checked_cast<const BoundSetPredicate&>(expr).literal_set()) {
+      ICEBERG_ASSIGN_OR_RAISE(auto bytes, Conversions::ToBytes(*type, value));
+      ICEBERG_ASSIGN_OR_RAISE(auto literal, Conversions::FromBytes(type, bytes));
+      if (range.empty) {
+        range = ValueRange{.lower = literal, .upper = literal};
+        continue;
+      }
+      range.lower = Looser(std::move(range.lower), literal, true);
+      range.upper = Looser(std::move(range.upper), std::move(literal), false);
+    }
+    return range;
+  }
+  return ValueRange{};
+}
+
+/// \brief Returns a key identifying the partition of a data file within a manifest.
+std::string PartitionKey(const DataFile& data_file) {
+  std::string key;
+  for (const auto& value : data_file.partition) {
+    key.push_back(value.IsNull() ? '\0' : '\1');
+    key.append(value.IsNull() ? "" : value.ToString());
+  }
+  return key;
+}
+
+/// \brief The bounds of a data file on the sort column.
+struct FileBounds {
+  size_t entry_index;
+  Literal lower;
+  Literal upper;
+};
+
+/// \brief The bounds of the live files of a partition.
+struct PartitionFiles {
+  std::vector<FileBounds> files;
+  bool indexable = true;
+};
+
+}  // namespace
+
+SortedBoundsIndex::SortedBoundsIndex(int32_t field_id,
+                                     std::shared_ptr<PrimitiveType> type,
+                                     std::optional<Literal> lower,
+                                     std::optional<Literal> upper, bool empty)
+    : field_id_(field_id),
+      type_(std::move(type)),
+      lower_(std::move(lower)),
+      upper_(std::move(upper)),
+      empty_(empty) {}
+
+SortedBoundsIndex::~SortedBoundsIndex() = default;
+
+Result<std::unique_ptr<SortedBoundsIndex>> SortedBoundsIndex::Make(
+    const SortOrder& sort_order, const std::shared_ptr<Expression>& expr,
+    const Schema& schema, bool case_sensitive) {
+  if (sort_order.fields().empty()) {
+    return nullptr;
+  }
+  const auto& sort_field = sort_order.fields().front();
+  if (sort_field.transform()->transform_type() != TransformType::kIdentity) {
+    return nullptr;
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto field, schema.FindFieldById(sort_field.source_id()));
+  if (!field.has_value() || !field->get().type()->is_primitive() ||
+      !IsOrdered(field->get().type()->type_id())) {
+    return nullptr;
+  }
+
+  ICEBERG_ASSIGN_OR_RAISE(auto rewritten, RewriteNot::Rewrite(expr));
+  ICEBERG_ASSIGN_OR_RAISE(auto is_bound, Binder::IsBound(rewritten));
+  if (!is_bound) {
+    ICEBERG_ASSIGN_OR_RAISE(rewritten, Binder::Bind(schema, rewritten, case_sensitive));
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto range, RangeOf(*rewritten, sort_field.source_id()));
+  if (!range.empty && !range.lower.has_value() && !range.upper.has_value()) {
+    return nullptr;
+  }
+  return std::unique_ptr<SortedBoundsIndex>(new SortedBoundsIndex(
+      sort_field.source_id(),
+      internal::checked_pointer_cast<PrimitiveType>(field->get().type()),
+      std::move(range.lower), std::move(range.upper), range.empty));
+}
+
+Result<std::vector<bool>> SortedBoundsIndex::RuledOut(
+    std::span<const ManifestEntry> entries) const {
+  std::vector<bool> ruled_out(entries.size(), false);
+  if (empty_) {
+    for (size_t i = 0; i < entries.size(); ++i) {
+      ruled_out[i] = entries[i].status != ManifestStatus::kDeleted;
+    }
+    return ruled_out;
+  }
+
+  // Collect the bounds of the live files of each partition. A partition with a file
+  // that has no bounds on the column cannot be indexed.
+  std::unordered_map<std::string, PartitionFiles> partitions;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    const auto& entry = entries[i];
+    if (entry.status == ManifestStatus::kDeleted) {
+      continue;
+    }
+    const auto& data_file = *entry.data_file;
+    auto& partition = partitions[PartitionKey(data_file)];
+    if (!partition.indexable) {
+      continue;
+    }
+    auto lower = data_file.lower_bounds.find(field_id_);
+    auto upper = data_file.upper_bounds.find(field_id_);
+    if (lower == data_file.lower_bounds.end() || upper == data_file.upper_bounds.end()) {
+      partition.indexable = false;
+      partition.files.clear();
+      continue;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto lower_bound,
+                            Conversions::FromBytes(type_, lower->second));
+    ICEBERG_ASSIGN_OR_RAISE(auto upper_bound,
+                            Conversions::FromBytes(type_, upper->second));
+    partition.files.push_back(FileBounds{.entry_index = i,
+                                         .lower = std::move(lower_bound),
+                                         .upper = std::move(upper_bound)});
+  }
+
+  for (auto& [_, partition] : partitions) {
+    auto& files = partition.files;
+    if (!partition.indexable || files.empty()) {
+      continue;
+    }
+    // Files written in sort order are usually listed in order already.
+    auto by_lower = [](const FileBounds& lhs, const FileBounds& rhs) {
+      return lhs.lower < rhs.lower;
+    };
+    if (!std::ranges::is_sorted(files, by_lower)) {
+      std::ranges::sort(files, by_lower);
+    }
+    // Only when the bounds do not overlap are the upper bounds sorted as well.
+    bool disjoint = files.front().lower <= files.front().upper;
+    for (size_t j = 1; disjoint && j < files.size(); ++j) {
+      disjoint = files[j - 1].upper <= files[j].lower && files[j].lower <= files[j].upper;
+    }
+    if (!disjoint) {
+      continue;
+    }
+
+    auto begin = files.begin();
+    if (lower_.has_value()) {
+      begin = std::ranges::partition_point(
+          files, [&](const FileBounds& file) { return file.upper < *lower_; });
+    }
+    auto end = files.end();
+    if (upper_.has_value()) {
+      end = std::ranges::partition_point(
+          files, [&](const FileBounds& file) { return file.lower <= *upper_; });
+    }
+    end = std::max(begin, end);
+    for (auto it = files.begin(); it != begin; ++it) {
+      ruled_out[it->entry_index] = true;
+    }
+    for (auto it = end; it != files.end(); ++it) {
+      ruled_out[it->entry_index] = true;
+    }
+  }
+  return ruled_out;
+}
+
+}  // namespace iceberg
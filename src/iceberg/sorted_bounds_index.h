@@ -0,0 +1,87 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/sorted_bounds_index.h
+/// Find the data files that may match a range of a sort column by binary search.
+
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "iceberg/expression/expression.h"
+#include "iceberg/expression/literal.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief Rules out the data files of a manifest whose bounds on the leading column of
+/// a sort order lie outside the range of that column allowed by a filter.
+///
+/// Files written in sort order usually have bounds that do not overlap within a
+/// partition. Sorted by lower bound, their upper bounds are then sorted as well, so the
+/// files that may hold a value of the range are found by binary search instead of
+/// evaluating the filter on the metrics of every file. Partitions whose files overlap or
+/// lack bounds on the column are left to the other evaluators.
+class ICEBERG_EXPORT SortedBoundsIndex {
+ public:
+  ~SortedBoundsIndex();
+
+  /// \brief Creates an index for the range of the leading sort column that a filter
+  /// allows.
+  ///
+  /// \param sort_order The sort order whose leading field selects the column
+  /// \param expr A bound or unbound expression on the table schema
+  /// \param schema The table schema to bind the expression to
+  /// \param case_sensitive Whether field name matching should be case sensitive
+  /// \return The index, or nullptr when the leading sort field is not an identity
+  /// transform of an ordered primitive column, or the filter does not bound it
+  static Result<std::unique_ptr<SortedBoundsIndex>> Make(
+      const SortOrder& sort_order, const std::shared_ptr<Expression>& expr,
+      const Schema& schema, bool case_sensitive = true);
+
+  /// \brief The field id of the indexed sort column.
+  int32_t field_id() const { return field_id_; }
+
+  /// \brief Returns which entries of a manifest cannot match the filter.
+  ///
+  /// Live entries are grouped by partition. Entries of a partition whose files do not
+  /// all have non-overlapping bounds on the column, and deleted entries, are never
+  /// ruled out.
+  Result<std::vector<bool>> RuledOut(std::span<const ManifestEntry> entries) const;
+
+ private:
+  SortedBoundsIndex(int32_t field_id, std::shared_ptr<PrimitiveType> type,
+                    std::optional<Literal> lower, std::optional<Literal> upper,
+                    bool empty);
+
+  int32_t field_id_;
+  std::shared_ptr<PrimitiveType> type_;
+  /// Inclusive bounds of the range, unbounded when unset.
+  std::optional<Literal> lower_;
+  std::optional<Literal> upper_;
+  /// Whether the filter allows no value, so that every file is ruled out.
+  bool empty_;
+};
+
+}  // namespace iceberg
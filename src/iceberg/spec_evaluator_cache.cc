@@ -0,0 +1,105 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/spec_evaluator_cache.h"
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include "iceberg/expression/manifest_evaluator.h"
+#include "iceberg/expression/residual_evaluator.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+Result<std::shared_ptr<const SpecEvaluators>> MakeSpecEvaluators(
+    const std::shared_ptr<PartitionSpec>& spec, const std::shared_ptr<Expression>& filter,
+    bool case_sensitive) {
+  auto evaluators = std::make_shared<SpecEvaluators>();
+  evaluators->spec = spec;
+  ICEBERG_ASSIGN_OR_RAISE(evaluators->partition_schema, spec->PartitionSchema());
+  if (filter != nullptr) {
+    ICEBERG_ASSIGN_OR_RAISE(
+        evaluators->manifest_evaluator,
+        ManifestEvaluator::MakeRowFilter(filter, spec, case_sensitive));
+    ICEBERG_ASSIGN_OR_RAISE(evaluators->residual_evaluator,
+                            ResidualEvaluator::Make(filter, spec, case_sensitive));
+  }
+  return evaluators;
+}
+
+}  // namespace
+
+size_t SpecEvaluatorCache::KeyHash::operator()(const Key& key) const {
+  size_t hash = std::hash<const PartitionSpec*>{}(key.spec);
+  hash = hash * 31 + std::hash<const Expression*>{}(key.filter);
+  return hash * 31 + static_cast<size_t>(key.case_sensitive);
+}
+
+SpecEvaluatorCache::SpecEvaluatorCache(size_t capacity)
+    : capacity_(std::max<size_t>(capacity, 1)) {}
+
+SpecEvaluatorCache::~SpecEvaluatorCache() = default;
+
+Result<std::shared_ptr<const SpecEvaluators>> SpecEvaluatorCache::Get(
+    const std::shared_ptr<PartitionSpec>& spec, const std::shared_ptr<Expression>& filter,
+    bool case_sensitive) {
+  if (spec == nullptr) {
+    return InvalidArgument("Cannot get the evaluators of a null partition spec");
+  }
+  const Key key{
+      .spec = spec.get(), .filter = filter.get(), .case_sensitive = case_sensitive};
+  {
+    std::lock_guard lock(mutex_);
+    if (auto it = index_.find(key); it != index_.end()) {
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return it->second->evaluators;
+    }
+  }
+
+  // Build outside the lock, a concurrent miss on the same key builds a duplicate and
+  // the first one inserted wins.
+  ICEBERG_ASSIGN_OR_RAISE(auto evaluators,
+                          MakeSpecEvaluators(spec, filter, case_sensitive));
+  std::lock_guard lock(mutex_);
+  if (auto it = index_.find(key); it != index_.end()) {
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->evaluators;
+  }
+  entries_.push_front(
+      Entry{.key = key, .filter = filter, .evaluators = std::move(evaluators)});
+  index_.emplace(key, entries_.begin());
+  if (entries_.size() > capacity_) {
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+  return entries_.front().evaluators;
+}
+
+size_t SpecEvaluatorCache::size() const {
+  std::lock_guard lock(mutex_);
+  return entries_.size();
+}
+
+}  // namespace iceberg
@@ -0,0 +1,108 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/spec_evaluator_cache.h
+/// Cache of the partition schemas and filter evaluators of partition specs.
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief The state derived from a partition spec and a filter to plan the manifests
+/// written with the spec.
+struct ICEBERG_EXPORT SpecEvaluators {
+  /// \brief The partition spec.
+  std::shared_ptr<PartitionSpec> spec;
+  /// \brief Schema of the partition tuples of the spec, or null if it is unpartitioned.
+  std::shared_ptr<Schema> partition_schema;
+  /// \brief Evaluator of the filter on the partition summaries of manifests, or null
+  /// without a filter.
+  std::shared_ptr<const ManifestEvaluator> manifest_evaluator;
+  /// \brief Evaluator of the residual of the filter for a partition, or null without a
+  /// filter.
+  std::shared_ptr<const ResidualEvaluator> residual_evaluator;
+};
+
+/// \brief A thread-safe LRU cache of SpecEvaluators.
+///
+/// Binding a filter to a partition spec and projecting it through the spec transforms
+/// is done once per spec and filter instead of once per scan, so repeated scans of a
+/// table with the same filter reuse the evaluators of the earlier ones, including the
+/// residuals they memoized per partition. Entries are keyed by the identity of the
+/// spec and the filter, which the cache keeps alive, and by case sensitivity.
+class ICEBERG_EXPORT SpecEvaluatorCache {
+ public:
+  /// \brief Default number of entries of a cache.
+  static constexpr size_t kDefaultCapacity = 128;
+
+  /// \brief Creates a cache holding up to `capacity` entries, at least one.
+  explicit SpecEvaluatorCache(size_t capacity = kDefaultCapacity);
+
+  ~SpecEvaluatorCache();
+
+  /// \brief Returns the evaluators of a spec for a filter, building them on a miss.
+  ///
+  /// \param spec The partition spec
+  /// \param filter The filter on table rows, or null for no filter
+  /// \param case_sensitive Whether field name matching should be case sensitive
+  Result<std::shared_ptr<const SpecEvaluators>> Get(
+      const std::shared_ptr<PartitionSpec>& spec,
+      const std::shared_ptr<Expression>& filter, bool case_sensitive);
+
+  /// \brief Returns the number of cached entries.
+  size_t size() const;
+
+ private:
+  struct Key {
+    const PartitionSpec* spec;
+    const Expression* filter;
+    bool case_sensitive;
+
+    bool operator==(const Key&) const = default;
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct Entry {
+    Key key;
+    // Keep the spec and filter alive so that their addresses are not reused.
+    std::shared_ptr<Expression> filter;
+    std::shared_ptr<const SpecEvaluators> evaluators;
+  };
+
+  const size_t capacity_;
+  mutable std::mutex mutex_;
+  // Most recently used first.
+  std::list<Entry> entries_;
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+};
+
+}  // namespace iceberg
@@ -0,0 +1,43 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/spill_options.h
+/// Options of the data spilled to local disk beyond a memory budget.
+
+#include <cstdint>
+#include <string>
+
+#include "iceberg/iceberg_export.h"
+
+namespace iceberg {
+
+/// \brief Where and beyond how much memory data is spilled to local disk.
+///
+/// Spilled data is written in a compact serialized form to temporary files, which are
+/// removed once the data is no longer needed, and read back when it is used.
+struct ICEBERG_EXPORT SpillOptions {
+  /// \brief The local directory of the spill files, created if missing.
+  std::string directory;
+  /// \brief The memory in bytes held before data is spilled, must be positive.
+  int64_t memory_budget_bytes = 0;
+};
+
+}  // namespace iceberg
@@ -22,9 +22,12 @@
 #include <algorithm>
 
 #include "iceberg/catalog.h"
+#include "iceberg/compact_snapshots.h"
 #include "iceberg/partition_spec.h"
 #include "iceberg/schema.h"
+#include "iceberg/snapshot_log_index.h"
 #include "iceberg/sort_order.h"
+#include "iceberg/spec_evaluator_cache.h"
 #include "iceberg/table_metadata.h"
 #include "iceberg/table_properties.h"
 #include "iceberg/table_scan.h"
@@ -42,7 +45,8 @@ Table::Table(TableIdentifier identifier, std::shared_ptr<TableMetadata> metadata
       metadata_location_(std::move(metadata_location)),
       io_(std::move(io)),
       catalog_(std::move(catalog)),
-      properties_(TableProperties::FromMap(metadata_->properties)) {}
+      properties_(TableProperties::FromMap(metadata_->properties)),
+      spec_evaluator_cache_(std::make_shared<SpecEvaluatorCache>()) {}
 
 const std::string& Table::uuid() const { return metadata_->table_uuid; }
 
@@ -57,10 +61,14 @@ Status Table::Refresh() {
     metadata_location_ = std::move(refreshed_table->metadata_location_);
     io_ = std::move(refreshed_table->io_);
     properties_ = std::move(refreshed_table->properties_);
+    // The evaluators are cached per spec object, which the new metadata replaces.
+    spec_evaluator_cache_ = std::make_shared<SpecEvaluatorCache>();
 
     schemas_map_.reset();
     partition_spec_map_.reset();
     sort_orders_map_.reset();
+    std::lock_guard lock(snapshot_log_index_mutex_);
+    snapshot_log_index_.reset();
   }
   return {};
 }
@@ -125,18 +133,40 @@ Result<std::shared_ptr<Snapshot>> Table::SnapshotById(int64_t snapshot_id) const
   return metadata_->SnapshotById(snapshot_id);
 }
 
-const std::vector<std::shared_ptr<Snapshot>>& Table::snapshots() const {
+const PersistentVector<std::shared_ptr<Snapshot>>& Table::snapshots() const {
+  // Compact snapshots were validated when the metadata was read, so materializing them
+  // does not fail.
+  if (const auto& compact = metadata_->compact_snapshots;
+      compact != nullptr && metadata_->snapshots.empty()) {
+    if (auto all = compact->All(); all.has_value()) {
+      return all->get();
+    }
+  }
   return metadata_->snapshots;
 }
 
-const std::vector<SnapshotLogEntry>& Table::history() const {
+const PersistentVector<SnapshotLogEntry>& Table::history() const {
   return metadata_->snapshot_log;
 }
 
 const std::shared_ptr<FileIO>& Table::io() const { return io_; }
 
+std::shared_ptr<const SnapshotLogIndex> Table::snapshot_log_index() const {
+  std::lock_guard lock(snapshot_log_index_mutex_);
+  if (!snapshot_log_index_) {
+    snapshot_log_index_ = std::make_shared<SnapshotLogIndex>(*metadata_);
+  }
+  return snapshot_log_index_;
+}
+
 std::unique_ptr<TableScanBuilder> Table::NewScan() const {
-  return std::make_unique<TableScanBuilder>(metadata_, io_);
+  auto builder = std::make_unique<TableScanBuilder>(metadata_, io_);
+  builder->WithSnapshotLogIndex(snapshot_log_index());
+  builder->WithSpecEvaluatorCache(spec_evaluator_cache_);
+  if (metrics_reporter_ != nullptr) {
+    builder->WithMetricsReporter(metrics_reporter_, identifier_);
+  }
+  return builder;
 }
 
 }  // namespace iceberg
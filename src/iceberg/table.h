@@ -20,6 +20,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -28,6 +29,7 @@
 #include "iceberg/snapshot.h"
 #include "iceberg/table_identifier.h"
 #include "iceberg/type_fwd.h"
+#include "iceberg/util/persistent_vector.h"
 
 namespace iceberg {
 
@@ -95,13 +97,17 @@ class ICEBERG_EXPORT Table {
   /// \return the Snapshot with the given id, return NotFoundError if not found
   Result<std::shared_ptr<Snapshot>> SnapshotById(int64_t snapshot_id) const;
 
-  /// \brief Get the snapshots of this table
-  const std::vector<std::shared_ptr<Snapshot>>& snapshots() const;
+  /// \brief Get the snapshots of this table, materializing them if the metadata keeps
+  /// them in a compact form
+  const PersistentVector<std::shared_ptr<Snapshot>>& snapshots() const;
 
   /// \brief Get the snapshot history of this table
   ///
   /// \return a vector of history entries
-  const std::vector<SnapshotLogEntry>& history() const;
+  const PersistentVector<SnapshotLogEntry>& history() const;
+
+  /// \brief Get the index of the snapshot history of this table, built on first use
+  std::shared_ptr<const SnapshotLogIndex> snapshot_log_index() const;
 
   /// \brief Create a new table scan builder for this table
   ///
@@ -112,6 +118,26 @@ class ICEBERG_EXPORT Table {
   /// \brief Returns a FileIO to read and write table data and metadata files
   const std::shared_ptr<FileIO>& io() const;
 
+  /// \brief Returns the current metadata of this table
+  const std::shared_ptr<TableMetadata>& metadata() const { return metadata_; }
+
+  /// \brief Returns the location of the current metadata file of this table
+  const std::string& metadata_location() const { return metadata_location_; }
+
+  /// \brief Returns the catalog this table belongs to, or null for a read-only table
+  const std::shared_ptr<Catalog>& catalog() const { return catalog_; }
+
+  /// \brief Returns the reporter of the scans and commits of this table, or null
+  const std::shared_ptr<MetricsReporter>& metrics_reporter() const {
+    return metrics_reporter_;
+  }
+
+  /// \brief Sets the reporter receiving a ScanReport for the scans created by NewScan()
+  /// and a CommitReport for each snapshot committed to this table
+  void set_metrics_reporter(std::shared_ptr<MetricsReporter> reporter) {
+    metrics_reporter_ = std::move(reporter);
+  }
+
  private:
   const TableIdentifier identifier_;
   std::shared_ptr<TableMetadata> metadata_;
@@ -119,6 +145,7 @@ class ICEBERG_EXPORT Table {
   std::shared_ptr<FileIO> io_;
   std::shared_ptr<Catalog> catalog_;
   std::unique_ptr<TableProperties> properties_;
+  std::shared_ptr<MetricsReporter> metrics_reporter_;
 
   // Cache lazy-initialized maps.
   mutable std::shared_ptr<std::unordered_map<int32_t, std::shared_ptr<Schema>>>
@@ -127,6 +154,11 @@ class ICEBERG_EXPORT Table {
       partition_spec_map_;
   mutable std::shared_ptr<std::unordered_map<int32_t, std::shared_ptr<SortOrder>>>
       sort_orders_map_;
+  // Built by the first scan of the metadata, which may run concurrently with others.
+  mutable std::mutex snapshot_log_index_mutex_;
+  mutable std::shared_ptr<const SnapshotLogIndex> snapshot_log_index_;
+  // Shared by the scans of the metadata, replaced on refresh.
+  std::shared_ptr<SpecEvaluatorCache> spec_evaluator_cache_;
 };
 
 }  // namespace iceberg
@@ -20,13 +20,20 @@
 #include "iceberg/table_metadata.h"
 
 #include <algorithm>
+#include <charconv>
 #include <chrono>
 #include <format>
+#include <istream>
 #include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <nlohmann/json.hpp>
 
+#include "iceberg/compact_snapshots.h"
 #include "iceberg/exception.h"
+#include "iceberg/executor.h"
 #include "iceberg/file_io.h"
 #include "iceberg/json_internal.h"
 #include "iceberg/partition_spec.h"
@@ -34,16 +41,33 @@
 #include "iceberg/schema.h"
 #include "iceberg/snapshot.h"
 #include "iceberg/sort_order.h"
+#include "iceberg/statistics_file.h"
+#include "iceberg/table_properties.h"
 #include "iceberg/table_update.h"
+#include "iceberg/type.h"
+#include "iceberg/util/checked_cast.h"
 #include "iceberg/util/gzip_internal.h"
 #include "iceberg/util/macros.h"
+#include "iceberg/util/string_util.h"
+#include "iceberg/util/tracing.h"
 #include "iceberg/util/uuid.h"
 
 namespace iceberg {
 
 namespace {
 const TimePointMs kInvalidLastUpdatedMs = TimePointMs::min();
+
+/// \brief Returns the highest ID of the fields of a type, at any depth.
+int32_t HighestFieldId(const Type& type) {
+  int32_t highest = Schema::kInvalidColumnId;
+  if (type.is_nested()) {
+    for (const auto& field : internal::checked_cast<const NestedType&>(type).fields()) {
+      highest = std::max({highest, field.field_id(), HighestFieldId(*field.type())});
+    }
+  }
+  return highest;
 }
+}  // namespace
 
 std::string ToString(const SnapshotLogEntry& entry) {
   return std::format("SnapshotLogEntry[timestampMillis={},snapshotId={}]",
@@ -80,6 +104,17 @@ Result<std::shared_ptr<PartitionSpec>> TableMetadata::PartitionSpec() const {
   return *iter;
 }
 
+Result<std::shared_ptr<PartitionSpec>> TableMetadata::PartitionSpecById(
+    int32_t spec_id) const {
+  auto iter = std::ranges::find_if(partition_specs, [spec_id](const auto& spec) {
+    return spec->spec_id() == spec_id;
+  });
+  if (iter == partition_specs.end()) {
+    return NotFound("Partition spec with ID {} is not found", spec_id);
+  }
+  return *iter;
+}
+
 Result<std::shared_ptr<SortOrder>> TableMetadata::SortOrder() const {
   auto iter = std::ranges::find_if(sort_orders, [this](const auto& order) {
     return order->order_id() == default_sort_order_id;
@@ -98,17 +133,40 @@ Result<std::shared_ptr<Snapshot>> TableMetadata::SnapshotById(int64_t snapshot_i
   auto iter = std::ranges::find_if(snapshots, [snapshot_id](const auto& snapshot) {
     return snapshot->snapshot_id == snapshot_id;
   });
-  if (iter == snapshots.end()) {
-    return NotFound("Snapshot with ID {} is not found", snapshot_id);
+  if (iter != snapshots.end()) {
+    return *iter;
   }
-  return *iter;
+  if (compact_snapshots != nullptr) {
+    return compact_snapshots->Get(snapshot_id);
+  }
+  return NotFound("Snapshot with ID {} is not found", snapshot_id);
+}
+
+bool TableMetadata::HasSnapshot(int64_t snapshot_id) const {
+  return std::ranges::any_of(snapshots,
+                             [snapshot_id](const auto& snapshot) {
+                               return snapshot->snapshot_id == snapshot_id;
+                             }) ||
+         (compact_snapshots != nullptr &&
+          compact_snapshots->Find(snapshot_id).has_value());
+}
+
+Result<PersistentVector<std::shared_ptr<Snapshot>>> TableMetadata::AllSnapshots() const {
+  if (compact_snapshots == nullptr) {
+    return snapshots;
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto compact, compact_snapshots->All());
+  auto all = snapshots;
+  for (const auto& snapshot : compact.get()) {
+    all.push_back(snapshot);
+  }
+  return all;
 }
 
 namespace {
 
-template <typename T>
-bool SharedPtrVectorEquals(const std::vector<std::shared_ptr<T>>& lhs,
-                           const std::vector<std::shared_ptr<T>>& rhs) {
+template <typename Vector>
+bool SharedPtrVectorEquals(const Vector& lhs, const Vector& rhs) {
   if (lhs.size() != rhs.size()) {
     return false;
   }
@@ -138,6 +196,17 @@ bool SnapshotRefEquals(
   return true;
 }
 
+/// \brief Compares the snapshots of two tables, whether they are compact or not.
+bool SnapshotsEqual(const TableMetadata& lhs, const TableMetadata& rhs) {
+  if (lhs.compact_snapshots == nullptr && rhs.compact_snapshots == nullptr) {
+    return SharedPtrVectorEquals(lhs.snapshots, rhs.snapshots);
+  }
+  auto lhs_snapshots = lhs.AllSnapshots();
+  auto rhs_snapshots = rhs.AllSnapshots();
+  return lhs_snapshots.has_value() && rhs_snapshots.has_value() &&
+         SharedPtrVectorEquals(lhs_snapshots.value(), rhs_snapshots.value());
+}
+
 }  // namespace
 
 bool operator==(const TableMetadata& lhs, const TableMetadata& rhs) {
@@ -152,7 +221,7 @@ bool operator==(const TableMetadata& lhs, const TableMetadata& rhs) {
          lhs.last_partition_id == rhs.last_partition_id &&
          lhs.properties == rhs.properties &&
          lhs.current_snapshot_id == rhs.current_snapshot_id &&
-         SharedPtrVectorEquals(lhs.snapshots, rhs.snapshots) &&
+         SnapshotsEqual(lhs, rhs) &&
          lhs.snapshot_log == rhs.snapshot_log && lhs.metadata_log == rhs.metadata_log &&
          SharedPtrVectorEquals(lhs.sort_orders, rhs.sort_orders) &&
          lhs.default_sort_order_id == rhs.default_sort_order_id &&
@@ -174,35 +243,143 @@ Result<MetadataFileCodecType> TableMetadataUtil::CodecFromFileName(
   }
 
   std::string_view file_name_without_suffix =
-      file_name.substr(0, file_name.find_last_of(".metadata.json"));
+      file_name.substr(0, file_name.rfind(".metadata.json"));
   if (file_name_without_suffix.ends_with(".gz")) {
     return MetadataFileCodecType::kGzip;
   }
   return MetadataFileCodecType::kNone;
 }
 
+Result<MetadataFileCodecType> TableMetadataUtil::CodecFromName(std::string_view name) {
+  auto codec_name = StringUtils::ToLower(name);
+  if (codec_name == "none") {
+    return MetadataFileCodecType::kNone;
+  }
+  if (codec_name == "gzip") {
+    return MetadataFileCodecType::kGzip;
+  }
+  return InvalidArgument("Invalid metadata compression codec: {}", name);
+}
+
+std::string_view TableMetadataUtil::FileExtension(MetadataFileCodecType codec_type) {
+  switch (codec_type) {
+    case MetadataFileCodecType::kGzip:
+      return ".gz.metadata.json";
+    case MetadataFileCodecType::kNone:
+      break;
+  }
+  return ".metadata.json";
+}
+
 Result<std::unique_ptr<TableMetadata>> TableMetadataUtil::Read(
-    FileIO& io, const std::string& location, std::optional<size_t> length) {
+    FileIO& io, const std::string& location, std::optional<size_t> length,
+    const TableMetadataReadOptions& options) {
+  ICEBERG_TRACE_SCOPE(trace, "TableMetadataUtil::Read");
+  ICEBERG_TRACE_ATTRIBUTE(trace, "path", location);
   ICEBERG_ASSIGN_OR_RAISE(auto codec_type, CodecFromFileName(location));
 
-  ICEBERG_ASSIGN_OR_RAISE(auto content, io.ReadFile(location, length));
   if (codec_type == MetadataFileCodecType::kGzip) {
-    auto gzip_decompressor = std::make_unique<GZipDecompressor>();
-    ICEBERG_RETURN_UNEXPECTED(gzip_decompressor->Init());
-    auto result = gzip_decompressor->Decompress(content);
-    ICEBERG_RETURN_UNEXPECTED(result);
-    content = result.value();
+    // The decompressed text is parsed as it is inflated, so that neither the compressed
+    // nor the decompressed content is held in memory at once.
+    ICEBERG_ASSIGN_OR_RAISE(auto file, io.NewInputFile(location, length));
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto buffer,
+        GZipInputBuffer::Make(std::move(file), options.executor != nullptr
+                                                   ? options.executor
+                                                   : DefaultExecutor()));
+    std::istream stream(buffer.get());
+    auto metadata = TableMetadataFromJsonStream(stream, options);
+    // A decompression error ends the stream, which then fails to parse.
+    ICEBERG_RETURN_UNEXPECTED(buffer->status());
+    return metadata;
   }
 
-  ICEBERG_ASSIGN_OR_RAISE(auto json, FromJsonString(content));
-  return TableMetadataFromJson(json);
+  ICEBERG_ASSIGN_OR_RAISE(auto content, io.ReadFile(location, length));
+  ICEBERG_TRACE_ATTRIBUTE(trace, "bytes", static_cast<int64_t>(content.size()));
+  return TableMetadataFromJsonString(content, options);
 }
 
 Status TableMetadataUtil::Write(FileIO& io, const std::string& location,
                                 const TableMetadata& metadata) {
-  auto json = ToJson(metadata);
-  ICEBERG_ASSIGN_OR_RAISE(auto json_string, ToJsonString(json));
-  return io.WriteFile(location, json_string);
+  ICEBERG_TRACE_SCOPE(trace, "TableMetadataUtil::Write");
+  ICEBERG_TRACE_ATTRIBUTE(trace, "path", location);
+  ICEBERG_ASSIGN_OR_RAISE(auto codec_type, CodecFromFileName(location));
+  // The JSON text is streamed into the file, compressed on the fly if needed, so that
+  // neither a JSON tree nor the full text of the metadata is held in memory.
+  ICEBERG_ASSIGN_OR_RAISE(auto file, io.NewOutputFile(location));
+  if (codec_type == MetadataFileCodecType::kGzip) {
+    ICEBERG_ASSIGN_OR_RAISE(
+        file, GZipOutputFile::Make(std::move(file),
+                                   GZipCompressor::kDefaultCompressionLevel,
+                                   DefaultExecutor()));
+  }
+  ICEBERG_RETURN_UNEXPECTED(WriteJson(metadata, *file));
+  return file->Close();
+}
+
+std::vector<std::string> TableMetadataUtil::RemovedMetadataFiles(
+    const TableMetadata& base, const TableMetadata& metadata) {
+  auto properties = TableProperties::FromMap(metadata.properties);
+  if (!properties->Get(TableProperties::kMetadataDeleteAfterCommitEnabled)) {
+    return {};
+  }
+  std::unordered_set<std::string_view> logged_files;
+  for (const auto& entry : metadata.metadata_log) {
+    logged_files.insert(entry.metadata_file);
+  }
+  std::vector<std::string> removed_files;
+  for (const auto& entry : base.metadata_log) {
+    if (!logged_files.contains(entry.metadata_file)) {
+      removed_files.push_back(entry.metadata_file);
+    }
+  }
+  return removed_files;
+}
+
+std::string TableMetadataUtil::MetadataFileLocation(const TableMetadata& metadata,
+                                                    std::string_view file_name) {
+  auto properties = TableProperties::FromMap(metadata.properties);
+  std::string_view folder = properties->Get(TableProperties::kWriteMetadataLocation);
+  std::string default_folder;
+  if (folder.empty()) {
+    std::string_view location = metadata.location;
+    while (location.ends_with('/')) {
+      location.remove_suffix(1);
+    }
+    default_folder = std::format("{}/metadata", location);
+    folder = default_folder;
+  }
+  while (folder.ends_with('/')) {
+    folder.remove_suffix(1);
+  }
+  return std::format("{}/{}", folder, file_name);
+}
+
+Result<std::string> TableMetadataUtil::NewMetadataFileLocation(
+    const TableMetadata& metadata, std::string_view current_location) {
+  // Metadata files written by this library are named "<version>-<uuid>.*", files with
+  // other names count as version 0.
+  std::string_view file_name = current_location;
+  if (auto pos = file_name.find_last_of('/'); pos != std::string_view::npos) {
+    file_name.remove_prefix(pos + 1);
+  }
+  int64_t version = 0;
+  if (auto dash = file_name.find('-'); dash != std::string_view::npos) {
+    auto digits = file_name.substr(0, dash);
+    if (!digits.empty() && std::ranges::all_of(digits, [](char c) {
+          return c >= '0' && c <= '9';
+        })) {
+      std::from_chars(digits.data(), digits.data() + digits.size(), version);
+    }
+  }
+
+  auto properties = TableProperties::FromMap(metadata.properties);
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto codec_type,
+      CodecFromName(properties->Get(TableProperties::kMetadataCompression)));
+  return MetadataFileLocation(
+      metadata, std::format("{:05d}-{}{}", version + 1, Uuid::GenerateV4().ToString(),
+                            FileExtension(codec_type)));
 }
 
 // TableMetadataBuilder implementation
@@ -224,6 +401,9 @@ struct TableMetadataBuilder::Impl {
   std::optional<std::string> metadata_location;
   std::optional<std::string> previous_metadata_location;
 
+  // ID of the schema added or reused by the last AddSchema call
+  std::optional<int32_t> last_added_schema_id;
+
   // Constructor for new table
   explicit Impl(int8_t format_version) : base(nullptr), metadata{} {
     metadata.format_version = format_version;
@@ -273,7 +453,13 @@ TableMetadataBuilder& TableMetadataBuilder::SetMetadataLocation(
 
 TableMetadataBuilder& TableMetadataBuilder::SetPreviousMetadataLocation(
     std::string_view previous_metadata_location) {
-  throw IcebergError(std::format("{} not implemented", __FUNCTION__));
+  if (impl_->base == nullptr) {
+    impl_->errors.emplace_back(ErrorKind::kInvalidArgument,
+                               "Cannot set previous metadata location of a new table");
+    return *this;
+  }
+  impl_->previous_metadata_location = std::string(previous_metadata_location);
+  return *this;
 }
 
 TableMetadataBuilder& TableMetadataBuilder::AssignUUID() {
@@ -315,15 +501,73 @@ TableMetadataBuilder& TableMetadataBuilder::UpgradeFormatVersion(
 
 TableMetadataBuilder& TableMetadataBuilder::SetCurrentSchema(
     std::shared_ptr<Schema> schema, int32_t new_last_column_id) {
-  throw IcebergError(std::format("{} not implemented", __FUNCTION__));
+  AddSchema(std::move(schema));
+  impl_->metadata.last_column_id =
+      std::max(impl_->metadata.last_column_id, new_last_column_id);
+  return SetCurrentSchema(kLastAdded);
 }
 
 TableMetadataBuilder& TableMetadataBuilder::SetCurrentSchema(int32_t schema_id) {
-  throw IcebergError(std::format("{} not implemented", __FUNCTION__));
+  if (schema_id == kLastAdded) {
+    if (!impl_->last_added_schema_id.has_value()) {
+      impl_->errors.emplace_back(ErrorKind::kInvalidArgument,
+                                 "Cannot set last added schema: no schema was added");
+      return *this;
+    }
+    schema_id = impl_->last_added_schema_id.value();
+  }
+
+  auto& metadata = impl_->metadata;
+  if (metadata.current_schema_id == schema_id) {
+    return *this;
+  }
+  if (std::ranges::none_of(metadata.schemas, [&](const auto& schema) {
+        return schema->schema_id() == schema_id;
+      })) {
+    impl_->errors.emplace_back(
+        ErrorKind::kInvalidArgument,
+        std::format("Cannot set current schema to unknown schema: {}", schema_id));
+    return *this;
+  }
+
+  metadata.current_schema_id = schema_id;
+  impl_->changes.push_back(std::make_unique<table::SetCurrentSchema>(schema_id));
+  return *this;
 }
 
 TableMetadataBuilder& TableMetadataBuilder::AddSchema(std::shared_ptr<Schema> schema) {
-  throw IcebergError(std::format("{} not implemented", __FUNCTION__));
+  if (schema == nullptr) {
+    impl_->errors.emplace_back(ErrorKind::kInvalidArgument, "Cannot add null schema");
+    return *this;
+  }
+
+  // A schema with the fields of an existing schema reuses its ID.
+  auto& metadata = impl_->metadata;
+  auto existing = std::ranges::find_if(metadata.schemas, [&](const auto& other) {
+    return std::ranges::equal(other->fields(), schema->fields());
+  });
+  if (existing != metadata.schemas.end()) {
+    impl_->last_added_schema_id = (*existing)->schema_id();
+    return *this;
+  }
+
+  int32_t schema_id = Schema::kInitialSchemaId;
+  for (const auto& other : metadata.schemas) {
+    schema_id =
+        std::max(schema_id, other->schema_id().value_or(Schema::kInitialSchemaId) + 1);
+  }
+  if (schema->schema_id() != schema_id) {
+    schema = std::make_shared<Schema>(
+        std::vector<SchemaField>(schema->fields().begin(), schema->fields().end()),
+        schema_id);
+  }
+
+  metadata.last_column_id = std::max(metadata.last_column_id, HighestFieldId(*schema));
+  metadata.schemas.push_back(schema);
+  impl_->last_added_schema_id = schema_id;
+  impl_->changes.push_back(
+      std::make_unique<table::AddSchema>(std::move(schema), metadata.last_column_id));
+  return *this;
 }
 
 TableMetadataBuilder& TableMetadataBuilder::SetDefaultPartitionSpec(
@@ -366,31 +610,214 @@ TableMetadataBuilder& TableMetadataBuilder::AddSortOrder(
 
 TableMetadataBuilder& TableMetadataBuilder::AddSnapshot(
     std::shared_ptr<Snapshot> snapshot) {
-  throw IcebergError(std::format("{} not implemented", __FUNCTION__));
+  if (snapshot == nullptr) {
+    impl_->errors.emplace_back(ErrorKind::kInvalidArgument, "Cannot add null snapshot");
+    return *this;
+  }
+
+  auto& metadata = impl_->metadata;
+  if (metadata.HasSnapshot(snapshot->snapshot_id)) {
+    impl_->errors.emplace_back(
+        ErrorKind::kInvalidArgument,
+        std::format("Snapshot already exists for id: {}", snapshot->snapshot_id));
+    return *this;
+  }
+
+  // A snapshot with a parent must be newer than every snapshot already in the table.
+  if (metadata.format_version > 1 && snapshot->parent_snapshot_id.has_value() &&
+      snapshot->sequence_number <= metadata.last_sequence_number) {
+    impl_->errors.emplace_back(
+        ErrorKind::kInvalidArgument,
+        std::format("Cannot add snapshot with sequence number {} older than last "
+                    "sequence number {}",
+                    snapshot->sequence_number, metadata.last_sequence_number));
+    return *this;
+  }
+
+  // From format version 3, each snapshot assigns the row IDs after those of the
+  // snapshots already in the table.
+  if (metadata.format_version >= 3) {
+    if (!snapshot->first_row_id.has_value() || !snapshot->added_rows.has_value()) {
+      impl_->errors.emplace_back(
+          ErrorKind::kInvalidArgument,
+          "Cannot add a snapshot without first-row-id and added-rows");
+      return *this;
+    }
+    if (snapshot->first_row_id.value() < metadata.next_row_id) {
+      impl_->errors.emplace_back(
+          ErrorKind::kInvalidArgument,
+          std::format("Cannot add a snapshot with first-row-id {} behind the table "
+                      "next-row-id {}",
+                      snapshot->first_row_id.value(), metadata.next_row_id));
+      return *this;
+    }
+    metadata.next_row_id += snapshot->added_rows.value();
+  }
+
+  metadata.last_updated_ms = snapshot->timestamp_ms;
+  metadata.last_sequence_number = snapshot->sequence_number;
+  metadata.snapshots.push_back(snapshot);
+
+  impl_->changes.push_back(std::make_unique<table::AddSnapshot>(std::move(snapshot)));
+  return *this;
 }
 
 TableMetadataBuilder& TableMetadataBuilder::SetBranchSnapshot(int64_t snapshot_id,
                                                               const std::string& branch) {
-  throw IcebergError(std::format("{} not implemented", __FUNCTION__));
+  SnapshotRef::Branch retention;
+  if (auto it = impl_->metadata.refs.find(branch); it != impl_->metadata.refs.end()) {
+    const auto& ref = it->second;
+    if (ref->type() != SnapshotRefType::kBranch) {
+      impl_->errors.emplace_back(
+          ErrorKind::kInvalidArgument,
+          std::format("Cannot update branch: {} is a tag", branch));
+      return *this;
+    }
+    if (ref->snapshot_id == snapshot_id) {
+      return *this;
+    }
+    // Moving a branch keeps its retention policy.
+    retention = std::get<SnapshotRef::Branch>(ref->retention);
+  }
+
+  return SetRef(branch, std::make_shared<SnapshotRef>(SnapshotRef{
+                            .snapshot_id = snapshot_id, .retention = retention}));
 }
 
 TableMetadataBuilder& TableMetadataBuilder::SetRef(const std::string& name,
                                                    std::shared_ptr<SnapshotRef> ref) {
-  throw IcebergError(std::format("{} not implemented", __FUNCTION__));
+  if (ref == nullptr) {
+    impl_->errors.emplace_back(ErrorKind::kInvalidArgument,
+                               "Cannot set null snapshot ref");
+    return *this;
+  }
+
+  auto& metadata = impl_->metadata;
+  if (auto it = metadata.refs.find(name);
+      it != metadata.refs.end() && *it->second == *ref) {
+    return *this;
+  }
+
+  const int64_t snapshot_id = ref->snapshot_id;
+  if (!metadata.HasSnapshot(snapshot_id)) {
+    impl_->errors.emplace_back(
+        ErrorKind::kInvalidArgument,
+        std::format("Cannot set {} to unknown snapshot: {}", name, snapshot_id));
+    return *this;
+  }
+
+  if (name == SnapshotRef::kMainBranch) {
+    // The snapshot log records when the current snapshot changed, which is the commit
+    // time of a snapshot added by this change set.
+    auto added = std::ranges::find_if(impl_->changes, [&](const auto& change) {
+      const auto* add = dynamic_cast<const table::AddSnapshot*>(change.get());
+      return add != nullptr && add->snapshot()->snapshot_id == snapshot_id;
+    });
+    if (added != impl_->changes.end()) {
+      metadata.last_updated_ms =
+          static_cast<const table::AddSnapshot&>(**added).snapshot()->timestamp_ms;
+    } else {
+      metadata.last_updated_ms =
+          TimePointMs{std::chrono::duration_cast<std::chrono::milliseconds>(
+              std::chrono::system_clock::now().time_since_epoch())};
+    }
+    metadata.current_snapshot_id = snapshot_id;
+    metadata.snapshot_log.push_back(
+        SnapshotLogEntry{.timestamp_ms = metadata.last_updated_ms,
+                         .snapshot_id = snapshot_id});
+  }
+
+  std::optional<int32_t> min_snapshots_to_keep;
+  std::optional<int64_t> max_snapshot_age_ms;
+  std::optional<int64_t> max_ref_age_ms;
+  if (const auto* branch = std::get_if<SnapshotRef::Branch>(&ref->retention)) {
+    min_snapshots_to_keep = branch->min_snapshots_to_keep;
+    max_snapshot_age_ms = branch->max_snapshot_age_ms;
+    max_ref_age_ms = branch->max_ref_age_ms;
+  } else {
+    max_ref_age_ms = std::get<SnapshotRef::Tag>(ref->retention).max_ref_age_ms;
+  }
+  impl_->changes.push_back(std::make_unique<table::SetSnapshotRef>(
+      name, snapshot_id, ref->type(), min_snapshots_to_keep, max_snapshot_age_ms,
+      max_ref_age_ms));
+
+  metadata.refs[name] = std::move(ref);
+  return *this;
 }
 
 TableMetadataBuilder& TableMetadataBuilder::RemoveRef(const std::string& name) {
-  throw IcebergError(std::format("{} not implemented", __FUNCTION__));
+  if (name == SnapshotRef::kMainBranch) {
+    impl_->metadata.current_snapshot_id = Snapshot::kInvalidSnapshotId;
+  }
+
+  if (impl_->metadata.refs.erase(name) == 0) {
+    return *this;
+  }
+
+  impl_->changes.push_back(std::make_unique<table::RemoveSnapshotRef>(name));
+  return *this;
 }
 
 TableMetadataBuilder& TableMetadataBuilder::RemoveSnapshots(
     const std::vector<std::shared_ptr<Snapshot>>& snapshots_to_remove) {
-  throw IcebergError(std::format("{} not implemented", __FUNCTION__));
+  std::vector<int64_t> snapshot_ids;
+  snapshot_ids.reserve(snapshots_to_remove.size());
+  for (const auto& snapshot : snapshots_to_remove) {
+    if (snapshot != nullptr) {
+      snapshot_ids.push_back(snapshot->snapshot_id);
+    }
+  }
+  return RemoveSnapshots(snapshot_ids);
 }
 
 TableMetadataBuilder& TableMetadataBuilder::RemoveSnapshots(
     const std::vector<int64_t>& snapshot_ids) {
-  throw IcebergError(std::format("{} not implemented", __FUNCTION__));
+  auto& metadata = impl_->metadata;
+  if (metadata.compact_snapshots != nullptr) {
+    impl_->errors.emplace_back(ErrorKind::kInvalidArgument,
+                               "Cannot remove snapshots from lazily read snapshots");
+    return *this;
+  }
+
+  std::unordered_set<int64_t> to_remove(snapshot_ids.begin(), snapshot_ids.end());
+  std::vector<int64_t> removed;
+  erase_if(metadata.snapshots, [&](const auto& snapshot) {
+    if (!to_remove.contains(snapshot->snapshot_id)) {
+      return false;
+    }
+    removed.push_back(snapshot->snapshot_id);
+    return true;
+  });
+  if (removed.empty()) {
+    return *this;
+  }
+  std::unordered_set<int64_t> removed_ids(removed.begin(), removed.end());
+
+  for (const auto snapshot_id : removed) {
+    RemoveStatistics(snapshot_id);
+    RemovePartitionStatistics(snapshot_id);
+  }
+
+  // Refs cannot point to removed snapshots.
+  std::vector<std::string> dangling_refs;
+  for (const auto& [name, ref] : metadata.refs) {
+    if (removed_ids.contains(ref->snapshot_id)) {
+      dangling_refs.push_back(name);
+    }
+  }
+  for (const auto& name : dangling_refs) {
+    RemoveRef(name);
+  }
+
+  // The snapshot log only keeps the changes after the last removed snapshot, so that
+  // it is a complete history of the current snapshot.
+  auto last_removed = std::ranges::find_if(
+      metadata.snapshot_log.rbegin(), metadata.snapshot_log.rend(),
+      [&](const auto& entry) { return removed_ids.contains(entry.snapshot_id); });
+  metadata.snapshot_log.erase(metadata.snapshot_log.begin(), last_removed.base());
+
+  impl_->changes.push_back(std::make_unique<table::RemoveSnapshots>(std::move(removed)));
+  return *this;
 }
 
 TableMetadataBuilder& TableMetadataBuilder::suppressHistoricalSnapshots() {
@@ -399,31 +826,90 @@ TableMetadataBuilder& TableMetadataBuilder::suppressHistoricalSnapshots() {
 
 TableMetadataBuilder& TableMetadataBuilder::SetStatistics(
     const std::shared_ptr<StatisticsFile>& statistics_file) {
-  throw IcebergError(std::format("{} not implemented", __FUNCTION__));
+  if (statistics_file == nullptr) {
+    impl_->errors.emplace_back(ErrorKind::kInvalidArgument,
+                               "Cannot set null statistics file");
+    return *this;
+  }
+
+  // A snapshot has a single statistics file, which replaces the previous one.
+  auto& statistics = impl_->metadata.statistics;
+  std::erase_if(statistics, [&](const auto& file) {
+    return file->snapshot_id == statistics_file->snapshot_id;
+  });
+  statistics.push_back(statistics_file);
+
+  impl_->changes.push_back(std::make_unique<table::SetStatistics>(statistics_file));
+  return *this;
 }
 
 TableMetadataBuilder& TableMetadataBuilder::RemoveStatistics(int64_t snapshot_id) {
-  throw IcebergError(std::format("{} not implemented", __FUNCTION__));
+  if (std::erase_if(impl_->metadata.statistics, [&](const auto& file) {
+        return file->snapshot_id == snapshot_id;
+      }) == 0) {
+    return *this;
+  }
+
+  impl_->changes.push_back(std::make_unique<table::RemoveStatistics>(snapshot_id));
+  return *this;
 }
 
 TableMetadataBuilder& TableMetadataBuilder::SetPartitionStatistics(
     const std::shared_ptr<PartitionStatisticsFile>& partition_statistics_file) {
-  throw IcebergError(std::format("{} not implemented", __FUNCTION__));
+  if (partition_statistics_file == nullptr) {
+    impl_->errors.emplace_back(ErrorKind::kInvalidArgument,
+                               "Cannot set null partition statistics file");
+    return *this;
+  }
+
+  auto& partition_statistics = impl_->metadata.partition_statistics;
+  std::erase_if(partition_statistics, [&](const auto& file) {
+    return file->snapshot_id == partition_statistics_file->snapshot_id;
+  });
+  partition_statistics.push_back(partition_statistics_file);
+
+  impl_->changes.push_back(
+      std::make_unique<table::SetPartitionStatistics>(partition_statistics_file));
+  return *this;
 }
 
 TableMetadataBuilder& TableMetadataBuilder::RemovePartitionStatistics(
     int64_t snapshot_id) {
-  throw IcebergError(std::format("{} not implemented", __FUNCTION__));
+  if (std::erase_if(impl_->metadata.partition_statistics, [&](const auto& file) {
+        return file->snapshot_id == snapshot_id;
+      }) == 0) {
+    return *this;
+  }
+
+  impl_->changes.push_back(
+      std::make_unique<table::RemovePartitionStatistics>(snapshot_id));
+  return *this;
 }
 
 TableMetadataBuilder& TableMetadataBuilder::SetProperties(
     const std::unordered_map<std::string, std::string>& updated) {
-  throw IcebergError(std::format("{} not implemented", __FUNCTION__));
+  if (updated.empty()) {
+    return *this;
+  }
+
+  for (const auto& [key, value] : updated) {
+    impl_->metadata.properties[key] = value;
+  }
+  impl_->changes.push_back(std::make_unique<table::SetProperties>(updated));
+  return *this;
 }
 
 TableMetadataBuilder& TableMetadataBuilder::RemoveProperties(
     const std::vector<std::string>& removed) {
-  throw IcebergError(std::format("{} not implemented", __FUNCTION__));
+  if (removed.empty()) {
+    return *this;
+  }
+
+  for (const auto& key : removed) {
+    impl_->metadata.properties.erase(key);
+  }
+  impl_->changes.push_back(std::make_unique<table::RemoveProperties>(removed));
+  return *this;
 }
 
 TableMetadataBuilder& TableMetadataBuilder::SetLocation(std::string_view location) {
@@ -458,7 +944,24 @@ Result<std::unique_ptr<TableMetadata>> TableMetadataBuilder::Build() {
             std::chrono::system_clock::now().time_since_epoch())};
   }
 
-  // 4. Create and return the TableMetadata
+  // 4. Log the previous metadata file, keeping the most recent ones only
+  if (impl_->previous_metadata_location.has_value()) {
+    auto& metadata_log = impl_->metadata.metadata_log;
+    metadata_log.push_back(
+        MetadataLogEntry{.timestamp_ms = impl_->base->last_updated_ms,
+                         .metadata_file = std::move(*impl_->previous_metadata_location)});
+    const auto max_previous_versions = std::max<int64_t>(
+        TableProperties::FromMap(impl_->metadata.properties)
+            ->Get(TableProperties::kMetadataPreviousVersionsMax),
+        1);
+    if (std::cmp_greater(metadata_log.size(), max_previous_versions)) {
+      metadata_log.erase(
+          metadata_log.begin(),
+          metadata_log.end() - static_cast<ptrdiff_t>(max_previous_versions));
+    }
+  }
+
+  // 5. Create and return the TableMetadata
   auto result = std::make_unique<TableMetadata>(std::move(impl_->metadata));
 
   return result;
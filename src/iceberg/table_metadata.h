@@ -23,6 +23,7 @@
 /// Table metadata for Iceberg tables.
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -30,6 +31,7 @@
 
 #include "iceberg/iceberg_export.h"
 #include "iceberg/type_fwd.h"
+#include "iceberg/util/persistent_vector.h"
 #include "iceberg/util/timepoint.h"
 
 namespace iceberg {
@@ -101,13 +103,20 @@ struct ICEBERG_EXPORT TableMetadata {
   /// ID of the current table snapshot
   int64_t current_snapshot_id;
   /// A list of valid snapshots
-  std::vector<std::shared_ptr<iceberg::Snapshot>> snapshots;
+  ///
+  /// The snapshots and the logs grow with the history of the table and are shared by
+  /// the copies of the metadata, so that building new metadata from it only copies
+  /// what changes.
+  PersistentVector<std::shared_ptr<iceberg::Snapshot>> snapshots;
+  /// Snapshots kept in a compact form and materialized on demand, when the metadata is
+  /// read with TableMetadataReadOptions::lazy_snapshots. Null otherwise.
+  std::shared_ptr<const CompactSnapshots> compact_snapshots;
   /// A list of timestamp and snapshot ID pairs that encodes changes to the current
   /// snapshot for the table
-  std::vector<SnapshotLogEntry> snapshot_log;
+  PersistentVector<SnapshotLogEntry> snapshot_log;
   /// A list of timestamp and metadata file location pairs that encodes changes to the
   /// previous metadata files for the table
-  std::vector<MetadataLogEntry> metadata_log;
+  PersistentVector<MetadataLogEntry> metadata_log;
   /// A list of sort orders
   std::vector<std::shared_ptr<iceberg::SortOrder>> sort_orders;
   /// Default sort order id of the table
@@ -128,12 +137,21 @@ struct ICEBERG_EXPORT TableMetadata {
       const std::optional<int32_t>& schema_id) const;
   /// \brief Get the current partition spec, return NotFoundError if not found
   Result<std::shared_ptr<iceberg::PartitionSpec>> PartitionSpec() const;
+  /// \brief Get the partition spec by ID, return NotFoundError if not found
+  Result<std::shared_ptr<iceberg::PartitionSpec>> PartitionSpecById(
+      int32_t spec_id) const;
   /// \brief Get the current sort order, return NotFoundError if not found
   Result<std::shared_ptr<iceberg::SortOrder>> SortOrder() const;
   /// \brief Get the current snapshot, return NotFoundError if not found
   Result<std::shared_ptr<iceberg::Snapshot>> Snapshot() const;
   /// \brief Get the snapshot of this table with the given id
   Result<std::shared_ptr<iceberg::Snapshot>> SnapshotById(int64_t snapshot_id) const;
+  /// \brief Returns whether the table has a snapshot with the given id, without
+  /// materializing it
+  bool HasSnapshot(int64_t snapshot_id) const;
+  /// \brief Get all snapshots of this table, including the compact snapshots, which are
+  /// materialized
+  Result<PersistentVector<std::shared_ptr<iceberg::Snapshot>>> AllSnapshots() const;
 
   ICEBERG_EXPORT friend bool operator==(const TableMetadata& lhs,
                                         const TableMetadata& rhs);
@@ -160,6 +178,10 @@ ICEBERG_EXPORT std::string ToString(const MetadataLogEntry& entry);
 /// Build() is called.
 class ICEBERG_EXPORT TableMetadataBuilder {
  public:
+  /// \brief Schema ID passed to SetCurrentSchema to select the schema of the last
+  /// AddSchema call
+  static constexpr int32_t kLastAdded = -1;
+
   /// \brief Create a builder for a new table
   ///
   /// \param format_version The format version for the table
@@ -181,6 +203,10 @@ class ICEBERG_EXPORT TableMetadataBuilder {
 
   /// \brief Set the previous metadata location of the table
   ///
+  /// The location is added to the metadata log with the last updated time of the base
+  /// metadata, and the oldest entries are dropped so that the log keeps at most
+  /// `write.metadata.previous-versions-max` files.
+  ///
   /// \param previous_metadata_location The previous metadata location
   /// \return Reference to this builder for method chaining
   TableMetadataBuilder& SetPreviousMetadataLocation(
@@ -214,12 +240,15 @@ class ICEBERG_EXPORT TableMetadataBuilder {
 
   /// \brief Set the current schema by schema ID
   ///
-  /// \param schema_id The ID of the schema to set as current
+  /// \param schema_id The ID of the schema to set as current, or kLastAdded
   /// \return Reference to this builder for method chaining
   TableMetadataBuilder& SetCurrentSchema(int32_t schema_id);
 
   /// \brief Add a schema to the table
   ///
+  /// The schema is assigned the next schema ID, unless an existing schema has the same
+  /// fields, whose ID is reused.
+  ///
   /// \param schema The schema to add
   /// \return Reference to this builder for method chaining
   TableMetadataBuilder& AddSchema(std::shared_ptr<Schema> schema);
@@ -411,6 +440,32 @@ enum class ICEBERG_EXPORT MetadataFileCodecType {
   kGzip,
 };
 
+/// \brief Options for reading table metadata files.
+struct ICEBERG_EXPORT TableMetadataReadOptions {
+  /// \brief Whether to keep only the snapshots that are referenced by a branch or tag,
+  /// or are ancestors of a referenced snapshot.
+  ///
+  /// Tables with long histories keep many expired or orphaned snapshots, which are not
+  /// needed to scan the branches and tags of the table. Metadata read with this option
+  /// misses those snapshots, so it must not be used as the base of a commit.
+  bool only_referenced_snapshots = false;
+
+  /// \brief Whether to keep the snapshots in TableMetadata::compact_snapshots, which
+  /// materializes them on demand, instead of TableMetadata::snapshots.
+  ///
+  /// Readers that only use the current snapshot or a few others then do not pay for the
+  /// whole history of the table. The snapshots are still validated when read.
+  bool lazy_snapshots = false;
+
+  /// \brief The pool sharing the schemas, partition specs and sort orders of the
+  /// metadata with equal ones read before, or null to keep separate copies.
+  std::shared_ptr<MetadataInternPool> intern_pool;
+
+  /// \brief The executor decompressing the members of gzip metadata files written by
+  /// TableMetadataUtil::Write, or null for the DefaultExecutor().
+  std::shared_ptr<Executor> executor;
+};
+
 /// \brief Utility class for table metadata
 struct ICEBERG_EXPORT TableMetadataUtil {
   /// \brief Get the codec type from the table metadata file name.
@@ -419,23 +474,76 @@ struct ICEBERG_EXPORT TableMetadataUtil {
   /// \return The codec type of the table metadata file.
   static Result<MetadataFileCodecType> CodecFromFileName(std::string_view file_name);
 
+  /// \brief Get the codec type from its name, as set in the
+  /// `write.metadata.compression-codec` table property.
+  ///
+  /// \param name The case-insensitive name of the codec, "none" or "gzip".
+  /// \return The codec type, or an error if the codec is unknown.
+  static Result<MetadataFileCodecType> CodecFromName(std::string_view name);
+
+  /// \brief Get the file name extension of table metadata files written with a codec.
+  ///
+  /// \param codec_type The codec type of the table metadata file.
+  /// \return The extension, such as ".gz.metadata.json" for gzip.
+  static std::string_view FileExtension(MetadataFileCodecType codec_type);
+
   /// \brief Read the table metadata file.
   ///
   /// \param io The file IO to use to read the table metadata.
   /// \param location The location of the table metadata file.
   /// \param length The optional length of the table metadata file.
+  /// \param options The options for reading the table metadata.
   /// \return The table metadata.
   static Result<std::unique_ptr<TableMetadata>> Read(
       class FileIO& io, const std::string& location,
-      std::optional<size_t> length = std::nullopt);
+      std::optional<size_t> length = std::nullopt,
+      const TableMetadataReadOptions& options = {});
 
   /// \brief Write the table metadata to a file.
   ///
+  /// The metadata is compressed with the codec of the file name of the location, see
+  /// CodecFromFileName and FileExtension.
+  ///
   /// \param io The file IO to use to write the table metadata.
   /// \param location The location of the table metadata file.
   /// \param metadata The table metadata to write.
   static Status Write(FileIO& io, const std::string& location,
                       const TableMetadata& metadata);
+
+  /// \brief Get the location of a file in the metadata folder of a table.
+  ///
+  /// The folder is set by the `write.metadata.path` table property, and defaults to the
+  /// "metadata" folder underneath the table location.
+  ///
+  /// \param metadata The table metadata.
+  /// \param file_name The name of the file.
+  /// \return The location of the file.
+  static std::string MetadataFileLocation(const TableMetadata& metadata,
+                                          std::string_view file_name);
+
+  /// \brief Get the location of the next version of a table metadata file.
+  ///
+  /// The file is named "<version>-<uuid>.metadata.json", with the extension of the
+  /// `write.metadata.compression-codec` table property, and a version one greater than
+  /// the version of the current metadata file.
+  ///
+  /// \param metadata The new table metadata.
+  /// \param current_location The location of the current table metadata file.
+  /// \return The location of the new table metadata file.
+  static Result<std::string> NewMetadataFileLocation(const TableMetadata& metadata,
+                                                     std::string_view current_location);
+
+  /// \brief Get the previous metadata files of a table that a commit dropped from its
+  /// metadata log, to be deleted once the commit succeeded.
+  ///
+  /// Files are only returned when the `write.metadata.delete-after-commit.enabled`
+  /// table property of the new metadata is true.
+  ///
+  /// \param base The table metadata replaced by the commit.
+  /// \param metadata The table metadata of the commit.
+  /// \return The locations of the metadata files that are no longer logged.
+  static std::vector<std::string> RemovedMetadataFiles(const TableMetadata& base,
+                                                       const TableMetadata& metadata);
 };
 
 }  // namespace iceberg
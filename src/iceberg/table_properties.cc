@@ -41,6 +41,7 @@ std::unique_ptr<TableProperties> TableProperties::FromMap(
   for (const auto& [key, value] : properties) {  // NOLINT(modernize-type-traits)
     table_properties->configs_[key] = value;
   }
+  table_properties->Parse();
   return table_properties;
 }
 
@@ -99,6 +99,8 @@ class ICEBERG_EXPORT TableProperties : public ConfigBase<TableProperties> {
   inline static Entry<int32_t> kManifestMinMergeCount{
       "commit.manifest.min-count-to-merge", 100};
   inline static Entry<bool> kManifestMergeEnabled{"commit.manifest-merge.enabled", true};
+  inline static Entry<int32_t> kManifestWriteParallelism{
+      "commit.manifest.write-parallelism", 1};
 
   // File format properties
 
@@ -148,6 +150,10 @@ class ICEBERG_EXPORT TableProperties : public ConfigBase<TableProperties> {
       "write.parquet.bloom-filter-enabled.column."};
   inline static std::string_view kParquetColumnStatsEnabledPrefix{
       "write.parquet.stats-enabled.column."};
+  inline static Entry<bool> kParquetAdaptiveEncodingEnabled{
+      "write.parquet.adaptive-encoding.enabled", false};
+  inline static std::string_view kParquetColumnEncodingPrefix{
+      "write.parquet.encoding.column."};
 
   // Avro properties
   inline static Entry<std::string> kAvroCompression{"write.avro.compression-codec",
@@ -194,6 +200,8 @@ class ICEBERG_EXPORT TableProperties : public ConfigBase<TableProperties> {
                                                   int64_t{4} * 1024 * 1024};  // 4 MB
   inline static Entry<bool> kAdaptiveSplitSizeEnabled{"read.split.adaptive-size.enabled",
                                                       true};
+  inline static Entry<bool> kSplitProjectedSizeEnabled{
+      "read.split.projected-size.enabled", false};
   inline static Entry<bool> kParquetVectorizationEnabled{
       "read.parquet.vectorization.enabled", true};
   inline static Entry<int32_t> kParquetBatchSize{"read.parquet.vectorization.batch-size",
@@ -204,6 +212,9 @@ class ICEBERG_EXPORT TableProperties : public ConfigBase<TableProperties> {
   inline static Entry<std::string> kDataPlanningMode{"read.data-planning-mode", "auto"};
   inline static Entry<std::string> kDeletePlanningMode{"read.delete-planning-mode",
                                                        "auto"};
+  /// \brief Checks that the strings read by table scans are valid UTF-8. When disabled,
+  /// the data files are trusted to only hold valid UTF-8 strings.
+  inline static Entry<bool> kValidateUtf8Enabled{"read.validate-utf8.enabled", false};
 
   // Write properties
 
@@ -233,6 +244,8 @@ class ICEBERG_EXPORT TableProperties : public ConfigBase<TableProperties> {
       "write.metadata.metrics.max-inferred-column-defaults", 100};
   inline static Entry<std::string> kDefaultWriteMetricsMode{
       "write.metadata.metrics.default", "truncate(16)"};
+  inline static std::string_view kMetricsModeColumnConfPrefix{
+      "write.metadata.metrics.column."};
 
   inline static std::string_view kDefaultNameMapping{"schema.name-mapping.default"};
 
@@ -19,6 +19,7 @@
 
 #include "iceberg/table_requirement.h"
 
+#include "iceberg/snapshot.h"
 #include "iceberg/table_metadata.h"
 #include "iceberg/util/string_util.h"
 
@@ -45,12 +46,47 @@ Status AssertUUID::Validate(const TableMetadata* base) const {
 }
 
 Status AssertRefSnapshotID::Validate(const TableMetadata* base) const {
-  return NotImplemented("AssertTableRefSnapshotID::Validate not implemented");
+  // Validate that the ref still points to the snapshot it had when the metadata was read
+
+  if (base == nullptr) {
+    return CommitFailed("Requirement failed: current table metadata is missing");
+  }
+
+  auto it = base->refs.find(ref_name_);
+  if (it != base->refs.end() && it->second != nullptr) {
+    const auto& ref = *it->second;
+    if (!snapshot_id_.has_value()) {
+      return CommitFailed("Requirement failed: {} {} was created concurrently",
+                          ToString(ref.type()), ref_name_);
+    }
+    if (ref.snapshot_id != snapshot_id_.value()) {
+      return CommitFailed(
+          "Requirement failed: {} {} has changed (expected id={}, actual id={})",
+          ToString(ref.type()), ref_name_, snapshot_id_.value(), ref.snapshot_id);
+    }
+  } else if (snapshot_id_.has_value()) {
+    return CommitFailed("Requirement failed: branch or tag {} is missing, expected {}",
+                        ref_name_, snapshot_id_.value());
+  }
+
+  return {};
 }
 
 Status AssertLastAssignedFieldId::Validate(const TableMetadata* base) const {
-  return NotImplemented(
-      "AssertCurrentTableLastAssignedFieldId::Validate not implemented");
+  // Validate that no field ID was assigned since the metadata was read
+
+  if (base == nullptr) {
+    return CommitFailed("Requirement failed: current table metadata is missing");
+  }
+
+  if (base->last_column_id != last_assigned_field_id_) {
+    return CommitFailed(
+        "Requirement failed: last assigned field ID does not match (expected={}, "
+        "actual={})",
+        last_assigned_field_id_, base->last_column_id);
+  }
+
+  return {};
 }
 
 Status AssertCurrentSchemaID::Validate(const TableMetadata* base) const {
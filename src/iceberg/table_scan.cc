@@ -19,38 +19,423 @@
 
 #include "iceberg/table_scan.h"
 
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
+#include <format>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "iceberg/arrow_c_data.h"
+#include "iceberg/async.h"
+#include "iceberg/deletes/delete_file_index.h"
+#include "iceberg/deletes/delete_loader.h"
+#include "iceberg/deletes/equality_delete_set.h"
+#include "iceberg/deletes/position_delete_index.h"
+#include "iceberg/executor.h"
+#include "iceberg/expression/batch_evaluator.h"
+#include "iceberg/expression/binder.h"
+#include "iceberg/expression/inclusive_metrics_evaluator.h"
+#include "iceberg/expression/manifest_evaluator.h"
+#include "iceberg/expression/residual_evaluator.h"
+#include "iceberg/expression/rewrite_not.h"
 #include "iceberg/file_reader.h"
+#include "iceberg/manifest_cache.h"
 #include "iceberg/manifest_entry.h"
 #include "iceberg/manifest_list.h"
 #include "iceberg/manifest_reader.h"
+#include "iceberg/metrics_reporter.h"
+#include "iceberg/partition_field.h"
+#include "iceberg/partition_map.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/prefetching_file_io.h"
+#include "iceberg/puffin/bloom_filter_index.h"
+#include "iceberg/scan_explain.h"
+#include "iceberg/scan_plan_cache.h"
+#include "iceberg/scan_task_serialization.h"
+#include "iceberg/scan_task_spill.h"
 #include "iceberg/schema.h"
 #include "iceberg/schema_field.h"
 #include "iceberg/snapshot.h"
+#include "iceberg/snapshot_log_index.h"
+#include "iceberg/sort_field.h"
+#include "iceberg/sort_order.h"
+#include "iceberg/sorted_bounds_index.h"
+#include "iceberg/spec_evaluator_cache.h"
 #include "iceberg/table_metadata.h"
+#include "iceberg/table_properties.h"
+#include "iceberg/transform.h"
+#include "iceberg/util/arrow_array_filter_internal.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/conversions.h"
 #include "iceberg/util/macros.h"
+#include "iceberg/util/merged_stream_internal.h"
+#include "iceberg/util/murmurhash3_internal.h"
+#include "iceberg/util/sorted_merge_stream_internal.h"
+#include "iceberg/util/utf8_internal.h"
 
 namespace iceberg {
 
 namespace {
+
+/// \brief Processes the batches of a stream ahead in steps run on executors.
+///
+/// The first step reads the batches and each following one transforms the batches of
+/// the previous step, e.g. reading them on an executor for I/O and filtering them on
+/// one for computation. A step is submitted to its executor while fewer than
+/// `capacity` of its batches wait for the next step, so the steps overlap with each
+/// other and with the processing of the taken batches, and a consumer that takes
+/// batches slowly holds back every step. A step runs once at a time, so batches keep
+/// their order. Processing stops at the end of the batches or at the first error,
+/// which is returned by every later call to Next. When a batch is requested and no
+/// step that could provide it is running, the calling thread runs the last step that
+/// can run instead of waiting for a submitted one to start, so a stream is never
+/// stalled by a busy executor.
+class BatchPipeline {
+ public:
+  using Batch = Result<std::optional<ArrowArray>>;
+
+  /// \brief A step of the pipeline.
+  struct Step {
+    /// \brief Reads the next batch, or returns nullopt at the end of the batches. Set
+    /// for the first step only.
+    std::function<Batch()> read;
+    /// \brief Transforms a batch of the previous step, or returns nullopt to drop it.
+    /// Set for the following steps.
+    std::function<Batch(ArrowArray)> transform;
+    /// \brief The executor running the step.
+    std::shared_ptr<Executor> executor;
+  };
+
+  BatchPipeline(size_t capacity, std::vector<Step> steps)
+      : state_(std::make_shared<State>(std::max<size_t>(capacity, 1), std::move(steps))) {
+    std::unique_lock lock(state_->mutex);
+    State::Schedule(state_, lock);
+  }
+
+  ~BatchPipeline() {
+    std::unique_lock lock(state_->mutex);
+    state_->stopped = true;
+    // A step that has not started is never run, and a running one is waited for, so
+    // the reader is not used once the pipeline is destroyed.
+    state_->cv.wait(lock, [&]() {
+      return std::ranges::none_of(state_->steps, [](const StepState& step) {
+        return step.run == RunState::kRunning;
+      });
+    });
+    for (auto& step : state_->steps) {
+      for (auto& batch : step.batches) {
+        if (batch.has_value() && batch->has_value() && (*batch)->release != nullptr) {
+          (*batch)->release(&batch->value());
+        }
+      }
+      step.batches.clear();
+    }
+  }
+
+  /// \brief Returns the next batch, processing it or waiting for it if needed.
+  Batch Next() {
+    std::unique_lock lock(state_->mutex);
+    auto& batches = state_->steps.back().batches;
+    while (batches.empty()) {
+      if (auto step = state_->LastRunnable()) {
+        State::RunOne(state_, *step, lock);
+      } else {
+        state_->cv.wait(lock);
+      }
+    }
+    if (IsLast(batches.front())) {
+      // The end of the batches or the error stays for the later calls.
+      return batches.front();
+    }
+    auto batch = std::move(batches.front());
+    batches.pop_front();
+    State::Schedule(state_, lock);
+    return batch;
+  }
+
+ private:
+  enum class RunState {
+    kIdle,
+    kSubmitted,
+    kRunning,
+  };
+
+  static bool IsLast(const Batch& batch) {
+    return !batch.has_value() || !batch->has_value();
+  }
+
+  struct StepState {
+    explicit StepState(Step step) : step(std::move(step)) {}
+
+    Step step;
+    /// \brief The batches of the step not taken by the next one yet, ending with the
+    /// last one once the step is done.
+    std::deque<Batch> batches;
+    RunState run = RunState::kIdle;
+    bool done = false;
+  };
+
+  /// \brief The state shared with the submitted steps, which may start after the
+  /// pipeline is destroyed.
+  struct State {
+    State(size_t capacity, std::vector<Step> steps) : capacity(capacity) {
+      this->steps.reserve(steps.size());
+      for (auto& step : steps) {
+        this->steps.emplace_back(std::move(step));
+      }
+    }
+
+    /// \brief Returns whether a step that is not running has a batch to process and
+    /// room for its result, called with the lock held.
+    bool CanRun(size_t index) const {
+      const auto& step = steps[index];
+      return !step.done && step.run != RunState::kRunning &&
+             step.batches.size() < capacity &&
+             (index == 0 || !steps[index - 1].batches.empty());
+    }
+
+    /// \brief Returns the last step that can run, called with the lock held.
+    std::optional<size_t> LastRunnable() const {
+      for (size_t index = steps.size(); index > 0; --index) {
+        if (CanRun(index - 1)) {
+          return index - 1;
+        }
+      }
+      return std::nullopt;
+    }
+
+    /// \brief Submits the steps that can run and are not submitted yet, called with
+    /// the lock held.
+    static void Schedule(const std::shared_ptr<State>& state,
+                         std::unique_lock<std::mutex>& lock) {
+      if (state->stopped) {
+        return;
+      }
+      std::vector<size_t> submits;
+      for (size_t index = 0; index < state->steps.size(); ++index) {
+        if (state->steps[index].run == RunState::kIdle && state->CanRun(index)) {
+          state->steps[index].run = RunState::kSubmitted;
+          submits.push_back(index);
+        }
+      }
+      if (submits.empty()) {
+        return;
+      }
+      lock.unlock();
+      for (size_t index : submits) {
+        state->steps[index].step.executor->Submit([state, index]() {
+          std::unique_lock task_lock(state->mutex);
+          auto& step = state->steps[index];
+          if (step.run != RunState::kSubmitted || state->stopped) {
+            return;
+          }
+          if (state->CanRun(index)) {
+            RunOne(state, index, task_lock);
+          } else {
+            step.run = RunState::kIdle;
+          }
+        });
+      }
+      lock.lock();
+    }
+
+    /// \brief Runs a step on one batch without the lock and schedules the next steps,
+    /// called with the lock held and the step able to run.
+    static void RunOne(const std::shared_ptr<State>& state, size_t index,
+                       std::unique_lock<std::mutex>& lock) {
+      auto& step = state->steps[index];
+      std::optional<ArrowArray> input;
+      if (index > 0) {
+        auto& inputs = state->steps[index - 1].batches;
+        if (IsLast(inputs.front())) {
+          // The end of the batches or the error is passed on.
+          step.batches.push_back(inputs.front());
+          step.done = true;
+          step.run = RunState::kIdle;
+          state->cv.notify_all();
+          return;
+        }
+        input = std::move(inputs.front()).value();
+        inputs.pop_front();
+      }
+      step.run = RunState::kRunning;
+      lock.unlock();
+      auto batch = input.has_value() ? step.step.transform(std::move(input.value()))
+                                     : step.step.read();
+      lock.lock();
+      if (index == 0 || !batch.has_value() || batch->has_value()) {
+        step.done = IsLast(batch);
+        step.batches.push_back(std::move(batch));
+      }
+      step.run = RunState::kIdle;
+      state->cv.notify_all();
+      Schedule(state, lock);
+    }
+
+    const size_t capacity;
+    std::vector<StepState> steps;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool stopped = false;
+  };
+
+  std::shared_ptr<State> state_;
+};
+
 /// \brief Private data structure to hold the Reader and error state
 struct ReaderStreamPrivateData {
   std::unique_ptr<Reader> reader;
+  /// \brief Serializes the calls to the reader, which are made on the executors when
+  /// batches are prefetched.
+  std::mutex reader_mutex;
+  /// \brief Reads the batches ahead, or null to read them in GetNext.
+  std::unique_ptr<BatchPipeline> pipeline;
+  /// \brief Evaluates the filter on each batch when rows are filtered, or null.
+  std::unique_ptr<BatchEvaluator> evaluator;
+  /// \brief The rows deleted by equality delete files.
+  std::vector<std::shared_ptr<const EqualityDeleteSet>> equality_deletes;
+  /// \brief Schema of the batches read from the reader.
+  std::shared_ptr<Schema> read_schema;
+  /// \brief Number of leading columns of the batches that are returned. The other
+  /// columns are only read to apply equality deletes.
+  int64_t num_columns = 0;
+  /// \brief Schema of the batches, fetched from the reader when filtering the first
+  /// batch.
+  ArrowSchema schema{};
+  /// \brief Receives the metrics of reading the batches, never null.
+  std::shared_ptr<ReadMetrics> metrics;
   std::string last_error;
 
-  explicit ReaderStreamPrivateData(std::unique_ptr<Reader> reader_ptr)
-      : reader(std::move(reader_ptr)) {}
+  bool FiltersRows() const { return evaluator != nullptr || !equality_deletes.empty(); }
 
   ~ReaderStreamPrivateData() {
+    // Stop prefetching before the reader is closed.
+    pipeline.reset();
+    if (schema.release != nullptr) {
+      schema.release(&schema);
+    }
     if (reader) {
       std::ignore = reader->Close();
     }
   }
 };
 
+/// \brief Releases the trailing children of an Arrow array or schema.
+template <typename T>
+void DropTrailingChildren(T& parent, int64_t n_children) {
+  for (int64_t i = n_children; i < parent.n_children; ++i) {
+    if (parent.children[i]->release != nullptr) {
+      parent.children[i]->release(parent.children[i]);
+    }
+  }
+  parent.n_children = std::min(parent.n_children, n_children);
+}
+
+/// \brief Returns the number of set bits of a selection bitmap.
+int64_t CountSelected(const std::vector<uint8_t>& selection) {
+  int64_t selected = 0;
+  for (uint8_t byte : selection) {
+    selected += std::popcount(byte);
+  }
+  return selected;
+}
+
+/// \brief Removes the rows of a batch that do not match the filter or that are deleted
+/// by equality deletes.
+///
+/// The batch is released unless it is returned as is because all of its rows match.
+/// \return The matching rows, or nullopt if there are none.
+Result<std::optional<ArrowArray>> FilterBatch(ReaderStreamPrivateData& private_data,
+                                              ArrowArray batch) {
+  auto filter = [&]() -> Result<std::optional<ArrowArray>> {
+    if (private_data.schema.release == nullptr) {
+      std::lock_guard lock(private_data.reader_mutex);
+      ICEBERG_ASSIGN_OR_RAISE(private_data.schema, private_data.reader->Schema());
+    }
+    std::vector<uint8_t> selection;
+    int64_t matching = batch.length;
+    if (private_data.evaluator != nullptr) {
+      ICEBERG_ASSIGN_OR_RAISE(
+          selection, private_data.evaluator->Evaluate(private_data.schema, batch));
+      matching = CountSelected(selection);
+    } else {
+      selection.assign((batch.length + 7) / 8, 0xFF);
+      if (batch.length % 8 != 0) {
+        selection.back() = static_cast<uint8_t>((1 << (batch.length % 8)) - 1);
+      }
+    }
+    for (const auto& deletes : private_data.equality_deletes) {
+      ICEBERG_RETURN_UNEXPECTED(deletes->RemoveDeleted(
+          *private_data.read_schema, private_data.schema, batch, selection));
+    }
+    const int64_t selected =
+        private_data.equality_deletes.empty() ? matching : CountSelected(selection);
+    private_data.metrics->rows_filtered.Increment(batch.length - matching);
+    private_data.metrics->rows_deleted.Increment(matching - selected);
+    if (selected == batch.length) {
+      return std::exchange(batch, ArrowArray{});
+    }
+    if (selected == 0) {
+      return std::nullopt;
+    }
+    return FilterArrowArray(private_data.schema, batch, selection);
+  };
+  auto result = filter();
+  if (batch.release != nullptr) {
+    batch.release(&batch);
+  }
+  return result;
+}
+
+/// \brief Reads the next batch from the reader, without filtering its rows.
+///
+/// \return The next batch, or nullopt at the end of the batches.
+Result<std::optional<ArrowArray>> ReadBatch(ReaderStreamPrivateData& private_data) {
+  std::lock_guard lock(private_data.reader_mutex);
+  Result<std::optional<ArrowArray>> batch;
+  {
+    auto timed = private_data.metrics->decode_duration.Start();
+    batch = private_data.reader->Next();
+  }
+  if (batch.has_value() && batch->has_value()) {
+    private_data.metrics->rows_read.Increment((*batch)->length);
+  }
+  return batch;
+}
+
+/// \brief Reads the next batch with matching rows from the reader.
+///
+/// Batches without matching rows are skipped.
+/// \return The next batch, or nullopt at the end of the batches.
+Result<std::optional<ArrowArray>> ReadNextBatch(ReaderStreamPrivateData& private_data) {
+  while (true) {
+    ICEBERG_ASSIGN_OR_RAISE(auto batch, ReadBatch(private_data));
+    if (!batch.has_value() || !private_data.FiltersRows()) {
+      return batch;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(batch, FilterBatch(private_data, std::move(batch.value())));
+    if (batch.has_value()) {
+      return batch;
+    }
+  }
+}
+
 /// \brief Callback to get the stream schema
 static int GetSchema(struct ArrowArrayStream* stream, struct ArrowSchema* out) {
   if (!stream || !stream->private_data) {
@@ -58,7 +443,11 @@ static int GetSchema(struct ArrowArrayStream* stream, struct ArrowSchema* out) {
   }
   auto* private_data = static_cast<ReaderStreamPrivateData*>(stream->private_data);
   // Get schema from reader
-  auto schema_result = private_data->reader->Schema();
+  Result<ArrowSchema> schema_result;
+  {
+    std::lock_guard lock(private_data->reader_mutex);
+    schema_result = private_data->reader->Schema();
+  }
   if (!schema_result.has_value()) {
     private_data->last_error = schema_result.error().message;
     std::memset(out, 0, sizeof(ArrowSchema));
@@ -66,6 +455,7 @@ static int GetSchema(struct ArrowArrayStream* stream, struct ArrowSchema* out) {
   }
 
   *out = std::move(schema_result.value());
+  DropTrailingChildren(*out, private_data->num_columns);
   return 0;
 }
 
@@ -77,7 +467,13 @@ static int GetNext(struct ArrowArrayStream* stream, struct ArrowArray* out) {
 
   auto* private_data = static_cast<ReaderStreamPrivateData*>(stream->private_data);
 
-  auto next_result = private_data->reader->Next();
+  Result<std::optional<ArrowArray>> next_result;
+  if (private_data->pipeline != nullptr) {
+    auto timed = private_data->metrics->wait_duration.Start();
+    next_result = private_data->pipeline->Next();
+  } else {
+    next_result = ReadNextBatch(*private_data);
+  }
   if (!next_result.has_value()) {
     private_data->last_error = next_result.error().message;
     std::memset(out, 0, sizeof(ArrowArray));
@@ -87,6 +483,9 @@ static int GetNext(struct ArrowArrayStream* stream, struct ArrowArray* out) {
   auto& optional_array = next_result.value();
   if (optional_array.has_value()) {
     *out = std::move(optional_array.value());
+    DropTrailingChildren(*out, private_data->num_columns);
+    private_data->metrics->batches.Increment();
+    private_data->metrics->rows_returned.Increment(out->length);
   } else {
     // End of stream - set release to nullptr to signal end
     std::memset(out, 0, sizeof(ArrowArray));
@@ -117,12 +516,48 @@ static void Release(struct ArrowArrayStream* stream) {
   stream->release = nullptr;
 }
 
-Result<ArrowArrayStream> MakeArrowArrayStream(std::unique_ptr<Reader> reader) {
-  if (!reader) {
+/// \brief Wraps a reader into an ArrowArrayStream.
+///
+/// \param private_data The reader of the batches and the deletes and filter that
+/// remove rows from them.
+/// \param prefetch_batches The number of batches to read ahead on the executors, or 0
+/// to read each batch when it is requested.
+/// \param executor The executor of the reads ahead, the default executor if null.
+/// \param io_executor The executor of the reads ahead when rows are filtered on
+/// `executor`, or null to read and filter them on `executor`.
+Result<ArrowArrayStream> MakeArrowArrayStream(
+    std::unique_ptr<ReaderStreamPrivateData> private_data, int32_t prefetch_batches,
+    std::shared_ptr<Executor> executor, std::shared_ptr<Executor> io_executor) {
+  if (!private_data->reader) {
     return InvalidArgument("Reader cannot be null");
   }
-
-  auto private_data = std::make_unique<ReaderStreamPrivateData>(std::move(reader));
+  if (prefetch_batches < 0) {
+    return InvalidArgument("Number of batches to prefetch cannot be negative: {}",
+                           prefetch_batches);
+  }
+  if (prefetch_batches > 0) {
+    auto* data = private_data.get();
+    if (executor == nullptr) {
+      executor = DefaultExecutor();
+    }
+    std::vector<BatchPipeline::Step> steps;
+    if (io_executor != nullptr && data->FiltersRows()) {
+      // Batches are read on the I/O executor and filtered on the other one.
+      steps.push_back({.read = [data]() { return ReadBatch(*data); },
+                       .executor = std::move(io_executor)});
+      steps.push_back({.transform =
+                           [data](ArrowArray batch) {
+                             return FilterBatch(*data, std::move(batch));
+                           },
+                       .executor = std::move(executor)});
+    } else {
+      steps.push_back({.read = [data]() { return ReadNextBatch(*data); },
+                       .executor = io_executor != nullptr ? std::move(io_executor)
+                                                          : std::move(executor)});
+    }
+    private_data->pipeline = std::make_unique<BatchPipeline>(
+        static_cast<size_t>(prefetch_batches), std::move(steps));
+  }
 
   ArrowArrayStream stream{.get_schema = GetSchema,
                           .get_next = GetNext,
@@ -133,166 +568,2630 @@ Result<ArrowArrayStream> MakeArrowArrayStream(std::unique_ptr<Reader> reader) {
   return stream;
 }
 
-}  // namespace
+/// \brief The evaluators of the partition specs of the manifests of a scan.
+///
+/// Specs are resolved on the planning thread, from the cache of the context when it has
+/// one, after which the planning workers only read them.
+class ScanSpecs {
+ public:
+  explicit ScanSpecs(const TableScanContext& context)
+      : context_(context),
+        cache_(context.spec_evaluator_cache != nullptr
+                   ? context.spec_evaluator_cache
+                   : std::make_shared<SpecEvaluatorCache>()) {}
 
-// implement FileScanTask
-FileScanTask::FileScanTask(std::shared_ptr<DataFile> data_file)
-    : data_file_(std::move(data_file)) {}
+  /// \brief Returns the evaluators of a spec, resolving them on first use.
+  Result<const SpecEvaluators*> Resolve(int32_t spec_id) {
+    auto& evaluators = specs_[spec_id];
+    if (evaluators == nullptr) {
+      ICEBERG_ASSIGN_OR_RAISE(auto spec,
+                              context_.table_metadata->PartitionSpecById(spec_id));
+      ICEBERG_ASSIGN_OR_RAISE(
+          evaluators, cache_->Get(spec, context_.filter, context_.case_sensitive));
+    }
+    return evaluators.get();
+  }
 
-const std::shared_ptr<DataFile>& FileScanTask::data_file() const { return data_file_; }
+  /// \brief Returns the evaluators of a resolved spec.
+  const SpecEvaluators& At(int32_t spec_id) const { return *specs_.at(spec_id); }
 
-int64_t FileScanTask::size_bytes() const { return data_file_->file_size_in_bytes; }
+ private:
+  const TableScanContext& context_;
+  std::shared_ptr<SpecEvaluatorCache> cache_;
+  std::unordered_map<int32_t, std::shared_ptr<const SpecEvaluators>> specs_;
+};
 
-int32_t FileScanTask::files_count() const { return 1; }
+/// \brief Drop the manifests whose partition summaries show that no file can match the
+/// scan filter, resolving the specs of the others.
+Result<std::vector<ManifestFile>> FilterManifests(
+    std::vector<ManifestFile> manifest_files, ScanSpecs& specs) {
+  std::vector<ManifestFile> matching_files;
+  matching_files.reserve(manifest_files.size());
+  for (auto& manifest_file : manifest_files) {
+    ICEBERG_ASSIGN_OR_RAISE(const auto* evaluators,
+                            specs.Resolve(manifest_file.partition_spec_id));
+    if (evaluators->manifest_evaluator != nullptr) {
+      ICEBERG_ASSIGN_OR_RAISE(auto might_match,
+                              evaluators->manifest_evaluator->Evaluate(manifest_file));
+      if (!might_match) {
+        continue;
+      }
+    }
+    matching_files.push_back(std::move(manifest_file));
+  }
+  return matching_files;
+}
 
-int64_t FileScanTask::estimated_row_count() const { return data_file_->record_count; }
+/// \brief Returns the number of data manifests among manifests of any content.
+int64_t CountDataManifests(const std::vector<ManifestFile>& manifest_files) {
+  return std::ranges::count(manifest_files, ManifestFile::Content::kData,
+                            &ManifestFile::content);
+}
 
-Result<ArrowArrayStream> FileScanTask::ToArrow(
-    const std::shared_ptr<FileIO>& io, const std::shared_ptr<Schema>& projected_schema,
-    const std::shared_ptr<Expression>& filter) const {
-  const ReaderOptions options{.path = data_file_->file_path,
-                              .length = data_file_->file_size_in_bytes,
-                              .io = io,
-                              .projection = projected_schema,
-                              .filter = filter};
+/// \brief Records the explanation of a scan while it is planned.
+///
+/// Manifests are registered before planning reads them, and the counts of a manifest
+/// are recorded by the thread that planned it. Residuals are added from any thread.
+class ExplainCollector {
+ public:
+  explicit ExplainCollector(ScanExplain& explain)
+      : explain_(explain), stage_start_(std::chrono::steady_clock::now()) {}
 
-  ICEBERG_ASSIGN_OR_RAISE(auto reader,
-                          ReaderFactoryRegistry::Open(data_file_->file_format, options));
+  /// \brief Registers the manifests of the snapshot, skipped until they are planned.
+  void AddManifests(const std::vector<ManifestFile>& manifest_files) {
+    explain_.manifests.reserve(manifest_files.size());
+    for (const auto& manifest_file : manifest_files) {
+      manifest_index_.emplace(manifest_file.manifest_path, explain_.manifests.size());
+      explain_.manifests.push_back(ManifestExplain{
+          .manifest_path = manifest_file.manifest_path,
+          .content = manifest_file.content,
+          .partition_spec_id = manifest_file.partition_spec_id,
+          .outcome = ManifestOutcome::kSkippedByPartitionSummaries,
+      });
+    }
+  }
 
-  return MakeArrowArrayStream(std::move(reader));
-}
+  /// \brief Records the file counts of a planned manifest.
+  void RecordManifest(const ManifestFile& manifest_file, const ManifestExplain& counts) {
+    auto& manifest = explain_.manifests[manifest_index_.at(manifest_file.manifest_path)];
+    manifest.outcome = ManifestOutcome::kScanned;
+    manifest.live_files = counts.live_files;
+    manifest.files_skipped_by_partition = counts.files_skipped_by_partition;
+    manifest.files_skipped_by_metrics = counts.files_skipped_by_metrics;
+    manifest.result_files = counts.result_files;
+    manifest.matched_delete_files = counts.matched_delete_files;
+  }
 
-TableScanBuilder::TableScanBuilder(std::shared_ptr<TableMetadata> table_metadata,
-                                   std::shared_ptr<FileIO> file_io)
-    : file_io_(std::move(file_io)) {
-  context_.table_metadata = std::move(table_metadata);
-}
+  /// \brief Counts a planned data file in the residual of its partition.
+  void AddResidual(int32_t spec_id, const std::vector<Literal>& partition,
+                   const std::shared_ptr<Expression>& residual) {
+    std::string key = std::to_string(spec_id);
+    for (const auto& value : partition) {
+      key.push_back(value.IsNull() ? '\0' : '\1');
+      key.append(value.IsNull() ? "" : value.ToString());
+    }
+    std::lock_guard lock(mutex_);
+    auto [it, inserted] = residual_index_.try_emplace(std::move(key),
+                                                      explain_.residuals.size());
+    if (inserted) {
+      explain_.residuals.push_back(PartitionResidual{
+          .partition_spec_id = spec_id, .partition = partition, .residual = residual});
+    }
+    ++explain_.residuals[it->second].data_files;
+  }
 
-TableScanBuilder& TableScanBuilder::WithColumnNames(
-    std::vector<std::string> column_names) {
-  column_names_ = std::move(column_names);
-  return *this;
-}
+  /// \brief Ends the current stage of planning and starts the next one.
+  void EndStage(std::chrono::nanoseconds ScanStageDurations::* stage) {
+    const auto now = std::chrono::steady_clock::now();
+    explain_.durations.*stage = now - stage_start_;
+    stage_start_ = now;
+  }
 
-TableScanBuilder& TableScanBuilder::WithProjectedSchema(std::shared_ptr<Schema> schema) {
-  context_.projected_schema = std::move(schema);
-  return *this;
-}
+  /// \brief Sums the counts of the data manifests.
+  void Finish() {
+    for (const auto& manifest : explain_.manifests) {
+      if (manifest.content == ManifestFile::Content::kData) {
+        explain_.data_files_skipped_by_partition += manifest.files_skipped_by_partition;
+        explain_.data_files_skipped_by_metrics += manifest.files_skipped_by_metrics;
+      }
+    }
+  }
 
-TableScanBuilder& TableScanBuilder::WithSnapshotId(int64_t snapshot_id) {
-  snapshot_id_ = snapshot_id;
-  return *this;
+ private:
+  ScanExplain& explain_;
+  std::unordered_map<std::string, size_t> manifest_index_;
+  std::chrono::steady_clock::time_point stage_start_;
+  std::mutex mutex_;
+  std::unordered_map<std::string, size_t> residual_index_;
+};
+
+/// \brief Collects the live delete files of the delete manifests.
+///
+/// Delete files only apply to data files of their own partition, or to all data files
+/// when their spec is unpartitioned, so the delete files of a partition whose residual
+/// is false are dropped when a residual evaluator is given.
+Status CollectDeleteFiles(const ManifestFile& manifest_file,
+                          const std::shared_ptr<FileIO>& file_io,
+                          const std::shared_ptr<Schema>& partition_schema,
+                          const ResidualEvaluator* residual_evaluator,
+                          ScanMetrics& metrics, ExplainCollector* explain,
+                          std::vector<ManifestEntry>& delete_entries) {
+  // Deleted entries are skipped while decoding, unless the cache holds the manifest.
+  ManifestReadOptions read_options;
+  if (ManifestCache::Global() == nullptr) {
+    read_options.statuses = {ManifestStatus::kAdded, ManifestStatus::kExisting};
+  }
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto manifest_reader,
+      ManifestReader::Make(manifest_file, file_io, partition_schema, read_options));
+  ICEBERG_ASSIGN_OR_RAISE(auto manifests, manifest_reader->Entries());
+  metrics.scanned_delete_manifests.Increment();
+  ManifestExplain counts;
+  for (auto& manifest_entry : manifests) {
+    if (manifest_entry.status == ManifestStatus::kDeleted) {
+      continue;
+    }
+    ++counts.live_files;
+    const auto& delete_file = manifest_entry.data_file;
+    if (delete_file->content == DataFile::Content::kData) {
+      return InvalidManifest("Data file {} found in delete manifest {}",
+                             delete_file->file_path, manifest_file.manifest_path);
+    }
+    if (residual_evaluator != nullptr) {
+      ICEBERG_ASSIGN_OR_RAISE(auto residual,
+                              residual_evaluator->ResidualFor(delete_file->partition));
+      if (residual->op() == Expression::Operation::kFalse) {
+        metrics.skipped_delete_files.Increment();
+        ++counts.files_skipped_by_partition;
+        continue;
+      }
+    }
+    ++counts.result_files;
+    delete_entries.push_back(std::move(manifest_entry));
+  }
+  if (explain != nullptr) {
+    explain->RecordManifest(manifest_file, counts);
+  }
+  return {};
 }
 
-TableScanBuilder& TableScanBuilder::WithFilter(std::shared_ptr<Expression> filter) {
-  context_.filter = std::move(filter);
-  return *this;
+/// \brief Returns the data file of a planned task, copied without its column metrics
+/// unless they are kept. The file read from the manifest may be shared with the
+/// manifest cache, so it is not modified.
+std::shared_ptr<DataFile> TaskDataFile(const std::shared_ptr<DataFile>& data_file,
+                                       bool include_column_stats) {
+  if (include_column_stats) {
+    return data_file;
+  }
+  return std::make_shared<DataFile>(data_file->CopyWithoutStats());
 }
 
-TableScanBuilder& TableScanBuilder::WithCaseSensitive(bool case_sensitive) {
-  context_.case_sensitive = case_sensitive;
-  return *this;
+/// \brief Returns the bytes of a data file in the given columns, or std::nullopt if the
+/// columns are not given or the file has no size for any of them.
+std::optional<int64_t> ProjectedFileSize(const DataFile& data_file,
+                                         const std::unordered_set<int32_t>* field_ids) {
+  if (field_ids == nullptr) {
+    return std::nullopt;
+  }
+  std::optional<int64_t> projected_size;
+  for (const auto& [field_id, size] : data_file.column_sizes) {
+    if (field_ids->contains(field_id)) {
+      projected_size = projected_size.value_or(0) + size;
+    }
+  }
+  return projected_size;
 }
 
-TableScanBuilder& TableScanBuilder::WithOption(std::string property, std::string value) {
-  context_.options[std::move(property)] = std::move(value);
-  return *this;
+/// \brief Returns the task reading the sampled row groups of its data file when the
+/// scan samples row groups and the file is a Parquet file, the task otherwise.
+std::shared_ptr<FileScanTask> SampleRowGroups(std::shared_ptr<FileScanTask> task,
+                                              const ScanSample* sample) {
+  if (sample == nullptr || sample->granularity != SampleGranularity::kRowGroup ||
+      task->data_file()->file_format != FileFormatType::kParquet) {
+    return task;
+  }
+  return task->SampleRowGroups({.fraction = sample->fraction, .seed = sample->seed});
 }
 
-TableScanBuilder& TableScanBuilder::WithLimit(std::optional<int64_t> limit) {
-  context_.limit = limit;
-  return *this;
+/// \brief Returns the options to read the data manifests of a scan with.
+///
+/// The metrics maps are most of the bytes of the manifests of wide tables. The column
+/// sizes are skipped while decoding the manifests unless the column stats are kept, and
+/// so are the other maps when neither the filter nor the matching of delete files uses
+/// them. The column sizes are also read when they weigh the tasks. Only the entries
+/// with the given statuses are parsed. A manifest cache only holds complete entries, so
+/// every column and entry is read when one is installed.
+ManifestReadOptions DataManifestReadOptions(const TableScanContext& context,
+                                            bool match_deletes, bool read_column_sizes,
+                                            std::vector<ManifestStatus> statuses) {
+  if (ManifestCache::Global() != nullptr) {
+    return {};
+  }
+  if (context.include_column_stats) {
+    return {.statuses = std::move(statuses)};
+  }
+  std::unordered_set<std::string_view> skipped;
+  if (!read_column_sizes) {
+    skipped.insert(DataFile::kColumnSizes.name());
+  }
+  if (context.filter == nullptr && !match_deletes) {
+    skipped.insert({DataFile::kValueCounts.name(), DataFile::kNullValueCounts.name(),
+                    DataFile::kNanValueCounts.name(), DataFile::kLowerBounds.name(),
+                    DataFile::kUpperBounds.name()});
+  }
+  ManifestReadOptions options{.statuses = std::move(statuses)};
+  for (const auto& field : DataFile::Type(nullptr)->fields()) {
+    if (field.optional() && !skipped.contains(field.name())) {
+      options.columns.emplace_back(field.name());
+    }
+  }
+  return options;
 }
 
-Result<std::unique_ptr<TableScan>> TableScanBuilder::Build() {
-  const auto& table_metadata = context_.table_metadata;
-  auto snapshot_id = snapshot_id_ ? snapshot_id_ : table_metadata->current_snapshot_id;
-  if (!snapshot_id) {
-    return InvalidArgument("No snapshot ID specified for table {}",
-                           table_metadata->table_uuid);
+/// \brief Plan the data file scan tasks of a single manifest.
+///
+/// Data files whose column metrics show that they cannot contain rows matching the
+/// scan filter are dropped when a metrics evaluator is given, data files whose bounds on
+/// the sort column are outside the range of the filter when a sorted bounds index is
+/// given, data files whose bloom filter rules out the keys of the filter when an index
+/// evaluator is given, and data files whose partition cannot match it when a residual
+/// evaluator is given. The tasks of
+/// data files with deletes load them with the shared delete loader. Tasks are weighed by
+/// the sizes of the projected columns when their field IDs are given, and data files or
+/// their row groups are sampled when a sample is given.
+Result<std::vector<std::shared_ptr<FileScanTask>>> PlanManifestTasks(
+    const ManifestFile& manifest_file, const std::shared_ptr<FileIO>& file_io,
+    const std::shared_ptr<Schema>& partition_schema,
+    const ManifestReadOptions& read_options,
+    const InclusiveMetricsEvaluator* metrics_evaluator,
+    const SortedBoundsIndex* sorted_bounds_index,
+    const BloomFilterIndexEvaluator* index_evaluator, bool include_column_stats,
+    const std::unordered_set<int32_t>* projected_field_ids, const ScanSample* sample,
+    const ResidualEvaluator* residual_evaluator, const DeleteFileIndex& delete_index,
+    const std::shared_ptr<DeleteLoader>& delete_loader,
+    const std::shared_ptr<MemoryPool>& memory_pool,
+    const std::shared_ptr<Executor>& executor,
+    const std::shared_ptr<Executor>& io_executor, ScanMetrics& metrics,
+    ExplainCollector* explain) {
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto manifest_reader,
+      ManifestReader::Make(manifest_file, file_io, partition_schema, read_options));
+  ICEBERG_ASSIGN_OR_RAISE(auto manifests, manifest_reader->Entries());
+  metrics.scanned_data_manifests.Increment();
+  // The files ruled out by the sorted bounds are found by binary search and skip the
+  // evaluation of the whole filter on their metrics.
+  std::vector<bool> ruled_out;
+  if (sorted_bounds_index != nullptr) {
+    ICEBERG_ASSIGN_OR_RAISE(ruled_out, sorted_bounds_index->RuledOut(manifests));
   }
-  ICEBERG_ASSIGN_OR_RAISE(context_.snapshot, table_metadata->SnapshotById(*snapshot_id));
 
-  if (!context_.projected_schema) {
-    const auto& snapshot = context_.snapshot;
-    auto schema_id =
-        snapshot->schema_id ? snapshot->schema_id : table_metadata->current_schema_id;
-    ICEBERG_ASSIGN_OR_RAISE(auto schema, table_metadata->SchemaById(schema_id));
+  ManifestExplain counts;
+  std::vector<std::shared_ptr<FileScanTask>> tasks;
+  tasks.reserve(manifests.size());
+  for (size_t i = 0; i < manifests.size(); ++i) {
+    auto& manifest_entry = manifests[i];
+    if (manifest_entry.status == ManifestStatus::kDeleted) {
+      continue;
+    }
+    ++counts.live_files;
+    const auto& data_file = manifest_entry.data_file;
+    if (data_file->content != DataFile::Content::kData) {
+      return InvalidManifest("Delete file {} found in data manifest {}",
+                             data_file->file_path, manifest_file.manifest_path);
+    }
+    if (sample != nullptr && !sample->ContainsFile(data_file->file_path)) {
+      metrics.skipped_data_files.Increment();
+      continue;
+    }
+    if (!ruled_out.empty() && ruled_out[i]) {
+      metrics.skipped_data_files.Increment();
+      ++counts.files_skipped_by_metrics;
+      continue;
+    }
+    if (metrics_evaluator != nullptr) {
+      ICEBERG_ASSIGN_OR_RAISE(auto might_match, metrics_evaluator->Evaluate(*data_file));
+      if (!might_match) {
+        metrics.skipped_data_files.Increment();
+        ++counts.files_skipped_by_metrics;
+        continue;
+      }
+    }
+    if (index_evaluator != nullptr) {
+      ICEBERG_ASSIGN_OR_RAISE(auto might_match, index_evaluator->Evaluate(*data_file));
+      if (!might_match) {
+        metrics.skipped_data_files.Increment();
+        ++counts.files_skipped_by_metrics;
+        continue;
+      }
+    }
+    std::shared_ptr<Expression> residual;
+    if (residual_evaluator != nullptr) {
+      ICEBERG_ASSIGN_OR_RAISE(residual,
+                              residual_evaluator->ResidualFor(data_file->partition));
+      if (residual->op() == Expression::Operation::kFalse) {
+        metrics.skipped_data_files.Increment();
+        ++counts.files_skipped_by_partition;
+        continue;
+      }
+    }
+    std::vector<std::shared_ptr<DataFile>> deletes;
+    if (!delete_index.IsEmpty()) {
+      ICEBERG_ASSIGN_OR_RAISE(
+          deletes, delete_index.ForDataFile(*data_file,
+                                            manifest_entry.sequence_number.value_or(0)));
+    }
+    metrics.result_data_files.Increment();
+    metrics.total_file_size_in_bytes.Increment(data_file->file_size_in_bytes);
+    metrics.result_delete_files.Increment(static_cast<int64_t>(deletes.size()));
+    for (const auto& delete_file : deletes) {
+      metrics.total_delete_file_size_in_bytes.Increment(delete_file->file_size_in_bytes);
+    }
+    ++counts.result_files;
+    counts.matched_delete_files += static_cast<int64_t>(deletes.size());
+    if (explain != nullptr && residual != nullptr) {
+      explain->AddResidual(manifest_file.partition_spec_id, data_file->partition,
+                           residual);
+    }
+    tasks.emplace_back(SampleRowGroups(
+        std::make_shared<FileScanTask>(
+            TaskDataFile(data_file, include_column_stats), std::move(deletes),
+            delete_loader, std::move(residual), memory_pool, executor, io_executor,
+            ProjectedFileSize(*data_file, projected_field_ids)),
+        sample));
+  }
+  if (explain != nullptr) {
+    explain->RecordManifest(manifest_file, counts);
+  }
+  return tasks;
+}
 
-    if (column_names_.empty()) {
-      context_.projected_schema = schema;
-    } else {
-      // TODO(gty404): collect touched columns from filter expression
-      std::vector<SchemaField> projected_fields;
-      projected_fields.reserve(column_names_.size());
-      for (const auto& column_name : column_names_) {
-        // TODO(gty404): support case-insensitive column names
-        auto field_opt = schema->GetFieldByName(column_name);
-        if (!field_opt) {
-          return InvalidArgument("Column {} not found in schema '{}'", column_name,
-                                 *schema_id);
-        }
-        projected_fields.emplace_back(field_opt.value()->get());
+/// \brief Returns the snapshots after `from_snapshot_id` in the lineage of `snapshot`,
+/// from the oldest to the newest.
+///
+/// All snapshots of the lineage that have not expired are returned when
+/// `from_snapshot_id` is unset. Fails when `from_snapshot_id` is not an ancestor of
+/// `snapshot`.
+Result<std::vector<std::shared_ptr<Snapshot>>> SnapshotsAfter(
+    const TableMetadata& table_metadata, std::optional<int64_t> from_snapshot_id,
+    std::shared_ptr<Snapshot> snapshot) {
+  std::vector<std::shared_ptr<Snapshot>> snapshots;
+  const auto to_snapshot_id = snapshot->snapshot_id;
+  while (snapshot->snapshot_id != from_snapshot_id) {
+    auto parent_snapshot_id = snapshot->parent_snapshot_id;
+    snapshots.push_back(std::move(snapshot));
+    if (parent_snapshot_id.has_value()) {
+      if (auto parent = table_metadata.SnapshotById(*parent_snapshot_id)) {
+        snapshot = std::move(parent.value());
+        continue;
       }
-      context_.projected_schema =
-          std::make_shared<Schema>(std::move(projected_fields), schema->schema_id());
     }
-  } else if (!column_names_.empty()) {
-    return InvalidArgument(
-        "Cannot specify column names when a projected schema is provided");
+    // The start of the lineage was reached, or the rest of it has expired.
+    if (from_snapshot_id.has_value()) {
+      return InvalidArgument("Snapshot {} is not an ancestor of snapshot {}",
+                             *from_snapshot_id, to_snapshot_id);
+    }
+    break;
   }
+  std::ranges::reverse(snapshots);
+  return snapshots;
+}
 
-  return std::make_unique<DataTableScan>(std::move(context_), file_io_);
+/// \brief Plan the scan tasks of the data files of a manifest that were added by one of
+/// the given snapshots.
+///
+/// Entries existing in the manifest, e.g. because the appending snapshot merged it with
+/// older manifests, are skipped. Tasks are weighed by the sizes of the projected columns
+/// when their field IDs are given, and data files or their row groups are sampled when
+/// a sample is given.
+Result<std::vector<std::shared_ptr<FileScanTask>>> PlanAppendedTasks(
+    const ManifestFile& manifest_file, const std::shared_ptr<FileIO>& file_io,
+    const std::shared_ptr<Schema>& partition_schema,
+    const ManifestReadOptions& read_options,
+    const InclusiveMetricsEvaluator* metrics_evaluator, bool include_column_stats,
+    const std::unordered_set<int32_t>* projected_field_ids, const ScanSample* sample,
+    const std::unordered_set<int64_t>& snapshot_ids,
+    const std::shared_ptr<MemoryPool>& memory_pool,
+    const std::shared_ptr<Executor>& executor,
+    const std::shared_ptr<Executor>& io_executor) {
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto manifest_reader,
+      ManifestReader::Make(manifest_file, file_io, partition_schema, read_options));
+  ICEBERG_ASSIGN_OR_RAISE(auto manifests, manifest_reader->Entries());
+
+  std::vector<std::shared_ptr<FileScanTask>> tasks;
+  for (auto& manifest_entry : manifests) {
+    if (manifest_entry.status != ManifestStatus::kAdded ||
+        !manifest_entry.snapshot_id.has_value() ||
+        !snapshot_ids.contains(*manifest_entry.snapshot_id)) {
+      continue;
+    }
+    const auto& data_file = manifest_entry.data_file;
+    if (data_file->content != DataFile::Content::kData) {
+      return InvalidManifest("Delete file {} found in data manifest {}",
+                             data_file->file_path, manifest_file.manifest_path);
+    }
+    if (sample != nullptr && !sample->ContainsFile(data_file->file_path)) {
+      continue;
+    }
+    if (metrics_evaluator != nullptr) {
+      ICEBERG_ASSIGN_OR_RAISE(auto might_match, metrics_evaluator->Evaluate(*data_file));
+      if (!might_match) {
+        continue;
+      }
+    }
+    tasks.emplace_back(SampleRowGroups(
+        std::make_shared<FileScanTask>(
+            TaskDataFile(data_file, include_column_stats),
+            std::vector<std::shared_ptr<DataFile>>{}, /*delete_loader=*/nullptr,
+            /*residual=*/nullptr, memory_pool, executor, io_executor,
+            ProjectedFileSize(*data_file, projected_field_ids)),
+        sample));
+  }
+  return tasks;
 }
 
-TableScan::TableScan(TableScanContext context, std::shared_ptr<FileIO> file_io)
-    : context_(std::move(context)), file_io_(std::move(file_io)) {}
+/// \brief A data manifest written by a snapshot with changes of a changelog scan.
+struct ChangelogManifest {
+  ManifestFile manifest_file;
+  int32_t change_ordinal;
+  int64_t commit_snapshot_id;
+};
 
-const std::shared_ptr<Snapshot>& TableScan::snapshot() const { return context_.snapshot; }
+/// \brief Plan the changelog tasks of the data files that the snapshot of a manifest
+/// added or removed.
+Result<std::vector<std::shared_ptr<ChangelogScanTask>>> PlanChangelogTasks(
+    const ChangelogManifest& manifest, const std::shared_ptr<FileIO>& file_io,
+    const std::shared_ptr<Schema>& partition_schema,
+    const ManifestReadOptions& read_options,
+    const InclusiveMetricsEvaluator* metrics_evaluator, bool include_column_stats) {
+  const auto& manifest_file = manifest.manifest_file;
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto manifest_reader,
+      ManifestReader::Make(manifest_file, file_io, partition_schema, read_options));
+  ICEBERG_ASSIGN_OR_RAISE(auto manifests, manifest_reader->Entries());
 
-const std::shared_ptr<Schema>& TableScan::projection() const {
-  return context_.projected_schema;
+  std::vector<std::shared_ptr<ChangelogScanTask>> tasks;
+  for (auto& manifest_entry : manifests) {
+    if (manifest_entry.status == ManifestStatus::kExisting ||
+        manifest_entry.snapshot_id != manifest.commit_snapshot_id) {
+      continue;
+    }
+    const auto& data_file = manifest_entry.data_file;
+    if (data_file->content != DataFile::Content::kData) {
+      return InvalidManifest("Delete file {} found in data manifest {}",
+                             data_file->file_path, manifest_file.manifest_path);
+    }
+    if (metrics_evaluator != nullptr) {
+      ICEBERG_ASSIGN_OR_RAISE(auto might_match, metrics_evaluator->Evaluate(*data_file));
+      if (!might_match) {
+        continue;
+      }
+    }
+    auto operation = manifest_entry.status == ManifestStatus::kAdded
+                         ? ChangelogOperation::kInsert
+                         : ChangelogOperation::kDelete;
+    tasks.emplace_back(std::make_shared<ChangelogScanTask>(
+        TaskDataFile(data_file, include_column_stats), operation,
+        manifest.change_ordinal, manifest.commit_snapshot_id));
+  }
+  return tasks;
 }
 
-const TableScanContext& TableScan::context() const { return context_; }
-
-const std::shared_ptr<FileIO>& TableScan::io() const { return file_io_; }
+/// \brief Returns the projected schema extended with the equality fields that it lacks,
+/// which are appended as top-level columns.
+Result<std::shared_ptr<Schema>> WithEqualityFields(
+    const std::shared_ptr<Schema>& projected_schema, const Schema& table_schema,
+    const std::vector<std::shared_ptr<const EqualityDeleteSet>>& equality_deletes) {
+  std::unordered_set<int32_t> missing_ids;
+  for (const auto& deletes : equality_deletes) {
+    for (int32_t field_id : deletes->equality_field_ids()) {
+      ICEBERG_ASSIGN_OR_RAISE(auto field, projected_schema->FindFieldById(field_id));
+      if (!field.has_value()) {
+        missing_ids.insert(field_id);
+      }
+    }
+  }
+  if (missing_ids.empty()) {
+    return projected_schema;
+  }
 
-DataTableScan::DataTableScan(TableScanContext context, std::shared_ptr<FileIO> file_io)
-    : TableScan(std::move(context), std::move(file_io)) {}
+  ICEBERG_ASSIGN_OR_RAISE(auto missing_fields, table_schema.Project(missing_ids));
+  auto projected_fields = projected_schema->fields();
+  std::vector<SchemaField> fields(projected_fields.begin(), projected_fields.end());
+  for (const auto& field : missing_fields->fields()) {
+    ICEBERG_ASSIGN_OR_RAISE(auto projected_field,
+                            projected_schema->FindFieldById(field.field_id()));
+    if (projected_field.has_value()) {
+      return NotSupported(
+          "Cannot apply equality deletes on fields of {} that are not projected",
+          field.name());
+    }
+    fields.push_back(field);
+  }
+  return std::make_shared<Schema>(std::move(fields), projected_schema->schema_id());
+}
 
-Result<std::vector<std::shared_ptr<FileScanTask>>> DataTableScan::PlanFiles() const {
-  ICEBERG_ASSIGN_OR_RAISE(
-      auto manifest_list_reader,
-      ManifestListReader::Make(context_.snapshot->manifest_list, file_io_));
-  ICEBERG_ASSIGN_OR_RAISE(auto manifest_files, manifest_list_reader->Files());
+/// \brief Reads a positive integer scan setting from the scan options, falling back to
+/// the table properties and then to the default value.
+template <typename T>
+Result<T> PositiveScanProperty(const TableScanContext& context,
+                               const TableProperties::Entry<T>& entry) {
+  const std::string* value = nullptr;
+  if (auto it = context.options.find(entry.key()); it != context.options.cend()) {
+    value = &it->second;
+  } else if (auto it = context.table_metadata->properties.find(entry.key());
+             it != context.table_metadata->properties.cend()) {
+    value = &it->second;
+  }
+  if (value == nullptr) {
+    return entry.value();
+  }
 
-  std::vector<std::shared_ptr<FileScanTask>> tasks;
-  ICEBERG_ASSIGN_OR_RAISE(auto partition_spec, context_.table_metadata->PartitionSpec());
-  auto partition_schema = partition_spec->schema();
+  T parsed{};
+  const char* end = value->data() + value->size();
+  auto [ptr, ec] = std::from_chars(value->data(), end, parsed);
+  if (ec != std::errc{} || ptr != end || parsed <= 0) {
+    return InvalidArgument("Invalid value '{}' for {}, expected a positive integer",
+                           *value, entry.key());
+  }
+  return parsed;
+}
 
-  for (const auto& manifest_file : manifest_files) {
-    ICEBERG_ASSIGN_OR_RAISE(
-        auto manifest_reader,
-        ManifestReader::Make(manifest_file, file_io_, partition_schema));
-    ICEBERG_ASSIGN_OR_RAISE(auto manifests, manifest_reader->Entries());
+/// \brief Reads a boolean scan setting from the scan options, falling back to the table
+/// properties and then to the default value.
+bool ScanFlag(const TableScanContext& context,
+              const TableProperties::Entry<bool>& entry) {
+  if (auto it = context.options.find(entry.key()); it != context.options.cend()) {
+    return it->second == "true";
+  }
+  if (auto it = context.table_metadata->properties.find(entry.key());
+      it != context.table_metadata->properties.cend()) {
+    return it->second == "true";
+  }
+  return entry.value();
+}
 
-    // TODO(gty404): filter manifests using partition spec and filter expression
+/// \brief Collects the IDs of the fields of a type and of their nested fields.
+void CollectFieldIds(const Type& type, std::unordered_set<int32_t>& field_ids) {
+  if (!type.is_nested()) {
+    return;
+  }
+  for (const auto& field : internal::checked_cast<const NestedType&>(type).fields()) {
+    field_ids.insert(field.field_id());
+    CollectFieldIds(*field.type(), field_ids);
+  }
+}
 
-    for (auto& manifest_entry : manifests) {
-      const auto& data_file = manifest_entry.data_file;
-      switch (data_file->content) {
-        case DataFile::Content::kData:
-          tasks.emplace_back(std::make_shared<FileScanTask>(manifest_entry.data_file));
-          break;
-        case DataFile::Content::kPositionDeletes:
-        case DataFile::Content::kEqualityDeletes:
-          return NotSupported("Equality/Position deletes are not supported in data scan");
-      }
-    }
+/// \brief Returns the IDs of the columns that the tasks of a scan read, whose sizes
+/// weigh the tasks, or std::nullopt if the tasks are weighed by their file size.
+///
+/// The tasks read the projected columns and the columns referenced by the filter, which
+/// a projected schema set by the caller may not include.
+Result<std::optional<std::unordered_set<int32_t>>> ProjectedFieldIds(
+    const TableScanContext& context, const Schema& schema) {
+  if (!ScanFlag(context, TableProperties::kSplitProjectedSizeEnabled)) {
+    return std::nullopt;
+  }
+  std::unordered_set<int32_t> field_ids;
+  CollectFieldIds(*context.projected_schema, field_ids);
+  if (context.filter != nullptr) {
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto filter_ids,
+        Binder::BoundReferences(schema, context.filter, context.case_sensitive));
+    field_ids.insert(filter_ids.begin(), filter_ids.end());
   }
+  return field_ids;
+}
 
+/// \brief Returns the key of the plan of a data table scan in a plan cache.
+///
+/// The filter is bound to the table schema with its negations rewritten, so that
+/// filters naming the columns or negating predicates differently share a plan. Values
+/// of arbitrary content are prefixed with their length.
+Result<std::string> PlanCacheKey(const TableScanContext& context, const Schema& schema) {
+  std::string key = std::format(
+      "{}:{}:{}:{}", context.table_metadata->table_uuid, context.snapshot->snapshot_id,
+      context.limit.has_value() ? std::to_string(*context.limit) : "-",
+      context.include_column_stats);
+  if (const auto& sample = context.sample; sample.has_value()) {
+    std::format_to(std::back_inserter(key), ":{}:{}:{}", sample->fraction, sample->seed,
+                   static_cast<int>(sample->granularity));
+  } else {
+    key += ":-";
+  }
+  std::string filter;
+  if (context.filter != nullptr) {
+    ICEBERG_ASSIGN_OR_RAISE(auto rewritten, RewriteNot::Rewrite(context.filter));
+    ICEBERG_ASSIGN_OR_RAISE(auto bound,
+                            Binder::Bind(schema, rewritten, context.case_sensitive));
+    filter = bound->ToString();
+  }
+  std::format_to(std::back_inserter(key), ":{}:{}", filter.size(), filter);
+
+  std::unordered_set<int32_t> field_ids;
+  CollectFieldIds(*context.projected_schema, field_ids);
+  std::vector<int32_t> sorted_ids(field_ids.begin(), field_ids.end());
+  std::ranges::sort(sorted_ids);
+  key += ":";
+  for (int32_t field_id : sorted_ids) {
+    std::format_to(std::back_inserter(key), "{},", field_id);
+  }
+  const std::map<std::string_view, std::string_view> options(context.options.begin(),
+                                                             context.options.end());
+  for (const auto& [name, value] : options) {
+    std::format_to(std::back_inserter(key), ":{}:{}={}:{}", name.size(), name,
+                   value.size(), value);
+  }
+  return key;
+}
+
+/// \brief Returns whether files of the format can be read starting at any split offset.
+bool IsSplittable(FileFormatType format) {
+  switch (format) {
+    case FileFormatType::kParquet:
+    case FileFormatType::kAvro:
+    case FileFormatType::kOrc:
+      return true;
+    case FileFormatType::kPuffin:
+      return false;
+  }
+  std::unreachable();
+}
+
+/// \brief Returns whether the split offsets of a file are increasing and within the file.
+bool HasValidSplitOffsets(const DataFile& data_file) {
+  const auto& offsets = data_file.split_offsets;
+  return !offsets.empty() && offsets.front() >= 0 &&
+         offsets.back() < data_file.file_size_in_bytes &&
+         std::ranges::adjacent_find(offsets, std::greater_equal<>{}) == offsets.cend();
+}
+
+/// \brief Splits a task that reads a whole file into tasks of at most the split size.
+///
+/// The split offsets of the file are used as split boundaries when they are valid, and
+/// adjacent ranges are combined as long as they fit in the split size. Otherwise, the
+/// file is cut into ranges of the split size. A task with a projected file size reads a
+/// share of each range, so its ranges are longer in proportion.
+void SplitFileTask(const std::shared_ptr<FileScanTask>& task, int64_t split_size,
+                   std::vector<std::shared_ptr<FileScanTask>>& splits) {
+  const auto& data_file = task->data_file();
+  const int64_t file_size = data_file->file_size_in_bytes;
+  if (auto projected_size = task->projected_file_size();
+      projected_size.has_value() && *projected_size < file_size) {
+    split_size = *projected_size <= 0
+                     ? file_size
+                     : static_cast<int64_t>(std::min(
+                           static_cast<double>(split_size) * file_size / *projected_size,
+                           static_cast<double>(file_size)));
+  }
+  // Position deletes cannot be applied to a split of an Avro file, whose row positions
+  // are unknown when reading from a split offset.
+  const bool has_position_deletes =
+      std::ranges::any_of(task->delete_files(), [](const auto& delete_file) {
+        return delete_file->content == DataFile::Content::kPositionDeletes;
+      });
+  if (task->length() <= split_size || task->start() != 0 || task->length() != file_size ||
+      !IsSplittable(data_file->file_format) ||
+      (has_position_deletes && data_file->file_format == FileFormatType::kAvro)) {
+    splits.push_back(task);
+    return;
+  }
+
+  if (HasValidSplitOffsets(*data_file)) {
+    const auto& offsets = data_file->split_offsets;
+    auto range_end = [&](size_t index) {
+      return index + 1 < offsets.size() ? offsets[index + 1] : file_size;
+    };
+    size_t index = 0;
+    while (index < offsets.size()) {
+      const int64_t start = offsets[index];
+      int64_t end = range_end(index++);
+      while (index < offsets.size() && range_end(index) - start <= split_size) {
+        end = range_end(index++);
+      }
+      splits.push_back(task->Slice(start, end - start));
+    }
+    return;
+  }
+
+  for (int64_t start = 0; start < file_size; start += split_size) {
+    splits.push_back(task->Slice(start, std::min(split_size, file_size - start)));
+  }
+}
+
+/// \brief Bin-packs tasks into combined tasks whose weight does not exceed the split
+/// size, unless they hold a single heavier task.
+///
+/// A task weighs the bytes it reads, including its delete files, but at least the open
+/// file cost for each of its files. Each task goes to the first open bin that has room
+/// for it, or to a new bin otherwise. When more than `lookback` bins are open, the
+/// heaviest one is closed and passed to the callback, so only the open bins are held.
+class TaskPacker {
+ public:
+  using Callback = std::function<Status(std::shared_ptr<CombinedScanTask>)>;
+
+  TaskPacker(int64_t split_size, int32_t lookback, int64_t open_file_cost,
+             Callback callback)
+      : split_size_(split_size),
+        lookback_(lookback),
+        open_file_cost_(open_file_cost),
+        callback_(std::move(callback)) {}
+
+  Status Add(std::shared_ptr<FileScanTask> task) {
+    const int64_t weight =
+        std::max(task->size_bytes(), task->files_count() * open_file_cost_);
+    auto bin = std::ranges::find_if(
+        bins_, [&](const Bin& bin) { return bin.weight + weight <= split_size_; });
+    if (bin != bins_.end()) {
+      bin->tasks.push_back(std::move(task));
+      bin->weight += weight;
+      return {};
+    }
+
+    bins_.emplace_back().tasks.push_back(std::move(task));
+    bins_.back().weight = weight;
+    if (bins_.size() > static_cast<size_t>(lookback_)) {
+      return CloseHeaviestBin();
+    }
+    return {};
+  }
+
+  /// \brief Closes the remaining open bins.
+  Status Finish() {
+    while (!bins_.empty()) {
+      ICEBERG_RETURN_UNEXPECTED(CloseHeaviestBin());
+    }
+    return {};
+  }
+
+ private:
+  struct Bin {
+    std::vector<std::shared_ptr<FileScanTask>> tasks;
+    int64_t weight = 0;
+  };
+
+  Status CloseHeaviestBin() {
+    auto heaviest = std::ranges::max_element(bins_, {}, &Bin::weight);
+    auto combined_task = std::make_shared<CombinedScanTask>(std::move(heaviest->tasks));
+    bins_.erase(heaviest);
+    return callback_(std::move(combined_task));
+  }
+
+  const int64_t split_size_;
+  const int32_t lookback_;
+  const int64_t open_file_cost_;
+  Callback callback_;
+  std::vector<Bin> bins_;
+};
+
+/// \brief Bin-packs tasks into combined tasks with a TaskPacker.
+std::vector<std::shared_ptr<CombinedScanTask>> PackTasks(
+    std::vector<std::shared_ptr<FileScanTask>> tasks, int64_t split_size,
+    int32_t lookback, int64_t open_file_cost) {
+  std::vector<std::shared_ptr<CombinedScanTask>> combined_tasks;
+  TaskPacker packer(split_size, lookback, open_file_cost,
+                    [&](std::shared_ptr<CombinedScanTask> task) -> Status {
+                      combined_tasks.push_back(std::move(task));
+                      return {};
+                    });
+  for (auto& task : tasks) {
+    std::ignore = packer.Add(std::move(task));
+  }
+  std::ignore = packer.Finish();
+  return combined_tasks;
+}
+
+/// \brief Returns the executor of a scan, the default executor if it has none.
+Executor& ContextExecutor(const TableScanContext& context) {
+  return context.executor != nullptr ? *context.executor : *DefaultExecutor();
+}
+
+/// \brief Returns the manifest file to read ahead with a PrefetchingFileIO.
+PrefetchingFileIO::File PrefetchedManifest(const ManifestFile& manifest_file) {
+  return {.location = manifest_file.manifest_path,
+          .length = manifest_file.manifest_length > 0
+                        ? std::optional<size_t>(manifest_file.manifest_length)
+                        : std::nullopt};
+}
+
+/// \brief Returns the FileIO reading the manifests of a scan.
+///
+/// With an I/O executor, the manifests are read ahead on it in the order they are
+/// planned, up to the planning parallelism of the scan or the bytes of its manifest
+/// readahead, while the manifests already read are decoded on the executor of the scan.
+Result<std::shared_ptr<FileIO>> ManifestFileIO(
+    const TableScanContext& context, const std::shared_ptr<FileIO>& file_io,
+    std::vector<PrefetchingFileIO::File> manifests) {
+  if (context.io_executor == nullptr || manifests.empty()) {
+    return file_io;
+  }
+  auto capacity = static_cast<size_t>(std::max(context.planning_parallelism, 1));
+  auto capacity_bytes = static_cast<size_t>(context.manifest_readahead_bytes);
+  if (capacity_bytes > 0) {
+    capacity = std::max(capacity, manifests.size());
+  }
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto prefetching_io,
+      PrefetchingFileIO::Make(file_io, std::move(manifests), capacity,
+                              context.io_executor, capacity_bytes));
+  return prefetching_io;
+}
+
+/// \brief Plans the tasks of manifests on up to `parallelism` threads and passes them
+/// to a callback in the order of the manifests.
+///
+/// \param executor Runs the helpers planning manifests ahead of the calling thread
+/// \param manifests The manifests to plan, of any type accepted by `plan_manifest`
+/// \param plan_manifest Returns the tasks of a manifest, called concurrently
+/// \param callback Receives each task on the calling thread, its errors stop planning
+template <typename Manifest, typename PlanManifest, typename Callback>
+Status PlanManifestsInOrder(Executor& executor, const std::vector<Manifest>& manifests,
+                            int32_t parallelism, const PlanManifest& plan_manifest,
+                            const Callback& callback) {
+  using Tasks = std::invoke_result_t<const PlanManifest&, const Manifest&>;
+  auto emit_tasks = [&](typename Tasks::value_type tasks) -> Status {
+    for (auto& task : tasks) {
+      ICEBERG_RETURN_UNEXPECTED(callback(std::move(task)));
+    }
+    return {};
+  };
+
+  const size_t count = manifests.size();
+  const auto num_workers = std::min<size_t>(count, static_cast<size_t>(parallelism));
+  if (num_workers <= 1) {
+    for (const auto& manifest : manifests) {
+      ICEBERG_ASSIGN_OR_RAISE(auto manifest_tasks, plan_manifest(manifest));
+      ICEBERG_RETURN_UNEXPECTED(emit_tasks(std::move(manifest_tasks)));
+    }
+    return {};
+  }
+
+  // Manifests are claimed in increasing order, and no manifest is claimed after a
+  // failure, so every manifest before the first failed one is planned and passed to
+  // the callback before the error is reported. The calling thread passes the tasks of
+  // each manifest to the callback in order, planning the next manifest itself when no
+  // helper claimed it yet, so it never waits for a helper that has not started.
+  // Helpers only claim manifests within `num_workers` of the next one to pass, which
+  // bounds the planned tasks held here, and exit instead of waiting when none can be
+  // claimed, so they never block a thread of the executor. The state is shared with
+  // helpers that may start after planning stopped.
+  struct State {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::optional<Tasks>> manifest_tasks;
+    size_t next_manifest = 0;
+    size_t next_to_emit = 0;
+    /// \brief The helpers submitted and not exited yet.
+    size_t helpers = 0;
+    /// \brief The manifests being planned by helpers.
+    size_t running = 0;
+    bool stopped = false;
+  };
+  auto state = std::make_shared<State>();
+  state->manifest_tasks.resize(count);
+
+  std::function<void()> helper = [state, count, num_workers, &manifests,
+                                  &plan_manifest]() {
+    std::unique_lock lock(state->mutex);
+    while (!state->stopped &&
+           state->next_manifest < std::min(count, state->next_to_emit + num_workers)) {
+      const size_t index = state->next_manifest++;
+      ++state->running;
+      lock.unlock();
+      auto planned = plan_manifest(manifests[index]);
+      lock.lock();
+      state->stopped |= !planned.has_value();
+      state->manifest_tasks[index] = std::move(planned);
+      --state->running;
+      state->cv.notify_all();
+    }
+    --state->helpers;
+  };
+  // Returns the number of helpers to submit for the manifests that can be claimed,
+  // called with the lock held.
+  auto reserve_helpers = [&]() -> size_t {
+    if (state->stopped) {
+      return 0;
+    }
+    const size_t claimable =
+        std::min(count, state->next_to_emit + num_workers) - state->next_manifest;
+    const size_t target = std::min(num_workers - 1, claimable);
+    const size_t reserved = target > state->helpers ? target - state->helpers : 0;
+    state->helpers += reserved;
+    return reserved;
+  };
+  auto submit_helpers = [&](size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+      executor.Submit(helper);
+    }
+  };
+
+  {
+    size_t new_helpers;
+    {
+      std::lock_guard lock(state->mutex);
+      new_helpers = reserve_helpers();
+    }
+    submit_helpers(new_helpers);
+  }
+
+  Status status;
+  for (size_t index = 0; index < count && status.has_value(); ++index) {
+    Tasks planned;
+    size_t new_helpers;
+    {
+      std::unique_lock lock(state->mutex);
+      if (state->next_manifest == index) {
+        ++state->next_manifest;
+        lock.unlock();
+        planned = plan_manifest(manifests[index]);
+        lock.lock();
+        state->stopped |= !planned.has_value();
+      } else {
+        state->cv.wait(lock, [&]() { return state->manifest_tasks[index].has_value(); });
+        planned = std::move(*state->manifest_tasks[index]);
+        state->manifest_tasks[index].reset();
+      }
+      state->next_to_emit = index + 1;
+      new_helpers = reserve_helpers();
+    }
+    submit_helpers(new_helpers);
+    if (planned.has_value()) {
+      status = emit_tasks(std::move(planned.value()));
+    } else {
+      status = std::unexpected(std::move(planned.error()));
+    }
+  }
+
+  std::unique_lock lock(state->mutex);
+  state->stopped = true;
+  state->cv.wait(lock, [&]() { return state->running == 0; });
+  return status;
+}
+
+/// \brief Returns whether no delete file nor residual filter applies to the rows of
+/// the data file of a task.
+bool MatchesAllRows(const FileScanTask& task) {
+  const auto& residual = task.residual();
+  return task.delete_files().empty() && !task.row_group_sample().has_value() &&
+         (residual == nullptr || residual->op() == Expression::Operation::kTrue);
+}
+
+/// \brief Plans tasks until the tasks whose rows all match the scan hold at least the
+/// limit of the scan, which stops planning without an error.
+///
+/// Only tasks without delete files and whose residual is true count toward the limit,
+/// since the rows of the other tasks may be deleted or filtered.
+/// \param plan Plans the tasks and passes them to its callback, whose errors stop it
+Status PlanWithLimit(
+    std::optional<int64_t> limit, const TableScan::FileScanTaskCallback& callback,
+    const std::function<Status(const TableScan::FileScanTaskCallback&)>& plan) {
+  if (!limit.has_value()) {
+    return plan(callback);
+  }
+  if (limit.value() <= 0) {
+    return {};
+  }
+  int64_t rows = 0;
+  bool limit_reached = false;
+  auto status = plan([&](std::shared_ptr<FileScanTask> task) -> Status {
+    if (MatchesAllRows(*task)) {
+      rows += task->data_file()->record_count;
+    }
+    ICEBERG_RETURN_UNEXPECTED(callback(std::move(task)));
+    if (rows >= limit.value()) {
+      limit_reached = true;
+      return Invalid("The limit of the scan is reached");
+    }
+    return {};
+  });
+  if (limit_reached) {
+    return {};
+  }
+  return status;
+}
+
+/// \brief Where a row falls in the order of the leading sort column: among the nulls
+/// placed first, among the values or among the nulls placed last.
+struct SortPosition {
+  enum class Tier { kNullsFirst, kValues, kNullsLast };
+
+  Tier tier;
+  /// \brief The value of the column, for the values tier.
+  std::optional<Literal> value;
+};
+
+/// \brief The positions of the first and last rows of a data file in the order of the
+/// leading sort column.
+struct SortRange {
+  SortPosition first;
+  SortPosition last;
+};
+
+/// \brief A range spanning the whole order, for files whose rows may be anywhere.
+const SortRange kUnknownSortRange = {
+    .first = {.tier = SortPosition::Tier::kNullsFirst},
+    .last = {.tier = SortPosition::Tier::kNullsLast}};
+
+/// \brief Returns whether the bounds of a column order its rows like their sort keys,
+/// which floating point bounds ignoring NaNs and signed zeros do not.
+bool BoundsOrderSortKeys(TypeId type_id) {
+  switch (type_id) {
+    case TypeId::kInt:
+    case TypeId::kLong:
+    case TypeId::kDecimal:
+    case TypeId::kDate:
+    case TypeId::kTime:
+    case TypeId::kTimestamp:
+    case TypeId::kTimestampTz:
+    case TypeId::kString:
+    case TypeId::kBinary:
+    case TypeId::kFixed:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// \brief Compares two positions in the order of a column, returning a negative value
+/// if `lhs` comes first, zero if they are equal and a positive value otherwise.
+int ComparePositions(const SortPosition& lhs, const SortPosition& rhs,
+                     bool descending) {
+  if (lhs.tier != rhs.tier) {
+    return lhs.tier < rhs.tier ? -1 : 1;
+  }
+  if (lhs.tier != SortPosition::Tier::kValues) {
+    return 0;
+  }
+  const auto order = *lhs.value <=> *rhs.value;
+  const int result = order < 0 ? -1 : (order > 0 ? 1 : 0);
+  return descending ? -result : result;
+}
+
+/// \brief Returns the range of the rows of a data file in the order of a sort field,
+/// from the metrics of its identity source column.
+Result<SortRange> FileSortRange(const DataFile& data_file, const SortField& field,
+                                const std::shared_ptr<PrimitiveType>& type) {
+  const int32_t field_id = field.source_id();
+  auto nulls = data_file.null_value_counts.find(field_id);
+  if (nulls == data_file.null_value_counts.end()) {
+    return kUnknownSortRange;
+  }
+  const SortPosition null_position = {.tier = field.null_order() == NullOrder::kFirst
+                                                  ? SortPosition::Tier::kNullsFirst
+                                                  : SortPosition::Tier::kNullsLast};
+  auto values = data_file.value_counts.find(field_id);
+  if (values != data_file.value_counts.end() && values->second == nulls->second) {
+    return SortRange{.first = null_position, .last = null_position};
+  }
+  auto lower = data_file.lower_bounds.find(field_id);
+  auto upper = data_file.upper_bounds.find(field_id);
+  if (lower == data_file.lower_bounds.end() || upper == data_file.upper_bounds.end()) {
+    return kUnknownSortRange;
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto lower_bound, Conversions::FromBytes(type, lower->second));
+  ICEBERG_ASSIGN_OR_RAISE(auto upper_bound, Conversions::FromBytes(type, upper->second));
+  const bool descending = field.direction() == SortDirection::kDescending;
+  SortRange range = {
+      .first = {.tier = SortPosition::Tier::kValues,
+                .value = descending ? std::move(upper_bound) : std::move(lower_bound)},
+      .last = {.tier = SortPosition::Tier::kValues,
+               .value = descending ? std::move(lower_bound) : std::move(upper_bound)}};
+  if (nulls->second > 0 && null_position.tier == SortPosition::Tier::kNullsFirst) {
+    range.first = null_position;
+  } else if (nulls->second > 0) {
+    range.last = null_position;
+  }
+  return range;
+}
+
+}  // namespace
+
+// implement ScanSample
+bool ScanSample::ContainsFile(std::string_view path) const {
+  if (granularity != SampleGranularity::kFile) {
+    return true;
+  }
+  uint32_t hash = 0;
+  MurmurHash3_x86_32(path.data(), static_cast<int>(path.size()), seed, &hash);
+  return static_cast<double>(hash) < fraction * 0x1p32;
+}
+
+// implement FileScanTask
+FileScanTask::FileScanTask(std::shared_ptr<DataFile> data_file)
+    : data_file_(std::move(data_file)),
+      start_(0),
+      length_(data_file_->file_size_in_bytes) {}
+
+FileScanTask::FileScanTask(std::shared_ptr<DataFile> data_file, int64_t start,
+                           int64_t length)
+    : data_file_(std::move(data_file)), start_(start), length_(length) {}
+
+FileScanTask::FileScanTask(std::shared_ptr<DataFile> data_file,
+                           std::vector<std::shared_ptr<DataFile>> delete_files,
+                           std::shared_ptr<DeleteLoader> delete_loader,
+                           std::shared_ptr<Expression> residual,
+                           std::shared_ptr<MemoryPool> memory_pool,
+                           std::shared_ptr<Executor> executor,
+                           std::shared_ptr<Executor> io_executor,
+                           std::optional<int64_t> projected_file_size)
+    : data_file_(std::move(data_file)),
+      start_(0),
+      length_(data_file_->file_size_in_bytes),
+      delete_files_(std::move(delete_files)),
+      delete_loader_(std::move(delete_loader)),
+      residual_(std::move(residual)),
+      memory_pool_(std::move(memory_pool)),
+      executor_(std::move(executor)),
+      io_executor_(std::move(io_executor)),
+      projected_file_size_(projected_file_size) {}
+
+const std::shared_ptr<DataFile>& FileScanTask::data_file() const { return data_file_; }
+
+int64_t FileScanTask::start() const { return start_; }
+
+int64_t FileScanTask::length() const { return length_; }
+
+const std::vector<std::shared_ptr<DataFile>>& FileScanTask::delete_files() const {
+  return delete_files_;
+}
+
+const std::shared_ptr<Expression>& FileScanTask::residual() const { return residual_; }
+
+const std::shared_ptr<MemoryPool>& FileScanTask::memory_pool() const {
+  return memory_pool_;
+}
+
+const std::shared_ptr<Executor>& FileScanTask::executor() const { return executor_; }
+
+const std::shared_ptr<Executor>& FileScanTask::io_executor() const {
+  return io_executor_;
+}
+
+std::optional<int64_t> FileScanTask::projected_file_size() const {
+  return projected_file_size_;
+}
+
+const std::optional<RowGroupSample>& FileScanTask::row_group_sample() const {
+  return row_group_sample_;
+}
+
+std::shared_ptr<FileScanTask> FileScanTask::Slice(int64_t start, int64_t length) const {
+  auto task = std::make_shared<FileScanTask>(*this);
+  task->start_ = start;
+  task->length_ = length;
+  return task;
+}
+
+std::shared_ptr<FileScanTask> FileScanTask::SampleRowGroups(RowGroupSample sample) const {
+  auto task = std::make_shared<FileScanTask>(*this);
+  task->row_group_sample_ = sample;
+  return task;
+}
+
+int64_t FileScanTask::size_bytes() const {
+  int64_t size_bytes = length_;
+  const int64_t file_size = data_file_->file_size_in_bytes;
+  if (projected_file_size_.has_value() && file_size > 0) {
+    // Assume that the projected bytes are evenly spread over the file.
+    size_bytes = static_cast<int64_t>(static_cast<double>(length_) / file_size *
+                                      *projected_file_size_);
+  }
+  for (const auto& delete_file : delete_files_) {
+    // Deletion vectors only read their blob of the Puffin file.
+    size_bytes += delete_file->content_size_in_bytes.value_or(
+        delete_file->file_size_in_bytes);
+  }
+  return size_bytes;
+}
+
+int32_t FileScanTask::files_count() const {
+  return 1 + static_cast<int32_t>(delete_files_.size());
+}
+
+int64_t FileScanTask::estimated_row_count() const {
+  const int64_t file_size = data_file_->file_size_in_bytes;
+  double fraction = row_group_sample_.has_value() ? row_group_sample_->fraction : 1.0;
+  if (length_ != file_size && file_size > 0) {
+    // Assume that the rows are evenly spread over the file.
+    fraction *= static_cast<double>(length_) / file_size;
+  }
+  if (fraction == 1.0) {
+    return data_file_->record_count;
+  }
+  return static_cast<int64_t>(fraction * data_file_->record_count);
+}
+
+Result<ArrowArrayStream> FileScanTask::ToArrow(
+    const std::shared_ptr<FileIO>& io, const std::shared_ptr<Schema>& projected_schema,
+    const std::shared_ptr<Expression>& filter, RowFilterMode row_filter_mode,
+    int32_t prefetch_batches, std::shared_ptr<ReadMetrics> metrics) const {
+  std::optional<Split> split;
+  if (start_ != 0 || length_ != data_file_->file_size_in_bytes) {
+    split = Split{.offset = static_cast<size_t>(start_),
+                  .length = static_cast<size_t>(length_)};
+  }
+
+  auto private_data = std::make_unique<ReaderStreamPrivateData>();
+  private_data->metrics = metrics != nullptr ? metrics : std::make_shared<ReadMetrics>();
+  private_data->read_schema = projected_schema;
+  private_data->num_columns = static_cast<int64_t>(projected_schema->fields().size());
+  std::shared_ptr<const PositionDeleteIndex> position_deletes;
+  if (!delete_files_.empty()) {
+    // Without the loader of a scan, equality fields are resolved in the projection.
+    auto delete_loader = delete_loader_ != nullptr
+                             ? delete_loader_
+                             : std::make_shared<DeleteLoader>(io, projected_schema,
+                                                              memory_pool_);
+    std::vector<std::shared_ptr<DataFile>> position_delete_files;
+    std::vector<std::shared_ptr<DataFile>> equality_delete_files;
+    for (const auto& delete_file : delete_files_) {
+      if (delete_file->content == DataFile::Content::kEqualityDeletes) {
+        equality_delete_files.push_back(delete_file);
+      } else {
+        position_delete_files.push_back(delete_file);
+      }
+    }
+    if (!position_delete_files.empty()) {
+      ICEBERG_ASSIGN_OR_RAISE(position_deletes,
+                              delete_loader->LoadPositionDeletes(position_delete_files,
+                                                                 data_file_->file_path));
+    }
+    if (!equality_delete_files.empty()) {
+      ICEBERG_ASSIGN_OR_RAISE(private_data->equality_deletes,
+                              delete_loader->LoadEqualityDeletes(equality_delete_files));
+      ICEBERG_ASSIGN_OR_RAISE(
+          private_data->read_schema,
+          WithEqualityFields(projected_schema, *delete_loader->schema(),
+                             private_data->equality_deletes));
+    }
+  }
+
+  // A filter that is always true, like the residual of a partition that guarantees
+  // the scan filter, does not need to be evaluated on the rows.
+  auto row_filter = filter;
+  if (row_filter != nullptr && row_filter->op() == Expression::Operation::kTrue) {
+    row_filter = nullptr;
+  }
+  if (row_filter != nullptr && row_filter_mode == RowFilterMode::kCompact) {
+    ICEBERG_ASSIGN_OR_RAISE(private_data->evaluator,
+                            BatchEvaluator::Make(*private_data->read_schema, row_filter));
+  }
+
+  const ReaderOptions options{.path = data_file_->file_path,
+                              .length = data_file_->file_size_in_bytes,
+                              .split = split,
+                              .row_group_sample = row_group_sample_,
+                              .io = io,
+                              .projection = private_data->read_schema,
+                              .filter = row_filter,
+                              .position_deletes = std::move(position_deletes),
+                              .memory_pool = memory_pool_,
+                              .metrics = std::move(metrics),
+                              .executor = executor_,
+                              .metadata_columns = {
+                                  .spec_id = data_file_->partition_spec_id,
+                                  .first_row_id = data_file_->first_row_id}};
+
+  ICEBERG_ASSIGN_OR_RAISE(private_data->reader,
+                          ReaderFactoryRegistry::Open(data_file_->file_format, options));
+
+  return MakeArrowArrayStream(std::move(private_data), prefetch_batches, executor_,
+                              io_executor_);
+}
+
+Result<int64_t> FileScanTask::CountRows(const std::shared_ptr<FileIO>& io,
+                                        const std::shared_ptr<Schema>& schema,
+                                        const std::shared_ptr<Expression>& filter,
+                                        std::shared_ptr<ReadMetrics> metrics) const {
+  const bool matches_all =
+      filter == nullptr || filter->op() == Expression::Operation::kTrue;
+  const bool whole_file = start_ == 0 && length_ == data_file_->file_size_in_bytes &&
+                          !row_group_sample_.has_value();
+  const bool has_equality_deletes =
+      std::ranges::any_of(delete_files_, [](const auto& delete_file) {
+        return delete_file->content == DataFile::Content::kEqualityDeletes;
+      });
+  if (matches_all && whole_file && !has_equality_deletes) {
+    int64_t deleted_rows = 0;
+    if (!delete_files_.empty()) {
+      auto delete_loader = delete_loader_ != nullptr
+                               ? delete_loader_
+                               : std::make_shared<DeleteLoader>(io, schema, memory_pool_);
+      ICEBERG_ASSIGN_OR_RAISE(
+          auto position_deletes,
+          delete_loader->LoadPositionDeletes(delete_files_, data_file_->file_path));
+      deleted_rows = position_deletes->Cardinality();
+    }
+    return data_file_->record_count - deleted_rows;
+  }
+
+  std::vector<int32_t> field_ids;
+  if (!matches_all) {
+    ICEBERG_ASSIGN_OR_RAISE(auto referenced,
+                            Binder::BoundReferences(*schema, filter,
+                                                    /*case_sensitive=*/true));
+    field_ids.assign(referenced.begin(), referenced.end());
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto filter_schema, schema->SelectFieldIds(field_ids));
+  ICEBERG_ASSIGN_OR_RAISE(auto stream,
+                          ToArrow(io, filter_schema, filter, RowFilterMode::kCompact,
+                                  /*prefetch_batches=*/0, std::move(metrics)));
+  int64_t count = 0;
+  Status status;
+  while (true) {
+    ArrowArray array;
+    if (int code = stream.get_next(&stream, &array); code != 0) {
+      const char* message = stream.get_last_error(&stream);
+      status = IOError("Cannot read the rows of {}: {}", data_file_->file_path,
+                       message != nullptr ? message : std::strerror(code));
+      break;
+    }
+    if (array.release == nullptr) {
+      break;
+    }
+    count += array.length;
+    array.release(&array);
+  }
+  stream.release(&stream);
+  ICEBERG_RETURN_UNEXPECTED(status);
+  return count;
+}
+
+// implement CombinedScanTask
+CombinedScanTask::CombinedScanTask(std::vector<std::shared_ptr<FileScanTask>> tasks)
+    : tasks_(std::move(tasks)) {}
+
+const std::vector<std::shared_ptr<FileScanTask>>& CombinedScanTask::tasks() const {
+  return tasks_;
+}
+
+int64_t CombinedScanTask::size_bytes() const {
+  int64_t size_bytes = 0;
+  for (const auto& task : tasks_) {
+    size_bytes += task->size_bytes();
+  }
+  return size_bytes;
+}
+
+int32_t CombinedScanTask::files_count() const {
+  int32_t files_count = 0;
+  for (const auto& task : tasks_) {
+    files_count += task->files_count();
+  }
+  return files_count;
+}
+
+int64_t CombinedScanTask::estimated_row_count() const {
+  int64_t row_count = 0;
+  for (const auto& task : tasks_) {
+    row_count += task->estimated_row_count();
+  }
+  return row_count;
+}
+
+GroupedScanTask::GroupedScanTask(std::vector<Literal> grouping_key,
+                                 std::vector<std::shared_ptr<FileScanTask>> tasks)
+    : CombinedScanTask(std::move(tasks)), grouping_key_(std::move(grouping_key)) {}
+
+const std::vector<Literal>& GroupedScanTask::grouping_key() const {
+  return grouping_key_;
+}
+
+ChangelogScanTask::ChangelogScanTask(std::shared_ptr<DataFile> data_file,
+                                     ChangelogOperation operation,
+                                     int32_t change_ordinal, int64_t commit_snapshot_id)
+    : FileScanTask(std::move(data_file)),
+      operation_(operation),
+      change_ordinal_(change_ordinal),
+      commit_snapshot_id_(commit_snapshot_id) {}
+
+ChangelogOperation ChangelogScanTask::operation() const { return operation_; }
+
+int32_t ChangelogScanTask::change_ordinal() const { return change_ordinal_; }
+
+int64_t ChangelogScanTask::commit_snapshot_id() const { return commit_snapshot_id_; }
+
+TableScanBuilder::TableScanBuilder(std::shared_ptr<TableMetadata> table_metadata,
+                                   std::shared_ptr<FileIO> file_io)
+    : file_io_(std::move(file_io)) {
+  context_.table_metadata = std::move(table_metadata);
+}
+
+TableScanBuilder& TableScanBuilder::WithColumnNames(
+    std::vector<std::string> column_names) {
+  column_names_ = std::move(column_names);
+  return *this;
+}
+
+TableScanBuilder& TableScanBuilder::WithFieldIds(std::vector<int32_t> field_ids) {
+  field_ids_ = std::move(field_ids);
+  return *this;
+}
+
+TableScanBuilder& TableScanBuilder::WithProjectedSchema(std::shared_ptr<Schema> schema) {
+  context_.projected_schema = std::move(schema);
+  return *this;
+}
+
+TableScanBuilder& TableScanBuilder::WithSnapshotId(int64_t snapshot_id) {
+  snapshot_id_ = snapshot_id;
+  return *this;
+}
+
+TableScanBuilder& TableScanBuilder::AsOfTime(TimePointMs timestamp) {
+  as_of_time_ = timestamp;
+  return *this;
+}
+
+TableScanBuilder& TableScanBuilder::UseRef(std::string name) {
+  ref_ = std::move(name);
+  return *this;
+}
+
+TableScanBuilder& TableScanBuilder::WithSnapshotLogIndex(
+    std::shared_ptr<const SnapshotLogIndex> index) {
+  snapshot_log_index_ = std::move(index);
+  return *this;
+}
+
+TableScanBuilder& TableScanBuilder::WithSpecEvaluatorCache(
+    std::shared_ptr<SpecEvaluatorCache> cache) {
+  context_.spec_evaluator_cache = std::move(cache);
+  return *this;
+}
+
+TableScanBuilder& TableScanBuilder::WithPlanCache(std::shared_ptr<ScanPlanCache> cache) {
+  context_.plan_cache = std::move(cache);
+  return *this;
+}
+
+TableScanBuilder& TableScanBuilder::FromSnapshotExclusive(int64_t snapshot_id) {
+  context_.from_snapshot_id = snapshot_id;
+  return *this;
+}
+
+TableScanBuilder& TableScanBuilder::ToSnapshot(int64_t snapshot_id) {
+  snapshot_id_ = snapshot_id;
+  return *this;
+}
+
+TableScanBuilder& TableScanBuilder::WithFilter(std::shared_ptr<Expression> filter) {
+  context_.filter = std::move(filter);
+  return *this;
+}
+
+TableScanBuilder& TableScanBuilder::WithCaseSensitive(bool case_sensitive) {
+  context_.case_sensitive = case_sensitive;
+  return *this;
+}
+
+TableScanBuilder& TableScanBuilder::WithOption(std::string property, std::string value) {
+  context_.options[std::move(property)] = std::move(value);
+  return *this;
+}
+
+TableScanBuilder& TableScanBuilder::WithLimit(std::optional<int64_t> limit) {
+  context_.limit = limit;
+  return *this;
+}
+
+TableScanBuilder& TableScanBuilder::WithSample(double fraction, uint32_t seed,
+                                               SampleGranularity granularity) {
+  context_.sample =
+      ScanSample{.fraction = fraction, .seed = seed, .granularity = granularity};
+  return *this;
+}
+
+TableScanBuilder& TableScanBuilder::WithSpill(SpillOptions options) {
+  context_.spill = std::move(options);
+  return *this;
+}
+
+TableScanBuilder& TableScanBuilder::WithColumnStats(bool include) {
+  context_.include_column_stats = include;
+  return *this;
+}
+
+TableScanBuilder& TableScanBuilder::WithBloomFilterIndex(
+    std::shared_ptr<const BloomFilterIndex> index) {
+  context_.bloom_filter_index = std::move(index);
+  return *this;
+}
+
+TableScanBuilder& TableScanBuilder::WithPlanningParallelism(int32_t parallelism) {
+  context_.planning_parallelism = parallelism;
+  return *this;
+}
+
+TableScanBuilder& TableScanBuilder::WithManifestReadahead(int64_t bytes) {
+  context_.manifest_readahead_bytes = bytes;
+  return *this;
+}
+
+TableScanBuilder& TableScanBuilder::WithMetricsReporter(
+    std::shared_ptr<MetricsReporter> reporter, TableIdentifier table_identifier) {
+  context_.metrics_reporter = std::move(reporter);
+  context_.table_identifier = std::move(table_identifier);
+  return *this;
+}
+
+TableScanBuilder& TableScanBuilder::WithExecutor(std::shared_ptr<Executor> executor) {
+  context_.executor = std::move(executor);
+  return *this;
+}
+
+TableScanBuilder& TableScanBuilder::WithIOExecutor(
+    std::shared_ptr<Executor> io_executor) {
+  context_.io_executor = std::move(io_executor);
+  return *this;
+}
+
+TableScanBuilder& TableScanBuilder::WithMemoryPool(
+    std::shared_ptr<MemoryPool> memory_pool) {
+  context_.memory_pool = std::move(memory_pool);
+  return *this;
+}
+
+Status TableScanBuilder::ResolveContext() {
+  if (context_.planning_parallelism < 1) {
+    return InvalidArgument("Planning parallelism must be positive, got {}",
+                           context_.planning_parallelism);
+  }
+  if (context_.manifest_readahead_bytes < 0) {
+    return InvalidArgument("Manifest readahead must not be negative, got {}",
+                           context_.manifest_readahead_bytes);
+  }
+  if (const auto& sample = context_.sample; sample.has_value()) {
+    if (!(sample->fraction > 0 && sample->fraction <= 1)) {
+      return InvalidArgument("Sample fraction must be in (0, 1], got {}",
+                             sample->fraction);
+    }
+  }
+  if (context_.spill.has_value() && context_.spill->memory_budget_bytes <= 0) {
+    return InvalidArgument("Spill memory budget must be positive, got {}",
+                           context_.spill->memory_budget_bytes);
+  }
+
+  const auto& table_metadata = context_.table_metadata;
+  const int snapshot_selectors = (snapshot_id_.has_value() ? 1 : 0) +
+                                 (as_of_time_.has_value() ? 1 : 0) +
+                                 (ref_.has_value() ? 1 : 0);
+  if (snapshot_selectors > 1) {
+    return InvalidArgument(
+        "Cannot set more than one of the snapshot ID, the time and the ref to scan");
+  }
+  auto snapshot_id = snapshot_id_;
+  if (as_of_time_.has_value()) {
+    if (snapshot_log_index_ == nullptr) {
+      snapshot_log_index_ = std::make_shared<SnapshotLogIndex>(*table_metadata);
+    }
+    snapshot_id = snapshot_log_index_->SnapshotIdAsOf(*as_of_time_);
+    if (!snapshot_id.has_value()) {
+      return InvalidArgument("Cannot find a snapshot of table {} older than {}ms",
+                             table_metadata->table_uuid,
+                             UnixMsFromTimePointMs(*as_of_time_));
+    }
+  } else if (ref_.has_value()) {
+    auto ref = table_metadata->refs.find(*ref_);
+    if (ref == table_metadata->refs.cend()) {
+      return InvalidArgument("Cannot find ref {} of table {}", *ref_,
+                             table_metadata->table_uuid);
+    }
+    snapshot_id = ref->second->snapshot_id;
+  } else if (!snapshot_id.has_value()) {
+    snapshot_id = table_metadata->current_snapshot_id;
+  }
+  if (!snapshot_id) {
+    return InvalidArgument("No snapshot ID specified for table {}",
+                           table_metadata->table_uuid);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(context_.snapshot, table_metadata->SnapshotById(*snapshot_id));
+
+  if (!context_.projected_schema) {
+    const auto& snapshot = context_.snapshot;
+    auto schema_id =
+        snapshot->schema_id ? snapshot->schema_id : table_metadata->current_schema_id;
+    ICEBERG_ASSIGN_OR_RAISE(auto schema, table_metadata->SchemaById(schema_id));
+
+    if (column_names_.empty() && field_ids_.empty()) {
+      context_.projected_schema = schema;
+    } else {
+      std::vector<int32_t> selected_ids;
+      selected_ids.reserve(column_names_.size() + field_ids_.size());
+      for (const auto& column_name : column_names_) {
+        ICEBERG_ASSIGN_OR_RAISE(
+            auto field_opt,
+            schema->FindFieldByName(column_name, context_.case_sensitive));
+        if (!field_opt) {
+          return InvalidArgument("Column {} not found in schema '{}'", column_name,
+                                 *schema_id);
+        }
+        selected_ids.push_back(field_opt->get().field_id());
+      }
+      for (int32_t field_id : field_ids_) {
+        ICEBERG_ASSIGN_OR_RAISE(auto field_opt, schema->FindFieldById(field_id));
+        if (!field_opt) {
+          return InvalidArgument("Field {} not found in schema '{}'", field_id,
+                                 *schema_id);
+        }
+        selected_ids.push_back(field_id);
+      }
+      // Columns referenced by the filter must be read to evaluate it on rows.
+      if (context_.filter) {
+        ICEBERG_ASSIGN_OR_RAISE(auto filter_ids,
+                                Binder::BoundReferences(*schema, context_.filter,
+                                                        context_.case_sensitive));
+        selected_ids.insert(selected_ids.end(), filter_ids.begin(), filter_ids.end());
+      }
+      ICEBERG_ASSIGN_OR_RAISE(context_.projected_schema,
+                              schema->SelectFieldIds(selected_ids));
+    }
+  } else if (!column_names_.empty() || !field_ids_.empty()) {
+    return InvalidArgument(
+        "Cannot specify column names or field IDs when a projected schema is provided");
+  }
+
+  if (context_.from_snapshot_id.has_value()) {
+    ICEBERG_RETURN_UNEXPECTED(
+        SnapshotsAfter(*table_metadata, context_.from_snapshot_id, context_.snapshot));
+  }
+  return {};
+}
+
+Result<std::unique_ptr<TableScan>> TableScanBuilder::Build() {
+  ICEBERG_RETURN_UNEXPECTED(ResolveContext());
+  if (context_.from_snapshot_id.has_value()) {
+    return std::make_unique<IncrementalAppendScan>(std::move(context_), file_io_);
+  }
+  return std::make_unique<DataTableScan>(std::move(context_), file_io_);
+}
+
+Result<std::unique_ptr<IncrementalChangelogScan>> TableScanBuilder::BuildChangelog() {
+  ICEBERG_RETURN_UNEXPECTED(ResolveContext());
+  return std::make_unique<IncrementalChangelogScan>(std::move(context_), file_io_);
+}
+
+TableScan::TableScan(TableScanContext context, std::shared_ptr<FileIO> file_io)
+    : context_(std::move(context)), file_io_(std::move(file_io)) {}
+
+const std::shared_ptr<Snapshot>& TableScan::snapshot() const { return context_.snapshot; }
+
+const std::shared_ptr<Schema>& TableScan::projection() const {
+  return context_.projected_schema;
+}
+
+const TableScanContext& TableScan::context() const { return context_; }
+
+double TableScan::sample_scale_factor() const {
+  return context_.sample.has_value() ? context_.sample->scale_factor() : 1.0;
+}
+
+const std::shared_ptr<FileIO>& TableScan::io() const { return file_io_; }
+
+Result<ArrowArrayStream> TableScan::ToArrow(int32_t parallelism, ScanOrder order,
+                                            RowFilterMode row_filter_mode) const {
+  if (parallelism <= 0) {
+    return InvalidArgument("Parallelism must be positive: {}", parallelism);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto combined_tasks, PlanTasks());
+  const bool validate_utf8 = ScanFlag(context_, TableProperties::kValidateUtf8Enabled);
+  std::vector<std::vector<ArrowStreamOpener>> groups;
+  groups.reserve(combined_tasks.size());
+  for (const auto& combined_task : combined_tasks) {
+    auto& group = groups.emplace_back();
+    for (const auto& task : combined_task->tasks()) {
+      group.push_back([task, io = file_io_, projection = context_.projected_schema,
+                       row_filter_mode, validate_utf8]() -> Result<ArrowArrayStream> {
+        ICEBERG_ASSIGN_OR_RAISE(
+            auto stream,
+            task->ToArrow(io, projection, task->residual(), row_filter_mode));
+        return validate_utf8 ? MakeUtf8ValidatingArrowStream(stream) : stream;
+      });
+    }
+  }
+  return MakeMergedArrowStream(
+      context_.projected_schema, std::move(groups),
+      {.parallelism = parallelism,
+       .ordered = order == ScanOrder::kOrdered,
+       .capacity = 2 * static_cast<size_t>(parallelism),
+       .limit = context_.limit,
+       .executor = context_.executor});
+}
+
+Result<OrderedScanPlan> TableScan::PlanOrderedFiles() const {
+  if (context_.limit.has_value()) {
+    // Planning stops at the limit, so the files of the first rows may not be planned.
+    return InvalidArgument("Cannot order the files of a scan with a limit");
+  }
+  if (!context_.include_column_stats) {
+    return InvalidArgument("Cannot order the files of a scan without column stats");
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto sort_order, context_.table_metadata->SortOrder());
+  if (sort_order->fields().empty()) {
+    return InvalidArgument("Cannot order the files of an unsorted table");
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto schema,
+                          context_.table_metadata->SchemaById(
+                              context_.snapshot->schema_id
+                                  ? context_.snapshot->schema_id
+                                  : context_.table_metadata->current_schema_id));
+  ICEBERG_ASSIGN_OR_RAISE(auto tasks, PlanFiles());
+
+  // Only the bounds of an identity leading column tell where the rows of a file are.
+  const auto& leading = sort_order->fields().front();
+  const bool descending = leading.direction() == SortDirection::kDescending;
+  std::shared_ptr<PrimitiveType> type;
+  if (leading.transform()->transform_type() == TransformType::kIdentity) {
+    ICEBERG_ASSIGN_OR_RAISE(auto field, schema->FindFieldById(leading.source_id()));
+    if (field.has_value() && field->get().type()->is_primitive() &&
+        BoundsOrderSortKeys(field->get().type()->type_id())) {
+      type = internal::checked_pointer_cast<PrimitiveType>(field->get().type());
+    }
+  }
+
+  struct RangedTask {
+    SortRange range;
+    std::shared_ptr<FileScanTask> task;
+  };
+  std::vector<RangedTask> ranged_tasks;
+  ranged_tasks.reserve(tasks.size());
+  for (auto& task : tasks) {
+    SortRange range = kUnknownSortRange;
+    if (type != nullptr) {
+      ICEBERG_ASSIGN_OR_RAISE(range, FileSortRange(*task->data_file(), leading, type));
+    }
+    ranged_tasks.push_back({.range = std::move(range), .task = std::move(task)});
+  }
+  std::ranges::stable_sort(ranged_tasks, [descending](const auto& lhs, const auto& rhs) {
+    const int first = ComparePositions(lhs.range.first, rhs.range.first, descending);
+    return first != 0 ? first < 0
+                      : ComparePositions(lhs.range.last, rhs.range.last, descending) < 0;
+  });
+
+  // A task starts a new group once it starts after every row of the group. With a
+  // single sort field, rows with equal keys may be returned in any order, so a task
+  // may also start where the group ends.
+  const bool single_field = sort_order->fields().size() == 1;
+  OrderedScanPlan plan{.sort_order = sort_order};
+  const SortPosition* group_last = nullptr;
+  for (auto& ranged_task : ranged_tasks) {
+    const auto& range = ranged_task.range;
+    const int order = group_last == nullptr
+                          ? -1
+                          : ComparePositions(*group_last, range.first, descending);
+    if (order < 0 || (order == 0 && single_field)) {
+      plan.groups.emplace_back();
+      group_last = &range.last;
+    } else if (ComparePositions(*group_last, range.last, descending) < 0) {
+      group_last = &range.last;
+    }
+    plan.groups.back().push_back(std::move(ranged_task.task));
+  }
+  plan.globally_ordered = std::ranges::all_of(plan.groups, [&](const auto& group) {
+    return group.size() == 1 &&
+           group.front()->data_file()->sort_order_id == sort_order->order_id();
+  });
+  return plan;
+}
+
+Result<ArrowArrayStream> TableScan::ToSortedArrow(int32_t parallelism,
+                                                  RowFilterMode row_filter_mode) const {
+  if (parallelism <= 0) {
+    return InvalidArgument("Parallelism must be positive: {}", parallelism);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto plan, PlanOrderedFiles());
+  for (const auto& sort_field : plan.sort_order->fields()) {
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto field, context_.projected_schema->FindFieldById(sort_field.source_id()));
+    if (!field.has_value()) {
+      return InvalidArgument("Cannot read in sort order without sort column {}",
+                             sort_field.source_id());
+    }
+  }
+
+  auto open_task = [io = file_io_, projection = context_.projected_schema,
+                    row_filter_mode,
+                    validate_utf8 = ScanFlag(context_,
+                                             TableProperties::kValidateUtf8Enabled)](
+                       std::shared_ptr<FileScanTask> task) {
+    return [task = std::move(task), io, projection, row_filter_mode,
+            validate_utf8]() -> Result<ArrowArrayStream> {
+      ICEBERG_ASSIGN_OR_RAISE(
+          auto stream, task->ToArrow(io, projection, task->residual(), row_filter_mode));
+      return validate_utf8 ? MakeUtf8ValidatingArrowStream(stream) : stream;
+    };
+  };
+  std::vector<std::vector<ArrowStreamOpener>> groups;
+  groups.reserve(plan.groups.size());
+  for (const auto& tasks : plan.groups) {
+    for (const auto& task : tasks) {
+      if (task->data_file()->sort_order_id != plan.sort_order->order_id()) {
+        return NotSupported("Cannot read in sort order data file {} not written in it",
+                            task->data_file()->file_path);
+      }
+    }
+    if (tasks.size() == 1) {
+      groups.push_back({open_task(tasks.front())});
+      continue;
+    }
+    std::vector<ArrowStreamOpener> parts;
+    parts.reserve(tasks.size());
+    for (const auto& task : tasks) {
+      parts.push_back(open_task(task));
+    }
+    groups.push_back({[projection = context_.projected_schema,
+                       sort_order = plan.sort_order, parts = std::move(parts)]() {
+      return MakeSortedMergeArrowStream(projection, sort_order, parts);
+    }});
+  }
+  // Each group is its own part, so that the workers read groups ahead while the
+  // ordered stream returns them one after the other.
+  return MakeMergedArrowStream(
+      context_.projected_schema, std::move(groups),
+      {.parallelism = parallelism,
+       .ordered = true,
+       .capacity = 2 * static_cast<size_t>(parallelism),
+       .executor = context_.executor});
+}
+
+Result<std::vector<AggregateValue>> TableScan::Aggregate(
+    const std::vector<ScanAggregate>& aggregates) const {
+  if (context_.limit.has_value()) {
+    // Planning stops at the limit, so the planned files may not hold all the rows.
+    return InvalidArgument("Cannot aggregate the rows of a scan with a limit");
+  }
+  if (!context_.include_column_stats) {
+    return InvalidArgument("Cannot aggregate the rows of a scan without column stats");
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto schema,
+                          context_.table_metadata->SchemaById(
+                              context_.snapshot->schema_id
+                                  ? context_.snapshot->schema_id
+                                  : context_.table_metadata->current_schema_id));
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto aggregator,
+      MetricsAggregator::Make(*schema, aggregates, context_.case_sensitive));
+  ICEBERG_RETURN_UNEXPECTED(PlanFiles([&](std::shared_ptr<FileScanTask> task) -> Status {
+    // Tasks without a residual of a filtered scan may hold rows that do not match.
+    const bool exact = MatchesAllRows(*task) &&
+                       (task->residual() != nullptr || context_.filter == nullptr);
+    return aggregator->Add(*task->data_file(), exact);
+  }));
+  return aggregator->Values();
+}
+
+Result<ScanExplain> TableScan::Explain() const {
+  return NotSupported("Explain is not supported by this scan");
+}
+
+Result<std::vector<std::shared_ptr<FileScanTask>>> TableScan::PlanFiles() const {
+  std::vector<std::shared_ptr<FileScanTask>> tasks;
+  ICEBERG_RETURN_UNEXPECTED(PlanFiles([&](std::shared_ptr<FileScanTask> task) -> Status {
+    tasks.push_back(std::move(task));
+    return {};
+  }));
+  return tasks;
+}
+
+Task<Result<std::vector<std::shared_ptr<FileScanTask>>>> TableScan::PlanFilesAsync(
+    std::shared_ptr<Executor> executor) const {
+  if (executor == nullptr) {
+    executor = context_.executor;
+  }
+  return RunOn(std::move(executor), [this]() { return PlanFiles(); });
+}
+
+Result<std::vector<std::shared_ptr<CombinedScanTask>>> TableScan::PlanTasks() const {
+  ICEBERG_ASSIGN_OR_RAISE(auto split_size,
+                          PositiveScanProperty(context_, TableProperties::kSplitSize));
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto lookback, PositiveScanProperty(context_, TableProperties::kSplitLookback));
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto open_file_cost,
+      PositiveScanProperty(context_, TableProperties::kSplitOpenFileCost));
+
+  std::vector<std::shared_ptr<CombinedScanTask>> combined_tasks;
+  ICEBERG_RETURN_UNEXPECTED(PackPlannedTasks(
+      split_size, lookback, open_file_cost,
+      [&](std::shared_ptr<CombinedScanTask> task) -> Status {
+        combined_tasks.push_back(std::move(task));
+        return {};
+      }));
+  return combined_tasks;
+}
+
+Result<std::unique_ptr<ScanTaskSpill>> TableScan::PlanSpilledTasks() const {
+  if (!context_.spill.has_value()) {
+    return InvalidArgument("Cannot plan spilled tasks of a scan without spill options");
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto split_size,
+                          PositiveScanProperty(context_, TableProperties::kSplitSize));
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto lookback, PositiveScanProperty(context_, TableProperties::kSplitLookback));
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto open_file_cost,
+      PositiveScanProperty(context_, TableProperties::kSplitOpenFileCost));
+  ICEBERG_ASSIGN_OR_RAISE(auto schema,
+                          context_.table_metadata->SchemaById(
+                              context_.snapshot->schema_id
+                                  ? context_.snapshot->schema_id
+                                  : context_.table_metadata->current_schema_id));
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto spill, ScanTaskSpill::Make(*context_.spill, std::move(schema),
+                                      context_.projected_schema));
+
+  ICEBERG_RETURN_UNEXPECTED(PackPlannedTasks(
+      split_size, lookback, open_file_cost,
+      [&](std::shared_ptr<CombinedScanTask> task) {
+        return spill->Add(std::move(task));
+      }));
+  return spill;
+}
+
+Status TableScan::PackPlannedTasks(
+    int64_t split_size, int32_t lookback, int64_t open_file_cost,
+    const std::function<Status(std::shared_ptr<CombinedScanTask>)>& callback) const {
+  TaskPacker packer(split_size, lookback, open_file_cost, callback);
+  std::vector<std::shared_ptr<FileScanTask>> split_tasks;
+  ICEBERG_RETURN_UNEXPECTED(PlanFiles([&](std::shared_ptr<FileScanTask> task) -> Status {
+    split_tasks.clear();
+    SplitFileTask(task, split_size, split_tasks);
+    for (auto& split_task : split_tasks) {
+      ICEBERG_RETURN_UNEXPECTED(packer.Add(std::move(split_task)));
+    }
+    return {};
+  }));
+  return packer.Finish();
+}
+
+Result<std::vector<ManifestShard>> TableScan::PlanShards(int32_t /*num_shards*/) const {
+  return NotSupported("Sharded planning is not supported by this scan");
+}
+
+Result<std::vector<std::shared_ptr<FileScanTask>>> TableScan::PlanShard(
+    const ManifestShard& /*shard*/) const {
+  return NotSupported("Sharded planning is not supported by this scan");
+}
+
+Result<std::vector<std::shared_ptr<CombinedScanTask>>> TableScan::MergeShardTasks(
+    std::vector<std::vector<std::shared_ptr<FileScanTask>>> shard_tasks) const {
+  ICEBERG_ASSIGN_OR_RAISE(auto split_size,
+                          PositiveScanProperty(context_, TableProperties::kSplitSize));
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto lookback, PositiveScanProperty(context_, TableProperties::kSplitLookback));
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto open_file_cost,
+      PositiveScanProperty(context_, TableProperties::kSplitOpenFileCost));
+
+  std::vector<std::shared_ptr<FileScanTask>> split_tasks;
+  for (const auto& tasks : shard_tasks) {
+    for (const auto& task : tasks) {
+      SplitFileTask(task, split_size, split_tasks);
+    }
+  }
+  return PackTasks(std::move(split_tasks), split_size, lookback, open_file_cost);
+}
+
+Result<std::vector<std::shared_ptr<GroupedScanTask>>> TableScan::PlanTasksByPartition(
+    const std::vector<std::string>& partition_fields) const {
+  if (partition_fields.empty()) {
+    return InvalidArgument("Cannot group scan tasks by no partition field");
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto default_spec, context_.table_metadata->PartitionSpec());
+  std::vector<const PartitionField*> grouping_fields;
+  for (const auto& name : partition_fields) {
+    auto fields = default_spec->fields();
+    auto it = std::ranges::find(fields, std::string_view(name), &PartitionField::name);
+    if (it == fields.end()) {
+      return InvalidArgument("Cannot find partition field {} in spec {}", name,
+                             default_spec->spec_id());
+    }
+    if (it->transform()->transform_type() == TransformType::kVoid) {
+      return InvalidArgument("Cannot group scan tasks by void partition field {}", name);
+    }
+    grouping_fields.push_back(&*it);
+  }
+
+  // The positions of the grouping fields in the partition tuples of each spec.
+  std::unordered_map<int32_t, std::vector<size_t>> spec_positions;
+  auto positions_of = [&](int32_t spec_id) -> Result<const std::vector<size_t>*> {
+    if (auto it = spec_positions.find(spec_id); it != spec_positions.end()) {
+      return &it->second;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto spec,
+                            context_.table_metadata->PartitionSpecById(spec_id));
+    const auto fields = spec->fields();
+    std::vector<size_t> positions;
+    for (const auto* grouping_field : grouping_fields) {
+      auto it = std::ranges::find_if(fields, [&](const PartitionField& field) {
+        return field.source_id() == grouping_field->source_id() &&
+               *field.transform() == *grouping_field->transform();
+      });
+      if (it == fields.end()) {
+        return InvalidArgument(
+            "Cannot group scan tasks by {}: partition spec {} has no field with its "
+            "source and transform",
+            grouping_field->name(), spec_id);
+      }
+      positions.push_back(static_cast<size_t>(it - fields.begin()));
+    }
+    return &spec_positions.emplace(spec_id, std::move(positions)).first->second;
+  };
+
+  ICEBERG_ASSIGN_OR_RAISE(auto split_size,
+                          PositiveScanProperty(context_, TableProperties::kSplitSize));
+  struct Group {
+    std::vector<Literal> key;
+    std::vector<std::shared_ptr<FileScanTask>> tasks;
+  };
+  // Grouping keys are not the partitions of a spec, they share one spec ID.
+  constexpr int32_t kGroupingSpecId = -1;
+  PartitionMap<Group> groups;
+  std::vector<std::shared_ptr<FileScanTask>> split_tasks;
+  ICEBERG_RETURN_UNEXPECTED(PlanFiles([&](std::shared_ptr<FileScanTask> task) -> Status {
+    const auto& data_file = *task->data_file();
+    ICEBERG_ASSIGN_OR_RAISE(const auto* positions,
+                            positions_of(data_file.partition_spec_id));
+    std::vector<Literal> key;
+    key.reserve(positions->size());
+    for (size_t position : *positions) {
+      if (position >= data_file.partition.size()) {
+        return InvalidManifest("Expected at least {} partition values of {}, got {}",
+                               position + 1, data_file.file_path,
+                               data_file.partition.size());
+      }
+      key.push_back(data_file.partition[position]);
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto group_key,
+                            PartitionTupleKey::Make(kGroupingSpecId, key));
+    auto [group, inserted] = groups.TryEmplace(std::move(group_key));
+    if (inserted) {
+      group->key = std::move(key);
+    }
+    split_tasks.clear();
+    SplitFileTask(task, split_size, split_tasks);
+    std::ranges::move(split_tasks, std::back_inserter(group->tasks));
+    return {};
+  }));
+
+  std::vector<std::shared_ptr<GroupedScanTask>> grouped_tasks;
+  grouped_tasks.reserve(groups.size());
+  for (auto& [unused, group] : groups) {
+    grouped_tasks.push_back(
+        std::make_shared<GroupedScanTask>(std::move(group.key), std::move(group.tasks)));
+  }
+  std::ranges::sort(grouped_tasks, [](const auto& lhs, const auto& rhs) {
+    const auto& lhs_key = lhs->grouping_key();
+    const auto& rhs_key = rhs->grouping_key();
+    for (size_t i = 0; i < lhs_key.size(); ++i) {
+      if (lhs_key[i].IsNull() || rhs_key[i].IsNull()) {
+        if (lhs_key[i].IsNull() != rhs_key[i].IsNull()) {
+          return lhs_key[i].IsNull();
+        }
+        continue;
+      }
+      if (auto cmp = lhs_key[i] <=> rhs_key[i]; cmp != 0) {
+        return cmp < 0;
+      }
+    }
+    return false;
+  });
+  return grouped_tasks;
+}
+
+DataTableScan::DataTableScan(TableScanContext context, std::shared_ptr<FileIO> file_io)
+    : TableScan(std::move(context), std::move(file_io)) {}
+
+Status DataTableScan::PlanFiles(const FileScanTaskCallback& callback) const {
+  if (context_.metrics_reporter == nullptr) {
+    ScanMetrics metrics;
+    return PlanCachedFiles(callback, metrics);
+  }
+
+  ScanReport report{
+      .table = context_.table_identifier,
+      .snapshot_id = context_.snapshot->snapshot_id,
+      .schema_id = context_.snapshot->schema_id
+                       ? context_.snapshot->schema_id
+                       : context_.table_metadata->current_schema_id,
+      .filter = context_.filter,
+  };
+  for (const auto& field : context_.projected_schema->fields()) {
+    report.projected_field_ids.push_back(field.field_id());
+  }
+  {
+    auto timed = report.metrics.total_planning_duration.Start();
+    ICEBERG_RETURN_UNEXPECTED(PlanCachedFiles(callback, report.metrics));
+  }
+  context_.metrics_reporter->Report(report);
+  return {};
+}
+
+Status DataTableScan::PlanCachedFiles(const FileScanTaskCallback& callback,
+                                      ScanMetrics& metrics) const {
+  const auto& cache = context_.plan_cache;
+  // The bloom filter index is not part of the key, so the plans it prunes are not
+  // cached.
+  if (cache == nullptr || context_.bloom_filter_index != nullptr) {
+    return PlanFiles(callback, metrics);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto schema,
+                          context_.table_metadata->SchemaById(
+                              context_.snapshot->schema_id
+                                  ? context_.snapshot->schema_id
+                                  : context_.table_metadata->current_schema_id));
+  ICEBERG_ASSIGN_OR_RAISE(auto key, PlanCacheKey(context_, *schema));
+
+  if (auto plan = cache->Get(key); plan != nullptr) {
+    ICEBERG_ASSIGN_OR_RAISE(auto batch, DeserializeScanTasks(*plan));
+    // The restored tasks share one delete loader, like the tasks of a planned scan.
+    std::shared_ptr<DeleteLoader> delete_loader;
+    for (const auto& combined_task : batch.tasks) {
+      for (const auto& task : combined_task->tasks()) {
+        if (!task->delete_files().empty() && delete_loader == nullptr) {
+          delete_loader = std::make_shared<DeleteLoader>(
+              file_io_, batch.schema, context_.memory_pool, context_.spill);
+        }
+        metrics.result_data_files.Increment();
+        metrics.result_delete_files.Increment(
+            static_cast<int64_t>(task->delete_files().size()));
+        auto restored = std::make_shared<FileScanTask>(
+            task->data_file(), task->delete_files(),
+            task->delete_files().empty() ? nullptr : delete_loader, task->residual(),
+            context_.memory_pool, context_.executor, context_.io_executor,
+            task->projected_file_size());
+        if (task->row_group_sample().has_value()) {
+          restored = restored->SampleRowGroups(*task->row_group_sample());
+        }
+        ICEBERG_RETURN_UNEXPECTED(callback(std::move(restored)));
+      }
+    }
+    return {};
+  }
+
+  std::vector<std::shared_ptr<FileScanTask>> tasks;
+  ICEBERG_RETURN_UNEXPECTED(PlanFiles(
+      [&](std::shared_ptr<FileScanTask> task) -> Status {
+        tasks.push_back(task);
+        return callback(std::move(task));
+      },
+      metrics));
+  ScanTaskBatch batch{
+      .schema = std::move(schema),
+      .projected_schema = context_.projected_schema,
+      .tasks = {std::make_shared<CombinedScanTask>(std::move(tasks))},
+  };
+  // Plans that cannot be serialized are not cached.
+  if (auto plan = SerializeScanTasks(batch); plan.has_value()) {
+    cache->Put(std::move(key), std::move(plan.value()));
+  }
+  return {};
+}
+
+Result<ScanExplain> DataTableScan::Explain() const {
+  ScanExplain explain{.snapshot_id = context_.snapshot->snapshot_id,
+                      .filter = context_.filter};
+  {
+    auto timed = explain.metrics.total_planning_duration.Start();
+    ICEBERG_RETURN_UNEXPECTED(PlanFiles(
+        [](std::shared_ptr<FileScanTask>) -> Status { return {}; }, explain.metrics,
+        &explain));
+  }
+  explain.durations.total = explain.metrics.total_planning_duration.total_duration();
+  return explain;
+}
+
+Result<std::vector<ManifestShard>> DataTableScan::PlanShards(int32_t num_shards) const {
+  if (num_shards <= 0) {
+    return InvalidArgument("Number of shards must be positive: {}", num_shards);
+  }
+  if (context_.limit.has_value()) {
+    // Each shard would stop planning at the limit on its own.
+    return InvalidArgument("Cannot shard the planning of a scan with a limit");
+  }
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto manifest_list_reader,
+      ManifestListReader::Make(context_.snapshot->manifest_list, file_io_));
+  ICEBERG_ASSIGN_OR_RAISE(auto all_manifest_files, manifest_list_reader->Files());
+  std::erase_if(all_manifest_files, [](const ManifestFile& manifest_file) {
+    return !manifest_file.has_live_files();
+  });
+  ScanSpecs specs(context_);
+  ICEBERG_ASSIGN_OR_RAISE(auto manifest_files,
+                          FilterManifests(std::move(all_manifest_files), specs));
+  std::vector<ManifestFile> data_manifests;
+  std::vector<ManifestFile> delete_manifests;
+  for (auto& manifest_file : manifest_files) {
+    auto& manifests = manifest_file.content == ManifestFile::Content::kData
+                          ? data_manifests
+                          : delete_manifests;
+    manifests.push_back(std::move(manifest_file));
+  }
+
+  // The length of a manifest bounds the time to read it and its entries the time to
+  // decode it, so each counts for half of the weight of the manifests.
+  auto entries_of = [](const ManifestFile& manifest_file) {
+    return manifest_file.added_files_count.value_or(0) +
+           manifest_file.existing_files_count.value_or(0) +
+           manifest_file.deleted_files_count.value_or(0);
+  };
+  double total_length = 0;
+  double total_entries = 0;
+  for (const auto& manifest_file : data_manifests) {
+    total_length += static_cast<double>(manifest_file.manifest_length);
+    total_entries += entries_of(manifest_file);
+  }
+  std::vector<double> weights;
+  weights.reserve(data_manifests.size());
+  for (const auto& manifest_file : data_manifests) {
+    weights.push_back(
+        (total_length > 0 ? manifest_file.manifest_length / total_length : 0) +
+        (total_entries > 0 ? entries_of(manifest_file) / total_entries : 0));
+  }
+  std::vector<size_t> by_weight(data_manifests.size());
+  std::iota(by_weight.begin(), by_weight.end(), 0);
+  std::ranges::stable_sort(by_weight, std::greater<>(),
+                           [&](size_t index) { return weights[index]; });
+
+  const auto shard_count = std::min<size_t>(num_shards, data_manifests.size());
+  std::vector<double> loads(shard_count, 0);
+  std::vector<std::vector<size_t>> assigned(shard_count);
+  for (size_t index : by_weight) {
+    const auto lightest = std::ranges::min_element(loads) - loads.begin();
+    loads[lightest] += weights[index];
+    assigned[lightest].push_back(index);
+  }
+  std::vector<ManifestShard> shards;
+  shards.reserve(shard_count);
+  for (auto& indices : assigned) {
+    std::ranges::sort(indices);
+    auto& shard = shards.emplace_back(ManifestShard{
+        .snapshot_id = context_.snapshot->snapshot_id,
+        .delete_manifests = delete_manifests,
+    });
+    for (size_t index : indices) {
+      shard.data_manifests.push_back(std::move(data_manifests[index]));
+    }
+  }
+  return shards;
+}
+
+Result<std::vector<std::shared_ptr<FileScanTask>>> DataTableScan::PlanShard(
+    const ManifestShard& shard) const {
+  if (shard.snapshot_id != context_.snapshot->snapshot_id) {
+    return InvalidArgument("Cannot plan a shard of snapshot {} in a scan of snapshot {}",
+                           shard.snapshot_id, context_.snapshot->snapshot_id);
+  }
+  std::vector<std::shared_ptr<FileScanTask>> tasks;
+  ScanMetrics metrics;
+  ICEBERG_RETURN_UNEXPECTED(PlanFiles(
+      [&](std::shared_ptr<FileScanTask> task) -> Status {
+        tasks.push_back(std::move(task));
+        return {};
+      },
+      metrics, /*explain=*/nullptr, &shard));
+  return tasks;
+}
+
+Status DataTableScan::PlanFiles(const FileScanTaskCallback& callback,
+                                ScanMetrics& metrics, ScanExplain* explain,
+                                const ManifestShard* shard) const {
+  std::optional<ExplainCollector> collector;
+  if (explain != nullptr) {
+    collector.emplace(*explain);
+  }
+  ExplainCollector* explain_collector = collector ? &*collector : nullptr;
+
+  std::vector<ManifestFile> all_manifest_files;
+  if (shard != nullptr) {
+    all_manifest_files = shard->delete_manifests;
+    std::ranges::copy(shard->data_manifests, std::back_inserter(all_manifest_files));
+  } else {
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto manifest_list_reader,
+        ManifestListReader::Make(context_.snapshot->manifest_list, file_io_));
+    ICEBERG_ASSIGN_OR_RAISE(all_manifest_files, manifest_list_reader->Files());
+  }
+  if (collector) {
+    collector->AddManifests(all_manifest_files);
+    collector->EndStage(&ScanStageDurations::read_manifest_list);
+  }
+  const auto num_data_manifests = CountDataManifests(all_manifest_files);
+  metrics.total_data_manifests.Increment(num_data_manifests);
+  metrics.total_delete_manifests.Increment(
+      static_cast<int64_t>(all_manifest_files.size()) - num_data_manifests);
+  // Manifests whose entries are all deleted have no file to read.
+  std::erase_if(all_manifest_files, [](const ManifestFile& manifest_file) {
+    return !manifest_file.has_live_files();
+  });
+  ScanSpecs specs(context_);
+  ICEBERG_ASSIGN_OR_RAISE(auto manifest_files,
+                          FilterManifests(std::move(all_manifest_files), specs));
+  const auto num_matching_data_manifests = CountDataManifests(manifest_files);
+  metrics.skipped_data_manifests.Increment(num_data_manifests -
+                                           num_matching_data_manifests);
+  metrics.skipped_delete_manifests.Increment(
+      metrics.total_delete_manifests.value() -
+      (static_cast<int64_t>(manifest_files.size()) - num_matching_data_manifests));
+
+  ICEBERG_ASSIGN_OR_RAISE(auto schema,
+                          context_.table_metadata->SchemaById(
+                              context_.snapshot->schema_id
+                                  ? context_.snapshot->schema_id
+                                  : context_.table_metadata->current_schema_id));
+  std::unique_ptr<InclusiveMetricsEvaluator> metrics_evaluator;
+  if (context_.filter != nullptr) {
+    ICEBERG_ASSIGN_OR_RAISE(metrics_evaluator,
+                            InclusiveMetricsEvaluator::Make(context_.filter, *schema,
+                                                            context_.case_sensitive));
+  }
+  std::unique_ptr<SortedBoundsIndex> sorted_bounds_index;
+  if (context_.filter != nullptr) {
+    if (auto sort_order = context_.table_metadata->SortOrder(); sort_order.has_value()) {
+      ICEBERG_ASSIGN_OR_RAISE(
+          sorted_bounds_index,
+          SortedBoundsIndex::Make(*sort_order.value(), context_.filter, *schema,
+                                  context_.case_sensitive));
+    }
+  }
+  std::unique_ptr<BloomFilterIndexEvaluator> index_evaluator;
+  if (context_.filter != nullptr && context_.bloom_filter_index != nullptr) {
+    ICEBERG_ASSIGN_OR_RAISE(
+        index_evaluator,
+        BloomFilterIndexEvaluator::Make(context_.bloom_filter_index, context_.filter,
+                                        *schema, context_.case_sensitive));
+  }
+  if (collector) {
+    collector->EndStage(&ScanStageDurations::filter_manifests);
+  }
+
+  // Delete files are collected before planning the data manifests, because a data
+  // file may be deleted by the delete files of any delete manifest.
+  std::vector<ManifestFile> data_manifests;
+  data_manifests.reserve(manifest_files.size());
+  std::vector<ManifestEntry> delete_entries;
+  for (auto& manifest_file : manifest_files) {
+    if (manifest_file.content == ManifestFile::Content::kData) {
+      data_manifests.push_back(std::move(manifest_file));
+      continue;
+    }
+    const auto& evaluators = specs.At(manifest_file.partition_spec_id);
+    ICEBERG_RETURN_UNEXPECTED(CollectDeleteFiles(
+        manifest_file, file_io_, evaluators.partition_schema,
+        evaluators.residual_evaluator.get(), metrics, explain_collector, delete_entries));
+  }
+  metrics.indexed_delete_files.Increment(static_cast<int64_t>(delete_entries.size()));
+  manifest_files = std::move(data_manifests);
+  ICEBERG_ASSIGN_OR_RAISE(auto delete_index,
+                          DeleteFileIndex::Make(schema, std::move(delete_entries)));
+  // The tasks of the scan share one loader, so every delete file is read once.
+  auto delete_loader = delete_index.IsEmpty()
+                           ? nullptr
+                           : std::make_shared<DeleteLoader>(file_io_, schema,
+                                                            context_.memory_pool,
+                                                            context_.spill);
+  if (collector) {
+    collector->EndStage(&ScanStageDurations::index_delete_files);
+  }
+
+  std::vector<PrefetchingFileIO::File> prefetched_manifests;
+  if (context_.io_executor != nullptr) {
+    std::ranges::transform(manifest_files, std::back_inserter(prefetched_manifests),
+                           PrefetchedManifest);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto manifest_io,
+      ManifestFileIO(context_, file_io_, std::move(prefetched_manifests)));
+  ICEBERG_ASSIGN_OR_RAISE(auto projected_field_ids, ProjectedFieldIds(context_, *schema));
+  const auto read_options =
+      DataManifestReadOptions(context_, !delete_index.IsEmpty(),
+                              projected_field_ids.has_value(),
+                              {ManifestStatus::kAdded, ManifestStatus::kExisting});
+  auto plan_manifest = [&](const ManifestFile& manifest_file) {
+    const auto& evaluators = specs.At(manifest_file.partition_spec_id);
+    return PlanManifestTasks(
+        manifest_file, manifest_io, evaluators.partition_schema, read_options,
+        metrics_evaluator.get(), sorted_bounds_index.get(), index_evaluator.get(),
+        context_.include_column_stats,
+        projected_field_ids.has_value() ? &*projected_field_ids : nullptr,
+        context_.sample.has_value() ? &*context_.sample : nullptr,
+        evaluators.residual_evaluator.get(),
+        delete_index, delete_loader, context_.memory_pool, context_.executor,
+        context_.io_executor, metrics, explain_collector);
+  };
+  ICEBERG_RETURN_UNEXPECTED(PlanWithLimit(
+      context_.limit, callback, [&](const FileScanTaskCallback& limited_callback) {
+        return PlanManifestsInOrder(ContextExecutor(context_), manifest_files,
+                                    context_.planning_parallelism, plan_manifest,
+                                    limited_callback);
+      }));
+  if (collector) {
+    collector->EndStage(&ScanStageDurations::plan_data_files);
+    collector->Finish();
+  }
+  return {};
+}
+
+IncrementalAppendScan::IncrementalAppendScan(TableScanContext context,
+                                             std::shared_ptr<FileIO> file_io)
+    : TableScan(std::move(context), std::move(file_io)) {}
+
+Status IncrementalAppendScan::PlanFiles(const FileScanTaskCallback& callback) const {
+  ICEBERG_ASSIGN_OR_RAISE(auto snapshots,
+                          SnapshotsAfter(*context_.table_metadata,
+                                         context_.from_snapshot_id, context_.snapshot));
+
+  // Each append snapshot contributes the manifests it wrote, read from its own manifest
+  // list because a later append may have merged them into a new manifest.
+  std::unordered_set<int64_t> snapshot_ids;
+  std::vector<ManifestFile> all_manifest_files;
+  for (const auto& snapshot : snapshots) {
+    if (snapshot->operation() != DataOperation::kAppend) {
+      continue;
+    }
+    snapshot_ids.insert(snapshot->snapshot_id);
+    ICEBERG_ASSIGN_OR_RAISE(auto manifest_list_reader,
+                            ManifestListReader::Make(snapshot->manifest_list, file_io_));
+    ICEBERG_ASSIGN_OR_RAISE(auto manifest_files, manifest_list_reader->Files());
+    for (auto& manifest_file : manifest_files) {
+      if (manifest_file.content == ManifestFile::Content::kData &&
+          manifest_file.added_snapshot_id == snapshot->snapshot_id &&
+          manifest_file.has_added_files()) {
+        all_manifest_files.push_back(std::move(manifest_file));
+      }
+    }
+  }
+  ScanSpecs specs(context_);
+  ICEBERG_ASSIGN_OR_RAISE(auto manifest_files,
+                          FilterManifests(std::move(all_manifest_files), specs));
+
+  ICEBERG_ASSIGN_OR_RAISE(auto schema,
+                          context_.table_metadata->SchemaById(
+                              context_.snapshot->schema_id
+                                  ? context_.snapshot->schema_id
+                                  : context_.table_metadata->current_schema_id));
+  std::unique_ptr<InclusiveMetricsEvaluator> metrics_evaluator;
+  if (context_.filter != nullptr) {
+    ICEBERG_ASSIGN_OR_RAISE(metrics_evaluator,
+                            InclusiveMetricsEvaluator::Make(context_.filter, *schema,
+                                                            context_.case_sensitive));
+  }
+
+  std::vector<PrefetchingFileIO::File> prefetched_manifests;
+  if (context_.io_executor != nullptr) {
+    std::ranges::transform(manifest_files, std::back_inserter(prefetched_manifests),
+                           PrefetchedManifest);
+  }
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto manifest_io,
+      ManifestFileIO(context_, file_io_, std::move(prefetched_manifests)));
+  ICEBERG_ASSIGN_OR_RAISE(auto projected_field_ids, ProjectedFieldIds(context_, *schema));
+  const auto read_options =
+      DataManifestReadOptions(context_, /*match_deletes=*/false,
+                              projected_field_ids.has_value(), {ManifestStatus::kAdded});
+  // Appended tasks have no residual, so the filter may remove any of their rows.
+  return PlanWithLimit(
+      context_.filter == nullptr ? context_.limit : std::nullopt, callback,
+      [&](const FileScanTaskCallback& limited_callback) -> Status {
+        for (const auto& manifest_file : manifest_files) {
+          const auto& partition_schema =
+              specs.At(manifest_file.partition_spec_id).partition_schema;
+          ICEBERG_ASSIGN_OR_RAISE(
+              auto tasks,
+              PlanAppendedTasks(manifest_file, manifest_io, partition_schema,
+                                read_options, metrics_evaluator.get(),
+                                context_.include_column_stats,
+                                projected_field_ids.has_value() ? &*projected_field_ids
+                                                                : nullptr,
+                                context_.sample.has_value() ? &*context_.sample : nullptr,
+                                snapshot_ids,
+                                context_.memory_pool, context_.executor,
+                                context_.io_executor));
+          for (auto& task : tasks) {
+            ICEBERG_RETURN_UNEXPECTED(limited_callback(std::move(task)));
+          }
+        }
+        return {};
+      });
+}
+
+IncrementalChangelogScan::IncrementalChangelogScan(TableScanContext context,
+                                                   std::shared_ptr<FileIO> file_io)
+    : context_(std::move(context)), file_io_(std::move(file_io)) {}
+
+const TableScanContext& IncrementalChangelogScan::context() const { return context_; }
+
+const std::shared_ptr<FileIO>& IncrementalChangelogScan::io() const { return file_io_; }
+
+Result<std::vector<std::shared_ptr<ChangelogScanTask>>>
+IncrementalChangelogScan::PlanFiles() const {
+  std::vector<std::shared_ptr<ChangelogScanTask>> tasks;
+  ICEBERG_RETURN_UNEXPECTED(
+      PlanFiles([&](std::shared_ptr<ChangelogScanTask> task) -> Status {
+        tasks.push_back(std::move(task));
+        return {};
+      }));
   return tasks;
 }
 
+Status IncrementalChangelogScan::PlanFiles(
+    const ChangelogScanTaskCallback& callback) const {
+  ICEBERG_ASSIGN_OR_RAISE(auto snapshots,
+                          SnapshotsAfter(*context_.table_metadata,
+                                         context_.from_snapshot_id, context_.snapshot));
+
+  // The changes of a snapshot are in the manifests it wrote, and manifests without
+  // added or deleted files only carry files of older snapshots.
+  std::vector<ChangelogManifest> manifests;
+  ScanSpecs specs(context_);
+  int32_t change_ordinal = 0;
+  for (const auto& snapshot : snapshots) {
+    if (snapshot->operation() == DataOperation::kReplace) {
+      continue;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto manifest_list_reader,
+                            ManifestListReader::Make(snapshot->manifest_list, file_io_));
+    ICEBERG_ASSIGN_OR_RAISE(auto all_manifest_files, manifest_list_reader->Files());
+    std::vector<ManifestFile> snapshot_manifest_files;
+    for (auto& manifest_file : all_manifest_files) {
+      if (manifest_file.added_snapshot_id != snapshot->snapshot_id ||
+          (!manifest_file.has_added_files() && !manifest_file.has_deleted_files())) {
+        continue;
+      }
+      if (manifest_file.content != ManifestFile::Content::kData) {
+        return NotSupported("Snapshot {} adds delete files, which changelog scans "
+                            "do not support",
+                            snapshot->snapshot_id);
+      }
+      snapshot_manifest_files.push_back(std::move(manifest_file));
+    }
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto manifest_files,
+        FilterManifests(std::move(snapshot_manifest_files), specs));
+    for (auto& manifest_file : manifest_files) {
+      manifests.push_back(ChangelogManifest{
+          .manifest_file = std::move(manifest_file),
+          .change_ordinal = change_ordinal,
+          .commit_snapshot_id = snapshot->snapshot_id,
+      });
+    }
+    ++change_ordinal;
+  }
+
+  ICEBERG_ASSIGN_OR_RAISE(auto schema,
+                          context_.table_metadata->SchemaById(
+                              context_.snapshot->schema_id
+                                  ? context_.snapshot->schema_id
+                                  : context_.table_metadata->current_schema_id));
+  std::unique_ptr<InclusiveMetricsEvaluator> metrics_evaluator;
+  if (context_.filter != nullptr) {
+    ICEBERG_ASSIGN_OR_RAISE(metrics_evaluator,
+                            InclusiveMetricsEvaluator::Make(context_.filter, *schema,
+                                                            context_.case_sensitive));
+  }
+
+  std::vector<PrefetchingFileIO::File> prefetched_manifests;
+  if (context_.io_executor != nullptr) {
+    for (const auto& manifest : manifests) {
+      prefetched_manifests.push_back(PrefetchedManifest(manifest.manifest_file));
+    }
+  }
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto manifest_io,
+      ManifestFileIO(context_, file_io_, std::move(prefetched_manifests)));
+  const auto read_options =
+      DataManifestReadOptions(context_, /*match_deletes=*/false,
+                              /*read_column_sizes=*/false,
+                              {ManifestStatus::kAdded, ManifestStatus::kDeleted});
+  auto plan_manifest = [&](const ChangelogManifest& manifest) {
+    const auto& partition_schema =
+        specs.At(manifest.manifest_file.partition_spec_id).partition_schema;
+    return PlanChangelogTasks(manifest, manifest_io, partition_schema, read_options,
+                              metrics_evaluator.get(), context_.include_column_stats);
+  };
+  return PlanManifestsInOrder(ContextExecutor(context_), manifests,
+                              context_.planning_parallelism, plan_manifest, callback);
+}
+
 }  // namespace iceberg
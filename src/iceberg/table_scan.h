@@ -19,12 +19,23 @@
 
 #pragma once
 
+#include <cstdint>
+#include <functional>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "iceberg/arrow_c_data.h"
+#include "iceberg/file_reader.h"
 #include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/scan_aggregate.h"
+#include "iceberg/scan_explain.h"
+#include "iceberg/spill_options.h"
+#include "iceberg/table_identifier.h"
 #include "iceberg/type_fwd.h"
+#include "iceberg/util/timepoint.h"
 
 namespace iceberg {
 
@@ -43,14 +54,139 @@ class ICEBERG_EXPORT ScanTask {
   virtual int64_t estimated_row_count() const = 0;
 };
 
+/// \brief How the rows returned by FileScanTask::ToArrow are filtered.
+enum class RowFilterMode {
+  /// \brief The filter is only used to skip data that cannot match, so the returned
+  /// batches may contain rows that do not match it.
+  kNone,
+  /// \brief Rows that do not match the filter are removed from the returned batches.
+  kCompact,
+};
+
+/// \brief The order of the batches returned by TableScan::ToArrow.
+enum class ScanOrder {
+  /// \brief Batches are returned in the order of the planned tasks.
+  kOrdered,
+  /// \brief Batches are returned as soon as they are read.
+  kUnordered,
+};
+
+/// \brief The granularity at which a scan samples the rows of the table.
+enum class SampleGranularity {
+  /// \brief Whole data files are sampled while planning.
+  kFile,
+  /// \brief The row groups of the planned Parquet data files are sampled while reading.
+  /// The rows of files in other formats are all read.
+  kRowGroup,
+};
+
+/// \brief A deterministic sample of the rows of a scan, like TABLESAMPLE.
+///
+/// Data files or row groups are sampled by hashing their path and index with the seed,
+/// so that every scan with the same sample reads the same rows. The sampled rows are
+/// about `fraction` of the rows of the table, and aggregates of them are scaled by
+/// scale_factor() to estimate the aggregates of the table.
+struct ICEBERG_EXPORT ScanSample {
+  /// \brief The fraction of the data files or row groups to read, in (0, 1].
+  double fraction = 1.0;
+  /// \brief The seed of the hash.
+  uint32_t seed = 0;
+  /// \brief Whether data files or row groups are sampled.
+  SampleGranularity granularity = SampleGranularity::kFile;
+
+  /// \brief Returns whether the data file at the given path is sampled, always true
+  /// when row groups are sampled.
+  bool ContainsFile(std::string_view path) const;
+
+  /// \brief The factor scaling the aggregates of the sampled rows to estimates of the
+  /// aggregates of all the rows.
+  double scale_factor() const { return 1.0 / fraction; }
+};
+
 /// \brief Task representing a data file and its corresponding delete files.
 class ICEBERG_EXPORT FileScanTask : public ScanTask {
  public:
+  /// \brief Constructs a task that reads the whole data file.
   explicit FileScanTask(std::shared_ptr<DataFile> data_file);
 
+  /// \brief Constructs a task that reads the whole data file and applies delete files.
+  ///
+  /// \param data_file The data file to read.
+  /// \param delete_files The position delete files and deletion vectors that apply to
+  /// the data file.
+  /// \param delete_loader Loads the delete files, shared by the tasks of a scan so that
+  /// every delete file is read once. A loader is created on each read if null.
+  /// \param residual The part of the scan filter that the partition of the data file
+  /// does not guarantee, or null if the scan has no filter.
+  /// \param memory_pool The pool of the buffers of the data file reader, its default
+  /// pool if null.
+  /// \param executor The executor reading batches ahead, the DefaultExecutor() if null.
+  /// \param io_executor The executor reading batches ahead, whose rows are then
+  /// filtered on `executor`, or null to read and filter them on `executor`.
+  /// \param projected_file_size The bytes of the data file that the scan reads, i.e.
+  /// the sizes of its projected columns, or std::nullopt if it reads the whole file.
+  FileScanTask(std::shared_ptr<DataFile> data_file,
+               std::vector<std::shared_ptr<DataFile>> delete_files,
+               std::shared_ptr<DeleteLoader> delete_loader = nullptr,
+               std::shared_ptr<Expression> residual = nullptr,
+               std::shared_ptr<MemoryPool> memory_pool = nullptr,
+               std::shared_ptr<Executor> executor = nullptr,
+               std::shared_ptr<Executor> io_executor = nullptr,
+               std::optional<int64_t> projected_file_size = std::nullopt);
+
+  /// \brief Constructs a task that reads the byte range [start, start + length) of the
+  /// data file.
+  FileScanTask(std::shared_ptr<DataFile> data_file, int64_t start, int64_t length);
+
   /// \brief The data file that should be read by this scan task.
   const std::shared_ptr<DataFile>& data_file() const;
 
+  /// \brief The starting position of this scan range in the data file.
+  int64_t start() const;
+
+  /// \brief The number of bytes of the data file to read from the starting position.
+  int64_t length() const;
+
+  /// \brief The delete files that should be applied to the rows of the data file.
+  const std::vector<std::shared_ptr<DataFile>>& delete_files() const;
+
+  /// \brief The residual of the scan filter for the partition of the data file.
+  ///
+  /// Rows of the data file match the scan filter if and only if they match the
+  /// residual, so it can be passed to ToArrow instead of the scan filter. It is
+  /// AlwaysTrue when the partition guarantees the filter, and null if the scan has no
+  /// filter.
+  const std::shared_ptr<Expression>& residual() const;
+
+  /// \brief The pool of the buffers of the data file reader, or null for its default
+  /// pool.
+  const std::shared_ptr<MemoryPool>& memory_pool() const;
+
+  /// \brief The executor reading batches ahead, or null for the DefaultExecutor().
+  const std::shared_ptr<Executor>& executor() const;
+
+  /// \brief The executor reading batches ahead, or null to read them on executor().
+  const std::shared_ptr<Executor>& io_executor() const;
+
+  /// \brief The bytes of the data file that the scan reads, i.e. the sizes of its
+  /// projected columns, or std::nullopt if it reads the whole file.
+  std::optional<int64_t> projected_file_size() const;
+
+  /// \brief The sample of the row groups of the data file read by the task, or
+  /// std::nullopt if it reads all of them.
+  const std::optional<RowGroupSample>& row_group_sample() const;
+
+  /// \brief Returns a task that reads the byte range [start, start + length) of the
+  /// data file and applies the same delete files.
+  std::shared_ptr<FileScanTask> Slice(int64_t start, int64_t length) const;
+
+  /// \brief Returns a task that only reads the sampled row groups of the data file.
+  std::shared_ptr<FileScanTask> SampleRowGroups(RowGroupSample sample) const;
+
+  /// \brief The bytes read by the task, including its delete files.
+  ///
+  /// With a projected file size, the range of the data file weighs its share of the
+  /// projected bytes rather than its length.
   int64_t size_bytes() const override;
   int32_t files_count() const override;
   int64_t estimated_row_count() const override;
@@ -58,18 +194,170 @@ class ICEBERG_EXPORT FileScanTask : public ScanTask {
   /**
    * \brief Returns a C-ABI compatible ArrowArrayStream to read the data for this task.
    *
+   * Rows deleted by the delete files of the task are not returned.
+   *
    * \param io The FileIO instance for accessing the file data.
    * \param projected_schema The projected schema for reading the data.
-   * \param filter Optional filter expression to apply during reading.
+   * \param filter Optional filter expression to apply during reading. Rows are not
+   * filtered when it is AlwaysTrue, such as the residual() of a partition that
+   * guarantees the scan filter.
+   * \param row_filter_mode How rows that do not match the filter are handled. With
+   * RowFilterMode::kCompact, the filter may only reference projected columns.
+   * \param prefetch_batches The number of batches to read ahead on the executor of the
+   * task while the returned ones are processed, so that reading overlaps with
+   * processing. With an I/O executor, batches are read on it and filtered on the
+   * executor of the task, and up to this number of batches wait at each of the two
+   * steps. Each batch is read when it is requested if 0.
+   * \param metrics Receives the counts of batches, rows and bytes read by the stream
+   * and the time spent decoding and waiting for batches, or null to not collect them.
+   * They remain readable after the stream is released.
    * \return A Result containing an ArrowArrayStream, or an error on failure.
    */
-  Result<ArrowArrayStream> ToArrow(const std::shared_ptr<FileIO>& io,
-                                   const std::shared_ptr<Schema>& projected_schema,
-                                   const std::shared_ptr<Expression>& filter) const;
+  Result<ArrowArrayStream> ToArrow(
+      const std::shared_ptr<FileIO>& io, const std::shared_ptr<Schema>& projected_schema,
+      const std::shared_ptr<Expression>& filter,
+      RowFilterMode row_filter_mode = RowFilterMode::kNone, int32_t prefetch_batches = 0,
+      std::shared_ptr<ReadMetrics> metrics = nullptr) const;
+
+  /// \brief Counts the rows of this task that match a filter, with the delete files of
+  /// the task applied.
+  ///
+  /// When the task reads the whole data file, the filter is null or AlwaysTrue, such as
+  /// the residual() of a partition that guarantees the scan filter, and no equality
+  /// delete file applies, the count is the record count of the data file minus its
+  /// deleted positions, and the file is not read. Otherwise only the columns referenced
+  /// by the filter and the equality delete files are read.
+  ///
+  /// \param io The FileIO instance for accessing the file data.
+  /// \param schema The schema of the rows, to which the filter is bound or bound case
+  /// sensitively.
+  /// \param filter Optional filter of the counted rows.
+  /// \param metrics Receives the counts of the data read, or null to not collect them.
+  /// \return A Result containing the number of rows, or an error on failure.
+  Result<int64_t> CountRows(const std::shared_ptr<FileIO>& io,
+                            const std::shared_ptr<Schema>& schema,
+                            const std::shared_ptr<Expression>& filter,
+                            std::shared_ptr<ReadMetrics> metrics = nullptr) const;
 
  private:
   /// \brief Data file metadata.
   std::shared_ptr<DataFile> data_file_;
+  /// \brief Starting position of the scan range.
+  int64_t start_;
+  /// \brief Length of the scan range.
+  int64_t length_;
+  /// \brief Delete files to apply to the data file.
+  std::vector<std::shared_ptr<DataFile>> delete_files_;
+  /// \brief Loader of the delete files, or null to load them on each read.
+  std::shared_ptr<DeleteLoader> delete_loader_;
+  /// \brief Residual of the scan filter for the partition of the data file.
+  std::shared_ptr<Expression> residual_;
+  /// \brief Pool of the buffers of the reader, or null for its default pool.
+  std::shared_ptr<MemoryPool> memory_pool_;
+  /// \brief Executor reading batches ahead, or null for the default executor.
+  std::shared_ptr<Executor> executor_;
+  /// \brief Executor reading batches ahead, or null to read them on executor_.
+  std::shared_ptr<Executor> io_executor_;
+  /// \brief Bytes of the data file read by the scan, or std::nullopt for all of them.
+  std::optional<int64_t> projected_file_size_;
+  /// \brief Sample of the row groups read, or std::nullopt for all of them.
+  std::optional<RowGroupSample> row_group_sample_;
+};
+
+/// \brief Task combining several file scan tasks to be read by a single worker.
+class ICEBERG_EXPORT CombinedScanTask : public ScanTask {
+ public:
+  explicit CombinedScanTask(std::vector<std::shared_ptr<FileScanTask>> tasks);
+
+  /// \brief The file scan tasks that are combined in this task.
+  const std::vector<std::shared_ptr<FileScanTask>>& tasks() const;
+
+  int64_t size_bytes() const override;
+  int32_t files_count() const override;
+  int64_t estimated_row_count() const override;
+
+ private:
+  /// \brief The combined file scan tasks.
+  std::vector<std::shared_ptr<FileScanTask>> tasks_;
+};
+
+/// \brief Combined task holding all the file scan tasks of a scan whose partitions have
+/// the same values for a set of partition fields.
+class ICEBERG_EXPORT GroupedScanTask : public CombinedScanTask {
+ public:
+  GroupedScanTask(std::vector<Literal> grouping_key,
+                  std::vector<std::shared_ptr<FileScanTask>> tasks);
+
+  /// \brief The values of the grouping partition fields, in the order they were given
+  /// to TableScan::PlanTasksByPartition().
+  const std::vector<Literal>& grouping_key() const;
+
+ private:
+  std::vector<Literal> grouping_key_;
+};
+
+/// \brief Scan tasks ordered by the sort order of the table, returned by
+/// TableScan::PlanOrderedFiles().
+struct ICEBERG_EXPORT OrderedScanPlan {
+  /// \brief The sort order of the table.
+  std::shared_ptr<SortOrder> sort_order;
+  /// \brief The planned tasks, in groups whose rows sort before the rows of the
+  /// following groups. Tasks whose files may hold rows with overlapping sort keys are
+  /// in the same group, ordered by where their rows start.
+  std::vector<std::vector<std::shared_ptr<FileScanTask>>> groups;
+  /// \brief Whether reading the tasks one after the other returns the rows in sort
+  /// order, which holds when every file is written in the sort order and every group
+  /// has a single task.
+  bool globally_ordered = false;
+};
+
+/// \brief A part of the manifests of a scan, returned by TableScan::PlanShards() to
+/// be planned on its own by TableScan::PlanShard(), possibly by another process.
+struct ICEBERG_EXPORT ManifestShard {
+  /// \brief The ID of the scanned snapshot.
+  int64_t snapshot_id = 0;
+  /// \brief The data manifests of the shard, in the order of the manifest list.
+  std::vector<ManifestFile> data_manifests;
+  /// \brief The delete manifests of the scan, in every shard because a data file may
+  /// be deleted by the files of any of them.
+  std::vector<ManifestFile> delete_manifests;
+};
+
+/// \brief How the rows of the data file of a changelog scan task changed.
+enum class ChangelogOperation {
+  /// \brief The rows were inserted by adding the data file.
+  kInsert,
+  /// \brief The rows were deleted by removing the data file.
+  kDelete,
+};
+
+/// \brief Task reading the rows of a data file added or removed by a snapshot.
+class ICEBERG_EXPORT ChangelogScanTask : public FileScanTask {
+ public:
+  /// \brief Constructs a task reporting a change of a whole data file.
+  ///
+  /// \param data_file The data file added or removed by the snapshot.
+  /// \param operation Whether the rows of the data file were inserted or deleted.
+  /// \param change_ordinal The position of the snapshot among the snapshots with
+  /// changes in the scan, from 0 for the oldest.
+  /// \param commit_snapshot_id The ID of the snapshot that added or removed the file.
+  ChangelogScanTask(std::shared_ptr<DataFile> data_file, ChangelogOperation operation,
+                    int32_t change_ordinal, int64_t commit_snapshot_id);
+
+  /// \brief How the rows of the data file changed.
+  ChangelogOperation operation() const;
+
+  /// \brief The position of the snapshot of the change among the snapshots with changes
+  /// in the scan, from 0 for the oldest.
+  int32_t change_ordinal() const;
+
+  /// \brief The ID of the snapshot that added or removed the data file.
+  int64_t commit_snapshot_id() const;
+
+ private:
+  ChangelogOperation operation_;
+  int32_t change_ordinal_;
+  int64_t commit_snapshot_id_;
 };
 
 /// \brief Scan context holding snapshot and scan-specific metadata.
@@ -78,6 +366,9 @@ struct TableScanContext {
   std::shared_ptr<TableMetadata> table_metadata;
   /// \brief Snapshot to scan.
   std::shared_ptr<Snapshot> snapshot;
+  /// \brief Exclusive start snapshot of an incremental scan, which reads the data files
+  /// appended after it up to `snapshot`.
+  std::optional<int64_t> from_snapshot_id;
   /// \brief Projected schema.
   std::shared_ptr<Schema> projected_schema;
   /// \brief Filter expression to apply.
@@ -87,7 +378,49 @@ struct TableScanContext {
   /// \brief Additional options for the scan.
   std::unordered_map<std::string, std::string> options;
   /// \brief Optional limit on the number of rows to scan.
+  ///
+  /// Planning stops once the planned tasks without delete files and whose residual
+  /// is true hold that many rows, and TableScan::ToArrow returns at most that many
+  /// rows.
   std::optional<int64_t> limit;
+  /// \brief Whether the data files of the planned tasks keep their column metrics.
+  ///
+  /// The metrics are used to plan the scan either way.
+  bool include_column_stats = true;
+  /// \brief Bloom filter index of a key column, or null. Data files whose filter rules
+  /// out the keys of the equality and IN predicates of the filter are not planned.
+  std::shared_ptr<const BloomFilterIndex> bloom_filter_index;
+  /// \brief Maximum number of manifests read concurrently while planning.
+  ///
+  /// A value of 1 plans serially on the calling thread.
+  int32_t planning_parallelism = 1;
+  /// \brief Maximum number of bytes of the manifests read ahead of planning on the I/O
+  /// executor, or 0 to read ahead as many manifests as are planned concurrently.
+  int64_t manifest_readahead_bytes = 0;
+  /// \brief Receives the report of each planned scan, or null to not report.
+  std::shared_ptr<MetricsReporter> metrics_reporter;
+  /// \brief Identifier of the scanned table, passed to the metrics reporter.
+  TableIdentifier table_identifier;
+  /// \brief Pool of the buffers of the data and delete file readers of the scan, or
+  /// null for their default pool.
+  std::shared_ptr<MemoryPool> memory_pool;
+  /// \brief Runs the concurrent planning of the scan and the reads ahead of its tasks,
+  /// or null for the DefaultExecutor().
+  std::shared_ptr<Executor> executor;
+  /// \brief Runs the reads of manifests and batches ahead, or null to run them on
+  /// `executor` together with their decoding.
+  std::shared_ptr<Executor> io_executor;
+  /// \brief Cache of the evaluators of the partition specs of the scanned manifests,
+  /// or null to build them for each planning of the scan.
+  std::shared_ptr<SpecEvaluatorCache> spec_evaluator_cache;
+  /// \brief Cache of the planned tasks of repeated scans, or null to plan each scan.
+  std::shared_ptr<ScanPlanCache> plan_cache;
+  /// \brief Sample of the rows of the scan, or std::nullopt to read all of them.
+  std::optional<ScanSample> sample;
+  /// \brief Where and beyond which memory budget the planned tasks of
+  /// TableScan::PlanSpilledTasks() and the equality deletes of the tasks are spilled, or
+  /// std::nullopt to keep them in memory.
+  std::optional<SpillOptions> spill;
 };
 
 /// \brief Builder class for creating TableScan instances.
@@ -104,11 +437,73 @@ class ICEBERG_EXPORT TableScanBuilder {
   /// \return Reference to the builder.
   TableScanBuilder& WithSnapshotId(int64_t snapshot_id);
 
+  /// \brief Sets the time at which to scan the table, which reads the snapshot that was
+  /// current at that time according to the snapshot log of the table.
+  /// \param timestamp The time to scan the table as of.
+  /// \return Reference to the builder.
+  TableScanBuilder& AsOfTime(TimePointMs timestamp);
+
+  /// \brief Sets the branch or tag to scan, which reads the snapshot it references.
+  /// \param name The name of the branch or tag.
+  /// \return Reference to the builder.
+  TableScanBuilder& UseRef(std::string name);
+
+  /// \brief Sets the index of the snapshot log used to resolve AsOfTime().
+  ///
+  /// Table::NewScan() sets the index that the table keeps for its metadata, so that it
+  /// is built once for all the scans of the metadata. An index is built for the scan
+  /// when unset.
+  /// \param index The index of the snapshot log of the scanned metadata.
+  /// \return Reference to the builder.
+  TableScanBuilder& WithSnapshotLogIndex(std::shared_ptr<const SnapshotLogIndex> index);
+
+  /// \brief Sets the cache of the evaluators of the partition specs of the scan.
+  ///
+  /// Table::NewScan() sets the cache that the table keeps for its metadata, so that the
+  /// scans of the table with the same filter reuse the partition schemas, manifest
+  /// evaluators and memoized residuals of each spec.
+  /// \param cache The cache of the evaluators of the specs of the scanned metadata.
+  /// \return Reference to the builder.
+  TableScanBuilder& WithSpecEvaluatorCache(std::shared_ptr<SpecEvaluatorCache> cache);
+
+  /// \brief Sets the cache of the planned tasks of the scan.
+  ///
+  /// A data table scan repeating the snapshot, filter, projection and options of an
+  /// earlier scan with the same cache restores the tasks that the earlier scan planned
+  /// instead of reading the manifests again. Scans with a bloom filter index are not
+  /// cached. The restored tasks use the memory pool and executors of the scan.
+  /// \param cache The cache of the planned tasks, or null to plan each scan.
+  /// \return Reference to the builder.
+  TableScanBuilder& WithPlanCache(std::shared_ptr<ScanPlanCache> cache);
+
+  /// \brief Makes the scan incremental, reading only the data files appended after the
+  /// given snapshot.
+  ///
+  /// The snapshot must be an ancestor of the snapshot to scan.
+  /// \param snapshot_id The ID of the snapshot to start after.
+  /// \return Reference to the builder.
+  TableScanBuilder& FromSnapshotExclusive(int64_t snapshot_id);
+
+  /// \brief Sets the last snapshot read by an incremental scan.
+  ///
+  /// Equivalent to WithSnapshotId(), the current snapshot is read when unset.
+  /// \param snapshot_id The ID of the snapshot to end at, inclusive.
+  /// \return Reference to the builder.
+  TableScanBuilder& ToSnapshot(int64_t snapshot_id);
+
   /// \brief Selects columns to include in the scan.
   /// \param column_names A list of column names. If empty, all columns will be selected.
   /// \return Reference to the builder.
   TableScanBuilder& WithColumnNames(std::vector<std::string> column_names);
 
+  /// \brief Selects fields to include in the scan by field ID.
+  ///
+  /// Nested fields are selected together with their parents, and selecting a struct,
+  /// list or map selects all of its children. Combined with WithColumnNames().
+  /// \param field_ids A list of field IDs. If empty, no field is selected by ID.
+  /// \return Reference to the builder.
+  TableScanBuilder& WithFieldIds(std::vector<int32_t> field_ids);
+
   /// \brief Sets the schema to use for the scan.
   /// \param schema The schema to use.
   /// \return Reference to the builder.
@@ -135,17 +530,133 @@ class ICEBERG_EXPORT TableScanBuilder {
   /// \return Reference to the builder.
   TableScanBuilder& WithLimit(std::optional<int64_t> limit);
 
+  /// \brief Samples a fraction of the rows of the table, like TABLESAMPLE.
+  ///
+  /// Data files are sampled while planning, so the skipped files are not read at all,
+  /// while sampling the row groups of the planned Parquet files gives a more uniform
+  /// sample of tables with few large files. See ScanSample.
+  /// \param fraction The fraction of the data files or row groups to read, in (0, 1].
+  /// \param seed The seed of the hash selecting the sampled files or row groups.
+  /// \param granularity Whether data files or row groups are sampled.
+  /// \return Reference to the builder.
+  TableScanBuilder& WithSample(double fraction, uint32_t seed = 0,
+                               SampleGranularity granularity = SampleGranularity::kFile);
+
+  /// \brief Spills planned tasks and equality deletes to local disk beyond a memory
+  /// budget.
+  ///
+  /// The tasks planned by TableScan::PlanSpilledTasks() are held in a ScanTaskSpill,
+  /// and the delete loader shared by the tasks of the scan keeps the equality deletes
+  /// it loads within the budget. See DeleteLoader.
+  /// \param options The directory of the spill files and the memory budget, which
+  /// must be positive.
+  /// \return Reference to the builder.
+  TableScanBuilder& WithSpill(SpillOptions options);
+
+  /// \brief Sets whether the data files of the planned tasks keep their column metrics.
+  ///
+  /// The column sizes, value counts and bounds of a file usually take most of its
+  /// memory, while reading a task only needs its path, format, size, partition and
+  /// split offsets. A planner holding many tasks can drop the metrics once the scan is
+  /// planned, which is then no longer able to Aggregate().
+  /// \param include Whether to keep the column metrics, true by default.
+  /// \return Reference to the builder.
+  TableScanBuilder& WithColumnStats(bool include);
+
+  /// \brief Sets the bloom filter index of a key column used to plan point lookups.
+  ///
+  /// Data files whose bloom filter shows that they hold none of the keys of the
+  /// equality or IN predicates of the filter on the column are skipped, which the
+  /// column metrics cannot do when the bounds of the keys of most files overlap. The
+  /// index is read with ReadBloomFilterIndex(). Files that it does not cover are
+  /// planned, so an index of an older snapshot can be used.
+  /// \param index The index, or null to plan with the column metrics only.
+  /// \return Reference to the builder.
+  TableScanBuilder& WithBloomFilterIndex(std::shared_ptr<const BloomFilterIndex> index);
+
+  /// \brief Sets the maximum number of manifests to read concurrently during planning.
+  ///
+  /// Planned tasks are returned in manifest list order regardless of the parallelism.
+  /// \param parallelism Number of manifests in flight, must be positive.
+  /// \return Reference to the builder.
+  TableScanBuilder& WithPlanningParallelism(int32_t parallelism);
+
+  /// \brief Sets how far the manifests are read ahead of planning on the I/O executor.
+  ///
+  /// The manifests that remain after pruning them by their partition summaries are read
+  /// ahead in the order they are planned, so storage keeps reading while the manifests
+  /// already read are decoded and evaluated. Reads ahead stop when planning does, e.g.
+  /// once the limit of the scan is reached. Has no effect without an I/O executor.
+  /// \param bytes Total length of the manifests read and not planned yet, or 0 to read
+  /// ahead as many manifests as the planning parallelism. Must not be negative.
+  /// \return Reference to the builder.
+  TableScanBuilder& WithManifestReadahead(int64_t bytes);
+
+  /// \brief Sets the reporter receiving a ScanReport each time files are planned.
+  /// \param reporter The metrics reporter, or null to not report.
+  /// \param table_identifier The identifier of the table, set in the reports.
+  /// \return Reference to the builder.
+  TableScanBuilder& WithMetricsReporter(std::shared_ptr<MetricsReporter> reporter,
+                                        TableIdentifier table_identifier = {});
+
+  /// \brief Sets the pool of the buffers allocated to read the files of the scan.
+  ///
+  /// A TrackingMemoryPool measures the memory used by the scan, and limits it. A
+  /// RecyclingMemoryPool reuses the buffers of the batches released by the consumer for
+  /// the next batches, instead of allocating them again.
+  /// \param memory_pool The memory pool, or null for the default pool of the readers.
+  /// \return Reference to the builder.
+  TableScanBuilder& WithMemoryPool(std::shared_ptr<MemoryPool> memory_pool);
+
+  /// \brief Sets the executor running the concurrent work of the scan.
+  ///
+  /// Manifests are planned concurrently and the batches of its tasks read ahead on the
+  /// executor, so that an engine with its own scheduler owns the threads of the scan.
+  /// \param executor The executor, or null for the DefaultExecutor().
+  /// \return Reference to the builder.
+  TableScanBuilder& WithExecutor(std::shared_ptr<Executor> executor);
+
+  /// \brief Sets the executor reading the files of the scan ahead.
+  ///
+  /// Reads mostly wait on storage while decoding and filtering use the CPU, so they
+  /// are best run on separate executors: a large pool for reads of an object store,
+  /// and one thread per core for the rest. With an I/O executor, manifests are read
+  /// ahead on it while the ones read are decoded on the executor of the scan, and
+  /// the batches of its tasks are read ahead on it and filtered on the executor of
+  /// the scan. The reads ahead are bounded by the planning parallelism and by the
+  /// batches to prefetch, so a slow consumer holds them back.
+  /// \param io_executor The executor, or null to read on the executor of the scan.
+  /// \return Reference to the builder.
+  TableScanBuilder& WithIOExecutor(std::shared_ptr<Executor> io_executor);
+
   /// \brief Builds and returns a TableScan instance.
   /// \return A Result containing the TableScan or an error.
   Result<std::unique_ptr<TableScan>> Build();
 
+  /// \brief Builds a scan of the changes between the start snapshot set with
+  /// FromSnapshotExclusive(), or the oldest snapshot when unset, and the scanned
+  /// snapshot.
+  /// \return A Result containing the IncrementalChangelogScan or an error.
+  Result<std::unique_ptr<IncrementalChangelogScan>> BuildChangelog();
+
  private:
+  /// \brief Resolves the snapshot and projected schema of the scan context.
+  Status ResolveContext();
+
   /// \brief the file I/O instance for reading manifests and data files.
   std::shared_ptr<FileIO> file_io_;
   /// \brief column names to project in the scan.
   std::vector<std::string> column_names_;
+  /// \brief field IDs to project in the scan.
+  std::vector<int32_t> field_ids_;
   /// \brief snapshot ID to scan, if specified.
   std::optional<int64_t> snapshot_id_;
+  /// \brief time to scan the table as of, if specified.
+  std::optional<TimePointMs> as_of_time_;
+  /// \brief branch or tag to scan, if specified.
+  std::optional<std::string> ref_;
+  /// \brief index of the snapshot log resolving the time to scan as of.
+  std::shared_ptr<const SnapshotLogIndex> snapshot_log_index_;
   /// \brief Context for the scan, including snapshot, schema, and filter.
   TableScanContext context_;
 };
@@ -172,15 +683,187 @@ class ICEBERG_EXPORT TableScan {
   /// \return A reference to the TableScanContext.
   const TableScanContext& context() const;
 
+  /// \brief Returns the factor scaling the aggregates of the rows read by the scan to
+  /// estimates of the aggregates of the table, 1 for a scan that is not sampled.
+  double sample_scale_factor() const;
+
   /// \brief Returns the file I/O instance used for reading manifests and data files.
   /// \return A shared pointer to the FileIO instance.
   const std::shared_ptr<FileIO>& io() const;
 
+  /// \brief Callback receiving the file scan tasks as they are planned.
+  ///
+  /// Returning an error stops planning, and the error is returned by PlanFiles.
+  using FileScanTaskCallback = std::function<Status(std::shared_ptr<FileScanTask>)>;
+
   /// \brief Plans the scan tasks by resolving manifests and data files.
   /// \return A Result containing scan tasks or an error.
-  virtual Result<std::vector<std::shared_ptr<FileScanTask>>> PlanFiles() const = 0;
+  virtual Result<std::vector<std::shared_ptr<FileScanTask>>> PlanFiles() const;
+
+  /// \brief Plans the scan tasks without blocking the awaiting coroutine.
+  ///
+  /// By default PlanFiles() runs on the executor and the coroutine is resumed on it.
+  /// \param executor The executor planning the scan, the executor of the scan context
+  /// if null.
+  virtual Task<Result<std::vector<std::shared_ptr<FileScanTask>>>> PlanFilesAsync(
+      std::shared_ptr<Executor> executor = nullptr) const;
+
+  /// \brief Plans the scan tasks, passing each task to a callback as soon as its
+  /// manifest has been read instead of collecting all of them.
+  ///
+  /// Tasks are passed in the same order as returned by PlanFiles(), from the calling
+  /// thread. Only a bounded number of manifests are read ahead of the callback, so
+  /// memory use does not grow with the size of the table.
+  /// \param callback Receives each task, its errors stop planning.
+  /// \return An error if planning failed or the callback returned an error.
+  virtual Status PlanFiles(const FileScanTaskCallback& callback) const = 0;
+
+  /// \brief Plans balanced scan tasks from the tasks returned by PlanFiles().
+  ///
+  /// Files larger than the target split size (read.split.target-size) are split at
+  /// their split offsets, or into ranges of the target split size when they have
+  /// none. The resulting tasks are then bin-packed into combined tasks of about the
+  /// target split size, counting each task as at least read.split.open-file-cost
+  /// bytes and keeping at most read.split.planning-lookback bins open. Scan options
+  /// take precedence over table properties.
+  ///
+  /// With read.split.projected-size.enabled, data files weigh the sizes of the columns
+  /// that the scan projects or filters on, from their column_sizes metrics, instead of
+  /// their file size, so that narrow scans of wide tables are neither over-split nor
+  /// under-packed. Files without these metrics weigh their file size.
+  /// \return A Result containing combined scan tasks or an error.
+  virtual Result<std::vector<std::shared_ptr<CombinedScanTask>>> PlanTasks() const;
+
+  /// \brief Plans the tasks of PlanTasks() into a ScanTaskSpill, which holds them
+  /// within the memory budget of the spill options of the scan.
+  ///
+  /// Tasks are packed while the files are planned, and only the open bins of the
+  /// packing and the tasks below the budget are held in memory, so that scans planning
+  /// millions of tasks do not hold all of them at once.
+  /// \return A Result containing the spilled tasks, or an error if planning failed or
+  /// the scan has no spill options.
+  Result<std::unique_ptr<ScanTaskSpill>> PlanSpilledTasks() const;
+
+  /// \brief Plans one task per value of a set of partition fields, such as a bucket
+  /// field, so that tables bucketed alike can be joined bucket by bucket.
+  ///
+  /// The fields are named in the default partition spec of the table. A file written
+  /// with another spec is grouped by the fields of its spec with the same source
+  /// column and transform, and planning fails if its spec has none, so every file of a
+  /// key is in the task of that key. Files are split like in PlanTasks(), and the
+  /// tasks are ordered by key with nulls first.
+  /// \param partition_fields The names of the grouping fields in the default spec.
+  /// \return A Result containing the grouped tasks or an error.
+  Result<std::vector<std::shared_ptr<GroupedScanTask>>> PlanTasksByPartition(
+      const std::vector<std::string>& partition_fields) const;
+
+  /// \brief Divides the manifests of the scan into shards that are planned on their
+  /// own, so that their manifests can be read on several processes.
+  ///
+  /// The manifests are pruned like when planning the scan, by their live entries and
+  /// their partition summaries. Each data manifest is weighed by its share of the
+  /// total length plus its share of the total entries of the data manifests, and the
+  /// heaviest manifests are assigned first, each to the lightest shard. There are
+  /// fewer shards than requested when there are fewer data manifests.
+  /// \param num_shards The number of shards, at least 1.
+  /// \return A Result containing the shards, or NotSupported for scans that cannot be
+  /// sharded, or InvalidArgument if the scan has a limit.
+  virtual Result<std::vector<ManifestShard>> PlanShards(int32_t num_shards) const;
+
+  /// \brief Plans the tasks of the data manifests of a shard, like PlanFiles() plans
+  /// the tasks of all the manifests.
+  ///
+  /// The scan must be configured like the scan that made the shard, with the same
+  /// snapshot, filter and options. The tasks of all the shards are the tasks of the
+  /// scan. Planning a shard does not report to the metrics reporter of the scan.
+  /// \param shard A shard returned by PlanShards().
+  /// \return A Result containing the tasks of the shard, or InvalidArgument if the
+  /// shard is of another snapshot.
+  virtual Result<std::vector<std::shared_ptr<FileScanTask>>> PlanShard(
+      const ManifestShard& shard) const;
+
+  /// \brief Splits and packs the tasks planned from the shards of the scan into
+  /// balanced tasks, like PlanTasks() does with the tasks of PlanFiles().
+  /// \param shard_tasks The tasks planned from each shard, in the order of the shards.
+  /// \return A Result containing the combined scan tasks or an error.
+  Result<std::vector<std::shared_ptr<CombinedScanTask>>> MergeShardTasks(
+      std::vector<std::vector<std::shared_ptr<FileScanTask>>> shard_tasks) const;
+
+  /// \brief Reads the rows of the scan with a number of workers into a single stream.
+  ///
+  /// The tasks returned by PlanTasks() are read like FileScanTask::ToArrow with their
+  /// residual. The file scan tasks of each combined task are queued to one worker,
+  /// and a worker whose queue is empty steals the tasks of the others. Workers run on
+  /// the executor of the scan and stop while two batches per worker wait for the
+  /// consumer. With a limit on the scan, the stream ends once that many rows have
+  /// been returned, the tasks that have not started are never opened and the files
+  /// of the others are closed. With TableProperties::kValidateUtf8Enabled set in the
+  /// scan options or the table properties, the workers check that the strings of each
+  /// batch are valid UTF-8, and the stream fails at the first invalid one.
+  /// \param parallelism The number of workers, at least 1.
+  /// \param order Whether the batches follow the order of the planned tasks.
+  /// \param row_filter_mode How rows that do not match the residuals are handled.
+  /// \return A Result containing an ArrowArrayStream, or an error on failure.
+  Result<ArrowArrayStream> ToArrow(
+      int32_t parallelism, ScanOrder order = ScanOrder::kOrdered,
+      RowFilterMode row_filter_mode = RowFilterMode::kNone) const;
+
+  /// \brief Plans the scan tasks in the default sort order of the table.
+  ///
+  /// Tasks are ordered by the lower bound of the leading sort column of their data
+  /// file, or by its upper bound when the column is descending, and a file with nulls
+  /// in the column starts or ends with them by the null order. Consecutive tasks whose
+  /// ranges of the column overlap are grouped together. Only an identity leading sort
+  /// field on an integer, decimal, temporal, string or binary column orders the
+  /// tasks; otherwise they form a single group in planning order.
+  /// \return A Result containing the ordered tasks, or InvalidArgument if the table is
+  /// unsorted, or if the scan has a limit or drops the column stats.
+  Result<OrderedScanPlan> PlanOrderedFiles() const;
+
+  /// \brief Reads the rows of the scan in the default sort order of the table.
+  ///
+  /// The groups returned by PlanOrderedFiles() are read one after the other like
+  /// ToArrow with the given number of workers. The task of a group with a single task
+  /// is read as is, and the tasks of a larger group are merged row by row by their
+  /// sort keys, holding one batch of each task at a time.
+  /// \param parallelism The number of workers, at least 1.
+  /// \param row_filter_mode How rows that do not match the residuals are handled.
+  /// \return A Result containing an ArrowArrayStream, or NotSupported if a planned
+  /// file is not written in the sort order, or InvalidArgument if a source column of
+  /// the sort order is not projected.
+  Result<ArrowArrayStream> ToSortedArrow(
+      int32_t parallelism, RowFilterMode row_filter_mode = RowFilterMode::kNone) const;
+
+  /// \brief Computes aggregates of the rows of the scan from the metrics of the
+  /// planned data files, without reading them.
+  ///
+  /// The values are exact when no planned file has delete files or a residual filter,
+  /// such as when the filter only references identity partition columns; otherwise
+  /// they bound the aggregates, see AggregateValue.
+  /// \param aggregates The aggregates to compute, on columns of the scanned schema.
+  /// \return A Result containing the values of the aggregates in their order, or an
+  /// error if the scan has a limit.
+  Result<std::vector<AggregateValue>> Aggregate(
+      const std::vector<ScanAggregate>& aggregates) const;
+
+  /// \brief Plans the scan and returns a profile of its planning instead of its tasks.
+  ///
+  /// The profile tells which manifests were read or skipped and why, how many files
+  /// were skipped by their partition and by their column metrics, the delete files
+  /// matched to the planned files, the residual filter of each planned partition and
+  /// the time spent in each stage of planning. Explaining does not report to the
+  /// metrics reporter of the scan.
+  /// \return A Result containing the profile, or NotSupported for scans that cannot
+  /// explain their planning.
+  virtual Result<ScanExplain> Explain() const;
 
  protected:
+  /// \brief Splits and bin-packs the planned files like PlanTasks(), passing each
+  /// combined task to a callback as soon as its bin is closed.
+  Status PackPlannedTasks(
+      int64_t split_size, int32_t lookback, int64_t open_file_cost,
+      const std::function<Status(std::shared_ptr<CombinedScanTask>)>& callback) const;
+
   /// \brief context for the scan, including snapshot, schema, and filter.
   const TableScanContext context_;
   /// \brief File I/O instance for reading manifests and data files.
@@ -193,9 +876,92 @@ class ICEBERG_EXPORT DataTableScan : public TableScan {
   /// \brief Constructs a DataScan with the given context and file I/O.
   DataTableScan(TableScanContext context, std::shared_ptr<FileIO> file_io);
 
-  /// \brief Plans the scan tasks by resolving manifests and data files.
-  /// \return A Result containing scan tasks or an error.
-  Result<std::vector<std::shared_ptr<FileScanTask>>> PlanFiles() const override;
+  using TableScan::PlanFiles;
+
+  Status PlanFiles(const FileScanTaskCallback& callback) const override;
+
+  Result<ScanExplain> Explain() const override;
+
+  Result<std::vector<ManifestShard>> PlanShards(int32_t num_shards) const override;
+
+  Result<std::vector<std::shared_ptr<FileScanTask>>> PlanShard(
+      const ManifestShard& shard) const override;
+
+ private:
+  /// \brief Plans the scan tasks, collecting the metrics of planning and, when
+  /// `explain` is not null, the profile of planning. Only the manifests of `shard` are
+  /// planned when it is not null.
+  Status PlanFiles(const FileScanTaskCallback& callback, ScanMetrics& metrics,
+                   ScanExplain* explain = nullptr,
+                   const ManifestShard* shard = nullptr) const;
+
+  /// \brief Plans the scan tasks like PlanFiles(), restoring them from the plan cache
+  /// of the scan when it has them, and caching them otherwise.
+  Status PlanCachedFiles(const FileScanTaskCallback& callback,
+                         ScanMetrics& metrics) const;
+};
+
+/// \brief A scan that reads the data files appended between two snapshots.
+///
+/// Only the snapshots written by append operations after the start snapshot, up to and
+/// including the scanned snapshot, contribute files, and of their manifests only the
+/// entries they added are read. Files added by other operations, such as overwrites or
+/// rewrites, are skipped, and delete files are not applied.
+class ICEBERG_EXPORT IncrementalAppendScan : public TableScan {
+ public:
+  /// \brief Constructs an IncrementalAppendScan with the given context and file I/O.
+  ///
+  /// The context must have a from_snapshot_id that is an ancestor of its snapshot.
+  IncrementalAppendScan(TableScanContext context, std::shared_ptr<FileIO> file_io);
+
+  using TableScan::PlanFiles;
+
+  Status PlanFiles(const FileScanTaskCallback& callback) const override;
+};
+
+/// \brief A scan of the rows inserted and deleted by the snapshots between two
+/// snapshots.
+///
+/// Changes are reported per data file, as written by copy-on-write tables: the rows of
+/// a data file added by a snapshot are inserted and the rows of a data file removed by
+/// a snapshot are deleted. Snapshots that replace files without changing the data of
+/// the table report no changes, and delete files are not supported.
+class ICEBERG_EXPORT IncrementalChangelogScan {
+ public:
+  /// \brief Constructs an IncrementalChangelogScan with the given context and file I/O.
+  ///
+  /// The from_snapshot_id of the context, if set, must be an ancestor of its snapshot.
+  IncrementalChangelogScan(TableScanContext context, std::shared_ptr<FileIO> file_io);
+
+  /// \brief Returns the scan context.
+  const TableScanContext& context() const;
+
+  /// \brief Returns the file I/O instance used for reading manifests and data files.
+  const std::shared_ptr<FileIO>& io() const;
+
+  /// \brief Callback receiving the changelog scan tasks as they are planned.
+  ///
+  /// Returning an error stops planning, and the error is returned by PlanFiles.
+  using ChangelogScanTaskCallback =
+      std::function<Status(std::shared_ptr<ChangelogScanTask>)>;
+
+  /// \brief Plans the changelog tasks, ordered by change ordinal.
+  /// \return A Result containing the changelog tasks or an error.
+  Result<std::vector<std::shared_ptr<ChangelogScanTask>>> PlanFiles() const;
+
+  /// \brief Plans the changelog tasks, passing each task to a callback in the order
+  /// returned by PlanFiles().
+  ///
+  /// Up to planning_parallelism manifests are read concurrently.
+  /// \param callback Receives each task, its errors stop planning.
+  /// \return An error if planning failed or the callback returned an error.
+  Status PlanFiles(const ChangelogScanTaskCallback& callback) const;
+
+ private:
+  /// \brief context for the scan, including snapshot, schema, and filter.
+  const TableScanContext context_;
+  /// \brief File I/O instance for reading manifests and data files.
+  std::shared_ptr<FileIO> file_io_;
 };
 
 }  // namespace iceberg
@@ -0,0 +1,163 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/table_stats.h"
+
+#include <charconv>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_entry_batch.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/manifest_reader.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief Parses a total of a snapshot summary, or returns std::nullopt if it is missing
+/// or invalid.
+std::optional<int64_t> ParseTotal(
+    const std::unordered_map<std::string, std::string>& summary, const std::string& key) {
+  auto it = summary.find(key);
+  if (it == summary.end()) {
+    return std::nullopt;
+  }
+  int64_t value = 0;
+  const auto& str = it->second;
+  if (auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+      ec != std::errc{} || ptr != str.data() + str.size() || value < 0) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+/// \brief Reads the counts from the totals of a snapshot summary, or returns
+/// std::nullopt if a required total is missing.
+std::optional<TableStats> StatsFromSummary(const Snapshot& snapshot,
+                                           bool require_file_size) {
+  auto records = ParseTotal(snapshot.summary, SnapshotSummaryFields::kTotalRecords);
+  auto data_files = ParseTotal(snapshot.summary, SnapshotSummaryFields::kTotalDataFiles);
+  auto delete_files =
+      ParseTotal(snapshot.summary, SnapshotSummaryFields::kTotalDeleteFiles);
+  auto file_size = ParseTotal(snapshot.summary, SnapshotSummaryFields::kTotalFileSize);
+  if (!records.has_value() || !data_files.has_value() || !delete_files.has_value() ||
+      (require_file_size && !file_size.has_value())) {
+    return std::nullopt;
+  }
+  return TableStats{.snapshot_id = snapshot.snapshot_id,
+                    .record_count = *records,
+                    .data_file_count = *data_files,
+                    .delete_file_count = *delete_files,
+                    .total_file_size = file_size,
+                    .source = TableStatsSource::kSummary};
+}
+
+/// \brief Sums the file and row counts of a manifest list, or returns std::nullopt if
+/// a manifest does not have them.
+std::optional<TableStats> StatsFromManifestList(
+    int64_t snapshot_id, const std::vector<ManifestFile>& manifests) {
+  TableStats stats{.snapshot_id = snapshot_id,
+                   .source = TableStatsSource::kManifestList};
+  for (const auto& manifest : manifests) {
+    if (!manifest.added_files_count.has_value() ||
+        !manifest.existing_files_count.has_value()) {
+      return std::nullopt;
+    }
+    const int64_t files = static_cast<int64_t>(*manifest.added_files_count) +
+                          *manifest.existing_files_count;
+    if (manifest.content == ManifestFile::Content::kDeletes) {
+      stats.delete_file_count += files;
+      continue;
+    }
+    if (!manifest.added_rows_count.has_value() ||
+        !manifest.existing_rows_count.has_value()) {
+      return std::nullopt;
+    }
+    stats.data_file_count += files;
+    stats.record_count += *manifest.added_rows_count + *manifest.existing_rows_count;
+  }
+  return stats;
+}
+
+/// \brief Counts the live entries of the manifests of a snapshot.
+Result<TableStats> StatsFromManifests(int64_t snapshot_id,
+                                      const std::vector<ManifestFile>& manifests,
+                                      const std::shared_ptr<FileIO>& io) {
+  TableStats stats{.snapshot_id = snapshot_id, .source = TableStatsSource::kManifests};
+  int64_t total_file_size = 0;
+  for (const auto& manifest : manifests) {
+    // The counted fields are required, so only the paths are read among the optional
+    // fields, which skips the column metrics.
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto reader, ManifestReader::Make(manifest, io, /*partition_schema=*/nullptr,
+                                          {.columns = {std::string(
+                                               DataFile::kFilePath.name())}}));
+    ICEBERG_RETURN_UNEXPECTED(
+        reader->VisitBatches([&](const ManifestEntryBatch& batch) -> Status {
+          for (int64_t row = 0; row < batch.size(); ++row) {
+            if (batch.status(row) == ManifestStatus::kDeleted) {
+              continue;
+            }
+            total_file_size += batch.file_size_in_bytes(row);
+            if (batch.content(row) == DataFile::Content::kData) {
+              ++stats.data_file_count;
+              stats.record_count += batch.record_count(row);
+            } else {
+              ++stats.delete_file_count;
+            }
+          }
+          return {};
+        }));
+  }
+  stats.total_file_size = total_file_size;
+  return stats;
+}
+
+}  // namespace
+
+Result<TableStats> ComputeTableStats(const TableMetadata& metadata,
+                                     const std::shared_ptr<FileIO>& io,
+                                     const TableStatsOptions& options) {
+  const int64_t snapshot_id = options.snapshot_id.value_or(metadata.current_snapshot_id);
+  if (snapshot_id == Snapshot::kInvalidSnapshotId) {
+    return TableStats{.total_file_size = 0};
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto snapshot, metadata.SnapshotById(snapshot_id));
+  if (auto stats = StatsFromSummary(*snapshot, options.require_file_size)) {
+    return std::move(*stats);
+  }
+
+  ICEBERG_ASSIGN_OR_RAISE(auto list_reader,
+                          ManifestListReader::Make(snapshot->manifest_list, io));
+  ICEBERG_ASSIGN_OR_RAISE(auto manifests, list_reader->Files());
+  if (!options.require_file_size) {
+    if (auto stats = StatsFromManifestList(snapshot_id, manifests)) {
+      return std::move(*stats);
+    }
+  }
+  return StatsFromManifests(snapshot_id, manifests, io);
+}
+
+}  // namespace iceberg
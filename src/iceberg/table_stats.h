@@ -0,0 +1,91 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/table_stats.h
+/// Counts of the rows, files and bytes of a table, answered from snapshot summaries
+/// when possible.
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief Where the counts of TableStats were read from, from the cheapest to the most
+/// expensive.
+enum class TableStatsSource {
+  /// The totals of the snapshot summary, without any file read.
+  kSummary,
+  /// The file and row counts of the manifest list, without reading the manifests.
+  kManifestList,
+  /// The entries of the manifests.
+  kManifests,
+};
+
+/// \brief Counts of the live files and rows of a snapshot of a table.
+struct ICEBERG_EXPORT TableStats {
+  /// The id of the snapshot, or std::nullopt for a table without snapshots
+  std::optional<int64_t> snapshot_id;
+  /// The number of records in the data files, without applying the deletes
+  int64_t record_count = 0;
+  /// The number of data files
+  int64_t data_file_count = 0;
+  /// The number of delete files, including deletion vectors
+  int64_t delete_file_count = 0;
+  /// The total size of the data and delete files in bytes, unset when the counts were
+  /// read from the manifest list, which does not have file sizes
+  std::optional<int64_t> total_file_size;
+  /// Where the counts were read from
+  TableStatsSource source = TableStatsSource::kSummary;
+
+  friend bool operator==(const TableStats& lhs, const TableStats& rhs) = default;
+};
+
+/// \brief Options of ComputeTableStats().
+struct ICEBERG_EXPORT TableStatsOptions {
+  /// The snapshot to count, the current snapshot when unset
+  std::optional<int64_t> snapshot_id;
+  /// Whether the total file size is required, so that the manifests are read when the
+  /// summary does not have it instead of stopping at the manifest list
+  bool require_file_size = false;
+};
+
+/// \brief Counts the live files and rows of a snapshot of a table.
+///
+/// The counts are read from the totals of the snapshot summary when it has all of
+/// them. Otherwise they are summed from the file and row counts of the manifest list,
+/// and only when the manifest list does not have them either, or the file size is
+/// required, from the entries of the manifests.
+///
+/// \param metadata The metadata of the table
+/// \param io The FileIO reading the manifest list and the manifests
+/// \param options The snapshot to count and the required counts
+/// \return A Result containing the counts, or an error if the snapshot does not exist
+/// or its files cannot be read.
+ICEBERG_EXPORT Result<TableStats> ComputeTableStats(const TableMetadata& metadata,
+                                                   const std::shared_ptr<FileIO>& io,
+                                                   const TableStatsOptions& options = {});
+
+}  // namespace iceberg
@@ -0,0 +1,335 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/table_transaction.h"
+
+#include <format>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
+
+#include "iceberg/catalog.h"
+#include "iceberg/expire_snapshots.h"
+#include "iceberg/fast_append.h"
+#include "iceberg/file_io.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/manifest_reader.h"
+#include "iceberg/row_delta.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/table_requirement.h"
+#include "iceberg/table_requirements.h"
+#include "iceberg/table_update.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+bool SameTable(const TableIdentifier& lhs, const TableIdentifier& rhs) {
+  return lhs.name == rhs.name && lhs.ns.levels == rhs.ns.levels;
+}
+
+}  // namespace
+
+/// \brief A catalog that stages the commits to the table of a transaction in memory,
+/// and passes everything else through to the catalog of the table.
+class TableTransaction::StagingCatalog
+    : public Catalog,
+      public std::enable_shared_from_this<StagingCatalog> {
+ public:
+  StagingCatalog(std::shared_ptr<Catalog> catalog, TableIdentifier identifier,
+                 std::shared_ptr<TableMetadata> base, std::string base_location,
+                 std::shared_ptr<FileIO> io)
+      : catalog_(std::move(catalog)),
+        identifier_(std::move(identifier)),
+        metadata_(std::move(base)),
+        base_location_(std::move(base_location)),
+        io_(std::move(io)) {}
+
+  /// \brief Returns the staged updates, in the order they were committed.
+  const std::vector<std::unique_ptr<TableUpdate>>& updates() const { return updates_; }
+
+  /// \brief Returns the staged table with its current metadata.
+  std::unique_ptr<Table> StagedTable() {
+    std::lock_guard lock(mutex_);
+    return MakeTable();
+  }
+
+  std::string_view name() const override { return catalog_->name(); }
+
+  Status CreateNamespace(
+      const Namespace& ns,
+      const std::unordered_map<std::string, std::string>& properties) override {
+    return catalog_->CreateNamespace(ns, properties);
+  }
+
+  Result<std::vector<Namespace>> ListNamespaces(const Namespace& ns) const override {
+    return catalog_->ListNamespaces(ns);
+  }
+
+  Result<std::unordered_map<std::string, std::string>> GetNamespaceProperties(
+      const Namespace& ns) const override {
+    return catalog_->GetNamespaceProperties(ns);
+  }
+
+  Status DropNamespace(const Namespace& ns) override {
+    return catalog_->DropNamespace(ns);
+  }
+
+  Result<bool> NamespaceExists(const Namespace& ns) const override {
+    return catalog_->NamespaceExists(ns);
+  }
+
+  Status UpdateNamespaceProperties(
+      const Namespace& ns, const std::unordered_map<std::string, std::string>& updates,
+      const std::unordered_set<std::string>& removals) override {
+    return catalog_->UpdateNamespaceProperties(ns, updates, removals);
+  }
+
+  Result<std::vector<TableIdentifier>> ListTables(const Namespace& ns) const override {
+    return catalog_->ListTables(ns);
+  }
+
+  Result<std::unique_ptr<Table>> CreateTable(
+      const TableIdentifier& identifier, const Schema& schema, const PartitionSpec& spec,
+      const std::string& location,
+      const std::unordered_map<std::string, std::string>& properties) override {
+    return catalog_->CreateTable(identifier, schema, spec, location, properties);
+  }
+
+  Result<std::unique_ptr<Table>> UpdateTable(
+      const TableIdentifier& identifier,
+      const std::vector<std::unique_ptr<TableRequirement>>& requirements,
+      const std::vector<std::unique_ptr<TableUpdate>>& updates) override {
+    if (!SameTable(identifier, identifier_)) {
+      return catalog_->UpdateTable(identifier, requirements, updates);
+    }
+
+    // Commits of concurrent operations of the transaction are serialized, and validated
+    // against the staged metadata like a catalog validates them against its own.
+    std::lock_guard lock(mutex_);
+    for (const auto& requirement : requirements) {
+      ICEBERG_RETURN_UNEXPECTED(requirement->Validate(metadata_.get()));
+    }
+    auto builder = TableMetadataBuilder::BuildFrom(metadata_.get());
+    for (const auto& update : updates) {
+      update->ApplyTo(*builder);
+    }
+    ICEBERG_ASSIGN_OR_RAISE(metadata_, builder->Build());
+    for (const auto& update : updates) {
+      updates_.push_back(update->Clone());
+    }
+    ++version_;
+    return MakeTable();
+  }
+
+  Result<std::shared_ptr<Transaction>> StageCreateTable(
+      const TableIdentifier& identifier, const Schema& schema, const PartitionSpec& spec,
+      const std::string& location,
+      const std::unordered_map<std::string, std::string>& properties) override {
+    return catalog_->StageCreateTable(identifier, schema, spec, location, properties);
+  }
+
+  Result<bool> TableExists(const TableIdentifier& identifier) const override {
+    return catalog_->TableExists(identifier);
+  }
+
+  Status DropTable(const TableIdentifier& identifier, bool purge) override {
+    if (SameTable(identifier, identifier_)) {
+      return NotSupported("Cannot drop table {} in its transaction", identifier.name);
+    }
+    return catalog_->DropTable(identifier, purge);
+  }
+
+  Result<std::unique_ptr<Table>> LoadTable(const TableIdentifier& identifier) override {
+    if (!SameTable(identifier, identifier_)) {
+      return catalog_->LoadTable(identifier);
+    }
+    return StagedTable();
+  }
+
+  Result<std::shared_ptr<Table>> RegisterTable(
+      const TableIdentifier& identifier,
+      const std::string& metadata_file_location) override {
+    return catalog_->RegisterTable(identifier, metadata_file_location);
+  }
+
+  std::unique_ptr<TableBuilder> BuildTable(const TableIdentifier& identifier,
+                                           const Schema& schema) const override {
+    return catalog_->BuildTable(identifier, schema);
+  }
+
+ private:
+  std::unique_ptr<Table> MakeTable() {
+    // The staged metadata is not written to a file, its location only has to change
+    // with each commit for Table::Refresh to pick the new metadata up.
+    auto location = version_ == 0 ? base_location_
+                                  : std::format("{}#staged-{}", base_location_, version_);
+    return std::make_unique<Table>(identifier_, metadata_, std::move(location), io_,
+                                   shared_from_this());
+  }
+
+  const std::shared_ptr<Catalog> catalog_;
+  const TableIdentifier identifier_;
+  std::mutex mutex_;
+  std::shared_ptr<TableMetadata> metadata_;
+  const std::string base_location_;
+  const std::shared_ptr<FileIO> io_;
+  std::vector<std::unique_ptr<TableUpdate>> updates_;
+  int64_t version_ = 0;
+};
+
+Result<std::shared_ptr<TableTransaction>> TableTransaction::Make(
+    std::shared_ptr<Table> table) {
+  if (table->catalog() == nullptr) {
+    return NotSupported("Cannot commit to table {} without a catalog",
+                        table->name().name);
+  }
+  auto catalog =
+      std::make_shared<StagingCatalog>(table->catalog(), table->name(), table->metadata(),
+                                       table->metadata_location(), table->io());
+  std::shared_ptr<Table> staged = catalog->StagedTable();
+  staged->set_metrics_reporter(table->metrics_reporter());
+  return std::shared_ptr<TableTransaction>(
+      new TableTransaction(std::move(table), std::move(catalog), std::move(staged)));
+}
+
+TableTransaction::TableTransaction(std::shared_ptr<Table> base_table,
+                                   std::shared_ptr<StagingCatalog> catalog,
+                                   std::shared_ptr<Table> table)
+    : base_table_(std::move(base_table)),
+      catalog_(std::move(catalog)),
+      table_(std::move(table)) {}
+
+TableTransaction::~TableTransaction() = default;
+
+std::shared_ptr<AppendFiles> TableTransaction::NewAppend() {
+  return std::make_shared<FastAppend>(table_);
+}
+
+std::shared_ptr<RowDelta> TableTransaction::NewRowDelta() {
+  return std::make_shared<RowDelta>(table_);
+}
+
+std::shared_ptr<ExpireSnapshots> TableTransaction::NewExpireSnapshots() {
+  // The files must not be deleted before the transaction is committed.
+  auto expire = std::make_shared<ExpireSnapshots>(table_);
+  expire->CleanExpiredFiles(false);
+  return expire;
+}
+
+Status TableTransaction::UpdateProperties(
+    const std::unordered_map<std::string, std::string>& updates,
+    const std::vector<std::string>& removals) {
+  std::vector<std::unique_ptr<TableUpdate>> staged;
+  if (!updates.empty()) {
+    staged.push_back(std::make_unique<table::SetProperties>(updates));
+  }
+  if (!removals.empty()) {
+    staged.push_back(std::make_unique<table::RemoveProperties>(removals));
+  }
+  return Stage(std::move(staged));
+}
+
+Status TableTransaction::SetCurrentSchema(std::shared_ptr<Schema> schema) {
+  if (schema == nullptr) {
+    return InvalidArgument("Cannot set a null schema");
+  }
+  std::vector<std::unique_ptr<TableUpdate>> staged;
+  staged.push_back(std::make_unique<table::AddSchema>(
+      std::move(schema), table_->metadata()->last_column_id));
+  staged.push_back(
+      std::make_unique<table::SetCurrentSchema>(TableMetadataBuilder::kLastAdded));
+  return Stage(std::move(staged));
+}
+
+Status TableTransaction::Stage(std::vector<std::unique_ptr<TableUpdate>> updates) {
+  if (committed_) {
+    return Invalid("Transaction on table {} is already committed",
+                   base_table_->name().name);
+  }
+  if (updates.empty()) {
+    return {};
+  }
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto requirements, TableRequirements::ForUpdateTable(*table_->metadata(), updates));
+  ICEBERG_RETURN_UNEXPECTED(catalog_->UpdateTable(table_->name(), requirements, updates));
+  return table_->Refresh();
+}
+
+Status TableTransaction::CommitTransaction() {
+  if (committed_) {
+    return Invalid("Transaction on table {} is already committed",
+                   base_table_->name().name);
+  }
+  const auto& updates = catalog_->updates();
+  if (updates.empty()) {
+    committed_ = true;
+    return {};
+  }
+
+  ICEBERG_ASSIGN_OR_RAISE(
+      auto requirements,
+      TableRequirements::ForUpdateTable(*base_table_->metadata(), updates));
+  auto committed =
+      base_table_->catalog()->UpdateTable(base_table_->name(), requirements, updates);
+  if (!committed.has_value()) {
+    // The snapshots may have been committed, so none of their files can be deleted.
+    if (committed.error().kind != ErrorKind::kCommitStateUnknown) {
+      CleanUncommitted();
+    }
+    return std::unexpected(std::move(committed.error()));
+  }
+
+  committed_ = true;
+  // The changes are committed, a failed refresh only leaves the table stale.
+  std::ignore = base_table_->Refresh();
+  return {};
+}
+
+void TableTransaction::CleanUncommitted() const {
+  const auto& io = table_->io();
+  std::unordered_set<std::string> deleted;
+  for (const auto& update : catalog_->updates()) {
+    const auto* add = dynamic_cast<const table::AddSnapshot*>(update.get());
+    if (add == nullptr) {
+      continue;
+    }
+    const auto& snapshot = *add->snapshot();
+    // The manifests added by the snapshot are only referenced by the snapshots of the
+    // transaction, its other manifests come from the table.
+    auto reader = ManifestListReader::Make(snapshot.manifest_list, io);
+    if (reader.has_value()) {
+      if (auto manifests = (*reader)->Files(); manifests.has_value()) {
+        for (const auto& manifest : *manifests) {
+          if (manifest.added_snapshot_id == snapshot.snapshot_id &&
+              deleted.insert(manifest.manifest_path).second) {
+            std::ignore = io->DeleteFile(manifest.manifest_path);
+          }
+        }
+      }
+    }
+    std::ignore = io->DeleteFile(snapshot.manifest_list);
+  }
+}
+
+}  // namespace iceberg
@@ -0,0 +1,99 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/table_transaction.h
+/// Transaction staging the changes of several operations on a table in memory.
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/transaction.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief A transaction that commits the changes of several operations on a table
+/// with a single metadata file and a single catalog commit.
+///
+/// The operations of the transaction are created on table(), whose catalog stages
+/// their commits: the updates of each commit are applied to the metadata of the
+/// transaction in memory, so that the next operation sees them, and kept in order.
+/// CommitTransaction() then sends all the updates to the catalog of the table in one
+/// UpdateTable call, with the requirements of the metadata the transaction started
+/// from.
+///
+/// A transaction that loses a race with a concurrent commit fails with
+/// ErrorKind::kCommitFailed and is not retried, as its operations were applied on top
+/// of the metadata it started from. The manifests and manifest lists written by its
+/// snapshots are then deleted. Snapshots expired in a transaction are removed from the
+/// metadata, but their files are not deleted.
+class ICEBERG_EXPORT TableTransaction : public Transaction {
+ public:
+  /// \brief Starts a transaction on a table.
+  ///
+  /// \param table The table to change, which must have a catalog to commit to
+  /// \return The transaction, or ErrorKind::kNotSupported if the table has no catalog
+  static Result<std::shared_ptr<TableTransaction>> Make(std::shared_ptr<Table> table);
+
+  ~TableTransaction() override;
+
+  const std::shared_ptr<Table>& table() const override { return table_; }
+
+  std::shared_ptr<AppendFiles> NewAppend() override;
+
+  std::shared_ptr<RowDelta> NewRowDelta() override;
+
+  /// \brief Create a new expiration of the snapshots of this table, which does not
+  /// delete the files of the expired snapshots.
+  std::shared_ptr<ExpireSnapshots> NewExpireSnapshots() override;
+
+  Status UpdateProperties(const std::unordered_map<std::string, std::string>& updates,
+                          const std::vector<std::string>& removals = {}) override;
+
+  Status SetCurrentSchema(std::shared_ptr<Schema> schema) override;
+
+  Status CommitTransaction() override;
+
+ private:
+  class StagingCatalog;
+
+  TableTransaction(std::shared_ptr<Table> base_table,
+                   std::shared_ptr<StagingCatalog> catalog, std::shared_ptr<Table> table);
+
+  /// \brief Stages updates computed from the current metadata of the transaction.
+  Status Stage(std::vector<std::unique_ptr<TableUpdate>> updates);
+
+  /// \brief Deletes the manifests and manifest lists written by the staged snapshots.
+  void CleanUncommitted() const;
+
+  // The table the transaction commits to
+  std::shared_ptr<Table> base_table_;
+  std::shared_ptr<StagingCatalog> catalog_;
+  // The table with the staged metadata, whose catalog is catalog_
+  std::shared_ptr<Table> table_;
+  bool committed_ = false;
+};
+
+}  // namespace iceberg
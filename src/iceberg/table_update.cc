@@ -20,6 +20,7 @@
 #include "iceberg/table_update.h"
 
 #include "iceberg/exception.h"
+#include "iceberg/snapshot.h"
 #include "iceberg/table_metadata.h"
 #include "iceberg/table_requirement.h"
 #include "iceberg/table_requirements.h"
@@ -62,21 +63,33 @@ Status UpgradeFormatVersion::GenerateRequirements(TableUpdateContext& context) c
 // AddSchema
 
 void AddSchema::ApplyTo(TableMetadataBuilder& builder) const {
-  throw IcebergError(std::format("{} not implemented", __FUNCTION__));
+  builder.AddSchema(schema_);
 }
 
 Status AddSchema::GenerateRequirements(TableUpdateContext& context) const {
-  return NotImplemented("AddTableSchema::GenerateRequirements not implemented");
+  // The field IDs of the schema must not have been assigned concurrently.
+  const TableMetadata* base = context.base();
+  if (base != nullptr && !context.is_replace()) {
+    context.AddRequirement(
+        std::make_unique<AssertLastAssignedFieldId>(base->last_column_id));
+  }
+  return {};
 }
 
 // SetCurrentSchema
 
 void SetCurrentSchema::ApplyTo(TableMetadataBuilder& builder) const {
-  throw IcebergError(std::format("{} not implemented", __FUNCTION__));
+  builder.SetCurrentSchema(schema_id_);
 }
 
 Status SetCurrentSchema::GenerateRequirements(TableUpdateContext& context) const {
-  return NotImplemented("SetCurrentTableSchema::GenerateRequirements not implemented");
+  // Replacing the current schema requires that it did not change concurrently.
+  const TableMetadata* base = context.base();
+  if (base != nullptr && !context.is_replace() && base->current_schema_id.has_value()) {
+    context.AddRequirement(
+        std::make_unique<AssertCurrentSchemaID>(base->current_schema_id.value()));
+  }
+  return {};
 }
 
 // AddPartitionSpec
@@ -144,59 +157,133 @@ Status SetDefaultSortOrder::GenerateRequirements(TableUpdateContext& context) co
 // AddSnapshot
 
 void AddSnapshot::ApplyTo(TableMetadataBuilder& builder) const {
-  throw IcebergError(std::format("{} not implemented", __FUNCTION__));
+  builder.AddSnapshot(snapshot_);
 }
 
 Status AddSnapshot::GenerateRequirements(TableUpdateContext& context) const {
-  return NotImplemented("AddTableSnapshot::GenerateRequirements not implemented");
+  // Concurrent changes are detected by the requirements of the refs that are moved to
+  // the new snapshot.
+  return {};
 }
 
 // RemoveSnapshots
 
-void RemoveSnapshots::ApplyTo(TableMetadataBuilder& builder) const {}
+void RemoveSnapshots::ApplyTo(TableMetadataBuilder& builder) const {
+  builder.RemoveSnapshots(snapshot_ids_);
+}
 
 Status RemoveSnapshots::GenerateRequirements(TableUpdateContext& context) const {
-  return NotImplemented("RemoveTableSnapshots::GenerateRequirements not implemented");
+  // The removed snapshots are chosen from the lineages of the refs, which must not
+  // have moved since.
+  const TableMetadata* base = context.base();
+  if (base != nullptr && !context.is_replace()) {
+    for (const auto& [name, ref] : base->refs) {
+      context.AddRequirement(
+          std::make_unique<AssertRefSnapshotID>(name, ref->snapshot_id));
+    }
+  }
+  return {};
 }
 
 // RemoveSnapshotRef
 
 void RemoveSnapshotRef::ApplyTo(TableMetadataBuilder& builder) const {
-  throw IcebergError(std::format("{} not implemented", __FUNCTION__));
+  builder.RemoveRef(ref_name_);
 }
 
 Status RemoveSnapshotRef::GenerateRequirements(TableUpdateContext& context) const {
-  return NotImplemented("RemoveTableSnapshotRef::GenerateRequirements not implemented");
+  return {};
 }
 
 // SetSnapshotRef
 
 void SetSnapshotRef::ApplyTo(TableMetadataBuilder& builder) const {
-  throw IcebergError(std::format("{} not implemented", __FUNCTION__));
+  auto ref = std::make_shared<SnapshotRef>(SnapshotRef{.snapshot_id = snapshot_id_});
+  if (type_ == SnapshotRefType::kBranch) {
+    ref->retention = SnapshotRef::Branch{.min_snapshots_to_keep = min_snapshots_to_keep_,
+                                         .max_snapshot_age_ms = max_snapshot_age_ms_,
+                                         .max_ref_age_ms = max_ref_age_ms_};
+  } else {
+    ref->retention = SnapshotRef::Tag{.max_ref_age_ms = max_ref_age_ms_};
+  }
+  builder.SetRef(ref_name_, std::move(ref));
 }
 
 Status SetSnapshotRef::GenerateRequirements(TableUpdateContext& context) const {
-  return NotImplemented("SetTableSnapshotRef::GenerateRequirements not implemented");
+  // Moving a ref requires that it still points to the snapshot it had in the base
+  // metadata, or that it is still missing if it is created by this update.
+  const TableMetadata* base = context.base();
+  if (base != nullptr && !context.is_replace()) {
+    std::optional<int64_t> base_snapshot_id;
+    if (auto it = base->refs.find(ref_name_); it != base->refs.end()) {
+      base_snapshot_id = it->second->snapshot_id;
+    }
+    context.AddRequirement(
+        std::make_unique<AssertRefSnapshotID>(ref_name_, base_snapshot_id));
+  }
+  return {};
 }
 
 // SetProperties
 
 void SetProperties::ApplyTo(TableMetadataBuilder& builder) const {
-  throw IcebergError(std::format("{} not implemented", __FUNCTION__));
+  builder.SetProperties(updated_);
 }
 
 Status SetProperties::GenerateRequirements(TableUpdateContext& context) const {
-  return NotImplemented("SetTableProperties::GenerateRequirements not implemented");
+  return {};
 }
 
 // RemoveProperties
 
 void RemoveProperties::ApplyTo(TableMetadataBuilder& builder) const {
-  throw IcebergError(std::format("{} not implemented", __FUNCTION__));
+  builder.RemoveProperties(removed_);
 }
 
 Status RemoveProperties::GenerateRequirements(TableUpdateContext& context) const {
-  return NotImplemented("RemoveTableProperties::GenerateRequirements not implemented");
+  return {};
+}
+
+// SetStatistics
+
+void SetStatistics::ApplyTo(TableMetadataBuilder& builder) const {
+  builder.SetStatistics(statistics_file_);
+}
+
+Status SetStatistics::GenerateRequirements(TableUpdateContext& context) const {
+  // Statistics of a snapshot do not depend on the other metadata of the table.
+  return {};
+}
+
+// RemoveStatistics
+
+void RemoveStatistics::ApplyTo(TableMetadataBuilder& builder) const {
+  builder.RemoveStatistics(snapshot_id_);
+}
+
+Status RemoveStatistics::GenerateRequirements(TableUpdateContext& context) const {
+  return {};
+}
+
+// SetPartitionStatistics
+
+void SetPartitionStatistics::ApplyTo(TableMetadataBuilder& builder) const {
+  builder.SetPartitionStatistics(partition_statistics_file_);
+}
+
+Status SetPartitionStatistics::GenerateRequirements(TableUpdateContext& context) const {
+  return {};
+}
+
+// RemovePartitionStatistics
+
+void RemovePartitionStatistics::ApplyTo(TableMetadataBuilder& builder) const {
+  builder.RemovePartitionStatistics(snapshot_id_);
+}
+
+Status RemovePartitionStatistics::GenerateRequirements(
+    TableUpdateContext& context) const {
+  return {};
 }
 
 // SetLocation
@@ -51,6 +51,9 @@ class ICEBERG_EXPORT TableUpdate {
   /// \param builder The builder to apply this update to
   virtual void ApplyTo(TableMetadataBuilder& builder) const = 0;
 
+  /// \brief Returns a copy of this update
+  virtual std::unique_ptr<TableUpdate> Clone() const = 0;
+
   /// \brief Generate update requirements for this metadata update
   ///
   /// This method generates the appropriate UpdateRequirement instances
@@ -71,6 +74,10 @@ class ICEBERG_EXPORT AssignUUID : public TableUpdate {
 
   const std::string& uuid() const { return uuid_; }
 
+  std::unique_ptr<TableUpdate> Clone() const override {
+    return std::make_unique<AssignUUID>(*this);
+  }
+
   void ApplyTo(TableMetadataBuilder& builder) const override;
 
   Status GenerateRequirements(TableUpdateContext& context) const override;
@@ -87,6 +94,10 @@ class ICEBERG_EXPORT UpgradeFormatVersion : public TableUpdate {
 
   int8_t format_version() const { return format_version_; }
 
+  std::unique_ptr<TableUpdate> Clone() const override {
+    return std::make_unique<UpgradeFormatVersion>(*this);
+  }
+
   void ApplyTo(TableMetadataBuilder& builder) const override;
 
   Status GenerateRequirements(TableUpdateContext& context) const override;
@@ -105,6 +116,10 @@ class ICEBERG_EXPORT AddSchema : public TableUpdate {
 
   int32_t last_column_id() const { return last_column_id_; }
 
+  std::unique_ptr<TableUpdate> Clone() const override {
+    return std::make_unique<AddSchema>(*this);
+  }
+
   void ApplyTo(TableMetadataBuilder& builder) const override;
 
   Status GenerateRequirements(TableUpdateContext& context) const override;
@@ -121,6 +136,10 @@ class ICEBERG_EXPORT SetCurrentSchema : public TableUpdate {
 
   int32_t schema_id() const { return schema_id_; }
 
+  std::unique_ptr<TableUpdate> Clone() const override {
+    return std::make_unique<SetCurrentSchema>(*this);
+  }
+
   void ApplyTo(TableMetadataBuilder& builder) const override;
 
   Status GenerateRequirements(TableUpdateContext& context) const override;
@@ -137,6 +156,10 @@ class ICEBERG_EXPORT AddPartitionSpec : public TableUpdate {
 
   const std::shared_ptr<PartitionSpec>& spec() const { return spec_; }
 
+  std::unique_ptr<TableUpdate> Clone() const override {
+    return std::make_unique<AddPartitionSpec>(*this);
+  }
+
   void ApplyTo(TableMetadataBuilder& builder) const override;
 
   Status GenerateRequirements(TableUpdateContext& context) const override;
@@ -152,6 +175,10 @@ class ICEBERG_EXPORT SetDefaultPartitionSpec : public TableUpdate {
 
   int32_t spec_id() const { return spec_id_; }
 
+  std::unique_ptr<TableUpdate> Clone() const override {
+    return std::make_unique<SetDefaultPartitionSpec>(*this);
+  }
+
   void ApplyTo(TableMetadataBuilder& builder) const override;
 
   Status GenerateRequirements(TableUpdateContext& context) const override;
@@ -168,6 +195,10 @@ class ICEBERG_EXPORT RemovePartitionSpecs : public TableUpdate {
 
   const std::vector<int32_t>& spec_ids() const { return spec_ids_; }
 
+  std::unique_ptr<TableUpdate> Clone() const override {
+    return std::make_unique<RemovePartitionSpecs>(*this);
+  }
+
   void ApplyTo(TableMetadataBuilder& builder) const override;
 
   Status GenerateRequirements(TableUpdateContext& context) const override;
@@ -184,6 +215,10 @@ class ICEBERG_EXPORT RemoveSchemas : public TableUpdate {
 
   const std::vector<int32_t>& schema_ids() const { return schema_ids_; }
 
+  std::unique_ptr<TableUpdate> Clone() const override {
+    return std::make_unique<RemoveSchemas>(*this);
+  }
+
   void ApplyTo(TableMetadataBuilder& builder) const override;
 
   Status GenerateRequirements(TableUpdateContext& context) const override;
@@ -200,6 +235,10 @@ class ICEBERG_EXPORT AddSortOrder : public TableUpdate {
 
   const std::shared_ptr<SortOrder>& sort_order() const { return sort_order_; }
 
+  std::unique_ptr<TableUpdate> Clone() const override {
+    return std::make_unique<AddSortOrder>(*this);
+  }
+
   void ApplyTo(TableMetadataBuilder& builder) const override;
 
   Status GenerateRequirements(TableUpdateContext& context) const override;
@@ -215,6 +254,10 @@ class ICEBERG_EXPORT SetDefaultSortOrder : public TableUpdate {
 
   int32_t sort_order_id() const { return sort_order_id_; }
 
+  std::unique_ptr<TableUpdate> Clone() const override {
+    return std::make_unique<SetDefaultSortOrder>(*this);
+  }
+
   void ApplyTo(TableMetadataBuilder& builder) const override;
 
   Status GenerateRequirements(TableUpdateContext& context) const override;
@@ -231,6 +274,10 @@ class ICEBERG_EXPORT AddSnapshot : public TableUpdate {
 
   const std::shared_ptr<Snapshot>& snapshot() const { return snapshot_; }
 
+  std::unique_ptr<TableUpdate> Clone() const override {
+    return std::make_unique<AddSnapshot>(*this);
+  }
+
   void ApplyTo(TableMetadataBuilder& builder) const override;
 
   Status GenerateRequirements(TableUpdateContext& context) const override;
@@ -247,6 +294,10 @@ class ICEBERG_EXPORT RemoveSnapshots : public TableUpdate {
 
   const std::vector<int64_t>& snapshot_ids() const { return snapshot_ids_; }
 
+  std::unique_ptr<TableUpdate> Clone() const override {
+    return std::make_unique<RemoveSnapshots>(*this);
+  }
+
   void ApplyTo(TableMetadataBuilder& builder) const override;
 
   Status GenerateRequirements(TableUpdateContext& context) const override;
@@ -262,6 +313,10 @@ class ICEBERG_EXPORT RemoveSnapshotRef : public TableUpdate {
 
   const std::string& ref_name() const { return ref_name_; }
 
+  std::unique_ptr<TableUpdate> Clone() const override {
+    return std::make_unique<RemoveSnapshotRef>(*this);
+  }
+
   void ApplyTo(TableMetadataBuilder& builder) const override;
 
   Status GenerateRequirements(TableUpdateContext& context) const override;
@@ -295,6 +350,10 @@ class ICEBERG_EXPORT SetSnapshotRef : public TableUpdate {
   }
   const std::optional<int64_t>& max_ref_age_ms() const { return max_ref_age_ms_; }
 
+  std::unique_ptr<TableUpdate> Clone() const override {
+    return std::make_unique<SetSnapshotRef>(*this);
+  }
+
   void ApplyTo(TableMetadataBuilder& builder) const override;
 
   Status GenerateRequirements(TableUpdateContext& context) const override;
@@ -316,6 +375,10 @@ class ICEBERG_EXPORT SetProperties : public TableUpdate {
 
   const std::unordered_map<std::string, std::string>& updated() const { return updated_; }
 
+  std::unique_ptr<TableUpdate> Clone() const override {
+    return std::make_unique<SetProperties>(*this);
+  }
+
   void ApplyTo(TableMetadataBuilder& builder) const override;
 
   Status GenerateRequirements(TableUpdateContext& context) const override;
@@ -332,6 +395,10 @@ class ICEBERG_EXPORT RemoveProperties : public TableUpdate {
 
   const std::vector<std::string>& removed() const { return removed_; }
 
+  std::unique_ptr<TableUpdate> Clone() const override {
+    return std::make_unique<RemoveProperties>(*this);
+  }
+
   void ApplyTo(TableMetadataBuilder& builder) const override;
 
   Status GenerateRequirements(TableUpdateContext& context) const override;
@@ -340,6 +407,89 @@ class ICEBERG_EXPORT RemoveProperties : public TableUpdate {
   std::vector<std::string> removed_;
 };
 
+/// \brief Represents setting the statistics file of a snapshot
+class ICEBERG_EXPORT SetStatistics : public TableUpdate {
+ public:
+  explicit SetStatistics(std::shared_ptr<StatisticsFile> statistics_file)
+      : statistics_file_(std::move(statistics_file)) {}
+
+  const std::shared_ptr<StatisticsFile>& statistics_file() const {
+    return statistics_file_;
+  }
+
+  std::unique_ptr<TableUpdate> Clone() const override {
+    return std::make_unique<SetStatistics>(*this);
+  }
+
+  void ApplyTo(TableMetadataBuilder& builder) const override;
+
+  Status GenerateRequirements(TableUpdateContext& context) const override;
+
+ private:
+  std::shared_ptr<StatisticsFile> statistics_file_;
+};
+
+/// \brief Represents removing the statistics file of a snapshot
+class ICEBERG_EXPORT RemoveStatistics : public TableUpdate {
+ public:
+  explicit RemoveStatistics(int64_t snapshot_id) : snapshot_id_(snapshot_id) {}
+
+  int64_t snapshot_id() const { return snapshot_id_; }
+
+  std::unique_ptr<TableUpdate> Clone() const override {
+    return std::make_unique<RemoveStatistics>(*this);
+  }
+
+  void ApplyTo(TableMetadataBuilder& builder) const override;
+
+  Status GenerateRequirements(TableUpdateContext& context) const override;
+
+ private:
+  int64_t snapshot_id_;
+};
+
+/// \brief Represents setting the partition statistics file of a snapshot
+class ICEBERG_EXPORT SetPartitionStatistics : public TableUpdate {
+ public:
+  explicit SetPartitionStatistics(
+      std::shared_ptr<PartitionStatisticsFile> partition_statistics_file)
+      : partition_statistics_file_(std::move(partition_statistics_file)) {}
+
+  const std::shared_ptr<PartitionStatisticsFile>& partition_statistics_file() const {
+    return partition_statistics_file_;
+  }
+
+  std::unique_ptr<TableUpdate> Clone() const override {
+    return std::make_unique<SetPartitionStatistics>(*this);
+  }
+
+  void ApplyTo(TableMetadataBuilder& builder) const override;
+
+  Status GenerateRequirements(TableUpdateContext& context) const override;
+
+ private:
+  std::shared_ptr<PartitionStatisticsFile> partition_statistics_file_;
+};
+
+/// \brief Represents removing the partition statistics file of a snapshot
+class ICEBERG_EXPORT RemovePartitionStatistics : public TableUpdate {
+ public:
+  explicit RemovePartitionStatistics(int64_t snapshot_id) : snapshot_id_(snapshot_id) {}
+
+  int64_t snapshot_id() const { return snapshot_id_; }
+
+  std::unique_ptr<TableUpdate> Clone() const override {
+    return std::make_unique<RemovePartitionStatistics>(*this);
+  }
+
+  void ApplyTo(TableMetadataBuilder& builder) const override;
+
+  Status GenerateRequirements(TableUpdateContext& context) const override;
+
+ private:
+  int64_t snapshot_id_;
+};
+
 /// \brief Represents setting the table location
 class ICEBERG_EXPORT SetLocation : public TableUpdate {
  public:
@@ -347,6 +497,10 @@ class ICEBERG_EXPORT SetLocation : public TableUpdate {
 
   const std::string& location() const { return location_; }
 
+  std::unique_ptr<TableUpdate> Clone() const override {
+    return std::make_unique<SetLocation>(*this);
+  }
+
   void ApplyTo(TableMetadataBuilder& builder) const override;
 
   Status GenerateRequirements(TableUpdateContext& context) const override;
@@ -0,0 +1,150 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/append_coordinator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/manifest_entry.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table.h"
+#include "iceberg/table_scan.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/test/table_test_base.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+class AppendCoordinatorTest : public TableTestBase {
+ protected:
+  void SetUp() override {
+    TableTestBase::SetUp();
+    ASSERT_NO_FATAL_FAILURE(RegisterTable());
+  }
+
+  static std::vector<std::shared_ptr<DataFile>> DataFiles(const std::string& path) {
+    return {std::make_shared<DataFile>(DataFile{
+        .file_path = path,
+        .file_format = FileFormatType::kParquet,
+        .record_count = 10,
+        .file_size_in_bytes = 100,
+    })};
+  }
+
+  static std::vector<std::string> ScanPaths(const Table& table) {
+    auto scan = table.NewScan()->Build();
+    EXPECT_THAT(scan, IsOk());
+    auto tasks = (*scan)->PlanFiles();
+    EXPECT_THAT(tasks, IsOk());
+    std::vector<std::string> paths;
+    for (const auto& task : *tasks) {
+      paths.push_back(task->data_file()->file_path);
+    }
+    std::ranges::sort(paths);
+    return paths;
+  }
+};
+
+TEST_F(AppendCoordinatorTest, GroupsConcurrentProducers) {
+  constexpr int kProducers = 8;
+  // The group is committed once every producer has appended its file.
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto coordinator,
+      AppendCoordinator::Make(LoadTable(), {.max_delay = std::chrono::minutes(1),
+                                            .max_files = kProducers}));
+
+  std::vector<std::future<Status>> futures(kProducers);
+  std::vector<std::jthread> producers;
+  for (int i = 0; i < kProducers; ++i) {
+    producers.emplace_back([&, i]() {
+      futures[i] = coordinator->Append(DataFiles(std::format("/data/{}.parquet", i)));
+    });
+  }
+  producers.clear();
+  for (auto& future : futures) {
+    EXPECT_THAT(future.get(), IsOk());
+  }
+
+  auto table = LoadTable();
+  EXPECT_EQ(table->history().size(), 1);
+  ICEBERG_UNWRAP_OR_FAIL(auto snapshot, table->current_snapshot());
+  EXPECT_EQ(snapshot->operation(), DataOperation::kAppend);
+  EXPECT_EQ(snapshot->summary.at(SnapshotSummaryFields::kAddedDataFiles),
+            std::to_string(kProducers));
+  EXPECT_EQ(ScanPaths(*table).size(), kProducers);
+}
+
+TEST_F(AppendCoordinatorTest, FlushAndDestructionCommitPendingFiles) {
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto coordinator,
+      AppendCoordinator::Make(LoadTable(), {.max_delay = std::chrono::minutes(1),
+                                            .merge_manifests = false}));
+
+  auto first = coordinator->Append(DataFiles("/data/a.parquet"));
+  coordinator->Flush();
+  EXPECT_THAT(first.get(), IsOk());
+  EXPECT_EQ(LoadTable()->history().size(), 1);
+
+  auto second = coordinator->Append(DataFiles("/data/b.parquet"));
+  coordinator.reset();
+  EXPECT_THAT(second.get(), IsOk());
+
+  auto table = LoadTable();
+  EXPECT_EQ(table->history().size(), 2);
+  EXPECT_EQ(ScanPaths(*table),
+            (std::vector<std::string>{"/data/a.parquet", "/data/b.parquet"}));
+}
+
+TEST_F(AppendCoordinatorTest, InvalidFilesFailOnlyTheirProducer) {
+  ICEBERG_UNWRAP_OR_FAIL(auto coordinator,
+                         AppendCoordinator::Make(LoadTable(), {.max_delay = {}}));
+
+  auto delete_files = DataFiles("/data/delete.parquet");
+  delete_files[0]->content = DataFile::Content::kPositionDeletes;
+  EXPECT_THAT(coordinator->Append(std::move(delete_files)).get(),
+              IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(coordinator->Append({nullptr}).get(),
+              IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(coordinator->Append({}).get(), IsOk());
+  EXPECT_THAT(coordinator->Append(DataFiles("/data/a.parquet")).get(), IsOk());
+
+  EXPECT_EQ(ScanPaths(*LoadTable()), (std::vector<std::string>{"/data/a.parquet"}));
+}
+
+TEST_F(AppendCoordinatorTest, InvalidOptions) {
+  EXPECT_THAT(AppendCoordinator::Make(nullptr, {}), IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(AppendCoordinator::Make(LoadTable(), {.max_files = 0}),
+              IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(
+      AppendCoordinator::Make(LoadTable(), {.max_delay = std::chrono::milliseconds(-1)}),
+      IsError(ErrorKind::kInvalidArgument));
+}
+
+}  // namespace iceberg
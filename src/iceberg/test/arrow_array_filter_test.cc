@@ -0,0 +1,265 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/util/arrow_array_filter_internal.h"
+
+#include <arrow/array.h>
+#include <arrow/c/bridge.h>
+#include <arrow/json/from_string.h>
+#include <arrow/type.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/arrow_c_data_guard_internal.h"
+#include "iceberg/test/matchers.h"
+
+namespace iceberg {
+
+namespace {
+
+// Filters an array with the C data interface and imports the result back.
+std::shared_ptr<::arrow::Array> Filter(const std::shared_ptr<::arrow::Array>& array,
+                                       const std::vector<bool>& selected) {
+  std::vector<uint8_t> selection((selected.size() + 7) / 8, 0);
+  for (size_t i = 0; i < selected.size(); ++i) {
+    if (selected[i]) {
+      selection[i / 8] |= 1 << (i % 8);
+    }
+  }
+
+  ArrowSchema c_schema;
+  ArrowArray c_array;
+  EXPECT_TRUE(::arrow::ExportType(*array->type(), &c_schema).ok());
+  EXPECT_TRUE(::arrow::ExportArray(*array, &c_array).ok());
+  internal::ArrowSchemaGuard schema_guard(&c_schema);
+  internal::ArrowArrayGuard array_guard(&c_array);
+
+  auto filtered = FilterArrowArray(c_schema, c_array, selection);
+  EXPECT_THAT(filtered, IsOk());
+  return ::arrow::ImportArray(&filtered.value(), array->type()).ValueOrDie();
+}
+
+void CheckFilter(const std::shared_ptr<::arrow::DataType>& type, std::string_view json,
+                 const std::vector<bool>& selected, std::string_view expected_json) {
+  auto array = ::arrow::json::ArrayFromJSONString(type, json).ValueOrDie();
+  auto expected = ::arrow::json::ArrayFromJSONString(type, expected_json).ValueOrDie();
+  auto actual = Filter(array, selected);
+  ASSERT_TRUE(actual->Equals(*expected))
+      << "Actual:\n"
+      << actual->ToString() << "\nExpected:\n"
+      << expected->ToString();
+}
+
+}  // namespace
+
+TEST(ArrowArrayFilterTest, Primitives) {
+  CheckFilter(::arrow::int32(), "[1, null, 3, 4]", {true, true, false, true},
+              "[1, null, 4]");
+  CheckFilter(::arrow::float64(), "[1.5, 2.5, null]", {false, true, true},
+              "[2.5, null]");
+  CheckFilter(::arrow::boolean(), "[true, false, true, null]", {true, false, true, true},
+              "[true, true, null]");
+  CheckFilter(::arrow::decimal128(10, 2), R"(["1.23", "4.56", null])",
+              {false, true, false}, R"(["4.56"])");
+  CheckFilter(::arrow::fixed_size_binary(2), R"(["ab", "cd", "ef"])",
+              {true, false, true}, R"(["ab", "ef"])");
+}
+
+TEST(ArrowArrayFilterTest, Strings) {
+  CheckFilter(::arrow::utf8(), R"(["foo", null, "", "bar"])", {true, true, true, false},
+              R"(["foo", null, ""])");
+  CheckFilter(::arrow::large_binary(), R"(["foo", "bar"])", {false, true}, R"(["bar"])");
+  CheckFilter(::arrow::utf8(), R"(["foo", "bar"])", {false, false}, "[]");
+}
+
+TEST(ArrowArrayFilterTest, NestedTypes) {
+  auto struct_type = ::arrow::struct_(
+      {::arrow::field("id", ::arrow::int64()), ::arrow::field("name", ::arrow::utf8())});
+  CheckFilter(struct_type, R"([[1, "a"], null, [3, null], [4, "d"]])",
+              {true, true, false, true}, R"([[1, "a"], null, [4, "d"]])");
+
+  CheckFilter(::arrow::list(::arrow::int32()), "[[1, 2], null, [], [3]]",
+              {false, true, true, true}, "[null, [], [3]]");
+  CheckFilter(::arrow::map(::arrow::utf8(), ::arrow::int32()),
+              R"([[["a", 1], ["b", 2]], [["c", 3]], null])", {true, false, true},
+              R"([[["a", 1], ["b", 2]], null])");
+  CheckFilter(::arrow::list(::arrow::list(::arrow::utf8())),
+              R"([[["a"], ["b", "c"]], [["d"]], [[], null]])", {true, false, true},
+              R"([[["a"], ["b", "c"]], [[], null]])");
+}
+
+TEST(ArrowArrayFilterTest, SlicedArray) {
+  auto array = ::arrow::json::ArrayFromJSONString(
+                   ::arrow::list(::arrow::utf8()), R"([["a"], ["b", null], null, ["c"]])")
+                   .ValueOrDie()
+                   ->Slice(1);
+  auto expected = ::arrow::json::ArrayFromJSONString(::arrow::list(::arrow::utf8()),
+                                                     R"([["b", null], ["c"]])")
+                      .ValueOrDie();
+  auto actual = Filter(array, {true, false, true});
+  ASSERT_TRUE(actual->Equals(*expected)) << actual->ToString();
+}
+
+TEST(ArrowArrayFilterTest, SelectionTooShort) {
+  auto array =
+      ::arrow::json::ArrayFromJSONString(::arrow::int32(), "[1, 2, 3, 4, 5, 6, 7, 8, 9]")
+          .ValueOrDie();
+  ArrowSchema c_schema;
+  ArrowArray c_array;
+  ASSERT_TRUE(::arrow::ExportType(*array->type(), &c_schema).ok());
+  ASSERT_TRUE(::arrow::ExportArray(*array, &c_array).ok());
+  internal::ArrowSchemaGuard schema_guard(&c_schema);
+  internal::ArrowArrayGuard array_guard(&c_array);
+
+  std::vector<uint8_t> selection = {0xff};
+  EXPECT_THAT(FilterArrowArray(c_schema, c_array, selection),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST(ArrowArrayFilterTest, TakeRows) {
+  auto array = ::arrow::json::ArrayFromJSONString(
+                   ::arrow::struct_({::arrow::field("id", ::arrow::int32()),
+                                     ::arrow::field("name", ::arrow::utf8())}),
+                   R"([[1, "a"], [2, null], [3, "c"], [4, "d"]])")
+                   .ValueOrDie()
+                   ->Slice(1);
+  ArrowSchema c_schema;
+  ArrowArray c_array;
+  ASSERT_TRUE(::arrow::ExportType(*array->type(), &c_schema).ok());
+  ASSERT_TRUE(::arrow::ExportArray(*array, &c_array).ok());
+  internal::ArrowSchemaGuard schema_guard(&c_schema);
+  internal::ArrowArrayGuard array_guard(&c_array);
+
+  std::vector<int64_t> indices = {2, 0, 2};
+  auto taken = TakeArrowArray(c_schema, c_array, indices);
+  ASSERT_THAT(taken, IsOk());
+  auto actual = ::arrow::ImportArray(&taken.value(), array->type()).ValueOrDie();
+  auto expected =
+      ::arrow::json::ArrayFromJSONString(array->type(),
+                                         R"([[4, "d"], [2, null], [4, "d"]])")
+          .ValueOrDie();
+  ASSERT_TRUE(actual->Equals(*expected)) << actual->ToString();
+
+  std::vector<int64_t> out_of_range = {3};
+  EXPECT_THAT(TakeArrowArray(c_schema, c_array, out_of_range),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST(ArrowArrayFilterTest, TakeRowsOfSeveralArrays) {
+  auto type = ::arrow::struct_({::arrow::field("id", ::arrow::int32()),
+                                ::arrow::field("tags", ::arrow::list(::arrow::utf8()))});
+  auto first = ::arrow::json::ArrayFromJSONString(type, R"([[1, ["a"]], [2, null]])")
+                   .ValueOrDie();
+  auto second =
+      ::arrow::json::ArrayFromJSONString(type, R"([[0, []], [3, ["b", "c"]], [4, null]])")
+          .ValueOrDie()
+          ->Slice(1);
+  ArrowSchema c_schema;
+  ArrowArray c_first;
+  ArrowArray c_second;
+  ASSERT_TRUE(::arrow::ExportType(*type, &c_schema).ok());
+  ASSERT_TRUE(::arrow::ExportArray(*first, &c_first).ok());
+  ASSERT_TRUE(::arrow::ExportArray(*second, &c_second).ok());
+  internal::ArrowSchemaGuard schema_guard(&c_schema);
+  internal::ArrowArrayGuard first_guard(&c_first);
+  internal::ArrowArrayGuard second_guard(&c_second);
+
+  const ArrowArray* arrays[] = {&c_first, &c_second};
+  std::vector<ArrowRowLocation> rows = {{1, 0}, {0, 1}, {0, 0}, {1, 1}};
+  auto taken = TakeArrowArrays(c_schema, arrays, rows);
+  ASSERT_THAT(taken, IsOk());
+  auto actual = ::arrow::ImportArray(&taken.value(), type).ValueOrDie();
+  auto expected = ::arrow::json::ArrayFromJSONString(
+                      type, R"([[3, ["b", "c"]], [2, null], [1, ["a"]], [4, null]])")
+                      .ValueOrDie();
+  ASSERT_TRUE(actual->Equals(*expected)) << actual->ToString();
+
+  std::vector<ArrowRowLocation> out_of_range = {{2, 0}};
+  EXPECT_THAT(TakeArrowArrays(c_schema, arrays, out_of_range),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST(ArrowArrayFilterTest, DictionaryArrays) {
+  auto type = ::arrow::dictionary(::arrow::int32(), ::arrow::utf8());
+  auto make = [&](std::string_view indices, std::string_view values) {
+    return ::arrow::DictionaryArray::FromArrays(
+               type, ::arrow::json::ArrayFromJSONString(::arrow::int32(), indices)
+                         .ValueOrDie(),
+               ::arrow::json::ArrayFromJSONString(::arrow::utf8(), values).ValueOrDie())
+        .ValueOrDie();
+  };
+  // The indices are filtered and the dictionary is kept as is.
+  auto array = make("[0, 1, null, 1, 2]", R"(["a", "b", "c"])");
+  auto actual = Filter(array, {false, true, true, false, true});
+  auto expected = make("[1, null, 2]", R"(["a", "b", "c"])");
+  ASSERT_TRUE(actual->Equals(*expected)) << actual->ToString();
+
+  // Rows of arrays with different dictionaries index their concatenation.
+  auto first = make("[1, 0]", R"(["x", "y"])");
+  auto second = make("[null, 0, 1]", R"(["z", "x"])");
+  ArrowSchema c_schema;
+  ArrowArray c_first;
+  ArrowArray c_second;
+  ASSERT_TRUE(::arrow::ExportType(*type, &c_schema).ok());
+  ASSERT_TRUE(::arrow::ExportArray(*first, &c_first).ok());
+  ASSERT_TRUE(::arrow::ExportArray(*second, &c_second).ok());
+  internal::ArrowSchemaGuard schema_guard(&c_schema);
+  internal::ArrowArrayGuard first_guard(&c_first);
+  internal::ArrowArrayGuard second_guard(&c_second);
+
+  const ArrowArray* arrays[] = {&c_first, &c_second};
+  std::vector<ArrowRowLocation> rows = {{1, 2}, {0, 0}, {1, 0}, {1, 1}};
+  auto taken = TakeArrowArrays(c_schema, arrays, rows);
+  ASSERT_THAT(taken, IsOk());
+  actual = ::arrow::ImportArray(&taken.value(), type).ValueOrDie();
+  expected = make("[3, 1, null, 2]", R"(["x", "y", "z", "x"])");
+  ASSERT_TRUE(actual->Equals(*expected)) << actual->ToString();
+
+  // 5 indices, then 4 offsets and 3 bytes of dictionary values.
+  ArrowArray c_array;
+  ASSERT_TRUE(::arrow::ExportArray(*array, &c_array).ok());
+  internal::ArrowArrayGuard array_guard(&c_array);
+  auto size = EstimateArrowArraySize(c_schema, c_array);
+  ASSERT_THAT(size, IsOk());
+  EXPECT_EQ(size.value(), 1 + 20 + 16 + 3);
+}
+
+TEST(ArrowArrayFilterTest, EstimateSize) {
+  auto array = ::arrow::json::ArrayFromJSONString(
+                   ::arrow::struct_({::arrow::field("id", ::arrow::int64()),
+                                     ::arrow::field("name", ::arrow::utf8())}),
+                   R"([[1, "aaaa"], [2, "bb"], [3, "cccccc"]])")
+                   .ValueOrDie();
+  auto estimate = [](const std::shared_ptr<::arrow::Array>& array) {
+    ArrowSchema c_schema;
+    ArrowArray c_array;
+    EXPECT_TRUE(::arrow::ExportType(*array->type(), &c_schema).ok());
+    EXPECT_TRUE(::arrow::ExportArray(*array, &c_array).ok());
+    internal::ArrowSchemaGuard schema_guard(&c_schema);
+    internal::ArrowArrayGuard array_guard(&c_array);
+    auto size = EstimateArrowArraySize(c_schema, c_array);
+    EXPECT_THAT(size, IsOk());
+    return size.value_or(-1);
+  };
+  // 3 longs, then 4 offsets and 12 bytes of strings.
+  EXPECT_EQ(estimate(array), 24 + 16 + 12);
+  // 1 long, then 2 offsets and 2 bytes of strings.
+  EXPECT_EQ(estimate(array->Slice(1, 1)), 8 + 8 + 2);
+}
+
+}  // namespace iceberg
@@ -17,10 +17,21 @@
  * under the License.
  */
 
+#include <filesystem>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <arrow/buffer.h>
 #include <arrow/filesystem/localfs.h>
+#include <arrow/io/file.h>
+#include <arrow/io/interfaces.h>
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include "iceberg/arrow/arrow_fs_file_io_internal.h"
+#include "iceberg/file_writer.h"
 #include "iceberg/test/matchers.h"
 #include "iceberg/test/temp_file_test_base.h"
 
@@ -64,4 +75,184 @@ TEST_F(LocalFileIOTest, DeleteFile) {
   EXPECT_THAT(del_res, HasErrorMessage("Cannot delete file"));
 }
 
+TEST_F(LocalFileIOTest, DeleteFiles) {
+  std::vector<std::string> file_locations;
+  for (int i = 0; i < 3; ++i) {
+    file_locations.push_back(CreateNewTempFilePath());
+    ASSERT_THAT(file_io_->WriteFile(file_locations.back(), "hello world"), IsOk());
+  }
+  file_locations.insert(file_locations.begin() + 1, temp_filepath_);
+
+  auto failures = file_io_->DeleteFiles(file_locations);
+  ASSERT_EQ(failures.size(), 1);
+  EXPECT_EQ(failures[0].file_location, temp_filepath_);
+  EXPECT_EQ(failures[0].error.kind, ErrorKind::kIOError);
+  for (const auto& file_location : file_locations) {
+    EXPECT_THAT(file_io_->ReadFile(file_location, std::nullopt),
+                IsError(ErrorKind::kIOError));
+  }
+}
+
+TEST_F(LocalFileIOTest, WriteFileIfAbsent) {
+  EXPECT_THAT(file_io_->FileExists(temp_filepath_), HasValue(::testing::IsFalse()));
+  ASSERT_THAT(file_io_->WriteFileIfAbsent(temp_filepath_, "first"), IsOk());
+  EXPECT_THAT(file_io_->FileExists(temp_filepath_), HasValue(::testing::IsTrue()));
+
+  EXPECT_THAT(file_io_->WriteFileIfAbsent(temp_filepath_, "second"),
+              IsError(ErrorKind::kAlreadyExists));
+  EXPECT_THAT(file_io_->ReadFile(temp_filepath_, std::nullopt),
+              HasValue(::testing::Eq("first")));
+
+  // Missing directories are created, and no temporary file is left behind.
+  auto nested = std::filesystem::path(CreateTempDirectory()) / "a" / "b" / "file";
+  ASSERT_THAT(file_io_->WriteFileIfAbsent(nested.string(), "nested"), IsOk());
+  EXPECT_EQ(std::distance(std::filesystem::directory_iterator(nested.parent_path()),
+                          std::filesystem::directory_iterator()),
+            1);
+}
+
+TEST_F(LocalFileIOTest, MemoryMappedFiles) {
+  ASSERT_THAT(file_io_->WriteFile(temp_filepath_, "hello world"), IsOk());
+  std::shared_ptr<FileIO> io = arrow::ArrowFileSystemFileIO::MakeLocalFileIO(
+      /*memory_map=*/true);
+  auto input = arrow::OpenArrowInputFile(io, temp_filepath_, std::nullopt);
+  ASSERT_THAT(input, IsOk());
+  EXPECT_NE(std::dynamic_pointer_cast<::arrow::io::MemoryMappedFile>(input.value()),
+            nullptr);
+  EXPECT_EQ(input.value()->ReadAt(6, 5).ValueOrDie()->ToString(), "world");
+  EXPECT_THAT(io->ReadFile(temp_filepath_, std::nullopt),
+              HasValue(::testing::Eq("hello world")));
+}
+
+TEST_F(LocalFileIOTest, InputAndOutputFiles) {
+  auto output = file_io_->NewOutputFile(temp_filepath_);
+  ASSERT_THAT(output, IsOk());
+  EXPECT_THAT(output.value()->Write("hello "), IsOk());
+  EXPECT_THAT(output.value()->Write("world"), IsOk());
+  EXPECT_THAT(output.value()->Position(), HasValue(::testing::Eq(11)));
+  EXPECT_THAT(output.value()->Close(), IsOk());
+
+  auto input = file_io_->NewInputFile(temp_filepath_, std::nullopt);
+  ASSERT_THAT(input, IsOk());
+  EXPECT_THAT(input.value()->Size(), HasValue(::testing::Eq(11)));
+  std::vector<uint8_t> buffer(5);
+  EXPECT_THAT(input.value()->ReadAt(6, buffer), HasValue(::testing::Eq(5)));
+  EXPECT_EQ(std::string(buffer.begin(), buffer.end()), "world");
+
+  std::vector<uint8_t> first(5);
+  std::vector<uint8_t> second(3);
+  std::vector<ReadRange> ranges = {{.offset = 0, .out = first},
+                                   {.offset = 8, .out = second}};
+  EXPECT_THAT(input.value()->ReadRanges(ranges), IsOk());
+  EXPECT_EQ(std::string(first.begin(), first.end()), "hello");
+  EXPECT_EQ(std::string(second.begin(), second.end()), "rld");
+  EXPECT_THAT(input.value()->Close(), IsOk());
+}
+
+TEST_F(LocalFileIOTest, CoalescedReadRanges) {
+  ASSERT_THAT(file_io_->WriteFile(temp_filepath_, "0123456789abcdefghij"), IsOk());
+  arrow::ArrowFileSystemFileIO io(std::make_shared<::arrow::fs::LocalFileSystem>(),
+                                  {.hole_size_limit = 4, .range_size_limit = 16});
+  auto input = io.NewInputFile(temp_filepath_, std::nullopt);
+  ASSERT_THAT(input, IsOk());
+
+  // The first three ranges are merged, the last one is read on its own.
+  std::vector<std::vector<uint8_t>> buffers = {std::vector<uint8_t>(2),
+                                               std::vector<uint8_t>(3),
+                                               std::vector<uint8_t>(4),
+                                               std::vector<uint8_t>(2)};
+  std::vector<ReadRange> ranges = {{.offset = 8, .out = buffers[0]},
+                                   {.offset = 0, .out = buffers[1]},
+                                   {.offset = 1, .out = buffers[2]},
+                                   {.offset = 18, .out = buffers[3]}};
+  ASSERT_THAT(input.value()->ReadRanges(ranges), IsOk());
+  std::vector<std::string> contents;
+  for (const auto& buffer : buffers) {
+    contents.emplace_back(buffer.begin(), buffer.end());
+  }
+  EXPECT_THAT(contents, ::testing::ElementsAre("89", "012", "1234", "ij"));
+
+  // A range past the end of the file cannot be read fully.
+  ranges = {{.offset = 19, .out = buffers[0]}};
+  EXPECT_THAT(input.value()->ReadRanges(ranges), IsError(ErrorKind::kIOError));
+}
+
+namespace {
+
+/// \brief A FileIO that is not backed by an Arrow file system.
+class InMemoryFileIO : public FileIO {
+ public:
+  Result<std::string> ReadFile(const std::string& file_location,
+                               std::optional<size_t> length) override {
+    auto it = files_.find(file_location);
+    if (it == files_.cend()) {
+      return IOError("File {} does not exist", file_location);
+    }
+    return it->second;
+  }
+
+  Status WriteFile(const std::string& file_location, std::string_view content) override {
+    files_[file_location] = std::string(content);
+    return {};
+  }
+
+  std::unordered_map<std::string, std::string> files_;
+};
+
+}  // namespace
+
+TEST(ArrowFileIOAdapterTest, OpenFilesOfOtherFileIO) {
+  auto io = std::make_shared<InMemoryFileIO>();
+  auto output = arrow::OpenArrowOutputStream(io, "data");
+  ASSERT_THAT(output, IsOk());
+  ASSERT_TRUE(output.value()->Write("hello world").ok());
+  EXPECT_EQ(output.value()->Tell().ValueOrDie(), 11);
+  ASSERT_TRUE(output.value()->Close().ok());
+  EXPECT_EQ(io->files_["data"], "hello world");
+
+  EXPECT_THAT(arrow::OpenArrowInputFile(io, "missing", std::nullopt),
+              IsError(ErrorKind::kIOError));
+  auto input = arrow::OpenArrowInputFile(io, "data", std::nullopt);
+  ASSERT_THAT(input, IsOk());
+  auto& file = *input.value();
+  EXPECT_EQ(file.GetSize().ValueOrDie(), 11);
+  EXPECT_EQ(file.ReadAt(6, 5).ValueOrDie()->ToString(), "world");
+  EXPECT_EQ(file.Read(5).ValueOrDie()->ToString(), "hello");
+  EXPECT_EQ(file.Tell().ValueOrDie(), 5);
+  // Reads stop at the end of the file.
+  EXPECT_EQ(file.ReadAt(8, 10).ValueOrDie()->ToString(), "rld");
+  ASSERT_TRUE(file.Close().ok());
+  EXPECT_TRUE(file.closed());
+  EXPECT_FALSE(file.ReadAt(0, 1).ok());
+
+  EXPECT_THAT(arrow::OpenArrowInputFile(nullptr, "data", std::nullopt),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST(ArrowFileIOAdapterTest, UploadPartsInBackground) {
+  auto io = std::make_shared<InMemoryFileIO>();
+  WriterOptions options{
+      .path = "data",
+      .io = io,
+      .properties = {{std::string(WriterOptions::kUploadPartsInFlightProperty), "2"},
+                     {std::string(WriterOptions::kUploadPartSizeProperty), "4"}}};
+  auto output = arrow::OpenArrowOutputStream(options);
+  ASSERT_THAT(output, IsOk());
+  std::string expected;
+  for (int i = 0; i < 100; ++i) {
+    auto chunk = std::to_string(i) + ",";
+    ASSERT_TRUE(output.value()->Write(chunk).ok());
+    ASSERT_TRUE(output.value()->Flush().ok());
+    expected += chunk;
+    EXPECT_EQ(output.value()->Tell().ValueOrDie(), static_cast<int64_t>(expected.size()));
+  }
+  ASSERT_TRUE(output.value()->Close().ok());
+  EXPECT_TRUE(output.value()->closed());
+  EXPECT_EQ(io->files_["data"], expected);
+
+  options.properties[std::string(WriterOptions::kUploadPartsInFlightProperty)] = "0";
+  EXPECT_THAT(arrow::OpenArrowOutputStream(options),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
 }  // namespace iceberg
@@ -0,0 +1,173 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/util/arrow_metrics_internal.h"
+
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <arrow/array.h>
+#include <arrow/c/bridge.h>
+#include <arrow/json/from_string.h>
+#include <arrow/type.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/arrow_c_data_guard_internal.h"
+#include "iceberg/expression/literal.h"
+#include "iceberg/schema.h"
+#include "iceberg/schema_internal.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+namespace {
+
+Schema TestSchema() {
+  return Schema({
+      SchemaField::MakeOptional(1, "id", int64()),
+      SchemaField::MakeOptional(2, "name", string()),
+      SchemaField::MakeOptional(
+          3, "location", struct_({SchemaField::MakeOptional(4, "lat", float64())})),
+      SchemaField::MakeOptional(5, "tags",
+                                list(SchemaField::MakeOptional(6, "element", int32()))),
+      SchemaField::MakeOptional(7, "data", binary()),
+  });
+}
+
+constexpr std::string_view kRows = R"([
+  [5, "apple", {"lat": 1.5}, [3, 1], "\u0001\u0002"],
+  [null, "zebra", {"lat": NaN}, [null], ""],
+  [-3, "mango", {"lat": -0.0}, null, "\u007f\u007f"],
+  [9, null, null, [7], null]
+])";
+
+std::shared_ptr<::arrow::Array> MakeArray(const Schema& schema, std::string_view json) {
+  ArrowSchema c_schema;
+  EXPECT_THAT(ToArrowSchema(schema, &c_schema), IsOk());
+  auto type = ::arrow::ImportType(&c_schema).ValueOrDie();
+  return ::arrow::json::ArrayFromJSONString(type, json).ValueOrDie();
+}
+
+Result<Metrics> CollectMetrics(
+    const Schema& schema, const std::vector<std::shared_ptr<::arrow::Array>>& arrays,
+    const std::unordered_map<std::string, std::string>& properties = {}) {
+  ICEBERG_ASSIGN_OR_RAISE(auto config, MetricsConfig::Make(properties, schema));
+  ICEBERG_ASSIGN_OR_RAISE(auto collector, ArrowMetricsCollector::Make(schema, config));
+  for (const auto& array : arrays) {
+    ArrowArray c_array;
+    if (!::arrow::ExportArray(*array, &c_array).ok()) {
+      return InvalidArrowData("Failed to export array");
+    }
+    internal::ArrowArrayGuard guard(&c_array);
+    ICEBERG_RETURN_UNEXPECTED(collector.Update(c_array));
+  }
+  return collector.Finish();
+}
+
+}  // namespace
+
+TEST(ArrowMetricsCollectorTest, DefaultMetrics) {
+  auto schema = TestSchema();
+  auto array = MakeArray(schema, kRows);
+  auto metrics = CollectMetrics(schema, {array, array->Slice(1, 2)});
+  ASSERT_THAT(metrics, IsOk());
+
+  EXPECT_EQ(metrics->row_count, 6);
+  EXPECT_EQ(metrics->value_counts.at(1), 6);
+  EXPECT_EQ(metrics->null_value_counts.at(1), 2);
+  EXPECT_EQ(metrics->lower_bounds.at(1), Literal::Long(-3));
+  EXPECT_EQ(metrics->upper_bounds.at(1), Literal::Long(9));
+
+  EXPECT_EQ(metrics->null_value_counts.at(2), 1);
+  EXPECT_EQ(metrics->lower_bounds.at(2), Literal::String("apple"));
+  EXPECT_EQ(metrics->upper_bounds.at(2), Literal::String("zebra"));
+
+  // Values in null structs are null, and NaN values are not bounds.
+  EXPECT_EQ(metrics->value_counts.at(4), 6);
+  EXPECT_EQ(metrics->null_value_counts.at(4), 1);
+  EXPECT_EQ(metrics->nan_value_counts.at(4), 2);
+  EXPECT_EQ(metrics->lower_bounds.at(4), Literal::Double(-0.0));
+  EXPECT_EQ(metrics->upper_bounds.at(4), Literal::Double(1.5));
+
+  // Elements of lists have counts without bounds.
+  EXPECT_EQ(metrics->value_counts.at(6), 5);
+  EXPECT_EQ(metrics->null_value_counts.at(6), 2);
+  EXPECT_FALSE(metrics->lower_bounds.contains(6));
+  EXPECT_FALSE(metrics->nan_value_counts.contains(6));
+
+  EXPECT_EQ(metrics->lower_bounds.at(7), Literal::Binary({}));
+  EXPECT_EQ(metrics->upper_bounds.at(7), Literal::Binary({0x7F, 0x7F}));
+}
+
+TEST(ArrowMetricsCollectorTest, MetricsModes) {
+  auto schema = TestSchema();
+  auto metrics = CollectMetrics(schema, {MakeArray(schema, kRows)},
+                                {{"write.metadata.metrics.default", "truncate(2)"},
+                                 {"write.metadata.metrics.column.id", "counts"},
+                                 {"write.metadata.metrics.column.location.lat", "none"},
+                                 {"write.metadata.metrics.column.data", "truncate(1)"}});
+  ASSERT_THAT(metrics, IsOk());
+
+  EXPECT_EQ(metrics->value_counts.at(1), 4);
+  EXPECT_FALSE(metrics->lower_bounds.contains(1));
+  EXPECT_FALSE(metrics->upper_bounds.contains(1));
+
+  EXPECT_EQ(metrics->lower_bounds.at(2), Literal::String("ap"));
+  EXPECT_EQ(metrics->upper_bounds.at(2), Literal::String("zf"));
+
+  EXPECT_FALSE(metrics->value_counts.contains(4));
+  EXPECT_FALSE(metrics->nan_value_counts.contains(4));
+
+  EXPECT_EQ(metrics->lower_bounds.at(7), Literal::Binary({}));
+  EXPECT_EQ(metrics->upper_bounds.at(7), Literal::Binary({0x80}));
+}
+
+TEST(ArrowMetricsCollectorTest, PrimitiveBounds) {
+  Schema schema({
+      SchemaField::MakeRequired(1, "flag", boolean()),
+      SchemaField::MakeRequired(2, "day", date()),
+      SchemaField::MakeRequired(3, "amount", decimal(9, 2)),
+      SchemaField::MakeRequired(4, "ratio", float32()),
+      SchemaField::MakeRequired(5, "code", fixed(2)),
+  });
+  auto array = MakeArray(schema, R"([
+    [true, 19000, "12.50", 0.5, "bb"],
+    [false, 18000, "-1.25", -2.5, "ab"],
+    [true, 20000, "3.00", 1.0, "ba"]
+  ])");
+  auto metrics = CollectMetrics(schema, {array});
+  ASSERT_THAT(metrics, IsOk());
+
+  EXPECT_EQ(metrics->lower_bounds.at(1), Literal::Boolean(false));
+  EXPECT_EQ(metrics->upper_bounds.at(1), Literal::Boolean(true));
+  EXPECT_EQ(metrics->lower_bounds.at(2), Literal::Date(18000));
+  EXPECT_EQ(metrics->upper_bounds.at(2), Literal::Date(20000));
+  EXPECT_EQ(metrics->lower_bounds.at(3), Literal::Decimal(-125, 9, 2));
+  EXPECT_EQ(metrics->upper_bounds.at(3), Literal::Decimal(1250, 9, 2));
+  EXPECT_EQ(metrics->lower_bounds.at(4), Literal::Float(-2.5F));
+  EXPECT_EQ(metrics->upper_bounds.at(4), Literal::Float(1.0F));
+  EXPECT_EQ(metrics->nan_value_counts.at(4), 0);
+  EXPECT_EQ(metrics->lower_bounds.at(5), Literal::Fixed({'a', 'b'}));
+  EXPECT_EQ(metrics->upper_bounds.at(5), Literal::Fixed({'b', 'b'}));
+}
+
+}  // namespace iceberg
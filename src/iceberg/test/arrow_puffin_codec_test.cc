@@ -0,0 +1,55 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/arrow/arrow_register.h"
+#include "iceberg/puffin/puffin_format.h"
+#include "iceberg/test/matchers.h"
+
+namespace iceberg::arrow {
+
+class ArrowPuffinCodecTest : public ::testing::TestWithParam<PuffinCompressionCodec> {
+ protected:
+  static void SetUpTestSuite() { RegisterPuffinCodecs(); }
+};
+
+TEST_P(ArrowPuffinCodecTest, RoundTrip) {
+  const auto& codec = PuffinCodecRegistry::GetCodec(GetParam());
+  std::string data;
+  for (int i = 0; i < 10000; ++i) {
+    data.append(std::to_string(i % 97));
+  }
+  ICEBERG_UNWRAP_OR_FAIL(auto compressed, codec.compress(data));
+  EXPECT_LT(compressed.size(), data.size());
+  // The decompressed size is not known, so the output grows as the frame is read.
+  EXPECT_THAT(codec.decompress(compressed), HasValue(::testing::Eq(data)));
+
+  compressed.resize(compressed.size() / 2);
+  EXPECT_THAT(codec.decompress(compressed), ::testing::Not(IsOk()));
+}
+
+INSTANTIATE_TEST_SUITE_P(Codecs, ArrowPuffinCodecTest,
+                         ::testing::Values(PuffinCompressionCodec::kLz4,
+                                           PuffinCompressionCodec::kZstd));
+
+}  // namespace iceberg::arrow
@@ -0,0 +1,254 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/arrow/arrow_scan.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <arrow/array.h>
+#include <arrow/c/bridge.h>
+#include <arrow/compute/api_scalar.h>
+#include <arrow/compute/expression.h>
+#include <arrow/json/from_string.h>
+#include <arrow/record_batch.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/avro/avro_register.h"
+#include "iceberg/data_writer.h"
+#include "iceberg/expression/expressions.h"
+#include "iceberg/fast_append.h"
+#include "iceberg/location_provider.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/parquet/parquet_register.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table.h"
+#include "iceberg/table_scan.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/test/table_test_base.h"
+#include "iceberg/type.h"
+
+namespace iceberg::arrow {
+
+namespace {
+
+namespace cp = ::arrow::compute;
+
+class DirectoryLocationProvider : public LocationProvider {
+ public:
+  explicit DirectoryLocationProvider(std::string directory)
+      : directory_(std::move(directory)) {}
+
+  Result<std::string> NewDataLocation(const std::string& filename) override {
+    return std::format("{}/{}", directory_, filename);
+  }
+
+  Result<std::string> NewDataLocation(const PartitionSpec& /*spec*/,
+                                      const StructLike& /*partition_data*/,
+                                      const std::string& filename) override {
+    return NewDataLocation(filename);
+  }
+
+ private:
+  std::string directory_;
+};
+
+// Returns the sorted IDs of the rows of a reader, whose first column is the ID.
+std::vector<int64_t> ReadIds(::arrow::RecordBatchReader& reader) {
+  std::vector<int64_t> ids;
+  for (const auto& batch : reader.ToRecordBatches().ValueOrDie()) {
+    auto column = std::static_pointer_cast<::arrow::Int64Array>(batch->column(0));
+    for (int64_t i = 0; i < column->length(); ++i) {
+      ids.push_back(column->Value(i));
+    }
+  }
+  std::ranges::sort(ids);
+  return ids;
+}
+
+}  // namespace
+
+TEST(ArrowFilterTest, ConvertsPredicates) {
+  auto expect_converted = [](const cp::Expression& filter,
+                             const std::shared_ptr<Expression>& expected) {
+    auto conversion = FromArrowExpression(filter);
+    EXPECT_TRUE(conversion.exact) << filter.ToString();
+    EXPECT_EQ(conversion.filter->ToString(), expected->ToString()) << filter.ToString();
+  };
+  expect_converted(cp::greater(cp::field_ref("id"), cp::literal(int64_t{3})),
+                   Expressions::GreaterThan("id", Literal::Long(3)));
+  // Comparisons with the literal first are flipped.
+  expect_converted(cp::less_equal(cp::literal(int64_t{3}), cp::field_ref("id")),
+                   Expressions::GreaterThanOrEqual("id", Literal::Long(3)));
+  expect_converted(cp::not_equal(cp::field_ref("data"), cp::literal(std::string("a"))),
+                   Expressions::NotEqual("data", Literal::String("a")));
+  expect_converted(cp::is_null(cp::field_ref("data")), Expressions::IsNull("data"));
+  expect_converted(cp::is_valid(cp::field_ref("data")), Expressions::NotNull("data"));
+  expect_converted(
+      cp::call("starts_with", {cp::field_ref("data")},
+               cp::MatchSubstringOptions("ab")),
+      Expressions::StartsWith("data", "ab"));
+  auto value_set = ::arrow::json::ArrayFromJSONString(::arrow::int64(), "[1, 2]")
+                       .ValueOrDie();
+  expect_converted(cp::call("is_in", {cp::field_ref("id")},
+                            cp::SetLookupOptions(value_set)),
+                   Expressions::In("id", {Literal::Long(1), Literal::Long(2)}));
+  expect_converted(
+      cp::or_(cp::equal(cp::field_ref("id"), cp::literal(int64_t{1})),
+              cp::not_(cp::is_null(cp::field_ref("data")))),
+      Expressions::Or(Expressions::Equal("id", Literal::Long(1)),
+                      Expressions::Not(Expressions::IsNull("data"))));
+  expect_converted(cp::literal(false), Expressions::AlwaysFalse());
+}
+
+TEST(ArrowFilterTest, DropsUnsupportedExpressions) {
+  auto unsupported = cp::equal(
+      cp::call("add", {cp::field_ref("id"), cp::literal(int64_t{1})}),
+      cp::literal(int64_t{3}));
+
+  // An unsupported conjunct is dropped, the other one is still pushed down.
+  auto conversion = FromArrowExpression(
+      cp::and_(cp::less(cp::field_ref("id"), cp::literal(int64_t{5})), unsupported));
+  EXPECT_FALSE(conversion.exact);
+  EXPECT_EQ(conversion.filter->ToString(),
+            Expressions::LessThan("id", Literal::Long(5))->ToString());
+
+  // A disjunction or a negation of an unsupported expression matches any row.
+  conversion = FromArrowExpression(
+      cp::or_(cp::less(cp::field_ref("id"), cp::literal(int64_t{5})), unsupported));
+  EXPECT_FALSE(conversion.exact);
+  EXPECT_EQ(conversion.filter->op(), Expression::Operation::kTrue);
+  conversion = FromArrowExpression(cp::not_(cp::and_(
+      cp::less(cp::field_ref("id"), cp::literal(int64_t{5})), unsupported)));
+  EXPECT_FALSE(conversion.exact);
+  EXPECT_EQ(conversion.filter->op(), Expression::Operation::kTrue);
+
+  // Comparisons with null are not converted.
+  conversion = FromArrowExpression(cp::equal(
+      cp::field_ref("id"), cp::literal(::arrow::MakeNullScalar(::arrow::int64()))));
+  EXPECT_FALSE(conversion.exact);
+  EXPECT_EQ(conversion.filter->op(), Expression::Operation::kTrue);
+}
+
+class ArrowScanTest : public TableTestBase {
+ protected:
+  static void SetUpTestSuite() {
+    avro::RegisterAll();
+    parquet::RegisterAll();
+  }
+
+  void SetUp() override {
+    TableTestBase::SetUp();
+    std::filesystem::create_directories(table_location_ + "/data");
+    schema_ = std::make_shared<Schema>(
+        std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int64()),
+                                 SchemaField::MakeOptional(2, "data", string())},
+        /*schema_id=*/0);
+    ASSERT_NO_FATAL_FAILURE(CreateTable());
+  }
+
+  // Appends the rows to the table in a new data file.
+  void AppendRows(const std::string& rows_json) {
+    auto type = ::arrow::struct_({::arrow::field("id", ::arrow::int64(), false),
+                                  ::arrow::field("data", ::arrow::utf8())});
+    auto array = ::arrow::json::ArrayFromJSONString(type, rows_json).ValueOrDie();
+    ArrowArray batch;
+    ASSERT_TRUE(::arrow::ExportArray(*array, &batch).ok());
+    ICEBERG_UNWRAP_OR_FAIL(
+        auto writer,
+        FanoutDataWriter::Make(PartitionedWriterOptions{
+            .schema = schema_,
+            .spec = PartitionSpec::Unpartitioned(),
+            .io = file_io_,
+            .location_provider =
+                std::make_shared<DirectoryLocationProvider>(table_location_ + "/data"),
+        }));
+    ASSERT_THAT(writer->Write(&batch), IsOk());
+    ICEBERG_UNWRAP_OR_FAIL(auto files, writer->Close());
+    FastAppend append(table_);
+    for (auto& file : files) {
+      append.AppendFile(std::make_shared<DataFile>(std::move(file)));
+    }
+    ASSERT_THAT(append.Commit(), IsOk());
+  }
+};
+
+TEST_F(ArrowScanTest, PushesDownProjectionAndFilter) {
+  ASSERT_NO_FATAL_FAILURE(AppendRows(R"([[1, "a"], [2, "b"], [3, "c"]])"));
+  ASSERT_NO_FATAL_FAILURE(AppendRows(R"([[4, "d"], [5, "e"]])"));
+
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto scan,
+      ArrowScan::Make(table_->NewScan(),
+                      cp::greater(cp::field_ref("id"), cp::literal(int64_t{3})), {"id"}));
+  EXPECT_TRUE(scan->filter_exact());
+  ASSERT_EQ(scan->schema()->num_fields(), 1);
+  EXPECT_EQ(scan->schema()->field(0)->name(), "id");
+
+  // The first file is skipped by its metrics.
+  ICEBERG_UNWRAP_OR_FAIL(auto fragments, scan->GetFragments());
+  ASSERT_EQ(fragments.size(), 1);
+  ASSERT_EQ(fragments[0].task()->files_count(), 1);
+  ICEBERG_UNWRAP_OR_FAIL(auto reader, fragments[0].ToRecordBatchReader());
+  EXPECT_EQ(ReadIds(*reader), (std::vector<int64_t>{4, 5}));
+
+  ICEBERG_UNWRAP_OR_FAIL(reader, scan->ToRecordBatchReader(/*parallelism=*/2));
+  EXPECT_EQ(reader->schema()->num_fields(), 1);
+  EXPECT_EQ(ReadIds(*reader), (std::vector<int64_t>{4, 5}));
+}
+
+TEST_F(ArrowScanTest, ReadsFragmentsIndependently) {
+  ASSERT_NO_FATAL_FAILURE(AppendRows(R"([[1, "a"], [2, "b"]])"));
+  ASSERT_NO_FATAL_FAILURE(AppendRows(R"([[3, "c"]])"));
+
+  // Each file is planned in its own task with a tiny split size.
+  auto builder = table_->NewScan();
+  builder->WithOption("read.split.target-size", "1");
+  ICEBERG_UNWRAP_OR_FAIL(auto scan,
+                         ArrowScan::Make(std::move(builder), cp::literal(true)));
+  EXPECT_TRUE(scan->filter_exact());
+  EXPECT_EQ(scan->schema()->num_fields(), 2);
+  ICEBERG_UNWRAP_OR_FAIL(auto fragments, scan->GetFragments());
+  ASSERT_EQ(fragments.size(), 2);
+  std::vector<int64_t> ids;
+  for (const auto& fragment : fragments) {
+    ICEBERG_UNWRAP_OR_FAIL(auto reader, fragment.ToRecordBatchReader());
+    std::ranges::copy(ReadIds(*reader), std::back_inserter(ids));
+  }
+  std::ranges::sort(ids);
+  EXPECT_EQ(ids, (std::vector<int64_t>{1, 2, 3}));
+
+  // Unknown columns fail the scan.
+  EXPECT_FALSE(ArrowScan::Make(table_->NewScan(), cp::literal(true), {"missing"})
+                   .has_value());
+  ICEBERG_UNWRAP_OR_FAIL(
+      scan, ArrowScan::Make(table_->NewScan(), cp::equal(cp::field_ref("missing"),
+                                                         cp::literal(int64_t{1}))));
+  EXPECT_FALSE(scan->GetFragments().has_value());
+  EXPECT_THAT(fragments[0].ToRecordBatchReader(/*prefetch_batches=*/-1),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+}  // namespace iceberg::arrow
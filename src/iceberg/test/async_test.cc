@@ -0,0 +1,162 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/async.h"
+
+#include <atomic>
+#include <cerrno>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/file_io.h"
+#include "iceberg/test/matchers.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief A FileIO of in-memory files.
+class MemoryFileIO : public FileIO {
+ public:
+  Result<std::string> ReadFile(const std::string& file_location,
+                               std::optional<size_t> length) override {
+    auto it = files_.find(file_location);
+    if (it == files_.cend()) {
+      return IOError("File {} does not exist", file_location);
+    }
+    return it->second;
+  }
+
+  std::unordered_map<std::string, std::string> files_;
+};
+
+/// \brief A stream of `remaining` empty batches.
+struct CountingStream {
+  static int GetNext(ArrowArrayStream* stream, ArrowArray* out) {
+    auto* remaining = static_cast<int32_t*>(stream->private_data);
+    *out = ArrowArray{};
+    if (*remaining == 0) {
+      return 0;
+    }
+    if (--*remaining < 0) {
+      return EIO;
+    }
+    out->release = [](ArrowArray* array) { array->release = nullptr; };
+    return 0;
+  }
+
+  static const char* GetLastError(ArrowArrayStream*) { return nullptr; }
+
+  explicit CountingStream(int32_t batches) : remaining(batches) {
+    stream.get_next = &GetNext;
+    stream.get_last_error = &GetLastError;
+    stream.private_data = &remaining;
+  }
+
+  int32_t remaining;
+  ArrowArrayStream stream{};
+};
+
+Task<int64_t> Add(int64_t left, int64_t right) { co_return left + right; }
+
+Task<int64_t> Sum(int32_t count) {
+  int64_t sum = 0;
+  for (int32_t i = 0; i < count; ++i) {
+    sum = co_await Add(sum, i);
+  }
+  co_return sum;
+}
+
+Task<Result<int32_t>> Fail() {
+  throw std::runtime_error("failed");
+  co_return 0;
+}
+
+}  // namespace
+
+TEST(AsyncTest, AwaitsNestedTasks) {
+  EXPECT_EQ(SyncWait(Add(1, 2)), 3);
+  EXPECT_EQ(SyncWait(Sum(1000)), 499500);
+}
+
+TEST(AsyncTest, PropagatesExceptions) {
+  EXPECT_THROW(SyncWait(Fail()), std::runtime_error);
+}
+
+TEST(AsyncTest, RunsOnExecutor) {
+  ICEBERG_UNWRAP_OR_FAIL(std::shared_ptr<Executor> pool, ThreadPoolExecutor::Make(2));
+  auto caller = std::this_thread::get_id();
+  auto thread = SyncWait(RunOn(pool, []() { return std::this_thread::get_id(); }));
+  EXPECT_NE(thread, caller);
+
+  auto resumed = SyncWait([](std::shared_ptr<Executor> pool) -> Task<std::thread::id> {
+    co_await ScheduleOn(*pool);
+    co_return std::this_thread::get_id();
+  }(pool));
+  EXPECT_NE(resumed, caller);
+}
+
+TEST(AsyncTest, MultiplexesTasksOnFewThreads) {
+  ICEBERG_UNWRAP_OR_FAIL(std::shared_ptr<Executor> pool, ThreadPoolExecutor::Make(2));
+  std::atomic<int32_t> calls = 0;
+  auto total = SyncWait([](std::shared_ptr<Executor> pool,
+                           std::atomic<int32_t>& calls) -> Task<int64_t> {
+    int64_t total = 0;
+    for (int32_t i = 0; i < 10000; ++i) {
+      total += co_await RunOn(pool, [&calls, i]() {
+        ++calls;
+        return i;
+      });
+    }
+    co_return total;
+  }(pool, calls));
+  EXPECT_EQ(total, 49995000);
+  EXPECT_EQ(calls, 10000);
+}
+
+TEST(AsyncTest, ReadsFiles) {
+  MemoryFileIO io;
+  io.files_["a"] = "content";
+  EXPECT_THAT(SyncWait(io.ReadFileAsync("a", std::nullopt)),
+              HasValue(::testing::Eq("content")));
+  EXPECT_THAT(SyncWait(io.ReadFileAsync("b", std::nullopt)),
+              IsError(ErrorKind::kIOError));
+}
+
+TEST(AsyncTest, ReadsStreams) {
+  CountingStream counting(2);
+  for (int32_t i = 0; i < 2; ++i) {
+    ICEBERG_UNWRAP_OR_FAIL(auto batch, SyncWait(NextAsync(&counting.stream)));
+    ASSERT_TRUE(batch.has_value());
+    batch->release(&batch.value());
+  }
+  ICEBERG_UNWRAP_OR_FAIL(auto end, SyncWait(NextAsync(&counting.stream)));
+  EXPECT_FALSE(end.has_value());
+
+  counting.remaining = -1;
+  EXPECT_THAT(SyncWait(NextAsync(&counting.stream)), IsError(ErrorKind::kIOError));
+}
+
+}  // namespace iceberg
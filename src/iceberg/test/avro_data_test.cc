@@ -29,6 +29,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "iceberg/arrow/arrow_metadata_columns_internal.h"
 #include "iceberg/avro/avro_data_util_internal.h"
 #include "iceberg/avro/avro_schema_util_internal.h"
 #include "iceberg/schema.h"
@@ -76,7 +77,8 @@ void VerifyAppendDatumToBuilder(const Schema& projected_schema,
   ASSERT_THAT(ToArrowSchema(projected_schema, &arrow_c_schema), IsOk());
   auto arrow_schema = ::arrow::ImportSchema(&arrow_c_schema).ValueOrDie();
   auto arrow_struct_type = std::make_shared<::arrow::StructType>(arrow_schema->fields());
-  auto builder = ::arrow::MakeBuilder(arrow_struct_type).ValueOrDie();
+  auto storage_type = arrow::StorageType(arrow_struct_type);
+  auto builder = ::arrow::MakeBuilder(storage_type).ValueOrDie();
 
   // Call AppendDatumToBuilder repeatedly to append the datum
   for (const auto& avro_datum : avro_data) {
@@ -86,10 +88,11 @@ void VerifyAppendDatumToBuilder(const Schema& projected_schema,
   }
 
   // Verify the result
-  auto array = builder->Finish().ValueOrDie();
-  auto expected_array =
-      ::arrow::json::ArrayFromJSONString(arrow_struct_type, expected_array_json)
-          .ValueOrDie();
+  auto array = arrow::ViewAsType(builder->Finish().ValueOrDie(), arrow_struct_type);
+  ASSERT_TRUE(array->type()->Equals(*arrow_struct_type));
+  auto expected_array = arrow::ViewAsType(
+      ::arrow::json::ArrayFromJSONString(storage_type, expected_array_json).ValueOrDie(),
+      arrow_struct_type);
   ASSERT_TRUE(array->Equals(*expected_array))
       << "array: " << array->ToString()
       << "\nexpected_array: " << expected_array->ToString();
@@ -210,24 +213,22 @@ const std::vector<AppendDatumParam> kPrimitiveTestCases = {
             },
         .expected_json = R"([{"a": "abcd"}, {"a": "bcde"}, {"a": "cdef"}])",
     },
-    /// FIXME: NotImplemented: MakeBuilder: cannot construct builder for type
-    /// extension<arrow.uuid>. Need to fix this in the upstream Arrow.
-    // {
-    //     .name = "UUID",
-    //     .projected_type = iceberg::uuid(),
-    //     .source_type = iceberg::uuid(),
-    //     .value_setter =
-    //         [](::avro::GenericDatum& datum, int i) {
-    //           datum.value<::avro::GenericRecord>()
-    //               .fieldAt(0)
-    //               .value<::avro::GenericFixed>()
-    //               .value() = {'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h',
-    //                           'i', 'j', 'k', 'l', 'm', 'n', 'o',
-    //                           static_cast<uint8_t>(i)};
-    //         },
-    //     .expected_json = R"([{"a": "abcdefghijklmnop"}, {"a": "bcdefghijklmnopq"},
-    //     {"a": "cdefghijklmnopqr"}])",
-    // },
+    {
+        .name = "UUID",
+        .projected_type = iceberg::uuid(),
+        .source_type = iceberg::uuid(),
+        .value_setter =
+            [](::avro::GenericDatum& datum, int i) {
+              datum.value<::avro::GenericRecord>()
+                  .fieldAt(0)
+                  .value<::avro::GenericFixed>()
+                  .value() = {'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h',
+                              'i', 'j', 'k', 'l', 'm', 'n', 'o',
+                              static_cast<uint8_t>('p' + i)};
+            },
+        .expected_json = R"([{"a": "abcdefghijklmnop"}, {"a": "abcdefghijklmnoq"},
+                             {"a": "abcdefghijklmnor"}])",
+    },
     {
         .name = "Decimal",
         .projected_type = iceberg::decimal(10, 2),
@@ -17,7 +17,9 @@
  * under the License.
  */
 
+#include <arrow/buffer.h>
 #include <arrow/filesystem/localfs.h>
+#include <arrow/io/memory.h>
 #include <arrow/result.h>
 #include <gtest/gtest.h>
 
@@ -341,4 +343,65 @@ TEST_F(AVROStreamTest, OutputStreamLargeData) {
   EXPECT_EQ(avro_input_stream->byteCount(), test_data.size());
 }
 
+TEST_F(AVROStreamTest, InputStreamBlocksZeroCopy) {
+  std::string test_data(buffer_size_ * 5 / 2, '\0');
+  for (size_t i = 0; i < test_data.size(); ++i) {
+    test_data[i] = static_cast<char>(i % 256);
+  }
+  auto source = ::arrow::Buffer::FromString(test_data);
+  AvroInputStream avro_input_stream(std::make_shared<::arrow::io::BufferReader>(source),
+                                    buffer_size_, AvroInputStream::ReadMode::kBlocks);
+
+  // Without Avro blocks to follow, ranges of buffer_size are read from the source.
+  std::vector<size_t> lengths;
+  const uint8_t* data{};
+  size_t len{};
+  while (avro_input_stream.next(&data, &len)) {
+    EXPECT_EQ(data, source->data() + avro_input_stream.byteCount() - len);
+    lengths.push_back(len);
+  }
+  EXPECT_EQ(lengths, (std::vector<size_t>{1024, 1024, 512}));
+  EXPECT_EQ(avro_input_stream.byteCount(), test_data.size());
+
+  avro_input_stream.seek(100);
+  ASSERT_TRUE(avro_input_stream.next(&data, &len));
+  EXPECT_EQ(data, source->data() + 100);
+  EXPECT_EQ(len, static_cast<size_t>(buffer_size_));
+  avro_input_stream.backup(24);
+  avro_input_stream.skip(1000);
+  ASSERT_TRUE(avro_input_stream.next(&data, &len));
+  EXPECT_EQ(data, source->data() + 2100);
+  EXPECT_EQ(len, test_data.size() - 2100);
+}
+
+TEST_F(AVROStreamTest, InputStreamBlocksFollowAvroBlocks) {
+  const std::string sync(16, 'S');
+  // A file header without metadata, followed by a block of one object of 2000 bytes
+  // and a block of one object of 8 bytes.
+  std::string file = std::string("Obj\x01", 4) + '\0' + sync;
+  const size_t first_block = file.size();
+  file += std::string("\x02\xa0\x1f", 3) + std::string(2000, 'a') + sync;
+  const size_t second_block = file.size();
+  file += std::string("\x02\x10", 2) + std::string(8, 'b') + sync;
+
+  constexpr size_t kRangeSize = 256;
+  auto source = ::arrow::Buffer::FromString(file);
+  AvroInputStream avro_input_stream(std::make_shared<::arrow::io::BufferReader>(source),
+                                    kRangeSize, AvroInputStream::ReadMode::kBlocks);
+
+  const uint8_t* data{};
+  size_t len{};
+  ASSERT_TRUE(avro_input_stream.next(&data, &len));
+  EXPECT_EQ(len, kRangeSize);
+  EXPECT_LT(first_block, kRangeSize);
+  // The rest of the first block is read at once, however large.
+  ASSERT_TRUE(avro_input_stream.next(&data, &len));
+  EXPECT_EQ(data, source->data() + kRangeSize);
+  EXPECT_EQ(len, second_block - kRangeSize);
+  ASSERT_TRUE(avro_input_stream.next(&data, &len));
+  EXPECT_EQ(len, file.size() - second_block);
+  EXPECT_FALSE(avro_input_stream.next(&data, &len));
+  EXPECT_EQ(avro_input_stream.byteCount(), file.size());
+}
+
 }  // namespace iceberg::avro
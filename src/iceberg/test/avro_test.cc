@@ -17,7 +17,12 @@
  * under the License.
  */
 
+#include <algorithm>
+#include <numeric>
+
 #include <arrow/array/array_base.h>
+#include <arrow/array/array_nested.h>
+#include <arrow/array/array_primitive.h>
 #include <arrow/c/bridge.h>
 #include <arrow/filesystem/localfs.h>
 #include <arrow/io/file.h>
@@ -29,11 +34,18 @@
 #include <gtest/gtest.h>
 
 #include "iceberg/arrow/arrow_fs_file_io_internal.h"
+#include "iceberg/avro/avro_reader.h"
 #include "iceberg/avro/avro_register.h"
 #include "iceberg/avro/avro_writer.h"
+#include "iceberg/deletes/position_delete_index.h"
+#include "iceberg/executor.h"
+#include "iceberg/expression/literal.h"
 #include "iceberg/file_reader.h"
+#include "iceberg/metrics.h"
+#include "iceberg/name_mapping.h"
 #include "iceberg/schema.h"
 #include "iceberg/schema_internal.h"
+#include "iceberg/table_properties.h"
 #include "iceberg/test/matchers.h"
 #include "iceberg/test/temp_file_test_base.h"
 #include "iceberg/type.h"
@@ -106,8 +118,8 @@ class AvroReaderTest : public TempFileTestBase {
     ASSERT_FALSE(data.value().has_value());
   }
 
-  void WriteAndVerify(std::shared_ptr<Schema> schema,
-                      const std::string& expected_string) {
+  void WriteAvroFile(std::shared_ptr<Schema> schema, const std::string& json,
+                     int64_t* length = nullptr, Metrics* metrics = nullptr) {
     ArrowSchema arrow_c_schema;
     ASSERT_THAT(ToArrowSchema(*schema, &arrow_c_schema), IsOk());
 
@@ -115,7 +127,7 @@ class AvroReaderTest : public TempFileTestBase {
     ASSERT_TRUE(arrow_schema_result.ok());
     auto arrow_schema = arrow_schema_result.ValueOrDie();
 
-    auto array_result = ::arrow::json::ArrayFromJSONString(arrow_schema, expected_string);
+    auto array_result = ::arrow::json::ArrayFromJSONString(arrow_schema, json);
     ASSERT_TRUE(array_result.ok());
     auto array = array_result.ValueOrDie();
 
@@ -125,15 +137,30 @@ class AvroReaderTest : public TempFileTestBase {
 
     auto writer_result = WriterFactoryRegistry::Open(
         FileFormatType::kAvro,
-        {.path = temp_avro_file_, .schema = schema, .io = file_io_});
+        {.path = temp_avro_file_,
+         .schema = schema,
+         .io = file_io_,
+         .properties = writer_properties_});
     ASSERT_TRUE(writer_result.has_value());
     auto writer = std::move(writer_result.value());
     ASSERT_THAT(writer->Write(&arrow_array), IsOk());
     ASSERT_THAT(writer->Close(), IsOk());
+    if (length != nullptr) {
+      *length = writer->length().value();
+    }
+    if (metrics != nullptr) {
+      *metrics = writer->metrics().value();
+    }
+  }
+
+  void WriteAndVerify(std::shared_ptr<Schema> schema,
+                      const std::string& expected_string) {
+    int64_t writer_length = 0;
+    ASSERT_NO_FATAL_FAILURE(WriteAvroFile(schema, expected_string, &writer_length));
 
     auto file_info_result = local_fs_->GetFileInfo(temp_avro_file_);
     ASSERT_TRUE(file_info_result.ok());
-    ASSERT_EQ(file_info_result->size(), writer->length().value());
+    ASSERT_EQ(file_info_result->size(), writer_length);
 
     auto reader_result = ReaderFactoryRegistry::Open(FileFormatType::kAvro,
                                                      {.path = temp_avro_file_,
@@ -146,9 +173,50 @@ class AvroReaderTest : public TempFileTestBase {
     ASSERT_NO_FATAL_FAILURE(VerifyExhausted(*reader));
   }
 
+  static std::shared_ptr<Schema> NestedSchema() {
+    return std::make_shared<Schema>(std::vector<SchemaField>{
+        SchemaField::MakeRequired(1, "id", int32()),
+        SchemaField::MakeOptional(2, "name", string()),
+        SchemaField::MakeOptional(3, "tags",
+                                  std::make_shared<ListType>(SchemaField::MakeOptional(
+                                      4, "element", string()))),
+        SchemaField::MakeOptional(
+            5, "props",
+            std::make_shared<MapType>(SchemaField::MakeRequired(6, "key", string()),
+                                      SchemaField::MakeOptional(7, "value", int32()))),
+        SchemaField::MakeOptional(
+            8, "codes",
+            std::make_shared<MapType>(SchemaField::MakeRequired(9, "key", int32()),
+                                      SchemaField::MakeOptional(10, "value", string()))),
+        SchemaField::MakeOptional(
+            11, "point",
+            std::make_shared<StructType>(std::vector<SchemaField>{
+                SchemaField::MakeRequired(12, "x", float64()),
+                SchemaField::MakeOptional(13, "y", float64())}))});
+  }
+
+  static constexpr std::string_view kNestedRows = R"([
+      [1, "a", ["x", null], [["k1", 1], ["k2", null]], [[1, "one"]], [1.5, null]],
+      [2, null, null, null, null, null],
+      [3, "c", [], [], [[2, "two"], [3, null]], [2.5, 3.5]]])";
+
+  Result<std::unique_ptr<Reader>> OpenReader(
+      std::shared_ptr<Schema> projection, bool decode_datum,
+      std::shared_ptr<const PositionDeleteIndex> position_deletes = nullptr) {
+    ReaderOptions options{.path = temp_avro_file_,
+                          .io = file_io_,
+                          .projection = std::move(projection),
+                          .position_deletes = std::move(position_deletes)};
+    if (decode_datum) {
+      options.properties.emplace(AvroReader::kDecodeDatumProperty, "true");
+    }
+    return ReaderFactoryRegistry::Open(FileFormatType::kAvro, options);
+  }
+
   std::shared_ptr<::arrow::fs::LocalFileSystem> local_fs_;
   std::shared_ptr<FileIO> file_io_;
   std::string temp_avro_file_;
+  std::unordered_map<std::string, std::string> writer_properties_;
 };
 
 TEST_F(AvroReaderTest, ReadTwoFields) {
@@ -168,6 +236,54 @@ TEST_F(AvroReaderTest, ReadTwoFields) {
   ASSERT_NO_FATAL_FAILURE(VerifyExhausted(*reader));
 }
 
+TEST_F(AvroReaderTest, ReadWithNameMapping) {
+  auto avro_schema = ::avro::compileJsonSchemaFromString(R"({
+    "type": "record",
+    "name": "TestRecord",
+    "fields": [
+      {"name": "id", "type": "int"},
+      {"name": "name", "type": ["null", "string"]}
+    ]
+  })");
+  {
+    ::avro::DataFileWriter<::avro::GenericDatum> writer(temp_avro_file_.c_str(),
+                                                        avro_schema);
+    ::avro::GenericDatum datum(avro_schema.root());
+    auto& record = datum.value<::avro::GenericRecord>();
+    record.fieldAt(0).value<int32_t>() = 1;
+    record.fieldAt(1).selectBranch(1);
+    record.fieldAt(1).value<std::string>() = "Alice";
+    writer.write(datum);
+    writer.close();
+  }
+
+  std::vector<MappedField> fields;
+  fields.emplace_back(MappedField{.names = {"id"}, .field_id = 1});
+  fields.emplace_back(MappedField{.names = {"name"}, .field_id = 2});
+  std::shared_ptr<NameMapping> name_mapping = NameMapping::Make(std::move(fields));
+
+  // The resolution of the mapping is shared by the readers of files with the same
+  // schema, and each projection is resolved on its own.
+  auto two_fields = std::make_shared<Schema>(std::vector<SchemaField>{
+      SchemaField::MakeRequired(1, "id", int32()),
+      SchemaField::MakeOptional(2, "name", string())});
+  auto one_field = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeOptional(2, "name", string())});
+  for (const auto& [schema, expected] :
+       {std::make_pair(two_fields, R"([[1, "Alice"]])"),
+        std::make_pair(two_fields, R"([[1, "Alice"]])"),
+        std::make_pair(one_field, R"([["Alice"]])")}) {
+    ICEBERG_UNWRAP_OR_FAIL(auto reader,
+                           ReaderFactoryRegistry::Open(FileFormatType::kAvro,
+                                                       {.path = temp_avro_file_,
+                                                        .io = file_io_,
+                                                        .projection = schema,
+                                                        .name_mapping = name_mapping}));
+    ASSERT_NO_FATAL_FAILURE(VerifyNextBatch(*reader, expected));
+    ASSERT_NO_FATAL_FAILURE(VerifyExhausted(*reader));
+  }
+}
+
 TEST_F(AvroReaderTest, ReadReorderedFieldsWithNulls) {
   CreateSimpleAvroFile();
   auto schema = std::make_shared<Schema>(std::vector<SchemaField>{
@@ -226,4 +342,270 @@ TEST_F(AvroReaderTest, AvroWriterNestedType) {
   WriteAndVerify(schema, expected_string);
 }
 
+TEST_F(AvroReaderTest, AvroWriterMetrics) {
+  auto schema = std::make_shared<iceberg::Schema>(std::vector<SchemaField>{
+      SchemaField::MakeRequired(1, "id", std::make_shared<IntType>()),
+      SchemaField::MakeOptional(2, "name", std::make_shared<StringType>())});
+  writer_properties_ = {{"write.metadata.metrics.column.name", "truncate(2)"}};
+
+  Metrics metrics;
+  ASSERT_NO_FATAL_FAILURE(WriteAvroFile(
+      schema, R"([[3, "Carol"], [1, null], [2, "Alice"]])", nullptr, &metrics));
+  EXPECT_EQ(metrics.row_count, 3);
+  EXPECT_EQ(metrics.value_counts.at(1), 3);
+  EXPECT_EQ(metrics.null_value_counts.at(2), 1);
+  EXPECT_EQ(metrics.lower_bounds.at(1), Literal::Int(1));
+  EXPECT_EQ(metrics.upper_bounds.at(1), Literal::Int(3));
+  EXPECT_EQ(metrics.lower_bounds.at(2), Literal::String("Al"));
+  EXPECT_EQ(metrics.upper_bounds.at(2), Literal::String("Cb"));
+}
+
+TEST_F(AvroReaderTest, DirectDecoderMatchesDatumDecoder) {
+  ASSERT_NO_FATAL_FAILURE(WriteAvroFile(NestedSchema(), std::string(kNestedRows)));
+
+  for (bool decode_datum : {false, true}) {
+    SCOPED_TRACE(decode_datum);
+    auto reader = OpenReader(NestedSchema(), decode_datum);
+    ASSERT_THAT(reader, IsOk());
+    ASSERT_NO_FATAL_FAILURE(VerifyNextBatch(**reader, kNestedRows));
+    ASSERT_NO_FATAL_FAILURE(VerifyExhausted(**reader));
+  }
+}
+
+TEST_F(AvroReaderTest, DirectDecoderSkipsUnprojectedFields) {
+  ASSERT_NO_FATAL_FAILURE(WriteAvroFile(NestedSchema(), std::string(kNestedRows)));
+  auto projection = std::make_shared<Schema>(std::vector<SchemaField>{
+      SchemaField::MakeOptional(
+          11, "point",
+          std::make_shared<StructType>(
+              std::vector<SchemaField>{SchemaField::MakeOptional(13, "y", float64())})),
+      SchemaField::MakeRequired(1, "id", int32()),
+      SchemaField::MakeOptional(20, "missing", string())});
+
+  auto reader = OpenReader(projection, /*decode_datum=*/false);
+  ASSERT_THAT(reader, IsOk());
+  ASSERT_NO_FATAL_FAILURE(VerifyNextBatch(
+      **reader, R"([[[null], 1, null], [null, 2, null], [[3.5], 3, null]])"));
+  ASSERT_NO_FATAL_FAILURE(VerifyExhausted(**reader));
+}
+
+TEST_F(AvroReaderTest, DirectEncoderMatchesDatumEncoder) {
+  auto schema = std::make_shared<Schema>(std::vector<SchemaField>{
+      SchemaField::MakeRequired(1, "id", int64()),
+      SchemaField::MakeOptional(2, "flag", boolean()),
+      SchemaField::MakeOptional(3, "amount", decimal(10, 2)),
+      SchemaField::MakeOptional(4, "payload", binary()),
+      SchemaField::MakeOptional(5, "day", date())});
+  constexpr std::string_view kRows = R"([
+      [1, true, "123.45", "abc", 19724],
+      [2, null, "-0.01", null, null],
+      [3, false, null, "", 0]])";
+
+  for (bool encode_datum : {false, true}) {
+    SCOPED_TRACE(encode_datum);
+    writer_properties_.clear();
+    if (encode_datum) {
+      writer_properties_.emplace(AvroWriter::kEncodeDatumProperty, "true");
+    }
+    ASSERT_NO_FATAL_FAILURE(WriteAvroFile(NestedSchema(), std::string(kNestedRows)));
+    auto nested_reader = OpenReader(NestedSchema(), /*decode_datum=*/false);
+    ASSERT_THAT(nested_reader, IsOk());
+    ASSERT_NO_FATAL_FAILURE(VerifyNextBatch(**nested_reader, kNestedRows));
+    ASSERT_NO_FATAL_FAILURE(VerifyExhausted(**nested_reader));
+
+    ASSERT_NO_FATAL_FAILURE(WriteAvroFile(schema, std::string(kRows)));
+    auto reader = OpenReader(schema, /*decode_datum=*/false);
+    ASSERT_THAT(reader, IsOk());
+    ASSERT_NO_FATAL_FAILURE(VerifyNextBatch(**reader, kRows));
+    ASSERT_NO_FATAL_FAILURE(VerifyExhausted(**reader));
+  }
+}
+
+TEST_F(AvroReaderTest, SkipDeletedPositions) {
+  ASSERT_NO_FATAL_FAILURE(WriteAvroFile(NestedSchema(), std::string(kNestedRows)));
+  auto deletes = std::make_shared<PositionDeleteIndex>();
+  deletes->Delete(0);
+  deletes->Delete(2);
+
+  for (bool decode_datum : {false, true}) {
+    SCOPED_TRACE(decode_datum);
+    auto reader = OpenReader(NestedSchema(), decode_datum, deletes);
+    ASSERT_THAT(reader, IsOk());
+    ASSERT_NO_FATAL_FAILURE(
+        VerifyNextBatch(**reader, R"([[2, null, null, null, null, null]])"));
+    ASSERT_NO_FATAL_FAILURE(VerifyExhausted(**reader));
+  }
+}
+
+TEST_F(AvroReaderTest, ReadCompressedFiles) {
+  const std::vector<std::pair<std::string, std::string>> codecs = {
+      {"uncompressed", "null"},
+      {"gzip", "deflate"},
+      {"snappy", "snappy"},
+      {"zstd", "zstandard"}};
+  for (const auto& [codec, avro_codec] : codecs) {
+    SCOPED_TRACE(codec);
+    writer_properties_ = {{TableProperties::kAvroCompression.key(), codec},
+                          {TableProperties::kAvroCompressionLevel.key(), "3"},
+                          {"custom", "value"}};
+    // Snappy and zstd are only available if the Avro library is built with them.
+    auto probe = WriterFactoryRegistry::Open(
+        FileFormatType::kAvro, {.path = CreateNewTempFilePathWithSuffix(".avro"),
+                                .schema = NestedSchema(),
+                                .io = file_io_,
+                                .properties = writer_properties_});
+    if (!probe.has_value() && probe.error().kind == ErrorKind::kNotSupported) {
+      continue;
+    }
+    ASSERT_THAT(probe, IsOk());
+    ASSERT_THAT(probe.value()->Close(), IsOk());
+
+    temp_avro_file_ = CreateNewTempFilePathWithSuffix(".avro");
+    ASSERT_NO_FATAL_FAILURE(WriteAvroFile(NestedSchema(), std::string(kNestedRows)));
+    for (bool decode_datum : {false, true}) {
+      auto reader = OpenReader(NestedSchema(), decode_datum);
+      ASSERT_THAT(reader, IsOk());
+      ASSERT_NO_FATAL_FAILURE(VerifyNextBatch(**reader, kNestedRows));
+      ASSERT_NO_FATAL_FAILURE(VerifyExhausted(**reader));
+
+      auto metadata = (*reader)->Metadata();
+      ASSERT_THAT(metadata, IsOk());
+      EXPECT_EQ(metadata->at("avro.codec"), avro_codec);
+      EXPECT_EQ(metadata->at("custom"), "value");
+      EXPECT_FALSE(metadata->contains(TableProperties::kAvroCompression.key()));
+    }
+  }
+}
+
+TEST_F(AvroReaderTest, InvalidCompression) {
+  auto open_writer = [&](std::string codec, std::string level) {
+    std::unordered_map<std::string, std::string> properties = {
+        {TableProperties::kAvroCompression.key(), std::move(codec)},
+        {TableProperties::kAvroCompressionLevel.key(), std::move(level)}};
+    return WriterFactoryRegistry::Open(FileFormatType::kAvro,
+                                       {.path = temp_avro_file_,
+                                        .schema = NestedSchema(),
+                                        .io = file_io_,
+                                        .properties = std::move(properties)});
+  };
+  EXPECT_THAT(open_writer("lz4", ""), IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(open_writer("gzip", "10"), IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(open_writer("gzip", "fast"), IsError(ErrorKind::kInvalidArgument));
+  // Codecs without levels ignore them.
+  auto writer = open_writer("uncompressed", "fast");
+  ASSERT_THAT(writer, IsOk());
+  EXPECT_THAT(writer.value()->Close(), IsOk());
+}
+
+TEST_F(AvroReaderTest, DecodeBlocksInParallel) {
+  // Small blocks, compressed independently, make chunks of several blocks.
+  constexpr int32_t kNumRows = 2000;
+  auto avro_schema = ::avro::compileJsonSchemaFromString(R"({
+      "type": "record",
+      "name": "TestRecord",
+      "fields": [
+        {"name": "id", "type": "int", "field-id": 1},
+        {"name": "name", "type": "string", "field-id": 2}
+      ]
+    })");
+  {
+    ::avro::DataFileWriter<::avro::GenericDatum> writer(
+        temp_avro_file_.c_str(), avro_schema, /*syncInterval=*/512,
+        ::avro::DEFLATE_CODEC);
+    for (int32_t id = 0; id < kNumRows; ++id) {
+      ::avro::GenericDatum datum(avro_schema.root());
+      auto& record = datum.value<::avro::GenericRecord>();
+      record.fieldAt(0).value<int32_t>() = id;
+      record.fieldAt(1).value<std::string>() = "name-" + std::to_string(id);
+      writer.write(datum);
+    }
+    writer.close();
+  }
+  auto file_size = local_fs_->GetFileInfo(temp_avro_file_).ValueOrDie().size();
+  auto schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32())});
+  ICEBERG_UNWRAP_OR_FAIL(auto executor, ThreadPoolExecutor::Make(3));
+  std::shared_ptr<Executor> shared_executor = std::move(executor);
+
+  auto read_ids = [&](std::optional<Split> split, bool parallel, bool ordered,
+                      std::shared_ptr<const PositionDeleteIndex> deletes = nullptr)
+      -> Result<std::vector<int32_t>> {
+    ReaderOptions options{.path = temp_avro_file_,
+                          .split = split,
+                          .batch_size = 100,
+                          .io = file_io_,
+                          .projection = schema,
+                          .position_deletes = std::move(deletes),
+                          .executor = shared_executor};
+    if (parallel) {
+      options.properties = {{std::string(AvroReader::kDecodeParallelismProperty), "4"},
+                            {std::string(AvroReader::kDecodeChunkSizeProperty), "2048"},
+                            {std::string(AvroReader::kDecodeOrderedProperty),
+                             ordered ? "true" : "false"}};
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto reader,
+                            ReaderFactoryRegistry::Open(FileFormatType::kAvro, options));
+    ICEBERG_ASSIGN_OR_RAISE(auto c_schema, reader->Schema());
+    auto arrow_type = ::arrow::ImportType(&c_schema).ValueOrDie();
+    std::vector<int32_t> ids;
+    while (true) {
+      ICEBERG_ASSIGN_OR_RAISE(auto batch, reader->Next());
+      if (!batch.has_value()) {
+        break;
+      }
+      auto array = ::arrow::ImportArray(&batch.value(), arrow_type).ValueOrDie();
+      EXPECT_LE(array->length(), 100);
+      const auto& id_array = static_cast<const ::arrow::Int32Array&>(
+          *static_cast<const ::arrow::StructArray&>(*array).field(0));
+      ids.insert(ids.end(), id_array.raw_values(),
+                 id_array.raw_values() + id_array.length());
+    }
+    ICEBERG_RETURN_UNEXPECTED(reader->Close());
+    return ids;
+  };
+
+  std::vector<int32_t> all_ids(kNumRows);
+  std::iota(all_ids.begin(), all_ids.end(), 0);
+  ICEBERG_UNWRAP_OR_FAIL(auto ordered, read_ids(std::nullopt, true, true));
+  EXPECT_EQ(ordered, all_ids);
+  ICEBERG_UNWRAP_OR_FAIL(auto unordered, read_ids(std::nullopt, true, false));
+  std::ranges::sort(unordered);
+  EXPECT_EQ(unordered, all_ids);
+
+  // Splits hold the same blocks as with the sequential reader.
+  const size_t middle = file_size / 2;
+  for (const auto& split :
+       {Split{.offset = 0, .length = middle},
+        Split{.offset = middle, .length = static_cast<size_t>(file_size) - middle}}) {
+    ICEBERG_UNWRAP_OR_FAIL(auto sequential_ids, read_ids(split, false, true));
+    ICEBERG_UNWRAP_OR_FAIL(auto parallel_ids, read_ids(split, true, true));
+    EXPECT_FALSE(parallel_ids.empty());
+    EXPECT_EQ(parallel_ids, sequential_ids);
+  }
+
+  auto deletes = std::make_shared<PositionDeleteIndex>();
+  for (int64_t position = 0; position < kNumRows; position += 2) {
+    deletes->Delete(position);
+  }
+  ICEBERG_UNWRAP_OR_FAIL(auto remaining, read_ids(std::nullopt, true, true, deletes));
+  ASSERT_EQ(remaining.size(), static_cast<size_t>(kNumRows / 2));
+  for (size_t i = 0; i < remaining.size(); ++i) {
+    EXPECT_EQ(remaining[i], static_cast<int32_t>(2 * i + 1));
+  }
+}
+
+TEST_F(AvroReaderTest, InvalidDecodeParallelism) {
+  CreateSimpleAvroFile();
+  auto schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32())});
+  ReaderOptions options{.path = temp_avro_file_, .io = file_io_, .projection = schema};
+  options.properties = {{std::string(AvroReader::kDecodeParallelismProperty), "0"}};
+  EXPECT_THAT(ReaderFactoryRegistry::Open(FileFormatType::kAvro, options),
+              IsError(ErrorKind::kInvalidArgument));
+  options.properties = {{std::string(AvroReader::kDecodeParallelismProperty), "2"},
+                        {std::string(AvroReader::kDecodeDatumProperty), "true"}};
+  EXPECT_THAT(ReaderFactoryRegistry::Open(FileFormatType::kAvro, options),
+              IsError(ErrorKind::kNotSupported));
+}
+
 }  // namespace iceberg::avro
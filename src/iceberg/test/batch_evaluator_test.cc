@@ -0,0 +1,385 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/expression/batch_evaluator.h"
+
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/expression/expressions.h"
+#include "iceberg/expression/predicate.h"
+#include "iceberg/expression/term.h"
+#include "iceberg/schema.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief A hand-built Arrow array that owns its buffers.
+struct ArrowNode {
+  std::string format;
+  std::vector<uint8_t> validity;
+  std::vector<uint8_t> data;
+  std::vector<int32_t> offsets;
+  std::vector<std::unique_ptr<ArrowNode>> children;
+  std::unique_ptr<ArrowNode> dictionary;
+  std::vector<const void*> buffers;
+  std::vector<ArrowSchema*> child_schemas;
+  std::vector<ArrowArray*> child_arrays;
+  ArrowSchema schema{};
+  ArrowArray array{};
+
+  void SetValid(int64_t index, bool valid) {
+    if (validity.size() <= static_cast<size_t>(index / 8)) {
+      validity.resize(index / 8 + 1, 0);
+    }
+    if (valid) {
+      validity[index / 8] |= 1 << (index % 8);
+    } else {
+      ++array.null_count;
+    }
+  }
+
+  void Finish(int64_t length) {
+    for (auto& child : children) {
+      child_schemas.push_back(&child->schema);
+      child_arrays.push_back(&child->array);
+    }
+    schema.format = format.c_str();
+    schema.n_children = static_cast<int64_t>(children.size());
+    schema.children = child_schemas.data();
+    array.length = length;
+    array.n_children = static_cast<int64_t>(children.size());
+    array.children = child_arrays.data();
+    array.n_buffers = static_cast<int64_t>(buffers.size());
+    array.buffers = buffers.data();
+    if (dictionary != nullptr) {
+      schema.dictionary = &dictionary->schema;
+      array.dictionary = &dictionary->array;
+    }
+  }
+};
+
+template <typename T>
+std::unique_ptr<ArrowNode> MakePrimitive(std::string format,
+                                         const std::vector<std::optional<T>>& values) {
+  auto node = std::make_unique<ArrowNode>();
+  node->format = std::move(format);
+  node->data.resize(values.size() * sizeof(T));
+  for (size_t i = 0; i < values.size(); ++i) {
+    node->SetValid(i, values[i].has_value());
+    T value = values[i].value_or(T{});
+    std::memcpy(node->data.data() + i * sizeof(T), &value, sizeof(T));
+  }
+  node->buffers = {node->validity.data(), node->data.data()};
+  node->Finish(static_cast<int64_t>(values.size()));
+  return node;
+}
+
+std::unique_ptr<ArrowNode> MakeBooleans(const std::vector<std::optional<bool>>& values) {
+  auto node = std::make_unique<ArrowNode>();
+  node->format = "b";
+  node->data.resize(values.size() / 8 + 1, 0);
+  for (size_t i = 0; i < values.size(); ++i) {
+    node->SetValid(i, values[i].has_value());
+    if (values[i].value_or(false)) {
+      node->data[i / 8] |= 1 << (i % 8);
+    }
+  }
+  node->buffers = {node->validity.data(), node->data.data()};
+  node->Finish(static_cast<int64_t>(values.size()));
+  return node;
+}
+
+std::unique_ptr<ArrowNode> MakeStrings(
+    const std::vector<std::optional<std::string>>& values) {
+  auto node = std::make_unique<ArrowNode>();
+  node->format = "u";
+  node->offsets.push_back(0);
+  for (size_t i = 0; i < values.size(); ++i) {
+    node->SetValid(i, values[i].has_value());
+    std::string value = values[i].value_or("");
+    node->data.insert(node->data.end(), value.begin(), value.end());
+    node->offsets.push_back(static_cast<int32_t>(node->data.size()));
+  }
+  node->buffers = {node->validity.data(), node->offsets.data(), node->data.data()};
+  node->Finish(static_cast<int64_t>(values.size()));
+  return node;
+}
+
+std::unique_ptr<ArrowNode> MakeDictionary(
+    const std::vector<std::optional<int32_t>>& indices,
+    const std::vector<std::optional<std::string>>& values) {
+  auto node = MakePrimitive<int32_t>("i", indices);
+  node->dictionary = MakeStrings(values);
+  node->Finish(static_cast<int64_t>(indices.size()));
+  return node;
+}
+
+std::unique_ptr<ArrowNode> MakeStruct(std::vector<std::unique_ptr<ArrowNode>> children,
+                                      const std::vector<bool>& valid) {
+  auto node = std::make_unique<ArrowNode>();
+  node->format = "+s";
+  node->children = std::move(children);
+  for (size_t i = 0; i < valid.size(); ++i) {
+    node->SetValid(i, valid[i]);
+  }
+  node->buffers = {node->validity.data()};
+  node->Finish(static_cast<int64_t>(valid.size()));
+  return node;
+}
+
+}  // namespace
+
+class BatchEvaluatorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    schema_ = std::make_shared<Schema>(
+        std::vector<SchemaField>{
+            SchemaField::MakeRequired(1, "id", int32()),
+            SchemaField::MakeOptional(2, "data", string()),
+            SchemaField::MakeOptional(3, "value", float64()),
+            SchemaField::MakeOptional(4, "flag", boolean()),
+            SchemaField::MakeOptional(
+                5, "location",
+                std::make_shared<StructType>(std::vector<SchemaField>{
+                    SchemaField::MakeOptional(6, "city", string())}))},
+        /*schema_id=*/0);
+
+    std::vector<std::unique_ptr<ArrowNode>> location;
+    location.push_back(MakeStrings({"paris", "london", std::nullopt, "rome", "paris"}));
+
+    std::vector<std::unique_ptr<ArrowNode>> columns;
+    columns.push_back(MakePrimitive<int32_t>("i", {1, 2, 3, 4, 5}));
+    columns.push_back(
+        MakeStrings({"apple", std::nullopt, "banana", "apricot", "cherry"}));
+    columns.push_back(MakePrimitive<double>(
+        "g", {1.5, std::numeric_limits<double>::quiet_NaN(), std::nullopt, -2.0, 10.0}));
+    columns.push_back(MakeBooleans({true, false, std::nullopt, true, false}));
+    columns.push_back(MakeStruct(std::move(location), {true, false, true, true, true}));
+    batch_ = MakeStruct(std::move(columns), {true, true, true, true, true});
+  }
+
+  std::vector<int64_t> Evaluate(const std::shared_ptr<Expression>& expr) {
+    auto evaluator = BatchEvaluator::Make(*schema_, expr);
+    EXPECT_THAT(evaluator, IsOk());
+    auto bitmap = (*evaluator)->Evaluate(batch_->schema, batch_->array);
+    EXPECT_THAT(bitmap, IsOk());
+    std::vector<int64_t> selected;
+    for (int64_t i = 0; i < batch_->array.length; ++i) {
+      if ((bitmap.value()[i / 8] >> (i % 8)) & 1) {
+        selected.push_back(i);
+      }
+    }
+    return selected;
+  }
+
+  std::shared_ptr<Schema> schema_;
+  std::unique_ptr<ArrowNode> batch_;
+};
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+TEST_F(BatchEvaluatorTest, Comparison) {
+  EXPECT_THAT(Evaluate(Expressions::LessThan("id", Literal::Int(3))), ElementsAre(0, 1));
+  EXPECT_THAT(Evaluate(Expressions::LessThanOrEqual("id", Literal::Int(3))),
+              ElementsAre(0, 1, 2));
+  EXPECT_THAT(Evaluate(Expressions::GreaterThan("id", Literal::Int(3))),
+              ElementsAre(3, 4));
+  EXPECT_THAT(Evaluate(Expressions::GreaterThanOrEqual("id", Literal::Int(3))),
+              ElementsAre(2, 3, 4));
+  EXPECT_THAT(Evaluate(Expressions::Equal("id", Literal::Int(3))), ElementsAre(2));
+  EXPECT_THAT(Evaluate(Expressions::NotEqual("id", Literal::Int(3))),
+              ElementsAre(0, 1, 3, 4));
+  EXPECT_THAT(Evaluate(Expressions::Equal("flag", Literal::Boolean(true))),
+              ElementsAre(0, 3));
+  EXPECT_THAT(Evaluate(Expressions::GreaterThan("data", Literal::String("b"))),
+              ElementsAre(2, 4));
+}
+
+TEST_F(BatchEvaluatorTest, NullValues) {
+  EXPECT_THAT(Evaluate(Expressions::IsNull("data")), ElementsAre(1));
+  EXPECT_THAT(Evaluate(Expressions::NotNull("data")), ElementsAre(0, 2, 3, 4));
+  // Null values never match comparisons, but match their negation.
+  EXPECT_THAT(Evaluate(Expressions::Equal("data", Literal::String("apple"))),
+              ElementsAre(0));
+  EXPECT_THAT(Evaluate(Expressions::NotEqual("data", Literal::String("apple"))),
+              ElementsAre(1, 2, 3, 4));
+  EXPECT_THAT(Evaluate(Expressions::LessThan("flag", Literal::Boolean(true))),
+              ElementsAre(1, 4));
+}
+
+TEST_F(BatchEvaluatorTest, NaNValues) {
+  EXPECT_THAT(Evaluate(Expressions::IsNaN("value")), ElementsAre(1));
+  EXPECT_THAT(Evaluate(Expressions::NotNaN("value")), ElementsAre(0, 2, 3, 4));
+  // NaN is greater than any other value.
+  EXPECT_THAT(Evaluate(Expressions::GreaterThan("value", Literal::Double(5.0))),
+              ElementsAre(1, 4));
+  EXPECT_THAT(Evaluate(Expressions::LessThan("value", Literal::Double(0.0))),
+              ElementsAre(3));
+}
+
+TEST_F(BatchEvaluatorTest, SetPredicates) {
+  EXPECT_THAT(Evaluate(Expressions::In("id", {Literal::Int(2), Literal::Int(4)})),
+              ElementsAre(1, 3));
+  EXPECT_THAT(Evaluate(Expressions::NotIn("id", {Literal::Int(2), Literal::Int(4)})),
+              ElementsAre(0, 2, 4));
+  EXPECT_THAT(Evaluate(Expressions::In(
+                  "data", {Literal::String("cherry"), Literal::String("apple")})),
+              ElementsAre(0, 4));
+
+  std::vector<Literal> many;
+  for (int32_t i = 0; i < 100; i += 2) {
+    many.push_back(Literal::Int(i));
+  }
+  EXPECT_THAT(Evaluate(Expressions::In("id", many)), ElementsAre(1, 3));
+  EXPECT_THAT(Evaluate(Expressions::NotIn("id", many)), ElementsAre(0, 2, 4));
+
+  // Large sets are probed through a bloom filter, and sets of doubles are not indexed.
+  std::vector<Literal> strings;
+  std::vector<Literal> doubles;
+  for (int32_t i = 0; i < 5000; ++i) {
+    strings.push_back(Literal::String("fruit" + std::to_string(i)));
+    doubles.push_back(Literal::Double(100.0 + i));
+  }
+  strings.push_back(Literal::String("banana"));
+  doubles.push_back(Literal::Double(-2.0));
+  EXPECT_THAT(Evaluate(Expressions::In("data", strings)), ElementsAre(2));
+  EXPECT_THAT(Evaluate(Expressions::In("value", doubles)), ElementsAre(3));
+}
+
+TEST_F(BatchEvaluatorTest, StartsWith) {
+  EXPECT_THAT(Evaluate(Expressions::StartsWith("data", "ap")), ElementsAre(0, 3));
+  EXPECT_THAT(Evaluate(Expressions::NotStartsWith("data", "ap")), ElementsAre(1, 2, 4));
+  EXPECT_THAT(Evaluate(Expressions::StartsWith("data", "z")), IsEmpty());
+}
+
+TEST_F(BatchEvaluatorTest, NestedFields) {
+  // Nested names cannot be bound yet, so the predicates are bound by hand.
+  auto city =
+      std::make_shared<BoundReference>(SchemaField::MakeOptional(6, "city", string()));
+  // The location of the second row is null, so its city is null too.
+  EXPECT_THAT(Evaluate(std::make_shared<BoundUnaryPredicate>(
+                  Expression::Operation::kIsNull, city)),
+              ElementsAre(1, 2));
+  EXPECT_THAT(Evaluate(std::make_shared<BoundLiteralPredicate>(
+                  Expression::Operation::kEq, city, Literal::String("paris"))),
+              ElementsAre(0, 4));
+}
+
+TEST_F(BatchEvaluatorTest, LogicalExpressions) {
+  EXPECT_THAT(Evaluate(Expressions::And(Expressions::GreaterThan("id", Literal::Int(1)),
+                                        Expressions::StartsWith("data", "a"))),
+              ElementsAre(3));
+  EXPECT_THAT(Evaluate(Expressions::Or(Expressions::Equal("id", Literal::Int(1)),
+                                       Expressions::IsNull("data"))),
+              ElementsAre(0, 1));
+  EXPECT_THAT(Evaluate(Expressions::Not(Expressions::Equal("id", Literal::Int(1)))),
+              ElementsAre(1, 2, 3, 4));
+  EXPECT_THAT(Evaluate(Expressions::AlwaysTrue()), ElementsAre(0, 1, 2, 3, 4));
+  EXPECT_THAT(Evaluate(Expressions::AlwaysFalse()), IsEmpty());
+}
+
+TEST_F(BatchEvaluatorTest, SlicedBatch) {
+  batch_->array.offset = 2;
+  batch_->array.length = 3;
+  EXPECT_THAT(Evaluate(Expressions::GreaterThan("id", Literal::Int(3))),
+              ElementsAre(1, 2));
+  EXPECT_THAT(Evaluate(Expressions::IsNull("value")), ElementsAre(0));
+}
+
+TEST_F(BatchEvaluatorTest, ReusedAcrossBatches) {
+  auto evaluator = BatchEvaluator::Make(
+      *schema_, Expressions::Or(Expressions::In("data", {Literal::String("apple"),
+                                                         Literal::String("cherry")}),
+                                Expressions::StartsWith("data", "ban")));
+  ASSERT_THAT(evaluator, IsOk());
+  ICEBERG_UNWRAP_OR_FAIL(auto bitmap,
+                         (*evaluator)->Evaluate(batch_->schema, batch_->array));
+  EXPECT_THAT(bitmap, ElementsAre(0b10101));
+
+  batch_->array.offset = 2;
+  batch_->array.length = 3;
+  ICEBERG_UNWRAP_OR_FAIL(bitmap, (*evaluator)->Evaluate(batch_->schema, batch_->array));
+  EXPECT_THAT(bitmap, ElementsAre(0b101));
+}
+
+TEST_F(BatchEvaluatorTest, DictionaryEncodedColumn) {
+  auto replace_data = [&](std::unique_ptr<ArrowNode> data) {
+    batch_->children[1] = std::move(data);
+    batch_->child_schemas[1] = &batch_->children[1]->schema;
+    batch_->child_arrays[1] = &batch_->children[1]->array;
+  };
+  // The same values as the data column, with unused and repeated dictionary values.
+  replace_data(MakeDictionary({0, std::nullopt, 3, 1, 2},
+                              {"apple", "apricot", "cherry", "banana", "unused"}));
+  EXPECT_THAT(Evaluate(Expressions::Equal("data", Literal::String("apple"))),
+              ElementsAre(0));
+  EXPECT_THAT(Evaluate(Expressions::NotEqual("data", Literal::String("apple"))),
+              ElementsAre(1, 2, 3, 4));
+  EXPECT_THAT(Evaluate(Expressions::GreaterThan("data", Literal::String("b"))),
+              ElementsAre(2, 4));
+  EXPECT_THAT(Evaluate(Expressions::In(
+                  "data", {Literal::String("cherry"), Literal::String("apple")})),
+              ElementsAre(0, 4));
+  EXPECT_THAT(Evaluate(Expressions::StartsWith("data", "ap")), ElementsAre(0, 3));
+  EXPECT_THAT(Evaluate(Expressions::IsNull("data")), ElementsAre(1));
+
+  batch_->array.offset = 2;
+  batch_->array.length = 3;
+  EXPECT_THAT(Evaluate(Expressions::StartsWith("data", "ap")), ElementsAre(1));
+  batch_->array.offset = 0;
+  batch_->array.length = 5;
+
+  // Rows whose dictionary value is null are null.
+  replace_data(MakeDictionary({0, 1, 0, 2, 1}, {"apple", std::nullopt, "cherry"}));
+  EXPECT_THAT(Evaluate(Expressions::IsNull("data")), ElementsAre(1, 4));
+  EXPECT_THAT(Evaluate(Expressions::NotEqual("data", Literal::String("apple"))),
+              ElementsAre(1, 3, 4));
+
+  replace_data(MakeDictionary({0, 1, 0, 5, 1}, {"apple", "cherry"}));
+  EXPECT_THAT(BatchEvaluator::Make(*schema_, Expressions::IsNull("data"))
+                  .value()
+                  ->Evaluate(batch_->schema, batch_->array),
+              IsError(ErrorKind::kInvalidArrowData));
+}
+
+TEST_F(BatchEvaluatorTest, InvalidBatch) {
+  auto evaluator =
+      BatchEvaluator::Make(*schema_, Expressions::Equal("id", Literal::Int(1)));
+  ASSERT_THAT(evaluator, IsOk());
+  EXPECT_THAT((*evaluator)->Evaluate(batch_->children[0]->schema,
+                                     batch_->children[0]->array),
+              IsError(ErrorKind::kInvalidArrowData));
+
+  batch_->children[0]->format = "l";
+  batch_->children[0]->schema.format = batch_->children[0]->format.c_str();
+  EXPECT_THAT((*evaluator)->Evaluate(batch_->schema, batch_->array),
+              IsError(ErrorKind::kInvalidArrowData));
+}
+
+}  // namespace iceberg
@@ -0,0 +1,73 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/util/batch_sizer_internal.h"
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/schema.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+TEST(BatchSizerTest, EstimateRowWidth) {
+  Schema schema(
+      {SchemaField::MakeRequired(1, "id", int64()),
+       SchemaField::MakeOptional(2, "name", string()),
+       SchemaField::MakeOptional(3, "point",
+                                 struct_({SchemaField::MakeRequired(4, "x", float32()),
+                                          SchemaField::MakeRequired(5, "y", float32())})),
+       SchemaField::MakeOptional(
+           6, "tags", list(SchemaField::MakeRequired(7, "element", int32())))});
+  // 8 + (4 + 16) + (4 + 4) + (4 + 4 * 4)
+  EXPECT_DOUBLE_EQ(BatchSizer::EstimateRowWidth(schema), 56);
+}
+
+TEST(BatchSizerTest, AdaptsToObservedBatches) {
+  ICEBERG_UNWRAP_OR_FAIL(auto sizer, BatchSizer::Make(1 << 20, 64));
+  EXPECT_EQ(sizer.batch_size(), 16384);
+
+  // The first batch replaces the estimate, later ones are averaged with it.
+  sizer.Observe(16384, int64_t{16384} * 256);
+  EXPECT_EQ(sizer.batch_size(), 4096);
+  sizer.Observe(4096, int64_t{4096} * 768);
+  EXPECT_EQ(sizer.batch_size(), 2048);
+
+  // Empty batches are ignored.
+  sizer.Observe(0, 0);
+  EXPECT_EQ(sizer.batch_size(), 2048);
+}
+
+TEST(BatchSizerTest, BoundsBatchSize) {
+  ICEBERG_UNWRAP_OR_FAIL(auto wide, BatchSizer::Make(1024, 1 << 20));
+  EXPECT_EQ(wide.batch_size(), 1);
+
+  ICEBERG_UNWRAP_OR_FAIL(auto narrow, BatchSizer::Make(1 << 30, 0));
+  EXPECT_EQ(narrow.batch_size(), BatchSizer::kMaxBatchSize);
+  narrow.Observe(100, 0);
+  EXPECT_EQ(narrow.batch_size(), BatchSizer::kMaxBatchSize);
+
+  EXPECT_THAT(BatchSizer::Make(0, 64), IsError(ErrorKind::kInvalidArgument));
+}
+
+}  // namespace iceberg
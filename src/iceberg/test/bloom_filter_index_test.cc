@@ -0,0 +1,192 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/puffin/bloom_filter_index.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/expression/expressions.h"
+#include "iceberg/file_io.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/schema.h"
+#include "iceberg/statistics_file.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief A FileIO that keeps the written files in memory.
+class InMemoryFileIO : public FileIO {
+ public:
+  Result<std::string> ReadFile(const std::string& file_location,
+                               std::optional<size_t> length) override {
+    auto it = files.find(file_location);
+    if (it == files.end()) {
+      return NotFound("File {} does not exist", file_location);
+    }
+    return it->second;
+  }
+
+  Status WriteFile(const std::string& file_location, std::string_view content) override {
+    files[file_location] = std::string(content);
+    return {};
+  }
+
+  std::map<std::string, std::string> files;
+};
+
+std::string LongKey(int64_t value) {
+  std::string key(sizeof(value), '\0');
+  for (size_t i = 0; i < sizeof(value); ++i) {
+    key[i] = static_cast<char>((static_cast<uint64_t>(value) >> (8 * i)) & 0xFF);
+  }
+  return key;
+}
+
+DataFile MakeDataFile(std::string path) {
+  DataFile data_file;
+  data_file.file_path = std::move(path);
+  return data_file;
+}
+
+}  // namespace
+
+TEST(BloomFilterTest, AddAndMightContain) {
+  auto filter = BloomFilter::Make(1000, 0.01);
+  EXPECT_GT(filter.num_bits(), 0);
+  EXPECT_GT(filter.num_hashes(), 0);
+  for (int64_t i = 0; i < 1000; ++i) {
+    filter.Add(LongKey(i));
+  }
+  for (int64_t i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(filter.MightContain(LongKey(i)));
+  }
+
+  int false_positives = 0;
+  for (int64_t i = 1000; i < 11000; ++i) {
+    false_positives += filter.MightContain(LongKey(i)) ? 1 : 0;
+  }
+  EXPECT_LT(false_positives, 300);
+}
+
+TEST(BloomFilterTest, Serialization) {
+  auto filter = BloomFilter::Make(100);
+  filter.Add("a");
+  filter.Add("b");
+  ICEBERG_UNWRAP_OR_FAIL(auto copy, BloomFilter::Deserialize(filter.Serialize()));
+  EXPECT_EQ(copy.num_bits(), filter.num_bits());
+  EXPECT_EQ(copy.num_hashes(), filter.num_hashes());
+  EXPECT_TRUE(copy.MightContain("a"));
+  EXPECT_TRUE(copy.MightContain("b"));
+
+  EXPECT_THAT(BloomFilter::Deserialize(""), IsError(ErrorKind::kInvalid));
+  EXPECT_THAT(BloomFilter::Deserialize(filter.Serialize().substr(0, 5)),
+              IsError(ErrorKind::kInvalid));
+}
+
+TEST(BloomFilterIndexTest, EvaluatePointLookups) {
+  Schema schema({SchemaField::MakeRequired(1, "id", int64()),
+                 SchemaField::MakeOptional(2, "data", string())});
+  auto index = std::make_shared<BloomFilterIndex>(1);
+  auto first = BloomFilter::Make(100);
+  auto second = BloomFilter::Make(100);
+  for (int64_t i = 0; i < 100; ++i) {
+    first.Add(LongKey(i));
+    second.Add(LongKey(i + 1000));
+  }
+  index->Add("s3://bucket/first.parquet", std::move(first));
+  index->Add("s3://bucket/second.parquet", std::move(second));
+
+  auto first_file = MakeDataFile("s3://bucket/first.parquet");
+  auto second_file = MakeDataFile("s3://bucket/second.parquet");
+  auto unindexed_file = MakeDataFile("s3://bucket/third.parquet");
+
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto evaluator,
+      BloomFilterIndexEvaluator::Make(
+          index, Expressions::Equal("id", Literal::Long(1005)), schema, true));
+  EXPECT_THAT(evaluator->Evaluate(first_file), HasValue(::testing::Eq(false)));
+  EXPECT_THAT(evaluator->Evaluate(second_file), HasValue(::testing::Eq(true)));
+  EXPECT_THAT(evaluator->Evaluate(unindexed_file), HasValue(::testing::Eq(true)));
+
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto in_evaluator,
+      BloomFilterIndexEvaluator::Make(
+          index, Expressions::In("id", {Literal::Long(5), Literal::Long(7)}), schema,
+          true));
+  EXPECT_THAT(in_evaluator->Evaluate(first_file), HasValue(::testing::Eq(true)));
+  EXPECT_THAT(in_evaluator->Evaluate(second_file), HasValue(::testing::Eq(false)));
+
+  // Predicates on other columns or ranges cannot be answered by the index.
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto range_evaluator,
+      BloomFilterIndexEvaluator::Make(
+          index, Expressions::GreaterThan("id", Literal::Long(5000)), schema, true));
+  EXPECT_THAT(range_evaluator->Evaluate(first_file), HasValue(::testing::Eq(true)));
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto or_evaluator,
+      BloomFilterIndexEvaluator::Make(
+          index,
+          Expressions::Or(Expressions::Equal("id", Literal::Long(1005)),
+                          Expressions::Equal("data", Literal::String("x"))),
+          schema, true));
+  EXPECT_THAT(or_evaluator->Evaluate(first_file), HasValue(::testing::Eq(true)));
+}
+
+TEST(BloomFilterIndexTest, WriteAndRead) {
+  BloomFilterIndex index(1);
+  auto filter = BloomFilter::Make(10);
+  filter.Add(LongKey(42));
+  index.Add("s3://bucket/data.parquet", std::move(filter));
+
+  auto io = std::make_shared<InMemoryFileIO>();
+  ICEBERG_UNWRAP_OR_FAIL(auto file, io->NewOutputFile("s3://bucket/index.puffin"));
+  ICEBERG_UNWRAP_OR_FAIL(auto statistics_file,
+                         WriteBloomFilterIndex(index, std::move(file), 7, 3));
+  ASSERT_EQ(statistics_file.blob_metadata.size(), 1);
+  EXPECT_EQ(statistics_file.blob_metadata[0].type, kBloomFilterIndexBlobType);
+  EXPECT_THAT(statistics_file.blob_metadata[0].fields, ::testing::ElementsAre(1));
+
+  TableMetadata metadata;
+  metadata.statistics.push_back(std::make_shared<StatisticsFile>(statistics_file));
+  const auto* found = FindBloomFilterIndexFile(metadata, 7, 1);
+  ASSERT_NE(found, nullptr);
+  EXPECT_EQ(FindBloomFilterIndexFile(metadata, 7, 2), nullptr);
+  EXPECT_EQ(FindBloomFilterIndexFile(metadata, 8, 1), nullptr);
+
+  ICEBERG_UNWRAP_OR_FAIL(auto read, ReadBloomFilterIndex(*io, *found, 1));
+  EXPECT_EQ(read.field_id(), 1);
+  ASSERT_EQ(read.size(), 1);
+  const auto* read_filter = read.FilterFor("s3://bucket/data.parquet");
+  ASSERT_NE(read_filter, nullptr);
+  EXPECT_TRUE(read_filter->MightContain(LongKey(42)));
+  EXPECT_THAT(ReadBloomFilterIndex(*io, *found, 2), IsError(ErrorKind::kNotFound));
+}
+
+}  // namespace iceberg
@@ -20,9 +20,16 @@
 #include "iceberg/util/bucket_util.h"
 
 #include <chrono>
+#include <limits>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
 
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "iceberg/test/matchers.h"
 #include "iceberg/test/temporal_test_helper.h"
 #include "iceberg/util/decimal.h"
 #include "iceberg/util/uuid.h"
@@ -107,4 +114,69 @@ TEST(BucketUtilsTest, HashHelper) {
   EXPECT_EQ(BucketUtils::HashBytes(fixed), -188683207);
 }
 
+namespace {
+
+int32_t ScalarBucket(int32_t hash, int32_t num_buckets) {
+  return (hash & std::numeric_limits<int32_t>::max()) % num_buckets;
+}
+
+}  // namespace
+
+TEST(BucketUtilsTest, BucketIndicesOfIntegers) {
+  std::mt19937_64 rng(42);
+  // Sizes around the lane count of the batch kernel.
+  for (size_t size : {0, 1, 15, 16, 17, 100}) {
+    std::vector<int64_t> longs(size);
+    std::vector<int32_t> ints(size);
+    for (size_t i = 0; i < size; ++i) {
+      longs[i] = static_cast<int64_t>(rng());
+      ints[i] = static_cast<int32_t>(longs[i]);
+    }
+    for (int32_t num_buckets : {1, 16, 7, 1000, std::numeric_limits<int32_t>::max()}) {
+      std::vector<int32_t> out(size);
+      ASSERT_THAT(BucketUtils::BucketIndices(std::span<const int64_t>(longs), num_buckets,
+                                             out),
+                  IsOk());
+      for (size_t i = 0; i < size; ++i) {
+        EXPECT_EQ(out[i], ScalarBucket(BucketUtils::HashLong(longs[i]), num_buckets));
+      }
+      ASSERT_THAT(
+          BucketUtils::BucketIndices(std::span<const int32_t>(ints), num_buckets, out),
+          IsOk());
+      for (size_t i = 0; i < size; ++i) {
+        EXPECT_EQ(out[i], ScalarBucket(BucketUtils::HashInt(ints[i]), num_buckets));
+      }
+    }
+  }
+}
+
+TEST(BucketUtilsTest, BucketIndicesOfBinaries) {
+  const std::vector<std::string> values = {"", "a", "iceberg", "bucket transform"};
+  std::string data;
+  std::vector<int32_t> offsets = {0};
+  for (const auto& value : values) {
+    data += value;
+    offsets.push_back(static_cast<int32_t>(data.size()));
+  }
+  std::vector<int32_t> out(values.size());
+  ASSERT_THAT(BucketUtils::BucketIndices(
+                  offsets, reinterpret_cast<const uint8_t*>(data.data()), 10, out),
+              IsOk());
+  for (size_t i = 0; i < values.size(); ++i) {
+    const auto hash = BucketUtils::HashBytes(std::span<const uint8_t>(
+        reinterpret_cast<const uint8_t*>(values[i].data()), values[i].size()));
+    EXPECT_EQ(out[i], ScalarBucket(hash, 10));
+  }
+}
+
+TEST(BucketUtilsTest, BucketIndicesInvalidArguments) {
+  std::vector<int64_t> values = {1, 2};
+  std::vector<int32_t> out(2);
+  EXPECT_THAT(BucketUtils::BucketIndices(std::span<const int64_t>(values), 0, out),
+              IsError(ErrorKind::kInvalidArgument));
+  std::vector<int32_t> short_out(1);
+  EXPECT_THAT(BucketUtils::BucketIndices(std::span<const int64_t>(values), 4, short_out),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
 }  // namespace iceberg
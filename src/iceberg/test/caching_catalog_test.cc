@@ -0,0 +1,178 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/caching_catalog.h"
+
+#include <memory>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/table.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/table_requirement.h"
+#include "iceberg/table_update.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/test/mock_catalog.h"
+
+namespace iceberg {
+
+using ::testing::_;
+using ::testing::ByMove;
+using ::testing::Return;
+
+class CachingCatalogTest : public ::testing::Test {
+ protected:
+  void SetUp() override { catalog_ = std::make_shared<MockCatalog>(); }
+
+  std::shared_ptr<CachingCatalog> MakeCache(std::chrono::milliseconds ttl,
+                                            int64_t max_entries = 10) {
+    auto cache = CachingCatalog::Make(
+        catalog_, CachingCatalog::Options{.ttl = ttl, .max_entries = max_entries});
+    EXPECT_THAT(cache, IsOk());
+    return cache.value();
+  }
+
+  std::unique_ptr<Table> MakeTable(const TableIdentifier& identifier,
+                                   const std::string& metadata_location) {
+    return std::make_unique<Table>(
+        identifier, std::make_shared<TableMetadata>(TableMetadata{.format_version = 2}),
+        metadata_location, nullptr, nullptr);
+  }
+
+  std::shared_ptr<MockCatalog> catalog_;
+  TableIdentifier ident_{.ns = {{"db"}}, .name = "t1"};
+};
+
+TEST_F(CachingCatalogTest, SharesMetadataWithinTtl) {
+  auto cache = MakeCache(std::chrono::hours(1));
+  EXPECT_CALL(*catalog_, LoadTable(_))
+      .WillOnce(Return(ByMove(MakeTable(ident_, "s3://t1/v1.metadata.json"))));
+  EXPECT_CALL(*catalog_, GetTableMetadataLocation(_)).Times(0);
+
+  ICEBERG_UNWRAP_OR_FAIL(auto first, cache->LoadTable(ident_));
+  ICEBERG_UNWRAP_OR_FAIL(auto second, cache->LoadTable(ident_));
+  EXPECT_EQ(first->metadata(), second->metadata());
+  EXPECT_EQ(second->metadata_location(), "s3://t1/v1.metadata.json");
+  // Commits of the returned tables go through the cache.
+  EXPECT_EQ(second->catalog(), cache);
+
+  auto stats = cache->stats();
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.entry_count, 1);
+}
+
+TEST_F(CachingCatalogTest, ValidatesByMetadataLocation) {
+  auto cache = MakeCache(std::chrono::milliseconds(0));
+  EXPECT_CALL(*catalog_, LoadTable(_))
+      .WillOnce(Return(ByMove(MakeTable(ident_, "s3://t1/v1.metadata.json"))))
+      .WillOnce(Return(ByMove(MakeTable(ident_, "s3://t1/v2.metadata.json"))));
+  EXPECT_CALL(*catalog_, GetTableMetadataLocation(_))
+      .WillOnce(Return(std::string("s3://t1/v1.metadata.json")))
+      .WillOnce(Return(std::string("s3://t1/v2.metadata.json")));
+
+  ICEBERG_UNWRAP_OR_FAIL(auto first, cache->LoadTable(ident_));
+  ICEBERG_UNWRAP_OR_FAIL(auto validated, cache->LoadTable(ident_));
+  EXPECT_EQ(first->metadata(), validated->metadata());
+
+  // The pointer moved, so the table is loaded again.
+  ICEBERG_UNWRAP_OR_FAIL(auto reloaded, cache->LoadTable(ident_));
+  EXPECT_NE(first->metadata(), reloaded->metadata());
+  EXPECT_EQ(reloaded->metadata_location(), "s3://t1/v2.metadata.json");
+
+  auto stats = cache->stats();
+  EXPECT_EQ(stats.misses, 2);
+  EXPECT_EQ(stats.validated_hits, 1);
+  EXPECT_EQ(stats.hits, 0);
+}
+
+TEST_F(CachingCatalogTest, ReloadsWithoutMetadataLocation) {
+  auto cache = MakeCache(std::chrono::milliseconds(0));
+  EXPECT_CALL(*catalog_, LoadTable(_))
+      .WillOnce(Return(ByMove(MakeTable(ident_, "s3://t1/v1.metadata.json"))))
+      .WillOnce(Return(ByMove(MakeTable(ident_, "s3://t1/v1.metadata.json"))));
+  EXPECT_CALL(*catalog_, GetTableMetadataLocation(_))
+      .WillOnce(Return(NotSupported("no pointer")));
+
+  EXPECT_THAT(cache->LoadTable(ident_), IsOk());
+  EXPECT_THAT(cache->LoadTable(ident_), IsOk());
+  EXPECT_EQ(cache->stats().misses, 2);
+}
+
+TEST_F(CachingCatalogTest, EvictsLeastRecentlyUsed) {
+  auto cache = MakeCache(std::chrono::hours(1), /*max_entries=*/2);
+  TableIdentifier t2{.ns = {{"db"}}, .name = "t2"};
+  TableIdentifier t3{.ns = {{"db"}}, .name = "t3"};
+  EXPECT_CALL(*catalog_, LoadTable(_))
+      .WillOnce(Return(ByMove(MakeTable(ident_, "s3://t1/v1.metadata.json"))))
+      .WillOnce(Return(ByMove(MakeTable(t2, "s3://t2/v1.metadata.json"))))
+      .WillOnce(Return(ByMove(MakeTable(t3, "s3://t3/v1.metadata.json"))))
+      .WillOnce(Return(ByMove(MakeTable(t2, "s3://t2/v1.metadata.json"))));
+
+  EXPECT_THAT(cache->LoadTable(ident_), IsOk());
+  EXPECT_THAT(cache->LoadTable(t2), IsOk());
+  EXPECT_THAT(cache->LoadTable(ident_), IsOk());
+  // t2 is the least recently used table.
+  EXPECT_THAT(cache->LoadTable(t3), IsOk());
+  EXPECT_THAT(cache->LoadTable(ident_), IsOk());
+  EXPECT_THAT(cache->LoadTable(t2), IsOk());
+
+  auto stats = cache->stats();
+  EXPECT_EQ(stats.misses, 4);
+  EXPECT_EQ(stats.hits, 2);
+  EXPECT_EQ(stats.evictions, 2);
+  EXPECT_EQ(stats.entry_count, 2);
+}
+
+TEST_F(CachingCatalogTest, CommitsUpdateTheCache) {
+  auto cache = MakeCache(std::chrono::hours(1));
+  EXPECT_CALL(*catalog_, LoadTable(_))
+      .WillOnce(Return(ByMove(MakeTable(ident_, "s3://t1/v1.metadata.json"))))
+      .WillOnce(Return(ByMove(MakeTable(ident_, "s3://t1/v3.metadata.json"))));
+  EXPECT_CALL(*catalog_, UpdateTable(_, _, _))
+      .WillOnce(Return(ByMove(MakeTable(ident_, "s3://t1/v2.metadata.json"))))
+      .WillOnce(Return(ByMove(CommitFailed("conflict"))));
+  EXPECT_CALL(*catalog_, DropTable(_, _)).WillOnce(Return(Status{}));
+
+  EXPECT_THAT(cache->LoadTable(ident_), IsOk());
+  ICEBERG_UNWRAP_OR_FAIL(auto committed, cache->UpdateTable(ident_, {}, {}));
+  ICEBERG_UNWRAP_OR_FAIL(auto loaded, cache->LoadTable(ident_));
+  EXPECT_EQ(loaded->metadata(), committed->metadata());
+  EXPECT_EQ(loaded->metadata_location(), "s3://t1/v2.metadata.json");
+
+  // A failed commit drops the entry, which may be out of date.
+  EXPECT_THAT(cache->UpdateTable(ident_, {}, {}), IsError(ErrorKind::kCommitFailed));
+  ICEBERG_UNWRAP_OR_FAIL(loaded, cache->LoadTable(ident_));
+  EXPECT_EQ(loaded->metadata_location(), "s3://t1/v3.metadata.json");
+
+  ASSERT_THAT(cache->DropTable(ident_, /*purge=*/false), IsOk());
+  EXPECT_EQ(cache->stats().entry_count, 0);
+}
+
+TEST_F(CachingCatalogTest, InvalidOptions) {
+  EXPECT_THAT(CachingCatalog::Make(nullptr, {}), IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(CachingCatalog::Make(catalog_, {.max_entries = 0}),
+              IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(CachingCatalog::Make(catalog_, {.ttl = std::chrono::milliseconds(-1)}),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+}  // namespace iceberg
@@ -0,0 +1,209 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/caching_file_io.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/test/matchers.h"
+#include "iceberg/test/temp_file_test_base.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief A FileIO of in-memory files, counting the reads of each file.
+class CountingFileIO : public FileIO {
+ public:
+  Result<std::string> ReadFile(const std::string& file_location,
+                               std::optional<size_t> length) override {
+    ++reads_[file_location];
+    auto it = files_.find(file_location);
+    if (it == files_.cend()) {
+      return IOError("File {} does not exist", file_location);
+    }
+    return it->second;
+  }
+
+  Status WriteFile(const std::string& file_location, std::string_view content) override {
+    files_[file_location] = std::string(content);
+    return {};
+  }
+
+  std::unordered_map<std::string, std::string> files_;
+  std::unordered_map<std::string, int> reads_;
+};
+
+std::span<uint8_t> AsSpan(std::string& buffer) {
+  return {reinterpret_cast<uint8_t*>(buffer.data()), buffer.size()};
+}
+
+}  // namespace
+
+class CachingFileIOTest : public TempFileTestBase {
+ protected:
+  void SetUp() override {
+    TempFileTestBase::SetUp();
+    directory_ = CreateTempDirectory();
+    file_io_ = std::make_shared<CountingFileIO>();
+  }
+
+  std::shared_ptr<CachingFileIO> MakeCache(int64_t capacity_bytes = 1024 * 1024,
+                                           bool cache_data_files = false) {
+    auto cache = CachingFileIO::Make(file_io_, {.directory = directory_,
+                                                .capacity_bytes = capacity_bytes,
+                                                .block_size = 4,
+                                                .cache_data_files = cache_data_files});
+    EXPECT_THAT(cache, IsOk());
+    return cache.value();
+  }
+
+  std::string directory_;
+  std::shared_ptr<CountingFileIO> file_io_;
+};
+
+TEST_F(CachingFileIOTest, InvalidOptions) {
+  EXPECT_THAT(
+      CachingFileIO::Make(nullptr, {.directory = directory_, .capacity_bytes = 1}),
+      IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(CachingFileIO::Make(file_io_, {.capacity_bytes = 1}),
+              IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(CachingFileIO::Make(file_io_, {.directory = directory_}),
+              IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(CachingFileIO::Make(file_io_, {.directory = directory_,
+                                             .capacity_bytes = 1,
+                                             .block_size = 0}),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(CachingFileIOTest, CacheableFiles) {
+  auto cache = MakeCache();
+  EXPECT_TRUE(cache->IsCacheable("s3://bucket/t/metadata/00001-abc.metadata.json"));
+  EXPECT_TRUE(cache->IsCacheable("s3://bucket/t/metadata/00001-abc.gz.metadata.json"));
+  EXPECT_TRUE(cache->IsCacheable("s3://bucket/t/metadata/snap-1-abc.avro"));
+  EXPECT_FALSE(cache->IsCacheable("s3://bucket/t/metadata/version-hint.text"));
+  EXPECT_FALSE(cache->IsCacheable("s3://bucket/t/data/00000-abc.parquet"));
+  EXPECT_TRUE(MakeCache(1024, /*cache_data_files=*/true)
+                  ->IsCacheable("s3://bucket/t/data/00000-abc.parquet"));
+}
+
+TEST_F(CachingFileIOTest, ReadFile) {
+  file_io_->files_ = {{"v1.metadata.json", "{}"}, {"version-hint.text", "1"}};
+  auto cache = MakeCache();
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_THAT(cache->ReadFile("v1.metadata.json", std::nullopt),
+                HasValue(::testing::Eq("{}")));
+    EXPECT_THAT(cache->ReadFile("version-hint.text", std::nullopt),
+                HasValue(::testing::Eq("1")));
+  }
+  EXPECT_EQ(file_io_->reads_["v1.metadata.json"], 1);
+  EXPECT_EQ(file_io_->reads_["version-hint.text"], 2);
+  EXPECT_THAT(cache->ReadFile("missing.metadata.json", std::nullopt),
+              IsError(ErrorKind::kIOError));
+
+  auto stats = cache->stats();
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 2);
+  EXPECT_EQ(stats.entry_count, 1);
+
+  // Entries are reused by another cache of the same directory.
+  auto reloaded = MakeCache();
+  EXPECT_EQ(reloaded->stats().entry_count, 1);
+  EXPECT_THAT(reloaded->ReadFile("v1.metadata.json", std::nullopt),
+              HasValue(::testing::Eq("{}")));
+  EXPECT_EQ(file_io_->reads_["v1.metadata.json"], 1);
+}
+
+TEST_F(CachingFileIOTest, InputFileBlocks) {
+  file_io_->files_ = {{"manifest.avro", "hello world"}};
+  auto cache = MakeCache();
+  for (int i = 0; i < 2; ++i) {
+    auto file = cache->NewInputFile("manifest.avro", 11);
+    ASSERT_THAT(file, IsOk());
+    auto& input = *file.value();
+    EXPECT_THAT(input.Size(), HasValue(::testing::Eq(11)));
+    std::string buffer(5, '\0');
+    EXPECT_THAT(input.ReadAt(6, AsSpan(buffer)), HasValue(::testing::Eq(5)));
+    EXPECT_EQ(buffer, "world");
+    EXPECT_THAT(input.ReadAt(8, AsSpan(buffer)), HasValue(::testing::Eq(3)));
+    EXPECT_EQ(buffer.substr(0, 3), "rld");
+    EXPECT_THAT(input.ReadAt(20, AsSpan(buffer)), HasValue(::testing::Eq(0)));
+    EXPECT_THAT(input.Close(), IsOk());
+    EXPECT_THAT(input.ReadAt(0, AsSpan(buffer)), IsError(ErrorKind::kInvalid));
+  }
+  // The file is only opened by the first reads, of blocks 1 and 2.
+  EXPECT_EQ(file_io_->reads_["manifest.avro"], 1);
+  EXPECT_EQ(cache->stats().entry_count, 3);
+}
+
+TEST_F(CachingFileIOTest, EvictLeastRecentlyUsed) {
+  const std::string content(100, 'x');
+  file_io_->files_ = {{"a.avro", content}, {"b.avro", content}, {"c.avro", content}};
+  // Room for two entries of the three files.
+  auto cache = MakeCache(300);
+  for (const auto* location : {"a.avro", "b.avro", "a.avro", "c.avro", "a.avro"}) {
+    EXPECT_THAT(cache->ReadFile(location, std::nullopt), IsOk());
+  }
+  auto stats = cache->stats();
+  EXPECT_EQ(stats.evictions, 1);
+  EXPECT_EQ(stats.entry_count, 2);
+  EXPECT_LE(stats.size_bytes, 300);
+  EXPECT_EQ(file_io_->reads_["a.avro"], 1);
+
+  EXPECT_THAT(cache->ReadFile("b.avro", std::nullopt), IsOk());
+  EXPECT_EQ(file_io_->reads_["b.avro"], 2);
+
+  // Files larger than the capacity are not cached.
+  file_io_->files_["large.avro"] = std::string(400, 'x');
+  EXPECT_THAT(cache->ReadFile("large.avro", std::nullopt), IsOk());
+  EXPECT_EQ(cache->stats().entry_count, 2);
+
+  cache->Clear();
+  EXPECT_EQ(cache->stats().entry_count, 0);
+  EXPECT_EQ(cache->stats().size_bytes, 0);
+  EXPECT_TRUE(std::filesystem::is_empty(directory_));
+}
+
+TEST_F(CachingFileIOTest, CorruptedEntry) {
+  file_io_->files_ = {{"v1.metadata.json", "{\"format-version\":2}"}};
+  auto cache = MakeCache();
+  ASSERT_THAT(cache->ReadFile("v1.metadata.json", std::nullopt), IsOk());
+
+  for (const auto& entry : std::filesystem::directory_iterator(directory_)) {
+    std::fstream file(entry.path(), std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(-1, std::ios::end);
+    file.put('!');
+  }
+  EXPECT_THAT(cache->ReadFile("v1.metadata.json", std::nullopt),
+              HasValue(::testing::Eq("{\"format-version\":2}")));
+  EXPECT_EQ(file_io_->reads_["v1.metadata.json"], 2);
+  EXPECT_EQ(cache->stats().corrupted, 1);
+
+  // The entry is cached again.
+  EXPECT_THAT(cache->ReadFile("v1.metadata.json", std::nullopt), IsOk());
+  EXPECT_EQ(file_io_->reads_["v1.metadata.json"], 2);
+}
+
+}  // namespace iceberg
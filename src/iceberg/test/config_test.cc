@@ -19,10 +19,13 @@
 
 #include "iceberg/util/config.h"
 
+#include <stdexcept>
 #include <string>
 
 #include <gtest/gtest.h>
 
+#include "iceberg/table_properties.h"
+
 namespace iceberg {
 
 enum class TestEnum { VALUE1, VALUE2, VALUE3 };
@@ -108,4 +111,18 @@ TEST(ConfigTest, BasicOperations) {
   ASSERT_EQ(config.Get(TestConfig::kDoubleConfig), 3.14);
 }
 
+TEST(ConfigTest, InvalidValuesFailWhenRead) {
+  auto properties = TableProperties::FromMap({{"commit.retry.num-retries", "many"},
+                                              {"commit.retry.min-wait-ms", "50"}});
+  ASSERT_EQ(properties->Get(TableProperties::kCommitMinRetryWaitMs), 50);
+  ASSERT_EQ(properties->Get(TableProperties::kManifestMergeEnabled), true);
+  ASSERT_THROW(properties->Get(TableProperties::kCommitNumRetries),
+               std::invalid_argument);
+
+  properties->Unset(TableProperties::kCommitNumRetries);
+  ASSERT_EQ(properties->Get(TableProperties::kCommitNumRetries), 4);
+  properties->Set(TableProperties::kCommitNumRetries, 7);
+  ASSERT_EQ(properties->Get(TableProperties::kCommitNumRetries), 7);
+}
+
 }  // namespace iceberg
@@ -0,0 +1,71 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/util/conversion_cache_internal.h"
+
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/test/matchers.h"
+
+namespace iceberg {
+
+TEST(ConversionCacheTest, ConvertsOncePerKey) {
+  ConversionCache<std::string> cache;
+  int conversions = 0;
+  auto convert = [&]() -> Result<std::string> {
+    ++conversions;
+    return "converted";
+  };
+
+  EXPECT_THAT(cache.GetOrConvert("a", convert), HasValue(::testing::Eq("converted")));
+  EXPECT_THAT(cache.GetOrConvert("a", convert), HasValue(::testing::Eq("converted")));
+  EXPECT_EQ(conversions, 1);
+  EXPECT_THAT(cache.GetOrConvert("b", convert), IsOk());
+  EXPECT_EQ(conversions, 2);
+  EXPECT_EQ(cache.size(), 2);
+}
+
+TEST(ConversionCacheTest, ErrorsAreNotCached) {
+  ConversionCache<int> cache;
+  EXPECT_THAT(cache.GetOrConvert("a", []() -> Result<int> { return Invalid("bad"); }),
+              IsError(ErrorKind::kInvalid));
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_THAT(cache.GetOrConvert("a", []() -> Result<int> { return 1; }),
+              HasValue(::testing::Eq(1)));
+}
+
+TEST(ConversionCacheTest, EvictsLeastRecentlyUsed) {
+  ConversionCache<int> cache(/*capacity=*/2);
+  int conversions = 0;
+  auto convert = [&]() -> Result<int> { return ++conversions; };
+
+  EXPECT_THAT(cache.GetOrConvert("a", convert), HasValue(::testing::Eq(1)));
+  EXPECT_THAT(cache.GetOrConvert("b", convert), HasValue(::testing::Eq(2)));
+  // Using "a" makes "b" the least recently used, evicted by "c".
+  EXPECT_THAT(cache.GetOrConvert("a", convert), HasValue(::testing::Eq(1)));
+  EXPECT_THAT(cache.GetOrConvert("c", convert), HasValue(::testing::Eq(3)));
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_THAT(cache.GetOrConvert("a", convert), HasValue(::testing::Eq(1)));
+  EXPECT_THAT(cache.GetOrConvert("b", convert), HasValue(::testing::Eq(4)));
+}
+
+}  // namespace iceberg
@@ -0,0 +1,239 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/convert_equality_delete_files.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <arrow/array.h>
+#include <arrow/c/bridge.h>
+#include <arrow/json/from_string.h>
+#include <arrow/record_batch.h>
+#include <arrow/table.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/avro/avro_register.h"
+#include "iceberg/data_writer.h"
+#include "iceberg/fast_append.h"
+#include "iceberg/location_provider.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/parquet/parquet_register.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/row_delta.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table.h"
+#include "iceberg/table_scan.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/test/table_test_base.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+namespace {
+
+class DirectoryLocationProvider : public LocationProvider {
+ public:
+  explicit DirectoryLocationProvider(std::string directory)
+      : directory_(std::move(directory)) {}
+
+  Result<std::string> NewDataLocation(const std::string& filename) override {
+    return std::format("{}/{}", directory_, filename);
+  }
+
+  Result<std::string> NewDataLocation(const PartitionSpec& /*spec*/,
+                                      const StructLike& /*partition_data*/,
+                                      const std::string& filename) override {
+    return NewDataLocation(filename);
+  }
+
+ private:
+  std::string directory_;
+};
+
+}  // namespace
+
+class ConvertEqualityDeleteFilesTest : public TableTestBase {
+ protected:
+  static void SetUpTestSuite() {
+    avro::RegisterAll();
+    parquet::RegisterAll();
+  }
+
+  void SetUp() override {
+    TableTestBase::SetUp();
+    std::filesystem::create_directories(table_location_ + "/data");
+    schema_ = std::make_shared<Schema>(
+        std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int64()),
+                                 SchemaField::MakeOptional(2, "data", string())},
+        /*schema_id=*/0);
+  }
+
+  // Writes the rows of a schema to Parquet files.
+  std::vector<DataFile> WriteRows(const std::shared_ptr<Schema>& schema,
+                                  const std::shared_ptr<::arrow::DataType>& type,
+                                  const std::string& rows_json) {
+    auto array = ::arrow::json::ArrayFromJSONString(type, rows_json).ValueOrDie();
+    ArrowArray batch;
+    EXPECT_TRUE(::arrow::ExportArray(*array, &batch).ok());
+    auto writer = FanoutDataWriter::Make(PartitionedWriterOptions{
+        .schema = schema,
+        .spec = PartitionSpec::Unpartitioned(),
+        .io = file_io_,
+        .location_provider =
+            std::make_shared<DirectoryLocationProvider>(table_location_ + "/data"),
+    });
+    EXPECT_THAT(writer, IsOk());
+    EXPECT_THAT(writer.value()->Write(&batch), IsOk());
+    auto files = writer.value()->Close();
+    EXPECT_THAT(files, IsOk());
+    return std::move(files.value());
+  }
+
+  // Appends the rows to the table in a new data file.
+  void AppendRows(const std::string& rows_json) {
+    auto type = ::arrow::struct_({::arrow::field("id", ::arrow::int64(), false),
+                                  ::arrow::field("data", ::arrow::utf8())});
+    auto files = WriteRows(schema_, type, rows_json);
+    FastAppend append(table_);
+    for (auto& file : files) {
+      append.AppendFile(std::make_shared<DataFile>(std::move(file)));
+    }
+    ASSERT_THAT(append.Commit(), IsOk());
+  }
+
+  // Commits an equality delete file of the rows with the IDs.
+  void DeleteIds(const std::string& ids_json) {
+    auto id_schema = std::make_shared<Schema>(
+        std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int64())});
+    auto files = WriteRows(
+        id_schema, ::arrow::struct_({::arrow::field("id", ::arrow::int64(), false)}),
+        ids_json);
+    RowDelta delta(table_);
+    for (auto& file : files) {
+      file.content = DataFile::Content::kEqualityDeletes;
+      file.equality_ids = {1};
+      delta.AddDeletes(std::make_shared<DataFile>(std::move(file)));
+    }
+    ASSERT_THAT(delta.Commit(), IsOk());
+  }
+
+  std::vector<std::shared_ptr<FileScanTask>> PlanFiles() {
+    TableScanBuilder builder(table_->metadata(), file_io_);
+    auto scan = builder.Build();
+    EXPECT_THAT(scan, IsOk());
+    auto tasks = scan.value()->PlanFiles();
+    EXPECT_THAT(tasks, IsOk());
+    return tasks.value();
+  }
+
+  // Returns the sorted IDs of the rows of the current snapshot.
+  std::vector<int64_t> ReadIds() {
+    std::vector<int64_t> ids;
+    for (const auto& task : PlanFiles()) {
+      auto stream = task->ToArrow(file_io_, schema_, nullptr);
+      EXPECT_THAT(stream, IsOk());
+      auto reader = ::arrow::ImportRecordBatchReader(&stream.value()).ValueOrDie();
+      for (const auto& batch : reader->ToRecordBatches().ValueOrDie()) {
+        auto column = std::static_pointer_cast<::arrow::Int64Array>(batch->column(0));
+        for (int64_t i = 0; i < column->length(); ++i) {
+          ids.push_back(column->Value(i));
+        }
+      }
+    }
+    std::ranges::sort(ids);
+    return ids;
+  }
+
+  // Counts the delete files of the scan tasks with the content.
+  int32_t CountDeleteFiles(DataFile::Content content) {
+    int32_t count = 0;
+    for (const auto& task : PlanFiles()) {
+      count += static_cast<int32_t>(
+          std::ranges::count(task->delete_files(), content, &DataFile::content));
+    }
+    return count;
+  }
+};
+
+TEST_F(ConvertEqualityDeleteFilesTest, ConvertsToPositionDeletes) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable());
+  ASSERT_NO_FATAL_FAILURE(AppendRows(R"([[1, "a"], [2, "b"], [3, "c"]])"));
+  ASSERT_NO_FATAL_FAILURE(AppendRows(R"([[4, "d"], [5, "e"]])"));
+  ASSERT_NO_FATAL_FAILURE(DeleteIds("[[2], [4]]"));
+  // The equality deletes do not apply to rows added after them.
+  ASSERT_NO_FATAL_FAILURE(AppendRows(R"([[2, "x"]])"));
+  ASSERT_EQ(ReadIds(), (std::vector<int64_t>{1, 2, 3, 5}));
+  ASSERT_EQ(CountDeleteFiles(DataFile::Content::kEqualityDeletes), 2);
+
+  ICEBERG_UNWRAP_OR_FAIL(auto result,
+                         ConvertEqualityDeleteFiles(table_).WithParallelism(2).Execute());
+  EXPECT_EQ(result.converted_partitions_count, 1);
+  EXPECT_EQ(result.skipped_partitions_count, 0);
+  EXPECT_EQ(result.removed_equality_delete_files_count, 1);
+  EXPECT_EQ(result.added_position_delete_files_count, 1);
+  EXPECT_EQ(result.added_position_deletes_count, 2);
+  ASSERT_TRUE(result.snapshot_id.has_value());
+
+  ICEBERG_UNWRAP_OR_FAIL(auto snapshot, table_->metadata()->Snapshot());
+  EXPECT_EQ(snapshot->snapshot_id, result.snapshot_id.value());
+  EXPECT_EQ(snapshot->operation(), DataOperation::kReplace);
+  EXPECT_EQ(snapshot->summary.at(SnapshotSummaryFields::kRemovedEqDeleteFiles), "1");
+  EXPECT_EQ(snapshot->summary.at(SnapshotSummaryFields::kAddedPosDeleteFiles), "1");
+  EXPECT_EQ(snapshot->summary.at(SnapshotSummaryFields::kTotalDeleteFiles), "1");
+  EXPECT_EQ(CountDeleteFiles(DataFile::Content::kEqualityDeletes), 0);
+  EXPECT_GT(CountDeleteFiles(DataFile::Content::kPositionDeletes), 0);
+  EXPECT_EQ(ReadIds(), (std::vector<int64_t>{1, 2, 3, 5}));
+
+  // Nothing is left to convert.
+  ICEBERG_UNWRAP_OR_FAIL(result, ConvertEqualityDeleteFiles(table_).Execute());
+  EXPECT_FALSE(result.snapshot_id.has_value());
+}
+
+TEST_F(ConvertEqualityDeleteFilesTest, SkipsPartitionsOverMemoryBudget) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable());
+  ASSERT_NO_FATAL_FAILURE(AppendRows(R"([[1, "a"], [2, "b"]])"));
+  ASSERT_NO_FATAL_FAILURE(DeleteIds("[[1]]"));
+  const int64_t snapshot_id = table_->metadata()->current_snapshot_id;
+
+  ICEBERG_UNWRAP_OR_FAIL(auto result,
+                         ConvertEqualityDeleteFiles(table_).MaxMemory(8).Execute());
+  EXPECT_EQ(result.converted_partitions_count, 0);
+  EXPECT_EQ(result.skipped_partitions_count, 1);
+  EXPECT_FALSE(result.snapshot_id.has_value());
+  EXPECT_EQ(table_->metadata()->current_snapshot_id, snapshot_id);
+  EXPECT_EQ(ReadIds(), (std::vector<int64_t>{2}));
+}
+
+TEST_F(ConvertEqualityDeleteFilesTest, RejectsInvalidOptions) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable());
+  EXPECT_THAT(ConvertEqualityDeleteFiles(table_).WithParallelism(0).Execute(),
+              IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(ConvertEqualityDeleteFiles(table_).MaxMemory(0).Execute(),
+              IsError(ErrorKind::kInvalidArgument));
+  ICEBERG_UNWRAP_OR_FAIL(auto result, ConvertEqualityDeleteFiles(table_).Execute());
+  EXPECT_FALSE(result.snapshot_id.has_value());
+}
+
+}  // namespace iceberg
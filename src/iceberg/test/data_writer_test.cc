@@ -0,0 +1,735 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/data_writer.h"
+
+#include <algorithm>
+#include <format>
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/file_io.h"
+#include "iceberg/file_reader.h"
+#include "iceberg/location_provider.h"
+#include "iceberg/metadata_columns.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/row/struct_like.h"
+#include "iceberg/schema.h"
+#include "iceberg/sort_field.h"
+#include "iceberg/sort_order.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/transform.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief A hand-built batch of (id int, data string) rows that owns its buffers.
+struct Batch {
+  std::vector<uint8_t> id_validity;
+  std::vector<int32_t> ids;
+  std::vector<uint8_t> data_validity;
+  std::vector<int32_t> offsets{0};
+  std::string data;
+  std::vector<const void*> id_buffers;
+  std::vector<const void*> data_buffers;
+  std::vector<const void*> struct_buffers{nullptr};
+  ArrowArray id_array{};
+  ArrowArray data_array{};
+  std::vector<ArrowArray*> children;
+  ArrowArray array{};
+};
+
+/// \brief Makes a batch whose ownership is transferred with its array.
+ArrowArray MakeBatch(const std::vector<int32_t>& ids,
+                     const std::vector<std::optional<std::string>>& data) {
+  auto* batch = new Batch();
+  batch->ids = ids;
+  batch->data_validity.resize((data.size() + 7) / 8, 0);
+  for (size_t i = 0; i < data.size(); ++i) {
+    if (data[i].has_value()) {
+      batch->data_validity[i / 8] |= 1 << (i % 8);
+      batch->data += *data[i];
+    } else {
+      ++batch->data_array.null_count;
+    }
+    batch->offsets.push_back(static_cast<int32_t>(batch->data.size()));
+  }
+  const auto length = static_cast<int64_t>(ids.size());
+  batch->id_buffers = {nullptr, batch->ids.data()};
+  batch->id_array.length = length;
+  batch->id_array.n_buffers = 2;
+  batch->id_array.buffers = batch->id_buffers.data();
+  batch->data_buffers = {batch->data_validity.data(), batch->offsets.data(),
+                         batch->data.data()};
+  batch->data_array.length = length;
+  batch->data_array.n_buffers = 3;
+  batch->data_array.buffers = batch->data_buffers.data();
+  batch->children = {&batch->id_array, &batch->data_array};
+  ArrowArray& array = batch->array;
+  array.length = length;
+  array.n_buffers = 1;
+  array.buffers = batch->struct_buffers.data();
+  array.n_children = 2;
+  array.children = batch->children.data();
+  array.private_data = batch;
+  array.release = [](ArrowArray* array) {
+    delete static_cast<Batch*>(array->private_data);
+    array->release = nullptr;
+  };
+  return array;
+}
+
+/// \brief What a fake writer has written to a file.
+struct WrittenFile {
+  std::string path;
+  std::vector<int32_t> ids;
+  std::vector<std::optional<std::string>> data;
+  std::unordered_map<std::string, std::string> properties;
+  /// \brief The (file_path, pos) rows written to a position delete file.
+  std::vector<std::pair<std::string, int64_t>> deletes;
+  bool closed = false;
+};
+
+/// \brief A writer that records the rows written to its file, which are the rows of
+/// position deletes if its schema is the position delete schema.
+class FakeWriter : public Writer {
+ public:
+  FakeWriter(std::vector<WrittenFile>& files, std::optional<int64_t> bytes_per_row)
+      : files_(files), bytes_per_row_(bytes_per_row) {}
+
+  Status Open(const WriterOptions& options) override {
+    index_ = files_.size();
+    files_.push_back(WrittenFile{.path = options.path, .properties = options.properties});
+    position_deletes_ = options.schema->fields()[0].field_id() ==
+                        MetadataColumns::kDeleteFilePath.field_id();
+    return {};
+  }
+
+  Status Close() override {
+    files_[index_].closed = true;
+    return {};
+  }
+
+  Status Write(ArrowArray* data) override {
+    if (position_deletes_) {
+      const ArrowArray& paths = *data->children[0];
+      const auto* offsets = static_cast<const int32_t*>(paths.buffers[1]);
+      const auto* chars = static_cast<const char*>(paths.buffers[2]);
+      const auto* positions = static_cast<const int64_t*>(data->children[1]->buffers[1]);
+      for (int64_t i = 0; i < data->length; ++i) {
+        files_[index_].deletes.emplace_back(
+            std::string(chars + offsets[i], offsets[i + 1] - offsets[i]), positions[i]);
+      }
+      data->release(data);
+      return {};
+    }
+    const ArrowArray& ids = *data->children[0];
+    const ArrowArray& strings = *data->children[1];
+    const auto* values = static_cast<const int32_t*>(ids.buffers[1]);
+    const auto* validity = static_cast<const uint8_t*>(strings.buffers[0]);
+    const auto* offsets = static_cast<const int32_t*>(strings.buffers[1]);
+    const auto* chars = static_cast<const char*>(strings.buffers[2]);
+    for (int64_t i = 0; i < data->length; ++i) {
+      files_[index_].ids.push_back(values[data->offset + ids.offset + i]);
+      const int64_t row = data->offset + strings.offset + i;
+      if (validity != nullptr && (validity[row / 8] & (1 << (row % 8))) == 0) {
+        files_[index_].data.push_back(std::nullopt);
+      } else {
+        files_[index_].data.emplace_back(std::in_place, chars + offsets[row],
+                                         offsets[row + 1] - offsets[row]);
+      }
+    }
+    data->release(data);
+    return {};
+  }
+
+  std::optional<Metrics> metrics() override {
+    Metrics metrics;
+    metrics.row_count = static_cast<int64_t>(files_[index_].ids.size());
+    metrics.value_counts[1] = metrics.row_count;
+    metrics.lower_bounds.emplace(1, Literal::Int(-1));
+    return metrics;
+  }
+
+  std::optional<int64_t> length() override {
+    return static_cast<int64_t>(files_[index_].ids.size() * sizeof(int32_t));
+  }
+
+  std::optional<int64_t> estimated_length() override {
+    if (!bytes_per_row_.has_value()) {
+      return std::nullopt;
+    }
+    return static_cast<int64_t>(files_[index_].ids.size()) * bytes_per_row_.value();
+  }
+
+  std::vector<int64_t> split_offsets() override { return {4}; }
+
+ private:
+  std::vector<WrittenFile>& files_;
+  std::optional<int64_t> bytes_per_row_;
+  size_t index_ = 0;
+  bool position_deletes_ = false;
+};
+
+/// \brief A reader of the rows of a fake writer, one row per batch.
+class FakeReader : public Reader {
+ public:
+  explicit FakeReader(const std::vector<WrittenFile>& files) : files_(files) {}
+
+  Status Open(const ReaderOptions& options) override {
+    for (const auto& file : files_) {
+      if (file.path == options.path) {
+        file_ = &file;
+        return {};
+      }
+    }
+    return NotFound("File not found: {}", options.path);
+  }
+
+  Status Close() override { return {}; }
+
+  Result<std::optional<ArrowArray>> Next() override {
+    if (row_ == file_->ids.size()) {
+      return std::nullopt;
+    }
+    auto batch = MakeBatch({file_->ids[row_]}, {file_->data[row_]});
+    ++row_;
+    return batch;
+  }
+
+  Result<ArrowSchema> Schema() override { return NotImplemented("Schema"); }
+
+  Result<std::unordered_map<std::string, std::string>> Metadata() override {
+    return std::unordered_map<std::string, std::string>{};
+  }
+
+ private:
+  const std::vector<WrittenFile>& files_;
+  const WrittenFile* file_ = nullptr;
+  size_t row_ = 0;
+};
+
+/// \brief A FileIO that records the deleted files.
+class FakeFileIO : public FileIO {
+ public:
+  Status DeleteFile(const std::string& file_location) override {
+    deleted.push_back(file_location);
+    return {};
+  }
+
+  std::vector<std::string> deleted;
+};
+
+/// \brief Puts data files under a directory of their partition value.
+class FakeLocationProvider : public LocationProvider {
+ public:
+  Result<std::string> NewDataLocation(const std::string& filename) override {
+    return "data/" + filename;
+  }
+
+  Result<std::string> NewDataLocation(const PartitionSpec& spec,
+                                      const StructLike& partition_data,
+                                      const std::string& filename) override {
+    auto value = partition_data.GetField(0).value();
+    auto* data = std::get_if<std::string_view>(&value);
+    return std::format("data/data={}/{}", data != nullptr ? *data : "null", filename);
+  }
+};
+
+}  // namespace
+
+class FanoutDataWriterTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    schema_ = std::make_shared<Schema>(
+        std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32()),
+                                 SchemaField::MakeOptional(2, "data", string())});
+    spec_ = std::make_shared<PartitionSpec>(
+        schema_, 1,
+        std::vector<PartitionField>{
+            PartitionField(2, 1000, "data", Transform::Identity())});
+  }
+
+  PartitionedWriterOptions Options() {
+    return PartitionedWriterOptions{
+        .schema = schema_,
+        .spec = spec_,
+        .location_provider = std::make_shared<FakeLocationProvider>(),
+        .file_name_prefix = "file",
+        .writer_factory = [this]() -> Result<std::unique_ptr<Writer>> {
+          return std::make_unique<FakeWriter>(files_, bytes_per_row_);
+        }};
+  }
+
+  std::shared_ptr<Schema> schema_;
+  std::shared_ptr<PartitionSpec> spec_;
+  std::vector<WrittenFile> files_;
+  /// \brief The encoded size of a row estimated by the writers, if any.
+  std::optional<int64_t> bytes_per_row_;
+};
+
+TEST_F(FanoutDataWriterTest, ScattersRowsByPartition) {
+  ICEBERG_UNWRAP_OR_FAIL(auto writer, FanoutDataWriter::Make(Options()));
+  auto batch = MakeBatch({0, 1, 2, 3, 4, 5}, {"a", "b", "a", std::nullopt, "b", "a"});
+  ASSERT_THAT(writer->Write(&batch), IsOk());
+  EXPECT_EQ(batch.release, nullptr);
+  EXPECT_EQ(writer->open_files(), 3);
+  batch = MakeBatch({6, 7}, {"b", "c"});
+  ASSERT_THAT(writer->Write(&batch), IsOk());
+  EXPECT_EQ(writer->open_files(), 4);
+
+  ICEBERG_UNWRAP_OR_FAIL(auto data_files, writer->Close());
+  ASSERT_EQ(files_.size(), 4);
+  ASSERT_EQ(data_files.size(), 4);
+  EXPECT_EQ(files_[0].path, "data/data=a/file-00001.parquet");
+  EXPECT_THAT(files_[0].ids, ::testing::ElementsAre(0, 2, 5));
+  EXPECT_EQ(files_[1].path, "data/data=b/file-00002.parquet");
+  EXPECT_THAT(files_[1].ids, ::testing::ElementsAre(1, 4, 6));
+  EXPECT_EQ(files_[2].path, "data/data=null/file-00003.parquet");
+  EXPECT_THAT(files_[2].ids, ::testing::ElementsAre(3));
+  EXPECT_THAT(files_[3].ids, ::testing::ElementsAre(7));
+
+  std::map<std::string, const DataFile*> by_path;
+  for (const auto& data_file : data_files) {
+    by_path[data_file.file_path] = &data_file;
+  }
+  const DataFile* a = by_path.at("data/data=a/file-00001.parquet");
+  EXPECT_EQ(a->content, DataFile::Content::kData);
+  EXPECT_EQ(a->file_format, FileFormatType::kParquet);
+  EXPECT_EQ(a->record_count, 3);
+  EXPECT_EQ(a->file_size_in_bytes, 12);
+  EXPECT_EQ(a->partition_spec_id, 1);
+  ASSERT_EQ(a->partition.size(), 1);
+  EXPECT_EQ(a->partition[0], Literal::String("a"));
+  EXPECT_THAT(a->value_counts, ::testing::ElementsAre(::testing::Pair(1, 3)));
+  EXPECT_THAT(a->lower_bounds,
+              ::testing::ElementsAre(::testing::Pair(
+                  1, ::testing::ElementsAre(0xff, 0xff, 0xff, 0xff))));
+  EXPECT_THAT(a->split_offsets, ::testing::ElementsAre(4));
+  EXPECT_TRUE(by_path.at("data/data=null/file-00003.parquet")->partition[0].IsNull());
+
+  for (const auto& file : files_) {
+    EXPECT_TRUE(file.closed) << file.path;
+  }
+  batch = MakeBatch({8}, {"a"});
+  EXPECT_THAT(writer->Write(&batch), IsError(ErrorKind::kInvalidArgument));
+  EXPECT_EQ(batch.release, nullptr);
+}
+
+TEST_F(FanoutDataWriterTest, Unpartitioned) {
+  auto options = Options();
+  options.spec = PartitionSpec::Unpartitioned();
+  ICEBERG_UNWRAP_OR_FAIL(auto writer, FanoutDataWriter::Make(std::move(options)));
+  auto batch = MakeBatch({0, 1, 2}, {"a", "b", "c"});
+  ASSERT_THAT(writer->Write(&batch), IsOk());
+  auto empty = MakeBatch({}, {});
+  ASSERT_THAT(writer->Write(&empty), IsOk());
+
+  ICEBERG_UNWRAP_OR_FAIL(auto data_files, writer->Close());
+  ASSERT_EQ(data_files.size(), 1);
+  EXPECT_EQ(data_files[0].file_path, "data/file-00001.parquet");
+  EXPECT_TRUE(data_files[0].partition.empty());
+  EXPECT_EQ(data_files[0].record_count, 3);
+  EXPECT_THAT(files_[0].ids, ::testing::ElementsAre(0, 1, 2));
+}
+
+TEST_F(FanoutDataWriterTest, RollsFilesAtTargetSize) {
+  auto options = Options();
+  // A batch of two rows reaches the target size.
+  options.target_file_size_bytes = 20;
+  ICEBERG_UNWRAP_OR_FAIL(auto writer, FanoutDataWriter::Make(std::move(options)));
+  for (int32_t id = 0; id < 5; ++id) {
+    auto batch = MakeBatch({id}, {"a"});
+    ASSERT_THAT(writer->Write(&batch), IsOk());
+  }
+  EXPECT_EQ(writer->open_files(), 1);
+
+  ICEBERG_UNWRAP_OR_FAIL(auto data_files, writer->Close());
+  ASSERT_EQ(files_.size(), 3);
+  EXPECT_THAT(files_[0].ids, ::testing::ElementsAre(0, 1));
+  EXPECT_THAT(files_[1].ids, ::testing::ElementsAre(2, 3));
+  EXPECT_THAT(files_[2].ids, ::testing::ElementsAre(4));
+  EXPECT_EQ(data_files.size(), 3);
+}
+
+TEST_F(FanoutDataWriterTest, RollsFilesAtEstimatedLength) {
+  bytes_per_row_ = 100;
+  auto options = Options();
+  options.target_file_size_bytes = 250;
+  ICEBERG_UNWRAP_OR_FAIL(auto writer, FanoutDataWriter::Make(std::move(options)));
+  for (int32_t id = 0; id < 4; ++id) {
+    auto batch = MakeBatch({id}, {"a"});
+    ASSERT_THAT(writer->Write(&batch), IsOk());
+  }
+  ICEBERG_UNWRAP_OR_FAIL(auto data_files, writer->Close());
+  // The writer estimates are used instead of the in-memory size of the rows.
+  ASSERT_EQ(files_.size(), 2);
+  EXPECT_THAT(files_[0].ids, ::testing::ElementsAre(0, 1, 2));
+  EXPECT_THAT(files_[1].ids, ::testing::ElementsAre(3));
+}
+
+TEST_F(FanoutDataWriterTest, ClosesLeastRecentlyWrittenFiles) {
+  auto options = Options();
+  options.max_open_files = 2;
+  ICEBERG_UNWRAP_OR_FAIL(auto writer, FanoutDataWriter::Make(std::move(options)));
+  auto batch = MakeBatch({0, 1}, {"a", "b"});
+  ASSERT_THAT(writer->Write(&batch), IsOk());
+  batch = MakeBatch({2}, {"a"});
+  ASSERT_THAT(writer->Write(&batch), IsOk());
+  // "b" is the least recently written partition.
+  batch = MakeBatch({3}, {"c"});
+  ASSERT_THAT(writer->Write(&batch), IsOk());
+  EXPECT_EQ(writer->open_files(), 2);
+  ASSERT_EQ(files_.size(), 3);
+  EXPECT_FALSE(files_[0].closed);
+  EXPECT_TRUE(files_[1].closed);
+
+  // A closed partition is written to a new file.
+  batch = MakeBatch({4}, {"b"});
+  ASSERT_THAT(writer->Write(&batch), IsOk());
+  EXPECT_TRUE(files_[0].closed);
+  ICEBERG_UNWRAP_OR_FAIL(auto data_files, writer->Close());
+  EXPECT_EQ(data_files.size(), 4);
+  EXPECT_THAT(files_[0].ids, ::testing::ElementsAre(0, 2));
+  EXPECT_THAT(files_[3].ids, ::testing::ElementsAre(4));
+}
+
+TEST_F(FanoutDataWriterTest, ClosesFilesOverMemoryLimit) {
+  auto options = Options();
+  options.max_open_bytes = 30;
+  ICEBERG_UNWRAP_OR_FAIL(auto writer, FanoutDataWriter::Make(std::move(options)));
+  auto batch = MakeBatch({0, 1, 2}, {"a", "b", "c"});
+  ASSERT_THAT(writer->Write(&batch), IsOk());
+  // The rows of each partition are estimated to 10 bytes, within the limit.
+  EXPECT_EQ(writer->open_files(), 3);
+  batch = MakeBatch({3}, {"c"});
+  ASSERT_THAT(writer->Write(&batch), IsOk());
+  EXPECT_EQ(writer->open_files(), 1);
+  EXPECT_TRUE(files_[0].closed);
+  EXPECT_TRUE(files_[1].closed);
+  EXPECT_FALSE(files_[2].closed);
+}
+
+TEST_F(FanoutDataWriterTest, InvalidOptions) {
+  auto options = Options();
+  options.location_provider = nullptr;
+  EXPECT_THAT(FanoutDataWriter::Make(std::move(options)),
+              IsError(ErrorKind::kInvalidArgument));
+  options = Options();
+  options.max_open_files = 0;
+  EXPECT_THAT(FanoutDataWriter::Make(std::move(options)),
+              IsError(ErrorKind::kInvalidArgument));
+  options = Options();
+  options.spec = std::make_shared<PartitionSpec>(
+      schema_, 1,
+      std::vector<PartitionField>{PartitionField(3, 1000, "x", Transform::Identity())});
+  EXPECT_THAT(FanoutDataWriter::Make(std::move(options)),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+class ClusteredDataWriterTest : public FanoutDataWriterTest {};
+
+TEST_F(ClusteredDataWriterTest, WritesRunsOfPartitions) {
+  ICEBERG_UNWRAP_OR_FAIL(auto writer, ClusteredDataWriter::Make(Options()));
+  auto batch = MakeBatch({0, 1, 2}, {"a", "a", "b"});
+  ASSERT_THAT(writer->Write(&batch), IsOk());
+  EXPECT_EQ(batch.release, nullptr);
+  EXPECT_EQ(writer->open_files(), 1);
+  ASSERT_EQ(files_.size(), 2);
+  EXPECT_TRUE(files_[0].closed);
+  batch = MakeBatch({3, 4, 5}, {"b", "c", "c"});
+  ASSERT_THAT(writer->Write(&batch), IsOk());
+  batch = MakeBatch({6, 7}, {std::nullopt, std::nullopt});
+  ASSERT_THAT(writer->Write(&batch), IsOk());
+  EXPECT_EQ(writer->open_files(), 1);
+
+  ICEBERG_UNWRAP_OR_FAIL(auto data_files, writer->Close());
+  EXPECT_EQ(writer->open_files(), 0);
+  ASSERT_EQ(files_.size(), 4);
+  EXPECT_THAT(files_[0].ids, ::testing::ElementsAre(0, 1));
+  EXPECT_THAT(files_[1].ids, ::testing::ElementsAre(2, 3));
+  EXPECT_THAT(files_[2].ids, ::testing::ElementsAre(4, 5));
+  EXPECT_EQ(files_[3].path, "data/data=null/file-00004.parquet");
+  EXPECT_THAT(files_[3].ids, ::testing::ElementsAre(6, 7));
+  ASSERT_EQ(data_files.size(), 4);
+  EXPECT_EQ(data_files[1].file_path, "data/data=b/file-00002.parquet");
+  EXPECT_EQ(data_files[1].record_count, 2);
+  EXPECT_EQ(data_files[1].partition[0], Literal::String("b"));
+  EXPECT_TRUE(data_files[3].partition[0].IsNull());
+  for (const auto& file : files_) {
+    EXPECT_TRUE(file.closed) << file.path;
+  }
+}
+
+TEST_F(ClusteredDataWriterTest, RollsFilesAtTargetSize) {
+  auto options = Options();
+  options.target_file_size_bytes = 20;
+  ICEBERG_UNWRAP_OR_FAIL(auto writer, ClusteredDataWriter::Make(std::move(options)));
+  for (int32_t id = 0; id < 3; ++id) {
+    auto batch = MakeBatch({id}, {"a"});
+    ASSERT_THAT(writer->Write(&batch), IsOk());
+  }
+  ICEBERG_UNWRAP_OR_FAIL(auto data_files, writer->Close());
+  ASSERT_EQ(files_.size(), 2);
+  EXPECT_THAT(files_[0].ids, ::testing::ElementsAre(0, 1));
+  EXPECT_THAT(files_[1].ids, ::testing::ElementsAre(2));
+  EXPECT_EQ(data_files.size(), 2);
+}
+
+TEST_F(ClusteredDataWriterTest, RejectsUnclusteredRows) {
+  ICEBERG_UNWRAP_OR_FAIL(auto writer, ClusteredDataWriter::Make(Options()));
+  auto batch = MakeBatch({0, 1, 2}, {"a", "b", "a"});
+  EXPECT_THAT(writer->Write(&batch), IsError(ErrorKind::kInvalidArgument));
+  EXPECT_EQ(batch.release, nullptr);
+
+  files_.clear();
+  ICEBERG_UNWRAP_OR_FAIL(writer, ClusteredDataWriter::Make(Options()));
+  batch = MakeBatch({0}, {"a"});
+  ASSERT_THAT(writer->Write(&batch), IsOk());
+  batch = MakeBatch({1}, {std::nullopt});
+  ASSERT_THAT(writer->Write(&batch), IsOk());
+  batch = MakeBatch({2}, {"a"});
+  EXPECT_THAT(writer->Write(&batch),
+              HasErrorMessage("not clustered by partition: rows of partition (\"a\")"));
+}
+
+class SortedDataWriterTest : public FanoutDataWriterTest {
+ protected:
+  SortOptions MakeSortOptions(SortDirection direction, NullOrder null_order,
+                              int32_t source_id) {
+    return SortOptions{
+        .sort_order = std::make_shared<SortOrder>(
+            1, std::vector<SortField>{
+                   SortField(source_id, Transform::Identity(), direction, null_order)}),
+        .spill_location = "spill",
+        .spill_reader_factory = [this]() -> Result<std::unique_ptr<Reader>> {
+          return std::make_unique<FakeReader>(files_);
+        }};
+  }
+};
+
+TEST_F(SortedDataWriterTest, SortsRowsByPartitionAndSortOrder) {
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto writer,
+      SortedDataWriter::Make(
+          Options(), MakeSortOptions(SortDirection::kDescending, NullOrder::kLast, 1)));
+  auto batch = MakeBatch({0, -1, 2, 3}, {"b", "a", "b", std::nullopt});
+  ASSERT_THAT(writer->Write(&batch), IsOk());
+  EXPECT_EQ(batch.release, nullptr);
+  batch = MakeBatch({-5, 5, 1}, {"a", "b", "b"});
+  ASSERT_THAT(writer->Write(&batch), IsOk());
+  // Rows are buffered until the writer is closed.
+  EXPECT_TRUE(files_.empty());
+
+  ICEBERG_UNWRAP_OR_FAIL(auto data_files, writer->Close());
+  EXPECT_EQ(writer->spilled_runs(), 0);
+  // Partitions are ordered with nulls first, and rows by descending id.
+  ASSERT_EQ(files_.size(), 3);
+  EXPECT_EQ(files_[0].path, "data/data=null/file-00001.parquet");
+  EXPECT_THAT(files_[0].ids, ::testing::ElementsAre(3));
+  EXPECT_EQ(files_[1].path, "data/data=a/file-00002.parquet");
+  EXPECT_THAT(files_[1].ids, ::testing::ElementsAre(-1, -5));
+  EXPECT_THAT(files_[2].ids, ::testing::ElementsAre(5, 2, 1, 0));
+  ASSERT_EQ(data_files.size(), 3);
+  for (const auto& data_file : data_files) {
+    EXPECT_EQ(data_file.sort_order_id, 1);
+  }
+  // The file writers are told which fields the rows are sorted by.
+  EXPECT_THAT(files_[0].properties,
+              ::testing::Contains(::testing::Pair(
+                  std::string(WriterOptions::kSortedFieldIdsProperty), "1")));
+}
+
+TEST_F(SortedDataWriterTest, MergesSpilledRuns) {
+  auto io = std::make_shared<FakeFileIO>();
+  auto options = Options();
+  options.spec = PartitionSpec::Unpartitioned();
+  options.io = io;
+  auto sort_options = MakeSortOptions(SortDirection::kAscending, NullOrder::kLast, 2);
+  // Every batch exceeds the buffer and is spilled.
+  sort_options.buffer_bytes = 1;
+  ICEBERG_UNWRAP_OR_FAIL(auto writer,
+                         SortedDataWriter::Make(std::move(options), sort_options));
+  auto batch = MakeBatch({0, 1}, {"c", "a"});
+  ASSERT_THAT(writer->Write(&batch), IsOk());
+  batch = MakeBatch({2, 3}, {std::nullopt, std::string("b\0", 2)});
+  ASSERT_THAT(writer->Write(&batch), IsOk());
+  batch = MakeBatch({4, 5, 6}, {"a", "d", "b"});
+  ASSERT_THAT(writer->Write(&batch), IsOk());
+  EXPECT_EQ(writer->spilled_runs(), 3);
+  ASSERT_EQ(files_.size(), 3);
+  EXPECT_EQ(files_[0].path, "spill/file-spill-00001.parquet");
+  EXPECT_THAT(files_[0].ids, ::testing::ElementsAre(1, 0));
+
+  ICEBERG_UNWRAP_OR_FAIL(auto data_files, writer->Close());
+  ASSERT_EQ(files_.size(), 4);
+  ASSERT_EQ(data_files.size(), 1);
+  EXPECT_EQ(data_files[0].file_path, "data/file-00001.parquet");
+  EXPECT_EQ(data_files[0].record_count, 7);
+  // Equal keys keep the order of the input, and nulls are last.
+  EXPECT_THAT(files_[3].ids, ::testing::ElementsAre(1, 4, 6, 3, 0, 5, 2));
+  EXPECT_THAT(io->deleted, ::testing::ElementsAre("spill/file-spill-00001.parquet",
+                                                  "spill/file-spill-00002.parquet",
+                                                  "spill/file-spill-00003.parquet"));
+}
+
+TEST_F(SortedDataWriterTest, OrdersRowsByZOrder) {
+  auto options = Options();
+  options.spec = PartitionSpec::Unpartitioned();
+  auto sort_options = MakeSortOptions(SortDirection::kAscending, NullOrder::kFirst, 1);
+  sort_options.sort_order = SortOrder::Unsorted();
+  sort_options.zorder_field_ids = {1, 2};
+  ICEBERG_UNWRAP_OR_FAIL(auto writer,
+                         SortedDataWriter::Make(std::move(options), sort_options));
+  // The ids and the last characters of the data vary in their two lowest bits, so the
+  // rows are ordered by the interleaved bits (id1, data1, id0, data0).
+  auto batch = MakeBatch({0, 1, 2, 3, 0, 1}, {"prefix-3", "prefix-0", "prefix-1",
+                                              "prefix-3", "prefix-0", "prefix-1"});
+  ASSERT_THAT(writer->Write(&batch), IsOk());
+
+  ICEBERG_UNWRAP_OR_FAIL(auto data_files, writer->Close());
+  ASSERT_EQ(files_.size(), 1);
+  EXPECT_THAT(files_[0].ids, ::testing::ElementsAre(0, 1, 1, 0, 2, 3));
+  EXPECT_THAT(files_[0].data,
+              ::testing::ElementsAre("prefix-0", "prefix-0", "prefix-1", "prefix-3",
+                                     "prefix-1", "prefix-3"));
+  ASSERT_EQ(data_files.size(), 1);
+  EXPECT_FALSE(data_files[0].sort_order_id.has_value());
+}
+
+TEST_F(SortedDataWriterTest, InvalidOptions) {
+  auto sort_options = MakeSortOptions(SortDirection::kAscending, NullOrder::kFirst, 1);
+  sort_options.sort_order = nullptr;
+  EXPECT_THAT(SortedDataWriter::Make(Options(), sort_options),
+              IsError(ErrorKind::kInvalidArgument));
+  sort_options = MakeSortOptions(SortDirection::kAscending, NullOrder::kFirst, 3);
+  EXPECT_THAT(SortedDataWriter::Make(Options(), sort_options),
+              IsError(ErrorKind::kInvalidArgument));
+
+  // Without a spill location, the rows must fit in the buffer.
+  sort_options = MakeSortOptions(SortDirection::kAscending, NullOrder::kFirst, 1);
+  sort_options.buffer_bytes = 1;
+  sort_options.spill_location.clear();
+  ICEBERG_UNWRAP_OR_FAIL(auto writer, SortedDataWriter::Make(Options(), sort_options));
+  auto batch = MakeBatch({0}, {"a"});
+  EXPECT_THAT(writer->Write(&batch), HasErrorMessage("has no spill location"));
+
+  sort_options = MakeSortOptions(SortDirection::kAscending, NullOrder::kFirst, 1);
+  sort_options.zorder_field_ids = {2};
+  sort_options.zorder_bytes_per_column = 0;
+  EXPECT_THAT(SortedDataWriter::Make(Options(), sort_options),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+class DeltaWriterTest : public FanoutDataWriterTest {
+ protected:
+  const WrittenFile& File(const std::string& path) const {
+    static const WrittenFile kMissing;
+    auto it = std::ranges::find(files_, path, &WrittenFile::path);
+    if (it == files_.end()) {
+      ADD_FAILURE() << "File not written: " << path;
+      return kMissing;
+    }
+    return *it;
+  }
+};
+
+TEST_F(DeltaWriterTest, DeletesKeysOfTheCheckpointByPosition) {
+  ICEBERG_UNWRAP_OR_FAIL(auto writer, DeltaWriter::Make(Options(), {1}));
+  auto batch = MakeBatch({1, 2, 3}, {"a", "a", "b"});
+  ASSERT_THAT(writer->Insert(&batch), IsOk());
+  EXPECT_EQ(batch.release, nullptr);
+  EXPECT_EQ(writer->indexed_keys(), 3);
+  // Key 2 was inserted in the checkpoint, and key 4 may be in an earlier commit.
+  batch = MakeBatch({2, 4}, {"a", "b"});
+  ASSERT_THAT(writer->Upsert(&batch), IsOk());
+  batch = MakeBatch({3, 5}, {"b", "a"});
+  ASSERT_THAT(writer->Delete(&batch), IsOk());
+  EXPECT_EQ(writer->indexed_keys(), 3);
+
+  ICEBERG_UNWRAP_OR_FAIL(auto result, writer->Close());
+  EXPECT_EQ(writer->indexed_keys(), 0);
+  EXPECT_THAT(File("data/data=a/file-00001.parquet").ids,
+              ::testing::ElementsAre(1, 2, 2));
+  EXPECT_THAT(File("data/data=b/file-00002.parquet").ids, ::testing::ElementsAre(3, 4));
+  EXPECT_THAT(File("data/data=b/file-eq-deletes-00001.parquet").ids,
+              ::testing::ElementsAre(4));
+  EXPECT_THAT(File("data/data=a/file-eq-deletes-00002.parquet").ids,
+              ::testing::ElementsAre(5));
+  EXPECT_THAT(File("data/data=a/file-pos-deletes-00001.parquet").deletes,
+              ::testing::ElementsAre(
+                  ::testing::Pair("data/data=a/file-00001.parquet", 1)));
+  EXPECT_THAT(File("data/data=b/file-pos-deletes-00002.parquet").deletes,
+              ::testing::ElementsAre(
+                  ::testing::Pair("data/data=b/file-00002.parquet", 0)));
+
+  ASSERT_EQ(result.data_files.size(), 2);
+  ASSERT_EQ(result.delete_files.size(), 4);
+  for (size_t i = 0; i < 2; ++i) {
+    EXPECT_EQ(result.delete_files[i].content, DataFile::Content::kEqualityDeletes);
+    EXPECT_THAT(result.delete_files[i].equality_ids, ::testing::ElementsAre(1));
+  }
+  for (size_t i = 2; i < 4; ++i) {
+    EXPECT_EQ(result.delete_files[i].content, DataFile::Content::kPositionDeletes);
+    EXPECT_EQ(result.delete_files[i].record_count, 1);
+  }
+  EXPECT_EQ(result.delete_files[2].partition, result.data_files[0].partition);
+}
+
+TEST_F(DeltaWriterTest, ReplacesKeysInsertedAgain) {
+  auto options = Options();
+  options.spec = PartitionSpec::Unpartitioned();
+  ICEBERG_UNWRAP_OR_FAIL(auto writer, DeltaWriter::Make(std::move(options), {1, 2}));
+  // Keys are made of both fields, including nulls.
+  auto batch = MakeBatch({1, 1, 1, 1}, {"a", std::nullopt, "a", std::nullopt});
+  ASSERT_THAT(writer->Upsert(&batch), IsOk());
+  EXPECT_EQ(writer->indexed_keys(), 2);
+
+  ICEBERG_UNWRAP_OR_FAIL(auto result, writer->Close());
+  // Each key is deleted once by equality, and its first row by position.
+  EXPECT_THAT(File("data/file-eq-deletes-00001.parquet").ids,
+              ::testing::ElementsAre(1, 1));
+  EXPECT_THAT(File("data/file-pos-deletes-00001.parquet").deletes,
+              ::testing::ElementsAre(::testing::Pair("data/file-00001.parquet", 0),
+                                     ::testing::Pair("data/file-00001.parquet", 1)));
+  EXPECT_EQ(result.data_files.size(), 1);
+  EXPECT_EQ(result.delete_files.size(), 2);
+}
+
+TEST_F(DeltaWriterTest, InvalidOptions) {
+  EXPECT_THAT(DeltaWriter::Make(Options(), {}), IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(DeltaWriter::Make(Options(), {3}), IsError(ErrorKind::kInvalidArgument));
+
+  ICEBERG_UNWRAP_OR_FAIL(auto writer, DeltaWriter::Make(Options(), {1}));
+  ASSERT_THAT(writer->Close(), IsOk());
+  auto batch = MakeBatch({0}, {"a"});
+  EXPECT_THAT(writer->Insert(&batch), IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(writer->Close(), IsError(ErrorKind::kInvalidArgument));
+}
+
+}  // namespace iceberg
@@ -23,6 +23,8 @@
 #include <array>
 #include <bit>
 #include <cstdint>
+#include <span>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -770,4 +772,74 @@ TEST(DecimalTest, Compare) {
             std::partial_ordering::less);
 }
 
+TEST(DecimalTest, BatchBigEndian) {
+  const std::vector<int128_t> values = {0, 1, -1, 127, -128, 1234567, -1234567};
+  for (int32_t byte_width : {3, 8, 16}) {
+    std::vector<uint8_t> bytes(values.size() * byte_width);
+    ASSERT_THAT(Decimal::ToBigEndian(values, byte_width, bytes), IsOk());
+    for (size_t i = 0; i < values.size(); ++i) {
+      auto expected = Decimal::FromBigEndian(bytes.data() + i * byte_width, byte_width);
+      ASSERT_THAT(expected, IsOk());
+      EXPECT_EQ(expected.value(), Decimal(values[i]));
+    }
+
+    std::vector<int128_t> decoded(values.size());
+    ASSERT_THAT(Decimal::FromBigEndian(bytes, byte_width, decoded), IsOk());
+    EXPECT_EQ(decoded, values);
+  }
+
+  std::vector<uint8_t> bytes(2);
+  EXPECT_THAT(Decimal::ToBigEndian(std::vector<int128_t>{128}, 1, bytes),
+              IsError(ErrorKind::kInvalidArgument));
+  std::vector<int128_t> decoded(3);
+  EXPECT_THAT(Decimal::FromBigEndian(bytes, 1, decoded),
+              IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(Decimal::FromBigEndian(bytes, 17, std::span<int128_t>{}),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST(DecimalTest, BatchRescale) {
+  std::vector<int128_t> values = {0, 12345, -12345};
+  ASSERT_THAT(Decimal::Rescale(values, 2, 5, values), IsOk());
+  EXPECT_EQ(values, (std::vector<int128_t>{0, 12345000, -12345000}));
+  ASSERT_THAT(Decimal::Rescale(values, 5, 2, values), IsOk());
+  EXPECT_EQ(values, (std::vector<int128_t>{0, 12345, -12345}));
+
+  std::vector<int128_t> out(values.size());
+  EXPECT_THAT(Decimal::Rescale(values, 2, 1, out), IsError(ErrorKind::kInvalid));
+  const std::vector<int128_t> max_value = {Decimal("99999999999999999999").value()};
+  EXPECT_THAT(Decimal::Rescale(max_value, 0, 20, std::span(out).first(1)),
+              IsError(ErrorKind::kInvalid));
+  EXPECT_THAT(Decimal::Rescale(values, 0, 1, std::span(out).first(1)),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST(DecimalTest, BatchCompare) {
+  // 1.00, 1.23, -1.23 and 1.24 at scale 2.
+  const std::vector<int128_t> values = {100, 123, -123, 124};
+  std::vector<int8_t> out(values.size());
+
+  ASSERT_THAT(Decimal::Compare(values, 2, Decimal(123), 2, out), IsOk());
+  EXPECT_EQ(out, (std::vector<int8_t>{-1, 0, -1, 1}));
+
+  // 1.230 is equal to 1.23.
+  ASSERT_THAT(Decimal::Compare(values, 2, Decimal(1230), 3, out), IsOk());
+  EXPECT_EQ(out, (std::vector<int8_t>{-1, 0, -1, 1}));
+
+  // 1.235 and -1.225 lie between two values at scale 2.
+  ASSERT_THAT(Decimal::Compare(values, 2, Decimal(1235), 3, out), IsOk());
+  EXPECT_EQ(out, (std::vector<int8_t>{-1, -1, -1, 1}));
+  ASSERT_THAT(Decimal::Compare(values, 2, Decimal(-1225), 3, out), IsOk());
+  EXPECT_EQ(out, (std::vector<int8_t>{1, 1, -1, 1}));
+
+  // 1 at scale 0 is upscaled to 1.00.
+  ASSERT_THAT(Decimal::Compare(values, 2, Decimal(1), 0, out), IsOk());
+  EXPECT_EQ(out, (std::vector<int8_t>{0, 1, -1, 1}));
+
+  // A value out of the range of the scale is greater than all values.
+  ASSERT_THAT(Decimal::Compare(values, 20, Decimal("99999999999999999999"), 0, out),
+              IsOk());
+  EXPECT_EQ(out, (std::vector<int8_t>{-1, -1, -1, -1}));
+}
+
 }  // namespace iceberg
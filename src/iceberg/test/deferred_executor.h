@@ -0,0 +1,51 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "iceberg/executor.h"
+
+namespace iceberg {
+
+/// \brief An executor that holds the submitted tasks until they are run explicitly.
+class DeferredExecutor : public Executor {
+ public:
+  void Submit(std::function<void()> task) override { tasks_.push_back(std::move(task)); }
+
+  int32_t concurrency() const override { return 1; }
+
+  size_t RunAll() {
+    auto tasks = std::move(tasks_);
+    for (auto& task : tasks) {
+      task();
+    }
+    return tasks.size();
+  }
+
+ private:
+  std::vector<std::function<void()>> tasks_;
+};
+
+}  // namespace iceberg
@@ -0,0 +1,104 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/manifest_reader.h"
+#include "iceberg/manifest_writer.h"
+#include "iceberg/result.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/snapshot_producer.h"
+#include "iceberg/table.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+/// \brief Removes data files from a table, rewriting the manifests that have them.
+class DeleteDataFiles : public SnapshotProducer {
+ public:
+  DeleteDataFiles(std::shared_ptr<Table> table, std::unordered_set<std::string> paths)
+      : SnapshotProducer(std::move(table)), paths_(std::move(paths)) {}
+
+  Status Commit() { return CommitSnapshot(); }
+
+ protected:
+  const std::string& operation() const override { return DataOperation::kDelete; }
+
+  Result<std::vector<ManifestFile>> Apply(const TableMetadata& base,
+                                          const Snapshot* parent) override {
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto reader, ManifestListReader::Make(parent->manifest_list, table()->io()));
+    ICEBERG_ASSIGN_OR_RAISE(auto manifest_files, reader->Files());
+    std::vector<ManifestFile> manifests;
+    for (auto& manifest_file : manifest_files) {
+      ICEBERG_ASSIGN_OR_RAISE(auto manifest_reader,
+                              ManifestReader::Make(manifest_file, table()->io(),
+                                                   /*partition_schema=*/nullptr));
+      ICEBERG_ASSIGN_OR_RAISE(auto entries, manifest_reader->Entries());
+      auto removed = [&](const ManifestEntry& entry) {
+        return entry.status != ManifestStatus::kDeleted &&
+               paths_.contains(entry.data_file->file_path);
+      };
+      if (std::ranges::none_of(entries, removed)) {
+        manifests.push_back(std::move(manifest_file));
+        continue;
+      }
+
+      ICEBERG_ASSIGN_OR_RAISE(auto spec,
+                              base.PartitionSpecById(manifest_file.partition_spec_id));
+      ICEBERG_ASSIGN_OR_RAISE(auto writer, NewManifestWriter(base, std::move(spec)));
+      for (auto& entry : entries) {
+        if (entry.status == ManifestStatus::kDeleted) {
+          continue;
+        }
+        if (removed(entry)) {
+          entry.status = ManifestStatus::kDeleted;
+          entry.snapshot_id = snapshot_id();
+        } else {
+          entry.status = ManifestStatus::kExisting;
+        }
+        ICEBERG_RETURN_UNEXPECTED(writer->Add(entry));
+      }
+      ICEBERG_RETURN_UNEXPECTED(writer->Close());
+      ICEBERG_ASSIGN_OR_RAISE(auto manifest, writer->ToManifestFile());
+      manifests.push_back(std::move(manifest));
+    }
+    return manifests;
+  }
+
+  std::unordered_map<std::string, std::string> Summary() const override { return {}; }
+
+  void CleanUncommitted(const std::unordered_set<std::string>& /*committed*/) override {}
+
+ private:
+  std::unordered_set<std::string> paths_;
+};
+
+}  // namespace iceberg
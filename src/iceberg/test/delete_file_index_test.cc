@@ -0,0 +1,243 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/deletes/delete_file_index.h"
+
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/manifest_entry.h"
+#include "iceberg/metadata_columns.h"
+#include "iceberg/schema.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/type.h"
+#include "iceberg/util/conversions.h"
+
+namespace iceberg {
+
+namespace {
+
+std::vector<uint8_t> IntBound(int32_t value) {
+  return Conversions::ToBytes(Literal::Int(value)).value();
+}
+
+std::vector<uint8_t> PathBound(const std::string& path) {
+  return {path.begin(), path.end()};
+}
+
+std::shared_ptr<DataFile> MakeFile(std::string path, DataFile::Content content,
+                                   std::vector<Literal> partition = {},
+                                   int32_t spec_id = 0) {
+  auto file = std::make_shared<DataFile>();
+  file->content = content;
+  file->file_path = std::move(path);
+  file->file_format = FileFormatType::kParquet;
+  file->partition = std::move(partition);
+  file->partition_spec_id = spec_id;
+  return file;
+}
+
+std::shared_ptr<DataFile> MakeEqualityDelete(std::string path,
+                                             std::vector<Literal> partition = {}) {
+  auto file = MakeFile(std::move(path), DataFile::Content::kEqualityDeletes,
+                       std::move(partition));
+  file->equality_ids = {1};
+  return file;
+}
+
+ManifestEntry MakeEntry(std::shared_ptr<DataFile> file, int64_t sequence_number) {
+  return ManifestEntry{.status = ManifestStatus::kAdded,
+                       .sequence_number = sequence_number,
+                       .data_file = std::move(file)};
+}
+
+std::shared_ptr<Schema> TableSchema() {
+  return std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeOptional(1, "id", int32())});
+}
+
+std::vector<std::string> DeletePaths(const DeleteFileIndex& index,
+                                     const DataFile& data_file,
+                                     int64_t sequence_number) {
+  auto delete_files = index.ForDataFile(data_file, sequence_number);
+  EXPECT_THAT(delete_files, IsOk());
+  std::vector<std::string> paths;
+  for (const auto& delete_file : delete_files.value()) {
+    paths.push_back(delete_file->file_path);
+  }
+  return paths;
+}
+
+}  // namespace
+
+TEST(DeleteFileIndexTest, EmptyIndex) {
+  auto index = DeleteFileIndex::Make(TableSchema(), {});
+  ASSERT_THAT(index, IsOk());
+  EXPECT_TRUE(index->IsEmpty());
+  auto data_file = MakeFile("data.parquet", DataFile::Content::kData);
+  EXPECT_THAT(DeletePaths(*index, *data_file, 1), ::testing::IsEmpty());
+}
+
+TEST(DeleteFileIndexTest, SequenceNumbers) {
+  const std::vector<Literal> partition = {Literal::Int(1)};
+  std::vector<ManifestEntry> entries;
+  for (int64_t sequence_number : {3, 1, 2}) {
+    const auto suffix = std::to_string(sequence_number);
+    entries.push_back(MakeEntry(
+        MakeFile("pos-" + suffix, DataFile::Content::kPositionDeletes, partition),
+        sequence_number));
+    entries.push_back(MakeEntry(MakeEqualityDelete("eq-" + suffix), sequence_number));
+  }
+  auto index = DeleteFileIndex::Make(TableSchema(), std::move(entries));
+  ASSERT_THAT(index, IsOk());
+  EXPECT_FALSE(index->IsEmpty());
+
+  auto data_file = MakeFile("data.parquet", DataFile::Content::kData, partition);
+  // Position deletes apply to data of the same sequence number, equality deletes do
+  // not.
+  EXPECT_THAT(DeletePaths(*index, *data_file, 2),
+              ::testing::ElementsAre("pos-2", "pos-3", "eq-3"));
+  EXPECT_THAT(DeletePaths(*index, *data_file, 3), ::testing::ElementsAre("pos-3"));
+  EXPECT_THAT(DeletePaths(*index, *data_file, 4), ::testing::IsEmpty());
+}
+
+TEST(DeleteFileIndexTest, PartitionScopedDeletes) {
+  std::vector<ManifestEntry> entries;
+  entries.push_back(MakeEntry(
+      MakeFile("pos-p1", DataFile::Content::kPositionDeletes, {Literal::Int(1)}), 1));
+  entries.push_back(MakeEntry(MakeEqualityDelete("eq-p1", {Literal::Int(1)}), 2));
+  entries.push_back(MakeEntry(MakeEqualityDelete("eq-global"), 2));
+  auto index = DeleteFileIndex::Make(TableSchema(), std::move(entries));
+  ASSERT_THAT(index, IsOk());
+
+  auto p1 = MakeFile("p1.parquet", DataFile::Content::kData, {Literal::Int(1)});
+  EXPECT_THAT(DeletePaths(*index, *p1, 1),
+              ::testing::ElementsAre("pos-p1", "eq-global", "eq-p1"));
+  auto p2 = MakeFile("p2.parquet", DataFile::Content::kData, {Literal::Int(2)});
+  EXPECT_THAT(DeletePaths(*index, *p2, 1), ::testing::ElementsAre("eq-global"));
+  // The same partition tuple of another spec is another partition.
+  auto other_spec =
+      MakeFile("spec1.parquet", DataFile::Content::kData, {Literal::Int(1)}, 1);
+  EXPECT_THAT(DeletePaths(*index, *other_spec, 1), ::testing::ElementsAre("eq-global"));
+}
+
+TEST(DeleteFileIndexTest, PathScopedDeletes) {
+  const int32_t path_id = MetadataColumns::kDeleteFilePath.field_id();
+  std::vector<ManifestEntry> entries;
+  auto referenced = MakeFile("pos-a", DataFile::Content::kPositionDeletes);
+  referenced->referenced_data_file = "a.parquet";
+  entries.push_back(MakeEntry(referenced, 1));
+  // Equal bounds of the path reference a single data file.
+  auto bounded = MakeFile("pos-b", DataFile::Content::kPositionDeletes);
+  bounded->lower_bounds[path_id] = PathBound("b.parquet");
+  bounded->upper_bounds[path_id] = PathBound("b.parquet");
+  entries.push_back(MakeEntry(bounded, 1));
+  auto vector = MakeFile("dv-b", DataFile::Content::kPositionDeletes);
+  vector->file_format = FileFormatType::kPuffin;
+  vector->referenced_data_file = "b.parquet";
+  entries.push_back(MakeEntry(vector, 2));
+  auto index = DeleteFileIndex::Make(TableSchema(), std::move(entries));
+  ASSERT_THAT(index, IsOk());
+
+  auto a = MakeFile("a.parquet", DataFile::Content::kData);
+  EXPECT_THAT(DeletePaths(*index, *a, 1), ::testing::ElementsAre("pos-a"));
+  // A deletion vector replaces the position delete files of its data file.
+  auto b = MakeFile("b.parquet", DataFile::Content::kData);
+  EXPECT_THAT(DeletePaths(*index, *b, 1), ::testing::ElementsAre("dv-b"));
+  auto c = MakeFile("c.parquet", DataFile::Content::kData);
+  EXPECT_THAT(DeletePaths(*index, *c, 1), ::testing::IsEmpty());
+}
+
+TEST(DeleteFileIndexTest, PrunePositionDeletesByPathBounds) {
+  const int32_t path_id = MetadataColumns::kDeleteFilePath.field_id();
+  auto delete_file = MakeFile("pos", DataFile::Content::kPositionDeletes);
+  delete_file->lower_bounds[path_id] = PathBound("b.parquet");
+  delete_file->upper_bounds[path_id] = PathBound("d.parquet");
+  std::vector<ManifestEntry> entries;
+  entries.push_back(MakeEntry(delete_file, 1));
+  auto index = DeleteFileIndex::Make(TableSchema(), std::move(entries));
+  ASSERT_THAT(index, IsOk());
+
+  for (const auto* path : {"a.parquet", "e.parquet"}) {
+    auto data_file = MakeFile(path, DataFile::Content::kData);
+    EXPECT_THAT(DeletePaths(*index, *data_file, 1), ::testing::IsEmpty()) << path;
+  }
+  auto data_file = MakeFile("c.parquet", DataFile::Content::kData);
+  EXPECT_THAT(DeletePaths(*index, *data_file, 1), ::testing::ElementsAre("pos"));
+}
+
+TEST(DeleteFileIndexTest, PruneEqualityDeletesByBounds) {
+  auto with_metrics = [](std::shared_ptr<DataFile> file, int32_t lower, int32_t upper,
+                         int64_t null_count = 0) {
+    file->lower_bounds[1] = IntBound(lower);
+    file->upper_bounds[1] = IntBound(upper);
+    file->value_counts[1] = 10;
+    file->null_value_counts[1] = null_count;
+    return file;
+  };
+  std::vector<ManifestEntry> entries;
+  entries.push_back(MakeEntry(with_metrics(MakeEqualityDelete("low"), 1, 5), 2));
+  entries.push_back(MakeEntry(with_metrics(MakeEqualityDelete("mid"), 8, 12), 2));
+  entries.push_back(MakeEntry(with_metrics(MakeEqualityDelete("nulls"), 50, 60, 1), 2));
+  entries.push_back(MakeEntry(MakeEqualityDelete("no-metrics"), 2));
+  auto index = DeleteFileIndex::Make(TableSchema(), std::move(entries));
+  ASSERT_THAT(index, IsOk());
+
+  auto data_file = with_metrics(MakeFile("data", DataFile::Content::kData), 10, 20);
+  EXPECT_THAT(DeletePaths(*index, *data_file, 1),
+              ::testing::ElementsAre("mid", "no-metrics"));
+
+  // Deleted nulls apply to data files with nulls, whatever their bounds.
+  data_file->null_value_counts[1] = 2;
+  EXPECT_THAT(DeletePaths(*index, *data_file, 1),
+              ::testing::ElementsAre("mid", "nulls", "no-metrics"));
+
+  // Only null values are not deleted by deletes without nulls.
+  auto all_null = MakeFile("all-null", DataFile::Content::kData);
+  all_null->value_counts[1] = 3;
+  all_null->null_value_counts[1] = 3;
+  EXPECT_THAT(DeletePaths(*index, *all_null, 1),
+              ::testing::ElementsAre("nulls", "no-metrics"));
+
+  // Without the schema, the bounds cannot be compared.
+  std::vector<ManifestEntry> unpruned;
+  unpruned.push_back(MakeEntry(with_metrics(MakeEqualityDelete("low"), 1, 5), 2));
+  auto no_schema = DeleteFileIndex::Make(nullptr, std::move(unpruned));
+  ASSERT_THAT(no_schema, IsOk());
+  EXPECT_THAT(DeletePaths(*no_schema, *data_file, 1), ::testing::ElementsAre("low"));
+}
+
+TEST(DeleteFileIndexTest, InvalidDeleteFiles) {
+  std::vector<ManifestEntry> data_entries;
+  data_entries.push_back(MakeEntry(MakeFile("data", DataFile::Content::kData), 1));
+  EXPECT_THAT(DeleteFileIndex::Make(TableSchema(), std::move(data_entries)),
+              IsError(ErrorKind::kInvalidArgument));
+
+  auto vector = MakeFile("dv", DataFile::Content::kPositionDeletes);
+  vector->file_format = FileFormatType::kPuffin;
+  std::vector<ManifestEntry> vector_entries;
+  vector_entries.push_back(MakeEntry(vector, 1));
+  EXPECT_THAT(DeleteFileIndex::Make(TableSchema(), std::move(vector_entries)),
+              IsError(ErrorKind::kInvalidManifest));
+}
+
+}  // namespace iceberg
@@ -0,0 +1,145 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/deletes/deletion_vector_writer.h"
+
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include "iceberg/deletes/position_delete_index.h"
+#include "iceberg/file_io.h"
+#include "iceberg/test/matchers.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief A FileIO that keeps the written files in memory.
+class InMemoryFileIO : public FileIO {
+ public:
+  Status WriteFile(const std::string& file_location, std::string_view content) override {
+    files[file_location] = std::string(content);
+    return {};
+  }
+
+  std::map<std::string, std::string> files;
+};
+
+DataFile MakeDataFile(std::string path, int32_t partition) {
+  DataFile data_file;
+  data_file.file_path = std::move(path);
+  data_file.partition = {Literal::Int(partition)};
+  data_file.partition_spec_id = 3;
+  return data_file;
+}
+
+/// \brief Returns the footer metadata of a Puffin file.
+nlohmann::json PuffinFooter(const std::string& content) {
+  int32_t payload_size;
+  std::memcpy(&payload_size, content.data() + content.size() - 12, sizeof(int32_t));
+  return nlohmann::json::parse(
+      content.substr(content.size() - 12 - payload_size, payload_size));
+}
+
+}  // namespace
+
+TEST(DeletionVectorWriterTest, WritesPuffinFile) {
+  auto io = std::make_shared<InMemoryFileIO>();
+  ICEBERG_UNWRAP_OR_FAIL(auto writer, DeletionVectorWriter::Make(
+                                          {.path = "deletes.puffin", .io = io}));
+  const auto b = MakeDataFile("b.parquet", 1);
+  const auto a = MakeDataFile("a.parquet", 2);
+  ASSERT_THAT(writer->Delete(b, 4), IsOk());
+  ASSERT_THAT(writer->Delete(a, 9), IsOk());
+  ASSERT_THAT(writer->Delete(b, 1), IsOk());
+  // The positions of a previous deletion vector are merged.
+  PositionDeleteIndex previous;
+  previous.Delete(10, 12);
+  ASSERT_THAT(writer->Delete(a, previous), IsOk());
+  EXPECT_THAT(writer->Delete(a, -1), IsError(ErrorKind::kInvalidArgument));
+
+  ICEBERG_UNWRAP_OR_FAIL(auto delete_files, writer->Close());
+  ASSERT_EQ(io->files.size(), 1);
+  const std::string& content = io->files.at("deletes.puffin");
+  EXPECT_EQ(content.substr(0, 4), "PFA1");
+  EXPECT_EQ(content.substr(content.size() - 4), "PFA1");
+  EXPECT_EQ(content.substr(content.size() - 8, 4), std::string(4, '\0'));
+
+  ASSERT_EQ(delete_files.size(), 2);
+  const auto footer = PuffinFooter(content);
+  ASSERT_EQ(footer["blobs"].size(), 2);
+  const std::vector<int64_t> cardinalities = {3, 2};
+  for (size_t i = 0; i < delete_files.size(); ++i) {
+    const auto& delete_file = delete_files[i];
+    EXPECT_EQ(delete_file.content, DataFile::Content::kPositionDeletes);
+    EXPECT_EQ(delete_file.file_format, FileFormatType::kPuffin);
+    EXPECT_EQ(delete_file.file_path, "deletes.puffin");
+    EXPECT_EQ(delete_file.file_size_in_bytes, static_cast<int64_t>(content.size()));
+    EXPECT_EQ(delete_file.record_count, cardinalities[i]);
+    EXPECT_EQ(delete_file.partition_spec_id, 3);
+    ASSERT_TRUE(delete_file.content_offset.has_value());
+    ASSERT_TRUE(delete_file.content_size_in_bytes.has_value());
+
+    const auto& blob = footer["blobs"][i];
+    EXPECT_EQ(blob["type"], "deletion-vector-v1");
+    EXPECT_EQ(blob["offset"], delete_file.content_offset.value());
+    EXPECT_EQ(blob["length"], delete_file.content_size_in_bytes.value());
+    EXPECT_EQ(blob["properties"]["referenced-data-file"],
+              delete_file.referenced_data_file.value());
+    EXPECT_EQ(blob["properties"]["cardinality"], std::to_string(cardinalities[i]));
+
+    ICEBERG_UNWRAP_OR_FAIL(
+        auto positions,
+        PositionDeleteIndex::DeserializeDeletionVector(std::string_view(content).substr(
+            delete_file.content_offset.value(),
+            delete_file.content_size_in_bytes.value())));
+    EXPECT_EQ(positions.Cardinality(), cardinalities[i]);
+  }
+  // Deletion vectors are ordered by the paths of their data files.
+  EXPECT_EQ(delete_files[0].referenced_data_file, "a.parquet");
+  EXPECT_EQ(delete_files[0].partition, a.partition);
+  EXPECT_EQ(delete_files[1].referenced_data_file, "b.parquet");
+  EXPECT_EQ(delete_files[1].partition, b.partition);
+  EXPECT_EQ(delete_files[0].content_offset, 4);
+}
+
+TEST(DeletionVectorWriterTest, NoDeletes) {
+  auto io = std::make_shared<InMemoryFileIO>();
+  ICEBERG_UNWRAP_OR_FAIL(auto writer, DeletionVectorWriter::Make(
+                                          {.path = "deletes.puffin", .io = io}));
+  ICEBERG_UNWRAP_OR_FAIL(auto delete_files, writer->Close());
+  EXPECT_TRUE(delete_files.empty());
+  EXPECT_TRUE(io->files.empty());
+
+  EXPECT_THAT(DeletionVectorWriter::Make({.path = "deletes.puffin"}),
+              IsError(ErrorKind::kInvalidArgument));
+  ICEBERG_UNWRAP_OR_FAIL(writer, DeletionVectorWriter::Make(
+                                     {.path = "deletes.puffin", .io = io}));
+  auto delete_file = MakeDataFile("deletes.parquet", 1);
+  delete_file.content = DataFile::Content::kPositionDeletes;
+  EXPECT_THAT(writer->Delete(delete_file, 1), IsError(ErrorKind::kInvalidArgument));
+}
+
+}  // namespace iceberg
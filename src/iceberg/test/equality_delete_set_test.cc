@@ -0,0 +1,307 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/deletes/equality_delete_set.h"
+
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/schema.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief A hand-built Arrow array that owns its buffers.
+struct ArrowNode {
+  std::string format;
+  std::vector<uint8_t> validity;
+  std::vector<uint8_t> data;
+  std::vector<int32_t> offsets;
+  std::vector<std::unique_ptr<ArrowNode>> children;
+  std::vector<const void*> buffers;
+  std::vector<ArrowSchema*> child_schemas;
+  std::vector<ArrowArray*> child_arrays;
+  ArrowSchema schema{};
+  ArrowArray array{};
+
+  void SetValid(int64_t index, bool valid) {
+    if (validity.size() <= static_cast<size_t>(index / 8)) {
+      validity.resize(index / 8 + 1, 0);
+    }
+    if (valid) {
+      validity[index / 8] |= 1 << (index % 8);
+    } else {
+      ++array.null_count;
+    }
+  }
+
+  void Finish(int64_t length) {
+    for (auto& child : children) {
+      child_schemas.push_back(&child->schema);
+      child_arrays.push_back(&child->array);
+    }
+    schema.format = format.c_str();
+    schema.n_children = static_cast<int64_t>(children.size());
+    schema.children = child_schemas.data();
+    array.length = length;
+    array.n_children = static_cast<int64_t>(children.size());
+    array.children = child_arrays.data();
+    array.n_buffers = static_cast<int64_t>(buffers.size());
+    array.buffers = buffers.data();
+  }
+};
+
+template <typename T>
+std::unique_ptr<ArrowNode> MakePrimitive(std::string format,
+                                         const std::vector<std::optional<T>>& values) {
+  auto node = std::make_unique<ArrowNode>();
+  node->format = std::move(format);
+  node->data.resize(values.size() * sizeof(T));
+  for (size_t i = 0; i < values.size(); ++i) {
+    node->SetValid(i, values[i].has_value());
+    T value = values[i].value_or(T{});
+    std::memcpy(node->data.data() + i * sizeof(T), &value, sizeof(T));
+  }
+  node->buffers = {node->validity.data(), node->data.data()};
+  node->Finish(static_cast<int64_t>(values.size()));
+  return node;
+}
+
+std::unique_ptr<ArrowNode> MakeStrings(
+    const std::vector<std::optional<std::string>>& values) {
+  auto node = std::make_unique<ArrowNode>();
+  node->format = "u";
+  node->offsets.push_back(0);
+  for (size_t i = 0; i < values.size(); ++i) {
+    node->SetValid(i, values[i].has_value());
+    std::string value = values[i].value_or("");
+    node->data.insert(node->data.end(), value.begin(), value.end());
+    node->offsets.push_back(static_cast<int32_t>(node->data.size()));
+  }
+  node->buffers = {node->validity.data(), node->offsets.data(), node->data.data()};
+  node->Finish(static_cast<int64_t>(values.size()));
+  return node;
+}
+
+std::unique_ptr<ArrowNode> MakeStruct(std::vector<std::unique_ptr<ArrowNode>> children,
+                                      const std::vector<bool>& valid) {
+  auto node = std::make_unique<ArrowNode>();
+  node->format = "+s";
+  node->children = std::move(children);
+  for (size_t i = 0; i < valid.size(); ++i) {
+    node->SetValid(i, valid[i]);
+  }
+  node->buffers = {node->validity.data()};
+  node->Finish(static_cast<int64_t>(valid.size()));
+  return node;
+}
+
+std::unique_ptr<ArrowNode> MakeBatch(
+    const std::vector<std::optional<int32_t>>& ids,
+    const std::vector<std::optional<std::string>>& names) {
+  std::vector<std::unique_ptr<ArrowNode>> columns;
+  columns.push_back(MakePrimitive<int32_t>("i", ids));
+  columns.push_back(MakeStrings(names));
+  return MakeStruct(std::move(columns), std::vector<bool>(ids.size(), true));
+}
+
+}  // namespace
+
+class EqualityDeleteSetTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    schema_ = std::make_shared<Schema>(
+        std::vector<SchemaField>{SchemaField::MakeOptional(1, "id", int32()),
+                                 SchemaField::MakeOptional(2, "name", string())},
+        /*schema_id=*/0);
+  }
+
+  /// \brief Returns the rows of a batch that are not deleted.
+  std::vector<int64_t> Remaining(const EqualityDeleteSet& deletes, const Schema& schema,
+                                 const ArrowNode& batch) {
+    std::vector<uint8_t> selection((batch.array.length + 7) / 8, 0xFF);
+    EXPECT_THAT(deletes.RemoveDeleted(schema, batch.schema, batch.array, selection),
+                IsOk());
+    std::vector<int64_t> remaining;
+    for (int64_t i = 0; i < batch.array.length; ++i) {
+      if ((selection[i / 8] >> (i % 8)) & 1) {
+        remaining.push_back(i);
+      }
+    }
+    return remaining;
+  }
+
+  std::shared_ptr<Schema> schema_;
+};
+
+using ::testing::ElementsAre;
+
+TEST_F(EqualityDeleteSetTest, RemoveDeletedRows) {
+  auto deletes = EqualityDeleteSet::Make(*schema_, {2, 1});
+  ASSERT_THAT(deletes, IsOk());
+  EXPECT_EQ(deletes->equality_field_ids(), (std::vector<int32_t>{1, 2}));
+  EXPECT_EQ(deletes->schema()->fields().size(), 2);
+  EXPECT_TRUE(deletes->IsEmpty());
+
+  auto delete_rows = MakeBatch({1, 2, 2, std::nullopt}, {"a", "b", "b", "d"});
+  ASSERT_THAT(deletes->Add(*schema_, delete_rows->schema, delete_rows->array), IsOk());
+  EXPECT_EQ(deletes->size(), 3);
+
+  // Nulls match nulls, and all equality fields must match.
+  auto data = MakeBatch({1, 1, 2, std::nullopt, 3, std::nullopt},
+                        {"a", "b", "b", "d", "a", std::nullopt});
+  EXPECT_THAT(Remaining(*deletes, *schema_, *data), ElementsAre(1, 4, 5));
+}
+
+TEST_F(EqualityDeleteSetTest, SingleField) {
+  auto deletes = EqualityDeleteSet::Make(*schema_, {2});
+  ASSERT_THAT(deletes, IsOk());
+  EXPECT_EQ(deletes->schema()->fields().size(), 1);
+
+  // Delete files only contain the equality fields.
+  std::vector<std::unique_ptr<ArrowNode>> columns;
+  columns.push_back(MakeStrings({"b", std::nullopt}));
+  auto delete_rows = MakeStruct(std::move(columns), {true, true});
+  ASSERT_THAT(deletes->Add(*deletes->schema(), delete_rows->schema, delete_rows->array),
+              IsOk());
+
+  auto data = MakeBatch({1, 2, 3, 4}, {"a", "b", std::nullopt, ""});
+  EXPECT_THAT(Remaining(*deletes, *schema_, *data), ElementsAre(0, 3));
+}
+
+TEST_F(EqualityDeleteSetTest, FloatingPointValues) {
+  Schema schema({SchemaField::MakeOptional(1, "value", float64())});
+  auto deletes = EqualityDeleteSet::Make(schema, {1});
+  ASSERT_THAT(deletes, IsOk());
+
+  std::vector<std::unique_ptr<ArrowNode>> delete_columns;
+  delete_columns.push_back(
+      MakePrimitive<double>("g", {std::numeric_limits<double>::quiet_NaN(), 0.0}));
+  auto delete_rows = MakeStruct(std::move(delete_columns), {true, true});
+  ASSERT_THAT(deletes->Add(schema, delete_rows->schema, delete_rows->array), IsOk());
+
+  // NaN values are equal regardless of their sign, while zeros of different signs are
+  // distinct values.
+  std::vector<std::unique_ptr<ArrowNode>> columns;
+  columns.push_back(MakePrimitive<double>(
+      "g", {-std::numeric_limits<double>::quiet_NaN(), -0.0, 0.0, 1.0, std::nullopt}));
+  auto data = MakeStruct(std::move(columns), std::vector<bool>(5, true));
+  EXPECT_THAT(Remaining(*deletes, schema, *data), ElementsAre(1, 3, 4));
+}
+
+TEST_F(EqualityDeleteSetTest, NestedField) {
+  Schema schema(
+      {SchemaField::MakeRequired(1, "id", int64()),
+       SchemaField::MakeOptional(2, "location",
+                                 std::make_shared<StructType>(std::vector<SchemaField>{
+                                     SchemaField::MakeOptional(3, "city", string())}))});
+  auto deletes = EqualityDeleteSet::Make(schema, {3});
+  ASSERT_THAT(deletes, IsOk());
+
+  std::vector<std::unique_ptr<ArrowNode>> delete_location;
+  delete_location.push_back(MakeStrings({"paris", "rome"}));
+  std::vector<std::unique_ptr<ArrowNode>> delete_columns;
+  delete_columns.push_back(MakeStruct(std::move(delete_location), {true, false}));
+  auto delete_rows = MakeStruct(std::move(delete_columns), {true, true});
+  ASSERT_THAT(deletes->Add(*deletes->schema(), delete_rows->schema, delete_rows->array),
+              IsOk());
+
+  // A null parent struct makes its fields null.
+  std::vector<std::unique_ptr<ArrowNode>> location;
+  location.push_back(MakeStrings({"paris", "rome", "rome", std::nullopt}));
+  std::vector<std::unique_ptr<ArrowNode>> columns;
+  columns.push_back(MakePrimitive<int64_t>("l", {1, 2, 3, 4}));
+  columns.push_back(MakeStruct(std::move(location), {true, true, false, true}));
+  auto data = MakeStruct(std::move(columns), std::vector<bool>(4, true));
+  EXPECT_THAT(Remaining(*deletes, schema, *data), ElementsAre(1));
+}
+
+TEST_F(EqualityDeleteSetTest, Merge) {
+  auto deletes = EqualityDeleteSet::Make(*schema_, {1});
+  ASSERT_THAT(deletes, IsOk());
+  auto other = EqualityDeleteSet::Make(*schema_, {1});
+  ASSERT_THAT(other, IsOk());
+  auto rows = MakeBatch({1, 2}, {"a", "b"});
+  auto other_rows = MakeBatch({2, 3}, {"b", "c"});
+  ASSERT_THAT(deletes->Add(*schema_, rows->schema, rows->array), IsOk());
+  ASSERT_THAT(other->Add(*schema_, other_rows->schema, other_rows->array), IsOk());
+
+  ASSERT_THAT(deletes->Merge(*other), IsOk());
+  EXPECT_EQ(deletes->size(), 3);
+  auto data = MakeBatch({0, 1, 2, 3, 4}, {"", "", "", "", ""});
+  EXPECT_THAT(Remaining(*deletes, *schema_, *data), ElementsAre(0, 4));
+
+  auto by_name = EqualityDeleteSet::Make(*schema_, {2});
+  ASSERT_THAT(by_name, IsOk());
+  EXPECT_THAT(deletes->Merge(*by_name), IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(EqualityDeleteSetTest, SerializeRoundTrip) {
+  auto deletes = EqualityDeleteSet::Make(*schema_, {2, 1});
+  ASSERT_THAT(deletes, IsOk());
+  auto rows = MakeBatch({1, 2, std::nullopt}, {"a", "b", "c"});
+  ASSERT_THAT(deletes->Add(*schema_, rows->schema, rows->array), IsOk());
+  EXPECT_GT(deletes->size_bytes(), 0);
+
+  auto restored = EqualityDeleteSet::Deserialize(*schema_, deletes->Serialize());
+  ASSERT_THAT(restored, IsOk());
+  EXPECT_EQ(restored->equality_field_ids(), (std::vector<int32_t>{1, 2}));
+  EXPECT_EQ(restored->size(), 3);
+  auto data = MakeBatch({1, 1, 2, std::nullopt}, {"a", "b", "b", "c"});
+  EXPECT_THAT(Remaining(*restored, *schema_, *data), ElementsAre(1));
+
+  auto truncated = deletes->Serialize();
+  truncated.pop_back();
+  EXPECT_THAT(EqualityDeleteSet::Deserialize(*schema_, truncated),
+              IsError(ErrorKind::kInvalid));
+}
+
+TEST_F(EqualityDeleteSetTest, InvalidFields) {
+  Schema schema({SchemaField::MakeOptional(
+      1, "tags", std::make_shared<ListType>(SchemaField::MakeOptional(2, "element",
+                                                                      string())))});
+  EXPECT_THAT(EqualityDeleteSet::Make(schema, {}), IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(EqualityDeleteSet::Make(schema, {3}), IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(EqualityDeleteSet::Make(schema, {1}), IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(EqualityDeleteSet::Make(schema, {2}), IsError(ErrorKind::kInvalidArgument));
+
+  // The equality fields must be in the schema of the probed batches.
+  auto deletes = EqualityDeleteSet::Make(*schema_, {2});
+  ASSERT_THAT(deletes, IsOk());
+  auto rows = MakeBatch({1}, {"a"});
+  ASSERT_THAT(deletes->Add(*schema_, rows->schema, rows->array), IsOk());
+  Schema ids({SchemaField::MakeOptional(1, "id", int32())});
+  std::vector<std::unique_ptr<ArrowNode>> columns;
+  columns.push_back(MakePrimitive<int32_t>("i", {1}));
+  auto batch = MakeStruct(std::move(columns), {true});
+  std::vector<uint8_t> selection(1, 0xFF);
+  EXPECT_THAT(deletes->RemoveDeleted(ids, batch->schema, batch->array, selection),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+}  // namespace iceberg
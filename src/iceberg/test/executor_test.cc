@@ -0,0 +1,154 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/executor.h"
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/test/deferred_executor.h"
+#include "iceberg/test/matchers.h"
+
+namespace iceberg {
+
+TEST(ExecutorTest, ThreadPoolRunsSubmittedTasks) {
+  EXPECT_THAT(ThreadPoolExecutor::Make(0), IsError(ErrorKind::kInvalidArgument));
+
+  std::atomic<int32_t> count = 0;
+  {
+    ICEBERG_UNWRAP_OR_FAIL(auto pool, ThreadPoolExecutor::Make(4));
+    EXPECT_EQ(pool->concurrency(), 4);
+    for (int32_t i = 0; i < 100; ++i) {
+      // Tasks submitted by a task go to the queue of its thread.
+      pool->Submit([&count, executor = pool.get()]() {
+        executor->Submit([&count]() { ++count; });
+        ++count;
+      });
+    }
+    // Destroying the pool runs the submitted tasks.
+  }
+  EXPECT_EQ(count, 200);
+}
+
+TEST(ExecutorTest, ThreadPoolReleasedByItsOwnTask) {
+  std::atomic<bool> released = false;
+  std::atomic<int32_t> count = 0;
+  {
+    ICEBERG_UNWRAP_OR_FAIL(std::shared_ptr<Executor> pool, ThreadPoolExecutor::Make(1));
+    // The task holds the last reference to the pool once it is released here.
+    pool->Submit([pool, &released]() {
+      while (!released) {
+        std::this_thread::yield();
+      }
+    });
+    for (int32_t i = 0; i < 3; ++i) {
+      pool->Submit([&count]() { ++count; });
+    }
+  }
+  released = true;
+  // The pool is destroyed by its thread, which runs the queued tasks first.
+  while (count < 3) {
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(count, 3);
+}
+
+TEST(ExecutorTest, DefaultExecutor) {
+  auto executor = DefaultExecutor();
+  ASSERT_NE(executor, nullptr);
+  EXPECT_EQ(executor, DefaultExecutor());
+  EXPECT_GE(executor->concurrency(), 1);
+}
+
+TEST(ExecutorTest, RunInParallel) {
+  ICEBERG_UNWRAP_OR_FAIL(auto pool, ThreadPoolExecutor::Make(4));
+  for (int32_t parallelism : {1, 2, 8}) {
+    std::vector<std::atomic<int32_t>> runs(50);
+    EXPECT_THAT(RunInParallel(*pool, runs.size(), parallelism,
+                              [&](size_t i) -> Status {
+                                ++runs[i];
+                                return {};
+                              }),
+                IsOk());
+    for (const auto& run : runs) {
+      EXPECT_EQ(run, 1) << parallelism;
+    }
+  }
+
+  // Only the calling thread runs tasks without parallelism.
+  const auto caller = std::this_thread::get_id();
+  EXPECT_THAT(RunInParallel(*pool, 10, 1,
+                            [&](size_t) -> Status {
+                              EXPECT_EQ(std::this_thread::get_id(), caller);
+                              return {};
+                            }),
+              IsOk());
+}
+
+TEST(ExecutorTest, RunInParallelStopsAtFirstError) {
+  ICEBERG_UNWRAP_OR_FAIL(auto pool, ThreadPoolExecutor::Make(2));
+  std::atomic<size_t> started = 0;
+  auto status = RunInParallel(*pool, 1000, 2, [&](size_t i) -> Status {
+    ++started;
+    if (i == 3) {
+      return InvalidArgument("Task {} failed", i);
+    }
+    return {};
+  });
+  EXPECT_THAT(status, IsError(ErrorKind::kInvalidArgument));
+  EXPECT_LT(started, 1000);
+}
+
+TEST(ExecutorTest, RunInParallelWithoutExecutorThreads) {
+  // Helpers that never start do not block the call, whose tasks all run on the calling
+  // thread, and do nothing once they start after it returned.
+  DeferredExecutor executor;
+  std::vector<size_t> indices;
+  EXPECT_THAT(RunInParallel(executor, 5, 4,
+                            [&](size_t i) -> Status {
+                              indices.push_back(i);
+                              return {};
+                            }),
+              IsOk());
+  EXPECT_THAT(indices, ::testing::ElementsAre(0, 1, 2, 3, 4));
+  EXPECT_EQ(executor.RunAll(), 3);
+  EXPECT_EQ(indices.size(), 5);
+}
+
+TEST(ExecutorTest, NestedRunInParallel) {
+  // Tasks of the pool waiting on nested calls still complete with a single thread.
+  ICEBERG_UNWRAP_OR_FAIL(auto pool, ThreadPoolExecutor::Make(1));
+  std::atomic<int32_t> count = 0;
+  EXPECT_THAT(RunInParallel(*pool, 4, 4,
+                            [&](size_t) -> Status {
+                              return RunInParallel(*pool, 4, 4, [&](size_t) -> Status {
+                                ++count;
+                                return {};
+                              });
+                            }),
+              IsOk());
+  EXPECT_EQ(count, 16);
+}
+
+}  // namespace iceberg
@@ -0,0 +1,201 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/expire_snapshots.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/fast_append.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/rewrite_manifests.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/test/delete_data_files.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/test/table_test_base.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+class ExpireSnapshotsTest : public TableTestBase {
+ protected:
+  void SetUp() override {
+    TableTestBase::SetUp();
+    std::filesystem::create_directories(table_location_ + "/data");
+  }
+
+  // Creates a data file on disk and returns its path.
+  std::string DataPath(const std::string& name) {
+    auto path = std::format("{}/data/{}", table_location_, name);
+    std::ofstream(path) << "data";
+    return path;
+  }
+
+  int64_t Append(const std::string& path) {
+    FastAppend append(table_);
+    append.AppendFile(std::make_shared<DataFile>(DataFile{
+        .file_path = path,
+        .file_format = FileFormatType::kParquet,
+        .record_count = 10,
+        .file_size_in_bytes = 100,
+    }));
+    EXPECT_THAT(append.Commit(), IsOk());
+    return append.snapshot_id();
+  }
+
+  int64_t Delete(const std::string& path) {
+    DeleteDataFiles delete_files(table_, {path});
+    EXPECT_THAT(delete_files.Commit(), IsOk());
+    return delete_files.snapshot_id();
+  }
+
+  std::vector<int64_t> SnapshotIds() const {
+    std::vector<int64_t> snapshot_ids;
+    for (const auto& snapshot : table_->metadata()->snapshots) {
+      snapshot_ids.push_back(snapshot->snapshot_id);
+    }
+    std::ranges::sort(snapshot_ids);
+    return snapshot_ids;
+  }
+
+  // A timestamp after all snapshots of the test.
+  static TimePointMs Later() {
+    return std::chrono::time_point_cast<std::chrono::milliseconds>(
+               std::chrono::system_clock::now()) +
+           std::chrono::hours(1);
+  }
+};
+
+TEST_F(ExpireSnapshotsTest, KeepsRecentSnapshotsByDefault) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable());
+  auto first = Append(DataPath("a.parquet"));
+  auto second = Append(DataPath("b.parquet"));
+
+  ExpireSnapshots expire(table_);
+  ICEBERG_UNWRAP_OR_FAIL(auto result, expire.Commit());
+  EXPECT_TRUE(result.expired_snapshot_ids.empty());
+  EXPECT_EQ(SnapshotIds(), (std::vector<int64_t>{std::min(first, second),
+                                                 std::max(first, second)}));
+}
+
+TEST_F(ExpireSnapshotsTest, DeletesFilesOnlyReachableFromExpiredSnapshots) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable());
+  auto a = DataPath("a.parquet");
+  auto b = DataPath("b.parquet");
+  auto first = Append(a);
+  auto first_list = table_->metadata()->Snapshot().value()->manifest_list;
+  auto second = Append(b);
+  auto third = Delete(a);
+
+  ExpireSnapshots expire(table_);
+  expire.ExpireOlderThan(Later()).RetainLast(1);
+  ICEBERG_UNWRAP_OR_FAIL(auto expired_ids, expire.Apply());
+  std::ranges::sort(expired_ids);
+  EXPECT_EQ(expired_ids, (std::vector<int64_t>{std::min(first, second),
+                                               std::max(first, second)}));
+
+  ICEBERG_UNWRAP_OR_FAIL(auto result, expire.Commit());
+  EXPECT_EQ(result.expired_snapshot_ids.size(), 2);
+  EXPECT_EQ(SnapshotIds(), std::vector<int64_t>{third});
+  EXPECT_EQ(table_->metadata()->current_snapshot_id, third);
+  // The file removed by the retained snapshot is gone, and so are the manifest of the
+  // first snapshot and the manifest lists of the expired snapshots.
+  EXPECT_EQ(result.deleted_files_count, 1);
+  EXPECT_EQ(result.deleted_manifests_count, 1);
+  EXPECT_EQ(result.deleted_manifest_lists_count, 2);
+  EXPECT_TRUE(result.delete_failures.empty());
+  EXPECT_FALSE(std::filesystem::exists(a));
+  EXPECT_TRUE(std::filesystem::exists(b));
+  EXPECT_FALSE(std::filesystem::exists(first_list));
+}
+
+TEST_F(ExpireSnapshotsTest, KeepsFilesOfRewrittenManifests) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable());
+  auto a = DataPath("a.parquet");
+  auto b = DataPath("b.parquet");
+  Append(a);
+  Append(b);
+  RewriteManifests rewrite(table_);
+  ASSERT_THAT(rewrite.Commit(), IsOk());
+
+  ExpireSnapshots expire(table_);
+  expire.ExpireOlderThan(Later()).RetainLast(1).WithParallelism(4);
+  ICEBERG_UNWRAP_OR_FAIL(auto result, expire.Commit());
+  EXPECT_EQ(result.expired_snapshot_ids.size(), 2);
+  EXPECT_EQ(SnapshotIds(), std::vector<int64_t>{rewrite.snapshot_id()});
+  // Both files are live in the rewritten manifest, only the old manifests go.
+  EXPECT_EQ(result.deleted_files_count, 0);
+  EXPECT_EQ(result.deleted_manifests_count, 2);
+  EXPECT_EQ(result.deleted_manifest_lists_count, 2);
+  EXPECT_TRUE(std::filesystem::exists(a));
+  EXPECT_TRUE(std::filesystem::exists(b));
+}
+
+TEST_F(ExpireSnapshotsTest, ExpiresSnapshotById) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable());
+  auto first = Append(DataPath("a.parquet"));
+  auto second = Append(DataPath("b.parquet"));
+
+  ExpireSnapshots expire_current(table_);
+  expire_current.ExpireSnapshotId(second);
+  EXPECT_THAT(expire_current.Commit(), IsError(ErrorKind::kInvalidArgument));
+
+  ExpireSnapshots expire(table_);
+  expire.ExpireSnapshotId(first);
+  ICEBERG_UNWRAP_OR_FAIL(auto result, expire.Commit());
+  EXPECT_EQ(result.expired_snapshot_ids, std::vector<int64_t>{first});
+  EXPECT_EQ(SnapshotIds(), std::vector<int64_t>{second});
+  // Both files are still live in the current snapshot.
+  EXPECT_EQ(result.deleted_files_count, 0);
+  EXPECT_EQ(result.deleted_manifests_count, 0);
+  EXPECT_EQ(result.deleted_manifest_lists_count, 1);
+}
+
+TEST_F(ExpireSnapshotsTest, RequiresGcToCleanFiles) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable({{"gc.enabled", "false"}}));
+  auto a = DataPath("a.parquet");
+  Append(a);
+  auto second = Append(DataPath("b.parquet"));
+  Delete(a);
+
+  ExpireSnapshots expire(table_);
+  expire.ExpireOlderThan(Later()).RetainLast(1);
+  EXPECT_THAT(expire.Commit(), IsError(ErrorKind::kInvalidArgument));
+
+  expire.CleanExpiredFiles(false);
+  ICEBERG_UNWRAP_OR_FAIL(auto result, expire.Commit());
+  EXPECT_EQ(result.expired_snapshot_ids.size(), 2);
+  EXPECT_FALSE(table_->metadata()->HasSnapshot(second));
+  EXPECT_EQ(result.deleted_files_count, 0);
+  EXPECT_TRUE(std::filesystem::exists(a));
+}
+
+}  // namespace iceberg
@@ -0,0 +1,148 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/expression/expression_serialization.h"
+
+#include <memory>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/expression/binder.h"
+#include "iceberg/expression/expressions.h"
+#include "iceberg/expression/predicate.h"
+#include "iceberg/expression/term.h"
+#include "iceberg/schema.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/transform.h"
+#include "iceberg/type.h"
+#include "iceberg/util/checked_cast.h"
+
+namespace iceberg {
+
+using Op = Expression::Operation;
+
+class ExpressionSerializationTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    schema_ = std::make_shared<Schema>(
+        std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int64()),
+                                 SchemaField::MakeOptional(2, "data", string()),
+                                 SchemaField::MakeOptional(3, "price", decimal(9, 2))},
+        /*schema_id=*/0);
+  }
+
+  std::shared_ptr<Expression> RoundTrip(const Expression& expr,
+                                        const Schema* schema = nullptr) {
+    auto bytes = SerializeExpression(expr);
+    EXPECT_THAT(bytes, IsOk());
+    auto restored = DeserializeExpression(bytes.value(), schema);
+    EXPECT_THAT(restored, IsOk());
+    return restored.value();
+  }
+
+  std::shared_ptr<Schema> schema_;
+};
+
+TEST_F(ExpressionSerializationTest, UnboundExpression) {
+  auto expr = Expressions::And(
+      Expressions::Not(Expressions::In("data", {Literal::String("a"),
+                                                Literal::String("b")})),
+      Expressions::Or(Expressions::IsNull("price"),
+                      std::make_shared<UnboundPredicate<BoundTransform>>(
+                          Op::kEq, Expressions::Bucket("id", 16), Literal::Int(3))));
+  auto restored = RoundTrip(*expr);
+  ASSERT_EQ(restored->op(), Op::kAnd);
+  const auto& and_expr = internal::checked_cast<const And&>(*restored);
+
+  ASSERT_EQ(and_expr.left()->op(), Op::kNot);
+  auto in = std::dynamic_pointer_cast<UnboundPredicate<BoundReference>>(
+      internal::checked_cast<const Not&>(*and_expr.left()).child());
+  ASSERT_NE(in, nullptr);
+  EXPECT_EQ(in->op(), Op::kIn);
+  EXPECT_EQ(in->term()->reference()->name(), "data");
+  EXPECT_THAT(in->literals(),
+              ::testing::ElementsAre(Literal::String("a"), Literal::String("b")));
+
+  ASSERT_EQ(and_expr.right()->op(), Op::kOr);
+  const auto& or_expr = internal::checked_cast<const Or&>(*and_expr.right());
+  auto is_null =
+      std::dynamic_pointer_cast<UnboundPredicate<BoundReference>>(or_expr.left());
+  ASSERT_NE(is_null, nullptr);
+  EXPECT_EQ(is_null->op(), Op::kIsNull);
+  EXPECT_TRUE(is_null->literals().empty());
+  auto bucket =
+      std::dynamic_pointer_cast<UnboundPredicate<BoundTransform>>(or_expr.right());
+  ASSERT_NE(bucket, nullptr);
+  EXPECT_EQ(bucket->op(), Op::kEq);
+  EXPECT_EQ(bucket->term()->reference()->name(), "id");
+  EXPECT_EQ(internal::checked_cast<const UnboundTransform&>(*bucket->term())
+                .transform()
+                ->ToString(),
+            "bucket[16]");
+  EXPECT_THAT(bucket->literals(), ::testing::ElementsAre(Literal::Int(3)));
+}
+
+TEST_F(ExpressionSerializationTest, BoundExpression) {
+  auto expr = Expressions::Or(
+      Expressions::GreaterThanOrEqual("price", Literal::Decimal(1999, 9, 2)),
+      Expressions::NotIn("id", {Literal::Long(1), Literal::Long(-2)}));
+  ICEBERG_UNWRAP_OR_FAIL(auto bound,
+                         Binder::Bind(*schema_, expr, /*case_sensitive=*/true));
+  auto restored = RoundTrip(*bound, schema_.get());
+  ASSERT_EQ(restored->op(), Op::kOr);
+  const auto& or_expr = internal::checked_cast<const Or&>(*restored);
+
+  auto gt_eq = std::dynamic_pointer_cast<BoundLiteralPredicate>(or_expr.left());
+  ASSERT_NE(gt_eq, nullptr);
+  EXPECT_EQ(gt_eq->op(), Op::kGtEq);
+  EXPECT_EQ(gt_eq->reference()->field().field_id(), 3);
+  EXPECT_EQ(gt_eq->literal(), Literal::Decimal(1999, 9, 2));
+
+  auto not_in = std::dynamic_pointer_cast<BoundSetPredicate>(or_expr.right());
+  ASSERT_NE(not_in, nullptr);
+  EXPECT_EQ(not_in->op(), Op::kNotIn);
+  EXPECT_EQ(not_in->reference()->field().field_id(), 1);
+  EXPECT_EQ(not_in->literal_set().size(), 2);
+  EXPECT_TRUE(not_in->literal_set().Contains(int64_t{-2}));
+
+  // Bound predicates refer to fields by ID and need the schema to be restored.
+  ICEBERG_UNWRAP_OR_FAIL(auto bytes, SerializeExpression(*bound));
+  EXPECT_THAT(DeserializeExpression(bytes), IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(ExpressionSerializationTest, InvalidData) {
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto bytes, SerializeExpression(*Expressions::Equal("data", Literal::String("x"))));
+  EXPECT_EQ(RoundTrip(*Expressions::AlwaysFalse())->op(), Op::kFalse);
+
+  std::vector<uint8_t> truncated(bytes.begin(), bytes.end() - 1);
+  EXPECT_THAT(DeserializeExpression(truncated), IsError(ErrorKind::kInvalid));
+
+  auto trailing = bytes;
+  trailing.push_back(0);
+  EXPECT_THAT(DeserializeExpression(trailing), IsError(ErrorKind::kInvalid));
+
+  auto version = bytes;
+  version[0] = 2;
+  EXPECT_THAT(DeserializeExpression(version), IsError(ErrorKind::kNotSupported));
+}
+
+}  // namespace iceberg
@@ -0,0 +1,412 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/fast_append.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/expression/expressions.h"
+#include "iceberg/expression/literal.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/manifest_reader.h"
+#include "iceberg/metrics_reporter.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/table_scan.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/test/table_test_base.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief Exposes the validations of the snapshot producers.
+class ConflictValidator : public SnapshotProducer {
+ public:
+  explicit ConflictValidator(std::shared_ptr<Table> table)
+      : SnapshotProducer(std::move(table)) {}
+
+  using SnapshotProducer::ValidateAddedDataFiles;
+  using SnapshotProducer::ValidateNoNewDeleteFiles;
+
+ protected:
+  const std::string& operation() const override { return DataOperation::kAppend; }
+
+  Result<std::vector<ManifestFile>> Apply(const TableMetadata& /*base*/,
+                                          const Snapshot* /*parent*/) override {
+    return std::vector<ManifestFile>{};
+  }
+
+  std::unordered_map<std::string, std::string> Summary() const override { return {}; }
+
+  void CleanUncommitted(const std::unordered_set<std::string>& /*committed*/) override {}
+};
+
+/// \brief Keeps the reports it receives.
+class RecordingReporter : public MetricsReporter {
+ public:
+  void Report(const MetricsReport& report) override { reports.push_back(report); }
+
+  std::vector<MetricsReport> reports;
+};
+
+}  // namespace
+
+class FastAppendTest : public TableTestBase {
+ protected:
+  static std::shared_ptr<DataFile> MakeDataFile(const std::string& path,
+                                                int64_t record_count) {
+    return std::make_shared<DataFile>(DataFile{
+        .file_path = path,
+        .file_format = FileFormatType::kParquet,
+        .record_count = record_count,
+        .file_size_in_bytes = record_count * 10,
+    });
+  }
+
+  // A data file whose IDs are between the bounds.
+  static std::shared_ptr<DataFile> MakeBoundedDataFile(const std::string& path,
+                                                       int64_t lower, int64_t upper) {
+    auto file = MakeDataFile(path, 10);
+    file->lower_bounds[1] = Literal::Long(lower).Serialize().value();
+    file->upper_bounds[1] = Literal::Long(upper).Serialize().value();
+    return file;
+  }
+
+  static std::vector<std::string> ScanPaths(const Table& table) {
+    auto scan = table.NewScan()->Build();
+    EXPECT_THAT(scan, IsOk());
+    auto tasks = (*scan)->PlanFiles();
+    EXPECT_THAT(tasks, IsOk());
+    std::vector<std::string> paths;
+    for (const auto& task : *tasks) {
+      paths.push_back(task->data_file()->file_path);
+    }
+    std::ranges::sort(paths);
+    return paths;
+  }
+
+  std::vector<ManifestFile> Manifests(const Snapshot& snapshot) {
+    auto reader = ManifestListReader::Make(snapshot.manifest_list, file_io_);
+    EXPECT_THAT(reader, IsOk());
+    auto files = (*reader)->Files();
+    EXPECT_THAT(files, IsOk());
+    return std::move(files.value());
+  }
+
+  int32_t CountAvroFiles() const {
+    int32_t count = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(MetadataFolder())) {
+      count += entry.path().extension() == ".avro" ? 1 : 0;
+    }
+    return count;
+  }
+};
+
+TEST_F(FastAppendTest, AppendToEmptyTable) {
+  ASSERT_NO_FATAL_FAILURE(RegisterTable());
+  auto table = LoadTable();
+
+  FastAppend append(table);
+  append.AppendFile(MakeDataFile("/data/a.parquet", 10))
+      .AppendFile(MakeDataFile("/data/b.parquet", 20))
+      .Set("engine-name", "test");
+  ASSERT_THAT(append.Commit(), IsOk());
+
+  ICEBERG_UNWRAP_OR_FAIL(auto snapshot, table->current_snapshot());
+  EXPECT_EQ(snapshot->snapshot_id, append.snapshot_id());
+  EXPECT_EQ(snapshot->parent_snapshot_id, std::nullopt);
+  EXPECT_EQ(snapshot->sequence_number, 1);
+  EXPECT_EQ(snapshot->operation(), DataOperation::kAppend);
+  EXPECT_EQ(snapshot->summary.at(SnapshotSummaryFields::kAddedDataFiles), "2");
+  EXPECT_EQ(snapshot->summary.at(SnapshotSummaryFields::kTotalDataFiles), "2");
+  EXPECT_EQ(snapshot->summary.at(SnapshotSummaryFields::kTotalRecords), "30");
+  EXPECT_EQ(snapshot->summary.at("engine-name"), "test");
+  EXPECT_EQ(table->metadata()->refs.at(SnapshotRef::kMainBranch)->snapshot_id,
+            append.snapshot_id());
+
+  auto manifests = Manifests(*snapshot);
+  ASSERT_EQ(manifests.size(), 1);
+  EXPECT_EQ(manifests[0].sequence_number, 1);
+  EXPECT_EQ(manifests[0].added_snapshot_id, append.snapshot_id());
+  EXPECT_EQ(manifests[0].added_files_count, 2);
+  EXPECT_EQ(manifests[0].added_rows_count, 30);
+
+  EXPECT_EQ(ScanPaths(*table),
+            (std::vector<std::string>{"/data/a.parquet", "/data/b.parquet"}));
+}
+
+TEST_F(FastAppendTest, AssignsRowIds) {
+  ASSERT_NO_FATAL_FAILURE(RegisterTable({}, /*format_version=*/3));
+  auto table = LoadTable();
+
+  FastAppend first(table);
+  first.AppendFile(MakeDataFile("/data/a.parquet", 10))
+      .AppendFile(MakeDataFile("/data/b.parquet", 20));
+  ASSERT_THAT(first.Commit(), IsOk());
+  FastAppend second(table);
+  second.AppendFile(MakeDataFile("/data/c.parquet", 5));
+  ASSERT_THAT(second.Commit(), IsOk());
+
+  ICEBERG_UNWRAP_OR_FAIL(auto snapshot, table->current_snapshot());
+  EXPECT_EQ(snapshot->first_row_id, 30);
+  EXPECT_EQ(snapshot->added_rows, 5);
+  EXPECT_EQ(table->metadata()->next_row_id, 35);
+  auto manifests = Manifests(*snapshot);
+  ASSERT_EQ(manifests.size(), 2);
+  EXPECT_EQ(manifests[0].first_row_id, 30);
+  EXPECT_EQ(manifests[1].first_row_id, 0);
+
+  // The files inherit consecutive ranges of row IDs from their manifests.
+  auto scan = table->NewScan()->Build();
+  ASSERT_THAT(scan, IsOk());
+  ICEBERG_UNWRAP_OR_FAIL(auto tasks, (*scan)->PlanFiles());
+  std::unordered_map<std::string, std::optional<int64_t>> first_row_ids;
+  for (const auto& task : tasks) {
+    first_row_ids[task->data_file()->file_path] = task->data_file()->first_row_id;
+  }
+  EXPECT_EQ(first_row_ids,
+            (std::unordered_map<std::string, std::optional<int64_t>>{
+                {"/data/a.parquet", 0},
+                {"/data/b.parquet", 10},
+                {"/data/c.parquet", 30}}));
+}
+
+TEST_F(FastAppendTest, AppendKeepsExistingManifests) {
+  ASSERT_NO_FATAL_FAILURE(RegisterTable());
+  auto table = LoadTable();
+
+  FastAppend first(table);
+  first.AppendFile(MakeDataFile("/data/a.parquet", 10));
+  ASSERT_THAT(first.Commit(), IsOk());
+  FastAppend second(table);
+  second.AppendFile(MakeDataFile("/data/b.parquet", 20));
+  ASSERT_THAT(second.Commit(), IsOk());
+
+  ICEBERG_UNWRAP_OR_FAIL(auto snapshot, table->current_snapshot());
+  EXPECT_EQ(snapshot->parent_snapshot_id, first.snapshot_id());
+  EXPECT_EQ(snapshot->sequence_number, 2);
+  EXPECT_EQ(snapshot->summary.at(SnapshotSummaryFields::kTotalDataFiles), "2");
+  EXPECT_EQ(snapshot->summary.at(SnapshotSummaryFields::kTotalRecords), "30");
+  EXPECT_EQ(table->history().size(), 2);
+
+  auto manifests = Manifests(*snapshot);
+  ASSERT_EQ(manifests.size(), 2);
+  EXPECT_EQ(manifests[0].added_snapshot_id, second.snapshot_id());
+  EXPECT_EQ(manifests[1].added_snapshot_id, first.snapshot_id());
+  EXPECT_EQ(manifests[1].sequence_number, 1);
+
+  EXPECT_EQ(ScanPaths(*table),
+            (std::vector<std::string>{"/data/a.parquet", "/data/b.parquet"}));
+}
+
+TEST_F(FastAppendTest, RetryReusesManifests) {
+  ASSERT_NO_FATAL_FAILURE(RegisterTable());
+  auto table = LoadTable();
+  auto stale_table = LoadTable();
+
+  FastAppend first(table);
+  first.AppendFile(MakeDataFile("/data/a.parquet", 10));
+  ASSERT_THAT(first.Commit(), IsOk());
+
+  // The first attempt conflicts with the commit above, the retry is committed on top of
+  // it with the manifest written for the first attempt.
+  FastAppend second(stale_table);
+  second.AppendFile(MakeDataFile("/data/b.parquet", 20));
+  ASSERT_THAT(second.Commit(), IsOk());
+
+  ICEBERG_UNWRAP_OR_FAIL(auto snapshot, stale_table->current_snapshot());
+  EXPECT_EQ(snapshot->snapshot_id, second.snapshot_id());
+  EXPECT_EQ(snapshot->parent_snapshot_id, first.snapshot_id());
+  EXPECT_EQ(snapshot->sequence_number, 2);
+  EXPECT_NE(snapshot->manifest_list.find(std::format("snap-{}-2-", second.snapshot_id())),
+            std::string::npos);
+  EXPECT_EQ(Manifests(*snapshot).size(), 2);
+
+  // A manifest and a manifest list per append, the list of the failed attempt is
+  // deleted.
+  EXPECT_EQ(CountAvroFiles(), 4);
+  EXPECT_EQ(ScanPaths(*stale_table),
+            (std::vector<std::string>{"/data/a.parquet", "/data/b.parquet"}));
+}
+
+TEST_F(FastAppendTest, WritesManifestsInParallel) {
+  ASSERT_NO_FATAL_FAILURE(RegisterTable({{"commit.manifest.write-parallelism", "4"},
+                                         {"commit.manifest.target-size-bytes", "1"}}));
+  auto table = LoadTable();
+
+  constexpr int32_t kFilesCount = 5000;
+  FastAppend append(table);
+  for (int32_t i = 0; i < kFilesCount; ++i) {
+    append.AppendFile(MakeDataFile(std::format("/data/{:05}.parquet", i), 1));
+  }
+  ASSERT_THAT(append.Commit(), IsOk());
+
+  // The files are split across the writers, which each roll to a new manifest after
+  // every batch of files.
+  ICEBERG_UNWRAP_OR_FAIL(auto snapshot, table->current_snapshot());
+  auto manifests = Manifests(*snapshot);
+  EXPECT_GE(manifests.size(), 4);
+  int32_t added_files_count = 0;
+  std::unordered_set<std::string> paths;
+  for (const auto& manifest : manifests) {
+    EXPECT_EQ(manifest.added_snapshot_id, append.snapshot_id());
+    added_files_count += manifest.added_files_count.value_or(0);
+    paths.insert(manifest.manifest_path);
+  }
+  EXPECT_EQ(added_files_count, kFilesCount);
+  EXPECT_EQ(paths.size(), manifests.size());
+
+  auto scanned = ScanPaths(*table);
+  ASSERT_EQ(scanned.size(), kFilesCount);
+  EXPECT_EQ(scanned.front(), "/data/00000.parquet");
+  EXPECT_EQ(scanned.back(), "/data/04999.parquet");
+}
+
+TEST_F(FastAppendTest, ReportsCommitMetrics) {
+  ASSERT_NO_FATAL_FAILURE(RegisterTable());
+  auto table = LoadTable();
+  auto stale_table = LoadTable();
+  auto reporter = std::make_shared<RecordingReporter>();
+  stale_table->set_metrics_reporter(reporter);
+
+  FastAppend first(table);
+  first.AppendFile(MakeDataFile("/data/a.parquet", 10));
+  ASSERT_THAT(first.Commit(), IsOk());
+  EXPECT_TRUE(reporter->reports.empty());
+
+  FastAppend second(stale_table);
+  second.AppendFile(MakeDataFile("/data/b.parquet", 20));
+  ASSERT_THAT(second.Commit(), IsOk());
+
+  ASSERT_EQ(reporter->reports.size(), 1);
+  const auto* report = std::get_if<CommitReport>(&reporter->reports[0]);
+  ASSERT_NE(report, nullptr);
+  EXPECT_EQ(report->table.name, "t1");
+  EXPECT_EQ(report->snapshot_id, second.snapshot_id());
+  EXPECT_EQ(report->sequence_number, 2);
+  EXPECT_EQ(report->operation, DataOperation::kAppend);
+  const auto& metrics = report->metrics;
+  EXPECT_EQ(metrics.attempts.value(), 2);
+  EXPECT_EQ(metrics.total_duration.count(), 1);
+  EXPECT_GT(metrics.total_duration.total_duration().count(), 0);
+  EXPECT_EQ(metrics.added_data_files.value(), 1);
+  EXPECT_EQ(metrics.removed_data_files.value(), 0);
+  EXPECT_EQ(metrics.total_data_files.value(), 2);
+  EXPECT_EQ(metrics.added_records.value(), 20);
+  EXPECT_EQ(metrics.total_records.value(), 30);
+  EXPECT_EQ(metrics.added_files_size_in_bytes.value(), 200);
+  EXPECT_EQ(metrics.total_files_size_in_bytes.value(), 300);
+}
+
+TEST_F(FastAppendTest, FailsWhenRetriesAreExhausted) {
+  ASSERT_NO_FATAL_FAILURE(RegisterTable({{"commit.retry.num-retries", "0"}}));
+  auto table = LoadTable();
+  auto stale_table = LoadTable();
+
+  FastAppend first(table);
+  first.AppendFile(MakeDataFile("/data/a.parquet", 10));
+  ASSERT_THAT(first.Commit(), IsOk());
+
+  FastAppend second(stale_table);
+  second.AppendFile(MakeDataFile("/data/b.parquet", 20));
+  auto status = second.Commit();
+  EXPECT_THAT(status, IsError(ErrorKind::kCommitFailed));
+  EXPECT_THAT(status, HasErrorMessage("branch main was created concurrently"));
+
+  // The files of the failed append are deleted.
+  EXPECT_EQ(CountAvroFiles(), 2);
+  ASSERT_THAT(stale_table->Refresh(), IsOk());
+  EXPECT_EQ(ScanPaths(*stale_table), (std::vector<std::string>{"/data/a.parquet"}));
+}
+
+TEST_F(FastAppendTest, InvalidDataFile) {
+  ASSERT_NO_FATAL_FAILURE(RegisterTable());
+  auto table = LoadTable();
+
+  auto delete_file = MakeDataFile("/data/delete.parquet", 1);
+  delete_file->content = DataFile::Content::kPositionDeletes;
+  FastAppend append(table);
+  append.AppendFile(delete_file);
+  EXPECT_THAT(append.Commit(), IsError(ErrorKind::kInvalidArgument));
+  EXPECT_EQ(table->metadata()->current_snapshot_id, Snapshot::kInvalidSnapshotId);
+}
+
+TEST_F(FastAppendTest, ValidatesConcurrentAppendsAgainstFilter) {
+  ASSERT_NO_FATAL_FAILURE(RegisterTable());
+  auto table = LoadTable();
+
+  FastAppend first(table);
+  first.AppendFile(MakeBoundedDataFile("/data/a.parquet", 0, 10));
+  ASSERT_THAT(first.Commit(), IsOk());
+  const int64_t starting_snapshot_id = first.snapshot_id();
+  FastAppend second(table);
+  second.AppendFile(MakeBoundedDataFile("/data/b.parquet", 50, 60));
+  ASSERT_THAT(second.Commit(), IsOk());
+  FastAppend third(table);
+  third.AppendFile(MakeBoundedDataFile("/data/c.parquet", 200, 300));
+  ASSERT_THAT(third.Commit(), IsOk());
+
+  const auto& base = *table->metadata();
+  ICEBERG_UNWRAP_OR_FAIL(auto parent, base.Snapshot());
+  ConflictValidator validator(table);
+  auto below_five = Expressions::LessThan("id", Literal::Long(5));
+  // Only the files added after the starting snapshot are checked.
+  EXPECT_THAT(validator.ValidateAddedDataFiles(base, parent.get(), starting_snapshot_id,
+                                               below_five),
+              IsOk());
+  auto status = validator.ValidateAddedDataFiles(
+      base, parent.get(), starting_snapshot_id,
+      Expressions::GreaterThan("id", Literal::Long(100)));
+  EXPECT_THAT(status, IsError(ErrorKind::kValidationFailed));
+  EXPECT_THAT(status, HasErrorMessage("/data/c.parquet"));
+  EXPECT_THAT(validator.ValidateAddedDataFiles(base, parent.get(), starting_snapshot_id,
+                                               /*conflict_detection_filter=*/nullptr),
+              IsError(ErrorKind::kValidationFailed));
+  EXPECT_THAT(validator.ValidateAddedDataFiles(base, parent.get(), third.snapshot_id(),
+                                               /*conflict_detection_filter=*/nullptr),
+              IsOk());
+  EXPECT_THAT(validator.ValidateNoNewDeleteFiles(base, parent.get(), starting_snapshot_id,
+                                                 /*conflict_detection_filter=*/nullptr),
+              IsOk());
+
+  // Without a starting snapshot, all files are added concurrently.
+  EXPECT_THAT(validator.ValidateAddedDataFiles(base, parent.get(), std::nullopt,
+                                               below_five),
+              IsError(ErrorKind::kValidationFailed));
+  EXPECT_THAT(validator.ValidateAddedDataFiles(base, parent.get(), 12345,
+                                               /*conflict_detection_filter=*/nullptr),
+              HasErrorMessage("is not an ancestor"));
+}
+
+}  // namespace iceberg
@@ -0,0 +1,177 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/file_io.h"
+
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/test/matchers.h"
+#include "iceberg/util/read_ranges_internal.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief A FileIO that only implements reading and writing whole files.
+class InMemoryFileIO : public FileIO {
+ public:
+  Result<std::string> ReadFile(const std::string& file_location,
+                               std::optional<size_t> length) override {
+    auto it = files_.find(file_location);
+    if (it == files_.cend()) {
+      return IOError("File {} does not exist", file_location);
+    }
+    return it->second;
+  }
+
+  Status WriteFile(const std::string& file_location, std::string_view content) override {
+    files_[file_location] = std::string(content);
+    return {};
+  }
+
+  Status DeleteFile(const std::string& file_location) override {
+    if (files_.erase(file_location) == 0) {
+      return IOError("File {} does not exist", file_location);
+    }
+    return {};
+  }
+
+  std::unordered_map<std::string, std::string> files_;
+};
+
+std::span<uint8_t> AsSpan(std::string& buffer) {
+  return {reinterpret_cast<uint8_t*>(buffer.data()), buffer.size()};
+}
+
+}  // namespace
+
+TEST(FileIOTest, DefaultInputFile) {
+  InMemoryFileIO io;
+  io.files_["data"] = "hello world";
+  EXPECT_THAT(io.NewInputFile("missing", std::nullopt), IsError(ErrorKind::kIOError));
+
+  auto file = io.NewInputFile("data", std::nullopt);
+  ASSERT_THAT(file, IsOk());
+  auto& input = *file.value();
+  EXPECT_EQ(input.location(), "data");
+  EXPECT_THAT(input.Size(), HasValue(::testing::Eq(11)));
+
+  std::string buffer(5, '\0');
+  EXPECT_THAT(input.ReadAt(6, AsSpan(buffer)), HasValue(::testing::Eq(5)));
+  EXPECT_EQ(buffer, "world");
+  // Reads stop at the end of the file.
+  EXPECT_THAT(input.ReadAt(8, AsSpan(buffer)), HasValue(::testing::Eq(3)));
+  EXPECT_EQ(buffer.substr(0, 3), "rld");
+  EXPECT_THAT(input.ReadAt(20, AsSpan(buffer)), HasValue(::testing::Eq(0)));
+
+  std::string first(2, '\0');
+  std::string second(3, '\0');
+  std::vector<ReadRange> ranges = {{.offset = 0, .out = AsSpan(first)},
+                                   {.offset = 8, .out = AsSpan(second)}};
+  EXPECT_THAT(input.ReadRanges(ranges), IsOk());
+  EXPECT_EQ(first, "he");
+  EXPECT_EQ(second, "rld");
+  // A range past the end of the file cannot be read fully.
+  ranges = {{.offset = 9, .out = AsSpan(second)}};
+  EXPECT_THAT(input.ReadRanges(ranges), IsError(ErrorKind::kIOError));
+
+  EXPECT_THAT(input.Close(), IsOk());
+  EXPECT_THAT(input.ReadAt(0, AsSpan(buffer)), IsError(ErrorKind::kInvalid));
+}
+
+TEST(FileIOTest, DefaultOutputFile) {
+  InMemoryFileIO io;
+  auto file = io.NewOutputFile("data");
+  ASSERT_THAT(file, IsOk());
+  auto& output = *file.value();
+  EXPECT_EQ(output.location(), "data");
+
+  EXPECT_THAT(output.Write("hello "), IsOk());
+  EXPECT_THAT(output.Write("world"), IsOk());
+  EXPECT_THAT(output.Position(), HasValue(::testing::Eq(11)));
+  // The file is written when it is closed.
+  EXPECT_FALSE(io.files_.contains("data"));
+  EXPECT_THAT(output.Close(), IsOk());
+  EXPECT_EQ(io.files_["data"], "hello world");
+  EXPECT_THAT(output.Write("!"), IsError(ErrorKind::kInvalid));
+}
+
+TEST(FileIOTest, DefaultDeleteFiles) {
+  InMemoryFileIO io;
+  io.files_ = {{"a", "1"}, {"b", "2"}, {"c", "3"}};
+  EXPECT_THAT(io.DeleteFiles({}), ::testing::IsEmpty());
+
+  const std::vector<std::string> locations = {"a", "missing", "c"};
+  auto failures = io.DeleteFiles(locations);
+  ASSERT_EQ(failures.size(), 1);
+  EXPECT_EQ(failures[0].file_location, "missing");
+  EXPECT_EQ(failures[0].error.kind, ErrorKind::kIOError);
+  // The files after the failed one are deleted too.
+  EXPECT_THAT(io.files_, ::testing::ElementsAre(::testing::Pair("b", "2")));
+}
+
+TEST(FileIOTest, CoalesceReadRanges) {
+  std::vector<uint8_t> buffer(100);
+  auto range = [&](int64_t offset, size_t length) {
+    return ReadRange{.offset = offset, .out = std::span(buffer).first(length)};
+  };
+  auto coalesce = [](const std::vector<ReadRange>& ranges, int64_t hole_size_limit,
+                     int64_t range_size_limit) {
+    std::vector<std::tuple<int64_t, int64_t, std::vector<size_t>>> result;
+    for (const auto& range : CoalesceReadRanges(
+             ranges, {.hole_size_limit = hole_size_limit,
+                      .range_size_limit = range_size_limit})) {
+      result.emplace_back(range.offset, range.length, range.ranges);
+    }
+    return result;
+  };
+  using Ranges = std::vector<size_t>;
+
+  EXPECT_TRUE(CoalesceReadRanges({}, ReadCoalescingOptions{}).empty());
+
+  // Unsorted ranges separated by holes of 5 and 20 bytes.
+  std::vector<ReadRange> ranges = {range(60, 10), range(0, 10), range(15, 25)};
+  EXPECT_THAT(coalesce(ranges, 5, 100),
+              ::testing::ElementsAre(std::tuple(0, 40, Ranges{1, 2}),
+                                     std::tuple(60, 10, Ranges{0})));
+  EXPECT_THAT(coalesce(ranges, 20, 100),
+              ::testing::ElementsAre(std::tuple(0, 70, Ranges{1, 2, 0})));
+  // The size limit stops merging, but a range larger than it is not split.
+  EXPECT_THAT(coalesce(ranges, 20, 20),
+              ::testing::ElementsAre(std::tuple(0, 10, Ranges{1}),
+                                     std::tuple(15, 25, Ranges{2}),
+                                     std::tuple(60, 10, Ranges{0})));
+  EXPECT_THAT(coalesce(ranges, 0, 100),
+              ::testing::ElementsAre(std::tuple(0, 10, Ranges{1}),
+                                     std::tuple(15, 25, Ranges{2}),
+                                     std::tuple(60, 10, Ranges{0})));
+
+  // Overlapping and adjacent ranges are merged whatever the limits.
+  ranges = {range(0, 30), range(10, 5), range(30, 10)};
+  EXPECT_THAT(coalesce(ranges, 0, 1),
+              ::testing::ElementsAre(std::tuple(0, 40, Ranges{0, 1, 2})));
+}
+
+}  // namespace iceberg
@@ -17,6 +17,8 @@
  * under the License.
  */
 
+#include <format>
+
 #include <arrow/array.h>
 #include <arrow/c/bridge.h>
 #include <arrow/json/from_string.h>
@@ -28,8 +30,14 @@
 #include <parquet/metadata.h>
 
 #include "iceberg/arrow/arrow_fs_file_io_internal.h"
+#include "iceberg/deletes/delete_loader.h"
+#include "iceberg/deletes/position_delete_index.h"
+#include "iceberg/executor.h"
+#include "iceberg/expression/expressions.h"
 #include "iceberg/file_format.h"
 #include "iceberg/manifest_entry.h"
+#include "iceberg/metadata_columns.h"
+#include "iceberg/metrics_reporter.h"
 #include "iceberg/parquet/parquet_register.h"
 #include "iceberg/schema.h"
 #include "iceberg/table_scan.h"
@@ -91,6 +99,114 @@ class FileScanTaskTest : public TempFileTestBase {
                     .ok());
   }
 
+  // Helper to write a position delete file deleting the given rows.
+  std::shared_ptr<DataFile> WritePositionDeleteFile(std::string_view deletes_json) {
+    const std::string kParquetFieldIdKey = "PARQUET:field_id";
+    const auto path_id = std::to_string(MetadataColumns::kDeleteFilePath.field_id());
+    const auto pos_id = std::to_string(MetadataColumns::kDeleteFilePos.field_id());
+    auto arrow_schema = ::arrow::schema(
+        {::arrow::field("file_path", ::arrow::utf8(), /*nullable=*/false,
+                        ::arrow::KeyValueMetadata::Make({kParquetFieldIdKey},
+                                                        {path_id})),
+         ::arrow::field("pos", ::arrow::int64(), /*nullable=*/false,
+                        ::arrow::KeyValueMetadata::Make({kParquetFieldIdKey},
+                                                        {pos_id}))});
+    auto table = ::arrow::Table::FromRecordBatches(
+                     arrow_schema, {::arrow::RecordBatch::FromStructArray(
+                                        ::arrow::json::ArrayFromJSONString(
+                                            ::arrow::struct_(arrow_schema->fields()),
+                                            deletes_json)
+                                            .ValueOrDie())
+                                        .ValueOrDie()})
+                     .ValueOrDie();
+
+    auto delete_file = std::make_shared<DataFile>();
+    delete_file->content = DataFile::Content::kPositionDeletes;
+    delete_file->file_path = CreateNewTempFilePathWithSuffix(".parquet");
+    delete_file->file_format = FileFormatType::kParquet;
+    delete_file->record_count = table->num_rows();
+
+    auto io = internal::checked_cast<arrow::ArrowFileSystemFileIO&>(*file_io_);
+    auto outfile = io.fs()->OpenOutputStream(delete_file->file_path).ValueOrDie();
+    EXPECT_TRUE(::parquet::arrow::WriteTable(*table, ::arrow::default_memory_pool(),
+                                             outfile, 1024)
+                    .ok());
+    EXPECT_TRUE(outfile->Close().ok());
+    delete_file->file_size_in_bytes = io.fs()->GetFileInfo(delete_file->file_path)
+                                          .ValueOrDie()
+                                          .size();
+    return delete_file;
+  }
+
+  // Helper to write an equality delete file deleting the rows with the given ids.
+  std::shared_ptr<DataFile> WriteEqualityDeleteFile(std::string_view ids_json) {
+    auto arrow_schema = ::arrow::schema({::arrow::field(
+        "id", ::arrow::int32(), /*nullable=*/false,
+        ::arrow::KeyValueMetadata::Make({"PARQUET:field_id"}, {"1"}))});
+    auto table = ::arrow::Table::FromRecordBatches(
+                     arrow_schema, {::arrow::RecordBatch::FromStructArray(
+                                        ::arrow::json::ArrayFromJSONString(
+                                            ::arrow::struct_(arrow_schema->fields()),
+                                            ids_json)
+                                            .ValueOrDie())
+                                        .ValueOrDie()})
+                     .ValueOrDie();
+
+    auto delete_file = std::make_shared<DataFile>();
+    delete_file->content = DataFile::Content::kEqualityDeletes;
+    delete_file->file_path = CreateNewTempFilePathWithSuffix(".parquet");
+    delete_file->file_format = FileFormatType::kParquet;
+    delete_file->record_count = table->num_rows();
+    delete_file->equality_ids = {1};
+
+    auto io = internal::checked_cast<arrow::ArrowFileSystemFileIO&>(*file_io_);
+    auto outfile = io.fs()->OpenOutputStream(delete_file->file_path).ValueOrDie();
+    EXPECT_TRUE(::parquet::arrow::WriteTable(*table, ::arrow::default_memory_pool(),
+                                             outfile, 1024)
+                    .ok());
+    EXPECT_TRUE(outfile->Close().ok());
+    delete_file->file_size_in_bytes = io.fs()->GetFileInfo(delete_file->file_path)
+                                          .ValueOrDie()
+                                          .size();
+    return delete_file;
+  }
+
+  // Helper to write a deletion vector of the data file after some leading bytes, as
+  // it would be stored in a Puffin file.
+  std::shared_ptr<DataFile> WriteDeletionVector(const std::vector<int64_t>& positions) {
+    PositionDeleteIndex index;
+    for (int64_t position : positions) {
+      index.Delete(position);
+    }
+    const std::string header = "PFA1";
+    const std::string blob = index.SerializeDeletionVector();
+
+    auto delete_file = std::make_shared<DataFile>();
+    delete_file->content = DataFile::Content::kPositionDeletes;
+    delete_file->file_path = CreateNewTempFilePathWithSuffix(".puffin");
+    delete_file->file_format = FileFormatType::kPuffin;
+    delete_file->record_count = static_cast<int64_t>(positions.size());
+    delete_file->file_size_in_bytes = static_cast<int64_t>(header.size() + blob.size());
+    delete_file->referenced_data_file = temp_parquet_file_;
+    delete_file->content_offset = static_cast<int64_t>(header.size());
+    delete_file->content_size_in_bytes = static_cast<int64_t>(blob.size());
+    EXPECT_THAT(file_io_->WriteFile(delete_file->file_path, header + blob), IsOk());
+    return delete_file;
+  }
+
+  // Reads all rows of a task into a table.
+  std::shared_ptr<::arrow::Table> ReadTable(const FileScanTask& task,
+                                            const std::shared_ptr<Schema>& schema) {
+    auto stream_result = task.ToArrow(file_io_, schema, nullptr);
+    EXPECT_THAT(stream_result, IsOk());
+    if (!stream_result.has_value()) {
+      return nullptr;
+    }
+    auto stream = std::move(stream_result.value());
+    auto record_batch_reader = ::arrow::ImportRecordBatchReader(&stream).ValueOrDie();
+    return record_batch_reader->ToTable().ValueOrDie();
+  }
+
   // Helper method to verify the content of the next batch from an ArrowArrayStream.
   void VerifyStreamNextBatch(struct ArrowArrayStream* stream,
                              std::string_view expected_json) {
@@ -164,6 +280,158 @@ TEST_F(FileScanTaskTest, ReadProjectedAndReorderedSchema) {
       VerifyStreamNextBatch(&stream, R"([["Foo", null], ["Bar", null], ["Baz", null]])"));
 }
 
+TEST_F(FileScanTaskTest, ReadWithRowFilter) {
+  auto data_file = std::make_shared<DataFile>();
+  data_file->file_path = temp_parquet_file_;
+  data_file->file_format = FileFormatType::kParquet;
+
+  auto projected_schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32()),
+                               SchemaField::MakeOptional(2, "name", string())});
+  auto filter = Expressions::NotEqual("name", Literal::String("Bar"));
+
+  FileScanTask task(data_file);
+
+  // Without row filtering, the rows of the batch are not filtered.
+  auto unfiltered_result = task.ToArrow(file_io_, projected_schema, filter);
+  ASSERT_THAT(unfiltered_result, IsOk());
+  auto unfiltered_stream = std::move(unfiltered_result.value());
+  ASSERT_NO_FATAL_FAILURE(VerifyStreamNextBatch(
+      &unfiltered_stream, R"([[1, "Foo"], [2, "Bar"], [3, "Baz"]])"));
+
+  auto stream_result =
+      task.ToArrow(file_io_, projected_schema, filter, RowFilterMode::kCompact);
+  ASSERT_THAT(stream_result, IsOk());
+  auto stream = std::move(stream_result.value());
+  ASSERT_NO_FATAL_FAILURE(VerifyStreamNextBatch(&stream, R"([[1, "Foo"], [3, "Baz"]])"));
+}
+
+TEST_F(FileScanTaskTest, ReadWithRowFilterSkipsBatches) {
+  // Each row is written to its own row group and read as its own batch.
+  CreateSimpleParquetFile(/*chunk_size=*/1);
+  auto data_file = std::make_shared<DataFile>();
+  data_file->file_path = temp_parquet_file_;
+  data_file->file_format = FileFormatType::kParquet;
+
+  auto projected_schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32()),
+                               SchemaField::MakeOptional(2, "name", string())});
+
+  FileScanTask task(data_file);
+
+  // Statistics cannot rule out not-equal predicates, so the first batch is read and
+  // all of its rows are filtered.
+  auto stream_result =
+      task.ToArrow(file_io_, projected_schema,
+                   Expressions::NotEqual("name", Literal::String("Foo")),
+                   RowFilterMode::kCompact);
+  ASSERT_THAT(stream_result, IsOk());
+  auto stream = std::move(stream_result.value());
+  auto record_batch_reader = ::arrow::ImportRecordBatchReader(&stream).ValueOrDie();
+  auto table = record_batch_reader->ToTable().ValueOrDie();
+  ASSERT_EQ(table->num_rows(), 2);
+  auto ids = table->GetColumnByName("id");
+  EXPECT_EQ(ids->GetScalar(0).ValueOrDie()->ToString(), "2");
+  EXPECT_EQ(ids->GetScalar(1).ValueOrDie()->ToString(), "3");
+}
+
+TEST_F(FileScanTaskTest, ReadWithPrefetch) {
+  // Each row is written to its own row group and read as its own batch.
+  CreateSimpleParquetFile(/*chunk_size=*/1);
+  auto data_file = std::make_shared<DataFile>();
+  data_file->file_path = temp_parquet_file_;
+  data_file->file_format = FileFormatType::kParquet;
+
+  auto projected_schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32()),
+                               SchemaField::MakeOptional(2, "name", string())});
+  auto filter = Expressions::NotEqual("name", Literal::String("Bar"));
+
+  FileScanTask task(data_file);
+
+  EXPECT_THAT(task.ToArrow(file_io_, projected_schema, nullptr, RowFilterMode::kNone,
+                           /*prefetch_batches=*/-1),
+              IsError(ErrorKind::kInvalidArgument));
+
+  for (int32_t prefetch_batches : {1, 2, 8}) {
+    auto stream_result = task.ToArrow(file_io_, projected_schema, filter,
+                                      RowFilterMode::kCompact, prefetch_batches);
+    ASSERT_THAT(stream_result, IsOk());
+    auto stream = std::move(stream_result.value());
+    auto record_batch_reader = ::arrow::ImportRecordBatchReader(&stream).ValueOrDie();
+    auto table = record_batch_reader->ToTable().ValueOrDie();
+    ASSERT_EQ(table->num_rows(), 2) << prefetch_batches;
+    auto ids = table->GetColumnByName("id");
+    EXPECT_EQ(ids->GetScalar(0).ValueOrDie()->ToString(), "1");
+    EXPECT_EQ(ids->GetScalar(1).ValueOrDie()->ToString(), "3");
+  }
+
+  // Releasing the stream stops prefetching and releases the batches read ahead.
+  auto stream_result = task.ToArrow(file_io_, projected_schema, nullptr,
+                                    RowFilterMode::kNone, /*prefetch_batches=*/2);
+  ASSERT_THAT(stream_result, IsOk());
+  auto stream = std::move(stream_result.value());
+  ASSERT_NO_FATAL_FAILURE(VerifyStreamNextBatch(&stream, R"([[1, "Foo"]])"));
+}
+
+TEST_F(FileScanTaskTest, ReadWithIOExecutor) {
+  // Each row is written to its own row group and read as its own batch.
+  CreateSimpleParquetFile(/*chunk_size=*/1);
+  auto data_file = std::make_shared<DataFile>();
+  data_file->file_path = temp_parquet_file_;
+  data_file->file_format = FileFormatType::kParquet;
+
+  auto projected_schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32()),
+                               SchemaField::MakeOptional(2, "name", string())});
+  auto filter = Expressions::NotEqual("name", Literal::String("Bar"));
+
+  ICEBERG_UNWRAP_OR_FAIL(std::shared_ptr<Executor> executor, ThreadPoolExecutor::Make(2));
+  ICEBERG_UNWRAP_OR_FAIL(std::shared_ptr<Executor> io_executor,
+                         ThreadPoolExecutor::Make(2));
+  FileScanTask task(data_file, {}, /*delete_loader=*/nullptr, /*residual=*/nullptr,
+                    /*memory_pool=*/nullptr, executor, io_executor);
+  EXPECT_EQ(task.io_executor(), io_executor);
+
+  // Batches are read on the I/O executor and filtered on the other one.
+  for (int32_t prefetch_batches : {0, 1, 2, 8}) {
+    auto stream_result = task.ToArrow(file_io_, projected_schema, filter,
+                                      RowFilterMode::kCompact, prefetch_batches);
+    ASSERT_THAT(stream_result, IsOk());
+    auto stream = std::move(stream_result.value());
+    auto record_batch_reader = ::arrow::ImportRecordBatchReader(&stream).ValueOrDie();
+    auto table = record_batch_reader->ToTable().ValueOrDie();
+    ASSERT_EQ(table->num_rows(), 2) << prefetch_batches;
+    auto ids = table->GetColumnByName("id");
+    EXPECT_EQ(ids->GetScalar(0).ValueOrDie()->ToString(), "1");
+    EXPECT_EQ(ids->GetScalar(1).ValueOrDie()->ToString(), "3");
+  }
+
+  // Releasing the stream stops both steps and releases the batches held by them.
+  auto stream_result = task.ToArrow(file_io_, projected_schema, filter,
+                                    RowFilterMode::kCompact, /*prefetch_batches=*/2);
+  ASSERT_THAT(stream_result, IsOk());
+  auto stream = std::move(stream_result.value());
+  ASSERT_NO_FATAL_FAILURE(VerifyStreamNextBatch(&stream, R"([[1, "Foo"]])"));
+}
+
+TEST_F(FileScanTaskTest, RowFilterOnMissingColumn) {
+  auto data_file = std::make_shared<DataFile>();
+  data_file->file_path = temp_parquet_file_;
+  data_file->file_format = FileFormatType::kParquet;
+
+  auto projected_schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeOptional(2, "name", string())});
+
+  FileScanTask task(data_file);
+
+  auto stream_result =
+      task.ToArrow(file_io_, projected_schema,
+                   Expressions::GreaterThan("id", Literal::Int(1)),
+                   RowFilterMode::kCompact);
+  EXPECT_THAT(stream_result, IsError(ErrorKind::kInvalidExpression));
+}
+
 TEST_F(FileScanTaskTest, ReadEmptyFile) {
   CreateEmptyParquetFile();
   auto data_file = std::make_shared<DataFile>();
@@ -183,4 +451,205 @@ TEST_F(FileScanTaskTest, ReadEmptyFile) {
   ASSERT_NO_FATAL_FAILURE(VerifyStreamExhausted(&stream));
 }
 
+TEST_F(FileScanTaskTest, ReadWithPositionDeletes) {
+  auto data_file = std::make_shared<DataFile>();
+  data_file->file_path = temp_parquet_file_;
+  data_file->file_format = FileFormatType::kParquet;
+
+  auto projected_schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32()),
+                               SchemaField::MakeOptional(2, "name", string())});
+  // Deletes of other data files are ignored.
+  auto delete_file = WritePositionDeleteFile(std::format(
+      R"([["{0}", 1], ["{0}", 7], ["other.parquet", 0]])", temp_parquet_file_));
+
+  FileScanTask task(data_file, {delete_file});
+  EXPECT_EQ(task.files_count(), 2);
+
+  auto stream_result = task.ToArrow(file_io_, projected_schema, nullptr);
+  ASSERT_THAT(stream_result, IsOk());
+  auto stream = std::move(stream_result.value());
+  ASSERT_NO_FATAL_FAILURE(VerifyStreamNextBatch(&stream, R"([[1, "Foo"], [3, "Baz"]])"));
+}
+
+TEST_F(FileScanTaskTest, PositionDeletesSkipRowGroups) {
+  // Each row is written to its own row group.
+  CreateSimpleParquetFile(/*chunk_size=*/1);
+  auto data_file = std::make_shared<DataFile>();
+  data_file->file_path = temp_parquet_file_;
+  data_file->file_format = FileFormatType::kParquet;
+
+  auto projected_schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32())});
+  auto delete_file = WritePositionDeleteFile(
+      std::format(R"([["{0}", 0], ["{0}", 2]])", temp_parquet_file_));
+
+  auto table = ReadTable(FileScanTask(data_file, {delete_file}), projected_schema);
+  ASSERT_NE(table, nullptr);
+  ASSERT_EQ(table->num_rows(), 1);
+  EXPECT_EQ(table->GetColumnByName("id")->GetScalar(0).ValueOrDie()->ToString(), "2");
+}
+
+TEST_F(FileScanTaskTest, ReadWithMetrics) {
+  // Each row is written to its own row group and read as its own batch.
+  CreateSimpleParquetFile(/*chunk_size=*/1);
+  auto data_file = std::make_shared<DataFile>();
+  data_file->file_path = temp_parquet_file_;
+  data_file->file_format = FileFormatType::kParquet;
+
+  auto projected_schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32()),
+                               SchemaField::MakeOptional(2, "name", string())});
+  auto delete_file =
+      WritePositionDeleteFile(std::format(R"([["{0}", 0]])", temp_parquet_file_));
+
+  FileScanTask task(data_file, {delete_file});
+  auto metrics = std::make_shared<ReadMetrics>();
+  auto stream_result =
+      task.ToArrow(file_io_, projected_schema,
+                   Expressions::NotEqual("name", Literal::String("Bar")),
+                   RowFilterMode::kCompact, /*prefetch_batches=*/0, metrics);
+  ASSERT_THAT(stream_result, IsOk());
+  auto stream = std::move(stream_result.value());
+  auto record_batch_reader = ::arrow::ImportRecordBatchReader(&stream).ValueOrDie();
+  auto table = record_batch_reader->ToTable().ValueOrDie();
+  ASSERT_EQ(table->num_rows(), 1);
+
+  // The deleted first row group is skipped, and the row of the second one is filtered.
+  EXPECT_EQ(metrics->row_groups_skipped.value(), 1);
+  EXPECT_EQ(metrics->rows_read.value(), 2);
+  EXPECT_EQ(metrics->rows_filtered.value(), 1);
+  EXPECT_EQ(metrics->rows_deleted.value(), 0);
+  EXPECT_EQ(metrics->rows_returned.value(), 1);
+  EXPECT_EQ(metrics->batches.value(), 1);
+  EXPECT_GT(metrics->bytes_read.value(), 0);
+  EXPECT_GT(metrics->io_duration.count(), 0);
+  EXPECT_GT(metrics->decode_duration.count(), 0);
+}
+
+TEST_F(FileScanTaskTest, ReadWithDeletionVector) {
+  auto data_file = std::make_shared<DataFile>();
+  data_file->file_path = temp_parquet_file_;
+  data_file->file_format = FileFormatType::kParquet;
+
+  auto projected_schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32()),
+                               SchemaField::MakeOptional(2, "name", string())});
+  auto delete_file = WriteDeletionVector({0, 2});
+
+  FileScanTask task(data_file, {delete_file});
+  auto stream_result = task.ToArrow(file_io_, projected_schema, nullptr);
+  ASSERT_THAT(stream_result, IsOk());
+  auto stream = std::move(stream_result.value());
+  ASSERT_NO_FATAL_FAILURE(VerifyStreamNextBatch(&stream, R"([[2, "Bar"]])"));
+}
+
+TEST_F(FileScanTaskTest, InvalidDeletionVectorCardinality) {
+  auto data_file = std::make_shared<DataFile>();
+  data_file->file_path = temp_parquet_file_;
+  data_file->file_format = FileFormatType::kParquet;
+
+  auto projected_schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32())});
+  auto delete_file = WriteDeletionVector({1});
+  delete_file->record_count = 2;
+
+  FileScanTask task(data_file, {delete_file});
+  EXPECT_THAT(task.ToArrow(file_io_, projected_schema, nullptr),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(FileScanTaskTest, DeleteLoaderReadsDeleteFilesOnce) {
+  auto data_file = std::make_shared<DataFile>();
+  data_file->file_path = temp_parquet_file_;
+  data_file->file_format = FileFormatType::kParquet;
+
+  auto projected_schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32())});
+  auto position_deletes =
+      WritePositionDeleteFile(std::format(R"([["{}", 0]])", temp_parquet_file_));
+  auto deletion_vector = WriteDeletionVector({2});
+
+  auto delete_loader = std::make_shared<DeleteLoader>(file_io_);
+  FileScanTask first_task(data_file, {position_deletes}, delete_loader);
+  FileScanTask second_task(data_file, {deletion_vector, position_deletes},
+                           delete_loader);
+  auto first_table = ReadTable(first_task, projected_schema);
+  ASSERT_NE(first_table, nullptr);
+  EXPECT_EQ(first_table->num_rows(), 2);
+
+  // The position delete file is not read again by the second task.
+  ASSERT_THAT(file_io_->DeleteFile(position_deletes->file_path), IsOk());
+  auto second_table = ReadTable(second_task, projected_schema);
+  ASSERT_NE(second_table, nullptr);
+  ASSERT_EQ(second_table->num_rows(), 1);
+  EXPECT_EQ(second_table->GetColumnByName("id")->GetScalar(0).ValueOrDie()->ToString(),
+            "2");
+}
+
+TEST_F(FileScanTaskTest, ReadWithEqualityDeletes) {
+  auto data_file = std::make_shared<DataFile>();
+  data_file->file_path = temp_parquet_file_;
+  data_file->file_format = FileFormatType::kParquet;
+
+  auto table_schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32()),
+                               SchemaField::MakeOptional(2, "name", string())});
+  auto equality_deletes = WriteEqualityDeleteFile(R"([[2], [4]])");
+  auto position_deletes =
+      WritePositionDeleteFile(std::format(R"([["{}", 0]])", temp_parquet_file_));
+  auto delete_loader = std::make_shared<DeleteLoader>(file_io_, table_schema);
+  FileScanTask task(data_file, {equality_deletes, position_deletes}, delete_loader);
+
+  auto stream_result = task.ToArrow(file_io_, table_schema, nullptr);
+  ASSERT_THAT(stream_result, IsOk());
+  auto stream = std::move(stream_result.value());
+  ASSERT_NO_FATAL_FAILURE(VerifyStreamNextBatch(&stream, R"([[3, "Baz"]])"));
+
+  // The equality field is read to apply the deletes, but is not returned.
+  auto projected_schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeOptional(2, "name", string())});
+  FileScanTask equality_task(data_file, {equality_deletes}, delete_loader);
+  auto projected_result = equality_task.ToArrow(file_io_, projected_schema, nullptr);
+  ASSERT_THAT(projected_result, IsOk());
+  auto projected_stream = std::move(projected_result.value());
+  ASSERT_NO_FATAL_FAILURE(
+      VerifyStreamNextBatch(&projected_stream, R"([["Foo"], ["Baz"]])"));
+}
+
+TEST_F(FileScanTaskTest, CountRows) {
+  auto schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32()),
+                               SchemaField::MakeOptional(2, "name", string())});
+
+  // Without a filter, the count of a whole file comes from its metadata, so the file is
+  // not opened.
+  auto missing_file = std::make_shared<DataFile>();
+  missing_file->file_path = "missing.parquet";
+  missing_file->file_format = FileFormatType::kParquet;
+  missing_file->record_count = 10;
+  FileScanTask missing_task(missing_file);
+  EXPECT_THAT(missing_task.CountRows(file_io_, schema, nullptr), HasValue(10));
+  EXPECT_THAT(missing_task.CountRows(file_io_, schema, Expressions::AlwaysTrue()),
+              HasValue(10));
+
+  auto data_file = std::make_shared<DataFile>();
+  data_file->file_path = temp_parquet_file_;
+  data_file->file_format = FileFormatType::kParquet;
+  data_file->record_count = 3;
+  auto position_deletes =
+      WritePositionDeleteFile(std::format(R"([["{}", 0]])", temp_parquet_file_));
+  FileScanTask task(data_file, {position_deletes});
+  EXPECT_THAT(task.CountRows(file_io_, schema, nullptr), HasValue(2));
+
+  // Only the rows matching the filter are counted.
+  auto filter = Expressions::NotEqual("name", Literal::String("Bar"));
+  EXPECT_THAT(task.CountRows(file_io_, schema, filter), HasValue(1));
+
+  auto equality_deletes = WriteEqualityDeleteFile(R"([[2]])");
+  auto delete_loader = std::make_shared<DeleteLoader>(file_io_, schema);
+  FileScanTask equality_task(data_file, {equality_deletes}, delete_loader);
+  EXPECT_THAT(equality_task.CountRows(file_io_, schema, nullptr), HasValue(2));
+}
+
 }  // namespace iceberg
@@ -17,6 +17,9 @@
  * under the License.
  */
 
+#include <istream>
+#include <iterator>
+
 #include <arrow/filesystem/localfs.h>
 #include <arrow/io/compressed.h>
 #include <arrow/io/file.h>
@@ -24,10 +27,12 @@
 #include <gtest/gtest.h>
 
 #include "iceberg/arrow/arrow_fs_file_io_internal.h"
+#include "iceberg/executor.h"
 #include "iceberg/file_io.h"
 #include "iceberg/test/matchers.h"
 #include "iceberg/test/temp_file_test_base.h"
 #include "iceberg/util/gzip_internal.h"
+#include "iceberg/util/macros.h"
 
 namespace iceberg {
 
@@ -40,6 +45,18 @@ class GZipTest : public TempFileTestBase {
     temp_filepath_ = CreateNewTempFilePathWithSuffix("test.gz");
   }
 
+  /// \brief Reads the file at temp_filepath_ through a GZipInputBuffer.
+  Result<std::string> ReadWithInputBuffer(std::shared_ptr<Executor> executor) {
+    ICEBERG_ASSIGN_OR_RAISE(auto file, io_->NewInputFile(temp_filepath_, std::nullopt));
+    ICEBERG_ASSIGN_OR_RAISE(auto buffer,
+                            GZipInputBuffer::Make(std::move(file), std::move(executor)));
+    std::istream stream(buffer.get());
+    std::string content{std::istreambuf_iterator<char>(stream),
+                        std::istreambuf_iterator<char>()};
+    ICEBERG_RETURN_UNEXPECTED(buffer->status());
+    return content;
+  }
+
   std::shared_ptr<iceberg::FileIO> io_;
   std::string temp_filepath_;
 };
@@ -80,4 +97,142 @@ TEST_F(GZipTest, GZipDecompressedString) {
   ASSERT_EQ(read_data.value(), test_string);
 }
 
+TEST_F(GZipTest, GZipCompressRoundTrip) {
+  GZipCompressor gzip_compressor;
+  ASSERT_THAT(gzip_compressor.Init(), IsOk());
+  GZipDecompressor gzip_decompressor;
+  ASSERT_THAT(gzip_decompressor.Init(), IsOk());
+
+  // Both are reusable, and the outputs are larger than the initial inflate buffer.
+  for (const auto& data : {GenerateRandomString(1024), std::string(1 << 20, 'a'),
+                           GenerateRandomString(100 * 1024)}) {
+    auto compressed = gzip_compressor.Compress(data);
+    ASSERT_THAT(compressed, IsOk());
+    ASSERT_GE(compressed->size(), 2);
+    EXPECT_EQ(static_cast<unsigned char>((*compressed)[0]), 0x1f);
+    EXPECT_EQ(static_cast<unsigned char>((*compressed)[1]), 0x8b);
+    auto decompressed = gzip_decompressor.Decompress(compressed.value());
+    ASSERT_THAT(decompressed, IsOk());
+    EXPECT_EQ(decompressed.value(), data);
+  }
+}
+
+TEST_F(GZipTest, GZipDecompressWithWrongTrailerSize) {
+  GZipCompressor gzip_compressor;
+  auto compressed = gzip_compressor.Compress(GenerateRandomString(64 * 1024));
+  ASSERT_THAT(compressed, IsOk());
+
+  // A corrupted uncompressed size is detected by the trailer check, and does not size
+  // the output buffer beyond the maximum compression ratio.
+  for (char size_byte : {'\x01', '\xff'}) {
+    std::string corrupted = compressed.value();
+    corrupted.back() = size_byte;
+    GZipDecompressor gzip_decompressor;
+    EXPECT_THAT(gzip_decompressor.Decompress(corrupted),
+                IsError(ErrorKind::kDecompressError));
+  }
+}
+
+TEST_F(GZipTest, GZipDecompressTruncatedData) {
+  GZipCompressor gzip_compressor;
+  auto compressed = gzip_compressor.Compress(GenerateRandomString(1024));
+  ASSERT_THAT(compressed, IsOk());
+
+  GZipDecompressor gzip_decompressor;
+  EXPECT_THAT(gzip_decompressor.Decompress(compressed->substr(0, compressed->size() / 2)),
+              IsError(ErrorKind::kDecompressError));
+}
+
+TEST_F(GZipTest, GZipOutputFileRoundTrip) {
+  auto data = GenerateRandomString(100 * 1024) + std::string(1 << 20, 'a');
+
+  auto output_file = io_->NewOutputFile(temp_filepath_);
+  ASSERT_THAT(output_file, IsOk());
+  auto file = GZipOutputFile::Make(std::move(output_file.value()));
+  ASSERT_THAT(file, IsOk());
+  // Written in pieces that do not line up with the compressed output buffer.
+  for (size_t pos = 0; pos < data.size(); pos += 7000) {
+    ASSERT_THAT((*file)->Write(std::string_view(data).substr(pos, 7000)), IsOk());
+  }
+  EXPECT_THAT((*file)->Position(), HasValue(static_cast<int64_t>(data.size())));
+  ASSERT_THAT((*file)->Close(), IsOk());
+  EXPECT_THAT((*file)->Write("more"), IsError(ErrorKind::kInvalid));
+
+  auto compressed = io_->ReadFile(temp_filepath_, std::nullopt);
+  ASSERT_THAT(compressed, IsOk());
+  EXPECT_LT(compressed->size(), data.size());
+  GZipDecompressor gzip_decompressor;
+  ASSERT_THAT(gzip_decompressor.Init(), IsOk());
+  auto decompressed = gzip_decompressor.Decompress(compressed.value());
+  ASSERT_THAT(decompressed, IsOk());
+  EXPECT_EQ(decompressed.value(), data);
+}
+
+TEST_F(GZipTest, GZipOutputFileCompressesMembersInParallel) {
+  auto data = GenerateRandomString(GZipOutputFile::kMemberSize * 5 / 2);
+  std::shared_ptr<Executor> executor = ThreadPoolExecutor::Make(4).value();
+
+  auto output_file = io_->NewOutputFile(temp_filepath_);
+  ASSERT_THAT(output_file, IsOk());
+  auto file = GZipOutputFile::Make(std::move(output_file.value()),
+                                   GZipCompressor::kDefaultCompressionLevel, executor);
+  ASSERT_THAT(file, IsOk());
+  ASSERT_THAT((*file)->Write(data), IsOk());
+  ASSERT_THAT((*file)->Close(), IsOk());
+
+  // Three members, each decompressing into its part of the data.
+  auto compressed = io_->ReadFile(temp_filepath_, std::nullopt);
+  ASSERT_THAT(compressed, IsOk());
+  GZipDecompressor gzip_decompressor;
+  EXPECT_THAT(gzip_decompressor.Decompress(compressed.value()), HasValue(data));
+
+  // Members are cut from the stream and decompressed on the executor, or on the
+  // calling thread.
+  EXPECT_THAT(ReadWithInputBuffer(executor), HasValue(data));
+  EXPECT_THAT(ReadWithInputBuffer(nullptr), HasValue(data));
+}
+
+TEST_F(GZipTest, GZipInputBufferInflatesOtherStreams) {
+  GZipCompressor gzip_compressor;
+  auto first = GenerateRandomString(100 * 1024);
+  auto second = std::string(1 << 20, 'a');
+  auto first_member = gzip_compressor.Compress(first);
+  ASSERT_THAT(first_member, IsOk());
+  auto second_member = gzip_compressor.Compress(second);
+  ASSERT_THAT(second_member, IsOk());
+
+  // A multi-member stream whose members do not record their sizes.
+  ASSERT_THAT(io_->WriteFile(temp_filepath_, *first_member + *second_member), IsOk());
+  std::shared_ptr<Executor> executor = ThreadPoolExecutor::Make(2).value();
+  EXPECT_THAT(ReadWithInputBuffer(executor), HasValue(first + second));
+
+  ASSERT_THAT(io_->WriteFile(temp_filepath_,
+                             first_member->substr(0, first_member->size() / 2)),
+              IsOk());
+  EXPECT_THAT(ReadWithInputBuffer(executor), IsError(ErrorKind::kDecompressError));
+}
+
+TEST_F(GZipTest, GZipInputBufferCorruptedMembers) {
+  auto output_file = io_->NewOutputFile(temp_filepath_);
+  ASSERT_THAT(output_file, IsOk());
+  auto file = GZipOutputFile::Make(std::move(output_file.value()));
+  ASSERT_THAT(file, IsOk());
+  ASSERT_THAT((*file)->Write(GenerateRandomString(GZipOutputFile::kMemberSize * 2)),
+              IsOk());
+  ASSERT_THAT((*file)->Close(), IsOk());
+  auto compressed = io_->ReadFile(temp_filepath_, std::nullopt);
+  ASSERT_THAT(compressed, IsOk());
+
+  std::shared_ptr<Executor> executor = ThreadPoolExecutor::Make(2).value();
+  std::string corrupted = compressed.value();
+  corrupted[corrupted.size() - 100] ^= 0x55;
+  ASSERT_THAT(io_->WriteFile(temp_filepath_, corrupted), IsOk());
+  EXPECT_THAT(ReadWithInputBuffer(executor), IsError(ErrorKind::kDecompressError));
+
+  ASSERT_THAT(
+      io_->WriteFile(temp_filepath_, compressed->substr(0, compressed->size() - 1)),
+      IsOk());
+  EXPECT_THAT(ReadWithInputBuffer(executor), IsError(ErrorKind::kDecompressError));
+}
+
 }  // namespace iceberg
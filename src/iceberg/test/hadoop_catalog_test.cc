@@ -0,0 +1,211 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/catalog/hadoop/hadoop_catalog.h"
+
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/arrow/arrow_fs_file_io_internal.h"
+#include "iceberg/avro/avro_register.h"
+#include "iceberg/fast_append.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/table_update.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/test/temp_file_test_base.h"
+#include "iceberg/type.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+class HadoopCatalogTest : public TempFileTestBase {
+ protected:
+  static void SetUpTestSuite() { avro::RegisterAll(); }
+
+  void SetUp() override {
+    TempFileTestBase::SetUp();
+    file_io_ = arrow::ArrowFileSystemFileIO::MakeLocalFileIO();
+    warehouse_ = CreateTempDirectory();
+    catalog_ = HadoopCatalog::Make("test_catalog", file_io_, warehouse_);
+  }
+
+  std::shared_ptr<Table> CreateTable(const TableIdentifier& identifier) {
+    auto table = catalog_->CreateTable(identifier, schema_,
+                                       *PartitionSpec::Unpartitioned(),
+                                       /*location=*/"", {});
+    EXPECT_THAT(table, IsOk());
+    return std::move(table.value());
+  }
+
+  std::string MetadataFolder(const TableIdentifier& identifier) const {
+    return catalog_->TableLocation(identifier).value() + "/metadata";
+  }
+
+  Status SetProperty(const TableIdentifier& identifier, const std::string& key) {
+    std::vector<std::unique_ptr<TableUpdate>> updates;
+    updates.push_back(std::make_unique<table::SetProperties>(
+        std::unordered_map<std::string, std::string>{{key, "true"}}));
+    ICEBERG_RETURN_UNEXPECTED(catalog_->UpdateTable(identifier, {}, updates));
+    return {};
+  }
+
+  std::shared_ptr<FileIO> file_io_;
+  std::string warehouse_;
+  std::shared_ptr<HadoopCatalog> catalog_;
+  Schema schema_{std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int64())}};
+  TableIdentifier identifier_{.ns = Namespace{{"db"}}, .name = "t1"};
+};
+
+TEST_F(HadoopCatalogTest, CreatesAndCommitsVersions) {
+  auto table = CreateTable(identifier_);
+  EXPECT_EQ(table->metadata_location(),
+            MetadataFolder(identifier_) + "/v1.metadata.json");
+  EXPECT_EQ(table->location(), std::format("{}/db/t1", warehouse_));
+  EXPECT_EQ(table->metadata()->last_column_id, 1);
+  EXPECT_THAT(catalog_->TableExists(identifier_), HasValue(::testing::IsTrue()));
+
+  FastAppend append(table);
+  append.AppendFile(std::make_shared<DataFile>(DataFile{
+      .file_path = "/data/a.parquet",
+      .file_format = FileFormatType::kParquet,
+      .record_count = 10,
+      .file_size_in_bytes = 100,
+  }));
+  ASSERT_THAT(append.Commit(), IsOk());
+
+  ICEBERG_UNWRAP_OR_FAIL(auto loaded, catalog_->LoadTable(identifier_));
+  EXPECT_EQ(loaded->metadata_location(),
+            MetadataFolder(identifier_) + "/v2.metadata.json");
+  ICEBERG_UNWRAP_OR_FAIL(auto current, loaded->current_snapshot());
+  EXPECT_EQ(current->snapshot_id, append.snapshot_id());
+  EXPECT_THAT(file_io_->ReadFile(MetadataFolder(identifier_) + "/version-hint.text",
+                                 std::nullopt),
+              HasValue(::testing::Eq("2")));
+
+  EXPECT_THAT(catalog_->CreateTable(identifier_, schema_,
+                                    *PartitionSpec::Unpartitioned(), "", {}),
+              IsError(ErrorKind::kAlreadyExists));
+  EXPECT_THAT(catalog_->CreateTable({.ns = {}, .name = "t2"}, schema_,
+                                    *PartitionSpec::Unpartitioned(), "/elsewhere", {}),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(HadoopCatalogTest, FindsVersionsPastTheHint) {
+  CreateTable(identifier_);
+  for (int i = 0; i < 9; ++i) {
+    ASSERT_THAT(SetProperty(identifier_, std::format("p{}", i)), IsOk());
+  }
+  const auto latest = MetadataFolder(identifier_) + "/v10.metadata.json";
+  const auto hint = MetadataFolder(identifier_) + "/version-hint.text";
+  EXPECT_THAT(catalog_->GetTableMetadataLocation(identifier_), HasValue(latest));
+
+  // A stale hint is a starting point for probing the next versions.
+  ASSERT_THAT(file_io_->WriteFile(hint, "3"), IsOk());
+  EXPECT_THAT(catalog_->GetTableMetadataLocation(identifier_), HasValue(latest));
+
+  // A hint that cannot be used falls back to listing the metadata folder.
+  ASSERT_THAT(file_io_->WriteFile(hint, "not a version"), IsOk());
+  EXPECT_THAT(catalog_->GetTableMetadataLocation(identifier_), HasValue(latest));
+  ASSERT_THAT(file_io_->DeleteFile(hint), IsOk());
+  EXPECT_THAT(catalog_->GetTableMetadataLocation(identifier_), HasValue(latest));
+
+  ICEBERG_UNWRAP_OR_FAIL(auto table, catalog_->LoadTable(identifier_));
+  EXPECT_EQ(table->metadata()->properties.size(), 9);
+}
+
+TEST_F(HadoopCatalogTest, ConcurrentCommitsWriteEachVersionOnce) {
+  CreateTable(identifier_);
+  constexpr int kThreads = 8;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      // A commit that loses the race for a version retries on the next one.
+      Status status;
+      do {
+        status = SetProperty(identifier_, std::format("p{}", i));
+      } while (!status.has_value() && status.error().kind == ErrorKind::kCommitFailed);
+      EXPECT_THAT(status, IsOk());
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ICEBERG_UNWRAP_OR_FAIL(auto table, catalog_->LoadTable(identifier_));
+  EXPECT_EQ(table->metadata_location(),
+            std::format("{}/v{}.metadata.json", MetadataFolder(identifier_),
+                        kThreads + 1));
+  EXPECT_EQ(table->metadata()->properties.size(), kThreads);
+}
+
+TEST_F(HadoopCatalogTest, NamespacesHoldTables) {
+  CreateTable(identifier_);
+  CreateTable({.ns = Namespace{{"db", "inner"}}, .name = "t2"});
+  const Namespace db{{"db"}};
+
+  ICEBERG_UNWRAP_OR_FAIL(auto tables, catalog_->ListTables(db));
+  ASSERT_EQ(tables.size(), 1);
+  EXPECT_EQ(tables[0].ns.levels, db.levels);
+  EXPECT_EQ(tables[0].name, "t1");
+  ICEBERG_UNWRAP_OR_FAIL(auto namespaces, catalog_->ListNamespaces({}));
+  ASSERT_EQ(namespaces.size(), 1);
+  EXPECT_EQ(namespaces[0].levels, db.levels);
+  ICEBERG_UNWRAP_OR_FAIL(namespaces, catalog_->ListNamespaces(db));
+  ASSERT_EQ(namespaces.size(), 1);
+  EXPECT_THAT(namespaces[0].levels, ::testing::ElementsAre("db", "inner"));
+  EXPECT_THAT(catalog_->NamespaceExists(db), HasValue(::testing::IsTrue()));
+  EXPECT_THAT(catalog_->NamespaceExists(Namespace{{"other"}}),
+              HasValue(::testing::IsFalse()));
+  EXPECT_THAT(catalog_->ListTables(Namespace{{"other"}}),
+              IsError(ErrorKind::kNoSuchNamespace));
+  EXPECT_THAT(catalog_->DropNamespace(db), IsError(ErrorKind::kNotAllowed));
+  EXPECT_THAT(catalog_->CreateNamespace(Namespace{{"other"}}, {}),
+              IsError(ErrorKind::kNotSupported));
+  EXPECT_THAT(catalog_->TableExists({.ns = Namespace{{"a/b"}}, .name = "t"}),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(HadoopCatalogTest, DropTable) {
+  CreateTable(identifier_);
+  ASSERT_THAT(SetProperty(identifier_, "p"), IsOk());
+  ASSERT_THAT(catalog_->DropTable(identifier_, /*purge=*/false), IsOk());
+
+  EXPECT_THAT(catalog_->TableExists(identifier_), HasValue(::testing::IsFalse()));
+  EXPECT_THAT(catalog_->LoadTable(identifier_), IsError(ErrorKind::kNoSuchTable));
+  EXPECT_THAT(catalog_->ListTables({}), HasValue(::testing::IsEmpty()));
+
+  // The table can be created again at the same location.
+  auto table = CreateTable(identifier_);
+  EXPECT_EQ(table->metadata_location(),
+            MetadataFolder(identifier_) + "/v1.metadata.json");
+}
+
+}  // namespace iceberg
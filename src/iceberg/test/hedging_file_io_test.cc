@@ -0,0 +1,195 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/hedging_file_io.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/executor.h"
+#include "iceberg/test/matchers.h"
+
+namespace iceberg {
+
+namespace {
+
+using namespace std::chrono_literals;
+
+/// \brief A FileIO of a single file whose first reads are slow or throttled.
+class ScriptedFileIO : public FileIO {
+ public:
+  class File : public InputFile {
+   public:
+    explicit File(ScriptedFileIO* io) : io_(io) {}
+
+    const std::string& location() const override { return io_->location_; }
+
+    Result<int64_t> Size() override {
+      return static_cast<int64_t>(io_->content_.size());
+    }
+
+    Result<int64_t> ReadAt(int64_t offset, std::span<uint8_t> out) override {
+      ICEBERG_RETURN_UNEXPECTED(io_->Request());
+      const auto length = std::min<int64_t>(
+          static_cast<int64_t>(out.size()),
+          static_cast<int64_t>(io_->content_.size()) - offset);
+      std::memcpy(out.data(), io_->content_.data() + offset,
+                  static_cast<size_t>(length));
+      return length;
+    }
+
+   private:
+    ScriptedFileIO* io_;
+  };
+
+  Result<std::string> ReadFile(const std::string& file_location,
+                               std::optional<size_t> length) override {
+    ICEBERG_RETURN_UNEXPECTED(Request());
+    return content_;
+  }
+
+  Result<std::unique_ptr<InputFile>> NewInputFile(const std::string& file_location,
+                                                  std::optional<size_t> length) override {
+    return std::make_unique<File>(this);
+  }
+
+  Status Request() {
+    const int32_t request = requests_.fetch_add(1);
+    if (request < throttled_requests_) {
+      return IOError("HTTP 503: SlowDown, please reduce your request rate");
+    }
+    if (request < throttled_requests_ + slow_requests_) {
+      std::this_thread::sleep_for(slow_latency_);
+    }
+    return {};
+  }
+
+  std::string location_ = "s3://bucket/table/data/file.parquet";
+  std::string content_ = "0123456789";
+  int32_t throttled_requests_ = 0;
+  int32_t slow_requests_ = 0;
+  std::chrono::milliseconds slow_latency_{0};
+  std::atomic<int32_t> requests_{0};
+};
+
+}  // namespace
+
+class HedgingFileIOTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    file_io_ = std::make_shared<ScriptedFileIO>();
+    ICEBERG_UNWRAP_OR_FAIL(executor_, ThreadPoolExecutor::Make(4));
+  }
+
+  std::shared_ptr<HedgingFileIO> MakeIO(HedgingFileIO::Options options) {
+    options.executor = executor_;
+    auto io = HedgingFileIO::Make(file_io_, std::move(options));
+    EXPECT_THAT(io, IsOk());
+    return io.value();
+  }
+
+  std::shared_ptr<Executor> executor_;
+  std::shared_ptr<ScriptedFileIO> file_io_;
+};
+
+TEST_F(HedgingFileIOTest, HedgesSlowReadFile) {
+  file_io_->slow_requests_ = 1;
+  file_io_->slow_latency_ = 500ms;
+  auto io = MakeIO({.initial_hedge_delay = 20ms});
+
+  const auto start = std::chrono::steady_clock::now();
+  ICEBERG_UNWRAP_OR_FAIL(auto content, io->ReadFile("file", std::nullopt));
+  EXPECT_EQ(content, "0123456789");
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 400ms);
+  EXPECT_EQ(file_io_->requests_, 2);
+  const auto stats = io->stats();
+  EXPECT_EQ(stats.hedged_reads, 1);
+  EXPECT_EQ(stats.hedge_wins, 1);
+}
+
+TEST_F(HedgingFileIOTest, HedgesSlowReadAt) {
+  file_io_->slow_requests_ = 1;
+  file_io_->slow_latency_ = 500ms;
+  auto io = MakeIO({.initial_hedge_delay = 20ms});
+  ICEBERG_UNWRAP_OR_FAIL(auto file, io->NewInputFile("file", std::nullopt));
+
+  std::string out(4, '\0');
+  const auto start = std::chrono::steady_clock::now();
+  auto read = file->ReadAt(
+      3, std::span(reinterpret_cast<uint8_t*>(out.data()), out.size()));
+  ASSERT_THAT(read, IsOk());
+  EXPECT_EQ(*read, 4);
+  EXPECT_EQ(out, "3456");
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 400ms);
+  EXPECT_EQ(io->stats().hedge_wins, 1);
+}
+
+TEST_F(HedgingFileIOTest, FastReadsAreNotHedged) {
+  auto io = MakeIO({.initial_hedge_delay = 1000ms});
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_THAT(io->ReadFile("file", std::nullopt), IsOk());
+  }
+  EXPECT_EQ(file_io_->requests_, 10);
+  EXPECT_EQ(io->stats().hedged_reads, 0);
+}
+
+TEST_F(HedgingFileIOTest, ThrottlingHalvesConcurrency) {
+  file_io_->throttled_requests_ = 2;
+  auto io = MakeIO({.initial_concurrency = 8, .min_concurrency = 1});
+
+  EXPECT_THAT(io->ReadFile("file", std::nullopt), HasValue(::testing::Eq("0123456789")));
+  const auto stats = io->stats();
+  EXPECT_EQ(stats.throttled_requests, 2);
+  // Halved twice, then raised by 1/2 by the successful request.
+  EXPECT_DOUBLE_EQ(stats.concurrency_limit, 2.5);
+}
+
+TEST_F(HedgingFileIOTest, ThrottledRequestsGiveUp) {
+  file_io_->throttled_requests_ = 10;
+  auto io = MakeIO({.max_throttle_retries = 1});
+  EXPECT_THAT(io->ReadFile("file", std::nullopt), IsError(ErrorKind::kIOError));
+  EXPECT_EQ(file_io_->requests_, 2);
+}
+
+TEST_F(HedgingFileIOTest, IsThrottling) {
+  EXPECT_TRUE(HedgingFileIO::IsThrottling(
+      Error{.kind = ErrorKind::kIOError, .message = "AWS Error SLOW_DOWN (SlowDown)"}));
+  EXPECT_TRUE(HedgingFileIO::IsThrottling(
+      Error{.kind = ErrorKind::kIOError, .message = "HTTP response code 429"}));
+  EXPECT_FALSE(HedgingFileIO::IsThrottling(
+      Error{.kind = ErrorKind::kIOError, .message = "HTTP response code 404"}));
+}
+
+TEST_F(HedgingFileIOTest, InvalidOptions) {
+  EXPECT_THAT(HedgingFileIO::Make(nullptr, {}), IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(HedgingFileIO::Make(file_io_, {.hedge_percentile = 0}),
+              IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(HedgingFileIO::Make(file_io_, {.initial_concurrency = 4,
+                                             .min_concurrency = 8,
+                                             .max_concurrency = 16}),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+}  // namespace iceberg
@@ -0,0 +1,250 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/import_files.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <arrow/array.h>
+#include <arrow/json/from_string.h>
+#include <arrow/record_batch.h>
+#include <arrow/table.h>
+#include <arrow/util/key_value_metadata.h>
+#include <gtest/gtest.h>
+#include <parquet/arrow/writer.h>
+
+#include "iceberg/arrow/arrow_fs_file_io_internal.h"
+#include "iceberg/avro/avro_register.h"
+#include "iceberg/expression/expressions.h"
+#include "iceberg/expression/literal.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/name_mapping.h"
+#include "iceberg/parquet/parquet_register.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table.h"
+#include "iceberg/table_scan.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/test/table_test_base.h"
+#include "iceberg/transform.h"
+#include "iceberg/type.h"
+#include "iceberg/util/checked_cast.h"
+
+namespace iceberg {
+
+class ImportFilesTest : public TableTestBase {
+ protected:
+  static void SetUpTestSuite() {
+    avro::RegisterAll();
+    parquet::RegisterAll();
+  }
+
+  void SetUp() override {
+    TableTestBase::SetUp();
+    std::filesystem::create_directories(table_location_ + "/data");
+    schema_ = std::make_shared<Schema>(
+        std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int64()),
+                                 SchemaField::MakeOptional(2, "data", string())},
+        /*schema_id=*/0);
+  }
+
+  // Registers and loads an empty table, partitioned by identity(id) if requested.
+  void CreateTable(std::unordered_map<std::string, std::string> properties = {},
+                   bool partitioned = false) {
+    if (partitioned) {
+      spec_ = std::make_shared<PartitionSpec>(
+          schema_, /*spec_id=*/1,
+          std::vector<PartitionField>{
+              PartitionField(1, 1000, "id", Transform::Identity())});
+    }
+    TableTestBase::CreateTable(std::move(properties));
+  }
+
+  // Writes rows of (id, data) to a Parquet file of another writer, with or without
+  // field ids, and returns its path.
+  std::string WriteParquetFile(const std::string& name, const std::string& rows_json,
+                               bool with_field_ids, int64_t row_group_rows = 1024) {
+    auto field_id = [&](const std::string& id) {
+      return with_field_ids ? ::arrow::KeyValueMetadata::Make({"PARQUET:field_id"}, {id})
+                            : nullptr;
+    };
+    auto arrow_schema = ::arrow::schema(
+        {::arrow::field("id", ::arrow::int64(), /*nullable=*/false, field_id("1")),
+         ::arrow::field("data", ::arrow::utf8(), /*nullable=*/true, field_id("2"))});
+    auto batch = ::arrow::RecordBatch::FromStructArray(
+                     ::arrow::json::ArrayFromJSONString(
+                         ::arrow::struct_(arrow_schema->fields()), rows_json)
+                         .ValueOrDie())
+                     .ValueOrDie();
+    auto table = ::arrow::Table::FromRecordBatches(arrow_schema, {batch}).ValueOrDie();
+
+    auto path = std::format("{}/data/{}", table_location_, name);
+    auto& io = internal::checked_cast<arrow::ArrowFileSystemFileIO&>(*file_io_);
+    auto outfile = io.fs()->OpenOutputStream(path).ValueOrDie();
+    EXPECT_TRUE(::parquet::arrow::WriteTable(*table, ::arrow::default_memory_pool(),
+                                             outfile, row_group_rows)
+                    .ok());
+    EXPECT_TRUE(outfile->Close().ok());
+    return path;
+  }
+
+  // Returns the data files of the current snapshot matching a filter, by path.
+  std::vector<std::shared_ptr<DataFile>> PlanFiles(
+      std::shared_ptr<Expression> filter = nullptr) {
+    TableScanBuilder builder(table_->metadata(), file_io_);
+    if (filter != nullptr) {
+      builder.WithFilter(std::move(filter));
+    }
+    auto scan = builder.Build();
+    EXPECT_THAT(scan, IsOk());
+    auto tasks = scan.value()->PlanFiles();
+    EXPECT_THAT(tasks, IsOk());
+    std::vector<std::shared_ptr<DataFile>> files;
+    for (const auto& task : tasks.value()) {
+      files.push_back(task->data_file());
+    }
+    std::ranges::sort(files, {}, &DataFile::file_path);
+    return files;
+  }
+};
+
+TEST_F(ImportFilesTest, ImportsMetricsFromFooters) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable({{"write.metadata.metrics.column.data",
+                                        "truncate(2)"}}));
+  // The rows of the first file are split across row groups.
+  auto first = WriteParquetFile(
+      "a.parquet", R"([[3, "carol"], [1, null], [5, "alice"], [4, null]])",
+      /*with_field_ids=*/true, /*row_group_rows=*/2);
+  auto second =
+      WriteParquetFile("b.parquet", R"([[10, "dave"], [12, "eve"]])",
+                       /*with_field_ids=*/true);
+
+  ImportFiles import(table_);
+  import.AddFile(first).AddFile(second).WithParallelism(2).Set("source", "hive");
+  ICEBERG_UNWRAP_OR_FAIL(auto result, import.Execute());
+  EXPECT_EQ(result.imported_files_count, 2);
+  EXPECT_EQ(result.imported_records_count, 6);
+
+  ICEBERG_UNWRAP_OR_FAIL(auto snapshot, table_->metadata()->Snapshot());
+  ASSERT_TRUE(result.snapshot_id.has_value());
+  EXPECT_EQ(snapshot->snapshot_id, *result.snapshot_id);
+  EXPECT_EQ(snapshot->operation(), DataOperation::kAppend);
+  EXPECT_EQ(snapshot->summary.at(SnapshotSummaryFields::kAddedDataFiles), "2");
+  EXPECT_EQ(snapshot->summary.at("source"), "hive");
+
+  auto files = PlanFiles();
+  ASSERT_EQ(files.size(), 2);
+  const auto& file = *files[0];
+  EXPECT_EQ(file.file_path, first);
+  EXPECT_EQ(file.record_count, 4);
+  EXPECT_EQ(file.file_size_in_bytes, std::filesystem::file_size(first));
+  EXPECT_EQ(file.split_offsets.size(), 2);
+  EXPECT_EQ(file.value_counts.at(1), 4);
+  EXPECT_EQ(file.null_value_counts.at(1), 0);
+  EXPECT_EQ(file.null_value_counts.at(2), 2);
+  EXPECT_GT(file.column_sizes.at(1), 0);
+  EXPECT_EQ(file.lower_bounds.at(1), Literal::Long(1).Serialize().value());
+  EXPECT_EQ(file.upper_bounds.at(1), Literal::Long(5).Serialize().value());
+  // The string bounds are truncated like the bounds of written files.
+  EXPECT_EQ(file.lower_bounds.at(2), Literal::String("al").Serialize().value());
+  EXPECT_EQ(file.upper_bounds.at(2), Literal::String("cb").Serialize().value());
+
+  // The bounds prune the imported files.
+  auto matching = PlanFiles(Expressions::GreaterThan("id", Literal::Long(8)));
+  ASSERT_EQ(matching.size(), 1);
+  EXPECT_EQ(matching[0]->file_path, second);
+}
+
+TEST_F(ImportFilesTest, AppliesNameMapping) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable(
+      {{"schema.name-mapping.default",
+        R"([{"field-id": 1, "names": ["id"]}, {"field-id": 2, "names": ["data"]}])"}}));
+  auto path = WriteParquetFile("a.parquet", R"([[7, "x"], [9, null]])",
+                               /*with_field_ids=*/false);
+
+  ImportFiles import(table_);
+  import.AddFile(path);
+  ASSERT_THAT(import.Execute(), IsOk());
+
+  auto files = PlanFiles();
+  ASSERT_EQ(files.size(), 1);
+  EXPECT_EQ(files[0]->record_count, 2);
+  EXPECT_EQ(files[0]->null_value_counts.at(2), 1);
+  EXPECT_EQ(files[0]->lower_bounds.at(1), Literal::Long(7).Serialize().value());
+  EXPECT_EQ(files[0]->upper_bounds.at(1), Literal::Long(9).Serialize().value());
+
+  // Columns that are not mapped have no metrics.
+  auto unmapped_path = WriteParquetFile("b.parquet", R"([[8, "y"]])",
+                                        /*with_field_ids=*/false);
+  ImportFiles unmapped(table_);
+  unmapped.AddFile(unmapped_path).WithNameMapping(NameMapping::MakeEmpty());
+  ASSERT_THAT(unmapped.Execute(), IsOk());
+  files = PlanFiles();
+  ASSERT_EQ(files.size(), 2);
+  EXPECT_EQ(files[1]->record_count, 1);
+  EXPECT_TRUE(files[1]->value_counts.empty());
+  EXPECT_TRUE(files[1]->lower_bounds.empty());
+}
+
+TEST_F(ImportFilesTest, PartitionedTable) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable({}, /*partitioned=*/true));
+  auto path = WriteParquetFile("id=3.parquet", R"([[3, "x"]])", /*with_field_ids=*/true);
+
+  ImportFiles missing_partition(table_);
+  missing_partition.AddFile(path);
+  EXPECT_THAT(missing_partition.Execute(), IsError(ErrorKind::kInvalidArgument));
+
+  ImportFiles import(table_);
+  import.AddFile(path, {Literal::Long(3)});
+  ASSERT_THAT(import.Execute(), IsOk());
+  auto files = PlanFiles(Expressions::Equal("id", Literal::Long(3)));
+  ASSERT_EQ(files.size(), 1);
+  EXPECT_EQ(files[0]->partition, std::vector<Literal>{Literal::Long(3)});
+  EXPECT_EQ(files[0]->partition_spec_id, 1);
+  EXPECT_TRUE(PlanFiles(Expressions::Equal("id", Literal::Long(4))).empty());
+}
+
+TEST_F(ImportFilesTest, InvalidImports) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable());
+
+  ImportFiles no_files(table_);
+  ICEBERG_UNWRAP_OR_FAIL(auto result, no_files.Execute());
+  EXPECT_EQ(result.imported_files_count, 0);
+  EXPECT_FALSE(result.snapshot_id.has_value());
+
+  ImportFiles invalid_parallelism(table_);
+  invalid_parallelism.AddFile(table_location_ + "/data/a.parquet").WithParallelism(0);
+  EXPECT_THAT(invalid_parallelism.Execute(), IsError(ErrorKind::kInvalidArgument));
+
+  // A missing file fails the import without committing any file.
+  auto path = WriteParquetFile("a.parquet", R"([[1, "x"]])", /*with_field_ids=*/true);
+  ImportFiles missing_file(table_);
+  missing_file.AddFile(path).AddFile(table_location_ + "/data/missing.parquet");
+  EXPECT_FALSE(missing_file.Execute().has_value());
+  EXPECT_EQ(table_->metadata()->current_snapshot_id, Snapshot::kInvalidSnapshotId);
+}
+
+}  // namespace iceberg
@@ -19,7 +19,12 @@
 
 #include "iceberg/catalog/memory/in_memory_catalog.h"
 
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
+#include <format>
+#include <thread>
+#include <vector>
 
 #include <arrow/filesystem/localfs.h>
 #include <gmock/gmock.h>
@@ -117,6 +122,38 @@ TEST_F(InMemoryCatalogTest, RegisterTable) {
   ASSERT_EQ(table.value()->location(), "s3://bucket/test/location");
 }
 
+TEST_F(InMemoryCatalogTest, UpdateTableDeletesPreviousMetadataFiles) {
+  TableIdentifier table_ident{.ns = {}, .name = "t1"};
+
+  std::unique_ptr<TableMetadata> metadata;
+  ASSERT_NO_FATAL_FAILURE(ReadTableMetadata("TableMetadataV2Valid.json", &metadata));
+  auto table_location = GenerateTestTableLocation(table_ident.name);
+  metadata->properties["write.metadata.path"] = table_location;
+  metadata->properties["write.metadata.previous-versions-max"] = "2";
+  metadata->properties["write.metadata.delete-after-commit.enabled"] = "true";
+  auto metadata_location = std::format("{}v1.metadata.json", table_location);
+  ASSERT_THAT(TableMetadataUtil::Write(*file_io_, metadata_location, *metadata), IsOk());
+  ASSERT_THAT(catalog_->RegisterTable(table_ident, metadata_location), IsOk());
+
+  std::vector<std::string> metadata_locations = {metadata_location};
+  for (int i = 0; i < 4; ++i) {
+    auto table = catalog_->UpdateTable(table_ident, {}, {});
+    ASSERT_THAT(table, IsOk());
+    metadata_locations.push_back(table.value()->metadata_location());
+    // The log keeps the most recent previous files only.
+    const auto& metadata_log = table.value()->metadata()->metadata_log;
+    ASSERT_EQ(metadata_log.size(), static_cast<size_t>(std::min(i + 1, 2)));
+    EXPECT_EQ(metadata_log.back().metadata_file, metadata_locations[i]);
+  }
+
+  catalog_->WaitForMetadataFileDeletes();
+  for (size_t i = 0; i < metadata_locations.size(); ++i) {
+    // The files dropped from the log are deleted, the logged ones are kept.
+    EXPECT_EQ(std::filesystem::exists(metadata_locations[i]), i >= 2)
+        << metadata_locations[i];
+  }
+}
+
 TEST_F(InMemoryCatalogTest, RefreshTable) {
   TableIdentifier table_ident{.ns = {}, .name = "t1"};
   auto schema = std::make_shared<Schema>(
@@ -206,4 +243,49 @@ TEST_F(InMemoryCatalogTest, Namespace) {
   ASSERT_EQ(propsRs.value().at("prop3"), "val3");
 }
 
+TEST_F(InMemoryCatalogTest, ConcurrentReads) {
+  constexpr int kReaders = 8;
+  constexpr int kLookups = 500;
+  constexpr int kNamespaces = 50;
+  Namespace parent{.levels = {"db"}};
+  ASSERT_THAT(catalog_->CreateNamespace(parent, {}), IsOk());
+
+  std::atomic<int> failures = 0;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kReaders; ++i) {
+    threads.emplace_back([&]() {
+      for (int j = 0; j < kLookups; ++j) {
+        if (!catalog_->NamespaceExists(parent).value_or(false) ||
+            !catalog_->ListTables(parent).has_value()) {
+          ++failures;
+        }
+      }
+    });
+  }
+  threads.emplace_back([&]() {
+    for (int i = 0; i < kNamespaces; ++i) {
+      if (!catalog_->CreateNamespace(
+                   Namespace{.levels = {"db", std::format("ns{}", i)}}, {})
+               .has_value()) {
+        ++failures;
+      }
+    }
+  });
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(failures, 0);
+
+  auto children = catalog_->ListNamespaces(parent);
+  ASSERT_THAT(children, IsOk());
+  EXPECT_EQ(children->size(), kNamespaces);
+
+  auto stats = catalog_->lock_stats();
+  EXPECT_EQ(stats.shared_acquisitions, kReaders * kLookups * 2 + 1);
+  EXPECT_EQ(stats.exclusive_acquisitions, kNamespaces + 1);
+  EXPECT_LE(stats.contended_shared_acquisitions, stats.shared_acquisitions);
+  EXPECT_LE(stats.contended_exclusive_acquisitions, stats.exclusive_acquisitions);
+  EXPECT_GE(stats.wait_nanos, 0);
+}
+
 }  // namespace iceberg
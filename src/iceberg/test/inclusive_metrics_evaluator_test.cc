@@ -0,0 +1,177 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/expression/inclusive_metrics_evaluator.h"
+
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/expression/expressions.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/schema.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+class InclusiveMetricsEvaluatorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    schema_ = std::make_shared<Schema>(
+        std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32()),
+                                 SchemaField::MakeOptional(2, "data", string()),
+                                 SchemaField::MakeOptional(3, "all_nulls", string()),
+                                 SchemaField::MakeOptional(4, "some_nulls", string()),
+                                 SchemaField::MakeOptional(5, "no_stats", int32()),
+                                 SchemaField::MakeOptional(6, "all_nans", float64()),
+                                 SchemaField::MakeOptional(7, "nan_bounds", float32())},
+        /*schema_id=*/0);
+
+    // id in [30, 79], data in ["bar", "foo"] without nulls.
+    file_.file_path = "file.parquet";
+    file_.record_count = 50;
+    file_.value_counts = {{1, 50}, {2, 50}, {3, 50}, {4, 50}, {6, 50}, {7, 50}};
+    file_.null_value_counts = {{1, 0}, {2, 0}, {3, 50}, {4, 10}, {6, 0}, {7, 0}};
+    file_.nan_value_counts = {{6, 50}, {7, 5}};
+    file_.lower_bounds = {{1, Literal::Int(30).Serialize().value()},
+                          {2, Literal::String("bar").Serialize().value()},
+                          {7, Literal::Float(std::numeric_limits<float>::quiet_NaN())
+                                  .Serialize()
+                                  .value()}};
+    file_.upper_bounds = {{1, Literal::Int(79).Serialize().value()},
+                          {2, Literal::String("foo").Serialize().value()},
+                          {7, Literal::Float(2.0f).Serialize().value()}};
+  }
+
+  bool Evaluate(const std::shared_ptr<Expression>& expr) {
+    auto evaluator = InclusiveMetricsEvaluator::Make(expr, *schema_);
+    EXPECT_THAT(evaluator, IsOk());
+    auto result = (*evaluator)->Evaluate(file_);
+    EXPECT_THAT(result, IsOk());
+    return result.value();
+  }
+
+  std::shared_ptr<Schema> schema_;
+  DataFile file_;
+};
+
+TEST_F(InclusiveMetricsEvaluatorTest, Comparison) {
+  EXPECT_FALSE(Evaluate(Expressions::LessThan("id", Literal::Int(30))));
+  EXPECT_TRUE(Evaluate(Expressions::LessThan("id", Literal::Int(31))));
+  EXPECT_FALSE(Evaluate(Expressions::LessThanOrEqual("id", Literal::Int(29))));
+  EXPECT_TRUE(Evaluate(Expressions::LessThanOrEqual("id", Literal::Int(30))));
+  EXPECT_FALSE(Evaluate(Expressions::GreaterThan("id", Literal::Int(79))));
+  EXPECT_TRUE(Evaluate(Expressions::GreaterThan("id", Literal::Int(78))));
+  EXPECT_FALSE(Evaluate(Expressions::GreaterThanOrEqual("id", Literal::Int(80))));
+  EXPECT_TRUE(Evaluate(Expressions::GreaterThanOrEqual("id", Literal::Int(79))));
+  EXPECT_FALSE(Evaluate(Expressions::Equal("id", Literal::Int(5))));
+  EXPECT_FALSE(Evaluate(Expressions::Equal("id", Literal::Int(80))));
+  EXPECT_TRUE(Evaluate(Expressions::Equal("id", Literal::Int(42))));
+  EXPECT_TRUE(Evaluate(Expressions::NotEqual("id", Literal::Int(42))));
+  EXPECT_FALSE(Evaluate(Expressions::Equal("data", Literal::String("zzz"))));
+  EXPECT_TRUE(Evaluate(Expressions::Equal("data", Literal::String("baz"))));
+}
+
+TEST_F(InclusiveMetricsEvaluatorTest, NullChecks) {
+  EXPECT_FALSE(Evaluate(Expressions::IsNull("id")));
+  EXPECT_TRUE(Evaluate(Expressions::NotNull("id")));
+  EXPECT_TRUE(Evaluate(Expressions::IsNull("all_nulls")));
+  EXPECT_FALSE(Evaluate(Expressions::NotNull("all_nulls")));
+  EXPECT_TRUE(Evaluate(Expressions::IsNull("some_nulls")));
+  EXPECT_TRUE(Evaluate(Expressions::NotNull("some_nulls")));
+  // Any comparison on a column that only holds nulls is false.
+  EXPECT_FALSE(Evaluate(Expressions::Equal("all_nulls", Literal::String("a"))));
+  EXPECT_FALSE(Evaluate(Expressions::StartsWith("all_nulls", "a")));
+}
+
+TEST_F(InclusiveMetricsEvaluatorTest, NaNChecks) {
+  EXPECT_TRUE(Evaluate(Expressions::IsNaN("all_nans")));
+  EXPECT_FALSE(Evaluate(Expressions::NotNaN("all_nans")));
+  EXPECT_FALSE(Evaluate(Expressions::LessThan("all_nans", Literal::Double(1.0))));
+  EXPECT_TRUE(Evaluate(Expressions::IsNaN("nan_bounds")));
+  EXPECT_TRUE(Evaluate(Expressions::NotNaN("nan_bounds")));
+  // A NaN lower bound does not bound the column.
+  EXPECT_TRUE(Evaluate(Expressions::LessThan("nan_bounds", Literal::Float(1.0f))));
+  EXPECT_FALSE(Evaluate(Expressions::GreaterThan("nan_bounds", Literal::Float(2.0f))));
+}
+
+TEST_F(InclusiveMetricsEvaluatorTest, SetPredicates) {
+  EXPECT_FALSE(Evaluate(
+      Expressions::In("id", {Literal::Int(5), Literal::Int(6), Literal::Int(80)})));
+  EXPECT_TRUE(Evaluate(Expressions::In("id", {Literal::Int(5), Literal::Int(31)})));
+  EXPECT_TRUE(Evaluate(Expressions::NotIn("id", {Literal::Int(5), Literal::Int(31)})));
+  EXPECT_FALSE(Evaluate(Expressions::In(
+      "data", {Literal::String("aaa"), Literal::String("zzz")})));
+
+  // Sets larger than the per-value limit are pruned by their smallest and largest
+  // values.
+  std::vector<Literal> above;
+  std::vector<Literal> spanning;
+  for (int32_t i = 0; i < 1000; ++i) {
+    above.push_back(Literal::Int(100 + i));
+    spanning.push_back(Literal::Int(i * 100));
+  }
+  EXPECT_FALSE(Evaluate(Expressions::In("id", above)));
+  EXPECT_TRUE(Evaluate(Expressions::In("id", spanning)));
+}
+
+TEST_F(InclusiveMetricsEvaluatorTest, StartsWith) {
+  EXPECT_TRUE(Evaluate(Expressions::StartsWith("data", "b")));
+  EXPECT_TRUE(Evaluate(Expressions::StartsWith("data", "fo")));
+  EXPECT_FALSE(Evaluate(Expressions::StartsWith("data", "a")));
+  EXPECT_FALSE(Evaluate(Expressions::StartsWith("data", "fop")));
+  EXPECT_TRUE(Evaluate(Expressions::NotStartsWith("data", "b")));
+  EXPECT_TRUE(Evaluate(Expressions::NotStartsWith("some_nulls", "b")));
+}
+
+TEST_F(InclusiveMetricsEvaluatorTest, MissingStatsMightMatch) {
+  EXPECT_TRUE(Evaluate(Expressions::Equal("no_stats", Literal::Int(5))));
+  EXPECT_TRUE(Evaluate(Expressions::IsNull("no_stats")));
+  EXPECT_TRUE(Evaluate(Expressions::NotNull("no_stats")));
+  EXPECT_TRUE(Evaluate(Expressions::LessThan("no_stats", Literal::Int(5))));
+}
+
+TEST_F(InclusiveMetricsEvaluatorTest, LogicalExpressions) {
+  EXPECT_FALSE(Evaluate(
+      Expressions::And(Expressions::GreaterThan("id", Literal::Int(50)),
+                       Expressions::Equal("data", Literal::String("zzz")))));
+  EXPECT_TRUE(
+      Evaluate(Expressions::Or(Expressions::GreaterThan("id", Literal::Int(100)),
+                               Expressions::Equal("data", Literal::String("baz")))));
+  EXPECT_FALSE(Evaluate(Expressions::Not(Expressions::LessThan("id", Literal::Int(80)))));
+  EXPECT_TRUE(Evaluate(Expressions::Not(Expressions::LessThan("id", Literal::Int(79)))));
+  EXPECT_TRUE(Evaluate(Expressions::AlwaysTrue()));
+  EXPECT_FALSE(Evaluate(Expressions::AlwaysFalse()));
+}
+
+TEST_F(InclusiveMetricsEvaluatorTest, EmptyFileCannotMatch) {
+  file_.record_count = 0;
+  EXPECT_FALSE(Evaluate(Expressions::AlwaysTrue()));
+  EXPECT_FALSE(Evaluate(Expressions::NotNull("id")));
+}
+
+TEST_F(InclusiveMetricsEvaluatorTest, UnknownField) {
+  auto evaluator = InclusiveMetricsEvaluator::Make(
+      Expressions::Equal("unknown", Literal::Int(1)), *schema_);
+  EXPECT_THAT(evaluator, IsError(ErrorKind::kInvalidExpression));
+}
+
+}  // namespace iceberg
@@ -0,0 +1,143 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/fast_append.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/merge_append.h"
+#include "iceberg/rewrite_manifests.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table.h"
+#include "iceberg/table_scan.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/test/table_test_base.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+class IncrementalAppendScanTest : public TableTestBase {
+ protected:
+  static std::shared_ptr<DataFile> MakeDataFile(const std::string& path) {
+    return std::make_shared<DataFile>(DataFile{
+        .file_path = path,
+        .file_format = FileFormatType::kParquet,
+        .record_count = 10,
+        .file_size_in_bytes = 100,
+    });
+  }
+
+  // Appends a file in a new snapshot and returns the id of the snapshot.
+  template <typename Operation>
+  int64_t Append(const std::string& path) {
+    Operation append(table_);
+    append.AppendFile(MakeDataFile(path));
+    EXPECT_THAT(append.Commit(), IsOk());
+    return append.snapshot_id();
+  }
+
+  static std::vector<std::string> ScanPaths(TableScanBuilder& builder) {
+    auto scan = builder.Build();
+    EXPECT_THAT(scan, IsOk());
+    auto tasks = (*scan)->PlanFiles();
+    EXPECT_THAT(tasks, IsOk());
+    std::vector<std::string> paths;
+    for (const auto& task : *tasks) {
+      paths.push_back(task->data_file()->file_path);
+    }
+    std::ranges::sort(paths);
+    return paths;
+  }
+};
+
+TEST_F(IncrementalAppendScanTest, ReadsFilesAppendedAfterStartSnapshot) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable());
+  auto first = Append<FastAppend>("/data/a.parquet");
+  auto second = Append<FastAppend>("/data/b.parquet");
+  auto third = Append<FastAppend>("/data/c.parquet");
+
+  auto builder = table_->NewScan();
+  builder->FromSnapshotExclusive(first).ToSnapshot(third);
+  EXPECT_EQ(ScanPaths(*builder),
+            (std::vector<std::string>{"/data/b.parquet", "/data/c.parquet"}));
+
+  builder = table_->NewScan();
+  builder->FromSnapshotExclusive(first).ToSnapshot(second);
+  EXPECT_EQ(ScanPaths(*builder), std::vector<std::string>{"/data/b.parquet"});
+
+  // The scan ends at the current snapshot by default.
+  builder = table_->NewScan();
+  builder->FromSnapshotExclusive(second);
+  EXPECT_EQ(ScanPaths(*builder), std::vector<std::string>{"/data/c.parquet"});
+
+  builder = table_->NewScan();
+  builder->FromSnapshotExclusive(third);
+  EXPECT_TRUE(ScanPaths(*builder).empty());
+}
+
+TEST_F(IncrementalAppendScanTest, ReadsFilesOfMergedManifests) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable({{"commit.manifest.min-count-to-merge", "2"}}));
+  auto first = Append<MergeAppend>("/data/a.parquet");
+  Append<MergeAppend>("/data/b.parquet");
+  auto third = Append<MergeAppend>("/data/c.parquet");
+
+  // The manifest of the last snapshot has all files, only the ones appended in the
+  // range are read.
+  auto builder = table_->NewScan();
+  builder->FromSnapshotExclusive(first).ToSnapshot(third);
+  EXPECT_EQ(ScanPaths(*builder),
+            (std::vector<std::string>{"/data/b.parquet", "/data/c.parquet"}));
+}
+
+TEST_F(IncrementalAppendScanTest, SkipsSnapshotsOfOtherOperations) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable());
+  auto first = Append<FastAppend>("/data/a.parquet");
+  Append<FastAppend>("/data/b.parquet");
+  RewriteManifests rewrite(table_);
+  ASSERT_THAT(rewrite.Commit(), IsOk());
+  Append<FastAppend>("/data/c.parquet");
+
+  auto builder = table_->NewScan();
+  builder->FromSnapshotExclusive(first);
+  EXPECT_EQ(ScanPaths(*builder),
+            (std::vector<std::string>{"/data/b.parquet", "/data/c.parquet"}));
+}
+
+TEST_F(IncrementalAppendScanTest, StartSnapshotMustBeAncestor) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable());
+  auto first = Append<FastAppend>("/data/a.parquet");
+  auto second = Append<FastAppend>("/data/b.parquet");
+
+  auto builder = table_->NewScan();
+  builder->FromSnapshotExclusive(second).ToSnapshot(first);
+  EXPECT_THAT(builder->Build(), IsError(ErrorKind::kInvalidArgument));
+
+  builder = table_->NewScan();
+  builder->FromSnapshotExclusive(12345);
+  EXPECT_THAT(builder->Build(), IsError(ErrorKind::kInvalidArgument));
+}
+
+}  // namespace iceberg
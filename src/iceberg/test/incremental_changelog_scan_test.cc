@@ -0,0 +1,154 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <format>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/fast_append.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/merge_append.h"
+#include "iceberg/rewrite_manifests.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/table_scan.h"
+#include "iceberg/test/delete_data_files.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/test/table_test_base.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+class IncrementalChangelogScanTest : public TableTestBase {
+ protected:
+  // Appends a file in a new snapshot and returns the id of the snapshot.
+  template <typename Operation>
+  int64_t Append(const std::string& path) {
+    Operation append(table_);
+    append.AppendFile(std::make_shared<DataFile>(DataFile{
+        .file_path = path,
+        .file_format = FileFormatType::kParquet,
+        .record_count = 10,
+        .file_size_in_bytes = 100,
+    }));
+    EXPECT_THAT(append.Commit(), IsOk());
+    return append.snapshot_id();
+  }
+
+  // Removes a file in a new snapshot and returns the id of the snapshot.
+  int64_t Delete(const std::string& path) {
+    DeleteDataFiles delete_files(table_, {path});
+    EXPECT_THAT(delete_files.Commit(), IsOk());
+    return delete_files.snapshot_id();
+  }
+
+  static std::string Change(int32_t change_ordinal, ChangelogOperation operation,
+                            int64_t commit_snapshot_id, const std::string& path) {
+    return std::format("{} {} {} {}", change_ordinal,
+                       operation == ChangelogOperation::kInsert ? "insert" : "delete",
+                       commit_snapshot_id, path);
+  }
+
+  static std::vector<std::string> PlanChanges(TableScanBuilder& builder) {
+    auto scan = builder.BuildChangelog();
+    EXPECT_THAT(scan, IsOk());
+    auto tasks = (*scan)->PlanFiles();
+    EXPECT_THAT(tasks, IsOk());
+    std::vector<std::string> changes;
+    for (const auto& task : *tasks) {
+      changes.push_back(Change(task->change_ordinal(), task->operation(),
+                               task->commit_snapshot_id(),
+                               task->data_file()->file_path));
+    }
+    return changes;
+  }
+};
+
+TEST_F(IncrementalChangelogScanTest, ReportsInsertedAndDeletedFiles) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable());
+  auto first = Append<FastAppend>("/data/a.parquet");
+  auto second = Append<FastAppend>("/data/b.parquet");
+  auto third = Delete("/data/a.parquet");
+  auto fourth = Append<FastAppend>("/data/c.parquet");
+
+  auto builder = table_->NewScan();
+  builder->FromSnapshotExclusive(first).WithPlanningParallelism(4);
+  EXPECT_EQ(PlanChanges(*builder),
+            (std::vector<std::string>{
+                Change(0, ChangelogOperation::kInsert, second, "/data/b.parquet"),
+                Change(1, ChangelogOperation::kDelete, third, "/data/a.parquet"),
+                Change(2, ChangelogOperation::kInsert, fourth, "/data/c.parquet"),
+            }));
+
+  builder = table_->NewScan();
+  builder->FromSnapshotExclusive(second).ToSnapshot(third);
+  EXPECT_EQ(PlanChanges(*builder),
+            std::vector<std::string>{
+                Change(0, ChangelogOperation::kDelete, third, "/data/a.parquet")});
+}
+
+TEST_F(IncrementalChangelogScanTest, ReportsAllSnapshotsWithoutStartSnapshot) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable());
+  auto first = Append<FastAppend>("/data/a.parquet");
+  auto second = Append<FastAppend>("/data/b.parquet");
+
+  auto builder = table_->NewScan();
+  EXPECT_EQ(PlanChanges(*builder),
+            (std::vector<std::string>{
+                Change(0, ChangelogOperation::kInsert, first, "/data/a.parquet"),
+                Change(1, ChangelogOperation::kInsert, second, "/data/b.parquet"),
+            }));
+}
+
+TEST_F(IncrementalChangelogScanTest, SkipsReplacedAndMergedFiles) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable({{"commit.manifest.min-count-to-merge", "2"}}));
+  auto first = Append<MergeAppend>("/data/a.parquet");
+  auto second = Append<MergeAppend>("/data/b.parquet");
+  RewriteManifests rewrite(table_);
+  ASSERT_THAT(rewrite.Commit(), IsOk());
+  auto fourth = Append<MergeAppend>("/data/c.parquet");
+
+  // The merged manifests have the files of older snapshots as existing, and the
+  // rewrite does not change the data of the table.
+  auto builder = table_->NewScan();
+  builder->FromSnapshotExclusive(first);
+  EXPECT_EQ(PlanChanges(*builder),
+            (std::vector<std::string>{
+                Change(0, ChangelogOperation::kInsert, second, "/data/b.parquet"),
+                Change(1, ChangelogOperation::kInsert, fourth, "/data/c.parquet"),
+            }));
+}
+
+TEST_F(IncrementalChangelogScanTest, StartSnapshotMustBeAncestor) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable());
+  auto first = Append<FastAppend>("/data/a.parquet");
+  auto second = Append<FastAppend>("/data/b.parquet");
+
+  auto builder = table_->NewScan();
+  builder->FromSnapshotExclusive(second).ToSnapshot(first);
+  EXPECT_THAT(builder->BuildChangelog(), IsError(ErrorKind::kInvalidArgument));
+}
+
+}  // namespace iceberg
@@ -0,0 +1,174 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/instrumented_file_io.h"
+
+#include <string>
+#include <unordered_map>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/test/matchers.h"
+
+namespace iceberg {
+
+namespace {
+
+using Operation = InstrumentedFileIO::Operation;
+using FileCategory = InstrumentedFileIO::FileCategory;
+
+/// \brief A FileIO of in-memory files.
+class MemoryFileIO : public FileIO {
+ public:
+  Result<std::string> ReadFile(const std::string& file_location,
+                               std::optional<size_t> length) override {
+    auto it = files_.find(file_location);
+    if (it == files_.cend()) {
+      return IOError("File {} does not exist", file_location);
+    }
+    return it->second;
+  }
+
+  Status WriteFile(const std::string& file_location, std::string_view content) override {
+    files_[file_location] = std::string(content);
+    return {};
+  }
+
+  Status DeleteFile(const std::string& file_location) override {
+    if (files_.erase(file_location) == 0) {
+      return IOError("File {} does not exist", file_location);
+    }
+    return {};
+  }
+
+  std::unordered_map<std::string, std::string> files_;
+};
+
+}  // namespace
+
+class InstrumentedFileIOTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    file_io_ = std::make_shared<MemoryFileIO>();
+    ICEBERG_UNWRAP_OR_FAIL(io_, InstrumentedFileIO::Make(file_io_));
+  }
+
+  std::shared_ptr<MemoryFileIO> file_io_;
+  std::shared_ptr<InstrumentedFileIO> io_;
+};
+
+TEST_F(InstrumentedFileIOTest, ClassifyFile) {
+  EXPECT_EQ(InstrumentedFileIO::ClassifyFile("s3://b/t/metadata/00001-a.metadata.json"),
+            FileCategory::kMetadata);
+  EXPECT_EQ(InstrumentedFileIO::ClassifyFile("s3://b/t/metadata/version-hint.text"),
+            FileCategory::kMetadata);
+  EXPECT_EQ(InstrumentedFileIO::ClassifyFile("s3://b/t/metadata/snap-1-1-a.avro"),
+            FileCategory::kManifestList);
+  EXPECT_EQ(InstrumentedFileIO::ClassifyFile("s3://b/t/metadata/a-m0.avro"),
+            FileCategory::kManifest);
+  EXPECT_EQ(InstrumentedFileIO::ClassifyFile("s3://b/t/data/00000-a.parquet"),
+            FileCategory::kData);
+  EXPECT_EQ(InstrumentedFileIO::ClassifyFile("s3://b/t/data/00000-a-deletes.parquet"),
+            FileCategory::kDelete);
+  EXPECT_EQ(InstrumentedFileIO::ClassifyFile("s3://b/t/data/dv-a.puffin"),
+            FileCategory::kDelete);
+  EXPECT_EQ(InstrumentedFileIO::ClassifyFile("s3://b/t/data"), FileCategory::kOther);
+}
+
+TEST_F(InstrumentedFileIOTest, CountsRequestsAndBytes) {
+  ASSERT_THAT(io_->WriteFile("v1.metadata.json", "{}"), IsOk());
+  ASSERT_THAT(io_->WriteFile("snap-1.avro", "list"), IsOk());
+  EXPECT_THAT(io_->ReadFile("v1.metadata.json", std::nullopt), IsOk());
+  EXPECT_THAT(io_->ReadFile("v1.metadata.json", std::nullopt), IsOk());
+  EXPECT_THAT(io_->ReadFile("v2.metadata.json", std::nullopt),
+              IsError(ErrorKind::kIOError));
+
+  ICEBERG_UNWRAP_OR_FAIL(auto input, io_->NewInputFile("snap-1.avro", std::nullopt));
+  std::string buffer(3, '\0');
+  EXPECT_THAT(input->ReadAt(1, {reinterpret_cast<uint8_t*>(buffer.data()), 3}),
+              HasValue(::testing::Eq(3)));
+  EXPECT_EQ(buffer, "ist");
+
+  ICEBERG_UNWRAP_OR_FAIL(auto output, io_->NewOutputFile("00000-a.parquet"));
+  ASSERT_THAT(output->Write("abcd"), IsOk());
+  ASSERT_THAT(output->Write("ef"), IsOk());
+  ASSERT_THAT(output->Close(), IsOk());
+  EXPECT_EQ(file_io_->files_["00000-a.parquet"], "abcdef");
+
+  auto stats = io_->stats();
+  const auto& metadata_reads = stats.Get(Operation::kRead, FileCategory::kMetadata);
+  EXPECT_EQ(metadata_reads.requests, 3);
+  EXPECT_EQ(metadata_reads.errors, 1);
+  EXPECT_EQ(metadata_reads.bytes, 4);
+  EXPECT_EQ(stats.Get(Operation::kRead, FileCategory::kManifestList).bytes, 3);
+  EXPECT_EQ(stats.Get(Operation::kOpen, FileCategory::kManifestList).requests, 1);
+  EXPECT_EQ(stats.Get(Operation::kWrite, FileCategory::kData).requests, 2);
+  EXPECT_EQ(stats.Get(Operation::kWrite, FileCategory::kData).bytes, 6);
+  EXPECT_EQ(stats.Total(Operation::kWrite).requests, 4);
+  EXPECT_EQ(stats.Total(Operation::kRead).requests, 4);
+  EXPECT_EQ(stats.latencies[static_cast<size_t>(Operation::kRead)].count, 4);
+
+  io_->ResetStats();
+  EXPECT_EQ(io_->stats().Total(Operation::kRead).requests, 0);
+}
+
+TEST_F(InstrumentedFileIOTest, DeleteFiles) {
+  file_io_->files_ = {{"a.parquet", "a"}, {"b-deletes.parquet", "b"}};
+  std::vector<std::string> locations = {"a.parquet", "b-deletes.parquet", "c.parquet"};
+  EXPECT_EQ(io_->DeleteFiles(locations).size(), 1);
+
+  auto stats = io_->stats();
+  EXPECT_EQ(stats.Get(Operation::kDelete, FileCategory::kData).requests, 2);
+  EXPECT_EQ(stats.Get(Operation::kDelete, FileCategory::kData).errors, 1);
+  EXPECT_EQ(stats.Get(Operation::kDelete, FileCategory::kDelete).requests, 1);
+  EXPECT_EQ(stats.Get(Operation::kDelete, FileCategory::kDelete).errors, 0);
+  EXPECT_EQ(stats.latencies[static_cast<size_t>(Operation::kDelete)].count, 1);
+}
+
+TEST_F(InstrumentedFileIOTest, CustomClassifier) {
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto io, InstrumentedFileIO::Make(
+                   file_io_, {.classifier = [](std::string_view) {
+                     return FileCategory::kData;
+                   }}));
+  ASSERT_THAT(io->WriteFile("v1.metadata.json", "{}"), IsOk());
+  EXPECT_EQ(io->stats().Get(Operation::kWrite, FileCategory::kData).requests, 1);
+  EXPECT_THAT(InstrumentedFileIO::Make(nullptr), IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(InstrumentedFileIOTest, ToPrometheus) {
+  ASSERT_THAT(io_->WriteFile("v1.metadata.json", "{}"), IsOk());
+  const auto text = io_->stats().ToPrometheus();
+  EXPECT_THAT(text,
+              ::testing::HasSubstr("# TYPE iceberg_file_io_requests_total counter"));
+  EXPECT_THAT(text, ::testing::HasSubstr(
+                        "iceberg_file_io_requests_total{operation=\"write\","
+                        "category=\"metadata\"} 1\n"));
+  EXPECT_THAT(text, ::testing::HasSubstr(
+                        "iceberg_file_io_bytes_total{operation=\"write\","
+                        "category=\"metadata\"} 2\n"));
+  EXPECT_THAT(text, ::testing::HasSubstr("iceberg_file_io_latency_seconds_bucket{"
+                                         "operation=\"write\",le=\"+Inf\"} 1\n"));
+  EXPECT_THAT(text, ::testing::HasSubstr(
+                        "iceberg_file_io_latency_seconds_bucket{operation=\"read\","
+                        "le=\"0.0001\"} 0\n"));
+}
+
+}  // namespace iceberg
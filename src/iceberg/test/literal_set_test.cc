@@ -0,0 +1,122 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/expression/literal_set.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/util/uuid.h"
+
+namespace iceberg {
+
+TEST(LiteralSetTest, IntegerSet) {
+  std::vector<Literal::Value> values;
+  for (int64_t i = 0; i < 5000; ++i) {
+    values.emplace_back(i * 3);
+  }
+  values.emplace_back(std::numeric_limits<int64_t>::min());
+  values.emplace_back(int64_t{3});
+  LiteralSet set(values);
+
+  ASSERT_EQ(set.index_kind(), LiteralSet::IndexKind::kInteger);
+  EXPECT_EQ(set.size(), values.size());
+  EXPECT_TRUE(set.Contains(Literal::Value{int64_t{3}}));
+  EXPECT_FALSE(set.Contains(Literal::Value{int64_t{4}}));
+  EXPECT_FALSE(set.Contains(Literal::Value{std::monostate{}}));
+  EXPECT_TRUE(set.ContainsKey(std::numeric_limits<int64_t>::min()));
+  EXPECT_TRUE(set.ContainsKey(int64_t{14997}));
+  EXPECT_FALSE(set.ContainsKey(int64_t{15000}));
+
+  std::vector<int64_t> keys = {0,  1,     2,
+                               3,  -3,    14997,
+                               std::numeric_limits<int64_t>::min()};
+  std::vector<uint8_t> matches(keys.size());
+  set.ContainsKeys(keys, matches);
+  EXPECT_THAT(matches, ::testing::ElementsAre(1, 0, 0, 1, 0, 1, 1));
+
+  ASSERT_NE(set.min(), nullptr);
+  ASSERT_NE(set.max(), nullptr);
+  EXPECT_EQ(*set.min(), Literal::Value{std::numeric_limits<int64_t>::min()});
+  EXPECT_EQ(*set.max(), Literal::Value{int64_t{14997}});
+}
+
+TEST(LiteralSetTest, StringSet) {
+  LiteralSet set(std::vector<Literal::Value>{std::string("banana"),
+                                             std::string("apple"),
+                                             std::string("cherry")});
+
+  ASSERT_EQ(set.index_kind(), LiteralSet::IndexKind::kBinary);
+  EXPECT_TRUE(set.Contains(Literal::Value{std::string("apple")}));
+  EXPECT_FALSE(set.Contains(Literal::Value{std::string("apricot")}));
+
+  std::vector<std::string_view> keys = {"cherry", "", "banana", "bananas"};
+  std::vector<uint8_t> matches(keys.size());
+  set.ContainsKeys(keys, matches);
+  EXPECT_THAT(matches, ::testing::ElementsAre(1, 0, 1, 0));
+
+  EXPECT_EQ(*set.min(), Literal::Value{std::string("apple")});
+  EXPECT_EQ(*set.max(), Literal::Value{std::string("cherry")});
+
+  // Copies share the indexed values.
+  LiteralSet copy = set;
+  EXPECT_TRUE(copy.ContainsKey(std::string_view("banana")));
+}
+
+TEST(LiteralSetTest, FloatingPointSet) {
+  LiteralSet set(std::vector<Literal::Value>{
+      -0.0, 1.5, std::numeric_limits<double>::quiet_NaN()});
+
+  EXPECT_EQ(set.index_kind(), LiteralSet::IndexKind::kNone);
+  EXPECT_TRUE(set.Contains(Literal::Value{1.5}));
+  // Values compare like Literal, so 0.0 differs from -0.0 and NaN matches NaN.
+  EXPECT_TRUE(set.Contains(Literal::Value{-0.0}));
+  EXPECT_FALSE(set.Contains(Literal::Value{0.0}));
+  EXPECT_TRUE(set.Contains(Literal::Value{std::numeric_limits<double>::quiet_NaN()}));
+
+  EXPECT_EQ(std::get<double>(*set.min()), -0.0);
+  EXPECT_TRUE(std::isnan(std::get<double>(*set.max())));
+}
+
+TEST(LiteralSetTest, UnorderedSet) {
+  auto uuid = Uuid::GenerateV4();
+  LiteralSet set(std::vector<Literal::Value>{uuid});
+
+  EXPECT_EQ(set.index_kind(), LiteralSet::IndexKind::kNone);
+  EXPECT_TRUE(set.Contains(Literal::Value{uuid}));
+  EXPECT_FALSE(set.Contains(Literal::Value{Uuid::GenerateV4()}));
+  EXPECT_EQ(set.min(), nullptr);
+  EXPECT_EQ(set.max(), nullptr);
+}
+
+TEST(LiteralSetTest, EmptySet) {
+  LiteralSet set;
+  EXPECT_TRUE(set.empty());
+  EXPECT_FALSE(set.Contains(Literal::Value{int32_t{1}}));
+  EXPECT_EQ(set.min(), nullptr);
+}
+
+}  // namespace iceberg
@@ -21,6 +21,7 @@
 
 #include <limits>
 #include <numbers>
+#include <string_view>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -28,6 +29,7 @@
 #include "iceberg/test/matchers.h"
 #include "iceberg/test/temporal_test_helper.h"
 #include "iceberg/type.h"
+#include "iceberg/util/conversions.h"
 
 namespace iceberg {
 
@@ -495,6 +497,73 @@ TEST(LiteralSerDeTest, TypePromotion) {
   EXPECT_EQ(double_result->type()->type_id(), TypeId::kDouble);
   EXPECT_DOUBLE_EQ(std::get<double>(double_result->value()), 1.0);
 }
+
+TEST(LiteralSerDeTest, CompareWithSerializedScalar) {
+  for (const auto& literal :
+       {Literal::Int(-5), Literal::Long(1L << 40), Literal::Double(2.5),
+        Literal::String("banana"), Literal::Binary({0x01, 0xFF}),
+        Literal::Decimal(12345, 9, 2), Literal::Date(19724)}) {
+    ICEBERG_UNWRAP_OR_FAIL(auto bytes, literal.Serialize());
+    ICEBERG_UNWRAP_OR_FAIL(auto scalar,
+                           Conversions::ScalarFromBytes(*literal.type(), bytes));
+    EXPECT_EQ(literal.Compare(scalar), std::partial_ordering::equivalent)
+        << literal.ToString();
+  }
+
+  // String and binary scalars are views of the serialized bytes.
+  std::vector<uint8_t> bytes = {'b', 'a', 'n'};
+  ICEBERG_UNWRAP_OR_FAIL(auto view, Conversions::ScalarFromBytes(*string(), bytes));
+  EXPECT_EQ(std::get<std::string_view>(view).data(),
+            reinterpret_cast<const char*>(bytes.data()));
+  EXPECT_EQ(Literal::String("banana").Compare(view), std::partial_ordering::greater);
+  EXPECT_EQ(Literal::String("apple").Compare(view), std::partial_ordering::less);
+
+  // Bytes compare unsigned, like binary literals.
+  std::vector<uint8_t> high = {0x80};
+  ICEBERG_UNWRAP_OR_FAIL(auto high_view, Conversions::ScalarFromBytes(*binary(), high));
+  EXPECT_EQ(Literal::Binary({0x7F}).Compare(high_view), std::partial_ordering::less);
+
+  auto uuid = Uuid::FromString("123e4567-e89b-12d3-a456-426614174000").value();
+  std::vector<uint8_t> uuid_bytes(uuid.bytes().begin(), uuid.bytes().end());
+  ICEBERG_UNWRAP_OR_FAIL(auto uuid_view,
+                         Conversions::ScalarFromBytes(*iceberg::uuid(), uuid_bytes));
+  EXPECT_EQ(Literal::UUID(uuid).Compare(uuid_view), std::partial_ordering::equivalent);
+
+  EXPECT_EQ(Literal::Null(int32()).Compare(Scalar{int32_t{1}}),
+            std::partial_ordering::unordered);
+  EXPECT_EQ(Literal::Int(1).Compare(Scalar{int64_t{1}}),
+            std::partial_ordering::unordered);
+  EXPECT_THAT(Conversions::ScalarFromBytes(*iceberg::uuid(), high),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST(LiteralSerDeTest, CompareSerializedValues) {
+  // Serialized values compare like the literals they hold.
+  auto expect_order = [](const Literal& lhs, const Literal& rhs) {
+    ICEBERG_UNWRAP_OR_FAIL(auto lhs_bytes, lhs.Serialize());
+    ICEBERG_UNWRAP_OR_FAIL(auto rhs_bytes, rhs.Serialize());
+    ICEBERG_UNWRAP_OR_FAIL(auto cmp,
+                           Conversions::CompareBytes(*lhs.type(), lhs_bytes, rhs_bytes));
+    EXPECT_EQ(cmp, lhs <=> rhs) << lhs.ToString() << " vs " << rhs.ToString();
+  };
+  expect_order(Literal::Int(-1), Literal::Int(256));
+  expect_order(Literal::Long(1L << 40), Literal::Long(-(1L << 40)));
+  expect_order(Literal::Float(-0.0f), Literal::Float(0.0f));
+  expect_order(Literal::Double(std::numeric_limits<double>::quiet_NaN()),
+               Literal::Double(1.0));
+  expect_order(Literal::Decimal(-100, 9, 2), Literal::Decimal(5, 9, 2));
+  expect_order(Literal::String("apple"), Literal::String("apricot"));
+  expect_order(Literal::Binary({0x80}), Literal::Binary({0x7F, 0xFF}));
+  expect_order(Literal::Boolean(true), Literal::Boolean(true));
+
+  // Ints written before a promotion to long compare with longs.
+  std::vector<uint8_t> int_bytes = {1, 0, 0, 0};
+  std::vector<uint8_t> long_bytes = {2, 0, 0, 0, 0, 0, 0, 0};
+  EXPECT_THAT(Conversions::CompareBytes(*int64(), int_bytes, long_bytes),
+              HasValue(::testing::Eq(std::partial_ordering::less)));
+  EXPECT_THAT(Conversions::CompareBytes(*int32(), int_bytes, long_bytes),
+              IsError(ErrorKind::kInvalidArgument));
+}
 // Instantiate parameterized tests
 
 INSTANTIATE_TEST_SUITE_P(
@@ -0,0 +1,148 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/location_provider.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/partition_field.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/row/struct_like.h"
+#include "iceberg/schema.h"
+#include "iceberg/schema_field.h"
+#include "iceberg/table_properties.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/transform.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+namespace {
+
+class ScalarStructLike : public StructLike {
+ public:
+  explicit ScalarStructLike(std::vector<Scalar> values) : values_(std::move(values)) {}
+
+  Result<Scalar> GetField(size_t pos) const override { return values_.at(pos); }
+
+  size_t num_fields() const override { return values_.size(); }
+
+ private:
+  std::vector<Scalar> values_;
+};
+
+std::unique_ptr<LocationProvider> MakeProvider(
+    const std::unordered_map<std::string, std::string>& properties) {
+  return LocationProvider::Make("s3://bucket/db/table/",
+                                *TableProperties::FromMap(properties));
+}
+
+}  // namespace
+
+class LocationProviderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    auto schema = std::make_shared<Schema>(
+        std::vector<SchemaField>{SchemaField::MakeOptional(1, "category", string()),
+                                 SchemaField::MakeOptional(2, "ts", timestamp()),
+                                 SchemaField::MakeOptional(3, "id", int64())},
+        /*schema_id=*/0);
+    spec_ = std::make_shared<PartitionSpec>(
+        schema, /*spec_id=*/1,
+        std::vector<PartitionField>{
+            PartitionField(1, 1000, "category", Transform::Identity()),
+            PartitionField(2, 1001, "ts_hour", Transform::Hour()),
+            PartitionField(3, 1002, "id_bucket", Transform::Bucket(16))});
+  }
+
+  std::shared_ptr<PartitionSpec> spec_;
+};
+
+TEST_F(LocationProviderTest, PartitionPath) {
+  // 2024-01-02 10:00 is hour 473386 since the epoch.
+  ScalarStructLike partition({std::string_view("a b/c"), 473386, 7});
+  EXPECT_THAT(
+      spec_->PartitionPath(partition),
+      HasValue(::testing::Eq("category=a+b%2Fc/ts_hour=2024-01-02-10/id_bucket=7")));
+
+  ScalarStructLike nulls({std::monostate{}, -1, std::monostate{}});
+  EXPECT_THAT(
+      spec_->PartitionPath(nulls),
+      HasValue(::testing::Eq("category=null/ts_hour=1969-12-31-23/id_bucket=null")));
+
+  EXPECT_THAT(spec_->PartitionPath(ScalarStructLike({std::monostate{}})),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(LocationProviderTest, DefaultLocations) {
+  auto provider = MakeProvider({});
+  EXPECT_THAT(provider->NewDataLocation("file.parquet"),
+              HasValue(::testing::Eq("s3://bucket/db/table/data/file.parquet")));
+  ScalarStructLike partition({std::string_view("x"), 0, 1});
+  EXPECT_THAT(provider->NewDataLocation(*spec_, partition, "file.parquet"),
+              HasValue(::testing::Eq("s3://bucket/db/table/data/category=x/"
+                                     "ts_hour=1970-01-01-00/id_bucket=1/file.parquet")));
+
+  provider = MakeProvider({{"write.data.path", "s3://other/data/"}});
+  EXPECT_THAT(provider->NewDataLocation("file.parquet"),
+              HasValue(::testing::Eq("s3://other/data/file.parquet")));
+}
+
+TEST_F(LocationProviderTest, ObjectStoreLocations) {
+  auto provider = MakeProvider({{"write.object-storage.enabled", "true"}});
+  ICEBERG_UNWRAP_OR_FAIL(auto location, provider->NewDataLocation("a"));
+  EXPECT_EQ(location, "s3://bucket/db/table/data/0101/0110/1001/10110010/a");
+
+  // Files with different names are spread over different prefixes.
+  ICEBERG_UNWRAP_OR_FAIL(auto other, provider->NewDataLocation("b"));
+  EXPECT_THAT(other, ::testing::MatchesRegex(
+                         "s3://bucket/db/table/data/[01]{4}/[01]{4}/[01]{4}/[01]{8}/b"));
+  EXPECT_NE(other.substr(0, other.size() - 1), location.substr(0, location.size() - 1));
+
+  // Partition directories follow the entropy, which is computed on them too.
+  ScalarStructLike partition({std::string_view("x"), 0, 1});
+  ICEBERG_UNWRAP_OR_FAIL(auto partitioned,
+                         provider->NewDataLocation(*spec_, partition, "file.parquet"));
+  EXPECT_THAT(partitioned,
+              ::testing::MatchesRegex("s3://bucket/db/table/data/[01]{4}/[01]{4}/[01]{4}/"
+                                      "[01]{8}/category=x/ts_hour=1970-01-01-00/"
+                                      "id_bucket=1/file.parquet"));
+
+  provider = MakeProvider({{"write.object-storage.enabled", "true"},
+                           {"write.object-storage.partitioned-paths", "false"}});
+  ICEBERG_UNWRAP_OR_FAIL(auto flat,
+                         provider->NewDataLocation(*spec_, partition, "file.parquet"));
+  EXPECT_THAT(flat, ::testing::MatchesRegex(
+                        "s3://bucket/db/table/data/[01]{4}/[01]{4}/[01]{4}/[01]{8}-"
+                        "file.parquet"));
+
+  // Tables that share a data location are told apart by their location.
+  provider = MakeProvider({{"write.object-storage.enabled", "true"},
+                           {"write.data.path", "s3://shared/data"}});
+  ICEBERG_UNWRAP_OR_FAIL(auto shared, provider->NewDataLocation("a"));
+  EXPECT_EQ(shared, "s3://shared/data/0101/0110/1001/10110010/db/table/a");
+}
+
+}  // namespace iceberg
@@ -0,0 +1,149 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/manifest_cache.h"
+
+#include <format>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/test/matchers.h"
+
+namespace iceberg {
+
+namespace {
+
+ManifestFile MakeManifest(const std::string& path, int64_t sequence_number = 1) {
+  return ManifestFile{.manifest_path = path,
+                      .sequence_number = sequence_number,
+                      .added_snapshot_id = 1000};
+}
+
+std::vector<ManifestEntry> MakeEntries(int32_t count) {
+  std::vector<ManifestEntry> entries(count);
+  for (int32_t i = 0; i < count; ++i) {
+    entries[i].data_file = std::make_shared<DataFile>();
+    entries[i].data_file->file_path = std::format("data-{}.parquet", i);
+  }
+  return entries;
+}
+
+}  // namespace
+
+TEST(ManifestCacheTest, InvalidCapacity) {
+  EXPECT_THAT(ManifestCache::Make(0), IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(ManifestCache::Make(-1), IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST(ManifestCacheTest, CacheEntries) {
+  auto cache = ManifestCache::Make(1 << 20).value();
+  auto manifest = MakeManifest("manifest.avro");
+  EXPECT_EQ(cache->GetEntries(manifest), nullptr);
+
+  cache->PutEntries(manifest, MakeEntries(3));
+  auto entries = cache->GetEntries(manifest);
+  ASSERT_NE(entries, nullptr);
+  ASSERT_EQ(entries->size(), 3);
+  EXPECT_EQ((*entries)[2].data_file->file_path, "data-2.parquet");
+
+  // The inherited metadata is part of the key.
+  EXPECT_EQ(cache->GetEntries(MakeManifest("manifest.avro", 2)), nullptr);
+  // Manifests and manifest lists do not share keys.
+  EXPECT_EQ(cache->GetManifestFiles("manifest.avro"), nullptr);
+
+  auto stats = cache->stats();
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 3);
+  EXPECT_EQ(stats.file_count, 1);
+  EXPECT_GT(stats.size_bytes, 0);
+}
+
+TEST(ManifestCacheTest, CacheManifestFiles) {
+  auto cache = ManifestCache::Make(1 << 20).value();
+  cache->PutManifestFiles("snap-1.avro",
+                          {MakeManifest("a.avro"), MakeManifest("b.avro")});
+  auto files = cache->GetManifestFiles("snap-1.avro");
+  ASSERT_NE(files, nullptr);
+  ASSERT_EQ(files->size(), 2);
+  EXPECT_EQ((*files)[1].manifest_path, "b.avro");
+  EXPECT_EQ(cache->GetManifestFiles("snap-2.avro"), nullptr);
+}
+
+TEST(ManifestCacheTest, EvictLeastRecentlyUsed) {
+  // Measure the size of a manifest, then make room for two of them.
+  auto probe = ManifestCache::Make(1 << 20).value();
+  probe->PutEntries(MakeManifest("probe.avro"), MakeEntries(10));
+  const int64_t manifest_size = probe->stats().size_bytes;
+
+  auto cache = ManifestCache::Make(2 * manifest_size + 1).value();
+  auto a = MakeManifest("a.avro");
+  auto b = MakeManifest("b.avro");
+  auto c = MakeManifest("c.avro");
+  cache->PutEntries(a, MakeEntries(10));
+  cache->PutEntries(b, MakeEntries(10));
+  ASSERT_NE(cache->GetEntries(a), nullptr);
+
+  // b is the least recently used manifest.
+  cache->PutEntries(c, MakeEntries(10));
+  EXPECT_NE(cache->GetEntries(a), nullptr);
+  EXPECT_EQ(cache->GetEntries(b), nullptr);
+  EXPECT_NE(cache->GetEntries(c), nullptr);
+
+  auto stats = cache->stats();
+  EXPECT_EQ(stats.evictions, 1);
+  EXPECT_EQ(stats.file_count, 2);
+  EXPECT_EQ(stats.size_bytes, 2 * manifest_size);
+}
+
+TEST(ManifestCacheTest, SkipFilesLargerThanCapacity) {
+  auto cache = ManifestCache::Make(1).value();
+  auto manifest = MakeManifest("manifest.avro");
+  cache->PutEntries(manifest, MakeEntries(1));
+  EXPECT_EQ(cache->GetEntries(manifest), nullptr);
+  EXPECT_EQ(cache->stats().file_count, 0);
+  EXPECT_EQ(cache->stats().evictions, 0);
+}
+
+TEST(ManifestCacheTest, ReplaceAndClear) {
+  auto cache = ManifestCache::Make(1 << 20).value();
+  auto manifest = MakeManifest("manifest.avro");
+  cache->PutEntries(manifest, MakeEntries(1));
+  cache->PutEntries(manifest, MakeEntries(2));
+  ASSERT_NE(cache->GetEntries(manifest), nullptr);
+  EXPECT_EQ(cache->GetEntries(manifest)->size(), 2);
+  EXPECT_EQ(cache->stats().file_count, 1);
+
+  cache->Clear();
+  EXPECT_EQ(cache->GetEntries(manifest), nullptr);
+  EXPECT_EQ(cache->stats().file_count, 0);
+  EXPECT_EQ(cache->stats().size_bytes, 0);
+}
+
+TEST(ManifestCacheTest, GlobalCache) {
+  EXPECT_EQ(ManifestCache::Global(), nullptr);
+  auto cache = ManifestCache::Make(1 << 20).value();
+  ManifestCache::SetGlobal(cache);
+  EXPECT_EQ(ManifestCache::Global(), cache);
+  ManifestCache::SetGlobal(nullptr);
+  EXPECT_EQ(ManifestCache::Global(), nullptr);
+}
+
+}  // namespace iceberg
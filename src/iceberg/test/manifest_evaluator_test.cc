@@ -0,0 +1,204 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/expression/manifest_evaluator.h"
+
+#include <gtest/gtest.h>
+
+#include "iceberg/expression/expressions.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/partition_field.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/transform.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+class ManifestEvaluatorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    schema_ = std::make_shared<Schema>(
+        std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32()),
+                                 SchemaField::MakeOptional(2, "data", string()),
+                                 SchemaField::MakeOptional(3, "category", string()),
+                                 SchemaField::MakeOptional(4, "ts", timestamp())},
+        /*schema_id=*/0);
+    spec_ = std::make_shared<PartitionSpec>(
+        schema_, /*spec_id=*/1,
+        std::vector<PartitionField>{
+            PartitionField(1, 1000, "id", Transform::Identity()),
+            PartitionField(2, 1001, "data_bucket", Transform::Bucket(16)),
+            PartitionField(3, 1002, "category", Transform::Identity()),
+            PartitionField(4, 1003, "ts_day", Transform::Day())});
+
+    // id in [30, 79], data buckets in [0, 7], category in ["bar", "foo"] with nulls,
+    // ts days in [19723, 19725] (2024-01-01 to 2024-01-03).
+    manifest_.partitions = {
+        Summary(/*contains_null=*/false, Literal::Int(30), Literal::Int(79)),
+        Summary(/*contains_null=*/false, Literal::Int(0), Literal::Int(7)),
+        Summary(/*contains_null=*/true, Literal::String("bar"), Literal::String("foo")),
+        Summary(/*contains_null=*/false, Literal::Int(19723), Literal::Int(19725)),
+    };
+  }
+
+  static PartitionFieldSummary Summary(bool contains_null, const Literal& lower,
+                                       const Literal& upper) {
+    return PartitionFieldSummary{.contains_null = contains_null,
+                                 .contains_nan = false,
+                                 .lower_bound = lower.Serialize().value(),
+                                 .upper_bound = upper.Serialize().value()};
+  }
+
+  bool Evaluate(const std::shared_ptr<Expression>& expr) {
+    auto evaluator = ManifestEvaluator::MakeRowFilter(expr, spec_);
+    EXPECT_THAT(evaluator, IsOk());
+    auto result = (*evaluator)->Evaluate(manifest_);
+    EXPECT_THAT(result, IsOk());
+    return result.value();
+  }
+
+  std::shared_ptr<Schema> schema_;
+  std::shared_ptr<PartitionSpec> spec_;
+  ManifestFile manifest_;
+};
+
+TEST_F(ManifestEvaluatorTest, Comparison) {
+  EXPECT_FALSE(Evaluate(Expressions::LessThan("id", Literal::Int(30))));
+  EXPECT_TRUE(Evaluate(Expressions::LessThan("id", Literal::Int(31))));
+  EXPECT_FALSE(Evaluate(Expressions::LessThanOrEqual("id", Literal::Int(29))));
+  EXPECT_TRUE(Evaluate(Expressions::LessThanOrEqual("id", Literal::Int(30))));
+  EXPECT_FALSE(Evaluate(Expressions::GreaterThan("id", Literal::Int(79))));
+  EXPECT_TRUE(Evaluate(Expressions::GreaterThan("id", Literal::Int(78))));
+  EXPECT_FALSE(Evaluate(Expressions::GreaterThanOrEqual("id", Literal::Int(80))));
+  EXPECT_TRUE(Evaluate(Expressions::GreaterThanOrEqual("id", Literal::Int(79))));
+  EXPECT_FALSE(Evaluate(Expressions::Equal("id", Literal::Int(80))));
+  EXPECT_TRUE(Evaluate(Expressions::Equal("id", Literal::Int(50))));
+  EXPECT_TRUE(Evaluate(Expressions::NotEqual("id", Literal::Int(50))));
+}
+
+TEST_F(ManifestEvaluatorTest, NullChecks) {
+  EXPECT_FALSE(Evaluate(Expressions::IsNull("data")));
+  EXPECT_TRUE(Evaluate(Expressions::IsNull("category")));
+  EXPECT_TRUE(Evaluate(Expressions::NotNull("category")));
+}
+
+TEST_F(ManifestEvaluatorTest, AllNullSummaries) {
+  auto schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeOptional(5, "count", int32()),
+                               SchemaField::MakeOptional(6, "score", float64())},
+      /*schema_id=*/0);
+  auto spec = std::make_shared<PartitionSpec>(
+      schema, /*spec_id=*/1,
+      std::vector<PartitionField>{
+          PartitionField(5, 1000, "count", Transform::Identity()),
+          PartitionField(6, 1001, "score", Transform::Identity())});
+  // Writers may leave contains_nan unset for fields that cannot hold NaN.
+  ManifestFile manifest;
+  manifest.partitions = {
+      PartitionFieldSummary{.contains_null = true, .contains_nan = std::nullopt},
+      PartitionFieldSummary{.contains_null = true, .contains_nan = std::nullopt},
+  };
+  auto evaluate = [&](const std::shared_ptr<Expression>& expr) {
+    auto evaluator = ManifestEvaluator::MakeRowFilter(expr, spec);
+    EXPECT_THAT(evaluator, IsOk());
+    auto result = (*evaluator)->Evaluate(manifest);
+    EXPECT_THAT(result, IsOk());
+    return result.value();
+  };
+
+  EXPECT_FALSE(evaluate(Expressions::NotNull("count")));
+  EXPECT_TRUE(evaluate(Expressions::IsNull("count")));
+  // A double field without bounds may hold NaN values unless contains_nan says not.
+  EXPECT_TRUE(evaluate(Expressions::NotNull("score")));
+  manifest.partitions[1].contains_nan = false;
+  EXPECT_FALSE(evaluate(Expressions::NotNull("score")));
+}
+
+TEST_F(ManifestEvaluatorTest, SetPredicates) {
+  EXPECT_FALSE(Evaluate(Expressions::In("id", {Literal::Int(1), Literal::Int(100)})));
+  EXPECT_TRUE(Evaluate(Expressions::In("id", {Literal::Int(1), Literal::Int(50)})));
+  EXPECT_TRUE(Evaluate(Expressions::NotIn("id", {Literal::Int(1), Literal::Int(50)})));
+}
+
+TEST_F(ManifestEvaluatorTest, StartsWith) {
+  EXPECT_FALSE(Evaluate(Expressions::StartsWith("category", "a")));
+  EXPECT_TRUE(Evaluate(Expressions::StartsWith("category", "ba")));
+  EXPECT_TRUE(Evaluate(Expressions::StartsWith("category", "c")));
+  EXPECT_FALSE(Evaluate(Expressions::StartsWith("category", "g")));
+}
+
+TEST_F(ManifestEvaluatorTest, BucketProjection) {
+  auto bucket = Transform::Bucket(16)->Bind(string()).value();
+  for (const auto* value : {"a", "b", "c", "d", "e", "f", "g", "h"}) {
+    auto bucket_value = bucket->Transform(Literal::String(value)).value();
+    auto expected = std::get<int32_t>(bucket_value.value()) <= 7;
+    EXPECT_EQ(Evaluate(Expressions::Equal("data", Literal::String(value))), expected)
+        << value;
+  }
+}
+
+TEST_F(ManifestEvaluatorTest, TemporalProjection) {
+  // 2024-01-04T00:00:00 and 2023-12-31T23:59:59.999999
+  constexpr int64_t kJan4 = 1704326400000000L;
+  constexpr int64_t kDec31 = 1704067199999999L;
+  EXPECT_FALSE(
+      Evaluate(Expressions::GreaterThanOrEqual("ts", Literal::Timestamp(kJan4))));
+  EXPECT_TRUE(
+      Evaluate(Expressions::GreaterThanOrEqual("ts", Literal::Timestamp(kJan4 - 1))));
+  EXPECT_FALSE(Evaluate(Expressions::LessThanOrEqual("ts", Literal::Timestamp(kDec31))));
+  EXPECT_FALSE(Evaluate(Expressions::LessThan("ts", Literal::Timestamp(kDec31 + 1))));
+  EXPECT_TRUE(Evaluate(Expressions::LessThan("ts", Literal::Timestamp(kDec31 + 2))));
+}
+
+TEST_F(ManifestEvaluatorTest, LogicalExpressions) {
+  auto id_out_of_range = Expressions::Equal("id", Literal::Int(100));
+  auto id_in_range = Expressions::Equal("id", Literal::Int(50));
+
+  EXPECT_FALSE(Evaluate(Expressions::And(id_in_range, id_out_of_range)));
+  EXPECT_TRUE(Evaluate(Expressions::Or(id_in_range, id_out_of_range)));
+  // not(id >= 30) is rewritten to id < 30
+  EXPECT_FALSE(Evaluate(
+      Expressions::Not(Expressions::GreaterThanOrEqual("id", Literal::Int(30)))));
+}
+
+TEST_F(ManifestEvaluatorTest, UnpartitionedColumnsMightMatch) {
+  auto schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32()),
+                               SchemaField::MakeOptional(5, "other", int64())},
+      /*schema_id=*/0);
+  auto spec = std::make_shared<PartitionSpec>(
+      schema, /*spec_id=*/1,
+      std::vector<PartitionField>{PartitionField(1, 1000, "id", Transform::Identity())});
+  auto evaluator = ManifestEvaluator::MakeRowFilter(
+      Expressions::Equal("other", Literal::Long(1)), spec);
+  ASSERT_THAT(evaluator, IsOk());
+  EXPECT_THAT((*evaluator)->Evaluate(manifest_), HasValue(::testing::Eq(true)));
+}
+
+TEST_F(ManifestEvaluatorTest, ManifestWithoutSummaries) {
+  ManifestFile manifest;
+  auto evaluator = ManifestEvaluator::MakeRowFilter(
+      Expressions::Equal("id", Literal::Int(100)), spec_);
+  ASSERT_THAT(evaluator, IsOk());
+  EXPECT_THAT((*evaluator)->Evaluate(manifest), HasValue(::testing::Eq(true)));
+}
+
+}  // namespace iceberg
@@ -0,0 +1,144 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/manifest_list_diff.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/fast_append.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/rewrite_manifests.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/test/table_test_base.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+class ManifestListDiffTest : public TableTestBase {
+ protected:
+  void SetUp() override {
+    TableTestBase::SetUp();
+    ASSERT_NO_FATAL_FAILURE(CreateTable());
+  }
+
+  // Appends a file in a new snapshot and returns the id of the snapshot.
+  int64_t Append(const std::string& path) {
+    FastAppend append(table_);
+    append.AppendFile(std::make_shared<DataFile>(DataFile{
+        .file_path = path,
+        .file_format = FileFormatType::kParquet,
+        .record_count = 10,
+        .file_size_in_bytes = 100,
+    }));
+    EXPECT_THAT(append.Commit(), IsOk());
+    return append.snapshot_id();
+  }
+
+  static std::vector<int64_t> AddedSnapshotIds(const std::vector<ManifestFile>& files) {
+    std::vector<int64_t> ids;
+    for (const auto& file : files) {
+      ids.push_back(file.added_snapshot_id);
+    }
+    std::ranges::sort(ids);
+    return ids;
+  }
+};
+
+TEST_F(ManifestListDiffTest, AllManifestsAreAddedWithoutOlderSnapshot) {
+  auto first = Append("/data/a.parquet");
+  auto second = Append("/data/b.parquet");
+
+  ManifestListDiffer differ(file_io_);
+  ICEBERG_UNWRAP_OR_FAIL(auto changes, differ.Diff(*table_->metadata(), std::nullopt,
+                                                   second));
+  EXPECT_EQ(AddedSnapshotIds(changes.added_manifests),
+            (std::vector<int64_t>{std::min(first, second), std::max(first, second)}));
+  EXPECT_TRUE(changes.removed_manifests.empty());
+}
+
+TEST_F(ManifestListDiffTest, ManifestsAddedByAppends) {
+  auto first = Append("/data/a.parquet");
+  auto second = Append("/data/b.parquet");
+  auto third = Append("/data/c.parquet");
+
+  ManifestListDiffer differ(file_io_);
+  ICEBERG_UNWRAP_OR_FAIL(auto changes, differ.Diff(*table_->metadata(), first, third));
+  EXPECT_EQ(AddedSnapshotIds(changes.added_manifests),
+            (std::vector<int64_t>{std::min(second, third), std::max(second, third)}));
+  EXPECT_TRUE(changes.removed_manifests.empty());
+
+  ICEBERG_UNWRAP_OR_FAIL(changes, differ.Diff(*table_->metadata(), third, third));
+  EXPECT_TRUE(changes.added_manifests.empty());
+  EXPECT_TRUE(changes.removed_manifests.empty());
+}
+
+TEST_F(ManifestListDiffTest, RewrittenManifestsAreRemoved) {
+  auto first = Append("/data/a.parquet");
+  auto second = Append("/data/b.parquet");
+  RewriteManifests rewrite(table_);
+  ASSERT_THAT(rewrite.Commit(), IsOk());
+
+  ManifestListDiffer differ(file_io_);
+  ICEBERG_UNWRAP_OR_FAIL(auto changes,
+                         differ.Diff(*table_->metadata(), second, rewrite.snapshot_id()));
+  EXPECT_EQ(AddedSnapshotIds(changes.added_manifests),
+            std::vector<int64_t>{rewrite.snapshot_id()});
+  EXPECT_EQ(AddedSnapshotIds(changes.removed_manifests),
+            (std::vector<int64_t>{std::min(first, second), std::max(first, second)}));
+}
+
+TEST_F(ManifestListDiffTest, OlderSnapshotNotInLineage) {
+  auto first = Append("/data/a.parquet");
+  auto second = Append("/data/b.parquet");
+
+  // Diffing against a newer snapshot compares the manifest paths.
+  ManifestListDiffer differ(file_io_);
+  ICEBERG_UNWRAP_OR_FAIL(auto changes, differ.Diff(*table_->metadata(), second, first));
+  EXPECT_TRUE(changes.added_manifests.empty());
+  EXPECT_EQ(AddedSnapshotIds(changes.removed_manifests), std::vector<int64_t>{second});
+}
+
+TEST_F(ManifestListDiffTest, KeepsManifestListOfNewerSnapshot) {
+  auto first = Append("/data/a.parquet");
+  auto second = Append("/data/b.parquet");
+  auto third = Append("/data/c.parquet");
+
+  ManifestListDiffer differ(file_io_);
+  ICEBERG_UNWRAP_OR_FAIL(auto changes, differ.Diff(*table_->metadata(), first, second));
+  EXPECT_EQ(AddedSnapshotIds(changes.added_manifests), std::vector<int64_t>{second});
+
+  // The next poll does not read the manifest list of the previously planned snapshot.
+  ICEBERG_UNWRAP_OR_FAIL(auto snapshot, table_->metadata()->SnapshotById(second));
+  ASSERT_TRUE(std::filesystem::remove(snapshot->manifest_list));
+  ICEBERG_UNWRAP_OR_FAIL(changes, differ.Diff(*table_->metadata(), second, third));
+  EXPECT_EQ(AddedSnapshotIds(changes.added_manifests), std::vector<int64_t>{third});
+  EXPECT_TRUE(changes.removed_manifests.empty());
+}
+
+}  // namespace iceberg
@@ -17,7 +17,11 @@
  * under the License.
  */
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <span>
+#include <string>
 
 #include <arrow/filesystem/localfs.h>
 #include <gtest/gtest.h>
@@ -25,6 +29,7 @@
 #include "iceberg/arrow/arrow_fs_file_io_internal.h"
 #include "iceberg/avro/avro_register.h"
 #include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_entry_batch.h"
 #include "iceberg/manifest_list.h"
 #include "iceberg/manifest_reader.h"
 #include "iceberg/manifest_writer.h"
@@ -191,6 +196,161 @@ TEST_F(ManifestReaderV1Test, WritePartitionedTest) {
   TestManifestReadingByPath(write_manifest_path, expected_entries, partition_schema);
 }
 
+TEST_F(ManifestReaderV1Test, WriteEntriesAcrossBatches) {
+  iceberg::SchemaField table_field(1, "order_ts_hour_source", iceberg::int32(), true);
+  iceberg::SchemaField partition_field(1000, "order_ts_hour", iceberg::int32(), true);
+  auto table_schema = std::make_shared<Schema>(std::vector<SchemaField>({table_field}));
+  auto partition_schema =
+      std::make_shared<Schema>(std::vector<SchemaField>({partition_field}));
+  std::vector<PartitionField> fields{
+      PartitionField(1, 1000, "order_ts_hour", Transform::Identity())};
+  auto partition_spec = std::make_shared<PartitionSpec>(table_schema, 1, fields);
+
+  // Enough entries for several batches of the writer.
+  auto test_data = PreparePartitionedTestData();
+  std::vector<ManifestEntry> expected_entries;
+  for (size_t i = 0; i < 2500; ++i) {
+    auto entry = test_data[i % test_data.size()];
+    entry.data_file = std::make_shared<DataFile>(*entry.data_file);
+    entry.data_file->file_path += std::to_string(i);
+    expected_entries.push_back(std::move(entry));
+  }
+
+  // Mixing single entries with bulk appends leaves the batches partially filled.
+  auto write_manifest_path = CreateNewTempFilePath();
+  ICEBERG_UNWRAP_OR_FAIL(auto writer, ManifestWriter::MakeV1Writer(
+                                          1, write_manifest_path, file_io_,
+                                          std::move(partition_spec)));
+  std::span<const ManifestEntry> entries(expected_entries);
+  ASSERT_THAT(writer->Add(entries[0]), IsOk());
+  ASSERT_THAT(writer->AddAll(entries.subspan(1, 1500)), IsOk());
+  ASSERT_THAT(writer->Add(entries[1501]), IsOk());
+  ASSERT_THAT(writer->AddAll(entries.subspan(1502)), IsOk());
+  ASSERT_THAT(writer->Close(), IsOk());
+
+  TestManifestReadingByPath(write_manifest_path, expected_entries, partition_schema);
+}
+
+TEST_F(ManifestReaderV1Test, SelectColumns) {
+  iceberg::SchemaField partition_field(1000, "order_ts_hour", iceberg::int32(), true);
+  auto partition_schema =
+      std::make_shared<Schema>(std::vector<SchemaField>({partition_field}));
+  auto expected_entries = PreparePartitionedTestData();
+  for (auto& entry : expected_entries) {
+    auto& file = *entry.data_file;
+    // Only the selected optional fields and the metrics of the kept columns are read.
+    file.column_sizes.clear();
+    file.value_counts.clear();
+    file.null_value_counts.clear();
+    file.upper_bounds.clear();
+    file.split_offsets.clear();
+    file.sort_order_id.reset();
+    std::erase_if(file.lower_bounds, [](const auto& bound) { return bound.first != 1; });
+  }
+
+  std::string path = GetResourcePath("56357cd7-391f-4df8-aa24-e7e667da8870-m4.avro");
+  ManifestReadOptions options{.columns = {"lower_bounds"}, .stats_field_ids = {{1}}};
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto reader, ManifestReader::Make(path, file_io_, partition_schema, options));
+  EXPECT_THAT(reader->Entries(), HasValue(::testing::Eq(expected_entries)));
+}
+
+TEST_F(ManifestReaderV1Test, SelectUnknownColumn) {
+  std::string path = GetResourcePath("56357cd7-391f-4df8-aa24-e7e667da8870-m4.avro");
+  ManifestReadOptions options{.columns = {"file_path", "unknown_field"}};
+  auto reader = ManifestReader::Make(path, file_io_, nullptr, options);
+  EXPECT_THAT(reader, IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(reader, HasErrorMessage("unknown_field"));
+}
+
+TEST_F(ManifestReaderV1Test, SelectStatuses) {
+  iceberg::SchemaField table_field(1, "order_ts_hour_source", iceberg::int32(), true);
+  iceberg::SchemaField partition_field(1000, "order_ts_hour", iceberg::int32(), true);
+  auto table_schema = std::make_shared<Schema>(std::vector<SchemaField>({table_field}));
+  auto partition_schema =
+      std::make_shared<Schema>(std::vector<SchemaField>({partition_field}));
+  std::vector<PartitionField> fields{
+      PartitionField(1, 1000, "order_ts_hour", Transform::Identity())};
+  auto partition_spec = std::make_shared<PartitionSpec>(table_schema, 1, fields);
+
+  // Enough entries for several batches, with the statuses interleaved within each.
+  constexpr std::array kStatuses = {ManifestStatus::kAdded, ManifestStatus::kExisting,
+                                    ManifestStatus::kDeleted};
+  auto test_data = PreparePartitionedTestData();
+  std::vector<ManifestEntry> entries;
+  std::vector<ManifestEntry> live_entries;
+  std::vector<ManifestEntry> deleted_entries;
+  for (size_t i = 0; i < 2500; ++i) {
+    auto entry = test_data[i % test_data.size()];
+    entry.status = kStatuses[i % kStatuses.size()];
+    entry.data_file = std::make_shared<DataFile>(*entry.data_file);
+    entry.data_file->file_path += std::to_string(i);
+    auto& selected =
+        entry.status == ManifestStatus::kDeleted ? deleted_entries : live_entries;
+    selected.push_back(entry);
+    entries.push_back(std::move(entry));
+  }
+  auto write_manifest_path = CreateNewTempFilePath();
+  TestWriteManifest(write_manifest_path, partition_spec, entries);
+
+  auto read = [&](std::vector<ManifestStatus> statuses) {
+    ManifestReadOptions options{.statuses = std::move(statuses)};
+    auto reader =
+        ManifestReader::Make(write_manifest_path, file_io_, partition_schema, options);
+    EXPECT_THAT(reader, IsOk());
+    return reader.value()->Entries();
+  };
+  EXPECT_THAT(read({ManifestStatus::kAdded, ManifestStatus::kExisting}),
+              HasValue(::testing::Eq(live_entries)));
+  EXPECT_THAT(read({ManifestStatus::kDeleted}),
+              HasValue(::testing::Eq(deleted_entries)));
+  EXPECT_THAT(read({ManifestStatus::kDeleted, ManifestStatus::kExisting,
+                    ManifestStatus::kAdded}),
+              HasValue(::testing::Eq(entries)));
+}
+
+TEST_F(ManifestReaderV1Test, VisitBatches) {
+  iceberg::SchemaField partition_field(1000, "order_ts_hour", iceberg::int32(), true);
+  auto partition_schema =
+      std::make_shared<Schema>(std::vector<SchemaField>({partition_field}));
+  auto expected_entries = PreparePartitionedTestData();
+  std::string path = GetResourcePath("56357cd7-391f-4df8-aa24-e7e667da8870-m4.avro");
+  ICEBERG_UNWRAP_OR_FAIL(auto reader,
+                         ManifestReader::Make(path, file_io_, partition_schema));
+
+  size_t visited = 0;
+  auto status = reader->VisitBatches([&](const ManifestEntryBatch& batch) -> Status {
+    for (int64_t row = 0; row < batch.size(); ++row, ++visited) {
+      const auto& expected = expected_entries[visited];
+      const auto& file = *expected.data_file;
+      EXPECT_EQ(batch.status(row), expected.status);
+      EXPECT_EQ(batch.snapshot_id(row), expected.snapshot_id);
+      EXPECT_EQ(batch.content(row), file.content);
+      EXPECT_EQ(batch.file_path(row), file.file_path);
+      EXPECT_THAT(batch.file_format(row), HasValue(::testing::Eq(file.file_format)));
+      EXPECT_THAT(batch.partition(row), HasValue(::testing::Eq(file.partition)));
+      EXPECT_EQ(batch.record_count(row), file.record_count);
+      EXPECT_EQ(batch.file_size_in_bytes(row), file.file_size_in_bytes);
+      EXPECT_EQ(batch.column_size(row, 1), file.column_sizes.at(1));
+      EXPECT_EQ(batch.value_count(row, 2), file.value_counts.at(2));
+      EXPECT_EQ(batch.null_value_count(row, 3), file.null_value_counts.at(3));
+      EXPECT_EQ(batch.nan_value_count(row, 1), std::nullopt);
+      EXPECT_EQ(batch.column_size(row, 5), std::nullopt);
+
+      auto lower_bound = batch.lower_bound(row, 4);
+      EXPECT_TRUE(lower_bound.has_value() &&
+                  std::ranges::equal(lower_bound.value(), file.lower_bounds.at(4)));
+      EXPECT_FALSE(batch.upper_bound(row, 5).has_value());
+      EXPECT_TRUE(std::ranges::equal(batch.split_offsets(row), file.split_offsets));
+
+      EXPECT_THAT(batch.Entry(row), HasValue(::testing::Eq(expected)));
+    }
+    return {};
+  });
+  ASSERT_THAT(status, IsOk());
+  EXPECT_EQ(visited, expected_entries.size());
+}
+
 class ManifestReaderV2Test : public ManifestReaderTestBase {
  protected:
   std::vector<ManifestEntry> CreateV2TestData(
@@ -290,6 +450,69 @@ TEST_F(ManifestReaderV2Test, MetadataInheritanceTest) {
   TestManifestReadingWithManifestFile(manifest_file, expected_entries);
 }
 
+TEST_F(ManifestReaderV2Test, VisitBatchesAppliesInheritance) {
+  std::string path = GetResourcePath("2ddf1bc9-830b-4015-aced-c060df36f150-m0.avro");
+  ManifestFile manifest_file{
+      .manifest_path = path,
+      .manifest_length = 100,
+      .partition_spec_id = 12,
+      .content = ManifestFile::Content::kData,
+      .sequence_number = 15,
+      .added_snapshot_id = 679879563479918846LL,
+  };
+  auto expected_entries = PrepareMetadataInheritanceTestData();
+  ICEBERG_UNWRAP_OR_FAIL(auto reader,
+                         ManifestReader::Make(manifest_file, file_io_, nullptr));
+
+  std::vector<ManifestEntry> entries;
+  auto status = reader->VisitBatches([&](const ManifestEntryBatch& batch) -> Status {
+    for (int64_t row = 0; row < batch.size(); ++row) {
+      // The stored sequence numbers are null, they are inherited by Entry().
+      EXPECT_EQ(batch.sequence_number(row), std::nullopt);
+      EXPECT_EQ(batch.file_sequence_number(row), std::nullopt);
+      EXPECT_TRUE(batch.partition(row).value().empty());
+      ICEBERG_ASSIGN_OR_RAISE(auto entry, batch.Entry(row));
+      entries.push_back(std::move(entry));
+    }
+    EXPECT_THAT(batch.Entry(batch.size()), IsError(ErrorKind::kInvalidArgument));
+    return {};
+  });
+  ASSERT_THAT(status, IsOk());
+  EXPECT_EQ(entries, expected_entries);
+}
+
+TEST_F(ManifestReaderV2Test, InheritsFirstRowIds) {
+  std::string path = GetResourcePath("2ddf1bc9-830b-4015-aced-c060df36f150-m0.avro");
+  ManifestFile manifest_file{
+      .manifest_path = path,
+      .manifest_length = 100,
+      .partition_spec_id = 12,
+      .content = ManifestFile::Content::kData,
+      .sequence_number = 15,
+      .added_snapshot_id = 679879563479918846LL,
+      .first_row_id = 1000,
+  };
+  auto expected_entries = PrepareMetadataInheritanceTestData();
+  for (auto& entry : expected_entries) {
+    entry.data_file->first_row_id = 1000;
+  }
+  TestManifestReadingWithManifestFile(manifest_file, expected_entries);
+
+  ICEBERG_UNWRAP_OR_FAIL(auto reader,
+                         ManifestReader::Make(manifest_file, file_io_, nullptr));
+  std::vector<ManifestEntry> entries;
+  auto status = reader->VisitBatches([&](const ManifestEntryBatch& batch) -> Status {
+    for (int64_t row = 0; row < batch.size(); ++row) {
+      EXPECT_EQ(batch.first_row_id(row), 1000);
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto entry, batch.Entry(0));
+    entries.push_back(std::move(entry));
+    return {};
+  });
+  ASSERT_THAT(status, IsOk());
+  EXPECT_EQ(entries, expected_entries);
+}
+
 TEST_F(ManifestReaderV2Test, WriteNonPartitionedTest) {
   auto expected_entries = PrepareNonPartitionedTestData();
   auto write_manifest_path = CreateNewTempFilePath();
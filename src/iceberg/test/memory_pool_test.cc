@@ -0,0 +1,151 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/memory_pool.h"
+
+#include <cstring>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/test/matchers.h"
+
+namespace iceberg {
+
+TEST(MemoryPoolTest, SystemPool) {
+  const auto& pool = MemoryPool::System();
+  const int64_t allocated = pool->bytes_allocated();
+
+  uint8_t* buffer = nullptr;
+  ASSERT_THAT(pool->Allocate(100, MemoryPool::kDefaultAlignment, &buffer), IsOk());
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer) % MemoryPool::kDefaultAlignment, 0);
+  std::memset(buffer, 'x', 100);
+  ASSERT_THAT(pool->Reallocate(100, 200, MemoryPool::kDefaultAlignment, &buffer),
+              IsOk());
+  EXPECT_EQ(buffer[99], 'x');
+  pool->Free(buffer, 200, MemoryPool::kDefaultAlignment);
+  EXPECT_EQ(pool->bytes_allocated(), allocated);
+
+  ASSERT_THAT(pool->Allocate(0, MemoryPool::kDefaultAlignment, &buffer), IsOk());
+  EXPECT_NE(buffer, nullptr);
+  pool->Free(buffer, 0, MemoryPool::kDefaultAlignment);
+
+  EXPECT_THAT(pool->Allocate(-1, MemoryPool::kDefaultAlignment, &buffer),
+              IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(pool->Allocate(8, 3, &buffer), IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST(MemoryPoolTest, TrackingPool) {
+  TrackingMemoryPool pool;
+  EXPECT_FALSE(pool.limit().has_value());
+
+  uint8_t* first = nullptr;
+  uint8_t* second = nullptr;
+  ASSERT_THAT(pool.Allocate(100, MemoryPool::kDefaultAlignment, &first), IsOk());
+  ASSERT_THAT(pool.Allocate(50, MemoryPool::kDefaultAlignment, &second), IsOk());
+  EXPECT_EQ(pool.bytes_allocated(), 150);
+  ASSERT_THAT(pool.Reallocate(100, 20, MemoryPool::kDefaultAlignment, &first), IsOk());
+  EXPECT_EQ(pool.bytes_allocated(), 70);
+  pool.Free(first, 20, MemoryPool::kDefaultAlignment);
+  pool.Free(second, 50, MemoryPool::kDefaultAlignment);
+
+  EXPECT_EQ(pool.bytes_allocated(), 0);
+  EXPECT_EQ(pool.max_memory(), 150);
+  EXPECT_EQ(pool.total_bytes_allocated(), 150);
+  EXPECT_EQ(pool.num_allocations(), 3);
+}
+
+TEST(MemoryPoolTest, Limit) {
+  auto parent = std::make_shared<TrackingMemoryPool>(/*limit=*/1000);
+  TrackingMemoryPool pool(/*limit=*/100, parent);
+
+  uint8_t* buffer = nullptr;
+  ASSERT_THAT(pool.Allocate(80, MemoryPool::kDefaultAlignment, &buffer), IsOk());
+  uint8_t* other = nullptr;
+  EXPECT_THAT(pool.Allocate(40, MemoryPool::kDefaultAlignment, &other),
+              IsError(ErrorKind::kOutOfMemory));
+  // A failed reallocation leaves the buffer and the accounting unchanged.
+  uint8_t* const original = buffer;
+  EXPECT_THAT(pool.Reallocate(80, 120, MemoryPool::kDefaultAlignment, &buffer),
+              IsError(ErrorKind::kOutOfMemory));
+  EXPECT_EQ(buffer, original);
+  EXPECT_EQ(pool.bytes_allocated(), 80);
+  EXPECT_EQ(parent->bytes_allocated(), 80);
+
+  // The limit of the parent applies to its children as well.
+  TrackingMemoryPool sibling(/*limit=*/std::nullopt, parent);
+  EXPECT_THAT(sibling.Allocate(960, MemoryPool::kDefaultAlignment, &other),
+              IsError(ErrorKind::kOutOfMemory));
+  EXPECT_EQ(sibling.bytes_allocated(), 0);
+
+  pool.Free(buffer, 80, MemoryPool::kDefaultAlignment);
+  EXPECT_EQ(parent->bytes_allocated(), 0);
+  EXPECT_EQ(pool.max_memory(), 80);
+}
+
+TEST(MemoryPoolTest, RecyclingPool) {
+  auto parent = std::make_shared<TrackingMemoryPool>();
+  RecyclingMemoryPool pool(/*max_retained_bytes=*/1024, parent);
+
+  uint8_t* buffer = nullptr;
+  ASSERT_THAT(pool.Allocate(100, MemoryPool::kDefaultAlignment, &buffer), IsOk());
+  std::memset(buffer, 'x', 100);
+  // Buffers are allocated from the parent in power-of-two size classes, and grow
+  // within their class without moving.
+  EXPECT_EQ(parent->bytes_allocated(), 128);
+  uint8_t* const original = buffer;
+  ASSERT_THAT(pool.Reallocate(100, 120, MemoryPool::kDefaultAlignment, &buffer),
+              IsOk());
+  EXPECT_EQ(buffer, original);
+  ASSERT_THAT(pool.Reallocate(120, 200, MemoryPool::kDefaultAlignment, &buffer),
+              IsOk());
+  EXPECT_EQ(buffer[99], 'x');
+  EXPECT_EQ(pool.bytes_allocated(), 200);
+  EXPECT_EQ(pool.bytes_retained(), 128);
+
+  // Freed buffers are reused by the next allocations of their class.
+  pool.Free(buffer, 200, MemoryPool::kDefaultAlignment);
+  EXPECT_EQ(pool.bytes_allocated(), 0);
+  EXPECT_EQ(pool.bytes_retained(), 384);
+  uint8_t* recycled = nullptr;
+  ASSERT_THAT(pool.Allocate(256, MemoryPool::kDefaultAlignment, &recycled), IsOk());
+  EXPECT_EQ(recycled, buffer);
+  EXPECT_EQ(pool.num_recycled(), 1);
+  EXPECT_EQ(parent->bytes_allocated(), 384);
+
+  // Buffers larger than the retained bytes are not recycled.
+  uint8_t* large = nullptr;
+  ASSERT_THAT(pool.Allocate(2000, MemoryPool::kDefaultAlignment, &large), IsOk());
+  pool.Free(large, 2000, MemoryPool::kDefaultAlignment);
+  EXPECT_EQ(parent->bytes_allocated(), 384);
+  pool.Free(recycled, 256, MemoryPool::kDefaultAlignment);
+  EXPECT_EQ(pool.num_allocations(), 5);
+  EXPECT_EQ(pool.max_memory(), 2256);
+
+  // The retained buffers are returned to the parent with the pool.
+  {
+    RecyclingMemoryPool scoped(/*max_retained_bytes=*/1024, parent);
+    ASSERT_THAT(scoped.Allocate(10, MemoryPool::kDefaultAlignment, &buffer), IsOk());
+    scoped.Free(buffer, 10, MemoryPool::kDefaultAlignment);
+    EXPECT_EQ(scoped.bytes_retained(), 64);
+  }
+  EXPECT_EQ(parent->bytes_allocated(), 384);
+}
+
+}  // namespace iceberg
@@ -0,0 +1,218 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/merge_append.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/manifest_reader.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table.h"
+#include "iceberg/table_scan.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/test/table_test_base.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+class MergeAppendTest : public TableTestBase {
+ protected:
+  static std::shared_ptr<DataFile> MakeDataFile(const std::string& path,
+                                                int64_t record_count) {
+    return std::make_shared<DataFile>(DataFile{
+        .file_path = path,
+        .file_format = FileFormatType::kParquet,
+        .record_count = record_count,
+        .file_size_in_bytes = record_count * 10,
+    });
+  }
+
+  static std::vector<std::string> ScanPaths(const Table& table) {
+    auto scan = table.NewScan()->Build();
+    EXPECT_THAT(scan, IsOk());
+    auto tasks = (*scan)->PlanFiles();
+    EXPECT_THAT(tasks, IsOk());
+    std::vector<std::string> paths;
+    for (const auto& task : *tasks) {
+      paths.push_back(task->data_file()->file_path);
+    }
+    std::ranges::sort(paths);
+    return paths;
+  }
+
+  std::vector<ManifestFile> Manifests(const Snapshot& snapshot) {
+    auto reader = ManifestListReader::Make(snapshot.manifest_list, file_io_);
+    EXPECT_THAT(reader, IsOk());
+    auto files = (*reader)->Files();
+    EXPECT_THAT(files, IsOk());
+    return std::move(files.value());
+  }
+
+  std::vector<ManifestEntry> Entries(const ManifestFile& manifest) {
+    auto reader = ManifestReader::Make(manifest, file_io_, /*partition_schema=*/nullptr);
+    EXPECT_THAT(reader, IsOk());
+    auto entries = (*reader)->Entries();
+    EXPECT_THAT(entries, IsOk());
+    return std::move(entries.value());
+  }
+
+  int32_t CountAvroFiles() const {
+    int32_t count = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(MetadataFolder())) {
+      count += entry.path().extension() == ".avro" ? 1 : 0;
+    }
+    return count;
+  }
+};
+
+TEST_F(MergeAppendTest, KeepsNewManifestsBelowMinCount) {
+  ASSERT_NO_FATAL_FAILURE(RegisterTable({{"commit.manifest.min-count-to-merge", "3"}}));
+  auto table = LoadTable();
+
+  for (const auto& path : {"/data/a.parquet", "/data/b.parquet"}) {
+    MergeAppend append(table);
+    append.AppendFile(MakeDataFile(path, 10));
+    ASSERT_THAT(append.Commit(), IsOk());
+  }
+
+  ICEBERG_UNWRAP_OR_FAIL(auto snapshot, table->current_snapshot());
+  EXPECT_EQ(Manifests(*snapshot).size(), 2);
+}
+
+TEST_F(MergeAppendTest, MergesManifestsAtMinCount) {
+  ASSERT_NO_FATAL_FAILURE(RegisterTable({{"commit.manifest.min-count-to-merge", "3"}}));
+  auto table = LoadTable();
+
+  std::vector<int64_t> snapshot_ids;
+  for (const auto& path : {"/data/a.parquet", "/data/b.parquet", "/data/c.parquet"}) {
+    MergeAppend append(table);
+    append.AppendFile(MakeDataFile(path, 10));
+    ASSERT_THAT(append.Commit(), IsOk());
+    snapshot_ids.push_back(append.snapshot_id());
+  }
+
+  ICEBERG_UNWRAP_OR_FAIL(auto snapshot, table->current_snapshot());
+  EXPECT_EQ(snapshot->sequence_number, 3);
+  EXPECT_EQ(snapshot->summary.at(SnapshotSummaryFields::kAddedDataFiles), "1");
+  EXPECT_EQ(snapshot->summary.at(SnapshotSummaryFields::kTotalDataFiles), "3");
+
+  auto manifests = Manifests(*snapshot);
+  ASSERT_EQ(manifests.size(), 1);
+  EXPECT_EQ(manifests[0].added_snapshot_id, snapshot_ids[2]);
+  EXPECT_EQ(manifests[0].sequence_number, 3);
+  EXPECT_EQ(manifests[0].min_sequence_number, 1);
+  EXPECT_EQ(manifests[0].added_files_count, 1);
+  EXPECT_EQ(manifests[0].existing_files_count, 2);
+
+  // Entries keep the order of the merged manifests, from the newest to the oldest, and
+  // the merged entries keep their sequence numbers.
+  auto entries = Entries(manifests[0]);
+  ASSERT_EQ(entries.size(), 3);
+  EXPECT_EQ(entries[0].status, ManifestStatus::kAdded);
+  EXPECT_EQ(entries[0].data_file->file_path, "/data/c.parquet");
+  EXPECT_EQ(entries[0].sequence_number, 3);
+  EXPECT_EQ(entries[1].status, ManifestStatus::kExisting);
+  EXPECT_EQ(entries[1].snapshot_id, snapshot_ids[1]);
+  EXPECT_EQ(entries[1].sequence_number, 2);
+  EXPECT_EQ(entries[2].status, ManifestStatus::kExisting);
+  EXPECT_EQ(entries[2].snapshot_id, snapshot_ids[0]);
+  EXPECT_EQ(entries[2].sequence_number, 1);
+
+  // The new manifest of the last append was merged and is deleted.
+  EXPECT_EQ(CountAvroFiles(), 6);
+  EXPECT_EQ(ScanPaths(*table),
+            (std::vector<std::string>{"/data/a.parquet", "/data/b.parquet",
+                                      "/data/c.parquet"}));
+}
+
+TEST_F(MergeAppendTest, MergingDisabled) {
+  ASSERT_NO_FATAL_FAILURE(RegisterTable({{"commit.manifest.min-count-to-merge", "2"},
+                                         {"commit.manifest-merge.enabled", "false"}}));
+  auto table = LoadTable();
+
+  for (const auto& path : {"/data/a.parquet", "/data/b.parquet", "/data/c.parquet"}) {
+    MergeAppend append(table);
+    append.AppendFile(MakeDataFile(path, 10));
+    ASSERT_THAT(append.Commit(), IsOk());
+  }
+
+  ICEBERG_UNWRAP_OR_FAIL(auto snapshot, table->current_snapshot());
+  EXPECT_EQ(Manifests(*snapshot).size(), 3);
+}
+
+TEST_F(MergeAppendTest, ManifestsAboveTargetSizeAreNotMerged) {
+  ASSERT_NO_FATAL_FAILURE(RegisterTable({{"commit.manifest.min-count-to-merge", "2"},
+                                         {"commit.manifest.target-size-bytes", "1"}}));
+  auto table = LoadTable();
+
+  for (const auto& path : {"/data/a.parquet", "/data/b.parquet", "/data/c.parquet"}) {
+    MergeAppend append(table);
+    append.AppendFile(MakeDataFile(path, 10));
+    ASSERT_THAT(append.Commit(), IsOk());
+  }
+
+  // Each manifest fills a bin of its own.
+  ICEBERG_UNWRAP_OR_FAIL(auto snapshot, table->current_snapshot());
+  EXPECT_EQ(Manifests(*snapshot).size(), 3);
+}
+
+TEST_F(MergeAppendTest, RetryMergesOnTopOfConcurrentCommit) {
+  ASSERT_NO_FATAL_FAILURE(RegisterTable({{"commit.manifest.min-count-to-merge", "2"}}));
+  auto table = LoadTable();
+
+  MergeAppend first(table);
+  first.AppendFile(MakeDataFile("/data/a.parquet", 10));
+  ASSERT_THAT(first.Commit(), IsOk());
+  auto stale_table = LoadTable();
+  MergeAppend second(table);
+  second.AppendFile(MakeDataFile("/data/b.parquet", 10));
+  ASSERT_THAT(second.Commit(), IsOk());
+
+  // The first attempt merges with the manifest of the first append and conflicts, the
+  // retry merges with the manifest committed by the second append instead.
+  MergeAppend third(stale_table);
+  third.AppendFile(MakeDataFile("/data/c.parquet", 10));
+  ASSERT_THAT(third.Commit(), IsOk());
+
+  ICEBERG_UNWRAP_OR_FAIL(auto snapshot, stale_table->current_snapshot());
+  EXPECT_EQ(snapshot->parent_snapshot_id, second.snapshot_id());
+  auto manifests = Manifests(*snapshot);
+  ASSERT_EQ(manifests.size(), 1);
+  EXPECT_EQ(manifests[0].added_files_count, 1);
+  EXPECT_EQ(manifests[0].existing_files_count, 2);
+
+  // The manifests written by the failed attempt are deleted, as well as the new manifest
+  // of the third append, leaving three manifest lists, the manifest of the first append
+  // and two merged manifests.
+  EXPECT_EQ(CountAvroFiles(), 6);
+  EXPECT_EQ(ScanPaths(*stale_table),
+            (std::vector<std::string>{"/data/a.parquet", "/data/b.parquet",
+                                      "/data/c.parquet"}));
+}
+
+}  // namespace iceberg
@@ -0,0 +1,278 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/util/merged_stream_internal.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/executor.h"
+#include "iceberg/schema.h"
+#include "iceberg/test/deferred_executor.h"
+#include "iceberg/test/matchers.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief Counts the streams and arrays of the parts that are not released.
+struct Counters {
+  std::atomic<int32_t> opened = 0;
+  std::atomic<int32_t> streams = 0;
+  std::atomic<int32_t> arrays = 0;
+};
+
+/// \brief A batch identifying its part and its position in the part.
+struct FakeArray {
+  int32_t id;
+  std::shared_ptr<Counters> counters;
+};
+
+/// \brief A part returning `batches` batches of `rows` rows.
+struct FakeStream {
+  int32_t part;
+  int32_t batches;
+  int64_t rows;
+  int32_t next = 0;
+  std::shared_ptr<Counters> counters;
+
+  static int GetNext(ArrowArrayStream* stream, ArrowArray* out) {
+    auto* fake = static_cast<FakeStream*>(stream->private_data);
+    *out = ArrowArray{};
+    if (fake->next == fake->batches) {
+      return 0;
+    }
+    ++fake->counters->arrays;
+    out->length = fake->rows;
+    out->private_data = new FakeArray{.id = fake->part * 100 + fake->next++,
+                                      .counters = fake->counters};
+    out->release = [](ArrowArray* array) {
+      auto* data = static_cast<FakeArray*>(array->private_data);
+      --data->counters->arrays;
+      delete data;
+      array->release = nullptr;
+    };
+    return 0;
+  }
+
+  static const char* GetLastError(ArrowArrayStream*) { return nullptr; }
+
+  static void Release(ArrowArrayStream* stream) {
+    auto* fake = static_cast<FakeStream*>(stream->private_data);
+    --fake->counters->streams;
+    delete fake;
+    stream->release = nullptr;
+  }
+};
+
+ArrowStreamOpener MakePart(int32_t part, int32_t batches, int64_t rows,
+                           const std::shared_ptr<Counters>& counters) {
+  return [=]() -> Result<ArrowArrayStream> {
+    ++counters->opened;
+    ++counters->streams;
+    return ArrowArrayStream{.get_next = FakeStream::GetNext,
+                            .get_last_error = FakeStream::GetLastError,
+                            .release = FakeStream::Release,
+                            .private_data = new FakeStream{.part = part,
+                                                           .batches = batches,
+                                                           .rows = rows,
+                                                           .counters = counters}};
+  };
+}
+
+}  // namespace
+
+class MergedStreamTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    schema_ = std::make_shared<Schema>(
+        std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32())});
+    counters_ = std::make_shared<Counters>();
+  }
+
+  /// \brief Returns groups of `parts` parts of 5 batches of 10 rows.
+  std::vector<std::vector<ArrowStreamOpener>> MakeGroups(int32_t groups,
+                                                         int32_t parts) {
+    std::vector<std::vector<ArrowStreamOpener>> result(groups);
+    for (int32_t group = 0; group < groups; ++group) {
+      for (int32_t part = 0; part < parts; ++part) {
+        result[group].push_back(MakePart(group * parts + part, 5, 10, counters_));
+      }
+    }
+    return result;
+  }
+
+  /// \brief Reads the ids of the batches of a stream until its end or an error.
+  static Result<std::vector<int32_t>> ReadIds(ArrowArrayStream& stream,
+                                              int64_t* rows = nullptr) {
+    std::vector<int32_t> ids;
+    while (true) {
+      ArrowArray array;
+      if (stream.get_next(&stream, &array) != 0) {
+        return IOError("{}", stream.get_last_error(&stream));
+      }
+      if (array.release == nullptr) {
+        return ids;
+      }
+      ids.push_back(static_cast<FakeArray*>(array.private_data)->id);
+      if (rows != nullptr) {
+        *rows += array.length;
+      }
+      array.release(&array);
+    }
+  }
+
+  std::vector<int32_t> ExpectedIds(int32_t parts) {
+    std::vector<int32_t> ids;
+    for (int32_t part = 0; part < parts; ++part) {
+      for (int32_t batch = 0; batch < 5; ++batch) {
+        ids.push_back(part * 100 + batch);
+      }
+    }
+    return ids;
+  }
+
+  void ExpectReleased() {
+    EXPECT_EQ(counters_->streams, 0);
+    EXPECT_EQ(counters_->arrays, 0);
+  }
+
+  std::shared_ptr<Schema> schema_;
+  std::shared_ptr<Counters> counters_;
+};
+
+TEST_F(MergedStreamTest, Ordered) {
+  ICEBERG_UNWRAP_OR_FAIL(std::shared_ptr<Executor> pool, ThreadPoolExecutor::Make(3));
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto stream,
+      MakeMergedArrowStream(schema_, MakeGroups(3, 4),
+                            {.parallelism = 3, .capacity = 4, .executor = pool}));
+  ArrowSchema arrow_schema;
+  ASSERT_EQ(stream.get_schema(&stream, &arrow_schema), 0);
+  EXPECT_EQ(arrow_schema.n_children, 1);
+  arrow_schema.release(&arrow_schema);
+
+  ICEBERG_UNWRAP_OR_FAIL(auto ids, ReadIds(stream));
+  EXPECT_THAT(ids, ::testing::ElementsAreArray(ExpectedIds(12)));
+  stream.release(&stream);
+  EXPECT_EQ(counters_->opened, 12);
+  ExpectReleased();
+}
+
+TEST_F(MergedStreamTest, Unordered) {
+  ICEBERG_UNWRAP_OR_FAIL(std::shared_ptr<Executor> pool, ThreadPoolExecutor::Make(4));
+  ICEBERG_UNWRAP_OR_FAIL(auto stream,
+                         MakeMergedArrowStream(schema_, MakeGroups(2, 6),
+                                               {.parallelism = 4,
+                                                .ordered = false,
+                                                .capacity = 2,
+                                                .executor = pool}));
+  ICEBERG_UNWRAP_OR_FAIL(auto ids, ReadIds(stream));
+  EXPECT_THAT(ids, ::testing::UnorderedElementsAreArray(ExpectedIds(12)));
+  stream.release(&stream);
+  ExpectReleased();
+}
+
+TEST_F(MergedStreamTest, ReadsWithoutWorkers) {
+  // The consumer reads the parts itself when the workers never start.
+  for (bool ordered : {true, false}) {
+    ICEBERG_UNWRAP_OR_FAIL(
+        auto stream,
+        MakeMergedArrowStream(schema_, MakeGroups(2, 2),
+                              {.parallelism = 2,
+                               .ordered = ordered,
+                               .executor = std::make_shared<DeferredExecutor>()}));
+    ICEBERG_UNWRAP_OR_FAIL(auto ids, ReadIds(stream));
+    EXPECT_THAT(ids, ::testing::UnorderedElementsAreArray(ExpectedIds(4)));
+    stream.release(&stream);
+  }
+  ExpectReleased();
+}
+
+TEST_F(MergedStreamTest, Limit) {
+  std::vector<std::vector<ArrowStreamOpener>> groups(1);
+  for (int32_t part = 0; part < 10; ++part) {
+    groups[0].push_back(MakePart(part, 1, 10, counters_));
+  }
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto stream,
+      MakeMergedArrowStream(schema_, std::move(groups),
+                            {.limit = 25,
+                             .executor = std::make_shared<DeferredExecutor>()}));
+  int64_t rows = 0;
+  ICEBERG_UNWRAP_OR_FAIL(auto ids, ReadIds(stream, &rows));
+  EXPECT_THAT(ids, ::testing::ElementsAre(0, 100, 200));
+  EXPECT_EQ(rows, 25);
+  // The parts after the limit are never opened, and the others are closed.
+  EXPECT_EQ(counters_->opened, 3);
+  EXPECT_EQ(counters_->streams, 0);
+  stream.release(&stream);
+  ExpectReleased();
+
+  ICEBERG_UNWRAP_OR_FAIL(auto empty,
+                         MakeMergedArrowStream(schema_, MakeGroups(1, 1), {.limit = 0}));
+  ICEBERG_UNWRAP_OR_FAIL(auto empty_ids, ReadIds(empty));
+  EXPECT_THAT(empty_ids, ::testing::IsEmpty());
+  empty.release(&empty);
+  EXPECT_EQ(counters_->opened, 3);
+}
+
+TEST_F(MergedStreamTest, Error) {
+  auto groups = MakeGroups(2, 2);
+  groups[1][0] = []() -> Result<ArrowArrayStream> { return IOError("cannot open"); };
+  ICEBERG_UNWRAP_OR_FAIL(std::shared_ptr<Executor> pool, ThreadPoolExecutor::Make(2));
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto stream,
+      MakeMergedArrowStream(schema_, std::move(groups),
+                            {.parallelism = 2, .capacity = 2, .executor = pool}));
+  EXPECT_THAT(ReadIds(stream), IsError(ErrorKind::kIOError));
+  // The error stays for the following calls.
+  ArrowArray array;
+  EXPECT_NE(stream.get_next(&stream, &array), 0);
+  stream.release(&stream);
+  ExpectReleased();
+
+  EXPECT_THAT(MakeMergedArrowStream(schema_, {}, {.parallelism = 0}),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(MergedStreamTest, ReleasedWhileReading) {
+  ICEBERG_UNWRAP_OR_FAIL(std::shared_ptr<Executor> pool, ThreadPoolExecutor::Make(4));
+  for (bool ordered : {true, false}) {
+    ICEBERG_UNWRAP_OR_FAIL(auto stream,
+                           MakeMergedArrowStream(schema_, MakeGroups(4, 4),
+                                                 {.parallelism = 4,
+                                                  .ordered = ordered,
+                                                  .capacity = 8,
+                                                  .executor = pool}));
+    ArrowArray array;
+    ASSERT_EQ(stream.get_next(&stream, &array), 0);
+    array.release(&array);
+    stream.release(&stream);
+  }
+  pool.reset();
+  ExpectReleased();
+}
+
+}  // namespace iceberg
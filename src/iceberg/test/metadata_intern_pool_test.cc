@@ -0,0 +1,130 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/metadata_intern_pool.h"
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/partition_field.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/sort_field.h"
+#include "iceberg/sort_order.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/transform.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+namespace {
+
+std::shared_ptr<Schema> MakeSchema(int32_t schema_id = 0) {
+  return std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int64()),
+                               SchemaField::MakeOptional(2, "data", string())},
+      schema_id);
+}
+
+std::shared_ptr<PartitionSpec> MakeSpec(std::shared_ptr<Schema> schema) {
+  return std::make_shared<PartitionSpec>(
+      std::move(schema), /*spec_id=*/0,
+      std::vector<PartitionField>{
+          PartitionField(1, 1000, "id_bucket", Transform::Bucket(16))});
+}
+
+std::shared_ptr<SortOrder> MakeSortOrder() {
+  return std::make_shared<SortOrder>(
+      /*order_id=*/1, std::vector<SortField>{SortField(2, Transform::Identity(),
+                                                       SortDirection::kAscending,
+                                                       NullOrder::kFirst)});
+}
+
+}  // namespace
+
+TEST(MetadataInternPoolTest, SharesEqualValues) {
+  MetadataInternPool pool;
+  auto schema = MakeSchema();
+  EXPECT_EQ(pool.Intern(schema), schema);
+  EXPECT_EQ(pool.Intern(MakeSchema()), schema);
+  // Schemas with another ID are different values.
+  auto other = MakeSchema(/*schema_id=*/1);
+  EXPECT_EQ(pool.Intern(other), other);
+
+  auto sort_order = MakeSortOrder();
+  EXPECT_EQ(pool.Intern(sort_order), sort_order);
+  EXPECT_EQ(pool.Intern(MakeSortOrder()), sort_order);
+
+  auto stats = pool.stats();
+  EXPECT_EQ(stats.hits, 2);
+  EXPECT_EQ(stats.misses, 3);
+  EXPECT_EQ(stats.entry_count, 3);
+}
+
+TEST(MetadataInternPoolTest, RebindsSpecsToPooledSchemas) {
+  MetadataInternPool pool;
+  auto schema = pool.Intern(MakeSchema());
+
+  auto spec = pool.Intern(MakeSpec(MakeSchema()));
+  EXPECT_EQ(spec->schema(), schema);
+  EXPECT_EQ(pool.Intern(MakeSpec(MakeSchema())), spec);
+  EXPECT_EQ(pool.Intern(MakeSpec(schema)), spec);
+
+  // Specs bound to different schemas are not shared.
+  auto other = pool.Intern(MakeSpec(MakeSchema(/*schema_id=*/1)));
+  EXPECT_NE(other, spec);
+  EXPECT_EQ(*other, *spec);
+}
+
+TEST(MetadataInternPoolTest, InternsMetadata) {
+  MetadataInternPool pool;
+  auto make_metadata = [] {
+    auto schema = MakeSchema();
+    return TableMetadata{.format_version = 2,
+                         .schemas = {schema},
+                         .current_schema_id = 0,
+                         .partition_specs = {MakeSpec(schema)},
+                         .sort_orders = {MakeSortOrder()}};
+  };
+  auto first = make_metadata();
+  auto second = make_metadata();
+  pool.Intern(first);
+  pool.Intern(second);
+
+  EXPECT_EQ(first.schemas[0], second.schemas[0]);
+  EXPECT_EQ(first.partition_specs[0], second.partition_specs[0]);
+  EXPECT_EQ(first.partition_specs[0]->schema(), first.schemas[0]);
+  EXPECT_EQ(first.sort_orders[0], second.sort_orders[0]);
+}
+
+TEST(MetadataInternPoolTest, DropsUnusedValues) {
+  MetadataInternPool pool;
+  for (int32_t i = 0; i < 1000; ++i) {
+    pool.Intern(MakeSchema(i));
+  }
+  // None of the schemas is used anymore, so the pool does not grow with them.
+  EXPECT_LT(pool.stats().entry_count, 200);
+
+  auto schema = MakeSchema();
+  EXPECT_EQ(pool.Intern(schema), schema);
+}
+
+}  // namespace iceberg
@@ -17,14 +17,19 @@
  * under the License.
  */
 
+#include <format>
+#include <string>
+
 #include <arrow/filesystem/localfs.h>
 #include <arrow/io/compressed.h>
 #include <arrow/io/file.h>
 #include <arrow/util/compression.h>
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <nlohmann/json.hpp>
 
 #include "iceberg/arrow/arrow_fs_file_io_internal.h"
+#include "iceberg/executor.h"
 #include "iceberg/file_io.h"
 #include "iceberg/json_internal.h"
 #include "iceberg/schema.h"
@@ -125,4 +130,111 @@ TEST_F(MetadataIOTest, ReadWriteCompressedMetadata) {
   EXPECT_EQ(*metadata_read, metadata);
 }
 
+TEST_F(MetadataIOTest, WriteCompressedMetadata) {
+  TableMetadata metadata = PrepareMetadata();
+
+  auto file_path = CreateNewTempFilePathWithSuffix(
+      std::string(TableMetadataUtil::FileExtension(MetadataFileCodecType::kGzip)));
+  EXPECT_THAT(TableMetadataUtil::Write(*io_, file_path, metadata), IsOk());
+
+  auto content = io_->ReadFile(file_path, std::nullopt);
+  ASSERT_THAT(content, IsOk());
+  ASSERT_GE(content->size(), 2);
+  EXPECT_EQ(static_cast<unsigned char>((*content)[0]), 0x1f);
+  EXPECT_EQ(static_cast<unsigned char>((*content)[1]), 0x8b);
+
+  auto result = TableMetadataUtil::Read(*io_, file_path);
+  ASSERT_THAT(result, IsOk());
+  EXPECT_EQ(*result.value(), metadata);
+}
+
+TEST_F(MetadataIOTest, ReadLargeCompressedMetadata) {
+  TableMetadata metadata = PrepareMetadata();
+  // Enough history for the compressed file to have several members.
+  for (int64_t i = 1; i <= 20000; ++i) {
+    metadata.snapshots.push_back(std::make_shared<Snapshot>(Snapshot{
+        .snapshot_id = i,
+        .parent_snapshot_id = i - 1,
+        .sequence_number = 0,
+        .timestamp_ms = TimePointMsFromUnixMs(1515100955770 + i).value(),
+        .manifest_list = std::format("s3://a/b/snap-{}.avro", i),
+        .summary = {{"operation", "append"}, {"added-data-files", "1"}},
+    }));
+  }
+
+  auto file_path = CreateNewTempFilePathWithSuffix(
+      std::string(TableMetadataUtil::FileExtension(MetadataFileCodecType::kGzip)));
+  ASSERT_THAT(TableMetadataUtil::Write(*io_, file_path, metadata), IsOk());
+
+  for (int32_t num_threads : {1, 4}) {
+    TableMetadataReadOptions options{
+        .executor = ThreadPoolExecutor::Make(num_threads).value()};
+    auto result = TableMetadataUtil::Read(*io_, file_path, std::nullopt, options);
+    ASSERT_THAT(result, IsOk());
+    EXPECT_EQ(*result.value(), metadata);
+  }
+}
+
+TEST_F(MetadataIOTest, WriteJsonMatchesJsonTree) {
+  TableMetadata metadata = PrepareMetadata();
+  metadata.format_version = 2;
+  metadata.properties["quoted \"key\""] = "line\nbreak\ttab\\ \x01 \u00e9";
+  // Enough history for the text to be written in several chunks.
+  for (int64_t i = 1; i <= 10000; ++i) {
+    auto timestamp_ms = TimePointMsFromUnixMs(1515100955770 + i).value();
+    metadata.snapshots.push_back(std::make_shared<Snapshot>(Snapshot{
+        .snapshot_id = i,
+        .parent_snapshot_id = i - 1,
+        .sequence_number = i,
+        .timestamp_ms = timestamp_ms,
+        .manifest_list = std::format("s3://a/b/snap-{}.avro", i),
+        .summary = {{"operation", "append"}, {"added-data-files", "1"}},
+        .schema_id = 1,
+    }));
+    metadata.snapshot_log.push_back({.timestamp_ms = timestamp_ms, .snapshot_id = i});
+    metadata.metadata_log.push_back(
+        {.timestamp_ms = timestamp_ms,
+         .metadata_file = std::format("s3://bucket/path/metadata/{}.metadata.json", i)});
+  }
+  metadata.refs["main"] = std::make_shared<SnapshotRef>(
+      SnapshotRef{.snapshot_id = 10000, .retention = SnapshotRef::Branch{}});
+
+  auto file = io_->NewOutputFile(temp_filepath_);
+  ASSERT_THAT(file, IsOk());
+  ASSERT_THAT(WriteJson(metadata, **file), IsOk());
+  ASSERT_THAT((*file)->Close(), IsOk());
+
+  auto content = io_->ReadFile(temp_filepath_, std::nullopt);
+  ASSERT_THAT(content, IsOk());
+  auto json = FromJsonString(content.value());
+  ASSERT_THAT(json, IsOk());
+  EXPECT_EQ(json.value(), ToJson(metadata));
+}
+
+TEST(MetadataCodecTest, CodecFromFileName) {
+  EXPECT_THAT(TableMetadataUtil::CodecFromFileName("v1.metadata.json"),
+              HasValue(::testing::Eq(MetadataFileCodecType::kNone)));
+  EXPECT_THAT(TableMetadataUtil::CodecFromFileName("v1.gz.metadata.json"),
+              HasValue(::testing::Eq(MetadataFileCodecType::kGzip)));
+  EXPECT_THAT(TableMetadataUtil::CodecFromFileName("v1.metadata.json.gz"),
+              HasValue(::testing::Eq(MetadataFileCodecType::kGzip)));
+  EXPECT_THAT(TableMetadataUtil::CodecFromFileName("v1.json"),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST(MetadataCodecTest, CodecFromName) {
+  for (auto codec_type : {MetadataFileCodecType::kNone, MetadataFileCodecType::kGzip}) {
+    EXPECT_THAT(
+        TableMetadataUtil::CodecFromFileName(
+            std::format("v1{}", TableMetadataUtil::FileExtension(codec_type))),
+        HasValue(::testing::Eq(codec_type)));
+  }
+  EXPECT_THAT(TableMetadataUtil::CodecFromName("none"),
+              HasValue(::testing::Eq(MetadataFileCodecType::kNone)));
+  EXPECT_THAT(TableMetadataUtil::CodecFromName("GZIP"),
+              HasValue(::testing::Eq(MetadataFileCodecType::kGzip)));
+  EXPECT_THAT(TableMetadataUtil::CodecFromName("zstd"),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
 }  // namespace iceberg
@@ -19,9 +19,14 @@
 
 #include <optional>
 #include <string>
+#include <vector>
 
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
 
+#include "iceberg/compact_snapshots.h"
+#include "iceberg/json_internal.h"
 #include "iceberg/partition_field.h"
 #include "iceberg/partition_spec.h"
 #include "iceberg/schema.h"
@@ -412,4 +417,101 @@ TEST(MetadataSerdeTest, DeserializeV2MissingSortOrder) {
                                "sort-orders must exist");
 }
 
+TEST(MetadataSerdeTest, DeserializeJsonString) {
+  for (const auto* file_name :
+       {"TableMetadataV1Valid.json", "TableMetadataV2Valid.json",
+        "TableMetadataV2ValidMinimal.json", "TableMetadataStatisticsFiles.json",
+        "TableMetadataPartitionStatisticsFiles.json"}) {
+    std::unique_ptr<TableMetadata> expected;
+    ASSERT_NO_FATAL_FAILURE(ReadTableMetadata(file_name, &expected));
+    std::string json_string;
+    ASSERT_NO_FATAL_FAILURE(ReadJsonFile(file_name, &json_string));
+    auto metadata = TableMetadataFromJsonString(json_string);
+    ASSERT_THAT(metadata, IsOk()) << file_name;
+    EXPECT_EQ(*metadata.value(), *expected) << file_name;
+  }
+
+  EXPECT_THAT(TableMetadataFromJsonString("{\"format-version\": 2"),
+              IsError(ErrorKind::kJsonParseError));
+  std::string json_string;
+  ASSERT_NO_FATAL_FAILURE(ReadJsonFile("TableMetadataV2Valid.json", &json_string));
+  auto json = nlohmann::json::parse(json_string);
+  json["snapshots"][0].erase("timestamp-ms");
+  EXPECT_THAT(TableMetadataFromJsonString(json.dump()),
+              HasErrorMessage("Missing 'timestamp-ms'"));
+}
+
+TEST(MetadataSerdeTest, DeserializeOnlyReferencedSnapshots) {
+  std::string json_string;
+  ASSERT_NO_FATAL_FAILURE(ReadJsonFile("TableMetadataV2Valid.json", &json_string));
+  auto json = nlohmann::json::parse(json_string);
+  // A snapshot of an expired branch, whose parent is referenced.
+  auto orphan = json["snapshots"][1];
+  orphan["snapshot-id"] = 42;
+  orphan["parent-snapshot-id"] = 3051729675574597004;
+  json["snapshots"].push_back(orphan);
+  json_string = json.dump();
+
+  auto snapshot_ids = [](const TableMetadata& metadata) {
+    std::vector<int64_t> ids;
+    for (const auto& snapshot : metadata.snapshots) {
+      ids.push_back(snapshot->snapshot_id);
+    }
+    return ids;
+  };
+  auto all = TableMetadataFromJsonString(json_string);
+  ASSERT_THAT(all, IsOk());
+  EXPECT_THAT(snapshot_ids(*all.value()),
+              ::testing::ElementsAre(3051729675574597004, 3055729675574597004, 42));
+  auto referenced =
+      TableMetadataFromJsonString(json_string, {.only_referenced_snapshots = true});
+  ASSERT_THAT(referenced, IsOk());
+  EXPECT_THAT(snapshot_ids(*referenced.value()),
+              ::testing::ElementsAre(3051729675574597004, 3055729675574597004));
+  EXPECT_EQ(referenced.value()->snapshot_log, all.value()->snapshot_log);
+}
+
+TEST(MetadataSerdeTest, DeserializeLazySnapshots) {
+  std::string json_string;
+  ASSERT_NO_FATAL_FAILURE(ReadJsonFile("TableMetadataV2Valid.json", &json_string));
+  auto eager = TableMetadataFromJsonString(json_string);
+  ASSERT_THAT(eager, IsOk());
+  auto lazy = TableMetadataFromJsonString(json_string, {.lazy_snapshots = true});
+  ASSERT_THAT(lazy, IsOk());
+
+  const auto& metadata = *lazy.value();
+  EXPECT_TRUE(metadata.snapshots.empty());
+  ASSERT_NE(metadata.compact_snapshots, nullptr);
+  const auto& compact = *metadata.compact_snapshots;
+  ASSERT_EQ(compact.size(), 2);
+  EXPECT_EQ(compact.snapshot_id(1), 3055729675574597004);
+  EXPECT_EQ(compact.parent_snapshot_id(1), 3051729675574597004);
+  EXPECT_EQ(compact.parent_snapshot_id(0), std::nullopt);
+  EXPECT_EQ(compact.Find(3051729675574597004), 0);
+  EXPECT_EQ(compact.Find(42), std::nullopt);
+
+  auto current = metadata.Snapshot();
+  ASSERT_THAT(current, IsOk());
+  EXPECT_EQ(*current.value(), *eager.value()->snapshots[1]);
+  // Materialized snapshots are reused.
+  EXPECT_EQ(metadata.SnapshotById(3055729675574597004).value(), current.value());
+  EXPECT_TRUE(metadata.HasSnapshot(3051729675574597004));
+  EXPECT_THAT(metadata.SnapshotById(42), IsError(ErrorKind::kNotFound));
+
+  auto all = metadata.AllSnapshots();
+  ASSERT_THAT(all, IsOk());
+  ASSERT_EQ(all->size(), 2);
+  EXPECT_EQ(*all.value()[0], *eager.value()->snapshots[0]);
+  EXPECT_EQ(metadata, *eager.value());
+  // Compact snapshots are serialized as they were read.
+  auto round_trip = TableMetadataFromJson(ToJson(metadata));
+  ASSERT_THAT(round_trip, IsOk());
+  EXPECT_EQ(*round_trip.value(), *eager.value());
+
+  auto referenced = TableMetadataFromJsonString(
+      json_string, {.only_referenced_snapshots = true, .lazy_snapshots = true});
+  ASSERT_THAT(referenced, IsOk());
+  EXPECT_EQ(referenced.value()->compact_snapshots->size(), 2);
+}
+
 }  // namespace iceberg
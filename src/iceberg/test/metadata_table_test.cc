@@ -0,0 +1,214 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/metadata_table.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <nanoarrow/nanoarrow.h>
+
+#include "iceberg/fast_append.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/test/delete_data_files.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/test/table_test_base.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+class MetadataTableTest : public TableTestBase {
+ protected:
+  void SetUp() override {
+    TableTestBase::SetUp();
+    ASSERT_NO_FATAL_FAILURE(CreateTable());
+  }
+
+  int64_t Append(const std::vector<std::string>& paths) {
+    FastAppend append(table_);
+    for (const auto& path : paths) {
+      append.AppendFile(std::make_shared<DataFile>(DataFile{
+          .file_path = path,
+          .file_format = FileFormatType::kParquet,
+          .record_count = 10,
+          .file_size_in_bytes = 100,
+      }));
+    }
+    EXPECT_THAT(append.Commit(), IsOk());
+    return append.snapshot_id();
+  }
+
+  int64_t Delete(const std::string& path) {
+    DeleteDataFiles delete_files(table_, {path});
+    EXPECT_THAT(delete_files.Commit(), IsOk());
+    return delete_files.snapshot_id();
+  }
+
+  // Reads the values of a top-level column, or of a field of a top-level struct column,
+  // of a metadata table, formatted as strings with nulls as "null".
+  std::vector<std::string> ReadColumn(MetadataTableType type,
+                                      const std::vector<std::string>& path) {
+    std::vector<std::string> values;
+    auto scan = MetadataTableScan::Make(type, table_->metadata(), file_io_);
+    EXPECT_THAT(scan, IsOk());
+    auto stream_result = (*scan)->ToArrow();
+    EXPECT_THAT(stream_result, IsOk());
+    ArrowArrayStream stream = std::move(stream_result.value());
+
+    ArrowSchema schema;
+    EXPECT_EQ(stream.get_schema(&stream, &schema), 0);
+    ArrowArrayView view;
+    EXPECT_EQ(ArrowArrayViewInitFromSchema(&view, &schema, nullptr), NANOARROW_OK);
+    const ArrowSchema* column_schema = &schema;
+    std::vector<int64_t> indices;
+    for (const auto& name : path) {
+      int64_t index = 0;
+      while (index < column_schema->n_children &&
+             column_schema->children[index]->name != name) {
+        ++index;
+      }
+      EXPECT_LT(index, column_schema->n_children) << name;
+      indices.push_back(index);
+      column_schema = column_schema->children[index];
+    }
+    const bool is_string = std::string_view(column_schema->format) == "u";
+
+    while (true) {
+      ArrowArray batch;
+      EXPECT_EQ(stream.get_next(&stream, &batch), 0) << stream.get_last_error(&stream);
+      if (batch.release == nullptr) {
+        break;
+      }
+      EXPECT_EQ(ArrowArrayViewSetArray(&view, &batch, nullptr), NANOARROW_OK);
+      const ArrowArrayView* column = &view;
+      for (auto index : indices) {
+        column = column->children[index];
+      }
+      for (int64_t row = 0; row < column->length; ++row) {
+        if (ArrowArrayViewIsNull(column, row)) {
+          values.emplace_back("null");
+        } else if (is_string) {
+          auto value = ArrowArrayViewGetStringUnsafe(column, row);
+          values.emplace_back(value.data, value.size_bytes);
+        } else {
+          values.push_back(std::to_string(ArrowArrayViewGetIntUnsafe(column, row)));
+        }
+      }
+      ArrowArrayRelease(&batch);
+    }
+    ArrowArrayViewReset(&view);
+    ArrowSchemaRelease(&schema);
+    stream.release(&stream);
+    std::ranges::sort(values);
+    return values;
+  }
+};
+
+TEST(MetadataTableTypeTest, ParsesNames) {
+  for (auto type : {MetadataTableType::kEntries, MetadataTableType::kFiles,
+                    MetadataTableType::kAllDataFiles, MetadataTableType::kManifests,
+                    MetadataTableType::kPartitions, MetadataTableType::kSnapshots,
+                    MetadataTableType::kHistory}) {
+    EXPECT_THAT(MetadataTableTypeFromString(ToString(type)),
+                HasValue(::testing::Eq(type)));
+  }
+  EXPECT_THAT(MetadataTableTypeFromString("FILES"),
+              HasValue(::testing::Eq(MetadataTableType::kFiles)));
+  EXPECT_THAT(MetadataTableTypeFromString("metadata_log_entries"),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(MetadataTableTest, EmptyTable) {
+  for (auto type : {MetadataTableType::kEntries, MetadataTableType::kFiles,
+                    MetadataTableType::kManifests, MetadataTableType::kSnapshots}) {
+    auto scan = MetadataTableScan::Make(type, table_->metadata(), file_io_);
+    ASSERT_THAT(scan, IsOk());
+    ICEBERG_UNWRAP_OR_FAIL(auto stream, (*scan)->ToArrow());
+    ArrowArray batch;
+    ASSERT_EQ(stream.get_next(&stream, &batch), 0);
+    EXPECT_EQ(batch.release, nullptr) << ToString(type);
+    stream.release(&stream);
+  }
+}
+
+TEST_F(MetadataTableTest, SnapshotsAndHistory) {
+  auto first = Append({"/data/a.parquet"});
+  auto second = Append({"/data/b.parquet"});
+
+  EXPECT_EQ(ReadColumn(MetadataTableType::kSnapshots, {"snapshot_id"}),
+            (std::vector<std::string>{std::to_string(first), std::to_string(second)}));
+  EXPECT_EQ(ReadColumn(MetadataTableType::kSnapshots, {"parent_id"}),
+            (std::vector<std::string>{"null", std::to_string(first)}));
+  EXPECT_EQ(ReadColumn(MetadataTableType::kSnapshots, {"operation"}),
+            (std::vector<std::string>{"append", "append"}));
+  EXPECT_EQ(ReadColumn(MetadataTableType::kHistory, {"snapshot_id"}),
+            (std::vector<std::string>{std::to_string(first), std::to_string(second)}));
+  EXPECT_EQ(ReadColumn(MetadataTableType::kHistory, {"is_current_ancestor"}),
+            (std::vector<std::string>{"1", "1"}));
+}
+
+TEST_F(MetadataTableTest, ManifestsOfCurrentSnapshot) {
+  auto first = Append({"/data/a.parquet"});
+  auto second = Append({"/data/b.parquet", "/data/c.parquet"});
+
+  EXPECT_EQ(ReadColumn(MetadataTableType::kManifests, {"added_snapshot_id"}),
+            (std::vector<std::string>{std::to_string(first), std::to_string(second)}));
+  EXPECT_EQ(ReadColumn(MetadataTableType::kManifests, {"added_files_count"}),
+            (std::vector<std::string>{"1", "2"}));
+}
+
+TEST_F(MetadataTableTest, EntriesInheritSnapshotIdAndSequenceNumber) {
+  auto first = Append({"/data/a.parquet"});
+  auto second = Append({"/data/b.parquet"});
+
+  EXPECT_EQ(ReadColumn(MetadataTableType::kEntries, {"data_file", "file_path"}),
+            (std::vector<std::string>{"/data/a.parquet", "/data/b.parquet"}));
+  EXPECT_EQ(ReadColumn(MetadataTableType::kEntries, {"snapshot_id"}),
+            (std::vector<std::string>{std::to_string(first), std::to_string(second)}));
+  EXPECT_EQ(ReadColumn(MetadataTableType::kEntries, {"sequence_number"}),
+            (std::vector<std::string>{"1", "2"}));
+}
+
+TEST_F(MetadataTableTest, FilesExcludeDeletedEntries) {
+  Append({"/data/a.parquet", "/data/b.parquet"});
+  Append({"/data/c.parquet"});
+  Delete("/data/a.parquet");
+
+  EXPECT_EQ(ReadColumn(MetadataTableType::kEntries, {"status"}),
+            (std::vector<std::string>{"0", "1", "2"}));
+  EXPECT_EQ(ReadColumn(MetadataTableType::kFiles, {"file_path"}),
+            (std::vector<std::string>{"/data/b.parquet", "/data/c.parquet"}));
+  EXPECT_EQ(ReadColumn(MetadataTableType::kFiles, {"record_count"}),
+            (std::vector<std::string>{"10", "10"}));
+  // The deleted file is still referenced by the manifests of older snapshots.
+  EXPECT_EQ(ReadColumn(MetadataTableType::kAllDataFiles, {"file_path"}),
+            (std::vector<std::string>{"/data/a.parquet", "/data/b.parquet",
+                                      "/data/b.parquet", "/data/c.parquet"}));
+}
+
+}  // namespace iceberg
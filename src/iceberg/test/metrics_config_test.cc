@@ -0,0 +1,102 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/metrics_config.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/schema.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+TEST(MetricsModeTest, FromString) {
+  EXPECT_EQ(MetricsMode::FromString("none"), MetricsMode::None());
+  EXPECT_EQ(MetricsMode::FromString("Counts"), MetricsMode::Counts());
+  EXPECT_EQ(MetricsMode::FromString("FULL"), MetricsMode::Full());
+  EXPECT_EQ(MetricsMode::FromString("truncate(8)"), MetricsMode::Truncate(8));
+  EXPECT_EQ(MetricsMode::Truncate(8).ToString(), "truncate(8)");
+
+  for (const auto* mode : {"", "all", "truncate", "truncate()", "truncate(0)",
+                           "truncate(-1)", "truncate(8"}) {
+    EXPECT_THAT(MetricsMode::FromString(mode), IsError(ErrorKind::kInvalidArgument))
+        << mode;
+  }
+}
+
+TEST(MetricsConfigTest, ColumnModes) {
+  Schema schema({
+      SchemaField::MakeRequired(1, "id", int64()),
+      SchemaField::MakeOptional(2, "name", string()),
+      SchemaField::MakeOptional(
+          3, "location", struct_({SchemaField::MakeOptional(4, "lat", float64())})),
+  });
+
+  EXPECT_EQ(MetricsConfig::Default().ColumnMode(1), MetricsMode::Truncate(16));
+
+  auto config = MetricsConfig::Make({{"write.metadata.metrics.default", "counts"},
+                                     {"write.metadata.metrics.column.name", "full"},
+                                     {"write.metadata.metrics.column.location.lat",
+                                      "none"},
+                                     {"write.metadata.metrics.column.dropped", "full"}},
+                                    schema);
+  ASSERT_THAT(config, IsOk());
+  EXPECT_EQ(config->ColumnMode(1), MetricsMode::Counts());
+  EXPECT_EQ(config->ColumnMode(2), MetricsMode::Full());
+  EXPECT_EQ(config->ColumnMode(4), MetricsMode::None());
+
+  EXPECT_THAT(MetricsConfig::Make(
+                  {{"write.metadata.metrics.column.name", "truncate(x)"}}, schema),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST(MetricsConfigTest, MaxInferredColumnDefaults) {
+  Schema schema({
+      SchemaField::MakeRequired(
+          1, "point", struct_({SchemaField::MakeRequired(2, "x", float64()),
+                               SchemaField::MakeRequired(3, "y", float64())})),
+      SchemaField::MakeRequired(4, "id", int64()),
+  });
+
+  // The first primitive columns up to the limit keep the default mode.
+  auto config = MetricsConfig::Make(
+      {{"write.metadata.metrics.max-inferred-column-defaults", "1"}}, schema);
+  ASSERT_THAT(config, IsOk());
+  EXPECT_EQ(config->ColumnMode(2), MetricsMode::Truncate(16));
+  EXPECT_EQ(config->ColumnMode(3), MetricsMode::None());
+  EXPECT_EQ(config->ColumnMode(4), MetricsMode::None());
+
+  // An explicit default mode applies to all columns.
+  config = MetricsConfig::Make(
+      {{"write.metadata.metrics.max-inferred-column-defaults", "1"},
+       {"write.metadata.metrics.default", "full"}},
+      schema);
+  ASSERT_THAT(config, IsOk());
+  EXPECT_EQ(config->ColumnMode(4), MetricsMode::Full());
+
+  config = MetricsConfig::Make({}, schema);
+  ASSERT_THAT(config, IsOk());
+  EXPECT_EQ(config->ColumnMode(4), MetricsMode::Truncate(16));
+}
+
+}  // namespace iceberg
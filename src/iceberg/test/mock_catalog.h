@@ -78,6 +78,9 @@ class MockCatalog : public Catalog {
   MOCK_METHOD((Result<std::unique_ptr<Table>>), LoadTable, (const TableIdentifier&),
               (override));
 
+  MOCK_METHOD(Result<std::string>, GetTableMetadataLocation, (const TableIdentifier&),
+              (const, override));
+
   MOCK_METHOD((Result<std::shared_ptr<Table>>), RegisterTable,
               (const TableIdentifier&, const std::string&), (override));
 
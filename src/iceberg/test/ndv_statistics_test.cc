@@ -0,0 +1,273 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/puffin/ndv_statistics.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/file_io.h"
+#include "iceberg/puffin/theta_sketch.h"
+#include "iceberg/schema.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief A FileIO that keeps the written files in memory.
+class InMemoryFileIO : public FileIO {
+ public:
+  Result<std::string> ReadFile(const std::string& file_location,
+                               std::optional<size_t> length) override {
+    auto it = files.find(file_location);
+    if (it == files.end()) {
+      return NotFound("File {} does not exist", file_location);
+    }
+    return it->second;
+  }
+
+  Status WriteFile(const std::string& file_location, std::string_view content) override {
+    files[file_location] = std::string(content);
+    return {};
+  }
+
+  std::map<std::string, std::string> files;
+};
+
+/// \brief An Arrow array over buffers owned by the test.
+struct TestArray {
+  ArrowArray array{};
+  std::vector<const void*> buffers;
+  std::vector<ArrowArray*> children;
+
+  TestArray(int64_t length, int64_t null_count, std::vector<const void*> buffers,
+            std::vector<ArrowArray*> children = {}, int64_t offset = 0)
+      : buffers(std::move(buffers)), children(std::move(children)) {
+    array.length = length;
+    array.null_count = null_count;
+    array.offset = offset;
+    array.n_buffers = static_cast<int64_t>(this->buffers.size());
+    array.n_children = static_cast<int64_t>(this->children.size());
+    array.buffers = this->buffers.data();
+    array.children = this->children.data();
+  }
+};
+
+std::string IntValue(int32_t value) {
+  return {reinterpret_cast<const char*>(&value), sizeof(value)};
+}
+
+}  // namespace
+
+TEST(ThetaSketchTest, ExactMode) {
+  ThetaSketch sketch;
+  EXPECT_TRUE(sketch.IsEmpty());
+  EXPECT_EQ(sketch.Estimate(), 0);
+  for (int round = 0; round < 3; ++round) {
+    for (int32_t i = 0; i < 1000; ++i) {
+      sketch.Update(IntValue(i));
+    }
+  }
+  EXPECT_FALSE(sketch.IsEmpty());
+  EXPECT_FALSE(sketch.IsEstimationMode());
+  EXPECT_EQ(sketch.Estimate(), 1000);
+  EXPECT_EQ(sketch.num_retained(), 1000);
+}
+
+TEST(ThetaSketchTest, EstimationMode) {
+  ThetaSketch sketch;
+  for (int32_t i = 0; i < 100000; ++i) {
+    sketch.Update(IntValue(i));
+  }
+  EXPECT_TRUE(sketch.IsEstimationMode());
+  EXPECT_EQ(sketch.num_retained(), ThetaSketch::kDefaultNominalEntries);
+  EXPECT_NEAR(sketch.Estimate(), 100000, 100000 * 0.05);
+}
+
+TEST(ThetaSketchTest, Merge) {
+  ThetaSketch left;
+  ThetaSketch right;
+  for (int32_t i = 0; i < 60000; ++i) {
+    left.Update(IntValue(i));
+    right.Update(IntValue(i + 40000));
+  }
+  left.Merge(right);
+  EXPECT_NEAR(left.Estimate(), 100000, 100000 * 0.05);
+
+  ThetaSketch empty;
+  empty.Merge(ThetaSketch());
+  EXPECT_TRUE(empty.IsEmpty());
+}
+
+TEST(ThetaSketchTest, CompactSerialization) {
+  // An empty sketch is a single preamble long, with the hash of the default seed.
+  const auto empty = ThetaSketch().Serialize();
+  ASSERT_EQ(empty.size(), 8);
+  EXPECT_EQ(empty[0], 1);
+  EXPECT_EQ(empty[1], 3);
+  EXPECT_EQ(empty[2], 3);
+  EXPECT_EQ(static_cast<uint8_t>(empty[6]), 0xCC);
+  EXPECT_EQ(static_cast<uint8_t>(empty[7]), 0x93);
+  ICEBERG_UNWRAP_OR_FAIL(auto empty_sketch, ThetaSketch::Deserialize(empty));
+  EXPECT_TRUE(empty_sketch.IsEmpty());
+
+  ThetaSketch single;
+  single.Update("a");
+  EXPECT_EQ(single.Serialize().size(), 16);
+
+  ThetaSketch exact;
+  for (int32_t i = 0; i < 100; ++i) {
+    exact.Update(IntValue(i));
+  }
+  EXPECT_EQ(exact.Serialize().size(), 16 + 100 * 8);
+
+  ThetaSketch estimated;
+  for (int32_t i = 0; i < 50000; ++i) {
+    estimated.Update(IntValue(i));
+  }
+  const auto data = estimated.Serialize();
+  EXPECT_EQ(data.size(), 24 + ThetaSketch::kDefaultNominalEntries * 8);
+  for (const auto& sketch : {single, exact, estimated}) {
+    ICEBERG_UNWRAP_OR_FAIL(auto copy, ThetaSketch::Deserialize(sketch.Serialize()));
+    EXPECT_EQ(copy.Estimate(), sketch.Estimate());
+    EXPECT_EQ(copy.theta(), sketch.theta());
+  }
+
+  EXPECT_THAT(ThetaSketch::Deserialize(data.substr(0, 100)),
+              IsError(ErrorKind::kInvalidArgument));
+  auto other_seed = data;
+  other_seed[6] = 0;
+  EXPECT_THAT(ThetaSketch::Deserialize(other_seed), HasErrorMessage("seed"));
+  auto not_compact = data;
+  not_compact[2] = 2;
+  EXPECT_THAT(ThetaSketch::Deserialize(not_compact), IsError(ErrorKind::kNotSupported));
+}
+
+TEST(NdvSketchCollectorTest, CollectColumns) {
+  Schema schema({SchemaField::MakeRequired(1, "id", int32()),
+                 SchemaField::MakeOptional(2, "name", string()),
+                 SchemaField::MakeOptional(
+                     3, "point",
+                     std::make_shared<StructType>(std::vector<SchemaField>{
+                         SchemaField::MakeOptional(4, "x", float64())})),
+                 SchemaField::MakeOptional(
+                     5, "tags", std::make_shared<ListType>(SchemaField::MakeOptional(
+                                    6, "element", string())))});
+  ICEBERG_UNWRAP_OR_FAIL(auto collector, NdvSketchCollector::Make(schema));
+  // The values of lists are not the values of a column.
+  EXPECT_THAT(collector.field_ids(), ::testing::ElementsAre(1, 2, 4));
+  EXPECT_THAT(NdvSketchCollector::Make(schema, std::vector<int32_t>{6}),
+              IsError(ErrorKind::kInvalidArgument));
+
+  // Rows 1 to 4 of 5 rows: the second name is null, and so is the third point.
+  const int32_t ids[] = {0, 1, 2, 1, 2};
+  const int32_t offsets[] = {0, 1, 2, 2, 3, 4};
+  const char names[] = "abab";
+  const uint8_t name_validity[] = {0b11011};
+  const double xs[] = {0, 1.5, 1.5, 7, 2.5};
+  const uint8_t point_validity[] = {0b10111};
+  const int32_t tag_offsets[] = {0, 0, 0, 0, 0, 0};
+  TestArray id_array(5, 0, {nullptr, ids});
+  TestArray name_array(5, 1, {name_validity, offsets, names});
+  TestArray x_array(5, 0, {nullptr, xs});
+  TestArray point_array(5, 1, {point_validity}, {&x_array.array});
+  TestArray tag_values(0, 0, {nullptr, tag_offsets, names});
+  TestArray tag_array(5, 0, {nullptr, tag_offsets}, {&tag_values.array});
+  TestArray root(4, 0, {nullptr},
+                 {&id_array.array, &name_array.array, &point_array.array,
+                  &tag_array.array},
+                 /*offset=*/1);
+  ASSERT_THAT(collector.Update(root.array), IsOk());
+  ASSERT_EQ(collector.sketches().size(), 3);
+  EXPECT_EQ(collector.sketches()[0].Estimate(), 2);
+  EXPECT_EQ(collector.sketches()[1].Estimate(), 2);
+  EXPECT_EQ(collector.sketches()[2].Estimate(), 2);
+
+  auto other = collector;
+  ASSERT_THAT(other.Update(root.array), IsOk());
+  ASSERT_THAT(collector.Merge(other), IsOk());
+  EXPECT_EQ(collector.sketches()[0].Estimate(), 2);
+  ICEBERG_UNWRAP_OR_FAIL(auto ids_only,
+                         NdvSketchCollector::Make(schema, std::vector<int32_t>{1}));
+  EXPECT_THAT(collector.Merge(ids_only), IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST(NdvStatisticsTest, WriteAndReadStatistics) {
+  Schema schema({SchemaField::MakeRequired(1, "id", int64()),
+                 SchemaField::MakeRequired(2, "bucket", int64())});
+  ICEBERG_UNWRAP_OR_FAIL(auto collector, NdvSketchCollector::Make(schema));
+  std::vector<int64_t> ids(20000);
+  std::vector<int64_t> buckets(ids.size());
+  for (size_t i = 0; i < ids.size(); ++i) {
+    ids[i] = static_cast<int64_t>(i);
+    buckets[i] = static_cast<int64_t>(i % 10);
+  }
+  TestArray id_array(ids.size(), 0, {nullptr, ids.data()});
+  TestArray bucket_array(ids.size(), 0, {nullptr, buckets.data()});
+  TestArray root(ids.size(), 0, {nullptr}, {&id_array.array, &bucket_array.array});
+  ASSERT_THAT(collector.Update(root.array), IsOk());
+
+  auto io = std::make_shared<InMemoryFileIO>();
+  ICEBERG_UNWRAP_OR_FAIL(auto file, io->NewOutputFile("s3://bucket/stats.puffin"));
+  ICEBERG_UNWRAP_OR_FAIL(auto statistics_file,
+                         WriteNdvStatistics(collector, std::move(file), 7, 3));
+  EXPECT_EQ(statistics_file.snapshot_id, 7);
+  EXPECT_EQ(statistics_file.path, "s3://bucket/stats.puffin");
+  EXPECT_EQ(statistics_file.file_size_in_bytes,
+            io->files.at("s3://bucket/stats.puffin").size());
+  ASSERT_EQ(statistics_file.blob_metadata.size(), 2);
+  EXPECT_EQ(statistics_file.blob_metadata[1].type, "apache-datasketches-theta-v1");
+  EXPECT_EQ(statistics_file.blob_metadata[1].source_snapshot_sequence_number, 3);
+  EXPECT_THAT(statistics_file.blob_metadata[1].fields, ::testing::ElementsAre(2));
+  EXPECT_EQ(statistics_file.blob_metadata[1].properties.at("ndv"), "10");
+
+  TableMetadata metadata;
+  metadata.statistics.push_back(std::make_shared<StatisticsFile>(statistics_file));
+  auto estimates = NdvEstimates(metadata, 7);
+  ASSERT_EQ(estimates.size(), 2);
+  EXPECT_NEAR(estimates.at(1), 20000, 20000 * 0.05);
+  EXPECT_EQ(estimates.at(2), 10);
+  EXPECT_TRUE(NdvEstimates(metadata, 8).empty());
+
+  ICEBERG_UNWRAP_OR_FAIL(auto sketches, ReadNdvSketches(*io, statistics_file));
+  ASSERT_EQ(sketches.size(), 2);
+  EXPECT_EQ(sketches.at(1).Estimate(), collector.sketches()[0].Estimate());
+  EXPECT_EQ(sketches.at(2).Estimate(), 10);
+}
+
+TEST(NdvStatisticsTest, ComputeWithoutTasks) {
+  Schema schema({SchemaField::MakeRequired(1, "id", int64())});
+  auto io = std::make_shared<InMemoryFileIO>();
+  ICEBERG_UNWRAP_OR_FAIL(auto collector, ComputeNdvSketches({}, io, schema, {}, 4));
+  ASSERT_EQ(collector.sketches().size(), 1);
+  EXPECT_TRUE(collector.sketches()[0].IsEmpty());
+  EXPECT_THAT(ComputeNdvSketches({}, io, schema, {}, 0),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+}  // namespace iceberg
@@ -0,0 +1,212 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <arrow/array.h>
+#include <arrow/c/bridge.h>
+#include <arrow/json/from_string.h>
+#include <arrow/type.h>
+
+#include "iceberg/arrow/arrow_fs_file_io_internal.h"
+#include "iceberg/arrow/arrow_status_internal.h"
+#include "iceberg/deletes/position_delete_index.h"
+#include "iceberg/file_reader.h"
+#include "iceberg/file_writer.h"
+#include "iceberg/orc/orc_register.h"
+#include "iceberg/result.h"
+#include "iceberg/schema.h"
+#include "iceberg/schema_field.h"
+#include "iceberg/schema_internal.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/type.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg::orc {
+
+class OrcReadWrite : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() { orc::RegisterAll(); }
+
+  void SetUp() override {
+    file_io_ = arrow::ArrowFileSystemFileIO::MakeMockFileIO();
+    schema_ = std::make_shared<Schema>(
+        std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32()),
+                                 SchemaField::MakeOptional(2, "name", string())});
+  }
+
+  std::shared_ptr<::arrow::Array> MakeArray(const Schema& schema,
+                                            std::string_view json) {
+    ArrowSchema arrow_c_schema;
+    EXPECT_THAT(ToArrowSchema(schema, &arrow_c_schema), IsOk());
+    auto arrow_schema = ::arrow::ImportType(&arrow_c_schema).ValueOrDie();
+    return ::arrow::json::ArrayFromJSONString(::arrow::struct_(arrow_schema->fields()),
+                                              json)
+        .ValueOrDie();
+  }
+
+  // Writes every batch to the file, and returns the closed writer.
+  Result<std::unique_ptr<Writer>> WriteBatches(
+      const std::vector<std::string>& batches,
+      std::unordered_map<std::string, std::string> properties = {}) {
+    ICEBERG_ASSIGN_OR_RAISE(auto writer,
+                            WriterFactoryRegistry::Open(FileFormatType::kOrc,
+                                                        {.path = path_,
+                                                         .schema = schema_,
+                                                         .io = file_io_,
+                                                         .properties = properties}));
+    for (const auto& batch : batches) {
+      ArrowArray array;
+      ICEBERG_ARROW_RETURN_NOT_OK(
+          ::arrow::ExportArray(*MakeArray(*schema_, batch), &array));
+      ICEBERG_RETURN_UNEXPECTED(writer->Write(&array));
+    }
+    ICEBERG_RETURN_UNEXPECTED(writer->Close());
+    return writer;
+  }
+
+  // Reads all batches of the file into one JSON-comparable array.
+  void VerifyRead(const ReaderOptions& options, std::string_view expected_json) {
+    ICEBERG_UNWRAP_OR_FAIL(auto reader,
+                           ReaderFactoryRegistry::Open(FileFormatType::kOrc, options));
+    ICEBERG_UNWRAP_OR_FAIL(auto arrow_c_schema, reader->Schema());
+    auto arrow_schema = ::arrow::ImportType(&arrow_c_schema).ValueOrDie();
+
+    ::arrow::ArrayVector chunks;
+    while (true) {
+      ICEBERG_UNWRAP_OR_FAIL(auto batch, reader->Next());
+      if (!batch.has_value()) {
+        break;
+      }
+      chunks.push_back(::arrow::ImportArray(&batch.value(), arrow_schema).ValueOrDie());
+    }
+    ASSERT_THAT(reader->Close(), IsOk());
+
+    auto expected =
+        ::arrow::json::ArrayFromJSONString(arrow_schema, expected_json).ValueOrDie();
+    ::arrow::ChunkedArray actual(chunks, arrow_schema);
+    ASSERT_TRUE(actual.Equals(::arrow::ChunkedArray(expected)))
+        << actual.ToString() << " vs " << expected->ToString();
+  }
+
+  std::shared_ptr<FileIO> file_io_;
+  std::shared_ptr<Schema> schema_;
+  std::string path_ = "orc_test.orc";
+};
+
+TEST_F(OrcReadWrite, RoundTrip) {
+  ICEBERG_UNWRAP_OR_FAIL(auto writer,
+                         WriteBatches({R"([[1, "Foo"], [2, null], [3, "Baz"]])"}));
+  ASSERT_TRUE(writer->length().has_value());
+  EXPECT_EQ(writer->split_offsets().size(), 1);
+  ASSERT_TRUE(writer->metrics().has_value());
+  EXPECT_EQ(writer->metrics()->row_count, 3);
+
+  ASSERT_NO_FATAL_FAILURE(VerifyRead(
+      {.path = path_, .length = writer->length(), .io = file_io_, .projection = schema_},
+      R"([[1, "Foo"], [2, null], [3, "Baz"]])"));
+}
+
+TEST_F(OrcReadWrite, ReadProjection) {
+  ICEBERG_UNWRAP_OR_FAIL(auto writer,
+                         WriteBatches({R"([[1, "Foo"], [2, "Bar"], [3, "Baz"]])"}));
+
+  // Columns are matched by name, promoted and reordered, and missing optional fields
+  // are read as nulls.
+  auto projection = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeOptional(3, "score", float64()),
+                               SchemaField::MakeOptional(2, "name", string()),
+                               SchemaField::MakeRequired(1, "id", int64())});
+  ASSERT_NO_FATAL_FAILURE(VerifyRead(
+      {.path = path_, .io = file_io_, .projection = projection},
+      R"([[null, "Foo", 1], [null, "Bar", 2], [null, "Baz", 3]])"));
+}
+
+TEST_F(OrcReadWrite, ReadSplit) {
+  // A stripe is flushed after every batch, so each batch is in its own stripe.
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto writer, WriteBatches({R"([[1, "a"], [2, "b"]])", R"([[3, "c"]])"},
+                                {{"write.orc.stripe-size-bytes", "1"}}));
+  auto split_offsets = writer->split_offsets();
+  ASSERT_EQ(split_offsets.size(), 2);
+  const auto first = static_cast<size_t>(split_offsets[0]);
+  const auto second = static_cast<size_t>(split_offsets[1]);
+
+  std::vector<Split> splits = {
+      {.offset = 0, .length = std::numeric_limits<size_t>::max()},
+      {.offset = first, .length = second - first},
+      {.offset = second, .length = 1},
+      {.offset = second + 1, .length = std::numeric_limits<size_t>::max()},
+  };
+  std::vector<std::string> expected_json = {
+      R"([[1, "a"], [2, "b"], [3, "c"]])",
+      R"([[1, "a"], [2, "b"]])",
+      R"([[3, "c"]])",
+      "[]",
+  };
+  for (size_t i = 0; i < splits.size(); ++i) {
+    ASSERT_NO_FATAL_FAILURE(VerifyRead(
+        {.path = path_, .split = splits[i], .io = file_io_, .projection = schema_},
+        expected_json[i]));
+  }
+}
+
+TEST_F(OrcReadWrite, ReadWithPositionDeletes) {
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto writer,
+      WriteBatches({R"([[1, "a"], [2, "b"], [3, "c"]])", R"([[4, "d"], [5, "e"]])"},
+                   {{"write.orc.stripe-size-bytes", "1"}}));
+
+  // The second stripe is skipped, and the deleted rows of the first are dropped.
+  auto deletes = std::make_shared<PositionDeleteIndex>();
+  deletes->Delete(1);
+  deletes->Delete(3, 5);
+  ASSERT_NO_FATAL_FAILURE(VerifyRead({.path = path_,
+                                      .batch_size = 2,
+                                      .io = file_io_,
+                                      .projection = schema_,
+                                      .position_deletes = deletes},
+                                     R"([[1, "a"], [3, "c"]])"));
+}
+
+TEST_F(OrcReadWrite, WriterProperties) {
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto writer,
+      WriteBatches({R"([[1, "Foo"]])"},
+                   {{"write.orc.compression-codec", "snappy"},
+                    {"write.orc.compression-strategy", "compression"},
+                    {"write.orc.bloom.filter.columns", "id, name"},
+                    {"write.orc.bloom.filter.fpp", "0.01"}}));
+  ASSERT_NO_FATAL_FAILURE(VerifyRead(
+      {.path = path_, .io = file_io_, .projection = schema_}, R"([[1, "Foo"]])"));
+
+  EXPECT_THAT(WriteBatches({}, {{"write.orc.compression-codec", "brotli"}}),
+              IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(WriteBatches({}, {{"write.orc.stripe-size-bytes", "0"}}),
+              IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(WriteBatches({}, {{"write.orc.bloom.filter.columns", "id"},
+                                {"write.orc.bloom.filter.fpp", "1.5"}}),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+}  // namespace iceberg::orc
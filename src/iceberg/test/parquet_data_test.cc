@@ -17,6 +17,8 @@
  * under the License.
  */
 
+#include <format>
+
 #include <arrow/array.h>
 #include <arrow/c/bridge.h>
 #include <arrow/json/from_string.h>
@@ -214,6 +216,14 @@ const std::vector<ProjectRecordBatchParam> kPrimitiveTestCases = {
         .input_json = R"([{"a": "0.00"}, {"a": "10.01"}, {"a": "20.02"}])",
         .expected_json = R"([{"a": "0.00"}, {"a": "10.01"}, {"a": "20.02"}])",
     },
+    {
+        .name = "DateToTimestampPromotion",
+        .projected_type = timestamp(),
+        .source_type = date(),
+        .input_json = R"([{"a": -1}, {"a": 0}, {"a": 19358}])",
+        .expected_json =
+            R"([{"a": -86400000000}, {"a": 0}, {"a": 1672531200000000}])",
+    },
 };
 
 INSTANTIATE_TEST_SUITE_P(
@@ -503,4 +513,156 @@ TEST(ProjectRecordBatchTest, EmptyRecordBatch) {
       VerifyProjectRecordBatch(iceberg_schema, iceberg_schema, input_json, input_json));
 }
 
+TEST(ProjectRecordBatchTest, ReuseUnchangedArrays) {
+  Schema projected_schema({
+      SchemaField::MakeRequired(1, "id", int64()),
+      SchemaField::MakeRequired(2, "person",
+                                std::make_shared<StructType>(std::vector<SchemaField>{
+                                    SchemaField::MakeRequired(3, "name", string()),
+                                })),
+      SchemaField::MakeRequired(
+          5, "numbers",
+          std::make_shared<ListType>(SchemaField::MakeRequired(6, "element", int32()))),
+  });
+  Schema source_schema({
+      SchemaField::MakeRequired(1, "id", int32()),
+      SchemaField::MakeRequired(2, "person",
+                                std::make_shared<StructType>(std::vector<SchemaField>{
+                                    SchemaField::MakeRequired(3, "name", string()),
+                                    SchemaField::MakeRequired(4, "age", int32()),
+                                })),
+      SchemaField::MakeRequired(
+          5, "numbers",
+          std::make_shared<ListType>(SchemaField::MakeRequired(6, "element", int32()))),
+  });
+  auto projection = Project(projected_schema, source_schema, /*prune_source=*/false);
+  ASSERT_THAT(projection, IsOk());
+
+  ArrowSchema source_c_schema;
+  ASSERT_THAT(ToArrowSchema(source_schema, &source_c_schema), IsOk());
+  auto source_arrow_schema = ::arrow::ImportSchema(&source_c_schema).ValueOrDie();
+  ArrowSchema projected_c_schema;
+  ASSERT_THAT(ToArrowSchema(projected_schema, &projected_c_schema), IsOk());
+  auto projected_arrow_schema = ::arrow::ImportSchema(&projected_c_schema).ValueOrDie();
+  auto input = RecordBatchFromJson(source_arrow_schema, R"([
+    {"id": 1, "person": {"name": "Person0", "age": 25}, "numbers": [0, 1]},
+    {"id": 2, "person": {"name": "Person1", "age": 26}, "numbers": [2]}
+  ])");
+
+  auto result = ProjectRecordBatch(input, projected_arrow_schema, projected_schema,
+                                   projection.value(), ::arrow::default_memory_pool());
+  ASSERT_THAT(result, IsOk());
+  const auto& output = result.value();
+  // The promoted column and the pruned struct are rebuilt, others are reused.
+  EXPECT_NE(output->column(0)->data(), input->column(0)->data());
+  EXPECT_NE(output->column(1)->data(), input->column(1)->data());
+  auto input_person = std::static_pointer_cast<::arrow::StructArray>(input->column(1));
+  auto output_person = std::static_pointer_cast<::arrow::StructArray>(output->column(1));
+  EXPECT_EQ(output_person->field(0)->data(), input_person->field(0)->data());
+  EXPECT_EQ(output->column(2)->data(), input->column(2)->data());
+}
+
+TEST(ProjectRecordBatchTest, PromoteSlicedArraysWithNulls) {
+  Schema projected_schema({
+      SchemaField::MakeOptional(1, "i", int64()),
+      SchemaField::MakeOptional(2, "f", float64()),
+      SchemaField::MakeOptional(3, "d", decimal(10, 2)),
+      SchemaField::MakeOptional(4, "ts", timestamp()),
+  });
+  Schema source_schema({
+      SchemaField::MakeOptional(1, "i", int32()),
+      SchemaField::MakeOptional(2, "f", float32()),
+      SchemaField::MakeOptional(3, "d", decimal(6, 2)),
+      SchemaField::MakeOptional(4, "ts", date()),
+  });
+  auto projection = Project(projected_schema, source_schema, /*prune_source=*/false);
+  ASSERT_THAT(projection, IsOk());
+
+  ArrowSchema source_c_schema;
+  ASSERT_THAT(ToArrowSchema(source_schema, &source_c_schema), IsOk());
+  auto source_arrow_schema = ::arrow::ImportSchema(&source_c_schema).ValueOrDie();
+  ArrowSchema projected_c_schema;
+  ASSERT_THAT(ToArrowSchema(projected_schema, &projected_c_schema), IsOk());
+  auto projected_arrow_schema = ::arrow::ImportSchema(&projected_c_schema).ValueOrDie();
+  std::string rows = "[";
+  for (int i = 0; i < 20; ++i) {
+    rows += i == 0 ? "" : ", ";
+    rows += i % 3 == 0
+                ? R"({"i": null, "f": null, "d": null, "ts": null})"
+                : std::format(R"({{"i": {0}, "f": {0}.5, "d": "{0}.25", "ts": {0}}})", i);
+  }
+  rows += "]";
+  // An offset that is not a multiple of 8 shifts the values within the validity bytes.
+  auto input = RecordBatchFromJson(source_arrow_schema, rows)->Slice(5, 11);
+
+  auto result = ProjectRecordBatch(input, projected_arrow_schema, projected_schema,
+                                   projection.value(), ::arrow::default_memory_pool());
+  ASSERT_THAT(result, IsOk());
+  const auto& output = result.value();
+  ASSERT_EQ(output->num_rows(), 11);
+  for (int column = 0; column < output->num_columns(); ++column) {
+    ASSERT_EQ(output->column(column)->null_count(), 4);
+    for (int64_t row = 0; row < output->num_rows(); ++row) {
+      ASSERT_EQ(output->column(column)->IsNull(row), (row + 5) % 3 == 0);
+    }
+  }
+  auto ints = std::static_pointer_cast<::arrow::Int64Array>(output->column(0));
+  auto floats = std::static_pointer_cast<::arrow::DoubleArray>(output->column(1));
+  auto decimals = std::static_pointer_cast<::arrow::Decimal128Array>(output->column(2));
+  auto timestamps = std::static_pointer_cast<::arrow::TimestampArray>(output->column(3));
+  EXPECT_EQ(ints->Value(2), 7);
+  EXPECT_EQ(floats->Value(2), 7.5);
+  EXPECT_EQ(decimals->FormatValue(2), "7.25");
+  EXPECT_EQ(timestamps->Value(2), 7 * 86400000000LL);
+  // Widening the precision of decimals reuses their values.
+  EXPECT_EQ(output->column(2)->data()->buffers[1], input->column(2)->data()->buffers[1]);
+}
+
+TEST(RequiresProjectionTest, IdentityProjection) {
+  Schema schema({
+      SchemaField::MakeRequired(1, "id", int32()),
+      SchemaField::MakeOptional(2, "person",
+                                std::make_shared<StructType>(std::vector<SchemaField>{
+                                    SchemaField::MakeRequired(3, "name", string()),
+                                    SchemaField::MakeOptional(4, "age", int32()),
+                                })),
+  });
+  ArrowSchema c_schema;
+  ASSERT_THAT(ToArrowSchema(schema, &c_schema), IsOk());
+  auto arrow_schema = ::arrow::ImportSchema(&c_schema).ValueOrDie();
+
+  auto verify = [&](const Schema& projected_schema, bool expected) {
+    auto projection = Project(projected_schema, schema, /*prune_source=*/true);
+    ASSERT_THAT(projection, IsOk());
+    ArrowSchema projected_c_schema;
+    ASSERT_THAT(ToArrowSchema(projected_schema, &projected_c_schema), IsOk());
+    auto projected_arrow_schema =
+        ::arrow::ImportSchema(&projected_c_schema).ValueOrDie();
+    // Batches read with pruning have the Arrow schema of the pruned source.
+    std::vector<std::shared_ptr<::arrow::Field>> batch_fields;
+    for (const auto& field : projection->fields) {
+      if (field.kind == FieldProjection::Kind::kProjected) {
+        batch_fields.push_back(arrow_schema->field(
+            static_cast<int>(std::get<size_t>(field.from))));
+      }
+    }
+    EXPECT_EQ(RequiresProjection(::arrow::Schema(batch_fields), *projected_arrow_schema,
+                                 projection.value()),
+              expected)
+        << projected_schema.ToString();
+  };
+
+  verify(schema, /*expected=*/false);
+  // Type promotion
+  verify(Schema({SchemaField::MakeRequired(1, "id", int64())}), /*expected=*/true);
+  // Missing optional field
+  verify(Schema({SchemaField::MakeRequired(1, "id", int32()),
+                 SchemaField::MakeOptional(5, "missing", int32())}),
+         /*expected=*/true);
+  // Reordered fields
+  verify(Schema({SchemaField::MakeOptional(2, "person", schema.fields()[1].type()),
+                 SchemaField::MakeRequired(1, "id", int32())}),
+         /*expected=*/true);
+}
+
 }  // namespace iceberg::parquet
@@ -0,0 +1,205 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <parquet/bloom_filter.h>
+#include <parquet/schema.h>
+#include <parquet/types.h>
+
+#include "iceberg/expression/binder.h"
+#include "iceberg/expression/expressions.h"
+#include "iceberg/expression/literal.h"
+#include "iceberg/parquet/parquet_row_group_filter_internal.h"
+#include "iceberg/schema.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/type.h"
+#include "iceberg/util/uuid.h"
+
+namespace iceberg::parquet {
+
+namespace {
+
+::parquet::schema::NodePtr MakeNode(
+    const std::string& name, int field_id, ::parquet::Type::type physical_type,
+    std::shared_ptr<const ::parquet::LogicalType> logical_type =
+        ::parquet::LogicalType::None(),
+    int length = -1) {
+  return ::parquet::schema::PrimitiveNode::Make(name, ::parquet::Repetition::REQUIRED,
+                                                std::move(logical_type), physical_type,
+                                                length, field_id);
+}
+
+}  // namespace
+
+class ParquetBloomFilterTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    schema_ = std::make_shared<Schema>(std::vector<SchemaField>{
+        SchemaField::MakeRequired(1, "id", int64()),
+        // Promoted from int after the file was written.
+        SchemaField::MakeRequired(2, "count", int64()),
+        SchemaField::MakeRequired(3, "name", string()),
+        SchemaField::MakeRequired(4, "code", fixed(4)),
+        SchemaField::MakeRequired(5, "price", decimal(9, 2)),
+        SchemaField::MakeRequired(6, "key", uuid())});
+    parquet_schema_.Init(::parquet::schema::GroupNode::Make(
+        "schema", ::parquet::Repetition::REQUIRED,
+        {MakeNode("id", 1, ::parquet::Type::INT64),
+         MakeNode("count", 2, ::parquet::Type::INT32),
+         MakeNode("name", 3, ::parquet::Type::BYTE_ARRAY,
+                  ::parquet::LogicalType::String()),
+         MakeNode("code", 4, ::parquet::Type::FIXED_LEN_BYTE_ARRAY,
+                  ::parquet::LogicalType::None(), /*length=*/4),
+         MakeNode("price", 5, ::parquet::Type::FIXED_LEN_BYTE_ARRAY,
+                  ::parquet::LogicalType::Decimal(9, 2), /*length=*/4),
+         MakeNode("key", 6, ::parquet::Type::FIXED_LEN_BYTE_ARRAY,
+                  ::parquet::LogicalType::UUID(), /*length=*/16)}));
+    for (int i = 0; i < parquet_schema_.num_columns(); ++i) {
+      column_indices_[parquet_schema_.Column(i)->schema_node()->field_id()] = i;
+      auto bloom_filter = std::make_unique<::parquet::BlockSplitBloomFilter>();
+      bloom_filter->Init(::parquet::BlockSplitBloomFilter::OptimalNumOfBytes(
+          /*ndv=*/16, /*fpp=*/0.01));
+      bloom_filters_[i] = std::move(bloom_filter);
+    }
+  }
+
+  // Inserts a value the way the Parquet writer hashes values of the physical type.
+  template <typename T>
+  void Insert(int column_index, T value) {
+    auto& bloom_filter = *bloom_filters_.at(column_index);
+    bloom_filter.InsertHash(bloom_filter.Hash(value));
+  }
+
+  void InsertByteArray(int column_index, std::string_view value) {
+    ::parquet::ByteArray byte_array(static_cast<uint32_t>(value.size()),
+                                    reinterpret_cast<const uint8_t*>(value.data()));
+    Insert(column_index, &byte_array);
+  }
+
+  void InsertFixed(int column_index, const std::vector<uint8_t>& value) {
+    auto& bloom_filter = *bloom_filters_.at(column_index);
+    ::parquet::FLBA flba(value.data());
+    bloom_filter.InsertHash(
+        bloom_filter.Hash(&flba, static_cast<uint32_t>(value.size())));
+  }
+
+  bool MightMatch(const std::shared_ptr<Expression>& expr) {
+    auto bound = Binder::Bind(*schema_, expr, /*case_sensitive=*/true);
+    EXPECT_THAT(bound, IsOk());
+    BloomFilterLookup bloom_filter =
+        [this](int column_index) -> Result<const ::parquet::BloomFilter*> {
+      auto it = bloom_filters_.find(column_index);
+      if (it == bloom_filters_.end()) {
+        return nullptr;
+      }
+      return it->second.get();
+    };
+    auto result = MightMatchBloomFilters(bound.value(), parquet_schema_, column_indices_,
+                                         bloom_filter);
+    EXPECT_THAT(result, IsOk());
+    return result.value();
+  }
+
+  std::shared_ptr<Schema> schema_;
+  ::parquet::SchemaDescriptor parquet_schema_;
+  std::unordered_map<int32_t, int> column_indices_;
+  std::unordered_map<int, std::unique_ptr<::parquet::BlockSplitBloomFilter>>
+      bloom_filters_;
+};
+
+TEST_F(ParquetBloomFilterTest, Equal) {
+  Insert(0, int64_t{42});
+  InsertByteArray(2, "abc");
+
+  EXPECT_TRUE(MightMatch(Expressions::Equal("id", Literal::Long(42))));
+  EXPECT_FALSE(MightMatch(Expressions::Equal("id", Literal::Long(43))));
+  EXPECT_TRUE(MightMatch(Expressions::Equal("name", Literal::String("abc"))));
+  EXPECT_FALSE(MightMatch(Expressions::Equal("name", Literal::String("abd"))));
+}
+
+TEST_F(ParquetBloomFilterTest, In) {
+  Insert(0, int64_t{42});
+  InsertByteArray(2, "abc");
+
+  EXPECT_TRUE(MightMatch(Expressions::In("id", {Literal::Long(1), Literal::Long(42)})));
+  EXPECT_FALSE(MightMatch(Expressions::In("id", {Literal::Long(1), Literal::Long(2)})));
+  EXPECT_TRUE(MightMatch(
+      Expressions::In("name", {Literal::String("abc"), Literal::String("xyz")})));
+  EXPECT_FALSE(MightMatch(
+      Expressions::In("name", {Literal::String("abd"), Literal::String("xyz")})));
+}
+
+TEST_F(ParquetBloomFilterTest, AndOr) {
+  Insert(0, int64_t{42});
+  InsertByteArray(2, "abc");
+
+  EXPECT_FALSE(
+      MightMatch(Expressions::And(Expressions::Equal("id", Literal::Long(42)),
+                                  Expressions::Equal("name", Literal::String("x")))));
+  EXPECT_TRUE(
+      MightMatch(Expressions::Or(Expressions::Equal("id", Literal::Long(43)),
+                                 Expressions::Equal("name", Literal::String("abc")))));
+  // Predicates other than equality and IN are not checked.
+  EXPECT_TRUE(MightMatch(Expressions::NotEqual("id", Literal::Long(42))));
+  EXPECT_TRUE(MightMatch(Expressions::LessThan("id", Literal::Long(0))));
+}
+
+TEST_F(ParquetBloomFilterTest, HashesByPhysicalType) {
+  // Values of an int64 column are hashed as int64, not as int32.
+  Insert(0, int32_t{42});
+  EXPECT_FALSE(MightMatch(Expressions::Equal("id", Literal::Long(42))));
+
+  // Fixed length values are hashed by their bytes.
+  InsertFixed(3, {1, 2, 3, 4});
+  EXPECT_TRUE(MightMatch(Expressions::Equal("code", Literal::Fixed({1, 2, 3, 4}))));
+  EXPECT_FALSE(MightMatch(Expressions::Equal("code", Literal::Fixed({1, 2, 3, 5}))));
+
+  // Decimals are hashed as big-endian values of the column length.
+  InsertFixed(4, {0xff, 0xff, 0xcf, 0xc7});
+  EXPECT_TRUE(MightMatch(Expressions::Equal("price", Literal::Decimal(-12345, 9, 2))));
+  EXPECT_FALSE(MightMatch(Expressions::Equal("price", Literal::Decimal(12345, 9, 2))));
+
+  ICEBERG_UNWRAP_OR_FAIL(auto uuid,
+                         Uuid::FromString("123e4567-e89b-12d3-a456-426614174000"));
+  InsertFixed(5, std::vector<uint8_t>(uuid.bytes().begin(), uuid.bytes().end()));
+  EXPECT_TRUE(MightMatch(Expressions::Equal("key", Literal::UUID(uuid))));
+}
+
+TEST_F(ParquetBloomFilterTest, PromotedColumnMightMatch) {
+  // The values of the column were written as int32, so long values cannot be hashed
+  // the way the file hashed them.
+  Insert(1, int32_t{7});
+  EXPECT_TRUE(MightMatch(Expressions::Equal("count", Literal::Long(7))));
+  EXPECT_TRUE(MightMatch(Expressions::Equal("count", Literal::Long(8))));
+  EXPECT_TRUE(MightMatch(Expressions::In("count", {Literal::Long(8), Literal::Long(9)})));
+}
+
+TEST_F(ParquetBloomFilterTest, MissingBloomFilterMightMatch) {
+  bloom_filters_.erase(2);
+  EXPECT_TRUE(MightMatch(Expressions::Equal("name", Literal::String("abc"))));
+}
+
+}  // namespace iceberg::parquet
@@ -303,6 +303,25 @@ TEST(ParquetSchemaProjectionTest, ProjectSchemaEvolutionFloatToDouble) {
   ASSERT_PROJECTED_FIELD(projection.fields[0], 0);
 }
 
+TEST(ParquetSchemaProjectionTest, ProjectSchemaEvolutionDateToTimestamp) {
+  Schema expected_schema({
+      SchemaField::MakeRequired(/*field_id=*/1, "value", iceberg::timestamp()),
+  });
+
+  auto date_node = ::parquet::schema::PrimitiveNode::Make(
+      "value", ::parquet::Repetition::REQUIRED, ::parquet::LogicalType::Date(),
+      ::parquet::Type::INT32, /*primitive_length=*/-1, /*field_id=*/1);
+  auto parquet_schema = MakeGroupNode("iceberg_schema", {date_node});
+
+  auto schema_manifest = MakeSchemaManifest(parquet_schema);
+  auto projection_result = Project(expected_schema, schema_manifest);
+  ASSERT_THAT(projection_result, IsOk());
+
+  const auto& projection = *projection_result;
+  ASSERT_EQ(projection.fields.size(), 1);
+  ASSERT_PROJECTED_FIELD(projection.fields[0], 0);
+}
+
 TEST(ParquetSchemaProjectionTest, ProjectSchemaEvolutionIncompatibleTypes) {
   Schema expected_schema({
       SchemaField::MakeRequired(/*field_id=*/1, "value", iceberg::int32()),
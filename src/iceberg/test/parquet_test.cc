@@ -17,7 +17,13 @@
  * under the License.
  */
 
+#include <algorithm>
+#include <format>
 #include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <arrow/array.h>
 #include <arrow/c/bridge.h>
@@ -28,12 +34,26 @@
 #include <arrow/util/key_value_metadata.h>
 #include <parquet/arrow/reader.h>
 #include <parquet/arrow/writer.h>
+#include <parquet/bloom_filter.h>
+#include <parquet/bloom_filter_reader.h>
+#include <parquet/file_reader.h>
 #include <parquet/metadata.h>
+#include <parquet/properties.h>
 
 #include "iceberg/arrow/arrow_fs_file_io_internal.h"
 #include "iceberg/arrow/arrow_status_internal.h"
+#include "iceberg/deletes/position_delete_index.h"
+#include "iceberg/executor.h"
+#include "iceberg/expression/expressions.h"
+#include "iceberg/expression/literal.h"
 #include "iceberg/file_reader.h"
 #include "iceberg/file_writer.h"
+#include "iceberg/memory_pool.h"
+#include "iceberg/metadata_columns.h"
+#include "iceberg/metrics_config.h"
+#include "iceberg/name_mapping.h"
+#include "iceberg/parquet/parquet_metadata_cache.h"
+#include "iceberg/parquet/parquet_reader.h"
 #include "iceberg/parquet/parquet_register.h"
 #include "iceberg/result.h"
 #include "iceberg/schema.h"
@@ -155,6 +175,34 @@ class ParquetReaderTest : public ::testing::Test {
     ASSERT_TRUE(outfile->Close().ok());
   }
 
+  // Writes ids 1 to 6 in a single row group with one row per data page.
+  void CreatePagedParquetFile() {
+    const std::string kParquetFieldIdKey = "PARQUET:field_id";
+    auto arrow_schema = ::arrow::schema(
+        {::arrow::field("id", ::arrow::int32(), /*nullable=*/false,
+                        ::arrow::KeyValueMetadata::Make({kParquetFieldIdKey}, {"1"}))});
+    auto table = ::arrow::Table::FromRecordBatches(
+                     arrow_schema, {::arrow::RecordBatch::FromStructArray(
+                                        ::arrow::json::ArrayFromJSONString(
+                                            ::arrow::struct_(arrow_schema->fields()),
+                                            R"([[1], [2], [3], [4], [5], [6]])")
+                                            .ValueOrDie())
+                                        .ValueOrDie()})
+                     .ValueOrDie();
+
+    auto properties = ::parquet::WriterProperties::Builder()
+                          .enable_write_page_index()
+                          ->data_pagesize(1)
+                          ->write_batch_size(1)
+                          ->build();
+    auto io = internal::checked_cast<arrow::ArrowFileSystemFileIO&>(*file_io_);
+    auto outfile = io.fs()->OpenOutputStream(temp_parquet_file_).ValueOrDie();
+    ASSERT_TRUE(::parquet::arrow::WriteTable(*table, ::arrow::default_memory_pool(),
+                                             outfile, /*chunk_size=*/100, properties)
+                    .ok());
+    ASSERT_TRUE(outfile->Close().ok());
+  }
+
   void VerifyNextBatch(Reader& reader, std::string_view expected_json) {
     // Boilerplate to get Arrow schema
     auto schema_result = reader.Schema();
@@ -206,6 +254,34 @@ TEST_F(ParquetReaderTest, ReadTwoFields) {
   ASSERT_NO_FATAL_FAILURE(VerifyExhausted(*reader));
 }
 
+TEST_F(ParquetReaderTest, ReadWithMetadataCache) {
+  CreateSimpleParquetFile();
+  ICEBERG_UNWRAP_OR_FAIL(auto cache, parquet::ParquetMetadataCache::Make(1 << 20));
+  parquet::ParquetMetadataCache::SetGlobal(cache);
+
+  auto schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32())});
+  for (int i = 0; i < 2; ++i) {
+    ICEBERG_UNWRAP_OR_FAIL(
+        auto reader,
+        ReaderFactoryRegistry::Open(
+            FileFormatType::kParquet,
+            {.path = temp_parquet_file_, .io = file_io_, .projection = schema}));
+    ASSERT_NO_FATAL_FAILURE(VerifyNextBatch(*reader, R"([[1], [2], [3]])"));
+    ASSERT_NO_FATAL_FAILURE(VerifyExhausted(*reader));
+  }
+  parquet::ParquetMetadataCache::SetGlobal(nullptr);
+
+  auto stats = cache->stats();
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.file_count, 1);
+  EXPECT_GT(stats.size_bytes, 0);
+
+  EXPECT_THAT(parquet::ParquetMetadataCache::Make(0),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
 TEST_F(ParquetReaderTest, ReadReorderedFieldsWithNulls) {
   CreateSimpleParquetFile();
 
@@ -244,6 +320,74 @@ TEST_F(ParquetReaderTest, ReadWithBatchSize) {
   ASSERT_NO_FATAL_FAILURE(VerifyExhausted(*reader));
 }
 
+TEST_F(ParquetReaderTest, ReadWithTargetBatchBytes) {
+  CreateSimpleParquetFile();
+
+  auto schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32())});
+
+  // The target replaces the batch size, and is smaller than a row.
+  ICEBERG_UNWRAP_OR_FAIL(auto reader,
+                         ReaderFactoryRegistry::Open(FileFormatType::kParquet,
+                                                     {.path = temp_parquet_file_,
+                                                      .batch_size = 100,
+                                                      .target_batch_bytes = 1,
+                                                      .io = file_io_,
+                                                      .projection = schema}));
+  ASSERT_NO_FATAL_FAILURE(VerifyNextBatch(*reader, R"([[1]])"));
+  ASSERT_NO_FATAL_FAILURE(VerifyNextBatch(*reader, R"([[2]])"));
+  ASSERT_NO_FATAL_FAILURE(VerifyNextBatch(*reader, R"([[3]])"));
+  ASSERT_NO_FATAL_FAILURE(VerifyExhausted(*reader));
+
+  EXPECT_THAT(ReaderFactoryRegistry::Open(FileFormatType::kParquet,
+                                          {.path = temp_parquet_file_,
+                                           .target_batch_bytes = 0,
+                                           .io = file_io_,
+                                           .projection = schema}),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(ParquetReaderTest, ReadWithMemoryPool) {
+  CreateSimpleParquetFile();
+
+  auto schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32()),
+                               SchemaField::MakeOptional(2, "name", string())});
+
+  auto pool = std::make_shared<TrackingMemoryPool>();
+  {
+    ICEBERG_UNWRAP_OR_FAIL(auto reader, ReaderFactoryRegistry::Open(
+                                            FileFormatType::kParquet,
+                                            {.path = temp_parquet_file_,
+                                             .io = file_io_,
+                                             .projection = schema,
+                                             .memory_pool = pool}));
+    ASSERT_NO_FATAL_FAILURE(
+        VerifyNextBatch(*reader, R"([[1, "Foo"], [2, "Bar"], [3, "Baz"]])"));
+    EXPECT_GT(pool->max_memory(), 0);
+    EXPECT_GT(pool->num_allocations(), 0);
+  }
+  EXPECT_EQ(pool->bytes_allocated(), 0);
+
+  // A pool whose limit is too low fails the read instead of allocating past it.
+  auto limited_pool = std::make_shared<TrackingMemoryPool>(/*limit=*/16);
+  auto read = [&]() -> Status {
+    ICEBERG_ASSIGN_OR_RAISE(auto reader, ReaderFactoryRegistry::Open(
+                                             FileFormatType::kParquet,
+                                             {.path = temp_parquet_file_,
+                                              .io = file_io_,
+                                              .projection = schema,
+                                              .memory_pool = limited_pool}));
+    ICEBERG_ASSIGN_OR_RAISE(auto batch, reader->Next());
+    if (batch.has_value()) {
+      batch->release(&batch.value());
+    }
+    return {};
+  };
+  EXPECT_FALSE(read().has_value());
+  EXPECT_LE(limited_pool->max_memory(), 16);
+}
+
 TEST_F(ParquetReaderTest, ReadSplit) {
   CreateSplitParquetFile();
 
@@ -287,6 +431,295 @@ TEST_F(ParquetReaderTest, ReadSplit) {
   }
 }
 
+TEST_F(ParquetReaderTest, ReadWithRowGroupFilter) {
+  CreateSplitParquetFile();
+
+  auto schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32())});
+
+  // The file has two row groups, with ids [1, 2] and [3].
+  std::vector<std::shared_ptr<Expression>> filters = {
+      Expressions::Equal("id", Literal::Int(3)),
+      Expressions::LessThan("id", Literal::Int(3)),
+      Expressions::GreaterThan("id", Literal::Int(3)),
+      Expressions::In("id", {Literal::Int(2), Literal::Int(5)}),
+      Expressions::Not(Expressions::GreaterThanOrEqual("id", Literal::Int(2))),
+      // Filters on columns that are not projected do not prune row groups.
+      Expressions::Equal("name", Literal::String("Foo")),
+  };
+  std::vector<std::string> expected_json = {
+      R"([[3]])", R"([[1], [2]])", "", R"([[1], [2]])", R"([[1], [2]])",
+      R"([[1], [2], [3]])",
+  };
+
+  for (size_t i = 0; i < filters.size(); ++i) {
+    auto reader_result =
+        ReaderFactoryRegistry::Open(FileFormatType::kParquet, {.path = temp_parquet_file_,
+                                                               .batch_size = 100,
+                                                               .io = file_io_,
+                                                               .projection = schema,
+                                                               .filter = filters[i]});
+    ASSERT_THAT(reader_result, IsOk());
+    auto reader = std::move(reader_result.value());
+    if (!expected_json[i].empty()) {
+      ASSERT_NO_FATAL_FAILURE(VerifyNextBatch(*reader, expected_json[i]));
+    }
+    ASSERT_NO_FATAL_FAILURE(VerifyExhausted(*reader));
+  }
+}
+
+TEST_F(ParquetReaderTest, ReadWithPageIndexFilter) {
+  CreatePagedParquetFile();
+
+  auto schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32())});
+
+  std::vector<std::shared_ptr<Expression>> filters = {
+      Expressions::Equal("id", Literal::Int(3)),
+      Expressions::In("id", {Literal::Int(2), Literal::Int(5)}),
+      Expressions::Or(Expressions::LessThan("id", Literal::Int(2)),
+                      Expressions::GreaterThan("id", Literal::Int(4))),
+      Expressions::And(Expressions::GreaterThan("id", Literal::Int(1)),
+                       Expressions::LessThan("id", Literal::Int(4))),
+      Expressions::NotEqual("id", Literal::Int(3)),
+  };
+  std::vector<std::string> expected_json = {
+      R"([[3]])",
+      R"([[2], [5]])",
+      R"([[1], [5], [6]])",
+      R"([[2], [3]])",
+      R"([[1], [2], [3], [4], [5], [6]])",
+  };
+
+  for (size_t i = 0; i < filters.size(); ++i) {
+    auto reader_result =
+        ReaderFactoryRegistry::Open(FileFormatType::kParquet, {.path = temp_parquet_file_,
+                                                               .batch_size = 100,
+                                                               .io = file_io_,
+                                                               .projection = schema,
+                                                               .filter = filters[i]});
+    ASSERT_THAT(reader_result, IsOk());
+    auto reader = std::move(reader_result.value());
+    ASSERT_NO_FATAL_FAILURE(VerifyNextBatch(*reader, expected_json[i]));
+    ASSERT_NO_FATAL_FAILURE(VerifyExhausted(*reader));
+  }
+}
+
+TEST_F(ParquetReaderTest, ReadWithLateMaterialization) {
+  CreateSplitParquetFile();
+
+  auto schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32()),
+                               SchemaField::MakeOptional(2, "name", string())});
+  std::unordered_map<std::string, std::string> properties = {
+      {std::string(ParquetReader::kLateMaterializationProperty), "true"}};
+
+  // Neither filter can be decided from the column statistics of the first row group.
+  std::vector<std::shared_ptr<Expression>> filters = {
+      Expressions::Equal("name", Literal::String("Baz")),
+      Expressions::NotEqual("id", Literal::Int(2))};
+  std::vector<std::vector<std::string>> expected_json = {
+      {R"([[3, "Baz"]])"}, {R"([[1, "Foo"]])", R"([[3, "Baz"]])"}};
+
+  for (size_t i = 0; i < filters.size(); ++i) {
+    ICEBERG_UNWRAP_OR_FAIL(auto reader,
+                           ReaderFactoryRegistry::Open(FileFormatType::kParquet,
+                                                       {.path = temp_parquet_file_,
+                                                        .batch_size = 100,
+                                                        .io = file_io_,
+                                                        .projection = schema,
+                                                        .filter = filters[i],
+                                                        .properties = properties}));
+    for (const auto& json : expected_json[i]) {
+      ASSERT_NO_FATAL_FAILURE(VerifyNextBatch(*reader, json));
+    }
+    ASSERT_NO_FATAL_FAILURE(VerifyExhausted(*reader));
+  }
+}
+
+TEST_F(ParquetReaderTest, ReadRowGroupsInParallel) {
+  CreateSplitParquetFile();
+
+  auto schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32()),
+                               SchemaField::MakeOptional(2, "name", string())});
+  ICEBERG_UNWRAP_OR_FAIL(std::shared_ptr<Executor> executor,
+                         ThreadPoolExecutor::Make(2));
+  std::unordered_map<std::string, std::string> properties = {
+      {std::string(ParquetReader::kRowGroupParallelismProperty), "2"},
+      {std::string(ParquetReader::kUseThreadsProperty), "true"}};
+
+  // The row groups are returned in file order, each in batches of its own.
+  ICEBERG_UNWRAP_OR_FAIL(auto reader,
+                         ReaderFactoryRegistry::Open(FileFormatType::kParquet,
+                                                     {.path = temp_parquet_file_,
+                                                      .batch_size = 100,
+                                                      .io = file_io_,
+                                                      .projection = schema,
+                                                      .executor = executor,
+                                                      .properties = properties}));
+  ASSERT_NO_FATAL_FAILURE(VerifyNextBatch(*reader, R"([[1, "Foo"], [2, "Bar"]])"));
+  ASSERT_NO_FATAL_FAILURE(VerifyNextBatch(*reader, R"([[3, "Baz"]])"));
+  ASSERT_NO_FATAL_FAILURE(VerifyExhausted(*reader));
+  ASSERT_THAT(reader->Close(), IsOk());
+
+  // Deleted rows are skipped across the row groups read in parallel.
+  auto deletes = std::make_shared<PositionDeleteIndex>();
+  deletes->Delete(0);
+  ICEBERG_UNWRAP_OR_FAIL(reader,
+                         ReaderFactoryRegistry::Open(FileFormatType::kParquet,
+                                                     {.path = temp_parquet_file_,
+                                                      .batch_size = 100,
+                                                      .io = file_io_,
+                                                      .projection = schema,
+                                                      .position_deletes = deletes,
+                                                      .executor = executor,
+                                                      .properties = properties}));
+  ASSERT_NO_FATAL_FAILURE(VerifyNextBatch(*reader, R"([[2, "Bar"]])"));
+  ASSERT_NO_FATAL_FAILURE(VerifyNextBatch(*reader, R"([[3, "Baz"]])"));
+  ASSERT_NO_FATAL_FAILURE(VerifyExhausted(*reader));
+
+  properties[std::string(ParquetReader::kRowGroupParallelismProperty)] = "0";
+  EXPECT_THAT(ReaderFactoryRegistry::Open(FileFormatType::kParquet,
+                                          {.path = temp_parquet_file_,
+                                           .io = file_io_,
+                                           .projection = schema,
+                                           .properties = properties}),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(ParquetReaderTest, ReadDictionaryColumns) {
+  CreateSplitParquetFile();
+
+  auto schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32()),
+                               SchemaField::MakeOptional(2, "name", string())});
+  std::unordered_map<std::string, std::string> properties = {
+      {std::string(ParquetReader::kReadDictionaryProperty), "true"}};
+
+  ICEBERG_UNWRAP_OR_FAIL(auto reader,
+                         ReaderFactoryRegistry::Open(FileFormatType::kParquet,
+                                                     {.path = temp_parquet_file_,
+                                                      .batch_size = 100,
+                                                      .io = file_io_,
+                                                      .projection = schema,
+                                                      .properties = properties}));
+  ICEBERG_UNWRAP_OR_FAIL(auto arrow_c_schema, reader->Schema());
+  auto arrow_type = ::arrow::ImportType(&arrow_c_schema).ValueOrDie();
+  ASSERT_TRUE(arrow_type->field(1)->type()->Equals(
+      ::arrow::dictionary(::arrow::int32(), ::arrow::utf8())));
+
+  // Row groups may have dictionaries of their own, so compare the decoded values.
+  std::vector<std::string> names;
+  while (true) {
+    ICEBERG_UNWRAP_OR_FAIL(auto data, reader->Next());
+    if (!data.has_value()) {
+      break;
+    }
+    auto array = ::arrow::ImportArray(&data.value(), arrow_type).ValueOrDie();
+    const auto& column = internal::checked_cast<const ::arrow::DictionaryArray&>(
+        *internal::checked_cast<const ::arrow::StructArray&>(*array).field(1));
+    const auto& dictionary =
+        internal::checked_cast<const ::arrow::StringArray&>(*column.dictionary());
+    for (int64_t i = 0; i < column.length(); ++i) {
+      names.push_back(dictionary.GetString(column.GetValueIndex(i)));
+    }
+  }
+  EXPECT_THAT(names, ::testing::ElementsAre("Foo", "Bar", "Baz"));
+  ASSERT_THAT(reader->Close(), IsOk());
+
+  // The column property overrides the default.
+  properties[std::format("{}name", ParquetReader::kReadDictionaryColumnPrefix)] =
+      "false";
+  ICEBERG_UNWRAP_OR_FAIL(reader,
+                         ReaderFactoryRegistry::Open(FileFormatType::kParquet,
+                                                     {.path = temp_parquet_file_,
+                                                      .batch_size = 100,
+                                                      .io = file_io_,
+                                                      .projection = schema,
+                                                      .properties = properties}));
+  ASSERT_NO_FATAL_FAILURE(
+      VerifyNextBatch(*reader, R"([[1, "Foo"], [2, "Bar"], [3, "Baz"]])"));
+  ASSERT_NO_FATAL_FAILURE(VerifyExhausted(*reader));
+}
+
+TEST_F(ParquetReaderTest, ReadConstantAndDefaultColumns) {
+  CreateSimpleParquetFile();
+
+  auto schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32()),
+                               SchemaField::MakeOptional(2, "name", string()),
+                               SchemaField::MakeRequired(3, "region", string())});
+
+  // The constant replaces the stored column, the default fills the missing one.
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto reader,
+      ReaderFactoryRegistry::Open(FileFormatType::kParquet,
+                                  {.path = temp_parquet_file_,
+                                   .io = file_io_,
+                                   .projection = schema,
+                                   .constants = {{2, Literal::String("Qux")}},
+                                   .default_values = {{3, Literal::String("eu")}}}));
+  ASSERT_NO_FATAL_FAILURE(VerifyNextBatch(
+      *reader, R"([[1, "Qux", "eu"], [2, "Qux", "eu"], [3, "Qux", "eu"]])"));
+  ASSERT_NO_FATAL_FAILURE(VerifyExhausted(*reader));
+}
+
+TEST_F(ParquetReaderTest, ReadMetadataColumns) {
+  CreateSplitParquetFile();
+
+  auto schema = std::make_shared<Schema>(std::vector<SchemaField>{
+      SchemaField::MakeRequired(1, "id", int32()), MetadataColumns::kRowPosition,
+      MetadataColumns::kSpecId, MetadataColumns::kFilePath});
+  auto deletes = std::make_shared<PositionDeleteIndex>();
+  deletes->Delete(1);
+
+  // The positions of the rows follow the deleted row and the second row group.
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto reader,
+      ReaderFactoryRegistry::Open(FileFormatType::kParquet,
+                                  {.path = temp_parquet_file_,
+                                   .batch_size = 100,
+                                   .io = file_io_,
+                                   .projection = schema,
+                                   .position_deletes = deletes,
+                                   .metadata_columns = {.spec_id = 3}}));
+  ICEBERG_UNWRAP_OR_FAIL(auto arrow_c_schema, reader->Schema());
+  auto arrow_type = ::arrow::ImportType(&arrow_c_schema).ValueOrDie();
+  ASSERT_TRUE(arrow_type->field(3)->type()->Equals(
+      ::arrow::dictionary(::arrow::int32(), ::arrow::utf8())));
+
+  std::vector<int32_t> ids;
+  std::vector<int64_t> positions;
+  while (true) {
+    ICEBERG_UNWRAP_OR_FAIL(auto data, reader->Next());
+    if (!data.has_value()) {
+      break;
+    }
+    auto array = ::arrow::ImportArray(&data.value(), arrow_type).ValueOrDie();
+    const auto& struct_array =
+        internal::checked_cast<const ::arrow::StructArray&>(*array);
+    const auto& id = internal::checked_cast<const ::arrow::Int32Array&>(
+        *struct_array.field(0));
+    const auto& pos = internal::checked_cast<const ::arrow::Int64Array&>(
+        *struct_array.field(1));
+    const auto& spec_id = internal::checked_cast<const ::arrow::Int32Array&>(
+        *struct_array.field(2));
+    const auto& file = internal::checked_cast<const ::arrow::DictionaryArray&>(
+        *struct_array.field(3));
+    const auto& file_dictionary =
+        internal::checked_cast<const ::arrow::StringArray&>(*file.dictionary());
+    for (int64_t i = 0; i < struct_array.length(); ++i) {
+      ids.push_back(id.Value(i));
+      positions.push_back(pos.Value(i));
+      EXPECT_EQ(spec_id.Value(i), 3);
+      EXPECT_EQ(file_dictionary.GetString(file.GetValueIndex(i)), temp_parquet_file_);
+    }
+  }
+  EXPECT_THAT(ids, ::testing::ElementsAre(1, 3));
+  EXPECT_THAT(positions, ::testing::ElementsAre(0, 2));
+}
+
 class ParquetReadWrite : public ::testing::Test {
  protected:
   static void SetUpTestSuite() { parquet::RegisterAll(); }
@@ -365,4 +798,449 @@ TEST_F(ParquetReadWrite, SimpleTypeRoundTrip) {
   ASSERT_TRUE(out->Equals(*array));
 }
 
+TEST_F(ParquetReadWrite, WriterProperties) {
+  auto schema = std::make_shared<Schema>(std::vector<SchemaField>{
+      SchemaField::MakeRequired(1, "id", int64()),
+      SchemaField::MakeOptional(2, "name", string()),
+  });
+  ArrowSchema arrow_c_schema;
+  ASSERT_THAT(ToArrowSchema(*schema, &arrow_c_schema), IsOk());
+  auto arrow_schema = ::arrow::ImportType(&arrow_c_schema).ValueOrDie();
+  std::string json = "[";
+  for (int i = 0; i < 1000; ++i) {
+    json += std::format(R"({}[{}, "name-{}"])", i == 0 ? "" : ",", i, i);
+  }
+  json += "]";
+  auto array =
+      ::arrow::json::ArrayFromJSONString(::arrow::struct_(arrow_schema->fields()), json)
+          .ValueOrDie();
+
+  std::shared_ptr<FileIO> file_io = arrow::ArrowFileSystemFileIO::MakeMockFileIO();
+  auto& io = internal::checked_cast<arrow::ArrowFileSystemFileIO&>(*file_io);
+  const std::string path = "properties.parquet";
+  auto write = [&](std::unordered_map<std::string, std::string> properties) {
+    return WriteArray(array, {.path = path,
+                              .schema = schema,
+                              .io = file_io,
+                              .properties = std::move(properties)});
+  };
+  auto read_metadata = [&]() {
+    return ::parquet::ReadMetaData(io.fs()->OpenInputFile(path).ValueOrDie());
+  };
+
+  for (const auto& [codec, compression] :
+       std::vector<std::pair<std::string, ::arrow::Compression::type>>{
+           {"uncompressed", ::arrow::Compression::UNCOMPRESSED},
+           {"gzip", ::arrow::Compression::GZIP},
+           {"zstd", ::arrow::Compression::ZSTD},
+       }) {
+    ASSERT_THAT(write({{"write.parquet.compression-codec", codec},
+                       {"write.parquet.compression-level", "3"}}),
+                IsOk())
+        << codec;
+    auto metadata = read_metadata();
+    ASSERT_EQ(metadata->num_row_groups(), 1) << codec;
+    EXPECT_EQ(metadata->RowGroup(0)->ColumnChunk(0)->compression(), compression)
+        << codec;
+  }
+
+  // Row groups are closed at the row group size.
+  ASSERT_THAT(write({{"write.parquet.row-group-size-bytes", "4096"}}), IsOk());
+  auto metadata = read_metadata();
+  EXPECT_GT(metadata->num_row_groups(), 1);
+  EXPECT_EQ(metadata->num_rows(), 1000);
+
+  for (const auto& [key, value] : std::vector<std::pair<std::string, std::string>>{
+           {"write.parquet.compression-codec", "unknown"},
+           {"write.parquet.compression-level", "100"},
+           {"write.parquet.row-group-size-bytes", "0"},
+           {"write.parquet.page-size-bytes", "1MB"},
+           {"write.parquet.dict-size-bytes", "-1"},
+       }) {
+    EXPECT_THAT(write({{key, value}}), IsError(ErrorKind::kInvalidArgument))
+        << key << "=" << value;
+  }
+}
+
+TEST_F(ParquetReadWrite, EstimatedLength) {
+  auto schema = std::make_shared<Schema>(std::vector<SchemaField>{
+      SchemaField::MakeRequired(1, "id", int64()),
+      SchemaField::MakeOptional(2, "name", string()),
+  });
+  ArrowSchema arrow_c_schema;
+  ASSERT_THAT(ToArrowSchema(*schema, &arrow_c_schema), IsOk());
+  auto arrow_schema = ::arrow::ImportType(&arrow_c_schema).ValueOrDie();
+  std::string json = "[";
+  for (int i = 0; i < 1000; ++i) {
+    json += std::format(R"({}[{}, "name-{}"])", i == 0 ? "" : ",", i, i);
+  }
+  json += "]";
+  auto array =
+      ::arrow::json::ArrayFromJSONString(::arrow::struct_(arrow_schema->fields()), json)
+          .ValueOrDie();
+
+  std::shared_ptr<FileIO> file_io = arrow::ArrowFileSystemFileIO::MakeMockFileIO();
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto writer,
+      WriterFactoryRegistry::Open(
+          FileFormatType::kParquet,
+          {.path = "estimated.parquet",
+           .schema = schema,
+           .io = file_io,
+           .properties = {{"write.parquet.row-group-size-bytes", "4096"}}}));
+  int64_t estimated_length = 0;
+  for (int64_t offset = 0; offset < array->length(); offset += 100) {
+    ArrowArray c_array;
+    ASSERT_TRUE(::arrow::ExportArray(*array->Slice(offset, 100), &c_array).ok());
+    ASSERT_THAT(writer->Write(&c_array), IsOk());
+    // Buffered rows are estimated before they are flushed.
+    auto estimate = writer->estimated_length();
+    ASSERT_TRUE(estimate.has_value());
+    EXPECT_GT(*estimate, 0);
+    estimated_length = *estimate;
+  }
+  ASSERT_THAT(writer->Close(), IsOk());
+  ASSERT_TRUE(writer->length().has_value());
+  const int64_t length = writer->length().value();
+  EXPECT_EQ(writer->estimated_length(), length);
+  EXPECT_GT(estimated_length, length / 2);
+  EXPECT_LT(estimated_length, length * 2);
+}
+
+TEST_F(ParquetReadWrite, BloomFilters) {
+  auto schema = std::make_shared<Schema>(std::vector<SchemaField>{
+      SchemaField::MakeRequired(1, "id", int64()),
+      SchemaField::MakeOptional(2, "name", string()),
+      SchemaField::MakeOptional(3, "price", decimal(9, 2)),
+      SchemaField::MakeOptional(4, "active", boolean()),
+      SchemaField::MakeOptional(
+          5, "location",
+          std::make_shared<StructType>(std::vector<SchemaField>{
+              SchemaField::MakeOptional(6, "city", string())})),
+  });
+  ArrowSchema arrow_c_schema;
+  ASSERT_THAT(ToArrowSchema(*schema, &arrow_c_schema), IsOk());
+  auto arrow_schema = ::arrow::ImportType(&arrow_c_schema).ValueOrDie();
+  // Even ids from 0 to 1998, and prices with unscaled values of -101 * i.
+  std::string json = "[";
+  for (int i = 0; i < 1000; ++i) {
+    json += std::format(R"({}[{}, "name-{}", "-{}.{:02}", {}, {{"city": "city-{}"}}])",
+                        i == 0 ? "" : ",", i * 2, i, i, i % 100,
+                        i % 2 == 0 ? "true" : "null", i);
+  }
+  json += "]";
+  auto array =
+      ::arrow::json::ArrayFromJSONString(::arrow::struct_(arrow_schema->fields()), json)
+          .ValueOrDie();
+
+  std::shared_ptr<FileIO> file_io = arrow::ArrowFileSystemFileIO::MakeMockFileIO();
+  auto& io = internal::checked_cast<arrow::ArrowFileSystemFileIO&>(*file_io);
+  const std::string path = "bloom_filters.parquet";
+  auto write = [&](std::unordered_map<std::string, std::string> properties) {
+    return WriteArray(array, {.path = path,
+                              .schema = schema,
+                              .io = file_io,
+                              .properties = std::move(properties)});
+  };
+
+  EXPECT_THAT(write({{"write.parquet.bloom-filter-enabled.column.id", "true"},
+                     {"write.parquet.bloom-filter-fpp.column.id", "1.5"}}),
+              IsError(ErrorKind::kInvalidArgument));
+  // Columns that are not in the schema are ignored, and so are boolean columns since
+  // Parquet does not hash booleans. A struct column has filters for its leaf columns.
+  ASSERT_THAT(write({{"write.parquet.bloom-filter-enabled.column.id", "true"},
+                     {"write.parquet.bloom-filter-fpp.column.id", "0.0001"},
+                     {"write.parquet.bloom-filter-enabled.column.price", "true"},
+                     {"write.parquet.bloom-filter-enabled.column.active", "true"},
+                     {"write.parquet.bloom-filter-enabled.column.location", "true"},
+                     {"write.parquet.bloom-filter-enabled.column.dropped", "true"},
+                     {"write.parquet.row-group-size-bytes", "8192"}}),
+              IsOk());
+
+  auto file_reader =
+      ::parquet::ParquetFileReader::Open(io.fs()->OpenInputFile(path).ValueOrDie());
+  auto metadata = file_reader->metadata();
+  ASSERT_GT(metadata->num_row_groups(), 1);
+  ASSERT_EQ(metadata->num_rows(), 1000);
+
+  // Each row group has the filters of the values written to it.
+  int64_t row = 0;
+  int false_positives = 0;
+  for (int i = 0; i < metadata->num_row_groups(); ++i) {
+    auto row_group = file_reader->GetBloomFilterReader().RowGroup(i);
+    ASSERT_NE(row_group, nullptr);
+    auto id_filter = row_group->GetColumnBloomFilter(0);
+    auto price_filter = row_group->GetColumnBloomFilter(2);
+    auto city_filter = row_group->GetColumnBloomFilter(4);
+    ASSERT_NE(id_filter, nullptr);
+    ASSERT_NE(price_filter, nullptr);
+    ASSERT_NE(city_filter, nullptr);
+    EXPECT_EQ(row_group->GetColumnBloomFilter(1), nullptr);
+    EXPECT_EQ(row_group->GetColumnBloomFilter(3), nullptr);
+
+    const int64_t end = row + metadata->RowGroup(i)->num_rows();
+    for (; row < end; ++row) {
+      EXPECT_TRUE(id_filter->FindHash(id_filter->Hash(row * 2))) << row;
+      if (id_filter->FindHash(id_filter->Hash(row * 2 + 1))) {
+        ++false_positives;
+      }
+
+      // Decimals are hashed as big-endian values of the 4 bytes of decimal(9, 2).
+      const auto unscaled = static_cast<uint32_t>(-(row * 100 + row % 100));
+      const std::vector<uint8_t> price = {
+          static_cast<uint8_t>(unscaled >> 24), static_cast<uint8_t>(unscaled >> 16),
+          static_cast<uint8_t>(unscaled >> 8), static_cast<uint8_t>(unscaled)};
+      ::parquet::FLBA price_flba(price.data());
+      EXPECT_TRUE(price_filter->FindHash(price_filter->Hash(&price_flba, 4))) << row;
+
+      const std::string city = std::format("city-{}", row);
+      ::parquet::ByteArray city_value(static_cast<uint32_t>(city.size()),
+                                      reinterpret_cast<const uint8_t*>(city.data()));
+      EXPECT_TRUE(city_filter->FindHash(city_filter->Hash(&city_value))) << row;
+    }
+  }
+  EXPECT_LT(false_positives, 5);
+
+  // The reader skips a row group whose filter rules out an id within its range.
+  const int64_t missing_id = metadata->RowGroup(0)->num_rows() / 2 * 2 + 1;
+  auto read_schema = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int64())});
+  auto read = [&](int64_t id, std::shared_ptr<::arrow::Array>& out) {
+    return ReadArray(out, {.path = path,
+                           .io = file_io,
+                           .projection = read_schema,
+                           .filter = Expressions::Equal("id", Literal::Long(id))});
+  };
+  std::shared_ptr<::arrow::Array> out;
+  ASSERT_THAT(read(missing_id, out), IsOk());
+  EXPECT_EQ(out, nullptr);
+  ASSERT_THAT(read(missing_id - 1, out), IsOk());
+  EXPECT_NE(out, nullptr);
+}
+
+TEST_F(ParquetReadWrite, ColumnEncodings) {
+  auto schema = std::make_shared<Schema>(std::vector<SchemaField>{
+      SchemaField::MakeRequired(1, "id", int64()),
+      SchemaField::MakeRequired(2, "value", float64()),
+      SchemaField::MakeOptional(3, "name", string()),
+  });
+  ArrowSchema arrow_c_schema;
+  ASSERT_THAT(ToArrowSchema(*schema, &arrow_c_schema), IsOk());
+  auto arrow_schema = ::arrow::ImportType(&arrow_c_schema).ValueOrDie();
+  std::string json = "[";
+  for (int i = 0; i < 1000; ++i) {
+    json += std::format(R"({}[{}, {}.5, "name-{:04}"])", i == 0 ? "" : ",", i, i, i);
+  }
+  json += "]";
+  auto array =
+      ::arrow::json::ArrayFromJSONString(::arrow::struct_(arrow_schema->fields()), json)
+          .ValueOrDie();
+
+  std::shared_ptr<FileIO> file_io = arrow::ArrowFileSystemFileIO::MakeMockFileIO();
+  auto& io = internal::checked_cast<arrow::ArrowFileSystemFileIO&>(*file_io);
+  const std::string path = "encodings.parquet";
+  auto write = [&](std::unordered_map<std::string, std::string> properties) {
+    return WriteArray(array, {.path = path,
+                              .schema = schema,
+                              .io = file_io,
+                              .properties = std::move(properties)});
+  };
+  // Returns whether the chunk of a column has a dictionary and uses an encoding.
+  auto column = [&](int i, ::parquet::Encoding::type encoding) {
+    auto metadata = ::parquet::ReadMetaData(io.fs()->OpenInputFile(path).ValueOrDie());
+    auto chunk = metadata->RowGroup(0)->ColumnChunk(i);
+    const auto& encodings = chunk->encodings();
+    return std::make_pair(chunk->has_dictionary_page(),
+                          std::ranges::find(encodings, encoding) != encodings.end());
+  };
+
+  // Columns are dictionary encoded by default.
+  ASSERT_THAT(write({}), IsOk());
+  EXPECT_EQ(column(0, ::parquet::Encoding::RLE_DICTIONARY), std::make_pair(true, true));
+  EXPECT_EQ(column(1, ::parquet::Encoding::RLE_DICTIONARY), std::make_pair(true, true));
+
+  // Floating point columns are split into byte streams, and sorted columns are delta
+  // encoded.
+  ASSERT_THAT(write({{"write.parquet.adaptive-encoding.enabled", "true"},
+                     {std::string(WriterOptions::kSortedFieldIdsProperty), "1,3"}}),
+              IsOk());
+  EXPECT_EQ(column(0, ::parquet::Encoding::DELTA_BINARY_PACKED),
+            std::make_pair(false, true));
+  EXPECT_EQ(column(1, ::parquet::Encoding::BYTE_STREAM_SPLIT),
+            std::make_pair(false, true));
+  EXPECT_EQ(column(2, ::parquet::Encoding::DELTA_BYTE_ARRAY),
+            std::make_pair(false, true));
+
+  // Unsorted columns keep their dictionary, and column encodings take precedence.
+  ASSERT_THAT(write({{"write.parquet.adaptive-encoding.enabled", "true"},
+                     {"write.parquet.encoding.column.value", "dictionary"},
+                     {"write.parquet.encoding.column.name", "delta-length-byte-array"},
+                     {"write.parquet.encoding.column.dropped", "plain"}}),
+              IsOk());
+  EXPECT_EQ(column(0, ::parquet::Encoding::RLE_DICTIONARY), std::make_pair(true, true));
+  EXPECT_EQ(column(1, ::parquet::Encoding::RLE_DICTIONARY), std::make_pair(true, true));
+  EXPECT_EQ(column(2, ::parquet::Encoding::DELTA_LENGTH_BYTE_ARRAY),
+            std::make_pair(false, true));
+
+  for (const auto& [key, value] : std::vector<std::pair<std::string, std::string>>{
+           {"write.parquet.encoding.column.id", "unknown"},
+           {"write.parquet.encoding.column.name", "delta-binary-packed"},
+           {"write.parquet.encoding.column.id", "delta-byte-array"},
+       }) {
+    EXPECT_THAT(write({{key, value}}), IsError(ErrorKind::kInvalidArgument))
+        << key << "=" << value;
+  }
+  EXPECT_THAT(write({{"write.parquet.adaptive-encoding.enabled", "true"},
+                     {std::string(WriterOptions::kSortedFieldIdsProperty), "1,id"}}),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(ParquetReadWrite, WriterMetrics) {
+  auto schema = std::make_shared<Schema>(std::vector<SchemaField>{
+      SchemaField::MakeRequired(1, "id", int64()),
+      SchemaField::MakeOptional(2, "name", string()),
+      SchemaField::MakeOptional(3, "score", float64()),
+  });
+  ArrowSchema arrow_c_schema;
+  ASSERT_THAT(ToArrowSchema(*schema, &arrow_c_schema), IsOk());
+  auto arrow_schema = ::arrow::ImportType(&arrow_c_schema).ValueOrDie();
+  auto array = ::arrow::json::ArrayFromJSONString(
+                   ::arrow::struct_(arrow_schema->fields()),
+                   R"([[3, "Carol", 1.5], [1, null, NaN], [2, "Alice", null]])")
+                   .ValueOrDie();
+
+  std::shared_ptr<FileIO> file_io = arrow::ArrowFileSystemFileIO::MakeMockFileIO();
+  auto writer = WriterFactoryRegistry::Open(
+      FileFormatType::kParquet,
+      {.path = "metrics.parquet",
+       .schema = schema,
+       .io = file_io,
+       .properties = {{"write.metadata.metrics.column.name", "truncate(2)"},
+                      {"write.metadata.metrics.column.score", "counts"}}});
+  ASSERT_THAT(writer, IsOk());
+  EXPECT_EQ(writer.value()->metrics(), std::nullopt);
+  ASSERT_THAT(WriteArray(array, *writer.value()), IsOk());
+
+  auto metrics = writer.value()->metrics();
+  ASSERT_TRUE(metrics.has_value());
+  EXPECT_EQ(metrics->row_count, 3);
+  for (int64_t field_id : {1, 2, 3}) {
+    EXPECT_GT(metrics->column_sizes.at(field_id), 0) << field_id;
+    EXPECT_EQ(metrics->value_counts.at(field_id), 3) << field_id;
+  }
+  EXPECT_EQ(metrics->lower_bounds.at(1), Literal::Long(1));
+  EXPECT_EQ(metrics->upper_bounds.at(1), Literal::Long(3));
+  EXPECT_EQ(metrics->null_value_counts.at(2), 1);
+  EXPECT_EQ(metrics->lower_bounds.at(2), Literal::String("Al"));
+  EXPECT_EQ(metrics->upper_bounds.at(2), Literal::String("Cb"));
+  EXPECT_EQ(metrics->null_value_counts.at(3), 1);
+  EXPECT_EQ(metrics->nan_value_counts.at(3), 1);
+  EXPECT_FALSE(metrics->lower_bounds.contains(3));
+}
+
+TEST_F(ParquetReadWrite, FooterMetrics) {
+  auto schema = std::make_shared<Schema>(std::vector<SchemaField>{
+      SchemaField::MakeRequired(1, "id", int64()),
+      SchemaField::MakeOptional(2, "name", string()),
+      SchemaField::MakeOptional(3, "score", float64()),
+  });
+  ArrowSchema arrow_c_schema;
+  ASSERT_THAT(ToArrowSchema(*schema, &arrow_c_schema), IsOk());
+  auto arrow_schema = ::arrow::ImportType(&arrow_c_schema).ValueOrDie();
+  auto array = ::arrow::json::ArrayFromJSONString(
+                   ::arrow::struct_(arrow_schema->fields()),
+                   R"([[3, "Carol", 1.5], [1, null, 0.5], [2, "Alice", null]])")
+                   .ValueOrDie();
+
+  std::shared_ptr<FileIO> file_io = arrow::ArrowFileSystemFileIO::MakeMockFileIO();
+  std::unordered_map<std::string, std::string> properties = {
+      {"write.metadata.metrics.column.name", "truncate(2)"},
+      {"write.metadata.metrics.column.score", "counts"}};
+  auto writer = WriterFactoryRegistry::Open(FileFormatType::kParquet,
+                                            {.path = "footer.parquet",
+                                             .schema = schema,
+                                             .io = file_io,
+                                             .properties = properties});
+  ASSERT_THAT(writer, IsOk());
+  ASSERT_THAT(WriteArray(array, *writer.value()), IsOk());
+  auto written = writer.value()->metrics();
+  ASSERT_TRUE(written.has_value());
+
+  // The metrics read from the footer match the metrics of the writer.
+  ICEBERG_UNWRAP_OR_FAIL(auto metrics_config, MetricsConfig::Make(properties, *schema));
+  ICEBERG_UNWRAP_OR_FAIL(auto footer,
+                         FooterReaderRegistry::Read(FileFormatType::kParquet,
+                                                    {.path = "footer.parquet",
+                                                     .io = file_io,
+                                                     .schema = schema,
+                                                     .metrics_config = metrics_config}));
+  EXPECT_EQ(footer.length, writer.value()->length());
+  EXPECT_EQ(footer.split_offsets.size(), 1);
+  EXPECT_EQ(footer.metrics.row_count, written->row_count);
+  EXPECT_EQ(footer.metrics.column_sizes, written->column_sizes);
+  EXPECT_EQ(footer.metrics.value_counts, written->value_counts);
+  EXPECT_EQ(footer.metrics.null_value_counts, written->null_value_counts);
+  EXPECT_EQ(footer.metrics.lower_bounds, written->lower_bounds);
+  EXPECT_EQ(footer.metrics.upper_bounds, written->upper_bounds);
+  EXPECT_EQ(footer.metrics.lower_bounds.at(2), Literal::String("Al"));
+  EXPECT_FALSE(footer.metrics.lower_bounds.contains(3));
+
+  EXPECT_THAT(FooterReaderRegistry::Read(FileFormatType::kParquet,
+                                         {.path = "footer.parquet", .io = file_io}),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(ParquetReadWrite, FooterMetricsWithNameMapping) {
+  // A file of another writer, without field ids and with two row groups.
+  auto arrow_schema = ::arrow::schema({::arrow::field("id", ::arrow::int64(), false),
+                                       ::arrow::field("name", ::arrow::utf8())});
+  auto batch = ::arrow::RecordBatch::FromStructArray(
+                   ::arrow::json::ArrayFromJSONString(
+                       ::arrow::struct_(arrow_schema->fields()),
+                       R"([[5, "b"], [2, null], [9, "a"], [4, null]])")
+                       .ValueOrDie())
+                   .ValueOrDie();
+  auto table = ::arrow::Table::FromRecordBatches(arrow_schema, {batch}).ValueOrDie();
+  std::shared_ptr<FileIO> file_io = arrow::ArrowFileSystemFileIO::MakeMockFileIO();
+  auto& io = internal::checked_cast<arrow::ArrowFileSystemFileIO&>(*file_io);
+  auto outfile = io.fs()->OpenOutputStream("unmapped.parquet").ValueOrDie();
+  ASSERT_TRUE(::parquet::arrow::WriteTable(*table, ::arrow::default_memory_pool(),
+                                           outfile, /*chunk_size=*/2)
+                  .ok());
+  ASSERT_TRUE(outfile->Close().ok());
+
+  auto schema = std::make_shared<Schema>(std::vector<SchemaField>{
+      SchemaField::MakeRequired(1, "id", int64()),
+      SchemaField::MakeOptional(2, "name", string()),
+  });
+  std::vector<MappedField> fields;
+  fields.emplace_back(MappedField{.names = {"id"}, .field_id = 1});
+  fields.emplace_back(MappedField{.names = {"name"}, .field_id = 2});
+  std::shared_ptr<NameMapping> name_mapping = NameMapping::Make(std::move(fields));
+
+  ICEBERG_UNWRAP_OR_FAIL(auto footer,
+                         FooterReaderRegistry::Read(FileFormatType::kParquet,
+                                                    {.path = "unmapped.parquet",
+                                                     .io = file_io,
+                                                     .schema = schema,
+                                                     .name_mapping = name_mapping}));
+  EXPECT_EQ(footer.split_offsets.size(), 2);
+  EXPECT_EQ(footer.metrics.row_count, 4);
+  EXPECT_EQ(footer.metrics.value_counts.at(1), 4);
+  EXPECT_EQ(footer.metrics.null_value_counts.at(2), 2);
+  EXPECT_EQ(footer.metrics.lower_bounds.at(1), Literal::Long(2));
+  EXPECT_EQ(footer.metrics.upper_bounds.at(1), Literal::Long(9));
+  // The second row group has only nulls, which do not bound the values.
+  EXPECT_EQ(footer.metrics.lower_bounds.at(2), Literal::String("a"));
+  EXPECT_EQ(footer.metrics.upper_bounds.at(2), Literal::String("b"));
+
+  // Without a name mapping, the columns have no field ids and no metrics.
+  ICEBERG_UNWRAP_OR_FAIL(
+      footer, FooterReaderRegistry::Read(
+                  FileFormatType::kParquet,
+                  {.path = "unmapped.parquet", .io = file_io, .schema = schema}));
+  EXPECT_EQ(footer.metrics.row_count, 4);
+  EXPECT_TRUE(footer.metrics.value_counts.empty());
+}
+
 }  // namespace iceberg::parquet
@@ -0,0 +1,118 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/partition_map.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/expression/literal.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+namespace {
+
+PartitionTupleKey Key(int32_t spec_id, const std::vector<Literal>& partition) {
+  auto key = PartitionTupleKey::Make(spec_id, partition);
+  EXPECT_THAT(key, IsOk());
+  return std::move(key).value();
+}
+
+}  // namespace
+
+TEST(PartitionTupleKeyTest, Equality) {
+  auto key = Key(0, {Literal::Int(1), Literal::String("a")});
+  EXPECT_EQ(key, Key(0, {Literal::Int(1), Literal::String("a")}));
+  EXPECT_EQ(key.hash(), Key(0, {Literal::Int(1), Literal::String("a")}).hash());
+  EXPECT_EQ(key.spec_id(), 0);
+
+  // The spec, the values and the types of the values are part of the key.
+  EXPECT_NE(key, Key(1, {Literal::Int(1), Literal::String("a")}));
+  EXPECT_NE(key, Key(0, {Literal::Int(2), Literal::String("a")}));
+  EXPECT_NE(key, Key(0, {Literal::Long(1), Literal::String("a")}));
+  EXPECT_NE(key, Key(0, {Literal::Int(1), Literal::Null(string())}));
+  EXPECT_NE(Key(0, {Literal::String("ab"), Literal::String("")}),
+            Key(0, {Literal::String("a"), Literal::String("b")}));
+  EXPECT_EQ(Key(0, {}), Key(0, {}));
+}
+
+TEST(PartitionMapTest, InsertAndFind) {
+  PartitionMap<int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.Find(Key(0, {Literal::Int(1)})), nullptr);
+
+  auto [value, inserted] = map.TryEmplace(Key(0, {Literal::Int(1)}), 10);
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(*value, 10);
+  std::tie(value, inserted) = map.TryEmplace(Key(0, {Literal::Int(1)}), 20);
+  EXPECT_FALSE(inserted);
+  EXPECT_EQ(*value, 10);
+
+  map[Key(1, {Literal::Int(1)})] += 5;
+  EXPECT_EQ(map.size(), 2);
+  ASSERT_NE(map.Find(Key(1, {Literal::Int(1)})), nullptr);
+  EXPECT_EQ(*map.Find(Key(1, {Literal::Int(1)})), 5);
+  EXPECT_FALSE(map.Contains(Key(0, {Literal::Int(2)})));
+
+  map.Clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_FALSE(map.Contains(Key(0, {Literal::Int(1)})));
+}
+
+TEST(PartitionMapTest, GrowsInInsertionOrder) {
+  PartitionMap<int32_t> map;
+  constexpr int32_t kNumPartitions = 10000;
+  for (int32_t i = 0; i < kNumPartitions; ++i) {
+    EXPECT_TRUE(map.TryEmplace(Key(i % 3, {Literal::Int(i)}), i).second);
+  }
+  EXPECT_EQ(map.size(), kNumPartitions);
+  for (int32_t i = 0; i < kNumPartitions; ++i) {
+    const auto* value = map.Find(Key(i % 3, {Literal::Int(i)}));
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(*value, i);
+    EXPECT_FALSE(map.Contains(Key((i + 1) % 3, {Literal::Int(i)})));
+  }
+
+  int32_t expected = 0;
+  for (const auto& [key, value] : map) {
+    EXPECT_EQ(key.spec_id(), expected % 3);
+    EXPECT_EQ(value, expected++);
+  }
+}
+
+TEST(PartitionSetTest, InsertAndContains) {
+  PartitionSet set;
+  EXPECT_TRUE(set.Insert(Key(0, {Literal::String("a")})));
+  EXPECT_TRUE(set.Insert(Key(0, {Literal::Null(string())})));
+  EXPECT_FALSE(set.Insert(Key(0, {Literal::String("a")})));
+  EXPECT_EQ(set.size(), 2);
+  EXPECT_TRUE(set.Contains(Key(0, {Literal::Null(string())})));
+  EXPECT_FALSE(set.Contains(Key(0, {Literal::String("b")})));
+
+  std::vector<PartitionTupleKey> keys;
+  set.ForEach([&](const PartitionTupleKey& key) { keys.push_back(key); });
+  ASSERT_EQ(keys.size(), 2);
+  EXPECT_EQ(keys[0], Key(0, {Literal::String("a")}));
+}
+
+}  // namespace iceberg
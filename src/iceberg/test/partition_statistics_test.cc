@@ -0,0 +1,346 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/partition_statistics.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/expression/expressions.h"
+#include "iceberg/file_reader.h"
+#include "iceberg/file_writer.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/schema_internal.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/transform.h"
+#include "iceberg/type.h"
+#include "iceberg/util/timepoint.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief The batches written to the files of the fake format, keyed by path.
+std::map<std::string, std::vector<ArrowArray>>& WrittenBatches() {
+  static std::map<std::string, std::vector<ArrowArray>> batches;
+  return batches;
+}
+
+/// \brief A writer that keeps the written batches in memory.
+class FakeWriter : public Writer {
+ public:
+  Status Open(const WriterOptions& options) override {
+    path_ = options.path;
+    WrittenBatches()[path_].clear();
+    return {};
+  }
+
+  Status Close() override { return {}; }
+
+  Status Write(ArrowArray* data) override {
+    length_ += data->length;
+    WrittenBatches()[path_].push_back(*data);
+    data->release = nullptr;
+    return {};
+  }
+
+  std::optional<Metrics> metrics() override { return std::nullopt; }
+
+  std::optional<int64_t> length() override { return length_ * 100; }
+
+  std::vector<int64_t> split_offsets() override { return {}; }
+
+ private:
+  std::string path_;
+  int64_t length_ = 0;
+};
+
+/// \brief A reader that returns the batches kept by the fake writer.
+class FakeReader : public Reader {
+ public:
+  Status Open(const ReaderOptions& options) override {
+    projection_ = options.projection;
+    batches_ = std::move(WrittenBatches()[options.path]);
+    return {};
+  }
+
+  Status Close() override { return {}; }
+
+  Result<std::optional<ArrowArray>> Next() override {
+    if (next_ == batches_.size()) {
+      return std::nullopt;
+    }
+    return batches_[next_++];
+  }
+
+  Result<ArrowSchema> Schema() override {
+    ArrowSchema schema;
+    ICEBERG_RETURN_UNEXPECTED(ToArrowSchema(*projection_, &schema));
+    return schema;
+  }
+
+  Result<std::unordered_map<std::string, std::string>> Metadata() override {
+    return std::unordered_map<std::string, std::string>{};
+  }
+
+ private:
+  std::shared_ptr<class Schema> projection_;
+  std::vector<ArrowArray> batches_;
+  size_t next_ = 0;
+};
+
+std::shared_ptr<DataFile> MakeFile(DataFile::Content content,
+                                   std::vector<Literal> partition, int32_t spec_id,
+                                   int64_t record_count) {
+  auto file = std::make_shared<DataFile>();
+  file->content = content;
+  file->file_path = "file-" + std::to_string(record_count);
+  file->file_format = FileFormatType::kParquet;
+  file->partition = std::move(partition);
+  file->partition_spec_id = spec_id;
+  file->record_count = record_count;
+  file->file_size_in_bytes = record_count * 10;
+  return file;
+}
+
+ManifestEntry MakeEntry(std::shared_ptr<DataFile> file, int64_t snapshot_id,
+                        ManifestStatus status = ManifestStatus::kAdded) {
+  return ManifestEntry{
+      .status = status, .snapshot_id = snapshot_id, .data_file = std::move(file)};
+}
+
+}  // namespace
+
+class PartitionStatisticsTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    auto schema = std::make_shared<Schema>(
+        std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32()),
+                                 SchemaField::MakeOptional(2, "category", string())},
+        /*schema_id=*/0);
+    metadata_.schemas = {schema};
+    metadata_.partition_specs = {
+        std::make_shared<PartitionSpec>(
+            schema, 0,
+            std::vector<PartitionField>{
+                PartitionField(1, 1000, "id", Transform::Identity())}),
+        std::make_shared<PartitionSpec>(
+            schema, 1,
+            std::vector<PartitionField>{
+                PartitionField(1, 1000, "id", Transform::Identity()),
+                PartitionField(2, 1001, "category", Transform::Identity())})};
+    for (auto [snapshot_id, timestamp] : {std::pair{10, 1000}, std::pair{11, 2000}}) {
+      metadata_.snapshots.push_back(std::make_shared<Snapshot>(
+          Snapshot{.snapshot_id = snapshot_id,
+                   .sequence_number = snapshot_id,
+                   .timestamp_ms = TimePointMsFromUnixMs(timestamp).value()}));
+    }
+  }
+
+  /// \brief Collects the statistics of files of both specs, of the partitions
+  /// (id=1, category=null), (id=1, category="a") and (id=2, category=null).
+  std::vector<PartitionStats> CollectStats() {
+    auto collector = PartitionStatsCollector::Make(metadata_);
+    EXPECT_THAT(collector, IsOk());
+    const Literal null_category = Literal::Null(string());
+    for (const auto& entry : {
+             MakeEntry(MakeFile(DataFile::Content::kData, {Literal::Int(1)}, 0, 5), 10),
+             MakeEntry(MakeFile(DataFile::Content::kData, {Literal::Int(1)}, 0, 7), 11),
+             MakeEntry(MakeFile(DataFile::Content::kData, {Literal::Int(2)}, 0, 3), 10),
+             MakeEntry(MakeFile(DataFile::Content::kData, {Literal::Int(2)}, 0, 100), 11,
+                       ManifestStatus::kDeleted),
+             MakeEntry(MakeFile(DataFile::Content::kData,
+                                {Literal::Int(1), Literal::String("a")}, 1, 11),
+                       11),
+             MakeEntry(MakeFile(DataFile::Content::kEqualityDeletes,
+                                {Literal::Int(1), null_category}, 1, 2),
+                       11),
+         }) {
+      EXPECT_THAT(collector->Update(entry), IsOk());
+    }
+    auto stats = collector->stats();
+    std::ranges::sort(stats, [](const auto& lhs, const auto& rhs) {
+      return std::pair{std::get<int32_t>(lhs.partition[0].value()),
+                       !lhs.partition[1].IsNull()} <
+             std::pair{std::get<int32_t>(rhs.partition[0].value()),
+                       !rhs.partition[1].IsNull()};
+    });
+    return stats;
+  }
+
+  TableMetadata metadata_;
+};
+
+TEST_F(PartitionStatisticsTest, UnifiedPartitionType) {
+  ICEBERG_UNWRAP_OR_FAIL(auto partition_type, UnifiedPartitionType(metadata_));
+  ASSERT_EQ(partition_type->fields().size(), 2);
+  EXPECT_EQ(partition_type->fields()[0],
+            SchemaField::MakeOptional(1000, "id", int32()));
+  EXPECT_EQ(partition_type->fields()[1],
+            SchemaField::MakeOptional(1001, "category", string()));
+
+  auto schema = PartitionStatsSchema(partition_type);
+  EXPECT_EQ(schema->fields().size(), 13);
+  EXPECT_EQ(schema->fields()[0].field_id(), 1);
+}
+
+TEST_F(PartitionStatisticsTest, CollectStats) {
+  auto stats = CollectStats();
+  ASSERT_EQ(stats.size(), 3);
+
+  // Files of both specs fall into the same unified partition.
+  const auto& id1 = stats[0];
+  EXPECT_EQ(id1.spec_id, 1);
+  EXPECT_EQ(id1.data_record_count, 12);
+  EXPECT_EQ(id1.data_file_count, 2);
+  EXPECT_EQ(id1.total_data_file_size_in_bytes, 120);
+  EXPECT_EQ(id1.equality_delete_record_count, 2);
+  EXPECT_EQ(id1.equality_delete_file_count, 1);
+  EXPECT_EQ(id1.delete_file_count(), 1);
+  EXPECT_EQ(id1.last_updated_at, 2000);
+  EXPECT_EQ(id1.last_updated_snapshot_id, 11);
+
+  EXPECT_EQ(stats[1].data_record_count, 11);
+  EXPECT_EQ(stats[1].partition[1], Literal::String("a"));
+
+  // Deleted entries are not counted.
+  const auto& id2 = stats[2];
+  EXPECT_EQ(id2.spec_id, 0);
+  EXPECT_EQ(id2.data_record_count, 3);
+  EXPECT_EQ(id2.data_file_count, 1);
+  EXPECT_EQ(id2.last_updated_snapshot_id, 10);
+
+  ICEBERG_UNWRAP_OR_FAIL(auto collector, PartitionStatsCollector::Make(metadata_));
+  EXPECT_THAT(collector.Update(MakeEntry(
+                  MakeFile(DataFile::Content::kData, {Literal::Int(1)}, 5, 1), 10)),
+              IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(
+      collector.Update(MakeEntry(MakeFile(DataFile::Content::kData, {}, 0, 1), 10)),
+      IsError(ErrorKind::kInvalidManifest));
+}
+
+TEST_F(PartitionStatisticsTest, MergeStats) {
+  PartitionStats stats{.spec_id = 0,
+                       .data_record_count = 5,
+                       .data_file_count = 1,
+                       .total_record_count = 5,
+                       .last_updated_at = 2000,
+                       .last_updated_snapshot_id = 11};
+  stats.Merge(PartitionStats{.spec_id = 1,
+                             .data_record_count = 3,
+                             .data_file_count = 1,
+                             .last_updated_at = 1000,
+                             .last_updated_snapshot_id = 10,
+                             .dv_count = 1});
+  EXPECT_EQ(stats.spec_id, 1);
+  EXPECT_EQ(stats.data_record_count, 8);
+  EXPECT_EQ(stats.data_file_count, 2);
+  EXPECT_EQ(stats.delete_file_count(), 1);
+  EXPECT_EQ(stats.total_record_count, std::nullopt);
+  EXPECT_EQ(stats.last_updated_snapshot_id, 11);
+}
+
+TEST_F(PartitionStatisticsTest, CountPartitions) {
+  auto stats = CollectStats();
+  ICEBERG_UNWRAP_OR_FAIL(auto partition_type, UnifiedPartitionType(metadata_));
+
+  ICEBERG_UNWRAP_OR_FAIL(auto all, CountPartitions(partition_type, stats, nullptr));
+  EXPECT_EQ(all.partition_count, 3);
+  EXPECT_EQ(all.data_record_count, 26);
+  EXPECT_EQ(all.data_file_count, 4);
+  EXPECT_EQ(all.row_count(), std::nullopt);
+
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto id1,
+      CountPartitions(partition_type, stats, Expressions::Equal("id", Literal::Int(1))));
+  EXPECT_EQ(id1.partition_count, 2);
+  EXPECT_EQ(id1.data_record_count, 23);
+  EXPECT_EQ(id1.delete_file_count, 1);
+
+  // Partitions without deletes give the exact row count.
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto category_a,
+      CountPartitions(partition_type, stats,
+                      Expressions::Equal("category", Literal::String("a"))));
+  EXPECT_EQ(category_a.partition_count, 1);
+  EXPECT_EQ(category_a.row_count(), 11);
+
+  EXPECT_THAT(CountPartitions(partition_type, stats,
+                              Expressions::Equal("missing", Literal::Int(1))),
+              IsError(ErrorKind::kInvalidExpression));
+}
+
+TEST_F(PartitionStatisticsTest, WriteAndReadStatsFile) {
+  auto& writer_factory = WriterFactoryRegistry::GetFactory(FileFormatType::kOrc);
+  auto& reader_factory = ReaderFactoryRegistry::GetFactory(FileFormatType::kOrc);
+  auto original_writer_factory = std::exchange(
+      writer_factory,
+      []() -> Result<std::unique_ptr<Writer>> { return std::make_unique<FakeWriter>(); });
+  auto original_reader_factory = std::exchange(
+      reader_factory,
+      []() -> Result<std::unique_ptr<Reader>> { return std::make_unique<FakeReader>(); });
+
+  auto stats = CollectStats();
+  ICEBERG_UNWRAP_OR_FAIL(auto partition_type, UnifiedPartitionType(metadata_));
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto file, WritePartitionStatsFile(partition_type, stats, 11, FileFormatType::kOrc,
+                                         "stats.orc", nullptr));
+  EXPECT_EQ(file.snapshot_id, 11);
+  EXPECT_EQ(file.path, "stats.orc");
+  EXPECT_EQ(file.file_size_in_bytes, 300);
+
+  ICEBERG_UNWRAP_OR_FAIL(auto read,
+                         ReadPartitionStatsFile(partition_type, file, nullptr));
+  EXPECT_EQ(read, stats);
+
+  // Count queries are answered from the statistics file of the snapshot.
+  ASSERT_THAT(WritePartitionStatsFile(partition_type, stats, 11, FileFormatType::kOrc,
+                                      "stats.orc", nullptr),
+              IsOk());
+  metadata_.partition_statistics.push_back(
+      std::make_shared<PartitionStatisticsFile>(file));
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto counts,
+      CountPartitionsFromStatistics(metadata_, 11, nullptr,
+                                    Expressions::Equal("id", Literal::Int(2))));
+  ASSERT_TRUE(counts.has_value());
+  EXPECT_EQ(counts->row_count(), 3);
+  EXPECT_THAT(CountPartitionsFromStatistics(metadata_, 10, nullptr, nullptr),
+              HasValue(::testing::Eq(std::nullopt)));
+
+  auto unpartitioned = std::make_shared<StructType>(std::vector<SchemaField>{});
+  EXPECT_THAT(WritePartitionStatsFile(unpartitioned, stats, 11, FileFormatType::kOrc,
+                                      "empty.orc", nullptr),
+              IsError(ErrorKind::kInvalidArgument));
+
+  writer_factory = std::move(original_writer_factory);
+  reader_factory = std::move(original_reader_factory);
+}
+
+}  // namespace iceberg
@@ -0,0 +1,131 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/util/persistent_vector.h"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace iceberg {
+
+namespace {
+
+PersistentVector<int> Iota(int count) {
+  std::vector<int> values(count);
+  std::iota(values.begin(), values.end(), 0);
+  return values;
+}
+
+}  // namespace
+
+TEST(PersistentVectorTest, AccessesElementsAcrossChunks) {
+  auto vector = Iota(200);
+  ASSERT_EQ(vector.size(), 200);
+  EXPECT_EQ(vector.front(), 0);
+  EXPECT_EQ(vector.back(), 199);
+  for (int i = 0; i < 200; ++i) {
+    EXPECT_EQ(vector[i], i);
+  }
+  EXPECT_EQ(std::ranges::find(vector, 130) - vector.begin(), 130);
+  EXPECT_EQ(*vector.rbegin(), 199);
+  EXPECT_EQ(vector, Iota(200));
+  EXPECT_NE(vector, Iota(199));
+  EXPECT_TRUE(PersistentVector<int>{}.empty());
+  EXPECT_THAT((PersistentVector<int>{1, 2, 3}), ::testing::ElementsAre(1, 2, 3));
+}
+
+TEST(PersistentVectorTest, CopiesShareElements) {
+  auto vector = Iota(100);
+  auto copy = vector;
+  // Both vectors hold the same elements until one of them changes.
+  EXPECT_EQ(&copy[10], &vector[10]);
+  EXPECT_EQ(&copy[99], &vector[99]);
+
+  copy.push_back(100);
+  EXPECT_EQ(vector.size(), 100);
+  EXPECT_EQ(copy.size(), 101);
+  EXPECT_EQ(copy.back(), 100);
+  // Appending only copies the last chunk.
+  EXPECT_EQ(&copy[10], &vector[10]);
+  EXPECT_NE(&copy[99], &vector[99]);
+  EXPECT_EQ(copy[99], 99);
+}
+
+TEST(PersistentVectorTest, ErasesFromTheFront) {
+  auto vector = Iota(150);
+  auto copy = vector;
+  copy.erase(copy.begin(), copy.begin() + 70);
+  ASSERT_EQ(copy.size(), 80);
+  EXPECT_EQ(copy.front(), 70);
+  EXPECT_EQ(&copy[0], &vector[70]);
+  copy.push_back(150);
+  EXPECT_EQ(copy.back(), 150);
+  EXPECT_EQ(vector.size(), 150);
+  EXPECT_EQ(vector.back(), 149);
+
+  copy.erase(copy.begin(), copy.end());
+  EXPECT_TRUE(copy.empty());
+}
+
+TEST(PersistentVectorTest, ErasesElsewhere) {
+  auto vector = Iota(150);
+  auto copy = vector;
+  auto it = copy.erase(copy.begin() + 10, copy.begin() + 100);
+  EXPECT_EQ(*it, 100);
+  ASSERT_EQ(copy.size(), 60);
+  EXPECT_EQ(copy[9], 9);
+  EXPECT_EQ(copy[10], 100);
+  EXPECT_EQ(copy.back(), 149);
+  EXPECT_EQ(vector, Iota(150));
+
+  EXPECT_EQ(erase_if(copy, [](int value) { return value % 2 == 1; }), 30);
+  ASSERT_EQ(copy.size(), 30);
+  EXPECT_EQ(copy[4], 8);
+  EXPECT_EQ(copy[5], 100);
+  EXPECT_EQ(erase_if(copy, [](int value) { return value > 1000; }), 0);
+  EXPECT_EQ(vector, Iota(150));
+
+  std::vector<int> calls;
+  EXPECT_EQ(erase_if(vector,
+                     [&](int value) {
+                       calls.push_back(value);
+                       return value == 0;
+                     }),
+            1);
+  const auto expected_calls = Iota(150);
+  EXPECT_EQ(calls, std::vector<int>(expected_calls.begin(), expected_calls.end()));
+  EXPECT_EQ(vector.front(), 1);
+}
+
+TEST(PersistentVectorTest, SharesPointedToElements) {
+  PersistentVector<std::shared_ptr<std::string>> vector;
+  vector.push_back(std::make_shared<std::string>("a"));
+  vector.emplace_back(std::make_shared<std::string>("b"));
+  auto copy = vector;
+  EXPECT_EQ(copy[1], vector[1]);
+  EXPECT_EQ(*copy[1], "b");
+}
+
+}  // namespace iceberg
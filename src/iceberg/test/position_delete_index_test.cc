@@ -0,0 +1,127 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/deletes/position_delete_index.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/test/matchers.h"
+
+namespace iceberg {
+
+namespace {
+
+std::vector<int64_t> Positions(const PositionDeleteIndex& index, int64_t begin,
+                               int64_t end) {
+  std::vector<int64_t> positions;
+  index.ForEach(begin, end, [&](int64_t position) { positions.push_back(position); });
+  return positions;
+}
+
+}  // namespace
+
+TEST(PositionDeleteIndexTest, DeletePositions) {
+  PositionDeleteIndex index;
+  EXPECT_TRUE(index.IsEmpty());
+
+  index.Delete(3);
+  index.Delete(10, 13);
+  index.Delete(-1);
+  index.Delete(5, 5);
+  EXPECT_FALSE(index.IsEmpty());
+  EXPECT_EQ(index.Cardinality(), 4);
+  EXPECT_TRUE(index.IsDeleted(3));
+  EXPECT_TRUE(index.IsDeleted(12));
+  EXPECT_FALSE(index.IsDeleted(13));
+  EXPECT_FALSE(index.IsDeleted(-1));
+  EXPECT_EQ(Positions(index, 0, 100), (std::vector<int64_t>{3, 10, 11, 12}));
+  EXPECT_EQ(Positions(index, 4, 12), (std::vector<int64_t>{10, 11}));
+  EXPECT_TRUE(Positions(index, 13, 100).empty());
+}
+
+TEST(PositionDeleteIndexTest, PositionsBeyond32Bits) {
+  constexpr int64_t kHigh = int64_t{1} << 32;
+  PositionDeleteIndex index;
+  index.Delete(kHigh - 2, kHigh + 2);
+  index.Delete(5 * kHigh + 7);
+  EXPECT_EQ(index.Cardinality(), 5);
+  EXPECT_TRUE(index.IsDeleted(kHigh - 1));
+  EXPECT_TRUE(index.IsDeleted(kHigh));
+  EXPECT_FALSE(index.IsDeleted(7));
+  EXPECT_EQ(Positions(index, kHigh - 1, 6 * kHigh),
+            (std::vector<int64_t>{kHigh - 1, kHigh, kHigh + 1, 5 * kHigh + 7}));
+}
+
+TEST(PositionDeleteIndexTest, Merge) {
+  PositionDeleteIndex index;
+  index.Delete(1);
+  PositionDeleteIndex other;
+  other.Delete(1);
+  other.Delete(int64_t{1} << 40);
+  index.Merge(other);
+  EXPECT_EQ(index.Cardinality(), 2);
+  EXPECT_TRUE(index.IsDeleted(int64_t{1} << 40));
+}
+
+TEST(PositionDeleteIndexTest, DeletionVectorRoundTrip) {
+  PositionDeleteIndex index;
+  index.Delete(0, 100);
+  index.Delete(int64_t{3} << 32);
+  auto blob = index.SerializeDeletionVector();
+  // Length, magic bytes, bitmap count and checksum.
+  ASSERT_GT(blob.size(), 20);
+  EXPECT_EQ(static_cast<uint8_t>(blob[4]), 0xD1);
+  EXPECT_EQ(static_cast<uint8_t>(blob[7]), 0x64);
+
+  auto deserialized = PositionDeleteIndex::DeserializeDeletionVector(blob);
+  ASSERT_THAT(deserialized, IsOk());
+  EXPECT_EQ(deserialized->Cardinality(), 101);
+  EXPECT_TRUE(deserialized->IsDeleted(99));
+  EXPECT_TRUE(deserialized->IsDeleted(int64_t{3} << 32));
+
+  auto empty = PositionDeleteIndex::DeserializeDeletionVector(
+      PositionDeleteIndex().SerializeDeletionVector());
+  ASSERT_THAT(empty, IsOk());
+  EXPECT_TRUE(empty->IsEmpty());
+}
+
+TEST(PositionDeleteIndexTest, CorruptedDeletionVector) {
+  PositionDeleteIndex index;
+  index.Delete(42);
+  const auto blob = index.SerializeDeletionVector();
+
+  EXPECT_THAT(PositionDeleteIndex::DeserializeDeletionVector(blob.substr(0, 8)),
+              IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(PositionDeleteIndex::DeserializeDeletionVector(blob + "x"),
+              IsError(ErrorKind::kInvalidArgument));
+
+  auto bad_magic = blob;
+  bad_magic[5] = 0;
+  EXPECT_THAT(PositionDeleteIndex::DeserializeDeletionVector(bad_magic),
+              IsError(ErrorKind::kInvalidArgument));
+
+  auto bad_checksum = blob;
+  bad_checksum.back() ^= 1;
+  EXPECT_THAT(PositionDeleteIndex::DeserializeDeletionVector(bad_checksum),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+}  // namespace iceberg
@@ -0,0 +1,172 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/deletes/position_delete_writer.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/deletes/position_delete_index.h"
+#include "iceberg/metadata_columns.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/util/conversions.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief What a fake writer has written to a file.
+struct WrittenFile {
+  std::string path;
+  std::vector<std::pair<std::string, int64_t>> rows;
+  int32_t batches = 0;
+};
+
+/// \brief A writer that records the (file_path, pos) rows written to its file.
+class FakeWriter : public Writer {
+ public:
+  explicit FakeWriter(WrittenFile& file) : file_(file) {}
+
+  Status Open(const WriterOptions& options) override {
+    file_.path = options.path;
+    return {};
+  }
+
+  Status Close() override { return {}; }
+
+  Status Write(ArrowArray* data) override {
+    const ArrowArray& paths = *data->children[0];
+    const ArrowArray& positions = *data->children[1];
+    const auto* offsets = static_cast<const int32_t*>(paths.buffers[1]);
+    const auto* chars = static_cast<const char*>(paths.buffers[2]);
+    const auto* values = static_cast<const int64_t*>(positions.buffers[1]);
+    for (int64_t row = 0; row < data->length; ++row) {
+      file_.rows.emplace_back(
+          std::string(chars + offsets[row], chars + offsets[row + 1]), values[row]);
+    }
+    ++file_.batches;
+    data->release(data);
+    return {};
+  }
+
+  std::optional<Metrics> metrics() override { return std::nullopt; }
+
+  std::optional<int64_t> length() override {
+    return static_cast<int64_t>(file_.rows.size()) * 16;
+  }
+
+  std::vector<int64_t> split_offsets() override { return {4}; }
+
+ private:
+  WrittenFile& file_;
+};
+
+std::vector<uint8_t> Bound(const Literal& value) {
+  return Conversions::ToBytes(value).value();
+}
+
+}  // namespace
+
+class PositionDeleteWriterTest : public ::testing::Test {
+ protected:
+  PositionDeleteWriterOptions Options() {
+    return PositionDeleteWriterOptions{
+        .path = "deletes.parquet",
+        .spec_id = 2,
+        .partition = {Literal::Int(7)},
+        .writer_factory = [this]() -> Result<std::unique_ptr<Writer>> {
+          return std::make_unique<FakeWriter>(file_);
+        }};
+  }
+
+  WrittenFile file_;
+};
+
+TEST_F(PositionDeleteWriterTest, SortsDeletesByPathAndPosition) {
+  ICEBERG_UNWRAP_OR_FAIL(auto writer, PositionDeleteWriter::Make(Options()));
+  ASSERT_THAT(writer->Delete("b.parquet", 7), IsOk());
+  ASSERT_THAT(writer->Delete("a.parquet", int64_t{1} << 33), IsOk());
+  ASSERT_THAT(writer->Delete("b.parquet", 2), IsOk());
+  ASSERT_THAT(writer->Delete("a.parquet", 5), IsOk());
+  ASSERT_THAT(writer->Delete("b.parquet", 7), IsOk());
+  PositionDeleteIndex positions;
+  positions.Delete(3, 5);
+  ASSERT_THAT(writer->Delete("c.parquet", positions), IsOk());
+  EXPECT_THAT(writer->Delete("a.parquet", -1), IsError(ErrorKind::kInvalidArgument));
+
+  ICEBERG_UNWRAP_OR_FAIL(auto delete_file, writer->Close());
+  EXPECT_EQ(file_.path, "deletes.parquet");
+  using Row = std::pair<std::string, int64_t>;
+  EXPECT_THAT(file_.rows, ::testing::ElementsAre(Row("a.parquet", 5),
+                                            Row("a.parquet", int64_t{1} << 33),
+                                            Row("b.parquet", 2), Row("b.parquet", 7),
+                                            Row("c.parquet", 3), Row("c.parquet", 4)));
+
+  ASSERT_TRUE(delete_file.has_value());
+  EXPECT_EQ(delete_file->content, DataFile::Content::kPositionDeletes);
+  EXPECT_EQ(delete_file->file_path, "deletes.parquet");
+  EXPECT_EQ(delete_file->file_format, FileFormatType::kParquet);
+  EXPECT_EQ(delete_file->record_count, 6);
+  EXPECT_EQ(delete_file->file_size_in_bytes, 96);
+  EXPECT_EQ(delete_file->partition_spec_id, 2);
+  EXPECT_EQ(delete_file->partition, std::vector<Literal>{Literal::Int(7)});
+  EXPECT_FALSE(delete_file->referenced_data_file.has_value());
+  const int32_t path_id = MetadataColumns::kDeleteFilePath.field_id();
+  const int32_t pos_id = MetadataColumns::kDeleteFilePos.field_id();
+  EXPECT_EQ(delete_file->lower_bounds.at(path_id), Bound(Literal::String("a.parquet")));
+  EXPECT_EQ(delete_file->upper_bounds.at(path_id), Bound(Literal::String("c.parquet")));
+  EXPECT_EQ(delete_file->lower_bounds.at(pos_id), Bound(Literal::Long(2)));
+  EXPECT_EQ(delete_file->upper_bounds.at(pos_id), Bound(Literal::Long(int64_t{1} << 33)));
+  EXPECT_EQ(delete_file->value_counts.at(pos_id), 6);
+  EXPECT_THAT(writer->Close(), IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(PositionDeleteWriterTest, ReferencesSingleDataFile) {
+  ICEBERG_UNWRAP_OR_FAIL(auto writer, PositionDeleteWriter::Make(Options()));
+  for (int64_t position = 5000; position > 0; --position) {
+    ASSERT_THAT(writer->Delete("a.parquet", position), IsOk());
+  }
+  ICEBERG_UNWRAP_OR_FAIL(auto delete_file, writer->Close());
+  ASSERT_TRUE(delete_file.has_value());
+  EXPECT_EQ(delete_file->referenced_data_file, "a.parquet");
+  EXPECT_EQ(delete_file->record_count, 5000);
+  // Deletes are written in batches.
+  EXPECT_EQ(file_.batches, 2);
+  ASSERT_EQ(file_.rows.size(), 5000);
+  EXPECT_EQ(file_.rows.front().second, 1);
+  EXPECT_EQ(file_.rows.back().second, 5000);
+}
+
+TEST_F(PositionDeleteWriterTest, NoDeletes) {
+  ICEBERG_UNWRAP_OR_FAIL(auto writer, PositionDeleteWriter::Make(Options()));
+  ICEBERG_UNWRAP_OR_FAIL(auto delete_file, writer->Close());
+  EXPECT_FALSE(delete_file.has_value());
+  EXPECT_TRUE(file_.path.empty());
+
+  auto options = Options();
+  options.path.clear();
+  EXPECT_THAT(PositionDeleteWriter::Make(std::move(options)),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+}  // namespace iceberg
@@ -17,7 +17,9 @@
  * under the License.
  */
 
+#include "iceberg/expression/binder.h"
 #include "iceberg/expression/expressions.h"
+#include "iceberg/expression/predicate.h"
 #include "iceberg/schema.h"
 #include "iceberg/test/matchers.h"
 #include "iceberg/type.h"
@@ -373,6 +375,37 @@ TEST_F(PredicateTest, UnboundPredicateBindIn) {
 
   auto bound_multi = bound_multi_result.value();
   EXPECT_EQ(bound_multi->op(), Expression::Operation::kIn);
+
+  // Test IN operation with duplicate values (should be deduplicated)
+  auto in_duplicates = Expressions::In(
+      "age", {Literal::Int(30), Literal::Int(25), Literal::Int(30), Literal::Int(25)});
+  ICEBERG_UNWRAP_OR_FAIL(auto bound_duplicates, in_duplicates->Bind(*schema_, true));
+  ASSERT_EQ(bound_duplicates->op(), Expression::Operation::kIn);
+  EXPECT_THAT(
+      std::dynamic_pointer_cast<BoundSetPredicate>(bound_duplicates)->literal_set(),
+      ::testing::SizeIs(2));
+
+  auto in_same = Expressions::In("age", {Literal::Int(25), Literal::Int(25)});
+  ICEBERG_UNWRAP_OR_FAIL(auto bound_same, in_same->Bind(*schema_, true));
+  EXPECT_EQ(bound_same->op(), Expression::Operation::kEq);
+}
+
+TEST_F(PredicateTest, UnboundPredicateBindInUuid) {
+  Schema schema({SchemaField::MakeRequired(1, "uuid", uuid())}, /*schema_id=*/0);
+  auto first = Uuid::GenerateV4();
+  auto second = Uuid::GenerateV4();
+  auto in_duplicates =
+      Expressions::In("uuid", {Literal::UUID(first), Literal::UUID(second),
+                               Literal::UUID(first), Literal::UUID(second)});
+  ICEBERG_UNWRAP_OR_FAIL(auto bound_duplicates, in_duplicates->Bind(schema, true));
+  ASSERT_EQ(bound_duplicates->op(), Expression::Operation::kIn);
+  EXPECT_THAT(
+      std::dynamic_pointer_cast<BoundSetPredicate>(bound_duplicates)->literal_set(),
+      ::testing::SizeIs(2));
+
+  auto in_same = Expressions::In("uuid", {Literal::UUID(first), Literal::UUID(first)});
+  ICEBERG_UNWRAP_OR_FAIL(auto bound_same, in_same->Bind(schema, true));
+  EXPECT_EQ(bound_same->op(), Expression::Operation::kEq);
 }
 
 TEST_F(PredicateTest, FloatingPointNaNPredicates) {
@@ -433,4 +466,74 @@ TEST_F(PredicateTest, ComplexExpressionCombinations) {
   EXPECT_EQ(nested->op(), Expression::Operation::kAnd);
 }
 
+TEST_F(PredicateTest, BindMergesRanges) {
+  auto literal_of = [](const std::shared_ptr<Expression>& expr) {
+    return std::dynamic_pointer_cast<BoundLiteralPredicate>(expr)->literal();
+  };
+
+  // The tighter bound is kept, across nested conjunctions.
+  auto lower = Expressions::And(
+      Expressions::And(Expressions::GreaterThan("age", Literal::Int(1)),
+                       Expressions::IsNull("name")),
+      Expressions::GreaterThanOrEqual("age", Literal::Int(3)));
+  ICEBERG_UNWRAP_OR_FAIL(auto bound_lower, Binder::Bind(*schema_, lower, true));
+  ASSERT_EQ(bound_lower->op(), Expression::Operation::kAnd);
+  const auto& lower_and = static_cast<const And&>(*bound_lower);
+  EXPECT_EQ(lower_and.left()->op(), Expression::Operation::kGtEq);
+  EXPECT_EQ(literal_of(lower_and.left()), Literal::Int(3));
+  EXPECT_EQ(lower_and.right()->op(), Expression::Operation::kIsNull);
+
+  auto upper = Expressions::And(Expressions::LessThanOrEqual("age", Literal::Int(5)),
+                                Expressions::LessThan("age", Literal::Int(5)));
+  ICEBERG_UNWRAP_OR_FAIL(auto bound_upper, Binder::Bind(*schema_, upper, true));
+  EXPECT_EQ(bound_upper->op(), Expression::Operation::kLt);
+
+  // A range with equal inclusive bounds becomes an equality.
+  auto point = Expressions::And(Expressions::GreaterThanOrEqual("age", Literal::Int(5)),
+                                Expressions::LessThanOrEqual("age", Literal::Int(5)));
+  ICEBERG_UNWRAP_OR_FAIL(auto bound_point, Binder::Bind(*schema_, point, true));
+  EXPECT_EQ(bound_point->op(), Expression::Operation::kEq);
+  EXPECT_EQ(literal_of(bound_point), Literal::Int(5));
+
+  // Empty ranges fold to false.
+  auto empty = Expressions::And(Expressions::GreaterThan("age", Literal::Int(5)),
+                                Expressions::LessThan("age", Literal::Int(3)));
+  ICEBERG_UNWRAP_OR_FAIL(auto bound_empty, Binder::Bind(*schema_, empty, true));
+  EXPECT_EQ(bound_empty->op(), Expression::Operation::kFalse);
+
+  auto conflicting = Expressions::And(Expressions::Equal("age", Literal::Int(5)),
+                                      Expressions::GreaterThan("age", Literal::Int(5)));
+  ICEBERG_UNWRAP_OR_FAIL(auto bound_conflicting,
+                         Binder::Bind(*schema_, conflicting, true));
+  EXPECT_EQ(bound_conflicting->op(), Expression::Operation::kFalse);
+
+  // A non-empty range keeps both bounds.
+  auto range = Expressions::And(Expressions::GreaterThan("age", Literal::Int(1)),
+                                Expressions::LessThan("age", Literal::Int(5)));
+  ICEBERG_UNWRAP_OR_FAIL(auto bound_range, Binder::Bind(*schema_, range, true));
+  EXPECT_EQ(bound_range->op(), Expression::Operation::kAnd);
+
+  // Bounds on different fields are not merged.
+  auto different = Expressions::And(Expressions::GreaterThan("age", Literal::Int(5)),
+                                    Expressions::LessThan("id", Literal::Long(3)));
+  ICEBERG_UNWRAP_OR_FAIL(auto bound_different, Binder::Bind(*schema_, different, true));
+  EXPECT_EQ(bound_different->op(), Expression::Operation::kAnd);
+}
+
+TEST_F(PredicateTest, BindPushesDownNot) {
+  auto expr = Expressions::Not(Expressions::Or(
+      Expressions::LessThan("age", Literal::Int(5)),
+      Expressions::Not(Expressions::GreaterThan("age", Literal::Int(3)))));
+  // not(age < 5 or not(age > 3)) is age >= 5 and age > 3, merged into age >= 5.
+  ICEBERG_UNWRAP_OR_FAIL(auto bound, Binder::Bind(*schema_, expr, true));
+  ASSERT_EQ(bound->op(), Expression::Operation::kGtEq);
+  EXPECT_EQ(std::dynamic_pointer_cast<BoundLiteralPredicate>(bound)->literal(),
+            Literal::Int(5));
+
+  // A Not of a required field check folds away.
+  auto not_null = Expressions::Not(Expressions::IsNull("age"));
+  ICEBERG_UNWRAP_OR_FAIL(auto bound_not_null, Binder::Bind(*schema_, not_null, true));
+  EXPECT_EQ(bound_not_null->op(), Expression::Operation::kTrue);
+}
+
 }  // namespace iceberg
@@ -0,0 +1,186 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/prefetching_file_io.h"
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/executor.h"
+#include "iceberg/test/deferred_executor.h"
+#include "iceberg/test/matchers.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief A FileIO of in-memory files counting the reads made through it.
+class MemoryFileIO : public FileIO {
+ public:
+  Result<std::string> ReadFile(const std::string& file_location,
+                               std::optional<size_t> length) override {
+    ++reads_;
+    auto it = files_.find(file_location);
+    if (it == files_.cend()) {
+      return IOError("File {} does not exist", file_location);
+    }
+    return it->second;
+  }
+
+  Status WriteFile(const std::string& file_location, std::string_view content) override {
+    files_[file_location] = std::string(content);
+    return {};
+  }
+
+  std::unordered_map<std::string, std::string> files_;
+  std::atomic<int32_t> reads_ = 0;
+};
+
+std::vector<PrefetchingFileIO::File> Files(const std::vector<std::string>& locations) {
+  std::vector<PrefetchingFileIO::File> files;
+  for (const auto& location : locations) {
+    files.push_back({.location = location, .length = std::nullopt});
+  }
+  return files;
+}
+
+}  // namespace
+
+class PrefetchingFileIOTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    file_io_ = std::make_shared<MemoryFileIO>();
+    for (const auto& location : {"a", "b", "c"}) {
+      ASSERT_THAT(file_io_->WriteFile(location, "content of " + std::string(location)),
+                  IsOk());
+    }
+    executor_ = std::make_shared<DeferredExecutor>();
+  }
+
+  std::shared_ptr<MemoryFileIO> file_io_;
+  std::shared_ptr<DeferredExecutor> executor_;
+};
+
+TEST_F(PrefetchingFileIOTest, InvalidArguments) {
+  EXPECT_THAT(PrefetchingFileIO::Make(nullptr, Files({"a"}), 1, executor_),
+              IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(PrefetchingFileIO::Make(file_io_, Files({"a"}), 0, executor_),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(PrefetchingFileIOTest, ReadsAheadWithinCapacity) {
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto io, PrefetchingFileIO::Make(file_io_, Files({"a", "b", "c"}), 2, executor_));
+  EXPECT_EQ(executor_->RunAll(), 2);
+  EXPECT_EQ(file_io_->reads_, 2);
+
+  // Taking a file makes room for the next one.
+  EXPECT_THAT(io->ReadFile("a", std::nullopt), HasValue(::testing::Eq("content of a")));
+  EXPECT_EQ(file_io_->reads_, 2);
+  EXPECT_EQ(executor_->RunAll(), 1);
+  EXPECT_EQ(file_io_->reads_, 3);
+
+  ICEBERG_UNWRAP_OR_FAIL(auto input, io->NewInputFile("b", std::nullopt));
+  std::string buffer(7, '\0');
+  EXPECT_THAT(input->ReadAt(0, {reinterpret_cast<uint8_t*>(buffer.data()), 7}),
+              HasValue(::testing::Eq(7)));
+  EXPECT_EQ(buffer, "content");
+  EXPECT_THAT(io->ReadFile("c", std::nullopt), HasValue(::testing::Eq("content of c")));
+  EXPECT_EQ(file_io_->reads_, 3);
+  EXPECT_EQ(executor_->RunAll(), 0);
+
+  // A file is read ahead for its first read only.
+  EXPECT_THAT(io->ReadFile("a", std::nullopt), HasValue(::testing::Eq("content of a")));
+  EXPECT_EQ(file_io_->reads_, 4);
+}
+
+TEST_F(PrefetchingFileIOTest, ReadsOnCallingThreadBeforeStart) {
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto io, PrefetchingFileIO::Make(file_io_, Files({"a", "b", "missing"}), 1,
+                                       executor_));
+  // The read of b did not start, so it is made by the caller.
+  EXPECT_THAT(io->ReadFile("b", std::nullopt), HasValue(::testing::Eq("content of b")));
+  EXPECT_EQ(file_io_->reads_, 1);
+
+  // The submitted read takes the first file not read yet, and errors are kept.
+  EXPECT_EQ(executor_->RunAll(), 1);
+  EXPECT_THAT(io->ReadFile("a", std::nullopt), HasValue(::testing::Eq("content of a")));
+  EXPECT_EQ(executor_->RunAll(), 1);
+  EXPECT_EQ(file_io_->reads_, 3);
+  EXPECT_THAT(io->NewInputFile("missing", std::nullopt), IsError(ErrorKind::kIOError));
+  EXPECT_EQ(file_io_->reads_, 3);
+}
+
+TEST_F(PrefetchingFileIOTest, ReadsAheadWithinByteCapacity) {
+  // Each file is 12 bytes long, so two of them fit in 30 bytes.
+  std::vector<PrefetchingFileIO::File> files;
+  for (const auto& location : {"a", "b", "c"}) {
+    files.push_back({.location = location, .length = 12});
+  }
+  ICEBERG_UNWRAP_OR_FAIL(auto io, PrefetchingFileIO::Make(file_io_, std::move(files),
+                                                          3, executor_, 30));
+  EXPECT_EQ(executor_->RunAll(), 2);
+  EXPECT_THAT(io->ReadFile("a", std::nullopt), HasValue(::testing::Eq("content of a")));
+  EXPECT_EQ(executor_->RunAll(), 1);
+  EXPECT_EQ(file_io_->reads_, 3);
+
+  // A file larger than the capacity is still read ahead when no other file is held.
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto small_io, PrefetchingFileIO::Make(file_io_, {{.location = "a", .length = 12}},
+                                             1, executor_, 4));
+  EXPECT_EQ(executor_->RunAll(), 1);
+  EXPECT_EQ(file_io_->reads_, 4);
+  EXPECT_THAT(small_io->ReadFile("a", std::nullopt),
+              HasValue(::testing::Eq("content of a")));
+  EXPECT_EQ(file_io_->reads_, 4);
+}
+
+TEST_F(PrefetchingFileIOTest, StopsWhenDestroyed) {
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto io, PrefetchingFileIO::Make(file_io_, Files({"a", "b"}), 2, executor_));
+  io.reset();
+  EXPECT_EQ(executor_->RunAll(), 2);
+  EXPECT_EQ(file_io_->reads_, 0);
+}
+
+TEST_F(PrefetchingFileIOTest, ReadsConcurrently) {
+  std::vector<std::string> locations;
+  for (int32_t i = 0; i < 50; ++i) {
+    locations.push_back("file-" + std::to_string(i));
+    ASSERT_THAT(file_io_->WriteFile(locations.back(), locations.back()), IsOk());
+  }
+  ICEBERG_UNWRAP_OR_FAIL(std::shared_ptr<Executor> pool, ThreadPoolExecutor::Make(4));
+  {
+    ICEBERG_UNWRAP_OR_FAIL(auto io,
+                           PrefetchingFileIO::Make(file_io_, Files(locations), 3, pool));
+    for (const auto& location : locations) {
+      EXPECT_THAT(io->ReadFile(location, std::nullopt),
+                  HasValue(::testing::Eq(location)));
+    }
+  }
+  EXPECT_EQ(file_io_->reads_, 50);
+}
+
+}  // namespace iceberg
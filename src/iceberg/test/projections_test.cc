@@ -0,0 +1,204 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/expression/projections.h"
+
+#include <string_view>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/expression/expressions.h"
+#include "iceberg/expression/predicate.h"
+#include "iceberg/partition_field.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/transform.h"
+#include "iceberg/type.h"
+#include "iceberg/util/checked_cast.h"
+
+namespace iceberg {
+
+namespace {
+
+// 2024-01-02T10:00:00 and 2024-01-02T00:00:00 in microseconds from the epoch, both on
+// day 19724.
+constexpr int64_t kTimestamp = 1704189600000000;
+constexpr int64_t kMidnight = 1704153600000000;
+
+}  // namespace
+
+class ProjectionsTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    schema_ = std::make_shared<Schema>(
+        std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32()),
+                                 SchemaField::MakeOptional(2, "data", string()),
+                                 SchemaField::MakeOptional(3, "category", string()),
+                                 SchemaField::MakeOptional(4, "ts", timestamp()),
+                                 SchemaField::MakeOptional(5, "region", string()),
+                                 SchemaField::MakeOptional(6, "other", int32())},
+        /*schema_id=*/0);
+    spec_ = std::make_shared<PartitionSpec>(
+        schema_, /*spec_id=*/1,
+        std::vector<PartitionField>{
+            PartitionField(1, 1000, "id_trunc", Transform::Truncate(10)),
+            PartitionField(2, 1001, "data_bucket", Transform::Bucket(16)),
+            PartitionField(3, 1002, "category_trunc", Transform::Truncate(3)),
+            PartitionField(4, 1003, "ts_day", Transform::Day()),
+            PartitionField(5, 1004, "region", Transform::Identity())});
+  }
+
+  std::shared_ptr<Expression> Inclusive(const std::shared_ptr<Expression>& expr) {
+    auto projected = Projections::Inclusive(spec_)->Project(expr);
+    EXPECT_THAT(projected, IsOk());
+    return projected.value();
+  }
+
+  std::shared_ptr<Expression> Strict(const std::shared_ptr<Expression>& expr) {
+    auto projected = Projections::Strict(spec_)->Project(expr);
+    EXPECT_THAT(projected, IsOk());
+    return projected.value();
+  }
+
+  static void ExpectPredicate(const std::shared_ptr<Expression>& expr,
+                              Expression::Operation op, std::string_view name,
+                              const std::vector<Literal>& literals) {
+    auto pred = std::dynamic_pointer_cast<UnboundPredicate<BoundReference>>(expr);
+    ASSERT_NE(pred, nullptr);
+    EXPECT_EQ(pred->op(), op);
+    EXPECT_EQ(pred->reference()->name(), name);
+    EXPECT_THAT(pred->literals(), ::testing::UnorderedElementsAreArray(literals));
+  }
+
+  std::shared_ptr<Schema> schema_;
+  std::shared_ptr<PartitionSpec> spec_;
+};
+
+using Op = Expression::Operation;
+
+TEST_F(ProjectionsTest, InclusiveTemporal) {
+  ExpectPredicate(Inclusive(Expressions::LessThan("ts", Literal::Timestamp(kTimestamp))),
+                  Op::kLtEq, "ts_day", {Literal::Int(19724)});
+  ExpectPredicate(Inclusive(Expressions::Equal("ts", Literal::Timestamp(kTimestamp))),
+                  Op::kEq, "ts_day", {Literal::Int(19724)});
+}
+
+TEST_F(ProjectionsTest, StrictTemporal) {
+  ExpectPredicate(Strict(Expressions::LessThan("ts", Literal::Timestamp(kTimestamp))),
+                  Op::kLt, "ts_day", {Literal::Int(19724)});
+  ExpectPredicate(
+      Strict(Expressions::LessThanOrEqual("ts", Literal::Timestamp(kTimestamp))),
+      Op::kLt, "ts_day", {Literal::Int(19724)});
+  ExpectPredicate(
+      Strict(Expressions::GreaterThanOrEqual("ts", Literal::Timestamp(kMidnight))),
+      Op::kGt, "ts_day", {Literal::Int(19723)});
+  ExpectPredicate(
+      Strict(Expressions::GreaterThan("ts", Literal::Timestamp(kTimestamp))), Op::kGt,
+      "ts_day", {Literal::Int(19724)});
+  ExpectPredicate(Strict(Expressions::NotEqual("ts", Literal::Timestamp(kTimestamp))),
+                  Op::kNotEq, "ts_day", {Literal::Int(19724)});
+  // A day may hold other timestamps, so equality cannot be guaranteed.
+  EXPECT_EQ(Strict(Expressions::Equal("ts", Literal::Timestamp(kTimestamp)))->op(),
+            Op::kFalse);
+  // Negations are rewritten before projecting.
+  ExpectPredicate(
+      Strict(Expressions::Not(
+          Expressions::GreaterThanOrEqual("ts", Literal::Timestamp(kTimestamp)))),
+      Op::kLt, "ts_day", {Literal::Int(19724)});
+}
+
+TEST_F(ProjectionsTest, StrictPreEpochTemporal) {
+  // Pre-epoch values may have been written to the following day.
+  ExpectPredicate(Strict(Expressions::GreaterThan("ts", Literal::Timestamp(-1))),
+                  Op::kGt, "ts_day", {Literal::Int(0)});
+  ExpectPredicate(Strict(Expressions::NotEqual("ts", Literal::Timestamp(-1))),
+                  Op::kNotIn, "ts_day", {Literal::Int(-1), Literal::Int(0)});
+}
+
+TEST_F(ProjectionsTest, Bucket) {
+  auto bucket = Transform::Bucket(16)->Bind(string()).value();
+  auto bucket_value = bucket->Transform(Literal::String("a")).value();
+
+  ExpectPredicate(Inclusive(Expressions::Equal("data", Literal::String("a"))), Op::kEq,
+                  "data_bucket", {bucket_value});
+  EXPECT_EQ(Inclusive(Expressions::NotEqual("data", Literal::String("a")))->op(),
+            Op::kTrue);
+
+  EXPECT_EQ(Strict(Expressions::Equal("data", Literal::String("a")))->op(), Op::kFalse);
+  ExpectPredicate(Strict(Expressions::NotEqual("data", Literal::String("a"))),
+                  Op::kNotEq, "data_bucket", {bucket_value});
+  auto other_bucket_value = bucket->Transform(Literal::String("b")).value();
+  ExpectPredicate(
+      Strict(Expressions::NotIn("data", {Literal::String("a"), Literal::String("b")})),
+      Op::kNotIn, "data_bucket", {bucket_value, other_bucket_value});
+}
+
+TEST_F(ProjectionsTest, StrictTruncateInteger) {
+  ExpectPredicate(Strict(Expressions::LessThanOrEqual("id", Literal::Int(9))), Op::kLt,
+                  "id_trunc", {Literal::Int(10)});
+  ExpectPredicate(Strict(Expressions::LessThan("id", Literal::Int(5))), Op::kLt,
+                  "id_trunc", {Literal::Int(0)});
+  ExpectPredicate(Strict(Expressions::GreaterThanOrEqual("id", Literal::Int(10))),
+                  Op::kGt, "id_trunc", {Literal::Int(0)});
+  ExpectPredicate(Strict(Expressions::NotIn("id", {Literal::Int(1), Literal::Int(15)})),
+                  Op::kNotIn, "id_trunc", {Literal::Int(0), Literal::Int(10)});
+  EXPECT_EQ(Strict(Expressions::Equal("id", Literal::Int(5)))->op(), Op::kFalse);
+  EXPECT_EQ(Strict(Expressions::In("id", {Literal::Int(1), Literal::Int(15)}))->op(),
+            Op::kFalse);
+}
+
+TEST_F(ProjectionsTest, TruncateString) {
+  ExpectPredicate(Inclusive(Expressions::StartsWith("category", "abcd")),
+                  Op::kStartsWith, "category_trunc", {Literal::String("abc")});
+
+  ExpectPredicate(Strict(Expressions::StartsWith("category", "ab")), Op::kStartsWith,
+                  "category_trunc", {Literal::String("ab")});
+  EXPECT_EQ(Strict(Expressions::StartsWith("category", "abcd"))->op(), Op::kFalse);
+  ExpectPredicate(Strict(Expressions::NotStartsWith("category", "abcd")),
+                  Op::kNotStartsWith, "category_trunc", {Literal::String("abc")});
+  ExpectPredicate(Strict(Expressions::LessThanOrEqual("category", Literal::String("b"))),
+                  Op::kLt, "category_trunc", {Literal::String("b")});
+}
+
+TEST_F(ProjectionsTest, IdentityAndUnpartitioned) {
+  ExpectPredicate(Strict(Expressions::Equal("region", Literal::String("eu"))), Op::kEq,
+                  "region", {Literal::String("eu")});
+  ExpectPredicate(Strict(Expressions::IsNull("data")), Op::kIsNull, "data_bucket", {});
+
+  EXPECT_EQ(Inclusive(Expressions::Equal("other", Literal::Int(1)))->op(), Op::kTrue);
+  EXPECT_EQ(Strict(Expressions::Equal("other", Literal::Int(1)))->op(), Op::kFalse);
+
+  auto projected = Strict(
+      Expressions::And(Expressions::LessThan("ts", Literal::Timestamp(kTimestamp)),
+                       Expressions::Equal("region", Literal::String("eu"))));
+  ASSERT_EQ(projected->op(), Op::kAnd);
+  const auto& conjunction = internal::checked_cast<const And&>(*projected);
+  ExpectPredicate(conjunction.left(), Op::kLt, "ts_day", {Literal::Int(19724)});
+  ExpectPredicate(conjunction.right(), Op::kEq, "region", {Literal::String("eu")});
+
+  EXPECT_EQ(Strict(Expressions::Or(Expressions::Equal("other", Literal::Int(1)),
+                                   Expressions::Equal("id", Literal::Int(5))))
+                ->op(),
+            Op::kFalse);
+}
+
+}  // namespace iceberg
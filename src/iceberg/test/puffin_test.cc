@@ -0,0 +1,278 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include "iceberg/file_io.h"
+#include "iceberg/puffin/puffin_format.h"
+#include "iceberg/puffin/puffin_reader.h"
+#include "iceberg/puffin/puffin_writer.h"
+#include "iceberg/test/matchers.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief An output file that appends to a string.
+class StringOutputFile : public OutputFile {
+ public:
+  explicit StringOutputFile(std::string* content) : content_(content) {}
+
+  const std::string& location() const override { return location_; }
+
+  Status Write(std::string_view data) override {
+    content_->append(data);
+    return {};
+  }
+
+  Result<int64_t> Position() const override {
+    return static_cast<int64_t>(content_->size());
+  }
+
+  Status Close() override { return {}; }
+
+ private:
+  std::string location_ = "memory.puffin";
+  std::string* content_;
+};
+
+/// \brief An input file of a string that records the ranges that are read.
+class StringInputFile : public InputFile {
+ public:
+  StringInputFile(std::string content, std::vector<std::pair<int64_t, int64_t>>* reads)
+      : content_(std::move(content)), reads_(reads) {}
+
+  const std::string& location() const override { return location_; }
+
+  Result<int64_t> Size() override { return static_cast<int64_t>(content_.size()); }
+
+  Result<int64_t> ReadAt(int64_t offset, std::span<uint8_t> out) override {
+    const auto size = std::min<int64_t>(out.size(), content_.size() - offset);
+    reads_->emplace_back(offset, size);
+    std::memcpy(out.data(), content_.data() + offset, size);
+    return size;
+  }
+
+ private:
+  std::string location_ = "memory.puffin";
+  std::string content_;
+  std::vector<std::pair<int64_t, int64_t>>* reads_;
+};
+
+/// \brief A reversible "compression" that makes compressed blobs recognizable.
+std::string Reverse(std::string_view data) { return {data.rbegin(), data.rend()}; }
+
+class PuffinTest : public ::testing::Test {
+ protected:
+  void TearDown() override {
+    // Restore the codec of the core library.
+    PuffinCodecRegistry(PuffinCompressionCodec::kZstd, zstd_);
+  }
+
+  /// \brief Writes a file with a deletion vector, a sketch and an empty blob.
+  std::vector<PuffinBlobMetadata> WriteFile() {
+    auto writer = PuffinWriter::Make(std::make_unique<StringOutputFile>(&content_),
+                                     {{"writer", "test"}});
+    EXPECT_THAT(writer, IsOk());
+    std::vector<PuffinBlobMetadata> blobs;
+    for (auto blob : {
+             PuffinBlob{.type = std::string(PuffinConstants::kDeletionVectorV1),
+                        .fields = {2147483645},
+                        .data = "positions",
+                        .properties = {{"referenced-data-file", "a.parquet"}}},
+             PuffinBlob{.type = std::string(PuffinConstants::kApacheDataSketchesThetaV1),
+                        .fields = {1, 2},
+                        .snapshot_id = 7,
+                        .sequence_number = 3,
+                        .data = "sketch"},
+             PuffinBlob{.type = "empty"},
+         }) {
+      auto metadata = writer.value()->Add(blob);
+      EXPECT_THAT(metadata, IsOk());
+      blobs.push_back(std::move(metadata.value()));
+    }
+    EXPECT_THAT(writer.value()->Close(), IsOk());
+    EXPECT_EQ(writer.value()->file_size(), static_cast<int64_t>(content_.size()));
+    footer_size_ = writer.value()->footer_size();
+    return blobs;
+  }
+
+  Result<std::unique_ptr<PuffinReader>> Open(
+      std::optional<int64_t> footer_size = std::nullopt) {
+    reads_.clear();
+    return PuffinReader::Open(std::make_unique<StringInputFile>(content_, &reads_),
+                              footer_size);
+  }
+
+  PuffinCodec zstd_ = PuffinCodecRegistry::GetCodec(PuffinCompressionCodec::kZstd);
+  std::string content_;
+  int64_t footer_size_ = 0;
+  std::vector<std::pair<int64_t, int64_t>> reads_;
+};
+
+}  // namespace
+
+TEST_F(PuffinTest, RoundTrip) {
+  const auto blobs = WriteFile();
+  EXPECT_EQ(content_.substr(0, 4), "PFA1");
+  EXPECT_EQ(blobs[0].offset, 4);
+  EXPECT_EQ(blobs[0].length, 9);
+  EXPECT_EQ(blobs[1].offset, 13);
+  EXPECT_EQ(blobs[2].length, 0);
+
+  ICEBERG_UNWRAP_OR_FAIL(auto reader, Open());
+  // The footer of a small file is read with a single read of the end of the file.
+  EXPECT_THAT(reads_, ::testing::SizeIs(1));
+  EXPECT_EQ(reader->footer_size(), footer_size_);
+  EXPECT_EQ(reader->metadata().blobs, blobs);
+  EXPECT_EQ(reader->metadata().properties.at("writer"), "test");
+  EXPECT_TRUE(reader->metadata().properties.contains("created-by"));
+
+  reads_.clear();
+  EXPECT_THAT(reader->ReadBlob(blobs[1]), HasValue(::testing::Eq("sketch")));
+  EXPECT_THAT(reads_, ::testing::ElementsAre(std::pair<int64_t, int64_t>{13, 6}));
+  ICEBERG_UNWRAP_OR_FAIL(auto data, reader->ReadBlobs(blobs));
+  EXPECT_THAT(data, ::testing::ElementsAre("positions", "sketch", ""));
+  EXPECT_THAT(reader->Close(), IsOk());
+  EXPECT_THAT(reader->ReadBlob(blobs[0]), IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(PuffinTest, FooterLayout) {
+  WriteFile();
+  EXPECT_EQ(content_.substr(content_.size() - 4), "PFA1");
+  EXPECT_EQ(content_.substr(content_.size() - footer_size_, 4), "PFA1");
+  int32_t payload_size;
+  std::memcpy(&payload_size, content_.data() + content_.size() - 12, sizeof(int32_t));
+  EXPECT_EQ(payload_size, footer_size_ - 16);
+  auto footer = nlohmann::json::parse(
+      content_.substr(content_.size() - 12 - payload_size, payload_size));
+  EXPECT_EQ(footer["blobs"][1]["type"], "apache-datasketches-theta-v1");
+  EXPECT_EQ(footer["blobs"][1]["snapshot-id"], 7);
+  EXPECT_EQ(footer["blobs"][1]["sequence-number"], 3);
+  EXPECT_FALSE(footer["blobs"][1].contains("compression-codec"));
+  EXPECT_EQ(footer["blobs"][0]["properties"]["referenced-data-file"], "a.parquet");
+}
+
+TEST_F(PuffinTest, KnownFooterSize) {
+  WriteFile();
+  ICEBERG_UNWRAP_OR_FAIL(auto reader, Open(footer_size_));
+  EXPECT_THAT(reads_, ::testing::ElementsAre(std::pair<int64_t, int64_t>{
+                          content_.size() - footer_size_, footer_size_}));
+  EXPECT_THAT(reader->metadata().blobs, ::testing::SizeIs(3));
+  EXPECT_THAT(Open(footer_size_ + 1), IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(PuffinTest, LargeFooter) {
+  auto writer = PuffinWriter::Make(std::make_unique<StringOutputFile>(&content_));
+  ASSERT_THAT(writer, IsOk());
+  const std::string data(100, 'x');
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_THAT(writer.value()->Add({.type = "blob-" + std::to_string(i), .data = data}),
+                IsOk());
+  }
+  ASSERT_THAT(writer.value()->Close(), IsOk());
+  ASSERT_GT(writer.value()->footer_size(), 16 * 1024);
+
+  // The rest of a footer larger than the first read is read once its size is known.
+  ICEBERG_UNWRAP_OR_FAIL(auto reader, Open());
+  EXPECT_THAT(reads_, ::testing::SizeIs(2));
+  ASSERT_THAT(reader->metadata().blobs, ::testing::SizeIs(1000));
+  EXPECT_EQ(reader->metadata().blobs[999].type, "blob-999");
+  EXPECT_THAT(reader->ReadBlob(reader->metadata().blobs[999]),
+              HasValue(::testing::Eq(data)));
+}
+
+TEST_F(PuffinTest, Compression) {
+  auto writer = PuffinWriter::Make(std::make_unique<StringOutputFile>(&content_));
+  ASSERT_THAT(writer, IsOk());
+  const PuffinBlob blob{
+      .type = "blob", .data = "data", .compression_codec = PuffinCompressionCodec::kZstd};
+  // The codecs of compression libraries are not available in the core library.
+  EXPECT_THAT(writer.value()->Add(blob), IsError(ErrorKind::kNotSupported));
+
+  PuffinCodecRegistry(PuffinCompressionCodec::kZstd,
+                      {.compress = [](std::string_view data) -> Result<std::string> {
+                         return Reverse(data);
+                       },
+                       .decompress = [](std::string_view data) -> Result<std::string> {
+                         return Reverse(data);
+                       }});
+  ICEBERG_UNWRAP_OR_FAIL(auto metadata, writer.value()->Add(blob));
+  EXPECT_EQ(metadata.compression_codec, PuffinCompressionCodec::kZstd);
+  ASSERT_THAT(writer.value()->Close(), IsOk());
+  EXPECT_EQ(content_.substr(metadata.offset, metadata.length), "atad");
+
+  ICEBERG_UNWRAP_OR_FAIL(auto reader, Open());
+  EXPECT_EQ(reader->metadata().blobs[0].compression_codec,
+            PuffinCompressionCodec::kZstd);
+  EXPECT_THAT(reader->ReadBlob(reader->metadata().blobs[0]),
+              HasValue(::testing::Eq("data")));
+}
+
+TEST_F(PuffinTest, InvalidFiles) {
+  content_ = "PFA1";
+  EXPECT_THAT(Open(), IsError(ErrorKind::kInvalidArgument));
+
+  const auto blobs = WriteFile();
+  const std::string valid = content_;
+  content_.back() = 'X';
+  EXPECT_THAT(Open(), HasErrorMessage("missing the magic"));
+
+  // A footer payload size beyond the file.
+  content_ = valid;
+  content_[content_.size() - 9] = '\x7f';
+  EXPECT_THAT(Open(), HasErrorMessage("footer payload size"));
+
+  // A footer payload that is not JSON.
+  content_ = valid;
+  content_[content_.size() - footer_size_ + 4] = '[';
+  EXPECT_THAT(Open(), IsError(ErrorKind::kJsonParseError));
+
+  content_ = valid;
+  ICEBERG_UNWRAP_OR_FAIL(auto reader, Open());
+  auto outside = blobs[1];
+  outside.length = static_cast<int64_t>(content_.size());
+  EXPECT_THAT(reader->ReadBlob(outside), IsError(ErrorKind::kInvalidArgument));
+  auto header = blobs[0];
+  header.offset = 0;
+  EXPECT_THAT(reader->ReadBlobs({&header, 1}), IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST(PuffinFormatTest, CompressionCodecNames) {
+  EXPECT_EQ(ToString(PuffinCompressionCodec::kLz4), "lz4");
+  EXPECT_EQ(ToString(PuffinCompressionCodec::kZstd), "zstd");
+  EXPECT_THAT(PuffinCompressionCodecFromString("zstd"),
+              HasValue(::testing::Eq(PuffinCompressionCodec::kZstd)));
+  EXPECT_THAT(PuffinCompressionCodecFromString("snappy"),
+              IsError(ErrorKind::kNotSupported));
+}
+
+}  // namespace iceberg
@@ -0,0 +1,172 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/remove_orphan_files.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/fast_append.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table.h"
+#include "iceberg/table_properties.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/test/table_test_base.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+TEST(NormalizeLocationTest, CanonicalizesSchemesAuthoritiesAndSlashes) {
+  std::unordered_map<std::string, std::string> schemes{{"s3a", "s3"}};
+  std::unordered_map<std::string, std::string> authorities{{"bucket.alias", "bucket"}};
+
+  EXPECT_EQ(NormalizeLocation("s3a://bucket/a//b", schemes, authorities),
+            "s3://bucket/a/b");
+  EXPECT_EQ(NormalizeLocation("S3A://bucket.alias/a/b", schemes, authorities),
+            "s3://bucket/a/b");
+  EXPECT_EQ(NormalizeLocation("gs://bucket/a/b", schemes, authorities),
+            "gs://bucket/a/b");
+  EXPECT_EQ(NormalizeLocation("file:///tmp//t/a", schemes, authorities), "/tmp/t/a");
+  EXPECT_EQ(NormalizeLocation("file:/tmp/t/a", schemes, authorities), "/tmp/t/a");
+  EXPECT_EQ(NormalizeLocation("/tmp/t/a", schemes, authorities), "/tmp/t/a");
+}
+
+class RemoveOrphanFilesTest : public TableTestBase {
+ protected:
+  void SetUp() override {
+    TableTestBase::SetUp();
+    std::filesystem::create_directories(table_location_ + "/data");
+  }
+
+  // Creates a file on disk under the table location and returns its path.
+  std::string CreateFile(const std::string& name) {
+    auto path = std::format("{}/{}", table_location_, name);
+    std::ofstream(path) << "data";
+    return path;
+  }
+
+  void Append(const std::string& path) {
+    FastAppend append(table_);
+    append.AppendFile(std::make_shared<DataFile>(DataFile{
+        .file_path = path,
+        .file_format = FileFormatType::kParquet,
+        .record_count = 10,
+        .file_size_in_bytes = 100,
+    }));
+    ASSERT_THAT(append.Commit(), IsOk());
+  }
+
+  // A timestamp after all files of the test.
+  static TimePointMs Later() {
+    return std::chrono::time_point_cast<std::chrono::milliseconds>(
+               std::chrono::system_clock::now()) +
+           std::chrono::hours(1);
+  }
+
+  static std::vector<std::string> Sorted(std::vector<std::string> locations) {
+    for (auto& location : locations) {
+      location = NormalizeLocation(location, {}, {});
+    }
+    std::ranges::sort(locations);
+    return locations;
+  }
+};
+
+TEST_F(RemoveOrphanFilesTest, FindsAndDeletesUnreferencedFiles) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable());
+  auto live = CreateFile("data/live.parquet");
+  ASSERT_NO_FATAL_FAILURE(Append(live));
+  ASSERT_NO_FATAL_FAILURE(Append(CreateFile("data/other.parquet")));
+  auto orphan = CreateFile("data/orphan.parquet");
+  auto orphan_metadata = CreateFile("metadata/orphan.avro");
+
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto dry_run,
+      RemoveOrphanFiles(table_).OlderThan(Later()).DryRun(true).Execute());
+  EXPECT_EQ(Sorted(dry_run.orphan_file_locations),
+            Sorted({orphan, orphan_metadata}));
+  EXPECT_EQ(dry_run.deleted_files_count, 0);
+  EXPECT_TRUE(std::filesystem::exists(orphan));
+
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto result,
+      RemoveOrphanFiles(table_).OlderThan(Later()).WithParallelism(4).Execute());
+  EXPECT_EQ(Sorted(result.orphan_file_locations), Sorted({orphan, orphan_metadata}));
+  EXPECT_EQ(result.deleted_files_count, 2);
+  EXPECT_TRUE(result.delete_failures.empty());
+  EXPECT_FALSE(std::filesystem::exists(orphan));
+  EXPECT_FALSE(std::filesystem::exists(orphan_metadata));
+  EXPECT_TRUE(std::filesystem::exists(live));
+  EXPECT_TRUE(std::filesystem::exists(table_->metadata_location()));
+}
+
+TEST_F(RemoveOrphanFilesTest, KeepsRecentFiles) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable());
+  auto orphan = CreateFile("data/orphan.parquet");
+
+  ICEBERG_UNWRAP_OR_FAIL(auto result, RemoveOrphanFiles(table_).Execute());
+  EXPECT_TRUE(result.orphan_file_locations.empty());
+  EXPECT_TRUE(std::filesystem::exists(orphan));
+}
+
+TEST_F(RemoveOrphanFilesTest, SpillsShardsBeyondMemoryLimit) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable());
+  std::vector<std::string> orphans;
+  for (int i = 0; i < 20; ++i) {
+    ASSERT_NO_FATAL_FAILURE(Append(CreateFile(std::format("data/live-{}.parquet", i))));
+    orphans.push_back(CreateFile(std::format("data/orphan-{}.parquet", i)));
+  }
+  auto spill_directory = CreateTempDirectory();
+
+  ICEBERG_UNWRAP_OR_FAIL(auto result, RemoveOrphanFiles(table_)
+                                          .OlderThan(Later())
+                                          .DryRun(true)
+                                          .NumShards(3)
+                                          .MemoryLimit(64)
+                                          .SpillDirectory(spill_directory)
+                                          .Execute());
+  EXPECT_EQ(Sorted(result.orphan_file_locations), Sorted(orphans));
+  EXPECT_TRUE(std::filesystem::is_empty(spill_directory));
+}
+
+TEST_F(RemoveOrphanFilesTest, RequiresGcEnabledToDelete) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable({{TableProperties::kGcEnabled.key(), "false"}}));
+  auto orphan = CreateFile("data/orphan.parquet");
+
+  EXPECT_THAT(RemoveOrphanFiles(table_).OlderThan(Later()).Execute(),
+              IsError(ErrorKind::kInvalidArgument));
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto result,
+      RemoveOrphanFiles(table_).OlderThan(Later()).DryRun(true).Execute());
+  EXPECT_EQ(Sorted(result.orphan_file_locations), Sorted({orphan}));
+}
+
+}  // namespace iceberg
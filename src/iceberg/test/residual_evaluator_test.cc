@@ -0,0 +1,150 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/expression/residual_evaluator.h"
+
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/expression/expressions.h"
+#include "iceberg/expression/predicate.h"
+#include "iceberg/partition_field.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/transform.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+namespace {
+
+// 2024-01-02T00:00:00 in microseconds from the epoch, the start of day 19724.
+constexpr int64_t kMidnight = 1704153600000000;
+constexpr int64_t kDay = 86400000000;
+
+}  // namespace
+
+class ResidualEvaluatorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    schema_ = std::make_shared<Schema>(
+        std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32()),
+                                 SchemaField::MakeOptional(2, "data", string()),
+                                 SchemaField::MakeOptional(3, "ts", timestamp()),
+                                 SchemaField::MakeOptional(4, "region", string())},
+        /*schema_id=*/0);
+    spec_ = std::make_shared<PartitionSpec>(
+        schema_, /*spec_id=*/1,
+        std::vector<PartitionField>{
+            PartitionField(1, 1000, "id_trunc", Transform::Truncate(10)),
+            PartitionField(3, 1001, "ts_day", Transform::Day()),
+            PartitionField(4, 1002, "region", Transform::Identity())});
+  }
+
+  std::shared_ptr<Expression> Residual(const std::shared_ptr<Expression>& expr,
+                                       int32_t id_trunc, int32_t day,
+                                       Literal region) {
+    auto evaluator = ResidualEvaluator::Make(expr, spec_);
+    EXPECT_THAT(evaluator, IsOk());
+    auto residual =
+        evaluator.value()->ResidualFor({Literal::Int(id_trunc), Literal::Int(day),
+                                        std::move(region)});
+    EXPECT_THAT(residual, IsOk());
+    return residual.value();
+  }
+
+  std::shared_ptr<Schema> schema_;
+  std::shared_ptr<PartitionSpec> spec_;
+};
+
+using Op = Expression::Operation;
+
+TEST_F(ResidualEvaluatorTest, IdentityPartition) {
+  auto expr = Expressions::Equal("region", Literal::String("eu"));
+  EXPECT_EQ(Residual(expr, 0, 19724, Literal::String("eu"))->op(), Op::kTrue);
+  EXPECT_EQ(Residual(expr, 0, 19724, Literal::String("us"))->op(), Op::kFalse);
+  EXPECT_EQ(Residual(expr, 0, 19724, Literal::Null(string()))->op(), Op::kFalse);
+
+  auto not_null = Expressions::NotNull("region");
+  EXPECT_EQ(Residual(not_null, 0, 19724, Literal::String("eu"))->op(), Op::kTrue);
+  EXPECT_EQ(Residual(not_null, 0, 19724, Literal::Null(string()))->op(), Op::kFalse);
+}
+
+TEST_F(ResidualEvaluatorTest, TemporalRange) {
+  auto expr = Expressions::And(
+      Expressions::And(
+          Expressions::GreaterThanOrEqual("ts", Literal::Timestamp(kMidnight)),
+          Expressions::LessThan("ts", Literal::Timestamp(kMidnight + kDay))),
+      Expressions::Equal("data", Literal::String("x")));
+
+  // The whole day is in range, so only the predicate on data remains.
+  auto residual = Residual(expr, 0, 19724, Literal::String("eu"));
+  ASSERT_EQ(residual->op(), Op::kEq);
+  auto pred = std::dynamic_pointer_cast<BoundPredicate>(residual);
+  ASSERT_NE(pred, nullptr);
+  EXPECT_EQ(pred->reference()->field().field_id(), 2);
+
+  EXPECT_EQ(Residual(expr, 0, 19725, Literal::String("eu"))->op(), Op::kFalse);
+  EXPECT_EQ(Residual(expr, 0, 19723, Literal::String("eu"))->op(), Op::kFalse);
+
+  // A range that ends within the day must still be applied to its rows.
+  auto partial = Expressions::LessThan("ts", Literal::Timestamp(kMidnight + 1000));
+  EXPECT_EQ(Residual(partial, 0, 19724, Literal::String("eu"))->op(), Op::kLt);
+  EXPECT_EQ(Residual(partial, 0, 19723, Literal::String("eu"))->op(), Op::kTrue);
+}
+
+TEST_F(ResidualEvaluatorTest, Disjunction) {
+  auto expr = Expressions::Or(Expressions::Equal("region", Literal::String("eu")),
+                              Expressions::Equal("id", Literal::Int(3)));
+  EXPECT_EQ(Residual(expr, 0, 19724, Literal::String("eu"))->op(), Op::kTrue);
+  EXPECT_EQ(Residual(expr, 0, 19724, Literal::String("us"))->op(), Op::kEq);
+  EXPECT_EQ(Residual(expr, 10, 19724, Literal::String("us"))->op(), Op::kFalse);
+
+  auto not_in = Expressions::NotIn("id", {Literal::Int(1), Literal::Int(2)});
+  EXPECT_EQ(Residual(not_in, 10, 19724, Literal::String("us"))->op(), Op::kTrue);
+  EXPECT_EQ(Residual(not_in, 0, 19724, Literal::String("us"))->op(), Op::kNotIn);
+}
+
+TEST_F(ResidualEvaluatorTest, MemoizedPerPartition) {
+  auto expr = Expressions::And(Expressions::Equal("region", Literal::String("eu")),
+                               Expressions::Equal("data", Literal::String("x")));
+  ICEBERG_UNWRAP_OR_FAIL(auto evaluator, ResidualEvaluator::Make(expr, spec_));
+
+  std::vector<Literal> partition = {Literal::Int(0), Literal::Int(19724),
+                                    Literal::String("eu")};
+  ICEBERG_UNWRAP_OR_FAIL(auto first, evaluator->ResidualFor(partition));
+  ICEBERG_UNWRAP_OR_FAIL(auto second, evaluator->ResidualFor(partition));
+  EXPECT_EQ(first->op(), Op::kEq);
+  EXPECT_EQ(first, second);
+
+  EXPECT_THAT(evaluator->ResidualFor({Literal::Int(0)}),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(ResidualEvaluatorTest, UnpartitionedColumn) {
+  auto expr = Expressions::Equal("data", Literal::String("x"));
+  EXPECT_EQ(Residual(expr, 0, 19724, Literal::String("eu"))->op(), Op::kEq);
+  EXPECT_EQ(Residual(Expressions::AlwaysTrue(), 0, 19724, Literal::String("eu"))->op(),
+            Op::kTrue);
+}
+
+}  // namespace iceberg
@@ -21,19 +21,42 @@
 
 #include <httplib.h>
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <string>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <nlohmann/json.hpp>
 
+#include "iceberg/catalog/rest/http_client.h"
+#include "iceberg/catalog/rest/json_internal.h"
+#include "iceberg/catalog/rest/rest_table_scan.h"
+#include "iceberg/expression/expressions.h"
+#include "iceberg/expression/predicate.h"
+#include "iceberg/file_io.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/table.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/table_requirement.h"
+#include "iceberg/table_scan.h"
+#include "iceberg/table_update.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/test/test_common.h"
+#include "iceberg/util/checked_cast.h"
+
 namespace iceberg::catalog::rest {
 
 class RestCatalogIntegrationTest : public ::testing::Test {
  protected:
   void SetUp() override {
     server_ = std::make_unique<httplib::Server>();
+    server_->set_keep_alive_max_count(100);
     port_ = server_->bind_to_any_port("127.0.0.1");
 
     server_thread_ = std::thread([this]() { server_->listen_after_bind(); });
@@ -46,66 +69,562 @@ class RestCatalogIntegrationTest : public ::testing::Test {
     }
   }
 
+  std::string BaseUri() const { return "http://127.0.0.1:" + std::to_string(port_); }
+
+  /// \brief Serves a catalog config with the "ws" prefix.
+  void ServeConfig() {
+    server_->Get("/v1/config", [](const httplib::Request&, httplib::Response& res) {
+      res.status = 200;
+      res.set_content(R"({"defaults": {}, "overrides": {"prefix": "ws"}})",
+                      "application/json");
+    });
+  }
+
+  Result<std::shared_ptr<RestCatalog>> MakeCatalog(
+      std::unordered_map<std::string, std::string> properties = {}) {
+    return RestCatalog::Make(RestCatalogConfig{.uri = BaseUri(),
+                                               .properties = std::move(properties),
+                                               .file_io = std::make_shared<FileIO>()});
+  }
+
+  /// \brief Returns a LoadTableResult body with valid table metadata.
+  static std::string LoadTableResultBody() {
+    std::string metadata;
+    ReadJsonFile("TableMetadataV2ValidMinimal.json", &metadata);
+    nlohmann::json body;
+    body["metadata-location"] = "s3://bucket/db/t/metadata/v1.metadata.json";
+    body["metadata"] = nlohmann::json::parse(metadata);
+    return body.dump();
+  }
+
+  static void SetError(httplib::Response& res, int code, const std::string& type) {
+    nlohmann::json error;
+    error["error"] = {{"message", "error from server"}, {"type", type}, {"code", code}};
+    res.status = code;
+    res.set_content(error.dump(), "application/json");
+  }
+
   std::unique_ptr<httplib::Server> server_;
   int port_ = -1;
   std::thread server_thread_;
 };
 
-TEST_F(RestCatalogIntegrationTest, GetConfigSuccessfully) {
+TEST_F(RestCatalogIntegrationTest, MakeMergesServerConfig) {
+  std::string warehouse;
+  server_->Get("/v1/config",
+               [&warehouse](const httplib::Request& req, httplib::Response& res) {
+                 warehouse = req.get_param_value("warehouse");
+                 res.status = 200;
+                 res.set_content(R"({
+                   "defaults": {"a": "default", "b": "default"},
+                   "overrides": {"b": "override"}
+                 })",
+                                 "application/json");
+               });
+
+  auto catalog = MakeCatalog({{"warehouse", "s3://test-bucket"}, {"a", "client"}});
+  ASSERT_THAT(catalog, IsOk());
+  EXPECT_EQ(warehouse, "s3://test-bucket");
+  const auto& properties = catalog.value()->properties();
+  EXPECT_EQ(properties.at("a"), "client");
+  EXPECT_EQ(properties.at("b"), "override");
+  EXPECT_EQ(properties.at("warehouse"), "s3://test-bucket");
+}
+
+TEST_F(RestCatalogIntegrationTest, HandlesServerError) {
   server_->Get("/v1/config", [](const httplib::Request&, httplib::Response& res) {
-    res.status = 200;
-    res.set_content(R"({"warehouse": "s3://test-bucket"})", "application/json");
+    res.status = 500;
+    res.set_content("Internal Server Error", "text/plain");
   });
 
-  std::string base_uri = "http://127.0.0.1:" + std::to_string(port_);
-  RestCatalog catalog(base_uri);
-  cpr::Response response = catalog.GetConfig();
+  auto catalog = MakeCatalog();
+  EXPECT_THAT(catalog, IsError(ErrorKind::kIOError));
+  EXPECT_THAT(catalog, HasErrorMessage("Internal Server Error"));
+}
 
-  ASSERT_EQ(response.error.code, cpr::ErrorCode::OK);
-  ASSERT_EQ(response.status_code, 200);
+TEST_F(RestCatalogIntegrationTest, ListNamespacesReturnsMultipleResults) {
+  ServeConfig();
+  std::vector<std::string> parents;
+  server_->Get("/v1/ws/namespaces",
+               [&parents](const httplib::Request& req, httplib::Response& res) {
+                 parents.push_back(req.get_param_value("parent"));
+                 res.status = 200;
+                 if (req.get_param_value("pageToken").empty()) {
+                   res.set_content(R"({
+                     "namespaces": [["accounting", "db"]],
+                     "next-page-token": "page-2"
+                   })",
+                                   "application/json");
+                 } else {
+                   res.set_content(R"({"namespaces": [["accounting", "tax"]]})",
+                                   "application/json");
+                 }
+               });
 
-  auto json_body = nlohmann::json::parse(response.text);
-  EXPECT_EQ(json_body["warehouse"], "s3://test-bucket");
+  auto catalog = MakeCatalog();
+  ASSERT_THAT(catalog, IsOk());
+  auto namespaces = catalog.value()->ListNamespaces(Namespace{.levels = {"accounting"}});
+  ASSERT_THAT(namespaces, IsOk());
+  ASSERT_EQ(namespaces->size(), 2);
+  EXPECT_THAT(namespaces->at(0).levels, ::testing::ElementsAre("accounting", "db"));
+  EXPECT_THAT(namespaces->at(1).levels, ::testing::ElementsAre("accounting", "tax"));
+  EXPECT_THAT(parents, ::testing::ElementsAre("accounting", "accounting"));
 }
 
-TEST_F(RestCatalogIntegrationTest, ListNamespacesReturnsMultipleResults) {
-  server_->Get("/v1/namespaces", [](const httplib::Request&, httplib::Response& res) {
+TEST_F(RestCatalogIntegrationTest, NamespaceOperations) {
+  ServeConfig();
+  std::string created;
+  server_->Post("/v1/ws/namespaces",
+                [&created](const httplib::Request& req, httplib::Response& res) {
+                  created = req.body;
+                  res.status = 200;
+                  res.set_content(req.body, "application/json");
+                });
+  // Namespace levels are joined with the unit separator.
+  server_->Get("/v1/ws/namespaces/a\x1F"
+               "b",
+               [](const httplib::Request&, httplib::Response& res) {
+                 res.status = 200;
+                 res.set_content(R"({"namespace": ["a", "b"], "properties": {"k": "v"}})",
+                                 "application/json");
+               });
+  server_->Get(R"(/v1/ws/namespaces/([^/]+))",
+               [](const httplib::Request&, httplib::Response& res) {
+                 SetError(res, 404, "NoSuchNamespaceException");
+               });
+
+  auto catalog = MakeCatalog();
+  ASSERT_THAT(catalog, IsOk());
+  Namespace ns{.levels = {"a", "b"}};
+  EXPECT_THAT(catalog.value()->CreateNamespace(ns, {{"k", "v"}}), IsOk());
+  EXPECT_EQ(nlohmann::json::parse(created), nlohmann::json::parse(R"({
+    "namespace": ["a", "b"], "properties": {"k": "v"}
+  })"));
+
+  EXPECT_THAT(catalog.value()->NamespaceExists(ns), HasValue(::testing::Eq(true)));
+  Namespace missing{.levels = {"missing"}};
+  EXPECT_THAT(catalog.value()->NamespaceExists(missing), HasValue(::testing::Eq(false)));
+
+  auto properties = catalog.value()->GetNamespaceProperties(ns);
+  ASSERT_THAT(properties, IsOk());
+  EXPECT_EQ(properties->at("k"), "v");
+  EXPECT_THAT(catalog.value()->GetNamespaceProperties(missing),
+              IsError(ErrorKind::kNoSuchNamespace));
+}
+
+TEST_F(RestCatalogIntegrationTest, LoadTable) {
+  ServeConfig();
+  server_->Get("/v1/ws/namespaces/db/tables/t",
+               [](const httplib::Request&, httplib::Response& res) {
+                 res.status = 200;
+                 res.set_content(LoadTableResultBody(), "application/json");
+               });
+  server_->Get(R"(/v1/ws/namespaces/db/tables/([^/]+))",
+               [](const httplib::Request&, httplib::Response& res) {
+                 SetError(res, 404, "NoSuchTableException");
+               });
+
+  auto catalog = MakeCatalog();
+  ASSERT_THAT(catalog, IsOk());
+  TableIdentifier identifier{.ns = Namespace{.levels = {"db"}}, .name = "t"};
+  auto table = catalog.value()->LoadTable(identifier);
+  ASSERT_THAT(table, IsOk());
+  EXPECT_EQ(table.value()->uuid(), "9c12d441-03fe-4693-9a96-a0705ddf69c1");
+  EXPECT_EQ(table.value()->location(), "s3://bucket/test/location");
+
+  EXPECT_THAT(catalog.value()->TableExists(identifier), HasValue(::testing::Eq(true)));
+  TableIdentifier missing{.ns = Namespace{.levels = {"db"}}, .name = "missing"};
+  EXPECT_THAT(catalog.value()->TableExists(missing), HasValue(::testing::Eq(false)));
+  EXPECT_THAT(catalog.value()->LoadTable(missing), IsError(ErrorKind::kNoSuchTable));
+}
+
+TEST_F(RestCatalogIntegrationTest, UpdateTable) {
+  ServeConfig();
+  std::string commit;
+  server_->Post("/v1/ws/namespaces/db/tables/t",
+                [&commit](const httplib::Request& req, httplib::Response& res) {
+                  commit = req.body;
+                  res.status = 200;
+                  res.set_content(LoadTableResultBody(), "application/json");
+                });
+  server_->Post("/v1/ws/namespaces/db/tables/conflict",
+                [](const httplib::Request&, httplib::Response& res) {
+                  SetError(res, 409, "CommitFailedException");
+                });
+
+  auto catalog = MakeCatalog();
+  ASSERT_THAT(catalog, IsOk());
+  std::vector<std::unique_ptr<TableRequirement>> requirements;
+  requirements.push_back(std::make_unique<table::AssertUUID>("uuid"));
+  std::vector<std::unique_ptr<TableUpdate>> updates;
+  updates.push_back(std::make_unique<table::SetLocation>("s3://bucket/new"));
+
+  TableIdentifier identifier{.ns = Namespace{.levels = {"db"}}, .name = "t"};
+  auto table = catalog.value()->UpdateTable(identifier, requirements, updates);
+  ASSERT_THAT(table, IsOk());
+  EXPECT_EQ(nlohmann::json::parse(commit), nlohmann::json::parse(R"({
+    "identifier": {"namespace": ["db"], "name": "t"},
+    "requirements": [{"type": "assert-table-uuid", "uuid": "uuid"}],
+    "updates": [{"action": "set-location", "location": "s3://bucket/new"}]
+  })"));
+
+  TableIdentifier conflict{.ns = Namespace{.levels = {"db"}}, .name = "conflict"};
+  EXPECT_THAT(catalog.value()->UpdateTable(conflict, requirements, updates),
+              IsError(ErrorKind::kCommitFailed));
+}
+
+TEST_F(RestCatalogIntegrationTest, CommitTransaction) {
+  ServeConfig();
+  std::string commit;
+  server_->Post("/v1/ws/transactions/commit",
+                [&commit](const httplib::Request& req, httplib::Response& res) {
+                  commit = req.body;
+                  if (commit.find("conflict") != std::string::npos) {
+                    SetError(res, 409, "CommitFailedException");
+                  } else {
+                    res.status = 204;
+                  }
+                });
+
+  auto catalog = MakeCatalog();
+  ASSERT_THAT(catalog, IsOk());
+  ::iceberg::rest::CommitTransactionRequest request;
+  for (const auto* name : {"t1", "t2"}) {
+    ::iceberg::rest::CommitTableRequest table_change{
+        .identifier = {.ns = Namespace{.levels = {"db"}}, .name = name}};
+    table_change.requirements.push_back(std::make_unique<table::AssertUUID>("uuid"));
+    table_change.updates.push_back(
+        std::make_unique<table::SetLocation>("s3://bucket/new"));
+    request.table_changes.push_back(std::move(table_change));
+  }
+  ASSERT_THAT(catalog.value()->CommitTransaction(request), IsOk());
+  EXPECT_EQ(nlohmann::json::parse(commit), nlohmann::json::parse(R"({
+    "table-changes": [
+      {
+        "identifier": {"namespace": ["db"], "name": "t1"},
+        "requirements": [{"type": "assert-table-uuid", "uuid": "uuid"}],
+        "updates": [{"action": "set-location", "location": "s3://bucket/new"}]
+      },
+      {
+        "identifier": {"namespace": ["db"], "name": "t2"},
+        "requirements": [{"type": "assert-table-uuid", "uuid": "uuid"}],
+        "updates": [{"action": "set-location", "location": "s3://bucket/new"}]
+      }
+    ]
+  })"));
+
+  request.table_changes[1].identifier.name = "conflict";
+  EXPECT_THAT(catalog.value()->CommitTransaction(request),
+              IsError(ErrorKind::kCommitFailed));
+}
+
+TEST_F(RestCatalogIntegrationTest, LoadTables) {
+  ServeConfig();
+  std::atomic<int> requests = 0;
+  server_->Get(R"(/v1/ws/namespaces/db/tables/(t\d+))",
+               [&requests](const httplib::Request&, httplib::Response& res) {
+                 ++requests;
+                 res.status = 200;
+                 res.set_content(LoadTableResultBody(), "application/json");
+               });
+  server_->Get("/v1/ws/namespaces/db/tables/missing",
+               [](const httplib::Request&, httplib::Response& res) {
+                 SetError(res, 404, "NoSuchTableException");
+               });
+
+  auto catalog = MakeCatalog();
+  ASSERT_THAT(catalog, IsOk());
+  std::vector<TableIdentifier> identifiers;
+  for (int i = 0; i < 20; ++i) {
+    identifiers.push_back(
+        {.ns = Namespace{.levels = {"db"}}, .name = "t" + std::to_string(i)});
+  }
+  identifiers.push_back({.ns = Namespace{.levels = {"db"}}, .name = "missing"});
+
+  auto tables = catalog.value()->LoadTables(identifiers, /*parallelism=*/4);
+  ASSERT_EQ(tables.size(), identifiers.size());
+  for (size_t i = 0; i + 1 < tables.size(); ++i) {
+    ASSERT_THAT(tables[i], IsOk());
+    EXPECT_EQ(tables[i].value()->name().name, identifiers[i].name);
+  }
+  EXPECT_THAT(tables.back(), IsError(ErrorKind::kNoSuchTable));
+  EXPECT_EQ(requests, 20);
+}
+
+TEST_F(RestCatalogIntegrationTest, RestTableScan) {
+  server_->Get("/v1/config", [](const httplib::Request&, httplib::Response& res) {
+    nlohmann::json config;
+    config["overrides"] = {{"prefix", "ws"}};
+    config["endpoints"] = {std::string(RestTableScan::kPlanEndpoint),
+                           std::string(RestTableScan::kTasksEndpoint)};
     res.status = 200;
-    res.set_content(R"({
-         "namespaces": [
-             ["accounting", "db"],
-             ["production", "db"]
-         ]
-     })",
-                    "application/json");
+    res.set_content(config.dump(), "application/json");
   });
+  server_->Get("/v1/ws/namespaces/db/tables/t",
+               [](const httplib::Request&, httplib::Response& res) {
+                 std::string metadata;
+                 ReadJsonFile("TableMetadataV2Valid.json", &metadata);
+                 nlohmann::json body;
+                 body["metadata-location"] = "s3://bucket/db/t/metadata/v1.metadata.json";
+                 body["metadata"] = nlohmann::json::parse(metadata);
+                 res.status = 200;
+                 res.set_content(body.dump(), "application/json");
+               });
+  auto data_file = [](const std::string& path, int64_t x) {
+    return nlohmann::json{{"content", "data"},       {"file-path", path},
+                          {"file-format", "parquet"}, {"spec-id", 0},
+                          {"partition", {x}},         {"record-count", 10},
+                          {"file-size-in-bytes", 100}};
+  };
+  nlohmann::json plan_request;
+  std::mutex mutex;
+  server_->Post("/v1/ws/namespaces/db/tables/t/plan",
+                [&](const httplib::Request& req, httplib::Response& res) {
+                  std::lock_guard lock(mutex);
+                  plan_request = nlohmann::json::parse(req.body);
+                  res.status = 200;
+                  res.set_content(R"({"status": "submitted", "plan-id": "p1"})",
+                                  "application/json");
+                });
+  server_->Get("/v1/ws/namespaces/db/tables/t/plan/p1",
+               [&](const httplib::Request&, httplib::Response& res) {
+                 nlohmann::json body;
+                 body["status"] = "completed";
+                 body["plan-id"] = "p1";
+                 body["plan-tasks"] = {"task-1"};
+                 body["file-scan-tasks"] = {{{"data-file", data_file("a.parquet", 1)}}};
+                 res.status = 200;
+                 res.set_content(body.dump(), "application/json");
+               });
+  server_->Post("/v1/ws/namespaces/db/tables/t/tasks",
+                [&](const httplib::Request& req, httplib::Response& res) {
+                  if (nlohmann::json::parse(req.body)["plan-task"] != "task-1") {
+                    SetError(res, 400, "BadRequestException");
+                    return;
+                  }
+                  nlohmann::json body;
+                  body["file-scan-tasks"] = {{{"data-file", data_file("b.parquet", 2)}},
+                                             {{"data-file", data_file("c.parquet", 3)}}};
+                  res.status = 200;
+                  res.set_content(body.dump(), "application/json");
+                });
 
-  std::string base_uri = "http://127.0.0.1:" + std::to_string(port_);
-  RestCatalog catalog(base_uri);
-  cpr::Response response = catalog.ListNamespaces();
+  auto catalog = MakeCatalog();
+  ASSERT_THAT(catalog, IsOk());
+  TableIdentifier identifier{.ns = Namespace{.levels = {"db"}}, .name = "t"};
+  ICEBERG_UNWRAP_OR_FAIL(auto table, catalog.value()->LoadTable(identifier));
+  auto builder = table->NewScan();
+  builder->WithFilter(Expressions::GreaterThan("x", Literal::Long(1)));
+  ICEBERG_UNWRAP_OR_FAIL(auto local_scan, builder->Build());
 
-  ASSERT_EQ(response.error.code, cpr::ErrorCode::OK);
-  ASSERT_EQ(response.status_code, 200);
+  RestTableScan scan(catalog.value(), identifier, std::move(local_scan));
+  ICEBERG_UNWRAP_OR_FAIL(auto tasks, scan.PlanFiles());
+  // The file of partition x=1 cannot match the filter.
+  ASSERT_EQ(tasks.size(), 2);
+  EXPECT_EQ(tasks[0]->data_file()->file_path, "b.parquet");
+  EXPECT_EQ(tasks[1]->data_file()->file_path, "c.parquet");
+  EXPECT_EQ(plan_request["snapshot-id"], 3055729675574597004);
+  EXPECT_EQ(plan_request["filter"],
+            nlohmann::json::parse(R"({"type": "gt", "term": "x", "value": 1})"));
+}
+
+TEST_F(RestCatalogIntegrationTest, HttpClientReusesConnections) {
+  std::mutex mutex;
+  std::set<int> remote_ports;
+  std::string accept_encoding;
+  server_->Get("/ping", [&](const httplib::Request& req, httplib::Response& res) {
+    std::lock_guard lock(mutex);
+    remote_ports.insert(req.remote_port);
+    accept_encoding = req.get_header_value("Accept-Encoding");
+    res.status = 200;
+    res.set_content("pong", "text/plain");
+  });
 
-  auto json_body = nlohmann::json::parse(response.text);
-  ASSERT_TRUE(json_body.contains("namespaces"));
-  EXPECT_EQ(json_body["namespaces"].size(), 2);
-  EXPECT_THAT(json_body["namespaces"][0][0], "accounting");
+  HttpClient client;
+  for (int i = 0; i < 10; ++i) {
+    auto response = client.Get(BaseUri() + "/ping", cpr::Parameters{});
+    ASSERT_THAT(response, IsOk());
+    EXPECT_EQ(response->text, "pong");
+  }
+  // Sequential requests reuse the connection of one pooled session.
+  EXPECT_EQ(remote_ports.size(), 1);
+  EXPECT_EQ(client.idle_sessions(), 1);
+  EXPECT_THAT(accept_encoding, ::testing::HasSubstr("gzip"));
 }
 
-TEST_F(RestCatalogIntegrationTest, HandlesServerError) {
-  server_->Get("/v1/config", [](const httplib::Request&, httplib::Response& res) {
-    res.status = 500;
-    res.set_content("Internal Server Error", "text/plain");
+TEST_F(RestCatalogIntegrationTest, HttpClientConcurrentRequests) {
+  server_->Get("/ping", [](const httplib::Request&, httplib::Response& res) {
+    res.status = 200;
+    res.set_content("pong", "text/plain");
   });
 
-  std::string base_uri = "http://127.0.0.1:" + std::to_string(port_);
-  RestCatalog catalog(base_uri);
-  cpr::Response response = catalog.GetConfig();
+  constexpr int kThreads = 8;
+  HttpClient client(HttpClientOptions{.max_idle_sessions = 4});
+  std::vector<std::thread> threads;
+  std::atomic<int> failures = 0;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&]() {
+      for (int j = 0; j < 10; ++j) {
+        auto response = client.Get(BaseUri() + "/ping", cpr::Parameters{});
+        if (!response.has_value() || response->text != "pong") {
+          ++failures;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(failures, 0);
+  EXPECT_GE(client.idle_sessions(), 1);
+  EXPECT_LE(client.idle_sessions(), 4);
+}
+
+TEST(RestJsonTest, TableUpdateToJson) {
+  auto json = ::iceberg::rest::ToJson(table::SetSnapshotRef(
+      "main", 42, SnapshotRefType::kBranch, /*min_snapshots_to_keep=*/3));
+  ASSERT_THAT(json, IsOk());
+  EXPECT_EQ(json.value(), nlohmann::json::parse(R"({
+    "action": "set-snapshot-ref", "ref-name": "main", "snapshot-id": 42,
+    "type": "branch", "min-snapshots-to-keep": 3
+  })"));
+
+  json = ::iceberg::rest::ToJson(table::RemoveProperties({"a", "b"}));
+  ASSERT_THAT(json, IsOk());
+  EXPECT_EQ(json.value(), nlohmann::json::parse(R"({
+    "action": "remove-properties", "removals": ["a", "b"]
+  })"));
+}
+
+TEST(RestJsonTest, TableRequirementToJson) {
+  auto json = ::iceberg::rest::ToJson(table::AssertRefSnapshotID("main", std::nullopt));
+  ASSERT_THAT(json, IsOk());
+  EXPECT_EQ(json.value(), nlohmann::json::parse(R"({
+    "type": "assert-ref-snapshot-id", "ref": "main", "snapshot-id": null
+  })"));
+
+  json = ::iceberg::rest::ToJson(table::AssertDoesNotExist());
+  ASSERT_THAT(json, IsOk());
+  EXPECT_EQ(json.value(), nlohmann::json::parse(R"({"type": "assert-create"})"));
+}
+
+TEST(RestJsonTest, ErrorResponseFromJson) {
+  auto error = ::iceberg::rest::ErrorResponseFromJson(nlohmann::json::parse(R"({
+    "error": {"message": "missing", "type": "NoSuchTableException", "code": 404}
+  })"));
+  ASSERT_THAT(error, IsOk());
+  EXPECT_EQ(error->message, "missing");
+  EXPECT_EQ(error->type, "NoSuchTableException");
+  EXPECT_EQ(error->code, 404);
+}
+
+TEST(RestJsonTest, ExpressionToJson) {
+  auto expr = Expressions::And(
+      Expressions::Equal("x", Literal::Long(1)),
+      Expressions::Not(Expressions::In("y", {Literal::Int(2), Literal::Int(3)})));
+  auto json = ::iceberg::rest::ToJson(*expr);
+  ASSERT_THAT(json, IsOk());
+  EXPECT_EQ(json.value(), nlohmann::json::parse(R"({
+    "type": "and",
+    "left": {"type": "eq", "term": "x", "value": 1},
+    "right": {"type": "not", "child": {"type": "in", "term": "y", "values": [2, 3]}}
+  })"));
+
+  json = ::iceberg::rest::ToJson(*Expressions::IsNull("x"));
+  ASSERT_THAT(json, IsOk());
+  EXPECT_EQ(json.value(), nlohmann::json::parse(R"({"type": "is-null", "term": "x"})"));
+
+  EXPECT_THAT(::iceberg::rest::ToJson(*Expressions::Equal("x", Literal::Binary({1}))),
+              IsError(ErrorKind::kNotSupported));
+}
+
+TEST(RestJsonTest, ExpressionFromJson) {
+  auto json = nlohmann::json::parse(R"({
+    "type": "or",
+    "left": {"type": "lt-eq", "term": "x", "value": 1},
+    "right": {
+      "type": "not",
+      "child": {
+        "type": "in",
+        "term": {"type": "transform", "transform": "bucket[16]", "term": "y"},
+        "values": [2, 3]
+      }
+    }
+  })");
+  ICEBERG_UNWRAP_OR_FAIL(auto expr, ::iceberg::rest::ExpressionFromJson(json));
+  ASSERT_EQ(expr->op(), Expression::Operation::kOr);
+  const auto& or_expr = internal::checked_cast<const Or&>(*expr);
+  auto left =
+      std::dynamic_pointer_cast<UnboundPredicate<BoundReference>>(or_expr.left());
+  ASSERT_NE(left, nullptr);
+  EXPECT_EQ(left->op(), Expression::Operation::kLtEq);
+  EXPECT_EQ(left->term()->reference()->name(), "x");
+  EXPECT_THAT(left->literals(), ::testing::ElementsAre(Literal::Long(1)));
+
+  // Expressions written by ToJson are read back unchanged.
+  ICEBERG_UNWRAP_OR_FAIL(auto round_trip, ::iceberg::rest::ToJson(*expr));
+  EXPECT_EQ(round_trip, json);
+
+  ICEBERG_UNWRAP_OR_FAIL(auto always_true,
+                         ::iceberg::rest::ExpressionFromJson(nlohmann::json(true)));
+  EXPECT_EQ(always_true->op(), Expression::Operation::kTrue);
+
+  EXPECT_THAT(::iceberg::rest::ExpressionFromJson(
+                  nlohmann::json::parse(R"({"type": "like", "term": "x"})")),
+              IsError(ErrorKind::kJsonParseError));
+  EXPECT_THAT(::iceberg::rest::ExpressionFromJson(
+                  nlohmann::json::parse(R"({"type": "eq", "term": "x"})")),
+              IsError(ErrorKind::kJsonParseError));
+}
+
+TEST(RestJsonTest, PlanTableScanResponseFromJson) {
+  ICEBERG_UNWRAP_OR_FAIL(auto metadata, ReadTableMetadata("TableMetadataV2Valid.json"));
+  auto response = ::iceberg::rest::PlanTableScanResponseFromJson(
+      nlohmann::json::parse(R"({
+        "status": "completed",
+        "plan-tasks": ["next"],
+        "delete-files": [{
+          "content": "position-deletes", "file-path": "d.parquet",
+          "file-format": "parquet", "spec-id": 0, "partition": [7],
+          "record-count": 1, "file-size-in-bytes": 10
+        }],
+        "file-scan-tasks": [{
+          "data-file": {
+            "content": "data", "file-path": "a.parquet", "file-format": "parquet",
+            "spec-id": 0, "partition": [7], "record-count": 5,
+            "file-size-in-bytes": 100, "key-metadata": "0aff",
+            "value-counts": {"keys": [1], "values": [5]},
+            "lower-bounds": {"keys": [1, 99], "values": [3, "ignored"]}
+          },
+          "delete-file-references": [0]
+        }]
+      })"),
+      *metadata);
+  ASSERT_THAT(response, IsOk());
+  EXPECT_EQ(response->plan_status, "completed");
+  EXPECT_EQ(response->tasks.plan_tasks, std::vector<std::string>{"next"});
+  ASSERT_EQ(response->tasks.delete_files.size(), 1);
+  EXPECT_EQ(response->tasks.delete_files[0]->content,
+            DataFile::Content::kPositionDeletes);
+  ASSERT_EQ(response->tasks.file_scan_tasks.size(), 1);
+  const auto& task = response->tasks.file_scan_tasks[0];
+  EXPECT_EQ(task.delete_file_references, std::vector<int32_t>{0});
+  EXPECT_EQ(task.data_file->file_path, "a.parquet");
+  EXPECT_EQ(task.data_file->partition, std::vector<Literal>{Literal::Long(7)});
+  EXPECT_EQ(task.data_file->key_metadata, (std::vector<uint8_t>{0x0a, 0xff}));
+  EXPECT_EQ(task.data_file->value_counts.at(1), 5);
+  EXPECT_EQ(task.data_file->lower_bounds.size(), 1);
+  EXPECT_EQ(task.data_file->lower_bounds.at(1).size(), 8);
 
-  ASSERT_EQ(response.error.code, cpr::ErrorCode::OK);
-  ASSERT_EQ(response.status_code, 500);
-  ASSERT_EQ(response.text, "Internal Server Error");
+  auto out_of_range = ::iceberg::rest::FetchScanTasksResponseFromJson(
+      nlohmann::json::parse(R"({"file-scan-tasks": [{
+        "data-file": {"content": "data", "file-path": "a.parquet",
+                      "file-format": "parquet", "spec-id": 0, "partition": [7],
+                      "record-count": 5, "file-size-in-bytes": 100},
+        "delete-file-references": [1]
+      }]})"),
+      *metadata);
+  EXPECT_THAT(out_of_range, IsError(ErrorKind::kJsonParseError));
 }
 
 }  // namespace iceberg::catalog::rest
@@ -0,0 +1,297 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/rewrite_data_files.h"
+
+#include <filesystem>
+#include <format>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <arrow/array.h>
+#include <arrow/c/bridge.h>
+#include <arrow/json/from_string.h>
+#include <arrow/record_batch.h>
+#include <arrow/table.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/avro/avro_register.h"
+#include "iceberg/data_writer.h"
+#include "iceberg/fast_append.h"
+#include "iceberg/location_provider.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/parquet/parquet_register.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/sort_field.h"
+#include "iceberg/sort_order.h"
+#include "iceberg/table.h"
+#include "iceberg/table_scan.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/test/table_test_base.h"
+#include "iceberg/transform.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+namespace {
+
+class DirectoryLocationProvider : public LocationProvider {
+ public:
+  explicit DirectoryLocationProvider(std::string directory)
+      : directory_(std::move(directory)) {}
+
+  Result<std::string> NewDataLocation(const std::string& filename) override {
+    return std::format("{}/{}", directory_, filename);
+  }
+
+  Result<std::string> NewDataLocation(const PartitionSpec& /*spec*/,
+                                      const StructLike& /*partition_data*/,
+                                      const std::string& filename) override {
+    return NewDataLocation(filename);
+  }
+
+ private:
+  std::string directory_;
+};
+
+}  // namespace
+
+class RewriteDataFilesTest : public TableTestBase {
+ protected:
+  static void SetUpTestSuite() {
+    avro::RegisterAll();
+    parquet::RegisterAll();
+  }
+
+  void SetUp() override {
+    TableTestBase::SetUp();
+    std::filesystem::create_directories(table_location_ + "/data");
+    schema_ = std::make_shared<Schema>(
+        std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int64()),
+                                 SchemaField::MakeOptional(2, "data", string())},
+        /*schema_id=*/0);
+  }
+
+  // Writes the rows to a Parquet data file and appends it to the table.
+  void AppendRows(const std::string& rows_json) {
+    auto array = ::arrow::json::ArrayFromJSONString(
+                     ::arrow::struct_({::arrow::field("id", ::arrow::int64(), false),
+                                       ::arrow::field("data", ::arrow::utf8())}),
+                     rows_json)
+                     .ValueOrDie();
+    ArrowArray batch;
+    ASSERT_TRUE(::arrow::ExportArray(*array, &batch).ok());
+
+    ICEBERG_UNWRAP_OR_FAIL(
+        auto writer,
+        FanoutDataWriter::Make(PartitionedWriterOptions{
+            .schema = schema_,
+            .spec = PartitionSpec::Unpartitioned(),
+            .io = file_io_,
+            .location_provider =
+                std::make_shared<DirectoryLocationProvider>(table_location_ + "/data"),
+        }));
+    ASSERT_THAT(writer->Write(&batch), IsOk());
+    ICEBERG_UNWRAP_OR_FAIL(auto data_files, writer->Close());
+
+    FastAppend append(table_);
+    for (auto& data_file : data_files) {
+      append.AppendFile(std::make_shared<DataFile>(std::move(data_file)));
+    }
+    ASSERT_THAT(append.Commit(), IsOk());
+  }
+
+  std::vector<std::shared_ptr<FileScanTask>> PlanFiles() {
+    TableScanBuilder builder(table_->metadata(), file_io_);
+    auto scan = builder.Build();
+    EXPECT_THAT(scan, IsOk());
+    auto tasks = scan.value()->PlanFiles();
+    EXPECT_THAT(tasks, IsOk());
+    return tasks.value();
+  }
+
+  // Reads the rows of the current snapshot.
+  std::shared_ptr<::arrow::Table> ReadTable() {
+    std::vector<std::shared_ptr<::arrow::RecordBatch>> batches;
+    std::shared_ptr<::arrow::Schema> arrow_schema;
+    for (const auto& task : PlanFiles()) {
+      auto stream = task->ToArrow(file_io_, schema_, nullptr);
+      EXPECT_THAT(stream, IsOk());
+      auto reader = ::arrow::ImportRecordBatchReader(&stream.value()).ValueOrDie();
+      arrow_schema = reader->schema();
+      for (const auto& batch : reader->ToRecordBatches().ValueOrDie()) {
+        batches.push_back(batch);
+      }
+    }
+    return ::arrow::Table::FromRecordBatches(arrow_schema, batches)
+        .ValueOrDie()
+        ->CombineChunks()
+        .ValueOrDie();
+  }
+};
+
+TEST_F(RewriteDataFilesTest, CompactsSmallFiles) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable());
+  ASSERT_NO_FATAL_FAILURE(AppendRows(R"([[1, "a"], [2, "b"]])"));
+  ASSERT_NO_FATAL_FAILURE(AppendRows(R"([[3, "c"]])"));
+  ASSERT_NO_FATAL_FAILURE(AppendRows(R"([[4, null], [5, "e"]])"));
+  const auto before = PlanFiles();
+  ASSERT_EQ(before.size(), 3);
+
+  ICEBERG_UNWRAP_OR_FAIL(auto result,
+                         RewriteDataFiles(table_).MinInputFiles(2).Execute());
+  EXPECT_EQ(result.rewritten_file_groups_count, 1);
+  EXPECT_EQ(result.rewritten_data_files_count, 3);
+  EXPECT_EQ(result.added_data_files_count, 1);
+  ASSERT_TRUE(result.snapshot_id.has_value());
+
+  ICEBERG_UNWRAP_OR_FAIL(auto snapshot, table_->metadata()->Snapshot());
+  EXPECT_EQ(snapshot->snapshot_id, result.snapshot_id.value());
+  EXPECT_EQ(snapshot->operation(), DataOperation::kReplace);
+  const auto after = PlanFiles();
+  ASSERT_EQ(after.size(), 1);
+  EXPECT_EQ(after[0]->data_file()->record_count, 5);
+  EXPECT_TRUE(after[0]->data_file()->file_path.starts_with(table_location_ + "/data/"));
+
+  // Files are bin-packed by decreasing size, so the rows are compared by ID.
+  auto rows = ReadTable();
+  ASSERT_EQ(rows->num_rows(), 5);
+  auto ids = std::static_pointer_cast<::arrow::Int64Array>(rows->column(0)->chunk(0));
+  auto data = std::static_pointer_cast<::arrow::StringArray>(rows->column(1)->chunk(0));
+  std::map<int64_t, std::string> rows_by_id;
+  for (int64_t i = 0; i < rows->num_rows(); ++i) {
+    rows_by_id[ids->Value(i)] = data->IsNull(i) ? "null" : data->GetString(i);
+  }
+  EXPECT_EQ(rows_by_id, (std::map<int64_t, std::string>{
+                            {1, "a"}, {2, "b"}, {3, "c"}, {4, "null"}, {5, "e"}}));
+}
+
+TEST_F(RewriteDataFilesTest, SortsRewrittenRows) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable());
+  ASSERT_NO_FATAL_FAILURE(AppendRows(R"([[2, "b"], [5, "e"]])"));
+  ASSERT_NO_FATAL_FAILURE(AppendRows(R"([[3, "c"]])"));
+  auto sort_order = std::make_shared<SortOrder>(
+      1, std::vector<SortField>{SortField(1, Transform::Identity(),
+                                          SortDirection::kDescending, NullOrder::kLast)});
+
+  // Groups with too few files are only rewritten with RewriteAll().
+  ICEBERG_UNWRAP_OR_FAIL(auto result,
+                         RewriteDataFiles(table_).Sort(sort_order).Execute());
+  EXPECT_FALSE(result.snapshot_id.has_value());
+  ICEBERG_UNWRAP_OR_FAIL(
+      result, RewriteDataFiles(table_).Sort(sort_order).RewriteAll(true).Execute());
+  EXPECT_EQ(result.rewritten_data_files_count, 2);
+  ASSERT_TRUE(result.snapshot_id.has_value());
+
+  auto rows = ReadTable();
+  ASSERT_EQ(rows->num_rows(), 3);
+  auto ids = std::static_pointer_cast<::arrow::Int64Array>(rows->column(0)->chunk(0));
+  EXPECT_EQ(ids->Value(0), 5);
+  EXPECT_EQ(ids->Value(1), 3);
+  EXPECT_EQ(ids->Value(2), 2);
+}
+
+TEST_F(RewriteDataFilesTest, ZOrdersRewrittenRows) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable());
+  ASSERT_NO_FATAL_FAILURE(AppendRows(R"([[3, "a"], [0, "d"]])"));
+  ASSERT_NO_FATAL_FAILURE(AppendRows(R"([[1, "b"]])"));
+  EXPECT_THAT(RewriteDataFiles(table_).ZOrder({"id", "missing"}).Execute(),
+              IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(RewriteDataFiles(table_).ZOrder({}).Execute(),
+              IsError(ErrorKind::kInvalidArgument));
+  // The table has no sort order.
+  EXPECT_THAT(RewriteDataFiles(table_).Sort().Execute(),
+              IsError(ErrorKind::kInvalidArgument));
+
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto result,
+      RewriteDataFiles(table_).ZOrder({"id", "data"}).MinInputFiles(2).Execute());
+  ASSERT_TRUE(result.snapshot_id.has_value());
+  const auto after = PlanFiles();
+  ASSERT_EQ(after.size(), 1);
+  EXPECT_FALSE(after[0]->data_file()->sort_order_id.has_value());
+
+  // The first bytes of the data precede the low bytes of the ids in the key.
+  auto rows = ReadTable();
+  ASSERT_EQ(rows->num_rows(), 3);
+  auto ids = std::static_pointer_cast<::arrow::Int64Array>(rows->column(0)->chunk(0));
+  EXPECT_EQ(ids->Value(0), 3);
+  EXPECT_EQ(ids->Value(1), 1);
+  EXPECT_EQ(ids->Value(2), 0);
+}
+
+TEST_F(RewriteDataFilesTest, SkipsGroupsWithTooFewFiles) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable());
+  ASSERT_NO_FATAL_FAILURE(AppendRows(R"([[1, "a"]])"));
+  ASSERT_NO_FATAL_FAILURE(AppendRows(R"([[2, "b"]])"));
+  const auto snapshot_id = table_->metadata()->current_snapshot_id;
+
+  ICEBERG_UNWRAP_OR_FAIL(auto result, RewriteDataFiles(table_).Execute());
+  EXPECT_EQ(result.rewritten_file_groups_count, 0);
+  EXPECT_FALSE(result.snapshot_id.has_value());
+  EXPECT_EQ(table_->metadata()->current_snapshot_id, snapshot_id);
+
+  // Files of the target size are not selected.
+  ICEBERG_UNWRAP_OR_FAIL(
+      result, RewriteDataFiles(table_).MinInputFiles(2).MinFileSize(1).Execute());
+  EXPECT_FALSE(result.snapshot_id.has_value());
+}
+
+TEST_F(RewriteDataFilesTest, RewriteFailsForRemovedFiles) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable());
+  ASSERT_NO_FATAL_FAILURE(AppendRows(R"([[1, "a"]])"));
+  auto file = std::make_shared<DataFile>(*PlanFiles()[0]->data_file());
+
+  auto missing = std::make_shared<DataFile>(*file);
+  missing->file_path = table_location_ + "/data/missing.parquet";
+  RewriteFiles rewrite(table_);
+  rewrite.RemoveDataFile(missing).AddDataFile(file);
+  EXPECT_THAT(rewrite.Commit(), IsError(ErrorKind::kValidationFailed));
+
+  RewriteFiles no_removed(table_);
+  no_removed.AddDataFile(file);
+  EXPECT_THAT(no_removed.Commit(), IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(RewriteDataFilesTest, ValidatesStartingSnapshotIsAncestor) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable());
+  ASSERT_NO_FATAL_FAILURE(AppendRows(R"([[1, "a"]])"));
+  auto file = PlanFiles()[0]->data_file();
+
+  RewriteFiles rewrite(table_);
+  rewrite.RemoveDataFile(file).AddDataFile(file).ValidateFromSnapshot(12345);
+  EXPECT_THAT(rewrite.Commit(), IsError(ErrorKind::kValidationFailed));
+}
+
+TEST_F(RewriteDataFilesTest, RejectsInvalidOptions) {
+  ASSERT_NO_FATAL_FAILURE(CreateTable());
+  EXPECT_THAT(RewriteDataFiles(table_).WithParallelism(0).Execute(),
+              IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(RewriteDataFiles(table_).TargetFileSize(0).Execute(),
+              IsError(ErrorKind::kInvalidArgument));
+  ICEBERG_UNWRAP_OR_FAIL(auto result, RewriteDataFiles(table_).Execute());
+  EXPECT_FALSE(result.snapshot_id.has_value());
+}
+
+}  // namespace iceberg
@@ -0,0 +1,228 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/rewrite_manifests.h"
+
+#include <algorithm>
+#include <format>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/expression/literal.h"
+#include "iceberg/fast_append.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/manifest_reader.h"
+#include "iceberg/partition_field.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table.h"
+#include "iceberg/table_scan.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/test/table_test_base.h"
+#include "iceberg/transform.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+class RewriteManifestsTest : public TableTestBase {
+ protected:
+  void SetUp() override {
+    TableTestBase::SetUp();
+    spec_ = std::make_shared<PartitionSpec>(
+        schema_, PartitionSpec::kInitialSpecId,
+        std::vector<PartitionField>{
+            PartitionField(1, 1000, "id", Transform::Identity())});
+  }
+
+  static std::shared_ptr<DataFile> MakeDataFile(const std::string& path, int64_t id) {
+    return std::make_shared<DataFile>(DataFile{
+        .file_path = path,
+        .file_format = FileFormatType::kParquet,
+        .partition = {Literal::Long(id)},
+        .record_count = 10,
+        .file_size_in_bytes = 100,
+    });
+  }
+
+  // Appends a file to each of the partitions 1 and 2 in each of two commits, so that
+  // both manifests span both partitions.
+  void AppendInterleaved(const std::shared_ptr<Table>& table) {
+    for (const auto& prefix : {"/data/a", "/data/b"}) {
+      FastAppend append(table);
+      append.AppendFile(MakeDataFile(std::format("{}-1.parquet", prefix), 1))
+          .AppendFile(MakeDataFile(std::format("{}-2.parquet", prefix), 2));
+      ASSERT_THAT(append.Commit(), IsOk());
+    }
+  }
+
+  const std::vector<std::string> all_paths_{"/data/a-1.parquet", "/data/a-2.parquet",
+                                            "/data/b-1.parquet", "/data/b-2.parquet"};
+
+  static std::vector<std::string> ScanPaths(const Table& table) {
+    auto scan = table.NewScan()->Build();
+    EXPECT_THAT(scan, IsOk());
+    auto tasks = (*scan)->PlanFiles();
+    EXPECT_THAT(tasks, IsOk());
+    std::vector<std::string> paths;
+    for (const auto& task : *tasks) {
+      paths.push_back(task->data_file()->file_path);
+    }
+    std::ranges::sort(paths);
+    return paths;
+  }
+
+  std::vector<ManifestFile> Manifests(const Snapshot& snapshot) {
+    auto reader = ManifestListReader::Make(snapshot.manifest_list, file_io_);
+    EXPECT_THAT(reader, IsOk());
+    auto files = (*reader)->Files();
+    EXPECT_THAT(files, IsOk());
+    return std::move(files.value());
+  }
+
+  std::vector<ManifestEntry> Entries(const ManifestFile& manifest) {
+    auto partition_schema = std::make_shared<Schema>(std::vector<SchemaField>{
+        SchemaField::MakeOptional(1000, "id", int64())});
+    auto reader = ManifestReader::Make(manifest, file_io_, partition_schema);
+    EXPECT_THAT(reader, IsOk());
+    auto entries = (*reader)->Entries();
+    EXPECT_THAT(entries, IsOk());
+    return std::move(entries.value());
+  }
+};
+
+TEST_F(RewriteManifestsTest, ClustersEntriesByPartition) {
+  ASSERT_NO_FATAL_FAILURE(RegisterTable());
+  auto table = LoadTable();
+  ASSERT_NO_FATAL_FAILURE(AppendInterleaved(table));
+  ICEBERG_UNWRAP_OR_FAIL(auto parent, table->current_snapshot());
+
+  RewriteManifests rewrite(table);
+  ASSERT_THAT(rewrite.Commit(), IsOk());
+
+  ICEBERG_UNWRAP_OR_FAIL(auto snapshot, table->current_snapshot());
+  EXPECT_EQ(snapshot->parent_snapshot_id, parent->snapshot_id);
+  EXPECT_EQ(snapshot->operation(), DataOperation::kReplace);
+  EXPECT_EQ(snapshot->summary.at(SnapshotSummaryFields::kCreatedManifestsCount), "1");
+  EXPECT_EQ(snapshot->summary.at(SnapshotSummaryFields::kReplacedManifestsCount), "2");
+  EXPECT_EQ(snapshot->summary.at(SnapshotSummaryFields::kKeptManifestsCount), "0");
+  EXPECT_EQ(snapshot->summary.at(SnapshotSummaryFields::kProcessedManifestEntries), "4");
+  EXPECT_EQ(snapshot->summary.at(SnapshotSummaryFields::kTotalDataFiles), "4");
+
+  auto manifests = Manifests(*snapshot);
+  ASSERT_EQ(manifests.size(), 1);
+  EXPECT_EQ(manifests[0].existing_files_count, 4);
+  EXPECT_EQ(manifests[0].added_files_count, 0);
+
+  // The entries are ordered by partition, then by manifest, and keep their sequence
+  // numbers.
+  auto entries = Entries(manifests[0]);
+  ASSERT_EQ(entries.size(), 4);
+  std::vector<std::string> paths;
+  for (const auto& entry : entries) {
+    EXPECT_EQ(entry.status, ManifestStatus::kExisting);
+    paths.push_back(entry.data_file->file_path);
+  }
+  EXPECT_EQ(paths, (std::vector<std::string>{"/data/b-1.parquet", "/data/a-1.parquet",
+                                             "/data/b-2.parquet", "/data/a-2.parquet"}));
+  EXPECT_EQ(entries[0].sequence_number, 2);
+  EXPECT_EQ(entries[1].sequence_number, 1);
+
+  EXPECT_EQ(ScanPaths(*table), all_paths_);
+}
+
+TEST_F(RewriteManifestsTest, ManifestsDoNotOverlap) {
+  ASSERT_NO_FATAL_FAILURE(RegisterTable({{"commit.manifest.target-size-bytes", "1"}}));
+  auto table = LoadTable();
+  ASSERT_NO_FATAL_FAILURE(AppendInterleaved(table));
+
+  RewriteManifests rewrite(table);
+  rewrite.WithParallelism(4);
+  ASSERT_THAT(rewrite.Commit(), IsOk());
+
+  // With a tiny target size each entry fills a manifest, and no manifest spans more
+  // than one partition.
+  ICEBERG_UNWRAP_OR_FAIL(auto snapshot, table->current_snapshot());
+  auto manifests = Manifests(*snapshot);
+  ASSERT_EQ(manifests.size(), 4);
+  for (const auto& manifest : manifests) {
+    ASSERT_EQ(manifest.partitions.size(), 1);
+    EXPECT_EQ(manifest.partitions[0].lower_bound, manifest.partitions[0].upper_bound);
+  }
+  EXPECT_EQ(ScanPaths(*table), all_paths_);
+}
+
+TEST_F(RewriteManifestsTest, ClusterByFunction) {
+  ASSERT_NO_FATAL_FAILURE(RegisterTable());
+  auto table = LoadTable();
+  ASSERT_NO_FATAL_FAILURE(AppendInterleaved(table));
+
+  // Cluster by the commit that wrote the file.
+  RewriteManifests rewrite(table);
+  rewrite.ClusterBy([](const DataFile& file) {
+    return std::vector<Literal>{Literal::String(file.file_path.substr(0, 7))};
+  });
+  ASSERT_THAT(rewrite.Commit(), IsOk());
+
+  ICEBERG_UNWRAP_OR_FAIL(auto snapshot, table->current_snapshot());
+  auto manifests = Manifests(*snapshot);
+  ASSERT_EQ(manifests.size(), 1);
+  std::vector<std::string> paths;
+  for (const auto& entry : Entries(manifests[0])) {
+    paths.push_back(entry.data_file->file_path);
+  }
+  EXPECT_EQ(paths, all_paths_);
+}
+
+TEST_F(RewriteManifestsTest, RewriteIfKeepsOtherManifests) {
+  ASSERT_NO_FATAL_FAILURE(RegisterTable());
+  auto table = LoadTable();
+  ASSERT_NO_FATAL_FAILURE(AppendInterleaved(table));
+  ICEBERG_UNWRAP_OR_FAIL(auto parent, table->current_snapshot());
+  auto kept = Manifests(*parent)[0];
+
+  RewriteManifests rewrite(table);
+  rewrite.RewriteIf([&](const ManifestFile& manifest) {
+    return manifest.manifest_path != kept.manifest_path;
+  });
+  ASSERT_THAT(rewrite.Commit(), IsOk());
+
+  ICEBERG_UNWRAP_OR_FAIL(auto snapshot, table->current_snapshot());
+  EXPECT_EQ(snapshot->summary.at(SnapshotSummaryFields::kKeptManifestsCount), "1");
+  auto manifests = Manifests(*snapshot);
+  ASSERT_EQ(manifests.size(), 2);
+  EXPECT_EQ(manifests[1].manifest_path, kept.manifest_path);
+  EXPECT_EQ(ScanPaths(*table), all_paths_);
+}
+
+TEST_F(RewriteManifestsTest, InvalidParallelism) {
+  ASSERT_NO_FATAL_FAILURE(RegisterTable());
+  auto table = LoadTable();
+
+  RewriteManifests rewrite(table);
+  rewrite.WithParallelism(0);
+  EXPECT_THAT(rewrite.Commit(), IsError(ErrorKind::kInvalidArgument));
+  EXPECT_EQ(table->metadata()->current_snapshot_id, Snapshot::kInvalidSnapshotId);
+}
+
+}  // namespace iceberg
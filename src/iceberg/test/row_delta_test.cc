@@ -0,0 +1,326 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/row_delta.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/expression/expressions.h"
+#include "iceberg/expression/literal.h"
+#include "iceberg/fast_append.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/manifest_reader.h"
+#include "iceberg/rewrite_data_files.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table.h"
+#include "iceberg/table_scan.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/test/table_test_base.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+class RowDeltaTest : public TableTestBase {
+ protected:
+  // A data file whose IDs are between the bounds.
+  static std::shared_ptr<DataFile> MakeDataFile(const std::string& path,
+                                                int64_t lower = 0, int64_t upper = 10) {
+    return std::make_shared<DataFile>(DataFile{
+        .file_path = path,
+        .file_format = FileFormatType::kParquet,
+        .record_count = 10,
+        .file_size_in_bytes = 100,
+        .lower_bounds = {{1, Literal::Long(lower).Serialize().value()}},
+        .upper_bounds = {{1, Literal::Long(upper).Serialize().value()}},
+    });
+  }
+
+  static std::shared_ptr<DataFile> MakePositionDeletes(const std::string& path,
+                                                       const std::string& data_file) {
+    return std::make_shared<DataFile>(DataFile{
+        .content = DataFile::Content::kPositionDeletes,
+        .file_path = path,
+        .file_format = FileFormatType::kParquet,
+        .record_count = 2,
+        .file_size_in_bytes = 20,
+        .referenced_data_file = data_file,
+    });
+  }
+
+  static std::shared_ptr<DataFile> MakeEqualityDeletes(const std::string& path) {
+    return std::make_shared<DataFile>(DataFile{
+        .content = DataFile::Content::kEqualityDeletes,
+        .file_path = path,
+        .file_format = FileFormatType::kParquet,
+        .record_count = 3,
+        .file_size_in_bytes = 30,
+        .equality_ids = {1},
+    });
+  }
+
+  // The paths of the delete files of the scan tasks, by the paths of their data files.
+  static std::map<std::string, std::vector<std::string>> ScanDeletes(
+      const Table& table) {
+    auto scan = table.NewScan()->Build();
+    EXPECT_THAT(scan, IsOk());
+    auto tasks = (*scan)->PlanFiles();
+    EXPECT_THAT(tasks, IsOk());
+    std::map<std::string, std::vector<std::string>> deletes;
+    for (const auto& task : *tasks) {
+      auto& paths = deletes[task->data_file()->file_path];
+      for (const auto& delete_file : task->delete_files()) {
+        paths.push_back(delete_file->file_path);
+      }
+      std::ranges::sort(paths);
+    }
+    return deletes;
+  }
+
+  std::vector<ManifestFile> Manifests(const Snapshot& snapshot) {
+    auto reader = ManifestListReader::Make(snapshot.manifest_list, file_io_);
+    EXPECT_THAT(reader, IsOk());
+    auto files = (*reader)->Files();
+    EXPECT_THAT(files, IsOk());
+    return std::move(files.value());
+  }
+};
+
+TEST_F(RowDeltaTest, CommitsDataAndDeletesInOneSnapshot) {
+  ASSERT_NO_FATAL_FAILURE(RegisterTable());
+  auto table = LoadTable();
+  FastAppend append(table);
+  append.AppendFile(MakeDataFile("/data/a.parquet"));
+  ASSERT_THAT(append.Commit(), IsOk());
+
+  RowDelta delta(table);
+  delta.AddRows(MakeDataFile("/data/b.parquet"))
+      .AddDeletes(MakePositionDeletes("/data/a-pos.parquet", "/data/a.parquet"))
+      .AddDeletes(MakeEqualityDeletes("/data/eq.parquet"))
+      .Set("engine-name", "test");
+  ASSERT_THAT(delta.Commit(), IsOk());
+
+  ICEBERG_UNWRAP_OR_FAIL(auto snapshot, table->current_snapshot());
+  EXPECT_EQ(snapshot->snapshot_id, delta.snapshot_id());
+  EXPECT_EQ(snapshot->parent_snapshot_id, append.snapshot_id());
+  EXPECT_EQ(snapshot->sequence_number, 2);
+  EXPECT_EQ(snapshot->operation(), DataOperation::kOverwrite);
+  const auto& summary = snapshot->summary;
+  EXPECT_EQ(summary.at(SnapshotSummaryFields::kAddedDataFiles), "1");
+  EXPECT_EQ(summary.at(SnapshotSummaryFields::kAddedDeleteFiles), "2");
+  EXPECT_EQ(summary.at(SnapshotSummaryFields::kAddedPosDeleteFiles), "1");
+  EXPECT_EQ(summary.at(SnapshotSummaryFields::kAddedEqDeleteFiles), "1");
+  EXPECT_EQ(summary.at(SnapshotSummaryFields::kAddedPosDeletes), "2");
+  EXPECT_EQ(summary.at(SnapshotSummaryFields::kAddedEqDeletes), "3");
+  EXPECT_EQ(summary.at(SnapshotSummaryFields::kAddedFileSize), "150");
+  EXPECT_EQ(summary.at(SnapshotSummaryFields::kTotalDataFiles), "2");
+  EXPECT_EQ(summary.at(SnapshotSummaryFields::kTotalDeleteFiles), "2");
+  EXPECT_EQ(summary.at(SnapshotSummaryFields::kTotalRecords), "20");
+  EXPECT_EQ(summary.at("engine-name"), "test");
+
+  // Separate data and delete manifests, both with the sequence number of the snapshot.
+  auto manifests = Manifests(*snapshot);
+  ASSERT_EQ(manifests.size(), 3);
+  EXPECT_EQ(manifests[0].content, ManifestFile::Content::kData);
+  EXPECT_EQ(manifests[0].added_files_count, 1);
+  EXPECT_EQ(manifests[1].content, ManifestFile::Content::kDeletes);
+  EXPECT_EQ(manifests[1].added_files_count, 2);
+  for (const auto& manifest : {manifests[0], manifests[1]}) {
+    EXPECT_EQ(manifest.added_snapshot_id, delta.snapshot_id());
+    EXPECT_EQ(manifest.sequence_number, 2);
+    EXPECT_EQ(manifest.min_sequence_number, 2);
+  }
+  EXPECT_EQ(manifests[2].added_snapshot_id, append.snapshot_id());
+
+  // The equality deletes only apply to the older data file.
+  EXPECT_EQ(ScanDeletes(*table),
+            (std::map<std::string, std::vector<std::string>>{
+                {"/data/a.parquet", {"/data/a-pos.parquet", "/data/eq.parquet"}},
+                {"/data/b.parquet", {}}}));
+}
+
+TEST_F(RowDeltaTest, OperationOfTheAddedFiles) {
+  ASSERT_NO_FATAL_FAILURE(RegisterTable());
+  auto table = LoadTable();
+
+  RowDelta rows(table);
+  rows.AddRows(MakeDataFile("/data/a.parquet"));
+  ASSERT_THAT(rows.Commit(), IsOk());
+  ICEBERG_UNWRAP_OR_FAIL(auto snapshot, table->current_snapshot());
+  EXPECT_EQ(snapshot->operation(), DataOperation::kAppend);
+  EXPECT_EQ(Manifests(*snapshot).size(), 1);
+
+  RowDelta deletes(table);
+  deletes.AddDeletes(MakePositionDeletes("/data/a-pos.parquet", "/data/a.parquet"));
+  ASSERT_THAT(deletes.Commit(), IsOk());
+  ICEBERG_UNWRAP_OR_FAIL(snapshot, table->current_snapshot());
+  EXPECT_EQ(snapshot->operation(), DataOperation::kDelete);
+  EXPECT_EQ(snapshot->summary.at(SnapshotSummaryFields::kTotalDataFiles), "1");
+  EXPECT_EQ(snapshot->summary.at(SnapshotSummaryFields::kTotalDeleteFiles), "1");
+  EXPECT_EQ(ScanDeletes(*table), (std::map<std::string, std::vector<std::string>>{
+                                     {"/data/a.parquet", {"/data/a-pos.parquet"}}}));
+}
+
+TEST_F(RowDeltaTest, RetryReusesManifests) {
+  ASSERT_NO_FATAL_FAILURE(RegisterTable());
+  auto table = LoadTable();
+  auto stale_table = LoadTable();
+
+  FastAppend append(table);
+  append.AppendFile(MakeDataFile("/data/a.parquet"));
+  ASSERT_THAT(append.Commit(), IsOk());
+
+  // The first attempt conflicts with the append, the retry is validated and committed
+  // on top of it with the manifests written for the first attempt.
+  RowDelta delta(stale_table);
+  delta.AddRows(MakeDataFile("/data/b.parquet"))
+      .AddDeletes(MakeEqualityDeletes("/data/eq.parquet"))
+      .ValidateNoConflictingDeleteFiles();
+  ASSERT_THAT(delta.Commit(), IsOk());
+
+  ICEBERG_UNWRAP_OR_FAIL(auto snapshot, stale_table->current_snapshot());
+  EXPECT_EQ(snapshot->parent_snapshot_id, append.snapshot_id());
+  EXPECT_EQ(snapshot->sequence_number, 2);
+  EXPECT_EQ(Manifests(*snapshot).size(), 3);
+  EXPECT_EQ(ScanDeletes(*stale_table),
+            (std::map<std::string, std::vector<std::string>>{
+                {"/data/a.parquet", {"/data/eq.parquet"}}, {"/data/b.parquet", {}}}));
+}
+
+TEST_F(RowDeltaTest, FailsWhenReferencedDataFileWasRemoved) {
+  ASSERT_NO_FATAL_FAILURE(RegisterTable());
+  auto table = LoadTable();
+  FastAppend append(table);
+  append.AppendFile(MakeDataFile("/data/a.parquet"))
+      .AppendFile(MakeDataFile("/data/b.parquet"));
+  ASSERT_THAT(append.Commit(), IsOk());
+  const int64_t starting_snapshot_id = append.snapshot_id();
+
+  // A concurrent compaction replaces a.parquet.
+  RewriteFiles rewrite(table);
+  rewrite.RemoveDataFile(MakeDataFile("/data/a.parquet"))
+      .AddDataFile(MakeDataFile("/data/c.parquet"));
+  ASSERT_THAT(rewrite.Commit(), IsOk());
+
+  RowDelta stale(table);
+  stale.ValidateFromSnapshot(starting_snapshot_id)
+      .AddDeletes(MakePositionDeletes("/data/a-pos.parquet", "/data/a.parquet"));
+  auto status = stale.Commit();
+  EXPECT_THAT(status, IsError(ErrorKind::kValidationFailed));
+  EXPECT_THAT(status, HasErrorMessage("/data/a.parquet"));
+
+  RowDelta explicit_paths(table);
+  explicit_paths.ValidateFromSnapshot(starting_snapshot_id)
+      .ValidateDataFilesExist({"/data/a.parquet"})
+      .AddDeletes(MakeEqualityDeletes("/data/eq.parquet"));
+  EXPECT_THAT(explicit_paths.Commit(), IsError(ErrorKind::kValidationFailed));
+  EXPECT_EQ(table->metadata()->current_snapshot_id, rewrite.snapshot_id());
+
+  // The files that are still in the table do not conflict.
+  RowDelta delta(table);
+  delta.ValidateFromSnapshot(starting_snapshot_id)
+      .AddDeletes(MakePositionDeletes("/data/b-pos.parquet", "/data/b.parquet"));
+  EXPECT_THAT(delta.Commit(), IsOk());
+}
+
+TEST_F(RowDeltaTest, ValidatesConcurrentFilesAgainstFilter) {
+  ASSERT_NO_FATAL_FAILURE(RegisterTable());
+  auto table = LoadTable();
+  FastAppend append(table);
+  append.AppendFile(MakeDataFile("/data/a.parquet", 0, 10));
+  ASSERT_THAT(append.Commit(), IsOk());
+  const int64_t starting_snapshot_id = append.snapshot_id();
+
+  RowDelta concurrent(table);
+  concurrent.AddRows(MakeDataFile("/data/b.parquet", 50, 60));
+  ASSERT_THAT(concurrent.Commit(), IsOk());
+
+  RowDelta disjoint(table);
+  disjoint.ValidateFromSnapshot(starting_snapshot_id)
+      .ConflictDetectionFilter(Expressions::LessThan("id", Literal::Long(5)))
+      .ValidateNoConflictingDataFiles()
+      .AddDeletes(MakeEqualityDeletes("/data/eq-1.parquet"));
+  EXPECT_THAT(disjoint.Commit(), IsOk());
+
+  // The data file committed concurrently may contain rows matching the filter.
+  RowDelta overlapping(table);
+  overlapping.ValidateFromSnapshot(starting_snapshot_id)
+      .ConflictDetectionFilter(Expressions::GreaterThan("id", Literal::Long(40)))
+      .ValidateNoConflictingDataFiles()
+      .AddDeletes(MakeEqualityDeletes("/data/eq-2.parquet"));
+  auto status = overlapping.Commit();
+  EXPECT_THAT(status, IsError(ErrorKind::kValidationFailed));
+  EXPECT_THAT(status, HasErrorMessage("/data/b.parquet"));
+
+  RowDelta deletes(table);
+  deletes.ValidateFromSnapshot(concurrent.snapshot_id())
+      .ValidateNoConflictingDataFiles()
+      .ValidateNoConflictingDeleteFiles()
+      .AddDeletes(MakeEqualityDeletes("/data/eq-3.parquet"));
+  status = deletes.Commit();
+  EXPECT_THAT(status, IsError(ErrorKind::kValidationFailed));
+  EXPECT_THAT(status, HasErrorMessage("/data/eq-1.parquet"));
+
+  RowDelta not_ancestor(table);
+  not_ancestor.ValidateFromSnapshot(12345).ValidateNoConflictingDataFiles();
+  EXPECT_THAT(not_ancestor.Commit(), HasErrorMessage("is not an ancestor"));
+}
+
+TEST_F(RowDeltaTest, InvalidFiles) {
+  ASSERT_NO_FATAL_FAILURE(RegisterTable());
+  auto table = LoadTable();
+
+  RowDelta data_as_deletes(table);
+  data_as_deletes.AddDeletes(MakeDataFile("/data/a.parquet"));
+  EXPECT_THAT(data_as_deletes.Commit(), IsError(ErrorKind::kInvalidArgument));
+
+  RowDelta deletes_as_data(table);
+  deletes_as_data.AddRows(MakeEqualityDeletes("/data/eq.parquet"));
+  EXPECT_THAT(deletes_as_data.Commit(), IsError(ErrorKind::kInvalidArgument));
+
+  auto no_ids = MakeEqualityDeletes("/data/eq.parquet");
+  no_ids->equality_ids.clear();
+  RowDelta missing_ids(table);
+  missing_ids.AddDeletes(no_ids);
+  EXPECT_THAT(missing_ids.Commit(), IsError(ErrorKind::kInvalidArgument));
+  EXPECT_EQ(table->metadata()->current_snapshot_id, Snapshot::kInvalidSnapshotId);
+}
+
+TEST_F(RowDeltaTest, DeletesRequireFormatVersion2) {
+  ASSERT_NO_FATAL_FAILURE(RegisterTable({}, /*format_version=*/1));
+  auto table = LoadTable();
+
+  RowDelta deletes(table);
+  deletes.AddDeletes(MakeEqualityDeletes("/data/eq.parquet"));
+  EXPECT_THAT(deletes.Commit(), HasErrorMessage("format version 1"));
+
+  RowDelta rows(table);
+  rows.AddRows(MakeDataFile("/data/a.parquet"));
+  EXPECT_THAT(rows.Commit(), IsOk());
+}
+
+}  // namespace iceberg
@@ -0,0 +1,150 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/scan_aggregate.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/manifest_entry.h"
+#include "iceberg/schema.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/type.h"
+#include "iceberg/util/conversions.h"
+
+namespace iceberg {
+
+class ScanAggregateTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    schema_ = std::make_shared<Schema>(
+        std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int64()),
+                                 SchemaField::MakeOptional(2, "ts", timestamp()),
+                                 SchemaField::MakeOptional(3, "data", string()),
+                                 SchemaField::MakeOptional(4, "score", float64())},
+        /*schema_id=*/0);
+  }
+
+  /// \brief Returns a data file with metrics for the id and ts columns.
+  static DataFile MakeFile(int64_t rows, int64_t min_id, int64_t max_id,
+                           int64_t ts_nulls) {
+    DataFile file;
+    file.record_count = rows;
+    file.value_counts = {{1, rows}, {2, rows}};
+    file.null_value_counts = {{2, ts_nulls}};
+    file.lower_bounds[1] = Conversions::ToBytes(Literal::Long(min_id)).value();
+    file.upper_bounds[1] = Conversions::ToBytes(Literal::Long(max_id)).value();
+    if (ts_nulls < rows) {
+      file.lower_bounds[2] = Conversions::ToBytes(Literal::Timestamp(min_id)).value();
+      file.upper_bounds[2] = Conversions::ToBytes(Literal::Timestamp(max_id)).value();
+    }
+    return file;
+  }
+
+  std::vector<AggregateValue> Aggregate(const std::vector<ScanAggregate>& aggregates,
+                                        const std::vector<DataFile>& files,
+                                        bool exact = true) {
+    auto aggregator = MetricsAggregator::Make(*schema_, aggregates);
+    EXPECT_THAT(aggregator, IsOk());
+    for (const auto& file : files) {
+      EXPECT_THAT(aggregator.value()->Add(file, exact), IsOk());
+    }
+    return aggregator.value()->Values();
+  }
+
+  std::shared_ptr<Schema> schema_;
+};
+
+TEST_F(ScanAggregateTest, CountMinMax) {
+  auto values = Aggregate(
+      {ScanAggregate::CountStar(), ScanAggregate::Count("ts"), ScanAggregate::Min("id"),
+       ScanAggregate::Max("id"), ScanAggregate::Min("ts"), ScanAggregate::Max("ts")},
+      {MakeFile(10, 5, 20, 2), MakeFile(5, 1, 8, 5), MakeFile(3, 30, 40, 0)});
+  ASSERT_EQ(values.size(), 6);
+  EXPECT_EQ(values[0].value, Literal::Long(18));
+  EXPECT_EQ(values[1].value, Literal::Long(11));
+  EXPECT_EQ(values[2].value, Literal::Long(1));
+  EXPECT_EQ(values[3].value, Literal::Long(40));
+  // The file whose ts values are all null has no ts bounds.
+  EXPECT_EQ(values[4].value, Literal::Timestamp(5));
+  EXPECT_EQ(values[5].value, Literal::Timestamp(40));
+  for (const auto& value : values) {
+    EXPECT_TRUE(value.exact);
+  }
+}
+
+TEST_F(ScanAggregateTest, NoFiles) {
+  auto values = Aggregate({ScanAggregate::CountStar(), ScanAggregate::Max("ts")}, {});
+  ASSERT_EQ(values.size(), 2);
+  EXPECT_EQ(values[0].value, Literal::Long(0));
+  ASSERT_TRUE(values[1].value.has_value());
+  EXPECT_TRUE(values[1].value->IsNull());
+  EXPECT_TRUE(values[1].exact);
+}
+
+TEST_F(ScanAggregateTest, InexactValues) {
+  // Rows of the files may be deleted or filtered out.
+  auto values = Aggregate({ScanAggregate::CountStar(), ScanAggregate::Min("id")},
+                          {MakeFile(10, 5, 20, 0)}, /*exact=*/false);
+  EXPECT_EQ(values[0].value, Literal::Long(10));
+  EXPECT_FALSE(values[0].exact);
+  EXPECT_EQ(values[1].value, Literal::Long(5));
+  EXPECT_FALSE(values[1].exact);
+
+  // String bounds may be truncated, and floating-point bounds do not cover NaN.
+  auto file = MakeFile(10, 5, 20, 0);
+  file.value_counts[3] = 10;
+  file.null_value_counts[3] = 0;
+  file.lower_bounds[3] = Conversions::ToBytes(Literal::String("a")).value();
+  file.value_counts[4] = 10;
+  file.null_value_counts[4] = 0;
+  file.nan_value_counts[4] = 1;
+  file.upper_bounds[4] = Conversions::ToBytes(Literal::Double(1.5)).value();
+  values = Aggregate({ScanAggregate::Min("data"), ScanAggregate::Max("score"),
+                      ScanAggregate::Count("data")},
+                     {file});
+  EXPECT_EQ(values[0].value, Literal::String("a"));
+  EXPECT_FALSE(values[0].exact);
+  EXPECT_EQ(values[1].value, Literal::Double(1.5));
+  EXPECT_FALSE(values[1].exact);
+  EXPECT_EQ(values[2].value, Literal::Long(10));
+  EXPECT_TRUE(values[2].exact);
+}
+
+TEST_F(ScanAggregateTest, MissingMetrics) {
+  DataFile file;
+  file.record_count = 10;
+  auto values = Aggregate({ScanAggregate::CountStar(), ScanAggregate::Count("ts"),
+                           ScanAggregate::Max("id")},
+                          {MakeFile(5, 1, 2, 0), file});
+  EXPECT_EQ(values[0].value, Literal::Long(15));
+  EXPECT_FALSE(values[1].value.has_value());
+  EXPECT_FALSE(values[2].value.has_value());
+}
+
+TEST_F(ScanAggregateTest, InvalidColumns) {
+  EXPECT_THAT(MetricsAggregator::Make(*schema_, {ScanAggregate::Min("missing")}),
+              IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(MetricsAggregator::Make(*schema_, {ScanAggregate::Count("ID")},
+                                      /*case_sensitive=*/false),
+              IsOk());
+}
+
+}  // namespace iceberg
@@ -0,0 +1,81 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/scan_plan_cache.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/test/matchers.h"
+
+namespace iceberg {
+
+TEST(ScanPlanCacheTest, InvalidCapacity) {
+  EXPECT_THAT(ScanPlanCache::Make(0), IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(ScanPlanCache::Make(-1), IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST(ScanPlanCacheTest, CachePlans) {
+  auto cache = ScanPlanCache::Make(1 << 20).value();
+  EXPECT_EQ(cache->Get("a"), nullptr);
+
+  cache->Put("a", {1, 2, 3});
+  auto plan = cache->Get("a");
+  ASSERT_NE(plan, nullptr);
+  EXPECT_EQ(*plan, (std::vector<uint8_t>{1, 2, 3}));
+
+  // Putting a key again replaces its plan.
+  cache->Put("a", {4});
+  EXPECT_EQ(*cache->Get("a"), std::vector<uint8_t>{4});
+
+  auto stats = cache->stats();
+  EXPECT_EQ(stats.hits, 2);
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.plan_count, 1);
+  EXPECT_EQ(stats.size_bytes, 2);
+
+  cache->Clear();
+  EXPECT_EQ(cache->Get("a"), nullptr);
+  EXPECT_EQ(cache->stats().plan_count, 0);
+  EXPECT_EQ(cache->stats().size_bytes, 0);
+}
+
+TEST(ScanPlanCacheTest, EvictsLeastRecentlyUsed) {
+  // Each plan takes 10 bytes with its key.
+  auto cache = ScanPlanCache::Make(25).value();
+  cache->Put("a", std::vector<uint8_t>(9));
+  cache->Put("b", std::vector<uint8_t>(9));
+  ASSERT_NE(cache->Get("a"), nullptr);
+  cache->Put("c", std::vector<uint8_t>(9));
+
+  EXPECT_NE(cache->Get("a"), nullptr);
+  EXPECT_EQ(cache->Get("b"), nullptr);
+  EXPECT_NE(cache->Get("c"), nullptr);
+  EXPECT_EQ(cache->stats().evictions, 1);
+  EXPECT_EQ(cache->stats().size_bytes, 20);
+
+  // Plans larger than the capacity are not cached.
+  cache->Put("d", std::vector<uint8_t>(25));
+  EXPECT_EQ(cache->Get("d"), nullptr);
+  EXPECT_EQ(cache->stats().plan_count, 2);
+}
+
+}  // namespace iceberg
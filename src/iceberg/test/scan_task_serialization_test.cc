@@ -0,0 +1,292 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/scan_task_serialization.h"
+
+#include <format>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/expression/binder.h"
+#include "iceberg/expression/expressions.h"
+#include "iceberg/expression/predicate.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/schema.h"
+#include "iceberg/table_scan.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+class ScanTaskSerializationTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    schema_ = std::make_shared<Schema>(
+        std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int64()),
+                                 SchemaField::MakeOptional(2, "region", string()),
+                                 SchemaField::MakeOptional(3, "price", decimal(9, 2))},
+        /*schema_id=*/3);
+  }
+
+  std::shared_ptr<DataFile> MakeFile(const std::string& path, Literal region) {
+    auto file = std::make_shared<DataFile>();
+    file->file_path = path;
+    file->partition = {std::move(region), Literal::Int(7)};
+    file->partition_spec_id = 1;
+    file->record_count = 100;
+    file->file_size_in_bytes = 4096;
+    file->value_counts = {{1, 100}, {2, 90}};
+    file->lower_bounds = {{1, Literal::Long(-5).Serialize().value()}};
+    file->upper_bounds = {{1, Literal::Long(500).Serialize().value()}};
+    file->split_offsets = {4, 2048};
+    file->sort_order_id = 0;
+    return file;
+  }
+
+  /// \brief Expects the files to be equal, including their null partition values,
+  /// which do not compare equal to each other.
+  static void ExpectSameFile(const DataFile& actual, const DataFile& expected) {
+    ASSERT_EQ(actual.partition.size(), expected.partition.size());
+    for (size_t i = 0; i < actual.partition.size(); ++i) {
+      EXPECT_EQ(actual.partition[i].IsNull(), expected.partition[i].IsNull());
+      if (!expected.partition[i].IsNull()) {
+        EXPECT_EQ(actual.partition[i], expected.partition[i]);
+      }
+      EXPECT_EQ(actual.partition[i].type()->type_id(),
+                expected.partition[i].type()->type_id());
+    }
+    DataFile actual_rest = actual;
+    DataFile expected_rest = expected;
+    actual_rest.partition.clear();
+    expected_rest.partition.clear();
+    EXPECT_EQ(actual_rest, expected_rest);
+  }
+
+  std::shared_ptr<Expression> Bind(const std::shared_ptr<Expression>& expr) {
+    auto bound = Binder::Bind(*schema_, expr, /*case_sensitive=*/true);
+    EXPECT_THAT(bound, IsOk());
+    return bound.value();
+  }
+
+  std::shared_ptr<Schema> schema_;
+};
+
+TEST_F(ScanTaskSerializationTest, RoundTrip) {
+  auto deletes = std::make_shared<DataFile>();
+  deletes->content = DataFile::Content::kPositionDeletes;
+  deletes->file_path = "deletes.puffin";
+  deletes->file_format = FileFormatType::kPuffin;
+  deletes->partition = {Literal::String("eu"), Literal::Int(7)};
+  deletes->partition_spec_id = 1;
+  deletes->referenced_data_file = "data-0.parquet";
+  deletes->content_offset = 4;
+  deletes->content_size_in_bytes = 40;
+
+  auto residual = Bind(Expressions::And(
+      Expressions::Or(Expressions::GreaterThan("id", Literal::Long(7)),
+                      Expressions::IsNull("region")),
+      Expressions::Not(Expressions::In(
+          "price", {Literal::Decimal(150, 9, 2), Literal::Decimal(-3, 9, 2)}))));
+  auto first = std::make_shared<FileScanTask>(
+      MakeFile("data-0.parquet", Literal::String("eu")), std::vector{deletes},
+      /*delete_loader=*/nullptr, residual);
+  auto second = std::make_shared<FileScanTask>(
+      MakeFile("data-1.parquet", Literal::String("eu")), std::vector{deletes});
+  second = second->Slice(2048, 2048);
+  auto third = std::make_shared<FileScanTask>(
+      MakeFile("data-2.parquet", Literal::Null(string())),
+      std::vector<std::shared_ptr<DataFile>>{}, /*delete_loader=*/nullptr,
+      /*residual=*/nullptr, /*memory_pool=*/nullptr, /*executor=*/nullptr,
+      /*io_executor=*/nullptr, /*projected_file_size=*/512);
+  third = third->SampleRowGroups({.fraction = 0.3, .seed = 11});
+
+  ScanTaskBatch batch{
+      .schema = schema_,
+      .projected_schema = schema_,
+      .tasks = {std::make_shared<CombinedScanTask>(std::vector{first, second}),
+                std::make_shared<CombinedScanTask>(std::vector{third})}};
+  ICEBERG_UNWRAP_OR_FAIL(auto data, SerializeScanTasks(batch));
+  ICEBERG_UNWRAP_OR_FAIL(auto restored, DeserializeScanTasks(data));
+
+  ASSERT_NE(restored.schema, nullptr);
+  EXPECT_EQ(*restored.schema, *schema_);
+  EXPECT_EQ(restored.schema->schema_id(), 3);
+  // The projected schema is the table schema, so it is written once.
+  EXPECT_EQ(restored.projected_schema, restored.schema);
+
+  ASSERT_EQ(restored.tasks.size(), 2);
+  ASSERT_EQ(restored.tasks[0]->tasks().size(), 2);
+  ASSERT_EQ(restored.tasks[1]->tasks().size(), 1);
+  std::vector<std::shared_ptr<FileScanTask>> expected = {first, second, third};
+  std::vector<std::shared_ptr<FileScanTask>> actual = {restored.tasks[0]->tasks()[0],
+                                                       restored.tasks[0]->tasks()[1],
+                                                       restored.tasks[1]->tasks()[0]};
+  for (size_t i = 0; i < expected.size(); ++i) {
+    ExpectSameFile(*actual[i]->data_file(), *expected[i]->data_file());
+    EXPECT_EQ(actual[i]->start(), expected[i]->start());
+    EXPECT_EQ(actual[i]->length(), expected[i]->length());
+    EXPECT_EQ(actual[i]->projected_file_size(), expected[i]->projected_file_size());
+    ASSERT_EQ(actual[i]->row_group_sample().has_value(),
+              expected[i]->row_group_sample().has_value());
+    if (expected[i]->row_group_sample().has_value()) {
+      EXPECT_EQ(actual[i]->row_group_sample()->fraction,
+                expected[i]->row_group_sample()->fraction);
+      EXPECT_EQ(actual[i]->row_group_sample()->seed,
+                expected[i]->row_group_sample()->seed);
+    }
+    ASSERT_EQ(actual[i]->delete_files().size(), expected[i]->delete_files().size());
+    for (const auto& delete_file : actual[i]->delete_files()) {
+      EXPECT_EQ(*delete_file, *deletes);
+    }
+  }
+  // The tasks sharing a delete file share the restored file.
+  EXPECT_EQ(actual[0]->delete_files()[0], actual[1]->delete_files()[0]);
+
+  // The residual is restored bound to the restored schema.
+  const auto& restored_residual = actual[0]->residual();
+  ASSERT_NE(restored_residual, nullptr);
+  ASSERT_EQ(restored_residual->op(), Expression::Operation::kAnd);
+  const auto& conjunction = static_cast<const And&>(*restored_residual);
+  ASSERT_EQ(conjunction.left()->op(), Expression::Operation::kOr);
+  const auto& disjunction = static_cast<const Or&>(*conjunction.left());
+  auto greater = std::dynamic_pointer_cast<BoundLiteralPredicate>(disjunction.left());
+  ASSERT_NE(greater, nullptr);
+  EXPECT_EQ(greater->op(), Expression::Operation::kGt);
+  EXPECT_EQ(greater->reference()->field().field_id(), 1);
+  EXPECT_EQ(greater->literal(), Literal::Long(7));
+  auto is_null = std::dynamic_pointer_cast<BoundUnaryPredicate>(disjunction.right());
+  ASSERT_NE(is_null, nullptr);
+  EXPECT_EQ(is_null->op(), Expression::Operation::kIsNull);
+  EXPECT_EQ(is_null->reference()->field().field_id(), 2);
+  // Binding rewrote the negated set predicate to NotIn.
+  auto not_in = std::dynamic_pointer_cast<BoundSetPredicate>(conjunction.right());
+  ASSERT_NE(not_in, nullptr);
+  EXPECT_EQ(not_in->op(), Expression::Operation::kNotIn);
+  EXPECT_EQ(not_in->reference()->field().field_id(), 3);
+  EXPECT_EQ(not_in->literal_set().size(), 2);
+  ICEBERG_UNWRAP_OR_FAIL(auto matches,
+                         not_in->Test(Literal::Decimal(150, 9, 2).value()));
+  EXPECT_FALSE(matches);
+  ICEBERG_UNWRAP_OR_FAIL(matches, not_in->Test(Literal::Decimal(151, 9, 2).value()));
+  EXPECT_TRUE(matches);
+  EXPECT_EQ(actual[1]->residual(), nullptr);
+}
+
+TEST_F(ScanTaskSerializationTest, PartitionsWrittenOnce) {
+  const std::string region = "a-partition-value-shared-by-the-files";
+  std::vector<std::shared_ptr<FileScanTask>> tasks;
+  for (int32_t i = 0; i < 3; ++i) {
+    tasks.push_back(std::make_shared<FileScanTask>(
+        MakeFile(std::format("data-{}.parquet", i), Literal::String(region))));
+  }
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto data, SerializeScanTasks(ScanTaskBatch{
+                     .tasks = {std::make_shared<CombinedScanTask>(tasks)}}));
+  std::string_view text(reinterpret_cast<const char*>(data.data()), data.size());
+  EXPECT_NE(text.find(region), std::string_view::npos);
+  EXPECT_EQ(text.find(region), text.rfind(region));
+
+  ICEBERG_UNWRAP_OR_FAIL(auto restored, DeserializeScanTasks(data));
+  ASSERT_EQ(restored.tasks.size(), 1);
+  ASSERT_EQ(restored.tasks[0]->tasks().size(), 3);
+  for (const auto& task : restored.tasks[0]->tasks()) {
+    EXPECT_EQ(task->data_file()->partition[0], Literal::String(region));
+  }
+}
+
+TEST_F(ScanTaskSerializationTest, InvalidBatches) {
+  auto residual = Bind(Expressions::Equal("id", Literal::Long(1)));
+  ScanTaskBatch batch{.tasks = {std::make_shared<CombinedScanTask>(
+                          std::vector{std::make_shared<FileScanTask>(
+                              MakeFile("data.parquet", Literal::String("eu")),
+                              std::vector<std::shared_ptr<DataFile>>{},
+                              /*delete_loader=*/nullptr, residual)})}};
+  // Residuals are restored against the table schema.
+  EXPECT_THAT(SerializeScanTasks(batch), IsError(ErrorKind::kInvalidArgument));
+
+  batch.schema = schema_;
+  ICEBERG_UNWRAP_OR_FAIL(auto data, SerializeScanTasks(batch));
+  EXPECT_THAT(DeserializeScanTasks(data), IsOk());
+  EXPECT_THAT(DeserializeScanTasks(std::span(data).first(data.size() - 1)),
+              IsError(ErrorKind::kInvalid));
+  auto corrupted = data;
+  corrupted[1] = 'X';
+  EXPECT_THAT(DeserializeScanTasks(corrupted), IsError(ErrorKind::kInvalid));
+  auto newer = data;
+  newer[4] = 2;
+  EXPECT_THAT(DeserializeScanTasks(newer), IsError(ErrorKind::kNotSupported));
+
+  auto changelog = std::make_shared<ChangelogScanTask>(
+      MakeFile("data.parquet", Literal::String("eu")), ChangelogOperation::kInsert,
+      /*change_ordinal=*/0, /*commit_snapshot_id=*/1);
+  EXPECT_THAT(SerializeScanTasks(ScanTaskBatch{
+                  .tasks = {std::make_shared<CombinedScanTask>(
+                      std::vector<std::shared_ptr<FileScanTask>>{changelog})}}),
+              IsError(ErrorKind::kNotSupported));
+}
+
+TEST_F(ScanTaskSerializationTest, ManifestShardRoundTrip) {
+  ManifestFile data_manifest{
+      .manifest_path = "s3://bucket/metadata/data.avro",
+      .manifest_length = 8192,
+      .partition_spec_id = 1,
+      .sequence_number = 4,
+      .min_sequence_number = 2,
+      .added_snapshot_id = 42,
+      .added_files_count = 3,
+      .existing_files_count = 0,
+      .added_rows_count = 300,
+      .partitions = {PartitionFieldSummary{
+                         .contains_null = false,
+                         .contains_nan = true,
+                         .lower_bound = Literal::String("eu").Serialize().value(),
+                         .upper_bound = Literal::String("us").Serialize().value()},
+                     PartitionFieldSummary{}},
+      .key_metadata = {1, 2, 3},
+      .first_row_id = 1000,
+  };
+  ManifestFile delete_manifest{
+      .manifest_path = "s3://bucket/metadata/deletes.avro",
+      .manifest_length = 1024,
+      .content = ManifestFile::Content::kDeletes,
+      .added_snapshot_id = 41,
+  };
+  ManifestShard shard{.snapshot_id = 42,
+                      .data_manifests = {data_manifest, data_manifest},
+                      .delete_manifests = {delete_manifest}};
+  shard.data_manifests[1].manifest_path = "s3://bucket/metadata/other.avro";
+
+  ICEBERG_UNWRAP_OR_FAIL(auto data, SerializeManifestShard(shard));
+  ICEBERG_UNWRAP_OR_FAIL(auto restored, DeserializeManifestShard(data));
+  EXPECT_EQ(restored.snapshot_id, 42);
+  EXPECT_EQ(restored.data_manifests, shard.data_manifests);
+  EXPECT_EQ(restored.delete_manifests, shard.delete_manifests);
+
+  EXPECT_THAT(DeserializeManifestShard(std::span(data).first(data.size() - 1)),
+              IsError(ErrorKind::kInvalid));
+  ICEBERG_UNWRAP_OR_FAIL(auto tasks, SerializeScanTasks(ScanTaskBatch{}));
+  EXPECT_THAT(DeserializeManifestShard(tasks), IsError(ErrorKind::kInvalid));
+}
+
+}  // namespace iceberg
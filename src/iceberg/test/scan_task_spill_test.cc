@@ -0,0 +1,121 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/scan_task_spill.h"
+
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/manifest_entry.h"
+#include "iceberg/schema.h"
+#include "iceberg/table_scan.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/test/temp_file_test_base.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+class ScanTaskSpillTest : public TempFileTestBase {
+ protected:
+  void SetUp() override {
+    TempFileTestBase::SetUp();
+    directory_ = CreateTempDirectory() + "/spill";
+  }
+
+  static std::shared_ptr<CombinedScanTask> MakeTask(int index) {
+    auto file = std::make_shared<DataFile>();
+    file->file_path = std::format("data-{}.parquet", index);
+    file->record_count = 10;
+    file->file_size_in_bytes = 1024;
+    return std::make_shared<CombinedScanTask>(
+        std::vector{std::make_shared<FileScanTask>(std::move(file))});
+  }
+
+  static std::vector<std::string> Paths(const ScanTaskSpill& spill) {
+    std::vector<std::string> paths;
+    EXPECT_THAT(spill.ForEach([&](std::shared_ptr<CombinedScanTask> task) -> Status {
+      for (const auto& file_task : task->tasks()) {
+        paths.push_back(file_task->data_file()->file_path);
+      }
+      return {};
+    }),
+                IsOk());
+    return paths;
+  }
+
+  std::string directory_;
+  std::shared_ptr<Schema> schema_ = std::make_shared<Schema>(
+      std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int64())},
+      /*schema_id=*/0);
+};
+
+TEST_F(ScanTaskSpillTest, InvalidBudget) {
+  EXPECT_THAT(ScanTaskSpill::Make({.directory = directory_}, schema_, schema_),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(ScanTaskSpillTest, KeepsTasksWithinBudget) {
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto spill, ScanTaskSpill::Make({.directory = directory_,
+                                       .memory_budget_bytes = 1 << 20},
+                                      schema_, schema_));
+  ASSERT_THAT(spill->Add(MakeTask(0)), IsOk());
+  EXPECT_EQ(spill->spilled_bytes(), 0);
+  EXPECT_GT(spill->buffered_bytes(), 0);
+  EXPECT_EQ(Paths(*spill), std::vector<std::string>{"data-0.parquet"});
+  EXPECT_FALSE(std::filesystem::exists(directory_));
+}
+
+TEST_F(ScanTaskSpillTest, SpillsBeyondBudget) {
+  std::vector<std::string> expected;
+  {
+    ICEBERG_UNWRAP_OR_FAIL(
+        auto spill, ScanTaskSpill::Make({.directory = directory_,
+                                         .memory_budget_bytes = 1000},
+                                        schema_, schema_));
+    for (int i = 0; i < 20; ++i) {
+      ASSERT_THAT(spill->Add(MakeTask(i)), IsOk());
+      expected.push_back(std::format("data-{}.parquet", i));
+    }
+    EXPECT_EQ(spill->task_count(), 20);
+    EXPECT_GT(spill->spilled_bytes(), 0);
+    EXPECT_LE(spill->buffered_bytes(), 1000);
+    EXPECT_EQ(Paths(*spill), expected);
+    // Tasks can be read back more than once.
+    EXPECT_EQ(Paths(*spill), expected);
+
+    // An error of the callback stops the iteration.
+    int calls = 0;
+    EXPECT_THAT(spill->ForEach([&](std::shared_ptr<CombinedScanTask>) -> Status {
+      ++calls;
+      return Invalid("stop");
+    }),
+                IsError(ErrorKind::kInvalid));
+    EXPECT_EQ(calls, 1);
+  }
+  // The spill file is removed with the spill.
+  EXPECT_TRUE(std::filesystem::is_empty(directory_));
+}
+
+}  // namespace iceberg
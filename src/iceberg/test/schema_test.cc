@@ -19,8 +19,11 @@
 
 #include "iceberg/schema.h"
 
+#include <format>
 #include <memory>
+#include <string_view>
 #include <thread>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -246,6 +249,22 @@ TEST_F(ComplexShortNameTest, TestFindById) {
   ASSERT_THAT(schema_->FindFieldById(0), ::testing::Optional(std::nullopt));
 }
 
+TEST_F(ComplexShortNameTest, TestFindColumnNameAndParentId) {
+  using ::testing::Optional;
+  ASSERT_THAT(schema_->FindColumnName(9), Optional(Optional(std::string_view("Map"))));
+  ASSERT_THAT(schema_->FindColumnName(5),
+              Optional(Optional(std::string_view("Map.value.First_child"))));
+  ASSERT_THAT(
+      schema_->FindColumnName(2),
+      Optional(Optional(std::string_view("Map.value.Second_child.element.Bar"))));
+  ASSERT_THAT(schema_->FindColumnName(10), Optional(std::nullopt));
+
+  ASSERT_THAT(schema_->FindParentId(9), Optional(std::nullopt));
+  ASSERT_THAT(schema_->FindParentId(8), Optional(Optional(9)));
+  ASSERT_THAT(schema_->FindParentId(4), Optional(Optional(6)));
+  ASSERT_THAT(schema_->FindParentId(2), Optional(Optional(4)));
+}
+
 TEST_F(ComplexShortNameTest, TestFindByName) {
   ASSERT_THAT(schema_->FindFieldByName("Map"), ::testing::Optional(*field9_));
   ASSERT_THAT(schema_->FindFieldByName("Map.value"), ::testing::Optional(*field8_));
@@ -444,6 +463,25 @@ TEST_F(ComplexMapStructShortNameTest, TestInvalidPaths) {
               ::testing::Optional(std::nullopt));
 }
 
+TEST(SchemaTest, FindFieldWithSparseIds) {
+  // Ids too sparse for a direct lookup table.
+  std::vector<iceberg::SchemaField> fields;
+  for (int32_t i = 0; i < 100; ++i) {
+    fields.emplace_back(i * 100000 + 7, std::format("f{}", i), iceberg::int64(), true);
+  }
+  iceberg::Schema schema(fields, 1);
+
+  for (const auto& field : fields) {
+    ASSERT_THAT(schema.FindFieldById(field.field_id()), ::testing::Optional(field));
+    ASSERT_THAT(schema.FindFieldByName(field.name()), ::testing::Optional(field));
+  }
+  ASSERT_THAT(schema.FindFieldById(8), ::testing::Optional(std::nullopt));
+  ASSERT_THAT(schema.FindFieldById(-1), ::testing::Optional(std::nullopt));
+  ASSERT_THAT(schema.FindFieldByName("F42", /*case_sensitive=*/false),
+              ::testing::Optional(fields[42]));
+  ASSERT_THAT(schema.FindFieldByName("f100"), ::testing::Optional(std::nullopt));
+}
+
 TEST(SchemaTest, DuplicatePathErrorCaseSensitive) {
   auto nested_b = std::make_unique<iceberg::SchemaField>(2, "b", iceberg::int32(), false);
   auto nested_struct =
@@ -943,6 +981,38 @@ INSTANTIATE_TEST_SUITE_P(
                          .expected_schema = []() { return MakeSchema(); },
                          .should_succeed = true}));
 
+TEST(SchemaTest, SelectFieldIds) {
+  auto schema = NestedUserSchema();
+
+  // A nested field is selected with its parents only.
+  std::vector<int32_t> city_ids = {12, 1};
+  ICEBERG_UNWRAP_OR_FAIL(auto city, schema->SelectFieldIds(city_ids));
+  auto expected_user = iceberg::SchemaField{
+      17, "user",
+      MakeStructType(iceberg::SchemaField{16, "address", MakeStructType(City()), true}),
+      true};
+  EXPECT_EQ(*city, *MakeSchema(Id(), expected_user));
+
+  // A struct is selected with all of its children.
+  std::vector<int32_t> address_ids = {16};
+  ICEBERG_UNWRAP_OR_FAIL(auto address, schema->SelectFieldIds(address_ids));
+  auto expected_address_user = iceberg::SchemaField{
+      17, "user",
+      MakeStructType(iceberg::SchemaField{16, "address",
+                                          MakeStructType(Street(), City()), true}),
+      true};
+  EXPECT_EQ(*address, *MakeSchema(expected_address_user));
+
+  // The same set of ids, in any order or with duplicates, reuses the projection.
+  std::vector<int32_t> reordered_ids = {1, 12, 12};
+  ICEBERG_UNWRAP_OR_FAIL(auto cached, schema->SelectFieldIds(reordered_ids));
+  EXPECT_EQ(cached.get(), city.get());
+
+  std::vector<int32_t> missing_ids = {999};
+  ICEBERG_UNWRAP_OR_FAIL(auto empty, schema->SelectFieldIds(missing_ids));
+  EXPECT_EQ(*empty, *MakeSchema());
+}
+
 class SchemaThreadSafetyTest : public ::testing::Test {
  protected:
   void SetUp() override {
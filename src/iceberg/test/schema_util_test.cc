@@ -24,6 +24,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "iceberg/expression/literal.h"
 #include "iceberg/metadata_columns.h"
 #include "iceberg/schema.h"
 #include "iceberg/schema_field.h"
@@ -179,6 +180,39 @@ TEST(SchemaUtilTest, ProjectMissingRequiredField) {
   ASSERT_THAT(projection_result, HasErrorMessage("Missing required field"));
 }
 
+TEST(SchemaUtilTest, ProjectWithConstants) {
+  Schema source_schema = CreateFlatSchema();
+  Schema expected_schema({
+      SchemaField::MakeRequired(/*field_id=*/1, "id", iceberg::int64()),
+      SchemaField::MakeOptional(/*field_id=*/2, "name", iceberg::string()),
+      SchemaField::MakeRequired(/*field_id=*/10, "extra", iceberg::string()),
+      SchemaField::MakeRequired(/*field_id=*/4, "data", iceberg::float64()),
+  });
+  auto project = [&](const Schema& schema) {
+    return Project(schema, source_schema, /*prune_source=*/true);
+  };
+
+  // The constant field is not read, and the missing required field takes its default.
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto projection,
+      ProjectWithConstants(expected_schema, {{2, Literal::String("eu")}},
+                           {{10, Literal::String("x")}, {4, Literal::Double(1.0)}},
+                           project));
+  ASSERT_EQ(projection.fields.size(), 4);
+  AssertProjectedField(projection.fields[0], 0);
+  ASSERT_EQ(projection.fields[1].kind, FieldProjection::Kind::kConstant);
+  EXPECT_EQ(std::get<Literal>(projection.fields[1].from), Literal::String("eu"));
+  ASSERT_EQ(projection.fields[2].kind, FieldProjection::Kind::kDefault);
+  EXPECT_EQ(std::get<Literal>(projection.fields[2].from), Literal::String("x"));
+  // Fields in the source are read rather than defaulted.
+  AssertProjectedField(projection.fields[3], 1);
+
+  EXPECT_THAT(ProjectWithConstants(expected_schema, {{2, Literal::Int(1)}}, {}, project),
+              IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(ProjectWithConstants(expected_schema, {}, {}, project),
+              IsError(ErrorKind::kInvalidSchema));
+}
+
 TEST(SchemaUtilTest, ProjectMetadataColumn) {
   Schema source_schema = CreateFlatSchema();
   Schema expected_schema({
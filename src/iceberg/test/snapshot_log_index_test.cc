@@ -0,0 +1,120 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/snapshot_log_index.h"
+
+#include <format>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/table_scan.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+namespace {
+
+TimePointMs Ms(int64_t unix_ms) { return TimePointMsFromUnixMs(unix_ms).value(); }
+
+// A table whose current snapshot changed at the given times, to snapshots 1, 2, ...
+std::shared_ptr<TableMetadata> MakeMetadata(const std::vector<int64_t>& log_times) {
+  auto metadata = std::make_shared<TableMetadata>(TableMetadata{
+      .format_version = 2,
+      .schemas = {std::make_shared<Schema>(
+          std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int64())},
+          /*schema_id=*/0)},
+      .current_schema_id = 0,
+  });
+  for (size_t i = 0; i < log_times.size(); ++i) {
+    const auto snapshot_id = static_cast<int64_t>(i + 1);
+    metadata->snapshots.push_back(std::make_shared<Snapshot>(Snapshot{
+        .snapshot_id = snapshot_id,
+        .sequence_number = snapshot_id,
+        .timestamp_ms = Ms(log_times[i]),
+        .manifest_list = std::format("snap-{}.avro", snapshot_id),
+        .schema_id = 0,
+    }));
+    metadata->snapshot_log.push_back(
+        {.timestamp_ms = Ms(log_times[i]), .snapshot_id = snapshot_id});
+  }
+  metadata->current_snapshot_id = static_cast<int64_t>(log_times.size());
+  return metadata;
+}
+
+}  // namespace
+
+TEST(SnapshotLogIndexTest, SnapshotIdAsOf) {
+  auto metadata = MakeMetadata({100, 200, 300});
+  SnapshotLogIndex index(*metadata);
+  EXPECT_EQ(index.SnapshotIdAsOf(Ms(99)), std::nullopt);
+  EXPECT_EQ(index.SnapshotIdAsOf(Ms(100)), 1);
+  EXPECT_EQ(index.SnapshotIdAsOf(Ms(250)), 2);
+  EXPECT_EQ(index.SnapshotIdAsOf(Ms(300)), 3);
+  EXPECT_EQ(index.SnapshotIdAsOf(Ms(1000)), 3);
+
+  EXPECT_EQ(SnapshotLogIndex(*MakeMetadata({})).SnapshotIdAsOf(Ms(1000)), std::nullopt);
+}
+
+TEST(SnapshotLogIndexTest, ClockSkew) {
+  // The third change was logged with a clock behind the one of the second.
+  SnapshotLogIndex index(*MakeMetadata({100, 200, 150, 300}));
+  EXPECT_EQ(index.SnapshotIdAsOf(Ms(120)), 1);
+  EXPECT_EQ(index.SnapshotIdAsOf(Ms(160)), 3);
+  EXPECT_EQ(index.SnapshotIdAsOf(Ms(250)), 3);
+  EXPECT_EQ(index.SnapshotIdAsOf(Ms(300)), 4);
+}
+
+TEST(SnapshotLogIndexTest, TableScanAsOfTimeAndRef) {
+  auto metadata = MakeMetadata({100, 200, 300});
+  metadata->refs["main"] = std::make_shared<SnapshotRef>(
+      SnapshotRef{.snapshot_id = 3, .retention = SnapshotRef::Branch{}});
+  metadata->refs["audit"] = std::make_shared<SnapshotRef>(
+      SnapshotRef{.snapshot_id = 1, .retention = SnapshotRef::Tag{}});
+
+  ICEBERG_UNWRAP_OR_FAIL(auto as_of,
+                         TableScanBuilder(metadata, nullptr).AsOfTime(Ms(250)).Build());
+  EXPECT_EQ(as_of->snapshot()->snapshot_id, 2);
+
+  auto index = std::make_shared<SnapshotLogIndex>(*metadata);
+  ICEBERG_UNWRAP_OR_FAIL(auto indexed, TableScanBuilder(metadata, nullptr)
+                                           .WithSnapshotLogIndex(index)
+                                           .AsOfTime(Ms(100))
+                                           .Build());
+  EXPECT_EQ(indexed->snapshot()->snapshot_id, 1);
+
+  ICEBERG_UNWRAP_OR_FAIL(auto tag,
+                         TableScanBuilder(metadata, nullptr).UseRef("audit").Build());
+  EXPECT_EQ(tag->snapshot()->snapshot_id, 1);
+
+  EXPECT_THAT(TableScanBuilder(metadata, nullptr).AsOfTime(Ms(50)).Build(),
+              IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(TableScanBuilder(metadata, nullptr).UseRef("missing").Build(),
+              IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(
+      TableScanBuilder(metadata, nullptr).UseRef("main").WithSnapshotId(1).Build(),
+      IsError(ErrorKind::kInvalidArgument));
+}
+
+}  // namespace iceberg
@@ -0,0 +1,153 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/sorted_bounds_index.h"
+
+#include <memory>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/expression/expressions.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/schema.h"
+#include "iceberg/sort_order.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/transform.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+class SortedBoundsIndexTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    schema_ = std::make_shared<Schema>(
+        std::vector<SchemaField>{SchemaField::MakeRequired(1, "ts", int64()),
+                                 SchemaField::MakeOptional(2, "data", string())},
+        /*schema_id=*/0);
+    sort_order_ = std::make_shared<SortOrder>(
+        1, std::vector<SortField>{SortField(1, Transform::Identity(),
+                                            SortDirection::kAscending,
+                                            NullOrder::kFirst)});
+  }
+
+  static ManifestEntry Entry(std::vector<Literal> partition, int64_t lower,
+                             int64_t upper) {
+    auto data_file = std::make_shared<DataFile>();
+    data_file->record_count = 10;
+    data_file->partition = std::move(partition);
+    data_file->lower_bounds = {{1, Literal::Long(lower).Serialize().value()}};
+    data_file->upper_bounds = {{1, Literal::Long(upper).Serialize().value()}};
+    return ManifestEntry{.status = ManifestStatus::kAdded,
+                         .data_file = std::move(data_file)};
+  }
+
+  std::vector<bool> RuledOut(const std::shared_ptr<Expression>& expr,
+                             const std::vector<ManifestEntry>& entries) {
+    auto index = SortedBoundsIndex::Make(*sort_order_, expr, *schema_);
+    EXPECT_THAT(index, IsOk());
+    EXPECT_NE(index.value(), nullptr);
+    auto ruled_out = index.value()->RuledOut(entries);
+    EXPECT_THAT(ruled_out, IsOk());
+    return ruled_out.value();
+  }
+
+  std::shared_ptr<Schema> schema_;
+  std::shared_ptr<SortOrder> sort_order_;
+};
+
+TEST_F(SortedBoundsIndexTest, PointAndRangeLookups) {
+  // Files of one partition listed out of order, with bounds that only touch.
+  std::vector<ManifestEntry> entries = {Entry({}, 20, 29), Entry({}, 0, 9),
+                                        Entry({}, 30, 39), Entry({}, 10, 20)};
+
+  EXPECT_THAT(RuledOut(Expressions::Equal("ts", Literal::Long(25)), entries),
+              ::testing::ElementsAre(false, true, true, true));
+  EXPECT_THAT(RuledOut(Expressions::Equal("ts", Literal::Long(20)), entries),
+              ::testing::ElementsAre(false, true, true, false));
+  EXPECT_THAT(RuledOut(Expressions::Equal("ts", Literal::Long(50)), entries),
+              ::testing::ElementsAre(true, true, true, true));
+  EXPECT_THAT(RuledOut(Expressions::And(
+                           Expressions::GreaterThanOrEqual("ts", Literal::Long(5)),
+                           Expressions::LessThan("ts", Literal::Long(12))),
+                       entries),
+              ::testing::ElementsAre(true, false, true, false));
+  EXPECT_THAT(RuledOut(Expressions::GreaterThan("ts", Literal::Long(31)), entries),
+              ::testing::ElementsAre(true, true, false, true));
+  EXPECT_THAT(
+      RuledOut(Expressions::In("ts", {Literal::Long(1), Literal::Long(3)}), entries),
+      ::testing::ElementsAre(true, false, true, true));
+  EXPECT_THAT(RuledOut(Expressions::Or(Expressions::Equal("ts", Literal::Long(1)),
+                                       Expressions::Equal("ts", Literal::Long(35))),
+                       entries),
+              ::testing::ElementsAre(false, false, false, false));
+  EXPECT_THAT(RuledOut(Expressions::And(Expressions::Equal("ts", Literal::Long(35)),
+                                        Expressions::Equal("data", Literal::String("x"))),
+                       entries),
+              ::testing::ElementsAre(true, true, false, true));
+}
+
+TEST_F(SortedBoundsIndexTest, OverlappingOrMissingBounds) {
+  auto expr = Expressions::Equal("ts", Literal::Long(25));
+
+  // The files of partition 1 overlap, so only those of partition 2 are indexed.
+  std::vector<ManifestEntry> entries = {
+      Entry({Literal::Int(1)}, 0, 30), Entry({Literal::Int(1)}, 20, 40),
+      Entry({Literal::Int(1)}, 50, 60), Entry({Literal::Int(2)}, 0, 9),
+      Entry({Literal::Int(2)}, 20, 29)};
+  EXPECT_THAT(RuledOut(expr, entries),
+              ::testing::ElementsAre(false, false, false, true, false));
+
+  entries[3].data_file->lower_bounds.clear();
+  EXPECT_THAT(RuledOut(expr, entries),
+              ::testing::ElementsAre(false, false, false, false, false));
+
+  // Deleted entries are neither indexed nor ruled out.
+  entries = {Entry({}, 0, 9), Entry({}, 5, 30)};
+  entries[1].status = ManifestStatus::kDeleted;
+  EXPECT_THAT(RuledOut(expr, entries), ::testing::ElementsAre(true, false));
+}
+
+TEST_F(SortedBoundsIndexTest, NotApplicable) {
+  auto expr = Expressions::Equal("ts", Literal::Long(25));
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto unsorted, SortedBoundsIndex::Make(*SortOrder::Unsorted(), expr, *schema_));
+  EXPECT_EQ(unsorted, nullptr);
+
+  SortOrder bucketed(2, {SortField(1, Transform::Bucket(4), SortDirection::kAscending,
+                                   NullOrder::kFirst)});
+  ICEBERG_UNWRAP_OR_FAIL(auto bucket_index,
+                         SortedBoundsIndex::Make(bucketed, expr, *schema_));
+  EXPECT_EQ(bucket_index, nullptr);
+
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto other_column,
+      SortedBoundsIndex::Make(*sort_order_,
+                              Expressions::Equal("data", Literal::String("x")),
+                              *schema_));
+  EXPECT_EQ(other_column, nullptr);
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto not_equal,
+      SortedBoundsIndex::Make(*sort_order_,
+                              Expressions::NotEqual("ts", Literal::Long(25)), *schema_));
+  EXPECT_EQ(not_equal, nullptr);
+}
+
+}  // namespace iceberg
@@ -0,0 +1,151 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/util/sorted_merge_stream_internal.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <arrow/array.h>
+#include <arrow/array/concatenate.h>
+#include <arrow/c/bridge.h>
+#include <arrow/json/from_string.h>
+#include <arrow/record_batch.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/schema.h"
+#include "iceberg/sort_field.h"
+#include "iceberg/sort_order.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/transform.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+namespace {
+
+std::shared_ptr<::arrow::DataType> RowType() {
+  return ::arrow::struct_(
+      {::arrow::field("id", ::arrow::int32()), ::arrow::field("data", ::arrow::utf8())});
+}
+
+/// \brief Returns a part with a batch for each JSON array of rows.
+ArrowStreamOpener MakePart(std::vector<std::string> batches_json) {
+  return [batches_json = std::move(batches_json)]() -> Result<ArrowArrayStream> {
+    std::vector<std::shared_ptr<::arrow::RecordBatch>> batches;
+    for (const auto& json : batches_json) {
+      auto array = ::arrow::json::ArrayFromJSONString(RowType(), json).ValueOrDie();
+      batches.push_back(::arrow::RecordBatch::FromStructArray(array).ValueOrDie());
+    }
+    auto reader =
+        ::arrow::RecordBatchReader::Make(batches, ::arrow::schema(RowType()->fields()))
+            .ValueOrDie();
+    ArrowArrayStream stream;
+    if (!::arrow::ExportRecordBatchReader(reader, &stream).ok()) {
+      return IOError("Failed to export the batches of a part");
+    }
+    return stream;
+  };
+}
+
+/// \brief Reads the rows of a stream into a single struct array.
+std::shared_ptr<::arrow::Array> ReadRows(ArrowArrayStream* stream) {
+  auto reader = ::arrow::ImportRecordBatchReader(stream).ValueOrDie();
+  ::arrow::ArrayVector arrays;
+  for (const auto& batch : reader->ToRecordBatches().ValueOrDie()) {
+    arrays.push_back(batch->ToStructArray().ValueOrDie());
+  }
+  return ::arrow::Concatenate(arrays).ValueOrDie();
+}
+
+}  // namespace
+
+class SortedMergeStreamTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    schema_ = std::make_shared<Schema>(
+        std::vector<SchemaField>{SchemaField::MakeOptional(1, "id", int32()),
+                                 SchemaField::MakeOptional(2, "data", string())});
+  }
+
+  std::shared_ptr<SortOrder> MakeSortOrder(int32_t source_id, SortDirection direction,
+                                           NullOrder null_order) {
+    return std::make_shared<SortOrder>(
+        1, std::vector<SortField>{
+               SortField(source_id, Transform::Identity(), direction, null_order)});
+  }
+
+  void CheckMerge(const std::shared_ptr<SortOrder>& sort_order,
+                  std::vector<ArrowStreamOpener> parts, std::string_view expected_json) {
+    ICEBERG_UNWRAP_OR_FAIL(auto stream,
+                           MakeSortedMergeArrowStream(schema_, sort_order, parts));
+    auto actual = ReadRows(&stream);
+    auto expected =
+        ::arrow::json::ArrayFromJSONString(RowType(), expected_json).ValueOrDie();
+    ASSERT_TRUE(actual->Equals(*expected)) << actual->ToString();
+  }
+
+  std::shared_ptr<Schema> schema_;
+};
+
+TEST_F(SortedMergeStreamTest, MergesAscending) {
+  // Rows with equal keys come from the earlier part first.
+  CheckMerge(MakeSortOrder(1, SortDirection::kAscending, NullOrder::kLast),
+             {MakePart({R"([[1, "a"], [4, "a"]])", "[]", R"([[7, "a"], [null, "a"]])"}),
+              MakePart({R"([[2, "b"], [4, "b"], [5, "b"]])"}), MakePart({}),
+              MakePart({R"([[0, "c"]])", R"([[9, "c"], [null, "c"]])"})},
+             R"([[0, "c"], [1, "a"], [2, "b"], [4, "a"], [4, "b"], [5, "b"], [7, "a"],
+                 [9, "c"], [null, "a"], [null, "c"]])");
+}
+
+TEST_F(SortedMergeStreamTest, MergesDescendingNullsFirst) {
+  CheckMerge(MakeSortOrder(2, SortDirection::kDescending, NullOrder::kFirst),
+             {MakePart({R"([[1, null], [2, "z"], [3, "b"]])"}),
+              MakePart({R"([[4, "y"]])", R"([[5, "c"], [6, "a"]])"})},
+             R"([[1, null], [2, "z"], [4, "y"], [5, "c"], [3, "b"], [6, "a"]])");
+}
+
+TEST_F(SortedMergeStreamTest, NoParts) {
+  CheckMerge(MakeSortOrder(1, SortDirection::kAscending, NullOrder::kFirst), {}, "[]");
+}
+
+TEST_F(SortedMergeStreamTest, PartErrors) {
+  auto failing = []() -> Result<ArrowArrayStream> {
+    return IOError("Cannot open the part");
+  };
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto stream,
+      MakeSortedMergeArrowStream(
+          schema_, MakeSortOrder(1, SortDirection::kAscending, NullOrder::kFirst),
+          {MakePart({R"([[1, "a"]])"}), failing}));
+  ArrowArray batch;
+  EXPECT_NE(stream.get_next(&stream, &batch), 0);
+  EXPECT_NE(stream.get_last_error(&stream), nullptr);
+  stream.release(&stream);
+}
+
+TEST_F(SortedMergeStreamTest, MissingSortColumn) {
+  EXPECT_THAT(MakeSortedMergeArrowStream(
+                  schema_, MakeSortOrder(3, SortDirection::kAscending, NullOrder::kFirst),
+                  {}),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+}  // namespace iceberg
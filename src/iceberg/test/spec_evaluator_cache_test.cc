@@ -0,0 +1,136 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/spec_evaluator_cache.h"
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/expression/expressions.h"
+#include "iceberg/expression/manifest_evaluator.h"
+#include "iceberg/expression/residual_evaluator.h"
+#include "iceberg/partition_field.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/transform.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+class SpecEvaluatorCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    schema_ = std::make_shared<Schema>(
+        std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int64()),
+                                 SchemaField::MakeOptional(2, "region", string())},
+        /*schema_id=*/0);
+    identity_spec_ = std::make_shared<PartitionSpec>(
+        schema_, /*spec_id=*/0,
+        std::vector<PartitionField>{
+            PartitionField(2, 1000, "region", Transform::Identity())});
+    bucket_spec_ = std::make_shared<PartitionSpec>(
+        schema_, /*spec_id=*/1,
+        std::vector<PartitionField>{
+            PartitionField(1, 1001, "id_bucket", Transform::Bucket(16))});
+  }
+
+  std::shared_ptr<Schema> schema_;
+  std::shared_ptr<PartitionSpec> identity_spec_;
+  std::shared_ptr<PartitionSpec> bucket_spec_;
+};
+
+TEST_F(SpecEvaluatorCacheTest, BuildsEvaluatorsPerSpec) {
+  SpecEvaluatorCache cache;
+  auto filter = Expressions::Equal("region", Literal::String("eu"));
+
+  ICEBERG_UNWRAP_OR_FAIL(auto identity, cache.Get(identity_spec_, filter, true));
+  ICEBERG_UNWRAP_OR_FAIL(auto bucket, cache.Get(bucket_spec_, filter, true));
+  EXPECT_EQ(identity->spec, identity_spec_);
+  EXPECT_EQ(bucket->spec, bucket_spec_);
+  ASSERT_NE(identity->partition_schema, nullptr);
+  EXPECT_EQ(identity->partition_schema->fields()[0].field_id(), 1000);
+  EXPECT_EQ(bucket->partition_schema->fields()[0].field_id(), 1001);
+
+  // The residual of each spec is computed from its own partition values.
+  ASSERT_NE(identity->residual_evaluator, nullptr);
+  ICEBERG_UNWRAP_OR_FAIL(auto residual, identity->residual_evaluator->ResidualFor(
+                                            {Literal::String("us")}));
+  EXPECT_EQ(residual->op(), Expression::Operation::kFalse);
+  ICEBERG_UNWRAP_OR_FAIL(residual,
+                         bucket->residual_evaluator->ResidualFor({Literal::Int(3)}));
+  EXPECT_EQ(residual->op(), Expression::Operation::kEq);
+  EXPECT_NE(identity->manifest_evaluator, nullptr);
+  EXPECT_EQ(cache.size(), 2);
+}
+
+TEST_F(SpecEvaluatorCacheTest, ReusesEntries) {
+  SpecEvaluatorCache cache;
+  auto filter = Expressions::Equal("id", Literal::Long(3));
+
+  ICEBERG_UNWRAP_OR_FAIL(auto first, cache.Get(bucket_spec_, filter, true));
+  ICEBERG_UNWRAP_OR_FAIL(auto second, cache.Get(bucket_spec_, filter, true));
+  EXPECT_EQ(first, second);
+
+  // An equal filter of another object, or another case sensitivity, is a new entry.
+  auto other_filter = Expressions::Equal("id", Literal::Long(3));
+  ICEBERG_UNWRAP_OR_FAIL(auto other, cache.Get(bucket_spec_, other_filter, true));
+  EXPECT_NE(other, first);
+  ICEBERG_UNWRAP_OR_FAIL(auto insensitive, cache.Get(bucket_spec_, filter, false));
+  EXPECT_NE(insensitive, first);
+  EXPECT_EQ(cache.size(), 3);
+}
+
+TEST_F(SpecEvaluatorCacheTest, NoFilter) {
+  SpecEvaluatorCache cache;
+  ICEBERG_UNWRAP_OR_FAIL(auto evaluators, cache.Get(identity_spec_, nullptr, true));
+  EXPECT_NE(evaluators->partition_schema, nullptr);
+  EXPECT_EQ(evaluators->manifest_evaluator, nullptr);
+  EXPECT_EQ(evaluators->residual_evaluator, nullptr);
+
+  EXPECT_THAT(cache.Get(nullptr, nullptr, true), IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(cache.Get(identity_spec_, Expressions::Equal("missing", Literal::Int(1)),
+                        true),
+              IsError(ErrorKind::kInvalidExpression));
+  EXPECT_EQ(cache.size(), 1);
+}
+
+TEST_F(SpecEvaluatorCacheTest, EvictsLeastRecentlyUsed) {
+  SpecEvaluatorCache cache(/*capacity=*/2);
+  auto first_filter = Expressions::Equal("id", Literal::Long(1));
+  auto second_filter = Expressions::Equal("id", Literal::Long(2));
+  auto third_filter = Expressions::Equal("id", Literal::Long(3));
+
+  ICEBERG_UNWRAP_OR_FAIL(auto first, cache.Get(bucket_spec_, first_filter, true));
+  ICEBERG_UNWRAP_OR_FAIL(auto second, cache.Get(bucket_spec_, second_filter, true));
+  // Using the first entry makes the second the least recently used.
+  ICEBERG_UNWRAP_OR_FAIL(auto reused, cache.Get(bucket_spec_, first_filter, true));
+  EXPECT_EQ(reused, first);
+  ICEBERG_UNWRAP_OR_FAIL(auto third, cache.Get(bucket_spec_, third_filter, true));
+  EXPECT_EQ(cache.size(), 2);
+
+  ICEBERG_UNWRAP_OR_FAIL(reused, cache.Get(bucket_spec_, first_filter, true));
+  EXPECT_EQ(reused, first);
+  ICEBERG_UNWRAP_OR_FAIL(auto rebuilt, cache.Get(bucket_spec_, second_filter, true));
+  EXPECT_NE(rebuilt, second);
+}
+
+}  // namespace iceberg
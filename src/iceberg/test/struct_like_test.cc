@@ -262,6 +262,55 @@ TEST(ArrowArrayStructLike, PrimitiveFields) {
   }
 }
 
+TEST(ArrowArrayStructLike, TypedColumns) {
+  auto struct_type = ::arrow::struct_(
+      {::arrow::field("id", ::arrow::int64(), /*nullable=*/false),
+       ::arrow::field("name", ::arrow::utf8(), /*nullable=*/true),
+       ::arrow::field("score", ::arrow::float32(), /*nullable=*/true),
+       ::arrow::field("date", ::arrow::date32(), /*nullable=*/false)});
+
+  auto arrow_array = ::arrow::json::ArrayFromJSONString(struct_type, R"([
+    {"id": 1, "name": "Alice", "score": 95.5, "date": 19724},
+    {"id": 2, "name": "Bob", "score": null, "date": 19725},
+    {"id": 3, "name": null, "score": 87.25, "date": 19726},
+    {"id": 4, "name": "Dan", "score": 70.0, "date": 19727}])")
+                         .ValueOrDie();
+
+  ArrowSchema c_schema;
+  ArrowArray c_array;
+  internal::ArrowSchemaGuard schema_guard(&c_schema);
+  internal::ArrowArrayGuard array_guard(&c_array);
+  ASSERT_TRUE(::arrow::ExportType(*struct_type, &c_schema).ok());
+  ASSERT_TRUE(::arrow::ExportArray(*arrow_array, &c_array).ok());
+  ICEBERG_UNWRAP_OR_FAIL(auto struct_like, ArrowArrayStructLike::Make(c_schema, c_array));
+
+  // Columns are indexed like the rows of GetField.
+  ICEBERG_UNWRAP_OR_FAIL(auto ids, struct_like->GetInt64Column(0));
+  ASSERT_EQ(ids.size(), 4);
+  for (int64_t i = 0; i < ids.size(); ++i) {
+    ASSERT_THAT(struct_like->Reset(i), IsOk());
+    EXPECT_SCALAR_EQ(struct_like->GetField(0), int64_t, ids.values[i]);
+    EXPECT_TRUE(ids.IsValid(i));
+  }
+
+  ICEBERG_UNWRAP_OR_FAIL(auto names, struct_like->GetBinaryColumn(1));
+  ASSERT_EQ(names.size(), 4);
+  EXPECT_EQ(names.Value(1), "Bob");
+  EXPECT_FALSE(names.IsValid(2));
+  EXPECT_EQ(names.Value(3), "Dan");
+
+  ICEBERG_UNWRAP_OR_FAIL(auto scores, struct_like->GetFloatColumn(2));
+  EXPECT_FALSE(scores.IsValid(1));
+  EXPECT_TRUE(scores.IsValid(2));
+  EXPECT_EQ(scores.values[2], 87.25f);
+
+  ICEBERG_UNWRAP_OR_FAIL(auto dates, struct_like->GetInt32Column(3));
+  EXPECT_EQ(dates.values[1], 19725);
+
+  EXPECT_THAT(struct_like->GetInt32Column(0), IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(struct_like->GetDoubleColumn(4), IsError(ErrorKind::kInvalidArgument));
+}
+
 TEST(ArrowArrayStructLike, NestedStruct) {
   auto person_type =
       ::arrow::struct_({::arrow::field("name", ::arrow::utf8(), /*nullable=*/false),
@@ -291,6 +340,7 @@ TEST(ArrowArrayStructLike, NestedStruct) {
   std::array<std::string, kNumRows> names = {"Alice", "Bob"};
   std::array<int32_t, kNumRows> ages = {30, 25};
 
+  std::shared_ptr<StructLike> previous_person;
   for (int64_t i = 0; i < kNumRows; ++i) {
     ASSERT_THAT(struct_like->Reset(i), IsOk());
     EXPECT_EQ(struct_like->num_fields(), 2);
@@ -305,6 +355,12 @@ TEST(ArrowArrayStructLike, NestedStruct) {
     EXPECT_EQ(person_struct->num_fields(), 2);
     EXPECT_SCALAR_EQ(person_struct->GetField(0), std::string_view, names[i]);
     EXPECT_SCALAR_EQ(person_struct->GetField(1), int32_t, ages[i]);
+
+    // The nested wrapper is re-pointed at each row rather than allocated again.
+    if (previous_person != nullptr) {
+      EXPECT_EQ(person_struct, previous_person);
+    }
+    previous_person = person_struct;
   }
 }
 
@@ -24,7 +24,9 @@
 #include <gtest/gtest.h>
 
 #include "iceberg/partition_spec.h"
+#include "iceberg/snapshot.h"
 #include "iceberg/sort_order.h"
+#include "iceberg/statistics_file.h"
 #include "iceberg/table_metadata.h"
 #include "iceberg/table_requirement.h"
 #include "iceberg/table_requirements.h"
@@ -155,6 +157,234 @@ TEST_F(TableMetadataBuilderTest, AssignUUIDAndCaseInsensitiveComparison) {
   EXPECT_EQ(metadata->table_uuid, "TEST-UUID-ABCD");  // Original case preserved
 }
 
+// ============================================================================
+// TableMetadataBuilder - Statistics Tests
+// ============================================================================
+
+TEST_F(TableMetadataBuilderTest, SetAndRemoveStatistics) {
+  auto statistics = [](int64_t snapshot_id, std::string path) {
+    return std::make_shared<StatisticsFile>(
+        StatisticsFile{.snapshot_id = snapshot_id,
+                       .path = std::move(path),
+                       .file_size_in_bytes = 100,
+                       .file_footer_size_in_bytes = 50,
+                       .blob_metadata = {}});
+  };
+  auto builder = TableMetadataBuilder::BuildFrom(base_metadata_.get());
+  builder->SetStatistics(statistics(1, "s3://bucket/stats-1a.puffin"));
+  builder->SetStatistics(statistics(2, "s3://bucket/stats-2.puffin"));
+  // The statistics file of a snapshot replaces its previous one.
+  builder->SetStatistics(statistics(1, "s3://bucket/stats-1b.puffin"));
+  builder->RemoveStatistics(2);
+  builder->RemoveStatistics(3);
+
+  ICEBERG_UNWRAP_OR_FAIL(auto metadata, builder->Build());
+  ASSERT_EQ(metadata->statistics.size(), 1);
+  EXPECT_EQ(metadata->statistics[0]->path, "s3://bucket/stats-1b.puffin");
+
+  table::RemoveStatistics update(1);
+  EXPECT_TRUE(GenerateRequirements(update, metadata.get()).empty());
+  auto other = TableMetadataBuilder::BuildFrom(metadata.get());
+  update.ApplyTo(*other);
+  ICEBERG_UNWRAP_OR_FAIL(auto removed, other->Build());
+  EXPECT_TRUE(removed->statistics.empty());
+}
+
+TEST_F(TableMetadataBuilderTest, SetNullStatistics) {
+  auto builder = TableMetadataBuilder::BuildFrom(base_metadata_.get());
+  builder->SetStatistics(nullptr);
+
+  ASSERT_THAT(builder->Build(), HasErrorMessage("Cannot set null statistics file"));
+}
+
+TEST_F(TableMetadataBuilderTest, SetAndRemovePartitionStatistics) {
+  auto partition_statistics = [](int64_t snapshot_id, std::string path) {
+    return std::make_shared<PartitionStatisticsFile>(PartitionStatisticsFile{
+        .snapshot_id = snapshot_id, .path = std::move(path), .file_size_in_bytes = 10});
+  };
+  auto builder = TableMetadataBuilder::BuildFrom(base_metadata_.get());
+  builder->SetPartitionStatistics(partition_statistics(1, "s3://bucket/p-1a.parquet"));
+  builder->SetPartitionStatistics(partition_statistics(2, "s3://bucket/p-2.parquet"));
+  builder->SetPartitionStatistics(partition_statistics(1, "s3://bucket/p-1b.parquet"));
+  builder->RemovePartitionStatistics(2);
+  builder->RemovePartitionStatistics(3);
+  builder->SetPartitionStatistics(nullptr);
+  EXPECT_THAT(builder->Build(),
+              HasErrorMessage("Cannot set null partition statistics file"));
+
+  builder = TableMetadataBuilder::BuildFrom(base_metadata_.get());
+  table::SetPartitionStatistics(partition_statistics(1, "s3://bucket/p-1.parquet"))
+      .ApplyTo(*builder);
+  ICEBERG_UNWRAP_OR_FAIL(auto metadata, builder->Build());
+  ASSERT_EQ(metadata->partition_statistics.size(), 1);
+  EXPECT_EQ(metadata->partition_statistics[0]->path, "s3://bucket/p-1.parquet");
+
+  table::RemovePartitionStatistics update(1);
+  EXPECT_TRUE(GenerateRequirements(update, metadata.get()).empty());
+  auto other = TableMetadataBuilder::BuildFrom(metadata.get());
+  update.ApplyTo(*other);
+  ICEBERG_UNWRAP_OR_FAIL(auto removed, other->Build());
+  EXPECT_TRUE(removed->partition_statistics.empty());
+}
+
+TEST_F(TableMetadataBuilderTest, AddSnapshotAndSetMainBranch) {
+  auto snapshot = std::make_shared<Snapshot>(Snapshot{
+      .snapshot_id = 1,
+      .sequence_number = 1,
+      .timestamp_ms = TimePointMs{std::chrono::milliseconds(2000)},
+      .manifest_list = "s3://bucket/test/metadata/snap-1.avro",
+  });
+  auto builder = TableMetadataBuilder::BuildFrom(base_metadata_.get());
+  builder->AddSnapshot(snapshot);
+  builder->SetBranchSnapshot(1, SnapshotRef::kMainBranch);
+  ICEBERG_UNWRAP_OR_FAIL(auto metadata, builder->Build());
+
+  EXPECT_EQ(metadata->current_snapshot_id, 1);
+  EXPECT_EQ(metadata->last_sequence_number, 1);
+  EXPECT_EQ(metadata->last_updated_ms, snapshot->timestamp_ms);
+  ASSERT_EQ(metadata->snapshots.size(), 1);
+  ASSERT_TRUE(metadata->refs.contains(SnapshotRef::kMainBranch));
+  EXPECT_EQ(metadata->refs.at(SnapshotRef::kMainBranch)->snapshot_id, 1);
+  ASSERT_EQ(metadata->snapshot_log.size(), 1);
+  EXPECT_EQ(metadata->snapshot_log[0],
+            (SnapshotLogEntry{.timestamp_ms = snapshot->timestamp_ms, .snapshot_id = 1}));
+
+  // A child snapshot must have a newer sequence number.
+  auto child = std::make_shared<Snapshot>(*snapshot);
+  child->snapshot_id = 2;
+  child->parent_snapshot_id = 1;
+  auto other = TableMetadataBuilder::BuildFrom(metadata.get());
+  other->AddSnapshot(child);
+  other->AddSnapshot(snapshot);
+  other->SetRef("branch", std::make_shared<SnapshotRef>(SnapshotRef{.snapshot_id = 3}));
+  auto result = other->Build();
+  EXPECT_THAT(result, HasErrorMessage("older than last sequence number 1"));
+  EXPECT_THAT(result, HasErrorMessage("Snapshot already exists for id: 1"));
+  EXPECT_THAT(result, HasErrorMessage("Cannot set branch to unknown snapshot: 3"));
+}
+
+TEST_F(TableMetadataBuilderTest, AddSnapshotAssignsRowIds) {
+  base_metadata_->format_version = 3;
+  base_metadata_->next_row_id = 100;
+  auto snapshot = std::make_shared<Snapshot>(Snapshot{
+      .snapshot_id = 1,
+      .sequence_number = 1,
+      .timestamp_ms = TimePointMs{std::chrono::milliseconds(2000)},
+      .first_row_id = 100,
+      .added_rows = 30,
+  });
+  auto builder = TableMetadataBuilder::BuildFrom(base_metadata_.get());
+  builder->AddSnapshot(snapshot);
+  ICEBERG_UNWRAP_OR_FAIL(auto metadata, builder->Build());
+  EXPECT_EQ(metadata->next_row_id, 130);
+
+  // The row IDs of a snapshot cannot overlap those already assigned.
+  auto behind = std::make_shared<Snapshot>(*snapshot);
+  behind->snapshot_id = 2;
+  behind->sequence_number = 2;
+  behind->first_row_id = 120;
+  auto other = TableMetadataBuilder::BuildFrom(metadata.get());
+  other->AddSnapshot(behind);
+  EXPECT_THAT(other->Build(), HasErrorMessage("behind the table next-row-id 130"));
+
+  auto missing = std::make_shared<Snapshot>(*behind);
+  missing->first_row_id = std::nullopt;
+  other = TableMetadataBuilder::BuildFrom(metadata.get());
+  other->AddSnapshot(missing);
+  EXPECT_THAT(other->Build(), HasErrorMessage("without first-row-id and added-rows"));
+}
+
+TEST_F(TableMetadataBuilderTest, AddSnapshotSharesHistoryWithBase) {
+  for (int64_t snapshot_id = 1; snapshot_id <= 100; ++snapshot_id) {
+    auto timestamp = TimePointMs{std::chrono::milliseconds(1000 + snapshot_id)};
+    base_metadata_->snapshots.push_back(std::make_shared<Snapshot>(
+        Snapshot{.snapshot_id = snapshot_id,
+                 .sequence_number = snapshot_id,
+                 .timestamp_ms = timestamp}));
+    base_metadata_->snapshot_log.push_back(
+        SnapshotLogEntry{.timestamp_ms = timestamp, .snapshot_id = snapshot_id});
+  }
+  base_metadata_->last_sequence_number = 100;
+
+  auto builder = TableMetadataBuilder::BuildFrom(base_metadata_.get());
+  builder->AddSnapshot(std::make_shared<Snapshot>(
+      Snapshot{.snapshot_id = 101,
+               .sequence_number = 101,
+               .timestamp_ms = TimePointMs{std::chrono::milliseconds(2000)}}));
+  builder->SetBranchSnapshot(101, SnapshotRef::kMainBranch);
+  ICEBERG_UNWRAP_OR_FAIL(auto metadata, builder->Build());
+
+  ASSERT_EQ(metadata->snapshots.size(), 101);
+  ASSERT_EQ(metadata->snapshot_log.size(), 101);
+  EXPECT_EQ(metadata->snapshots.back()->snapshot_id, 101);
+  // The entries of the base are not copied by the new metadata.
+  EXPECT_EQ(&metadata->snapshots[0], &base_metadata_->snapshots[0]);
+  EXPECT_EQ(&metadata->snapshot_log[0], &base_metadata_->snapshot_log[0]);
+  EXPECT_EQ(base_metadata_->snapshots.size(), 100);
+  EXPECT_EQ(base_metadata_->snapshot_log.size(), 100);
+}
+
+TEST_F(TableMetadataBuilderTest, SetAndRemoveSnapshotRef) {
+  base_metadata_->snapshots.push_back(std::make_shared<Snapshot>(
+      Snapshot{.snapshot_id = 1, .sequence_number = 1, .timestamp_ms = {}}));
+  table::SetSnapshotRef update("tag", 1, SnapshotRefType::kTag,
+                               /*min_snapshots_to_keep=*/std::nullopt,
+                               /*max_snapshot_age_ms=*/std::nullopt,
+                               /*max_ref_age_ms=*/1000);
+
+  auto builder = TableMetadataBuilder::BuildFrom(base_metadata_.get());
+  update.ApplyTo(*builder);
+  ICEBERG_UNWRAP_OR_FAIL(auto metadata, builder->Build());
+  ASSERT_TRUE(metadata->refs.contains("tag"));
+  EXPECT_EQ(*metadata->refs.at("tag"),
+            (SnapshotRef{.snapshot_id = 1,
+                         .retention = SnapshotRef::Tag{.max_ref_age_ms = 1000}}));
+  EXPECT_EQ(metadata->current_snapshot_id, Snapshot::kInvalidSnapshotId);
+
+  auto other = TableMetadataBuilder::BuildFrom(metadata.get());
+  table::RemoveSnapshotRef("tag").ApplyTo(*other);
+  ICEBERG_UNWRAP_OR_FAIL(auto removed, other->Build());
+  EXPECT_TRUE(removed->refs.empty());
+}
+
+TEST_F(TableMetadataBuilderTest, RemoveSnapshots) {
+  for (int64_t snapshot_id = 1; snapshot_id <= 3; ++snapshot_id) {
+    auto timestamp = TimePointMs{std::chrono::milliseconds(1000 * snapshot_id)};
+    base_metadata_->snapshots.push_back(std::make_shared<Snapshot>(
+        Snapshot{.snapshot_id = snapshot_id,
+                 .parent_snapshot_id = snapshot_id == 1
+                                           ? std::nullopt
+                                           : std::optional<int64_t>(snapshot_id - 1),
+                 .sequence_number = snapshot_id,
+                 .timestamp_ms = timestamp}));
+    base_metadata_->snapshot_log.push_back(
+        SnapshotLogEntry{.timestamp_ms = timestamp, .snapshot_id = snapshot_id});
+  }
+  base_metadata_->current_snapshot_id = 3;
+  base_metadata_->refs[SnapshotRef::kMainBranch] =
+      std::make_shared<SnapshotRef>(SnapshotRef{.snapshot_id = 3});
+  base_metadata_->refs["tag"] = std::make_shared<SnapshotRef>(
+      SnapshotRef{.snapshot_id = 2, .retention = SnapshotRef::Tag{}});
+  base_metadata_->statistics.push_back(std::make_shared<StatisticsFile>(
+      StatisticsFile{.snapshot_id = 1, .path = "s3://bucket/stats-1.puffin"}));
+
+  table::RemoveSnapshots update({1, 2, 4});
+  auto requirements = GenerateRequirements(update, base_metadata_.get());
+  EXPECT_EQ(requirements.size(), 2);
+  auto builder = TableMetadataBuilder::BuildFrom(base_metadata_.get());
+  update.ApplyTo(*builder);
+  ICEBERG_UNWRAP_OR_FAIL(auto metadata, builder->Build());
+
+  ASSERT_EQ(metadata->snapshots.size(), 1);
+  EXPECT_EQ(metadata->snapshots[0]->snapshot_id, 3);
+  EXPECT_EQ(metadata->current_snapshot_id, 3);
+  // The tag of a removed snapshot is removed with it.
+  EXPECT_FALSE(metadata->refs.contains("tag"));
+  EXPECT_TRUE(metadata->statistics.empty());
+  ASSERT_EQ(metadata->snapshot_log.size(), 1);
+  EXPECT_EQ(metadata->snapshot_log[0].snapshot_id, 3);
+}
+
 // ============================================================================
 // TableUpdate - ApplyTo Tests
 // ============================================================================
@@ -198,6 +428,40 @@ TEST_F(TableMetadataBuilderTest,
   EXPECT_TRUE(requirements.empty());  // No requirement when base has no UUID
 }
 
+TEST_F(TableMetadataBuilderTest, TableUpdateWithSetSnapshotRef) {
+  table::SetSnapshotRef update(SnapshotRef::kMainBranch, 2, SnapshotRefType::kBranch);
+
+  auto requirements = GenerateRequirements(update, base_metadata_.get());
+  ASSERT_EQ(requirements.size(), 1);
+  auto* requirement = dynamic_cast<table::AssertRefSnapshotID*>(requirements[0].get());
+  ASSERT_NE(requirement, nullptr);
+  EXPECT_EQ(requirement->ref_name(), SnapshotRef::kMainBranch);
+  EXPECT_EQ(requirement->snapshot_id(), std::nullopt);
+
+  base_metadata_->refs[SnapshotRef::kMainBranch] =
+      std::make_shared<SnapshotRef>(SnapshotRef{.snapshot_id = 1});
+  requirements = GenerateRequirements(update, base_metadata_.get());
+  ASSERT_EQ(requirements.size(), 1);
+  requirement = dynamic_cast<table::AssertRefSnapshotID*>(requirements[0].get());
+  ASSERT_NE(requirement, nullptr);
+  EXPECT_EQ(requirement->snapshot_id(), 1);
+}
+
+TEST_F(TableMetadataBuilderTest, TableRequirementsForUpdateTable) {
+  std::vector<std::unique_ptr<TableUpdate>> updates;
+  updates.push_back(std::make_unique<table::SetSnapshotRef>(
+      SnapshotRef::kMainBranch, 1, SnapshotRefType::kBranch));
+
+  ICEBERG_UNWRAP_OR_FAIL(auto requirements,
+                         TableRequirements::ForUpdateTable(*base_metadata_, updates));
+  ASSERT_EQ(requirements.size(), 2);
+  EXPECT_NE(dynamic_cast<table::AssertUUID*>(requirements[0].get()), nullptr);
+  EXPECT_NE(dynamic_cast<table::AssertRefSnapshotID*>(requirements[1].get()), nullptr);
+  for (const auto& requirement : requirements) {
+    EXPECT_THAT(requirement->Validate(base_metadata_.get()), IsOk());
+  }
+}
+
 // ============================================================================
 // TableRequirement - Validate Tests
 // ============================================================================
@@ -264,6 +528,32 @@ TEST_F(TableMetadataBuilderTest, TableRequirementAssertCurrentSchemaIDNotSet) {
   EXPECT_THAT(status, HasErrorMessage("schema ID is not set"));
 }
 
+TEST_F(TableMetadataBuilderTest, TableRequirementAssertRefSnapshotID) {
+  base_metadata_->refs[SnapshotRef::kMainBranch] =
+      std::make_shared<SnapshotRef>(SnapshotRef{.snapshot_id = 1});
+
+  EXPECT_THAT(table::AssertRefSnapshotID(SnapshotRef::kMainBranch, 1)
+                  .Validate(base_metadata_.get()),
+              IsOk());
+  EXPECT_THAT(table::AssertRefSnapshotID("missing", std::nullopt)
+                  .Validate(base_metadata_.get()),
+              IsOk());
+
+  auto status = table::AssertRefSnapshotID(SnapshotRef::kMainBranch, 2)
+                    .Validate(base_metadata_.get());
+  EXPECT_THAT(status, IsError(ErrorKind::kCommitFailed));
+  EXPECT_THAT(status, HasErrorMessage("branch main has changed"));
+
+  status = table::AssertRefSnapshotID(SnapshotRef::kMainBranch, std::nullopt)
+               .Validate(base_metadata_.get());
+  EXPECT_THAT(status, IsError(ErrorKind::kCommitFailed));
+  EXPECT_THAT(status, HasErrorMessage("branch main was created concurrently"));
+
+  status = table::AssertRefSnapshotID("missing", 1).Validate(base_metadata_.get());
+  EXPECT_THAT(status, IsError(ErrorKind::kCommitFailed));
+  EXPECT_THAT(status, HasErrorMessage("branch or tag missing is missing"));
+}
+
 // ============================================================================
 // Integration Tests - End-to-End Workflow
 // ============================================================================
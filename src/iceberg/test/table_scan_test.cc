@@ -0,0 +1,1222 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <iterator>
+#include <tuple>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/arrow/arrow_fs_file_io_internal.h"
+#include "iceberg/avro/avro_register.h"
+#include "iceberg/executor.h"
+#include "iceberg/expression/expressions.h"
+#include "iceberg/manifest_cache.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/manifest_list.h"
+#include "iceberg/manifest_writer.h"
+#include "iceberg/memory_pool.h"
+#include "iceberg/metadata_columns.h"
+#include "iceberg/metrics_reporter.h"
+#include "iceberg/partition_field.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/scan_plan_cache.h"
+#include "iceberg/scan_task_serialization.h"
+#include "iceberg/scan_task_spill.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/sort_field.h"
+#include "iceberg/sort_order.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/table_properties.h"
+#include "iceberg/table_scan.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/test/temp_file_test_base.h"
+#include "iceberg/transform.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief Keeps the scan reports it receives.
+class RecordingReporter : public MetricsReporter {
+ public:
+  void Report(const MetricsReport& report) override {
+    reports.push_back(std::get<ScanReport>(report));
+  }
+
+  std::vector<ScanReport> reports;
+};
+
+}  // namespace
+
+class TableScanTest : public TempFileTestBase {
+ protected:
+  static constexpr int64_t kSnapshotId = 1000;
+
+  static void SetUpTestSuite() { avro::RegisterAll(); }
+
+  void SetUp() override {
+    TempFileTestBase::SetUp();
+    file_io_ = arrow::ArrowFileSystemFileIO::MakeLocalFileIO();
+    schema_ = std::make_shared<Schema>(
+        std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int32())},
+        /*schema_id=*/0);
+  }
+
+  ManifestEntry MakeEntry(const std::string& file_path,
+                          std::vector<Literal> partition = {}) {
+    ManifestEntry entry;
+    entry.status = ManifestStatus::kAdded;
+    entry.snapshot_id = kSnapshotId;
+    entry.data_file = std::make_shared<DataFile>();
+    entry.data_file->file_path = file_path;
+    entry.data_file->file_format = FileFormatType::kParquet;
+    entry.data_file->partition = std::move(partition);
+    entry.data_file->record_count = 10;
+    entry.data_file->file_size_in_bytes = 1024;
+    return entry;
+  }
+
+  ManifestEntry MakeDeleteEntry(const std::string& file_path,
+                                std::vector<Literal> partition = {}) {
+    auto entry = MakeEntry(file_path, std::move(partition));
+    entry.data_file->content = DataFile::Content::kPositionDeletes;
+    return entry;
+  }
+
+  ManifestFile WriteManifest(
+      const std::shared_ptr<PartitionSpec>& spec,
+      const std::vector<ManifestEntry>& entries,
+      ManifestFile::Content content = ManifestFile::Content::kData) {
+    auto manifest_path = CreateNewTempFilePathWithSuffix(".avro");
+    manifest_paths_.push_back(manifest_path);
+    auto writer =
+        ManifestWriter::MakeV2Writer(kSnapshotId, manifest_path, file_io_, spec);
+    EXPECT_THAT(writer, IsOk());
+    EXPECT_THAT((*writer)->AddAll(entries), IsOk());
+    EXPECT_THAT((*writer)->Close(), IsOk());
+
+    return ManifestFile{
+        .manifest_path = manifest_path,
+        .manifest_length =
+            static_cast<int64_t>(std::filesystem::file_size(manifest_path)),
+        .partition_spec_id = spec->spec_id(),
+        .content = content,
+        .sequence_number = 1,
+        .min_sequence_number = 1,
+        .added_snapshot_id = kSnapshotId,
+        .added_files_count = static_cast<int32_t>(entries.size()),
+    };
+  }
+
+  // Returns table metadata whose current snapshot references the given manifests.
+  std::shared_ptr<TableMetadata> PrepareTable(
+      const std::vector<ManifestFile>& manifest_files,
+      std::shared_ptr<PartitionSpec> spec = PartitionSpec::Unpartitioned()) {
+    auto manifest_list_path = CreateNewTempFilePathWithSuffix(".avro");
+    auto list_writer = ManifestListWriter::MakeV2Writer(
+        kSnapshotId, std::nullopt, /*sequence_number=*/1, manifest_list_path, file_io_);
+    EXPECT_THAT(list_writer, IsOk());
+    EXPECT_THAT((*list_writer)->AddAll(manifest_files), IsOk());
+    EXPECT_THAT((*list_writer)->Close(), IsOk());
+
+    const int32_t spec_id = spec->spec_id();
+    return std::make_shared<TableMetadata>(TableMetadata{
+        .format_version = 2,
+        .table_uuid = "test-table-uuid",
+        .location = "/tmp/test_table",
+        .last_sequence_number = 1,
+        .last_column_id = 1,
+        .schemas = {schema_},
+        .current_schema_id = 0,
+        .partition_specs = {std::move(spec)},
+        .default_spec_id = spec_id,
+        .current_snapshot_id = kSnapshotId,
+        .snapshots = {std::make_shared<Snapshot>(Snapshot{
+            .snapshot_id = kSnapshotId,
+            .sequence_number = 1,
+            .timestamp_ms = TimePointMsFromUnixMs(1700000000000).value(),
+            .manifest_list = manifest_list_path,
+            .schema_id = 0,
+        })},
+    });
+  }
+
+  // Writes one unpartitioned manifest per element of `files_per_manifest`.
+  std::shared_ptr<TableMetadata> PrepareTable(
+      const std::vector<int32_t>& files_per_manifest) {
+    std::vector<ManifestFile> manifest_files;
+    for (size_t i = 0; i < files_per_manifest.size(); ++i) {
+      std::vector<ManifestEntry> entries;
+      for (int32_t j = 0; j < files_per_manifest[i]; ++j) {
+        entries.push_back(MakeEntry(std::format("data-{}-{}.parquet", i, j)));
+      }
+      manifest_files.push_back(WriteManifest(PartitionSpec::Unpartitioned(), entries));
+    }
+    return PrepareTable(manifest_files);
+  }
+
+  static std::vector<std::string> TaskPaths(
+      const std::vector<std::shared_ptr<FileScanTask>>& tasks) {
+    std::vector<std::string> paths;
+    for (const auto& task : tasks) {
+      paths.push_back(task->data_file()->file_path);
+    }
+    return paths;
+  }
+
+  // Writes an unpartitioned manifest with a data file of each of the given sizes.
+  std::shared_ptr<TableMetadata> PrepareTableWithFileSizes(
+      const std::vector<int64_t>& file_sizes) {
+    std::vector<ManifestEntry> entries;
+    for (size_t i = 0; i < file_sizes.size(); ++i) {
+      auto entry = MakeEntry(std::format("data-{}.parquet", i));
+      entry.data_file->file_size_in_bytes = file_sizes[i];
+      entries.push_back(std::move(entry));
+    }
+    return PrepareTable(std::vector<ManifestFile>{
+        WriteManifest(PartitionSpec::Unpartitioned(), entries)});
+  }
+
+  static std::vector<std::vector<std::string>> TaskPaths(
+      const std::vector<std::shared_ptr<CombinedScanTask>>& combined_tasks) {
+    std::vector<std::vector<std::string>> paths;
+    for (const auto& combined_task : combined_tasks) {
+      paths.push_back(TaskPaths(combined_task->tasks()));
+    }
+    return paths;
+  }
+
+  std::shared_ptr<FileIO> file_io_;
+  std::shared_ptr<Schema> schema_;
+  std::vector<std::string> manifest_paths_;
+};
+
+TEST_F(TableScanTest, ParallelPlanningMatchesSerialPlanning) {
+  auto metadata = PrepareTable({3, 1, 0, 2, 4, 1, 2});
+
+  auto serial_scan = TableScanBuilder(metadata, file_io_).Build();
+  ASSERT_THAT(serial_scan, IsOk());
+  auto serial_tasks = (*serial_scan)->PlanFiles();
+  ASSERT_THAT(serial_tasks, IsOk());
+  ASSERT_EQ(serial_tasks->size(), 13);
+
+  for (int32_t parallelism : {2, 4, 16}) {
+    auto parallel_scan =
+        TableScanBuilder(metadata, file_io_).WithPlanningParallelism(parallelism).Build();
+    ASSERT_THAT(parallel_scan, IsOk());
+    auto parallel_tasks = (*parallel_scan)->PlanFiles();
+    ASSERT_THAT(parallel_tasks, IsOk());
+    EXPECT_EQ(TaskPaths(*parallel_tasks), TaskPaths(*serial_tasks))
+        << "parallelism: " << parallelism;
+  }
+}
+
+TEST_F(TableScanTest, PlanningWithManifestReadahead) {
+  auto metadata = PrepareTable({3, 1, 0, 2, 4, 1, 2});
+  auto serial_scan = TableScanBuilder(metadata, file_io_).Build();
+  ASSERT_THAT(serial_scan, IsOk());
+  auto serial_tasks = (*serial_scan)->PlanFiles();
+  ASSERT_THAT(serial_tasks, IsOk());
+
+  ICEBERG_UNWRAP_OR_FAIL(std::shared_ptr<Executor> io_executor,
+                         ThreadPoolExecutor::Make(4));
+  for (int64_t readahead_bytes : {1, 4096, 1 << 20}) {
+    auto scan = TableScanBuilder(metadata, file_io_)
+                    .WithPlanningParallelism(2)
+                    .WithIOExecutor(io_executor)
+                    .WithManifestReadahead(readahead_bytes)
+                    .Build();
+    ASSERT_THAT(scan, IsOk());
+    auto tasks = (*scan)->PlanFiles();
+    ASSERT_THAT(tasks, IsOk());
+    EXPECT_EQ(TaskPaths(*tasks), TaskPaths(*serial_tasks))
+        << "readahead: " << readahead_bytes;
+  }
+
+  auto invalid_scan =
+      TableScanBuilder(metadata, file_io_).WithManifestReadahead(-1).Build();
+  EXPECT_THAT(invalid_scan, IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(TableScanTest, ParallelPlanningReportsManifestErrors) {
+  auto metadata = PrepareTable({1, 1, 1});
+  ASSERT_TRUE(std::filesystem::remove(manifest_paths_[1]));
+
+  auto scan = TableScanBuilder(metadata, file_io_).WithPlanningParallelism(4).Build();
+  ASSERT_THAT(scan, IsOk());
+  EXPECT_FALSE((*scan)->PlanFiles().has_value());
+}
+
+TEST_F(TableScanTest, PlanFilesWithCallback) {
+  auto metadata = PrepareTable({3, 1, 0, 2, 4, 1, 2});
+  auto scan = TableScanBuilder(metadata, file_io_).Build();
+  ASSERT_THAT(scan, IsOk());
+  auto expected_tasks = (*scan)->PlanFiles();
+  ASSERT_THAT(expected_tasks, IsOk());
+
+  for (int32_t parallelism : {1, 2, 16}) {
+    scan =
+        TableScanBuilder(metadata, file_io_).WithPlanningParallelism(parallelism).Build();
+    ASSERT_THAT(scan, IsOk());
+    std::vector<std::shared_ptr<FileScanTask>> tasks;
+    auto status = (*scan)->PlanFiles([&](std::shared_ptr<FileScanTask> task) -> Status {
+      tasks.push_back(std::move(task));
+      return {};
+    });
+    ASSERT_THAT(status, IsOk());
+    EXPECT_EQ(TaskPaths(tasks), TaskPaths(*expected_tasks))
+        << "parallelism: " << parallelism;
+  }
+}
+
+TEST_F(TableScanTest, PlanFilesStopsOnCallbackError) {
+  auto metadata = PrepareTable({2, 2, 2, 2});
+
+  for (int32_t parallelism : {1, 4}) {
+    auto scan =
+        TableScanBuilder(metadata, file_io_).WithPlanningParallelism(parallelism).Build();
+    ASSERT_THAT(scan, IsOk());
+    std::vector<std::shared_ptr<FileScanTask>> tasks;
+    auto status = (*scan)->PlanFiles([&](std::shared_ptr<FileScanTask> task) -> Status {
+      if (tasks.size() == 3) {
+        return InvalidArgument("enough tasks");
+      }
+      tasks.push_back(std::move(task));
+      return {};
+    });
+    EXPECT_THAT(status, IsError(ErrorKind::kInvalidArgument));
+    EXPECT_EQ(TaskPaths(tasks), (std::vector<std::string>{"data-0-0.parquet",
+                                                          "data-0-1.parquet",
+                                                          "data-1-0.parquet"}))
+        << "parallelism: " << parallelism;
+  }
+}
+
+TEST_F(TableScanTest, PlanFilesStopsAtLimit) {
+  auto metadata = PrepareTable({2, 2, 2, 2});
+
+  for (int32_t parallelism : {1, 4}) {
+    auto scan = TableScanBuilder(metadata, file_io_)
+                    .WithPlanningParallelism(parallelism)
+                    .WithLimit(25)
+                    .Build();
+    ASSERT_THAT(scan, IsOk());
+    auto tasks = (*scan)->PlanFiles();
+    ASSERT_THAT(tasks, IsOk());
+    EXPECT_EQ(TaskPaths(*tasks), (std::vector<std::string>{"data-0-0.parquet",
+                                                           "data-0-1.parquet",
+                                                           "data-1-0.parquet"}))
+        << "parallelism: " << parallelism;
+  }
+
+  auto empty_scan = TableScanBuilder(metadata, file_io_).WithLimit(0).Build();
+  ASSERT_THAT(empty_scan, IsOk());
+  auto empty_tasks = (*empty_scan)->PlanFiles();
+  ASSERT_THAT(empty_tasks, IsOk());
+  EXPECT_TRUE(empty_tasks->empty());
+
+  // The manifests after the limit are not read.
+  for (size_t i = 1; i < manifest_paths_.size(); ++i) {
+    ASSERT_TRUE(std::filesystem::remove(manifest_paths_[i]));
+  }
+  auto scan = TableScanBuilder(metadata, file_io_).WithLimit(20).Build();
+  ASSERT_THAT(scan, IsOk());
+  auto tasks = (*scan)->PlanFiles();
+  ASSERT_THAT(tasks, IsOk());
+  EXPECT_EQ(tasks->size(), 2);
+}
+
+TEST_F(TableScanTest, AggregateFromMetadata) {
+  auto metadata = PrepareTable({2, 1});
+  auto scan = TableScanBuilder(metadata, file_io_).Build();
+  ASSERT_THAT(scan, IsOk());
+  auto values =
+      (*scan)->Aggregate({ScanAggregate::CountStar(), ScanAggregate::Max("id")});
+  ASSERT_THAT(values, IsOk());
+  ASSERT_EQ(values->size(), 2);
+  EXPECT_EQ((*values)[0].value, Literal::Long(30));
+  EXPECT_TRUE((*values)[0].exact);
+  // The data files have no column metrics.
+  EXPECT_FALSE((*values)[1].value.has_value());
+
+  auto limited_scan = TableScanBuilder(metadata, file_io_).WithLimit(5).Build();
+  ASSERT_THAT(limited_scan, IsOk());
+  EXPECT_THAT((*limited_scan)->Aggregate({ScanAggregate::CountStar()}),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(TableScanTest, PlanFilesFromManifestCache) {
+  auto metadata = PrepareTable({2, 1});
+  auto cache = ManifestCache::Make(1 << 20).value();
+  ManifestCache::SetGlobal(cache);
+
+  auto scan = TableScanBuilder(metadata, file_io_).Build();
+  ASSERT_THAT(scan, IsOk());
+  auto tasks = (*scan)->PlanFiles();
+  ASSERT_THAT(tasks, IsOk());
+  EXPECT_EQ(cache->stats().misses, 3);
+  EXPECT_EQ(cache->stats().file_count, 3);
+
+  // The second plan does not read the manifest list nor the manifests.
+  ASSERT_TRUE(std::filesystem::remove(metadata->snapshots[0]->manifest_list));
+  for (const auto& manifest_path : manifest_paths_) {
+    ASSERT_TRUE(std::filesystem::remove(manifest_path));
+  }
+  auto cached_tasks = (*scan)->PlanFiles();
+  ManifestCache::SetGlobal(nullptr);
+  ASSERT_THAT(cached_tasks, IsOk());
+  EXPECT_EQ(TaskPaths(*cached_tasks), TaskPaths(*tasks));
+  EXPECT_EQ(cache->stats().hits, 3);
+}
+
+TEST_F(TableScanTest, SkipManifestsByPartitionSummaries) {
+  auto spec = std::make_shared<PartitionSpec>(
+      schema_, /*spec_id=*/1,
+      std::vector<PartitionField>{PartitionField(1, 1000, "id", Transform::Identity())});
+
+  // Manifest i holds the files of partitions id=10*i and id=10*i+5.
+  std::vector<ManifestFile> manifest_files;
+  for (int32_t i = 0; i < 4; ++i) {
+    auto manifest_file =
+        WriteManifest(spec, {MakeEntry(std::format("data-{}-0.parquet", i),
+                                       {Literal::Int(10 * i)}),
+                             MakeEntry(std::format("data-{}-1.parquet", i),
+                                       {Literal::Int(10 * i + 5)})});
+    manifest_file.partitions = {PartitionFieldSummary{
+        .contains_null = false,
+        .contains_nan = false,
+        .lower_bound = Literal::Int(10 * i).Serialize().value(),
+        .upper_bound = Literal::Int(10 * i + 5).Serialize().value()}};
+    manifest_files.push_back(std::move(manifest_file));
+  }
+  auto metadata = PrepareTable(manifest_files, spec);
+
+  // Remove the manifests that must be skipped, so reading them fails the plan.
+  ASSERT_TRUE(std::filesystem::remove(manifest_paths_[0]));
+  ASSERT_TRUE(std::filesystem::remove(manifest_paths_[3]));
+
+  auto scan = TableScanBuilder(metadata, file_io_)
+                  .WithFilter(Expressions::And(
+                      Expressions::GreaterThanOrEqual("id", Literal::Int(12)),
+                      Expressions::LessThan("id", Literal::Int(30))))
+                  .Build();
+  ASSERT_THAT(scan, IsOk());
+  auto tasks = (*scan)->PlanFiles();
+  ASSERT_THAT(tasks, IsOk());
+  EXPECT_EQ(TaskPaths(*tasks),
+            (std::vector<std::string>{"data-1-0.parquet", "data-1-1.parquet",
+                                      "data-2-0.parquet", "data-2-1.parquet"}));
+}
+
+TEST_F(TableScanTest, SkipManifestsWithoutLiveFiles) {
+  auto deleted = MakeEntry("data-0.parquet");
+  deleted.status = ManifestStatus::kDeleted;
+  auto existing = MakeEntry("data-1.parquet");
+  existing.status = ManifestStatus::kExisting;
+  auto deleted_manifest = WriteManifest(PartitionSpec::Unpartitioned(), {deleted});
+  deleted_manifest.added_files_count = 0;
+  deleted_manifest.existing_files_count = 0;
+  deleted_manifest.deleted_files_count = 1;
+  auto mixed_manifest = WriteManifest(PartitionSpec::Unpartitioned(),
+                                      {deleted, existing, MakeEntry("data-2.parquet")});
+  auto metadata = PrepareTable({deleted_manifest, mixed_manifest});
+
+  // The counts of the first manifest show that all of its entries are deleted, so it
+  // is not read.
+  ASSERT_TRUE(std::filesystem::remove(manifest_paths_[0]));
+
+  auto scan = TableScanBuilder(metadata, file_io_).Build();
+  ASSERT_THAT(scan, IsOk());
+  auto tasks = (*scan)->PlanFiles();
+  ASSERT_THAT(tasks, IsOk());
+  EXPECT_EQ(TaskPaths(*tasks),
+            (std::vector<std::string>{"data-1.parquet", "data-2.parquet"}));
+}
+
+TEST_F(TableScanTest, SkipDataFilesByColumnMetrics) {
+  // File i holds the ids in [10 * i, 10 * i + 9].
+  std::vector<ManifestEntry> entries;
+  for (int32_t i = 0; i < 4; ++i) {
+    auto entry = MakeEntry(std::format("data-{}.parquet", i));
+    entry.data_file->value_counts = {{1, 10}};
+    entry.data_file->null_value_counts = {{1, 0}};
+    entry.data_file->lower_bounds = {{1, Literal::Int(10 * i).Serialize().value()}};
+    entry.data_file->upper_bounds = {{1, Literal::Int(10 * i + 9).Serialize().value()}};
+    entries.push_back(std::move(entry));
+  }
+  auto metadata =
+      PrepareTable(std::vector<ManifestFile>{WriteManifest(PartitionSpec::Unpartitioned(),
+                                                           entries)});
+
+  auto scan = TableScanBuilder(metadata, file_io_)
+                  .WithFilter(Expressions::In("id", {Literal::Int(15), Literal::Int(35)}))
+                  .Build();
+  ASSERT_THAT(scan, IsOk());
+  auto tasks = (*scan)->PlanFiles();
+  ASSERT_THAT(tasks, IsOk());
+  EXPECT_EQ(TaskPaths(*tasks),
+            (std::vector<std::string>{"data-1.parquet", "data-3.parquet"}));
+}
+
+TEST_F(TableScanTest, PlanFilesWithoutColumnStats) {
+  std::vector<ManifestEntry> entries;
+  for (int32_t i = 0; i < 2; ++i) {
+    auto entry = MakeEntry(std::format("data-{}.parquet", i));
+    entry.data_file->value_counts = {{1, 10}};
+    entry.data_file->lower_bounds = {{1, Literal::Int(10 * i).Serialize().value()}};
+    entry.data_file->upper_bounds = {{1, Literal::Int(10 * i + 9).Serialize().value()}};
+    entry.data_file->split_offsets = {4};
+    entries.push_back(std::move(entry));
+  }
+  auto metadata =
+      PrepareTable(std::vector<ManifestFile>{WriteManifest(PartitionSpec::Unpartitioned(),
+                                                           entries)});
+
+  // The metrics still skip files, but are not kept by the planned tasks.
+  auto scan = TableScanBuilder(metadata, file_io_)
+                  .WithFilter(Expressions::GreaterThan("id", Literal::Int(12)))
+                  .WithColumnStats(false)
+                  .Build();
+  ASSERT_THAT(scan, IsOk());
+  auto tasks = (*scan)->PlanFiles();
+  ASSERT_THAT(tasks, IsOk());
+  ASSERT_EQ(TaskPaths(*tasks), (std::vector<std::string>{"data-1.parquet"}));
+  const auto& data_file = *(*tasks)[0]->data_file();
+  EXPECT_TRUE(data_file.value_counts.empty());
+  EXPECT_TRUE(data_file.lower_bounds.empty());
+  EXPECT_TRUE(data_file.upper_bounds.empty());
+  EXPECT_EQ(data_file.split_offsets, std::vector<int64_t>{4});
+  EXPECT_EQ(data_file.record_count, entries[1].data_file->record_count);
+  EXPECT_THAT((*scan)->Aggregate({ScanAggregate::CountStar()}),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(TableScanTest, PlanFilesWithPositionDeletes) {
+  auto spec = std::make_shared<PartitionSpec>(
+      schema_, /*spec_id=*/1,
+      std::vector<PartitionField>{PartitionField(1, 1000, "id", Transform::Identity())});
+
+  auto deletion_vector = MakeDeleteEntry("dv.puffin", {Literal::Int(1)});
+  deletion_vector.data_file->file_format = FileFormatType::kPuffin;
+  deletion_vector.data_file->referenced_data_file = "data-0.parquet";
+  // Position deletes of a single file, known from the bounds of the path column.
+  auto path_deletes = MakeDeleteEntry("path-deletes.parquet", {Literal::Int(2)});
+  const std::string referenced_path = "data-2.parquet";
+  const std::vector<uint8_t> path_bound(referenced_path.begin(), referenced_path.end());
+  path_deletes.data_file->lower_bounds = {
+      {MetadataColumns::kDeleteFilePath.field_id(), path_bound}};
+  path_deletes.data_file->upper_bounds = {
+      {MetadataColumns::kDeleteFilePath.field_id(), path_bound}};
+  auto partition_deletes =
+      MakeDeleteEntry("partition-deletes.parquet", {Literal::Int(1)});
+
+  auto data_manifest =
+      WriteManifest(spec, {MakeEntry("data-0.parquet", {Literal::Int(1)}),
+                           MakeEntry("data-1.parquet", {Literal::Int(1)}),
+                           MakeEntry("data-2.parquet", {Literal::Int(2)}),
+                           MakeEntry("data-3.parquet", {Literal::Int(2)})});
+  auto delete_manifest =
+      WriteManifest(spec, {deletion_vector, path_deletes, partition_deletes},
+                    ManifestFile::Content::kDeletes);
+  auto metadata = PrepareTable({data_manifest, delete_manifest}, spec);
+
+  auto scan = TableScanBuilder(metadata, file_io_).Build();
+  ASSERT_THAT(scan, IsOk());
+  auto tasks = (*scan)->PlanFiles();
+  ASSERT_THAT(tasks, IsOk());
+  ASSERT_EQ(TaskPaths(*tasks),
+            (std::vector<std::string>{"data-0.parquet", "data-1.parquet",
+                                      "data-2.parquet", "data-3.parquet"}));
+
+  auto delete_paths = [](const FileScanTask& task) {
+    std::vector<std::string> paths;
+    for (const auto& delete_file : task.delete_files()) {
+      paths.push_back(delete_file->file_path);
+    }
+    return paths;
+  };
+  // The deletion vector replaces the position deletes of its data file.
+  EXPECT_EQ(delete_paths(*(*tasks)[0]), std::vector<std::string>{"dv.puffin"});
+  EXPECT_EQ(delete_paths(*(*tasks)[1]),
+            std::vector<std::string>{"partition-deletes.parquet"});
+  EXPECT_EQ(delete_paths(*(*tasks)[2]), std::vector<std::string>{"path-deletes.parquet"});
+  EXPECT_TRUE(delete_paths(*(*tasks)[3]).empty());
+  EXPECT_EQ((*tasks)[1]->files_count(), 2);
+  EXPECT_EQ((*tasks)[1]->size_bytes(), 2048);
+}
+
+TEST_F(TableScanTest, ReportsScanMetrics) {
+  auto spec = std::make_shared<PartitionSpec>(
+      schema_, /*spec_id=*/1,
+      std::vector<PartitionField>{PartitionField(1, 1000, "id", Transform::Identity())});
+  auto deletion_vector = MakeDeleteEntry("dv.puffin", {Literal::Int(1)});
+  deletion_vector.data_file->file_format = FileFormatType::kPuffin;
+  deletion_vector.data_file->referenced_data_file = "data-0.parquet";
+
+  // The second data manifest only holds files of partition id=2.
+  auto skipped_manifest =
+      WriteManifest(spec, {MakeEntry("data-3.parquet", {Literal::Int(2)})});
+  skipped_manifest.partitions = {PartitionFieldSummary{
+      .contains_null = false,
+      .contains_nan = false,
+      .lower_bound = Literal::Int(2).Serialize().value(),
+      .upper_bound = Literal::Int(2).Serialize().value()}};
+  auto metadata = PrepareTable(
+      {WriteManifest(spec, {MakeEntry("data-0.parquet", {Literal::Int(1)}),
+                            MakeEntry("data-1.parquet", {Literal::Int(1)}),
+                            MakeEntry("data-2.parquet", {Literal::Int(2)})}),
+       skipped_manifest,
+       WriteManifest(spec,
+                     {deletion_vector,
+                      MakeDeleteEntry("partition-deletes.parquet", {Literal::Int(1)}),
+                      MakeDeleteEntry("other-deletes.parquet", {Literal::Int(2)})},
+                     ManifestFile::Content::kDeletes)},
+      spec);
+
+  auto reporter = std::make_shared<RecordingReporter>();
+  auto scan = TableScanBuilder(metadata, file_io_)
+                  .WithFilter(Expressions::Equal("id", Literal::Int(1)))
+                  .WithMetricsReporter(reporter, TableIdentifier{.name = "t1"})
+                  .Build();
+  ASSERT_THAT(scan, IsOk());
+  auto tasks = (*scan)->PlanFiles();
+  ASSERT_THAT(tasks, IsOk());
+  ASSERT_EQ(TaskPaths(*tasks),
+            (std::vector<std::string>{"data-0.parquet", "data-1.parquet"}));
+
+  ASSERT_EQ(reporter->reports.size(), 1);
+  const auto& report = reporter->reports[0];
+  EXPECT_EQ(report.table.name, "t1");
+  EXPECT_EQ(report.snapshot_id, kSnapshotId);
+  EXPECT_EQ(report.schema_id, 0);
+  EXPECT_EQ(report.projected_field_ids, std::vector<int32_t>{1});
+  const auto& metrics = report.metrics;
+  EXPECT_EQ(metrics.total_planning_duration.count(), 1);
+  EXPECT_EQ(metrics.total_data_manifests.value(), 2);
+  EXPECT_EQ(metrics.total_delete_manifests.value(), 1);
+  EXPECT_EQ(metrics.scanned_data_manifests.value(), 1);
+  EXPECT_EQ(metrics.scanned_delete_manifests.value(), 1);
+  EXPECT_EQ(metrics.skipped_data_manifests.value(), 1);
+  EXPECT_EQ(metrics.skipped_delete_manifests.value(), 0);
+  EXPECT_EQ(metrics.result_data_files.value(), 2);
+  EXPECT_EQ(metrics.skipped_data_files.value(), 1);
+  // The deletes of partition id=2 cannot apply to the planned files.
+  EXPECT_EQ(metrics.skipped_delete_files.value(), 1);
+  EXPECT_EQ(metrics.indexed_delete_files.value(), 2);
+  EXPECT_EQ(metrics.result_delete_files.value(), 2);
+  EXPECT_EQ(metrics.total_file_size_in_bytes.value(), 2048);
+  EXPECT_EQ(metrics.total_delete_file_size_in_bytes.value(), 2048);
+
+  // Every planning reports, including planning with a callback.
+  ASSERT_THAT((*scan)->PlanTasks(), IsOk());
+  EXPECT_EQ(reporter->reports.size(), 2);
+}
+
+TEST_F(TableScanTest, ExplainPlanning) {
+  auto spec = std::make_shared<PartitionSpec>(
+      schema_, /*spec_id=*/1,
+      std::vector<PartitionField>{PartitionField(1, 1000, "id", Transform::Identity())});
+
+  // The column metrics of data-1.parquet show that it holds no id=1.
+  auto out_of_bounds = MakeEntry("data-1.parquet", {Literal::Int(1)});
+  out_of_bounds.data_file->value_counts = {{1, 10}};
+  out_of_bounds.data_file->null_value_counts = {{1, 0}};
+  out_of_bounds.data_file->lower_bounds = {{1, Literal::Int(5).Serialize().value()}};
+  out_of_bounds.data_file->upper_bounds = {{1, Literal::Int(9).Serialize().value()}};
+  auto skipped_manifest =
+      WriteManifest(spec, {MakeEntry("data-3.parquet", {Literal::Int(2)})});
+  skipped_manifest.partitions = {PartitionFieldSummary{
+      .contains_null = false,
+      .contains_nan = false,
+      .lower_bound = Literal::Int(2).Serialize().value(),
+      .upper_bound = Literal::Int(2).Serialize().value()}};
+  auto metadata = PrepareTable(
+      {WriteManifest(spec, {MakeEntry("data-0.parquet", {Literal::Int(1)}),
+                            out_of_bounds,
+                            MakeEntry("data-2.parquet", {Literal::Int(2)})}),
+       skipped_manifest,
+       WriteManifest(spec,
+                     {MakeDeleteEntry("partition-deletes.parquet", {Literal::Int(1)}),
+                      MakeDeleteEntry("other-deletes.parquet", {Literal::Int(2)})},
+                     ManifestFile::Content::kDeletes)},
+      spec);
+
+  auto reporter = std::make_shared<RecordingReporter>();
+  ICEBERG_UNWRAP_OR_FAIL(auto scan,
+                         TableScanBuilder(metadata, file_io_)
+                             .WithFilter(Expressions::Equal("id", Literal::Int(1)))
+                             .WithMetricsReporter(reporter)
+                             .Build());
+  ICEBERG_UNWRAP_OR_FAIL(auto explain, scan->Explain());
+  EXPECT_TRUE(reporter->reports.empty());
+  EXPECT_EQ(explain.snapshot_id, kSnapshotId);
+
+  ASSERT_EQ(explain.manifests.size(), 3);
+  const auto& data_manifest = explain.manifests[0];
+  EXPECT_EQ(data_manifest.manifest_path, manifest_paths_[1]);
+  EXPECT_EQ(data_manifest.outcome, ManifestOutcome::kScanned);
+  EXPECT_EQ(data_manifest.live_files, 3);
+  EXPECT_EQ(data_manifest.files_skipped_by_metrics, 1);
+  EXPECT_EQ(data_manifest.files_skipped_by_partition, 1);
+  EXPECT_EQ(data_manifest.result_files, 1);
+  EXPECT_EQ(data_manifest.matched_delete_files, 1);
+  EXPECT_EQ(explain.manifests[1].outcome, ManifestOutcome::kSkippedByPartitionSummaries);
+  EXPECT_EQ(explain.manifests[1].live_files, 0);
+  const auto& delete_manifest = explain.manifests[2];
+  EXPECT_EQ(delete_manifest.content, ManifestFile::Content::kDeletes);
+  EXPECT_EQ(delete_manifest.outcome, ManifestOutcome::kScanned);
+  EXPECT_EQ(delete_manifest.files_skipped_by_partition, 1);
+  EXPECT_EQ(delete_manifest.result_files, 1);
+
+  EXPECT_EQ(explain.data_files_skipped_by_partition, 1);
+  EXPECT_EQ(explain.data_files_skipped_by_metrics, 1);
+  EXPECT_EQ(explain.metrics.result_data_files.value(), 1);
+  EXPECT_EQ(explain.metrics.result_delete_files.value(), 1);
+
+  // The partition id=1 guarantees the filter, so its rows need no filtering.
+  ASSERT_EQ(explain.residuals.size(), 1);
+  EXPECT_EQ(explain.residuals[0].partition, std::vector<Literal>{Literal::Int(1)});
+  EXPECT_EQ(explain.residuals[0].residual->op(), Expression::Operation::kTrue);
+  EXPECT_EQ(explain.residuals[0].data_files, 1);
+
+  EXPECT_GT(explain.durations.total.count(), 0);
+  EXPECT_LE(explain.durations.plan_data_files, explain.durations.total);
+  EXPECT_NE(explain.ToString().find("skipped by partition summaries"), std::string::npos);
+}
+
+TEST_F(TableScanTest, TasksUseScanMemoryPool) {
+  auto metadata = PrepareTable(std::vector<int32_t>{2});
+
+  auto pool = std::make_shared<TrackingMemoryPool>();
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto scan, TableScanBuilder(metadata, file_io_).WithMemoryPool(pool).Build());
+  ICEBERG_UNWRAP_OR_FAIL(auto tasks, scan->PlanFiles());
+  ASSERT_EQ(tasks.size(), 2);
+  for (const auto& task : tasks) {
+    EXPECT_EQ(task->memory_pool(), pool);
+  }
+}
+
+TEST_F(TableScanTest, PlanCacheRestoresRepeatedScans) {
+  auto metadata = PrepareTable(std::vector<int32_t>{2, 1});
+  ICEBERG_UNWRAP_OR_FAIL(auto cache, ScanPlanCache::Make(1 << 20));
+  auto pool = std::make_shared<TrackingMemoryPool>();
+  auto plan = [&](std::shared_ptr<Expression> filter)
+      -> Result<std::vector<std::shared_ptr<FileScanTask>>> {
+    ICEBERG_ASSIGN_OR_RAISE(auto scan, TableScanBuilder(metadata, file_io_)
+                                           .WithFilter(std::move(filter))
+                                           .WithMemoryPool(pool)
+                                           .WithPlanCache(cache)
+                                           .Build());
+    return scan->PlanFiles();
+  };
+
+  ICEBERG_UNWRAP_OR_FAIL(auto planned,
+                         plan(Expressions::GreaterThan("id", Literal::Int(12))));
+  ASSERT_EQ(planned.size(), 3);
+  EXPECT_EQ(cache->stats().misses, 1);
+  EXPECT_EQ(cache->stats().plan_count, 1);
+
+  // The cached plan is restored without reading the manifests, for a filter that only
+  // differs in how it is negated.
+  for (const auto& manifest_path : manifest_paths_) {
+    ASSERT_TRUE(std::filesystem::remove(manifest_path));
+  }
+  ICEBERG_UNWRAP_OR_FAIL(auto restored,
+                         plan(Expressions::Not(Expressions::LessThanOrEqual(
+                             "id", Literal::Int(12)))));
+  EXPECT_EQ(cache->stats().hits, 1);
+  EXPECT_EQ(TaskPaths(restored), TaskPaths(planned));
+  for (const auto& task : restored) {
+    EXPECT_EQ(task->memory_pool(), pool);
+    ASSERT_NE(task->residual(), nullptr);
+    EXPECT_EQ(task->residual()->ToString(), planned[0]->residual()->ToString());
+  }
+
+  // Another filter is another plan.
+  EXPECT_FALSE(plan(Expressions::LessThan("id", Literal::Int(12))).has_value());
+  EXPECT_EQ(cache->stats().misses, 2);
+}
+
+TEST_F(TableScanTest, SampleFilesAndRowGroups) {
+  std::vector<ManifestEntry> entries;
+  for (int i = 0; i < 100; ++i) {
+    entries.push_back(MakeEntry(std::format("file-{}.parquet", i)));
+  }
+  auto metadata = PrepareTable(
+      std::vector<ManifestFile>{WriteManifest(PartitionSpec::Unpartitioned(), entries)});
+  auto plan = [&](double fraction, uint32_t seed, SampleGranularity granularity)
+      -> Result<std::vector<std::shared_ptr<FileScanTask>>> {
+    ICEBERG_ASSIGN_OR_RAISE(auto scan, TableScanBuilder(metadata, file_io_)
+                                           .WithSample(fraction, seed, granularity)
+                                           .Build());
+    EXPECT_DOUBLE_EQ(scan->sample_scale_factor(), 1.0 / fraction);
+    return scan->PlanFiles();
+  };
+
+  // Files are sampled by the hash of their path, so that every scan with the same
+  // seed plans the same files.
+  ICEBERG_UNWRAP_OR_FAIL(auto sampled, plan(0.25, 7, SampleGranularity::kFile));
+  EXPECT_GT(sampled.size(), 10);
+  EXPECT_LT(sampled.size(), 40);
+  const ScanSample sample{.fraction = 0.25, .seed = 7};
+  for (const auto& task : sampled) {
+    EXPECT_TRUE(sample.ContainsFile(task->data_file()->file_path));
+    EXPECT_FALSE(task->row_group_sample().has_value());
+  }
+  ICEBERG_UNWRAP_OR_FAIL(auto repeated, plan(0.25, 7, SampleGranularity::kFile));
+  EXPECT_EQ(TaskPaths(repeated), TaskPaths(sampled));
+  ICEBERG_UNWRAP_OR_FAIL(auto reseeded, plan(0.25, 8, SampleGranularity::kFile));
+  EXPECT_NE(TaskPaths(reseeded), TaskPaths(sampled));
+  ICEBERG_UNWRAP_OR_FAIL(auto all, plan(1.0, 7, SampleGranularity::kFile));
+  EXPECT_EQ(all.size(), 100);
+
+  // Every file is planned to read a sample of its row groups.
+  ICEBERG_UNWRAP_OR_FAIL(auto row_groups, plan(0.5, 7, SampleGranularity::kRowGroup));
+  ASSERT_EQ(row_groups.size(), 100);
+  ASSERT_TRUE(row_groups[0]->row_group_sample().has_value());
+  EXPECT_EQ(row_groups[0]->row_group_sample()->fraction, 0.5);
+  EXPECT_EQ(row_groups[0]->row_group_sample()->seed, 7u);
+  EXPECT_EQ(row_groups[0]->estimated_row_count(), 5);
+
+  EXPECT_THAT(TableScanBuilder(metadata, file_io_).WithSample(0).Build(),
+              IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT(TableScanBuilder(metadata, file_io_).WithSample(1.5).Build(),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(TableScanTest, PlanSpilledTasks) {
+  std::vector<ManifestEntry> entries;
+  for (int i = 0; i < 20; ++i) {
+    entries.push_back(MakeEntry(std::format("file-{}.parquet", i)));
+  }
+  auto metadata = PrepareTable(
+      std::vector<ManifestFile>{WriteManifest(PartitionSpec::Unpartitioned(), entries)});
+  auto builder = [&]() {
+    return TableScanBuilder(metadata, file_io_)
+        .WithOption(TableProperties::kSplitSize.key(), "3072")
+        .WithOption(TableProperties::kSplitLookback.key(), "2");
+  };
+  ICEBERG_UNWRAP_OR_FAIL(auto scan, builder().Build());
+  ICEBERG_UNWRAP_OR_FAIL(auto tasks, scan->PlanTasks());
+  ASSERT_EQ(tasks.size(), 7);
+  EXPECT_THAT(scan->PlanSpilledTasks(), IsError(ErrorKind::kInvalidArgument));
+
+  // With a budget of a single byte, every task is spilled once it is packed.
+  const auto directory = CreateTempDirectory() + "/spill";
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto spilling_scan,
+      builder().WithSpill({.directory = directory, .memory_budget_bytes = 1}).Build());
+  ICEBERG_UNWRAP_OR_FAIL(auto spill, spilling_scan->PlanSpilledTasks());
+  EXPECT_EQ(spill->task_count(), static_cast<int64_t>(tasks.size()));
+  EXPECT_GT(spill->spilled_bytes(), 0);
+  EXPECT_EQ(spill->buffered_bytes(), 0);
+
+  std::vector<std::string> paths;
+  ASSERT_THAT(spill->ForEach([&](std::shared_ptr<CombinedScanTask> task) -> Status {
+    for (const auto& file_task : task->tasks()) {
+      paths.push_back(file_task->data_file()->file_path);
+    }
+    return {};
+  }),
+              IsOk());
+  std::vector<std::string> planned_paths;
+  for (const auto& task : tasks) {
+    for (const auto& file_task : task->tasks()) {
+      planned_paths.push_back(file_task->data_file()->file_path);
+    }
+  }
+  EXPECT_EQ(paths, planned_paths);
+
+  // The spill file is removed with the spilled tasks.
+  spill.reset();
+  EXPECT_TRUE(std::filesystem::is_empty(directory));
+
+  EXPECT_THAT(builder().WithSpill({.directory = directory}).Build(),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(TableScanTest, PlanFilesWithEqualityDeletes) {
+  auto equality_deletes = MakeDeleteEntry("eq-deletes.parquet");
+  equality_deletes.sequence_number = 2;
+  equality_deletes.data_file->content = DataFile::Content::kEqualityDeletes;
+  equality_deletes.data_file->equality_ids = {1};
+  // Equality deletes only apply to data files with a lower sequence number.
+  auto old_file = MakeEntry("old.parquet");
+  old_file.sequence_number = 1;
+  auto new_file = MakeEntry("new.parquet");
+  new_file.sequence_number = 2;
+  auto metadata = PrepareTable(std::vector<ManifestFile>{
+      WriteManifest(PartitionSpec::Unpartitioned(), {old_file, new_file}),
+      WriteManifest(PartitionSpec::Unpartitioned(), {equality_deletes},
+                    ManifestFile::Content::kDeletes)});
+
+  auto scan = TableScanBuilder(metadata, file_io_).Build();
+  ASSERT_THAT(scan, IsOk());
+  auto tasks = (*scan)->PlanFiles();
+  ASSERT_THAT(tasks, IsOk());
+  ASSERT_EQ(TaskPaths(*tasks), (std::vector<std::string>{"old.parquet", "new.parquet"}));
+  ASSERT_EQ((*tasks)[0]->delete_files().size(), 1);
+  EXPECT_EQ((*tasks)[0]->delete_files()[0]->file_path, "eq-deletes.parquet");
+  EXPECT_TRUE((*tasks)[1]->delete_files().empty());
+}
+
+TEST_F(TableScanTest, PlanTasksSplitsLargeFiles) {
+  auto with_offsets = MakeEntry("with-offsets.parquet");
+  with_offsets.data_file->file_size_in_bytes = 250;
+  with_offsets.data_file->record_count = 1000;
+  with_offsets.data_file->split_offsets = {4, 60, 120, 200};
+  auto without_offsets = MakeEntry("without-offsets.parquet");
+  without_offsets.data_file->file_size_in_bytes = 250;
+  auto small = MakeEntry("small.parquet");
+  small.data_file->file_size_in_bytes = 40;
+  auto metadata = PrepareTable(std::vector<ManifestFile>{WriteManifest(
+      PartitionSpec::Unpartitioned(), {with_offsets, without_offsets, small})});
+  // Scan options take precedence over table properties.
+  metadata->properties[TableProperties::kSplitSize.key()] = "1000";
+
+  // Opening a file costs a whole split, so that every split gets its own task.
+  auto scan = TableScanBuilder(metadata, file_io_)
+                  .WithOption(TableProperties::kSplitSize.key(), "100")
+                  .WithOption(TableProperties::kSplitOpenFileCost.key(), "100")
+                  .WithOption(TableProperties::kSplitLookback.key(), "1")
+                  .Build();
+  ASSERT_THAT(scan, IsOk());
+  auto tasks = (*scan)->PlanTasks();
+  ASSERT_THAT(tasks, IsOk());
+
+  std::vector<std::tuple<std::string, int64_t, int64_t>> ranges;
+  for (const auto& combined_task : *tasks) {
+    ASSERT_EQ(combined_task->tasks().size(), 1);
+    const auto& task = combined_task->tasks().front();
+    ranges.emplace_back(task->data_file()->file_path, task->start(), task->length());
+  }
+  EXPECT_EQ(ranges, (std::vector<std::tuple<std::string, int64_t, int64_t>>{
+                        {"with-offsets.parquet", 4, 56},
+                        {"with-offsets.parquet", 60, 60},
+                        {"with-offsets.parquet", 120, 80},
+                        {"with-offsets.parquet", 200, 50},
+                        {"without-offsets.parquet", 0, 100},
+                        {"without-offsets.parquet", 100, 100},
+                        {"without-offsets.parquet", 200, 50},
+                        {"small.parquet", 0, 40},
+                    }));
+  EXPECT_EQ((*tasks)[2]->size_bytes(), 80);
+  EXPECT_EQ((*tasks)[2]->estimated_row_count(), 320);
+}
+
+TEST_F(TableScanTest, PlanTasksWeighsProjectedColumnSizes) {
+  // Column 2 is not read by the scan, and is most of the bytes of the files.
+  auto narrow = MakeEntry("narrow.parquet");
+  narrow.data_file->file_size_in_bytes = 1000;
+  narrow.data_file->column_sizes = {{1, 50}, {2, 950}};
+  auto wide = MakeEntry("wide.parquet");
+  wide.data_file->file_size_in_bytes = 1000;
+  wide.data_file->column_sizes = {{1, 250}, {2, 750}};
+  auto unmeasured = MakeEntry("unmeasured.parquet");
+  unmeasured.data_file->file_size_in_bytes = 40;
+  auto metadata = PrepareTable(std::vector<ManifestFile>{WriteManifest(
+      PartitionSpec::Unpartitioned(), {narrow, wide, unmeasured})});
+  metadata->properties[TableProperties::kSplitSize.key()] = "100";
+  metadata->properties[TableProperties::kSplitOpenFileCost.key()] = "100";
+
+  ICEBERG_UNWRAP_OR_FAIL(auto scan, TableScanBuilder(metadata, file_io_).Build());
+  ICEBERG_UNWRAP_OR_FAIL(auto tasks, scan->PlanTasks());
+  EXPECT_EQ(tasks.size(), 21);
+
+  ICEBERG_UNWRAP_OR_FAIL(
+      scan, TableScanBuilder(metadata, file_io_)
+                .WithOption(TableProperties::kSplitProjectedSizeEnabled.key(), "true")
+                .Build());
+  ICEBERG_UNWRAP_OR_FAIL(tasks, scan->PlanTasks());
+  std::vector<std::tuple<std::string, int64_t, int64_t, int64_t>> ranges;
+  for (const auto& combined_task : tasks) {
+    ASSERT_EQ(combined_task->tasks().size(), 1);
+    const auto& task = combined_task->tasks().front();
+    ranges.emplace_back(task->data_file()->file_path, task->start(), task->length(),
+                        task->size_bytes());
+  }
+  // A file weighs the sizes of the projected columns, and its ranges their share of
+  // them, so that a range holds a split size of projected bytes.
+  EXPECT_EQ(ranges, (std::vector<std::tuple<std::string, int64_t, int64_t, int64_t>>{
+                        {"narrow.parquet", 0, 1000, 50},
+                        {"wide.parquet", 0, 400, 100},
+                        {"wide.parquet", 400, 400, 100},
+                        {"wide.parquet", 800, 200, 50},
+                        {"unmeasured.parquet", 0, 40, 40},
+                    }));
+  EXPECT_EQ(tasks[0]->tasks().front()->projected_file_size(), 50);
+  EXPECT_EQ(tasks[4]->tasks().front()->projected_file_size(), std::nullopt);
+}
+
+TEST_F(TableScanTest, PlanTasksPacksSmallFiles) {
+  auto metadata = PrepareTableWithFileSizes({30, 5, 60, 50, 20});
+  metadata->properties[TableProperties::kSplitSize.key()] = "100";
+  metadata->properties[TableProperties::kSplitOpenFileCost.key()] = "10";
+
+  auto scan = TableScanBuilder(metadata, file_io_).Build();
+  ASSERT_THAT(scan, IsOk());
+  auto tasks = (*scan)->PlanTasks();
+  ASSERT_THAT(tasks, IsOk());
+  EXPECT_EQ(TaskPaths(*tasks), (std::vector<std::vector<std::string>>{
+                                   {"data-0.parquet", "data-1.parquet", "data-2.parquet"},
+                                   {"data-3.parquet", "data-4.parquet"},
+                               }));
+  EXPECT_EQ((*tasks)[0]->size_bytes(), 95);
+  EXPECT_EQ((*tasks)[0]->files_count(), 3);
+  EXPECT_EQ((*tasks)[0]->estimated_row_count(), 30);
+}
+
+TEST_F(TableScanTest, PlanTasksLookback) {
+  auto metadata = PrepareTableWithFileSizes({60, 60, 30});
+  metadata->properties[TableProperties::kSplitSize.key()] = "100";
+  metadata->properties[TableProperties::kSplitOpenFileCost.key()] = "1";
+
+  auto scan = TableScanBuilder(metadata, file_io_).Build();
+  ASSERT_THAT(scan, IsOk());
+  auto tasks = (*scan)->PlanTasks();
+  ASSERT_THAT(tasks, IsOk());
+  EXPECT_EQ(TaskPaths(*tasks), (std::vector<std::vector<std::string>>{
+                                   {"data-0.parquet", "data-2.parquet"},
+                                   {"data-1.parquet"},
+                               }));
+
+  // With a single open bin, the first bin is closed before the last file is planned.
+  scan = TableScanBuilder(metadata, file_io_)
+             .WithOption(TableProperties::kSplitLookback.key(), "1")
+             .Build();
+  ASSERT_THAT(scan, IsOk());
+  tasks = (*scan)->PlanTasks();
+  ASSERT_THAT(tasks, IsOk());
+  EXPECT_EQ(TaskPaths(*tasks), (std::vector<std::vector<std::string>>{
+                                   {"data-0.parquet"},
+                                   {"data-1.parquet", "data-2.parquet"},
+                               }));
+}
+
+TEST_F(TableScanTest, PlanTasksByPartition) {
+  auto bucket_spec = std::make_shared<PartitionSpec>(
+      schema_, /*spec_id=*/1,
+      std::vector<PartitionField>{
+          PartitionField(1, 1000, "id_bucket", Transform::Bucket(4))});
+  // The evolved spec keeps the bucket field after a new field, under another name.
+  auto evolved_spec = std::make_shared<PartitionSpec>(
+      schema_, /*spec_id=*/2,
+      std::vector<PartitionField>{
+          PartitionField(1, 1001, "id", Transform::Identity()),
+          PartitionField(1, 1000, "bucket", Transform::Bucket(4))});
+  auto metadata = PrepareTable(
+      std::vector<ManifestFile>{
+          WriteManifest(bucket_spec,
+                        {MakeEntry("a.parquet", {Literal::Int(0)}),
+                         MakeEntry("b.parquet", {Literal::Int(1)}),
+                         MakeEntry("c.parquet", {Literal::Null(int32())})}),
+          WriteManifest(evolved_spec,
+                        {MakeEntry("d.parquet", {Literal::Int(7), Literal::Int(1)}),
+                         MakeEntry("e.parquet", {Literal::Int(8), Literal::Int(0)})})},
+      evolved_spec);
+  metadata->partition_specs.push_back(bucket_spec);
+
+  auto scan = TableScanBuilder(metadata, file_io_).Build();
+  ASSERT_THAT(scan, IsOk());
+  ICEBERG_UNWRAP_OR_FAIL(auto tasks, (*scan)->PlanTasksByPartition({"bucket"}));
+  ASSERT_EQ(tasks.size(), 3);
+  EXPECT_TRUE(tasks[0]->grouping_key()[0].IsNull());
+  EXPECT_EQ(TaskPaths(tasks[0]->tasks()), (std::vector<std::string>{"c.parquet"}));
+  EXPECT_EQ(tasks[1]->grouping_key(), (std::vector<Literal>{Literal::Int(0)}));
+  EXPECT_EQ(TaskPaths(tasks[1]->tasks()),
+            (std::vector<std::string>{"a.parquet", "e.parquet"}));
+  EXPECT_EQ(tasks[2]->grouping_key(), (std::vector<Literal>{Literal::Int(1)}));
+  EXPECT_EQ(TaskPaths(tasks[2]->tasks()),
+            (std::vector<std::string>{"b.parquet", "d.parquet"}));
+
+  EXPECT_THAT((*scan)->PlanTasksByPartition({"id_bucket"}),
+              IsError(ErrorKind::kInvalidArgument));
+  EXPECT_THAT((*scan)->PlanTasksByPartition({}), IsError(ErrorKind::kInvalidArgument));
+  // The files of the first spec cannot be grouped by a field it does not have.
+  EXPECT_THAT((*scan)->PlanTasksByPartition({"bucket", "id"}),
+              IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(TableScanTest, PlanShards) {
+  auto metadata = PrepareTable({4, 1, 2, 3, 1});
+  auto scan = TableScanBuilder(metadata, file_io_).Build();
+  ASSERT_THAT(scan, IsOk());
+
+  ICEBERG_UNWRAP_OR_FAIL(auto shards, (*scan)->PlanShards(2));
+  ASSERT_EQ(shards.size(), 2);
+  std::vector<std::vector<std::shared_ptr<FileScanTask>>> shard_tasks;
+  std::vector<std::string> paths;
+  for (const auto& shard : shards) {
+    EXPECT_EQ(shard.snapshot_id, kSnapshotId);
+    EXPECT_FALSE(shard.data_manifests.empty());
+    // Shards are planned from their serialized form, like on another process.
+    ICEBERG_UNWRAP_OR_FAIL(auto data, SerializeManifestShard(shard));
+    ICEBERG_UNWRAP_OR_FAIL(auto restored, DeserializeManifestShard(data));
+    ICEBERG_UNWRAP_OR_FAIL(auto tasks, (*scan)->PlanShard(restored));
+    std::ranges::copy(TaskPaths(tasks), std::back_inserter(paths));
+    shard_tasks.push_back(std::move(tasks));
+  }
+  // Every data manifest is in one shard, in the order of the manifest list.
+  std::vector<size_t> manifest_positions;
+  for (const auto& shard : shards) {
+    std::vector<size_t> positions;
+    for (const auto& manifest_file : shard.data_manifests) {
+      auto it = std::ranges::find(manifest_paths_, manifest_file.manifest_path);
+      positions.push_back(it - manifest_paths_.begin());
+    }
+    EXPECT_TRUE(std::ranges::is_sorted(positions));
+    std::ranges::copy(positions, std::back_inserter(manifest_positions));
+  }
+  std::ranges::sort(manifest_positions);
+  EXPECT_EQ(manifest_positions, (std::vector<size_t>{0, 1, 2, 3, 4}));
+  ICEBERG_UNWRAP_OR_FAIL(auto all_tasks, (*scan)->PlanFiles());
+  auto expected_paths = TaskPaths(all_tasks);
+  std::ranges::sort(paths);
+  std::ranges::sort(expected_paths);
+  EXPECT_EQ(paths, expected_paths);
+
+  ICEBERG_UNWRAP_OR_FAIL(auto merged_tasks, (*scan)->MergeShardTasks(shard_tasks));
+  int32_t merged_files = 0;
+  for (const auto& task : merged_tasks) {
+    merged_files += task->files_count();
+  }
+  EXPECT_EQ(merged_files, 11);
+
+  // There is at most one shard per data manifest.
+  ICEBERG_UNWRAP_OR_FAIL(shards, (*scan)->PlanShards(10));
+  EXPECT_EQ(shards.size(), 5);
+  EXPECT_THAT((*scan)->PlanShards(0), IsError(ErrorKind::kInvalidArgument));
+
+  shards[0].snapshot_id = kSnapshotId + 1;
+  EXPECT_THAT((*scan)->PlanShard(shards[0]), IsError(ErrorKind::kInvalidArgument));
+
+  scan = TableScanBuilder(metadata, file_io_).WithLimit(5).Build();
+  ASSERT_THAT(scan, IsOk());
+  EXPECT_THAT((*scan)->PlanShards(2), IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(TableScanTest, PlanOrderedFiles) {
+  // Each file is written in the sort order and holds the ids in [lower, upper], with
+  // `nulls` null ids.
+  auto make_entry = [this](const std::string& path, std::optional<int32_t> lower,
+                           std::optional<int32_t> upper, int64_t nulls) {
+    auto entry = MakeEntry(path);
+    entry.data_file->sort_order_id = 1;
+    entry.data_file->value_counts = {{1, 10}};
+    entry.data_file->null_value_counts = {{1, nulls}};
+    if (lower.has_value()) {
+      entry.data_file->lower_bounds = {{1, Literal::Int(*lower).Serialize().value()}};
+      entry.data_file->upper_bounds = {{1, Literal::Int(*upper).Serialize().value()}};
+    }
+    return entry;
+  };
+  auto prepare_table = [this](const std::vector<ManifestEntry>& entries) {
+    auto metadata = PrepareTable(std::vector<ManifestFile>{
+        WriteManifest(PartitionSpec::Unpartitioned(), entries)});
+    metadata->sort_orders = {std::make_shared<SortOrder>(
+        1, std::vector<SortField>{SortField(1, Transform::Identity(),
+                                            SortDirection::kAscending,
+                                            NullOrder::kLast)})};
+    metadata->default_sort_order_id = 1;
+    return metadata;
+  };
+  auto group_paths = [](const OrderedScanPlan& plan) {
+    std::vector<std::vector<std::string>> paths;
+    for (const auto& group : plan.groups) {
+      paths.push_back(TaskPaths(group));
+    }
+    return paths;
+  };
+
+  auto metadata = prepare_table(
+      {make_entry("a.parquet", 20, 29, 0), make_entry("b.parquet", 0, 9, 0),
+       make_entry("c.parquet", 5, 15, 0), make_entry("d.parquet", 30, 39, 2),
+       make_entry("e.parquet", std::nullopt, std::nullopt, 10)});
+  auto scan = TableScanBuilder(metadata, file_io_).Build();
+  ASSERT_THAT(scan, IsOk());
+  ICEBERG_UNWRAP_OR_FAIL(auto plan, (*scan)->PlanOrderedFiles());
+  EXPECT_EQ(plan.sort_order->order_id(), 1);
+  // The nulls of d.parquet sort last, with the nulls of e.parquet.
+  EXPECT_EQ(group_paths(plan), (std::vector<std::vector<std::string>>{
+                                   {"b.parquet", "c.parquet"},
+                                   {"a.parquet"},
+                                   {"d.parquet"},
+                                   {"e.parquet"}}));
+  EXPECT_FALSE(plan.globally_ordered);
+
+  metadata = prepare_table({make_entry("a.parquet", 20, 29, 0),
+                            make_entry("b.parquet", 10, 20, 0)});
+  scan = TableScanBuilder(metadata, file_io_).Build();
+  ASSERT_THAT(scan, IsOk());
+  ICEBERG_UNWRAP_OR_FAIL(plan, (*scan)->PlanOrderedFiles());
+  EXPECT_EQ(group_paths(plan), (std::vector<std::vector<std::string>>{
+                                   {"b.parquet"}, {"a.parquet"}}));
+  EXPECT_TRUE(plan.globally_ordered);
+
+  // A file without metrics may hold rows anywhere in the order.
+  metadata = prepare_table({make_entry("a.parquet", 20, 29, 0),
+                            make_entry("b.parquet", 0, 9, 0), MakeEntry("c.parquet")});
+  scan = TableScanBuilder(metadata, file_io_).Build();
+  ASSERT_THAT(scan, IsOk());
+  ICEBERG_UNWRAP_OR_FAIL(plan, (*scan)->PlanOrderedFiles());
+  EXPECT_EQ(group_paths(plan), (std::vector<std::vector<std::string>>{
+                                   {"c.parquet", "b.parquet", "a.parquet"}}));
+  EXPECT_FALSE(plan.globally_ordered);
+  // The file of c.parquet is not written in the sort order, so it cannot be merged.
+  EXPECT_THAT((*scan)->ToSortedArrow(1), IsError(ErrorKind::kNotSupported));
+
+  scan = TableScanBuilder(metadata, file_io_).WithLimit(10).Build();
+  ASSERT_THAT(scan, IsOk());
+  EXPECT_THAT((*scan)->PlanOrderedFiles(), IsError(ErrorKind::kInvalidArgument));
+
+  metadata->sort_orders = {SortOrder::Unsorted()};
+  metadata->default_sort_order_id = SortOrder::Unsorted()->order_id();
+  scan = TableScanBuilder(metadata, file_io_).Build();
+  ASSERT_THAT(scan, IsOk());
+  EXPECT_THAT((*scan)->PlanOrderedFiles(), IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(TableScanTest, PlanTasksInvalidSplitProperties) {
+  auto metadata = PrepareTableWithFileSizes({10});
+  metadata->properties[TableProperties::kSplitSize.key()] = "128MB";
+  auto scan = TableScanBuilder(metadata, file_io_).Build();
+  ASSERT_THAT(scan, IsOk());
+  EXPECT_THAT((*scan)->PlanTasks(), IsError(ErrorKind::kInvalidArgument));
+
+  scan = TableScanBuilder(metadata, file_io_)
+             .WithOption(TableProperties::kSplitSize.key(), "1024")
+             .WithOption(TableProperties::kSplitLookback.key(), "0")
+             .Build();
+  ASSERT_THAT(scan, IsOk());
+  EXPECT_THAT((*scan)->PlanTasks(), IsError(ErrorKind::kInvalidArgument));
+}
+
+TEST_F(TableScanTest, InvalidPlanningParallelism) {
+  auto metadata = PrepareTable({1});
+  auto scan = TableScanBuilder(metadata, file_io_).WithPlanningParallelism(0).Build();
+  EXPECT_THAT(scan, IsError(ErrorKind::kInvalidArgument));
+}
+
+}  // namespace iceberg
@@ -0,0 +1,179 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/table_stats.h"
+
+#include <format>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/fast_append.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/row_delta.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/test/table_test_base.h"
+#include "iceberg/type.h"
+#include "iceberg/util/persistent_vector.h"
+
+namespace iceberg {
+
+class TableStatsTest : public TableTestBase {
+ protected:
+  void SetUp() override {
+    TableTestBase::SetUp();
+    ASSERT_NO_FATAL_FAILURE(CreateTable());
+  }
+
+  // Registers a table with the metadata under a name and loads it.
+  std::shared_ptr<Table> RegisterMetadata(const std::string& name,
+                                          const TableMetadata& metadata) {
+    auto metadata_location =
+        std::format("{}/metadata/{}.metadata.json", table_location_, name);
+    EXPECT_THAT(TableMetadataUtil::Write(*file_io_, metadata_location, metadata), IsOk());
+    TableIdentifier identifier{.ns = {}, .name = name};
+    EXPECT_THAT(catalog_->RegisterTable(identifier, metadata_location), IsOk());
+    auto table = catalog_->LoadTable(identifier);
+    EXPECT_THAT(table, IsOk());
+    return std::move(table.value());
+  }
+
+  static std::shared_ptr<DataFile> MakeDataFile(const std::string& path,
+                                                int64_t record_count) {
+    return std::make_shared<DataFile>(DataFile{
+        .file_path = path,
+        .file_format = FileFormatType::kParquet,
+        .record_count = record_count,
+        .file_size_in_bytes = record_count * 10,
+    });
+  }
+
+  // Appends two data files and a position delete file of the first one.
+  void CommitFiles(const std::shared_ptr<Table>& table) {
+    FastAppend append(table);
+    append.AppendFile(MakeDataFile("/data/a.parquet", 10))
+        .AppendFile(MakeDataFile("/data/b.parquet", 20));
+    ASSERT_THAT(append.Commit(), IsOk());
+    RowDelta delta(table);
+    delta.AddDeletes(std::make_shared<DataFile>(DataFile{
+        .content = DataFile::Content::kPositionDeletes,
+        .file_path = "/data/a-pos.parquet",
+        .file_format = FileFormatType::kParquet,
+        .record_count = 2,
+        .file_size_in_bytes = 5,
+        .referenced_data_file = "/data/a.parquet",
+    }));
+    ASSERT_THAT(delta.Commit(), IsOk());
+  }
+
+  // Registers a copy of the table whose current snapshot has no totals.
+  std::shared_ptr<Table> RegisterWithoutTotals(const Table& table) {
+    TableMetadata metadata = *table.metadata();
+    PersistentVector<std::shared_ptr<Snapshot>> snapshots;
+    for (const auto& snapshot : metadata.snapshots) {
+      auto stripped = std::make_shared<Snapshot>(*snapshot);
+      std::erase_if(stripped->summary,
+                    [](const auto& entry) { return entry.first.starts_with("total-"); });
+      snapshots.push_back(std::move(stripped));
+    }
+    metadata.snapshots = std::move(snapshots);
+    return RegisterMetadata("t2", metadata);
+  }
+};
+
+TEST_F(TableStatsTest, EmptyTable) {
+  ICEBERG_UNWRAP_OR_FAIL(auto stats, ComputeTableStats(*table_->metadata(), file_io_));
+  EXPECT_EQ(stats, (TableStats{.total_file_size = 0}));
+}
+
+TEST_F(TableStatsTest, ReadsSummaryTotals) {
+  ASSERT_NO_FATAL_FAILURE(CommitFiles(table_));
+  ICEBERG_UNWRAP_OR_FAIL(auto snapshot, table_->metadata()->Snapshot());
+
+  ICEBERG_UNWRAP_OR_FAIL(auto stats, ComputeTableStats(*table_->metadata(), file_io_));
+  EXPECT_EQ(stats, (TableStats{.snapshot_id = snapshot->snapshot_id,
+                               .record_count = 30,
+                               .data_file_count = 2,
+                               .delete_file_count = 1,
+                               .total_file_size = 305,
+                               .source = TableStatsSource::kSummary}));
+
+  // An older snapshot is counted from its own summary.
+  ASSERT_TRUE(snapshot->parent_snapshot_id.has_value());
+  ICEBERG_UNWRAP_OR_FAIL(
+      stats, ComputeTableStats(*table_->metadata(), file_io_,
+                               {.snapshot_id = snapshot->parent_snapshot_id}));
+  EXPECT_EQ(stats.delete_file_count, 0);
+  EXPECT_EQ(stats.total_file_size, 300);
+
+  EXPECT_THAT(ComputeTableStats(*table_->metadata(), file_io_, {.snapshot_id = 42}),
+              IsError(ErrorKind::kNotFound));
+}
+
+TEST_F(TableStatsTest, FallsBackToManifests) {
+  ASSERT_NO_FATAL_FAILURE(CommitFiles(table_));
+  auto table = RegisterWithoutTotals(*table_);
+  const int64_t snapshot_id = table->metadata()->current_snapshot_id;
+
+  // Without totals, the counts come from the manifest list, which has no sizes.
+  ICEBERG_UNWRAP_OR_FAIL(auto stats, ComputeTableStats(*table->metadata(), file_io_));
+  EXPECT_EQ(stats, (TableStats{.snapshot_id = snapshot_id,
+                               .record_count = 30,
+                               .data_file_count = 2,
+                               .delete_file_count = 1,
+                               .source = TableStatsSource::kManifestList}));
+
+  ICEBERG_UNWRAP_OR_FAIL(stats, ComputeTableStats(*table->metadata(), file_io_,
+                                                  {.require_file_size = true}));
+  EXPECT_EQ(stats, (TableStats{.snapshot_id = snapshot_id,
+                               .record_count = 30,
+                               .data_file_count = 2,
+                               .delete_file_count = 1,
+                               .total_file_size = 305,
+                               .source = TableStatsSource::kManifests}));
+}
+
+TEST_F(TableStatsTest, CommitRestoresMissingTotals) {
+  ASSERT_NO_FATAL_FAILURE(CommitFiles(table_));
+  auto table = RegisterWithoutTotals(*table_);
+
+  FastAppend append(table);
+  append.AppendFile(MakeDataFile("/data/c.parquet", 5));
+  ASSERT_THAT(append.Commit(), IsOk());
+
+  // The totals of files and records are recounted from the manifest list of the new
+  // snapshot, the size cannot be.
+  ICEBERG_UNWRAP_OR_FAIL(auto snapshot, table->metadata()->Snapshot());
+  EXPECT_EQ(snapshot->summary.at(SnapshotSummaryFields::kTotalRecords), "35");
+  EXPECT_EQ(snapshot->summary.at(SnapshotSummaryFields::kTotalDataFiles), "3");
+  EXPECT_EQ(snapshot->summary.at(SnapshotSummaryFields::kTotalDeleteFiles), "1");
+  EXPECT_FALSE(snapshot->summary.contains(SnapshotSummaryFields::kTotalFileSize));
+  ICEBERG_UNWRAP_OR_FAIL(auto stats, ComputeTableStats(*table->metadata(), file_io_));
+  EXPECT_EQ(stats.source, TableStatsSource::kSummary);
+  EXPECT_EQ(stats.record_count, 35);
+  EXPECT_EQ(stats.total_file_size, std::nullopt);
+}
+
+}  // namespace iceberg
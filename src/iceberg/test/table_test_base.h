@@ -0,0 +1,127 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/arrow/arrow_fs_file_io_internal.h"
+#include "iceberg/avro/avro_register.h"
+#include "iceberg/catalog/memory/in_memory_catalog.h"
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/sort_order.h"
+#include "iceberg/table.h"
+#include "iceberg/table_identifier.h"
+#include "iceberg/table_metadata.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/test/temp_file_test_base.h"
+#include "iceberg/type.h"
+#include "iceberg/util/timepoint.h"
+
+namespace iceberg {
+
+/// A base class for tests that commit to a table of an in-memory catalog.
+///
+/// The table lives in a temporary directory. It is registered from the metadata of an
+/// empty table with `schema_` and `spec_`, which are a single required `id` column and
+/// no partitioning unless a derived class replaces them before registering the table.
+class TableTestBase : public TempFileTestBase {
+ protected:
+  static void SetUpTestSuite() { avro::RegisterAll(); }
+
+  void SetUp() override {
+    TempFileTestBase::SetUp();
+    file_io_ = arrow::ArrowFileSystemFileIO::MakeLocalFileIO();
+    catalog_ = InMemoryCatalog::Make("test_catalog", file_io_, "/tmp/warehouse/", {});
+    table_location_ = CreateTempDirectory();
+    std::filesystem::create_directories(MetadataFolder());
+    schema_ = std::make_shared<Schema>(
+        std::vector<SchemaField>{SchemaField::MakeRequired(1, "id", int64())},
+        /*schema_id=*/0);
+    spec_ = PartitionSpec::Unpartitioned();
+  }
+
+  std::string MetadataFolder() const { return table_location_ + "/metadata"; }
+
+  /// \brief Registers an empty table with the given properties as `identifier_`.
+  void RegisterTable(std::unordered_map<std::string, std::string> properties = {},
+                     int8_t format_version = 2) {
+    // Keep the retries of the tests short.
+    properties.emplace("commit.retry.min-wait-ms", "1");
+    properties.emplace("commit.retry.max-wait-ms", "10");
+    TableMetadata metadata{
+        .format_version = format_version,
+        .table_uuid = "test-table-uuid",
+        .location = table_location_,
+        .last_sequence_number = TableMetadata::kInitialSequenceNumber,
+        .last_updated_ms = TimePointMsFromUnixMs(1700000000000).value(),
+        .last_column_id = std::ranges::max(schema_->fields(), {}, &SchemaField::field_id)
+                              .field_id(),
+        .schemas = {schema_},
+        .current_schema_id = 0,
+        .partition_specs = {spec_},
+        .default_spec_id = spec_->spec_id(),
+        .last_partition_id = spec_->fields().empty()
+                                 ? PartitionSpec::kInvalidPartitionFieldId
+                                 : spec_->last_assigned_field_id(),
+        .properties = std::move(properties),
+        .current_snapshot_id = Snapshot::kInvalidSnapshotId,
+        .sort_orders = {SortOrder::Unsorted()},
+        .default_sort_order_id = SortOrder::kInitialSortOrderId,
+        .next_row_id = TableMetadata::kInitialRowId,
+    };
+    auto metadata_location = std::format("{}/00000-init.metadata.json", MetadataFolder());
+    ASSERT_THAT(TableMetadataUtil::Write(*file_io_, metadata_location, metadata), IsOk());
+    ASSERT_THAT(catalog_->RegisterTable(identifier_, metadata_location), IsOk());
+  }
+
+  /// \brief Registers an empty table as `identifier_` and loads it into `table_`.
+  void CreateTable(std::unordered_map<std::string, std::string> properties = {}) {
+    ASSERT_NO_FATAL_FAILURE(RegisterTable(std::move(properties)));
+    ICEBERG_UNWRAP_OR_FAIL(table_, catalog_->LoadTable(identifier_));
+  }
+
+  std::shared_ptr<Table> LoadTable() {
+    auto table = catalog_->LoadTable(identifier_);
+    EXPECT_THAT(table, IsOk());
+    return std::move(table.value());
+  }
+
+  std::shared_ptr<FileIO> file_io_;
+  std::shared_ptr<InMemoryCatalog> catalog_;
+  std::string table_location_;
+  std::shared_ptr<Schema> schema_;
+  std::shared_ptr<PartitionSpec> spec_;
+  TableIdentifier identifier_{.ns = {}, .name = "t1"};
+  std::shared_ptr<Table> table_;
+};
+
+}  // namespace iceberg
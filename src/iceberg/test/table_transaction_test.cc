@@ -0,0 +1,164 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/table_transaction.h"
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "iceberg/append_files.h"
+#include "iceberg/expire_snapshots.h"
+#include "iceberg/fast_append.h"
+#include "iceberg/manifest_entry.h"
+#include "iceberg/schema.h"
+#include "iceberg/snapshot.h"
+#include "iceberg/table.h"
+#include "iceberg/test/matchers.h"
+#include "iceberg/test/table_test_base.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+class TableTransactionTest : public TableTestBase {
+ protected:
+  void SetUp() override {
+    TableTestBase::SetUp();
+    ASSERT_NO_FATAL_FAILURE(RegisterTable({{"commit.retry.num-retries", "0"}}));
+  }
+
+  static std::shared_ptr<DataFile> MakeDataFile(const std::string& path) {
+    return std::make_shared<DataFile>(DataFile{
+        .file_path = path,
+        .file_format = FileFormatType::kParquet,
+        .record_count = 10,
+        .file_size_in_bytes = 100,
+    });
+  }
+
+  int32_t CountFiles(std::string_view extension) const {
+    int32_t count = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(MetadataFolder())) {
+      count += entry.path().extension() == extension ? 1 : 0;
+    }
+    return count;
+  }
+};
+
+TEST_F(TableTransactionTest, CommitsOperationsWithOneMetadataFile) {
+  auto table = LoadTable();
+  ICEBERG_UNWRAP_OR_FAIL(auto transaction, TableTransaction::Make(table));
+
+  auto first = transaction->NewAppend();
+  first->AppendFile(MakeDataFile("/data/a.parquet"));
+  ASSERT_THAT(first->Commit(), IsOk());
+  ASSERT_THAT(transaction->UpdateProperties({{"owner", "nightly"}},
+                                            {"commit.retry.num-retries"}),
+              IsOk());
+  auto schema = std::make_shared<Schema>(std::vector<SchemaField>{
+      SchemaField::MakeRequired(1, "id", int64()),
+      SchemaField::MakeOptional(2, "data", string())});
+  ASSERT_THAT(transaction->SetCurrentSchema(schema), IsOk());
+  auto second = transaction->NewAppend();
+  second->AppendFile(MakeDataFile("/data/b.parquet"));
+  ASSERT_THAT(second->Commit(), IsOk());
+
+  // The operations see the staged metadata, the table and the catalog do not.
+  const auto& staged = transaction->table()->metadata();
+  EXPECT_EQ(staged->snapshots.size(), 2);
+  EXPECT_EQ(staged->properties.at("owner"), "nightly");
+  EXPECT_EQ(staged->current_schema_id, 1);
+  EXPECT_EQ(table->metadata()->current_snapshot_id, Snapshot::kInvalidSnapshotId);
+  EXPECT_EQ(LoadTable()->metadata()->current_snapshot_id, Snapshot::kInvalidSnapshotId);
+  EXPECT_EQ(CountFiles(".json"), 1);
+
+  ASSERT_THAT(transaction->CommitTransaction(), IsOk());
+  EXPECT_EQ(CountFiles(".json"), 2);
+
+  for (const auto& committed : {table, LoadTable()}) {
+    const auto& metadata = committed->metadata();
+    ASSERT_EQ(metadata->snapshots.size(), 2);
+    ICEBERG_UNWRAP_OR_FAIL(auto current, committed->current_snapshot());
+    EXPECT_EQ(current->sequence_number, 2);
+    EXPECT_EQ(current->parent_snapshot_id, metadata->snapshots[0]->snapshot_id);
+    EXPECT_EQ(current->summary.at(SnapshotSummaryFields::kTotalDataFiles), "2");
+    EXPECT_EQ(metadata->properties.at("owner"), "nightly");
+    EXPECT_FALSE(metadata->properties.contains("commit.retry.num-retries"));
+    EXPECT_EQ(metadata->last_column_id, 2);
+    ICEBERG_UNWRAP_OR_FAIL(auto current_schema, committed->schema());
+    EXPECT_EQ(current_schema->schema_id(), 1);
+    EXPECT_EQ(current_schema->fields().size(), 2);
+  }
+
+  EXPECT_THAT(transaction->CommitTransaction(), IsError(ErrorKind::kInvalid));
+}
+
+TEST_F(TableTransactionTest, ExpiresSnapshotsWithoutDeletingFiles) {
+  auto table = LoadTable();
+  FastAppend append(table);
+  append.AppendFile(MakeDataFile("/data/a.parquet"));
+  ASSERT_THAT(append.Commit(), IsOk());
+  const int32_t avro_files = CountFiles(".avro");
+
+  ICEBERG_UNWRAP_OR_FAIL(auto transaction, TableTransaction::Make(table));
+  auto next = transaction->NewAppend();
+  next->AppendFile(MakeDataFile("/data/b.parquet"));
+  ASSERT_THAT(next->Commit(), IsOk());
+  auto expire = transaction->NewExpireSnapshots();
+  expire->ExpireSnapshotId(append.snapshot_id());
+  ICEBERG_UNWRAP_OR_FAIL(auto result, expire->Commit());
+  EXPECT_EQ(result.expired_snapshot_ids, std::vector<int64_t>{append.snapshot_id()});
+  ASSERT_THAT(transaction->CommitTransaction(), IsOk());
+
+  ASSERT_EQ(table->metadata()->snapshots.size(), 1);
+  EXPECT_FALSE(table->metadata()->HasSnapshot(append.snapshot_id()));
+  // The files of the expired snapshot are kept, next to those of the new snapshot.
+  EXPECT_EQ(CountFiles(".avro"), avro_files + 2);
+}
+
+TEST_F(TableTransactionTest, ConflictDeletesStagedFiles) {
+  auto table = LoadTable();
+  ICEBERG_UNWRAP_OR_FAIL(auto transaction, TableTransaction::Make(table));
+  auto staged = transaction->NewAppend();
+  staged->AppendFile(MakeDataFile("/data/a.parquet"));
+  ASSERT_THAT(staged->Commit(), IsOk());
+
+  FastAppend concurrent(LoadTable());
+  concurrent.AppendFile(MakeDataFile("/data/b.parquet"));
+  ASSERT_THAT(concurrent.Commit(), IsOk());
+  const int32_t avro_files = CountFiles(".avro");
+
+  EXPECT_THAT(transaction->CommitTransaction(), IsError(ErrorKind::kCommitFailed));
+  EXPECT_EQ(CountFiles(".avro"), avro_files - 2);
+  ICEBERG_UNWRAP_OR_FAIL(auto current, LoadTable()->current_snapshot());
+  EXPECT_EQ(current->snapshot_id, concurrent.snapshot_id());
+}
+
+TEST_F(TableTransactionTest, RequiresCatalog) {
+  auto table = LoadTable();
+  auto read_only = std::make_shared<Table>(identifier_, table->metadata(),
+                                           table->metadata_location(), file_io_,
+                                           /*catalog=*/nullptr);
+  EXPECT_THAT(TableTransaction::Make(read_only), IsError(ErrorKind::kNotSupported));
+}
+
+}  // namespace iceberg
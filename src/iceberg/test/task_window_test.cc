@@ -0,0 +1,133 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/util/task_window_internal.h"
+
+#include <functional>
+#include <future>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/test/deferred_executor.h"
+#include "iceberg/test/matchers.h"
+
+namespace iceberg {
+
+TEST(TaskWindowTest, TakesResultsInOrder) {
+  auto executor = std::make_shared<DeferredExecutor>();
+  TaskWindow<int32_t> window(executor, /*capacity=*/3, /*ordered=*/true);
+  EXPECT_TRUE(window.empty());
+  std::vector<int32_t> runs;
+  for (int32_t i = 0; i < 3; ++i) {
+    window.Push([&runs, i]() -> Result<int32_t> {
+      runs.push_back(i);
+      return i;
+    });
+  }
+  EXPECT_TRUE(window.full());
+
+  // The helpers run the tasks in the order they were pushed.
+  EXPECT_EQ(executor->RunAll(), 3);
+  EXPECT_THAT(runs, ::testing::ElementsAre(0, 1, 2));
+  for (int32_t i = 0; i < 3; ++i) {
+    ICEBERG_UNWRAP_OR_FAIL(auto value, window.Take());
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_TRUE(window.empty());
+}
+
+TEST(TaskWindowTest, RunsTasksNotStartedByHelpers) {
+  auto executor = std::make_shared<DeferredExecutor>();
+  int32_t runs = 0;
+  {
+    TaskWindow<int32_t> window(executor, /*capacity=*/2, /*ordered=*/true);
+    for (int32_t i = 0; i < 2; ++i) {
+      window.Push([&runs, i]() -> Result<int32_t> {
+        ++runs;
+        return i * 10;
+      });
+    }
+    ICEBERG_UNWRAP_OR_FAIL(auto first, window.Take());
+    EXPECT_EQ(first, 0);
+    EXPECT_EQ(runs, 1);
+    ICEBERG_UNWRAP_OR_FAIL(auto second, window.Take());
+    EXPECT_EQ(second, 10);
+    EXPECT_EQ(runs, 2);
+    window.Push([&runs]() -> Result<int32_t> {
+      ++runs;
+      return 20;
+    });
+  }
+  // Helpers starting after the window is destroyed run nothing.
+  EXPECT_EQ(executor->RunAll(), 3);
+  EXPECT_EQ(runs, 2);
+}
+
+TEST(TaskWindowTest, TakesResultsAsTheyComplete) {
+  ICEBERG_UNWRAP_OR_FAIL(std::shared_ptr<Executor> pool, ThreadPoolExecutor::Make(2));
+  std::promise<void> first_started;
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  TaskWindow<int32_t> window(pool, /*capacity=*/2, /*ordered=*/false);
+  window.Push([&first_started, released]() -> Result<int32_t> {
+    first_started.set_value();
+    released.wait();
+    return 0;
+  });
+  first_started.get_future().wait();
+  window.Push([]() -> Result<int32_t> { return 1; });
+
+  // The first task is blocked, so the second one completes and is taken first.
+  ICEBERG_UNWRAP_OR_FAIL(auto first, window.Take());
+  EXPECT_EQ(first, 1);
+  release.set_value();
+  ICEBERG_UNWRAP_OR_FAIL(auto second, window.Take());
+  EXPECT_EQ(second, 0);
+}
+
+TEST(TaskWindowTest, ErrorStopsHelpers) {
+  auto executor = std::make_shared<DeferredExecutor>();
+  TaskWindow<int32_t> window(executor, /*capacity=*/2, /*ordered=*/true);
+  int32_t runs = 0;
+  window.Push([&runs]() -> Result<int32_t> {
+    ++runs;
+    return IOError("failed");
+  });
+  window.Push([&runs]() -> Result<int32_t> {
+    ++runs;
+    return 1;
+  });
+  EXPECT_THAT(window.Take(), IsError(ErrorKind::kIOError));
+  EXPECT_EQ(executor->RunAll(), 2);
+  EXPECT_EQ(runs, 1);
+}
+
+TEST(TaskWindowTest, RunsTasksInlineWithoutCapacity) {
+  auto executor = std::make_shared<DeferredExecutor>();
+  TaskWindow<int32_t> window(executor, /*capacity=*/1, /*ordered=*/true);
+  window.Push([]() -> Result<int32_t> { return 7; });
+  EXPECT_TRUE(window.full());
+  EXPECT_EQ(executor->RunAll(), 0);
+  ICEBERG_UNWRAP_OR_FAIL(auto value, window.Take());
+  EXPECT_EQ(value, 7);
+}
+
+}  // namespace iceberg
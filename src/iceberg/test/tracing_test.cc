@@ -0,0 +1,107 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/util/tracing.h"
+
+#include <map>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace iceberg {
+
+namespace {
+
+struct RecordedSpan {
+  std::string name;
+  std::map<std::string, std::variant<int64_t, std::string>> attributes;
+  bool ended = false;
+};
+
+class RecordingSpan : public Span {
+ public:
+  explicit RecordingSpan(RecordedSpan& span) : span_(span) {}
+  ~RecordingSpan() override { span_.ended = true; }
+
+  void SetAttribute(std::string_view key, int64_t value) override {
+    span_.attributes[std::string(key)] = value;
+  }
+
+  void SetAttribute(std::string_view key, std::string_view value) override {
+    span_.attributes[std::string(key)] = std::string(value);
+  }
+
+ private:
+  RecordedSpan& span_;
+};
+
+class RecordingTracer : public Tracer {
+ public:
+  std::unique_ptr<Span> StartSpan(std::string_view name) override {
+    spans.push_back(
+        std::make_unique<RecordedSpan>(RecordedSpan{.name = std::string(name)}));
+    return std::make_unique<RecordingSpan>(*spans.back());
+  }
+
+  std::vector<std::unique_ptr<RecordedSpan>> spans;
+};
+
+}  // namespace
+
+class TracingTest : public ::testing::Test {
+ protected:
+  void TearDown() override { Tracer::SetGlobal(nullptr); }
+};
+
+TEST_F(TracingTest, TraceScope) {
+  auto tracer = std::make_shared<RecordingTracer>();
+  Tracer::SetGlobal(tracer);
+  EXPECT_EQ(Tracer::Global(), tracer);
+  {
+    TraceScope scope("FileIO::ReadFile");
+    scope.SetAttribute("path", "s3://bucket/file");
+    scope.SetAttribute("bytes", int64_t{42});
+    ASSERT_EQ(tracer->spans.size(), 1);
+    EXPECT_FALSE(tracer->spans[0]->ended);
+  }
+
+  ASSERT_EQ(tracer->spans.size(), 1);
+  const auto& span = *tracer->spans[0];
+  EXPECT_EQ(span.name, "FileIO::ReadFile");
+  EXPECT_TRUE(span.ended);
+  EXPECT_EQ(std::get<std::string>(span.attributes.at("path")), "s3://bucket/file");
+  EXPECT_EQ(std::get<int64_t>(span.attributes.at("bytes")), 42);
+  EXPECT_GE(std::get<int64_t>(span.attributes.at("duration_ns")), 0);
+}
+
+TEST_F(TracingTest, WithoutTracer) {
+  EXPECT_EQ(Tracer::Global(), nullptr);
+  TraceScope scope("FileIO::ReadFile");
+  scope.SetAttribute("bytes", int64_t{42});
+
+  // Scopes started before a tracer is installed are not traced.
+  auto tracer = std::make_shared<RecordingTracer>();
+  Tracer::SetGlobal(tracer);
+  scope.SetAttribute("rows", int64_t{1});
+  EXPECT_TRUE(tracer->spans.empty());
+}
+
+}  // namespace iceberg
@@ -19,9 +19,11 @@
 
 #include "iceberg/transform.h"
 
+#include <cstring>
 #include <format>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -30,6 +32,7 @@
 #include "iceberg/test/matchers.h"
 #include "iceberg/test/temporal_test_helper.h"
 #include "iceberg/type.h"
+#include "iceberg/util/checked_cast.h"
 #include "iceberg/util/formatter.h"  // IWYU pragma: keep
 
 namespace iceberg {
@@ -720,4 +723,232 @@ INSTANTIATE_TEST_SUITE_P(
                                      .source = Literal::Null(iceberg::string()),
                                      .expected = Literal::Null(iceberg::string())}));
 
+namespace {
+
+/// \brief An Arrow array of literals, with one leading null row skipped by its offset.
+struct LiteralArray {
+  LiteralArray(const PrimitiveType& type, const std::vector<Literal>& literals) {
+    const bool binary_like =
+        type.type_id() == TypeId::kString || type.type_id() == TypeId::kBinary;
+    const auto length = static_cast<int64_t>(literals.size()) + 1;
+    validity.resize((length + 7) / 8, 0);
+    offsets.push_back(0);
+    offsets.push_back(0);
+    if (!binary_like) {
+      values.resize(ValueWidth(type));
+    }
+    for (size_t i = 0; i < literals.size(); ++i) {
+      const auto& literal = literals[i];
+      if (!literal.IsNull()) {
+        validity[(i + 1) / 8] |= 1 << ((i + 1) % 8);
+      } else {
+        ++null_count;
+      }
+      std::visit(
+          [&]<typename T>(const T& value) {
+            if constexpr (std::is_same_v<T, std::string> ||
+                          std::is_same_v<T, std::vector<uint8_t>>) {
+              values.insert(values.end(), value.begin(), value.end());
+            } else if constexpr (std::is_same_v<T, Decimal>) {
+              Append(value.value());
+            } else if constexpr (std::is_same_v<T, int32_t> ||
+                                 std::is_same_v<T, int64_t>) {
+              Append(value);
+            } else if (!binary_like) {
+              values.resize(values.size() + ValueWidth(type));
+            }
+          },
+          literal.value());
+      offsets.push_back(static_cast<int32_t>(values.size()));
+    }
+    buffers = {validity.data(), binary_like ? static_cast<const void*>(offsets.data())
+                                            : values.data()};
+    if (binary_like) {
+      buffers.push_back(values.data());
+    }
+    array = ArrowArray{.length = length - 1,
+                       .null_count = null_count,
+                       .offset = 1,
+                       .n_buffers = static_cast<int64_t>(buffers.size()),
+                       .buffers = buffers.data()};
+  }
+
+  static size_t ValueWidth(const PrimitiveType& type) {
+    switch (type.type_id()) {
+      case TypeId::kInt:
+      case TypeId::kDate:
+        return sizeof(int32_t);
+      case TypeId::kDecimal:
+        return sizeof(int128_t);
+      default:
+        return sizeof(int64_t);
+    }
+  }
+
+  template <typename T>
+  void Append(T value) {
+    values.resize(values.size() + sizeof(T));
+    std::memcpy(values.data() + values.size() - sizeof(T), &value, sizeof(T));
+  }
+
+  std::vector<uint8_t> validity;
+  std::vector<int32_t> offsets;
+  std::vector<uint8_t> values;
+  std::vector<const void*> buffers;
+  int64_t null_count = 0;
+  ArrowArray array{};
+};
+
+/// \brief Reads the values of an Arrow array of the given type as literals.
+std::vector<Literal> ToLiterals(const std::shared_ptr<PrimitiveType>& type,
+                                const ArrowArray& array) {
+  const auto* validity = static_cast<const uint8_t*>(array.buffers[0]);
+  const auto* offsets = static_cast<const int32_t*>(array.buffers[1]);
+  const auto* values = static_cast<const uint8_t*>(array.buffers[1]);
+  std::vector<Literal> literals;
+  for (int64_t i = array.offset; i < array.offset + array.length; ++i) {
+    if (validity != nullptr && !((validity[i / 8] >> (i % 8)) & 1)) {
+      literals.push_back(Literal::Null(type));
+      continue;
+    }
+    switch (type->type_id()) {
+      case TypeId::kInt:
+        literals.push_back(Literal::Int(reinterpret_cast<const int32_t*>(values)[i]));
+        break;
+      case TypeId::kLong:
+        literals.push_back(Literal::Long(reinterpret_cast<const int64_t*>(values)[i]));
+        break;
+      case TypeId::kDecimal: {
+        const auto& decimal_type = internal::checked_cast<const DecimalType&>(*type);
+        int128_t value;
+        std::memcpy(&value, values + i * sizeof(int128_t), sizeof(int128_t));
+        literals.push_back(
+            Literal::Decimal(value, decimal_type.precision(), decimal_type.scale()));
+        break;
+      }
+      case TypeId::kString:
+      case TypeId::kBinary: {
+        const auto* data = static_cast<const char*>(array.buffers[2]) + offsets[i];
+        std::string value(data, offsets[i + 1] - offsets[i]);
+        literals.push_back(type->type_id() == TypeId::kString
+                               ? Literal::String(std::move(value))
+                               : Literal::Binary({value.begin(), value.end()}));
+        break;
+      }
+      default:
+        ADD_FAILURE() << "Unexpected type " << type->ToString();
+    }
+  }
+  return literals;
+}
+
+/// \brief Checks that the batch transform of the literals matches their transforms.
+void CheckTransformArray(const std::shared_ptr<Transform>& transform,
+                         const std::shared_ptr<PrimitiveType>& source_type,
+                         const std::vector<Literal>& literals) {
+  ICEBERG_UNWRAP_OR_FAIL(auto function, transform->Bind(source_type));
+  // Literals are compared by their string form, as null literals are not equal.
+  std::vector<std::string> expected;
+  for (const auto& literal : literals) {
+    ICEBERG_UNWRAP_OR_FAIL(auto value, function->Transform(literal));
+    expected.push_back(value.ToString());
+  }
+
+  LiteralArray source(*source_type, literals);
+  ICEBERG_UNWRAP_OR_FAIL(auto result, function->TransformArray(source.array));
+  const auto result_type =
+      internal::checked_pointer_cast<PrimitiveType>(function->ResultType());
+  EXPECT_EQ(result.length, static_cast<int64_t>(literals.size()));
+  std::vector<std::string> actual;
+  for (const auto& literal : ToLiterals(result_type, result)) {
+    actual.push_back(literal.ToString());
+  }
+  EXPECT_THAT(actual, ::testing::ElementsAreArray(expected))
+      << transform->ToString() << " of " << source_type->ToString();
+  result.release(&result);
+}
+
+}  // namespace
+
+TEST(TransformArrayTest, Bucket) {
+  CheckTransformArray(Transform::Bucket(16), int32(),
+                      {Literal::Int(34), Literal::Null(int32()), Literal::Int(-7)});
+  CheckTransformArray(Transform::Bucket(16), int64(),
+                      {Literal::Long(34), Literal::Long(-(1L << 40))});
+  CheckTransformArray(Transform::Bucket(16), date(),
+                      {Literal::Date(17486), Literal::Null(date())});
+  CheckTransformArray(Transform::Bucket(16), timestamp(),
+                      {Literal::Timestamp(1510871468000000)});
+  CheckTransformArray(Transform::Bucket(16), decimal(9, 2),
+                      {Literal::Decimal(1420, 9, 2), Literal::Decimal(-1420, 9, 2)});
+  CheckTransformArray(
+      Transform::Bucket(16), string(),
+      {Literal::String("iceberg"), Literal::Null(string()), Literal::String("")});
+  CheckTransformArray(Transform::Bucket(16), binary(),
+                      {Literal::Binary({0, 1, 2, 3}), Literal::Binary({})});
+}
+
+TEST(TransformArrayTest, Truncate) {
+  CheckTransformArray(Transform::Truncate(10), int32(),
+                      {Literal::Int(1), Literal::Int(-1), Literal::Null(int32())});
+  CheckTransformArray(Transform::Truncate(10), int64(),
+                      {Literal::Long(19), Literal::Long(-19)});
+  CheckTransformArray(Transform::Truncate(50), decimal(9, 2),
+                      {Literal::Decimal(1065, 9, 2), Literal::Decimal(-1065, 9, 2)});
+  CheckTransformArray(Transform::Truncate(3), string(),
+                      {Literal::String("iceberg"), Literal::String("ab"),
+                       Literal::String("éééé"), Literal::Null(string())});
+  CheckTransformArray(Transform::Truncate(2), binary(),
+                      {Literal::Binary({1, 2, 3}), Literal::Binary({1})});
+}
+
+TEST(TransformArrayTest, Temporal) {
+  const std::vector<Literal> dates = {Literal::Date(-1), Literal::Date(0),
+                                      Literal::Date(17486), Literal::Null(date())};
+  const std::vector<Literal> timestamps = {
+      Literal::Timestamp(-1), Literal::Timestamp(0),
+      Literal::Timestamp(1510871468123456), Literal::Null(timestamp())};
+  for (const auto& transform :
+       {Transform::Year(), Transform::Month(), Transform::Day()}) {
+    CheckTransformArray(transform, date(), dates);
+    CheckTransformArray(transform, timestamp(), timestamps);
+  }
+  CheckTransformArray(Transform::Hour(), timestamp(), timestamps);
+  CheckTransformArray(Transform::Hour(), timestamp_tz(),
+                      {Literal::TimestampTz(-3600000001), Literal::TimestampTz(7)});
+}
+
+TEST(TransformArrayTest, TemporalCalendar) {
+  // Every 29th day for 1200 years around the epoch, and the days around 0000-03-01.
+  std::vector<Literal> dates;
+  std::vector<Literal> timestamps;
+  for (int32_t day = -219146; day <= 219146; day += 29) {
+    dates.push_back(Literal::Date(day));
+    timestamps.push_back(Literal::Timestamp(int64_t{day} * 86400000000 - 1));
+  }
+  for (int32_t day : {-719469, -719468, -719409, -719408}) {
+    dates.push_back(Literal::Date(day));
+  }
+  for (const auto& transform :
+       {Transform::Year(), Transform::Month(), Transform::Day()}) {
+    CheckTransformArray(transform, date(), dates);
+    CheckTransformArray(transform, timestamp(), timestamps);
+  }
+}
+
+TEST(TransformArrayTest, IdentityAndVoid) {
+  for (const auto& transform : {Transform::Identity(), Transform::Void()}) {
+    CheckTransformArray(transform, int64(), {Literal::Long(5), Literal::Null(int64())});
+    CheckTransformArray(transform, string(),
+                        {Literal::String("a"), Literal::Null(string())});
+  }
+}
+
+TEST(TransformArrayTest, InvalidLayout) {
+  ICEBERG_UNWRAP_OR_FAIL(auto function, Transform::Bucket(4)->Bind(string()));
+  LiteralArray source(*int32(), {Literal::Int(1)});
+  EXPECT_THAT(function->TransformArray(source.array),
+              IsError(ErrorKind::kInvalidArrowData));
+}
+
 }  // namespace iceberg
@@ -19,9 +19,13 @@
 
 #include "iceberg/util/truncate_util.h"
 
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "iceberg/expression/literal.h"
+#include "iceberg/util/decimal.h"
 
 namespace iceberg {
 
@@ -50,4 +54,51 @@ TEST(TruncateUtilTest, TruncateLiteral) {
             Literal::Binary(std::vector<uint8_t>(expected.begin(), expected.end())));
 }
 
+TEST(TruncateUtilTest, UTF8PrefixLength) {
+  // Spans several words of 8 bytes, with code points of one to four bytes that cross
+  // the word boundaries.
+  const std::string source = "iceberg-\u00e9t\u00e9-\u51b0\u5c71-\U0001F9CA-table";
+  std::vector<size_t> starts;
+  for (size_t i = 0; i < source.size(); ++i) {
+    if ((source[i] & 0xC0) != 0x80) {
+      starts.push_back(i);
+    }
+  }
+  for (size_t length = 0; length < starts.size(); ++length) {
+    EXPECT_EQ(TruncateUtils::UTF8PrefixLength(source, length), starts[length]);
+    EXPECT_EQ(TruncateUtils::TruncateUTF8(source, length),
+              source.substr(0, starts[length]));
+  }
+  EXPECT_EQ(TruncateUtils::UTF8PrefixLength(source, starts.size()), source.size());
+  EXPECT_EQ(TruncateUtils::UTF8PrefixLength(source, 1000), source.size());
+  EXPECT_EQ(TruncateUtils::UTF8PrefixLength("", 3), 0);
+}
+
+TEST(TruncateUtilTest, TruncateInteger) {
+  EXPECT_EQ(TruncateUtils::TruncateInteger<int32_t>(-10, 10), -10);
+  EXPECT_EQ(TruncateUtils::TruncateInteger<int32_t>(-11, 10), -20);
+  EXPECT_EQ(TruncateUtils::TruncateInteger<int64_t>(19, 10), 10);
+  EXPECT_EQ(TruncateUtils::TruncateInteger<int128_t>(-1065, 50), -1100);
+  EXPECT_EQ(TruncateUtils::TruncateDecimal(Decimal(-1065), 50), Decimal(-1100));
+}
+
+TEST(TruncateUtilTest, TruncateUpperBounds) {
+  EXPECT_EQ(TruncateUtils::TruncateUTF8Max("iceberg", 3), "icf");
+  EXPECT_EQ(TruncateUtils::TruncateUTF8Max("ice", 3), "ice");
+  // Multi-byte code points are incremented as code points.
+  EXPECT_EQ(TruncateUtils::TruncateUTF8Max("\u00e9t\u00e9", 1), "\u00ea");
+  EXPECT_EQ(TruncateUtils::TruncateUTF8Max("a\U0010FFFFx", 2), "b");
+  EXPECT_EQ(TruncateUtils::TruncateUTF8Max("\uD7FFx", 1), "\uE000");
+  EXPECT_EQ(TruncateUtils::TruncateUTF8Max("\U0010FFFF\U0010FFFFx", 2), std::nullopt);
+
+  const std::vector<uint8_t> data = {0x01, 0x02, 0xFF, 0x04};
+  EXPECT_EQ(TruncateUtils::TruncateBinaryMax(data, 2),
+            (std::vector<uint8_t>{0x01, 0x03}));
+  EXPECT_EQ(TruncateUtils::TruncateBinaryMax(data, 3),
+            (std::vector<uint8_t>{0x01, 0x03}));
+  EXPECT_EQ(TruncateUtils::TruncateBinaryMax(data, 4), data);
+  EXPECT_EQ(TruncateUtils::TruncateBinaryMax(std::vector<uint8_t>{0xFF, 0xFF, 0x01}, 2),
+            std::nullopt);
+}
+
 }  // namespace iceberg
@@ -310,6 +310,16 @@ TEST(TypeTest, Fixed) {
                   ::testing::HasSubstr("length must be >= 0, was -1")));
 }
 
+TEST(TypeTest, Variant) {
+  const auto& variant = iceberg::variant();
+  ASSERT_EQ(iceberg::TypeId::kVariant, variant->type_id());
+  ASSERT_FALSE(variant->is_primitive());
+  ASSERT_FALSE(variant->is_nested());
+  ASSERT_EQ("variant", variant->ToString());
+  ASSERT_EQ(*variant, iceberg::VariantType());
+  ASSERT_NE(*variant, *iceberg::binary());
+}
+
 TEST(TypeTest, List) {
   {
     iceberg::SchemaField field(5, "element", iceberg::int32(), true);
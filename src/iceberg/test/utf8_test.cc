@@ -0,0 +1,176 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/util/utf8_internal.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/test/matchers.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief A string array over `data` split at `offsets`, and its schema.
+struct StringColumn {
+  StringColumn(std::string_view data, std::vector<int32_t> offsets)
+      : data(data), offsets(std::move(offsets)) {
+    buffers = {nullptr, this->offsets.data(), this->data.data()};
+    array.length = static_cast<int64_t>(this->offsets.size()) - 1;
+    array.n_buffers = 3;
+    array.buffers = buffers.data();
+    schema.format = "u";
+    schema.name = "data";
+  }
+
+  std::string data;
+  std::vector<int32_t> offsets;
+  std::vector<const void*> buffers;
+  ArrowArray array{};
+  ArrowSchema schema{};
+};
+
+/// \brief A stream returning a single batch of a string column.
+struct ColumnStream {
+  StringColumn* column;
+  bool done = false;
+
+  static int GetSchema(ArrowArrayStream* stream, ArrowSchema* out) {
+    auto* fake = static_cast<ColumnStream*>(stream->private_data);
+    *out = fake->column->schema;
+    out->release = [](ArrowSchema* schema) { schema->release = nullptr; };
+    return 0;
+  }
+
+  static int GetNext(ArrowArrayStream* stream, ArrowArray* out) {
+    auto* fake = static_cast<ColumnStream*>(stream->private_data);
+    *out = ArrowArray{};
+    if (!fake->done) {
+      fake->done = true;
+      *out = fake->column->array;
+      out->release = [](ArrowArray* array) { array->release = nullptr; };
+    }
+    return 0;
+  }
+
+  static const char* GetLastError(ArrowArrayStream*) { return nullptr; }
+
+  static void Release(ArrowArrayStream* stream) {
+    delete static_cast<ColumnStream*>(stream->private_data);
+    stream->release = nullptr;
+  }
+};
+
+}  // namespace
+
+TEST(Utf8Test, IsValidUtf8) {
+  EXPECT_TRUE(IsValidUtf8(""));
+  EXPECT_TRUE(IsValidUtf8("plain ascii that is longer than sixteen bytes"));
+  EXPECT_TRUE(IsValidUtf8("caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80"));
+  EXPECT_TRUE(
+      IsValidUtf8("a long ascii prefix before \xED\x9F\xBF and \xF4\x8F\xBF\xBF"));
+
+  // Truncated code points, at the end and before ASCII.
+  EXPECT_FALSE(IsValidUtf8("caf\xC3"));
+  EXPECT_FALSE(IsValidUtf8("\xE2\x82 more ascii after the truncated code point"));
+  // Lone continuation bytes and invalid lead bytes.
+  EXPECT_FALSE(IsValidUtf8("\x80"));
+  EXPECT_FALSE(IsValidUtf8("sixteen ascii bytes, then \xBF"));
+  EXPECT_FALSE(IsValidUtf8("\xFF"));
+  // Overlong encodings, surrogates and code points above U+10FFFF.
+  EXPECT_FALSE(IsValidUtf8("\xC0\xAF"));
+  EXPECT_FALSE(IsValidUtf8("\xE0\x80\xAF"));
+  EXPECT_FALSE(IsValidUtf8("\xF0\x80\x80\xAF"));
+  EXPECT_FALSE(IsValidUtf8("\xED\xA0\x80"));
+  EXPECT_FALSE(IsValidUtf8("\xF4\x90\x80\x80"));
+}
+
+TEST(Utf8Test, ValidateStringArray) {
+  StringColumn valid("caf\xC3\xA9\xE2\x82\xAC", {0, 5, 5, 8});
+  EXPECT_THAT(ValidateUtf8(valid.schema, valid.array), IsOk());
+
+  // The values are not checked beyond the slice of the array.
+  StringColumn sliced("\xFF" "ab", {0, 1, 2, 3});
+  sliced.array.offset = 1;
+  sliced.array.length = 2;
+  EXPECT_THAT(ValidateUtf8(sliced.schema, sliced.array), IsOk());
+
+  StringColumn invalid("ab\xFF", {0, 2, 3});
+  EXPECT_THAT(ValidateUtf8(invalid.schema, invalid.array),
+              HasErrorMessage("Invalid UTF-8 in string column data"));
+
+  // The data is valid, but each value holds half of a code point.
+  StringColumn split("\xC3\xA9", {0, 1, 2});
+  EXPECT_THAT(ValidateUtf8(split.schema, split.array),
+              IsError(ErrorKind::kInvalidArrowData));
+}
+
+TEST(Utf8Test, ValidateNestedArrays) {
+  StringColumn child("ab\xFF", {0, 2, 3});
+  ArrowArray* child_array = &child.array;
+  ArrowSchema* child_schema = &child.schema;
+  ArrowArray array{.length = 2, .n_children = 1, .children = &child_array};
+  ArrowSchema schema{.format = "+s", .n_children = 1, .children = &child_schema};
+  EXPECT_THAT(ValidateUtf8(schema, array), IsError(ErrorKind::kInvalidArrowData));
+
+  // Strings are checked in the dictionary of dictionary-encoded arrays.
+  StringColumn dictionary("ok\xC3", {0, 2, 3});
+  const int32_t indices[] = {0, 1};
+  const void* buffers[] = {nullptr, indices};
+  ArrowArray encoded{
+      .length = 2, .n_buffers = 2, .buffers = buffers, .dictionary = &dictionary.array};
+  ArrowSchema encoded_schema{.format = "i", .dictionary = &dictionary.schema};
+  EXPECT_THAT(ValidateUtf8(encoded_schema, encoded),
+              IsError(ErrorKind::kInvalidArrowData));
+  dictionary.offsets[2] = 2;
+  EXPECT_THAT(ValidateUtf8(encoded_schema, encoded), IsOk());
+
+  // Other arrays are not checked.
+  StringColumn binary("\xFF", {0, 1});
+  binary.schema.format = "z";
+  EXPECT_THAT(ValidateUtf8(binary.schema, binary.array), IsOk());
+}
+
+TEST(Utf8Test, ValidatingStream) {
+  StringColumn column("ab\xFF", {0, 2, 3});
+  auto stream = MakeUtf8ValidatingArrowStream(
+      ArrowArrayStream{.get_schema = ColumnStream::GetSchema,
+                       .get_next = ColumnStream::GetNext,
+                       .get_last_error = ColumnStream::GetLastError,
+                       .release = ColumnStream::Release,
+                       .private_data = new ColumnStream{.column = &column}});
+  ArrowArray batch{};
+  EXPECT_EQ(stream.get_next(&stream, &batch), EIO);
+  EXPECT_EQ(batch.release, nullptr);
+  EXPECT_EQ(std::string(stream.get_last_error(&stream)),
+            "Invalid UTF-8 in string column data");
+  EXPECT_EQ(stream.get_next(&stream, &batch), 0);
+  EXPECT_EQ(batch.release, nullptr);
+  stream.release(&stream);
+}
+
+}  // namespace iceberg
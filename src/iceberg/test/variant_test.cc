@@ -0,0 +1,138 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/util/variant_internal.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "iceberg/test/matchers.h"
+#include "iceberg/type.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief Encodes the metadata of a variant with sorted field names.
+std::string Metadata(const std::vector<std::string>& names) {
+  std::string metadata = {0x11, static_cast<char>(names.size())};
+  std::string strings;
+  metadata.push_back(0);
+  for (const auto& name : names) {
+    strings += name;
+    metadata.push_back(static_cast<char>(strings.size()));
+  }
+  return metadata + strings;
+}
+
+std::string Primitive(uint8_t type, std::string data = {}) {
+  return static_cast<char>(type << 2) + data;
+}
+
+std::string ShortString(const std::string& value) {
+  return static_cast<char>((value.size() << 2) | 1) + value;
+}
+
+/// \brief Encodes an object of fields sorted by name, given by field id.
+std::string Object(const std::vector<std::pair<uint8_t, std::string>>& fields) {
+  std::string object = {0x02, static_cast<char>(fields.size())};
+  std::string values;
+  std::string offsets;
+  for (const auto& [id, value] : fields) {
+    object.push_back(static_cast<char>(id));
+    offsets.push_back(static_cast<char>(values.size()));
+    values += value;
+  }
+  offsets.push_back(static_cast<char>(values.size()));
+  return object + offsets + values;
+}
+
+}  // namespace
+
+TEST(VariantTest, FindField) {
+  // {"id": 7, "user": {"name": "ann"}}
+  const auto metadata = Metadata({"id", "name", "user"});
+  const auto user = Object({{1, ShortString("ann")}});
+  const auto value = Object({{0, Primitive(3, "\x07")}, {2, user}});
+
+  const std::vector<std::string> id_path = {"id"};
+  ICEBERG_UNWRAP_OR_FAIL(auto id, FindVariantField(metadata, value, id_path));
+  ASSERT_TRUE(id.has_value());
+  EXPECT_THAT(VariantToLiteral(*id, int64()), HasValue(::testing::Eq(Literal::Long(7))));
+
+  const std::vector<std::string> name_path = {"user", "name"};
+  ICEBERG_UNWRAP_OR_FAIL(auto name, FindVariantField(metadata, value, name_path));
+  ASSERT_TRUE(name.has_value());
+  EXPECT_THAT(VariantToLiteral(*name, string()),
+              HasValue(::testing::Eq(Literal::String("ann"))));
+
+  // Missing fields and fields of values that are not objects.
+  const std::vector<std::string> missing_path = {"user", "id"};
+  EXPECT_THAT(FindVariantField(metadata, value, missing_path),
+              HasValue(::testing::Eq(std::nullopt)));
+  const std::vector<std::string> scalar_path = {"id", "name"};
+  EXPECT_THAT(FindVariantField(metadata, value, scalar_path),
+              HasValue(::testing::Eq(std::nullopt)));
+
+  // Truncated objects and unknown metadata versions are errors.
+  EXPECT_THAT(FindVariantField(metadata, value.substr(0, 4), id_path),
+              IsError(ErrorKind::kInvalid));
+  EXPECT_THAT(FindVariantField("\x02", value, id_path), IsError(ErrorKind::kInvalid));
+}
+
+TEST(VariantTest, ToLiteral) {
+  EXPECT_THAT(VariantToLiteral(Primitive(1), boolean()),
+              HasValue(::testing::Eq(Literal::Boolean(true))));
+  EXPECT_THAT(VariantToLiteral(Primitive(4, std::string("\x01\x02", 2)), int32()),
+              HasValue(::testing::Eq(Literal::Int(0x0201))));
+  EXPECT_THAT(VariantToLiteral(Primitive(14, std::string("\x00\x00\xc0\x3f", 4)),
+                               float64()),
+              HasValue(::testing::Eq(Literal::Double(1.5))));
+  EXPECT_THAT(VariantToLiteral(Primitive(16, std::string("\x02\x00\x00\x00hi", 6)),
+                               string()),
+              HasValue(::testing::Eq(Literal::String("hi"))));
+  // 12.34 as a decimal4 of scale 2.
+  EXPECT_THAT(
+      VariantToLiteral(Primitive(8, std::string("\x02\xd2\x04\x00\x00", 5)),
+                       decimal(9, 2)),
+      HasValue(::testing::Eq(Literal::Decimal(1234, 9, 2))));
+
+  // Values that do not fit the type are null.
+  ICEBERG_UNWRAP_OR_FAIL(
+      auto too_large,
+      VariantToLiteral(Primitive(6, std::string("\x00\x00\x00\x00\x01\x00\x00\x00", 8)),
+                       int32()));
+  EXPECT_TRUE(too_large.IsNull());
+  ICEBERG_UNWRAP_OR_FAIL(auto mismatch, VariantToLiteral(ShortString("x"), int64()));
+  EXPECT_TRUE(mismatch.IsNull());
+  ICEBERG_UNWRAP_OR_FAIL(auto object, VariantToLiteral(Object({}), string()));
+  EXPECT_TRUE(object.IsNull());
+  ICEBERG_UNWRAP_OR_FAIL(auto null, VariantToLiteral(Primitive(0), string()));
+  EXPECT_TRUE(null.IsNull());
+
+  EXPECT_THAT(VariantToLiteral(Primitive(6, "\x01"), int64()),
+              IsError(ErrorKind::kInvalid));
+}
+
+}  // namespace iceberg
@@ -21,8 +21,12 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
 #include "iceberg/type_fwd.h"
 
 namespace iceberg {
@@ -34,6 +38,9 @@ class ICEBERG_EXPORT Transaction {
 
   /// \brief Return the Table that this transaction will update
   ///
+  /// The table has the metadata of the changes staged so far, and the operations
+  /// created on it are staged in this transaction rather than committed.
+  ///
   /// \return this transaction's table
   virtual const std::shared_ptr<Table>& table() const = 0;
 
@@ -42,12 +49,36 @@ class ICEBERG_EXPORT Transaction {
   /// \return a new AppendFiles
   virtual std::shared_ptr<AppendFiles> NewAppend() = 0;
 
+  /// \brief Create a new row delta API to add data files and delete files of changed
+  /// rows to this table
+  ///
+  /// \return a new RowDelta
+  virtual std::shared_ptr<RowDelta> NewRowDelta() = 0;
+
+  /// \brief Create a new expiration of the snapshots of this table
+  ///
+  /// \return a new ExpireSnapshots
+  virtual std::shared_ptr<ExpireSnapshots> NewExpireSnapshots() = 0;
+
+  /// \brief Stage setting and removing table properties
+  ///
+  /// \param updates the properties to set
+  /// \param removals the keys of the properties to remove
+  virtual Status UpdateProperties(
+      const std::unordered_map<std::string, std::string>& updates,
+      const std::vector<std::string>& removals = {}) = 0;
+
+  /// \brief Stage adding a schema and making it the current schema of this table
+  ///
+  /// \param schema the new schema, whose new fields have IDs higher than those of the
+  /// current metadata
+  virtual Status SetCurrentSchema(std::shared_ptr<Schema> schema) = 0;
+
   /// \brief Apply the pending changes from all actions and commit
   ///
-  /// May throw ValidationException if any update cannot be applied to the current table
-  /// metadata. May throw CommitFailedException if the updates cannot be committed due to
-  /// conflicts.
-  virtual void CommitTransaction() = 0;
+  /// \return Status::OK if the changes were committed; ErrorKind::kCommitFailed if they
+  /// could not be committed because of concurrent changes
+  virtual Status CommitTransaction() = 0;
 };
 
 }  // namespace iceberg
@@ -20,10 +20,17 @@
 #include "iceberg/transform.h"
 
 #include <format>
+#include <limits>
+#include <optional>
 #include <regex>
+#include <vector>
 
+#include "iceberg/expression/expressions.h"
+#include "iceberg/expression/predicate.h"
 #include "iceberg/transform_function.h"
 #include "iceberg/type.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/macros.h"
 
 namespace iceberg {
 namespace {
@@ -36,6 +43,362 @@ constexpr std::string_view kMonthName = "month";
 constexpr std::string_view kDayName = "day";
 constexpr std::string_view kHourName = "hour";
 constexpr std::string_view kVoidName = "void";
+
+using ProjectedPredicate = std::shared_ptr<UnboundPredicate<BoundReference>>;
+
+ProjectedPredicate MakePredicate(Expression::Operation op, std::string_view name) {
+  return std::make_shared<UnboundPredicate<BoundReference>>(
+      op, Expressions::Ref(std::string(name)));
+}
+
+ProjectedPredicate MakePredicate(Expression::Operation op, std::string_view name,
+                                 Literal literal) {
+  return std::make_shared<UnboundPredicate<BoundReference>>(
+      op, Expressions::Ref(std::string(name)), std::move(literal));
+}
+
+ProjectedPredicate MakePredicate(Expression::Operation op, std::string_view name,
+                                 std::vector<Literal> literals) {
+  return std::make_shared<UnboundPredicate<BoundReference>>(
+      op, Expressions::Ref(std::string(name)), std::move(literals));
+}
+
+/// \brief Move an integral literal by one towards the given direction.
+///
+/// Literals at the limit of their type are returned unchanged, which keeps the
+/// projection inclusive.
+Literal AdjustBoundary(const Literal& literal, int32_t delta) {
+  return std::visit(
+      [&]<typename T>(const T& value) -> Literal {
+        if constexpr (std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t>) {
+          if ((delta < 0 && value == std::numeric_limits<T>::min()) ||
+              (delta > 0 && value == std::numeric_limits<T>::max())) {
+            return literal;
+          }
+          return Expressions::Lit(static_cast<T>(value + delta), literal.type());
+        } else if constexpr (std::is_same_v<T, Decimal>) {
+          return Expressions::Lit(value + Decimal(delta), literal.type());
+        } else {
+          return literal;
+        }
+      },
+      literal.value());
+}
+
+Result<std::vector<Literal>> TransformLiterals(TransformFunction& func,
+                                               const BoundSetPredicate& predicate) {
+  auto type = internal::checked_pointer_cast<PrimitiveType>(predicate.term()->type());
+  std::vector<Literal> literals;
+  literals.reserve(predicate.literal_set().size());
+  for (const auto& value : predicate.literal_set()) {
+    ICEBERG_ASSIGN_OR_RAISE(auto transformed,
+                            func.Transform(Expressions::Lit(value, type)));
+    literals.push_back(std::move(transformed));
+  }
+  return literals;
+}
+
+/// \brief Projection for transforms that are monotonic over integral values, i.e.
+/// truncate on numbers and the temporal transforms.
+///
+/// Strict bounds are turned into inclusive ones on the source value before the
+/// transform is applied, e.g. `x < 10` projects to `truncate(x) <= truncate(9)`.
+Result<ProjectedPredicate> ProjectIntegral(TransformFunction& func,
+                                           std::string_view name,
+                                           const BoundPredicate& predicate) {
+  if (predicate.kind() == BoundPredicate::Kind::kSet) {
+    if (predicate.op() != Expression::Operation::kIn) {
+      return nullptr;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto literals,
+        TransformLiterals(func,
+                          internal::checked_cast<const BoundSetPredicate&>(predicate)));
+    return MakePredicate(Expression::Operation::kIn, name, std::move(literals));
+  }
+
+  const auto& literal =
+      internal::checked_cast<const BoundLiteralPredicate&>(predicate).literal();
+  switch (predicate.op()) {
+    case Expression::Operation::kLt: {
+      ICEBERG_ASSIGN_OR_RAISE(auto boundary, func.Transform(AdjustBoundary(literal, -1)));
+      return MakePredicate(Expression::Operation::kLtEq, name, std::move(boundary));
+    }
+    case Expression::Operation::kLtEq: {
+      ICEBERG_ASSIGN_OR_RAISE(auto boundary, func.Transform(literal));
+      return MakePredicate(Expression::Operation::kLtEq, name, std::move(boundary));
+    }
+    case Expression::Operation::kGt: {
+      ICEBERG_ASSIGN_OR_RAISE(auto boundary, func.Transform(AdjustBoundary(literal, 1)));
+      return MakePredicate(Expression::Operation::kGtEq, name, std::move(boundary));
+    }
+    case Expression::Operation::kGtEq: {
+      ICEBERG_ASSIGN_OR_RAISE(auto boundary, func.Transform(literal));
+      return MakePredicate(Expression::Operation::kGtEq, name, std::move(boundary));
+    }
+    case Expression::Operation::kEq: {
+      ICEBERG_ASSIGN_OR_RAISE(auto boundary, func.Transform(literal));
+      return MakePredicate(Expression::Operation::kEq, name, std::move(boundary));
+    }
+    default:
+      return nullptr;
+  }
+}
+
+/// \brief Projection for truncate on strings and binary values.
+Result<ProjectedPredicate> ProjectTruncateArray(TransformFunction& func,
+                                                std::string_view name,
+                                                const BoundPredicate& predicate) {
+  if (predicate.kind() == BoundPredicate::Kind::kSet) {
+    if (predicate.op() != Expression::Operation::kIn) {
+      return nullptr;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto literals,
+        TransformLiterals(func,
+                          internal::checked_cast<const BoundSetPredicate&>(predicate)));
+    return MakePredicate(Expression::Operation::kIn, name, std::move(literals));
+  }
+
+  const auto& literal =
+      internal::checked_cast<const BoundLiteralPredicate&>(predicate).literal();
+  switch (predicate.op()) {
+    case Expression::Operation::kLt:
+    case Expression::Operation::kLtEq: {
+      ICEBERG_ASSIGN_OR_RAISE(auto boundary, func.Transform(literal));
+      return MakePredicate(Expression::Operation::kLtEq, name, std::move(boundary));
+    }
+    case Expression::Operation::kGt:
+    case Expression::Operation::kGtEq: {
+      ICEBERG_ASSIGN_OR_RAISE(auto boundary, func.Transform(literal));
+      return MakePredicate(Expression::Operation::kGtEq, name, std::move(boundary));
+    }
+    case Expression::Operation::kEq:
+    case Expression::Operation::kStartsWith: {
+      ICEBERG_ASSIGN_OR_RAISE(auto boundary, func.Transform(literal));
+      return MakePredicate(predicate.op(), name, std::move(boundary));
+    }
+    default:
+      return nullptr;
+  }
+}
+
+/// \brief Strict projection for transforms that are monotonic over integral values.
+///
+/// Equality cannot be projected, since adjacent values share a partition value, and
+/// bounds become exclusive on the partition value, e.g. `x <= 9` projects to
+/// `truncate(x) < truncate(10)`.
+Result<ProjectedPredicate> ProjectIntegralStrict(TransformFunction& func,
+                                                 std::string_view name,
+                                                 const BoundPredicate& predicate) {
+  if (predicate.kind() == BoundPredicate::Kind::kSet) {
+    if (predicate.op() != Expression::Operation::kNotIn) {
+      return nullptr;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto literals,
+        TransformLiterals(func,
+                          internal::checked_cast<const BoundSetPredicate&>(predicate)));
+    return MakePredicate(Expression::Operation::kNotIn, name, std::move(literals));
+  }
+
+  const auto& literal =
+      internal::checked_cast<const BoundLiteralPredicate&>(predicate).literal();
+  switch (predicate.op()) {
+    case Expression::Operation::kLt: {
+      ICEBERG_ASSIGN_OR_RAISE(auto boundary, func.Transform(literal));
+      return MakePredicate(Expression::Operation::kLt, name, std::move(boundary));
+    }
+    case Expression::Operation::kLtEq: {
+      ICEBERG_ASSIGN_OR_RAISE(auto boundary, func.Transform(AdjustBoundary(literal, 1)));
+      return MakePredicate(Expression::Operation::kLt, name, std::move(boundary));
+    }
+    case Expression::Operation::kGt: {
+      ICEBERG_ASSIGN_OR_RAISE(auto boundary, func.Transform(literal));
+      return MakePredicate(Expression::Operation::kGt, name, std::move(boundary));
+    }
+    case Expression::Operation::kGtEq: {
+      ICEBERG_ASSIGN_OR_RAISE(auto boundary, func.Transform(AdjustBoundary(literal, -1)));
+      return MakePredicate(Expression::Operation::kGt, name, std::move(boundary));
+    }
+    case Expression::Operation::kNotEq: {
+      ICEBERG_ASSIGN_OR_RAISE(auto boundary, func.Transform(literal));
+      return MakePredicate(Expression::Operation::kNotEq, name, std::move(boundary));
+    }
+    default:
+      return nullptr;
+  }
+}
+
+/// \brief Strict projection for truncate on strings and binary values.
+Result<ProjectedPredicate> ProjectTruncateArrayStrict(TransformFunction& func,
+                                                      std::string_view name,
+                                                      const BoundPredicate& predicate) {
+  if (predicate.kind() == BoundPredicate::Kind::kSet) {
+    if (predicate.op() != Expression::Operation::kNotIn) {
+      return nullptr;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto literals,
+        TransformLiterals(func,
+                          internal::checked_cast<const BoundSetPredicate&>(predicate)));
+    return MakePredicate(Expression::Operation::kNotIn, name, std::move(literals));
+  }
+
+  const auto& literal =
+      internal::checked_cast<const BoundLiteralPredicate&>(predicate).literal();
+  ICEBERG_ASSIGN_OR_RAISE(auto boundary, func.Transform(literal));
+  switch (predicate.op()) {
+    case Expression::Operation::kLt:
+    case Expression::Operation::kLtEq:
+      return MakePredicate(Expression::Operation::kLt, name, std::move(boundary));
+    case Expression::Operation::kGt:
+    case Expression::Operation::kGtEq:
+      return MakePredicate(Expression::Operation::kGt, name, std::move(boundary));
+    case Expression::Operation::kNotEq:
+    case Expression::Operation::kNotStartsWith:
+      return MakePredicate(predicate.op(), name, std::move(boundary));
+    case Expression::Operation::kStartsWith:
+      // Only a prefix that fits in the width is fully contained in partition values.
+      if (boundary.value() != literal.value()) {
+        return nullptr;
+      }
+      return MakePredicate(Expression::Operation::kStartsWith, name, std::move(boundary));
+    default:
+      return nullptr;
+  }
+}
+
+/// \brief Widen a temporal projection for partition values written by writers that
+/// rounded pre-epoch values towards zero instead of towards negative infinity.
+ProjectedPredicate FixInclusiveTimeProjection(ProjectedPredicate projected) {
+  if (projected == nullptr) {
+    return projected;
+  }
+  // Projected literals are int32 values: years, months, days or hours from the epoch.
+  auto widen = [](const Literal& literal) -> std::optional<Literal> {
+    const auto* value = std::get_if<int32_t>(&literal.value());
+    if (value != nullptr && *value < 0) {
+      return Expressions::Lit(*value + 1, literal.type());
+    }
+    return std::nullopt;
+  };
+
+  switch (projected->op()) {
+    case Expression::Operation::kLtEq:
+    case Expression::Operation::kEq: {
+      const auto& literal = projected->literals().front();
+      auto widened = widen(literal);
+      if (!widened.has_value()) {
+        return projected;
+      }
+      if (projected->op() == Expression::Operation::kLtEq) {
+        return MakePredicate(Expression::Operation::kLtEq,
+                             projected->reference()->name(), std::move(*widened));
+      }
+      return MakePredicate(Expression::Operation::kIn, projected->reference()->name(),
+                           std::vector<Literal>{literal, std::move(*widened)});
+    }
+    case Expression::Operation::kIn: {
+      std::vector<Literal> literals = projected->literals();
+      for (const auto& literal : projected->literals()) {
+        if (auto widened = widen(literal); widened.has_value()) {
+          literals.push_back(std::move(*widened));
+        }
+      }
+      return MakePredicate(Expression::Operation::kIn, projected->reference()->name(),
+                           std::move(literals));
+    }
+    default:
+      return projected;
+  }
+}
+
+/// \brief Narrow a strict temporal projection for partition values written by writers
+/// that rounded pre-epoch values towards zero, which may be one more than the correct
+/// partition value.
+ProjectedPredicate FixStrictTimeProjection(ProjectedPredicate projected) {
+  if (projected == nullptr) {
+    return projected;
+  }
+  auto value_of = [](const Literal& literal) -> std::optional<int32_t> {
+    if (const auto* value = std::get_if<int32_t>(&literal.value()); value != nullptr) {
+      return *value;
+    }
+    return std::nullopt;
+  };
+
+  switch (projected->op()) {
+    case Expression::Operation::kGt:
+    case Expression::Operation::kGtEq: {
+      const auto& literal = projected->literals().front();
+      auto value = value_of(literal);
+      if (!value.has_value() || *value > 0) {
+        return projected;
+      }
+      return MakePredicate(projected->op(), projected->reference()->name(),
+                           Expressions::Lit(*value + 1, literal.type()));
+    }
+    case Expression::Operation::kNotEq:
+    case Expression::Operation::kNotIn: {
+      std::vector<Literal> literals = projected->literals();
+      for (const auto& literal : projected->literals()) {
+        if (auto value = value_of(literal); value.has_value() && *value < 0) {
+          literals.push_back(Expressions::Lit(*value + 1, literal.type()));
+        }
+      }
+      if (literals.size() == projected->literals().size()) {
+        return projected;
+      }
+      return MakePredicate(Expression::Operation::kNotIn, projected->reference()->name(),
+                           std::move(literals));
+    }
+    default:
+      return projected;
+  }
+}
+
+/// \brief Projection of predicates that do not depend on the transform: null checks
+/// for every transform, since transforms produce null if and only if the source value
+/// is null, and every predicate for identity.
+///
+/// \return The projected predicate, or std::nullopt if the projection depends on the
+/// transform.
+std::optional<ProjectedPredicate> ProjectCommon(TransformType transform_type,
+                                                std::string_view name,
+                                                const BoundPredicate& predicate) {
+  if (predicate.kind() == BoundPredicate::Kind::kUnary) {
+    switch (predicate.op()) {
+      case Expression::Operation::kIsNull:
+      case Expression::Operation::kNotNull:
+        return MakePredicate(predicate.op(), name);
+      default:
+        if (transform_type == TransformType::kIdentity) {
+          return MakePredicate(predicate.op(), name);
+        }
+        return ProjectedPredicate();
+    }
+  }
+
+  if (transform_type != TransformType::kIdentity) {
+    return std::nullopt;
+  }
+  if (predicate.kind() == BoundPredicate::Kind::kSet) {
+    const auto& set_predicate =
+        internal::checked_cast<const BoundSetPredicate&>(predicate);
+    auto type = internal::checked_pointer_cast<PrimitiveType>(predicate.term()->type());
+    std::vector<Literal> literals;
+    literals.reserve(set_predicate.literal_set().size());
+    for (const auto& value : set_predicate.literal_set()) {
+      literals.push_back(Expressions::Lit(value, type));
+    }
+    return MakePredicate(predicate.op(), name, std::move(literals));
+  }
+  return MakePredicate(
+      predicate.op(), name,
+      internal::checked_cast<const BoundLiteralPredicate&>(predicate).literal());
+}
+
 }  // namespace
 
 std::shared_ptr<Transform> Transform::Identity() {
@@ -124,6 +487,130 @@ Result<std::shared_ptr<TransformFunction>> Transform::Bind(
   }
 }
 
+Result<std::shared_ptr<UnboundPredicate<BoundReference>>> Transform::Project(
+    std::string_view name, const std::shared_ptr<BoundPredicate>& predicate) const {
+  // Only predicates on the source column itself can be projected.
+  if (predicate->term()->kind() != Term::Kind::kReference) {
+    return nullptr;
+  }
+
+  if (transform_type_ == TransformType::kVoid ||
+      transform_type_ == TransformType::kUnknown) {
+    return nullptr;
+  }
+
+  if (auto projected = ProjectCommon(transform_type_, name, *predicate)) {
+    return std::move(*projected);
+  }
+
+  ICEBERG_ASSIGN_OR_RAISE(auto func, Bind(predicate->term()->type()));
+
+  switch (transform_type_) {
+    case TransformType::kBucket: {
+      if (predicate->op() == Expression::Operation::kEq) {
+        ICEBERG_ASSIGN_OR_RAISE(
+            auto bucket,
+            func->Transform(
+                internal::checked_cast<const BoundLiteralPredicate&>(*predicate)
+                    .literal()));
+        return MakePredicate(Expression::Operation::kEq, name, std::move(bucket));
+      }
+      if (predicate->op() == Expression::Operation::kIn) {
+        ICEBERG_ASSIGN_OR_RAISE(
+            auto buckets,
+            TransformLiterals(
+                *func, internal::checked_cast<const BoundSetPredicate&>(*predicate)));
+        return MakePredicate(Expression::Operation::kIn, name, std::move(buckets));
+      }
+      return nullptr;
+    }
+    case TransformType::kTruncate:
+      switch (predicate->term()->type()->type_id()) {
+        case TypeId::kInt:
+        case TypeId::kLong:
+        case TypeId::kDecimal:
+          return ProjectIntegral(*func, name, *predicate);
+        case TypeId::kString:
+        case TypeId::kBinary:
+          return ProjectTruncateArray(*func, name, *predicate);
+        default:
+          return nullptr;
+      }
+    case TransformType::kYear:
+    case TransformType::kMonth:
+    case TransformType::kDay:
+    case TransformType::kHour: {
+      ICEBERG_ASSIGN_OR_RAISE(auto projected, ProjectIntegral(*func, name, *predicate));
+      return FixInclusiveTimeProjection(std::move(projected));
+    }
+    default:
+      return nullptr;
+  }
+}
+
+Result<std::shared_ptr<UnboundPredicate<BoundReference>>> Transform::ProjectStrict(
+    std::string_view name, const std::shared_ptr<BoundPredicate>& predicate) const {
+  if (predicate->term()->kind() != Term::Kind::kReference) {
+    return nullptr;
+  }
+
+  if (transform_type_ == TransformType::kVoid ||
+      transform_type_ == TransformType::kUnknown) {
+    return nullptr;
+  }
+
+  if (auto projected = ProjectCommon(transform_type_, name, *predicate)) {
+    return std::move(*projected);
+  }
+
+  ICEBERG_ASSIGN_OR_RAISE(auto func, Bind(predicate->term()->type()));
+
+  switch (transform_type_) {
+    case TransformType::kBucket: {
+      // Equal values share a bucket, but a bucket holds other values too, so only
+      // exclusions can be projected.
+      if (predicate->op() == Expression::Operation::kNotEq) {
+        ICEBERG_ASSIGN_OR_RAISE(
+            auto bucket,
+            func->Transform(
+                internal::checked_cast<const BoundLiteralPredicate&>(*predicate)
+                    .literal()));
+        return MakePredicate(Expression::Operation::kNotEq, name, std::move(bucket));
+      }
+      if (predicate->op() == Expression::Operation::kNotIn) {
+        ICEBERG_ASSIGN_OR_RAISE(
+            auto buckets,
+            TransformLiterals(
+                *func, internal::checked_cast<const BoundSetPredicate&>(*predicate)));
+        return MakePredicate(Expression::Operation::kNotIn, name, std::move(buckets));
+      }
+      return nullptr;
+    }
+    case TransformType::kTruncate:
+      switch (predicate->term()->type()->type_id()) {
+        case TypeId::kInt:
+        case TypeId::kLong:
+        case TypeId::kDecimal:
+          return ProjectIntegralStrict(*func, name, *predicate);
+        case TypeId::kString:
+        case TypeId::kBinary:
+          return ProjectTruncateArrayStrict(*func, name, *predicate);
+        default:
+          return nullptr;
+      }
+    case TransformType::kYear:
+    case TransformType::kMonth:
+    case TransformType::kDay:
+    case TransformType::kHour: {
+      ICEBERG_ASSIGN_OR_RAISE(auto projected,
+                              ProjectIntegralStrict(*func, name, *predicate));
+      return FixStrictTimeProjection(std::move(projected));
+    }
+    default:
+      return nullptr;
+  }
+}
+
 bool TransformFunction::Equals(const TransformFunction& other) const {
   return transform_type_ == other.transform_type_ && *source_type_ == *other.source_type_;
 }
@@ -150,6 +637,11 @@ TransformFunction::TransformFunction(TransformType transform_type,
                                      std::shared_ptr<Type> source_type)
     : transform_type_(transform_type), source_type_(std::move(source_type)) {}
 
+Result<ArrowArray> TransformFunction::TransformArray(const ArrowArray& /*array*/) {
+  return NotSupported("Transform {} of Arrow arrays is not supported",
+                      TransformTypeToString(transform_type_));
+}
+
 TransformType TransformFunction::transform_type() const { return transform_type_; }
 
 std::shared_ptr<Type> const& TransformFunction::source_type() const {
@@ -26,6 +26,7 @@
 #include <utility>
 #include <variant>
 
+#include "iceberg/arrow_c_data.h"
 #include "iceberg/expression/literal.h"
 #include "iceberg/iceberg_export.h"
 #include "iceberg/result.h"
@@ -150,6 +151,30 @@ class ICEBERG_EXPORT Transform : public util::Formattable {
   Result<std::shared_ptr<TransformFunction>> Bind(
       const std::shared_ptr<Type>& source_type) const;
 
+  /// \brief Projects a predicate on the source column to the partition values produced
+  /// by this transform.
+  ///
+  /// The projection is inclusive: if the source predicate matches a row, the projected
+  /// predicate matches the partition value of that row.
+  ///
+  /// \param name The name of the partition field to reference in the projection.
+  /// \param predicate A predicate bound to the source column of this transform.
+  /// \return The projected predicate, or nullptr if the predicate cannot be projected.
+  Result<std::shared_ptr<UnboundPredicate<BoundReference>>> Project(
+      std::string_view name, const std::shared_ptr<BoundPredicate>& predicate) const;
+
+  /// \brief Projects a predicate on the source column to a predicate on the partition
+  /// values that implies it.
+  ///
+  /// The projection is strict: if the projected predicate matches a partition value,
+  /// the source predicate matches every row with that partition value.
+  ///
+  /// \param name The name of the partition field to reference in the projection.
+  /// \param predicate A predicate bound to the source column of this transform.
+  /// \return The projected predicate, or nullptr if the predicate cannot be projected.
+  Result<std::shared_ptr<UnboundPredicate<BoundReference>>> ProjectStrict(
+      std::string_view name, const std::shared_ptr<BoundPredicate>& predicate) const;
+
   /// \brief Returns a string representation of this transform (e.g., "bucket[16]").
   std::string ToString() const override;
 
@@ -197,6 +222,12 @@ class ICEBERG_EXPORT TransformFunction {
   ///
   /// All transforms must return null for a null input value.
   virtual Result<Literal> Transform(const Literal& literal) = 0;
+  /// \brief Transform an Arrow array of source values to an array of result values
+  ///
+  /// The array must have the Arrow layout of the source type. Null values are
+  /// transformed to nulls. The returned array owns its buffers and must be released
+  /// by the caller. Returns NotSupported unless overridden.
+  virtual Result<ArrowArray> TransformArray(const ArrowArray& array);
   /// \brief Get the transform type
   TransformType transform_type() const;
   /// \brief Get the source type of transform function
@@ -24,6 +24,7 @@
 #include "iceberg/expression/literal.h"
 #include "iceberg/type.h"
 #include "iceberg/type_fwd.h"
+#include "iceberg/util/arrow_transform_internal.h"
 #include "iceberg/util/bucket_util.h"
 #include "iceberg/util/macros.h"
 #include "iceberg/util/temporal_util.h"
@@ -36,6 +37,10 @@ IdentityTransform::IdentityTransform(std::shared_ptr<Type> const& source_type)
 
 Result<Literal> IdentityTransform::Transform(const Literal& literal) { return literal; }
 
+Result<ArrowArray> IdentityTransform::TransformArray(const ArrowArray& array) {
+  return TransformArrowArray(TransformType::kIdentity, *source_type(), array);
+}
+
 std::shared_ptr<Type> IdentityTransform::ResultType() const { return source_type(); }
 
 Result<std::unique_ptr<TransformFunction>> IdentityTransform::Make(
@@ -64,6 +69,10 @@ Result<Literal> BucketTransform::Transform(const Literal& literal) {
   return Literal::Int(bucket_index);
 }
 
+Result<ArrowArray> BucketTransform::TransformArray(const ArrowArray& array) {
+  return TransformArrowArray(TransformType::kBucket, *source_type(), array, num_buckets_);
+}
+
 std::shared_ptr<Type> BucketTransform::ResultType() const { return int32(); }
 
 Result<std::unique_ptr<TransformFunction>> BucketTransform::Make(
@@ -104,6 +113,10 @@ Result<Literal> TruncateTransform::Transform(const Literal& literal) {
   return TruncateUtils::TruncateLiteral(literal, width_);
 }
 
+Result<ArrowArray> TruncateTransform::TransformArray(const ArrowArray& array) {
+  return TransformArrowArray(TransformType::kTruncate, *source_type(), array, width_);
+}
+
 std::shared_ptr<Type> TruncateTransform::ResultType() const { return source_type(); }
 
 Result<std::unique_ptr<TransformFunction>> TruncateTransform::Make(
@@ -137,6 +150,10 @@ Result<Literal> YearTransform::Transform(const Literal& literal) {
   return TemporalUtils::ExtractYear(literal);
 }
 
+Result<ArrowArray> YearTransform::TransformArray(const ArrowArray& array) {
+  return TransformArrowArray(TransformType::kYear, *source_type(), array);
+}
+
 std::shared_ptr<Type> YearTransform::ResultType() const { return int32(); }
 
 Result<std::unique_ptr<TransformFunction>> YearTransform::Make(
@@ -165,6 +182,10 @@ Result<Literal> MonthTransform::Transform(const Literal& literal) {
   return TemporalUtils::ExtractMonth(literal);
 }
 
+Result<ArrowArray> MonthTransform::TransformArray(const ArrowArray& array) {
+  return TransformArrowArray(TransformType::kMonth, *source_type(), array);
+}
+
 std::shared_ptr<Type> MonthTransform::ResultType() const { return int32(); }
 
 Result<std::unique_ptr<TransformFunction>> MonthTransform::Make(
@@ -193,6 +214,10 @@ Result<Literal> DayTransform::Transform(const Literal& literal) {
   return TemporalUtils::ExtractDay(literal);
 }
 
+Result<ArrowArray> DayTransform::TransformArray(const ArrowArray& array) {
+  return TransformArrowArray(TransformType::kDay, *source_type(), array);
+}
+
 std::shared_ptr<Type> DayTransform::ResultType() const { return int32(); }
 
 Result<std::unique_ptr<TransformFunction>> DayTransform::Make(
@@ -221,6 +246,10 @@ Result<Literal> HourTransform::Transform(const Literal& literal) {
   return TemporalUtils::ExtractHour(literal);
 }
 
+Result<ArrowArray> HourTransform::TransformArray(const ArrowArray& array) {
+  return TransformArrowArray(TransformType::kHour, *source_type(), array);
+}
+
 std::shared_ptr<Type> HourTransform::ResultType() const { return int32(); }
 
 Result<std::unique_ptr<TransformFunction>> HourTransform::Make(
@@ -246,6 +275,10 @@ Result<Literal> VoidTransform::Transform(const Literal& literal) {
   return literal.IsNull() ? literal : Literal::Null(literal.type());
 }
 
+Result<ArrowArray> VoidTransform::TransformArray(const ArrowArray& array) {
+  return TransformArrowArray(TransformType::kVoid, *source_type(), array);
+}
+
 std::shared_ptr<Type> VoidTransform::ResultType() const { return source_type(); }
 
 Result<std::unique_ptr<TransformFunction>> VoidTransform::Make(
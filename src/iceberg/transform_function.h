@@ -33,6 +33,9 @@ class ICEBERG_EXPORT IdentityTransform : public TransformFunction {
   /// \brief Returns the same Literal as the input.
   Result<Literal> Transform(const Literal& literal) override;
 
+  /// \brief Returns a copy of the input array.
+  Result<ArrowArray> TransformArray(const ArrowArray& array) override;
+
   /// \brief Returns the same type as source_type.
   std::shared_ptr<Type> ResultType() const override;
 
@@ -56,6 +59,9 @@ class ICEBERG_EXPORT BucketTransform : public TransformFunction {
   /// - https://iceberg.apache.org/spec/#appendix-b-32-bit-hash-requirements
   Result<Literal> Transform(const Literal& literal) override;
 
+  /// \brief Applies the bucket hash function to the values of an Arrow array.
+  Result<ArrowArray> TransformArray(const ArrowArray& array) override;
+
   /// \brief Returns INT32 as the output type.
   std::shared_ptr<Type> ResultType() const override;
 
@@ -80,6 +86,9 @@ class ICEBERG_EXPORT TruncateTransform : public TransformFunction {
   /// \brief Truncates the input Literal to the specified width.
   Result<Literal> Transform(const Literal& literal) override;
 
+  /// \brief Truncates the values of an Arrow array to the specified width.
+  Result<ArrowArray> TransformArray(const ArrowArray& array) override;
+
   /// \brief Returns the same type as source_type.
   std::shared_ptr<Type> ResultType() const override;
 
@@ -103,6 +112,9 @@ class ICEBERG_EXPORT YearTransform : public TransformFunction {
   /// \brief Extract a date or timestamp year, as years from 1970.
   Result<Literal> Transform(const Literal& literal) override;
 
+  /// \brief Extracts the years of the values of an Arrow array.
+  Result<ArrowArray> TransformArray(const ArrowArray& array) override;
+
   /// \brief Returns INT32 as the output type.
   std::shared_ptr<Type> ResultType() const override;
 
@@ -122,6 +134,9 @@ class ICEBERG_EXPORT MonthTransform : public TransformFunction {
   /// \brief Extract a date or timestamp month, as months from 1970-01-01.
   Result<Literal> Transform(const Literal& literal) override;
 
+  /// \brief Extracts the months of the values of an Arrow array.
+  Result<ArrowArray> TransformArray(const ArrowArray& array) override;
+
   /// \brief Returns INT32 as the output type.
   std::shared_ptr<Type> ResultType() const override;
 
@@ -141,6 +156,9 @@ class ICEBERG_EXPORT DayTransform : public TransformFunction {
   /// \brief Extract a date or timestamp day, as days from 1970-01-01.
   Result<Literal> Transform(const Literal& literal) override;
 
+  /// \brief Extracts the days of the values of an Arrow array.
+  Result<ArrowArray> TransformArray(const ArrowArray& array) override;
+
   /// \brief Returns INT32 as the output type.
   std::shared_ptr<Type> ResultType() const override;
 
@@ -160,6 +178,9 @@ class ICEBERG_EXPORT HourTransform : public TransformFunction {
   /// \brief Extract a timestamp hour, as hours from 1970-01-01 00:00:00.
   Result<Literal> Transform(const Literal& literal) override;
 
+  /// \brief Extracts the hours of the values of an Arrow array.
+  Result<ArrowArray> TransformArray(const ArrowArray& array) override;
+
   /// \brief Returns INT32 as the output type.
   std::shared_ptr<Type> ResultType() const override;
 
@@ -179,6 +200,9 @@ class ICEBERG_EXPORT VoidTransform : public TransformFunction {
   /// \brief Returns a null literal.
   Result<Literal> Transform(const Literal& literal) override;
 
+  /// \brief Returns an array of nulls with the length of the input array.
+  Result<ArrowArray> TransformArray(const ArrowArray& array) override;
+
   /// \brief Returns the same type as source_type.
   std::shared_ptr<Type> ResultType() const override;
 
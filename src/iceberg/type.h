@@ -464,6 +464,29 @@ class ICEBERG_EXPORT UuidType : public PrimitiveType {
 
 /// @}
 
+/// \brief A data type representing a semi-structured value in the variant binary
+///   encoding, such as a JSON document.
+///
+/// A variant is neither primitive nor nested: its values describe their own types,
+/// and data files may store the values of some paths in typed columns, which is called
+/// shredding. Variants require format version 3.
+class ICEBERG_EXPORT VariantType : public Type {
+ public:
+  constexpr static const TypeId kTypeId = TypeId::kVariant;
+
+  VariantType() = default;
+  ~VariantType() override = default;
+
+  bool is_primitive() const override { return false; }
+  bool is_nested() const override { return false; }
+
+  TypeId type_id() const override;
+  std::string ToString() const override;
+
+ protected:
+  bool Equals(const Type& other) const override;
+};
+
 /// \defgroup type-factories Factory functions for creating primitive data types
 ///
 /// Factory functions for creating primitive data types
@@ -493,6 +516,8 @@ ICEBERG_EXPORT const std::shared_ptr<BinaryType>& binary();
 ICEBERG_EXPORT const std::shared_ptr<StringType>& string();
 /// \brief Return a UuidType instance.
 ICEBERG_EXPORT const std::shared_ptr<UuidType>& uuid();
+/// \brief Return a VariantType instance.
+ICEBERG_EXPORT const std::shared_ptr<VariantType>& variant();
 
 /// \brief Create a DecimalType with the given precision and scale.
 /// \param precision The number of decimal digits (max 38).
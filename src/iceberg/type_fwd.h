@@ -50,6 +50,7 @@ enum class TypeId {
   kUuid,
   kFixed,
   kBinary,
+  kVariant,
 };
 
 /// \brief The time unit.  In Iceberg V3 nanoseconds are also supported.
@@ -82,13 +83,21 @@ class TimestampType;
 class TimestampTzType;
 class Type;
 class UuidType;
+class VariantType;
 
 struct Namespace;
 struct TableIdentifier;
 
 class Catalog;
+class Executor;
 class FileIO;
+template <typename T>
+class Task;
+class InputFile;
 class LocationProvider;
+class MemoryPool;
+class MetadataInternPool;
+class OutputFile;
 class SortField;
 class SortOrder;
 class Table;
@@ -96,15 +105,23 @@ class TableProperties;
 class FileIO;
 class Transaction;
 class Transform;
+class TrackingMemoryPool;
 class TransformFunction;
 
+class CompactSnapshots;
 struct PartitionStatisticsFile;
 struct Snapshot;
 struct SnapshotRef;
 
 struct MetadataLogEntry;
 struct SnapshotLogEntry;
+class SnapshotLogIndex;
+class ScanPlanCache;
+class ScanTaskSpill;
+class SpecEvaluatorCache;
+struct SpecEvaluators;
 
+class BloomFilterIndex;
 struct StatisticsFile;
 struct TableMetadata;
 
@@ -112,6 +129,16 @@ struct MappedField;
 class MappedFields;
 class NameMapping;
 
+struct Metrics;
+class MetricsConfig;
+struct MetricsMode;
+class MetricsReporter;
+struct CommitReport;
+struct ReadMetrics;
+struct ScanExplain;
+struct ScanMetrics;
+struct ScanReport;
+
 enum class SnapshotRefType;
 enum class TransformType;
 
@@ -120,9 +147,23 @@ class Uuid;
 
 class Expression;
 class Literal;
-
+class ManifestEvaluator;
+class ResidualEvaluator;
+
+class BoundPredicate;
+class BoundReference;
+class BoundTerm;
+class NamedReference;
+template <typename B>
+class UnboundPredicate;
+
+class ChangelogScanTask;
+class CombinedScanTask;
 class DataTableScan;
 class FileScanTask;
+class IncrementalAppendScan;
+class IncrementalChangelogScan;
+class MetadataTableScan;
 class ScanTask;
 class TableScan;
 class TableScanBuilder;
@@ -131,15 +172,25 @@ struct DataFile;
 struct ManifestEntry;
 struct ManifestFile;
 struct ManifestList;
+struct ManifestShard;
 struct PartitionFieldSummary;
 
+class InheritableMetadata;
+class ManifestEntryBatch;
+class ManifestListDiffer;
 class ManifestListReader;
 class ManifestListWriter;
 class ManifestReader;
 class ManifestWriter;
 
+class DeleteFileIndex;
+class DeleteLoader;
+class EqualityDeleteSet;
+class PositionDeleteIndex;
+
 class Reader;
 class Writer;
+struct WriterOptions;
 
 class StructLike;
 class ArrayLike;
@@ -150,11 +201,23 @@ class TableRequirement;
 class TableMetadataBuilder;
 class TableUpdateContext;
 
+class AppendFiles;
+class ConvertEqualityDeleteFiles;
+class ExpireSnapshots;
+class FastAppend;
+class ImportFiles;
+class MergeAppend;
+class RemoveOrphanFiles;
+class RewriteDataFiles;
+class RewriteFiles;
+class RewriteManifests;
+class RowDelta;
+class SnapshotProducer;
+
 /// ----------------------------------------------------------------------------
 /// TODO: Forward declarations below are not added yet.
 /// ----------------------------------------------------------------------------
 
-class AppendFiles;
 class EncryptedKey;
 
 }  // namespace iceberg
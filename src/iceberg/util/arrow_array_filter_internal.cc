@@ -0,0 +1,601 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/util/arrow_array_filter_internal.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+// Consumers may reject null pointers for data buffers, even when they are empty.
+constexpr uint8_t kEmptyBuffer[8] = {};
+
+/// \brief Private data of the arrays produced by FilterArrowArray.
+struct OwnedArrayData {
+  ~OwnedArrayData() {
+    for (auto& child : children) {
+      if (child.release != nullptr) {
+        child.release(&child);
+      }
+    }
+    if (dictionary.release != nullptr) {
+      dictionary.release(&dictionary);
+    }
+  }
+
+  std::vector<std::vector<uint8_t>> buffers;
+  std::vector<const void*> buffer_pointers;
+  std::vector<ArrowArray> children;
+  std::vector<ArrowArray*> child_pointers;
+  ArrowArray dictionary{};
+};
+
+void ReleaseOwnedArray(ArrowArray* array) {
+  delete static_cast<OwnedArrayData*>(array->private_data);
+  array->private_data = nullptr;
+  array->release = nullptr;
+}
+
+bool GetBit(const uint8_t* bitmap, int64_t index) {
+  return (bitmap[index >> 3] >> (index & 7)) & 1;
+}
+
+void SetBit(uint8_t* bitmap, int64_t index) {
+  bitmap[index >> 3] |= static_cast<uint8_t>(1 << (index & 7));
+}
+
+Result<int64_t> ParseWidth(std::string_view format, std::string_view digits) {
+  int64_t width = 0;
+  auto [ptr, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), width);
+  if (ec != std::errc() || ptr != digits.data() + digits.size() || width <= 0) {
+    return InvalidArrowData("Invalid Arrow format: {}", format);
+  }
+  return width;
+}
+
+/// \brief Returns the byte width of the values of a fixed-width Arrow format.
+Result<int64_t> FixedWidth(std::string_view format) {
+  if (format.size() == 1) {
+    switch (format[0]) {
+      case 'c':
+      case 'C':
+        return 1;
+      case 's':
+      case 'S':
+      case 'e':
+        return 2;
+      case 'i':
+      case 'I':
+      case 'f':
+        return 4;
+      case 'l':
+      case 'L':
+      case 'g':
+        return 8;
+      default:
+        break;
+    }
+  }
+  if (format.starts_with("d:")) {
+    // Decimals are d:precision,scale[,bitwidth] with a default bit width of 128.
+    if (std::ranges::count(format, ',') < 2) {
+      return 16;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(auto bit_width,
+                            ParseWidth(format, format.substr(format.rfind(',') + 1)));
+    return bit_width / 8;
+  }
+  if (format.starts_with("w:")) {
+    return ParseWidth(format, format.substr(2));
+  }
+  if (format == "tdD" || format == "tts" || format == "ttm" || format == "tiM") {
+    return 4;
+  }
+  if (format == "tdm" || format == "ttu" || format == "ttn" || format == "tiD" ||
+      format.starts_with("ts") || format.starts_with("tD")) {
+    return 8;
+  }
+  if (format == "tin") {
+    return 16;
+  }
+  return NotSupported("Cannot filter Arrow arrays of format {}", format);
+}
+
+Status CheckLayout(const ArrowArray& array, std::string_view format, int64_t n_buffers,
+                   int64_t n_children) {
+  if (array.n_buffers != n_buffers || array.n_children != n_children) {
+    return InvalidArrowData(
+        "Arrow array of format {} has {} buffers and {} children, expected {} and {}",
+        format, array.n_buffers, array.n_children, n_buffers, n_children);
+  }
+  return {};
+}
+
+/// \brief The position of a value in one of the source arrays of a take, including the
+/// offset of the array.
+struct Position {
+  int64_t array;
+  int64_t index;
+};
+
+Status Take(const ArrowSchema& schema, std::span<const ArrowArray* const> arrays,
+            const std::vector<Position>& positions, ArrowArray* out);
+
+/// \brief Copies the offsets of the selected list elements and collects the positions
+/// of their values in the child arrays.
+template <typename Offset>
+std::vector<Position> TakeOffsets(std::span<const ArrowArray* const> arrays,
+                                  const std::vector<Position>& positions,
+                                  std::vector<uint8_t>& out_offsets) {
+  out_offsets.resize((positions.size() + 1) * sizeof(Offset));
+  auto* new_offsets = reinterpret_cast<Offset*>(out_offsets.data());
+  new_offsets[0] = 0;
+  std::vector<Position> value_positions;
+  for (size_t k = 0; k < positions.size(); ++k) {
+    const auto [array, index] = positions[k];
+    const auto* offsets = static_cast<const Offset*>(arrays[array]->buffers[1]);
+    const Offset start = offsets[index];
+    const Offset end = offsets[index + 1];
+    for (Offset j = start; j < end; ++j) {
+      value_positions.push_back({array, j});
+    }
+    new_offsets[k + 1] = new_offsets[k] + (end - start);
+  }
+  return value_positions;
+}
+
+template <typename Offset>
+void TakeBinary(std::span<const ArrowArray* const> arrays,
+                const std::vector<Position>& positions, OwnedArrayData& data) {
+  auto& out_offsets = data.buffers.emplace_back((positions.size() + 1) * sizeof(Offset));
+  auto& out_values = data.buffers.emplace_back();
+  auto* new_offsets = reinterpret_cast<Offset*>(out_offsets.data());
+  new_offsets[0] = 0;
+  for (size_t k = 0; k < positions.size(); ++k) {
+    const auto [array, index] = positions[k];
+    const auto* offsets = static_cast<const Offset*>(arrays[array]->buffers[1]);
+    const auto* values = static_cast<const uint8_t*>(arrays[array]->buffers[2]);
+    const Offset start = offsets[index];
+    const Offset end = offsets[index + 1];
+    out_values.insert(out_values.end(), values + start, values + end);
+    new_offsets[k + 1] = static_cast<Offset>(out_values.size());
+  }
+}
+
+Status TakeChild(const ArrowSchema& schema, std::span<const ArrowArray* const> arrays,
+                 const std::vector<bool>& used, int64_t pos,
+                 std::vector<Position> child_positions, OwnedArrayData& data) {
+  // Only the arrays of the taken values are required to be valid.
+  std::vector<const ArrowArray*> children(arrays.size(), nullptr);
+  for (size_t i = 0; i < arrays.size(); ++i) {
+    if (used[i]) {
+      children[i] = arrays[i]->children[pos];
+    }
+  }
+  for (auto& position : child_positions) {
+    position.index += children[position.array]->offset;
+  }
+  return Take(*schema.children[pos], children, child_positions, &data.children[pos]);
+}
+
+/// \brief Adds to the taken dictionary indices the position of the dictionary of
+/// their array in the merged dictionary. Null values get index 0.
+template <typename Index>
+Status RebaseIndices(OwnedArrayData& data, const std::vector<Position>& positions,
+                     const std::vector<int64_t>& bases) {
+  const auto& validity = data.buffers[0];
+  auto* indices = reinterpret_cast<Index*>(data.buffers[1].data());
+  for (size_t k = 0; k < positions.size(); ++k) {
+    if (!validity.empty() && !GetBit(validity.data(), static_cast<int64_t>(k))) {
+      indices[k] = 0;
+      continue;
+    }
+    const int64_t index = static_cast<int64_t>(indices[k]) + bases[positions[k].array];
+    if (index > static_cast<int64_t>(std::numeric_limits<Index>::max())) {
+      return NotSupported("Cannot merge Arrow dictionaries into more than {} values",
+                          std::numeric_limits<Index>::max());
+    }
+    indices[k] = static_cast<Index>(index);
+  }
+  return {};
+}
+
+/// \brief Copies the indices at the given positions of dictionary-encoded arrays, with
+/// a dictionary that holds the dictionaries of the arrays one after the other. Arrays
+/// that share their dictionary share it in the new array too.
+Status TakeDictionary(const ArrowSchema& schema,
+                      std::span<const ArrowArray* const> arrays,
+                      const std::vector<Position>& positions, ArrowArray* out) {
+  std::vector<bool> used(arrays.size(), false);
+  for (const auto& position : positions) {
+    used[position.array] = true;
+  }
+  std::vector<const ArrowArray*> dictionaries(arrays.size(), nullptr);
+  std::vector<Position> dictionary_positions;
+  std::vector<int64_t> bases(arrays.size(), 0);
+  bool rebase = false;
+  for (size_t i = 0; i < arrays.size(); ++i) {
+    if (!used[i]) {
+      continue;
+    }
+    const ArrowArray* dictionary = arrays[i]->dictionary;
+    if (dictionary == nullptr) {
+      return InvalidArrowData("Dictionary-encoded Arrow array has no dictionary");
+    }
+    dictionaries[i] = dictionary;
+    auto shared = std::ranges::find(dictionaries.begin(), dictionaries.begin() + i,
+                                    dictionary);
+    if (shared != dictionaries.begin() + i) {
+      bases[i] = bases[shared - dictionaries.begin()];
+      continue;
+    }
+    bases[i] = static_cast<int64_t>(dictionary_positions.size());
+    rebase |= bases[i] != 0;
+    for (int64_t j = 0; j < dictionary->length; ++j) {
+      dictionary_positions.push_back(
+          {static_cast<int64_t>(i), dictionary->offset + j});
+    }
+  }
+
+  ArrowSchema index_schema = schema;
+  index_schema.dictionary = nullptr;
+  ICEBERG_RETURN_UNEXPECTED(Take(index_schema, arrays, positions, out));
+  auto& data = *static_cast<OwnedArrayData*>(out->private_data);
+  if (rebase) {
+    std::string_view format = schema.format;
+    Status status;
+    if (format == "c") {
+      status = RebaseIndices<int8_t>(data, positions, bases);
+    } else if (format == "C") {
+      status = RebaseIndices<uint8_t>(data, positions, bases);
+    } else if (format == "s") {
+      status = RebaseIndices<int16_t>(data, positions, bases);
+    } else if (format == "S") {
+      status = RebaseIndices<uint16_t>(data, positions, bases);
+    } else if (format == "i") {
+      status = RebaseIndices<int32_t>(data, positions, bases);
+    } else if (format == "I") {
+      status = RebaseIndices<uint32_t>(data, positions, bases);
+    } else if (format == "l") {
+      status = RebaseIndices<int64_t>(data, positions, bases);
+    } else {
+      status = InvalidArrowData("Unsupported Arrow dictionary index format {}", format);
+    }
+    if (!status.has_value()) {
+      out->release(out);
+      return status;
+    }
+  }
+  auto status = Take(*schema.dictionary, dictionaries, dictionary_positions,
+                     &data.dictionary);
+  if (!status.has_value()) {
+    out->release(out);
+    return status;
+  }
+  out->dictionary = &data.dictionary;
+  return {};
+}
+
+/// \brief Copies the values at the given positions of the arrays, where positions
+/// already include the offsets of the arrays.
+Status Take(const ArrowSchema& schema, std::span<const ArrowArray* const> arrays,
+            const std::vector<Position>& positions, ArrowArray* out) {
+  if (schema.dictionary != nullptr) {
+    return TakeDictionary(schema, arrays, positions, out);
+  }
+  std::string_view format = schema.format;
+  std::vector<bool> used(arrays.size(), false);
+  for (const auto& position : positions) {
+    used[position.array] = true;
+  }
+  bool has_nulls = false;
+  for (size_t i = 0; i < arrays.size(); ++i) {
+    if (!used[i]) {
+      continue;
+    }
+    const ArrowArray& array = *arrays[i];
+    if (schema.n_children != array.n_children) {
+      return InvalidArrowData("Arrow schema has {} children but array has {}",
+                              schema.n_children, array.n_children);
+    }
+    if (format != "n" && array.n_buffers < 1) {
+      return InvalidArrowData("Arrow array of format {} has no validity buffer", format);
+    }
+    has_nulls |= format != "n" && array.null_count != 0 && array.buffers[0] != nullptr;
+  }
+
+  const auto length = static_cast<int64_t>(positions.size());
+  auto data = std::make_unique<OwnedArrayData>();
+  // Buffers are referenced while the next ones are added.
+  data->buffers.reserve(3);
+  data->children.resize(schema.n_children);
+  int64_t null_count = 0;
+
+  if (format == "n") {
+    for (size_t i = 0; i < arrays.size(); ++i) {
+      if (used[i]) {
+        ICEBERG_RETURN_UNEXPECTED(CheckLayout(*arrays[i], format, 0, 0));
+      }
+    }
+    null_count = length;
+  } else {
+    auto& validity = data->buffers.emplace_back();
+    if (has_nulls) {
+      validity.resize((length + 7) / 8, 0);
+      for (int64_t k = 0; k < length; ++k) {
+        const auto [array, index] = positions[k];
+        const ArrowArray& source = *arrays[array];
+        const auto* source_validity = static_cast<const uint8_t*>(source.buffers[0]);
+        if (source.null_count == 0 || source_validity == nullptr ||
+            GetBit(source_validity, index)) {
+          SetBit(validity.data(), k);
+        } else {
+          ++null_count;
+        }
+      }
+    }
+  }
+
+  auto check_layout = [&](int64_t n_buffers, int64_t n_children) -> Status {
+    for (size_t i = 0; i < arrays.size(); ++i) {
+      if (used[i]) {
+        ICEBERG_RETURN_UNEXPECTED(
+            CheckLayout(*arrays[i], format, n_buffers, n_children));
+      }
+    }
+    return {};
+  };
+
+  if (format == "n") {
+    // Null arrays do not have buffers.
+  } else if (format == "+s") {
+    ICEBERG_RETURN_UNEXPECTED(check_layout(1, schema.n_children));
+    for (int64_t pos = 0; pos < schema.n_children; ++pos) {
+      ICEBERG_RETURN_UNEXPECTED(TakeChild(schema, arrays, used, pos, positions, *data));
+    }
+  } else if (format == "+l" || format == "+m") {
+    ICEBERG_RETURN_UNEXPECTED(check_layout(2, 1));
+    auto value_positions =
+        TakeOffsets<int32_t>(arrays, positions, data->buffers.emplace_back());
+    ICEBERG_RETURN_UNEXPECTED(
+        TakeChild(schema, arrays, used, 0, std::move(value_positions), *data));
+  } else if (format == "+L") {
+    ICEBERG_RETURN_UNEXPECTED(check_layout(2, 1));
+    auto value_positions =
+        TakeOffsets<int64_t>(arrays, positions, data->buffers.emplace_back());
+    ICEBERG_RETURN_UNEXPECTED(
+        TakeChild(schema, arrays, used, 0, std::move(value_positions), *data));
+  } else if (format.starts_with("+w:")) {
+    ICEBERG_RETURN_UNEXPECTED(check_layout(1, 1));
+    ICEBERG_ASSIGN_OR_RAISE(auto list_size, ParseWidth(format, format.substr(3)));
+    std::vector<Position> value_positions;
+    value_positions.reserve(length * list_size);
+    for (const auto [array, index] : positions) {
+      for (int64_t j = 0; j < list_size; ++j) {
+        value_positions.push_back({array, index * list_size + j});
+      }
+    }
+    ICEBERG_RETURN_UNEXPECTED(
+        TakeChild(schema, arrays, used, 0, std::move(value_positions), *data));
+  } else if (format == "u" || format == "z") {
+    ICEBERG_RETURN_UNEXPECTED(check_layout(3, 0));
+    TakeBinary<int32_t>(arrays, positions, *data);
+  } else if (format == "U" || format == "Z") {
+    ICEBERG_RETURN_UNEXPECTED(check_layout(3, 0));
+    TakeBinary<int64_t>(arrays, positions, *data);
+  } else if (format == "b") {
+    ICEBERG_RETURN_UNEXPECTED(check_layout(2, 0));
+    auto& out_values = data->buffers.emplace_back((length + 7) / 8, 0);
+    for (int64_t k = 0; k < length; ++k) {
+      const auto [array, index] = positions[k];
+      if (GetBit(static_cast<const uint8_t*>(arrays[array]->buffers[1]), index)) {
+        SetBit(out_values.data(), k);
+      }
+    }
+  } else if (format.starts_with('+')) {
+    return NotSupported("Cannot filter Arrow arrays of format {}", format);
+  } else {
+    ICEBERG_RETURN_UNEXPECTED(check_layout(2, 0));
+    ICEBERG_ASSIGN_OR_RAISE(auto width, FixedWidth(format));
+    auto& out_values = data->buffers.emplace_back(length * width);
+    for (int64_t k = 0; k < length; ++k) {
+      const auto [array, index] = positions[k];
+      std::memcpy(out_values.data() + k * width,
+                  static_cast<const uint8_t*>(arrays[array]->buffers[1]) + index * width,
+                  width);
+    }
+  }
+
+  for (size_t i = 0; i < data->buffers.size(); ++i) {
+    const auto& buffer = data->buffers[i];
+    if (!buffer.empty()) {
+      data->buffer_pointers.push_back(buffer.data());
+    } else {
+      // An empty validity buffer means that all values are valid.
+      data->buffer_pointers.push_back(i == 0 ? nullptr : kEmptyBuffer);
+    }
+  }
+  for (auto& child : data->children) {
+    data->child_pointers.push_back(&child);
+  }
+
+  *out = ArrowArray{.length = length,
+                    .null_count = null_count,
+                    .offset = 0,
+                    .n_buffers = static_cast<int64_t>(data->buffer_pointers.size()),
+                    .n_children = static_cast<int64_t>(data->child_pointers.size()),
+                    .buffers = data->buffer_pointers.data(),
+                    .children = data->child_pointers.data(),
+                    .dictionary = nullptr,
+                    .release = ReleaseOwnedArray,
+                    .private_data = nullptr};
+  out->private_data = data.release();
+  return {};
+}
+
+/// \brief Estimates the size of `length` values of an array from position `offset`,
+/// where the offset already includes the offset of the array.
+Result<int64_t> EstimateSize(const ArrowSchema& schema, const ArrowArray& array,
+                             int64_t offset, int64_t length) {
+  std::string_view format = schema.format;
+  if (format == "n" || length == 0) {
+    return 0;
+  }
+  if (schema.dictionary != nullptr) {
+    const ArrowArray* dictionary = array.dictionary;
+    if (dictionary == nullptr) {
+      return InvalidArrowData("Dictionary-encoded Arrow array has no dictionary");
+    }
+    ArrowSchema index_schema = schema;
+    index_schema.dictionary = nullptr;
+    ICEBERG_ASSIGN_OR_RAISE(auto indices,
+                            EstimateSize(index_schema, array, offset, length));
+    ICEBERG_ASSIGN_OR_RAISE(auto values,
+                            EstimateSize(*schema.dictionary, *dictionary,
+                                         dictionary->offset, dictionary->length));
+    return indices + values;
+  }
+  if (schema.n_children != array.n_children) {
+    return InvalidArrowData("Arrow schema has {} children but array has {}",
+                            schema.n_children, array.n_children);
+  }
+  const int64_t bitmap_size = (length + 7) / 8;
+  int64_t size = array.n_buffers > 0 && array.buffers[0] != nullptr ? bitmap_size : 0;
+  auto child_size = [&](int64_t pos, int64_t child_offset,
+                        int64_t child_length) -> Result<int64_t> {
+    const ArrowArray& child = *array.children[pos];
+    return EstimateSize(*schema.children[pos], child, child.offset + child_offset,
+                        child_length);
+  };
+  auto offsets_range = [&]<typename Offset>(Offset) {
+    const auto* offsets = static_cast<const Offset*>(array.buffers[1]);
+    return std::pair<int64_t, int64_t>{offsets[offset],
+                                       offsets[offset + length] - offsets[offset]};
+  };
+
+  if (format == "+s") {
+    for (int64_t pos = 0; pos < array.n_children; ++pos) {
+      ICEBERG_ASSIGN_OR_RAISE(auto child, child_size(pos, offset, length));
+      size += child;
+    }
+  } else if (format == "+l" || format == "+m" || format == "+L") {
+    ICEBERG_RETURN_UNEXPECTED(CheckLayout(array, format, 2, 1));
+    const bool large = format == "+L";
+    auto [start, count] = large ? offsets_range(int64_t{}) : offsets_range(int32_t{});
+    ICEBERG_ASSIGN_OR_RAISE(auto child, child_size(0, start, count));
+    size += (length + 1) * (large ? 8 : 4) + child;
+  } else if (format.starts_with("+w:")) {
+    ICEBERG_RETURN_UNEXPECTED(CheckLayout(array, format, 1, 1));
+    ICEBERG_ASSIGN_OR_RAISE(auto list_size, ParseWidth(format, format.substr(3)));
+    ICEBERG_ASSIGN_OR_RAISE(auto child,
+                            child_size(0, offset * list_size, length * list_size));
+    size += child;
+  } else if (format == "u" || format == "z" || format == "U" || format == "Z") {
+    ICEBERG_RETURN_UNEXPECTED(CheckLayout(array, format, 3, 0));
+    const bool large = format == "U" || format == "Z";
+    auto value_bytes =
+        (large ? offsets_range(int64_t{}) : offsets_range(int32_t{})).second;
+    size += (length + 1) * (large ? 8 : 4) + value_bytes;
+  } else if (format == "b") {
+    size += bitmap_size;
+  } else if (format.starts_with('+')) {
+    return NotSupported("Cannot estimate the size of Arrow arrays of format {}", format);
+  } else {
+    ICEBERG_ASSIGN_OR_RAISE(auto width, FixedWidth(format));
+    size += length * width;
+  }
+  return size;
+}
+
+}  // namespace
+
+Result<ArrowArray> FilterArrowArray(const ArrowSchema& schema, const ArrowArray& array,
+                                    std::span<const uint8_t> selection) {
+  if (static_cast<int64_t>(selection.size()) < (array.length + 7) / 8) {
+    return InvalidArgument("Selection of {} bytes is too short for {} rows",
+                           selection.size(), array.length);
+  }
+  std::vector<Position> positions;
+  for (int64_t i = 0; i < array.length; ++i) {
+    if (GetBit(selection.data(), i)) {
+      positions.push_back({0, array.offset + i});
+    }
+  }
+  const ArrowArray* arrays[] = {&array};
+  ArrowArray out{};
+  ICEBERG_RETURN_UNEXPECTED(Take(schema, arrays, positions, &out));
+  return out;
+}
+
+Result<ArrowArray> TakeArrowArray(const ArrowSchema& schema, const ArrowArray& array,
+                                  std::span<const int64_t> indices) {
+  std::vector<Position> positions;
+  positions.reserve(indices.size());
+  for (int64_t index : indices) {
+    if (index < 0 || index >= array.length) {
+      return InvalidArgument("Row index {} is out of range for {} rows", index,
+                             array.length);
+    }
+    positions.push_back({0, array.offset + index});
+  }
+  const ArrowArray* arrays[] = {&array};
+  ArrowArray out{};
+  ICEBERG_RETURN_UNEXPECTED(Take(schema, arrays, positions, &out));
+  return out;
+}
+
+Result<ArrowArray> TakeArrowArrays(const ArrowSchema& schema,
+                                   std::span<const ArrowArray* const> arrays,
+                                   std::span<const ArrowRowLocation> rows) {
+  std::vector<Position> positions;
+  positions.reserve(rows.size());
+  for (const auto& row : rows) {
+    if (row.array < 0 || row.array >= static_cast<int64_t>(arrays.size())) {
+      return InvalidArgument("Array index {} is out of range for {} arrays", row.array,
+                             arrays.size());
+    }
+    const ArrowArray& array = *arrays[row.array];
+    if (row.row < 0 || row.row >= array.length) {
+      return InvalidArgument("Row index {} is out of range for {} rows", row.row,
+                             array.length);
+    }
+    positions.push_back({row.array, array.offset + row.row});
+  }
+  ArrowArray out{};
+  ICEBERG_RETURN_UNEXPECTED(Take(schema, arrays, positions, &out));
+  return out;
+}
+
+Result<int64_t> EstimateArrowArraySize(const ArrowSchema& schema,
+                                       const ArrowArray& array) {
+  return EstimateSize(schema, array, array.offset, array.length);
+}
+
+}  // namespace iceberg
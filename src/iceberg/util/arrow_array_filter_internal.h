@@ -0,0 +1,91 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "iceberg/arrow_c_data.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+
+namespace iceberg {
+
+/// \brief Copies the rows of an Arrow array that are set in a selection bitmap into a
+/// new array.
+///
+/// Struct, list, map, fixed-size list, binary, string and fixed-width arrays are
+/// supported, at any level of nesting, and so are dictionary-encoded arrays, whose
+/// dictionary is copied along with the selected indices. The input array is not
+/// modified.
+///
+/// \param schema The Arrow schema of the array
+/// \param array The array to filter
+/// \param selection A bitmap in Arrow validity layout with a bit for each row of the
+/// array, ignoring the offset of the array
+/// \return A new array that owns its buffers and must be released by the caller
+ICEBERG_EXPORT Result<ArrowArray> FilterArrowArray(const ArrowSchema& schema,
+                                                   const ArrowArray& array,
+                                                   std::span<const uint8_t> selection);
+
+/// \brief Copies the rows of an Arrow array at the given indices into a new array.
+///
+/// Supports the same arrays as FilterArrowArray. Rows are copied in the order of the
+/// indices, which may repeat rows.
+///
+/// \param schema The Arrow schema of the array
+/// \param array The array to take rows from
+/// \param indices The indices of the rows to take, ignoring the offset of the array
+/// \return A new array that owns its buffers and must be released by the caller
+ICEBERG_EXPORT Result<ArrowArray> TakeArrowArray(const ArrowSchema& schema,
+                                                 const ArrowArray& array,
+                                                 std::span<const int64_t> indices);
+
+/// \brief The location of a row in a list of Arrow arrays.
+struct ICEBERG_EXPORT ArrowRowLocation {
+  /// \brief The index of the array in the list.
+  int64_t array;
+  /// \brief The index of the row in the array, ignoring the offset of the array.
+  int64_t row;
+};
+
+/// \brief Copies rows of several Arrow arrays of the same schema into a new array.
+///
+/// Supports the same arrays as FilterArrowArray. Only the arrays that rows are taken
+/// from are read, so the others may be released. The dictionaries of
+/// dictionary-encoded arrays are concatenated, unless the arrays share them.
+///
+/// \param schema The Arrow schema of the arrays
+/// \param arrays The arrays to take rows from
+/// \param rows The locations of the rows to take, in the order of the new array
+/// \return A new array that owns its buffers and must be released by the caller
+ICEBERG_EXPORT Result<ArrowArray> TakeArrowArrays(
+    const ArrowSchema& schema, std::span<const ArrowArray* const> arrays,
+    std::span<const ArrowRowLocation> rows);
+
+/// \brief Estimates the in-memory size in bytes of the rows of an Arrow array.
+///
+/// Only the buffer ranges of the rows of the array are counted, including those of
+/// their nested values, so the estimate of a slice is the size of the slice. The
+/// dictionaries of dictionary-encoded arrays are counted whole.
+ICEBERG_EXPORT Result<int64_t> EstimateArrowArraySize(const ArrowSchema& schema,
+                                                      const ArrowArray& array);
+
+}  // namespace iceberg
@@ -0,0 +1,568 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/util/arrow_metrics_internal.h"
+
+#include <cmath>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "iceberg/expression/literal.h"
+#include "iceberg/schema.h"
+#include "iceberg/type.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/int128.h"
+#include "iceberg/util/macros.h"
+#include "iceberg/util/truncate_util.h"
+#include "iceberg/util/uuid.h"
+
+namespace iceberg {
+
+namespace {
+
+bool GetBit(const uint8_t* bitmap, int64_t index) {
+  return (bitmap[index >> 3] >> (index & 7)) & 1;
+}
+
+/// \brief The metrics of a primitive column.
+struct Column {
+  int32_t field_id;
+  std::shared_ptr<PrimitiveType> type;
+  MetricsMode mode;
+  /// \brief Whether bounds are collected, which they are not in lists and maps.
+  bool collect_bounds;
+  int64_t value_count = 0;
+  int64_t null_count = 0;
+  int64_t nan_count = 0;
+  std::optional<Literal> lower_bound;
+  std::optional<Literal> upper_bound;
+};
+
+/// \brief A node of the schema, with the index of its column for primitive nodes that
+/// collect metrics.
+struct Node {
+  TypeId type_id;
+  int32_t column = -1;
+  int32_t byte_width = 0;
+  std::vector<Node> children;
+};
+
+/// \brief A range of rows of a primitive array.
+struct Rows {
+  /// \brief The index of the first row in the buffers, including the array offset.
+  int64_t start;
+  int64_t length;
+  /// \brief The validity bitmap of the array, or nullptr if it has no nulls.
+  const uint8_t* bitmap;
+  /// \brief A byte per row that is zero for the rows of null parents, or nullptr if
+  /// no parent is null.
+  const uint8_t* parent_valid;
+
+  bool IsValid(int64_t i) const {
+    return (parent_valid == nullptr || parent_valid[i] != 0) &&
+           (bitmap == nullptr || GetBit(bitmap, start + i));
+  }
+};
+
+const uint8_t* NullBitmap(const ArrowArray& array) {
+  if (array.null_count == 0 || array.n_buffers == 0) {
+    return nullptr;
+  }
+  return static_cast<const uint8_t*>(array.buffers[0]);
+}
+
+Status CheckLayout(const ArrowArray& array, TypeId type_id, int64_t n_buffers,
+                   int64_t n_children) {
+  if (array.n_buffers != n_buffers || array.n_children != n_children) {
+    return InvalidArrowData(
+        "Arrow array of type {} has {} buffers and {} children, expected {} and {}",
+        ToString(type_id), array.n_buffers, array.n_children, n_buffers, n_children);
+  }
+  return {};
+}
+
+/// \brief Less than for floating point bounds, which orders -0.0 before 0.0.
+template <typename T>
+bool FloatLess(T lhs, T rhs) {
+  return lhs < rhs || (lhs == rhs && std::signbit(lhs) && !std::signbit(rhs));
+}
+
+/// \brief Counts the null and NaN values of the rows and returns the minimum and
+/// maximum of the other values.
+template <typename T, typename GetValue, typename Less>
+std::optional<std::pair<T, T>> ScanValues(const Rows& rows, Column* column,
+                                          GetValue&& get, Less&& less) {
+  std::optional<std::pair<T, T>> bounds;
+  auto add = [&](const T& value) {
+    if constexpr (std::is_floating_point_v<T>) {
+      if (std::isnan(value)) {
+        ++column->nan_count;
+        return;
+      }
+    }
+    if (!bounds.has_value()) {
+      bounds.emplace(value, value);
+    } else if (less(value, bounds->first)) {
+      bounds->first = value;
+    } else if (less(bounds->second, value)) {
+      bounds->second = value;
+    }
+  };
+
+  if (rows.bitmap == nullptr && rows.parent_valid == nullptr) {
+    for (int64_t i = 0; i < rows.length; ++i) {
+      add(get(rows.start + i));
+    }
+  } else {
+    for (int64_t i = 0; i < rows.length; ++i) {
+      if (!rows.IsValid(i)) {
+        ++column->null_count;
+        continue;
+      }
+      add(get(rows.start + i));
+    }
+  }
+  return bounds;
+}
+
+void MergeBounds(Column* column, Literal lower, Literal upper) {
+  if (!column->lower_bound.has_value() || lower < *column->lower_bound) {
+    column->lower_bound = std::move(lower);
+  }
+  if (!column->upper_bound.has_value() || *column->upper_bound < upper) {
+    column->upper_bound = std::move(upper);
+  }
+}
+
+template <typename T, typename GetValue, typename Less, typename ToLiteral>
+void UpdateBounds(const Rows& rows, Column* column, GetValue&& get, Less&& less,
+                  ToLiteral&& to_literal) {
+  auto bounds = ScanValues<T>(rows, column, get, less);
+  if (bounds.has_value()) {
+    MergeBounds(column, to_literal(bounds->first), to_literal(bounds->second));
+  }
+}
+
+template <typename T, typename ToLiteral>
+void UpdateFixedWidth(const Rows& rows, const ArrowArray& array, Column* column,
+                      ToLiteral&& to_literal) {
+  const auto* values = static_cast<const T*>(array.buffers[1]);
+  auto get = [values](int64_t i) { return values[i]; };
+  if constexpr (std::is_floating_point_v<T>) {
+    UpdateBounds<T>(rows, column, get, FloatLess<T>, to_literal);
+  } else {
+    UpdateBounds<T>(rows, column, get, std::less<T>{}, to_literal);
+  }
+}
+
+Status UpdateColumn(const Node& node, const ArrowArray& array, const Rows& rows,
+                    Column* column) {
+  switch (node.type_id) {
+    case TypeId::kBoolean: {
+      ICEBERG_RETURN_UNEXPECTED(CheckLayout(array, node.type_id, 2, 0));
+      const auto* values = static_cast<const uint8_t*>(array.buffers[1]);
+      UpdateBounds<bool>(
+          rows, column, [values](int64_t i) { return GetBit(values, i); },
+          std::less<bool>{}, Literal::Boolean);
+      break;
+    }
+    case TypeId::kInt:
+      ICEBERG_RETURN_UNEXPECTED(CheckLayout(array, node.type_id, 2, 0));
+      UpdateFixedWidth<int32_t>(rows, array, column, Literal::Int);
+      break;
+    case TypeId::kDate:
+      ICEBERG_RETURN_UNEXPECTED(CheckLayout(array, node.type_id, 2, 0));
+      UpdateFixedWidth<int32_t>(rows, array, column, Literal::Date);
+      break;
+    case TypeId::kLong:
+      ICEBERG_RETURN_UNEXPECTED(CheckLayout(array, node.type_id, 2, 0));
+      UpdateFixedWidth<int64_t>(rows, array, column, Literal::Long);
+      break;
+    case TypeId::kTime:
+      ICEBERG_RETURN_UNEXPECTED(CheckLayout(array, node.type_id, 2, 0));
+      UpdateFixedWidth<int64_t>(rows, array, column, Literal::Time);
+      break;
+    case TypeId::kTimestamp:
+      ICEBERG_RETURN_UNEXPECTED(CheckLayout(array, node.type_id, 2, 0));
+      UpdateFixedWidth<int64_t>(rows, array, column, Literal::Timestamp);
+      break;
+    case TypeId::kTimestampTz:
+      ICEBERG_RETURN_UNEXPECTED(CheckLayout(array, node.type_id, 2, 0));
+      UpdateFixedWidth<int64_t>(rows, array, column, Literal::TimestampTz);
+      break;
+    case TypeId::kFloat:
+      ICEBERG_RETURN_UNEXPECTED(CheckLayout(array, node.type_id, 2, 0));
+      UpdateFixedWidth<float>(rows, array, column, Literal::Float);
+      break;
+    case TypeId::kDouble:
+      ICEBERG_RETURN_UNEXPECTED(CheckLayout(array, node.type_id, 2, 0));
+      UpdateFixedWidth<double>(rows, array, column, Literal::Double);
+      break;
+    case TypeId::kDecimal: {
+      ICEBERG_RETURN_UNEXPECTED(CheckLayout(array, node.type_id, 2, 0));
+      const auto& decimal_type =
+          internal::checked_cast<const DecimalType&>(*column->type);
+      const auto* values = static_cast<const uint8_t*>(array.buffers[1]);
+      UpdateBounds<int128_t>(
+          rows, column,
+          [values](int64_t i) {
+            // Arrow decimals are little-endian 128-bit integers.
+            int128_t value;
+            std::memcpy(&value, values + i * sizeof(int128_t), sizeof(int128_t));
+            return value;
+          },
+          std::less<int128_t>{},
+          [&decimal_type](int128_t value) {
+            return Literal::Decimal(value, decimal_type.precision(),
+                                    decimal_type.scale());
+          });
+      break;
+    }
+    case TypeId::kString:
+    case TypeId::kBinary: {
+      ICEBERG_RETURN_UNEXPECTED(CheckLayout(array, node.type_id, 3, 0));
+      const auto* offsets = static_cast<const int32_t*>(array.buffers[1]);
+      const auto* data = static_cast<const char*>(array.buffers[2]);
+      auto get = [offsets, data](int64_t i) {
+        return std::string_view(data + offsets[i], offsets[i + 1] - offsets[i]);
+      };
+      if (node.type_id == TypeId::kString) {
+        UpdateBounds<std::string_view>(
+            rows, column, get, std::less<std::string_view>{},
+            [](std::string_view value) { return Literal::String(std::string(value)); });
+      } else {
+        UpdateBounds<std::string_view>(
+            rows, column, get, std::less<std::string_view>{}, [](std::string_view value) {
+              return Literal::Binary(std::vector<uint8_t>(value.begin(), value.end()));
+            });
+      }
+      break;
+    }
+    case TypeId::kFixed:
+    case TypeId::kUuid: {
+      ICEBERG_RETURN_UNEXPECTED(CheckLayout(array, node.type_id, 2, 0));
+      const auto* data = static_cast<const char*>(array.buffers[1]);
+      const int64_t width = node.byte_width;
+      auto get = [data, width](int64_t i) {
+        return std::string_view(data + i * width, width);
+      };
+      auto to_bytes = [](std::string_view value) {
+        return std::vector<uint8_t>(value.begin(), value.end());
+      };
+      if (node.type_id == TypeId::kFixed) {
+        UpdateBounds<std::string_view>(
+            rows, column, get, std::less<std::string_view>{},
+            [&](std::string_view value) { return Literal::Fixed(to_bytes(value)); });
+      } else {
+        UpdateBounds<std::string_view>(
+            rows, column, get, std::less<std::string_view>{},
+            [&](std::string_view value) {
+              return Literal::UUID(Uuid::FromBytes(to_bytes(value)).value());
+            });
+      }
+      break;
+    }
+    default:
+      return NotSupported("Cannot collect metrics of type {}", ToString(node.type_id));
+  }
+  return {};
+}
+
+}  // namespace
+
+Literal TruncateLowerBound(const Literal& bound, int32_t length) {
+  if (const auto* value = std::get_if<std::string>(&bound.value());
+      value != nullptr && bound.type()->type_id() == TypeId::kString) {
+    return Literal::String(
+        value->substr(0, TruncateUtils::UTF8PrefixLength(*value, length)));
+  }
+  if (const auto* value = std::get_if<std::vector<uint8_t>>(&bound.value());
+      value != nullptr && bound.type()->type_id() == TypeId::kBinary &&
+      value->size() > static_cast<size_t>(length)) {
+    return Literal::Binary(std::vector<uint8_t>(value->begin(), value->begin() + length));
+  }
+  return bound;
+}
+
+std::optional<Literal> TruncateUpperBound(const Literal& bound, int32_t length) {
+  if (const auto* value = std::get_if<std::string>(&bound.value());
+      value != nullptr && bound.type()->type_id() == TypeId::kString) {
+    auto truncated = TruncateUtils::TruncateUTF8Max(*value, length);
+    if (!truncated.has_value()) {
+      return std::nullopt;
+    }
+    return Literal::String(std::move(*truncated));
+  }
+  if (const auto* value = std::get_if<std::vector<uint8_t>>(&bound.value());
+      value != nullptr && bound.type()->type_id() == TypeId::kBinary) {
+    auto truncated = TruncateUtils::TruncateBinaryMax(*value, length);
+    if (!truncated.has_value()) {
+      return std::nullopt;
+    }
+    return Literal::Binary(std::move(*truncated));
+  }
+  return bound;
+}
+
+class ArrowMetricsCollector::Impl {
+ public:
+  explicit Impl(MetricsConfig config) : config_(std::move(config)) {}
+
+  /// \brief Adds the nodes of the fields of a nested type.
+  Status AddChildren(const NestedType& type, bool collect_bounds, Node* node) {
+    for (const auto& field : type.fields()) {
+      ICEBERG_ASSIGN_OR_RAISE(auto child, MakeNode(field, collect_bounds));
+      node->children.push_back(std::move(child));
+    }
+    return {};
+  }
+
+  Result<Node> MakeNode(const SchemaField& field, bool collect_bounds) {
+    const auto& type = field.type();
+    Node node{.type_id = type->type_id()};
+    switch (type->type_id()) {
+      case TypeId::kStruct:
+        ICEBERG_RETURN_UNEXPECTED(AddChildren(
+            internal::checked_cast<const NestedType&>(*type), collect_bounds, &node));
+        return node;
+      case TypeId::kList:
+      case TypeId::kMap:
+        ICEBERG_RETURN_UNEXPECTED(AddChildren(
+            internal::checked_cast<const NestedType&>(*type), false, &node));
+        return node;
+      case TypeId::kFixed:
+        node.byte_width = internal::checked_cast<const FixedType&>(*type).length();
+        break;
+      case TypeId::kUuid:
+        node.byte_width = Uuid::kLength;
+        break;
+      default:
+        break;
+    }
+
+    const MetricsMode mode = config_.ColumnMode(field.field_id());
+    if (mode.kind != MetricsMode::Kind::kNone) {
+      node.column = static_cast<int32_t>(columns_.size());
+      columns_.push_back(Column{
+          .field_id = field.field_id(),
+          .type = std::static_pointer_cast<PrimitiveType>(type),
+          .mode = mode,
+          .collect_bounds = collect_bounds && mode.kind != MetricsMode::Kind::kCounts,
+      });
+    }
+    return node;
+  }
+
+  Status Init(const Schema& schema) {
+    root_.type_id = TypeId::kStruct;
+    return AddChildren(schema, /*collect_bounds=*/true, &root_);
+  }
+
+  Status Update(const ArrowArray& array) {
+    ICEBERG_RETURN_UNEXPECTED(Visit(root_, array, 0, array.length, nullptr));
+    row_count_ += array.length;
+    return {};
+  }
+
+  Metrics Finish() const {
+    Metrics metrics;
+    metrics.row_count = row_count_;
+    for (const auto& column : columns_) {
+      metrics.value_counts[column.field_id] = column.value_count;
+      metrics.null_value_counts[column.field_id] = column.null_count;
+      const TypeId type_id = column.type->type_id();
+      if (type_id == TypeId::kFloat || type_id == TypeId::kDouble) {
+        metrics.nan_value_counts[column.field_id] = column.nan_count;
+      }
+      if (!column.collect_bounds || !column.lower_bound.has_value()) {
+        continue;
+      }
+      if (column.mode.kind == MetricsMode::Kind::kTruncate) {
+        metrics.lower_bounds.emplace(
+            column.field_id, TruncateLowerBound(*column.lower_bound, column.mode.length));
+        if (auto upper = TruncateUpperBound(*column.upper_bound, column.mode.length)) {
+          metrics.upper_bounds.emplace(column.field_id, std::move(*upper));
+        }
+      } else {
+        metrics.lower_bounds.emplace(column.field_id, *column.lower_bound);
+        metrics.upper_bounds.emplace(column.field_id, *column.upper_bound);
+      }
+    }
+    return metrics;
+  }
+
+  const MetricsConfig& config() const { return config_; }
+
+ private:
+  /// \brief Updates the metrics of the columns of a node with a range of rows.
+  ///
+  /// \param start The index of the first row in the logical rows of the array, before
+  /// applying the array offset
+  /// \param parent_valid A byte per row that is zero for the rows of null parents, or
+  /// nullptr if no parent is null
+  Status Visit(const Node& node, const ArrowArray& array, int64_t start, int64_t length,
+               const uint8_t* parent_valid) {
+    const int64_t physical_start = array.offset + start;
+    const uint8_t* bitmap = NullBitmap(array);
+    switch (node.type_id) {
+      case TypeId::kStruct: {
+        ICEBERG_RETURN_UNEXPECTED(CheckLayout(
+            array, node.type_id, 1, static_cast<int64_t>(node.children.size())));
+        std::vector<uint8_t> valid;
+        const uint8_t* child_valid = parent_valid;
+        if (bitmap != nullptr) {
+          valid.resize(length);
+          for (int64_t i = 0; i < length; ++i) {
+            valid[i] = (parent_valid == nullptr || parent_valid[i] != 0) &&
+                       GetBit(bitmap, physical_start + i);
+          }
+          child_valid = valid.data();
+        }
+        // The children of struct arrays are indexed like the struct array.
+        for (size_t i = 0; i < node.children.size(); ++i) {
+          ICEBERG_RETURN_UNEXPECTED(Visit(node.children[i], *array.children[i],
+                                          physical_start, length, child_valid));
+        }
+        return {};
+      }
+      case TypeId::kList:
+      case TypeId::kMap:
+        return VisitElements(node, array, physical_start, length, bitmap, parent_valid);
+      default:
+        break;
+    }
+
+    if (node.column < 0) {
+      return {};
+    }
+    Column& column = columns_[node.column];
+    column.value_count += length;
+    Rows rows{.start = physical_start,
+              .length = length,
+              .bitmap = bitmap,
+              .parent_valid = parent_valid};
+    if (column.collect_bounds) {
+      return UpdateColumn(node, array, rows, &column);
+    }
+    return CountValues(array, rows, &column);
+  }
+
+  /// \brief Counts the null and NaN values of a column without bounds.
+  static Status CountValues(const ArrowArray& array, const Rows& rows, Column* column) {
+    const TypeId type_id = column->type->type_id();
+    if (type_id == TypeId::kFloat || type_id == TypeId::kDouble) {
+      ICEBERG_RETURN_UNEXPECTED(CheckLayout(array, type_id, 2, 0));
+    }
+    if (type_id == TypeId::kFloat) {
+      const auto* values = static_cast<const float*>(array.buffers[1]);
+      ScanValues<float>(
+          rows, column, [values](int64_t i) { return values[i]; }, FloatLess<float>);
+    } else if (type_id == TypeId::kDouble) {
+      const auto* values = static_cast<const double*>(array.buffers[1]);
+      ScanValues<double>(
+          rows, column, [values](int64_t i) { return values[i]; }, FloatLess<double>);
+    } else if (rows.bitmap != nullptr || rows.parent_valid != nullptr) {
+      for (int64_t i = 0; i < rows.length; ++i) {
+        column->null_count += rows.IsValid(i) ? 0 : 1;
+      }
+    }
+    return {};
+  }
+
+  /// \brief Updates the metrics of the elements of the non-null lists or maps in a range
+  /// of rows.
+  Status VisitElements(const Node& node, const ArrowArray& array, int64_t physical_start,
+                       int64_t length, const uint8_t* bitmap,
+                       const uint8_t* parent_valid) {
+    ICEBERG_RETURN_UNEXPECTED(CheckLayout(array, node.type_id, 2, 1));
+    const auto* offsets = static_cast<const int32_t*>(array.buffers[1]);
+    const ArrowArray& child = *array.children[0];
+    auto visit_range = [&](int64_t begin, int64_t end) -> Status {
+      const int64_t child_start = offsets[physical_start + begin];
+      const int64_t child_length = offsets[physical_start + end] - child_start;
+      if (node.type_id == TypeId::kList) {
+        return Visit(node.children[0], child, child_start, child_length, nullptr);
+      }
+      ICEBERG_RETURN_UNEXPECTED(CheckLayout(child, TypeId::kStruct, 1, 2));
+      for (size_t i = 0; i < node.children.size(); ++i) {
+        ICEBERG_RETURN_UNEXPECTED(Visit(node.children[i], *child.children[i],
+                                        child.offset + child_start, child_length,
+                                        nullptr));
+      }
+      return {};
+    };
+
+    if (bitmap == nullptr && parent_valid == nullptr) {
+      return visit_range(0, length);
+    }
+    // Null lists and maps may have elements, which are skipped.
+    int64_t run_start = -1;
+    for (int64_t i = 0; i < length; ++i) {
+      const bool valid = (parent_valid == nullptr || parent_valid[i] != 0) &&
+                         (bitmap == nullptr || GetBit(bitmap, physical_start + i));
+      if (valid && run_start < 0) {
+        run_start = i;
+      } else if (!valid && run_start >= 0) {
+        ICEBERG_RETURN_UNEXPECTED(visit_range(run_start, i));
+        run_start = -1;
+      }
+    }
+    if (run_start >= 0) {
+      ICEBERG_RETURN_UNEXPECTED(visit_range(run_start, length));
+    }
+    return {};
+  }
+
+  MetricsConfig config_;
+  Node root_;
+  std::vector<Column> columns_;
+  int64_t row_count_ = 0;
+};
+
+ArrowMetricsCollector::ArrowMetricsCollector(std::unique_ptr<Impl> impl)
+    : impl_(std::move(impl)) {}
+
+ArrowMetricsCollector::~ArrowMetricsCollector() = default;
+
+ArrowMetricsCollector::ArrowMetricsCollector(ArrowMetricsCollector&&) noexcept =
+    default;
+
+ArrowMetricsCollector& ArrowMetricsCollector::operator=(
+    ArrowMetricsCollector&&) noexcept = default;
+
+Result<ArrowMetricsCollector> ArrowMetricsCollector::Make(const Schema& schema,
+                                                          MetricsConfig config) {
+  auto impl = std::make_unique<Impl>(std::move(config));
+  ICEBERG_RETURN_UNEXPECTED(impl->Init(schema));
+  return ArrowMetricsCollector(std::move(impl));
+}
+
+Status ArrowMetricsCollector::Update(const ArrowArray& array) {
+  return impl_->Update(array);
+}
+
+Metrics ArrowMetricsCollector::Finish() const { return impl_->Finish(); }
+
+const MetricsConfig& ArrowMetricsCollector::config() const { return impl_->config(); }
+
+}  // namespace iceberg
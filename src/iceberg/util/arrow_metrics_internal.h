@@ -0,0 +1,85 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include "iceberg/arrow_c_data.h"
+#include "iceberg/expression/literal.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/metrics.h"
+#include "iceberg/metrics_config.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief Returns a lower bound truncated to the length of a kTruncate metrics mode.
+///
+/// String bounds are truncated to `length` code points and binary bounds to `length`
+/// bytes; bounds of other types are returned as they are.
+ICEBERG_EXPORT Literal TruncateLowerBound(const Literal& bound, int32_t length);
+
+/// \brief Returns an upper bound truncated to the length of a kTruncate metrics mode,
+/// or std::nullopt if no truncated value is greater than or equal to the bound.
+ICEBERG_EXPORT std::optional<Literal> TruncateUpperBound(const Literal& bound,
+                                                         int32_t length);
+
+/// \brief Collects the column metrics of the Arrow arrays written to a data file.
+///
+/// Value counts, null value counts, NaN value counts and lower and upper bounds are
+/// collected for the primitive columns of the schema, following the metrics mode of
+/// each column. Bounds are not collected for the columns in lists and maps, and string
+/// and binary bounds are truncated when the file is finished.
+class ICEBERG_EXPORT ArrowMetricsCollector {
+ public:
+  ~ArrowMetricsCollector();
+
+  ArrowMetricsCollector(ArrowMetricsCollector&&) noexcept;
+  ArrowMetricsCollector& operator=(ArrowMetricsCollector&&) noexcept;
+
+  /// \brief Makes a collector for the columns of a schema.
+  ///
+  /// \param schema The schema of the written arrays
+  /// \param config The metrics modes of the columns
+  static Result<ArrowMetricsCollector> Make(const Schema& schema, MetricsConfig config);
+
+  /// \brief Updates the metrics with the rows of an array, which keeps its ownership.
+  ///
+  /// \param array A struct array of the schema, in the layout of `ToArrowSchema`
+  Status Update(const ArrowArray& array);
+
+  /// \brief Returns the metrics of the rows updated so far.
+  Metrics Finish() const;
+
+  /// \brief Returns the metrics modes of the columns.
+  const MetricsConfig& config() const;
+
+ private:
+  class Impl;
+
+  explicit ArrowMetricsCollector(std::unique_ptr<Impl> impl);
+
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace iceberg
@@ -0,0 +1,531 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/util/arrow_transform_internal.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "iceberg/type.h"
+#include "iceberg/util/bucket_util.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/decimal.h"
+#include "iceberg/util/macros.h"
+#include "iceberg/util/truncate_util.h"
+
+namespace iceberg {
+
+namespace {
+
+// Consumers may reject null pointers for data buffers, even when they are empty.
+constexpr uint8_t kEmptyBuffer[8] = {};
+
+constexpr int64_t kMicrosPerDay = 86'400'000'000;
+constexpr int64_t kMicrosPerHour = 3'600'000'000;
+
+/// \brief Private data of the arrays produced by TransformArrowArray.
+struct OwnedBuffers {
+  std::vector<std::vector<uint8_t>> buffers;
+  std::vector<const void*> buffer_pointers;
+};
+
+void ReleaseOwnedArray(ArrowArray* array) {
+  delete static_cast<OwnedBuffers*>(array->private_data);
+  array->private_data = nullptr;
+  array->release = nullptr;
+}
+
+bool GetBit(const uint8_t* bitmap, int64_t index) {
+  return (bitmap[index >> 3] >> (index & 7)) & 1;
+}
+
+void SetBit(uint8_t* bitmap, int64_t index) {
+  bitmap[index >> 3] |= static_cast<uint8_t>(1 << (index & 7));
+}
+
+/// \brief A new array under construction, with its validity bitmap as first buffer.
+class ArrayBuilder {
+ public:
+  explicit ArrayBuilder(int64_t length) : data_(std::make_unique<OwnedBuffers>()) {
+    // Buffers are referenced while the next ones are added.
+    data_->buffers.reserve(3);
+    data_->buffers.emplace_back();
+    length_ = length;
+  }
+
+  /// \brief Copies the validity of a source array of the same length.
+  void CopyValidity(const ArrowArray& array) {
+    const auto* validity = static_cast<const uint8_t*>(array.buffers[0]);
+    if (array.null_count == 0 || validity == nullptr) {
+      return;
+    }
+    auto& out = data_->buffers[0];
+    out.assign((length_ + 7) / 8, 0);
+    if (array.offset % 8 == 0) {
+      std::memcpy(out.data(), validity + array.offset / 8, out.size());
+      if (length_ % 8 != 0) {
+        out.back() &= static_cast<uint8_t>((1 << (length_ % 8)) - 1);
+      }
+    } else {
+      for (int64_t i = 0; i < length_; ++i) {
+        if (GetBit(validity, array.offset + i)) {
+          SetBit(out.data(), i);
+        }
+      }
+    }
+    int64_t valid_count = 0;
+    for (uint8_t byte : out) {
+      valid_count += std::popcount(byte);
+    }
+    null_count_ = length_ - valid_count;
+  }
+
+  /// \brief Marks all values as null.
+  void SetAllNull() {
+    data_->buffers[0].assign((length_ + 7) / 8, 0);
+    null_count_ = length_;
+  }
+
+  /// \brief Returns the validity of the new array, or nullptr if all values are valid.
+  const uint8_t* validity() const {
+    return data_->buffers[0].empty() ? nullptr : data_->buffers[0].data();
+  }
+
+  std::vector<uint8_t>& AddBuffer(size_t size) {
+    return data_->buffers.emplace_back(size, 0);
+  }
+
+  ArrowArray Finish() && {
+    for (size_t i = 0; i < data_->buffers.size(); ++i) {
+      const auto& buffer = data_->buffers[i];
+      if (!buffer.empty()) {
+        data_->buffer_pointers.push_back(buffer.data());
+      } else {
+        // An empty validity buffer means that all values are valid.
+        data_->buffer_pointers.push_back(i == 0 ? nullptr : kEmptyBuffer);
+      }
+    }
+    auto* data = data_.release();
+    return ArrowArray{.length = length_,
+                      .null_count = null_count_,
+                      .offset = 0,
+                      .n_buffers = static_cast<int64_t>(data->buffer_pointers.size()),
+                      .n_children = 0,
+                      .buffers = data->buffer_pointers.data(),
+                      .children = nullptr,
+                      .dictionary = nullptr,
+                      .release = ReleaseOwnedArray,
+                      .private_data = data};
+  }
+
+ private:
+  std::unique_ptr<OwnedBuffers> data_;
+  int64_t length_ = 0;
+  int64_t null_count_ = 0;
+};
+
+/// \brief Maps the valid rows of an array to fixed-width output values.
+///
+/// `fn` is called with the row index in the source buffers, offset included, and is
+/// not called for null rows, whose output value is zero.
+template <typename Out, typename Fn>
+ArrowArray MapFixedWidth(const ArrowArray& array, Fn&& fn) {
+  ArrayBuilder builder(array.length);
+  builder.CopyValidity(array);
+  auto& buffer = builder.AddBuffer(array.length * sizeof(Out));
+  auto* out = reinterpret_cast<Out*>(buffer.data());
+  if (const uint8_t* validity = builder.validity(); validity == nullptr) {
+    for (int64_t i = 0; i < array.length; ++i) {
+      out[i] = fn(array.offset + i);
+    }
+  } else {
+    for (int64_t i = 0; i < array.length; ++i) {
+      if (GetBit(validity, i)) {
+        out[i] = fn(array.offset + i);
+      }
+    }
+  }
+  return std::move(builder).Finish();
+}
+
+/// \brief Maps the valid rows of a string or binary array to a prefix of their value.
+///
+/// `prefix_length` is called with the value of a row and returns the number of bytes
+/// to keep.
+template <typename Fn>
+ArrowArray MapBinaryPrefix(const ArrowArray& array, Fn&& prefix_length) {
+  const auto* offsets = static_cast<const int32_t*>(array.buffers[1]) + array.offset;
+  const auto* values = static_cast<const uint8_t*>(array.buffers[2]);
+  ArrayBuilder builder(array.length);
+  builder.CopyValidity(array);
+  const uint8_t* validity = builder.validity();
+  auto& out_offsets_buffer = builder.AddBuffer((array.length + 1) * sizeof(int32_t));
+  auto& out_values = builder.AddBuffer(0);
+  out_values.reserve(offsets[array.length] - offsets[0]);
+  auto* out_offsets = reinterpret_cast<int32_t*>(out_offsets_buffer.data());
+  for (int64_t i = 0; i < array.length; ++i) {
+    if (validity == nullptr || GetBit(validity, i)) {
+      const auto* value = values + offsets[i];
+      const size_t length = prefix_length(std::string_view(
+          reinterpret_cast<const char*>(value), offsets[i + 1] - offsets[i]));
+      out_values.insert(out_values.end(), value, value + length);
+    }
+    out_offsets[i + 1] = static_cast<int32_t>(out_values.size());
+  }
+  return std::move(builder).Finish();
+}
+
+template <typename T>
+const T* Values(const ArrowArray& array) {
+  return static_cast<const T*>(array.buffers[1]);
+}
+
+int128_t DecimalAt(const uint8_t* values, int64_t index) {
+  // Arrow decimals are little-endian 128-bit integers.
+  int128_t value;
+  std::memcpy(&value, values + index * sizeof(int128_t), sizeof(int128_t));
+  return value;
+}
+
+Result<int32_t> FixedByteWidth(const Type& type) {
+  switch (type.type_id()) {
+    case TypeId::kInt:
+    case TypeId::kDate:
+    case TypeId::kFloat:
+      return 4;
+    case TypeId::kLong:
+    case TypeId::kDouble:
+    case TypeId::kTime:
+    case TypeId::kTimestamp:
+    case TypeId::kTimestampTz:
+      return 8;
+    case TypeId::kDecimal:
+    case TypeId::kUuid:
+      return 16;
+    case TypeId::kFixed:
+      return internal::checked_cast<const FixedType&>(type).length();
+    default:
+      return NotSupported("Cannot transform Arrow arrays of type {}", type.ToString());
+  }
+}
+
+bool IsBinaryLike(const Type& type) {
+  return type.type_id() == TypeId::kString || type.type_id() == TypeId::kBinary;
+}
+
+Status CheckLayout(const Type& type, const ArrowArray& array) {
+  if (!type.is_primitive()) {
+    return NotSupported("Cannot transform Arrow arrays of type {}", type.ToString());
+  }
+  const int64_t n_buffers = IsBinaryLike(type) ? 3 : 2;
+  if (array.n_buffers != n_buffers || array.n_children != 0) {
+    return InvalidArrowData(
+        "Arrow array of type {} has {} buffers and {} children, expected {} and 0",
+        type.ToString(), array.n_buffers, array.n_children, n_buffers);
+  }
+  return {};
+}
+
+ArrowArray CopyArray(const Type& type, const ArrowArray& array, int32_t byte_width) {
+  if (IsBinaryLike(type)) {
+    return MapBinaryPrefix(array, [](std::string_view value) { return value.size(); });
+  }
+  ArrayBuilder builder(array.length);
+  builder.CopyValidity(array);
+  if (type.type_id() == TypeId::kBoolean) {
+    const auto* values = Values<uint8_t>(array);
+    auto& out = builder.AddBuffer((array.length + 7) / 8);
+    for (int64_t i = 0; i < array.length; ++i) {
+      if (GetBit(values, array.offset + i)) {
+        SetBit(out.data(), i);
+      }
+    }
+  } else {
+    auto& out = builder.AddBuffer(array.length * byte_width);
+    std::memcpy(out.data(), Values<uint8_t>(array) + array.offset * byte_width,
+                out.size());
+  }
+  return std::move(builder).Finish();
+}
+
+ArrowArray NullArray(const Type& type, int64_t length, int32_t byte_width) {
+  ArrayBuilder builder(length);
+  builder.SetAllNull();
+  if (IsBinaryLike(type)) {
+    builder.AddBuffer((length + 1) * sizeof(int32_t));
+    builder.AddBuffer(0);
+  } else if (type.type_id() == TypeId::kBoolean) {
+    builder.AddBuffer((length + 7) / 8);
+  } else {
+    builder.AddBuffer(length * byte_width);
+  }
+  return std::move(builder).Finish();
+}
+
+std::span<int32_t> AddInt32Buffer(ArrayBuilder& builder, int64_t length) {
+  auto& buffer = builder.AddBuffer(length * sizeof(int32_t));
+  return {reinterpret_cast<int32_t*>(buffer.data()), static_cast<size_t>(length)};
+}
+
+/// \brief Buckets integers with the batch hash kernels of BucketUtils.
+///
+/// Null rows are hashed too, which is cheaper than skipping them, and their bucket
+/// is left in the output.
+template <typename T>
+Result<ArrowArray> BucketIntegers(const ArrowArray& array, int32_t num_buckets) {
+  ArrayBuilder builder(array.length);
+  builder.CopyValidity(array);
+  ICEBERG_RETURN_UNEXPECTED(BucketUtils::BucketIndices(
+      {Values<T>(array) + array.offset, static_cast<size_t>(array.length)}, num_buckets,
+      AddInt32Buffer(builder, array.length)));
+  return std::move(builder).Finish();
+}
+
+Result<ArrowArray> BucketArray(const Type& type, const ArrowArray& array,
+                               int32_t num_buckets) {
+  if (num_buckets <= 0) {
+    return InvalidArgument("Number of buckets must be positive, got {}", num_buckets);
+  }
+  auto bucket = [num_buckets](int32_t hash) {
+    return (hash & std::numeric_limits<int32_t>::max()) % num_buckets;
+  };
+  switch (type.type_id()) {
+    case TypeId::kInt:
+    case TypeId::kDate:
+      return BucketIntegers<int32_t>(array, num_buckets);
+    case TypeId::kLong:
+    case TypeId::kTime:
+    case TypeId::kTimestamp:
+    case TypeId::kTimestampTz:
+      return BucketIntegers<int64_t>(array, num_buckets);
+    case TypeId::kDecimal: {
+      const auto* values = Values<uint8_t>(array);
+      return MapFixedWidth<int32_t>(array, [&](int64_t i) {
+        const auto bytes = Decimal(DecimalAt(values, i)).ToBigEndian();
+        return bucket(BucketUtils::HashBytes(bytes));
+      });
+    }
+    case TypeId::kUuid:
+    case TypeId::kFixed: {
+      ICEBERG_ASSIGN_OR_RAISE(auto width, FixedByteWidth(type));
+      const auto* values = Values<uint8_t>(array);
+      return MapFixedWidth<int32_t>(array, [&](int64_t i) {
+        return bucket(
+            BucketUtils::HashBytes({values + i * width, static_cast<size_t>(width)}));
+      });
+    }
+    case TypeId::kString:
+    case TypeId::kBinary: {
+      ArrayBuilder builder(array.length);
+      builder.CopyValidity(array);
+      const auto* values = static_cast<const uint8_t*>(array.buffers[2]);
+      ICEBERG_RETURN_UNEXPECTED(BucketUtils::BucketIndices(
+          {Values<int32_t>(array) + array.offset, static_cast<size_t>(array.length + 1)},
+          values, num_buckets, AddInt32Buffer(builder, array.length)));
+      return std::move(builder).Finish();
+    }
+    default:
+      return NotSupported("{} is not a valid input type for bucket transform",
+                          type.ToString());
+  }
+}
+
+Result<ArrowArray> TruncateArray(const Type& type, const ArrowArray& array,
+                                 int32_t width) {
+  if (width <= 0) {
+    return InvalidArgument("Width must be positive, got {}", width);
+  }
+  switch (type.type_id()) {
+    case TypeId::kInt: {
+      const auto* values = Values<int32_t>(array);
+      return MapFixedWidth<int32_t>(array, [&](int64_t i) {
+        return TruncateUtils::TruncateInteger(values[i], width);
+      });
+    }
+    case TypeId::kLong: {
+      const auto* values = Values<int64_t>(array);
+      return MapFixedWidth<int64_t>(array, [&](int64_t i) {
+        return TruncateUtils::TruncateInteger(values[i], width);
+      });
+    }
+    case TypeId::kDecimal: {
+      const auto* values = Values<uint8_t>(array);
+      return MapFixedWidth<int128_t>(array, [&](int64_t i) {
+        return TruncateUtils::TruncateInteger(DecimalAt(values, i), width);
+      });
+    }
+    case TypeId::kString:
+      return MapBinaryPrefix(array, [width](std::string_view value) {
+        return TruncateUtils::UTF8PrefixLength(value, width);
+      });
+    case TypeId::kBinary:
+      // In contrast to strings, binary values do not have an assumed encoding and are
+      // truncated to `width` bytes.
+      return MapBinaryPrefix(array, [width](std::string_view value) {
+        return std::min(value.size(), static_cast<size_t>(width));
+      });
+    default:
+      return NotSupported("{} is not a valid input type for truncate transform",
+                          type.ToString());
+  }
+}
+
+/// \brief A civil year and month.
+struct YearMonth {
+  int32_t year;
+  int32_t month;  // 1 to 12
+};
+
+/// \brief Returns the civil year and month of a number of days since the epoch.
+///
+/// This is the days-to-civil algorithm of Howard Hinnant, with the days shifted by a
+/// whole number of 400-year eras so that every division is an unsigned division by a
+/// constant. There are no branches, so that the loops over arrays vectorize. Days must
+/// be in the range of int32_t, which includes the days of all int64_t microseconds.
+constexpr YearMonth CivilFromDays(int64_t days_since_epoch) {
+  // 2^31 days is less than 14700 eras of 146097 days.
+  constexpr uint64_t kEraShift = 14700;
+  // Days are counted from 0000-03-01, so that leap days are at the end of a year.
+  const uint64_t day = static_cast<uint64_t>(days_since_epoch + 719468 +
+                                             static_cast<int64_t>(kEraShift * 146097));
+  const uint64_t era = day / 146097;
+  const uint64_t day_of_era = day - era * 146097;
+  const uint64_t year_of_era =
+      (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+  const uint64_t day_of_year =
+      day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+  // Months are counted from March.
+  const uint64_t month = (5 * day_of_year + 2) / 153;
+  const uint64_t is_jan_or_feb = month >= 10;
+  return {.year = static_cast<int32_t>(static_cast<int64_t>(year_of_era + era * 400 +
+                                                            is_jan_or_feb) -
+                                       static_cast<int64_t>(kEraShift * 400)),
+          .month = static_cast<int32_t>(month + 3 - 12 * is_jan_or_feb)};
+}
+
+static_assert(CivilFromDays(0).year == 1970 && CivilFromDays(0).month == 1);
+static_assert(CivilFromDays(-1).year == 1969 && CivilFromDays(-1).month == 12);
+static_assert(CivilFromDays(11016).year == 2000 && CivilFromDays(11016).month == 2);
+static_assert(CivilFromDays(-719468).year == 0 && CivilFromDays(-719468).month == 3);
+
+int32_t Year(int64_t days_since_epoch) { return CivilFromDays(days_since_epoch).year; }
+
+int32_t MonthsSinceEpoch(int64_t days_since_epoch) {
+  const YearMonth civil = CivilFromDays(days_since_epoch);
+  return (civil.year - 1970) * 12 + civil.month - 1;
+}
+
+/// \brief Floor division of timestamps in microseconds.
+int64_t FloorDiv(int64_t micros, int64_t divisor) {
+  return micros / divisor - (micros % divisor < 0 ? 1 : 0);
+}
+
+Result<ArrowArray> TemporalArray(TransformType transform_type, const Type& type,
+                                 const ArrowArray& array) {
+  const bool is_date = type.type_id() == TypeId::kDate;
+  if (!is_date && type.type_id() != TypeId::kTimestamp &&
+      type.type_id() != TypeId::kTimestampTz) {
+    return NotSupported("{} is not a valid input type for {} transform", type.ToString(),
+                        TransformTypeToString(transform_type));
+  }
+  if (is_date && transform_type == TransformType::kHour) {
+    return NotSupported("{} is not a valid input type for hour transform",
+                        type.ToString());
+  }
+
+  if (is_date) {
+    const auto* values = Values<int32_t>(array);
+    switch (transform_type) {
+      case TransformType::kYear:
+        // Years are calendar years, as TemporalUtils::ExtractYear.
+        return MapFixedWidth<int32_t>(
+            array, [&](int64_t i) { return Year(values[i]); });
+      case TransformType::kMonth:
+        return MapFixedWidth<int32_t>(
+            array, [&](int64_t i) { return MonthsSinceEpoch(values[i]); });
+      case TransformType::kDay:
+        return MapFixedWidth<int32_t>(array, [&](int64_t i) { return values[i]; });
+      default:
+        break;
+    }
+  } else {
+    const auto* values = Values<int64_t>(array);
+    auto to_days = [values](int64_t i) {
+      return FloorDiv(values[i], kMicrosPerDay);
+    };
+    switch (transform_type) {
+      case TransformType::kYear:
+        return MapFixedWidth<int32_t>(array, [&](int64_t i) { return Year(to_days(i)); });
+      case TransformType::kMonth:
+        return MapFixedWidth<int32_t>(
+            array, [&](int64_t i) { return MonthsSinceEpoch(to_days(i)); });
+      case TransformType::kDay:
+        return MapFixedWidth<int32_t>(array, [&](int64_t i) {
+          return static_cast<int32_t>(to_days(i));
+        });
+      case TransformType::kHour:
+        return MapFixedWidth<int32_t>(array, [&](int64_t i) {
+          return static_cast<int32_t>(FloorDiv(values[i], kMicrosPerHour));
+        });
+      default:
+        break;
+    }
+  }
+  return NotSupported("{} is not a temporal transform",
+                      TransformTypeToString(transform_type));
+}
+
+}  // namespace
+
+Result<ArrowArray> TransformArrowArray(TransformType transform_type,
+                                       const Type& source_type, const ArrowArray& array,
+                                       int32_t param) {
+  ICEBERG_RETURN_UNEXPECTED(CheckLayout(source_type, array));
+  int32_t byte_width = 0;
+  if (!IsBinaryLike(source_type) && source_type.type_id() != TypeId::kBoolean) {
+    ICEBERG_ASSIGN_OR_RAISE(byte_width, FixedByteWidth(source_type));
+  }
+
+  switch (transform_type) {
+    case TransformType::kIdentity:
+      return CopyArray(source_type, array, byte_width);
+    case TransformType::kVoid:
+      return NullArray(source_type, array.length, byte_width);
+    case TransformType::kBucket:
+      return BucketArray(source_type, array, param);
+    case TransformType::kTruncate:
+      return TruncateArray(source_type, array, param);
+    case TransformType::kYear:
+    case TransformType::kMonth:
+    case TransformType::kDay:
+    case TransformType::kHour:
+      return TemporalArray(transform_type, source_type, array);
+    default:
+      return NotSupported("Cannot apply {} transform to Arrow arrays",
+                          TransformTypeToString(transform_type));
+  }
+}
+
+}  // namespace iceberg
@@ -0,0 +1,53 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/util/arrow_transform_internal.h
+/// Batch kernels of the partition transforms over Arrow arrays.
+
+#include <cstdint>
+
+#include "iceberg/arrow_c_data.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/transform.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief Applies a transform to every value of an Arrow array.
+///
+/// The array must have the Arrow layout of `source_type`: 32-bit offsets for strings
+/// and binaries, 128-bit decimals and fixed-size binaries for uuids and fixed values.
+/// Nulls are transformed to nulls. Bucket and temporal transforms produce int32
+/// arrays, the other transforms produce arrays with the layout of the source type.
+///
+/// \param transform_type The transform to apply; bucket and truncate transforms use
+/// `param` as their number of buckets and width
+/// \param source_type The Iceberg type of the values of the array
+/// \param array The array to transform
+/// \param param The parameter of the transform, ignored by the other transforms
+/// \return A new array that owns its buffers and must be released by the caller
+ICEBERG_EXPORT Result<ArrowArray> TransformArrowArray(TransformType transform_type,
+                                                      const Type& source_type,
+                                                      const ArrowArray& array,
+                                                      int32_t param = 0);
+
+}  // namespace iceberg
@@ -0,0 +1,120 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/util/batch_sizer_internal.h"
+
+#include <algorithm>
+
+#include "iceberg/schema.h"
+#include "iceberg/type.h"
+#include "iceberg/util/checked_cast.h"
+
+namespace iceberg {
+
+namespace {
+
+// The assumed number of bytes of a string or binary value, and of elements of a list
+// or entries of a map.
+constexpr double kVariableLength = 16;
+constexpr double kCollectionLength = 4;
+// The size of an offset of variable-length values and collections.
+constexpr double kOffsetWidth = 4;
+
+double EstimateWidth(const Type& type) {
+  switch (type.type_id()) {
+    case TypeId::kStruct:
+    case TypeId::kList:
+    case TypeId::kMap: {
+      double width = 0;
+      for (const auto& field : internal::checked_cast<const NestedType&>(type).fields()) {
+        width += EstimateWidth(*field.type());
+      }
+      return type.type_id() == TypeId::kStruct
+                 ? width
+                 : kOffsetWidth + kCollectionLength * width;
+    }
+    case TypeId::kBoolean:
+      return 1.0 / 8;
+    case TypeId::kInt:
+    case TypeId::kFloat:
+    case TypeId::kDate:
+      return 4;
+    case TypeId::kLong:
+    case TypeId::kDouble:
+    case TypeId::kTime:
+    case TypeId::kTimestamp:
+    case TypeId::kTimestampTz:
+      return 8;
+    case TypeId::kDecimal:
+    case TypeId::kUuid:
+      return 16;
+    case TypeId::kFixed:
+      return internal::checked_cast<const FixedType&>(type).length();
+    case TypeId::kString:
+    case TypeId::kBinary:
+      return kOffsetWidth + kVariableLength;
+    case TypeId::kVariant:
+      // The metadata and the value of each variant.
+      return 2 * (kOffsetWidth + kVariableLength);
+  }
+  return kOffsetWidth + kVariableLength;
+}
+
+}  // namespace
+
+BatchSizer::BatchSizer(int64_t target_bytes, double row_width)
+    : target_bytes_(target_bytes), row_width_(row_width) {
+  Update();
+}
+
+Result<BatchSizer> BatchSizer::Make(int64_t target_bytes, double row_width) {
+  if (target_bytes <= 0) {
+    return InvalidArgument("Target batch bytes must be positive, got {}", target_bytes);
+  }
+  return BatchSizer(target_bytes, row_width);
+}
+
+double BatchSizer::EstimateRowWidth(const Schema& schema) {
+  return EstimateWidth(schema);
+}
+
+void BatchSizer::Observe(int64_t num_rows, int64_t num_bytes) {
+  if (num_rows <= 0) {
+    return;
+  }
+  const double row_width = static_cast<double>(num_bytes) / num_rows;
+  // The estimate is replaced by the first observed width, and later widths are
+  // averaged so that a single unusual batch does not swing the size.
+  row_width_ = observed_ ? (row_width_ + row_width) / 2 : row_width;
+  observed_ = true;
+  Update();
+}
+
+void BatchSizer::Update() {
+  if (row_width_ <= 0) {
+    batch_size_ = kMaxBatchSize;
+    return;
+  }
+  const double rows = static_cast<double>(target_bytes_) / row_width_;
+  batch_size_ = rows >= static_cast<double>(kMaxBatchSize)
+                    ? kMaxBatchSize
+                    : std::max<int64_t>(1, static_cast<int64_t>(rows));
+}
+
+}  // namespace iceberg
@@ -0,0 +1,72 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/util/batch_sizer_internal.h
+/// Size the batches of readers by bytes instead of rows.
+
+#include <cstdint>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief Chooses the number of rows of the batches of a reader so that they hold
+/// about a target number of bytes.
+///
+/// The row width is first estimated from the schema, or from the file metadata when
+/// the format records it, and then from the sizes of the batches that are read. A
+/// sizer is not thread-safe.
+class ICEBERG_EXPORT BatchSizer {
+ public:
+  /// \brief The maximum number of rows of a batch, which bounds the batches of rows
+  /// that are estimated to take no space, such as rows of null values.
+  static constexpr int64_t kMaxBatchSize = int64_t{1} << 20;
+
+  /// \brief Creates a sizer for a target number of bytes per batch.
+  ///
+  /// \param target_bytes The target number of bytes of a batch, which must be positive
+  /// \param row_width The estimated number of bytes of a row
+  static Result<BatchSizer> Make(int64_t target_bytes, double row_width);
+
+  /// \brief Returns the estimated number of bytes of a row of a schema in Arrow
+  /// format, assuming a fixed length of variable-length values and collections.
+  static double EstimateRowWidth(const Schema& schema);
+
+  /// \brief The number of rows of the next batch.
+  int64_t batch_size() const { return batch_size_; }
+
+  /// \brief Adapts the number of rows to the size of a batch that was read.
+  void Observe(int64_t num_rows, int64_t num_bytes);
+
+ private:
+  BatchSizer(int64_t target_bytes, double row_width);
+
+  void Update();
+
+  int64_t target_bytes_;
+  double row_width_;
+  bool observed_ = false;
+  int64_t batch_size_ = 1;
+};
+
+}  // namespace iceberg
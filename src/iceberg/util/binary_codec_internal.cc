@@ -0,0 +1,103 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/util/binary_codec_internal.h"
+
+#include <utility>
+
+#include "iceberg/type.h"
+#include "iceberg/util/checked_cast.h"
+
+namespace iceberg {
+
+void WriteBinaryType(BinaryWriter& writer, const PrimitiveType& type) {
+  writer.Byte(static_cast<uint8_t>(type.type_id()));
+  if (type.type_id() == TypeId::kDecimal) {
+    const auto& decimal_type = internal::checked_cast<const DecimalType&>(type);
+    writer.Long(decimal_type.precision());
+    writer.Long(decimal_type.scale());
+  } else if (type.type_id() == TypeId::kFixed) {
+    writer.Long(internal::checked_cast<const FixedType&>(type).length());
+  }
+}
+
+Result<std::shared_ptr<PrimitiveType>> ReadBinaryType(BinaryReader& reader) {
+  ICEBERG_ASSIGN_OR_RAISE(auto type_id, reader.Byte());
+  switch (static_cast<TypeId>(type_id)) {
+    case TypeId::kBoolean:
+      return boolean();
+    case TypeId::kInt:
+      return int32();
+    case TypeId::kLong:
+      return int64();
+    case TypeId::kFloat:
+      return float32();
+    case TypeId::kDouble:
+      return float64();
+    case TypeId::kDecimal: {
+      ICEBERG_ASSIGN_OR_RAISE(auto precision, reader.Int());
+      ICEBERG_ASSIGN_OR_RAISE(auto scale, reader.Int());
+      return decimal(precision, scale);
+    }
+    case TypeId::kDate:
+      return date();
+    case TypeId::kTime:
+      return time();
+    case TypeId::kTimestamp:
+      return timestamp();
+    case TypeId::kTimestampTz:
+      return timestamp_tz();
+    case TypeId::kString:
+      return string();
+    case TypeId::kUuid:
+      return uuid();
+    case TypeId::kFixed: {
+      ICEBERG_ASSIGN_OR_RAISE(auto length, reader.Int());
+      return fixed(length);
+    }
+    case TypeId::kBinary:
+      return binary();
+    default:
+      return Invalid("Invalid literal type {} in serialized data", type_id);
+  }
+}
+
+Status WriteBinaryLiteral(BinaryWriter& writer, const Literal& literal) {
+  WriteBinaryType(writer, *literal.type());
+  if (literal.IsNull()) {
+    writer.Byte(0);
+    return {};
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto bytes, literal.Serialize());
+  writer.Byte(1);
+  writer.Bytes(bytes);
+  return {};
+}
+
+Result<Literal> ReadBinaryLiteral(BinaryReader& reader) {
+  ICEBERG_ASSIGN_OR_RAISE(auto type, ReadBinaryType(reader));
+  ICEBERG_ASSIGN_OR_RAISE(auto has_value, reader.Byte());
+  if (has_value == 0) {
+    return Literal::Null(std::move(type));
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto bytes, reader.Bytes());
+  return Literal::Deserialize(bytes, std::move(type));
+}
+
+}  // namespace iceberg
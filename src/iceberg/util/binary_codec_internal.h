@@ -0,0 +1,179 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/util/binary_codec_internal.h
+/// Encoding of the values of the compact binary forms written by the library.
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "iceberg/expression/literal.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+/// \brief Appends values to a binary buffer.
+class BinaryWriter {
+ public:
+  void Byte(uint8_t value) { out_.push_back(value); }
+
+  /// \brief Writes an unsigned integer in groups of 7 bits, the lowest first.
+  void Varint(uint64_t value) {
+    while (value >= 0x80) {
+      out_.push_back(static_cast<uint8_t>(value) | 0x80);
+      value >>= 7;
+    }
+    out_.push_back(static_cast<uint8_t>(value));
+  }
+
+  /// \brief Writes a signed integer zigzag encoded, so that small negative values take
+  /// few bytes too.
+  void Long(int64_t value) {
+    Varint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+  }
+
+  void OptionalLong(const std::optional<int64_t>& value) {
+    Byte(value.has_value());
+    if (value.has_value()) {
+      Long(*value);
+    }
+  }
+
+  void Bytes(std::span<const uint8_t> bytes) {
+    Varint(bytes.size());
+    out_.insert(out_.end(), bytes.begin(), bytes.end());
+  }
+
+  void String(std::string_view str) {
+    Bytes({reinterpret_cast<const uint8_t*>(str.data()), str.size()});
+  }
+
+  void Append(const BinaryWriter& other) {
+    out_.insert(out_.end(), other.out_.begin(), other.out_.end());
+  }
+
+  const std::vector<uint8_t>& bytes() const { return out_; }
+
+  std::vector<uint8_t> Finish() && { return std::move(out_); }
+
+ private:
+  std::vector<uint8_t> out_;
+};
+
+/// \brief Reads the values written by a BinaryWriter.
+class BinaryReader {
+ public:
+  explicit BinaryReader(std::span<const uint8_t> data) : data_(data) {}
+
+  Result<uint8_t> Byte() {
+    if (pos_ >= data_.size()) {
+      return Invalid("Serialized data is truncated");
+    }
+    return data_[pos_++];
+  }
+
+  Result<uint64_t> Varint() {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      ICEBERG_ASSIGN_OR_RAISE(auto byte, Byte());
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+    return Invalid("Invalid integer in serialized data");
+  }
+
+  Result<int64_t> Long() {
+    ICEBERG_ASSIGN_OR_RAISE(auto value, Varint());
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+  }
+
+  Result<int32_t> Int() {
+    ICEBERG_ASSIGN_OR_RAISE(auto value, Long());
+    if (value < std::numeric_limits<int32_t>::min() ||
+        value > std::numeric_limits<int32_t>::max()) {
+      return Invalid("Integer {} out of range in serialized data", value);
+    }
+    return static_cast<int32_t>(value);
+  }
+
+  Result<std::optional<int64_t>> OptionalLong() {
+    ICEBERG_ASSIGN_OR_RAISE(auto has_value, Byte());
+    if (has_value == 0) {
+      return std::nullopt;
+    }
+    return Long();
+  }
+
+  /// \brief Reads the number of values that follow, each taking at least a byte, so
+  /// that a corrupted count fails before anything is allocated for it.
+  Result<size_t> Count() {
+    ICEBERG_ASSIGN_OR_RAISE(auto count, Varint());
+    if (count > data_.size() - pos_) {
+      return Invalid("Serialized data is truncated");
+    }
+    return static_cast<size_t>(count);
+  }
+
+  Result<std::span<const uint8_t>> Bytes() {
+    ICEBERG_ASSIGN_OR_RAISE(auto size, Count());
+    auto bytes = data_.subspan(pos_, size);
+    pos_ += size;
+    return bytes;
+  }
+
+  Result<std::string> String() {
+    ICEBERG_ASSIGN_OR_RAISE(auto bytes, Bytes());
+    return std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+  }
+
+  bool AtEnd() const { return pos_ == data_.size(); }
+
+ private:
+  std::span<const uint8_t> data_;
+  size_t pos_ = 0;
+};
+
+/// \brief Writes a primitive type: its type ID followed by its parameters.
+ICEBERG_EXPORT void WriteBinaryType(BinaryWriter& writer, const PrimitiveType& type);
+
+/// \brief Reads a primitive type written by WriteBinaryType.
+ICEBERG_EXPORT Result<std::shared_ptr<PrimitiveType>> ReadBinaryType(
+    BinaryReader& reader);
+
+/// \brief Writes a literal with its type, so that it can be restored on its own. The
+/// value is written in the single-value binary serialization of the Iceberg spec.
+ICEBERG_EXPORT Status WriteBinaryLiteral(BinaryWriter& writer, const Literal& literal);
+
+/// \brief Reads a literal written by WriteBinaryLiteral.
+ICEBERG_EXPORT Result<Literal> ReadBinaryLiteral(BinaryReader& reader);
+
+}  // namespace iceberg
@@ -19,10 +19,13 @@
 
 #include "iceberg/util/bucket_util.h"
 
+#include <limits>
 #include <utility>
 
 #include "iceberg/expression/literal.h"
 #include "iceberg/util/endian.h"
+#include "iceberg/util/int128.h"
+#include "iceberg/util/macros.h"
 #include "iceberg/util/murmurhash3_internal.h"
 
 namespace iceberg {
@@ -94,8 +97,75 @@ int32_t HashLiteral<TypeId::kFixed>(const Literal& literal) {
   return BucketUtils::HashBytes(fixed);
 }
 
+/// \brief Reduces hash values to bucket indices in place.
+///
+/// A power-of-two number of buckets is a mask. Other numbers use a precomputed
+/// reciprocal instead of a division per value (Lemire et al., "Faster Remainder by
+/// Direct Computation").
+void ReduceToBuckets(std::span<int32_t> hashes, int32_t num_buckets) {
+  const auto divisor = static_cast<uint32_t>(num_buckets);
+  if ((divisor & (divisor - 1)) == 0) {
+    const int32_t mask = num_buckets - 1;
+    for (auto& hash : hashes) {
+      hash &= mask;
+    }
+    return;
+  }
+  const uint64_t reciprocal = std::numeric_limits<uint64_t>::max() / divisor + 1;
+  for (auto& hash : hashes) {
+    const uint64_t fraction =
+        reciprocal * static_cast<uint32_t>(hash & std::numeric_limits<int32_t>::max());
+    hash = static_cast<int32_t>((static_cast<uint128_t>(fraction) * divisor) >> 64);
+  }
+}
+
+Status CheckBucketIndices(size_t num_values, int32_t num_buckets, size_t num_out) {
+  if (num_buckets <= 0) [[unlikely]] {
+    return InvalidArgument("Number of buckets must be positive, got {}", num_buckets);
+  }
+  if (num_values != num_out) [[unlikely]] {
+    return InvalidArgument("Expected {} bucket indices, got an output of {}",
+                           num_values, num_out);
+  }
+  return {};
+}
+
+template <typename T>
+Status BucketLongs(std::span<const T> values, int32_t num_buckets,
+                   std::span<int32_t> out) {
+  ICEBERG_RETURN_UNEXPECTED(CheckBucketIndices(values.size(), num_buckets, out.size()));
+  MurmurHash3_x86_32_Longs(values.data(), static_cast<int64_t>(values.size()), 0,
+                           reinterpret_cast<uint32_t*>(out.data()));
+  ReduceToBuckets(out, num_buckets);
+  return {};
+}
+
 }  // namespace
 
+Status BucketUtils::BucketIndices(std::span<const int32_t> values, int32_t num_buckets,
+                                  std::span<int32_t> out) {
+  return BucketLongs(values, num_buckets, out);
+}
+
+Status BucketUtils::BucketIndices(std::span<const int64_t> values, int32_t num_buckets,
+                                  std::span<int32_t> out) {
+  return BucketLongs(values, num_buckets, out);
+}
+
+Status BucketUtils::BucketIndices(std::span<const int32_t> offsets, const uint8_t* data,
+                                  int32_t num_buckets, std::span<int32_t> out) {
+  if (offsets.empty()) [[unlikely]] {
+    return InvalidArgument("Offsets must have one more element than the values");
+  }
+  ICEBERG_RETURN_UNEXPECTED(
+      CheckBucketIndices(offsets.size() - 1, num_buckets, out.size()));
+  for (size_t i = 0; i < out.size(); ++i) {
+    MurmurHash3_x86_32(data + offsets[i], offsets[i + 1] - offsets[i], 0, &out[i]);
+  }
+  ReduceToBuckets(out, num_buckets);
+  return {};
+}
+
 int32_t BucketUtils::HashBytes(std::span<const uint8_t> bytes) {
   int32_t hash_value = 0;
   MurmurHash3_x86_32(bytes.data(), bytes.size(), 0, &hash_value);
@@ -55,6 +55,29 @@ class ICEBERG_EXPORT BucketUtils {
   /// \param num_buckets The number of buckets to hash into.
   /// \return (murmur3_x86_32_hash(literal) & Integer.MAX_VALUE) % num_buckets
   static Result<int32_t> BucketIndex(const Literal& literal, int32_t num_buckets);
+
+  /// \brief Compute the bucket indices of a batch of integers, hashed as longs.
+  ///
+  /// Dates are bucketed as ints and times and timestamps as longs.
+  /// \param values The input values to hash.
+  /// \param num_buckets The number of buckets to hash into.
+  /// \param out The bucket indices, with the size of `values`.
+  static Status BucketIndices(std::span<const int32_t> values, int32_t num_buckets,
+                              std::span<int32_t> out);
+
+  /// \copydoc BucketIndices(std::span<const int32_t>, int32_t, std::span<int32_t>)
+  static Status BucketIndices(std::span<const int64_t> values, int32_t num_buckets,
+                              std::span<int32_t> out);
+
+  /// \brief Compute the bucket indices of a batch of strings or binaries.
+  ///
+  /// \param offsets The offsets of the values in `data`, one more than the number of
+  /// values, as in Arrow string and binary arrays.
+  /// \param data The bytes of the values.
+  /// \param num_buckets The number of buckets to hash into.
+  /// \param out The bucket indices, with one less element than `offsets`.
+  static Status BucketIndices(std::span<const int32_t> offsets, const uint8_t* data,
+                              int32_t num_buckets, std::span<int32_t> out);
 };
 
 }  // namespace iceberg
@@ -18,10 +18,14 @@
  */
 #pragma once
 
+#include <any>
+#include <cstddef>
 #include <format>
 #include <functional>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "iceberg/exception.h"
 
@@ -61,6 +65,11 @@ U DefaultFromString(const std::string& val) {
 }
 }  // namespace internal
 
+/// \brief Base class of the configurations made of typed entries stored as strings.
+///
+/// The values of the entries declared by a configuration are parsed once, when the
+/// configuration is created or modified, so that Get() does not look up and parse the
+/// strings. Values that fail to parse are parsed again, and fail, when they are read.
 template <class ConcreteConfig>
 class ConfigBase {
  public:
@@ -70,13 +79,22 @@ class ConfigBase {
     Entry(std::string key, const T& val,
           std::function<std::string(const T&)> to_str = internal::DefaultToString<T>,
           std::function<T(const std::string&)> from_str = internal::DefaultFromString<T>)
-        : key_{std::move(key)}, default_{val}, to_str_{to_str}, from_str_{from_str} {}
+        : key_{std::move(key)},
+          default_{val},
+          to_str_{to_str},
+          from_str_{from_str},
+          index_{Register([key = key_, val, from_str](const Configs& configs) {
+            auto iter = configs.find(key);
+            return std::any(iter != configs.cend() ? from_str(iter->second) : val);
+          })} {}
 
    private:
     const std::string key_;
     const T default_;
     const std::function<std::string(const T&)> to_str_;
     const std::function<T(const std::string&)> from_str_;
+    /// \brief The index of the parsed value of the entry in a configuration.
+    const size_t index_;
 
     friend ConfigBase;
     friend ConcreteConfig;
@@ -87,25 +105,35 @@ class ConfigBase {
     const T& value() const { return default_; }
   };
 
+  ConfigBase() { Parse(); }
+
   template <typename T>
   ConfigBase& Set(const Entry<T>& entry, const T& val) {
     configs_.emplace(entry.key_, entry.to_str_(val));
+    Parse(entry.index_);
     return *this;
   }
 
   template <typename T>
   ConfigBase& Unset(const Entry<T>& entry) {
     configs_.erase(entry.key_);
+    Parse(entry.index_);
     return *this;
   }
 
   ConfigBase& Reset() {
     configs_.clear();
+    Parse();
     return *this;
   }
 
   template <typename T>
   T Get(const Entry<T>& entry) const {
+    if (entry.index_ < parsed_.size()) {
+      if (const auto* parsed = std::any_cast<T>(&parsed_[entry.index_])) {
+        return *parsed;
+      }
+    }
     auto iter = configs_.find(entry.key_);
     return iter != configs_.cend() ? entry.from_str_(iter->second) : entry.default_;
   }
@@ -113,7 +141,62 @@ class ConfigBase {
   const std::unordered_map<std::string, std::string>& configs() const { return configs_; }
 
  protected:
-  std::unordered_map<std::string, std::string> configs_;
+  using Configs = std::unordered_map<std::string, std::string>;
+
+  /// \brief Parses the values of all entries, after the configs are replaced.
+  void Parse() {
+    auto& registry = GetRegistry();
+    std::lock_guard lock(registry.mutex);
+    parsed_.resize(registry.parsers.size());
+    for (size_t index = 0; index < parsed_.size(); ++index) {
+      parsed_[index] = ParseValue(registry.parsers[index]);
+    }
+  }
+
+  Configs configs_;
+
+ private:
+  using Parser = std::function<std::any(const Configs&)>;
+
+  struct Registry {
+    std::mutex mutex;
+    std::vector<Parser> parsers;
+  };
+
+  static Registry& GetRegistry() {
+    static Registry registry;
+    return registry;
+  }
+
+  /// \brief Registers the parser of the value of an entry, returns its index.
+  static size_t Register(Parser parser) {
+    auto& registry = GetRegistry();
+    std::lock_guard lock(registry.mutex);
+    registry.parsers.push_back(std::move(parser));
+    return registry.parsers.size() - 1;
+  }
+
+  /// \brief Parses the value of an entry, or returns no value if it is invalid.
+  std::any ParseValue(const Parser& parser) const {
+    try {
+      return parser(configs_);
+    } catch (...) {
+      return {};
+    }
+  }
+
+  void Parse(size_t index) {
+    if (index >= parsed_.size()) {
+      // The entry was declared after the configuration was created.
+      return;
+    }
+    auto& registry = GetRegistry();
+    std::lock_guard lock(registry.mutex);
+    parsed_[index] = ParseValue(registry.parsers[index]);
+  }
+
+  /// \brief The parsed values of the entries by index, empty for invalid values.
+  std::vector<std::any> parsed_;
 };
 
 }  // namespace iceberg
@@ -0,0 +1,103 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/util/conversion_cache_internal.h
+/// A cache of schema conversions shared by the readers and writers of files.
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include "iceberg/result.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+/// \brief A thread-safe LRU cache of the results of schema conversions.
+///
+/// Readers and writers convert the same schemas for every file they open, e.g. the
+/// projection of a scan to an Arrow schema, or onto the schema of files written by the
+/// same writer. The results are cached by a key that identifies the input of the
+/// conversion, usually fingerprints of the schemas such as Schema::ToString(). Values
+/// are copied out of the cache, so they should be cheap to copy or immutable and
+/// shared. Failed conversions are not cached.
+template <typename Value>
+class ConversionCache {
+ public:
+  static constexpr size_t kDefaultCapacity = 256;
+
+  explicit ConversionCache(size_t capacity = kDefaultCapacity)
+      : capacity_(capacity > 0 ? capacity : 1) {}
+
+  ConversionCache(const ConversionCache&) = delete;
+  ConversionCache& operator=(const ConversionCache&) = delete;
+
+  /// \brief Returns the cached value of `key`, or the value returned by `convert` that
+  /// is cached on success.
+  ///
+  /// The conversion runs without holding the lock, so concurrent misses of a key may
+  /// each convert it.
+  template <typename Convert>
+  Result<Value> GetOrConvert(std::string key, Convert&& convert) {
+    {
+      std::lock_guard lock(mutex_);
+      if (auto it = index_.find(key); it != index_.cend()) {
+        items_.splice(items_.begin(), items_, it->second);
+        return it->second->value;
+      }
+    }
+    ICEBERG_ASSIGN_OR_RAISE(Value value, std::forward<Convert>(convert)());
+    std::lock_guard lock(mutex_);
+    if (!index_.contains(key)) {
+      items_.push_front(Item{.key = std::move(key), .value = value});
+      index_.emplace(items_.front().key, items_.begin());
+      if (items_.size() > capacity_) {
+        index_.erase(items_.back().key);
+        items_.pop_back();
+      }
+    }
+    return value;
+  }
+
+  /// \brief The number of cached values.
+  size_t size() const {
+    std::lock_guard lock(mutex_);
+    return items_.size();
+  }
+
+ private:
+  struct Item {
+    std::string key;
+    Value value;
+  };
+
+  const size_t capacity_;
+  mutable std::mutex mutex_;
+  // Cached items, from the most to the least recently used.
+  std::list<Item> items_;
+  std::unordered_map<std::string_view, typename std::list<Item>::iterator> index_;
+};
+
+}  // namespace iceberg
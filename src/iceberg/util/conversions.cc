@@ -19,9 +19,14 @@
 
 #include "iceberg/util/conversions.h"
 
+#include <cmath>
+#include <compare>
 #include <cstring>
 #include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
 
 #include "iceberg/util/decimal.h"
 #include "iceberg/util/endian.h"
@@ -222,4 +227,74 @@ Result<Literal> Conversions::FromBytes(std::shared_ptr<PrimitiveType> type,
   return Literal(std::move(value), std::move(type));
 }
 
+Result<Scalar> Conversions::ScalarFromBytes(const PrimitiveType& type,
+                                            std::span<const uint8_t> data) {
+  const std::string_view view(reinterpret_cast<const char*>(data.data()), data.size());
+  switch (type.type_id()) {
+    case TypeId::kString:
+    case TypeId::kBinary:
+      return Scalar{view};
+    case TypeId::kFixed: {
+      const auto& fixed_type = static_cast<const FixedType&>(type);
+      if (data.size() != fixed_type.length()) {
+        return InvalidArgument("Invalid data size for Fixed literal, got size: {}",
+                               data.size());
+      }
+      return Scalar{view};
+    }
+    case TypeId::kUuid:
+      if (data.size() != 16) {
+        return InvalidArgument("Invalid data size for UUID literal, got size: {}",
+                               data.size());
+      }
+      return Scalar{view};
+    default:
+      break;
+  }
+
+  // The remaining values are stored inline.
+  ICEBERG_ASSIGN_OR_RAISE(auto value, FromBytes(type, data));
+  return std::visit(
+      [&type](auto&& v) -> Result<Scalar> {
+        using T = std::decay_t<decltype(v)>;
+        if constexpr (std::is_arithmetic_v<T> || std::is_same_v<T, Decimal>) {
+          return Scalar{v};
+        } else {
+          return NotSupported("Deserialization for type {} is not supported",
+                              type.ToString());
+        }
+      },
+      value);
+}
+
+Result<std::partial_ordering> Conversions::CompareBytes(const PrimitiveType& type,
+                                                       std::span<const uint8_t> lhs,
+                                                       std::span<const uint8_t> rhs) {
+  ICEBERG_ASSIGN_OR_RAISE(auto lhs_scalar, ScalarFromBytes(type, lhs));
+  ICEBERG_ASSIGN_OR_RAISE(auto rhs_scalar, ScalarFromBytes(type, rhs));
+  if (type.type_id() == TypeId::kUuid) {
+    // UUIDs are only compared for equality, like UUID literals.
+    return lhs_scalar == rhs_scalar ? std::partial_ordering::equivalent
+                                    : std::partial_ordering::unordered;
+  }
+  return std::visit(
+      [&rhs_scalar](const auto& lhs_value) -> std::partial_ordering {
+        using T = std::decay_t<decltype(lhs_value)>;
+        const auto& rhs_value = std::get<T>(rhs_scalar);
+        if constexpr (std::is_floating_point_v<T>) {
+          // NaNs of the same sign are equivalent, like NaN literals.
+          if (std::isnan(lhs_value) && std::isnan(rhs_value)) {
+            return std::signbit(lhs_value) <=> std::signbit(rhs_value);
+          }
+          return std::strong_order(lhs_value, rhs_value);
+        } else if constexpr (std::is_arithmetic_v<T> || std::is_same_v<T, Decimal> ||
+                             std::is_same_v<T, std::string_view>) {
+          return lhs_value <=> rhs_value;
+        } else {
+          return std::partial_ordering::unordered;
+        }
+      },
+      lhs_scalar);
+}
+
 }  // namespace iceberg
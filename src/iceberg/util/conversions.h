@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <compare>
 #include <span>
 #include <vector>
 
@@ -60,6 +61,30 @@ class ICEBERG_EXPORT Conversions {
   /// \return A Result containing the deserialized value.
   static Result<Literal> FromBytes(std::shared_ptr<PrimitiveType> type,
                                    std::span<const uint8_t> data);
+
+  /// \brief Deserializes a span of bytes into a scalar without copying it.
+  ///
+  /// String, binary, fixed and UUID values are views of `data`, which must outlive
+  /// the returned scalar. Use this to compare serialized values, such as column
+  /// bounds, with Literal::Compare without allocating.
+  /// \param type The target primitive type to interpret the bytes as.
+  /// \param data A std::span of bytes representing the serialized value.
+  /// \return A Result containing the deserialized scalar.
+  static Result<Scalar> ScalarFromBytes(const PrimitiveType& type,
+                                        std::span<const uint8_t> data);
+
+  /// \brief Compares two serialized values of a type without deserializing them.
+  ///
+  /// Strings, binary and fixed values compare as unsigned bytes, and numbers are read
+  /// in place, so no value is copied. The order is that of the corresponding literals.
+  /// \param type The primitive type of both values.
+  /// \param lhs The serialized left-hand value.
+  /// \param rhs The serialized right-hand value.
+  /// \return A Result containing the comparison result, unordered for UUIDs that
+  /// differ, or an error if a value is invalid for the type.
+  static Result<std::partial_ordering> CompareBytes(const PrimitiveType& type,
+                                                    std::span<const uint8_t> lhs,
+                                                    std::span<const uint8_t> rhs);
 };
 
 }  // namespace iceberg
@@ -296,6 +296,50 @@ bool RescaleWouldCauseDataLoss(const Decimal& value, int32_t delta_scale,
   return false;
 }
 
+uint64_t LoadBigEndian64(const uint8_t* bytes) {
+  uint64_t value;
+  std::memcpy(&value, bytes, sizeof(value));
+  if constexpr (std::endian::native == std::endian::little) {
+    value = std::byteswap(value);
+  }
+  return value;
+}
+
+void StoreBigEndian64(uint64_t value, uint8_t* bytes) {
+  if constexpr (std::endian::native == std::endian::little) {
+    value = std::byteswap(value);
+  }
+  std::memcpy(bytes, &value, sizeof(value));
+}
+
+Status CheckByteWidth(int32_t byte_width, size_t num_values, size_t num_bytes) {
+  if (byte_width < kMinDecimalBytes || byte_width > kMaxDecimalBytes) [[unlikely]] {
+    return InvalidArgument("Decimal byte width must be in the range [{}, {}], was {}",
+                           kMinDecimalBytes, kMaxDecimalBytes, byte_width);
+  }
+  if (num_values * byte_width != num_bytes) [[unlikely]] {
+    return InvalidArgument("Expected {} bytes for {} decimals of {} bytes, got {}",
+                           num_values * byte_width, num_values, byte_width, num_bytes);
+  }
+  return {};
+}
+
+Status CheckBatchSize(size_t num_values, size_t num_out) {
+  if (num_values != num_out) [[unlikely]] {
+    return InvalidArgument("Expected an output of {} values, got {}", num_values,
+                           num_out);
+  }
+  return {};
+}
+
+Status CheckDeltaScale(int32_t delta_scale) {
+  if (std::abs(delta_scale) > Decimal::kMaxScale) [[unlikely]] {
+    return InvalidArgument("Scales must differ by at most {}, got {}", Decimal::kMaxScale,
+                           delta_scale);
+  }
+  return {};
+}
+
 }  // namespace
 
 Decimal::Decimal(std::string_view str) {
@@ -620,6 +664,121 @@ std::partial_ordering Decimal::Compare(const Decimal& lhs, const Decimal& rhs,
   return adjusted_lhs <=> adjusted_rhs;
 }
 
+Status Decimal::FromBigEndian(std::span<const uint8_t> data, int32_t byte_width,
+                              std::span<int128_t> out) {
+  ICEBERG_RETURN_UNEXPECTED(CheckByteWidth(byte_width, out.size(), data.size()));
+
+  // Each value is loaded into the most significant bytes and shifted back
+  // arithmetically, which sign extends it without branching.
+  const auto shift = static_cast<uint32_t>((kMaxDecimalBytes - byte_width) * CHAR_BIT);
+  for (size_t i = 0; i < out.size(); ++i) {
+    std::array<uint8_t, kMaxDecimalBytes> bytes{};
+    std::memcpy(bytes.data(), data.data() + i * byte_width, byte_width);
+    const auto value = (static_cast<uint128_t>(LoadBigEndian64(bytes.data())) << 64) |
+                       LoadBigEndian64(bytes.data() + 8);
+    out[i] = static_cast<int128_t>(value) >> shift;
+  }
+  return {};
+}
+
+Status Decimal::ToBigEndian(std::span<const int128_t> values, int32_t byte_width,
+                            std::span<uint8_t> out) {
+  ICEBERG_RETURN_UNEXPECTED(CheckByteWidth(byte_width, values.size(), out.size()));
+
+  const auto shift = static_cast<uint32_t>((kMaxDecimalBytes - byte_width) * CHAR_BIT);
+  for (size_t i = 0; i < values.size(); ++i) {
+    const auto value = static_cast<uint128_t>(values[i]) << shift;
+    if ((static_cast<int128_t>(value) >> shift) != values[i]) [[unlikely]] {
+      return InvalidArgument("Decimal {} does not fit in {} bytes",
+                             Decimal(values[i]).ToIntegerString(), byte_width);
+    }
+    std::array<uint8_t, kMaxDecimalBytes> bytes;
+    StoreBigEndian64(static_cast<uint64_t>(value >> 64), bytes.data());
+    StoreBigEndian64(static_cast<uint64_t>(value), bytes.data() + 8);
+    std::memcpy(out.data() + i * byte_width, bytes.data(), byte_width);
+  }
+  return {};
+}
+
+Status Decimal::Rescale(std::span<const int128_t> values, int32_t orig_scale,
+                        int32_t new_scale, std::span<int128_t> out) {
+  ICEBERG_RETURN_UNEXPECTED(CheckBatchSize(values.size(), out.size()));
+  const int32_t delta_scale = new_scale - orig_scale;
+  ICEBERG_RETURN_UNEXPECTED(CheckDeltaScale(delta_scale));
+  if (delta_scale == 0) {
+    std::ranges::copy(values, out.begin());
+    return {};
+  }
+
+  const int128_t multiplier = kDecimal128PowersOfTen[std::abs(delta_scale)].value();
+  auto data_loss = [&](int128_t value) {
+    return Invalid("Rescale {} from {} to {} would cause data loss",
+                   Decimal(value).ToIntegerString(), orig_scale, new_scale);
+  };
+
+  if (delta_scale > 0) {
+    const int128_t max_safe_value = kMaxDecimalValue.value() / multiplier;
+    const int128_t min_safe_value = kMinDecimalValue.value() / multiplier;
+    for (size_t i = 0; i < values.size(); ++i) {
+      const int128_t value = values[i];
+      if (value > max_safe_value || value < min_safe_value) [[unlikely]] {
+        return data_loss(value);
+      }
+      out[i] = value * multiplier;
+    }
+  } else {
+    for (size_t i = 0; i < values.size(); ++i) {
+      const int128_t value = values[i];
+      const int128_t quotient = value / multiplier;
+      if (quotient * multiplier != value) [[unlikely]] {
+        return data_loss(value);
+      }
+      out[i] = quotient;
+    }
+  }
+  return {};
+}
+
+Status Decimal::Compare(std::span<const int128_t> values, int32_t scale,
+                        const Decimal& other, int32_t other_scale,
+                        std::span<int8_t> out) {
+  ICEBERG_RETURN_UNEXPECTED(CheckBatchSize(values.size(), out.size()));
+  const int32_t delta_scale = scale - other_scale;
+  ICEBERG_RETURN_UNEXPECTED(CheckDeltaScale(delta_scale));
+
+  // `other` is rescaled once to the scale of the values, so that each value is
+  // compared with a plain integer comparison.
+  int128_t target = other.value();
+  if (delta_scale > 0) {
+    Decimal rescaled;
+    if (RescaleWouldCauseDataLoss(other, delta_scale,
+                                  kDecimal128PowersOfTen[delta_scale], &rescaled)) {
+      // `other` is out of the range of the values.
+      std::ranges::fill(out, other.IsNegative() ? 1 : -1);
+      return {};
+    }
+    target = rescaled.value();
+  } else if (delta_scale < 0) {
+    const int128_t divisor = kDecimal128PowersOfTen[-delta_scale].value();
+    const int128_t quotient = target / divisor;
+    if (quotient * divisor != target) {
+      // `other` lies strictly between two values of this scale, so no value equals it
+      // and the values up to its floor are less.
+      const int128_t floor_value = target < 0 ? quotient - 1 : quotient;
+      for (size_t i = 0; i < values.size(); ++i) {
+        out[i] = values[i] <= floor_value ? -1 : 1;
+      }
+      return {};
+    }
+    target = quotient;
+  }
+
+  for (size_t i = 0; i < values.size(); ++i) {
+    out[i] = static_cast<int8_t>((values[i] > target) - (values[i] < target));
+  }
+  return {};
+}
+
 std::array<uint8_t, Decimal::kByteWidth> Decimal::ToBytes() const {
   std::array<uint8_t, kByteWidth> out{{0}};
   std::memcpy(out.data(), &data_, kByteWidth);
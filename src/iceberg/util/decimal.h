@@ -28,6 +28,7 @@
 #include <compare>
 #include <cstdint>
 #include <iosfwd>
+#include <span>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -174,6 +175,45 @@ class ICEBERG_EXPORT Decimal : public util::Formattable {
   /// \brief Convert Decimal from one scale to another.
   Result<Decimal> Rescale(int32_t orig_scale, int32_t new_scale) const;
 
+  /// \name Batch kernels
+  ///
+  /// Convert, rescale and compare columns of unscaled values, as laid out in Arrow
+  /// decimal128 buffers, a batch at a time. The checks and constants shared by a batch
+  /// are hoisted out of the per-value loops. Outputs are unspecified if an error is
+  /// returned.
+  /// @{
+
+  /// \brief Convert fixed-length big-endian values, as stored in Avro and Parquet
+  ///        fixed decimals, to unscaled values.
+  /// \param data The values, `byte_width` bytes each.
+  /// \param byte_width The length of each value, between 1 and 16.
+  /// \param out The unscaled values, one per `byte_width` bytes of `data`.
+  static Status FromBigEndian(std::span<const uint8_t> data, int32_t byte_width,
+                              std::span<int128_t> out);
+
+  /// \brief Convert unscaled values to fixed-length two's-complement big-endian values.
+  /// \param values The unscaled values.
+  /// \param byte_width The length of each output value, between 1 and 16.
+  /// \param out The values, `byte_width` bytes each.
+  /// \return error status if a value does not fit in `byte_width` bytes
+  static Status ToBigEndian(std::span<const int128_t> values, int32_t byte_width,
+                            std::span<uint8_t> out);
+
+  /// \brief Convert unscaled values from one scale to another. `out` may alias
+  ///        `values`.
+  /// \return error status if rescaling a value would cause data loss
+  static Status Rescale(std::span<const int128_t> values, int32_t orig_scale,
+                        int32_t new_scale, std::span<int128_t> out);
+
+  /// \brief Compare unscaled values with one Decimal of a possibly different scale.
+  /// \param out The sign of each comparison: -1, 0 or 1 if the value is less than,
+  ///        equal to or greater than `other`.
+  static Status Compare(std::span<const int128_t> values, int32_t scale,
+                        const Decimal& other, int32_t other_scale,
+                        std::span<int8_t> out);
+
+  /// @}
+
   /// \brief Whether this number fits in the given precision
   ///
   /// Returns true if the number of significant digits is less or equal to `precision`.
@@ -21,13 +21,142 @@
 
 #include <zlib.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <cstring>
-#include <vector>
+#include <limits>
+#include <optional>
+#include <span>
+#include <utility>
 
+#include "iceberg/executor.h"
 #include "iceberg/util/macros.h"
 
 namespace iceberg {
 
+namespace {
+
+/// \brief The ID of the extra field recording the compressed size of a member in its
+/// gzip header, see GZipOutputFile.
+constexpr char kMemberSizeId1 = 'I';
+constexpr char kMemberSizeId2 = 'C';
+/// \brief The size of the gzip header of a member written by GZipOutputFile: the
+/// fixed header, the length of the extra field, and the extra field holding the ID,
+/// length and value of the member size.
+constexpr size_t kMemberHeaderSize = 10 + 2 + 4 + 4;
+constexpr size_t kGzipTrailerSize = 8;
+
+bool StartsWithGzipMagic(std::string_view data) {
+  return data.size() >= 2 && static_cast<unsigned char>(data[0]) == 0x1f &&
+         static_cast<unsigned char>(data[1]) == 0x8b;
+}
+
+uint32_t ReadLittleEndian(const char* data, int size) {
+  const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+  uint32_t value = 0;
+  for (int i = size - 1; i >= 0; --i) {
+    value = (value << 8) | bytes[i];
+  }
+  return value;
+}
+
+void WriteLittleEndian32(uint32_t value, char* data) {
+  for (int i = 0; i < 4; ++i) {
+    data[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+  }
+}
+
+/// \brief Returns the compressed size of the gzip member at the start of `data`, as
+/// recorded in its header by GZipOutputFile, 0 if `data` ends before the size, or
+/// nullopt if the member does not record it.
+std::optional<size_t> MemberSize(std::string_view data) {
+  constexpr unsigned char kDeflateMethod = 8;
+  constexpr unsigned char kExtraFlag = 0x04;
+  constexpr size_t kFixedHeaderSize = 10;
+  if (data.size() < kFixedHeaderSize + 2) {
+    return 0;
+  }
+  if (!StartsWithGzipMagic(data) ||
+      static_cast<unsigned char>(data[2]) != kDeflateMethod ||
+      (static_cast<unsigned char>(data[3]) & kExtraFlag) == 0) {
+    return std::nullopt;
+  }
+  const size_t extra_end =
+      kFixedHeaderSize + 2 + ReadLittleEndian(data.data() + kFixedHeaderSize, 2);
+  if (data.size() < extra_end) {
+    return 0;
+  }
+  // The extra field is a list of subfields, each with a 2-byte ID and a 2-byte length.
+  for (size_t pos = kFixedHeaderSize + 2; pos + 4 <= extra_end;) {
+    const size_t length = ReadLittleEndian(data.data() + pos + 2, 2);
+    if (data[pos] == kMemberSizeId1 && data[pos + 1] == kMemberSizeId2 && length == 4 &&
+        pos + 8 <= extra_end) {
+      const size_t member_size = ReadLittleEndian(data.data() + pos + 4, 4);
+      if (member_size < extra_end + kGzipTrailerSize) {
+        return std::nullopt;
+      }
+      return member_size;
+    }
+    pos += 4 + length;
+  }
+  return std::nullopt;
+}
+
+/// \brief Compresses `data` into a gzip member whose header records its compressed
+/// size, see GZipOutputFile.
+Result<std::string> CompressMember(std::string_view data, int compression_level) {
+  // Raw deflate with the maximum window size, as the header and trailer are written
+  // here.
+  constexpr int kRawWindowBits = -15;
+  // Default memory level
+  constexpr int kMemLevel = 8;
+  // Unknown operating system
+  constexpr char kUnknownOs = '\xff';
+
+  z_stream stream;
+  memset(&stream, 0, sizeof(stream));
+  int ret = deflateInit2(&stream, compression_level, Z_DEFLATED, kRawWindowBits,
+                         kMemLevel, Z_DEFAULT_STRATEGY);
+  if (ret != Z_OK) {
+    return CompressError("deflateInit2 failed, result:{}", ret);
+  }
+  const size_t bound = deflateBound(&stream, static_cast<uLong>(data.size()));
+  std::string member(kMemberHeaderSize + bound + kGzipTrailerSize, '\0');
+  stream.avail_in = static_cast<uInt>(data.size());
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+  stream.avail_out = static_cast<uInt>(bound);
+  stream.next_out = reinterpret_cast<Bytef*>(member.data() + kMemberHeaderSize);
+  ret = deflate(&stream, Z_FINISH);
+  const size_t deflated_size = stream.total_out;
+  deflateEnd(&stream);
+  if (ret != Z_STREAM_END) {
+    return CompressError("deflate failed, result:{}", ret);
+  }
+  member.resize(kMemberHeaderSize + deflated_size + kGzipTrailerSize);
+
+  // ID, deflate method, FEXTRA flag, no modification time, no extra flags, unknown OS,
+  // 8 bytes of extra field holding one 4-byte subfield.
+  constexpr char kHeader[] = {'\x1f', '\x8b', 8, 4, 0, 0, 0, 0, 0, kUnknownOs,
+                              8,      0,      kMemberSizeId1, kMemberSizeId2, 4, 0};
+  memcpy(member.data(), kHeader, sizeof(kHeader));
+  WriteLittleEndian32(static_cast<uint32_t>(member.size()),
+                      member.data() + sizeof(kHeader));
+  char* trailer = member.data() + kMemberHeaderSize + deflated_size;
+  const auto crc = crc32(crc32(0L, Z_NULL, 0),
+                         reinterpret_cast<const Bytef*>(data.data()),
+                         static_cast<uInt>(data.size()));
+  WriteLittleEndian32(static_cast<uint32_t>(crc), trailer);
+  WriteLittleEndian32(static_cast<uint32_t>(data.size()), trailer + 4);
+  return member;
+}
+
+/// \brief The number of members compressed or decompressed ahead on an executor.
+size_t WindowCapacity(const std::shared_ptr<Executor>& executor) {
+  return executor != nullptr ? static_cast<size_t>(executor->concurrency()) : 1;
+}
+
+}  // namespace
+
 class ZlibImpl {
  public:
   ZlibImpl() { memset(&stream_, 0, sizeof(stream_)); }
@@ -61,23 +190,160 @@ class ZlibImpl {
     stream_.avail_in = static_cast<uInt>(compressed_data.size());
     stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(compressed_data.data()));
 
-    // TODO(xiao.dong) magic buffer, can we get a estimated size from compressed data?
-    std::vector<char> out_buffer(32 * 1024);
-    std::string result;
+    // Inflate straight into the result, which starts at the estimated output size and
+    // only grows if the estimate was too small.
+    std::string result(EstimateDecompressedSize(compressed_data), '\0');
+    size_t output_size = 0;
     int ret = 0;
     do {
-      stream_.avail_out = static_cast<uInt>(out_buffer.size());
-      stream_.next_out = reinterpret_cast<Bytef*>(out_buffer.data());
+      if (output_size == result.size()) {
+        result.resize(result.size() * 2);
+      }
+      size_t available = std::min<size_t>(result.size() - output_size,
+                                          std::numeric_limits<uInt>::max());
+      stream_.avail_out = static_cast<uInt>(available);
+      stream_.next_out = reinterpret_cast<Bytef*>(result.data() + output_size);
       ret = inflate(&stream_, Z_NO_FLUSH);
       if (ret != Z_OK && ret != Z_STREAM_END) {
         return DecompressError("inflate failed, result:{}", ret);
       }
-      result.append(out_buffer.data(), out_buffer.size() - stream_.avail_out);
+      output_size += available - stream_.avail_out;
+      if (ret == Z_OK && stream_.avail_in == 0 && stream_.avail_out != 0) {
+        return DecompressError("inflate failed, truncated compressed data");
+      }
+      // The members of a multi-member gzip stream decompress one after the other.
+      if (ret == Z_STREAM_END &&
+          StartsWithGzipMagic(std::string_view(reinterpret_cast<char*>(stream_.next_in),
+                                               stream_.avail_in))) {
+        ICEBERG_RETURN_UNEXPECTED(Reset());
+        ret = Z_OK;
+      }
     } while (ret != Z_STREAM_END);
+    result.resize(output_size);
+
+    // Allow decompressing another stream with the same decompressor.
+    ICEBERG_RETURN_UNEXPECTED(Reset());
+    return result;
+  }
+
+  /// \brief Inflates bytes of `input` into `output`, removing the consumed bytes from
+  /// `input`, and returns the number of bytes written to `output`. Sets `ended` when
+  /// the stream, or the gzip member, ends, after which Reset() starts another one.
+  Result<size_t> Inflate(std::string_view& input, std::span<char> output, bool& ended) {
+    if (!initialized_) {
+      ICEBERG_RETURN_UNEXPECTED(Init());
+    }
+    const auto input_size = static_cast<uInt>(
+        std::min<size_t>(input.size(), std::numeric_limits<uInt>::max()));
+    const auto output_size = static_cast<uInt>(
+        std::min<size_t>(output.size(), std::numeric_limits<uInt>::max()));
+    stream_.avail_in = input_size;
+    stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream_.avail_out = output_size;
+    stream_.next_out = reinterpret_cast<Bytef*>(output.data());
+    int ret = inflate(&stream_, Z_NO_FLUSH);
+    if (ret != Z_OK && ret != Z_STREAM_END) {
+      return DecompressError("inflate failed, result:{}", ret);
+    }
+    input.remove_prefix(input_size - stream_.avail_in);
+    ended = ret == Z_STREAM_END;
+    return output_size - stream_.avail_out;
+  }
+
+  Status Reset() {
+    int ret = inflateReset(&stream_);
+    if (ret != Z_OK) {
+      return DecompressError("inflateReset failed, result:{}", ret);
+    }
+    return {};
+  }
+
+ private:
+  /// \brief Estimates the decompressed size of a stream.
+  ///
+  /// Gzip streams end with the uncompressed size modulo 2^32 (ISIZE, little-endian),
+  /// which is exact for single-member streams under 4 GiB. The trailer is only trusted
+  /// within the maximum compression ratio of deflate, so that concatenated members or
+  /// corrupted data cannot make it allocate an unbounded buffer.
+  static size_t EstimateDecompressedSize(const std::string& compressed_data) {
+    constexpr size_t kMinBufferSize = 32 * 1024;
+    constexpr size_t kMaxCompressionRatio = 1032;
+    const auto* bytes = reinterpret_cast<const unsigned char*>(compressed_data.data());
+    const size_t size = compressed_data.size();
+    if (size < 10 + kGzipTrailerSize || bytes[0] != 0x1f || bytes[1] != 0x8b) {
+      return kMinBufferSize;
+    }
+    const size_t isize = ReadLittleEndian(compressed_data.data() + size - 4, 4);
+    if (isize == 0 || isize / kMaxCompressionRatio > size) {
+      return kMinBufferSize;
+    }
+    return isize;
+  }
+
+ private:
+  bool initialized_ = false;
+  z_stream stream_;
+};
+
+class ZlibDeflateImpl {
+ public:
+  explicit ZlibDeflateImpl(int compression_level)
+      : compression_level_(compression_level) {
+    memset(&stream_, 0, sizeof(stream_));
+  }
+
+  ~ZlibDeflateImpl() {
+    if (initialized_) {
+      deflateEnd(&stream_);
+    }
+  }
+
+  Status Init() {
+    // Maximum window size
+    constexpr int kWindowBits = 15;
+    // Write a gzip header and trailer instead of a zlib wrapper.
+    constexpr int kGzipCodec = 16;
+    // Default memory level
+    constexpr int kMemLevel = 8;
+    int ret = deflateInit2(&stream_, compression_level_, Z_DEFLATED,
+                           kWindowBits | kGzipCodec, kMemLevel, Z_DEFAULT_STRATEGY);
+    if (ret != Z_OK) {
+      return CompressError("deflateInit2 failed, result:{}", ret);
+    }
+    initialized_ = true;
+    return {};
+  }
+
+  Result<std::string> Compress(std::string_view data) {
+    if (!initialized_) {
+      ICEBERG_RETURN_UNEXPECTED(Init());
+    }
+    if (data.size() > std::numeric_limits<uInt>::max()) {
+      return CompressError("cannot compress {} bytes at once", data.size());
+    }
+    stream_.avail_in = static_cast<uInt>(data.size());
+    stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+
+    // The bound covers the whole output, so a single deflate call finishes the stream.
+    std::string result(deflateBound(&stream_, static_cast<uLong>(data.size())), '\0');
+    stream_.avail_out = static_cast<uInt>(result.size());
+    stream_.next_out = reinterpret_cast<Bytef*>(result.data());
+    int ret = deflate(&stream_, Z_FINISH);
+    if (ret != Z_STREAM_END) {
+      return CompressError("deflate failed, result:{}", ret);
+    }
+    result.resize(result.size() - stream_.avail_out);
+
+    // Allow compressing another stream with the same compressor.
+    ret = deflateReset(&stream_);
+    if (ret != Z_OK) {
+      return CompressError("deflateReset failed, result:{}", ret);
+    }
     return result;
   }
 
  private:
+  int compression_level_;
   bool initialized_ = false;
   z_stream stream_;
 };
@@ -92,4 +358,277 @@ Result<std::string> GZipDecompressor::Decompress(const std::string& compressed_d
   return zlib_impl_->Decompress(compressed_data);
 }
 
+GZipCompressor::GZipCompressor(int compression_level)
+    : zlib_impl_(std::make_unique<ZlibDeflateImpl>(compression_level)) {}
+
+GZipCompressor::~GZipCompressor() = default;
+
+Status GZipCompressor::Init() { return zlib_impl_->Init(); }
+
+Result<std::string> GZipCompressor::Compress(std::string_view data) {
+  return zlib_impl_->Compress(data);
+}
+
+GZipOutputFile::GZipOutputFile(std::unique_ptr<OutputFile> file, int compression_level,
+                               std::shared_ptr<Executor> executor)
+    : file_(std::move(file)),
+      compression_level_(compression_level),
+      window_(executor, WindowCapacity(executor), /*ordered=*/true) {}
+
+GZipOutputFile::~GZipOutputFile() = default;
+
+Result<std::unique_ptr<GZipOutputFile>> GZipOutputFile::Make(
+    std::unique_ptr<OutputFile> file, int compression_level,
+    std::shared_ptr<Executor> executor) {
+  if (file == nullptr) {
+    return InvalidArgument("Cannot compress into a null output file");
+  }
+  if (compression_level != Z_DEFAULT_COMPRESSION &&
+      (compression_level < Z_NO_COMPRESSION || compression_level > Z_BEST_COMPRESSION)) {
+    return InvalidArgument("Invalid gzip compression level: {}", compression_level);
+  }
+  return std::unique_ptr<GZipOutputFile>(
+      new GZipOutputFile(std::move(file), compression_level, std::move(executor)));
+}
+
+const std::string& GZipOutputFile::location() const { return file_->location(); }
+
+Status GZipOutputFile::Write(std::string_view data) {
+  if (closed_) {
+    return Invalid("Cannot write closed file {}", location());
+  }
+  const auto size = static_cast<int64_t>(data.size());
+  while (!data.empty()) {
+    const size_t append_size = std::min(data.size(), kMemberSize - buffer_.size());
+    buffer_.append(data.substr(0, append_size));
+    data.remove_prefix(append_size);
+    if (buffer_.size() == kMemberSize) {
+      ICEBERG_RETURN_UNEXPECTED(PushMember());
+    }
+  }
+  position_ += size;
+  return {};
+}
+
+Status GZipOutputFile::PushMember() {
+  if (window_.full()) {
+    ICEBERG_ASSIGN_OR_RAISE(auto member, window_.Take());
+    ICEBERG_RETURN_UNEXPECTED(file_->Write(member));
+  }
+  window_.Push([data = std::exchange(buffer_, std::string()),
+                compression_level = compression_level_]() {
+    return CompressMember(data, compression_level);
+  });
+  pushed_ = true;
+  return {};
+}
+
+Result<int64_t> GZipOutputFile::Position() const { return position_; }
+
+Status GZipOutputFile::Close() {
+  if (closed_) {
+    return {};
+  }
+  closed_ = true;
+  // An empty stream still has a member.
+  if (!buffer_.empty() || !pushed_) {
+    ICEBERG_RETURN_UNEXPECTED(PushMember());
+  }
+  while (!window_.empty()) {
+    ICEBERG_ASSIGN_OR_RAISE(auto member, window_.Take());
+    ICEBERG_RETURN_UNEXPECTED(file_->Write(member));
+  }
+  return file_->Close();
+}
+
+class GZipInputBuffer::Impl {
+ public:
+  Impl(std::unique_ptr<InputFile> file, int64_t size, std::shared_ptr<Executor> executor)
+      : file_(std::move(file)),
+        size_(size),
+        window_(executor, WindowCapacity(executor), /*ordered=*/true) {}
+
+  /// \brief Returns the next decompressed bytes, or no bytes at the end of the
+  /// stream. The bytes stay valid until the next call.
+  Result<std::string_view> Next() {
+    if (mode_ == Mode::kUnknown) {
+      ICEBERG_RETURN_UNEXPECTED(ReadMore(0));
+      auto member_size = MemberSize(remaining());
+      mode_ = member_size.has_value() && member_size.value() > 0 ? Mode::kMembers
+                                                                 : Mode::kStream;
+    }
+    return mode_ == Mode::kMembers ? NextMember() : NextInflated();
+  }
+
+ private:
+  enum class Mode : uint8_t {
+    kUnknown,
+    /// \brief The members record their sizes and are decompressed as a whole.
+    kMembers,
+    /// \brief The stream is inflated as it is read.
+    kStream,
+  };
+
+  static constexpr size_t kInflateBufferSize = 256 * 1024;
+
+  std::string_view remaining() const {
+    return std::string_view(input_).substr(input_pos_);
+  }
+
+  /// \brief The offset in the file of the first compressed byte not consumed yet.
+  int64_t consumed_offset() const {
+    return offset_ - static_cast<int64_t>(input_.size() - input_pos_);
+  }
+
+  /// \brief Reads the next compressed bytes of the file, at least enough for
+  /// `min_size` bytes to be buffered unless the file ends before.
+  Status ReadMore(size_t min_size) {
+    input_.erase(0, input_pos_);
+    input_pos_ = 0;
+    const size_t missing = min_size > input_.size() ? min_size - input_.size() : 0;
+    const auto read_size = static_cast<size_t>(
+        std::min(static_cast<int64_t>(std::max(kReadSize, missing)), size_ - offset_));
+    if (read_size == 0) {
+      return {};
+    }
+    const size_t buffered = input_.size();
+    input_.resize(buffered + read_size);
+    ICEBERG_ASSIGN_OR_RAISE(
+        auto read_bytes,
+        file_->ReadAt(offset_, std::span(reinterpret_cast<uint8_t*>(input_.data()) +
+                                             buffered,
+                                         read_size)));
+    input_.resize(buffered + static_cast<size_t>(read_bytes));
+    offset_ += read_bytes;
+    if (static_cast<size_t>(read_bytes) < read_size) {
+      size_ = offset_;
+    }
+    return {};
+  }
+
+  Result<std::string_view> NextMember() {
+    ICEBERG_RETURN_UNEXPECTED(PushMembers());
+    while (!window_.empty()) {
+      ICEBERG_ASSIGN_OR_RAISE(output_, window_.Take());
+      // Keep the window full while the bytes of this member are consumed.
+      ICEBERG_RETURN_UNEXPECTED(PushMembers());
+      if (!output_.empty()) {
+        return std::string_view(output_);
+      }
+    }
+    return std::string_view();
+  }
+
+  /// \brief Cuts the next members from the compressed bytes and pushes their
+  /// decompression, until the window is full or the file ends.
+  Status PushMembers() {
+    while (!window_.full()) {
+      const auto input = remaining();
+      if (input.empty() && offset_ == size_) {
+        return {};
+      }
+      const auto member_size = MemberSize(input);
+      if (!member_size.has_value()) {
+        return DecompressError("gzip member at offset {} of {} does not record its size",
+                               consumed_offset(), file_->location());
+      }
+      if (member_size.value() == 0 || member_size.value() > input.size()) {
+        if (offset_ == size_) {
+          return DecompressError("truncated gzip member at offset {} of {}",
+                                 consumed_offset(), file_->location());
+        }
+        ICEBERG_RETURN_UNEXPECTED(ReadMore(member_size.value()));
+        continue;
+      }
+      window_.Push([member = std::string(input.substr(0, member_size.value()))]() {
+        ZlibImpl zlib;
+        return zlib.Decompress(member);
+      });
+      input_pos_ += member_size.value();
+    }
+    return {};
+  }
+
+  Result<std::string_view> NextInflated() {
+    if (output_.size() != kInflateBufferSize) {
+      output_.resize(kInflateBufferSize);
+    }
+    while (true) {
+      if (ended_) {
+        // Another gzip member may follow, and other trailing bytes are ignored.
+        if (remaining().size() < 2 && offset_ < size_) {
+          ICEBERG_RETURN_UNEXPECTED(ReadMore(2));
+          continue;
+        }
+        if (!StartsWithGzipMagic(remaining())) {
+          return std::string_view();
+        }
+        ICEBERG_RETURN_UNEXPECTED(zlib_.Reset());
+        ended_ = false;
+      }
+      if (remaining().empty()) {
+        if (offset_ == size_) {
+          return DecompressError("inflate failed, truncated compressed data");
+        }
+        ICEBERG_RETURN_UNEXPECTED(ReadMore(0));
+      }
+      auto input = remaining();
+      ICEBERG_ASSIGN_OR_RAISE(auto output_size, zlib_.Inflate(input, output_, ended_));
+      input_pos_ = input_.size() - input.size();
+      if (output_size > 0) {
+        return std::string_view(output_.data(), output_size);
+      }
+    }
+  }
+
+  std::unique_ptr<InputFile> file_;
+  int64_t size_;
+  // The offset in the file of the next compressed bytes to read
+  int64_t offset_ = 0;
+  // The compressed bytes read, consumed up to input_pos_
+  std::string input_;
+  size_t input_pos_ = 0;
+  // The decompressed bytes returned by the last call to Next()
+  std::string output_;
+  Mode mode_ = Mode::kUnknown;
+  TaskWindow<std::string> window_;
+  ZlibImpl zlib_;
+  // Whether the stream or gzip member inflated by zlib_ ended
+  bool ended_ = false;
+};
+
+GZipInputBuffer::GZipInputBuffer(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+
+GZipInputBuffer::~GZipInputBuffer() = default;
+
+Result<std::unique_ptr<GZipInputBuffer>> GZipInputBuffer::Make(
+    std::unique_ptr<InputFile> file, std::shared_ptr<Executor> executor) {
+  if (file == nullptr) {
+    return InvalidArgument("Cannot decompress a null input file");
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto size, file->Size());
+  return std::unique_ptr<GZipInputBuffer>(new GZipInputBuffer(
+      std::make_unique<Impl>(std::move(file), size, std::move(executor))));
+}
+
+GZipInputBuffer::int_type GZipInputBuffer::underflow() {
+  if (gptr() < egptr()) {
+    return traits_type::to_int_type(*gptr());
+  }
+  if (!status_.has_value()) {
+    return traits_type::eof();
+  }
+  auto bytes = impl_->Next();
+  if (!bytes.has_value()) {
+    status_ = std::unexpected(std::move(bytes).error());
+    return traits_type::eof();
+  }
+  if (bytes->empty()) {
+    return traits_type::eof();
+  }
+  auto* data = const_cast<char*>(bytes->data());
+  setg(data, data, data + bytes->size());
+  return traits_type::to_int_type(*gptr());
+}
+
 }  // namespace iceberg
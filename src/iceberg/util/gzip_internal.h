@@ -19,14 +19,20 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
+#include <streambuf>
 #include <string>
+#include <string_view>
 
+#include "iceberg/file_io.h"
 #include "iceberg/result.h"
+#include "iceberg/util/task_window_internal.h"
 
 namespace iceberg {
 
 class ZlibImpl;
+class ZlibDeflateImpl;
 
 class GZipDecompressor {
  public:
@@ -36,10 +42,127 @@ class GZipDecompressor {
 
   Status Init();
 
+  /// \brief Decompresses a gzip or zlib stream, including all the members of a
+  /// multi-member gzip stream.
+  ///
+  /// The output of a single-member gzip stream is sized once from the uncompressed
+  /// size in its trailer, instead of growing with every inflated chunk.
   Result<std::string> Decompress(const std::string& compressed_data);
 
  private:
   std::unique_ptr<ZlibImpl> zlib_impl_;
 };
 
+class GZipCompressor {
+ public:
+  /// \brief The zlib compression level used by default.
+  static constexpr int kDefaultCompressionLevel = 6;
+
+  explicit GZipCompressor(int compression_level = kDefaultCompressionLevel);
+
+  ~GZipCompressor();
+
+  Status Init();
+
+  /// \brief Compresses data into a single-member gzip stream.
+  Result<std::string> Compress(std::string_view data);
+
+ private:
+  std::unique_ptr<ZlibDeflateImpl> zlib_impl_;
+};
+
+/// \brief An output file compressing the bytes written to it into a multi-member gzip
+/// stream, which is written to another output file as it is compressed.
+///
+/// The bytes are cut into members of kMemberSize uncompressed bytes, compressed
+/// independently of each other, like pigz does with `--independent`. Members are
+/// compressed on an executor when one is given, up to its concurrency ahead of the
+/// members written, and on the calling thread otherwise. The header of each member
+/// holds its compressed size in an extra field (RFC 1952), which lets GZipInputBuffer
+/// find the members without inflating them, and which other gzip readers skip.
+///
+/// Unlike GZipCompressor::Compress, neither the uncompressed nor the compressed content
+/// is held in memory at once.
+class GZipOutputFile : public OutputFile {
+ public:
+  /// \brief The number of uncompressed bytes of each member but the last.
+  static constexpr size_t kMemberSize = 1 << 20;
+
+  ~GZipOutputFile() override;
+
+  /// \brief Creates a gzip output file writing into `file`, which it closes when it is
+  /// closed.
+  /// \param executor The executor compressing the members, or null to compress them on
+  /// the calling thread.
+  static Result<std::unique_ptr<GZipOutputFile>> Make(
+      std::unique_ptr<OutputFile> file,
+      int compression_level = GZipCompressor::kDefaultCompressionLevel,
+      std::shared_ptr<Executor> executor = nullptr);
+
+  const std::string& location() const override;
+
+  Status Write(std::string_view data) override;
+
+  /// \brief Returns the number of uncompressed bytes written.
+  Result<int64_t> Position() const override;
+
+  /// \brief Finishes the gzip stream and closes the underlying file.
+  Status Close() override;
+
+ private:
+  GZipOutputFile(std::unique_ptr<OutputFile> file, int compression_level,
+                 std::shared_ptr<Executor> executor);
+
+  /// \brief Compresses the buffered bytes into the next member, writing the oldest
+  /// compressed member first if the window of compressed members is full.
+  Status PushMember();
+
+  std::unique_ptr<OutputFile> file_;
+  const int compression_level_;
+  TaskWindow<std::string> window_;
+  // The uncompressed bytes of the next member
+  std::string buffer_;
+  int64_t position_ = 0;
+  bool pushed_ = false;
+  bool closed_ = false;
+};
+
+/// \brief A stream buffer decompressing a gzip or zlib stream read from a file, for
+/// parsing it with a std::istream without holding the decompressed content.
+///
+/// The compressed bytes are read in chunks of kReadSize bytes. Streams written by
+/// GZipOutputFile are cut into their members, which are decompressed on an executor
+/// when one is given, up to its concurrency ahead of the bytes read from the stream.
+/// Other streams, including multi-member gzip streams without the compressed sizes of
+/// their members, are inflated on the calling thread as they are read.
+///
+/// An error ends the stream, and is then returned by status().
+class GZipInputBuffer : public std::streambuf {
+ public:
+  /// \brief The number of compressed bytes read from the file at once.
+  static constexpr size_t kReadSize = 1 << 20;
+
+  ~GZipInputBuffer() override;
+
+  /// \brief Creates a buffer decompressing the content of `file`.
+  /// \param executor The executor decompressing the members, or null to decompress
+  /// them on the calling thread.
+  static Result<std::unique_ptr<GZipInputBuffer>> Make(
+      std::unique_ptr<InputFile> file, std::shared_ptr<Executor> executor = nullptr);
+
+  /// \brief Returns the error that ended the stream, if any.
+  const Status& status() const { return status_; }
+
+ protected:
+  int_type underflow() override;
+
+ private:
+  class Impl;
+
+  explicit GZipInputBuffer(std::unique_ptr<Impl> impl);
+
+  std::unique_ptr<Impl> impl_;
+  Status status_;
+};
+
 }  // namespace iceberg
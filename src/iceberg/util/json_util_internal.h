@@ -25,6 +25,7 @@
 
 #include "iceberg/result.h"
 #include "iceberg/util/macros.h"
+#include "iceberg/util/persistent_vector.h"
 
 /// \file iceberg/util/json_util_internal.h
 /// \brief Internal utilities for JSON serialization and deserialization.
@@ -103,6 +104,26 @@ nlohmann::json::array_t ToJsonList(const std::vector<std::shared_ptr<T>>& list)
                          });
 }
 
+/// \brief Overload of the above function for a persistent vector.
+template <typename T>
+nlohmann::json::array_t ToJsonList(const PersistentVector<T>& list) {
+  return std::accumulate(list.cbegin(), list.cend(), nlohmann::json::array(),
+                         [](nlohmann::json::array_t arr, const T& item) {
+                           arr.push_back(ToJson(item));
+                           return arr;
+                         });
+}
+
+/// \brief Overload of the above function for a persistent vector of shared pointers.
+template <typename T>
+nlohmann::json::array_t ToJsonList(const PersistentVector<std::shared_ptr<T>>& list) {
+  return std::accumulate(list.cbegin(), list.cend(), nlohmann::json::array(),
+                         [](nlohmann::json::array_t arr, const std::shared_ptr<T>& item) {
+                           arr.push_back(ToJson(*item));
+                           return arr;
+                         });
+}
+
 /// \brief Parse a list of items from a JSON object.
 ///
 /// \param[in] json The JSON object to parse.
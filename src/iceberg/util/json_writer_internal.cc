@@ -0,0 +1,189 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/util/json_writer_internal.h"
+
+#include <charconv>
+#include <exception>
+
+#include <nlohmann/json.hpp>
+
+namespace iceberg {
+
+namespace {
+
+constexpr char kHexDigits[] = "0123456789abcdef";
+
+// Whether a byte of a string must be escaped, as nlohmann::json escapes them.
+constexpr bool NeedsEscape(unsigned char c) { return c < 0x20 || c == '"' || c == '\\'; }
+
+}  // namespace
+
+JsonWriter::JsonWriter(OutputFile& file, size_t chunk_size)
+    : file_(file), chunk_size_(chunk_size) {
+  buffer_.reserve(chunk_size_);
+}
+
+void JsonWriter::StartObject() {
+  BeforeValue();
+  buffer_.push_back('{');
+  has_elements_.push_back(false);
+}
+
+void JsonWriter::EndObject() {
+  has_elements_.pop_back();
+  buffer_.push_back('}');
+  MaybeWriteChunk();
+}
+
+void JsonWriter::StartArray() {
+  BeforeValue();
+  buffer_.push_back('[');
+  has_elements_.push_back(false);
+}
+
+void JsonWriter::EndArray() {
+  has_elements_.pop_back();
+  buffer_.push_back(']');
+  MaybeWriteChunk();
+}
+
+void JsonWriter::Key(std::string_view key) {
+  BeforeValue();
+  AppendEscaped(key);
+  buffer_.push_back(':');
+  after_key_ = true;
+}
+
+void JsonWriter::String(std::string_view value) {
+  BeforeValue();
+  AppendEscaped(value);
+  MaybeWriteChunk();
+}
+
+void JsonWriter::Int(int64_t value) {
+  BeforeValue();
+  char digits[24];
+  auto result = std::to_chars(digits, digits + sizeof(digits), value);
+  buffer_.append(digits, result.ptr);
+}
+
+void JsonWriter::Bool(bool value) {
+  BeforeValue();
+  buffer_.append(value ? "true" : "false");
+}
+
+void JsonWriter::Null() {
+  BeforeValue();
+  buffer_.append("null");
+}
+
+void JsonWriter::RawValue(std::string_view json) {
+  BeforeValue();
+  buffer_.append(json);
+  MaybeWriteChunk();
+}
+
+void JsonWriter::Value(const nlohmann::json& json) {
+  BeforeValue();
+  try {
+    buffer_.append(json.dump());
+  } catch (const std::exception& e) {
+    if (status_.has_value()) {
+      status_ = JsonParseError("Failed to serialize to JSON string: {}", e.what());
+    }
+  }
+  MaybeWriteChunk();
+}
+
+Status JsonWriter::Finish() {
+  if (status_.has_value() && !buffer_.empty()) {
+    status_ = file_.Write(buffer_);
+  }
+  buffer_.clear();
+  return status_;
+}
+
+void JsonWriter::BeforeValue() {
+  if (after_key_) {
+    after_key_ = false;
+    return;
+  }
+  if (!has_elements_.empty()) {
+    if (has_elements_.back()) {
+      buffer_.push_back(',');
+    }
+    has_elements_.back() = true;
+  }
+}
+
+void JsonWriter::AppendEscaped(std::string_view value) {
+  buffer_.push_back('"');
+  size_t start = 0;
+  for (size_t pos = 0; pos < value.size(); ++pos) {
+    const auto c = static_cast<unsigned char>(value[pos]);
+    if (!NeedsEscape(c)) [[likely]] {
+      continue;
+    }
+    buffer_.append(value.substr(start, pos - start));
+    start = pos + 1;
+    switch (c) {
+      case '"':
+        buffer_.append("\\\"");
+        break;
+      case '\\':
+        buffer_.append("\\\\");
+        break;
+      case '\b':
+        buffer_.append("\\b");
+        break;
+      case '\f':
+        buffer_.append("\\f");
+        break;
+      case '\n':
+        buffer_.append("\\n");
+        break;
+      case '\r':
+        buffer_.append("\\r");
+        break;
+      case '\t':
+        buffer_.append("\\t");
+        break;
+      default:
+        buffer_.append("\\u00");
+        buffer_.push_back(kHexDigits[c >> 4]);
+        buffer_.push_back(kHexDigits[c & 0xf]);
+        break;
+    }
+  }
+  buffer_.append(value.substr(start));
+  buffer_.push_back('"');
+}
+
+void JsonWriter::MaybeWriteChunk() {
+  if (buffer_.size() < chunk_size_) {
+    return;
+  }
+  if (status_.has_value()) {
+    status_ = file_.Write(buffer_);
+  }
+  buffer_.clear();
+}
+
+}  // namespace iceberg
@@ -0,0 +1,89 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/util/json_writer_internal.h
+/// \brief Internal writer streaming JSON text into an output file.
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nlohmann/json_fwd.hpp>
+
+#include "iceberg/file_io.h"
+#include "iceberg/result.h"
+
+namespace iceberg {
+
+/// \brief Writes JSON text into an output file as it is produced, without building a
+/// DOM of the whole document.
+///
+/// The text is buffered and written to the file in chunks. Calls do not return the
+/// errors of the file, the first of them is kept and returned by Finish, and the
+/// text produced after it is discarded. The writer does not check that the calls form
+/// a valid document.
+class JsonWriter {
+ public:
+  /// \brief The size of the buffered text at which it is written to the file.
+  static constexpr size_t kDefaultChunkSize = 256 * 1024;
+
+  explicit JsonWriter(OutputFile& file, size_t chunk_size = kDefaultChunkSize);
+
+  void StartObject();
+  void EndObject();
+  void StartArray();
+  void EndArray();
+
+  /// \brief Writes the key of the next member of the current object.
+  void Key(std::string_view key);
+
+  void String(std::string_view value);
+  void Int(int64_t value);
+  void Bool(bool value);
+  void Null();
+
+  /// \brief Writes a value that is already serialized, as is.
+  void RawValue(std::string_view json);
+
+  /// \brief Writes a value held in a DOM, for the small parts of a document.
+  void Value(const nlohmann::json& json);
+
+  /// \brief Writes the buffered text to the file, without closing it.
+  ///
+  /// \return The first error of the writer, if any.
+  Status Finish();
+
+ private:
+  void BeforeValue();
+  void AppendEscaped(std::string_view value);
+  void MaybeWriteChunk();
+
+  OutputFile& file_;
+  size_t chunk_size_;
+  std::string buffer_;
+  // Whether each of the open objects and arrays has an element already
+  std::vector<bool> has_elements_;
+  bool after_key_ = false;
+  Status status_;
+};
+
+}  // namespace iceberg
@@ -0,0 +1,443 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/util/merged_stream_internal.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+
+#include "iceberg/executor.h"
+#include "iceberg/schema.h"
+#include "iceberg/schema_internal.h"
+
+namespace iceberg {
+
+namespace {
+
+enum class PartState {
+  /// \brief Not opened yet, in the queue of a worker.
+  kPending,
+  /// \brief Opened and not being read.
+  kIdle,
+  /// \brief Being opened or read by a thread.
+  kBusy,
+  /// \brief All of its batches have been read.
+  kDone,
+};
+
+struct Part {
+  explicit Part(ArrowStreamOpener open) : open(std::move(open)) {}
+
+  ArrowStreamOpener open;
+  ArrowArrayStream stream{};
+  PartState state = PartState::kPending;
+  /// \brief The batches read and not returned yet.
+  std::deque<ArrowArray> batches;
+};
+
+void ReleaseArray(ArrowArray& array) {
+  if (array.release != nullptr) {
+    array.release(&array);
+  }
+}
+
+/// \brief The state shared by the stream and its workers, which may start after the
+/// stream is released.
+class MergeState {
+ public:
+  MergeState(std::vector<std::vector<ArrowStreamOpener>> groups,
+             MergedStreamOptions options)
+      : options_(std::move(options)),
+        queues_(options_.parallelism),
+        current_(options_.parallelism),
+        running_(options_.parallelism, false) {
+    size_t group_index = 0;
+    for (auto& group : groups) {
+      auto& queue = queues_[group_index++ % queues_.size()];
+      for (auto& open : group) {
+        queue.push_back(parts_.size());
+        parts_.emplace_back(std::move(open));
+      }
+    }
+    stopped_ = options_.limit == 0;
+  }
+
+  ~MergeState() { ReleaseParts(); }
+
+  /// \brief Submits the first workers.
+  static void Start(const std::shared_ptr<MergeState>& state) {
+    std::unique_lock lock(state->mutex_);
+    Schedule(state, lock);
+  }
+
+  /// \brief Stops the workers, waits for the parts that are being read and releases
+  /// the streams of the parts.
+  void Stop() {
+    std::unique_lock lock(mutex_);
+    stopped_ = true;
+    cv_.wait(lock, [&]() {
+      return std::ranges::none_of(
+          parts_, [](const Part& part) { return part.state == PartState::kBusy; });
+    });
+    ReleaseParts();
+  }
+
+  /// \brief Returns the next batch, reading it or waiting for it if needed.
+  static Result<std::optional<ArrowArray>> Next(
+      const std::shared_ptr<MergeState>& state) {
+    std::unique_lock lock(state->mutex_);
+    while (true) {
+      if (state->error_.has_value()) {
+        return std::unexpected(state->error_.value());
+      }
+      if (state->stopped_) {
+        return std::nullopt;
+      }
+      std::optional<size_t> next;
+      if (state->options_.ordered) {
+        if (state->head_ == state->parts_.size()) {
+          return std::nullopt;
+        }
+        auto& head = state->parts_[state->head_];
+        if (!head.batches.empty()) {
+          next = state->head_;
+        } else if (head.state == PartState::kDone) {
+          ++state->head_;
+          continue;
+        } else if (head.state != PartState::kBusy) {
+          state->ReadBatch(state->head_, lock);
+          continue;
+        }
+      } else {
+        if (!state->ready_.empty()) {
+          next = state->ready_.front();
+          state->ready_.pop_front();
+        } else if (state->done_ == state->parts_.size()) {
+          return std::nullopt;
+        } else if (auto part = state->Steal()) {
+          state->ReadBatch(*part, lock);
+          continue;
+        }
+      }
+      if (!next.has_value()) {
+        state->cv_.wait(lock);
+        continue;
+      }
+
+      auto& batches = state->parts_[*next].batches;
+      auto batch = batches.front();
+      batches.pop_front();
+      --state->buffered_;
+      if (state->options_.limit.has_value()) {
+        const int64_t remaining = state->options_.limit.value() - state->returned_;
+        // The children of a struct array may be longer than the array.
+        if (batch.length > remaining) {
+          batch.length = remaining;
+          batch.null_count = batch.null_count == 0 ? 0 : -1;
+        }
+        state->returned_ += batch.length;
+        if (state->returned_ >= state->options_.limit.value()) {
+          // The parts that have not started are never opened, and the others are
+          // closed once they are not being read.
+          state->stopped_ = true;
+          state->ReleaseParts();
+        }
+      }
+      Schedule(state, lock);
+      return batch;
+    }
+  }
+
+ private:
+  /// \brief Releases the batches and streams of the parts that are not being read,
+  /// called with the lock held once the stream is stopped.
+  void ReleaseParts() {
+    for (auto& part : parts_) {
+      if (part.state == PartState::kBusy) {
+        continue;
+      }
+      for (auto& batch : part.batches) {
+        ReleaseArray(batch);
+      }
+      part.batches.clear();
+      if (part.stream.release != nullptr) {
+        part.stream.release(&part.stream);
+      }
+    }
+  }
+
+  /// \brief Returns whether a worker would find a part to read, called with the lock
+  /// held.
+  bool HasWork() const {
+    return !idle_.empty() || std::ranges::any_of(queues_, [&](const auto& queue) {
+             return std::ranges::any_of(queue, [&](size_t index) {
+               return parts_[index].state == PartState::kPending;
+             });
+           });
+  }
+
+  /// \brief Submits the workers that are not running and have a part to read, called
+  /// with the lock held.
+  static void Schedule(const std::shared_ptr<MergeState>& state,
+                       std::unique_lock<std::mutex>& lock) {
+    if (state->stopped_ || state->error_.has_value() ||
+        state->buffered_ >= state->options_.capacity) {
+      return;
+    }
+    std::vector<size_t> submits;
+    for (size_t worker = 0; worker < state->running_.size(); ++worker) {
+      if (!state->running_[worker] && state->HasWork()) {
+        state->running_[worker] = true;
+        submits.push_back(worker);
+      }
+    }
+    if (submits.empty()) {
+      return;
+    }
+    lock.unlock();
+    for (size_t worker : submits) {
+      state->options_.executor->Submit([state, worker]() { Work(state, worker); });
+    }
+    lock.lock();
+  }
+
+  /// \brief Reads batches of the parts of a worker until the consumer has enough
+  /// batches waiting or no part is left to read.
+  static void Work(const std::shared_ptr<MergeState>& state, size_t worker) {
+    std::unique_lock lock(state->mutex_);
+    while (!state->stopped_ && !state->error_.has_value()) {
+      std::optional<size_t> part;
+      auto& current = state->current_[worker];
+      if (current.has_value() && state->parts_[*current].state == PartState::kIdle) {
+        part = current;
+      }
+      if (state->buffered_ >= state->options_.capacity) {
+        // Only the part that the consumer of an ordered stream waits for goes on.
+        if (!state->options_.ordered || part != state->head_) {
+          break;
+        }
+      } else if (!part.has_value()) {
+        part = state->Pop(worker);
+      }
+      if (!part.has_value()) {
+        break;
+      }
+      current = part;
+      state->ReadBatch(*part, lock);
+    }
+    state->running_[worker] = false;
+  }
+
+  /// \brief Takes the first pending part of the queue of a worker, or otherwise a part
+  /// of another worker, called with the lock held.
+  std::optional<size_t> Pop(size_t worker) {
+    auto& queue = queues_[worker];
+    while (!queue.empty()) {
+      const size_t index = queue.front();
+      queue.pop_front();
+      if (parts_[index].state == PartState::kPending) {
+        return index;
+      }
+    }
+    return Steal();
+  }
+
+  /// \brief Takes the last pending part of the longest queue, or otherwise the first
+  /// part that was opened and is not being read, called with the lock held.
+  std::optional<size_t> Steal() {
+    while (true) {
+      auto longest = std::ranges::max_element(
+          queues_, [](const auto& left, const auto& right) {
+            return left.size() < right.size();
+          });
+      if (longest == queues_.end() || longest->empty()) {
+        break;
+      }
+      const size_t index = longest->back();
+      longest->pop_back();
+      if (parts_[index].state == PartState::kPending) {
+        return index;
+      }
+    }
+    if (!idle_.empty()) {
+      return *idle_.begin();
+    }
+    return std::nullopt;
+  }
+
+  /// \brief Opens a part if needed and reads its next batch without the lock, called
+  /// with the lock held and the part not being read.
+  void ReadBatch(size_t index, std::unique_lock<std::mutex>& lock) {
+    auto& part = parts_[index];
+    const bool opened = part.state == PartState::kIdle;
+    idle_.erase(index);
+    part.state = PartState::kBusy;
+    lock.unlock();
+
+    Status status;
+    ArrowArray batch{};
+    if (!opened) {
+      auto stream = part.open();
+      if (stream.has_value()) {
+        part.stream = stream.value();
+      } else {
+        status = std::unexpected(stream.error());
+      }
+    }
+    if (status.has_value()) {
+      if (int code = part.stream.get_next(&part.stream, &batch); code != 0) {
+        const char* message = part.stream.get_last_error(&part.stream);
+        status = IOError("Cannot read the next batch of a part: {}",
+                         message != nullptr ? message : std::strerror(code));
+        batch = ArrowArray{};
+      }
+    }
+
+    lock.lock();
+    if (!status.has_value()) {
+      if (!error_.has_value()) {
+        error_ = status.error();
+      }
+      part.state = PartState::kDone;
+    } else if (batch.release == nullptr) {
+      part.state = PartState::kDone;
+      ++done_;
+    } else if (stopped_ || error_.has_value()) {
+      ReleaseArray(batch);
+      part.state = PartState::kDone;
+    } else {
+      part.batches.push_back(batch);
+      if (!options_.ordered) {
+        ready_.push_back(index);
+      }
+      ++buffered_;
+      part.state = PartState::kIdle;
+      idle_.insert(index);
+    }
+    if (part.state == PartState::kDone && part.stream.release != nullptr) {
+      part.stream.release(&part.stream);
+    }
+    cv_.notify_all();
+  }
+
+  const MergedStreamOptions options_;
+  std::vector<Part> parts_;
+  /// \brief The pending parts queued to each worker.
+  std::vector<std::deque<size_t>> queues_;
+  /// \brief The part that each worker read last.
+  std::vector<std::optional<size_t>> current_;
+  /// \brief Whether each worker is submitted.
+  std::vector<bool> running_;
+  /// \brief The parts that were opened and are not being read.
+  std::set<size_t> idle_;
+  /// \brief The parts of the batches waiting for the consumer of an unordered stream,
+  /// in the order they were read.
+  std::deque<size_t> ready_;
+  /// \brief The part that the consumer of an ordered stream reads.
+  size_t head_ = 0;
+  /// \brief The number of batches waiting for the consumer.
+  size_t buffered_ = 0;
+  /// \brief The number of parts whose batches have all been read.
+  size_t done_ = 0;
+  /// \brief The number of rows returned.
+  int64_t returned_ = 0;
+  std::optional<Error> error_;
+  bool stopped_ = false;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+struct MergedStreamPrivateData {
+  std::shared_ptr<Schema> schema;
+  std::shared_ptr<MergeState> state;
+  std::string last_error;
+
+  ~MergedStreamPrivateData() { state->Stop(); }
+};
+
+int GetSchema(ArrowArrayStream* stream, ArrowSchema* out) {
+  auto* data = static_cast<MergedStreamPrivateData*>(stream->private_data);
+  if (auto status = ToArrowSchema(*data->schema, out); !status.has_value()) {
+    data->last_error = status.error().message;
+    return EIO;
+  }
+  return 0;
+}
+
+int GetNext(ArrowArrayStream* stream, ArrowArray* out) {
+  auto* data = static_cast<MergedStreamPrivateData*>(stream->private_data);
+  auto batch = MergeState::Next(data->state);
+  if (!batch.has_value()) {
+    data->last_error = batch.error().message;
+    std::memset(out, 0, sizeof(ArrowArray));
+    return EIO;
+  }
+  if (batch->has_value()) {
+    *out = batch->value();
+  } else {
+    std::memset(out, 0, sizeof(ArrowArray));
+  }
+  return 0;
+}
+
+const char* GetLastError(ArrowArrayStream* stream) {
+  auto* data = static_cast<MergedStreamPrivateData*>(stream->private_data);
+  return data->last_error.empty() ? nullptr : data->last_error.c_str();
+}
+
+void Release(ArrowArrayStream* stream) {
+  delete static_cast<MergedStreamPrivateData*>(stream->private_data);
+  stream->private_data = nullptr;
+  stream->release = nullptr;
+}
+
+}  // namespace
+
+Result<ArrowArrayStream> MakeMergedArrowStream(
+    std::shared_ptr<Schema> schema, std::vector<std::vector<ArrowStreamOpener>> groups,
+    MergedStreamOptions options) {
+  if (options.parallelism <= 0) {
+    return InvalidArgument("Parallelism must be positive: {}", options.parallelism);
+  }
+  if (options.limit.has_value() && options.limit.value() < 0) {
+    return InvalidArgument("Limit cannot be negative: {}", options.limit.value());
+  }
+  options.capacity = std::max<size_t>(options.capacity, 1);
+  if (options.executor == nullptr) {
+    options.executor = DefaultExecutor();
+  }
+
+  auto data = std::make_unique<MergedStreamPrivateData>();
+  data->schema = std::move(schema);
+  data->state = std::make_shared<MergeState>(std::move(groups), std::move(options));
+  MergeState::Start(data->state);
+  return ArrowArrayStream{.get_schema = GetSchema,
+                          .get_next = GetNext,
+                          .get_last_error = GetLastError,
+                          .release = Release,
+                          .private_data = data.release()};
+}
+
+}  // namespace iceberg
@@ -0,0 +1,76 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "iceberg/arrow_c_data.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief Opens the stream of one part of a merged stream.
+using ArrowStreamOpener = std::function<Result<ArrowArrayStream>()>;
+
+/// \brief Options of a stream merging the batches of several streams.
+struct ICEBERG_EXPORT MergedStreamOptions {
+  /// \brief The number of workers reading parts at the same time.
+  int32_t parallelism = 1;
+  /// \brief Whether the batches are returned in the order of the parts, or as soon as
+  /// they are read.
+  bool ordered = true;
+  /// \brief The number of batches read ahead of the consumer, at least 1.
+  size_t capacity = 1;
+  /// \brief The number of rows after which the stream ends, or nullopt for all rows.
+  std::optional<int64_t> limit;
+  /// \brief The executor running the workers, the DefaultExecutor() if null.
+  std::shared_ptr<Executor> executor;
+};
+
+/// \brief Returns a stream of the batches of several streams, read by a number of
+/// workers.
+///
+/// Each group of parts is queued to one worker in turn. A worker reads its parts one
+/// batch at a time, and once its queue is empty it steals the last part of the
+/// longest queue of the other workers. Parts are only opened when a worker starts
+/// them. The workers stop once `capacity` batches wait for the consumer, and a
+/// consumer that waits for a part that is not being read reads it itself, so the
+/// stream never waits on a worker that has not started.
+///
+/// Once `limit` rows have been returned the last batch is truncated, the parts that
+/// have not started are never opened, the others are closed and the stream ends.
+/// The first error of a part stops the workers and is returned by every following
+/// call.
+///
+/// \param schema The schema of the batches of the parts
+/// \param groups The parts, in the order of their batches in an ordered stream
+/// \param options The workers and order of the stream
+ICEBERG_EXPORT Result<ArrowArrayStream> MakeMergedArrowStream(
+    std::shared_ptr<Schema> schema, std::vector<std::vector<ArrowStreamOpener>> groups,
+    MergedStreamOptions options);
+
+}  // namespace iceberg
@@ -33,6 +33,20 @@ void MurmurHash3_x86_128(const void* key, int len, uint32_t seed, void* out);
 
 void MurmurHash3_x64_128(const void* key, int len, uint32_t seed, void* out);
 
+//-----------------------------------------------------------------------------
+// Batch variants of MurmurHash3_x86_32 for 64-bit integer keys.
+//
+// out[i] is the MurmurHash3_x86_32 of the 8 little-endian bytes of keys[i];
+// 32-bit keys are sign-extended first. Keys are hashed in independent lanes so
+// that the loop vectorizes, and on x86-64 Linux AVX2 and AVX-512 versions are
+// also compiled and selected at runtime.
+
+void MurmurHash3_x86_32_Longs(const int32_t* keys, int64_t n, uint32_t seed,
+                              uint32_t* out);
+
+void MurmurHash3_x86_32_Longs(const int64_t* keys, int64_t n, uint32_t seed,
+                              uint32_t* out);
+
 //-----------------------------------------------------------------------------
 
 }  // namespace iceberg
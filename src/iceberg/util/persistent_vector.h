@@ -0,0 +1,306 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/util/persistent_vector.h
+/// A vector whose copies share their elements.
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace iceberg {
+
+/// \brief A sequence whose copies share their elements, which are only exposed through
+/// const references.
+///
+/// The elements are stored in chunks of kChunkSize elements held by shared pointers.
+/// Copying the vector copies the pointers to its chunks rather than its elements, and a
+/// copy only copies a chunk when it changes a chunk that it shares: appending copies
+/// the last chunk, and erasing elements from the front only drops the chunks that no
+/// longer hold elements. Table metadata with a long history is copied on every commit,
+/// which then costs time proportional to the number of chunks rather than to the
+/// number of elements.
+///
+/// Like std::vector, the vector must not be changed while it is read concurrently, but
+/// separate copies can be changed and read concurrently.
+template <typename T>
+class PersistentVector {
+ public:
+  /// \brief The number of elements of a chunk.
+  static constexpr size_t kChunkSize = 64;
+
+  using value_type = T;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = const T&;
+  using const_reference = const T&;
+  using pointer = const T*;
+  using const_pointer = const T*;
+
+  /// \brief A random access iterator over the elements.
+  class const_iterator {
+   public:
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using reference = const T&;
+    using pointer = const T*;
+
+    const_iterator() = default;
+
+    reference operator*() const { return (*vector_)[index_]; }
+    pointer operator->() const { return &(*vector_)[index_]; }
+    reference operator[](difference_type n) const {
+      return (*vector_)[static_cast<size_t>(static_cast<difference_type>(index_) + n)];
+    }
+
+    const_iterator& operator++() {
+      ++index_;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      auto copy = *this;
+      ++index_;
+      return copy;
+    }
+    const_iterator& operator--() {
+      --index_;
+      return *this;
+    }
+    const_iterator operator--(int) {
+      auto copy = *this;
+      --index_;
+      return copy;
+    }
+    const_iterator& operator+=(difference_type n) {
+      index_ = static_cast<size_t>(static_cast<difference_type>(index_) + n);
+      return *this;
+    }
+    const_iterator& operator-=(difference_type n) { return *this += -n; }
+
+    friend const_iterator operator+(const_iterator it, difference_type n) {
+      return it += n;
+    }
+    friend const_iterator operator+(difference_type n, const_iterator it) {
+      return it += n;
+    }
+    friend const_iterator operator-(const_iterator it, difference_type n) {
+      return it -= n;
+    }
+    friend difference_type operator-(const const_iterator& lhs,
+                                     const const_iterator& rhs) {
+      return static_cast<difference_type>(lhs.index_) -
+             static_cast<difference_type>(rhs.index_);
+    }
+    friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) {
+      return lhs.index_ == rhs.index_;
+    }
+    friend std::strong_ordering operator<=>(const const_iterator& lhs,
+                                            const const_iterator& rhs) {
+      return lhs.index_ <=> rhs.index_;
+    }
+
+   private:
+    friend class PersistentVector;
+
+    const_iterator(const PersistentVector* vector, size_t index)
+        : vector_(vector), index_(index) {}
+
+    const PersistentVector* vector_ = nullptr;
+    size_t index_ = 0;
+  };
+
+  using iterator = const_iterator;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using reverse_iterator = const_reverse_iterator;
+
+  PersistentVector() = default;
+
+  PersistentVector(std::initializer_list<T> values)
+      : PersistentVector(values.begin(), values.end()) {}
+
+  /// \brief Creates a vector from the elements of a std::vector.
+  PersistentVector(std::vector<T> values) {  // NOLINT(google-explicit-constructor)
+    for (auto& value : values) {
+      push_back(std::move(value));
+    }
+  }
+
+  template <std::input_iterator Iterator, std::sentinel_for<Iterator> Sentinel>
+  PersistentVector(Iterator first, Sentinel last) {
+    for (; first != last; ++first) {
+      push_back(*first);
+    }
+  }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  const T& operator[](size_t pos) const {
+    const size_t offset = offset_ + pos;
+    return (*chunks_[offset / kChunkSize])[offset % kChunkSize];
+  }
+  const T& front() const { return (*this)[0]; }
+  const T& back() const { return (*this)[size_ - 1]; }
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, size_); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+  const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+  const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+  const_reverse_iterator crbegin() const { return rbegin(); }
+  const_reverse_iterator crend() const { return rend(); }
+
+  /// \brief Appends an element, copying the last chunk if it is shared.
+  void push_back(T value) { emplace_back(std::move(value)); }
+
+  template <typename... Args>
+  const T& emplace_back(Args&&... args) {
+    auto& chunk = MutableLastChunk();
+    chunk.emplace_back(std::forward<Args>(args)...);
+    ++size_;
+    return chunk.back();
+  }
+
+  void clear() {
+    chunks_.clear();
+    offset_ = 0;
+    size_ = 0;
+  }
+
+  /// \brief Erases the elements in [first, last).
+  ///
+  /// Erasing from the front does not copy any chunk, erasing from elsewhere copies the
+  /// elements after `first`.
+  ///
+  /// \return An iterator to the element after the erased ones
+  const_iterator erase(const_iterator first, const_iterator last) {
+    const size_t from = first.index_;
+    const size_t to = last.index_;
+    if (from == to) {
+      return const_iterator(this, from);
+    }
+    if (from == 0) {
+      if (to == size_) {
+        clear();
+        return begin();
+      }
+      const size_t offset = offset_ + to;
+      chunks_.erase(chunks_.begin(),
+                    chunks_.begin() + static_cast<difference_type>(offset / kChunkSize));
+      offset_ = offset % kChunkSize;
+      size_ -= to;
+      return begin();
+    }
+    std::vector<T> tail(begin() + static_cast<difference_type>(to), end());
+    Truncate(from);
+    for (auto& value : tail) {
+      push_back(std::move(value));
+    }
+    return const_iterator(this, from);
+  }
+
+  /// \brief Erases the elements that satisfy a predicate, keeping the order of the
+  /// others. The predicate is called once for each element, and nothing is copied if
+  /// no element is erased.
+  ///
+  /// \return The number of erased elements
+  template <typename Predicate>
+  friend size_t erase_if(PersistentVector& vector, Predicate predicate) {
+    auto first = std::ranges::find_if(vector, std::ref(predicate));
+    if (first == vector.end()) {
+      return 0;
+    }
+    std::vector<T> kept;
+    for (auto it = std::next(first); it != vector.end(); ++it) {
+      if (!predicate(*it)) {
+        kept.push_back(*it);
+      }
+    }
+    const auto kept_before = static_cast<size_t>(first - vector.begin());
+    const size_t erased = vector.size() - kept_before - kept.size();
+    if (kept_before == 0) {
+      vector.clear();
+    } else {
+      vector.Truncate(kept_before);
+    }
+    for (auto& value : kept) {
+      vector.push_back(std::move(value));
+    }
+    return erased;
+  }
+
+  friend bool operator==(const PersistentVector& lhs, const PersistentVector& rhs) {
+    return lhs.size_ == rhs.size_ && std::ranges::equal(lhs, rhs);
+  }
+
+ private:
+  using Chunk = std::vector<T>;
+
+  /// \brief Returns the chunk to append to, which is not shared.
+  Chunk& MutableLastChunk() {
+    if (chunks_.empty() || chunks_.back()->size() == kChunkSize) {
+      auto chunk = std::make_shared<Chunk>();
+      chunk->reserve(kChunkSize);
+      chunks_.push_back(std::move(chunk));
+    } else if (chunks_.back().use_count() > 1) {
+      auto chunk = std::make_shared<Chunk>();
+      chunk->reserve(kChunkSize);
+      chunk->assign(chunks_.back()->begin(), chunks_.back()->end());
+      chunks_.back() = std::move(chunk);
+    }
+    return *chunks_.back();
+  }
+
+  /// \brief Keeps the first `count` elements, which must not be zero.
+  void Truncate(size_t count) {
+    const size_t end = offset_ + count;
+    chunks_.resize((end + kChunkSize - 1) / kChunkSize);
+    const size_t last_size = end - (chunks_.size() - 1) * kChunkSize;
+    if (chunks_.back().use_count() == 1) {
+      chunks_.back()->erase(
+          chunks_.back()->begin() + static_cast<difference_type>(last_size),
+          chunks_.back()->end());
+    } else if (chunks_.back()->size() != last_size) {
+      auto chunk = std::make_shared<Chunk>();
+      chunk->reserve(kChunkSize);
+      chunk->assign(chunks_.back()->begin(),
+                    chunks_.back()->begin() + static_cast<difference_type>(last_size));
+      chunks_.back() = std::move(chunk);
+    }
+    size_ = count;
+  }
+
+  // All chunks hold kChunkSize elements but the last one, and the elements of the
+  // vector start at offset_ in the first chunk.
+  std::vector<std::shared_ptr<Chunk>> chunks_;
+  size_t offset_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace iceberg
@@ -0,0 +1,57 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/util/read_ranges_internal.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace iceberg {
+
+std::vector<CoalescedReadRange> CoalesceReadRanges(std::span<const ReadRange> ranges,
+                                                   const ReadCoalescingOptions& options) {
+  std::vector<size_t> order(ranges.size());
+  std::iota(order.begin(), order.end(), size_t{0});
+  std::ranges::stable_sort(order, {}, [&](size_t i) { return ranges[i].offset; });
+
+  std::vector<CoalescedReadRange> coalesced;
+  int64_t end = 0;
+  for (size_t index : order) {
+    const auto& range = ranges[index];
+    const int64_t range_end = range.offset + static_cast<int64_t>(range.out.size());
+    if (!coalesced.empty()) {
+      auto& last = coalesced.back();
+      const int64_t merged_end = std::max(end, range_end);
+      if (range.offset <= end ||
+          (range.offset - end <= options.hole_size_limit &&
+           merged_end - last.offset <= options.range_size_limit)) {
+        end = merged_end;
+        last.length = end - last.offset;
+        last.ranges.push_back(index);
+        continue;
+      }
+    }
+    end = range_end;
+    coalesced.push_back(
+        {.offset = range.offset, .length = range_end - range.offset, .ranges = {index}});
+  }
+  return coalesced;
+}
+
+}  // namespace iceberg
@@ -0,0 +1,53 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "iceberg/file_io.h"
+#include "iceberg/iceberg_export.h"
+
+namespace iceberg {
+
+/// \brief A range of bytes covering one or more ranges of a vectored read.
+struct CoalescedReadRange {
+  /// \brief The offset of the first byte of the range.
+  int64_t offset;
+  /// \brief The number of bytes of the range.
+  int64_t length;
+  /// \brief The indices of the read ranges covered by this range.
+  std::vector<size_t> ranges;
+};
+
+/// \brief Merges the ranges of a vectored read that are close to each other.
+///
+/// Ranges are merged in the order of their offsets while the hole between them and
+/// the size of the merged range stay within the limits of the options. Overlapping
+/// ranges are always merged.
+///
+/// \param ranges The ranges to read, in any order
+/// \param options The limits of the merged ranges
+/// \return The merged ranges, sorted by offset
+ICEBERG_EXPORT std::vector<CoalescedReadRange> CoalesceReadRanges(
+    std::span<const ReadRange> ranges, const ReadCoalescingOptions& options);
+
+}  // namespace iceberg
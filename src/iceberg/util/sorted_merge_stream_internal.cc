@@ -0,0 +1,250 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/util/sorted_merge_stream_internal.h"
+
+#include <cerrno>
+#include <cstring>
+#include <optional>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "iceberg/partition_spec.h"
+#include "iceberg/schema.h"
+#include "iceberg/schema_internal.h"
+#include "iceberg/sort_key_encoder_internal.h"
+#include "iceberg/sort_order.h"
+#include "iceberg/util/arrow_array_filter_internal.h"
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief The number of merged rows that are gathered into a batch.
+constexpr size_t kOutputBatchRows = 4096;
+
+void ReleaseArray(ArrowArray& array) {
+  if (array.release != nullptr) {
+    array.release(&array);
+  }
+}
+
+/// \brief The position of the merge in a part.
+struct Cursor {
+  ~Cursor() {
+    ReleaseArray(batch);
+    if (stream.release != nullptr) {
+      stream.release(&stream);
+    }
+  }
+
+  ArrowStreamOpener open;
+  ArrowArrayStream stream{};
+  ArrowArray batch{};
+  SortKeys keys;
+  int64_t row = 0;
+
+  bool exhausted() const { return stream.release == nullptr; }
+  std::string_view key() const { return keys[row]; }
+};
+
+class SortedMerge {
+ public:
+  SortedMerge(std::shared_ptr<Schema> schema, std::unique_ptr<SortKeyEncoder> encoder,
+              std::vector<ArrowStreamOpener> parts)
+      : schema_(std::move(schema)), encoder_(std::move(encoder)), cursors_(parts.size()) {
+    for (size_t i = 0; i < parts.size(); ++i) {
+      cursors_[i].open = std::move(parts[i]);
+    }
+  }
+
+  ~SortedMerge() {
+    if (arrow_schema_.release != nullptr) {
+      arrow_schema_.release(&arrow_schema_);
+    }
+  }
+
+  const std::shared_ptr<Schema>& schema() const { return schema_; }
+
+  /// \brief Returns the next batch of merged rows, or nullopt at the end of the parts.
+  Result<std::optional<ArrowArray>> Next() {
+    if (!started_) {
+      ICEBERG_RETURN_UNEXPECTED(Start());
+    }
+    while (!heap_.empty()) {
+      const size_t part = heap_.top();
+      heap_.pop();
+      auto& cursor = cursors_[part];
+      pending_.push_back({.array = static_cast<int64_t>(part), .row = cursor.row});
+      if (++cursor.row < cursor.batch.length) {
+        heap_.push(part);
+        if (pending_.size() >= kOutputBatchRows) {
+          return Take();
+        }
+        continue;
+      }
+      // The pending rows are taken from the batch before it is replaced.
+      ICEBERG_ASSIGN_OR_RAISE(auto batch, Take());
+      auto advanced = Advance(cursor);
+      if (!advanced.has_value()) {
+        ReleaseArray(batch);
+        return std::unexpected(advanced.error());
+      }
+      if (!cursor.exhausted()) {
+        heap_.push(part);
+      }
+      return batch;
+    }
+    if (pending_.empty()) {
+      return std::nullopt;
+    }
+    return Take();
+  }
+
+ private:
+  /// \brief A min-heap order of the parts by their next key. Equal keys are taken from
+  /// the earlier part, which keeps the merge stable.
+  struct Greater {
+    const std::vector<Cursor>* cursors;
+
+    bool operator()(size_t lhs, size_t rhs) const {
+      const auto order = (*cursors)[lhs].key() <=> (*cursors)[rhs].key();
+      return order == 0 ? lhs > rhs : order > 0;
+    }
+  };
+
+  Status Start() {
+    started_ = true;
+    ICEBERG_RETURN_UNEXPECTED(ToArrowSchema(*schema_, &arrow_schema_));
+    for (auto& cursor : cursors_) {
+      ICEBERG_ASSIGN_OR_RAISE(cursor.stream, cursor.open());
+      ICEBERG_RETURN_UNEXPECTED(Advance(cursor));
+      arrays_.push_back(&cursor.batch);
+    }
+    for (size_t i = 0; i < cursors_.size(); ++i) {
+      if (!cursors_[i].exhausted()) {
+        heap_.push(i);
+      }
+    }
+    return {};
+  }
+
+  /// \brief Replaces the batch of a part with its next non-empty batch and encodes its
+  /// keys, releasing the stream of the part at its end.
+  Status Advance(Cursor& cursor) {
+    while (true) {
+      ReleaseArray(cursor.batch);
+      cursor.row = 0;
+      if (cursor.stream.get_next(&cursor.stream, &cursor.batch) != 0) {
+        const char* message = cursor.stream.get_last_error(&cursor.stream);
+        return IOError("Failed to read a part of a sorted merge: {}",
+                       message != nullptr ? message : "unknown error");
+      }
+      if (cursor.batch.release == nullptr) {
+        cursor.stream.release(&cursor.stream);
+        return {};
+      }
+      if (cursor.batch.length > 0) {
+        return encoder_->Encode(cursor.batch, cursor.keys);
+      }
+    }
+  }
+
+  Result<ArrowArray> Take() {
+    auto batch = TakeArrowArrays(arrow_schema_, arrays_, pending_);
+    pending_.clear();
+    return batch;
+  }
+
+  std::shared_ptr<Schema> schema_;
+  std::unique_ptr<SortKeyEncoder> encoder_;
+  std::vector<Cursor> cursors_;
+  std::vector<const ArrowArray*> arrays_;
+  std::priority_queue<size_t, std::vector<size_t>, Greater> heap_{Greater{&cursors_}};
+  std::vector<ArrowRowLocation> pending_;
+  ArrowSchema arrow_schema_{};
+  bool started_ = false;
+};
+
+struct SortedMergePrivateData {
+  std::unique_ptr<SortedMerge> merge;
+  std::string last_error;
+};
+
+int GetSchema(ArrowArrayStream* stream, ArrowSchema* out) {
+  auto* data = static_cast<SortedMergePrivateData*>(stream->private_data);
+  if (auto status = ToArrowSchema(*data->merge->schema(), out); !status.has_value()) {
+    data->last_error = status.error().message;
+    return EIO;
+  }
+  return 0;
+}
+
+int GetNext(ArrowArrayStream* stream, ArrowArray* out) {
+  auto* data = static_cast<SortedMergePrivateData*>(stream->private_data);
+  auto batch = data->merge->Next();
+  if (!batch.has_value()) {
+    data->last_error = batch.error().message;
+    std::memset(out, 0, sizeof(ArrowArray));
+    return EIO;
+  }
+  if (batch->has_value()) {
+    *out = batch->value();
+  } else {
+    std::memset(out, 0, sizeof(ArrowArray));
+  }
+  return 0;
+}
+
+const char* GetLastError(ArrowArrayStream* stream) {
+  auto* data = static_cast<SortedMergePrivateData*>(stream->private_data);
+  return data->last_error.empty() ? nullptr : data->last_error.c_str();
+}
+
+void Release(ArrowArrayStream* stream) {
+  delete static_cast<SortedMergePrivateData*>(stream->private_data);
+  stream->private_data = nullptr;
+  stream->release = nullptr;
+}
+
+}  // namespace
+
+Result<ArrowArrayStream> MakeSortedMergeArrowStream(
+    std::shared_ptr<Schema> schema, std::shared_ptr<SortOrder> sort_order,
+    std::vector<ArrowStreamOpener> parts) {
+  if (schema == nullptr || sort_order == nullptr) {
+    return InvalidArgument("Sorted merge requires a schema and a sort order");
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto encoder,
+                          SortKeyEncoder::Make(*schema, *PartitionSpec::Unpartitioned(),
+                                               *sort_order));
+  auto data = std::make_unique<SortedMergePrivateData>();
+  data->merge = std::make_unique<SortedMerge>(std::move(schema), std::move(encoder),
+                                              std::move(parts));
+  return ArrowArrayStream{.get_schema = GetSchema,
+                          .get_next = GetNext,
+                          .get_last_error = GetLastError,
+                          .release = Release,
+                          .private_data = data.release()};
+}
+
+}  // namespace iceberg
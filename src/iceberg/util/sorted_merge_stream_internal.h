@@ -0,0 +1,50 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "iceberg/arrow_c_data.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+#include "iceberg/util/merged_stream_internal.h"
+
+namespace iceberg {
+
+/// \brief Returns a stream merging the rows of several streams that are each sorted by
+/// a sort order into a single stream sorted by it.
+///
+/// The parts are opened on the first call for a batch and read one batch at a time on
+/// the calling thread. Rows are compared by their encoded sort keys, and rows with
+/// equal keys are returned in the order of their parts. A batch of the stream ends
+/// when the batch of a part runs out, so that every batch of a part is released before
+/// the next one is read.
+///
+/// \param schema The schema of the batches of the parts, which has the source columns
+/// of the sort order
+/// \param sort_order The order of the rows of every part
+/// \param parts The parts to merge
+ICEBERG_EXPORT Result<ArrowArrayStream> MakeSortedMergeArrowStream(
+    std::shared_ptr<Schema> schema, std::shared_ptr<SortOrder> sort_order,
+    std::vector<ArrowStreamOpener> parts);
+
+}  // namespace iceberg
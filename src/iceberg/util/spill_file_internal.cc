@@ -0,0 +1,121 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/util/spill_file_internal.h"
+
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <random>
+#include <system_error>
+#include <utility>
+
+#include "iceberg/util/endian.h"
+
+namespace iceberg {
+
+namespace {
+
+/// \brief Returns a name unique across the processes sharing a directory.
+std::string UniqueName(std::string_view prefix) {
+  static const uint64_t process_id = []() {
+    std::random_device device;
+    return (static_cast<uint64_t>(device()) << 32) | device();
+  }();
+  static std::atomic<uint64_t> next_id = 0;
+  return std::format("{}-{:016x}-{}.spill", prefix, process_id, next_id++);
+}
+
+}  // namespace
+
+SpillFile::SpillFile(std::string path) : path_(std::move(path)) {}
+
+SpillFile::~SpillFile() {
+  file_.close();
+  std::error_code ec;
+  std::filesystem::remove(path_, ec);
+}
+
+Result<std::unique_ptr<SpillFile>> SpillFile::Make(const std::string& directory,
+                                                   std::string_view prefix) {
+  std::error_code ec;
+  std::filesystem::create_directories(directory, ec);
+  if (ec) {
+    return IOError("Cannot create spill directory {}: {}", directory, ec.message());
+  }
+  auto path = (std::filesystem::path(directory) / UniqueName(prefix)).string();
+  auto file = std::unique_ptr<SpillFile>(new SpillFile(path));
+  file->file_.open(path, std::ios::in | std::ios::out | std::ios::binary |
+                             std::ios::trunc);
+  if (!file->file_.is_open()) {
+    return IOError("Cannot create spill file {}", path);
+  }
+  return file;
+}
+
+Result<int64_t> SpillFile::Append(std::span<const uint8_t> record) {
+  const uint64_t size = ToLittleEndian(static_cast<uint64_t>(record.size()));
+  std::lock_guard lock(mutex_);
+  const int64_t offset = size_bytes_;
+  file_.seekp(offset);
+  file_.write(reinterpret_cast<const char*>(&size), sizeof(size));
+  file_.write(reinterpret_cast<const char*>(record.data()),
+              static_cast<std::streamsize>(record.size()));
+  file_.flush();
+  if (!file_) {
+    file_.clear();
+    return IOError("Cannot write {} bytes to spill file {}", record.size(), path_);
+  }
+  size_bytes_ += static_cast<int64_t>(sizeof(size) + record.size());
+  return offset;
+}
+
+Result<std::vector<uint8_t>> SpillFile::Read(int64_t offset) const {
+  std::lock_guard lock(mutex_);
+  if (offset < 0 || offset + static_cast<int64_t>(sizeof(uint64_t)) > size_bytes_) {
+    return InvalidArgument("Offset {} is out of spill file {} of {} bytes", offset,
+                           path_, size_bytes_);
+  }
+  uint64_t size = 0;
+  file_.seekg(offset);
+  file_.read(reinterpret_cast<char*>(&size), sizeof(size));
+  size = FromLittleEndian(size);
+  if (!file_ || size > static_cast<uint64_t>(size_bytes_ - offset) - sizeof(size)) {
+    file_.clear();
+    return IOError("Cannot read the record at offset {} of spill file {}", offset,
+                   path_);
+  }
+  std::vector<uint8_t> record(size);
+  file_.read(reinterpret_cast<char*>(record.data()),
+             static_cast<std::streamsize>(size));
+  if (!file_) {
+    file_.clear();
+    return IOError("Cannot read the record at offset {} of spill file {}", offset,
+                   path_);
+  }
+  return record;
+}
+
+int64_t SpillFile::size_bytes() const {
+  std::lock_guard lock(mutex_);
+  return size_bytes_;
+}
+
+}  // namespace iceberg
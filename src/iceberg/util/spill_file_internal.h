@@ -0,0 +1,77 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+
+namespace iceberg {
+
+/// \brief A temporary local file of records spilled from memory.
+///
+/// Records are appended with their size and read back by the offset returned when
+/// they were appended. The file is removed when the object is destroyed. Appends and
+/// reads are thread-safe.
+class ICEBERG_EXPORT SpillFile {
+ public:
+  /// \brief Creates an empty spill file with a unique name in a directory.
+  ///
+  /// \param directory The local directory of the file, created if missing
+  /// \param prefix The prefix of the name of the file
+  /// \return A Result containing the file, or an error if it cannot be created.
+  static Result<std::unique_ptr<SpillFile>> Make(const std::string& directory,
+                                                 std::string_view prefix);
+
+  ~SpillFile();
+
+  SpillFile(const SpillFile&) = delete;
+  SpillFile& operator=(const SpillFile&) = delete;
+
+  /// \brief Appends a record and returns its offset in the file.
+  Result<int64_t> Append(std::span<const uint8_t> record);
+
+  /// \brief Reads the record appended at an offset.
+  Result<std::vector<uint8_t>> Read(int64_t offset) const;
+
+  /// \brief The size of the file in bytes.
+  int64_t size_bytes() const;
+
+  /// \brief The path of the file.
+  const std::string& path() const { return path_; }
+
+ private:
+  explicit SpillFile(std::string path);
+
+  const std::string path_;
+  mutable std::mutex mutex_;
+  mutable std::fstream file_;
+  int64_t size_bytes_ = 0;
+};
+
+}  // namespace iceberg
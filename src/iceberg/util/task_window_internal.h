@@ -0,0 +1,170 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/util/task_window_internal.h
+/// A window of tasks run ahead of their results on an executor.
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "iceberg/executor.h"
+#include "iceberg/result.h"
+
+namespace iceberg {
+
+/// \brief Runs up to `capacity` tasks ahead of the results taken from it.
+///
+/// Each pushed task is run by a helper submitted to the executor, unless the capacity
+/// is 1, or by the thread taking the results, which runs the first pending task itself
+/// rather than waiting for a helper that has not started. Results are taken in the
+/// order of the tasks when `ordered` is set, and as the tasks complete otherwise. An
+/// error stops the helpers, and destroying the window waits for the running tasks,
+/// while pending tasks are never run.
+///
+/// The window is used by one thread, which pushes the tasks and takes the results.
+template <typename T>
+class TaskWindow {
+ public:
+  using Task = std::function<Result<T>()>;
+
+  TaskWindow(std::shared_ptr<Executor> executor, size_t capacity, bool ordered)
+      : executor_(std::move(executor)),
+        capacity_(std::max<size_t>(capacity, 1)),
+        ordered_(ordered),
+        state_(std::make_shared<State>()) {}
+
+  ~TaskWindow() {
+    std::unique_lock lock(state_->mutex);
+    state_->stopped = true;
+    state_->cv.wait(lock, [&]() { return state_->running == 0; });
+  }
+
+  TaskWindow(const TaskWindow&) = delete;
+  TaskWindow& operator=(const TaskWindow&) = delete;
+
+  /// \brief Returns whether no task is waiting to be taken.
+  bool empty() const {
+    std::lock_guard lock(state_->mutex);
+    return state_->slots.empty();
+  }
+
+  /// \brief Returns whether `capacity` tasks are waiting to be taken.
+  bool full() const {
+    std::lock_guard lock(state_->mutex);
+    return state_->slots.size() >= capacity_;
+  }
+
+  /// \brief Adds a task, which runs concurrently with the others.
+  void Push(Task task) {
+    {
+      std::lock_guard lock(state_->mutex);
+      state_->slots.push_back(std::make_shared<Slot>(std::move(task)));
+    }
+    if (capacity_ > 1) {
+      executor_->Submit([state = state_]() {
+        std::unique_lock lock(state->mutex);
+        if (!state->stopped) {
+          state->RunOne(lock);
+        }
+      });
+    }
+  }
+
+  /// \brief Takes the result of the first task, or of the first task to complete if
+  /// the window is not ordered, waiting for it or running it. The window must not be
+  /// empty.
+  Result<T> Take() {
+    std::unique_lock lock(state_->mutex);
+    auto& slots = state_->slots;
+    while (true) {
+      auto it = ordered_ ? (slots.front()->result.has_value() ? slots.begin()
+                                                               : slots.end())
+                         : std::ranges::find_if(slots, [](const auto& slot) {
+                             return slot->result.has_value();
+                           });
+      if (it != slots.end()) {
+        auto slot = std::move(*it);
+        slots.erase(it);
+        if (!slot->result->has_value()) {
+          state_->stopped = true;
+        }
+        return std::move(slot->result).value();
+      }
+      if (!state_->RunOne(lock)) {
+        state_->cv.wait(lock);
+      }
+    }
+  }
+
+ private:
+  /// \brief A task waiting to be taken: pending while it has a task, running while it
+  /// has neither a task nor a result, and complete once it has a result.
+  struct Slot {
+    explicit Slot(Task task) : task(std::move(task)) {}
+
+    Task task;
+    std::optional<Result<T>> result;
+  };
+
+  /// \brief The state shared with the helpers, which may start after the window is
+  /// destroyed.
+  struct State {
+    /// \brief Runs the first pending task without the lock, called with the lock
+    /// held. Returns false if no task is pending.
+    bool RunOne(std::unique_lock<std::mutex>& lock) {
+      auto it = std::ranges::find_if(
+          slots, [](const auto& slot) { return slot->task != nullptr; });
+      if (it == slots.end()) {
+        return false;
+      }
+      auto slot = *it;
+      auto task = std::exchange(slot->task, nullptr);
+      ++running;
+      lock.unlock();
+      auto result = task();
+      lock.lock();
+      slot->result = std::move(result);
+      --running;
+      cv.notify_all();
+      return true;
+    }
+
+    mutable std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::shared_ptr<Slot>> slots;
+    size_t running = 0;
+    bool stopped = false;
+  };
+
+  const std::shared_ptr<Executor> executor_;
+  const size_t capacity_;
+  const bool ordered_;
+  std::shared_ptr<State> state_;
+};
+
+}  // namespace iceberg
@@ -0,0 +1,71 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/util/tracing.h"
+
+#include <mutex>
+
+namespace iceberg {
+
+namespace {
+
+std::mutex global_tracer_mutex;
+std::shared_ptr<Tracer> global_tracer;
+
+}  // namespace
+
+std::shared_ptr<Tracer> Tracer::Global() {
+  std::lock_guard lock(global_tracer_mutex);
+  return global_tracer;
+}
+
+void Tracer::SetGlobal(std::shared_ptr<Tracer> tracer) {
+  std::lock_guard lock(global_tracer_mutex);
+  global_tracer = std::move(tracer);
+}
+
+TraceScope::TraceScope(std::string_view name) {
+  if (auto tracer = Tracer::Global(); tracer != nullptr) {
+    span_ = tracer->StartSpan(name);
+    start_ = std::chrono::steady_clock::now();
+  }
+}
+
+TraceScope::~TraceScope() {
+  if (span_ != nullptr) {
+    span_->SetAttribute("duration_ns",
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - start_)
+                            .count());
+  }
+}
+
+void TraceScope::SetAttribute(std::string_view key, int64_t value) {
+  if (span_ != nullptr) {
+    span_->SetAttribute(key, value);
+  }
+}
+
+void TraceScope::SetAttribute(std::string_view key, std::string_view value) {
+  if (span_ != nullptr) {
+    span_->SetAttribute(key, value);
+  }
+}
+
+}  // namespace iceberg
@@ -0,0 +1,108 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+/// \file iceberg/util/tracing.h
+/// Hooks to trace the metadata, manifest, data file and catalog operations of the
+/// library, such as with OpenTelemetry spans.
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include "iceberg/iceberg_export.h"
+
+namespace iceberg {
+
+/// \brief A traced operation, ended when it is destroyed.
+class ICEBERG_EXPORT Span {
+ public:
+  virtual ~Span() = default;
+
+  /// \brief Sets an integer attribute of the operation.
+  virtual void SetAttribute(std::string_view key, int64_t value) = 0;
+
+  /// \brief Sets a string attribute of the operation.
+  virtual void SetAttribute(std::string_view key, std::string_view value) = 0;
+};
+
+/// \brief Creates the spans of traced operations.
+///
+/// Spans are created and destroyed on the thread running the operation, so a tracer
+/// can nest them under the span active on that thread. Operations are traced only when
+/// the library is built with ICEBERG_ENABLE_TRACING and a process-wide tracer is
+/// installed with SetGlobal().
+///
+/// The spans of the library have these attributes, when they apply:
+/// - `path`: the location of the file read or written
+/// - `bytes`: the number of bytes read
+/// - `rows`: the number of rows or manifest entries read
+/// - `table`: the name of the table of a catalog operation
+/// - `duration_ns`: the duration of the operation in nanoseconds, set when it ends
+class ICEBERG_EXPORT Tracer {
+ public:
+  virtual ~Tracer() = default;
+
+  /// \brief Starts the span of an operation.
+  ///
+  /// \param name The name of the operation, such as `ManifestReader::Entries`
+  /// \return The span, or null to not trace the operation.
+  virtual std::unique_ptr<Span> StartSpan(std::string_view name) = 0;
+
+  /// \brief Returns the process-wide tracer, or null if none is installed.
+  static std::shared_ptr<Tracer> Global();
+
+  /// \brief Installs the process-wide tracer, or disables tracing when given null.
+  static void SetGlobal(std::shared_ptr<Tracer> tracer);
+};
+
+/// \brief Traces the scope it is declared in with a span of the global tracer.
+///
+/// Attributes are dropped when no tracer is installed. Use it through the
+/// ICEBERG_TRACE_SCOPE and ICEBERG_TRACE_ATTRIBUTE macros, which compile to nothing
+/// unless ICEBERG_ENABLE_TRACING is defined.
+class ICEBERG_EXPORT TraceScope {
+ public:
+  explicit TraceScope(std::string_view name);
+  ~TraceScope();
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+  void SetAttribute(std::string_view key, int64_t value);
+  void SetAttribute(std::string_view key, std::string_view value);
+
+ private:
+  std::unique_ptr<Span> span_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace iceberg
+
+#ifdef ICEBERG_ENABLE_TRACING
+/// \brief Declares a TraceScope named `scope` tracing the enclosing scope.
+#define ICEBERG_TRACE_SCOPE(scope, name) ::iceberg::TraceScope scope(name)
+/// \brief Sets an attribute of the span of `scope`.
+#define ICEBERG_TRACE_ATTRIBUTE(scope, key, value) (scope).SetAttribute(key, value)
+#else
+#define ICEBERG_TRACE_SCOPE(scope, name) static_cast<void>(0)
+#define ICEBERG_TRACE_ATTRIBUTE(scope, key, value) static_cast<void>(0)
+#endif
@@ -19,9 +19,15 @@
 
 #include "iceberg/util/truncate_util.h"
 
+#include <bit>
 #include <cstdint>
+#include <cstring>
 #include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 #include "iceberg/expression/literal.h"
 #include "iceberg/util/checked_cast.h"
@@ -57,8 +63,9 @@ Literal TruncateLiteralImpl<TypeId::kDecimal>(const Literal& literal, int32_t wi
 template <>
 Literal TruncateLiteralImpl<TypeId::kString>(const Literal& literal, int32_t width) {
   // Strings are truncated to a valid UTF-8 string with no more than `width` code points.
-  const auto& str = std::get<std::string>(literal.value());
-  return Literal::String(TruncateUtils::TruncateUTF8(str, width));
+  std::string_view str = std::get<std::string>(literal.value());
+  return Literal::String(
+      std::string(str.substr(0, TruncateUtils::UTF8PrefixLength(str, width))));
 }
 
 template <>
@@ -72,10 +79,121 @@ Literal TruncateLiteralImpl<TypeId::kBinary>(const Literal& literal, int32_t wid
   return Literal::Binary(std::vector<uint8_t>(data.begin(), data.begin() + width));
 }
 
+/// \brief Appends the UTF-8 encoding of a code point.
+void AppendCodePoint(uint32_t code_point, std::string* out) {
+  if (code_point < 0x80) {
+    out->push_back(static_cast<char>(code_point));
+  } else if (code_point < 0x800) {
+    out->push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+    out->push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+  } else if (code_point < 0x10000) {
+    out->push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+    out->push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+    out->push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+  } else {
+    out->push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+    out->push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+    out->push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+    out->push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+  }
+}
+
+/// \brief Decodes the UTF-8 code point that starts at the beginning of `data`.
+uint32_t DecodeCodePoint(std::string_view data) {
+  const auto lead = static_cast<uint8_t>(data[0]);
+  uint32_t code_point = lead;
+  size_t length = 1;
+  if (lead >= 0xF0) {
+    code_point = lead & 0x07;
+    length = 4;
+  } else if (lead >= 0xE0) {
+    code_point = lead & 0x0F;
+    length = 3;
+  } else if (lead >= 0xC0) {
+    code_point = lead & 0x1F;
+    length = 2;
+  }
+  for (size_t i = 1; i < length && i < data.size(); ++i) {
+    code_point = (code_point << 6) | (static_cast<uint8_t>(data[i]) & 0x3F);
+  }
+  return code_point;
+}
+
 }  // namespace
 
+size_t TruncateUtils::UTF8PrefixLength(std::string_view source, size_t L) {
+  if (source.size() <= L) {
+    // A code point has at least one byte.
+    return source.size();
+  }
+  size_t code_points = 0;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= source.size(); i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, source.data() + i, sizeof(word));
+    // Continuation bytes have the bits 10 at the top.
+    const uint64_t continuations = word & ~(word << 1) & 0x8080808080808080ULL;
+    const size_t starts = sizeof(uint64_t) - std::popcount(continuations);
+    if (code_points + starts > L) {
+      break;
+    }
+    code_points += starts;
+  }
+  for (; i < source.size(); ++i) {
+    // Start of a new UTF-8 code point
+    if ((source[i] & 0xC0) != 0x80 && code_points++ == L) {
+      return i;
+    }
+  }
+  return source.size();
+}
+
+std::optional<std::string> TruncateUtils::TruncateUTF8Max(std::string_view source,
+                                                          size_t L) {
+  std::string truncated(source.substr(0, UTF8PrefixLength(source, L)));
+  if (truncated.size() == source.size()) {
+    return truncated;
+  }
+
+  // Increment the last code point that can be incremented, and drop the code points
+  // after it.
+  while (!truncated.empty()) {
+    size_t start = truncated.size() - 1;
+    while (start > 0 && (static_cast<uint8_t>(truncated[start]) & 0xC0) == 0x80) {
+      --start;
+    }
+    uint32_t next = DecodeCodePoint(std::string_view(truncated).substr(start)) + 1;
+    if (next >= 0xD800 && next <= 0xDFFF) {
+      // Surrogates are not valid code points.
+      next = 0xE000;
+    }
+    truncated.resize(start);
+    if (next <= 0x10FFFF) {
+      AppendCodePoint(next, &truncated);
+      return truncated;
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<std::vector<uint8_t>> TruncateUtils::TruncateBinaryMax(
+    std::span<const uint8_t> source, size_t L) {
+  if (source.size() <= L) {
+    return std::vector<uint8_t>(source.begin(), source.end());
+  }
+  std::vector<uint8_t> truncated(source.begin(), source.begin() + L);
+  while (!truncated.empty()) {
+    if (truncated.back() != 0xFF) {
+      ++truncated.back();
+      return truncated;
+    }
+    truncated.pop_back();
+  }
+  return std::nullopt;
+}
+
 Decimal TruncateUtils::TruncateDecimal(const Decimal& decimal, int32_t width) {
-  return decimal - (((decimal % width) + width) % width);
+  return TruncateInteger(decimal.value(), width);
 }
 
 #define DISPATCH_TRUNCATE_LITERAL(TYPE_ID) \
@@ -20,17 +20,28 @@
 #pragma once
 
 #include <cstdint>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 #include "iceberg/iceberg_export.h"
 #include "iceberg/result.h"
 #include "iceberg/type_fwd.h"
+#include "iceberg/util/int128.h"
 
 namespace iceberg {
 
 class ICEBERG_EXPORT TruncateUtils {
  public:
+  /// \brief Returns the number of bytes of the first L code points of a UTF-8 string.
+  ///
+  /// Code points are counted a word of 8 bytes at a time, by counting the bytes that
+  /// are not continuation bytes.
+  static size_t UTF8PrefixLength(std::string_view source, size_t L);
+
   /// \brief Truncate a UTF-8 string to a specified number of code points.
   ///
   /// \param source The input string to truncate.
@@ -39,36 +50,44 @@ class ICEBERG_EXPORT TruncateUtils {
   /// If the input string is already valid and has fewer than L code points, it is
   /// returned unchanged.
   static std::string TruncateUTF8(std::string source, size_t L) {
-    size_t code_point_count = 0;
-    size_t safe_point = 0;
-
-    for (size_t i = 0; i < source.size(); ++i) {
-      // Start of a new UTF-8 code point
-      if ((source[i] & 0xC0) != 0x80) {
-        code_point_count++;
-        if (code_point_count > static_cast<size_t>(L)) {
-          safe_point = i;
-          break;
-        }
-      }
-    }
-
-    if (safe_point != 0) {
-      // Resize the string to the safe point
-      source.resize(safe_point);
-    }
-
+    source.resize(UTF8PrefixLength(source, L));
     return source;
   }
 
-  /// \brief Truncate an integer v, either int32_t or int64_t, to v - (v % W).
+  /// \brief Truncate a UTF-8 string to an upper bound of a specified number of code
+  /// points.
+  ///
+  /// The truncated string is greater than or equal to all the strings that start with
+  /// the source string: its last code point is incremented when code points are
+  /// removed.
+  ///
+  /// \param source The input string to truncate.
+  /// \param L The maximum number of code points allowed in the output string.
+  /// \return The truncated string, or std::nullopt if no code point of the truncated
+  /// string can be incremented.
+  static std::optional<std::string> TruncateUTF8Max(std::string_view source, size_t L);
+
+  /// \brief Truncate a binary value to an upper bound of a specified number of bytes.
+  ///
+  /// \param source The input bytes to truncate.
+  /// \param L The maximum number of bytes allowed in the output.
+  /// \return The truncated bytes with the last byte incremented when bytes are
+  /// removed, or std::nullopt if all the truncated bytes are 0xFF.
+  static std::optional<std::vector<uint8_t>> TruncateBinaryMax(
+      std::span<const uint8_t> source, size_t L);
+
+  /// \brief Truncate an integer v, either int32_t, int64_t or the int128_t value of a
+  /// decimal, to v - (v % W).
   ///
   /// The remainder, v % W, must be positive. For languages where % can produce negative
   /// values, the correct truncate function is: v - (((v % W) + W) % W)
   template <typename T>
-    requires std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t>
+    requires std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t> ||
+             std::is_same_v<T, int128_t>
   static inline T TruncateInteger(T v, int32_t W) {
-    return v - (((v % W) + W) % W);
+    // One division instead of two, as it is applied to every value of an array.
+    const T remainder = v % W;
+    return v - remainder - (remainder < 0 ? W : 0);
   }
 
   /// \brief Truncate a Decimal to a specified width.
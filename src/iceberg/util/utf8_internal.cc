@@ -0,0 +1,213 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/util/utf8_internal.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "iceberg/util/macros.h"
+
+namespace iceberg {
+
+namespace {
+
+constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+
+bool IsContinuation(uint8_t byte) { return (byte & 0xC0) == 0x80; }
+
+template <typename Offset>
+Status ValidateStringArray(const ArrowSchema& schema, const ArrowArray& array) {
+  if (array.n_buffers != 3) {
+    return InvalidArrowData("Arrow string array has {} buffers, expected 3",
+                            array.n_buffers);
+  }
+  if (array.length == 0 || array.buffers[1] == nullptr) {
+    return {};
+  }
+  const auto* offsets = static_cast<const Offset*>(array.buffers[1]) + array.offset;
+  const auto* data = static_cast<const char*>(array.buffers[2]);
+  const auto begin = static_cast<int64_t>(offsets[0]);
+  const auto end = static_cast<int64_t>(offsets[array.length]);
+  if (begin == end) {
+    return {};
+  }
+  if (begin > end || data == nullptr) {
+    return InvalidArrowData("Arrow string array has invalid offsets or no data");
+  }
+  // Valid data with no value starting within a code point only holds valid values.
+  bool valid = IsValidUtf8(std::string_view(data + begin, end - begin));
+  for (int64_t i = 1; valid && i < array.length; ++i) {
+    const auto start = static_cast<int64_t>(offsets[i]);
+    valid = start < begin || start >= end ||
+            !IsContinuation(static_cast<uint8_t>(data[start]));
+  }
+  if (!valid) {
+    const std::string_view name = schema.name != nullptr ? schema.name : "";
+    return InvalidArrowData("Invalid UTF-8 in string column {}", name);
+  }
+  return {};
+}
+
+struct Utf8StreamPrivateData {
+  ~Utf8StreamPrivateData() {
+    if (schema.release != nullptr) {
+      schema.release(&schema);
+    }
+    if (stream.release != nullptr) {
+      stream.release(&stream);
+    }
+  }
+
+  ArrowArrayStream stream;
+  ArrowSchema schema{};
+  std::string last_error;
+};
+
+int GetSchema(ArrowArrayStream* stream, ArrowSchema* out) {
+  auto* data = static_cast<Utf8StreamPrivateData*>(stream->private_data);
+  return data->stream.get_schema(&data->stream, out);
+}
+
+int GetNext(ArrowArrayStream* stream, ArrowArray* out) {
+  auto* data = static_cast<Utf8StreamPrivateData*>(stream->private_data);
+  if (data->schema.release == nullptr) {
+    if (int code = data->stream.get_schema(&data->stream, &data->schema); code != 0) {
+      return code;
+    }
+  }
+  if (int code = data->stream.get_next(&data->stream, out); code != 0) {
+    return code;
+  }
+  if (out->release == nullptr) {
+    return 0;
+  }
+  if (auto status = ValidateUtf8(data->schema, *out); !status.has_value()) {
+    data->last_error = status.error().message;
+    out->release(out);
+    std::memset(out, 0, sizeof(ArrowArray));
+    return EIO;
+  }
+  return 0;
+}
+
+const char* GetLastError(ArrowArrayStream* stream) {
+  auto* data = static_cast<Utf8StreamPrivateData*>(stream->private_data);
+  if (!data->last_error.empty()) {
+    return data->last_error.c_str();
+  }
+  return data->stream.get_last_error(&data->stream);
+}
+
+void Release(ArrowArrayStream* stream) {
+  delete static_cast<Utf8StreamPrivateData*>(stream->private_data);
+  stream->private_data = nullptr;
+  stream->release = nullptr;
+}
+
+}  // namespace
+
+bool IsValidUtf8(std::string_view data) {
+  const auto* pos = reinterpret_cast<const uint8_t*>(data.data());
+  const auto* end = pos + data.size();
+  while (pos < end) {
+    while (end - pos >= 16) {
+      uint64_t low;
+      uint64_t high;
+      std::memcpy(&low, pos, sizeof(low));
+      std::memcpy(&high, pos + sizeof(low), sizeof(high));
+      if (((low | high) & kHighBits) != 0) {
+        break;
+      }
+      pos += 16;
+    }
+    if (pos == end) {
+      break;
+    }
+
+    const uint8_t lead = *pos;
+    int64_t size = 0;
+    if (lead < 0x80) {
+      ++pos;
+      continue;
+    } else if (lead >= 0xC2 && lead <= 0xDF) {
+      size = 2;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+      size = 3;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+      size = 4;
+    } else {
+      return false;
+    }
+    if (end - pos < size) {
+      return false;
+    }
+    for (int64_t i = 1; i < size; ++i) {
+      if (!IsContinuation(pos[i])) {
+        return false;
+      }
+    }
+    // Reject overlong encodings, surrogates and code points above U+10FFFF.
+    if ((lead == 0xE0 && pos[1] < 0xA0) || (lead == 0xED && pos[1] > 0x9F) ||
+        (lead == 0xF0 && pos[1] < 0x90) || (lead == 0xF4 && pos[1] > 0x8F)) {
+      return false;
+    }
+    pos += size;
+  }
+  return true;
+}
+
+Status ValidateUtf8(const ArrowSchema& schema, const ArrowArray& array) {
+  const std::string_view format = schema.format != nullptr ? schema.format : "";
+  if (format == "u") {
+    ICEBERG_RETURN_UNEXPECTED(ValidateStringArray<int32_t>(schema, array));
+  } else if (format == "U") {
+    ICEBERG_RETURN_UNEXPECTED(ValidateStringArray<int64_t>(schema, array));
+  }
+
+  if (schema.n_children != array.n_children) {
+    return InvalidArrowData("Arrow array has {} children, expected {}",
+                            array.n_children, schema.n_children);
+  }
+  for (int64_t i = 0; i < array.n_children; ++i) {
+    ICEBERG_RETURN_UNEXPECTED(ValidateUtf8(*schema.children[i], *array.children[i]));
+  }
+  if (schema.dictionary != nullptr) {
+    if (array.dictionary == nullptr) {
+      return InvalidArrowData("Dictionary-encoded Arrow array has no dictionary");
+    }
+    ICEBERG_RETURN_UNEXPECTED(ValidateUtf8(*schema.dictionary, *array.dictionary));
+  }
+  return {};
+}
+
+ArrowArrayStream MakeUtf8ValidatingArrowStream(ArrowArrayStream stream) {
+  auto data = std::make_unique<Utf8StreamPrivateData>();
+  data->stream = stream;
+  return ArrowArrayStream{.get_schema = GetSchema,
+                          .get_next = GetNext,
+                          .get_last_error = GetLastError,
+                          .release = Release,
+                          .private_data = data.release()};
+}
+
+}  // namespace iceberg
@@ -0,0 +1,53 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <string_view>
+
+#include "iceberg/arrow_c_data.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+
+namespace iceberg {
+
+/// \brief Returns whether the bytes are well-formed UTF-8.
+///
+/// Runs of ASCII are checked 16 bytes at a time, and other bytes one code point at a
+/// time. Overlong encodings, surrogates and code points above U+10FFFF are rejected.
+ICEBERG_EXPORT bool IsValidUtf8(std::string_view data);
+
+/// \brief Checks that the values of the string arrays in an Arrow array are UTF-8.
+///
+/// The data buffer of each string or large string array is validated at once, and its
+/// offsets are then checked to not split a code point. String arrays are found at any
+/// level of nesting and in dictionaries, other arrays are not checked.
+///
+/// \param schema The Arrow schema of the array
+/// \param array The array to check
+/// \return An InvalidArrowData error naming the column of the first invalid value
+ICEBERG_EXPORT Status ValidateUtf8(const ArrowSchema& schema, const ArrowArray& array);
+
+/// \brief Returns a stream of the batches of a stream, each checked with ValidateUtf8.
+///
+/// The returned stream owns `stream`. A batch with an invalid value is released and
+/// its error is returned instead.
+ICEBERG_EXPORT ArrowArrayStream MakeUtf8ValidatingArrowStream(ArrowArrayStream stream);
+
+}  // namespace iceberg
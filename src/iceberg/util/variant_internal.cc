@@ -0,0 +1,372 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "iceberg/util/variant_internal.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "iceberg/type.h"
+#include "iceberg/util/checked_cast.h"
+#include "iceberg/util/endian.h"
+#include "iceberg/util/int128.h"
+#include "iceberg/util/macros.h"
+#include "iceberg/util/uuid.h"
+
+namespace iceberg {
+
+namespace {
+
+// The basic types in the two low bits of the header of a value.
+constexpr uint8_t kPrimitive = 0;
+constexpr uint8_t kShortString = 1;
+constexpr uint8_t kObject = 2;
+
+// The types of primitive values, in the six high bits of the header.
+enum class VariantPrimitive : uint8_t {
+  kNull = 0,
+  kTrue = 1,
+  kFalse = 2,
+  kInt8 = 3,
+  kInt16 = 4,
+  kInt32 = 5,
+  kInt64 = 6,
+  kDouble = 7,
+  kDecimal4 = 8,
+  kDecimal8 = 9,
+  kDecimal16 = 10,
+  kDate = 11,
+  kTimestampTz = 12,
+  kTimestamp = 13,
+  kFloat = 14,
+  kBinary = 15,
+  kString = 16,
+  kTime = 17,
+  kTimestampTzNanos = 18,
+  kTimestampNanos = 19,
+  kUuid = 20,
+};
+
+constexpr uint8_t kMetadataVersion = 1;
+
+/// \brief Reads an unsigned little-endian integer of 1 to 4 bytes.
+uint32_t ReadUnsigned(const char* data, int size) {
+  uint32_t result = 0;
+  for (int i = 0; i < size; ++i) {
+    result |= static_cast<uint32_t>(static_cast<uint8_t>(data[i])) << (8 * i);
+  }
+  return result;
+}
+
+template <typename T>
+T ReadLittleEndian(const char* data) {
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return FromLittleEndian(value);
+}
+
+Status CheckSize(std::string_view data, size_t size) {
+  if (data.size() < size) {
+    return Invalid("Truncated variant value, expected {} bytes, got {}", size,
+                   data.size());
+  }
+  return {};
+}
+
+/// \brief The dictionary of field names in the metadata of a variant.
+class VariantMetadata {
+ public:
+  static Result<VariantMetadata> Make(std::string_view metadata) {
+    ICEBERG_RETURN_UNEXPECTED(CheckSize(metadata, 1));
+    const auto header = static_cast<uint8_t>(metadata[0]);
+    if ((header & 0x0F) != kMetadataVersion) {
+      return Invalid("Unsupported variant metadata version {}", header & 0x0F);
+    }
+    const int offset_size = ((header >> 6) & 0x03) + 1;
+    ICEBERG_RETURN_UNEXPECTED(CheckSize(metadata, 1 + offset_size));
+    const uint32_t size = ReadUnsigned(metadata.data() + 1, offset_size);
+    const size_t strings_begin = 1 + (static_cast<size_t>(size) + 2) * offset_size;
+    ICEBERG_RETURN_UNEXPECTED(CheckSize(metadata, strings_begin));
+    return VariantMetadata(metadata.data() + 1 + offset_size, offset_size, size,
+                           metadata.substr(strings_begin));
+  }
+
+  /// \brief Returns the field name with an id.
+  Result<std::string_view> Key(uint32_t id) const {
+    if (id >= size_) {
+      return Invalid("Variant field id {} is out of the dictionary of {} names", id,
+                     size_);
+    }
+    const uint32_t begin = ReadUnsigned(offsets_ + id * offset_size_, offset_size_);
+    const uint32_t end = ReadUnsigned(offsets_ + (id + 1) * offset_size_, offset_size_);
+    if (begin > end || end > strings_.size()) {
+      return Invalid("Invalid offsets of variant field name {}", id);
+    }
+    return strings_.substr(begin, end - begin);
+  }
+
+ private:
+  VariantMetadata(const char* offsets, int offset_size, uint32_t size,
+                  std::string_view strings)
+      : offsets_(offsets), offset_size_(offset_size), size_(size), strings_(strings) {}
+
+  const char* offsets_;
+  int offset_size_;
+  uint32_t size_;
+  std::string_view strings_;
+};
+
+/// \brief Returns the value of a field of an object, or nullopt if it has no such field.
+Result<std::optional<std::string_view>> FindObjectField(const VariantMetadata& metadata,
+                                                        std::string_view object,
+                                                        std::string_view name) {
+  const auto value_header = static_cast<uint8_t>(object[0]) >> 2;
+  const int offset_size = (value_header & 0x03) + 1;
+  const int id_size = ((value_header >> 2) & 0x03) + 1;
+  const int count_size = (value_header & 0x10) != 0 ? 4 : 1;
+  ICEBERG_RETURN_UNEXPECTED(CheckSize(object, 1 + count_size));
+  const uint32_t count = ReadUnsigned(object.data() + 1, count_size);
+  const size_t ids_begin = 1 + count_size;
+  const size_t offsets_begin = ids_begin + static_cast<size_t>(count) * id_size;
+  const size_t values_begin =
+      offsets_begin + (static_cast<size_t>(count) + 1) * offset_size;
+  ICEBERG_RETURN_UNEXPECTED(CheckSize(object, values_begin));
+  const char* ids = object.data() + ids_begin;
+  const char* offsets = object.data() + offsets_begin;
+  const uint32_t values_size = ReadUnsigned(offsets + count * offset_size, offset_size);
+  ICEBERG_RETURN_UNEXPECTED(CheckSize(object, values_begin + values_size));
+
+  // The fields of an object are sorted by name.
+  uint32_t low = 0;
+  uint32_t high = count;
+  while (low < high) {
+    const uint32_t mid = low + (high - low) / 2;
+    ICEBERG_ASSIGN_OR_RAISE(auto key,
+                            metadata.Key(ReadUnsigned(ids + mid * id_size, id_size)));
+    const int cmp = key.compare(name);
+    if (cmp == 0) {
+      const uint32_t offset = ReadUnsigned(offsets + mid * offset_size, offset_size);
+      if (offset >= values_size) {
+        return Invalid("Invalid offset {} of variant field {}", offset, name);
+      }
+      return object.substr(values_begin + offset, values_size - offset);
+    }
+    if (cmp < 0) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return std::nullopt;
+}
+
+Literal IntegerLiteral(int64_t value, const std::shared_ptr<PrimitiveType>& type) {
+  switch (type->type_id()) {
+    case TypeId::kInt:
+      if (value >= std::numeric_limits<int32_t>::min() &&
+          value <= std::numeric_limits<int32_t>::max()) {
+        return Literal::Int(static_cast<int32_t>(value));
+      }
+      break;
+    case TypeId::kLong:
+      return Literal::Long(value);
+    default:
+      break;
+  }
+  return Literal::Null(type);
+}
+
+Literal DecimalLiteral(int128_t unscaled, int32_t scale,
+                       const std::shared_ptr<PrimitiveType>& type) {
+  if (type->type_id() != TypeId::kDecimal) {
+    return Literal::Null(type);
+  }
+  const auto& decimal_type = internal::checked_cast<const DecimalType&>(*type);
+  if (decimal_type.scale() != scale) {
+    return Literal::Null(type);
+  }
+  int128_t limit = 1;
+  for (int32_t i = 0; i < decimal_type.precision(); ++i) {
+    limit *= 10;
+  }
+  if (unscaled >= limit || unscaled <= -limit) {
+    return Literal::Null(type);
+  }
+  return Literal::Decimal(unscaled, decimal_type.precision(), scale);
+}
+
+Result<Literal> PrimitiveToLiteral(std::string_view value,
+                                   const std::shared_ptr<PrimitiveType>& type) {
+  const auto primitive =
+      static_cast<VariantPrimitive>(static_cast<uint8_t>(value[0]) >> 2);
+  const char* data = value.data() + 1;
+  const TypeId type_id = type->type_id();
+  switch (primitive) {
+    case VariantPrimitive::kNull:
+      return Literal::Null(type);
+    case VariantPrimitive::kTrue:
+    case VariantPrimitive::kFalse:
+      if (type_id == TypeId::kBoolean) {
+        return Literal::Boolean(primitive == VariantPrimitive::kTrue);
+      }
+      return Literal::Null(type);
+    case VariantPrimitive::kInt8:
+      ICEBERG_RETURN_UNEXPECTED(CheckSize(value, 2));
+      return IntegerLiteral(static_cast<int8_t>(data[0]), type);
+    case VariantPrimitive::kInt16:
+      ICEBERG_RETURN_UNEXPECTED(CheckSize(value, 3));
+      return IntegerLiteral(ReadLittleEndian<int16_t>(data), type);
+    case VariantPrimitive::kInt32:
+      ICEBERG_RETURN_UNEXPECTED(CheckSize(value, 5));
+      return IntegerLiteral(ReadLittleEndian<int32_t>(data), type);
+    case VariantPrimitive::kInt64:
+      ICEBERG_RETURN_UNEXPECTED(CheckSize(value, 9));
+      return IntegerLiteral(ReadLittleEndian<int64_t>(data), type);
+    case VariantPrimitive::kFloat:
+      ICEBERG_RETURN_UNEXPECTED(CheckSize(value, 5));
+      if (type_id == TypeId::kFloat) {
+        return Literal::Float(ReadLittleEndian<float>(data));
+      }
+      if (type_id == TypeId::kDouble) {
+        return Literal::Double(ReadLittleEndian<float>(data));
+      }
+      return Literal::Null(type);
+    case VariantPrimitive::kDouble:
+      ICEBERG_RETURN_UNEXPECTED(CheckSize(value, 9));
+      if (type_id == TypeId::kDouble) {
+        return Literal::Double(ReadLittleEndian<double>(data));
+      }
+      return Literal::Null(type);
+    case VariantPrimitive::kDecimal4:
+      ICEBERG_RETURN_UNEXPECTED(CheckSize(value, 6));
+      return DecimalLiteral(ReadLittleEndian<int32_t>(data + 1),
+                            static_cast<uint8_t>(data[0]), type);
+    case VariantPrimitive::kDecimal8:
+      ICEBERG_RETURN_UNEXPECTED(CheckSize(value, 10));
+      return DecimalLiteral(ReadLittleEndian<int64_t>(data + 1),
+                            static_cast<uint8_t>(data[0]), type);
+    case VariantPrimitive::kDecimal16: {
+      ICEBERG_RETURN_UNEXPECTED(CheckSize(value, 18));
+      const auto low = ReadLittleEndian<uint64_t>(data + 1);
+      const auto high = ReadLittleEndian<int64_t>(data + 9);
+      const auto unscaled = static_cast<int128_t>(
+          (static_cast<uint128_t>(static_cast<uint64_t>(high)) << 64) | low);
+      return DecimalLiteral(unscaled, static_cast<uint8_t>(data[0]), type);
+    }
+    case VariantPrimitive::kDate:
+      ICEBERG_RETURN_UNEXPECTED(CheckSize(value, 5));
+      if (type_id == TypeId::kDate) {
+        return Literal::Date(ReadLittleEndian<int32_t>(data));
+      }
+      return Literal::Null(type);
+    case VariantPrimitive::kTime:
+      ICEBERG_RETURN_UNEXPECTED(CheckSize(value, 9));
+      if (type_id == TypeId::kTime) {
+        return Literal::Time(ReadLittleEndian<int64_t>(data));
+      }
+      return Literal::Null(type);
+    case VariantPrimitive::kTimestamp:
+      ICEBERG_RETURN_UNEXPECTED(CheckSize(value, 9));
+      if (type_id == TypeId::kTimestamp) {
+        return Literal::Timestamp(ReadLittleEndian<int64_t>(data));
+      }
+      return Literal::Null(type);
+    case VariantPrimitive::kTimestampTz:
+      ICEBERG_RETURN_UNEXPECTED(CheckSize(value, 9));
+      if (type_id == TypeId::kTimestampTz) {
+        return Literal::TimestampTz(ReadLittleEndian<int64_t>(data));
+      }
+      return Literal::Null(type);
+    case VariantPrimitive::kTimestampNanos:
+    case VariantPrimitive::kTimestampTzNanos:
+      return Literal::Null(type);
+    case VariantPrimitive::kBinary:
+    case VariantPrimitive::kString: {
+      ICEBERG_RETURN_UNEXPECTED(CheckSize(value, 5));
+      const uint32_t length = ReadUnsigned(data, 4);
+      ICEBERG_RETURN_UNEXPECTED(CheckSize(value, 5 + static_cast<size_t>(length)));
+      if (primitive == VariantPrimitive::kString && type_id == TypeId::kString) {
+        return Literal::String(std::string(data + 4, length));
+      }
+      if (primitive == VariantPrimitive::kBinary && type_id == TypeId::kBinary) {
+        return Literal::Binary(std::vector<uint8_t>(data + 4, data + 4 + length));
+      }
+      return Literal::Null(type);
+    }
+    case VariantPrimitive::kUuid: {
+      ICEBERG_RETURN_UNEXPECTED(CheckSize(value, 1 + Uuid::kLength));
+      if (type_id != TypeId::kUuid) {
+        return Literal::Null(type);
+      }
+      ICEBERG_ASSIGN_OR_RAISE(
+          auto uuid, Uuid::FromBytes(std::span<const uint8_t>(
+                         reinterpret_cast<const uint8_t*>(data), Uuid::kLength)));
+      return Literal::UUID(uuid);
+    }
+  }
+  return Invalid("Unknown variant primitive type {}", static_cast<uint8_t>(primitive));
+}
+
+}  // namespace
+
+Result<std::optional<std::string_view>> FindVariantField(
+    std::string_view metadata, std::string_view value,
+    std::span<const std::string> path) {
+  if (path.empty()) {
+    return value;
+  }
+  ICEBERG_ASSIGN_OR_RAISE(auto dictionary, VariantMetadata::Make(metadata));
+  std::optional<std::string_view> field = value;
+  for (const auto& name : path) {
+    ICEBERG_RETURN_UNEXPECTED(CheckSize(*field, 1));
+    if ((static_cast<uint8_t>((*field)[0]) & 0x03) != kObject) {
+      return std::nullopt;
+    }
+    ICEBERG_ASSIGN_OR_RAISE(field, FindObjectField(dictionary, *field, name));
+    if (!field.has_value()) {
+      return std::nullopt;
+    }
+  }
+  return field;
+}
+
+Result<Literal> VariantToLiteral(std::string_view value,
+                                 const std::shared_ptr<PrimitiveType>& type) {
+  ICEBERG_RETURN_UNEXPECTED(CheckSize(value, 1));
+  const auto header = static_cast<uint8_t>(value[0]);
+  switch (header & 0x03) {
+    case kPrimitive:
+      return PrimitiveToLiteral(value, type);
+    case kShortString: {
+      const size_t length = header >> 2;
+      ICEBERG_RETURN_UNEXPECTED(CheckSize(value, 1 + length));
+      if (type->type_id() == TypeId::kString) {
+        return Literal::String(std::string(value.substr(1, length)));
+      }
+      return Literal::Null(type);
+    }
+    default:
+      // Objects and arrays.
+      return Literal::Null(type);
+  }
+}
+
+}  // namespace iceberg
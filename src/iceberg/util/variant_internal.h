@@ -0,0 +1,61 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "iceberg/expression/literal.h"
+#include "iceberg/iceberg_export.h"
+#include "iceberg/result.h"
+#include "iceberg/type_fwd.h"
+
+namespace iceberg {
+
+/// \brief Returns the value of a field nested in objects of a variant.
+///
+/// The metadata and the value are in the variant binary encoding. Each name of the path
+/// is looked up in the dictionary of the metadata, and then by binary search in the
+/// sorted fields of the object.
+///
+/// \param metadata The metadata of the variant
+/// \param value The value to start from, an object unless the path is empty
+/// \param path The names of the object fields to follow
+/// \return The encoded value of the field, which may extend past its end, or nullopt if
+/// a value on the path is not an object or does not have the next field
+ICEBERG_EXPORT Result<std::optional<std::string_view>> FindVariantField(
+    std::string_view metadata, std::string_view value,
+    std::span<const std::string> path);
+
+/// \brief Converts a variant value in the binary encoding to a literal of a type.
+///
+/// Integers of any width are converted to int and long when they fit, floats to double,
+/// and decimals to decimal types of the same scale that can hold them. Variant nulls,
+/// objects, arrays and values of other types are converted to a null literal.
+///
+/// \param value The encoded value
+/// \param type The type of the literal
+ICEBERG_EXPORT Result<Literal> VariantToLiteral(
+    std::string_view value, const std::shared_ptr<PrimitiveType>& type);
+
+}  // namespace iceberg
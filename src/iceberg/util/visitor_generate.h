@@ -36,6 +36,7 @@ namespace iceberg {
   ACTION(Uuid);                                \
   ACTION(Fixed);                               \
   ACTION(Binary);                              \
+  ACTION(Variant);                             \
   ACTION(Struct);                              \
   ACTION(List);                                \
   ACTION(Map);
@@ -62,6 +62,10 @@ Status ManifestEntryAdapterV1::Append(const ManifestEntry& entry) {
   return AppendInternal(entry);
 }
 
+Status ManifestEntryAdapterV1::AppendAll(std::span<const ManifestEntry> entries) {
+  return AppendAllInternal(entries);
+}
+
 Result<std::shared_ptr<StructType>> ManifestEntryAdapterV1::GetManifestEntryType() {
   // 'block_size_in_bytes' (ID 105) is a deprecated field that is REQUIRED
   // in the v1 data_file schema for backward compatibility.
@@ -32,6 +32,7 @@ class ManifestEntryAdapterV1 : public ManifestEntryAdapter {
       : ManifestEntryAdapter(std::move(partition_spec)), snapshot_id_(snapshot_id) {}
   Status Init() override;
   Status Append(const ManifestEntry& entry) override;
+  Status AppendAll(std::span<const ManifestEntry> entries) override;
 
  protected:
   Result<std::shared_ptr<StructType>> GetManifestEntryType() override;
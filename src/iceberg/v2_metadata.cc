@@ -67,6 +67,10 @@ Status ManifestEntryAdapterV2::Append(const ManifestEntry& entry) {
   return AppendInternal(entry);
 }
 
+Status ManifestEntryAdapterV2::AppendAll(std::span<const ManifestEntry> entries) {
+  return AppendAllInternal(entries);
+}
+
 Result<std::optional<int64_t>> ManifestEntryAdapterV2::GetSequenceNumber(
     const ManifestEntry& entry) const {
   if (!entry.sequence_number.has_value()) {
@@ -33,6 +33,7 @@ class ManifestEntryAdapterV2 : public ManifestEntryAdapter {
       : ManifestEntryAdapter(std::move(partition_spec)), snapshot_id_(snapshot_id) {}
   Status Init() override;
   Status Append(const ManifestEntry& entry) override;
+  Status AppendAll(std::span<const ManifestEntry> entries) override;
 
  protected:
   Result<std::optional<int64_t>> GetSequenceNumber(
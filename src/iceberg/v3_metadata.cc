@@ -70,6 +70,10 @@ Status ManifestEntryAdapterV3::Append(const ManifestEntry& entry) {
   return AppendInternal(entry);
 }
 
+Status ManifestEntryAdapterV3::AppendAll(std::span<const ManifestEntry> entries) {
+  return AppendAllInternal(entries);
+}
+
 Result<std::optional<int64_t>> ManifestEntryAdapterV3::GetSequenceNumber(
     const ManifestEntry& entry) const {
   if (!entry.sequence_number.has_value()) {
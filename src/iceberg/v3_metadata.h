@@ -36,6 +36,7 @@ class ManifestEntryAdapterV3 : public ManifestEntryAdapter {
         first_row_id_(first_row_id) {}
   Status Init() override;
   Status Append(const ManifestEntry& entry) override;
+  Status AppendAll(std::span<const ManifestEntry> entries) override;
 
  protected:
   Result<std::optional<int64_t>> GetSequenceNumber(